@@ -679,6 +679,10 @@ var gniExportDescs = []exporter.GNIExportDesc{
 			Rules: []string{
 				"//modules/skcms:skcms_TransformHsw",
 			}},
+		{Var: "skcms_TransformNeon",
+			Rules: []string{
+				"//modules/skcms:skcms_TransformNeon",
+			}},
 		{Var: "skcms_TransformSkx",
 			Rules: []string{
 				"//modules/skcms:skcms_TransformSkx",
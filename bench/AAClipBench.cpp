@@ -240,6 +240,79 @@ private:
     using INHERITED = Benchmark;
 };
 
+////////////////////////////////////////////////////////////////////////////////
+// A 4K frame clipped by a complex path: a many-pointed star over concentric even-odd rings. This
+// exercises building the AA clip rows and blitting rects and AA paths through the clip.
+class ComplexAAClipBench : public Benchmark {
+public:
+    enum class Mode { kBuild, kDrawRect, kDrawPath };
+
+    explicit ComplexAAClipBench(Mode mode) : fMode(mode) {
+        static const char* kNames[] = { "build", "rect", "path" };
+        fName.printf("aaclip_complex_4k_%s", kNames[(int)mode]);
+
+        const SkScalar cx = kW * 0.5f, cy = kH * 0.5f;
+        constexpr int kPoints = 97;
+        for (int i = 0; i < 2 * kPoints; ++i) {
+            SkScalar r = (i & 1) ? kH * 0.2f : kH * 0.49f;
+            SkScalar theta = i * SK_ScalarPI / kPoints;
+            SkPoint pt = {cx + r * SkScalarCos(theta), cy + r * SkScalarSin(theta)};
+            if (i == 0) {
+                fClipPath.moveTo(pt);
+            } else {
+                fClipPath.lineTo(pt);
+            }
+        }
+        fClipPath.close();
+        for (int i = 1; i <= 16; ++i) {
+            fClipPath.addCircle(cx, cy, i * kW / 34.0f + 0.3f);
+        }
+        fClipPath.setFillType(SkPathFillType::kEvenOdd);
+
+        fDrawPath.addOval(SkRect::MakeXYWH(1.5f, 2.5f, kW - 3, kH - 5));
+    }
+
+protected:
+    static constexpr int kW = 3840;
+    static constexpr int kH = 2160;
+
+    const char* onGetName() override { return fName.c_str(); }
+    SkISize onGetSize() override { return {kW, kH}; }
+    bool isSuitableFor(Backend backend) override { return backend == Backend::kRaster; }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        SkPaint paint;
+        this->setupPaint(&paint);
+        paint.setAntiAlias(true);
+
+        for (int i = 0; i < loops; ++i) {
+            if (fMode == Mode::kBuild) {
+                SkAAClip clip;
+                clip.setPath(fClipPath, {0, 0, kW, kH}, true);
+                continue;
+            }
+            canvas->save();
+            // jostle the clip each time to prevent caching
+            canvas->translate((i & 1) ? 0.25f : -0.25f, 0);
+            canvas->clipPath(fClipPath, SkClipOp::kIntersect, true);
+            canvas->resetMatrix();
+            if (fMode == Mode::kDrawRect) {
+                canvas->drawRect(SkRect::MakeWH(kW, kH), paint);
+            } else {
+                canvas->drawPath(fDrawPath, paint);
+            }
+            canvas->restore();
+        }
+    }
+
+private:
+    SkString fName;
+    Mode     fMode;
+    SkPath   fClipPath;
+    SkPath   fDrawPath;
+    using INHERITED = Benchmark;
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 
 DEF_BENCH(return new AAClipBuilderBench(false, false);)
@@ -253,3 +326,6 @@ DEF_BENCH(return new AAClipBench(true, false);)
 DEF_BENCH(return new AAClipBench(true, true);)
 DEF_BENCH(return new NestedAAClipBench(false);)
 DEF_BENCH(return new NestedAAClipBench(true);)
+DEF_BENCH(return new ComplexAAClipBench(ComplexAAClipBench::Mode::kBuild);)
+DEF_BENCH(return new ComplexAAClipBench(ComplexAAClipBench::Mode::kDrawRect);)
+DEF_BENCH(return new ComplexAAClipBench(ComplexAAClipBench::Mode::kDrawPath);)
@@ -64,6 +64,13 @@ public:
         return true;
     }
 
+    // Whether several instances of this benchmark, each drawing to its own canvas, can run at the
+    // same time on different threads. nanobench's --benchThreads mode runs these concurrently to
+    // measure how they scale.
+    virtual bool isThreadSafe() const {
+        return false;
+    }
+
     // Call before draw, allows the benchmark to do setup work outside of the
     // timer. When a benchmark is repeatedly drawn, this should be called once
     // before the initial draw.
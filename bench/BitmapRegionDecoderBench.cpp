@@ -13,12 +13,15 @@
 #include "src/core/SkOSFile.h"
 
 BitmapRegionDecoderBench::BitmapRegionDecoderBench(const char* baseName, SkData* encoded,
-        SkColorType colorType, uint32_t sampleSize, const SkIRect& subset)
+        SkColorType colorType, uint32_t sampleSize, const SkIRect& subset, int tileCount,
+        SkIVector tileStep)
     : fBRD(nullptr)
     , fData(SkRef(encoded))
     , fColorType(colorType)
     , fSampleSize(sampleSize)
     , fSubset(subset)
+    , fTileCount(tileCount)
+    , fTileStep(tileStep)
 {
     // Choose a useful name for the color type
     const char* colorName = color_type_to_str(colorType);
@@ -45,8 +48,11 @@ void BitmapRegionDecoderBench::onDraw(int n, SkCanvas* canvas) {
     auto ct = fBRD->computeOutputColorType(fColorType);
     auto cs = fBRD->computeOutputColorSpace(ct, nullptr);
     for (int i = 0; i < n; i++) {
-        SkBitmap bm;
-        SkAssertResult(fBRD->decodeRegion(&bm, nullptr, fSubset, fSampleSize, ct, false, cs));
+        for (int tile = 0; tile < fTileCount; tile++) {
+            const SkIRect subset = fSubset.makeOffset(fTileStep.fX * tile, fTileStep.fY * tile);
+            SkBitmap bm;
+            SkAssertResult(fBRD->decodeRegion(&bm, nullptr, subset, fSampleSize, ct, false, cs));
+        }
     }
 }
 #endif // SK_ENABLE_ANDROID_UTILS
@@ -12,6 +12,7 @@
 #ifdef SK_ENABLE_ANDROID_UTILS
 #include "include/core/SkData.h"
 #include "include/core/SkImageInfo.h"
+#include "include/core/SkPoint.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkString.h"
 
@@ -23,6 +24,8 @@ class BitmapRegionDecoder;
 
 /**
  *  Benchmark Android's BitmapRegionDecoder for a particular colorType, sampleSize, and subset.
+ *  With a tileCount above one, each iteration decodes that many tiles the size of subset, each
+ *  offset from the last by tileStep, the way a viewer requests tiles while panning.
  *
  *  nanobench.cpp handles creating benchmarks for interesting scaled subsets.  We strive to test
  *  on real use cases.
@@ -31,7 +34,8 @@ class BitmapRegionDecoderBench : public Benchmark {
 public:
     // Calls encoded->ref()
     BitmapRegionDecoderBench(const char* basename, SkData* encoded, SkColorType colorType,
-            uint32_t sampleSize, const SkIRect& subset);
+            uint32_t sampleSize, const SkIRect& subset, int tileCount = 1,
+            SkIVector tileStep = {0, 0});
 
 protected:
     const char* onGetName() override;
@@ -46,6 +50,8 @@ private:
     const SkColorType                                   fColorType;
     const uint32_t                                      fSampleSize;
     const SkIRect                                       fSubset;
+    const int                                           fTileCount;
+    const SkIVector                                     fTileStep;
     using INHERITED = Benchmark;
 };
 #endif // SK_ENABLE_ANDROID_UTILS
@@ -0,0 +1,78 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkString.h"
+#include "include/private/SkColorData.h"
+#include "src/base/SkRandom.h"
+#include "src/core/SkBlitMask.h"
+#include "src/core/SkBlitRow.h"
+
+// Times SkOpts' srcover row and A8 mask blits directly, on whichever kernels this CPU selected.
+class BlitRowBench : public Benchmark {
+public:
+    enum class Kind { kSrcOver, kColor32, kMaskBlack, kMaskOpaque, kMaskGeneral };
+
+    BlitRowBench(Kind kind, const char* name) : fKind(kind) {
+        fName.printf("blitrow_%s", name);
+    }
+
+    bool isSuitableFor(Backend backend) override { return backend == Backend::kNonRendering; }
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        SkRandom rand;
+        for (int i = 0; i < kW * kH; ++i) {
+            fDst[i] = SkPreMultiplyColor(rand.nextU());
+            fSrc[i] = SkPreMultiplyColor(rand.nextU());
+            fMask[i] = rand.nextU() & 0xff;
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        while (loops --> 0) {
+            switch (fKind) {
+                case Kind::kSrcOver:
+                    for (int y = 0; y < kH; ++y) {
+                        SkOpts::blit_row_s32a_opaque(fDst + y*kW, fSrc + y*kW, kW, 0xFF);
+                    }
+                    break;
+                case Kind::kColor32:
+                    for (int y = 0; y < kH; ++y) {
+                        SkOpts::blit_row_color32(fDst + y*kW, kW, 0x80402010);
+                    }
+                    break;
+                case Kind::kMaskBlack:
+                    SkOpts::blit_mask_d32_a8(fDst, kW*4, fMask, kW, SK_ColorBLACK, kW, kH);
+                    break;
+                case Kind::kMaskOpaque:
+                    SkOpts::blit_mask_d32_a8(fDst, kW*4, fMask, kW, 0xFF3080C0, kW, kH);
+                    break;
+                case Kind::kMaskGeneral:
+                    SkOpts::blit_mask_d32_a8(fDst, kW*4, fMask, kW, 0x803080C0, kW, kH);
+                    break;
+            }
+        }
+    }
+
+private:
+    // Arbitrary, but a non-multiple of 16 to exercise the tails of the SIMD loops.
+    static constexpr int kW = 1023, kH = 16;
+
+    Kind fKind;
+    SkString fName;
+    SkPMColor fDst[kW * kH];
+    SkPMColor fSrc[kW * kH];
+    SkAlpha fMask[kW * kH];
+};
+
+DEF_BENCH(return new BlitRowBench(BlitRowBench::Kind::kSrcOver, "srcover");)
+DEF_BENCH(return new BlitRowBench(BlitRowBench::Kind::kColor32, "color32");)
+DEF_BENCH(return new BlitRowBench(BlitRowBench::Kind::kMaskBlack, "mask_a8_black");)
+DEF_BENCH(return new BlitRowBench(BlitRowBench::Kind::kMaskOpaque, "mask_a8_opaque");)
+DEF_BENCH(return new BlitRowBench(BlitRowBench::Kind::kMaskGeneral, "mask_a8_general");)
@@ -18,6 +18,8 @@
 #define FILTER_HEIGHT_SMALL 32
 #define FILTER_WIDTH_LARGE  256
 #define FILTER_HEIGHT_LARGE 256
+#define FILTER_WIDTH_FULLSCREEN  1920
+#define FILTER_HEIGHT_FULLSCREEN 1080
 #define BLUR_SIGMA_MINI     0.5f
 #define BLUR_SIGMA_SMALL    1.0f
 #define BLUR_SIGMA_LARGE    10.0f
@@ -61,15 +63,17 @@ static sk_sp<SkImage> make_checkerboard(int width, int height) {
 class BlurImageFilterBench : public Benchmark {
 public:
     BlurImageFilterBench(SkScalar sigmaX, SkScalar sigmaY,  bool small, bool cropped,
-                         bool expanded)
+                         bool expanded, bool fullscreen = false)
       : fIsSmall(small)
       , fIsCropped(cropped)
       , fIsExpanded(expanded)
+      , fIsFullscreen(fullscreen)
       , fInitialized(false)
       , fSigmaX(sigmaX)
       , fSigmaY(sigmaY) {
+        SkASSERT(!fIsFullscreen || !fIsSmall);
         fName.printf("blur_image_filter_%s%s%s_%.2f_%.2f",
-                     fIsSmall ? "small" : "large",
+                     fIsFullscreen ? "fullscreen" : fIsSmall ? "small" : "large",
                      fIsCropped ? "_cropped" : "",
                      fIsExpanded ? "_expanded" : "",
                      sigmaX, sigmaY);
@@ -83,8 +87,14 @@ protected:
 
     void onDelayedSetup() override {
         if (!fInitialized) {
-            fCheckerboard = make_checkerboard(fIsSmall ? FILTER_WIDTH_SMALL : FILTER_WIDTH_LARGE,
-                                              fIsSmall ? FILTER_HEIGHT_SMALL : FILTER_HEIGHT_LARGE);
+            if (fIsFullscreen) {
+                fCheckerboard = make_checkerboard(FILTER_WIDTH_FULLSCREEN,
+                                                  FILTER_HEIGHT_FULLSCREEN);
+            } else {
+                fCheckerboard = make_checkerboard(
+                        fIsSmall ? FILTER_WIDTH_SMALL : FILTER_WIDTH_LARGE,
+                        fIsSmall ? FILTER_HEIGHT_SMALL : FILTER_HEIGHT_LARGE);
+            }
             fInitialized = true;
         }
     }
@@ -117,6 +127,7 @@ private:
     bool fIsSmall;
     bool fIsCropped;
     bool fIsExpanded;
+    bool fIsFullscreen;
     bool fInitialized;
     sk_sp<SkImage> fCheckerboard;
     SkScalar fSigmaX, fSigmaY;
@@ -136,6 +147,14 @@ DEF_BENCH(return new BlurImageFilterBench(BLUR_SIGMA_LARGE, BLUR_SIGMA_LARGE, fa
 DEF_BENCH(return new BlurImageFilterBench(BLUR_SIGMA_HUGE, BLUR_SIGMA_HUGE, true, false, false);)
 DEF_BENCH(return new BlurImageFilterBench(BLUR_SIGMA_HUGE, BLUR_SIGMA_HUGE, false, false, false);)
 
+// Backdrop-sized blurs, where splitting the passes across threads and blocking the column pass
+// matter most on the CPU.
+DEF_BENCH(return new BlurImageFilterBench(BLUR_SIGMA_LARGE, BLUR_SIGMA_LARGE, false, false, false,
+                                          true);)
+DEF_BENCH(return new BlurImageFilterBench(BLUR_SIGMA_HUGE, BLUR_SIGMA_HUGE, false, false, false,
+                                          true);)
+DEF_BENCH(return new BlurImageFilterBench(0, BLUR_SIGMA_HUGE, false, false, false, true);)
+
 DEF_BENCH(return new BlurImageFilterBench(BLUR_SIGMA_LARGE, 0, false, true, false);)
 DEF_BENCH(return new BlurImageFilterBench(BLUR_SIGMA_SMALL, 0, false, true, false);)
 DEF_BENCH(return new BlurImageFilterBench(0, BLUR_SIGMA_LARGE, false, true, false);)
@@ -367,3 +367,69 @@ DEF_BENCH(return new CompositingImages({512, 512}, {380, 380}, {5, 5}, ClampingM
 DEF_BENCH(return new CompositingImages({512, 512}, {380, 380}, {5, 5}, ClampingMode::kAlwaysStrict, TransformMode::kPerspective, 1));
 DEF_BENCH(return new CompositingImages({512, 512}, {380, 380}, {5, 5}, ClampingMode::kChromeTiling_RowMajor, TransformMode::kPerspective, 1));
 DEF_BENCH(return new CompositingImages({512, 512}, {380, 380}, {5, 5}, ClampingMode::kChromeTiling_Optimal, TransformMode::kPerspective, 1));
+
+// Raster counterpart: many pixel-aligned tiles cut from one image (e.g. a tiled layer or a
+// sprite sheet), drawn with a single image-set call.
+class RasterImageSetSprites : public Benchmark {
+public:
+    RasterImageSetSprites(int tileSize) : fTileSize(tileSize) {
+        fName.printf("raster_imageset_sprites_%d", tileSize);
+    }
+
+    bool isSuitableFor(Backend backend) override { return Backend::kRaster == backend; }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onPerCanvasPreDraw(SkCanvas* canvas) override {
+        auto surface = SkSurfaces::Raster(SkImageInfo::MakeN32Premul(kSize, kSize));
+        SkRandom rand;
+        for (int y = 0; y < kSize; y += fTileSize) {
+            for (int x = 0; x < kSize; x += fTileSize) {
+                SkPaint paint;
+                paint.setColor(rand.nextU() | 0x80000000);
+                surface->getCanvas()->drawRect(SkRect::MakeXYWH(x, y, fTileSize, fTileSize),
+                                               paint);
+            }
+        }
+        sk_sp<SkImage> image = surface->makeImageSnapshot();
+
+        // Shuffle the tiles so each lands somewhere other than where it came from.
+        const int tiles = kSize / fTileSize;
+        fEntries.clear();
+        for (int i = 0; i < tiles * tiles; ++i) {
+            int j = (i * 7 + 3) % (tiles * tiles);
+            SkRect src = SkRect::MakeXYWH((i % tiles) * fTileSize, (i / tiles) * fTileSize,
+                                          fTileSize, fTileSize);
+            SkRect dst = SkRect::MakeXYWH((j % tiles) * fTileSize, (j / tiles) * fTileSize,
+                                          fTileSize, fTileSize);
+            fEntries.push_back(SkCanvas::ImageSetEntry(image, src, dst, 1.0f,
+                                                       SkCanvas::kNone_QuadAAFlags));
+        }
+    }
+
+    void onPerCanvasPostDraw(SkCanvas*) override { fEntries.clear(); }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        SkPaint paint;
+        for (int i = 0; i < loops; ++i) {
+            canvas->experimental_DrawEdgeAAImageSet(fEntries.data(), fEntries.size(), nullptr,
+                                                    nullptr, SkSamplingOptions(), &paint,
+                                                    SkCanvas::kFast_SrcRectConstraint);
+        }
+    }
+
+    SkISize onGetSize() override { return {kSize, kSize}; }
+
+private:
+    static constexpr int kSize = 1024;
+
+    SkString fName;
+    int fTileSize;
+    TArray<SkCanvas::ImageSetEntry> fEntries;
+
+    using INHERITED = Benchmark;
+};
+
+DEF_BENCH(return new RasterImageSetSprites(16);)
+DEF_BENCH(return new RasterImageSetSprites(64);)
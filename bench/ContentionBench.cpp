@@ -0,0 +1,137 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+#include "include/core/SkFont.h"
+#include "include/core/SkFontTypes.h"
+#include "include/core/SkTypeface.h"
+#include "src/core/SkResourceCache.h"
+#include "src/core/SkTaskGroup.h"
+#include "tools/fonts/FontToolUtils.h"
+
+#include <algorithm>
+#include <iterator>
+
+// Small, single-threaded workloads on Skia's global caches and default executor. Run on their own
+// they measure the uncontended cost; run with nanobench --benchThreads they measure how that cost
+// scales when every thread hits the same locks.
+
+namespace {
+
+static void* gContentionNamespace;
+
+struct ContentionKey : public SkResourceCache::Key {
+    explicit ContentionKey(intptr_t value) : fValue(value) {
+        this->init(&gContentionNamespace, 0, sizeof(fValue));
+    }
+
+    intptr_t fValue;
+};
+
+struct ContentionRec : public SkResourceCache::Rec {
+    explicit ContentionRec(intptr_t value) : fKey(value) {}
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override { return sizeof(*this); }
+    const char* getCategory() const override { return "contention-bench"; }
+    SkDiscardableMemory* diagnostic_only_getDiscardable() const override { return nullptr; }
+
+    static bool Visitor(const SkResourceCache::Rec&, void*) { return true; }
+
+    ContentionKey fKey;
+};
+
+// Lookups in the global SkResourceCache, which are serialized by its one mutex.
+class ResourceCacheContentionBench : public Benchmark {
+protected:
+    const char* onGetName() override { return "contention_resourcecache_find"; }
+
+    bool isSuitableFor(Backend backend) override { return backend == Backend::kNonRendering; }
+    bool isThreadSafe() const override { return true; }
+
+    void onDelayedSetup() override {
+        for (int i = 0; i < kKeyCount; i++) {
+            // Other instances may have added the key already.
+            if (!SkResourceCache::Find(ContentionKey(i), ContentionRec::Visitor, nullptr)) {
+                SkResourceCache::Add(new ContentionRec(i));
+            }
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; i++) {
+            for (int k = 0; k < kKeyCount; k++) {
+                SkResourceCache::Find(ContentionKey(k), ContentionRec::Visitor, nullptr);
+            }
+        }
+    }
+
+private:
+    static constexpr int kKeyCount = 64;
+};
+
+// Glyph metrics lookups at several sizes, each of which finds its strike in the global
+// SkStrikeCache.
+class StrikeCacheContentionBench : public Benchmark {
+protected:
+    const char* onGetName() override { return "contention_strikecache_widths"; }
+
+    bool isSuitableFor(Backend backend) override { return backend == Backend::kNonRendering; }
+    bool isThreadSafe() const override { return true; }
+
+    void onDelayedSetup() override {
+        fFont = SkFont(ToolUtils::DefaultPortableTypeface());
+        static constexpr char kText[] = "The quick brown fox jumps over the lazy dog";
+        fGlyphCount = fFont.textToGlyphs(kText, sizeof(kText) - 1, SkTextEncoding::kUTF8,
+                                         fGlyphs, std::size(fGlyphs));
+        fGlyphCount = std::min<int>(fGlyphCount, std::size(fGlyphs));
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkScalar widths[std::size(fGlyphs)];
+        for (int i = 0; i < loops; i++) {
+            for (int size = 8; size < 16; size++) {
+                fFont.setSize(size);
+                fFont.getWidths(fGlyphs, fGlyphCount, widths);
+            }
+        }
+    }
+
+private:
+    SkFont    fFont;
+    SkGlyphID fGlyphs[64];
+    int       fGlyphCount = 0;
+};
+
+// Round trips through SkExecutor::GetDefault() with tasks that do nothing, i.e. the cost of
+// handing work to the shared thread pool and waiting for it.
+class ExecutorContentionBench : public Benchmark {
+protected:
+    const char* onGetName() override { return "contention_executor_add_wait"; }
+
+    bool isSuitableFor(Backend backend) override { return backend == Backend::kNonRendering; }
+    bool isThreadSafe() const override { return true; }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; i++) {
+            SkTaskGroup group;
+            for (int t = 0; t < kTasks; t++) {
+                group.add([] {});
+            }
+            group.wait();
+        }
+    }
+
+private:
+    static constexpr int kTasks = 16;
+};
+
+}  // namespace
+
+DEF_BENCH(return new ResourceCacheContentionBench();)
+DEF_BENCH(return new StrikeCacheContentionBench();)
+DEF_BENCH(return new ExecutorContentionBench();)
@@ -0,0 +1,113 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkFont.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkPath.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkString.h"
+#include "src/core/SkDistanceFieldGen.h"
+#include "src/core/SkMask.h"
+#include "tools/fonts/FontToolUtils.h"
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#if !defined(SK_DISABLE_SDF_TEXT)
+
+static const char* gText = "Call me Ishmael.  Some years ago--never mind how long precisely";
+
+// Generates the distance fields of the glyphs of a line of large text, the way the glyphs of a
+// new SDF strike are: one at a time, or all at once spread over a thread pool.
+class DistanceFieldGenBench : public Benchmark {
+public:
+    DistanceFieldGenBench(SkScalar textSize, bool batch)
+            : fTextSize(textSize), fBatch(batch) {
+        fName.printf("distance_field_gen_%g%s", textSize, batch ? "_batch" : "");
+    }
+
+private:
+    bool isSuitableFor(Backend backend) override { return backend == Backend::kNonRendering; }
+
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        SkFont font = ToolUtils::DefaultPortableFont();
+        font.setSize(fTextSize);
+        const size_t len = strlen(gText);
+        std::vector<SkGlyphID> glyphIDs(font.countText(gText, len, SkTextEncoding::kUTF8));
+        font.textToGlyphs(gText, len, SkTextEncoding::kUTF8, glyphIDs.data(),
+                          static_cast<int>(glyphIDs.size()));
+
+        SkPaint paint;
+        paint.setAntiAlias(true);
+        for (SkGlyphID glyphID : glyphIDs) {
+            SkPath path;
+            if (!font.getPath(glyphID, &path) || path.isEmpty()) {
+                continue;
+            }
+            const SkIRect bounds = path.getBounds().roundOut();
+            SkBitmap& image = fImages.emplace_back();
+            image.allocPixels(SkImageInfo::MakeA8(bounds.width(), bounds.height()));
+            image.eraseColor(SK_ColorTRANSPARENT);
+            SkCanvas canvas(image);
+            canvas.translate(-bounds.left(), -bounds.top());
+            canvas.drawPath(path, paint);
+        }
+
+        for (const SkBitmap& image : fImages) {
+            fDistanceFields.emplace_back(SkComputeDistanceFieldSize(image.width(),
+                                                                    image.height()));
+        }
+        for (size_t i = 0; i < fImages.size(); ++i) {
+            const SkBitmap& image = fImages[i];
+            fGlyphs.push_back({fDistanceFields[i].data(),
+                               static_cast<const unsigned char*>(image.getPixels()),
+                               SkMask::kA8_Format,
+                               image.width(),
+                               image.height(),
+                               image.rowBytes()});
+        }
+        if (fBatch) {
+            fExecutor = SkExecutor::MakeFIFOThreadPool();
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int loop = 0; loop < loops; ++loop) {
+            if (fBatch) {
+                SkGenerateDistanceFields(fGlyphs, fExecutor.get());
+            } else {
+                for (const SkDistanceFieldGlyph& glyph : fGlyphs) {
+                    SkGenerateDistanceFieldFromA8Image(glyph.fDistanceField, glyph.fImage,
+                                                       glyph.fWidth, glyph.fHeight,
+                                                       glyph.fRowBytes);
+                }
+            }
+        }
+    }
+
+    const SkScalar fTextSize;
+    const bool fBatch;
+    SkString fName;
+    std::vector<SkBitmap> fImages;
+    std::vector<std::vector<unsigned char>> fDistanceFields;
+    std::vector<SkDistanceFieldGlyph> fGlyphs;
+    std::unique_ptr<SkExecutor> fExecutor;
+};
+
+DEF_BENCH(return new DistanceFieldGenBench(32, false);)
+DEF_BENCH(return new DistanceFieldGenBench(128, false);)
+DEF_BENCH(return new DistanceFieldGenBench(128, true);)
+
+#endif  // !defined(SK_DISABLE_SDF_TEXT)
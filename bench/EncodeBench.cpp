@@ -7,6 +7,7 @@
 
 #include "bench/Benchmark.h"
 #include "include/core/SkBitmap.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkStream.h"
 #include "include/encode/SkJpegEncoder.h"
 #include "include/encode/SkPngEncoder.h"
@@ -75,16 +76,23 @@ static bool encode_webp_lossless(SkWStream* dst, const SkPixmap& src) {
 static bool encode_png(SkWStream* dst,
                        const SkPixmap& src,
                        SkPngEncoder::FilterFlag filters,
-                       int zlibLevel) {
+                       int zlibLevel,
+                       SkExecutor* executor = nullptr) {
     SkPngEncoder::Options opts;
     opts.fFilterFlags = filters;
     opts.fZLibLevel = zlibLevel;
+    opts.fExecutor = executor;
     return SkPngEncoder::Encode(dst, src, opts);
 }
 
 #define PNG(FLAG, ZLIBLEVEL) [](SkWStream* d, const SkPixmap& s) { \
            return encode_png(d, s, SkPngEncoder::FilterFlag::FLAG, ZLIBLEVEL); }
 
+// Encodes on a pool of THREADS threads, to show how the parallel encoder scales.
+#define PNG_MT(THREADS) [](SkWStream* d, const SkPixmap& s) {                               \
+           static SkExecutor* executor = SkExecutor::MakeFIFOThreadPool(THREADS).release(); \
+           return encode_png(d, s, SkPngEncoder::FilterFlag::kAll, 6, executor); }
+
 static const char* srcs[2] = {"images/mandrill_512.png", "images/color_wheel.jpg"};
 
 // The Android Photos app uses a quality of 90 on JPEG encodes
@@ -122,4 +130,15 @@ DEF_BENCH(return new EncodeBench(srcs[1], PNG(kNone, 6), "PNG_6n"));
 DEF_BENCH(return new EncodeBench(srcs[1], PNG(kNone, 3), "PNG_3n"));
 DEF_BENCH(return new EncodeBench(srcs[1], PNG(kNone, 1), "PNG_1n"));
 
+DEF_BENCH(return new EncodeBench(srcs[0], PNG_MT(1), "PNG_mt1"));
+DEF_BENCH(return new EncodeBench(srcs[0], PNG_MT(2), "PNG_mt2"));
+DEF_BENCH(return new EncodeBench(srcs[0], PNG_MT(4), "PNG_mt4"));
+DEF_BENCH(return new EncodeBench(srcs[0], PNG_MT(8), "PNG_mt8"));
+
+DEF_BENCH(return new EncodeBench(srcs[1], PNG_MT(1), "PNG_mt1"));
+DEF_BENCH(return new EncodeBench(srcs[1], PNG_MT(2), "PNG_mt2"));
+DEF_BENCH(return new EncodeBench(srcs[1], PNG_MT(4), "PNG_mt4"));
+DEF_BENCH(return new EncodeBench(srcs[1], PNG_MT(8), "PNG_mt8"));
+
+#undef PNG_MT
 #undef PNG
@@ -0,0 +1,63 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+#include "include/core/SkColorFilter.h"
+#include "include/core/SkData.h"
+#include "include/core/SkImageFilter.h"
+#include "include/core/SkSerialProcs.h"
+#include "include/core/SkString.h"
+#include "include/effects/SkImageFilters.h"
+
+// Reads back a serialized image filter DAG with a mix of flattenable types, optionally trusting
+// it via SkDeserialProcs::fTrustedChecksum (which includes verifying the checksum every time).
+class FlattenableDeserializeBench : public Benchmark {
+public:
+    explicit FlattenableDeserializeBench(bool trusted) : fTrusted(trusted) {
+        fName.printf("deserialize_image_filter%s", trusted ? "_trusted" : "");
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    bool isSuitableFor(Backend backend) override { return backend == Backend::kNonRendering; }
+
+    void onDelayedSetup() override {
+        const float matrix[20] = {0.5f, 0.2f, 0.1f, 0, 0,
+                                  0.1f, 0.6f, 0.1f, 0, 0,
+                                  0.2f, 0.1f, 0.7f, 0, 0,
+                                  0,    0,    0,    1, 0};
+        sk_sp<SkImageFilter> branches[8];
+        for (int i = 0; i < 8; i++) {
+            sk_sp<SkImageFilter> filter = SkImageFilters::Blur(1.0f + i, 2.0f, nullptr);
+            filter = SkImageFilters::ColorFilter(SkColorFilters::Matrix(matrix), std::move(filter));
+            filter = SkImageFilters::DropShadow(2, 3, 4, 4, SK_ColorBLACK, std::move(filter));
+            branches[i] = SkImageFilters::Offset(i, -i, std::move(filter));
+        }
+        fData = SkImageFilters::Merge(branches, 8)->serialize();
+        if (fTrusted) {
+            fProcs.fTrustedChecksum = SkDeserialProcs::Checksum(fData->data(), fData->size());
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; i++) {
+            sk_sp<SkImageFilter> filter =
+                    SkImageFilter::Deserialize(fData->data(), fData->size(), &fProcs);
+            SkASSERT(filter);
+        }
+    }
+
+private:
+    bool            fTrusted;
+    SkString        fName;
+    sk_sp<SkData>   fData;
+    SkDeserialProcs fProcs;
+};
+
+DEF_BENCH(return new FlattenableDeserializeBench(false);)
+DEF_BENCH(return new FlattenableDeserializeBench(true);)
@@ -7,9 +7,12 @@
 
 #include "bench/Benchmark.h"
 #include "src/base/SkRandom.h"
+#include "src/base/SkSpinlock.h"
 #include "src/gpu/ganesh/GrMemoryPool.h"
 
+#include <thread>
 #include <type_traits>
+#include <vector>
 
 namespace {
 
@@ -217,3 +220,88 @@ DEF_BENCH( return new GrMemoryPoolBench("random_aligned_ref",    run_random<Alig
 DEF_BENCH( return new GrMemoryPoolBench("random_unaligned_lg",   run_random<Unaligned>,  kLargePool); )
 DEF_BENCH( return new GrMemoryPoolBench("random_unaligned_sm",   run_random<Unaligned>,  kSmallPool); )
 DEF_BENCH( return new GrMemoryPoolBench("random_unaligned_ref",  run_random<Unaligned>,  0); )
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Several threads make objects and then free them, as threads recording DDLs at the same time do
+// with processors. They share one pool behind a lock, each use a pool of their own, or use the heap.
+enum class ThreadedPool { kShared, kPerThread, kHeap };
+
+class GrMemoryPoolThreadedBench : public Benchmark {
+public:
+    GrMemoryPoolThreadedBench(const char* name, ThreadedPool mode) : fMode(mode) {
+        fName.printf("grmemorypool_threaded_%s", name);
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == Backend::kNonRendering;
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        static constexpr int kThreadCount = 4;
+        static constexpr int kMaxObjects = 4 * (1 << 10);
+
+        std::unique_ptr<GrMemoryPool> sharedPool = GrMemoryPool::Make(4096, 4096);
+        SkSpinlock sharedLock;
+        auto allocate = [&](size_t size) -> void* {
+            switch (fMode) {
+                case ThreadedPool::kShared: {
+                    SkAutoSpinlock lock(sharedLock);
+                    return sharedPool->allocate(size);
+                }
+                case ThreadedPool::kPerThread:
+                    return GrThreadMemoryPool::Allocate(size);
+                case ThreadedPool::kHeap:
+                    return new Aligned;
+            }
+            SkUNREACHABLE;
+        };
+        auto release = [&](void* p) {
+            switch (fMode) {
+                case ThreadedPool::kShared: {
+                    SkAutoSpinlock lock(sharedLock);
+                    sharedPool->release(p);
+                    break;
+                }
+                case ThreadedPool::kPerThread:
+                    GrThreadMemoryPool::Release(p);
+                    break;
+                case ThreadedPool::kHeap:
+                    delete static_cast<Aligned*>(p);
+                    break;
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < kThreadCount; ++t) {
+            threads.emplace_back([&] {
+                std::vector<void*> objs(kMaxObjects);
+                for (int i = 0; i < loops; ++i) {
+                    for (void*& obj : objs) {
+                        obj = allocate(sizeof(Aligned));
+                    }
+                    for (void* obj : objs) {
+                        release(obj);
+                    }
+                }
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+    }
+
+    SkString     fName;
+    ThreadedPool fMode;
+
+    using INHERITED = Benchmark;
+};
+
+DEF_BENCH( return new GrMemoryPoolThreadedBench("shared",     ThreadedPool::kShared); )
+DEF_BENCH( return new GrMemoryPoolThreadedBench("per_thread", ThreadedPool::kPerThread); )
+DEF_BENCH( return new GrMemoryPoolThreadedBench("ref",        ThreadedPool::kHeap); )
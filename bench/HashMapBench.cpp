@@ -0,0 +1,92 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+#include "include/core/SkString.h"
+#include "src/base/SkRandom.h"
+#include "src/core/SkTHash.h"
+#include "src/core/SkTHashGroupTable.h"
+
+#include <cstdint>
+#include <vector>
+
+using namespace skia_private;
+
+// Compares lookups in THashMap (linear probing) and THashGroupMap (SIMD group probing).  Half
+// of the lookups hit and half miss, in random order.  The key kinds mimic real users:
+//   - ids:    scattered 32-bit unique IDs, as in SkPictureData's dedup maps.
+//   - glyphs: small, dense packed glyph IDs, as in SkStrike's glyph maps.
+//   - names:  short strings, as in SkPDF's resource maps.
+enum class Keys { kIDs, kGlyphs, kNames };
+
+template <typename K> static K make_key(Keys, uint32_t);
+
+template <> uint32_t make_key<uint32_t>(Keys keys, uint32_t i) {
+    return keys == Keys::kIDs ? SkRandom(i).nextU() : i;
+}
+
+template <> SkString make_key<SkString>(Keys, uint32_t i) {
+    return SkStringPrintf("/Resource%u", i);
+}
+
+template <typename K, typename Map>
+class HashMapBench : public Benchmark {
+public:
+    HashMapBench(const char* table, Keys keys, int count) : fKeys(keys), fCount(count) {
+        static const char* kKeyNames[] = {"ids", "glyphs", "names"};
+        fName.printf("hashmap_%s_%s_%d", table, kKeyNames[(int)keys], count);
+    }
+
+protected:
+    bool isSuitableFor(Backend backend) override { return backend == Backend::kNonRendering; }
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        for (int i = 0; i < fCount; i++) {
+            fMap.set(make_key<K>(fKeys, 2 * i), i);
+        }
+        // Odd keys were never added, so half of these lookups miss.
+        SkRandom rand;
+        for (int i = 0; i < 2 * fCount; i++) {
+            fQueries.push_back(make_key<K>(fKeys, rand.nextULessThan(2 * fCount)));
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        int found = 0;
+        for (int loop = 0; loop < loops; loop++) {
+            for (const K& key : fQueries) {
+                if (const int* val = fMap.find(key)) {
+                    found += *val;
+                }
+            }
+        }
+        fFound = found;
+    }
+
+private:
+    Keys           fKeys;
+    int            fCount;
+    SkString       fName;
+    Map            fMap;
+    std::vector<K> fQueries;
+    volatile int   fFound = 0;
+};
+
+#define DEF_HASHMAP_BENCHES(K, keys, count)                                                   \
+    DEF_BENCH(return (new HashMapBench<K, THashMap<K, int>>("linear", keys, count));)        \
+    DEF_BENCH(return (new HashMapBench<K, THashGroupMap<K, int>>("group", keys, count));)
+
+DEF_HASHMAP_BENCHES(uint32_t, Keys::kIDs,       64)
+DEF_HASHMAP_BENCHES(uint32_t, Keys::kIDs,     4096)
+DEF_HASHMAP_BENCHES(uint32_t, Keys::kIDs,   262144)
+DEF_HASHMAP_BENCHES(uint32_t, Keys::kGlyphs,   256)
+DEF_HASHMAP_BENCHES(uint32_t, Keys::kGlyphs, 16384)
+DEF_HASHMAP_BENCHES(SkString, Keys::kNames,     64)
+DEF_HASHMAP_BENCHES(SkString, Keys::kNames,   4096)
+
+#undef DEF_HASHMAP_BENCHES
@@ -0,0 +1,65 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+#include "bench/GpuTools.h"
+#include "include/core/SkBlendMode.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkSurface.h"
+
+/**
+ * Draws a grid of cells, each of which draws a small rect with each of kKinds blend modes, none of
+ * them overlapping. Ops with different blend modes can't be combined, so each cell leaves kKinds
+ * op chains, and each rect could join the chain of the same blend mode in the cell before it,
+ * kKinds chains back. With the default op chain lookback of 10 that is out of reach, and each rect
+ * is its own draw. Run with --opsTaskReorderLookback 100, and with --gpuStats to see the number of
+ * draws.
+ */
+class InterleavedDrawsBench : public Benchmark {
+    static constexpr int kKinds = 12;
+    static constexpr int kCells = 16;
+    static constexpr float kCellSize = 48;
+
+    const char* onGetName() override { return "InterleavedDraws"; }
+
+    bool isSuitableFor(Backend backend) override { return Backend::kGanesh == backend; }
+
+    SkISize onGetSize() override {
+        return {static_cast<int>(kCells * kCellSize), static_cast<int>(kCells * kCellSize)};
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        static constexpr SkBlendMode kModes[kKinds] = {
+                SkBlendMode::kSrcOver, SkBlendMode::kScreen,  SkBlendMode::kPlus,
+                SkBlendMode::kModulate, SkBlendMode::kSrcATop, SkBlendMode::kDstOver,
+                SkBlendMode::kXor,     SkBlendMode::kSrcIn,   SkBlendMode::kDstIn,
+                SkBlendMode::kSrcOut,  SkBlendMode::kDstOut,  SkBlendMode::kDstATop};
+        static constexpr float kKindSize = kCellSize / 4;
+        SkPaint paint;
+        paint.setColor(SK_ColorBLUE);
+        for (int loop = 0; loop < loops; ++loop) {
+            for (int y = 0; y < kCells; ++y) {
+                for (int x = 0; x < kCells; ++x) {
+                    for (int kind = 0; kind < kKinds; ++kind) {
+                        paint.setBlendMode(kModes[kind]);
+                        canvas->drawRect(SkRect::MakeXYWH(x * kCellSize + (kind % 4) * kKindSize,
+                                                          y * kCellSize + (kind / 4) * kKindSize,
+                                                          kKindSize - 1, kKindSize - 1),
+                                         paint);
+                    }
+                }
+            }
+            // Each loop is its own flush, so that ops are not combined across loops.
+            skgpu::Flush(canvas->getSurface());
+        }
+    }
+};
+
+DEF_BENCH(return new InterleavedDrawsBench();)
@@ -6,8 +6,10 @@
  */
 #include "bench/Benchmark.h"
 #include "include/core/SkMatrix.h"
+#include "include/core/SkPoint3.h"
 #include "include/core/SkString.h"
 #include "src/base/SkRandom.h"
+#include "src/core/SkMatrixPriv.h"
 #include "src/core/SkMatrixUtils.h"
 
 class MatrixBench : public Benchmark {
@@ -198,6 +200,7 @@ DEF_BENCH( return new InvertMapRectMatrixBench(
 static SkMatrix make_trans() { return SkMatrix::Translate(2, 3); }
 static SkMatrix make_scale() { SkMatrix m(make_trans()); m.postScale(1.5f, 0.5f); return m; }
 static SkMatrix make_afine() { SkMatrix m(make_trans()); m.postRotate(15); return m; }
+static SkMatrix make_persp() { SkMatrix m(make_afine()); m.setPerspX(0.001f); return m; }
 
 class MapPointsMatrixBench : public MatrixBench {
 protected:
@@ -226,6 +229,21 @@ DEF_BENCH( return new MapPointsMatrixBench("mappoints_identity", SkMatrix::I());
 DEF_BENCH( return new MapPointsMatrixBench("mappoints_trans", make_trans()); )
 DEF_BENCH( return new MapPointsMatrixBench("mappoints_scale", make_scale()); )
 DEF_BENCH( return new MapPointsMatrixBench("mappoints_affine", make_afine()); )
+DEF_BENCH( return new MapPointsMatrixBench("mappoints_persp", make_persp()); )
+
+class MapHomogeneousPointsMatrixBench : public MapPointsMatrixBench {
+    SkPoint3 fDst3[N];
+public:
+    MapHomogeneousPointsMatrixBench(const char name[], const SkMatrix& m)
+        : MapPointsMatrixBench(name, m) {}
+
+    void performTest() override {
+        for (int i = 0; i < 1000000; ++i) {
+            fM.mapHomogeneousPoints(fDst3, fSrc, N);
+        }
+    }
+};
+DEF_BENCH( return new MapHomogeneousPointsMatrixBench("maphomogeneous_persp", make_persp()); )
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -260,3 +278,24 @@ public:
 };
 DEF_BENCH( return new MapRectMatrixBench("maprect", false); )
 DEF_BENCH( return new MapRectMatrixBench("maprectscaletrans", true); )
+
+class MapRectsMatrixBench : public MatrixBench {
+    SkMatrix fM;
+    enum { N = 32 };
+    SkRect fSrc[N], fDst[N];
+public:
+    MapRectsMatrixBench(const char name[], const SkMatrix& m) : MatrixBench(name), fM(m) {
+        SkRandom rand;
+        for (int i = 0; i < N; ++i) {
+            fSrc[i] = SkRect::MakeXYWH(rand.nextSScalar1(), rand.nextSScalar1(),
+                                       rand.nextUScalar1(), rand.nextUScalar1());
+        }
+    }
+
+    void performTest() override {
+        for (int i = 0; i < 100000; ++i) {
+            SkMatrixPriv::MapRects(fM, fDst, fSrc, N);
+        }
+    }
+};
+DEF_BENCH( return new MapRectsMatrixBench("maprects_affine", make_afine()); )
@@ -14,6 +14,7 @@
 #include "include/core/SkPath.h"
 #include "include/core/SkPixmap.h"
 #include "include/core/SkStream.h"
+#include "include/core/SkString.h"
 #include "include/effects/SkGradientShader.h"
 #include "include/private/base/SkTo.h"
 #include "src/base/SkRandom.h"
@@ -79,6 +80,7 @@ DEF_BENCH(return new PDFScalarBench("PDFScalar_random", next_any);)
 
 #ifdef SK_SUPPORT_PDF
 
+#include "src/pdf/SkDeflate.h"
 #include "src/pdf/SkPDFBitmap.h"
 #include "src/pdf/SkPDFDocumentPriv.h"
 #include "src/pdf/SkPDFShader.h"
@@ -188,6 +190,57 @@ private:
     std::unique_ptr<SkStreamAsset> fAsset;
 };
 
+/** Deflates 1 MiB of PDF content stream per loop, so the time per loop in ms is the inverse
+    of the throughput in MiB/ms. Compares writing through an SkDeflateWStream with compressing
+    the whole buffer at once, for each strategy. */
+class PDFDeflateBench : public Benchmark {
+public:
+    PDFDeflateBench(bool wholeBuffer,
+                    SkDeflateWStream::Strategy strategy,
+                    const char* strategyName)
+            : fWholeBuffer(wholeBuffer), fStrategy(strategy) {
+        fName.printf("PDFDeflate_%s_%s", wholeBuffer ? "buffer" : "stream", strategyName);
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+    bool isSuitableFor(Backend backend) override {
+        return backend == Backend::kNonRendering;
+    }
+    void onDelayedSetup() override {
+        sk_sp<SkData> commands = GetResourceAsData("pdf_command_stream.txt");
+        if (!commands || commands->isEmpty()) {
+            return;
+        }
+        constexpr size_t kSize = 1 << 20;
+        fData = SkData::MakeUninitialized(kSize);
+        auto dst = static_cast<uint8_t*>(fData->writable_data());
+        for (size_t i = 0; i < kSize; i += commands->size()) {
+            memcpy(dst + i, commands->data(), std::min(commands->size(), kSize - i));
+        }
+    }
+    void onDraw(int loops, SkCanvas*) override {
+        SkASSERT(fData);
+        if (!fData) { return; }
+        while (loops-- > 0) {
+            if (fWholeBuffer) {
+                SkMemoryStream stream(fData);
+                (void)SkDeflateWStream::Compress(&stream, -1, fStrategy);
+            } else {
+                SkNullWStream wStream;
+                SkDeflateWStream deflateWStream(&wStream, -1, false, fStrategy);
+                deflateWStream.write(fData->data(), fData->size());
+            }
+        }
+    }
+
+private:
+    const bool fWholeBuffer;
+    const SkDeflateWStream::Strategy fStrategy;
+    SkString fName;
+    sk_sp<SkData> fData;
+};
+
 struct PDFColorComponentBench : public Benchmark {
     bool isSuitableFor(Backend b) override {
         return b == Backend::kNonRendering;
@@ -310,6 +363,11 @@ struct PDFClipPathBenchmark : public Benchmark {
 DEF_BENCH(return new PDFImageBench;)
 DEF_BENCH(return new PDFJpegImageBench;)
 DEF_BENCH(return new PDFCompressionBench;)
+DEF_BENCH(return new PDFDeflateBench(false, SkDeflateWStream::Strategy::kDefault, "default");)
+DEF_BENCH(return new PDFDeflateBench(true, SkDeflateWStream::Strategy::kDefault, "default");)
+DEF_BENCH(return new PDFDeflateBench(true, SkDeflateWStream::Strategy::kFiltered, "filtered");)
+DEF_BENCH(return new PDFDeflateBench(true, SkDeflateWStream::Strategy::kHuffmanOnly, "huffman");)
+DEF_BENCH(return new PDFDeflateBench(true, SkDeflateWStream::Strategy::kRLE, "rle");)
 DEF_BENCH(return new PDFColorComponentBench;)
 DEF_BENCH(return new PDFShaderBench;)
 DEF_BENCH(return new WritePDFTextBenchmark;)
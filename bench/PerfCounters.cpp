@@ -0,0 +1,228 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/PerfCounters.h"
+
+#include "include/core/SkTypes.h"
+
+#include <limits>
+
+#if defined(__linux__)
+    #include <linux/perf_event.h>
+    #include <sys/ioctl.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+    #include <cstring>
+#elif defined(SK_BUILD_FOR_MAC)
+    #include <dlfcn.h>
+    #include <algorithm>
+#endif
+
+const char* PerfCounters::Name(Counter c) {
+    switch (c) {
+        case kCycles:       return "cycles";
+        case kInstructions: return "instructions";
+        case kCacheMisses:  return "cache_misses";
+        case kBranchMisses: return "branch_misses";
+    }
+    SkUNREACHABLE;
+}
+
+void PerfCounters::stop() {
+    uint64_t counts[kCounterCount] = {};
+    this->onStop(counts);
+    for (int i = 0; i < kCounterCount; ++i) {
+        fTotals[i] += counts[i];
+    }
+}
+
+void PerfCounters::reset() {
+    for (uint64_t& total : fTotals) {
+        total = 0;
+    }
+}
+
+double PerfCounters::total(Counter c) const {
+    return fSupported[c] ? static_cast<double>(fTotals[c])
+                         : std::numeric_limits<double>::quiet_NaN();
+}
+
+#if defined(__linux__)
+
+namespace {
+
+// Counts the events as one perf_event group, so they are all scheduled on the PMU together and
+// describe the same instructions.
+class PerfEventCounters final : public PerfCounters {
+public:
+    static std::unique_ptr<PerfCounters> Make() {
+        static constexpr uint64_t kConfigs[kCounterCount] = {
+            PERF_COUNT_HW_CPU_CYCLES,
+            PERF_COUNT_HW_INSTRUCTIONS,
+            PERF_COUNT_HW_CACHE_MISSES,
+            PERF_COUNT_HW_BRANCH_MISSES,
+        };
+
+        std::unique_ptr<PerfEventCounters> counters(new PerfEventCounters);
+        for (int i = 0; i < kCounterCount; ++i) {
+            perf_event_attr attr;
+            memset(&attr, 0, sizeof(attr));
+            attr.size           = sizeof(attr);
+            attr.type           = PERF_TYPE_HARDWARE;
+            attr.config         = kConfigs[i];
+            attr.read_format    = PERF_FORMAT_GROUP;
+            attr.disabled       = counters->fLeader < 0;  // Members follow the leader.
+            attr.exclude_kernel = 1;
+            attr.exclude_hv     = 1;
+
+            // Not every PMU (or VM) has every event, so skip those that fail to open.
+            const int fd = syscall(SYS_perf_event_open, &attr, /*pid=*/0, /*cpu=*/-1,
+                                   counters->fLeader, /*flags=*/0);
+            if (fd < 0) {
+                continue;
+            }
+            if (counters->fLeader < 0) {
+                counters->fLeader = fd;
+            }
+            counters->fFDs[i] = fd;
+            counters->fSupported[i] = true;
+            counters->fGroupIndex[i] = counters->fGroupSize++;
+        }
+
+        if (counters->fLeader < 0) {
+            return nullptr;
+        }
+        return counters;
+    }
+
+    ~PerfEventCounters() override {
+        for (int fd : fFDs) {
+            if (fd >= 0) {
+                close(fd);
+            }
+        }
+    }
+
+private:
+    PerfEventCounters() {
+        for (int i = 0; i < kCounterCount; ++i) {
+            fFDs[i] = -1;
+            fGroupIndex[i] = -1;
+        }
+    }
+
+    void onStart() override {
+        ioctl(fLeader, PERF_EVENT_IOC_RESET,  PERF_IOC_FLAG_GROUP);
+        ioctl(fLeader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+
+    void onStop(uint64_t counts[kCounterCount]) override {
+        ioctl(fLeader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+        // With PERF_FORMAT_GROUP, the leader reads as { nr, values[nr] } in the order the
+        // events joined the group.
+        uint64_t buffer[1 + kCounterCount];
+        const ssize_t bytes = read(fLeader, buffer, sizeof(buffer));
+        if (bytes < static_cast<ssize_t>(sizeof(uint64_t) * (1 + fGroupSize)) ||
+            buffer[0] != static_cast<uint64_t>(fGroupSize)) {
+            return;
+        }
+        for (int i = 0; i < kCounterCount; ++i) {
+            if (fGroupIndex[i] >= 0) {
+                counts[i] = buffer[1 + fGroupIndex[i]];
+            }
+        }
+    }
+
+    int fFDs[kCounterCount];
+    int fGroupIndex[kCounterCount];
+    int fGroupSize = 0;
+    int fLeader = -1;
+};
+
+}  // namespace
+
+std::unique_ptr<PerfCounters> PerfCounters::Make() { return PerfEventCounters::Make(); }
+
+#elif defined(SK_BUILD_FOR_MAC)
+
+namespace {
+
+// kperf is a private framework, so it's loaded at runtime. Only its fixed counters, cycles and
+// instructions, are used; the configurable ones would need the kperfdata event database.
+class KPerfCounters final : public PerfCounters {
+public:
+    static std::unique_ptr<PerfCounters> Make() {
+        void* kperf = dlopen("/System/Library/PrivateFrameworks/kperf.framework/kperf", RTLD_LAZY);
+        if (!kperf) {
+            return nullptr;
+        }
+
+        std::unique_ptr<KPerfCounters> counters(new KPerfCounters);
+        auto set_counting        = (int(*)(uint32_t))dlsym(kperf, "kpc_set_counting");
+        auto set_thread_counting = (int(*)(uint32_t))dlsym(kperf, "kpc_set_thread_counting");
+        auto get_counter_count   = (uint32_t(*)(uint32_t))dlsym(kperf, "kpc_get_counter_count");
+        counters->fGetThreadCounters =
+                (int(*)(uint32_t, uint32_t, uint64_t*))dlsym(kperf, "kpc_get_thread_counters");
+        if (!set_counting || !set_thread_counting || !get_counter_count ||
+            !counters->fGetThreadCounters) {
+            return nullptr;
+        }
+
+        // These fail without root.
+        if (set_counting(kFixedClassMask) || set_thread_counting(kFixedClassMask)) {
+            return nullptr;
+        }
+        counters->fCount = get_counter_count(kFixedClassMask);
+        if (counters->fCount <= std::max(kCyclesIndex, kInstructionsIndex) ||
+            counters->fCount > kMaxCounters) {
+            return nullptr;
+        }
+
+        counters->fSupported[kCycles]       = true;
+        counters->fSupported[kInstructions] = true;
+        return counters;
+    }
+
+private:
+    static constexpr uint32_t kFixedClassMask = 1 << 0;  // KPC_CLASS_FIXED_MASK
+    static constexpr uint32_t kMaxCounters = 32;
+#if defined(SK_CPU_ARM64)
+    static constexpr uint32_t kCyclesIndex = 0, kInstructionsIndex = 1;
+#else
+    static constexpr uint32_t kCyclesIndex = 1, kInstructionsIndex = 0;
+#endif
+
+    KPerfCounters() = default;
+
+    void onStart() override {
+        fGetThreadCounters(0, fCount, fStart);
+    }
+
+    void onStop(uint64_t counts[kCounterCount]) override {
+        uint64_t end[kMaxCounters];
+        if (fGetThreadCounters(0, fCount, end)) {
+            return;
+        }
+        counts[kCycles]       = end[kCyclesIndex]       - fStart[kCyclesIndex];
+        counts[kInstructions] = end[kInstructionsIndex] - fStart[kInstructionsIndex];
+    }
+
+    int (*fGetThreadCounters)(uint32_t, uint32_t, uint64_t*) = nullptr;
+    uint32_t fCount = 0;
+    uint64_t fStart[kMaxCounters] = {};
+};
+
+}  // namespace
+
+std::unique_ptr<PerfCounters> PerfCounters::Make() { return KPerfCounters::Make(); }
+
+#else
+
+std::unique_ptr<PerfCounters> PerfCounters::Make() { return nullptr; }
+
+#endif
@@ -0,0 +1,64 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef PerfCounters_DEFINED
+#define PerfCounters_DEFINED
+
+#include <cstdint>
+#include <memory>
+
+/**
+ *  Hardware performance counters for the calling thread, read through perf_event on Linux and
+ *  Android, and through the private kperf framework on macOS (which needs root). Work done on
+ *  other threads, e.g. by a thread pool, is not counted.
+ *
+ *  Counts from each start()/stop() pair add up until reset().
+ */
+class PerfCounters {
+public:
+    enum Counter {
+        kCycles,
+        kInstructions,
+        kCacheMisses,
+        kBranchMisses,
+
+        kLast = kBranchMisses
+    };
+    static constexpr int kCounterCount = kLast + 1;
+
+    // The counter's name in nanobench's results.
+    static const char* Name(Counter);
+
+    // Returns null if none of the counters can be read on this system, or by this process.
+    static std::unique_ptr<PerfCounters> Make();
+
+    virtual ~PerfCounters() = default;
+
+    // Not every system has every counter; kperf for instance only exposes cycles and instructions.
+    bool has(Counter c) const { return fSupported[c]; }
+
+    void start() { this->onStart(); }
+    void stop();
+    void reset();
+
+    // Returns the counted events, or NaN if the counter isn't supported.
+    double total(Counter) const;
+
+protected:
+    PerfCounters() = default;
+
+    virtual void onStart() = 0;
+    // Sets |counts| to the events counted since onStart(), for the supported counters.
+    virtual void onStop(uint64_t counts[kCounterCount]) = 0;
+
+    bool fSupported[kCounterCount] = {};
+
+private:
+    uint64_t fTotals[kCounterCount] = {};
+};
+
+#endif  // PerfCounters_DEFINED
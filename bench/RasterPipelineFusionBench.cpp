@@ -0,0 +1,182 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkPaint.h"
+#include "include/effects/SkRuntimeEffect.h"
+#include "src/core/SkRasterPipeline.h"
+#include "src/core/SkRasterPipelineOpContexts.h"
+#include "src/core/SkRasterPipelineOpList.h"
+
+#include <algorithm>
+#include <functional>
+#include <string>
+
+extern bool gDisableRasterPipelineStageFusion;
+
+// Measures the fused stages SkRasterPipeline swaps in for common blits against running the
+// same pipelines one stage at a time. Each pipeline ends with load_8888_dst, srcover, store_8888.
+enum class FusionPipeline {
+    kSrcOver8888,        // load_8888
+    kSwapRBSrcOver8888,  // load_8888, swap_rb
+    kBilerpSrcOver8888,  // seed_shader, matrix_2x3, bilerp_clamp_8888
+};
+
+static const char* fusion_pipeline_name(FusionPipeline p) {
+    switch (p) {
+        case FusionPipeline::kSrcOver8888:       return "srcover_8888";
+        case FusionPipeline::kSwapRBSrcOver8888: return "swap_rb_srcover_8888";
+        case FusionPipeline::kBilerpSrcOver8888: return "bilerp_srcover_8888";
+        default:                                 SkUNREACHABLE;
+    }
+}
+
+class RasterPipelineFusionBench : public Benchmark {
+public:
+    RasterPipelineFusionBench(FusionPipeline pipeline, bool fused)
+            : fKind(pipeline), fFused(fused) {
+        fName = std::string("RasterPipelineFusion_") + fusion_pipeline_name(fKind) +
+                (fFused ? "_fused" : "_unfused");
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    bool isSuitableFor(Backend backend) override { return backend == Backend::kNonRendering; }
+
+    void onDelayedSetup() override {
+        // Half-transparent source pixels over opaque destination pixels.
+        std::fill(std::begin(fSrcPixels), std::end(fSrcPixels), 0x80402010);
+        std::fill(std::begin(fDstPixels), std::end(fDstPixels), 0xFF204080);
+
+        fSrcCtx = SkRasterPipeline_MemoryCtx{fSrcPixels, kWidth};
+        fDstCtx = SkRasterPipeline_MemoryCtx{fDstPixels, kWidth};
+        fGatherCtx.pixels = fSrcPixels;
+        fGatherCtx.stride = kWidth;
+        fGatherCtx.width  = kWidth;
+        fGatherCtx.height = kHeight;
+
+        using Op = SkRasterPipelineOp;
+        switch (fKind) {
+            case FusionPipeline::kSrcOver8888:
+                fPipeline.append(Op::load_8888, &fSrcCtx);
+                break;
+            case FusionPipeline::kSwapRBSrcOver8888:
+                fPipeline.append(Op::load_8888, &fSrcCtx);
+                fPipeline.append(Op::swap_rb);
+                break;
+            case FusionPipeline::kBilerpSrcOver8888:
+                fPipeline.append(Op::seed_shader);
+                fPipeline.append(Op::matrix_2x3, fMatrix);
+                fPipeline.append(Op::bilerp_clamp_8888, &fGatherCtx);
+                break;
+        }
+        fPipeline.append(Op::load_8888_dst, &fDstCtx);
+        fPipeline.append(Op::srcover);
+        fPipeline.append(Op::store_8888, &fDstCtx);
+
+        // Fusion happens when the pipeline is compiled.
+        gDisableRasterPipelineStageFusion = !fFused;
+        fCompiled = fPipeline.compile();
+        gDisableRasterPipelineStageFusion = false;
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; i++) {
+            for (int y = 0; y < kHeight; ++y) {
+                fCompiled(0, y, kWidth, 1);
+            }
+        }
+    }
+
+private:
+    static constexpr int kWidth = 256;
+    static constexpr int kHeight = 256;
+
+    FusionPipeline fKind;
+    bool fFused;
+    std::string fName;
+
+    SkRasterPipeline_<256> fPipeline;
+    SkRasterPipeline_MemoryCtx fSrcCtx;
+    SkRasterPipeline_MemoryCtx fDstCtx;
+    SkRasterPipeline_GatherCtx fGatherCtx;
+    float fMatrix[6] = {0.9f, 0.1f, 3.5f, -0.1f, 0.9f, 7.25f};
+    uint32_t fSrcPixels[kWidth * kHeight];
+    uint32_t fDstPixels[kWidth * kHeight];
+
+    std::function<void(size_t, size_t, size_t, size_t)> fCompiled;
+};
+
+DEF_BENCH(return new RasterPipelineFusionBench(FusionPipeline::kSrcOver8888, true);)
+DEF_BENCH(return new RasterPipelineFusionBench(FusionPipeline::kSrcOver8888, false);)
+DEF_BENCH(return new RasterPipelineFusionBench(FusionPipeline::kSwapRBSrcOver8888, true);)
+DEF_BENCH(return new RasterPipelineFusionBench(FusionPipeline::kSwapRBSrcOver8888, false);)
+DEF_BENCH(return new RasterPipelineFusionBench(FusionPipeline::kBilerpSrcOver8888, true);)
+DEF_BENCH(return new RasterPipelineFusionBench(FusionPipeline::kBilerpSrcOver8888, false);)
+
+// Measures the fused stages for SkSL arithmetic on pushed operands, by filling a bitmap with a
+// runtime shader that does a lot of it.
+class RasterPipelineFusionSkSLBench : public Benchmark {
+public:
+    explicit RasterPipelineFusionSkSLBench(bool fused) : fFused(fused) {
+        fName = std::string("RasterPipelineFusion_sksl") + (fFused ? "_fused" : "_unfused");
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    bool isSuitableFor(Backend backend) override { return backend == Backend::kNonRendering; }
+
+    void onDelayedSetup() override {
+        sk_sp<SkRuntimeEffect> effect = SkRuntimeEffect::MakeForShader(SkString(R"(
+            uniform float2 center;
+            uniform float scale;
+            uniform half4 colorA;
+            uniform half4 colorB;
+            half4 main(float2 p) {
+                float2 d = (p - center) * scale;
+                float t = d.x * d.x + d.y * d.y;
+                t = t / (t + scale) - scale * 0.25;
+                float2 w = d * t + center / scale;
+                return mix(colorA, colorB, half(fract(w.x - w.y))) * colorA.a;
+            }
+        )")).effect;
+        SkASSERT(effect);
+        SkRuntimeShaderBuilder builder(effect);
+        builder.uniform("center") = SkV2{kSize * 0.5f, kSize * 0.4f};
+        builder.uniform("scale") = 0.05f;
+        builder.uniform("colorA") = SkV4{1.f, 0.5f, 0.25f, 1.f};
+        builder.uniform("colorB") = SkV4{0.f, 0.25f, 1.f, 1.f};
+        fPaint.setShader(builder.makeShader());
+
+        fBitmap.allocN32Pixels(kSize, kSize);
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        // Fusion happens when the blitter compiles the shader's pipeline, on every draw.
+        gDisableRasterPipelineStageFusion = !fFused;
+        SkCanvas canvas(fBitmap);
+        for (int i = 0; i < loops; i++) {
+            canvas.drawPaint(fPaint);
+        }
+        gDisableRasterPipelineStageFusion = false;
+    }
+
+private:
+    static constexpr int kSize = 256;
+
+    bool fFused;
+    std::string fName;
+    SkPaint fPaint;
+    SkBitmap fBitmap;
+};
+
+DEF_BENCH(return new RasterPipelineFusionSkSLBench(true);)
+DEF_BENCH(return new RasterPipelineFusionSkSLBench(false);)
@@ -10,6 +10,8 @@
 #include "include/core/SkBitmap.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColorSpace.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkGraphics.h"
 
 // Time variants of read-pixels
 //  [ colortype ][ alphatype ][ colorspace ]
@@ -101,6 +103,56 @@ private:
 DEF_BENCH( return new PixmapOrientBench(); )
 
 
+// Converts a 4K F16 Display P3 image to 8888 sRGB, either on the calling thread or in bands on a
+// pool of the given number of threads, to measure how SetParallelPixelConversion() scales.
+class ConvertPixelsBench : public Benchmark {
+public:
+    explicit ConvertPixelsBench(int threads) : fThreads(threads) {
+        fName.printf("convertpix_f16_p3_to_8888_srgb_threads%d", threads);
+    }
+
+protected:
+    void onDelayedSetup() override {
+        const auto p3 = SkColorSpace::MakeRGB(SkNamedTransferFn::kSRGB, SkNamedGamut::kDisplayP3);
+        fSrc.allocPixels(SkImageInfo::Make(3840, 2160, kRGBA_F16_SkColorType,
+                                           kPremul_SkAlphaType, p3));
+        fSrc.eraseColor(SkColor4f{0.25f, 0.5f, 0.75f, 1.0f});
+        fDst.allocPixels(fSrc.info().makeColorType(kRGBA_8888_SkColorType)
+                                    .makeColorSpace(SkColorSpace::MakeSRGB()));
+        if (fThreads > 0) {
+            fExecutor = SkExecutor::MakeFIFOThreadPool(fThreads);
+        }
+    }
+
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == Backend::kNonRendering;
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkGraphics::SetParallelPixelConversion(fExecutor.get(), 0);
+        for (int i = 0; i < loops; ++i) {
+            fSrc.readPixels(fDst.pixmap());
+        }
+        SkGraphics::SetParallelPixelConversion(nullptr);
+    }
+
+private:
+    const int fThreads;
+    std::unique_ptr<SkExecutor> fExecutor;
+    SkBitmap fSrc, fDst;
+    SkString fName;
+
+    using INHERITED = Benchmark;
+};
+DEF_BENCH( return new ConvertPixelsBench(0); )
+DEF_BENCH( return new ConvertPixelsBench(2); )
+DEF_BENCH( return new ConvertPixelsBench(4); )
+DEF_BENCH( return new ConvertPixelsBench(8); )
+
 class GetAlphafBench : public Benchmark {
     SkString fName;
     SkColorType fCT;
@@ -8,8 +8,12 @@
 #include "bench/RecordingBench.h"
 
 #include "include/core/SkBBHFactory.h"
+#include "include/core/SkCanvas.h"
 #include "include/core/SkData.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkPath.h"
 #include "include/core/SkPictureRecorder.h"
+#include "include/core/SkRRect.h"
 
 PictureCentricBench::PictureCentricBench(const char* name, const SkPicture* pic) : fName(name) {
     // Flatten the source picture in case it's trivially nested (useless for timing).
@@ -34,27 +38,62 @@ SkISize PictureCentricBench::onGetSize() {
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
-RecordingBench::RecordingBench(const char* name, const SkPicture* pic, bool useBBH)
+RecordingBench::RecordingBench(const char* name, const SkPicture* pic, bool useBBH,
+                               bool recycleStorage)
     : INHERITED(name, pic)
     , fUseBBH(useBBH)
+    , fRecycleStorage(recycleStorage)
 {}
 
 void RecordingBench::onDraw(int loops, SkCanvas*) {
     SkRTreeFactory factory;
     SkPictureRecorder recorder;
+    recorder.setRecycleStorage(fRecycleStorage);
     while (loops --> 0) {
         fSrc->playback(recorder.beginRecording(fSrc->cullRect(), fUseBBH ? &factory : nullptr));
         (void)recorder.finishRecordingAsPicture();
     }
 }
 
+// A stand-in for one frame of UI: many small, mostly translucent draws under nested clips.
+static sk_sp<SkPicture> make_frame_picture() {
+    SkPictureRecorder recorder;
+    SkCanvas* canvas = recorder.beginRecording(1024, 1024);
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    for (int row = 0; row < 32; row++) {
+        canvas->save();
+        canvas->clipRect(SkRect::MakeXYWH(0, row * 32, 1024, 32));
+        for (int col = 0; col < 32; col++) {
+            canvas->save();
+            canvas->translate(col * 32, row * 32);
+            paint.setColor(SkColorSetARGB(0x80, row * 8, col * 8, 0x40));
+            canvas->drawRect(SkRect::MakeWH(30, 30), paint);
+            canvas->drawRRect(SkRRect::MakeRectXY(SkRect::MakeXYWH(4, 4, 22, 22), 4, 4), paint);
+            canvas->drawPath(SkPath::Circle(15, 15, 6), paint);
+            canvas->restore();
+        }
+        canvas->restore();
+    }
+    return recorder.finishRecordingAsPicture();
+}
+
+DEF_BENCH(return new RecordingBench("recording_frame", make_frame_picture().get(), false);)
+DEF_BENCH(return new RecordingBench("recording_frame_recycle", make_frame_picture().get(), false,
+                                    true);)
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
-#include "include/core/SkSerialProcs.h"
 
-DeserializePictureBench::DeserializePictureBench(const char* name, sk_sp<SkData> data)
+DeserializePictureBench::DeserializePictureBench(const char* name, sk_sp<SkData> data,
+                                                 bool trusted)
     : fName(name)
     , fEncodedPicture(std::move(data))
-{}
+{
+    if (trusted && fEncodedPicture) {
+        fProcs.fTrustedChecksum =
+                SkDeserialProcs::Checksum(fEncodedPicture->data(), fEncodedPicture->size());
+    }
+}
 
 const char* DeserializePictureBench::onGetName() {
     return fName.c_str();
@@ -70,6 +109,11 @@ SkISize DeserializePictureBench::onGetSize() {
 
 void DeserializePictureBench::onDraw(int loops, SkCanvas*) {
     for (int i = 0; i < loops; ++i) {
-        SkPicture::MakeFromData(fEncodedPicture.get());
+        SkPicture::MakeFromData(fEncodedPicture.get(), &fProcs);
     }
 }
+
+DEF_BENCH(return new DeserializePictureBench("deserialize_frame",
+                                             make_frame_picture()->serialize());)
+DEF_BENCH(return new DeserializePictureBench("deserialize_frame_trusted",
+                                             make_frame_picture()->serialize(), true);)
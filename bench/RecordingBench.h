@@ -10,6 +10,7 @@
 
 #include "bench/Benchmark.h"
 #include "include/core/SkPicture.h"
+#include "include/core/SkSerialProcs.h"
 
 class PictureCentricBench : public Benchmark {
 public:
@@ -29,20 +30,22 @@ protected:
 
 class RecordingBench : public PictureCentricBench {
 public:
-    RecordingBench(const char* name, const SkPicture*, bool useBBH);
+    RecordingBench(const char* name, const SkPicture*, bool useBBH, bool recycleStorage = false);
 
 protected:
     void onDraw(int loops, SkCanvas*) override;
 
 private:
     bool fUseBBH;
+    bool fRecycleStorage;
 
     using INHERITED = PictureCentricBench;
 };
 
 class DeserializePictureBench : public Benchmark {
 public:
-    DeserializePictureBench(const char* name, sk_sp<SkData> encodedPicture);
+    // If trusted, the picture is read with SkDeserialProcs::fTrustedChecksum set.
+    DeserializePictureBench(const char* name, sk_sp<SkData> encodedPicture, bool trusted = false);
 
 protected:
     const char* onGetName() override;
@@ -51,8 +54,9 @@ protected:
     void onDraw(int loops, SkCanvas*) override;
 
 private:
-    SkString      fName;
-    sk_sp<SkData> fEncodedPicture;
+    SkString        fName;
+    sk_sp<SkData>   fEncodedPicture;
+    SkDeserialProcs fProcs;
 
     using INHERITED = Benchmark;
 };
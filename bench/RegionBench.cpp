@@ -7,7 +7,9 @@
 #include "bench/Benchmark.h"
 #include "include/core/SkRegion.h"
 #include "include/core/SkString.h"
+#include "include/private/base/SkTArray.h"
 #include "src/base/SkRandom.h"
+#include "src/core/SkRegionPriv.h"
 
 static bool union_proc(SkRegion& a, SkRegion& b) {
     SkRegion result;
@@ -34,6 +36,25 @@ static bool diffrectbig_proc(SkRegion& a, SkRegion& b) {
     return result.op(a, a.getBounds(), SkRegion::kDifference_Op);
 }
 
+static bool sectrect_proc(SkRegion& a, SkRegion& b) {
+    SkRegion result;
+    return result.op(a, b.getBounds(), SkRegion::kIntersect_Op);
+}
+
+static bool torects_proc(SkRegion& a, SkRegion& b) {
+    skia_private::TArray<SkIRect> rects;
+    SkRegionPriv::ToRects(a, &rects);
+    SkRegionPriv::ToRects(b, &rects);
+    return !rects.empty();
+}
+
+static bool fromrects_proc(SkRegion& a, SkRegion& b) {
+    skia_private::TArray<SkIRect> rects;
+    SkRegionPriv::ToRects(a, &rects);
+    SkRegion result;
+    return SkRegionPriv::SetRects(&result, rects);
+}
+
 static bool containsrect_proc(SkRegion& a, SkRegion& b) {
     SkIRect r = a.getBounds();
     r.inset(r.width()/4, r.height()/4);
@@ -125,7 +146,54 @@ DEF_BENCH(return new RegionBench(SMALL, sect_proc, "intersect");)
 DEF_BENCH(return new RegionBench(SMALL, diff_proc, "difference");)
 DEF_BENCH(return new RegionBench(SMALL, diffrect_proc, "differencerect");)
 DEF_BENCH(return new RegionBench(SMALL, diffrectbig_proc, "differencerectbig");)
+DEF_BENCH(return new RegionBench(SMALL, sectrect_proc, "intersectrect");)
+DEF_BENCH(return new RegionBench(SMALL, torects_proc, "torects");)
+DEF_BENCH(return new RegionBench(SMALL, fromrects_proc, "fromrects");)
 DEF_BENCH(return new RegionBench(SMALL, containsrect_proc, "containsrect");)
 DEF_BENCH(return new RegionBench(SMALL, sectsrgn_proc, "intersectsrgn");)
 DEF_BENCH(return new RegionBench(SMALL, sectsrect_proc, "intersectsrect");)
 DEF_BENCH(return new RegionBench(SMALL, containsxy_proc, "containsxy");)
+
+// Accumulates damage the way a compositor does: many small rects unioned into one region, either
+// one op at a time or all at once with setRects().
+class RegionUnionRectsBench : public Benchmark {
+public:
+    RegionUnionRectsBench(int count, bool batch) : fBatch(batch) {
+        fName.printf("region_unionrects_%s_%d", batch ? "batch" : "serial", count);
+        SkRandom rand;
+        for (int i = 0; i < count; ++i) {
+            fRects.push_back(SkIRect::MakeXYWH(rand.nextULessThan(1024), rand.nextULessThan(768),
+                                               rand.nextRangeU(8, 64), rand.nextRangeU(8, 64)));
+        }
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == Backend::kNonRendering;
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; ++i) {
+            SkRegion rgn;
+            if (fBatch) {
+                rgn.setRects(fRects.data(), fRects.size());
+            } else {
+                for (const SkIRect& r : fRects) {
+                    rgn.op(r, SkRegion::kUnion_Op);
+                }
+            }
+        }
+    }
+
+private:
+    SkString fName;
+    skia_private::TArray<SkIRect> fRects;
+    bool fBatch;
+};
+
+DEF_BENCH(return new RegionUnionRectsBench(64, false);)
+DEF_BENCH(return new RegionUnionRectsBench(64, true);)
+DEF_BENCH(return new RegionUnionRectsBench(1024, false);)
+DEF_BENCH(return new RegionUnionRectsBench(1024, true);)
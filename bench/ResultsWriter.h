@@ -32,6 +32,7 @@
            "8888" : {
                  "median_ms" : 143.188128906250,
                  "min_ms" : 143.835957031250,
+                 "cycles" : 412345678.0,  // per loop, with --perfCounters
                  ...
               },
           ...
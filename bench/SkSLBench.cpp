@@ -14,8 +14,10 @@
 #include "src/gpu/ganesh/GrRecordingContextPriv.h"
 #include "src/gpu/ganesh/mock/GrMockCaps.h"
 #include "src/sksl/SkSLCompiler.h"
+#include "src/sksl/SkSLDefines.h"
 #include "src/sksl/SkSLModuleLoader.h"
 #include "src/sksl/SkSLParser.h"
+#include "src/sksl/SkSLProgramSettings.h"
 #include "src/sksl/codegen/SkSLGLSLCodeGenerator.h"
 #include "src/sksl/codegen/SkSLMetalCodeGenerator.h"
 #include "src/sksl/codegen/SkSLRasterPipelineBuilder.h"
@@ -39,6 +41,16 @@
 #include "src/sksl/generated/sksl_graphite_frag_es2.minified.sksl"
 #include "src/sksl/generated/sksl_graphite_vert_es2.minified.sksl"
 
+#include "src/sksl/generated/sksl_shared.dehydrated.sksl"
+#include "src/sksl/generated/sksl_compute.dehydrated.sksl"
+#include "src/sksl/generated/sksl_frag.dehydrated.sksl"
+#include "src/sksl/generated/sksl_gpu.dehydrated.sksl"
+#include "src/sksl/generated/sksl_public.dehydrated.sksl"
+#include "src/sksl/generated/sksl_rt_shader.dehydrated.sksl"
+#include "src/sksl/generated/sksl_vert.dehydrated.sksl"
+#include "src/sksl/generated/sksl_graphite_frag.dehydrated.sksl"
+#include "src/sksl/generated/sksl_graphite_vert.dehydrated.sksl"
+
 class SkSLCompilerStartupBench : public Benchmark {
 protected:
     const char* onGetName() override {
@@ -622,6 +634,98 @@ void main()
 }
 )");
 
+///////////////////////////////////////////////////////////////////////////////
+
+// A runtime shader with a fixed-size weighting loop, and helper calls which repeat the same math.
+// It exercises loop unrolling and common-subexpression elimination, which are off by default.
+static constexpr char kOptimizerBenchSrc[] = R"(
+uniform half4 weights[5];
+uniform half4 inColor;
+
+half luminance(half3 c) {
+    return dot(c, half3(0.2126, 0.7152, 0.0722));
+}
+
+half4 main(float2 xy) {
+    half4 color = half4(0);
+    for (int i = 0; i < 5; i++) {
+        color += weights[i] * luminance(inColor.rgb * half(i));
+    }
+    half contrast = luminance(color.rgb) * (1 - luminance(color.rgb));
+    return half4(color.rgb * contrast / (contrast + luminance(color.rgb)), color.a);
+}
+)";
+
+static SkSL::ProgramSettings optimizer_bench_settings(bool enableOptimizations) {
+    SkSL::ProgramSettings settings;
+    if (enableOptimizations) {
+        settings.fUnrollLoopThreshold = SkSL::kDefaultUnrollLoopThreshold;
+        settings.fEliminateCommonSubexpressions = true;
+    }
+    return settings;
+}
+
+// Returns the number of Raster Pipeline stages in the compiled program, or -1 on failure.
+static int count_skrp_stages(const SkSL::Program& program) {
+    const SkSL::FunctionDeclaration* main = program.getFunction("main");
+    if (!main) {
+        return -1;
+    }
+    std::unique_ptr<SkSL::RP::Program> rasterProg = SkSL::MakeRasterPipelineProgram(
+            program, *main->definition(), /*debugTrace=*/nullptr, /*writeTraceOps=*/false);
+    if (!rasterProg) {
+        return -1;
+    }
+    float uniformBuffer[1024];
+    if (rasterProg->numUniforms() > (int)std::size(uniformBuffer)) {
+        return -1;
+    }
+    SkSTArenaAlloc<2048> alloc;
+    SkRasterPipeline pipeline(&alloc);
+    rasterProg->appendStages(&pipeline,
+                             &alloc,
+                             /*callbacks=*/nullptr,
+                             /*uniforms=*/SkSpan{uniformBuffer, rasterProg->numUniforms()});
+    return pipeline.getNumStages();
+}
+
+// Times compilation of kOptimizerBenchSrc to Raster Pipeline, with the optional optimization passes
+// on or off. The resulting shader sizes are reported by RunSkSLModuleBenchmarks.
+class SkSLOptimizerBench : public Benchmark {
+public:
+    explicit SkSLOptimizerBench(bool enableOptimizations)
+            : fName(enableOptimizations ? "sksl_optimizer_unroll_cse" : "sksl_optimizer_baseline")
+            , fSettings(optimizer_bench_settings(enableOptimizations)) {}
+
+protected:
+    const char* onGetName() override {
+        return fName;
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == Backend::kNonRendering;
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        for (int i = 0; i < loops; i++) {
+            std::unique_ptr<SkSL::Program> program = fCompiler.convertProgram(
+                    SkSL::ProgramKind::kRuntimeShader, kOptimizerBenchSrc, fSettings);
+            if (fCompiler.errorCount()) {
+                SK_ABORT("shader compilation failed: %s\n", fCompiler.errorText().c_str());
+            }
+            SkAssertResult(count_skrp_stages(*program) > 0);
+        }
+    }
+
+private:
+    const char* fName;
+    SkSL::Compiler fCompiler;
+    SkSL::ProgramSettings fSettings;
+};
+
+DEF_BENCH(return new SkSLOptimizerBench(/*enableOptimizations=*/false);)
+DEF_BENCH(return new SkSLOptimizerBench(/*enableOptimizations=*/true);)
+
 #if defined(SK_BUILD_FOR_UNIX)
 
 #include <malloc.h>
@@ -647,11 +751,12 @@ static int64_t heap_bytes_used() {
 
 #endif
 
-static void bench(NanoJSONResultsWriter* log, const char* name, int bytes) {
-    SkDEBUGCODE(SkDebugf("%s: %d bytes\n", name, bytes);)
+static void bench(NanoJSONResultsWriter* log, const char* name, int value,
+                  const char* units = "bytes") {
+    SkDEBUGCODE(SkDebugf("%s: %d %s\n", name, value, units);)
     log->beginObject(name);          // test
     log->beginObject("meta");        //   config
-    log->appendS32("bytes", bytes);  //     sub_result
+    log->appendS32(units, value);    //     sub_result
     log->endObject();                //   config
     log->endObject();                // test
 }
@@ -725,12 +830,47 @@ void RunSkSLModuleBenchmarks(NanoJSONResultsWriter* log) {
 
     int compilerComputeBinarySize = std::size(SKSL_MINIFIED_sksl_compute);
     bench(log, "sksl_binary_size_compute", compilerComputeBinarySize);
+
+    // Report the dehydrated module sizes, which release builds hold alongside the minified code.
+    int dehydratedGPUBinarySize = std::size(SKSL_DEHYDRATED_sksl_shared) +
+                                  std::size(SKSL_DEHYDRATED_sksl_gpu) +
+                                  std::size(SKSL_DEHYDRATED_sksl_vert) +
+                                  std::size(SKSL_DEHYDRATED_sksl_frag) +
+                                  std::size(SKSL_DEHYDRATED_sksl_public) +
+                                  std::size(SKSL_DEHYDRATED_sksl_rt_shader);
+    bench(log, "sksl_dehydrated_size_gpu", dehydratedGPUBinarySize);
+
+    int dehydratedGraphiteBinarySize = std::size(SKSL_DEHYDRATED_sksl_graphite_frag) +
+                                       std::size(SKSL_DEHYDRATED_sksl_graphite_vert);
+    bench(log, "sksl_dehydrated_size_graphite", dehydratedGraphiteBinarySize);
+
+    int dehydratedComputeBinarySize = std::size(SKSL_DEHYDRATED_sksl_compute);
+    bench(log, "sksl_dehydrated_size_compute", dehydratedComputeBinarySize);
+
+    // Report the size of the shader compiled by SkSLOptimizerBench, with and without the optional
+    // optimization passes.
+    for (bool enableOptimizations : {false, true}) {
+        std::unique_ptr<SkSL::Program> program = compiler.convertProgram(
+                SkSL::ProgramKind::kRuntimeShader, kOptimizerBenchSrc,
+                optimizer_bench_settings(enableOptimizations));
+        if (program) {
+            bench(log,
+                  enableOptimizations ? "sksl_optimizer_unroll_cse_skrp_stages"
+                                      : "sksl_optimizer_baseline_skrp_stages",
+                  count_skrp_stages(*program),
+                  "stages");
+        }
+    }
 }
 
 class SkSLModuleLoaderBench : public Benchmark {
 public:
-    SkSLModuleLoaderBench(const char* name, std::vector<SkSL::ProgramKind> moduleList)
-            : fName(name), fModuleList(std::move(moduleList)) {}
+    SkSLModuleLoaderBench(const char* name,
+                          std::vector<SkSL::ProgramKind> moduleList,
+                          bool useDehydratedModules = true)
+            : fName(name)
+            , fModuleList(std::move(moduleList))
+            , fUseDehydratedModules(useDehydratedModules) {}
 
     const char* onGetName() override {
         return fName;
@@ -745,7 +885,9 @@ public:
     }
 
     void onPreDraw(SkCanvas*) override {
-        SkSL::ModuleLoader::Get().unloadModules();
+        SkSL::ModuleLoader loader = SkSL::ModuleLoader::Get();
+        loader.unloadModules();
+        loader.useDehydratedModules(fUseDehydratedModules);
     }
 
     void onDraw(int loops, SkCanvas*) override {
@@ -756,34 +898,43 @@ public:
         }
     }
 
+    void onPostDraw(SkCanvas*) override {
+        SkSL::ModuleLoader::Get().useDehydratedModules(true);
+    }
+
     const char* fName;
     std::vector<SkSL::ProgramKind> fModuleList;
+    bool fUseDehydratedModules;
 };
 
-DEF_BENCH(return new SkSLModuleLoaderBench("sksl_module_loader_ganesh",
-                                           {
-                                                   SkSL::ProgramKind::kVertex,
-                                                   SkSL::ProgramKind::kFragment,
-                                                   SkSL::ProgramKind::kRuntimeColorFilter,
-                                                   SkSL::ProgramKind::kRuntimeShader,
-                                                   SkSL::ProgramKind::kRuntimeBlender,
-                                                   SkSL::ProgramKind::kPrivateRuntimeColorFilter,
-                                                   SkSL::ProgramKind::kPrivateRuntimeShader,
-                                                   SkSL::ProgramKind::kPrivateRuntimeBlender,
-                                                   SkSL::ProgramKind::kCompute,
-                                           });)
-
-DEF_BENCH(return new SkSLModuleLoaderBench("sksl_module_loader_graphite",
-                                           {
-                                                   SkSL::ProgramKind::kVertex,
-                                                   SkSL::ProgramKind::kFragment,
-                                                   SkSL::ProgramKind::kRuntimeColorFilter,
-                                                   SkSL::ProgramKind::kRuntimeShader,
-                                                   SkSL::ProgramKind::kRuntimeBlender,
-                                                   SkSL::ProgramKind::kPrivateRuntimeColorFilter,
-                                                   SkSL::ProgramKind::kPrivateRuntimeShader,
-                                                   SkSL::ProgramKind::kPrivateRuntimeBlender,
-                                                   SkSL::ProgramKind::kCompute,
-                                                   SkSL::ProgramKind::kGraphiteVertex,
-                                                   SkSL::ProgramKind::kGraphiteFragment,
-                                           });)
+static std::vector<SkSL::ProgramKind> ganesh_module_list() {
+    return {
+            SkSL::ProgramKind::kVertex,
+            SkSL::ProgramKind::kFragment,
+            SkSL::ProgramKind::kRuntimeColorFilter,
+            SkSL::ProgramKind::kRuntimeShader,
+            SkSL::ProgramKind::kRuntimeBlender,
+            SkSL::ProgramKind::kPrivateRuntimeColorFilter,
+            SkSL::ProgramKind::kPrivateRuntimeShader,
+            SkSL::ProgramKind::kPrivateRuntimeBlender,
+            SkSL::ProgramKind::kCompute,
+    };
+}
+
+static std::vector<SkSL::ProgramKind> graphite_module_list() {
+    std::vector<SkSL::ProgramKind> moduleList = ganesh_module_list();
+    moduleList.push_back(SkSL::ProgramKind::kGraphiteVertex);
+    moduleList.push_back(SkSL::ProgramKind::kGraphiteFragment);
+    return moduleList;
+}
+
+DEF_BENCH(return new SkSLModuleLoaderBench("sksl_module_loader_ganesh", ganesh_module_list());)
+DEF_BENCH(return new SkSLModuleLoaderBench("sksl_module_loader_graphite", graphite_module_list());)
+
+// The same, compiling every module from its source instead of loading its dehydrated IR.
+DEF_BENCH(return new SkSLModuleLoaderBench("sksl_module_loader_ganesh_from_source",
+                                           ganesh_module_list(),
+                                           /*useDehydratedModules=*/false);)
+DEF_BENCH(return new SkSLModuleLoaderBench("sksl_module_loader_graphite_from_source",
+                                           graphite_module_list(),
+                                           /*useDehydratedModules=*/false);)
@@ -186,6 +186,55 @@ DEF_PATH_TESS_BENCH(wangs_formula_cubic_log2_affine, make_cubic_path(18),
     benchmark_wangs_formula_cubic_log2(fMatrix, fPath);
 }
 
+// Evaluates Wang's formula for the same cubics as wangs_formula_cubic_log2, but with the cubics
+// already in SoA layout and run through the batched kernel.
+class WangsFormulaCubicBatchBench : public Benchmark {
+public:
+    WangsFormulaCubicBatchBench(const char* subName, const SkMatrix& m) : fMatrix(m) {
+        fName.printf("tessellate_wangs_formula_cubic_p4_batch%s", subName);
+    }
+
+    const char* onGetName() override { return fName.c_str(); }
+    bool isSuitableFor(Backend backend) final { return backend == Backend::kNonRendering; }
+
+protected:
+    void onDelayedSetup() override {
+        for (auto [verb, pts, w] : SkPathPriv::Iterate(make_cubic_path(18))) {
+            if (verb == SkPathVerb::kCubic) {
+                for (int k = 0; k < 4; ++k) {
+                    fX[k].push_back(pts[k].fX);
+                    fY[k].push_back(pts[k].fY);
+                }
+            }
+        }
+        fN4.resize(fX[0].size());
+    }
+
+    void onDraw(int loops, SkCanvas*) final {
+        const float* const x[4] = {fX[0].data(), fX[1].data(), fX[2].data(), fX[3].data()};
+        const float* const y[4] = {fY[0].data(), fY[1].data(), fY[2].data(), fY[3].data()};
+        const int count = fN4.size();
+        const wangs_formula::VectorXform xform(fMatrix);
+        int sum = 0;
+        for (int i = 0; i < loops; ++i) {
+            wangs_formula::cubic_p4(4, x, y, count, fN4.data(), xform);
+            sum += wangs_formula::nextlog16(fN4[i % count]);
+        }
+        // Don't let the compiler optimize away the kernel.
+        if (sum <= 0) {
+            SK_ABORT("sum should be > 0.");
+        }
+    }
+
+    SkString fName;
+    const SkMatrix fMatrix;
+    std::vector<float> fX[4], fY[4], fN4;
+};
+
+DEF_BENCH(return new WangsFormulaCubicBatchBench("", SkMatrix::I());)
+DEF_BENCH(return new WangsFormulaCubicBatchBench("_affine",
+                                                 SkMatrix::MakeAll(.9f,0.9f,0, 1.1f,1.1f,0, 0,0,1));)
+
 static void benchmark_wangs_formula_conic(const SkMatrix& matrix, const SkPath& path) {
     int sum = 0;
     wangs_formula::VectorXform xform(matrix);
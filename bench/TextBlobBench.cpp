@@ -7,13 +7,16 @@
 
 #include "bench/Benchmark.h"
 #include "include/core/SkCanvas.h"
+#include "include/core/SkData.h"
 #include "include/core/SkFont.h"
 #include "include/core/SkPaint.h"
+#include "include/core/SkSerialProcs.h"
 #include "include/core/SkStream.h"
 #include "include/core/SkString.h"
 #include "include/core/SkTextBlob.h"
 #include "include/core/SkTypeface.h"
 #include "include/private/base/SkTemplates.h"
+#include "include/private/base/SkTo.h"
 #include "src/base/SkRandom.h"
 #include "tools/Resources.h"
 #include "tools/ToolUtils.h"
@@ -109,3 +112,81 @@ class TextBlobMakeBench : public SkTextBlobBench {
     }
 };
 DEF_BENCH( return new TextBlobMakeBench(); )
+
+// Reads back a serialized blob, whose glyphs and positions are usually packed.
+class TextBlobDeserializeBench : public SkTextBlobBench {
+    const char* onGetName() override {
+        return "TextBlobDeserializeBench";
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == Backend::kNonRendering;
+    }
+
+    void onDelayedSetup() override {
+        this->SkTextBlobBench::onDelayedSetup();
+        fData = this->makeBlob()->serialize(SkSerialProcs());
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; i++) {
+            for (int inner = 0; inner < 1000; ++inner) {
+                SkTextBlob::Deserialize(fData->data(), fData->size(), SkDeserialProcs());
+            }
+        }
+    }
+
+    sk_sp<SkData> fData;
+};
+DEF_BENCH( return new TextBlobDeserializeBench(); )
+
+/*
+ * Draws one run of many glyphs, so that the per glyph cost of placing them (mapping their
+ * positions and making their quads) shows rather than the per run cost.
+ */
+class TextBlobManyGlyphsBench : public Benchmark {
+public:
+    static constexpr int kGlyphCount = 10000;
+
+    TextBlobManyGlyphsBench(bool rotate) : fRotate(rotate) {
+        fName.printf("TextBlobManyGlyphs_%d%s", kGlyphCount, rotate ? "_rotated" : "");
+    }
+
+private:
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        SkFont font(ToolUtils::CreatePortableTypeface("serif", SkFontStyle()), 8);
+        font.setSubpixel(true);
+
+        SkTextBlobBuilder builder;
+        const SkTextBlobBuilder::RunBuffer& run = builder.allocRunPos(font, kGlyphCount);
+        SkRandom random;
+        for (int i = 0; i < kGlyphCount; ++i) {
+            run.glyphs[i] = SkToU16(random.nextRangeU(1, 90));
+            run.points()[i] = {random.nextRangeScalar(0, 640), random.nextRangeScalar(0, 480)};
+        }
+        fBlob = builder.make();
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        SkPaint paint;
+        for (int i = 0; i < loops; i++) {
+            canvas->save();
+            if (fRotate) {
+                canvas->rotate(15, 320, 240);
+            }
+            // A new translation each time draws the glyphs again rather than reusing the
+            // last draw's vertices.
+            canvas->translate(0.25f * (i % 4), 0);
+            canvas->drawTextBlob(fBlob, 0, 0, paint);
+            canvas->restore();
+        }
+    }
+
+    const bool fRotate;
+    SkString fName;
+    sk_sp<SkTextBlob> fBlob;
+};
+DEF_BENCH( return new TextBlobManyGlyphsBench(false); )
+DEF_BENCH( return new TextBlobManyGlyphsBench(true); )
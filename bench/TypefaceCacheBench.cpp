@@ -0,0 +1,79 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+#include "include/core/SkString.h"
+#include "include/core/SkTypeface.h"
+#include "src/core/SkTaskGroup.h"
+#include "src/core/SkTypefaceCache.h"
+#include "tools/fonts/TestEmptyTypeface.h"
+
+#include <vector>
+
+static bool is_typeface(SkTypeface* face, void* ctx) {
+    return face == ctx;
+}
+
+// Many threads resolving typefaces through the global typeface cache at once, as font managers do
+// when text is laid out on several threads. Typefaces are either filed by key, or found by
+// scanning the cache.
+class TypefaceCacheBench : public Benchmark {
+public:
+    explicit TypefaceCacheBench(bool keyed) : fKeyed(keyed) {
+        fName.printf("typeface_cache_lookup_%s", keyed ? "keyed" : "scan");
+    }
+
+    ~TypefaceCacheBench() override {
+        fTypefaces.clear();
+        SkTypefaceCache::PurgeAll();
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    bool isSuitableFor(Backend backend) override { return backend == Backend::kNonRendering; }
+
+    void onDelayedSetup() override {
+        for (int i = 0; i < kTypefaceCount; i++) {
+            sk_sp<SkTypeface> typeface = TestEmptyTypeface::Make();
+            if (fKeyed) {
+                SkTypefaceCache::Add(typeface, i);
+            } else {
+                SkTypefaceCache::Add(typeface);
+            }
+            fTypefaces.push_back(std::move(typeface));
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int loop = 0; loop < loops; loop++) {
+            SkTaskGroup().batch(kThreadCount, [this](int thread) {
+                for (int i = 0; i < kLookupsPerThread; i++) {
+                    const int index = (thread * 31 + i * 7) % kTypefaceCount;
+                    SkTypeface* typeface = fTypefaces[index].get();
+                    sk_sp<SkTypeface> found =
+                            fKeyed ? SkTypefaceCache::FindByKeyAndProcAndRef(index, is_typeface,
+                                                                             typeface)
+                                   : SkTypefaceCache::FindByProcAndRef(is_typeface, typeface);
+                    SkASSERT(found.get() == typeface);
+                }
+            });
+        }
+    }
+
+private:
+    static constexpr int kTypefaceCount = 256;
+    static constexpr int kThreadCount = 16;
+    static constexpr int kLookupsPerThread = 256;
+
+    const bool fKeyed;
+    SkString fName;
+    std::vector<sk_sp<SkTypeface>> fTypefaces;
+};
+
+DEF_BENCH(return new TypefaceCacheBench(false);)
+DEF_BENCH(return new TypefaceCacheBench(true);)
@@ -6,6 +6,7 @@
  */
 
 #include "bench/Benchmark.h"
+#include "include/core/SkBlendMode.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkPaint.h"
 #include "include/core/SkShader.h"
@@ -148,6 +149,68 @@ DEF_BENCH(return new VertBench(kColors_VertFlag);)
 DEF_BENCH(return new VertBench(kColors_VertFlag | kTexture_VertFlag);)
 DEF_BENCH(return new VertBench(kColors_VertFlag | kTexture_VertFlag | kBilerp_VertFlag);)
 
+// Large meshes of small triangles (e.g. mesh warps, charts) stress per-triangle setup cost more
+// than per-pixel cost.
+class VertMeshBench : public Benchmark {
+    static constexpr int W = 640;
+    static constexpr int H = 480;
+
+    SkString fName;
+    int fGrid;
+    SkBlendMode fMode;
+    sk_sp<SkVertices> fVerts;
+
+public:
+    VertMeshBench(int grid, SkBlendMode mode) : fGrid(grid), fMode(mode) {
+        SkASSERT((grid + 1) * (grid + 1) <= 65536);
+        fName.printf("verts_mesh_%d_colors_%s", grid, SkBlendMode_Name(mode));
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+    void onDelayedSetup() override {
+        const int ptCount = (fGrid + 1) * (fGrid + 1);
+        const int idxCount = fGrid * fGrid * 6;
+        SkVertices::Builder builder(SkVertices::kTriangles_VertexMode, ptCount, idxCount,
+                                    SkVertices::kHasColors_BuilderFlag);
+
+        SkRandom rand;
+        SkPoint* pts = builder.positions();
+        SkColor* colors = builder.colors();
+        for (int y = 0; y <= fGrid; ++y) {
+            for (int x = 0; x <= fGrid; ++x) {
+                // Jitter the interior so the triangles aren't all the same shape.
+                const bool interior = x > 0 && x < fGrid && y > 0 && y < fGrid;
+                const float jx = interior ? rand.nextSScalar1() * 0.3f : 0,
+                            jy = interior ? rand.nextSScalar1() * 0.3f : 0;
+                *pts++ = {(x + jx) * W / fGrid, (y + jy) * H / fGrid};
+                *colors++ = rand.nextU() | 0xFF000000;
+            }
+        }
+
+        uint16_t* idx = builder.indices();
+        const int rb = fGrid + 1;
+        for (int y = 0; y < fGrid; ++y) {
+            for (int x = 0; x < fGrid; ++x) {
+                const int n = y * rb + x;
+                *idx++ = n; *idx++ = n + 1;  *idx++ = n + rb + 1;
+                *idx++ = n; *idx++ = n + rb + 1; *idx++ = n + rb;
+            }
+        }
+        fVerts = builder.detach();
+    }
+    void onDraw(int loops, SkCanvas* canvas) override {
+        SkPaint paint;
+        this->setupPaint(&paint);
+        for (int i = 0; i < loops; i++) {
+            canvas->drawVertices(fVerts, fMode, paint);
+        }
+    }
+};
+DEF_BENCH(return new VertMeshBench( 64, SkBlendMode::kModulate);)
+DEF_BENCH(return new VertMeshBench(250, SkBlendMode::kModulate);)
+DEF_BENCH(return new VertMeshBench(250, SkBlendMode::kDst);)
+
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "include/core/SkRSXform.h"
@@ -0,0 +1,111 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+#include "include/core/SkString.h"
+#include "src/base/SkRandom.h"
+#include "src/base/SkTSort.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace skgpu::graphite {
+
+// Compares std::sort to SkTRadixSort on keys laid out like DrawPass::SortKey: a 64-bit pipeline key
+// of paint order (bits 48+), stencil index (32+), render step (30+) and pipeline index (0+), then a
+// 64-bit key of geometry uniform (47+), shading uniform (30+) and texture binding (0+) indices, and
+// a pointer to the draw.
+class DrawPassSortBench : public Benchmark {
+public:
+    enum class Order {
+        kShared,   // Non-overlapping draws, which share a handful of paint orders.
+        kLayered,  // Overlapping draws, a few to each paint order, so keys are mostly in order.
+    };
+
+    DrawPassSortBench(int count, Order order, bool radix)
+            : fCount(count), fOrder(order), fRadix(radix) {
+        fName.printf("DrawPassSort_%s_%d_%s",
+                     order == Order::kShared ? "shared" : "layered",
+                     count,
+                     radix ? "radix" : "std");
+    }
+
+protected:
+    struct Key {
+        uint64_t fPipelineKey;
+        uint64_t fUniformKey;
+        const void* fDraw;
+
+        bool operator<(const Key& k) const {
+            return fPipelineKey < k.fPipelineKey ||
+                   (fPipelineKey == k.fPipelineKey && fUniformKey < k.fUniformKey);
+        }
+    };
+
+    const char* onGetName() override { return fName.c_str(); }
+
+    bool isSuitableFor(Backend backend) override { return backend == Backend::kNonRendering; }
+
+    void onDelayedSetup() override {
+        SkRandom rand;
+        fKeys.resize(fCount);
+        for (int i = 0; i < fCount; ++i) {
+            uint64_t paintOrder = fOrder == Order::kShared ? rand.nextULessThan(64) : i / 3;
+            uint64_t renderStep = rand.nextULessThan(2);
+            uint64_t pipeline = rand.nextULessThan(24);
+            // Most draws have their own geometry uniforms, while shading uniforms and textures are
+            // shared far more.
+            uint64_t geometryUniforms = rand.nextULessThan(fCount);
+            uint64_t shadingUniforms = rand.nextULessThan(std::max(fCount / 16, 1));
+            uint64_t textures = rand.nextULessThan(64);
+            fKeys[i] = {paintOrder << 48 | renderStep << 30 | pipeline,
+                        geometryUniforms << 47 | shadingUniforms << 30 | textures,
+                        &fKeys[i]};
+        }
+        fWork.resize(fCount);
+        fScratch.resize(fCount);
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; ++i) {
+            std::copy(fKeys.begin(), fKeys.end(), fWork.begin());
+            if (fRadix) {
+                SkTRadixSort<2>(fWork.data(), fWork.data() + fCount, fScratch.data(),
+                                [](const Key& key, int w) {
+                                    return w ? key.fPipelineKey : key.fUniformKey;
+                                });
+            } else {
+                std::sort(fWork.begin(), fWork.end());
+            }
+        }
+    }
+
+private:
+    const int fCount;
+    const Order fOrder;
+    const bool fRadix;
+    SkString fName;
+    std::vector<Key> fKeys;
+    std::vector<Key> fWork;
+    std::vector<Key> fScratch;
+};
+
+}  // namespace skgpu::graphite
+
+using DrawPassSortBench = skgpu::graphite::DrawPassSortBench;
+
+DEF_BENCH( return new DrawPassSortBench(1000, DrawPassSortBench::Order::kShared, false); )
+DEF_BENCH( return new DrawPassSortBench(1000, DrawPassSortBench::Order::kShared, true); )
+DEF_BENCH( return new DrawPassSortBench(10000, DrawPassSortBench::Order::kShared, false); )
+DEF_BENCH( return new DrawPassSortBench(10000, DrawPassSortBench::Order::kShared, true); )
+DEF_BENCH( return new DrawPassSortBench(50000, DrawPassSortBench::Order::kShared, false); )
+DEF_BENCH( return new DrawPassSortBench(50000, DrawPassSortBench::Order::kShared, true); )
+DEF_BENCH( return new DrawPassSortBench(10000, DrawPassSortBench::Order::kLayered, false); )
+DEF_BENCH( return new DrawPassSortBench(10000, DrawPassSortBench::Order::kLayered, true); )
+DEF_BENCH( return new DrawPassSortBench(50000, DrawPassSortBench::Order::kLayered, false); )
+DEF_BENCH( return new DrawPassSortBench(50000, DrawPassSortBench::Order::kLayered, true); )
@@ -15,6 +15,7 @@
 #include "bench/CodecBenchPriv.h"
 #include "bench/GMBench.h"
 #include "bench/MSKPBench.h"
+#include "bench/PerfCounters.h"
 #include "bench/RecordingBench.h"
 #include "bench/ResultsWriter.h"
 #include "bench/SKPAnimationBench.h"
@@ -78,11 +79,13 @@
 #include "tools/graphite/GraphiteTestContext.h"
 #endif
 
+#include <atomic>
 #include <cinttypes>
 #include <memory>
 #include <optional>
 #include <stdlib.h>
 #include <thread>
+#include <vector>
 
 extern bool gSkForceRasterPipelineBlitter;
 extern bool gForceHighPrecisionRasterPipeline;
@@ -148,6 +151,10 @@ static DEFINE_int(flushEvery, 10, "Flush --outResultsFile every Nth run.");
 static DEFINE_bool(gpuStats, false, "Print GPU stats after each gpu benchmark?");
 static DEFINE_bool(gpuStatsDump, false, "Dump GPU stats after each benchmark to json");
 static DEFINE_bool(dmsaaStatsDump, false, "Dump DMSAA stats after each benchmark to json");
+static DEFINE_bool(perfCounters, false,
+                   "Count CPU cycles, instructions, cache misses and branch misses while timing "
+                   "CPU-bound benches, and write them per loop to --outResultsFile. Needs "
+                   "perf_event access on Linux, or root on macOS.");
 static DEFINE_bool(keepAlive, false, "Print a message every so often so that we don't time out");
 static DEFINE_bool(csv, false, "Print status in CSV format");
 static DEFINE_string(sourceType, "",
@@ -191,6 +198,10 @@ static DEFINE_string(mskps, "mskps", "Directory to read mskps from.");
 static DEFINE_string(svgs, "", "Directory to read SVGs from, or a single SVG file.");
 static DEFINE_string(texttraces, "", "Directory to read TextBlobTrace files from.");
 
+static DEFINE_int(benchThreads, 0,
+                  "If >1, also run this many instances of each thread-safe CPU bench at once, "
+                  "one per thread, and report their time per loop and scaling efficiency.");
+
 static DEFINE_int_2(threads, j, -1,
                "Run threadsafe tests on a threadpool with this many extra threads, "
                "defaulting to one extra thread per core.");
@@ -391,7 +402,8 @@ struct GraphiteTarget : public Target {
 };
 #endif // SK_GRAPHITE
 
-static double time(int loops, Benchmark* bench, Target* target) {
+static double time(int loops, Benchmark* bench, Target* target,
+                   PerfCounters* counters = nullptr) {
     SkCanvas* canvas = target->getCanvas();
     if (canvas) {
         canvas->clear(SK_ColorWHITE);
@@ -399,15 +411,68 @@ static double time(int loops, Benchmark* bench, Target* target) {
     bench->preDraw(canvas);
     double start = now_ms();
     canvas = target->beginTiming(canvas);
+    if (counters) {
+        counters->start();
+    }
 
     bench->draw(loops, canvas);
 
+    if (counters) {
+        counters->stop();
+    }
     target->endTiming();
     double elapsed = now_ms() - start;
     bench->postDraw(canvas);
     return elapsed;
 }
 
+// Runs each of 'benches' on its own thread, all at once, each drawing to its own copy of
+// 'target's surface (if any). Returns each thread's median time per loop, in ms.
+static TArray<double> time_concurrently(int loops, int samples,
+                                        const TArray<std::unique_ptr<Benchmark>>& benches,
+                                        const Target* target) {
+    const int threadCount = benches.size();
+    TArray<double> medians;
+    medians.push_back_n(threadCount, 0.0);
+
+    std::atomic<int> ready{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; t++) {
+        threads.emplace_back([&, t] {
+            Benchmark* bench = benches[t].get();
+            sk_sp<SkSurface> surface =
+                    target->surface ? SkSurfaces::Raster(target->surface->imageInfo()) : nullptr;
+            SkCanvas* canvas = surface ? surface->getCanvas() : nullptr;
+            bench->perCanvasPreDraw(canvas);
+
+            // Start timing together, so the threads contend for the whole run.
+            ready.fetch_add(1);
+            while (ready.load() < threadCount) {
+                std::this_thread::yield();
+            }
+
+            TArray<double> times;
+            for (int s = 0; s < samples; s++) {
+                if (canvas) {
+                    canvas->clear(SK_ColorWHITE);
+                }
+                bench->preDraw(canvas);
+                double start = now_ms();
+                bench->draw(loops, canvas);
+                times.push_back((now_ms() - start) / loops);
+                bench->postDraw(canvas);
+            }
+
+            bench->perCanvasPostDraw(canvas);
+            medians[t] = Stats(times, false).median;
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    return medians;
+}
+
 static double estimate_timer_overhead() {
     double overhead = 0;
     for (int i = 0; i < FLAGS_overheadLoops; i++) {
@@ -910,9 +975,16 @@ public:
         return bench.release();
     }
 
+    // Returns another instance of the current bench, if it's a micro bench.
+    std::unique_ptr<Benchmark> makeAnother() const {
+        return std::unique_ptr<Benchmark>(fCurrentFactory ? fCurrentFactory(nullptr) : nullptr);
+    }
+
     Benchmark* rawNext() {
+        fCurrentFactory = nullptr;
         if (fBenches) {
-            Benchmark* bench = fBenches->get()(nullptr);
+            fCurrentFactory = fBenches->get();
+            Benchmark* bench = fCurrentFactory(nullptr);
             fBenches = fBenches->next();
             fSourceType = "bench";
             fBenchType  = "micro";
@@ -1170,6 +1242,8 @@ public:
         // test on power of two sample sizes.  The output tile is always 512x512, so, when a
         // sampleSize is used, the size of the subset that is decoded is always
         // (sampleSize*512)x(sampleSize*512).
+        // Panning over a large image requests one tile after another from the same decoder, so we
+        // also benchmark a column of tiles from the top of the image to the bottom.
         // There are a few good reasons to only test on power of two sample sizes at this time:
         //     All use cases we are aware of only scale by powers of two.
         //     PNG decodes use the indicated sampling strategy regardless of the sample size, so
@@ -1187,7 +1261,7 @@ public:
 
             while (fCurrentColorType < fColorTypes.size()) {
                 while (fCurrentSampleSize < (int) std::size(brdSampleSizes)) {
-                    while (fCurrentSubsetType <= kLastSingle_SubsetType) {
+                    while (fCurrentSubsetType <= kTranslate_SubsetType) {
 
                         sk_sp<SkData> encoded(SkData::MakeFromFileName(path.c_str()));
                         const SkColorType colorType = fColorTypes[fCurrentColorType];
@@ -1204,6 +1278,8 @@ public:
                         SkString basename = SkOSPath::Basename(path.c_str());
                         SkIRect subset;
                         const uint32_t subsetSize = sampleSize * minOutputSize;
+                        int tileCount = 1;
+                        SkIVector tileStep = {0, 0};
                         switch (currentSubsetType) {
                             case kTopLeft_SubsetType:
                                 basename.append("_TopLeft");
@@ -1229,12 +1305,22 @@ public:
                                 subset = SkIRect::MakeXYWH(width - subsetSize,
                                         height - subsetSize, subsetSize, subsetSize);
                                 break;
+                            case kTranslate_SubsetType:
+                                basename.append("_Pan");
+                                subset = SkIRect::MakeXYWH((width - subsetSize) / 2, 0, subsetSize,
+                                        subsetSize);
+                                tileCount = height / subsetSize;
+                                tileStep = {0, (int) subsetSize};
+                                break;
                             default:
                                 SkASSERT(false);
                         }
 
+                        if (tileCount < 2 && kTranslate_SubsetType == currentSubsetType) {
+                            continue;
+                        }
                         return new BitmapRegionDecoderBench(basename.c_str(), encoded.get(),
-                                colorType, sampleSize, subset);
+                                colorType, sampleSize, subset, tileCount, tileStep);
                     }
                     fCurrentSubsetType = 0;
                     fCurrentSampleSize++;
@@ -1284,6 +1370,7 @@ private:
 #endif
 
     const BenchRegistry* fBenches;
+    Benchmark* (*fCurrentFactory)(void*) = nullptr;
     const skiagm::GMRegistry* fGMs;
     SkIRect            fClip;
     TArray<SkScalar> fScales;
@@ -1415,6 +1502,14 @@ int main(int argc, char** argv) {
         log.endObject(); // key
     }
 
+    std::unique_ptr<PerfCounters> perfCounters;
+    if (FLAGS_perfCounters) {
+        perfCounters = PerfCounters::Make();
+        if (!perfCounters) {
+            SkDebugf("WARNING: Can't read performance counters; ignoring --perfCounters.\n");
+        }
+    }
+
     const double overhead = estimate_timer_overhead();
     if (!FLAGS_quiet && !FLAGS_csv) {
         SkDebugf("Timer overhead: %s\n", HUMANIZE(overhead));
@@ -1502,7 +1597,8 @@ int main(int argc, char** argv) {
             bench->perCanvasPreDraw(canvas);
 
             int maxFrameLag;
-            int loops = target->needsFrameTiming(&maxFrameLag)
+            const bool frameTiming = target->needsFrameTiming(&maxFrameLag);
+            int loops = frameTiming
                 ? setup_gpu_bench(target, bench.get(), maxFrameLag)
                 : setup_cpu_bench(overhead, target, bench.get());
 
@@ -1522,17 +1618,24 @@ int main(int argc, char** argv) {
                 } while (now_ms() < stop);
             }
 
+            // Counters on the CPU say little about work done by the GPU, so only CPU-bound
+            // benches are counted.
+            PerfCounters* counters = frameTiming ? nullptr : perfCounters.get();
+            if (counters) {
+                counters->reset();
+            }
+
             if (FLAGS_ms) {
                 samples.clear();
                 auto stop = now_ms() + FLAGS_ms;
                 do {
-                    samples.push_back(time(loops, bench.get(), target) / loops);
+                    samples.push_back(time(loops, bench.get(), target, counters) / loops);
                     pool.drain();
                 } while (now_ms() < stop);
             } else {
                 samples.reset(FLAGS_samples);
                 for (int s = 0; s < FLAGS_samples; s++) {
-                    samples[s] = time(loops, bench.get(), target) / loops;
+                    samples[s] = time(loops, bench.get(), target, counters) / loops;
                     pool.drain();
                 }
             }
@@ -1559,6 +1662,28 @@ int main(int argc, char** argv) {
 
             bench->perCanvasPostDraw(canvas);
 
+            // Run more instances of the bench at once, to see how well it scales.
+            TArray<double> threadMs;
+            if (FLAGS_benchThreads > 1 && bench->isThreadSafe() && !frameTiming &&
+                (Benchmark::Backend::kNonRendering == target->config.backend ||
+                 Benchmark::Backend::kRaster == target->config.backend)) {
+                TArray<std::unique_ptr<Benchmark>> instances;
+                for (int t = 0; t < FLAGS_benchThreads; t++) {
+                    std::unique_ptr<Benchmark> instance = benchStream.makeAnother();
+                    if (!instance) {
+                        break;
+                    }
+                    instance->delayedSetup();
+                    instances.push_back(std::move(instance));
+                }
+                if (instances.size() == FLAGS_benchThreads) {
+                    threadMs = time_concurrently(loops, samples.size(), instances, target);
+                    for (double& ms : threadMs) {
+                        ms *= (1.0 / bench->getUnits());
+                    }
+                }
+            }
+
             if (Benchmark::Backend::kNonRendering != target->config.backend &&
                 !FLAGS_writePath.isEmpty() && FLAGS_writePath[0]) {
                 SkString pngFilename = SkOSPath::Join(FLAGS_writePath[0], config);
@@ -1587,6 +1712,28 @@ int main(int argc, char** argv) {
                 log.appendDoubleDigits(sample, 16);
             }
             log.endArray(); // samples
+            if (counters) {
+                // Like the samples, counts are per loop, in the benchmark's own units.
+                const double perLoop = 1.0 / (samples.size() * (double)loops * bench->getUnits());
+                for (int c = 0; c < PerfCounters::kCounterCount; c++) {
+                    const auto counter = static_cast<PerfCounters::Counter>(c);
+                    log.appendMetric(PerfCounters::Name(counter),
+                                     counters->total(counter) * perLoop);
+                }
+            }
+            if (!threadMs.empty()) {
+                // Each thread's time per loop, and how close that is to the time on one thread.
+                const double threadedMs = Stats(threadMs, false).mean;
+                log.appendMetric("threads", threadMs.size());
+                log.appendMetric("threaded_ms", threadedMs);
+                log.appendMetric("scaling_efficiency",
+                                 sk_ieee_double_divide(stats.median, threadedMs));
+                log.beginArray("thread_ms");
+                for (double ms : threadMs) {
+                    log.appendDoubleDigits(ms, 16);
+                }
+                log.endArray(); // thread_ms
+            }
             benchStream.fillCurrentMetrics(log);
             if (!keys.empty()) {
                 // dump to json, only SKPBench currently returns valid keys / values
@@ -1651,6 +1798,18 @@ int main(int argc, char** argv) {
                         );
             }
 
+            if (!threadMs.empty() && !FLAGS_quiet && !FLAGS_csv &&
+                kAutoTuneLoops == FLAGS_loops) {
+                const double threadedMs = Stats(threadMs, false).mean;
+                SkDebugf("\t\t%d threads\t%s/loop per thread\t%.0f%% scaling\t%s\t%s\n"
+                        , threadMs.size()
+                        , HUMANIZE(threadedMs)
+                        , 100 * sk_ieee_double_divide(stats.median, threadedMs)
+                        , config
+                        , bench->getUniqueName()
+                        );
+            }
+
             if (FLAGS_gpuStats && Benchmark::Backend::kGanesh == configs[i].backend) {
                 target->dumpStats();
             }
@@ -1458,11 +1458,13 @@ Result MSKPSrc::draw(int i, SkCanvas* canvas, GraphiteTestContext*) const {
         if (!stream) {
             return Result::Fatal("Unable to open file: %s", fPath.c_str());
         }
-        if (!SkMultiPictureDocument::Read(stream.get(), &fPages[0], fPages.size())) {
+        auto reader = SkMultiPictureDocument::Reader::Make(stream.get());
+        fPages[i].fPicture = reader ? reader->readPage(i) : nullptr;
+        page = fPages[i].fPicture.get();
+        if (!page) {
             return Result::Fatal("SkMultiPictureDocument reader failed on page %d: %s", i,
                                  fPath.c_str());
         }
-        page = fPages[i].fPicture.get();
     }
     canvas->drawPicture(page);
     return Result::Ok();
@@ -13,6 +13,7 @@
 #include "include/core/SkPaint.h"
 #include "include/core/SkPathBuilder.h"
 #include "include/core/SkPathEffect.h"
+#include "include/core/SkPathUtils.h"
 #include "include/core/SkPoint.h"
 #include "include/core/SkRect.h"
 #include "include/core/SkScalar.h"
@@ -641,6 +642,66 @@ DEF_SIMPLE_GM(thin_aa_dash_lines, canvas, 330, 110) {
     }
 }
 
+// Ganesh draws dashed lines with up to eight intervals with its dash line op. Each pattern is drawn
+// that way (as a line with a dash path effect), and right below it as the fill of the dashed
+// stroke, which is always computed on the CPU; the two should match. The last pattern is too long
+// for the op, so both of its lines are dashed on the CPU.
+DEF_SIMPLE_GM(dash_line_long_patterns, canvas, 520, 500) {
+    static constexpr SkScalar kPattern2[] = {10, 5};
+    static constexpr SkScalar kPattern4[] = {10, 5, 3, 5};
+    static constexpr SkScalar kPattern6[] = {12, 4, 2, 4, 6, 8};
+    static constexpr SkScalar kPattern8[] = {8, 3, 2, 3, 4, 6, 0, 5};
+    static constexpr SkScalar kPattern10[] = {5, 3, 5, 3, 2, 3, 2, 3, 1, 4};
+    static constexpr struct {
+        const SkScalar* fIntervals;
+        int fCount;
+    } kPatterns[] = {{kPattern2, std::size(kPattern2)},
+                     {kPattern4, std::size(kPattern4)},
+                     {kPattern6, std::size(kPattern6)},
+                     {kPattern8, std::size(kPattern8)},
+                     {kPattern10, std::size(kPattern10)}};
+
+    SkPaint dashPaint;
+    dashPaint.setAntiAlias(true);
+    dashPaint.setStroke(true);
+    dashPaint.setStrokeWidth(3);
+    SkPaint fillPaint;
+    fillPaint.setAntiAlias(true);
+
+    canvas->translate(10, 10);
+    for (auto cap : {SkPaint::kButt_Cap, SkPaint::kSquare_Cap}) {
+        dashPaint.setStrokeCap(cap);
+        for (SkScalar phase : {0.f, 7.f}) {
+            for (const auto& pattern : kPatterns) {
+                dashPaint.setPathEffect(
+                        SkDashPathEffect::Make(pattern.fIntervals, pattern.fCount, phase));
+                const SkPoint pts[2] = {{0, 0}, {240, 0}};
+                canvas->drawLine(pts[0], pts[1], dashPaint);
+
+                SkPath dashed;
+                skpathutils::FillPathWithPaint(SkPath::Line(pts[0], pts[1]), dashPaint, &dashed);
+                canvas->save();
+                canvas->translate(0, 8);
+                canvas->drawPath(dashed, fillPaint);
+                canvas->restore();
+
+                // The same, vertically and scaled.
+                canvas->save();
+                canvas->translate(260 + 30 * (&pattern - kPatterns), 0);
+                canvas->scale(1.5f, 1.5f);
+                canvas->rotate(90);
+                canvas->drawLine({0, 0}, {20, 0}, dashPaint);
+                skpathutils::FillPathWithPaint(SkPath::Line({0, 0}, {20, 0}), dashPaint, &dashed);
+                canvas->translate(0, -6);
+                canvas->drawPath(dashed, fillPaint);
+                canvas->restore();
+
+                canvas->translate(0, 24);
+            }
+        }
+    }
+}
+
 DEF_SIMPLE_GM(path_effect_empty_result, canvas, 100, 100) {
     SkPaint p;
     p.setStroke(true);
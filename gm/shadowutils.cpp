@@ -332,3 +332,61 @@ DEF_SIMPLE_GM(shadow_utils_directional, canvas, 256, 384) {
     }
 
 }
+
+// Convex polygons get analytic shadows on Ganesh. Each column draws a polygon's shadow in the top
+// row the default way, and in the row below with kGeometricOnly_ShadowFlag, which always uses the
+// tessellated shadows the analytic ones should match. The last column is too thin for its umbra,
+// so both rows are tessellated.
+DEF_SIMPLE_GM(shadow_utils_convex_polygons, canvas, 640, 600) {
+    static constexpr SkScalar kLightR = 30.f;
+    static constexpr SkScalar kHeight = 16.f;
+    const SkPoint3 lightPos = {320, -100, 600};
+    const SkColor ambientColor = SkColorSetARGB(0.1f * 255, 0, 0, 0);
+    const SkColor spotColor = SkColorSetARGB(0.35f * 255, 0, 0, 0);
+
+    TArray<SkPath> paths;
+    paths.push_back(SkPath::Polygon({{0, 60}, {35, 0}, {70, 60}}, true));
+    paths.push_back(SkPath::Polygon({{35, 0}, {70, 25}, {57, 65}, {13, 65}, {0, 25}}, true));
+    paths.push_back(SkPath::Polygon({{20, 0}, {60, 0}, {80, 35}, {60, 70}, {20, 70}, {0, 35}},
+                                    true));
+    paths.push_back(SkPath::Polygon({{0, 10}, {70, 0}, {60, 50}, {10, 70}}, true));
+    paths.push_back(SkPath::Polygon({{0, 0}, {70, 66}, {66, 70}}, true));
+
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    paint.setColor(SK_ColorWHITE);
+
+    // Plain, rotated, scaled, and with a transparent occluder and a directional light.
+    const uint32_t flags[] = {kNone_ShadowFlag,
+                              kNone_ShadowFlag,
+                              kNone_ShadowFlag,
+                              kTransparentOccluder_ShadowFlag,
+                              kDirectionalLight_ShadowFlag};
+    for (int row = 0; row < 10; ++row) {
+        const int variant = row / 2;
+        const bool geometricOnly = row % 2;
+        for (int i = 0; i < paths.size(); ++i) {
+            canvas->save();
+            canvas->translate(30 + 120 * i, 15 + 58 * row);
+            canvas->scale(0.6f, 0.6f);
+            if (variant == 1) {
+                canvas->rotate(30, 35, 35);
+            } else if (variant == 2) {
+                canvas->scale(0.5f, 0.5f);
+            }
+            SkPoint3 light = lightPos;
+            if (flags[variant] & kDirectionalLight_ShadowFlag) {
+                light = {-0.4f, -0.4f, 0.8f};
+            }
+            SkShadowUtils::DrawShadow(canvas, paths[i], SkPoint3{0, 0, kHeight}, light,
+                                      flags[variant] & kDirectionalLight_ShadowFlag ? 1.f : kLightR,
+                                      ambientColor, spotColor,
+                                      flags[variant] | (geometricOnly ? kGeometricOnly_ShadowFlag
+                                                                      : kNone_ShadowFlag));
+            if (!(flags[variant] & kTransparentOccluder_ShadowFlag)) {
+                canvas->drawPath(paths[i], paint);
+            }
+            canvas->restore();
+        }
+    }
+}
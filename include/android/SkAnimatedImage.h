@@ -14,9 +14,15 @@
 #include "include/core/SkMatrix.h"
 #include "include/core/SkRect.h"
 
+#include <cstddef>
+#include <memory>
+#include <vector>
+
 class SkAndroidCodec;
+class SkExecutor;
 class SkImage;
 class SkPicture;
+class SkTaskGroup;
 
 /**
  *  Thread unsafe drawable for drawing animated images (e.g. GIF).
@@ -110,6 +116,37 @@ public:
      */
     int getFrameCount() const { return fFrameCount; }
 
+    /**
+     *  Make frameIndex the current frame, decoding it from the closest frame
+     *  that is already decoded (or cached) and that it can be built on.
+     *
+     *  Returns how long to display the frame, or kFinished if it cannot be
+     *  decoded. Does not change the number of repetitions completed.
+     */
+    int seekFrame(int frameIndex);
+
+    /**
+     *  Keep up to this many bytes of decoded frames, so that seekFrame() and
+     *  later repetitions can reuse them instead of decoding again. Frames that
+     *  do not depend on earlier frames are kept in preference to recently
+     *  decoded ones.
+     *
+     *  Defaults to zero, which only keeps the few frames needed to decode the
+     *  next one.
+     */
+    void setFrameCacheBudget(size_t bytes);
+
+    size_t getFrameCacheBudget() const { return fFrameCacheBudget; }
+
+    /**
+     *  If executor is not null, the frame after the current one is decoded on
+     *  it while the current one is shown, so that the next decodeNextFrame()
+     *  only has to swap it in. This holds one extra frame in memory.
+     *
+     *  The executor must outlive this object, or be replaced first.
+     */
+    void setLookaheadExecutor(SkExecutor* executor);
+
 protected:
     SkRect onGetBounds() override;
     void onDraw(SkCanvas*) override;
@@ -137,6 +174,11 @@ private:
         bool copyTo(Frame*) const;
     };
 
+    struct CachedFrame {
+        Frame fFrame;
+        bool  fIndependent;
+    };
+
     std::unique_ptr<SkAndroidCodec> fCodec;
           SkImageInfo               fDecodeInfo;
     const SkIRect                   fCropRect;
@@ -153,12 +195,43 @@ private:
     int                             fRepetitionCount;
     int                             fRepetitionsCompleted;
 
+    // Least recently used first. The bitmaps may share pixels with the frames above;
+    // Frame::init() copies them before they are overwritten.
+    std::vector<CachedFrame>        fFrameCache;
+    size_t                          fFrameCacheBytes = 0;
+    size_t                          fFrameCacheBudget = 0;
+
+    // Only touched by the lookahead task while one is pending.
+    Frame                           fLookaheadFrame;
+    SkExecutor*                     fLookaheadExecutor = nullptr;
+    std::unique_ptr<SkTaskGroup>    fLookahead;
+
     SkAnimatedImage(std::unique_ptr<SkAndroidCodec>, const SkImageInfo& requestedInfo,
             SkIRect cropRect, sk_sp<SkPicture> postProcess);
 
     int computeNextFrame(int current, bool* animationEnded);
     double finish();
 
+    /**
+     *  Make frameToDecode the display frame, reusing a decoded or cached frame
+     *  where possible. Returns false on failure.
+     */
+    bool showFrame(int frameToDecode, int requiredFrame, SkAlphaType,
+                   SkCodecAnimation::DisposalMethod);
+
+    // Whether frameIndex is one of the frames above or is cached.
+    bool isDecoded(int frameIndex) const;
+    // Whether a frame that frameToDecode can be decoded on top of is decoded or cached.
+    bool hasPriorFrame(int frameToDecode, int requiredFrame) const;
+
+    const Frame* findCachedFrame(int frameIndex);
+    const Frame* findCachedPriorFrame(int frameToDecode, int requiredFrame);
+    void cacheFrame(const Frame&, bool independent);
+    void trimFrameCache();
+
+    void startLookahead();
+    void waitForLookahead();
+
     /**
      *  True if there is no crop, orientation, or post decoding scaling.
      */
@@ -19,6 +19,7 @@
 #include "include/core/SkYUVAPixmaps.h"
 #include "include/private/SkEncodedInfo.h"
 #include "include/private/base/SkNoncopyable.h"
+#include "include/private/base/SkTemplates.h"
 #include "modules/skcms/skcms.h"
 
 #include <cstddef>
@@ -30,6 +31,7 @@
 #include <vector>
 
 class SkData;
+class SkExecutor;
 class SkFrameHolder;
 class SkImage;
 class SkPngChunkReader;
@@ -324,6 +326,7 @@ public:
             , fSubset(nullptr)
             , fFrameIndex(0)
             , fPriorFrame(kNoFrame)
+            , fExecutor(nullptr)
         {}
 
         ZeroInitialized            fZeroInitialized;
@@ -367,6 +370,22 @@ public:
          *  If set to kNoFrame, the codec will decode any necessary required frame(s) first.
          */
         int                        fPriorFrame;
+
+        /**
+         *  If not NULL, getPixels may use this executor to decode parts of the image
+         *  concurrently. The decode still completes before getPixels returns.
+         *
+         *  Currently used by:
+         *  - the JPEG codec, for baseline images whose restart interval is a whole
+         *    number of MCU rows.
+         *  - the JPEG XL codec, which runs libjxl's parallel loops on the executor.
+         *  - the AVIF codec, which cannot use the executor itself but lets libavif's
+         *    AV1 decoder use one thread per core instead of one.
+         *  - the RAW codec, which runs the DNG SDK's area tasks and the conversion
+         *    into the destination on the executor.
+         *  Ignored by incremental and scanline decodes.
+         */
+        SkExecutor*                fExecutor;
     };
 
     /**
@@ -937,6 +956,9 @@ private:
     XformFormat                        fDstXformFormat; // Based on fDstInfo.
     skcms_ICCProfile                   fDstProfile;
     skcms_AlphaFormat                  fDstXformAlphaFormat;
+    // fSrcXformFormat to the destination above, planned once per decode.
+    std::unique_ptr<skcms_CompiledTransform, SkFunctionObject<skcms_FreeCompiledTransform>>
+                                       fColorXform;
 
     // Only meaningful during scanline decodes.
     int fCurrScanline = -1;
@@ -948,6 +970,7 @@ private:
     bool fUsingCallbackForHandleFrameIndex = false;
 
     bool initializeColorXform(const SkImageInfo& dstInfo, SkEncodedInfo::Alpha, bool srcIsOpaque);
+    void compileColorXform();
 
     /**
      *  Return whether these dimensions are supported as a scale.
@@ -26,12 +26,25 @@ inline bool IsRaw(const void*, size_t) {
     return true;
 }
 
+/**
+ *  Options for Decode(), passed as a pointer in its DecodeContext.
+ */
+struct DecodeOptions {
+    /**
+     *  If true, downscaled decodes of a DNG that are no larger than its embedded JPEG thumbnail
+     *  decode and resample the thumbnail instead of rendering the raw data. The thumbnail is the
+     *  camera's own rendering, so it may not match a full decode; only use it for previews.
+     */
+    bool fUseEmbeddedThumbnail = false;
+};
+
 /**
  *  Attempts to decode the given bytes as a raw image.
  *
  *  If the bytes are not a raw, returns nullptr.
  *
- *  DecodeContext is ignored
+ *  DecodeContext may be nullptr or a const DecodeOptions*. SkCodec::MakeFromStream() and
+ *  SkCodec::MakeFromData() always pass nullptr.
  */
 SK_API std::unique_ptr<SkCodec> Decode(std::unique_ptr<SkStream>,
                                        SkCodec::Result*,
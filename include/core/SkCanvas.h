@@ -2372,9 +2372,15 @@ private:
     // notify our surface (if we have one) that we are about to draw, so it
     // can perform copy-on-write or invalidate any cached images
     // returns false if the copy failed
-    [[nodiscard]] bool predrawNotify(bool willOverwritesEntireSurface = false);
+    // 'deviceBounds' limits the change to the surface; by default it is the clip bounds.
+    [[nodiscard]] bool predrawNotify(bool willOverwritesEntireSurface = false,
+                                     const SkIRect* deviceBounds = nullptr);
     [[nodiscard]] bool predrawNotify(const SkRect*, const SkPaint*, SkEnumBitMask<PredrawFlags>);
 
+    // Conservative bounds, in base device space, of what a draw of 'rect' (if known) with 'paint'
+    // (if known) can change. Empty while drawing into a layer, since restoring it draws again.
+    SkIRect surfaceDirtyBounds(const SkRect* rect, const SkPaint* paint) const;
+
     // call the appropriate predrawNotify and create a layer if needed.
     std::optional<AutoLayerForImageFilter> aboutToDraw(
             const SkPaint& paint,
@@ -11,9 +11,13 @@
 #include "include/core/SkPoint.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkScalar.h"
+#include "include/core/SkSpan.h"
 #include "include/private/base/SkAPI.h"
+#include "include/private/base/SkOnce.h"
 #include "include/private/base/SkTDArray.h"
 
+#include <cstdint>
+
 #include <memory>
 
 class SkMatrix;
@@ -30,6 +34,16 @@ public:
      */
     [[nodiscard]] bool getPosTan(SkScalar distance, SkPoint* position, SkVector* tangent) const;
 
+    /** Like calling getPosTan() for each of distances, but faster when the distances are in
+     *  increasing order, since each one continues from where the last one was found.
+     *  positions and tangents may each be empty, or as long as distances.
+     *
+     *  Returns false if any distance fails, leaving its position and tangent unchanged.
+     */
+    [[nodiscard]] bool getPosTans(SkSpan<const SkScalar> distances,
+                                  SkSpan<SkPoint> positions,
+                                  SkSpan<SkVector> tangents) const;
+
     enum MatrixFlags {
         kGetPosition_MatrixFlag     = 0x01,
         kGetTangent_MatrixFlag      = 0x02,
@@ -83,11 +97,20 @@ private:
     const SkScalar fLength;
     const bool fIsClosed;
 
+    // For long contours, built on first use: fSegmentIndex[i] is the first segment that ends at or
+    // after distance i * fLength / fSegmentIndex.size(), so a lookup only searches the segments
+    // between two entries.
+    mutable SkOnce fSegmentIndexOnce;
+    mutable SkTDArray<uint32_t> fSegmentIndex;
+
     SkContourMeasure(SkTDArray<Segment>&& segs, SkTDArray<SkPoint>&& pts,
                      SkScalar length, bool isClosed);
     ~SkContourMeasure() override {}
 
     const Segment* distanceToSegment(SkScalar distance, SkScalar* t) const;
+    int distanceToSegmentIndex(SkScalar distance) const;
+    SkScalar segmentT(int index, SkScalar distance) const;
+    void buildSegmentIndex() const;
 
     friend class SkContourMeasureIter;
     friend class SkPathMeasurePriv;
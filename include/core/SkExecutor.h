@@ -10,6 +10,7 @@
 
 #include <functional>
 #include <memory>
+#include <utility>
 #include "include/core/SkTypes.h"
 
 class SK_API SkExecutor {
@@ -22,6 +23,14 @@ public:
     static std::unique_ptr<SkExecutor> MakeLIFOThreadPool(int threads = 0,
                                                           bool allowBorrowing = true);
 
+    // Create a work-stealing thread pool SkExecutor.  Each worker thread owns a deque of work:
+    // work added from a worker thread is pushed onto that thread's deque and popped LIFO, and idle
+    // workers steal FIFO from the other deques.  Work added from other threads goes through a
+    // shared injection queue.  This scales better than the FIFO/LIFO pools when many small tasks
+    // are added concurrently, e.g. nested SkTaskGroup::batch() calls.
+    static std::unique_ptr<SkExecutor> MakeWorkStealingThreadPool(int threads = 0,
+                                                                  bool allowBorrowing = true);
+
     // There is always a default SkExecutor available by calling SkExecutor::GetDefault().
     static SkExecutor& GetDefault();
     static void SetDefault(SkExecutor*);  // Does not take ownership.  Not thread safe.
@@ -29,6 +38,18 @@ public:
     // Add work to execute.
     virtual void add(std::function<void(void)>) = 0;
 
+    enum class Priority {
+        kLow,     // Background work (e.g. encoding) that should yield to everything else.
+        kNormal,  // The priority of work passed to add().
+        kHigh,    // Latency-critical work (e.g. rasterization) that should run first.
+    };
+
+    // Add work to execute with a scheduling hint.  Executors that do not support priorities
+    // treat this exactly like add().
+    virtual void addWithPriority(std::function<void(void)> work, Priority) {
+        this->add(std::move(work));
+    }
+
     // If it makes sense for this executor, use this thread to execute work for a little while.
     virtual void borrow() {}
 
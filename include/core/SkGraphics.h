@@ -16,6 +16,7 @@
 #include <memory>
 
 class SkData;
+class SkExecutor;
 class SkImageGenerator;
 class SkOpenTypeSVGDecoder;
 class SkTraceMemoryDump;
@@ -126,6 +127,256 @@ public:
     static size_t GetResourceCacheSingleAllocationByteLimit();
     static size_t SetResourceCacheSingleAllocationByteLimit(size_t newLimit);
 
+    /**
+     *  The resource cache can be split into several shards, each with its own lock and its own
+     *  equal part of the total byte limit, so that threads using different entries do not
+     *  contend. The default is a single shard; at most 64 are used. Changing the count purges
+     *  the cache. SetResourceCacheShardCount() returns the previous count.
+     */
+    static int GetResourceCacheShardCount();
+    static int SetResourceCacheShardCount(int count);
+
+    struct ResourceCacheShardStats {
+        size_t   fBytesUsed;
+        size_t   fByteLimit;
+        int      fCount;
+        uint64_t fHitCount;
+        uint64_t fMissCount;
+    };
+    /**
+     *  Returns the memory use, entry count and lookup hits and misses of one shard of the
+     *  resource cache. Shards past the shard count are empty, unless some of their entries were
+     *  still in use when the count changed.
+     */
+    static ResourceCacheShardStats GetResourceCacheShardStats(int shardIndex);
+
+    /**
+     *  The CPU backend keeps recently compiled raster pipeline programs so that later draws with
+     *  the same structure (but different colors, images, etc.) only need to rebind their data.
+     *  These functions get/set the number of programs kept, and report how many are cached and
+     *  how many compiles found (hit) or did not find (miss) their program in the cache.
+     */
+    static int GetRasterPipelineCacheCountLimit();
+    static int SetRasterPipelineCacheCountLimit(int count);
+    static int GetRasterPipelineCacheCountUsed();
+    static uint64_t GetRasterPipelineCacheHitCount();
+    static uint64_t GetRasterPipelineCacheMissCount();
+
+    /**
+     *  Skia caches the runtime effects it compiles for its own shaders, color filters, blenders and
+     *  image filters, including the ones in deserialized pictures. These functions get/set the
+     *  most effects kept and an estimate of the most memory they may use, and report how many are
+     *  cached and their estimated memory. Setting either limit to 0 turns the cache off.
+     */
+    static int GetRuntimeEffectCacheCountLimit();
+    static int SetRuntimeEffectCacheCountLimit(int count);
+    static size_t GetRuntimeEffectCacheByteLimit();
+    static size_t SetRuntimeEffectCacheByteLimit(size_t bytes);
+    static int GetRuntimeEffectCacheCountUsed();
+    static size_t GetRuntimeEffectCacheBytesUsed();
+
+    /**
+     *  While enabled, the CPU backend counts the pixels each runtime effect shades and the time
+     *  spent running its stages, including any children it samples. Only draws set up after
+     *  profiling is enabled are counted. Profiled effects always run in high precision, and pay
+     *  for reading the clock twice per group of pixels, so this is off by default.
+     *  SetRuntimeEffectProfiling() returns the previous setting.
+     *
+     *  DumpRuntimeEffectProfile() reports one "skia/sk_runtime_effect/<hash>" dump per effect that
+     *  has been profiled, with its "pixels" and "time" (in nanoseconds), and its SkSL as "sksl".
+     *  Pixels are counted in whole groups of the pipeline's SIMD width, so partial groups at the
+     *  end of a span count in full. ResetRuntimeEffectProfile() sets every count back to zero.
+     */
+    static bool GetRuntimeEffectProfiling();
+    static bool SetRuntimeEffectProfiling(bool enabled);
+    static void DumpRuntimeEffectProfile(SkTraceMemoryDump* dump);
+    static void ResetRuntimeEffectProfile();
+
+    /**
+     *  Lets the CPU backend fill very large anti-aliased paths in horizontal bands, one task per
+     *  band on the given executor. Only paths with at least minPointCount points whose clipped
+     *  bounds cover at least minPixelCount pixels are split. The result matches filling the path
+     *  once per band with a clip to that band, which can differ slightly from a single unclipped
+     *  fill where edges are steep or very close together. Tall fills are split into passes that
+     *  each hold the coverage of at most 16MB of pixels. Passing nullptr (the default) turns this
+     *  off. The executor must outlive any drawing that may use it.
+     */
+    static void SetParallelPathFill(SkExecutor*,
+                                    int minPointCount = 10000,
+                                    int64_t minPixelCount = 1024 * 1024);
+
+    /**
+     *  Lets the CPU backend split pixel conversions that go through its general pipeline, such as
+     *  SkPixmap::readPixels() between color spaces or from F16 to 8888, into bands of rows on the
+     *  given executor. Only images with at least minPixelCount pixels are split, and the result is
+     *  the same as converting on one thread. Passing nullptr (the default) turns this off. The
+     *  executor must outlive any conversion that may use it.
+     */
+    static void SetParallelPixelConversion(SkExecutor*, int64_t minPixelCount = 2048 * 2048);
+
+    /**
+     *  Lets the CPU backend evaluate the independent inputs of merge and blend image filters
+     *  concurrently on the given executor, such as the shadow and blur branches of a merge. The
+     *  result is the same as evaluating them in order. Passing nullptr (the default) turns this
+     *  off. The executor must outlive any drawing that may use it.
+     */
+    static void SetParallelImageFilters(SkExecutor*);
+
+    /**
+     *  Lets the CPU backend evaluate image filters on layers larger than tileSize in either
+     *  dimension in square tiles of that size, so that intermediate images are bounded by a tile
+     *  (plus the filters' own outsets) instead of by the whole layer. With an executor set by
+     *  SetParallelImageFilters(), a few tiles are filtered at once. Only layers drawn without
+     *  scaling or rotation are tiled. Passing 0 (the default) turns this off.
+     */
+    static void SetImageFilterTileSize(int tileSize);
+
+    /**
+     *  Controls the cache of image filter results used by CPU drawing. With content keys, results
+     *  are keyed by the structure and parameters of the filter graph (with images and pictures
+     *  identified by their unique IDs) instead of by the filter object. Filters that are recreated
+     *  identically, e.g. by re-recording a picture every frame, then reuse each other's results
+     *  for the same source and transform. Content keys are off by default.
+     *
+     *  The byte limit is strict: results are purged until the cache fits, and a result larger than
+     *  the whole limit is not cached. SetImageFilterCacheByteLimit() returns the previous limit.
+     */
+    static void SetImageFilterCacheContentKeys(bool enabled);
+    static size_t SetImageFilterCacheByteLimit(size_t newLimit);
+
+    struct ImageFilterCacheStats {
+        size_t   fBytesUsed = 0;
+        size_t   fByteLimit = 0;
+        int      fEntryCount = 0;
+        uint64_t fHits = 0;    // lookups that found a cached result
+        uint64_t fMisses = 0;  // lookups that did not
+    };
+    static ImageFilterCacheStats GetImageFilterCacheStats();
+
+    /**
+     *  Lets the CPU backend draw gradients with more than two stops, or with explicit positions,
+     *  by sampling a cached table of 1024 colors instead of searching the stops for every pixel.
+     *  The table is built in the destination color space, so most such gradients can use the
+     *  faster low-precision pipeline. It is only used for destinations with at most 8 bits per
+     *  channel, and may differ from the exact colors by about one step. Off by default.
+     */
+    static void SetRasterGradientLUT(bool enabled);
+
+    /**
+     *  Lets the CPU backend draw Perlin noise and turbulence shaders that stitch tiles by shading
+     *  one tile into an image, kept in the resource cache by the shader's parameters, and then
+     *  repeating that image. The tile must have at most 1024 * 1024 pixels and the destination at
+     *  most 8 bits per channel. Static noise backgrounds then cost an image draw per frame. Off by
+     *  default.
+     */
+    static void SetRasterNoiseTileCache(bool enabled);
+
+    /**
+     *  Lets the CPU backend draw lazy images whose generators decode to 8-bit YUVA planes (e.g.
+     *  JPEG and video frames) by sampling the planes and converting to RGB per pixel, instead of
+     *  first decoding the whole image to RGBA. Applies to clamped, non-cubic, non-mipmapped
+     *  sampling of images with centered chroma siting and no encoded orientation. Off by default.
+     */
+    static void SetRasterYUVAPlanarSampling(bool enabled);
+
+    /**
+     *  Lets the CPU backend reuse the pixel memory of destroyed layers for later saveLayer()s,
+     *  instead of allocating and clearing new memory for each one. Memory is pooled in size classes
+     *  at most 25% larger than a layer needs, and a reused block is only cleared as far as earlier
+     *  layers used it. The limit bounds the free memory kept by the pool; memory held by live
+     *  layers doesn't count. Setting the limit to 0 (the default) turns pooling off.
+     *  SetRasterLayerPoolByteLimit() returns the previous limit.
+     *
+     *  The stats report the peak memory held by live layers since the last PurgeAllCaches(), which
+     *  also frees the pooled memory.
+     */
+    static size_t SetRasterLayerPoolByteLimit(size_t newLimit);
+
+    struct RasterLayerPoolStats {
+        size_t   fBytesPooled = 0;      // free memory kept for later layers
+        size_t   fBytesInUse = 0;       // memory held by live layers
+        size_t   fPeakBytesInUse = 0;
+        uint64_t fReuses = 0;           // layers given pooled memory
+        uint64_t fAllocations = 0;      // layers given new memory
+    };
+    static RasterLayerPoolStats GetRasterLayerPoolStats();
+
+    /**
+     *  Lets the CPU backend cache pictures and drawables that are drawn the same way over and over
+     *  as layers. Once drawPicture() or drawDrawable() has drawn one with the same scale, skew and
+     *  subpixel offset a few times, its whole cull rect (or bounds) is drawn into a layer, which
+     *  later draws composite instead of replaying it, even if the clip or whole-pixel translate
+     *  changed. Pictures small enough for drawPicture() to unroll, perspective, and paints with
+     *  image or mask filters are never cached. Drawables must report bounds that cover what they
+     *  draw, and call notifyDrawingChanged() when it changes.
+     *
+     *  A cached picture is drawn as if into a saveLayer(), so blend modes in it that read what was
+     *  drawn below it won't see those pixels.
+     *
+     *  The limit bounds the memory held by cached layers. Setting it to 0 (the default) turns the
+     *  cache off. SetPictureLayerCacheByteLimit() returns the previous limit.
+     */
+    static size_t SetPictureLayerCacheByteLimit(size_t newLimit);
+
+    struct PictureLayerCacheStats {
+        size_t   fBytesUsed = 0;   // memory held by cached layers
+        int      fCount = 0;       // cached layers
+        uint64_t fHits = 0;        // draws composited from a cached layer
+        uint64_t fMisses = 0;      // draws replayed because they had not been promoted yet
+        uint64_t fPromotions = 0;  // layers drawn and cached
+    };
+    static PictureLayerCacheStats GetPictureLayerCacheStats();
+
+    /**
+     *  Allocates the pixels of raster surfaces and bitmaps (everything SkMallocPixelRef::
+     *  MakeAllocate() allocates) of at least fMinBytes. fAlloc must return zeroed memory, or null
+     *  to fall back to the default allocator. fFree is passed the size given to fAlloc. Pixels are
+     *  freed by the allocator that allocated them, even if it has since been replaced.
+     */
+    struct RasterPixelAllocator {
+        void*  (*fAlloc)(size_t bytes, void* ctx) = nullptr;
+        void   (*fFree)(void* pixels, size_t bytes, void* ctx) = nullptr;
+        void*  fCtx = nullptr;
+        size_t fMinBytes = 0;
+    };
+
+    /**
+     *  Sets the allocator for large raster pixels, and returns the previous one. An allocator
+     *  with a null fAlloc (the default) means all pixels come from sk_calloc().
+     */
+    static RasterPixelAllocator SetRasterPixelAllocator(const RasterPixelAllocator&);
+
+    /**
+     *  Returns a built-in allocator for pixels of at least 'minBytes', meant for very large
+     *  surfaces. On Linux and Android it maps memory aligned to 2MB and asks the kernel to back it
+     *  with transparent huge pages, which cuts TLB misses when rasterizing. The memory is not
+     *  touched when allocated, so on NUMA systems each page lands on the node of the thread that
+     *  first writes it; SkSurfaces::RasterThreaded() first writes each band of tiles from its
+     *  executor, spreading the surface across the nodes its workers run on. Elsewhere this
+     *  allocator always falls back to the default.
+     */
+    static RasterPixelAllocator HugePageRasterPixelAllocator(size_t minBytes = 8 * 1024 * 1024);
+
+    /**
+     *  Lets short-lived allocation arenas, such as those made while setting up each draw, reuse
+     *  the memory blocks recently freed by other arenas on the same thread instead of allocating
+     *  new ones. Each thread keeps at most 256KB of blocks, which are freed when the thread exits,
+     *  when this is turned off (on the calling thread), or by PurgeAllCaches() (on the calling
+     *  thread). Off by default.
+     */
+    static void SetArenaBlockRecycling(bool enabled);
+
+    /**
+     *  Counts the current and peak memory allocated by subsystems that the caches don't cover:
+     *  allocation arenas, recorded pictures, PDF streams waiting to be written out, and codecs'
+     *  row buffers. DumpMemoryStatistics() reports them as "size" and "peak_size" under
+     *  "skia/sk_allocations/<subsystem>". ResetMemoryHighWaterMarks() starts the peaks over from
+     *  the current sizes, e.g. at the start of each frame. Memory allocated while counting is off
+     *  (the default) isn't counted.
+     */
+    static void SetMemoryAccounting(bool enabled);
+    static void ResetMemoryHighWaterMarks();
+
     /**
      *  Dumps memory usage of caches using the SkTraceMemoryDump interface. See SkTraceMemoryDump
      *  for usage of this method.
@@ -25,6 +25,7 @@ class GrRecordingContext;
 class SkBitmap;
 class SkColorSpace;
 class SkData;
+class SkExecutor;
 class SkImage;
 class SkImageFilter;
 class SkImageGenerator;
@@ -849,6 +850,15 @@ public:
     */
     virtual bool isLazyGenerated() const = 0;
 
+    /** If SkImage is lazy-generated, decodes its pixels into the raster cache on |executor|, so
+        a later draw or readPixels() finds them there. If that draw starts before the decode
+        finishes, it waits for the decode rather than starting another one. Does nothing for
+        other images.
+
+        @param executor  where to decode; if nullptr, SkExecutor::GetDefault()
+    */
+    void prefetchDecode(SkExecutor* executor = nullptr) const;
+
     /** Creates SkImage in target SkColorSpace.
         Returns nullptr if SkImage could not be created.
 
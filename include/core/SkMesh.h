@@ -259,6 +259,14 @@ private:
  * Both Make() and MakeIndexed() take a SkData with the uniform values. See
  * SkMeshSpecification::uniformSize() and SkMeshSpecification::uniforms() for sizing and packing
  * uniforms into the SkData.
+ *
+ * Consecutive draws of meshes that share a specification, uniform values, paint and matrix, and
+ * have no children, are batched on the GPU. This suits workloads such as particles or map markers
+ * that draw many small meshes: build them with one SkMeshSpecification and put any per-mesh data
+ * in vertex attributes rather than uniforms. Batched meshes with GPU buffers (see
+ * SkMeshes::MakeVertexBuffer) are drawn from those buffers, one draw call each, without changing
+ * programs in between. Batched triangle meshes with CPU buffers are uploaded together and drawn
+ * with one draw call.
  */
 class SK_API SkMesh {
 public:
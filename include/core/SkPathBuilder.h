@@ -20,6 +20,7 @@
 
 #include <initializer_list>
 
+class SkArenaAlloc;
 class SkRRect;
 
 class SK_API SkPathBuilder {
@@ -27,6 +28,11 @@ public:
     SkPathBuilder();
     SkPathBuilder(SkPathFillType);
     SkPathBuilder(const SkPath&);
+    // Paths returned by snapshot() and detach() keep their points and verbs in 'arena' instead
+    // of on the heap, and are cheap to make, draw and drop. They must be destroyed before the
+    // arena is. Copying or editing such a path first copies it to the heap, so copies (including
+    // those that pictures and GPU backends keep of the paths drawn) don't depend on the arena.
+    explicit SkPathBuilder(SkArenaAlloc* arena);
     SkPathBuilder(const SkPathBuilder&) = default;
     ~SkPathBuilder();
 
@@ -234,6 +240,7 @@ private:
 
     SkPathFillType      fFillType;
     bool                fIsVolatile;
+    SkArenaAlloc*       fArena = nullptr;
 
     unsigned    fSegmentMask;
     SkPoint     fLastMovePoint;
@@ -261,6 +268,7 @@ private:
     }
 
     SkPath make(sk_sp<SkPathRef>) const;
+    sk_sp<SkPathRef> makeArenaPathRef() const;
 
     SkPathBuilder& privateReverseAddPath(const SkPath&);
 
@@ -19,6 +19,7 @@
 
 class SkCanvas;
 class SkData;
+class SkExecutor;
 class SkMatrix;
 class SkStream;
 class SkWStream;
@@ -70,6 +71,10 @@ public:
         may be used to provide user context to procs->fPictureProc; procs->fPictureProc
         is called with a pointer to data, data byte length, and user context.
 
+        The drawing commands and most other serialized content are read where they are in
+        data rather than copied out first, so data may usefully be a memory-mapped file,
+        e.g. from SkData::MakeFromFileName().
+
         @param data   container for serial data
         @param procs  custom serial data decoders; may be nullptr
         @return       SkPicture constructed from data
@@ -135,6 +140,23 @@ public:
     */
     virtual void playback(SkCanvas* canvas, AbortCallback* callback = nullptr) const = 0;
 
+    /** Replays the drawing commands into several canvases concurrently, one task per canvas on
+        executor. canvases[i] is clipped to tiles[i], given in the local coordinates of
+        canvases[i]'s current matrix, and is sent only the commands that can draw inside it: the
+        bounding box hierarchy the picture was recorded with, or a temporary SkRTree shared by all
+        tiles if it was recorded without one, is searched once per tile.
+
+        Each canvas must be distinct and safe to draw to from any thread (e.g. raster canvases
+        over non-overlapping pixels). Returns once every canvas has been drawn.
+
+        @param canvases  receivers of drawing commands, one per tile
+        @param tiles     clip for each canvas, in picture coordinates
+        @param count     number of entries in canvases and tiles
+        @param executor  runs the playbacks; if nullptr, SkExecutor::GetDefault() is used
+    */
+    void playbackParallel(SkCanvas* const canvases[], const SkRect tiles[], int count,
+                          SkExecutor* executor = nullptr) const;
+
     /** Returns cull SkRect for this picture, passed in when SkPicture was created.
         Returned SkRect does not specify clipping SkRect for SkPicture; cull is hint
         of SkPicture bounds.
@@ -90,6 +90,15 @@ public:
      */
     sk_sp<SkDrawable> finishRecordingAsDrawable();
 
+    /**
+     *  Controls whether this recorder recycles recording storage between recordings. When enabled,
+     *  the recorder keeps a reference to the storage behind the last picture or drawable it
+     *  finished. If the caller has released that result by the next beginRecording(), the storage
+     *  is reused as-is; otherwise new storage is preallocated to the same size. This suits
+     *  callers that record a similar picture every frame. Disabled by default.
+     */
+    void setRecycleStorage(bool recycle);
+
 private:
     void reset();
 
@@ -107,6 +116,8 @@ private:
     sk_sp<SkBBoxHierarchy>      fBBH;
     std::unique_ptr<SkRecorder> fRecorder;
     sk_sp<SkRecord>             fRecord;
+    sk_sp<SkRecord>             fRecycledRecord;
+    bool                        fRecycleStorage = false;
 
     SkPictureRecorder(SkPictureRecorder&&) = delete;
     SkPictureRecorder& operator=(SkPictureRecorder&&) = delete;
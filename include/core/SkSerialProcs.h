@@ -12,9 +12,11 @@
 #include "include/private/base/SkAPI.h"
 
 #include <cstddef>
+#include <cstdint>
 #include <optional>
 
 class SkData;
+class SkExecutor;
 class SkImage;
 class SkPicture;
 class SkTypeface;
@@ -92,6 +94,13 @@ struct SK_API SkSerialProcs {
 
     SkSerialTypefaceProc fTypefaceProc = nullptr;
     void*                fTypefaceCtx = nullptr;
+
+    // If set, SkPicture::serialize() encodes the images drawn by the picture and its sub-pictures
+    // concurrently on this executor, while it writes the rest of the picture, and encodes images
+    // with identical contents only once. fImageProc is then called from the executor's threads,
+    // and may be called once for several identical images. The output is the same as without an
+    // executor, other than those identical images sharing one encoding.
+    SkExecutor*          fImageExecutor = nullptr;
 };
 
 struct SK_API SkDeserialProcs {
@@ -112,6 +121,17 @@ struct SK_API SkDeserialProcs {
     // parameters and returns a bool). Given that there are only two valid implementations of that
     // proc, we just insert the bool directly.
     bool                         fAllowSkSL = true;
+
+    // Data this process serialized itself, e.g. into an in-memory cache, can be read without
+    // range-checking every field. To opt in, set this to Checksum() of the serialized data,
+    // computed when it was written. The whole checksum is verified once before reading, and the
+    // data must not change while it is read. Data whose checksum doesn't match is read with the
+    // usual checks. Honored by SkPicture::MakeFromData() and SkFlattenable::Deserialize() (and
+    // so the Deserialize() of each flattenable type); ignored everywhere else.
+    uint64_t                     fTrustedChecksum = 0;
+
+    // Never returns 0, which means "untrusted" above.
+    static uint64_t Checksum(const void* data, size_t length);
 };
 
 #endif
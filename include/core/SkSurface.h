@@ -30,7 +30,9 @@ class SkBitmap;
 class SkCanvas;
 class SkCapabilities;
 class SkColorSpace;
+class SkExecutor;
 class SkPaint;
+class SkRegion;
 class SkSurface;
 struct SkIRect;
 struct SkISize;
@@ -82,6 +84,29 @@ inline sk_sp<SkSurface> Raster(const SkImageInfo& imageInfo,
     return Raster(imageInfo, 0, props);
 }
 
+/** Allocates a raster SkSurface that rasterizes in parallel. Draws to its SkCanvas are recorded,
+    and rasterized when the surface contents are next needed (makeImageSnapshot(), peekPixels(),
+    readPixels(), writePixels() or draw()). At that point the recorded draws are split into
+    tileSize x tileSize tiles and the tiles are drawn concurrently on executor. The resulting
+    pixels are identical to those produced by a surface from Raster().
+
+    Draws made inside a saveLayer() that is still open are rasterized once the layer is restored.
+    The surface's SkCanvas does not have direct pixel access: use the SkSurface's peekPixels()
+    and readPixels() rather than the SkCanvas'.
+
+    @param imageInfo  width, height, SkColorType, SkAlphaType, SkColorSpace,
+                      of raster surface; width and height must be greater than zero
+    @param executor   runs the tiles; if nullptr, SkExecutor::GetDefault() is used
+    @param tileSize   width and height of each tile in pixels; must be greater than zero
+    @param props      LCD striping orientation and setting for device independent fonts;
+                      may be nullptr
+    @return           SkSurface if parameters are valid and memory was allocated, else nullptr.
+*/
+SK_API sk_sp<SkSurface> RasterThreaded(const SkImageInfo& imageInfo,
+                                       SkExecutor* executor,
+                                       int tileSize = 256,
+                                       const SkSurfaceProps* props = nullptr);
+
 /** Allocates raster SkSurface. SkCanvas returned by SkSurface draws directly into the
     provided pixels.
 
@@ -214,6 +239,20 @@ public:
     */
     void notifyContentWillChange(ContentChangeMode mode);
 
+    /** Returns the area of the surface, in device space, that has changed since the surface was
+        created or resetDirtyRegion() was last called. It is rounded out to 64 x 64 pixel tiles.
+        Each draw contributes its clip bounds, narrowed to its geometry when that is known.
+        writePixels() contributes the written rect. notifyContentWillChange() marks the whole
+        surface. Use this to present only the changed part of a frame.
+
+        @return  dirty area of the surface
+    */
+    SkRegion dirtyRegion() const;
+
+    /** Clears the area returned by dirtyRegion(), typically after presenting it.
+    */
+    void resetDirtyRegion();
+
     /** Returns the recording context being used by the SkSurface.
 
         @return the recording context, if available; nullptr otherwise
@@ -60,6 +60,10 @@ public:
         // If set, all rendering will have dithering enabled
         // Currently this only impacts GPU backends
         kAlwaysDither_Flag = 1 << 2,
+        // Raster surfaces keep the pixels given up when a snapshot forces a copy-on-write, and
+        // reuse them once that snapshot is gone, copying only the tiles drawn to since. This
+        // trades a second buffer for cheap snapshot-then-small-update frames.
+        kReuseSnapshotPixels_Flag = 1 << 3,
     };
 
     /** No flags, unknown pixel geometry, platform-default contrast/gamma. */
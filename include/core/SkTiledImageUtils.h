@@ -16,7 +16,9 @@
 #include "include/core/SkScalar.h"
 #include "include/private/base/SkAPI.h"
 
+#include <cstddef>
 #include <cstdint>
+#include <memory>
 
 class SkPaint;
 
@@ -38,6 +40,53 @@ SK_API void DrawImageRect(SkCanvas* canvas,
                           SkCanvas::SrcRectConstraint constraint =
                                   SkCanvas::kFast_SrcRectConstraint);
 
+/** \class SkTiledImageUtils::TileStreamer
+    Spreads the upload of a tiled image over several frames. Passed to DrawImageRect, it limits
+    the bytes of new tiles uploaded between calls to newFrame(). Tiles that don't fit in the
+    budget are drawn from a low-resolution copy of the image until a later frame uploads them, so
+    panning across a very large image never stalls on a burst of uploads.
+
+    A TileStreamer remembers which tiles it has let through, keyed by image and tile, and draws
+    them again without charging the budget. It forgets the least recently drawn ones once they add
+    up to more than tileCacheBytes, or half of the GPU resource cache if that is smaller.
+
+    A TileStreamer must only be used by one thread at a time.
+*/
+class SK_API TileStreamer {
+public:
+    static constexpr size_t kDefaultTileCacheBytes = 128 * 1024 * 1024;
+
+    static std::unique_ptr<TileStreamer> Make(size_t uploadBudgetPerFrame,
+                                              size_t tileCacheBytes = kDefaultTileCacheBytes);
+
+    virtual ~TileStreamer() = default;
+
+    /** Resets the upload budget. Call it once at the start of each frame. */
+    virtual void newFrame() = 0;
+
+    /** The bytes of new tiles and placeholders drawn since newFrame(). */
+    virtual size_t bytesUploadedThisFrame() const = 0;
+
+    /** The tiles drawn from a placeholder since newFrame(). While this is non-zero, the client
+        should keep drawing frames so the remaining tiles stream in. */
+    virtual int placeholderTilesThisFrame() const = 0;
+
+protected:
+    TileStreamer() = default;
+};
+
+/** Like DrawImageRect above, but if the image is drawn as tiles their upload is paced by
+    'streamer'. A null 'streamer' uploads every tile right away.
+*/
+SK_API void DrawImageRect(SkCanvas* canvas,
+                          const SkImage* image,
+                          const SkRect& src,
+                          const SkRect& dst,
+                          const SkSamplingOptions& sampling,
+                          const SkPaint* paint,
+                          SkCanvas::SrcRectConstraint constraint,
+                          TileStreamer* streamer);
+
 inline void DrawImageRect(SkCanvas* canvas,
                           const sk_sp<SkImage>& image,
                           const SkRect& src,
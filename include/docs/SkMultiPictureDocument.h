@@ -14,6 +14,7 @@
 #include "include/core/SkTypes.h"
 
 #include <functional>
+#include <memory>
 
 class SkDocument;
 class SkStreamSeekable;
@@ -48,6 +49,32 @@ SK_API bool Read(SkStreamSeekable* src,
                  SkDocumentPage* dstArray,
                  int dstArrayCount,
                  const SkDeserialProcs* = nullptr);
+
+/**
+ *  Random access to the pages of an SkMultiPictureDocument. Opening one only reads its index;
+ *  each page is read and deserialized from the stream when it is asked for, and typefaces shared
+ *  between pages are deserialized once, the first time a page uses them.
+ *
+ *  Documents written before the index was added have to be read whole: Make() reads all of their
+ *  pages up front, as Read() does.
+ *
+ *  The stream must outlive the reader, and is repositioned by it. A reader must only be used from
+ *  one thread at a time. Procs that carry state from page to page, like SkSharingDeserialContext,
+ *  still need the pages read in order.
+ */
+class SK_API Reader {
+public:
+    /** Returns nullptr if src is not an SkMultiPictureDocument. */
+    static std::unique_ptr<Reader> Make(SkStreamSeekable* src, const SkDeserialProcs* = nullptr);
+
+    virtual ~Reader() = default;
+
+    virtual int pageCount() const = 0;
+    virtual SkSize pageSize(int index) const = 0;
+
+    /** Returns the page, or nullptr if index is out of range or the page could not be read. */
+    virtual sk_sp<SkPicture> readPage(int index) = 0;
+};
 }  // namespace SkMultiPictureDocument
 
 #endif  // SkMultiPictureDocument_DEFINED
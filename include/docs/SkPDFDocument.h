@@ -11,6 +11,7 @@
 #include "include/private/base/SkAPI.h"
 #include "include/private/base/SkNoncopyable.h"
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <vector>
@@ -18,6 +19,7 @@
 class SkCanvas;
 class SkExecutor;
 class SkPDFArray;
+class SkPDFResourceCacheImpl;
 class SkPDFTagTree;
 class SkWStream;
 
@@ -80,6 +82,28 @@ struct DateTime {
     void toISO8601(SkString* dst) const;
 };
 
+/** Remembers the font subsets and compressed images that documents write, so that other
+    documents given the same cache can reuse them instead of subsetting and compressing again.
+    Entries are keyed by the SkTypeface or SkImage they came from (and the glyphs used, or the
+    encoding options), so drawing the same typeface and image objects into each document is
+    what makes later documents hit the cache.
+
+    A cache may be shared by documents on any number of threads.
+*/
+class SK_API ResourceCache : public SkRefCnt {
+public:
+    /** Once the entries use more than |byteBudget| bytes, the least recently used are dropped.
+    */
+    static sk_sp<ResourceCache> Make(size_t byteBudget);
+
+    virtual size_t bytesUsed() const = 0;
+    virtual void purgeAll() = 0;
+
+private:
+    ResourceCache() = default;
+    friend class ::SkPDFResourceCacheImpl;
+};
+
 /** Optional metadata to be passed into the PDF factory function.
 */
 struct Metadata {
@@ -171,6 +195,16 @@ struct Metadata {
     */
     SkExecutor* fExecutor = nullptr;
 
+    /** If true and fExecutor is set, each page is recorded into an SkPicture while it is drawn,
+        and after endPage() it is converted to PDF on fExecutor while the caller goes on to the
+        next page. Pages are converted one at a time, in order, so their objects are emitted
+        in the same order as if they had been drawn directly. endPage() blocks if the caller
+        gets several pages ahead of the conversions.
+
+        Experimental.
+    */
+    bool fRecordPages = false;
+
     /** PDF streams may be compressed to save space.
         Use this to specify the desired compression vs time tradeoff.
     */
@@ -182,6 +216,34 @@ struct Metadata {
         HighButSlow = 9,
     } fCompressionLevel = CompressionLevel::Default;
 
+    /** How compressed streams are deflated. Filtered and RLE usually suit images with smooth
+        gradients or flat colors; HuffmanOnly is the fastest and compresses the least.
+    */
+    enum class CompressionStrategy : int {
+        Default = 0,
+        Filtered = 1,
+        HuffmanOnly = 2,
+        RLE = 3,
+    } fCompressionStrategy = CompressionStrategy::Default;
+
+    /** If true, the document's memory use no longer grows with its number of pages: each page
+        is written to the stream as soon as it ends, and of each kind of object that pages
+        share (images, image shaders, gradients and fonts) only the
+        fStreamingResourceLimit most recently used are remembered. An image or shader that is
+        drawn again after being forgotten is written again, and a font that is forgotten is
+        subset and written at once, so that a later use begins a new subset. The result renders
+        the same but may be larger.
+
+        Experimental.
+    */
+    bool fStreaming = false;
+    int fStreamingResourceLimit = 256;
+
+    /** If set, font subsets and compressed images are looked up in, and added to, this cache,
+        which may be shared with other documents. See ResourceCache.
+    */
+    sk_sp<ResourceCache> fResourceCache;
+
     /** Preferred Subsetter. */
     enum Subsetter {
         kHarfbuzz_Subsetter,
@@ -127,6 +127,14 @@ public:
         // painted.)
         bool forceUnoptimized = false;
 
+        // Lets the CPU backend bake color filters made from this effect into a color lookup table,
+        // the first time each set of uniforms is drawn, and then look colors up instead of running
+        // the effect for every pixel. A filter that treats its input as a color and an alpha
+        // (e.g. color grading) runs much faster this way, at the cost of some precision. The table
+        // is evaluated on opaque colors; translucent colors are unpremultiplied, looked up, and
+        // scaled by their alpha. Filters with children are never baked.
+        bool bakeColorFilterLUT = false;
+
     private:
         friend class SkRuntimeEffect;
         friend class SkRuntimeEffectPriv;
@@ -225,6 +233,21 @@ public:
     sk_sp<SkBlender> makeBlender(sk_sp<const SkData> uniforms,
                                  SkSpan<const ChildPtr> children = {}) const;
 
+    /**
+     * Returns a variant of this effect in which the named uniform is a constant with the given
+     * value, so that the compiler can fold it away along with any code it makes unreachable. This
+     * suits uniforms that select between modes of an effect: each specialized variant only carries
+     * the code for its own mode, on the GPU (where it gets its own pipelines) and on the CPU.
+     *
+     * 'size' must match the uniform's size. Arrays and layout(color) uniforms can't be specialized,
+     * nor can uniforms declared in the same statement as other variables. The specialized effect
+     * no longer has the uniform, so the uniform data passed to it must leave the value out. Calling
+     * this again with the same value returns the same effect. Returns nullptr on failure.
+     */
+    sk_sp<SkRuntimeEffect> makeSpecialized(std::string_view uniformName,
+                                           const void* value,
+                                           size_t size) const;
+
     /**
      * Creates a new Runtime Effect patterned after an already-existing one. The new shader behaves
      * like the original, but also creates a debug trace of its execution at the requested
@@ -278,6 +301,7 @@ private:
         kAlwaysOpaque_Flag        = 0x040,
         kAlphaUnchanged_Flag      = 0x080,
         kDisableOptimization_Flag = 0x100,
+        kBakeColorFilterLUT_Flag  = 0x200,
     };
 
     SkRuntimeEffect(std::unique_ptr<SkSL::Program> baseProgram,
@@ -304,9 +328,12 @@ private:
     bool usesColorTransform() const { return (fFlags & kUsesColorTransform_Flag); }
     bool alwaysOpaque()       const { return (fFlags & kAlwaysOpaque_Flag);       }
     bool isAlphaUnchanged()   const { return (fFlags & kAlphaUnchanged_Flag);     }
+    bool bakeColorFilterLUT() const { return (fFlags & kBakeColorFilterLUT_Flag); }
 
     const SkSL::RP::Program* getRPProgram(SkSL::DebugTracePriv* debugTrace) const;
 
+    struct SpecializedEffects;
+
     friend class GrSkSLFP;              // usesColorTransform
     friend class SkRuntimeShader;       // fBaseProgram, fMain, fSampleUsages, getRPProgram()
     friend class SkRuntimeBlender;      //
@@ -326,6 +353,9 @@ private:
     std::vector<SkSL::SampleUsage> fSampleUsages;
 
     uint32_t fFlags;  // Flags
+
+    mutable SkOnce fSpecializedEffectsOnce;
+    mutable std::unique_ptr<SpecializedEffects> fSpecializedEffects;
 };
 
 /** Base class for SkRuntimeShaderBuilder, defined below. */
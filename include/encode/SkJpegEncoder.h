@@ -17,6 +17,8 @@ class SkColorSpace;
 class SkData;
 class SkEncoder;
 class SkPixmap;
+class SkYUVAPixmapInfo;
+struct SkImageInfo;
 class SkWStream;
 class SkImage;
 class GrDirectContext;
@@ -123,6 +125,62 @@ SK_API std::unique_ptr<SkEncoder> Make(SkWStream* dst,
                                        const SkYUVAPixmaps& src,
                                        const SkColorSpace* srcColorSpace,
                                        const Options& options);
+
+/**
+ *  An encoder that is handed the image a stripe of rows at a time, so that the whole image never
+ *  has to be in memory (e.g. it can be encoded while it is still being rendered).
+ */
+class SK_API StreamingEncoder {
+public:
+    virtual ~StreamingEncoder() = default;
+
+    /**
+     *  Encode the next |rows|.height() rows of the image. For an encoder made from an
+     *  SkImageInfo, |rows| must have that info's width, color type and alpha type.
+     *
+     *  Returns false if |rows| does not match the encoder or has more rows than remain, or if
+     *  encoding fails; after that, all further calls fail. The image is complete once all of its
+     *  rows have been encoded.
+     */
+    virtual bool encodeRows(const SkPixmap& rows) = 0;
+
+    /**
+     *  Encode the next |rows|.yuvaInfo().height() rows of the image. For an encoder made from an
+     *  SkYUVAPixmapInfo, |rows| must have that info's width, plane configuration, subsampling
+     *  and data type. Unless they are the last rows of the image, the number of rows must be a
+     *  multiple of the vertical subsampling factor, so that each stripe starts on a new row of
+     *  the U and V planes.
+     *
+     *  The planes are handed to libjpeg-turbo as they are, without being converted to RGB or
+     *  interleaved.
+     */
+    virtual bool encodeRows(const SkYUVAPixmaps& rows) = 0;
+};
+
+/**
+ *  Create a jpeg encoder for an image described by |info| whose rows will be handed to
+ *  StreamingEncoder::encodeRows(const SkPixmap&). |options| may be used to control the encoding
+ *  behavior, and |info|'s color space is used to tag the output.
+ *
+ *  |dst| is unowned but must remain valid for the lifetime of the object.
+ *
+ *  This returns nullptr on an invalid or unsupported |info|.
+ */
+SK_API std::unique_ptr<StreamingEncoder> Make(SkWStream* dst,
+                                              const SkImageInfo& info,
+                                              const Options& options);
+
+/**
+ *  Create a jpeg encoder for an image described by |info| whose planes will be handed to
+ *  StreamingEncoder::encodeRows(const SkYUVAPixmaps&). The same planes are supported as by
+ *  Encode() of an SkYUVAPixmaps.
+ *
+ *  This returns nullptr on an invalid or unsupported |info|.
+ */
+SK_API std::unique_ptr<StreamingEncoder> Make(SkWStream* dst,
+                                              const SkYUVAPixmapInfo& info,
+                                              const SkColorSpace* srcColorSpace,
+                                              const Options& options);
 }  // namespace SkJpegEncoder
 
 #endif
@@ -19,6 +19,7 @@
 
 class GrDirectContext;
 class SkData;
+class SkExecutor;
 class SkImage;
 class SkPixmap;
 class SkWStream;
@@ -80,6 +81,15 @@ struct Options {
      */
     const skcms_ICCProfile* fICCProfile = nullptr;
     const char* fICCProfileDescription = nullptr;
+
+    /**
+     *  If not null, the rows are filtered and compressed in bands on this executor instead of
+     *  by libpng. Each call to encodeRows() (or the whole image, for Encode()) is split into bands
+     *  that are deflated as independent pieces of one zlib stream, so the output is a little
+     *  larger than a serial encode at the same fZLibLevel, but it is a standard PNG. The executor
+     *  is not used for color types that libpng has to convert further, such as opaque F16.
+     */
+    SkExecutor* fExecutor = nullptr;
 };
 
 /**
@@ -0,0 +1,87 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef skgpu_GpuMemoryReport_DEFINED
+#define skgpu_GpuMemoryReport_DEFINED
+
+#include "include/core/SkTypes.h"
+
+#include <cstddef>
+#include <vector>
+
+class SkTraceMemoryDump;
+
+namespace skgpu {
+
+/**
+ * A snapshot of the GPU memory held by a GrDirectContext, or by a Graphite Context or Recorder,
+ * broken down to help tune cache budgets. It is filled in by their getMemoryReport() calls.
+ *
+ * Locked resources are those in use, which the cache can't purge. Everything else the cache holds
+ * is purgeable.
+ */
+struct SK_API GpuMemoryReport {
+    struct ResourceType {
+        // The name of the type, e.g. "Texture" or "Buffer". It points to a static string.
+        const char* fName = nullptr;
+        int         fCount = 0;
+        size_t      fBytes = 0;
+        int         fPurgeableCount = 0;
+        size_t      fPurgeableBytes = 0;
+        size_t      fBudgetedBytes = 0;
+    };
+
+    /**
+     * An atlas is a set of pages, each a texture divided into a grid of plots that entries are
+     * packed into. Only active pages have a texture.
+     */
+    struct Atlas {
+        // e.g. "text_a8" or "small_path". It points to a static string.
+        const char* fName = nullptr;
+        int         fActivePages = 0;
+        int         fMaxPages = 0;
+        // The texture memory of the active pages.
+        size_t      fBytes = 0;
+        int         fPlotsPerPage = 0;
+        // Plots of the active pages that hold at least one entry.
+        int         fPlotsInUse = 0;
+        // The fraction of the active pages' area that holds entries, in [0, 1].
+        float       fOccupancy = 0;
+    };
+
+    int    fResourceCount = 0;
+    size_t fResourceBytes = 0;
+    size_t fPurgeableBytes = 0;
+    size_t fBudgetedBytes = 0;
+    size_t fBudget = 0;
+
+    // One entry per type of resource held, with the most bytes first.
+    std::vector<ResourceType> fResourceTypes;
+
+    std::vector<Atlas> fAtlases;
+
+    // Requests for scratch resources since the context or recorder was created, and how many of
+    // them reused one the cache held.
+    int fScratchRequests = 0;
+    int fScratchReuses = 0;
+
+    size_t lockedBytes() const { return fResourceBytes - fPurgeableBytes; }
+
+    float scratchReuseRate() const {
+        return fScratchRequests ? (float)fScratchReuses / fScratchRequests : 0.f;
+    }
+
+    /**
+     * Writes the report to 'dump' under 'prefix': the totals in "<prefix>", each resource type in
+     * "<prefix>/types/<name>" and each atlas in "<prefix>/atlases/<name>".
+     */
+    void dumpMemoryStatistics(SkTraceMemoryDump* dump, const char* prefix) const;
+};
+
+}  // namespace skgpu
+
+#endif  // skgpu_GpuMemoryReport_DEFINED
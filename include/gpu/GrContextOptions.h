@@ -135,6 +135,22 @@ struct SK_API GrContextOptions {
      */
     bool fAllowPathMaskCaching = true;
 
+    /**
+     * If true, the coverage masks and distance fields made for small paths are also kept on the
+     * CPU in the process wide SkResourceCache, where every context that sets this can find them.
+     * A context that draws a path another one already drew then only has to upload it. This costs
+     * resource cache memory, so it is only useful when several contexts draw the same paths.
+     */
+    bool fShareSmallPathMasksAcrossContexts = false;
+
+    /**
+     * If true, the context times the CPU work and, where the backend can, the GPU work of each
+     * render task it flushes, and counts the pipelines it looks up and makes. These are read with
+     * GrDirectContext::getPerfStats(). GPU timing uses timer queries on GL and timestamps on
+     * Vulkan, which cost a little GPU time per task.
+     */
+    bool fEnablePerfStats = false;
+
     /**
      * If true, the GPU will not be used to perform YUV -> RGB conversion when generating
      * textures from codec-backed images.
@@ -188,6 +204,14 @@ struct SK_API GrContextOptions {
      */
     Enable fReduceOpsTaskSplitting = Enable::kDefault;
 
+    /**
+     * When an op is recorded it may be combined with an op chain recorded before it, as long as no
+     * chain in between overlaps it. By default Ganesh looks at the last 10 chains. A larger value
+     * here looks at that many, using a spatial index of the chains so that it costs little more
+     * per op. This can batch more of the ops of UIs that interleave many kinds of draws.
+     */
+    int fOpsTaskReorderLookback = 0;
+
     /**
      * Some ES3 contexts report the ES2 external image extension, but not the ES3 version.
      * If support for external images is critical, enabling this option will cause Ganesh to limit
@@ -245,6 +269,25 @@ struct SK_API GrContextOptions {
      */
     int fMaxCachedVulkanSecondaryCommandBuffers = -1;
 
+    /**
+     * In Skia's vulkan backend the VkPipelineCache is loaded from fPersistentCache when the context
+     * is made and stored back by GrDirectContext::storeVkPipelineCacheData(). If this is positive,
+     * the context also stores it itself every this many submits, as long as pipelines were made
+     * since the last store. Getting the data from the driver copies the whole cache, so this should
+     * be large enough for the store to be rare once an app's pipelines have been made.
+     */
+    int fVulkanPipelineCacheStoreInterval = 0;
+
+    /**
+     * If this is true and fExecutor is set, Skia's vulkan backend records each render pass into a
+     * secondary command buffer on fExecutor's threads, while the flush goes on to the next ones.
+     * The primary command buffer is recorded when it is submitted, in flush order, once the
+     * secondary command buffers it executes are recorded. This spreads the cost of recording
+     * frames that draw into many surfaces across threads, but uses secondary command buffers, each
+     * with its own VkCommandPool, even on devices that prefer primary command buffers.
+     */
+    bool fRecordVulkanCommandBuffersInParallel = false;
+
     /**
      * If true, the caps will never support mipmaps.
      */
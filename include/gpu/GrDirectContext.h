@@ -9,7 +9,10 @@
 #define GrDirectContext_DEFINED
 
 #include "include/core/SkColor.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkRect.h"
 #include "include/core/SkRefCnt.h"
+#include "include/core/SkSpan.h"
 #include "include/core/SkTypes.h"
 #include "include/gpu/GpuTypes.h"
 #include "include/gpu/GrContextOptions.h"
@@ -42,9 +45,11 @@ class SkTraceMemoryDump;
 enum SkColorType : int;
 enum class SkTextureCompressionType;
 struct GrMockOptions;
+struct GrPerfStats;
 struct GrD3DBackendContext; // IWYU pragma: keep
 
 namespace skgpu {
+    struct GpuMemoryReport;
     class MutableTextureState;
 #if !defined(SK_ENABLE_OPTIMIZE_SIZE)
     namespace ganesh { class SmallPathAtlasMgr; }
@@ -484,15 +489,56 @@ public:
      */
     bool submit(GrSyncCpu sync = GrSyncCpu::kNo);
 
+    /** A surface of this context and the rect of it to read back. */
+    struct ReadPixelsRequest {
+        SkSurface* fSurface;
+        SkIRect fRect;
+    };
+
+    /**
+     * Reads back 'requests' as 'colorType', like SkSurface::asyncRescaleAndReadPixels() without
+     * rescaling, but with one transfer buffer and one flush for all of them. This makes capturing
+     * many small surfaces much cheaper than reading them back one by one. Transfer buffers are
+     * reused from earlier batches once their results are destroyed.
+     *
+     * When all the pixels are ready 'callback' is called once with a result that has a plane per
+     * request, in order, each with the pixels of its rect in the alpha type and color space of
+     * its surface. The result is null if any request fails: every surface must be a GPU surface
+     * of this context and every rect must be inside its surface. Surfaces whose pixels cannot be
+     * transferred to a buffer are read back right away.
+     */
+    void asyncReadPixelsBatch(SkSpan<const ReadPixelsRequest> requests,
+                              SkColorType colorType,
+                              SkImage::ReadPixelsCallback callback,
+                              SkImage::ReadPixelsContext context);
+
     /**
      * Checks whether any asynchronous work is complete and if so calls related callbacks.
      */
     void checkAsyncWorkCompletion();
 
-    /** Enumerates all cached GPU resources and dumps their memory to traceMemoryDump. */
+    /**
+     * Moves the stats collected since the last call into 'stats', replacing what was there. If
+     * GrContextOptions::fEnablePerfStats wasn't set the stats are always empty. GPU times of
+     * tasks are only known once the GPU is done with them, so this is best called once a frame,
+     * after checkAsyncWorkCompletion() or a sync submit.
+     */
+    void getPerfStats(GrPerfStats* stats);
+
+    /**
+     * Enumerates all cached GPU resources and dumps their memory to traceMemoryDump. The
+     * getMemoryReport() breakdown is dumped too, under "skia/gpu_memory_report".
+     */
     // Chrome is using this!
     void dumpMemoryStatistics(SkTraceMemoryDump* traceMemoryDump) const;
 
+    /**
+     * Replaces 'report' with a breakdown of the GPU memory the context holds: resources by type,
+     * purgeable and locked bytes, the occupancy of the glyph and small path atlases, and how often
+     * requests for scratch resources reused one from the cache.
+     */
+    void getMemoryReport(skgpu::GpuMemoryReport* report) const;
+
     bool supportsDistanceFieldText() const;
 
     void storeVkPipelineCacheData();
@@ -0,0 +1,50 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef GrPerfStats_DEFINED
+#define GrPerfStats_DEFINED
+
+#include "include/core/SkTypes.h"
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * Timings and pipeline counts that a GrDirectContext collects when
+ * GrContextOptions::fEnablePerfStats is set. They are meant to be gathered in the field and
+ * compared across builds, so they are cheap to collect but not exhaustive.
+ */
+struct SK_API GrPerfStats {
+    struct RenderTask {
+        // An ID for the task that is unique within its context.
+        uint32_t    fTaskID;
+        // The kind of task, e.g. "Ops" for draws or "Copy".
+        const char* fName;
+        // CPU time spent preparing the task (making its vertices and so on) and executing it
+        // (recording its commands for the GPU).
+        double      fPrepareMs;
+        double      fExecuteMs;
+        // GPU time spent on the task's commands. This is negative if the backend can't time them,
+        // or the measurement was lost, for instance because the GPU changed frequency mid query.
+        double      fGpuMs;
+    };
+
+    // The render tasks executed since the last call to getPerfStats(), in execution order. A
+    // task whose GPU time isn't known yet is held back until a later call.
+    std::vector<RenderTask> fRenderTasks;
+    // Tasks executed since the last call that were left out of fRenderTasks, because too many
+    // (thousands) piled up between calls.
+    int fDroppedRenderTasks = 0;
+
+    // Pipeline lookups since the last call that found a ready pipeline, and ones that had to make
+    // it, either from scratch or from a precompiled binary. Also the CPU time spent making them.
+    int    fPipelineCacheHits = 0;
+    int    fPipelineCacheMisses = 0;
+    double fPipelineCompileMs = 0;
+};
+
+#endif
@@ -182,6 +182,27 @@ SK_API sk_sp<SkImage> TextureFromCompressedTextureData(
         skgpu::Mipmapped mipmapped = skgpu::Mipmapped::kNo,
         GrProtected isProtected = GrProtected::kNo);
 
+/** Creates a GPU-backed SkImage by encoding the pixels of an opaque image in a compressed
+    format on the CPU and uploading the result with TextureFromCompressedTextureData. The
+    texture takes a quarter (BC1) or an eighth (ETC2) of the memory of an RGBA8 one, at some
+    loss of quality, so this suits large images that stay on screen for a long time.
+
+    Encoding is split across GrContextOptions::fExecutor if the context has one, and otherwise
+    done on the calling thread. The returned image has the color space of 'image'.
+
+    @param context     GPU context
+    @param image       opaque image to compress; any kind of image may be used
+    @param type        compression to use
+    @param mipmapped   whether to compress and upload mipmap levels too
+    @return            created SkImage, or nullptr if 'image' is not opaque or 'type' is kNone
+                       or not supported by the context
+*/
+SK_API sk_sp<SkImage> CompressedTextureFromImage(
+        GrDirectContext* context,
+        const SkImage* image,
+        SkTextureCompressionType type,
+        skgpu::Mipmapped mipmapped = skgpu::Mipmapped::kNo);
+
 /** Returns SkImage backed by GPU texture associated with context. Returned SkImage is
     compatible with SkSurface created with dstColorSpace. The returned SkImage respects
     mipmapped setting; if mipmapped equals skgpu::Mipmapped::kYes, the backing texture
@@ -212,6 +233,33 @@ inline sk_sp<SkImage> TextureFromImage(GrDirectContext* ctx,
     return TextureFromImage(ctx, img.get(), m, b);
 }
 
+/** Called once with the pixmap that the image's pixels must be written into. Returns false if
+    the pixels could not be produced.
+*/
+using PixelWriterProc = std::function<bool(const SkPixmap& dst)>;
+
+/** Creates a GPU-backed SkImage whose pixels are produced by writePixels, e.g. by decoding with
+    an SkCodec:
+
+        SkImages::TextureFromPixelWriter(context, codec->getInfo(), [&](const SkPixmap& dst) {
+            return codec->getPixels(dst) == SkCodec::kSuccess;
+        });
+
+    When the backend can upload from a mapped transfer buffer, dst points directly into that
+    buffer (with whatever row pitch the backend requires), so the pixels are never copied on the
+    CPU. Otherwise dst is a temporary raster allocation that is uploaded the usual way.
+    The texture is never mipmapped.
+    @param context      the GrDirectContext in play
+    @param info         dimensions and color info of the image; must be supported for textures
+    @param writePixels  fills dst with the pixels of the image; called at most once
+    @param budgeted     whether the new texture counts against the context's budget
+    @return             created SkImage, or nullptr
+*/
+SK_API sk_sp<SkImage> TextureFromPixelWriter(GrDirectContext* context,
+                                             const SkImageInfo& info,
+                                             const PixelWriterProc& writePixels,
+                                             skgpu::Budgeted budgeted = skgpu::Budgeted::kYes);
+
 /** Creates a GPU-backed SkImage from SkYUVAPixmaps.
     The image will remain planar with each plane converted to a texture using the passed
     GrRecordingContext.
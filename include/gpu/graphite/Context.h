@@ -17,13 +17,20 @@
 #include "include/private/base/SingleOwner.h"
 
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <memory>
 
 class SkColorSpace;
+class SkData;
 class SkRuntimeEffect;
 class SkTraceMemoryDump;
 
+namespace skgpu {
+struct GpuMemoryReport;
+}
+
 namespace skgpu::graphite {
 
 class BackendTexture;
@@ -146,6 +153,28 @@ public:
      */
     void performDeferredCleanup(std::chrono::milliseconds msNotUsed);
 
+    /**
+     * Writes the backend's compiled pipeline data to ContextOptions::fPersistentPipelineStorage,
+     * if one was provided. Data larger than maxSize bytes is not stored. This can be slow, so
+     * call it when the app is idle or about to exit rather than every frame.
+     */
+    void syncPipelineData(size_t maxSize = SIZE_MAX);
+
+    /**
+     * Returns the pipelines the Context compiled so far, encoded so that precompilePipelines() can
+     * compile them in a later run, or null if the Context wasn't made with
+     * ContextOptions::fRecordPipelineUsage. Pipelines that use user-defined SkRuntimeEffects or
+     * that draw to client textures Graphite wouldn't have made itself are left out.
+     */
+    sk_sp<SkData> serializePipelineUsage() const;
+
+    /**
+     * Compiles the pipelines in data from serializePipelineUsage(). The data only applies to the
+     * same version of Skia on the same backend; otherwise nothing is compiled. Returns the number
+     * of pipelines that are compiled now.
+     */
+    int precompilePipelines(const SkData& data);
+
     /**
      * Returns the number of bytes of the Context's gpu memory cache budget that are currently in
      * use.
@@ -159,10 +188,17 @@ public:
 
     /**
      * Enumerates all cached GPU resources owned by the Context and dumps their memory to
-     * traceMemoryDump.
+     * traceMemoryDump. A GpuMemoryReport summary is also dumped under
+     * "skia/gpu_memory_report/context".
      */
     void dumpMemoryStatistics(SkTraceMemoryDump* traceMemoryDump) const;
 
+    /**
+     * Fills 'report' with the resources held by the Context's cache, grouped by type, along
+     * with its budget and scratch reuse counts. Recorders report their own caches and atlases.
+     */
+    void getMemoryReport(skgpu::GpuMemoryReport* report) const;
+
     /**
      * Returns true if the backend-specific context has gotten into an unrecoverarble, lost state
      * (e.g. if we've gotten a VK_ERROR_DEVICE_LOST in the Vulkan backend).
@@ -11,11 +11,14 @@
 #include "include/private/base/SkAPI.h"
 #include "include/private/base/SkMath.h"
 
+class SkExecutor;
+
 namespace skgpu { class ShaderErrorHandler; }
 
 namespace skgpu::graphite {
 
 struct ContextOptionsPriv;
+class PersistentPipelineStorage;
 
 struct SK_API ContextOptions {
     ContextOptions() {}
@@ -90,6 +93,27 @@ struct SK_API ContextOptions {
      */
     bool fDisableCachedGlyphUploads = false;
 
+    /**
+     * If true, all Recorders made by the Context place glyphs in one shared atlas, instead of each
+     * Recorder having its own, so that a glyph is rasterized and uploaded once for all of them and
+     * the atlas keeps its contents from one Recording to the next. Glyph uploads are then made by
+     * the Context ahead of each Recording it inserts, so Recordings may still be inserted in any
+     * order, and more than once. The plots of the atlas that a Recording reads are kept until the
+     * Recording is deleted and the GPU is done with it; if the atlas fills up with such plots,
+     * further glyphs are not drawn until some are released.
+     */
+    bool fShareGlyphAtlasAcrossRecorders = false;
+
+    /**
+     * If true, the textures that Recorders made by the Context upload raster images to are kept in
+     * one cache for all of them, instead of each Recorder uploading the images it draws, so that
+     * an image drawn by several Recorders is uploaded once. The uploads are then made by the
+     * Context ahead of each Recording it inserts. Such raster images are not passed to the
+     * Recorders' ImageProviders. The textures count against the Context's budget, and are freed
+     * when nothing draws with them anymore and the Context needs the memory or purges resources.
+     */
+    bool fShareImageUploadsAcrossRecorders = false;
+
     static constexpr size_t kDefaultContextBudget = 256 * (1 << 20);
     /**
      * What is the budget for GPU resources allocated and held by the Context.
@@ -105,6 +129,50 @@ struct SK_API ContextOptions {
     bool fSetBackendLabels = false;
 #endif
 
+    /**
+     * If present, pipeline data compiled by the backend is loaded from this storage when the
+     * Context is created, and written back to it by Context::syncPipelineData(). The storage must
+     * outlive the Context.
+     */
+    PersistentPipelineStorage* fPersistentPipelineStorage = nullptr;
+
+    /**
+     * If present, pipelines that aren't in the cache yet are compiled on this executor. The
+     * pipelines needed by a render pass then compile concurrently, and Precompile() calls compile
+     * theirs in parallel. The executor must outlive the Context.
+     */
+    SkExecutor* fPipelineCompilationExecutor = nullptr;
+
+    /**
+     * Only used with fPipelineCompilationExecutor. If true, draws whose pipeline is still compiling
+     * when their render pass is prepared are dropped instead of waiting for the pipeline, so that
+     * a frame never stalls on pipeline compilation. Later frames use the pipeline once it's ready.
+     * If the pipeline fails to compile on the executor, later frames compile it synchronously.
+     */
+    bool fDropDrawsWithPendingPipelines = false;
+
+    /**
+     * If present, Context::submit() still submits the work to the GPU queue on the calling thread,
+     * so it stays ordered with the client's own semaphores and presents, but then hands waiting for
+     * that work to finish to this executor. The executor waits for each submission, maps the
+     * buffers of finished async readbacks, and calls the finished procs on its own thread as soon
+     * as their work finishes, so the calling thread doesn't need to call
+     * Context::checkAsyncWorkCompletion() and the finished procs must be safe to call from another
+     * thread. Skia never touches the GPU queue from the executor.
+     *
+     * With Dawn, the device must allow being used from multiple threads. The executor must outlive
+     * the Context. It is ignored with fNeverYieldToWebGPU.
+     */
+    SkExecutor* fSubmissionExecutor = nullptr;
+
+    /**
+     * If true, the Context keeps a list of the pipelines it compiles, which
+     * Context::serializePipelineUsage() writes out. An app can ship that data (collected from real
+     * use) and pass it to Context::precompilePipelines() at startup, instead of describing the
+     * pipelines it needs with PaintOptions.
+     */
+    bool fRecordPipelineUsage = false;
+
     /**
      * Private options that are only meant for testing within Skia's tools.
      */
@@ -12,6 +12,8 @@
 #include "include/core/SkTypes.h"
 #include "include/gpu/GpuTypes.h"
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 
 class SkSurface;
@@ -29,6 +31,50 @@ class Task;
 using GpuFinishedContext = void*;
 using GpuFinishedProc = void (*)(GpuFinishedContext finishedContext, CallbackResult);
 
+/**
+ * What it cost to record and run one Recording, reported to InsertRecordingInfo's
+ * fFinishedWithStatsProc.
+ *
+ * The CPU times are the wall-clock times spent in Recorder::snap() and in adding the Recording's
+ * commands in Context::insertRecording(). The counts cover the work snapped into the Recording:
+ * every DrawPass, the draws in them, and the pipelines each pass binds (a pipeline used by two
+ * passes is counted twice). fPipelinesCompiled is how many pipelines this Recorder had to compile
+ * since its last snap because no earlier Recording or precompile had made them.
+ *
+ * fGpuTimeNs is measured with GPU timestamps from the start of the first Recording that asked for
+ * stats to the end of the command buffer it was inserted into (on Metal, the whole command
+ * buffer), so it includes the Recordings that were inserted after it before the next
+ * Context::submit(). It is zero if the Recording wasn't
+ * submitted successfully or the backend can't measure GPU time (currently Dawn, and Vulkan devices
+ * without timestamp support).
+ */
+struct RecordingStats {
+    uint64_t fSnapCpuTimeNs = 0;
+    uint64_t fInsertCpuTimeNs = 0;
+
+    int fDrawPassCount = 0;
+    int fDrawCount = 0;
+    int fPipelineCount = 0;
+    int fPipelinesCompiled = 0;
+
+    // Bytes written into vertex, index, uniform and storage buffers.
+    size_t fBufferBytesWritten = 0;
+    // How many of those and of the GPU-only buffers the Recording's draws use were requested from
+    // the Context's resource cache, the bytes skipped between them to align suballocations, and the
+    // bytes left unused at their ends.
+    int fBufferAllocations = 0;
+    size_t fBufferAlignmentBytes = 0;
+    size_t fBufferUnusedBytes = 0;
+    // Bytes of pixel data written into transfer buffers to upload to textures.
+    size_t fUploadBytes = 0;
+
+    uint64_t fGpuTimeNs = 0;
+};
+
+using GpuFinishedWithStatsProc = void (*)(GpuFinishedContext finishedContext,
+                                          CallbackResult,
+                                          const RecordingStats&);
+
 /**
  * The fFinishedProc is called when the Recording has been submitted and finished on the GPU, or
  * when there is a failure that caused it not to be submitted. The callback will always be called
@@ -42,6 +88,10 @@ using GpuFinishedProc = void (*)(GpuFinishedContext finishedContext, CallbackRes
  * the Recording contains any such draws. It must be Graphite-backed and its backing texture's
  * TextureInfo must match the info provided to the Recorder when making the deferred canvas.
  *
+ * If fFinishedWithStatsProc is set it is called instead of fFinishedProc, at the same time and with
+ * the same fFinishedContext, and is also passed the RecordingStats of the Recording. Setting it
+ * makes the GPU time the command buffer, which has a small cost on some backends.
+ *
  * fTargetTranslation is an additional translation applied to draws targeting fTargetSurface.
  *
  * The client may pass in two arrays of initialized BackendSemaphores to be included in the
@@ -71,6 +121,7 @@ struct InsertRecordingInfo {
 
     GpuFinishedContext fFinishedContext = nullptr;
     GpuFinishedProc fFinishedProc = nullptr;
+    GpuFinishedWithStatsProc fFinishedWithStatsProc = nullptr;
 };
 
 /**
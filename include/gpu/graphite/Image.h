@@ -14,8 +14,10 @@
 #include "include/core/SkSpan.h"
 #include "include/gpu/GpuTypes.h"
 
+#include <functional>
 #include <string_view>
 
+class SkPixmap;
 class SkYUVAInfo;
 class SkYUVAPixmaps;
 struct SkIRect;
@@ -257,6 +259,35 @@ inline sk_sp<SkImage> TextureFromImage(skgpu::graphite::Recorder* r,
     return TextureFromImage(r, img.get(), props);
 }
 
+/** Called once with the pixmap that the image's pixels must be written into. Returns false if
+    the pixels could not be produced.
+*/
+using PixelWriterProc = std::function<bool(const SkPixmap& dst)>;
+
+/** Creates a texture-backed SkImage whose pixels are produced by writePixels, e.g. by decoding
+    with an SkCodec:
+
+        SkImages::TextureFromPixelWriter(recorder, codec->getInfo(), [&](const SkPixmap& dst) {
+            return codec->getPixels(dst) == SkCodec::kSuccess;
+        });
+
+    When the texture accepts info's color type as is, dst points directly into the Recorder's
+    upload buffer (with whatever row pitch the backend requires), so the pixels are never copied
+    on the CPU. Otherwise dst is a temporary raster allocation that is uploaded the usual way.
+
+    writePixels is called before this returns, so it may refer to stack state.
+
+    @param Recorder     the Recorder to use for storing commands
+    @param info         dimensions and color info of the image
+    @param writePixels  fills dst with the pixels of the image; called at most once
+    @param label        label for the texture, used for debugging
+    @return             created SkImage, or nullptr
+*/
+SK_API sk_sp<SkImage> TextureFromPixelWriter(skgpu::graphite::Recorder*,
+                                             const SkImageInfo& info,
+                                             const PixelWriterProc& writePixels,
+                                             std::string_view label = {});
+
 /** Creates SkImage from SkYUVAPixmaps.
 
     The image will remain planar with each plane converted to a texture using the passed Recorder.
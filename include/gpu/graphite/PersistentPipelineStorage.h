@@ -0,0 +1,54 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef skgpu_graphite_PersistentPipelineStorage_DEFINED
+#define skgpu_graphite_PersistentPipelineStorage_DEFINED
+
+#include "include/core/SkRefCnt.h"
+#include "include/private/base/SkAPI.h"
+
+class SkData;
+
+namespace skgpu::graphite {
+
+/**
+ * Client-provided storage (e.g. files on disk) for backend pipeline data that Graphite can reuse
+ * across runs, so that pipelines compiled in an earlier run do not have to be compiled from
+ * scratch again.
+ *
+ * Keys identify the backend and the driver that produced the data (vendor, device, driver version
+ * and pipeline cache UUID), so a single storage can be shared between devices; data stored under
+ * a key is only ever loaded back by a matching driver.
+ *
+ * Currently the Vulkan backend seeds its VkPipelineCache from load() when the Context is created
+ * and writes the cache back through store() from Context::syncPipelineData(). The Dawn backend
+ * does the same with the WGSL it generates from Skia's shaders (keeping only the most recently
+ * used shaders that fit in syncPipelineData()'s maxSize); that data does not depend on the driver.
+ */
+class SK_API PersistentPipelineStorage {
+public:
+    virtual ~PersistentPipelineStorage() = default;
+
+    /**
+     * Returns the data previously stored for the key, or null if there is none.
+     */
+    virtual sk_sp<SkData> load(const SkData& key) = 0;
+
+    /**
+     * Stores data for the key, replacing anything previously stored for it.
+     */
+    virtual void store(const SkData& key, const SkData& data) = 0;
+
+protected:
+    PersistentPipelineStorage() = default;
+    PersistentPipelineStorage(const PersistentPipelineStorage&) = delete;
+    PersistentPipelineStorage& operator=(const PersistentPipelineStorage&) = delete;
+};
+
+}  // namespace skgpu::graphite
+
+#endif  // skgpu_graphite_PersistentPipelineStorage_DEFINED
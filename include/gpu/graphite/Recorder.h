@@ -19,11 +19,13 @@
 
 struct AHardwareBuffer;
 class SkCanvas;
+class SkExecutor;
 struct SkImageInfo;
 class SkPixmap;
 class SkTraceMemoryDump;
 
 namespace skgpu {
+struct GpuMemoryReport;
 class RefCntedCallback;
 class TokenTracker;
 }
@@ -43,14 +45,18 @@ class Device;
 class DrawBufferManager;
 class GlobalCache;
 class ImageProvider;
+class PatchableUniformTracker;
+class PendingDrawPasses;
 class ProxyCache;
 class ProxyReadCountMap;
 class RecorderPriv;
 class ResourceProvider;
 class RuntimeEffectDictionary;
 class SharedContext;
+class StaticUniformArena;
 class Task;
 class TaskList;
+class TessellatedPathCache;
 class TextureDataBlock;
 class TextureInfo;
 class UniformDataBlock;
@@ -70,6 +76,37 @@ struct SK_API RecorderOptions final {
     static constexpr size_t kDefaultRecorderBudget = 256 * (1 << 20);
     // What is the budget for GPU resources allocated and held by this Recorder.
     size_t fGpuBudgetInBytes = kDefaultRecorderBudget;
+
+    /**
+     * If present, the draws of the DrawPasses made when the Recorder's devices are flushed (by
+     * snap() or when a device is read from) are sorted on this executor, while the Recorder goes
+     * on to the next pass. The executor must outlive the Recorder.
+     */
+    SkExecutor* fDrawPassExecutor = nullptr;
+
+    /**
+     * If present, the pixels of large texture uploads (such as those made for raster images) are
+     * converted and written to their upload buffers on this executor, so the Recorder doesn't wait
+     * for them. The Context waits for the writes of a Recording when it is inserted. The executor
+     * must outlive the Recorder and the Recordings it snaps.
+     */
+    SkExecutor* fUploadExecutor = nullptr;
+
+    /**
+     * If true, the Recordings snapped by the Recorder note where their draws wrote the uniforms of
+     * SkRuntimeEffects, so that they can be changed with Recording::setRuntimeEffectUniform()
+     * between insertions. This costs a copy of the uniforms of every pipeline that uses one.
+     */
+    bool fPatchableRuntimeEffectUniforms = false;
+
+    /**
+     * If nonzero, paint uniforms that the Recorder's draws use over and over (such as those of the
+     * few paints most of a UI is drawn with) are kept in long-lived uniform buffers of up to this
+     * many bytes in total, so that later passes and Recordings don't write them again. This is only
+     * done on backends that bind uniform buffers (not storage buffers) and can map them while the
+     * GPU uses them, and not with fPatchableRuntimeEffectUniforms.
+     */
+    size_t fStaticUniformArenaBytes = 0;
 };
 
 class SK_API Recorder final {
@@ -194,10 +231,18 @@ public:
 
     /**
      * Enumerates all cached GPU resources owned by the Recorder and dumps their memory to
-     * traceMemoryDump.
+     * traceMemoryDump. A GpuMemoryReport summary is also dumped under
+     * "skia/gpu_memory_report/recorder_<uniqueID>".
      */
     void dumpMemoryStatistics(SkTraceMemoryDump* traceMemoryDump) const;
 
+    /**
+     * Fills 'report' with the resources held by the Recorder's cache, grouped by type, and with
+     * the occupancy of its text and path atlases. The glyph atlases may be shared with other
+     * Recorders, in which case each of them reports them.
+     */
+    void getMemoryReport(skgpu::GpuMemoryReport* report) const;
+
     // Provides access to functions that aren't part of the public API.
     RecorderPriv priv();
     const RecorderPriv priv() const;  // NOLINT(readability-const-return-type)
@@ -246,6 +291,11 @@ private:
     std::unique_ptr<DrawBufferManager> fDrawBufferManager;
     std::unique_ptr<UploadBufferManager> fUploadBufferManager;
     std::unique_ptr<ProxyReadCountMap> fProxyReadCounts;
+    // Only present with RecorderOptions::fPatchableRuntimeEffectUniforms.
+    std::unique_ptr<PatchableUniformTracker> fPatchableUniformTracker;
+    std::unique_ptr<TessellatedPathCache> fTessellatedPathCache;
+    // Only present with RecorderOptions::fStaticUniformArenaBytes, on backends that support it.
+    std::unique_ptr<StaticUniformArena> fStaticUniformArena;
 
     // Iterating over tracked devices in flushTrackedDevices() needs to be re-entrant and support
     // additions to fTrackedDevices if registerDevice() is triggered by a temporary device during
@@ -253,6 +303,9 @@ private:
     // end of the initial call to flushTrackedDevices().
     skia_private::TArray<sk_sp<Device>> fTrackedDevices;
     int fFlushingDevicesIndex = -1;
+    // Only present with RecorderOptions::fDrawPassExecutor. Holds the passes made while flushing
+    // tracked devices until their commands are written at the end of the flush.
+    std::unique_ptr<PendingDrawPasses> fPendingDrawPasses;
 
     uint32_t fUniqueID;  // Needed for MessageBox handling for text
     uint32_t fNextRecordingID = 1;
@@ -273,6 +326,11 @@ private:
 
     skia_private::TArray<sk_sp<RefCntedCallback>> fFinishedProcs;
 
+    // The counts of the next Recording, added to as its DrawPasses are made.
+    RecordingStats fPendingRecordingStats;
+    // ResourceProvider::numGraphicsPipelinesCompiled() at the end of the last snap.
+    int fPipelinesCompiledBeforeSnap = 0;
+
 #if defined(GRAPHITE_TEST_UTILS)
     // For testing use only -- the Context used to create this Recorder
     Context* fContext = nullptr;
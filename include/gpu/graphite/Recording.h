@@ -9,19 +9,28 @@
 #define skgpu_graphite_Recording_DEFINED
 
 #include "include/core/SkRefCnt.h"
+#include "include/core/SkSpan.h"
+#include "include/gpu/graphite/GraphiteTypes.h"
 #include "include/private/base/SkTArray.h"
 
+#include <cstddef>
 #include <memory>
+#include <string_view>
 #include <unordered_set>
 #include <vector>
 
+class SkRuntimeEffect;
+
 namespace skgpu {
 class RefCntedCallback;
 }
 
 namespace skgpu::graphite {
 
+class Buffer;
 class CommandBuffer;
+class PatchableUniforms;
+class PendingUploadWrites;
 class RecordingPriv;
 class Resource;
 class ResourceProvider;
@@ -34,6 +43,20 @@ class SK_API Recording final {
 public:
     ~Recording();
 
+    /**
+     * Changes the value of the uniform 'name' of 'effect' in every draw of the Recording that uses
+     * the effect, from the next time the Recording is inserted. 'data' is laid out as in the
+     * uniform data that the effect's shaders, color filters and blenders are made with, and must be
+     * the size of the uniform. Earlier insertions keep the values they were inserted with.
+     *
+     * Returns false if the Recorder wasn't made with
+     * RecorderOptions::fPatchableRuntimeEffectUniforms, if the effect has no such uniform or it has
+     * a different size, or if none of the Recording's draws used the effect.
+     */
+    bool setRuntimeEffectUniform(const SkRuntimeEffect* effect,
+                                 std::string_view name,
+                                 SkSpan<const std::byte> data);
+
     RecordingPriv priv();
 
 private:
@@ -81,6 +104,10 @@ private:
     // Those refs are stored in the array here and will eventually be passed onto a CommandBuffer
     // when the Recording adds its commands.
     std::vector<sk_sp<Resource>> fExtraResourceRefs;
+    // Upload buffers that are still being written on the Recorder's upload executor. They stay
+    // mapped until the writes are done, and then join fExtraResourceRefs.
+    std::vector<sk_sp<Buffer>> fMappedUploadBuffers;
+    sk_sp<PendingUploadWrites> fPendingUploadWrites;
 
     std::unordered_set<sk_sp<TextureProxy>, ProxyHash> fNonVolatileLazyProxies;
     std::unordered_set<sk_sp<TextureProxy>, ProxyHash> fVolatileLazyProxies;
@@ -88,6 +115,16 @@ private:
     std::unique_ptr<LazyProxyData> fTargetProxyData;
 
     skia_private::TArray<sk_sp<RefCntedCallback>> fFinishedProcs;
+    // Pins the plots of a shared glyph atlas that the Recording reads. Each CommandBuffer the
+    // Recording is added to holds a ref, so the plots stay put until the Recording is deleted and
+    // the GPU is done with every insertion of it.
+    sk_sp<RefCntedCallback> fGlyphAtlasPins;
+
+    // What it cost to snap the Recording. Context::insertRecording() adds the rest.
+    RecordingStats fStats;
+
+    // Null unless the Recording's draws use runtime effect uniforms that can be changed.
+    std::unique_ptr<PatchableUniforms> fPatchableUniforms;
 };
 
 } // namespace skgpu::graphite
@@ -12,6 +12,7 @@
 #include "include/private/base/SkTArray.h"
 #include "include/private/base/SkTDArray.h"
 
+class SkExecutor;
 struct SkRect;
 
 
@@ -85,6 +86,13 @@ bool SK_API AsWinding(const SkPath& path, SkPath* result);
   */
 class SK_API SkOpBuilder {
 public:
+    SkOpBuilder() = default;
+
+    /** If executor is not null, resolve() combines independent operands on it in parallel.
+        The executor must outlive the builder.
+     */
+    explicit SkOpBuilder(SkExecutor* executor) : fExecutor(executor) {}
+
     /** Add one or more paths and their operand. The builder is empty before the first
         path is added, so the result of a single add is (emptyPath OP path).
 
@@ -104,6 +112,7 @@ public:
 private:
     skia_private::TArray<SkPath> fPathRefs;
     SkTDArray<SkPathOp> fOps;
+    SkExecutor* fExecutor = nullptr;
 
     static bool FixWinding(SkPath* path);
     static void ReversePath(SkPath* path);
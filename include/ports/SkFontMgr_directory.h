@@ -18,4 +18,12 @@ class SkFontMgr;
  */
 SK_API sk_sp<SkFontMgr> SkFontMgr_New_Custom_Directory(const char* dir);
 
+/** Like SkFontMgr_New_Custom_Directory(dir), but remembers the families and styles found in each
+ *  font file in an index at indexPath, keyed by the path, size and modification time of the font
+ *  file. A later font manager made with the same index only scans the font files that were added
+ *  or changed since, and opens the others only when one of their typefaces is used. The index is
+ *  rewritten whenever the fonts in dir change. If indexPath is null, no index is used.
+ */
+SK_API sk_sp<SkFontMgr> SkFontMgr_New_Custom_Directory(const char* dir, const char* indexPath);
+
 #endif // SkFontMgr_directory_DEFINED
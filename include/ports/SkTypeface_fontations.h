@@ -10,12 +10,25 @@
 
 #include "include/core/SkFontArguments.h"
 #include "include/core/SkRefCnt.h"
+#include "include/core/SkSpan.h"
 #include "include/core/SkTypeface.h"
 #include "include/core/SkTypes.h"
 
 #include <memory>
 
+class SkExecutor;
+
 SK_API sk_sp<SkTypeface> SkTypeface_Make_Fontations(std::unique_ptr<SkStreamAsset> fontData,
                                                     const SkFontArguments& args);
 
+/**
+ *  Extracts the outlines of 'glyphs' ahead of drawing them, in parallel on 'executor' if it is not
+ *  null. For color glyphs, the outlines their layers are drawn with are extracted instead. The
+ *  outlines are cached in font units, so one call serves every size 'typeface' is drawn at.
+ *  Does nothing if 'typeface' was not made by SkTypeface_Make_Fontations().
+ */
+SK_API void SkTypeface_PrefetchFontationsOutlines(const SkTypeface* typeface,
+                                                  SkSpan<const SkGlyphID> glyphs,
+                                                  SkExecutor* executor = nullptr);
+
 #endif
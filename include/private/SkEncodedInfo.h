@@ -31,11 +31,18 @@ public:
 
         const skcms_ICCProfile* profile() const { return &fProfile; }
         sk_sp<SkData> data() const { return fData; }
+        // Null if SkColorSpace can't represent the profile. Profiles made from the same bytes
+        // share one SkColorSpace.
+        sk_sp<SkColorSpace> colorSpace() const { return fColorSpace; }
+        // True if colorSpace() is known to be interchangeable with profile().
+        bool colorSpaceIsExact() const { return fColorSpaceIsExact; }
     private:
-        ICCProfile(const skcms_ICCProfile&, sk_sp<SkData> = nullptr);
+        ICCProfile(const skcms_ICCProfile&, sk_sp<SkData>, sk_sp<SkColorSpace>, bool exact);
 
-        skcms_ICCProfile fProfile;
-        sk_sp<SkData>    fData;
+        skcms_ICCProfile    fProfile;
+        sk_sp<SkData>       fData;
+        sk_sp<SkColorSpace> fColorSpace;
+        bool                fColorSpaceIsExact;
     };
 
     enum Alpha {
@@ -187,8 +194,7 @@ public:
                                            kN32_SkColorType      ;
         auto alpha = kOpaque_Alpha == fAlpha ? kOpaque_SkAlphaType
                                              : kUnpremul_SkAlphaType;
-        sk_sp<SkColorSpace> cs = fProfile ? SkColorSpace::Make(*fProfile->profile())
-                                          : nullptr;
+        sk_sp<SkColorSpace> cs = fProfile ? fProfile->colorSpace() : nullptr;
         if (!cs) {
             cs = SkColorSpace::MakeSRGB();
         }
@@ -209,6 +215,17 @@ public:
         return fProfile->data();
     }
 
+    sk_sp<SkColorSpace> profileColorSpace() const {
+        if (!fProfile) return nullptr;
+        return fProfile->colorSpace();
+    }
+
+    // True if pixels in 'cs' need no conversion to or from the encoded profile. This only
+    // compares pointers, so false doesn't mean a conversion is needed.
+    bool profileIsExactly(const SkColorSpace* cs) const {
+        return fProfile && fProfile->colorSpaceIsExact() && fProfile->colorSpace().get() == cs;
+    }
+
     uint8_t bitsPerComponent() const { return fBitsPerComponent; }
 
     uint8_t bitsPerPixel() const {
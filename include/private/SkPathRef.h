@@ -13,6 +13,7 @@
 #include "include/core/SkRect.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkScalar.h"
+#include "include/core/SkSpan.h"
 #include "include/core/SkTypes.h"
 #include "include/private/SkIDChangeListener.h"
 #include "include/private/base/SkDebug.h"
@@ -25,6 +26,7 @@
 #include <tuple>
 #include <utility>
 
+class SkArenaAlloc;
 class SkMatrix;
 class SkRRect;
 
@@ -296,6 +298,26 @@ public:
 
   //  static SkPathRef* CreateFromBuffer(SkRBuffer* buffer);
 
+    /**
+     * Makes a path ref whose points, verbs and weights are copied into 'arena', and which is
+     * allocated there as well. The arena keeps its own ref, so the path ref is never unique and
+     * any edit copies it to the heap. Copying an SkPath that uses it also copies it to the heap
+     * (see refOrCopy()), so only the SkPath it is first given to must be destroyed before the
+     * arena; debug builds assert if it isn't.
+     */
+    static sk_sp<SkPathRef> MakeInArena(SkArenaAlloc* arena,
+                                        SkSpan<const SkPoint> points,
+                                        SkSpan<const uint8_t> verbs,
+                                        SkSpan<const SkScalar> weights,
+                                        unsigned segmentMask);
+
+    /**
+     * Returns a new ref to this path ref, or, if it was made by MakeInArena(), a copy of it on the
+     * heap. SkPath copies use this, so that whatever keeps a copy of a path (a picture, a GPU op
+     * or draw list, a cache) never refers to an arena.
+     */
+    sk_sp<SkPathRef> refOrCopy();
+
     /**
      * Rollsback a path ref to zero verbs and points with the assumption that the path ref will be
      * repopulated with approximately the same number of verbs and points. A new path ref is created
@@ -401,6 +423,10 @@ private:
         SkDEBUGCODE(this->validate();)
     }
 
+    // Wraps storage owned by an arena; see MakeInArena().
+    SkPathRef(SkSpan<SkPoint> points, SkSpan<uint8_t> verbs, SkSpan<SkScalar> weights,
+              unsigned segmentMask);
+
     void copy(const SkPathRef& ref, int additionalReserveVerbs, int additionalReservePoints, int additionalReserveConics);
 
     // Return true if the computed bounds are finite.
@@ -565,6 +591,8 @@ private:
     bool     fRRectOrOvalIsCCW;
     uint8_t  fRRectOrOvalStartIdx;
     uint8_t  fSegmentMask;
+    // Set for path refs made by MakeInArena(), which live in the arena.
+    bool     fInArena = false;
     // If the path is an arc, these four variables store that information.
     // We should just store an SkArc, but alignment would cost us 8 more bytes.
     SkArc::Type fArcType;
@@ -534,6 +534,18 @@ protected:
         }
     }
 
+    // Creates an array over storage it doesn't own, whose first size elements are already
+    // constructed. The array moves to the heap if it ever needs more than the storage holds.
+    TArray(SkSpan<T> storage, int size) {
+        static_assert(std::is_trivially_destructible_v<T>);
+        SkASSERT(0 <= size && SkToSizeT(size) <= storage.size());
+        this->setData(storage);
+        this->changeSize(size);
+
+        // setData always sets fOwnMemory to true, but the caller owns the storage.
+        fOwnMemory = false;
+    }
+
     // Copy a C array, using pre-allocated storage if preAllocCount >= count. Otherwise, storage
     // will only be used when array shrinks to fit.
     template <int InitialCapacity>
@@ -766,6 +778,12 @@ public:
     explicit STArray(int reserveCount)
         : STArray() { this->reserve_exact(reserveCount); }
 
+    // Wraps storage owned by the caller (e.g. an arena), which must outlive the array. The
+    // inline storage is left unused.
+    STArray(SkSpan<T> storage, int size)
+        : Storage{}
+        , TArray<T, MEM_MOVE>(storage, size) {}
+
     STArray(const STArray& that)
         : STArray() { *this = that; }
 
@@ -9,13 +9,18 @@
 #define GrDeferredDisplayListRecorder_DEFINED
 
 #include "include/core/SkRefCnt.h"
+#include "include/core/SkSize.h"
 #include "include/core/SkTypes.h"
 #include "include/private/chromium/GrDeferredDisplayList.h"
 #include "include/private/chromium/GrSurfaceCharacterization.h"
 
+#include <vector>
+
 class GrRecordingContext;
 class GrRenderTargetProxy;
 class SkCanvas;
+class SkExecutor;
+class SkPicture;
 class SkSurface;
 
 /*
@@ -46,6 +51,21 @@ public:
 
     sk_sp<GrDeferredDisplayList> detach();
 
+    /**
+     * Records 'picture', drawn into the surface that 'characterization' describes, as one DDL for
+     * each tile of 'tileSize' that the surface is split into. The tiles are recorded in parallel
+     * on 'executor', or in turn on this thread if it is null, and this returns once all of them
+     * are recorded. Each DDL only draws to its own tile, so calling skgpu::ganesh::DrawDDL with
+     * each of them, in any order, draws the picture into the surface.
+     *
+     * Returns no DDLs if the characterization is invalid or the tile size is empty.
+     */
+    static std::vector<sk_sp<GrDeferredDisplayList>> RecordTiled(
+            const SkPicture*,
+            const GrSurfaceCharacterization&,
+            SkISize tileSize,
+            SkExecutor*);
+
 private:
     GrDeferredDisplayListRecorder(const GrDeferredDisplayListRecorder&) = delete;
     GrDeferredDisplayListRecorder& operator=(const GrDeferredDisplayListRecorder&) = delete;
@@ -69,6 +69,11 @@ public:
     // unlocked after this call.
     SK_SPI void writeStrikeData(std::vector<uint8_t>* memory);
 
+    // If set, the A8 and distance field glyph masks written by writeStrikeData are run length
+    // encoded, which makes them much smaller for typical text at the cost of some encoding
+    // and decoding time. Any SkStrikeClient can read the data either way.
+    SK_SPI void setRunLengthEncodeImages(bool runLengthEncode);
+
     // Testing helpers
     void setMaxEntriesInDescriptorMapForTesting(size_t count);
     size_t remoteStrikeMapSizeForTesting() const;
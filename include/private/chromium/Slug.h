@@ -46,6 +46,10 @@ public:
     static sk_sp<Slug> Deserialize(const void* data,
                                    size_t size,
                                    const SkStrikeClient* client = nullptr);
+    // Like the above, but the Slug refers to the glyph positions in data rather than copying
+    // them, and keeps a ref on data for as long as it needs them. This saves a copy per glyph
+    // when many Slugs are deserialized from buffers that are kept around anyway.
+    static sk_sp<Slug> Deserialize(sk_sp<SkData> data, const SkStrikeClient* client = nullptr);
     static sk_sp<Slug> MakeFromBuffer(SkReadBuffer& buffer);
 
     // Allows clients to deserialize SkPictures that contain slug data
@@ -0,0 +1,156 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkDrawStatsCanvas_DEFINED
+#define SkDrawStatsCanvas_DEFINED
+
+#include "include/core/SkString.h"
+#include "include/core/SkTypes.h"
+#include "include/utils/SkPaintFilterCanvas.h"
+
+#include <cstdint>
+#include <vector>
+
+class SkWStream;
+
+namespace skgpu::graphite {
+class Recorder;
+}
+
+/** \class SkDrawStatsCanvas
+
+    A proxy canvas that attributes the cost of the draws it forwards. Each draw is timed, and its
+    clipped device bounds are counted as the pixels it covers. The totals are kept per draw type,
+    per shader and blender class, and per renderer the GPU backends picked (Ganesh path renderers
+    and Graphite Renderers). The number of raster pipelines built in lowp and highp is counted
+    too.
+
+    Times are the CPU time spent in the target canvas's draw calls. For GPU canvases that is the
+    cost of recording the draw, not of executing it. Pictures and drawables are played back
+    through this canvas, so their contents are attributed draw by draw.
+
+    Typical use is to wrap the frame's canvas, and call endFrame() and dump() after each frame.
+*/
+class SK_API SkDrawStatsCanvas : public SkPaintFilterCanvas {
+public:
+    enum class Op {
+        kPaint,
+        kBehind,
+        kPoints,
+        kRect,
+        kRRect,
+        kDRRect,
+        kRegion,
+        kOval,
+        kArc,
+        kPath,
+        kImage,
+        kImageRect,
+        kImageLattice,
+        kAtlas,
+        kVertices,
+        kPatch,
+        kText,
+        kShadow,
+        kEdgeAAQuad,
+        kEdgeAAImageSet,
+
+        kLast = kEdgeAAImageSet
+    };
+    static constexpr int kOpCount = static_cast<int>(Op::kLast) + 1;
+
+    static const char* OpName(Op);
+
+    struct Counter {
+        int      fDraws  = 0;
+        double   fMillis = 0;
+        uint64_t fPixels = 0;
+    };
+
+    struct NamedCounter {
+        SkString fName;
+        Counter  fCounter;
+    };
+
+    struct Stats {
+        Counter fOps[kOpCount];
+
+        // Keyed by the paint's shader type, e.g. "LinearGradient" or "Image", or "None".
+        std::vector<NamedCounter> fShaders;
+        // Keyed by the paint's blend mode, e.g. "SrcOver", or "Runtime" for runtime blenders.
+        std::vector<NamedCounter> fBlenders;
+        // Keyed by renderer name. A draw may pick several renderers, or none.
+        std::vector<NamedCounter> fRenderers;
+
+        int fLowpPipelines  = 0;
+        int fHighpPipelines = 0;
+
+        /** Writes the stats as text tables, with the most expensive entries first. */
+        void dump(SkWStream*) const;
+    };
+
+    /**
+     *  The new canvas forwards to the specified canvas, and starts with its matrix and clip.
+     */
+    explicit SkDrawStatsCanvas(SkCanvas* target);
+
+    const Stats& stats() const { return fStats; }
+
+    /**
+     *  Returns the stats collected since the last call (or since construction), and starts over.
+     */
+    Stats endFrame();
+
+    skgpu::graphite::Recorder* recorder() const override;
+
+protected:
+    bool onFilter(SkPaint&) const override { return true; }
+
+    void onDrawPaint(const SkPaint&) override;
+    void onDrawBehind(const SkPaint&) override;
+    void onDrawPoints(PointMode, size_t count, const SkPoint pts[], const SkPaint&) override;
+    void onDrawRect(const SkRect&, const SkPaint&) override;
+    void onDrawRRect(const SkRRect&, const SkPaint&) override;
+    void onDrawDRRect(const SkRRect&, const SkRRect&, const SkPaint&) override;
+    void onDrawRegion(const SkRegion&, const SkPaint&) override;
+    void onDrawOval(const SkRect&, const SkPaint&) override;
+    void onDrawArc(const SkRect&, SkScalar, SkScalar, bool, const SkPaint&) override;
+    void onDrawPath(const SkPath&, const SkPaint&) override;
+
+    void onDrawImage2(const SkImage*, SkScalar, SkScalar, const SkSamplingOptions&,
+                      const SkPaint*) override;
+    void onDrawImageRect2(const SkImage*, const SkRect&, const SkRect&, const SkSamplingOptions&,
+                          const SkPaint*, SrcRectConstraint) override;
+    void onDrawImageLattice2(const SkImage*, const Lattice&, const SkRect&, SkFilterMode,
+                             const SkPaint*) override;
+    void onDrawAtlas2(const SkImage*, const SkRSXform[], const SkRect[], const SkColor[], int,
+                     SkBlendMode, const SkSamplingOptions&, const SkRect*, const SkPaint*) override;
+
+    void onDrawVerticesObject(const SkVertices*, SkBlendMode, const SkPaint&) override;
+    void onDrawPatch(const SkPoint cubics[12], const SkColor colors[4],
+                     const SkPoint texCoords[4], SkBlendMode, const SkPaint&) override;
+    void onDrawPicture(const SkPicture*, const SkMatrix*, const SkPaint*) override;
+    void onDrawDrawable(SkDrawable*, const SkMatrix*) override;
+
+    void onDrawGlyphRunList(const sktext::GlyphRunList&, const SkPaint&) override;
+    void onDrawTextBlob(const SkTextBlob*, SkScalar x, SkScalar y, const SkPaint&) override;
+    void onDrawShadowRec(const SkPath&, const SkDrawShadowRec&) override;
+
+    void onDrawEdgeAAQuad(const SkRect&, const SkPoint[4], QuadAAFlags, const SkColor4f&,
+                          SkBlendMode) override;
+    void onDrawEdgeAAImageSet2(const ImageSetEntry[], int count, const SkPoint[], const SkMatrix[],
+                               const SkSamplingOptions&, const SkPaint*,
+                               SrcRectConstraint) override;
+
+private:
+    class AutoDraw;
+
+    SkCanvas* fTarget;
+    Stats     fStats;
+};
+
+#endif  // SkDrawStatsCanvas_DEFINED
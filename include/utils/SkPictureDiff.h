@@ -0,0 +1,33 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkPictureDiff_DEFINED
+#define SkPictureDiff_DEFINED
+
+#include "include/core/SkRegion.h"
+#include "include/core/SkTypes.h"
+
+class SkPicture;
+
+class SK_API SkPictureDiff {
+public:
+    /**
+     *  Returns the area, in picture space, where playing back 'after' may produce different
+     *  pixels than playing back 'before', e.g. the damage between two frames of a UI. Playing
+     *  'after' clipped to this region over the output of 'before' produces the output of 'after'.
+     *
+     *  Draws are matched across the pictures, in order, by their content, their bounds, and the
+     *  matrix, clip and layers they are drawn under. Only unmatched draws contribute damage.
+     *  Images, text blobs and pictures match by unique ID, and paint effects (shaders, filters,
+     *  etc.) by object identity, so re-creating an identical effect counts as a change. Draws
+     *  that can't be compared (drawables, vertices, meshes, atlases, slugs, backdrop layers,
+     *  ...) always contribute their bounds.
+     */
+    static SkRegion Damage(const SkPicture& before, const SkPicture& after);
+};
+
+#endif
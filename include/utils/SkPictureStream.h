@@ -0,0 +1,98 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkPictureStream_DEFINED
+#define SkPictureStream_DEFINED
+
+#include "include/core/SkData.h"
+#include "include/core/SkM44.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkSerialProcs.h"
+#include "include/core/SkTypes.h"
+
+#include <functional>
+#include <memory>
+
+class SkCanvas;
+class SkRecord;
+class SkRecorder;
+
+/**
+ *  Serializes what is drawn into its canvas as a stream of chunks, each written as soon as enough
+ *  ops have been drawn, so a receiver can start replaying a frame while it is still being drawn
+ *  and sent. Each chunk holds the ops drawn since the previous one, in the same format as a
+ *  serialized SkPicture.
+ *
+ *      SkPictureStreamWriter writer(bounds, [&](sk_sp<SkData> chunk) { send(chunk); });
+ *      draw_frame(writer.getCanvas());
+ *      writer.finish();
+ *
+ *  The receiver plays the chunks, in order, with an SkPictureStreamReader.
+ */
+class SK_API SkPictureStreamWriter {
+public:
+    using ChunkProc = std::function<void(sk_sp<SkData>)>;
+
+    static constexpr int kDefaultOpsPerChunk = 256;
+
+    SkPictureStreamWriter(const SkRect& bounds, ChunkProc, const SkSerialProcs* = nullptr,
+                          int opsPerChunk = kDefaultOpsPerChunk);
+    // Calls finish().
+    ~SkPictureStreamWriter();
+
+    // Valid until finish().
+    SkCanvas* getCanvas();
+
+    // Writes a chunk with the ops drawn since the last chunk, if there are any.
+    void flush();
+
+    // Writes the last chunk. Nothing more can be drawn.
+    void finish();
+
+private:
+    static void WillAppend(void* ctx);
+    void writeChunk();
+
+    const SkRect fBounds;
+    const ChunkProc fChunkProc;
+    const SkSerialProcs fProcs;
+    const int fOpsPerChunk;
+
+    sk_sp<SkRecord> fRecord;
+    std::unique_ptr<SkRecorder> fRecorder;
+    int fWrittenOps = 0;  // ops in fRecord already written in a chunk
+    int fOpenSaves = 0;   // saves opened and not restored by the written ops
+};
+
+/**
+ *  Plays the chunks written by an SkPictureStreamWriter into a canvas as they arrive. Each chunk
+ *  continues where the previous one left off, so all of them must be played, in order, into the
+ *  same canvas, and nothing else should change the canvas's matrix, clip or saves meanwhile.
+ */
+class SK_API SkPictureStreamReader {
+public:
+    explicit SkPictureStreamReader(const SkDeserialProcs* = nullptr);
+
+    // Returns false if the chunk is invalid, after which nothing more is played.
+    bool playChunk(const void* data, size_t size, SkCanvas*);
+    bool playChunk(const SkData* data, SkCanvas* canvas) {
+        return data && this->playChunk(data->data(), data->size(), canvas);
+    }
+
+    // Restores the saves left open by the chunks played into 'canvas'.
+    void finish(SkCanvas*);
+
+private:
+    const SkDeserialProcs fProcs;
+    bool  fStarted = false;
+    bool  fFailed = false;
+    int   fSaveCount = 0;  // the canvas's save count before the first chunk
+    SkM44 fInitialMatrix;  // the canvas's matrix before the first chunk
+};
+
+#endif
@@ -0,0 +1,121 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkRingBufferTracer_DEFINED
+#define SkRingBufferTracer_DEFINED
+
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkTypes.h"
+#include "include/private/base/SkMutex.h"
+#include "include/private/base/SkThreadAnnotations.h"
+#include "include/utils/SkEventTracer.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+class SkData;
+
+/**
+ * An SkEventTracer cheap enough to leave installed in production, e.g. to trace frame phases in
+ * the field and pull the last few seconds of events when something goes wrong.
+ *
+ * Each thread records into its own fixed-size ring buffer of small binary records, without
+ * taking locks; once the ring is full, the oldest events are overwritten. Recording is off until
+ * setEnabled(true), and can be turned on and off at any time. exportPerfettoTrace() snapshots all
+ * rings into a Perfetto protobuf trace, which ui.perfetto.dev and trace_processor can open.
+ *
+ * Only the name, category, phase, timestamp and duration of each event are kept. Arguments are
+ * dropped, as are counters and object events. Names passed with TRACE_STR_COPY are interned, up to
+ * a fixed number of distinct names. A thread's ring outlives the thread, until a new thread reuses
+ * it.
+ *
+ *     auto* tracer = new SkRingBufferTracer();
+ *     SkEventTracer::SetInstance(tracer);
+ *     tracer->setEnabled(true);
+ *     ...
+ *     sk_sp<SkData> trace = tracer->exportPerfettoTrace();
+ */
+class SK_API SkRingBufferTracer final : public SkEventTracer {
+public:
+    struct Options {
+        // Ring capacity per thread, rounded up to a power of two. Each event takes 32 bytes.
+        size_t fEventsPerThread = 8192;
+
+        // Whether to also record the "disabled-by-default-" categories, which are too verbose to
+        // leave on in the field.
+        bool fIncludeDisabledByDefault = false;
+    };
+
+    SkRingBufferTracer() : SkRingBufferTracer(Options()) {}
+    explicit SkRingBufferTracer(const Options&);
+    ~SkRingBufferTracer() override;
+
+    /**
+     * Turns recording on or off for every category. Events already recorded are kept.
+     */
+    void setEnabled(bool);
+    bool isEnabled() const { return fEnabled.load(std::memory_order_relaxed); }
+
+    /**
+     * Drops all recorded events. Safe to call while other threads are recording.
+     */
+    void clear();
+
+    /**
+     * Returns the events currently in the rings as a serialized perfetto.protos.Trace, with one
+     * track per recording thread. Safe to call while other threads are recording; events that
+     * are overwritten during the export are left out.
+     */
+    sk_sp<SkData> exportPerfettoTrace() const;
+
+    const uint8_t* getCategoryGroupEnabled(const char* name) override;
+    const char* getCategoryGroupName(const uint8_t* categoryEnabledFlag) override;
+
+    SkEventTracer::Handle addTraceEvent(char phase,
+                                        const uint8_t* categoryEnabledFlag,
+                                        const char* name,
+                                        uint64_t id,
+                                        int32_t numArgs,
+                                        const char** argNames,
+                                        const uint8_t* argTypes,
+                                        const uint64_t* argValues,
+                                        uint8_t flags) override;
+
+    void updateTraceEventDuration(const uint8_t* categoryEnabledFlag,
+                                  const char* name,
+                                  SkEventTracer::Handle handle) override;
+
+private:
+    class ThreadRing;
+
+    uint8_t categoryFlags(const char* category) const;
+    ThreadRing* currentThreadRing();
+    const char* internName(const char*);
+
+    static constexpr int kMaxCategories = 64;
+    static constexpr int kMaxInternedNames = 1024;
+
+    const size_t      fEventsPerThread;
+    const bool        fIncludeDisabledByDefault;
+    const uint32_t    fTracerID;
+    std::atomic<bool> fEnabled{false};
+
+    // The macros read these flags directly, without locks, so they never move.
+    uint8_t     fCategoryFlags[kMaxCategories] = {};
+    const char* fCategoryNames[kMaxCategories] = {};
+    int         fCategoryCount SK_GUARDED_BY(fMutex) = 0;
+
+    mutable SkMutex fMutex;
+    std::vector<sk_sp<ThreadRing>>  fRings SK_GUARDED_BY(fMutex);
+    std::unordered_set<std::string> fInternedNames SK_GUARDED_BY(fMutex);
+};
+
+#endif  // SkRingBufferTracer_DEFINED
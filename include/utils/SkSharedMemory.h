@@ -0,0 +1,101 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkSharedMemory_DEFINED
+#define SkSharedMemory_DEFINED
+
+#include "include/core/SkData.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkTypes.h"
+
+#include <cstddef>
+#include <vector>
+
+class SkImage;
+class SkPixelRef;
+struct SkImageInfo;
+
+/**
+ *  Memory that can be shared with other processes by passing a file descriptor (e.g. over a unix
+ *  socket with SCM_RIGHTS), so pixels and encoded images can move between processes without being
+ *  copied. It is backed by memfd on Linux and Android (falling back to ashmem on older Android
+ *  kernels), and by POSIX shared memory on Apple platforms. Elsewhere nothing is supported and
+ *  these return null or -1.
+ *
+ *  Each block of shared memory owns a file descriptor, which stays open until the SkData or
+ *  SkPixelRef using the memory is destroyed.
+ */
+namespace SkSharedMemory {
+    SK_API bool IsSupported();
+
+    /**
+     *  Returns 'size' bytes of zeroed, writable shared memory. Fill them in through
+     *  SkData::writable_data() before sharing them.
+     */
+    SK_API sk_sp<SkData> MakeData(size_t size);
+
+    /**
+     *  Maps all of the shared memory behind 'fd', e.g. a descriptor received from another process.
+     *  The memory keeps its own duplicate of 'fd'; the caller still owns 'fd'. Writes to the memory
+     *  by other processes are visible through the returned data.
+     */
+    SK_API sk_sp<SkData> MapData(int fd);
+
+    /**
+     *  If [addr, addr + length) lies within shared memory from MakeData(), MapData() or the pixel
+     *  ref factories below, returns its file descriptor and sets 'offset' to the offset of 'addr'
+     *  in it. Otherwise returns -1. The descriptor belongs to the memory and is only valid while
+     *  the memory is alive; dup() it to keep it longer.
+     */
+    SK_API int FindFD(const void* addr, size_t length, size_t* offset);
+
+    /** Returns a pixel ref whose zeroed pixels are in shared memory. */
+    SK_API sk_sp<SkPixelRef> MakePixelRef(const SkImageInfo&, size_t rowBytes);
+
+    /**
+     *  Returns a pixel ref using the pixels at 'offset' in the shared memory behind 'fd', which are
+     *  shared with whichever processes also map it. The caller still owns 'fd'.
+     */
+    SK_API sk_sp<SkPixelRef> MapPixelRef(int fd, size_t offset, const SkImageInfo&,
+                                         size_t rowBytes);
+}  // namespace SkSharedMemory
+
+/**
+ *  Serial procs that write references to shared memory in place of the pixels of raster images
+ *  and the encoded data of lazy images, when those are in shared memory. Other images are
+ *  serialized as usual.
+ *
+ *      SkSharedMemorySerialContext ctx;
+ *      SkSerialProcs procs;
+ *      procs.fImageProc = SkSharedMemorySerialContext::SerializeImage;
+ *      procs.fImageCtx = &ctx;
+ *      sk_sp<SkData> skp = picture->serialize(&procs);
+ *      // send skp, along with ctx.fFDs in that order, before the images are destroyed
+ *
+ *  The receiving process deserializes with an SkSharedMemoryDeserialContext holding the same file
+ *  descriptors, in the same order. Its images map the shared memory instead of copying it.
+ */
+struct SK_API SkSharedMemorySerialContext {
+    // The file descriptors referenced by the serialized images, each once. They belong to the
+    // images' memory.
+    std::vector<int> fFDs;
+
+    static sk_sp<SkData> SerializeImage(SkImage*, void* ctx);
+};
+
+struct SK_API SkSharedMemoryDeserialContext {
+    // The file descriptors from SkSharedMemorySerialContext::fFDs, in the same order. They still
+    // belong to the caller.
+    std::vector<int> fFDs;
+
+    // The memory behind fFDs, mapped as images first refer to it, so each is only mapped once.
+    std::vector<sk_sp<SkData>> fMappings;
+
+    static sk_sp<SkImage> DeserializeImage(const void* data, size_t length, void* ctx);
+};
+
+#endif
@@ -0,0 +1,85 @@
+// Copyright 2026 Google LLC
+// Use of this source code is governed by a BSD-style license that can be found in the LICENSE file.
+
+#include "bench/Benchmark.h"
+#include "include/core/SkPath.h"
+#include "include/core/SkString.h"
+#include "include/pathops/SkPathOps.h"
+#include "modules/bentleyottmann/include/PolygonOps.h"
+#include "src/base/SkRandom.h"
+
+#include <cmath>
+
+// A star-shaped polygon around center with a random radius at each vertex, like a coastline.
+static SkPath make_polygon(SkRandom* random, SkPoint center, int segments) {
+    SkPath path;
+    path.incReserve(segments);
+    for (int i = 0; i < segments; ++i) {
+        const float angle = 2 * SK_FloatPI * i / segments;
+        const float radius = random->nextRangeF(800, 1000);
+        const SkPoint p = center + SkPoint{radius * std::cos(angle), radius * std::sin(angle)};
+        if (i == 0) {
+            path.moveTo(p);
+        } else {
+            path.lineTo(p);
+        }
+    }
+    path.close();
+    return path;
+}
+
+// Two overlapping large polygons, combined with either polygon_op() or Op().
+class PolygonOpsBench : public Benchmark {
+public:
+    PolygonOpsBench(int segments, SkPathOp op, bool usePathOps)
+            : fSegments{segments}, fOp{op}, fUsePathOps{usePathOps} {
+        fName.printf("bentleyottmann_polygon_%s_%s_%d",
+                     usePathOps ? "pathops" : "sweep",
+                     op == kUnion_SkPathOp ? "union" : "intersect",
+                     segments);
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == Backend::kNonRendering;
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    void onDelayedSetup() override {
+        SkRandom random;
+        fOne = make_polygon(&random, {1000, 1000}, fSegments / 2);
+        fTwo = make_polygon(&random, {1300, 1000}, fSegments / 2);
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; ++i) {
+            SkPath result;
+            if (fUsePathOps) {
+                Op(fOne, fTwo, fOp, &result);
+            } else {
+                result = bentleyottmann::polygon_op(fOne, fTwo, fOp).value_or(SkPath());
+            }
+        }
+    }
+
+private:
+    const int fSegments;
+    const SkPathOp fOp;
+    const bool fUsePathOps;
+    SkString fName;
+    SkPath fOne, fTwo;
+};
+
+// Op() is far too slow to run at the larger sizes.
+DEF_BENCH( return new PolygonOpsBench(10'000, kUnion_SkPathOp, true); )
+DEF_BENCH( return new PolygonOpsBench(10'000, kIntersect_SkPathOp, true); )
+
+DEF_BENCH( return new PolygonOpsBench(10'000, kUnion_SkPathOp, false); )
+DEF_BENCH( return new PolygonOpsBench(10'000, kIntersect_SkPathOp, false); )
+DEF_BENCH( return new PolygonOpsBench(100'000, kUnion_SkPathOp, false); )
+DEF_BENCH( return new PolygonOpsBench(100'000, kIntersect_SkPathOp, false); )
+DEF_BENCH( return new PolygonOpsBench(1'000'000, kUnion_SkPathOp, false); )
+DEF_BENCH( return new PolygonOpsBench(1'000'000, kIntersect_SkPathOp, false); )
@@ -0,0 +1,29 @@
+// Copyright 2026 Google LLC
+// Use of this source code is governed by a BSD-style license that can be found in the LICENSE file.
+
+#ifndef PolygonOps_DEFINED
+#define PolygonOps_DEFINED
+
+#include "include/core/SkPath.h"
+#include "include/pathops/SkPathOps.h"
+
+#include <optional>
+
+namespace bentleyottmann {
+
+// Computes the boolean operation op on two polygons: paths made only of lines, with any fill
+// type. The points are snapped to a grid of 1/1024 (coarser for paths spanning more than about
+// ±500k) and every edge crossing is snapped to the same grid, so the result may differ from
+// Op() by that much. The result is filled using even-odd (or inverse even-odd).
+//
+// Returns nullopt if either path has curves or non-finite points, if it is too large to snap
+// to the grid, or if snapping the crossings keeps creating new crossings.
+std::optional<SkPath> polygon_op(const SkPath& one, const SkPath& two, SkPathOp op);
+
+// A replacement for Op() from SkPathOps.h that uses polygon_op() when it can, and Op()
+// otherwise.
+bool path_op(const SkPath& one, const SkPath& two, SkPathOp op, SkPath* result);
+
+}  // namespace bentleyottmann
+
+#endif  // PolygonOps_DEFINED
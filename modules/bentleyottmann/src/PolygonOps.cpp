@@ -0,0 +1,479 @@
+// Copyright 2026 Google LLC
+// Use of this source code is governed by a BSD-style license that can be found in the LICENSE file.
+
+#include "modules/bentleyottmann/include/PolygonOps.h"
+
+#include "include/core/SkPathTypes.h"
+#include "include/core/SkPoint.h"
+#include "include/core/SkRect.h"
+#include "include/private/base/SkAssert.h"
+#include "include/private/base/SkTo.h"
+#include "modules/bentleyottmann/include/Point.h"
+#include "modules/bentleyottmann/include/Segment.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace bentleyottmann {
+namespace {
+
+// Keep the points small enough that differences of points, and the 64-bit cross products of
+// those differences, can't overflow.
+constexpr float kMaxCoordinate = 1 << 29;
+constexpr float kMaxScale = 1024;
+
+// Snapping crossings to the grid can create new crossings. Give up on paths that keep doing so.
+constexpr int kMaxSweeps = 16;
+
+struct Edge {
+    Point upper;
+    Point lower;
+
+    // The change in the winding number of each operand when crossing from the left of the edge
+    // to the right.
+    int windOne;
+    int windTwo;
+
+    // The winding numbers to the left of the edge, found by the sweep.
+    int leftOne = 0;
+    int leftTwo = 0;
+
+    Segment segment() const { return {upper, lower}; }
+};
+
+// A point where an edge must be split before the next sweep.
+struct Split {
+    int edge;
+    Point point;
+};
+
+int64_t cross(Point v0, Point v1) {
+    return SkToS64(v0.x) * SkToS64(v1.y) - SkToS64(v0.y) * SkToS64(v1.x);
+}
+
+int64_t dot(Point v0, Point v1) {
+    return SkToS64(v0.x) * SkToS64(v1.x) + SkToS64(v0.y) * SkToS64(v1.y);
+}
+
+// Returns a negative number, 0 or a positive number if p is to the left of, on, or to the right
+// of where the sweep line through p crosses the active edge e.
+int compare_point_to_edge(Point p, const Edge& e) {
+    if (e.upper.y == e.lower.y) {
+        // Points are ordered by y and then by x, so the sweep line leans infinitesimally up to
+        // the right, and a horizontal edge crosses it at every point on its row that it spans.
+        return p.x < e.upper.x ? -1 : p.x > e.lower.x ? 1 : 0;
+    }
+    // The edge points down, so p is to its left when the cross product is positive.
+    const int64_t side = cross(e.lower - e.upper, p - e.upper);
+    return side > 0 ? -1 : side < 0 ? 1 : 0;
+}
+
+// Whether p is on the edge, exactly.
+bool is_on_edge(Point p, const Edge& e) {
+    return e.upper <= p && p <= e.lower && cross(e.lower - e.upper, p - e.upper) == 0;
+}
+
+// Orders the active edges from left to right along the sweep line. Edges are only compared
+// against edges being inserted, which start at the sweep point, and against the sweep point
+// itself; the is_transparent comparisons find the edges passing through the sweep point.
+class ActiveEdgeLess {
+public:
+    using is_transparent = void;
+
+    ActiveEdgeLess(const std::vector<Edge>* edges, const Point* sweepPoint)
+            : fEdges{edges}, fSweepPoint{sweepPoint} {}
+
+    bool operator()(int i0, int i1) const {
+        const Edge& e0 = (*fEdges)[i0];
+        const Edge& e1 = (*fEdges)[i1];
+        const Point p = *fSweepPoint;
+        int order = 0;
+        if (e0.upper != p) {
+            order = -compare_point_to_edge(p, e0);
+        } else if (e1.upper != p) {
+            order = compare_point_to_edge(p, e1);
+        }
+        if (order == 0) {
+            // Both edges pass through the sweep point; order them by where they go below it.
+            order = compare_slopes(e0.segment(), e1.segment());
+        }
+        // Overlapping edges are ordered arbitrarily; the sweep splits them so they don't overlap.
+        return order != 0 ? order < 0 : i0 < i1;
+    }
+
+    bool operator()(int i, Point p) const { return compare_point_to_edge(p, (*fEdges)[i]) > 0; }
+    bool operator()(Point p, int i) const { return compare_point_to_edge(p, (*fEdges)[i]) < 0; }
+
+private:
+    const std::vector<Edge>* fEdges;
+    const Point* fSweepPoint;
+};
+
+// Sweeps the edges, top to bottom, checking that no edge touches another except at their end
+// points. Edges are kept in order along the sweep line, and each newly adjacent pair is checked
+// for crossings, so if there is a crossing, the first one is always found. Any crossings, and any
+// end points on the interior of an edge, are recorded in splits.
+//
+// If there are no splits, every edge has its winding numbers set, and the sweep returns true.
+bool sweep(std::vector<Edge>* edgesPtr, std::vector<Split>* splits) {
+    std::vector<Edge>& edges = *edgesPtr;
+    const int edgeCount = SkToInt(edges.size());
+
+    std::vector<int> byUpper(edgeCount), byLower(edgeCount);
+    for (int i = 0; i < edgeCount; ++i) {
+        byUpper[i] = byLower[i] = i;
+    }
+    std::sort(byUpper.begin(), byUpper.end(), [&](int i0, int i1) {
+        return edges[i0].upper < edges[i1].upper;
+    });
+    std::sort(byLower.begin(), byLower.end(), [&](int i0, int i1) {
+        return edges[i0].lower < edges[i1].lower;
+    });
+
+    Point sweepPoint = Point::Smallest();
+    using ActiveEdges = std::set<int, ActiveEdgeLess>;
+    ActiveEdges active{ActiveEdgeLess{&edges, &sweepPoint}};
+    std::vector<ActiveEdges::iterator> activeEdge(edgeCount);
+
+    auto checkForCrossing = [&](int i0, int i1) {
+        const Edge& e0 = edges[i0];
+        const Edge& e1 = edges[i1];
+        if (std::optional<Point> crossing = intersect(e0.segment(), e1.segment())) {
+            if (*crossing != e0.upper && *crossing != e0.lower) {
+                splits->push_back({i0, *crossing});
+            }
+            if (*crossing != e1.upper && *crossing != e1.lower) {
+                splits->push_back({i1, *crossing});
+            }
+        }
+    };
+
+    int upperIndex = 0, lowerIndex = 0;
+    while (upperIndex < edgeCount || lowerIndex < edgeCount) {
+        sweepPoint = Point::Largest();
+        if (upperIndex < edgeCount) {
+            sweepPoint = edges[byUpper[upperIndex]].upper;
+        }
+        if (lowerIndex < edgeCount) {
+            sweepPoint = std::min(sweepPoint, edges[byLower[lowerIndex]].lower);
+        }
+
+        // Any edges passing through the sweep point have a vertex on their interior. (After an
+        // unsplit crossing the active edges are out of order, so make sure.)
+        auto [first, last] = active.equal_range(sweepPoint);
+        for (auto i = first; i != last; ++i) {
+            if (edges[*i].lower != sweepPoint && is_on_edge(sweepPoint, edges[*i])) {
+                splits->push_back({*i, sweepPoint});
+            }
+        }
+
+        for (; lowerIndex < edgeCount && edges[byLower[lowerIndex]].lower == sweepPoint;
+               ++lowerIndex) {
+            active.erase(activeEdge[byLower[lowerIndex]]);
+        }
+        for (; upperIndex < edgeCount && edges[byUpper[upperIndex]].upper == sweepPoint;
+               ++upperIndex) {
+            const int edge = byUpper[upperIndex];
+            activeEdge[edge] = active.insert(edge).first;
+        }
+
+        // Check the edges that became adjacent, and set the winding numbers of the new edges.
+        std::tie(first, last) = active.equal_range(sweepPoint);
+        if (first != active.begin() && last != active.end() && first == last) {
+            checkForCrossing(*std::prev(first), *last);
+        }
+        if (first == last) {
+            continue;
+        }
+        if (first != active.begin()) {
+            checkForCrossing(*std::prev(first), *first);
+        }
+        if (last != active.end()) {
+            checkForCrossing(*std::prev(last), *last);
+        }
+
+        int windOne = 0, windTwo = 0;
+        if (first != active.begin()) {
+            const Edge& left = edges[*std::prev(first)];
+            windOne = left.leftOne + left.windOne;
+            windTwo = left.leftTwo + left.windTwo;
+        }
+        for (auto i = first; i != last; ++i) {
+            Edge& edge = edges[*i];
+            if (auto next = std::next(i); next != last) {
+                const Edge& nextEdge = edges[*next];
+                if (edge.upper == sweepPoint && nextEdge.upper == sweepPoint &&
+                    compare_slopes(edge.segment(), nextEdge.segment()) == 0) {
+                    // Both edges start here and overlap. Split the longer one where the shorter
+                    // one ends.
+                    if (edge.lower < nextEdge.lower) {
+                        splits->push_back({*next, edge.lower});
+                    } else {
+                        splits->push_back({*i, nextEdge.lower});
+                    }
+                }
+            }
+            if (edge.upper == sweepPoint) {
+                edge.leftOne = windOne;
+                edge.leftTwo = windTwo;
+            }
+            windOne = edge.leftOne + edge.windOne;
+            windTwo = edge.leftTwo + edge.windTwo;
+        }
+    }
+
+    return splits->empty();
+}
+
+// Combines edges with the same end points, and drops edges that don't change either winding.
+void merge_edges(std::vector<Edge>* edges) {
+    std::sort(edges->begin(), edges->end(), [](const Edge& e0, const Edge& e1) {
+        return std::tie(e0.upper, e0.lower) < std::tie(e1.upper, e1.lower);
+    });
+    size_t count = 0;
+    for (size_t i = 0; i < edges->size();) {
+        Edge edge = (*edges)[i];
+        for (++i; i < edges->size() &&
+                  (*edges)[i].upper == edge.upper && (*edges)[i].lower == edge.lower; ++i) {
+            edge.windOne += (*edges)[i].windOne;
+            edge.windTwo += (*edges)[i].windTwo;
+        }
+        if (edge.windOne != 0 || edge.windTwo != 0) {
+            (*edges)[count++] = edge;
+        }
+    }
+    edges->resize(count);
+}
+
+void add_edge(Point p0, Point p1, int windOne, int windTwo, std::vector<Edge>* edges) {
+    if (p0 == p1) {
+        return;
+    }
+    if (p1 < p0) {
+        std::swap(p0, p1);
+        windOne = -windOne;
+        windTwo = -windTwo;
+    }
+    edges->push_back({p0, p1, windOne, windTwo});
+}
+
+void split_edges(std::vector<Split>* splits, std::vector<Edge>* edges) {
+    const std::vector<Edge>& oldEdges = *edges;
+    // Sort the splits along each edge.
+    std::sort(splits->begin(), splits->end(), [&](const Split& s0, const Split& s1) {
+        if (s0.edge != s1.edge) {
+            return s0.edge < s1.edge;
+        }
+        const Edge& edge = oldEdges[s0.edge];
+        const Point direction = edge.lower - edge.upper;
+        return dot(s0.point - edge.upper, direction) < dot(s1.point - edge.upper, direction);
+    });
+
+    std::vector<Edge> newEdges;
+    newEdges.reserve(oldEdges.size() + splits->size());
+    size_t splitIndex = 0;
+    for (int i = 0; i < SkToInt(oldEdges.size()); ++i) {
+        const Edge& edge = oldEdges[i];
+        Point start = edge.upper;
+        for (; splitIndex < splits->size() && (*splits)[splitIndex].edge == i; ++splitIndex) {
+            const Point point = (*splits)[splitIndex].point;
+            add_edge(start, point, edge.windOne, edge.windTwo, &newEdges);
+            start = point;
+        }
+        add_edge(start, edge.lower, edge.windOne, edge.windTwo, &newEdges);
+    }
+
+    merge_edges(&newEdges);
+    *edges = std::move(newEdges);
+}
+
+bool is_polygon(const SkPath& path) {
+    return path.isFinite() && (path.getSegmentMasks() & ~SkPath::kLine_SegmentMask) == 0;
+}
+
+Point to_grid(SkPoint p, float scale) {
+    return {SkToS32(std::lround(p.fX * scale)), SkToS32(std::lround(p.fY * scale))};
+}
+
+void add_path(const SkPath& path, float scale, int windOne, int windTwo,
+              std::vector<Edge>* edges) {
+    SkPath::Iter iter(path, /*forceClose=*/true);
+    SkPoint pts[4];
+    SkPath::Verb verb;
+    while ((verb = iter.next(pts)) != SkPath::kDone_Verb) {
+        if (verb == SkPath::kLine_Verb) {
+            add_edge(to_grid(pts[0], scale), to_grid(pts[1], scale), windOne, windTwo, edges);
+        }
+    }
+}
+
+bool is_inside(int winding, SkPathFillType fillType) {
+    const bool inside = SkPathFillType_IsEvenOdd(fillType) ? (winding & 1) : winding != 0;
+    return inside != SkPathFillType_IsInverse(fillType);
+}
+
+bool apply_op(SkPathOp op, bool one, bool two) {
+    switch (op) {
+        case kDifference_SkPathOp:        return one && !two;
+        case kIntersect_SkPathOp:         return one && two;
+        case kUnion_SkPathOp:             return one || two;
+        case kXOR_SkPathOp:               return one != two;
+        case kReverseDifference_SkPathOp: return two && !one;
+    }
+    SkUNREACHABLE;
+}
+
+// Links the edges into closed contours. Every vertex has an even number of edges, because the
+// faces around it alternate between inside and outside of the result.
+SkPath make_path(const std::vector<Segment>& edges, float scale) {
+    // Each end of each edge, sorted so the edges at a vertex are together.
+    std::vector<std::pair<Point, int>> ends;
+    ends.reserve(2 * edges.size());
+    for (int i = 0; i < SkToInt(edges.size()); ++i) {
+        ends.push_back({edges[i].p0, i});
+        ends.push_back({edges[i].p1, i});
+    }
+    std::sort(ends.begin(), ends.end(), [](const auto& e0, const auto& e1) {
+        return std::tie(e0.first, e0.second) < std::tie(e1.first, e1.second);
+    });
+
+    std::vector<bool> used(edges.size(), false);
+    // For the first end at each vertex, the first end at that vertex that may be unused.
+    std::vector<size_t> unused(ends.size());
+    for (size_t i = 0; i < ends.size(); ++i) {
+        unused[i] = i;
+    }
+    auto nextEdge = [&](Point vertex) {
+        const size_t firstEnd =
+                std::lower_bound(ends.begin(), ends.end(), vertex, [](const auto& end, Point p) {
+                    return end.first < p;
+                }) - ends.begin();
+        size_t& end = unused[firstEnd];
+        while (end < ends.size() && ends[end].first == vertex && used[ends[end].second]) {
+            ++end;
+        }
+        SkASSERT(end < ends.size() && ends[end].first == vertex);
+        return end < ends.size() && ends[end].first == vertex ? ends[end].second : -1;
+    };
+
+    auto collinear = [](Point p0, Point p1, Point p2) { return cross(p1 - p0, p2 - p1) == 0; };
+
+    SkPath path;
+    std::vector<Point> contour;
+    for (int i = 0; i < SkToInt(edges.size()); ++i) {
+        if (used[i]) {
+            continue;
+        }
+        used[i] = true;
+        const Point start = edges[i].p0;
+        Point vertex = edges[i].p1;
+        contour.clear();
+        contour.push_back(start);
+        while (vertex != start) {
+            if (contour.size() >= 2 && collinear(contour[contour.size() - 2], contour.back(),
+                                                 vertex)) {
+                contour.back() = vertex;
+            } else {
+                contour.push_back(vertex);
+            }
+            const int edge = nextEdge(vertex);
+            if (edge < 0) {
+                break;
+            }
+            used[edge] = true;
+            vertex = edges[edge].p0 == vertex ? edges[edge].p1 : edges[edge].p0;
+        }
+
+        // Drop collinear points where the contour closes.
+        size_t begin = 0;
+        while (contour.size() - begin >= 3) {
+            if (collinear(contour[contour.size() - 2], contour.back(), contour[begin])) {
+                contour.pop_back();
+            } else if (collinear(contour.back(), contour[begin], contour[begin + 1])) {
+                ++begin;
+            } else {
+                break;
+            }
+        }
+        if (contour.size() - begin < 3) {
+            continue;
+        }
+
+        path.moveTo(contour[begin].x / scale, contour[begin].y / scale);
+        for (size_t j = begin + 1; j < contour.size(); ++j) {
+            path.lineTo(contour[j].x / scale, contour[j].y / scale);
+        }
+        path.close();
+    }
+    return path;
+}
+
+}  // namespace
+
+std::optional<SkPath> polygon_op(const SkPath& one, const SkPath& two, SkPathOp op) {
+    if (!is_polygon(one) || !is_polygon(two)) {
+        return std::nullopt;
+    }
+
+    // Use the finest grid that fits both paths.
+    SkRect bounds = one.getBounds();
+    bounds.join(two.getBounds());
+    const float extent = std::max({std::abs(bounds.fLeft), std::abs(bounds.fTop),
+                                   std::abs(bounds.fRight), std::abs(bounds.fBottom)});
+    float scale = kMaxScale;
+    while (scale > 1 && extent * scale > kMaxCoordinate) {
+        scale /= 2;
+    }
+    if (extent * scale > kMaxCoordinate) {
+        return std::nullopt;
+    }
+
+    std::vector<Edge> edges;
+    add_path(one, scale, 1, 0, &edges);
+    add_path(two, scale, 0, 1, &edges);
+    merge_edges(&edges);
+
+    std::vector<Split> splits;
+    for (int sweeps = 1; !sweep(&edges, &splits); ++sweeps) {
+        if (sweeps == kMaxSweeps) {
+            return std::nullopt;
+        }
+        split_edges(&splits, &edges);
+        splits.clear();
+    }
+
+    auto isInside = [&](int windOne, int windTwo) {
+        return apply_op(op, is_inside(windOne, one.getFillType()),
+                            is_inside(windTwo, two.getFillType()));
+    };
+
+    // Keep the edges between the inside and the outside of the result.
+    std::vector<Segment> boundary;
+    for (const Edge& edge : edges) {
+        if (isInside(edge.leftOne, edge.leftTwo) !=
+            isInside(edge.leftOne + edge.windOne, edge.leftTwo + edge.windTwo)) {
+            boundary.push_back(edge.segment());
+        }
+    }
+
+    SkPath result = make_path(boundary, scale);
+    result.setFillType(isInside(0, 0) ? SkPathFillType::kInverseEvenOdd
+                                      : SkPathFillType::kEvenOdd);
+    return result;
+}
+
+bool path_op(const SkPath& one, const SkPath& two, SkPathOp op, SkPath* result) {
+    if (std::optional<SkPath> polygon = polygon_op(one, two, op)) {
+        *result = std::move(*polygon);
+        return true;
+    }
+    return Op(one, two, op, result);
+}
+
+}  // namespace bentleyottmann
@@ -0,0 +1,123 @@
+// Copyright 2026 Google LLC
+// Use of this source code is governed by a BSD-style license that can be found in the LICENSE file.
+
+#include "modules/bentleyottmann/include/PolygonOps.h"
+
+#include "include/core/SkPath.h"
+#include "include/core/SkPathTypes.h"
+#include "include/core/SkRect.h"
+#include "include/pathops/SkPathOps.h"
+#include "src/base/SkRandom.h"
+#include "tests/Test.h"
+
+#include <optional>
+
+using namespace bentleyottmann;
+
+static constexpr SkPathOp kOps[] = {
+        kDifference_SkPathOp,
+        kIntersect_SkPathOp,
+        kUnion_SkPathOp,
+        kXOR_SkPathOp,
+        kReverseDifference_SkPathOp,
+};
+
+// Checks that polygon_op() agrees with Op() at the center of every unit square in bounds.
+static void check_against_op(skiatest::Reporter* r,
+                             const SkPath& one,
+                             const SkPath& two,
+                             SkRect bounds) {
+    for (SkPathOp op : kOps) {
+        std::optional<SkPath> result = polygon_op(one, two, op);
+        SkPath expected;
+        if (!result || !Op(one, two, op, &expected)) {
+            ERRORF(r, "op %d failed", op);
+            continue;
+        }
+        int mismatches = 0;
+        for (float y = bounds.fTop + 0.5f; y < bounds.fBottom; ++y) {
+            for (float x = bounds.fLeft + 0.5f; x < bounds.fRight; ++x) {
+                mismatches += result->contains(x, y) != expected.contains(x, y);
+            }
+        }
+        REPORTER_ASSERT(r, mismatches == 0, "op %d: %d mismatched points", op, mismatches);
+    }
+}
+
+DEF_TEST(BO_PolygonOpsRects, r) {
+    SkPath one = SkPath::Rect({0, 0, 20, 20}),
+           two = SkPath::Rect({10, 10, 30, 30});
+    check_against_op(r, one, two, {-5, -5, 35, 35});
+
+    // Rects sharing an edge, or part of one, or a corner.
+    check_against_op(r, one, SkPath::Rect({20, 0, 40, 20}), {-5, -5, 45, 25});
+    check_against_op(r, one, SkPath::Rect({20, 5, 30, 10}), {-5, -5, 35, 25});
+    check_against_op(r, one, SkPath::Rect({20, 20, 30, 30}), {-5, -5, 35, 35});
+
+    // The same rect, wound the other way.
+    check_against_op(r, one, SkPath::Rect({0, 0, 20, 20}, SkPathDirection::kCCW), {-5, -5, 25, 25});
+
+    // Adjacent rects union into a single rect.
+    std::optional<SkPath> joined = polygon_op(one, SkPath::Rect({20, 0, 40, 20}), kUnion_SkPathOp);
+    REPORTER_ASSERT(r, joined && joined->countPoints() == 4);
+    REPORTER_ASSERT(r, joined && joined->getBounds() == SkRect::MakeLTRB(0, 0, 40, 20));
+
+    // Disjoint rects intersect to nothing.
+    std::optional<SkPath> empty = polygon_op(one, SkPath::Rect({30, 30, 40, 40}),
+                                             kIntersect_SkPathOp);
+    REPORTER_ASSERT(r, empty && empty->isEmpty());
+}
+
+DEF_TEST(BO_PolygonOpsFillTypes, r) {
+    // A star, which has a hole in the middle when filled using even-odd.
+    SkPath star;
+    star.moveTo(20, 0);
+    for (int i = 1; i < 5; ++i) {
+        const float angle = i * 4 * SK_FloatPI / 5;
+        star.lineTo(20 + 20 * std::sin(angle), 20 - 20 * std::cos(angle));
+    }
+    star.close();
+    SkPath square = SkPath::Rect({10, 10, 50, 30});
+
+    for (SkPathFillType starFill : {SkPathFillType::kWinding, SkPathFillType::kEvenOdd,
+                                    SkPathFillType::kInverseWinding,
+                                    SkPathFillType::kInverseEvenOdd}) {
+        for (SkPathFillType squareFill : {SkPathFillType::kWinding,
+                                          SkPathFillType::kInverseEvenOdd}) {
+            star.setFillType(starFill);
+            square.setFillType(squareFill);
+            check_against_op(r, star, square, {-5, -5, 55, 45});
+        }
+    }
+}
+
+DEF_TEST(BO_PolygonOpsRandom, r) {
+    // Self-intersecting polygons, with lots of crossings between them.
+    SkRandom random;
+    for (int trial = 0; trial < 20; ++trial) {
+        SkPath paths[2];
+        for (SkPath& path : paths) {
+            path.moveTo(random.nextRangeF(0, 100), random.nextRangeF(0, 100));
+            for (int i = 0; i < 20; ++i) {
+                path.lineTo(random.nextRangeF(0, 100), random.nextRangeF(0, 100));
+            }
+            path.close();
+            path.setFillType(random.nextBool() ? SkPathFillType::kWinding
+                                               : SkPathFillType::kEvenOdd);
+        }
+        check_against_op(r, paths[0], paths[1], {0, 0, 100, 100});
+    }
+}
+
+DEF_TEST(BO_PolygonOpsCurves, r) {
+    SkPath oval = SkPath::Oval({0, 0, 20, 20}),
+           rect = SkPath::Rect({10, 10, 30, 30});
+    REPORTER_ASSERT(r, !polygon_op(oval, rect, kUnion_SkPathOp));
+    REPORTER_ASSERT(r, !polygon_op(rect, oval, kUnion_SkPathOp));
+
+    // path_op() falls back to Op().
+    SkPath result, expected;
+    REPORTER_ASSERT(r, path_op(oval, rect, kUnion_SkPathOp, &result));
+    REPORTER_ASSERT(r, Op(oval, rect, kUnion_SkPathOp, &expected));
+    REPORTER_ASSERT(r, result == expected);
+}
@@ -18,6 +18,7 @@
 #include "include/core/SkColorFilter.h"
 #include "include/core/SkColorSpace.h"
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkImageFilter.h"
 #include "include/core/SkImageGenerator.h"
@@ -73,6 +74,10 @@
 #include <emscripten/bind.h>
 #include <emscripten/html5.h>
 
+#ifdef CK_ENABLE_THREADS
+#include <thread>
+#endif
+
 #if defined(CK_ENABLE_WEBGL) || defined(CK_ENABLE_WEBGPU)
 #define ENABLE_GPU
 #endif
@@ -749,6 +754,182 @@ SkPath MakePathFromVerbsPointsWeights(WASMPointerU8 verbsPtr, int numVerbs,
     return path;
 }
 
+//========================================================================================
+// Batched draw commands
+//========================================================================================
+
+// Draw commands recorded by JS into a float array, so they can be replayed onto a canvas with a
+// single call instead of one call per draw. Each command is an opcode followed by its arguments.
+// Paints are copied in once, and referenced by their index (handle) in the commands.
+// See CanvasKit.CommandBuffer in interface.js, which writes these.
+static const int CMD_SAVE = 0;
+static const int CMD_RESTORE = 1;
+static const int CMD_TRANSLATE = 2;   // dx, dy
+static const int CMD_SCALE = 3;       // sx, sy
+static const int CMD_ROTATE = 4;      // degrees, px, py
+static const int CMD_CONCAT = 5;      // 16 matrix values, row major
+static const int CMD_CLIP_RECT = 6;   // l, t, r, b, clip op, anti-alias
+static const int CMD_DRAW_RECT = 7;   // l, t, r, b, paint
+static const int CMD_DRAW_RRECT = 8;  // l, t, r, b, 8 radii, paint
+static const int CMD_DRAW_OVAL = 9;   // l, t, r, b, paint
+static const int CMD_DRAW_CIRCLE = 10;  // cx, cy, radius, paint
+static const int CMD_DRAW_LINE = 11;  // x0, y0, x1, y1, paint
+static const int CMD_DRAW_PAINT = 12; // paint
+static const int CMD_DRAW_COLOR = 13; // r, g, b, a, blend mode
+
+class CommandBuffer {
+public:
+    int addPaint(const SkPaint& paint) {
+        fPaints.push_back(paint);
+        return SkToInt(fPaints.size()) - 1;
+    }
+
+    void setPaint(int handle, const SkPaint& paint) {
+        if (handle < 0 || handle >= SkToInt(fPaints.size())) {
+            SkDebugf("Invalid paint handle %d\n", handle);
+            return;
+        }
+        fPaints[handle] = paint;
+    }
+
+    int countPaints() const { return SkToInt(fPaints.size()); }
+
+    // Resizes the command storage, keeping its contents, and returns its new address.
+    WASMPointerF32 resize(int count) {
+        fCommands.resize(std::max(count, 0));
+        return reinterpret_cast<WASMPointerF32>(fCommands.data());
+    }
+
+    void replay(SkCanvas& canvas, int numCmds) const;
+
+private:
+    std::vector<SkPaint> fPaints;
+    std::vector<float>   fCommands;
+};
+
+void CommandBuffer::replay(SkCanvas& canvas, int numCmds) const {
+    numCmds = std::min(numCmds, SkToInt(fCommands.size()));
+    const float* cmds = fCommands.data();
+
+    // Stop replaying at the first malformed command.
+    #define CHECK_NUM_ARGS(n) \
+        if ((i + n) > numCmds) { \
+            SkDebugf("Not enough args for draw command %d\n", op); \
+            return; \
+        }
+    #define NEXT_PAINT(p) \
+        const int p##Handle = sk_float_floor2int(cmds[i++]); \
+        if (p##Handle < 0 || p##Handle >= SkToInt(fPaints.size())) { \
+            SkDebugf("Invalid paint handle %d\n", p##Handle); \
+            return; \
+        } \
+        const SkPaint& p = fPaints[p##Handle];
+
+    for (int i = 0; i < numCmds;) {
+        const int op = sk_float_floor2int(cmds[i++]);
+        switch (op) {
+            case CMD_SAVE:
+                canvas.save();
+                break;
+            case CMD_RESTORE:
+                canvas.restore();
+                break;
+            case CMD_TRANSLATE:
+                CHECK_NUM_ARGS(2)
+                canvas.translate(cmds[i], cmds[i + 1]);
+                i += 2;
+                break;
+            case CMD_SCALE:
+                CHECK_NUM_ARGS(2)
+                canvas.scale(cmds[i], cmds[i + 1]);
+                i += 2;
+                break;
+            case CMD_ROTATE:
+                CHECK_NUM_ARGS(3)
+                canvas.rotate(cmds[i], cmds[i + 1], cmds[i + 2]);
+                i += 3;
+                break;
+            case CMD_CONCAT:
+                CHECK_NUM_ARGS(16)
+                canvas.concat(SkM44::RowMajor(cmds + i));
+                i += 16;
+                break;
+            case CMD_CLIP_RECT: {
+                CHECK_NUM_ARGS(6)
+                const SkRect rect = SkRect::MakeLTRB(cmds[i], cmds[i + 1], cmds[i + 2], cmds[i + 3]);
+                const auto clipOp = sk_float_floor2int(cmds[i + 4]) == 0 ? SkClipOp::kDifference
+                                                                         : SkClipOp::kIntersect;
+                canvas.clipRect(rect, clipOp, cmds[i + 5] != 0);
+                i += 6;
+                break;
+            }
+            case CMD_DRAW_RECT: {
+                CHECK_NUM_ARGS(5)
+                const SkRect rect = SkRect::MakeLTRB(cmds[i], cmds[i + 1], cmds[i + 2], cmds[i + 3]);
+                i += 4;
+                NEXT_PAINT(paint)
+                canvas.drawRect(rect, paint);
+                break;
+            }
+            case CMD_DRAW_RRECT: {
+                CHECK_NUM_ARGS(13)
+                const SkRRect rrect = ptrToSkRRect(reinterpret_cast<WASMPointerF32>(cmds + i));
+                i += 12;
+                NEXT_PAINT(paint)
+                canvas.drawRRect(rrect, paint);
+                break;
+            }
+            case CMD_DRAW_OVAL: {
+                CHECK_NUM_ARGS(5)
+                const SkRect rect = SkRect::MakeLTRB(cmds[i], cmds[i + 1], cmds[i + 2], cmds[i + 3]);
+                i += 4;
+                NEXT_PAINT(paint)
+                canvas.drawOval(rect, paint);
+                break;
+            }
+            case CMD_DRAW_CIRCLE: {
+                CHECK_NUM_ARGS(4)
+                const float cx = cmds[i], cy = cmds[i + 1], radius = cmds[i + 2];
+                i += 3;
+                NEXT_PAINT(paint)
+                canvas.drawCircle(cx, cy, radius, paint);
+                break;
+            }
+            case CMD_DRAW_LINE: {
+                CHECK_NUM_ARGS(5)
+                const float x0 = cmds[i], y0 = cmds[i + 1], x1 = cmds[i + 2], y1 = cmds[i + 3];
+                i += 4;
+                NEXT_PAINT(paint)
+                canvas.drawLine(x0, y0, x1, y1, paint);
+                break;
+            }
+            case CMD_DRAW_PAINT: {
+                CHECK_NUM_ARGS(1)
+                NEXT_PAINT(paint)
+                canvas.drawPaint(paint);
+                break;
+            }
+            case CMD_DRAW_COLOR: {
+                CHECK_NUM_ARGS(5)
+                const SkColor4f color = {cmds[i], cmds[i + 1], cmds[i + 2], cmds[i + 3]};
+                const int mode = sk_float_floor2int(cmds[i + 4]);
+                i += 5;
+                if (mode < 0 || mode > static_cast<int>(SkBlendMode::kLastMode)) {
+                    SkDebugf("Invalid blend mode %d\n", mode);
+                    return;
+                }
+                canvas.drawColor(color, static_cast<SkBlendMode>(mode));
+                break;
+            }
+            default:
+                SkDebugf("Unknown draw command %d\n", op);
+                return;
+        }
+    }
+    #undef CHECK_NUM_ARGS
+    #undef NEXT_PAINT
+}
+
 //========================================================================================
 // Path Effects
 //========================================================================================
@@ -1043,12 +1224,36 @@ static Uint8Array encodeImage(GrDirectContext* dContext,
     return toBytes(data);
 }
 
+#ifdef CK_ENABLE_THREADS
+// Threaded builds run Skia's parallel work (tiled raster, decodes, blurs, etc.) on a pool of web
+// workers, which is installed as the default SkExecutor. A count of 0 runs that work on the
+// calling thread again.
+static std::unique_ptr<SkExecutor> gThreadPool;
+
+static void SetThreadCount(int threads) {
+    SkExecutor::SetDefault(nullptr);
+    gThreadPool = threads > 0 ? SkExecutor::MakeWorkStealingThreadPool(threads) : nullptr;
+    SkExecutor::SetDefault(gThreadPool.get());
+}
+#endif
+
 EMSCRIPTEN_BINDINGS(Skia) {
 #ifdef ENABLE_GPU
     constant("gpu", true);
     function("_MakeGrContext", &MakeGrContext);
 #endif // ENABLE_GPU
 
+#ifdef __wasm_simd128__
+    constant("simd", true);
+#endif
+
+#ifdef CK_ENABLE_THREADS
+    constant("threads", true);
+    function("setThreadCount", &SetThreadCount);
+    // Use all the workers emscripten started for us (see PTHREAD_POOL_SIZE in BUILD.gn).
+    SetThreadCount(std::max<int>(std::thread::hardware_concurrency(), 1));
+#endif
+
 #ifdef CK_ENABLE_WEBGL
     constant("webgl", true);
     function("_MakeOnScreenGLSurface", select_overload<sk_sp<SkSurface>(sk_sp<GrDirectContext>, int, int, sk_sp<SkColorSpace>)>(&MakeOnScreenGLSurface));
@@ -1385,6 +1590,10 @@ EMSCRIPTEN_BINDINGS(Skia) {
             const SkRect* rect = reinterpret_cast<const SkRect*>(fPtr);
             self.drawRect(*rect, paint);
         }))
+        .function("_drawCommands", optional_override([](SkCanvas& self, const CommandBuffer& cmds,
+                                                        int numCmds)->void {
+            cmds.replay(self, numCmds);
+        }))
         .function("_drawRect4f", optional_override([](SkCanvas& self, SkScalar left, SkScalar top,
                                                      SkScalar right, SkScalar bottom,
                                                      const SkPaint& paint)->void {
@@ -1821,6 +2030,13 @@ EMSCRIPTEN_BINDINGS(Skia) {
         return SkMaskFilter::MakeBlur(style, sigma, respectCTM);
     }), allow_raw_pointers());
 
+    class_<CommandBuffer>("CommandBuffer")
+        .constructor<>()
+        .function("addPaint", &CommandBuffer::addPaint)
+        .function("setPaint", &CommandBuffer::setPaint)
+        .function("countPaints", &CommandBuffer::countPaints)
+        .function("_resize", &CommandBuffer::resize);
+
     class_<SkPaint>("Paint")
         .constructor<>()
         .function("copy", optional_override([](const SkPaint& self)->SkPaint {
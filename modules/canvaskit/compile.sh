@@ -55,6 +55,18 @@ else
   ENABLE_WEBGL="true"
 fi
 
+ENABLE_SIMD="false"
+if [[ $@ == *simd* ]]; then
+  echo "Using WASM SIMD"
+  ENABLE_SIMD="true"
+fi
+
+ENABLE_THREADS="false"
+if [[ $@ == *threads* ]]; then
+  echo "Using pthreads (requires SharedArrayBuffer)"
+  ENABLE_THREADS="true"
+fi
+
 SERIALIZE_SKP="true"
 if [[ $@ == *no_skp_serialization* ]]; then
   # This saves about 20kb compressed.
@@ -261,6 +273,8 @@ echo "Compiling"
   skia_canvaskit_enable_debugger=${DEBUGGER_ENABLED} \
   skia_canvaskit_enable_paragraph=${ENABLE_PARAGRAPH} \
   skia_canvaskit_enable_webgl=${ENABLE_WEBGL} \
-  skia_canvaskit_enable_webgpu=${ENABLE_WEBGPU}"
+  skia_canvaskit_enable_webgpu=${ENABLE_WEBGPU} \
+  skia_canvaskit_enable_simd=${ENABLE_SIMD} \
+  skia_canvaskit_enable_threads=${ENABLE_THREADS}"
 
 ${NINJA} -C ${BUILD_DIR} canvaskit.js
@@ -297,6 +297,7 @@ var CanvasKit = {
       drawColor: function() {},
       drawColorComponents: function() {},
       drawColorInt: function() {},
+      drawCommands: function() {},
       drawDRRect: function() {},
       drawGlyphs: function() {},
       drawImage: function() {},
@@ -340,6 +341,7 @@ var CanvasKit = {
     _drawCircle: function() {},
     _drawColor: function() {},
     _drawColorInt: function() {},
+    _drawCommands: function() {},
     _drawDRRect:  function() {},
     _drawGlyphs: function() {},
     _drawImage: function() {},
@@ -405,6 +407,37 @@ var CanvasKit = {
     _MakeAdobeRGB: function() {},
   },
 
+  CommandBuffer: {
+    // public API (from C++ bindings)
+    addPaint: function() {},
+    countPaints: function() {},
+    setPaint: function() {},
+
+    prototype: {
+      clipRect: function() {},
+      concat: function() {},
+      drawCircle: function() {},
+      drawColor: function() {},
+      drawLine: function() {},
+      drawOval: function() {},
+      drawPaint: function() {},
+      drawRRect: function() {},
+      drawRect: function() {},
+      reset: function() {},
+      restore: function() {},
+      rotate: function() {},
+      save: function() {},
+      scale: function() {},
+      size: function() {},
+      translate: function() {},
+    },
+
+    // private API (from C++ bindings)
+    _resize: function() {},
+    _reserve: function() {},
+    _writeRect: function() {},
+  },
+
   ContourMeasureIter: {
     next: function() {},
   },
@@ -851,7 +884,10 @@ var CanvasKit = {
 
   // Constants and Enums
   gpu: {},
+  simd: {},
   skottie: {},
+  threads: {},
+  setThreadCount: function() {},
 
   TRANSPARENT: {},
   BLACK: {},
@@ -594,6 +594,12 @@ CanvasKit.onRuntimeInitialized = function() {
     }
   };
 
+  // Replays all the commands recorded into cmds, a CanvasKit.CommandBuffer, with a single call.
+  CanvasKit.Canvas.prototype.drawCommands = function(cmds) {
+    CanvasKit.setCurrentContext(this._context);
+    this._drawCommands(cmds, cmds._len || 0);
+  };
+
   CanvasKit.Canvas.prototype.drawDRRect = function(outer, inner, paint) {
     CanvasKit.setCurrentContext(this._context);
     var oPtr = copyRRectToWasm(outer, _scratchRRectPtr);
@@ -930,6 +936,155 @@ CanvasKit.onRuntimeInitialized = function() {
     }
   };
 
+  // The opcodes of the commands in a CommandBuffer. These must match the CMD_ constants in
+  // canvaskit_bindings.cpp.
+  var CMD_SAVE = 0;
+  var CMD_RESTORE = 1;
+  var CMD_TRANSLATE = 2;
+  var CMD_SCALE = 3;
+  var CMD_ROTATE = 4;
+  var CMD_CONCAT = 5;
+  var CMD_CLIP_RECT = 6;
+  var CMD_DRAW_RECT = 7;
+  var CMD_DRAW_RRECT = 8;
+  var CMD_DRAW_OVAL = 9;
+  var CMD_DRAW_CIRCLE = 10;
+  var CMD_DRAW_LINE = 11;
+  var CMD_DRAW_PAINT = 12;
+  var CMD_DRAW_COLOR = 13;
+
+  // Makes room for n more floats in the command buffer's WASM memory and returns the index in
+  // CanvasKit.HEAPF32 of the first of them. The commands are written straight into WASM memory,
+  // so drawing them later doesn't copy them.
+  CanvasKit.CommandBuffer.prototype._reserve = function(n) {
+    var len = this._len || 0;
+    if (!this._ptr || len + n > this._cap) {
+      this._cap = Math.max(2 * (this._cap || 0), len + n, 256);
+      this._ptr = this._resize(this._cap);
+    }
+    this._len = len + n;
+    return (this._ptr / 4) + len;
+  };
+
+  // Returns how many floats the recorded commands take up.
+  CanvasKit.CommandBuffer.prototype.size = function() {
+    return this._len || 0;
+  };
+
+  // Forgets the recorded commands, keeping their memory and the paints for reuse.
+  CanvasKit.CommandBuffer.prototype.reset = function() {
+    this._len = 0;
+  };
+
+  CanvasKit.CommandBuffer.prototype.save = function() {
+    CanvasKit.HEAPF32[this._reserve(1)] = CMD_SAVE;
+  };
+
+  CanvasKit.CommandBuffer.prototype.restore = function() {
+    CanvasKit.HEAPF32[this._reserve(1)] = CMD_RESTORE;
+  };
+
+  CanvasKit.CommandBuffer.prototype.translate = function(dx, dy) {
+    var i = this._reserve(3);
+    CanvasKit.HEAPF32[i] = CMD_TRANSLATE;
+    CanvasKit.HEAPF32[i + 1] = dx;
+    CanvasKit.HEAPF32[i + 2] = dy;
+  };
+
+  CanvasKit.CommandBuffer.prototype.scale = function(sx, sy) {
+    var i = this._reserve(3);
+    CanvasKit.HEAPF32[i] = CMD_SCALE;
+    CanvasKit.HEAPF32[i + 1] = sx;
+    CanvasKit.HEAPF32[i + 2] = sy;
+  };
+
+  CanvasKit.CommandBuffer.prototype.rotate = function(degrees, px, py) {
+    var i = this._reserve(4);
+    CanvasKit.HEAPF32[i] = CMD_ROTATE;
+    CanvasKit.HEAPF32[i + 1] = degrees;
+    CanvasKit.HEAPF32[i + 2] = px || 0;
+    CanvasKit.HEAPF32[i + 3] = py || 0;
+  };
+
+  // Like Canvas.concat, takes a 3x3 or 4x4 matrix in row major order.
+  CanvasKit.CommandBuffer.prototype.concat = function(matr) {
+    var m44 = matr;
+    if (matr.length === 9) {
+      m44 = [matr[0], matr[1], 0, matr[2],
+             matr[3], matr[4], 0, matr[5],
+             0,       0,       1, 0,
+             matr[6], matr[7], 0, matr[8]];
+    } else if (matr.length !== 16) {
+      throw 'invalid matrix size ' + matr.length;
+    }
+    var i = this._reserve(17);
+    CanvasKit.HEAPF32[i] = CMD_CONCAT;
+    CanvasKit.HEAPF32.set(m44, i + 1);
+  };
+
+  // Writes a command taking a rect, followed by the given arguments.
+  CanvasKit.CommandBuffer.prototype._writeRect = function(op, rect, a, b) {
+    var n = b !== undefined ? 7 : 6;
+    var i = this._reserve(n);
+    var heap = CanvasKit.HEAPF32;
+    heap[i] = op;
+    heap[i + 1] = rect[0];
+    heap[i + 2] = rect[1];
+    heap[i + 3] = rect[2];
+    heap[i + 4] = rect[3];
+    heap[i + 5] = a;
+    if (n === 7) {
+      heap[i + 6] = b;
+    }
+  };
+
+  CanvasKit.CommandBuffer.prototype.clipRect = function(rect, op, antialias) {
+    this._writeRect(CMD_CLIP_RECT, rect, op.value, antialias ? 1 : 0);
+  };
+
+  // The paint is a handle returned by addPaint().
+  CanvasKit.CommandBuffer.prototype.drawRect = function(rect, paint) {
+    this._writeRect(CMD_DRAW_RECT, rect, paint);
+  };
+
+  CanvasKit.CommandBuffer.prototype.drawRRect = function(rrect, paint) {
+    if (rrect.length !== 12) {
+      throw 'invalid rrect size ' + rrect.length;
+    }
+    var i = this._reserve(14);
+    CanvasKit.HEAPF32[i] = CMD_DRAW_RRECT;
+    CanvasKit.HEAPF32.set(rrect, i + 1);
+    CanvasKit.HEAPF32[i + 13] = paint;
+  };
+
+  CanvasKit.CommandBuffer.prototype.drawOval = function(oval, paint) {
+    this._writeRect(CMD_DRAW_OVAL, oval, paint);
+  };
+
+  CanvasKit.CommandBuffer.prototype.drawCircle = function(cx, cy, radius, paint) {
+    var i = this._reserve(5);
+    CanvasKit.HEAPF32[i] = CMD_DRAW_CIRCLE;
+    CanvasKit.HEAPF32[i + 1] = cx;
+    CanvasKit.HEAPF32[i + 2] = cy;
+    CanvasKit.HEAPF32[i + 3] = radius;
+    CanvasKit.HEAPF32[i + 4] = paint;
+  };
+
+  CanvasKit.CommandBuffer.prototype.drawLine = function(x0, y0, x1, y1, paint) {
+    this._writeRect(CMD_DRAW_LINE, [x0, y0, x1, y1], paint);
+  };
+
+  CanvasKit.CommandBuffer.prototype.drawPaint = function(paint) {
+    var i = this._reserve(2);
+    CanvasKit.HEAPF32[i] = CMD_DRAW_PAINT;
+    CanvasKit.HEAPF32[i + 1] = paint;
+  };
+
+  CanvasKit.CommandBuffer.prototype.drawColor = function(color4f, mode) {
+    var m = mode !== undefined ? mode : CanvasKit.BlendMode.SrcOver;
+    this._writeRect(CMD_DRAW_COLOR, color4f, m.value);
+  };
+
   CanvasKit.Paint.prototype.getColor = function() {
     this._getColor(_scratchColorPtr);
     return copyColorFromWasm(_scratchColorPtr);
@@ -110,6 +110,21 @@ function canvasTests(CK: CanvasKit, canvas?: Canvas, paint?: Paint, path?: Path,
     canvas.drawColorComponents(0.2, 1.0, -0.02, 0.5, CK.BlendMode.ColorDodge);
     canvas.drawColorInt(CK.ColorAsInt(100, 110, 120));
     canvas.drawColorInt(CK.ColorAsInt(100, 110, 120), CK.BlendMode.ColorDodge);
+    const cmds = new CK.CommandBuffer();
+    const handle = cmds.addPaint(paint); // $ExpectType number
+    cmds.setPaint(handle, paint);
+    cmds.save();
+    cmds.translate(10, 20);
+    cmds.rotate(45, 5, 5);
+    cmds.concat([1, 0, 0, 0, 1, 0, 0, 0, 1]);
+    cmds.clipRect(someRect, CK.ClipOp.Intersect, true);
+    cmds.drawRect(someRect, handle);
+    cmds.drawRRect(someRRect, handle);
+    cmds.drawCircle(10, 10, 5, handle);
+    cmds.drawColor(someColor, CK.BlendMode.Multiply);
+    cmds.restore();
+    canvas.drawCommands(cmds);
+    cmds.reset();
     canvas.drawDRRect(someRRect, CK.RRectXY(someRect, 10, 20), paint);
     canvas.drawImage(img, 0, -43);
     canvas.drawImage(img, 0, -43, paint);
@@ -450,6 +450,7 @@ export interface CanvasKit {
                          filterPrefix?: string, soundMap?: SoundMap): ManagedSkottieAnimation;
 
     // Constructors, i.e. things made with `new CanvasKit.Foo()`;
+    readonly CommandBuffer: DefaultConstructor<CommandBuffer>;
     readonly ImageData: ImageDataConstructor;
     readonly ParagraphStyle: ParagraphStyleConstructor;
     readonly ContourMeasureIter: ContourMeasureIterConstructor;
@@ -547,6 +548,16 @@ export interface CanvasKit {
     readonly managed_skottie?: boolean; // true if advanced (managed) Skottie code was compiled in
     readonly rt_effect?: boolean; // true if RuntimeEffect was compiled in
     readonly skottie?: boolean; // true if base Skottie code was compiled in
+    readonly simd?: boolean; // true if built with WASM SIMD
+    readonly threads?: boolean; // true if built with pthreads
+
+    /**
+     * Only in builds with threads. Sets how many web workers run Skia's parallel work, such as
+     * threaded raster and decodes. Defaults to navigator.hardwareConcurrency; 0 runs that work on
+     * the calling thread.
+     * @param threads
+     */
+    setThreadCount?: (threads: number) => void;
 
     // Paragraph Enums
     readonly Affinity: AffinityEnumValues;
@@ -1459,6 +1470,13 @@ export interface Canvas extends EmbindObject<"Canvas"> {
      */
     drawColorInt(color: ColorInt, blendMode?: BlendMode): void;
 
+    /**
+     * Replays the commands recorded in the given CommandBuffer onto this canvas, with a single
+     * call into WASM. Replaying stops at the first invalid command.
+     * @param cmds
+     */
+    drawCommands(cmds: CommandBuffer): void;
+
     /**
      * Draws RRect outer and inner using clip, Matrix, and Paint paint.
      * outer must contain inner or the drawing is undefined.
@@ -1860,6 +1878,56 @@ export interface Canvas extends EmbindObject<"Canvas"> {
  */
 export type ColorFilter = EmbindObject<"ColorFilter">;
 
+/**
+ * Records draw commands into WASM memory, to be drawn with Canvas.drawCommands(). Drawing many
+ * simple shapes this way avoids a call into WASM for each of them. Paints are copied into the
+ * buffer once, and commands refer to them by the handle addPaint() returns.
+ */
+export interface CommandBuffer extends EmbindObject<"CommandBuffer"> {
+    /**
+     * Copies the paint into the buffer, and returns a handle for commands to draw with it.
+     * @param paint
+     */
+    addPaint(paint: Paint): number;
+
+    /**
+     * Replaces the paint with the given handle, for already recorded commands too.
+     * @param handle - returned by addPaint().
+     * @param paint
+     */
+    setPaint(handle: number, paint: Paint): void;
+
+    /**
+     * Returns how many paints have been added.
+     */
+    countPaints(): number;
+
+    /**
+     * Forgets all recorded commands. The memory and paints are kept for reuse.
+     */
+    reset(): void;
+
+    /**
+     * Returns how many floats the recorded commands take up.
+     */
+    size(): number;
+
+    save(): void;
+    restore(): void;
+    translate(dx: number, dy: number): void;
+    scale(sx: number, sy: number): void;
+    rotate(degrees: number, px?: number, py?: number): void;
+    concat(m: Matrix3x3 | Matrix4x4 | number[]): void;
+    clipRect(rect: Rect | number[], op: ClipOp, doAntiAlias: boolean): void;
+    drawRect(rect: Rect | number[], paint: number): void;
+    drawRRect(rrect: RRect | number[], paint: number): void;
+    drawOval(oval: Rect | number[], paint: number): void;
+    drawCircle(cx: number, cy: number, radius: number, paint: number): void;
+    drawLine(x0: number, y0: number, x1: number, y1: number, paint: number): void;
+    drawPaint(paint: number): void;
+    drawColor(color: Color | number[], blendMode?: BlendMode): void;
+}
+
 export interface ContourMeasureIter extends EmbindObject<"ContourMeasureIter"> {
     /**
      *  Iterates through contours in path, returning a contour-measure object for each contour
@@ -0,0 +1,60 @@
+// Picks which build of CanvasKit to load, based on what the current JS environment supports.
+//
+//   const variant = CanvasKitVariant.detect();  // e.g. 'simd-threads'
+//   const InitCanvasKit = require('canvaskit-wasm/' + CanvasKitVariant.entryPoint(variant));
+//
+// The 'simd' builds use WASM SIMD128 in the CPU backend. The 'simd-threads' build also runs
+// Skia's parallel work on web workers, which needs SharedArrayBuffer; in browsers that means the
+// page must be cross-origin isolated.
+(function(root, factory) {
+  if (typeof module === 'object' && module.exports) {
+    module.exports = factory();
+  } else {
+    root.CanvasKitVariant = factory();
+  }
+}(typeof self !== 'undefined' ? self : this, function() {
+  // A module with a function returning a v128.const, which only validates with SIMD support.
+  var SIMD_TEST_MODULE = new Uint8Array([
+    0, 97, 115, 109, 1, 0, 0, 0, 1, 5, 1, 96, 0, 1, 123, 3, 2, 1, 0, 10, 10, 1, 8, 0, 65, 0,
+    253, 15, 253, 98, 11,
+  ]);
+
+  function supportsSimd() {
+    try {
+      return typeof WebAssembly === 'object' && WebAssembly.validate(SIMD_TEST_MODULE);
+    } catch (e) {
+      return false;
+    }
+  }
+
+  function supportsThreads() {
+    if (typeof SharedArrayBuffer === 'undefined' ||
+        (typeof crossOriginIsolated !== 'undefined' && !crossOriginIsolated)) {
+      return false;
+    }
+    try {
+      var memory = new WebAssembly.Memory({initial: 1, maximum: 1, shared: true});
+      return memory.buffer instanceof SharedArrayBuffer;
+    } catch (e) {
+      return false;
+    }
+  }
+
+  return {
+    supportsSimd: supportsSimd,
+    supportsThreads: supportsThreads,
+
+    // Returns the fastest build this environment can run: 'simd-threads', 'simd' or ''.
+    detect: function() {
+      if (!supportsSimd()) {
+        return '';
+      }
+      return supportsThreads() ? 'simd-threads' : 'simd';
+    },
+
+    // Returns the path of the given build's canvaskit.js, relative to the package.
+    entryPoint: function(variant) {
+      return variant ? 'bin/' + variant + '/canvaskit.js' : 'bin/canvaskit.js';
+    },
+  };
+}));
@@ -134,6 +134,47 @@ describe('Canvas Behavior', () => {
         paint.delete();
     });
 
+    gm('command_buffer_canvas', (canvas) => {
+        const cmds = new CanvasKit.CommandBuffer();
+
+        const paint = new CanvasKit.Paint();
+        paint.setAntiAlias(true);
+        paint.setColor(CanvasKit.BLUE);
+        const fill = cmds.addPaint(paint);
+        paint.setStyle(CanvasKit.PaintStyle.Stroke);
+        paint.setStrokeWidth(4.0);
+        paint.setColor(CanvasKit.RED);
+        const stroke = cmds.addPaint(paint);
+        expect(cmds.countPaints()).toEqual(2);
+
+        cmds.drawColor(CanvasKit.WHITE);
+        // Enough commands that the buffer has to grow.
+        for (let i = 0; i < 100; i++) {
+            cmds.drawCircle(10 + (i % 10) * 20, 10 + Math.floor(i / 10) * 20, 8, fill);
+        }
+        cmds.save();
+        cmds.translate(100, 100);
+        cmds.rotate(30, 50, 50);
+        cmds.clipRect([0, 0, 200, 200], CanvasKit.ClipOp.Intersect, true);
+        cmds.drawRRect(CanvasKit.RRectXY([10, 10, 100, 60], 10, 10), stroke);
+        cmds.drawOval([10, 80, 100, 130], stroke);
+        cmds.drawLine(0, 0, 100, 150, stroke);
+        cmds.restore();
+
+        canvas.drawCommands(cmds);
+
+        // Paints can be changed after recording, and the commands drawn again.
+        paint.setColor(CanvasKit.Color(0, 200, 0, 0.5));
+        cmds.setPaint(stroke, paint);
+        cmds.reset();
+        expect(cmds.size()).toEqual(0);
+        cmds.drawRect([220, 220, 290, 290], stroke);
+        canvas.drawCommands(cmds);
+
+        paint.delete();
+        cmds.delete();
+    });
+
     gm('rrect_canvas', (canvas) => {
         const path = starPath(CanvasKit);
 
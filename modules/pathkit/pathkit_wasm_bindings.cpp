@@ -18,6 +18,7 @@
 #include "include/effects/SkTrimPathEffect.h"
 #include "include/pathops/SkPathOps.h"
 #include "include/private/base/SkFloatingPoint.h"
+#include "include/private/base/SkTo.h"
 #include "include/utils/SkParsePath.h"
 #include "src/base/SkFloatBits.h"
 #include "src/core/SkPaintDefaults.h"
@@ -26,6 +27,8 @@
 #include <emscripten.h>
 #include <emscripten/bind.h>
 
+#include <vector>
+
 using namespace emscripten;
 
 static const int MOVE = 0;
@@ -263,6 +266,124 @@ SkPathOrNull EMSCRIPTEN_KEEPALIVE ResolveBuilder(SkOpBuilder& builder) {
     return emscripten::val::null();
 }
 
+//========================================================================================
+// Batches of paths
+//========================================================================================
+
+// Holds many paths, so that ops and exports over all of them take one call instead of one per
+// path. The bulk exports are written to buffers owned by the batch and returned as typed array
+// views of WASM memory, without copying them into JS arrays. A view is only valid until the next
+// export of the same kind, until the batch is deleted, or until WASM memory grows (which any
+// PathKit call that allocates may do), so read or copy it right away.
+class PathBatch {
+public:
+    void add(const SkPath& path) {
+        fPaths.push_back(path);
+    }
+
+    int count() const {
+        return SkToInt(fPaths.size());
+    }
+
+    void reset() {
+        fPaths.clear();
+    }
+
+    SkPathOrNull get(int i) const {
+        if (i < 0 || i >= this->count()) {
+            return emscripten::val::null();
+        }
+        return emscripten::val(fPaths[i]);
+    }
+
+    // Returns the union of all the paths, or null if it could not be computed.
+    SkPathOrNull makeUnion() const {
+        SkOpBuilder builder;
+        for (const SkPath& path : fPaths) {
+            builder.add(path, kUnion_SkPathOp);
+        }
+        SkPath out;
+        if (builder.resolve(&out)) {
+            return emscripten::val(out);
+        }
+        return emscripten::val::null();
+    }
+
+    // Simplifies every path in place. Paths that can't be simplified are left as they were, and
+    // make this return false.
+    bool simplify() {
+        bool ok = true;
+        for (SkPath& path : fPaths) {
+            ok &= Simplify(path, &path);
+        }
+        return ok;
+    }
+
+    // Returns a Float32Array of the paths' bounds, 4 floats (left, top, right, bottom) per path.
+    emscripten::val getBounds() {
+        fBounds.resize(4 * fPaths.size());
+        for (size_t i = 0; i < fPaths.size(); ++i) {
+            const SkRect& r = fPaths[i].getBounds();
+            float* dst = fBounds.data() + 4 * i;
+            dst[0] = r.fLeft;
+            dst[1] = r.fTop;
+            dst[2] = r.fRight;
+            dst[3] = r.fBottom;
+        }
+        return emscripten::val(emscripten::typed_memory_view(fBounds.size(), fBounds.data()));
+    }
+
+    // Returns {cmds, offsets}. cmds is a Float32Array of every path's commands, in the flat
+    // format FromCmds() takes: each verb followed by its points. offsets is an Int32Array with
+    // count() + 1 entries; path i's commands are cmds[offsets[i]] up to cmds[offsets[i + 1]].
+    emscripten::val toCmds() {
+        fCmds.clear();
+        fCmdOffsets.resize(fPaths.size() + 1);
+        for (size_t i = 0; i < fPaths.size(); ++i) {
+            fCmdOffsets[i] = SkToS32(fCmds.size());
+            for (auto [verb, pts, w] : SkPathPriv::Iterate(fPaths[i])) {
+                switch (verb) {
+                case SkPathVerb::kMove:
+                    fCmds.insert(fCmds.end(), {MOVE, pts[0].x(), pts[0].y()});
+                    break;
+                case SkPathVerb::kLine:
+                    fCmds.insert(fCmds.end(), {LINE, pts[1].x(), pts[1].y()});
+                    break;
+                case SkPathVerb::kQuad:
+                    fCmds.insert(fCmds.end(), {QUAD, pts[1].x(), pts[1].y(),
+                                                     pts[2].x(), pts[2].y()});
+                    break;
+                case SkPathVerb::kConic:
+                    fCmds.insert(fCmds.end(), {CONIC, pts[1].x(), pts[1].y(),
+                                                      pts[2].x(), pts[2].y(), *w});
+                    break;
+                case SkPathVerb::kCubic:
+                    fCmds.insert(fCmds.end(), {CUBIC, pts[1].x(), pts[1].y(),
+                                                      pts[2].x(), pts[2].y(),
+                                                      pts[3].x(), pts[3].y()});
+                    break;
+                case SkPathVerb::kClose:
+                    fCmds.push_back(CLOSE);
+                    break;
+                }
+            }
+        }
+        fCmdOffsets.back() = SkToS32(fCmds.size());
+
+        emscripten::val result = emscripten::val::object();
+        result.set("cmds", emscripten::typed_memory_view(fCmds.size(), fCmds.data()));
+        result.set("offsets", emscripten::typed_memory_view(fCmdOffsets.size(),
+                                                           fCmdOffsets.data()));
+        return result;
+    }
+
+private:
+    std::vector<SkPath>  fPaths;
+    std::vector<float>   fBounds;
+    std::vector<float>   fCmds;
+    std::vector<int32_t> fCmdOffsets;
+};
+
 //========================================================================================
 // Canvas things
 //========================================================================================
@@ -551,6 +672,22 @@ EMSCRIPTEN_BINDINGS(skia) {
         .function("make", &ResolveBuilder)
         .function("resolve", &ResolveBuilder);
 
+    class_<PathBatch>("SkPathBatch")
+        .constructor<>()
+
+        .function("add", &PathBatch::add)
+        .function("count", &PathBatch::count)
+        .function("reset", &PathBatch::reset)
+        .function("get", &PathBatch::get)
+
+        // PathOps
+        .function("makeUnion", &PathBatch::makeUnion)
+        .function("simplify", &PathBatch::simplify)
+
+        // Exporting
+        .function("getBounds", &PathBatch::getBounds)
+        .function("toCmds", &PathBatch::toCmds);
+
     // Without these function() bindings, the function would be exposed but oblivious to
     // our types (e.g. SkPath)
 
@@ -165,6 +165,58 @@ describe('PathKit\'s Path Behavior', function() {
             });
         });
 
+        it('path_toCmds_many', function(done) {
+            function setup(ctx) {
+                ctx.paths = [];
+                for (let i = 0; i < 50; i++) {
+                    ctx.paths.push(drawPath());
+                }
+            }
+
+            function test(ctx) {
+                for (const path of ctx.paths) {
+                    path.toCmds();
+                    path.getBounds();
+                }
+            }
+
+            function teardown(ctx) {
+                ctx.paths.forEach((p) => p.delete());
+            }
+
+            LoadPathKit.then(() => {
+                benchmarkAndReport('path_toCmds_many', setup, test, teardown).then(() => {
+                    done();
+                }).catch(reportError(done));
+            });
+        });
+
+        it('path_toCmds_batch', function(done) {
+            function setup(ctx) {
+                ctx.batch = new PathKit.SkPathBatch();
+                for (let i = 0; i < 50; i++) {
+                    let path = drawPath();
+                    ctx.batch.add(path);
+                    path.delete();
+                }
+            }
+
+            function test(ctx) {
+                ctx.batch.toCmds();
+                ctx.batch.getBounds();
+            }
+
+            function teardown(ctx) {
+                ctx.batch.delete();
+            }
+
+            LoadPathKit.then(() => {
+                benchmarkAndReport('path_toCmds_batch', setup, test, teardown).then(() => {
+                    done();
+                }).catch(reportError(done));
+            });
+        });
+
         it('path_toPath2D', function(done) {
             function setup(ctx) {
                 ctx.path = drawPath();
@@ -152,4 +152,111 @@ describe('PathKit\'s Pathops', function() {
         });
     });
 
+    // The batch benchmarks compare one call over N paths with N calls.
+    const BATCH_SIZE = 50;
+
+    function drawStars(n) {
+        let stars = [];
+        for (let i = 0; i < n; i++) {
+            stars.push(drawStar(X=100 + (i % 10) * 15, Y=100 + Math.floor(i / 10) * 15, R=40));
+        }
+        return stars;
+    }
+
+    it('pathops_union_many', function(done) {
+        function setup(ctx) {
+            ctx.stars = drawStars(BATCH_SIZE);
+        }
+
+        function test(ctx) {
+            let path = PathKit.NewPath();
+            for (const star of ctx.stars) {
+                path.op(star, PathKit.PathOp.UNION);
+            }
+            path.delete();
+        }
+
+        function teardown(ctx) {
+            ctx.stars.forEach((s) => s.delete());
+        }
+
+        LoadPathKit.then(() => {
+            benchmarkAndReport('pathops_union_many', setup, test, teardown).then(() => {
+                done();
+            }).catch(reportError(done));
+        });
+    });
+
+    it('pathops_union_batch', function(done) {
+        function setup(ctx) {
+            ctx.stars = drawStars(BATCH_SIZE);
+            ctx.batch = new PathKit.SkPathBatch();
+            ctx.stars.forEach((s) => ctx.batch.add(s));
+        }
+
+        function test(ctx) {
+            let path = ctx.batch.makeUnion();
+            path.delete();
+        }
+
+        function teardown(ctx) {
+            ctx.stars.forEach((s) => s.delete());
+            ctx.batch.delete();
+        }
+
+        LoadPathKit.then(() => {
+            benchmarkAndReport('pathops_union_batch', setup, test, teardown).then(() => {
+                done();
+            }).catch(reportError(done));
+        });
+    });
+
+    it('pathops_simplify_many', function(done) {
+        function setup(ctx) {
+            ctx.stars = drawStars(BATCH_SIZE);
+        }
+
+        function test(ctx) {
+            for (const star of ctx.stars) {
+                let path = star.copy().simplify();
+                path.delete();
+            }
+        }
+
+        function teardown(ctx) {
+            ctx.stars.forEach((s) => s.delete());
+        }
+
+        LoadPathKit.then(() => {
+            benchmarkAndReport('pathops_simplify_many', setup, test, teardown).then(() => {
+                done();
+            }).catch(reportError(done));
+        });
+    });
+
+    it('pathops_simplify_batch', function(done) {
+        function setup(ctx) {
+            ctx.stars = drawStars(BATCH_SIZE);
+            ctx.batch = new PathKit.SkPathBatch();
+        }
+
+        function test(ctx) {
+            // Re-add the stars, so every run simplifies the same (unsimplified) paths.
+            ctx.batch.reset();
+            ctx.stars.forEach((s) => ctx.batch.add(s));
+            ctx.batch.simplify();
+        }
+
+        function teardown(ctx) {
+            ctx.stars.forEach((s) => s.delete());
+            ctx.batch.delete();
+        }
+
+        LoadPathKit.then(() => {
+            benchmarkAndReport('pathops_simplify_batch', setup, test, teardown).then(() => {
+                done();
+            }).catch(reportError(done));
+        });
+    });
+
 });
\ No newline at end of file
@@ -167,4 +167,45 @@ describe('PathKit\'s Path Behavior', function() {
         });
     });
 
+    describe('Path batches', function(){
+        it('exports bounds and commands of every path at once', function(done) {
+            LoadPathKit.then(catchException(done, () => {
+                let batch = new PathKit.SkPathBatch();
+                let paths = [];
+                for (let i = 0; i < 3; i++) {
+                    let path = PathKit.NewPath();
+                    path.moveTo(10 * i, 0);
+                    path.lineTo(10 * i + 5, 10);
+                    path.quadTo(10 * i, 20, 10 * i + 5, 30);
+                    path.close();
+                    batch.add(path);
+                    paths.push(path);
+                }
+                batch.add(PathKit.NewPath());
+                expect(batch.count()).toEqual(4);
+
+                let bounds = batch.getBounds();
+                expect(bounds.length).toEqual(16);
+                for (let i = 0; i < 3; i++) {
+                    let b = paths[i].getBounds();
+                    expect(Array.from(bounds.slice(4 * i, 4 * i + 4))).toEqual(
+                        [b.fLeft, b.fTop, b.fRight, b.fBottom]);
+                }
+
+                let {cmds, offsets} = batch.toCmds();
+                expect(offsets.length).toEqual(5);
+                for (let i = 0; i < 3; i++) {
+                    let flat = [].concat(...paths[i].toCmds());
+                    expect(Array.from(cmds.slice(offsets[i], offsets[i + 1]))).toEqual(flat);
+                }
+                // The empty path has no commands.
+                expect(offsets[4]).toEqual(offsets[3]);
+
+                paths.forEach((p) => p.delete());
+                batch.delete();
+                done();
+            }));
+        });
+    });
+
 });
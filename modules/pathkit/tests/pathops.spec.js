@@ -165,6 +165,46 @@ describe('PathKit\'s PathOps Behavior', function() {
         }));
     });
 
+    it('unions and simplifies batches of paths', function(done) {
+        LoadPathKit.then(catchException(done, () => {
+            let batch = new PathKit.SkPathBatch();
+            let expected = PathKit.NewPath();
+            for (let i = 0; i < 4; i++) {
+                let path = PathKit.NewPath();
+                path.rect(10 * i, 10 * i, 30, 30);
+                batch.add(path);
+                expected.op(path, PathKit.PathOp.UNION);
+                path.delete();
+            }
+
+            let union = batch.makeUnion();
+            expect(union).not.toBeNull();
+            expect(union.getBounds()).toEqual(expected.getBounds());
+            expect(union.toSVGString()).toEqual(expected.toSVGString());
+
+            // A self-intersecting bowtie, which simplify() splits into two triangles.
+            let bowtie = PathKit.NewPath();
+            bowtie.moveTo(0, 0).lineTo(20, 20).lineTo(20, 0).lineTo(0, 20).close();
+            batch.reset();
+            batch.add(bowtie);
+            batch.add(union);
+            expect(batch.simplify()).toBe(true);
+
+            let simplified = batch.get(0);
+            let expectedBowtie = bowtie.copy().simplify();
+            expect(simplified.toSVGString()).toEqual(expectedBowtie.toSVGString());
+            expect(batch.get(2)).toBeNull();
+
+            expectedBowtie.delete();
+            simplified.delete();
+            bowtie.delete();
+            union.delete();
+            expected.delete();
+            batch.delete();
+            done();
+        }));
+    });
+
     it('simplifies a path with .simplify() and matches what we see from C++', function(done) {
         LoadPathKit.then(catchException(done, () => {
             init();
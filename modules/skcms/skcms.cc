@@ -2297,10 +2297,15 @@ bool skcms_ApproximateCurve(const skcms_Curve* curve,
     return isfinitef_(*max_error);
 }
 
-enum class CpuType { Baseline, HSW, SKX };
+enum class CpuType { Baseline, HSW, SKX, Neon };
 
 static CpuType cpu_type() {
-    #if defined(SKCMS_PORTABLE) || !defined(__x86_64__) || defined(SKCMS_FORCE_BASELINE)
+    #if defined(SKCMS_PORTABLE) || defined(SKCMS_FORCE_BASELINE)
+        return CpuType::Baseline;
+    #elif defined(__aarch64__) && !defined(SKCMS_DISABLE_NEON)
+        // Every AArch64 CPU has what the Neon backend needs, so there's nothing to detect.
+        return CpuType::Neon;
+    #elif !defined(__x86_64__)
         return CpuType::Baseline;
     #elif defined(SKCMS_FORCE_HSW)
         return CpuType::HSW;
@@ -2492,42 +2497,34 @@ static bool prep_for_destination(const skcms_ICCProfile* profile,
         && skcms_Matrix3x3_invert(&profile->toXYZD50, fromXYZD50);
 }
 
-bool skcms_Transform(const void*             src,
-                     skcms_PixelFormat       srcFmt,
-                     skcms_AlphaFormat       srcAlpha,
-                     const skcms_ICCProfile* srcProfile,
-                     void*                   dst,
-                     skcms_PixelFormat       dstFmt,
-                     skcms_AlphaFormat       dstAlpha,
-                     const skcms_ICCProfile* dstProfile,
-                     size_t                  nz) {
-    const size_t dst_bpp = bytes_per_pixel(dstFmt),
-                 src_bpp = bytes_per_pixel(srcFmt);
-    // Let's just refuse if the request is absurdly big.
-    if (nz * dst_bpp > INT_MAX || nz * src_bpp > INT_MAX) {
-        return false;
-    }
-    int n = (int)nz;
-
-    // Null profiles default to sRGB. Passing null for both is handy when doing format conversion.
-    if (!srcProfile) {
-        srcProfile = skcms_sRGB_profile();
-    }
-    if (!dstProfile) {
-        dstProfile = skcms_sRGB_profile();
-    }
-
-    // We can't transform in place unless the PixelFormats are the same size.
-    if (dst == src && dst_bpp != src_bpp) {
-        return false;
-    }
-    // TODO: more careful alias rejection (like, dst == src + 1)?
-
+// Everything skcms_Transform() works out before it touches any pixels.
+struct TransformPlan {
     Op          program[32];
     const void* context[32];
+    ptrdiff_t   programSize;
+    size_t      src_bpp,
+                dst_bpp;
 
-    Op*          ops      = program;
-    const void** contexts = context;
+    // Op arguments that don't live in the profiles.
+    skcms_Curve      dst_curves[3];
+    skcms_Matrix3x3  from_xyz;
+    skcms_ICCProfile gray_dst_profile;
+};
+
+// Profiles must not be null. When sameProfiles is true, no color space conversion is planned.
+static bool plan_transform(skcms_PixelFormat       srcFmt,
+                           skcms_AlphaFormat       srcAlpha,
+                           const skcms_ICCProfile* srcProfile,
+                           skcms_PixelFormat       dstFmt,
+                           skcms_AlphaFormat       dstAlpha,
+                           const skcms_ICCProfile* dstProfile,
+                           bool                    sameProfiles,
+                           TransformPlan*          plan) {
+    plan->src_bpp = bytes_per_pixel(srcFmt);
+    plan->dst_bpp = bytes_per_pixel(dstFmt);
+
+    Op*          ops      = plan->program;
+    const void** contexts = plan->context;
 
     auto add_op = [&](Op o) {
         *ops++ = o;
@@ -2551,12 +2548,12 @@ bool skcms_Transform(const void*             src,
     };
 
     // These are always parametric curves of some sort.
-    skcms_Curve dst_curves[3];
+    skcms_Curve* dst_curves = plan->dst_curves;
     dst_curves[0].table_entries =
     dst_curves[1].table_entries =
     dst_curves[2].table_entries = 0;
 
-    skcms_Matrix3x3        from_xyz;
+    skcms_Matrix3x3& from_xyz = plan->from_xyz;
 
     switch (srcFmt >> 1) {
         default: return false;
@@ -2592,13 +2589,13 @@ bool skcms_Transform(const void*             src,
     if (srcFmt & 1) {
         add_op(Op::swap_rb);
     }
-    skcms_ICCProfile gray_dst_profile;
     if ((dstFmt >> 1) == (skcms_PixelFormat_G_8 >> 1)) {
         // When transforming to gray, stop at XYZ (by setting toXYZ to identity), then transform
         // luminance (Y) by the destination transfer function.
-        gray_dst_profile = *dstProfile;
-        skcms_SetXYZD50(&gray_dst_profile, &skcms_XYZD50_profile()->toXYZD50);
-        dstProfile = &gray_dst_profile;
+        plan->gray_dst_profile = *dstProfile;
+        skcms_SetXYZD50(&plan->gray_dst_profile, &skcms_XYZD50_profile()->toXYZD50);
+        dstProfile = &plan->gray_dst_profile;
+        sameProfiles = false;
     }
 
     if (srcProfile->data_color_space == skcms_Signature_CMYK) {
@@ -2615,7 +2612,7 @@ bool skcms_Transform(const void*             src,
         add_op(Op::unpremul);
     }
 
-    if (dstProfile != srcProfile) {
+    if (!sameProfiles) {
 
         if (!prep_for_destination(dstProfile,
                                   &from_xyz,
@@ -2783,11 +2780,26 @@ bool skcms_Transform(const void*             src,
             break;
     }
 
-    assert(ops      <= program + ARRAY_COUNT(program));
-    assert(contexts <= context + ARRAY_COUNT(context));
+    assert(ops      <= plan->program + ARRAY_COUNT(plan->program));
+    assert(contexts <= plan->context + ARRAY_COUNT(plan->context));
 
-    auto run = baseline::run_program;
+    plan->programSize = ops - plan->program;
+    return true;
+}
+
+using RunProgramFn = void (*)(const Op* program, const void** contexts, ptrdiff_t programSize,
+                              const char* src, char* dst, int n,
+                              const size_t src_bpp, const size_t dst_bpp);
+
+static RunProgramFn select_run_program() {
+    RunProgramFn run = baseline::run_program;
     switch (cpu_type()) {
+        case CpuType::Neon:
+            #if !defined(SKCMS_DISABLE_NEON)
+                run = neon::run_program;
+            #endif
+            break;
+
         case CpuType::SKX:
             #if !defined(SKCMS_DISABLE_SKX)
                 run = skx::run_program;
@@ -2803,11 +2815,95 @@ bool skcms_Transform(const void*             src,
         case CpuType::Baseline:
             break;
     }
+    return run;
+}
 
-    run(program, context, ops - program, (const char*)src, (char*)dst, n, src_bpp,dst_bpp);
+static bool run_plan(const TransformPlan& plan, RunProgramFn run,
+                     const void* src, void* dst, size_t nz) {
+    // Let's just refuse if the request is absurdly big.
+    if (nz * plan.dst_bpp > INT_MAX || nz * plan.src_bpp > INT_MAX) {
+        return false;
+    }
+    // We can't transform in place unless the PixelFormats are the same size.
+    if (dst == src && plan.dst_bpp != plan.src_bpp) {
+        return false;
+    }
+    // TODO: more careful alias rejection (like, dst == src + 1)?
+
+    run(plan.program, const_cast<const void**>(plan.context), plan.programSize,
+        (const char*)src, (char*)dst, (int)nz, plan.src_bpp, plan.dst_bpp);
     return true;
 }
 
+bool skcms_Transform(const void*             src,
+                     skcms_PixelFormat       srcFmt,
+                     skcms_AlphaFormat       srcAlpha,
+                     const skcms_ICCProfile* srcProfile,
+                     void*                   dst,
+                     skcms_PixelFormat       dstFmt,
+                     skcms_AlphaFormat       dstAlpha,
+                     const skcms_ICCProfile* dstProfile,
+                     size_t                  nz) {
+    // Null profiles default to sRGB. Passing null for both is handy when doing format conversion.
+    if (!srcProfile) {
+        srcProfile = skcms_sRGB_profile();
+    }
+    if (!dstProfile) {
+        dstProfile = skcms_sRGB_profile();
+    }
+
+    TransformPlan plan;
+    return plan_transform(srcFmt, srcAlpha, srcProfile, dstFmt, dstAlpha, dstProfile,
+                          /*sameProfiles=*/dstProfile == srcProfile, &plan)
+        && run_plan(plan, select_run_program(), src, dst, nz);
+}
+
+struct skcms_CompiledTransform {
+    TransformPlan    plan;
+    RunProgramFn     run;
+    // The plan's contexts point into these copies rather than the caller's profiles.
+    skcms_ICCProfile src_profile,
+                     dst_profile;
+};
+
+skcms_CompiledTransform* skcms_CompileTransform(skcms_PixelFormat       srcFmt,
+                                                skcms_AlphaFormat       srcAlpha,
+                                                const skcms_ICCProfile* srcProfile,
+                                                skcms_PixelFormat       dstFmt,
+                                                skcms_AlphaFormat       dstAlpha,
+                                                const skcms_ICCProfile* dstProfile) {
+    if (!srcProfile) {
+        srcProfile = skcms_sRGB_profile();
+    }
+    if (!dstProfile) {
+        dstProfile = skcms_sRGB_profile();
+    }
+
+    auto* xform = (skcms_CompiledTransform*)malloc(sizeof(skcms_CompiledTransform));
+    if (!xform) {
+        return nullptr;
+    }
+    xform->src_profile = *srcProfile;
+    xform->dst_profile = *dstProfile;
+    if (!plan_transform(srcFmt, srcAlpha, &xform->src_profile,
+                        dstFmt, dstAlpha, &xform->dst_profile,
+                        /*sameProfiles=*/dstProfile == srcProfile, &xform->plan)) {
+        free(xform);
+        return nullptr;
+    }
+    xform->run = select_run_program();
+    return xform;
+}
+
+bool skcms_RunCompiledTransform(const skcms_CompiledTransform* xform,
+                                const void* src, void* dst, size_t npixels) {
+    return run_plan(xform->plan, xform->run, src, dst, npixels);
+}
+
+void skcms_FreeCompiledTransform(skcms_CompiledTransform* xform) {
+    free(xform);
+}
+
 static void assert_usable_as_destination(const skcms_ICCProfile* profile) {
 #if defined(NDEBUG)
     (void)profile;
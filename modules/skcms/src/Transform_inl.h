@@ -48,7 +48,7 @@ using U8  = V<uint8_t>;
 
 // Similar to the AVX+ features, we define USING_NEON and USING_NEON_F16C.
 // This is more for organizational clarity... skcms.cc doesn't force these.
-#if N > 1 && defined(__ARM_NEON)
+#if N == 4 && defined(__ARM_NEON)
     #define USING_NEON
 
     // We have to use two different mechanisms to enable the f16 conversion intrinsics:
@@ -66,6 +66,12 @@ using U8  = V<uint8_t>;
     #endif
 #endif
 
+// The AArch64 backend runs 8 lanes, each vector a pair of NEON registers. The 4-lane NEON
+// loads and stores don't apply there, but the f16 conversions and floor do, a half at a time.
+#if N == 8 && defined(__aarch64__)
+    #define USING_NEON_X2
+#endif
+
 // These -Wvector-conversion warnings seem to trigger in very bogus situations,
 // like vst3q_f32() expecting a 16x char rather than a 4x float vector.  :/
 #if defined(USING_NEON) && defined(__clang__)
@@ -75,7 +81,7 @@ using U8  = V<uint8_t>;
 // GCC & Clang (but not clang-cl) warn returning U64 on x86 is larger than a register.
 // You'd see warnings like, "using AVX even though AVX is not enabled".
 // We stifle these warnings; our helpers that return U64 are always inlined.
-#if defined(__SSE__) && defined(__GNUC__)
+#if (defined(__SSE__) || defined(USING_NEON_X2)) && defined(__GNUC__)
     #if !defined(__has_warning)
         #pragma GCC diagnostic ignored "-Wpsabi"
     #elif __has_warning("-Wpsabi")
@@ -153,6 +159,10 @@ SI U32 to_fixed(F f) {  return (U32)cast<I32>(f + 0.5f); }
 SI F F_from_Half(U16 half) {
 #if defined(USING_NEON_F16C)
     return vcvt_f32_f16((float16x4_t)half);
+#elif defined(USING_NEON_X2)
+    float16x8_t h = bit_pun<float16x8_t>(half);
+    float32x4_t f[2] = { vcvt_f32_f16(vget_low_f16(h)), vcvt_high_f32_f16(h) };
+    return load<F>(f);
 #elif defined(USING_AVX512F)
     return (F)_mm512_cvtph_ps((__m256i)half);
 #elif defined(USING_AVX_F16C)
@@ -180,6 +190,10 @@ SI F F_from_Half(U16 half) {
 SI U16 Half_from_F(F f) {
 #if defined(USING_NEON_F16C)
     return (U16)vcvt_f16_f32(f);
+#elif defined(USING_NEON_X2)
+    float32x4_t parts[2];
+    store(parts, f);
+    return bit_pun<U16>(vcvt_high_f16_f32(vcvt_f16_f32(parts[0]), parts[1]));
 #elif defined(USING_AVX512F)
     return (U16)_mm512_cvtps_ph((__m512 )f, _MM_FROUND_CUR_DIRECTION );
 #elif defined(USING_AVX_F16C)
@@ -219,8 +233,14 @@ SI U64 swap_endian_16x4(const U64& rgba) {
 SI F floor_(F x) {
 #if N == 1
     return floorf_(x);
-#elif defined(__aarch64__)
+#elif defined(USING_NEON) && defined(__aarch64__)
     return vrndmq_f32(x);
+#elif defined(USING_NEON_X2)
+    float32x4_t parts[2];
+    store(parts, x);
+    parts[0] = vrndmq_f32(parts[0]);
+    parts[1] = vrndmq_f32(parts[1]);
+    return load<F>(parts);
 #elif defined(USING_AVX512F)
     // Clang's _mm512_floor_ps() passes its mask as -1, not (__mmask16)-1,
     // and integer santizer catches that this implicit cast changes the
@@ -154,6 +154,13 @@ void run_program(const Op* program, const void** contexts, ptrdiff_t programSize
 }
 namespace skx {
 
+void run_program(const Op* program, const void** contexts, ptrdiff_t programSize,
+                 const char* src, char* dst, int n,
+                 const size_t src_bpp, const size_t dst_bpp);
+
+}
+namespace neon {
+
 void run_program(const Op* program, const void** contexts, ptrdiff_t programSize,
                  const char* src, char* dst, int n,
                  const size_t src_bpp, const size_t dst_bpp);
@@ -0,0 +1,44 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "skcms_public.h"     // NO_G3_REWRITE
+#include "skcms_internals.h"  // NO_G3_REWRITE
+#include "skcms_Transform.h"  // NO_G3_REWRITE
+#include <assert.h>
+#include <float.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__aarch64__)
+    #include <arm_neon.h>
+#endif
+
+namespace skcms_private {
+namespace neon {
+
+#if defined(SKCMS_DISABLE_NEON) || !defined(__aarch64__)
+
+void run_program(const Op* program, const void** contexts, ptrdiff_t programSize,
+                 const char* src, char* dst, int n,
+                 const size_t src_bpp, const size_t dst_bpp) {
+    skcms_private::baseline::run_program(program, contexts, programSize,
+                                         src, dst, n, src_bpp, dst_bpp);
+}
+
+#else
+
+// Every AArch64 CPU has 32 NEON registers and f16 conversions, so unlike the 4-lane baseline
+// we can keep 8 lanes in flight per op without any runtime checks.
+#define N 8
+template <typename T> using V = skcms_private::Vec<N,T>;
+#include "Transform_inl.h"
+
+#endif
+
+}  // namespace neon
+}  // namespace skcms_private
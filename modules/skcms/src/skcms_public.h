@@ -354,6 +354,28 @@ SKCMS_API bool skcms_Transform(const void*             src,
                                const skcms_ICCProfile* dstProfile,
                                size_t                  npixels);
 
+// skcms_Transform() works out which ops to run (classifying curves, inverting and concatenating
+// matrices) on every call. To convert many rows with the same formats and profiles, compile the
+// transform once and run it on each row instead. The profiles are copied, but any tables they
+// point into must outlive the compiled transform. Returns null if skcms_Transform() would fail
+// for these formats and profiles.
+typedef struct skcms_CompiledTransform skcms_CompiledTransform;
+
+SKCMS_API skcms_CompiledTransform* skcms_CompileTransform(skcms_PixelFormat       srcFmt,
+                                                          skcms_AlphaFormat       srcAlpha,
+                                                          const skcms_ICCProfile* srcProfile,
+                                                          skcms_PixelFormat       dstFmt,
+                                                          skcms_AlphaFormat       dstAlpha,
+                                                          const skcms_ICCProfile* dstProfile);
+
+// Like skcms_Transform() with the compiled formats and profiles. Safe to call concurrently.
+SKCMS_API bool skcms_RunCompiledTransform(const skcms_CompiledTransform*,
+                                          const void* src,
+                                          void*       dst,
+                                          size_t      npixels);
+
+SKCMS_API void skcms_FreeCompiledTransform(skcms_CompiledTransform*);
+
 // If profile can be used as a destination in skcms_Transform, return true. Otherwise, attempt to
 // rewrite it with approximations where reasonable. If successful, return true. If no reasonable
 // approximation exists, leave the profile unchanged and return false.
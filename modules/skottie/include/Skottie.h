@@ -23,9 +23,12 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <vector>
 
 class SkCanvas;
+class SkData;
+class SkExecutor;
 class SkStream;
 struct SkRect;
 
@@ -38,9 +41,23 @@ class RenderNode;
 
 namespace SkShapers { class Factory; }
 
+namespace skjson {
+
+class DOM;
+class ObjectValue;
+
+} // namespace skjson
+
 namespace skottie {
 
-namespace internal { class Animator; }
+namespace internal {
+
+class Animator;
+class TemplateCache;
+
+} // namespace internal
+
+class AnimationTemplate;
 
 using ImageAsset = skresources::ImageAsset;
 using ResourceProvider = skresources::ResourceProvider;
@@ -170,18 +187,65 @@ public:
         Builder& setTextShapingFactory(sk_sp<SkShapers::Factory>);
 
         /**
-         * Animation factories.
+         * Registers an executor used by seek() to evaluate the animators of separate top-level
+         * layers and precomps concurrently, before the scene graph is revalidated on the calling
+         * thread.  The executor must outlive the animation.
+         *
+         * Expression evaluators, external layers and image assets may then be called from the
+         * executor's threads, and concurrently for separate layers.
+         */
+        Builder& setAnimatorExecutor(SkExecutor*);
+
+        /**
+         * Enables raster caching of layer content (shapes, text and precomps), with images using
+         * up to |bytes| in total.  Content is rasterized after it renders unchanged for a few
+         * frames, and the image is reused until the content or the layer scale changes.
+         *
+         * Caching is off by default (0 bytes).
+         */
+        Builder& setLayerCacheBudget(size_t bytes);
+
+        /**
+         * Animation factories.  Besides Lottie JSON, they accept the pre-parsed binary form
+         * produced by ConvertToBinary(), which loads without parsing JSON text.
          */
         sk_sp<Animation> make(SkStream*);
         sk_sp<Animation> make(const char* data, size_t length);
         sk_sp<Animation> makeFromFile(const char path[]);
 
+        /**
+         * Parses an animation once, into a template for building any number of animations
+         * (e.g. the same animation playing in many tiles).  See AnimationTemplate.
+         *
+         * Returns null if the data is not a JSON object.
+         */
+        sk_sp<AnimationTemplate> makeTemplate(const char* data, size_t length);
+
+        /**
+         * Builds an animation from a template.  Apart from the first, these skip parsing the
+         * JSON, and share their keyframes and images with the other animations built from the
+         * same template.
+         */
+        sk_sp<Animation> make(const AnimationTemplate&);
+
+        /**
+         * Converts Lottie JSON to the pre-parsed binary form.  The binary form is larger than
+         * the JSON, and is specific to the Skia version which wrote it: it is meant as a load
+         * time cache, not for long-term storage.
+         *
+         * Returns null if the data is not a JSON object.
+         */
+        static sk_sp<SkData> ConvertToBinary(const char* data, size_t length);
+
         /**
          * Get handle for SlotManager after animation is built.
          */
         const sk_sp<SlotManager>& getSlotManager() const {return fSlotManager;}
 
     private:
+        // Builds the animation for a parsed JSON root, after fStats' JSON fields are set.
+        sk_sp<Animation> build(const skjson::ObjectValue&, sk_sp<internal::TemplateCache>);
+
         const uint32_t          fFlags;
 
         sk_sp<ResourceProvider>   fResourceProvider;
@@ -193,6 +257,8 @@ public:
         sk_sp<ExpressionManager>  fExpressionManager;
         sk_sp<SkShapers::Factory> fShapingFactory;
         sk_sp<SlotManager>        fSlotManager;
+        SkExecutor*               fAnimatorExecutor = nullptr;
+        size_t                    fLayerCacheBudget = 0;
         Stats                     fStats;
     };
 
@@ -232,6 +298,21 @@ public:
     void render(SkCanvas* canvas, const SkRect* dst = nullptr) const;
     void render(SkCanvas* canvas, const SkRect* dst, RenderFlags) const;
 
+    /**
+     * Redraws only the |damage| area of the current animation frame, in animation coordinates
+     * (e.g. the bounds of the InvalidationController passed to the last seek).  The area is
+     * cleared to transparent and redrawn, skipping content which lies outside of it.
+     *
+     * The canvas must hold the previous frame, rendered with the same dst and flags.
+     *
+     * @param canvas   destination canvas
+     * @param damage   the area to redraw
+     * @param dst      optional destination rect
+     * @param flags    optional RenderFlags
+     */
+    void renderDamage(SkCanvas* canvas, const SkRect& damage, const SkRect* dst = nullptr,
+                      RenderFlags flags = 0) const;
+
     /**
      * [Deprecated: use one of the other versions.]
      *
@@ -293,7 +374,10 @@ private:
     Animation(sk_sp<sksg::RenderNode>,
               std::vector<sk_sp<internal::Animator>>&&,
               SkString ver, const SkSize& size,
-              double inPoint, double outPoint, double duration, double fps, uint32_t flags);
+              double inPoint, double outPoint, double duration, double fps, uint32_t flags,
+              SkExecutor* animatorExecutor);
+
+    void renderFrame(SkCanvas*, const SkRect* dst, RenderFlags, const SkRect* damage) const;
 
     const sk_sp<sksg::RenderNode>                fSceneRoot;
     const std::vector<sk_sp<internal::Animator>> fAnimators;
@@ -304,10 +388,36 @@ private:
                                                  fDuration,
                                                  fFPS;
     const uint32_t                               fFlags;
+    SkExecutor* const                            fAnimatorExecutor;
 
     using INHERITED = SkNVRefCnt<Animation>;
 };
 
+/**
+ * A parsed animation, from Animation::Builder::makeTemplate(), which Animation::Builder can build
+ * any number of animations from.
+ *
+ * Each animation still builds its own scene graph, and has its own playback state and
+ * SlotManager.  Immutable data is shared with the other animations built from the template: the
+ * JSON, keyframes, and images (other than multi-frame or slotted ones).  Images are loaded by
+ * the ResourceProvider of the first animation which needs them.
+ *
+ * Animations may be built from a template on several threads at once.
+ */
+class SK_API AnimationTemplate final : public SkNVRefCnt<AnimationTemplate> {
+public:
+    ~AnimationTemplate();
+
+private:
+    friend class Animation::Builder;
+
+    AnimationTemplate(std::unique_ptr<skjson::DOM>, size_t json_size);
+
+    const std::unique_ptr<skjson::DOM>   fDOM;
+    const sk_sp<internal::TemplateCache> fCache;
+    const size_t                         fJsonSize;
+};
+
 } // namespace skottie
 
 #endif // Skottie_DEFINED
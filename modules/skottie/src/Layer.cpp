@@ -25,6 +25,7 @@
 #include "modules/skottie/src/animator/Animator.h"
 #include "modules/skottie/src/effects/Effects.h"
 #include "modules/skottie/src/effects/MotionBlurEffect.h"
+#include "modules/sksg/include/SkSGCacheEffect.h"
 #include "modules/sksg/include/SkSGClipEffect.h"
 #include "modules/sksg/include/SkSGDraw.h"
 #include "modules/sksg/include/SkSGGeometryNode.h"
@@ -446,27 +447,28 @@ sk_sp<sksg::RenderNode> LayerBuilder::buildRenderTree(const AnimationBuilder& ab
     enum : uint32_t {
         kTransformEffects = 0x01, // The layer transform also applies to its effects.
         kForceSeek        = 0x02, // Dispatch all seek() events even when the layer is inactive.
+        kCacheContent     = 0x04, // The content is worth caching as an image while unchanged.
     };
 
     static constexpr struct {
         LayerBuilder                      fBuilder;
         uint32_t                          fFlags;
     } gLayerBuildInfo[] = {
-        { &AnimationBuilder::attachPrecompLayer, kTransformEffects },  // 'ty':  0 -> precomp
-        { &AnimationBuilder::attachSolidLayer  , kTransformEffects },  // 'ty':  1 -> solid
-        { &AnimationBuilder::attachFootageLayer, kTransformEffects },  // 'ty':  2 -> image
-        { &AnimationBuilder::attachNullLayer   ,                 0 },  // 'ty':  3 -> null
-        { &AnimationBuilder::attachShapeLayer  ,                 0 },  // 'ty':  4 -> shape
-        { &AnimationBuilder::attachTextLayer   ,                 0 },  // 'ty':  5 -> text
-        { &AnimationBuilder::attachAudioLayer  ,        kForceSeek },  // 'ty':  6 -> audio
-        { nullptr                              ,                 0 },  // 'ty':  7 -> pholderVideo
-        { nullptr                              ,                 0 },  // 'ty':  8 -> imageSeq
-        { &AnimationBuilder::attachFootageLayer, kTransformEffects },  // 'ty':  9 -> video
-        { nullptr                              ,                 0 },  // 'ty': 10 -> pholderStill
-        { nullptr                              ,                 0 },  // 'ty': 11 -> guide
-        { nullptr                              ,                 0 },  // 'ty': 12 -> adjustment
-        { &AnimationBuilder::attachNullLayer   ,                 0 },  // 'ty': 13 -> camera
-        { nullptr                              ,                 0 },  // 'ty': 14 -> light
+        { &AnimationBuilder::attachPrecompLayer, kTransformEffects | kCacheContent },  // 'ty':  0 -> precomp
+        { &AnimationBuilder::attachSolidLayer  ,                 kTransformEffects },  // 'ty':  1 -> solid
+        { &AnimationBuilder::attachFootageLayer,                 kTransformEffects },  // 'ty':  2 -> image
+        { &AnimationBuilder::attachNullLayer   ,                                 0 },  // 'ty':  3 -> null
+        { &AnimationBuilder::attachShapeLayer  ,                     kCacheContent },  // 'ty':  4 -> shape
+        { &AnimationBuilder::attachTextLayer   ,                     kCacheContent },  // 'ty':  5 -> text
+        { &AnimationBuilder::attachAudioLayer  ,                        kForceSeek },  // 'ty':  6 -> audio
+        { nullptr                              ,                                 0 },  // 'ty':  7 -> pholderVideo
+        { nullptr                              ,                                 0 },  // 'ty':  8 -> imageSeq
+        { &AnimationBuilder::attachFootageLayer,                 kTransformEffects },  // 'ty':  9 -> video
+        { nullptr                              ,                                 0 },  // 'ty': 10 -> pholderStill
+        { nullptr                              ,                                 0 },  // 'ty': 11 -> guide
+        { nullptr                              ,                                 0 },  // 'ty': 12 -> adjustment
+        { &AnimationBuilder::attachNullLayer   ,                                 0 },  // 'ty': 13 -> camera
+        { nullptr                              ,                                 0 },  // 'ty': 14 -> light
     };
 
     if (fType < 0 || static_cast<size_t>(fType) >= std::size(gLayerBuildInfo)) {
@@ -501,6 +503,12 @@ sk_sp<sksg::RenderNode> LayerBuilder::buildRenderTree(const AnimationBuilder& ab
     // Optional layer mask.
     layer = AttachMask(fJlayer["masksProperties"], &abuilder, std::move(layer));
 
+    // Optional content cache.  Content is only rasterized once it stops changing, so animated
+    // layers are cached over the time ranges where they are static.
+    if (layer && abuilder.fLayerCacheBudget && (build_info.fFlags & kCacheContent)) {
+        layer = sksg::CacheEffect::Make(std::move(layer), abuilder.fLayerCacheBudget);
+    }
+
     // Does the transform apply to effects also?
     // (AE quirk: it doesn't - except for solid layers)
     const auto transform_effects = (build_info.fFlags & kTransformEffects);
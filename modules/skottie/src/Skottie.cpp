@@ -7,14 +7,18 @@
 
 #include "modules/skottie/include/Skottie.h"
 
+#include "include/core/SkBlendMode.h"
 #include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
 #include "include/core/SkData.h"
 #include "include/core/SkFontMgr.h"
+#include "include/core/SkM44.h"
 #include "include/core/SkMatrix.h"
 #include "include/core/SkRect.h"
 #include "include/core/SkStream.h"
 #include "include/private/base/SkDebug.h"
 #include "include/private/base/SkFloatingPoint.h"
+#include "include/private/base/SkMutex.h"
 #include "include/private/base/SkTPin.h"
 #include "include/private/base/SkTo.h"
 #include "modules/skottie/include/ExternalLayer.h"
@@ -27,11 +31,14 @@
 #include "modules/skottie/src/SkottieValue.h"
 #include "modules/skottie/src/Transform.h"  // IWYU pragma: keep
 #include "modules/skottie/src/animator/Animator.h"
+#include "modules/skottie/src/animator/KeyframeAnimator.h"
 #include "modules/skottie/src/text/TextAdapter.h"
+#include "modules/sksg/include/SkSGNode.h"
 #include "modules/sksg/include/SkSGOpacityEffect.h"
 #include "modules/sksg/include/SkSGRenderNode.h"
 #include "modules/skshaper/include/SkShaper_factory.h"
 #include "src/core/SkTHash.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/core/SkTraceEvent.h"
 #include "src/utils/SkJSON.h"
 
@@ -45,6 +52,7 @@
 #include <memory>
 #include <ratio>
 #include <utility>
+#include <vector>
 
 #if !defined(SK_DISABLE_LEGACY_SHAPER_FACTORY)
 #include "modules/skshaper/utils/FactoryHelpers.h"
@@ -68,6 +76,37 @@ void SceneGraphRevalidator::revalidate() {
     }
 }
 
+TemplateCache::TemplateCache() = default;
+TemplateCache::~TemplateCache() = default;
+
+sk_sp<const KeyframeData> TemplateCache::findKeyframes(const skjson::ArrayValue& jkfs,
+                                                       const void* kind) const {
+    SkAutoMutexExclusive lock(fMutex);
+    const auto* data = fKeyframes.find({&jkfs, kind});
+    return data ? *data : nullptr;
+}
+
+sk_sp<const KeyframeData> TemplateCache::addKeyframes(const skjson::ArrayValue& jkfs,
+                                                      const void* kind,
+                                                      sk_sp<const KeyframeData> data) {
+    SkAutoMutexExclusive lock(fMutex);
+    if (const auto* found = fKeyframes.find({&jkfs, kind})) {
+        return *found;
+    }
+    return *fKeyframes.set({&jkfs, kind}, std::move(data));
+}
+
+sk_sp<ImageAsset> TemplateCache::findImage(const SkString& id) const {
+    SkAutoMutexExclusive lock(fMutex);
+    const auto* asset = fImages.find(id);
+    return asset ? *asset : nullptr;
+}
+
+void TemplateCache::addImage(const SkString& id, sk_sp<ImageAsset> asset) {
+    SkAutoMutexExclusive lock(fMutex);
+    fImages.set(id, std::move(asset));
+}
+
 void AnimationBuilder::log(Logger::Level lvl, const skjson::Value* json,
                            const char fmt[], ...) const {
     if (!fLogger) {
@@ -144,7 +183,8 @@ AnimationBuilder::AnimationBuilder(sk_sp<ResourceProvider> rp, sk_sp<SkFontMgr>
                                    sk_sp<SkShapers::Factory> shapingFactory,
                                    Animation::Builder::Stats* stats,
                                    const SkSize& comp_size, float duration, float framerate,
-                                   uint32_t flags)
+                                   uint32_t flags, size_t layer_cache_budget,
+                                   sk_sp<TemplateCache> template_cache)
     : fResourceProvider(std::move(rp))
     , fFontMgr(std::move(fontmgr))
     , fPropertyObserver(std::move(pobserver))
@@ -155,6 +195,10 @@ AnimationBuilder::AnimationBuilder(sk_sp<ResourceProvider> rp, sk_sp<SkFontMgr>
     , fShapingFactory(std::move(shapingFactory))
     , fRevalidator(sk_make_sp<SceneGraphRevalidator>())
     , fSlotManager(sk_make_sp<SlotManager>(fRevalidator))
+    , fLayerCacheBudget(layer_cache_budget
+                            ? sk_make_sp<sksg::CacheEffect::Budget>(layer_cache_budget)
+                            : nullptr)
+    , fTemplateCache(std::move(template_cache))
     , fStats(stats)
     , fCompSize(comp_size)
     , fDuration(duration)
@@ -301,6 +345,13 @@ void AnimationBuilder::AutoPropertyTracker::updateContext(PropertyObserver* obse
 
 } // namespace internal
 
+AnimationTemplate::AnimationTemplate(std::unique_ptr<skjson::DOM> dom, size_t json_size)
+    : fDOM(std::move(dom))
+    , fCache(sk_make_sp<internal::TemplateCache>())
+    , fJsonSize(json_size) {}
+
+AnimationTemplate::~AnimationTemplate() = default;
+
 Animation::Builder::Builder(uint32_t flags) : fFlags(flags) {}
 Animation::Builder::Builder(const Builder&) = default;
 Animation::Builder::Builder(Builder&&) = default;
@@ -346,6 +397,16 @@ Animation::Builder& Animation::Builder::setTextShapingFactory(sk_sp<SkShapers::F
     return *this;
 }
 
+Animation::Builder& Animation::Builder::setAnimatorExecutor(SkExecutor* executor) {
+    fAnimatorExecutor = executor;
+    return *this;
+}
+
+Animation::Builder& Animation::Builder::setLayerCacheBudget(size_t bytes) {
+    fLayerCacheBudget = bytes;
+    return *this;
+}
+
 sk_sp<Animation> Animation::Builder::make(SkStream* stream) {
     if (!stream->hasLength()) {
         // TODO: handle explicit buffering?
@@ -366,22 +427,28 @@ sk_sp<Animation> Animation::Builder::make(SkStream* stream) {
     return this->make(static_cast<const char*>(data->data()), data->size());
 }
 
+sk_sp<SkData> Animation::Builder::ConvertToBinary(const char* data, size_t data_len) {
+    const skjson::DOM dom(data, data_len);
+    if (!dom.root().is<skjson::ObjectValue>()) {
+        return nullptr;
+    }
+
+    SkDynamicMemoryWStream stream;
+    dom.write(&stream, skjson::DOM::Format::kBinary);
+    return stream.detachAsData();
+}
+
 sk_sp<Animation> Animation::Builder::make(const char* data, size_t data_len) {
     TRACE_EVENT0("skottie", TRACE_FUNC);
 
-    // Sanitize factory args.
-    class NullResourceProvider final : public ResourceProvider {
-        sk_sp<SkData> load(const char[], const char[]) const override { return nullptr; }
-    };
-    auto resolvedProvider = fResourceProvider
-            ? fResourceProvider : sk_make_sp<NullResourceProvider>();
-
     fStats = Stats{};
 
     fStats.fJsonSize = data_len;
     const auto t0 = std::chrono::steady_clock::now();
 
-    const skjson::DOM dom(data, data_len);
+    const skjson::DOM dom(data, data_len, skjson::DOM::IsBinary(data, data_len)
+                                                  ? skjson::DOM::Format::kBinary
+                                                  : skjson::DOM::Format::kText);
     if (!dom.root().is<skjson::ObjectValue>()) {
         // TODO: more error info.
         if (fLogger) {
@@ -389,11 +456,51 @@ sk_sp<Animation> Animation::Builder::make(const char* data, size_t data_len) {
         }
         return nullptr;
     }
-    const auto& json = dom.root().as<skjson::ObjectValue>();
 
     const auto t1 = std::chrono::steady_clock::now();
     fStats.fJsonParseTimeMS = std::chrono::duration<float, std::milli>{t1-t0}.count();
 
+    return this->build(dom.root().as<skjson::ObjectValue>(), nullptr);
+}
+
+sk_sp<AnimationTemplate> Animation::Builder::makeTemplate(const char* data, size_t data_len) {
+    TRACE_EVENT0("skottie", TRACE_FUNC);
+
+    auto dom = std::make_unique<skjson::DOM>(data, data_len,
+                                             skjson::DOM::IsBinary(data, data_len)
+                                                     ? skjson::DOM::Format::kBinary
+                                                     : skjson::DOM::Format::kText);
+    if (!dom->root().is<skjson::ObjectValue>()) {
+        if (fLogger) {
+            fLogger->log(Logger::Level::kError, "Failed to parse JSON input.\n");
+        }
+        return nullptr;
+    }
+
+    return sk_sp<AnimationTemplate>(new AnimationTemplate(std::move(dom), data_len));
+}
+
+sk_sp<Animation> Animation::Builder::make(const AnimationTemplate& animation_template) {
+    TRACE_EVENT0("skottie", TRACE_FUNC);
+
+    fStats = Stats{};
+    fStats.fJsonSize = animation_template.fJsonSize;
+
+    return this->build(animation_template.fDOM->root().as<skjson::ObjectValue>(),
+                       animation_template.fCache);
+}
+
+sk_sp<Animation> Animation::Builder::build(const skjson::ObjectValue& json,
+                                           sk_sp<internal::TemplateCache> template_cache) {
+    // Sanitize factory args.
+    class NullResourceProvider final : public ResourceProvider {
+        sk_sp<SkData> load(const char[], const char[]) const override { return nullptr; }
+    };
+    auto resolvedProvider = fResourceProvider
+            ? fResourceProvider : sk_make_sp<NullResourceProvider>();
+
+    const auto t0 = std::chrono::steady_clock::now();
+
     const auto version  = ParseDefault<SkString>(json["v"], SkString());
     const auto size     = SkSize::Make(ParseDefault<float>(json["w"], 0.0f),
                                        ParseDefault<float>(json["h"], 0.0f));
@@ -427,14 +534,15 @@ sk_sp<Animation> Animation::Builder::make(const char* data, size_t data_len) {
                                        std::move(fPrecompInterceptor),
                                        std::move(fExpressionManager),
                                        std::move(factory),
-                                       &fStats, size, duration, fps, fFlags);
+                                       &fStats, size, duration, fps, fFlags,
+                                       fLayerCacheBudget, std::move(template_cache));
     auto ainfo = builder.parse(json);
 
     fSlotManager = ainfo.fSlotManager;
 
-    const auto t2 = std::chrono::steady_clock::now();
-    fStats.fSceneParseTimeMS = std::chrono::duration<float, std::milli>{t2-t1}.count();
-    fStats.fTotalLoadTimeMS  = std::chrono::duration<float, std::milli>{t2-t0}.count();
+    const auto t1 = std::chrono::steady_clock::now();
+    fStats.fSceneParseTimeMS = std::chrono::duration<float, std::milli>{t1-t0}.count();
+    fStats.fTotalLoadTimeMS  = fStats.fJsonParseTimeMS + fStats.fSceneParseTimeMS;
 
     if (!ainfo.fSceneRoot && fLogger) {
         fLogger->log(Logger::Level::kError, "Could not parse animation.\n");
@@ -453,7 +561,8 @@ sk_sp<Animation> Animation::Builder::make(const char* data, size_t data_len) {
                                           outPoint,
                                           duration,
                                           fps,
-                                          flags));
+                                          flags,
+                                          fAnimatorExecutor));
 }
 
 sk_sp<Animation> Animation::Builder::makeFromFile(const char path[]) {
@@ -466,7 +575,8 @@ sk_sp<Animation> Animation::Builder::makeFromFile(const char path[]) {
 Animation::Animation(sk_sp<sksg::RenderNode> scene_root,
                      std::vector<sk_sp<internal::Animator>>&& animators,
                      SkString version, const SkSize& size,
-                     double inPoint, double outPoint, double duration, double fps, uint32_t flags)
+                     double inPoint, double outPoint, double duration, double fps, uint32_t flags,
+                     SkExecutor* animatorExecutor)
     : fSceneRoot(std::move(scene_root))
     , fAnimators(std::move(animators))
     , fVersion(std::move(version))
@@ -475,7 +585,8 @@ Animation::Animation(sk_sp<sksg::RenderNode> scene_root,
     , fOutPoint(outPoint)
     , fDuration(duration)
     , fFPS(fps)
-    , fFlags(flags) {}
+    , fFlags(flags)
+    , fAnimatorExecutor(animatorExecutor) {}
 
 Animation::~Animation() = default;
 
@@ -484,6 +595,16 @@ void Animation::render(SkCanvas* canvas, const SkRect* dstR) const {
 }
 
 void Animation::render(SkCanvas* canvas, const SkRect* dstR, RenderFlags renderFlags) const {
+    this->renderFrame(canvas, dstR, renderFlags, nullptr);
+}
+
+void Animation::renderDamage(SkCanvas* canvas, const SkRect& damage, const SkRect* dstR,
+                             RenderFlags renderFlags) const {
+    this->renderFrame(canvas, dstR, renderFlags, &damage);
+}
+
+void Animation::renderFrame(SkCanvas* canvas, const SkRect* dstR, RenderFlags renderFlags,
+                            const SkRect* damage) const {
     TRACE_EVENT0("skottie", TRACE_FUNC);
 
     if (!fSceneRoot)
@@ -500,6 +621,21 @@ void Animation::render(SkCanvas* canvas, const SkRect* dstR, RenderFlags renderF
         canvas->clipRect(srcR);
     }
 
+    if (damage) {
+        // Clip to whole device pixels, so the redrawn area replaces the old one exactly,
+        // without antialiased seams.
+        const SkM44 ctm = canvas->getLocalToDevice();
+        const SkIRect device_damage = ctm.asM33().mapRect(*damage).roundOut();
+        canvas->resetMatrix();
+        canvas->clipIRect(device_damage);
+        canvas->setMatrix(ctm);
+
+        if (canvas->isClipEmpty()) {
+            return;
+        }
+        canvas->drawColor(SK_ColorTRANSPARENT, SkBlendMode::kSrc);
+    }
+
     if ((fFlags & Flags::kRequiresTopLevelIsolation) &&
         !(renderFlags & RenderFlag::kSkipTopLevelIsolation)) {
         // The animation uses non-trivial blending, and needs
@@ -507,7 +643,11 @@ void Animation::render(SkCanvas* canvas, const SkRect* dstR, RenderFlags renderF
         canvas->saveLayer(srcR, nullptr);
     }
 
-    fSceneRoot->render(canvas);
+    if (damage) {
+        fSceneRoot->renderClipped(canvas);
+    } else {
+        fSceneRoot->render(canvas);
+    }
 }
 
 void Animation::seekFrame(double t, sksg::InvalidationController* ic) {
@@ -520,8 +660,24 @@ void Animation::seekFrame(double t, sksg::InvalidationController* ic) {
     const auto kLastValidFrame = std::nextafterf(fOutPoint, fInPoint),
                      comp_time = SkTPin<float>(fInPoint + t, fInPoint, kLastValidFrame);
 
-    for (const auto& anim : fAnimators) {
-        anim->seek(comp_time);
+    if (fAnimatorExecutor && fAnimators.size() > 1) {
+        // Top-level animators drive separate layers and precomps, each updating its own scene
+        // graph nodes.  They run concurrently, and the invalidations they collect are propagated
+        // here once they are all done.
+        std::vector<sksg::InvalidationList> invalidations(fAnimators.size());
+        SkTaskGroup tasks(*fAnimatorExecutor);
+        tasks.batch(SkToInt(fAnimators.size()), [&](int i) {
+            sksg::AutoDeferInvalidation defer(&invalidations[i]);
+            fAnimators[i]->seek(comp_time);
+        });
+        tasks.wait();
+        for (auto& list : invalidations) {
+            list.apply();
+        }
+    } else {
+        for (const auto& anim : fAnimators) {
+            anim->seek(comp_time);
+        }
     }
 
     fSceneRoot->revalidate(ic, SkMatrix::I());
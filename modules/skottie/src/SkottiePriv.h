@@ -20,6 +20,9 @@
 #include "modules/skottie/include/SlotManager.h"
 #include "modules/skottie/src/animator/Animator.h"
 #include "modules/skottie/src/text/Font.h"
+#include "include/private/base/SkMutex.h"
+#include "include/private/base/SkThreadAnnotations.h"
+#include "modules/sksg/include/SkSGCacheEffect.h"
 #include "src/base/SkUTF.h"
 #include "src/core/SkTHash.h"
 
@@ -46,6 +49,7 @@ namespace internal {
 // Close-enough to AE.
 static constexpr float kBlurSizeToSigma = 0.3f;
 
+class KeyframeData;
 class TextAdapter;
 class TransformAdapter2D;
 class TransformAdapter3D;
@@ -63,13 +67,47 @@ private:
     sk_sp<sksg::RenderNode> fRoot;
 };
 
+// Keyframe data and images loaded by the animations built from an AnimationTemplate, which later
+// builds from the same template reuse.  Keyframes are keyed by their JSON array, which the
+// template keeps alive.  Animations may be built from a template on several threads at once.
+class TemplateCache final : public SkNVRefCnt<TemplateCache> {
+public:
+    TemplateCache();
+    ~TemplateCache();
+
+    sk_sp<const KeyframeData> findKeyframes(const skjson::ArrayValue&, const void* kind) const;
+
+    // Returns the data added first, when several builds parse the same keyframes concurrently.
+    sk_sp<const KeyframeData> addKeyframes(const skjson::ArrayValue&, const void* kind,
+                                           sk_sp<const KeyframeData>);
+
+    sk_sp<ImageAsset> findImage(const SkString& id) const;
+    void addImage(const SkString& id, sk_sp<ImageAsset>);
+
+private:
+    struct KeyframesKey {
+        const void* fJSON;
+        const void* fKind;
+
+        bool operator==(const KeyframesKey& other) const {
+            return fJSON == other.fJSON && fKind == other.fKind;
+        }
+    };
+
+    mutable SkMutex fMutex;
+    skia_private::THashMap<KeyframesKey, sk_sp<const KeyframeData>> fKeyframes
+            SK_GUARDED_BY(fMutex);
+    skia_private::THashMap<SkString, sk_sp<ImageAsset>> fImages SK_GUARDED_BY(fMutex);
+};
+
 class AnimationBuilder final : public SkNoncopyable {
 public:
     AnimationBuilder(sk_sp<ResourceProvider>, sk_sp<SkFontMgr>, sk_sp<PropertyObserver>,
                      sk_sp<Logger>, sk_sp<MarkerObserver>, sk_sp<PrecompInterceptor>,
                      sk_sp<ExpressionManager>, sk_sp<SkShapers::Factory>,
                      Animation::Builder::Stats*, const SkSize& comp_size,
-                     float duration, float framerate, uint32_t flags);
+                     float duration, float framerate, uint32_t flags,
+                     size_t layer_cache_budget, sk_sp<TemplateCache>);
 
     struct AnimationInfo {
         sk_sp<sksg::RenderNode> fSceneRoot;
@@ -194,6 +232,9 @@ public:
 
     sk_sp<ExpressionManager> expression_manager() const;
 
+    // Null unless building from an AnimationTemplate.
+    TemplateCache* template_cache() const { return fTemplateCache.get(); }
+
     const skjson::ObjectValue* getSlotsRoot() const {
         return fSlotsRoot;
     }
@@ -248,6 +289,8 @@ private:
     sk_sp<SkShapers::Factory>    fShapingFactory;
     sk_sp<SceneGraphRevalidator> fRevalidator;
     sk_sp<SlotManager>           fSlotManager;
+    sk_sp<sksg::CacheEffect::Budget> fLayerCacheBudget;  // null when layer caching is off
+    sk_sp<TemplateCache>         fTemplateCache;
     Animation::Builder::Stats*   fStats;
     const SkSize                 fCompSize;
     const float                  fDuration,
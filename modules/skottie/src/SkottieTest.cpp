@@ -5,12 +5,22 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColorSpace.h"
+#include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkPictureRecorder.h"
+#include "include/core/SkRect.h"
 #include "include/core/SkStream.h"
 #include "include/core/SkSurface.h"
 #include "modules/skottie/include/Skottie.h"
+#include "modules/sksg/include/SkSGInvalidationController.h"
 #include "tests/Test.h"
 
 #include <cmath>
+#include <functional>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -244,6 +254,132 @@ DEF_TEST(Skottie_Image_Loading, reporter) {
     }
 }
 
+DEF_TEST(Skottie_PrefetchingResourceProvider, reporter) {
+    // Runs tasks when told to, so the test controls when prefetching happens.
+    class ManualExecutor final : public SkExecutor {
+    public:
+        void add(std::function<void(void)> work) override { fWork.push_back(std::move(work)); }
+
+        size_t pending() const { return fWork.size(); }
+
+        void runAll() {
+            while (!fWork.empty()) {
+                auto work = std::move(fWork.front());
+                fWork.erase(fWork.begin());
+                work();
+            }
+        }
+
+    private:
+        std::vector<std::function<void(void)>> fWork;
+    };
+
+    class TestAsset final : public skresources::ImageAsset {
+    public:
+        explicit TestAsset(bool multi_frame) : fMultiFrame(multi_frame) {}
+
+        const std::vector<float>& requestedFrames() const { return fRequestedFrames; }
+
+    private:
+        bool isMultiFrame() override { return fMultiFrame; }
+
+        FrameData getFrameData(float t) override {
+            fRequestedFrames.push_back(t);
+
+            // A lazy 10x10 image, which the provider has to decode.
+            SkPictureRecorder recorder;
+            recorder.beginRecording(10, 10)->clear(SK_ColorRED);
+            return {SkImages::DeferredFromPicture(recorder.finishRecordingAsPicture(),
+                                                  {10, 10}, nullptr, nullptr,
+                                                  SkImages::BitDepth::kU8,
+                                                  SkColorSpace::MakeSRGB()),
+                    SkSamplingOptions(), SkMatrix::I(), SizeFit::kCenter};
+        }
+
+        const bool         fMultiFrame;
+        std::vector<float> fRequestedFrames;
+    };
+
+    class TestResourceProvider final : public skresources::ResourceProvider {
+    public:
+        TestResourceProvider(sk_sp<TestAsset> single_asset, sk_sp<TestAsset> multi_asset)
+            : fSingleFrameAsset(std::move(single_asset))
+            , fMultiFrameAsset (std::move( multi_asset)) {}
+
+    private:
+        sk_sp<ImageAsset> loadImageAsset(const char[], const char[], const char id[]) const override {
+            return strcmp(id, "single_frame") ? fMultiFrameAsset : fSingleFrameAsset;
+        }
+
+        const sk_sp<TestAsset> fSingleFrameAsset,
+                               fMultiFrameAsset;
+    };
+
+    static constexpr size_t kImageBytes = 10 * 10 * 4;
+
+    ManualExecutor executor;
+    auto single_asset = sk_make_sp<TestAsset>(false),
+          multi_asset = sk_make_sp<TestAsset>(true);
+    skresources::PrefetchingResourceProvider::Options options;
+    options.fExecutor = &executor;
+    options.fDecodedBudget = 3 * kImageBytes;
+    options.fLookaheadFrames = 2;
+    auto provider = skresources::PrefetchingResourceProvider::Make(
+            sk_make_sp<TestResourceProvider>(single_asset, multi_asset), options);
+    const skresources::ResourceProvider* rp = provider.get();
+
+    // Static images are loaded and decoded by the prefetch task.
+    provider->prefetchImageAsset("images/", "single_frame.png", "single_frame");
+    provider->prefetchImageAsset("images/", "single_frame.png", "single_frame");
+    REPORTER_ASSERT(reporter, executor.pending() == 1);
+    REPORTER_ASSERT(reporter, single_asset->requestedFrames().empty());
+    executor.runAll();
+    REPORTER_ASSERT(reporter, single_asset->requestedFrames().size() == 1);
+    REPORTER_ASSERT(reporter, provider->decodedBytes() == kImageBytes);
+
+    auto single = rp->loadImageAsset("images/", "single_frame.png", "single_frame");
+    REPORTER_ASSERT(reporter, single && !single->isMultiFrame());
+    auto frame = single->getFrameData(0);
+    REPORTER_ASSERT(reporter, frame.image && !frame.image->isLazyGenerated());
+    REPORTER_ASSERT(reporter, single_asset->requestedFrames().size() == 1);
+
+    // Multi-frame images decode the next frames once the frame step is known.
+    auto multi = rp->loadImageAsset("images/", "multi_frame.png", "multi_frame");
+    REPORTER_ASSERT(reporter, multi && multi->isMultiFrame());
+    multi->getFrameData(0);
+    REPORTER_ASSERT(reporter, executor.pending() == 0);
+    multi->getFrameData(0.1f);
+    REPORTER_ASSERT(reporter, executor.pending() == 1);
+    executor.runAll();
+    REPORTER_ASSERT(reporter, multi_asset->requestedFrames().size() == 4);
+    REPORTER_ASSERT(reporter, SkScalarNearlyEqual(multi_asset->requestedFrames()[2], 0.2f));
+    REPORTER_ASSERT(reporter, SkScalarNearlyEqual(multi_asset->requestedFrames()[3], 0.3f));
+    REPORTER_ASSERT(reporter, provider->decodedBytes() == 3 * kImageBytes);
+
+    // Decoded frames are served without asking the wrapped asset, and dropped once played.
+    frame = multi->getFrameData(0.2f);
+    REPORTER_ASSERT(reporter, frame.image && !frame.image->isLazyGenerated());
+    REPORTER_ASSERT(reporter, multi_asset->requestedFrames().size() == 4);
+
+    // Looking ahead from 0.2s also wants 0.4s, which doesn't fit in the budget yet.
+    executor.runAll();
+    REPORTER_ASSERT(reporter, multi_asset->requestedFrames().size() == 5);
+    REPORTER_ASSERT(reporter, provider->decodedBytes() == 3 * kImageBytes);
+
+    // Playing 0.3s drops 0.2s, which makes room for 0.4s.
+    multi->getFrameData(0.3f);
+    REPORTER_ASSERT(reporter, provider->decodedBytes() == 2 * kImageBytes);
+    executor.runAll();
+    REPORTER_ASSERT(reporter, provider->decodedBytes() == 3 * kImageBytes);
+
+    // The provider keeps its assets, and their decoded pixels, until it is destroyed.
+    single.reset();
+    multi.reset();
+    REPORTER_ASSERT(reporter, provider->decodedBytes() == 3 * kImageBytes);
+    provider.reset();
+    REPORTER_ASSERT(reporter, executor.pending() == 0);
+}
+
 DEF_TEST(Skottie_Layer_NoType, r) {
     static constexpr char json[] =
         R"({
@@ -269,3 +405,325 @@ DEF_TEST(Skottie_Layer_NoType, r) {
     // passes if we don't crash
     REPORTER_ASSERT(r, anim);
 }
+
+DEF_TEST(Skottie_AnimatorExecutor, r) {
+    static constexpr char json[] =
+        R"({
+             "v": "5.2.1",
+             "w": 100,
+             "h": 100,
+             "fr": 10,
+             "ip": 0,
+             "op": 100,
+             "layers": [
+               {
+                 "ty": 1, "ind": 0, "ip": 0, "op": 100, "sw": 40, "sh": 40, "sc": "#ff0000",
+                 "ks": {
+                   "p": { "a": 1, "k": [ { "t": 0, "s": [ 0, 0 ] }, { "t": 100, "s": [ 60, 60 ] } ] }
+                 }
+               },
+               {
+                 "ty": 1, "ind": 1, "ip": 0, "op": 100, "sw": 40, "sh": 40, "sc": "#00ff00",
+                 "ks": {
+                   "p": { "a": 1, "k": [ { "t": 0, "s": [ 60, 0 ] }, { "t": 100, "s": [ 0, 60 ] } ] },
+                   "o": { "a": 1, "k": [ { "t": 0, "s": [ 100 ] }, { "t": 100, "s": [ 20 ] } ] }
+                 }
+               },
+               {
+                 "ty": 1, "ind": 2, "ip": 20, "op": 80, "sw": 100, "sh": 100, "sc": "#0000ff",
+                 "ks": {
+                   "r": { "a": 1, "k": [ { "t": 0, "s": [ 0 ] }, { "t": 100, "s": [ 90 ] } ] },
+                   "o": { "a": 0, "k": 50 }
+                 }
+               }
+             ]
+           })";
+
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+
+    SkMemoryStream serialStream(json, strlen(json)),
+                   concurrentStream(json, strlen(json));
+    auto serial     = Animation::Builder().make(&serialStream);
+    auto concurrent = Animation::Builder().setAnimatorExecutor(executor.get())
+                                          .make(&concurrentStream);
+    REPORTER_ASSERT(r, serial && concurrent);
+    if (!serial || !concurrent) {
+        return;
+    }
+
+    const SkImageInfo info = SkImageInfo::MakeN32Premul(100, 100);
+    auto render = [&](Animation* animation, float frame) {
+        auto surface = SkSurfaces::Raster(info);
+        animation->seekFrame(frame);
+        animation->render(surface->getCanvas());
+        return surface->makeImageSnapshot();
+    };
+
+    for (float frame : {0.f, 10.f, 25.f, 50.f, 50.f, 79.5f, 99.f, 5.f}) {
+        SkBitmap expected, actual;
+        REPORTER_ASSERT(r, render(serial.get(), frame)->asLegacyBitmap(&expected));
+        REPORTER_ASSERT(r, render(concurrent.get(), frame)->asLegacyBitmap(&actual));
+        REPORTER_ASSERT(r, 0 == memcmp(expected.getPixels(), actual.getPixels(),
+                                       expected.computeByteSize()),
+                        "frame %g", frame);
+    }
+}
+
+DEF_TEST(Skottie_LayerCache, r) {
+    static constexpr char json[] =
+        R"({
+             "v": "5.2.1",
+             "w": 100,
+             "h": 100,
+             "fr": 10,
+             "ip": 0,
+             "op": 100,
+             "layers": [
+               {
+                 "ty": 1, "ind": 0, "ip": 0, "op": 100, "sw": 20, "sh": 20, "sc": "#00ff00",
+                 "ks": {
+                   "p": { "a": 1, "k": [ { "t": 0, "s": [ 0, 0 ] }, { "t": 100, "s": [ 80, 80 ] } ] }
+                 }
+               },
+               {
+                 "ty": 4, "ind": 1, "ip": 0, "op": 100,
+                 "ks": {
+                   "p": { "a": 1, "k": [ { "t": 0, "s": [ 0, 0 ] }, { "t": 40, "s": [ 10, 10 ] } ] }
+                 },
+                 "shapes": [
+                   { "ty": "el", "p": { "a": 0, "k": [ 40, 40 ] }, "s": { "a": 0, "k": [ 50, 30 ] } },
+                   { "ty": "fl", "c": { "a": 0, "k": [ 1, 0, 0, 1 ] }, "o": { "a": 0, "k": 100 } }
+                 ]
+               }
+             ]
+           })";
+
+    SkMemoryStream uncachedStream(json, strlen(json)),
+                   cachedStream(json, strlen(json));
+    auto uncached = Animation::Builder().make(&uncachedStream);
+    auto cached   = Animation::Builder().setLayerCacheBudget(1024 * 1024).make(&cachedStream);
+    REPORTER_ASSERT(r, uncached && cached);
+    if (!uncached || !cached) {
+        return;
+    }
+
+    const SkImageInfo info = SkImageInfo::MakeN32Premul(100, 100);
+    auto render = [&](Animation* animation, float frame) {
+        auto surface = SkSurfaces::Raster(info);
+        animation->seekFrame(frame);
+        animation->render(surface->getCanvas());
+        return surface->makeImageSnapshot();
+    };
+
+    // The shape moves by fractions of a pixel until frame 40, and is static afterwards.
+    for (float frame : {0.f, 1.f, 2.f, 3.f, 20.f, 40.f, 45.f, 50.f, 55.f, 60.f, 30.f, 99.f}) {
+        SkBitmap expected, actual;
+        REPORTER_ASSERT(r, render(uncached.get(), frame)->asLegacyBitmap(&expected));
+        REPORTER_ASSERT(r, render(cached.get(), frame)->asLegacyBitmap(&actual));
+        REPORTER_ASSERT(r, 0 == memcmp(expected.getPixels(), actual.getPixels(),
+                                       expected.computeByteSize()),
+                        "frame %g", frame);
+    }
+}
+
+DEF_TEST(Skottie_BinaryFormat, r) {
+    static constexpr char json[] =
+        R"({
+             "v": "5.2.1",
+             "w": 100,
+             "h": 100,
+             "fr": 10,
+             "ip": 0,
+             "op": 100,
+             "layers": [
+               {
+                 "ty": 4, "ind": 0, "ip": 0, "op": 100, "nm": "shape",
+                 "ks": {
+                   "p": { "a": 1, "k": [ { "t": 0, "s": [ 0, 0 ] }, { "t": 100, "s": [ 50, 50 ] } ] }
+                 },
+                 "shapes": [
+                   { "ty": "el", "p": { "a": 0, "k": [ 40, 40 ] }, "s": { "a": 0, "k": [ 50, 30 ] } },
+                   { "ty": "fl", "c": { "a": 0, "k": [ 1, 0, 0, 1 ] }, "o": { "a": 0, "k": 100 } }
+                 ]
+               }
+             ]
+           })";
+
+    auto binary = Animation::Builder::ConvertToBinary(json, strlen(json));
+    REPORTER_ASSERT(r, binary);
+    if (!binary) {
+        return;
+    }
+    REPORTER_ASSERT(r, !Animation::Builder::ConvertToBinary("[ 1, 2 ]", 8));
+    REPORTER_ASSERT(r, !Animation::Builder::ConvertToBinary("{ \"v\": ", 7));
+
+    auto fromJSON   = Animation::Builder().make(json, strlen(json));
+    auto fromBinary = Animation::Builder().make(static_cast<const char*>(binary->data()),
+                                                binary->size());
+    REPORTER_ASSERT(r, fromJSON && fromBinary);
+    if (!fromJSON || !fromBinary) {
+        return;
+    }
+    REPORTER_ASSERT(r, fromBinary->duration() == fromJSON->duration());
+    REPORTER_ASSERT(r, fromBinary->fps()      == fromJSON->fps());
+    REPORTER_ASSERT(r, fromBinary->size()     == fromJSON->size());
+    REPORTER_ASSERT(r, fromBinary->version()  == fromJSON->version());
+
+    const SkImageInfo info = SkImageInfo::MakeN32Premul(100, 100);
+    auto render = [&](Animation* animation, float frame) {
+        auto surface = SkSurfaces::Raster(info);
+        animation->seekFrame(frame);
+        animation->render(surface->getCanvas());
+        return surface->makeImageSnapshot();
+    };
+
+    for (float frame : {0.f, 25.f, 50.f, 99.f}) {
+        SkBitmap expected, actual;
+        REPORTER_ASSERT(r, render(fromJSON.get(), frame)->asLegacyBitmap(&expected));
+        REPORTER_ASSERT(r, render(fromBinary.get(), frame)->asLegacyBitmap(&actual));
+        REPORTER_ASSERT(r, 0 == memcmp(expected.getPixels(), actual.getPixels(),
+                                       expected.computeByteSize()),
+                        "frame %g", frame);
+    }
+
+    // Truncated binary data is rejected.
+    REPORTER_ASSERT(r, !Animation::Builder().make(static_cast<const char*>(binary->data()),
+                                                  binary->size() - 8));
+}
+
+DEF_TEST(Skottie_Template, r) {
+    static constexpr char json[] =
+        R"({
+             "v": "5.2.1",
+             "w": 100,
+             "h": 100,
+             "fr": 10,
+             "ip": 0,
+             "op": 100,
+             "layers": [
+               {
+                 "ty": 4, "ind": 0, "ip": 0, "op": 100,
+                 "ks": {
+                   "p": { "a": 1, "k": [ { "t": 0, "s": [ 0, 0 ] }, { "t": 100, "s": [ 50, 50 ] } ] },
+                   "o": { "a": 1, "k": [ { "t": 0, "s": [ 100 ] }, { "t": 100, "s": [ 20 ] } ] }
+                 },
+                 "shapes": [
+                   { "ty": "el", "p": { "a": 0, "k": [ 40, 40 ] }, "s": { "a": 0, "k": [ 50, 30 ] } },
+                   { "ty": "fl", "o": { "a": 0, "k": 100 },
+                     "c": { "a": 1, "k": [ { "t": 0, "s": [ 1, 0, 0, 1 ] },
+                                           { "t": 100, "s": [ 0, 0, 1, 1 ] } ] } }
+                 ]
+               }
+             ]
+           })";
+
+    REPORTER_ASSERT(r, !Animation::Builder().makeTemplate("[ 1, 2 ]", 8));
+
+    auto animation_template = Animation::Builder().makeTemplate(json, strlen(json));
+    REPORTER_ASSERT(r, animation_template);
+    if (!animation_template) {
+        return;
+    }
+
+    auto reference = Animation::Builder().make(json, strlen(json));
+    std::vector<sk_sp<Animation>> instances;
+    for (int i = 0; i < 3; ++i) {
+        Animation::Builder builder;
+        instances.push_back(builder.make(*animation_template));
+        REPORTER_ASSERT(r, instances.back());
+        REPORTER_ASSERT(r, builder.getStats().fJsonSize == strlen(json));
+    }
+    REPORTER_ASSERT(r, reference);
+    if (!reference || !instances[0] || !instances[1] || !instances[2]) {
+        return;
+    }
+
+    const SkImageInfo info = SkImageInfo::MakeN32Premul(100, 100);
+    auto render = [&](Animation* animation) {
+        auto surface = SkSurfaces::Raster(info);
+        animation->render(surface->getCanvas());
+        SkBitmap bm;
+        SkAssertResult(surface->makeImageSnapshot()->asLegacyBitmap(&bm));
+        return bm;
+    };
+
+    // Instances share keyframes, but play independently.
+    const float frames[] = { 10, 50, 90 };
+    for (size_t i = 0; i < std::size(frames); ++i) {
+        instances[i]->seekFrame(frames[i]);
+    }
+    for (size_t i = 0; i < std::size(frames); ++i) {
+        reference->seekFrame(frames[i]);
+        const SkBitmap expected = render(reference.get()),
+                       actual   = render(instances[i].get());
+        REPORTER_ASSERT(r, 0 == memcmp(expected.getPixels(), actual.getPixels(),
+                                       expected.computeByteSize()),
+                        "frame %g", frames[i]);
+    }
+}
+
+DEF_TEST(Skottie_DamageRender, r) {
+    static constexpr char json[] =
+        R"({
+             "v": "5.2.1",
+             "w": 100,
+             "h": 100,
+             "fr": 10,
+             "ip": 0,
+             "op": 100,
+             "layers": [
+               {
+                 "ty": 4, "ind": 0, "ip": 0, "op": 100,
+                 "ks": {
+                   "p": { "a": 1, "k": [ { "t": 0, "s": [ 0, 0 ] }, { "t": 100, "s": [ 40, 10 ] } ] }
+                 },
+                 "shapes": [
+                   { "ty": "el", "p": { "a": 0, "k": [ 20, 20 ] }, "s": { "a": 0, "k": [ 15, 10 ] } },
+                   { "ty": "fl", "o": { "a": 0, "k": 100 }, "c": { "a": 0, "k": [ 1, 0, 0, 1 ] } }
+                 ]
+               },
+               {
+                 "ty": 4, "ind": 1, "ip": 0, "op": 100,
+                 "shapes": [
+                   { "ty": "rc", "p": { "a": 0, "k": [ 50, 70 ] }, "s": { "a": 0, "k": [ 80, 40 ] } },
+                   { "ty": "fl", "o": { "a": 0, "k": 60 }, "c": { "a": 0, "k": [ 0, 0, 1, 1 ] } }
+                 ]
+               }
+             ]
+           })";
+
+    auto animation = Animation::Make(json, strlen(json));
+    REPORTER_ASSERT(r, animation);
+    if (!animation) {
+        return;
+    }
+
+    const SkRect dst = SkRect::MakeXYWH(3.5f, 5.25f, 150, 150);
+    const SkImageInfo info = SkImageInfo::MakeN32Premul(160, 160);
+    auto snap = [](SkSurface* surface) {
+        SkBitmap bm;
+        SkAssertResult(surface->makeImageSnapshot()->asLegacyBitmap(&bm));
+        return bm;
+    };
+
+    auto damaged = SkSurfaces::Raster(info);
+    animation->seekFrame(0);
+    animation->render(damaged->getCanvas(), &dst);
+
+    for (float frame : { 10.f, 50.f, 90.f }) {
+        sksg::InvalidationController ic;
+        animation->seekFrame(frame, &ic);
+        REPORTER_ASSERT(r, !ic.bounds().isEmpty());
+        REPORTER_ASSERT(r, !ic.bounds().contains(SkRect::MakeSize(animation->size())));
+        animation->renderDamage(damaged->getCanvas(), ic.bounds(), &dst);
+
+        auto full = SkSurfaces::Raster(info);
+        animation->render(full->getCanvas(), &dst);
+
+        const SkBitmap expected = snap(full.get()),
+                       actual   = snap(damaged.get());
+        REPORTER_ASSERT(r, 0 == memcmp(expected.getPixels(), actual.getPixels(),
+                                       expected.computeByteSize()),
+                        "frame %g", frame);
+    }
+}
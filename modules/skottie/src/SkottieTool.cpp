@@ -97,6 +97,10 @@ static DEFINE_int(threads,  0, "Number of worker threads (0 -> cores count).");
 
 static DEFINE_bool2(gpu, g, false, "Enable GPU rasterization.");
 
+static DEFINE_string(writeBinary, nullptr,
+                     "Convert the input to the pre-parsed binary form, write it to this file "
+                     "and exit.");
+
 namespace {
 
 static constexpr SkColor kClearColor = SK_ColorWHITE;
@@ -474,6 +478,19 @@ int main(int argc, char** argv) {
     CommandLineFlags::Parse(argc, argv);
     SkGraphics::Init();
 
+    if (!FLAGS_input.isEmpty() && !FLAGS_writeBinary.isEmpty()) {
+        auto json = SkData::MakeFromFileName(FLAGS_input[0]);
+        auto binary = json ? skottie::Animation::Builder::ConvertToBinary(
+                                     static_cast<const char*>(json->data()), json->size())
+                           : nullptr;
+        SkFILEWStream out(FLAGS_writeBinary[0]);
+        if (!binary || !out.isValid() || !out.write(binary->data(), binary->size())) {
+            SkDebugf("Could not convert %s.\n", FLAGS_input[0]);
+            return 1;
+        }
+        return 0;
+    }
+
     if (FLAGS_input.isEmpty() || FLAGS_writePath.isEmpty()) {
         SkDebugf("Missing required 'input' and 'writePath' args.\n");
         return 1;
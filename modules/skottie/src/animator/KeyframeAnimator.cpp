@@ -9,9 +9,11 @@
 
 #include "include/private/base/SkTo.h"
 #include "modules/skottie/src/SkottieJson.h"
+#include "modules/skottie/src/SkottiePriv.h"
 #include "src/utils/SkJSON.h"
 
 #include <cstddef>
+#include <utility>
 
 #define DUMP_KF_RECORDS 0
 
@@ -91,6 +93,30 @@ float KeyframeAnimator::compute_weight(const KFSegment &seg, float t) const {
 
 AnimatorBuilder::~AnimatorBuilder() = default;
 
+sk_sp<KeyframeAnimator> AnimatorBuilder::makeFromKeyframes(const AnimationBuilder& abuilder,
+                                                           const skjson::ArrayValue& jkfs) {
+    SkASSERT(jkfs.size() > 0);
+
+    const void* kind = this->keyframeDataKind();
+    TemplateCache* cache = kind ? abuilder.template_cache() : nullptr;
+
+    sk_sp<const KeyframeData> data;
+    if (cache) {
+        data = cache->findKeyframes(jkfs, kind);
+    }
+    if (!data) {
+        data = this->parseKeyframeData(abuilder, jkfs);
+        if (!data) {
+            return nullptr;
+        }
+        if (cache) {
+            data = cache->addKeyframes(jkfs, kind, std::move(data));
+        }
+    }
+
+    return this->makeKeyframeAnimator(std::move(data));
+}
+
 bool AnimatorBuilder::parseKeyframes(const AnimationBuilder& abuilder,
                                      const skjson::ArrayValue& jkfs) {
     // Keyframe format:
@@ -152,7 +178,7 @@ bool AnimatorBuilder::parseKeyframes(const AnimationBuilder& abuilder,
         }
 
         float t;
-        if (!Parse<float>((*jkf)["t"], &t)) {
+        if (!::skottie::Parse<float>((*jkf)["t"], &t)) {
             return false;
         }
 
@@ -205,8 +231,8 @@ uint32_t AnimatorBuilder::parseMapping(const skjson::ObjectValue& jkf) {
     }
 
     SkPoint c0, c1;
-    if (!Parse(jkf["o"], &c0) ||
-        !Parse(jkf["i"], &c1) ||
+    if (!::skottie::Parse(jkf["o"], &c0) ||
+        !::skottie::Parse(jkf["i"], &c1) ||
         SkCubicMap::IsLinear(c0, c1)) {
         return Keyframe::kLinearMapping;
     }
@@ -66,6 +66,15 @@ struct Keyframe {
     inline static constexpr uint32_t kCubicIndexOffset = 2;
 };
 
+// Keyframe records and cubic mappers parsed from a JSON keyframe array, along with any values
+// stored outside the records (in subclasses).  They are immutable once parsed, which lets the
+// animations built from an AnimationTemplate share them.
+class KeyframeData : public SkRefCnt {
+public:
+    std::vector<Keyframe>   fKFs; // Keyframe records, one per AE/Lottie keyframe.
+    std::vector<SkCubicMap> fCMs; // Optional cubic mappers (Bezier interpolation).
+};
+
 class KeyframeAnimator : public Animator {
 public:
     ~KeyframeAnimator() override;
@@ -78,9 +87,10 @@ public:
     }
 
 protected:
-    KeyframeAnimator(std::vector<Keyframe> kfs, std::vector<SkCubicMap> cms)
-        : fKFs(std::move(kfs))
-        , fCMs(std::move(cms)) {}
+    explicit KeyframeAnimator(sk_sp<const KeyframeData> data)
+        : fData(std::move(data))
+        , fKFs(fData->fKFs)
+        , fCMs(fData->fCMs) {}
 
     struct LERPInfo {
         float           weight; // vrec0/vrec1 weight [0..1]
@@ -110,17 +120,19 @@ private:
     // Given a |t| and a containing KFSegment, compute the local interpolation weight.
     float compute_weight(const KFSegment& seg, float t) const;
 
-    const std::vector<Keyframe>   fKFs; // Keyframe records, one per AE/Lottie keyframe.
-    const std::vector<SkCubicMap> fCMs; // Optional cubic mappers (Bezier interpolation).
-    mutable KFSegment             fCurrentSegment = { nullptr, nullptr }; // Cached segment.
+    const sk_sp<const KeyframeData> fData;
+    const std::vector<Keyframe>&    fKFs;
+    const std::vector<SkCubicMap>&  fCMs;
+    mutable KFSegment               fCurrentSegment = { nullptr, nullptr }; // Cached segment.
 };
 
 class AnimatorBuilder : public SkNoncopyable {
 public:
     virtual ~AnimatorBuilder();
 
-    virtual sk_sp<KeyframeAnimator> makeFromKeyframes(const AnimationBuilder&,
-                                                      const skjson::ArrayValue&) = 0;
+    // Reuses the keyframe data parsed from |jkfs| by earlier builds of the same AnimationTemplate,
+    // when possible.
+    sk_sp<KeyframeAnimator> makeFromKeyframes(const AnimationBuilder&, const skjson::ArrayValue&);
 
     virtual sk_sp<Animator> makeFromExpression(ExpressionManager&, const char*) = 0;
 
@@ -130,6 +142,16 @@ protected:
     explicit AnimatorBuilder(Keyframe::Value::Type ty)
         : keyframe_type(ty) {}
 
+    virtual sk_sp<KeyframeData> parseKeyframeData(const AnimationBuilder&,
+                                                  const skjson::ArrayValue&) = 0;
+
+    // Binds keyframe data from parseKeyframeData() (possibly another builder's) to our target.
+    virtual sk_sp<KeyframeAnimator> makeKeyframeAnimator(sk_sp<const KeyframeData>) = 0;
+
+    // Builders which parse the same JSON into the same keyframe data return the same kind, and
+    // can share it.  Null when the data depends on more than the JSON (e.g. fonts).
+    virtual const void* keyframeDataKind() const = 0;
+
     virtual bool parseKFValue(const AnimationBuilder&,
                               const skjson::ObjectValue&,
                               const skjson::Value&,
@@ -137,6 +159,14 @@ protected:
 
     bool parseKeyframes(const AnimationBuilder&, const skjson::ArrayValue&);
 
+    // Moves the parsed keyframe records and cubic mappers to |data|.
+    template <typename T>
+    sk_sp<T> releaseKeyframes(sk_sp<T> data) {
+        data->fKFs = std::move(fKFs);
+        data->fCMs = std::move(fCMs);
+        return data;
+    }
+
     std::vector<Keyframe>   fKFs; // Keyframe records, one per AE/Lottie keyframe.
     std::vector<SkCubicMap> fCMs; // Optional cubic mappers (Bezier interpolation).
 
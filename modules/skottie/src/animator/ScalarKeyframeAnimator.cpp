@@ -28,10 +28,8 @@ namespace  {
     // Scalar specialization: stores scalar values (floats) inline in keyframes.
 class ScalarKeyframeAnimator final : public KeyframeAnimator {
 public:
-    ScalarKeyframeAnimator(std::vector<Keyframe> kfs,
-                           std::vector<SkCubicMap> cms,
-                           ScalarValue* target_value)
-        : INHERITED(std::move(kfs), std::move(cms))
+    ScalarKeyframeAnimator(sk_sp<const KeyframeData> data, ScalarValue* target_value)
+        : INHERITED(std::move(data))
         , fTarget(target_value) {}
 
 private:
@@ -78,17 +76,6 @@ class ScalarAnimatorBuilder final : public AnimatorBuilder {
             : INHERITED(Keyframe::Value::Type::kScalar)
             , fTarget(target) {}
 
-        sk_sp<KeyframeAnimator> makeFromKeyframes(const AnimationBuilder& abuilder,
-                                     const skjson::ArrayValue& jkfs) override {
-            SkASSERT(jkfs.size() > 0);
-            if (!this->parseKeyframes(abuilder, jkfs)) {
-                return nullptr;
-            }
-
-            return sk_sp<ScalarKeyframeAnimator>(
-                        new ScalarKeyframeAnimator(std::move(fKFs), std::move(fCMs), fTarget));
-        }
-
         sk_sp<Animator> makeFromExpression(ExpressionManager& em, const char* expr) override {
             sk_sp<ExpressionEvaluator<ScalarValue>> expression_evaluator =
                 em.createNumberExpressionEvaluator(expr);
@@ -101,6 +88,24 @@ class ScalarAnimatorBuilder final : public AnimatorBuilder {
         }
 
     private:
+        sk_sp<KeyframeData> parseKeyframeData(const AnimationBuilder& abuilder,
+                                              const skjson::ArrayValue& jkfs) override {
+            if (!this->parseKeyframes(abuilder, jkfs)) {
+                return nullptr;
+            }
+
+            return this->releaseKeyframes(sk_make_sp<KeyframeData>());
+        }
+
+        sk_sp<KeyframeAnimator> makeKeyframeAnimator(sk_sp<const KeyframeData> data) override {
+            return sk_make_sp<ScalarKeyframeAnimator>(std::move(data), fTarget);
+        }
+
+        const void* keyframeDataKind() const override {
+            static constexpr char kKind = 0;
+            return &kKind;
+        }
+
         bool parseKFValue(const AnimationBuilder&,
                           const skjson::ObjectValue&,
                           const skjson::Value& jv,
@@ -26,10 +26,15 @@ class AnimationBuilder;
 namespace  {
 class TextKeyframeAnimator final : public KeyframeAnimator {
 public:
-    TextKeyframeAnimator(std::vector<Keyframe> kfs, std::vector<SkCubicMap> cms,
-                         std::vector<TextValue> vs, TextValue* target_value)
-        : INHERITED(std::move(kfs), std::move(cms))
-        , fValues(std::move(vs))
+    class Data final : public KeyframeData {
+    public:
+        std::vector<TextValue> fValues;
+    };
+
+    // |data| is a Data, from TextAnimatorBuilder.
+    TextKeyframeAnimator(sk_sp<const KeyframeData> data, TextValue* target_value)
+        : INHERITED(data)
+        , fValues(static_cast<const Data&>(*data).fValues)
         , fTarget(target_value) {}
 
 private:
@@ -45,8 +50,8 @@ private:
         return false;
     }
 
-    const std::vector<TextValue> fValues;
-    TextValue*                   fTarget;
+    const std::vector<TextValue>& fValues;
+    TextValue*                    fTarget;
 
     using INHERITED = KeyframeAnimator;
 };
@@ -78,34 +83,37 @@ public:
         : INHERITED(Keyframe::Value::Type::kIndex)
         , fTarget(target) {}
 
-    sk_sp<KeyframeAnimator> makeFromKeyframes(const AnimationBuilder& abuilder,
-                                    const skjson::ArrayValue& jkfs) override {
-        SkASSERT(jkfs.size() > 0);
+    sk_sp<Animator> makeFromExpression(ExpressionManager& em, const char* expr) override {
+         sk_sp<ExpressionEvaluator<SkString>> expression_evaluator =
+                em.createStringExpressionEvaluator(expr);
+            return sk_make_sp<TextExpressionAnimator>(expression_evaluator, fTarget);
+    }
+
+    bool parseValue(const AnimationBuilder& abuilder, const skjson::Value& jv) const override {
+        return Parse(jv, abuilder, fTarget);
+    }
 
+private:
+    sk_sp<KeyframeData> parseKeyframeData(const AnimationBuilder& abuilder,
+                                          const skjson::ArrayValue& jkfs) override {
         fValues.reserve(jkfs.size());
         if (!this->parseKeyframes(abuilder, jkfs)) {
             return nullptr;
         }
         fValues.shrink_to_fit();
 
-        return sk_sp<TextKeyframeAnimator>(
-                    new TextKeyframeAnimator(std::move(fKFs),
-                                                std::move(fCMs),
-                                                std::move(fValues),
-                                                fTarget));
+        auto data = sk_make_sp<TextKeyframeAnimator::Data>();
+        data->fValues = std::move(fValues);
+        return this->releaseKeyframes(std::move(data));
     }
 
-    sk_sp<Animator> makeFromExpression(ExpressionManager& em, const char* expr) override {
-         sk_sp<ExpressionEvaluator<SkString>> expression_evaluator =
-                em.createStringExpressionEvaluator(expr);
-            return sk_make_sp<TextExpressionAnimator>(expression_evaluator, fTarget);
+    sk_sp<KeyframeAnimator> makeKeyframeAnimator(sk_sp<const KeyframeData> data) override {
+        return sk_make_sp<TextKeyframeAnimator>(std::move(data), fTarget);
     }
 
-    bool parseValue(const AnimationBuilder& abuilder, const skjson::Value& jv) const override {
-        return Parse(jv, abuilder, fTarget);
-    }
+    // Text values hold typefaces, which depend on the builder's fonts.
+    const void* keyframeDataKind() const override { return nullptr; }
 
-private:
     bool parseKFValue(const AnimationBuilder& abuilder,
                         const skjson::ObjectValue&,
                         const skjson::Value& jv,
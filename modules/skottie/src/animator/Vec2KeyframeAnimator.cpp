@@ -41,10 +41,15 @@ public:
         sk_sp<SkContourMeasure> cmeasure;
     };
 
-    Vec2KeyframeAnimator(std::vector<Keyframe> kfs, std::vector<SkCubicMap> cms,
-                         std::vector<SpatialValue> vs, Vec2Value* vec_target, float* rot_target)
-        : INHERITED(std::move(kfs), std::move(cms))
-        , fValues(std::move(vs))
+    class Data final : public KeyframeData {
+    public:
+        std::vector<SpatialValue> fValues;
+    };
+
+    // |data| is a Data, from Vec2AnimatorBuilder.
+    Vec2KeyframeAnimator(sk_sp<const KeyframeData> data, Vec2Value* vec_target, float* rot_target)
+        : INHERITED(data)
+        , fValues(static_cast<const Data&>(*data).fValues)
         , fVecTarget(vec_target)
         , fRotTarget(rot_target) {}
 
@@ -120,7 +125,7 @@ private:
         return this->update(Lerp(v0.v2, v1.v2, lerp_info.weight), tan);
     }
 
-    const std::vector<Vec2KeyframeAnimator::SpatialValue> fValues;
+    const std::vector<SpatialValue>& fValues;
     Vec2Value*                      fVecTarget;
     float*                          fRotTarget;
 
@@ -157,35 +162,39 @@ class Vec2AnimatorBuilder final : public AnimatorBuilder {
             , fVecTarget(vec_target)
             , fRotTarget(rot_target) {}
 
-        sk_sp<KeyframeAnimator> makeFromKeyframes(const AnimationBuilder& abuilder,
-                                     const skjson::ArrayValue& jkfs) override {
-            SkASSERT(jkfs.size() > 0);
+        sk_sp<Animator> makeFromExpression(ExpressionManager& em, const char* expr) override {
+            sk_sp<ExpressionEvaluator<std::vector<SkScalar>>> expression_evaluator =
+                em.createArrayExpressionEvaluator(expr);
+            return sk_make_sp<Vec2ExpressionAnimator>(expression_evaluator, fVecTarget);
+        }
+
+        bool parseValue(const AnimationBuilder&, const skjson::Value& jv) const override {
+            return ::skottie::Parse(jv, fVecTarget);
+        }
 
+    private:
+        sk_sp<KeyframeData> parseKeyframeData(const AnimationBuilder& abuilder,
+                                              const skjson::ArrayValue& jkfs) override {
             fValues.reserve(jkfs.size());
             if (!this->parseKeyframes(abuilder, jkfs)) {
                 return nullptr;
             }
             fValues.shrink_to_fit();
 
-            return sk_sp<Vec2KeyframeAnimator>(
-                        new Vec2KeyframeAnimator(std::move(fKFs),
-                                                 std::move(fCMs),
-                                                 std::move(fValues),
-                                                 fVecTarget,
-                                                 fRotTarget));
+            auto data = sk_make_sp<Vec2KeyframeAnimator::Data>();
+            data->fValues = std::move(fValues);
+            return this->releaseKeyframes(std::move(data));
         }
 
-        sk_sp<Animator> makeFromExpression(ExpressionManager& em, const char* expr) override {
-            sk_sp<ExpressionEvaluator<std::vector<SkScalar>>> expression_evaluator =
-                em.createArrayExpressionEvaluator(expr);
-            return sk_make_sp<Vec2ExpressionAnimator>(expression_evaluator, fVecTarget);
+        sk_sp<KeyframeAnimator> makeKeyframeAnimator(sk_sp<const KeyframeData> data) override {
+            return sk_make_sp<Vec2KeyframeAnimator>(std::move(data), fVecTarget, fRotTarget);
         }
 
-        bool parseValue(const AnimationBuilder&, const skjson::Value& jv) const override {
-            return ::skottie::Parse(jv, fVecTarget);
+        const void* keyframeDataKind() const override {
+            static constexpr char kKind = 0;
+            return &kKind;
         }
 
-    private:
         void backfill_spatial(const Vec2KeyframeAnimator::SpatialValue& val) {
             SkASSERT(!fValues.empty());
             auto& prev_val = fValues.back();
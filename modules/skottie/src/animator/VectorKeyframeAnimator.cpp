@@ -85,14 +85,17 @@ namespace {
 //
 class VectorKeyframeAnimator final : public KeyframeAnimator {
 public:
-    VectorKeyframeAnimator(std::vector<Keyframe> kfs,
-                           std::vector<SkCubicMap> cms,
-                           std::vector<float> storage,
-                           size_t vec_len,
-                           std::vector<float>* target_value)
-        : INHERITED(std::move(kfs), std::move(cms))
-        , fStorage(std::move(storage))
-        , fVecLen(vec_len)
+    class Data final : public KeyframeData {
+    public:
+        std::vector<float> fStorage;
+        size_t             fVecLen;
+    };
+
+    // |data| is a Data, from VectorAnimatorBuilder.
+    VectorKeyframeAnimator(sk_sp<const KeyframeData> data, std::vector<float>* target_value)
+        : INHERITED(data)
+        , fStorage(static_cast<const Data&>(*data).fStorage)
+        , fVecLen(static_cast<const Data&>(*data).fVecLen)
         , fTarget(target_value) {
 
         // Resize the target value appropriately.
@@ -149,8 +152,8 @@ private:
         return changed;
     }
 
-    const std::vector<float> fStorage;
-    const size_t             fVecLen;
+    const std::vector<float>& fStorage;
+    const size_t              fVecLen;
 
     std::vector<float>*      fTarget;
 
@@ -194,8 +197,8 @@ VectorAnimatorBuilder::VectorAnimatorBuilder(std::vector<float>* target,
     , fParseData(parse_data)
     , fTarget(target) {}
 
-sk_sp<KeyframeAnimator> VectorAnimatorBuilder::makeFromKeyframes(const AnimationBuilder& abuilder,
-                                                            const skjson::ArrayValue& jkfs) {
+sk_sp<KeyframeData> VectorAnimatorBuilder::parseKeyframeData(const AnimationBuilder& abuilder,
+                                                             const skjson::ArrayValue& jkfs) {
     SkASSERT(jkfs.size() > 0);
 
     // peek at the first keyframe value to find our vector length
@@ -223,12 +226,20 @@ sk_sp<KeyframeAnimator> VectorAnimatorBuilder::makeFromKeyframes(const Animation
     fStorage.resize(fCurrentVec * fVecLen);
     fStorage.shrink_to_fit();
 
-    return sk_sp<VectorKeyframeAnimator>(
-                new VectorKeyframeAnimator(std::move(fKFs),
-                                           std::move(fCMs),
-                                           std::move(fStorage),
-                                           fVecLen,
-                                           fTarget));
+    auto data = sk_make_sp<VectorKeyframeAnimator::Data>();
+    data->fStorage = std::move(fStorage);
+    data->fVecLen  = fVecLen;
+    return this->releaseKeyframes(std::move(data));
+}
+
+sk_sp<KeyframeAnimator> VectorAnimatorBuilder::makeKeyframeAnimator(
+        sk_sp<const KeyframeData> data) {
+    return sk_make_sp<VectorKeyframeAnimator>(std::move(data), fTarget);
+}
+
+const void* VectorAnimatorBuilder::keyframeDataKind() const {
+    // Values only depend on how they are parsed.
+    return reinterpret_cast<const void*>(fParseData);
 }
 
 sk_sp<Animator> VectorAnimatorBuilder::makeFromExpression(ExpressionManager& em, const char* expr) {
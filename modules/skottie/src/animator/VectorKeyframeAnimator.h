@@ -35,12 +35,16 @@ public:
 
     VectorAnimatorBuilder(std::vector<float>*, VectorLenParser, VectorDataParser);
 
-    sk_sp<KeyframeAnimator> makeFromKeyframes(const AnimationBuilder&,
-                                              const skjson::ArrayValue&) override;
-
     sk_sp<Animator> makeFromExpression(ExpressionManager&, const char*) override;
 
 private:
+    sk_sp<KeyframeData> parseKeyframeData(const AnimationBuilder&,
+                                          const skjson::ArrayValue&) override;
+
+    sk_sp<KeyframeAnimator> makeKeyframeAnimator(sk_sp<const KeyframeData>) override;
+
+    const void* keyframeDataKind() const override;
+
     bool parseValue(const AnimationBuilder&, const skjson::Value&) const override;
 
     bool parseKFValue(const AnimationBuilder&,
@@ -125,7 +125,18 @@ AnimationBuilder::loadFootageAsset(const skjson::ObjectValue& defaultJImage) con
         return cached_info;
     }
 
-    auto asset = fResourceProvider->loadImageAsset(path->begin(), name->begin(), id->begin());
+    // Slotted images can be replaced per animation, and multi-frame images hold the current
+    // frame, so only other images are shared between animations built from a template.
+    sk_sp<ImageAsset> asset;
+    if (fTemplateCache && !slotID) {
+        asset = fTemplateCache->findImage(res_id);
+    }
+    if (!asset) {
+        asset = fResourceProvider->loadImageAsset(path->begin(), name->begin(), id->begin());
+        if (asset && fTemplateCache && !slotID && !asset->isMultiFrame()) {
+            fTemplateCache->addImage(res_id, asset);
+        }
+    }
     if (!asset && !slotID) {
         this->log(Logger::Level::kError, nullptr, "Could not load image asset: %s/%s (id: '%s').",
                   path->begin(), name->begin(), id->begin());
@@ -287,7 +287,7 @@ public:
                    std::move(fontmgr),
                    nullptr, nullptr, nullptr, nullptr, nullptr,
                    std::move(sfact),
-                   &fStats, {0, 0}, 1, 1, 0)
+                   &fStats, {0, 0}, 1, 1, 0, 0, nullptr)
         , fAlloc(4096)
     {}
 
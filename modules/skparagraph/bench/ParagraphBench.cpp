@@ -13,6 +13,9 @@
 #include "tools/fonts/FontToolUtils.h"
 
 #include <cfloat>
+#include <memory>
+#include <vector>
+#include "include/core/SkExecutor.h"
 #include "include/core/SkPictureRecorder.h"
 #include "modules/skparagraph/utils/TestFontCollection.h"
 
@@ -47,10 +50,59 @@ struct ParagraphBench : public Benchmark {
         SkCanvas* canvas = rec.beginRecording({0,0, 2000,3000});
         while (loops-- > 0) {
             paragraph->layout(fWidth);
-            auto impl = static_cast<ParagraphImpl*>(paragraph.get());
             paragraph->paint(canvas, 0, 0);
             paragraph->markDirty();
-            impl->resetCache();
+            fontCollection->getParagraphCache()->reset();
+        }
+    }
+};
+
+// Lays out many independent paragraphs sharing a FontCollection, with Paragraph::LayoutAll().
+struct ParagraphBatchBench : public Benchmark {
+    ParagraphBatchBench(bool threaded, const char* r, const char* n)
+            : fResource(r), fName(n), fThreaded(threaded) {}
+    static constexpr int kParagraphs = 64;
+    sk_sp<SkData> fData;
+    std::unique_ptr<SkExecutor> fExecutor;
+    const char* fResource;
+    const char* fName;
+    bool fThreaded;
+    const char* onGetName() override { return fName; }
+    bool isSuitableFor(Backend backend) override { return backend == Backend::kNonRendering; }
+    void onDelayedSetup() override {
+        fData = GetResourceAsData(fResource);
+        if (fThreaded) {
+            fExecutor = SkExecutor::MakeFIFOThreadPool();
+        }
+    }
+    void onDraw(int loops, SkCanvas*) override {
+        if (!fData) {
+            return;
+        }
+
+        const char* text = (const char*)fData->data();
+
+        auto fontCollection = sk_make_sp<FontCollection>();
+        fontCollection->setDefaultFontManager(ToolUtils::TestFontMgr());
+        // Shape every paragraph, rather than copying the first one's results.
+        fontCollection->getParagraphCache()->turnOn(false);
+        ParagraphStyle paragraph_style;
+        paragraph_style.turnHintingOff();
+
+        std::vector<std::unique_ptr<Paragraph>> paragraphs;
+        std::vector<Paragraph*> batch;
+        for (int i = 0; i < kParagraphs; ++i) {
+            ParagraphBuilderImpl builder(paragraph_style, fontCollection);
+            builder.addText(text);
+            paragraphs.push_back(builder.Build());
+            batch.push_back(paragraphs.back().get());
+        }
+
+        while (loops-- > 0) {
+            Paragraph::LayoutAll(batch, 500, fExecutor.get());
+            for (Paragraph* paragraph : batch) {
+                paragraph->markDirty();
+            }
         }
     }
 };
@@ -62,4 +114,8 @@ struct ParagraphBench : public Benchmark {
 PARAGRAPH_BENCH(english)
 #undef PARAGRAPH_BENCH
 
+DEF_BENCH(return new ParagraphBatchBench(false, "text/english.txt", "paragraph_batch_english");)
+DEF_BENCH(return new ParagraphBatchBench(true, "text/english.txt",
+                                         "paragraph_batch_english_threaded");)
+
 #endif  // !defined(SK_BUILD_FOR_ANDROID_FRAMEWORK) && !defined(SK_BUILD_FOR_GOOGLE3)
@@ -11,6 +11,7 @@
 #include "modules/skparagraph/include/FontArguments.h"
 #include "modules/skparagraph/include/ParagraphCache.h"
 #include "modules/skparagraph/include/TextStyle.h"
+#include "src/base/SkSharedMutex.h"
 #include "src/core/SkTHash.h"
 
 namespace skia {
@@ -18,6 +19,10 @@ namespace textlayout {
 
 class TextStyle;
 class Paragraph;
+
+// Font managers and fallback settings must be set up before the collection is shared.  After
+// that, paragraphs can be laid out with it on several threads at once: the typeface lookups and
+// their caches are thread-safe.
 class FontCollection : public SkRefCnt {
 public:
     FontCollection();
@@ -44,7 +49,9 @@ public:
     void enableFontFallback();
     bool fontFallbackEnabled() { return fEnableFontFallback; }
 
-    ParagraphCache* getParagraphCache() { return &fParagraphCache; }
+    ParagraphCache* getParagraphCache() { return fParagraphCache.get(); }
+    // Lets several collections that resolve families the same way share shaping results.
+    void setParagraphCache(sk_sp<ParagraphCache> cache);
 
     void clearCaches();
 
@@ -70,15 +77,33 @@ private:
         };
     };
 
+    struct FallbackKey {
+        SkUnichar fUnicode;
+        SkFontStyle fFontStyle;
+        SkString fLocale;
+
+        bool operator==(const FallbackKey& other) const;
+
+        struct Hasher {
+            uint32_t operator()(const FallbackKey& key) const;
+        };
+    };
+
     bool fEnableFontFallback;
-    skia_private::THashMap<FamilyKey, std::vector<sk_sp<SkTypeface>>, FamilyKey::Hasher> fTypefaces;
+
+    // Lookups take the lock shared, and only take it exclusively to add what they found.
+    SkSharedMutex fCacheMutex;
+    skia_private::THashMap<FamilyKey, std::vector<sk_sp<SkTypeface>>, FamilyKey::Hasher> fTypefaces
+            SK_GUARDED_BY(fCacheMutex);
+    skia_private::THashMap<FallbackKey, sk_sp<SkTypeface>, FallbackKey::Hasher> fFallbacks
+            SK_GUARDED_BY(fCacheMutex);
     sk_sp<SkFontMgr> fDefaultFontManager;
     sk_sp<SkFontMgr> fAssetFontManager;
     sk_sp<SkFontMgr> fDynamicFontManager;
     sk_sp<SkFontMgr> fTestFontManager;
 
     std::vector<SkString> fDefaultFamilyNames;
-    ParagraphCache fParagraphCache;
+    sk_sp<ParagraphCache> fParagraphCache;
 };
 }  // namespace textlayout
 }  // namespace skia
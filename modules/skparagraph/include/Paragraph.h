@@ -3,6 +3,7 @@
 #define Paragraph_DEFINED
 
 #include "include/core/SkPath.h"
+#include "include/core/SkSpan.h"
 #include "modules/skparagraph/include/FontCollection.h"
 #include "modules/skparagraph/include/Metrics.h"
 #include "modules/skparagraph/include/ParagraphStyle.h"
@@ -10,6 +11,7 @@
 #include <unordered_set>
 
 class SkCanvas;
+class SkExecutor;
 
 namespace skia {
 namespace textlayout {
@@ -41,6 +43,12 @@ public:
 
     virtual void layout(SkScalar width) = 0;
 
+    // Lays out all the paragraphs at the same width, spreading them across the executor's
+    // threads (or on this thread, without an executor), and returns once they are all done.
+    // The paragraphs must be distinct, but can share a FontCollection.
+    static void LayoutAll(SkSpan<Paragraph* const> paragraphs, SkScalar width,
+                          SkExecutor* executor);
+
     virtual void paint(SkCanvas* canvas, SkScalar x, SkScalar y) = 0;
 
     virtual void paint(ParagraphPainter* painter, SkScalar x, SkScalar y) = 0;
@@ -74,12 +82,20 @@ public:
     virtual std::unordered_set<SkUnichar> unresolvedCodepoints() = 0;
 
     // Experimental API that allows fast way to update some of "immutable" paragraph attributes
-    // but not the text itself
     virtual void updateTextAlign(TextAlign textAlign) = 0;
     virtual void updateFontSize(size_t from, size_t to, SkScalar fontSize) = 0;
     virtual void updateForegroundPaint(size_t from, size_t to, SkPaint paint) = 0;
     virtual void updateBackgroundPaint(size_t from, size_t to, SkPaint paint) = 0;
 
+    // Replaces the UTF-8 text in [from, to) with the given text, which takes the style of the
+    // text before it (or of the first text style at the start of the paragraph).
+    // The next layout() only shapes the text that the edit touched, and reuses the runs of the
+    // rest of the paragraph. Returns false and leaves the paragraph as it was if the range
+    // does not fall on code point boundaries, overlaps a placeholder, or the text is not UTF-8.
+    // Not for paragraphs built with SkUnicode from client-provided text information, which only
+    // holds for the original text.
+    virtual bool updateText(size_t from, size_t to, const SkString& text) = 0;
+
     enum VisitorFlags {
         kWhiteSpace_VisitorFlag = 1 << 0,
     };
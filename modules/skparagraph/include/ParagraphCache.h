@@ -2,9 +2,16 @@
 #ifndef ParagraphCache_DEFINED
 #define ParagraphCache_DEFINED
 
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkString.h"
 #include "include/private/base/SkMutex.h"
+#include "include/private/base/SkThreadAnnotations.h"
 #include "src/core/SkLRUCache.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <functional>  // std::function
+#include <memory>
 
 #define PARAGRAPH_CACHE_STATS
 
@@ -15,50 +22,74 @@ class ParagraphImpl;
 class ParagraphCacheKey;
 class ParagraphCacheValue;
 
-class ParagraphCache {
+/**
+ *  Remembers how paragraphs were shaped, so that laying out the same text with the same styles
+ *  again (at any width) does not shape it again.
+ *
+ *  The cache is split into shards, each with its own lock and LRU list, so that paragraphs laid
+ *  out on different threads rarely wait for each other. Its size is limited by an estimate of
+ *  the bytes its entries use.
+ *
+ *  A cache may be shared by several FontCollections (see FontCollection::setParagraphCache()),
+ *  as long as they resolve font families to the same typefaces: entries are keyed by family
+ *  names, not by typefaces.
+ */
+class ParagraphCache : public SkRefCnt {
 public:
+    static constexpr size_t kDefaultByteBudget = 4 * 1024 * 1024;
+    static constexpr int kDefaultShardCount = 8;
+
     ParagraphCache();
-    ~ParagraphCache();
+    ParagraphCache(size_t byteBudget, int shardCount);
+    ~ParagraphCache() override;
 
     void abandon();
     void reset();
     bool updateParagraph(ParagraphImpl* paragraph);
     bool findParagraph(ParagraphImpl* paragraph);
 
+    struct Stats {
+        int fCount = 0;
+        size_t fBytes = 0;
+        uint64_t fHits = 0;
+        uint64_t fMisses = 0;
+        uint64_t fEvictions = 0;
+    };
+    // Totals over all shards since the cache was made or last reset().
+    Stats stats() const;
+    size_t byteBudget() const { return fByteBudget; }
+
     // For testing
     void setChecker(std::function<void(ParagraphImpl* impl, const char*, bool)> checker) {
         fChecker = std::move(checker);
     }
     void printStatistics();
     void turnOn(bool value) { fCacheIsOn = value; }
-    int count() { return fLRUCacheMap.count(); }
+    int count() { return this->stats().fCount; }
 
     bool isPossiblyTextEditing(ParagraphImpl* paragraph);
 
  private:
 
     struct Entry;
-    void updateFrom(const ParagraphImpl* paragraph, Entry* entry);
+    struct Shard;
     void updateTo(ParagraphImpl* paragraph, const Entry* entry);
+    Shard& shardFor(const ParagraphCacheKey& key) const;
 
-     mutable SkMutex fParagraphMutex;
-     std::function<void(ParagraphImpl* impl, const char*, bool)> fChecker;
-
-    static const int kMaxEntries = 128;
+    std::function<void(ParagraphImpl* impl, const char*, bool)> fChecker;
 
     struct KeyHash {
         uint32_t operator()(const ParagraphCacheKey& key) const;
     };
 
-    SkLRUCache<ParagraphCacheKey, std::unique_ptr<Entry>, KeyHash> fLRUCacheMap;
-    bool fCacheIsOn;
-    ParagraphCacheValue* fLastCachedValue;
+    const size_t fByteBudget;
+    const int fShardCount;
+    std::unique_ptr<Shard[]> fShards;
+    std::atomic<bool> fCacheIsOn;
 
-#ifdef PARAGRAPH_CACHE_STATS
-    int fTotalRequests;
-    int fCacheMisses;
-    int fHashMisses; // cache hit but hash table missed
-#endif
+    // The text of the paragraph added last, for isPossiblyTextEditing().
+    SkMutex fLastCachedTextMutex;
+    SkString fLastCachedText SK_GUARDED_BY(fLastCachedTextMutex);
 };
 
 }  // namespace textlayout
@@ -33,9 +33,22 @@ size_t FontCollection::FamilyKey::Hasher::operator()(const FontCollection::Famil
            std::hash<std::optional<FontArguments>>()(key.fFontArguments);
 }
 
+bool FontCollection::FallbackKey::operator==(const FontCollection::FallbackKey& other) const {
+    return fUnicode == other.fUnicode &&
+           fFontStyle == other.fFontStyle &&
+           fLocale == other.fLocale;
+}
+
+uint32_t FontCollection::FallbackKey::Hasher::operator()(const FontCollection::FallbackKey& key) const {
+    return SkGoodHash()(key.fUnicode) ^
+           SkGoodHash()(key.fFontStyle) ^
+           SkGoodHash()(key.fLocale);
+}
+
 FontCollection::FontCollection()
         : fEnableFontFallback(true)
-        , fDefaultFamilyNames({SkString(DEFAULT_FONT_FAMILY)}) { }
+        , fDefaultFamilyNames({SkString(DEFAULT_FONT_FAMILY)})
+        , fParagraphCache(sk_make_sp<ParagraphCache>()) { }
 
 size_t FontCollection::getFontManagersCount() const { return this->getFontManagerOrder().size(); }
 
@@ -43,6 +56,10 @@ void FontCollection::setAssetFontManager(sk_sp<SkFontMgr> font_manager) {
     fAssetFontManager = std::move(font_manager);
 }
 
+void FontCollection::setParagraphCache(sk_sp<ParagraphCache> cache) {
+    fParagraphCache = cache ? std::move(cache) : sk_make_sp<ParagraphCache>();
+}
+
 void FontCollection::setDynamicFontManager(sk_sp<SkFontMgr> font_manager) {
     fDynamicFontManager = std::move(font_manager);
 }
@@ -92,9 +109,11 @@ std::vector<sk_sp<SkTypeface>> FontCollection::findTypefaces(const std::vector<S
 std::vector<sk_sp<SkTypeface>> FontCollection::findTypefaces(const std::vector<SkString>& familyNames, SkFontStyle fontStyle, const std::optional<FontArguments>& fontArgs) {
     // Look inside the font collections cache first
     FamilyKey familyKey(familyNames, fontStyle, fontArgs);
-    auto found = fTypefaces.find(familyKey);
-    if (found) {
-        return *found;
+    {
+        SkAutoSharedMutexShared lock(fCacheMutex);
+        if (auto found = fTypefaces.find(familyKey)) {
+            return *found;
+        }
     }
 
     std::vector<sk_sp<SkTypeface>> typefaces;
@@ -129,6 +148,8 @@ std::vector<sk_sp<SkTypeface>> FontCollection::findTypefaces(const std::vector<S
         }
     }
 
+    // Another thread may have matched the same families meanwhile, with the same result.
+    SkAutoSharedMutexExclusive lock(fCacheMutex);
     fTypefaces.set(familyKey, typefaces);
     return typefaces;
 }
@@ -153,6 +174,15 @@ sk_sp<SkTypeface> FontCollection::matchTypeface(const SkString& familyName, SkFo
 sk_sp<SkTypeface> FontCollection::defaultFallback(SkUnichar unicode,
                                                   SkFontStyle fontStyle,
                                                   const SkString& locale) {
+    // Paragraphs usually fall back for the same few characters, so matches are shared by all the
+    // paragraphs using the collection.  Misses are not cached.
+    FallbackKey fallbackKey{unicode, fontStyle, locale};
+    {
+        SkAutoSharedMutexShared lock(fCacheMutex);
+        if (auto found = fFallbacks.find(fallbackKey)) {
+            return *found;
+        }
+    }
 
     for (const auto& manager : this->getFontManagerOrder()) {
         std::vector<const char*> bcp47;
@@ -163,6 +193,8 @@ sk_sp<SkTypeface> FontCollection::defaultFallback(SkUnichar unicode,
             nullptr, fontStyle, bcp47.data(), bcp47.size(), unicode));
 
         if (typeface != nullptr) {
+            SkAutoSharedMutexExclusive lock(fCacheMutex);
+            fFallbacks.set(fallbackKey, typeface);
             return typeface;
         }
     }
@@ -219,8 +251,12 @@ void FontCollection::disableFontFallback() { fEnableFontFallback = false; }
 void FontCollection::enableFontFallback() { fEnableFontFallback = true; }
 
 void FontCollection::clearCaches() {
-    fParagraphCache.reset();
-    fTypefaces.reset();
+    fParagraphCache->reset();
+    {
+        SkAutoSharedMutexExclusive lock(fCacheMutex);
+        fTypefaces.reset();
+        fFallbacks.reset();
+    }
     SkShapers::HB::PurgeCaches();
 }
 
@@ -7,6 +7,7 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <unordered_set>
 
 using namespace skia_private;
@@ -14,6 +15,19 @@ using namespace skia_private;
 namespace skia {
 namespace textlayout {
 
+// The features of a block as the shaper sees them: clipped to the block, relative to its start
+static TArray<SkShaper::Feature> relative_features(const TArray<SkShaper::Feature>& features,
+                                                   TextRange text) {
+    TArray<SkShaper::Feature> relative(features.size());
+    for (const SkShaper::Feature& feature : features) {
+        relative.push_back({feature.tag,
+                            feature.value,
+                            std::max(feature.start, text.start) - text.start,
+                            std::min(feature.end, text.end) - text.start});
+    }
+    return relative;
+}
+
 void OneLineShaper::commitRunBuffer(const RunInfo&) {
 
     fCurrentRun->commit();
@@ -157,6 +171,7 @@ void OneLineShaper::finish(const Block& block, SkScalar height, SkScalar& advanc
         fResolvedBlocks.emplace_back(unresolved);
         fUnresolvedGlyphs += unresolved.fGlyphs.width();
         fParagraph->addUnresolvedCodepoints(unresolved.fText);
+        fUnresolvedText.push_back(unresolved.fText);
     }
 
     // Sort all pieces by text
@@ -249,6 +264,169 @@ void OneLineShaper::finish(const Block& block, SkScalar height, SkScalar& advanc
     }
 }
 
+bool OneLineShaper::canReuse(const ShapedBlock& shaped,
+                             const Block& block,
+                             const TArray<SkShaper::Feature>& features,
+                             uint8_t bidiLevel) const {
+    const auto& previous = *fParagraph->fPreviousShaping;
+    const TextRange text = block.fRange;
+    const TextRange shapedText = shaped.fBlock.fRange;
+    if (!shaped.fStartsGraphemes ||
+        shapedText.width() != text.width() ||
+        shaped.fBidiLevel != bidiLevel ||
+        !shaped.fBlock.fStyle.equals(block.fStyle)) {
+        return false;
+    }
+
+    const TArray<SkShaper::Feature> relative = relative_features(features, text);
+    if (relative.size() != shaped.fFeatures.size()) {
+        return false;
+    }
+    for (int i = 0; i < relative.size(); ++i) {
+        const SkShaper::Feature& a = relative[i];
+        const SkShaper::Feature& b = shaped.fFeatures[i];
+        if (a.tag != b.tag || a.value != b.value || a.start != b.start || a.end != b.end) {
+            return false;
+        }
+    }
+
+    if (memcmp(previous.fText.c_str() + shapedText.start,
+               fParagraph->fText.c_str() + text.start,
+               text.width()) != 0) {
+        return false;
+    }
+
+    // The shaper only looks at where the graphemes start and at control characters. Whether a
+    // grapheme starts can depend on the text around the block (regional indicators, joiners),
+    // so the text being the same is not enough. The block has to start a grapheme, too, or
+    // looking for the start of its first one would go on into the text before it.
+    constexpr auto kFlags = SkUnicode::CodeUnitFlags::kGraphemeStart |
+                            SkUnicode::CodeUnitFlags::kControl;
+    if (!fParagraph->codeUnitHasProperty(text.start,
+                                         SkUnicode::CodeUnitFlags::kGraphemeStart)) {
+        return false;
+    }
+    for (size_t i = 0; i < text.width(); ++i) {
+        if ((fParagraph->fCodeUnitProperties[text.start + i] & kFlags) !=
+            (previous.fCodeUnitProperties[shapedText.start + i] & kFlags)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool OneLineShaper::reuseShapedBlock(const Block& block,
+                                     const TArray<SkShaper::Feature>& features,
+                                     uint8_t bidiLevel,
+                                     SkScalar& advanceX) {
+    const auto* previous = fParagraph->fPreviousShaping.get();
+    if (previous == nullptr) {
+        return false;
+    }
+
+    // A block the edit did not touch is either before it, where the text did not move,
+    // or after it, where the text moved as much as it grew or shrank
+    const TextRange text = block.fRange;
+    const ShapedBlock* shaped = nullptr;
+    for (TextIndex start : {text.start,
+                            text.start + previous->fText.size() - fParagraph->fText.size()}) {
+        auto found = std::lower_bound(previous->fShapedBlocks.begin(),
+                                      previous->fShapedBlocks.end(),
+                                      start,
+                                      [](const ShapedBlock& candidate, TextIndex start) {
+                                          return candidate.fBlock.fRange.start < start;
+                                      });
+        if (found != previous->fShapedBlocks.end() && found->fBlock.fRange.start == start &&
+            this->canReuse(*found, block, features, bidiLevel)) {
+            shaped = found;
+            break;
+        }
+    }
+    if (shaped == nullptr) {
+        return false;
+    }
+
+    // The runs were shaped in the same place on the line relative to the block
+    const TextIndex shapedStart = shaped->fBlock.fRange.start;
+    const SkScalar shiftX = advanceX - shaped->fAdvanceX;
+    const size_t firstRun = fParagraph->fRuns.size();
+    for (size_t index = shaped->fRuns.start; index < shaped->fRuns.end; ++index) {
+        const Run& run = previous->fRuns[index];
+        const SkShaper::RunHandler::RunInfo info = {
+                run.fFont,
+                run.fBidiLevel,
+                run.fAdvance,
+                run.size(),
+                run.fUtf8Range
+        };
+        auto& copy = fParagraph->fRuns.emplace_back(fParagraph,
+                                                    info,
+                                                    run.fClusterStart - shapedStart + text.start,
+                                                    run.fHeightMultiplier,
+                                                    run.fUseHalfLeading,
+                                                    run.fBaselineShift,
+                                                    fParagraph->fRuns.size(),
+                                                    run.fOffset.fX + shiftX);
+        for (size_t i = 0; i <= run.size(); ++i) {
+            if (i < run.size()) {
+                copy.fGlyphs[i] = run.fGlyphs[i];
+            }
+            copy.fPositions[i] = run.fPositions[i] + SkVector::Make(shiftX, 0);
+            copy.fOffsets[i] = run.fOffsets[i];
+            copy.fClusterIndexes[i] = run.fClusterIndexes[i];
+        }
+        fParagraph->fFontSwitches.emplace_back(copy.fTextRange.start, copy.fFont);
+    }
+
+    fUnresolvedGlyphs += shaped->fUnresolvedGlyphs;
+    for (TextRange unresolved : shaped->fUnresolvedText) {
+        unresolved = TextRange(unresolved.start - shapedStart + text.start,
+                               unresolved.end - shapedStart + text.start);
+        fParagraph->addUnresolvedCodepoints(unresolved);
+        fUnresolvedText.push_back(unresolved);
+    }
+    fParagraph->fReusedRuns += fParagraph->fRuns.size() - firstRun;
+
+    this->addShapedBlock(block,
+                         features,
+                         bidiLevel,
+                         SkRange<size_t>(firstRun, fParagraph->fRuns.size()),
+                         shaped->fUnresolvedGlyphs,
+                         advanceX,
+                         shaped->fAdvance);
+    advanceX += shaped->fAdvance;
+    return true;
+}
+
+void OneLineShaper::addShapedBlock(const Block& block,
+                                   const TArray<SkShaper::Feature>& features,
+                                   uint8_t bidiLevel,
+                                   SkRange<size_t> runs,
+                                   size_t unresolvedGlyphs,
+                                   SkScalar advanceX,
+                                   SkScalar advance) {
+    auto& shaped = fParagraph->fShapedBlocks.emplace_back();
+    shaped.fBlock = block;
+    shaped.fFeatures = relative_features(features, block.fRange);
+    shaped.fBidiLevel = bidiLevel;
+    shaped.fRuns = runs;
+    shaped.fAdvanceX = advanceX;
+    shaped.fAdvance = advance;
+    shaped.fUnresolvedGlyphs = unresolvedGlyphs;
+    shaped.fUnresolvedText = std::move(fUnresolvedText);
+    fUnresolvedText.clear();
+
+    // Until the cluster table is built, the code unit flags are the ones the shaper looked at
+    shaped.fStartsGraphemes = fParagraph->codeUnitHasProperty(
+            block.fRange.start, SkUnicode::CodeUnitFlags::kGraphemeStart);
+    for (size_t index = runs.start; index < runs.end; ++index) {
+        if (!fParagraph->codeUnitHasProperty(fParagraph->fRuns[index].fTextRange.start,
+                                             SkUnicode::CodeUnitFlags::kGraphemeStart)) {
+            shaped.fStartsGraphemes = false;
+        }
+    }
+}
+
 // Make it [left:right) regardless of a text direction
 TextRange OneLineShaper::normalizeTextRange(GlyphRange glyphRange) {
 
@@ -635,6 +813,13 @@ bool OneLineShaper::shape() {
         iterateThroughFontStyles(textRange, styleSpan,
                 [this, &shaper, defaultBidiLevel, limitlessWidth, &advanceX]
                 (Block block, TArray<SkShaper::Feature> features) {
+            if (this->reuseShapedBlock(block, features, defaultBidiLevel, advanceX)) {
+                return;
+            }
+            const size_t firstRun = fParagraph->fRuns.size();
+            const size_t unresolvedGlyphs = fUnresolvedGlyphs;
+            const SkScalar blockAdvanceX = advanceX;
+
             auto blockSpan = SkSpan<Block>(&block, 1);
 
             // Start from the beginning (hoping that it's a simple case one block - one run)
@@ -719,6 +904,13 @@ bool OneLineShaper::shape() {
             });
 
             this->finish(block, fHeight, advanceX);
+            this->addShapedBlock(block,
+                                 features,
+                                 defaultBidiLevel,
+                                 SkRange<size_t>(firstRun, fParagraph->fRuns.size()),
+                                 fUnresolvedGlyphs - unresolvedGlyphs,
+                                 blockAdvanceX,
+                                 advanceX - blockAdvanceX);
         });
 
         return true;
@@ -83,6 +83,23 @@ private:
 #endif
     void finish(const Block& block, SkScalar height, SkScalar& advanceX);
 
+    // Takes the runs of a block shaped the same way before the last text edit
+    bool reuseShapedBlock(const Block& block,
+                          const skia_private::TArray<SkShaper::Feature>& features,
+                          uint8_t bidiLevel,
+                          SkScalar& advanceX);
+    bool canReuse(const ShapedBlock& shaped,
+                  const Block& block,
+                  const skia_private::TArray<SkShaper::Feature>& features,
+                  uint8_t bidiLevel) const;
+    void addShapedBlock(const Block& block,
+                        const skia_private::TArray<SkShaper::Feature>& features,
+                        uint8_t bidiLevel,
+                        SkRange<size_t> runs,
+                        size_t unresolvedGlyphs,
+                        SkScalar advanceX,
+                        SkScalar advance);
+
     void beginLine() override {}
     void runInfo(const RunInfo&) override {}
     void commitRunInfo() override {}
@@ -125,6 +142,7 @@ private:
     std::shared_ptr<Run> fCurrentRun;
     std::deque<RunBlock> fUnresolvedBlocks;
     std::vector<RunBlock> fResolvedBlocks;
+    skia_private::TArray<TextRange, true> fUnresolvedText;  // Of the block being shaped
 
     // Keeping all resolved typefaces
     struct FontKey {
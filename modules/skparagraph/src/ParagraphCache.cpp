@@ -1,4 +1,6 @@
 // Copyright 2019 Google LLC.
+#include <algorithm>
+#include <climits>
 #include <memory>
 
 #include "modules/skparagraph/include/FontArguments.h"
@@ -54,6 +56,8 @@ public:
     uint32_t hash() const { return fHash; }
 
     const SkString& text() const { return fText; }
+    const TArray<Placeholder, true>& placeholders() const { return fPlaceholders; }
+    const TArray<Block, true>& textStyles() const { return fTextStyles; }
 
 private:
     static uint32_t mix(uint32_t hash, uint32_t data);
@@ -76,10 +80,30 @@ public:
         , fCodeUnitProperties(paragraph->fCodeUnitProperties)
         , fWords(paragraph->fWords)
         , fBidiRegions(paragraph->fBidiRegions)
+        , fShapedBlocks(paragraph->fShapedBlocks)
         , fHasLineBreaks(paragraph->fHasLineBreaks)
         , fHasWhitespacesInside(paragraph->fHasWhitespacesInside)
         , fTrailingSpaces(paragraph->fTrailingSpaces) { }
 
+    // An estimate of the memory this value holds on to, for the cache's byte budget.
+    size_t bytes() const {
+        size_t bytes = sizeof(ParagraphCacheValue) + fKey.text().size() +
+                       fKey.placeholders().size() * sizeof(Placeholder) +
+                       fKey.textStyles().size() * sizeof(Block);
+        for (const Run& run : fRuns) {
+            // Glyphs, positions, offsets and cluster indices.
+            bytes += sizeof(Run) +
+                     run.size() * (sizeof(SkGlyphID) + 2 * sizeof(SkPoint) + sizeof(uint32_t));
+        }
+        bytes += fClusters.size() * sizeof(Cluster);
+        bytes += fClustersIndexFromCodeUnit.size() * sizeof(size_t);
+        bytes += fCodeUnitProperties.size() * sizeof(SkUnicode::CodeUnitFlags);
+        bytes += fWords.size() * sizeof(size_t);
+        bytes += fBidiRegions.size() * sizeof(SkUnicode::BidiRegion);
+        bytes += fShapedBlocks.size() * sizeof(ShapedBlock);
+        return bytes;
+    }
+
     // Input == key
     ParagraphCacheKey fKey;
 
@@ -91,6 +115,7 @@ public:
     TArray<SkUnicode::CodeUnitFlags, true> fCodeUnitProperties;
     std::vector<size_t> fWords;
     std::vector<SkUnicode::BidiRegion> fBidiRegions;
+    TArray<ShapedBlock> fShapedBlocks;
     bool fHasLineBreaks;
     bool fHasWhitespacesInside;
     TextIndex fTrailingSpaces;
@@ -234,24 +259,50 @@ bool ParagraphCacheKey::operator==(const ParagraphCacheKey& other) const {
 
 struct ParagraphCache::Entry {
 
-    Entry(ParagraphCacheValue* value) : fValue(value) {}
+    Entry(ParagraphCacheValue* value) : fValue(value), fBytes(value->bytes()) {}
     std::unique_ptr<ParagraphCacheValue> fValue;
+    size_t fBytes;
 };
 
-ParagraphCache::ParagraphCache()
+struct ParagraphCache::Shard {
+    explicit Shard() : fLRUCacheMap(INT_MAX) {}
+
+    // Evicts least recently used entries until |bytes| more fit in |budget|.
+    void makeRoom(size_t bytes, size_t budget) SK_REQUIRES(fMutex) {
+        std::unique_ptr<Entry> evicted;
+        while (fBytes + bytes > budget && fLRUCacheMap.removeLeastRecentlyUsed(&evicted)) {
+            fBytes -= evicted->fBytes;
+            ++fEvictions;
+        }
+    }
+
+    SkMutex fMutex;
+    // The byte budget, not this count, limits the entries.
+    SkLRUCache<ParagraphCacheKey, std::unique_ptr<Entry>, KeyHash> fLRUCacheMap
+            SK_GUARDED_BY(fMutex);
+    size_t fBytes SK_GUARDED_BY(fMutex) = 0;
+    uint64_t fHits SK_GUARDED_BY(fMutex) = 0;
+    uint64_t fMisses SK_GUARDED_BY(fMutex) = 0;
+    uint64_t fEvictions SK_GUARDED_BY(fMutex) = 0;
+};
+
+ParagraphCache::ParagraphCache() : ParagraphCache(kDefaultByteBudget, kDefaultShardCount) {}
+
+ParagraphCache::ParagraphCache(size_t byteBudget, int shardCount)
     : fChecker([](ParagraphImpl* impl, const char*, bool){ })
-    , fLRUCacheMap(kMaxEntries)
+    , fByteBudget(byteBudget)
+    , fShardCount(std::max(shardCount, 1))
+    , fShards(new Shard[fShardCount])
     , fCacheIsOn(true)
-    , fLastCachedValue(nullptr)
-#ifdef PARAGRAPH_CACHE_STATS
-    , fTotalRequests(0)
-    , fCacheMisses(0)
-    , fHashMisses(0)
-#endif
 { }
 
 ParagraphCache::~ParagraphCache() { }
 
+ParagraphCache::Shard& ParagraphCache::shardFor(const ParagraphCacheKey& key) const {
+    // The low bits pick the hash table slot within the shard, so use the high bits here.
+    return fShards[(key.hash() >> 16) % fShardCount];
+}
+
 void ParagraphCache::updateTo(ParagraphImpl* paragraph, const Entry* entry) {
 
     paragraph->fRuns.clear();
@@ -261,6 +312,7 @@ void ParagraphCache::updateTo(ParagraphImpl* paragraph, const Entry* entry) {
     paragraph->fCodeUnitProperties = entry->fValue->fCodeUnitProperties;
     paragraph->fWords = entry->fValue->fWords;
     paragraph->fBidiRegions = entry->fValue->fBidiRegions;
+    paragraph->fShapedBlocks = entry->fValue->fShapedBlocks;
     paragraph->fHasLineBreaks = entry->fValue->fHasLineBreaks;
     paragraph->fHasWhitespacesInside = entry->fValue->fHasWhitespacesInside;
     paragraph->fTrailingSpaces = entry->fValue->fTrailingSpaces;
@@ -272,13 +324,29 @@ void ParagraphCache::updateTo(ParagraphImpl* paragraph, const Entry* entry) {
     }
 }
 
+ParagraphCache::Stats ParagraphCache::stats() const {
+    Stats stats;
+    for (int i = 0; i < fShardCount; ++i) {
+        Shard& shard = fShards[i];
+        SkAutoMutexExclusive lock(shard.fMutex);
+        stats.fCount += shard.fLRUCacheMap.count();
+        stats.fBytes += shard.fBytes;
+        stats.fHits += shard.fHits;
+        stats.fMisses += shard.fMisses;
+        stats.fEvictions += shard.fEvictions;
+    }
+    return stats;
+}
+
 void ParagraphCache::printStatistics() {
+    const Stats stats = this->stats();
+    const uint64_t requests = stats.fHits + stats.fMisses;
     SkDebugf("--- Paragraph Cache ---\n");
-    SkDebugf("Total requests: %d\n", fTotalRequests);
-    SkDebugf("Cache misses: %d\n", fCacheMisses);
-    SkDebugf("Cache miss %%: %f\n", (fTotalRequests > 0) ? 100.f * fCacheMisses / fTotalRequests : 0.f);
-    int cacheHits = fTotalRequests - fCacheMisses;
-    SkDebugf("Hash miss %%: %f\n", (cacheHits > 0) ? 100.f * fHashMisses / cacheHits : 0.f);
+    SkDebugf("Total requests: %llu\n", (unsigned long long)requests);
+    SkDebugf("Cache misses: %llu\n", (unsigned long long)stats.fMisses);
+    SkDebugf("Cache miss %%: %f\n", (requests > 0) ? 100.f * stats.fMisses / requests : 0.f);
+    SkDebugf("Evictions: %llu\n", (unsigned long long)stats.fEvictions);
+    SkDebugf("Entries: %d (%zu of %zu bytes)\n", stats.fCount, stats.fBytes, fByteBudget);
     SkDebugf("---------------------\n");
 }
 
@@ -287,35 +355,34 @@ void ParagraphCache::abandon() {
 }
 
 void ParagraphCache::reset() {
-    SkAutoMutexExclusive lock(fParagraphMutex);
-#ifdef PARAGRAPH_CACHE_STATS
-    fTotalRequests = 0;
-    fCacheMisses = 0;
-    fHashMisses = 0;
-#endif
-    fLRUCacheMap.reset();
-    fLastCachedValue = nullptr;
+    for (int i = 0; i < fShardCount; ++i) {
+        Shard& shard = fShards[i];
+        SkAutoMutexExclusive lock(shard.fMutex);
+        shard.fLRUCacheMap.reset();
+        shard.fBytes = 0;
+        shard.fHits = 0;
+        shard.fMisses = 0;
+        shard.fEvictions = 0;
+    }
+    SkAutoMutexExclusive lock(fLastCachedTextMutex);
+    fLastCachedText.reset();
 }
 
 bool ParagraphCache::findParagraph(ParagraphImpl* paragraph) {
     if (!fCacheIsOn) {
         return false;
     }
-#ifdef PARAGRAPH_CACHE_STATS
-    ++fTotalRequests;
-#endif
-    SkAutoMutexExclusive lock(fParagraphMutex);
     ParagraphCacheKey key(paragraph);
-    std::unique_ptr<Entry>* entry = fLRUCacheMap.find(key);
-
+    Shard& shard = this->shardFor(key);
+    SkAutoMutexExclusive lock(shard.fMutex);
+    std::unique_ptr<Entry>* entry = shard.fLRUCacheMap.find(key);
     if (!entry) {
         // We have a cache miss
-#ifdef PARAGRAPH_CACHE_STATS
-        ++fCacheMisses;
-#endif
+        ++shard.fMisses;
         fChecker(paragraph, "missingParagraph", true);
         return false;
     }
+    ++shard.fHits;
     updateTo(paragraph, entry->get());
     fChecker(paragraph, "foundParagraph", true);
     return true;
@@ -325,38 +392,52 @@ bool ParagraphCache::updateParagraph(ParagraphImpl* paragraph) {
     if (!fCacheIsOn) {
         return false;
     }
-#ifdef PARAGRAPH_CACHE_STATS
-    ++fTotalRequests;
-#endif
-    SkAutoMutexExclusive lock(fParagraphMutex);
-
     ParagraphCacheKey key(paragraph);
-    std::unique_ptr<Entry>* entry = fLRUCacheMap.find(key);
-    if (!entry) {
-        // isTooMuchMemoryWasted(paragraph) not needed for now
-        if (isPossiblyTextEditing(paragraph)) {
-            // Skip this paragraph
+    Shard& shard = this->shardFor(key);
+    {
+        SkAutoMutexExclusive lock(shard.fMutex);
+        if (shard.fLRUCacheMap.find(key)) {
+            // We do not have to update the paragraph
             return false;
         }
-        ParagraphCacheValue* value = new ParagraphCacheValue(std::move(key), paragraph);
-        fLRUCacheMap.insert(value->fKey, std::make_unique<Entry>(value));
-        fChecker(paragraph, "addedParagraph", true);
-        fLastCachedValue = value;
-        return true;
-    } else {
-        // We do not have to update the paragraph
+    }
+    // isTooMuchMemoryWasted(paragraph) not needed for now
+    if (isPossiblyTextEditing(paragraph)) {
+        // Skip this paragraph
+        return false;
+    }
+    auto entry = std::make_unique<Entry>(new ParagraphCacheValue(std::move(key), paragraph));
+    const size_t shardBudget = fByteBudget / fShardCount;
+    if (entry->fBytes > shardBudget) {
         return false;
     }
+    {
+        SkAutoMutexExclusive lock(shard.fMutex);
+        // Another thread may have added the same paragraph meanwhile.
+        if (shard.fLRUCacheMap.find(entry->fValue->fKey)) {
+            return false;
+        }
+        shard.makeRoom(entry->fBytes, shardBudget);
+        shard.fBytes += entry->fBytes;
+        const ParagraphCacheKey& entryKey = entry->fValue->fKey;
+        shard.fLRUCacheMap.insert(entryKey, std::move(entry));
+    }
+    {
+        SkAutoMutexExclusive lock(fLastCachedTextMutex);
+        fLastCachedText = paragraph->fText;
+    }
+    fChecker(paragraph, "addedParagraph", true);
+    return true;
 }
 
 // Special situation: (very) long paragraph that is close to the last formatted paragraph
 #define NOCACHE_PREFIX_LENGTH 40
 bool ParagraphCache::isPossiblyTextEditing(ParagraphImpl* paragraph) {
-    if (fLastCachedValue == nullptr) {
-        return false;
+    SkString lastText;
+    {
+        SkAutoMutexExclusive lock(fLastCachedTextMutex);
+        lastText = fLastCachedText;
     }
-
-    auto& lastText = fLastCachedValue->fKey.text();
     auto& text = paragraph->fText;
 
     if ((lastText.size() < NOCACHE_PREFIX_LENGTH) || (text.size() < NOCACHE_PREFIX_LENGTH)) {
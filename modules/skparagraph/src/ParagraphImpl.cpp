@@ -21,6 +21,7 @@
 #include "modules/skparagraph/src/TextWrapper.h"
 #include "modules/skunicode/include/SkUnicode.h"
 #include "src/base/SkUTF.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/core/SkTextBlobPriv.h"
 
 #include <algorithm>
@@ -70,6 +71,22 @@ Paragraph::Paragraph(ParagraphStyle style, sk_sp<FontCollection> fonts)
     SkASSERT(fFontCollection);
 }
 
+void Paragraph::LayoutAll(SkSpan<Paragraph* const> paragraphs, SkScalar width,
+                          SkExecutor* executor) {
+    if (!executor || paragraphs.size() < 2) {
+        for (Paragraph* paragraph : paragraphs) {
+            paragraph->layout(width);
+        }
+        return;
+    }
+
+    SkTaskGroup tasks(*executor);
+    tasks.batch(SkToInt(paragraphs.size()), [&](int i) {
+        paragraphs[i]->layout(width);
+    });
+    tasks.wait();
+}
+
 ParagraphImpl::ParagraphImpl(const SkString& text,
                              ParagraphStyle style,
                              TArray<Block, true> blocks,
@@ -197,13 +214,17 @@ void ParagraphImpl::layout(SkScalar rawWidth) {
                 fFontCollection->getParagraphCache()->updateParagraph(this);
             }
         }
+        // Nothing is left to take over from before a text edit, even after a cache hit
+        fPreviousShaping.reset();
+        // The strut and the empty line metrics only depend on the styles and on whether
+        // there is any text, so a relayout at another width does not have to resolve them again
+        this->resolveStrut();
+        this->computeEmptyMetrics();
         fState = kShaped;
     }
 
     if (fState == kShaped) {
         this->resetContext();
-        this->resolveStrut();
-        this->computeEmptyMetrics();
         this->fLines.clear();
         this->breakShapedTextIntoLines(floorWidth);
         fState = kLineBroken;
@@ -554,7 +575,10 @@ void ParagraphImpl::buildClusterTable() {
 
 bool ParagraphImpl::shapeTextIntoEndlessLine() {
 
+    fShapedBlocks.clear();
+    fReusedRuns = 0;
     if (fText.size() == 0) {
+        fPreviousShaping.reset();
         return false;
     }
 
@@ -564,6 +588,7 @@ bool ParagraphImpl::shapeTextIntoEndlessLine() {
     OneLineShaper oneLineShaper(this);
     auto result = oneLineShaper.shape();
     fUnresolvedGlyphs = oneLineShaper.unresolvedGlyphs();
+    fPreviousShaping.reset();
 
     this->applySpacingAndBuildClusterTable();
 
@@ -1098,6 +1123,134 @@ void ParagraphImpl::updateTextAlign(TextAlign textAlign) {
     }
 }
 
+bool ParagraphImpl::updateText(size_t from, size_t to, const SkString& text) {
+    auto startsCodePoint = [this](size_t index) {
+        return index == fText.size() || (static_cast<uint8_t>(fText[index]) & 0xC0) != 0x80;
+    };
+    if (from > to || to > fText.size() || !startsCodePoint(from) || !startsCodePoint(to) ||
+        SkUTF::CountUTF8(text.c_str(), text.size()) < 0) {
+        return false;
+    }
+    for (auto& placeholder : fPlaceholders) {
+        if (from < placeholder.fRange.end && to > placeholder.fRange.start) {
+            return false;
+        }
+    }
+
+    // The new text takes the style of the text before it, or after it at the very start.
+    // Next to a placeholder that is the style the placeholder was added with.
+    const TextStyle* style = nullptr;
+    for (auto& block : fTextStyles) {
+        if (block.fRange.width() > 0 && (from == 0 || block.fRange.contains({from - 1, from}))) {
+            style = &block.fStyle;
+            break;
+        }
+    }
+    if (style != nullptr && style->isPlaceholder()) {
+        for (auto& placeholder : fPlaceholders) {
+            if (placeholder.fRange.end == from || placeholder.fRange.start == from) {
+                style = &placeholder.fTextStyle;
+                break;
+            }
+        }
+    }
+
+    // Only runs as they came out of the shaper can be reused, that is, without any spacing
+    bool hasSpacing = false;
+    for (auto& block : fTextStyles) {
+        if (block.fRange.width() > 0 &&
+            (!SkScalarNearlyZero(block.fStyle.getLetterSpacing()) ||
+             !SkScalarNearlyZero(block.fStyle.getWordSpacing()))) {
+            hasSpacing = true;
+        }
+    }
+    if (fState >= kShaped && !hasSpacing) {
+        auto previous = std::make_unique<PreviousShaping>();
+        previous->fText = fText;
+        previous->fCodeUnitProperties = std::move(fCodeUnitProperties);
+        previous->fRuns = std::move(fRuns);
+        previous->fShapedBlocks = std::move(fShapedBlocks);
+        fPreviousShaping = std::move(previous);
+    } else if (hasSpacing) {
+        fPreviousShaping.reset();
+    }
+
+    // Cut the styles at the edit and put the new text in between
+    const size_t end = from + text.size();
+    auto moved = [&](size_t index) { return index - to + end; };
+    TArray<Block, true> blocks;
+    auto addBlock = [&blocks](TextRange range, const TextStyle& blockStyle) {
+        if (range.width() == 0) {
+            return;
+        }
+        if (!blocks.empty() && blocks.back().fRange.end == range.start &&
+            blocks.back().fStyle.equals(blockStyle)) {
+            blocks.back().add(range);
+        } else {
+            blocks.emplace_back(range, blockStyle);
+        }
+    };
+    for (auto& block : fTextStyles) {
+        if (block.fRange.start < from) {
+            addBlock({block.fRange.start, std::min(block.fRange.end, from)}, block.fStyle);
+        }
+    }
+    if (style != nullptr) {
+        addBlock({from, end}, *style);
+    }
+    for (auto& block : fTextStyles) {
+        if (block.fRange.end > to) {
+            addBlock({moved(std::max(block.fRange.start, to)), moved(block.fRange.end)},
+                     block.fStyle);
+        }
+    }
+    fTextStyles = std::move(blocks);
+
+    // Placeholders are all before the edit or all after it
+    TextIndex textStart = 0;
+    BlockIndex blockIndex = 0;
+    BlockIndex blocksStart = 0;
+    for (auto& placeholder : fPlaceholders) {
+        if (placeholder.fRange.start >= to) {
+            placeholder.fRange = TextRange(moved(placeholder.fRange.start),
+                                           moved(placeholder.fRange.end));
+        }
+        placeholder.fTextBefore = TextRange(textStart, placeholder.fRange.start);
+        textStart = placeholder.fRange.end;
+        while (blockIndex < SkToSizeT(fTextStyles.size()) &&
+               fTextStyles[blockIndex].fRange.start < placeholder.fRange.start) {
+            ++blockIndex;
+        }
+        placeholder.fBlocksBefore = BlockRange(blocksStart, blockIndex);
+        blocksStart = blockIndex + 1;
+    }
+
+    SkString newText(fText.c_str(), from);
+    newText.append(text);
+    newText.append(fText.c_str() + to, fText.size() - to);
+    fText = std::move(newText);
+
+    // Everything else is computed from the text again at the next layout
+    fCodeUnitProperties.clear();
+    fBidiRegions.clear();
+    fWords.clear();
+    fUTF8IndexForUTF16Index.clear();
+    fUTF16IndexForUTF8Index.clear();
+    fillUTF16MappingOnce.emplace();
+    fHasLineBreaks = false;
+    fHasWhitespacesInside = false;
+    fRuns.clear();
+    fClusters.clear();
+    fClustersIndexFromCodeUnit.clear();
+    fShapedBlocks.clear();
+    fLines.clear();
+    fPicture = nullptr;
+    fState = kUnknown;
+    fOldWidth = 0;
+    fOldHeight = 0;
+    return true;
+}
+
 void ParagraphImpl::updateForegroundPaint(size_t from, size_t to, SkPaint paint) {
     SkASSERT(from == 0 && to == fText.size());
     auto defaultStyle = fParagraphStyle.getTextStyle();
@@ -1168,7 +1321,7 @@ TextIndex ParagraphImpl::findPreviousGlyphClusterBoundary(TextIndex utf8) const
 }
 
 void ParagraphImpl::ensureUTF16Mapping() {
-    fillUTF16MappingOnce([&] {
+    (*fillUTF16MappingOnce)([&] {
         SkUnicode::extractUtfConversionMapping(
                 this->text(),
                 [&](size_t index) { fUTF8IndexForUTF16Index.emplace_back(index); },
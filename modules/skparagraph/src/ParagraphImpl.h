@@ -29,6 +29,7 @@
 #include "src/core/SkTHash.h"
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -68,6 +69,21 @@ struct ResolvedFontDescriptor {
     TextIndex fTextStart;
 };
 
+// The text of one call to the shaper, what it was shaped with and the runs that came out of it.
+// A text edit keeps the runs of the blocks it does not touch (see ParagraphImpl::updateText).
+struct ShapedBlock {
+    Block fBlock;
+    skia_private::TArray<SkShaper::Feature> fFeatures;  // Relative to the start of the block
+    uint8_t fBidiLevel;
+    SkRange<size_t> fRuns;
+    SkScalar fAdvanceX;         // Where the block starts
+    SkScalar fAdvance;          // How far it moves the next block
+    size_t fUnresolvedGlyphs;
+    skia_private::TArray<TextRange, true> fUnresolvedText;
+    // Every run of the block starts a grapheme, so shaping it never looked at the text before it
+    bool fStartsGraphemes;
+};
+
 enum InternalState {
   kUnknown = 0,
   kIndexed = 1,     // Text is indexed
@@ -207,6 +223,9 @@ public:
     void updateFontSize(size_t from, size_t to, SkScalar fontSize) override;
     void updateForegroundPaint(size_t from, size_t to, SkPaint paint) override;
     void updateBackgroundPaint(size_t from, size_t to, SkPaint paint) override;
+    bool updateText(size_t from, size_t to, const SkString& text) override;
+    // How many runs the last shaping took over from before a text edit
+    size_t reusedRuns_ForTesting() const { return fReusedRuns; }
 
     void visit(const Visitor&) override;
     void extendedVisit(const ExtendedVisitor&) override;
@@ -257,6 +276,14 @@ private:
 
     void computeEmptyMetrics();
 
+    // The shaping results from before a text edit, for the next shaping to take what it can from
+    struct PreviousShaping {
+        SkString fText;
+        skia_private::TArray<SkUnicode::CodeUnitFlags, true> fCodeUnitProperties;
+        skia_private::TArray<Run, false> fRuns;
+        skia_private::TArray<ShapedBlock> fShapedBlocks;
+    };
+
     // Input
     skia_private::TArray<StyleBlock<SkScalar>> fLetterSpaceStyles;
     skia_private::TArray<StyleBlock<SkScalar>> fWordSpaceStyles;
@@ -280,7 +307,8 @@ private:
     // They are filled lazily whenever they need and cached
     skia_private::TArray<TextIndex, true> fUTF8IndexForUTF16Index;
     skia_private::TArray<size_t, true> fUTF16IndexForUTF8Index;
-    SkOnce fillUTF16MappingOnce;
+    // Emplaced again when the text changes
+    std::optional<SkOnce> fillUTF16MappingOnce{std::in_place};
     size_t fUnresolvedGlyphs;
     std::unordered_set<SkUnichar> fUnresolvedCodepoints;
 
@@ -288,6 +316,9 @@ private:
     sk_sp<SkPicture> fPicture;          // kRecorded    (cached: text styles)
 
     skia_private::TArray<ResolvedFontDescriptor> fFontSwitches;
+    skia_private::TArray<ShapedBlock> fShapedBlocks;            // kShaped
+    std::unique_ptr<PreviousShaping> fPreviousShaping;
+    size_t fReusedRuns = 0;
 
     InternalLineMetrics fEmptyMetrics;
     InternalLineMetrics fStrutMetrics;
@@ -7,6 +7,7 @@
 #include "include/core/SkBitmap.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColor.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkFontMgr.h"
 #include "include/core/SkFontStyle.h"
 #include "include/core/SkPaint.h"
@@ -5483,6 +5484,209 @@ UNIX_ONLY_TEST(SkParagraph_CacheText, reporter) {
     test("text3", 2, false);
 }
 
+UNIX_ONLY_TEST(SkParagraph_RelayoutAtNewWidth, reporter) {
+    sk_sp<ResourceFontCollection> fontCollection = sk_make_sp<ResourceFontCollection>();
+    SKIP_IF_FONTS_NOT_FOUND(reporter, fontCollection)
+    fontCollection->getParagraphCache()->turnOn(false);
+
+    ParagraphStyle paragraph_style;
+    paragraph_style.turnHintingOff();
+    StrutStyle strut_style;
+    strut_style.setStrutEnabled(true);
+    strut_style.setFontFamilies({SkString("Roboto")});
+    strut_style.setFontSize(20);
+    paragraph_style.setStrutStyle(strut_style);
+    TextStyle text_style;
+    text_style.setFontFamilies({SkString("Roboto")});
+    text_style.setFontSize(14);
+    text_style.setColor(SK_ColorBLACK);
+
+    auto build = [&]() {
+        ParagraphBuilderImpl builder(paragraph_style, fontCollection, get_unicode());
+        builder.pushStyle(text_style);
+        builder.addText("The quick brown fox jumps over the lazy dog.\n\nAnd then again.");
+        builder.pop();
+        return builder.Build();
+    };
+
+    // Relayout only breaks the shaped text into lines again; the result must be the same as
+    // laying out a new paragraph at that width.
+    auto paragraph = build();
+    for (SkScalar width : {300.f, 60.f, 1000.f, 120.f}) {
+        paragraph->layout(width);
+        auto fresh = build();
+        fresh->layout(width);
+        REPORTER_ASSERT(reporter, paragraph->lineNumber() == fresh->lineNumber());
+        REPORTER_ASSERT(reporter, paragraph->getHeight() == fresh->getHeight());
+        REPORTER_ASSERT(reporter, paragraph->getLongestLine() == fresh->getLongestLine());
+        REPORTER_ASSERT(reporter,
+                        paragraph->getAlphabeticBaseline() == fresh->getAlphabeticBaseline());
+    }
+}
+
+UNIX_ONLY_TEST(SkParagraph_UpdateText, reporter) {
+    sk_sp<ResourceFontCollection> fontCollection = sk_make_sp<ResourceFontCollection>();
+    SKIP_IF_FONTS_NOT_FOUND(reporter, fontCollection)
+    fontCollection->getParagraphCache()->turnOn(false);
+
+    ParagraphStyle paragraph_style;
+    paragraph_style.turnHintingOff();
+    TextStyle text_style;
+    text_style.setFontFamilies({SkString("Roboto")});
+    text_style.setFontSize(20);
+    text_style.setColor(SK_ColorBLACK);
+    TextStyle big_style(text_style);
+    big_style.setFontSize(24);
+
+    // Every other piece of text is big, so that each piece is shaped on its own
+    auto build = [&](std::vector<const char*> texts) {
+        ParagraphBuilderImpl builder(paragraph_style, fontCollection, get_unicode());
+        for (size_t i = 0; i < texts.size(); ++i) {
+            builder.pushStyle(i % 2 ? big_style : text_style);
+            builder.addText(texts[i]);
+            builder.pop();
+        }
+        return builder.Build();
+    };
+
+    // An edited paragraph has to come out the same as one built with the edited text
+    auto check = [&](Paragraph* paragraph, std::vector<const char*> texts) {
+        auto fresh = build(texts);
+        paragraph->layout(150);
+        fresh->layout(150);
+        auto impl = static_cast<ParagraphImpl*>(paragraph);
+        auto freshImpl = static_cast<ParagraphImpl*>(fresh.get());
+        REPORTER_ASSERT(reporter, impl->text().size() == freshImpl->text().size());
+        REPORTER_ASSERT(reporter, !memcmp(impl->text().data(), freshImpl->text().data(),
+                                          impl->text().size()));
+        REPORTER_ASSERT(reporter, impl->runs().size() == freshImpl->runs().size());
+        for (size_t i = 0; i < std::min(impl->runs().size(), freshImpl->runs().size()); ++i) {
+            const Run& run = impl->runs()[i];
+            const Run& freshRun = freshImpl->runs()[i];
+            REPORTER_ASSERT(reporter, run.textRange() == freshRun.textRange(), "run %zu", i);
+            REPORTER_ASSERT(reporter, run.size() == freshRun.size(), "run %zu", i);
+            if (run.size() != freshRun.size()) {
+                continue;
+            }
+            for (size_t g = 0; g < run.size(); ++g) {
+                REPORTER_ASSERT(reporter, run.glyphs()[g] == freshRun.glyphs()[g]);
+                REPORTER_ASSERT(reporter, SkScalarNearlyEqual(run.positions()[g].fX,
+                                                              freshRun.positions()[g].fX));
+            }
+        }
+        REPORTER_ASSERT(reporter, paragraph->lineNumber() == fresh->lineNumber());
+        REPORTER_ASSERT(reporter, SkScalarNearlyEqual(paragraph->getHeight(), fresh->getHeight()));
+        REPORTER_ASSERT(reporter, SkScalarNearlyEqual(paragraph->getMaxIntrinsicWidth(),
+                                                      fresh->getMaxIntrinsicWidth()));
+        return impl->reusedRuns_ForTesting();
+    };
+
+    auto paragraph = build({"The quick brown fox ", "jumps over", " the lazy dog."});
+    paragraph->layout(150);
+
+    // Only the text of the first style is shaped again
+    REPORTER_ASSERT(reporter, paragraph->updateText(4, 9, SkString("slow")));
+    REPORTER_ASSERT(reporter,
+                    check(paragraph.get(), {"The slow brown fox ", "jumps over", " the lazy dog."})
+                    == 2);
+
+    // Text added at the end of a style takes that style
+    REPORTER_ASSERT(reporter, paragraph->updateText(29, 29, SkString(" and under")));
+    REPORTER_ASSERT(reporter,
+                    check(paragraph.get(),
+                          {"The slow brown fox ", "jumps over and under", " the lazy dog."})
+                    == 2);
+
+    // Deleting across styles keeps what is left of both, which is shaped again
+    REPORTER_ASSERT(reporter, paragraph->updateText(9, 33, SkString("ran")));
+    REPORTER_ASSERT(reporter,
+                    check(paragraph.get(), {"The slow ran", " under", " the lazy dog."}) == 1);
+
+    // Edits add up until the next layout
+    REPORTER_ASSERT(reporter, paragraph->updateText(0, 0, SkString("So ")));
+    REPORTER_ASSERT(reporter, paragraph->updateText(31, 35, SkString("cat!")));
+    REPORTER_ASSERT(reporter,
+                    check(paragraph.get(), {"So The slow ran", " under", " the lazy cat!"}) == 1);
+
+    // The range has to be on code points
+    auto utf8 = build({"caf\u00e9", " au lait"});
+    utf8->layout(150);
+    REPORTER_ASSERT(reporter, !utf8->updateText(4, 5, SkString("e")));
+    REPORTER_ASSERT(reporter, !utf8->updateText(0, 100, SkString()));
+    REPORTER_ASSERT(reporter, utf8->updateText(3, 5, SkString("e")));
+    REPORTER_ASSERT(reporter, check(utf8.get(), {"cafe", " au lait"}) == 1);
+
+    // Placeholders cannot be edited, but the text next to them can
+    ParagraphBuilderImpl builder(paragraph_style, fontCollection, get_unicode());
+    builder.pushStyle(text_style);
+    builder.addText("Before ");
+    builder.addPlaceholder(PlaceholderStyle(20, 20, PlaceholderAlignment::kBaseline,
+                                            TextBaseline::kAlphabetic, 0));
+    builder.addText(" after");
+    builder.pop();
+    auto withPlaceholder = builder.Build();
+    withPlaceholder->layout(150);
+    REPORTER_ASSERT(reporter, !withPlaceholder->updateText(6, 8, SkString()));
+    REPORTER_ASSERT(reporter, withPlaceholder->updateText(10, 10, SkString("wards")));
+    withPlaceholder->layout(150);
+    REPORTER_ASSERT(reporter, withPlaceholder->getRectsForPlaceholders().size() == 1);
+    auto impl = static_cast<ParagraphImpl*>(withPlaceholder.get());
+    REPORTER_ASSERT(reporter, impl->placeholders().back().fRange == TextRange(21, 21));
+    REPORTER_ASSERT(reporter, impl->reusedRuns_ForTesting() == 1);
+}
+
+UNIX_ONLY_TEST(SkParagraph_CacheByteBudget, reporter) {
+    sk_sp<ResourceFontCollection> fontCollection = sk_make_sp<ResourceFontCollection>();
+    SKIP_IF_FONTS_NOT_FOUND(reporter, fontCollection)
+    // Enough for a few of the paragraphs below, spread over two shards.
+    auto cache = sk_make_sp<ParagraphCache>(16 * 1024, 2);
+    fontCollection->setParagraphCache(cache);
+
+    ParagraphStyle paragraph_style;
+    paragraph_style.turnHintingOff();
+    TextStyle text_style;
+    text_style.setFontFamilies({SkString("Roboto")});
+    text_style.setColor(SK_ColorBLACK);
+
+    auto layout = [&](const SkString& text) {
+        ParagraphBuilderImpl builder(paragraph_style, fontCollection, get_unicode());
+        builder.pushStyle(text_style);
+        builder.addText(text.c_str(), text.size());
+        builder.pop();
+        auto paragraph = builder.Build();
+        paragraph->layout(TestCanvasWidth);
+    };
+
+    for (int i = 0; i < 50; ++i) {
+        layout(SkStringPrintf("%d: short text", i));
+        const auto stats = cache->stats();
+        REPORTER_ASSERT(reporter, stats.fBytes <= cache->byteBudget());
+        REPORTER_ASSERT(reporter, stats.fCount == cache->count());
+    }
+    auto stats = cache->stats();
+    REPORTER_ASSERT(reporter, stats.fMisses == 50 && stats.fHits == 0);
+    REPORTER_ASSERT(reporter, stats.fEvictions > 0 && stats.fCount < 50);
+
+    // Another collection resolving families the same way can use what the first one shaped,
+    // and laying out again at another width does not shape again.
+    sk_sp<ResourceFontCollection> other = sk_make_sp<ResourceFontCollection>();
+    other->setParagraphCache(cache);
+    {
+        ParagraphBuilderImpl builder(paragraph_style, other, get_unicode());
+        builder.pushStyle(text_style);
+        builder.addText("49: short text");
+        builder.pop();
+        auto paragraph = builder.Build();
+        paragraph->layout(TestCanvasWidth);
+        paragraph->layout(TestCanvasWidth / 2);
+    }
+    REPORTER_ASSERT(reporter, cache->stats().fHits == 1);
+
+    cache->reset();
+    stats = cache->stats();
+    REPORTER_ASSERT(reporter, stats.fCount == 0 && stats.fBytes == 0 && stats.fMisses == 0);
+}
+
 UNIX_ONLY_TEST(SkParagraph_CacheFonts, reporter) {
     ParagraphCache cache;
     cache.turnOn(true);
@@ -8481,3 +8685,50 @@ UNIX_ONLY_TEST(SkParagraph_ICU4X_EmojiRuns, reporter) {
     SkUnicode_Emoji(SkUnicodes::ICU4X::Make(), reporter);
 }
 #endif
+
+UNIX_ONLY_TEST(SkParagraph_LayoutAll, reporter) {
+    sk_sp<ResourceFontCollection> fontCollection = sk_make_sp<ResourceFontCollection>();
+    SKIP_IF_FONTS_NOT_FOUND(reporter, fontCollection)
+    // Shape every paragraph, so they all resolve typefaces through the shared collection.
+    fontCollection->getParagraphCache()->turnOn(false);
+
+    ParagraphStyle paragraph_style;
+    paragraph_style.turnHintingOff();
+    TextStyle text_style;
+    text_style.setFontFamilies({SkString("Roboto")});
+    text_style.setFontSize(20);
+    text_style.setColor(SK_ColorBLACK);
+
+    auto make = [&](int i) {
+        ParagraphBuilderImpl builder(paragraph_style, fontCollection, get_unicode());
+        builder.pushStyle(text_style);
+        SkString text;
+        text.printf("Paragraph %d: the quick brown fox jumps over the lazy dog %d times, "
+                    "then wraps onto more lines.", i, i * 7);
+        builder.addText(text.c_str(), text.size());
+        builder.pop();
+        return builder.Build();
+    };
+
+    static constexpr int kParagraphs = 32;
+    std::vector<std::unique_ptr<Paragraph>> expected, actual;
+    std::vector<Paragraph*> batch;
+    for (int i = 0; i < kParagraphs; ++i) {
+        expected.push_back(make(i));
+        expected.back()->layout(200);
+        actual.push_back(make(i));
+        batch.push_back(actual.back().get());
+    }
+
+    fontCollection->clearCaches();
+    auto executor = SkExecutor::MakeFIFOThreadPool(4);
+    Paragraph::LayoutAll(batch, 200, executor.get());
+
+    for (int i = 0; i < kParagraphs; ++i) {
+        REPORTER_ASSERT(reporter, actual[i]->getHeight() == expected[i]->getHeight(), "%d", i);
+        REPORTER_ASSERT(reporter, actual[i]->lineNumber() == expected[i]->lineNumber(), "%d", i);
+        REPORTER_ASSERT(reporter,
+                        actual[i]->getLongestLine() == expected[i]->getLongestLine(), "%d", i);
+        REPORTER_ASSERT(reporter, actual[i]->unresolvedGlyphs() == 0, "%d", i);
+    }
+}
@@ -65,11 +65,26 @@ void Editor::setFontMgr(sk_sp<SkFontMgr> fontMgr) {
     for (auto& l : fLines) { this->markDirty(&l); }
 }
 
+// The x position after the last glyph, if the line was shaped into a single row.
+static float unwrapped_width(const std::vector<SkRect>& cursorPos) {
+    return cursorPos.empty() ? 0 : cursorPos.back().left();
+}
+
 void Editor::setWidth(int w) {
     if (fWidth != w) {
         fWidth = w;
-        fNeedsReshape = true;
-        for (auto& l : fLines) { this->markDirty(&l); }
+        if (fLines.empty()) {
+            fNeedsReshape = true;
+        }
+        for (auto& l : fLines) {
+            // A line that was not wrapped and still fits is shaped the same way at the new width,
+            // so resizing only reshapes the lines that wrap (or did).
+            if (!l.fShaped || !l.fLineEndOffsets.empty() ||
+                unwrapped_width(l.fCursorPos) > (float)w) {
+                this->markDirty(&l);
+                fNeedsReshape = true;
+            }
+        }
     }
 }
 static SkPoint to_point(SkIPoint p) { return {(float)p.x(), (float)p.y()}; }
@@ -18,10 +18,12 @@
 #include "include/private/base/SkMutex.h"
 #include "src/core/SkTHash.h"
 
+#include <cstddef>
 #include <memory>
 
 class SkAnimCodecPlayer;
 class SkCodec;
+class SkExecutor;
 class SkImage;
 
 namespace skresources {
@@ -260,6 +262,69 @@ private:
     using INHERITED = ResourceProviderProxyBase;
 };
 
+/**
+ * Loads and decodes image assets ahead of time, on an SkExecutor, so that the first frames of
+ * image-heavy animations don't stall on loading and decoding them.
+ *
+ * prefetchImageAsset() starts loading an asset (typically every asset an animation declares,
+ * before building it), and loadImageAsset() returns prefetched assets, waiting for them if they
+ * are still loading. Like CachingResourceProvider, assets are shared by resource id.
+ *
+ * Static images are decoded once loaded. Multi-frame images decode their upcoming frames in the
+ * background as they are played, predicting frame times from the last two requests.
+ *
+ * Decoded pixels held by the provider count against a budget. Static images that don't fit are
+ * left as the wrapped provider returned them (typically decoded when drawn), and frames that don't
+ * fit are not decoded ahead.
+ */
+class SK_API PrefetchingResourceProvider final : public ResourceProviderProxyBase {
+public:
+    struct Options {
+        // Runs the loads and decodes. If null, SkExecutor::GetDefault() is used. The executor
+        // must outlive the provider and the assets it returns.
+        SkExecutor* fExecutor = nullptr;
+        // Limit on decoded pixel bytes held by the provider's assets.
+        size_t      fDecodedBudget = 128 * 1024 * 1024;
+        // How many upcoming frames of multi-frame images to decode ahead.
+        int         fLookaheadFrames = 4;
+    };
+
+    static sk_sp<PrefetchingResourceProvider> Make(sk_sp<ResourceProvider>, const Options&);
+
+    ~PrefetchingResourceProvider() override;
+
+    /**
+     * Starts loading and decoding the image asset specified by |path| + |name| + |id|.
+     */
+    void prefetchImageAsset(const char resource_path[],
+                            const char resource_name[],
+                            const char resource_id[]);
+
+    /**
+     * Returns the decoded pixel bytes currently held for the provider's assets.
+     */
+    size_t decodedBytes() const;
+
+private:
+    class Asset;
+    class Budget;
+
+    PrefetchingResourceProvider(sk_sp<ResourceProvider>, const Options&);
+
+    sk_sp<ImageAsset> loadImageAsset(const char[], const char[], const char[]) const override;
+
+    sk_sp<Asset> findOrMakeAsset(const char[], const char[], const char[], bool* made) const;
+
+    SkExecutor&         fExecutor;
+    const int           fLookaheadFrames;
+    const sk_sp<Budget> fBudget;
+
+    mutable SkMutex                                        fMutex;
+    mutable skia_private::THashMap<SkString, sk_sp<Asset>> fAssets;
+
+    using INHERITED = ResourceProviderProxyBase;
+};
+
 class SK_API DataURIResourceProviderProxy final : public ResourceProviderProxyBase {
 public:
     // If font data is supplied via base64 encoding, this needs a provided SkFontMgr to process
@@ -10,15 +10,21 @@
 #include "include/codec/SkCodec.h"
 #include "include/core/SkBitmap.h"
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkFontMgr.h"
 #include "include/core/SkImage.h"
+#include "include/core/SkImageInfo.h"
 #include "include/private/base/SkTPin.h"
 #include "modules/skresources/src/SkAnimCodecPlayer.h"
 #include "src/base/SkBase64.h"
 #include "src/core/SkOSFile.h"
 #include "src/utils/SkOSPath.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <map>
+#include <utility>
 
 #if defined(HAVE_VIDEO_DECODER)
     #include "experimental/ffmpeg/SkVideoDecoder.h"
@@ -269,6 +275,250 @@ sk_sp<ImageAsset> CachingResourceProvider::loadImageAsset(const char resource_pa
     return asset;
 }
 
+class PrefetchingResourceProvider::Budget final : public SkNVRefCnt<Budget> {
+public:
+    explicit Budget(size_t limit) : fLimit(limit) {}
+
+    bool reserve(size_t bytes) {
+        size_t used = fUsed.load(std::memory_order_relaxed);
+        do {
+            if (used > fLimit || bytes > fLimit - used) {
+                return false;
+            }
+        } while (!fUsed.compare_exchange_weak(used, used + bytes, std::memory_order_relaxed));
+        return true;
+    }
+
+    void release(size_t bytes) {
+        fUsed.fetch_sub(bytes, std::memory_order_relaxed);
+    }
+
+    size_t used() const { return fUsed.load(std::memory_order_relaxed); }
+
+private:
+    const size_t        fLimit;
+    std::atomic<size_t> fUsed = 0;
+};
+
+// Wraps the asset from the proxied provider. The wrapped asset isn't thread safe, so it is only
+// used while holding fMutex, by whichever thread needs it: prefetch and lookahead tasks, or the
+// thread rendering the animation.
+class PrefetchingResourceProvider::Asset final : public ImageAsset {
+public:
+    Asset(sk_sp<ResourceProvider> proxy, const char path[], const char name[], const char id[],
+          SkExecutor& executor, int lookahead, sk_sp<Budget> budget)
+        : fProxy(std::move(proxy))
+        , fPath(path)
+        , fName(name)
+        , fId(id)
+        , fExecutor(executor)
+        , fLookahead(lookahead)
+        , fBudget(std::move(budget)) {}
+
+    ~Asset() override {
+        fBudget->release(fStaticBytes);
+        for (const auto& [ms, frame] : fFrames) {
+            fBudget->release(frame.bytes);
+        }
+    }
+
+    // Loads the wrapped asset, and decodes it if it is static. Returns false if there is none.
+    bool load() {
+        SkAutoMutexExclusive lock(fMutex);
+        return this->loadLocked();
+    }
+
+    bool isMultiFrame() override {
+        SkAutoMutexExclusive lock(fMutex);
+        this->loadLocked();
+        return fMultiFrame;
+    }
+
+    FrameData getFrameData(float t) override {
+        SkAutoMutexExclusive lock(fMutex);
+        if (!this->loadLocked()) {
+            return {};
+        }
+        if (!fMultiFrame) {
+            return fStatic;
+        }
+
+        // Frames are keyed by milliseconds, the resolution of SkAnimCodecPlayer.
+        const uint32_t ms = static_cast<uint32_t>(std::max(t, 0.0f) * 1000);
+        if (fHasLast && ms > fLastMs) {
+            fStepMs = ms - fLastMs;
+        }
+        fHasLast = true;
+        fLastMs  = ms;
+
+        // Frames decoded ahead that have been played, or skipped, won't be needed again.
+        while (!fFrames.empty() && fFrames.begin()->first < ms) {
+            fBudget->release(fFrames.begin()->second.bytes);
+            fFrames.erase(fFrames.begin());
+        }
+
+        FrameData frame;
+        if (const auto it = fFrames.find(ms); it != fFrames.end()) {
+            frame = it->second.data;
+        } else {
+            frame = fInner->getFrameData(t);
+        }
+
+        if (fStepMs > 0 && fLookahead > 0 && !fLookaheadPending) {
+            fLookaheadPending = true;
+            fExecutor.add([self = sk_ref_sp(this)] { self->lookahead(); });
+        }
+
+        return frame;
+    }
+
+private:
+    struct Frame {
+        FrameData data;
+        size_t    bytes;
+    };
+
+    bool loadLocked() {
+        if (fProxy) {
+            fInner = fProxy->loadImageAsset(fPath.c_str(), fName.c_str(), fId.c_str());
+            fProxy = nullptr;
+            if (fInner) {
+                fMultiFrame = fInner->isMultiFrame();
+                if (!fMultiFrame) {
+                    fStatic = fInner->getFrameData(0);
+                    fStatic.image = this->decode(std::move(fStatic.image), &fStaticBytes);
+                }
+            }
+        }
+        return fInner != nullptr;
+    }
+
+    // Returns the image decoded, if it fits in the budget, and sets |bytes| to its size.
+    // Otherwise returns it as it was, and sets |bytes| to 0.
+    sk_sp<SkImage> decode(sk_sp<SkImage> image, size_t* bytes) {
+        *bytes = 0;
+        if (!image) {
+            return nullptr;
+        }
+        const size_t size = image->imageInfo().computeMinByteSize();
+        if (!fBudget->reserve(size)) {
+            return image;
+        }
+        if (image->isLazyGenerated()) {
+            sk_sp<SkImage> raster = image->makeRasterImage();
+            if (!raster) {
+                fBudget->release(size);
+                return image;
+            }
+            image = std::move(raster);
+        }
+        *bytes = size;
+        return image;
+    }
+
+    // Decodes upcoming frames, at the last requested time plus multiples of the last step.
+    void lookahead() {
+        for (int i = 1; i <= fLookahead; ++i) {
+            // Only one frame is decoded at a time, so the thread rendering the animation waits at
+            // most that long for the lock.
+            SkAutoMutexExclusive lock(fMutex);
+            const uint32_t ms = fLastMs + i * fStepMs;
+            if (fFrames.find(ms) != fFrames.end()) {
+                continue;
+            }
+            FrameData data = fInner->getFrameData(ms * 0.001f);
+            size_t bytes;
+            data.image = this->decode(std::move(data.image), &bytes);
+            if (!bytes) {
+                // Out of budget (or the frame failed to decode).
+                break;
+            }
+            fFrames[ms] = {std::move(data), bytes};
+        }
+
+        SkAutoMutexExclusive lock(fMutex);
+        fLookaheadPending = false;
+    }
+
+    sk_sp<ResourceProvider> fProxy;  // Until the asset is loaded.
+    const SkString          fPath,
+                            fName,
+                            fId;
+    SkExecutor&             fExecutor;
+    const int               fLookahead;
+    const sk_sp<Budget>     fBudget;
+
+    SkMutex                   fMutex;
+    sk_sp<ImageAsset>         fInner;
+    bool                      fMultiFrame = false;
+    FrameData                 fStatic;
+    size_t                    fStaticBytes = 0;
+    std::map<uint32_t, Frame> fFrames;  // Decoded upcoming frames, by time in ms.
+    uint32_t                  fLastMs = 0,
+                              fStepMs = 0;
+    bool                      fHasLast = false,
+                              fLookaheadPending = false;
+};
+
+sk_sp<PrefetchingResourceProvider> PrefetchingResourceProvider::Make(sk_sp<ResourceProvider> rp,
+                                                                     const Options& options) {
+    return rp ? sk_sp<PrefetchingResourceProvider>(
+                        new PrefetchingResourceProvider(std::move(rp), options))
+              : nullptr;
+}
+
+PrefetchingResourceProvider::PrefetchingResourceProvider(sk_sp<ResourceProvider> rp,
+                                                         const Options& options)
+        : INHERITED(std::move(rp))
+        , fExecutor(options.fExecutor ? *options.fExecutor : SkExecutor::GetDefault())
+        , fLookaheadFrames(std::max(options.fLookaheadFrames, 0))
+        , fBudget(sk_make_sp<Budget>(options.fDecodedBudget)) {}
+
+PrefetchingResourceProvider::~PrefetchingResourceProvider() = default;
+
+sk_sp<PrefetchingResourceProvider::Asset> PrefetchingResourceProvider::findOrMakeAsset(
+        const char resource_path[], const char resource_name[], const char resource_id[],
+        bool* made) const {
+    SkAutoMutexExclusive amx(fMutex);
+
+    const SkString key(resource_id);
+    if (const auto* asset = fAssets.find(key)) {
+        *made = false;
+        return *asset;
+    }
+
+    auto asset = sk_make_sp<Asset>(fProxy, resource_path, resource_name, resource_id,
+                                   fExecutor, fLookaheadFrames, fBudget);
+    fAssets.set(key, asset);
+    *made = true;
+
+    return asset;
+}
+
+void PrefetchingResourceProvider::prefetchImageAsset(const char resource_path[],
+                                                     const char resource_name[],
+                                                     const char resource_id[]) {
+    bool made;
+    auto asset = this->findOrMakeAsset(resource_path, resource_name, resource_id, &made);
+    if (made) {
+        fExecutor.add([asset = std::move(asset)] { asset->load(); });
+    }
+}
+
+sk_sp<ImageAsset> PrefetchingResourceProvider::loadImageAsset(const char resource_path[],
+                                                              const char resource_name[],
+                                                              const char resource_id[]) const {
+    bool made;
+    auto asset = this->findOrMakeAsset(resource_path, resource_name, resource_id, &made);
+
+    // Waits for the asset if it is being prefetched.
+    return asset->load() ? std::move(asset) : nullptr;
+}
+
+size_t PrefetchingResourceProvider::decodedBytes() const {
+    return fBudget->used();
+}
+
 sk_sp<DataURIResourceProviderProxy> DataURIResourceProviderProxy::Make(sk_sp<ResourceProvider> rp,
                                                                        ImageDecodeStrategy strat,
                                                                        sk_sp<const SkFontMgr> mgr) {
@@ -0,0 +1,91 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkSGCacheEffect_DEFINED
+#define SkSGCacheEffect_DEFINED
+
+#include "include/core/SkImage.h"
+#include "include/core/SkMatrix.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkRefCnt.h"
+#include "modules/sksg/include/SkSGEffectNode.h"
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+class SkCanvas;
+
+namespace sksg {
+class InvalidationController;
+
+/**
+ * Caches its child as a raster image (or a GPU texture, when rendering to a GPU canvas).
+ *
+ * The child is rasterized in device space, once it has been rendered kPromoteAfter consecutive
+ * times with the same scale, skew and subpixel translation, and the image is then drawn in its
+ * place until the child is invalidated or the transformation changes.  Drawing the image behaves
+ * like rendering the child in an isolation layer.
+ *
+ * Images count against a Budget, which can be shared by many cache nodes.  Nodes which would
+ * exceed it render their child directly.
+ */
+class CacheEffect final : public EffectNode {
+public:
+    class Budget final : public SkNVRefCnt<Budget> {
+    public:
+        explicit Budget(size_t bytes) : fLimit(bytes) {}
+
+        size_t limit()     const { return fLimit; }
+        size_t bytesUsed() const { return fUsed.load(std::memory_order_relaxed); }
+
+    private:
+        friend class CacheEffect;
+
+        bool reserve(size_t bytes);
+        void release(size_t bytes);
+
+        const size_t        fLimit;
+        std::atomic<size_t> fUsed = 0;
+    };
+
+    static constexpr int kPromoteAfter = 2;
+
+    static sk_sp<CacheEffect> Make(sk_sp<RenderNode> child, sk_sp<Budget> budget) {
+        return child && budget
+                ? sk_sp<CacheEffect>(new CacheEffect(std::move(child), std::move(budget)))
+                : nullptr;
+    }
+
+    ~CacheEffect() override;
+
+    bool hasCachedImage() const { return fImage != nullptr; }
+
+protected:
+    void onRender(SkCanvas*, const RenderContext*) const override;
+
+    SkRect onRevalidate(InvalidationController*, const SkMatrix&) override;
+
+private:
+    CacheEffect(sk_sp<RenderNode>, sk_sp<Budget>);
+
+    void purge() const;
+
+    const sk_sp<Budget> fBudget;
+
+    // Rendering is const, but updates the cache.
+    mutable sk_sp<SkImage> fImage;
+    mutable SkIRect        fImageBounds = SkIRect::MakeEmpty();  // in device space, less fMatrix
+    mutable SkMatrix       fMatrix;  // the device transformation, less its whole-pixel translation
+    mutable int            fUses = 0;
+
+    using INHERITED = EffectNode;
+};
+
+} // namespace sksg
+
+#endif // SkSGCacheEffect_DEFINED
@@ -30,6 +30,8 @@ class InvalidationController;
  * Note: egress edges are only implemented/supported in container subclasses
  * (e.g. Group, Effect, Draw).
  */
+class InvalidationList;
+
 class Node : public SkRefCnt {
 public:
     // Traverse the DAG and revalidate any dependant/invalidated nodes.
@@ -90,12 +92,43 @@ private:
     uint32_t                fNodeFlags   :  8; // Accessible from select subclasses.
     // Free bits                         : 18;
 
+    friend class InvalidationList;
     friend class NodePriv;
     friend class RenderNode; // node flags access
 
     using INHERITED = SkRefCnt;
 };
 
+/**
+ * Collects invalidations instead of propagating them to observers, so that nodes in separate
+ * parts of a scene graph can be updated on different threads.  Each thread collects into its own
+ * list with an AutoDeferInvalidation, then apply() propagates them from one thread, when nothing
+ * else is updating or traversing the graph.
+ */
+class InvalidationList {
+public:
+    void apply();
+
+private:
+    friend class Node;
+
+    struct Invalidation {
+        sk_sp<Node> fNode;  // kept alive until applied
+        bool        fDamage;
+    };
+    std::vector<Invalidation> fInvalidations;
+};
+
+// While alive, invalidate() on the calling thread only appends to |list|.
+class AutoDeferInvalidation {
+public:
+    explicit AutoDeferInvalidation(InvalidationList* list);
+    ~AutoDeferInvalidation();
+
+private:
+    InvalidationList* fPrev;
+};
+
 // Helper for defining attribute getters/setters in subclasses.
 #define SG_ATTRIBUTE(attr_name, attr_type, attr_container)             \
     const attr_type& get##attr_name() const { return attr_container; } \
@@ -39,6 +39,10 @@ public:
     // Render the node and its descendants to the canvas.
     void render(SkCanvas*, const RenderContext* = nullptr) const;
 
+    // Render the node, skipping descendants which fall outside the canvas clip.  Useful when
+    // only a damaged area needs to be redrawn.
+    void renderClipped(SkCanvas*) const;
+
     // Perform a front-to-back hit-test, and return the RenderNode located at |point|.
     // Normally, hit-testing stops at leaf Draw nodes.
     const RenderNode* nodeAt(const SkPoint& point) const;
@@ -65,6 +69,8 @@ protected:
         SkMatrix             fShaderCTM = SkMatrix::I(),
                              fMaskCTM   = SkMatrix::I();
         float                fOpacity   = 1;
+        // Skip nodes whose bounds are rejected by the canvas clip.
+        bool                 fCullToClip = false;
 
         // Returns true if the paint overrides require a layer when applied to non-atomic draws.
         bool requiresIsolation() const;
@@ -0,0 +1,150 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "modules/sksg/include/SkSGCacheEffect.h"
+
+#include "include/core/SkCanvas.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkSamplingOptions.h"
+#include "include/core/SkSurface.h"
+#include "include/core/SkSurfaceProps.h"
+#include "include/private/base/SkAssert.h"
+
+#include <cmath>
+
+namespace sksg {
+
+namespace {
+
+// Past this, float translations can't hold a fraction of a pixel.
+static constexpr float kMaxTranslate = 1 << 24;
+
+} // namespace
+
+bool CacheEffect::Budget::reserve(size_t bytes) {
+    size_t used = fUsed.load(std::memory_order_relaxed);
+    do {
+        if (bytes > fLimit - used) {
+            return false;
+        }
+    } while (!fUsed.compare_exchange_weak(used, used + bytes, std::memory_order_relaxed));
+
+    return true;
+}
+
+void CacheEffect::Budget::release(size_t bytes) {
+    SkASSERT(bytes <= this->bytesUsed());
+    fUsed.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+CacheEffect::CacheEffect(sk_sp<RenderNode> child, sk_sp<Budget> budget)
+    : INHERITED(std::move(child))
+    , fBudget(std::move(budget))
+    , fMatrix(SkMatrix::I()) {}
+
+CacheEffect::~CacheEffect() {
+    this->purge();
+}
+
+void CacheEffect::purge() const {
+    if (fImage) {
+        fBudget->release(fImage->imageInfo().computeMinByteSize());
+        fImage.reset();
+    }
+}
+
+void CacheEffect::onRender(SkCanvas* canvas, const RenderContext* ctx) const {
+    // Shader overrides apply to the individual child draws, and cannot be baked into the image.
+    if (ctx && (ctx->fShader || ctx->fMaskShader)) {
+        this->INHERITED::onRender(canvas, ctx);
+        return;
+    }
+
+    const auto ctm = canvas->getLocalToDeviceAs3x3();
+    const auto tx = ctm.getTranslateX(),
+               ty = ctm.getTranslateY();
+    if (ctm.hasPerspective() || !ctm.isFinite() ||
+        !(std::fabs(tx) < kMaxTranslate) || !(std::fabs(ty) < kMaxTranslate)) {
+        this->INHERITED::onRender(canvas, ctx);
+        return;
+    }
+
+    // The image is reusable as long as the content only moves by whole pixels.
+    const auto ix = std::floor(tx),
+               iy = std::floor(ty);
+    auto matrix = ctm;
+    matrix.setTranslateX(tx - ix);
+    matrix.setTranslateY(ty - iy);
+
+    if (matrix != fMatrix) {
+        this->purge();
+        fMatrix = matrix;
+        fUses   = 0;
+    }
+
+    if (!fImage) {
+        if (++fUses <= kPromoteAfter) {
+            this->INHERITED::onRender(canvas, ctx);
+            return;
+        }
+
+        // The image needs alpha even when the canvas doesn't have any.
+        auto info = canvas->imageInfo();
+        if (SkColorTypeIsAlwaysOpaque(info.colorType())) {
+            info = info.makeColorType(kN32_SkColorType);
+        }
+        const auto bounds = matrix.mapRect(this->bounds()).roundOut();
+        info = info.makeDimensions(bounds.size()).makeAlphaType(kPremul_SkAlphaType);
+        const auto bytes = info.computeMinByteSize();
+        if (info.colorType() == kUnknown_SkColorType || info.isEmpty() ||
+            SkImageInfo::ByteSizeOverflowed(bytes) || !fBudget->reserve(bytes)) {
+            this->INHERITED::onRender(canvas, ctx);
+            return;
+        }
+
+        const auto props = canvas->getTopProps();
+        auto surface = canvas->makeSurface(info, &props);
+        if (surface) {
+            auto* layer = surface->getCanvas();
+            layer->translate(-bounds.fLeft, -bounds.fTop);
+            layer->concat(matrix);
+            this->INHERITED::onRender(layer, nullptr);
+            fImage = surface->makeImageSnapshot();
+        }
+        if (!fImage) {
+            fBudget->release(bytes);
+            this->INHERITED::onRender(canvas, ctx);
+            return;
+        }
+        fImageBounds = bounds;
+    }
+
+    SkPaint paint;
+    if (ctx) {
+        ctx->modulatePaint(SkMatrix::I(), &paint, /*is_layer_paint=*/true);
+    }
+
+    // The image is pixel aligned, so it draws without resampling.
+    canvas->save();
+    canvas->resetMatrix();
+    canvas->drawImage(fImage, ix + fImageBounds.fLeft, iy + fImageBounds.fTop,
+                      SkSamplingOptions(), &paint);
+    canvas->restore();
+}
+
+SkRect CacheEffect::onRevalidate(InvalidationController* ic, const SkMatrix& ctm) {
+    SkASSERT(this->hasInval());
+
+    // The child has changed.
+    this->purge();
+    fUses = 0;
+
+    return this->INHERITED::onRevalidate(ic, ctm);
+}
+
+} // namespace sksg
@@ -110,14 +110,39 @@ void Node::forEachInvalObserver(Func&& func) const {
     }
 }
 
-void Node::invalidate(bool damageBubbling) {
-    TRAVERSAL_GUARD;
+// The list collecting this thread's invalidations, if any.
+static thread_local InvalidationList* gDeferredInvalidations = nullptr;
+
+AutoDeferInvalidation::AutoDeferInvalidation(InvalidationList* list)
+    : fPrev(gDeferredInvalidations) {
+    gDeferredInvalidations = list;
+}
 
+AutoDeferInvalidation::~AutoDeferInvalidation() {
+    gDeferredInvalidations = fPrev;
+}
+
+void InvalidationList::apply() {
+    SkASSERT(gDeferredInvalidations != this);
+    for (const auto& inval : fInvalidations) {
+        inval.fNode->invalidate(inval.fDamage);
+    }
+    fInvalidations.clear();
+}
+
+void Node::invalidate(bool damageBubbling) {
     if (this->hasInval() && (!damageBubbling || (fFlags & kDamage_Flag))) {
         // All done.
         return;
     }
 
+    if (gDeferredInvalidations) {
+        gDeferredInvalidations->fInvalidations.push_back({sk_ref_sp(this), damageBubbling});
+        return;
+    }
+
+    TRAVERSAL_GUARD;
+
     if (damageBubbling && !(fInvalTraits & kBubbleDamage_Trait)) {
         // Found a damage observer.
         fFlags |= kDamage_Flag;
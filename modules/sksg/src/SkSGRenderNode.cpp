@@ -47,12 +47,19 @@ void RenderNode::setVisible(bool v) {
 
 void RenderNode::render(SkCanvas* canvas, const RenderContext* ctx) const {
     SkASSERT(!this->hasInval());
-    if (this->isVisible() && !this->bounds().isEmpty()) {
+    if (this->isVisible() && !this->bounds().isEmpty() &&
+        !(ctx && ctx->fCullToClip && canvas->quickReject(this->bounds()))) {
         this->onRender(canvas, ctx);
     }
     SkASSERT(!this->hasInval());
 }
 
+void RenderNode::renderClipped(SkCanvas* canvas) const {
+    RenderContext ctx;
+    ctx.fCullToClip = true;
+    this->render(canvas, &ctx);
+}
+
 const RenderNode* RenderNode::nodeAt(const SkPoint& p) const {
     return this->bounds().contains(p.x(), p.y()) ? this->onNodeAt(p) : nullptr;
 }
@@ -9,8 +9,13 @@
 
 #if !defined(SK_BUILD_FOR_GOOGLE3)
 
+#include "include/core/SkCanvas.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkPixmap.h"
 #include "include/core/SkRect.h"
+#include "include/core/SkSurface.h"
 #include "include/private/base/SkTo.h"
+#include "modules/sksg/include/SkSGCacheEffect.h"
 #include "modules/sksg/include/SkSGDraw.h"
 #include "modules/sksg/include/SkSGGroup.h"
 #include "modules/sksg/include/SkSGInvalidationController.h"
@@ -355,4 +360,70 @@ DEF_TEST(SGInvalidation, reporter) {
     inval_group_remove(reporter);
 }
 
+DEF_TEST(SGCacheEffect, reporter) {
+    auto color = sksg::Color::Make(SK_ColorRED);
+    auto draw  = sksg::Draw::Make(sksg::Rect::Make(SkRect::MakeLTRB(10, 10, 50, 40)), color);
+    auto budget = sk_make_sp<sksg::CacheEffect::Budget>(64 * 1024);
+    auto cache = sksg::CacheEffect::Make(draw, budget);
+    auto xform = sksg::Matrix<SkMatrix>::Make(SkMatrix::Translate(5, 5));
+    auto root  = sksg::TransformEffect::Make(cache, xform);
+
+    const auto info = SkImageInfo::MakeN32Premul(100, 100);
+    auto expected = SkSurfaces::Raster(info),
+         actual   = SkSurfaces::Raster(info);
+
+    auto check = [&](bool cached) {
+        sksg::InvalidationController ic;
+        root->revalidate(&ic, SkMatrix::I());
+
+        // Render the same content without the cache.
+        expected->getCanvas()->clear(SK_ColorTRANSPARENT);
+        expected->getCanvas()->concat(xform->getMatrix());
+        draw->render(expected->getCanvas());
+        expected->getCanvas()->resetMatrix();
+
+        actual->getCanvas()->clear(SK_ColorTRANSPARENT);
+        root->render(actual->getCanvas());
+        REPORTER_ASSERT(reporter, cache->hasCachedImage() == cached);
+
+        SkPixmap e, a;
+        REPORTER_ASSERT(reporter, expected->peekPixels(&e) && actual->peekPixels(&a));
+        REPORTER_ASSERT(reporter, 0 == memcmp(e.addr(), a.addr(), e.computeByteSize()));
+    };
+
+    for (int i = 0; i < sksg::CacheEffect::kPromoteAfter; ++i) {
+        check(false);
+    }
+    check(true);
+    check(true);
+    REPORTER_ASSERT(reporter, budget->bytesUsed() == 40 * 30 * 4);
+
+    // Whole-pixel translations reuse the image.
+    xform->setMatrix(SkMatrix::Translate(20, 30));
+    check(true);
+
+    // Content changes purge it.
+    color->setColor(SK_ColorBLUE);
+    check(false);
+    REPORTER_ASSERT(reporter, budget->bytesUsed() == 0);
+    for (int i = 0; i < sksg::CacheEffect::kPromoteAfter; ++i) {
+        check(false);
+    }
+    check(true);
+
+    // So do scale changes.
+    xform->setMatrix(SkMatrix::Scale(2, 2));
+    check(false);
+    REPORTER_ASSERT(reporter, budget->bytesUsed() == 0);
+
+    // Content which doesn't fit the budget is never cached.
+    auto small_budget = sk_make_sp<sksg::CacheEffect::Budget>(1024);
+    cache = sksg::CacheEffect::Make(draw, small_budget);
+    root  = sksg::TransformEffect::Make(cache, xform);
+    for (int i = 0; i <= sksg::CacheEffect::kPromoteAfter; ++i) {
+        check(false);
+    }
+    REPORTER_ASSERT(reporter, small_budget->bytesUsed() == 0);
+}
+
 #endif // !defined(SK_BUILD_FOR_GOOGLE3)
@@ -33,6 +33,15 @@ SKSHAPER_API std::unique_ptr<SkShaper::ScriptRunIterator> ScriptRunIterator(cons
                                                                             SkFourByteTag script);
 
 SKSHAPER_API void PurgeCaches();
+
+/**
+ *  Sets how many bytes the cache of shaped words, shared by all HarfBuzz shapers (including the
+ *  ones skparagraph uses), may hold. Runs are then shaped one word at a time and each word is
+ *  only shaped once, for fonts whose lookups do not involve the space glyph. 0, the default,
+ *  disables the cache. PurgeCaches() empties it.
+ */
+SKSHAPER_API void SetWordCacheLimit(size_t bytes);
+SKSHAPER_API size_t GetWordCacheUsed();
 }  // namespace SkShapers::HB
 
 #endif
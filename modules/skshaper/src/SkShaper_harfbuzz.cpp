@@ -34,7 +34,9 @@
 #include "modules/skunicode/include/SkUnicode.h"
 #include "src/base/SkTDPQueue.h"
 #include "src/base/SkUTF.h"
+#include "src/core/SkChecksum.h"
 #include "src/core/SkLRUCache.h"
+#include "src/core/SkTHash.h"
 
 #if !defined(SK_DISABLE_LEGACY_SKSHAPER_FUNCTIONS)
 #include "modules/skshaper/include/SkShaper_skunicode.h"
@@ -43,6 +45,7 @@
 #include <hb-ot.h>
 #include <hb.h>
 
+#include <atomic>
 #include <cstdint>
 #include <cstring>
 #include <memory>
@@ -65,6 +68,7 @@ using HBBlob   = std::unique_ptr<hb_blob_t  , SkFunctionObject<hb_blob_destroy>
 using HBFace   = std::unique_ptr<hb_face_t  , SkFunctionObject<hb_face_destroy>  >;
 using HBFont   = std::unique_ptr<hb_font_t  , SkFunctionObject<hb_font_destroy>  >;
 using HBBuffer = std::unique_ptr<hb_buffer_t, SkFunctionObject<hb_buffer_destroy>>;
+using HBSet    = std::unique_ptr<hb_set_t   , SkFunctionObject<hb_set_destroy>   >;
 
 using SkUnicodeBreak = std::unique_ptr<SkBreakIterator>;
 
@@ -640,6 +644,21 @@ protected:
                     const FontRunIterator&,
                     const Feature*, size_t featuresSize) const;
 private:
+    // Shapes [utf8Start, utf8End) with [contextStart, contextEnd) around it as context, and
+    // appends the glyphs with clusters relative to utf8. Returns the advance of the glyphs.
+    SkVector shapeSegment(const char* utf8,
+                          const char* contextStart,
+                          const char* utf8Start,
+                          const char* utf8End,
+                          const char* contextEnd,
+                          hb_font_t*,
+                          const SkFont&,
+                          hb_direction_t,
+                          hb_script_t,
+                          hb_language_t,
+                          SkSpan<const hb_feature_t>,
+                          TArray<ShapedGlyph, true>* glyphs) const;
+
     const sk_sp<SkFontMgr> fFontMgr; // for fallback
     HBBuffer               fBuffer;
     hb_language_t          fUndefinedLanguage;
@@ -1275,6 +1294,258 @@ static HBLockedFaceCache get_hbFace_cache() {
     return HBLockedFaceCache(gHBFaceCache, gHBFaceCacheMutex);
 }
 
+/**
+ *  Remembers the glyphs HarfBuzz made for space-delimited segments of text (a word and the spaces
+ *  after it), so that text which repeats the same words is not shaped again and again.
+ *
+ *  Shaping a run one segment at a time only gives the same glyphs as shaping it whole if it is
+ *  always safe to break after a space, i.e. if no substitution or positioning lookup of the font
+ *  looks at the space glyph. That is checked once per typeface; see spaceIsInert().
+ *
+ *  The cache is disabled until SkShapers::HB::SetWordCacheLimit() gives it a budget.
+ */
+class HBWordCache {
+public:
+    static HBWordCache& Get() {
+        static HBWordCache* gCache = new HBWordCache;
+        return *gCache;
+    }
+
+    // Segments longer than this are shaped, but not cached.
+    static constexpr size_t kMaxSegmentBytes = 128;
+
+    // How much context around a segment HarfBuzz looks at (HB_BUFFER_CONTEXT_LENGTH).
+    static constexpr int kContextLength = 5;
+
+    class Key {
+    public:
+        Key(const SkFont& font, hb_direction_t direction, hb_script_t script,
+            hb_language_t language, SkSpan<const hb_feature_t> features,
+            const char* contextStart, const char* segmentStart, const char* segmentEnd,
+            const char* contextEnd) {
+            Header header;
+            memset(&header, 0, sizeof(header));
+            header.fTypefaceID = font.getTypeface()->uniqueID();
+            header.fSize = font.getSize();
+            header.fScaleX = font.getScaleX();
+            header.fSkewX = font.getSkewX();
+            header.fFlags = (font.isForceAutoHinting() ? 1 : 0) |
+                            (font.isEmbeddedBitmaps()  ? 2 : 0) |
+                            (font.isSubpixel()         ? 4 : 0) |
+                            (font.isLinearMetrics()    ? 8 : 0) |
+                            (font.isEmbolden()         ? 16 : 0) |
+                            (font.isBaselineSnap()     ? 32 : 0) |
+                            (SkToU32(font.getEdging())  << 8) |
+                            (SkToU32(font.getHinting()) << 16);
+            header.fDirection = direction;
+            header.fScript = script;
+            header.fLanguage = language;  // HarfBuzz interns languages.
+            header.fFeatureCount = SkToU32(features.size());
+            header.fPreContextBytes = SkToU32(segmentStart - contextStart);
+            header.fSegmentBytes = SkToU32(segmentEnd - segmentStart);
+
+            fBytes.append(reinterpret_cast<const char*>(&header), sizeof(header));
+            for (const hb_feature_t& feature : features) {
+                const uint32_t tagAndValue[] = {feature.tag, feature.value};
+                fBytes.append(reinterpret_cast<const char*>(tagAndValue), sizeof(tagAndValue));
+            }
+            fBytes.append(contextStart, contextEnd - contextStart);
+            fHash = SkChecksum::Hash32(fBytes.c_str(), fBytes.size());
+        }
+
+        bool operator==(const Key& that) const {
+            return fHash == that.fHash && fBytes == that.fBytes;
+        }
+        size_t bytes() const { return fBytes.size(); }
+
+        struct Hash {
+            uint32_t operator()(const Key& key) const { return key.fHash; }
+        };
+
+    private:
+        struct Header {
+            SkTypefaceID fTypefaceID;
+            SkScalar fSize, fScaleX, fSkewX;
+            uint32_t fFlags;
+            hb_direction_t fDirection;
+            hb_script_t fScript;
+            hb_language_t fLanguage;
+            uint32_t fFeatureCount, fPreContextBytes, fSegmentBytes;
+        };
+
+        SkString fBytes;
+        uint32_t fHash;
+    };
+
+    bool isEnabled() const { return fLimit.load(std::memory_order_relaxed) > 0; }
+
+    void setLimit(size_t bytes) {
+        SkAutoMutexExclusive lock(fMutex);
+        fLimit = bytes;
+        this->purgeAsNeeded();
+    }
+
+    size_t used() const {
+        SkAutoMutexExclusive lock(fMutex);
+        return fUsed;
+    }
+
+    void purge() {
+        SkAutoMutexExclusive lock(fMutex);
+        fLRU.reset();
+        fUsed = 0;
+        fSpaceIsInert.reset();
+    }
+
+    /** Returns true if it is always safe to shape text in |hbFont| one segment at a time. */
+    bool spaceIsInert(const SkTypeface& typeface, hb_font_t* hbFont) {
+        const SkTypefaceID typefaceID = typeface.uniqueID();
+        {
+            SkAutoMutexExclusive lock(fMutex);
+            if (const bool* inert = fSpaceIsInert.find(typefaceID)) {
+                return *inert;
+            }
+        }
+        const bool inert = ComputeSpaceIsInert(hbFont);
+        SkAutoMutexExclusive lock(fMutex);
+        fSpaceIsInert.set(typefaceID, inert);
+        return inert;
+    }
+
+    /** Appends the cached glyphs for |key|, with clusters offset by |clusterOffset|. */
+    bool find(const Key& key, uint32_t clusterOffset,
+              TArray<ShapedGlyph, true>* glyphs, SkVector* advance) {
+        SkAutoMutexExclusive lock(fMutex);
+        std::unique_ptr<Value>* found = fLRU.find(key);
+        if (!found) {
+            return false;
+        }
+        const Value& value = **found;
+        ShapedGlyph* dst = glyphs->push_back_n(SkToInt(value.fNumGlyphs), value.fGlyphs.get());
+        for (size_t i = 0; i < value.fNumGlyphs; ++i) {
+            dst[i].fCluster += clusterOffset;
+        }
+        *advance += value.fAdvance;
+        return true;
+    }
+
+    /** Caches |glyphs|, whose clusters are offset by |clusterOffset|. */
+    void add(Key key, uint32_t clusterOffset, SkSpan<const ShapedGlyph> glyphs, SkVector advance) {
+        auto value = std::make_unique<Value>();
+        value->fGlyphs.reset(new ShapedGlyph[glyphs.size()]);
+        value->fNumGlyphs = glyphs.size();
+        for (size_t i = 0; i < glyphs.size(); ++i) {
+            value->fGlyphs[i] = glyphs[i];
+            value->fGlyphs[i].fCluster -= clusterOffset;
+        }
+        value->fAdvance = advance;
+        value->fBytes = sizeof(Key) + key.bytes() + sizeof(Value) +
+                        glyphs.size() * sizeof(ShapedGlyph);
+
+        SkAutoMutexExclusive lock(fMutex);
+        if (fLRU.find(key)) {
+            return;  // Another thread shaped the same segment meanwhile.
+        }
+        fUsed += value->fBytes;
+        fLRU.insert(std::move(key), std::move(value));
+        this->purgeAsNeeded();
+    }
+
+private:
+    struct Value {
+        std::unique_ptr<ShapedGlyph[]> fGlyphs;
+        size_t fNumGlyphs;
+        SkVector fAdvance;
+        size_t fBytes;
+    };
+
+    HBWordCache() : fLRU(INT_MAX) {}
+
+    void purgeAsNeeded() SK_REQUIRES(fMutex) {
+        std::unique_ptr<Value> evicted;
+        while (fUsed > fLimit && fLRU.removeLeastRecentlyUsed(&evicted)) {
+            fUsed -= evicted->fBytes;
+        }
+    }
+
+    static bool ComputeSpaceIsInert(hb_font_t* hbFont) {
+#if SK_HB_VERSION_CHECK(2, 0, 0)
+        hb_codepoint_t space;
+        if (!hb_font_get_nominal_glyph(hbFont, ' ', &space)) {
+            return false;
+        }
+        hb_face_t* face = hb_font_get_face(hbFont);
+        // HarfBuzz applies these tables without lookups that could be inspected.
+        for (hb_tag_t tag : {HB_TAG('k','e','r','n'), HB_TAG('k','e','r','x'),
+                             HB_TAG('m','o','r','t'), HB_TAG('m','o','r','x')}) {
+            HBBlob table(hb_face_reference_table(face, tag));
+            if (hb_blob_get_length(table.get()) > 0) {
+                return false;
+            }
+        }
+        HBSet before(hb_set_create()), input(hb_set_create()), after(hb_set_create());
+        for (hb_tag_t table : {HB_OT_TAG_GSUB, HB_OT_TAG_GPOS}) {
+            HBSet lookups(hb_set_create());
+            hb_ot_layout_collect_lookups(face, table, nullptr, nullptr, nullptr, lookups.get());
+            hb_codepoint_t lookup = HB_SET_VALUE_INVALID;
+            while (hb_set_next(lookups.get(), &lookup)) {
+                hb_ot_layout_lookup_collect_glyphs(face, table, lookup, before.get(), input.get(),
+                                                   after.get(), nullptr);
+            }
+        }
+        return !hb_set_has(before.get(), space) &&
+               !hb_set_has(input.get(), space) &&
+               !hb_set_has(after.get(), space);
+#else
+        return false;
+#endif
+    }
+
+    std::atomic<size_t> fLimit{0};
+    mutable SkMutex fMutex;
+    SkLRUCache<Key, std::unique_ptr<Value>, Key::Hash> fLRU SK_GUARDED_BY(fMutex);
+    size_t fUsed SK_GUARDED_BY(fMutex) = 0;
+    THashMap<SkTypefaceID, bool> fSpaceIsInert SK_GUARDED_BY(fMutex);
+};
+
+static bool is_utf8_continuation(char c) {
+    return (static_cast<unsigned char>(c) & 0xC0) == 0x80;
+}
+
+// The context HarfBuzz would look at before |start|, except that it stops at a space: nothing
+// before a space changes how the text after it is shaped.
+static const char* segment_context_start(const char* text, const char* start) {
+    const char* p = start;
+    for (int i = 0; i < HBWordCache::kContextLength && p > text; ++i) {
+        do {
+            --p;
+        } while (p > text && is_utf8_continuation(*p));
+        if (*p == ' ') {
+            break;
+        }
+    }
+    return p;
+}
+
+// The context HarfBuzz would look at after |end|, up to and including the next space. A segment
+// that ends in a space needs none.
+static const char* segment_context_end(const char* end, const char* textEnd, const char* start) {
+    if (end > start && end[-1] == ' ') {
+        return end;
+    }
+    const char* p = end;
+    for (int i = 0; i < HBWordCache::kContextLength && p < textEnd; ++i) {
+        const bool space = *p == ' ';
+        do {
+            ++p;
+        } while (p < textEnd && is_utf8_continuation(*p));
+        if (space) {
+            break;
+        }
+    }
+    return p;
+}
+
 ShapedRun ShaperHarfBuzz::shape(char const * const utf8,
                                   size_t const utf8Bytes,
                                   char const * const utf8Start,
@@ -1289,33 +1560,8 @@ ShapedRun ShaperHarfBuzz::shape(char const * const utf8,
     ShapedRun run(RunHandler::Range(utf8Start - utf8, utf8runLength),
                   font.currentFont(), bidi.currentLevel(), nullptr, 0);
 
-    hb_buffer_t* buffer = fBuffer.get();
-    SkAutoTCallVProc<hb_buffer_t, hb_buffer_clear_contents> autoClearBuffer(buffer);
-    hb_buffer_set_content_type(buffer, HB_BUFFER_CONTENT_TYPE_UNICODE);
-    hb_buffer_set_cluster_level(buffer, HB_BUFFER_CLUSTER_LEVEL_MONOTONE_CHARACTERS);
-
-    // Documentation for HB_BUFFER_FLAG_BOT/EOT at 763e5466c0a03a7c27020e1e2598e488612529a7.
-    // Currently BOT forces a dotted circle when first codepoint is a mark; EOT has no effect.
-    // Avoid adding dotted circle, re-evaluate if BOT/EOT change. See https://skbug.com/9618.
-    // hb_buffer_set_flags(buffer, HB_BUFFER_FLAG_BOT | HB_BUFFER_FLAG_EOT);
-
-    // Add precontext.
-    hb_buffer_add_utf8(buffer, utf8, utf8Start - utf8, utf8Start - utf8, 0);
-
-    // Populate the hb_buffer directly with utf8 cluster indexes.
-    const char* utf8Current = utf8Start;
-    while (utf8Current < utf8End) {
-        unsigned int cluster = utf8Current - utf8;
-        hb_codepoint_t u = utf8_next(&utf8Current, utf8End);
-        hb_buffer_add(buffer, u, cluster);
-    }
-
-    // Add postcontext.
-    hb_buffer_add_utf8(buffer, utf8Current, utf8 + utf8Bytes - utf8Current, 0, 0);
-
     hb_direction_t direction = is_LTR(bidi.currentLevel()) ? HB_DIRECTION_LTR:HB_DIRECTION_RTL;
-    hb_buffer_set_direction(buffer, direction);
-    hb_buffer_set_script(buffer, hb_script_from_iso15924_tag((hb_tag_t)script.currentScript()));
+    hb_script_t hbScript = hb_script_from_iso15924_tag((hb_tag_t)script.currentScript());
     // Buffers with HB_LANGUAGE_INVALID race since hb_language_get_default is not thread safe.
     // The user must provide a language, but may provide data hb_language_from_string cannot use.
     // Use "und" for the undefined language in this case (RFC5646 4.1 5).
@@ -1323,8 +1569,6 @@ ShapedRun ShaperHarfBuzz::shape(char const * const utf8,
     if (hbLanguage == HB_LANGUAGE_INVALID) {
         hbLanguage = fUndefinedLanguage;
     }
-    hb_buffer_set_language(buffer, hbLanguage);
-    hb_buffer_guess_segment_properties(buffer);
 
     // TODO: better cache HBFace (data) / hbfont (typeface)
     // An HBFace is expensive (it sanitizes the bits).
@@ -1347,6 +1591,7 @@ ShapedRun ShaperHarfBuzz::shape(char const * const utf8,
     }
 
     STArray<32, hb_feature_t> hbFeatures;
+    bool featuresAreGlobal = true;
     for (const auto& feature : SkSpan(features, featuresSize)) {
         if (feature.end < SkTo<size_t>(utf8Start - utf8) ||
                           SkTo<size_t>(utf8End   - utf8)  <= feature.start)
@@ -1361,13 +1606,112 @@ ShapedRun ShaperHarfBuzz::shape(char const * const utf8,
         } else {
             hbFeatures.push_back({ (hb_tag_t)feature.tag, feature.value,
                                    SkTo<unsigned>(feature.start), SkTo<unsigned>(feature.end)});
+            featuresAreGlobal = false;
+        }
+    }
+
+    const SkFont& skFont = font.currentFont();
+    STArray<32, ShapedGlyph, true> glyphs;
+    SkVector runAdvance = { 0, 0 };
+    HBWordCache& wordCache = HBWordCache::Get();
+    if (featuresAreGlobal && wordCache.isEnabled() &&
+        wordCache.spaceIsInert(*skFont.getTypeface(), hbFont.get()))
+    {
+        const char* utf8TextEnd = utf8 + utf8Bytes;
+        const char* segmentStart = utf8Start;
+        while (segmentStart < utf8End) {
+            // A segment is a word and the spaces after it.
+            const char* segmentEnd = segmentStart;
+            while (segmentEnd < utf8End && *segmentEnd != ' ') { ++segmentEnd; }
+            while (segmentEnd < utf8End && *segmentEnd == ' ') { ++segmentEnd; }
+
+            const char* contextStart = segment_context_start(utf8, segmentStart);
+            const char* contextEnd = segment_context_end(segmentEnd, utf8TextEnd, segmentStart);
+            const uint32_t clusterOffset = SkToU32(segmentStart - utf8);
+            if (SkToSizeT(segmentEnd - segmentStart) > HBWordCache::kMaxSegmentBytes) {
+                runAdvance += this->shapeSegment(utf8, contextStart, segmentStart, segmentEnd,
+                                                 contextEnd, hbFont.get(), skFont, direction,
+                                                 hbScript, hbLanguage, hbFeatures, &glyphs);
+            } else {
+                HBWordCache::Key key(skFont, direction, hbScript, hbLanguage, hbFeatures,
+                                     contextStart, segmentStart, segmentEnd, contextEnd);
+                if (!wordCache.find(key, clusterOffset, &glyphs, &runAdvance)) {
+                    const int first = glyphs.size();
+                    SkVector advance = this->shapeSegment(utf8, contextStart, segmentStart,
+                                                          segmentEnd, contextEnd, hbFont.get(),
+                                                          skFont, direction, hbScript,
+                                                          hbLanguage, hbFeatures, &glyphs);
+                    wordCache.add(std::move(key), clusterOffset,
+                                  SkSpan(glyphs).subspan(first), advance);
+                    runAdvance += advance;
+                }
+            }
+            segmentStart = segmentEnd;
         }
+    } else {
+        runAdvance = this->shapeSegment(utf8, utf8, utf8Start, utf8End, utf8 + utf8Bytes,
+                                        hbFont.get(), skFont, direction, hbScript, hbLanguage,
+                                        hbFeatures, &glyphs);
+    }
+
+    if (glyphs.empty()) {
+        return run;
+    }
+    run = ShapedRun(RunHandler::Range(utf8Start - utf8, utf8runLength),
+                    skFont, bidi.currentLevel(),
+                    std::unique_ptr<ShapedGlyph[]>(new ShapedGlyph[glyphs.size()]), glyphs.size());
+    memcpy(run.fGlyphs.get(), glyphs.data(), glyphs.size_bytes());
+    run.fAdvance = runAdvance;
+
+    return run;
+}
+
+SkVector ShaperHarfBuzz::shapeSegment(const char* utf8,
+                                      const char* contextStart,
+                                      const char* utf8Start,
+                                      const char* utf8End,
+                                      const char* contextEnd,
+                                      hb_font_t* hbFont,
+                                      const SkFont& font,
+                                      hb_direction_t direction,
+                                      hb_script_t script,
+                                      hb_language_t language,
+                                      SkSpan<const hb_feature_t> features,
+                                      TArray<ShapedGlyph, true>* glyphs) const {
+    hb_buffer_t* buffer = fBuffer.get();
+    SkAutoTCallVProc<hb_buffer_t, hb_buffer_clear_contents> autoClearBuffer(buffer);
+    hb_buffer_set_content_type(buffer, HB_BUFFER_CONTENT_TYPE_UNICODE);
+    hb_buffer_set_cluster_level(buffer, HB_BUFFER_CLUSTER_LEVEL_MONOTONE_CHARACTERS);
+
+    // Documentation for HB_BUFFER_FLAG_BOT/EOT at 763e5466c0a03a7c27020e1e2598e488612529a7.
+    // Currently BOT forces a dotted circle when first codepoint is a mark; EOT has no effect.
+    // Avoid adding dotted circle, re-evaluate if BOT/EOT change. See https://skbug.com/9618.
+    // hb_buffer_set_flags(buffer, HB_BUFFER_FLAG_BOT | HB_BUFFER_FLAG_EOT);
+
+    // Add precontext.
+    hb_buffer_add_utf8(buffer, contextStart, utf8Start - contextStart,
+                       utf8Start - contextStart, 0);
+
+    // Populate the hb_buffer directly with utf8 cluster indexes.
+    const char* utf8Current = utf8Start;
+    while (utf8Current < utf8End) {
+        unsigned int cluster = utf8Current - utf8;
+        hb_codepoint_t u = utf8_next(&utf8Current, utf8End);
+        hb_buffer_add(buffer, u, cluster);
     }
 
-    hb_shape(hbFont.get(), buffer, hbFeatures.data(), hbFeatures.size());
+    // Add postcontext.
+    hb_buffer_add_utf8(buffer, utf8Current, contextEnd - utf8Current, 0, 0);
+
+    hb_buffer_set_direction(buffer, direction);
+    hb_buffer_set_script(buffer, script);
+    hb_buffer_set_language(buffer, language);
+    hb_buffer_guess_segment_properties(buffer);
+
+    hb_shape(hbFont, buffer, features.data(), features.size());
     unsigned len = hb_buffer_get_length(buffer);
     if (len == 0) {
-        return run;
+        return {0, 0};
     }
 
     if (direction == HB_DIRECTION_RTL) {
@@ -1378,10 +1722,6 @@ ShapedRun ShaperHarfBuzz::shape(char const * const utf8,
     hb_glyph_info_t* info = hb_buffer_get_glyph_infos(buffer, nullptr);
     hb_glyph_position_t* pos = hb_buffer_get_glyph_positions(buffer, nullptr);
 
-    run = ShapedRun(RunHandler::Range(utf8Start - utf8, utf8runLength),
-                    font.currentFont(), bidi.currentLevel(),
-                    std::unique_ptr<ShapedGlyph[]>(new ShapedGlyph[len]), len);
-
     // Undo skhb_position with (1.0/(1<<16)) and scale as needed.
     AutoSTArray<32, SkGlyphID> glyphIDs(len);
     for (unsigned i = 0; i < len; i++) {
@@ -1389,13 +1729,14 @@ ShapedRun ShaperHarfBuzz::shape(char const * const utf8,
     }
     AutoSTArray<32, SkRect> glyphBounds(len);
     SkPaint p;
-    run.fFont.getBounds(glyphIDs.get(), len, glyphBounds.get(), &p);
+    font.getBounds(glyphIDs.get(), len, glyphBounds.get(), &p);
 
-    double SkScalarFromHBPosX = +(1.52587890625e-5) * run.fFont.getScaleX();
+    double SkScalarFromHBPosX = +(1.52587890625e-5) * font.getScaleX();
     double SkScalarFromHBPosY = -(1.52587890625e-5);  // HarfBuzz y-up, Skia y-down
-    SkVector runAdvance = { 0, 0 };
+    SkVector advance = { 0, 0 };
+    ShapedGlyph* shapedGlyphs = glyphs->push_back_n(SkToInt(len));
     for (unsigned i = 0; i < len; i++) {
-        ShapedGlyph& glyph = run.fGlyphs[i];
+        ShapedGlyph& glyph = shapedGlyphs[i];
         glyph.fID = info[i].codepoint;
         glyph.fCluster = info[i].cluster;
         glyph.fOffset.fX = pos[i].x_offset * SkScalarFromHBPosX;
@@ -1409,13 +1750,13 @@ ShapedRun ShaperHarfBuzz::shape(char const * const utf8,
 #else
         glyph.fUnsafeToBreak = false;
 #endif
+        glyph.fMayLineBreakBefore = false;
         glyph.fMustLineBreakBefore = false;
+        glyph.fGraphemeBreakBefore = false;
 
-        runAdvance += glyph.fAdvance;
+        advance += glyph.fAdvance;
     }
-    run.fAdvance = runAdvance;
-
-    return run;
+    return advance;
 }
 }  // namespace
 
@@ -1534,5 +1875,10 @@ std::unique_ptr<SkShaper::ScriptRunIterator> ScriptRunIterator(const char* utf8,
 void PurgeCaches() {
     HBLockedFaceCache cache = get_hbFace_cache();
     cache.reset();
+    HBWordCache::Get().purge();
 }
+
+void SetWordCacheLimit(size_t bytes) { HBWordCache::Get().setLimit(bytes); }
+
+size_t GetWordCacheUsed() { return HBWordCache::Get().used(); }
 }  // namespace SkShapers::HB
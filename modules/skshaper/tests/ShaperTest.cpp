@@ -23,6 +23,7 @@
 #include <cinttypes>
 #include <cstdint>
 #include <memory>
+#include <vector>
 
 #if defined(SK_UNICODE_ICU_IMPLEMENTATION)
 #include "modules/skunicode/include/SkUnicode_icu.h"
@@ -271,4 +272,81 @@ SHAPER_TEST(taitham)
 SHAPER_TEST(tamil)
 #undef SHAPER_TEST
 
+namespace {
+// Collects the glyphs of every run, in the order they are committed.
+struct CollectingRunHandler final : public SkShaper::RunHandler {
+    std::vector<SkGlyphID> fGlyphs;
+    std::vector<SkPoint> fPositions;
+    std::vector<uint32_t> fClusters;
+    size_t fRunGlyphCount = 0;
+
+    void beginLine() override {}
+    void runInfo(const RunInfo&) override {}
+    void commitRunInfo() override {}
+    Buffer runBuffer(const RunInfo& info) override {
+        fRunGlyphCount = info.glyphCount;
+        fGlyphs.resize(fGlyphs.size() + info.glyphCount);
+        fPositions.resize(fPositions.size() + info.glyphCount);
+        fClusters.resize(fClusters.size() + info.glyphCount);
+        const size_t start = fGlyphs.size() - info.glyphCount;
+        return {fGlyphs.data() + start, fPositions.data() + start, nullptr,
+                fClusters.data() + start, {0, 0}};
+    }
+    void commitRunBuffer(const RunInfo&) override {}
+    void commitLine() override {}
+};
+}  // namespace
+
+DEF_SERIAL_TEST(Shaper_word_cache, r) {
+    auto unicode = get_unicode();
+    if (!unicode) {
+        ERRORF(r, "Could not create unicode.");
+        return;
+    }
+    auto shaper = SkShapers::HB::ShaperDrivenWrapper(unicode, SkFontMgr::RefEmpty());
+    const SkFont font = ToolUtils::DefaultFont();
+
+    auto shape = [&](const char* resource) {
+        CollectingRunHandler handler;
+        sk_sp<SkData> data = GetResourceAsData(resource);
+        if (!data) {
+            return handler;
+        }
+        const char* utf8 = (const char*)data->data();
+        const size_t utf8Bytes = data->size();
+        auto bidi = SkShapers::unicode::BidiRunIterator(unicode, utf8, utf8Bytes,
+                                                        SkBidiIterator::kLTR);
+        auto language = SkShaper::MakeStdLanguageRunIterator(utf8, utf8Bytes);
+        auto script = SkShapers::HB::ScriptRunIterator(utf8, utf8Bytes);
+        auto fontRuns = SkShaper::MakeFontMgrRunIterator(utf8, utf8Bytes, font,
+                                                         SkFontMgr::RefEmpty());
+        shaper->shape(utf8, utf8Bytes, *fontRuns, *bidi, *script, *language, nullptr, 0, 400,
+                      &handler);
+        return handler;
+    };
+
+    SkShapers::HB::PurgeCaches();
+    SkShapers::HB::SetWordCacheLimit(0);
+    for (const char* resource : {"text/english.txt", "text/arabic.txt", "text/hebrew.txt"}) {
+        skiatest::ReporterContext context(r, resource);
+        const CollectingRunHandler expected = shape(resource);
+        REPORTER_ASSERT(r, SkShapers::HB::GetWordCacheUsed() == 0);
+
+        // Shaping word by word, whether the words are found in the cache or not, gives the
+        // same glyphs as shaping whole runs.
+        constexpr size_t kLimit = 64 * 1024;
+        SkShapers::HB::SetWordCacheLimit(kLimit);
+        for (int pass = 0; pass < 2; ++pass) {
+            const CollectingRunHandler actual = shape(resource);
+            REPORTER_ASSERT(r, actual.fGlyphs == expected.fGlyphs, "pass %d", pass);
+            REPORTER_ASSERT(r, actual.fPositions == expected.fPositions, "pass %d", pass);
+            REPORTER_ASSERT(r, actual.fClusters == expected.fClusters, "pass %d", pass);
+            REPORTER_ASSERT(r, SkShapers::HB::GetWordCacheUsed() <= kLimit);
+        }
+
+        SkShapers::HB::SetWordCacheLimit(0);
+        REPORTER_ASSERT(r, SkShapers::HB::GetWordCacheUsed() == 0);
+    }
+}
+
 #endif  // #if defined(SK_SHAPER_HARFBUZZ_AVAILABLE) && defined(SK_SHAPER_UNICODE_AVAILABLE)
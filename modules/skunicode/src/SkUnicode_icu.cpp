@@ -21,6 +21,7 @@
 #include "modules/skunicode/src/SkUnicode_icupriv.h"
 #include "src/base/SkBitmaskEnum.h"
 #include "src/base/SkUTF.h"
+#include "src/base/SkVx.h"
 #include "src/core/SkChecksum.h"
 #include "src/core/SkTHash.h"
 
@@ -31,6 +32,7 @@
 #include <unicode/utext.h>
 #include <unicode/utypes.h>
 
+#include <array>
 #include <cstdint>
 #include <cstring>
 #include <functional>
@@ -333,6 +335,154 @@ class SkIcuBreakIteratorCache final {
 };
 /*static*/ int32_t SkIcuBreakIteratorCache::BreakIteratorRef::Instances{0};
 
+static bool is_ascii(const char utf8[], int utf8Units) {
+    int i = 0;
+    for (; i + 16 <= utf8Units; i += 16) {
+        if (any(skvx::byte16::Load(utf8 + i) >= 0x80)) {
+            return false;
+        }
+    }
+    for (; i < utf8Units; ++i) {
+        if (static_cast<uint8_t>(utf8[i]) >= 0x80) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// The UAX #14 line breaking classes of the ASCII characters the fast path below handles; the rest
+// (quotes, brackets, hyphens, slashes, currency signs, tabs and other controls) take part in
+// rules that look further than the previous character, and are left to ICU.
+enum class AsciiLineBreakClass : uint8_t {
+    kUnhandled,
+    kAlphabetic,       // AL: letters and symbols such as # & * < = > @ ^ _ ` ~
+    kNumeric,          // NU
+    kInfixSeparator,   // IS: , . : ;
+    kExclamation,      // EX: ! ?
+    kSpace,            // SP
+    kLineFeed,         // LF
+    kCarriageReturn,   // CR
+};
+
+static constexpr std::array<AsciiLineBreakClass, 128> kAsciiLineBreakClasses = [] {
+    using C = AsciiLineBreakClass;
+    std::array<C, 128> classes = {};
+    for (char c = 'a'; c <= 'z'; ++c) { classes[c] = C::kAlphabetic; }
+    for (char c = 'A'; c <= 'Z'; ++c) { classes[c] = C::kAlphabetic; }
+    for (char c : {'#', '&', '*', '<', '=', '>', '@', '^', '_', '`', '~'}) {
+        classes[c] = C::kAlphabetic;
+    }
+    for (char c = '0'; c <= '9'; ++c) { classes[c] = C::kNumeric; }
+    for (char c : {',', '.', ':', ';'}) { classes[c] = C::kInfixSeparator; }
+    classes['!'] = classes['?'] = C::kExclamation;
+    classes[' '] = C::kSpace;
+    classes['\n'] = C::kLineFeed;
+    classes['\r'] = C::kCarriageReturn;
+    return classes;
+}();
+
+/**
+ *  Computes the same code unit flags as SkUnicode_icu::computeCodeUnitFlags() for text made only
+ *  of the characters in kAsciiLineBreakClasses, without ICU. Returns false, leaving |results| in
+ *  an unspecified state, for any other text.
+ *
+ *  For such text every code unit starts a grapheme, except for a LF after a CR (UAX #29 GB3),
+ *  and the line breaks follow from UAX #14 as follows:
+ *      LB4, LB5: break after LF and CR, but not between CR and LF
+ *      LB6, LB7: no break before LF, CR or spaces
+ *      LB13, LB15d: no break before IS or EX, even after spaces
+ *      LB18:     break after spaces
+ *      LB23, LB28: no break between letters and digits
+ *      LB25:     no break in numbers such as 1,000.5
+ *      LB29:     no break between IS and a letter
+ *  The two pairs no rule above covers, IS followed by a digit outside of a number and EX followed
+ *  by a letter or digit, are left to ICU. So is a space followed by IS and a digit, as in " .5":
+ *  since Unicode 15.1 (ICU 74) LB15c breaks before the IS, while earlier versions don't, and the
+ *  result has to match whichever ICU is in use.
+ */
+static bool compute_ascii_code_unit_flags(const char utf8[], int utf8Units,
+                                          TArray<SkUnicode::CodeUnitFlags, true>* results) {
+    using C = AsciiLineBreakClass;
+    if (!is_ascii(utf8, utf8Units)) {
+        return false;
+    }
+    results->clear();
+    results->push_back_n(utf8Units + 1, SkUnicode::CodeUnitFlags::kNoCodeUnitFlag);
+    SkUnicode::CodeUnitFlags* flags = results->data();
+    flags[0] = SkUnicode::kSoftLineBreakBefore | SkUnicode::kGraphemeStart;
+
+    C previous = C::kUnhandled;
+    bool inNumber = false;  // Whether the IS characters before this one follow a digit.
+    for (int i = 0; i < utf8Units; ++i) {
+        const C current = kAsciiLineBreakClasses[static_cast<uint8_t>(utf8[i])];
+        if (current == C::kUnhandled) {
+            return false;
+        }
+        if (i > 0) {
+            bool lineBreak;
+            if (previous == C::kLineFeed) {
+                lineBreak = true;
+                flags[i] |= SkUnicode::kHardLineBreakBefore;
+            } else if (previous == C::kCarriageReturn) {
+                lineBreak = current != C::kLineFeed;
+            } else if (current == C::kSpace || current == C::kLineFeed ||
+                       current == C::kCarriageReturn) {
+                lineBreak = false;
+            } else if (current == C::kInfixSeparator || current == C::kExclamation) {
+                if (previous == C::kSpace && current == C::kInfixSeparator &&
+                    i + 1 < utf8Units &&
+                    kAsciiLineBreakClasses[static_cast<uint8_t>(utf8[i + 1])] == C::kNumeric) {
+                    return false;
+                }
+                lineBreak = false;
+            } else if (previous == C::kSpace) {
+                lineBreak = true;
+            } else if (previous == C::kInfixSeparator) {
+                if (current == C::kNumeric && !inNumber) {
+                    return false;
+                }
+                lineBreak = false;
+            } else if (previous == C::kExclamation) {
+                return false;
+            } else {
+                lineBreak = false;  // Letters and digits.
+            }
+            if (lineBreak) {
+                flags[i] |= SkUnicode::kSoftLineBreakBefore;
+            }
+            if (!(previous == C::kCarriageReturn && current == C::kLineFeed)) {
+                flags[i] |= SkUnicode::kGraphemeStart;
+            }
+        }
+
+        switch (current) {
+            case C::kSpace:
+                flags[i] |= SkUnicode::kPartOfIntraWordBreak | SkUnicode::kPartOfWhiteSpaceBreak;
+                break;
+            case C::kLineFeed:
+            case C::kCarriageReturn:
+                flags[i] |= SkUnicode::kPartOfIntraWordBreak | SkUnicode::kPartOfWhiteSpaceBreak |
+                            SkUnicode::kControl;
+                break;
+            default:
+                break;
+        }
+        if (current == C::kNumeric) {
+            inNumber = true;
+        } else if (current != C::kInfixSeparator) {
+            inNumber = false;
+        }
+        previous = current;
+    }
+    if (utf8Units > 0) {
+        flags[utf8Units] |= SkUnicode::kSoftLineBreakBefore | SkUnicode::kGraphemeStart;
+        if (previous == C::kLineFeed) {
+            flags[utf8Units] |= SkUnicode::kHardLineBreakBefore;
+        }
+    }
+    return true;
+}
+
 class SkUnicode_icu : public SkUnicode {
 
     static bool extractWords(uint16_t utf16[], int utf16Units, const char* locale,
@@ -522,6 +672,14 @@ public:
                         int utf8Units,
                         TextDirection dir,
                         std::vector<BidiRegion>* results) override {
+        // 7-bit text has no strong right-to-left characters, so in a left-to-right paragraph
+        // all of it is at level 0.
+        if (dir == TextDirection::kLTR && is_ascii(utf8, utf8Units)) {
+            if (utf8Units > 0) {
+                results->emplace_back(0, utf8Units, 0);
+            }
+            return true;
+        }
         return fBidiFact->ExtractBidi(utf8, utf8Units, dir, results);
     }
 
@@ -570,6 +728,12 @@ public:
 
     bool computeCodeUnitFlags(char utf8[], int utf8Units, bool replaceTabs,
                               TArray<SkUnicode::CodeUnitFlags, true>* results) override {
+        // Short labels are mostly plain ASCII, for which running ICU's iterators costs the most.
+        // (The fast path does not handle tabs, so there is nothing to replace.)
+        if (compute_ascii_code_unit_flags(utf8, utf8Units, results)) {
+            return true;
+        }
+
         results->clear();
         results->push_back_n(utf8Units + 1, CodeUnitFlags::kNoCodeUnitFlag);
 
@@ -283,6 +283,47 @@ DEF_TEST_ICU_UNICODES(SkUnicode_ComputeCodeUnitFlags, reporter) {
     }
 }
 
+DEF_TEST_ICU_UNICODES(SkUnicode_ComputeCodeUnitFlagsAscii, reporter) {
+    if (!unicode) {
+        return;
+    }
+    // Plain ASCII text may be handled without the break iterators; it must come out the same as
+    // when it follows a non-ASCII word, which cannot.
+    const char* texts[] = {
+        "Hello, world! How are you?",
+        "Version 1.2.3 costs 1,000.50 now; ok: yes.",
+        "line one\nline two\r\nline three\rend\n",
+        "a  b   c !d ?e ,f .g :h ;i",
+        "x=1 y<2 z>3 a|b c~d e@f g#h i&j k*l m^n o_p q`r",
+        "T1000 3am p.m. e.g.,like so!!",
+        // A space followed by IS and a digit breaks before the IS since ICU 74 (LB15c), but not
+        // before; the IS followed by anything else never does.
+        "costs .50 or ,5 at :30 on ;1",
+        "see .net and :x or ;",
+    };
+    const SkString prefix("\u00E9t\u00E9 ");
+    for (const char* text : texts) {
+        SkString ascii(text);
+        SkString mixed = prefix;
+        mixed.append(ascii);
+        TArray<SkUnicode::CodeUnitFlags, true> asciiFlags, mixedFlags;
+        REPORTER_ASSERT(reporter, unicode->computeCodeUnitFlags(
+                ascii.data(), ascii.size(), /*replaceTabs=*/false, &asciiFlags));
+        REPORTER_ASSERT(reporter, unicode->computeCodeUnitFlags(
+                mixed.data(), mixed.size(), /*replaceTabs=*/false, &mixedFlags));
+        REPORTER_ASSERT(reporter, asciiFlags.size() == SkToInt(ascii.size() + 1));
+        REPORTER_ASSERT(reporter, mixedFlags.size() == SkToInt(mixed.size() + 1));
+        if (asciiFlags.size() + SkToInt(prefix.size()) != mixedFlags.size()) {
+            continue;
+        }
+        for (int i = 0; i < asciiFlags.size(); ++i) {
+            REPORTER_ASSERT(reporter, asciiFlags[i] == mixedFlags[i + prefix.size()],
+                            "'%s' at %d: %x != %x", text, i, asciiFlags[i],
+                            mixedFlags[i + prefix.size()]);
+        }
+    }
+}
+
 DEF_TEST_UNICODES(SkUnicode_ReorderVisual, reporter) {
     if (!unicode) {
         return;
@@ -16,6 +16,8 @@
 #include "modules/skshaper/include/SkShaper_factory.h"
 #include "modules/svg/include/SkSVGIDMapper.h"
 
+#include <memory>
+
 class SkCanvas;
 class SkDOM;
 class SkStream;
@@ -46,14 +48,27 @@ public:
          */
         Builder& setTextShapingFactory(sk_sp<SkShapers::Factory>);
 
+        /**
+         * When enabled, render() records the document into a picture, and replays it for as long
+         * as the document and its container size stay the same, instead of resolving the node
+         * tree again.  This suits static documents drawn repeatedly.
+         *
+         * Modifying any SVG node, or calling findNodeById(), discards the picture.  Content
+         * loaded by the resource provider is captured by the picture as it was first rendered.
+         */
+        Builder& setRenderCaching(bool);
+
         sk_sp<SkSVGDOM> make(SkStream&) const;
 
     private:
         sk_sp<SkFontMgr>                             fFontMgr;
         sk_sp<skresources::ResourceProvider>         fResourceProvider;
         sk_sp<SkShapers::Factory>                    fTextShapingFactory;
+        bool                                         fRenderCaching = false;
     };
 
+    ~SkSVGDOM() override;
+
     static sk_sp<SkSVGDOM> MakeFromStream(SkStream& str) {
         return Builder().make(str);
     }
@@ -89,6 +104,7 @@ public:
     const SkSize& containerSize() const;
 
     // Returns the node with the given id, or nullptr if not found.
+    // The returned node slot can be modified, so this discards any cached render.
     sk_sp<SkSVGNode>* findNodeById(const char* id);
 
     void render(SkCanvas*) const;
@@ -101,7 +117,12 @@ private:
              sk_sp<SkFontMgr>,
              sk_sp<skresources::ResourceProvider>,
              SkSVGIDMapper&&,
-             sk_sp<SkShapers::Factory>);
+             sk_sp<SkShapers::Factory>,
+             bool renderCaching);
+
+    class RenderCache;
+
+    void renderRoot(SkCanvas*) const;
 
     const sk_sp<SkSVGSVG>                       fRoot;
     const sk_sp<SkFontMgr>                      fFontMgr;
@@ -109,6 +130,7 @@ private:
     const sk_sp<skresources::ResourceProvider>  fResourceProvider;
     const SkSVGIDMapper                         fIDMapper;
     SkSize                                      fContainerSize;
+    const std::unique_ptr<RenderCache>          fRenderCache;  // null unless caching renders
 };
 
 #endif // SkSVGDOM_DEFINED
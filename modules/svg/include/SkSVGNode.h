@@ -9,6 +9,7 @@
 #define SkSVGNode_DEFINED
 
 #include "include/core/SkRefCnt.h"
+#include "include/core/SkTypes.h"
 #include "modules/svg/include/SkSVGAttribute.h"
 #include "modules/svg/include/SkSVGAttributeParser.h"
 
@@ -88,6 +89,7 @@ public:                                                                      \
         } else {                                                             \
             dest->set(SkSVGPropertyState::kInherit);                         \
         }                                                                    \
+        DidModify();                                                         \
     }                                                                        \
     void set##attr_name(SkSVGProperty<attr_type, attr_inherited>&& v) {      \
         auto* dest = &fPresentationAttributes.f##attr_name;                  \
@@ -97,6 +99,7 @@ public:                                                                      \
         } else {                                                             \
             dest->set(SkSVGPropertyState::kInherit);                         \
         }                                                                    \
+        DidModify();                                                         \
     }
 
 class SK_API SkSVGNode : public SkRefCnt {
@@ -118,6 +121,10 @@ public:
     // TODO: consolidate with existing setAttribute
     virtual bool parseAndSetAttribute(const char* name, const char* value);
 
+    // Changes whenever any node is modified, e.g. by setting an attribute or appending a child.
+    // Renders cached from a DOM are valid for as long as it stays the same.
+    static uint32_t Generation();
+
     // inherited
     SVG_PRES_ATTR(ClipRule                 , SkSVGFillRule  , true)
     SVG_PRES_ATTR(Color                    , SkSVGColorType , true)
@@ -156,6 +163,9 @@ public:
 protected:
     SkSVGNode(SkSVGTag);
 
+    // Must be called by all node mutators.
+    static void DidModify();
+
     static SkMatrix ComputeViewboxMatrix(const SkRect&, const SkRect&, SkSVGPreserveAspectRatio);
 
     // Called before onRender(), to apply local attributes to the context.  Unlike onRender(),
@@ -204,8 +214,14 @@ private:
             return pr.isValid();                                              \
         }                                                                     \
     public:                                                                   \
-        void set##attr_name(const attr_type& a) { set_cp(a); }                \
-        void set##attr_name(attr_type&& a) { set_mv(std::move(a)); }
+        void set##attr_name(const attr_type& a) {                             \
+            set_cp(a);                                                        \
+            DidModify();                                                      \
+        }                                                                     \
+        void set##attr_name(attr_type&& a) {                                  \
+            set_mv(std::move(a));                                             \
+            DidModify();                                                      \
+        }
 
 #define SVG_ATTR(attr_name, attr_type, attr_default)                        \
     private:                                                                \
@@ -9,7 +9,12 @@
 
 #include "include/core/SkCanvas.h"
 #include "include/core/SkFontMgr.h"
+#include "include/core/SkPicture.h"
+#include "include/core/SkPictureRecorder.h"
+#include "include/core/SkSize.h"
 #include "include/core/SkString.h"
+#include "include/private/base/SkMutex.h"
+#include "include/private/base/SkThreadAnnotations.h"
 #include "include/private/base/SkTo.h"
 #include "modules/skshaper/include/SkShaper_factory.h"
 #include "modules/svg/include/SkSVGAttributeParser.h"
@@ -51,8 +56,12 @@
 #include "modules/svg/include/SkSVGUse.h"
 #include "modules/svg/include/SkSVGValue.h"
 #include "src/base/SkTSearch.h"
+#include "src/core/SkRectPriv.h"
 #include "src/core/SkTraceEvent.h"
-#include "src/xml/SkDOM.h"
+#include "src/xml/SkXMLParser.h"
+
+#include <cstring>
+#include <vector>
 
 namespace {
 
@@ -286,15 +295,6 @@ SortedDictionaryEntry<sk_sp<SkSVGNode>(*)()> gTagFactories[] = {
     { "use"                , []() -> sk_sp<SkSVGNode> { return SkSVGUse::Make();                 }},
 };
 
-struct ConstructionContext {
-    ConstructionContext(SkSVGIDMapper* mapper) : fParent(nullptr), fIDMapper(mapper) {}
-    ConstructionContext(const ConstructionContext& other, const sk_sp<SkSVGNode>& newParent)
-        : fParent(newParent.get()), fIDMapper(other.fIDMapper) {}
-
-    SkSVGNode*     fParent;
-    SkSVGIDMapper* fIDMapper;
-};
-
 bool set_string_attribute(const sk_sp<SkSVGNode>& node, const char* name, const char* value) {
     if (node->parseAndSetAttribute(name, value)) {
         // Handled by new code path
@@ -323,76 +323,107 @@ bool set_string_attribute(const sk_sp<SkSVGNode>& node, const char* name, const
     return true;
 }
 
-void parse_node_attributes(const SkDOM& xmlDom, const SkDOM::Node* xmlNode,
-                           const sk_sp<SkSVGNode>& svgNode, SkSVGIDMapper* mapper) {
-    const char* name, *value;
-    SkDOM::AttrIter attrIter(xmlDom, xmlNode);
-    while ((name = attrIter.next(&value))) {
-        // We're handling id attributes out of band for now.
-        if (!strcmp(name, "id")) {
-            mapper->set(SkString(value), svgNode);
-            continue;
-        }
-        set_string_attribute(svgNode, name, value);
+sk_sp<SkSVGNode> make_node(const char* elem, bool is_root) {
+    if (strcmp(elem, "svg") == 0) {
+        // Outermost SVG element must be tagged as such.
+        return SkSVGSVG::Make(is_root ? SkSVGSVG::Type::kRoot
+                                      : SkSVGSVG::Type::kInner);
     }
-}
-
-sk_sp<SkSVGNode> construct_svg_node(const SkDOM& dom, const ConstructionContext& ctx,
-                                    const SkDOM::Node* xmlNode) {
-    const char* elem = dom.getName(xmlNode);
-    const SkDOM::Type elemType = dom.getType(xmlNode);
-
-    if (elemType == SkDOM::kText_Type) {
-        // Text literals require special handling.
-        SkASSERT(dom.countChildren(xmlNode) == 0);
-        auto txt = SkSVGTextLiteral::Make();
-        txt->setText(SkString(dom.getName(xmlNode)));
-        ctx.fParent->appendChild(std::move(txt));
 
+    const int tagIndex = SkStrSearch(&gTagFactories[0].fKey,
+                                     SkTo<int>(std::size(gTagFactories)),
+                                     elem, sizeof(gTagFactories[0]));
+    if (tagIndex < 0) {
+#if defined(SK_VERBOSE_SVG_PARSING)
+        SkDebugf("unhandled element: <%s>\n", elem);
+#endif
         return nullptr;
     }
+    SkASSERT(SkTo<size_t>(tagIndex) < std::size(gTagFactories));
+
+    return gTagFactories[tagIndex].fValue();
+}
+
+// Builds the SVG node tree as the XML parser reports elements, attributes and text, without an
+// intermediate XML DOM.  Attribute values are parsed straight out of the parser's buffers.
+class SVGNodeBuilder final : public SkXMLParser {
+public:
+    explicit SVGNodeBuilder(SkSVGIDMapper* mapper)
+        : SkXMLParser(&fParserError)
+        , fIDMapper(mapper) {}
 
-    SkASSERT(elemType == SkDOM::kElement_Type);
+    sk_sp<SkSVGNode> releaseRoot() { return std::move(fRoot); }
 
-    auto make_node = [](const ConstructionContext& ctx, const char* elem) -> sk_sp<SkSVGNode> {
-        if (strcmp(elem, "svg") == 0) {
-            // Outermost SVG element must be tagged as such.
-            return SkSVGSVG::Make(ctx.fParent ? SkSVGSVG::Type::kInner
-                                              : SkSVGSVG::Type::kRoot);
+    SkXMLParserError fParserError;
+
+protected:
+    bool onStartElement(const char elem[]) override {
+        if (fSkipDepth > 0) {
+            ++fSkipDepth;
+            return false;
         }
 
-        const int tagIndex = SkStrSearch(&gTagFactories[0].fKey,
-                                         SkTo<int>(std::size(gTagFactories)),
-                                         elem, sizeof(gTagFactories[0]));
-        if (tagIndex < 0) {
-#if defined(SK_VERBOSE_SVG_PARSING)
-            SkDebugf("unhandled element: <%s>\n", elem);
-#endif
-            return nullptr;
+        auto node = make_node(elem, fParents.empty());
+        if (!node) {
+            // Unhandled elements are dropped along with their subtree.
+            fSkipDepth = 1;
+            return false;
         }
-        SkASSERT(SkTo<size_t>(tagIndex) < std::size(gTagFactories));
+        fParents.push_back(std::move(node));
+        return false;
+    }
 
-        return gTagFactories[tagIndex].fValue();
-    };
+    bool onAddAttribute(const char name[], const char value[]) override {
+        if (fSkipDepth > 0) {
+            return false;
+        }
+        SkASSERT(!fParents.empty());
 
-    auto node = make_node(ctx, elem);
-    if (!node) {
-        return nullptr;
+        // We're handling id attributes out of band for now.
+        if (!strcmp(name, "id")) {
+            fIDMapper->set(SkString(value), fParents.back());
+            return false;
+        }
+        set_string_attribute(fParents.back(), name, value);
+        return false;
     }
 
-    parse_node_attributes(dom, xmlNode, node, ctx.fIDMapper);
+    bool onEndElement(const char[]) override {
+        if (fSkipDepth > 0) {
+            --fSkipDepth;
+            return false;
+        }
+        SkASSERT(!fParents.empty());
+
+        // Nodes are appended once complete, like children of their own.
+        sk_sp<SkSVGNode> node = std::move(fParents.back());
+        fParents.pop_back();
+        if (fParents.empty()) {
+            fRoot = std::move(node);
+        } else {
+            fParents.back()->appendChild(std::move(node));
+        }
+        return false;
+    }
 
-    ConstructionContext localCtx(ctx, node);
-    for (auto* child = dom.getFirstChild(xmlNode, nullptr); child;
-         child = dom.getNextSibling(child)) {
-        sk_sp<SkSVGNode> childNode = construct_svg_node(dom, localCtx, child);
-        if (childNode) {
-            node->appendChild(std::move(childNode));
+    bool onText(const char text[], int len) override {
+        if (fSkipDepth > 0 || fParents.empty()) {
+            return false;
         }
+
+        // Text literals require special handling.
+        auto txt = SkSVGTextLiteral::Make();
+        txt->setText(SkString(text, SkToSizeT(len)));
+        fParents.back()->appendChild(std::move(txt));
+        return false;
     }
 
-    return node;
-}
+private:
+    SkSVGIDMapper*                fIDMapper;
+    std::vector<sk_sp<SkSVGNode>> fParents;
+    sk_sp<SkSVGNode>              fRoot;
+    int                           fSkipDepth = 0;  // nesting level within an unhandled element
+};
 
 } // anonymous namespace
 
@@ -411,17 +442,22 @@ SkSVGDOM::Builder& SkSVGDOM::Builder::setTextShapingFactory(sk_sp<SkShapers::Fac
     return *this;
 }
 
+SkSVGDOM::Builder& SkSVGDOM::Builder::setRenderCaching(bool enabled) {
+    fRenderCaching = enabled;
+    return *this;
+}
+
 sk_sp<SkSVGDOM> SkSVGDOM::Builder::make(SkStream& str) const {
     TRACE_EVENT0("skia", TRACE_FUNC);
-    SkDOM xmlDom;
-    if (!xmlDom.build(str)) {
+    SkSVGIDMapper mapper;
+    SVGNodeBuilder builder(&mapper);
+    if (!builder.parse(str)) {
+        SkDEBUGCODE(SkDebugf("xml parse error, line %d\n",
+                             builder.fParserError.getLineNumber());)
         return nullptr;
     }
 
-    SkSVGIDMapper mapper;
-    ConstructionContext ctx(&mapper);
-
-    auto root = construct_svg_node(xmlDom, ctx, xmlDom.getRootNode());
+    auto root = builder.releaseRoot();
     if (!root || root->tag() != SkSVGTag::kSvg) {
         return nullptr;
     }
@@ -439,38 +475,99 @@ sk_sp<SkSVGDOM> SkSVGDOM::Builder::make(SkStream& str) const {
                                         std::move(fFontMgr),
                                         std::move(resource_provider),
                                         std::move(mapper),
-                                        std::move(factory)));
+                                        std::move(factory),
+                                        fRenderCaching));
 }
 
+// The last render of the document, recorded as a picture.
+class SkSVGDOM::RenderCache {
+public:
+    sk_sp<SkPicture> find(const SkSize& containerSize) {
+        SkAutoMutexExclusive lock(fMutex);
+        if (fPicture &&
+            (fContainerSize != containerSize || fGeneration != SkSVGNode::Generation())) {
+            fPicture = nullptr;
+        }
+        return fPicture;
+    }
+
+    void set(sk_sp<SkPicture> picture, const SkSize& containerSize, uint32_t generation) {
+        SkAutoMutexExclusive lock(fMutex);
+        fPicture       = std::move(picture);
+        fContainerSize = containerSize;
+        fGeneration    = generation;
+    }
+
+    void purge() {
+        SkAutoMutexExclusive lock(fMutex);
+        fPicture = nullptr;
+    }
+
+private:
+    SkMutex          fMutex;
+    sk_sp<SkPicture> fPicture       SK_GUARDED_BY(fMutex);
+    SkSize           fContainerSize SK_GUARDED_BY(fMutex) = {0, 0};
+    uint32_t         fGeneration    SK_GUARDED_BY(fMutex) = 0;
+};
+
 SkSVGDOM::SkSVGDOM(sk_sp<SkSVGSVG> root,
                    sk_sp<SkFontMgr> fmgr,
                    sk_sp<skresources::ResourceProvider> rp,
                    SkSVGIDMapper&& mapper,
-                   sk_sp<SkShapers::Factory> fact)
+                   sk_sp<SkShapers::Factory> fact,
+                   bool renderCaching)
         : fRoot(std::move(root))
         , fFontMgr(std::move(fmgr))
         , fTextShapingFactory(std::move(fact))
         , fResourceProvider(std::move(rp))
         , fIDMapper(std::move(mapper))
-        , fContainerSize(fRoot->intrinsicSize(SkSVGLengthContext(SkSize::Make(0, 0)))) {
+        , fContainerSize(fRoot->intrinsicSize(SkSVGLengthContext(SkSize::Make(0, 0))))
+        , fRenderCache(renderCaching ? std::make_unique<RenderCache>() : nullptr) {
     SkASSERT(fResourceProvider);
     SkASSERT(fTextShapingFactory);
 }
 
+SkSVGDOM::~SkSVGDOM() = default;
+
 void SkSVGDOM::render(SkCanvas* canvas) const {
     TRACE_EVENT0("skia", TRACE_FUNC);
-    if (fRoot) {
-        SkSVGLengthContext       lctx(fContainerSize);
-        SkSVGPresentationContext pctx;
-        fRoot->render(SkSVGRenderContext(canvas,
-                                         fFontMgr,
-                                         fResourceProvider,
-                                         fIDMapper,
-                                         lctx,
-                                         pctx,
-                                         {nullptr, nullptr},
-                                         fTextShapingFactory));
+    if (!fRoot) {
+        return;
+    }
+
+    if (!fRenderCache) {
+        this->renderRoot(canvas);
+        return;
     }
+
+    sk_sp<SkPicture> picture = fRenderCache->find(fContainerSize);
+    if (!picture) {
+        const uint32_t generation = SkSVGNode::Generation();
+
+        // Content may draw anywhere, so the recording is not culled.
+        SkPictureRecorder recorder;
+        this->renderRoot(recorder.beginRecording(SkRectPriv::MakeLargeS32()));
+        picture = recorder.finishRecordingAsPicture();
+
+        // Nodes modified while recording may have been rendered either way.
+        if (generation == SkSVGNode::Generation()) {
+            fRenderCache->set(picture, fContainerSize, generation);
+        }
+    }
+    canvas->drawPicture(picture);
+}
+
+void SkSVGDOM::renderRoot(SkCanvas* canvas) const {
+    SkSVGLengthContext       lctx(fContainerSize);
+    SkSVGPresentationContext pctx;
+    fRoot->render(SkSVGRenderContext(canvas,
+                                     fFontMgr,
+                                     fResourceProvider,
+                                     fIDMapper,
+                                     lctx,
+                                     pctx,
+                                     {nullptr, nullptr},
+                                     fTextShapingFactory));
 }
 
 void SkSVGDOM::renderNode(SkCanvas* canvas, SkSVGPresentationContext& pctx, const char* id) const {
@@ -495,11 +592,14 @@ const SkSize& SkSVGDOM::containerSize() const {
 }
 
 void SkSVGDOM::setContainerSize(const SkSize& containerSize) {
-    // TODO: inval
+    // Cached renders are keyed by the container size.
     fContainerSize = containerSize;
 }
 
 sk_sp<SkSVGNode>* SkSVGDOM::findNodeById(const char* id) {
+    if (fRenderCache) {
+        fRenderCache->purge();
+    }
     SkString idStr(id);
     return this->fIDMapper.find(idStr);
 }
@@ -14,6 +14,10 @@
 #include "modules/svg/include/SkSVGValue.h"
 #include "src/base/SkTLazy.h"
 
+#include <atomic>
+
+static std::atomic<uint32_t> gGeneration{0};
+
 SkSVGNode::SkSVGNode(SkSVGTag t) : fTag(t) {
     // Uninherited presentation attributes need a non-null default value.
     fPresentationAttributes.fStopColor.set(SkSVGColor(SK_ColorBLACK));
@@ -25,6 +29,14 @@ SkSVGNode::SkSVGNode(SkSVGTag t) : fTag(t) {
 
 SkSVGNode::~SkSVGNode() { }
 
+uint32_t SkSVGNode::Generation() {
+    return gGeneration.load(std::memory_order_acquire);
+}
+
+void SkSVGNode::DidModify() {
+    gGeneration.fetch_add(1, std::memory_order_release);
+}
+
 void SkSVGNode::render(const SkSVGRenderContext& ctx) const {
     SkSVGRenderContext localContext(ctx, this);
 
@@ -0,0 +1,89 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkSize.h"
+#include "include/core/SkStream.h"
+#include "modules/svg/include/SkSVGDOM.h"
+#include "modules/svg/include/SkSVGNode.h"
+#include "modules/svg/include/SkSVGRect.h"
+#include "modules/svg/include/SkSVGTypes.h"
+#include "tests/Test.h"
+
+#include <cstring>
+
+DEF_TEST(Svg_RenderCaching, r) {
+    static constexpr char svgText[] = R"EOF(
+    <svg width="100%" height="100%" viewBox="0 0 100 100" xmlns="http://www.w3.org/2000/svg">
+        <defs>
+            <linearGradient id="g">
+                <stop offset="0" stop-color="red"/>
+                <stop offset="1" stop-color="blue"/>
+            </linearGradient>
+        </defs>
+        <rect id="r" x="10" y="10" width="50" height="30" fill="url(#g)"/>
+        <circle cx="60" cy="60" r="25" fill="green" fill-opacity="0.5"/>
+    </svg>
+    )EOF";
+
+    auto make = [](bool caching) {
+        SkMemoryStream stream(svgText, strlen(svgText));
+        return SkSVGDOM::Builder().setRenderCaching(caching).make(stream);
+    };
+    auto cached   = make(true),
+         uncached = make(false);
+    REPORTER_ASSERT(r, cached && uncached);
+    if (!cached || !uncached) {
+        return;
+    }
+
+    auto render = [](const SkSVGDOM& dom) {
+        SkBitmap bm;
+        bm.allocPixels(SkImageInfo::MakeN32Premul(80, 60));
+        SkCanvas canvas(bm);
+        canvas.clear(SK_ColorTRANSPARENT);
+        dom.render(&canvas);
+        return bm;
+    };
+    auto check = [&](const char* step) {
+        const SkBitmap expected = render(*uncached);
+        for (int i = 0; i < 2; ++i) {
+            const SkBitmap actual = render(*cached);
+            REPORTER_ASSERT(r, 0 == memcmp(expected.getPixels(), actual.getPixels(),
+                                           expected.computeByteSize()),
+                            "%s, render %d", step, i);
+        }
+    };
+
+    for (auto* dom : { cached.get(), uncached.get() }) {
+        dom->setContainerSize(SkSize::Make(80, 60));
+    }
+    check("initial");
+
+    // The cached picture is keyed by the container size.
+    for (auto* dom : { cached.get(), uncached.get() }) {
+        dom->setContainerSize(SkSize::Make(60, 40));
+    }
+    check("resized");
+
+    // Modifying a node invalidates the cached picture, even without going through the DOM.
+    sk_sp<SkSVGNode>* cachedRect = cached->findNodeById("r");
+    sk_sp<SkSVGNode>* uncachedRect = uncached->findNodeById("r");
+    REPORTER_ASSERT(r, cachedRect && uncachedRect);
+    if (!cachedRect || !uncachedRect) {
+        return;
+    }
+    check("found");
+    for (auto* node : { cachedRect->get(), uncachedRect->get() }) {
+        static_cast<SkSVGRect*>(node)->setWidth(SkSVGLength(80));
+        node->setFill(SkSVGProperty<SkSVGPaint, true>(SkSVGPaint(SkSVGColor(SK_ColorMAGENTA))));
+    }
+    check("modified");
+}
@@ -142,6 +142,7 @@ SKIA_PUBLIC_HDRS = [
     "include/gpu/d3d/GrD3DBackendContext.h",
     "include/gpu/d3d/GrD3DTypes.h",
     "include/gpu/ganesh/GrExternalTextureGenerator.h",
+    "include/gpu/ganesh/GrPerfStats.h",
     "include/gpu/ganesh/SkImageGanesh.h",
     "include/gpu/ganesh/SkMeshGanesh.h",
     "include/gpu/ganesh/SkSurfaceGanesh.h",
@@ -167,6 +168,7 @@ SKIA_PUBLIC_HDRS = [
     "include/gpu/gl/GrGLConfig_chrome.h",
     "include/gpu/gl/egl/GrGLMakeEGLInterface.h",
     "include/gpu/gl/glx/GrGLMakeGLXInterface.h",
+    "include/gpu/GpuMemoryReport.h",
     "include/gpu/GpuTypes.h",
     "include/gpu/GrBackendSemaphore.h",
     "include/gpu/GrBackendSurface.h",
@@ -213,6 +215,7 @@ SKIA_PUBLIC_HDRS = [
     "include/sksl/SkSLVersion.h",
     "include/utils/SkCanvasStateUtils.h",
     "include/utils/SkCustomTypeface.h",
+    "include/utils/SkDrawStatsCanvas.h",
     "include/utils/SkEventTracer.h",
     "include/utils/SkNoDrawCanvas.h",
     "include/utils/SkNullCanvas.h",
@@ -221,7 +224,11 @@ SKIA_PUBLIC_HDRS = [
     "include/utils/SkPaintFilterCanvas.h",
     "include/utils/SkParse.h",
     "include/utils/SkParsePath.h",
+    "include/utils/SkPictureDiff.h",
+    "include/utils/SkPictureStream.h",
+    "include/utils/SkRingBufferTracer.h",
     "include/utils/SkShadowUtils.h",
+    "include/utils/SkSharedMemory.h",
     "include/utils/SkTextUtils.h",
     "include/utils/SkTraceEventPhase.h",
     "include/utils/mac/SkCGUtils.h",
@@ -297,6 +304,8 @@ BASE_SRCS_ALL = [
     "include/private/gpu/ganesh/GrTypesPriv.h",
     "src/android/SkAndroidFrameworkUtils.cpp",
     "src/android/SkAnimatedImage.cpp",
+    "src/base/SkAllocationCounters.cpp",
+    "src/base/SkAllocationCounters.h",
     "src/base/SkArenaAlloc.cpp",
     "src/base/SkArenaAlloc.h",
     "src/base/SkArenaAllocList.h",
@@ -454,6 +463,8 @@ BASE_SRCS_ALL = [
     "src/core/SkDevice.h",
     "src/core/SkDistanceFieldGen.cpp",
     "src/core/SkDistanceFieldGen.h",
+    "src/core/SkDistanceFieldGen_opts.cpp",
+    "src/core/SkDistanceFieldGen_opts_hsw.cpp",
     "src/core/SkDocument.cpp",
     "src/core/SkDraw.cpp",
     "src/core/SkDraw.h",
@@ -462,6 +473,8 @@ BASE_SRCS_ALL = [
     "src/core/SkDrawProcs.h",
     "src/core/SkDrawShadowInfo.cpp",
     "src/core/SkDrawShadowInfo.h",
+    "src/core/SkDrawStatsSink.cpp",
+    "src/core/SkDrawStatsSink.h",
     "src/core/SkDraw_atlas.cpp",
     "src/core/SkDraw_text.cpp",
     "src/core/SkDraw_vertices.cpp",
@@ -480,6 +493,8 @@ BASE_SRCS_ALL = [
     "src/core/SkFont.cpp",
     "src/core/SkFontDescriptor.cpp",
     "src/core/SkFontDescriptor.h",
+    "src/core/SkFontFallbackCache.cpp",
+    "src/core/SkFontFallbackCache.h",
     "src/core/SkFontMetricsPriv.cpp",
     "src/core/SkFontMetricsPriv.h",
     "src/core/SkFontMgr.cpp",
@@ -691,6 +706,9 @@ BASE_SRCS_ALL = [
     "src/core/SkTextBlob.cpp",
     "src/core/SkTextBlobPriv.h",
     "src/core/SkTextFormatParams.h",
+    "src/core/SkTextQuads.h",
+    "src/core/SkTextQuads_opts.cpp",
+    "src/core/SkTextQuads_opts_hsw.cpp",
     "src/core/SkTraceEvent.h",
     "src/core/SkTraceEventCommon.h",
     "src/core/SkTypeface.cpp",
@@ -786,6 +804,8 @@ BASE_SRCS_ALL = [
     "src/gpu/DataUtils.h",
     "src/gpu/DitherUtils.cpp",
     "src/gpu/DitherUtils.h",
+    "src/gpu/GpuMemoryReport.cpp",
+    "src/gpu/GpuMemoryReportPriv.h",
     "src/gpu/GpuRefCnt.h",
     "src/gpu/GpuTypesPriv.h",
     "src/gpu/KeyBuilder.h",
@@ -929,6 +949,10 @@ BASE_SRCS_ALL = [
     "src/gpu/ganesh/GrOpsTypes.h",
     "src/gpu/ganesh/GrPaint.cpp",
     "src/gpu/ganesh/GrPaint.h",
+    "src/gpu/ganesh/GrPathMeshCache.cpp",
+    "src/gpu/ganesh/GrPathMeshCache.h",
+    "src/gpu/ganesh/GrPerfStatsRecorder.cpp",
+    "src/gpu/ganesh/GrPerfStatsRecorder.h",
     "src/gpu/ganesh/GrPersistentCacheUtils.cpp",
     "src/gpu/ganesh/GrPersistentCacheUtils.h",
     "src/gpu/ganesh/GrPipeline.cpp",
@@ -1213,6 +1237,8 @@ BASE_SRCS_ALL = [
     "src/gpu/ganesh/ops/GrSimpleMeshDrawOpHelperWithStencil.h",
     "src/gpu/ganesh/ops/LatticeOp.cpp",
     "src/gpu/ganesh/ops/LatticeOp.h",
+    "src/gpu/ganesh/ops/OpChainIndex.cpp",
+    "src/gpu/ganesh/ops/OpChainIndex.h",
     "src/gpu/ganesh/ops/OpsTask.cpp",
     "src/gpu/ganesh/ops/OpsTask.h",
     "src/gpu/ganesh/ops/PathInnerTriangulateOp.cpp",
@@ -1229,6 +1255,8 @@ BASE_SRCS_ALL = [
     "src/gpu/ganesh/ops/ShadowRRectOp.h",
     "src/gpu/ganesh/ops/SmallPathAtlasMgr.cpp",
     "src/gpu/ganesh/ops/SmallPathAtlasMgr.h",
+    "src/gpu/ganesh/ops/SmallPathMaskCache.cpp",
+    "src/gpu/ganesh/ops/SmallPathMaskCache.h",
     "src/gpu/ganesh/ops/SmallPathRenderer.cpp",
     "src/gpu/ganesh/ops/SmallPathRenderer.h",
     "src/gpu/ganesh/ops/SmallPathShapeData.cpp",
@@ -1294,15 +1322,19 @@ BASE_SRCS_ALL = [
     "src/image/SkSurface_Null.cpp",
     "src/image/SkSurface_Raster.cpp",
     "src/image/SkSurface_Raster.h",
+    "src/image/SkTileStreamer.cpp",
+    "src/image/SkTileStreamer.h",
     "src/image/SkTiledImageUtils.cpp",
     "src/opts/SkBitmapProcState_opts.h",
     "src/opts/SkBlitMask_opts.h",
     "src/opts/SkBlitRow_opts.h",
+    "src/opts/SkDistanceFieldGen_opts.h",
     "src/opts/SkMemset_opts.h",
     "src/opts/SkOpts_RestoreTarget.h",
     "src/opts/SkOpts_SetTarget.h",
     "src/opts/SkRasterPipeline_opts.h",
     "src/opts/SkSwizzler_opts.inc",
+    "src/opts/SkTextQuads_opts.h",
     "src/pathops/SkAddIntersections.cpp",
     "src/pathops/SkAddIntersections.h",
     "src/pathops/SkDConicLineIntersection.cpp",
@@ -1390,6 +1422,8 @@ BASE_SRCS_ALL = [
     "src/pdf/SkPDFMakeToUnicodeCmap.h",
     "src/pdf/SkPDFMetadata.cpp",
     "src/pdf/SkPDFMetadata.h",
+    "src/pdf/SkPDFResourceCache.cpp",
+    "src/pdf/SkPDFResourceCache.h",
     "src/pdf/SkPDFResourceDict.cpp",
     "src/pdf/SkPDFResourceDict.h",
     "src/pdf/SkPDFShader.cpp",
@@ -1490,6 +1524,8 @@ BASE_SRCS_ALL = [
     "src/sksl/SkSLContext.cpp",
     "src/sksl/SkSLContext.h",
     "src/sksl/SkSLDefines.h",
+    "src/sksl/SkSLDehydrator.cpp",
+    "src/sksl/SkSLDehydrator.h",
     "src/sksl/SkSLErrorReporter.cpp",
     "src/sksl/SkSLErrorReporter.h",
     "src/sksl/SkSLFileOutputStream.h",
@@ -1518,6 +1554,8 @@ BASE_SRCS_ALL = [
     "src/sksl/SkSLPosition.h",
     "src/sksl/SkSLProgramKind.h",
     "src/sksl/SkSLProgramSettings.h",
+    "src/sksl/SkSLRehydrator.cpp",
+    "src/sksl/SkSLRehydrator.h",
     "src/sksl/SkSLSampleUsage.cpp",
     "src/sksl/SkSLString.cpp",
     "src/sksl/SkSLString.h",
@@ -1678,6 +1716,7 @@ BASE_SRCS_ALL = [
     "src/sksl/tracing/SkSLTraceHook.cpp",
     "src/sksl/tracing/SkSLTraceHook.h",
     "src/sksl/transform/SkSLAddConstToVarModifiers.cpp",
+    "src/sksl/transform/SkSLEliminateCommonSubexpressions.cpp",
     "src/sksl/transform/SkSLEliminateDeadFunctions.cpp",
     "src/sksl/transform/SkSLEliminateDeadGlobalVariables.cpp",
     "src/sksl/transform/SkSLEliminateDeadLocalVariables.cpp",
@@ -1735,6 +1774,7 @@ BASE_SRCS_ALL = [
     "src/utils/SkCustomTypeface.cpp",
     "src/utils/SkDashPath.cpp",
     "src/utils/SkDashPathPriv.h",
+    "src/utils/SkDrawStatsCanvas.cpp",
     "src/utils/SkEventTracer.cpp",
     "src/utils/SkFloatToDecimal.cpp",
     "src/utils/SkFloatToDecimal.h",
@@ -1758,13 +1798,19 @@ BASE_SRCS_ALL = [
     "src/utils/SkParsePath.cpp",
     "src/utils/SkPatchUtils.cpp",
     "src/utils/SkPatchUtils.h",
+    "src/utils/SkPictureDiff.cpp",
+    "src/utils/SkPictureStream.cpp",
     "src/utils/SkPolyUtils.cpp",
     "src/utils/SkPolyUtils.h",
+    "src/utils/SkPrefetchingStream.cpp",
+    "src/utils/SkPrefetchingStream.h",
+    "src/utils/SkRingBufferTracer.cpp",
     "src/utils/SkShaderUtils.cpp",
     "src/utils/SkShaderUtils.h",
     "src/utils/SkShadowTessellator.cpp",
     "src/utils/SkShadowTessellator.h",
     "src/utils/SkShadowUtils.cpp",
+    "src/utils/SkSharedMemory.cpp",
     "src/utils/SkTextUtils.cpp",
     "src/xps/SkXPSDevice.cpp",
     "src/xps/SkXPSDevice.h",
@@ -1772,6 +1818,8 @@ BASE_SRCS_ALL = [
 ]
 
 ENCODE_SRCS = [
+    "src/encode/SkAsyncEncoder.cpp",
+    "src/encode/SkAsyncEncoder.h",
     "src/encode/SkEncoder.cpp",
     "src/encode/SkICCPriv.h",
     "src/encode/SkICC.cpp",
@@ -1872,26 +1920,37 @@ CODEC_SRCS_ALL = CODEC_SRCS_LIMITED + [
 ]
 
 TEXTUAL_HDRS = [
+    "src/sksl/generated/sksl_compute.dehydrated.sksl",
     "src/sksl/generated/sksl_compute.minified.sksl",
     "src/sksl/generated/sksl_compute.unoptimized.sksl",
+    "src/sksl/generated/sksl_frag.dehydrated.sksl",
     "src/sksl/generated/sksl_frag.minified.sksl",
     "src/sksl/generated/sksl_frag.unoptimized.sksl",
+    "src/sksl/generated/sksl_gpu.dehydrated.sksl",
     "src/sksl/generated/sksl_gpu.minified.sksl",
     "src/sksl/generated/sksl_gpu.unoptimized.sksl",
+    "src/sksl/generated/sksl_graphite_frag.dehydrated.sksl",
     "src/sksl/generated/sksl_graphite_frag.minified.sksl",
     "src/sksl/generated/sksl_graphite_frag.unoptimized.sksl",
+    "src/sksl/generated/sksl_graphite_frag_es2.dehydrated.sksl",
     "src/sksl/generated/sksl_graphite_frag_es2.minified.sksl",
     "src/sksl/generated/sksl_graphite_frag_es2.unoptimized.sksl",
+    "src/sksl/generated/sksl_graphite_vert.dehydrated.sksl",
     "src/sksl/generated/sksl_graphite_vert.minified.sksl",
     "src/sksl/generated/sksl_graphite_vert.unoptimized.sksl",
+    "src/sksl/generated/sksl_graphite_vert_es2.dehydrated.sksl",
     "src/sksl/generated/sksl_graphite_vert_es2.minified.sksl",
     "src/sksl/generated/sksl_graphite_vert_es2.unoptimized.sksl",
+    "src/sksl/generated/sksl_public.dehydrated.sksl",
     "src/sksl/generated/sksl_public.minified.sksl",
     "src/sksl/generated/sksl_public.unoptimized.sksl",
+    "src/sksl/generated/sksl_rt_shader.dehydrated.sksl",
     "src/sksl/generated/sksl_rt_shader.minified.sksl",
     "src/sksl/generated/sksl_rt_shader.unoptimized.sksl",
+    "src/sksl/generated/sksl_shared.dehydrated.sksl",
     "src/sksl/generated/sksl_shared.minified.sksl",
     "src/sksl/generated/sksl_shared.unoptimized.sksl",
+    "src/sksl/generated/sksl_vert.dehydrated.sksl",
     "src/sksl/generated/sksl_vert.minified.sksl",
     "src/sksl/generated/sksl_vert.unoptimized.sksl",
     # Included by GrGLMakeNativeInterface_android.cpp
@@ -2319,6 +2378,7 @@ MACOS_DEFINES = [
 ################################################################################
 
 SKSG_LIB_HDRS = [
+    "modules/sksg/include/SkSGCacheEffect.h",
     "modules/sksg/include/SkSGClipEffect.h",
     "modules/sksg/include/SkSGColorFilter.h",
     "modules/sksg/include/SkSGDraw.h",
@@ -2345,6 +2405,7 @@ SKSG_LIB_HDRS = [
 ]
 
 SKSG_LIB_SRCS = [
+    "modules/sksg/src/SkSGCacheEffect.cpp",
     "modules/sksg/src/SkSGClipEffect.cpp",
     "modules/sksg/src/SkSGColorFilter.cpp",
     "modules/sksg/src/SkSGDraw.cpp",
@@ -16,8 +16,10 @@
 #include "src/codec/SkCodecPriv.h"
 #include "src/codec/SkPixmapUtilsPriv.h"
 #include "src/core/SkImagePriv.h"
+#include "src/core/SkTaskGroup.h"
 
 #include <limits.h>
+#include <algorithm>
 #include <utility>
 
 sk_sp<SkAnimatedImage> SkAnimatedImage::Make(std::unique_ptr<SkAndroidCodec> codec,
@@ -103,7 +105,9 @@ SkAnimatedImage::SkAnimatedImage(std::unique_ptr<SkAndroidCodec> codec,
     this->decodeNextFrame();
 }
 
-SkAnimatedImage::~SkAnimatedImage() { }
+SkAnimatedImage::~SkAnimatedImage() {
+    this->waitForLookahead();
+}
 
 SkRect SkAnimatedImage::onGetBounds() {
     return SkRect::MakeIWH(fCropRect.width(), fCropRect.height());
@@ -151,6 +155,7 @@ bool SkAnimatedImage::Frame::copyTo(Frame* dst) const {
 }
 
 void SkAnimatedImage::reset() {
+    this->waitForLookahead();
     fFinished = false;
     fRepetitionsCompleted = 0;
     if (fDisplayFrame.fIndex != 0) {
@@ -187,7 +192,17 @@ double SkAnimatedImage::finish() {
     return kFinished;
 }
 
+// A frame can be decoded on top of any complete frame from its required frame onward.
+template <typename Frame>
+static bool is_valid_prior_frame(const Frame& frame, int requiredFrame, int frameToDecode) {
+    if (SkCodec::kNoFrame == frame.fIndex || is_restore_previous(frame.fDisposalMethod)) {
+        return false;
+    }
+    return frame.fIndex >= requiredFrame && frame.fIndex < frameToDecode;
+}
+
 int SkAnimatedImage::decodeNextFrame() {
+    this->waitForLookahead();
     if (fFinished) {
         return kFinished;
     }
@@ -221,24 +236,98 @@ int SkAnimatedImage::decodeNextFrame() {
         }
     }
 
-    if (frameToDecode == fDisplayFrame.fIndex) {
-        if (animationEnded) {
+    const bool decoded = this->isDecoded(frameToDecode);
+    if (!this->showFrame(frameToDecode, frameInfo.fRequiredFrame, frameInfo.fAlphaType,
+                         frameInfo.fDisposalMethod)) {
+        return this->finish();
+    }
+
+    if (animationEnded) {
+        return this->finish();
+    } else if (!decoded && fCodec->getEncodedFormat() == SkEncodedImageFormat::kHEIF) {
+        // HEIF doesn't know the frame duration until after decoding. Update to
+        // the correct value. Note that earlier returns in this method either
+        // return kFinished, or fCurrentFrameDuration. If they return the
+        // latter, it is a frame that was previously decoded, so it has the
+        // updated value.
+        if (fCodec->codec()->getFrameInfo(frameToDecode, &frameInfo)) {
+            fCurrentFrameDuration = frameInfo.fDuration;
+        } else {
+            SkCodecPrintf("Failed to getFrameInfo on second attempt (HEIF)");
+        }
+    }
+    this->startLookahead();
+    return fCurrentFrameDuration;
+}
+
+int SkAnimatedImage::seekFrame(int frameIndex) {
+    this->waitForLookahead();
+
+    SkCodec::FrameInfo frameInfo;
+    if (!fCodec->codec()->getFrameInfo(frameIndex, &frameInfo) || !frameInfo.fFullyReceived) {
+        // A still image has no frame info, but its only frame is already showing.
+        return frameIndex == fDisplayFrame.fIndex ? fCurrentFrameDuration : kFinished;
+    }
+
+    // Walk back through the required frames until one can be built on something already
+    // decoded, then decode forward from there. Each frame in the chain is the required frame of
+    // the one before it, so it is always a valid starting point for that one.
+    std::vector<SkCodec::FrameInfo> chainInfos = {frameInfo};
+    std::vector<int> chain = {frameIndex};
+    while (!this->isDecoded(chain.back()) &&
+           chainInfos.back().fRequiredFrame != SkCodec::kNoFrame &&
+           !this->hasPriorFrame(chain.back(), chainInfos.back().fRequiredFrame)) {
+        const int requiredFrame = chainInfos.back().fRequiredFrame;
+        SkCodec::FrameInfo requiredInfo;
+        if (!fCodec->codec()->getFrameInfo(requiredFrame, &requiredInfo)) {
             return this->finish();
         }
-        return fCurrentFrameDuration;
+        chain.push_back(requiredFrame);
+        chainInfos.push_back(requiredInfo);
     }
 
-    for (Frame* frame : { &fRestoreFrame, &fDecodingFrame }) {
+    fFinished = false;
+    for (size_t i = chain.size(); i-- > 0;) {
+        const SkCodec::FrameInfo& info = chainInfos[i];
+        if (!this->showFrame(chain[i], info.fRequiredFrame, info.fAlphaType,
+                             info.fDisposalMethod)) {
+            return this->finish();
+        }
+    }
+
+    // Re-read the duration, which HEIF only knows after decoding.
+    fCurrentFrameDuration = fCodec->codec()->getFrameInfo(frameIndex, &frameInfo)
+                                    ? frameInfo.fDuration
+                                    : chainInfos.front().fDuration;
+    this->startLookahead();
+    return fCurrentFrameDuration;
+}
+
+bool SkAnimatedImage::showFrame(int frameToDecode, int requiredFrame, SkAlphaType frameAlphaType,
+                                SkCodecAnimation::DisposalMethod disposalMethod) {
+    if (frameToDecode == fDisplayFrame.fIndex) {
+        return true;
+    }
+
+    for (Frame* frame : { &fRestoreFrame, &fDecodingFrame, &fLookaheadFrame }) {
         if (frameToDecode == frame->fIndex) {
             using std::swap;
             swap(fDisplayFrame, *frame);
-            if (animationEnded) {
-                return this->finish();
+            if (frame == &fLookaheadFrame) {
+                this->cacheFrame(fDisplayFrame, requiredFrame == SkCodec::kNoFrame);
             }
-            return fCurrentFrameDuration;
+            return true;
         }
     }
 
+    if (const Frame* cached = this->findCachedFrame(frameToDecode)) {
+        // Keep the old display frame around as a starting point, like a decode would.
+        using std::swap;
+        swap(fDecodingFrame, fDisplayFrame);
+        fDisplayFrame = *cached;
+        return true;
+    }
+
     // The following code makes an effort to avoid overwriting a frame that will
     // be used again. If frame |i| is_restore_previous, frame |i+1| will not
     // depend on frame |i|, so do not overwrite frame |i-1|, which may be needed
@@ -248,8 +337,8 @@ int SkAnimatedImage::decodeNextFrame() {
     SkAndroidCodec::AndroidOptions options;
     options.fSampleSize = fSampleSize;
     options.fFrameIndex = frameToDecode;
-    if (frameInfo.fRequiredFrame == SkCodec::kNoFrame) {
-        if (is_restore_previous(frameInfo.fDisposalMethod)) {
+    if (requiredFrame == SkCodec::kNoFrame) {
+        if (is_restore_previous(disposalMethod)) {
             // frameToDecode will be discarded immediately after drawing, so
             // do not overwrite a frame which could possibly be used in the
             // future.
@@ -260,16 +349,11 @@ int SkAnimatedImage::decodeNextFrame() {
             }
         }
     } else {
-        auto validPriorFrame = [&frameInfo, &frameToDecode](const Frame& frame) {
-            if (SkCodec::kNoFrame == frame.fIndex ||
-                    is_restore_previous(frame.fDisposalMethod)) {
-                return false;
-            }
-
-            return frame.fIndex >= frameInfo.fRequiredFrame && frame.fIndex < frameToDecode;
+        auto validPriorFrame = [requiredFrame, frameToDecode](const Frame& frame) {
+            return is_valid_prior_frame(frame, requiredFrame, frameToDecode);
         };
         if (validPriorFrame(fDecodingFrame)) {
-            if (is_restore_previous(frameInfo.fDisposalMethod)) {
+            if (is_restore_previous(disposalMethod)) {
                 // fDecodingFrame is a good frame to use for this one, but we
                 // don't want to overwrite it.
                 fDecodingFrame.copyTo(&fRestoreFrame);
@@ -278,27 +362,34 @@ int SkAnimatedImage::decodeNextFrame() {
         } else if (validPriorFrame(fDisplayFrame)) {
             if (!fDisplayFrame.copyTo(&fDecodingFrame)) {
                 SkCodecPrintf("Failed to allocate pixels for frame\n");
-                return this->finish();
+                return false;
             }
             options.fPriorFrame = fDecodingFrame.fIndex;
         } else if (validPriorFrame(fRestoreFrame)) {
-            if (!is_restore_previous(frameInfo.fDisposalMethod)) {
+            if (!is_restore_previous(disposalMethod)) {
                 using std::swap;
                 swap(fDecodingFrame, fRestoreFrame);
             } else if (!fRestoreFrame.copyTo(&fDecodingFrame)) {
                 SkCodecPrintf("Failed to restore frame\n");
-                return this->finish();
+                return false;
+            }
+            options.fPriorFrame = fDecodingFrame.fIndex;
+        } else if (const Frame* cached = this->findCachedPriorFrame(frameToDecode,
+                                                                    requiredFrame)) {
+            if (!cached->copyTo(&fDecodingFrame)) {
+                SkCodecPrintf("Failed to allocate pixels for frame\n");
+                return false;
             }
             options.fPriorFrame = fDecodingFrame.fIndex;
         }
     }
 
-    auto alphaType = kOpaque_SkAlphaType == frameInfo.fAlphaType ?
+    auto alphaType = kOpaque_SkAlphaType == frameAlphaType ?
                      kOpaque_SkAlphaType : kPremul_SkAlphaType;
     auto info = fDecodeInfo.makeAlphaType(alphaType);
     SkBitmap* dst = &fDecodingFrame.fBitmap;
     if (!fDecodingFrame.init(info, Frame::OnInit::kRestoreIfNecessary)) {
-        return this->finish();
+        return false;
     }
 
     auto result = fCodec->getAndroidPixels(dst->info(), dst->getPixels(), dst->rowBytes(),
@@ -306,31 +397,166 @@ int SkAnimatedImage::decodeNextFrame() {
     if (result != SkCodec::kSuccess) {
         SkCodecPrintf("%s, frame %i of %i\n", SkCodec::ResultToString(result),
                       frameToDecode, fFrameCount);
-        return this->finish();
+        return false;
     }
 
     fDecodingFrame.fIndex = frameToDecode;
-    fDecodingFrame.fDisposalMethod = frameInfo.fDisposalMethod;
+    fDecodingFrame.fDisposalMethod = disposalMethod;
 
     using std::swap;
     swap(fDecodingFrame, fDisplayFrame);
     fDisplayFrame.fBitmap.notifyPixelsChanged();
+    this->cacheFrame(fDisplayFrame, requiredFrame == SkCodec::kNoFrame);
+    return true;
+}
 
-    if (animationEnded) {
-        return this->finish();
-    } else if (fCodec->getEncodedFormat() == SkEncodedImageFormat::kHEIF) {
-        // HEIF doesn't know the frame duration until after decoding. Update to
-        // the correct value. Note that earlier returns in this method either
-        // return kFinished, or fCurrentFrameDuration. If they return the
-        // latter, it is a frame that was previously decoded, so it has the
-        // updated value.
-        if (fCodec->codec()->getFrameInfo(frameToDecode, &frameInfo)) {
-            fCurrentFrameDuration = frameInfo.fDuration;
-        } else {
-            SkCodecPrintf("Failed to getFrameInfo on second attempt (HEIF)");
+bool SkAnimatedImage::isDecoded(int frameIndex) const {
+    for (const Frame* frame : { &fDisplayFrame, &fDecodingFrame, &fRestoreFrame,
+                                &fLookaheadFrame }) {
+        if (frame->fIndex == frameIndex) {
+            return true;
         }
     }
-    return fCurrentFrameDuration;
+    return std::any_of(fFrameCache.begin(), fFrameCache.end(), [frameIndex](const auto& cached) {
+        return cached.fFrame.fIndex == frameIndex;
+    });
+}
+
+bool SkAnimatedImage::hasPriorFrame(int frameToDecode, int requiredFrame) const {
+    for (const Frame* frame : { &fDisplayFrame, &fDecodingFrame, &fRestoreFrame }) {
+        if (is_valid_prior_frame(*frame, requiredFrame, frameToDecode)) {
+            return true;
+        }
+    }
+    return std::any_of(fFrameCache.begin(), fFrameCache.end(), [&](const auto& cached) {
+        return is_valid_prior_frame(cached.fFrame, requiredFrame, frameToDecode);
+    });
+}
+
+const SkAnimatedImage::Frame* SkAnimatedImage::findCachedFrame(int frameIndex) {
+    auto it = std::find_if(fFrameCache.begin(), fFrameCache.end(), [frameIndex](const auto& c) {
+        return c.fFrame.fIndex == frameIndex;
+    });
+    if (it == fFrameCache.end()) {
+        return nullptr;
+    }
+    // Mark it as the most recently used.
+    std::rotate(it, it + 1, fFrameCache.end());
+    return &fFrameCache.back().fFrame;
+}
+
+const SkAnimatedImage::Frame* SkAnimatedImage::findCachedPriorFrame(int frameToDecode,
+                                                                    int requiredFrame) {
+    // Any valid prior frame costs a single decode, so prefer the latest one, which is the most
+    // likely to be reused by the frames that follow.
+    int best = SkCodec::kNoFrame;
+    for (const CachedFrame& cached : fFrameCache) {
+        if (is_valid_prior_frame(cached.fFrame, requiredFrame, frameToDecode)) {
+            best = std::max(best, cached.fFrame.fIndex);
+        }
+    }
+    return best == SkCodec::kNoFrame ? nullptr : this->findCachedFrame(best);
+}
+
+void SkAnimatedImage::cacheFrame(const Frame& frame, bool independent) {
+    const size_t bytes = frame.fBitmap.computeByteSize();
+    if (bytes > fFrameCacheBudget || frame.fIndex == SkCodec::kNoFrame ||
+        this->findCachedFrame(frame.fIndex)) {
+        return;
+    }
+    fFrameCache.push_back({frame, independent});
+    fFrameCacheBytes += bytes;
+    this->trimFrameCache();
+}
+
+void SkAnimatedImage::trimFrameCache() {
+    while (fFrameCacheBytes > fFrameCacheBudget) {
+        // Evict the least recently used frame that depends on others, then keyframes.
+        auto victim = std::find_if(fFrameCache.begin(), fFrameCache.end(),
+                                   [](const CachedFrame& c) { return !c.fIndependent; });
+        if (victim == fFrameCache.end()) {
+            victim = fFrameCache.begin();
+        }
+        fFrameCacheBytes -= victim->fFrame.fBitmap.computeByteSize();
+        fFrameCache.erase(victim);
+    }
+}
+
+void SkAnimatedImage::setFrameCacheBudget(size_t bytes) {
+    fFrameCacheBudget = bytes;
+    this->trimFrameCache();
+}
+
+void SkAnimatedImage::setLookaheadExecutor(SkExecutor* executor) {
+    this->waitForLookahead();
+    fLookahead.reset();
+    fLookaheadExecutor = executor;
+    if (executor) {
+        fLookahead = std::make_unique<SkTaskGroup>(*executor);
+    } else {
+        fLookaheadFrame = Frame();
+    }
+}
+
+void SkAnimatedImage::waitForLookahead() {
+    if (fLookahead) {
+        fLookahead->wait();
+    }
+}
+
+void SkAnimatedImage::startLookahead() {
+    if (!fLookahead || fFinished || fFrameCount <= 1) {
+        return;
+    }
+    const int frameToDecode = fDisplayFrame.fIndex + 1 == fFrameCount ? 0
+                                                                       : fDisplayFrame.fIndex + 1;
+    SkCodec::FrameInfo frameInfo;
+    if (this->isDecoded(frameToDecode) ||
+        !fCodec->codec()->getFrameInfo(frameToDecode, &frameInfo) ||
+        !frameInfo.fFullyReceived) {
+        return;
+    }
+
+    SkAndroidCodec::AndroidOptions options;
+    options.fSampleSize = fSampleSize;
+    options.fFrameIndex = frameToDecode;
+    const Frame* prior = nullptr;
+    if (frameInfo.fRequiredFrame != SkCodec::kNoFrame) {
+        for (const Frame* frame : { &fDisplayFrame, &fDecodingFrame, &fRestoreFrame }) {
+            if (is_valid_prior_frame(*frame, frameInfo.fRequiredFrame, frameToDecode)) {
+                prior = frame;
+                break;
+            }
+        }
+    }
+    auto alphaType = kOpaque_SkAlphaType == frameInfo.fAlphaType ?
+                     kOpaque_SkAlphaType : kPremul_SkAlphaType;
+    const SkImageInfo info = fDecodeInfo.makeAlphaType(alphaType);
+    const SkCodecAnimation::DisposalMethod disposalMethod = frameInfo.fDisposalMethod;
+
+    // Until the next wait, the task owns fCodec and fLookaheadFrame and only reads the frame
+    // it starts from. The main thread only reads fDisplayFrame (to draw it) in the meantime.
+    fLookaheadFrame.fIndex = SkCodec::kNoFrame;
+    fLookahead->add([this, prior, info, options, frameToDecode, disposalMethod]() mutable {
+        Frame* dst = &fLookaheadFrame;
+        if (prior) {
+            if (!prior->copyTo(dst)) {
+                dst->fIndex = SkCodec::kNoFrame;
+                return;
+            }
+            options.fPriorFrame = prior->fIndex;
+        }
+        // After copyTo() the pixels are unique, so init() only updates the alpha type.
+        if (!dst->init(info, Frame::OnInit::kNoRestore) ||
+            fCodec->getAndroidPixels(dst->fBitmap.info(), dst->fBitmap.getPixels(),
+                                     dst->fBitmap.rowBytes(), &options) != SkCodec::kSuccess) {
+            dst->fIndex = SkCodec::kNoFrame;
+            return;
+        }
+        dst->fIndex = frameToDecode;
+        dst->fDisposalMethod = disposalMethod;
+        dst->fBitmap.notifyPixelsChanged();
+    });
 }
 
 void SkAnimatedImage::onDraw(SkCanvas* canvas) {
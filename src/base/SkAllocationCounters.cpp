@@ -0,0 +1,88 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/base/SkAllocationCounters.h"
+
+#include <algorithm>
+#include <atomic>
+
+namespace {
+std::atomic<bool> gEnabled{false};
+
+struct Counter {
+    std::atomic<size_t> fCurrent{0};
+    std::atomic<size_t> fPeak{0};
+};
+
+Counter gCounters[SkAllocationCounters::kCategoryCount];
+
+Counter& counter(SkAllocationCategory category) {
+    return gCounters[static_cast<int>(category)];
+}
+}  // namespace
+
+bool SkAllocationCounters::SetEnabled(bool enabled) {
+    return gEnabled.exchange(enabled, std::memory_order_relaxed);
+}
+
+bool SkAllocationCounters::IsEnabled() {
+    return gEnabled.load(std::memory_order_relaxed);
+}
+
+SkAllocationCounters::Counts SkAllocationCounters::Get(SkAllocationCategory category) {
+    Counter& c = counter(category);
+    Counts counts;
+    counts.fCurrent = c.fCurrent.load(std::memory_order_relaxed);
+    counts.fPeak = std::max(c.fPeak.load(std::memory_order_relaxed), counts.fCurrent);
+    return counts;
+}
+
+void SkAllocationCounters::ResetPeaks() {
+    for (Counter& c : gCounters) {
+        c.fPeak.store(c.fCurrent.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+}
+
+const char* SkAllocationCounters::Name(SkAllocationCategory category) {
+    switch (category) {
+        case SkAllocationCategory::kArenaAlloc: return "arena_alloc";
+        case SkAllocationCategory::kRecord:     return "record";
+        case SkAllocationCategory::kPDF:        return "pdf";
+        case SkAllocationCategory::kCodec:      return "codec";
+    }
+    return "";
+}
+
+void SkAllocationCounters::Add(SkAllocationCategory category, size_t bytes) {
+    Counter& c = counter(category);
+    const size_t current = c.fCurrent.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    size_t peak = c.fPeak.load(std::memory_order_relaxed);
+    while (peak < current &&
+           !c.fPeak.compare_exchange_weak(peak, current, std::memory_order_relaxed)) {}
+}
+
+void SkAllocationCounters::Subtract(SkAllocationCategory category, size_t bytes) {
+    counter(category).fCurrent.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+void SkAccountedBytes::set(size_t bytes) {
+    if (bytes < fBytes) {
+        SkAllocationCounters::Subtract(fCategory, fBytes - bytes);
+        fBytes = bytes;
+    } else if (bytes > fBytes && SkAllocationCounters::IsEnabled()) {
+        SkAllocationCounters::Add(fCategory, bytes - fBytes);
+        fBytes = bytes;
+    }
+}
+
+void SkAccountedBytes::setCategory(SkAllocationCategory category) {
+    if (category != fCategory && fBytes > 0) {
+        SkAllocationCounters::Subtract(fCategory, fBytes);
+        SkAllocationCounters::Add(category, fBytes);
+    }
+    fCategory = category;
+}
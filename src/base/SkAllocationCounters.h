@@ -0,0 +1,74 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkAllocationCounters_DEFINED
+#define SkAllocationCounters_DEFINED
+
+#include <cstddef>
+
+// The subsystems whose memory SkAllocationCounters counts.
+enum class SkAllocationCategory {
+    kArenaAlloc,  // heap blocks of SkArenaAllocs not counted below
+    kRecord,      // SkRecord commands and their record arrays
+    kPDF,         // PDF streams waiting to be written out
+    kCodec,       // codecs' row and color transform buffers
+
+    kLast = kCodec,
+};
+
+// Process-wide counters of the current and peak bytes allocated by a few subsystems, meant for
+// finding what causes memory spikes without a heap profiler. Counting is off by default, and
+// costs one relaxed atomic load per counted allocation while off.
+class SkAllocationCounters {
+public:
+    static constexpr int kCategoryCount = static_cast<int>(SkAllocationCategory::kLast) + 1;
+
+    // Returns the previous setting. Turning counting off keeps the counts, which still go down
+    // as memory counted earlier is freed.
+    static bool SetEnabled(bool enabled);
+    static bool IsEnabled();
+
+    struct Counts {
+        size_t fCurrent = 0;
+        size_t fPeak = 0;  // since the last ResetPeaks()
+    };
+    static Counts Get(SkAllocationCategory);
+
+    // Sets each peak to the current count, e.g. at the start of a frame.
+    static void ResetPeaks();
+
+    static const char* Name(SkAllocationCategory);
+
+    static void Add(SkAllocationCategory, size_t bytes);
+    static void Subtract(SkAllocationCategory, size_t bytes);
+};
+
+// The bytes one owner has counted in a category. It only counts growth while counting is on, and
+// subtracts what it counted when it shrinks or is destroyed, so the counts stay balanced when
+// counting is turned on or off in between.
+class SkAccountedBytes {
+public:
+    explicit SkAccountedBytes(SkAllocationCategory category) : fCategory(category) {}
+    ~SkAccountedBytes() { this->set(0); }
+
+    SkAccountedBytes(const SkAccountedBytes&) = delete;
+    SkAccountedBytes& operator=(const SkAccountedBytes&) = delete;
+
+    void set(size_t bytes);
+    void add(size_t bytes) { this->set(fBytes + bytes); }
+
+    // Moves the bytes counted so far to another category.
+    void setCategory(SkAllocationCategory);
+
+    size_t bytes() const { return fBytes; }
+
+private:
+    SkAllocationCategory fCategory;
+    size_t               fBytes = 0;
+};
+
+#endif  // SkAllocationCounters_DEFINED
@@ -8,13 +8,148 @@
 #include "src/base/SkArenaAlloc.h"
 
 #include "include/private/base/SkMalloc.h"
+#include "src/base/SkMathPriv.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cstddef>
 
 static char* end_chain(char*) { return nullptr; }
 
+namespace {
+// Blocks are cached in classes by the power of two below their size, from 256 bytes up to 64KB.
+constexpr int kMinBlockClass = 8;
+constexpr int kMaxBlockClass = 15;
+constexpr int kBlockClassCount = kMaxBlockClass - kMinBlockClass + 1;
+constexpr int kBlocksPerClass = 4;
+constexpr size_t kMaxCachedBytes = 256 * 1024;
+
+std::atomic<bool> gBlockRecycling{false};
+
+// This is trivially destructible so that arenas freed while the thread exits, after
+// BlockCacheOwner's destructor has run, can still see fExited and free their blocks directly.
+struct BlockCache {
+    struct Block {
+        char*    fPtr;
+        uint32_t fSize;
+    };
+    Block    fBlocks[kBlockClassCount][kBlocksPerClass];
+    int      fCounts[kBlockClassCount];
+    size_t   fBytes;
+    uint64_t fAllocated;
+    uint64_t fReused;
+    bool     fOwned;
+    bool     fExited;
+
+    // Returns a cached block of at least *size bytes and sets *size to its size, or returns null.
+    char* take(uint32_t* size) {
+        const int sizeClass = std::max(kMinBlockClass, SkPrevLog2(*size));
+        // Any block from the class above is big enough.
+        for (int c = sizeClass; c <= std::min(sizeClass + 1, kMaxBlockClass); c++) {
+            Block* blocks = fBlocks[c - kMinBlockClass];
+            int& count = fCounts[c - kMinBlockClass];
+            for (int i = count - 1; i >= 0; i--) {
+                if (blocks[i].fSize >= *size) {
+                    const Block block = blocks[i];
+                    blocks[i] = blocks[--count];
+                    fBytes -= block.fSize;
+                    *size = block.fSize;
+                    return block.fPtr;
+                }
+            }
+        }
+        return nullptr;
+    }
+
+    bool put(char* ptr, uint32_t size);
+
+    void purge() {
+        for (int c = 0; c < kBlockClassCount; c++) {
+            for (int i = 0; i < fCounts[c]; i++) {
+                sk_free(fBlocks[c][i].fPtr);
+            }
+            fCounts[c] = 0;
+        }
+        fBytes = 0;
+    }
+};
+
+thread_local BlockCache gBlockCache;
+
+struct BlockCacheOwner {
+    ~BlockCacheOwner() {
+        gBlockCache.purge();
+        gBlockCache.fExited = true;
+    }
+};
+
+thread_local BlockCacheOwner gBlockCacheOwner;
+
+bool BlockCache::put(char* ptr, uint32_t size) {
+    const int sizeClass = SkPrevLog2(size);
+    if (fExited || sizeClass < kMinBlockClass || sizeClass > kMaxBlockClass ||
+        fCounts[sizeClass - kMinBlockClass] == kBlocksPerClass ||
+        fBytes + size > kMaxCachedBytes) {
+        return false;
+    }
+    if (!fOwned) {
+        // Using the owner registers its destructor to run when this thread exits.
+        (void)&gBlockCacheOwner;
+        fOwned = true;
+    }
+    // Cached blocks are poisoned like freed memory until an arena takes them.
+    sk_asan_poison_memory_region(ptr, size);
+    int& count = fCounts[sizeClass - kMinBlockClass];
+    fBlocks[sizeClass - kMinBlockClass][count++] = {ptr, size};
+    fBytes += size;
+    return true;
+}
+}  // namespace
+
+static char* allocate_block(uint32_t* size) {
+    if (gBlockRecycling.load(std::memory_order_relaxed)) {
+        BlockCache& cache = gBlockCache;
+        if (char* block = cache.take(size)) {
+            cache.fReused++;
+            return block;
+        }
+        cache.fAllocated++;
+    }
+    return static_cast<char*>(sk_malloc_throw(*size));
+}
+
+static void free_block(char* block, uint32_t size) {
+    if (gBlockRecycling.load(std::memory_order_relaxed) && gBlockCache.put(block, size)) {
+        return;
+    }
+    sk_free(block);
+}
+
+bool SkArenaAlloc::SetBlockRecycling(bool enabled) {
+    const bool wasEnabled = gBlockRecycling.exchange(enabled, std::memory_order_relaxed);
+    if (!enabled) {
+        PurgeThreadBlockCache();
+    }
+    return wasEnabled;
+}
+
+SkArenaAlloc::BlockRecyclingStats SkArenaAlloc::ThreadBlockRecyclingStats() {
+    const BlockCache& cache = gBlockCache;
+    BlockRecyclingStats stats;
+    stats.fAllocated = cache.fAllocated;
+    stats.fReused = cache.fReused;
+    stats.fCachedBytes = cache.fBytes;
+    for (int count : cache.fCounts) {
+        stats.fCachedBlocks += count;
+    }
+    return stats;
+}
+
+void SkArenaAlloc::PurgeThreadBlockCache() {
+    gBlockCache.purge();
+}
+
 SkArenaAlloc::SkArenaAlloc(char* block, size_t size, size_t firstHeapAllocation)
     : fDtorCursor {block}
     , fCursor     {block}
@@ -62,16 +197,18 @@ void SkArenaAlloc::RunDtorsOnBlock(char* footerEnd) {
 }
 
 char* SkArenaAlloc::NextBlock(char* footerEnd) {
-    char* objEnd = footerEnd - (sizeof(char*) + sizeof(Footer));
+    char* objEnd = footerEnd - (sizeof(char*) + sizeof(uint32_t) + sizeof(Footer));
     char* next;
+    uint32_t blockSize;
     memmove(&next, objEnd, sizeof(char*));
+    memmove(&blockSize, objEnd + sizeof(char*), sizeof(uint32_t));
     RunDtorsOnBlock(next);
-    sk_free(objEnd);
+    free_block(objEnd, blockSize);
     return nullptr;
 }
 
 void SkArenaAlloc::ensureSpace(uint32_t size, uint32_t alignment) {
-    constexpr uint32_t headerSize = sizeof(Footer) + sizeof(ptrdiff_t);
+    constexpr uint32_t headerSize = sizeof(Footer) + sizeof(ptrdiff_t) + sizeof(uint32_t);
     constexpr uint32_t maxSize = std::numeric_limits<uint32_t>::max();
     constexpr uint32_t overhead = headerSize + sizeof(Footer);
     AssertRelease(size <= maxSize - overhead);
@@ -92,7 +229,9 @@ void SkArenaAlloc::ensureSpace(uint32_t size, uint32_t alignment) {
         allocationSize = (allocationSize + mask) & ~mask;
     }
 
-    char* newBlock = static_cast<char*>(sk_malloc_throw(allocationSize));
+    // A recycled block may be bigger than asked for.
+    char* newBlock = allocate_block(&allocationSize);
+    fHeapBytes.add(allocationSize);
 
     auto previousDtor = fDtorCursor;
     fCursor = newBlock;
@@ -103,6 +242,7 @@ void SkArenaAlloc::ensureSpace(uint32_t size, uint32_t alignment) {
     sk_asan_poison_memory_region(fCursor, fEnd - fCursor);
 
     this->installRaw(previousDtor);
+    this->installRaw(allocationSize);
     this->installFooter(NextBlock, 0);
 }
 
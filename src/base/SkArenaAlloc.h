@@ -12,6 +12,7 @@
 #include "include/private/base/SkAssert.h"
 #include "include/private/base/SkTFitsIn.h"
 #include "include/private/base/SkTo.h"
+#include "src/base/SkAllocationCounters.h"
 
 #include <algorithm>
 #include <array>
@@ -116,6 +117,31 @@ public:
 
     ~SkArenaAlloc();
 
+    // Heap blocks can be recycled through a small cache on each thread: when recycling is on,
+    // blocks freed by an arena are kept, a few per power-of-two size class, and handed to the next
+    // arena on the same thread that needs a block that size. This saves the malloc and free of
+    // short-lived arenas, like those made while setting up a draw. It is off by default. Turning it
+    // off frees the calling thread's cached blocks; other threads free theirs when they exit.
+    static bool SetBlockRecycling(bool enabled);
+
+    // Counted for the calling thread, while recycling is on.
+    struct BlockRecyclingStats {
+        uint64_t fAllocated = 0;     // blocks allocated from the heap
+        uint64_t fReused = 0;        // blocks taken from the cache
+        size_t   fCachedBytes = 0;   // memory held by the cache
+        int      fCachedBlocks = 0;  // blocks held by the cache
+    };
+    static BlockRecyclingStats ThreadBlockRecyclingStats();
+
+    // Frees the blocks cached by the calling thread.
+    static void PurgeThreadBlockCache();
+
+    // The arena's heap blocks are counted under kArenaAlloc in SkAllocationCounters, unless the
+    // owner says they belong to another subsystem.
+    void setAllocationCategory(SkAllocationCategory category) {
+        fHeapBytes.setCategory(category);
+    }
+
     template <typename Ctor>
     auto make(Ctor&& ctor) -> decltype(ctor(nullptr)) {
         using T = std::remove_pointer_t<decltype(ctor(nullptr))>;
@@ -302,6 +328,8 @@ private:
     char*          fEnd;
 
     SkFibBlockSizes<std::numeric_limits<uint32_t>::max()> fFibonacciProgression;
+
+    SkAccountedBytes fHeapBytes{SkAllocationCategory::kArenaAlloc};
 };
 
 class SkArenaAllocWithReset : public SkArenaAlloc {
@@ -11,8 +11,12 @@
 #include "include/private/base/SkTo.h"
 #include "src/base/SkMathPriv.h"
 
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -211,4 +215,81 @@ template <typename T> void SkTQSort(T** begin, T** end) {
     SkTQSort(begin, end, [](const T* a, const T* b) { return *a < *b; });
 }
 
+/**
+ *  Sorts the region from begin to end by unsigned integer keys with a least significant digit
+ *  radix sort, which is stable and takes time linear in the number of items. An item's key is
+ *  kKeyWords 64 bit words, which keyWord(item, i) returns from least (i = 0) to most significant.
+ *  Bytes that are the same in every key take no pass, so keys that leave most of their bits unused
+ *  sort in only a few passes. The per pass overhead makes this slower than SkTQSort or std::sort
+ *  for small counts.
+ *
+ *  @param begin points to the beginning of the region to be sorted
+ *  @param end points past the end of the region to be sorted
+ *  @param scratch points to room for as many items as are sorted
+ *  @param keyWord a functor/lambda which returns the i-th word of an item's key
+ */
+template <int kKeyWords, typename T, typename K>
+void SkTRadixSort(T* begin, T* end, T* scratch, const K& keyWord) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    const int n = SkToInt(end - begin);
+    if (n <= 1) {
+        return;
+    }
+
+    // Find the bits that differ between keys. Only the bytes holding them need a pass, and only
+    // those are counted; counting a byte that rarely changes is slow since every item increments
+    // the same count.
+    uint64_t orBits[kKeyWords] = {};
+    uint64_t andBits[kKeyWords];
+    for (int w = 0; w < kKeyWords; ++w) {
+        andBits[w] = ~uint64_t(0);
+    }
+    for (int i = 0; i < n; ++i) {
+        for (int w = 0; w < kKeyWords; ++w) {
+            uint64_t word = keyWord(begin[i], w);
+            orBits[w] |= word;
+            andBits[w] &= word;
+        }
+    }
+    int digits[8 * kKeyWords];
+    int digitCount = 0;
+    for (int d = 0; d < 8 * kKeyWords; ++d) {
+        if (((orBits[d / 8] ^ andBits[d / 8]) >> (8 * (d % 8))) & 0xFF) {
+            digits[digitCount++] = d;
+        }
+    }
+    if (!digitCount) {
+        return;
+    }
+
+    std::vector<uint32_t> counts(digitCount * 256, 0);
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < digitCount; ++j) {
+            const int d = digits[j];
+            counts[j * 256 + ((keyWord(begin[i], d / 8) >> (8 * (d % 8))) & 0xFF)]++;
+        }
+    }
+
+    T* src = begin;
+    T* dst = scratch;
+    for (int j = 0; j < digitCount; ++j) {
+        const int w = digits[j] / 8;
+        const int shift = 8 * (digits[j] % 8);
+        uint32_t* offsets = &counts[j * 256];
+        uint32_t offset = 0;
+        for (int v = 0; v < 256; ++v) {
+            uint32_t count = offsets[v];
+            offsets[v] = offset;
+            offset += count;
+        }
+        for (int i = 0; i < n; ++i) {
+            dst[offsets[(keyWord(src[i], w) >> shift) & 0xFF]++] = src[i];
+        }
+        std::swap(src, dst);
+    }
+    if (src != begin) {
+        std::copy(src, src + n, begin);
+    }
+}
+
 #endif
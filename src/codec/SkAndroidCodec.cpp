@@ -327,7 +327,7 @@ sk_sp<SkColorSpace> SkAndroidCodec::computeOutputColorSpace(SkColorType outputCo
                         return cicpColorSpace;
                     }
                 }
-                if (auto encodedSpace = SkColorSpace::Make(*encodedProfile)) {
+                if (auto encodedSpace = fCodec->getEncodedInfo().profileColorSpace()) {
                     // Leave the pixels in the encoded color space.  Color space conversion
                     // will be handled after decode time.
                     return encodedSpace;
@@ -15,11 +15,14 @@
 #include "include/core/SkSize.h"
 #include "include/core/SkStream.h"
 #include "include/core/SkTypes.h"
+#include "include/private/base/SkTo.h"
 #include "modules/skcms/skcms.h"
 #include "src/core/SkStreamPriv.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <cstring>
+#include <thread>
 #include <utility>
 
 #include "avif/avif.h"
@@ -59,7 +62,7 @@ std::unique_ptr<SkCodec> SkAvifCodec::MakeFromStream(std::unique_ptr<SkStream> s
     avifDecoder->allowProgressive = AVIF_FALSE;
     avifDecoder->allowIncremental = AVIF_FALSE;
     avifDecoder->strictFlags = AVIF_STRICT_DISABLED;
-    // TODO(vigneshv): Enable threading based on number of CPU cores available.
+    // onGetPixels() raises this when it is given an executor.
     avifDecoder->maxThreads = 1;
 
     // libavif needs a contiguous data buffer.
@@ -205,6 +208,18 @@ SkCodec::Result SkAvifCodec::onGetPixels(const SkImageInfo& dstInfo,
         return kUnimplemented;
     }
 
+    // libavif's AV1 decoders run their own worker threads and cannot use the executor itself, so
+    // an executor only asks for as many threads as there are cores. The AV1 decoder picks up its
+    // thread count when it is created, so changing it means recreating the decoder.
+    const int maxThreads =
+            options.fExecutor ? SkToInt(std::max(1u, std::thread::hardware_concurrency())) : 1;
+    if (fAvifDecoder->maxThreads != maxThreads) {
+        fAvifDecoder->maxThreads = maxThreads;
+        if (avifDecoderReset(fAvifDecoder.get()) != AVIF_RESULT_OK) {
+            return kInternalError;
+        }
+    }
+
     avifResult result = avifDecoderNthImage(fAvifDecoder.get(), options.fFrameIndex);
     if (result != AVIF_RESULT_OK) {
         return kInvalidInput;
@@ -262,6 +262,9 @@ SkCodec::~SkCodec() {}
 
 void SkCodec::setSrcXformFormat(XformFormat pixelFormat) {
     fSrcXformFormat = pixelFormat;
+    if (this->colorXform()) {
+        this->compileColorXform();
+    }
 }
 
 bool SkCodec::queryYUVAInfo(const SkYUVAPixmapInfo::SupportedDataTypes& supportedDataTypes,
@@ -804,6 +807,7 @@ bool sk_select_xform_format(SkColorType colorType, bool forColorTable,
 bool SkCodec::initializeColorXform(const SkImageInfo& dstInfo, SkEncodedInfo::Alpha encodedAlpha,
                                    bool srcIsOpaque) {
     fXformTime = kNo_XformTime;
+    fColorXform.reset();
     bool needsColorXform = false;
     if (this->usesColorXform()) {
         if (kRGBA_F16_SkColorType == dstInfo.colorType() ||
@@ -822,7 +826,10 @@ bool SkCodec::initializeColorXform(const SkImageInfo& dstInfo, SkEncodedInfo::Al
             if (!srcProfile) {
                 srcProfile = skcms_sRGB_profile();
             }
-            if (!skcms_ApproximatelyEqualProfiles(srcProfile, &fDstProfile) ) {
+            // Decoding to the color space from getInfo() is common, and with an interned
+            // profile that needs only a pointer compare.
+            if (!fEncodedInfo.profileIsExactly(dstInfo.colorSpace()) &&
+                !skcms_ApproximatelyEqualProfiles(srcProfile, &fDstProfile)) {
                 needsColorXform = true;
             }
         }
@@ -846,16 +853,24 @@ bool SkCodec::initializeColorXform(const SkImageInfo& dstInfo, SkEncodedInfo::Al
         } else {
             fDstXformAlphaFormat = skcms_AlphaFormat_Unpremul;
         }
+        this->compileColorXform();
     }
     return true;
 }
 
-void SkCodec::applyColorXform(void* dst, const void* src, int count) const {
+void SkCodec::compileColorXform() {
     // It is okay for srcProfile to be null. This will use sRGB.
     const auto* srcProfile = fEncodedInfo.profile();
-    SkAssertResult(skcms_Transform(src, fSrcXformFormat, skcms_AlphaFormat_Unpremul, srcProfile,
-                                   dst, fDstXformFormat, fDstXformAlphaFormat, &fDstProfile,
-                                   count));
+    fColorXform.reset(skcms_CompileTransform(fSrcXformFormat, skcms_AlphaFormat_Unpremul,
+                                             srcProfile, fDstXformFormat, fDstXformAlphaFormat,
+                                             &fDstProfile));
+    SkASSERT(fColorXform);
+}
+
+void SkCodec::applyColorXform(void* dst, const void* src, int count) const {
+    // Compiled up front, so rows may be transformed from several threads at once.
+    SkAssertResult(fColorXform &&
+                   skcms_RunCompiledTransform(fColorXform.get(), src, dst, count));
 }
 
 std::vector<SkCodec::FrameInfo> SkCodec::getFrameInfo() {
@@ -7,24 +7,35 @@
 
 #include "include/private/SkEncodedInfo.h"
 
+#include "include/core/SkColorSpace.h"
+#include "include/core/SkData.h"
 #include "modules/skcms/skcms.h"
+#include "src/core/SkICCProfileCache.h"
+
+#include <utility>
 
 std::unique_ptr<SkEncodedInfo::ICCProfile> SkEncodedInfo::ICCProfile::Make(sk_sp<SkData> data) {
-    if (data) {
-        skcms_ICCProfile profile;
-        if (skcms_Parse(data->data(), data->size(), &profile)) {
-            return std::unique_ptr<ICCProfile>(new ICCProfile(profile, std::move(data)));
-        }
+    if (auto interned = SkICCProfileCache::Global()->intern(std::move(data))) {
+        return std::unique_ptr<ICCProfile>(new ICCProfile(interned->fProfile,
+                                                          interned->fData,
+                                                          interned->fColorSpace,
+                                                          interned->fColorSpaceIsExact));
     }
     return nullptr;
 }
 
 std::unique_ptr<SkEncodedInfo::ICCProfile> SkEncodedInfo::ICCProfile::Make(
         const skcms_ICCProfile& profile) {
-    return std::unique_ptr<ICCProfile>(new ICCProfile(profile));
+    return std::unique_ptr<ICCProfile>(
+            new ICCProfile(profile, nullptr, SkColorSpace::Make(profile), /*exact=*/false));
 }
 
-SkEncodedInfo::ICCProfile::ICCProfile(const skcms_ICCProfile& profile, sk_sp<SkData> data)
+SkEncodedInfo::ICCProfile::ICCProfile(const skcms_ICCProfile& profile,
+                                      sk_sp<SkData> data,
+                                      sk_sp<SkColorSpace> colorSpace,
+                                      bool exact)
     : fProfile(profile)
     , fData(std::move(data))
+    , fColorSpace(std::move(colorSpace))
+    , fColorSpaceIsExact(exact)
 {}
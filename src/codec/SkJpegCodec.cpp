@@ -12,6 +12,7 @@
 #include "include/core/SkAlphaType.h"
 #include "include/core/SkColorType.h"
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkPixmap.h"
 #include "include/core/SkRefCnt.h"
@@ -21,6 +22,7 @@
 #include "include/private/base/SkAlign.h"
 #include "include/private/base/SkMalloc.h"
 #include "include/private/base/SkTemplates.h"
+#include "include/private/base/SkTo.h"
 #include "modules/skcms/skcms.h"
 #include "src/codec/SkCodecPriv.h"
 #include "src/codec/SkJpegConstants.h"
@@ -29,15 +31,19 @@
 #include "src/codec/SkJpegPriv.h"
 #include "src/codec/SkParseEncodedOrigin.h"
 #include "src/codec/SkSwizzler.h"
+#include "src/core/SkTaskGroup.h"
 
 #ifdef SK_CODEC_DECODES_JPEG_GAINMAPS
 #include "include/private/SkGainmapInfo.h"
 #endif  // SK_CODEC_DECODES_JPEG_GAINMAPS
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <csetjmp>
 #include <cstring>
 #include <utility>
+#include <vector>
 
 using namespace skia_private;
 
@@ -271,11 +277,13 @@ bool SkJpegCodec::onRewind() {
     }
     SkASSERT(nullptr != decoderMgr);
     fDecoderMgr.reset(decoderMgr);
+    fSeekStream.reset();
 
     fSwizzler.reset(nullptr);
     fSwizzleSrcRow = nullptr;
     fColorXformSrcRow = nullptr;
     fStorage.reset();
+    fStorageBytes.set(0);
 
     return true;
 }
@@ -466,6 +474,261 @@ static inline bool needs_swizzler_to_convert_from_cmyk(J_COLOR_SPACE jpegColorTy
     return !hasCMYKColorSpace || !hasColorSpaceXform;
 }
 
+// Where the pieces of a single-scan JPEG with restart markers live in its encoded data, and how the
+// restart intervals divide up the image.
+struct SkJpegCodec::RestartIndex {
+    size_t fFrameOffset = 0;         // The SOF0 or SOF1 marker.
+    size_t fScanDataOffset = 0;      // The first byte of entropy-coded data after SOS.
+    std::vector<size_t> fRestarts;   // Each RSTm marker, in order.
+    size_t fEndOffset = 0;           // The EOI marker.
+
+    int fIntervalHeight = 0;         // The rows of the full-size image in each interval.
+    int fIntervalCount = 0;
+
+    // Fills in everything but the interval geometry from the encoded data.
+    bool scan(const uint8_t* data, size_t size);
+
+    size_t intervalStart(int i) const {
+        return 0 == i ? fScanDataOffset : fRestarts[i - 1] + kJpegMarkerCodeSize;
+    }
+    size_t intervalEnd(int i) const {
+        return i < fIntervalCount - 1 ? fRestarts[i] : fEndOffset;
+    }
+
+    // Makes a standalone JPEG of the intervals [first, last) of data, which is height rows tall:
+    // the original header with the frame height patched, the entropy-coded data of those
+    // intervals with their restart markers renumbered from RST0, and EOI.
+    sk_sp<SkData> makeJpeg(const uint8_t* data, int first, int last, int height) const {
+        const size_t headerSize = fScanDataOffset;
+        const size_t scanStart = this->intervalStart(first);
+        const size_t scanSize = this->intervalEnd(last - 1) - scanStart;
+        sk_sp<SkData> jpeg = SkData::MakeUninitialized(headerSize + scanSize + kJpegMarkerCodeSize);
+        uint8_t* bytes = static_cast<uint8_t*>(jpeg->writable_data());
+        memcpy(bytes, data, headerSize);
+        memcpy(bytes + headerSize, data + scanStart, scanSize);
+        bytes[headerSize + scanSize] = 0xFF;
+        bytes[headerSize + scanSize + 1] = kJpegMarkerEndOfImage;
+
+        // SOF: marker (2), length (2), precision (1), height (2).
+        bytes[fFrameOffset + 5] = height >> 8;
+        bytes[fFrameOffset + 6] = height & 0xFF;
+        for (int i = first; i < last - 1; i++) {
+            const size_t rst = fRestarts[i] - scanStart + headerSize;
+            bytes[rst + 1] = 0xD0 + (i - first) % 8;
+        }
+        return jpeg;
+    }
+};
+
+// Finds the frame header, the start of the scan, and every restart marker. Returns false for
+// anything other than a sequential, single-scan, Huffman-coded image whose restart markers are
+// numbered in order.
+bool SkJpegCodec::RestartIndex::scan(const uint8_t* data, size_t size) {
+    if (size < sizeof(kJpegSig) || memcmp(data, kJpegSig, sizeof(kJpegSig)) != 0) {
+        return false;
+    }
+
+    bool sawFrame = false;
+    size_t offset = kJpegMarkerCodeSize;
+    while (true) {
+        // Any marker may be preceded by fill bytes.
+        const size_t fillStart = offset;
+        while (offset < size && data[offset] == 0xFF) {
+            offset++;
+        }
+        if (offset == fillStart || offset + kJpegSegmentParameterLengthSize >= size) {
+            return false;
+        }
+        const uint8_t marker = data[offset];
+        const size_t markerOffset = offset - 1;
+        const size_t length = (data[offset + 1] << 8) | data[offset + 2];
+        offset += 1;
+        if (length < kJpegSegmentParameterLengthSize || length > size - offset) {
+            return false;
+        }
+        if (marker >= 0xC0 && marker <= 0xCF && marker != 0xC4 && marker != 0xC8 &&
+            marker != 0xCC) {
+            // Only baseline and extended sequential Huffman frames.
+            if (sawFrame || (marker != 0xC0 && marker != 0xC1)) {
+                return false;
+            }
+            sawFrame = true;
+            fFrameOffset = markerOffset;
+        }
+        offset += length;
+        if (marker == kJpegMarkerStartOfScan) {
+            break;
+        }
+    }
+    if (!sawFrame) {
+        return false;
+    }
+    fScanDataOffset = offset;
+
+    for (; offset + 1 < size; offset++) {
+        if (data[offset] != 0xFF) {
+            continue;
+        }
+        const uint8_t next = data[offset + 1];
+        if (next == 0x00 || next == 0xFF) {
+            // A stuffed 0xFF in the entropy-coded data, or fill bytes before a marker.
+            continue;
+        }
+        if (next >= 0xD0 && next <= 0xD7) {
+            if (static_cast<size_t>(next - 0xD0) != fRestarts.size() % 8) {
+                return false;
+            }
+            fRestarts.push_back(offset);
+            offset++;
+            continue;
+        }
+        if (next == kJpegMarkerEndOfImage) {
+            fEndOffset = offset;
+            return true;
+        }
+        // Anything else (DNL, another scan, ...) is more than we handle here.
+        return false;
+    }
+    return false;
+}
+
+static const uint8_t* get_memory_base(SkStream* stream) {
+    return stream->getMemoryBase() && stream->hasLength()
+            ? static_cast<const uint8_t*>(stream->getMemoryBase())
+            : nullptr;
+}
+
+const SkJpegCodec::RestartIndex* SkJpegCodec::restartIndex() {
+    if (fRestartIndexBuilt) {
+        return fRestartIndex.get();
+    }
+    fRestartIndexBuilt = true;
+
+    jpeg_decompress_struct* dinfo = fDecoderMgr->dinfo();
+    if (0 == dinfo->restart_interval || dinfo->progressive_mode || dinfo->arith_code ||
+        dinfo->comps_in_scan != dinfo->num_components ||
+        (1 == dinfo->comps_in_scan &&
+         (1 != dinfo->max_h_samp_factor || 1 != dinfo->max_v_samp_factor))) {
+        return nullptr;
+    }
+
+    // Each restart interval has to cover whole MCU rows so that it is a band of the image.
+    const int width = this->dimensions().width();
+    const int height = this->dimensions().height();
+    const int mcuWidth = DCTSIZE * dinfo->max_h_samp_factor;
+    const int mcuHeight = DCTSIZE * dinfo->max_v_samp_factor;
+    const unsigned int mcusPerRow = (width + mcuWidth - 1) / mcuWidth;
+    if (0 != dinfo->restart_interval % mcusPerRow) {
+        return nullptr;
+    }
+
+    const uint8_t* data = get_memory_base(this->stream());
+    auto index = std::make_unique<RestartIndex>();
+    index->fIntervalHeight = mcuHeight * SkToInt(dinfo->restart_interval / mcusPerRow);
+    index->fIntervalCount = (height + index->fIntervalHeight - 1) / index->fIntervalHeight;
+    if (!data || !index->scan(data, this->stream()->getLength()) ||
+        index->fRestarts.size() + 1 != static_cast<size_t>(index->fIntervalCount)) {
+        return nullptr;
+    }
+    fRestartIndex = std::move(index);
+    return fRestartIndex.get();
+}
+
+bool SkJpegCodec::decodeStripe(SkData* stripeData, int skipRows, int rowCount, void* dst,
+                               size_t rowBytes, int dstWidth) const {
+    SkMemoryStream stream(sk_ref_sp(stripeData));
+    JpegDecoderMgr decoderMgr(&stream);
+
+    skjpeg_error_mgr::AutoPushJmpBuf jmp(decoderMgr.errorMgr());
+    if (setjmp(jmp)) {
+        return decoderMgr.returnFalse("decodeStripe");
+    }
+
+    decoderMgr.init();
+    jpeg_decompress_struct* dinfo = decoderMgr.dinfo();
+    if (JPEG_HEADER_OK != jpeg_read_header(dinfo, true)) {
+        return false;
+    }
+    dinfo->out_color_space = fDecoderMgr->dinfo()->out_color_space;
+    dinfo->dither_mode = fDecoderMgr->dinfo()->dither_mode;
+    if (!jpeg_start_decompress(dinfo)) {
+        return false;
+    }
+
+    AutoTMalloc<JSAMPLE> skippedRow(skipRows > 0 ? get_row_bytes(dinfo) : 0);
+    for (int y = 0; y < skipRows + rowCount; y++) {
+        JSAMPLE* row = y < skipRows
+                ? skippedRow.get()
+                : SkTAddOffset<JSAMPLE>(dst, (y - skipRows) * rowBytes);
+        if (1 != jpeg_read_scanlines(dinfo, &row, 1)) {
+            return false;
+        }
+        if (y >= skipRows && this->colorXform()) {
+            this->applyColorXform(row, row, dstWidth);
+        }
+    }
+    return true;
+}
+
+bool SkJpegCodec::decodeRestartStripes(const SkImageInfo& dstInfo, void* dst, size_t rowBytes,
+                                       SkExecutor* executor) {
+    // Stripes decode straight into dst, so there must be nothing to do per row apart from an
+    // in-place color xform.
+    jpeg_decompress_struct* dinfo = fDecoderMgr->dinfo();
+    if (dstInfo.dimensions() != this->dimensions() ||
+        (this->colorXform() && 4 != dstInfo.bytesPerPixel()) ||
+        needs_swizzler_to_convert_from_cmyk(dinfo->out_color_space,
+                                            this->getEncodedInfo().profile(), this->colorXform())) {
+        return false;
+    }
+    const RestartIndex* index = this->restartIndex();
+    if (!index) {
+        return false;
+    }
+
+    // A couple of dozen stripes keep a large pool busy without making each stripe too short to
+    // be worth the overlapping rows it decodes.
+    constexpr int kMaxStripeCount = 32;
+    constexpr int kMinStripeHeight = 128;
+    const int height = this->dimensions().height();
+    const int intervalCount = index->fIntervalCount;
+    const int intervalHeight = index->fIntervalHeight;
+    int stripeCount = std::min({kMaxStripeCount, intervalCount, height / kMinStripeHeight});
+    if (stripeCount < 2) {
+        return false;
+    }
+    const int intervalsPerStripe = (intervalCount + stripeCount - 1) / stripeCount;
+    stripeCount = (intervalCount + intervalsPerStripe - 1) / intervalsPerStripe;
+
+    const uint8_t* data = get_memory_base(this->stream());
+    std::atomic<bool> failed{false};
+    SkTaskGroup tasks(*executor);
+    tasks.batch(stripeCount, [&](int stripe) {
+        // Each stripe also decodes the interval above and below the rows it writes, so that
+        // chroma upsampling next to the stripe's edges sees the same neighbors it would in a
+        // serial decode.
+        const int first = stripe * intervalsPerStripe;
+        const int last = std::min(first + intervalsPerStripe, intervalCount);
+        const int decodeFirst = std::max(first - 1, 0);
+        const int decodeLast = std::min(last + 1, intervalCount);
+        const int decodeTop = decodeFirst * intervalHeight;
+        const int decodeBottom = std::min(decodeLast * intervalHeight, height);
+        const int top = first * intervalHeight;
+        const int bottom = std::min(last * intervalHeight, height);
+
+        sk_sp<SkData> stripeData =
+                index->makeJpeg(data, decodeFirst, decodeLast, decodeBottom - decodeTop);
+        if (!this->decodeStripe(stripeData.get(), top - decodeTop, bottom - top,
+                                SkTAddOffset<void>(dst, top * rowBytes), rowBytes,
+                                dstInfo.width())) {
+            failed.store(true, std::memory_order_relaxed);
+        }
+    });
+    tasks.wait();
+
+    return !failed.load(std::memory_order_relaxed);
+}
+
 /*
  * Performs the jpeg decode
  */
@@ -478,6 +741,11 @@ SkCodec::Result SkJpegCodec::onGetPixels(const SkImageInfo& dstInfo,
         return kUnimplemented;
     }
 
+    if (options.fExecutor &&
+        this->decodeRestartStripes(dstInfo, dst, dstRowBytes, options.fExecutor)) {
+        return kSuccess;
+    }
+
     // Get a pointer to the decompress info since we will use it quite frequently
     jpeg_decompress_struct* dinfo = fDecoderMgr->dinfo();
 
@@ -534,6 +802,7 @@ bool SkJpegCodec::allocateStorage(const SkImageInfo& dstInfo) {
         if (!fStorage.reset(totalBytes)) {
             return false;
         }
+        fStorageBytes.set(totalBytes);
         fSwizzleSrcRow = (swizzleBytes > 0) ? fStorage.get() : nullptr;
         fColorXformSrcRow = (xformBytes > 0) ?
                 SkTAddOffset<uint32_t>(fStorage.get(), swizzleBytes) : nullptr;
@@ -681,6 +950,10 @@ int SkJpegCodec::onGetScanlines(void* dst, int count, size_t dstRowBytes) {
 }
 
 bool SkJpegCodec::onSkipScanlines(int count) {
+    if (0 == fDecoderMgr->dinfo()->output_scanline && this->seekToRestartInterval(count)) {
+        return true;
+    }
+
     // Set the jump location for libjpeg errors
     skjpeg_error_mgr::AutoPushJmpBuf jmp(fDecoderMgr->errorMgr());
     if (setjmp(jmp)) {
@@ -690,6 +963,64 @@ bool SkJpegCodec::onSkipScanlines(int count) {
     return (uint32_t) count == jpeg_skip_scanlines(fDecoderMgr->dinfo(), count);
 }
 
+bool SkJpegCodec::seekToRestartInterval(int row) {
+    const RestartIndex* index = this->restartIndex();
+    jpeg_decompress_struct* dinfo = fDecoderMgr->dinfo();
+    if (!index || 0 != (index->fIntervalHeight * dinfo->scale_num) % dinfo->scale_denom) {
+        return false;
+    }
+
+    // Start one interval early, so that chroma upsampling of the first row we keep sees the same
+    // neighbors it would have if we had decoded from the top.
+    const int outputIntervalHeight = index->fIntervalHeight * dinfo->scale_num / dinfo->scale_denom;
+    const int first = row / outputIntervalHeight - 1;
+    if (first < 1) {
+        return false;
+    }
+
+    const uint8_t* data = get_memory_base(this->stream());
+    const int height = this->dimensions().height() - first * index->fIntervalHeight;
+    auto stream = std::make_unique<SkMemoryStream>(
+            index->makeJpeg(data, first, index->fIntervalCount, height));
+    auto decoderMgr = std::make_unique<JpegDecoderMgr>(stream.get());
+
+    skjpeg_error_mgr::AutoPushJmpBuf jmp(decoderMgr->errorMgr());
+    if (setjmp(jmp)) {
+        return decoderMgr->returnFalse("seekToRestartInterval");
+    }
+
+    decoderMgr->init();
+    jpeg_decompress_struct* seekInfo = decoderMgr->dinfo();
+    if (JPEG_HEADER_OK != jpeg_read_header(seekInfo, true)) {
+        return false;
+    }
+    seekInfo->out_color_space = dinfo->out_color_space;
+    seekInfo->dither_mode = dinfo->dither_mode;
+    seekInfo->scale_num = dinfo->scale_num;
+    seekInfo->scale_denom = dinfo->scale_denom;
+    if (!jpeg_start_decompress(seekInfo)) {
+        return false;
+    }
+    if (this->options().fSubset) {
+        // The image is just as wide, so this crops exactly as onStartScanlineDecode() did.
+        uint32_t startX = this->options().fSubset->x();
+        uint32_t width = this->options().fSubset->width();
+        jpeg_crop_scanline(seekInfo, &startX, &width);
+        SkASSERT(width == dinfo->output_width);
+    }
+
+    const int skip = row - first * outputIntervalHeight;
+    if ((uint32_t) skip != jpeg_skip_scanlines(seekInfo, skip)) {
+        return false;
+    }
+
+    // The rest of the scanline decode reads from the seeked decompress struct. The next rewind
+    // will read the header of the whole image again.
+    fDecoderMgr = std::move(decoderMgr);
+    fSeekStream = std::move(stream);
+    return true;
+}
+
 static bool is_yuv_supported(const jpeg_decompress_struct* dinfo,
                              const SkJpegCodec& codec,
                              const SkYUVAPixmapInfo::SupportedDataTypes* supportedDataTypes,
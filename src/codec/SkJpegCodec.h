@@ -17,12 +17,15 @@
 #include "include/core/SkYUVAPixmaps.h"
 #include "include/private/SkEncodedInfo.h"
 #include "include/private/base/SkTemplates.h"
+#include "src/base/SkAllocationCounters.h"
 
 #include <cstddef>
 #include <cstdint>
 #include <memory>
 
 class JpegDecoderMgr;
+class SkData;
+class SkExecutor;
 class SkSampler;
 class SkStream;
 class SkSwizzler;
@@ -131,6 +134,36 @@ private:
     [[nodiscard]] bool allocateStorage(const SkImageInfo& dstInfo);
     int readRows(const SkImageInfo& dstInfo, void* dst, size_t rowBytes, int count, const Options&);
 
+    /*
+     * Finds the restart intervals of the encoded data the first time it is called. Returns nullptr
+     * if the image is not a single scan whose restart intervals cover whole MCU rows, or if the
+     * encoded data is not in memory.
+     */
+    struct RestartIndex;
+    const RestartIndex* restartIndex();
+
+    /*
+     * Replaces fDecoderMgr, at the start of a scanline decode, with one that decodes just the
+     * restart intervals from a little above row onwards and has skipped to row. Returns false,
+     * leaving fDecoderMgr untouched, if there is no restart index or not enough rows to skip.
+     */
+    bool seekToRestartInterval(int row);
+
+    /*
+     * Decodes the whole image as stripes of restart intervals, each with its own decompress
+     * struct, on the executor. Returns false without writing a complete image if the encoded
+     * data or the destination does not allow it, in which case the caller decodes serially.
+     */
+    bool decodeRestartStripes(const SkImageInfo& dstInfo, void* dst, size_t rowBytes,
+                              SkExecutor* executor);
+
+    /*
+     * Decodes a standalone stripe made by decodeRestartStripes, dropping its first skipRows
+     * rows and writing the next rowCount rows to dst.
+     */
+    bool decodeStripe(SkData* stripeData, int skipRows, int rowCount, void* dst,
+                      size_t rowBytes, int dstWidth) const;
+
     /*
      * Scanline decoding.
      */
@@ -140,6 +173,9 @@ private:
     int onGetScanlines(void* dst, int count, size_t rowBytes) override;
     bool onSkipScanlines(int count) override;
 
+    // The encoded data of the restart intervals fDecoderMgr is reading after a seek. Declared
+    // first so that it outlives fDecoderMgr.
+    std::unique_ptr<SkStream>          fSeekStream;
     std::unique_ptr<JpegDecoderMgr>    fDecoderMgr;
 
     // We will save the state of the decompress struct after reading the header.
@@ -148,6 +184,7 @@ private:
 
 
     skia_private::AutoTMalloc<uint8_t>             fStorage;
+    SkAccountedBytes                               fStorageBytes{SkAllocationCategory::kCodec};
     uint8_t* fSwizzleSrcRow = nullptr;
     uint32_t* fColorXformSrcRow = nullptr;
 
@@ -158,6 +195,10 @@ private:
 
     std::unique_ptr<SkSwizzler>        fSwizzler;
 
+    // Built at most once; the encoded data does not change across rewinds.
+    std::unique_ptr<RestartIndex>      fRestartIndex;
+    bool                               fRestartIndexBuilt = false;
+
     friend class SkRawCodec;
 
     using INHERITED = SkCodec;
@@ -27,6 +27,7 @@
 #include "src/codec/SkJpegSegmentScan.h"
 #include "src/codec/SkJpegSourceMgr.h"
 #include "src/codec/SkJpegXmp.h"
+#include "src/core/SkICCProfileCache.h"
 #else
 struct SkGainmapInfo;
 #endif  // SK_CODEC_DECODES_JPEG_GAINMAPS
@@ -121,12 +122,11 @@ static bool extract_gainmap(SkJpegSourceMgr* decoderSource,
         didPopulateInfo = SkGainmapInfo::Parse(
                 metadataDecoder.getISOGainmapMetadata(/*copyData=*/false).get(), info);
         if (didPopulateInfo && info.fGainmapMathColorSpace) {
-            auto iccData = metadataDecoder.getICCProfileData(/*copyData=*/false);
-            skcms_ICCProfile iccProfile;
-            if (iccData && skcms_Parse(iccData->data(), iccData->size(), &iccProfile)) {
-                auto iccProfileSpace = SkColorSpace::Make(iccProfile);
-                if (iccProfileSpace) {
-                    info.fGainmapMathColorSpace = std::move(iccProfileSpace);
+            // Copy the profile, since the cache may keep it past this decoder's lifetime.
+            auto iccData = metadataDecoder.getICCProfileData(/*copyData=*/true);
+            if (auto interned = SkICCProfileCache::Global()->intern(std::move(iccData))) {
+                if (interned->fColorSpace) {
+                    info.fGainmapMathColorSpace = interned->fColorSpace;
                 }
             }
         }
@@ -11,6 +11,7 @@
 #include "include/codec/SkJpegxlDecoder.h"
 #include "include/core/SkColorType.h"
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkStream.h"
@@ -20,17 +21,23 @@
 #include "include/private/base/SkTemplates.h"
 #include "include/private/base/SkTo.h"
 #include "modules/skcms/skcms.h"
+#include "src/base/SkScopeExit.h"
 #include "src/codec/SkFrameHolder.h"
 #include "src/core/SkStreamPriv.h"
 #include "src/core/SkSwizzlePriv.h"
+#include "src/core/SkTaskGroup.h"
 
 #include "jxl/codestream_header.h"  // NO_G3_REWRITE
 #include "jxl/decode.h"  // NO_G3_REWRITE
 #include "jxl/decode_cxx.h"  // NO_G3_REWRITE
+#include "jxl/parallel_runner.h"  // NO_G3_REWRITE
 #include "jxl/types.h"  // NO_G3_REWRITE
 
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <cstring>
+#include <functional>
 #include <limits>
 #include <utility>
 #include <vector>
@@ -67,6 +74,12 @@ public:
     size_t fPixelShift;
     size_t fRowBytes;
     SkColorType fDstColorType;
+    // The executor of the getPixels() call in progress, if any; see RunOnExecutor().
+    SkExecutor* fExecutor = nullptr;
+
+    static JxlParallelRetCode RunOnExecutor(void* runnerOpaque, void* jpegxlOpaque,
+                                            JxlParallelRunInit init, JxlParallelRunFunction func,
+                                            uint32_t startRange, uint32_t endRange);
 
 protected:
     const SkFrame* onGetFrame(int i) const override {
@@ -75,6 +88,52 @@ protected:
     }
 };
 
+bool SkJpegxlCodec::RunParallel(SkExecutor* executor, uint32_t start, uint32_t end,
+                                const std::function<bool(size_t workerCount)>& init,
+                                const std::function<void(uint32_t value, size_t worker)>& func) {
+    if (start >= end) {
+        return true;
+    }
+    // libjxl allocates scratch space for each worker, so keep their number modest. Workers pull
+    // values from a shared counter, so any extra workers beyond the executor's threads only idle.
+    const uint32_t workerCount = executor ? std::min(kMaxParallelWorkers, end - start) : 1;
+    if (!init(workerCount)) {
+        return false;
+    }
+    if (workerCount == 1) {
+        for (uint32_t value = start; value < end; ++value) {
+            func(value, 0);
+        }
+        return true;
+    }
+
+    // Each worker runs its values one after another, so calls for the same worker never overlap.
+    std::atomic<uint32_t> next{start};
+    SkTaskGroup tasks(*executor);
+    tasks.batch(SkToInt(workerCount), [&](int worker) {
+        for (uint32_t value = next.fetch_add(1, std::memory_order_relaxed); value < end;
+             value = next.fetch_add(1, std::memory_order_relaxed)) {
+            func(value, SkToSizeT(worker));
+        }
+    });
+    tasks.wait();
+    return true;
+}
+
+// libjxl hands its data-parallel loops (groups of the frame, passes, ...) to this runner, and
+// requires that calls with the same thread id don't run concurrently.
+JxlParallelRetCode SkJpegxlCodecPriv::RunOnExecutor(void* runnerOpaque, void* jpegxlOpaque,
+                                                    JxlParallelRunInit init,
+                                                    JxlParallelRunFunction func,
+                                                    uint32_t startRange, uint32_t endRange) {
+    SkExecutor* executor = static_cast<SkJpegxlCodecPriv*>(runnerOpaque)->fExecutor;
+    const bool ok = SkJpegxlCodec::RunParallel(
+            executor, startRange, endRange,
+            [&](size_t workerCount) { return init(jpegxlOpaque, workerCount) == 0; },
+            [&](uint32_t value, size_t worker) { func(jpegxlOpaque, value, worker); });
+    return ok ? JXL_PARALLEL_RET_SUCCESS : JXL_PARALLEL_RET_RUNNER_ERROR;
+}
+
 SkJpegxlCodec::SkJpegxlCodec(std::unique_ptr<SkJpegxlCodecPriv> codec,
                              SkEncodedInfo&& info,
                              std::unique_ptr<SkStream> stream,
@@ -104,8 +163,17 @@ std::unique_ptr<SkCodec> SkJpegxlCodec::MakeFromStream(std::unique_ptr<SkStream>
     auto priv = std::make_unique<SkJpegxlCodecPriv>();
     JxlDecoder* dec = priv->fDecoder.get();
 
+    // The runner survives rewinds, so it only needs to be installed once. It decodes serially
+    // unless getPixels() is given an executor.
+    auto status = JxlDecoderSetParallelRunner(dec, SkJpegxlCodecPriv::RunOnExecutor, priv.get());
+    if (status != JXL_DEC_SUCCESS) {
+        // Fresh instance must accept a parallel runner.
+        SkDEBUGFAIL("libjxl returned unexpected status");
+        return nullptr;
+    }
+
     // Only query metadata this time.
-    auto status = JxlDecoderSubscribeEvents(dec, JXL_DEC_BASIC_INFO | JXL_DEC_COLOR_ENCODING);
+    status = JxlDecoderSubscribeEvents(dec, JXL_DEC_BASIC_INFO | JXL_DEC_COLOR_ENCODING);
     if (status != JXL_DEC_SUCCESS) {
         // Fresh instance must accept request for subscription.
         SkDEBUGFAIL("libjxl returned unexpected status");
@@ -208,6 +276,9 @@ SkCodec::Result SkJpegxlCodec::onGetPixels(const SkImageInfo& dstInfo, void* dst
     auto* dec = codec.fDecoder.get();
     JxlDecoderStatus status;
 
+    codec.fExecutor = options.fExecutor;
+    SK_AT_SCOPE_EXIT(codec.fExecutor = nullptr);
+
     if ((codec.fLastProcessedFrame >= index) || (codec.fLastProcessedFrame = SkCodec::kNoFrame)) {
         codec.fLastProcessedFrame = SkCodec::kNoFrame;
         JxlDecoderRewind(dec);
@@ -322,6 +393,7 @@ bool SkJpegxlCodec::conversionSupported(const SkImageInfo& dstInfo, bool srcIsOp
 
 void SkJpegxlCodec::imageOutCallback(void* opaque, size_t x, size_t y,
                                      size_t num_pixels, const void* pixels) {
+    // With an executor, libjxl calls this from several threads at once, each for its own pixels.
     SkJpegxlCodec* instance = reinterpret_cast<SkJpegxlCodec*>(opaque);
     auto& codec = *instance->fCodec.get();
     size_t offset = y * codec.fRowBytes + (x << codec.fPixelShift);
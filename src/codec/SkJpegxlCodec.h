@@ -14,9 +14,12 @@
 #include "src/codec/SkScalingCodec.h"
 
 #include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <memory>
 
 class SkCodec;
+class SkExecutor;
 class SkFrameHolder;
 class SkJpegxlCodecPriv;
 class SkStream;
@@ -38,6 +41,18 @@ public:
      */
     static std::unique_ptr<SkCodec> MakeFromStream(std::unique_ptr<SkStream>, Result*);
 
+    static constexpr uint32_t kMaxParallelWorkers = 8;
+
+    /*
+     * Runs libjxl's parallel loops for getPixels(). Calls init with the number of workers, at
+     * most kMaxParallelWorkers, then func for every value in [start, end) with the index of the
+     * worker that runs it. Calls for the same worker never overlap. Without an executor there is
+     * a single worker, on the calling thread. Returns false if init does.
+     */
+    static bool RunParallel(SkExecutor*, uint32_t start, uint32_t end,
+                            const std::function<bool(size_t workerCount)>& init,
+                            const std::function<void(uint32_t value, size_t worker)>& func);
+
 protected:
     /* TODO(eustas): implement when downscaling is supported. */
     /* SkISize onGetScaledDimensions(float desiredScale) const override; */
@@ -462,6 +462,7 @@ void SkPngCodec::allocateStorage(const SkImageInfo& dstInfo) {
             const size_t bytesPerPixel = (bitsPerPixel > 32) ? bitsPerPixel / 8 : 4;
             const size_t colorXformBytes = dstInfo.width() * bytesPerPixel;
             fStorage.reset(colorXformBytes);
+            fStorageBytes.set(colorXformBytes);
             fColorXformSrcRow = fStorage.get();
             break;
         }
@@ -11,6 +11,7 @@
 #include "include/codec/SkEncodedImageFormat.h"
 #include "include/core/SkRefCnt.h"
 #include "include/private/base/SkTemplates.h"
+#include "src/base/SkAllocationCounters.h"
 
 #include <cstddef>
 #include <cstdint>
@@ -90,6 +91,7 @@ protected:
     sk_sp<SkColorPalette>       fColorTable;    // May be unpremul.
     std::unique_ptr<SkSwizzler> fSwizzler;
     skia_private::AutoTMalloc<uint8_t>      fStorage;
+    SkAccountedBytes                        fStorageBytes{SkAllocationCategory::kCodec};
     void*                       fColorXformSrcRow;
     const int                   fBitDepth;
 
@@ -9,10 +9,14 @@
 
 #include "include/codec/SkCodec.h"
 #include "include/codec/SkRawDecoder.h"
+#include "include/core/SkBitmap.h"
 #include "include/core/SkColorSpace.h"
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImageInfo.h"
+#include "include/core/SkPixmap.h"
 #include "include/core/SkRefCnt.h"
+#include "include/core/SkSamplingOptions.h"
 #include "include/core/SkStream.h"
 #include "include/core/SkTypes.h"
 #include "include/private/SkEncodedInfo.h"
@@ -124,8 +128,11 @@ class SkDngHost : public dng_host {
 public:
     explicit SkDngHost(dng_memory_allocator* allocater) : dng_host(allocater) {}
 
+    // Area tasks run on this executor instead of the default one. Does not take ownership.
+    void setExecutor(SkExecutor* executor) { fExecutor = executor; }
+
     void PerformAreaTask(dng_area_task& task, const dng_rect& area) override {
-        SkTaskGroup taskGroup;
+        SkTaskGroup taskGroup(fExecutor ? *fExecutor : SkExecutor::GetDefault());
 
         // tileSize is typically 256x256
         const dng_point tileSize(task.FindTileSize(area));
@@ -161,18 +168,20 @@ public:
 
     uint32 PerformAreaTaskThreads() override {
 #ifdef SK_BUILD_FOR_ANDROID
-        // Only use 1 thread. DNGs with the warp effect require a lot of memory,
-        // and the amount of memory required scales linearly with the number of
-        // threads. The sample used in CTS requires over 500 MB, so even two
-        // threads is significantly expensive. There is no good way to tell
-        // whether the image has the warp effect.
-        return 1;
+        // Only use 1 thread unless the client passed an executor. DNGs with the
+        // warp effect require a lot of memory, and the amount of memory required
+        // scales linearly with the number of threads. The sample used in CTS
+        // requires over 500 MB, so even two threads is significantly expensive.
+        // There is no good way to tell whether the image has the warp effect.
+        return fExecutor ? kMaxMPThreads : 1;
 #else
         return kMaxMPThreads;
 #endif
     }
 
 private:
+    SkExecutor* fExecutor = nullptr;
+
     using INHERITED = dng_host;
 };
 
@@ -484,8 +493,9 @@ public:
      *   100% size:              4000 x 3000
      *   requested size:         1600 x 1200
      *   returned size could be: 2000 x 1500
+     * If executor is not null, the DNG SDK's area tasks run on it.
      */
-    dng_image* render(int width, int height) {
+    dng_image* render(int width, int height, SkExecutor* executor) {
         if (!fHost || !fInfo || !fNegative || !fDngStream) {
             if (!this->readDng()) {
                 return nullptr;
@@ -496,11 +506,12 @@ public:
         const int preferredSize = std::max(width, height);
         try {
             // render() takes ownership of fHost, fInfo, fNegative and fDngStream when available.
-            std::unique_ptr<dng_host> host(fHost.release());
+            std::unique_ptr<SkDngHost> host(fHost.release());
             std::unique_ptr<dng_info> info(fInfo.release());
             std::unique_ptr<dng_negative> negative(fNegative.release());
             std::unique_ptr<dng_stream> dngStream(fDngStream.release());
 
+            host->setExecutor(executor);
             host->SetPreferredSize(preferredSize);
             host->ValidateSizes();
 
@@ -630,7 +641,7 @@ private:
 
     dng_memory_allocator fAllocator;
     std::unique_ptr<SkRawStream> fStream;
-    std::unique_ptr<dng_host> fHost;
+    std::unique_ptr<SkDngHost> fHost;
     std::unique_ptr<dng_info> fInfo;
     std::unique_ptr<dng_negative> fNegative;
     std::unique_ptr<dng_stream> fDngStream;
@@ -647,7 +658,8 @@ private:
  * fallback to create SkRawCodec for DNG images.
  */
 std::unique_ptr<SkCodec> SkRawCodec::MakeFromStream(std::unique_ptr<SkStream> stream,
-                                                    Result* result) {
+                                                    Result* result,
+                                                    bool useThumbnail) {
     SkASSERT(result);
     if (!stream) {
         *result = SkCodec::kInvalidInput;
@@ -663,12 +675,14 @@ std::unique_ptr<SkCodec> SkRawCodec::MakeFromStream(std::unique_ptr<SkStream> st
     // Does not take the ownership of rawStream.
     SkPiexStream piexStream(rawStream.get());
     ::piex::PreviewImageData imageData;
+    bool foundPreviewData = false;
     if (::piex::IsRaw(&piexStream)) {
         ::piex::Error error = ::piex::GetPreviewImageData(&piexStream, &imageData);
         if (error == ::piex::Error::kFail) {
             *result = kInvalidInput;
             return nullptr;
         }
+        foundPreviewData = error == ::piex::Error::kOk;
 
         std::unique_ptr<SkEncodedInfo::ICCProfile> profile;
         if (imageData.color_space == ::piex::PreviewImageData::kAdobeRgb) {
@@ -703,6 +717,20 @@ std::unique_ptr<SkCodec> SkRawCodec::MakeFromStream(std::unique_ptr<SkStream> st
         return nullptr;
     }
 
+    // DNGs usually embed a small JPEG thumbnail. If the client opted in, keep it for decodes
+    // small enough to use it.
+    sk_sp<SkData> thumbnailData;
+    SkISize thumbnailSize = SkISize::MakeEmpty();
+    const ::piex::Image& thumbnail = imageData.thumbnail;
+    if (useThumbnail && foundPreviewData && thumbnail.length > 0 &&
+        thumbnail.format == ::piex::Image::kJpegCompressed) {
+        sk_sp<SkData> data = SkData::MakeUninitialized(thumbnail.length);
+        if (rawStream->read(data->writable_data(), thumbnail.offset, thumbnail.length)) {
+            thumbnailData = std::move(data);
+            thumbnailSize = SkISize::Make(thumbnail.width, thumbnail.height);
+        }
+    }
+
     // Takes the ownership of the rawStream.
     std::unique_ptr<SkDngImage> dngImage(SkDngImage::NewFromStream(rawStream.release()));
     if (!dngImage) {
@@ -711,15 +739,60 @@ std::unique_ptr<SkCodec> SkRawCodec::MakeFromStream(std::unique_ptr<SkStream> st
     }
 
     *result = kSuccess;
-    return std::unique_ptr<SkCodec>(new SkRawCodec(dngImage.release()));
+    return std::unique_ptr<SkCodec>(
+            new SkRawCodec(dngImage.release(), std::move(thumbnailData), thumbnailSize));
+}
+
+bool SkRawCodec::decodeThumbnail(const SkImageInfo& dstInfo, void* dst, size_t dstRowBytes) {
+    const SkISize dstSize = dstInfo.dimensions();
+    if (!fThumbnailData || dstSize == this->dimensions() ||
+        dstSize.width() > fThumbnailSize.width() || dstSize.height() > fThumbnailSize.height()) {
+        return false;
+    }
+    // The thumbnail must show the whole image, not a crop or a rotation of it.
+    const float maxDiffRatio = 1.03f;
+    const float aspectRatio = (this->dimensions().width() * (float) fThumbnailSize.height()) /
+                              (this->dimensions().height() * (float) fThumbnailSize.width());
+    if (aspectRatio > maxDiffRatio || aspectRatio < 1 / maxDiffRatio) {
+        return false;
+    }
+
+    Result result;
+    std::unique_ptr<SkCodec> codec =
+            SkJpegCodec::MakeFromStream(SkMemoryStream::Make(fThumbnailData), &result);
+    if (!codec || codec->dimensions() != fThumbnailSize) {
+        return false;
+    }
+
+    // Let libjpeg do as much of the downscaling as it can, then resample to the exact size.
+    SkISize decodeSize = fThumbnailSize;
+    for (float scale : {1 / 8.f, 1 / 4.f, 1 / 2.f}) {
+        const SkISize scaled = codec->getScaledDimensions(scale);
+        if (scaled.width() >= dstSize.width() && scaled.height() >= dstSize.height()) {
+            decodeSize = scaled;
+            break;
+        }
+    }
+    const SkPixmap dstPixmap(dstInfo, dst, dstRowBytes);
+    if (decodeSize == dstSize) {
+        return codec->getPixels(dstPixmap) == kSuccess;
+    }
+    SkBitmap decoded;
+    return decoded.tryAllocPixels(dstInfo.makeDimensions(decodeSize)) &&
+           codec->getPixels(decoded.pixmap()) == kSuccess &&
+           decoded.pixmap().scalePixels(dstPixmap, SkSamplingOptions(SkCubicResampler::Mitchell()));
 }
 
 SkCodec::Result SkRawCodec::onGetPixels(const SkImageInfo& dstInfo, void* dst,
                                         size_t dstRowBytes, const Options& options,
                                         int* rowsDecoded) {
+    if (this->decodeThumbnail(dstInfo, dst, dstRowBytes)) {
+        return kSuccess;
+    }
+
     const int width = dstInfo.width();
     const int height = dstInfo.height();
-    std::unique_ptr<dng_image> image(fDngImage->render(width, height));
+    std::unique_ptr<dng_image> image(fDngImage->render(width, height, options.fExecutor));
     if (!image) {
         return kInvalidInput;
     }
@@ -733,19 +806,6 @@ SkCodec::Result SkRawCodec::onGetPixels(const SkImageInfo& dstInfo, void* dst,
         return SkCodec::kInvalidScale;
     }
 
-    void* dstRow = dst;
-    AutoTMalloc<uint8_t> srcRow(width * 3);
-
-    dng_pixel_buffer buffer;
-    buffer.fData = &srcRow[0];
-    buffer.fPlane = 0;
-    buffer.fPlanes = 3;
-    buffer.fColStep = buffer.fPlanes;
-    buffer.fPlaneStep = 1;
-    buffer.fPixelType = ttByte;
-    buffer.fPixelSize = sizeof(uint8_t);
-    buffer.fRowStep = width * 3;
-
     constexpr auto srcFormat = skcms_PixelFormat_RGB_888;
     skcms_PixelFormat dstFormat;
     if (!sk_select_xform_format(dstInfo.colorType(), false, &dstFormat)) {
@@ -759,26 +819,74 @@ SkCodec::Result SkRawCodec::onGetPixels(const SkImageInfo& dstInfo, void* dst,
         cs->toProfile(&dstProfileStorage);
         dstProfile = &dstProfileStorage;
     }
+    std::unique_ptr<skcms_CompiledTransform, SkFunctionObject<skcms_FreeCompiledTransform>> xform(
+            skcms_CompileTransform(srcFormat, skcms_AlphaFormat_Unpremul, srcProfile,
+                                   dstFormat, skcms_AlphaFormat_Unpremul, dstProfile));
+    if (!xform) {
+        SkDebugf("failed to transform\n");
+        *rowsDecoded = 0;
+        return kInternalError;
+    }
+
+    // Converts rows [top, bottom) of the rendered image. On failure, *failedRow is the first row
+    // that was not converted.
+    auto convertRows = [&](int top, int bottom, int* failedRow) {
+        void* dstRow = SkTAddOffset<void>(dst, top * dstRowBytes);
+        AutoTMalloc<uint8_t> srcRow(width * 3);
+
+        dng_pixel_buffer buffer;
+        buffer.fData = &srcRow[0];
+        buffer.fPlane = 0;
+        buffer.fPlanes = 3;
+        buffer.fColStep = buffer.fPlanes;
+        buffer.fPlaneStep = 1;
+        buffer.fPixelType = ttByte;
+        buffer.fPixelSize = sizeof(uint8_t);
+        buffer.fRowStep = width * 3;
+
+        for (int i = top; i < bottom; ++i) {
+            buffer.fArea = dng_rect(i, 0, i + 1, width);
+
+            try {
+                image->Get(buffer, dng_image::edge_zero);
+            } catch (...) {
+                *failedRow = i;
+                return kIncompleteInput;
+            }
 
-    for (int i = 0; i < height; ++i) {
-        buffer.fArea = dng_rect(i, 0, i + 1, width);
-
-        try {
-            image->Get(buffer, dng_image::edge_zero);
-        } catch (...) {
-            *rowsDecoded = i;
-            return kIncompleteInput;
-        }
+            if (!skcms_RunCompiledTransform(xform.get(), &srcRow[0], dstRow, dstInfo.width())) {
+                SkDebugf("failed to transform\n");
+                *failedRow = i;
+                return kInternalError;
+            }
 
-        if (!skcms_Transform(&srcRow[0], srcFormat, skcms_AlphaFormat_Unpremul, srcProfile,
-                             dstRow,     dstFormat, skcms_AlphaFormat_Unpremul, dstProfile,
-                             dstInfo.width())) {
-            SkDebugf("failed to transform\n");
-            *rowsDecoded = i;
-            return kInternalError;
+            dstRow = SkTAddOffset<void>(dstRow, dstRowBytes);
+        }
+        return kSuccess;
+    };
+
+    // With an executor, convert the rendered image in bands of rows. Reading the rendered image
+    // does not modify it, so the bands can run concurrently.
+    constexpr int kBandHeight = 64;
+    const int bandCount = options.fExecutor ? (height + kBandHeight - 1) / kBandHeight : 1;
+    if (bandCount <= 1) {
+        return convertRows(0, height, rowsDecoded);
+    }
+    std::vector<Result> results(bandCount, kSuccess);
+    std::vector<int> failedRows(bandCount, 0);
+    SkTaskGroup tasks(*options.fExecutor);
+    tasks.batch(bandCount, [&](int band) {
+        results[band] = convertRows(band * kBandHeight,
+                                    std::min((band + 1) * kBandHeight, height),
+                                    &failedRows[band]);
+    });
+    tasks.wait();
+    // Every band above the first one that failed is complete.
+    for (int band = 0; band < bandCount; ++band) {
+        if (results[band] != kSuccess) {
+            *rowsDecoded = failedRows[band];
+            return results[band];
         }
-
-        dstRow = SkTAddOffset<void>(dstRow, dstRowBytes);
     }
     return kSuccess;
 }
@@ -823,34 +931,38 @@ bool SkRawCodec::onDimensionsSupported(const SkISize& dim) {
 
 SkRawCodec::~SkRawCodec() {}
 
-SkRawCodec::SkRawCodec(SkDngImage* dngImage)
+SkRawCodec::SkRawCodec(SkDngImage* dngImage, sk_sp<SkData> thumbnailData, SkISize thumbnailSize)
     : INHERITED(SkEncodedInfo::Make(dngImage->width(), dngImage->height(),
                                     SkEncodedInfo::kRGB_Color,
                                     SkEncodedInfo::kOpaque_Alpha, 8),
                 skcms_PixelFormat_RGBA_8888, nullptr)
-    , fDngImage(dngImage) {}
+    , fDngImage(dngImage)
+    , fThumbnailData(std::move(thumbnailData))
+    , fThumbnailSize(thumbnailSize) {}
 
 namespace SkRawDecoder {
 
 std::unique_ptr<SkCodec> Decode(std::unique_ptr<SkStream> stream,
                                 SkCodec::Result* outResult,
-                                SkCodecs::DecodeContext) {
+                                SkCodecs::DecodeContext ctx) {
     SkCodec::Result resultStorage;
     if (!outResult) {
         outResult = &resultStorage;
     }
-    return SkRawCodec::MakeFromStream(std::move(stream), outResult);
+    const auto* options = static_cast<const DecodeOptions*>(ctx);
+    return SkRawCodec::MakeFromStream(std::move(stream), outResult,
+                                      options && options->fUseEmbeddedThumbnail);
 }
 
 std::unique_ptr<SkCodec> Decode(sk_sp<SkData> data,
                                 SkCodec::Result* outResult,
-                                SkCodecs::DecodeContext) {
+                                SkCodecs::DecodeContext ctx) {
     if (!data) {
         if (outResult) {
             *outResult = SkCodec::kInvalidInput;
         }
         return nullptr;
     }
-    return Decode(SkMemoryStream::Make(std::move(data)), outResult, nullptr);
+    return Decode(SkMemoryStream::Make(std::move(data)), outResult, ctx);
 }
 }  // namespace SkRawDecoder
@@ -10,6 +10,8 @@
 
 #include "include/codec/SkCodec.h"
 #include "include/codec/SkEncodedImageFormat.h"
+#include "include/core/SkData.h"
+#include "include/core/SkRefCnt.h"
 #include "include/core/SkSize.h"
 #include "include/core/SkTypes.h"
 
@@ -31,8 +33,11 @@ public:
     /*
      * Creates a RAW decoder
      * Takes ownership of the stream
+     * If useThumbnail is true, small decodes may use the embedded JPEG thumbnail. See
+     * SkRawDecoder::DecodeOptions.
      */
-    static std::unique_ptr<SkCodec> MakeFromStream(std::unique_ptr<SkStream>, Result*);
+    static std::unique_ptr<SkCodec> MakeFromStream(std::unique_ptr<SkStream>, Result*,
+                                                   bool useThumbnail = false);
 
     ~SkRawCodec() override;
 
@@ -58,10 +63,19 @@ private:
     /*
      * Creates an instance of the decoder
      * Called only by NewFromStream, takes ownership of dngImage.
+     * thumbnailData is the embedded JPEG thumbnail, if any and if the client opted in to it.
      */
-    SkRawCodec(SkDngImage* dngImage);
+    SkRawCodec(SkDngImage* dngImage, sk_sp<SkData> thumbnailData, SkISize thumbnailSize);
+
+    /*
+     * Decodes a downscaled dstInfo from the JPEG thumbnail instead of rendering the DNG, if the
+     * thumbnail is at least as large as dstInfo. Returns false if it could not.
+     */
+    bool decodeThumbnail(const SkImageInfo& dstInfo, void* dst, size_t dstRowBytes);
 
     std::unique_ptr<SkDngImage> fDngImage;
+    sk_sp<SkData> fThumbnailData;
+    SkISize fThumbnailSize;
 
     using INHERITED = SkCodec;
 };
@@ -17,6 +17,7 @@
 #include "include/core/SkRect.h"
 #include "include/core/SkSize.h"
 #include "include/core/SkStream.h"
+#include "include/core/SkYUVAInfo.h"
 #include "include/private/base/SkAlign.h"
 #include "include/private/base/SkMath.h"
 #include "include/private/base/SkTFitsIn.h"
@@ -569,6 +570,128 @@ SkCodec::Result SkWebpCodec::onGetPixels(const SkImageInfo& dstInfo, void* dst,
     return result;
 }
 
+bool SkWebpCodec::isYUVSupported(const SkYUVAPixmapInfo::SupportedDataTypes* supportedDataTypes,
+                                 SkYUVAPixmapInfo* yuvaPixmapInfo) const {
+    // Lossless images are stored as BGRA, so libwebp would have to convert them to YUV.
+    const auto color = this->getEncodedInfo().color();
+    if (color != SkEncodedInfo::kYUV_Color && color != SkEncodedInfo::kYUVA_Color) {
+        return false;
+    }
+    if (WebPDemuxGetI(fDemux.get(), WEBP_FF_FORMAT_FLAGS) & ANIMATION_FLAG) {
+        return false;
+    }
+
+    const auto planeConfig = color == SkEncodedInfo::kYUVA_Color ? SkYUVAInfo::PlaneConfig::kY_U_V_A
+                                                                 : SkYUVAInfo::PlaneConfig::kY_U_V;
+    if (supportedDataTypes &&
+        !supportedDataTypes->supported(planeConfig, SkYUVAPixmapInfo::DataType::kUnorm8)) {
+        return false;
+    }
+    if (yuvaPixmapInfo) {
+        // VP8 is always 4:2:0 with BT.601 limited range coefficients.
+        SkYUVAInfo yuvaInfo(this->dimensions(),
+                            planeConfig,
+                            SkYUVAInfo::Subsampling::k420,
+                            kRec601_Limited_SkYUVColorSpace,
+                            this->getOrigin(),
+                            SkYUVAInfo::Siting::kCentered,
+                            SkYUVAInfo::Siting::kCentered);
+        *yuvaPixmapInfo = SkYUVAPixmapInfo(yuvaInfo, SkYUVAPixmapInfo::DataType::kUnorm8, nullptr);
+    }
+    return true;
+}
+
+bool SkWebpCodec::onQueryYUVAInfo(const SkYUVAPixmapInfo::SupportedDataTypes& supportedDataTypes,
+                                  SkYUVAPixmapInfo* yuvaPixmapInfo) const {
+    return this->isYUVSupported(&supportedDataTypes, yuvaPixmapInfo);
+}
+
+SkCodec::Result SkWebpCodec::onGetYUVAPlanes(const SkYUVAPixmaps& yuvaPixmaps) {
+    if (!this->isYUVSupported(nullptr, nullptr)) {
+        return kInvalidInput;
+    }
+    const std::array<SkPixmap, SkYUVAPixmaps::kMaxPlanes>& planes = yuvaPixmaps.planes();
+    const bool hasAlpha = yuvaPixmaps.yuvaInfo().hasAlpha();
+#ifdef SK_DEBUG
+    {
+        SkYUVAPixmapInfo info;
+        SkASSERT(this->isYUVSupported(nullptr, &info));
+        SkASSERT(info.yuvaInfo() == yuvaPixmaps.yuvaInfo());
+        for (int i = 0; i < info.numPlanes(); ++i) {
+            SkASSERT(planes[i].colorType() == kAlpha_8_SkColorType);
+            SkASSERT(info.planeInfo(i).dimensions() == planes[i].dimensions());
+        }
+    }
+#endif
+
+    WebPDecoderConfig config;
+    if (0 == WebPInitDecoderConfig(&config)) {
+        // ABI mismatch.
+        return kInvalidInput;
+    }
+
+    // Free any memory associated with the buffer. Must be called last, so we declare it first.
+    SkAutoTCallVProc<WebPDecBuffer, WebPFreeDecBuffer> autoFree(&(config.output));
+
+    WebPIterator frame;
+    SkAutoTCallVProc<WebPIterator, WebPDemuxReleaseIterator> autoFrame(&frame);
+    if (!WebPDemuxGetFrame(fDemux, 1, &frame)) {
+        return kIncompleteInput;
+    }
+
+    // libwebp writes each plane with its own stride, straight into the client's memory.
+    config.output.colorspace = hasAlpha ? MODE_YUVA : MODE_YUV;
+    config.output.is_external_memory = 1;
+    WebPYUVABuffer& yuva = config.output.u.YUVA;
+    yuva.y = static_cast<uint8_t*>(planes[0].writable_addr());
+    yuva.y_stride = SkToInt(planes[0].rowBytes());
+    yuva.y_size = planes[0].computeByteSize();
+    yuva.u = static_cast<uint8_t*>(planes[1].writable_addr());
+    yuva.u_stride = SkToInt(planes[1].rowBytes());
+    yuva.u_size = planes[1].computeByteSize();
+    yuva.v = static_cast<uint8_t*>(planes[2].writable_addr());
+    yuva.v_stride = SkToInt(planes[2].rowBytes());
+    yuva.v_size = planes[2].computeByteSize();
+    if (hasAlpha) {
+        yuva.a = static_cast<uint8_t*>(planes[3].writable_addr());
+        yuva.a_stride = SkToInt(planes[3].rowBytes());
+        yuva.a_size = planes[3].computeByteSize();
+    }
+
+    SkAutoTCallVProc<WebPIDecoder, WebPIDelete> idec(WebPIDecode(nullptr, 0, &config));
+    if (!idec) {
+        return kInvalidInput;
+    }
+
+    switch (WebPIUpdate(idec, frame.fragment.bytes, frame.fragment.size)) {
+        case VP8_STATUS_OK:
+            return kSuccess;
+        case VP8_STATUS_SUSPENDED: {
+            int rowsDecoded = 0;
+            if (!WebPIDecGetYUVA(idec, &rowsDecoded, nullptr, nullptr, nullptr, nullptr, nullptr,
+                                 nullptr, nullptr, nullptr) || rowsDecoded <= 0) {
+                return kInvalidInput;
+            }
+            // Fill the rows that never arrived with transparent black, as onGetPixels() would.
+            auto fill = [](const SkPixmap& plane, int fromRow, uint8_t value) {
+                for (int y = fromRow; y < plane.height(); ++y) {
+                    memset(plane.writable_addr(0, y), value, plane.width());
+                }
+            };
+            fill(planes[0], rowsDecoded, 16);
+            // Chroma rows that straddle the last decoded luma row may only be partly written.
+            fill(planes[1], rowsDecoded / 2, 128);
+            fill(planes[2], rowsDecoded / 2, 128);
+            if (hasAlpha) {
+                fill(planes[3], rowsDecoded, 0);
+            }
+            return kIncompleteInput;
+        }
+        default:
+            return kInvalidInput;
+    }
+}
+
 SkWebpCodec::SkWebpCodec(SkEncodedInfo&& info, std::unique_ptr<SkStream> stream,
                          WebPDemuxer* demux, sk_sp<SkData> data, SkEncodedOrigin origin)
     : INHERITED(std::move(info), skcms_PixelFormat_BGRA_8888, std::move(stream),
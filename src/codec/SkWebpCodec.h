@@ -13,6 +13,7 @@
 #include "include/core/SkData.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkTypes.h"
+#include "include/core/SkYUVAPixmaps.h"
 #include "include/private/SkEncodedInfo.h"
 #include "include/private/base/SkTemplates.h"
 #include "src/codec/SkFrameHolder.h"
@@ -43,6 +44,11 @@ protected:
 
     bool onGetValidSubset(SkIRect* /* desiredSubset */) const override;
 
+    bool onQueryYUVAInfo(const SkYUVAPixmapInfo::SupportedDataTypes&,
+                         SkYUVAPixmapInfo*) const override;
+
+    Result onGetYUVAPlanes(const SkYUVAPixmaps& yuvaPixmaps) override;
+
     int onGetFrameCount() override;
     bool onGetFrameInfo(int, FrameInfo*) const override;
     int onGetRepetitionCount() override;
@@ -55,6 +61,10 @@ private:
     SkWebpCodec(SkEncodedInfo&&, std::unique_ptr<SkStream>, WebPDemuxer*, sk_sp<SkData>,
                 SkEncodedOrigin);
 
+    // Lossy still images are stored as 4:2:0 YUV, with alpha (if any) as its own plane. Reports
+    // those planes as is, or returns false for lossless and animated images.
+    bool isYUVSupported(const SkYUVAPixmapInfo::SupportedDataTypes*, SkYUVAPixmapInfo*) const;
+
     SkAutoTCallVProc<WebPDemuxer, WebPDemuxDelete> fDemux;
 
     // fDemux has a pointer into this data.
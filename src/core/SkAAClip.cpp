@@ -19,6 +19,7 @@
 #include "include/private/base/SkMath.h"
 #include "include/private/base/SkTDArray.h"
 #include "include/private/base/SkTo.h"
+#include "src/base/SkVx.h"
 #include "src/core/SkBlitter.h"
 #include "src/core/SkMask.h"
 #include "src/core/SkScan.h"
@@ -521,6 +522,19 @@ private:
     }
 
     static void AppendRun(SkTDArray<uint8_t>& data, U8CPU alpha, int count) {
+        // Blitters often hand us neighbouring spans of the same coverage; extend the last run
+        // rather than splitting the row into more runs for every later operation to walk.
+        if (!data.empty()) {
+            uint8_t* last = data.end() - 2;
+            if (last[1] == alpha && last[0] < 255) {
+                int n = std::min(count, 255 - last[0]);
+                last[0] += n;
+                count -= n;
+                if (0 == count) {
+                    return;
+                }
+            }
+        }
         do {
             int n = count;
             if (n > 255) {
@@ -1261,6 +1275,13 @@ SkAAClip& SkAAClip::operator=(const SkAAClip& src) {
     return *this;
 }
 
+size_t SkAAClip::approximateBytesUsed() const {
+    if (!fRunHead) {
+        return 0;
+    }
+    return sizeof(RunHead) + fRunHead->fRowCount * sizeof(YOffset) + fRunHead->fDataSize;
+}
+
 bool SkAAClip::setEmpty() {
     this->freeRuns();
     fBounds.setEmpty();
@@ -1809,6 +1830,26 @@ static inline uint16_t mergeOne(uint16_t value, unsigned alpha) {
                        SkMulDiv255Round(b, alpha));
 }
 
+static void mergeRow(const uint8_t* SK_RESTRICT src, int n, unsigned alpha,
+                     uint8_t* SK_RESTRICT dst) {
+    using U16 = skvx::Vec<16, uint16_t>;
+    for (; n >= 16; n -= 16, src += 16, dst += 16) {
+        // div255() rounds exactly like SkMulDiv255Round().
+        skvx::cast<uint8_t>(skvx::div255(skvx::cast<uint16_t>(skvx::byte16::Load(src)) *
+                                         U16(alpha))).store(dst);
+    }
+    for (int i = 0; i < n; ++i) {
+        dst[i] = mergeOne(src[i], alpha);
+    }
+}
+
+static void mergeRow(const uint16_t* SK_RESTRICT src, int n, unsigned alpha,
+                     uint16_t* SK_RESTRICT dst) {
+    for (int i = 0; i < n; ++i) {
+        dst[i] = mergeOne(src[i], alpha);
+    }
+}
+
 template <typename T>
 void mergeT(const void* inSrc, int srcN, const uint8_t* SK_RESTRICT row, int rowN, void* inDst) {
     const T* SK_RESTRICT src = static_cast<const T*>(inSrc);
@@ -1824,9 +1865,7 @@ void mergeT(const void* inSrc, int srcN, const uint8_t* SK_RESTRICT row, int row
         } else if (0 == rowA) {
             small_bzero(dst, n * sizeof(T));
         } else {
-            for (int i = 0; i < n; ++i) {
-                dst[i] = mergeOne(src[i], rowA);
-            }
+            mergeRow(src, n, rowA, dst);
         }
 
         if (0 == (srcN -= n)) {
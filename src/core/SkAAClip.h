@@ -48,6 +48,9 @@ public:
 
     bool translate(int dx, int dy, SkAAClip* dst) const;
 
+    // The memory held by the clip's runs, which copies of it share.
+    size_t approximateBytesUsed() const;
+
     /**
      *  Allocates a mask the size of the aaclip, and expands its data into
      *  the mask, using kA8_Format. Used for tests and visualization purposes.
@@ -53,6 +53,9 @@ public:
     size_t approximateBytesUsed() const override;
     const SkBigPicture* asSkBigPicture() const override { return this; }
 
+// Like playback(), but searches bbh rather than the picture's own BBH.
+    void playback(SkCanvas*, const SkBBoxHierarchy* bbh) const;
+
 // Used by GrRecordReplaceDraw
     const SkBBoxHierarchy* bbh() const { return fBBH.get(); }
     const SkRecord*     record() const { return fRecord.get(); }
@@ -28,16 +28,20 @@
 #include "include/core/SkSurfaceProps.h"
 #include "include/core/SkTileMode.h"
 #include "include/private/base/SkAssert.h"
+#include "include/private/base/SkTArray.h"
 #include "include/private/base/SkTo.h"
 #include "src/base/SkTLazy.h"
 #include "src/core/SkDraw.h"
 #include "src/core/SkImagePriv.h"
+#include "src/core/SkLayerPixelPool.h"
 #include "src/core/SkMatrixPriv.h"
+#include "src/core/SkMatrixUtils.h"
 #include "src/core/SkRasterClip.h"
 #include "src/core/SkSpecialImage.h"
 #include "src/image/SkImage_Base.h"
 #include "src/text/GlyphRun.h"
 
+#include <cmath>
 #include <utility>
 
 class SkVertices;
@@ -302,6 +306,15 @@ sk_sp<SkDevice> SkBitmapDevice::createDevice(const CreateInfo& cinfo, const SkPa
         info = info.makeColorType(kN32_SkColorType);
     }
 
+    // Layers come and go many times a frame, so try to reuse the memory of earlier ones.
+    SkAlphaType newAT = info.alphaType();
+    if (!cinfo.fAllocator && valid_for_bitmap_device(info, &newAT)) {
+        SkBitmap bitmap;
+        if (SkLayerPixelPool::Global()->allocPixels(info.makeAlphaType(newAT), &bitmap)) {
+            return sk_make_sp<SkBitmapDevice>(bitmap, surfaceProps);
+        }
+    }
+
     return SkBitmapDevice::Create(info, surfaceProps, cinfo.fAllocator);
 }
 
@@ -566,6 +579,92 @@ void SkBitmapDevice::drawAtlas(const SkRSXform xform[],
     BDDraw(this).drawAtlas(xform, tex, colors, count, std::move(blender), paint);
 }
 
+// Computes where 'entry' lands if it draws as an unscaled, pixel-aligned copy of an integer
+// subset of its image (the same test drawImageRect() uses to take the sprite path).
+static bool image_set_entry_as_sprite(const SkCanvas::ImageSetEntry& entry,
+                                      const SkMatrix& ctm,
+                                      const SkMatrix preViewMatrices[],
+                                      const SkSamplingOptions& sampling,
+                                      SkIRect* srcRect,
+                                      SkIPoint* dstPoint) {
+    if (entry.fHasClip) {
+        return false;
+    }
+    const SkIRect src = entry.fSrcRect.round();
+    if (src.isEmpty() || SkRect::Make(src) != entry.fSrcRect ||
+        !entry.fImage->bounds().contains(src)) {
+        return false;
+    }
+
+    SkMatrix m = ctm;
+    if (entry.fMatrixIndex >= 0) {
+        m.preConcat(preViewMatrices[entry.fMatrixIndex]);
+    }
+    m.preConcat(SkMatrix::RectToRect(entry.fSrcRect, entry.fDstRect));
+    m.preTranslate(src.fLeft, src.fTop);
+
+    // Keep the rounded dst rect well inside int range (this also rejects NaN).
+    constexpr float kMaxCoord = 1 << 29;
+    if (!(std::abs(m.getTranslateX()) < kMaxCoord && std::abs(m.getTranslateY()) < kMaxCoord) ||
+        !SkTreatAsSprite(m, src.size(), sampling,
+                         entry.fAAFlags == SkCanvas::kAll_QuadAAFlags)) {
+        return false;
+    }
+    *srcRect = src;
+    *dstPoint = {SkScalarRoundToInt(m.getTranslateX()), SkScalarRoundToInt(m.getTranslateY())};
+    return true;
+}
+
+void SkBitmapDevice::drawEdgeAAImageSet(const SkCanvas::ImageSetEntry images[], int count,
+                                        const SkPoint dstClips[], const SkMatrix preViewMatrices[],
+                                        const SkSamplingOptions& sampling, const SkPaint& paint,
+                                        SkCanvas::SrcRectConstraint constraint) {
+    // Runs of entries that copy pixel-aligned rects out of the same raster image with the same
+    // alpha (e.g. tiles of a composited layer) are drawn as one sprite batch. Everything else
+    // goes through drawImageRect() one entry at a time.
+    const bool canBatch = !SkDrawTiler::NeedsTiling(this) && fRCStack.rc().isBW();
+    skia_private::TArray<SkIRect> srcRects;
+    skia_private::TArray<SkIPoint> dstPoints;
+    int clipIndex = 0;
+    for (int i = 0; i < count;) {
+        srcRects.clear();
+        dstPoints.clear();
+        for (int j = i; canBatch && j < count; ++j) {
+            if (images[j].fImage != images[i].fImage || images[j].fAlpha != images[i].fAlpha ||
+                !image_set_entry_as_sprite(images[j], this->localToDevice(), preViewMatrices,
+                                           sampling, &srcRects.push_back(),
+                                           &dstPoints.push_back())) {
+                srcRects.pop_back();
+                dstPoints.pop_back();
+                break;
+            }
+        }
+
+        const int n = srcRects.size();
+        if (n > 1) {
+            SkBitmap bitmap;
+            SkPixmap pixmap;
+            SkPaint entryPaint(paint);
+            entryPaint.setAlphaf(paint.getAlphaf() * images[i].fAlpha);
+            // TODO: Elevate direct context requirement to public API and remove cheat.
+            auto dContext = as_IB(images[i].fImage.get())->directContext();
+            if (as_IB(images[i].fImage.get())->getROPixels(dContext, &bitmap) &&
+                bitmap.peekPixels(&pixmap) &&
+                BDDraw(this).drawSprites(pixmap, srcRects.data(), dstPoints.data(), n,
+                                         entryPaint)) {
+                i += n;
+                continue;
+            }
+        }
+
+        const SkPoint* clip = images[i].fHasClip ? dstClips + clipIndex : nullptr;
+        this->SkDevice::drawEdgeAAImageSet(images + i, 1, clip, preViewMatrices, sampling, paint,
+                                           constraint);
+        clipIndex += images[i].fHasClip ? 4 : 0;
+        ++i;
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 void SkBitmapDevice::drawSpecial(SkSpecialImage* src,
@@ -21,6 +21,7 @@ namespace SkOpts {
     DEFINE_DEFAULT(blit_mask_d32_a8);
 
     void Init_BlitMask_ssse3();
+    void Init_BlitMask_skx();  // In src/opts/SkOpts_skx.cpp, built with AVX-512 enabled.
 
     static bool init() {
     #if defined(SK_ENABLE_OPTIMIZE_SIZE)
@@ -29,6 +30,10 @@ namespace SkOpts {
         #if SK_CPU_SSE_LEVEL < SK_CPU_SSE_LEVEL_SSSE3
             if (SkCpu::Supports(SkCpu::SSSE3)) { Init_BlitMask_ssse3(); }
         #endif
+
+        #if (SK_CPU_SSE_LEVEL < SK_CPU_SSE_LEVEL_SKX) && defined(SK_ENABLE_AVX512_OPTS)
+            if (SkCpu::Supports(SkCpu::SKX)) { Init_BlitMask_skx(); }
+        #endif
     #endif
       return true;
     }
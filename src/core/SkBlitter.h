@@ -26,6 +26,7 @@ class SkMatrix;
 class SkPaint;
 class SkPixmap;
 class SkShader;
+class SkSpriteBlitter;
 class SkSurfaceProps;
 struct SkMask;
 
@@ -150,11 +151,11 @@ public:
                              sk_sp<SkShader> clipShader,
                              const SkSurfaceProps& props);
 
-    static SkBlitter* ChooseSprite(const SkPixmap& dst,
-                                   const SkPaint&,
-                                   const SkPixmap& src,
-                                   int left, int top,
-                                   SkArenaAlloc*, sk_sp<SkShader> clipShader);
+    static SkSpriteBlitter* ChooseSprite(const SkPixmap& dst,
+                                         const SkPaint&,
+                                         const SkPixmap& src,
+                                         int left, int top,
+                                         SkArenaAlloc*, sk_sp<SkShader> clipShader);
     ///@}
 
     static bool UseLegacyBlitter(const SkPixmap&, const SkPaint&, const SkMatrix&);
@@ -192,9 +192,9 @@ private:
 
 // returning null means the caller will call SkBlitter::Choose() and
 // have wrapped the source bitmap inside a shader
-SkBlitter* SkBlitter::ChooseSprite(const SkPixmap& dst, const SkPaint& paint,
-                                   const SkPixmap& source, int left, int top,
-                                   SkArenaAlloc* alloc, sk_sp<SkShader> clipShader) {
+SkSpriteBlitter* SkBlitter::ChooseSprite(const SkPixmap& dst, const SkPaint& paint,
+                                         const SkPixmap& source, int left, int top,
+                                         SkArenaAlloc* alloc, sk_sp<SkShader> clipShader) {
     /*  We currently ignore antialiasing and filtertype, meaning we will take our
         special blitters regardless of these settings. Ignoring filtertype seems fine
         since by definition there is no scale in the matrix. Ignoring antialiasing is
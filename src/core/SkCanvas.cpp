@@ -55,6 +55,7 @@
 #include "src/core/SkMaskFilterBase.h"
 #include "src/core/SkMatrixPriv.h"
 #include "src/core/SkPaintPriv.h"
+#include "src/core/SkPictureLayerCache.h"
 #include "src/core/SkSpecialImage.h"
 #include "src/core/SkSurfacePriv.h"
 #include "src/core/SkTraceEvent.h"
@@ -143,11 +144,32 @@ bool SkCanvas::wouldOverwriteEntireSurface(const SkRect* rect, const SkPaint* pa
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
-bool SkCanvas::predrawNotify(bool willOverwritesEntireSurface) {
+SkIRect SkCanvas::surfaceDirtyBounds(const SkRect* rect, const SkPaint* paint) const {
+    const SkDevice* root = this->rootDevice();
+    if (this->topDevice() != root) {
+        return SkIRect::MakeEmpty();
+    }
+    SkIRect bounds = root->devClipBounds();
+    const SkMatrix& ctm = this->getTotalMatrix();
+    if (rect && paint && paint->canComputeFastBounds() && !ctm.hasPerspective()) {
+        SkRect storage;
+        SkRect devRect = ctm.mapRect(paint->computeFastBounds(*rect, &storage));
+        // Outset for anti-aliasing.
+        if (devRect.isFinite() && !bounds.intersect(devRect.roundOut().makeOutset(1, 1))) {
+            return SkIRect::MakeEmpty();
+        }
+    }
+    return bounds;
+}
+
+bool SkCanvas::predrawNotify(bool willOverwritesEntireSurface, const SkIRect* deviceBounds) {
     if (fSurfaceBase) {
+        const SkIRect dirty = deviceBounds ? *deviceBounds
+                                           : this->surfaceDirtyBounds(nullptr, nullptr);
         if (!fSurfaceBase->aboutToDraw(willOverwritesEntireSurface
                                        ? SkSurface::kDiscard_ContentChangeMode
-                                       : SkSurface::kRetain_ContentChangeMode)) {
+                                       : SkSurface::kRetain_ContentChangeMode,
+                                       &dirty)) {
             return false;
         }
     }
@@ -162,12 +184,14 @@ bool SkCanvas::predrawNotify(const SkRect* rect, const SkPaint* paint,
         // there is an outstanding snapshot, since w/o that, there will be no copy-on-write
         // and therefore we don't care which mode we're in.
         //
-        if (fSurfaceBase->outstandingImageSnapshot()) {
+        if ((flags & PredrawFlags::kCheckForOverwrite) &&
+            fSurfaceBase->outstandingImageSnapshot()) {
             if (this->wouldOverwriteEntireSurface(rect, paint, flags)) {
                 mode = SkSurface::kDiscard_ContentChangeMode;
             }
         }
-        if (!fSurfaceBase->aboutToDraw(mode)) {
+        const SkIRect dirty = this->surfaceDirtyBounds(rect, paint);
+        if (!fSurfaceBase->aboutToDraw(mode, &dirty)) {
             return false;
         }
     }
@@ -254,14 +278,8 @@ std::optional<AutoLayerForImageFilter> SkCanvas::aboutToDraw(
         const SkPaint& paint,
         const SkRect* rawBounds,
         SkEnumBitMask<PredrawFlags> flags) {
-    if (flags & PredrawFlags::kCheckForOverwrite) {
-        if (!this->predrawNotify(rawBounds, &paint, flags)) {
-            return std::nullopt;
-        }
-    } else {
-        if (!this->predrawNotify()) {
-            return std::nullopt;
-        }
+    if (!this->predrawNotify(rawBounds, &paint, flags)) {
+        return std::nullopt;
     }
 
     // TODO: Eventually all devices will use this code path and this will just test 'flags'.
@@ -409,7 +427,7 @@ bool SkCanvas::writePixels(const SkImageInfo& srcInfo, const void* pixels, size_
 
     // Tell our owning surface to bump its generation ID.
     const bool completeOverwrite = srcRect.size() == device->imageInfo().dimensions();
-    if (!this->predrawNotify(completeOverwrite)) {
+    if (!this->predrawNotify(completeOverwrite, &srcRect)) {
         return false;
     }
 
@@ -849,7 +867,34 @@ void SkCanvas::internalDrawDeviceWithFilter(SkDevice* src,
     sk_sp<SkImageFilter> nullFilter;
     FilterSpan filtersOrNull = filters.empty() ? FilterSpan{&nullFilter, 1} : filters;
 
+    // Tiles are clipped to exactly on the device, so only tile when layer pixels map 1:1 to device
+    // pixels. Coverage layers draw a mask instead and aren't tiled.
+    const SkMatrix& layerToDevice = mapping.layerToDevice();
+    const bool canTile = !srcIsCoverageLayer && layerToDevice.isTranslate() &&
+                         SkScalarIsInt(layerToDevice.getTranslateX()) &&
+                         SkScalarIsInt(layerToDevice.getTranslateY());
+
     for (const sk_sp<SkImageFilter>& filter : filtersOrNull) {
+        if (filter && canTile &&
+            skif::EvaluateTiled(
+                    ctx,
+                    [&](const skif::Context& tileCtx) {
+                        return as_IFB(filter)->filterImage(tileCtx);
+                    },
+                    [&](const skif::Context& tileCtx, const skif::FilterResult& tileResult) {
+                        dst->pushClipStack();
+                        {
+                            SkAutoDeviceTransformRestore adtr{dst, layerToDevice};
+                            dst->clipRect(SkRect::Make(SkIRect(tileCtx.desiredOutput())),
+                                          SkClipOp::kIntersect, /*aa=*/false);
+                        }
+                        apply_alpha_and_colorfilter(tileCtx, tileResult, paint)
+                                .draw(tileCtx, dst, paint.getBlender());
+                        dst->popClipStack();
+                    })) {
+            continue;
+        }
+
         auto result = filter ? as_IFB(filter)->filterImage(ctx) : source;
 
         if (srcIsCoverageLayer) {
@@ -2213,7 +2258,8 @@ void SkCanvas::onDrawImageRect2(const SkImage* image, const SkRect& src, const S
 
     if (this->topDevice()->shouldDrawAsTiledImageRect()) {
         if (this->topDevice()->drawAsTiledImageRect(
-                    this, image, &src, dst, realSampling, realPaint, constraint)) {
+                    this, image, &src, dst, realSampling, realPaint, constraint,
+                    /*streamer=*/nullptr)) {
             return;
         }
     }
@@ -2583,6 +2629,13 @@ void SkCanvas::drawDrawable(SkDrawable* dr, const SkMatrix* matrix) {
 }
 
 void SkCanvas::onDrawDrawable(SkDrawable* dr, const SkMatrix* matrix) {
+    SkPixmap pm;
+    if (SkPictureLayerCache::Global()->isEnabled() && this->topDevice()->peekPixels(&pm) &&
+        this->topDevice()->isPixelAlignedToGlobal() &&
+        SkPictureLayerCache::Global()->drawDrawable(this, pm.info(), dr, matrix)) {
+        return;
+    }
+
     // drawable bounds are no longer reliable (e.g. android displaylist)
     // so don't use them for quick-reject
     if (this->predrawNotify()) {
@@ -2765,6 +2818,13 @@ void SkCanvas::onDrawPicture(const SkPicture* picture, const SkMatrix* matrix,
         return;
     }
 
+    SkPixmap pm;
+    if (SkPictureLayerCache::Global()->isEnabled() && this->topDevice()->peekPixels(&pm) &&
+        this->topDevice()->isPixelAlignedToGlobal() &&
+        SkPictureLayerCache::Global()->drawPicture(this, pm.info(), picture, matrix, paint)) {
+        return;
+    }
+
     SkAutoCanvasMatrixPaint acmp(this, matrix, paint, picture->cullRect());
     picture->playback(this);
 }
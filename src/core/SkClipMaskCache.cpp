@@ -0,0 +1,137 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/core/SkClipMaskCache.h"
+
+#include "include/core/SkMatrix.h"
+#include "include/core/SkPath.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkRegion.h"
+#include "include/core/SkTypes.h"
+#include "include/private/SkIDChangeListener.h"
+#include "src/core/SkAAClip.h"
+#include "src/core/SkPathPriv.h"
+#include "src/core/SkResourceCache.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+#define CHECK_LOCAL(localCache, localName, globalName, ...) \
+    ((localCache) ? localCache->localName(__VA_ARGS__) : SkResourceCache::globalName(__VA_ARGS__))
+
+// Rasterizing a path this short costs less than a cache lookup.
+static constexpr int kMinVerbsToCache = 8;
+
+static uint64_t make_shared_id(uint32_t pathGenID) {
+    uint64_t sharedID = SkSetFourByteTag('c', 'l', 'i', 'p');
+    return (sharedID << 32) | pathGenID;
+}
+
+static bool can_cache(const SkPath& path) {
+    return !path.isVolatile() && path.countVerbs() >= kMinVerbsToCache;
+}
+
+namespace {
+static unsigned gClipMaskKeyNamespaceLabel;
+
+enum class MaskType : uint32_t { kBW, kAA, kAAWithoutAA };
+
+struct ClipMaskKey : public SkResourceCache::Key {
+public:
+    ClipMaskKey(const SkPath& path, const SkMatrix& ctm, const SkIRect& bounds, MaskType type)
+        : fGenID(path.getGenerationID())
+        , fBounds(bounds)
+        , fType(type) {
+        ctm.get9(fMatrix);
+        this->init(&gClipMaskKeyNamespaceLabel, make_shared_id(fGenID),
+                   sizeof(fGenID) + sizeof(fMatrix) + sizeof(fBounds) + sizeof(fType));
+    }
+
+    uint32_t fGenID;
+    SkScalar fMatrix[9];
+    SkIRect  fBounds;
+    MaskType fType;
+};
+
+class ClipMaskPurgeListener final : public SkIDChangeListener {
+public:
+    explicit ClipMaskPurgeListener(uint64_t sharedID) : fSharedID(sharedID) {}
+
+    void changed() override { SkResourceCache::PostPurgeSharedID(fSharedID); }
+
+private:
+    uint64_t fSharedID;
+};
+
+// Both SkRegion and SkAAClip share their runs on copy, so holding one here and handing out
+// copies costs a ref, not the mask.
+template <typename Mask>
+struct ClipMaskRec : public SkResourceCache::Rec {
+    ClipMaskRec(const ClipMaskKey& key, const Mask& mask, sk_sp<SkIDChangeListener> listener)
+        : fKey(key), fMask(mask), fListener(std::move(listener)) {}
+    ~ClipMaskRec() override {
+        fListener->markShouldDeregister();
+    }
+
+    ClipMaskKey fKey;
+    Mask fMask;
+    sk_sp<SkIDChangeListener> fListener;
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override { return sizeof(*this) + bytes_used(fMask); }
+    const char* getCategory() const override { return "clip-mask"; }
+    SkDiscardableMemory* diagnostic_only_getDiscardable() const override { return nullptr; }
+
+    static size_t bytes_used(const SkRegion& rgn) { return rgn.writeToMemory(nullptr); }
+    static size_t bytes_used(const SkAAClip& clip) { return clip.approximateBytesUsed(); }
+
+    static bool Visitor(const SkResourceCache::Rec& baseRec, void* contextData) {
+        const ClipMaskRec& rec = static_cast<const ClipMaskRec&>(baseRec);
+        *static_cast<Mask*>(contextData) = rec.fMask;
+        return true;
+    }
+};
+} // namespace
+
+template <typename Mask, typename SetPathFn>
+static bool set_path(Mask* dst, const SkPath& path, const SkMatrix& ctm, const SkIRect& bounds,
+                     MaskType type, SkResourceCache* localCache, SetPathFn&& setPath) {
+    if (!can_cache(path)) {
+        return setPath(dst, path.makeTransform(ctm));
+    }
+
+    const ClipMaskKey key(path, ctm, bounds, type);
+    if (CHECK_LOCAL(localCache, find, Find, key, ClipMaskRec<Mask>::Visitor, dst)) {
+        return !dst->isEmpty();
+    }
+
+    const bool nonEmpty = setPath(dst, path.makeTransform(ctm));
+    auto listener = sk_make_sp<ClipMaskPurgeListener>(key.getSharedID());
+    SkPathPriv::AddGenIDChangeListener(path, listener);
+    CHECK_LOCAL(localCache, add, Add, new ClipMaskRec<Mask>(key, *dst, std::move(listener)));
+    return nonEmpty;
+}
+
+bool SkClipMaskCache::SetPath(SkRegion* rgn, const SkPath& path, const SkMatrix& ctm,
+                              const SkIRect& bounds, SkResourceCache* localCache) {
+    return set_path(rgn, path, ctm, bounds, MaskType::kBW, localCache,
+                    [&](SkRegion* dst, const SkPath& devPath) {
+                        return dst->setPath(devPath, SkRegion(bounds));
+                    });
+}
+
+bool SkClipMaskCache::SetPath(SkAAClip* clip, const SkPath& path, const SkMatrix& ctm,
+                              const SkIRect& bounds, bool doAA, SkResourceCache* localCache) {
+    return set_path(clip, path, ctm, bounds, doAA ? MaskType::kAA : MaskType::kAAWithoutAA,
+                    localCache,
+                    [&](SkAAClip* dst, const SkPath& devPath) {
+                        return dst->setPath(devPath, bounds, doAA);
+                    });
+}
@@ -0,0 +1,34 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkClipMaskCache_DEFINED
+#define SkClipMaskCache_DEFINED
+
+struct SkIRect;
+class SkAAClip;
+class SkMatrix;
+class SkPath;
+class SkRegion;
+class SkResourceCache;
+
+class SkClipMaskCache {
+public:
+    /**
+     * Like rgn->setPath(path mapped by ctm, SkRegion(bounds)), or clip->setPath(path mapped by
+     * ctm, bounds, doAA). Reuses the coverage from an earlier call with the same path (by
+     * generation ID), matrix and bounds while it is in the SkResourceCache. The entries are purged
+     * when the path's generation ID goes away.
+     *
+     * Volatile paths and small paths are rasterized every time.
+     */
+    static bool SetPath(SkRegion* rgn, const SkPath& path, const SkMatrix& ctm,
+                        const SkIRect& bounds, SkResourceCache* localCache = nullptr);
+    static bool SetPath(SkAAClip* clip, const SkPath& path, const SkMatrix& ctm,
+                        const SkIRect& bounds, bool doAA, SkResourceCache* localCache = nullptr);
+};
+
+#endif
@@ -0,0 +1,120 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/core/SkColorLUTCache.h"
+
+#include "include/core/SkColorSpace.h"
+#include "include/effects/SkRuntimeEffect.h"
+#include "src/core/SkChecksum.h"
+#include "src/core/SkResourceCache.h"
+#include "src/core/SkRuntimeEffectPriv.h"
+
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#define CHECK_LOCAL(localCache, localName, globalName, ...) \
+    ((localCache) ? localCache->localName(__VA_ARGS__) : SkResourceCache::globalName(__VA_ARGS__))
+
+namespace {
+static unsigned gColorLUTKeyNamespaceLabel;
+
+uint32_t color_space_hash(const SkColorSpace* cs) {
+    const uint64_t hash = cs ? cs->hash() : 0;
+    return (uint32_t)(hash ^ (hash >> 32));
+}
+
+struct ColorLUTKey : public SkResourceCache::Key {
+    ColorLUTKey(const SkRuntimeEffect& effect, SkColorSpace* dstCS, SkSpan<const float> uniforms)
+            : fEffectHash(SkRuntimeEffectPriv::Hash(effect))
+            , fColorSpaceHash(color_space_hash(dstCS))
+            , fUniformsHash(SkChecksum::Hash32(uniforms.data(), uniforms.size_bytes()))
+            , fUniformCount(uniforms.size()) {
+        this->init(&gColorLUTKeyNamespaceLabel, /*sharedID=*/0,
+                   sizeof(fEffectHash) + sizeof(fColorSpaceHash) + sizeof(fUniformsHash) +
+                   sizeof(fUniformCount));
+    }
+
+    uint32_t fEffectHash;
+    uint32_t fColorSpaceHash;
+    uint32_t fUniformsHash;
+    uint32_t fUniformCount;
+};
+
+// The key only holds hashes, so the Rec keeps what the LUT was baked from, to check for collisions.
+struct ColorLUTQuery {
+    const SkRuntimeEffect& fEffect;
+    SkColorSpace* fDstCS;
+    SkSpan<const float> fUniforms;
+
+    sk_sp<const SkColorLUT> fResult;
+};
+
+struct ColorLUTRec : public SkResourceCache::Rec {
+    ColorLUTRec(const SkRuntimeEffect& effect,
+                SkColorSpace* dstCS,
+                SkSpan<const float> uniforms,
+                sk_sp<const SkColorLUT> lut)
+            : fKey(effect, dstCS, uniforms)
+            , fEffect(sk_ref_sp(&effect))
+            , fDstCS(sk_ref_sp(dstCS))
+            , fUniforms(uniforms.begin(), uniforms.end())
+            , fLUT(std::move(lut)) {}
+
+    ColorLUTKey fKey;
+    sk_sp<const SkRuntimeEffect> fEffect;
+    sk_sp<SkColorSpace> fDstCS;
+    std::vector<float> fUniforms;
+    sk_sp<const SkColorLUT> fLUT;
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override {
+        return sizeof(*this) + fUniforms.size() * sizeof(float) + fLUT->bytesUsed();
+    }
+    const char* getCategory() const override { return "color-lut"; }
+
+    bool matches(const ColorLUTQuery& query) const {
+        return (fEffect.get() == &query.fEffect ||
+                fEffect->source() == query.fEffect.source()) &&
+               SkColorSpace::Equals(fDstCS.get(), query.fDstCS) &&
+               fUniforms.size() == query.fUniforms.size() &&
+               !memcmp(fUniforms.data(), query.fUniforms.data(), query.fUniforms.size_bytes());
+    }
+
+    static bool Visitor(const SkResourceCache::Rec& baseRec, void* contextData) {
+        const ColorLUTRec& rec = static_cast<const ColorLUTRec&>(baseRec);
+        ColorLUTQuery* query = static_cast<ColorLUTQuery*>(contextData);
+        if (!rec.matches(*query)) {
+            // A hash collision; the entry will be replaced by the LUT the caller bakes instead.
+            return false;
+        }
+        query->fResult = rec.fLUT;
+        return true;
+    }
+};
+}  // namespace
+
+sk_sp<const SkColorLUT> SkColorLUTCache::Find(const SkRuntimeEffect& effect,
+                                              SkColorSpace* dstCS,
+                                              SkSpan<const float> uniforms,
+                                              SkResourceCache* localCache) {
+    ColorLUTKey key(effect, dstCS, uniforms);
+    ColorLUTQuery query{effect, dstCS, uniforms, nullptr};
+    if (!CHECK_LOCAL(localCache, find, Find, key, ColorLUTRec::Visitor, &query)) {
+        return nullptr;
+    }
+    return std::move(query.fResult);
+}
+
+void SkColorLUTCache::Add(const SkRuntimeEffect& effect,
+                          SkColorSpace* dstCS,
+                          SkSpan<const float> uniforms,
+                          sk_sp<const SkColorLUT> lut,
+                          SkResourceCache* localCache) {
+    return CHECK_LOCAL(localCache, add, Add,
+                       new ColorLUTRec(effect, dstCS, uniforms, std::move(lut)));
+}
@@ -0,0 +1,61 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkColorLUTCache_DEFINED
+#define SkColorLUTCache_DEFINED
+
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkSpan.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class SkColorSpace;
+class SkResourceCache;
+class SkRuntimeEffect;
+
+/**
+ * A runtime color filter, baked into lookup tables for the CPU backend. (See
+ * SkRuntimeEffect::Options::bakeColorFilterLUT.) A filter whose R, G and B outputs each depend only
+ * on the matching input channel, and whose alpha is constant, is baked into one byte table per
+ * channel; any other filter is baked into a 3D table of premul colors.
+ */
+struct SkColorLUT : public SkNVRefCnt<SkColorLUT> {
+    static constexpr int k3DSize = 33;
+
+    bool fSeparable = false;
+
+    // When fSeparable: unpremul output channels, indexed by the unpremul input channel. (The alpha
+    // table maps the input alpha to the output alpha.)
+    uint8_t fTableA[256] = {}, fTableR[256] = {}, fTableG[256] = {}, fTableB[256] = {};
+
+    // Otherwise: k3DSize^3 premul RGBA colors, laid out for the lut_3D raster pipeline stage.
+    std::vector<float> f3D;
+
+    size_t bytesUsed() const { return sizeof(*this) + f3D.size() * sizeof(float); }
+};
+
+class SkColorLUTCache {
+public:
+    /**
+     * Returns the LUT baked from `effect` with these uniforms, for drawing into `dstCS`, or nullptr
+     * if it isn't in the cache.
+     */
+    static sk_sp<const SkColorLUT> Find(const SkRuntimeEffect& effect,
+                                        SkColorSpace* dstCS,
+                                        SkSpan<const float> uniforms,
+                                        SkResourceCache* localCache = nullptr);
+
+    static void Add(const SkRuntimeEffect& effect,
+                    SkColorSpace* dstCS,
+                    SkSpan<const float> uniforms,
+                    sk_sp<const SkColorLUT> lut,
+                    SkResourceCache* localCache = nullptr);
+};
+
+#endif
@@ -33,7 +33,8 @@ SkColorSpaceXformSteps::SkColorSpaceXformSteps(const SkColorSpace* src, SkAlphaT
     if (!src) { src = sk_srgb_singleton(); }
     if (!dst) { dst = src; }
 
-    if (src->hash() == dst->hash() && srcAT == dstAT) {
+    // Interned color spaces (e.g. from decoded ICC profiles) usually match by pointer.
+    if ((src == dst || src->hash() == dst->hash()) && srcAT == dstAT) {
         SkASSERT(SkColorSpace::Equals(src,dst));
         return;
     }
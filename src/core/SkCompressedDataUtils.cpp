@@ -11,6 +11,7 @@
 #include "include/core/SkColor.h"
 #include "include/core/SkColorPriv.h"
 #include "include/core/SkData.h"
+#include "include/core/SkPixmap.h"
 #include "include/core/SkScalar.h"
 #include "include/core/SkSize.h"
 #include "include/private/SkColorData.h"
@@ -20,7 +21,11 @@
 #include "src/core/SkMipmap.h"
 
 #include <algorithm>
+#include <cmath>
 #include <cstdint>
+#include <cstring>
+#include <limits>
+#include <utility>
 
 using namespace skia_private;
 
@@ -234,6 +239,348 @@ static bool decompress_bc1(SkISize dimensions, const uint8_t* srcData,
     return true;
 }
 
+//------------------------------------------------------------------------------------------------
+namespace {
+
+struct RGB {
+    int fR, fG, fB;
+};
+
+int color_error(const RGB& a, const RGB& b) {
+    int dr = a.fR - b.fR, dg = a.fG - b.fG, db = a.fB - b.fB;
+    return dr * dr + dg * dg + db * db;
+}
+
+// Reads the 4x4 block at (bx, by) of an RGBA_8888 pixmap, in row order. Blocks that hang off the
+// right or bottom edge repeat the last column or row, which the decoders skip.
+void read_block(const SkPixmap& src, int bx, int by, RGB block[16]) {
+    for (int i = 0; i < 4; ++i) {
+        const int y = std::min(4 * by + i, src.height() - 1);
+        const uint8_t* row = static_cast<const uint8_t*>(src.addr(0, y));
+        for (int j = 0; j < 4; ++j) {
+            const int x = std::min(4 * bx + j, src.width() - 1);
+            block[4 * i + j] = {row[4 * x], row[4 * x + 1], row[4 * x + 2]};
+        }
+    }
+}
+
+// Picks the best modifier of 'table' for each of a sub-block's pixels, returning the total error.
+int etc1_subblock_error(const RGB* const pixels[8], const RGB& base, int table, int indices[8]) {
+    int total = 0;
+    for (int p = 0; p < 8; ++p) {
+        int best = std::numeric_limits<int>::max();
+        for (int m = 0; m < kNumETC1PixelIndices; ++m) {
+            const int delta = kETC1ModifierTables[table][m];
+            const RGB modified = {SkTPin(base.fR + delta, 0, 255),
+                                  SkTPin(base.fG + delta, 0, 255),
+                                  SkTPin(base.fB + delta, 0, 255)};
+            const int error = color_error(modified, *pixels[p]);
+            if (error < best) {
+                best = error;
+                indices[p] = m;
+            }
+        }
+        total += best;
+    }
+    return total;
+}
+
+// Tries both sub-block orientations, basing each sub-block on its average color. Differential
+// mode, with its finer base colors, is used whenever the two averages are close enough. Since
+// the deltas stay in range this never makes one of ETC2's extra modes, so the block is both ETC1
+// and ETC2.
+void encode_etc1_block(const RGB block[16], ETC1Block* dst) {
+    uint32_t bestHigh = 0, bestLow = 0;
+    int bestError = std::numeric_limits<int>::max();
+
+    for (bool flip : {false, true}) {
+        const RGB* pixels[2][8];
+        int positions[2][8];
+        int counts[2] = {0, 0};
+        int sums[2][3] = {};
+        for (int y = 0; y < 4; ++y) {
+            for (int x = 0; x < 4; ++x) {
+                const int s = xy_to_subblock_index(x, y, flip);
+                const RGB& pixel = block[4 * y + x];
+                pixels[s][counts[s]] = &pixel;
+                positions[s][counts[s]++] = 4 * y + x;
+                sums[s][0] += pixel.fR;
+                sums[s][1] += pixel.fG;
+                sums[s][2] += pixel.fB;
+            }
+        }
+
+        int q5[2][3];
+        bool differential = true;
+        for (int c = 0; c < 3; ++c) {
+            for (int s = 0; s < 2; ++s) {
+                q5[s][c] = (((sums[s][c] + 4) / 8) * 31 + 127) / 255;
+            }
+            const int delta = q5[1][c] - q5[0][c];
+            differential &= delta >= -4 && delta <= 3;
+        }
+
+        RGB bases[2];
+        uint32_t high = flip ? kFlipBit : 0;
+        if (differential) {
+            for (int s = 0; s < 2; ++s) {
+                bases[s] = {extend_5To8bits(q5[s][0]),
+                            extend_5To8bits(q5[s][1]),
+                            extend_5To8bits(q5[s][2])};
+            }
+            high |= kDiffBit;
+            high |= (q5[0][0] << 27) | (((q5[1][0] - q5[0][0]) & 0x7) << 24);
+            high |= (q5[0][1] << 19) | (((q5[1][1] - q5[0][1]) & 0x7) << 16);
+            high |= (q5[0][2] << 11) | (((q5[1][2] - q5[0][2]) & 0x7) << 8);
+        } else {
+            int q4[2][3];
+            for (int s = 0; s < 2; ++s) {
+                for (int c = 0; c < 3; ++c) {
+                    q4[s][c] = (((sums[s][c] + 4) / 8) * 15 + 127) / 255;
+                }
+                bases[s] = {extend_4To8bits(q4[s][0]),
+                            extend_4To8bits(q4[s][1]),
+                            extend_4To8bits(q4[s][2])};
+            }
+            high |= (q4[0][0] << 28) | (q4[1][0] << 24);
+            high |= (q4[0][1] << 20) | (q4[1][1] << 16);
+            high |= (q4[0][2] << 12) | (q4[1][2] << 8);
+        }
+
+        uint32_t low = 0;
+        int error = 0;
+        for (int s = 0; s < 2; ++s) {
+            SkASSERT(counts[s] == 8);
+            int bestTable = 0, bestTableError = std::numeric_limits<int>::max();
+            int bestIndices[8], indices[8];
+            for (int t = 0; t < kNumETC1ModifierTables; ++t) {
+                const int tableError = etc1_subblock_error(pixels[s], bases[s], t, indices);
+                if (tableError < bestTableError) {
+                    bestTableError = tableError;
+                    bestTable = t;
+                    memcpy(bestIndices, indices, sizeof(indices));
+                }
+            }
+            high |= bestTable << (s == 0 ? 5 : 2);
+            for (int p = 0; p < 8; ++p) {
+                // Pixel indices are stored in column order, with the high bits 16 above the low.
+                const int x = positions[s][p] % 4, y = positions[s][p] / 4;
+                const int bit = 4 * x + y;
+                low |= (bestIndices[p] & 0x1) << bit;
+                low |= (bestIndices[p] >> 1) << (bit + 16);
+            }
+            error += bestTableError;
+        }
+
+        if (error < bestError) {
+            bestError = error;
+            bestHigh = high;
+            bestLow = low;
+        }
+    }
+
+    dst->fHigh = SkBSwap32(bestHigh);
+    dst->fLow = SkBSwap32(bestLow);
+}
+
+uint16_t to565(float r, float g, float b) {
+    const int r5 = SkTPin(SkScalarRoundToInt(r * 31 / 255), 0, 31);
+    const int g6 = SkTPin(SkScalarRoundToInt(g * 63 / 255), 0, 63);
+    const int b5 = SkTPin(SkScalarRoundToInt(b * 31 / 255), 0, 31);
+    return SkToU16((r5 << 11) | (g6 << 5) | b5);
+}
+
+RGB rgb_from565(uint16_t rgb565) {
+    return {SkToInt(SkR16ToR32((rgb565 >> 11) & 0x1F)),
+            SkToInt(SkG16ToG32((rgb565 >> 5) & 0x3F)),
+            SkToInt(SkB16ToB32(rgb565 & 0x1F))};
+}
+
+// Chooses each pixel's nearest color in the four color palette of 'c0' > 'c1', computed as
+// decompress_bc1() does, and returns the total error.
+int bc1_indices(const RGB block[16], uint16_t c0, uint16_t c1, uint32_t* indices) {
+    SkASSERT(c0 > c1);
+    const RGB e0 = rgb_from565(c0), e1 = rgb_from565(c1);
+    auto mix = [&](float t) {
+        auto channel = [t](int a, int b) { return SkScalarRoundToInt(t * a + (1.0f - t) * b); };
+        return RGB{channel(e0.fR, e1.fR), channel(e0.fG, e1.fG), channel(e0.fB, e1.fB)};
+    };
+    const RGB palette[4] = {e0, e1, mix(2.0f/3.0f), mix(1.0f/3.0f)};
+
+    *indices = 0;
+    int total = 0;
+    for (int p = 0; p < 16; ++p) {
+        int best = std::numeric_limits<int>::max(), bestIndex = 0;
+        for (int i = 0; i < 4; ++i) {
+            const int error = color_error(block[p], palette[i]);
+            if (error < best) {
+                best = error;
+                bestIndex = i;
+            }
+        }
+        *indices |= bestIndex << (2 * p);
+        total += best;
+    }
+    return total;
+}
+
+// Returns the block's endpoints in the order and format of a BC1 block, or false if they are the
+// same color.
+bool bc1_endpoints(float e0[3], float e1[3], uint16_t* c0, uint16_t* c1) {
+    *c0 = to565(e0[0], e0[1], e0[2]);
+    *c1 = to565(e1[0], e1[1], e1[2]);
+    if (*c0 < *c1) {
+        std::swap(*c0, *c1);
+    }
+    return *c0 != *c1;
+}
+
+// Fits the endpoints to the block's principal axis, then refits them once to the indices that
+// gives by least squares, keeping the refit if it is better.
+void encode_bc1_block(const RGB block[16], BC1Block* dst) {
+    float mean[3] = {0, 0, 0};
+    for (int p = 0; p < 16; ++p) {
+        mean[0] += block[p].fR;
+        mean[1] += block[p].fG;
+        mean[2] += block[p].fB;
+    }
+    for (float& m : mean) {
+        m /= 16;
+    }
+
+    float cov[6] = {0, 0, 0, 0, 0, 0};  // rr, rg, rb, gg, gb, bb
+    for (int p = 0; p < 16; ++p) {
+        const float r = block[p].fR - mean[0], g = block[p].fG - mean[1], b = block[p].fB - mean[2];
+        cov[0] += r * r;
+        cov[1] += r * g;
+        cov[2] += r * b;
+        cov[3] += g * g;
+        cov[4] += g * b;
+        cov[5] += b * b;
+    }
+    float axis[3] = {1, 1, 1};
+    for (int iter = 0; iter < 4; ++iter) {
+        const float x = cov[0] * axis[0] + cov[1] * axis[1] + cov[2] * axis[2];
+        const float y = cov[1] * axis[0] + cov[3] * axis[1] + cov[4] * axis[2];
+        const float z = cov[2] * axis[0] + cov[4] * axis[1] + cov[5] * axis[2];
+        const float len = std::max({std::abs(x), std::abs(y), std::abs(z)});
+        if (len == 0) {
+            break;
+        }
+        axis[0] = x / len;
+        axis[1] = y / len;
+        axis[2] = z / len;
+    }
+
+    float minDot = std::numeric_limits<float>::max(), maxDot = -minDot;
+    int minP = 0, maxP = 0;
+    for (int p = 0; p < 16; ++p) {
+        const float dot = block[p].fR * axis[0] + block[p].fG * axis[1] + block[p].fB * axis[2];
+        if (dot < minDot) {
+            minDot = dot;
+            minP = p;
+        }
+        if (dot > maxDot) {
+            maxDot = dot;
+            maxP = p;
+        }
+    }
+    // Pull the endpoints in a little, since few pixels are right at the ends of the line.
+    float e0[3] = {float(block[maxP].fR), float(block[maxP].fG), float(block[maxP].fB)};
+    float e1[3] = {float(block[minP].fR), float(block[minP].fG), float(block[minP].fB)};
+    for (int c = 0; c < 3; ++c) {
+        const float inset = (e0[c] - e1[c]) / 16;
+        e0[c] -= inset;
+        e1[c] += inset;
+    }
+
+    uint16_t c0, c1;
+    if (!bc1_endpoints(e0, e1, &c0, &c1)) {
+        // With equal endpoints the decoder sees a three color block, in which index 0 is c0.
+        *dst = {c0, c1, 0};
+        return;
+    }
+    uint32_t indices;
+    int error = bc1_indices(block, c0, c1, &indices);
+
+    // Each index weights c0 by 1, 0, 2/3 or 1/3. Solve for the endpoints that best fit the pixels
+    // with those weights.
+    static constexpr float kWeights[4] = {1, 0, 2.0f/3.0f, 1.0f/3.0f};
+    float aa = 0, ab = 0, bb = 0;
+    float ap[3] = {0, 0, 0}, bp[3] = {0, 0, 0};
+    for (int p = 0; p < 16; ++p) {
+        const float a = kWeights[(indices >> (2 * p)) & 0x3], b = 1 - a;
+        const float pixel[3] = {float(block[p].fR), float(block[p].fG), float(block[p].fB)};
+        aa += a * a;
+        ab += a * b;
+        bb += b * b;
+        for (int c = 0; c < 3; ++c) {
+            ap[c] += a * pixel[c];
+            bp[c] += b * pixel[c];
+        }
+    }
+    const float det = aa * bb - ab * ab;
+    if (det != 0) {
+        for (int c = 0; c < 3; ++c) {
+            e0[c] = (bb * ap[c] - ab * bp[c]) / det;
+            e1[c] = (aa * bp[c] - ab * ap[c]) / det;
+        }
+        uint16_t r0, r1;
+        uint32_t refitIndices;
+        if (bc1_endpoints(e0, e1, &r0, &r1)) {
+            const int refitError = bc1_indices(block, r0, r1, &refitIndices);
+            if (refitError < error) {
+                c0 = r0;
+                c1 = r1;
+                indices = refitIndices;
+            }
+        }
+    }
+
+    *dst = {c0, c1, indices};
+}
+
+}  // anonymous namespace
+
+bool SkCompress(const SkPixmap& src, SkTextureCompressionType compressionType, void* dst) {
+    if (src.colorType() != kRGBA_8888_SkColorType || src.width() <= 0 || src.height() <= 0 ||
+        !src.addr()) {
+        return false;
+    }
+
+    const int numXBlocks = num_4x4_blocks(src.width());
+    const int numYBlocks = num_4x4_blocks(src.height());
+    RGB block[16];
+    switch (compressionType) {
+        case SkTextureCompressionType::kNone:
+            return false;
+        case SkTextureCompressionType::kETC2_RGB8_UNORM: {
+            ETC1Block* dstBlocks = static_cast<ETC1Block*>(dst);
+            for (int y = 0; y < numYBlocks; ++y) {
+                for (int x = 0; x < numXBlocks; ++x) {
+                    read_block(src, x, y, block);
+                    encode_etc1_block(block, &dstBlocks[y * numXBlocks + x]);
+                }
+            }
+            return true;
+        }
+        case SkTextureCompressionType::kBC1_RGB8_UNORM:
+        case SkTextureCompressionType::kBC1_RGBA8_UNORM: {
+            // Only four color blocks are made, so the image is encoded as opaque either way.
+            BC1Block* dstBlocks = static_cast<BC1Block*>(dst);
+            for (int y = 0; y < numYBlocks; ++y) {
+                for (int x = 0; x < numXBlocks; ++x) {
+                    read_block(src, x, y, block);
+                    encode_bc1_block(block, &dstBlocks[y * numXBlocks + x]);
+                }
+            }
+            return true;
+        }
+    }
+
+    SkUNREACHABLE;
+}
+
 bool SkDecompress(sk_sp<SkData> data,
                   SkISize dimensions,
                   SkTextureCompressionType compressionType,
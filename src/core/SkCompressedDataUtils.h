@@ -17,6 +17,7 @@
 
 class SkBitmap;
 class SkData;
+class SkPixmap;
 struct SkISize;
 
 static constexpr bool SkTextureCompressionTypeIsOpaque(SkTextureCompressionType compression) {
@@ -48,4 +49,11 @@ bool SkDecompress(sk_sp<SkData> data,
                   SkTextureCompressionType compressionType,
                   SkBitmap* dst);
 
+/*
+ * Encodes 'src', which must be kRGBA_8888_SkColorType, into 'dst' as a single level of
+ * 'compressionType', which takes SkCompressedDataSize(compressionType, src.dimensions(), nullptr,
+ * false) bytes. Alpha is ignored, so 'src' should be opaque. Returns false if 'src' is not usable.
+ */
+bool SkCompress(const SkPixmap& src, SkTextureCompressionType compressionType, void* dst);
+
 #endif
@@ -10,15 +10,23 @@
 #include "include/core/SkMatrix.h"
 #include "include/core/SkPath.h"
 #include "include/core/SkPathTypes.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkTypes.h"
+#include "include/private/SkIDChangeListener.h"
 #include "include/private/base/SkAssert.h"
 #include "include/private/base/SkDebug.h"
 #include "include/private/base/SkFloatingPoint.h"
+#include "include/private/base/SkTPin.h"
 #include "src/core/SkGeometry.h"
 #include "src/core/SkPathMeasurePriv.h"
 #include "src/core/SkPathPriv.h"
+#include "src/core/SkResourceCache.h"
 
 #include <algorithm>
+#include <cstddef>
+#include <optional>
 #include <utility>
+#include <vector>
 
 #define kMaxTValue  0x3FFFFFFF
 
@@ -184,23 +192,104 @@ static bool cubic_too_curvy(const SkPoint pts[4], SkScalar tolerance) {
 // arbitrarily large values for resScale.
 constexpr int kMaxRecursionDepth = 8;
 
+// Measuring a path this short costs less than a cache lookup.
+static constexpr int kMinVerbsToCache = 8;
+
+namespace {
+static unsigned gContourMeasuresKeyNamespaceLabel;
+
+struct ContourMeasuresKey : public SkResourceCache::Key {
+public:
+    ContourMeasuresKey(const SkPath& path, bool forceClosed, SkScalar resScale)
+        : fGenID(path.getGenerationID())
+        , fForceClosed(forceClosed)
+        , fResScale(resScale)
+    {
+        uint64_t sharedID = SkSetFourByteTag('c', 'm', 's', 'r');
+        this->init(&gContourMeasuresKeyNamespaceLabel, (sharedID << 32) | fGenID,
+                   sizeof(fGenID) + sizeof(fForceClosed) + sizeof(fResScale));
+    }
+
+    uint32_t fGenID;
+    uint32_t fForceClosed;
+    SkScalar fResScale;
+};
+
+class ContourMeasuresPurgeListener final : public SkIDChangeListener {
+public:
+    explicit ContourMeasuresPurgeListener(uint64_t sharedID) : fSharedID(sharedID) {}
+
+    void changed() override { SkResourceCache::PostPurgeSharedID(fSharedID); }
+
+private:
+    uint64_t fSharedID;
+};
+
+struct ContourMeasuresRec : public SkResourceCache::Rec {
+    ContourMeasuresRec(const ContourMeasuresKey& key,
+                       std::vector<sk_sp<SkContourMeasure>> measures,
+                       size_t measuresBytes,
+                       sk_sp<SkIDChangeListener> listener)
+        : fKey(key)
+        , fMeasures(std::move(measures))
+        , fMeasuresBytes(measuresBytes)
+        , fListener(std::move(listener)) {}
+    ~ContourMeasuresRec() override {
+        fListener->markShouldDeregister();
+    }
+
+    ContourMeasuresKey fKey;
+    std::vector<sk_sp<SkContourMeasure>> fMeasures;
+    size_t fMeasuresBytes;
+    sk_sp<SkIDChangeListener> fListener;
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override { return sizeof(*this) + fMeasuresBytes; }
+    const char* getCategory() const override { return "contour-measures"; }
+    SkDiscardableMemory* diagnostic_only_getDiscardable() const override { return nullptr; }
+
+    static bool Visitor(const SkResourceCache::Rec& baseRec, void* contextData) {
+        const ContourMeasuresRec& rec = static_cast<const ContourMeasuresRec&>(baseRec);
+        *static_cast<std::vector<sk_sp<SkContourMeasure>>*>(contextData) = rec.fMeasures;
+        return true;
+    }
+};
+} // namespace
+
 class SkContourMeasureIter::Impl {
 public:
     Impl(const SkPath& path, bool forceClosed, SkScalar resScale)
         : fPath(path)
         , fIter(SkPathPriv::Iterate(fPath).begin())
         , fTolerance(CHEAP_DIST_LIMIT * sk_ieee_float_divide(1.0f, resScale))
-        , fForceClosed(forceClosed) {}
+        , fForceClosed(forceClosed) {
+        // The contours of a path that is measured again and again (by an animation, say) are
+        // shared through the resource cache, keyed by its generation ID.
+        if (!path.isVolatile() && path.countVerbs() >= kMinVerbsToCache) {
+            fCacheKey.emplace(path, forceClosed, resScale);
+            fFromCache = SkResourceCache::Find(*fCacheKey, ContourMeasuresRec::Visitor,
+                                               &fMeasures);
+        }
+    }
+
+    sk_sp<SkContourMeasure> next();
 
+private:
     bool hasNextSegments() const { return fIter != SkPathPriv::Iterate(fPath).end(); }
     SkContourMeasure* buildSegments();
 
-private:
     SkPath                fPath;
     SkPathPriv::RangeIter fIter;
     SkScalar              fTolerance;
     bool                  fForceClosed;
 
+    // The path's contours, either found in the cache or recorded to add to it.
+    std::optional<ContourMeasuresKey>    fCacheKey;
+    bool                                 fFromCache = false;
+    std::vector<sk_sp<SkContourMeasure>> fMeasures;
+    size_t                               fMeasuresIndex = 0;
+    size_t                               fMeasuresBytes = 0;
+
     // temporary
     SkTDArray<SkContourMeasure::Segment>  fSegments;
     SkTDArray<SkPoint>  fPts; // Points used to define the segments
@@ -520,19 +609,40 @@ void SkContourMeasureIter::reset(const SkPath& path, bool forceClosed, SkScalar
     }
 }
 
-sk_sp<SkContourMeasure> SkContourMeasureIter::next() {
-    if (!fImpl) {
-        return nullptr;
+sk_sp<SkContourMeasure> SkContourMeasureIter::Impl::next() {
+    if (fFromCache) {
+        return fMeasuresIndex < fMeasures.size() ? fMeasures[fMeasuresIndex++] : nullptr;
     }
-    while (fImpl->hasNextSegments()) {
-        auto cm = fImpl->buildSegments();
+    while (this->hasNextSegments()) {
+        sk_sp<SkContourMeasure> cm(this->buildSegments());
         if (cm) {
-            return sk_sp<SkContourMeasure>(cm);
+            if (fCacheKey) {
+                fMeasures.push_back(cm);
+                fMeasuresBytes += sizeof(SkContourMeasure) +
+                                  cm->fSegments.size() * sizeof(SkContourMeasure::Segment) +
+                                  cm->fPts.size() * sizeof(SkPoint);
+            }
+            return cm;
         }
     }
+    if (fCacheKey) {
+        // Every contour has been measured.
+        auto listener = sk_make_sp<ContourMeasuresPurgeListener>(fCacheKey->getSharedID());
+        SkPathPriv::AddGenIDChangeListener(fPath, listener);
+        SkResourceCache::Add(new ContourMeasuresRec(*fCacheKey, std::move(fMeasures),
+                                                    fMeasuresBytes, std::move(listener)));
+        fCacheKey.reset();
+    }
     return nullptr;
 }
 
+sk_sp<SkContourMeasure> SkContourMeasureIter::next() {
+    if (!fImpl) {
+        return nullptr;
+    }
+    return fImpl->next();
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 SkContourMeasure::SkContourMeasure(SkTDArray<Segment>&& segs, SkTDArray<SkPoint>&& pts, SkScalar length, bool isClosed)
@@ -572,18 +682,58 @@ int SkTKSearch(const T base[], int count, const K& key) {
     return hi;
 }
 
-const SkContourMeasure::Segment* SkContourMeasure::distanceToSegment( SkScalar distance,
-                                                                     SkScalar* t) const {
-    SkDEBUGCODE(SkScalar length = ) this->length();
-    SkASSERT(distance >= 0 && distance <= length);
+// Contours with fewer segments than this are binary searched without an index.
+static constexpr int kMinSegmentsToIndex = 64;
+
+// The distance where a bucket of the segment index starts.
+static SkScalar bucket_start(SkScalar length, int bucket, int bucketCount) {
+    return length * bucket / bucketCount;
+}
+
+void SkContourMeasure::buildSegmentIndex() const {
+    const int count = fSegments.size();
+    fSegmentIndex.resize(count);
+    int index = 0;
+    for (int bucket = 0; bucket < count; ++bucket) {
+        const SkScalar start = bucket_start(fLength, bucket, count);
+        while (index < count - 1 && fSegments[index].fDistance < start) {
+            ++index;
+        }
+        fSegmentIndex[bucket] = index;
+    }
+}
 
+int SkContourMeasure::distanceToSegmentIndex(SkScalar distance) const {
     const Segment*  seg = fSegments.begin();
     int             count = fSegments.size();
 
-    int index = SkTKSearch<Segment, SkScalar>(seg, count, distance);
-    // don't care if we hit an exact match or not, so we xor index if it is negative
-    index ^= (index >> 31);
-    seg = &seg[index];
+    if (count < kMinSegmentsToIndex) {
+        int index = SkTKSearch<Segment, SkScalar>(seg, count, distance);
+        // don't care if we hit an exact match or not, so we xor index if it is negative
+        return index ^ (index >> 31);
+    }
+
+    fSegmentIndexOnce([this] { this->buildSegmentIndex(); });
+
+    // Find the bucket holding distance, allowing for rounding in the division.
+    int bucket = std::min(static_cast<int>(distance * count / fLength), count - 1);
+    while (bucket > 0 && bucket_start(fLength, bucket, count) > distance) {
+        --bucket;
+    }
+    while (bucket < count - 1 && bucket_start(fLength, bucket + 1, count) <= distance) {
+        ++bucket;
+    }
+
+    // The segment is no earlier than the first one reaching the start of this bucket, and no
+    // later than the first one reaching the start of the next.
+    const int lo = fSegmentIndex[bucket];
+    const int hi = bucket < count - 1 ? fSegmentIndex[bucket + 1] : count - 1;
+    return std::lower_bound(seg + lo, seg + hi, distance,
+                            [](const Segment& s, SkScalar d) { return s.fDistance < d; }) - seg;
+}
+
+SkScalar SkContourMeasure::segmentT(int index, SkScalar distance) const {
+    const Segment* seg = &fSegments[index];
 
     // now interpolate t-values with the prev segment (if possible)
     SkScalar    startT = 0, startD = 0;
@@ -600,8 +750,17 @@ const SkContourMeasure::Segment* SkContourMeasure::distanceToSegment( SkScalar d
     SkASSERT(distance >= startD);
     SkASSERT(seg->fDistance > startD);
 
-    *t = startT + (seg->getScalarT() - startT) * (distance - startD) / (seg->fDistance - startD);
-    return seg;
+    return startT + (seg->getScalarT() - startT) * (distance - startD) / (seg->fDistance - startD);
+}
+
+const SkContourMeasure::Segment* SkContourMeasure::distanceToSegment( SkScalar distance,
+                                                                     SkScalar* t) const {
+    SkDEBUGCODE(SkScalar length = ) this->length();
+    SkASSERT(distance >= 0 && distance <= length);
+
+    const int index = this->distanceToSegmentIndex(distance);
+    *t = this->segmentT(index, distance);
+    return &fSegments[index];
 }
 
 bool SkContourMeasure::getPosTan(SkScalar distance, SkPoint* pos, SkVector* tangent) const {
@@ -630,6 +789,50 @@ bool SkContourMeasure::getPosTan(SkScalar distance, SkPoint* pos, SkVector* tang
     return true;
 }
 
+bool SkContourMeasure::getPosTans(SkSpan<const SkScalar> distances,
+                                  SkSpan<SkPoint> positions,
+                                  SkSpan<SkVector> tangents) const {
+    SkASSERT(positions.empty() || positions.size() == distances.size());
+    SkASSERT(tangents.empty() || tangents.size() == distances.size());
+
+    const SkScalar length = this->length();
+    SkASSERT(length > 0 && !fSegments.empty());
+
+    bool success = true;
+    int index = -1;
+    SkScalar lastDistance = 0;
+    for (size_t i = 0; i < distances.size(); ++i) {
+        SkScalar distance = distances[i];
+        if (SkIsNaN(distance)) {
+            success = false;
+            continue;
+        }
+        distance = SkTPin(distance, 0.f, length);
+
+        if (index >= 0 && distance >= lastDistance) {
+            // Walk forward from the last distance's segment.
+            while (fSegments[index].fDistance < distance) {
+                ++index;
+            }
+        } else {
+            index = this->distanceToSegmentIndex(distance);
+        }
+        lastDistance = distance;
+
+        const SkScalar t = this->segmentT(index, distance);
+        if (SkIsNaN(t)) {
+            success = false;
+            continue;
+        }
+        const Segment& seg = fSegments[index];
+        SkASSERT((unsigned)seg.fPtIndex < (unsigned)fPts.size());
+        compute_pos_tan(&fPts[seg.fPtIndex], seg.fType, t,
+                        positions.empty() ? nullptr : &positions[i],
+                        tangents.empty() ? nullptr : &tangents[i]);
+    }
+    return success;
+}
+
 bool SkContourMeasure::getMatrix(SkScalar distance, SkMatrix* matrix, MatrixFlags flags) const {
     SkPoint     position;
     SkVector    tangent;
@@ -7,12 +7,14 @@
 #include "src/core/SkConvertPixels.h"
 
 #include "include/core/SkColorType.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkSize.h"
 #include "include/private/SkColorData.h"
 #include "include/private/base/SkAssert.h"
 #include "include/private/base/SkTPin.h"
 #include "include/private/base/SkTemplates.h"
+#include "include/private/base/SkTo.h"
 #include "src/base/SkHalf.h"
 #include "src/base/SkRectMemcpy.h"
 #include "src/core/SkColorSpaceXformSteps.h"
@@ -20,7 +22,10 @@
 #include "src/core/SkRasterPipeline.h"
 #include "src/core/SkRasterPipelineOpContexts.h"
 #include "src/core/SkSwizzlePriv.h"
+#include "src/core/SkTaskGroup.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <cstring>
 #include <initializer_list>
@@ -242,6 +247,66 @@ static bool convert_to_alpha8(const SkImageInfo& dstInfo,       void* vdst, size
     return false;
 }
 
+static std::atomic<SkExecutor*> gParallelConvertExecutor{nullptr};
+static std::atomic<int64_t>     gParallelConvertMinPixelCount{0};
+
+void SkSetParallelConvertPixels(SkExecutor* executor, int64_t minPixelCount) {
+    gParallelConvertMinPixelCount.store(minPixelCount);
+    gParallelConvertExecutor.store(executor);
+}
+
+// Converts each band claimed from nextBand with one compiled pipeline. A compiled pipeline keeps
+// per-run scratch for its memory contexts, so each task builds its own.
+static void convert_bands_with_pipeline(const SkImageInfo& dstInfo, void* dstPixels, int dstStride,
+                                        const SkImageInfo& srcInfo, const void* srcPixels,
+                                        int srcStride, const SkColorSpaceXformSteps& steps,
+                                        int bandRows, int bandCount, std::atomic<int>* nextBand) {
+    SkRasterPipeline_MemoryCtx src = { const_cast<void*>(srcPixels), srcStride },
+                               dst = {                   dstPixels,  dstStride };
+
+    SkRasterPipeline_<256> pipeline;
+    pipeline.appendLoad(srcInfo.colorType(), &src);
+    steps.apply(&pipeline);
+    pipeline.appendStore(dstInfo.colorType(), &dst);
+    auto run = pipeline.compile();
+
+    const int width = srcInfo.width(), height = srcInfo.height();
+    int band;
+    while ((band = nextBand->fetch_add(1, std::memory_order_relaxed)) < bandCount) {
+        const int top = band * bandRows;
+        run(0, top, width, std::min(bandRows, height - top));
+    }
+}
+
+// Large conversions are split into bands of rows small enough that a band's source and
+// destination stay in cache, handed out to at most kMaxTasks tasks on the parallel executor.
+static bool parallel_convert_with_pipeline(const SkImageInfo& dstInfo, void* dstRow, int dstStride,
+                                           const SkImageInfo& srcInfo, const void* srcRow,
+                                           int srcStride, const SkColorSpaceXformSteps& steps) {
+    static constexpr int kBandPixels = 64 * 1024;
+    static constexpr int kMaxTasks = 16;
+
+    SkExecutor* executor = gParallelConvertExecutor.load();
+    const int width = srcInfo.width(), height = srcInfo.height();
+    if (!executor || SkToS64(width) * height < gParallelConvertMinPixelCount.load()) {
+        return false;
+    }
+    const int bandRows = std::max(1, kBandPixels / width);
+    const int bandCount = (height + bandRows - 1) / bandRows;
+    if (bandCount < 2) {
+        return false;
+    }
+
+    std::atomic<int> nextBand{0};
+    SkTaskGroup tasks(*executor);
+    tasks.batch(std::min(bandCount, kMaxTasks), [&](int) {
+        convert_bands_with_pipeline(dstInfo, dstRow, dstStride, srcInfo, srcRow, srcStride, steps,
+                                    bandRows, bandCount, &nextBand);
+    });
+    tasks.wait();
+    return true;
+}
+
 // Default: Use the pipeline.
 static void convert_with_pipeline(const SkImageInfo& dstInfo, void* dstRow, int dstStride,
                                   const SkImageInfo& srcInfo, const void* srcRow, int srcStride,
@@ -276,6 +341,9 @@ bool SkConvertPixels(const SkImageInfo& dstInfo,       void* dstPixels, size_t d
             return true;
         }
     }
-    convert_with_pipeline(dstInfo, dstPixels, dstStride, srcInfo, srcPixels, srcStride, steps);
+    if (!parallel_convert_with_pipeline(dstInfo, dstPixels, dstStride,
+                                        srcInfo, srcPixels, srcStride, steps)) {
+        convert_with_pipeline(dstInfo, dstPixels, dstStride, srcInfo, srcPixels, srcStride, steps);
+    }
     return true;
 }
@@ -9,11 +9,17 @@
 #define SkConvertPixels_DEFINED
 
 #include <cstddef>
+#include <cstdint>
 
+class SkExecutor;
 struct SkImageInfo;
 
 [[nodiscard]] bool SkConvertPixels(
         const SkImageInfo& dstInfo,       void* dstPixels, size_t dstRowBytes,
         const SkImageInfo& srcInfo, const void* srcPixels, size_t srcRowBytes);
 
+// Lets SkConvertPixels() run conversions that need SkRasterPipeline on the executor, in bands of
+// rows, once the image has at least minPixelCount pixels. Passing nullptr turns this off.
+void SkSetParallelConvertPixels(SkExecutor*, int64_t minPixelCount);
+
 #endif
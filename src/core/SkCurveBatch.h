@@ -0,0 +1,35 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkCurveBatch_DEFINED
+#define SkCurveBatch_DEFINED
+
+// Kernels that evaluate many curves at once. The curves are passed in SoA layout: x[k][i] and
+// y[k][i] are the coordinates of control point k of curve i.
+namespace SkOpts {
+    // n4[i] = lengthTerm * max(|M*(p0 - 2p1 + p2)|^2, |M*(p1 - 2p2 + p3)|^2) for cubic i, where M
+    // is the 2x2 matrix with columns {m[0], m[1]} and {m[2], m[3]}. This is Wang's formula raised
+    // to the 4th power; see skgpu::wangs_formula::cubic_p4().
+    extern void (*cubic_wangs_formula_p4)(float lengthTerm, const float m[4],
+                                          const float* const x[4], const float* const y[4],
+                                          int count, float n4[]);
+
+    // The same for quadratic i, with the single second difference p0 - 2p1 + p2.
+    extern void (*quadratic_wangs_formula_p4)(float lengthTerm, const float m[4],
+                                              const float* const x[3], const float* const y[3],
+                                              int count, float n4[]);
+
+    // Chops cubic i at t[i], which must be in [0, 1], writing the 7 control points of the two
+    // halves to dstX[0..6][i] and dstY[0..6][i] like SkChopCubicAt().
+    extern void (*chop_cubics_at)(const float* const x[4], const float* const y[4],
+                                  const float t[], int count,
+                                  float* const dstX[7], float* const dstY[7]);
+
+    void Init_CurveBatch();
+}  // namespace SkOpts
+
+#endif
@@ -75,6 +75,9 @@ namespace sktext::gpu {
 class SDFTControl;
 class Slug;
 }
+namespace SkTiledImageUtils {
+class TileStreamer;
+}
 
 struct SkStrikeDeviceInfo {
     const SkSurfaceProps fSurfaceProps;
@@ -366,13 +369,15 @@ public:
     // Return true if canvas calls to drawImage or drawImageRect should try to
     // be drawn in a tiled way.
     virtual bool shouldDrawAsTiledImageRect() const { return false; }
+    // 'streamer' is null unless the draw comes from SkTiledImageUtils with a TileStreamer.
     virtual bool drawAsTiledImageRect(SkCanvas*,
                                       const SkImage*,
                                       const SkRect* src,
                                       const SkRect& dst,
                                       const SkSamplingOptions&,
                                       const SkPaint&,
-                                      SkCanvas::SrcRectConstraint) { return false; }
+                                      SkCanvas::SrcRectConstraint,
+                                      SkTiledImageUtils::TileStreamer*) { return false; }
 
     virtual void drawImageLattice(const SkImage*, const SkCanvas::Lattice&,
                                   const SkRect& dst, SkFilterMode, const SkPaint&);
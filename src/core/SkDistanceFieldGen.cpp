@@ -7,15 +7,19 @@
 
 #include "src/core/SkDistanceFieldGen.h"
 
+#include "include/core/SkExecutor.h"
 #include "include/core/SkPoint.h"
 #include "include/core/SkScalar.h"
 #include "include/private/base/SkMalloc.h"
-#include "include/private/base/SkTPin.h"
 #include "include/private/base/SkTemplates.h"
+#include "include/private/base/SkTo.h"
 #include "src/base/SkAutoMalloc.h"
 #include "src/core/SkMask.h"
 #include "src/core/SkPointPriv.h"
+#include "src/core/SkTaskGroup.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <cstring>
 #include <utility>
@@ -24,10 +28,16 @@ using namespace skia_private;
 
 #if !defined(SK_DISABLE_SDF_TEXT)
 
+// The distance transform's data, one plane per component so that SkOpts can work on whole rows.
 struct DFData {
-    float   fAlpha;      // alpha value of source texel
-    float   fDistSq;     // distance squared to nearest (so far) edge texel
-    SkPoint fDistVector; // distance vector to nearest (so far) edge texel
+    float* fAlpha;       // alpha value of source texel
+    float* fDistSq;      // distance squared to nearest (so far) edge texel
+    float* fDistX;       // distance vector to nearest (so far) edge texel
+    float* fDistY;
+
+    SkDistanceFieldRow row(int index) const {
+        return {fDistSq + index, fDistX + index, fDistY + index};
+    }
 };
 
 enum NeighborFlags {
@@ -79,43 +89,58 @@ static bool found_edge(const unsigned char* imagePtr, int width, int neighborFla
     return false;
 }
 
-static void init_glyph_data(DFData* data, unsigned char* edges, const unsigned char* image,
+static void init_glyph_data(float* alpha, unsigned char* edges, const unsigned char* image,
                             int dataWidth, int dataHeight,
                             int imageWidth, int imageHeight,
                             int pad) {
-    data += pad*dataWidth;
-    data += pad;
+    alpha += pad*dataWidth;
+    alpha += pad;
     edges += (pad*dataWidth + pad);
 
+    auto initPixel = [&](int i, int j) {
+        const unsigned char* imagePtr = image + j*imageWidth + i;
+        float* alphaPtr = alpha + j*dataWidth + i;
+        if (255 == *imagePtr) {
+            *alphaPtr = 1.0f;
+        } else {
+            *alphaPtr = (*imagePtr)*0.00392156862f;  // 1/255
+        }
+        int checkMask = kAll_NeighborFlags;
+        if (i == 0) {
+            checkMask &= ~(kLeft_NeighborFlag|kTopLeft_NeighborFlag|kBottomLeft_NeighborFlag);
+        }
+        if (i == imageWidth-1) {
+            checkMask &= ~(kRight_NeighborFlag|kTopRight_NeighborFlag|kBottomRight_NeighborFlag);
+        }
+        if (j == 0) {
+            checkMask &= ~(kTopLeft_NeighborFlag|kTop_NeighborFlag|kTopRight_NeighborFlag);
+        }
+        if (j == imageHeight-1) {
+            checkMask &= ~(kBottomLeft_NeighborFlag|kBottom_NeighborFlag|kBottomRight_NeighborFlag);
+        }
+        if (found_edge(imagePtr, imageWidth, checkMask)) {
+            edges[j*dataWidth + i] = 255;  // using 255 makes for convenient debug rendering
+        }
+    };
+
     for (int j = 0; j < imageHeight; ++j) {
-        for (int i = 0; i < imageWidth; ++i) {
-            if (255 == *image) {
-                data->fAlpha = 1.0f;
-            } else {
-                data->fAlpha = (*image)*0.00392156862f;  // 1/255
+        if (j == 0 || j == imageHeight-1) {
+            for (int i = 0; i < imageWidth; ++i) {
+                initPixel(i, j);
             }
-            int checkMask = kAll_NeighborFlags;
-            if (i == 0) {
-                checkMask &= ~(kLeft_NeighborFlag|kTopLeft_NeighborFlag|kBottomLeft_NeighborFlag);
-            }
-            if (i == imageWidth-1) {
-                checkMask &= ~(kRight_NeighborFlag|kTopRight_NeighborFlag|kBottomRight_NeighborFlag);
-            }
-            if (j == 0) {
-                checkMask &= ~(kTopLeft_NeighborFlag|kTop_NeighborFlag|kTopRight_NeighborFlag);
-            }
-            if (j == imageHeight-1) {
-                checkMask &= ~(kBottomLeft_NeighborFlag|kBottom_NeighborFlag|kBottomRight_NeighborFlag);
-            }
-            if (found_edge(image, imageWidth, checkMask)) {
-                *edges = 255;  // using 255 makes for convenient debug rendering
-            }
-            ++data;
-            ++image;
-            ++edges;
+            continue;
+        }
+        // Only the pixels on the border of the image are missing some of their neighbors.
+        initPixel(0, j);
+        if (imageWidth > 2) {
+            const unsigned char* row = image + j*imageWidth + 1;
+            SkOpts::distance_field_find_edges(row - imageWidth, row, row + imageWidth,
+                                              alpha + j*dataWidth + 1, edges + j*dataWidth + 1,
+                                              imageWidth-2);
+        }
+        if (imageWidth > 1) {
+            initPixel(imageWidth-1, j);
         }
-        data += 2*pad;
-        edges += 2*pad;
     }
 }
 
@@ -162,192 +187,94 @@ static float edge_distance(const SkPoint& direction, float alpha) {
     return distance;
 }
 
-static void init_distances(DFData* data, unsigned char* edges, int width, int height) {
-    // skip one pixel border
-    DFData* currData = data;
-    DFData* prevData = data - width;
-    DFData* nextData = data + width;
-
-    for (int j = 0; j < height; ++j) {
-        for (int i = 0; i < width; ++i) {
-            if (*edges) {
-                // we should not be in the one-pixel outside band
-                SkASSERT(i > 0 && i < width-1 && j > 0 && j < height-1);
-                // gradient will point from low to high
-                // +y is down in this case
-                // i.e., if you're outside, gradient points towards edge
-                // if you're inside, gradient points away from edge
-                SkPoint currGrad;
-                currGrad.fX = (prevData+1)->fAlpha - (prevData-1)->fAlpha
-                             + SK_ScalarSqrt2*(currData+1)->fAlpha
-                             - SK_ScalarSqrt2*(currData-1)->fAlpha
-                             + (nextData+1)->fAlpha - (nextData-1)->fAlpha;
-                currGrad.fY = (nextData-1)->fAlpha - (prevData-1)->fAlpha
-                             + SK_ScalarSqrt2*nextData->fAlpha
-                             - SK_ScalarSqrt2*prevData->fAlpha
-                             + (nextData+1)->fAlpha - (prevData+1)->fAlpha;
-                SkPointPriv::SetLengthFast(&currGrad, 1.0f);
-
-                // init squared distance to edge and distance vector
-                float dist = edge_distance(currGrad, currData->fAlpha);
-                currGrad.scale(dist, &currData->fDistVector);
-                currData->fDistSq = dist*dist;
-            } else {
-                // init distance to "far away"
-                currData->fDistSq = 2000000.f;
-                currData->fDistVector.fX = 1000.f;
-                currData->fDistVector.fY = 1000.f;
-            }
-            ++currData;
-            ++prevData;
-            ++nextData;
-            ++edges;
+static void init_distances(const DFData& data, unsigned char* edges, int width, int height) {
+    // init distance to "far away"
+    const int count = width*height;
+    std::fill_n(data.fDistSq, count, 2000000.f);
+    std::fill_n(data.fDistX, count, 1000.f);
+    std::fill_n(data.fDistY, count, 1000.f);
+
+    const float* alpha = data.fAlpha;
+    for (int index = 0; index < count; ++index) {
+        if (edges[index]) {
+            // we should not be in the one-pixel outside band
+            SkASSERT(index % width > 0 && index % width < width-1 &&
+                     index / width > 0 && index / width < height-1);
+            const int prev = index - width;
+            const int next = index + width;
+            // gradient will point from low to high
+            // +y is down in this case
+            // i.e., if you're outside, gradient points towards edge
+            // if you're inside, gradient points away from edge
+            SkPoint currGrad;
+            currGrad.fX = alpha[prev+1] - alpha[prev-1]
+                         + SK_ScalarSqrt2*alpha[index+1]
+                         - SK_ScalarSqrt2*alpha[index-1]
+                         + alpha[next+1] - alpha[next-1];
+            currGrad.fY = alpha[next-1] - alpha[prev-1]
+                         + SK_ScalarSqrt2*alpha[next]
+                         - SK_ScalarSqrt2*alpha[prev]
+                         + alpha[next+1] - alpha[prev+1];
+            SkPointPriv::SetLengthFast(&currGrad, 1.0f);
+
+            // init squared distance to edge and distance vector
+            float dist = edge_distance(currGrad, alpha[index]);
+            data.fDistX[index] = currGrad.fX * dist;
+            data.fDistY[index] = currGrad.fY * dist;
+            data.fDistSq[index] = dist*dist;
         }
     }
 }
 
 // Danielsson's 8SSEDT
-
-// first stage forward pass
-// (forward in Y, forward in X)
-static void F1(DFData* curr, int width) {
-    // upper left
-    DFData* check = curr - width-1;
-    SkPoint distVec = check->fDistVector;
-    float distSq = check->fDistSq - 2.0f*(distVec.fX + distVec.fY - 1.0f);
-    if (distSq < curr->fDistSq) {
-        distVec.fX -= 1.0f;
-        distVec.fY -= 1.0f;
-        curr->fDistSq = distSq;
-        curr->fDistVector = distVec;
-    }
-
-    // up
-    check = curr - width;
-    distVec = check->fDistVector;
-    distSq = check->fDistSq - 2.0f*distVec.fY + 1.0f;
-    if (distSq < curr->fDistSq) {
-        distVec.fY -= 1.0f;
-        curr->fDistSq = distSq;
-        curr->fDistVector = distVec;
-    }
-
-    // upper right
-    check = curr - width+1;
-    distVec = check->fDistVector;
-    distSq = check->fDistSq + 2.0f*(distVec.fX - distVec.fY + 1.0f);
-    if (distSq < curr->fDistSq) {
-        distVec.fX += 1.0f;
-        distVec.fY -= 1.0f;
-        curr->fDistSq = distSq;
-        curr->fDistVector = distVec;
-    }
-
-    // left
-    check = curr - 1;
-    distVec = check->fDistVector;
-    distSq = check->fDistSq - 2.0f*distVec.fX + 1.0f;
-    if (distSq < curr->fDistSq) {
-        distVec.fX -= 1.0f;
-        curr->fDistSq = distSq;
-        curr->fDistVector = distVec;
-    }
-}
-
-// second stage forward pass
-// (forward in Y, backward in X)
-static void F2(DFData* curr, int width) {
-    // right
-    DFData* check = curr + 1;
-    SkPoint distVec = check->fDistVector;
-    float distSq = check->fDistSq + 2.0f*distVec.fX + 1.0f;
-    if (distSq < curr->fDistSq) {
-        distVec.fX += 1.0f;
-        curr->fDistSq = distSq;
-        curr->fDistVector = distVec;
-    }
-}
-
-// first stage backward pass
-// (backward in Y, forward in X)
-static void B1(DFData* curr, int width) {
-    // left
-    DFData* check = curr - 1;
-    SkPoint distVec = check->fDistVector;
-    float distSq = check->fDistSq - 2.0f*distVec.fX + 1.0f;
-    if (distSq < curr->fDistSq) {
-        distVec.fX -= 1.0f;
-        curr->fDistSq = distSq;
-        curr->fDistVector = distVec;
+//
+// Each pass over a row first takes the candidates from the row above (going forward in y) or
+// below (going backward in y) for all of its pixels at once, with SkOpts. Those rows are done,
+// so only the candidates from the pixels to the left and right need to be taken one at a time.
+// A candidate only replaces a nearer one, so the order in which they are taken matters when
+// two are as near; the passes below take them in the order the scalar transform always has.
+
+static inline float twice(float x) { return x + x; }
+
+// Going forward in x, from the pixel to the left.
+static void nearest_left(const DFData& data, const unsigned char* edges, int start, int count) {
+    for (int index = start; index < start + count; ++index) {
+        if (!edges[index]) {
+            float distSq = data.fDistSq[index-1] - twice(data.fDistX[index-1]) + 1.0f;
+            if (distSq < data.fDistSq[index]) {
+                data.fDistSq[index] = distSq;
+                data.fDistX[index] = data.fDistX[index-1] - 1.0f;
+                data.fDistY[index] = data.fDistY[index-1];
+            }
+        }
     }
 }
 
-// second stage backward pass
-// (backward in Y, backwards in X)
-static void B2(DFData* curr, int width) {
-    // right
-    DFData* check = curr + 1;
-    SkPoint distVec = check->fDistVector;
-    float distSq = check->fDistSq + 2.0f*distVec.fX + 1.0f;
-    if (distSq < curr->fDistSq) {
-        distVec.fX += 1.0f;
-        curr->fDistSq = distSq;
-        curr->fDistVector = distVec;
-    }
-
-    // bottom left
-    check = curr + width-1;
-    distVec = check->fDistVector;
-    distSq = check->fDistSq - 2.0f*(distVec.fX - distVec.fY - 1.0f);
-    if (distSq < curr->fDistSq) {
-        distVec.fX -= 1.0f;
-        distVec.fY += 1.0f;
-        curr->fDistSq = distSq;
-        curr->fDistVector = distVec;
-    }
-
-    // bottom
-    check = curr + width;
-    distVec = check->fDistVector;
-    distSq = check->fDistSq + 2.0f*distVec.fY + 1.0f;
-    if (distSq < curr->fDistSq) {
-        distVec.fY += 1.0f;
-        curr->fDistSq = distSq;
-        curr->fDistVector = distVec;
-    }
-
-    // bottom right
-    check = curr + width+1;
-    distVec = check->fDistVector;
-    distSq = check->fDistSq + 2.0f*(distVec.fX + distVec.fY + 1.0f);
-    if (distSq < curr->fDistSq) {
-        distVec.fX += 1.0f;
-        distVec.fY += 1.0f;
-        curr->fDistSq = distSq;
-        curr->fDistVector = distVec;
+// Going backward in x, from the pixel to the right, and then from below if |below| is not null:
+// the nearest of the pixels below, as found by SkOpts::distance_field_nearest_below().
+static void nearest_right(const DFData& data, const unsigned char* edges, int start, int count,
+                          const SkDistanceFieldRow* below) {
+    for (int i = count - 1; i >= 0; --i) {
+        const int index = start + i;
+        if (!edges[index]) {
+            float distSq = data.fDistSq[index+1] + twice(data.fDistX[index+1]) + 1.0f;
+            if (distSq < data.fDistSq[index]) {
+                data.fDistSq[index] = distSq;
+                data.fDistX[index] = data.fDistX[index+1] + 1.0f;
+                data.fDistY[index] = data.fDistY[index+1];
+            }
+            if (below && below->fDistSq[i] < data.fDistSq[index]) {
+                data.fDistSq[index] = below->fDistSq[i];
+                data.fDistX[index] = below->fX[i];
+                data.fDistY[index] = below->fY[i];
+            }
+        }
     }
 }
 
 // enable this to output edge data rather than the distance field
 #define DUMP_EDGE 0
 
-#if !DUMP_EDGE
-template <int distanceMagnitude>
-static unsigned char pack_distance_field_val(float dist) {
-    // The distance field is constructed as unsigned char values, so that the zero value is at 128,
-    // Beside 128, we have 128 values in range [0, 128), but only 127 values in range (128, 255].
-    // So we multiply distanceMagnitude by 127/128 at the latter range to avoid overflow.
-    dist = SkTPin<float>(-dist, -distanceMagnitude, distanceMagnitude * 127.0f / 128.0f);
-
-    // Scale into the positive range for unsigned distance.
-    dist += distanceMagnitude;
-
-    // Scale into unsigned char range.
-    // Round to place negative and positive values as equally as possible around 128
-    // (which represents zero).
-    return (unsigned char)SkScalarRoundToInt(dist / (2 * distanceMagnitude) * 256.0f);
-}
-#endif
 
 // assumes a padded 8-bit image and distance field
 // width and height are the original width and height of the image
@@ -365,111 +292,75 @@ static bool generate_distance_field_from_image(unsigned char* distanceField,
     int dataWidth = width + 2*pad;
     int dataHeight = height + 2*pad;
 
-    // create zeroed temp DFData+edge storage
-    UniqueVoidPtr storage(sk_calloc_throw(dataWidth*dataHeight*(sizeof(DFData) + 1)));
-    DFData*        dataPtr = (DFData*)storage.get();
-    unsigned char* edgePtr = (unsigned char*)storage.get() + dataWidth*dataHeight*sizeof(DFData);
+    // create zeroed temp DFData+edge storage, and a row of candidates from below
+    const int dataCount = dataWidth*dataHeight;
+    UniqueVoidPtr storage(sk_calloc_throw(
+            (4*dataCount + 3*dataWidth)*sizeof(float) + dataCount));
+    float* planes = (float*)storage.get();
+    const DFData data{planes, planes + dataCount, planes + 2*dataCount, planes + 3*dataCount};
+    float* belowPlanes = planes + 4*dataCount;
+    const SkDistanceFieldRow below{belowPlanes, belowPlanes + dataWidth, belowPlanes + 2*dataWidth};
+    unsigned char* edgePtr = (unsigned char*)(belowPlanes + 3*dataWidth);
 
     // copy glyph into distance field storage
-    init_glyph_data(dataPtr, edgePtr, copyPtr,
+    init_glyph_data(data.fAlpha, edgePtr, copyPtr,
                     dataWidth, dataHeight,
                     width+2, height+2, SK_DistanceFieldPad);
 
     // create initial distance data, particularly at edges
-    init_distances(dataPtr, edgePtr, dataWidth, dataHeight);
+    init_distances(data, edgePtr, dataWidth, dataHeight);
 
     // now perform Euclidean distance transform to propagate distances
+    const int rowCount = dataWidth-2;
 
     // forwards in y
-    DFData* currData = dataPtr+dataWidth+1; // skip outer buffer
-    unsigned char* currEdge = edgePtr+dataWidth+1;
+    int start = dataWidth+1; // skip outer buffer
     for (int j = 1; j < dataHeight-1; ++j) {
-        // forwards in x
-        for (int i = 1; i < dataWidth-1; ++i) {
-            // don't need to calculate distance for edge pixels
-            if (!*currEdge) {
-                F1(currData, dataWidth);
-            }
-            ++currData;
-            ++currEdge;
-        }
-
-        // backwards in x
-        --currData; // reset to end
-        --currEdge;
-        for (int i = 1; i < dataWidth-1; ++i) {
-            // don't need to calculate distance for edge pixels
-            if (!*currEdge) {
-                F2(currData, dataWidth);
-            }
-            --currData;
-            --currEdge;
-        }
-
-        currData += dataWidth+1;
-        currEdge += dataWidth+1;
+        // from above, then forwards and backwards in x
+        // (edge pixels don't need their distance calculated)
+        SkOpts::distance_field_nearest_above(data.row(start), data.row(start - dataWidth),
+                                             edgePtr + start, rowCount);
+        nearest_left(data, edgePtr, start, rowCount);
+        nearest_right(data, edgePtr, start, rowCount, nullptr);
+        start += dataWidth;
     }
 
     // backwards in y
-    currData = dataPtr+dataWidth*(dataHeight-2) - 1; // skip outer buffer
-    currEdge = edgePtr+dataWidth*(dataHeight-2) - 1;
+    // This has always started two pixels before the row it means to, so each of its passes
+    // covers the last pixel of one row and all but the last three of the next. That is kept
+    // as is, so the distance fields stay the same.
+    start = dataWidth*(dataHeight-2) - 1;
     for (int j = 1; j < dataHeight-1; ++j) {
-        // forwards in x
-        for (int i = 1; i < dataWidth-1; ++i) {
-            // don't need to calculate distance for edge pixels
-            if (!*currEdge) {
-                B1(currData, dataWidth);
-            }
-            ++currData;
-            ++currEdge;
-        }
-
-        // backwards in x
-        --currData; // reset to end
-        --currEdge;
-        for (int i = 1; i < dataWidth-1; ++i) {
-            // don't need to calculate distance for edge pixels
-            if (!*currEdge) {
-                B2(currData, dataWidth);
-            }
-            --currData;
-            --currEdge;
-        }
-
-        currData -= dataWidth-1;
-        currEdge -= dataWidth-1;
+        // forwards in x, then backwards in x and from below
+        SkOpts::distance_field_nearest_below(below, data.row(start + dataWidth), rowCount);
+        nearest_left(data, edgePtr, start, rowCount);
+        nearest_right(data, edgePtr, start, rowCount, &below);
+        start -= dataWidth;
     }
 
     // copy results to final distance field data
-    currData = dataPtr + dataWidth+1;
-    currEdge = edgePtr + dataWidth+1;
+    int index = dataWidth+1;
     unsigned char *dfPtr = distanceField;
     for (int j = 1; j < dataHeight-1; ++j) {
-        for (int i = 1; i < dataWidth-1; ++i) {
 #if DUMP_EDGE
-            float alpha = currData->fAlpha;
+        for (int i = 1; i < dataWidth-1; ++i) {
+            float alpha = data.fAlpha[index];
             float edge = 0.0f;
-            if (*currEdge) {
+            if (edgePtr[index]) {
                 edge = 0.25f;
             }
             // blend with original image
             float result = alpha + (1.0f-alpha)*edge;
             unsigned char val = sk_float_round2int(255*result);
             *dfPtr++ = val;
+            ++index;
+        }
 #else
-            float dist;
-            if (currData->fAlpha > 0.5f) {
-                dist = -SkScalarSqrt(currData->fDistSq);
-            } else {
-                dist = SkScalarSqrt(currData->fDistSq);
-            }
-            *dfPtr++ = pack_distance_field_val<SK_DistanceFieldMagnitude>(dist);
+        SkOpts::distance_field_pack(data.fDistSq + index, data.fAlpha + index, dfPtr, rowCount);
+        index += rowCount;
+        dfPtr += rowCount;
 #endif
-            ++currData;
-            ++currEdge;
-        }
-        currData += 2;
-        currEdge += 2;
+        index += 2;
     }
 
     return true;
@@ -569,4 +460,46 @@ bool SkGenerateDistanceFieldFromBWImage(unsigned char* distanceField,
     return generate_distance_field_from_image(distanceField, copyPtr, width, height);
 }
 
+bool SkGenerateDistanceFields(SkSpan<const SkDistanceFieldGlyph> glyphs, SkExecutor* executor) {
+    std::atomic<bool> succeeded{true};
+    auto generate = [&](int i) {
+        const SkDistanceFieldGlyph& glyph = glyphs[i];
+        bool result;
+        switch (glyph.fFormat) {
+            case SkMask::kA8_Format:
+                result = SkGenerateDistanceFieldFromA8Image(glyph.fDistanceField, glyph.fImage,
+                                                            glyph.fWidth, glyph.fHeight,
+                                                            glyph.fRowBytes);
+                break;
+            case SkMask::kLCD16_Format:
+                result = SkGenerateDistanceFieldFromLCD16Mask(glyph.fDistanceField, glyph.fImage,
+                                                              glyph.fWidth, glyph.fHeight,
+                                                              glyph.fRowBytes);
+                break;
+            case SkMask::kBW_Format:
+                result = SkGenerateDistanceFieldFromBWImage(glyph.fDistanceField, glyph.fImage,
+                                                            glyph.fWidth, glyph.fHeight,
+                                                            glyph.fRowBytes);
+                break;
+            default:
+                result = false;
+                break;
+        }
+        if (!result) {
+            succeeded.store(false, std::memory_order_relaxed);
+        }
+    };
+
+    if (executor == nullptr || glyphs.size() < 2) {
+        for (size_t i = 0; i < glyphs.size(); ++i) {
+            generate(SkToInt(i));
+        }
+    } else {
+        SkTaskGroup taskGroup{*executor};
+        taskGroup.batch(SkToInt(glyphs.size()), generate);
+        taskGroup.wait();
+    }
+    return succeeded.load(std::memory_order_relaxed);
+}
+
 #endif // !defined(SK_DISABLE_SDF_TEXT)
@@ -8,8 +8,13 @@
 #define SkDistanceFieldGen_DEFINED
 
 #include "include/core/SkTypes.h"
+#include "include/private/base/SkSpan_impl.h"
+#include "src/core/SkMask.h"
 
 #include <cstddef>
+#include <cstdint>
+
+class SkExecutor;
 
 #if !defined(SK_DISABLE_SDF_TEXT)
 
@@ -76,6 +81,56 @@ inline size_t SkComputeDistanceFieldSize(int w, int h) {
     return (w + 2*SK_DistanceFieldPad) * (h + 2*SK_DistanceFieldPad) * sizeof(unsigned char);
 }
 
+/** One glyph for SkGenerateDistanceFields(). */
+struct SkDistanceFieldGlyph {
+    unsigned char*       fDistanceField;  // SkComputeDistanceFieldSize(fWidth, fHeight) bytes
+    const unsigned char* fImage;
+    SkMask::Format       fFormat;         // kA8_Format, kLCD16_Format or kBW_Format
+    int                  fWidth;
+    int                  fHeight;
+    size_t               fRowBytes;
+};
+
+/** Generates the distance fields of many glyphs at once, spread over executor, and returns when
+ *  all are done. A null executor generates them on the calling thread.
+ *
+ *  @return false if any of the glyphs has an unsupported format
+ */
+bool SkGenerateDistanceFields(SkSpan<const SkDistanceFieldGlyph> glyphs, SkExecutor* executor);
+
+// The row of the distance transform that SkOpts::distance_field_* below work on, one plane
+// each for the squared distance to the nearest edge and the vector to it.
+struct SkDistanceFieldRow {
+    float* fDistSq;
+    float* fX;
+    float* fY;
+};
+
+namespace SkOpts {
+    // For each of the count pixels of an 8-bit row, sets alpha to its value scaled to [0, 1] and
+    // edges to 255 if it is next to an edge of the image, or else to 0. The rows above and below
+    // it, and the pixels to either side of it, must all be readable.
+    extern void (*distance_field_find_edges)(const uint8_t* above, const uint8_t* row,
+                                             const uint8_t* below, float* alpha, uint8_t* edges,
+                                             int count);
+    // Turns the squared distances of count pixels into the 8-bit values of the distance field,
+    // negating them for the pixels with an alpha over one half.
+    extern void (*distance_field_pack)(const float* distSq, const float* alpha,
+                                       uint8_t* distanceField, int count);
+    // Moves each of the count pixels of row that is not an edge to the nearest of the pixels
+    // above it, above[i-1], above[i] and above[i+1], if that is nearer than where it is.
+    extern void (*distance_field_nearest_above)(SkDistanceFieldRow row, SkDistanceFieldRow above,
+                                                const uint8_t* edges, int count);
+    // Sets each of the count pixels of nearest to the nearest of the pixels below it,
+    // below[i-1], below[i] and below[i+1].
+    extern void (*distance_field_nearest_below)(SkDistanceFieldRow nearest,
+                                                SkDistanceFieldRow below, int count);
+}  // namespace SkOpts
+
 #endif // !defined(SK_DISABLE_SDF_TEXT)
 
+namespace SkOpts {
+    void Init_DistanceFieldGen();
+}  // namespace SkOpts
+
 #endif
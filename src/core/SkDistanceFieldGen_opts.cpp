@@ -0,0 +1,46 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/private/base/SkFeatures.h"
+#include "src/core/SkCpu.h"
+#include "src/core/SkDistanceFieldGen.h"
+#include "src/core/SkOptsTargets.h"
+
+#define SK_OPTS_TARGET SK_OPTS_TARGET_DEFAULT
+#include "src/opts/SkOpts_SetTarget.h"
+
+#include "src/opts/SkDistanceFieldGen_opts.h"  // IWYU pragma: keep
+
+#include "src/opts/SkOpts_RestoreTarget.h"
+
+namespace SkOpts {
+#if !defined(SK_DISABLE_SDF_TEXT)
+    DEFINE_DEFAULT(distance_field_find_edges);
+    DEFINE_DEFAULT(distance_field_pack);
+    DEFINE_DEFAULT(distance_field_nearest_above);
+    DEFINE_DEFAULT(distance_field_nearest_below);
+
+    void Init_DistanceFieldGen_hsw();
+
+    static bool init() {
+    #if defined(SK_ENABLE_OPTIMIZE_SIZE)
+        // All Init_foo functions are omitted when optimizing for size
+    #elif defined(SK_CPU_X86)
+        #if SK_CPU_SSE_LEVEL < SK_CPU_SSE_LEVEL_AVX2
+            if (SkCpu::Supports(SkCpu::HSW)) { Init_DistanceFieldGen_hsw(); }
+        #endif
+    #endif
+      return true;
+    }
+#endif  // !defined(SK_DISABLE_SDF_TEXT)
+
+    void Init_DistanceFieldGen() {
+    #if !defined(SK_DISABLE_SDF_TEXT)
+        [[maybe_unused]] static bool gInitialized = init();
+    #endif
+    }
+}  // namespace SkOpts
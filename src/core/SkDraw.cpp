@@ -32,6 +32,11 @@
 #include "src/core/SkRasterClip.h"
 #include "src/core/SkRectPriv.h"
 #include "src/core/SkScan.h"
+#include "src/core/SkSpriteBlitter.h"
+#include "src/core/SkTaskGroup.h"
+
+#include <algorithm>
+#include <cstdint>
 
 #if defined(SK_SUPPORT_LEGACY_ALPHA_BITMAP_AS_COVERAGE)
 #include "src/core/SkMaskFilterBase.h"
@@ -423,6 +428,91 @@ void SkDraw::drawSprite(const SkBitmap& bitmap, int x, int y, const SkPaint& ori
     draw.drawRect(r, paintWithShader);
 }
 
+bool SkDraw::drawSprites(const SkPixmap& src, const SkIRect srcRects[], const SkIPoint dstPoints[],
+                         int count, const SkPaint& origPaint) const {
+    SkDEBUGCODE(this->validate();)
+
+    // Same restrictions as drawSprite(), except that the clip has to handle every sprite.
+    if (!fRC->isBW() || origPaint.getColorFilter() || origPaint.getMaskFilter() ||
+        SkColorTypeIsAlphaOnly(src.colorType())) {
+        return false;
+    }
+    if (fRC->isEmpty() || count <= 0) {
+        return true;
+    }
+
+    SkPaint paint(origPaint);
+    paint.setStyle(SkPaint::kFill_Style);
+
+    // Band 0 is set up here so we can still bail out before anything is drawn.
+    SkSTArenaAlloc<kSkBlitterContextSize> allocator;
+    SkSpriteBlitter* blitter = SkBlitter::ChooseSprite(fDst, paint, src, 0, 0, &allocator,
+                                                       fRC->clipShader());
+    if (!blitter) {
+        return false;
+    }
+
+    const SkIRect clipBounds = fRC->getBounds();
+    uint64_t area = 0;
+    for (int i = 0; i < count; ++i) {
+        SkASSERT(SkIRect::MakeSize(src.dimensions()).contains(srcRects[i]));
+        SkIRect r = SkIRect::MakeXYWH(dstPoints[i].fX, dstPoints[i].fY,
+                                      srcRects[i].width(), srcRects[i].height());
+        if (r.intersect(clipBounds)) {
+            area += (uint64_t)r.width() * r.height();
+        }
+    }
+
+    auto blitBand = [&](SkSpriteBlitter* bandBlitter, const SkIRect& band) {
+        for (int i = 0; i < count; ++i) {
+            SkIRect r = SkIRect::MakeXYWH(dstPoints[i].fX, dstPoints[i].fY,
+                                          srcRects[i].width(), srcRects[i].height());
+            if (r.intersect(band)) {
+                bandBlitter->setOrigin(dstPoints[i].fX - srcRects[i].fLeft,
+                                       dstPoints[i].fY - srcRects[i].fTop);
+                SkScan::FillIRect(r, *fRC, bandBlitter);
+            }
+        }
+    };
+
+    // Big batches are split into horizontal bands, which never touch the same dst pixels, so
+    // each can be blitted independently with its own blitter. Small ones aren't worth it.
+    constexpr uint64_t kMinAreaToSplit = 512 * 512;
+    constexpr int kMaxBands = 4;
+    constexpr int kMinBandHeight = 64;
+    const int bands = area < kMinAreaToSplit
+                            ? 1
+                            : std::clamp(clipBounds.height() / kMinBandHeight, 1, kMaxBands);
+    if (bands == 1) {
+        blitBand(blitter, clipBounds);
+        return true;
+    }
+
+    const int bandHeight = (clipBounds.height() + bands - 1) / bands;
+    auto bandRect = [&](int b) {
+        const int top = clipBounds.fTop + b * bandHeight;
+        return SkIRect::MakeLTRB(clipBounds.fLeft, top,
+                                 clipBounds.fRight, std::min(clipBounds.fBottom, top + bandHeight));
+    };
+    SkTaskGroup tasks;
+    for (int b = 1; b < bands; ++b) {
+        tasks.add([&, b] {
+            SkSTArenaAlloc<kSkBlitterContextSize> bandAllocator;
+            SkSpriteBlitter* bandBlitter = SkBlitter::ChooseSprite(fDst, paint, src, 0, 0,
+                                                                   &bandAllocator,
+                                                                   fRC->clipShader());
+            // Band 0 got a blitter from the same inputs.
+            SkASSERT(bandBlitter);
+            if (bandBlitter) {
+                blitBand(bandBlitter, bandRect(b));
+            }
+        });
+    }
+    blitBand(blitter, bandRect(0));
+    tasks.wait();
+    return true;
+}
+
 #if defined(SK_SUPPORT_LEGACY_ALPHA_BITMAP_AS_COVERAGE)
 void SkDraw::drawDevMask(const SkMask& srcM, const SkPaint& paint) const {
     if (srcM.fBounds.isEmpty()) {
@@ -26,10 +26,13 @@ class SkGlyph;
 class SkGlyphRunListPainterCPU;
 class SkMatrix;
 class SkPaint;
+class SkPixmap;
 class SkVertices;
 namespace sktext { class GlyphRunList; }
 struct SkPoint3;
 struct SkPoint;
+struct SkIPoint;
+struct SkIRect;
 struct SkRSXform;
 struct SkRect;
 
@@ -43,6 +46,12 @@ public:
     void    drawBitmap(const SkBitmap&, const SkMatrix&, const SkRect* dstOrNull,
                        const SkSamplingOptions&, const SkPaint&) const override;
     void    drawSprite(const SkBitmap&, int x, int y, const SkPaint&) const;
+    /* Draws integer-aligned subsets of 'src' with one blitter, ignoring the CTM: srcRects[i] is
+       copied so that its top-left lands on dstPoints[i]. Large batches are split into bands that
+       run on SkExecutor::GetDefault(). Returns false, having drawn nothing, if the paint or clip
+       needs the general (shader) path. */
+    bool    drawSprites(const SkPixmap& src, const SkIRect srcRects[], const SkIPoint dstPoints[],
+                        int count, const SkPaint&) const;
     void    drawGlyphRunList(SkCanvas* canvas,
                              SkGlyphRunListPainterCPU* glyphPainter,
                              const sktext::GlyphRunList& glyphRunList,
@@ -445,6 +445,10 @@ void SkDrawBase::drawPath(const SkPath& origSrcPath, const SkPaint& origPaint,
         if (this->computeConservativeLocalClipBounds(&cullRect)) {
             cullRectPtr = &cullRect;
         }
+        if (pathIsMutable) {
+            // The path is a temporary, so don't cache its stroke by its generation ID.
+            pathPtr->setIsVolatile(true);
+        }
         doFill = skpathutils::FillPathWithPaint(*pathPtr, *paint, tmpPath, cullRectPtr, *fCTM);
         pathPtr = tmpPath;
     }
@@ -0,0 +1,13 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/core/SkDrawStatsSink.h"
+
+SkDrawStatsSink*& SkDrawStatsSink::Current() {
+    static thread_local SkDrawStatsSink* sink = nullptr;
+    return sink;
+}
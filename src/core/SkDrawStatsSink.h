@@ -0,0 +1,56 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkDrawStatsSink_DEFINED
+#define SkDrawStatsSink_DEFINED
+
+/**
+ *  Receives the rendering choices the backends make while drawing, for SkDrawStatsCanvas. The
+ *  canvas installs a sink on the calling thread around each draw it forwards, so the choices are
+ *  attributed to that draw. Work deferred to other threads, or to flush time, is not seen.
+ *
+ *  With no sink installed, noting a choice costs one thread-local load.
+ */
+class SkDrawStatsSink {
+public:
+    virtual ~SkDrawStatsSink() = default;
+
+    // A GPU backend picked a renderer for the draw: a Ganesh PathRenderer, or a Graphite Renderer.
+    static void NoteRenderer(const char* name) {
+        if (SkDrawStatsSink* sink = Current()) {
+            sink->onRenderer(name);
+        }
+    }
+
+    // The CPU backend built a SkRasterPipeline program.
+    static void NoteRasterPipeline(bool lowp) {
+        if (SkDrawStatsSink* sink = Current()) {
+            sink->onRasterPipeline(lowp);
+        }
+    }
+
+    class AutoInstall {
+    public:
+        explicit AutoInstall(SkDrawStatsSink* sink) : fPrevious(Current()) { Current() = sink; }
+        ~AutoInstall() { Current() = fPrevious; }
+
+        AutoInstall(const AutoInstall&) = delete;
+        AutoInstall& operator=(const AutoInstall&) = delete;
+
+    private:
+        SkDrawStatsSink* fPrevious;
+    };
+
+protected:
+    virtual void onRenderer(const char* name) = 0;
+    virtual void onRasterPipeline(bool lowp) = 0;
+
+private:
+    static SkDrawStatsSink*& Current();
+};
+
+#endif  // SkDrawStatsSink_DEFINED
@@ -7,6 +7,7 @@
 
 #include "include/core/SkAlphaType.h"
 #include "include/core/SkColor.h"
+#include "include/core/SkImage.h"
 #include "include/core/SkMaskFilter.h"
 #include "include/core/SkMatrix.h"
 #include "include/core/SkPaint.h"
@@ -27,15 +28,18 @@
 #include "src/core/SkCoreBlitters.h"
 #include "src/core/SkDraw.h"
 #include "src/core/SkEffectPriv.h"
+#include "src/core/SkMatrixUtils.h"
 #include "src/core/SkRasterClip.h"
 #include "src/core/SkRasterPipeline.h"
 #include "src/core/SkRasterPipelineOpContexts.h"
 #include "src/core/SkRasterPipelineOpList.h"
 #include "src/core/SkScan.h"
 #include "src/core/SkSurfacePriv.h"
+#include "src/shaders/SkImageShader.h"
 #include "src/shaders/SkShaderBase.h"
 #include "src/shaders/SkTransformShader.h"
 
+#include <cmath>
 #include <cstdint>
 #include <optional>
 
@@ -68,6 +72,44 @@ static void load_color(SkRasterPipeline_UniformColorCtx* ctx, const float rgba[]
     ctx->rgba[3] = SkScalarRoundToInt(rgba[3]*255); ctx->a = rgba[3];
 }
 
+// If every sprite is an unrotated, unscaled copy of a rect of a raster image that lands on
+// (or is snapped to) whole pixels, fills in the equivalent sprite batch and returns the image's
+// pixels. Sampling doesn't matter in that case.
+static bool atlas_as_sprites(const SkMatrix& ctm, const SkShader* atlasShader,
+                             const SkRSXform xform[], const SkRect textures[], int count,
+                             SkPixmap* pixmap, SkIRect srcRects[], SkIPoint dstPoints[]) {
+    if (!ctm.isTranslate() || as_SB(atlasShader)->type() != SkShaderBase::ShaderType::kImage) {
+        return false;
+    }
+    auto imageShader = static_cast<const SkImageShader*>(atlasShader);
+    if (imageShader->isRaw() || !imageShader->image()->peekPixels(pixmap)) {
+        return false;
+    }
+
+    const SkIRect imageBounds = SkIRect::MakeSize(pixmap->dimensions());
+    for (int i = 0; i < count; ++i) {
+        if (xform[i].fSCos != 1 || xform[i].fSSin != 0) {
+            return false;
+        }
+        const SkIRect src = textures[i].round();
+        if (SkRect::Make(src) != textures[i] || !imageBounds.contains(src)) {
+            return false;
+        }
+        const SkMatrix m = SkMatrix::Translate(ctm.getTranslateX() + xform[i].fTx,
+                                               ctm.getTranslateY() + xform[i].fTy);
+        // Keep the rounded dst rect well inside int range (this also rejects NaN).
+        constexpr float kMaxCoord = 1 << 29;
+        if (!(std::abs(m.getTranslateX()) < kMaxCoord && std::abs(m.getTranslateY()) < kMaxCoord) ||
+            !SkTreatAsSprite(m, src.size(), imageShader->sampling(), /*isAntiAlias=*/false)) {
+            return false;
+        }
+        srcRects[i] = src;
+        dstPoints[i] = {SkScalarRoundToInt(m.getTranslateX()),
+                        SkScalarRoundToInt(m.getTranslateY())};
+    }
+    return true;
+}
+
 void SkDraw::drawAtlas(const SkRSXform xform[],
                        const SkRect textures[],
                        const SkColor colors[],
@@ -87,6 +129,19 @@ void SkDraw::drawAtlas(const SkRSXform xform[],
     p.setShader(nullptr);
     p.setMaskFilter(nullptr);
 
+    // Without colors, translate-only sprites from a raster atlas can skip the per-sprite shader
+    // update and share one sprite blitter.
+    if (!colors) {
+        SkPixmap pixmap;
+        auto srcRects = alloc.makeArrayDefault<SkIRect>(count);
+        auto dstPoints = alloc.makeArrayDefault<SkIPoint>(count);
+        if (atlas_as_sprites(*fCTM, atlasShader.get(), xform, textures, count,
+                             &pixmap, srcRects, dstPoints) &&
+            this->drawSprites(pixmap, srcRects, dstPoints, count, p)) {
+            return;
+        }
+    }
+
     // The RSXForms can't contain perspective - only the CTM can.
     const bool perspective = fCTM->hasPerspective();
 
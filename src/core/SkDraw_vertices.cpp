@@ -28,11 +28,18 @@
 #include "include/private/base/SkFloatingPoint.h"
 #include "include/private/base/SkTo.h"
 #include "src/base/SkArenaAlloc.h"
+#include "src/base/SkVx.h"
+#include "src/core/SkBlendModePriv.h"
 #include "src/core/SkBlenderBase.h"
+#include "src/core/SkColorSpacePriv.h"
+#include "src/core/SkColorSpaceXformSteps.h"
 #include "src/core/SkConvertPixels.h"
 #include "src/core/SkCoreBlitters.h"
 #include "src/core/SkDraw.h"
 #include "src/core/SkRasterClip.h"
+#include "src/core/SkRasterPipeline.h"
+#include "src/core/SkRasterPipelineOpContexts.h"
+#include "src/core/SkRasterPipelineOpList.h"
 #include "src/core/SkScan.h"
 #include "src/core/SkSurfacePriv.h"
 #include "src/core/SkVertState.h"
@@ -43,6 +50,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <optional>
 #include <utility>
 
@@ -184,6 +192,135 @@ static void fill_triangle(const VertState& state, SkBlitter* blitter, const SkRa
     }
 }
 
+namespace {
+
+// Draws triangles whose paint reduces to interpolated vertex colors, optionally modulated by an
+// opaque paint color, onto 8888 destinations.
+//
+// The generic path rebuilds SkTriColorShader's barycentric matrix for every triangle and runs the
+// full shader pipeline for every span. Here each triangle's setup is just a pair of color
+// gradients, each span's colors are stepped directly into an 8888 buffer, and every span of every
+// triangle is blended by the same small (lowp-friendly) pipeline that is compiled once per draw.
+class TriColorSpanBlitter final : public SkBlitter {
+public:
+    static TriColorSpanBlitter* Make(const SkPixmap& dst,
+                                     const SkRasterClip& rc,
+                                     const SkPaint& paint,
+                                     bool modulatePaintColor,
+                                     bool colorsAreOpaque,
+                                     SkArenaAlloc* alloc) {
+        if ((dst.colorType() != kRGBA_8888_SkColorType &&
+             dst.colorType() != kBGRA_8888_SkColorType) ||
+            dst.alphaType() == kUnpremul_SkAlphaType) {
+            return nullptr;
+        }
+        if (!rc.isBW() || rc.clipShader()) {
+            return nullptr;
+        }
+        if (paint.getColorFilter() || paint.getMaskFilter() || paint.isDither()) {
+            return nullptr;
+        }
+        std::optional<SkBlendMode> mode = paint.asBlendMode();
+        if (mode != SkBlendMode::kSrcOver && mode != SkBlendMode::kSrc) {
+            return nullptr;
+        }
+
+        SkColor4f paintColor = paint.getColor4f();
+        SkColorSpaceXformSteps(sk_srgb_singleton(), kUnpremul_SkAlphaType,
+                               dst.colorSpace(),    kUnpremul_SkAlphaType).apply(paintColor.vec());
+        const float a = paintColor.fA;
+        skvx::float4 scale = modulatePaintColor
+                ? skvx::float4{paintColor.fR * a, paintColor.fG * a, paintColor.fB * a, a}
+                : skvx::float4(a);
+        if (!skvx::all((scale >= 0) & (scale <= 1))) {
+            return nullptr;
+        }
+        if (*mode == SkBlendMode::kSrcOver && colorsAreOpaque && a == 1) {
+            mode = SkBlendMode::kSrc;
+        }
+
+        return alloc->make<TriColorSpanBlitter>(dst, *mode, scale, alloc);
+    }
+
+    TriColorSpanBlitter(const SkPixmap& dst, SkBlendMode mode, skvx::float4 scale,
+                        SkArenaAlloc* alloc)
+            : fScale(scale)
+            , fSrcPtr{nullptr, 0}
+            , fDstPtr{dst.writable_addr(), SkToInt(dst.rowBytesAsPixels())} {
+        SkRasterPipeline p(alloc);
+        p.appendLoad(kRGBA_8888_SkColorType, &fSrcPtr);
+        if (mode == SkBlendMode::kSrcOver) {
+            if (dst.colorType() == kBGRA_8888_SkColorType) {
+                p.append(SkRasterPipelineOp::swap_rb);
+            }
+            p.append(SkRasterPipelineOp::srcover_rgba_8888, &fDstPtr);
+        } else {
+            SkASSERT(mode == SkBlendMode::kSrc);
+            p.appendStore(dst.colorType(), &fDstPtr);
+        }
+        fBlitSpan = p.compile();
+    }
+
+    // Computes the color gradients for the triangle. Returns false if the triangle is too
+    // degenerate to have finite gradients (SkTriColorShader::update() rejects the same).
+    bool setTriangle(const SkPoint pts[3], const SkPMColor4f& c0, const SkPMColor4f& c1,
+                     const SkPMColor4f& c2) {
+        const SkVector e1 = pts[1] - pts[0],
+                       e2 = pts[2] - pts[0];
+        const float invDet = sk_ieee_float_divide(1.0f, e1.cross(e2));
+
+        const skvx::float4 v0 = skvx::float4::Load(c0.vec()) * fScale,
+                           d1 = skvx::float4::Load(c1.vec()) * fScale - v0,
+                           d2 = skvx::float4::Load(c2.vec()) * fScale - v0;
+        fDdx = (d1 * e2.fY - d2 * e1.fY) * invDet;
+        fDdy = (d2 * e1.fX - d1 * e2.fX) * invDet;
+        if (!skvx::all((fDdx * 0 == 0) & (fDdy * 0 == 0))) {  // any NaN or inf?
+            return false;
+        }
+        fOrigin = pts[0];
+        fC0 = v0;
+        return true;
+    }
+
+    void blitH(int x, int y, int width) override {
+        // Sample at pixel centers, relative to the first vertex to keep the numerics local.
+        skvx::float4 c = fC0 + (x + 0.5f - fOrigin.fX) * fDdx
+                             + (y + 0.5f - fOrigin.fY) * fDdy;
+        while (width > 0) {
+            const int n = std::min(width, kMaxSpan);
+            for (int i = 0; i < n; ++i) {
+                // Centers near an edge may extrapolate slightly; keep the result premultiplied.
+                skvx::float4 v = skvx::pin(c, skvx::float4(0), skvx::float4(1));
+                v = skvx::min(v, skvx::float4(v[3]));
+                skvx::cast<uint8_t>(v * 255 + 0.5f).store(fSpan + i);
+                c += fDdx;
+            }
+            fSrcPtr.pixels = fSpan - x;
+            fBlitSpan(x, y, n, 1);
+            x += n;
+            width -= n;
+        }
+    }
+
+    void blitAntiH(int, int, const SkAlpha[], const int16_t[]) override {
+        // SkScan::FillTriangle() only produces aliased spans.
+        SkDEBUGFAIL("blitAntiH not supported");
+    }
+
+private:
+    static constexpr int kMaxSpan = 256;
+
+    const skvx::float4 fScale;
+    skvx::float4 fC0, fDdx, fDdy;
+    SkPoint fOrigin;
+
+    SkRasterPipeline_MemoryCtx fSrcPtr, fDstPtr;
+    std::function<void(size_t, size_t, size_t, size_t)> fBlitSpan;
+    uint32_t fSpan[kMaxSpan];
+};
+
+}  // namespace
+
 void SkDraw::drawFixedVertices(const SkVertices* vertices,
                                sk_sp<SkBlender> blender,
                                const SkPaint& paint,
@@ -234,13 +371,38 @@ void SkDraw::drawFixedVertices(const SkVertices* vertices,
     // Explicit texture coords can't contain perspective - only the CTM can.
     const bool usePerspective = fCTM->hasPerspective();
 
-    SkTriColorShader* triColorShader = nullptr;
     SkPMColor4f* dstColors = nullptr;
+    bool colorsAreOpaque = false;
     if (colors) {
         dstColors =
                 convert_colors(colors, vertexCount, fDst.colorSpace(), outerAlloc, skipColorXform);
-        triColorShader = outerAlloc->make<SkTriColorShader>(compute_is_opaque(colors, vertexCount),
-                                                            usePerspective);
+        colorsAreOpaque = compute_is_opaque(colors, vertexCount);
+    }
+
+    // Interpolated colors alone (or modulated by the paint color) don't need the shader pipeline.
+    if (colors && !paintShader && dev2) {
+        const bool modulatePaintColor =
+                !blenderIsDst && as_BB(blender)->asBlendMode() == SkBlendMode::kModulate;
+        if (blenderIsDst || modulatePaintColor) {
+            if (auto* spanBlitter = TriColorSpanBlitter::Make(
+                        fDst, *fRC, paint, modulatePaintColor, colorsAreOpaque, outerAlloc)) {
+                VertState state(vertexCount, indices, indexCount);
+                VertState::Proc vertProc = state.chooseProc(info.mode());
+                while (vertProc(&state)) {
+                    SkPoint tmp[] = {dev2[state.f0], dev2[state.f1], dev2[state.f2]};
+                    if (spanBlitter->setTriangle(tmp, dstColors[state.f0], dstColors[state.f1],
+                                                 dstColors[state.f2])) {
+                        SkScan::FillTriangle(tmp, *fRC, spanBlitter);
+                    }
+                }
+                return;
+            }
+        }
+    }
+
+    SkTriColorShader* triColorShader = nullptr;
+    if (colors) {
+        triColorShader = outerAlloc->make<SkTriColorShader>(colorsAreOpaque, usePerspective);
     }
 
     // Combines per-vertex colors with 'shader' using 'blender'.
@@ -10,7 +10,9 @@
 #include "include/private/base/SkSemaphore.h"
 #include "include/private/base/SkTArray.h"
 #include "src/base/SkNoDestructor.h"
+#include "src/base/SkSpinlock.h"
 
+#include <atomic>
 #include <deque>
 #include <thread>
 #include <utility>
@@ -143,6 +145,173 @@ private:
     bool                  fAllowBorrowing;
 };
 
+// An SkWorkStealingThreadPool gives each of its threads a private deque of work.  Work added by
+// a pool thread goes to the back of that thread's deque, and the owner pops from the back (LIFO,
+// which keeps nested SkTaskGroup work hot in cache).  Idle threads steal from the front of other
+// threads' deques.  Work added from outside the pool, or with a non-normal priority, goes to one of
+// the shared injection queues instead.
+//
+// Each deque is guarded by its own spinlock rather than being a lock-free Chase-Lev deque; the
+// lock is only ever contended between an owner and a thief, never by every thread in the pool.
+//
+// fWorkAvailable counts queued work: every add() signals it exactly once, and a thread only goes
+// looking for work after a successful wait(), so there is always work to find for it.  Shutdown
+// signals one extra time per thread with fShuttingDown set.
+class SkWorkStealingThreadPool final : public SkExecutor {
+public:
+    explicit SkWorkStealingThreadPool(int threads, bool allowBorrowing)
+            : fWorkers(new Worker[threads])
+            , fWorkerCount(threads)
+            , fAllowBorrowing(allowBorrowing) {
+        for (int i = 0; i < threads; i++) {
+            fThreads.emplace_back(&Loop, this, i);
+        }
+    }
+
+    ~SkWorkStealingThreadPool() override {
+        fShuttingDown.store(true, std::memory_order_release);
+        fWorkAvailable.signal(fThreads.size());
+        for (int i = 0; i < fThreads.size(); i++) {
+            fThreads[i].join();
+        }
+    }
+
+    void add(std::function<void(void)> work) override {
+        this->addWithPriority(std::move(work), Priority::kNormal);
+    }
+
+    void addWithPriority(std::function<void(void)> work, Priority priority) override {
+        Worker* local = this->currentWorker();
+        if (local && priority == Priority::kNormal) {
+            SkAutoSpinlock lock(local->fLock);
+            local->fWork.emplace_back(std::move(work));
+        } else {
+            Injection& queue = fInjection[static_cast<int>(priority)];
+            SkAutoMutexExclusive lock(queue.fLock);
+            queue.fWork.emplace_back(std::move(work));
+        }
+        fWorkAvailable.signal(1);
+    }
+
+    void borrow() override {
+        if (fAllowBorrowing && fWorkAvailable.try_wait()) {
+            SkAssertResult(this->do_work(this->currentWorkerIndex()));
+        }
+    }
+
+private:
+    using WorkList = std::deque<std::function<void(void)>>;
+
+    struct Worker {
+        SkSpinlock fLock;
+        WorkList   fWork;
+    };
+
+    struct Injection {
+        SkMutex  fLock;
+        WorkList fWork;
+    };
+
+    // Identifies the pool (and slot in that pool) the current thread works for, if any.
+    struct ThreadSlot {
+        const SkWorkStealingThreadPool* fPool  = nullptr;
+        int                             fIndex = -1;
+    };
+    static ThreadSlot& CurrentSlot() {
+        static thread_local ThreadSlot slot;
+        return slot;
+    }
+
+    int currentWorkerIndex() const {
+        const ThreadSlot& slot = CurrentSlot();
+        return slot.fPool == this ? slot.fIndex : -1;
+    }
+
+    Worker* currentWorker() {
+        int index = this->currentWorkerIndex();
+        return index >= 0 ? &fWorkers[index] : nullptr;
+    }
+
+    static bool PopFront(WorkList* list, std::function<void(void)>* work) {
+        if (list->empty()) {
+            return false;
+        }
+        *work = std::move(list->front());
+        list->pop_front();
+        return true;
+    }
+
+    bool popInjected(Priority priority, std::function<void(void)>* work) {
+        Injection& queue = fInjection[static_cast<int>(priority)];
+        SkAutoMutexExclusive lock(queue.fLock);
+        return PopFront(&queue.fWork, work);
+    }
+
+    // Look for one piece of work, in priority order.  Returns false only if every list was empty
+    // when we looked at it.
+    bool findWork(int self, std::function<void(void)>* work) {
+        if (this->popInjected(Priority::kHigh, work)) {
+            return true;
+        }
+        if (self >= 0) {
+            Worker& mine = fWorkers[self];
+            SkAutoSpinlock lock(mine.fLock);
+            if (!mine.fWork.empty()) {
+                *work = std::move(mine.fWork.back());
+                mine.fWork.pop_back();
+                return true;
+            }
+        }
+        if (this->popInjected(Priority::kNormal, work)) {
+            return true;
+        }
+        // Steal, starting with our neighbor so thieves spread out over the victims.
+        for (int i = 1; i <= fWorkerCount; i++) {
+            int victim = (self + i + fWorkerCount) % fWorkerCount;
+            if (victim == self) {
+                continue;
+            }
+            SkAutoSpinlock lock(fWorkers[victim].fLock);
+            if (PopFront(&fWorkers[victim].fWork, work)) {
+                return true;
+            }
+        }
+        return this->popInjected(Priority::kLow, work);
+    }
+
+    // This method should be called only after a successful wait() on fWorkAvailable.
+    // Returns false when it's time for the calling thread to shut down.
+    bool do_work(int self) {
+        std::function<void(void)> work;
+        while (!this->findWork(self, &work)) {
+            // There's guaranteed to be work somewhere unless we were woken to shut down.
+            // Otherwise, it was only just added and is about to be visible.
+            if (fShuttingDown.load(std::memory_order_acquire)) {
+                return false;
+            }
+            std::this_thread::yield();
+        }
+        work();
+        return true;
+    }
+
+    static void Loop(SkWorkStealingThreadPool* pool, int index) {
+        CurrentSlot() = {pool, index};
+        do {
+            pool->fWorkAvailable.wait();
+        } while (pool->do_work(index));
+        CurrentSlot() = {};
+    }
+
+    TArray<std::thread>       fThreads;
+    std::unique_ptr<Worker[]> fWorkers;
+    int                       fWorkerCount;
+    Injection                 fInjection[3];  // Indexed by Priority.
+    SkSemaphore               fWorkAvailable;
+    std::atomic<bool>         fShuttingDown{false};
+    bool                      fAllowBorrowing;
+};
+
 std::unique_ptr<SkExecutor> SkExecutor::MakeFIFOThreadPool(int threads, bool allowBorrowing) {
     using WorkList = std::deque<std::function<void(void)>>;
     return std::make_unique<SkThreadPool<WorkList>>(threads > 0 ? threads : num_cores(),
@@ -153,3 +322,8 @@ std::unique_ptr<SkExecutor> SkExecutor::MakeLIFOThreadPool(int threads, bool all
     return std::make_unique<SkThreadPool<WorkList>>(threads > 0 ? threads : num_cores(),
                                                     allowBorrowing);
 }
+std::unique_ptr<SkExecutor> SkExecutor::MakeWorkStealingThreadPool(int threads,
+                                                                   bool allowBorrowing) {
+    return std::make_unique<SkWorkStealingThreadPool>(threads > 0 ? threads : num_cores(),
+                                                      allowBorrowing);
+}
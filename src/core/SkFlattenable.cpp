@@ -153,6 +153,7 @@ sk_sp<SkFlattenable> SkFlattenable::Deserialize(SkFlattenable::Type type, const
     SkReadBuffer buffer(data, size);
     if (procs) {
         buffer.setDeserialProcs(*procs);
+        buffer.trustIfChecksumMatches(procs->fTrustedChecksum);
     }
     return sk_sp<SkFlattenable>(buffer.readFlattenable(type));
 }
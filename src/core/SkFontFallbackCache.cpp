@@ -0,0 +1,97 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/core/SkFontFallbackCache.h"
+
+#include "include/core/SkTypeface.h"
+#include "include/private/base/SkTArray.h"
+#include "src/core/SkChecksum.h"
+
+#include <cstring>
+#include <utility>
+
+using namespace skia_private;
+
+struct SkFontFallbackCache::Entry {
+    Entry(std::unique_ptr<Chain> chain, int maxBlocks)
+            : fChain(std::move(chain)), fBlocks(maxBlocks) {
+        if (fChain) {
+            fTypefaces.resize(fChain->count());
+        }
+    }
+
+    const std::unique_ptr<Chain> fChain;
+    // The typefaces made so far, by their index in the chain.
+    TArray<sk_sp<SkTypeface>> fTypefaces;
+    // The coverage of the first fonts of the chain, as far as any character of the block has
+    // needed to look, by block.
+    SkLRUCache<SkUnichar, TArray<Coverage>> fBlocks;
+};
+
+uint32_t SkFontFallbackCache::KeyHash::operator()(const Key& key) const {
+    uint32_t hash = SkGoodHash()(key.fFamilyName);
+    hash = SkChecksum::Hash32(key.fLanguages.c_str(), key.fLanguages.size(), hash);
+    const uint32_t style[] = {static_cast<uint32_t>(key.fStyle.weight()),
+                              static_cast<uint32_t>(key.fStyle.width()),
+                              static_cast<uint32_t>(key.fStyle.slant()),
+                              key.fHasFamilyName};
+    return SkChecksum::Hash32(style, sizeof(style), hash);
+}
+
+SkFontFallbackCache::SkFontFallbackCache(int maxChains, int maxBlocksPerChain)
+        : fMaxBlocksPerChain(maxBlocksPerChain), fChains(maxChains) {}
+
+SkFontFallbackCache::~SkFontFallbackCache() = default;
+
+sk_sp<SkTypeface> SkFontFallbackCache::match(const char familyName[], const SkFontStyle& style,
+                                             const char* bcp47[], int bcp47Count,
+                                             SkUnichar character,
+                                             const MakeChainProc& makeChain) {
+    if (character < 0 || character > 0x10FFFF) {
+        return nullptr;
+    }
+
+    Key key{familyName != nullptr, SkString(familyName), style, SkString()};
+    for (int i = 0; i < bcp47Count; ++i) {
+        key.fLanguages.append(bcp47[i], strlen(bcp47[i]) + 1);
+    }
+
+    SkAutoMutexExclusive lock(fMutex);
+    std::unique_ptr<Entry>* found = fChains.find(key);
+    Entry* entry = found ? found->get()
+                         : fChains.insert(std::move(key),
+                                          std::make_unique<Entry>(makeChain(),
+                                                                  fMaxBlocksPerChain))->get();
+    if (!entry->fChain) {
+        return nullptr;
+    }
+
+    const SkUnichar block = character / kBlockSize;
+    TArray<Coverage>* coverages = entry->fBlocks.find(block);
+    if (!coverages) {
+        coverages = entry->fBlocks.insert(block, TArray<Coverage>());
+    }
+
+    const int bit = character % kBlockSize;
+    for (int i = 0; i < entry->fChain->count(); ++i) {
+        if (i == coverages->size()) {
+            entry->fChain->getCoverage(i, block * kBlockSize, &coverages->push_back());
+        }
+        if ((*coverages)[i].test(bit)) {
+            if (!entry->fTypefaces[i]) {
+                entry->fTypefaces[i] = entry->fChain->makeTypeface(i);
+            }
+            return entry->fTypefaces[i];
+        }
+    }
+    return nullptr;
+}
+
+void SkFontFallbackCache::reset() {
+    SkAutoMutexExclusive lock(fMutex);
+    fChains.reset();
+}
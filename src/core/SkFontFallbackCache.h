@@ -0,0 +1,101 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkFontFallbackCache_DEFINED
+#define SkFontFallbackCache_DEFINED
+
+#include "include/core/SkFontStyle.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkString.h"
+#include "include/core/SkTypes.h"
+#include "include/private/base/SkMutex.h"
+#include "include/private/base/SkThreadAnnotations.h"
+#include "src/core/SkLRUCache.h"
+
+#include <bitset>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+class SkTypeface;
+
+/**
+ *  Remembers the answers of SkFontMgr::matchFamilyStyleCharacter() for font managers that answer
+ *  with the first font that has a glyph for the character, out of a list of fonts (the fallback
+ *  chain) that only depends on the family, style and languages asked for.
+ *
+ *  The font manager makes each chain once. For each block of kBlockSize code points the cache
+ *  then keeps which characters of the block each font of the chain covers, found when the block
+ *  is first asked about. So a run of characters from one script, such as Han text, costs one
+ *  coverage check per font for its first character and bit tests after that, rather than a walk
+ *  of the fallback configuration per character.
+ *
+ *  The number of chains, and of blocks per chain, is bounded; the least recently used are
+ *  forgotten first. The cache is thread safe.
+ */
+class SkFontFallbackCache {
+public:
+    static constexpr int kBlockSize = 256;
+    using Coverage = std::bitset<kBlockSize>;
+
+    class Chain {
+    public:
+        virtual ~Chain() = default;
+
+        virtual int count() const = 0;
+
+        /** Sets bit (c - first) of coverage for each c in [first, first + kBlockSize) that
+         *  font index has a glyph for. */
+        virtual void getCoverage(int index, SkUnichar first, Coverage* coverage) const = 0;
+
+        virtual sk_sp<SkTypeface> makeTypeface(int index) const = 0;
+    };
+
+    using MakeChainProc = std::function<std::unique_ptr<Chain>()>;
+
+    static constexpr int kDefaultMaxChains = 16;
+    static constexpr int kDefaultMaxBlocksPerChain = 32;
+
+    SkFontFallbackCache(int maxChains = kDefaultMaxChains,
+                        int maxBlocksPerChain = kDefaultMaxBlocksPerChain);
+    ~SkFontFallbackCache();
+
+    /**
+     *  Returns the first font of the chain for (familyName, style, bcp47) that has a glyph for
+     *  character, or nullptr if none does. makeChain is called if the chain is not cached.
+     */
+    sk_sp<SkTypeface> match(const char familyName[], const SkFontStyle& style,
+                            const char* bcp47[], int bcp47Count, SkUnichar character,
+                            const MakeChainProc& makeChain);
+
+    void reset();
+
+private:
+    struct Key {
+        bool fHasFamilyName;
+        SkString fFamilyName;
+        SkFontStyle fStyle;
+        SkString fLanguages;  // The bcp47 tags, each followed by a '\0'.
+
+        bool operator==(const Key& that) const {
+            return fHasFamilyName == that.fHasFamilyName &&
+                   fFamilyName == that.fFamilyName &&
+                   fStyle == that.fStyle &&
+                   fLanguages == that.fLanguages;
+        }
+    };
+    struct KeyHash {
+        uint32_t operator()(const Key& key) const;
+    };
+    struct Entry;
+
+    const int fMaxBlocksPerChain;
+    SkMutex fMutex;
+    SkLRUCache<Key, std::unique_ptr<Entry>, KeyHash> fChains SK_GUARDED_BY(fMutex);
+};
+
+#endif
@@ -24,10 +24,12 @@
 #include "src/core/SkWriteBuffer.h"
 #include "src/text/StrikeForGPU.h"
 
+#include <algorithm>
 #include <cstring>
 #include <optional>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 using namespace skglyph;
 using namespace sktext;
@@ -346,16 +348,93 @@ void SkGlyph::flattenMetrics(SkWriteBuffer& buffer) const {
     buffer.writeUInt(SkTo<uint32_t>(fMaskFormat));
 }
 
-void SkGlyph::flattenImage(SkWriteBuffer& buffer) const {
+namespace {
+// Run-length encoding of 8-bit masks, which are mostly runs of fully covered or uncovered
+// pixels. A control byte n < 128 is followed by n + 1 literal bytes; a control byte n >= 128 is
+// followed by one byte that repeats n - 125 times, so runs are 3 to 130 bytes long.
+constexpr size_t kMaxLiteral = 128;
+constexpr size_t kMinRun = 3;
+constexpr size_t kMaxRun = 130;
+
+bool is_run_length_encoded(SkMask::Format format) {
+    return format == SkMask::kA8_Format || format == SkMask::kSDF_Format;
+}
+
+std::vector<uint8_t> run_length_encode(const uint8_t* src, size_t size) {
+    std::vector<uint8_t> encoded;
+    encoded.reserve(size + size / kMaxLiteral + 1);
+    size_t literalStart = 0;
+    auto flushLiterals = [&](size_t end) {
+        while (literalStart < end) {
+            const size_t count = std::min(end - literalStart, kMaxLiteral);
+            encoded.push_back(SkTo<uint8_t>(count - 1));
+            encoded.insert(encoded.end(), src + literalStart, src + literalStart + count);
+            literalStart += count;
+        }
+    };
+    size_t i = 0;
+    while (i < size) {
+        size_t run = 1;
+        while (i + run < size && run < kMaxRun && src[i + run] == src[i]) {
+            ++run;
+        }
+        if (run >= kMinRun) {
+            flushLiterals(i);
+            encoded.push_back(SkTo<uint8_t>(run + 125));
+            encoded.push_back(src[i]);
+            literalStart = i + run;
+        }
+        i += run;
+    }
+    flushLiterals(size);
+    return encoded;
+}
+
+// Returns false unless src decodes to exactly size bytes.
+bool run_length_decode(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t size) {
+    const uint8_t* const srcEnd = src + srcSize;
+    uint8_t* const dstEnd = dst + size;
+    while (src < srcEnd) {
+        const size_t control = *src++;
+        if (control < kMaxLiteral) {
+            const size_t count = control + 1;
+            if (SkToSizeT(srcEnd - src) < count || SkToSizeT(dstEnd - dst) < count) {
+                return false;
+            }
+            memcpy(dst, src, count);
+            src += count;
+            dst += count;
+        } else {
+            const size_t count = control - 125;
+            if (src == srcEnd || SkToSizeT(dstEnd - dst) < count) {
+                return false;
+            }
+            memset(dst, *src++, count);
+            dst += count;
+        }
+    }
+    return dst == dstEnd;
+}
+}  // namespace
+
+void SkGlyph::flattenImage(SkWriteBuffer& buffer, bool runLengthEncode) const {
     SkASSERT(this->setImageHasBeenCalled());
 
     // If the glyph is empty or too big, then no image data is sent.
     if (!this->isEmpty() && SkGlyphDigest::FitsInAtlas(*this)) {
-        buffer.writeByteArray(this->image(), this->imageSize());
+        if (runLengthEncode && is_run_length_encoded(this->maskFormat())) {
+            const std::vector<uint8_t> encoded =
+                    run_length_encode(static_cast<const uint8_t*>(this->image()),
+                                      this->imageSize());
+            buffer.writeByteArray(encoded.data(), encoded.size());
+        } else {
+            buffer.writeByteArray(this->image(), this->imageSize());
+        }
     }
 }
 
-size_t SkGlyph::addImageFromBuffer(SkReadBuffer& buffer, SkArenaAlloc* alloc) {
+size_t SkGlyph::addImageFromBuffer(SkReadBuffer& buffer, SkArenaAlloc* alloc,
+                                   bool runLengthEncoded) {
     SkASSERT(buffer.isValid());
 
     // If the glyph is empty or too big, then no image data is received.
@@ -366,7 +445,15 @@ size_t SkGlyph::addImageFromBuffer(SkReadBuffer& buffer, SkArenaAlloc* alloc) {
     size_t memoryIncrease = 0;
 
     void* imageData = alloc->makeBytesAlignedTo(this->imageSize(), this->formatAlignment());
-    buffer.readByteArray(imageData, this->imageSize());
+    if (runLengthEncoded && is_run_length_encoded(this->maskFormat())) {
+        size_t encodedSize;
+        const void* encoded = buffer.skipByteArray(&encodedSize);
+        buffer.validate(encoded != nullptr &&
+                        run_length_decode(static_cast<const uint8_t*>(encoded), encodedSize,
+                                          static_cast<uint8_t*>(imageData), this->imageSize()));
+    } else {
+        buffer.readByteArray(imageData, this->imageSize());
+    }
     if (buffer.isValid()) {
         this->installImage(imageData);
         memoryIncrease += this->imageSize();
@@ -534,11 +534,13 @@ public:
     // Flatten the metrics portions, but no drawing data.
     void flattenMetrics(SkWriteBuffer&) const;
 
-    // Flatten just the the mask data.
-    void flattenImage(SkWriteBuffer&) const;
+    // Flatten just the the mask data. If runLengthEncode is set, A8 and SDF masks are run length
+    // encoded.
+    void flattenImage(SkWriteBuffer&, bool runLengthEncode = false) const;
 
-    // Read the image data, store it in the alloc, and add it to the glyph.
-    size_t addImageFromBuffer(SkReadBuffer&, SkArenaAlloc*);
+    // Read the image data, store it in the alloc, and add it to the glyph. runLengthEncoded must
+    // match what the image was flattened with.
+    size_t addImageFromBuffer(SkReadBuffer&, SkArenaAlloc*, bool runLengthEncoded = false);
 
     // Flatten just the path data.
     void flattenPath(SkWriteBuffer&) const;
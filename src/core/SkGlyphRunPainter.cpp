@@ -25,6 +25,9 @@
 #include "include/private/base/SkFloatingPoint.h"
 #include "include/private/base/SkSpan_impl.h"
 #include "include/private/base/SkTArray.h"
+#include "include/private/base/SkTo.h"
+#include "src/base/SkZip.h"
+#include "src/core/SkEnumerate.h"
 #include "src/core/SkGlyph.h"
 #include "src/core/SkMask.h"
 #include "src/core/SkScalerContext.h"
@@ -132,13 +135,20 @@ prepare_for_direct_mask_drawing(SkStrike* strike,
 
     int acceptedSize = 0;
     int rejectedSize = 0;
+    // Map all the positions with one vectorized call. The accepted positions hold them until
+    // each is used, which is safe since a glyph is only ever accepted into an earlier slot.
+    SkASSERT(source.size() <= acceptedBuffer.size());
+    const SkSpan<SkPoint> mappedPositions = acceptedBuffer.get<1>().first(source.size());
+    positionMatrixWithRounding.mapPoints(mappedPositions.data(), source.get<1>().data(),
+                                         SkToInt(source.size()));
+
     strike->lock();
-    for (auto [glyphID, pos] : source) {
+    for (auto [i, glyphID, pos] : SkMakeEnumerate(source)) {
         if (!SkIsFinite(pos.x(), pos.y())) {
             continue;
         }
 
-        const SkPoint mappedPos = positionMatrixWithRounding.mapPoint(pos);
+        const SkPoint mappedPos = mappedPositions[i];
         const SkPackedGlyphID packedGlyphID = SkPackedGlyphID{glyphID, mappedPos, mask};
         switch (SkGlyphDigest digest = strike->digestFor(kDirectMaskCPU, packedGlyphID);
                 digest.actionFor(kDirectMaskCPU)) {
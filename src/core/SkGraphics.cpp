@@ -7,17 +7,40 @@
 
 #include "include/core/SkGraphics.h"
 
+#include "include/core/SkString.h"
+#include "include/core/SkTraceMemoryDump.h"
+#include "src/base/SkAllocationCounters.h"
+#include "src/base/SkArenaAlloc.h"
 #include "src/core/SkBitmapProcState.h"
 #include "src/core/SkBlitMask.h"
 #include "src/core/SkBlitRow.h"
+#include "src/core/SkConvertPixels.h"
 #include "src/core/SkCpu.h"
+#include "src/core/SkCurveBatch.h"
+#include "src/core/SkDistanceFieldGen.h"
+#include "src/core/SkICCProfileCache.h"
+#include "src/core/SkImageFilterCache.h"
+#include "src/core/SkImageFilterTypes.h"
 #include "src/core/SkImageFilter_Base.h"
+#include "src/core/SkLayerPixelPool.h"
+#include "src/core/SkMatrixBatch.h"
 #include "src/core/SkMemset.h"
+#include "src/core/SkMipmapDownsample.h"
 #include "src/core/SkOpts.h"
+#include "src/core/SkPictureLayerCache.h"
+#include "src/core/SkPixelAllocator.h"
+#include "src/core/SkRasterPipelineCache.h"
 #include "src/core/SkResourceCache.h"
+#include "src/core/SkRuntimeEffectCache.h"
+#include "src/core/SkRuntimeEffectProfiler.h"
+#include "src/core/SkScan.h"
 #include "src/core/SkStrikeCache.h"
 #include "src/core/SkSwizzlePriv.h"
+#include "src/core/SkTextQuads.h"
 #include "src/core/SkTypefaceCache.h"
+#include "src/shaders/SkImageShader.h"
+#include "src/shaders/SkPerlinNoiseShaderImpl.h"
+#include "src/shaders/gradients/SkGradientBaseShader.h"
 
 void SkGraphics::Init() {
     // SkGraphics::Init() must be thread-safe and idempotent.
@@ -26,8 +49,13 @@ void SkGraphics::Init() {
     SkOpts::Init_BitmapProcState();
     SkOpts::Init_BlitMask();
     SkOpts::Init_BlitRow();
+    SkOpts::Init_CurveBatch();
+    SkOpts::Init_DistanceFieldGen();
+    SkOpts::Init_MatrixBatch();
     SkOpts::Init_Memset();
+    SkOpts::Init_MipmapDownsample();
     SkOpts::Init_Swizzler();
+    SkOpts::Init_TextQuads();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -35,12 +63,134 @@ void SkGraphics::Init() {
 void SkGraphics::DumpMemoryStatistics(SkTraceMemoryDump* dump) {
   SkResourceCache::DumpMemoryStatistics(dump);
   SkStrikeCache::DumpMemoryStatistics(dump);
+
+  if (SkAllocationCounters::IsEnabled()) {
+      for (int i = 0; i < SkAllocationCounters::kCategoryCount; i++) {
+          const auto category = static_cast<SkAllocationCategory>(i);
+          const SkAllocationCounters::Counts counts = SkAllocationCounters::Get(category);
+          SkString dumpName = SkStringPrintf("skia/sk_allocations/%s",
+                                             SkAllocationCounters::Name(category));
+          dump->dumpNumericValue(dumpName.c_str(), "size", "bytes", counts.fCurrent);
+          dump->dumpNumericValue(dumpName.c_str(), "peak_size", "bytes", counts.fPeak);
+      }
+  }
 }
 
 void SkGraphics::PurgeAllCaches() {
     SkGraphics::PurgeFontCache();
     SkGraphics::PurgeResourceCache();
     SkImageFilter_Base::PurgeCache();
+    SkRasterPipelineCache::Global()->purgeAll();
+    SkRuntimeEffectCache::Global()->purgeAll();
+    SkGradientBaseShader::PurgeRasterLUTCache();
+    SkLayerPixelPool::Global()->purgeAll();
+    SkICCProfileCache::Global()->purgeAll();
+    SkPictureLayerCache::Global()->purgeAll();
+    SkArenaAlloc::PurgeThreadBlockCache();
+}
+
+void SkGraphics::SetParallelPathFill(SkExecutor* executor,
+                                     int minPointCount,
+                                     int64_t minPixelCount) {
+    SkScan::SetParallelAntiFill(executor, minPointCount, minPixelCount);
+}
+
+void SkGraphics::SetParallelPixelConversion(SkExecutor* executor, int64_t minPixelCount) {
+    SkSetParallelConvertPixels(executor, minPixelCount);
+}
+
+void SkGraphics::SetParallelImageFilters(SkExecutor* executor) {
+    skif::SetRasterBackendExecutor(executor);
+}
+
+void SkGraphics::SetImageFilterTileSize(int tileSize) {
+    skif::SetRasterBackendTileSize(tileSize);
+}
+
+void SkGraphics::SetImageFilterCacheContentKeys(bool enabled) {
+    SkImageFilterCache::Get()->setContentKeyed(enabled);
+}
+
+size_t SkGraphics::SetImageFilterCacheByteLimit(size_t newLimit) {
+    return SkImageFilterCache::Get()->setByteLimit(newLimit);
+}
+
+SkGraphics::ImageFilterCacheStats SkGraphics::GetImageFilterCacheStats() {
+    const SkImageFilterCache::Stats stats = SkImageFilterCache::Get()->stats();
+    ImageFilterCacheStats result;
+    result.fBytesUsed = stats.fBytesUsed;
+    result.fByteLimit = stats.fByteLimit;
+    result.fEntryCount = stats.fEntryCount;
+    result.fHits = stats.fHits;
+    result.fMisses = stats.fMisses;
+    return result;
+}
+
+void SkGraphics::SetRasterGradientLUT(bool enabled) {
+    SkGradientBaseShader::SetUseRasterLUT(enabled);
+}
+
+void SkGraphics::SetRasterNoiseTileCache(bool enabled) {
+    SkPerlinNoiseShader::SetUseRasterTileCache(enabled);
+}
+
+void SkGraphics::SetRasterYUVAPlanarSampling(bool enabled) {
+    SkImageShader::SetUseRasterYUVAPlanes(enabled);
+}
+
+size_t SkGraphics::SetRasterLayerPoolByteLimit(size_t newLimit) {
+    return SkLayerPixelPool::Global()->setByteLimit(newLimit);
+}
+
+SkGraphics::RasterLayerPoolStats SkGraphics::GetRasterLayerPoolStats() {
+    const SkLayerPixelPool::Stats stats = SkLayerPixelPool::Global()->stats();
+    RasterLayerPoolStats result;
+    result.fBytesPooled = stats.fBytesPooled;
+    result.fBytesInUse = stats.fBytesInUse;
+    result.fPeakBytesInUse = stats.fPeakBytesInUse;
+    result.fReuses = stats.fReuses;
+    result.fAllocations = stats.fAllocations;
+    return result;
+}
+
+size_t SkGraphics::SetPictureLayerCacheByteLimit(size_t newLimit) {
+    return SkPictureLayerCache::Global()->setByteLimit(newLimit);
+}
+
+SkGraphics::PictureLayerCacheStats SkGraphics::GetPictureLayerCacheStats() {
+    const SkPictureLayerCache::Stats stats = SkPictureLayerCache::Global()->stats();
+    PictureLayerCacheStats result;
+    result.fBytesUsed = stats.fBytesUsed;
+    result.fCount = stats.fCount;
+    result.fHits = stats.fHits;
+    result.fMisses = stats.fMisses;
+    result.fPromotions = stats.fPromotions;
+    return result;
+}
+
+SkGraphics::RasterPixelAllocator SkGraphics::SetRasterPixelAllocator(
+        const RasterPixelAllocator& allocator) {
+    return SkPixelAllocator::Set(allocator);
+}
+
+SkGraphics::RasterPixelAllocator SkGraphics::HugePageRasterPixelAllocator(size_t minBytes) {
+    RasterPixelAllocator allocator;
+    allocator.fAlloc = SkPixelAllocator::HugePageAlloc;
+    allocator.fFree = SkPixelAllocator::HugePageFree;
+    allocator.fMinBytes = minBytes;
+    return allocator;
+}
+
+void SkGraphics::SetArenaBlockRecycling(bool enabled) {
+    SkArenaAlloc::SetBlockRecycling(enabled);
+}
+
+void SkGraphics::SetMemoryAccounting(bool enabled) {
+    SkAllocationCounters::SetEnabled(enabled);
+}
+
+void SkGraphics::ResetMemoryHighWaterMarks() {
+    SkAllocationCounters::ResetPeaks();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -78,6 +228,66 @@ void SkGraphics::PurgePinnedFontCache() {
     SkStrikeCache::GlobalStrikeCache()->purgePinned();
 }
 
+int SkGraphics::GetRasterPipelineCacheCountLimit() {
+    return SkRasterPipelineCache::Global()->getCountLimit();
+}
+
+int SkGraphics::SetRasterPipelineCacheCountLimit(int count) {
+    return SkRasterPipelineCache::Global()->setCountLimit(count);
+}
+
+int SkGraphics::GetRasterPipelineCacheCountUsed() {
+    return SkRasterPipelineCache::Global()->getCountUsed();
+}
+
+uint64_t SkGraphics::GetRasterPipelineCacheHitCount() {
+    return SkRasterPipelineCache::Global()->getHitCount();
+}
+
+uint64_t SkGraphics::GetRasterPipelineCacheMissCount() {
+    return SkRasterPipelineCache::Global()->getMissCount();
+}
+
+int SkGraphics::GetRuntimeEffectCacheCountLimit() {
+    return SkRuntimeEffectCache::Global()->getCountLimit();
+}
+
+int SkGraphics::SetRuntimeEffectCacheCountLimit(int count) {
+    return SkRuntimeEffectCache::Global()->setCountLimit(count);
+}
+
+size_t SkGraphics::GetRuntimeEffectCacheByteLimit() {
+    return SkRuntimeEffectCache::Global()->getByteLimit();
+}
+
+size_t SkGraphics::SetRuntimeEffectCacheByteLimit(size_t bytes) {
+    return SkRuntimeEffectCache::Global()->setByteLimit(bytes);
+}
+
+int SkGraphics::GetRuntimeEffectCacheCountUsed() {
+    return SkRuntimeEffectCache::Global()->getCountUsed();
+}
+
+size_t SkGraphics::GetRuntimeEffectCacheBytesUsed() {
+    return SkRuntimeEffectCache::Global()->getBytesUsed();
+}
+
+bool SkGraphics::GetRuntimeEffectProfiling() {
+    return SkRuntimeEffectProfiler::Global()->isEnabled();
+}
+
+bool SkGraphics::SetRuntimeEffectProfiling(bool enabled) {
+    return SkRuntimeEffectProfiler::Global()->setEnabled(enabled);
+}
+
+void SkGraphics::DumpRuntimeEffectProfile(SkTraceMemoryDump* dump) {
+    SkRuntimeEffectProfiler::Global()->dump(dump);
+}
+
+void SkGraphics::ResetRuntimeEffectProfile() {
+    SkRuntimeEffectProfiler::Global()->reset();
+}
+
 static int gTypefaceCacheCountLimit = 1024; // historical default value
 
 int SkGraphics::GetTypefaceCacheCountLimit() {
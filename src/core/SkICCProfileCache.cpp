@@ -0,0 +1,94 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/core/SkICCProfileCache.h"
+
+#include "src/core/SkChecksum.h"
+
+#include <utility>
+
+// Enough for a few dozen typical camera and display profiles, or a handful with large LUTs.
+static constexpr size_t kDefaultByteLimit = 4 * 1024 * 1024;
+// SkLRUCache needs a count limit too; the byte limit should be what purges in practice.
+static constexpr int kMaxCount = 1024;
+
+SkICCProfileCache* SkICCProfileCache::Global() {
+    static SkICCProfileCache* cache = new SkICCProfileCache(kDefaultByteLimit);
+    return cache;
+}
+
+SkICCProfileCache::SkICCProfileCache(size_t byteLimit) : fCache(kMaxCount), fByteLimit(byteLimit) {}
+
+sk_sp<const SkICCProfileCache::Entry> SkICCProfileCache::intern(sk_sp<SkData> data) {
+    if (!data) {
+        return nullptr;
+    }
+    const uint32_t hash = SkChecksum::Hash32(data->data(), data->size());
+    {
+        SkAutoMutexExclusive lock(fMutex);
+        if (sk_sp<const Entry>* found = fCache.find(hash)) {
+            if ((*found)->fData->equals(data.get())) {
+                fStats.fHits++;
+                return *found;
+            }
+        }
+        fStats.fMisses++;
+    }
+
+    // Parse without holding the lock; another thread may intern the same bytes meanwhile, in
+    // which case the later one wins the slot and both results are equivalent.
+    sk_sp<Entry> entry(new Entry);
+    if (!skcms_Parse(data->data(), data->size(), &entry->fProfile)) {
+        return nullptr;
+    }
+    entry->fData = std::move(data);
+    entry->fColorSpace = SkColorSpace::Make(entry->fProfile);
+    if (entry->fColorSpace) {
+        skcms_ICCProfile csProfile;
+        entry->fColorSpace->toProfile(&csProfile);
+        entry->fColorSpaceIsExact =
+                skcms_ApproximatelyEqualProfiles(&entry->fProfile, &csProfile);
+    }
+
+    const size_t bytes = entry->fData->size();
+    if (bytes <= fByteLimit) {
+        SkAutoMutexExclusive lock(fMutex);
+        if (sk_sp<const Entry>* old = fCache.find(hash)) {
+            fStats.fBytesUsed -= (*old)->fData->size();
+            *old = entry;
+        } else {
+            sk_sp<const Entry> evicted;
+            if (fCache.count() >= fCache.maxCount() && fCache.removeLeastRecentlyUsed(&evicted)) {
+                fStats.fBytesUsed -= evicted->fData->size();
+            }
+            fCache.insert(hash, entry);
+        }
+        fStats.fBytesUsed += bytes;
+        this->purgeAsNeeded();
+    }
+    return entry;
+}
+
+void SkICCProfileCache::purgeAsNeeded() {
+    sk_sp<const Entry> evicted;
+    while (fStats.fBytesUsed > fByteLimit && fCache.removeLeastRecentlyUsed(&evicted)) {
+        fStats.fBytesUsed -= evicted->fData->size();
+    }
+}
+
+SkICCProfileCache::Stats SkICCProfileCache::stats() {
+    SkAutoMutexExclusive lock(fMutex);
+    Stats stats = fStats;
+    stats.fCount = fCache.count();
+    return stats;
+}
+
+void SkICCProfileCache::purgeAll() {
+    SkAutoMutexExclusive lock(fMutex);
+    fCache.reset();
+    fStats.fBytesUsed = 0;
+}
@@ -0,0 +1,68 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkICCProfileCache_DEFINED
+#define SkICCProfileCache_DEFINED
+
+#include "include/core/SkColorSpace.h"
+#include "include/core/SkData.h"
+#include "include/core/SkRefCnt.h"
+#include "include/private/base/SkMutex.h"
+#include "include/private/base/SkThreadAnnotations.h"
+#include "modules/skcms/skcms.h"
+#include "src/core/SkLRUCache.h"
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ *  Interns parsed ICC profiles by their bytes. Images from the same camera or app tend to embed
+ *  the same few profiles, so decoders parse each of them once and share a single SkColorSpace,
+ *  which also lets later color space checks compare pointers.
+ *
+ *  Recently used profiles are kept until their bytes exceed the cache's limit.
+ */
+class SkICCProfileCache {
+public:
+    static SkICCProfileCache* Global();
+
+    explicit SkICCProfileCache(size_t byteLimit);
+
+    struct Entry : public SkNVRefCnt<Entry> {
+        sk_sp<SkData>       fData;     // the first copy seen of these bytes
+        skcms_ICCProfile    fProfile;  // points into fData
+        // Null if SkColorSpace can't represent the profile.
+        sk_sp<SkColorSpace> fColorSpace;
+        // True if converting between fProfile and fColorSpace would be a no-op.
+        bool                fColorSpaceIsExact = false;
+    };
+
+    // Returns the profile parsed from these bytes, parsing them only if they are not in the
+    // cache. Returns null if they are not a valid ICC profile.
+    sk_sp<const Entry> intern(sk_sp<SkData>);
+
+    struct Stats {
+        size_t   fBytesUsed = 0;  // profile bytes held by the cache
+        int      fCount = 0;      // profiles held by the cache
+        uint64_t fHits = 0;
+        uint64_t fMisses = 0;
+    };
+    Stats stats();
+
+    void purgeAll();
+
+private:
+    void purgeAsNeeded() SK_REQUIRES(fMutex);
+
+    SkMutex fMutex;
+    // Keyed by a hash of the bytes; a hit still compares the bytes.
+    SkLRUCache<uint32_t, sk_sp<const Entry>> fCache SK_GUARDED_BY(fMutex);
+    const size_t fByteLimit;
+    Stats        fStats SK_GUARDED_BY(fMutex);
+};
+
+#endif  // SkICCProfileCache_DEFINED
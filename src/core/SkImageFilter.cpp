@@ -8,14 +8,22 @@
 #include "include/core/SkImageFilter.h"
 
 #include "include/core/SkColorFilter.h"
+#include "include/core/SkData.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkMatrix.h"
+#include "include/core/SkPicture.h"
 #include "include/core/SkPoint.h"
 #include "include/core/SkRect.h"
+#include "include/core/SkSerialProcs.h"
+#include "include/core/SkTypeface.h"
 #include "include/core/SkTypes.h"
+#include "include/private/base/SkMutex.h"
 #include "include/private/base/SkTArray.h"
 #include "include/private/base/SkTemplates.h"
+#include "include/private/base/SkTo.h"
+#include "src/base/SkNoDestructor.h"
+#include "src/core/SkChecksum.h"
 #include "src/core/SkImageFilterCache.h"
 #include "src/core/SkImageFilterTypes.h"
 #include "src/core/SkImageFilter_Base.h"
@@ -24,6 +32,8 @@
 #include "src/core/SkReadBuffer.h"
 #include "src/core/SkRectPriv.h"
 #include "src/core/SkSpecialImage.h"
+#include "src/core/SkTHash.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/core/SkValidationUtils.h"
 #include "src/core/SkWriteBuffer.h"
 #include "src/effects/colorfilters/SkColorFilterBase.h"
@@ -164,6 +174,78 @@ SkImageFilter_Base::~SkImageFilter_Base() {
     SkImageFilterCache::Get()->purgeByImageFilter(this);
 }
 
+namespace {
+
+// Maps the flattened bytes of a filter graph to the content ID shared by every filter that
+// flattens to them. The map is bounded by clearing it when it gets too large; filters that later
+// compute their content ID then get a new one, and miss any results cached under the old one.
+class ContentIDRegistry {
+public:
+    uint32_t findOrAdd(sk_sp<SkData> data) {
+        SkAutoMutexExclusive lock(fMutex);
+        const Key key{std::move(data)};
+        if (const uint32_t* id = fIDs.find(key)) {
+            return *id;
+        }
+        if (fIDs.count() >= kMaxContentIDs) {
+            fIDs.reset();
+        }
+        // Draw from the unique ID sequence so that content IDs never match a unique ID.
+        const uint32_t id = next_image_filter_unique_id();
+        fIDs.set(key, id);
+        return id;
+    }
+
+private:
+    static constexpr int kMaxContentIDs = 4096;
+
+    struct Key {
+        sk_sp<SkData> fData;
+        bool operator==(const Key& other) const { return fData->equals(other.fData.get()); }
+    };
+    struct KeyHash {
+        uint32_t operator()(const Key& key) const {
+            return SkChecksum::Hash32(key.fData->data(), key.fData->size());
+        }
+    };
+
+    SkMutex fMutex;
+    skia_private::THashMap<Key, uint32_t, KeyHash> fIDs;
+};
+
+static sk_sp<SkData> unique_id_data(uint32_t id) {
+    return SkData::MakeWithCopy(&id, sizeof(id));
+}
+
+}  // namespace
+
+uint32_t SkImageFilter_Base::contentID() const {
+    if (uint32_t id = fContentID.load(std::memory_order_acquire)) {
+        return id;
+    }
+
+    // Images, pictures and typefaces are identified by their unique IDs instead of their
+    // contents, which are immutable for a given ID and can be expensive to serialize.
+    SkSerialProcs procs;
+    procs.fImageProc = [](SkImage* image, void*) { return unique_id_data(image->uniqueID()); };
+    procs.fPictureProc = [](SkPicture* picture, void*) {
+        return unique_id_data(picture->uniqueID());
+    };
+    procs.fTypefaceProc = [](SkTypeface* typeface, void*) {
+        return unique_id_data(typeface->uniqueID());
+    };
+    SkBinaryWriteBuffer buffer(procs);
+    buffer.writeFlattenable(this);
+
+    static SkNoDestructor<ContentIDRegistry> gRegistry;
+    const uint32_t id = buffer.bytesWritten() ? gRegistry->findOrAdd(buffer.snapshotAsData())
+                                              : fUniqueID;
+    // Racing threads may each compute an ID, but they are equal unless the registry was cleared
+    // in between, and either one is valid.
+    fContentID.store(id, std::memory_order_release);
+    return id;
+}
+
 std::pair<sk_sp<SkImageFilter>, std::optional<SkRect>>
 SkImageFilter_Base::Unflatten(SkReadBuffer& buffer) {
     Common common;
@@ -244,19 +326,23 @@ skif::FilterResult SkImageFilter_Base::filterImage(const skif::Context& context)
     uint32_t srcGenID = srcInKey ? context.source().image()->uniqueID() : SK_InvalidUniqueID;
     const SkIRect srcSubset = srcInKey ? context.source().image()->subset() : SkIRect::MakeWH(0, 0);
 
-    SkImageFilterCacheKey key(fUniqueID,
+    // Content-keyed results are shared by every filter with the same content, so they aren't
+    // tied to this filter and outlive it.
+    SkImageFilterCache* cache = context.backend()->cache();
+    const bool contentKeyed = cache && cache->contentKeyed();
+    SkImageFilterCacheKey key(contentKeyed ? this->contentID() : fUniqueID,
                               context.mapping().layerMatrix(),
                               SkIRect(context.desiredOutput()),
                               srcGenID, srcSubset);
-    if (context.backend()->cache() && context.backend()->cache()->get(key, &result)) {
+    if (cache && cache->get(key, &result)) {
         context.markCacheHit();
         return result;
     }
 
     result = this->onFilterImage(context);
 
-    if (context.backend()->cache()) {
-        context.backend()->cache()->set(key, this, result);
+    if (cache) {
+        cache->set(key, contentKeyed ? nullptr : this, result);
     }
 
     return result;
@@ -385,6 +471,40 @@ skif::FilterResult SkImageFilter_Base::getChildOutput(int index, const skif::Con
     return input ? as_IFB(input)->filterImage(ctx) : ctx.source();
 }
 
+void SkImageFilter_Base::getChildOutputs(const skif::Context& ctx,
+                                         SkSpan<skif::FilterResult> outputs) const {
+    SkASSERT(outputs.size() == SkToSizeT(this->countInputs()));
+    const int count = this->countInputs();
+
+    int filterCount = 0;
+    for (int i = 0; i < count; ++i) {
+        filterCount += this->getInput(i) ? 1 : 0;
+    }
+    SkExecutor* executor = ctx.backend()->executor();
+    if (!executor || filterCount < 2) {
+        for (int i = 0; i < count; ++i) {
+            outputs[i] = this->getChildOutput(i, ctx);
+        }
+        return;
+    }
+
+    // Each input records into its own stats, so that only this thread updates the context's.
+    // The cache is shared, and is safe to use from every input's thread.
+    skia_private::AutoSTArray<4, skif::Stats> stats(count);
+    SkTaskGroup tasks(*executor);
+    for (int i = 1; i < count; ++i) {
+        tasks.add([this, &ctx, &stats, outputs, i] {
+            outputs[i] = this->getChildOutput(i, ctx.withNewStats(&stats[i]));
+        });
+    }
+    outputs[0] = this->getChildOutput(0, ctx.withNewStats(&stats[0]));
+    tasks.wait();
+
+    for (int i = 0; i < count; ++i) {
+        ctx.addStats(stats[i]);
+    }
+}
+
 void SkImageFilter_Base::PurgeCache() {
     auto cache = SkImageFilterCache::Get(SkImageFilterCache::CreateIfNecessary::kNo);
     if (cache) {
@@ -16,6 +16,7 @@
 #include "src/core/SkTDynamicHash.h"
 #include "src/core/SkTHash.h"
 
+#include <atomic>
 #include <vector>
 
 using namespace skia_private;
@@ -63,8 +64,10 @@ public:
             }
 
             *result = v->fImage;
+            fHits++;
             return true;
         }
+        fMisses++;
         return false;
     }
 
@@ -74,24 +77,23 @@ public:
         if (Value* v = fLookup.find(key)) {
             this->removeInternal(v);
         }
+        const size_t bytes = result.image() ? result.image()->getSize() : 0;
+        if (bytes > fMaxBytes) {
+            return;
+        }
         Value* v = new Value(key, result, filter);
         fLookup.add(v);
         fLRU.addToHead(v);
-        fCurrentBytes += result.image() ? result.image()->getSize() : 0;
-        if (auto* values = fImageFilterValues.find(filter)) {
-            values->push_back(v);
-        } else {
-            fImageFilterValues.set(filter, {v});
-        }
-
-        while (fCurrentBytes > fMaxBytes) {
-            Value* tail = fLRU.tail();
-            SkASSERT(tail);
-            if (tail == v) {
-                break;
+        fCurrentBytes += bytes;
+        if (filter) {
+            if (auto* values = fImageFilterValues.find(filter)) {
+                values->push_back(v);
+            } else {
+                fImageFilterValues.set(filter, {v});
             }
-            this->removeInternal(tail);
         }
+
+        this->purgeToLimit();
     }
 
     void purge() override {
@@ -119,7 +121,42 @@ public:
     }
 
     SkDEBUGCODE(int count() const override { return fLookup.count(); })
+
+    void setContentKeyed(bool contentKeyed) override {
+        fContentKeyed.store(contentKeyed, std::memory_order_relaxed);
+    }
+    bool contentKeyed() const override {
+        return fContentKeyed.load(std::memory_order_relaxed);
+    }
+
+    size_t setByteLimit(size_t maxBytes) override {
+        SkAutoMutexExclusive mutex(fMutex);
+        const size_t oldMaxBytes = fMaxBytes;
+        fMaxBytes = maxBytes;
+        this->purgeToLimit();
+        return oldMaxBytes;
+    }
+
+    Stats stats() const override {
+        SkAutoMutexExclusive mutex(fMutex);
+        Stats stats;
+        stats.fBytesUsed = fCurrentBytes;
+        stats.fByteLimit = fMaxBytes;
+        stats.fEntryCount = fLookup.count();
+        stats.fHits = fHits;
+        stats.fMisses = fMisses;
+        return stats;
+    }
+
 private:
+    void purgeToLimit() {
+        while (fCurrentBytes > fMaxBytes) {
+            Value* tail = fLRU.tail();
+            SkASSERT(tail);
+            this->removeInternal(tail);
+        }
+    }
+
     void removeInternal(Value* v) {
         if (v->fFilter) {
             if (auto* values = fImageFilterValues.find(v->fFilter)) {
@@ -147,6 +184,9 @@ private:
     THashMap<const SkImageFilter*, std::vector<Value*>> fImageFilterValues;
     size_t                                              fMaxBytes;
     size_t                                              fCurrentBytes;
+    mutable uint64_t                                    fHits = 0;
+    mutable uint64_t                                    fMisses = 0;
+    std::atomic<bool>                                   fContentKeyed{false};
     mutable SkMutex                                     fMutex;
 };
 
@@ -52,8 +52,9 @@ struct SkImageFilterCacheKey {
 };
 
 // This cache maps from (filter's unique ID + CTM + clipBounds + src bitmap generation ID) to result
-// NOTE: this is the _specific_ unique ID of the image filter, so refiltering the same image with a
-// copy of the image filter (with exactly the same parameters) will not yield a cache hit.
+// NOTE: by default this is the _specific_ unique ID of the image filter, so refiltering the same
+// image with a copy of the image filter (with exactly the same parameters) will not yield a cache
+// hit. A content-keyed cache uses the filter's content ID instead (see setContentKeyed()).
 class SkImageFilterCache : public SkRefCnt {
 public:
     static constexpr size_t kDefaultTransientSize = 32 * 1024 * 1024;
@@ -76,6 +77,25 @@ public:
     virtual void purge() = 0;
     virtual void purgeByImageFilter(const SkImageFilter*) = 0;
     SkDEBUGCODE(virtual int count() const = 0;)
+
+    // When true, SkImageFilter_Base::filterImage() keys results by the filter's contentID() rather
+    // than its uniqueID(), and stores them with a null filter so they outlive it. Recreated but
+    // identical filters then hit the cache across frames, as long as their source is the same.
+    virtual void setContentKeyed(bool) = 0;
+    virtual bool contentKeyed() const = 0;
+
+    // Sets the byte budget, purging least recently used results until the cache fits. The budget
+    // is strict: a result larger than the whole budget is not cached. Returns the old budget.
+    virtual size_t setByteLimit(size_t) = 0;
+
+    struct Stats {
+        size_t   fBytesUsed = 0;
+        size_t   fByteLimit = 0;
+        int      fEntryCount = 0;
+        uint64_t fHits = 0;    // get() calls that found a result
+        uint64_t fMisses = 0;  // get() calls that did not
+    };
+    virtual Stats stats() const = 0;
 };
 
 #endif
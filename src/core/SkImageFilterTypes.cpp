@@ -35,10 +35,12 @@
 #include "src/core/SkKnownRuntimeEffects.h"
 #include "src/core/SkMatrixPriv.h"
 #include "src/core/SkRectPriv.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/core/SkTraceEvent.h"
 #include "src/effects/colorfilters/SkColorFilterBase.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 
 namespace skif {
@@ -178,8 +180,11 @@ std::optional<LayerSpace<SkMatrix>> periodic_axis_transform(
 class RasterBackend : public Backend {
 public:
 
-    RasterBackend(const SkSurfaceProps& surfaceProps, SkColorType colorType)
-            : Backend(SkImageFilterCache::Get(), surfaceProps, colorType) {}
+    RasterBackend(const SkSurfaceProps& surfaceProps,
+                  SkColorType colorType,
+                  SkExecutor* executor,
+                  int tileSize)
+            : Backend(SkImageFilterCache::Get(), surfaceProps, colorType, executor, tileSize) {}
 
     sk_sp<SkDevice> makeDevice(SkISize size,
                                sk_sp<SkColorSpace> colorSpace,
@@ -202,16 +207,23 @@ public:
     const SkBlurEngine* getBlurEngine() const override { return nullptr; }
 };
 
+std::atomic<SkExecutor*> gRasterBackendExecutor{nullptr};
+std::atomic<int>         gRasterBackendTileSize{0};
+
 } // anonymous namespace
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
 Backend::Backend(sk_sp<SkImageFilterCache> cache,
                  const SkSurfaceProps& surfaceProps,
-                 const SkColorType colorType)
+                 const SkColorType colorType,
+                 SkExecutor* executor,
+                 int tileSize)
         : fCache(std::move(cache))
         , fSurfaceProps(surfaceProps)
-        , fColorType(colorType) {}
+        , fColorType(colorType)
+        , fExecutor(executor)
+        , fTileSize(tileSize) {}
 
 Backend::~Backend() = default;
 
@@ -221,7 +233,80 @@ sk_sp<Backend> MakeRasterBackend(const SkSurfaceProps& surfaceProps, SkColorType
     // all color types, like the GPU backends.
     colorType = kN32_SkColorType;
 
-    return sk_make_sp<RasterBackend>(surfaceProps, colorType);
+    return sk_make_sp<RasterBackend>(surfaceProps, colorType,
+                                     gRasterBackendExecutor.load(),
+                                     gRasterBackendTileSize.load());
+}
+
+void SetRasterBackendExecutor(SkExecutor* executor) {
+    gRasterBackendExecutor.store(executor);
+}
+
+void SetRasterBackendTileSize(int tileSize) {
+    gRasterBackendTileSize.store(std::max(tileSize, 0));
+}
+
+bool EvaluateTiled(const Context& ctx,
+                   const std::function<FilterResult(const Context&)>& filter,
+                   const std::function<void(const Context&, const FilterResult&)>& drawTile) {
+    static constexpr int kMaxConcurrentTiles = 4;
+
+    const int tileSize = ctx.backend()->tileSize();
+    const LayerSpace<SkIRect>& output = ctx.desiredOutput();
+    if (tileSize <= 0 || output.isEmpty() ||
+        (output.width() <= tileSize && output.height() <= tileSize)) {
+        return false;
+    }
+
+    const int columns = (output.width() + tileSize - 1) / tileSize;
+    const int tileCount = columns * ((output.height() + tileSize - 1) / tileSize);
+    auto tileContext = [&](int tile) {
+        const int left = output.left() + (tile % columns) * tileSize;
+        const int top  = output.top()  + (tile / columns) * tileSize;
+        return ctx.withNewDesiredOutput(LayerSpace<SkIRect>(
+                SkIRect::MakeLTRB(left, top, std::min(left + tileSize, output.right()),
+                                             std::min(top + tileSize, output.bottom()))));
+    };
+
+    SkExecutor* executor = ctx.backend()->executor();
+    if (!executor) {
+        for (int tile = 0; tile < tileCount; ++tile) {
+            const Context tileCtx = tileContext(tile);
+            drawTile(tileCtx, filter(tileCtx));
+        }
+        return true;
+    }
+
+    // As in SkImageFilter_Base::getChildOutputs(), each concurrent tile records its own stats.
+    FilterResult results[kMaxConcurrentTiles];
+    Stats stats[kMaxConcurrentTiles];
+    for (int first = 0; first < tileCount; first += kMaxConcurrentTiles) {
+        const int count = std::min(kMaxConcurrentTiles, tileCount - first);
+        SkTaskGroup tasks(*executor);
+        for (int i = 1; i < count; ++i) {
+            tasks.add([&, i] {
+                results[i] = filter(tileContext(first + i).withNewStats(&stats[i]));
+            });
+        }
+        results[0] = filter(tileContext(first).withNewStats(&stats[0]));
+        tasks.wait();
+
+        for (int i = 0; i < count; ++i) {
+            ctx.addStats(stats[i]);
+            stats[i] = {};
+            drawTile(tileContext(first + i), results[i]);
+            results[i] = {};
+        }
+    }
+    return true;
+}
+
+void Stats::add(const Stats& other) {
+    fNumVisitedImageFilters    += other.fNumVisitedImageFilters;
+    fNumCacheHits              += other.fNumCacheHits;
+    fNumOffscreenSurfaces      += other.fNumOffscreenSurfaces;
+    fNumShaderClampedDraws     += other.fNumShaderClampedDraws;
+    fNumShaderBasedTilingDraws += other.fNumShaderBasedTilingDraws;
 }
 
 void Stats::dumpStats() const {
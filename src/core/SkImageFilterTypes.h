@@ -29,6 +29,7 @@
 #include "src/core/SkSpecialImage.h"
 
 #include <cstdint>
+#include <functional>
 #include <optional>
 #include <utility>
 
@@ -37,6 +38,7 @@ class SkBitmap;
 class SkBlender;
 class SkBlurEngine;
 class SkDevice;
+class SkExecutor;
 class SkImage;
 class SkImageFilter;
 class SkImageFilterCache;
@@ -1108,19 +1110,39 @@ public:
 
     SkImageFilterCache* cache() const { return fCache.get(); }
 
+    // When non-null, independent inputs of a filter may be evaluated concurrently on this
+    // executor (see SkImageFilter_Base::getChildOutputs()). Only backends whose devices and images
+    // can be used from any thread should provide one.
+    SkExecutor* executor() const { return fExecutor; }
+
+    // When positive, the largest width and height of a tile when a filter DAG is evaluated in
+    // tiles to bound the size of its intermediate images (see EvaluateTiled()).
+    int tileSize() const { return fTileSize; }
+
 protected:
     Backend(sk_sp<SkImageFilterCache> cache,
             const SkSurfaceProps& surfaceProps,
-            const SkColorType colorType);
+            const SkColorType colorType,
+            SkExecutor* executor = nullptr,
+            int tileSize = 0);
 
 private:
     sk_sp<SkImageFilterCache> fCache;
     SkSurfaceProps fSurfaceProps;
     SkColorType fColorType;
+    SkExecutor* fExecutor;
+    int fTileSize;
 };
 
 sk_sp<Backend> MakeRasterBackend(const SkSurfaceProps& surfaceProps, SkColorType colorType);
 
+// Sets the executor given to raster backends made after this call, or turns concurrent input
+// evaluation off with nullptr. The executor must outlive any filtering that may use it.
+void SetRasterBackendExecutor(SkExecutor*);
+
+// Sets the tile size given to raster backends made after this call, or turns tiling off with 0.
+void SetRasterBackendTileSize(int tileSize);
+
 // Stats for a single image filter evaluation
 struct Stats {
     int fNumVisitedImageFilters = 0; // size of the filter dag
@@ -1129,6 +1151,7 @@ struct Stats {
     int fNumShaderClampedDraws = 0; // shader-emulated clamp is fairly cheap but HW tiling is best
     int fNumShaderBasedTilingDraws = 0; // shader-emulated decal, mirror, repeat are expensive
 
+    void add(const Stats& other);  // accumulate the stats of a concurrently evaluated input
     void dumpStats() const;   // log to std out
     void reportStats() const; // trace event counters
 };
@@ -1210,6 +1233,20 @@ public:
         return c;
     }
 
+    // Create a new context that matches this context, but records into 'stats' instead (or into
+    // nothing if this context has no stats). Used for inputs evaluated on other threads, whose
+    // stats are then combined with addStats() once they are done.
+    Context withNewStats(Stats* stats) const {
+        Context c = *this;
+        c.fStats = fStats ? stats : nullptr;
+        return c;
+    }
+    void addStats(const Stats& stats) const {
+        if (fStats) {
+            fStats->add(stats);
+        }
+    }
+
 
     // Stats tracking
     void markVisitedImageFilter() const {
@@ -1253,6 +1290,19 @@ private:
     Stats* fStats;
 };
 
+// Evaluates a filter DAG over ctx.desiredOutput() in tiles of at most the backend's tileSize(), so
+// each node only produces the part of its output that a tile needs, plus its own outsets, instead
+// of an image covering the whole output. 'filter' is called with a context whose desired output
+// is one tile, and 'drawTile' is then called with that context and the tile's result, always on
+// the calling thread and in row-major order. With an executor, a few tiles are filtered at once;
+// the rest wait so that only those tiles' intermediates are alive together.
+//
+// Returns false, without calling either function, if the backend does not tile or the desired
+// output fits in a single tile.
+bool EvaluateTiled(const Context& ctx,
+                   const std::function<FilterResult(const Context&)>& filter,
+                   const std::function<void(const Context&, const FilterResult&)>& drawTile);
+
 } // end namespace skif
 
 #endif // SkImageFilterTypes_DEFINED
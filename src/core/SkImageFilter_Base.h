@@ -16,6 +16,7 @@
 
 #include "src/core/SkImageFilterTypes.h"
 
+#include <atomic>
 #include <optional>
 
 // True base class that all SkImageFilter implementations need to extend from. This provides the
@@ -129,6 +130,13 @@ public:
 
     uint32_t uniqueID() const { return fUniqueID; }
 
+    // Returns an ID shared by every filter whose graph flattens to the same bytes, with images,
+    // pictures and typefaces written as their unique IDs. A filter that is recreated with the same
+    // parameters and inputs gets the same content ID, so results cached under it (see
+    // SkImageFilterCache::setContentKeyed()) can be reused. Falls back to uniqueID() if the
+    // filter can't be flattened. Never equal to another filter's unique ID.
+    uint32_t contentID() const;
+
     static SkFlattenable::Type GetFlattenableType() {
         return kSkImageFilter_Type;
     }
@@ -199,6 +207,11 @@ protected:
     // `withNewDesiredOutput`.
     skif::FilterResult getChildOutput(int index, const skif::Context& ctx) const;
 
+    // Evaluates every input into 'outputs' as getChildOutput() would, all with the same context.
+    // When the context's backend has an executor and at least two inputs are non-null filters,
+    // the inputs are evaluated concurrently, with the first on the calling thread.
+    void getChildOutputs(const skif::Context& ctx, SkSpan<skif::FilterResult> outputs) const;
+
 private:
     friend class SkImageFilter;
     // For PurgeCache()
@@ -303,6 +316,7 @@ private:
 
     bool fUsesSrcInput;
     uint32_t fUniqueID; // Globally unique
+    mutable std::atomic<uint32_t> fContentID{0}; // Computed on first use by contentID()
 
     using INHERITED = SkImageFilter;
 };
@@ -23,6 +23,10 @@ private:
         : fKey(key)
         , fValue(std::move(value)) {}
 
+        Entry(K&& key, V&& value)
+        : fKey(std::move(key))
+        , fValue(std::move(value)) {}
+
         K fKey;
         V fValue;
 
@@ -61,14 +65,13 @@ public:
 
     V* insert(const K& key, V value) {
         SkASSERT(!this->find(key));
+        return this->insertEntry(new Entry(key, std::move(value)));
+    }
 
-        Entry* entry = new Entry(key, std::move(value));
-        fMap.set(entry);
-        fLRU.addToHead(entry);
-        while (fMap.count() > fMaxCount) {
-            this->remove(fLRU.tail()->fKey);
-        }
-        return &entry->fValue;
+    // For keys that can be moved but not copied.
+    V* insert(K&& key, V value) {
+        SkASSERT(!this->find(key));
+        return this->insertEntry(new Entry(std::move(key), std::move(value)));
     }
 
     V* insert_or_update(const K& key, V value) {
@@ -80,10 +83,35 @@ public:
         }
     }
 
+    // Removes the least recently used entry, first moving its value into |value| if that is not
+    // null. Returns false if the cache is empty.
+    bool removeLeastRecentlyUsed(V* value = nullptr) {
+        Entry* entry = fLRU.tail();
+        if (!entry) {
+            return false;
+        }
+        if (value) {
+            *value = std::move(entry->fValue);
+        }
+        this->remove(entry->fKey);
+        return true;
+    }
+
     int count() const {
         return fMap.count();
     }
 
+    int maxCount() const {
+        return fMaxCount;
+    }
+
+    void setMaxCount(int maxCount) {
+        fMaxCount = maxCount;
+        while (fMap.count() > fMaxCount) {
+            this->remove(fLRU.tail()->fKey);
+        }
+    }
+
     template <typename Fn>  // f(K*, V*)
     void foreach(Fn&& fn) {
         typename SkTInternalLList<Entry>::Iter iter;
@@ -112,6 +140,15 @@ private:
         }
     };
 
+    V* insertEntry(Entry* entry) {
+        fMap.set(entry);
+        fLRU.addToHead(entry);
+        while (fMap.count() > fMaxCount) {
+            this->remove(fLRU.tail()->fKey);
+        }
+        return &entry->fValue;
+    }
+
     void remove(const K& key) {
         Entry** value = fMap.find(key);
         SkASSERT(value);
@@ -0,0 +1,170 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/core/SkLayerPixelPool.h"
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkPixelRef.h"
+#include "include/core/SkRefCnt.h"
+#include "include/private/base/SkAssert.h"
+#include "include/private/base/SkMalloc.h"
+#include "src/base/SkMathPriv.h"
+
+#include <algorithm>
+
+// Smaller layers are rounded up to this, so tiny layers of different sizes share blocks.
+static constexpr size_t kMinSizeClass = 4096;
+// Layers bigger than this are rare enough that pooling them isn't worth the memory.
+static constexpr size_t kMaxSizeClass = 1u << 30;
+
+SkLayerPixelPool* SkLayerPixelPool::Global() {
+    static SkLayerPixelPool* pool = new SkLayerPixelPool(0);
+    return pool;
+}
+
+SkLayerPixelPool::SkLayerPixelPool(size_t byteLimit) : fByteLimit(byteLimit) {}
+
+size_t SkLayerPixelPool::SizeClass(size_t bytes) {
+    SkASSERT(bytes <= kMaxSizeClass);
+    if (bytes <= kMinSizeClass) {
+        return kMinSizeClass;
+    }
+    // Round up to a multiple of a quarter of the power of two below 'bytes'.
+    const size_t n = bytes - 1;
+    const int shift = SkPrevLog2(static_cast<uint32_t>(n)) - 2;
+    return ((n >> shift) + 1) << shift;
+}
+
+// Gives its memory back to the pool when the layer (and anything sharing its pixels) is done.
+class SkLayerPixelPool::PooledPixelRef final : public SkPixelRef {
+public:
+    PooledPixelRef(SkLayerPixelPool* pool, const SkImageInfo& info, size_t rowBytes,
+                   size_t sizeClass, Block block)
+            : SkPixelRef(info.width(), info.height(), block.fAddr, rowBytes)
+            , fPool(pool)
+            , fSizeClass(sizeClass)
+            , fDirtyBytes(std::max(block.fDirtyBytes, info.computeByteSize(rowBytes))) {}
+
+    ~PooledPixelRef() override {
+        fPool->release(fSizeClass, {this->pixels(), fDirtyBytes});
+    }
+
+private:
+    SkLayerPixelPool* fPool;
+    size_t fSizeClass;
+    size_t fDirtyBytes;
+};
+
+bool SkLayerPixelPool::allocPixels(const SkImageInfo& info, SkBitmap* bitmap) {
+    const size_t rowBytes = info.minRowBytes();
+    const size_t bytes = info.computeByteSize(rowBytes);
+    if (info.isEmpty() || SkImageInfo::ByteSizeOverflowed(bytes) || bytes > kMaxSizeClass) {
+        return false;
+    }
+    const size_t sizeClass = SizeClass(bytes);
+
+    Block block = {nullptr, 0};
+    {
+        SkAutoMutexExclusive lock(fMutex);
+        if (sizeClass > fByteLimit) {
+            return false;
+        }
+        skia_private::TArray<Block>* blocks = fFree.find(sizeClass);
+        if (blocks && !blocks->empty()) {
+            block = blocks->back();
+            blocks->pop_back();
+            fStats.fBytesPooled -= sizeClass;
+            fStats.fReuses++;
+        } else {
+            fStats.fAllocations++;
+        }
+        fStats.fBytesInUse += sizeClass;
+        fStats.fPeakBytesInUse = std::max(fStats.fPeakBytesInUse, fStats.fBytesInUse);
+    }
+
+    if (block.fAddr) {
+        // Only what earlier layers may have drawn to needs clearing.
+        sk_bzero(block.fAddr, std::min(block.fDirtyBytes, bytes));
+    } else {
+        block.fAddr = sk_calloc_canfail(sizeClass);
+        if (!block.fAddr) {
+            SkAutoMutexExclusive lock(fMutex);
+            fStats.fBytesInUse -= sizeClass;
+            fStats.fAllocations--;
+            return false;
+        }
+    }
+
+    if (!bitmap->setInfo(info, rowBytes)) {
+        this->release(sizeClass, block);
+        return false;
+    }
+    bitmap->setPixelRef(sk_make_sp<PooledPixelRef>(this, info, rowBytes, sizeClass, block), 0, 0);
+    return true;
+}
+
+void SkLayerPixelPool::release(size_t sizeClass, Block block) {
+    {
+        SkAutoMutexExclusive lock(fMutex);
+        fStats.fBytesInUse -= sizeClass;
+        if (fStats.fBytesPooled + sizeClass <= fByteLimit) {
+            fFree[sizeClass].push_back(block);
+            fStats.fBytesPooled += sizeClass;
+            return;
+        }
+    }
+    sk_free(block.fAddr);
+}
+
+SkLayerPixelPool::Stats SkLayerPixelPool::stats() {
+    SkAutoMutexExclusive lock(fMutex);
+    return fStats;
+}
+
+size_t SkLayerPixelPool::getByteLimit() {
+    SkAutoMutexExclusive lock(fMutex);
+    return fByteLimit;
+}
+
+size_t SkLayerPixelPool::setByteLimit(size_t bytes) {
+    SkAutoMutexExclusive lock(fMutex);
+    const size_t prevLimit = fByteLimit;
+    fByteLimit = bytes;
+    this->purgeAsNeeded();
+    return prevLimit;
+}
+
+void SkLayerPixelPool::purgeAll() {
+    SkAutoMutexExclusive lock(fMutex);
+    fFree.foreach([](size_t, skia_private::TArray<Block>* blocks) {
+        for (const Block& block : *blocks) {
+            sk_free(block.fAddr);
+        }
+    });
+    fFree.reset();
+    fStats.fBytesPooled = 0;
+    fStats.fPeakBytesInUse = fStats.fBytesInUse;
+}
+
+void SkLayerPixelPool::purgeAsNeeded() {
+    // Free the largest blocks first, since they are the least likely to be reused.
+    while (fStats.fBytesPooled > fByteLimit) {
+        skia_private::TArray<Block>* largest = nullptr;
+        size_t largestClass = 0;
+        fFree.foreach([&](size_t sizeClass, skia_private::TArray<Block>* blocks) {
+            if (!blocks->empty() && sizeClass > largestClass) {
+                largest = blocks;
+                largestClass = sizeClass;
+            }
+        });
+        SkASSERT(largest);
+        sk_free(largest->back().fAddr);
+        largest->pop_back();
+        fStats.fBytesPooled -= largestClass;
+    }
+}
@@ -0,0 +1,77 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkLayerPixelPool_DEFINED
+#define SkLayerPixelPool_DEFINED
+
+#include "include/private/base/SkMutex.h"
+#include "include/private/base/SkTArray.h"
+#include "include/private/base/SkThreadAnnotations.h"
+#include "src/core/SkTHash.h"
+
+#include <cstddef>
+#include <cstdint>
+
+class SkBitmap;
+struct SkImageInfo;
+
+/**
+ *  The process-wide pool of pixel memory behind raster saveLayer()s. Layers are allocated in size
+ *  classes (four per power of two, so at most 25% is wasted), and their memory goes back to the
+ *  pool when the layer's pixel ref is destroyed, on whichever thread that happens. A block only
+ *  needs to be cleared as far as it was used by earlier layers: memory past that is still zero
+ *  from its first allocation.
+ *
+ *  The pool is off (its byte limit is 0) by default. Blocks that would take the free memory past
+ *  the limit are freed instead of pooled.
+ */
+class SkLayerPixelPool {
+public:
+    static SkLayerPixelPool* Global();
+
+    explicit SkLayerPixelPool(size_t byteLimit);
+
+    // Sets up the bitmap with zeroed, pooled pixels for this info and its min row bytes. Returns
+    // false if the pool is off or the memory could not be allocated; the bitmap is left untouched.
+    bool allocPixels(const SkImageInfo&, SkBitmap*);
+
+    // The memory is rounded up to the returned size. Exposed for testing.
+    static size_t SizeClass(size_t bytes);
+
+    struct Stats {
+        size_t   fBytesPooled = 0;      // free memory kept for later layers
+        size_t   fBytesInUse = 0;       // memory held by live layers
+        size_t   fPeakBytesInUse = 0;   // the most fBytesInUse has been since the last purge
+        uint64_t fReuses = 0;           // layers given pooled memory
+        uint64_t fAllocations = 0;      // layers given new memory
+    };
+    Stats stats();
+
+    size_t getByteLimit();
+    size_t setByteLimit(size_t bytes);
+
+    // Frees all pooled memory and resets the peak to the memory currently in use.
+    void purgeAll();
+
+private:
+    struct Block {
+        void*  fAddr;
+        size_t fDirtyBytes;  // bytes from fAddr that may be non-zero
+    };
+
+    class PooledPixelRef;
+
+    void release(size_t sizeClass, Block) SK_EXCLUDES(fMutex);
+    void purgeAsNeeded() SK_REQUIRES(fMutex);
+
+    SkMutex fMutex;
+    skia_private::THashMap<size_t, skia_private::TArray<Block>> fFree SK_GUARDED_BY(fMutex);
+    size_t fByteLimit SK_GUARDED_BY(fMutex);
+    Stats  fStats SK_GUARDED_BY(fMutex);
+};
+
+#endif  // SkLayerPixelPool_DEFINED
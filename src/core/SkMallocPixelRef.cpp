@@ -10,9 +10,11 @@
 #include "include/core/SkAlphaType.h"
 #include "include/core/SkColorType.h"
 #include "include/core/SkData.h"
+#include "include/core/SkGraphics.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkPixelRef.h"
 #include "include/private/base/SkMalloc.h"
+#include "src/core/SkPixelAllocator.h"
 
 #include <utility>
 
@@ -44,6 +46,24 @@ sk_sp<SkPixelRef> SkMallocPixelRef::MakeAllocate(const SkImageInfo& info, size_t
         return nullptr;
     }
 #endif
+    const SkGraphics::RasterPixelAllocator allocator = SkPixelAllocator::Get(size);
+    if (allocator.fAlloc) {
+        if (void* addr = allocator.fAlloc(size, allocator.fCtx)) {
+            struct PixelRef final : public SkPixelRef {
+                PixelRef(int w, int h, void* s, size_t r,
+                         const SkGraphics::RasterPixelAllocator& a, size_t size)
+                    : SkPixelRef(w, h, s, r), fAllocator(a), fSize(size) {}
+                ~PixelRef() override {
+                    fAllocator.fFree(this->pixels(), fSize, fAllocator.fCtx);
+                }
+                SkGraphics::RasterPixelAllocator fAllocator;
+                size_t fSize;
+            };
+            return sk_sp<SkPixelRef>(
+                    new PixelRef(info.width(), info.height(), addr, rowBytes, allocator, size));
+        }
+    }
+
     void* addr = sk_calloc_canfail(size);
     if (nullptr == addr) {
         return nullptr;
@@ -20,6 +20,7 @@
 #include "include/private/base/SkTo.h"
 #include "src/base/SkFloatBits.h"
 #include "src/base/SkVx.h"
+#include "src/core/SkMatrixBatch.h"
 #include "src/core/SkMatrixPriv.h"
 #include "src/core/SkMatrixUtils.h"
 #include "src/core/SkSamplingPriv.h"
@@ -958,54 +959,21 @@ void SkMatrix::Persp_pts(const SkMatrix& m, SkPoint dst[],
     SkASSERT(m.hasPerspective());
 
     if (count > 0) {
-        do {
-            SkScalar sy = src->fY;
-            SkScalar sx = src->fX;
-            src += 1;
-
-            SkScalar x = sdot(sx, m.fMat[kMScaleX], sy, m.fMat[kMSkewX])  + m.fMat[kMTransX];
-            SkScalar y = sdot(sx, m.fMat[kMSkewY],  sy, m.fMat[kMScaleY]) + m.fMat[kMTransY];
-            SkScalar z = sdot(sx, m.fMat[kMPersp0], sy, m.fMat[kMPersp1]) + m.fMat[kMPersp2];
-            if (z) {
-                z = 1 / z;
-            }
-
-            dst->fY = y * z;
-            dst->fX = x * z;
-            dst += 1;
-        } while (--count);
+        SkOpts::map_points_persp(m.fMat, src, count, dst);
     }
 }
 
 void SkMatrix::Affine_vpts(const SkMatrix& m, SkPoint dst[], const SkPoint src[], int count) {
     SkASSERT(m.getType() != SkMatrix::kPerspective_Mask);
     if (count > 0) {
-        SkScalar tx = m.getTranslateX();
-        SkScalar ty = m.getTranslateY();
-        SkScalar sx = m.getScaleX();
-        SkScalar sy = m.getScaleY();
-        SkScalar kx = m.getSkewX();
-        SkScalar ky = m.getSkewY();
-        skvx::float4 trans4(tx, ty, tx, ty);
-        skvx::float4 scale4(sx, sy, sx, sy);
-        skvx::float4  skew4(kx, ky, kx, ky);    // applied to swizzle of src4
-        bool trailingElement = (count & 1);
-        count >>= 1;
-        skvx::float4 src4;
-        for (int i = 0; i < count; ++i) {
-            src4 = skvx::float4::Load(src);
-            skvx::float4 swz4 = skvx::shuffle<1,0,3,2>(src4);  // y0 x0, y1 x1
-            (src4 * scale4 + swz4 * skew4 + trans4).store(dst);
-            src += 2;
-            dst += 2;
-        }
-        if (trailingElement) {
-            // We use the same logic here to ensure that the math stays consistent throughout, even
-            // though the high float2 is ignored.
-            src4.lo = skvx::float2::Load(src);
-            skvx::float4 swz4 = skvx::shuffle<1,0,3,2>(src4);  // y0 x0, y1 x1
-            (src4 * scale4 + swz4 * skew4 + trans4).lo.store(dst);
-        }
+        float affine[6];
+        affine[kAScaleX] = m.getScaleX();
+        affine[kASkewY]  = m.getSkewY();
+        affine[kASkewX]  = m.getSkewX();
+        affine[kAScaleY] = m.getScaleY();
+        affine[kATransX] = m.getTranslateX();
+        affine[kATransY] = m.getTranslateY();
+        SkOpts::map_points_affine(affine, src, count, dst);
     }
 }
 
@@ -1074,13 +1042,7 @@ void SkMatrix::mapHomogeneousPoints(SkPoint3 dst[], const SkPoint src[], int cou
             dst[i] = { src[i].fX, src[i].fY, 1 };
         }
     } else if (this->hasPerspective()) {
-        for (int i = 0; i < count; ++i) {
-            dst[i] = {
-                fMat[0] * src[i].fX + fMat[1] * src[i].fY + fMat[2],
-                fMat[3] * src[i].fX + fMat[4] * src[i].fY + fMat[5],
-                fMat[6] * src[i].fX + fMat[7] * src[i].fY + fMat[8],
-            };
-        }
+        SkOpts::map_points_homogeneous(fMat, src, count, dst);
     } else {    // affine
         for (int i = 0; i < count; ++i) {
             dst[i] = {
@@ -1116,6 +1078,22 @@ void SkMatrix::mapVectors(SkPoint dst[], const SkPoint src[], int count) const {
     }
 }
 
+void SkMatrixPriv::MapRects(const SkMatrix& mx, SkRect dst[], const SkRect src[], int count) {
+    if (mx.isScaleTranslate()) {
+        for (int i = 0; i < count; ++i) {
+            mx.mapRectScaleTranslate(&dst[i], src[i]);
+        }
+    } else if (mx.hasPerspective()) {
+        for (int i = 0; i < count; ++i) {
+            mx.mapRect(&dst[i], src[i]);
+        }
+    } else {
+        float affine[6];
+        SkAssertResult(mx.asAffine(affine));
+        SkOpts::map_rects_affine(affine, src, count, dst);
+    }
+}
+
 static skvx::float4 sort_as_rect(const skvx::float4& ltrb) {
     skvx::float4 rblt(ltrb[2], ltrb[3], ltrb[0], ltrb[1]);
     auto min = skvx::min(ltrb, rblt);
@@ -0,0 +1,40 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkMatrixBatch_DEFINED
+#define SkMatrixBatch_DEFINED
+
+#include "include/core/SkPoint.h"
+#include "include/core/SkPoint3.h"
+#include "include/core/SkRect.h"
+
+// Kernels that map many points or rects through one matrix. They back SkMatrix::mapPoints(),
+// SkMatrix::mapHomogeneousPoints() and SkMatrixPriv::MapRects(). Except in
+// map_points_homogeneous(), dst may be the same array as src.
+namespace SkOpts {
+    // Maps count points through the affine matrix given as by SkMatrix::asAffine().
+    extern void (*map_points_affine)(const float affine[6], const SkPoint src[], int count,
+                                     SkPoint dst[]);
+
+    // Maps count points through the matrix given as by SkMatrix::get9(), dividing by the
+    // resulting w. Points with w == 0 map to (0, 0), as in SkMatrix::mapPoints().
+    extern void (*map_points_persp)(const float mat[9], const SkPoint src[], int count,
+                                    SkPoint dst[]);
+
+    // Maps count points through the matrix given as by SkMatrix::get9(), without the divide.
+    extern void (*map_points_homogeneous)(const float mat[9], const SkPoint src[], int count,
+                                          SkPoint3 dst[]);
+
+    // Writes the bounds of each of count rects mapped through the affine matrix given as by
+    // SkMatrix::asAffine(). Non-finite input gives non-finite output.
+    extern void (*map_rects_affine)(const float affine[6], const SkRect src[], int count,
+                                    SkRect dst[]);
+
+    void Init_MatrixBatch();
+}  // namespace SkOpts
+
+#endif
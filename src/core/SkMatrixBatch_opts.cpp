@@ -0,0 +1,47 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/private/base/SkFeatures.h"
+#include "src/core/SkCpu.h"
+#include "src/core/SkMatrixBatch.h"
+#include "src/core/SkOptsTargets.h"
+
+#define SK_OPTS_TARGET SK_OPTS_TARGET_DEFAULT
+#include "src/opts/SkOpts_SetTarget.h"
+
+#include "src/opts/SkMatrixBatch_opts.h"  // IWYU pragma: keep
+
+#include "src/opts/SkOpts_RestoreTarget.h"
+
+namespace SkOpts {
+    DEFINE_DEFAULT(map_points_affine);
+    DEFINE_DEFAULT(map_points_persp);
+    DEFINE_DEFAULT(map_points_homogeneous);
+    DEFINE_DEFAULT(map_rects_affine);
+
+    void Init_MatrixBatch_hsw();
+    void Init_MatrixBatch_skx();  // In src/opts/SkOpts_skx.cpp, built with AVX-512 enabled.
+
+    static bool init() {
+    #if defined(SK_ENABLE_OPTIMIZE_SIZE)
+        // All Init_foo functions are omitted when optimizing for size
+    #elif defined(SK_CPU_X86)
+        #if SK_CPU_SSE_LEVEL < SK_CPU_SSE_LEVEL_AVX2
+            if (SkCpu::Supports(SkCpu::HSW)) { Init_MatrixBatch_hsw(); }
+        #endif
+
+        #if (SK_CPU_SSE_LEVEL < SK_CPU_SSE_LEVEL_SKX) && defined(SK_ENABLE_AVX512_OPTS)
+            if (SkCpu::Supports(SkCpu::SKX)) { Init_MatrixBatch_skx(); }
+        #endif
+    #endif
+      return true;
+    }
+
+    void Init_MatrixBatch() {
+      [[maybe_unused]] static bool gInitialized = init();
+    }
+}  // namespace SkOpts
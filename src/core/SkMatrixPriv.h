@@ -174,6 +174,11 @@ public:
     static void MapHomogeneousPointsWithStride(const SkMatrix& mx, SkPoint3 dst[], size_t dstStride,
                                                const SkPoint3 src[], size_t srcStride, int count);
 
+    /** Sets dst[i] to the bounds of src[i] mapped by mx, like mx.mapRect(&dst[i], src[i]), for
+        count rects. dst may be src.
+    */
+    static void MapRects(const SkMatrix& mx, SkRect dst[], const SkRect src[], int count);
+
     static bool PostIDiv(SkMatrix* matrix, int divx, int divy) {
         return matrix->postIDiv(divx, divy);
     }
@@ -9,11 +9,15 @@
 #include "include/core/SkBitmap.h"
 #include "include/core/SkColorSpace.h"
 #include "include/core/SkColorType.h"
+#include "include/core/SkRect.h"
 #include "include/core/SkTypes.h"
 #include "include/private/base/SkTo.h"
 #include "src/base/SkMathPriv.h"
 #include "src/core/SkImageInfoPriv.h"
 #include "src/core/SkMipmapBuilder.h"
+#include "src/core/SkTaskGroup.h"
+
+#include <algorithm>
 
 #include <new>
 
@@ -26,6 +30,47 @@
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+// Large levels are filtered in bands of dst rows on the default executor. Every level still
+// waits for the one above it, but the top few levels hold nearly all of the pixels.
+static void build_level(SkMipmapDownSampler* downsampler,
+                        const SkPixmap& dst, const SkPixmap& src) {
+    static constexpr int64_t kMinPixelsToBand = 256 * 256;
+    static constexpr int kMinBandRows = 32;
+    static constexpr int kMaxBands = 8;
+
+    const int rows = dst.height();
+    const int bands = !downsampler->canBuildBands() ||
+                      SkToS64(dst.width()) * rows < kMinPixelsToBand
+                              ? 1
+                              : std::clamp(rows / kMinBandRows, 1, kMaxBands);
+    if (bands == 1) {
+        downsampler->buildLevel(dst, src);
+        return;
+    }
+
+    // An odd src height is filtered with three vertical taps, so each band also reads the first
+    // src row of the band below it. That keeps every src band's height parity, and so its filter,
+    // the same as the whole level's.
+    const int extraRow = src.height() & 1;
+    auto buildBand = [&](int band) {
+        const int top = rows * band / bands, bottom = rows * (band + 1) / bands;
+        SkPixmap dstBand, srcBand;
+        SkAssertResult(dst.extractSubset(&dstBand,
+                                         SkIRect::MakeLTRB(0, top, dst.width(), bottom)));
+        SkAssertResult(src.extractSubset(&srcBand,
+                                         SkIRect::MakeLTRB(0, 2 * top,
+                                                           src.width(), 2 * bottom + extraRow)));
+        downsampler->buildLevel(dstBand, srcBand);
+    };
+
+    SkTaskGroup tasks;
+    for (int band = 1; band < bands; ++band) {
+        tasks.add([&buildBand, band] { buildBand(band); });
+    }
+    buildBand(0);
+    tasks.wait();
+}
+
 SkMipmap::SkMipmap(void* malloc, size_t size) : SkCachedData(malloc, size) {}
 SkMipmap::SkMipmap(size_t size, SkDiscardableMemory* dm) : SkCachedData(size, dm) {}
 
@@ -120,7 +165,7 @@ SkMipmap* SkMipmap::Build(const SkPixmap& src, SkDiscardableFactoryProc fact,
 
         const SkPixmap& dstPM = levels[i].fPixmap;
         if (downsampler) {
-            downsampler->buildLevel(dstPM, srcPM);
+            build_level(downsampler.get(), dstPM, srcPM);
         }
         srcPM = dstPM;
         addr += height * rowBytes;
@@ -27,6 +27,10 @@ struct SkMipmapDownSampler {
     virtual ~SkMipmapDownSampler() {}
 
     virtual void buildLevel(const SkPixmap& dst, const SkPixmap& src) = 0;
+
+    // Whether buildLevel() may run concurrently on bands of dst rows, each given the band of src
+    // rows that filters into it (plus the next src row when the src height is odd).
+    virtual bool canBuildBands() const { return false; }
 };
 
 /*
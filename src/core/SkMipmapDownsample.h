@@ -0,0 +1,24 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkMipmapDownsample_DEFINED
+#define SkMipmapDownsample_DEFINED
+
+#include <cstddef>
+
+namespace SkOpts {
+    // Filters one row of count 8888 mipmap pixels into dst from the source rows starting at src,
+    // srcRB bytes apart. The 2_2 kernel is a box over two rows of even-width source; the 3_3
+    // kernel is the 1-2-1 tent over three rows of odd-width source. Both match the scalar filters
+    // of SkMipmapHQDownSampler exactly.
+    extern void (*mipmap_downsample_2_2_8888)(void* dst, const void* src, size_t srcRB, int count);
+    extern void (*mipmap_downsample_3_3_8888)(void* dst, const void* src, size_t srcRB, int count);
+
+    void Init_MipmapDownsample();
+}  // namespace SkOpts
+
+#endif
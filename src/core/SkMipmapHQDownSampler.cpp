@@ -13,6 +13,7 @@
 #include "src/base/SkHalf.h"
 #include "src/base/SkVx.h"
 #include "src/core/SkMipmap.h"
+#include "src/core/SkMipmapDownsample.h"
 
 namespace {
 
@@ -388,6 +389,7 @@ struct HQDownSampler : SkMipmapDownSampler {
     FilterProc* proc_3_3 = nullptr;
 
     void buildLevel(const SkPixmap& dst, const SkPixmap& src) override;
+    bool canBuildBands() const override { return true; }
 };
 
 void HQDownSampler::buildLevel(const SkPixmap& dst, const SkPixmap& src) {
@@ -454,11 +456,11 @@ std::unique_ptr<SkMipmapDownSampler> SkMipmap::MakeDownSampler(const SkPixmap& r
             proc_1_2 = downsample_1_2<ColorTypeFilter_8888>;
             proc_1_3 = downsample_1_3<ColorTypeFilter_8888>;
             proc_2_1 = downsample_2_1<ColorTypeFilter_8888>;
-            proc_2_2 = downsample_2_2<ColorTypeFilter_8888>;
+            proc_2_2 = SkOpts::mipmap_downsample_2_2_8888;
             proc_2_3 = downsample_2_3<ColorTypeFilter_8888>;
             proc_3_1 = downsample_3_1<ColorTypeFilter_8888>;
             proc_3_2 = downsample_3_2<ColorTypeFilter_8888>;
-            proc_3_3 = downsample_3_3<ColorTypeFilter_8888>;
+            proc_3_3 = SkOpts::mipmap_downsample_3_3_8888;
             break;
         case kRGB_565_SkColorType:
             proc_1_2 = downsample_1_2<ColorTypeFilter_565>;
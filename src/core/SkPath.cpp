@@ -177,7 +177,7 @@ void SkPath::resetFields() {
 }
 
 SkPath::SkPath(const SkPath& that)
-    : fPathRef(SkRef(that.fPathRef.get())) {
+    : fPathRef(that.fPathRef->refOrCopy()) {
     this->copyFields(that);
     SkDEBUGCODE(that.validate();)
 }
@@ -190,7 +190,7 @@ SkPath& SkPath::operator=(const SkPath& that) {
     SkDEBUGCODE(that.validate();)
 
     if (this != &that) {
-        fPathRef.reset(SkRef(that.fPathRef.get()));
+        fPathRef = that.fPathRef->refOrCopy();
         this->copyFields(that);
     }
     SkDEBUGCODE(this->validate();)
@@ -37,6 +37,11 @@ SkPathBuilder::SkPathBuilder(const SkPath& src) {
     *this = src;
 }
 
+SkPathBuilder::SkPathBuilder(SkArenaAlloc* arena) : fArena(arena) {
+    SkASSERT(arena);
+    this->reset();
+}
+
 SkPathBuilder::~SkPathBuilder() {
 }
 
@@ -229,7 +234,14 @@ SkPath SkPathBuilder::make(sk_sp<SkPathRef> pr) const {
     return path;
 }
 
+sk_sp<SkPathRef> SkPathBuilder::makeArenaPathRef() const {
+    return SkPathRef::MakeInArena(fArena, fPts, fVerbs, fConicWeights, fSegmentMask);
+}
+
 SkPath SkPathBuilder::snapshot() const {
+    if (fArena) {
+        return this->make(this->makeArenaPathRef());
+    }
     return this->make(sk_sp<SkPathRef>(new SkPathRef(fPts,
                                                      fVerbs,
                                                      fConicWeights,
@@ -237,6 +249,12 @@ SkPath SkPathBuilder::snapshot() const {
 }
 
 SkPath SkPathBuilder::detach() {
+    if (fArena) {
+        // Copy rather than move, so the builder keeps its storage for the next path.
+        auto path = this->make(this->makeArenaPathRef());
+        this->reset();
+        return path;
+    }
     auto path = this->make(sk_sp<SkPathRef>(new SkPathRef(std::move(fPts),
                                                           std::move(fVerbs),
                                                           std::move(fConicWeights),
@@ -12,6 +12,7 @@
 #include "include/core/SkRRect.h"
 #include "include/private/base/SkFloatingPoint.h"
 #include "include/private/base/SkOnce.h"
+#include "src/base/SkArenaAlloc.h"
 #include "src/base/SkVx.h"
 
 #include <cstring>
@@ -64,6 +65,64 @@ size_t SkPathRef::approximateBytesUsed() const {
          + fConicWeights.capacity() * sizeof(fConicWeights[0]);
 }
 
+SkPathRef::SkPathRef(SkSpan<SkPoint> points, SkSpan<uint8_t> verbs, SkSpan<SkScalar> weights,
+                     unsigned segmentMask)
+        : fPoints(points, SkToInt(points.size()))
+        , fVerbs(verbs, SkToInt(verbs.size()))
+        , fConicWeights(weights, SkToInt(weights.size())) {
+    fBoundsIsDirty = true;    // this also invalidates fIsFinite
+    fGenerationID = 0;        // recompute
+    fSegmentMask = segmentMask;
+    fType = PathType::kGeneral;
+    // The next two values don't matter unless fType is kOval or kRRect
+    fRRectOrOvalIsCCW = false;
+    fRRectOrOvalStartIdx = 0xAC;
+    fArcOval.setEmpty();
+    fArcStartAngle = fArcSweepAngle = 0.0f;
+    fArcType = SkArc::Type::kArc;
+    fInArena = true;
+    SkDEBUGCODE(fEditorsAttached.store(0);)
+
+    this->computeBounds();
+    SkDEBUGCODE(this->validate();)
+}
+
+template <typename T>
+static SkSpan<T> copy_to_arena(SkArenaAlloc* arena, SkSpan<const T> src) {
+    T* dst = arena->makeArrayDefault<T>(src.size());
+    if (!src.empty()) {
+        memcpy(dst, src.data(), src.size_bytes());
+    }
+    return {dst, src.size()};
+}
+
+sk_sp<SkPathRef> SkPathRef::MakeInArena(SkArenaAlloc* arena,
+                                        SkSpan<const SkPoint> points,
+                                        SkSpan<const uint8_t> verbs,
+                                        SkSpan<const SkScalar> weights,
+                                        unsigned segmentMask) {
+    SkASSERT(arena);
+    SkSpan<SkPoint> arenaPoints = copy_to_arena(arena, points);
+    SkSpan<uint8_t> arenaVerbs = copy_to_arena(arena, verbs);
+    SkSpan<SkScalar> arenaWeights = copy_to_arena(arena, weights);
+
+    // The arena runs the destructor, with the ref the path ref was created with still held,
+    // so unref() never deletes it.
+    SkPathRef* ref = arena->make([&](void* storage) {
+        return new (storage) SkPathRef(arenaPoints, arenaVerbs, arenaWeights, segmentMask);
+    });
+    return sk_ref_sp(ref);
+}
+
+sk_sp<SkPathRef> SkPathRef::refOrCopy() {
+    if (!fInArena) {
+        return sk_ref_sp(this);
+    }
+    sk_sp<SkPathRef> copy(new SkPathRef);
+    copy->copy(*this, 0, 0, 0);
+    return copy;
+}
+
 SkPathRef::~SkPathRef() {
     // Deliberately don't validate() this path ref, otherwise there's no way
     // to read one that's not valid and then free its memory without asserting.
@@ -143,8 +202,7 @@ void SkPathRef::CreateTransformedCopy(sk_sp<SkPathRef>* dst,
     SkDEBUGCODE(src.validate();)
     if (matrix.isIdentity()) {
         if (dst->get() != &src) {
-            src.ref();
-            dst->reset(const_cast<SkPathRef*>(&src));
+            *dst = const_cast<SkPathRef&>(src).refOrCopy();
             SkDEBUGCODE((*dst)->validate();)
         }
         return;
@@ -13,6 +13,7 @@
 #include "include/core/SkPathEffect.h"
 #include "include/core/SkStrokeRec.h"
 #include "src/core/SkMatrixPriv.h"
+#include "src/core/SkStrokeCache.h"
 
 namespace skpathutils {
 
@@ -51,7 +52,10 @@ bool FillPathWithPaint(const SkPath& src, const SkPaint& paint, SkPath* dst,
         srcPtr = &tmpPath;
     }
 
-    if (!rec.applyToPath(dst, *srcPtr)) {
+    // Only the caller's path keeps its generation ID from one draw to the next.
+    const bool stroked = srcPtr == &src ? SkStrokeCache::ApplyToPath(rec, src, dst)
+                                        : rec.applyToPath(dst, *srcPtr);
+    if (!stroked) {
         if (srcPtr == &tmpPath) {
             // If path's were copy-on-write, this trick would not be needed.
             // As it is, we want to save making a deep-copy from tmpPath -> dst
@@ -7,26 +7,36 @@
 
 #include "include/core/SkPicture.h"
 
+#include "include/core/SkBBHFactory.h"
+#include "include/core/SkCanvas.h"
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkPictureRecorder.h"
 #include "include/core/SkSerialProcs.h"
 #include "include/core/SkStream.h"
 #include "include/private/base/SkTFitsIn.h"
 #include "include/private/base/SkTo.h"
 #include "src/base/SkMathPriv.h"
+#include "src/core/SkBigPicture.h"
 #include "src/core/SkCanvasPriv.h"
 #include "src/core/SkPictureData.h"
+#include "src/core/SkPictureImageEncoder.h"
 #include "src/core/SkPicturePlayback.h"
 #include "src/core/SkPicturePriv.h"
 #include "src/core/SkPictureRecord.h"
+#include "src/core/SkRTree.h"
 #include "src/core/SkReadBuffer.h"
+#include "src/core/SkRecord.h"
+#include "src/core/SkRecordDraw.h"
 #include "src/core/SkResourceCache.h"
 #include "src/core/SkStreamPriv.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/core/SkWriteBuffer.h"
 
 #include <atomic>
 #include <cstring>
 #include <memory>
+#include <vector>
 
 // When we read/write the SkPictInfo via a stream, we have a sentinel byte right after the info.
 // Note: in the read/write buffer versions, we have a slightly different convention:
@@ -55,9 +65,42 @@ SkPicture::~SkPicture() {
     }
 }
 
+void SkPicture::playbackParallel(SkCanvas* const canvases[], const SkRect tiles[], int count,
+                                 SkExecutor* executor) const {
+    const SkBigPicture* bigPicture = this->asSkBigPicture();
+
+    // A picture recorded without a BBH gets a temporary one, built once and shared by every tile.
+    const SkBBoxHierarchy* bbh = bigPicture ? bigPicture->bbh() : nullptr;
+    sk_sp<SkBBoxHierarchy> temporaryBBH;
+    if (bigPicture && !bbh && count > 1) {
+        const SkRecord& record = *bigPicture->record();
+        std::vector<SkRect> bounds(record.count());
+        std::vector<SkBBoxHierarchy::Metadata> meta(record.count());
+        SkRecordFillBounds(this->cullRect(), record, bounds.data(), meta.data());
+        temporaryBBH = sk_make_sp<SkRTree>();
+        temporaryBBH->insert(bounds.data(), meta.data(), record.count());
+        bbh = temporaryBBH.get();
+    }
+
+    SkTaskGroup(executor ? *executor : SkExecutor::GetDefault()).batch(count, [&](int i) {
+        SkCanvas* canvas = canvases[i];
+        SkAutoCanvasRestore acr(canvas, true);
+        canvas->clipRect(tiles[i]);
+        if (bigPicture) {
+            bigPicture->playback(canvas, bbh);
+        } else {
+            this->playback(canvas);
+        }
+    });
+}
+
 static const char kMagic[] = { 's', 'k', 'i', 'a', 'p', 'i', 'c', 't' };
 
 SkPictInfo SkPicture::createHeader() const {
+    return SkPicturePriv::MakeHeader(this->cullRect());
+}
+
+SkPictInfo SkPicturePriv::MakeHeader(const SkRect& cullRect) {
     SkPictInfo info;
     // Copy magic bytes at the beginning of the header
     static_assert(sizeof(kMagic) == 8, "");
@@ -66,7 +109,7 @@ SkPictInfo SkPicture::createHeader() const {
 
     // Set picture info after magic bytes in the header
     info.setVersion(SkPicturePriv::kCurrent_Version);
-    info.fCullRect = this->cullRect();
+    info.fCullRect = cullRect;
     return info;
 }
 
@@ -144,8 +187,24 @@ sk_sp<SkPicture> SkPicture::Forwardport(const SkPictInfo& info,
 
 static const int kNestedSKPLimit = 100; // Arbitrarily set
 
+// Only whole serialized pictures can be checked against fTrustedChecksum, so pictures read from
+// streams are never trusted. Past here a non-zero fTrustedChecksum means it has been verified.
+static SkDeserialProcs verify_trusted_checksum(const SkDeserialProcs* procs,
+                                               const void* data, size_t size) {
+    SkDeserialProcs verified;
+    if (procs) {
+        verified = *procs;
+    }
+    if (verified.fTrustedChecksum != 0 &&
+        (!data || verified.fTrustedChecksum != SkDeserialProcs::Checksum(data, size))) {
+        verified.fTrustedChecksum = 0;
+    }
+    return verified;
+}
+
 sk_sp<SkPicture> SkPicture::MakeFromStream(SkStream* stream, const SkDeserialProcs* procs) {
-    return MakeFromStreamPriv(stream, procs, nullptr, kNestedSKPLimit);
+    const SkDeserialProcs verified = verify_trusted_checksum(procs, nullptr, 0);
+    return MakeFromStreamPriv(stream, &verified, nullptr, kNestedSKPLimit);
 }
 
 sk_sp<SkPicture> SkPicture::MakeFromData(const void* data, size_t size,
@@ -153,16 +212,19 @@ sk_sp<SkPicture> SkPicture::MakeFromData(const void* data, size_t size,
     if (!data) {
         return nullptr;
     }
+    const SkDeserialProcs verified = verify_trusted_checksum(procs, data, size);
     SkMemoryStream stream(data, size);
-    return MakeFromStreamPriv(&stream, procs, nullptr, kNestedSKPLimit);
+    return MakeFromStreamPriv(&stream, &verified, nullptr, kNestedSKPLimit);
 }
 
 sk_sp<SkPicture> SkPicture::MakeFromData(const SkData* data, const SkDeserialProcs* procs) {
     if (!data) {
         return nullptr;
     }
-    SkMemoryStream stream(data->data(), data->size());
-    return MakeFromStreamPriv(&stream, procs, nullptr, kNestedSKPLimit);
+    const SkDeserialProcs verified = verify_trusted_checksum(procs, data->data(), data->size());
+    // Streaming from the SkData itself lets the op data be shared instead of copied.
+    SkMemoryStream stream(sk_ref_sp(const_cast<SkData*>(data)));
+    return MakeFromStreamPriv(&stream, &verified, nullptr, kNestedSKPLimit);
 }
 
 sk_sp<SkPicture> SkPicture::MakeFromStreamPriv(SkStream* stream, const SkDeserialProcs* procsPtr,
@@ -305,6 +367,15 @@ void SkPicture::serialize(SkWStream* stream, const SkSerialProcs* procsPtr,
     std::unique_ptr<SkPictureData> data(this->backport());
     if (data) {
         stream->write8(kPictureData_TrailingStreamByteAfterPictInfo);
+        if (procs.fImageExecutor && !typefaceSet && !textBlobsOnly) {
+            // Encode the images of the whole picture while its ops are written.
+            SkPictureImageEncoder encoder(*procs.fImageExecutor, procs);
+            skia_private::TArray<sk_sp<const SkImage>> images;
+            data->collectImages(&images);
+            encoder.encode(images);
+            data->serialize(stream, encoder.procs(), typefaceSet, textBlobsOnly);
+            return;
+        }
         data->serialize(stream, procs, typefaceSet, textBlobsOnly);
     } else {
         stream->write8(kFailure_TrailingStreamByteAfterPictInfo);
@@ -9,10 +9,12 @@
 
 #include "include/core/SkFlattenable.h"
 #include "include/core/SkFontMgr.h"
+#include "include/core/SkPicture.h"
 #include "include/core/SkSerialProcs.h"
 #include "include/core/SkStream.h"
 #include "include/core/SkString.h"
 #include "include/core/SkTypeface.h"
+#include "include/private/base/SkAlign.h"
 #include "include/private/base/SkDebug.h"
 #include "include/private/base/SkTFitsIn.h"
 #include "include/private/base/SkTemplates.h"
@@ -29,6 +31,7 @@
 #include "src/core/SkWriteBuffer.h"
 
 #include <cstring>
+#include <memory>
 #include <utility>
 
 using namespace skia_private;
@@ -101,6 +104,19 @@ static void write_tag_size(SkWStream* stream, uint32_t tag, size_t size) {
     stream->write32(SkToU32(size));
 }
 
+// Pads the stream so that the payload of the tag written next is 4-byte aligned relative to the
+// start of the stream. A reader with the whole stream in (possibly mapped) memory can then use the
+// payload where it is instead of copying it out for SkReadBuffer.
+static void write_alignment_padding(SkWStream* stream) {
+    // The padding tag and the next tag are 8 bytes each, so only the bytes before them matter.
+    const size_t padding = (0 - stream->bytesWritten()) & 3;
+    if (padding) {
+        static constexpr uint8_t kZeros[3] = {0, 0, 0};
+        write_tag_size(stream, SK_PICT_PADDING_TAG, padding);
+        stream->write(kZeros, padding);
+    }
+}
+
 void SkPictureData::WriteFactories(SkWStream* stream, const SkFactorySet& rec) {
     int count = rec.count();
 
@@ -227,6 +243,7 @@ static SkSerialProcs skip_typeface_proc(const SkSerialProcs& procs) {
 void SkPictureData::serialize(SkWStream* stream, const SkSerialProcs& procs,
                               SkRefCntSet* topLevelTypeFaceSet, bool textBlobsOnly) const {
     // This can happen at pretty much any time, so might as well do it first.
+    write_alignment_padding(stream);
     write_tag_size(stream, SK_PICT_READER_TAG, fOpData->size());
     stream->write(fOpData->bytes(), fOpData->size());
 
@@ -264,6 +281,7 @@ void SkPictureData::serialize(SkWStream* stream, const SkSerialProcs& procs,
     WriteTypefaces(stream, *typefaceSet, procs);
 
     // Write the buffer.
+    write_alignment_padding(stream);
     write_tag_size(stream, SK_PICT_BUFFER_SIZE_TAG, buffer.bytesWritten());
     buffer.writeToStream(stream);
 
@@ -278,6 +296,15 @@ void SkPictureData::serialize(SkWStream* stream, const SkSerialProcs& procs,
     stream->write32(SK_PICT_EOF_TAG);
 }
 
+void SkPictureData::collectImages(TArray<sk_sp<const SkImage>>* images) const {
+    images->push_back_n(fImages.size(), fImages.data());
+    for (const sk_sp<const SkPicture>& pic : fPictures) {
+        if (std::unique_ptr<SkPictureData> data{pic->backport()}) {
+            data->collectImages(images);
+        }
+    }
+}
+
 void SkPictureData::flatten(SkWriteBuffer& buffer) const {
     write_tag_size(buffer, SK_PICT_READER_TAG, fOpData->size());
     buffer.writeByteArray(fOpData->bytes(), fOpData->size());
@@ -303,6 +330,36 @@ void SkPictureData::flatten(SkWriteBuffer& buffer) const {
 
 ///////////////////////////////////////////////////////////////////////////////
 
+// If the stream is backed by memory and its next 'size' bytes are all there and 4-byte aligned,
+// as SkReadBuffer requires, skips past them and returns where they are. Otherwise returns nullptr
+// without moving the stream.
+static const void* skip_in_place(SkStream* stream, size_t size) {
+    const char* base = static_cast<const char*>(stream->getMemoryBase());
+    if (!base || !stream->hasPosition() || !stream->hasLength()) {
+        return nullptr;
+    }
+    const size_t position = stream->getPosition();
+    const size_t length = stream->getLength();
+    if (position > length || size > length - position ||
+        !SkIsAlign4(reinterpret_cast<uintptr_t>(base + position))) {
+        return nullptr;
+    }
+    return stream->skip(size) == size ? base + position : nullptr;
+}
+
+// Streams over an SkData (e.g. a mapped .skp file) share their op data rather than copying it.
+static sk_sp<SkData> share_or_copy_data(SkStream* stream, size_t size) {
+    sk_sp<SkData> streamData = stream->getData();
+    if (streamData && streamData->data() == stream->getMemoryBase()) {
+        const size_t offset = stream->getPosition();
+        if (const void* bytes = skip_in_place(stream, size)) {
+            SkASSERT(bytes == streamData->bytes() + offset);
+            return SkData::MakeSubset(streamData.get(), offset, size);
+        }
+    }
+    return SkData::MakeFromStream(stream, size);
+}
+
 bool SkPictureData::parseStreamTag(SkStream* stream,
                                    uint32_t tag,
                                    uint32_t size,
@@ -310,9 +367,14 @@ bool SkPictureData::parseStreamTag(SkStream* stream,
                                    SkTypefacePlayback* topLevelTFPlayback,
                                    int recursionLimit) {
     switch (tag) {
+        case SK_PICT_PADDING_TAG:
+            if (size > 3 || stream->skip(size) != size) {
+                return false;
+            }
+            break;
         case SK_PICT_READER_TAG:
             SkASSERT(nullptr == fOpData);
-            fOpData = SkData::MakeFromStream(stream, size);
+            fOpData = share_or_copy_data(stream, size);
             if (!fOpData) {
                 return false;
             }
@@ -381,13 +443,20 @@ bool SkPictureData::parseStreamTag(SkStream* stream,
             if (StreamRemainingLengthIsBelow(stream, size)) {
                 return false;
             }
-            SkAutoMalloc storage(size);
-            if (stream->read(storage.get(), size) != size) {
-                return false;
+            // Parse the buffer in place if we can; nothing we parse out of it refers back to it.
+            SkAutoMalloc storage;
+            const void* bytes = skip_in_place(stream, size);
+            if (!bytes) {
+                storage.reset(size);
+                if (stream->read(storage.get(), size) != size) {
+                    return false;
+                }
+                bytes = storage.get();
             }
 
-            SkReadBuffer buffer(storage.get(), size);
+            SkReadBuffer buffer(bytes, size);
             buffer.setVersion(fInfo.getVersion());
+            buffer.setTrusted(fTrusted);
 
             if (!fFactoryPlayback) {
                 return false;
@@ -521,6 +590,8 @@ SkPictureData* SkPictureData::CreateFromStream(SkStream* stream,
                                                SkTypefacePlayback* topLevelTFPlayback,
                                                int recursionLimit) {
     std::unique_ptr<SkPictureData> data(new SkPictureData(info));
+    // SkPicture::MakeFromData() clears fTrustedChecksum unless it verified it.
+    data->fTrusted = procs.fTrustedChecksum != 0;
     if (!topLevelTFPlayback) {
         topLevelTFPlayback = &data->fTFPlayback;
     }
@@ -535,6 +606,7 @@ SkPictureData* SkPictureData::CreateFromBuffer(SkReadBuffer& buffer,
                                                const SkPictInfo& info) {
     std::unique_ptr<SkPictureData> data(new SkPictureData(info));
     buffer.setVersion(info.getVersion());
+    data->fTrusted = buffer.isTrusted();
 
     if (!data->parseBuffer(buffer)) {
         return nullptr;
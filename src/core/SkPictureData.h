@@ -63,6 +63,8 @@ public:
 #define SK_PICT_TYPEFACE_TAG   SkSetFourByteTag('t', 'p', 'f', 'c')
 #define SK_PICT_PICTURE_TAG    SkSetFourByteTag('p', 'c', 't', 'r')
 #define SK_PICT_DRAWABLE_TAG   SkSetFourByteTag('d', 'r', 'a', 'w')
+// Up to 3 zero bytes, written to a stream so the payload of the next tag is 4-byte aligned
+#define SK_PICT_PADDING_TAG    SkSetFourByteTag('p', 'a', 'd', ' ')
 
 // This tag specifies the size of the ReadBuffer, needed for the following tags
 #define SK_PICT_BUFFER_SIZE_TAG     SkSetFourByteTag('a', 'r', 'a', 'y')
@@ -98,10 +100,16 @@ public:
     void serialize(SkWStream*, const SkSerialProcs&, SkRefCntSet*, bool textBlobsOnly=false) const;
     void flatten(SkWriteBuffer&) const;
 
+    // Appends the images drawn by this picture and its sub-pictures.
+    void collectImages(skia_private::TArray<sk_sp<const SkImage>>*) const;
+
     const SkPictInfo& info() const { return fInfo; }
 
     const sk_sp<SkData>& opData() const { return fOpData; }
 
+    // Whether the data came from a source verified against SkDeserialProcs::fTrustedChecksum.
+    bool isTrusted() const { return fTrusted; }
+
 protected:
     explicit SkPictureData(const SkPictInfo& info);
 
@@ -178,6 +186,7 @@ private:
     std::unique_ptr<SkFactoryPlayback> fFactoryPlayback;
 
     const SkPictInfo fInfo;
+    bool             fTrusted = false;
 
     static void WriteFactories(SkWStream* stream, const SkFactorySet& rec);
     static void WriteTypefaces(SkWStream* stream, const SkRefCntSet& rec, const SkSerialProcs&);
@@ -0,0 +1,146 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/core/SkPictureImageEncoder.h"
+
+#include "include/core/SkColorSpace.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkPixmap.h"
+#include "src/core/SkChecksum.h"
+#include "src/core/SkWriteBuffer.h"
+
+#include <cstring>
+#include <optional>
+
+// Returns a hash of the image's encoded data, or of its pixels for raster images, or nothing for
+// images whose contents can't be read cheaply.
+static std::optional<uint64_t> content_hash(const SkImage* image) {
+    if (sk_sp<SkData> encoded = image->refEncodedData()) {
+        return SkChecksum::Hash64(encoded->data(), encoded->size(), /*seed=*/1);
+    }
+    SkPixmap pixmap;
+    if (!image->peekPixels(&pixmap)) {
+        return std::nullopt;
+    }
+    const SkImageInfo& info = pixmap.info();
+    const uint32_t header[] = {
+        static_cast<uint32_t>(info.width()),
+        static_cast<uint32_t>(info.height()),
+        static_cast<uint32_t>(info.colorType()),
+        static_cast<uint32_t>(info.alphaType()),
+        info.colorSpace() ? info.colorSpace()->hash() : 0,
+    };
+    uint64_t hash = SkChecksum::Hash64(header, sizeof(header), /*seed=*/2);
+    const size_t rowBytes = info.minRowBytes();
+    for (int y = 0; y < info.height(); y++) {
+        hash = SkChecksum::Hash64(pixmap.addr(0, y), rowBytes, hash);
+    }
+    return hash;
+}
+
+static bool same_content(const SkImage* a, const SkImage* b) {
+    sk_sp<SkData> encodedA = a->refEncodedData(),
+                  encodedB = b->refEncodedData();
+    if (encodedA || encodedB) {
+        return encodedA && encodedB && encodedA->equals(encodedB.get());
+    }
+    SkPixmap pixmapA, pixmapB;
+    if (!a->peekPixels(&pixmapA) || !b->peekPixels(&pixmapB)) {
+        return false;
+    }
+    const SkImageInfo& infoA = pixmapA.info();
+    const SkImageInfo& infoB = pixmapB.info();
+    if (infoA.dimensions() != infoB.dimensions() ||
+        infoA.colorType() != infoB.colorType() ||
+        infoA.alphaType() != infoB.alphaType() ||
+        !SkColorSpace::Equals(infoA.colorSpace(), infoB.colorSpace())) {
+        return false;
+    }
+    const size_t rowBytes = infoA.minRowBytes();
+    for (int y = 0; y < infoA.height(); y++) {
+        if (0 != memcmp(pixmapA.addr(0, y), pixmapB.addr(0, y), rowBytes)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+SkPictureImageEncoder::SkPictureImageEncoder(SkExecutor& executor, const SkSerialProcs& procs)
+        : fProcs(procs)
+        , fTasks(executor) {}
+
+SkPictureImageEncoder::~SkPictureImageEncoder() {
+    fTasks.wait();
+}
+
+void SkPictureImageEncoder::encode(const skia_private::TArray<sk_sp<const SkImage>>& images) {
+    SkASSERT(fSlots.empty());
+    for (const sk_sp<const SkImage>& image : images) {
+        if (image && !fSlotsByID.find(image->uniqueID())) {
+            fSlotsByID.set(image->uniqueID(), fSlots.size());
+            fSlots.push_back().fImage = image;
+        }
+    }
+    fTasks.batch(fSlots.size(), [this](int index) { this->encodeSlot(index); });
+}
+
+void SkPictureImageEncoder::encodeSlot(int index) {
+    Slot& slot = fSlots[index];
+    const std::optional<uint64_t> hash = content_hash(slot.fImage.get());
+    if (hash) {
+        // Compare against the images with this hash outside the lock, then claim the hash for this
+        // slot only if no image was added meanwhile, so identical images are encoded just once.
+        int compared = 0;
+        while (true) {
+            skia_private::STArray<1, int> candidates;
+            {
+                SkAutoMutexExclusive lock(fMutex);
+                skia_private::STArray<1, int>* claimed = fSlotsByContent.find(*hash);
+                if (!claimed) {
+                    claimed = fSlotsByContent.set(*hash, {});
+                }
+                if (claimed->size() == compared) {
+                    claimed->push_back(index);
+                    break;
+                }
+                candidates.push_back_n(claimed->size() - compared, claimed->data() + compared);
+                compared = claimed->size();
+            }
+            for (int candidate : candidates) {
+                if (same_content(slot.fImage.get(), fSlots[candidate].fImage.get())) {
+                    slot.fSameAs = candidate;
+                    return;
+                }
+            }
+        }
+    }
+    slot.fData = SkBinaryWriteBuffer::SerializeImage(slot.fImage.get(), fProcs);
+}
+
+SkSerialProcs SkPictureImageEncoder::procs() {
+    SkSerialProcs procs = fProcs;
+    procs.fImageProc = ImageProc;
+    procs.fImageCtx = this;
+    // Sub-pictures are serialized with these procs; their images are already being encoded.
+    procs.fImageExecutor = nullptr;
+    return procs;
+}
+
+sk_sp<SkData> SkPictureImageEncoder::ImageProc(SkImage* image, void* ctx) {
+    auto* encoder = static_cast<SkPictureImageEncoder*>(ctx);
+    if (const int* index = encoder->fSlotsByID.find(image->uniqueID())) {
+        if (!encoder->fWaited) {
+            encoder->fTasks.wait();
+            encoder->fWaited = true;
+        }
+        const Slot& slot = encoder->fSlots[*index];
+        return slot.fSameAs >= 0 ? encoder->fSlots[slot.fSameAs].fData : slot.fData;
+    }
+    // Not one of the picture's images, e.g. an image in a shader or a mipmap level.
+    return encoder->fProcs.fImageProc ? encoder->fProcs.fImageProc(image, encoder->fProcs.fImageCtx)
+                                      : nullptr;
+}
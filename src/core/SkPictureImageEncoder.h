@@ -0,0 +1,69 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkPictureImageEncoder_DEFINED
+#define SkPictureImageEncoder_DEFINED
+
+#include "include/core/SkData.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkSerialProcs.h"
+#include "include/private/base/SkMutex.h"
+#include "include/private/base/SkTArray.h"
+#include "include/private/base/SkThreadAnnotations.h"
+#include "src/core/SkTHash.h"
+#include "src/core/SkTaskGroup.h"
+
+#include <cstdint>
+
+class SkExecutor;
+
+/**
+ *  Encodes the images of a picture concurrently on an executor, for SkSerialProcs::fImageExecutor.
+ *  Images are deduplicated by unique ID and then by content: a hash of their encoded data or
+ *  pixels, checked by comparing the contents. Each distinct image is encoded once, as
+ *  SkBinaryWriteBuffer::SerializeImage() would encode it with the original procs.
+ *
+ *  procs() returns procs whose image proc hands out those encodings, waiting for them if needed,
+ *  and calls the original image proc for any other image.
+ */
+class SkPictureImageEncoder {
+public:
+    SkPictureImageEncoder(SkExecutor&, const SkSerialProcs&);
+    ~SkPictureImageEncoder();
+
+    // Starts encoding these images. Call this at most once.
+    void encode(const skia_private::TArray<sk_sp<const SkImage>>&);
+
+    SkSerialProcs procs();
+
+private:
+    struct Slot {
+        sk_sp<const SkImage> fImage;
+        sk_sp<SkData>        fData;
+        int                  fSameAs = -1;  // the slot with the same content that holds fData
+    };
+
+    static sk_sp<SkData> ImageProc(SkImage*, void* ctx);
+
+    void encodeSlot(int index);
+
+    const SkSerialProcs fProcs;
+    SkTaskGroup fTasks;
+    bool fWaited = false;
+
+    // Written by encode(), then only read until the tasks are done.
+    skia_private::TArray<Slot> fSlots;
+    skia_private::THashMap<uint32_t, int> fSlotsByID;
+
+    SkMutex fMutex;
+    // Slots that hold an encoding, by content hash.
+    skia_private::THashMap<uint64_t, skia_private::STArray<1, int>> fSlotsByContent
+            SK_GUARDED_BY(fMutex);
+};
+
+#endif  // SkPictureImageEncoder_DEFINED
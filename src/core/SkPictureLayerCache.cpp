@@ -0,0 +1,318 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/core/SkPictureLayerCache.h"
+
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColorSpace.h"
+#include "include/core/SkDrawable.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkMatrix.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkPicture.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkSamplingOptions.h"
+#include "include/core/SkSurface.h"
+#include "include/core/SkSurfaceProps.h"
+#include "src/core/SkBigPicture.h"
+#include "src/core/SkChecksum.h"
+#include "src/core/SkPicturePriv.h"
+#include "src/core/SkRecord.h"
+#include "src/core/SkRecords.h"
+
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+// SkLRUCache needs count limits too; the byte limit should be what purges layers in practice.
+static constexpr int kMaxLayerCount = 1024;
+// Keys drawn less recently than this many others start counting their uses over.
+static constexpr int kMaxTrackedUses = 256;
+// Past this, float translates can't hold a fraction of a pixel.
+static constexpr float kMaxTranslate = 1 << 24;
+// Pictures nested deeper than this aren't inspected, and so aren't cached.
+static constexpr int kMaxPictureDepth = 8;
+// Marks a key in fUses whose contents can't be drawn through a layer.
+static constexpr int kNeverPromote = -1;
+
+enum : uint32_t {
+    kPicture_Kind,
+    kDrawable_Kind,
+};
+
+SkPictureLayerCache* SkPictureLayerCache::Global() {
+    static SkPictureLayerCache* cache = new SkPictureLayerCache(0);
+    return cache;
+}
+
+SkPictureLayerCache::SkPictureLayerCache(size_t byteLimit, int promoteAfter)
+        : fLayers(kMaxLayerCount)
+        , fUses(kMaxTrackedUses)
+        , fByteLimit(byteLimit)
+        , fPromoteAfter(promoteAfter)
+        , fEnabled(byteLimit > 0) {}
+
+bool SkPictureLayerCache::Key::operator==(const Key& that) const {
+    return 0 == memcmp(this, &that, sizeof(Key));
+}
+
+uint32_t SkPictureLayerCache::Key::Hash::operator()(const Key& key) const {
+    return SkChecksum::Hash32(&key, sizeof(Key));
+}
+
+static size_t layer_bytes(const SkImage* image) {
+    return image->imageInfo().computeMinByteSize();
+}
+
+static bool composites_src_over(const SkPaint* paint) {
+    return !paint || paint->asBlendMode() == SkBlendMode::kSrcOver;
+}
+
+static bool draws_same_through_layer(const SkPicture* picture, int depth);
+
+namespace {
+
+// Checks whether drawing a record into a transparent layer and compositing that src-over looks
+// the same as drawing the record directly. That holds when everything it draws blends src-over,
+// since src-over is associative, and nothing reads what is under the layer.
+struct LayerSafety {
+    template <typename T> void operator()(const T& op) {
+        if constexpr ((T::kTags & SkRecords::kHasPaint_Tag) != 0) {
+            fSafe &= composites_src_over(AsPtr(op.paint));
+        }
+    }
+    void operator()(const SkRecords::SaveLayer& op) {
+        fSafe &= !op.backdrop &&
+                 !(op.saveLayerFlags & SkCanvas::kInitWithPrevious_SaveLayerFlag) &&
+                 composites_src_over(op.paint);
+    }
+    void operator()(const SkRecords::SaveBehind&)   { fSafe = false; }
+    void operator()(const SkRecords::DrawBehind&)   { fSafe = false; }
+    void operator()(const SkRecords::DrawDrawable&) { fSafe = false; }
+    void operator()(const SkRecords::DrawEdgeAAQuad& op) {
+        fSafe &= op.mode == SkBlendMode::kSrcOver;
+    }
+    void operator()(const SkRecords::DrawPicture& op) {
+        // With a paint, the nested picture is drawn into its own layer anyway.
+        fSafe &= op.paint ? composites_src_over(op.paint)
+                          : draws_same_through_layer(op.picture.get(), fDepth + 1);
+    }
+
+    static const SkPaint* AsPtr(const SkRecords::Optional<SkPaint>& paint) { return paint; }
+    static const SkPaint* AsPtr(const SkPaint& paint) { return &paint; }
+
+    int  fDepth;
+    bool fSafe = true;
+};
+
+}  // namespace
+
+static bool draws_same_through_layer(const SkPicture* picture, int depth) {
+    if (depth > kMaxPictureDepth) {
+        return false;
+    }
+    // Other pictures hold a single op, and drawPicture() unrolls them instead of coming here.
+    const SkBigPicture* bigPicture = SkPicturePriv::AsSkBigPicture(sk_ref_sp(picture));
+    if (!bigPicture) {
+        return false;
+    }
+    LayerSafety safety{depth};
+    const SkRecord* record = bigPicture->record();
+    for (int i = 0; i < record->count() && safety.fSafe; ++i) {
+        record->visit(i, safety);
+    }
+    return safety.fSafe;
+}
+
+bool SkPictureLayerCache::drawPicture(SkCanvas* canvas, const SkImageInfo& deviceInfo,
+                                      const SkPicture* picture, const SkMatrix* matrix,
+                                      const SkPaint* paint) {
+    // These would apply to the layer differently than to the picture's saveLayer().
+    if (paint && (paint->getImageFilter() || paint->getMaskFilter())) {
+        return false;
+    }
+    // With a paint, drawPicture() draws into a layer too, so any picture can be cached.
+    return this->draw(canvas, deviceInfo, kPicture_Kind, picture->uniqueID(),
+                      picture->cullRect(), matrix, paint,
+                      [picture](SkCanvas* layer) { picture->playback(layer); },
+                      [picture, paint]() {
+                          return paint || draws_same_through_layer(picture, /*depth=*/0);
+                      });
+}
+
+bool SkPictureLayerCache::drawDrawable(SkCanvas* canvas, const SkImageInfo& deviceInfo,
+                                       SkDrawable* drawable, const SkMatrix* matrix) {
+    // A drawable promises to draw the same thing until its generation ID changes.
+    return this->draw(canvas, deviceInfo, kDrawable_Kind, drawable->getGenerationID(),
+                      drawable->getBounds(), matrix, nullptr,
+                      [drawable](SkCanvas* layer) { drawable->draw(layer); },
+                      [drawable]() {
+                          sk_sp<SkPicture> snapshot = drawable->makePictureSnapshot();
+                          return snapshot && draws_same_through_layer(snapshot.get(), 0);
+                      });
+}
+
+template <typename DrawFn, typename CheckFn>
+bool SkPictureLayerCache::draw(SkCanvas* canvas, const SkImageInfo& deviceInfo, uint32_t kind,
+                               uint32_t id, const SkRect& bounds, const SkMatrix* matrix,
+                               const SkPaint* paint, DrawFn&& drawFn, CheckFn&& canUseLayer) {
+    if (!this->isEnabled()) {
+        return false;
+    }
+
+    SkMatrix ctm = canvas->getLocalToDeviceAs3x3();
+    if (matrix) {
+        ctm.preConcat(*matrix);
+    }
+    const float tx = ctm.getTranslateX(),
+                ty = ctm.getTranslateY();
+    if (ctm.hasPerspective() || !ctm.isFinite() ||
+        !(std::fabs(tx) < kMaxTranslate) || !(std::fabs(ty) < kMaxTranslate)) {
+        return false;
+    }
+
+    // Layers are keyed by the matrix with its whole-pixel translate taken out, so a picture that
+    // only moves by whole pixels reuses its layer.
+    const float ix = std::floor(tx),
+                iy = std::floor(ty);
+    SkMatrix layerMatrix = ctm;
+    layerMatrix.setTranslateX(tx - ix);
+    layerMatrix.setTranslateY(ty - iy);
+
+    const SkIRect layerBounds = layerMatrix.mapRect(bounds).roundOut();
+    const SkImageInfo layerInfo = SkImageInfo::Make(layerBounds.size(),
+                                                    deviceInfo.colorType(),
+                                                    kPremul_SkAlphaType,
+                                                    deviceInfo.refColorSpace());
+    const size_t bytes = layerInfo.computeMinByteSize();
+    if (layerInfo.isEmpty() || SkImageInfo::ByteSizeOverflowed(bytes)) {
+        return false;
+    }
+
+    const SkSurfaceProps props = canvas->getTopProps();
+    Key key;
+    key.fColorSpaceHash = deviceInfo.colorSpace() ? deviceInfo.colorSpace()->hash() : 0;
+    key.fKind = kind;
+    key.fID = id;
+    // Adding 0 turns -0 into 0, so they compare equal as bytes.
+    key.fMatrix[0] = layerMatrix.getScaleX() + 0.0f;
+    key.fMatrix[1] = layerMatrix.getSkewX() + 0.0f;
+    key.fMatrix[2] = layerMatrix.getSkewY() + 0.0f;
+    key.fMatrix[3] = layerMatrix.getScaleY() + 0.0f;
+    key.fMatrix[4] = layerMatrix.getTranslateX() + 0.0f;
+    key.fMatrix[5] = layerMatrix.getTranslateY() + 0.0f;
+    key.fColorType = deviceInfo.colorType();
+    key.fPropsFlags = props.flags();
+    key.fPixelGeometry = props.pixelGeometry();
+
+    sk_sp<SkImage> image;
+    {
+        SkAutoMutexExclusive lock(fMutex);
+        if (bytes > fByteLimit) {
+            return false;
+        }
+        if (sk_sp<SkImage>* found = fLayers.find(key)) {
+            image = *found;
+            fStats.fHits++;
+        } else {
+            int* uses = fUses.find(key);
+            if (!uses) {
+                uses = fUses.insert(key, 0);
+            }
+            if (*uses == kNeverPromote) {
+                return false;
+            }
+            if (++*uses <= fPromoteAfter) {
+                fStats.fMisses++;
+                return false;
+            }
+            *uses = 0;
+        }
+    }
+
+    if (!image) {
+        // Only checked when promoting, since it walks the whole picture.
+        if (!canUseLayer()) {
+            SkAutoMutexExclusive lock(fMutex);
+            fUses.insert_or_update(key, kNeverPromote);
+            return false;
+        }
+
+        // Draw the layer without holding the lock; the picture may draw other cached pictures.
+        sk_sp<SkSurface> surface = canvas->makeSurface(layerInfo, &props);
+        if (!surface) {
+            return false;
+        }
+        SkCanvas* layer = surface->getCanvas();
+        layer->translate(-layerBounds.fLeft, -layerBounds.fTop);
+        layer->concat(layerMatrix);
+        drawFn(layer);
+        image = surface->makeImageSnapshot();
+        if (!image) {
+            return false;
+        }
+
+        SkAutoMutexExclusive lock(fMutex);
+        fStats.fPromotions++;
+        if (sk_sp<SkImage>* old = fLayers.find(key)) {
+            // Another thread promoted the same key meanwhile.
+            fStats.fBytesUsed -= layer_bytes(old->get());
+            *old = image;
+        } else {
+            sk_sp<SkImage> evicted;
+            if (fLayers.count() >= fLayers.maxCount() && fLayers.removeLeastRecentlyUsed(&evicted)) {
+                fStats.fBytesUsed -= layer_bytes(evicted.get());
+            }
+            fLayers.insert(key, image);
+        }
+        fStats.fBytesUsed += layer_bytes(image.get());
+        this->purgeAsNeeded();
+    }
+
+    // The layer is pixel aligned, so it composites without resampling.
+    canvas->save();
+    canvas->resetMatrix();
+    canvas->drawImage(image.get(), ix + layerBounds.fLeft, iy + layerBounds.fTop,
+                      SkSamplingOptions(), paint);
+    canvas->restore();
+    return true;
+}
+
+void SkPictureLayerCache::purgeAsNeeded() {
+    sk_sp<SkImage> evicted;
+    while (fStats.fBytesUsed > fByteLimit && fLayers.removeLeastRecentlyUsed(&evicted)) {
+        fStats.fBytesUsed -= layer_bytes(evicted.get());
+    }
+}
+
+SkPictureLayerCache::Stats SkPictureLayerCache::stats() {
+    SkAutoMutexExclusive lock(fMutex);
+    Stats stats = fStats;
+    stats.fCount = fLayers.count();
+    return stats;
+}
+
+size_t SkPictureLayerCache::getByteLimit() {
+    SkAutoMutexExclusive lock(fMutex);
+    return fByteLimit;
+}
+
+size_t SkPictureLayerCache::setByteLimit(size_t bytes) {
+    SkAutoMutexExclusive lock(fMutex);
+    const size_t prevLimit = fByteLimit;
+    fByteLimit = bytes;
+    fEnabled.store(bytes > 0, std::memory_order_relaxed);
+    this->purgeAsNeeded();
+    return prevLimit;
+}
+
+void SkPictureLayerCache::purgeAll() {
+    SkAutoMutexExclusive lock(fMutex);
+    fLayers.reset();
+    fUses.reset();
+    fStats.fBytesUsed = 0;
+}
@@ -0,0 +1,111 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkPictureLayerCache_DEFINED
+#define SkPictureLayerCache_DEFINED
+
+#include "include/core/SkImage.h"
+#include "include/core/SkRefCnt.h"
+#include "include/private/base/SkMutex.h"
+#include "include/private/base/SkThreadAnnotations.h"
+#include "src/core/SkLRUCache.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+class SkCanvas;
+class SkDrawable;
+class SkMatrix;
+class SkPaint;
+class SkPicture;
+struct SkImageInfo;
+struct SkRect;
+
+/**
+ *  Caches raster layers of pictures and drawables that are drawn the same way over and over, like
+ *  a static sidebar in an otherwise animated frame. After a picture has been replayed kPromoteAfter
+ *  times with the same scale, skew and subpixel offset into the same kind of device, the next draw
+ *  draws its whole cull rect into a layer, which that draw and later ones composite instead of
+ *  replaying the picture.
+ *
+ *  Because a layer covers the whole cull rect, it doesn't depend on the clip, and the clip is
+ *  applied when compositing it. Drawing through the cache behaves like drawing the picture into a
+ *  saveLayer(), as drawPicture() with a paint does. Without a paint, that only matches replaying
+ *  the picture if everything in it blends src-over and nothing reads the destination, so other
+ *  pictures, such as those that clear or use backdrop filters, are never cached.
+ *
+ *  The cache is off (its byte limit is 0) by default. Layers bigger than the limit are not cached.
+ */
+class SkPictureLayerCache {
+public:
+    static SkPictureLayerCache* Global();
+
+    static constexpr int kPromoteAfter = 2;
+
+    SkPictureLayerCache(size_t byteLimit, int promoteAfter = kPromoteAfter);
+
+    bool isEnabled() const { return fEnabled.load(std::memory_order_relaxed); }
+
+    // These draw the picture or drawable into the canvas from a cached layer and return true, or
+    // return false if the caller should draw it as usual. 'deviceInfo' describes the canvas's top
+    // device, which must be a raster device aligned to the canvas's global coordinates.
+    bool drawPicture(SkCanvas*, const SkImageInfo& deviceInfo, const SkPicture*,
+                     const SkMatrix*, const SkPaint*);
+    bool drawDrawable(SkCanvas*, const SkImageInfo& deviceInfo, SkDrawable*, const SkMatrix*);
+
+    struct Stats {
+        size_t   fBytesUsed = 0;   // memory held by cached layers
+        int      fCount = 0;       // cached layers
+        uint64_t fHits = 0;        // draws composited from a cached layer
+        uint64_t fMisses = 0;      // draws replayed because they had not been promoted yet
+        uint64_t fPromotions = 0;  // layers drawn and cached
+    };
+    Stats stats();
+
+    size_t getByteLimit();
+    size_t setByteLimit(size_t bytes);
+
+    void purgeAll();
+
+private:
+    struct Key {
+        uint64_t fColorSpaceHash;
+        uint32_t fKind;  // picture or drawable, since their IDs come from different counters
+        uint32_t fID;
+        float    fMatrix[6];  // scale and skew, and the fractional part of the translate
+        int32_t  fColorType;
+        uint32_t fPropsFlags;
+        uint32_t fPixelGeometry;
+        uint32_t fPad = 0;
+
+        bool operator==(const Key&) const;
+        struct Hash {
+            uint32_t operator()(const Key&) const;
+        };
+    };
+
+    // 'canUseLayer' says whether the contents look the same drawn through a layer.
+    template <typename DrawFn, typename CheckFn>
+    bool draw(SkCanvas*, const SkImageInfo& deviceInfo, uint32_t kind, uint32_t id,
+              const SkRect& bounds, const SkMatrix* matrix, const SkPaint*, DrawFn&&,
+              CheckFn&& canUseLayer);
+
+    void purgeAsNeeded() SK_REQUIRES(fMutex);
+
+    SkMutex fMutex;
+    SkLRUCache<Key, sk_sp<SkImage>, Key::Hash> fLayers SK_GUARDED_BY(fMutex);
+    // How many times recent keys without a layer have been drawn.
+    SkLRUCache<Key, int, Key::Hash> fUses SK_GUARDED_BY(fMutex);
+    size_t fByteLimit SK_GUARDED_BY(fMutex);
+    Stats  fStats SK_GUARDED_BY(fMutex);
+    const int fPromoteAfter;
+    // Lets drawPicture() skip the lock when the cache is off.
+    std::atomic<bool> fEnabled;
+};
+
+#endif  // SkPictureLayerCache_DEFINED
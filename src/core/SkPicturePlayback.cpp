@@ -63,18 +63,35 @@ void SkPicturePlayback::draw(SkCanvas* canvas,
     AutoResetOpID aroi(this);
     SkASSERT(0 == fCurOffset);
 
-    SkReadBuffer reader(fPictureData->opData()->bytes(),
-                        fPictureData->opData()->size());
-    reader.setVersion(fPictureData->info().getVersion());
-
     // Record this, so we can concat w/ it if we encounter a setMatrix()
     SkM44 initialMatrix = canvas->getLocalToDevice();
 
     SkAutoCanvasRestore acr(canvas, false);
 
+    this->drawOps(canvas, callback, initialMatrix, buffer);
+}
+
+bool SkPicturePlayback::drawContinuation(SkCanvas* canvas, const SkM44& initialMatrix,
+                                         int minSaveCount) {
+    AutoResetOpID aroi(this);
+    SkASSERT(0 == fCurOffset);
+
+    fMinSaveCount = minSaveCount;
+    const bool valid = this->drawOps(canvas, nullptr, initialMatrix, nullptr);
+    fMinSaveCount = 0;
+    return valid;
+}
+
+bool SkPicturePlayback::drawOps(SkCanvas* canvas, SkPicture::AbortCallback* callback,
+                                const SkM44& initialMatrix, SkReadBuffer* buffer) {
+    SkReadBuffer reader(fPictureData->opData()->bytes(),
+                        fPictureData->opData()->size());
+    reader.setVersion(fPictureData->info().getVersion());
+    reader.setTrusted(fPictureData->isTrusted());
+
     while (!reader.eof() && reader.isValid()) {
         if (callback && callback->abort()) {
-            return;
+            return true;
         }
 
         fCurOffset = reader.offset();
@@ -87,7 +104,7 @@ void SkPicturePlayback::draw(SkCanvas* canvas,
         }
 
         if (!reader.validate(size > 0 && op > UNUSED && op <= LAST_DRAWTYPE_ENUM)) {
-            return;
+            return false;
         }
 
         this->handleOp(&reader, (DrawType)op, size, canvas, initialMatrix);
@@ -97,6 +114,7 @@ void SkPicturePlayback::draw(SkCanvas* canvas,
     if (buffer) {
         buffer->validate(reader.isValid());
     }
+    return reader.isValid();
 }
 
 static void validate_offsetToRestore(SkReadBuffer* reader, size_t offsetToRestore) {
@@ -652,7 +670,9 @@ void SkPicturePlayback::handleOp(SkReadBuffer* reader,
             }
         } break;
         case RESTORE:
-            canvas->restore();
+            if (canvas->getSaveCount() > fMinSaveCount) {
+                canvas->restore();
+            }
             break;
         case ROTATE: {
             auto deg = reader->readScalar();
@@ -30,6 +30,11 @@ public:
 
     void draw(SkCanvas* canvas, SkPicture::AbortCallback*, SkReadBuffer* buffer);
 
+    // Draws ops that continue ones drawn earlier into the same canvas, e.g. a chunk of a picture
+    // stream. Unlike draw(), saves are left open, setMatrix() is relative to 'initialMatrix', and
+    // restores never go below 'minSaveCount'. Returns false if the ops are invalid.
+    bool drawContinuation(SkCanvas* canvas, const SkM44& initialMatrix, int minSaveCount);
+
     // TODO: remove the curOp calls after cleaning up GrGatherDevice
     // Return the ID of the operation currently being executed when playing
     // back. 0 indicates no call is active.
@@ -42,6 +47,12 @@ private:
     // The offset of the current operation when within the draw method
     size_t fCurOffset;
 
+    // Restores are ignored at or below this save count.
+    int fMinSaveCount = 0;
+
+    // Returns false if the ops are invalid.
+    bool drawOps(SkCanvas*, SkPicture::AbortCallback*, const SkM44& initialMatrix, SkReadBuffer*);
+
     void handleOp(SkReadBuffer* reader,
                   DrawType op,
                   uint32_t size,
@@ -46,6 +46,9 @@ public:
         pic->fAddedToCache.store(true);
     }
 
+    // Returns the header written before the data of a picture with this cull rect.
+    static SkPictInfo MakeHeader(const SkRect& cullRect);
+
     // V35: Store SkRect (rather then width & height) in header
     // V36: Remove (obsolete) alphatype from SkColorTable
     // V37: Added shadow only option to SkDropShadowImageFilter (last version to record CLEAR)
@@ -115,6 +118,8 @@ public:
     // V102: Convolution image filter uses ::Crop to apply tile mode
     // V103: Remove deprecated per-image filter crop rect
     // v104: SaveLayer supports multiple image filters
+    // v105: Streams pad op data and the flattened buffer so they can be read in place
+    // v106: Text blobs pack glyphs and positions, and don't repeat the previous run's font
 
     enum Version {
         kPictureShaderFilterParam_Version   = 82,
@@ -140,6 +145,8 @@ public:
         kConvolutionImageFilterTilingUpdate = 102,
         kRemoveDeprecatedCropRect           = 103,
         kMultipleFiltersOnSaveLayer         = 104,
+        kAlignedStreamPayloads              = 105,
+        kCompactTextBlobs                   = 106,
 
         // Only SKPs within the min/current picture version range (inclusive) can be read.
         //
@@ -164,7 +171,7 @@ public:
         //
         // Contact the Infra Gardener if the above steps do not work for you.
         kMin_Version     = kPictureShaderFilterParam_Version,
-        kCurrent_Version = kMultipleFiltersOnSaveLayer
+        kCurrent_Version = kCompactTextBlobs
     };
 };
 
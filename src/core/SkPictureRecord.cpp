@@ -59,7 +59,9 @@ void SkPictureRecord::willSave() {
     // record the offset to us, making it non-positive to distinguish a save
     // from a clip entry.
     fRestoreOffsetStack.push_back(-(int32_t)fWriter.bytesWritten());
-    this->recordSave();
+    if (fRecordSaves) {
+        this->recordSave();
+    }
 
     this->SkCanvasVirtualEnforcer<SkCanvas>::willSave();
 }
@@ -305,6 +307,15 @@ void SkPictureRecord::endRecording() {
     this->restoreToCount(fInitialSaveCount);
 }
 
+void SkPictureRecord::beginContinuation(int openSaves) {
+    SkASSERT(kNoInitialSave == fInitialSaveCount);
+    fRecordSaves = false;
+    for (int i = 0; i < openSaves; ++i) {
+        this->save();
+    }
+    fRecordSaves = true;
+}
+
 size_t SkPictureRecord::recordRestoreOffsetPlaceholder() {
     if (fRestoreOffsetStack.empty()) {
         return -1;
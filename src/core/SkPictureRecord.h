@@ -114,6 +114,11 @@ public:
     void beginRecording();
     void endRecording();
 
+    // Instead of beginRecording() and endRecording(), records ops that continue ones recorded
+    // elsewhere, inside 'openSaves' saves opened by those. Their restores are recorded, but not the
+    // saves themselves, and saves opened by these ops are left open.
+    void beginContinuation(int openSaves);
+
 protected:
     void addNoOp();
 
@@ -288,6 +293,7 @@ private:
 
     uint32_t fRecordFlags;
     int      fInitialSaveCount;
+    bool     fRecordSaves = true;
 
     friend class SkPictureData;   // for SkPictureData's SkPictureRecord-based constructor
 };
@@ -40,7 +40,16 @@ SkCanvas* SkPictureRecorder::beginRecording(const SkRect& userCullRect,
     fBBH = std::move(bbh);
 
     if (!fRecord) {
-        fRecord.reset(new SkRecord);
+        if (fRecycledRecord && fRecycledRecord->unique()) {
+            // Whatever we handed this out to is gone, so its storage is ours to reuse.
+            fRecord = std::move(fRecycledRecord);
+            fRecord->reset();
+        } else if (fRecycledRecord) {
+            fRecord = sk_make_sp<SkRecord>(fRecycledRecord->count(), fRecycledRecord->bytesUsed());
+            fRecycledRecord = nullptr;
+        } else {
+            fRecord.reset(new SkRecord);
+        }
     }
     fRecorder->reset(fRecord.get(), cullRect);
     fActivelyRecording = true;
@@ -51,6 +60,13 @@ SkCanvas* SkPictureRecorder::beginRecording(const SkRect& bounds, SkBBHFactory*
     return this->beginRecording(bounds, factory ? (*factory)() : nullptr);
 }
 
+void SkPictureRecorder::setRecycleStorage(bool recycle) {
+    fRecycleStorage = recycle;
+    if (!recycle) {
+        fRecycledRecord = nullptr;
+    }
+}
+
 SkCanvas* SkPictureRecorder::getRecordingCanvas() {
     return fActivelyRecording ? fRecorder.get() : nullptr;
 }
@@ -101,6 +117,9 @@ sk_sp<SkPicture> SkPictureRecorder::finishRecordingAsPicture() {
     for (int i = 0; pictList && i < pictList->count(); i++) {
         subPictureBytes += pictList->begin()[i]->approximateBytesUsed();
     }
+    if (fRecycleStorage) {
+        fRecycledRecord = fRecord;
+    }
     return sk_make_sp<SkBigPicture>(fCullRect,
                                     std::move(fRecord),
                                     std::move(pictList),
@@ -142,6 +161,9 @@ sk_sp<SkDrawable> SkPictureRecorder::finishRecordingAsDrawable() {
         fBBH->insert(bounds.data(), meta, fRecord->count());
     }
 
+    if (fRecycleStorage) {
+        fRecycledRecord = fRecord;
+    }
     sk_sp<SkDrawable> drawable =
          sk_make_sp<SkRecordedDrawable>(std::move(fRecord), std::move(fBBH),
                                         fRecorder->detachDrawableList(), fCullRect);
@@ -0,0 +1,89 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/core/SkPixelAllocator.h"
+
+#include "include/core/SkTypes.h"
+#include "include/private/base/SkAlign.h"
+#include "include/private/base/SkMutex.h"
+
+#include <atomic>
+#include <cstdint>
+
+#if (defined(SK_BUILD_FOR_UNIX) || defined(SK_BUILD_FOR_ANDROID)) && !defined(__EMSCRIPTEN__)
+    #include <sys/mman.h>
+    #define SK_HUGE_PAGES_SUPPORTED
+#endif
+
+static SkMutex& allocator_mutex() {
+    static SkMutex& mutex = *(new SkMutex);
+    return mutex;
+}
+
+static SkGraphics::RasterPixelAllocator gAllocator SK_GUARDED_BY(allocator_mutex());
+// Lets smaller allocations skip the lock. SIZE_MAX if no allocator is set.
+static std::atomic<size_t> gMinBytes{SIZE_MAX};
+
+SkGraphics::RasterPixelAllocator SkPixelAllocator::Get(size_t bytes) {
+    if (bytes < gMinBytes.load(std::memory_order_relaxed)) {
+        return {};
+    }
+    SkAutoMutexExclusive lock(allocator_mutex());
+    return bytes >= gAllocator.fMinBytes ? gAllocator : SkGraphics::RasterPixelAllocator{};
+}
+
+SkGraphics::RasterPixelAllocator SkPixelAllocator::Set(
+        const SkGraphics::RasterPixelAllocator& allocator) {
+    SkAutoMutexExclusive lock(allocator_mutex());
+    const SkGraphics::RasterPixelAllocator prev = gAllocator;
+    gAllocator = allocator;
+    gMinBytes.store(allocator.fAlloc ? allocator.fMinBytes : SIZE_MAX, std::memory_order_relaxed);
+    return prev;
+}
+
+#if defined(SK_HUGE_PAGES_SUPPORTED)
+
+// The transparent huge page size on x86-64, and on ARM64 with 4KB base pages.
+static constexpr size_t kHugePageSize = 2 * 1024 * 1024;
+
+void* SkPixelAllocator::HugePageAlloc(size_t bytes, void*) {
+    if (bytes == 0 || bytes > SIZE_MAX - 2 * kHugePageSize) {
+        return nullptr;
+    }
+    // Over-allocate by a huge page, then trim the ends so what's left is aligned to one.
+    const size_t size = SkAlignTo(bytes, kHugePageSize);
+    void* addr = mmap(nullptr, size + kHugePageSize, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (addr == MAP_FAILED) {
+        return nullptr;
+    }
+    char* start = static_cast<char*>(addr);
+    char* aligned = reinterpret_cast<char*>(
+            SkAlignTo(reinterpret_cast<uintptr_t>(start), kHugePageSize));
+    if (aligned > start) {
+        munmap(start, aligned - start);
+    }
+    if (char* end = start + size + kHugePageSize; end > aligned + size) {
+        munmap(aligned + size, end - (aligned + size));
+    }
+    // Only a hint: with THP disabled the memory is still usable, just with normal pages. The pages
+    // are left untouched (and so zero), so each one is placed on the NUMA node of the thread that
+    // first writes to it.
+    madvise(aligned, size, MADV_HUGEPAGE);
+    return aligned;
+}
+
+void SkPixelAllocator::HugePageFree(void* pixels, size_t bytes, void*) {
+    munmap(pixels, SkAlignTo(bytes, kHugePageSize));
+}
+
+#else
+
+void* SkPixelAllocator::HugePageAlloc(size_t, void*) { return nullptr; }
+void SkPixelAllocator::HugePageFree(void*, size_t, void*) { SkDEBUGFAIL("never allocated"); }
+
+#endif  // SK_HUGE_PAGES_SUPPORTED
@@ -0,0 +1,33 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkPixelAllocator_DEFINED
+#define SkPixelAllocator_DEFINED
+
+#include "include/core/SkGraphics.h"
+
+#include <cstddef>
+
+/**
+ *  The allocator set by SkGraphics::SetRasterPixelAllocator(), which SkMallocPixelRef::
+ *  MakeAllocate() uses for large pixel allocations.
+ */
+namespace SkPixelAllocator {
+    // Returns the allocator to use for 'bytes' of pixels. Its fAlloc is null if they should be
+    // allocated with sk_calloc.
+    SkGraphics::RasterPixelAllocator Get(size_t bytes);
+
+    SkGraphics::RasterPixelAllocator Set(const SkGraphics::RasterPixelAllocator&);
+
+    // Memory aligned to and padded to huge pages, which the kernel is asked to back with
+    // transparent huge pages. Only Linux and Android support this; elsewhere HugePageAlloc()
+    // returns null.
+    void* HugePageAlloc(size_t bytes, void* ctx);
+    void  HugePageFree(void* pixels, size_t bytes, void* ctx);
+}  // namespace SkPixelAllocator
+
+#endif  // SkPixelAllocator_DEFINED
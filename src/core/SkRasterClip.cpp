@@ -13,6 +13,7 @@
 #include "include/core/SkPath.h"
 #include "include/core/SkScalar.h"
 #include "include/private/base/SkDebug.h"
+#include "src/core/SkClipMaskCache.h"
 #include "src/core/SkRegionPriv.h"
 
 class SkBlitter;
@@ -154,7 +155,7 @@ bool SkRasterClip::op(const SkRect& localRect, const SkMatrix& matrix, SkClipOp
 
     const bool isScaleTrans = matrix.isScaleTranslate();
     if (!isScaleTrans) {
-        return this->op(SkPath::Rect(localRect), matrix, op, doAA);
+        return this->op(SkPath::Rect(localRect).setIsVolatile(true), matrix, op, doAA);
     }
 
     SkRect devRect = matrix.mapRect(localRect);
@@ -179,31 +180,33 @@ bool SkRasterClip::op(const SkRect& localRect, const SkMatrix& matrix, SkClipOp
 }
 
 bool SkRasterClip::op(const SkRRect& rrect, const SkMatrix& matrix, SkClipOp op, bool doAA) {
-    return this->op(SkPath::RRect(rrect), matrix, op, doAA);
+    return this->op(SkPath::RRect(rrect).setIsVolatile(true), matrix, op, doAA);
 }
 
 bool SkRasterClip::op(const SkPath& path, const SkMatrix& matrix, SkClipOp op, bool doAA) {
     AUTO_RASTERCLIP_VALIDATE(*this);
 
-    SkPath devPath;
-    path.transform(matrix, &devPath);
-
     // Since op is either intersect or difference, the clip is always shrinking; that means we can
     // always use our current bounds as the limiting factor for region/aaclip operations.
     if (this->isRect() && op == SkClipOp::kIntersect) {
         // However, in the relatively common case of intersecting a new path with a rectangular
         // clip, it's faster to convert the path into a region/aa-mask in place than evaluate the
         // actual intersection. See skbug.com/12398
+        // The result only depends on the path, matrix and bounds, so a clip that is set the same
+        // way every frame can reuse its mask from the last one.
         if (doAA && fIsBW) {
             this->convertToAA();
         }
+        const SkIRect bounds = this->getBounds();
         if (fIsBW) {
-            fBW.setPath(devPath, SkRegion(this->getBounds()));
+            SkClipMaskCache::SetPath(&fBW, path, matrix, bounds);
         } else {
-            fAA.setPath(devPath, this->getBounds(), doAA);
+            SkClipMaskCache::SetPath(&fAA, path, matrix, bounds, doAA);
         }
         return this->updateCacheAndReturnNonEmpty();
     } else {
+        SkPath devPath;
+        path.transform(matrix, &devPath);
         return this->op(SkRasterClip(devPath, this->getBounds(), doAA), op);
     }
 }
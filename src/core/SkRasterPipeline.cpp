@@ -14,8 +14,10 @@
 #include "include/private/base/SkTemplates.h"
 #include "modules/skcms/skcms.h"
 #include "src/base/SkVx.h"
+#include "src/core/SkDrawStatsSink.h"
 #include "src/core/SkImageInfoPriv.h"
 #include "src/core/SkOpts.h"
+#include "src/core/SkRasterPipelineCache.h"
 #include "src/core/SkRasterPipelineOpContexts.h"
 #include "src/core/SkRasterPipelineOpList.h"
 
@@ -27,6 +29,7 @@ using namespace skia_private;
 using Op = SkRasterPipelineOp;
 
 bool gForceHighPrecisionRasterPipeline;
+bool gDisableRasterPipelineStageFusion;
 
 SkRasterPipeline::SkRasterPipeline(SkArenaAlloc* alloc) : fAlloc(alloc) {
     this->reset();
@@ -550,10 +553,69 @@ static void prepend_to_pipeline(SkRasterPipelineStage*& ip, SkOpts::StageFn stag
     ip->ctx = ctx;
 }
 
+// Sequences of ops that have a fused op running all of them in one stage. A sequence must be listed
+// before any shorter sequence that is a prefix of it.
+struct StageFusion {
+    Op  fused;
+    int numOps;
+    Op  ops[4];
+};
+static constexpr StageFusion kStageFusions[] = {
+    {Op::fused_load_8888_srcover_store_8888, 4,
+     {Op::load_8888, Op::load_8888_dst, Op::srcover, Op::store_8888}},
+    {Op::fused_bilerp_clamp_8888_srcover_store_8888, 4,
+     {Op::bilerp_clamp_8888, Op::load_8888_dst, Op::srcover, Op::store_8888}},
+    {Op::fused_load_8888_dst_srcover_store_8888, 3,
+     {Op::load_8888_dst, Op::srcover, Op::store_8888}},
+    {Op::fused_seed_shader_matrix_2x3, 2,
+     {Op::seed_shader, Op::matrix_2x3}},
+#define M(first, second) {Op::fused_##first##_##second, 2, {Op::first, Op::second}},
+    SK_RASTER_PIPELINE_SKSL_FUSIONS(M)
+#undef M
+};
+
+// Rewrites an assembled program so each fusable sequence of stages starts with its fused stage.
+// The fused stage reads the contexts of the stages it replaces from their slots and then skips
+// over them, so the other slots are left untouched.
+static void fuse_stages(const SkRasterPipeline::StageList* stages,
+                        int numStages,
+                        SkRasterPipelineStage* program,
+                        const SkOpts::StageFn* opTable,
+                        int opTableSize) {
+    if (gDisableRasterPipelineStageFusion) {
+        return;
+    }
+    AutoSTArray<32, Op> ops(numStages);
+    int index = numStages;
+    for (const SkRasterPipeline::StageList* st = stages; st; st = st->prev) {
+        ops[--index] = st->stage;
+    }
+
+    for (int i = 0; i < numStages; ++i) {
+        for (const StageFusion& fusion : kStageFusions) {
+            if (i + fusion.numOps <= numStages &&
+                std::equal(fusion.ops, fusion.ops + fusion.numOps, &ops[i]) &&
+                (int)fusion.fused < opTableSize && opTable[(int)fusion.fused]) {
+                program[i].fn = opTable[(int)fusion.fused];
+                i += fusion.numOps - 1;
+                break;
+            }
+        }
+    }
+}
+
 bool SkRasterPipeline::buildLowpPipeline(SkRasterPipelineStage* ip) const {
     if (gForceHighPrecisionRasterPipeline || fRewindCtx) {
         return false;
     }
+    // The SkSL ops only run in lowp when an SkSL program set up its slots for lowp.
+    bool hasLowpSlots = false;
+    for (const StageList* st = fStages; st; st = st->prev) {
+        if (st->stage == Op::set_lowp_base_pointer) {
+            hasLowpSlots = true;
+            break;
+        }
+    }
     // Stages are stored backwards in fStages; to compensate, we assemble the pipeline in reverse
     // here, back to front.
     prepend_to_pipeline(ip, SkOpts::just_return_lowp, /*ctx=*/nullptr);
@@ -563,8 +625,12 @@ bool SkRasterPipeline::buildLowpPipeline(SkRasterPipelineStage* ip) const {
             // This program contains a stage that doesn't exist in lowp.
             return false;
         }
+        if (opIndex >= kFirstRasterPipelineSkSLLowpOp && !hasLowpSlots) {
+            return false;
+        }
         prepend_to_pipeline(ip, SkOpts::ops_lowp[opIndex], st->ctx);
     }
+    fuse_stages(fStages, fNumStages, ip, SkOpts::ops_lowp, kNumRasterPipelineLowpOps);
     return true;
 }
 
@@ -575,11 +641,12 @@ void SkRasterPipeline::buildHighpPipeline(SkRasterPipelineStage* ip) const {
         int opIndex = (int)st->stage;
         prepend_to_pipeline(ip, SkOpts::ops_highp[opIndex], st->ctx);
     }
+    fuse_stages(fStages, fNumStages, ip, SkOpts::ops_highp, kNumRasterPipelineHighpOps);
 
     // stack_checkpoint and stack_rewind are only implemented in highp. We only need these stages
-    // when generating long (or looping) pipelines from SkSL. The other stages used by the SkSL
-    // Raster Pipeline generator will only have highp implementations, because we can't execute SkSL
-    // code without floating point.
+    // when generating long (or looping) pipelines from SkSL. Most of the other stages used by the
+    // SkSL Raster Pipeline generator only have highp implementations; the few that exist in lowp
+    // still run their math on highp float slots (see SK_RASTER_PIPELINE_OPS_SKSL_LOWP).
     if (fRewindCtx) {
         const int rewindIndex = (int)Op::stack_checkpoint;
         prepend_to_pipeline(ip, SkOpts::ops_highp[rewindIndex], fRewindCtx);
@@ -596,6 +663,37 @@ SkRasterPipeline::StartPipelineFn SkRasterPipeline::buildPipeline(SkRasterPipeli
     return SkOpts::start_pipeline_highp;
 }
 
+SkRasterPipeline::StartPipelineFn SkRasterPipeline::buildCachedPipeline(
+        SkRasterPipelineStage* program, int stagesNeeded) const {
+    AutoSTArray<32, Op> ops(fNumStages);
+    int index = fNumStages;
+    for (const StageList* st = fStages; st; st = st->prev) {
+        ops[--index] = st->stage;
+    }
+    SkSpan<const Op> opSpan{ops.get(), ops.size()};
+
+    SkRasterPipelineCache* cache = SkRasterPipelineCache::Global();
+    const uint64_t key = SkRasterPipelineCache::Key(opSpan);
+    if (StartPipelineFn start = cache->find(key, opSpan, program, stagesNeeded)) {
+        // The cached program has the same layout buildPipeline() produces, so we only need to
+        // bind our own contexts, back to front.
+        SkRasterPipelineStage* ip = program + stagesNeeded;
+        (--ip)->ctx = nullptr;  // just_return
+        for (const StageList* st = fStages; st; st = st->prev) {
+            (--ip)->ctx = st->ctx;
+        }
+        if (fRewindCtx) {
+            (--ip)->ctx = fRewindCtx;  // stack_checkpoint
+        }
+        SkASSERT(ip == program);
+        return start;
+    }
+
+    StartPipelineFn start = this->buildPipeline(program + stagesNeeded);
+    cache->add(key, opSpan, program, stagesNeeded, start);
+    return start;
+}
+
 int SkRasterPipeline::stagesNeeded() const {
     // Add 1 to budget for a `just_return` stage at the end.
     int stages = fNumStages + 1;
@@ -626,6 +724,7 @@ void SkRasterPipeline::run(size_t x, size_t y, size_t w, size_t h) const {
     }
 
     auto start_pipeline = this->buildPipeline(program.get() + stagesNeeded);
+    SkDrawStatsSink::NoteRasterPipeline(start_pipeline == SkOpts::start_pipeline_lowp);
     start_pipeline(x, y, x + w, y + h, program.get(),
                    SkSpan{patches.data(), numMemoryCtxs},
                    fTailPointer);
@@ -650,7 +749,8 @@ std::function<void(size_t, size_t, size_t, size_t)> SkRasterPipeline::compile()
     }
     uint8_t* tailPointer = fTailPointer;
 
-    auto start_pipeline = this->buildPipeline(program + stagesNeeded);
+    auto start_pipeline = this->buildCachedPipeline(program, stagesNeeded);
+    SkDrawStatsSink::NoteRasterPipeline(start_pipeline == SkOpts::start_pipeline_lowp);
     return [=](size_t x, size_t y, size_t w, size_t h) {
         start_pipeline(x, y, x + w, y + h, program,
                        SkSpan{patches, numMemoryCtxs},
@@ -144,6 +144,9 @@ private:
                                      SkSpan<SkRasterPipeline_MemoryCtxPatch>,
                                      uint8_t*);
     StartPipelineFn buildPipeline(SkRasterPipelineStage*) const;
+    // Like buildPipeline(), but reuses the stage functions of an identical earlier program from
+    // SkRasterPipelineCache when there is one. `program` points at the first of `stagesNeeded`.
+    StartPipelineFn buildCachedPipeline(SkRasterPipelineStage* program, int stagesNeeded) const;
 
     void uncheckedAppend(SkRasterPipelineOp, void*);
     int stagesNeeded() const;
@@ -0,0 +1,131 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/core/SkRasterPipelineCache.h"
+
+#include "include/private/base/SkTo.h"
+#include "src/core/SkChecksum.h"
+#include "src/core/SkRasterPipeline.h"
+
+#include <algorithm>
+#include <utility>
+
+extern bool gForceHighPrecisionRasterPipeline;
+extern bool gDisableRasterPipelineStageFusion;
+
+// The blitter compiles three to five pipelines per draw, so this holds the pipelines of a few
+// hundred distinct paints.
+static constexpr int kDefaultCountLimit = 512;
+
+SkRasterPipelineCache* SkRasterPipelineCache::Global() {
+    static SkRasterPipelineCache* cache = new SkRasterPipelineCache(kDefaultCountLimit);
+    return cache;
+}
+
+SkRasterPipelineCache::SkRasterPipelineCache(int countLimit) {
+    this->setShardLimits(countLimit);
+}
+
+void SkRasterPipelineCache::setShardLimits(int countLimit) {
+    fCountLimit.store(countLimit, std::memory_order_relaxed);
+    for (int i = 0; i < kShardCount; ++i) {
+        Shard& shard = fShards[i];
+        SkAutoMutexExclusive lock(shard.fMutex);
+        shard.fPrograms.setMaxCount(countLimit / kShardCount + (i < countLimit % kShardCount));
+    }
+}
+
+uint64_t SkRasterPipelineCache::Key(SkSpan<const SkRasterPipelineOp> ops) {
+    // SkOpts::Init() swaps in different stage functions, so the key covers which ones are live.
+    uint64_t seed = reinterpret_cast<uintptr_t>(SkOpts::start_pipeline_highp);
+    seed = seed * 4 + (gForceHighPrecisionRasterPipeline ? 2 : 0)
+                    + (gDisableRasterPipelineStageFusion ? 1 : 0);
+    return SkChecksum::Hash64(ops.data(), ops.size_bytes(), seed);
+}
+
+SkRasterPipelineCache::StartPipelineFn SkRasterPipelineCache::find(
+        uint64_t key,
+        SkSpan<const SkRasterPipelineOp> ops,
+        SkRasterPipelineStage* program,
+        int numStages) {
+    Shard& shard = this->shard(key);
+    {
+        SkAutoMutexExclusive lock(shard.fMutex);
+        const Program* cached = shard.fPrograms.find(key);
+        // Keys are hashes, so make sure this really is the same program.
+        if (cached && cached->fStageFns.size() == numStages &&
+            std::equal(ops.begin(), ops.end(), cached->fOps.begin(), cached->fOps.end())) {
+            for (int i = 0; i < numStages; ++i) {
+                program[i].fn = cached->fStageFns[i];
+            }
+            shard.fHits.fetch_add(1, std::memory_order_relaxed);
+            return cached->fStart;
+        }
+    }
+    shard.fMisses.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+}
+
+void SkRasterPipelineCache::add(uint64_t key,
+                                SkSpan<const SkRasterPipelineOp> ops,
+                                const SkRasterPipelineStage* program,
+                                int numStages,
+                                StartPipelineFn start) {
+    Program built;
+    built.fOps.push_back_n(SkToInt(ops.size()), ops.data());
+    built.fStageFns.reserve_exact(numStages);
+    for (int i = 0; i < numStages; ++i) {
+        built.fStageFns.push_back(program[i].fn);
+    }
+    built.fStart = start;
+
+    Shard& shard = this->shard(key);
+    SkAutoMutexExclusive lock(shard.fMutex);
+    shard.fPrograms.insert_or_update(key, std::move(built));
+}
+
+int SkRasterPipelineCache::getCountUsed() {
+    int count = 0;
+    for (Shard& shard : fShards) {
+        SkAutoMutexExclusive lock(shard.fMutex);
+        count += shard.fPrograms.count();
+    }
+    return count;
+}
+
+int SkRasterPipelineCache::getCountLimit() {
+    return fCountLimit.load(std::memory_order_relaxed);
+}
+
+int SkRasterPipelineCache::setCountLimit(int count) {
+    const int prev = this->getCountLimit();
+    this->setShardLimits(std::max(count, 0));
+    return prev;
+}
+
+uint64_t SkRasterPipelineCache::getHitCount() const {
+    uint64_t hits = 0;
+    for (const Shard& shard : fShards) {
+        hits += shard.fHits.load(std::memory_order_relaxed);
+    }
+    return hits;
+}
+
+uint64_t SkRasterPipelineCache::getMissCount() const {
+    uint64_t misses = 0;
+    for (const Shard& shard : fShards) {
+        misses += shard.fMisses.load(std::memory_order_relaxed);
+    }
+    return misses;
+}
+
+void SkRasterPipelineCache::purgeAll() {
+    for (Shard& shard : fShards) {
+        SkAutoMutexExclusive lock(shard.fMutex);
+        shard.fPrograms.reset();
+    }
+}
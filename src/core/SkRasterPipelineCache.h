@@ -0,0 +1,100 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkRasterPipelineCache_DEFINED
+#define SkRasterPipelineCache_DEFINED
+
+#include "include/private/base/SkMutex.h"
+#include "include/private/base/SkSpan_impl.h"
+#include "include/private/base/SkTArray.h"
+#include "include/private/base/SkThreadAnnotations.h"
+#include "src/core/SkLRUCache.h"
+#include "src/core/SkOpts.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+struct SkRasterPipelineStage;
+
+/**
+ *  A process-wide cache of assembled SkRasterPipeline programs, keyed by their sequence of ops
+ *  and the global flags that affect how a program is built. A compile() that hits the cache copies
+ *  the cached stage functions and only binds the new pipeline's contexts, skipping the lowp/highp
+ *  decision, the per-stage table lookups, and stage fusion.
+ *
+ *  Every draw looks its pipelines up, often from several threads at once, so the programs are
+ *  split by key across shards that each have their own lock and their own share of the limit.
+ */
+class SkRasterPipelineCache {
+public:
+    using StartPipelineFn = void (*)(size_t, size_t, size_t, size_t,
+                                     SkRasterPipelineStage* program,
+                                     SkSpan<SkRasterPipeline_MemoryCtxPatch>,
+                                     uint8_t*);
+
+    static SkRasterPipelineCache* Global();
+
+    explicit SkRasterPipelineCache(int countLimit);
+
+    // Computes the key for a program made of these ops, built with the current global flags.
+    static uint64_t Key(SkSpan<const SkRasterPipelineOp> ops);
+
+    // On a hit, copies the cached stage functions into the `fn` of each stage of `program` and
+    // returns the start function the program was built for. Returns nullptr on a miss.
+    StartPipelineFn find(uint64_t key,
+                         SkSpan<const SkRasterPipelineOp> ops,
+                         SkRasterPipelineStage* program,
+                         int numStages);
+
+    // Remembers the stage functions of a freshly built program.
+    void add(uint64_t key,
+             SkSpan<const SkRasterPipelineOp> ops,
+             const SkRasterPipelineStage* program,
+             int numStages,
+             StartPipelineFn start);
+
+    int getCountUsed();
+    int getCountLimit();
+    int setCountLimit(int count);
+    uint64_t getHitCount() const;
+    uint64_t getMissCount() const;
+
+    void purgeAll();
+
+private:
+    struct Program {
+        skia_private::TArray<SkRasterPipelineOp> fOps;
+        skia_private::TArray<SkOpts::StageFn>    fStageFns;
+        StartPipelineFn                          fStart;
+    };
+
+    static constexpr int kShardCount = 16;
+
+    // Each on its own cache line, so that threads using different shards don't slow each other.
+    struct alignas(64) Shard {
+        Shard() : fPrograms(0) {}
+
+        SkMutex fMutex;
+        SkLRUCache<uint64_t, Program> fPrograms SK_GUARDED_BY(fMutex);
+
+        std::atomic<uint64_t> fHits{0};
+        std::atomic<uint64_t> fMisses{0};
+    };
+
+    // The top bits of the key pick the shard.
+    static_assert(kShardCount == 16);
+    Shard& shard(uint64_t key) { return fShards[key >> 60]; }
+
+    // Splits the limit between the shards.
+    void setShardLimits(int countLimit);
+
+    std::atomic<int> fCountLimit{0};
+    Shard fShards[kShardCount];
+};
+
+#endif  // SkRasterPipelineCache_DEFINED
@@ -72,6 +72,19 @@ struct SkRasterPipeline_GatherCtx {
     bool        roundDownAtInteger = false;
 };
 
+// Indexed by SkYUVAInfo::YUVAChannels. Each pointer is offset to the channel's byte within its
+// plane's pixels, and pixels[3] is null when the image has no alpha.
+struct SkRasterPipeline_YUVACtx {
+    const uint8_t* pixels[4];
+    int            stride[4];         // in bytes
+    int            bytesPerPixel[4];
+    float          width[4];
+    float          height[4];
+    float          scaleX[4];         // plane width / image width
+    float          scaleY[4];         // plane height / image height
+    bool           linear;
+};
+
 // State shared by save_xy, accumulate, and bilinear_* / bicubic_*.
 struct SkRasterPipeline_SamplerCtx {
     float      x[SkRasterPipeline_kMaxStride_highp];
@@ -182,6 +195,15 @@ struct SkRasterPipeline_EvenlySpaced2StopGradientCtx {
     float b[4];
 };
 
+// A gradient baked into premul 8888 colors in the destination color space. Entries 1 through
+// lastIndex-1 sample t evenly over [0,1]; entries 0 and lastIndex hold the colors for t < 0 and
+// t > 1, which differ from the end colors when there are hard stops at 0 or 1.
+struct SkRasterPipeline_GradientLUTCtx {
+    const uint32_t* table;
+    float scale;  // lastIndex - 2
+    uint32_t lastIndex;
+};
+
 struct SkRasterPipeline_2PtConicalCtx {
     uint32_t fMask[SkRasterPipeline_kMaxStride_highp];
     float    fP0,
@@ -202,6 +224,13 @@ struct SkRasterPipeline_TablesCtx {
     const uint8_t *r, *g, *b, *a;
 };
 
+// `table` holds size^3 premul RGBA colors, with red varying fastest and blue slowest. The lut_3D
+// stage looks up the (unpremul) input RGB, and scales the result by the input alpha.
+struct SkRasterPipeline_Lut3DCtx {
+    const float* table;
+    int size;  // at least 2
+};
+
 using SkRPOffset = uint32_t;
 
 struct SkRasterPipeline_InitLaneMasksCtx {
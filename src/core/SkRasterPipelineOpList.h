@@ -8,6 +8,77 @@
 #ifndef SkRasterPipelineOpList_DEFINED
 #define SkRasterPipelineOpList_DEFINED
 
+// `SK_RASTER_PIPELINE_OPS_FUSED` defines ops which each run a common sequence of other ops in one
+// stage. They are never appended directly; SkRasterPipeline swaps them in when it builds a program.
+// A fused op occupies the first of the slots of the ops it replaces, reads each replaced op's
+// context from its own slot, and then jumps past all of them.
+#define SK_RASTER_PIPELINE_OPS_FUSED(M)                            \
+    M(fused_load_8888_dst_srcover_store_8888)                      \
+    M(fused_load_8888_srcover_store_8888)                          \
+    M(fused_bilerp_clamp_8888_srcover_store_8888)                  \
+    M(fused_seed_shader_matrix_2x3)
+
+// `SK_RASTER_PIPELINE_SKSL_FUSIONS` lists pairs of SkSL ops that have a fused op, named
+// `fused_<first>_<second>`. SkSL programs push an operand onto the temp stack and immediately
+// consume it with an arithmetic op, so these pairs make up a large share of typical programs.
+// `SK_RASTER_PIPELINE_OPS_SKSL_FUSED` names the fused ops, which are highp only.
+#define SK_RASTER_PIPELINE_SKSL_FUSIONS_FOR(F, op)                                  \
+    F(copy_uniform,          op##_float)    F(copy_2_uniforms,       op##_2_floats) \
+    F(copy_3_uniforms,       op##_3_floats) F(copy_4_uniforms,       op##_4_floats) \
+    F(copy_slot_unmasked,    op##_float)    F(copy_2_slots_unmasked, op##_2_floats) \
+    F(copy_3_slots_unmasked, op##_3_floats) F(copy_4_slots_unmasked, op##_4_floats)
+
+#define SK_RASTER_PIPELINE_SKSL_FUSIONS(F)        \
+    SK_RASTER_PIPELINE_SKSL_FUSIONS_FOR(F, add)   \
+    SK_RASTER_PIPELINE_SKSL_FUSIONS_FOR(F, sub)   \
+    SK_RASTER_PIPELINE_SKSL_FUSIONS_FOR(F, mul)   \
+    SK_RASTER_PIPELINE_SKSL_FUSIONS_FOR(F, div)
+
+#define SK_RASTER_PIPELINE_OPS_SKSL_FUSED_FOR(M, op)                                              \
+    M(fused_copy_uniform_##op##_float)           M(fused_copy_2_uniforms_##op##_2_floats)         \
+    M(fused_copy_3_uniforms_##op##_3_floats)     M(fused_copy_4_uniforms_##op##_4_floats)         \
+    M(fused_copy_slot_unmasked_##op##_float)     M(fused_copy_2_slots_unmasked_##op##_2_floats)   \
+    M(fused_copy_3_slots_unmasked_##op##_3_floats)                                                \
+    M(fused_copy_4_slots_unmasked_##op##_4_floats)
+
+#define SK_RASTER_PIPELINE_OPS_SKSL_FUSED(M)      \
+    SK_RASTER_PIPELINE_OPS_SKSL_FUSED_FOR(M, add) \
+    SK_RASTER_PIPELINE_OPS_SKSL_FUSED_FOR(M, sub) \
+    SK_RASTER_PIPELINE_OPS_SKSL_FUSED_FOR(M, mul) \
+    SK_RASTER_PIPELINE_OPS_SKSL_FUSED_FOR(M, div)
+
+// `SK_RASTER_PIPELINE_OPS_SKSL_LOWP` defines the SkSL ops that also have a lowp implementation.
+// SkSL slots always hold floats, laid out for the highp stride; a lowp program's slot data holds a
+// copy of every slot for each highp-sized part of the lowp stride, and the lowp ops run the highp
+// math once per copy. A program only uses these ops in lowp when RP::Program can show that it
+// doesn't need more than lowp's range and precision (see RP::Program::canRunInLowp). Those
+// programs start with `set_lowp_base_pointer`, and move colors in and out of their slots with
+// `store_src_slots`, `store_dst_slots` and `load_src_slots`; every other program starts with the
+// highp-only `set_base_pointer`. A pipeline without `set_lowp_base_pointer` never runs these ops in
+// lowp, since their slots wouldn't have the lowp layout.
+#define SK_RASTER_PIPELINE_OPS_SKSL_LOWP(M)                                                     \
+    M(set_lowp_base_pointer) M(init_lane_masks)                                                 \
+    M(store_src_slots) M(store_dst_slots) M(load_src_slots)                                     \
+    M(copy_uniform)     M(copy_2_uniforms)     M(copy_3_uniforms)     M(copy_4_uniforms)        \
+    M(copy_constant)    M(splat_2_constants)   M(splat_3_constants)   M(splat_4_constants)      \
+    M(copy_slot_unmasked)          M(copy_2_slots_unmasked)                                     \
+    M(copy_3_slots_unmasked)       M(copy_4_slots_unmasked)                                     \
+    M(copy_immutable_unmasked)     M(copy_2_immutables_unmasked)                                \
+    M(copy_3_immutables_unmasked)  M(copy_4_immutables_unmasked)                                \
+    M(swizzle_1) M(swizzle_2) M(swizzle_3) M(swizzle_4)                                         \
+    M(dot_2_floats) M(dot_3_floats) M(dot_4_floats)                                             \
+    M(add_imm_float)                                                                            \
+        M(add_n_floats)   M(add_float)    M(add_2_floats)   M(add_3_floats)   M(add_4_floats)   \
+    M(sub_n_floats)       M(sub_float)    M(sub_2_floats)   M(sub_3_floats)   M(sub_4_floats)   \
+    M(mul_imm_float)                                                                            \
+        M(mul_n_floats)   M(mul_float)    M(mul_2_floats)   M(mul_3_floats)   M(mul_4_floats)   \
+    M(div_n_floats)       M(div_float)    M(div_2_floats)   M(div_3_floats)   M(div_4_floats)   \
+    M(max_imm_float)                                                                            \
+        M(max_n_floats)   M(max_float)    M(max_2_floats)   M(max_3_floats)   M(max_4_floats)   \
+    M(min_imm_float)                                                                            \
+        M(min_n_floats)   M(min_float)    M(min_2_floats)   M(min_3_floats)   M(min_4_floats)   \
+    M(mix_n_floats)       M(mix_float)    M(mix_2_floats)   M(mix_3_floats)   M(mix_4_floats)
+
 // `SK_RASTER_PIPELINE_OPS_LOWP` defines ops that have parallel lowp and highp implementations.
 #define SK_RASTER_PIPELINE_OPS_LOWP(M)                             \
     M(move_src_dst) M(move_dst_src) M(swap_src_dst)                \
@@ -28,6 +99,7 @@
     M(alpha_to_red) M(alpha_to_red_dst)                            \
     M(bt709_luminance_or_luma_to_alpha) M(bt709_luminance_or_luma_to_rgb) \
     M(bilerp_clamp_8888)                                           \
+    M(bicubic_clamp_8888) M(bicubic_repeat_8888)                   \
     M(load_src) M(store_src) M(store_src_a) M(load_dst) M(store_dst) \
     M(scale_u8) M(scale_565) M(scale_1_float) M(scale_native)      \
     M( lerp_u8) M( lerp_565) M( lerp_1_float) M(lerp_native)       \
@@ -47,14 +119,17 @@
     M(evenly_spaced_gradient)                                      \
     M(gradient)                                                    \
     M(evenly_spaced_2_stop_gradient)                               \
+    M(gradient_lut)                                                \
     M(xy_to_unit_angle)                                            \
     M(xy_to_radius)                                                \
     M(emboss)                                                      \
-    M(swizzle)
+    M(swizzle)                                                     \
+    SK_RASTER_PIPELINE_OPS_FUSED(M)                                \
+    SK_RASTER_PIPELINE_OPS_SKSL_LOWP(M)
 
-// `SK_RASTER_PIPELINE_OPS_SKSL` defines ops used by SkSL.
+// `SK_RASTER_PIPELINE_OPS_SKSL` defines the rest of the ops used by SkSL.
 #define SK_RASTER_PIPELINE_OPS_SKSL(M)                                                          \
-    M(init_lane_masks) M(store_device_xy01) M(exchange_src)                                     \
+    M(store_device_xy01) M(exchange_src)                                                        \
     M(load_condition_mask)  M(store_condition_mask)                                             \
     M(merge_condition_mask) M(merge_inv_condition_mask)                                         \
     M(load_loop_mask)       M(store_loop_mask)      M(mask_off_loop_mask)                       \
@@ -88,43 +163,26 @@
     M(asin_float)       M(acos_float)          M(atan_float)          M(atan2_n_floats)         \
     M(sqrt_float)       M(pow_n_floats)        M(exp_float)           M(exp2_float)             \
     M(log_float)        M(log2_float)          M(refract_4_floats)                              \
-    M(copy_uniform)     M(copy_2_uniforms)     M(copy_3_uniforms)     M(copy_4_uniforms)        \
-    M(copy_constant)    M(splat_2_constants)   M(splat_3_constants)   M(splat_4_constants)      \
     M(copy_slot_masked) M(copy_2_slots_masked) M(copy_3_slots_masked) M(copy_4_slots_masked)    \
     M(copy_from_indirect_unmasked) M(copy_from_indirect_uniform_unmasked)                       \
     M(copy_to_indirect_masked)     M(swizzle_copy_to_indirect_masked)                           \
-    M(copy_slot_unmasked)          M(copy_2_slots_unmasked)                                     \
-    M(copy_3_slots_unmasked)       M(copy_4_slots_unmasked)                                     \
-    M(copy_immutable_unmasked)     M(copy_2_immutables_unmasked)                                \
-    M(copy_3_immutables_unmasked)  M(copy_4_immutables_unmasked)                                \
     M(swizzle_copy_slot_masked)    M(swizzle_copy_2_slots_masked)                               \
     M(swizzle_copy_3_slots_masked) M(swizzle_copy_4_slots_masked)                               \
-    M(swizzle_1) M(swizzle_2) M(swizzle_3) M(swizzle_4) M(shuffle)                              \
+    M(shuffle)                                                                                  \
     M(matrix_multiply_2) M(matrix_multiply_3) M(matrix_multiply_4)                              \
-    M(smoothstep_n_floats) M(dot_2_floats) M(dot_3_floats) M(dot_4_floats)                      \
-    M(add_imm_float)                                                                            \
-        M(add_n_floats)   M(add_float)    M(add_2_floats)   M(add_3_floats)   M(add_4_floats)   \
+    M(smoothstep_n_floats)                                                                      \
     M(add_imm_int)                                                                              \
         M(add_n_ints)     M(add_int)      M(add_2_ints)     M(add_3_ints)     M(add_4_ints)     \
-    M(sub_n_floats)       M(sub_float)    M(sub_2_floats)   M(sub_3_floats)   M(sub_4_floats)   \
     M(sub_n_ints)         M(sub_int)      M(sub_2_ints)     M(sub_3_ints)     M(sub_4_ints)     \
-    M(mul_imm_float)                                                                            \
-        M(mul_n_floats)   M(mul_float)    M(mul_2_floats)   M(mul_3_floats)   M(mul_4_floats)   \
     M(mul_imm_int)                                                                              \
         M(mul_n_ints)     M(mul_int)      M(mul_2_ints)     M(mul_3_ints)     M(mul_4_ints)     \
-    M(div_n_floats)       M(div_float)    M(div_2_floats)   M(div_3_floats)   M(div_4_floats)   \
     M(div_n_ints)         M(div_int)      M(div_2_ints)     M(div_3_ints)     M(div_4_ints)     \
     M(div_n_uints)        M(div_uint)     M(div_2_uints)    M(div_3_uints)    M(div_4_uints)    \
-    M(max_imm_float)                                                                            \
-        M(max_n_floats)   M(max_float)    M(max_2_floats)   M(max_3_floats)   M(max_4_floats)   \
     M(max_n_ints)         M(max_int)      M(max_2_ints)     M(max_3_ints)     M(max_4_ints)     \
     M(max_n_uints)        M(max_uint)     M(max_2_uints)    M(max_3_uints)    M(max_4_uints)    \
-    M(min_imm_float)                                                                            \
-        M(min_n_floats)   M(min_float)    M(min_2_floats)   M(min_3_floats)   M(min_4_floats)   \
     M(min_n_ints)         M(min_int)      M(min_2_ints)     M(min_3_ints)     M(min_4_ints)     \
     M(min_n_uints)        M(min_uint)     M(min_2_uints)    M(min_3_uints)    M(min_4_uints)    \
     M(mod_n_floats)       M(mod_float)    M(mod_2_floats)   M(mod_3_floats)   M(mod_4_floats)   \
-    M(mix_n_floats)       M(mix_float)    M(mix_2_floats)   M(mix_3_floats)   M(mix_4_floats)   \
     M(mix_n_ints)         M(mix_int)      M(mix_2_ints)     M(mix_3_ints)     M(mix_4_ints)     \
     M(cmplt_imm_float)                                                                          \
         M(cmplt_n_floats) M(cmplt_float)  M(cmplt_2_floats) M(cmplt_3_floats) M(cmplt_4_floats) \
@@ -146,10 +204,11 @@
         M(cmpne_n_floats) M(cmpne_float)  M(cmpne_2_floats) M(cmpne_3_floats) M(cmpne_4_floats) \
     M(cmpne_imm_int)                                                                            \
         M(cmpne_n_ints)   M(cmpne_int)    M(cmpne_2_ints)   M(cmpne_3_ints)   M(cmpne_4_ints)   \
-    M(trace_line)         M(trace_var)    M(trace_enter)    M(trace_exit)     M(trace_scope)
+    M(trace_line)         M(trace_var)    M(trace_enter)    M(trace_exit)     M(trace_scope)     \
+    SK_RASTER_PIPELINE_OPS_SKSL_FUSED(M)
 
 // `SK_RASTER_PIPELINE_OPS_HIGHP_ONLY` defines ops that are only available in highp; this subset
-// includes all of SkSL.
+// includes most of SkSL.
 #define SK_RASTER_PIPELINE_OPS_HIGHP_ONLY(M)                                   \
     M(callback)                                                                \
     M(stack_checkpoint) M(stack_rewind)                                        \
@@ -169,7 +228,7 @@
     M(gather_10101010_xr) M(load_10101010_xr) M(load_10101010_xr_dst)          \
     M(store_10101010_xr)                                                       \
     M(store_src_rg) M(load_src_rg)                                             \
-    M(byte_tables)                                                             \
+    M(byte_tables) M(lut_3D)                                                   \
     M(colorburn) M(colordodge) M(softlight)                                    \
     M(hue) M(saturation) M(color) M(luminosity)                                \
     M(matrix_3x3) M(matrix_3x4) M(matrix_4x5) M(matrix_4x3)                    \
@@ -183,7 +242,6 @@
     M(mirror_x)   M(repeat_x)                                                  \
     M(mirror_y)   M(repeat_y)                                                  \
     M(negate_x)                                                                \
-    M(bicubic_clamp_8888)                                                      \
     M(bilinear_setup)                                                          \
     M(bilinear_nx) M(bilinear_px) M(bilinear_ny) M(bilinear_py)                \
     M(bicubic_setup)                                                           \
@@ -192,6 +250,7 @@
     M(accumulate)                                                              \
     M(perlin_noise)                                                            \
     M(mipmap_linear_init) M(mipmap_linear_update) M(mipmap_linear_finish)      \
+    M(sample_yuva)                                                             \
     M(xy_to_2pt_conical_strip)                                                 \
     M(xy_to_2pt_conical_focal_on_circle)                                       \
     M(xy_to_2pt_conical_well_behaved)                                          \
@@ -220,6 +279,11 @@ enum class SkRasterPipelineOp {
 #define M(st) +1
     static constexpr int kNumRasterPipelineLowpOps  = SK_RASTER_PIPELINE_OPS_LOWP(M);
     static constexpr int kNumRasterPipelineHighpOps = SK_RASTER_PIPELINE_OPS_ALL(M);
+    static constexpr int kNumRasterPipelineSkSLLowpOps = SK_RASTER_PIPELINE_OPS_SKSL_LOWP(M);
 #undef M
 
+// The SkSL lowp ops are the last of the lowp ops.
+static constexpr int kFirstRasterPipelineSkSLLowpOp =
+        kNumRasterPipelineLowpOps - kNumRasterPipelineSkSLLowpOps;
+
 #endif  // SkRasterPipelineOpList_DEFINED
@@ -19,6 +19,7 @@
 #include "include/core/SkPoint3.h"
 #include "include/core/SkRRect.h"
 #include "include/core/SkRegion.h"
+#include "include/core/SkSerialProcs.h"
 #include "include/core/SkSize.h"
 #include "include/core/SkString.h"
 #include "include/core/SkTypeface.h"
@@ -26,6 +27,7 @@
 #include "src/base/SkAutoMalloc.h"
 #include "src/base/SkMathPriv.h"
 #include "src/base/SkSafeMath.h"
+#include "src/core/SkChecksum.h"
 #include "src/core/SkMatrixPriv.h"
 #include "src/core/SkMipmapBuilder.h"
 #include "src/core/SkWriteBuffer.h"
@@ -88,10 +90,22 @@ void SkReadBuffer::setDeserialProcs(const SkDeserialProcs& procs) {
     this->setAllowSkSL(procs.fAllowSkSL);
 }
 
+uint64_t SkDeserialProcs::Checksum(const void* data, size_t length) {
+    uint64_t hash = SkChecksum::Hash64(data, length);
+    return hash ? hash : 1;
+}
+
+bool SkReadBuffer::trustIfChecksumMatches(uint64_t checksum) {
+    fTrusted = checksum != 0 && checksum == SkDeserialProcs::Checksum(fBase, this->size());
+    return fTrusted;
+}
+
 bool SkReadBuffer::readBool() {
     uint32_t value = this->readUInt();
     // Boolean value should be either 0 or 1
-    this->validate(!(value & ~1));
+    if (!fTrusted) {
+        this->validate(!(value & ~1));
+    }
     return value != 0;
 }
 
@@ -151,7 +165,7 @@ const char* SkReadBuffer::readString(size_t* len) {
     // The string is len characters and a terminating \0.
     const char* c_str = this->skipT<char>(*len+1);
 
-    if (this->validate(c_str && c_str[*len] == '\0')) {
+    if (this->validate(c_str && (fTrusted || c_str[*len] == '\0'))) {
         return c_str;
     }
     return nullptr;
@@ -524,7 +538,7 @@ SkFlattenable* SkReadBuffer::readRawFlattenable() {
         obj = (*factory)(*this);
         // check that we read the amount we expected
         size_t sizeRead = this->offset() - offset;
-        if (sizeRecorded != sizeRead) {
+        if (!fTrusted && sizeRecorded != sizeRead) {
             this->validate(false);
             return nullptr;
         }
@@ -553,7 +567,7 @@ SkFlattenable* SkReadBuffer::readFlattenable(SkFlattenable::Type ft) {
 int32_t SkReadBuffer::checkInt(int32_t min, int32_t max) {
     SkASSERT(min <= max);
     int32_t value = this->read32();
-    if (value < min || value > max) {
+    if (!fTrusted && (value < min || value > max)) {
         this->validate(false);
         value = min;
     }
@@ -98,7 +98,7 @@ public:
 
     template <typename T> T read32LE(T max) {
         uint32_t value = this->readUInt();
-        if (!this->validate(value <= static_cast<uint32_t>(max))) {
+        if (!fTrusted && !this->validate(value <= static_cast<uint32_t>(max))) {
             value = 0;
         }
         return static_cast<T>(value);
@@ -184,6 +184,14 @@ public:
     bool allowSkSL() const { return fAllowSkSL; }
     void setAllowSkSL(bool allow) { fAllowSkSL = allow; }
 
+    // A trusted buffer holds data this process wrote, so reads skip range checks on the values
+    // themselves (booleans, enums, ranged ints, flattenable sizes). Bounds are still checked.
+    bool isTrusted() const { return fTrusted; }
+    void setTrusted(bool trusted) { fTrusted = trusted; }
+
+    // Trusts the whole buffer if checksum is SkDeserialProcs::Checksum() of its contents.
+    bool trustIfChecksumMatches(uint64_t checksum);
+
     /**
      *  If isValid is false, sets the buffer to be "invalid". Returns true if the buffer
      *  is still valid.
@@ -255,6 +263,7 @@ private:
     }
 
     bool fAllowSkSL = true;
+    bool fTrusted = false;
     bool fError = false;
 };
 
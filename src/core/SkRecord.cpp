@@ -8,6 +8,17 @@
 #include "src/core/SkRecord.h"
 
 #include <algorithm>
+#include <new>
+
+static constexpr size_t kMaxStorageSize = 1 << 30;
+
+SkRecord::SkRecord(int countHint, size_t bytesHint) {
+    if (countHint > 0) {
+        fReserved = countHint;
+        fRecords.reset(fReserved);
+    }
+    this->resetAlloc(bytesHint);
+}
 
 SkRecord::~SkRecord() {
     Destroyer destroyer;
@@ -20,6 +31,7 @@ void SkRecord::grow() {
     SkASSERT(fCount == fReserved);
     fReserved = fReserved ? fReserved * 2 : 4;
     fRecords.realloc(fReserved);
+    fAccountedBytes.set(fReserved * sizeof(Record) + fStorageSize);
 }
 
 size_t SkRecord::bytesUsed() const {
@@ -35,3 +47,29 @@ void SkRecord::defrag() {
                                    [](Record op) { return op.type() == SkRecords::NoOp_Type; });
     fCount = noops - fRecords.get();
 }
+
+void SkRecord::reset() {
+    Destroyer destroyer;
+    for (int i = 0; i < this->count(); i++) {
+        this->mutate(i, destroyer);
+    }
+    fCount = 0;
+    this->resetAlloc(fApproxBytesAllocated);
+}
+
+void SkRecord::resetAlloc(size_t bytesHint) {
+    // Everything in fAlloc is trivially destructible (see alloc()), so destroying it only
+    // releases the heap blocks it chained on after fStorage.
+    fAlloc.~SkArenaAlloc();
+    // SkArenaAlloc blocks are limited to 32-bit sizes; huge records just use the heap as usual.
+    bytesHint = std::min(bytesHint, kMaxStorageSize);
+    if (bytesHint > fStorageSize) {
+        // A little slack so slowly growing recordings don't spill into the heap every time.
+        fStorageSize = bytesHint + bytesHint / 8;
+        fStorage.reset(fStorageSize);
+    }
+    new (&fAlloc) SkArenaAlloc(fStorage.get(), fStorageSize, kFirstHeapAllocation);
+    fAlloc.setAllocationCategory(SkAllocationCategory::kRecord);
+    fApproxBytesAllocated = 0;
+    fAccountedBytes.set(fReserved * sizeof(Record) + fStorageSize);
+}
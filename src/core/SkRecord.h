@@ -11,6 +11,7 @@
 #include "include/core/SkRefCnt.h"
 #include "include/private/base/SkAssert.h"
 #include "include/private/base/SkTemplates.h"
+#include "src/base/SkAllocationCounters.h"
 #include "src/base/SkArenaAlloc.h"
 #include "src/core/SkRecords.h"
 
@@ -32,6 +33,9 @@
 class SkRecord : public SkRefCnt {
 public:
     SkRecord() = default;
+    // Preallocates room for countHint commands and bytesHint bytes of command data, e.g. to
+    // match the size of a similar, previously recorded SkRecord.
+    SkRecord(int countHint, size_t bytesHint);
     ~SkRecord() override;
 
     // Returns the number of canvas commands in this SkRecord.
@@ -97,6 +101,11 @@ public:
     // May change count() and the indices of ops, but preserves their order.
     void defrag();
 
+    // Destroy all commands, leaving this record empty but keeping its storage: the command
+    // array keeps its capacity, and the next commands are allocated from a single block big
+    // enough to hold everything this record held before the reset.
+    void reset();
+
 private:
     // An SkRecord is structured as an array of pointers into a big chunk of memory where
     // records representing each canvas draw call are stored:
@@ -129,6 +138,7 @@ private:
     std::enable_if_t<!std::is_empty<T>::value, T*> allocCommand() { return this->alloc<T>(); }
 
     void grow();
+    void resetAlloc(size_t bytesHint);
 
     // A typed pointer to some bytes in fAlloc.  visit() and mutate() allow polymorphic dispatch.
     struct Record {
@@ -176,10 +186,19 @@ private:
         fReserved{0};
     skia_private::AutoTMalloc<Record> fRecords;
 
+    // fAlloc's first block, when this record has been sized from a hint.  Declared before fAlloc
+    // so it outlives it.
+    skia_private::AutoTMalloc<char> fStorage;
+    size_t                          fStorageSize{0};
+
     // fAlloc needs to be a data structure which can append variable length data in contiguous
     // chunks, returning a stable handle to that data for later retrieval.
-    SkArenaAlloc fAlloc{256};
+    static constexpr size_t kFirstHeapAllocation = 256;
+    SkArenaAlloc fAlloc{kFirstHeapAllocation};
     size_t       fApproxBytesAllocated{0};
+
+    // fRecords and fStorage, as counted by SkAllocationCounters; fAlloc counts its own blocks.
+    SkAccountedBytes fAccountedBytes{SkAllocationCategory::kRecord};
 };
 
 #endif//SkRecord_DEFINED
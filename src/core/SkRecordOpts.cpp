@@ -7,19 +7,29 @@
 
 #include "src/core/SkRecordOpts.h"
 
+#include "include/core/SkBBHFactory.h"
 #include "include/core/SkBlendMode.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColor.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkMatrix.h"
 #include "include/core/SkPaint.h"
+#include "include/core/SkRect.h"
 #include "include/core/SkRefCnt.h"
 #include "include/private/base/SkMath.h"
 #include "include/private/base/SkTemplates.h"
+#include "src/core/SkPaintPriv.h"
 #include "src/core/SkRecord.h"
+#include "src/core/SkRecordDraw.h"
 #include "src/core/SkRecordPattern.h"
 #include "src/core/SkRecords.h"
+#include "src/core/SkRectPriv.h"
 
+#include <algorithm>
+#include <climits>
 #include <cstdint>
 #include <optional>
+#include <vector>
 
 using namespace SkRecords;
 
@@ -266,6 +276,204 @@ void SkRecordMergeSvgOpacityAndFilterLayers(SkRecord* record) {
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+// Walks the record tracking the CTM and an id for the current clip (and layer). Each draw is
+// remembered along with its clip id. When an opaque rect, image rect or paint fill comes along,
+// any remembered draw under the same clip whose bounds fit inside the pixels the fill fully
+// covers is turned into a NoOp.
+//
+// Clip ids are never reused, so "same id" means "same layer, same clip" even across nested
+// Save/Restore blocks between the two draws. Anti-aliased clips and clip shaders only partially
+// cover some pixels, so nothing is treated as covered under them. Ops that may read back pixels
+// from elsewhere (backdrop layers, SaveBehind/DrawBehind, pictures and drawables that could
+// contain those) forget every remembered draw.
+//
+// The bounds of draws inside a layer with image filters are mapped through those filters, while
+// the covered rect is only mapped through the CTM, so the two can't be compared there. Nothing
+// is remembered or covered inside such layers.
+class OccludedDrawNooper {
+public:
+    explicit OccludedDrawNooper(SkRecord* record)
+            : fRecord(record)
+            , fBounds(record->count())
+            , fMeta(record->count()) {
+        // There's no cull rect here; the bounds of unbounded draws will be huge, and so only
+        // coverable by a DrawPaint.
+        SkRecordFillBounds(SkRectPriv::MakeLargest(), *record, fBounds.data(), fMeta.get());
+    }
+
+    bool run() {
+        for (fCurrentOp = 0; fCurrentOp < fRecord->count(); ++fCurrentOp) {
+            fRecord->visit(fCurrentOp, *this);
+        }
+        return fChanged;
+    }
+
+    template <typename T> void operator()(const T&) {
+        if constexpr ((T::kTags & kDraw_Tag) != 0) {
+            this->addCandidate();
+        }
+    }
+
+    void operator()(const Save&) { fSaveStack.push_back(fClip); }
+    void operator()(const SaveLayer& op) {
+        fSaveStack.push_back(fClip);
+        if (op.backdrop || (op.saveLayerFlags & SkCanvas::kInitWithPrevious_SaveLayerFlag)) {
+            fCandidates.clear();
+        }
+        fClip.id = fNextClipID++;
+        fClip.filtered |= (op.paint && op.paint->getImageFilter()) || !op.filters.empty();
+    }
+    void operator()(const SaveBehind&) {
+        fSaveStack.push_back(fClip);
+        fCandidates.clear();
+        fClip.id = fNextClipID++;
+    }
+    void operator()(const Restore& op) {
+        fCTM = op.matrix;
+        if (fSaveStack.empty()) {
+            return;
+        }
+        const Clip restored = fSaveStack.back();
+        fSaveStack.pop_back();
+        if (restored.id != fClip.id) {
+            // Nothing will ever be drawn under this clip again.
+            this->forgetClip(fClip.id);
+        }
+        fClip = restored;
+    }
+
+    void operator()(const SetMatrix& op) { fCTM = op.matrix; }
+    void operator()(const SetM44& op)    { fCTM = op.matrix.asM33(); }
+    void operator()(const Concat44& op)  { fCTM.preConcat(op.matrix.asM33()); }
+    void operator()(const Concat& op)    { fCTM.preConcat(op.matrix); }
+    void operator()(const Scale& op)     { fCTM.preScale(op.sx, op.sy); }
+    void operator()(const Translate& op) { fCTM.preTranslate(op.dx, op.dy); }
+
+    void operator()(const ClipRect& op)   { this->newClip(op.opAA.aa()); }
+    void operator()(const ClipRRect& op)  { this->newClip(op.opAA.aa()); }
+    void operator()(const ClipPath& op)   { this->newClip(op.opAA.aa()); }
+    void operator()(const ClipRegion&)    { this->newClip(false); }
+    void operator()(const ClipShader&)    { this->newClip(true); }
+    void operator()(const ResetClip&) {
+        fClip.id = fNextClipID++;
+        fClip.soft = false;
+    }
+
+    // These may read or produce pixels we can't see, or carry meaning beyond their pixels.
+    void operator()(const DrawBehind&)     { fCandidates.clear(); }
+    void operator()(const DrawPicture&)    { fCandidates.clear(); }
+    void operator()(const DrawDrawable&)   { fCandidates.clear(); }
+    void operator()(const DrawAnnotation&) {}
+
+    void operator()(const DrawPaint& op) {
+        if (IsOpaqueFill(&op.paint, SkPaintPriv::kNone_ShaderOverrideOpacity)) {
+            this->cover(nullptr);
+        }
+        this->addCandidate();
+    }
+    void operator()(const DrawRect& op) {
+        if (IsOpaqueFill(&op.paint, SkPaintPriv::kNone_ShaderOverrideOpacity)) {
+            this->cover(&op.rect);
+        }
+        this->addCandidate();
+    }
+    void operator()(const DrawImageRect& op) {
+        if (SkRect::Make(op.image->bounds()).contains(op.src) &&
+            IsOpaqueFill(op.paint, op.image->isOpaque()
+                                           ? SkPaintPriv::kOpaque_ShaderOverrideOpacity
+                                           : SkPaintPriv::kNotOpaque_ShaderOverrideOpacity)) {
+            this->cover(&op.dst);
+        }
+        this->addCandidate();
+    }
+
+private:
+    struct Clip {
+        int id;
+        bool soft;      // Some pixels are only partially inside the clip.
+        bool filtered;  // Inside a layer with image filters.
+    };
+
+    struct Candidate {
+        int op;
+        int clipID;
+    };
+
+    static bool IsOpaqueFill(const SkPaint* paint, SkPaintPriv::ShaderOverrideOpacity opacity) {
+        if (paint && (paint->getStyle() != SkPaint::kFill_Style || paint->getPathEffect() ||
+                      paint->getMaskFilter() || paint->getImageFilter())) {
+            return false;
+        }
+        return SkPaintPriv::Overwrites(paint, opacity);
+    }
+
+    void newClip(bool aa) {
+        fClip.id = fNextClipID++;
+        fClip.soft |= aa;
+    }
+
+    void addCandidate() {
+        if (!fClip.filtered) {
+            fCandidates.push_back({fCurrentOp, fClip.id});
+        }
+    }
+
+    void forgetClip(int clipID) {
+        fCandidates.erase(std::remove_if(fCandidates.begin(), fCandidates.end(),
+                                         [&](const Candidate& c) { return c.clipID == clipID; }),
+                          fCandidates.end());
+    }
+
+    // Turns every candidate under the current clip that 'localRect' (or everything, if null)
+    // fully covers into a NoOp.
+    void cover(const SkRect* localRect) {
+        if (fClip.soft || fClip.filtered) {
+            return;
+        }
+        SkIRect covered = SkIRect::MakeLTRB(INT_MIN, INT_MIN, INT_MAX, INT_MAX);
+        if (localRect) {
+            if (!fCTM.rectStaysRect()) {
+                return;
+            }
+            // Only pixels entirely inside the rect are certain to be overwritten, whether or not
+            // the rect is anti-aliased.
+            covered = fCTM.mapRect(localRect->makeSorted()).roundIn();
+            if (covered.isEmpty()) {
+                return;
+            }
+        }
+
+        fCandidates.erase(std::remove_if(fCandidates.begin(), fCandidates.end(),
+                                         [&](const Candidate& c) {
+            if (c.clipID != fClip.id || !covered.contains(fBounds[c.op].roundOut())) {
+                return false;
+            }
+            fRecord->replace<NoOp>(c.op);
+            fChanged = true;
+            return true;
+        }), fCandidates.end());
+    }
+
+    SkRecord* fRecord;
+    skia_private::AutoTArray<SkRect> fBounds;
+    skia_private::AutoTMalloc<SkBBoxHierarchy::Metadata> fMeta;
+
+    int fCurrentOp = 0;
+    SkMatrix fCTM = SkMatrix::I();
+    Clip fClip = {0, false, false};
+    int fNextClipID = 1;
+    std::vector<Clip> fSaveStack;
+    std::vector<Candidate> fCandidates;
+    bool fChanged = false;
+};
+
+void SkRecordNoopOccludedDraws(SkRecord* record) {
+    OccludedDrawNooper pass(record);
+    pass.run();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
 void SkRecordOptimize(SkRecord* record) {
     // This might be useful  as a first pass in the future if we want to weed
     // out junk for other optimization passes.  Right now, nothing needs it,
@@ -283,6 +491,7 @@ void SkRecordOptimize(SkRecord* record) {
     SkRecordNoopSaveLayerDrawRestores(record);
 #endif
     SkRecordMergeSvgOpacityAndFilterLayers(record);
+    SkRecordNoopOccludedDraws(record);
 
     record->defrag();
 }
@@ -26,4 +26,8 @@ void SkRecordNoopSaveLayerDrawRestores(SkRecord*);
 // the alpha of the first SaveLayer to the second SaveLayer.
 void SkRecordMergeSvgOpacityAndFilterLayers(SkRecord*);
 
+// Turns draws that are entirely overwritten by a later opaque rect, image rect or paint fill under
+// the same clip (e.g. a full-screen background repainted under opaque panels) into no-ops.
+void SkRecordNoopOccludedDraws(SkRecord*);
+
 #endif//SkRecordOpts_DEFINED
@@ -112,6 +112,11 @@ void SkRecorder::reset(SkRecord* record, const SkRect& bounds) {
     SkASSERT(this->imageInfo().width() >= 0 && this->imageInfo().height() >= 0);
 }
 
+void SkRecorder::setRecord(SkRecord* record) {
+    this->forgetRecord();
+    fRecord = record;
+}
+
 void SkRecorder::forgetRecord() {
     fDrawableList.reset(nullptr);
     fApproxBytesUsedBySubPictures = 0;
@@ -121,6 +126,9 @@ void SkRecorder::forgetRecord() {
 // To make appending to fRecord a little less verbose.
 template<typename T, typename... Args>
 void SkRecorder::append(Args&&... args) {
+    if (fWillAppendProc) {
+        fWillAppendProc(fWillAppendCtx);
+    }
     new (fRecord->append<T>()) T{std::forward<Args>(args)...};
 }
 
@@ -82,6 +82,10 @@ public:
 
     void reset(SkRecord*, const SkRect& bounds);
 
+    // Start appending to a new SkRecord while keeping the canvas state (saves, matrix and clip).
+    // Like reset(), this forgets the drawable list.
+    void setRecord(SkRecord*);
+
     size_t approxBytesUsedBySubPictures() const { return fApproxBytesUsedBySubPictures; }
 
     SkDrawableList* getDrawableList() const { return fDrawableList.get(); }
@@ -90,6 +94,14 @@ public:
     // Make SkRecorder forget entirely about its SkRecord*; all calls to SkRecorder will fail.
     void forgetRecord();
 
+    // Calls 'proc' before appending each op, while the record holds only complete ops. The proc
+    // may read the record, but must not change it or this recorder.
+    using WillAppendProc = void (*)(void* ctx);
+    void setWillAppendProc(WillAppendProc proc, void* ctx) {
+        fWillAppendProc = proc;
+        fWillAppendCtx = ctx;
+    }
+
     void willSave() override;
     SaveLayerStrategy getSaveLayerStrategy(const SaveLayerRec&) override;
     bool onDoSaveBehind(const SkRect*) override;
@@ -171,6 +183,8 @@ private:
     size_t fApproxBytesUsedBySubPictures;
     SkRecord* fRecord;
     std::unique_ptr<SkDrawableList> fDrawableList;
+    WillAppendProc fWillAppendProc = nullptr;
+    void* fWillAppendCtx = nullptr;
 };
 
 #endif//SkRecorder_DEFINED
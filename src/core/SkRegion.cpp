@@ -14,6 +14,7 @@
 #include "include/private/base/SkTo.h"
 #include "src/base/SkBuffer.h"
 #include "src/base/SkSafeMath.h"
+#include "src/base/SkVx.h"
 #include "src/core/SkRegionPriv.h"
 
 #include <algorithm>
@@ -655,15 +656,109 @@ void SkRegion::translate(int dx, int dy, SkRegion* dst) const {
 ///////////////////////////////////////////////////////////////////////////////
 
 bool SkRegion::setRects(const SkIRect rects[], int count) {
-    if (0 == count) {
-        this->setEmpty();
-    } else {
-        this->setRect(rects[0]);
-        for (int i = 1; i < count; i++) {
-            this->op(rects[i], kUnion_Op);
+    return SkRegionPriv::SetRects(this, {rects, SkToSizeT(std::max(count, 0))});
+}
+
+bool SkRegionPriv::SetRects(SkRegion* rgn, SkSpan<const SkIRect> rects) {
+    // Empty rects add nothing to a union.
+    STArray<16, SkIRect> sorted;
+    for (const SkIRect& r : rects) {
+        if (!r.isEmpty()) {
+            sorted.push_back(r);
+        }
+    }
+    if (sorted.empty()) {
+        return rgn->setEmpty();
+    }
+    if (sorted.size() == 1) {
+        return rgn->setRect(sorted[0]);
+    }
+    std::sort(sorted.begin(), sorted.end(),
+              [](const SkIRect& a, const SkIRect& b) { return a.fTop < b.fTop; });
+
+    // Every top and bottom edge starts a new band.
+    STArray<32, int32_t> ys;
+    for (const SkIRect& r : sorted) {
+        ys.push_back(r.fTop);
+        ys.push_back(r.fBottom);
+    }
+    std::sort(ys.begin(), ys.end());
+    ys.resize(std::unique(ys.begin(), ys.end()) - ys.begin());
+
+    RunArray array;
+    int count = 0;
+    array[count++] = ys[0];         // top
+    int prevStart = -1, prevLen = 0;
+
+    STArray<16, SkIRect> active;    // the rects crossing the current band
+    int next = 0;
+    for (int band = 0; band + 1 < ys.size(); ++band) {
+        const int32_t top = ys[band], bot = ys[band + 1];
+        for (int i = active.size() - 1; i >= 0; --i) {
+            if (active[i].fBottom <= top) {
+                active.removeShuffle(i);
+            }
+        }
+        while (next < sorted.size() && sorted[next].fTop <= top) {
+            active.push_back(sorted[next++]);
+        }
+        std::sort(active.begin(), active.end(),
+                  [](const SkIRect& a, const SkIRect& b) { return a.fLeft < b.fLeft; });
+
+        // bottom, interval count, intervals, x-sentinel and the final y-sentinel
+        array.resizeToAtLeast(count + 2 + 2 * active.size() + 2);
+        RunType* const start = &array[count + 2];
+        RunType* dst = start;
+        for (const SkIRect& r : active) {
+            if (dst > start && dst[-1] >= r.fLeft) {
+                dst[-1] = std::max(dst[-1], r.fRight);
+            } else {
+                *dst++ = r.fLeft;
+                *dst++ = r.fRight;
+            }
+        }
+        const int len = SkToInt(dst - start);
+
+        // Like RgnOper::addSpan(), extend the previous band when this one has the same intervals.
+        if (prevStart >= 0 && prevLen == len &&
+                !memcmp(&array[prevStart], start, len * sizeof(RunType))) {
+            array[prevStart - 2] = bot;
+            continue;
+        }
+        array[count] = bot;
+        array[count + 1] = len >> 1;
+        *dst = SkRegion_kRunTypeSentinel;
+        prevStart = count + 2;
+        prevLen = len;
+        count += 2 + len + 1;
+    }
+    array[count++] = SkRegion_kRunTypeSentinel;
+    return rgn->setRuns(&array[0], count);
+}
+
+void SkRegionPriv::ToRects(const SkRegion& rgn, TArray<SkIRect>* rects) {
+    if (rgn.isEmpty()) {
+        return;
+    }
+    if (rgn.isRect()) {
+        rects->push_back(rgn.getBounds());
+        return;
+    }
+
+    rects->reserve(rects->size() + rgn.fRunHead->getIntervalCount());
+    const RunType* runs = rgn.fRunHead->readonly_runs();
+    int top = *runs++;
+    while (!SkRegionValueIsSentinel(runs[0])) {
+        const int bot = runs[0];
+        const int intervals = runs[1];
+        runs += 2;
+        for (int i = 0; i < intervals; ++i) {
+            rects->push_back(SkIRect::MakeLTRB(runs[0], top, runs[1], bot));
+            runs += 2;
         }
+        runs += 1;  // skip x-sentinel
+        top = bot;
     }
-    return !this->isEmpty();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -779,6 +874,114 @@ static int distance_to_sentinel(const SkRegionPriv::RunType* runs) {
     return ptr - runs;
 }
 
+// Returns how many of the n intervals at runs have their left (kEdge == 0) or right (kEdge == 1)
+// edge less than x. Since the intervals are sorted, these are always the first ones, so this is
+// also the index of the first interval whose edge is >= x. Checks four intervals at a time.
+template <int kEdge>
+static int count_edges_less_than(const SkRegionPriv::RunType runs[], int n, int x) {
+    skvx::int4 counts = 0;
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const skvx::int8 v = skvx::int8::Load(runs + 2 * i);
+        const skvx::int4 edges = kEdge == 0 ? skvx::shuffle<0, 2, 4, 6>(v)
+                                            : skvx::shuffle<1, 3, 5, 7>(v);
+        counts -= edges < x;  // true lanes are -1
+    }
+    int count = counts[0] + counts[1] + counts[2] + counts[3];
+    for (; i < n && runs[2 * i + kEdge] < x; ++i) {
+        count += 1;
+    }
+    return count;
+}
+
+// Intersects a scanline's intervals with the single interval [left, rite), which is how every
+// op against a rect (clipping in particular) sees each scanline. Only the first and last
+// surviving intervals can change, so the rest are copied as a block.
+static SkRegionPriv::RunType* clip_span(const SkRegionPriv::RunType runs[],
+                                        int left, int rite,
+                                        SkRegionPriv::RunType* dst) {
+    const int n = runs[-1];
+    SkASSERT(n == distance_to_sentinel(runs) >> 1);
+    // The first interval that ends after left, and one past the last that starts before rite.
+    const int first = count_edges_less_than<1>(runs, n, left + 1);
+    const int last  = count_edges_less_than<0>(runs, n, rite);
+    if (first < last) {
+        const int count = 2 * (last - first);
+        memcpy(dst, runs + 2 * first, count * sizeof(SkRegionPriv::RunType));
+        dst[0] = std::max<SkRegionPriv::RunType>(dst[0], left);
+        dst[count - 1] = std::min<SkRegionPriv::RunType>(dst[count - 1], rite);
+        dst += count;
+    }
+    return dst;
+}
+
+static SkRegionPriv::RunType* intersect_spans(const SkRegionPriv::RunType a_runs[],
+                                              const SkRegionPriv::RunType b_runs[],
+                                              SkRegionPriv::RunType* dst) {
+    if (SkRegionValueIsSentinel(a_runs[0]) || SkRegionValueIsSentinel(b_runs[0])) {
+        return dst;
+    }
+    if (SkRegionValueIsSentinel(a_runs[2])) {
+        return clip_span(b_runs, a_runs[0], a_runs[1], dst);
+    }
+    if (SkRegionValueIsSentinel(b_runs[2])) {
+        return clip_span(a_runs, b_runs[0], b_runs[1], dst);
+    }
+
+    // Intervals within a scanline never touch, so neither can the pieces of their intersection.
+    while (!SkRegionValueIsSentinel(a_runs[0]) && !SkRegionValueIsSentinel(b_runs[0])) {
+        const int left = std::max(a_runs[0], b_runs[0]);
+        const int rite = std::min(a_runs[1], b_runs[1]);
+        if (left < rite) {
+            *dst++ = (SkRegionPriv::RunType)left;
+            *dst++ = (SkRegionPriv::RunType)rite;
+        }
+        if (a_runs[1] <= b_runs[1]) {
+            a_runs += 2;
+        }
+        if (b_runs[1] <= rite) {
+            b_runs += 2;
+        }
+    }
+    return dst;
+}
+
+static SkRegionPriv::RunType* union_spans(const SkRegionPriv::RunType a_runs[],
+                                          const SkRegionPriv::RunType b_runs[],
+                                          SkRegionPriv::RunType* dst) {
+    SkRegionPriv::RunType* const start = dst;
+    // Merge [left, rite) into the last interval if they overlap or touch.
+    auto append = [&](SkRegionPriv::RunType left, SkRegionPriv::RunType rite) {
+        if (dst > start && dst[-1] >= left) {
+            dst[-1] = std::max(dst[-1], rite);
+        } else {
+            *dst++ = left;
+            *dst++ = rite;
+        }
+    };
+
+    while (!SkRegionValueIsSentinel(a_runs[0]) && !SkRegionValueIsSentinel(b_runs[0])) {
+        if (a_runs[0] <= b_runs[0]) {
+            append(a_runs[0], a_runs[1]);
+            a_runs += 2;
+        } else {
+            append(b_runs[0], b_runs[1]);
+            b_runs += 2;
+        }
+    }
+
+    // Once one side runs out, the rest of the other can only merge with the last interval we
+    // wrote, and whatever lies past that is copied as a block.
+    const SkRegionPriv::RunType* rest = SkRegionValueIsSentinel(a_runs[0]) ? b_runs : a_runs;
+    while (!SkRegionValueIsSentinel(rest[0]) && dst > start && dst[-1] >= rest[0]) {
+        dst[-1] = std::max(dst[-1], rest[1]);
+        rest += 2;
+    }
+    const int count = distance_to_sentinel(rest);
+    memcpy(dst, rest, count * sizeof(SkRegionPriv::RunType));
+    return dst + count;
+}
+
 static int operate_on_span(const SkRegionPriv::RunType a_runs[],
                            const SkRegionPriv::RunType b_runs[],
                            RunArray* array, int dstOffset,
@@ -788,6 +991,21 @@ static int operate_on_span(const SkRegionPriv::RunType a_runs[],
             dstOffset + distance_to_sentinel(a_runs) + distance_to_sentinel(b_runs) + 2);
     SkRegionPriv::RunType* dst = &(*array)[dstOffset]; // get pointer AFTER resizing.
 
+    // Union and intersection are by far the most common ops, and have simpler merges than the
+    // general state machine below.
+    if (min == 1 && max == 3) {
+        dst = union_spans(a_runs, b_runs, dst);
+        SkASSERT(dst < &(*array)[array->count() - 1]);
+        *dst++ = SkRegion_kRunTypeSentinel;
+        return dst - &(*array)[0];
+    }
+    if (min == 3 && max == 3) {
+        dst = intersect_spans(a_runs, b_runs, dst);
+        SkASSERT(dst < &(*array)[array->count() - 1]);
+        *dst++ = SkRegion_kRunTypeSentinel;
+        return dst - &(*array)[0];
+    }
+
     spanRec rec;
     bool    firstInterval = true;
 
@@ -9,8 +9,10 @@
 #define SkRegionPriv_DEFINED
 
 #include "include/core/SkRegion.h"
+#include "include/core/SkSpan.h"
 #include "include/private/base/SkMalloc.h"
 #include "include/private/base/SkMath.h"
+#include "include/private/base/SkTArray.h"
 #include "include/private/base/SkTo.h"
 
 #include <atomic>
@@ -27,6 +29,14 @@ public:
     // of the rect may be 1. It should never be empty.
     static void VisitSpans(const SkRegion& rgn, const std::function<void(const SkIRect&)>&);
 
+    // A region can also be kept as a plain list of rects sorted by top and then left, where the
+    // rects in each band share a top and bottom and never touch. This is the order the Iterator
+    // visits them in. ToRects() appends a region's rects to a list in that form; SetRects() sets a
+    // region to the union of any list of rects, overlapping or in any order. SetRects() builds
+    // the runs in one sweep down the rects, rather than with one union op per rect.
+    static void ToRects(const SkRegion& rgn, skia_private::TArray<SkIRect>* rects);
+    static bool SetRects(SkRegion* rgn, SkSpan<const SkIRect> rects);
+
 #ifdef SK_DEBUG
     static void Validate(const SkRegion& rgn);
 #endif
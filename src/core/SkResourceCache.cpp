@@ -17,6 +17,7 @@
 #include "include/private/base/SkMath.h"
 #include "include/private/base/SkMutex.h"
 #include "include/private/base/SkTArray.h"
+#include "include/private/base/SkThreadAnnotations.h"
 #include "include/private/base/SkTo.h"
 #include "src/core/SkCachedData.h"
 #include "src/core/SkChecksum.h"
@@ -29,6 +30,7 @@
 #endif
 
 #include <algorithm>
+#include <atomic>
 
 using namespace skia_private;
 
@@ -463,94 +465,215 @@ void SkResourceCache::checkMessages() {
 
 ///////////////////////////////////////////////////////////////////////////////
 
-static SkResourceCache* gResourceCache = nullptr;
-static SkMutex& resource_cache_mutex() {
+// The global cache is split into shards by key hash, each with its own mutex and LRU list, so
+// that threads looking up different keys rarely contend. There is a single shard by default.
+static constexpr int kMaxShardCount = 64;
+
+namespace {
+struct Shard {
+    SkMutex          fMutex;
+    SkResourceCache* fCache SK_GUARDED_BY(fMutex) = nullptr;
+    uint64_t         fHitCount SK_GUARDED_BY(fMutex) = 0;
+    uint64_t         fMissCount SK_GUARDED_BY(fMutex) = 0;
+};
+}  // namespace
+
+static Shard* shards() {
+    static Shard* shards = new Shard[kMaxShardCount];
+    return shards;
+}
+
+// Serializes changes to the shard count and limits below. Held before any shard's mutex.
+static SkMutex& resource_cache_config_mutex() {
     static SkMutex& mutex = *(new SkMutex);
     return mutex;
 }
 
-/** Must hold resource_cache_mutex() when calling. */
-static SkResourceCache* get_cache() {
-    // resource_cache_mutex() is always held when this is called, so we don't need to be fancy in here.
-    resource_cache_mutex().assertHeld();
-    if (nullptr == gResourceCache) {
+static std::atomic<int>    gShardCount{1};
+static std::atomic<size_t> gTotalByteLimit{SK_DEFAULT_IMAGE_CACHE_LIMIT};
+static std::atomic<size_t> gSingleAllocationByteLimit{0};
+
+// Each shard in use gets an equal part of the total budget, so the total is enforced only
+// approximately: one shard may purge while others still have room. Unused shards get nothing.
+static size_t shard_byte_limit(int index, int shardCount, size_t totalByteLimit) {
+    return index < shardCount ? totalByteLimit / shardCount : 0;
+}
+
+/** Must hold shard.fMutex when calling. */
+static SkResourceCache* get_cache(Shard& shard, int index) {
+    shard.fMutex.assertHeld();
+    if (nullptr == shard.fCache) {
 #ifdef SK_USE_DISCARDABLE_SCALEDIMAGECACHE
-        gResourceCache = new SkResourceCache(SkDiscardableMemory::Create);
+        shard.fCache = new SkResourceCache(SkDiscardableMemory::Create);
 #else
-        gResourceCache = new SkResourceCache(SK_DEFAULT_IMAGE_CACHE_LIMIT);
+        shard.fCache = new SkResourceCache(shard_byte_limit(index,
+                                                            gShardCount.load(),
+                                                            gTotalByteLimit.load()));
 #endif
+        shard.fCache->setSingleAllocationByteLimit(gSingleAllocationByteLimit.load());
+    }
+    return shard.fCache;
+}
+
+static int shard_index(const SkResourceCache::Key& key) {
+    return key.hash() % gShardCount.load(std::memory_order_relaxed);
+}
+
+// Calls fn on each shard that has been used, including shards no longer in use, which may still
+// hold entries that could not be purged when the shard count changed.
+template <typename Fn>
+static void for_each_cache(Fn&& fn) {
+    for (int i = 0; i < kMaxShardCount; ++i) {
+        Shard& shard = shards()[i];
+        SkAutoMutexExclusive am(shard.fMutex);
+        if (i == 0 || shard.fCache) {
+            fn(get_cache(shard, i));
+        }
+    }
+}
+
+/** Must hold resource_cache_config_mutex() when calling. */
+static void update_shard_limits() {
+    resource_cache_config_mutex().assertHeld();
+    const int shardCount = gShardCount.load();
+    const size_t totalByteLimit = gTotalByteLimit.load();
+    for (int i = 0; i < kMaxShardCount; ++i) {
+        Shard& shard = shards()[i];
+        SkAutoMutexExclusive am(shard.fMutex);
+        if (shard.fCache) {
+            shard.fCache->setSingleAllocationByteLimit(gSingleAllocationByteLimit.load());
+            shard.fCache->setTotalByteLimit(shard_byte_limit(i, shardCount, totalByteLimit));
+        }
     }
-    return gResourceCache;
 }
 
 size_t SkResourceCache::GetTotalBytesUsed() {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    return get_cache()->getTotalBytesUsed();
+    size_t used = 0;
+    for_each_cache([&](SkResourceCache* cache) { used += cache->getTotalBytesUsed(); });
+    return used;
 }
 
 size_t SkResourceCache::GetTotalByteLimit() {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    return get_cache()->getTotalByteLimit();
+#ifdef SK_USE_DISCARDABLE_SCALEDIMAGECACHE
+    return 0;
+#else
+    return gTotalByteLimit.load();
+#endif
 }
 
 size_t SkResourceCache::SetTotalByteLimit(size_t newLimit) {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    return get_cache()->setTotalByteLimit(newLimit);
+#ifdef SK_USE_DISCARDABLE_SCALEDIMAGECACHE
+    return 0;
+#else
+    SkAutoMutexExclusive am(resource_cache_config_mutex());
+    size_t prevLimit = gTotalByteLimit.exchange(newLimit);
+    update_shard_limits();
+    return prevLimit;
+#endif
+}
+
+int SkResourceCache::GetShardCount() {
+    return gShardCount.load();
+}
+
+int SkResourceCache::SetShardCount(int count) {
+    count = std::clamp(count, 1, kMaxShardCount);
+    SkAutoMutexExclusive am(resource_cache_config_mutex());
+    int prevCount = gShardCount.exchange(count);
+    if (count != prevCount) {
+        // Entries now belong to different shards, so start over.
+        for_each_cache([](SkResourceCache* cache) { cache->purgeAll(); });
+        update_shard_limits();
+    }
+    return prevCount;
+}
+
+SkResourceCache::ShardStats SkResourceCache::GetShardStats(int index) {
+    ShardStats stats;
+    if (index < 0 || index >= kMaxShardCount) {
+        return stats;
+    }
+    Shard& shard = shards()[index];
+    SkAutoMutexExclusive am(shard.fMutex);
+    if (shard.fCache) {
+        stats.fBytesUsed = shard.fCache->getTotalBytesUsed();
+        stats.fByteLimit = shard.fCache->getTotalByteLimit();
+        stats.fCount = shard.fCache->fCount;
+    }
+    stats.fHitCount = shard.fHitCount;
+    stats.fMissCount = shard.fMissCount;
+    return stats;
 }
 
 SkResourceCache::DiscardableFactory SkResourceCache::GetDiscardableFactory() {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    return get_cache()->discardableFactory();
+#ifdef SK_USE_DISCARDABLE_SCALEDIMAGECACHE
+    return SkDiscardableMemory::Create;
+#else
+    return nullptr;
+#endif
 }
 
 SkCachedData* SkResourceCache::NewCachedData(size_t bytes) {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    return get_cache()->newCachedData(bytes);
+    // This does not touch any cached entries, so there is no shard to lock.
+    if (DiscardableFactory factory = GetDiscardableFactory()) {
+        SkDiscardableMemory* dm = factory(bytes);
+        return dm ? new SkCachedData(bytes, dm) : nullptr;
+    }
+    return new SkCachedData(sk_malloc_throw(bytes), bytes);
 }
 
 void SkResourceCache::Dump() {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    get_cache()->dump();
+    for_each_cache([](SkResourceCache* cache) { cache->dump(); });
 }
 
 size_t SkResourceCache::SetSingleAllocationByteLimit(size_t size) {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    return get_cache()->setSingleAllocationByteLimit(size);
+    SkAutoMutexExclusive am(resource_cache_config_mutex());
+    size_t prevLimit = gSingleAllocationByteLimit.exchange(size);
+    update_shard_limits();
+    return prevLimit;
 }
 
 size_t SkResourceCache::GetSingleAllocationByteLimit() {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    return get_cache()->getSingleAllocationByteLimit();
+    return gSingleAllocationByteLimit.load();
 }
 
 size_t SkResourceCache::GetEffectiveSingleAllocationByteLimit() {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    return get_cache()->getEffectiveSingleAllocationByteLimit();
+    // An entry lives in a single shard, so it has to fit in that shard's part of the budget.
+    Shard& shard = shards()[0];
+    SkAutoMutexExclusive am(shard.fMutex);
+    return get_cache(shard, 0)->getEffectiveSingleAllocationByteLimit();
 }
 
 void SkResourceCache::PurgeAll() {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    return get_cache()->purgeAll();
+    for_each_cache([](SkResourceCache* cache) { cache->purgeAll(); });
 }
 
 void SkResourceCache::CheckMessages() {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    return get_cache()->checkMessages();
+    for_each_cache([](SkResourceCache* cache) { cache->checkMessages(); });
 }
 
 bool SkResourceCache::Find(const Key& key, FindVisitor visitor, void* context) {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    return get_cache()->find(key, visitor, context);
+    const int index = shard_index(key);
+    Shard& shard = shards()[index];
+    SkAutoMutexExclusive am(shard.fMutex);
+    bool found = get_cache(shard, index)->find(key, visitor, context);
+    if (found) {
+        shard.fHitCount += 1;
+    } else {
+        shard.fMissCount += 1;
+    }
+    return found;
 }
 
 void SkResourceCache::Add(Rec* rec, void* payload) {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    get_cache()->add(rec, payload);
+    const int index = shard_index(rec->getKey());
+    Shard& shard = shards()[index];
+    SkAutoMutexExclusive am(shard.fMutex);
+    get_cache(shard, index)->add(rec, payload);
 }
 
 void SkResourceCache::VisitAll(Visitor visitor, void* context) {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    get_cache()->visitAll(visitor, context);
+    for_each_cache([&](SkResourceCache* cache) { cache->visitAll(visitor, context); });
 }
 
 void SkResourceCache::PostPurgeSharedID(uint64_t sharedID) {
@@ -581,6 +704,19 @@ size_t SkGraphics::SetResourceCacheSingleAllocationByteLimit(size_t newLimit) {
     return SkResourceCache::SetSingleAllocationByteLimit(newLimit);
 }
 
+int SkGraphics::GetResourceCacheShardCount() {
+    return SkResourceCache::GetShardCount();
+}
+
+int SkGraphics::SetResourceCacheShardCount(int count) {
+    return SkResourceCache::SetShardCount(count);
+}
+
+SkGraphics::ResourceCacheShardStats SkGraphics::GetResourceCacheShardStats(int shardIndex) {
+    SkResourceCache::ShardStats stats = SkResourceCache::GetShardStats(shardIndex);
+    return {stats.fBytesUsed, stats.fByteLimit, stats.fCount, stats.fHitCount, stats.fMissCount};
+}
+
 void SkGraphics::PurgeResourceCache() {
     SkImageFilter_Base::PurgeCache();
     return SkResourceCache::PurgeAll();
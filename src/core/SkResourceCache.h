@@ -162,6 +162,23 @@ public:
     static size_t GetTotalByteLimit();
     static size_t SetTotalByteLimit(size_t newLimit);
 
+    /**
+     *  The global cache can be split into up to 64 shards, each with its own lock, LRU list and
+     *  an equal part of the total byte limit. Keys are assigned to shards by their hash.
+     *  Changing the count purges the cache. SetShardCount() returns the previous count.
+     */
+    static int GetShardCount();
+    static int SetShardCount(int count);
+
+    struct ShardStats {
+        size_t   fBytesUsed = 0;
+        size_t   fByteLimit = 0;
+        int      fCount = 0;
+        uint64_t fHitCount = 0;
+        uint64_t fMissCount = 0;
+    };
+    static ShardStats GetShardStats(int shardIndex);
+
     static size_t SetSingleAllocationByteLimit(size_t);
     static size_t GetSingleAllocationByteLimit();
     static size_t GetEffectiveSingleAllocationByteLimit();
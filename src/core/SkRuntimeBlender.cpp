@@ -17,6 +17,7 @@
 #include "src/core/SkEffectPriv.h"
 #include "src/core/SkReadBuffer.h"
 #include "src/core/SkRuntimeEffectPriv.h"
+#include "src/core/SkRuntimeEffectProfiler.h"
 #include "src/core/SkWriteBuffer.h"
 #include "src/shaders/SkShaderBase.h"
 #include "src/sksl/codegen/SkSLRasterPipelineBuilder.h"
@@ -78,7 +79,9 @@ bool SkRuntimeBlender::onAppendStages(const SkStageRec& rec) const {
         SkShaders::MatrixRec matrix(SkMatrix::I());
         matrix.markCTMApplied();
         RuntimeEffectRPCallbacks callbacks(rec, matrix, fChildren, fEffect->fSampleUsages);
+        auto* profile = SkRuntimeEffectProfiler::Global()->appendBegin(rec, *fEffect);
         bool success = program->appendStages(rec.fPipeline, rec.fAlloc, &callbacks, uniforms);
+        SkRuntimeEffectProfiler::AppendEnd(rec, profile);
         return success;
     }
     return false;
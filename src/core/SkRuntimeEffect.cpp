@@ -15,12 +15,12 @@
 #include "include/core/SkData.h"
 #include "include/private/base/SkAlign.h"
 #include "include/private/base/SkDebug.h"
+#include "include/private/base/SkFloatingPoint.h"
 #include "include/private/base/SkMutex.h"
 #include "include/private/base/SkOnce.h"
 #include "include/private/base/SkTArray.h"
 #include "src/base/SkArenaAlloc.h"
 #include "src/base/SkEnumBitMask.h"
-#include "src/base/SkNoDestructor.h"
 #include "src/core/SkBlenderBase.h"
 #include "src/core/SkChecksum.h"
 #include "src/core/SkColorSpacePriv.h"
@@ -31,6 +31,7 @@
 #include "src/core/SkRasterPipelineOpList.h"
 #include "src/core/SkReadBuffer.h"
 #include "src/core/SkRuntimeBlender.h"
+#include "src/core/SkRuntimeEffectCache.h"
 #include "src/core/SkRuntimeEffectPriv.h"
 #include "src/core/SkStreamPriv.h"
 #include "src/core/SkWriteBuffer.h"
@@ -61,6 +62,8 @@
 #include "src/sksl/tracing/SkSLDebugTracePriv.h"
 
 #include <algorithm>
+#include <cstring>
+#include <string>
 
 using namespace skia_private;
 
@@ -512,6 +515,9 @@ SkRuntimeEffect::Result SkRuntimeEffect::MakeInternal(std::unique_ptr<SkSL::Prog
     if (options.forceUnoptimized) {
         flags |= kDisableOptimization_Flag;
     }
+    if (options.bakeColorFilterLUT) {
+        flags |= kBakeColorFilterLUT_Flag;
+    }
 
     // Find 'main', then locate the sample coords parameter. (It might not be present.)
     const SkSL::FunctionDeclaration* main = program->getFunction("main");
@@ -653,6 +659,108 @@ sk_sp<SkRuntimeEffect> SkRuntimeEffect::makeUnoptimizedClone() {
     return result.effect;
 }
 
+struct SkRuntimeEffect::SpecializedEffects {
+    // Each distinct value makes a new program, so only the most recently used ones are kept.
+    static constexpr int kMaxCount = 16;
+
+    SkMutex fMutex;
+    SkLRUCache<SkString, sk_sp<SkRuntimeEffect>> fEffects SK_GUARDED_BY(fMutex){kMaxCount};
+};
+
+sk_sp<SkRuntimeEffect> SkRuntimeEffect::makeSpecialized(std::string_view uniformName,
+                                                        const void* value,
+                                                        size_t size) const {
+    const Uniform* uniform = this->findUniform(uniformName);
+    if (!uniform || uniform->isArray() || uniform->isColor() || size != uniform->sizeInBytes()) {
+        return nullptr;
+    }
+
+    fSpecializedEffectsOnce([this] {
+        fSpecializedEffects = std::make_unique<SpecializedEffects>();
+    });
+    SkString key(uniformName);
+    key.append("=");
+    key.append(static_cast<const char*>(value), size);
+    {
+        SkAutoMutexExclusive lock(fSpecializedEffects->fMutex);
+        if (sk_sp<SkRuntimeEffect>* found = fSpecializedEffects->fEffects.find(key)) {
+            return *found;
+        }
+    }
+
+    // The uniform's declaration is replaced with a constant one in the source, and the result is
+    // compiled again. Constant globals are folded into the expressions that use them as they are
+    // converted, which lets the optimizer drop the branches and functions they make unreachable.
+    const std::string& source = *fBaseProgram->fSource;
+    const SkSL::VarDeclaration* decl = nullptr;
+    for (const SkSL::ProgramElement* elem : fBaseProgram->elements()) {
+        if (elem->is<SkSL::GlobalVarDeclaration>()) {
+            const SkSL::VarDeclaration& d = elem->as<SkSL::GlobalVarDeclaration>().varDeclaration();
+            if (d.var()->name() == uniformName) {
+                decl = &d;
+                break;
+            }
+        }
+    }
+    if (!decl) {
+        return nullptr;
+    }
+    // Only a declaration that is a statement of its own can be replaced as a whole.
+    const int start = decl->position().startOffset();
+    const int end = decl->position().endOffset();
+    const size_t next = source.find_first_not_of(" \t\r\n", end);
+    if (decl->var()->modifiersPosition().startOffset() != start ||
+        next == std::string::npos || source[next] != ';') {
+        return nullptr;
+    }
+
+    const SkSL::Type& type = decl->var()->type();
+    const std::string typeName = type.displayName();
+    SkASSERT(type.slotCount() * sizeof(float) == size);
+    std::string constant = "const " + typeName + " " + std::string(uniformName) + " = " +
+                           typeName + "(";
+    for (size_t i = 0; i < type.slotCount(); ++i) {
+        if (i) {
+            constant += ", ";
+        }
+        if (type.componentType().isFloat()) {
+            float f;
+            memcpy(&f, static_cast<const char*>(value) + i * sizeof(float), sizeof(float));
+            if (!SkIsFinite(f)) {
+                return nullptr;
+            }
+            constant += SkStringPrintf("%.9g", f).c_str();
+        } else {
+            int v;
+            memcpy(&v, static_cast<const char*>(value) + i * sizeof(int), sizeof(int));
+            constant += std::to_string(v);
+        }
+    }
+    constant += ")";
+
+    std::string specialized = source.substr(0, start) + constant + source.substr(end);
+
+    // As in makeUnoptimizedClone, the restrictions of the original Options were already enforced.
+    Options options;
+    options.forceUnoptimized = SkToBool(fFlags & kDisableOptimization_Flag);
+    options.bakeColorFilterLUT = SkToBool(fFlags & kBakeColorFilterLUT_Flag);
+    options.maxVersionAllowed = SkSL::Version::k300;
+    options.allowPrivateAccess = true;
+    Result result = MakeFromSource(SkString(specialized), options, fBaseProgram->fConfig->fKind);
+    if (!result.effect) {
+        // The value can make the program invalid, e.g. by making a constant expression overflow.
+        return nullptr;
+    }
+
+    SkAutoMutexExclusive lock(fSpecializedEffects->fMutex);
+    if (sk_sp<SkRuntimeEffect>* found = fSpecializedEffects->fEffects.find(key)) {
+        // Another thread specialized the effect with the same value first.
+        return *found;
+    }
+    fSpecializedEffects->fEffects.insert(std::move(key), result.effect);
+    return result.effect;
+}
+
 SkRuntimeEffect::Result SkRuntimeEffect::MakeForColorFilter(SkString sksl, const Options& options) {
     auto programKind = options.allowPrivateAccess ? SkSL::ProgramKind::kPrivateRuntimeColorFilter
                                                   : SkSL::ProgramKind::kRuntimeColorFilter;
@@ -680,31 +788,22 @@ SkRuntimeEffect::Result SkRuntimeEffect::MakeForBlender(SkString sksl, const Opt
 sk_sp<SkRuntimeEffect> SkMakeCachedRuntimeEffect(
         SkRuntimeEffect::Result (*make)(SkString sksl, const SkRuntimeEffect::Options&),
         SkString sksl) {
-    static SkNoDestructor<SkMutex> mutex;
-    static SkNoDestructor<SkLRUCache<uint64_t, sk_sp<SkRuntimeEffect>>> cache(11 /*arbitrary*/);
-
-    uint64_t key = SkChecksum::Hash64(sksl.c_str(), sksl.size());
-    {
-        SkAutoMutexExclusive _(*mutex);
-        if (sk_sp<SkRuntimeEffect>* found = cache->find(key)) {
-            return *found;
-        }
+    SkRuntimeEffectCache* cache = SkRuntimeEffectCache::Global();
+    if (sk_sp<SkRuntimeEffect> found = cache->find(make, sksl)) {
+        return found;
     }
 
     SkRuntimeEffect::Options options;
     SkRuntimeEffectPriv::AllowPrivateAccess(&options);
 
-    auto [effect, err] = make(std::move(sksl), options);
+    auto [effect, err] = make(sksl, options);
     if (!effect) {
         SkDEBUGFAILF("%s", err.c_str());
         return nullptr;
     }
     SkASSERT(err.isEmpty());
 
-    {
-        SkAutoMutexExclusive _(*mutex);
-        cache->insert_or_update(key, effect);
-    }
+    cache->add(make, sksl, effect);
     return effect;
 }
 
@@ -753,9 +852,10 @@ SkRuntimeEffect::SkRuntimeEffect(std::unique_ptr<SkSL::Program> baseProgram,
     // Everything from SkRuntimeEffect::Options which could influence the compiled result needs to
     // be accounted for in `fHash`. If you've added a new field to Options and caused the static-
     // assert below to trigger, please incorporate your field into `fHash` and update KnownOptions
-    // to match the layout of Options.
+    // to match the layout of Options. (bakeColorFilterLUT only changes how the CPU backend draws
+    // the effect, so it doesn't need to be in `fHash`.)
     struct KnownOptions {
-        bool forceUnoptimized, allowPrivateAccess;
+        bool forceUnoptimized, bakeColorFilterLUT, allowPrivateAccess;
         uint32_t fStableKey;
         SkSL::Version maxVersionAllowed;
     };
@@ -0,0 +1,126 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/core/SkRuntimeEffectCache.h"
+
+#include "src/core/SkChecksum.h"
+
+#include <algorithm>
+#include <climits>
+#include <utility>
+
+// Internal effects come from a few dozen sources, plus whatever pictures bring along.
+static constexpr int kDefaultCountLimit = 64;
+static constexpr size_t kDefaultByteLimit = 4 * 1024 * 1024;
+
+// The IR of a typical runtime effect, after optimization, takes ~30x its source. Effects that have
+// been drawn on the CPU also keep their raster pipeline program, which is smaller.
+static constexpr size_t kEstimatedBytesPerSourceByte = 32;
+
+SkRuntimeEffectCache* SkRuntimeEffectCache::Global() {
+    static SkRuntimeEffectCache* cache =
+            new SkRuntimeEffectCache(kDefaultCountLimit, kDefaultByteLimit);
+    return cache;
+}
+
+// The LRU cache itself never evicts, so that every eviction goes through purgeAsNeeded() and
+// fBytesUsed stays accurate.
+SkRuntimeEffectCache::SkRuntimeEffectCache(int countLimit, size_t byteLimit)
+        : fEffects(INT_MAX)
+        , fCountLimit(std::max(countLimit, 0))
+        , fByteLimit(byteLimit) {}
+
+uint64_t SkRuntimeEffectCache::Key(MakeFn make, const SkString& sksl) {
+    // The same SkSL can be compiled as different kinds of effect.
+    return SkChecksum::Hash64(sksl.c_str(), sksl.size(), reinterpret_cast<uintptr_t>(make));
+}
+
+size_t SkRuntimeEffectCache::EstimatedBytes(const SkString& sksl) {
+    return sizeof(SkRuntimeEffect) + sksl.size() * kEstimatedBytesPerSourceByte;
+}
+
+sk_sp<SkRuntimeEffect> SkRuntimeEffectCache::find(MakeFn make, const SkString& sksl) {
+    const uint64_t key = Key(make, sksl);
+    SkAutoMutexExclusive lock(fMutex);
+    const Entry* entry = fEffects.find(key);
+    // Keys are hashes, so make sure this really is the same SkSL.
+    if (entry && entry->fSkSL == sksl) {
+        return entry->fEffect;
+    }
+    return nullptr;
+}
+
+void SkRuntimeEffectCache::add(MakeFn make,
+                               const SkString& sksl,
+                               sk_sp<SkRuntimeEffect> effect) {
+    const uint64_t key = Key(make, sksl);
+    const size_t bytes = EstimatedBytes(sksl);
+    SkAutoMutexExclusive lock(fMutex);
+    if (fCountLimit == 0 || bytes > fByteLimit) {
+        return;
+    }
+    if (Entry* existing = fEffects.find(key)) {
+        fBytesUsed -= EstimatedBytes(existing->fSkSL);
+        *existing = {sksl, std::move(effect)};
+    } else {
+        fEffects.insert(key, {sksl, std::move(effect)});
+    }
+    fBytesUsed += bytes;
+    this->purgeAsNeeded();
+}
+
+void SkRuntimeEffectCache::purgeAsNeeded() {
+    Entry evicted;
+    while (fEffects.count() > fCountLimit || fBytesUsed > fByteLimit) {
+        if (!fEffects.removeLeastRecentlyUsed(&evicted)) {
+            break;
+        }
+        fBytesUsed -= EstimatedBytes(evicted.fSkSL);
+    }
+}
+
+int SkRuntimeEffectCache::getCountUsed() {
+    SkAutoMutexExclusive lock(fMutex);
+    return fEffects.count();
+}
+
+int SkRuntimeEffectCache::getCountLimit() {
+    SkAutoMutexExclusive lock(fMutex);
+    return fCountLimit;
+}
+
+int SkRuntimeEffectCache::setCountLimit(int count) {
+    SkAutoMutexExclusive lock(fMutex);
+    const int prev = fCountLimit;
+    fCountLimit = std::max(count, 0);
+    this->purgeAsNeeded();
+    return prev;
+}
+
+size_t SkRuntimeEffectCache::getBytesUsed() {
+    SkAutoMutexExclusive lock(fMutex);
+    return fBytesUsed;
+}
+
+size_t SkRuntimeEffectCache::getByteLimit() {
+    SkAutoMutexExclusive lock(fMutex);
+    return fByteLimit;
+}
+
+size_t SkRuntimeEffectCache::setByteLimit(size_t bytes) {
+    SkAutoMutexExclusive lock(fMutex);
+    const size_t prev = fByteLimit;
+    fByteLimit = bytes;
+    this->purgeAsNeeded();
+    return prev;
+}
+
+void SkRuntimeEffectCache::purgeAll() {
+    SkAutoMutexExclusive lock(fMutex);
+    fEffects.reset();
+    fBytesUsed = 0;
+}
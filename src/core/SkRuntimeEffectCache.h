@@ -0,0 +1,68 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkRuntimeEffectCache_DEFINED
+#define SkRuntimeEffectCache_DEFINED
+
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkString.h"
+#include "include/effects/SkRuntimeEffect.h"
+#include "include/private/base/SkMutex.h"
+#include "include/private/base/SkThreadAnnotations.h"
+#include "src/core/SkLRUCache.h"
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ *  The process-wide cache behind SkMakeCachedRuntimeEffect(), which keeps the effects Skia compiles
+ *  for its own shaders, color filters, blenders and image filters (including ones deserialized from
+ *  pictures), keyed by their SkSL. It is limited both in entries and in an estimate of the memory
+ *  the compiled programs use, and evicts the least recently used effects past either limit.
+ */
+class SkRuntimeEffectCache {
+public:
+    using MakeFn = SkRuntimeEffect::Result (*)(SkString, const SkRuntimeEffect::Options&);
+
+    static SkRuntimeEffectCache* Global();
+
+    SkRuntimeEffectCache(int countLimit, size_t byteLimit);
+
+    // Returns the cached effect made by `make` from this SkSL, or nullptr.
+    sk_sp<SkRuntimeEffect> find(MakeFn make, const SkString& sksl);
+    void add(MakeFn make, const SkString& sksl, sk_sp<SkRuntimeEffect>);
+
+    // The memory an effect is assumed to use. SkSL programs don't track their size, so this is
+    // estimated from the length of the source.
+    static size_t EstimatedBytes(const SkString& sksl);
+
+    int getCountUsed();
+    int getCountLimit();
+    int setCountLimit(int count);
+    size_t getBytesUsed();
+    size_t getByteLimit();
+    size_t setByteLimit(size_t bytes);
+
+    void purgeAll();
+
+private:
+    struct Entry {
+        SkString fSkSL;
+        sk_sp<SkRuntimeEffect> fEffect;
+    };
+
+    static uint64_t Key(MakeFn make, const SkString& sksl);
+    void purgeAsNeeded() SK_REQUIRES(fMutex);
+
+    SkMutex fMutex;
+    SkLRUCache<uint64_t, Entry> fEffects SK_GUARDED_BY(fMutex);
+    int fCountLimit SK_GUARDED_BY(fMutex);
+    size_t fByteLimit SK_GUARDED_BY(fMutex);
+    size_t fBytesUsed SK_GUARDED_BY(fMutex) = 0;
+};
+
+#endif  // SkRuntimeEffectCache_DEFINED
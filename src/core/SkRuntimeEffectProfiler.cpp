@@ -0,0 +1,100 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/core/SkRuntimeEffectProfiler.h"
+
+#include "include/core/SkTraceMemoryDump.h"
+#include "include/effects/SkRuntimeEffect.h"
+#include "src/base/SkArenaAlloc.h"
+#include "src/base/SkTime.h"
+#include "src/core/SkEffectPriv.h"
+#include "src/core/SkRasterPipeline.h"
+#include "src/core/SkRasterPipelineOpContexts.h"
+#include "src/core/SkRasterPipelineOpList.h"
+#include "src/core/SkRuntimeEffectPriv.h"
+
+#include <utility>
+
+// Both callbacks of a scope share its start time. A pipeline only ever runs on one thread at a
+// time, so no synchronization is needed; nested effects (children sampled by an effect) have
+// scopes of their own, so a parent's time includes its children's.
+struct SkRuntimeEffectProfiler::Scope {
+    struct Callback : public SkRasterPipeline_CallbackCtx {
+        Scope* fScope;
+    };
+
+    Callback fBegin, fEnd;
+    Counters* fCounters;
+    double fStart = 0;
+};
+
+SkRuntimeEffectProfiler* SkRuntimeEffectProfiler::Global() {
+    static SkRuntimeEffectProfiler* profiler = new SkRuntimeEffectProfiler;
+    return profiler;
+}
+
+SkRuntimeEffectProfiler::Counters* SkRuntimeEffectProfiler::counters(
+        const SkRuntimeEffect& effect) {
+    const uint32_t hash = SkRuntimeEffectPriv::Hash(effect);
+    SkAutoMutexExclusive lock(fMutex);
+    if (std::unique_ptr<Counters>* counters = fCounters.find(hash)) {
+        return counters->get();
+    }
+    auto counters = std::make_unique<Counters>();
+    counters->fSkSL = effect.source().c_str();
+    return fCounters.set(hash, std::move(counters))->get();
+}
+
+SkRuntimeEffectProfiler::Scope* SkRuntimeEffectProfiler::appendBegin(
+        const SkStageRec& rec, const SkRuntimeEffect& effect) {
+    if (!this->isEnabled()) {
+        return nullptr;
+    }
+    auto* scope = rec.fAlloc->make<Scope>();
+    scope->fCounters = this->counters(effect);
+    scope->fBegin.fScope = scope->fEnd.fScope = scope;
+    scope->fBegin.fn = [](SkRasterPipeline_CallbackCtx* self, int) {
+        Scope* scope = static_cast<Scope::Callback*>(self)->fScope;
+        scope->fStart = SkTime::GetNSecs();
+    };
+    rec.fPipeline->append(SkRasterPipelineOp::callback, &scope->fBegin);
+    return scope;
+}
+
+void SkRuntimeEffectProfiler::AppendEnd(const SkStageRec& rec, Scope* scope) {
+    if (!scope) {
+        return;
+    }
+    scope->fEnd.fn = [](SkRasterPipeline_CallbackCtx* self, int activePixels) {
+        Scope* scope = static_cast<Scope::Callback*>(self)->fScope;
+        const double elapsed = SkTime::GetNSecs() - scope->fStart;
+        scope->fCounters->fPixels.fetch_add(activePixels, std::memory_order_relaxed);
+        scope->fCounters->fNanoseconds.fetch_add(elapsed > 0 ? (uint64_t)elapsed : 0,
+                                                 std::memory_order_relaxed);
+    };
+    rec.fPipeline->append(SkRasterPipelineOp::callback, &scope->fEnd);
+}
+
+void SkRuntimeEffectProfiler::dump(SkTraceMemoryDump* dump) {
+    SkAutoMutexExclusive lock(fMutex);
+    fCounters.foreach([&](uint32_t hash, const std::unique_ptr<Counters>& counters) {
+        SkString dumpName = SkStringPrintf("skia/sk_runtime_effect/%08x", hash);
+        dump->dumpNumericValue(dumpName.c_str(), "pixels", "objects",
+                               counters->fPixels.load(std::memory_order_relaxed));
+        dump->dumpNumericValue(dumpName.c_str(), "time", "nanoseconds",
+                               counters->fNanoseconds.load(std::memory_order_relaxed));
+        dump->dumpStringValue(dumpName.c_str(), "sksl", counters->fSkSL.c_str());
+    });
+}
+
+void SkRuntimeEffectProfiler::reset() {
+    SkAutoMutexExclusive lock(fMutex);
+    fCounters.foreach([](uint32_t, std::unique_ptr<Counters>* counters) {
+        (*counters)->fPixels.store(0, std::memory_order_relaxed);
+        (*counters)->fNanoseconds.store(0, std::memory_order_relaxed);
+    });
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkRuntimeEffectProfiler_DEFINED
+#define SkRuntimeEffectProfiler_DEFINED
+
+#include "include/core/SkString.h"
+#include "include/private/base/SkMutex.h"
+#include "include/private/base/SkThreadAnnotations.h"
+#include "src/core/SkTHash.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+class SkRuntimeEffect;
+class SkTraceMemoryDump;
+struct SkStageRec;
+
+/**
+ *  The process-wide counters behind SkGraphics::SetRuntimeEffectProfiling(). While profiling is
+ *  enabled, the CPU backend brackets the stages of each runtime effect with a pair of callback
+ *  stages, which count the pixels the effect shades and the time spent between them. Counters are
+ *  kept per effect hash, and are never freed, because pipelines that are still running may point
+ *  at them.
+ */
+class SkRuntimeEffectProfiler {
+public:
+    struct Scope;
+
+    static SkRuntimeEffectProfiler* Global();
+
+    bool isEnabled() const { return fEnabled.load(std::memory_order_relaxed); }
+    bool setEnabled(bool enabled) { return fEnabled.exchange(enabled, std::memory_order_relaxed); }
+
+    // If profiling is enabled, appends a stage that starts timing `effect`, and returns the scope
+    // to pass to AppendEnd() once the effect's stages have been appended. Otherwise, returns
+    // nullptr.
+    Scope* appendBegin(const SkStageRec&, const SkRuntimeEffect& effect);
+    static void AppendEnd(const SkStageRec&, Scope*);
+
+    // Reports one "skia/sk_runtime_effect/<hash>" dump per effect that has been drawn.
+    void dump(SkTraceMemoryDump*);
+    void reset();
+
+private:
+    struct Counters {
+        SkString fSkSL;
+        std::atomic<uint64_t> fPixels{0};
+        std::atomic<uint64_t> fNanoseconds{0};
+    };
+
+    Counters* counters(const SkRuntimeEffect&);
+
+    std::atomic<bool> fEnabled{false};
+    SkMutex fMutex;
+    skia_private::THashMap<uint32_t, std::unique_ptr<Counters>> fCounters SK_GUARDED_BY(fMutex);
+};
+
+#endif  // SkRuntimeEffectProfiler_DEFINED
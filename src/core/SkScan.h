@@ -13,7 +13,10 @@
 #include "include/core/SkRect.h"
 #include "include/private/base/SkFixed.h"
 
+#include <cstdint>
+
 class SkBlitter;
+class SkExecutor;
 class SkPath;
 class SkRasterClip;
 class SkRegion;
@@ -36,6 +39,11 @@ public:
 
     static void FillPath(const SkPath&, const SkIRect&, SkBlitter*);
 
+    // Lets AntiFillPath() split paths with at least minPointCount points, covering at least
+    // minPixelCount pixels after clipping, into horizontal bands filled in parallel on executor.
+    // A null executor (the default) turns this off.
+    static void SetParallelAntiFill(SkExecutor*, int minPointCount, int64_t minPixelCount);
+
     // Paths of a certain size cannot be anti-aliased unless externally tiled (handled by SkDraw).
     // SkBitmapDevice automatically tiles, SkAAClip does not so SkRasterClipStack converts AA clips
     // to BW clips if that's the case. SkRegion uses this to know when to tile and union smaller
@@ -89,6 +97,9 @@ private:
     static void AntiHairLineRgn(const SkPoint[], int count, const SkRegion*, SkBlitter*);
     static void AAAFillPath(const SkPath& path, SkBlitter* blitter, const SkIRect& pathIR,
                             const SkIRect& clipBounds, bool forceRLE);
+    // Returns false, without drawing, if the path should not be filled in parallel bands.
+    static bool ParallelAAAFillPath(const SkPath& path, SkBlitter* blitter, const SkIRect& pathIR,
+                                    const SkIRect& clipBounds);
 };
 
 /** Assign an SkXRect from a SkIRect, by promoting the src rect's coordinates
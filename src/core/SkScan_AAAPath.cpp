@@ -17,6 +17,7 @@
 #include "include/private/base/SkSafe32.h"
 #include "include/private/base/SkTo.h"
 #include "src/base/SkTSort.h"
+#include "src/base/SkVx.h"
 #include "src/core/SkAlphaRuns.h"
 #include "src/core/SkAnalyticEdge.h"
 #include "src/core/SkBlitter.h"
@@ -97,6 +98,40 @@ static void safely_add_alpha(SkAlpha* alpha, SkAlpha delta) {
     *alpha = std::min(0xFF, *alpha + delta);
 }
 
+// add_alpha() and safely_add_alpha() over rows of coverage. Both are saturating adds: add_alpha()
+// only ever sees sums up to 256, which CatchOverflow() maps to 255.
+static void add_alphas(SkAlpha* alpha, const SkAlpha* delta, int n) {
+    using U8 = skvx::Vec<16, uint8_t>;
+    for (; n >= 16; n -= 16, alpha += 16, delta += 16) {
+        skvx::saturated_add(U8::Load(alpha), U8::Load(delta)).store(alpha);
+    }
+    for (; n > 0; --n) {
+        safely_add_alpha(alpha++, *delta++);
+    }
+}
+
+static void add_alphas(SkAlpha* alpha, SkAlpha delta, int n) {
+    using U8 = skvx::Vec<16, uint8_t>;
+    for (; n >= 16; n -= 16, alpha += 16) {
+        skvx::saturated_add(U8::Load(alpha), U8(delta)).store(alpha);
+    }
+    for (; n > 0; --n) {
+        safely_add_alpha(alpha++, delta);
+    }
+}
+
+// alpha = max(alpha - delta, 0) over a row.
+static void subtract_alphas(SkAlpha* alpha, const SkAlpha* delta, int n) {
+    using U8 = skvx::Vec<16, uint8_t>;
+    for (; n >= 16; n -= 16, alpha += 16, delta += 16) {
+        const U8 a = U8::Load(alpha), d = U8::Load(delta);
+        (max(a, d) - d).store(alpha);
+    }
+    for (; n > 0; --n, ++alpha, ++delta) {
+        *alpha = *alpha > *delta ? *alpha - *delta : 0;
+    }
+}
+
 class AdditiveBlitter : public SkBlitter {
 public:
     ~AdditiveBlitter() override {}
@@ -237,10 +272,7 @@ void MaskAdditiveBlitter::blitAntiH(int x, int y, const SkAlpha alpha) {
 
 void MaskAdditiveBlitter::blitAntiH(int x, int y, int width, const SkAlpha alpha) {
     SkASSERT(x >= fMask.fBounds.fLeft - 1);
-    uint8_t* row = this->getRow(y);
-    for (int i = 0; i < width; ++i) {
-        add_alpha(&row[x + i], alpha);
-    }
+    add_alphas(this->getRow(y) + x, alpha, width);
 }
 
 void MaskAdditiveBlitter::blitV(int x, int y, int height, SkAlpha alpha) {
@@ -424,9 +456,7 @@ void RunBasedAdditiveBlitter::blitAntiH(int x, int y, const SkAlpha antialias[],
         }
         fRuns.fRuns[x + i] = 1;
     }
-    for (int i = 0; i < len; ++i) {
-        add_alpha(&fRuns.fAlpha[x + i], antialias[i]);
-    }
+    add_alphas(fRuns.fAlpha + x, antialias, len);
 }
 
 void RunBasedAdditiveBlitter::blitAntiH(int x, int y, const SkAlpha alpha) {
@@ -494,9 +524,7 @@ void SafeRLEAdditiveBlitter::blitAntiH(int x, int y, const SkAlpha antialias[],
         }
         fRuns.fRuns[x + i] = 1;
     }
-    for (int i = 0; i < len; ++i) {
-        safely_add_alpha(&fRuns.fAlpha[x + i], antialias[i]);
-    }
+    add_alphas(fRuns.fAlpha + x, antialias, len);
 }
 
 void SafeRLEAdditiveBlitter::blitAntiH(int x, int y, const SkAlpha alpha) {
@@ -705,13 +733,7 @@ static void blit_full_alpha(AdditiveBlitter* blitter,
                             bool noRealBlitter,
                             bool needSafeCheck) {
     if (isUsingMask) {
-        for (int i = 0; i < len; ++i) {
-            if (needSafeCheck) {
-                safely_add_alpha(&maskRow[x + i], fullAlpha);
-            } else {
-                add_alpha(&maskRow[x + i], fullAlpha);
-            }
-        }
+        add_alphas(maskRow + x, fullAlpha, len);
     } else {
         if (fullAlpha == 0xFF && !noRealBlitter) {
             blitter->getRealBlitter()->blitH(x, y, len);
@@ -765,10 +787,10 @@ static void blit_aaa_trapezoid_row(AdditiveBlitter* blitter,
     int16_t* runs       = (int16_t*)(alphas + (len + 1) * 2);
 
     for (int i = 0; i < len; ++i) {
-        runs[i]   = 1;
-        alphas[i] = fullAlpha;
+        runs[i] = 1;
     }
     runs[len] = 0;
+    memset(alphas, fullAlpha, len);
 
     int uL = SkFixedFloorToInt(ul);
     int lL = SkFixedCeilToInt(ll);
@@ -782,13 +804,7 @@ static void blit_aaa_trapezoid_row(AdditiveBlitter* blitter,
     } else {
         compute_alpha_below_line(
                 tempAlphas + uL - L, ul - SkIntToFixed(uL), ll - SkIntToFixed(uL), lDY, fullAlpha);
-        for (int i = uL; i < lL; ++i) {
-            if (alphas[i - L] > tempAlphas[i - L]) {
-                alphas[i - L] -= tempAlphas[i - L];
-            } else {
-                alphas[i - L] = 0;
-            }
-        }
+        subtract_alphas(alphas + uL - L, tempAlphas + uL - L, lL - uL);
     }
 
     int uR = SkFixedFloorToInt(ur);
@@ -803,23 +819,11 @@ static void blit_aaa_trapezoid_row(AdditiveBlitter* blitter,
     } else {
         compute_alpha_above_line(
                 tempAlphas + uR - L, ur - SkIntToFixed(uR), lr - SkIntToFixed(uR), rDY, fullAlpha);
-        for (int i = uR; i < lR; ++i) {
-            if (alphas[i - L] > tempAlphas[i - L]) {
-                alphas[i - L] -= tempAlphas[i - L];
-            } else {
-                alphas[i - L] = 0;
-            }
-        }
+        subtract_alphas(alphas + uR - L, tempAlphas + uR - L, lR - uR);
     }
 
     if (isUsingMask) {
-        for (int i = 0; i < len; ++i) {
-            if (needSafeCheck) {
-                safely_add_alpha(&maskRow[L + i], alphas[i]);
-            } else {
-                add_alpha(&maskRow[L + i], alphas[i]);
-            }
-        }
+        add_alphas(maskRow + L, alphas, len);
     } else {
         if (fullAlpha == 0xFF && !noRealBlitter) {
             // Real blitter is faster than RunBasedAdditiveBlitter
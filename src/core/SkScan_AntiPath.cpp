@@ -7,17 +7,26 @@
 
 #include "include/core/SkPath.h"
 
+#include "include/core/SkExecutor.h"
 #include "include/core/SkRect.h"
 #include "include/core/SkRegion.h"
 #include "include/private/base/SkAssert.h"
 #include "include/private/base/SkMath.h"
+#include "include/private/base/SkTo.h"
 #include "src/core/SkAAClip.h"
 #include "src/core/SkBlitter.h"
+#include "src/core/SkMask.h"
 #include "src/core/SkRasterClip.h"
 #include "src/core/SkScan.h"
 #include "src/core/SkScanPriv.h"
+#include "src/core/SkTaskGroup.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
 
 static SkIRect safeRoundOut(const SkRect& src) {
     // roundOut will pin huge floats to max/min int
@@ -55,6 +64,133 @@ static int rect_overflows_short_shift(SkIRect rect, int shift) {
            overflows_short_shift(rect.fBottom, shift);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+
+static std::atomic<SkExecutor*> gParallelFillExecutor{nullptr};
+static std::atomic<int>         gParallelFillMinPointCount{0};
+static std::atomic<int64_t>     gParallelFillMinPixelCount{0};
+
+void SkScan::SetParallelAntiFill(SkExecutor* executor, int minPointCount, int64_t minPixelCount) {
+    gParallelFillMinPointCount.store(minPointCount);
+    gParallelFillMinPixelCount.store(minPixelCount);
+    gParallelFillExecutor.store(executor);
+}
+
+namespace {
+// Records the coverage of one band of a parallel fill in an A8 mask, so that it can be blitted
+// to the real blitter after all the bands are done.
+class BandCoverageBlitter final : public SkBlitter {
+public:
+    explicit BandCoverageBlitter(const SkIRect& bounds)
+            : fBounds(bounds)
+            , fRowBytes(bounds.width())
+            , fStorage(new uint8_t[fRowBytes * bounds.height()]()) {}
+
+    void blitH(int x, int y, int width) override {
+        memset(this->addr(x, y), 0xFF, width);
+    }
+
+    void blitAntiH(int x, int y, const SkAlpha antialias[], const int16_t runs[]) override {
+        uint8_t* dst = this->addr(x, y);
+        for (int count = runs[0]; count > 0; count = runs[0]) {
+            if (antialias[0]) {
+                memset(dst, antialias[0], count);
+            }
+            runs += count;
+            antialias += count;
+            dst += count;
+        }
+    }
+
+    void blitV(int x, int y, int height, SkAlpha alpha) override {
+        for (uint8_t* dst = this->addr(x, y); --height >= 0; dst += fRowBytes) {
+            *dst = alpha;
+        }
+    }
+
+    void blitRect(int x, int y, int width, int height) override {
+        for (uint8_t* dst = this->addr(x, y); --height >= 0; dst += fRowBytes) {
+            memset(dst, 0xFF, width);
+        }
+    }
+
+    void blitMask(const SkMask& mask, const SkIRect& clip) override {
+        if (mask.fFormat != SkMask::kA8_Format) {
+            this->SkBlitter::blitMask(mask, clip);
+            return;
+        }
+        for (int y = clip.fTop; y < clip.fBottom; ++y) {
+            memcpy(this->addr(clip.fLeft, y), mask.getAddr8(clip.fLeft, y), clip.width());
+        }
+    }
+
+    SkMask mask() const {
+        return SkMask(fStorage.get(), fBounds, fRowBytes, SkMask::kA8_Format);
+    }
+
+private:
+    uint8_t* addr(int x, int y) {
+        SkASSERT(fBounds.contains(x, y));
+        return fStorage.get() + (y - fBounds.fTop) * fRowBytes + (x - fBounds.fLeft);
+    }
+
+    const SkIRect                    fBounds;
+    const size_t                     fRowBytes;
+    const std::unique_ptr<uint8_t[]> fStorage;
+};
+}  // namespace
+
+// Fills a large path in horizontal bands, each on its own task with its own additive blitter,
+// then blits the bands' coverage to blitter from top to bottom. Each band is rasterized as if
+// clipped to that band. The bands' coverage is held until it is blitted, so the clipped bounds
+// are filled in passes of at most kMaxPassBytes of coverage each.
+bool SkScan::ParallelAAAFillPath(const SkPath& path,
+                                 SkBlitter* blitter,
+                                 const SkIRect& ir,
+                                 const SkIRect& clipBounds) {
+    SkExecutor* executor = gParallelFillExecutor.load();
+    SkIRect clippedIR;
+    if (!executor || !clippedIR.intersect(ir, clipBounds) ||
+        path.countPoints() < gParallelFillMinPointCount.load() ||
+        int64_t(clippedIR.width()) * clippedIR.height() < gParallelFillMinPixelCount.load()) {
+        return false;
+    }
+
+    // Each band re-walks the edges above it, so keep bands tall enough to be worth the overhead.
+    static constexpr int    kMaxBandCount  = 32;
+    static constexpr int    kMinBandHeight = 64;
+    static constexpr size_t kMaxPassBytes  = 16 << 20;
+    if (clippedIR.height() / kMinBandHeight < 2) {
+        return false;
+    }
+    const int passHeight = std::max(2 * kMinBandHeight,
+                                    SkToInt(kMaxPassBytes / clippedIR.width()));
+
+    std::vector<std::unique_ptr<BandCoverageBlitter>> bands;
+    SkTaskGroup tasks(*executor);
+    for (int passTop = clippedIR.fTop; passTop < clippedIR.fBottom; passTop += passHeight) {
+        const SkIRect pass = {clippedIR.fLeft, passTop,
+                              clippedIR.fRight, std::min(clippedIR.fBottom, passTop + passHeight)};
+        const int bandCount = std::clamp(pass.height() / kMinBandHeight, 1, kMaxBandCount);
+        bands.resize(bandCount);
+        tasks.batch(bandCount, [&](int i) {
+            const int top    = pass.fTop + pass.height() *  i      / bandCount;
+            const int bottom = pass.fTop + pass.height() * (i + 1) / bandCount;
+            const SkIRect band = {pass.fLeft, top, pass.fRight, bottom};
+            bands[i] = std::make_unique<BandCoverageBlitter>(band);
+            SkScan::AAAFillPath(path, bands[i].get(), ir, band, /*forceRLE=*/false);
+        });
+        tasks.wait();
+
+        for (std::unique_ptr<BandCoverageBlitter>& band : bands) {
+            const SkMask mask = band->mask();
+            blitter->blitMask(mask, mask.fBounds);
+            band.reset();
+        }
+    }
+    return true;
+}
+
 void SkScan::AntiFillPath(const SkPath& path, const SkRegion& origClip,
                           SkBlitter* blitter, bool forceRLE) {
     if (origClip.isEmpty()) {
@@ -126,7 +262,10 @@ void SkScan::AntiFillPath(const SkPath& path, const SkRegion& origClip,
         sk_blit_above(blitter, ir, *clipRgn);
     }
 
-    SkScan::AAAFillPath(path, blitter, ir, clipRgn->getBounds(), forceRLE);
+    if (isInverse || forceRLE ||
+        !SkScan::ParallelAAAFillPath(path, blitter, ir, clipRgn->getBounds())) {
+        SkScan::AAAFillPath(path, blitter, ir, clipRgn->getBounds(), forceRLE);
+    }
 
     if (isInverse) {
         sk_blit_below(blitter, ir, *clipRgn);
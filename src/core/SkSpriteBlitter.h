@@ -23,6 +23,13 @@ public:
 
     virtual bool setup(const SkPixmap& dst, int left, int top, const SkPaint&);
 
+    // Moves the source so that its top-left lands on (left, top), without redoing setup().
+    // This lets one blitter draw many sprites from the same source.
+    void setOrigin(int left, int top) {
+        fLeft = left;
+        fTop = top;
+    }
+
     // blitH, blitAntiH, blitV and blitMask should not be called on an SkSpriteBlitter.
     void blitH(int x, int y, int width) override;
     void blitAntiH(int x, int y, const SkAlpha antialias[], const int16_t runs[]) override;
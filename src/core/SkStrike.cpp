@@ -8,6 +8,7 @@
 #include "src/core/SkStrike.h"
 
 #include "include/core/SkDrawable.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkFontStyle.h"
 #include "include/core/SkMatrix.h"
 #include "include/core/SkPath.h"
@@ -16,18 +17,22 @@
 #include "include/core/SkTypeface.h"
 #include "include/private/base/SkDebug.h"
 #include "include/private/base/SkTFitsIn.h"
+#include "include/private/base/SkTo.h"
 #include "src/core/SkGlyph.h"
 #include "src/core/SkMask.h"
 #include "src/core/SkReadBuffer.h"
 #include "src/core/SkScalerContext.h"
 #include "src/core/SkStrikeCache.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/core/SkWriteBuffer.h"
 #include "src/text/StrikeForGPU.h"
 
+#include <algorithm>
 #include <cctype>
 #include <new>
 #include <optional>
 #include <utility>
+#include <vector>
 
 using namespace skglyph;
 
@@ -87,7 +92,8 @@ void
 SkStrike::FlattenGlyphsByType(SkWriteBuffer& buffer,
                               SkSpan<SkGlyph> images,
                               SkSpan<SkGlyph> paths,
-                              SkSpan<SkGlyph> drawables) {
+                              SkSpan<SkGlyph> drawables,
+                              bool runLengthEncodeImages) {
     SkASSERT_RELEASE(SkTFitsIn<int>(images.size()) &&
                      SkTFitsIn<int>(paths.size()) &&
                      SkTFitsIn<int>(drawables.size()));
@@ -96,7 +102,7 @@ SkStrike::FlattenGlyphsByType(SkWriteBuffer& buffer,
     for (SkGlyph& glyph : images) {
         SkASSERT(SkMask::IsValidFormat(glyph.maskFormat()));
         glyph.flattenMetrics(buffer);
-        glyph.flattenImage(buffer);
+        glyph.flattenImage(buffer, runLengthEncodeImages);
     }
 
     buffer.writeInt(paths.size());
@@ -114,7 +120,7 @@ SkStrike::FlattenGlyphsByType(SkWriteBuffer& buffer,
     }
 }
 
-bool SkStrike::mergeFromBuffer(SkReadBuffer& buffer) {
+bool SkStrike::mergeFromBuffer(SkReadBuffer& buffer, bool runLengthEncodedImages) {
     // Read glyphs with images for the current strike.
     const int imagesCount = buffer.readInt();
     if (imagesCount == 0 && !buffer.isValid()) {
@@ -124,7 +130,7 @@ bool SkStrike::mergeFromBuffer(SkReadBuffer& buffer) {
     {
         Monitor m{this};
         for (int curImage = 0; curImage < imagesCount; ++curImage) {
-            if (!this->mergeGlyphAndImageFromBuffer(buffer)) {
+            if (!this->mergeGlyphAndImageFromBuffer(buffer, runLengthEncodedImages)) {
                 return false;
             }
         }
@@ -217,26 +223,37 @@ void SkStrike::findIntercepts(const SkScalar bounds[2], SkScalar scale, SkScalar
 
 SkSpan<const SkGlyph*> SkStrike::metrics(
         SkSpan<const SkGlyphID> glyphIDs, const SkGlyph* results[]) {
-    Monitor m{this};
-    return this->internalPrepare(glyphIDs, kMetricsOnly, results);
+    const size_t found = fMetricsGlyphs.findPrefix(glyphIDs, results);
+    if (found < glyphIDs.size()) {
+        Monitor m{this};
+        this->internalPrepare(glyphIDs.subspan(found), kMetricsOnly, results + found);
+    }
+    return {results, glyphIDs.size()};
 }
 
 SkSpan<const SkGlyph*> SkStrike::preparePaths(
         SkSpan<const SkGlyphID> glyphIDs, const SkGlyph* results[]) {
-    Monitor m{this};
-    return this->internalPrepare(glyphIDs, kMetricsAndPath, results);
+    const size_t found = fPathGlyphs.findPrefix(glyphIDs, results);
+    if (found < glyphIDs.size()) {
+        Monitor m{this};
+        this->internalPrepare(glyphIDs.subspan(found), kMetricsAndPath, results + found);
+    }
+    return {results, glyphIDs.size()};
 }
 
 SkSpan<const SkGlyph*> SkStrike::prepareImages(
         SkSpan<const SkPackedGlyphID> glyphIDs, const SkGlyph* results[]) {
-    const SkGlyph** cursor = results;
-    Monitor m{this};
-    for (auto glyphID : glyphIDs) {
-        SkGlyph* glyph = this->glyph(glyphID);
-        this->prepareForImage(glyph);
-        *cursor++ = glyph;
+    const size_t found = fImageGlyphs.findPrefix(glyphIDs, results);
+    if (found < glyphIDs.size()) {
+        const SkGlyph** cursor = results + found;
+        Monitor m{this};
+        for (auto glyphID : glyphIDs.subspan(found)) {
+            SkGlyph* glyph = this->glyph(glyphID);
+            this->prepareForImage(glyph);
+            fMemoryIncrease += fImageGlyphs.add(glyph);
+            *cursor++ = glyph;
+        }
     }
-
     return {results, glyphIDs.size()};
 }
 
@@ -255,6 +272,71 @@ SkSpan<const SkGlyph*> SkStrike::prepareDrawables(
     return {results, glyphIDs.size()};
 }
 
+void SkStrike::prefetchImages(SkSpan<const SkPackedGlyphID> glyphIDs, SkExecutor* executor) {
+    std::vector<SkPackedGlyphID> missing;
+    {
+        Monitor m{this};
+        for (auto glyphID : glyphIDs) {
+            if (fImageGlyphs.find(glyphID) != nullptr) {
+                continue;
+            }
+            SkGlyph* glyph = this->glyph(glyphID);
+            if (glyph->setImageHasBeenCalled()) {
+                fMemoryIncrease += fImageGlyphs.add(glyph);
+            } else {
+                missing.push_back(glyphID);
+            }
+        }
+        std::sort(missing.begin(), missing.end());
+        missing.erase(std::unique(missing.begin(), missing.end()), missing.end());
+
+        if (executor == nullptr || missing.size() <= kGlyphsPerPrefetchTask) {
+            for (auto glyphID : missing) {
+                SkGlyph* glyph = this->glyph(glyphID);
+                this->prepareForImage(glyph);
+                fMemoryIncrease += fImageGlyphs.add(glyph);
+            }
+            return;
+        }
+    }
+
+    // Each task makes its glyphs from scratch with its own scaler context, into its own arena,
+    // so nothing is shared with the strike until the results are copied in below.
+    struct Task {
+        SkArenaAlloc         fAlloc{kMinAllocAmount};
+        std::vector<SkGlyph> fGlyphs;
+    };
+    const int taskCount = SkToInt((missing.size() + kGlyphsPerPrefetchTask - 1) /
+                                  kGlyphsPerPrefetchTask);
+    std::unique_ptr<Task[]> tasks{new Task[taskCount]};
+    SkTaskGroup taskGroup{*executor};
+    taskGroup.batch(taskCount, [&](int i) {
+        std::unique_ptr<SkScalerContext> scaler = fStrikeSpec.createScalerContext();
+        Task& task = tasks[i];
+        const size_t start = i * kGlyphsPerPrefetchTask;
+        const size_t end = std::min(start + kGlyphsPerPrefetchTask, missing.size());
+        task.fGlyphs.reserve(end - start);
+        for (size_t j = start; j < end; ++j) {
+            SkGlyph glyph = scaler->makeGlyph(missing[j], &task.fAlloc);
+            glyph.setImage(&task.fAlloc, scaler.get());
+            task.fGlyphs.push_back(glyph);
+        }
+    });
+    taskGroup.wait();
+
+    Monitor m{this};
+    for (int i = 0; i < taskCount; ++i) {
+        for (const SkGlyph& prefetched : tasks[i].fGlyphs) {
+            SkGlyph* glyph = this->glyph(prefetched.getPackedID());
+            // Another thread may have drawn the glyph in the meantime.
+            if (!glyph->setImageHasBeenCalled()) {
+                fMemoryIncrease += glyph->setMetricsAndImage(&fAlloc, prefetched);
+            }
+            fMemoryIncrease += fImageGlyphs.add(glyph);
+        }
+    }
+}
+
 void SkStrike::glyphIDsToPaths(SkSpan<sktext::IDOrPath> idsOrPaths) {
     Monitor m{this};
     for (sktext::IDOrPath& idOrPath : idsOrPaths) {
@@ -399,13 +481,13 @@ SkGlyph* SkStrike::mergeGlyphFromBuffer(SkReadBuffer& buffer) {
     return glyph;
 }
 
-bool SkStrike::mergeGlyphAndImageFromBuffer(SkReadBuffer& buffer) {
+bool SkStrike::mergeGlyphAndImageFromBuffer(SkReadBuffer& buffer, bool runLengthEncoded) {
     SkASSERT(buffer.isValid());
     SkGlyph* glyph = this->mergeGlyphFromBuffer(buffer);
     if (!buffer.validate(glyph != nullptr)) {
         return false;
     }
-    fMemoryIncrease += glyph->addImageFromBuffer(buffer, &fAlloc);
+    fMemoryIncrease += glyph->addImageFromBuffer(buffer, &fAlloc, runLengthEncoded);
     return buffer.isValid();
 }
 
@@ -434,8 +516,12 @@ SkSpan<const SkGlyph*> SkStrike::internalPrepare(
     const SkGlyph** cursor = results;
     for (auto glyphID : glyphIDs) {
         SkGlyph* glyph = this->glyph(SkPackedGlyphID{glyphID});
+        fMemoryIncrease += fMetricsGlyphs.add(glyph);
         if (pathDetail == kMetricsAndPath) {
             this->prepareForPath(glyph);
+            if (glyph->setPathHasBeenCalled()) {
+                fMemoryIncrease += fPathGlyphs.add(glyph);
+            }
         }
         *cursor++ = glyph;
     }
@@ -443,6 +529,53 @@ SkSpan<const SkGlyph*> SkStrike::internalPrepare(
     return {results, glyphIDs.size()};
 }
 
+SkStrike::PublishedGlyphs::Table::Table(uint32_t capacity)
+        : fCapacity{capacity}
+        , fSlots{new std::atomic<const SkGlyph*>[capacity]} {
+    for (uint32_t i = 0; i < capacity; ++i) {
+        fSlots[i].store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+void SkStrike::PublishedGlyphs::Table::insert(const SkGlyph* glyph) {
+    const uint32_t mask = fCapacity - 1;
+    uint32_t i = glyph->getPackedID().hash() & mask;
+    while (fSlots[i].load(std::memory_order_relaxed) != nullptr) {
+        i = (i + 1) & mask;
+    }
+    // Pairs with the acquire in find(), so readers see the glyph's data.
+    fSlots[i].store(glyph, std::memory_order_release);
+}
+
+size_t SkStrike::PublishedGlyphs::add(const SkGlyph* glyph) {
+    if (this->find(glyph->getPackedID()) != nullptr) {
+        return 0;
+    }
+
+    size_t increase = 0;
+    Table* table = fTable.load(std::memory_order_relaxed);
+    // Keep the table at most half full so searches stay short and always reach an empty slot.
+    if (table == nullptr || 2 * (fCount + 1) > table->fCapacity) {
+        const uint32_t capacity = table == nullptr ? 16 : 2 * table->fCapacity;
+        auto bigger = std::make_unique<Table>(capacity);
+        if (table != nullptr) {
+            for (uint32_t i = 0; i < table->fCapacity; ++i) {
+                if (const SkGlyph* g = table->fSlots[i].load(std::memory_order_relaxed)) {
+                    bigger->insert(g);
+                }
+            }
+        }
+        table = bigger.get();
+        fTables.push_back(std::move(bigger));
+        fTable.store(table, std::memory_order_release);
+        increase = sizeof(Table) + capacity * sizeof(std::atomic<const SkGlyph*>);
+    }
+
+    table->insert(glyph);
+    fCount += 1;
+    return increase;
+}
+
 void SkStrike::updateMemoryUsage(size_t increase) {
     if (increase > 0) {
         // fRemoved and the cache's total memory are managed under the cache's lock. This allows
@@ -21,12 +21,15 @@
 #include "src/core/SkTHash.h"
 #include "src/text/StrikeForGPU.h"
 
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <vector>
 
 class SkDescriptor;
 class SkDrawable;
+class SkExecutor;
 class SkPath;
 class SkReadBuffer;
 class SkStrikeCache;
@@ -56,11 +59,14 @@ public:
     bool prepareForPath(SkGlyph*) override SK_REQUIRES(fStrikeLock);
     bool prepareForDrawable(SkGlyph*) override SK_REQUIRES(fStrikeLock);
 
-    bool mergeFromBuffer(SkReadBuffer& buffer) SK_EXCLUDES(fStrikeLock);
+    // runLengthEncodedImages must match what the glyphs were flattened with.
+    bool mergeFromBuffer(SkReadBuffer& buffer,
+                         bool runLengthEncodedImages = false) SK_EXCLUDES(fStrikeLock);
     static void FlattenGlyphsByType(SkWriteBuffer& buffer,
                                     SkSpan<SkGlyph> images,
                                     SkSpan<SkGlyph> paths,
-                                    SkSpan<SkGlyph> drawables);
+                                    SkSpan<SkGlyph> drawables,
+                                    bool runLengthEncodeImages = false);
 
     // Lookup (or create if needed) the returned glyph using toID. If that glyph is not initialized
     // with an image, then use the information in fromGlyph to initialize the width, height top,
@@ -99,6 +105,13 @@ public:
     SkSpan<const SkGlyph*> prepareDrawables(
             SkSpan<const SkGlyphID> glyphIDs, const SkGlyph* results[]) SK_EXCLUDES(fStrikeLock);
 
+    // Generate the images of the glyphs in glyphIDs that have none yet, spread over tasks on
+    // executor that each use their own scaler context, and add them to the strike together once
+    // all are done. Afterwards, prepareImages() finds these glyphs without generating anything.
+    // A null executor, or too few missing glyphs to be worth splitting, generates them here.
+    void prefetchImages(SkSpan<const SkPackedGlyphID> glyphIDs,
+                        SkExecutor* executor) SK_EXCLUDES(fStrikeLock);
+
     // SkStrikeForGPU APIs
     const SkDescriptor& getDescriptor() const override {
         return fStrikeSpec.descriptor();
@@ -138,6 +151,58 @@ private:
     friend class SkStrikeTestingPeer;
     class Monitor;
 
+    // A set of glyphs keyed by packed glyph ID that can be searched without the strike lock.
+    // Glyphs are only added, with the strike lock held, and only once the data a reader needs
+    // from them is set. Outgrown tables are kept until the strike is destroyed, so a reader
+    // holding an old table never looks at freed memory.
+    class PublishedGlyphs {
+    public:
+        const SkGlyph* find(SkPackedGlyphID packedID) const {
+            const Table* table = fTable.load(std::memory_order_acquire);
+            if (table == nullptr) {
+                return nullptr;
+            }
+            const uint32_t mask = table->fCapacity - 1;
+            for (uint32_t i = packedID.hash() & mask;; i = (i + 1) & mask) {
+                const SkGlyph* glyph = table->fSlots[i].load(std::memory_order_acquire);
+                if (glyph == nullptr || glyph->getPackedID() == packedID) {
+                    return glyph;
+                }
+            }
+        }
+
+        // Fills results with the glyphs for glyphIDs up to the first one not published, and
+        // returns how many were found.
+        template <typename ID>
+        size_t findPrefix(SkSpan<const ID> glyphIDs, const SkGlyph* results[]) const {
+            size_t found = 0;
+            for (auto glyphID : glyphIDs) {
+                const SkGlyph* glyph = this->find(SkPackedGlyphID{glyphID});
+                if (glyph == nullptr) {
+                    break;
+                }
+                results[found++] = glyph;
+            }
+            return found;
+        }
+
+        // Returns the number of bytes allocated for a larger table, if any.
+        size_t add(const SkGlyph* glyph);
+
+    private:
+        struct Table {
+            explicit Table(uint32_t capacity);
+            void insert(const SkGlyph* glyph);
+
+            const uint32_t fCapacity;
+            std::unique_ptr<std::atomic<const SkGlyph*>[]> fSlots;
+        };
+
+        std::atomic<Table*> fTable{nullptr};
+        std::vector<std::unique_ptr<Table>> fTables;
+        uint32_t fCount = 0;
+    };
+
     // Return a glyph. Create it if it doesn't exist, and initialize the glyph with metrics and
     // advances using a scaler.
     SkGlyph* glyph(SkPackedGlyphID) SK_REQUIRES(fStrikeLock);
@@ -146,7 +211,8 @@ private:
     SkGlyphDigest* addGlyphAndDigest(SkGlyph* glyph) SK_REQUIRES(fStrikeLock);
 
     SkGlyph* mergeGlyphFromBuffer(SkReadBuffer& buffer) SK_REQUIRES(fStrikeLock);
-    bool mergeGlyphAndImageFromBuffer(SkReadBuffer& buffer) SK_REQUIRES(fStrikeLock);
+    bool mergeGlyphAndImageFromBuffer(SkReadBuffer& buffer,
+                                      bool runLengthEncoded) SK_REQUIRES(fStrikeLock);
     bool mergeGlyphAndPathFromBuffer(SkReadBuffer& buffer) SK_REQUIRES(fStrikeLock);
     bool mergeGlyphAndDrawableFromBuffer(SkReadBuffer& buffer) SK_REQUIRES(fStrikeLock);
 
@@ -190,6 +256,10 @@ private:
     // Used while changing the strike to track memory increase.
     size_t fMemoryIncrease SK_GUARDED_BY(fStrikeLock) {0};
 
+    // The number of glyphs prefetchImages() generates per task, so the cost of making each task's
+    // scaler context is spread over a few glyphs.
+    inline static constexpr size_t kGlyphsPerPrefetchTask = 32;
+
     // So, we don't grow our arrays a lot.
     inline static constexpr size_t kMinGlyphCount = 8;
     inline static constexpr size_t kMinGlyphImageSize = 16 /* height */ * 8 /* width */;
@@ -197,6 +267,12 @@ private:
 
     SkArenaAlloc            fAlloc SK_GUARDED_BY(fStrikeLock) {kMinAllocAmount};
 
+    // Glyphs with metrics, images and paths already generated. metrics(), prepareImages() and
+    // preparePaths() look here before taking the strike lock. Only adding needs the lock.
+    PublishedGlyphs fMetricsGlyphs;
+    PublishedGlyphs fImageGlyphs;
+    PublishedGlyphs fPathGlyphs;
+
     // The following are protected by the SkStrikeCache's mutex.
     SkStrike*                       fNext{nullptr};
     SkStrike*                       fPrev{nullptr};
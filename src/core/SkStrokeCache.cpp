@@ -0,0 +1,118 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/core/SkStrokeCache.h"
+
+#include "include/core/SkPath.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkScalar.h"
+#include "include/core/SkStrokeRec.h"
+#include "include/core/SkTypes.h"
+#include "include/private/SkIDChangeListener.h"
+#include "src/core/SkPathPriv.h"
+#include "src/core/SkResourceCache.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#define CHECK_LOCAL(localCache, localName, globalName, ...) \
+    ((localCache) ? localCache->localName(__VA_ARGS__) : SkResourceCache::globalName(__VA_ARGS__))
+
+// Stroking a path this short costs less than a cache lookup.
+static constexpr int kMinVerbsToCache = 8;
+
+static uint64_t make_shared_id(uint32_t pathGenID) {
+    uint64_t sharedID = SkSetFourByteTag('s', 't', 'r', 'k');
+    return (sharedID << 32) | pathGenID;
+}
+
+namespace {
+static unsigned gStrokeKeyNamespaceLabel;
+
+struct StrokeKey : public SkResourceCache::Key {
+public:
+    StrokeKey(const SkPath& path, const SkStrokeRec& rec)
+        : fGenID(path.getGenerationID())
+        , fWidth(rec.getWidth())
+        , fMiter(rec.getMiter())
+        , fResScale(rec.getResScale())
+        , fFlags(rec.getCap() |
+                 rec.getJoin() << 8 |
+                 (rec.getStyle() == SkStrokeRec::kStrokeAndFill_Style) << 16 |
+                 (int)path.getFillType() << 24)
+    {
+        this->init(&gStrokeKeyNamespaceLabel, make_shared_id(fGenID),
+                   sizeof(fGenID) + sizeof(fWidth) + sizeof(fMiter) + sizeof(fResScale) +
+                   sizeof(fFlags));
+    }
+
+    uint32_t fGenID;
+    SkScalar fWidth;
+    SkScalar fMiter;
+    SkScalar fResScale;
+    uint32_t fFlags;
+};
+
+class StrokePurgeListener final : public SkIDChangeListener {
+public:
+    explicit StrokePurgeListener(uint64_t sharedID) : fSharedID(sharedID) {}
+
+    void changed() override { SkResourceCache::PostPurgeSharedID(fSharedID); }
+
+private:
+    uint64_t fSharedID;
+};
+
+struct StrokeRec : public SkResourceCache::Rec {
+    StrokeRec(const StrokeKey& key, const SkPath& outline, sk_sp<SkIDChangeListener> listener)
+        : fKey(key), fOutline(outline), fListener(std::move(listener)) {}
+    ~StrokeRec() override {
+        fListener->markShouldDeregister();
+    }
+
+    StrokeKey fKey;
+    SkPath fOutline;
+    sk_sp<SkIDChangeListener> fListener;
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override { return sizeof(*this) + fOutline.approximateBytesUsed(); }
+    const char* getCategory() const override { return "stroke"; }
+    SkDiscardableMemory* diagnostic_only_getDiscardable() const override { return nullptr; }
+
+    static bool Visitor(const SkResourceCache::Rec& baseRec, void* contextData) {
+        const StrokeRec& rec = static_cast<const StrokeRec&>(baseRec);
+        *static_cast<SkPath*>(contextData) = rec.fOutline;
+        return true;
+    }
+};
+} // namespace
+
+bool SkStrokeCache::ApplyToPath(const SkStrokeRec& rec, const SkPath& src, SkPath* dst,
+                                SkResourceCache* localCache) {
+    const SkScalar resScale = rec.getResScale();
+    if (!rec.needToApply() || src.isVolatile() || src.countVerbs() < kMinVerbsToCache ||
+        !(resScale > 0 && SkIsFinite(resScale))) {
+        return rec.applyToPath(dst, src);
+    }
+
+    SkStrokeRec bucketed = rec;
+    bucketed.setResScale(std::exp2(std::ceil(std::log2(resScale))));
+    const StrokeKey key(src, bucketed);
+    if (CHECK_LOCAL(localCache, find, Find, key, StrokeRec::Visitor, dst)) {
+        return true;
+    }
+
+    SkPath outline;
+    SkAssertResult(bucketed.applyToPath(&outline, src));
+    auto listener = sk_make_sp<StrokePurgeListener>(key.getSharedID());
+    SkPathPriv::AddGenIDChangeListener(src, listener);
+    CHECK_LOCAL(localCache, add, Add, new StrokeRec(key, outline, std::move(listener)));
+    *dst = std::move(outline);
+    return true;
+}
@@ -0,0 +1,29 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkStrokeCache_DEFINED
+#define SkStrokeCache_DEFINED
+
+class SkPath;
+class SkResourceCache;
+class SkStrokeRec;
+
+class SkStrokeCache {
+public:
+    /**
+     * Like rec.applyToPath(dst, src), but reuses the outline from an earlier call with the same
+     * path (by generation ID) and stroke parameters while it is in the SkResourceCache. The
+     * entries are purged when the path's generation ID goes away.
+     *
+     * Volatile paths and small paths are stroked every time. The resScale is rounded up to a power
+     * of two, so a cached outline is at least as precise as requested.
+     */
+    static bool ApplyToPath(const SkStrokeRec& rec, const SkPath& src, SkPath* dst,
+                            SkResourceCache* localCache = nullptr);
+};
+
+#endif
@@ -0,0 +1,459 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkTHashGroupTable_DEFINED
+#define SkTHashGroupTable_DEFINED
+
+#include "include/core/SkTypes.h"
+#include "include/private/base/SkAssert.h"
+#include "src/base/SkMathPriv.h"
+#include "src/core/SkTHash.h"
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <utility>
+
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE2
+    #include <emmintrin.h>
+#elif defined(SK_ARM_HAS_NEON)
+    #include <arm_neon.h>
+#endif
+
+namespace skia_private {
+
+// THashGroupTable is a drop-in alternative to THashTable, with the same interface and the same
+// Traits requirements.  It is an open-addressing table in the style of Abseil's Swiss tables:
+// alongside the slots we keep one control byte per slot, holding either 7 bits of the slot's hash
+// or a marker for an empty or deleted slot.  Lookups probe 16 control bytes at a time with SIMD
+// compares, so they rarely touch a slot whose key doesn't match, and stay fast at high load.
+//
+// Prefer it for large, lookup-heavy tables with keys that are expensive to compare.  Small tables
+// and cheap keys usually do just as well with THashTable.  THashGroupMap and THashGroupSet below
+// wrap it exactly as THashMap and THashSet wrap THashTable.
+template <typename T, typename K, typename Traits = T>
+class THashGroupTable {
+public:
+    THashGroupTable() = default;
+    ~THashGroupTable() { this->destroySlots(); }
+
+    THashGroupTable(const THashGroupTable&  that) { *this = that; }
+    THashGroupTable(      THashGroupTable&& that) { *this = std::move(that); }
+
+    THashGroupTable& operator=(const THashGroupTable& that) {
+        if (this != &that) {
+            this->destroySlots();
+            fCount      = that.fCount;
+            fCapacity   = that.fCapacity;
+            fGrowthLeft = that.fGrowthLeft;
+            fCtrl.reset(fCapacity ? new int8_t[fCapacity] : nullptr);
+            fSlots.reset(fCapacity ? new Slot[fCapacity] : nullptr);
+            if (fCapacity) {
+                memcpy(fCtrl.get(), that.fCtrl.get(), fCapacity);
+            }
+            for (int i = 0; i < fCapacity; i++) {
+                if (IsFull(fCtrl[i])) {
+                    new (&fSlots[i].fVal) T(that.fSlots[i].fVal);
+                }
+            }
+        }
+        return *this;
+    }
+
+    THashGroupTable& operator=(THashGroupTable&& that) {
+        if (this != &that) {
+            this->destroySlots();
+            fCount      = that.fCount;
+            fCapacity   = that.fCapacity;
+            fGrowthLeft = that.fGrowthLeft;
+            fCtrl       = std::move(that.fCtrl);
+            fSlots      = std::move(that.fSlots);
+
+            that.fCount = that.fCapacity = that.fGrowthLeft = 0;
+        }
+        return *this;
+    }
+
+    // Clear the table.
+    void reset() { *this = THashGroupTable(); }
+
+    // How many entries are in the table?
+    int count() const { return fCount; }
+
+    // How many slots does the table contain?
+    int capacity() const { return fCapacity; }
+
+    // Approximately how many bytes of memory do we use beyond sizeof(*this)?
+    size_t approxBytesUsed() const { return fCapacity * (sizeof(Slot) + sizeof(int8_t)); }
+
+    // Exchange two hash tables.
+    void swap(THashGroupTable& that) {
+        std::swap(fCount, that.fCount);
+        std::swap(fCapacity, that.fCapacity);
+        std::swap(fGrowthLeft, that.fGrowthLeft);
+        std::swap(fCtrl, that.fCtrl);
+        std::swap(fSlots, that.fSlots);
+    }
+
+    void swap(THashGroupTable&& that) {
+        *this = std::move(that);
+    }
+
+    // The same cautions as THashTable apply: don't change an entry's key through the pointers
+    // returned by set(), find() or foreach(), and those pointers are valid only until the next
+    // call to set() or remove().
+
+    // Copy val into the hash table, returning a pointer to the copy now in the table.
+    // If there already is an entry in the table with the same key, we overwrite it.
+    T* set(T val) {
+        if (fGrowthLeft == 0) {
+            // Grow geometrically, or just sweep out tombstones if they're what filled us up.
+            this->resize(fCount + fCount / 2 + 1);
+        }
+        return this->uncheckedSet(std::move(val));
+    }
+
+    // If there is an entry in the table with this key, return a pointer to it.  If not, null.
+    T* find(const K& key) const {
+        int index = this->findIndex(key, Hash(key));
+        return index < 0 ? nullptr : &fSlots[index].fVal;
+    }
+
+    // If there is an entry in the table with this key, return it.  If not, null.
+    // This only works for pointer type T, and cannot be used to find an nullptr entry.
+    T findOrNull(const K& key) const {
+        if (T* p = this->find(key)) {
+            return *p;
+        }
+        return nullptr;
+    }
+
+    // If a value with this key exists in the hash table, removes it and returns true.
+    // Otherwise, returns false.
+    bool removeIfExists(const K& key) {
+        int index = this->findIndex(key, Hash(key));
+        if (index < 0) {
+            return false;
+        }
+        fSlots[index].fVal.~T();
+        fCount--;
+
+        // A probe only moves past a group once it has found that group full, so if this slot's
+        // group still has an empty slot no probe ever went on past it, and this slot may become
+        // empty too.  Otherwise it must stay a tombstone to keep those longer probes intact.
+        if (Group::MatchEmpty(&fCtrl[index & ~(kGroupWidth - 1)])) {
+            fCtrl[index] = kEmpty;
+            fGrowthLeft++;
+        } else {
+            fCtrl[index] = kDeleted;
+        }
+
+        if (4 * fCount <= fCapacity && fCapacity > kGroupWidth) {
+            this->resize(fCount);
+        }
+        return true;
+    }
+
+    // Removes the value with this key from the hash table. Asserts if it is missing.
+    void remove(const K& key) {
+        SkAssertResult(this->removeIfExists(key));
+    }
+
+    // Rebuilds the table with room for at least `count` entries before it needs to grow again,
+    // discarding any tombstones.  Like THashTable::resize(), this can be called to manually grow
+    // capacity before a bulk insertion.
+    void resize(int count) {
+        SkASSERT(count >= fCount);
+        int capacity = kGroupWidth;
+        while (MaxLoad(capacity) < count) {
+            capacity *= 2;
+        }
+
+        std::unique_ptr<int8_t[]> oldCtrl  = std::move(fCtrl);
+        std::unique_ptr<Slot[]>   oldSlots = std::move(fSlots);
+        int oldCapacity = fCapacity;
+
+        fCapacity   = capacity;
+        fGrowthLeft = MaxLoad(capacity) - fCount;
+        fCtrl.reset(new int8_t[capacity]);
+        fSlots.reset(new Slot[capacity]);
+        memset(fCtrl.get(), kEmpty, capacity);
+
+        for (int i = 0; i < oldCapacity; i++) {
+            if (IsFull(oldCtrl[i])) {
+                T& val = oldSlots[i].fVal;
+                uint32_t hash = Hash(Traits::GetKey(val));
+                int index = this->findInsertIndex(hash);
+                new (&fSlots[index].fVal) T(std::move(val));
+                fCtrl[index] = H2(hash);
+                val.~T();
+            }
+        }
+    }
+
+    // Call fn on every entry in the table.  You may mutate the entries, but be very careful.
+    template <typename Fn>  // f(T*)
+    void foreach(Fn&& fn) {
+        for (int i = 0; i < fCapacity; i++) {
+            if (IsFull(fCtrl[i])) {
+                fn(&fSlots[i].fVal);
+            }
+        }
+    }
+
+    // Call fn on every entry in the table.  You may not mutate anything.
+    template <typename Fn>  // f(T) or f(const T&)
+    void foreach(Fn&& fn) const {
+        for (int i = 0; i < fCapacity; i++) {
+            if (IsFull(fCtrl[i])) {
+                fn(fSlots[i].fVal);
+            }
+        }
+    }
+
+    // A basic iterator-like class which disallows mutation; sufficient for range-based for loops.
+    // Intended for use by THashMap and THashSet via begin() and end().
+    // Adding or removing elements may invalidate all iterators.
+    template <typename SlotVal>
+    class Iter {
+    public:
+        using TTable = THashGroupTable<T, K, Traits>;
+
+        Iter(const TTable* table, int slot) : fTable(table), fSlot(slot) {}
+
+        static Iter MakeBegin(const TTable* table) {
+            return Iter{table, table->nextPopulatedSlot(-1)};
+        }
+
+        static Iter MakeEnd(const TTable* table) {
+            return Iter{table, table->capacity()};
+        }
+
+        const SlotVal& operator*() const {
+            return *fTable->slot(fSlot);
+        }
+
+        const SlotVal* operator->() const {
+            return fTable->slot(fSlot);
+        }
+
+        bool operator==(const Iter& that) const {
+            // Iterators from different tables shouldn't be compared against each other.
+            SkASSERT(fTable == that.fTable);
+            return fSlot == that.fSlot;
+        }
+
+        bool operator!=(const Iter& that) const {
+            return !(*this == that);
+        }
+
+        Iter& operator++() {
+            fSlot = fTable->nextPopulatedSlot(fSlot);
+            return *this;
+        }
+
+        Iter operator++(int) {
+            Iter old = *this;
+            this->operator++();
+            return old;
+        }
+
+    protected:
+        const TTable* fTable;
+        int fSlot;
+    };
+
+private:
+    static constexpr int kGroupWidth = 16;
+
+    // Control bytes: a full slot holds the low 7 bits of its hash, so is never negative.
+    static constexpr int8_t kEmpty   = -128;
+    static constexpr int8_t kDeleted =   -2;
+
+    static bool IsFull(int8_t ctrl) { return ctrl >= 0; }
+
+    // We keep at least 1/8 of the slots empty so probes for missing keys stay short.
+    static int MaxLoad(int capacity) { return capacity - capacity / 8; }
+
+    static uint32_t Hash(const K& key) { return Traits::Hash(key) & 0xffffffff; }
+
+    // The low 7 bits of the hash go in the control byte, the rest pick the first group to probe.
+    static int8_t H2(uint32_t hash) { return (int8_t)(hash & 0x7f); }
+    static uint32_t H1(uint32_t hash) { return hash >> 7; }
+
+    // Masks with one bit set for each of a group's 16 control bytes that matches.  With NEON the
+    // bits are 4 apart, so slot indices come from the bit index >> Group::kShift.
+    struct Group {
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE2
+        static constexpr int kShift = 0;
+
+        static uint64_t Match(const int8_t* ctrl, int8_t h2) {
+            __m128i c = _mm_loadu_si128((const __m128i*)ctrl);
+            return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(c, _mm_set1_epi8(h2)));
+        }
+        static uint64_t MatchEmpty(const int8_t* ctrl) { return Match(ctrl, kEmpty); }
+        static uint64_t MatchEmptyOrDeleted(const int8_t* ctrl) {
+            // Only empty and deleted control bytes have their top bit set.
+            return (uint32_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)ctrl));
+        }
+#elif defined(SK_ARM_HAS_NEON)
+        static constexpr int kShift = 2;
+
+        static uint64_t ToMask(uint8x16_t eq) {
+            // Narrowing each 16-bit pair of 0x00/0xff bytes by 4 bits leaves a nibble per byte.
+            uint8x8_t nibbles = vshrn_n_u16(vreinterpretq_u16_u8(eq), 4);
+            return vget_lane_u64(vreinterpret_u64_u8(nibbles), 0) & 0x8888888888888888ull;
+        }
+        static uint64_t Match(const int8_t* ctrl, int8_t h2) {
+            return ToMask(vceqq_s8(vld1q_s8(ctrl), vdupq_n_s8(h2)));
+        }
+        static uint64_t MatchEmpty(const int8_t* ctrl) { return Match(ctrl, kEmpty); }
+        static uint64_t MatchEmptyOrDeleted(const int8_t* ctrl) {
+            return ToMask(vcltq_s8(vld1q_s8(ctrl), vdupq_n_s8(0)));
+        }
+#else
+        static constexpr int kShift = 0;
+
+        static uint64_t Match(const int8_t* ctrl, int8_t h2) {
+            uint64_t mask = 0;
+            for (int i = 0; i < kGroupWidth; i++) {
+                mask |= (uint64_t)(ctrl[i] == h2) << i;
+            }
+            return mask;
+        }
+        static uint64_t MatchEmpty(const int8_t* ctrl) { return Match(ctrl, kEmpty); }
+        static uint64_t MatchEmptyOrDeleted(const int8_t* ctrl) {
+            uint64_t mask = 0;
+            for (int i = 0; i < kGroupWidth; i++) {
+                mask |= (uint64_t)(ctrl[i] < 0) << i;
+            }
+            return mask;
+        }
+#endif
+
+        static int Lowest(uint64_t mask) {
+            SkASSERT(mask);
+            uint32_t lo = (uint32_t)mask;
+            int bit = lo ? SkCTZ(lo) : 32 + SkCTZ((uint32_t)(mask >> 32));
+            return bit >> kShift;
+        }
+    };
+
+    // Groups are probed in triangular steps (+1, +2, +3...), which visits every group of a
+    // power-of-two sized table before repeating.
+    template <typename Fn>  // bool f(int group) returns true to stop probing.
+    int probe(uint32_t hash, Fn&& fn) const {
+        const int groupMask = fCapacity / kGroupWidth - 1;
+        int group = H1(hash) & groupMask;
+        for (int step = 1; step <= groupMask + 1; step++) {
+            int index = fn(group * kGroupWidth);
+            if (index != kKeepProbing) {
+                return index;
+            }
+            group = (group + step) & groupMask;
+        }
+        return -1;
+    }
+    static constexpr int kKeepProbing = -2;
+
+    int findIndex(const K& key, uint32_t hash) const {
+        if (fCount == 0) {
+            return -1;
+        }
+        const int8_t h2 = H2(hash);
+        return this->probe(hash, [&](int base) {
+            const int8_t* ctrl = &fCtrl[base];
+            for (uint64_t m = Group::Match(ctrl, h2); m; m &= m - 1) {
+                int index = base + Group::Lowest(m);
+                if (key == Traits::GetKey(fSlots[index].fVal)) {
+                    return index;
+                }
+            }
+            return Group::MatchEmpty(ctrl) ? -1 : kKeepProbing;
+        });
+    }
+
+    // Finds the first empty or deleted slot along hash's probe sequence.
+    int findInsertIndex(uint32_t hash) const {
+        int index = this->probe(hash, [&](int base) {
+            uint64_t m = Group::MatchEmptyOrDeleted(&fCtrl[base]);
+            return m ? base + Group::Lowest(m) : kKeepProbing;
+        });
+        SkASSERT(index >= 0);
+        return index;
+    }
+
+    T* uncheckedSet(T&& val) {
+        const K& key = Traits::GetKey(val);
+        SkASSERT(key == key);
+        uint32_t hash = Hash(key);
+
+        int index = this->findIndex(key, hash);
+        if (index >= 0) {
+            // Overwrite previous entry.
+            fSlots[index].fVal.~T();
+            return new (&fSlots[index].fVal) T(std::move(val));
+        }
+
+        index = this->findInsertIndex(hash);
+        if (fCtrl[index] == kEmpty) {
+            SkASSERT(fGrowthLeft > 0);
+            fGrowthLeft--;
+        }
+        fCtrl[index] = H2(hash);
+        fCount++;
+        return new (&fSlots[index].fVal) T(std::move(val));
+    }
+
+    void destroySlots() {
+        for (int i = 0; i < fCapacity; i++) {
+            if (IsFull(fCtrl[i])) {
+                fSlots[i].fVal.~T();
+            }
+        }
+    }
+
+    // Increments an iterator's slot.
+    int nextPopulatedSlot(int currentSlot) const {
+        for (int i = currentSlot + 1; i < fCapacity; i++) {
+            if (IsFull(fCtrl[i])) {
+                return i;
+            }
+        }
+        return fCapacity;
+    }
+
+    // Reads from an iterator's slot.
+    const T* slot(int i) const {
+        SkASSERT(IsFull(fCtrl[i]));
+        return &fSlots[i].fVal;
+    }
+
+    // Raw storage for a T; whether it holds one is tracked by the matching control byte.
+    struct Slot {
+        Slot() {}
+        ~Slot() {}
+        union { T fVal; };
+    };
+
+    int fCount      = 0,
+        fCapacity   = 0,
+        fGrowthLeft = 0;  // How many more empty slots we can fill before we must rehash.
+    std::unique_ptr<int8_t[]> fCtrl;
+    std::unique_ptr<Slot[]>   fSlots;
+};
+
+template <typename K, typename V, typename HashK = SkGoodHash>
+using THashGroupMap = THashMap<K, V, HashK, THashGroupTable>;
+
+template <typename T, typename HashT = SkGoodHash>
+using THashGroupSet = THashSet<T, HashT, THashGroupTable>;
+
+}  // namespace skia_private
+
+#endif  // SkTHashGroupTable_DEFINED
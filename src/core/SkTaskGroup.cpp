@@ -48,7 +48,7 @@ void SkTaskGroup::wait() {
 
 SkTaskGroup::Enabler::Enabler(int threads) {
     if (threads) {
-        fThreadPool = SkExecutor::MakeLIFOThreadPool(threads);
+        fThreadPool = SkExecutor::MakeWorkStealingThreadPool(threads);
         SkExecutor::SetDefault(fThreadPool.get());
     }
 }
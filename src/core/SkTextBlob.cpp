@@ -31,6 +31,7 @@
 
 #include <algorithm>
 #include <atomic>
+#include <cmath>
 #include <limits>
 #include <new>
 #include <vector>
@@ -181,12 +182,142 @@ union PositioningAndExtended {
     struct {
         uint8_t  positioning;
         uint8_t  extended;
-        uint16_t padding;
+        uint16_t flags;  // zero before kCompactTextBlobs
     };
 };
 
 static_assert(sizeof(PositioningAndExtended) == sizeof(int32_t), "");
 
+// How a serialized run is packed.
+enum : uint16_t {
+    kSameFont_RunFlag        = 1 << 0,  // the font is the previous run's, and isn't written
+    kPackedGlyphs_RunFlag    = 1 << 1,  // glyph IDs are varints of zigzagged deltas
+    kPackedPositions_RunFlag = 1 << 2,  // positions are varints of zigzagged fixed point deltas
+};
+
+// Positions are packed as fixed point with at most this many fractional bits, and only when that
+// represents every one of them exactly.
+static constexpr int kMaxPositionShift = 16;
+// Past this, the deltas between fixed point positions could overflow.
+static constexpr float kMaxFixedPosition = 1 << 30;
+
+uint32_t zigzag(int32_t v) {
+    return (static_cast<uint32_t>(v) << 1) ^ static_cast<uint32_t>(v >> 31);
+}
+
+int32_t unzigzag(uint32_t v) {
+    return static_cast<int32_t>(v >> 1) ^ -static_cast<int32_t>(v & 1);
+}
+
+void write_varint(TArray<uint8_t>* bytes, uint32_t v) {
+    while (v >= 0x80) {
+        bytes->push_back(static_cast<uint8_t>(v | 0x80));
+        v >>= 7;
+    }
+    bytes->push_back(static_cast<uint8_t>(v));
+}
+
+bool read_varint(const uint8_t** cur, const uint8_t* end, uint32_t* v) {
+    uint32_t result = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+        if (*cur == end) {
+            return false;
+        }
+        const uint8_t byte = *(*cur)++;
+        result |= static_cast<uint32_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+            *v = result;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Packs glyph IDs as deltas from the previous glyph, which are small within most runs. Returns
+// false if that isn't smaller than writing them as they are.
+bool pack_glyphs(const uint16_t glyphs[], int count, TArray<uint8_t>* bytes) {
+    const int rawSize = count * sizeof(uint16_t);
+    bytes->clear();
+    bytes->reserve(count);
+    int32_t prev = 0;
+    for (int i = 0; i < count && bytes->size() < rawSize; i++) {
+        write_varint(bytes, zigzag(glyphs[i] - prev));
+        prev = glyphs[i];
+    }
+    return bytes->size() < rawSize;
+}
+
+bool unpack_glyphs(const uint8_t* cur, const uint8_t* end, uint16_t glyphs[], int count) {
+    uint16_t prev = 0;
+    for (int i = 0; i < count; i++) {
+        uint32_t v;
+        if (!read_varint(&cur, end, &v)) {
+            return false;
+        }
+        prev = glyphs[i] = static_cast<uint16_t>(prev + unzigzag(v));
+    }
+    return cur == end;
+}
+
+// Packs 'count' positions of 'stride' scalars each as fixed point deltas from the previous
+// position, using the fewest fractional bits that represent them all exactly, e.g. none for
+// positions on whole pixels and 6 for positions on 1/64ths of a pixel. Returns false if the
+// positions need more bits or packing them isn't smaller than writing them as they are.
+bool pack_positions(const SkScalar pos[], int count, int stride, TArray<uint8_t>* bytes) {
+    const int rawSize = count * stride * sizeof(SkScalar);
+    int shift = 0;
+    for (int i = 0; i < count * stride; i++) {
+        if (!SkIsFinite(pos[i])) {
+            return false;
+        }
+        while (std::ldexp(pos[i], shift) != std::floor(std::ldexp(pos[i], shift))) {
+            if (++shift > kMaxPositionShift) {
+                return false;
+            }
+        }
+    }
+    for (int i = 0; i < count * stride; i++) {
+        if (!(std::fabs(std::ldexp(pos[i], shift)) < kMaxFixedPosition)) {
+            return false;
+        }
+    }
+
+    bytes->clear();
+    bytes->reserve(1 + count * stride);
+    bytes->push_back(SkToU8(shift));
+    for (int c = 0; c < stride; c++) {
+        int32_t prev = 0;
+        for (int i = 0; i < count && bytes->size() < rawSize; i++) {
+            const int32_t fixed = static_cast<int32_t>(std::ldexp(pos[i * stride + c], shift));
+            write_varint(bytes, zigzag(fixed - prev));
+            prev = fixed;
+        }
+    }
+    return bytes->size() < rawSize;
+}
+
+bool unpack_positions(const uint8_t* cur, const uint8_t* end, SkScalar pos[], int count,
+                      int stride) {
+    if (cur == end || *cur > kMaxPositionShift) {
+        return false;
+    }
+    const SkScalar scale = std::ldexp(1.0f, -*cur++);
+    for (int c = 0; c < stride; c++) {
+        int32_t fixed = 0;
+        for (int i = 0; i < count; i++) {
+            uint32_t v;
+            if (!read_varint(&cur, end, &v)) {
+                return false;
+            }
+            // Wrapping keeps malformed data from being undefined behavior.
+            fixed = static_cast<int32_t>(static_cast<uint32_t>(fixed) +
+                                         static_cast<uint32_t>(unzigzag(v)));
+            pos[i * stride + c] = static_cast<SkScalar>(fixed) * scale;
+        }
+    }
+    return cur == end;
+}
+
 } // namespace
 
 enum SkTextBlob::GlyphPositioning : uint8_t {
@@ -665,11 +796,16 @@ void SkTextBlobPriv::Flatten(const SkTextBlob& blob, SkWriteBuffer& buffer) {
     // some cc_unittests fail if we remove this...
     buffer.writeRect(blob.bounds());
 
+    TArray<uint8_t> packedGlyphs, packedPositions;
+    const SkFont* prevFont = nullptr;
     SkTextBlobRunIterator it(&blob);
     while (!it.done()) {
         SkASSERT(it.glyphCount() > 0);
+        const int glyphCount = it.glyphCount();
+        const auto positioning = SkTo<SkTextBlob::GlyphPositioning>(it.positioning());
+        const int stride = SkTextBlob::ScalarsPerGlyph(positioning);
 
-        buffer.write32(it.glyphCount());
+        buffer.write32(glyphCount);
         PositioningAndExtended pe;
         pe.intValue = 0;
         pe.positioning = it.positioning();
@@ -677,21 +813,41 @@ void SkTextBlobPriv::Flatten(const SkTextBlob& blob, SkWriteBuffer& buffer) {
 
         uint32_t textSize = it.textSize();
         pe.extended = textSize > 0;
+        if (prevFont && *prevFont == it.font()) {
+            pe.flags |= kSameFont_RunFlag;
+        }
+        if (pack_glyphs(it.glyphs(), glyphCount, &packedGlyphs)) {
+            pe.flags |= kPackedGlyphs_RunFlag;
+        }
+        // RSXforms are rotations and rarely fixed point; only pack x and y positions.
+        if ((positioning == SkTextBlob::kHorizontal_Positioning ||
+             positioning == SkTextBlob::kFull_Positioning) &&
+            pack_positions(it.pos(), glyphCount, stride, &packedPositions)) {
+            pe.flags |= kPackedPositions_RunFlag;
+        }
         buffer.write32(pe.intValue);
         if (pe.extended) {
             buffer.write32(textSize);
         }
         buffer.writePoint(it.offset());
 
-        SkFontPriv::Flatten(it.font(), buffer);
+        if (!(pe.flags & kSameFont_RunFlag)) {
+            SkFontPriv::Flatten(it.font(), buffer);
+        }
+        prevFont = &it.font();
 
-        buffer.writeByteArray(it.glyphs(), it.glyphCount() * sizeof(uint16_t));
-        buffer.writeByteArray(it.pos(),
-                              it.glyphCount() * sizeof(SkScalar) *
-                              SkTextBlob::ScalarsPerGlyph(
-                                  SkTo<SkTextBlob::GlyphPositioning>(it.positioning())));
+        if (pe.flags & kPackedGlyphs_RunFlag) {
+            buffer.writeByteArray(packedGlyphs.data(), packedGlyphs.size());
+        } else {
+            buffer.writeByteArray(it.glyphs(), glyphCount * sizeof(uint16_t));
+        }
+        if (pe.flags & kPackedPositions_RunFlag) {
+            buffer.writeByteArray(packedPositions.data(), packedPositions.size());
+        } else {
+            buffer.writeByteArray(it.pos(), glyphCount * sizeof(SkScalar) * stride);
+        }
         if (pe.extended) {
-            buffer.writeByteArray(it.clusters(), sizeof(uint32_t) * it.glyphCount());
+            buffer.writeByteArray(it.clusters(), sizeof(uint32_t) * glyphCount);
             buffer.writeByteArray(it.text(), it.textSize());
         }
 
@@ -708,6 +864,8 @@ sk_sp<SkTextBlob> SkTextBlobPriv::MakeFromBuffer(SkReadBuffer& reader) {
 
     SkTextBlobBuilder blobBuilder;
     SkSafeMath safe;
+    SkFont font;
+    bool haveFont = false;
     for (;;) {
         int glyphCount = reader.read32();
         if (glyphCount == 0) {
@@ -721,6 +879,10 @@ sk_sp<SkTextBlob> SkTextBlobPriv::MakeFromBuffer(SkReadBuffer& reader) {
         if (glyphCount <= 0 || pos > SkTextBlob::kRSXform_Positioning) {
             return nullptr;
         }
+        const uint16_t flags = reader.isVersionLT(SkPicturePriv::kCompactTextBlobs) ? 0 : pe.flags;
+        if ((flags & kSameFont_RunFlag) && !haveFont) {
+            return nullptr;
+        }
         int textSize = pe.extended ? reader.read32() : 0;
         if (textSize < 0) {
             return nullptr;
@@ -728,18 +890,22 @@ sk_sp<SkTextBlob> SkTextBlobPriv::MakeFromBuffer(SkReadBuffer& reader) {
 
         SkPoint offset;
         reader.readPoint(&offset);
-        SkFont font;
-        SkFontPriv::Unflatten(&font, reader);
+        if (!(flags & kSameFont_RunFlag)) {
+            font = SkFont();
+            SkFontPriv::Unflatten(&font, reader);
+            haveFont = true;
+        }
 
         // Compute the expected size of the buffer and ensure we have enough to deserialize
-        // a run before allocating it.
-        const size_t glyphSize = safe.mul(glyphCount, sizeof(uint16_t)),
-                     posSize =
-                             safe.mul(glyphCount, safe.mul(sizeof(SkScalar),
-                             SkTextBlob::ScalarsPerGlyph(pos))),
+        // a run before allocating it. Packed glyphs and positions take at least a byte each.
+        const size_t posCount = safe.mul(glyphCount, SkTextBlob::ScalarsPerGlyph(pos)),
+                     glyphSize = safe.mul(glyphCount, sizeof(uint16_t)),
+                     posSize = safe.mul(posCount, sizeof(SkScalar)),
                      clusterSize = pe.extended ? safe.mul(glyphCount, sizeof(uint32_t)) : 0;
         const size_t totalSize =
-                safe.add(safe.add(glyphSize, posSize), safe.add(clusterSize, textSize));
+                safe.add(safe.add((flags & kPackedGlyphs_RunFlag) ? glyphCount : glyphSize,
+                                  (flags & kPackedPositions_RunFlag) ? posCount : posSize),
+                         safe.add(clusterSize, textSize));
 
         if (!reader.isValid() || !safe || totalSize > reader.available()) {
             return nullptr;
@@ -769,10 +935,26 @@ sk_sp<SkTextBlob> SkTextBlobPriv::MakeFromBuffer(SkReadBuffer& reader) {
             return nullptr;
         }
 
-        if (!reader.readByteArray(buf->glyphs, glyphSize) ||
-            !reader.readByteArray(buf->pos, posSize)) {
+        if (flags & kPackedGlyphs_RunFlag) {
+            size_t size;
+            auto bytes = static_cast<const uint8_t*>(reader.skipByteArray(&size));
+            if (!bytes || !unpack_glyphs(bytes, bytes + size, buf->glyphs, glyphCount)) {
+                return nullptr;
+            }
+        } else if (!reader.readByteArray(buf->glyphs, glyphSize)) {
             return nullptr;
+        }
+        if (flags & kPackedPositions_RunFlag) {
+            size_t size;
+            auto bytes = static_cast<const uint8_t*>(reader.skipByteArray(&size));
+            if (pos == SkTextBlob::kDefault_Positioning || pos == SkTextBlob::kRSXform_Positioning ||
+                !bytes || !unpack_positions(bytes, bytes + size, buf->pos, glyphCount,
+                                            SkTextBlob::ScalarsPerGlyph(pos))) {
+                return nullptr;
             }
+        } else if (!reader.readByteArray(buf->pos, posSize)) {
+            return nullptr;
+        }
 
         if (pe.extended) {
             if (!reader.readByteArray(buf->clusters, clusterSize) ||
@@ -0,0 +1,24 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkTextQuads_DEFINED
+#define SkTextQuads_DEFINED
+
+#include "include/core/SkPoint.h"
+
+namespace SkOpts {
+    // Maps the corners of count glyph rectangles through the affine matrix given as by
+    // SkMatrix::asAffine(). Rectangle i has its left top at leftTop[i] and its width and height in
+    // size[i]. Its corners go to corners[4*i] through corners[4*i + 3] in the order left top,
+    // left bottom, right top, right bottom, which is the order of the vertices of a text quad.
+    extern void (*map_text_quads)(const float affine[6], const SkPoint leftTop[],
+                                  const SkPoint size[], int count, SkPoint corners[]);
+
+    void Init_TextQuads();
+}  // namespace SkOpts
+
+#endif
@@ -11,7 +11,7 @@
 #include "include/core/SkGraphics.h"
 #include "include/core/SkString.h"
 #include "include/private/base/SkDebug.h"
-#include "include/private/base/SkMutex.h"
+#include "src/base/SkSharedMutex.h"
 
 #include <atomic>
 #include <cstdint>
@@ -19,19 +19,36 @@
 
 SkTypefaceCache::SkTypefaceCache() {}
 
-void SkTypefaceCache::add(sk_sp<SkTypeface> face) {
+bool SkTypefaceCache::makeRoom() {
     const auto limit = SkGraphics::GetTypefaceCacheCountLimit();
 
-    if (fTypefaces.size() >= limit) {
+    if (fTypefaces.size() + fKeyedCount >= limit) {
         this->purge(limit >> 2);
     }
-    if (limit > 0) {
+    return limit > 0;
+}
+
+void SkTypefaceCache::add(sk_sp<SkTypeface> face) {
+    if (this->makeRoom()) {
         fTypefaces.emplace_back(std::move(face));
     }
 }
 
-sk_sp<SkTypeface> SkTypefaceCache::findByProcAndRef(FindProc proc, void* ctx) const {
-    for (const sk_sp<SkTypeface>& typeface : fTypefaces) {
+void SkTypefaceCache::add(sk_sp<SkTypeface> face, uint32_t key) {
+    if (this->makeRoom()) {
+        auto* faces = fKeyedTypefaces.find(key);
+        if (!faces) {
+            faces = fKeyedTypefaces.set(key, {});
+        }
+        faces->emplace_back(std::move(face));
+        fKeyedCount++;
+    }
+}
+
+template <typename Typefaces>
+static sk_sp<SkTypeface> find_in(const Typefaces& typefaces,
+                                 SkTypefaceCache::FindProc proc, void* ctx) {
+    for (const sk_sp<SkTypeface>& typeface : typefaces) {
         if (proc(typeface.get(), ctx)) {
             return typeface;
         }
@@ -39,24 +56,68 @@ sk_sp<SkTypeface> SkTypefaceCache::findByProcAndRef(FindProc proc, void* ctx) co
     return nullptr;
 }
 
-void SkTypefaceCache::purge(int numToPurge) {
-    int count = fTypefaces.size();
+sk_sp<SkTypeface> SkTypefaceCache::findByProcAndRef(FindProc proc, void* ctx) const {
+    sk_sp<SkTypeface> found = find_in(fTypefaces, proc, ctx);
+    if (!found) {
+        fKeyedTypefaces.foreach([&](uint32_t, const auto& faces) {
+            if (!found) {
+                found = find_in(faces, proc, ctx);
+            }
+        });
+    }
+    return found;
+}
+
+sk_sp<SkTypeface> SkTypefaceCache::findByKeyAndProcAndRef(uint32_t key,
+                                                          FindProc proc, void* ctx) const {
+    const auto* faces = fKeyedTypefaces.find(key);
+    return faces ? find_in(*faces, proc, ctx) : nullptr;
+}
+
+// Removes typefaces only owned by the cache until numToPurge have been removed, returning true if
+// it got that far. Purges every such typeface if numToPurge starts at 0.
+template <typename Typefaces>
+static bool purge_from(Typefaces* typefaces, int* numToPurge) {
+    int count = typefaces->size();
     int i = 0;
     while (i < count) {
-        if (fTypefaces[i]->unique()) {
-            fTypefaces.removeShuffle(i);
+        if ((*typefaces)[i]->unique()) {
+            typefaces->removeShuffle(i);
             --count;
-            if (--numToPurge == 0) {
-                return;
+            if (--*numToPurge == 0) {
+                return true;
             }
         } else {
             ++i;
         }
     }
+    return false;
+}
+
+void SkTypefaceCache::purge(int numToPurge) {
+    if (purge_from(&fTypefaces, &numToPurge)) {
+        return;
+    }
+
+    skia_private::TArray<uint32_t> emptyKeys;
+    bool done = false;
+    fKeyedTypefaces.foreach([&](uint32_t key, auto* faces) {
+        if (!done) {
+            const int count = faces->size();
+            done = purge_from(faces, &numToPurge);
+            fKeyedCount -= count - faces->size();
+            if (faces->empty()) {
+                emptyKeys.push_back(key);
+            }
+        }
+    });
+    for (uint32_t key : emptyKeys) {
+        fKeyedTypefaces.remove(key);
+    }
 }
 
 void SkTypefaceCache::purgeAll() {
-    this->purge(fTypefaces.size());
+    this->purge(fTypefaces.size() + fKeyedCount);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -71,23 +132,33 @@ SkTypefaceID SkTypefaceCache::NewTypefaceID() {
     return nextID.fetch_add(1, std::memory_order_relaxed);
 }
 
-static SkMutex& typeface_cache_mutex() {
-    static SkMutex& mutex = *(new SkMutex);
+static SkSharedMutex& typeface_cache_mutex() {
+    static SkSharedMutex& mutex = *(new SkSharedMutex);
     return mutex;
 }
 
 void SkTypefaceCache::Add(sk_sp<SkTypeface> face) {
-    SkAutoMutexExclusive ama(typeface_cache_mutex());
+    SkAutoSharedMutexExclusive ama(typeface_cache_mutex());
     Get().add(std::move(face));
 }
 
+void SkTypefaceCache::Add(sk_sp<SkTypeface> face, uint32_t key) {
+    SkAutoSharedMutexExclusive ama(typeface_cache_mutex());
+    Get().add(std::move(face), key);
+}
+
 sk_sp<SkTypeface> SkTypefaceCache::FindByProcAndRef(FindProc proc, void* ctx) {
-    SkAutoMutexExclusive ama(typeface_cache_mutex());
+    SkAutoSharedMutexShared ama(typeface_cache_mutex());
     return Get().findByProcAndRef(proc, ctx);
 }
 
+sk_sp<SkTypeface> SkTypefaceCache::FindByKeyAndProcAndRef(uint32_t key, FindProc proc, void* ctx) {
+    SkAutoSharedMutexShared ama(typeface_cache_mutex());
+    return Get().findByKeyAndProcAndRef(key, proc, ctx);
+}
+
 void SkTypefaceCache::PurgeAll() {
-    SkAutoMutexExclusive ama(typeface_cache_mutex());
+    SkAutoSharedMutexExclusive ama(typeface_cache_mutex());
     Get().purgeAll();
 }
 
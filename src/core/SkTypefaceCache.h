@@ -13,6 +13,9 @@
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkTypeface.h"
 #include "include/private/base/SkTArray.h"
+#include "src/core/SkTHash.h"
+
+#include <cstdint>
 
 class SkTypefaceCache {
 public:
@@ -31,6 +34,13 @@ public:
      */
     void add(sk_sp<SkTypeface>);
 
+    /**
+     *  Like add(), but files the typeface under 'key', which should be a hash of whatever the
+     *  FindProcs used to look it up compare. findByKeyAndProcAndRef() then only calls its proc
+     *  for typefaces with the same key, instead of for every typeface in the cache.
+     */
+    void add(sk_sp<SkTypeface>, uint32_t key);
+
     /**
      *  Iterate through the cache, calling proc(typeface, ctx) for each typeface.
      *  If proc returns true, then return that typeface.
@@ -38,6 +48,11 @@ public:
      */
     sk_sp<SkTypeface> findByProcAndRef(FindProc proc, void* ctx) const;
 
+    /**
+     *  Like findByProcAndRef(), but only considers the typefaces added with 'key'.
+     */
+    sk_sp<SkTypeface> findByKeyAndProcAndRef(uint32_t key, FindProc proc, void* ctx) const;
+
     /**
      *  This will unref all of the typefaces in the cache for which the cache
      *  is the only owner. Normally this is handled automatically as needed.
@@ -52,10 +67,13 @@ public:
      */
     static SkTypefaceID NewTypefaceID();
 
-    // These are static wrappers around a global instance of a cache.
+    // These are static wrappers around a global instance of a cache. Lookups share a
+    // reader-writer lock, so threads can look up typefaces concurrently.
 
     static void Add(sk_sp<SkTypeface>);
+    static void Add(sk_sp<SkTypeface>, uint32_t key);
     static sk_sp<SkTypeface> FindByProcAndRef(FindProc proc, void* ctx);
+    static sk_sp<SkTypeface> FindByKeyAndProcAndRef(uint32_t key, FindProc proc, void* ctx);
     static void PurgeAll();
 
     /**
@@ -66,9 +84,14 @@ public:
 private:
     static SkTypefaceCache& Get();
 
+    bool makeRoom();
     void purge(int count);
 
+    // Typefaces added without a key.
     skia_private::TArray<sk_sp<SkTypeface>> fTypefaces;
+    // Typefaces added with a key, by key.
+    skia_private::THashMap<uint32_t, skia_private::STArray<1, sk_sp<SkTypeface>>> fKeyedTypefaces;
+    int fKeyedCount = 0;
 };
 
 #endif
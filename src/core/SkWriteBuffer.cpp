@@ -159,7 +159,8 @@ bool SkBinaryWriteBuffer::writeToStream(SkWStream* stream) const {
     return fWriter.writeToStream(stream);
 }
 
-static sk_sp<SkData> serialize_image(const SkImage* image, SkSerialProcs procs) {
+sk_sp<SkData> SkBinaryWriteBuffer::SerializeImage(const SkImage* image,
+                                                  const SkSerialProcs& procs) {
     sk_sp<SkData> data;
     if (procs.fImageProc) {
         data = procs.fImageProc(const_cast<SkImage*>(image), procs.fImageCtx);
@@ -203,7 +204,7 @@ static sk_sp<SkData> serialize_mipmap(const SkMipmap* mipmap, SkSerialProcs proc
         SkMipmap::Level level;
         if (mipmap->getLevel(i, &level)) {
             sk_sp<SkImage> levelImage = SkImages::RasterFromPixmap(level.fPixmap, nullptr, nullptr);
-            sk_sp<SkData> levelData = serialize_image(levelImage.get(), procs);
+            sk_sp<SkData> levelData = SkBinaryWriteBuffer::SerializeImage(levelImage.get(), procs);
             buffer.writeDataAsByteArray(levelData.get());
         } else {
             return nullptr;
@@ -230,7 +231,7 @@ void SkBinaryWriteBuffer::writeImage(const SkImage* image) {
 
     this->write32(flags);
 
-    sk_sp<SkData> data = serialize_image(image, fProcs);
+    sk_sp<SkData> data = SerializeImage(image, fProcs);
     SkASSERT(data);
     this->writeDataAsByteArray(data.get());
 
@@ -153,6 +153,10 @@ public:
     void setFactoryRecorder(sk_sp<SkFactorySet>);
     void setTypefaceRecorder(sk_sp<SkRefCntSet>);
 
+    // The data writeImage() writes for an image: what the procs' fImageProc returns, or else the
+    // image's encoded data, or else the image encoded as PNG.
+    static sk_sp<SkData> SerializeImage(const SkImage*, const SkSerialProcs&);
+
 private:
     sk_sp<SkFactorySet> fFactorySet;
     sk_sp<SkRefCntSet> fTFSet;
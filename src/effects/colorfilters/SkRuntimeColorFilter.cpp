@@ -13,6 +13,7 @@
 #include "include/core/SkColorFilter.h"
 #include "include/core/SkData.h"
 #include "include/core/SkMatrix.h"
+#include "include/core/SkScalar.h"
 #include "include/core/SkString.h"
 #include "include/effects/SkLumaColorFilter.h"
 #include "include/effects/SkOverdrawColorFilter.h"
@@ -22,14 +23,24 @@
 #include "include/private/base/SkDebug.h"
 #include "include/private/base/SkFloatingPoint.h"
 #include "include/private/base/SkTArray.h"
+#include "include/private/base/SkTPin.h"
+#include "src/base/SkArenaAlloc.h"
+#include "src/core/SkColorLUTCache.h"
 #include "src/core/SkEffectPriv.h"
 #include "src/core/SkKnownRuntimeEffects.h"
+#include "src/core/SkRasterPipeline.h"
+#include "src/core/SkRasterPipelineOpContexts.h"
+#include "src/core/SkRasterPipelineOpList.h"
 #include "src/core/SkReadBuffer.h"
 #include "src/core/SkRuntimeEffectPriv.h"
+#include "src/core/SkRuntimeEffectProfiler.h"
 #include "src/core/SkWriteBuffer.h"
 #include "src/shaders/SkShaderBase.h"
 #include "src/sksl/codegen/SkSLRasterPipelineBuilder.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <string>
 #include <utility>
 
@@ -46,7 +57,152 @@ SkRuntimeColorFilter::SkRuntimeColorFilter(sk_sp<SkRuntimeEffect> effect,
         , fUniforms(std::move(uniforms))
         , fChildren(children.begin(), children.end()) {}
 
-bool SkRuntimeColorFilter::appendStages(const SkStageRec& rec, bool) const {
+sk_sp<SkRuntimeColorFilter> SkRuntimeColorFilter::makeWithLUTCache_ForTesting(
+        SkResourceCache* lutCache) const {
+    auto filter = sk_make_sp<SkRuntimeColorFilter>(fEffect, fUniforms, fChildren);
+    filter->fLUTCache = lutCache;
+    return filter;
+}
+
+namespace {
+
+bool append_program_stages(const SkStageRec& rec,
+                           const SkSL::RP::Program& program,
+                           SkSpan<const float> uniforms,
+                           SkSpan<const SkRuntimeEffect::ChildPtr> children,
+                           SkSpan<const SkSL::SampleUsage> sampleUsages) {
+    SkShaders::MatrixRec matrix(SkMatrix::I());
+    matrix.markCTMApplied();
+    RuntimeEffectRPCallbacks callbacks(rec, matrix, children, sampleUsages);
+    return program.appendStages(rec.fPipeline, rec.fAlloc, &callbacks, uniforms);
+}
+
+// Runs the program over `count` float RGBA colors, in place.
+bool run_program(const SkStageRec& rec,
+                 const SkSL::RP::Program& program,
+                 SkSpan<const float> uniforms,
+                 SkSpan<const SkSL::SampleUsage> sampleUsages,
+                 float* colors,
+                 int count) {
+    SkArenaAlloc alloc(/*firstHeapAllocation=*/1024);
+    SkRasterPipeline pipeline(&alloc);
+    SkRasterPipeline_MemoryCtx ctx{colors, count};
+    pipeline.append(SkRasterPipelineOp::load_f32, &ctx);
+    SkStageRec runRec{&pipeline, &alloc, rec.fDstColorType, rec.fDstCS, rec.fPaintColor,
+                      rec.fSurfaceProps};
+    if (!append_program_stages(runRec, program, uniforms, /*children=*/{}, sampleUsages)) {
+        return false;
+    }
+    pipeline.append(SkRasterPipelineOp::store_f32, &ctx);
+    pipeline.run(0, 0, count, 1);
+    return true;
+}
+
+uint8_t to_byte(float v) {
+    return (uint8_t)SkScalarRoundToInt(SkTPin(v, 0.0f, 1.0f) * 255);
+}
+
+// Evaluates the program on a grid of opaque colors. If it turns out to be separable, it's then
+// sampled once more along the diagonal to fill in 8-bit tables.
+sk_sp<const SkColorLUT> bake_lut(const SkStageRec& rec,
+                                 const SkSL::RP::Program& program,
+                                 SkSpan<const float> uniforms,
+                                 SkSpan<const SkSL::SampleUsage> sampleUsages) {
+    constexpr int kSize = SkColorLUT::k3DSize;
+    constexpr int kCount = kSize * kSize * kSize;
+    auto lut = sk_make_sp<SkColorLUT>();
+    lut->f3D.resize(4 * kCount);
+    float* grid = lut->f3D.data();
+    for (int b = 0; b < kSize; ++b) {
+        for (int g = 0; g < kSize; ++g) {
+            for (int r = 0; r < kSize; ++r) {
+                grid[0] = r / (kSize - 1.0f);
+                grid[1] = g / (kSize - 1.0f);
+                grid[2] = b / (kSize - 1.0f);
+                grid[3] = 1.0f;
+                grid += 4;
+            }
+        }
+    }
+    if (!run_program(rec, program, uniforms, sampleUsages, lut->f3D.data(), kCount)) {
+        return nullptr;
+    }
+
+    // The tables are separable if each of R, G and B only varies along its own axis, and alpha
+    // doesn't vary at all. All the outputs also need to fit in a byte table.
+    static constexpr float kTolerance = 1 / 4096.0f;
+    const float* colors = lut->f3D.data();
+    auto entry = [&](int r, int g, int b) { return colors + 4 * ((b * kSize + g) * kSize + r); };
+    bool separable = true;
+    for (int b = 0; b < kSize && separable; ++b) {
+        for (int g = 0; g < kSize && separable; ++g) {
+            for (int r = 0; r < kSize && separable; ++r) {
+                const float* c = entry(r, g, b);
+                separable = std::abs(c[0] - entry(r, 0, 0)[0]) <= kTolerance &&
+                            std::abs(c[1] - entry(0, g, 0)[1]) <= kTolerance &&
+                            std::abs(c[2] - entry(0, 0, b)[2]) <= kTolerance &&
+                            std::abs(c[3] - colors[3])         <= kTolerance &&
+                            std::min({c[0], c[1], c[2]}) >= 0 &&
+                            std::max({c[0], c[1], c[2]}) <= c[3] + kTolerance &&
+                            c[3] <= 1;
+            }
+        }
+    }
+    if (!separable) {
+        return lut;
+    }
+
+    float diagonal[4 * 256];
+    for (int i = 0; i < 256; ++i) {
+        diagonal[4*i + 0] = diagonal[4*i + 1] = diagonal[4*i + 2] = i / 255.0f;
+        diagonal[4*i + 3] = 1.0f;
+    }
+    if (!run_program(rec, program, uniforms, sampleUsages, diagonal, 256)) {
+        return lut;
+    }
+    // The tables hold unpremul colors, which are premultiplied again after the lookup.
+    const float alpha = colors[3];
+    const float invAlpha = alpha > 0 ? 1 / alpha : 0;
+    for (int i = 0; i < 256; ++i) {
+        lut->fTableR[i] = to_byte(diagonal[4*i + 0] * invAlpha);
+        lut->fTableG[i] = to_byte(diagonal[4*i + 1] * invAlpha);
+        lut->fTableB[i] = to_byte(diagonal[4*i + 2] * invAlpha);
+        lut->fTableA[i] = to_byte(i / 255.0f * alpha);
+    }
+    lut->fSeparable = true;
+    lut->f3D = {};
+    return lut;
+}
+
+void append_lut_stages(const SkStageRec& rec, sk_sp<const SkColorLUT> lut, bool shaderIsOpaque) {
+    SkRasterPipeline* p = rec.fPipeline;
+    if (!shaderIsOpaque) {
+        p->append(SkRasterPipelineOp::unpremul);
+    }
+    if (lut->fSeparable) {
+        // This mirrors SkTableColorFilter.
+        auto* tables = rec.fAlloc->make<SkRasterPipeline_TablesCtx>();
+        tables->a = lut->fTableA;
+        tables->r = lut->fTableR;
+        tables->g = lut->fTableG;
+        tables->b = lut->fTableB;
+        p->append(SkRasterPipelineOp::byte_tables, tables);
+        if (!shaderIsOpaque || lut->fTableA[0xff] != 0xff) {
+            p->append(SkRasterPipelineOp::premul);
+        }
+    } else {
+        auto* ctx = rec.fAlloc->make<SkRasterPipeline_Lut3DCtx>();
+        ctx->table = lut->f3D.data();
+        ctx->size = SkColorLUT::k3DSize;
+        p->append(SkRasterPipelineOp::lut_3D, ctx);
+    }
+    // The pipeline may run after the cache drops the LUT.
+    rec.fAlloc->make<sk_sp<const SkColorLUT>>(std::move(lut));
+}
+
+}  // namespace
+
+bool SkRuntimeColorFilter::appendStages(const SkStageRec& rec, bool shaderIsOpaque) const {
     if (!SkRuntimeEffectPriv::CanDraw(SkCapabilities::RasterBackend().get(), fEffect.get())) {
         // SkRP has support for many parts of #version 300 already, but for now, we restrict its
         // usage in runtime effects to just #version 100.
@@ -59,10 +215,26 @@ bool SkRuntimeColorFilter::appendStages(const SkStageRec& rec, bool) const {
                                                     /*alwaysCopyIntoAlloc=*/false,
                                                     rec.fDstCS,
                                                     rec.fAlloc);
-        SkShaders::MatrixRec matrix(SkMatrix::I());
-        matrix.markCTMApplied();
-        RuntimeEffectRPCallbacks callbacks(rec, matrix, fChildren, fEffect->fSampleUsages);
-        bool success = program->appendStages(rec.fPipeline, rec.fAlloc, &callbacks, uniforms);
+        sk_sp<const SkColorLUT> lut;
+        if (fEffect->bakeColorFilterLUT() && fChildren.empty()) {
+            // Filters without children only depend on their input color and uniforms.
+            lut = SkColorLUTCache::Find(*fEffect, rec.fDstCS, uniforms, fLUTCache);
+            if (!lut) {
+                lut = bake_lut(rec, *program, uniforms, fEffect->fSampleUsages);
+                if (lut) {
+                    SkColorLUTCache::Add(*fEffect, rec.fDstCS, uniforms, lut, fLUTCache);
+                }
+            }
+        }
+        auto* profile = SkRuntimeEffectProfiler::Global()->appendBegin(rec, *fEffect);
+        bool success = true;
+        if (lut) {
+            append_lut_stages(rec, std::move(lut), shaderIsOpaque);
+        } else {
+            success = append_program_stages(rec, *program, uniforms, fChildren,
+                                            fEffect->fSampleUsages);
+        }
+        SkRuntimeEffectProfiler::AppendEnd(rec, profile);
         return success;
     }
     return false;
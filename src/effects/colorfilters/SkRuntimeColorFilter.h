@@ -19,6 +19,7 @@
 #include <vector>
 
 class SkReadBuffer;
+class SkResourceCache;
 class SkWriteBuffer;
 struct SkStageRec;
 
@@ -44,10 +45,15 @@ public:
     sk_sp<const SkData> uniforms() const { return fUniforms; }
     SkSpan<const SkRuntimeEffect::ChildPtr> children() const { return fChildren; }
 
+    // Returns a copy of this filter that keeps its baked LUTs in `lutCache` rather than in the
+    // global SkResourceCache.
+    sk_sp<SkRuntimeColorFilter> makeWithLUTCache_ForTesting(SkResourceCache* lutCache) const;
+
 private:
     sk_sp<SkRuntimeEffect> fEffect;
     sk_sp<const SkData> fUniforms;
     std::vector<SkRuntimeEffect::ChildPtr> fChildren;
+    SkResourceCache* fLUTCache = nullptr;
 };
 
 #endif
@@ -308,9 +308,12 @@ skif::FilterResult SkBlendImageFilter::onFilterImage(const skif::Context& ctx) c
     }
 
     skif::Context inputCtx = ctx.withNewDesiredOutput(*requiredInput);
+    skif::FilterResult inputs[2];
+    this->getChildOutputs(inputCtx, inputs);
+
     skif::FilterResult::Builder builder{ctx};
-    builder.add(this->getChildOutput(kBackground, inputCtx));
-    builder.add(this->getChildOutput(kForeground, inputCtx));
+    builder.add(inputs[kBackground]);
+    builder.add(inputs[kForeground]);
     return builder.eval(
             [&](SkSpan<sk_sp<SkShader>> inputs) -> sk_sp<SkShader> {
                 return this->makeBlendShader(inputs[kBackground], inputs[kForeground]);
@@ -21,6 +21,7 @@
 #include "include/core/SkTypes.h"
 #include "include/private/base/SkFloatingPoint.h"
 #include "include/private/base/SkMalloc.h"
+#include "include/private/base/SkTemplates.h"
 #include "include/private/base/SkTo.h"
 #include "src/base/SkArenaAlloc.h"
 #include "src/base/SkVx.h"
@@ -28,6 +29,7 @@
 #include "src/core/SkImageFilter_Base.h"
 #include "src/core/SkReadBuffer.h"
 #include "src/core/SkSpecialImage.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/core/SkWriteBuffer.h"
 
 #include <algorithm>
@@ -768,6 +770,47 @@ private:
     skvx::Vec<4, uint32_t>* fBuffer1Cursor;
 };
 
+// Passes keep running sums and circular buffers, so each thread of work needs its own.
+Pass* make_pass(const PassMaker& maker, SkArenaAlloc* alloc) {
+    void* buffer = alloc->makeBytesAlignedTo(maker.bufferSizeBytes(),
+                                             alignof(skvx::Vec<4, uint32_t>));
+    return maker.makePass(buffer, alloc);
+}
+
+// Calls fn(spanStart, spanEnd) on disjoint spans that together cover [start, end), where each
+// index in the range is a row or column of 'length' pixels. Span boundaries fall on multiples of
+// 'granularity' from 'start'. Blurs with enough pixels are split into several spans that run in
+// parallel on the default SkExecutor.
+template <typename Fn>
+void for_each_span(int start, int end, int length, int granularity, Fn&& fn) {
+    static constexpr int64_t kMinPixelsToSplit = 256 * 256;
+    static constexpr int kMinSpan = 32;
+    static constexpr int kMaxSpans = 8;
+
+    const int count = end - start;
+    if (count <= 0) {
+        return;
+    }
+    const int spans = SkToS64(count) * length < kMinPixelsToSplit
+                              ? 1
+                              : std::clamp(count / kMinSpan, 1, kMaxSpans);
+    int spanSize = (count + spans - 1) / spans;
+    spanSize = (spanSize + granularity - 1) / granularity * granularity;
+    if (spanSize >= count) {
+        fn(start, end);
+        return;
+    }
+
+    SkTaskGroup tasks;
+    for (int spanStart = start + spanSize; spanStart < end; spanStart += spanSize) {
+        tasks.add([&fn, spanStart, spanEnd = std::min(end, spanStart + spanSize)] {
+            fn(spanStart, spanEnd);
+        });
+    }
+    fn(start, start + spanSize);
+    tasks.wait();
+}
+
 // TODO: Implement CPU backend for different fTileMode. This is still worth doing inline with the
 // blur; at the moment the tiling is applied via the CropImageFilter and carried as metadata on
 // the FilterResult. This is forcefully applied in onFilterImage() to get a simple SkSpecialImage to
@@ -833,15 +876,14 @@ sk_sp<SkSpecialImage> cpu_blur(const skif::Context& ctx,
     }
     dst.eraseColor(SK_ColorTRANSPARENT);
 
-    auto buffer = alloc.makeBytesAlignedTo(std::max(makerX->bufferSizeBytes(),
-                                                    makerY->bufferSizeBytes()),
-                                           alignof(skvx::Vec<4, uint32_t>));
-
     // Basic Plan: The three cases to handle
     // * Horizontal and Vertical - blur horizontally while copying values from the source to
     //     the destination. Then, do an in-place vertical blur.
     // * Horizontal only - blur horizontally copying values from the source to the destination.
     // * Vertical only - blur vertically copying values from the source to the destination.
+    //
+    // Both passes are split into independent pieces of work (bands of rows for X, blocks of
+    // columns for Y) that run in parallel when the blur is big enough to be worth it.
 
     // Initialize these assuming the Y-only case
     int loopStart  = std::max(srcBounds.left(),  dstBounds.left());
@@ -854,20 +896,23 @@ sk_sp<SkSpecialImage> cpu_blur(const skif::Context& ctx,
         loopStart = std::max(srcBounds.top(),    dstBounds.top());
         loopEnd   = std::min(srcBounds.bottom(), dstBounds.bottom());
 
-        auto srcAddr = src.getAddr32(0, loopStart - srcBounds.top());
-        auto dstAddr = dst.getAddr32(0, loopStart - dstBounds.top());
-
         // Iterate over each row to calculate 1D blur along X.
-        Pass* pass = makerX->makePass(buffer, &alloc);
-        for (int y = loopStart; y < loopEnd; ++y) {
-            pass->blur(srcBounds.left()  - dstBounds.left(),
-                       srcBounds.right() - dstBounds.left(),
-                       dstBounds.width(),
-                       srcAddr, 1,
-                       dstAddr, 1);
-            srcAddr += src.rowBytesAsPixels();
-            dstAddr += dst.rowBytesAsPixels();
-        }
+        for_each_span(loopStart, loopEnd, dstBounds.width(), /*granularity=*/1,
+                      [&](int start, int end) {
+            SkSTArenaAlloc<1024> spanAlloc;
+            Pass* pass = make_pass(*makerX, &spanAlloc);
+            auto srcAddr = src.getAddr32(0, start - srcBounds.top());
+            auto dstAddr = dst.getAddr32(0, start - dstBounds.top());
+            for (int y = start; y < end; ++y) {
+                pass->blur(srcBounds.left()  - dstBounds.left(),
+                           srcBounds.right() - dstBounds.left(),
+                           dstBounds.width(),
+                           srcAddr, 1,
+                           dstAddr, 1);
+                srcAddr += src.rowBytesAsPixels();
+                dstAddr += dst.rowBytesAsPixels();
+            }
+        });
 
         // Set up the Y pass to blur from the full dst into the non-outset portion of dst
         src = dst;
@@ -884,20 +929,51 @@ sk_sp<SkSpecialImage> cpu_blur(const skif::Context& ctx,
 
     // Iterate over each column to calculate 1D blur along Y. This is either blurring from src into
     // dst for a 1D blur; or it's blurring from dst into dst for the second pass of a 2D blur.
+    //
+    // Walking a column touches a new cache line for every pixel, so instead we transpose blocks
+    // of kColumnBlock columns (one cache line of each row) into rows, blur those with unit stride,
+    // and transpose the results back. Each block reads all of its src pixels before writing any
+    // dst pixel, and blocks never share columns, so this also works in place.
     if (makerY->window() > 1) {
-        auto srcAddr = src.getAddr32(loopStart - srcBounds.left(), 0);
-        auto dstAddr = dst.getAddr32(loopStart - dstBounds.left(), dstYOffset);
-
-        Pass* pass = makerY->makePass(buffer, &alloc);
-        for (int x = loopStart; x < loopEnd; ++x) {
-            pass->blur(srcBounds.top()    - dstBounds.top(),
-                       srcBounds.bottom() - dstBounds.top(),
-                       dstBounds.height(),
-                       srcAddr, src.rowBytesAsPixels(),
-                       dstAddr, dst.rowBytesAsPixels());
-            srcAddr += 1;
-            dstAddr += 1;
-        }
+        static constexpr int kColumnBlock = 16;
+        const int srcHeight = srcBounds.height();
+        const int dstHeight = dstBounds.height();
+
+        for_each_span(loopStart, loopEnd, srcHeight, kColumnBlock, [&](int start, int end) {
+            SkSTArenaAlloc<1024> spanAlloc;
+            Pass* pass = make_pass(*makerY, &spanAlloc);
+            skia_private::AutoTMalloc<uint32_t> columns(kColumnBlock * (srcHeight + dstHeight));
+            uint32_t* srcColumns = columns.get();
+            uint32_t* dstColumns = srcColumns + kColumnBlock * srcHeight;
+
+            for (int x = start; x < end; x += kColumnBlock) {
+                const int n = std::min(kColumnBlock, end - x);
+
+                const uint32_t* srcAddr = src.getAddr32(x - srcBounds.left(), 0);
+                for (int y = 0; y < srcHeight; ++y) {
+                    for (int i = 0; i < n; ++i) {
+                        srcColumns[i * srcHeight + y] = srcAddr[i];
+                    }
+                    srcAddr += src.rowBytesAsPixels();
+                }
+
+                for (int i = 0; i < n; ++i) {
+                    pass->blur(srcBounds.top()    - dstBounds.top(),
+                               srcBounds.bottom() - dstBounds.top(),
+                               dstHeight,
+                               srcColumns + i * srcHeight, 1,
+                               dstColumns + i * dstHeight, 1);
+                }
+
+                uint32_t* dstAddr = dst.getAddr32(x - dstBounds.left(), dstYOffset);
+                for (int y = 0; y < dstHeight; ++y) {
+                    for (int i = 0; i < n; ++i) {
+                        dstAddr[i] = dstColumns[i * dstHeight + y];
+                    }
+                    dstAddr += dst.rowBytesAsPixels();
+                }
+            }
+        });
     }
 
     originalDstBounds.offset(-dstOrigin); // Make relative to dst's pixels
@@ -0,0 +1,105 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/encode/SkAsyncEncoder.h"
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkStream.h"
+
+#include <optional>
+#include <utility>
+
+SkAsyncEncoder::SkAsyncEncoder(SkExecutor* executor, size_t maxBytesInFlight)
+        : fTasks(executor ? *executor : SkExecutor::GetDefault())
+        , fMaxBytesInFlight(maxBytesInFlight) {}
+
+SkAsyncEncoder::~SkAsyncEncoder() { this->wait(); }
+
+void SkAsyncEncoder::submit(Request request, Callback callback) {
+    std::optional<SkImageInfo> convertedInfo;
+    if (request.fColorType != kUnknown_SkColorType) {
+        convertedInfo = request.fSrc.info().makeColorType(request.fColorType);
+        if (request.fColorSpace) {
+            convertedInfo = convertedInfo->makeColorSpace(request.fColorSpace);
+        }
+    }
+    const size_t srcBytes = request.fSrc.computeByteSize();
+    const size_t convertedBytes = convertedInfo ? convertedInfo->computeMinByteSize() : 0;
+    this->reserve(srcBytes + convertedBytes);
+
+    fTasks.add([this, request = std::move(request), callback = std::move(callback),
+                convertedInfo, srcBytes, convertedBytes] {
+        auto releaseSrc = [&] {
+            if (request.fReleaseProc) {
+                request.fReleaseProc(request.fReleaseContext);
+            }
+            this->release(srcBytes);
+        };
+
+        SkBitmap converted;
+        const SkPixmap* src = &request.fSrc;
+        bool ok = true;
+        if (convertedInfo) {
+            ok = converted.tryAllocPixels(*convertedInfo) &&
+                 request.fSrc.readPixels(converted.pixmap());
+            src = &converted.pixmap();
+            // Nothing needs the original pixels anymore, so let the next request have them.
+            releaseSrc();
+        }
+
+        Result result;
+        result.fEncoded.resize(request.fEncoders.size());
+        for (size_t i = 0; ok && i < request.fEncoders.size(); ++i) {
+            SkDynamicMemoryWStream stream;
+            if (request.fEncoders[i] && request.fEncoders[i](&stream, *src)) {
+                result.fEncoded[i] = stream.detachAsData();
+            }
+        }
+
+        if (convertedInfo) {
+            converted.reset();
+            this->release(convertedBytes);
+        } else {
+            releaseSrc();
+        }
+        callback(std::move(result));
+    });
+}
+
+void SkAsyncEncoder::wait() { fTasks.wait(); }
+
+size_t SkAsyncEncoder::bytesInFlight() const {
+    SkAutoMutexExclusive lock(fMutex);
+    return fBytesInFlight;
+}
+
+void SkAsyncEncoder::reserve(size_t bytes) {
+    for (;;) {
+        {
+            SkAutoMutexExclusive lock(fMutex);
+            if (fBytesInFlight == 0 || fBytesInFlight + bytes <= fMaxBytesInFlight) {
+                fBytesInFlight += bytes;
+                return;
+            }
+            fBlockedSubmits++;
+        }
+        fBytesReleased.wait();
+    }
+}
+
+void SkAsyncEncoder::release(size_t bytes) {
+    int blocked;
+    {
+        SkAutoMutexExclusive lock(fMutex);
+        fBytesInFlight -= bytes;
+        blocked = fBlockedSubmits;
+        fBlockedSubmits = 0;
+    }
+    fBytesReleased.signal(blocked);
+}
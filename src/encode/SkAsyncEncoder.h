@@ -0,0 +1,101 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkAsyncEncoder_DEFINED
+#define SkAsyncEncoder_DEFINED
+
+#include "include/core/SkColorSpace.h"
+#include "include/core/SkColorType.h"
+#include "include/core/SkData.h"
+#include "include/core/SkPixmap.h"
+#include "include/core/SkRefCnt.h"
+#include "include/private/base/SkMutex.h"
+#include "include/private/base/SkSemaphore.h"
+#include "include/private/base/SkThreadAnnotations.h"
+#include "src/core/SkTaskGroup.h"
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+class SkExecutor;
+class SkWStream;
+
+/**
+ *  Encodes images on an SkExecutor instead of on the calling thread.
+ *
+ *  Each request encodes one source into one or more formats, and reports the results to a
+ *  callback. The executor decides how many requests are encoded at once. The caller chooses how
+ *  many bytes of source pixels may be waiting or being encoded at once: when that is used up,
+ *  submit() blocks until earlier requests finish. This keeps memory bounded when the caller
+ *  produces images faster than they can be encoded.
+ *
+ *  submit() may be called from any thread except the executor's own threads, which could
+ *  deadlock on the memory limit.
+ */
+class SkAsyncEncoder {
+public:
+    // Typically a lambda that calls SkPngEncoder::Encode(), SkJpegEncoder::Encode() or
+    // SkWebpEncoder::Encode() with the desired options.
+    using Encoder = std::function<bool(SkWStream*, const SkPixmap&)>;
+    using ReleaseProc = void (*)(void* context);
+
+    struct Request {
+        SkPixmap fSrc;
+
+        // Called, on an executor thread, once the encoders are done with the pixels of fSrc.
+        // It is called even if encoding fails.
+        ReleaseProc fReleaseProc = nullptr;
+        void* fReleaseContext = nullptr;
+
+        // If fColorType is not kUnknown, fSrc is converted to it (and to fColorSpace, if that is
+        // not null) once, before any encoder runs, and every encoder is handed the converted
+        // pixels. For example, encoding an F16 image as both PNG and WebP can share one
+        // conversion to RGBA 8888 instead of each encoder converting on its own.
+        SkColorType fColorType = kUnknown_SkColorType;
+        sk_sp<SkColorSpace> fColorSpace;
+
+        std::vector<Encoder> fEncoders;
+    };
+
+    // fEncoded[i] holds the output of the request's fEncoders[i], or is null if it failed.
+    struct Result {
+        std::vector<sk_sp<SkData>> fEncoded;
+    };
+    using Callback = std::function<void(Result)>;
+
+    // |maxBytesInFlight| limits the total size of the source pixels, plus any converted copies,
+    // of the requests that have been submitted but not finished. A single request that is larger
+    // than the limit still runs, but only once nothing else is in flight.
+    SkAsyncEncoder(SkExecutor* executor, size_t maxBytesInFlight);
+
+    // Waits for all submitted requests to finish.
+    ~SkAsyncEncoder();
+
+    // Queues |request| to be encoded, blocking first if that would go over the memory limit.
+    // |callback| is called on an executor thread once all of the request's encoders have run.
+    void submit(Request request, Callback callback);
+
+    // Blocks until every request submitted so far has finished and had its callback called.
+    void wait();
+
+    size_t bytesInFlight() const;
+
+private:
+    void reserve(size_t bytes);
+    void release(size_t bytes);
+
+    SkTaskGroup     fTasks;
+    const size_t    fMaxBytesInFlight;
+
+    mutable SkMutex fMutex;
+    size_t          fBytesInFlight SK_GUARDED_BY(fMutex) = 0;
+    int             fBlockedSubmits SK_GUARDED_BY(fMutex) = 0;
+    SkSemaphore     fBytesReleased;
+};
+
+#endif
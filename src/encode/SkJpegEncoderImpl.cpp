@@ -13,6 +13,7 @@
 #include "include/core/SkData.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkPixmap.h"
+#include "include/core/SkRect.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkStream.h"
 #include "include/core/SkYUVAInfo.h"
@@ -22,7 +23,9 @@
 #include "include/private/base/SkAssert.h"
 #include "include/private/base/SkNoncopyable.h"
 #include "include/private/base/SkTemplates.h"
+#include "include/private/base/SkTo.h"
 #include "src/base/SkMSAN.h"
+#include "src/core/SkImageInfoPriv.h"
 #include "src/codec/SkJpegConstants.h"
 #include "src/codec/SkJpegPriv.h"
 #include "src/encode/SkImageEncoderFns.h"
@@ -34,6 +37,8 @@
 #include <cstdint>
 #include <cstring>
 #include <memory>
+#include <optional>
+#include <tuple>
 #include <utility>
 
 class GrDirectContext;
@@ -67,6 +72,15 @@ public:
 
     transform_scanline_proc proc() const { return fProc; }
 
+    // Writes |numRows| rows of |src|, which must match the info from initializeRGB().
+    // |storage| must hold a row of input_components bytes per pixel if there is a proc().
+    void writeRGBRows(const SkPixmap& src, int numRows, uint8_t* storage);
+
+    // Writes |numRows| rows of |src|'s planes, starting at luma row |srcRow|, which must be a
+    // multiple of the vertical subsampling factor. |src| must match the info from
+    // initializeYUV(), except for its height.
+    void writeYUVRows(const SkYUVAPixmaps& src, int srcRow, int numRows);
+
     ~SkJpegEncoderMgr() { jpeg_destroy_compress(&fCInfo); }
 
 private:
@@ -77,11 +91,19 @@ private:
         fCInfo.dest = &fDstMgr;
     }
     void initializeCommon(const SkJpegEncoder::Options&, const SkJpegMetadataEncoder::SegmentList&);
+    void writeRawRows();
 
     jpeg_compress_struct fCInfo;
     skjpeg_error_mgr fErrMgr;
     skjpeg_destination_mgr fDstMgr;
     transform_scanline_proc fProc;
+
+    // For YUV, rows are gathered into whole iMCU rows for jpeg_write_raw_data(): up to
+    // v_samp_factor * DCTSIZE rows of each component, padded out to whole blocks.
+    skia_private::AutoTMalloc<JSAMPLE> fRawStorage;
+    JSAMPROW fRawRows[3][MAX_SAMP_FACTOR * DCTSIZE];
+    int fRawRowsFilled = 0;  // Luma rows gathered for the current iMCU row.
+    int fRawImageRows = 0;   // Luma rows of the image written or gathered so far.
 };
 
 bool SkJpegEncoderMgr::initializeRGB(const SkImageInfo& srcInfo,
@@ -181,41 +203,18 @@ bool SkJpegEncoderMgr::initializeRGB(const SkImageInfo& srcInfo,
     return true;
 }
 
-// Convert a row of an SkYUVAPixmaps to a row of Y,U,V triples.
-// TODO(ccameron): This is horribly inefficient.
-static void yuva_copy_row(const SkYUVAPixmaps& src, int row, uint8_t* dst) {
-    int width = src.plane(0).width();
-    switch (src.yuvaInfo().planeConfig()) {
-        case SkYUVAInfo::PlaneConfig::kY_U_V: {
-            auto [ssWidthU, ssHeightU] = src.yuvaInfo().planeSubsamplingFactors(1);
-            auto [ssWidthV, ssHeightV] = src.yuvaInfo().planeSubsamplingFactors(2);
-            const uint8_t* srcY = reinterpret_cast<const uint8_t*>(src.plane(0).addr(0, row));
-            const uint8_t* srcU =
-                    reinterpret_cast<const uint8_t*>(src.plane(1).addr(0, row / ssHeightU));
-            const uint8_t* srcV =
-                    reinterpret_cast<const uint8_t*>(src.plane(2).addr(0, row / ssHeightV));
-            for (int col = 0; col < width; ++col) {
-                dst[3 * col + 0] = srcY[col];
-                dst[3 * col + 1] = srcU[col / ssWidthU];
-                dst[3 * col + 2] = srcV[col / ssWidthV];
-            }
-            break;
-        }
-        case SkYUVAInfo::PlaneConfig::kY_UV: {
-            auto [ssWidthUV, ssHeightUV] = src.yuvaInfo().planeSubsamplingFactors(1);
-            const uint8_t* srcY = reinterpret_cast<const uint8_t*>(src.plane(0).addr(0, row));
-            const uint8_t* srcUV =
-                    reinterpret_cast<const uint8_t*>(src.plane(1).addr(0, row / ssHeightUV));
-            for (int col = 0; col < width; ++col) {
-                dst[3 * col + 0] = srcY[col];
-                dst[3 * col + 1] = srcUV[2 * (col / ssWidthUV) + 0];
-                dst[3 * col + 2] = srcUV[2 * (col / ssWidthUV) + 1];
-            }
-            break;
+// Copies |width| samples, each |stride| bytes apart, to a row of |paddedWidth| samples, repeating
+// the last one to fill the padding.
+static void copy_padded_row(const uint8_t* src, int stride, int width, JSAMPLE* dst,
+                            int paddedWidth) {
+    if (stride == 1) {
+        memcpy(dst, src, width);
+    } else {
+        for (int x = 0; x < width; ++x) {
+            dst[x] = src[x * stride];
         }
-        default:
-            break;
     }
+    memset(dst + width, dst[width - 1], paddedWidth - width);
 }
 
 bool SkJpegEncoderMgr::initializeYUV(const SkYUVAPixmapInfo& srcInfo,
@@ -241,7 +240,7 @@ bool SkJpegEncoderMgr::initializeYUV(const SkYUVAPixmapInfo& srcInfo,
     }
 
     // Support only Y,U,V and Y,UV configurations (they are the only ones supported by
-    // yuva_copy_row).
+    // writeYUVRows).
     switch (srcInfo.yuvaInfo().planeConfig()) {
         case SkYUVAInfo::PlaneConfig::kY_U_V:
         case SkYUVAInfo::PlaneConfig::kY_UV:
@@ -255,11 +254,101 @@ bool SkJpegEncoderMgr::initializeYUV(const SkYUVAPixmapInfo& srcInfo,
     auto [ssHoriz, ssVert] = SkYUVAInfo::SubsamplingFactors(srcInfo.yuvaInfo().subsampling());
     fCInfo.comp_info[0].h_samp_factor = ssHoriz;
     fCInfo.comp_info[0].v_samp_factor = ssVert;
+    fCInfo.raw_data_in = TRUE;
 
     initializeCommon(options, metadataSegments);
+
+    // jpeg_start_compress() has worked out the size of each component in blocks.
+    size_t rawBytes = 0;
+    for (int c = 0; c < 3; ++c) {
+        const jpeg_component_info& comp = fCInfo.comp_info[c];
+        rawBytes += comp.v_samp_factor * DCTSIZE * comp.width_in_blocks * DCTSIZE;
+    }
+    fRawStorage.reset(rawBytes);
+    JSAMPLE* row = fRawStorage.get();
+    for (int c = 0; c < 3; ++c) {
+        const jpeg_component_info& comp = fCInfo.comp_info[c];
+        for (int i = 0; i < comp.v_samp_factor * DCTSIZE; ++i) {
+            fRawRows[c][i] = row;
+            row += comp.width_in_blocks * DCTSIZE;
+        }
+    }
     return true;
 }
 
+void SkJpegEncoderMgr::writeRGBRows(const SkPixmap& src, int numRows, uint8_t* storage) {
+    const size_t srcBytes = SkColorTypeBytesPerPixel(src.colorType()) * src.width();
+    const size_t jpegSrcBytes = fCInfo.input_components * src.width();
+    const void* srcRow = src.addr();
+    for (int i = 0; i < numRows; i++) {
+        JSAMPLE* jpegSrcRow = (JSAMPLE*)(const_cast<void*>(srcRow));
+        if (fProc) {
+            sk_msan_assert_initialized(srcRow, SkTAddOffset<const void>(srcRow, srcBytes));
+            fProc((char*)storage, (const char*)srcRow, src.width(), fCInfo.input_components);
+            jpegSrcRow = storage;
+            sk_msan_assert_initialized(jpegSrcRow,
+                                       SkTAddOffset<const void>(jpegSrcRow, jpegSrcBytes));
+        } else {
+            // Same as above, but this repetition allows determining whether a
+            // proc was used when msan asserts.
+            sk_msan_assert_initialized(jpegSrcRow,
+                                       SkTAddOffset<const void>(jpegSrcRow, jpegSrcBytes));
+        }
+
+        jpeg_write_scanlines(&fCInfo, &jpegSrcRow, 1);
+        srcRow = SkTAddOffset<const void>(srcRow, src.rowBytes());
+    }
+}
+
+void SkJpegEncoderMgr::writeYUVRows(const SkYUVAPixmaps& src, int srcRow, int numRows) {
+    const bool interleavedUV = src.yuvaInfo().planeConfig() == SkYUVAInfo::PlaneConfig::kY_UV;
+    const int ssVert = fCInfo.comp_info[0].v_samp_factor;
+    const int lumaWidth = src.plane(0).width();
+    const int chromaWidth = src.plane(1).width();
+    const int lumaPadded = fCInfo.comp_info[0].width_in_blocks * DCTSIZE;
+    const int chromaPadded = fCInfo.comp_info[1].width_in_blocks * DCTSIZE;
+
+    for (int i = 0; i < numRows; ++i) {
+        const int row = srcRow + i;
+        copy_padded_row(static_cast<const uint8_t*>(src.plane(0).addr(0, row)), 1, lumaWidth,
+                        fRawRows[0][fRawRowsFilled], lumaPadded);
+        if (fRawRowsFilled % ssVert == 0) {
+            const int chromaRow = fRawRowsFilled / ssVert;
+            const auto* u = static_cast<const uint8_t*>(src.plane(1).addr(0, row / ssVert));
+            const auto* v = interleavedUV
+                    ? u + 1
+                    : static_cast<const uint8_t*>(src.plane(2).addr(0, row / ssVert));
+            const int stride = interleavedUV ? 2 : 1;
+            copy_padded_row(u, stride, chromaWidth, fRawRows[1][chromaRow], chromaPadded);
+            copy_padded_row(v, stride, chromaWidth, fRawRows[2][chromaRow], chromaPadded);
+        }
+        if (++fRawRowsFilled == ssVert * DCTSIZE) {
+            this->writeRawRows();
+        }
+    }
+
+    // The last iMCU row is padded out by repeating the bottom rows of each component.
+    fRawImageRows += numRows;
+    if (fRawImageRows == SkToInt(fCInfo.image_height) && fRawRowsFilled > 0) {
+        const int chromaRowsFilled = (fRawRowsFilled + ssVert - 1) / ssVert;
+        for (int i = fRawRowsFilled; i < ssVert * DCTSIZE; ++i) {
+            memcpy(fRawRows[0][i], fRawRows[0][fRawRowsFilled - 1], lumaPadded);
+        }
+        for (int c = 1; c < 3; ++c) {
+            for (int i = chromaRowsFilled; i < DCTSIZE; ++i) {
+                memcpy(fRawRows[c][i], fRawRows[c][chromaRowsFilled - 1], chromaPadded);
+            }
+        }
+        this->writeRawRows();
+    }
+}
+
+void SkJpegEncoderMgr::writeRawRows() {
+    JSAMPARRAY planes[3] = {fRawRows[0], fRawRows[1], fRawRows[2]};
+    jpeg_write_raw_data(&fCInfo, planes, fCInfo.comp_info[0].v_samp_factor * DCTSIZE);
+    fRawRowsFilled = 0;
+}
+
 void SkJpegEncoderMgr::initializeCommon(
         const SkJpegEncoder::Options& options,
         const SkJpegMetadataEncoder::SegmentList& metadataSegments) {
@@ -329,7 +418,7 @@ SkJpegEncoderImpl::SkJpegEncoderImpl(std::unique_ptr<SkJpegEncoderMgr> encoderMg
 
 SkJpegEncoderImpl::SkJpegEncoderImpl(std::unique_ptr<SkJpegEncoderMgr> encoderMgr,
                                      const SkYUVAPixmaps& src)
-        : SkEncoder(src.plane(0), encoderMgr->cinfo()->input_components * src.yuvaInfo().width())
+        : SkEncoder(src.plane(0), 0)
         , fEncoderMgr(std::move(encoderMgr))
         , fSrcYUVA(src) {}
 
@@ -342,37 +431,12 @@ bool SkJpegEncoderImpl::onEncodeRows(int numRows) {
     }
 
     if (fSrcYUVA) {
-        // TODO(ccameron): Consider using jpeg_write_raw_data, to avoid having to re-pack the data.
-        for (int i = 0; i < numRows; i++) {
-            yuva_copy_row(*fSrcYUVA, fCurrRow + i, fStorage.get());
-            JSAMPLE* jpegSrcRow = fStorage.get();
-            jpeg_write_scanlines(fEncoderMgr->cinfo(), &jpegSrcRow, 1);
-        }
+        fEncoderMgr->writeYUVRows(*fSrcYUVA, fCurrRow, numRows);
     } else {
-        const size_t srcBytes = SkColorTypeBytesPerPixel(fSrc.colorType()) * fSrc.width();
-        const size_t jpegSrcBytes = fEncoderMgr->cinfo()->input_components * fSrc.width();
-        const void* srcRow = fSrc.addr(0, fCurrRow);
-        for (int i = 0; i < numRows; i++) {
-            JSAMPLE* jpegSrcRow = (JSAMPLE*)(const_cast<void*>(srcRow));
-            if (fEncoderMgr->proc()) {
-                sk_msan_assert_initialized(srcRow, SkTAddOffset<const void>(srcRow, srcBytes));
-                fEncoderMgr->proc()((char*)fStorage.get(),
-                                    (const char*)srcRow,
-                                    fSrc.width(),
-                                    fEncoderMgr->cinfo()->input_components);
-                jpegSrcRow = fStorage.get();
-                sk_msan_assert_initialized(jpegSrcRow,
-                                           SkTAddOffset<const void>(jpegSrcRow, jpegSrcBytes));
-            } else {
-                // Same as above, but this repetition allows determining whether a
-                // proc was used when msan asserts.
-                sk_msan_assert_initialized(jpegSrcRow,
-                                           SkTAddOffset<const void>(jpegSrcRow, jpegSrcBytes));
-            }
-
-            jpeg_write_scanlines(fEncoderMgr->cinfo(), &jpegSrcRow, 1);
-            srcRow = SkTAddOffset<const void>(srcRow, fSrc.rowBytes());
-        }
+        SkPixmap rows;
+        SkAssertResult(fSrc.extractSubset(&rows, SkIRect::MakeXYWH(0, fCurrRow, fSrc.width(),
+                                                                    numRows)));
+        fEncoderMgr->writeRGBRows(rows, numRows, fStorage.get());
     }
 
     fCurrRow += numRows;
@@ -383,6 +447,93 @@ bool SkJpegEncoderImpl::onEncodeRows(int numRows) {
     return true;
 }
 
+namespace {
+
+class SkJpegStreamingEncoderImpl final : public SkJpegEncoder::StreamingEncoder {
+public:
+    SkJpegStreamingEncoderImpl(std::unique_ptr<SkJpegEncoderMgr> encoderMgr,
+                               const SkImageInfo& info)
+            : fEncoderMgr(std::move(encoderMgr))
+            , fInfo(info)
+            , fStorage(fEncoderMgr->proc()
+                               ? fEncoderMgr->cinfo()->input_components * info.width()
+                               : 0) {}
+
+    SkJpegStreamingEncoderImpl(std::unique_ptr<SkJpegEncoderMgr> encoderMgr,
+                               const SkYUVAPixmapInfo& info)
+            : fEncoderMgr(std::move(encoderMgr))
+            , fInfo(SkImageInfo::MakeUnknown(info.yuvaInfo().width(), info.yuvaInfo().height()))
+            , fYUVAInfo(info) {}
+
+    bool encodeRows(const SkPixmap& rows) override {
+        if (fYUVAInfo || !this->canEncode(rows.height()) || !rows.addr() ||
+            rows.width() != fInfo.width() || rows.colorType() != fInfo.colorType() ||
+            rows.alphaType() != fInfo.alphaType()) {
+            return this->fail();
+        }
+
+        skjpeg_error_mgr::AutoPushJmpBuf jmp(fEncoderMgr->errorMgr());
+        if (setjmp(jmp)) {
+            return this->fail();
+        }
+        fEncoderMgr->writeRGBRows(rows, rows.height(), fStorage.get());
+        this->advance(rows.height());
+        return true;
+    }
+
+    bool encodeRows(const SkYUVAPixmaps& rows) override {
+        if (!fYUVAInfo || !rows.isValid()) {
+            return this->fail();
+        }
+        const SkYUVAInfo& expected = fYUVAInfo->yuvaInfo();
+        const SkYUVAInfo& actual = rows.yuvaInfo();
+        const int numRows = actual.height();
+        const int ssVert = std::get<1>(SkYUVAInfo::SubsamplingFactors(expected.subsampling()));
+        if (!this->canEncode(numRows) || actual.width() != expected.width() ||
+            actual.planeConfig() != expected.planeConfig() ||
+            actual.subsampling() != expected.subsampling() ||
+            rows.dataType() != fYUVAInfo->dataType() ||
+            (numRows % ssVert != 0 && fCurrRow + numRows != fInfo.height())) {
+            return this->fail();
+        }
+
+        skjpeg_error_mgr::AutoPushJmpBuf jmp(fEncoderMgr->errorMgr());
+        if (setjmp(jmp)) {
+            return this->fail();
+        }
+        fEncoderMgr->writeYUVRows(rows, 0, numRows);
+        this->advance(numRows);
+        return true;
+    }
+
+private:
+    bool canEncode(int numRows) const {
+        return !fFailed && numRows > 0 && numRows <= fInfo.height() - fCurrRow;
+    }
+
+    bool fail() {
+        fFailed = true;
+        return false;
+    }
+
+    // Must be called with the error manager's jump buffer pushed.
+    void advance(int numRows) {
+        fCurrRow += numRows;
+        if (fCurrRow == fInfo.height()) {
+            jpeg_finish_compress(fEncoderMgr->cinfo());
+        }
+    }
+
+    std::unique_ptr<SkJpegEncoderMgr> fEncoderMgr;
+    const SkImageInfo fInfo;
+    const std::optional<SkYUVAPixmapInfo> fYUVAInfo;
+    skia_private::AutoTMalloc<uint8_t> fStorage;
+    int fCurrRow = 0;
+    bool fFailed = false;
+};
+
+}  // namespace
+
 namespace SkJpegEncoder {
 
 bool Encode(SkWStream* dst, const SkPixmap& src, const Options& options) {
@@ -430,6 +581,49 @@ std::unique_ptr<SkEncoder> Make(SkWStream* dst,
     return SkJpegEncoderImpl::MakeYUV(dst, src, srcColorSpace, options, metadataSegments);
 }
 
+std::unique_ptr<StreamingEncoder> Make(SkWStream* dst,
+                                       const SkImageInfo& info,
+                                       const Options& options) {
+    if (!SkImageInfoIsValid(info)) {
+        return nullptr;
+    }
+    SkJpegMetadataEncoder::SegmentList metadataSegments;
+    SkJpegMetadataEncoder::AppendXMPStandard(metadataSegments, options.xmpMetadata);
+    SkJpegMetadataEncoder::AppendICC(metadataSegments, options, info.colorSpace());
+
+    std::unique_ptr<SkJpegEncoderMgr> encoderMgr = SkJpegEncoderMgr::Make(dst);
+    skjpeg_error_mgr::AutoPushJmpBuf jmp(encoderMgr->errorMgr());
+    if (setjmp(jmp)) {
+        return nullptr;
+    }
+    if (!encoderMgr->initializeRGB(info, options, metadataSegments)) {
+        return nullptr;
+    }
+    return std::make_unique<SkJpegStreamingEncoderImpl>(std::move(encoderMgr), info);
+}
+
+std::unique_ptr<StreamingEncoder> Make(SkWStream* dst,
+                                       const SkYUVAPixmapInfo& info,
+                                       const SkColorSpace* srcColorSpace,
+                                       const Options& options) {
+    if (!info.isValid()) {
+        return nullptr;
+    }
+    SkJpegMetadataEncoder::SegmentList metadataSegments;
+    SkJpegMetadataEncoder::AppendXMPStandard(metadataSegments, options.xmpMetadata);
+    SkJpegMetadataEncoder::AppendICC(metadataSegments, options, srcColorSpace);
+
+    std::unique_ptr<SkJpegEncoderMgr> encoderMgr = SkJpegEncoderMgr::Make(dst);
+    skjpeg_error_mgr::AutoPushJmpBuf jmp(encoderMgr->errorMgr());
+    if (setjmp(jmp)) {
+        return nullptr;
+    }
+    if (!encoderMgr->initializeYUV(info, options, metadataSegments)) {
+        return nullptr;
+    }
+    return std::make_unique<SkJpegStreamingEncoderImpl>(std::move(encoderMgr), info);
+}
+
 }  // namespace SkJpegEncoder
 
 namespace SkJpegMetadataEncoder {
@@ -13,6 +13,7 @@
 #include "include/core/SkColorType.h"
 #include "include/core/SkData.h"
 #include "include/core/SkDataTable.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkPixmap.h"
 #include "include/core/SkRefCnt.h"
@@ -23,10 +24,15 @@
 #include "include/private/base/SkAssert.h"
 #include "include/private/base/SkDebug.h"
 #include "include/private/base/SkNoncopyable.h"
+#include "include/private/base/SkSpan_impl.h"
+#include "include/private/base/SkTFitsIn.h"
 #include "include/private/base/SkTemplates.h"
+#include "include/private/base/SkTo.h"
 #include "modules/skcms/skcms.h"
 #include "src/base/SkMSAN.h"
+#include "src/base/SkVx.h"
 #include "src/codec/SkPngPriv.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/encode/SkImageEncoderFns.h"
 #include "src/encode/SkImageEncoderPriv.h"
 #include "src/image/SkImage_Base.h"
@@ -35,12 +41,15 @@
 #include <csetjmp>
 #include <cstdint>
 #include <cstring>
+#include <initializer_list>
+#include <limits>
 #include <memory>
 #include <utility>
 #include <vector>
 
 #include <png.h>
 #include <pngconf.h>
+#include "zlib.h"  // NO_G3_REWRITE
 
 class GrDirectContext;
 class SkImage;
@@ -444,13 +453,360 @@ bool SkPngEncoderMgr::writeInfo(const SkImageInfo& srcInfo) {
 
 void SkPngEncoderMgr::chooseProc(const SkImageInfo& srcInfo) { fProc = choose_proc(srcInfo); }
 
-SkPngEncoderImpl::SkPngEncoderImpl(std::unique_ptr<SkPngEncoderMgr> encoderMgr, const SkPixmap& src)
+namespace {
+
+// PNG filters predict each byte from the byte of the pixel to its left (a), the byte above it (b)
+// and the byte above and to the left (c), all taken from the unfiltered rows. So when encoding,
+// unlike when decoding, no byte depends on another filtered byte and every filter vectorizes.
+template <int N> using U8 = skvx::Vec<N, uint8_t>;
+template <int N> using I16 = skvx::Vec<N, int16_t>;
+
+template <int kFilter, int N>
+SK_ALWAYS_INLINE U8<N> predict(const U8<N>& a, const U8<N>& b, const U8<N>& c) {
+    if constexpr (kFilter == PNG_FILTER_VALUE_SUB) {
+        return a;
+    } else if constexpr (kFilter == PNG_FILTER_VALUE_UP) {
+        return b;
+    } else if constexpr (kFilter == PNG_FILTER_VALUE_AVG) {
+        // (a + b) / 2, without overflowing 8 bits.
+        return (a & b) + ((a ^ b) >> 1);
+    } else if constexpr (kFilter == PNG_FILTER_VALUE_PAETH) {
+        auto abs = [](const I16<N>& x) { return max(x, I16<N>(0) - x); };
+        const I16<N> ia = skvx::cast<int16_t>(a),
+                     ib = skvx::cast<int16_t>(b),
+                     ic = skvx::cast<int16_t>(c);
+        const I16<N> pa = abs(ib - ic),
+                     pb = abs(ia - ic),
+                     pc = abs(ia + ib - ic - ic);
+        return skvx::cast<uint8_t>(if_then_else((pa <= pb) & (pa <= pc), ia,
+                                                if_then_else(pb <= pc, ib, ic)));
+    } else {
+        return U8<N>(0);
+    }
+}
+
+// Writes the rowBytes filtered bytes of row to dst. prior is the unfiltered row above it.
+template <int kFilter>
+void filter_row(const uint8_t* row, const uint8_t* prior, size_t rowBytes, size_t bpp,
+                uint8_t* dst) {
+    // The first pixel has nothing to its left, so a and c are 0.
+    size_t i = 0;
+    for (; i < std::min(bpp, rowBytes); ++i) {
+        dst[i] = (U8<1>(row[i]) - predict<kFilter, 1>(U8<1>(0), U8<1>(prior[i]), U8<1>(0)))[0];
+    }
+    for (; i + 16 <= rowBytes; i += 16) {
+        const U8<16> a = U8<16>::Load(row + i - bpp),
+                     b = U8<16>::Load(prior + i),
+                     c = U8<16>::Load(prior + i - bpp);
+        (U8<16>::Load(row + i) - predict<kFilter, 16>(a, b, c)).store(dst + i);
+    }
+    for (; i < rowBytes; ++i) {
+        dst[i] = (U8<1>(row[i]) - predict<kFilter, 1>(U8<1>(row[i - bpp]), U8<1>(prior[i]),
+                                                      U8<1>(prior[i - bpp])))[0];
+    }
+}
+
+using FilterRowProc = void (*)(const uint8_t*, const uint8_t*, size_t, size_t, uint8_t*);
+constexpr FilterRowProc kFilterRowProcs[] = {
+        filter_row<PNG_FILTER_VALUE_NONE>,
+        filter_row<PNG_FILTER_VALUE_SUB>,
+        filter_row<PNG_FILTER_VALUE_UP>,
+        filter_row<PNG_FILTER_VALUE_AVG>,
+        filter_row<PNG_FILTER_VALUE_PAETH>,
+};
+
+// The heuristic libpng uses to choose between filters: the sum of the filtered bytes, taken as
+// signed values. Smaller sums tend to compress better.
+uint32_t filtered_row_cost(const uint8_t* filtered, size_t rowBytes) {
+    uint32_t cost = 0;
+    size_t i = 0;
+    while (i + 16 <= rowBytes) {
+        // Each lane grows by at most 128 per step, so fold the lanes in before they overflow.
+        skvx::Vec<16, uint16_t> sum(0);
+        for (int step = 0; step < 256 && i + 16 <= rowBytes; ++step, i += 16) {
+            const U8<16> v = U8<16>::Load(filtered + i);
+            sum += skvx::cast<uint16_t>(min(v, U8<16>(0) - v));
+        }
+        for (int lane = 0; lane < 16; ++lane) {
+            cost += sum[lane];
+        }
+    }
+    for (; i < rowBytes; ++i) {
+        cost += std::min<uint32_t>(filtered[i], 256 - filtered[i]);
+    }
+    return cost;
+}
+
+}  // namespace
+
+/*
+ * Encodes the image data of a PNG on an SkExecutor, pigz-style, bypassing libpng's IDAT writing.
+ * Bands of rows are filtered and deflated concurrently, each into its own raw deflate stream.
+ * Each stream is primed with the last 32KB of filtered data above it and ends with a sync flush,
+ * so the streams concatenate into a single zlib stream, which is written out in IDAT chunks.
+ */
+class SkPngParallelEncoder final : SkNoncopyable {
+public:
+    SkPngParallelEncoder(SkWStream* stream,
+                         const SkPixmap& src,
+                         transform_scanline_proc proc,
+                         size_t rowBytes,
+                         size_t bytesPerPixel,
+                         int filters,
+                         int zlibLevel,
+                         SkExecutor* executor)
+            : fStream(stream)
+            , fSrc(src)
+            , fProc(proc)
+            , fRowBytes(rowBytes)
+            , fBytesPerPixel(bytesPerPixel)
+            , fFilters(filters)
+            , fZLibLevel(zlibLevel)
+            , fExecutor(executor) {}
+
+    // Encodes rows [top, top + numRows), and finishes the image after its last row.
+    bool encodeRows(int top, int numRows);
+
+private:
+    struct Band {
+        std::vector<uint8_t> fDeflated;
+        uLong fAdler = 0;
+        bool fSucceeded = false;
+    };
+
+    // Bands this large compress about as well as the whole image in one stream.
+    static constexpr size_t kBandBytes = 256 * 1024;
+    // The size of deflate's window, and so of the dictionary that primes each band.
+    static constexpr size_t kWindowBytes = 32 * 1024;
+
+    size_t filteredRowBytes() const { return fRowBytes + 1; }
+    void transformRow(int y, uint8_t* dst) const;
+    // Writes the filter type byte and the filtered row to dst.
+    void filterRow(const uint8_t* row, const uint8_t* prior, uint8_t* dst) const;
+    bool encodeBand(int top, int bottom, bool finish, Band*) const;
+    bool writeChunk(const char type[4], std::initializer_list<SkSpan<const uint8_t>> data);
+
+    SkWStream* fStream;
+    const SkPixmap fSrc;
+    const transform_scanline_proc fProc;
+    const size_t fRowBytes;
+    const size_t fBytesPerPixel;
+    const int fFilters;
+    const int fZLibLevel;
+    SkExecutor* fExecutor;
+
+    bool fWroteZLibHeader = false;
+    uLong fAdler = 1;  // The Adler-32 of an empty stream.
+};
+
+void SkPngParallelEncoder::transformRow(int y, uint8_t* dst) const {
+    const void* srcRow = fSrc.addr(0, y);
+    sk_msan_assert_initialized(srcRow,
+                               (const uint8_t*)srcRow + (fSrc.width() << fSrc.shiftPerPixel()));
+    fProc((char*)dst, (const char*)srcRow, fSrc.width(), fSrc.info().bytesPerPixel());
+}
+
+void SkPngParallelEncoder::filterRow(const uint8_t* row, const uint8_t* prior, uint8_t* dst) const {
+    int candidates[5];
+    int candidateCount = 0;
+    for (int filter = PNG_FILTER_VALUE_NONE; filter <= PNG_FILTER_VALUE_PAETH; ++filter) {
+        if (fFilters & (PNG_FILTER_NONE << filter)) {
+            candidates[candidateCount++] = filter;
+        }
+    }
+    if (candidateCount <= 1) {
+        const int filter = candidateCount ? candidates[0] : PNG_FILTER_VALUE_NONE;
+        dst[0] = SkToU8(filter);
+        kFilterRowProcs[filter](row, prior, fRowBytes, fBytesPerPixel, dst + 1);
+        return;
+    }
+
+    skia_private::AutoTMalloc<uint8_t> scratch(fRowBytes);
+    uint32_t bestCost = std::numeric_limits<uint32_t>::max();
+    for (int i = 0; i < candidateCount; ++i) {
+        uint8_t* filtered = i == 0 ? dst + 1 : scratch.get();
+        kFilterRowProcs[candidates[i]](row, prior, fRowBytes, fBytesPerPixel, filtered);
+        const uint32_t cost = filtered_row_cost(filtered, fRowBytes);
+        if (cost < bestCost) {
+            bestCost = cost;
+            dst[0] = SkToU8(candidates[i]);
+            if (filtered != dst + 1) {
+                memcpy(dst + 1, filtered, fRowBytes);
+            }
+        }
+    }
+}
+
+bool SkPngParallelEncoder::encodeBand(int top, int bottom, bool finish, Band* band) const {
+    // Also filter enough of the rows above to fill deflate's window, to use as the dictionary.
+    const size_t filteredRowBytes = this->filteredRowBytes();
+    const int dictionaryRows =
+            std::min(top, SkToInt((kWindowBytes + filteredRowBytes - 1) / filteredRowBytes));
+    const int firstRow = top - dictionaryRows;
+
+    std::vector<uint8_t> filtered((bottom - firstRow) * filteredRowBytes);
+    skia_private::AutoTMalloc<uint8_t> rows(2 * fRowBytes);
+    uint8_t* prior = rows.get();
+    uint8_t* row = rows.get() + fRowBytes;
+    if (firstRow == 0) {
+        // The row above the first row is all zeros.
+        memset(prior, 0, fRowBytes);
+    } else {
+        this->transformRow(firstRow - 1, prior);
+    }
+    for (int y = firstRow; y < bottom; ++y) {
+        this->transformRow(y, row);
+        this->filterRow(row, prior, filtered.data() + (y - firstRow) * filteredRowBytes);
+        std::swap(row, prior);
+    }
+
+    const uint8_t* input = filtered.data() + dictionaryRows * filteredRowBytes;
+    const size_t inputBytes = (bottom - top) * filteredRowBytes;
+    if (!SkTFitsIn<uInt>(inputBytes)) {
+        return false;
+    }
+    band->fAdler = adler32(adler32(0, nullptr, 0), input, SkToUInt(inputBytes));
+
+    // Like libpng, only use zlib's filtered strategy when the rows are filtered.
+    const int strategy = fFilters & ~PNG_FILTER_NONE ? Z_FILTERED : Z_DEFAULT_STRATEGY;
+    z_stream zstream = {};
+    if (deflateInit2(&zstream, fZLibLevel, Z_DEFLATED, /*windowBits=*/-15, /*memLevel=*/8,
+                     strategy) != Z_OK) {
+        return false;
+    }
+    if (dictionaryRows > 0) {
+        const size_t dictionaryBytes = std::min(kWindowBytes, dictionaryRows * filteredRowBytes);
+        if (deflateSetDictionary(&zstream, input - dictionaryBytes,
+                                 SkToUInt(dictionaryBytes)) != Z_OK) {
+            deflateEnd(&zstream);
+            return false;
+        }
+    }
+
+    zstream.next_in = const_cast<Bytef*>(input);
+    zstream.avail_in = SkToUInt(inputBytes);
+    // deflateBound() does not count the empty block a sync flush ends with.
+    std::vector<uint8_t>& deflated = band->fDeflated;
+    deflated.resize(deflateBound(&zstream, zstream.avail_in) + 16);
+    const int flush = finish ? Z_FINISH : Z_SYNC_FLUSH;
+    size_t produced = 0;
+    int result;
+    do {
+        if (produced == deflated.size()) {
+            deflated.resize(2 * deflated.size());
+        }
+        zstream.next_out = deflated.data() + produced;
+        zstream.avail_out = SkToUInt(deflated.size() - produced);
+        result = deflate(&zstream, flush);
+        produced = deflated.size() - zstream.avail_out;
+    } while (result == Z_OK && zstream.avail_out == 0);
+    deflateEnd(&zstream);
+    deflated.resize(produced);
+
+    return finish ? result == Z_STREAM_END : result == Z_OK;
+}
+
+bool SkPngParallelEncoder::writeChunk(const char type[4],
+                                      std::initializer_list<SkSpan<const uint8_t>> data) {
+    size_t length = 0;
+    for (SkSpan<const uint8_t> part : data) {
+        length += part.size();
+    }
+    if (length > PNG_UINT_31_MAX) {
+        return false;
+    }
+
+    uint8_t header[8];
+    png_save_uint_32(header, SkToU32(length));
+    memcpy(header + 4, type, 4);
+    uLong crc = crc32(crc32(0, nullptr, 0), header + 4, 4);
+    for (SkSpan<const uint8_t> part : data) {
+        // crc32() starts over when handed a null buffer, which an empty span may have.
+        if (!part.empty()) {
+            crc = crc32(crc, part.data(), SkToUInt(part.size()));
+        }
+    }
+    uint8_t footer[4];
+    png_save_uint_32(footer, SkToU32(crc));
+
+    if (!fStream->write(header, sizeof(header))) {
+        return false;
+    }
+    for (SkSpan<const uint8_t> part : data) {
+        if (!fStream->write(part.data(), part.size())) {
+            return false;
+        }
+    }
+    return fStream->write(footer, sizeof(footer));
+}
+
+bool SkPngParallelEncoder::encodeRows(int top, int numRows) {
+    const int bottom = top + numRows;
+    const bool finish = bottom == fSrc.height();
+    const int rowsPerBand = std::max(1, SkToInt(kBandBytes / this->filteredRowBytes()));
+    const int bandCount = (numRows + rowsPerBand - 1) / rowsPerBand;
+
+    std::vector<Band> bands(bandCount);
+    SkTaskGroup tasks(*fExecutor);
+    tasks.batch(bandCount, [&](int i) {
+        const int bandTop = top + i * rowsPerBand;
+        const int bandBottom = std::min(bandTop + rowsPerBand, bottom);
+        bands[i].fSucceeded =
+                this->encodeBand(bandTop, bandBottom, finish && i == bandCount - 1, &bands[i]);
+    });
+    tasks.wait();
+
+    // zlib's header for a 32KB window and no preset dictionary. The level bits are only a hint to
+    // decoders; these match the ones deflate() would write.
+    uint8_t zlibHeader[2] = {0x78, 0};
+    const int levelFlags = fZLibLevel < 2 ? 0 : fZLibLevel < 6 ? 1 : fZLibLevel == 6 ? 2 : 3;
+    zlibHeader[1] = SkToU8(levelFlags << 6);
+    zlibHeader[1] += SkToU8(31 - (zlibHeader[0] * 256 + zlibHeader[1]) % 31);
+
+    for (int i = 0; i < bandCount; ++i) {
+        const Band& band = bands[i];
+        if (!band.fSucceeded) {
+            return false;
+        }
+        const int bandRows = std::min(rowsPerBand, numRows - i * rowsPerBand);
+        fAdler = adler32_combine(fAdler, band.fAdler, bandRows * this->filteredRowBytes());
+
+        SkSpan<const uint8_t> header, trailer;
+        if (!fWroteZLibHeader) {
+            header = zlibHeader;
+            fWroteZLibHeader = true;
+        }
+        uint8_t adler[4];
+        if (finish && i == bandCount - 1) {
+            png_save_uint_32(adler, SkToU32(fAdler));
+            trailer = adler;
+        }
+        if (!this->writeChunk("IDAT", {header, SkSpan(band.fDeflated), trailer})) {
+            return false;
+        }
+    }
+
+    return !finish || this->writeChunk("IEND", {});
+}
+
+SkPngEncoderImpl::SkPngEncoderImpl(std::unique_ptr<SkPngEncoderMgr> encoderMgr,
+                                   std::unique_ptr<SkPngParallelEncoder> parallelEncoder,
+                                   const SkPixmap& src)
         : SkEncoder(src, encoderMgr->pngBytesPerPixel() * src.width())
-        , fEncoderMgr(std::move(encoderMgr)) {}
+        , fEncoderMgr(std::move(encoderMgr))
+        , fParallelEncoder(std::move(parallelEncoder)) {}
 
 SkPngEncoderImpl::~SkPngEncoderImpl() {}
 
 bool SkPngEncoderImpl::onEncodeRows(int numRows) {
+    if (fParallelEncoder) {
+        if (!fParallelEncoder->encodeRows(fCurrRow, numRows)) {
+            return false;
+        }
+        fCurrRow += numRows;
+        return true;
+    }
+
     if (setjmp(png_jmpbuf(fEncoderMgr->pngPtr()))) {
         return false;
     }
@@ -502,7 +858,20 @@ std::unique_ptr<SkEncoder> Make(SkWStream* dst, const SkPixmap& src, const Optio
 
     encoderMgr->chooseProc(src.info());
 
-    return std::make_unique<SkPngEncoderImpl>(std::move(encoderMgr), src);
+    // The parallel encoder writes the rows exactly as transformed, so it cannot be used when
+    // libpng would transform them further (e.g. to drop the alpha of opaque F16).
+    std::unique_ptr<SkPngParallelEncoder> parallelEncoder;
+    const size_t pngRowBytes = png_get_rowbytes(encoderMgr->pngPtr(), encoderMgr->infoPtr());
+    const size_t pngBytesPerPixel = SkToSizeT(encoderMgr->pngBytesPerPixel());
+    if (options.fExecutor && pngRowBytes == pngBytesPerPixel * src.width()) {
+        parallelEncoder = std::make_unique<SkPngParallelEncoder>(
+                dst, src, encoderMgr->proc(), pngRowBytes, pngBytesPerPixel,
+                (int)options.fFilterFlags & (int)FilterFlag::kAll,
+                std::min(std::max(0, options.fZLibLevel), 9), options.fExecutor);
+    }
+
+    return std::make_unique<SkPngEncoderImpl>(
+            std::move(encoderMgr), std::move(parallelEncoder), src);
 }
 
 bool Encode(SkWStream* dst, const SkPixmap& src, const Options& options) {
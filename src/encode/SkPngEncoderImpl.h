@@ -14,16 +14,21 @@
 
 class SkPixmap;
 class SkPngEncoderMgr;
+class SkPngParallelEncoder;
 
 class SkPngEncoderImpl : public SkEncoder {
 public:
     // public so it can be called from SkPngEncoder namespace. It should only be made
     // via SkPngEncoder::Make
-    SkPngEncoderImpl(std::unique_ptr<SkPngEncoderMgr>, const SkPixmap& src);
+    // If parallelEncoder is not null, it encodes all of the rows instead of libpng.
+    SkPngEncoderImpl(std::unique_ptr<SkPngEncoderMgr>,
+                     std::unique_ptr<SkPngParallelEncoder> parallelEncoder,
+                     const SkPixmap& src);
     ~SkPngEncoderImpl() override;
 
 protected:
     bool onEncodeRows(int numRows) override;
     std::unique_ptr<SkPngEncoderMgr> fEncoderMgr;
+    std::unique_ptr<SkPngParallelEncoder> fParallelEncoder;
 };
 #endif
@@ -14,6 +14,7 @@
 #include "include/private/base/SkAssert.h"
 #include "include/private/base/SkDebug.h"
 #include "include/private/base/SkTArray.h"
+#include "include/private/base/SkTDArray.h"
 #include "src/core/SkMessageBus.h"
 
 #include <cstddef>
@@ -90,14 +91,39 @@ public:
         fClientHeldBuffers.emplace_front(std::move(b));
     }
 
+    /**
+     * Like insert() but once process() unmaps the buffer it is handed to the 'recycle' function
+     * passed to it rather than let go.
+     */
+    void insertRecyclable(sk_sp<T> b) {
+        fRecyclableBuffers.push_back(b.get());
+        this->insert(std::move(b));
+    }
+
     /** Poll for messages and unmap any incoming buffers. */
     void process() {
+        this->process([](sk_sp<T>) {});
+    }
+
+    /**
+     * Like process(), but passes the unmapped buffers that were inserted with insertRecyclable()
+     * to 'recycle'.
+     */
+    template <typename RecycleFn>
+    void process(RecycleFn&& recycle) {
         skia_private::STArray<4, BufferFinishedMessage> messages;
         fFinishedBufferInbox.poll(&messages);
         if (!fAbandoned) {
             for (auto& m : messages) {
                 this->remove(m.fBuffer);
                 m.fBuffer->unmap();
+                for (int i = 0; i < fRecyclableBuffers.size(); ++i) {
+                    if (fRecyclableBuffers[i] == m.fBuffer.get()) {
+                        fRecyclableBuffers.removeShuffle(i);
+                        recycle(std::move(m.fBuffer));
+                        break;
+                    }
+                }
             }
         }
     }
@@ -106,11 +132,14 @@ public:
     void abandon() {
         fAbandoned = true;
         fClientHeldBuffers.clear();
+        fRecyclableBuffers.clear();
     }
 
 private:
     typename BufferFinishedMessageBus::Inbox fFinishedBufferInbox;
     std::forward_list<sk_sp<T>> fClientHeldBuffers;
+    // The held buffers that were inserted with insertRecyclable().
+    SkTDArray<const T*> fRecyclableBuffers;
     bool fAbandoned = false;
 
     void remove(const sk_sp<T>& b) {
@@ -140,7 +169,16 @@ public:
 
     ~TAsyncReadResult() override {
         for (int i = 0; i < fPlanes.size(); ++i) {
-            fPlanes[i].releaseMappedBuffer(fIntendedRecipient);
+            // Planes may share a buffer, which is only handed back once.
+            bool shared = false;
+            for (int j = i + 1; j < fPlanes.size() && !shared; ++j) {
+                shared = fPlanes[j].sharesMappedBuffer(fPlanes[i]);
+            }
+            if (shared) {
+                fPlanes[i].dropMappedBuffer();
+            } else {
+                fPlanes[i].releaseMappedBuffer(fIntendedRecipient);
+            }
         }
     }
 
@@ -164,7 +202,7 @@ public:
             result.fTransferBuffer->unmap();
         } else {
             manager->insert(result.fTransferBuffer);
-            this->addMappedPlane(mappedData, rowBytes, std::move(result.fTransferBuffer));
+            this->addMappedPlane(std::move(result.fTransferBuffer), /*offset=*/0, rowBytes);
         }
         return true;
     }
@@ -175,19 +213,22 @@ public:
         fPlanes.emplace_back(std::move(data), rowBytes);
     }
 
-private:
-    void addMappedPlane(const void* data, size_t rowBytes, sk_sp<T> mappedBuffer) {
-        SkASSERT(data);
+    /**
+     * Adds a plane that starts at 'offset' in 'mappedBuffer'. The buffer must have been inserted
+     * in the manager once, however many planes of the result share it.
+     */
+    void addMappedPlane(sk_sp<T> mappedBuffer, size_t offset, size_t rowBytes) {
         SkASSERT(rowBytes > 0);
         SkASSERT(mappedBuffer);
         SkASSERT(mappedBuffer->isMapped());
-        fPlanes.emplace_back(std::move(mappedBuffer), rowBytes);
+        fPlanes.emplace_back(std::move(mappedBuffer), offset, rowBytes);
     }
 
+private:
     class Plane {
     public:
-        Plane(sk_sp<T> buffer, size_t rowBytes)
-                : fMappedBuffer(std::move(buffer)), fRowBytes(rowBytes) {}
+        Plane(sk_sp<T> buffer, size_t offset, size_t rowBytes)
+                : fMappedBuffer(std::move(buffer)), fOffset(offset), fRowBytes(rowBytes) {}
         Plane(sk_sp<SkData> data, size_t rowBytes) : fData(std::move(data)), fRowBytes(rowBytes) {}
 
         Plane(Plane&&) = default;
@@ -204,11 +245,16 @@ private:
             }
         }
 
+        bool sharesMappedBuffer(const Plane& that) const {
+            return fMappedBuffer && fMappedBuffer == that.fMappedBuffer;
+        }
+        void dropMappedBuffer() { fMappedBuffer.reset(); }
+
         const void* data() const {
             if (fMappedBuffer) {
                 SkASSERT(!fData);
                 SkASSERT(fMappedBuffer->isMapped());
-                return fMappedBuffer->map();
+                return static_cast<const char*>(fMappedBuffer->map()) + fOffset;
             }
             SkASSERT(fData);
             return fData->data();
@@ -219,6 +265,7 @@ private:
     private:
         sk_sp<SkData> fData;
         sk_sp<T> fMappedBuffer;
+        size_t fOffset = 0;
         size_t fRowBytes;
     };
     skia_private::STArray<4, Plane> fPlanes;
@@ -28,7 +28,7 @@
 class GrOpFlushState;
 class SkAutoPixmapStorage;
 class TestingUploadTarget;
-namespace skgpu::graphite { class RecorderPriv; }
+namespace skgpu::graphite { class RecorderPriv; class TextAtlasManager; }
 
 /**
  * This file includes internal types that are used by all of our gpu backends for atlases.
@@ -131,6 +131,16 @@ static constexpr SkColorType MaskFormatToColorType(MaskFormat format) {
     SkUNREACHABLE;
 }
 
+// The name the glyph atlas of each MaskFormat is reported under, e.g. in a GpuMemoryReport.
+static constexpr const char* MaskFormatToTextAtlasName(MaskFormat format) {
+    switch (format) {
+        case MaskFormat::kA8:   return "text_a8";
+        case MaskFormat::kA565: return "text_565";
+        case MaskFormat::kARGB: return "text_argb";
+    }
+    SkUNREACHABLE;
+}
+
 /**
  * Keep track of generation number for atlases and Plots.
  */
@@ -218,6 +228,7 @@ private:
     friend class ::GrOpFlushState;
     friend class ::TestingUploadTarget;
     friend class skgpu::graphite::RecorderPriv;
+    friend class skgpu::graphite::TextAtlasManager;
 
     // Issues the next token for a draw.
     AtlasToken issueDrawToken() { return ++fCurrentDrawToken; }
@@ -490,6 +501,9 @@ public:
 
     void markFullIfUsed() { fIsFull = !fDirtyRect.isEmpty(); }
 
+    /** The fraction of the Plot's area that holds subimages. */
+    float percentFull() const { return fRectanizer.percentFull(); }
+
     /**
      * Create a clone of this plot. The cloned plot will take the place of the current plot in
      * the atlas
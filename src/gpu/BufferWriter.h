@@ -472,6 +472,13 @@ struct TextureUploadWriter : public BufferWriter {
         SkRectMemcpy(dst, dstRowBytes, src, srcRowBytes, trimRowBytes, rowCount);
     }
 
+    // Returns the start of a block of image data at `offset` that is `dstRowBytes` wide and
+    // `rowCount` rows tall, for callers that produce the pixels directly in the upload buffer.
+    void* writableBlock(size_t offset, size_t dstRowBytes, int rowCount) {
+        this->validate(offset + dstRowBytes * rowCount);
+        return SkTAddOffset<void>(fPtr, offset);
+    }
+
     void convertAndWrite(size_t offset,
                          const SkImageInfo& srcInfo, const void* src, size_t srcRowBytes,
                          const SkImageInfo& dstInfo, size_t dstRowBytes) {
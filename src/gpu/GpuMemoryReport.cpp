@@ -0,0 +1,89 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/gpu/GpuMemoryReport.h"
+
+#include "include/core/SkString.h"
+#include "include/core/SkTraceMemoryDump.h"
+#include "src/gpu/GpuMemoryReportPriv.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace skgpu {
+
+void AddResourceToReport(GpuMemoryReport* report, const char* type, size_t bytes, bool purgeable,
+                         bool budgeted) {
+    report->fResourceCount += 1;
+    report->fResourceBytes += bytes;
+    report->fPurgeableBytes += purgeable ? bytes : 0;
+    report->fBudgetedBytes += budgeted ? bytes : 0;
+
+    // There are only a handful of types, so a linear search is fine.
+    GpuMemoryReport::ResourceType* entry = nullptr;
+    for (GpuMemoryReport::ResourceType& existing : report->fResourceTypes) {
+        if (!strcmp(existing.fName, type)) {
+            entry = &existing;
+            break;
+        }
+    }
+    if (!entry) {
+        entry = &report->fResourceTypes.emplace_back();
+        entry->fName = type;
+    }
+    entry->fCount += 1;
+    entry->fBytes += bytes;
+    if (purgeable) {
+        entry->fPurgeableCount += 1;
+        entry->fPurgeableBytes += bytes;
+    }
+    entry->fBudgetedBytes += budgeted ? bytes : 0;
+}
+
+void SortReportResourceTypes(GpuMemoryReport* report) {
+    std::stable_sort(report->fResourceTypes.begin(), report->fResourceTypes.end(),
+                     [](const GpuMemoryReport::ResourceType& a,
+                        const GpuMemoryReport::ResourceType& b) { return a.fBytes > b.fBytes; });
+}
+
+void GpuMemoryReport::dumpMemoryStatistics(SkTraceMemoryDump* dump, const char* prefix) const {
+    // None of the values are named "size". The resources are already dumped one by one, and
+    // tracing would count their bytes twice otherwise.
+    dump->dumpNumericValue(prefix, "resource_count", "objects", fResourceCount);
+    dump->dumpNumericValue(prefix, "resource_bytes", "bytes", fResourceBytes);
+    dump->dumpNumericValue(prefix, "purgeable_bytes", "bytes", fPurgeableBytes);
+    dump->dumpNumericValue(prefix, "locked_bytes", "bytes", this->lockedBytes());
+    dump->dumpNumericValue(prefix, "budgeted_bytes", "bytes", fBudgetedBytes);
+    dump->dumpNumericValue(prefix, "budget", "bytes", fBudget);
+    dump->dumpNumericValue(prefix, "scratch_requests", "objects", fScratchRequests);
+    dump->dumpNumericValue(prefix, "scratch_reuses", "objects", fScratchReuses);
+
+    if (dump->getRequestedDetails() != SkTraceMemoryDump::kObjectsBreakdowns_LevelOfDetail) {
+        return;
+    }
+    for (const ResourceType& type : fResourceTypes) {
+        SkString name = SkStringPrintf("%s/types/%s", prefix, type.fName);
+        dump->dumpNumericValue(name.c_str(), "count", "objects", type.fCount);
+        dump->dumpNumericValue(name.c_str(), "bytes", "bytes", type.fBytes);
+        dump->dumpNumericValue(name.c_str(), "purgeable_count", "objects", type.fPurgeableCount);
+        dump->dumpNumericValue(name.c_str(), "purgeable_bytes", "bytes", type.fPurgeableBytes);
+        dump->dumpNumericValue(name.c_str(), "budgeted_bytes", "bytes", type.fBudgetedBytes);
+    }
+    for (const Atlas& atlas : fAtlases) {
+        SkString name = SkStringPrintf("%s/atlases/%s", prefix, atlas.fName);
+        dump->dumpNumericValue(name.c_str(), "active_pages", "objects", atlas.fActivePages);
+        dump->dumpNumericValue(name.c_str(), "max_pages", "objects", atlas.fMaxPages);
+        dump->dumpNumericValue(name.c_str(), "bytes", "bytes", atlas.fBytes);
+        dump->dumpNumericValue(name.c_str(), "plots_in_use", "objects", atlas.fPlotsInUse);
+        dump->dumpNumericValue(name.c_str(), "plots", "objects",
+                               atlas.fActivePages * atlas.fPlotsPerPage);
+        dump->dumpNumericValue(name.c_str(), "occupancy", "percent",
+                               (uint64_t)(atlas.fOccupancy * 100 + 0.5f));
+    }
+}
+
+}  // namespace skgpu
@@ -0,0 +1,27 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef skgpu_GpuMemoryReportPriv_DEFINED
+#define skgpu_GpuMemoryReportPriv_DEFINED
+
+#include "include/gpu/GpuMemoryReport.h"
+
+#include <cstddef>
+
+namespace skgpu {
+
+// Adds a resource to the report's totals and to the entry for its type. 'type' must be a static
+// string, e.g. what getResourceType() returns.
+void AddResourceToReport(GpuMemoryReport*, const char* type, size_t bytes, bool purgeable,
+                         bool budgeted);
+
+// Orders the report's resource types by bytes, most first. Called once all are added.
+void SortReportResourceTypes(GpuMemoryReport*);
+
+} // namespace skgpu
+
+#endif // skgpu_GpuMemoryReportPriv_DEFINED
@@ -25,7 +25,10 @@ namespace skgpu {
 
 class ShaderErrorHandler;
 
-/** Wrapper for the SkSL compiler with useful logging and error handling. */
+/**
+ * Wrapper for the SkSL compiler with useful logging and error handling. Each call uses its own
+ * SkSL::Compiler, so it can be called from several threads at once.
+ */
 bool SkSLToBackend(const SkSL::ShaderCaps* caps,
                    bool (*toBackend)(SkSL::Program&, const SkSL::ShaderCaps*, std::string*),
                    const char* backendLabel,
@@ -19,6 +19,7 @@
 #include "src/core/SkImagePriv.h"
 #include "src/core/SkSamplingPriv.h"
 #include "src/image/SkImage_Base.h"
+#include "src/image/SkTileStreamer.h"
 
 //////////////////////////////////////////////////////////////////////////////
 //  Helper functions for tiling a large SkBitmap
@@ -91,7 +92,9 @@ int draw_tiled_bitmap(SkCanvas* canvas,
                       const SkPaint* paint,
                       SkCanvas::QuadAAFlags origAAFlags,
                       SkCanvas::SrcRectConstraint constraint,
-                      SkSamplingOptions sampling) {
+                      SkSamplingOptions sampling,
+                      size_t cacheSize,
+                      SkTileStreamer* streamer) {
     if (sampling.isAniso()) {
         sampling = SkSamplingPriv::AnisoFallback(/* imageIsMipped= */ false);
     }
@@ -145,45 +148,56 @@ int draw_tiled_bitmap(SkCanvas* canvas,
                                                                   iClampRect);
             }
 
-            // We must subset as a bitmap and then turn it into an SkImage if we want caching to
-            // work. Image subsets always make a copy of the pixels and lose the association with
-            // the original's SkPixelRef.
-            if (SkBitmap subsetBmp; bitmap.extractSubset(&subsetBmp, iTileR)) {
-                sk_sp<SkImage> image = SkMakeImageFromRasterBitmap(subsetBmp,
-                                                                   kNever_SkCopyPixelsMode);
-                if (!image) {
-                    continue;
-                }
+            unsigned aaFlags = SkCanvas::kNone_QuadAAFlags;
+            // Preserve the original edge AA flags for the exterior tile edges.
+            if (tileR.fLeft <= srcRect.fLeft && (origAAFlags & SkCanvas::kLeft_QuadAAFlag)) {
+                aaFlags |= SkCanvas::kLeft_QuadAAFlag;
+            }
+            if (tileR.fRight >= srcRect.fRight && (origAAFlags & SkCanvas::kRight_QuadAAFlag)) {
+                aaFlags |= SkCanvas::kRight_QuadAAFlag;
+            }
+            if (tileR.fTop <= srcRect.fTop && (origAAFlags & SkCanvas::kTop_QuadAAFlag)) {
+                aaFlags |= SkCanvas::kTop_QuadAAFlag;
+            }
+            if (tileR.fBottom >= srcRect.fBottom && (origAAFlags & SkCanvas::kBottom_QuadAAFlag)) {
+                aaFlags |= SkCanvas::kBottom_QuadAAFlag;
+            }
 
-                unsigned aaFlags = SkCanvas::kNone_QuadAAFlags;
-                // Preserve the original edge AA flags for the exterior tile edges.
-                if (tileR.fLeft <= srcRect.fLeft && (origAAFlags & SkCanvas::kLeft_QuadAAFlag)) {
-                    aaFlags |= SkCanvas::kLeft_QuadAAFlag;
-                }
-                if (tileR.fRight >= srcRect.fRight && (origAAFlags & SkCanvas::kRight_QuadAAFlag)) {
-                    aaFlags |= SkCanvas::kRight_QuadAAFlag;
+            sk_sp<SkImage> image;
+            if (streamer && !streamer->admitTile(bitmap, iTileR, cacheSize)) {
+                // Until a later frame uploads the tile, draw its part of the placeholder.
+                image = streamer->placeholderForTile(bitmap);
+                if (image) {
+                    tileR = SkMatrix::Scale(SkIntToScalar(image->width()) / bitmap.width(),
+                                            SkIntToScalar(image->height()) / bitmap.height())
+                                    .mapRect(tileR);
                 }
-                if (tileR.fTop <= srcRect.fTop && (origAAFlags & SkCanvas::kTop_QuadAAFlag)) {
-                    aaFlags |= SkCanvas::kTop_QuadAAFlag;
+            }
+            if (!image) {
+                // We must subset as a bitmap and then turn it into an SkImage if we want caching
+                // to work. Image subsets always make a copy of the pixels and lose the association
+                // with the original's SkPixelRef.
+                SkBitmap subsetBmp;
+                if (!bitmap.extractSubset(&subsetBmp, iTileR)) {
+                    continue;
                 }
-                if (tileR.fBottom >= srcRect.fBottom &&
-                    (origAAFlags & SkCanvas::kBottom_QuadAAFlag)) {
-                    aaFlags |= SkCanvas::kBottom_QuadAAFlag;
+                image = SkMakeImageFromRasterBitmap(subsetBmp, kNever_SkCopyPixelsMode);
+                if (!image) {
+                    continue;
                 }
-
                 // Offset the source rect to make it "local" to our tmp bitmap
                 tileR.offset(-offset.fX, -offset.fY);
+            }
 
-                imgSet.push_back(SkCanvas::ImageSetEntry(std::move(image),
-                                                         tileR,
-                                                         rectToDraw,
-                                                         /* matrixIndex= */ -1,
-                                                         /* alpha= */ 1.0f,
-                                                         aaFlags,
-                                                         /* hasClip= */ false));
+            imgSet.push_back(SkCanvas::ImageSetEntry(std::move(image),
+                                                     tileR,
+                                                     rectToDraw,
+                                                     /* matrixIndex= */ -1,
+                                                     /* alpha= */ 1.0f,
+                                                     aaFlags,
+                                                     /* hasClip= */ false));
 
-                numTilesDrawn += 1;
-            }
+            numTilesDrawn += 1;
         }
     }
 
@@ -363,7 +377,8 @@ std::tuple<bool, size_t> TiledTextureUtils::DrawAsTiledImageRect(
         const SkPaint* paint,
         SkCanvas::SrcRectConstraint constraint,
         size_t cacheSize,
-        size_t maxTextureSize) {
+        size_t maxTextureSize,
+        SkTiledImageUtils::TileStreamer* streamer) {
     if (canvas->isClipEmpty()) {
         return {true, 0};
     }
@@ -429,7 +444,9 @@ std::tuple<bool, size_t> TiledTextureUtils::DrawAsTiledImageRect(
                                                  paint,
                                                  aaFlags,
                                                  constraint,
-                                                 sampling);
+                                                 sampling,
+                                                 cacheSize,
+                                                 static_cast<SkTileStreamer*>(streamer));
                 return {true, tiles};
             }
         }
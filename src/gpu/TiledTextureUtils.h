@@ -23,6 +23,10 @@ class SkPaint;
 struct SkRect;
 struct SkSamplingOptions;
 
+namespace SkTiledImageUtils {
+class TileStreamer;
+}
+
 namespace skgpu {
 
 class TiledTextureUtils {
@@ -70,7 +74,8 @@ public:
                                                          const SkPaint*,
                                                          SkCanvas::SrcRectConstraint,
                                                          size_t cacheSize,
-                                                         size_t maxTextureSize);
+                                                         size_t maxTextureSize,
+                                                         SkTiledImageUtils::TileStreamer*);
 };
 
 } // namespace skgpu
@@ -23,6 +23,7 @@
 #include "src/gpu/ganesh/GrProxyProvider.h"
 #include "src/gpu/ganesh/GrRecordingContextPriv.h"
 #include "src/gpu/ganesh/GrSWMaskHelper.h"
+#include "src/gpu/ganesh/SkGr.h"
 #include "src/gpu/ganesh/StencilMaskHelper.h"
 #include "src/gpu/ganesh/SurfaceDrawContext.h"
 #include "src/gpu/ganesh/effects/GrBlendFragmentProcessor.h"
@@ -309,6 +310,71 @@ void draw_to_sw_mask(GrSWMaskHelper* helper,
     }
 }
 
+// Keys a SW mask by what is drawn into it. A save record's gen ID is new every time the clip is
+// rebuilt, so a clip that is set the same way on every frame would otherwise render the same mask
+// again each time. Returns an invalid key if an element can't be keyed by its contents.
+skgpu::UniqueKey make_content_key(const SkIRect& bounds,
+                                  const skgpu::ganesh::ClipStack::Element** elements,
+                                  int count) {
+    int keySize = 4;
+    for (int i = 0; i < count; ++i) {
+        const GrShape& shape = elements[i]->fShape;
+        keySize += 2 + 9;  // shape state, op and AA, matrix
+        switch (shape.type()) {
+            case GrShape::Type::kRect:
+                keySize += 4;
+                break;
+            case GrShape::Type::kRRect:
+                keySize += SkRRect::kSizeInMemory / sizeof(uint32_t);
+                break;
+            case GrShape::Type::kPath:
+                if (shape.path().isVolatile()) {
+                    return {};
+                }
+                keySize += 1;
+                break;
+            default:
+                return {};
+        }
+    }
+
+    static const skgpu::UniqueKey::Domain kDomain = skgpu::UniqueKey::GenerateDomain();
+    skgpu::UniqueKey key;
+    skgpu::UniqueKey::Builder builder(&key, kDomain, keySize, "clip_mask_content");
+    int k = 0;
+    builder[k++] = bounds.fLeft;
+    builder[k++] = bounds.fTop;
+    builder[k++] = bounds.fRight;
+    builder[k++] = bounds.fBottom;
+    for (int i = 0; i < count; ++i) {
+        const skgpu::ganesh::ClipStack::Element& e = *elements[i];
+        builder[k++] = e.fShape.stateKey();
+        builder[k++] = (static_cast<uint32_t>(e.fOp) << 1) | (e.fAA == GrAA::kYes);
+        SkScalar m[9];
+        e.fLocalToDevice.get9(m);
+        memcpy(&builder[k], m, sizeof(m));
+        k += 9;
+        switch (e.fShape.type()) {
+            case GrShape::Type::kRect:
+                memcpy(&builder[k], &e.fShape.rect(), sizeof(SkRect));
+                k += 4;
+                break;
+            case GrShape::Type::kRRect:
+                e.fShape.rrect().writeToMemory(&builder[k]);
+                k += SkRRect::kSizeInMemory / sizeof(uint32_t);
+                break;
+            case GrShape::Type::kPath:
+                builder[k++] = e.fShape.path().getGenerationID();
+                break;
+            default:
+                SkUNREACHABLE;
+        }
+    }
+    SkASSERT(k == keySize);
+    builder.finish();
+    return key;
+}
+
 GrSurfaceProxyView render_sw_mask(GrRecordingContext* context,
                                   const SkIRect& bounds,
                                   const skgpu::ganesh::ClipStack::Element** elements,
@@ -751,14 +817,22 @@ ClipStack::ClipState ClipStack::RawElement::clipType() const {
 ///////////////////////////////////////////////////////////////////////////////
 // ClipStack::Mask
 
-ClipStack::Mask::Mask(const SaveRecord& current, const SkIRect& drawBounds)
+ClipStack::Mask::Mask(const SaveRecord& current, const SkIRect& drawBounds,
+                      const UniqueKey& contentKey)
         : fBounds(drawBounds)
-        , fGenID(current.genID()) {
+        , fGenID(current.genID())
+        , fContentKeyed(contentKey.isValid()) {
     static const UniqueKey::Domain kDomain = UniqueKey::GenerateDomain();
 
     // The gen ID should not be invalid, empty, or wide open, since those do not require masks
     SkASSERT(fGenID != kInvalidGenID && fGenID != kEmptyGenID && fGenID != kWideOpenGenID);
 
+    SkDEBUGCODE(fOwner = &current;)
+    if (fContentKeyed) {
+        fKey = contentKey;
+        return;
+    }
+
     UniqueKey::Builder builder(&fKey, kDomain, 5, "clip_mask");
     builder[0] = fGenID;
     builder[1] = drawBounds.fLeft;
@@ -766,8 +840,6 @@ ClipStack::Mask::Mask(const SaveRecord& current, const SkIRect& drawBounds)
     builder[3] = drawBounds.fTop;
     builder[4] = drawBounds.fBottom;
     SkASSERT(fKey.isValid());
-
-    SkDEBUGCODE(fOwner = &current;)
 }
 
 bool ClipStack::Mask::appliesToDraw(const SaveRecord& current, const SkIRect& drawBounds) const {
@@ -780,8 +852,12 @@ bool ClipStack::Mask::appliesToDraw(const SaveRecord& current, const SkIRect& dr
 void ClipStack::Mask::invalidate(GrProxyProvider* proxyProvider) {
     SkASSERT(proxyProvider);
     SkASSERT(fKey.isValid()); // Should only be invalidated once
-    proxyProvider->processInvalidUniqueKey(
-            fKey, nullptr, GrProxyProvider::InvalidateGPUResource::kYes);
+    // A content-keyed mask stays in the resource cache for later frames. It goes away when one of
+    // its paths changes or the cache purges it.
+    if (!fContentKeyed) {
+        proxyProvider->processInvalidUniqueKey(
+                fKey, nullptr, GrProxyProvider::InvalidateGPUResource::kYes);
+    }
     fKey.reset();
 }
 
@@ -1626,17 +1702,41 @@ GrFPResult ClipStack::GetSWMaskFP(GrRecordingContext* context, Mask::Stack* mask
     }
 
     if (!maskProxy) {
-        // No existing mask was found, so need to render a new one
-        maskProxy = render_sw_mask(context, bounds, elements, count);
-        if (!maskProxy) {
-            // If we still don't have one, there's nothing we can do
-            return GrFPFailure(std::move(clipFP));
+        // A previous frame may have rendered a mask from the same elements.
+        UniqueKey contentKey = make_content_key(bounds, elements, count);
+        if (contentKey.isValid()) {
+            maskProxy = proxyProvider->findCachedProxyWithColorTypeFallback(
+                    contentKey, kMaskOrigin, GrColorType::kAlpha_8, 1);
+            if (maskProxy) {
+                masks->emplace_back(current, bounds, contentKey);
+                maskBounds = bounds;
+            }
         }
 
-        // Register the mask for later invalidation
-        Mask& mask = masks->emplace_back(current, bounds);
-        proxyProvider->assignUniqueKeyToProxy(mask.key(), maskProxy.asTextureProxy());
-        maskBounds = bounds;
+        if (!maskProxy) {
+            // No existing mask was found, so need to render a new one
+            maskProxy = render_sw_mask(context, bounds, elements, count);
+            if (!maskProxy) {
+                // If we still don't have one, there's nothing we can do
+                return GrFPFailure(std::move(clipFP));
+            }
+
+            if (contentKey.isValid()) {
+                // Drop the mask once any of its paths change.
+                auto listener = GrMakeUniqueKeyInvalidationListener(&contentKey,
+                                                                    proxyProvider->contextID());
+                for (int i = 0; i < count; ++i) {
+                    if (elements[i]->fShape.isPath()) {
+                        SkPathPriv::AddGenIDChangeListener(elements[i]->fShape.path(), listener);
+                    }
+                }
+            }
+
+            // Register the mask for later invalidation
+            Mask& mask = masks->emplace_back(current, bounds, contentKey);
+            proxyProvider->assignUniqueKeyToProxy(mask.key(), maskProxy.asTextureProxy());
+            maskBounds = bounds;
+        }
     }
 
     // Wrap the mask in an FP that samples it for coverage
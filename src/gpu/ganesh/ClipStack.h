@@ -184,7 +184,10 @@ private:
     public:
         using Stack = SkTBlockList<Mask, 1>;
 
-        Mask(const SaveRecord& current, const SkIRect& bounds);
+        // If contentKey is valid, the mask is keyed by the elements drawn into it instead of by
+        // the save record, and outlives the record so a later frame can reuse it.
+        Mask(const SaveRecord& current, const SkIRect& bounds,
+             const UniqueKey& contentKey = UniqueKey());
 
         ~Mask() {
             // The key should have been released by the clip stack before hand
@@ -207,6 +210,7 @@ private:
         // Repeatedly querying an unmodified save record with the same bounds is idempotent.
         SkIRect     fBounds;
         uint32_t    fGenID;
+        bool        fContentKeyed;
 
         SkDEBUGCODE(const SaveRecord* fOwner;)
     };
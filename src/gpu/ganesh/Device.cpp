@@ -1003,7 +1003,8 @@ bool Device::drawAsTiledImageRect(SkCanvas* canvas,
                                   const SkRect& dst,
                                   const SkSamplingOptions& sampling,
                                   const SkPaint& paint,
-                                  SkCanvas::SrcRectConstraint constraint) {
+                                  SkCanvas::SrcRectConstraint constraint,
+                                  SkTiledImageUtils::TileStreamer* streamer) {
     GrRecordingContext* rCtx = canvas->recordingContext();
     if (!rCtx) {
         return false;
@@ -1040,7 +1041,8 @@ bool Device::drawAsTiledImageRect(SkCanvas* canvas,
             &paint,
             constraint,
             cacheSize,
-            maxTextureSize);
+            maxTextureSize,
+            streamer);
 #if defined(GR_TEST_UTILS)
     gNumTilesDrawnGanesh.store(numTiles, std::memory_order_relaxed);
 #endif
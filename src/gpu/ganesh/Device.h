@@ -206,7 +206,8 @@ public:
                               const SkRect& dst,
                               const SkSamplingOptions&,
                               const SkPaint&,
-                              SkCanvas::SrcRectConstraint) override;
+                              SkCanvas::SrcRectConstraint,
+                              SkTiledImageUtils::TileStreamer*) override;
     void drawImageLattice(const SkImage*, const SkCanvas::Lattice&,
                           const SkRect& dst, SkFilterMode, const SkPaint&) override;
 
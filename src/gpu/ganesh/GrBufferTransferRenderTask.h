@@ -36,9 +36,7 @@ private:
     }
     bool onExecute(GrOpFlushState*) override;
 
-#if defined(GR_TEST_UTILS)
     const char* name() const final { return "BufferTransfer"; }
-#endif
 #ifdef SK_DEBUG
     void visitProxies_debugOnly(const GrVisitProxyFunc&) const override {}
 #endif
@@ -28,9 +28,7 @@ private:
     }
     bool onExecute(GrOpFlushState*) override;
 
-#if defined(GR_TEST_UTILS)
     const char* name() const final { return "BufferUpdate"; }
-#endif
 #ifdef SK_DEBUG
     void visitProxies_debugOnly(const GrVisitProxyFunc&) const override {}
 #endif
@@ -7,6 +7,68 @@
 
 #include "src/gpu/ganesh/GrClientMappedBufferManager.h"
 
+#include "src/gpu/ganesh/GrGpuResourcePriv.h"
+#include "src/gpu/ganesh/GrResourceProvider.h"
+
+#include <utility>
+
+void GrClientMappedBufferManager::process() {
+    this->TClientMappedBufferManager::process([this](sk_sp<GrGpuBuffer> buffer) {
+        this->recycle(std::move(buffer));
+    });
+}
+
+void GrClientMappedBufferManager::recycle(sk_sp<GrGpuBuffer> buffer) {
+    SkASSERT(!buffer->isMapped());
+    static const skgpu::UniqueKey::Domain kDomain = skgpu::UniqueKey::GenerateDomain();
+
+    RecycledBuffer recycled;
+    skgpu::UniqueKey::Builder builder(&recycled.fKey, kDomain, 1, "RecycledTransferBuffer");
+    builder[0] = fNextRecycledBufferID++;
+    builder.finish();
+    recycled.fSize = buffer->size();
+    fResourceProvider->assignUniqueKeyToResource(recycled.fKey, buffer.get());
+
+    if (fRecycledBuffers.size() < kMaxRecycledBuffers) {
+        fRecycledBuffers.push_back(std::move(recycled));
+    } else {
+        this->dropRecycledBuffer(fRecycledBuffers[fNextRecycledBuffer]);
+        fRecycledBuffers[fNextRecycledBuffer] = std::move(recycled);
+        fNextRecycledBuffer = (fNextRecycledBuffer + 1) % kMaxRecycledBuffers;
+    }
+}
+
+sk_sp<GrGpuBuffer> GrClientMappedBufferManager::takeRecycledBuffer(size_t minSize) {
+    while (true) {
+        int best = -1;
+        for (int i = 0; i < fRecycledBuffers.size(); ++i) {
+            size_t size = fRecycledBuffers[i].fSize;
+            if (size >= minSize && (best < 0 || size < fRecycledBuffers[best].fSize)) {
+                best = i;
+            }
+        }
+        if (best < 0) {
+            return nullptr;
+        }
+        sk_sp<GrGpuBuffer> buffer =
+                fResourceProvider->findByUniqueKey<GrGpuBuffer>(fRecycledBuffers[best].fKey);
+        fRecycledBuffers.removeShuffle(best);
+        fNextRecycledBuffer = 0;
+        // A buffer the cache has purged is forgotten, and the next best one is tried.
+        if (buffer) {
+            buffer->resourcePriv().removeUniqueKey();
+            return buffer;
+        }
+    }
+}
+
+void GrClientMappedBufferManager::dropRecycledBuffer(const RecycledBuffer& recycled) {
+    auto buffer = fResourceProvider->findByUniqueKey<GrGpuBuffer>(recycled.fKey);
+    if (buffer) {
+        buffer->resourcePriv().removeUniqueKey();
+    }
+}
+
 //////////////////////////////////////////////////////////////////////////////
 
 DECLARE_SKMESSAGEBUS_MESSAGE(GrClientMappedBufferManager::BufferFinishedMessage,
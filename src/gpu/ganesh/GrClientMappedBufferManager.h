@@ -9,15 +9,55 @@
 #define GrClientMappedBufferManager_DEFINED
 
 #include "include/gpu/GrDirectContext.h"
+#include "include/private/base/SkTArray.h"
 #include "src/gpu/AsyncReadTypes.h"
+#include "src/gpu/ResourceKey.h"
 #include "src/gpu/ganesh/GrGpuBuffer.h"
 
+#include <cstddef>
+#include <cstdint>
+
+class GrResourceProvider;
+
 // This is declared as a class rather than an alias to allow for forward declarations
 class GrClientMappedBufferManager :
         public skgpu::TClientMappedBufferManager<GrGpuBuffer, GrDirectContext::DirectContextID> {
 public:
-    GrClientMappedBufferManager(GrDirectContext::DirectContextID ownerID)
-            : TClientMappedBufferManager(ownerID) {}
+    GrClientMappedBufferManager(GrDirectContext::DirectContextID ownerID,
+                                GrResourceProvider* resourceProvider)
+            : TClientMappedBufferManager(ownerID), fResourceProvider(resourceProvider) {}
+
+    /** Poll for messages and unmap any incoming buffers, recycling the recyclable ones. */
+    void process();
+
+    /**
+     * Keeps an unmapped transfer buffer for takeRecycledBuffer(). Only its key is kept, so until
+     * then the buffer is purgeable, and the resource cache purges it like any other resource to
+     * stay within budget or once it has gone unused.
+     */
+    void recycle(sk_sp<GrGpuBuffer>);
+
+    /**
+     * Returns the smallest recycled buffer of at least 'minSize' bytes that the resource cache
+     * has not purged, or null if there is none.
+     */
+    sk_sp<GrGpuBuffer> takeRecycledBuffer(size_t minSize);
+
+private:
+    static constexpr int kMaxRecycledBuffers = 4;
+
+    struct RecycledBuffer {
+        skgpu::UniqueKey fKey;
+        size_t fSize;
+    };
+
+    // Lets go of a recycled buffer, which is then freed unless something else uses it.
+    void dropRecycledBuffer(const RecycledBuffer&);
+
+    GrResourceProvider* fResourceProvider;
+    skia_private::STArray<kMaxRecycledBuffers, RecycledBuffer> fRecycledBuffers;
+    int fNextRecycledBuffer = 0;
+    uint32_t fNextRecycledBufferID = 0;
 };
 
 bool SkShouldPostMessageToBus(const GrClientMappedBufferManager::BufferFinishedMessage&,
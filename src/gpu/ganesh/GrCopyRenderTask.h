@@ -41,9 +41,7 @@ private:
     ExpectedOutcome onMakeClosed(GrRecordingContext*, SkIRect* targetUpdateBounds) override;
     bool onExecute(GrOpFlushState*) override;
 
-#if defined(GR_TEST_UTILS)
     const char* name() const final { return "Copy"; }
-#endif
 #ifdef SK_DEBUG
     void visitProxies_debugOnly(const GrVisitProxyFunc& func) const override {
         func(fSrc.get(), skgpu::Mipmapped::kNo);
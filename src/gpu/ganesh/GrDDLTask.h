@@ -54,12 +54,13 @@ private:
 
     bool onExecute(GrOpFlushState*) override;
 
+    const char* name() const final { return "DDL"; }
+
 #if defined(GR_TEST_UTILS)
     void dump(const SkString& label,
               SkString indent,
               bool printDependencies,
               bool close) const final;
-    const char* name() const final { return "DDL"; }
 #endif
 #ifdef SK_DEBUG
     void visitProxies_debugOnly(const GrVisitProxyFunc&) const override {}
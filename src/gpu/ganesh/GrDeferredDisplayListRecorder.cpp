@@ -8,6 +8,9 @@
 #include "include/private/chromium/GrDeferredDisplayListRecorder.h"
 
 #include "include/core/SkCanvas.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkPicture.h"
+#include "include/core/SkRect.h"
 #include "include/core/SkSurface.h"
 #include "include/gpu/GpuTypes.h"
 #include "include/gpu/GrRecordingContext.h"
@@ -16,6 +19,7 @@
 #include "include/private/chromium/GrDeferredDisplayList.h"
 #include "include/private/chromium/GrSurfaceCharacterization.h"
 #include "include/private/gpu/ganesh/GrTypesPriv.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/gpu/SkBackingFit.h"
 #include "src/gpu/ganesh/Device.h"
 #include "src/gpu/ganesh/GrCaps.h"
@@ -203,3 +207,54 @@ sk_sp<GrDeferredDisplayList> GrDeferredDisplayListRecorder::detach() {
     fSurface = nullptr;
     return ddl;
 }
+
+std::vector<sk_sp<GrDeferredDisplayList>> GrDeferredDisplayListRecorder::RecordTiled(
+        const SkPicture* picture,
+        const GrSurfaceCharacterization& characterization,
+        SkISize tileSize,
+        SkExecutor* executor) {
+    if (!picture || !characterization.isValid() || tileSize.isEmpty()) {
+        return {};
+    }
+
+    const SkISize dimensions = characterization.dimensions();
+    const int numXTiles = (dimensions.width() + tileSize.width() - 1) / tileSize.width();
+    const int numYTiles = (dimensions.height() + tileSize.height() - 1) / tileSize.height();
+    std::vector<sk_sp<GrDeferredDisplayList>> ddls(numXTiles * numYTiles);
+
+    // Each tile is recorded for the whole surface, but clipped to its own part of it. That lets
+    // the tiles be drawn straight into the surface, rather than into textures of their own that
+    // then have to be composed into it.
+    auto recordTile = [&](int i) {
+        SkIRect tile = SkIRect::MakeXYWH((i % numXTiles) * tileSize.width(),
+                                         (i / numXTiles) * tileSize.height(),
+                                         tileSize.width(),
+                                         tileSize.height());
+        SkAssertResult(tile.intersect(SkIRect::MakeSize(dimensions)));
+
+        GrDeferredDisplayListRecorder recorder(characterization);
+        SkCanvas* canvas = recorder.getCanvas();
+        if (!canvas) {
+            return;
+        }
+        canvas->clipIRect(tile);
+        canvas->drawPicture(picture);
+        ddls[i] = recorder.detach();
+    };
+
+    if (executor) {
+        SkTaskGroup taskGroup(*executor);
+        taskGroup.batch(SkToInt(ddls.size()), recordTile);
+        taskGroup.wait();
+    } else {
+        for (int i = 0; i < SkToInt(ddls.size()); ++i) {
+            recordTile(i);
+        }
+    }
+
+    // A tile fails to record only if its characterization does, which would fail them all.
+    if (!ddls[0]) {
+        return {};
+    }
+    return ddls;
+}
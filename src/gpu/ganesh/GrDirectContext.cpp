@@ -12,10 +12,12 @@
 #include "include/core/SkSurface.h"
 #include "include/core/SkTextureCompressionType.h"
 #include "include/core/SkTraceMemoryDump.h"
+#include "include/gpu/GpuMemoryReport.h"
 #include "include/gpu/GpuTypes.h"
 #include "include/gpu/GrBackendSemaphore.h"
 #include "include/gpu/GrBackendSurface.h"
 #include "include/gpu/GrContextThreadSafeProxy.h"
+#include "include/gpu/ganesh/GrPerfStats.h"
 #include "include/private/base/SingleOwner.h"
 #include "include/private/base/SkTArray.h"
 #include "include/private/base/SkTemplates.h"
@@ -39,6 +41,7 @@
 #include "src/gpu/ganesh/GrDrawOpAtlas.h"
 #include "src/gpu/ganesh/GrDrawingManager.h"
 #include "src/gpu/ganesh/GrGpu.h"
+#include "src/gpu/ganesh/GrPerfStatsRecorder.h"
 #include "src/gpu/ganesh/GrPixmap.h"
 #include "src/gpu/ganesh/GrProxyProvider.h"
 #include "src/gpu/ganesh/GrRenderTargetProxy.h"
@@ -50,6 +53,7 @@
 #include "src/gpu/ganesh/GrSurfaceProxyView.h"
 #include "src/gpu/ganesh/GrThreadSafePipelineBuilder.h" // IWYU pragma: keep
 #include "src/gpu/ganesh/SurfaceContext.h"
+#include "src/gpu/ganesh/SurfaceFillContext.h"
 #include "src/gpu/ganesh/image/SkImage_GaneshBase.h"
 #include "src/gpu/ganesh/mock/GrMockGpu.h"
 #include "src/gpu/ganesh/ops/SmallPathAtlasMgr.h"
@@ -268,7 +272,8 @@ bool GrDirectContext::init() {
 #endif
     fResourceProvider = std::make_unique<GrResourceProvider>(fGpu.get(), fResourceCache.get(),
                                                              this->singleOwner());
-    fMappedBufferManager = std::make_unique<GrClientMappedBufferManager>(this->directContextID());
+    fMappedBufferManager = std::make_unique<GrClientMappedBufferManager>(this->directContextID(),
+                                                                         fResourceProvider.get());
 
     fDidTestPMConversions = false;
 
@@ -376,6 +381,15 @@ void GrDirectContext::performDeferredCleanup(std::chrono::milliseconds msNotUsed
     fResourceCache->purgeAsNeeded();
     fResourceCache->purgeResourcesNotUsedSince(purgeTime, opts);
 
+    // Atlas pages are only drained slowly at flush time, so while the client is idle we also
+    // pack their live contents into as few pages as they fit in.
+    fAtlasManager->compactIdle();
+#if !defined(SK_ENABLE_OPTIMIZE_SIZE)
+    if (fSmallPathAtlasMgr) {
+        fSmallPathAtlasMgr->compactIdle();
+    }
+#endif
+
     // The textBlob Cache doesn't actually hold any GPU resource but this is a convenient
     // place to purge stale blobs
     this->getTextBlobRedrawCoordinator()->purgeStaleBlobs();
@@ -455,6 +469,7 @@ bool GrDirectContext::submit(GrSyncCpu sync) {
         return false;
     }
 
+    fResourceCache->notifyFrameSubmitted();
     return fGpu->submitToGpu(sync);
 }
 
@@ -528,6 +543,38 @@ void GrDirectContext::flush(SkSurface* surface) {
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void GrDirectContext::asyncReadPixelsBatch(SkSpan<const ReadPixelsRequest> requests,
+                                           SkColorType colorType,
+                                           SkImage::ReadPixelsCallback callback,
+                                           SkImage::ReadPixelsContext context) {
+    ASSERT_SINGLE_OWNER
+    if (this->abandoned()) {
+        callback(context, nullptr);
+        return;
+    }
+
+    STArray<8, skgpu::ganesh::SurfaceContext*> surfaceContexts;
+    STArray<8, SkIRect> rects;
+    for (const ReadPixelsRequest& request : requests) {
+        if (!request.fSurface || !asSB(request.fSurface)->isGaneshBacked() ||
+            !SkIRect::MakeSize(request.fSurface->imageInfo().dimensions())
+                     .contains(request.fRect) ||
+            request.fRect.isEmpty()) {
+            callback(context, nullptr);
+            return;
+        }
+        auto gs = static_cast<SkSurface_Ganesh*>(request.fSurface);
+        if (!this->priv().matches(gs->getDevice()->recordingContext())) {
+            callback(context, nullptr);
+            return;
+        }
+        surfaceContexts.push_back(gs->getDevice()->surfaceFillContext());
+        rects.push_back(request.fRect);
+    }
+    skgpu::ganesh::SurfaceContext::AsyncReadPixelsBatch(
+            this, surfaceContexts, rects, colorType, callback, context);
+}
+
 void GrDirectContext::checkAsyncWorkCompletion() {
     if (fGpu) {
         fGpu->checkFinishProcs();
@@ -557,11 +604,38 @@ bool GrDirectContext::supportsDistanceFieldText() const {
 
 //////////////////////////////////////////////////////////////////////////////
 
+void GrDirectContext::getPerfStats(GrPerfStats* stats) {
+    ASSERT_SINGLE_OWNER
+    *stats = {};
+    if (this->abandoned() || !fGpu->perfStats()) {
+        return;
+    }
+    fGpu->perfStats()->getStats(stats);
+}
+
 void GrDirectContext::dumpMemoryStatistics(SkTraceMemoryDump* traceMemoryDump) const {
     ASSERT_SINGLE_OWNER
     fResourceCache->dumpMemoryStatistics(traceMemoryDump);
     traceMemoryDump->dumpNumericValue("skia/gr_text_blob_cache", "size", "bytes",
                                       this->getTextBlobRedrawCoordinator()->usedBytes());
+
+    skgpu::GpuMemoryReport report;
+    this->getMemoryReport(&report);
+    report.dumpMemoryStatistics(traceMemoryDump, "skia/gpu_memory_report");
+}
+
+void GrDirectContext::getMemoryReport(skgpu::GpuMemoryReport* report) const {
+    ASSERT_SINGLE_OWNER
+    *report = {};
+    fResourceCache->addToMemoryReport(report);
+    if (fAtlasManager) {
+        fAtlasManager->addToMemoryReport(report);
+    }
+#if !defined(SK_ENABLE_OPTIMIZE_SIZE)
+    if (fSmallPathAtlasMgr) {
+        fSmallPathAtlasMgr->addToMemoryReport(report);
+    }
+#endif
 }
 
 GrBackendTexture GrDirectContext::createBackendTexture(int width,
@@ -9,6 +9,7 @@
 
 #include <memory>
 
+#include "include/gpu/GpuMemoryReport.h"
 #include "include/private/base/SkTPin.h"
 #include "src/gpu/ganesh/GrBackendUtils.h"
 #include "src/gpu/ganesh/GrCaps.h"
@@ -459,6 +460,77 @@ void GrDrawOpAtlas::compact(AtlasToken startTokenForNextFlush) {
     fPrevFlushToken = startTokenForNextFlush;
 }
 
+void GrDrawOpAtlas::addToMemoryReport(const char* name, skgpu::GpuMemoryReport* report) const {
+    skgpu::GpuMemoryReport::Atlas& atlas = report->fAtlases.emplace_back();
+    atlas.fName = name;
+    atlas.fActivePages = fNumActivePages;
+    atlas.fMaxPages = fMaxPages;
+    atlas.fBytes = fNumActivePages * fTextureWidth * fTextureHeight * fBytesPerPixel;
+    atlas.fPlotsPerPage = fNumPlots;
+    // The plots are all the same size, so their mean fullness is the pages' occupancy.
+    float fullness = 0;
+    for (uint32_t pageIndex = 0; pageIndex < fNumActivePages; ++pageIndex) {
+        for (uint32_t plotIndex = 0; plotIndex < fNumPlots; ++plotIndex) {
+            const float plotFullness = fPages[pageIndex].fPlotArray[plotIndex]->percentFull();
+            atlas.fPlotsInUse += plotFullness > 0;
+            fullness += plotFullness;
+        }
+    }
+    atlas.fOccupancy = fNumActivePages ? fullness / (fNumActivePages * fNumPlots) : 0;
+}
+
+void GrDrawOpAtlas::compactIdle() {
+    // Between flushes no op is holding on to a plot, so the live plots of the last page can be
+    // evicted whenever earlier pages have room for them. Their entries are added again, packed
+    // into earlier pages, the next time they are drawn, and those that are not drawn again are
+    // gone for good. Each page emptied this way is released.
+    while (fNumActivePages > 1) {
+        uint32_t lastPageIndex = fNumActivePages - 1;
+        PlotList::Iter plotIter;
+
+        TArray<Plot*> availablePlots;
+        for (uint32_t pageIndex = 0; pageIndex < lastPageIndex; ++pageIndex) {
+            plotIter.init(fPages[pageIndex].fPlotList, PlotList::Iter::kHead_IterStart);
+            while (Plot* plot = plotIter.get()) {
+                if (plot->flushesSinceLastUsed() > kPlotRecentlyUsedCount) {
+                    availablePlots.push_back(plot);
+                }
+                plotIter.next();
+            }
+        }
+
+        TArray<Plot*> usedPlots;
+        int recentlyUsedPlots = 0;
+        plotIter.init(fPages[lastPageIndex].fPlotList, PlotList::Iter::kHead_IterStart);
+        while (Plot* plot = plotIter.get()) {
+            if (plot->lastUseToken() != AtlasToken::InvalidToken()) {
+                usedPlots.push_back(plot);
+                if (plot->flushesSinceLastUsed() <= kPlotRecentlyUsedCount) {
+                    ++recentlyUsedPlots;
+                }
+            }
+            plotIter.next();
+        }
+        if (recentlyUsedPlots > availablePlots.size()) {
+            break;
+        }
+
+        for (Plot* plot : usedPlots) {
+            if (plot->flushesSinceLastUsed() <= kPlotRecentlyUsedCount) {
+                this->processEvictionAndResetRects(availablePlots.back());
+                availablePlots.pop_back();
+            }
+            this->processEvictionAndResetRects(plot);
+        }
+
+        if constexpr (kDumpAtlasData) {
+            SkDebugf("idle delete %u\n", lastPageIndex);
+        }
+        this->deactivateLastPage();
+        fFlushesSinceLastUse = 0;
+    }
+}
+
 bool GrDrawOpAtlas::createPages(
         GrProxyProvider* proxyProvider, GenerationCounter* generationCounter) {
     SkASSERT(SkIsPow2(fTextureWidth) && SkIsPow2(fTextureHeight));
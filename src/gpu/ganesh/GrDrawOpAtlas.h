@@ -23,6 +23,8 @@ class GrProxyProvider;
 class GrResourceProvider;
 class GrTextureProxy;
 
+namespace skgpu { struct GpuMemoryReport; }
+
 /**
  * This class manages one or more atlas textures on behalf of GrDrawOps. The draw ops that use the
  * atlas perform texture uploads when preparing their draws during flush. The class provides
@@ -48,7 +50,8 @@ class GrTextureProxy;
  * Garbage collection is initiated by the GrDrawOpAtlas's client via the compact() method. One
  * solution is to make the client a subclass of GrOnFlushCallbackObject, register it with the
  * GrContext via addOnFlushCallbackObject(), and the client's postFlush() method calls compact()
- * and passes in the given GrDrawUploadToken.
+ * and passes in the given GrDrawUploadToken. When the client is idle it may also call
+ * compactIdle() to release pages all at once rather than waiting for them to drain.
  */
 class GrDrawOpAtlas {
 public:
@@ -156,12 +159,22 @@ public:
 
     void compact(skgpu::AtlasToken startTokenForNextFlush);
 
+    /**
+     * Unlike compact(), which only drains the last page a little at each flush, this empties and
+     * releases as many trailing pages as the plots that have aged out of earlier pages can take
+     * the live plots of. It must be called between flushes, for instance when the client is idle.
+     */
+    void compactIdle();
+
     void instantiate(GrOnFlushResourceProvider*);
 
     uint32_t maxPages() const {
         return fMaxPages;
     }
 
+    /** Adds the atlas's page count and occupancy to 'report', as the atlas called 'name'. */
+    void addToMemoryReport(const char* name, skgpu::GpuMemoryReport* report) const;
+
 private:
     friend class GrDrawOpAtlasTools;
 
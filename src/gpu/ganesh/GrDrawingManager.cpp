@@ -15,6 +15,8 @@
 #include "include/gpu/GrRecordingContext.h"
 #include "include/private/chromium/GrDeferredDisplayList.h"
 #include "src/base/SkTInternalLList.h"
+#include "src/base/SkTime.h"
+#include "src/core/SkDrawStatsSink.h"
 #include "src/gpu/ganesh/GrBufferTransferRenderTask.h"
 #include "src/gpu/ganesh/GrBufferUpdateRenderTask.h"
 #include "src/gpu/ganesh/GrClientMappedBufferManager.h"
@@ -27,6 +29,7 @@
 #include "src/gpu/ganesh/GrNativeRect.h"
 #include "src/gpu/ganesh/GrOnFlushResourceProvider.h"
 #include "src/gpu/ganesh/GrOpFlushState.h"
+#include "src/gpu/ganesh/GrPerfStatsRecorder.h"
 #include "src/gpu/ganesh/GrRecordingContextPriv.h"
 #include "src/gpu/ganesh/GrRenderTargetProxy.h"
 #include "src/gpu/ganesh/GrRenderTask.h"
@@ -241,14 +244,26 @@ bool GrDrawingManager::executeRenderTasks(GrOpFlushState* flushState) {
 
     bool anyRenderTasksExecuted = false;
 
-    for (const auto& renderTask : fDAG) {
+    // When the context collects GrPerfStats we time each task's prepare and execute.
+    GrPerfStatsRecorder* perfStats = flushState->gpu()->perfStats();
+    skia_private::TArray<double> prepareMs;
+    if (perfStats) {
+        prepareMs.push_back_n(fDAG.size(), 0.0);
+    }
+
+    for (int i = 0; i < fDAG.size(); ++i) {
+        const sk_sp<GrRenderTask>& renderTask = fDAG[i];
         if (!renderTask || !renderTask->isInstantiated()) {
              continue;
         }
 
         SkASSERT(renderTask->deferredProxiesAreInstantiated());
 
+        double startNanos = perfStats ? SkTime::GetNSecs() : 0;
         renderTask->prepare(flushState);
+        if (perfStats) {
+            prepareMs[i] = (SkTime::GetNSecs() - startNanos) * 1e-6;
+        }
     }
 
     // Upload all data to the GPU
@@ -263,15 +278,26 @@ bool GrDrawingManager::executeRenderTasks(GrOpFlushState* flushState) {
     int numRenderTasksExecuted = 0;
 
     // Execute the normal op lists.
-    for (const auto& renderTask : fDAG) {
+    for (int i = 0; i < fDAG.size(); ++i) {
+        const sk_sp<GrRenderTask>& renderTask = fDAG[i];
         SkASSERT(renderTask);
         if (!renderTask->isInstantiated()) {
             continue;
         }
 
+        uint32_t timer = 0;
+        double startNanos = 0;
+        if (perfStats) {
+            timer = perfStats->startTaskTimer();
+            startNanos = SkTime::GetNSecs();
+        }
         if (renderTask->execute(flushState)) {
             anyRenderTasksExecuted = true;
         }
+        if (perfStats) {
+            double executeMs = (SkTime::GetNSecs() - startNanos) * 1e-6;
+            perfStats->didExecuteTask(renderTask.get(), prepareMs[i], executeMs, timer);
+        }
         if (++numRenderTasksExecuted >= kMaxRenderTasksBeforeFlush) {
             flushState->gpu()->submitToGpu(GrSyncCpu::kNo);
             numRenderTasksExecuted = 0;
@@ -1023,6 +1049,9 @@ skgpu::ganesh::PathRenderer* GrDrawingManager::getPathRenderer(
         SkDebugf("getPathRenderer: %s\n", pr->name());
     }
 #endif
+    if (pr) {
+        SkDrawStatsSink::NoteRenderer(pr->name());
+    }
 
     return pr;
 }
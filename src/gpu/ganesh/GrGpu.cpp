@@ -23,6 +23,7 @@
 #include "src/gpu/ganesh/GrDirectContextPriv.h"
 #include "src/gpu/ganesh/GrGpuBuffer.h"
 #include "src/gpu/ganesh/GrGpuResourcePriv.h"
+#include "src/gpu/ganesh/GrPerfStatsRecorder.h"
 #include "src/gpu/ganesh/GrRenderTarget.h"
 #include "src/gpu/ganesh/GrResourceProvider.h"
 #include "src/gpu/ganesh/GrRingBuffer.h"
@@ -38,7 +39,11 @@ using namespace skia_private;
 
 ////////////////////////////////////////////////////////////////////////////////
 
-GrGpu::GrGpu(GrDirectContext* direct) : fResetBits(kAll_GrBackendState), fContext(direct) {}
+GrGpu::GrGpu(GrDirectContext* direct) : fResetBits(kAll_GrBackendState), fContext(direct) {
+    if (direct && direct->priv().options().fEnablePerfStats) {
+        fPerfStats = std::make_unique<GrPerfStatsRecorder>(this);
+    }
+}
 
 GrGpu::~GrGpu() {
     this->callSubmittedProcs(false);
@@ -48,7 +53,12 @@ void GrGpu::initCaps(sk_sp<const GrCaps> caps) {
     fCaps = std::move(caps);
 }
 
-void GrGpu::disconnect(DisconnectType type) {}
+void GrGpu::disconnect(DisconnectType type) {
+    // The backend frees or forgets its timers itself.
+    if (fPerfStats) {
+        fPerfStats->abandonTimers();
+    }
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 
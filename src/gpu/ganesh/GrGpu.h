@@ -34,6 +34,7 @@ class GrAttachment;
 class GrBackendSemaphore;
 class GrDirectContext;
 class GrGLContext;
+class GrPerfStatsRecorder;
 class GrProgramDesc;
 class GrProgramInfo;
 class GrRenderTarget;
@@ -412,6 +413,31 @@ public:
     // Called before render tasks are executed during a flush.
     virtual void willExecute() {}
 
+    // Null unless GrContextOptions::fEnablePerfStats was set.
+    GrPerfStatsRecorder* perfStats() { return fPerfStats.get(); }
+
+    enum class TimerResult {
+        kPending,
+        kReady,
+        kFailed,
+    };
+
+    /**
+     * Timers measure the GPU time of the work recorded between startTimer() and endTimer(). They
+     * are only started between render tasks, outside of any GrOpsRenderPass. startTimer() returns
+     * 0 if the backend can't time the GPU, in which case no other timer call is made for it.
+     */
+    virtual uint32_t startTimer() { return 0; }
+    virtual void endTimer(uint32_t timer) {}
+    /**
+     * Returns kPending until the GPU has done the work, and kFailed if the time was lost (e.g. to
+     * a disjoint GPU clock). kReady comes with the elapsed time in 'nanos'.
+     */
+    virtual TimerResult timerResult(uint32_t timer, uint64_t* nanos) {
+        return TimerResult::kFailed;
+    }
+    virtual void deleteTimer(uint32_t timer) {}
+
     bool submitToGpu(GrSyncCpu sync);
 
     virtual void submit(GrOpsRenderPass*) = 0;
@@ -887,6 +913,8 @@ private:
 
     bool fOOMed = false;
 
+    std::unique_ptr<GrPerfStatsRecorder> fPerfStats;
+
 #if SK_HISTOGRAMS_ENABLED
     int fCurrentSubmitRenderPassCount = 0;
 #endif
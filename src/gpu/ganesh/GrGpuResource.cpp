@@ -27,6 +27,8 @@ static inline GrResourceCache* get_resource_cache(GrGpu* gpu) {
 GrGpuResource::GrGpuResource(GrGpu* gpu, std::string_view label)
         : fGpu(gpu), fUniqueID(CreateUniqueID()), fLabel(label) {
     SkDEBUGCODE(fCacheArrayIndex = -1);
+    SkDEBUGCODE(fDeadlineQueueIndex = -1);
+    SkDEBUGCODE(fCategoryQueueIndex = -1);
 }
 
 void GrGpuResource::registerWithCache(skgpu::Budgeted budgeted) {
@@ -235,9 +235,7 @@ public:
 
     static uint32_t CreateUniqueID();
 
-#if defined(GR_TEST_UTILS)
     virtual const GrSurface* asSurface() const { return nullptr; }
-#endif
 
 protected:
     // This must be called by every non-wrapped GrGpuObject. It should be called once the object is
@@ -323,10 +321,18 @@ private:
     // An index into a heap when this resource is purgeable or an array when not. This is maintained
     // by the cache.
     int fCacheArrayIndex;
+    // Indices into the cache's heaps of its category's purgeable budgeted resources, ordered by
+    // the frame they are due to be used again and by LRU. These are maintained by the cache.
+    int fDeadlineQueueIndex;
+    int fCategoryQueueIndex;
     // This value reflects how recently this resource was accessed in the cache. This is maintained
     // by the cache.
     uint32_t fTimestamp;
     skgpu::StdSteadyClock::time_point fTimeWhenBecamePurgeable;
+    // The cache's frame in which this resource was last used and a running average of the frames
+    // between its uses, zero until it is used a second time. These are maintained by the cache.
+    uint32_t fLastUseFrame = 0;
+    uint32_t fReuseInterval = 0;
 
     static const size_t kInvalidGpuMemorySize = ~static_cast<size_t>(0);
     skgpu::ScratchKey fScratchKey;
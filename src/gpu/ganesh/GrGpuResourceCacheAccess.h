@@ -11,6 +11,8 @@
 #include "src/gpu/ganesh/GrGpuResource.h"
 #include "src/gpu/ganesh/GrGpuResourcePriv.h"
 
+#include <algorithm>
+
 namespace skiatest {
     class Reporter;
 }  // namespace skiatest
@@ -71,6 +73,37 @@ private:
     uint32_t timestamp() const { return fResource->fTimestamp; }
     void setTimestamp(uint32_t ts) { fResource->fTimestamp = ts; }
 
+    /** Called by the cache when the resource is added to it in 'frame'. */
+    void setFirstUseFrame(uint32_t frame) {
+        fResource->fLastUseFrame = frame;
+        fResource->fReuseInterval = 0;
+    }
+
+    /**
+     * Called by the cache each time the resource is looked up or reffed in 'frame', to keep an
+     * estimate of how many frames go by between its uses.
+     */
+    void noteUseInFrame(uint32_t frame) {
+        uint32_t interval = frame - fResource->fLastUseFrame;
+        if (interval > 0) {
+            fResource->fReuseInterval = fResource->fReuseInterval
+                                                ? (fResource->fReuseInterval + interval) / 2
+                                                : interval;
+        }
+        fResource->fLastUseFrame = frame;
+    }
+
+    uint32_t lastUseFrame() const { return fResource->fLastUseFrame; }
+    uint32_t reuseInterval() const { return fResource->fReuseInterval; }
+
+    /**
+     * The frame the resource is next expected to be used in: one reuse interval after its last
+     * use, or the frame after it if it has not been reused yet.
+     */
+    uint32_t dueFrame() const {
+        return fResource->fLastUseFrame + std::max(fResource->fReuseInterval, 1u);
+    }
+
     void setTimeWhenResourceBecomePurgeable() {
         SkASSERT(fResource->isPurgeable());
         fResource->fTimeWhenBecamePurgeable = skgpu::StdSteadyClock::now();
@@ -85,6 +118,8 @@ private:
     }
 
     int* accessCacheIndex() const { return &fResource->fCacheArrayIndex; }
+    int* accessDeadlineQueueIndex() const { return &fResource->fDeadlineQueueIndex; }
+    int* accessCategoryQueueIndex() const { return &fResource->fCategoryQueueIndex; }
 
     CacheAccess(GrGpuResource* resource) : fResource(resource) {}
     CacheAccess(const CacheAccess& that) : fResource(that.fResource) {}
@@ -8,8 +8,12 @@
 #include "src/gpu/ganesh/GrMemoryPool.h"
 
 #include "include/core/SkTypes.h"
+#include "include/private/base/SkAlign.h"
 #include "include/private/base/SkDebug.h"
+#include "include/private/base/SkMutex.h"
 #include "include/private/base/SkTPin.h"
+#include "src/base/SkSpinlock.h"
+#include "src/base/SkTInternalLList.h"
 
 #include <cstring>
 #include <new>
@@ -149,3 +153,130 @@ void GrMemoryPool::validate() const {
     SkASSERT(allocCount > 0 || this->isEmpty());
 }
 #endif
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+// Each allocation is preceded by a pointer to the pool it came from.
+static constexpr size_t kPoolPtrSize = SkAlignTo(sizeof(void*), GrMemoryPool::kAlignment);
+
+class ThreadPool {
+public:
+    SK_DECLARE_INTERNAL_LLIST_INTERFACE(ThreadPool);
+
+    static SkMutex& RegistryMutex() {
+        static SkMutex* gMutex = new SkMutex;
+        return *gMutex;
+    }
+    static SkTInternalLList<ThreadPool>& Registry() {
+        static auto* gRegistry = new SkTInternalLList<ThreadPool>;
+        return *gRegistry;
+    }
+
+    ThreadPool() : fPool(GrMemoryPool::Make(4096, 4096)) {
+        SkAutoMutexExclusive lock(RegistryMutex());
+        Registry().addToTail(this);
+    }
+
+    ~ThreadPool() {
+        SkAutoMutexExclusive lock(RegistryMutex());
+        Registry().remove(this);
+    }
+
+    void* allocate(size_t size) {
+        void* start;
+        {
+            SkAutoSpinlock lock(fLock);
+            start = fPool->allocate(kPoolPtrSize + size);
+            ++fAllocationCount;
+            ++fTotalAllocationCount;
+        }
+        *static_cast<ThreadPool**>(start) = this;
+        return static_cast<char*>(start) + kPoolPtrSize;
+    }
+
+    static void Release(void* p) {
+        void* start = static_cast<char*>(p) - kPoolPtrSize;
+        ThreadPool* pool = *static_cast<ThreadPool**>(start);
+        bool unused;
+        {
+            SkAutoSpinlock lock(pool->fLock);
+            pool->fPool->release(start);
+            unused = --pool->fAllocationCount == 0 && pool->fThreadExited;
+        }
+        if (unused) {
+            delete pool;
+        }
+    }
+
+    void threadExited() {
+        bool unused;
+        {
+            SkAutoSpinlock lock(fLock);
+            fThreadExited = true;
+            unused = fAllocationCount == 0;
+        }
+        if (unused) {
+            delete this;
+        }
+    }
+
+    void addStats(GrThreadMemoryPool::Stats* stats) {
+        SkAutoSpinlock lock(fLock);
+        stats->fPoolCount++;
+        stats->fAllocationCount += fAllocationCount;
+        stats->fTotalAllocationCount += fTotalAllocationCount;
+        stats->fSize += fPool->size();
+    }
+
+private:
+    // The pool is mostly used by its own thread. Other threads only take the lock when they
+    // release memory, or ask for stats.
+    SkSpinlock fLock;
+    std::unique_ptr<GrMemoryPool> fPool;
+    int fAllocationCount = 0;
+    int64_t fTotalAllocationCount = 0;
+    bool fThreadExited = false;
+};
+
+struct ThreadPoolHolder {
+    ~ThreadPoolHolder() {
+        if (fPool) {
+            fPool->threadExited();
+        }
+    }
+    ThreadPool* fPool = nullptr;
+};
+
+static thread_local ThreadPoolHolder sThreadPool;
+
+}  // anonymous namespace
+
+void* GrThreadMemoryPool::Allocate(size_t size) {
+    if (!sThreadPool.fPool) {
+        sThreadPool.fPool = new ThreadPool;
+    }
+    return sThreadPool.fPool->allocate(size);
+}
+
+void GrThreadMemoryPool::Release(void* p) {
+    ThreadPool::Release(p);
+}
+
+GrThreadMemoryPool::Stats GrThreadMemoryPool::GetStats() {
+    Stats stats;
+    SkAutoMutexExclusive lock(ThreadPool::RegistryMutex());
+    for (ThreadPool* pool : ThreadPool::Registry()) {
+        pool->addStats(&stats);
+    }
+    return stats;
+}
+
+GrThreadMemoryPool::Stats GrThreadMemoryPool::GetThreadStats() {
+    Stats stats;
+    if (sThreadPool.fPool) {
+        sThreadPool.fPool->addStats(&stats);
+    }
+    return stats;
+}
@@ -138,4 +138,28 @@ private:
 
     SkBlockAllocator fAllocator; // Must be the last field, in order to use extra allocated space
 };
+
+/**
+ * Parcels out memory from a GrMemoryPool that belongs to the calling thread, so that threads that
+ * record at the same time (e.g., DDLs on worker threads) don't contend for one pool. Memory may be
+ * released on any thread and goes back to the pool it came from. A thread's pool is freed once the
+ * thread has exited and all of the pool's memory has been released, which is typically when the
+ * DDLs recorded on the thread are destroyed.
+ */
+class GrThreadMemoryPool {
+public:
+    static void* Allocate(size_t size);
+    static void Release(void* p);
+
+    struct Stats {
+        int     fPoolCount = 0;             // pools that are in use or whose threads still run
+        int     fAllocationCount = 0;       // allocations that have not been released
+        int64_t fTotalAllocationCount = 0;  // allocations made by the pools in 'fPoolCount'
+        size_t  fSize = 0;                  // heap memory held by the pools, as in size()
+    };
+    // The counts for all pools, and for just the calling thread's pool.
+    static Stats GetStats();
+    static Stats GetThreadStats();
+};
+
 #endif
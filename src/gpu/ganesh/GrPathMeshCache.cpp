@@ -0,0 +1,213 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/gpu/ganesh/GrPathMeshCache.h"
+
+#include "include/core/SkData.h"
+#include "include/core/SkMatrix.h"
+#include "include/core/SkScalar.h"
+#include "include/private/SkIDChangeListener.h"
+#include "include/private/base/SkAssert.h"
+#include "include/private/base/SkMalloc.h"
+#include "include/private/base/SkTo.h"
+#include "include/private/gpu/ganesh/GrTypesPriv.h"
+#include "src/core/SkMessageBus.h"
+#include "src/gpu/ganesh/GrGpuBuffer.h"
+#include "src/gpu/ganesh/GrResourceProvider.h"
+#include "src/gpu/ganesh/GrStyle.h"
+#include "src/gpu/ganesh/geometry/GrStyledShape.h"
+
+#include <cstring>
+#include <utility>
+
+namespace {
+
+// When the SkPathRef genID changes, invalidate a corresponding GrResource described by key.
+class UniqueKeyInvalidator : public SkIDChangeListener {
+public:
+    UniqueKeyInvalidator(const skgpu::UniqueKey& key, uint32_t contextUniqueID)
+            : fMsg(key, contextUniqueID, /* inThreadSafeCache */ true) {}
+
+private:
+    skgpu::UniqueKeyInvalidatedMessage fMsg;
+
+    void changed() override {
+        SkMessageBus<skgpu::UniqueKeyInvalidatedMessage, uint32_t>::Post(fMsg);
+    }
+};
+
+static constexpr int kMatrixCnt = 6;
+
+void matrix_values(const SkMatrix& matrix, SkScalar values[kMatrixCnt]) {
+    SkASSERT(!matrix.hasPerspective());
+    values[0] = matrix.getScaleX();
+    values[1] = matrix.getSkewX();
+    values[2] = matrix.getTranslateX();
+    values[3] = matrix.getSkewY();
+    values[4] = matrix.getScaleY();
+    values[5] = matrix.getTranslateY();
+}
+
+}  // anonymous namespace
+
+bool GrPathMeshCache::CanCache(const GrStyledShape& shape) {
+    return shape.hasUnstyledKey() &&
+           GrStyle::KeySize(shape.style(), GrStyle::Apply::kPathEffectAndStrokeRec) >= 0;
+}
+
+SkIVector GrPathMeshCache::SplitTranslation(const SkMatrix& viewMatrix, SkMatrix* meshMatrix) {
+    SkASSERT(!viewMatrix.hasPerspective());
+    // Fractions of a pixel stay in the mesh's matrix, since meshes are often snapped to the pixel
+    // grid in device space.
+    SkIVector translate = {SkScalarFloorToInt(viewMatrix.getTranslateX()),
+                           SkScalarFloorToInt(viewMatrix.getTranslateY())};
+    *meshMatrix = viewMatrix;
+    meshMatrix->postTranslate(-translate.fX, -translate.fY);
+    return translate;
+}
+
+void GrPathMeshCache::MakeKey(skgpu::UniqueKey* key,
+                              const skgpu::UniqueKey::Domain& domain,
+                              const GrStyledShape& shape,
+                              SkSpan<const uint32_t> extra,
+                              const char* tag) {
+    SkASSERT(CanCache(shape));
+    const GrStyle& style = shape.style();
+    static constexpr auto kApply = GrStyle::Apply::kPathEffectAndStrokeRec;
+
+    int shapeKeyDataCnt = shape.unstyledKeySize();
+    int styleKeyDataCnt = GrStyle::KeySize(style, kApply);
+    skgpu::UniqueKey::Builder builder(key, domain,
+                                      shapeKeyDataCnt + styleKeyDataCnt + SkToInt(extra.size()),
+                                      tag);
+    int i = 0;
+    shape.writeUnstyledKey(&builder[i]);
+    i += shapeKeyDataCnt;
+    // Meshes whose stroke depends on the resolution scale put it in 'extra'.
+    GrStyle::WriteKey(&builder[i], style, kApply, SK_Scalar1);
+    i += styleKeyDataCnt;
+    for (uint32_t value : extra) {
+        builder[i++] = value;
+    }
+    builder.finish();
+}
+
+std::tuple<sk_sp<GrPathMeshCache::VertexData>, sk_sp<SkData>> GrPathMeshCache::Add(
+        GrThreadSafeCache* threadSafeCache,
+        const skgpu::UniqueKey& key,
+        const GrStyledShape& shape,
+        uint32_t contextID,
+        sk_sp<VertexData> vertexData,
+        GrThreadSafeCache::IsNewerBetter isNewerBetter) {
+    auto [cachedVerts, data] = threadSafeCache->addVertsWithData(key, vertexData, isNewerBetter);
+    if (cachedVerts == vertexData) {
+        // This isn't perfect. The new mesh is in the cache but it may have replaced a
+        // pre-existing one. A duplicated listener is unlikely and not that expensive so we just
+        // roll with it.
+        shape.addGenIDChangeListener(sk_make_sp<UniqueKeyInvalidator>(key, contextID));
+    }
+    return {std::move(cachedVerts), std::move(data)};
+}
+
+sk_sp<SkData> GrPathMeshCache::MakeMatrixData(const SkMatrix& meshMatrix) {
+    SkScalar values[kMatrixCnt];
+    matrix_values(meshMatrix, values);
+    return SkData::MakeWithCopy(values, sizeof(values));
+}
+
+bool GrPathMeshCache::MatrixMatches(const SkData* data, const SkMatrix& meshMatrix) {
+    SkScalar values[kMatrixCnt];
+    matrix_values(meshMatrix, values);
+    return data && data->size() == sizeof(values) && !memcmp(data->data(), values, sizeof(values));
+}
+
+void GrPathMeshCache::Replace(GrThreadSafeCache* threadSafeCache,
+                              const skgpu::UniqueKey& key,
+                              sk_sp<VertexData> vertexData) {
+    // If the entry was purged since it was found this adds it again, without a listener. It is
+    // then only dropped once the cache needs the space.
+    threadSafeCache->addVertsWithData(key, std::move(vertexData),
+                                      [](SkData*, SkData*) { return true; });
+}
+
+sk_sp<GrGpuBuffer> GrPathMeshCache::GpuBuffer(GrResourceProvider* resourceProvider,
+                                              VertexData* vertexData) {
+    if (!vertexData->gpuBuffer()) {
+        sk_sp<GrGpuBuffer> buffer = resourceProvider->createBuffer(vertexData->vertices(),
+                                                                   vertexData->size(),
+                                                                   GrGpuBufferType::kVertex,
+                                                                   kStatic_GrAccessPattern);
+        if (!buffer) {
+            return nullptr;
+        }
+
+        // Since we have a direct context and a ref on 'vertexData' we need not worry about any
+        // threading issues in this call.
+        vertexData->setGpuBuffer(std::move(buffer));
+    }
+    return vertexData->refGpuBuffer();
+}
+
+GrPathMeshCache::StaticVertexAllocator::StaticVertexAllocator(GrResourceProvider* resourceProvider,
+                                                              bool canMapVB)
+        : fResourceProvider(resourceProvider)
+        , fCanMapVB(canMapVB) {}
+
+#ifdef SK_DEBUG
+GrPathMeshCache::StaticVertexAllocator::~StaticVertexAllocator() {
+    SkASSERT(!fLockStride && !fVertices && !fVertexBuffer && !fVertexData);
+}
+#endif
+
+void* GrPathMeshCache::StaticVertexAllocator::lock(size_t stride, int eagerCount) {
+    SkASSERT(!fLockStride && !fVertices && !fVertexBuffer && !fVertexData);
+    SkASSERT(stride && eagerCount);
+
+    size_t size = eagerCount * stride;
+    fVertexBuffer = fResourceProvider->createBuffer(size,
+                                                    GrGpuBufferType::kVertex,
+                                                    kStatic_GrAccessPattern,
+                                                    GrResourceProvider::ZeroInit::kNo);
+    if (!fVertexBuffer) {
+        return nullptr;
+    }
+    if (fCanMapVB) {
+        fVertices = fVertexBuffer->map();
+    }
+    if (!fVertices) {
+        fVertices = sk_malloc_throw(eagerCount * stride);
+        fCanMapVB = false;
+    }
+    fLockStride = stride;
+    return fVertices;
+}
+
+void GrPathMeshCache::StaticVertexAllocator::unlock(int actualCount) {
+    SkASSERT(fLockStride && fVertices && fVertexBuffer && !fVertexData);
+
+    if (fCanMapVB) {
+        fVertexBuffer->unmap();
+    } else {
+        fVertexBuffer->updateData(fVertices,
+                                  /*offset=*/0,
+                                  /*size=*/actualCount*fLockStride,
+                                  /*preserve=*/false);
+        sk_free(fVertices);
+    }
+
+    fVertexData = GrThreadSafeCache::MakeVertexData(std::move(fVertexBuffer),
+                                                    actualCount, fLockStride);
+
+    fVertices = nullptr;
+    fLockStride = 0;
+}
+
+sk_sp<GrPathMeshCache::VertexData> GrPathMeshCache::StaticVertexAllocator::detachVertexData() {
+    SkASSERT(!fLockStride && !fVertices && !fVertexBuffer && fVertexData);
+
+    return std::move(fVertexData);
+}
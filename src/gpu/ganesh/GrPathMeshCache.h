@@ -0,0 +1,124 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef GrPathMeshCache_DEFINED
+#define GrPathMeshCache_DEFINED
+
+#include "include/core/SkPoint.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkSpan.h"
+#include "src/gpu/ResourceKey.h"
+#include "src/gpu/ganesh/GrEagerVertexAllocator.h"
+#include "src/gpu/ganesh/GrThreadSafeCache.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+
+class GrGpuBuffer;
+class GrResourceProvider;
+class GrStyledShape;
+class SkData;
+class SkMatrix;
+
+/**
+ * Helpers for ops that keep the meshes they make for paths in the GrThreadSafeCache, so that later
+ * draws of the same path, in this frame or the next, reuse them rather than making them again. A
+ * mesh's vertex buffer is a budgeted GPU resource: it counts against the GrResourceCache budget,
+ * and the GrThreadSafeCache lets go of it when the resource cache needs the space back.
+ *
+ * A mesh is keyed by the shape's key (which holds the path's generation ID) and the parts of its
+ * style that change its geometry. A mesh made in device space keeps the view matrix it was made
+ * with, less its integer translation, in its key's custom data, so that a shape drawn with a
+ * different matrix in every frame has one entry rather than one per matrix. A draw whose matrix
+ * only differs by an integer translation from the one a mesh was made with reuses it, translating
+ * it on the GPU. The key is dropped from the cache once the path changes.
+ */
+class GrPathMeshCache {
+public:
+    using VertexData = GrThreadSafeCache::VertexData;
+
+    /**
+     * Whether meshes of 'shape' can be cached. The shape needs a key, which volatile paths do not
+     * have, and a style with a key.
+     */
+    static bool CanCache(const GrStyledShape&);
+
+    /**
+     * Splits 'viewMatrix', which must not have perspective, into the matrix a device space mesh
+     * is made with ('meshMatrix') and the integer translation to draw it with.
+     */
+    static SkIVector SplitTranslation(const SkMatrix& viewMatrix, SkMatrix* meshMatrix);
+
+    /**
+     * Makes a key in 'domain' for a mesh of 'shape', which CanCache() must accept. Any state
+     * besides the shape that the mesh depends on goes in 'extra'.
+     */
+    static void MakeKey(skgpu::UniqueKey*,
+                        const skgpu::UniqueKey::Domain&,
+                        const GrStyledShape&,
+                        SkSpan<const uint32_t> extra,
+                        const char* tag);
+
+    /**
+     * The custom data for the key of a device space mesh made with 'meshMatrix', from
+     * SplitTranslation(), and whether a cached entry's data is for that matrix.
+     */
+    static sk_sp<SkData> MakeMatrixData(const SkMatrix& meshMatrix);
+    static bool MatrixMatches(const SkData*, const SkMatrix& meshMatrix);
+
+    /**
+     * Adds 'vertexData' to the cache under 'key' and returns what ends up there, which is what
+     * another thread added first if 'isNewerBetter' prefers it. When 'vertexData' is added it is
+     * removed again when the shape's path changes.
+     */
+    static std::tuple<sk_sp<VertexData>, sk_sp<SkData>> Add(GrThreadSafeCache*,
+                                                            const skgpu::UniqueKey&,
+                                                            const GrStyledShape&,
+                                                            uint32_t contextID,
+                                                            sk_sp<VertexData>,
+                                                            GrThreadSafeCache::IsNewerBetter);
+
+    /**
+     * Replaces the entry under 'key', which was just found in the cache, with 'vertexData'. That
+     * entry already gets removed when the shape's path changes, so this adds no listener for it.
+     */
+    static void Replace(GrThreadSafeCache*, const skgpu::UniqueKey&, sk_sp<VertexData>);
+
+    /**
+     * Returns the vertex buffer of 'vertexData', uploading the vertices first if a recording
+     * context made them on the CPU.
+     */
+    static sk_sp<GrGpuBuffer> GpuBuffer(GrResourceProvider*, VertexData*);
+
+    /**
+     * Writes vertices straight into a new static vertex buffer, for a mesh that is made when there
+     * is a resource provider.
+     */
+    class StaticVertexAllocator : public GrEagerVertexAllocator {
+    public:
+        StaticVertexAllocator(GrResourceProvider*, bool canMapVB);
+#ifdef SK_DEBUG
+        ~StaticVertexAllocator() override;
+#endif
+
+        void* lock(size_t stride, int eagerCount) override;
+        void unlock(int actualCount) override;
+
+        sk_sp<VertexData> detachVertexData();
+
+    private:
+        sk_sp<VertexData> fVertexData;
+        sk_sp<GrGpuBuffer> fVertexBuffer;
+        GrResourceProvider* fResourceProvider;
+        bool fCanMapVB;
+        void* fVertices = nullptr;
+        size_t fLockStride = 0;
+    };
+};
+
+#endif
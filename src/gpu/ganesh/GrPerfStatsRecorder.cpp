@@ -0,0 +1,96 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/gpu/ganesh/GrPerfStatsRecorder.h"
+
+#include "include/private/base/SkAssert.h"
+#include "src/gpu/ganesh/GrGpu.h"
+#include "src/gpu/ganesh/GrRenderTask.h"
+#include "src/gpu/ganesh/GrThreadSafePipelineBuilder.h"
+
+uint32_t GrPerfStatsRecorder::startTaskTimer() {
+    return fGpu->startTimer();
+}
+
+void GrPerfStatsRecorder::didExecuteTask(const GrRenderTask* task,
+                                         double prepareMs,
+                                         double executeMs,
+                                         uint32_t timer) {
+    if (timer) {
+        fGpu->endTimer(timer);
+    }
+    if (fTasks.size() == kMaxTasks) {
+        // Drop the older half at once, so that a context whose stats are never read doesn't
+        // shift the whole array for every task.
+        this->dropOldestTasks(kMaxTasks / 2);
+    }
+    fTasks.push_back({{task->uniqueID(), task->name(), prepareMs, executeMs, -1.0}, timer});
+}
+
+void GrPerfStatsRecorder::dropOldestTasks(int count) {
+    SkASSERT(count <= fTasks.size());
+    for (int i = 0; i < count; ++i) {
+        if (fTasks[i].fTimer) {
+            fGpu->deleteTimer(fTasks[i].fTimer);
+        }
+    }
+    // Keep the remaining tasks in order.
+    for (int i = count; i < fTasks.size(); ++i) {
+        fTasks[i - count] = fTasks[i];
+    }
+    fTasks.pop_back_n(count);
+    fDroppedTasks += count;
+}
+
+void GrPerfStatsRecorder::getStats(GrPerfStats* stats) {
+    *stats = {};
+
+    // Tasks are reported in order, so we stop at the first whose GPU time isn't in yet.
+    int ready = 0;
+    for (; ready < fTasks.size(); ++ready) {
+        PendingTask& task = fTasks[ready];
+        if (task.fTimer) {
+            uint64_t nanos;
+            GrGpu::TimerResult result = fGpu->timerResult(task.fTimer, &nanos);
+            if (result == GrGpu::TimerResult::kPending) {
+                break;
+            }
+            if (result == GrGpu::TimerResult::kReady) {
+                task.fStats.fGpuMs = nanos * 1e-6;
+            }
+            fGpu->deleteTimer(task.fTimer);
+            task.fTimer = 0;
+        }
+        stats->fRenderTasks.push_back(task.fStats);
+    }
+    // Keep the tasks still waiting on the GPU, in order.
+    for (int i = ready; i < fTasks.size(); ++i) {
+        fTasks[i - ready] = fTasks[i];
+    }
+    fTasks.pop_back_n(ready);
+    stats->fDroppedRenderTasks = fDroppedTasks;
+    fDroppedTasks = 0;
+
+    if (GrThreadSafePipelineBuilder* builder = fGpu->pipelineBuilder()) {
+        const GrThreadSafePipelineBuilder::PerfCounters* counters = builder->perfCounters();
+        int hits = counters->hits();
+        int misses = counters->misses();
+        int64_t compileNanos = counters->compileNanos();
+        stats->fPipelineCacheHits = hits - fLastPipelineHits;
+        stats->fPipelineCacheMisses = misses - fLastPipelineMisses;
+        stats->fPipelineCompileMs = (compileNanos - fLastPipelineCompileNanos) * 1e-6;
+        fLastPipelineHits = hits;
+        fLastPipelineMisses = misses;
+        fLastPipelineCompileNanos = compileNanos;
+    }
+}
+
+void GrPerfStatsRecorder::abandonTimers() {
+    for (PendingTask& task : fTasks) {
+        task.fTimer = 0;
+    }
+}
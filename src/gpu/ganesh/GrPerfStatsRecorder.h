@@ -0,0 +1,66 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef GrPerfStatsRecorder_DEFINED
+#define GrPerfStatsRecorder_DEFINED
+
+#include "include/gpu/ganesh/GrPerfStats.h"
+#include "include/private/base/SkTArray.h"
+
+#include <cstdint>
+
+class GrGpu;
+class GrRenderTask;
+
+/**
+ * Collects the GrPerfStats of a context that sets GrContextOptions::fEnablePerfStats. The
+ * GrDrawingManager times each render task it flushes and hands the times, along with the GPU
+ * timer it ran the task under, to the GrGpu's recorder. Tasks wait here until their timer's result
+ * is in, so that getStats() reports them complete and in order. At most kMaxTasks wait at a time,
+ * in case getStats() is called rarely or never; past that the oldest are dropped and counted.
+ */
+class GrPerfStatsRecorder {
+public:
+    static constexpr int kMaxTasks = 4096;
+
+    explicit GrPerfStatsRecorder(GrGpu* gpu) : fGpu(gpu) {}
+
+    /** Starts the GPU timer for the next task, or returns 0 if the GPU can't be timed. */
+    uint32_t startTaskTimer();
+
+    /** Ends 'timer' and records a task that was prepared and executed in the given CPU times. */
+    void didExecuteTask(const GrRenderTask*, double prepareMs, double executeMs, uint32_t timer);
+
+    /** Moves the stats collected since the last call into 'stats'. See GrDirectContext. */
+    void getStats(GrPerfStats* stats);
+
+    /**
+     * Forgets the outstanding timers without going to the GPU for them, for when the GrGpu is
+     * disconnected from its backend. The tasks they timed get no GPU time.
+     */
+    void abandonTimers();
+
+private:
+    struct PendingTask {
+        GrPerfStats::RenderTask fStats;
+        uint32_t                fTimer;
+    };
+
+    // Forgets the 'count' oldest tasks, which getStats() then only counts.
+    void dropOldestTasks(int count);
+
+    GrGpu* fGpu;
+    skia_private::TArray<PendingTask> fTasks;
+    int fDroppedTasks = 0;
+    // The pipeline builder's counts at the last getStats(), so that each call reports only what
+    // happened since.
+    int     fLastPipelineHits = 0;
+    int     fLastPipelineMisses = 0;
+    int64_t fLastPipelineCompileNanos = 0;
+};
+
+#endif
@@ -5,47 +5,39 @@
  * found in the LICENSE file.
  */
 
-#include "src/base/SkSpinlock.h"
 #include "src/gpu/ganesh/GrMemoryPool.h"
 #include "src/gpu/ganesh/GrProcessor.h"
 
 #include <memory>
 
-// We use a global pool protected by a mutex(spinlock). Chrome may use the same GrContext on
-// different threads. The GrContext is not used concurrently on different threads and there is a
-// memory barrier between accesses of a context on different threads. Also, there may be multiple
-// GrContexts and those contexts may be in use concurrently on different threads.
+// Processors come from a pool that belongs to the thread making them. Chrome may use the same
+// GrContext on different threads, and there may be multiple GrContexts (or DDL recorders) in use
+// concurrently on different threads, so processors may be freed on another thread than the one
+// that made them.
 namespace {
-#if !defined(SK_BUILD_FOR_ANDROID_FRAMEWORK)
-static SkSpinlock gProcessorSpinlock;
-#endif
-class MemoryPoolAccessor {
-public:
-
 // We know in the Android framework there is only one GrContext.
 #if defined(SK_BUILD_FOR_ANDROID_FRAMEWORK)
-    MemoryPoolAccessor() {}
-    ~MemoryPoolAccessor() {}
+GrMemoryPool* pool() {
+    static GrMemoryPool* gPool = GrMemoryPool::Make(4096, 4096).release();
+    return gPool;
+}
+
+void* allocate(size_t size) { return pool()->allocate(size); }
+void release(void* target) { pool()->release(target); }
 #else
-    MemoryPoolAccessor() { gProcessorSpinlock.acquire(); }
-    ~MemoryPoolAccessor() { gProcessorSpinlock.release(); }
+void* allocate(size_t size) { return GrThreadMemoryPool::Allocate(size); }
+void release(void* target) { GrThreadMemoryPool::Release(target); }
 #endif
-
-    GrMemoryPool* pool() const {
-        static GrMemoryPool* gPool = GrMemoryPool::Make(4096, 4096).release();
-        return gPool;
-    }
-};
 }  // namespace
 
 ///////////////////////////////////////////////////////////////////////////////
 
-void* GrProcessor::operator new(size_t size) { return MemoryPoolAccessor().pool()->allocate(size); }
+void* GrProcessor::operator new(size_t size) { return allocate(size); }
 
 void* GrProcessor::operator new(size_t object_size, size_t footer_size) {
-    return MemoryPoolAccessor().pool()->allocate(object_size + footer_size);
+    return allocate(object_size + footer_size);
 }
 
 void GrProcessor::operator delete(void* target) {
-    return MemoryPoolAccessor().pool()->release(target);
+    return release(target);
 }
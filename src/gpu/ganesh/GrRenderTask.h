@@ -108,6 +108,9 @@ public:
      */
     virtual skgpu::ganesh::OpsTask* asOpsTask() { return nullptr; }
 
+    // A short name for the kind of task, used in dumps and GrPerfStats.
+    virtual const char* name() const = 0;
+
 #if defined(GR_TEST_UTILS)
     /*
      * Dump out the GrRenderTask dependency DAG
@@ -116,7 +119,6 @@ public:
                       SkString indent,
                       bool printDependencies,
                       bool close) const;
-    virtual const char* name() const = 0;
 #endif
 
 #ifdef SK_DEBUG
@@ -6,7 +6,9 @@
  */
 
 #include "src/gpu/ganesh/GrResourceCache.h"
+#include <algorithm>
 #include <atomic>
+#include <cstdint>
 #include <vector>
 #include "include/gpu/GrDirectContext.h"
 #include "include/private/base/SingleOwner.h"
@@ -15,6 +17,7 @@
 #include "src/base/SkScopeExit.h"
 #include "src/base/SkTSort.h"
 #include "src/core/SkMessageBus.h"
+#include "src/gpu/GpuMemoryReportPriv.h"
 #include "src/gpu/ganesh/GrCaps.h"
 #include "src/gpu/ganesh/GrDirectContextPriv.h"
 #include "src/gpu/ganesh/GrGpuResourceCacheAccess.h"
@@ -57,6 +60,7 @@ GrResourceCache::GrResourceCache(skgpu::SingleOwner* singleOwner,
         , fSingleOwner(singleOwner) {
     SkASSERT(owningContextID.isValid());
     SkASSERT(familyID != SK_InvalidUniqueID);
+    std::fill_n(fCategoryLimits, kCategoryCount, SIZE_MAX);
 }
 
 GrResourceCache::~GrResourceCache() {
@@ -68,6 +72,71 @@ void GrResourceCache::setLimit(size_t bytes) {
     this->purgeAsNeeded();
 }
 
+GrResourceCache::Category GrResourceCache::CategoryOf(const GrGpuResource* resource) {
+    const GrSurface* surface = resource->asSurface();
+    if (!surface) {
+        return Category::kBuffer;
+    }
+    if (surface->asRenderTarget()) {
+        return Category::kRenderTarget;
+    }
+    if (surface->asTexture()) {
+        return Category::kTexture;
+    }
+    return Category::kAttachment;
+}
+
+void GrResourceCache::setCategoryLimit(Category category, size_t bytes) {
+    fCategoryLimits[static_cast<int>(category)] = bytes;
+    this->purgeAsNeeded();
+}
+
+GrResourceCache::CategoryStats GrResourceCache::getCategoryStats(Category category) const {
+    int i = static_cast<int>(category);
+    CategoryStats stats;
+    stats.fBudgetedBytes = fCategoryBytes[i];
+    stats.fLimit = fCategoryLimits[i];
+    stats.fHits = fCategoryHits[i];
+    stats.fPurges = fCategoryPurges[i];
+    stats.fWouldHaveHits = fCategoryWouldHaveHits[i];
+    return stats;
+}
+
+float GrResourceCache::wouldHaveHitRate() const {
+    int lookups = fLookupMisses;
+    int wouldHaveHits = 0;
+    for (int i = 0; i < kCategoryCount; ++i) {
+        lookups += fCategoryHits[i];
+        wouldHaveHits += fCategoryWouldHaveHits[i];
+    }
+    return lookups ? static_cast<float>(wouldHaveHits) / lookups : 0.f;
+}
+
+void GrResourceCache::addBudgetedBytes(const GrGpuResource* resource, size_t size) {
+    fBudgetedBytes += size;
+    fCategoryBytes[CategoryIndex(resource)] += size;
+}
+
+void GrResourceCache::removeBudgetedBytes(const GrGpuResource* resource, size_t size) {
+    fBudgetedBytes -= size;
+    fCategoryBytes[CategoryIndex(resource)] -= size;
+}
+
+void GrResourceCache::noteLookup(const GrGpuResource* found, uint32_t keyHash, bool unique) {
+    if (found) {
+        ++fCategoryHits[CategoryIndex(found)];
+        return;
+    }
+    ++fLookupMisses;
+    // This is only reached before a new resource is made, which costs far more than the search.
+    for (const PurgedKey& purged : fRecentlyPurged) {
+        if (purged.fHash == keyHash && purged.fUnique == unique) {
+            ++fCategoryWouldHaveHits[purged.fCategory];
+            break;
+        }
+    }
+}
+
 void GrResourceCache::insertResource(GrGpuResource* resource) {
     ASSERT_SINGLE_OWNER
     SkASSERT(resource);
@@ -78,6 +147,7 @@ void GrResourceCache::insertResource(GrGpuResource* resource) {
     // We must set the timestamp before adding to the array in case the timestamp wraps and we wind
     // up iterating over all the resources that already have timestamps.
     resource->cacheAccess().setTimestamp(this->getNextTimestamp());
+    resource->cacheAccess().setFirstUseFrame(fFrame);
 
     this->addToNonpurgeableArray(resource);
 
@@ -90,7 +160,7 @@ void GrResourceCache::insertResource(GrGpuResource* resource) {
 #endif
     if (GrBudgetedType::kBudgeted == resource->resourcePriv().budgetedType()) {
         ++fBudgetedCount;
-        fBudgetedBytes += size;
+        this->addBudgetedBytes(resource, size);
         TRACE_COUNTER2("skia.gpu.cache", "skia budget", "used",
                        fBudgetedBytes, "free", fMaxBytes - fBudgetedBytes);
 #if GR_CACHE_STATS
@@ -111,6 +181,9 @@ void GrResourceCache::removeResource(GrGpuResource* resource) {
     if (resource->resourcePriv().isPurgeable()) {
         fPurgeableQueue.remove(resource);
         fPurgeableBytes -= size;
+        if (resource->resourcePriv().budgetedType() == GrBudgetedType::kBudgeted) {
+            this->removeFromCategoryQueues(resource);
+        }
     } else {
         this->removeFromNonpurgeableArray(resource);
     }
@@ -119,7 +192,7 @@ void GrResourceCache::removeResource(GrGpuResource* resource) {
     fBytes -= size;
     if (GrBudgetedType::kBudgeted == resource->resourcePriv().budgetedType()) {
         --fBudgetedCount;
-        fBudgetedBytes -= size;
+        this->removeBudgetedBytes(resource, size);
         TRACE_COUNTER2("skia.gpu.cache", "skia budget", "used",
                        fBudgetedBytes, "free", fMaxBytes - fBudgetedBytes);
     }
@@ -211,11 +284,14 @@ GrGpuResource* GrResourceCache::findAndRefScratchResource(const skgpu::ScratchKe
     SkASSERT(scratchKey.isValid());
 
     GrGpuResource* resource = fScratchMap.find(scratchKey);
+    ++fScratchRequests;
     if (resource) {
+        ++fScratchReuses;
         fScratchMap.remove(scratchKey, resource);
         this->refAndMakeResourceMRU(resource);
         this->validate();
     }
+    this->noteLookup(resource, scratchKey.hash(), /*unique=*/false);
     return resource;
 }
 
@@ -298,6 +374,9 @@ void GrResourceCache::refAndMakeResourceMRU(GrGpuResource* resource) {
         // It's about to become unpurgeable.
         fPurgeableBytes -= resource->gpuMemorySize();
         fPurgeableQueue.remove(resource);
+        if (resource->resourcePriv().budgetedType() == GrBudgetedType::kBudgeted) {
+            this->removeFromCategoryQueues(resource);
+        }
         this->addToNonpurgeableArray(resource);
     } else if (!resource->cacheAccess().hasRefOrCommandBufferUsage() &&
                resource->resourcePriv().budgetedType() == GrBudgetedType::kBudgeted) {
@@ -307,6 +386,7 @@ void GrResourceCache::refAndMakeResourceMRU(GrGpuResource* resource) {
     resource->cacheAccess().ref();
 
     resource->cacheAccess().setTimestamp(this->getNextTimestamp());
+    resource->cacheAccess().noteUseInFrame(fFrame);
     this->validate();
 }
 
@@ -360,6 +440,9 @@ void GrResourceCache::notifyARefCntReachedZero(GrGpuResource* resource,
     bool hasUniqueKey = resource->getUniqueKey().isValid();
 
     GrBudgetedType budgetedType = resource->resourcePriv().budgetedType();
+    if (budgetedType == GrBudgetedType::kBudgeted) {
+        this->addToCategoryQueues(resource);
+    }
 
     if (budgetedType == GrBudgetedType::kBudgeted) {
         // Purge the resource immediately if we're over budget
@@ -405,7 +488,7 @@ void GrResourceCache::didChangeBudgetStatus(GrGpuResource* resource) {
     SkDEBUGCODE(bool wasPurgeable = resource->resourcePriv().isPurgeable());
     if (resource->resourcePriv().budgetedType() == GrBudgetedType::kBudgeted) {
         ++fBudgetedCount;
-        fBudgetedBytes += size;
+        this->addBudgetedBytes(resource, size);
 #if GR_CACHE_STATS
         fBudgetedHighWaterBytes = std::max(fBudgetedBytes, fBudgetedHighWaterBytes);
         fBudgetedHighWaterCount = std::max(fBudgetedCount, fBudgetedHighWaterCount);
@@ -421,7 +504,7 @@ void GrResourceCache::didChangeBudgetStatus(GrGpuResource* resource) {
     } else {
         SkASSERT(resource->resourcePriv().budgetedType() != GrBudgetedType::kUnbudgetedCacheable);
         --fBudgetedCount;
-        fBudgetedBytes -= size;
+        this->removeBudgetedBytes(resource, size);
         if (!resource->resourcePriv().isPurgeable() &&
             !resource->cacheAccess().hasRefOrCommandBufferUsage()) {
             --fNumBudgetedResourcesFlushWillMakePurgeable;
@@ -452,36 +535,107 @@ void GrResourceCache::purgeAsNeeded() {
                 fProxyProvider->processInvalidUniqueKey(
                                                     invalidKeyMsgs[i].key(), nullptr,
                                                     GrProxyProvider::InvalidateGPUResource::kYes);
-                SkASSERT(!this->findAndRefUniqueResource(invalidKeyMsgs[i].key()));
+                SkASSERT(!this->hasUniqueKey(invalidKeyMsgs[i].key()));
             }
         }
     }
 
     this->processFreedGpuResources();
 
-    bool stillOverbudget = this->overBudget();
-    while (stillOverbudget && fPurgeableQueue.count()) {
-        GrGpuResource* resource = fPurgeableQueue.peek();
-        SkASSERT(resource->resourcePriv().isPurgeable());
-        resource->cacheAccess().release();
-        stillOverbudget = this->overBudget();
+    for (int category = 0; category < kCategoryCount; ++category) {
+        if (this->overCategoryBudget(category)) {
+            this->purgeOverdueFirst(category, [this, category] {
+                return this->overCategoryBudget(category);
+            });
+        }
     }
 
-    if (stillOverbudget) {
+    if (this->overBudget()) {
+        this->purgeOverdueFirst(-1, [this] { return this->overBudget(); });
+    }
+
+    if (this->overBudget()) {
         fThreadSafeCache->dropUniqueRefs(this);
 
-        stillOverbudget = this->overBudget();
-        while (stillOverbudget && fPurgeableQueue.count()) {
-            GrGpuResource* resource = fPurgeableQueue.peek();
-            SkASSERT(resource->resourcePriv().isPurgeable());
-            resource->cacheAccess().release();
-            stillOverbudget = this->overBudget();
-        }
+        this->purgeOverdueFirst(-1, [this] { return this->overBudget(); });
     }
 
     this->validate();
 }
 
+bool GrResourceCache::isOverdue(const GrGpuResource* resource) const {
+    return fFrame > resource->cacheAccess().dueFrame();
+}
+
+template <typename Fn>
+void GrResourceCache::purgeOverdueFirst(int category, Fn&& stillOverBudget) {
+    const int firstCategory = category < 0 ? 0 : category;
+    const int lastCategory = category < 0 ? kCategoryCount - 1 : category;
+
+    // Resources that are due to be used again soon are worth more than their LRU order says, so
+    // the overdue ones go first. Each category's earliest due resource is the most overdue of it.
+    while (stillOverBudget()) {
+        GrGpuResource* mostOverdue = nullptr;
+        for (int i = firstCategory; i <= lastCategory; ++i) {
+            if (fDeadlineQueues[i].count()) {
+                GrGpuResource* resource = fDeadlineQueues[i].peek();
+                if (this->isOverdue(resource) &&
+                    (!mostOverdue || CompareDueFrame(resource, mostOverdue))) {
+                    mostOverdue = resource;
+                }
+            }
+        }
+        if (!mostOverdue) {
+            break;
+        }
+        this->purgeForBudget(mostOverdue);
+    }
+
+    if (category >= 0) {
+        while (stillOverBudget() && fCategoryQueues[category].count()) {
+            this->purgeForBudget(fCategoryQueues[category].peek());
+        }
+        return;
+    }
+    while (stillOverBudget() && fPurgeableQueue.count()) {
+        this->purgeForBudget(fPurgeableQueue.peek());
+    }
+}
+
+void GrResourceCache::addToCategoryQueues(GrGpuResource* resource) {
+    SkASSERT(resource->resourcePriv().isPurgeable());
+    SkASSERT(resource->resourcePriv().budgetedType() == GrBudgetedType::kBudgeted);
+    const int category = CategoryIndex(resource);
+    fDeadlineQueues[category].insert(resource);
+    fCategoryQueues[category].insert(resource);
+}
+
+void GrResourceCache::removeFromCategoryQueues(GrGpuResource* resource) {
+    const int category = CategoryIndex(resource);
+    fDeadlineQueues[category].remove(resource);
+    fCategoryQueues[category].remove(resource);
+}
+
+void GrResourceCache::purgeForBudget(GrGpuResource* resource) {
+    SkASSERT(resource->resourcePriv().isPurgeable());
+    const skgpu::UniqueKey& uniqueKey = resource->getUniqueKey();
+    const skgpu::ScratchKey& scratchKey = resource->resourcePriv().getScratchKey();
+    const int category = CategoryIndex(resource);
+    if (uniqueKey.isValid() || scratchKey.isValid()) {
+        PurgedKey purged = {uniqueKey.isValid() ? uniqueKey.hash() : scratchKey.hash(),
+                            uniqueKey.isValid(),
+                            SkToS8(category)};
+        if (fRecentlyPurged.size() < kRecentlyPurgedCount) {
+            fRecentlyPurged.push_back(purged);
+        } else {
+            fRecentlyPurged[fNextRecentlyPurged] = purged;
+            fNextRecentlyPurged = (fNextRecentlyPurged + 1) % kRecentlyPurgedCount;
+        }
+    }
+    ++fCategoryPurges[category];
+    resource->cacheAccess().release();
+}
+
 void GrResourceCache::purgeUnlockedResources(const skgpu::StdSteadyClock::time_point* purgeTime,
                                              GrPurgeResourceOptions opts) {
     if (opts == GrPurgeResourceOptions::kAllResources) {
@@ -729,6 +883,24 @@ void GrResourceCache::dumpMemoryStatistics(SkTraceMemoryDump* traceMemoryDump) c
     }
 }
 
+void GrResourceCache::addToMemoryReport(skgpu::GpuMemoryReport* report) const {
+    auto add = [report](const GrGpuResource* resource, bool purgeable) {
+        skgpu::AddResourceToReport(
+                report, resource->getResourceType(), resource->gpuMemorySize(), purgeable,
+                resource->resourcePriv().budgetedType() == GrBudgetedType::kBudgeted);
+    };
+    for (int i = 0; i < fNonpurgeableResources.size(); ++i) {
+        add(fNonpurgeableResources[i], /*purgeable=*/false);
+    }
+    for (int i = 0; i < fPurgeableQueue.count(); ++i) {
+        add(fPurgeableQueue.at(i), /*purgeable=*/true);
+    }
+    skgpu::SortReportResourceTypes(report);
+    report->fBudget += fMaxBytes;
+    report->fScratchRequests += fScratchRequests;
+    report->fScratchReuses += fScratchReuses;
+}
+
 #if GR_CACHE_STATS
 void GrResourceCache::getStats(Stats* stats) const {
     stats->reset();
@@ -790,6 +962,7 @@ void GrResourceCache::validate() const {
         size_t fBytes;
         int fBudgetedCount;
         size_t fBudgetedBytes;
+        size_t fCategoryBytes[kCategoryCount];
         int fLocked;
         int fScratch;
         int fCouldBeScratch;
@@ -836,6 +1009,7 @@ void GrResourceCache::validate() const {
             if (GrBudgetedType::kBudgeted == resource->resourcePriv().budgetedType()) {
                 ++fBudgetedCount;
                 fBudgetedBytes += resource->gpuMemorySize();
+                fCategoryBytes[CategoryIndex(resource)] += resource->gpuMemorySize();
             }
         }
     };
@@ -865,12 +1039,24 @@ void GrResourceCache::validate() const {
         }
         stats.update(fNonpurgeableResources[i]);
     }
+    int purgeableBudgetedCount[kCategoryCount] = {};
     for (int i = 0; i < fPurgeableQueue.count(); ++i) {
         SkASSERT(fPurgeableQueue.at(i)->resourcePriv().isPurgeable());
         SkASSERT(*fPurgeableQueue.at(i)->cacheAccess().accessCacheIndex() == i);
         SkASSERT(!fPurgeableQueue.at(i)->wasDestroyed());
         stats.update(fPurgeableQueue.at(i));
         purgeableBytes += fPurgeableQueue.at(i)->gpuMemorySize();
+        if (fPurgeableQueue.at(i)->resourcePriv().budgetedType() == GrBudgetedType::kBudgeted) {
+            ++purgeableBudgetedCount[CategoryIndex(fPurgeableQueue.at(i))];
+        }
+    }
+    for (int i = 0; i < kCategoryCount; ++i) {
+        SkASSERT(fDeadlineQueues[i].count() == purgeableBudgetedCount[i]);
+        SkASSERT(fCategoryQueues[i].count() == purgeableBudgetedCount[i]);
+        for (int j = 0; j < fCategoryQueues[i].count(); ++j) {
+            SkASSERT(*fDeadlineQueues[i].at(j)->cacheAccess().accessDeadlineQueueIndex() == j);
+            SkASSERT(*fCategoryQueues[i].at(j)->cacheAccess().accessCategoryQueueIndex() == j);
+        }
     }
 
     SkASSERT(fCount == this->getResourceCount());
@@ -880,6 +1066,9 @@ void GrResourceCache::validate() const {
     SkASSERT(fNumBudgetedResourcesFlushWillMakePurgeable ==
              numBudgetedResourcesFlushWillMakePurgeable);
     SkASSERT(stats.fBudgetedBytes == fBudgetedBytes);
+    for (int i = 0; i < kCategoryCount; ++i) {
+        SkASSERT(stats.fCategoryBytes[i] == fCategoryBytes[i]);
+    }
     SkASSERT(stats.fBudgetedCount == fBudgetedCount);
     SkASSERT(purgeableBytes == fPurgeableBytes);
 #if GR_CACHE_STATS
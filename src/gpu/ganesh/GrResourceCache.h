@@ -30,6 +30,7 @@ class GrTexture;
 class GrThreadSafeCache;
 
 namespace skgpu {
+struct GpuMemoryReport;
 class SingleOwner;
 }
 
@@ -89,6 +90,57 @@ public:
     /** Sets the max gpu memory byte size of the cache. */
     void setLimit(size_t bytes);
 
+    /**
+     * The kinds of resources that can be given a budget of their own, within the cache's. MSAA
+     * and stencil attachments are kAttachment, and everything that is not a surface is kBuffer.
+     */
+    enum class Category {
+        kTexture,
+        kRenderTarget,
+        kAttachment,
+        kBuffer,
+
+        kLast = kBuffer
+    };
+    static constexpr int kCategoryCount = static_cast<int>(Category::kLast) + 1;
+
+    static Category CategoryOf(const GrGpuResource*);
+
+    /**
+     * Sets the max gpu memory byte size of budgeted resources in 'category'. Resources of one
+     * category are purged when it goes over its limit, even if the cache as a whole is within its
+     * budget. By default a category is only limited by the cache's budget.
+     */
+    void setCategoryLimit(Category category, size_t bytes);
+
+    /**
+     * Called once per frame, which Ganesh takes to be each submit. Purging favors resources that
+     * have gone unused for longer than the number of frames they are usually reused in.
+     */
+    void notifyFrameSubmitted() { ++fFrame; }
+
+    struct CategoryStats {
+        size_t fBudgetedBytes = 0;
+        size_t fLimit = 0;
+        // Lookups by key that found a resource of the category.
+        int fHits = 0;
+        // Resources of the category purged to stay within a budget.
+        int fPurges = 0;
+        // Lookups that found nothing but whose key was one of the last purged to stay in budget.
+        int fWouldHaveHits = 0;
+    };
+
+    CategoryStats getCategoryStats(Category) const;
+
+    /** Returns the number of lookups by key that found nothing. */
+    int getLookupMissCount() const { return fLookupMisses; }
+
+    /**
+     * Returns the fraction of lookups by key that found nothing but would have found a resource
+     * if the cache had not purged it to stay in budget.
+     */
+    float wouldHaveHitRate() const;
+
     /**
      * Returns the number of resources.
      */
@@ -153,6 +205,7 @@ public:
         if (resource) {
             this->refAndMakeResourceMRU(resource);
         }
+        this->noteLookup(resource, key.hash(), /*unique=*/true);
         return resource;
     }
 
@@ -261,6 +314,9 @@ public:
     // Enumerates all cached resources and dumps their details to traceMemoryDump.
     void dumpMemoryStatistics(SkTraceMemoryDump* traceMemoryDump) const;
 
+    // Adds the cached resources, the budget and the scratch reuse counts to 'report'.
+    void addToMemoryReport(skgpu::GpuMemoryReport* report) const;
+
     void setProxyProvider(GrProxyProvider* proxyProvider) { fProxyProvider = proxyProvider; }
     void setThreadSafeCache(GrThreadSafeCache* threadSafeCache) {
         fThreadSafeCache = threadSafeCache;
@@ -314,6 +370,32 @@ private:
 
     bool wouldFit(size_t bytes) const { return fBudgetedBytes+bytes <= fMaxBytes; }
 
+    static int CategoryIndex(const GrGpuResource* resource) {
+        return static_cast<int>(CategoryOf(resource));
+    }
+    bool overCategoryBudget(int category) const {
+        return fCategoryBytes[category] > fCategoryLimits[category];
+    }
+    void addBudgetedBytes(const GrGpuResource*, size_t size);
+    void removeBudgetedBytes(const GrGpuResource*, size_t size);
+
+    // Whether a purgeable resource has gone unused for longer than it usually goes between uses,
+    // or for more than one frame if it has not been reused yet.
+    bool isOverdue(const GrGpuResource*) const;
+
+    // Purges purgeable resources until 'stillOverBudget' returns false: the overdue budgeted ones
+    // first, most overdue first, and then the rest in LRU order. If 'category' is not negative
+    // only budgeted resources of that category are purged.
+    template <typename Fn> void purgeOverdueFirst(int category, Fn&& stillOverBudget);
+    // Releases a resource to get within a budget, remembering its key for would have hit stats.
+    void purgeForBudget(GrGpuResource*);
+
+    // Adds and removes a purgeable budgeted resource from its category's queues.
+    void addToCategoryQueues(GrGpuResource*);
+    void removeFromCategoryQueues(GrGpuResource*);
+
+    void noteLookup(const GrGpuResource* found, uint32_t keyHash, bool unique);
+
     uint32_t getNextTimestamp();
 
     void purgeUnlockedResources(const skgpu::StdSteadyClock::time_point* purgeTime,
@@ -353,8 +435,24 @@ private:
         return res->cacheAccess().accessCacheIndex();
     }
 
+    static bool CompareDueFrame(GrGpuResource* const& a, GrGpuResource* const& b) {
+        uint32_t dueA = a->cacheAccess().dueFrame();
+        uint32_t dueB = b->cacheAccess().dueFrame();
+        return dueA < dueB || (dueA == dueB && CompareTimestamp(a, b));
+    }
+
+    static int* AccessDeadlineQueueIndex(GrGpuResource* const& res) {
+        return res->cacheAccess().accessDeadlineQueueIndex();
+    }
+
+    static int* AccessCategoryQueueIndex(GrGpuResource* const& res) {
+        return res->cacheAccess().accessCategoryQueueIndex();
+    }
+
     typedef SkMessageBus<skgpu::UniqueKeyInvalidatedMessage, uint32_t>::Inbox InvalidUniqueKeyInbox;
     typedef SkTDPQueue<GrGpuResource*, CompareTimestamp, AccessResourceIndex> PurgeableQueue;
+    typedef SkTDPQueue<GrGpuResource*, CompareDueFrame, AccessDeadlineQueueIndex> DeadlineQueue;
+    typedef SkTDPQueue<GrGpuResource*, CompareTimestamp, AccessCategoryQueueIndex> CategoryQueue;
     typedef SkTDArray<GrGpuResource*> ResourceArray;
 
     GrProxyProvider*                    fProxyProvider = nullptr;
@@ -392,6 +490,34 @@ private:
     size_t                              fPurgeableBytes = 0;
     int                                 fNumBudgetedResourcesFlushWillMakePurgeable = 0;
 
+    // Budgeted bytes and limits, and lookup stats, of each Category.
+    size_t                              fCategoryBytes[kCategoryCount] = {};
+    size_t                              fCategoryLimits[kCategoryCount];
+    int                                 fCategoryHits[kCategoryCount] = {};
+    int                                 fCategoryPurges[kCategoryCount] = {};
+    int                                 fCategoryWouldHaveHits[kCategoryCount] = {};
+    int                                 fLookupMisses = 0;
+    // Requests for scratch resources, and how many of them found one.
+    int                                 fScratchRequests = 0;
+    int                                 fScratchReuses = 0;
+    uint32_t                            fFrame = 0;
+
+    // The purgeable budgeted resources of each Category, by the frame they are due to be used
+    // again, so that the overdue ones are found without searching, and in LRU order.
+    DeadlineQueue                       fDeadlineQueues[kCategoryCount];
+    CategoryQueue                       fCategoryQueues[kCategoryCount];
+
+    // The keys of the last resources purged to stay in budget, as a ring, so that lookups of them
+    // are counted as would have hits.
+    struct PurgedKey {
+        uint32_t fHash;
+        bool     fUnique;
+        int8_t   fCategory;
+    };
+    static constexpr int kRecentlyPurgedCount = 256;
+    skia_private::TArray<PurgedKey>     fRecentlyPurged;
+    int                                 fNextRecentlyPurged = 0;
+
     InvalidUniqueKeyInbox               fInvalidUniqueKeyInbox;
     UnrefResourceMessage::Bus::Inbox    fUnrefResourceInbox;
 
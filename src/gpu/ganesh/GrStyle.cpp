@@ -6,6 +6,8 @@
  */
 
 #include "src/gpu/ganesh/GrStyle.h"
+
+#include "src/core/SkStrokeCache.h"
 #include "src/utils/SkDashPathPriv.h"
 
 int GrStyle::KeySize(const GrStyle &style, Apply apply, uint32_t flags) {
@@ -185,7 +187,10 @@ bool GrStyle::applyToPath(SkPath* dst, SkStrokeRec::InitStyle* style, const SkPa
         return false;
     }
     if (strokeRec.needToApply()) {
-        if (!strokeRec.applyToPath(dst, *pathForStrokeRec)) {
+        const bool stroked = pathForStrokeRec == &src
+                                     ? SkStrokeCache::ApplyToPath(strokeRec, src, dst)
+                                     : strokeRec.applyToPath(dst, *pathForStrokeRec);
+        if (!stroked) {
             return false;
         }
         dst->setIsVolatile(true);
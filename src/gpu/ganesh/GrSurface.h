@@ -103,9 +103,7 @@ public:
         sk_sp<GrDirectContext> fDirectContext;
     };
 
-#if defined(GR_TEST_UTILS)
     const GrSurface* asSurface() const override { return this; }
-#endif
 
 protected:
     void setGLRTFBOIDIs0() {
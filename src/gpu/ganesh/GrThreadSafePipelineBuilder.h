@@ -11,6 +11,7 @@
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkTypes.h"
 #include <atomic>
+#include <cstdint>
 
 #if defined(GR_TEST_UTILS)
 #include "include/core/SkString.h"
@@ -106,8 +107,34 @@ public:
 
     Stats* stats() { return &fStats; }
 
+    /**
+     * The pipeline lookups GrPerfStats reports. Unlike Stats these are kept in every build, since
+     * they are only a few relaxed atomic adds per pipeline bind.
+     */
+    class PerfCounters {
+    public:
+        void recordHit() { fHits.fetch_add(1, std::memory_order_relaxed); }
+        void recordMiss(double compileNanos) {
+            fMisses.fetch_add(1, std::memory_order_relaxed);
+            fCompileNanos.fetch_add(static_cast<int64_t>(compileNanos),
+                                    std::memory_order_relaxed);
+        }
+
+        int hits() const { return fHits.load(std::memory_order_relaxed); }
+        int misses() const { return fMisses.load(std::memory_order_relaxed); }
+        int64_t compileNanos() const { return fCompileNanos.load(std::memory_order_relaxed); }
+
+    private:
+        std::atomic<int> fHits{0};
+        std::atomic<int> fMisses{0};
+        std::atomic<int64_t> fCompileNanos{0};
+    };
+
+    PerfCounters* perfCounters() { return &fPerfCounters; }
+
 protected:
     Stats fStats;
+    PerfCounters fPerfCounters;
 };
 
 #endif
@@ -54,9 +54,7 @@ private:
 
     bool onExecute(GrOpFlushState*) override;
 
-#if defined(GR_TEST_UTILS)
     const char* name() const final { return "TransferFrom"; }
-#endif
 #ifdef SK_DEBUG
     void visitProxies_debugOnly(const GrVisitProxyFunc& func) const override {
         func(fSrcProxy.get(), skgpu::Mipmapped::kNo);
@@ -33,9 +33,7 @@ private:
 
     bool onExecute(GrOpFlushState*) override;
 
-#if defined(GR_TEST_UTILS)
     const char* name() const final { return "Wait"; }
-#endif
 #ifdef SK_DEBUG
     // No non-dst proxies.
     void visitProxies_debugOnly(const GrVisitProxyFunc&) const override {}
@@ -702,6 +702,154 @@ void SurfaceContext::asyncReadPixels(GrDirectContext* dContext,
             this->asSurfaceProxy(), SkSurfaces::BackendSurfaceAccess::kNoAccess, flushInfo);
 }
 
+void SurfaceContext::AsyncReadPixelsBatch(GrDirectContext* dContext,
+                                          SkSpan<SurfaceContext* const> contexts,
+                                          SkSpan<const SkIRect> rects,
+                                          SkColorType colorType,
+                                          ReadPixelsCallback callback,
+                                          ReadPixelsContext callbackContext) {
+    using AsyncReadResult = skgpu::TAsyncReadResult<GrGpuBuffer, GrDirectContext::DirectContextID,
+                                                    PixelTransferResult>;
+    SkASSERT(contexts.size() == rects.size());
+
+    if (!dContext || contexts.empty()) {
+        callback(callbackContext, nullptr);
+        return;
+    }
+    for (size_t i = 0; i < contexts.size(); ++i) {
+        SkASSERT(rects[i].fLeft >= 0 && rects[i].fRight <= contexts[i]->width());
+        SkASSERT(rects[i].fTop >= 0 && rects[i].fBottom <= contexts[i]->height());
+        if (contexts[i]->asSurfaceProxy()->isProtected() == GrProtected::kYes) {
+            callback(callbackContext, nullptr);
+            return;
+        }
+    }
+
+    // Each request that can be transferred gets its own range of one shared buffer. The others
+    // are read back right away, as asyncReadPixels() does.
+    struct Request {
+        SkISize fSize;
+        size_t fOffset = 0;
+        PixelTransferResult fTransfer;
+        sk_sp<SkData> fCpuData;
+        size_t fCpuRowBytes = 0;
+    };
+    GrColorType dstCT = SkColorTypeToGrColorType(colorType);
+    STArray<8, TransferLayout> layouts;
+    size_t bufferSize = 0;
+    for (size_t i = 0; i < contexts.size(); ++i) {
+        TransferLayout& layout = layouts.push_back(contexts[i]->transferLayout(dstCT, rects[i]));
+        if (layout.fSize) {
+            bufferSize = SkAlignTo(bufferSize, layout.fOffsetAlignment) + layout.fSize;
+        }
+    }
+
+    auto mappedBufferManager = dContext->priv().clientMappedBufferManager();
+    sk_sp<GrGpuBuffer> buffer;
+    if (bufferSize) {
+        buffer = mappedBufferManager->takeRecycledBuffer(bufferSize);
+        if (!buffer) {
+            buffer = dContext->priv().resourceProvider()->createBuffer(
+                    bufferSize,
+                    GrGpuBufferType::kXferGpuToCpu,
+                    GrAccessPattern::kStream_GrAccessPattern,
+                    GrResourceProvider::ZeroInit::kNo);
+        }
+        if (!buffer) {
+            callback(callbackContext, nullptr);
+            return;
+        }
+    }
+
+    struct FinishContext {
+        ReadPixelsCallback* fClientCallback;
+        ReadPixelsContext fClientContext;
+        GrClientMappedBufferManager* fMappedBufferManager;
+        sk_sp<GrGpuBuffer> fBuffer;
+        TArray<Request> fRequests;
+
+        std::unique_ptr<AsyncReadResult> makeResult() {
+            auto result = std::make_unique<AsyncReadResult>(fMappedBufferManager->ownerID());
+            const char* mappedData = nullptr;
+            if (fBuffer) {
+                mappedData = static_cast<const char*>(fBuffer->map());
+                if (!mappedData) {
+                    return nullptr;
+                }
+            }
+            bool holdsBuffer = false;
+            for (Request& request : fRequests) {
+                const PixelTransferResult& transfer = request.fTransfer;
+                if (!transfer.fTransferBuffer) {
+                    result->addCpuPlane(std::move(request.fCpuData), request.fCpuRowBytes);
+                } else if (transfer.fPixelConverter) {
+                    sk_sp<SkData> data =
+                            SkData::MakeUninitialized(transfer.fRowBytes * request.fSize.height());
+                    transfer.fPixelConverter(data->writable_data(), mappedData + request.fOffset);
+                    result->addCpuPlane(std::move(data), transfer.fRowBytes);
+                } else {
+                    result->addMappedPlane(fBuffer, request.fOffset, transfer.fRowBytes);
+                    holdsBuffer = true;
+                }
+            }
+            // The buffer goes back to the manager, to be reused once nothing reads from it.
+            if (holdsBuffer) {
+                fMappedBufferManager->insertRecyclable(std::move(fBuffer));
+            } else if (fBuffer) {
+                fBuffer->unmap();
+                fMappedBufferManager->recycle(std::move(fBuffer));
+            }
+            return result;
+        }
+    };
+    auto finishContext = std::make_unique<FinishContext>();
+    finishContext->fClientCallback = callback;
+    finishContext->fClientContext = callbackContext;
+    finishContext->fMappedBufferManager = mappedBufferManager;
+    finishContext->fBuffer = buffer;
+
+    STArray<8, GrSurfaceProxy*> proxies;
+    size_t offset = 0;
+    for (size_t i = 0; i < contexts.size(); ++i) {
+        SurfaceContext* sc = contexts[i];
+        Request& request = finishContext->fRequests.push_back();
+        request.fSize = rects[i].size();
+        if (layouts[i].fSize) {
+            offset = SkAlignTo(offset, layouts[i].fOffsetAlignment);
+            request.fOffset = offset;
+            request.fTransfer = sc->transferPixels(dstCT, rects[i], layouts[i], buffer, offset);
+            offset += layouts[i].fSize;
+            proxies.push_back(sc->asSurfaceProxy());
+            continue;
+        }
+        auto ii = SkImageInfo::Make(rects[i].size(), colorType, sc->colorInfo().alphaType(),
+                                    sc->colorInfo().refColorSpace());
+        GrPixmap pm = GrPixmap::Allocate(ii);
+        if (!sc->readPixels(dContext, pm, rects[i].topLeft())) {
+            callback(callbackContext, nullptr);
+            return;
+        }
+        request.fCpuData = pm.pixelStorage();
+        request.fCpuRowBytes = pm.rowBytes();
+    }
+
+    if (proxies.empty()) {
+        callback(callbackContext, finishContext->makeResult());
+        return;
+    }
+
+    // All of the transfers are flushed together, with one callback once they are all done.
+    auto finishCallback = [](GrGpuFinishedContext c) {
+        std::unique_ptr<FinishContext> context(reinterpret_cast<FinishContext*>(c));
+        (*context->fClientCallback)(context->fClientContext, context->makeResult());
+    };
+    GrFlushInfo flushInfo;
+    flushInfo.fFinishedContext = finishContext.release();
+    flushInfo.fFinishedProc = finishCallback;
+
+    dContext->priv().flushSurfaces(proxies, SkSurfaces::BackendSurfaceAccess::kNoAccess, flushInfo);
+}
+
 void SurfaceContext::asyncRescaleAndReadPixelsYUV420(GrDirectContext* dContext,
                                                      SkYUVColorSpace yuvColorSpace,
                                                      bool readAlpha,
@@ -1295,8 +1443,8 @@ bool SurfaceContext::rescaleInto(SurfaceFillContext* dst,
     return true;
 }
 
-SurfaceContext::PixelTransferResult SurfaceContext::transferPixels(GrColorType dstCT,
-                                                                   const SkIRect& rect) {
+SurfaceContext::TransferLayout SurfaceContext::transferLayout(GrColorType dstCT,
+                                                              const SkIRect& rect) {
     SkASSERT(rect.fLeft >= 0 && rect.fRight <= this->width());
     SkASSERT(rect.fTop >= 0 && rect.fBottom <= this->height());
     auto direct = fContext->asDirectContext();
@@ -1325,20 +1473,42 @@ SurfaceContext::PixelTransferResult SurfaceContext::transferPixels(GrColorType d
         return {};
     }
 
-    size_t rowBytes = GrColorTypeBytesPerPixel(supportedRead.fColorType) * rect.width();
-    rowBytes = SkAlignTo(rowBytes, this->caps()->transferBufferRowBytesAlignment());
-    size_t size = rowBytes * rect.height();
+    TransferLayout layout;
+    layout.fReadColorType = supportedRead.fColorType;
+    layout.fRowBytes = GrColorTypeBytesPerPixel(supportedRead.fColorType) * rect.width();
+    layout.fRowBytes = SkAlignTo(layout.fRowBytes, this->caps()->transferBufferRowBytesAlignment());
+    layout.fSize = layout.fRowBytes * rect.height();
+    layout.fOffsetAlignment = supportedRead.fOffsetAlignmentForTransferBuffer;
+    return layout;
+}
+
+SurfaceContext::PixelTransferResult SurfaceContext::transferPixels(GrColorType dstCT,
+                                                                   const SkIRect& rect) {
+    TransferLayout layout = this->transferLayout(dstCT, rect);
+    if (!layout.fSize) {
+        return {};
+    }
     // By using kStream_GrAccessPattern here, we are not able to cache and reuse the buffer for
     // multiple reads. Switching to kDynamic_GrAccessPattern would allow for this, however doing
     // so causes a crash in a chromium test. See skbug.com/11297
-    auto buffer = direct->priv().resourceProvider()->createBuffer(
-            size,
+    auto buffer = fContext->asDirectContext()->priv().resourceProvider()->createBuffer(
+            layout.fSize,
             GrGpuBufferType::kXferGpuToCpu,
             GrAccessPattern::kStream_GrAccessPattern,
             GrResourceProvider::ZeroInit::kNo);
     if (!buffer) {
         return {};
     }
+    return this->transferPixels(dstCT, rect, layout, std::move(buffer), 0);
+}
+
+SurfaceContext::PixelTransferResult SurfaceContext::transferPixels(GrColorType dstCT,
+                                                                   const SkIRect& rect,
+                                                                   const TransferLayout& layout,
+                                                                   sk_sp<GrGpuBuffer> buffer,
+                                                                   size_t offset) {
+    SkASSERT(layout.fSize && offset % layout.fOffsetAlignment == 0);
+    SkASSERT(offset + layout.fSize <= buffer->size());
     auto srcRect = rect;
     bool flip = this->origin() == kBottomLeft_GrSurfaceOrigin;
     if (flip) {
@@ -1347,22 +1517,22 @@ SurfaceContext::PixelTransferResult SurfaceContext::transferPixels(GrColorType d
     }
     this->drawingManager()->newTransferFromRenderTask(this->asSurfaceProxyRef(), srcRect,
                                                       this->colorInfo().colorType(),
-                                                      supportedRead.fColorType, buffer, 0);
+                                                      layout.fReadColorType, buffer, offset);
     PixelTransferResult result;
     result.fTransferBuffer = std::move(buffer);
     auto at = this->colorInfo().alphaType();
-    if (supportedRead.fColorType != dstCT || flip) {
+    if (layout.fReadColorType != dstCT || flip) {
         int w = rect.width(), h = rect.height();
-        GrImageInfo srcInfo(supportedRead.fColorType, at, nullptr, w, h);
+        GrImageInfo srcInfo(layout.fReadColorType, at, nullptr, w, h);
         GrImageInfo dstInfo(dstCT, at, nullptr, w, h);
         result.fRowBytes = dstInfo.minRowBytes();
-        result.fPixelConverter = [dstInfo, srcInfo, rowBytes](
+        result.fPixelConverter = [dstInfo, srcInfo, rowBytes = layout.fRowBytes](
                 void* dst, const void* src) {
             GrConvertPixels( GrPixmap(dstInfo, dst, dstInfo.minRowBytes()),
                             GrCPixmap(srcInfo, src, rowBytes));
         };
     } else {
-        result.fRowBytes = rowBytes;
+        result.fRowBytes = layout.fRowBytes;
     }
     return result;
 }
@@ -12,6 +12,7 @@
 #include "include/core/SkRect.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkSamplingOptions.h"
+#include "include/core/SkSpan.h"
 #include "include/core/SkSurface.h"
 #include "src/gpu/ganesh/GrColorInfo.h"
 #include "src/gpu/ganesh/GrDataUtils.h"
@@ -101,6 +102,15 @@ public:
                                          ReadPixelsCallback callback,
                                          ReadPixelsContext context);
 
+    // GPU implementation for GrDirectContext::asyncReadPixelsBatch. 'contexts' and 'rects' are
+    // the same size.
+    static void AsyncReadPixelsBatch(GrDirectContext*,
+                                     SkSpan<SurfaceContext* const> contexts,
+                                     SkSpan<const SkIRect> rects,
+                                     SkColorType,
+                                     ReadPixelsCallback callback,
+                                     ReadPixelsContext callbackContext);
+
     /**
      * Writes a rectangle of pixels from src into the surfaceDrawContext at the specified position.
      * @param dContext         The direct context to use
@@ -202,6 +212,24 @@ protected:
     };
     PixelTransferResult transferPixels(GrColorType colorType, const SkIRect& rect);
 
+    // How a transfer of rect, read as colorType, is laid out in a transfer buffer. fSize is zero
+    // if the transfer cannot be performed.
+    struct TransferLayout {
+        GrColorType fReadColorType = GrColorType::kUnknown;
+        size_t fRowBytes = 0;
+        size_t fSize = 0;
+        size_t fOffsetAlignment = 0;
+    };
+    TransferLayout transferLayout(GrColorType colorType, const SkIRect& rect);
+
+    // Inserts a transfer laid out by transferLayout() into buffer at offset, which must be a
+    // multiple of the layout's fOffsetAlignment.
+    PixelTransferResult transferPixels(GrColorType colorType,
+                                       const SkIRect& rect,
+                                       const TransferLayout&,
+                                       sk_sp<GrGpuBuffer> buffer,
+                                       size_t offset);
+
     // The async read step of asyncRescaleAndReadPixels()
     void asyncReadPixels(GrDirectContext*,
                          const SkIRect& srcRect,
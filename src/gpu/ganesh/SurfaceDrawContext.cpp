@@ -26,6 +26,7 @@
 #include "src/core/SkLatticeIter.h"
 #include "src/core/SkMatrixPriv.h"
 #include "src/core/SkMeshPriv.h"
+#include "src/core/SkPathPriv.h"
 #include "src/core/SkPointPriv.h"
 #include "src/core/SkRRectPriv.h"
 #include "src/core/SkStrikeCache.h"
@@ -1102,6 +1103,35 @@ void SurfaceDrawContext::drawRRect(const GrClip* origClip,
 
 ///////////////////////////////////////////////////////////////////////////////
 
+// Gets the points of 'path' if it is a single convex contour of lines, which drawFastShadow() can
+// shadow analytically.
+static bool get_shadow_polygon(const SkPath& path, TArray<SkPoint, true>* points) {
+    if (!path.isConvex() || path.getSegmentMasks() != SkPath::kLine_SegmentMask ||
+        path.countPoints() > ShadowRRectOp::kMaxPolygonPoints) {
+        return false;
+    }
+    bool sawMove = false;
+    for (auto [verb, pts, w] : SkPathPriv::Iterate(path)) {
+        switch (verb) {
+            case SkPathVerb::kMove:
+                if (sawMove) {
+                    return false;
+                }
+                sawMove = true;
+                points->push_back(pts[0]);
+                break;
+            case SkPathVerb::kLine:
+                points->push_back(pts[1]);
+                break;
+            case SkPathVerb::kClose:
+                break;
+            default:
+                return false;
+        }
+    }
+    return points->size() >= 3;
+}
+
 bool SurfaceDrawContext::drawFastShadow(const GrClip* clip,
                                         const SkMatrix& viewMatrix,
                                         const SkPath& path,
@@ -1137,11 +1167,13 @@ bool SurfaceDrawContext::drawFastShadow(const GrClip* clip,
         isRRect = true;
     }
 
-    if (!isRRect) {
+    // Other convex polygons are drawn analytically too, as long as they aren't too thin.
+    STArray<16, SkPoint, true> polygon;
+    if (!isRRect && !get_shadow_polygon(path, &polygon)) {
         return false;
     }
 
-    if (rrect.isEmpty()) {
+    if (isRRect && rrect.isEmpty()) {
         return true;
     }
 
@@ -1163,41 +1195,56 @@ bool SurfaceDrawContext::drawFastShadow(const GrClip* clip,
     SkScalar occluderHeight = rec.fZPlaneParams.fZ;
     bool transparent = SkToBool(rec.fFlags & SkShadowFlags::kTransparentOccluder_ShadowFlag);
 
+    // Both ops are made before either is added, so that a polygon the ops can't handle falls back
+    // to a tessellated shadow as a whole.
+    GrOp::Owner ambientOp;
+    GrOp::Owner spotOp;
+
     if (SkColorGetA(rec.fAmbientColor) > 0) {
         SkScalar devSpaceInsetWidth = SkDrawShadowMetrics::AmbientBlurRadius(occluderHeight);
         const SkScalar umbraRecipAlpha = SkDrawShadowMetrics::AmbientRecipAlpha(occluderHeight);
         const SkScalar devSpaceAmbientBlur = devSpaceInsetWidth * umbraRecipAlpha;
 
-        // Outset the shadow rrect to the border of the penumbra
-        SkScalar ambientPathOutset = devSpaceInsetWidth * devToSrcScale;
-        SkRRect ambientRRect;
-        SkRect outsetRect = rrect.rect().makeOutset(ambientPathOutset, ambientPathOutset);
-        // If the rrect was an oval then its outset will also be one.
-        // We set it explicitly to avoid errors.
-        if (rrect.isOval()) {
-            ambientRRect = SkRRect::MakeOval(outsetRect);
-        } else {
-            SkScalar outsetRad = SkRRectPriv::GetSimpleRadii(rrect).fX + ambientPathOutset;
-            ambientRRect = SkRRect::MakeRectXY(outsetRect, outsetRad, outsetRad);
-        }
-
         // The ShadowRRectOp still uses 8888 colors, so it might get clamped if the shadow color
         // does not fit in bytes after being transformed to the destination color space. This can
         // happen if the destination color space is smaller than sRGB, which is highly unlikely.
         GrColor ambientColor = SkColorToPMColor4f(rec.fAmbientColor, colorInfo()).toBytes_RGBA();
-        if (transparent) {
-            // set a large inset to force a fill
-            devSpaceInsetWidth = ambientRRect.width();
-        }
+        if (!isRRect) {
+            // The polygon fills its shadow regardless, so transparency doesn't matter.
+            ambientOp = ShadowRRectOp::MakeConvexPolygon(fContext,
+                                                         ambientColor,
+                                                         viewMatrix,
+                                                         polygon,
+                                                         devSpaceInsetWidth,
+                                                         devSpaceAmbientBlur);
+            if (!ambientOp) {
+                return false;
+            }
+        } else {
+            // Outset the shadow rrect to the border of the penumbra
+            SkScalar ambientPathOutset = devSpaceInsetWidth * devToSrcScale;
+            SkRRect ambientRRect;
+            SkRect outsetRect = rrect.rect().makeOutset(ambientPathOutset, ambientPathOutset);
+            // If the rrect was an oval then its outset will also be one.
+            // We set it explicitly to avoid errors.
+            if (rrect.isOval()) {
+                ambientRRect = SkRRect::MakeOval(outsetRect);
+            } else {
+                SkScalar outsetRad = SkRRectPriv::GetSimpleRadii(rrect).fX + ambientPathOutset;
+                ambientRRect = SkRRect::MakeRectXY(outsetRect, outsetRad, outsetRad);
+            }
 
-        GrOp::Owner op = ShadowRRectOp::Make(fContext,
-                                             ambientColor,
-                                             viewMatrix,
-                                             ambientRRect,
-                                             devSpaceAmbientBlur,
-                                             devSpaceInsetWidth);
-        if (op) {
-            this->addDrawOp(clip, std::move(op));
+            if (transparent) {
+                // set a large inset to force a fill
+                devSpaceInsetWidth = ambientRRect.width();
+            }
+
+            ambientOp = ShadowRRectOp::Make(fContext,
+                                            ambientColor,
+                                            viewMatrix,
+                                            ambientRRect,
+                                            devSpaceAmbientBlur,
+                                            devSpaceInsetWidth);
         }
     }
 
@@ -1231,83 +1278,104 @@ bool SurfaceDrawContext::drawFastShadow(const GrClip* clip,
             SkASSERT(false);
         }
 
-        // Compute the transformed shadow rrect
-        SkRRect spotShadowRRect;
+        // Compute the transformed shadow geometry
         SkMatrix shadowTransform;
         shadowTransform.setScaleTranslate(spotScale, spotScale, spotOffset.fX, spotOffset.fY);
-        rrect.transform(shadowTransform, &spotShadowRRect);
-        SkScalar spotRadius = spotShadowRRect.getSimpleRadii().fX;
-
-        // Compute the insetWidth
-        SkScalar blurOutset = srcSpaceSpotBlur;
-        SkScalar insetWidth = blurOutset;
-        if (transparent) {
-            // If transparent, just do a fill
-            insetWidth += spotShadowRRect.width();
-        } else {
-            // For shadows, instead of using a stroke we specify an inset from the penumbra
-            // border. We want to extend this inset area so that it meets up with the caster
-            // geometry. The inset geometry will by default already be inset by the blur width.
-            //
-            // We compare the min and max corners inset by the radius between the original
-            // rrect and the shadow rrect. The distance between the two plus the difference
-            // between the scaled radius and the original radius gives the distance from the
-            // transformed shadow shape to the original shape in that corner. The max
-            // of these gives the maximum distance we need to cover.
-            //
-            // Since we are outsetting by 1/2 the blur distance, we just add the maxOffset to
-            // that to get the full insetWidth.
-            SkScalar maxOffset;
-            if (rrect.isRect()) {
-                // Manhattan distance works better for rects
-                maxOffset = std::max(std::max(SkTAbs(spotShadowRRect.rect().fLeft -
-                                                 rrect.rect().fLeft),
-                                          SkTAbs(spotShadowRRect.rect().fTop -
-                                                 rrect.rect().fTop)),
-                                   std::max(SkTAbs(spotShadowRRect.rect().fRight -
-                                                 rrect.rect().fRight),
-                                          SkTAbs(spotShadowRRect.rect().fBottom -
-                                                 rrect.rect().fBottom)));
-            } else {
-                SkScalar dr = spotRadius - SkRRectPriv::GetSimpleRadii(rrect).fX;
-                SkPoint upperLeftOffset = SkPoint::Make(spotShadowRRect.rect().fLeft -
-                                                        rrect.rect().fLeft + dr,
-                                                        spotShadowRRect.rect().fTop -
-                                                        rrect.rect().fTop + dr);
-                SkPoint lowerRightOffset = SkPoint::Make(spotShadowRRect.rect().fRight -
-                                                         rrect.rect().fRight - dr,
-                                                         spotShadowRRect.rect().fBottom -
-                                                         rrect.rect().fBottom - dr);
-                maxOffset = SkScalarSqrt(std::max(SkPointPriv::LengthSqd(upperLeftOffset),
-                                                  SkPointPriv::LengthSqd(lowerRightOffset))) + dr;
-            }
-            insetWidth += std::max(blurOutset, maxOffset);
-        }
-
-        // Outset the shadow rrect to the border of the penumbra
-        SkRect outsetRect = spotShadowRRect.rect().makeOutset(blurOutset, blurOutset);
-        if (spotShadowRRect.isOval()) {
-            spotShadowRRect = SkRRect::MakeOval(outsetRect);
-        } else {
-            SkScalar outsetRad = spotRadius + blurOutset;
-            spotShadowRRect = SkRRect::MakeRectXY(outsetRect, outsetRad, outsetRad);
-        }
 
         // The ShadowRRectOp still uses 8888 colors, so it might get clamped if the shadow color
         // does not fit in bytes after being transformed to the destination color space. This can
         // happen if the destination color space is smaller than sRGB, which is highly unlikely.
         GrColor spotColor = SkColorToPMColor4f(rec.fSpotColor, colorInfo()).toBytes_RGBA();
-        GrOp::Owner op = ShadowRRectOp::Make(fContext,
-                                             spotColor,
-                                             viewMatrix,
-                                             spotShadowRRect,
-                                             2.0f * devSpaceSpotBlur,
-                                             insetWidth);
-        if (op) {
-            this->addDrawOp(clip, std::move(op));
+        if (!isRRect) {
+            STArray<16, SkPoint, true> spotPolygon(polygon.size());
+            spotPolygon.push_back_n(polygon.size());
+            shadowTransform.mapPoints(spotPolygon.begin(), polygon.begin(), polygon.size());
+            // The penumbra reaches half the blur width outside the transformed polygon.
+            spotOp = ShadowRRectOp::MakeConvexPolygon(fContext,
+                                                      spotColor,
+                                                      viewMatrix,
+                                                      spotPolygon,
+                                                      devSpaceSpotBlur,
+                                                      2.0f * devSpaceSpotBlur);
+            if (!spotOp) {
+                return false;
+            }
+        } else {
+            SkRRect spotShadowRRect;
+            rrect.transform(shadowTransform, &spotShadowRRect);
+            SkScalar spotRadius = spotShadowRRect.getSimpleRadii().fX;
+
+            // Compute the insetWidth
+            SkScalar blurOutset = srcSpaceSpotBlur;
+            SkScalar insetWidth = blurOutset;
+            if (transparent) {
+                // If transparent, just do a fill
+                insetWidth += spotShadowRRect.width();
+            } else {
+                // For shadows, instead of using a stroke we specify an inset from the penumbra
+                // border. We want to extend this inset area so that it meets up with the caster
+                // geometry. The inset geometry will by default already be inset by the blur width.
+                //
+                // We compare the min and max corners inset by the radius between the original
+                // rrect and the shadow rrect. The distance between the two plus the difference
+                // between the scaled radius and the original radius gives the distance from the
+                // transformed shadow shape to the original shape in that corner. The max
+                // of these gives the maximum distance we need to cover.
+                //
+                // Since we are outsetting by 1/2 the blur distance, we just add the maxOffset to
+                // that to get the full insetWidth.
+                SkScalar maxOffset;
+                if (rrect.isRect()) {
+                    // Manhattan distance works better for rects
+                    maxOffset = std::max(std::max(SkTAbs(spotShadowRRect.rect().fLeft -
+                                                     rrect.rect().fLeft),
+                                              SkTAbs(spotShadowRRect.rect().fTop -
+                                                     rrect.rect().fTop)),
+                                       std::max(SkTAbs(spotShadowRRect.rect().fRight -
+                                                     rrect.rect().fRight),
+                                              SkTAbs(spotShadowRRect.rect().fBottom -
+                                                     rrect.rect().fBottom)));
+                } else {
+                    SkScalar dr = spotRadius - SkRRectPriv::GetSimpleRadii(rrect).fX;
+                    SkPoint upperLeftOffset = SkPoint::Make(spotShadowRRect.rect().fLeft -
+                                                            rrect.rect().fLeft + dr,
+                                                            spotShadowRRect.rect().fTop -
+                                                            rrect.rect().fTop + dr);
+                    SkPoint lowerRightOffset = SkPoint::Make(spotShadowRRect.rect().fRight -
+                                                             rrect.rect().fRight - dr,
+                                                             spotShadowRRect.rect().fBottom -
+                                                             rrect.rect().fBottom - dr);
+                    maxOffset = SkScalarSqrt(
+                            std::max(SkPointPriv::LengthSqd(upperLeftOffset),
+                                     SkPointPriv::LengthSqd(lowerRightOffset))) + dr;
+                }
+                insetWidth += std::max(blurOutset, maxOffset);
+            }
+
+            // Outset the shadow rrect to the border of the penumbra
+            SkRect outsetRect = spotShadowRRect.rect().makeOutset(blurOutset, blurOutset);
+            if (spotShadowRRect.isOval()) {
+                spotShadowRRect = SkRRect::MakeOval(outsetRect);
+            } else {
+                SkScalar outsetRad = spotRadius + blurOutset;
+                spotShadowRRect = SkRRect::MakeRectXY(outsetRect, outsetRad, outsetRad);
+            }
+
+            spotOp = ShadowRRectOp::Make(fContext,
+                                         spotColor,
+                                         viewMatrix,
+                                         spotShadowRRect,
+                                         2.0f * devSpaceSpotBlur,
+                                         insetWidth);
         }
     }
 
+    if (ambientOp) {
+        this->addDrawOp(clip, std::move(ambientOp));
+    }
+    if (spotOp) {
+        this->addDrawOp(clip, std::move(spotOp));
+    }
     return true;
 }
 
@@ -393,6 +393,7 @@ GrStyledShape::GrStyledShape(const GrStyledShape& parent, GrStyle::Apply apply,
                 tmpPath.init();
             }
             tmpParent->asPath(tmpPath.get());
+            tmpPath->setIsVolatile(true);
             SkStrokeRec::InitStyle fillOrHairline;
             // The parent shape may have simplified away the strokeRec, check for that here.
             if (tmpParent->style().applies()) {
@@ -416,6 +417,8 @@ GrStyledShape::GrStyledShape(const GrStyledShape& parent, GrStyle::Apply apply,
         } else {
             srcForParentStyle = tmpPath.init();
             parent.asPath(tmpPath.get());
+            // A temporary path; keep its stroke out of SkStrokeCache.
+            tmpPath->setIsVolatile(true);
         }
         SkStrokeRec::InitStyle fillOrHairline;
         SkASSERT(parent.fStyle.applies());
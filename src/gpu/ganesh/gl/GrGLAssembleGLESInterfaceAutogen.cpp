@@ -432,25 +432,29 @@ sk_sp<const GrGLInterface> GrGLMakeAssembledGLESInterface(void *ctx, GrGLGetProc
     }
 
     if (glVer >= GR_GL_VER(3,0)) {
-#if defined(GR_TEST_UTILS)
         GET_PROC(BeginQuery);
         GET_PROC(DeleteQueries);
         GET_PROC(EndQuery);
         GET_PROC(GenQueries);
         GET_PROC(GetQueryObjectuiv);
+#if defined(GR_TEST_UTILS)
         GET_PROC(GetQueryiv);
 #endif
     } else if (extensions.has("GL_EXT_occlusion_query_boolean")) {
-#if defined(GR_TEST_UTILS)
         GET_PROC_SUFFIX(BeginQuery, EXT);
         GET_PROC_SUFFIX(DeleteQueries, EXT);
         GET_PROC_SUFFIX(EndQuery, EXT);
         GET_PROC_SUFFIX(GenQueries, EXT);
         GET_PROC_SUFFIX(GetQueryObjectuiv, EXT);
+#if defined(GR_TEST_UTILS)
         GET_PROC_SUFFIX(GetQueryiv, EXT);
 #endif
     }
 
+    if (extensions.has("GL_EXT_disjoint_timer_query")) {
+        GET_PROC_SUFFIX(GetQueryObjectui64v, EXT);
+    }
+
     if (extensions.has("GL_ARB_invalidate_subdata")) {
         GET_PROC(InvalidateBufferData);
         GET_PROC(InvalidateBufferSubData);
@@ -466,6 +470,10 @@ sk_sp<const GrGLInterface> GrGLMakeAssembledGLESInterface(void *ctx, GrGLGetProc
         GET_PROC(InvalidateSubFramebuffer);
     }
 
+    if (extensions.has("GL_EXT_buffer_storage")) {
+        GET_PROC_SUFFIX(BufferStorage, EXT);
+    }
+
     GET_PROC(GetShaderPrecisionFormat);
 
     if (extensions.has("GL_NV_fence")) {
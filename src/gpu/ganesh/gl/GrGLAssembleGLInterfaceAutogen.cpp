@@ -438,12 +438,12 @@ sk_sp<const GrGLInterface> GrGLMakeAssembledGLInterface(void *ctx, GrGLGetProc g
 
     GET_PROC(GetQueryObjectiv);
 
-#if defined(GR_TEST_UTILS)
     GET_PROC(BeginQuery);
     GET_PROC(DeleteQueries);
     GET_PROC(EndQuery);
     GET_PROC(GenQueries);
     GET_PROC(GetQueryObjectuiv);
+#if defined(GR_TEST_UTILS)
     GET_PROC(GetQueryiv);
 #endif
 
@@ -484,6 +484,12 @@ sk_sp<const GrGLInterface> GrGLMakeAssembledGLInterface(void *ctx, GrGLGetProc g
         GET_PROC(InvalidateSubFramebuffer);
     }
 
+    if (glVer >= GR_GL_VER(4,4)) {
+        GET_PROC(BufferStorage);
+    } else if (extensions.has("GL_ARB_buffer_storage")) {
+        GET_PROC(BufferStorage);
+    }
+
     if (glVer >= GR_GL_VER(4,3)) {
         GET_PROC(GetShaderPrecisionFormat);
     } else if (extensions.has("GL_ARB_ES2_compatibility")) {
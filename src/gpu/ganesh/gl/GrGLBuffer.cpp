@@ -8,11 +8,14 @@
 #include "src/gpu/ganesh/gl/GrGLBuffer.h"
 
 #include "include/core/SkTraceMemoryDump.h"
+#include "include/private/base/SkTemplates.h"
 #include "src/core/SkTraceEvent.h"
 #include "src/gpu/ganesh/GrGpuResourcePriv.h"
 #include "src/gpu/ganesh/gl/GrGLCaps.h"
 #include "src/gpu/ganesh/gl/GrGLGpu.h"
 
+#include <cstring>
+
 #define GL_CALL(X) GR_GL_CALL(this->glGpu()->glInterface(), X)
 #define GL_CALL_RET(RET, X) GR_GL_CALL_RET(this->glGpu()->glInterface(), RET, X)
 
@@ -100,6 +103,27 @@ inline static GrGLenum gr_to_gl_access_pattern(GrGpuBufferType bufferType,
     return usageType(bufferType, accessPattern);
 }
 
+// Only buffers the CPU writes and the GPU reads, and that are written again each time they are
+// reused, are worth keeping mapped.
+static bool use_persistent_mapping(GrGpuBufferType bufferType,
+                                   GrAccessPattern accessPattern,
+                                   const GrGLCaps& caps) {
+    if (!caps.persistentBufferMapSupport() || accessPattern != kDynamic_GrAccessPattern) {
+        return false;
+    }
+    switch (bufferType) {
+        case GrGpuBufferType::kVertex:
+        case GrGpuBufferType::kIndex:
+        case GrGpuBufferType::kDrawIndirect:
+            return true;
+        case GrGpuBufferType::kXferCpuToGpu:
+        case GrGpuBufferType::kXferGpuToCpu:
+        case GrGpuBufferType::kUniform:
+            return false;
+    }
+    SkUNREACHABLE;
+}
+
 GrGLBuffer::GrGLBuffer(GrGLGpu* gpu,
                        size_t size,
                        GrGpuBufferType intendedType,
@@ -113,11 +137,17 @@ GrGLBuffer::GrGLBuffer(GrGLGpu* gpu,
     GL_CALL(GenBuffers(1, &fBufferID));
     if (fBufferID) {
         GrGLenum target = gpu->bindBuffer(fIntendedType, this);
-        GrGLenum error = GL_ALLOC_CALL(this->glGpu(), BufferData(target,
-                                                                 (GrGLsizeiptr)size,
-                                                                 nullptr,
-                                                                 fUsage));
-        if (error != GR_GL_NO_ERROR) {
+        bool created;
+        if (use_persistent_mapping(intendedType, accessPattern, gpu->glCaps())) {
+            created = this->createPersistentStorage(target);
+        } else {
+            GrGLenum error = GL_ALLOC_CALL(this->glGpu(), BufferData(target,
+                                                                     (GrGLsizeiptr)size,
+                                                                     nullptr,
+                                                                     fUsage));
+            created = error == GR_GL_NO_ERROR;
+        }
+        if (!created) {
             GL_CALL(DeleteBuffers(1, &fBufferID));
             fBufferID = 0;
         }
@@ -128,6 +158,22 @@ GrGLBuffer::GrGLBuffer(GrGLGpu* gpu,
     }
 }
 
+bool GrGLBuffer::createPersistentStorage(GrGLenum target) {
+    static constexpr GrGLbitfield kFlags =
+            GR_GL_MAP_WRITE_BIT | GR_GL_MAP_PERSISTENT_BIT | GR_GL_MAP_COHERENT_BIT;
+    GrGLenum error = GL_ALLOC_CALL(this->glGpu(), BufferStorage(target,
+                                                                (GrGLsizeiptr)this->size(),
+                                                                nullptr,
+                                                                kFlags));
+    if (error != GR_GL_NO_ERROR) {
+        return false;
+    }
+    // Since the mapping is coherent, writes are seen by any GL command issued after them without
+    // having to flush or unmap.
+    GL_CALL_RET(fPersistentMapPtr, MapBufferRange(target, 0, this->size(), kFlags));
+    return SkToBool(fPersistentMapPtr);
+}
+
 inline GrGLGpu* GrGLBuffer::glGpu() const {
     SkASSERT(!this->wasDestroyed());
     return static_cast<GrGLGpu*>(this->getGpu());
@@ -147,6 +193,7 @@ void GrGLBuffer::onRelease() {
             fBufferID = 0;
         }
         fMapPtr = nullptr;
+        fPersistentMapPtr = nullptr;
     }
 
     INHERITED::onRelease();
@@ -155,6 +202,7 @@ void GrGLBuffer::onRelease() {
 void GrGLBuffer::onAbandon() {
     fBufferID = 0;
     fMapPtr = nullptr;
+    fPersistentMapPtr = nullptr;
     INHERITED::onAbandon();
 }
 
@@ -180,6 +228,13 @@ void GrGLBuffer::onMap(MapType type) {
     SkASSERT(!this->wasDestroyed());
     SkASSERT(!this->isMapped());
 
+    if (fPersistentMapPtr) {
+        SkASSERT(type == MapType::kWriteDiscard);
+        this->glGpu()->willWritePersistentBuffer(this);
+        fMapPtr = fPersistentMapPtr;
+        return;
+    }
+
     // Handling dirty context is done in the bindBuffer call
     switch (this->glCaps().mapBufferType()) {
         case GrGLCaps::kNone_MapBufferType:
@@ -225,6 +280,10 @@ void GrGLBuffer::onMap(MapType type) {
 
 void GrGLBuffer::onUnmap(MapType) {
     SkASSERT(fBufferID);
+    if (fPersistentMapPtr) {
+        fMapPtr = nullptr;
+        return;
+    }
     // bind buffer handles the dirty context
     switch (this->glCaps().mapBufferType()) {
         case GrGLCaps::kNone_MapBufferType:
@@ -263,6 +322,12 @@ bool GrGLBuffer::onClearToZero() {
 bool GrGLBuffer::onUpdateData(const void* src, size_t offset, size_t size, bool preserve) {
     SkASSERT(fBufferID);
 
+    if (fPersistentMapPtr) {
+        this->glGpu()->willWritePersistentBuffer(this);
+        memcpy(SkTAddOffset<void>(fPersistentMapPtr, offset), src, size);
+        return true;
+    }
+
     // bindbuffer handles dirty context
     GrGLenum target = this->glGpu()->bindBuffer(fIntendedType, this);
     if (!preserve) {
@@ -9,6 +9,7 @@
 #define GrGLBuffer_DEFINED
 
 #include "include/gpu/gl/GrGLTypes.h"
+#include "include/private/base/SkTo.h"
 #include "src/gpu/ganesh/GrGpuBuffer.h"
 
 class GrGLGpu;
@@ -31,6 +32,20 @@ public:
     void setHasAttachedToTexture() { fHasAttachedToTexture = true; }
     bool hasAttachedToTexture() const { return fHasAttachedToTexture; }
 
+    /**
+     * Buffers made with glBufferStorage stay mapped for as long as they live. Instead of relying on
+     * GL to synchronize writes, GrGLGpu tracks which of them the GPU may still be reading.
+     */
+    bool isPersistentlyMapped() const { return SkToBool(fPersistentMapPtr); }
+
+    enum class GpuUse {
+        kNone,
+        kPendingSubmit,  // Written since the last submit.
+        kSubmitted,      // Written before a submit whose fence hasn't signaled yet.
+    };
+    GpuUse gpuUse() const { return fGpuUse; }
+    void setGpuUse(GpuUse use) { fGpuUse = use; }
+
 protected:
     GrGLBuffer(GrGLGpu*,
                size_t size,
@@ -52,12 +67,16 @@ private:
     bool onClearToZero() override;
     bool onUpdateData(const void* src, size_t offset, size_t size, bool preserve) override;
 
+    bool createPersistentStorage(GrGLenum target);
+
     void onSetLabel() override;
 
     GrGpuBufferType fIntendedType;
     GrGLuint        fBufferID;
     GrGLenum        fUsage;
     bool            fHasAttachedToTexture;
+    void*           fPersistentMapPtr = nullptr;
+    GpuUse          fGpuUse = GpuUse::kNone;
 
     using INHERITED = GrGpuBuffer;
 };
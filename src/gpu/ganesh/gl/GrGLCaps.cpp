@@ -98,9 +98,11 @@ GrGLCaps::GrGLCaps(const GrContextOptions& contextOptions,
     fTextureSwizzleSupport = false;
     fTiledRenderingSupport = false;
     fFenceSyncSupport = false;
+    fPersistentBufferMapSupport = false;
     fFBFetchRequiresEnablePerSample = false;
     fSRGBWriteControl = false;
     fSkipErrorChecks = false;
+    fTimerQuerySupport = false;
 
     fShaderCaps = std::make_unique<GrShaderCaps>();
 
@@ -254,6 +256,21 @@ void GrGLCaps::init(const GrContextOptions& contextOptions,
         fES2CompatibilitySupport = true;
     }
 
+    // Timing the GPU needs the 64 bit query results, which ES only has with the disjoint timer
+    // extension. We only make timer queries for GrPerfStats, so nothing is lost without them.
+    if (GR_IS_GR_GL(standard)) {
+        fTimerQuerySupport = version >= GR_GL_VER(3, 3) ||
+                             ctxInfo.hasExtension("GL_ARB_timer_query") ||
+                             ctxInfo.hasExtension("GL_EXT_timer_query");
+    } else if (GR_IS_GR_GL_ES(standard)) {
+        fTimerQuerySupport = ctxInfo.hasExtension("GL_EXT_disjoint_timer_query");
+    }
+    fTimerQuerySupport = fTimerQuerySupport && contextOptions.fEnablePerfStats &&
+                         gli->fFunctions.fGenQueries && gli->fFunctions.fDeleteQueries &&
+                         gli->fFunctions.fBeginQuery && gli->fFunctions.fEndQuery &&
+                         gli->fFunctions.fGetQueryObjectuiv &&
+                         gli->fFunctions.fGetQueryObjectui64v;
+
     if (GR_IS_GR_GL(standard)) {
         fClientCanDisableMultisample = true;
     } else if (GR_IS_GR_GL_ES(standard)) {
@@ -852,6 +869,22 @@ void GrGLCaps::init(const GrContextOptions& contextOptions,
                                                 &formatWorkarounds);
     }
 
+    // Buffers that stay mapped rely on fences to know when the GPU is done reading them. This comes
+    // after the workarounds, which may turn off buffer mapping.
+    if (fMapBufferType == kMapBufferRange_MapBufferType && fFenceSyncSupport &&
+        fFenceType == FenceType::kSyncObject && gli->fFunctions.fBufferStorage) {
+        if (GR_IS_GR_GL(standard)) {
+            fPersistentBufferMapSupport = version >= GR_GL_VER(4, 4) ||
+                                          ctxInfo.hasExtension("GL_ARB_buffer_storage");
+        } else if (GR_IS_GR_GL_ES(standard)) {
+            fPersistentBufferMapSupport = ctxInfo.hasExtension("GL_EXT_buffer_storage");
+        }
+    }
+    // Writing to a persistently mapped buffer costs no more than staging the data in CPU memory.
+    if (fPersistentBufferMapSupport && contextOptions.fBufferMapThreshold < 0) {
+        fBufferMapThreshold = 0;
+    }
+
     // Requires msaa support, ES compatibility have already been detected.
     this->initFormatTable(ctxInfo, gli, formatWorkarounds);
 
@@ -1297,6 +1330,7 @@ void GrGLCaps::onDumpJSON(SkJSONWriter* writer) const {
     writer->appendBool("Texture swizzle support", fTextureSwizzleSupport);
     writer->appendBool("Tiled rendering support", fTiledRenderingSupport);
     writer->appendBool("Fence sync support", fFenceSyncSupport);
+    writer->appendBool("Persistent buffer map support", fPersistentBufferMapSupport);
     writer->appendBool("FB fetch requires enable per sample", fFBFetchRequiresEnablePerSample);
     writer->appendBool("sRGB Write Control", fSRGBWriteControl);
 
@@ -502,6 +502,12 @@ public:
 
     bool tiledRenderingSupport() const { return fTiledRenderingSupport; }
 
+    /**
+     * Can dynamic vertex, index, and indirect buffers be made with glBufferStorage and kept mapped
+     * for their whole lifetime.
+     */
+    bool persistentBufferMapSupport() const { return fPersistentBufferMapSupport; }
+
     bool fbFetchRequiresEnablePerSample() const { return fFBFetchRequiresEnablePerSample; }
 
     /* Is there support for enabling/disabling sRGB writes for sRGB-capable color buffers? */
@@ -515,6 +521,9 @@ public:
 
     bool clientCanDisableMultisample() const { return fClientCanDisableMultisample; }
 
+    /** Are GL_TIME_ELAPSED queries supported, and wanted for GrPerfStats? */
+    bool timerQuerySupport() const { return fTimerQuerySupport; }
+
     GrBackendFormat getBackendFormatFromCompressionType(SkTextureCompressionType) const override;
 
     skgpu::Swizzle getWriteSwizzle(const GrBackendFormat&, GrColorType) const override;
@@ -626,10 +635,12 @@ private:
     bool fTextureSwizzleSupport : 1;
     bool fTiledRenderingSupport : 1;
     bool fFenceSyncSupport : 1;
+    bool fPersistentBufferMapSupport : 1;
     bool fFBFetchRequiresEnablePerSample : 1;
     bool fSRGBWriteControl : 1;
     bool fSkipErrorChecks : 1;
     bool fClientCanDisableMultisample : 1;
+    bool fTimerQuerySupport : 1;
 
     // Driver workarounds
     bool fDoManualMipmapping : 1;
@@ -510,6 +510,13 @@ GrGLGpu::~GrGLGpu() {
 
     fSamplerObjectCache.reset();
 
+    while (!fSubmittedPersistentBuffers.empty()) {
+        this->deleteSync(fSubmittedPersistentBuffers.front().fFence);
+        fSubmittedPersistentBuffers.pop_front();
+    }
+    fPersistentBuffersToSubmit.clear();
+    this->deleteTimerQueries();
+
     fFinishCallbacks.callAll(true);
 }
 
@@ -542,6 +549,10 @@ void GrGLGpu::disconnect(DisconnectType type) {
         if (fSamplerObjectCache) {
             fSamplerObjectCache->release();
         }
+        for (const SubmittedPersistentBuffers& submitted : fSubmittedPersistentBuffers) {
+            this->deleteSync(submitted.fFence);
+        }
+        this->deleteTimerQueries();
     } else {
         if (fProgramCache) {
             fProgramCache->abandon();
@@ -567,6 +578,10 @@ void GrGLGpu::disconnect(DisconnectType type) {
     for (size_t i = 0; i < std::size(fMipmapPrograms); ++i) {
         fMipmapPrograms[i].fProgram = 0;
     }
+    fPersistentBuffersToSubmit.clear();
+    fSubmittedPersistentBuffers.clear();
+    fTimerQueries.clear();
+    fFreeTimerQueries.clear();
 
     fFinishCallbacks.callAll(/* doDelete */ DisconnectType::kCleanup == type);
 }
@@ -4254,6 +4269,16 @@ void GrGLGpu::flush(FlushType flushType) {
 }
 
 bool GrGLGpu::onSubmitToGpu(GrSyncCpu sync) {
+    if (!fPersistentBuffersToSubmit.empty()) {
+        // The fence is inserted before the flush so that it goes to the GPU with the work that
+        // reads the buffers.
+        for (const sk_sp<GrGLBuffer>& buffer : fPersistentBuffersToSubmit) {
+            buffer->setGpuUse(GrGLBuffer::GpuUse::kSubmitted);
+        }
+        fSubmittedPersistentBuffers.push_back({this->insertFence(),
+                                               std::move(fPersistentBuffersToSubmit)});
+        fPersistentBuffersToSubmit.clear();
+    }
     if (sync == GrSyncCpu::kYes ||
         (!fFinishCallbacks.empty() && !this->glCaps().fenceSyncSupport())) {
         this->finishOutstandingGpuWork();
@@ -4263,6 +4288,7 @@ bool GrGLGpu::onSubmitToGpu(GrSyncCpu sync) {
         // See if any previously inserted finish procs are good to go.
         fFinishCallbacks.check();
     }
+    this->releaseFinishedPersistentBuffers();
     if (!this->glCaps().skipErrorChecks()) {
         this->clearErrorsAndCheckForOOM();
     }
@@ -4277,6 +4303,68 @@ void GrGLGpu::willExecute() {
     }
 }
 
+uint32_t GrGLGpu::startTimer() {
+    // Bounds the queries made if getPerfStats() is never called to collect the results.
+    static constexpr int kMaxTimerQueries = 256;
+    if (!this->glCaps().timerQuerySupport()) {
+        return 0;
+    }
+    GrGLuint query = 0;
+    if (!fFreeTimerQueries.empty()) {
+        query = fFreeTimerQueries.back();
+        fFreeTimerQueries.pop_back();
+    } else if (fTimerQueries.size() < kMaxTimerQueries) {
+        GL_CALL(GenQueries(1, &query));
+        if (!query) {
+            return 0;
+        }
+        fTimerQueries.push_back(query);
+    } else {
+        return 0;
+    }
+    GL_CALL(BeginQuery(GR_GL_TIME_ELAPSED, query));
+    return query;
+}
+
+void GrGLGpu::endTimer(uint32_t timer) {
+    SkASSERT(timer);
+    GL_CALL(EndQuery(GR_GL_TIME_ELAPSED));
+}
+
+GrGpu::TimerResult GrGLGpu::timerResult(uint32_t timer, uint64_t* nanos) {
+    SkASSERT(timer);
+    GrGLuint available = 0;
+    GL_CALL(GetQueryObjectuiv(timer, GR_GL_QUERY_RESULT_AVAILABLE, &available));
+    if (!available) {
+        return TimerResult::kPending;
+    }
+    if (GR_IS_GR_GL_ES(this->glStandard())) {
+        // A disjoint event, like the GPU changing frequency, makes the results unreliable.
+        GrGLint disjoint = 0;
+        GL_CALL(GetIntegerv(GR_GL_GPU_DISJOINT, &disjoint));
+        if (disjoint) {
+            return TimerResult::kFailed;
+        }
+    }
+    GrGLuint64 elapsed = 0;
+    GL_CALL(GetQueryObjectui64v(timer, GR_GL_QUERY_RESULT, &elapsed));
+    *nanos = elapsed;
+    return TimerResult::kReady;
+}
+
+void GrGLGpu::deleteTimer(uint32_t timer) {
+    SkASSERT(timer);
+    fFreeTimerQueries.push_back(timer);
+}
+
+void GrGLGpu::deleteTimerQueries() {
+    if (!fTimerQueries.empty()) {
+        GL_CALL(DeleteQueries(fTimerQueries.size(), fTimerQueries.data()));
+    }
+    fTimerQueries.clear();
+    fFreeTimerQueries.clear();
+}
+
 void GrGLGpu::submit(GrOpsRenderPass* renderPass) {
     // The GrGLOpsRenderPass doesn't buffer ops so there is nothing to do here
     SkASSERT(fCachedOpsRenderPass.get() == renderPass);
@@ -4338,6 +4426,38 @@ void GrGLGpu::deleteFence(GrGLsync fence) {
     }
 }
 
+void GrGLGpu::willWritePersistentBuffer(GrGLBuffer* buffer) {
+    SkASSERT(buffer->isPersistentlyMapped());
+    // Buffers are normally only written again once the cache hands them out, which it won't do
+    // until their fence has signaled. Those written across submits have to wait here.
+    while (buffer->gpuUse() == GrGLBuffer::GpuUse::kSubmitted) {
+        SkASSERT(!fSubmittedPersistentBuffers.empty());
+        this->waitSync(fSubmittedPersistentBuffers.front().fFence, GR_GL_TIMEOUT_IGNORED,
+                       /*flush=*/false);
+        this->popSubmittedPersistentBuffers();
+    }
+    if (buffer->gpuUse() == GrGLBuffer::GpuUse::kNone) {
+        buffer->setGpuUse(GrGLBuffer::GpuUse::kPendingSubmit);
+        fPersistentBuffersToSubmit.push_back(sk_ref_sp(buffer));
+    }
+}
+
+void GrGLGpu::popSubmittedPersistentBuffers() {
+    SubmittedPersistentBuffers& submitted = fSubmittedPersistentBuffers.front();
+    this->deleteSync(submitted.fFence);
+    for (const sk_sp<GrGLBuffer>& buffer : submitted.fBuffers) {
+        buffer->setGpuUse(GrGLBuffer::GpuUse::kNone);
+    }
+    fSubmittedPersistentBuffers.pop_front();
+}
+
+void GrGLGpu::releaseFinishedPersistentBuffers() {
+    while (!fSubmittedPersistentBuffers.empty() &&
+           this->waitSync(fSubmittedPersistentBuffers.front().fFence, 0, /*flush=*/false)) {
+        this->popSubmittedPersistentBuffers();
+    }
+}
+
 [[nodiscard]] std::unique_ptr<GrSemaphore> GrGLGpu::makeSemaphore(bool isOwned) {
     SkASSERT(this->caps()->semaphoreSupport());
     return GrGLSemaphore::Make(this, isOwned);
@@ -4368,6 +4488,7 @@ void GrGLGpu::waitSemaphore(GrSemaphore* semaphore) {
 
 void GrGLGpu::checkFinishProcs() {
     fFinishCallbacks.check();
+    this->releaseFinishedPersistentBuffers();
 }
 
 void GrGLGpu::finishOutstandingGpuWork() {
@@ -52,6 +52,7 @@
 #include <array>
 #include <cstddef>
 #include <cstdint>
+#include <deque>
 #include <memory>
 #include <string_view>
 
@@ -239,12 +240,22 @@ public:
 
     void willExecute() override;
 
+    uint32_t startTimer() override;
+    void endTimer(uint32_t timer) override;
+    TimerResult timerResult(uint32_t timer, uint64_t* nanos) override;
+    void deleteTimer(uint32_t timer) override;
+
     void submit(GrOpsRenderPass* renderPass) override;
 
     [[nodiscard]] GrGLsync insertFence();
     bool waitFence(GrGLsync);
     void deleteFence(GrGLsync);
 
+    // Called before the CPU writes to a persistently mapped buffer. Waits for the GPU to finish
+    // reading the buffer if it may still be, and then keeps the buffer from being reused until the
+    // work of the next submit has completed.
+    void willWritePersistentBuffer(GrGLBuffer*);
+
     [[nodiscard]] std::unique_ptr<GrSemaphore> makeSemaphore(bool isOwned) override;
     std::unique_ptr<GrSemaphore> wrapBackendSemaphore(const GrBackendSemaphore&,
                                                       GrSemaphoreWrapType,
@@ -859,6 +870,25 @@ private:
 
     GrGLFinishCallbacks fFinishCallbacks;
 
+    // Persistently mapped buffers written since the last submit, and those written before earlier
+    // submits, along with the fences of those submits, oldest first. Holding refs keeps the
+    // resource cache from handing the buffers out again while the GPU may read them.
+    struct SubmittedPersistentBuffers {
+        GrGLsync fFence;
+        skia_private::TArray<sk_sp<GrGLBuffer>> fBuffers;
+    };
+    skia_private::TArray<sk_sp<GrGLBuffer>> fPersistentBuffersToSubmit;
+    std::deque<SubmittedPersistentBuffers> fSubmittedPersistentBuffers;
+    // Releases the oldest submitted persistent buffers, whose fence must have signaled.
+    void popSubmittedPersistentBuffers();
+    void releaseFinishedPersistentBuffers();
+
+    // The GL_TIME_ELAPSED queries made for startTimer(), and those of them not in use. A timer is
+    // its query's ID.
+    skia_private::TArray<GrGLuint> fTimerQueries;
+    skia_private::TArray<GrGLuint> fFreeTimerQueries;
+    void deleteTimerQueries();
+
     // If we've called a command that requires us to call glFlush than this will be set to true
     // since we defer calling flush until submit time. When we call submitToGpu if this is true then
     // we call glFlush and reset this to false.
@@ -11,6 +11,7 @@
 
 #include "include/gpu/GrContextOptions.h"
 #include "include/gpu/GrDirectContext.h"
+#include "src/base/SkTime.h"
 #include "src/gpu/ganesh/GrDirectContextPriv.h"
 #include "src/gpu/ganesh/GrFragmentProcessor.h"
 #include "src/gpu/ganesh/GrProcessor.h"
@@ -89,12 +90,16 @@ sk_sp<GrGLProgram> GrGLGpu::ProgramCache::findOrCreateProgramImpl(GrDirectContex
                                                                   Stats::ProgramCacheResult* stat) {
     *stat = Stats::ProgramCacheResult::kHit;
     std::unique_ptr<Entry>* entry = fMap.find(desc);
-    if (entry && !(*entry)->fProgram) {
+    if (entry && (*entry)->fProgram) {
+        fPerfCounters.recordHit();
+    } else if (entry) {
         // We've pre-compiled the GL program, but don't have the GrGLProgram scaffolding
         const GrGLPrecompiledProgram* precompiledProgram = &((*entry)->fPrecompiledProgram);
         SkASSERT(precompiledProgram->fProgramID != 0);
+        double startNanos = SkTime::GetNSecs();
         (*entry)->fProgram = GrGLProgramBuilder::CreateProgram(dContext, desc, programInfo,
                                                                precompiledProgram);
+        fPerfCounters.recordMiss(SkTime::GetNSecs() - startNanos);
         if (!(*entry)->fProgram) {
             // Should we purge the program ID from the cache at this point?
             SkDEBUGFAIL("Couldn't create program from precompiled program");
@@ -103,9 +108,11 @@ sk_sp<GrGLProgram> GrGLGpu::ProgramCache::findOrCreateProgramImpl(GrDirectContex
         }
         fStats.incNumPartialCompilationSuccesses();
         *stat = Stats::ProgramCacheResult::kPartial;
-    } else if (!entry) {
+    } else {
         // We have a cache miss
+        double startNanos = SkTime::GetNSecs();
         sk_sp<GrGLProgram> program = GrGLProgramBuilder::CreateProgram(dContext, desc, programInfo);
+        fPerfCounters.recordMiss(SkTime::GetNSecs() - startNanos);
         if (!program) {
             fStats.incNumCompilationFailures();
             return nullptr;
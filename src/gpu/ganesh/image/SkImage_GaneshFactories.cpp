@@ -11,12 +11,15 @@
 #include "include/core/SkBitmap.h"
 #include "include/core/SkColorSpace.h"
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkPixmap.h"
+#include "include/core/SkRect.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkSamplingOptions.h"
 #include "include/core/SkSize.h"
+#include "include/core/SkTextureCompressionType.h"
 #include "include/gpu/GpuTypes.h"
 #include "include/gpu/GrBackendSurface.h"
 #include "include/gpu/GrContextThreadSafeProxy.h"
@@ -24,15 +27,21 @@
 #include "include/gpu/GrRecordingContext.h"
 #include "include/gpu/GrTypes.h"
 #include "include/gpu/ganesh/GrExternalTextureGenerator.h"
+#include "include/private/base/SkAlign.h"
 #include "include/private/base/SkAssert.h"
+#include "include/private/base/SkTArray.h"
 #include "include/private/chromium/SkImageChromium.h"
 #include "include/private/gpu/ganesh/GrImageContext.h"
 #include "include/private/gpu/ganesh/GrTextureGenerator.h"
 #include "include/private/gpu/ganesh/GrTypesPriv.h"
 #include "src/core/SkAutoPixmapStorage.h"
+#include "src/core/SkCompressedDataUtils.h"
 #include "src/core/SkImageInfoPriv.h"
+#include "src/core/SkMipmap.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/gpu/GpuTypesPriv.h"
 #include "src/gpu/RefCntedCallback.h"
+#include "src/gpu/SkBackingFit.h"
 #include "src/gpu/Swizzle.h"
 #include "src/gpu/ganesh/GrBackendTextureImageGenerator.h"
 #include "src/gpu/ganesh/GrBackendUtils.h"
@@ -40,10 +49,12 @@
 #include "src/gpu/ganesh/GrContextThreadSafeProxyPriv.h"
 #include "src/gpu/ganesh/GrDirectContextPriv.h"
 #include "src/gpu/ganesh/GrGpu.h"
+#include "src/gpu/ganesh/GrGpuBuffer.h"
 #include "src/gpu/ganesh/GrGpuResourcePriv.h"
 #include "src/gpu/ganesh/GrImageContextPriv.h"
 #include "src/gpu/ganesh/GrProxyProvider.h"
 #include "src/gpu/ganesh/GrRecordingContextPriv.h"
+#include "src/gpu/ganesh/GrResourceProvider.h"
 #include "src/gpu/ganesh/GrSemaphore.h"
 #include "src/gpu/ganesh/GrSurfaceProxy.h"
 #include "src/gpu/ganesh/GrSurfaceProxyView.h"
@@ -313,6 +324,90 @@ sk_sp<SkImage> TextureFromCompressedTextureData(GrDirectContext* direct,
                                       SkColorInfo(colorType, kOpaque_SkAlphaType, nullptr));
 }
 
+sk_sp<SkImage> CompressedTextureFromImage(GrDirectContext* direct,
+                                          const SkImage* image,
+                                          SkTextureCompressionType type,
+                                          skgpu::Mipmapped mipmapped) {
+    if (!direct || !image || !image->isOpaque() || type == SkTextureCompressionType::kNone ||
+        !direct->compressedBackendFormat(type).isValid()) {
+        return nullptr;
+    }
+    if (!direct->priv().caps()->mipmapSupport()) {
+        mipmapped = skgpu::Mipmapped::kNo;
+    }
+
+    SkBitmap bitmap;
+    SkImageInfo info = SkImageInfo::Make(image->dimensions(), kRGBA_8888_SkColorType,
+                                         kOpaque_SkAlphaType, image->refColorSpace());
+    if (!bitmap.tryAllocPixels(info) || !image->readPixels(direct, bitmap.pixmap(), 0, 0)) {
+        return nullptr;
+    }
+
+    skia_private::STArray<16, SkPixmap> levels;
+    levels.push_back(bitmap.pixmap());
+    sk_sp<SkMipmap> mipmaps;
+    if (mipmapped == skgpu::Mipmapped::kYes) {
+        mipmaps.reset(SkMipmap::Build(bitmap.pixmap(), nullptr));
+        if (!mipmaps) {
+            return nullptr;
+        }
+        for (int i = 0; i < mipmaps->countLevels(); ++i) {
+            SkMipmap::Level level;
+            SkAssertResult(mipmaps->getLevel(i, &level));
+            levels.push_back(level.fPixmap);
+        }
+    }
+
+    skia_private::TArray<size_t> levelOffsets;
+    size_t size = SkCompressedDataSize(type, image->dimensions(), &levelOffsets,
+                                       mipmapped == skgpu::Mipmapped::kYes);
+    SkASSERT(levelOffsets.size() == levels.size());
+    sk_sp<SkData> data = SkData::MakeUninitialized(size);
+
+    // Each band of block rows is encoded separately, so that the executor can share them out.
+    static constexpr int kBandHeight = 64;
+    static_assert(kBandHeight % 4 == 0);
+    struct Band {
+        int fLevel;
+        int fTop;
+    };
+    skia_private::TArray<Band> bands;
+    for (int i = 0; i < levels.size(); ++i) {
+        for (int top = 0; top < levels[i].height(); top += kBandHeight) {
+            bands.push_back({i, top});
+        }
+    }
+    const size_t blockSize = SkCompressedBlockSize(type);
+    auto encodeBand = [&](int i) {
+        const SkPixmap& level = levels[bands[i].fLevel];
+        const int top = bands[i].fTop;
+        SkPixmap band;
+        SkAssertResult(level.extractSubset(&band, SkIRect::MakeLTRB(
+                0, top, level.width(), std::min(top + kBandHeight, level.height()))));
+        const size_t blocksPerRow = (level.width() + 3) / 4;
+        uint8_t* dst = static_cast<uint8_t*>(data->writable_data()) +
+                       levelOffsets[bands[i].fLevel] + (top / 4) * blocksPerRow * blockSize;
+        SkAssertResult(SkCompress(band, type, dst));
+    };
+    SkExecutor* executor = direct->priv().options().fExecutor;
+    if (executor && bands.size() > 1) {
+        SkTaskGroup taskGroup(*executor);
+        taskGroup.batch(bands.size(), encodeBand);
+        taskGroup.wait();
+    } else {
+        for (int i = 0; i < bands.size(); ++i) {
+            encodeBand(i);
+        }
+    }
+
+    sk_sp<SkImage> compressed = TextureFromCompressedTextureData(
+            direct, std::move(data), image->width(), image->height(), type, mipmapped);
+    if (compressed && image->colorSpace()) {
+        compressed = compressed->reinterpretColorSpace(image->refColorSpace());
+    }
+    return compressed;
+}
+
 sk_sp<SkImage> PromiseTextureFrom(sk_sp<GrContextThreadSafeProxy> threadSafeProxy,
                                   const GrBackendFormat& backendFormat,
                                   SkISize dimensions,
@@ -463,4 +558,99 @@ sk_sp<SkImage> TextureFromImage(GrDirectContext* dContext,
             sk_ref_sp(dContext), ib->uniqueID(), std::move(view), std::move(colorInfo));
 }
 
+// Has writePixels fill a mapped transfer buffer and uploads the texture from it. Returns nullptr
+// without calling writePixels if the context can't upload info's color type that way.
+static sk_sp<SkImage> texture_from_transfer_buffer(GrDirectContext* dContext,
+                                                   const SkImageInfo& info,
+                                                   const SkImages::PixelWriterProc& writePixels,
+                                                   skgpu::Budgeted budgeted,
+                                                   bool* calledWritePixels) {
+    const GrCaps* caps = dContext->priv().caps();
+    if (!caps->transferFromBufferToTextureSupport() ||
+        !(caps->mapBufferFlags() & GrCaps::kCanMap_MapFlag)) {
+        return nullptr;
+    }
+    GrColorType ct = SkColorTypeToGrColorType(info.colorType());
+    GrBackendFormat format = caps->getDefaultBackendFormat(ct, GrRenderable::kNo);
+    if (ct == GrColorType::kUnknown || !format.isValid()) {
+        return nullptr;
+    }
+    // The codec writes exactly info's color type, so the backend must accept it as is.
+    GrCaps::SupportedWrite supported = caps->supportedWritePixelsColorType(ct, format, ct);
+    if (supported.fColorType != ct || !supported.fOffsetAlignmentForTransferBuffer) {
+        return nullptr;
+    }
+    size_t rowBytes = SkAlignTo(info.minRowBytes(), caps->transferBufferRowBytesAlignment());
+    if (rowBytes != info.minRowBytes() && !caps->transferPixelsToRowBytesSupport()) {
+        return nullptr;
+    }
+
+    GrProxyProvider* proxyProvider = dContext->priv().proxyProvider();
+    sk_sp<GrTextureProxy> proxy = proxyProvider->createProxy(format,
+                                                             info.dimensions(),
+                                                             GrRenderable::kNo,
+                                                             /*renderTargetSampleCnt=*/1,
+                                                             skgpu::Mipmapped::kNo,
+                                                             SkBackingFit::kExact,
+                                                             budgeted,
+                                                             GrProtected::kNo,
+                                                             /*label=*/"TextureFromPixelWriter",
+                                                             GrInternalSurfaceFlags::kNone,
+                                                             GrSurfaceProxy::UseAllocator::kNo);
+    GrResourceProvider* resourceProvider = dContext->priv().resourceProvider();
+    if (!proxy || !proxy->instantiate(resourceProvider)) {
+        return nullptr;
+    }
+    sk_sp<GrGpuBuffer> buffer =
+            resourceProvider->createBuffer(rowBytes * info.height(),
+                                           GrGpuBufferType::kXferCpuToGpu,
+                                           kDynamic_GrAccessPattern,
+                                           GrResourceProvider::ZeroInit::kNo);
+    void* pixels = buffer ? buffer->map() : nullptr;
+    if (!pixels) {
+        return nullptr;
+    }
+
+    *calledWritePixels = true;
+    bool wrote = writePixels(SkPixmap(info, pixels, rowBytes));
+    buffer->unmap();
+    if (!wrote || !dContext->priv().getGpu()->transferPixelsTo(proxy->peekTexture(),
+                                                               SkIRect::MakeSize(info.dimensions()),
+                                                               ct,
+                                                               ct,
+                                                               std::move(buffer),
+                                                               /*offset=*/0,
+                                                               rowBytes)) {
+        return nullptr;
+    }
+
+    skgpu::Swizzle swizzle = caps->getReadSwizzle(format, ct);
+    GrSurfaceProxyView view(std::move(proxy), kTopLeft_GrSurfaceOrigin, swizzle);
+    return sk_make_sp<SkImage_Ganesh>(
+            sk_ref_sp(dContext), kNeedNewImageUniqueID, std::move(view), info.colorInfo());
+}
+
+sk_sp<SkImage> TextureFromPixelWriter(GrDirectContext* dContext,
+                                      const SkImageInfo& info,
+                                      const PixelWriterProc& writePixels,
+                                      skgpu::Budgeted budgeted) {
+    if (!dContext || dContext->abandoned() || !writePixels || !SkImageInfoIsValid(info)) {
+        return nullptr;
+    }
+
+    bool calledWritePixels = false;
+    sk_sp<SkImage> image =
+            texture_from_transfer_buffer(dContext, info, writePixels, budgeted, &calledWritePixels);
+    if (image || calledWritePixels) {
+        return image;
+    }
+
+    SkBitmap bitmap;
+    if (!bitmap.tryAllocPixels(info) || !writePixels(bitmap.pixmap())) {
+        return nullptr;
+    }
+    bitmap.setImmutable();
+    return TextureFromImage(dContext, bitmap.asImage(), skgpu::Mipmapped::kNo, budgeted);
+}
+
 }  // namespace SkImages
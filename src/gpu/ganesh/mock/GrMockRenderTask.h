@@ -50,9 +50,7 @@ public:
     }
     bool onExecute(GrOpFlushState*) override { return true; }
 
-#if defined(GR_TEST_UTILS)
     const char* name() const final { return "Mock"; }
-#endif
 
 private:
     skia_private::TArray<sk_sp<GrSurfaceProxy>> fUsed;
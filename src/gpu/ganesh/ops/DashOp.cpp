@@ -43,6 +43,11 @@ constexpr int kAAModeCnt = static_cast<int>(skgpu::ganesh::DashOp::AAMode::kCove
 
 namespace skgpu::ganesh::DashOp {
 
+// Every on interval of a pattern is drawn as a separate line over the whole length of the dashed
+// line, with the effect discarding everything but that interval, so the fill cost grows with the
+// number of intervals. Longer patterns are dashed on the CPU instead.
+static constexpr int kMaxIntervalCount = 8;
+
 namespace {
 
 void calc_dash_scaling(SkScalar* parallelScale, SkScalar* perpScale,
@@ -192,13 +197,14 @@ public:
         SkScalar fPerpendicularScale;
     };
 
+    // All the lines must have the same points, view matrix and stroke width.
     static GrOp::Owner Make(GrRecordingContext* context,
                             GrPaint&& paint,
-                            const LineData& geometry,
+                            SkSpan<const LineData> lines,
                             SkPaint::Cap cap,
                             AAMode aaMode, bool fullDash,
                             const GrUserStencilSettings* stencilSettings) {
-        return GrOp::Make<DashOpImpl>(context, std::move(paint), geometry, cap,
+        return GrOp::Make<DashOpImpl>(context, std::move(paint), lines, cap,
                                       aaMode, fullDash, stencilSettings);
     }
 
@@ -235,7 +241,7 @@ public:
 private:
     friend class GrOp; // for ctor
 
-    DashOpImpl(GrPaint&& paint, const LineData& geometry, SkPaint::Cap cap, AAMode aaMode,
+    DashOpImpl(GrPaint&& paint, SkSpan<const LineData> lines, SkPaint::Cap cap, AAMode aaMode,
                bool fullDash, const GrUserStencilSettings* stencilSettings)
             : INHERITED(ClassID())
             , fColor(paint.getColor4f())
@@ -244,7 +250,9 @@ private:
             , fAAMode(aaMode)
             , fProcessorSet(std::move(paint))
             , fStencilSettings(stencilSettings) {
-        fLines.push_back(geometry);
+        SkASSERT(!lines.empty());
+        fLines.push_back_n(lines.size(), lines.data());
+        const LineData& geometry = lines[0];
 
         // compute bounds
         SkScalar halfStrokeWidth = 0.5f * geometry.fSrcStrokeWidth;
@@ -254,8 +262,10 @@ private:
         bounds.outset(xBloat, halfStrokeWidth);
 
         // Note, we actually create the combined matrix here, and save the work
-        SkMatrix& combinedMatrix = fLines[0].fSrcRotInv;
-        combinedMatrix.postConcat(geometry.fViewMatrix);
+        for (LineData& line : fLines) {
+            line.fSrcRotInv.postConcat(line.fViewMatrix);
+        }
+        const SkMatrix& combinedMatrix = fLines[0].fSrcRotInv;
 
         IsHairline zeroArea = geometry.fSrcStrokeWidth ? IsHairline::kNo : IsHairline::kYes;
         HasAABloat aaBloat = (aaMode == AAMode::kNone) ? HasAABloat::kNo : HasAABloat::kYes;
@@ -1136,6 +1146,7 @@ GrOp::Owner MakeDashLineOp(GrRecordingContext* context,
                            const GrUserStencilSettings* stencilSettings) {
     SkASSERT(CanDrawDashLine(pts, style, viewMatrix));
     const SkScalar* intervals = style.dashIntervals();
+    const int intervalCount = style.dashIntervalCnt();
     SkScalar phase = style.dashPhase();
 
     SkPaint::Cap cap = style.strokeRec().getCap();
@@ -1143,8 +1154,13 @@ GrOp::Owner MakeDashLineOp(GrRecordingContext* context,
     DashOpImpl::LineData lineData;
     lineData.fSrcStrokeWidth = style.strokeRec().getWidth();
 
+    SkScalar intervalLength = 0;
+    for (int i = 0; i < intervalCount; ++i) {
+        intervalLength += intervals[i];
+    }
+
     // the phase should be normalized to be [0, sum of all intervals)
-    SkASSERT(phase >= 0 && phase < intervals[0] + intervals[1]);
+    SkASSERT(phase >= 0 && phase < intervalLength);
 
     // Rotate the src pts so they are aligned horizontally with pts[0].fX < pts[1].fX
     if (pts[0].fY != pts[1].fY || pts[0].fX > pts[1].fX) {
@@ -1166,23 +1182,46 @@ GrOp::Owner MakeDashLineOp(GrRecordingContext* context,
         return nullptr;
     }
 
-    SkScalar offInterval = intervals[1] * lineData.fParallelScale;
     SkScalar strokeWidth = lineData.fSrcStrokeWidth * lineData.fPerpendicularScale;
 
-    if (SkPaint::kSquare_Cap == cap && 0 != lineData.fSrcStrokeWidth) {
-        // add cap to on interval and remove from off interval
-        offInterval -= strokeWidth;
-    }
+    lineData.fViewMatrix = viewMatrix;
 
-    // TODO we can do a real rect call if not using fulldash(ie no off interval, not using AA)
-    bool fullDash = offInterval > 0.f || aaMode != AAMode::kNone;
+    // The effect only knows one on and one off interval. Longer patterns are drawn as one line
+    // per on interval, each dashed with that on interval and the rest of the pattern as off,
+    // and with its phase shifted to where that on interval starts. The on intervals don't
+    // overlap, so neither do the lines. (CanDrawDashLine checks that caps don't reach across
+    // the off intervals either.)
+    STArray<1, DashOpImpl::LineData, true> lines;
+    bool fullDash = false;
+    SkScalar onStart = 0;
+    for (int i = 0; i < intervalCount; i += 2) {
+        const SkScalar onInterval = intervals[i];
+        const SkScalar start = onStart;
+        onStart += intervals[i] + intervals[i + 1];
+        if (SkPaint::kButt_Cap == cap && 0 == onInterval && intervalCount > 2) {
+            continue;
+        }
 
-    lineData.fViewMatrix = viewMatrix;
-    lineData.fPhase = phase;
-    lineData.fIntervals[0] = intervals[0];
-    lineData.fIntervals[1] = intervals[1];
+        SkScalar offInterval = (intervalLength - onInterval) * lineData.fParallelScale;
+        if (SkPaint::kSquare_Cap == cap && 0 != lineData.fSrcStrokeWidth) {
+            // add cap to on interval and remove from off interval
+            offInterval -= strokeWidth;
+        }
+
+        // TODO we can do a real rect call if not using fulldash(ie no off interval, not using AA)
+        fullDash |= offInterval > 0.f || aaMode != AAMode::kNone;
 
-    return DashOpImpl::Make(context, std::move(paint), lineData, cap, aaMode, fullDash,
+        DashOpImpl::LineData& line = lines.push_back(lineData);
+        line.fPhase = phase >= start ? phase - start : phase - start + intervalLength;
+        line.fIntervals[0] = onInterval;
+        line.fIntervals[1] = intervalLength - onInterval;
+    }
+    if (lines.empty()) {
+        // Every on interval is empty, and butt caps draw nothing for them.
+        return nullptr;
+    }
+
+    return DashOpImpl::Make(context, std::move(paint), lines, cap, aaMode, fullDash,
                             stencilSettings);
 }
 
@@ -1199,24 +1238,38 @@ bool CanDrawDashLine(const SkPoint pts[2], const GrStyle& style, const SkMatrix&
         return false;
     }
 
-    if (!style.isDashed() || 2 != style.dashIntervalCnt()) {
+    if (!style.isDashed() || style.dashIntervalCnt() < 2 || style.dashIntervalCnt() % 2 ||
+        style.dashIntervalCnt() > kMaxIntervalCount) {
         return false;
     }
 
     const SkScalar* intervals = style.dashIntervals();
-    if (0 == intervals[0] && 0 == intervals[1]) {
+    const int intervalCount = style.dashIntervalCnt();
+    SkScalar intervalLength = 0;
+    for (int i = 0; i < intervalCount; ++i) {
+        intervalLength += intervals[i];
+    }
+    if (0 == intervalLength) {
         return false;
     }
 
     SkPaint::Cap cap = style.strokeRec().getCap();
-    if (SkPaint::kRound_Cap == cap) {
-        // Current we don't support round caps unless the on interval is zero
-        if (intervals[0] != 0.f) {
-            return false;
-        }
-        // If the width of the circle caps in greater than the off interval we will pick up unwanted
-        // segments of circles at the start and end of the dash line.
-        if (style.strokeRec().getWidth() > intervals[1]) {
+    const SkScalar strokeWidth = style.strokeRec().getWidth();
+    for (int i = 0; i < intervalCount; i += 2) {
+        if (SkPaint::kRound_Cap == cap) {
+            // Current we don't support round caps unless the on interval is zero
+            if (intervals[i] != 0.f) {
+                return false;
+            }
+            // If the width of the circle caps in greater than the off interval we will pick up
+            // unwanted segments of circles at the start and end of the dash line.
+            if (strokeWidth > intervals[i + 1]) {
+                return false;
+            }
+        } else if (SkPaint::kSquare_Cap == cap && intervalCount > 2 &&
+                   strokeWidth > intervals[i + 1]) {
+            // Each on interval of a longer pattern is drawn separately, so caps reaching across
+            // an off interval would be blended twice.
             return false;
         }
     }
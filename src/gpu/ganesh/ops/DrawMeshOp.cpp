@@ -647,6 +647,7 @@ private:
     GrGeometryProcessor* makeGP(SkArenaAlloc*);
 
     CombineResult onCombineIfPossible(GrOp* t, SkArenaAlloc*, const GrCaps&) override;
+    CombineResult combineMeshes(MeshOp* that, const GrCaps&);
 
     /**
      * Built either from a SkMesh or a SkVertices. In the former case the data is owned
@@ -668,6 +669,22 @@ private:
 
         bool isFromVertices() const { return SkToBool(fVertices); }
 
+        // Is this an SkMesh whose vertices (and indices, if any) are in Ganesh GPU buffers?
+        bool isGpuResident() const {
+            if (this->isFromVertices() || !fMeshData.vb->isGaneshBacked()) {
+                return false;
+            }
+            return !fMeshData.ib || fMeshData.ib->isGaneshBacked();
+        }
+
+        // Is this an SkMesh whose vertices (and indices, if any) can be read on the CPU?
+        bool isCpuBacked() const {
+            if (this->isFromVertices() || !fMeshData.vb->peek()) {
+                return false;
+            }
+            return !fMeshData.ib || fMeshData.ib->peek();
+        }
+
         const SkVertices* vertices() const {
             SkASSERT(this->isFromVertices());
             return fVertices.get();
@@ -771,7 +788,8 @@ private:
     sk_sp<const SkData>        fUniforms;
     int                        fVertexCount;
     int                        fIndexCount;
-    GrSimpleMesh*              fMesh = nullptr;
+    GrSimpleMesh*              fDraws = nullptr;
+    int                        fDrawCount = 0;
     GrProgramInfo*             fProgramInfo = nullptr;
     TArray<std::unique_ptr<GrFragmentProcessor>> fChildren;
 
@@ -1058,7 +1076,37 @@ void MeshOp::onCreateProgramInfo(const GrCaps* caps,
 }
 
 void MeshOp::onPrepareDraws(GrMeshDrawTarget* target) {
+    SkASSERT(!fDraws);
     size_t vertexStride = fSpecification->stride();
+
+    if (fMeshes.size() > 1 && fMeshes[0].isGpuResident()) {
+        // Combined meshes whose buffers are already on the GPU each draw from their own buffers.
+        fDraws = target->allocMeshes(fMeshes.size());
+        fDrawCount = fMeshes.size();
+        for (int i = 0; i < fMeshes.size(); ++i) {
+            const Mesh& m = fMeshes[i];
+            SkASSERT(m.isGpuResident());
+            auto [vb, voffset] = m.gpuVB();
+            auto [ib, ioffset] = m.gpuIB();
+            SkASSERT(vb && voffset % vertexStride == 0);
+            int firstVertex = SkToInt(voffset / vertexStride);
+            if (ib) {
+                SkASSERT(ioffset % sizeof(uint16_t) == 0);
+                fDraws[i].setIndexed(std::move(ib),
+                                     m.indexCount(),
+                                     SkToInt(ioffset / sizeof(uint16_t)),
+                                     /*minIndexValue=*/0,
+                                     m.vertexCount() - 1,
+                                     GrPrimitiveRestart::kNo,
+                                     std::move(vb),
+                                     firstVertex);
+            } else {
+                fDraws[i].set(std::move(vb), m.vertexCount(), firstVertex);
+            }
+        }
+        return;
+    }
+
     sk_sp<const GrBuffer> vertexBuffer;
     int firstVertex;
     std::tie(vertexBuffer, firstVertex) = fMeshes[0].gpuVB();
@@ -1112,11 +1160,11 @@ void MeshOp::onPrepareDraws(GrMeshDrawTarget* target) {
         firstIndex /= sizeof(uint16_t);
     }
 
-    SkASSERT(!fMesh);
-    fMesh = target->allocMesh();
+    fDraws = target->allocMesh();
+    fDrawCount = 1;
 
     if (indexBuffer) {
-        fMesh->setIndexed(std::move(indexBuffer),
+        fDraws->setIndexed(std::move(indexBuffer),
                           fIndexCount,
                           firstIndex,
                           /*minIndexValue=*/0,
@@ -1125,7 +1173,7 @@ void MeshOp::onPrepareDraws(GrMeshDrawTarget* target) {
                           std::move(vertexBuffer),
                           firstVertex);
     } else {
-        fMesh->set(std::move(vertexBuffer), fVertexCount, firstVertex);
+        fDraws->set(std::move(vertexBuffer), fVertexCount, firstVertex);
     }
 }
 
@@ -1134,7 +1182,7 @@ void MeshOp::onExecute(GrOpFlushState* flushState, const SkRect& chainBounds) {
         this->createProgramInfo(flushState);
     }
 
-    if (!fProgramInfo || !fMesh) {
+    if (!fProgramInfo || !fDraws) {
         return;
     }
 
@@ -1151,15 +1199,18 @@ void MeshOp::onExecute(GrOpFlushState* flushState, const SkRect& chainBounds) {
     flushState->bindTextures(fProgramInfo->geomProc(),
                              geomProcTextures.data(),
                              fProgramInfo->pipeline());
-    flushState->drawMesh(*fMesh);
+    for (int i = 0; i < fDrawCount; ++i) {
+        flushState->drawMesh(fDraws[i]);
+    }
 }
 
 GrOp::CombineResult MeshOp::onCombineIfPossible(GrOp* t, SkArenaAlloc*, const GrCaps& caps) {
     auto that = t->cast<MeshOp>();
-    if (!fMeshes[0].isFromVertices() || !that->fMeshes[0].isFromVertices()) {
-        // We *could* make this work when the vertex/index buffers are CPU-backed but that isn't an
-        // important use case.
-        return GrOp::CombineResult::kCannotCombine;
+    if (fMeshes[0].isFromVertices() != that->fMeshes[0].isFromVertices()) {
+        return CombineResult::kCannotCombine;
+    }
+    if (!fMeshes[0].isFromVertices()) {
+        return this->combineMeshes(that, caps);
     }
 
     // Check for a combinable primitive type.
@@ -1225,6 +1276,79 @@ GrOp::CombineResult MeshOp::onCombineIfPossible(GrOp* t, SkArenaAlloc*, const Gr
     return CombineResult::kMerged;
 }
 
+GrOp::CombineResult MeshOp::combineMeshes(MeshOp* that, const GrCaps& caps) {
+    // Many small SkMeshes with the same spec and uniforms, such as particles or map markers, can
+    // share one program. Those with GPU buffers keep them and are drawn one after another. Those
+    // with CPU buffers are uploaded together like SkVertices and drawn at once.
+    bool gpuResident = fMeshes[0].isGpuResident();
+    if (gpuResident != that->fMeshes[0].isGpuResident()) {
+        return CombineResult::kCannotCombine;
+    }
+    if (fPrimitiveType != that->fPrimitiveType) {
+        return CombineResult::kCannotCombine;
+    }
+    if (!gpuResident) {
+        if (!fMeshes[0].isCpuBacked() || !that->fMeshes[0].isCpuBacked()) {
+            return CombineResult::kCannotCombine;
+        }
+        // Strips can't be concatenated.
+        if (fPrimitiveType != GrPrimitiveType::kTriangles) {
+            return CombineResult::kCannotCombine;
+        }
+        if (fVertexCount > INT32_MAX - that->fVertexCount) {
+            return CombineResult::kCannotCombine;
+        }
+        if (SkToBool(fIndexCount) != SkToBool(that->fIndexCount)) {
+            return CombineResult::kCannotCombine;
+        }
+        if (SkToBool(fIndexCount) && fVertexCount > SkToInt(UINT16_MAX) - that->fVertexCount) {
+            return CombineResult::kCannotCombine;
+        }
+    }
+
+    if (SkMeshSpecificationPriv::Hash(*this->fSpecification) !=
+        SkMeshSpecificationPriv::Hash(*that->fSpecification)) {
+        return CombineResult::kCannotCombine;
+    }
+
+    // There is no cheap way to tell whether two sets of child effects are the same.
+    if (!fChildren.empty() || !that->fChildren.empty()) {
+        return CombineResult::kCannotCombine;
+    }
+
+    if (SkToBool(fUniforms) != SkToBool(that->fUniforms) ||
+        (fUniforms && !fUniforms->equals(that->fUniforms.get()))) {
+        return CombineResult::kCannotCombine;
+    }
+
+    if (fIgnoreSpecColor != that->fIgnoreSpecColor) {
+        return CombineResult::kCannotCombine;
+    }
+    if ((fIgnoreSpecColor || !SkMeshSpecificationPriv::HasColors(*fSpecification)) &&
+        fColor != that->fColor) {
+        return CombineResult::kCannotCombine;
+    }
+
+    if (!fHelper.isCompatible(that->fHelper, caps, this->bounds(), that->bounds())) {
+        return CombineResult::kCannotCombine;
+    }
+
+    // Unlike SkVertices, the position of a mesh vertex is only known to its vertex program, so
+    // the vertices can't be transformed on the CPU.
+    if (fViewMatrix != that->fViewMatrix) {
+        return CombineResult::kCannotCombine;
+    }
+
+    if (!GrColorSpaceXform::Equals(fColorSpaceXform.get(), that->fColorSpaceXform.get())) {
+        return CombineResult::kCannotCombine;
+    }
+
+    fMeshes.move_back_n(that->fMeshes.size(), that->fMeshes.begin());
+    fVertexCount += that->fVertexCount;
+    fIndexCount  += that->fIndexCount;
+    return CombineResult::kMerged;
+}
+
 }  // anonymous namespace
 
 namespace skgpu::ganesh::DrawMeshOp {
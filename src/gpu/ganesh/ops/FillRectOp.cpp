@@ -14,6 +14,7 @@
 #include "src/gpu/ganesh/GrOpsTypes.h"
 #include "src/gpu/ganesh/GrPaint.h"
 #include "src/gpu/ganesh/GrProgramInfo.h"
+#include "src/gpu/ganesh/GrRecordingContextPriv.h"
 #include "src/gpu/ganesh/SkGr.h"
 #include "src/gpu/ganesh/SurfaceDrawContext.h"
 #include "src/gpu/ganesh/geometry/GrQuad.h"
@@ -294,6 +295,17 @@ private:
                 SkDebugf("Could not allocate indices\n");
                 return;
             }
+            if (fQuads.count() > skgpu::ganesh::QuadPerEdgeAA::QuadLimit(
+                                         vertexSpec.indexBufferOption())) {
+                fIndirectDrawCount = skgpu::ganesh::QuadPerEdgeAA::WriteIndirectDraws(
+                        target, vertexSpec, fQuads.count(), fBaseVertex, &fIndirectBuffer,
+                        &fIndirectOffset);
+                if (!fIndirectDrawCount) {
+                    SkDebugf("Could not allocate indirect draws\n");
+                    fIndexBuffer.reset();
+                    return;
+                }
+            }
         }
     }
 
@@ -317,6 +329,11 @@ private:
         flushState->bindPipelineAndScissorClip(*fProgramInfo, chainBounds);
         flushState->bindBuffers(std::move(fIndexBuffer), nullptr, std::move(fVertexBuffer));
         flushState->bindTextures(fProgramInfo->geomProc(), nullptr, fProgramInfo->pipeline());
+        if (fIndirectBuffer) {
+            flushState->drawIndexedIndirect(fIndirectBuffer.get(), fIndirectOffset,
+                                            fIndirectDrawCount);
+            return;
+        }
         skgpu::ganesh::QuadPerEdgeAA::IssueDraw(flushState->caps(),
                                                 flushState->opsRenderPass(),
                                                 vertexSpec,
@@ -338,8 +355,11 @@ private:
             upgradeToCoverageAAOnMerge = true;
         }
 
+        // Quads past what the index buffer draws at once can be drawn with more indirect draws.
+        const int maxDraws = skgpu::ganesh::QuadPerEdgeAA::MaxIndirectDraws(caps);
+        const int combinedQuadCount = fQuads.count() + that->fQuads.count();
         if (CombinedQuadCountWillOverflow(fHelper.aaType(), upgradeToCoverageAAOnMerge,
-                                          fQuads.count() + that->fQuads.count())) {
+                                          (combinedQuadCount + maxDraws - 1) / maxDraws)) {
             return CombineResult::kCannotCombine;
         }
 
@@ -386,7 +406,8 @@ private:
     }
 #endif
 
-    bool canAddQuads(int numQuads, GrAAType aaType) {
+    // 'maxDraws' is how many draws, each covering as many quads as the index buffer, may be used.
+    bool canAddQuads(int numQuads, GrAAType aaType, int maxDraws) {
         // The new quad's aa type should be the same as the first quad's or none, except when the
         // first quad's aa type was already downgraded to none, in which case the stored type must
         // be lifted to back to the requested type.
@@ -394,7 +415,8 @@ private:
         if (aaType != fHelper.aaType() && aaType != GrAAType::kNone) {
             auto indexBufferOption =
                     skgpu::ganesh::QuadPerEdgeAA::CalcIndexBufferOption(aaType, quadCount);
-            if (quadCount > skgpu::ganesh::QuadPerEdgeAA::QuadLimit(indexBufferOption)) {
+            if ((quadCount + maxDraws - 1) / maxDraws >
+                skgpu::ganesh::QuadPerEdgeAA::QuadLimit(indexBufferOption)) {
                 // Promoting to the new aaType would've caused an overflow of the indexBuffer
                 // limit
                 return false;
@@ -406,7 +428,8 @@ private:
         } else {
             auto indexBufferOption = skgpu::ganesh::QuadPerEdgeAA::CalcIndexBufferOption(
                     fHelper.aaType(), quadCount);
-            if (quadCount > skgpu::ganesh::QuadPerEdgeAA::QuadLimit(indexBufferOption)) {
+            if ((quadCount + maxDraws - 1) / maxDraws >
+                skgpu::ganesh::QuadPerEdgeAA::QuadLimit(indexBufferOption)) {
                 return false; // This op can't grow any more
             }
         }
@@ -416,7 +439,7 @@ private:
 
     // Similar to onCombineIfPossible, but adds a quad assuming its op would have been compatible.
     // But since it's avoiding the op list management, it must update the op's bounds.
-    bool addQuad(DrawQuad* quad, const SkPMColor4f& color, GrAAType aaType) {
+    bool addQuad(DrawQuad* quad, const SkPMColor4f& color, GrAAType aaType, int maxDraws) {
         SkRect newBounds = this->bounds();
         newBounds.joinPossiblyEmptyRect(quad->fDevice.bounds());
 
@@ -426,7 +449,7 @@ private:
         if (count == 0 ) {
             // Just skip the append (trivial success)
             return true;
-        } else if (!this->canAddQuads(count, aaType)) {
+        } else if (!this->canAddQuads(count, aaType, maxDraws)) {
             // Not enough room in the index buffer for the AA type
             return false;
         } else {
@@ -459,6 +482,10 @@ private:
     sk_sp<const GrBuffer> fVertexBuffer;
     sk_sp<const GrBuffer> fIndexBuffer;
     int fBaseVertex;
+    // Set when there are more quads than one draw with the index buffer can cover.
+    sk_sp<const GrBuffer> fIndirectBuffer;
+    size_t fIndirectOffset = 0;
+    int fIndirectDrawCount = 0;
 
     using INHERITED = GrMeshDrawOp;
 };
@@ -505,6 +532,8 @@ GrOp::Owner FillRectOp::MakeOp(GrRecordingContext* context,
     GrOp::Owner op = FillRectOp::Make(context, std::move(paint), aaType,
                                       &quad, stencilSettings, InputFlags::kNone);
     auto fillRects = op->cast<FillRectOpImpl>();
+    const int maxDraws =
+            skgpu::ganesh::QuadPerEdgeAA::MaxIndirectDraws(*context->priv().caps());
 
     *numConsumed = 1;
     // Accumulate remaining quads similar to onCombineIfPossible() without creating an op
@@ -517,7 +546,7 @@ GrOp::Owner FillRectOp::MakeOp(GrRecordingContext* context,
         GrQuadUtils::ResolveAAType(aaType, quads[i].fAAFlags, quad.fDevice,
                                    &resolvedAA, &quad.fEdgeFlags);
 
-        if (!fillRects->addQuad(&quad, quads[i].fColor, resolvedAA)) {
+        if (!fillRects->addQuad(&quad, quads[i].fColor, resolvedAA, maxDraws)) {
             break;
         }
 
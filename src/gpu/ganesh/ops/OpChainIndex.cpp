@@ -0,0 +1,85 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/gpu/ganesh/ops/OpChainIndex.h"
+
+#include "include/private/base/SkAssert.h"
+#include "include/private/base/SkTPin.h"
+#include "src/gpu/ganesh/geometry/GrRect.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace skia_private;
+
+namespace skgpu::ganesh {
+
+OpChainIndex::OpChainIndex(const SkRect& area)
+        : fArea(area)
+        , fCellsPerX(area.width() > 0 ? kGridSize / area.width() : 0)
+        , fCellsPerY(area.height() > 0 ? kGridSize / area.height() : 0) {}
+
+OpChainIndex::CellRange OpChainIndex::cellsFor(const SkRect& bounds) const {
+    auto cellOf = [](float v, float origin, float cellsPer) {
+        return static_cast<int>(SkTPin(std::floor((v - origin) * cellsPer),
+                                       0.f, static_cast<float>(kGridSize - 1)));
+    };
+    return {cellOf(bounds.fLeft,   fArea.fLeft, fCellsPerX),
+            cellOf(bounds.fTop,    fArea.fTop,  fCellsPerY),
+            cellOf(bounds.fRight,  fArea.fLeft, fCellsPerX),
+            cellOf(bounds.fBottom, fArea.fTop,  fCellsPerY)};
+}
+
+void OpChainIndex::add(int chainIndex, uint32_t classID, const SkRect& bounds) {
+    SkASSERT(chainIndex <= fBounds.size());
+    if (chainIndex == fBounds.size()) {
+        fBounds.push_back(bounds);
+        TArray<int>* chains = fChainsByClass.find(classID);
+        if (!chains) {
+            chains = fChainsByClass.set(classID, TArray<int>());
+        }
+        chains->push_back(chainIndex);
+    } else {
+        fBounds[chainIndex] = bounds;
+    }
+
+    const CellRange cells = this->cellsFor(bounds);
+    for (int y = cells.fTop; y <= cells.fBottom; ++y) {
+        for (int x = cells.fLeft; x <= cells.fRight; ++x) {
+            // Chains that grow are nearly always recent ones, so this rarely looks far.
+            TArray<int>& chains = this->cell(x, y);
+            int i = chains.size();
+            while (i > 0 && chains[i - 1] > chainIndex) {
+                --i;
+            }
+            if (i > 0 && chains[i - 1] == chainIndex) {
+                continue;
+            }
+            chains.push_back(chainIndex);
+            std::rotate(chains.begin() + i, chains.end() - 1, chains.end());
+        }
+    }
+}
+
+int OpChainIndex::lastOverlapping(const SkRect& bounds, int minIndex) const {
+    int last = minIndex - 1;
+    const CellRange cells = this->cellsFor(bounds);
+    for (int y = cells.fTop; y <= cells.fBottom; ++y) {
+        for (int x = cells.fLeft; x <= cells.fRight; ++x) {
+            const TArray<int>& chains = this->cell(x, y);
+            for (int i = chains.size() - 1; i >= 0 && chains[i] > last; --i) {
+                if (GrRectsOverlap(fBounds[chains[i]], bounds)) {
+                    last = chains[i];
+                    break;
+                }
+            }
+        }
+    }
+    return last;
+}
+
+}  // namespace skgpu::ganesh
@@ -0,0 +1,68 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef OpChainIndex_DEFINED
+#define OpChainIndex_DEFINED
+
+#include "include/core/SkRect.h"
+#include "include/private/base/SkTArray.h"
+#include "src/core/SkTHash.h"
+
+#include <cstdint>
+
+namespace skgpu::ganesh {
+
+/**
+ * Lets OpsTask find the chains a new op may be added to without trying each recent chain in
+ * turn. An op may join any earlier chain of its class that comes after the last chain it overlaps.
+ * The index keeps, for each of a grid of cells over the target, the chains that touch the cell,
+ * and for each op class the chains whose head op is of that class.
+ *
+ * Chains are identified by their index in the OpsTask. Chains are added in order, and a chain
+ * that grows is added again with its new bounds.
+ */
+class OpChainIndex {
+public:
+    static constexpr int kGridSize = 16;
+
+    // Ops outside of area are counted as being in the cells along its edges.
+    explicit OpChainIndex(const SkRect& area);
+
+    void add(int chainIndex, uint32_t classID, const SkRect& bounds);
+
+    // Returns the last chain at or after minIndex whose bounds overlap bounds, or minIndex - 1 if
+    // there is none.
+    int lastOverlapping(const SkRect& bounds, int minIndex) const;
+
+    // The chains whose head op has classID, in order.
+    const skia_private::TArray<int>* chainsOfClass(uint32_t classID) const {
+        return fChainsByClass.find(classID);
+    }
+
+    int count() const { return fBounds.size(); }
+
+private:
+    struct CellRange {
+        int fLeft, fTop, fRight, fBottom;
+    };
+    CellRange cellsFor(const SkRect& bounds) const;
+    skia_private::TArray<int>& cell(int x, int y) { return fCells[y * kGridSize + x]; }
+    const skia_private::TArray<int>& cell(int x, int y) const {
+        return fCells[y * kGridSize + x];
+    }
+
+    const SkRect fArea;
+    const float fCellsPerX, fCellsPerY;
+    skia_private::TArray<SkRect> fBounds;
+    // Each cell's chains, in increasing order.
+    skia_private::TArray<int> fCells[kGridSize * kGridSize];
+    skia_private::THashMap<uint32_t, skia_private::TArray<int>> fChainsByClass;
+};
+
+}  // namespace skgpu::ganesh
+
+#endif
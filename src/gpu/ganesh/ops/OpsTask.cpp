@@ -25,6 +25,7 @@
 #include "src/gpu/ganesh/GrResourceProvider.h"
 #include "src/gpu/ganesh/GrTexture.h"
 #include "src/gpu/ganesh/geometry/GrRect.h"
+#include "src/gpu/ganesh/ops/OpChainIndex.h"
 
 using namespace skia_private;
 
@@ -398,6 +399,9 @@ OpsTask::OpsTask(GrDrawingManager* drawingMgr,
         , fUsesMSAASurface(view.asRenderTargetProxy()->numSamples() > 1)
         , fTargetSwizzle(view.swizzle())
         , fTargetOrigin(view.origin())
+        , fMaxOpChainDistance(std::max(
+                  kMaxOpChainDistance,
+                  drawingMgr->getContext()->priv().options().fOpsTaskReorderLookback))
         , fArenas{std::move(arenas)}
           SkDEBUGCODE(, fNumClips(0)) {
     this->addTarget(drawingMgr, view.detachProxy());
@@ -408,6 +412,7 @@ void OpsTask::deleteOps() {
         chain.deleteOps();
     }
     fOpChains.clear();
+    fChainIndex.reset();
 }
 
 OpsTask::~OpsTask() {
@@ -749,7 +754,9 @@ int OpsTask::mergeFrom(SkSpan<const sk_sp<GrRenderTask>> tasks) {
         toMerge->fDeferredProxies.clear();
         toMerge->fSampledProxies.clear();
         toMerge->fOpChains.clear();
+        toMerge->fChainIndex.reset();
     }
+    fChainIndex.reset();
     fMustPreserveStencil = mergingNodes.back()->fMustPreserveStencil;
     return mergedCount;
 }
@@ -992,8 +999,12 @@ void OpsTask::recordOp(
                op->bounds().fRight, op->bounds().fBottom);
     GrOP_INFO(SkTabString(op->dumpInfo(), 1).c_str());
     GrOP_INFO("\tOutcome:\n");
-    int maxCandidates = std::min(kMaxOpChainDistance, fOpChains.size());
-    if (maxCandidates) {
+    if (fMaxOpChainDistance > kMaxOpChainDistance) {
+        op = this->appendToIndexedChain(std::move(op), processorAnalysis, dstProxyView, clip, caps);
+        if (!op) {
+            return;
+        }
+    } else if (int maxCandidates = std::min(kMaxOpChainDistance, fOpChains.size())) {
         int i = 0;
         while (true) {
             OpChain& candidate = fOpChains.fromBack(i);
@@ -1021,6 +1032,44 @@ void OpsTask::recordOp(
         SkDEBUGCODE(fNumClips++;)
     }
     fOpChains.emplace_back(std::move(op), processorAnalysis, clip, dstProxyView);
+    if (fChainIndex) {
+        fChainIndex->add(fOpChains.size() - 1, fOpChains.back().head()->classID(),
+                         fOpChains.back().bounds());
+    }
+}
+
+GrOp::Owner OpsTask::appendToIndexedChain(
+        GrOp::Owner op, GrProcessorSet::Analysis processorAnalysis,
+        const GrDstProxyView* dstProxyView, GrAppliedClip* clip, const GrCaps& caps) {
+    if (!fChainIndex) {
+        fChainIndex = std::make_unique<OpChainIndex>(this->target(0)->backingStoreBoundsRect());
+        for (int i = 0; i < fOpChains.size(); ++i) {
+            fChainIndex->add(i, fOpChains[i].head()->classID(), fOpChains[i].bounds());
+        }
+    }
+    SkASSERT(fChainIndex->count() == fOpChains.size());
+
+    // The op may join any chain of its class from the last one it overlaps on. Trying the chains
+    // of other classes would fail, and looking past the one it overlaps would draw it out of order.
+    const int minIndex = std::max(0, fOpChains.size() - fMaxOpChainDistance);
+    const int firstIndex = std::max(minIndex,
+                                    fChainIndex->lastOverlapping(op->bounds(), minIndex));
+    const TArray<int>* chains = fChainIndex->chainsOfClass(op->classID());
+    if (!chains) {
+        GrOP_INFO("\t\tBackward: No chain of the same class\n");
+        return op;
+    }
+    for (int i = chains->size() - 1; i >= 0 && (*chains)[i] >= firstIndex; --i) {
+        OpChain& candidate = fOpChains[(*chains)[i]];
+        op = candidate.appendOp(std::move(op), processorAnalysis, dstProxyView, clip, caps,
+                                fArenas->arenaAlloc(), fAuditTrail);
+        if (!op) {
+            fChainIndex->add((*chains)[i], candidate.head()->classID(), candidate.bounds());
+            return nullptr;
+        }
+    }
+    GrOP_INFO("\t\tBackward: No chain to add to from chain %d\n", firstIndex);
+    return op;
 }
 
 void OpsTask::forwardCombine(const GrCaps& caps) {
@@ -1056,6 +1105,7 @@ void OpsTask::forwardCombine(const GrCaps& caps) {
 
 GrRenderTask::ExpectedOutcome OpsTask::onMakeClosed(GrRecordingContext* rContext,
                                                     SkIRect* targetUpdateBounds) {
+    fChainIndex.reset();
     this->forwardCombine(*rContext->priv().caps());
     if (!this->isColorNoOp()) {
         GrSurfaceProxy* proxy = this->target(0);
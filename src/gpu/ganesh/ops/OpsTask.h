@@ -28,6 +28,8 @@
 #include "src/gpu/ganesh/GrRenderTask.h"
 #include "src/gpu/ganesh/ops/GrOp.h"
 
+#include <memory>
+
 class GrAuditTrail;
 class GrCaps;
 class GrClearOp;
@@ -37,6 +39,7 @@ class OpsTaskTestingAccess;
 
 namespace skgpu::ganesh {
 
+class OpChainIndex;
 class SurfaceDrawContext;
 
 class OpsTask : public GrRenderTask {
@@ -106,12 +109,13 @@ public:
     void visitProxies_debugOnly(const GrVisitProxyFunc&) const override;
 #endif
 
+    const char* name() const final { return "Ops"; }
+
 #if defined(GR_TEST_UTILS)
     void dump(const SkString& label,
               SkString indent,
               bool printDependencies,
               bool close) const override;
-    const char* name() const final { return "Ops"; }
     int numOpChains() const { return fOpChains.size(); }
     const GrOp* getChain(int index) const { return fOpChains[index].head(); }
 #endif
@@ -258,6 +262,11 @@ private:
 
     void forwardCombine(const GrCaps&);
 
+    // Adds op to one of the last fMaxOpChainDistance chains, found with fChainIndex, if it can.
+    // Returns op if it could not.
+    GrOp::Owner appendToIndexedChain(GrOp::Owner, GrProcessorSet::Analysis,
+                                     const GrDstProxyView*, GrAppliedClip*, const GrCaps&);
+
     // Remove all ops, proxies, etc. Used in the merging algorithm when tasks can be skipped.
     void reset();
 
@@ -290,6 +299,11 @@ private:
     // For ops/opsTask we have mean: 5 stdDev: 28
     skia_private::STArray<25, OpChain> fOpChains;
 
+    // How many chains back recordOp looks for one to add an op to. When this is more than the
+    // default, fChainIndex finds the chains it can use instead of recordOp trying each in turn.
+    const int fMaxOpChainDistance;
+    std::unique_ptr<OpChainIndex> fChainIndex;
+
     sk_sp<GrArenas> fArenas;
     SkDEBUGCODE(int fNumClips;)
 
@@ -10,6 +10,7 @@
 #include "src/base/SkVx.h"
 #include "src/gpu/KeyBuilder.h"
 #include "src/gpu/ganesh/GrCaps.h"
+#include "src/gpu/ganesh/GrDrawIndirectCommand.h"
 #include "src/gpu/ganesh/GrMeshDrawTarget.h"
 #include "src/gpu/ganesh/GrResourceProvider.h"
 #include "src/gpu/ganesh/SkGr.h"
@@ -19,6 +20,8 @@
 #include "src/gpu/ganesh/glsl/GrGLSLVarying.h"
 #include "src/gpu/ganesh/glsl/GrGLSLVertexGeoBuilder.h"
 
+#include <algorithm>
+
 static_assert((int)GrQuadAAFlags::kLeft   == SkCanvas::kLeft_QuadAAFlag);
 static_assert((int)GrQuadAAFlags::kTop    == SkCanvas::kTop_QuadAAFlag);
 static_assert((int)GrQuadAAFlags::kRight  == SkCanvas::kRight_QuadAAFlag);
@@ -527,6 +530,43 @@ void IssueDraw(const GrCaps& caps, GrOpsRenderPass* renderPass, const VertexSpec
     }
 }
 
+int MaxIndirectDraws(const GrCaps& caps) {
+    // Bounds the size of the vertex data a single op may need.
+    static constexpr int kMaxIndirectDraws = 16;
+
+    if (caps.nativeDrawIndirectSupport() && !caps.nativeDrawIndexedIndirectIsBroken() &&
+        caps.drawInstancedSupport()) {
+        return kMaxIndirectDraws;
+    }
+    return 1;
+}
+
+int WriteIndirectDraws(GrMeshDrawTarget* target, const VertexSpec& spec, int quadCount,
+                       int absVertBufferOffset, sk_sp<const GrBuffer>* indirectBuffer,
+                       size_t* indirectOffset) {
+    SkASSERT(spec.needsIndexBuffer());
+
+    const int maxNumQuads = QuadLimit(spec.indexBufferOption());
+    const int numIndicesPerQuad = spec.indexBufferOption() == IndexBufferOption::kPictureFramed
+                                          ? GrResourceProvider::NumIndicesPerAAQuad()
+                                          : GrResourceProvider::NumIndicesPerNonAAQuad();
+    const int drawCount = (quadCount + maxNumQuads - 1) / maxNumQuads;
+    SkASSERT(drawCount <= MaxIndirectDraws(target->caps()));
+
+    GrDrawIndexedIndirectWriter writer =
+            target->makeDrawIndexedIndirectSpace(drawCount, indirectBuffer, indirectOffset);
+    if (!writer) {
+        return 0;
+    }
+    for (int firstQuad = 0; firstQuad < quadCount; firstQuad += maxNumQuads) {
+        const int quadsInDraw = std::min(quadCount - firstQuad, maxNumQuads);
+        writer.writeIndexed(quadsInDraw * numIndicesPerQuad, /*baseIndex=*/0, /*instanceCount=*/1,
+                            /*baseInstance=*/0,
+                            absVertBufferOffset + firstQuad * spec.verticesPerQuad());
+    }
+    return drawCount;
+}
+
 ////////////////// VertexSpec Implementation
 
 int VertexSpec::deviceDimensionality() const {
@@ -206,6 +206,18 @@ private:
     void IssueDraw(const GrCaps&, GrOpsRenderPass*, const VertexSpec&, int runningQuadCount,
                    int quadCount, int maxVerts, int absVertBufferOffset);
 
+    // Where indexed indirect draws are native, an op may hold more quads than QuadLimit allows and
+    // still draw them with one drawIndexedIndirect: a run of draws that each cover as many quads
+    // as the index buffer does. This returns how many such draws an op may use, or 1 if it can't.
+    int MaxIndirectDraws(const GrCaps&);
+
+    // Writes the indirect draws for 'quadCount' quads, stored in the vertex buffer starting at
+    // 'absVertBufferOffset', into space from the target. The vertex spec must use an index buffer.
+    // Returns the number of draws, or 0 if the space couldn't be allocated.
+    int WriteIndirectDraws(GrMeshDrawTarget*, const VertexSpec&, int quadCount,
+                           int absVertBufferOffset, sk_sp<const GrBuffer>* indirectBuffer,
+                           size_t* indirectOffset);
+
     }  // namespace skgpu::ganesh::QuadPerEdgeAA
 
 #endif // QuadPerEdgeAA_DEFINED
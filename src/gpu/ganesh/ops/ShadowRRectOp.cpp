@@ -8,7 +8,9 @@
 #include "src/gpu/ganesh/ops/ShadowRRectOp.h"
 
 #include "include/core/SkBitmap.h"
+#include "include/core/SkMatrix.h"
 #include "include/gpu/GrRecordingContext.h"
+#include "src/core/SkPointPriv.h"
 #include "src/core/SkRRectPriv.h"
 #include "src/gpu/ganesh/GrMemoryPool.h"
 #include "src/gpu/ganesh/GrOpFlushState.h"
@@ -20,6 +22,9 @@
 #include "src/gpu/ganesh/effects/GrShadowGeoProc.h"
 #include "src/gpu/ganesh/ops/GrSimpleMeshDrawOpHelper.h"
 
+#include <algorithm>
+#include <cstdint>
+
 using namespace skia_private;
 
 namespace {
@@ -662,6 +667,377 @@ private:
     using INHERITED = GrMeshDrawOp;
 };
 
+///////////////////////////////////////////////////////////////////////////////
+// Convex Polygon Data
+//
+// The shadow of a convex polygon is made of:
+//   - the polygon inset by the part of the blur that falls inside it (the umbra), as a fan,
+//   - a quad along each edge from the umbra's edge to the polygon's edge,
+//   - a quad along each edge from the polygon's edge out to the penumbra's border, and
+//   - a fan around each corner that circumscribes the rounded border there.
+//
+// These use the same vertex layout and geometry processor as the rrects. The shadow params are
+// affine across the edge quads and radial across the corner fans, so interpolating them gives the
+// exact distance to the penumbra's border everywhere.
+
+struct ShadowVertex {
+    SkPoint  fPos;
+    GrColor  fColor;
+    SkPoint  fOffset;
+    SkScalar fDistanceCorrection;
+};
+
+// Corners are split into segments of at most 45 degrees.
+static constexpr int kMaxCornerSegments = 4;
+
+// Returns the number of segments for the corner that turns from normal 'n0' to 'n1', and the
+// angle it turns through.
+int corner_segments(const SkVector& n0, const SkVector& n1, SkScalar* angle) {
+    *angle = SkScalarATan2(n0.cross(n1), n0.dot(n1));
+    return std::clamp(SkScalarCeilToInt(*angle * kMaxCornerSegments / SK_ScalarPI),
+                      1, kMaxCornerSegments);
+}
+
+// Maps 'polygon' to device space, drops repeated and collinear points, and orients it so that
+// every turn is positive, which makes (e.fY, -e.fX) the outward normal of each edge e. Returns
+// false if what is left isn't a strictly convex polygon.
+bool make_device_polygon(const SkMatrix& viewMatrix,
+                         SkSpan<const SkPoint> polygon,
+                         TArray<SkPoint, true>* points) {
+    const int count = SkToInt(polygon.size());
+    if (count < 3 || count > skgpu::ganesh::ShadowRRectOp::kMaxPolygonPoints) {
+        return false;
+    }
+    points->reserve_exact(count);
+    for (const SkPoint& pt : polygon) {
+        SkPoint devPt = viewMatrix.mapPoint(pt);
+        if (points->empty() || !SkPointPriv::EqualsWithinTolerance(points->back(), devPt)) {
+            points->push_back(devPt);
+        }
+    }
+    while (points->size() > 1 && SkPointPriv::EqualsWithinTolerance(points->back(),
+                                                                    points->front())) {
+        points->pop_back();
+    }
+
+    // Drop points that don't turn the polygon until every point does.
+    for (bool dropped = true; dropped && points->size() >= 3;) {
+        dropped = false;
+        const int n = points->size();
+        TArray<SkPoint, true> kept(n);
+        for (int i = 0; i < n; ++i) {
+            const SkPoint& prev = kept.empty() ? (*points)[n - 1] : kept.back();
+            SkVector e0 = (*points)[i] - prev;
+            SkVector e1 = (*points)[(i + 1) % n] - (*points)[i];
+            if (SkScalarNearlyZero(e0.cross(e1) / (e0.length() * e1.length()))) {
+                dropped = true;
+                continue;
+            }
+            kept.push_back((*points)[i]);
+        }
+        *points = std::move(kept);
+    }
+    int n = points->size();
+    if (n < 3) {
+        return false;
+    }
+
+    int positive = 0;
+    for (int i = 0; i < n; ++i) {
+        SkVector e0 = (*points)[i] - (*points)[(i + n - 1) % n];
+        SkVector e1 = (*points)[(i + 1) % n] - (*points)[i];
+        positive += e0.cross(e1) > 0 ? 1 : 0;
+    }
+    if (positive == 0) {
+        std::reverse(points->begin(), points->end());
+    } else if (positive != n) {
+        return false;
+    }
+    return true;
+}
+
+class ShadowConvexPolygonOp final : public GrMeshDrawOp {
+public:
+    DEFINE_OP_CLASS_ID
+
+    // 'points' are in device space, oriented as make_device_polygon() leaves them. 'normals'
+    // are the outward normals of the edges that start at each point, and 'umbra' the points of the
+    // polygon inset by 'umbraInset'.
+    ShadowConvexPolygonOp(GrColor color,
+                          SkSpan<const SkPoint> points,
+                          SkSpan<const SkVector> normals,
+                          SkSpan<const SkPoint> umbra,
+                          SkScalar outset,
+                          SkScalar blurRadius,
+                          SkScalar umbraInset,
+                          GrSurfaceProxyView falloffView)
+            : INHERITED(ClassID())
+            , fFalloffView(std::move(falloffView)) {
+        const int n = SkToInt(points.size());
+        fPoints.push_back_n(n, points.data());
+        fNormals.push_back_n(n, normals.data());
+        fUmbra.push_back_n(n, umbra.data());
+
+        int cornerVerts = 0;
+        int cornerIndices = 0;
+        for (int i = 0; i < n; ++i) {
+            SkScalar angle;
+            int segments = corner_segments(normals[(i + n - 1) % n], normals[i], &angle);
+            cornerVerts += segments + 3;
+            cornerIndices += 3 * (segments + 1);
+        }
+        // Two quads per edge, the corners and the umbra's fan.
+        int vertCount = 8 * n + cornerVerts + n;
+        int indexCount = 12 * n + cornerIndices + 3 * (n - 2);
+
+        // The corner fans reach out past the penumbra's border by at most 1/cos(pi/8).
+        SkRect bounds;
+        bounds.setBounds(points.data(), n);
+        bounds.outset(outset * 1.08239220f, outset * 1.08239220f);
+        this->setBounds(bounds, HasAABloat::kNo, IsHairline::kNo);
+
+        fGeoData.push_back({color, outset, blurRadius, umbraInset, 0, n, vertCount, indexCount});
+        fVertCount = vertCount;
+        fIndexCount = indexCount;
+    }
+
+    const char* name() const override { return "ShadowConvexPolygonOp"; }
+
+    FixedFunctionFlags fixedFunctionFlags() const override { return FixedFunctionFlags::kNone; }
+
+    GrProcessorSet::Analysis finalize(const GrCaps&, const GrAppliedClip*, GrClampType) override {
+        return GrProcessorSet::EmptySetAnalysis();
+    }
+
+private:
+    struct Geometry {
+        GrColor  fColor;
+        SkScalar fOutset;
+        SkScalar fBlurRadius;
+        SkScalar fUmbraInset;
+        int      fFirstPoint;
+        int      fPointCount;
+        int      fVertCount;
+        int      fIndexCount;
+    };
+
+    static void WriteVertex(ShadowVertex** verts, GrColor color, SkPoint pos,
+                            SkVector offset, SkScalar distanceCorrection) {
+        **verts = {pos, color, offset, distanceCorrection};
+        (*verts)++;
+    }
+
+    // Writes the vertices and indices of one polygon, numbering the vertices from 'baseVertex'.
+    void fillInPolygon(const Geometry& args, ShadowVertex** verts, uint16_t** indices,
+                       int baseVertex) const {
+        const GrColor color = args.fColor;
+        const SkScalar outset = args.fOutset;
+        const SkScalar blurRadius = args.fBlurRadius;
+        // The GP's coverage comes from distanceCorrection * (1 - length(offset)), which is the
+        // distance inside the penumbra's border in units of the blur radius.
+        const SkScalar outerCorrection = outset / blurRadius;
+        const SkScalar umbraOffset = args.fUmbraInset / blurRadius;
+        const SkPoint* points = fPoints.begin() + args.fFirstPoint;
+        const SkVector* normals = fNormals.begin() + args.fFirstPoint;
+        const SkPoint* umbra = fUmbra.begin() + args.fFirstPoint;
+        const int n = args.fPointCount;
+
+        int v = baseVertex;
+        auto quad = [indices](int a, int b, int c, int d) {
+            for (int index : {a, b, c, a, c, d}) {
+                *(*indices)++ = SkToU16(index);
+            }
+        };
+        auto triangle = [indices](int a, int b, int c) {
+            for (int index : {a, b, c}) {
+                *(*indices)++ = SkToU16(index);
+            }
+        };
+
+        for (int i = 0; i < n; ++i) {
+            const SkPoint& p0 = points[i];
+            const SkPoint& p1 = points[(i + 1) % n];
+            const SkVector& normal = normals[i];
+
+            // From the polygon's edge out to the penumbra's border.
+            WriteVertex(verts, color, p0, {0, 0}, outerCorrection);
+            WriteVertex(verts, color, p1, {0, 0}, outerCorrection);
+            WriteVertex(verts, color, p1 + normal * outset, normal, outerCorrection);
+            WriteVertex(verts, color, p0 + normal * outset, normal, outerCorrection);
+            quad(v, v + 1, v + 2, v + 3);
+            v += 4;
+
+            // From the umbra's edge out to the polygon's edge.
+            WriteVertex(verts, color, umbra[i], {0, 0}, 1);
+            WriteVertex(verts, color, umbra[(i + 1) % n], {0, 0}, 1);
+            WriteVertex(verts, color, p1, normal * umbraOffset, 1);
+            WriteVertex(verts, color, p0, normal * umbraOffset, 1);
+            quad(v, v + 1, v + 2, v + 3);
+            v += 4;
+        }
+
+        for (int i = 0; i < n; ++i) {
+            const SkPoint& center = points[i];
+            const SkVector& n0 = normals[(i + n - 1) % n];
+            const SkVector& n1 = normals[i];
+            SkScalar angle;
+            int segments = corner_segments(n0, n1, &angle);
+            SkScalar step = angle / segments;
+            // The fan's outer edges are tangent to the border at each segment's ends.
+            SkScalar tangentScale = SkScalarInvert(SkScalarCos(0.5f * step));
+
+            int first = v;
+            WriteVertex(verts, color, center, {0, 0}, outerCorrection);
+            WriteVertex(verts, color, center + n0 * outset, n0, outerCorrection);
+            for (int j = 0; j < segments; ++j) {
+                SkScalar a = (j + 0.5f) * step;
+                SkScalar c = SkScalarCos(a);
+                SkScalar s = SkScalarSin(a);
+                SkVector dir = SkVector::Make(c * n0.fX - s * n0.fY, s * n0.fX + c * n0.fY);
+                dir *= tangentScale;
+                WriteVertex(verts, color, center + dir * outset, dir, outerCorrection);
+            }
+            WriteVertex(verts, color, center + n1 * outset, n1, outerCorrection);
+            for (int j = 0; j <= segments; ++j) {
+                triangle(first, first + j + 1, first + j + 2);
+            }
+            v += segments + 3;
+        }
+
+        // The umbra has full coverage.
+        for (int i = 0; i < n; ++i) {
+            WriteVertex(verts, color, umbra[i], {0, 0}, 1);
+        }
+        for (int i = 1; i < n - 1; ++i) {
+            triangle(v, v + i, v + i + 1);
+        }
+    }
+
+    GrProgramInfo* programInfo() override { return fProgramInfo; }
+
+    void onCreateProgramInfo(const GrCaps* caps,
+                             SkArenaAlloc* arena,
+                             const GrSurfaceProxyView& writeView,
+                             bool usesMSAASurface,
+                             GrAppliedClip&& appliedClip,
+                             const GrDstProxyView& dstProxyView,
+                             GrXferBarrierFlags renderPassXferBarriers,
+                             GrLoadOp colorLoadOp) override {
+        GrGeometryProcessor* gp = GrRRectShadowGeoProc::Make(arena, fFalloffView);
+        SkASSERT(sizeof(ShadowVertex) == gp->vertexStride());
+
+        fProgramInfo = GrSimpleMeshDrawOpHelper::CreateProgramInfo(caps, arena, writeView,
+                                                                   usesMSAASurface,
+                                                                   std::move(appliedClip),
+                                                                   dstProxyView, gp,
+                                                                   GrProcessorSet::MakeEmptySet(),
+                                                                   GrPrimitiveType::kTriangles,
+                                                                   renderPassXferBarriers,
+                                                                   colorLoadOp,
+                                                                   GrPipeline::InputFlags::kNone,
+                                                                   &GrUserStencilSettings::kUnused);
+    }
+
+    void onPrepareDraws(GrMeshDrawTarget* target) override {
+        sk_sp<const GrBuffer> vertexBuffer;
+        int firstVertex;
+        ShadowVertex* verts = (ShadowVertex*)target->makeVertexSpace(
+                sizeof(ShadowVertex), fVertCount, &vertexBuffer, &firstVertex);
+        if (!verts) {
+            SkDebugf("Could not allocate vertices\n");
+            return;
+        }
+
+        sk_sp<const GrBuffer> indexBuffer;
+        int firstIndex = 0;
+        uint16_t* indices = target->makeIndexSpace(fIndexCount, &indexBuffer, &firstIndex);
+        if (!indices) {
+            SkDebugf("Could not allocate indices\n");
+            return;
+        }
+
+        int currStartVertex = 0;
+        for (const Geometry& args : fGeoData) {
+            SkDEBUGCODE(ShadowVertex* vertStart = verts;)
+            SkDEBUGCODE(uint16_t* indexStart = indices;)
+            this->fillInPolygon(args, &verts, &indices, currStartVertex);
+            SkASSERT(verts - vertStart == args.fVertCount);
+            SkASSERT(indices - indexStart == args.fIndexCount);
+            currStartVertex += args.fVertCount;
+        }
+
+        fMesh = target->allocMesh();
+        fMesh->setIndexed(std::move(indexBuffer), fIndexCount, firstIndex, 0, fVertCount - 1,
+                          GrPrimitiveRestart::kNo, std::move(vertexBuffer), firstVertex);
+    }
+
+    void onExecute(GrOpFlushState* flushState, const SkRect& chainBounds) override {
+        if (!fProgramInfo) {
+            this->createProgramInfo(flushState);
+        }
+
+        if (!fProgramInfo || !fMesh) {
+            return;
+        }
+
+        flushState->bindPipelineAndScissorClip(*fProgramInfo, chainBounds);
+        flushState->bindTextures(fProgramInfo->geomProc(), *fFalloffView.proxy(),
+                                 fProgramInfo->pipeline());
+        flushState->drawMesh(*fMesh);
+    }
+
+    CombineResult onCombineIfPossible(GrOp* t, SkArenaAlloc*, const GrCaps& caps) override {
+        ShadowConvexPolygonOp* that = t->cast<ShadowConvexPolygonOp>();
+        // Every vertex must be reachable with 16 bit indices.
+        if (fVertCount + that->fVertCount > UINT16_MAX + 1) {
+            return CombineResult::kCannotCombine;
+        }
+        int firstPoint = fPoints.size();
+        fPoints.push_back_n(that->fPoints.size(), that->fPoints.begin());
+        fNormals.push_back_n(that->fNormals.size(), that->fNormals.begin());
+        fUmbra.push_back_n(that->fUmbra.size(), that->fUmbra.begin());
+        for (Geometry geo : that->fGeoData) {
+            geo.fFirstPoint += firstPoint;
+            fGeoData.push_back(geo);
+        }
+        fVertCount += that->fVertCount;
+        fIndexCount += that->fIndexCount;
+        return CombineResult::kMerged;
+    }
+
+#if defined(GR_TEST_UTILS)
+    SkString onDumpInfo() const override {
+        SkString string;
+        for (const Geometry& geo : fGeoData) {
+            string.appendf("Color: 0x%08x Points: %d, Outset: %.2f, BlurRad: %.2f, Umbra: %.2f\n",
+                           geo.fColor, geo.fPointCount, geo.fOutset, geo.fBlurRadius,
+                           geo.fUmbraInset);
+        }
+        return string;
+    }
+#endif
+
+    void visitProxies(const GrVisitProxyFunc& func) const override {
+        func(fFalloffView.proxy(), skgpu::Mipmapped(false));
+        if (fProgramInfo) {
+            fProgramInfo->visitFPProxies(func);
+        }
+    }
+
+    STArray<1, Geometry, true> fGeoData;
+    STArray<8, SkPoint, true> fPoints;
+    STArray<8, SkVector, true> fNormals;
+    STArray<8, SkPoint, true> fUmbra;
+    int fVertCount;
+    int fIndexCount;
+    GrSurfaceProxyView fFalloffView;
+
+    GrSimpleMesh*      fMesh = nullptr;
+    GrProgramInfo*     fProgramInfo = nullptr;
+
+    using INHERITED = GrMeshDrawOp;
+};
+
 }  // anonymous namespace
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -745,6 +1121,71 @@ GrOp::Owner Make(GrRecordingContext* context,
                                              std::move(falloffView));
 }
 
+GrOp::Owner MakeConvexPolygon(GrRecordingContext* context,
+                              GrColor color,
+                              const SkMatrix& viewMatrix,
+                              SkSpan<const SkPoint> polygon,
+                              SkScalar devOutset,
+                              SkScalar blurWidth) {
+    SkASSERT(!viewMatrix.hasPerspective());
+    if (devOutset <= 0 || blurWidth <= 0) {
+        return nullptr;
+    }
+
+    STArray<8, SkPoint, true> points;
+    if (!make_device_polygon(viewMatrix, polygon, &points)) {
+        return nullptr;
+    }
+    const int n = points.size();
+
+    STArray<8, SkVector, true> normals(n);
+    for (int i = 0; i < n; ++i) {
+        SkVector edge = points[(i + 1) % n] - points[i];
+        SkVector normal = SkVector::Make(edge.fY, -edge.fX);
+        if (!normal.normalize()) {
+            return nullptr;
+        }
+        normals.push_back(normal);
+    }
+
+    // The part of the blur that doesn't fit outside the polygon falls inside it. The umbra is the
+    // polygon inset by that much, found by moving each corner along its bisector. If the polygon
+    // is too thin for that, some edge of the umbra flips over and we give up.
+    const SkScalar umbraInset = std::max(blurWidth - devOutset, 0.0f);
+    STArray<8, SkPoint, true> umbra(n);
+    for (int i = 0; i < n; ++i) {
+        const SkVector& n0 = normals[(i + n - 1) % n];
+        const SkVector& n1 = normals[i];
+        SkScalar denom = 1 + n0.dot(n1);
+        if (denom <= SK_ScalarNearlyZero) {
+            return nullptr;
+        }
+        umbra.push_back(points[i] - (n0 + n1) * (umbraInset / denom));
+    }
+    for (int i = 0; i < n; ++i) {
+        SkVector edge = points[(i + 1) % n] - points[i];
+        SkVector umbraEdge = umbra[(i + 1) % n] - umbra[i];
+        if (edge.dot(umbraEdge) <= 0) {
+            return nullptr;
+        }
+    }
+
+    GrSurfaceProxyView falloffView = create_falloff_texture(context);
+    if (!falloffView) {
+        return nullptr;
+    }
+
+    return GrOp::Make<ShadowConvexPolygonOp>(context,
+                                             color,
+                                             SkSpan(points),
+                                             SkSpan(normals),
+                                             SkSpan(umbra),
+                                             devOutset,
+                                             blurWidth,
+                                             umbraInset,
+                                             std::move(falloffView));
+}
+
 }  // namespace skgpu::ganesh::ShadowRRectOp
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -792,4 +1233,35 @@ GR_DRAW_OP_TEST_DEFINE(ShadowRRectOp) {
     } while (true);
 }
 
+GR_DRAW_OP_TEST_DEFINE(ShadowConvexPolygonOp) {
+    // We may choose a polygon and blur that the factory rejects. We loop until it accepts one.
+    do {
+        SkScalar rotate = random->nextSScalar1() * 360.f;
+        SkScalar translateX = random->nextSScalar1() * 1000.f;
+        SkScalar translateY = random->nextSScalar1() * 1000.f;
+        SkScalar scale = random->nextRangeScalar(0.1f, 10.f);
+        SkMatrix viewMatrix;
+        viewMatrix.setRotate(rotate);
+        viewMatrix.postTranslate(translateX, translateY);
+        viewMatrix.postScale(scale, scale);
+
+        // A regular polygon squashed along one axis is convex.
+        int pointCount = random->nextRangeU(3, 12);
+        SkScalar radius = random->nextRangeScalar(1.f, 100.f);
+        SkScalar squash = random->nextRangeScalar(0.2f, 1.f);
+        SkPoint polygon[12];
+        for (int i = 0; i < pointCount; ++i) {
+            SkScalar angle = 2 * SK_ScalarPI * i / pointCount;
+            polygon[i] = {radius * SkScalarCos(angle), squash * radius * SkScalarSin(angle)};
+        }
+        SkScalar outset = random->nextRangeScalar(0.5f, 72.f);
+        SkScalar blurWidth = random->nextRangeScalar(0.5f, 72.f);
+        GrColor color = paint.getColor4f().toBytes_RGBA();
+        if (auto op = skgpu::ganesh::ShadowRRectOp::MakeConvexPolygon(
+                    context, color, viewMatrix, SkSpan(polygon, pointCount), outset, blurWidth)) {
+            return op;
+        }
+    } while (true);
+}
+
 #endif // defined(GR_TEST_UTILS)
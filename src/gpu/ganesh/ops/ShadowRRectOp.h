@@ -9,6 +9,7 @@
 #define ShadowRRectOp_DEFINED
 
 #include <memory>
+#include "include/core/SkSpan.h"
 #include "src/gpu/ganesh/GrColor.h"
 #include "src/gpu/ganesh/ops/GrOp.h"
 
@@ -16,6 +17,7 @@ class GrRecordingContext;
 
 class SkMatrix;
 class SkRRect;
+struct SkPoint;
 
 namespace skgpu::ganesh::ShadowRRectOp {
 
@@ -26,6 +28,23 @@ GrOp::Owner Make(GrRecordingContext*,
                  SkScalar blurWidth,
                  SkScalar insetWidth);
 
+// The most points a polygon passed to MakeConvexPolygon() may have.
+inline constexpr int kMaxPolygonPoints = 256;
+
+/**
+ * Makes an op that draws the shadow of a convex polygon analytically. The shadow covers the
+ * polygon outset by 'devOutset' and falls off over the outer 'blurWidth' of that, both in device
+ * space. Returns null if the polygon isn't strictly convex once mapped to device space, or if it
+ * is too thin for the part of the blur that falls inside it, in which case the caller should
+ * tessellate the shadow instead.
+ */
+GrOp::Owner MakeConvexPolygon(GrRecordingContext*,
+                              GrColor,
+                              const SkMatrix& viewMatrix,
+                              SkSpan<const SkPoint> polygon,
+                              SkScalar devOutset,
+                              SkScalar blurWidth);
+
 }  // namespace skgpu::ganesh::ShadowRRectOp
 
 #endif // ShadowRRectOp_DEFINED
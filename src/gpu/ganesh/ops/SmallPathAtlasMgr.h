@@ -39,8 +39,21 @@ public:
 
     void reset();
 
+    // Releases atlas pages whose live paths fit in earlier pages. Called between flushes.
+    void compactIdle() {
+        if (fAtlas) {
+            fAtlas->compactIdle();
+        }
+    }
+
     bool initAtlas(GrProxyProvider*, const GrCaps*);
 
+    void addToMemoryReport(skgpu::GpuMemoryReport* report) const {
+        if (fAtlas) {
+            fAtlas->addToMemoryReport("small_path", report);
+        }
+    }
+
     SmallPathShapeData* findOrCreate(const GrStyledShape&, int desiredDimension);
     SmallPathShapeData* findOrCreate(const GrStyledShape&, const SkMatrix& ctm);
 
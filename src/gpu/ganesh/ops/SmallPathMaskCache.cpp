@@ -0,0 +1,135 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/gpu/ganesh/ops/SmallPathMaskCache.h"
+
+#if !defined(SK_ENABLE_OPTIMIZE_SIZE)
+
+#include "include/private/base/SkAssert.h"
+#include "src/base/SkTLazy.h"
+#include "src/core/SkCachedData.h"
+#include "src/core/SkResourceCache.h"
+#include "src/gpu/ganesh/ops/SmallPathShapeData.h"
+
+#include <cstdint>
+#include <cstring>
+
+class SkDiscardableMemory;
+
+#define CHECK_LOCAL(localCache, localName, globalName, ...) \
+    ((localCache) ? localCache->localName(__VA_ARGS__) : SkResourceCache::globalName(__VA_ARGS__))
+
+namespace skgpu::ganesh {
+
+namespace {
+static unsigned gSmallPathMaskKeyNamespaceLabel;
+
+// Paths with keys longer than this are not shared. Shapes only key small paths by their data, so
+// nearly all keys fit.
+static constexpr int kMaxShapeKey32 = 64;
+
+struct SmallPathMaskKey : public SkResourceCache::Key {
+public:
+    static bool Fits(const SmallPathShapeDataKey& key) { return key.count32() <= kMaxShapeKey32; }
+
+    SmallPathMaskKey(const SmallPathShapeDataKey& key, bool distanceField)
+            : fDistanceField(distanceField)
+            , fCount32(key.count32()) {
+        SkASSERT(Fits(key));
+        memcpy(fShapeKey, key.data(), fCount32 * sizeof(uint32_t));
+        // Only the words in use are hashed and compared.
+        this->init(&gSmallPathMaskKeyNamespaceLabel, 0,
+                   sizeof(fDistanceField) + sizeof(fCount32) + fCount32 * sizeof(uint32_t));
+    }
+
+    uint32_t fDistanceField;
+    int32_t  fCount32;
+    uint32_t fShapeKey[kMaxShapeKey32];
+};
+
+struct MaskValue {
+    SmallPathMaskCache::Mask fMask;
+    SkCachedData*            fData;
+};
+
+struct SmallPathMaskRec : public SkResourceCache::Rec {
+    SmallPathMaskRec(const SmallPathMaskKey& key,
+                     const SmallPathMaskCache::Mask& mask,
+                     SkCachedData* data)
+            : fKey(key), fValue({mask, data}) {
+        fValue.fData->attachToCacheAndRef();
+    }
+    ~SmallPathMaskRec() override {
+        fValue.fData->detachFromCacheAndUnref();
+    }
+
+    SmallPathMaskKey fKey;
+    MaskValue        fValue;
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override { return sizeof(*this) + fValue.fData->size(); }
+    const char* getCategory() const override { return "small-path-mask"; }
+    SkDiscardableMemory* diagnostic_only_getDiscardable() const override {
+        return fValue.fData->diagnostic_only_getDiscardable();
+    }
+
+    static bool Visitor(const SkResourceCache::Rec& baseRec, void* contextData) {
+        const SmallPathMaskRec& rec = static_cast<const SmallPathMaskRec&>(baseRec);
+        SkTLazy<MaskValue>* result = static_cast<SkTLazy<MaskValue>*>(contextData);
+
+        SkCachedData* tmpData = rec.fValue.fData;
+        tmpData->ref();
+        if (nullptr == tmpData->data()) {
+            tmpData->unref();
+            return false;
+        }
+        result->init(rec.fValue);
+        return true;
+    }
+};
+}  // namespace
+
+SkCachedData* SmallPathMaskCache::FindAndRef(const SmallPathShapeDataKey& shapeKey,
+                                             bool distanceField,
+                                             Mask* mask,
+                                             SkResourceCache* localCache) {
+    if (!SmallPathMaskKey::Fits(shapeKey)) {
+        return nullptr;
+    }
+    SkTLazy<MaskValue> result;
+    SmallPathMaskKey key(shapeKey, distanceField);
+    if (!CHECK_LOCAL(localCache, find, Find, key, SmallPathMaskRec::Visitor, &result)) {
+        return nullptr;
+    }
+    *mask = result->fMask;
+    return result->fData;
+}
+
+SkCachedData* SmallPathMaskCache::NewData(const SmallPathShapeDataKey& shapeKey,
+                                          int width,
+                                          int height,
+                                          SkResourceCache* localCache) {
+    if (!SmallPathMaskKey::Fits(shapeKey) || width <= 0 || height <= 0) {
+        return nullptr;
+    }
+    return CHECK_LOCAL(localCache, newCachedData, NewCachedData,
+                       static_cast<size_t>(width) * height);
+}
+
+void SmallPathMaskCache::Add(const SmallPathShapeDataKey& shapeKey,
+                             bool distanceField,
+                             const Mask& mask,
+                             SkCachedData* data,
+                             SkResourceCache* localCache) {
+    SkASSERT(data && data->size() >= static_cast<size_t>(mask.fWidth) * mask.fHeight);
+    SmallPathMaskKey key(shapeKey, distanceField);
+    CHECK_LOCAL(localCache, add, Add, new SmallPathMaskRec(key, mask, data));
+}
+
+}  // namespace skgpu::ganesh
+
+#endif // SK_ENABLE_OPTIMIZE_SIZE
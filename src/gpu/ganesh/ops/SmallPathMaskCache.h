@@ -0,0 +1,63 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SmallPathMaskCache_DEFINED
+#define SmallPathMaskCache_DEFINED
+
+#if !defined(SK_ENABLE_OPTIMIZE_SIZE)
+
+#include "include/core/SkRect.h"
+
+class SkCachedData;
+class SkResourceCache;
+
+namespace skgpu::ganesh {
+
+class SmallPathShapeDataKey;
+
+/**
+ * A CPU side cache of the coverage masks and distance fields SmallPathOp makes for paths, shared
+ * by every context in the process. A context that draws a path another context already drew
+ * uploads the cached image to its atlas rather than rasterizing the path again. Entries live in
+ * the global SkResourceCache and are budgeted and purged along with everything else there.
+ *
+ * Entries are keyed by the same key as the atlas entry they fill, which holds the shape's key
+ * and either the distance field's dimension or the matrix the mask was drawn with.
+ */
+class SmallPathMaskCache {
+public:
+    struct Mask {
+        int    fWidth;
+        int    fHeight;
+        // The bounds the image covers in the shape's space for a distance field, or relative to
+        // the draw's integer translation for a coverage mask.
+        SkRect fDrawBounds;
+    };
+
+    /**
+     * On success returns a ref to the data holding the A8 image, tightly packed, and fills out
+     * 'mask'. Returns null if there is none.
+     */
+    static SkCachedData* FindAndRef(const SmallPathShapeDataKey&, bool distanceField, Mask* mask,
+                                    SkResourceCache* localCache = nullptr);
+
+    /**
+     * Returns new data big enough for an image of the given size, for the caller to fill and then
+     * Add(). Returns null if the key won't fit in the cache or there is no memory.
+     */
+    static SkCachedData* NewData(const SmallPathShapeDataKey&, int width, int height,
+                                 SkResourceCache* localCache = nullptr);
+
+    static void Add(const SmallPathShapeDataKey&, bool distanceField, const Mask&, SkCachedData*,
+                    SkResourceCache* localCache = nullptr);
+};
+
+}  // namespace skgpu::ganesh
+
+#endif // SK_ENABLE_OPTIMIZE_SIZE
+
+#endif // SmallPathMaskCache_DEFINED
@@ -10,6 +10,7 @@
 
 #include "include/core/SkPaint.h"
 #include "src/core/SkAutoPixmapStorage.h"
+#include "src/core/SkCachedData.h"
 #include "src/core/SkDistanceFieldGen.h"
 #include "src/core/SkDraw.h"
 #include "src/core/SkMatrixPriv.h"
@@ -20,6 +21,7 @@
 #include "src/gpu/ganesh/GrCaps.h"
 #include "src/gpu/ganesh/GrDistanceFieldGenFromVector.h"
 #include "src/gpu/ganesh/GrDrawOpTest.h"
+#include "src/gpu/ganesh/GrRecordingContextPriv.h"
 #include "src/gpu/ganesh/GrResourceProvider.h"
 #include "src/gpu/ganesh/SurfaceDrawContext.h"
 #include "src/gpu/ganesh/effects/GrBitmapTextGeoProc.h"
@@ -29,6 +31,7 @@
 #include "src/gpu/ganesh/ops/GrMeshDrawOp.h"
 #include "src/gpu/ganesh/ops/GrSimpleMeshDrawOpHelperWithStencil.h"
 #include "src/gpu/ganesh/ops/SmallPathAtlasMgr.h"
+#include "src/gpu/ganesh/ops/SmallPathMaskCache.h"
 #include "src/gpu/ganesh/ops/SmallPathShapeData.h"
 
 using namespace skia_private;
@@ -67,15 +70,17 @@ public:
                             const SkMatrix& viewMatrix,
                             bool gammaCorrect,
                             const GrUserStencilSettings* stencilSettings) {
+        bool shareMasks = context->priv().options().fShareSmallPathMasksAcrossContexts;
         return Helper::FactoryHelper<SmallPathOp>(context, std::move(paint), shape, viewMatrix,
-                                                  gammaCorrect, stencilSettings);
+                                                  gammaCorrect, shareMasks, stencilSettings);
     }
 
     SmallPathOp(GrProcessorSet* processorSet, const SkPMColor4f& color, const GrStyledShape& shape,
-                const SkMatrix& viewMatrix, bool gammaCorrect,
+                const SkMatrix& viewMatrix, bool gammaCorrect, bool shareMasks,
                 const GrUserStencilSettings* stencilSettings)
             : INHERITED(ClassID())
-            , fHelper(processorSet, GrAAType::kCoverage, stencilSettings) {
+            , fHelper(processorSet, GrAAType::kCoverage, stencilSettings)
+            , fShareMasks(shareMasks) {
         SkASSERT(shape.hasUnstyledKey());
         // Compute bounds
         this->setTransformedBounds(shape.bounds(), viewMatrix, HasAABloat::kYes, IsHairline::kNo);
@@ -344,6 +349,25 @@ private:
         return GrDrawOpAtlas::ErrorCode::kSucceeded == code;
     }
 
+    // Uploads the image another op, possibly of another context, made for shapeData's key.
+    // Returns false if there is none or it could not be added to the atlas.
+    bool addSharedMaskToAtlas(GrMeshDrawTarget* target,
+                              FlushInfo* flushInfo,
+                              skgpu::ganesh::SmallPathAtlasMgr* atlasMgr,
+                              skgpu::ganesh::SmallPathShapeData* shapeData,
+                              bool distanceField) const {
+        SmallPathMaskCache::Mask mask;
+        sk_sp<SkCachedData> data(
+                SmallPathMaskCache::FindAndRef(shapeData->fKey, distanceField, &mask));
+        if (!data) {
+            return false;
+        }
+        return this->addToAtlasWithRetry(target, flushInfo, atlasMgr,
+                                         mask.fWidth, mask.fHeight, data->data(),
+                                         mask.fDrawBounds,
+                                         distanceField ? SK_DistanceFieldPad : 0, shapeData);
+    }
+
     bool addDFPathToAtlas(GrMeshDrawTarget* target,
                           FlushInfo* flushInfo,
                           skgpu::ganesh::SmallPathAtlasMgr* atlasMgr,
@@ -351,6 +375,11 @@ private:
                           const GrStyledShape& shape,
                           uint32_t dimension,
                           SkScalar scale) const {
+        if (fShareMasks && this->addSharedMaskToAtlas(target, flushInfo, atlasMgr, shapeData,
+                                                      /*distanceField=*/true)) {
+            return true;
+        }
+
         const SkRect& bounds = shape.bounds();
 
         // generate bounding rect for bitmap draw
@@ -389,13 +418,22 @@ private:
         SkIRect dfBounds = devPathBounds.makeOutset(SK_DistanceFieldPad, SK_DistanceFieldPad);
         width = dfBounds.width();
         height = dfBounds.height();
+        // When sharing, the distance field is made in the shared cache's memory so that other
+        // contexts can upload it too.
+        sk_sp<SkCachedData> sharedData;
+        if (fShareMasks) {
+            sharedData.reset(SmallPathMaskCache::NewData(shapeData->fKey, width, height));
+        }
         // TODO We should really generate this directly into the plot somehow
-        SkAutoSMalloc<1024> dfStorage(width * height * sizeof(unsigned char));
+        SkAutoSMalloc<1024> dfStorage(sharedData ? 0 : width * height * sizeof(unsigned char));
+        unsigned char* dfPixels = sharedData
+                ? static_cast<unsigned char*>(sharedData->writable_data())
+                : static_cast<unsigned char*>(dfStorage.get());
 
         SkPath path;
         shape.asPath(&path);
         // Generate signed distance field directly from SkPath
-        bool succeed = GrGenerateDistanceFieldFromPath((unsigned char*)dfStorage.get(),
+        bool succeed = GrGenerateDistanceFieldFromPath(dfPixels,
                                                        path, drawMatrix, width, height,
                                                        width * sizeof(unsigned char));
         if (!succeed) {
@@ -422,7 +460,7 @@ private:
             draw.drawPathCoverage(path, paint);
 
             // Generate signed distance field
-            SkGenerateDistanceFieldFromA8Image((unsigned char*)dfStorage.get(),
+            SkGenerateDistanceFieldFromA8Image(dfPixels,
                                                (const unsigned char*)dst.addr(),
                                                dst.width(), dst.height(), dst.rowBytes());
         }
@@ -433,8 +471,13 @@ private:
         drawBounds.fRight /= scale;
         drawBounds.fBottom /= scale;
 
+        if (sharedData) {
+            SmallPathMaskCache::Add(shapeData->fKey, /*distanceField=*/true,
+                                    {width, height, drawBounds}, sharedData.get());
+        }
+
         return this->addToAtlasWithRetry(target, flushInfo, atlasMgr,
-                                         width, height, dfStorage.get(),
+                                         width, height, dfPixels,
                                          drawBounds, SK_DistanceFieldPad, shapeData);
     }
 
@@ -448,6 +491,10 @@ private:
         if (bounds.isEmpty()) {
             return false;
         }
+        if (fShareMasks && this->addSharedMaskToAtlas(target, flushInfo, atlasMgr, shapeData,
+                                                      /*distanceField=*/false)) {
+            return true;
+        }
         SkMatrix drawMatrix(ctm);
         SkScalar tx = ctm.getTranslateX();
         SkScalar ty = ctm.getTranslateY();
@@ -502,6 +549,18 @@ private:
 
         SkRect drawBounds = SkRect::Make(devPathBounds).makeOffset(-translateX, -translateY);
 
+        if (fShareMasks) {
+            sk_sp<SkCachedData> sharedData(
+                    SmallPathMaskCache::NewData(shapeData->fKey, dst.width(), dst.height()));
+            if (sharedData) {
+                SkASSERT(dst.rowBytes() == static_cast<size_t>(dst.width()));
+                memcpy(sharedData->writable_data(), dst.addr(), dst.computeByteSize());
+                SmallPathMaskCache::Add(shapeData->fKey, /*distanceField=*/false,
+                                        {dst.width(), dst.height(), drawBounds},
+                                        sharedData.get());
+            }
+        }
+
         return this->addToAtlasWithRetry(target, flushInfo, atlasMgr,
                                          dst.width(), dst.height(), dst.addr(),
                                          drawBounds, 0, shapeData);
@@ -657,6 +716,8 @@ private:
     Helper fHelper;
     bool fGammaCorrect;
     bool fWideColor;
+    // Whether to use and fill the process wide SmallPathMaskCache.
+    const bool fShareMasks;
 
     using INHERITED = GrMeshDrawOp;
 };
@@ -8,7 +8,6 @@
 
 #include "src/gpu/ganesh/ops/TriangulatingPathRenderer.h"
 
-#include "include/private/SkIDChangeListener.h"
 #include "src/core/SkGeometry.h"
 #include "src/gpu/ganesh/GrAuditTrail.h"
 #include "src/gpu/ganesh/GrCaps.h"
@@ -16,6 +15,7 @@
 #include "src/gpu/ganesh/GrDrawOpTest.h"
 #include "src/gpu/ganesh/GrEagerVertexAllocator.h"
 #include "src/gpu/ganesh/GrOpFlushState.h"
+#include "src/gpu/ganesh/GrPathMeshCache.h"
 #include "src/gpu/ganesh/GrProgramInfo.h"
 #include "src/gpu/ganesh/GrRecordingContextPriv.h"
 #include "src/gpu/ganesh/GrResourceCache.h"
@@ -49,7 +49,7 @@ namespace {
 // The TessInfo struct contains ancillary data not specifically required for the triangle
 // data (which is stored in a GrThreadSafeCache::VertexData object).
 // The 'fNumVertices' field is a temporary exception. It is still needed to support the
-// AA triangulated path case - which doesn't use the GrThreadSafeCache nor the VertexData object).
+// AA triangulated path case - which doesn't keep a TessInfo with its cached VertexData).
 // When there is an associated VertexData, its numVertices should always match the TessInfo's
 // value.
 struct TessInfo {
@@ -83,90 +83,9 @@ bool is_newer_better(SkData* incumbent, SkData* challenger) {
     return true;
 }
 
-// When the SkPathRef genID changes, invalidate a corresponding GrResource described by key.
-class UniqueKeyInvalidator : public SkIDChangeListener {
-public:
-    UniqueKeyInvalidator(const skgpu::UniqueKey& key, uint32_t contextUniqueID)
-            : fMsg(key, contextUniqueID, /* inThreadSafeCache */ true) {}
-
-private:
-    skgpu::UniqueKeyInvalidatedMessage fMsg;
-
-    void changed() override {
-        SkMessageBus<skgpu::UniqueKeyInvalidatedMessage, uint32_t>::Post(fMsg);
-    }
-};
-
-class StaticVertexAllocator : public GrEagerVertexAllocator {
-public:
-    StaticVertexAllocator(GrResourceProvider* resourceProvider, bool canMapVB)
-            : fResourceProvider(resourceProvider)
-            , fCanMapVB(canMapVB) {
-    }
-
-#ifdef SK_DEBUG
-    ~StaticVertexAllocator() override {
-        SkASSERT(!fLockStride && !fVertices && !fVertexBuffer && !fVertexData);
-    }
-#endif
-
-    void* lock(size_t stride, int eagerCount) override {
-        SkASSERT(!fLockStride && !fVertices && !fVertexBuffer && !fVertexData);
-        SkASSERT(stride && eagerCount);
-
-        size_t size = eagerCount * stride;
-        fVertexBuffer = fResourceProvider->createBuffer(size,
-                                                        GrGpuBufferType::kVertex,
-                                                        kStatic_GrAccessPattern,
-                                                        GrResourceProvider::ZeroInit::kNo);
-        if (!fVertexBuffer) {
-            return nullptr;
-        }
-        if (fCanMapVB) {
-            fVertices = fVertexBuffer->map();
-        }
-        if (!fVertices) {
-            fVertices = sk_malloc_throw(eagerCount * stride);
-            fCanMapVB = false;
-        }
-        fLockStride = stride;
-        return fVertices;
-    }
-
-    void unlock(int actualCount) override {
-        SkASSERT(fLockStride && fVertices && fVertexBuffer && !fVertexData);
-
-        if (fCanMapVB) {
-            fVertexBuffer->unmap();
-        } else {
-            fVertexBuffer->updateData(fVertices,
-                                      /*offset=*/0,
-                                      /*size=*/actualCount*fLockStride,
-                                      /*preserve=*/false);
-            sk_free(fVertices);
-        }
-
-        fVertexData = GrThreadSafeCache::MakeVertexData(std::move(fVertexBuffer),
-                                                        actualCount, fLockStride);
-
-        fVertices = nullptr;
-        fLockStride = 0;
-    }
-
-    sk_sp<GrThreadSafeCache::VertexData> detachVertexData() {
-        SkASSERT(!fLockStride && !fVertices && !fVertexBuffer && fVertexData);
-
-        return std::move(fVertexData);
-    }
-
-private:
-    sk_sp<GrThreadSafeCache::VertexData> fVertexData;
-    sk_sp<GrGpuBuffer> fVertexBuffer;
-    GrResourceProvider* fResourceProvider;
-    bool fCanMapVB;
-    void* fVertices = nullptr;
-    size_t fLockStride = 0;
-};
+// Two AA meshes added for the same key at once are for the same path, and the first one is kept
+// whichever matrix it is for.
+bool keep_incumbent(SkData*, SkData*) { return false; }
 
 class TriangulatingPathOp final : public GrMeshDrawOp {
 private:
@@ -211,6 +130,16 @@ public:
             , fViewMatrix(viewMatrix)
             , fDevClipBounds(devClipBounds)
             , fAntiAlias(GrAAType::kCoverage == aaType) {
+        // AA meshes are made in device space, so a cached one is only reused by draws with the
+        // same matrix, less an integer translation. For inverse fills they also depend on the
+        // clip, which is rarely the same from draw to draw.
+        fCacheAAMesh = fAntiAlias && !shape.inverseFilled() && !viewMatrix.hasPerspective() &&
+                       GrPathMeshCache::CanCache(shape);
+        if (fCacheAAMesh) {
+            fMeshTranslate = GrPathMeshCache::SplitTranslation(viewMatrix, &fMeshMatrix);
+        } else {
+            fMeshMatrix = viewMatrix;
+        }
         SkRect devBounds;
         viewMatrix.mapRect(&devBounds, shape.bounds());
         if (shape.inverseFilled()) {
@@ -245,21 +174,19 @@ private:
                           const SkIRect& devClipBounds) {
         static const skgpu::UniqueKey::Domain kDomain = skgpu::UniqueKey::GenerateDomain();
 
-        bool inverseFill = shape.inverseFilled();
-
         static constexpr int kClipBoundsCnt = sizeof(devClipBounds) / sizeof(uint32_t);
-        int shapeKeyDataCnt = shape.unstyledKeySize();
-        SkASSERT(shapeKeyDataCnt >= 0);
-        skgpu::UniqueKey::Builder builder(key, kDomain, shapeKeyDataCnt + kClipBoundsCnt, "Path");
-        shape.writeUnstyledKey(&builder[0]);
+        uint32_t clipBounds[kClipBoundsCnt] = {};
         // For inverse fills, the tessellation is dependent on clip bounds.
-        if (inverseFill) {
-            memcpy(&builder[shapeKeyDataCnt], &devClipBounds, sizeof(devClipBounds));
-        } else {
-            memset(&builder[shapeKeyDataCnt], 0, sizeof(devClipBounds));
+        if (shape.inverseFilled()) {
+            memcpy(clipBounds, &devClipBounds, sizeof(devClipBounds));
         }
+        GrPathMeshCache::MakeKey(key, kDomain, shape, clipBounds, "Path");
+    }
+
+    void createAAKey(skgpu::UniqueKey* key) const {
+        static const skgpu::UniqueKey::Domain kDomain = skgpu::UniqueKey::GenerateDomain();
 
-        builder.finish();
+        GrPathMeshCache::MakeKey(key, kDomain, fShape, {}, "AAPath");
     }
 
     // Triangulate the provided 'shape' in the shape's coordinate space. 'tol' should already
@@ -304,26 +231,16 @@ private:
         }
 
         if (fVertexData) {
-            if (!fVertexData->gpuBuffer()) {
-                sk_sp<GrGpuBuffer> buffer = rp->createBuffer(fVertexData->vertices(),
-                                                             fVertexData->size(),
-                                                             GrGpuBufferType::kVertex,
-                                                             kStatic_GrAccessPattern);
-                if (!buffer) {
-                    return;
-                }
-
-                // Since we have a direct context and a ref on 'fVertexData' we need not worry
-                // about any threading issues in this call.
-                fVertexData->setGpuBuffer(std::move(buffer));
+            sk_sp<GrGpuBuffer> buffer = GrPathMeshCache::GpuBuffer(rp, fVertexData.get());
+            if (!buffer) {
+                return;
             }
-
-            fMesh = CreateMesh(target, fVertexData->refGpuBuffer(), 0, fVertexData->numVertices());
+            fMesh = CreateMesh(target, std::move(buffer), 0, fVertexData->numVertices());
             return;
         }
 
         bool canMapVB = GrCaps::kNone_MapFlags != target->caps().mapBufferFlags();
-        StaticVertexAllocator allocator(rp, canMapVB);
+        GrPathMeshCache::StaticVertexAllocator allocator(rp, canMapVB);
 
         bool isLinear;
         int vertexCount = Triangulate(&allocator, fViewMatrix, fShape, fDevClipBounds, tol,
@@ -336,18 +253,10 @@ private:
 
         key.setCustomData(create_data(vertexCount, isLinear, tol));
 
-        auto [tmpV, tmpD] = threadSafeCache->addVertsWithData(key, fVertexData, is_newer_better);
-        if (tmpV != fVertexData) {
-            SkASSERT(!tmpV->gpuBuffer());
-            // In this case, although the different triangulation found in the cache is better,
-            // we will continue on with the current triangulation since it is already on the gpu.
-        } else {
-            // This isn't perfect. The current triangulation is in the cache but it may have
-            // replaced a pre-existing one. A duplicated listener is unlikely and not that
-            // expensive so we just roll with it.
-            fShape.addGenIDChangeListener(
-                sk_make_sp<UniqueKeyInvalidator>(key, target->contextUniqueID()));
-        }
+        // If a better triangulation is found in the cache, we still continue on with the current
+        // one since it is already on the gpu.
+        GrPathMeshCache::Add(threadSafeCache, key, fShape, target->contextUniqueID(), fVertexData,
+                             is_newer_better);
 
         fMesh = CreateMesh(target, fVertexData->refGpuBuffer(), 0, fVertexData->numVertices());
     }
@@ -355,13 +264,60 @@ private:
     void createAAMesh(GrMeshDrawTarget* target) {
         SkASSERT(!fVertexData);
         SkASSERT(fAntiAlias);
+        GrResourceProvider* rp = target->resourceProvider();
+        auto threadSafeCache = target->threadSafeCache();
+
+        skgpu::UniqueKey key;
+        bool cacheMesh = fCacheAAMesh;
+        bool foundEntry = false;
+        if (fCacheAAMesh) {
+            this->createAAKey(&key);
+            auto [cachedVerts, data] = threadSafeCache->findVertsWithData(key);
+            foundEntry = SkToBool(cachedVerts);
+            bool sameMatrix = GrPathMeshCache::MatrixMatches(data.get(), fMeshMatrix);
+            if (foundEntry && sameMatrix && cachedVerts->numVertices()) {
+                sk_sp<GrGpuBuffer> buffer = GrPathMeshCache::GpuBuffer(rp, cachedVerts.get());
+                if (buffer) {
+                    fMesh = CreateMesh(target, std::move(buffer), 0, cachedVerts->numVertices());
+                }
+                return;
+            }
+            key.setCustomData(GrPathMeshCache::MakeMatrixData(fMeshMatrix));
+            if (foundEntry && !sameMatrix) {
+                // The matrix changed since the path was last drawn, as it does in every frame of
+                // an animation, so a cached mesh would likely never be used. The entry only keeps
+                // the matrix, and the mesh is cached by the next draw if it has the same one.
+                GrPathMeshCache::Replace(threadSafeCache, key,
+                                         GrThreadSafeCache::MakeVertexData(nullptr, 0, 0));
+                cacheMesh = false;
+            }
+        }
+
         SkPath path = this->getPath();
         if (path.isEmpty()) {
             return;
         }
         SkRect clipBounds = SkRect::Make(fDevClipBounds);
-        path.transform(fViewMatrix);
+        clipBounds.offset(-fMeshTranslate.fX, -fMeshTranslate.fY);
+        path.transform(fMeshMatrix);
         SkScalar tol = GrPathUtils::kDefaultTolerance;
+        if (cacheMesh) {
+            bool canMapVB = GrCaps::kNone_MapFlags != target->caps().mapBufferFlags();
+            GrPathMeshCache::StaticVertexAllocator allocator(rp, canMapVB);
+            if (GrAATriangulator::PathToAATriangles(path, tol, clipBounds, &allocator) == 0) {
+                return;
+            }
+            sk_sp<GrThreadSafeCache::VertexData> vertexData = allocator.detachVertexData();
+            if (foundEntry) {
+                // The entry only had this matrix.
+                GrPathMeshCache::Replace(threadSafeCache, key, vertexData);
+            } else {
+                GrPathMeshCache::Add(threadSafeCache, key, fShape, target->contextUniqueID(),
+                                     vertexData, keep_incumbent);
+            }
+            fMesh = CreateMesh(target, vertexData->refGpuBuffer(), 0, vertexData->numVertices());
+            return;
+        }
         sk_sp<const GrBuffer> vertexBuffer;
         int firstVertex;
         GrEagerDynamicVertexAllocator allocator(target, &vertexBuffer, &firstVertex);
@@ -401,8 +357,16 @@ private:
                 coverageType = Coverage::kSolid_Type;
             }
             if (fAntiAlias) {
-                gp = GrDefaultGeoProcFactory::MakeForDeviceSpace(arena, color, coverageType,
-                                                                 localCoordsType, fViewMatrix);
+                // The vertices are in device space, less the mesh's translation.
+                SkMatrix invert = SkMatrix::I();
+                if (LocalCoords::kUnused_Type != localCoordsType &&
+                    !fMeshMatrix.invert(&invert)) {
+                    return;
+                }
+                gp = GrDefaultGeoProcFactory::Make(
+                        arena, color, coverageType,
+                        LocalCoords(LocalCoords::kUsePosition_Type, &invert),
+                        SkMatrix::Translate(fMeshTranslate.fX, fMeshTranslate.fY));
             } else {
                 gp = GrDefaultGeoProcFactory::Make(arena, color, coverageType, localCoordsType,
                                                    fViewMatrix);
@@ -478,19 +442,14 @@ private:
         // predicate will replace the version in the cache if 'fVertexData' is a more accurate
         // triangulation. This will leave some other recording threads using a poorer triangulation
         // but will result in a version with greater applicability being in the cache.
-        auto [tmpV, tmpD] = threadSafeViewCache->addVertsWithData(key, fVertexData,
-                                                                  is_newer_better);
+        auto [tmpV, tmpD] = GrPathMeshCache::Add(threadSafeViewCache, key, fShape,
+                                                 rContext->priv().contextID(), fVertexData,
+                                                 is_newer_better);
         if (tmpV != fVertexData) {
             // Someone beat us to creating the triangulation (and it is better than ours) so
             // just go ahead and use it.
             SkASSERT(cache_match(tmpD.get(), tol));
             fVertexData = std::move(tmpV);
-        } else {
-            // This isn't perfect. The current triangulation is in the cache but it may have
-            // replaced a pre-existing one. A duplicated listener is unlikely and not that
-            // expensive so we just roll with it.
-            fShape.addGenIDChangeListener(
-                    sk_make_sp<UniqueKeyInvalidator>(key, rContext->priv().contextID()));
         }
     }
 
@@ -538,6 +497,10 @@ private:
     SkMatrix       fViewMatrix;
     SkIRect        fDevClipBounds;
     bool           fAntiAlias;
+    bool           fCacheAAMesh;
+    // The matrix the AA mesh is made with, and the translation it is drawn with.
+    SkMatrix       fMeshMatrix;
+    SkIVector      fMeshTranslate = {0, 0};
 
     GrSimpleMesh*  fMesh = nullptr;
     GrProgramInfo* fProgramInfo = nullptr;
@@ -608,8 +571,8 @@ PathRenderer::CanDrawPath TriangulatingPathRenderer::onCanDrawPath(
             }
             break;
         case GrAAType::kCoverage:
-            // Use analytic AA if we don't have MSAA. In this case, we do not cache, so we accept
-            // paths without keys.
+            // Use analytic AA if we don't have MSAA. In this case, meshes are only cached for
+            // paths with keys, but we accept paths without them too.
             SkPath path;
             args.fShape->asPath(&path);
             if (path.countVerbs() > fMaxVerbCount) {
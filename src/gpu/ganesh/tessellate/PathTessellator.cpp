@@ -35,12 +35,40 @@ using CurveWriter = PatchWriter<VertexChunkPatchAllocator,
 void write_curve_patches(CurveWriter&& patchWriter,
                          const SkMatrix& shaderMatrix,
                          const PathTessellator::PathDrawList& pathDrawList) {
-    patchWriter.setShaderTransform(wangs_formula::VectorXform{shaderMatrix});
+    const wangs_formula::VectorXform xform{shaderMatrix};
+    patchWriter.setShaderTransform(xform);
+    // The mapped cubics of each path, in SoA layout, so Wang's formula is evaluated for all of
+    // them in one batch before they are written.
+    skia_private::TArray<float> cubicCoords[8];
+    skia_private::TArray<float> cubicN4;
     for (auto [pathMatrix, path, color] : pathDrawList) {
         AffineMatrix m(pathMatrix);
         if (patchWriter.attribs() & PatchAttribs::kColor) {
             patchWriter.updateColorAttrib(color);
         }
+        for (auto& coords : cubicCoords) {
+            coords.clear();
+        }
+        for (auto [verb, pts, w] : SkPathPriv::Iterate(path)) {
+            if (verb == SkPathVerb::kCubic) {
+                auto [p0, p1] = m.map2Points(pts);
+                auto [p2, p3] = m.map2Points(pts+2);
+                int k = 0;
+                for (skvx::float2 p : {p0, p1, p2, p3}) {
+                    cubicCoords[k++].push_back(p.x());
+                    cubicCoords[k++].push_back(p.y());
+                }
+            }
+        }
+        const int cubicCount = cubicCoords[0].size();
+        const float* const x[4] = {cubicCoords[0].data(), cubicCoords[2].data(),
+                                   cubicCoords[4].data(), cubicCoords[6].data()};
+        const float* const y[4] = {cubicCoords[1].data(), cubicCoords[3].data(),
+                                   cubicCoords[5].data(), cubicCoords[7].data()};
+        cubicN4.resize(cubicCount);
+        wangs_formula::cubic_p4(kPrecision, x, y, cubicCount, cubicN4.data(), xform);
+
+        int cubicIdx = 0;
         for (auto [verb, pts, w] : SkPathPriv::Iterate(path)) {
             switch (verb) {
                 case SkPathVerb::kQuad: {
@@ -60,10 +88,12 @@ void write_curve_patches(CurveWriter&& patchWriter,
                 }
 
                 case SkPathVerb::kCubic: {
-                    auto [p0, p1] = m.map2Points(pts);
-                    auto [p2, p3] = m.map2Points(pts+2);
-
-                    patchWriter.writeCubic(p0, p1, p2, p3);
+                    const int i = cubicIdx++;
+                    patchWriter.writeCubic(skvx::float2{x[0][i], y[0][i]},
+                                           skvx::float2{x[1][i], y[1][i]},
+                                           skvx::float2{x[2][i], y[2][i]},
+                                           skvx::float2{x[3][i], y[3][i]},
+                                           cubicN4[i]);
                     break;
                 }
 
@@ -49,6 +49,15 @@ void GrAtlasManager::freeAll() {
     }
 }
 
+void GrAtlasManager::addToMemoryReport(skgpu::GpuMemoryReport* report) const {
+    for (int i = 0; i < skgpu::kMaskFormatCount; ++i) {
+        if (fAtlases[i]) {
+            fAtlases[i]->addToMemoryReport(
+                    skgpu::MaskFormatToTextAtlasName(AtlasIndexToMaskFormat(i)), report);
+        }
+    }
+}
+
 bool GrAtlasManager::hasGlyph(MaskFormat format, Glyph* glyph) {
     SkASSERT(glyph);
     return this->getAtlas(format)->hasID(glyph->fAtlasLocator.plotLocator());
@@ -64,6 +64,18 @@ public:
 
     void freeAll();
 
+    // Releases atlas pages whose live glyphs fit in earlier pages. Called between flushes.
+    void compactIdle() {
+        for (int i = 0; i < skgpu::kMaskFormatCount; ++i) {
+            if (fAtlases[i]) {
+                fAtlases[i]->compactIdle();
+            }
+        }
+    }
+
+    // Adds the glyph atlases that have been created to 'report'.
+    void addToMemoryReport(skgpu::GpuMemoryReport*) const;
+
     bool hasGlyph(skgpu::MaskFormat, sktext::gpu::Glyph*);
 
     GrDrawOpAtlas::ErrorCode addGlyphToAtlas(const SkGlyph&,
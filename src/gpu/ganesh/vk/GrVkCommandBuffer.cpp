@@ -7,6 +7,7 @@
 
 #include "src/gpu/ganesh/vk/GrVkCommandBuffer.h"
 
+#include "include/core/SkExecutor.h"
 #include "include/core/SkRect.h"
 #include "src/core/SkTraceEvent.h"
 #include "src/gpu/ganesh/vk/GrVkBuffer.h"
@@ -51,11 +52,28 @@ void GrVkCommandBuffer::freeGPUData(const GrGpu* gpu, VkCommandPool cmdPool) con
     SkASSERT(!this->isWrapped());
 
     const GrVkGpu* vkGpu = (const GrVkGpu*)gpu;
-    GR_VK_CALL(vkGpu->vkInterface(), FreeCommandBuffers(vkGpu->device(), cmdPool, 1, &fCmdBuffer));
+    this->freeCommandBuffer(vkGpu, cmdPool);
 
     this->onFreeGPUData(vkGpu);
 }
 
+void GrVkCommandBuffer::freeCommandBuffer(const GrVkGpu* gpu, VkCommandPool cmdPool) const {
+    GR_VK_CALL(gpu->vkInterface(), FreeCommandBuffers(gpu->device(), cmdPool, 1, &fCmdBuffer));
+}
+
+void GrVkCommandBuffer::recordDeferredCommands(const skgpu::VulkanInterface* iface) {
+    for (const DeferredCommand* command = fDeferredCommands; command; command = command->fNext) {
+        command->fRecord(command, iface, fCmdBuffer);
+    }
+    this->dropDeferredCommands();
+}
+
+void GrVkCommandBuffer::dropDeferredCommands() {
+    fDeferredCommands = nullptr;
+    fLastDeferredCommand = &fDeferredCommands;
+    fDeferredAlloc.reset();
+}
+
 void GrVkCommandBuffer::releaseResources() {
     TRACE_EVENT0("skia.gpu", TRACE_FUNC);
     SkASSERT(!fIsActive || this->isWrapped());
@@ -170,10 +188,19 @@ void GrVkCommandBuffer::submitPipelineBarriers(const GrVkGpu* gpu, bool forSelfD
         }
 
         VkDependencyFlags dependencyFlags = fBarriersByRegion ? VK_DEPENDENCY_BY_REGION_BIT : 0;
-        GR_VK_CALL(gpu->vkInterface(), CmdPipelineBarrier(
-                fCmdBuffer, fSrcStageMask, fDstStageMask, dependencyFlags, 0, nullptr,
-                fBufferBarriers.size(), fBufferBarriers.begin(),
-                fImageBarriers.size(), fImageBarriers.begin()));
+        VkPipelineStageFlags srcStageMask = fSrcStageMask;
+        VkPipelineStageFlags dstStageMask = fDstStageMask;
+        uint32_t bufferBarrierCount = fBufferBarriers.size();
+        const VkBufferMemoryBarrier* bufferBarriers =
+                this->keepForCommand(fBufferBarriers.begin(), fBufferBarriers.size());
+        uint32_t imageBarrierCount = fImageBarriers.size();
+        const VkImageMemoryBarrier* imageBarriers =
+                this->keepForCommand(fImageBarriers.begin(), fImageBarriers.size());
+        this->recordCommand(gpu, [=](auto iface, auto cmdBuffer) {
+            GR_VK_CALL(iface, CmdPipelineBarrier(
+                    cmdBuffer, srcStageMask, dstStageMask, dependencyFlags, 0, nullptr,
+                    bufferBarrierCount, bufferBarriers, imageBarrierCount, imageBarriers));
+        });
         fBufferBarriers.clear();
         fImageBarriers.clear();
         fBarriersByRegion = false;
@@ -195,12 +222,10 @@ void GrVkCommandBuffer::bindInputBuffer(GrVkGpu* gpu, uint32_t binding,
     // TODO: once vbuffer->offset() no longer always returns 0, we will need to track the offset
     // to know if we can skip binding or not.
     if (vkBuffer != fBoundInputBuffers[binding]) {
-        VkDeviceSize offset = 0;
-        GR_VK_CALL(gpu->vkInterface(), CmdBindVertexBuffers(fCmdBuffer,
-                                                            binding,
-                                                            1,
-                                                            &vkBuffer,
-                                                            &offset));
+        this->recordCommand(gpu, [=](auto iface, auto cmdBuffer) {
+            VkDeviceSize offset = 0;
+            GR_VK_CALL(iface, CmdBindVertexBuffers(cmdBuffer, binding, 1, &vkBuffer, &offset));
+        });
         fBoundInputBuffers[binding] = vkBuffer;
         this->addGrBuffer(std::move(buffer));
     }
@@ -212,9 +237,11 @@ void GrVkCommandBuffer::bindIndexBuffer(GrVkGpu* gpu, sk_sp<const GrBuffer> buff
     // TODO: once ibuffer->offset() no longer always returns 0, we will need to track the offset
     // to know if we can skip binding or not.
     if (vkBuffer != fBoundIndexBuffer) {
-        GR_VK_CALL(gpu->vkInterface(), CmdBindIndexBuffer(fCmdBuffer,
-                                                          vkBuffer, /*offset=*/0,
-                                                          VK_INDEX_TYPE_UINT16));
+        this->recordCommand(gpu, [=](auto iface, auto cmdBuffer) {
+            GR_VK_CALL(iface, CmdBindIndexBuffer(cmdBuffer,
+                                                 vkBuffer, /*offset=*/0,
+                                                 VK_INDEX_TYPE_UINT16));
+        });
         fBoundIndexBuffer = vkBuffer;
         this->addGrBuffer(std::move(buffer));
     }
@@ -241,11 +268,15 @@ void GrVkCommandBuffer::clearAttachments(const GrVkGpu* gpu,
         }
     }
 #endif
-    GR_VK_CALL(gpu->vkInterface(), CmdClearAttachments(fCmdBuffer,
-                                                       numAttachments,
-                                                       attachments,
-                                                       numRects,
-                                                       clearRects));
+    attachments = this->keepForCommand(attachments, numAttachments);
+    clearRects = this->keepForCommand(clearRects, numRects);
+    this->recordCommand(gpu, [=](auto iface, auto cmdBuffer) {
+        GR_VK_CALL(iface, CmdClearAttachments(cmdBuffer,
+                                              numAttachments,
+                                              attachments,
+                                              numRects,
+                                              clearRects));
+    });
     if (gpu->vkCaps().mustInvalidatePrimaryCmdBufferStateAfterClearAttachments()) {
         this->invalidateState();
     }
@@ -259,21 +290,28 @@ void GrVkCommandBuffer::bindDescriptorSets(const GrVkGpu* gpu,
                                            uint32_t dynamicOffsetCount,
                                            const uint32_t* dynamicOffsets) {
     SkASSERT(fIsActive);
-    GR_VK_CALL(gpu->vkInterface(), CmdBindDescriptorSets(fCmdBuffer,
-                                                         VK_PIPELINE_BIND_POINT_GRAPHICS,
-                                                         layout,
-                                                         firstSet,
-                                                         setCount,
-                                                         descriptorSets,
-                                                         dynamicOffsetCount,
-                                                         dynamicOffsets));
+    descriptorSets = this->keepForCommand(descriptorSets, setCount);
+    dynamicOffsets = this->keepForCommand(dynamicOffsets, dynamicOffsetCount);
+    this->recordCommand(gpu, [=](auto iface, auto cmdBuffer) {
+        GR_VK_CALL(iface, CmdBindDescriptorSets(cmdBuffer,
+                                                VK_PIPELINE_BIND_POINT_GRAPHICS,
+                                                layout,
+                                                firstSet,
+                                                setCount,
+                                                descriptorSets,
+                                                dynamicOffsetCount,
+                                                dynamicOffsets));
+    });
 }
 
 void GrVkCommandBuffer::bindPipeline(const GrVkGpu* gpu, sk_sp<const GrVkPipeline> pipeline) {
     SkASSERT(fIsActive);
-    GR_VK_CALL(gpu->vkInterface(), CmdBindPipeline(fCmdBuffer,
-                                                   VK_PIPELINE_BIND_POINT_GRAPHICS,
-                                                   pipeline->pipeline()));
+    VkPipeline vkPipeline = pipeline->pipeline();
+    this->recordCommand(gpu, [=](auto iface, auto cmdBuffer) {
+        GR_VK_CALL(iface, CmdBindPipeline(cmdBuffer,
+                                          VK_PIPELINE_BIND_POINT_GRAPHICS,
+                                          vkPipeline));
+    });
     this->addResource(std::move(pipeline));
 }
 
@@ -284,12 +322,15 @@ void GrVkCommandBuffer::pushConstants(const GrVkGpu* gpu, VkPipelineLayout layou
     // offset and size must be a multiple of 4
     SkASSERT(!SkToBool(offset & 0x3));
     SkASSERT(!SkToBool(size & 0x3));
-    GR_VK_CALL(gpu->vkInterface(), CmdPushConstants(fCmdBuffer,
-                                                    layout,
-                                                    stageFlags,
-                                                    offset,
-                                                    size,
-                                                    values));
+    values = this->keepForCommand(static_cast<const uint32_t*>(values), size / 4);
+    this->recordCommand(gpu, [=](auto iface, auto cmdBuffer) {
+        GR_VK_CALL(iface, CmdPushConstants(cmdBuffer,
+                                           layout,
+                                           stageFlags,
+                                           offset,
+                                           size,
+                                           values));
+    });
 }
 
 void GrVkCommandBuffer::drawIndexed(const GrVkGpu* gpu,
@@ -301,12 +342,14 @@ void GrVkCommandBuffer::drawIndexed(const GrVkGpu* gpu,
     SkASSERT(fIsActive);
     SkASSERT(fActiveRenderPass);
     this->addingWork(gpu);
-    GR_VK_CALL(gpu->vkInterface(), CmdDrawIndexed(fCmdBuffer,
-                                                  indexCount,
-                                                  instanceCount,
-                                                  firstIndex,
-                                                  vertexOffset,
-                                                  firstInstance));
+    this->recordCommand(gpu, [=](auto iface, auto cmdBuffer) {
+        GR_VK_CALL(iface, CmdDrawIndexed(cmdBuffer,
+                                         indexCount,
+                                         instanceCount,
+                                         firstIndex,
+                                         vertexOffset,
+                                         firstInstance));
+    });
 }
 
 void GrVkCommandBuffer::draw(const GrVkGpu* gpu,
@@ -317,11 +360,13 @@ void GrVkCommandBuffer::draw(const GrVkGpu* gpu,
     SkASSERT(fIsActive);
     SkASSERT(fActiveRenderPass);
     this->addingWork(gpu);
-    GR_VK_CALL(gpu->vkInterface(), CmdDraw(fCmdBuffer,
-                                           vertexCount,
-                                           instanceCount,
-                                           firstVertex,
-                                           firstInstance));
+    this->recordCommand(gpu, [=](auto iface, auto cmdBuffer) {
+        GR_VK_CALL(iface, CmdDraw(cmdBuffer,
+                                  vertexCount,
+                                  instanceCount,
+                                  firstVertex,
+                                  firstInstance));
+    });
 }
 
 void GrVkCommandBuffer::drawIndirect(const GrVkGpu* gpu,
@@ -334,11 +379,13 @@ void GrVkCommandBuffer::drawIndirect(const GrVkGpu* gpu,
     SkASSERT(!indirectBuffer->isCpuBuffer());
     this->addingWork(gpu);
     VkBuffer vkBuffer = static_cast<const GrVkBuffer*>(indirectBuffer.get())->vkBuffer();
-    GR_VK_CALL(gpu->vkInterface(), CmdDrawIndirect(fCmdBuffer,
-                                                   vkBuffer,
-                                                   offset,
-                                                   drawCount,
-                                                   stride));
+    this->recordCommand(gpu, [=](auto iface, auto cmdBuffer) {
+        GR_VK_CALL(iface, CmdDrawIndirect(cmdBuffer,
+                                          vkBuffer,
+                                          offset,
+                                          drawCount,
+                                          stride));
+    });
     this->addGrBuffer(std::move(indirectBuffer));
 }
 
@@ -352,11 +399,13 @@ void GrVkCommandBuffer::drawIndexedIndirect(const GrVkGpu* gpu,
     SkASSERT(!indirectBuffer->isCpuBuffer());
     this->addingWork(gpu);
     VkBuffer vkBuffer = static_cast<const GrVkBuffer*>(indirectBuffer.get())->vkBuffer();
-    GR_VK_CALL(gpu->vkInterface(), CmdDrawIndexedIndirect(fCmdBuffer,
-                                                          vkBuffer,
-                                                          offset,
-                                                          drawCount,
-                                                          stride));
+    this->recordCommand(gpu, [=](auto iface, auto cmdBuffer) {
+        GR_VK_CALL(iface, CmdDrawIndexedIndirect(cmdBuffer,
+                                                 vkBuffer,
+                                                 offset,
+                                                 drawCount,
+                                                 stride));
+    });
     this->addGrBuffer(std::move(indirectBuffer));
 }
 
@@ -367,11 +416,11 @@ void GrVkCommandBuffer::setViewport(const GrVkGpu* gpu,
     SkASSERT(fIsActive);
     SkASSERT(1 == viewportCount);
     if (0 != memcmp(viewports, &fCachedViewport, sizeof(VkViewport))) {
-        GR_VK_CALL(gpu->vkInterface(), CmdSetViewport(fCmdBuffer,
-                                                      firstViewport,
-                                                      viewportCount,
-                                                      viewports));
         fCachedViewport = viewports[0];
+        VkViewport viewport = viewports[0];
+        this->recordCommand(gpu, [=](auto iface, auto cmdBuffer) {
+            GR_VK_CALL(iface, CmdSetViewport(cmdBuffer, firstViewport, 1, &viewport));
+        });
     }
 }
 
@@ -382,11 +431,11 @@ void GrVkCommandBuffer::setScissor(const GrVkGpu* gpu,
     SkASSERT(fIsActive);
     SkASSERT(1 == scissorCount);
     if (0 != memcmp(scissors, &fCachedScissor, sizeof(VkRect2D))) {
-        GR_VK_CALL(gpu->vkInterface(), CmdSetScissor(fCmdBuffer,
-                                                     firstScissor,
-                                                     scissorCount,
-                                                     scissors));
         fCachedScissor = scissors[0];
+        VkRect2D scissor = scissors[0];
+        this->recordCommand(gpu, [=](auto iface, auto cmdBuffer) {
+            GR_VK_CALL(iface, CmdSetScissor(cmdBuffer, firstScissor, 1, &scissor));
+        });
     }
 }
 
@@ -394,8 +443,11 @@ void GrVkCommandBuffer::setBlendConstants(const GrVkGpu* gpu,
                                           const float blendConstants[4]) {
     SkASSERT(fIsActive);
     if (0 != memcmp(blendConstants, fCachedBlendConstant, 4 * sizeof(float))) {
-        GR_VK_CALL(gpu->vkInterface(), CmdSetBlendConstants(fCmdBuffer, blendConstants));
         memcpy(fCachedBlendConstant, blendConstants, 4 * sizeof(float));
+        const float* constants = this->keepForCommand(blendConstants, 4);
+        this->recordCommand(gpu, [=](auto iface, auto cmdBuffer) {
+            GR_VK_CALL(iface, CmdSetBlendConstants(cmdBuffer, constants));
+        });
     }
 }
 
@@ -442,6 +494,7 @@ void GrVkPrimaryCommandBuffer::begin(GrVkGpu* gpu) {
 
     GR_VK_CALL_ERRCHECK(gpu, BeginCommandBuffer(fCmdBuffer, &cmdBufferBeginInfo));
     fIsActive = true;
+    fDeferred = gpu->commandBufferExecutor() != nullptr;
 }
 
 void GrVkPrimaryCommandBuffer::end(GrVkGpu* gpu, bool abandoningBuffer) {
@@ -454,11 +507,24 @@ void GrVkPrimaryCommandBuffer::end(GrVkGpu* gpu, bool abandoningBuffer) {
     // layers complain about calling end on a command buffer that contains resources that have
     // already been deleted. From the vulkan API it isn't required to end the command buffer to
     // delete it, so we just skip the vulkan API calls and update our own state tracking.
+    //
+    // A deferred command buffer can only execute its secondary command buffers once they are
+    // recorded, and they can't be freed while they are being recorded either.
+    for (const auto& buffer : fSecondaryCommandBuffers) {
+        VkResult result = buffer->waitUntilRecorded();
+        if (!abandoningBuffer) {
+            gpu->checkVkResult(result);
+        }
+    }
     if (!abandoningBuffer) {
         this->submitPipelineBarriers(gpu);
+        this->recordDeferredCommands(gpu->vkInterface());
 
         GR_VK_CALL_ERRCHECK(gpu, EndCommandBuffer(fCmdBuffer));
+    } else {
+        this->dropDeferredCommands();
     }
+    fDeferred = false;
     this->invalidateState();
     fIsActive = false;
     fHasWork = false;
@@ -490,12 +556,14 @@ bool GrVkPrimaryCommandBuffer::beginRenderPass(GrVkGpu* gpu,
     beginInfo.framebuffer = framebuffer->framebuffer();
     beginInfo.renderArea = renderArea;
     beginInfo.clearValueCount = renderPass->clearValueCount();
-    beginInfo.pClearValues = clearValues;
+    beginInfo.pClearValues = this->keepForCommand(clearValues, beginInfo.clearValueCount);
 
     VkSubpassContents contents = forSecondaryCB ? VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS
                                                 : VK_SUBPASS_CONTENTS_INLINE;
 
-    GR_VK_CALL(gpu->vkInterface(), CmdBeginRenderPass(fCmdBuffer, &beginInfo, contents));
+    this->recordCommand(gpu, [=](auto iface, auto cmdBuffer) {
+        GR_VK_CALL(iface, CmdBeginRenderPass(cmdBuffer, &beginInfo, contents));
+    });
     fActiveRenderPass = renderPass;
     this->addResource(renderPass);
     this->addResource(std::move(framebuffer));
@@ -507,7 +575,9 @@ void GrVkPrimaryCommandBuffer::endRenderPass(const GrVkGpu* gpu) {
     SkASSERT(fIsActive);
     SkASSERT(fActiveRenderPass);
     this->addingWork(gpu);
-    GR_VK_CALL(gpu->vkInterface(), CmdEndRenderPass(fCmdBuffer));
+    this->recordCommand(gpu, [](auto iface, auto cmdBuffer) {
+        GR_VK_CALL(iface, CmdEndRenderPass(cmdBuffer));
+    });
     fActiveRenderPass = nullptr;
 }
 
@@ -517,7 +587,9 @@ void GrVkPrimaryCommandBuffer::nexSubpass(GrVkGpu* gpu, bool forSecondaryCB) {
     SkASSERT(fActiveRenderPass);
     VkSubpassContents contents = forSecondaryCB ? VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS
                                                 : VK_SUBPASS_CONTENTS_INLINE;
-    GR_VK_CALL(gpu->vkInterface(), CmdNextSubpass(fCmdBuffer, contents));
+    this->recordCommand(gpu, [=](auto iface, auto cmdBuffer) {
+        GR_VK_CALL(iface, CmdNextSubpass(cmdBuffer, contents));
+    });
 }
 
 void GrVkPrimaryCommandBuffer::executeCommands(const GrVkGpu* gpu,
@@ -532,7 +604,14 @@ void GrVkPrimaryCommandBuffer::executeCommands(const GrVkGpu* gpu,
 
     this->addingWork(gpu);
 
-    GR_VK_CALL(gpu->vkInterface(), CmdExecuteCommands(fCmdBuffer, 1, &buffer->fCmdBuffer));
+    // By the time a deferred command buffer makes this call, end() has waited for the secondary
+    // command buffer to be recorded, and skips it if that failed.
+    const GrVkSecondaryCommandBuffer* secondary = buffer.get();
+    this->recordCommand(gpu, [=](auto iface, auto cmdBuffer) {
+        if (secondary->fRecordResult == VK_SUCCESS) {
+            GR_VK_CALL(iface, CmdExecuteCommands(cmdBuffer, 1, &secondary->fCmdBuffer));
+        }
+    });
     fSecondaryCommandBuffers.push_back(std::move(buffer));
     // When executing a secondary command buffer all state (besides render pass state) becomes
     // invalidated and must be reset. This includes bound buffers, pipelines, dynamic state, etc.
@@ -715,13 +794,18 @@ void GrVkPrimaryCommandBuffer::copyImage(const GrVkGpu* gpu,
     this->addingWork(gpu);
     this->addResource(srcImage->resource());
     this->addResource(dstImage->resource());
-    GR_VK_CALL(gpu->vkInterface(), CmdCopyImage(fCmdBuffer,
-                                                srcImage->image(),
-                                                srcLayout,
-                                                dstImage->image(),
-                                                dstLayout,
-                                                copyRegionCount,
-                                                copyRegions));
+    VkImage srcVkImage = srcImage->image();
+    VkImage dstVkImage = dstImage->image();
+    copyRegions = this->keepForCommand(copyRegions, copyRegionCount);
+    this->recordCommand(gpu, [=](auto iface, auto cmdBuffer) {
+        GR_VK_CALL(iface, CmdCopyImage(cmdBuffer,
+                                       srcVkImage,
+                                       srcLayout,
+                                       dstVkImage,
+                                       dstLayout,
+                                       copyRegionCount,
+                                       copyRegions));
+    });
 }
 
 void GrVkPrimaryCommandBuffer::blitImage(const GrVkGpu* gpu,
@@ -739,14 +823,17 @@ void GrVkPrimaryCommandBuffer::blitImage(const GrVkGpu* gpu,
     this->addingWork(gpu);
     this->addResource(srcResource);
     this->addResource(dstResource);
-    GR_VK_CALL(gpu->vkInterface(), CmdBlitImage(fCmdBuffer,
-                                                srcImage,
-                                                srcLayout,
-                                                dstImage,
-                                                dstLayout,
-                                                blitRegionCount,
-                                                blitRegions,
-                                                filter));
+    blitRegions = this->keepForCommand(blitRegions, blitRegionCount);
+    this->recordCommand(gpu, [=](auto iface, auto cmdBuffer) {
+        GR_VK_CALL(iface, CmdBlitImage(cmdBuffer,
+                                       srcImage,
+                                       srcLayout,
+                                       dstImage,
+                                       dstLayout,
+                                       blitRegionCount,
+                                       blitRegions,
+                                       filter));
+    });
 }
 
 void GrVkPrimaryCommandBuffer::blitImage(const GrVkGpu* gpu,
@@ -777,13 +864,17 @@ void GrVkPrimaryCommandBuffer::copyImageToBuffer(const GrVkGpu* gpu,
     SkASSERT(fIsActive);
     SkASSERT(!fActiveRenderPass);
     this->addingWork(gpu);
-    GrVkBuffer* vkBuffer = static_cast<GrVkBuffer*>(dstBuffer.get());
-    GR_VK_CALL(gpu->vkInterface(), CmdCopyImageToBuffer(fCmdBuffer,
-                                                        srcImage->image(),
-                                                        srcLayout,
-                                                        vkBuffer->vkBuffer(),
-                                                        copyRegionCount,
-                                                        copyRegions));
+    VkImage srcVkImage = srcImage->image();
+    VkBuffer dstVkBuffer = static_cast<GrVkBuffer*>(dstBuffer.get())->vkBuffer();
+    copyRegions = this->keepForCommand(copyRegions, copyRegionCount);
+    this->recordCommand(gpu, [=](auto iface, auto cmdBuffer) {
+        GR_VK_CALL(iface, CmdCopyImageToBuffer(cmdBuffer,
+                                               srcVkImage,
+                                               srcLayout,
+                                               dstVkBuffer,
+                                               copyRegionCount,
+                                               copyRegions));
+    });
     this->addResource(srcImage->resource());
     this->addGrBuffer(std::move(dstBuffer));
 }
@@ -798,12 +889,16 @@ void GrVkPrimaryCommandBuffer::copyBufferToImage(const GrVkGpu* gpu,
     SkASSERT(!fActiveRenderPass);
     this->addingWork(gpu);
 
-    GR_VK_CALL(gpu->vkInterface(), CmdCopyBufferToImage(fCmdBuffer,
-                                                        srcBuffer,
-                                                        dstImage->image(),
-                                                        dstLayout,
-                                                        copyRegionCount,
-                                                        copyRegions));
+    VkImage dstVkImage = dstImage->image();
+    copyRegions = this->keepForCommand(copyRegions, copyRegionCount);
+    this->recordCommand(gpu, [=](auto iface, auto cmdBuffer) {
+        GR_VK_CALL(iface, CmdCopyBufferToImage(cmdBuffer,
+                                               srcBuffer,
+                                               dstVkImage,
+                                               dstLayout,
+                                               copyRegionCount,
+                                               copyRegions));
+    });
     this->addResource(dstImage->resource());
 }
 
@@ -816,16 +911,44 @@ void GrVkPrimaryCommandBuffer::fillBuffer(GrVkGpu* gpu,
     SkASSERT(!fActiveRenderPass);
     this->addingWork(gpu);
 
-    const GrVkBuffer* bufferVk = static_cast<GrVkBuffer*>(buffer.get());
+    VkBuffer vkBuffer = static_cast<GrVkBuffer*>(buffer.get())->vkBuffer();
 
-    GR_VK_CALL(gpu->vkInterface(), CmdFillBuffer(fCmdBuffer,
-                                                 bufferVk->vkBuffer(),
-                                                 offset,
-                                                 size,
-                                                 data));
+    this->recordCommand(gpu, [=](auto iface, auto cmdBuffer) {
+        GR_VK_CALL(iface, CmdFillBuffer(cmdBuffer,
+                                        vkBuffer,
+                                        offset,
+                                        size,
+                                        data));
+    });
     this->addGrBuffer(std::move(buffer));
 }
 
+void GrVkPrimaryCommandBuffer::resetQueryPool(GrVkGpu* gpu,
+                                              VkQueryPool pool,
+                                              uint32_t firstQuery,
+                                              uint32_t count) {
+    SkASSERT(fIsActive);
+    SkASSERT(!fActiveRenderPass);
+    this->addingWork(gpu);
+
+    this->recordCommand(gpu, [=](auto iface, auto cmdBuffer) {
+        GR_VK_CALL(iface, CmdResetQueryPool(cmdBuffer, pool, firstQuery, count));
+    });
+}
+
+void GrVkPrimaryCommandBuffer::writeTimestamp(GrVkGpu* gpu,
+                                              VkPipelineStageFlagBits stage,
+                                              VkQueryPool pool,
+                                              uint32_t query) {
+    SkASSERT(fIsActive);
+    SkASSERT(!fActiveRenderPass);
+    this->addingWork(gpu);
+
+    this->recordCommand(gpu, [=](auto iface, auto cmdBuffer) {
+        GR_VK_CALL(iface, CmdWriteTimestamp(cmdBuffer, stage, pool, query));
+    });
+}
+
 void GrVkPrimaryCommandBuffer::copyBuffer(GrVkGpu* gpu,
                                           sk_sp<GrGpuBuffer> srcBuffer,
                                           sk_sp<GrGpuBuffer> dstBuffer,
@@ -845,14 +968,17 @@ void GrVkPrimaryCommandBuffer::copyBuffer(GrVkGpu* gpu,
     }
 #endif
 
-    const GrVkBuffer* srcVk = static_cast<GrVkBuffer*>(srcBuffer.get());
-    const GrVkBuffer* dstVk = static_cast<GrVkBuffer*>(dstBuffer.get());
-
-    GR_VK_CALL(gpu->vkInterface(), CmdCopyBuffer(fCmdBuffer,
-                                                 srcVk->vkBuffer(),
-                                                 dstVk->vkBuffer(),
-                                                 regionCount,
-                                                 regions));
+    VkBuffer srcVkBuffer = static_cast<GrVkBuffer*>(srcBuffer.get())->vkBuffer();
+    VkBuffer dstVkBuffer = static_cast<GrVkBuffer*>(dstBuffer.get())->vkBuffer();
+    regions = this->keepForCommand(regions, regionCount);
+
+    this->recordCommand(gpu, [=](auto iface, auto cmdBuffer) {
+        GR_VK_CALL(iface, CmdCopyBuffer(cmdBuffer,
+                                        srcVkBuffer,
+                                        dstVkBuffer,
+                                        regionCount,
+                                        regions));
+    });
     this->addGrBuffer(std::move(srcBuffer));
     this->addGrBuffer(std::move(dstBuffer));
 }
@@ -869,10 +995,11 @@ void GrVkPrimaryCommandBuffer::updateBuffer(GrVkGpu* gpu,
     SkASSERT(dataSize <= 65536);
     SkASSERT(0 == (dataSize & 0x03));  // four byte aligned
     this->addingWork(gpu);
-    GR_VK_CALL(
-            gpu->vkInterface(),
-            CmdUpdateBuffer(
-                    fCmdBuffer, dstBuffer->vkBuffer(), dstOffset, dataSize, (const uint32_t*)data));
+    VkBuffer dstVkBuffer = dstBuffer->vkBuffer();
+    const uint32_t* words = this->keepForCommand((const uint32_t*)data, dataSize / 4);
+    this->recordCommand(gpu, [=](auto iface, auto cmdBuffer) {
+        GR_VK_CALL(iface, CmdUpdateBuffer(cmdBuffer, dstVkBuffer, dstOffset, dataSize, words));
+    });
     this->addGrBuffer(std::move(dstBuffer));
 }
 
@@ -885,12 +1012,18 @@ void GrVkPrimaryCommandBuffer::clearColorImage(const GrVkGpu* gpu,
     SkASSERT(!fActiveRenderPass);
     this->addingWork(gpu);
     this->addResource(image->resource());
-    GR_VK_CALL(gpu->vkInterface(), CmdClearColorImage(fCmdBuffer,
-                                                      image->image(),
-                                                      image->currentLayout(),
-                                                      color,
-                                                      subRangeCount,
-                                                      subRanges));
+    VkImage vkImage = image->image();
+    VkImageLayout layout = image->currentLayout();
+    color = this->keepForCommand(color, 1);
+    subRanges = this->keepForCommand(subRanges, subRangeCount);
+    this->recordCommand(gpu, [=](auto iface, auto cmdBuffer) {
+        GR_VK_CALL(iface, CmdClearColorImage(cmdBuffer,
+                                             vkImage,
+                                             layout,
+                                             color,
+                                             subRangeCount,
+                                             subRanges));
+    });
 }
 
 void GrVkPrimaryCommandBuffer::clearDepthStencilImage(const GrVkGpu* gpu,
@@ -902,12 +1035,18 @@ void GrVkPrimaryCommandBuffer::clearDepthStencilImage(const GrVkGpu* gpu,
     SkASSERT(!fActiveRenderPass);
     this->addingWork(gpu);
     this->addResource(image->resource());
-    GR_VK_CALL(gpu->vkInterface(), CmdClearDepthStencilImage(fCmdBuffer,
-                                                             image->image(),
-                                                             image->currentLayout(),
-                                                             color,
-                                                             subRangeCount,
-                                                             subRanges));
+    VkImage vkImage = image->image();
+    VkImageLayout layout = image->currentLayout();
+    color = this->keepForCommand(color, 1);
+    subRanges = this->keepForCommand(subRanges, subRangeCount);
+    this->recordCommand(gpu, [=](auto iface, auto cmdBuffer) {
+        GR_VK_CALL(iface, CmdClearDepthStencilImage(cmdBuffer,
+                                                    vkImage,
+                                                    layout,
+                                                    color,
+                                                    subRangeCount,
+                                                    subRanges));
+    });
 }
 
 void GrVkPrimaryCommandBuffer::resolveImage(GrVkGpu* gpu,
@@ -922,13 +1061,20 @@ void GrVkPrimaryCommandBuffer::resolveImage(GrVkGpu* gpu,
     this->addResource(srcImage.resource());
     this->addResource(dstImage.resource());
 
-    GR_VK_CALL(gpu->vkInterface(), CmdResolveImage(fCmdBuffer,
-                                                   srcImage.image(),
-                                                   srcImage.currentLayout(),
-                                                   dstImage.image(),
-                                                   dstImage.currentLayout(),
-                                                   regionCount,
-                                                   regions));
+    VkImage srcVkImage = srcImage.image();
+    VkImageLayout srcLayout = srcImage.currentLayout();
+    VkImage dstVkImage = dstImage.image();
+    VkImageLayout dstLayout = dstImage.currentLayout();
+    regions = this->keepForCommand(regions, regionCount);
+    this->recordCommand(gpu, [=](auto iface, auto cmdBuffer) {
+        GR_VK_CALL(iface, CmdResolveImage(cmdBuffer,
+                                          srcVkImage,
+                                          srcLayout,
+                                          dstVkImage,
+                                          dstLayout,
+                                          regionCount,
+                                          regions));
+    });
 }
 
 void GrVkPrimaryCommandBuffer::onFreeGPUData(const GrVkGpu* gpu) const {
@@ -947,10 +1093,19 @@ void GrVkPrimaryCommandBuffer::onFreeGPUData(const GrVkGpu* gpu) const {
 GrVkSecondaryCommandBuffer* GrVkSecondaryCommandBuffer::Create(GrVkGpu* gpu,
                                                                GrVkCommandPool* cmdPool) {
     SkASSERT(cmdPool);
+    // Recording a command buffer uses its pool, so that each one recorded on the executor needs a
+    // pool of its own.
+    VkCommandPool ownPool = VK_NULL_HANDLE;
+    if (gpu->commandBufferExecutor()) {
+        ownPool = GrVkCommandPool::CreateVkCommandPool(gpu);
+        if (ownPool == VK_NULL_HANDLE) {
+            return nullptr;
+        }
+    }
     const VkCommandBufferAllocateInfo cmdInfo = {
         VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,   // sType
         nullptr,                                          // pNext
-        cmdPool->vkCommandPool(),                         // commandPool
+        ownPool ? ownPool : cmdPool->vkCommandPool(),     // commandPool
         VK_COMMAND_BUFFER_LEVEL_SECONDARY,                // level
         1                                                 // bufferCount
     };
@@ -959,9 +1114,12 @@ GrVkSecondaryCommandBuffer* GrVkSecondaryCommandBuffer::Create(GrVkGpu* gpu,
     VkResult err;
     GR_VK_CALL_RESULT(gpu, err, AllocateCommandBuffers(gpu->device(), &cmdInfo, &cmdBuffer));
     if (err) {
+        if (ownPool) {
+            GR_VK_CALL(gpu->vkInterface(), DestroyCommandPool(gpu->device(), ownPool, nullptr));
+        }
         return nullptr;
     }
-    return new GrVkSecondaryCommandBuffer(cmdBuffer, /*externalRenderPass=*/nullptr);
+    return new GrVkSecondaryCommandBuffer(cmdBuffer, /*externalRenderPass=*/nullptr, ownPool);
 }
 
 GrVkSecondaryCommandBuffer* GrVkSecondaryCommandBuffer::Create(
@@ -969,23 +1127,49 @@ GrVkSecondaryCommandBuffer* GrVkSecondaryCommandBuffer::Create(
     return new GrVkSecondaryCommandBuffer(cmdBuffer, externalRenderPass);
 }
 
+GrVkSecondaryCommandBuffer::~GrVkSecondaryCommandBuffer() {
+    this->waitUntilRecorded();
+}
+
 void GrVkSecondaryCommandBuffer::begin(GrVkGpu* gpu, const GrVkFramebuffer* framebuffer,
                                        const GrVkRenderPass* compatibleRenderPass) {
     SkASSERT(!fIsActive);
     SkASSERT(!this->isWrapped());
     SkASSERT(compatibleRenderPass);
+    // A recycled command buffer may still be being recorded for its last use.
+    this->waitUntilRecorded();
     fActiveRenderPass = compatibleRenderPass;
 
-    VkCommandBufferInheritanceInfo inheritanceInfo;
-    memset(&inheritanceInfo, 0, sizeof(VkCommandBufferInheritanceInfo));
-    inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
-    inheritanceInfo.pNext = nullptr;
-    inheritanceInfo.renderPass = fActiveRenderPass->vkRenderPass();
-    inheritanceInfo.subpass = 0; // Currently only using 1 subpass for each render pass
-    inheritanceInfo.framebuffer = framebuffer ? framebuffer->framebuffer() : VK_NULL_HANDLE;
-    inheritanceInfo.occlusionQueryEnable = false;
-    inheritanceInfo.queryFlags = 0;
-    inheritanceInfo.pipelineStatistics = 0;
+    memset(&fInheritanceInfo, 0, sizeof(VkCommandBufferInheritanceInfo));
+    fInheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+    fInheritanceInfo.pNext = nullptr;
+    fInheritanceInfo.renderPass = fActiveRenderPass->vkRenderPass();
+    fInheritanceInfo.subpass = 0; // Currently only using 1 subpass for each render pass
+    fInheritanceInfo.framebuffer = framebuffer ? framebuffer->framebuffer() : VK_NULL_HANDLE;
+    fInheritanceInfo.occlusionQueryEnable = false;
+    fInheritanceInfo.queryFlags = 0;
+    fInheritanceInfo.pipelineStatistics = 0;
+
+    fRecordResult = VK_SUCCESS;
+    fIsActive = true;
+    if (fCommandPool != VK_NULL_HANDLE) {
+        // The commands are kept until end(), which has them recorded on the executor.
+        fDeferred = true;
+        return;
+    }
+    fRecordResult = this->beginAndRecord(gpu->vkInterface(), gpu->device());
+    gpu->checkVkResult(fRecordResult);
+}
+
+VkResult GrVkSecondaryCommandBuffer::beginAndRecord(const skgpu::VulkanInterface* iface,
+                                                    VkDevice device) {
+    VkResult result;
+    if (fCommandPool != VK_NULL_HANDLE) {
+        result = GR_VK_CALL(iface, ResetCommandPool(device, fCommandPool, 0));
+        if (result != VK_SUCCESS) {
+            return result;
+        }
+    }
 
     VkCommandBufferBeginInfo cmdBufferBeginInfo;
     memset(&cmdBufferBeginInfo, 0, sizeof(VkCommandBufferBeginInfo));
@@ -993,26 +1177,75 @@ void GrVkSecondaryCommandBuffer::begin(GrVkGpu* gpu, const GrVkFramebuffer* fram
     cmdBufferBeginInfo.pNext = nullptr;
     cmdBufferBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT |
             VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-    cmdBufferBeginInfo.pInheritanceInfo = &inheritanceInfo;
-
-    GR_VK_CALL_ERRCHECK(gpu, BeginCommandBuffer(fCmdBuffer, &cmdBufferBeginInfo));
+    cmdBufferBeginInfo.pInheritanceInfo = &fInheritanceInfo;
 
-    fIsActive = true;
+    result = GR_VK_CALL(iface, BeginCommandBuffer(fCmdBuffer, &cmdBufferBeginInfo));
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+    this->recordDeferredCommands(iface);
+    return VK_SUCCESS;
 }
 
 void GrVkSecondaryCommandBuffer::end(GrVkGpu* gpu) {
     SkASSERT(fIsActive);
     SkASSERT(!this->isWrapped());
-    GR_VK_CALL_ERRCHECK(gpu, EndCommandBuffer(fCmdBuffer));
     this->invalidateState();
     fHasWork = false;
     fIsActive = false;
+    if (fDeferred) {
+        fDeferred = false;
+        const skgpu::VulkanInterface* iface = gpu->vkInterface();
+        VkDevice device = gpu->device();
+        fRecording = std::make_unique<SkTaskGroup>(*gpu->commandBufferExecutor());
+        fRecording->add([this, iface, device] {
+            TRACE_EVENT0("skia.gpu", "GrVkSecondaryCommandBuffer::record");
+            VkResult result = this->beginAndRecord(iface, device);
+            if (result == VK_SUCCESS) {
+                result = GR_VK_CALL(iface, EndCommandBuffer(fCmdBuffer));
+            }
+            fRecordResult = result;
+        });
+        return;
+    }
+    if (fRecordResult == VK_SUCCESS) {
+        GR_VK_CALL_ERRCHECK(gpu, EndCommandBuffer(fCmdBuffer));
+    }
+}
+
+void GrVkSecondaryCommandBuffer::stopDeferring(GrVkGpu* gpu) {
+    SkASSERT(fIsActive);
+    if (!fDeferred) {
+        return;
+    }
+    fDeferred = false;
+    fRecordResult = this->beginAndRecord(gpu->vkInterface(), gpu->device());
+    gpu->checkVkResult(fRecordResult);
+}
+
+VkResult GrVkSecondaryCommandBuffer::waitUntilRecorded() {
+    if (fRecording) {
+        fRecording->wait();
+        fRecording.reset();
+    }
+    return fRecordResult;
 }
 
 void GrVkSecondaryCommandBuffer::recycle(GrVkCommandPool* cmdPool) {
     if (this->isWrapped()) {
         delete this;
     } else {
+        this->waitUntilRecorded();
         cmdPool->recycleSecondaryCommandBuffer(this);
     }
 }
+
+void GrVkSecondaryCommandBuffer::freeCommandBuffer(const GrVkGpu* gpu,
+                                                   VkCommandPool cmdPool) const {
+    if (fCommandPool != VK_NULL_HANDLE) {
+        // Destroying the pool frees the command buffer too.
+        GR_VK_CALL(gpu->vkInterface(), DestroyCommandPool(gpu->device(), fCommandPool, nullptr));
+    } else {
+        INHERITED::freeCommandBuffer(gpu, cmdPool);
+    }
+}
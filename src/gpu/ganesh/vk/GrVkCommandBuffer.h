@@ -9,12 +9,18 @@
 #define GrVkCommandBuffer_DEFINED
 
 #include "include/gpu/vk/GrVkTypes.h"
+#include "src/base/SkArenaAlloc.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/gpu/GpuRefCnt.h"
 #include "src/gpu/ganesh/GrManagedResource.h"
 #include "src/gpu/ganesh/vk/GrVkGpu.h"
 #include "src/gpu/ganesh/vk/GrVkSemaphore.h"
 #include "src/gpu/ganesh/vk/GrVkUtil.h"
 
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
 class GrVkFramebuffer;
 class GrVkImage;
 class GrVkPipeline;
@@ -139,6 +145,9 @@ public:
 
     void freeGPUData(const GrGpu* gpu, VkCommandPool pool) const;
 
+    // Frees the VkCommandBuffer, which came from cmdPool unless it has a pool of its own.
+    virtual void freeCommandBuffer(const GrVkGpu* gpu, VkCommandPool cmdPool) const;
+
     bool hasWork() const { return fHasWork; }
 
 protected:
@@ -155,7 +164,60 @@ protected:
 
     void submitPipelineBarriers(const GrVkGpu* gpu, bool forSelfDependency = false);
 
+    // Makes the Vulkan call, as fn(iface, cmdBuffer), or keeps it to make later if the
+    // command buffer is deferred. The call can only capture values, or pointers to data from
+    // keepForCommand(), since it may be made on another thread.
+    template <typename Fn>
+    void recordCommand(const GrVkGpu* gpu, Fn&& fn) {
+        if (!fDeferred) {
+            fn(gpu->vkInterface(), fCmdBuffer);
+            return;
+        }
+        using Command = DeferredCommandImpl<std::decay_t<Fn>>;
+        static_assert(std::is_trivially_destructible_v<Command>);
+        Command* command = fDeferredAlloc.make<Command>(std::forward<Fn>(fn));
+        *fLastDeferredCommand = command;
+        fLastDeferredCommand = &command->fNext;
+    }
+
+    // Returns the data itself, or a copy of it that lasts until the deferred commands are made.
+    template <typename T>
+    const T* keepForCommand(const T* data, size_t count) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        if (!fDeferred || !count) {
+            return data;
+        }
+        T* copy = fDeferredAlloc.makeArrayDefault<T>(count);
+        memcpy(copy, data, count * sizeof(T));
+        return copy;
+    }
+
+    // Makes the calls of the deferred commands in order, and drops them.
+    void recordDeferredCommands(const skgpu::VulkanInterface* iface);
+    void dropDeferredCommands();
+
 private:
+    struct DeferredCommand {
+        using RecordProc = void (*)(const DeferredCommand*,
+                                    const skgpu::VulkanInterface*,
+                                    VkCommandBuffer);
+        RecordProc fRecord;
+        DeferredCommand* fNext = nullptr;
+    };
+
+    template <typename Fn>
+    struct DeferredCommandImpl : DeferredCommand {
+        explicit DeferredCommandImpl(Fn fn) : DeferredCommand{&Record}, fFn(std::move(fn)) {}
+
+        static void Record(const DeferredCommand* command,
+                           const skgpu::VulkanInterface* iface,
+                           VkCommandBuffer cmdBuffer) {
+            static_cast<const DeferredCommandImpl*>(command)->fFn(iface, cmdBuffer);
+        }
+
+        Fn fFn;
+    };
+
     static constexpr int kInitialTrackedResourcesCount = 32;
 
 protected:
@@ -199,6 +261,14 @@ protected:
     VkPipelineStageFlags fDstStageMask = 0;
 
     bool fIsWrapped;
+
+    // A deferred command buffer keeps its commands to make the Vulkan calls for later, all at once.
+    bool                      fDeferred = false;
+
+private:
+    SkArenaAllocWithReset     fDeferredAlloc{1024};
+    DeferredCommand*          fDeferredCommands = nullptr;
+    DeferredCommand**         fLastDeferredCommand = &fDeferredCommands;
 };
 
 class GrVkSecondaryCommandBuffer;
@@ -209,6 +279,9 @@ public:
 
     static GrVkPrimaryCommandBuffer* Create(GrVkGpu* gpu, VkCommandPool cmdPool);
 
+    // When the gpu records secondary command buffers on its executor, the primary command buffer
+    // is deferred, since it can only execute them once they are recorded. Its commands are then
+    // made by end().
     void begin(GrVkGpu* gpu);
     void end(GrVkGpu* gpu, bool abandoningBuffer = false);
 
@@ -311,6 +384,13 @@ public:
                       uint32_t regionCount,
                       const VkImageResolve* regions);
 
+    void resetQueryPool(GrVkGpu* gpu, VkQueryPool pool, uint32_t firstQuery, uint32_t count);
+
+    void writeTimestamp(GrVkGpu* gpu,
+                        VkPipelineStageFlagBits stage,
+                        VkQueryPool pool,
+                        uint32_t query);
+
     bool submitToQueue(GrVkGpu* gpu, VkQueue queue,
                        skia_private::TArray<GrVkSemaphore::Resource*>& signalSemaphores,
                        skia_private::TArray<GrVkSemaphore::Resource*>& waitSemaphores);
@@ -345,28 +425,55 @@ private:
 
 class GrVkSecondaryCommandBuffer : public GrVkCommandBuffer {
 public:
+    // If the gpu records secondary command buffers on its executor, the command buffer is made in
+    // a pool of its own, so that it can be recorded on any thread.
     static GrVkSecondaryCommandBuffer* Create(GrVkGpu* gpu, GrVkCommandPool* cmdPool);
     // Used for wrapping an external secondary command buffer.
     static GrVkSecondaryCommandBuffer* Create(VkCommandBuffer externalSecondaryCB,
                                               const GrVkRenderPass* externalRenderPass);
 
+    ~GrVkSecondaryCommandBuffer() override;
+
+    // A command buffer with a pool of its own is deferred between begin() and end(), and end()
+    // records it on the gpu's executor.
     void begin(GrVkGpu* gpu, const GrVkFramebuffer* framebuffer,
                const GrVkRenderPass* compatibleRenderPass);
     void end(GrVkGpu* gpu);
 
+    // Makes the calls of the commands so far, and of later ones as they come, so that the
+    // VkCommandBuffer can be handed to a client to record into.
+    void stopDeferring(GrVkGpu* gpu);
+
+    // Waits for the executor to record the command buffer, if it is, and returns how that went.
+    VkResult waitUntilRecorded();
+
     void recycle(GrVkCommandPool* cmdPool);
 
+    void freeCommandBuffer(const GrVkGpu* gpu, VkCommandPool cmdPool) const override;
+
     VkCommandBuffer vkCommandBuffer() { return fCmdBuffer; }
 
 private:
     explicit GrVkSecondaryCommandBuffer(VkCommandBuffer cmdBuffer,
-                                        const GrVkRenderPass* externalRenderPass)
-            : INHERITED(cmdBuffer, SkToBool(externalRenderPass)) {
+                                        const GrVkRenderPass* externalRenderPass,
+                                        VkCommandPool cmdPool = VK_NULL_HANDLE)
+            : INHERITED(cmdBuffer, SkToBool(externalRenderPass))
+            , fCommandPool(cmdPool) {
         fActiveRenderPass = externalRenderPass;
     }
 
     void onFreeGPUData(const GrVkGpu* gpu) const override {}
 
+    // Begins the VkCommandBuffer and makes the calls of the deferred commands.
+    VkResult beginAndRecord(const skgpu::VulkanInterface* iface, VkDevice device);
+
+    // The pool of its own, if it has one.
+    VkCommandPool                  fCommandPool;
+    VkCommandBufferInheritanceInfo fInheritanceInfo;
+    std::unique_ptr<SkTaskGroup>   fRecording;
+    // Set by the executor's thread before fRecording is done.
+    VkResult                       fRecordResult = VK_SUCCESS;
+
     // Used for accessing fIsActive (on GrVkCommandBuffer)
     friend class GrVkPrimaryCommandBuffer;
 
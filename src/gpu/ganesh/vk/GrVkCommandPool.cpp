@@ -12,7 +12,7 @@
 #include "src/gpu/ganesh/vk/GrVkCommandBuffer.h"
 #include "src/gpu/ganesh/vk/GrVkGpu.h"
 
-GrVkCommandPool* GrVkCommandPool::Create(GrVkGpu* gpu) {
+VkCommandPool GrVkCommandPool::CreateVkCommandPool(GrVkGpu* gpu) {
     VkCommandPoolCreateFlags cmdPoolCreateFlags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
     if (gpu->protectedContext()) {
         cmdPoolCreateFlags |= VK_COMMAND_POOL_CREATE_PROTECTED_BIT;
@@ -28,6 +28,14 @@ GrVkCommandPool* GrVkCommandPool::Create(GrVkGpu* gpu) {
     VkCommandPool pool;
     GR_VK_CALL_RESULT(gpu, result, CreateCommandPool(gpu->device(), &cmdPoolInfo, nullptr, &pool));
     if (result != VK_SUCCESS) {
+        return VK_NULL_HANDLE;
+    }
+    return pool;
+}
+
+GrVkCommandPool* GrVkCommandPool::Create(GrVkGpu* gpu) {
+    VkCommandPool pool = CreateVkCommandPool(gpu);
+    if (pool == VK_NULL_HANDLE) {
         return nullptr;
     }
 
@@ -66,9 +74,7 @@ void GrVkCommandPool::recycleSecondaryCommandBuffer(GrVkSecondaryCommandBuffer*
     if (fAvailableSecondaryBuffers.size() < fMaxCachedSecondaryCommandBuffers) {
         fAvailableSecondaryBuffers.push_back(std::move(scb));
     } else {
-        VkCommandBuffer vkBuffer = buffer->vkCommandBuffer();
-        GR_VK_CALL(fGpu->vkInterface(),
-                   FreeCommandBuffers(fGpu->device(), fCommandPool, 1, &vkBuffer));
+        buffer->freeCommandBuffer(fGpu, fCommandPool);
     }
 }
 
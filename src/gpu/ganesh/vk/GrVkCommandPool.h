@@ -22,6 +22,9 @@ class GrVkCommandPool : public GrVkManagedResource {
 public:
     static GrVkCommandPool* Create(GrVkGpu* gpu);
 
+    // Creates a VkCommandPool like the one Create() makes, or returns VK_NULL_HANDLE.
+    static VkCommandPool CreateVkCommandPool(GrVkGpu* gpu);
+
     VkCommandPool vkCommandPool() const {
         return fCommandPool;
     }
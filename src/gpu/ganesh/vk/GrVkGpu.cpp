@@ -233,6 +233,11 @@ GrVkGpu::GrVkGpu(GrDirectContext* direct,
 
     fResourceProvider.init();
 
+    const GrContextOptions& options = direct->priv().options();
+    if (options.fRecordVulkanCommandBuffersInParallel) {
+        fCommandBufferExecutor = options.fExecutor;
+    }
+
     fMainCmdPool = fResourceProvider.findOrCreateCommandPool();
     if (fMainCmdPool) {
         fMainCmdBuffer = fMainCmdPool->getPrimaryCommandBuffer();
@@ -269,6 +274,13 @@ void GrVkGpu::destroyResources() {
 
     fMSAALoadManager.destroyResources(this);
 
+    if (fTimerQueryPool != VK_NULL_HANDLE) {
+        VK_CALL(DestroyQueryPool(fDevice, fTimerQueryPool, nullptr));
+        fTimerQueryPool = VK_NULL_HANDLE;
+    }
+    fFreeTimers.clear();
+    fTimerCount = 0;
+
     // must call this just before we destroy the command pool and VkDevice
     fResourceProvider.destroyResources();
 }
@@ -2237,11 +2249,20 @@ void GrVkGpu::takeOwnershipOfBuffer(sk_sp<GrGpuBuffer> buffer) {
 }
 
 bool GrVkGpu::onSubmitToGpu(GrSyncCpu sync) {
+    bool submitted;
     if (sync == GrSyncCpu::kYes) {
-        return this->submitCommandBuffer(kForce_SyncQueue);
+        submitted = this->submitCommandBuffer(kForce_SyncQueue);
     } else {
-        return this->submitCommandBuffer(kSkip_SyncQueue);
+        submitted = this->submitCommandBuffer(kSkip_SyncQueue);
+    }
+
+    int storeInterval = this->getContext()->priv().options().fVulkanPipelineCacheStoreInterval;
+    if (storeInterval > 0 && ++fSubmitsSincePipelineCacheStore >= storeInterval &&
+        fResourceProvider.hasUnstoredPipelines()) {
+        this->storeVkPipelineCacheData();
+        fSubmitsSincePipelineCacheStore = 0;
     }
+    return submitted;
 }
 
 void GrVkGpu::finishOutstandingGpuWork() {
@@ -2694,6 +2715,82 @@ void GrVkGpu::submit(GrOpsRenderPass* renderPass) {
     fCachedOpsRenderPass->reset();
 }
 
+// Bounds the timestamps written if getPerfStats() is never called to collect the results.
+static constexpr uint32_t kMaxTimers = 256;
+
+uint32_t GrVkGpu::startTimer() {
+    // Timers are only started when GrPerfStats are enabled.
+    const VkPhysicalDeviceLimits& limits = fPhysDevProps.limits;
+    if (!limits.timestampComputeAndGraphics || limits.timestampPeriod <= 0 || !fMainCmdBuffer) {
+        return 0;
+    }
+    if (fTimerQueryPool == VK_NULL_HANDLE) {
+        VkQueryPoolCreateInfo createInfo = {};
+        createInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+        createInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+        createInfo.queryCount = 2 * kMaxTimers;
+        VkResult result;
+        VK_CALL_RET(result, CreateQueryPool(fDevice, &createInfo, nullptr, &fTimerQueryPool));
+        if (result != VK_SUCCESS) {
+            fTimerQueryPool = VK_NULL_HANDLE;
+            return 0;
+        }
+    }
+    uint32_t timer;
+    if (!fFreeTimers.empty()) {
+        timer = fFreeTimers.back();
+        fFreeTimers.pop_back();
+    } else if (fTimerCount < kMaxTimers) {
+        timer = ++fTimerCount;
+    } else {
+        return 0;
+    }
+    uint32_t firstQuery = 2 * (timer - 1);
+    fMainCmdBuffer->resetQueryPool(this, fTimerQueryPool, firstQuery, 2);
+    fMainCmdBuffer->writeTimestamp(this, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, fTimerQueryPool,
+                                   firstQuery);
+    return timer;
+}
+
+void GrVkGpu::endTimer(uint32_t timer) {
+    SkASSERT(timer && timer <= fTimerCount);
+    if (!fMainCmdBuffer) {
+        return;
+    }
+    // The task may have submitted the command buffer the timer started in, but the end timestamp
+    // still comes after all of its work.
+    fMainCmdBuffer->writeTimestamp(this, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, fTimerQueryPool,
+                                   2 * (timer - 1) + 1);
+}
+
+GrGpu::TimerResult GrVkGpu::timerResult(uint32_t timer, uint64_t* nanos) {
+    SkASSERT(timer && timer <= fTimerCount);
+    uint64_t timestamps[2];
+    VkResult result;
+    GR_VK_CALL_RESULT_NOCHECK(this, result, GetQueryPoolResults(fDevice,
+                                                                fTimerQueryPool,
+                                                                2 * (timer - 1),
+                                                                2,
+                                                                sizeof(timestamps),
+                                                                timestamps,
+                                                                sizeof(uint64_t),
+                                                                VK_QUERY_RESULT_64_BIT));
+    if (result == VK_NOT_READY) {
+        return TimerResult::kPending;
+    }
+    if (result != VK_SUCCESS || timestamps[1] < timestamps[0]) {
+        return TimerResult::kFailed;
+    }
+    *nanos = static_cast<uint64_t>((timestamps[1] - timestamps[0]) *
+                                   static_cast<double>(fPhysDevProps.limits.timestampPeriod));
+    return TimerResult::kReady;
+}
+
+void GrVkGpu::deleteTimer(uint32_t timer) {
+    SkASSERT(timer && timer <= fTimerCount);
+    fFreeTimers.push_back(timer);
+}
+
 [[nodiscard]] std::unique_ptr<GrSemaphore> GrVkGpu::makeSemaphore(bool isOwned) {
     return GrVkSemaphore::Make(this, isOwned);
 }
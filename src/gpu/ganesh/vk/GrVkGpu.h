@@ -31,6 +31,7 @@ class GrVkPrimaryCommandBuffer;
 class GrVkRenderPass;
 class GrVkSecondaryCommandBuffer;
 class GrVkTexture;
+class SkExecutor;
 enum class SkTextureCompressionType;
 
 namespace skgpu {
@@ -84,6 +85,10 @@ public:
 
     GrVkPrimaryCommandBuffer* currentCommandBuffer() const { return fMainCmdBuffer; }
 
+    // The executor that secondary command buffers are recorded on, if they are recorded in
+    // parallel (see GrContextOptions::fRecordVulkanCommandBuffersInParallel).
+    SkExecutor* commandBufferExecutor() const { return fCommandBufferExecutor; }
+
     void xferBarrier(GrRenderTarget*, GrXferBarrierType) override;
 
     bool setBackendTextureState(const GrBackendTexture&,
@@ -156,6 +161,11 @@ public:
 
     void submit(GrOpsRenderPass*) override;
 
+    uint32_t startTimer() override;
+    void endTimer(uint32_t timer) override;
+    TimerResult timerResult(uint32_t timer, uint64_t* nanos) override;
+    void deleteTimer(uint32_t timer) override;
+
     [[nodiscard]] std::unique_ptr<GrSemaphore> makeSemaphore(bool isOwned) override;
     std::unique_ptr<GrSemaphore> wrapBackendSemaphore(const GrBackendSemaphore&,
                                                       GrSemaphoreWrapType,
@@ -420,6 +430,8 @@ private:
     // just a raw pointer; object's lifespan is managed by fCmdPool
     GrVkPrimaryCommandBuffer*                             fMainCmdBuffer;
 
+    SkExecutor*                                           fCommandBufferExecutor = nullptr;
+
     skia_private::STArray<1, GrVkSemaphore::Resource*>    fSemaphoresToWaitOn;
     skia_private::STArray<1, GrVkSemaphore::Resource*>    fSemaphoresToSignal;
 
@@ -439,6 +451,15 @@ private:
     skgpu::VulkanDeviceLostContext                        fDeviceLostContext;
     skgpu::VulkanDeviceLostProc                           fDeviceLostProc;
 
+    // The timestamps for startTimer(), made when first needed. Timer N writes queries 2N-2 and
+    // 2N-1 at its start and end.
+    VkQueryPool                                           fTimerQueryPool = VK_NULL_HANDLE;
+    skia_private::TArray<uint32_t>                        fFreeTimers;
+    uint32_t                                              fTimerCount = 0;
+
+    // For GrContextOptions::fVulkanPipelineCacheStoreInterval.
+    int                                                   fSubmitsSincePipelineCacheStore = 0;
+
     using INHERITED = GrGpu;
 };
 
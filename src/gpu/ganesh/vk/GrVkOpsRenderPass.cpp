@@ -253,7 +253,10 @@ bool GrVkOpsRenderPass::init(const GrOpsRenderPass::LoadAndStoreInfo& colorInfo,
         return false;
     }
 
-    if (!fGpu->vkCaps().preferPrimaryOverSecondaryCommandBuffers()) {
+    // Render passes are recorded into secondary command buffers when those can be recorded in
+    // parallel, even where primary command buffers are preferred.
+    if (!fGpu->vkCaps().preferPrimaryOverSecondaryCommandBuffers() ||
+        fGpu->commandBufferExecutor()) {
         SkASSERT(fGpu->cmdPool());
         fCurrentSecondaryCommandBuffer = fGpu->cmdPool()->findOrCreateSecondaryCommandBuffer(fGpu);
         if (!fCurrentSecondaryCommandBuffer) {
@@ -581,7 +584,7 @@ void GrVkOpsRenderPass::addAdditionalRenderPass(bool mustUseSecondaryCommandBuff
     }
 
     if (!fGpu->vkCaps().preferPrimaryOverSecondaryCommandBuffers() ||
-        mustUseSecondaryCommandBuffer) {
+        fGpu->commandBufferExecutor() || mustUseSecondaryCommandBuffer) {
         SkASSERT(fGpu->cmdPool());
         fCurrentSecondaryCommandBuffer = fGpu->cmdPool()->findOrCreateSecondaryCommandBuffer(fGpu);
         if (!fCurrentSecondaryCommandBuffer) {
@@ -864,6 +867,9 @@ void GrVkOpsRenderPass::onExecuteDrawable(std::unique_ptr<SkDrawable::GpuDrawHan
     }
     SkASSERT(fCurrentSecondaryCommandBuffer);
 
+    // The drawable records into the command buffer right away, after what we have recorded so far.
+    fCurrentSecondaryCommandBuffer->stopDeferring(fGpu);
+
     GrVkDrawableInfo vkInfo;
     vkInfo.fSecondaryCommandBuffer = fCurrentSecondaryCommandBuffer->vkCommandBuffer();
     vkInfo.fCompatibleRenderPass = fCurrentRenderPass->vkRenderPass();
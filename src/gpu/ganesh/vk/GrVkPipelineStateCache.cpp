@@ -7,6 +7,7 @@
 
 #include "include/gpu/GrContextOptions.h"
 #include "include/gpu/GrDirectContext.h"
+#include "src/base/SkTime.h"
 #include "src/gpu/ganesh/GrAttachment.h"
 #include "src/gpu/ganesh/GrDirectContextPriv.h"
 #include "src/gpu/ganesh/GrFragmentProcessor.h"
@@ -120,13 +121,16 @@ GrVkPipelineState* GrVkResourceProvider::PipelineStateCache::findOrCreatePipelin
         if (stat) {
             *stat = Stats::ProgramCacheResult::kMiss;
         }
+        double startNanos = SkTime::GetNSecs();
         GrVkPipelineState* pipelineState(GrVkPipelineStateBuilder::CreatePipelineState(
                 fGpu, desc, programInfo, compatibleRenderPass, overrideSubpassForResolveLoad));
+        fPerfCounters.recordMiss(SkTime::GetNSecs() - startNanos);
         if (!pipelineState) {
             return nullptr;
         }
         entry = fMap.insert(desc, std::make_unique<Entry>(fGpu, pipelineState));
         return (*entry)->fPipelineState.get();
     }
+    fPerfCounters.recordHit();
     return (*entry)->fPipelineState.get();
 }
@@ -20,6 +20,25 @@
 #include "src/gpu/ganesh/vk/GrVkRenderTarget.h"
 #include "src/gpu/ganesh/vk/GrVkUtil.h"
 
+namespace {
+
+// The driver checks the vendor, device and pipeline cache UUID in the header of the data itself,
+// but not the driver version, and a blob from an older driver is often accepted and then never
+// hit. Keying on all of them means each driver gets its own entry.
+sk_sp<SkData> make_pipeline_cache_key(const VkPhysicalDeviceProperties& props) {
+    const uint32_t ids[] = {GrVkGpu::kPipelineCache_PersistentCacheKeyType,
+                            props.vendorID,
+                            props.deviceID,
+                            props.driverVersion};
+    sk_sp<SkData> key = SkData::MakeUninitialized(sizeof(ids) + VK_UUID_SIZE);
+    char* ptr = static_cast<char*>(key->writable_data());
+    memcpy(ptr, ids, sizeof(ids));
+    memcpy(ptr + sizeof(ids), props.pipelineCacheUUID, VK_UUID_SIZE);
+    return key;
+}
+
+}  // anonymous namespace
+
 GrVkResourceProvider::GrVkResourceProvider(GrVkGpu* gpu)
     : fGpu(gpu)
     , fPipelineCache(VK_NULL_HANDLE) {
@@ -41,15 +60,16 @@ VkPipelineCache GrVkResourceProvider::pipelineCache() {
         createInfo.pNext = nullptr;
         createInfo.flags = 0;
 
-        auto persistentCache = fGpu->getContext()->priv().getPersistentCache();
+        // This may be called while the context is being made, before it has taken its persistent
+        // cache from the options.
+        auto persistentCache = fGpu->getContext()->priv().options().fPersistentCache;
         sk_sp<SkData> cached;
         if (persistentCache) {
-            uint32_t key = GrVkGpu::kPipelineCache_PersistentCacheKeyType;
-            sk_sp<SkData> keyData = SkData::MakeWithoutCopy(&key, sizeof(uint32_t));
+            sk_sp<SkData> keyData = make_pipeline_cache_key(fGpu->physicalDeviceProperties());
             cached = persistentCache->load(*keyData);
         }
         bool usedCached = false;
-        if (cached) {
+        if (cached && cached->size() >= 16 + VK_UUID_SIZE) {
             const uint32_t* cacheHeader = (const uint32_t*)cached->data();
             if (cacheHeader[1] == VK_PIPELINE_CACHE_HEADER_VERSION_ONE) {
                 // For version one of the header, the total header size is 16 bytes plus
@@ -91,6 +111,12 @@ void GrVkResourceProvider::init() {
     fDescriptorSetManagers.emplace_back(dsm);
     SkASSERT(2 == fDescriptorSetManagers.size());
     fInputDSHandle = GrVkDescriptorSetManager::Handle(1);
+
+    // Load any stored pipeline cache now rather than when the first pipeline is needed, which is
+    // usually in the middle of the first frame.
+    if (fGpu->getContext()->priv().options().fPersistentCache) {
+        this->pipelineCache();
+    }
 }
 
 sk_sp<const GrVkPipeline> GrVkResourceProvider::makePipeline(
@@ -100,6 +126,7 @@ sk_sp<const GrVkPipeline> GrVkResourceProvider::makePipeline(
         VkRenderPass compatibleRenderPass,
         VkPipelineLayout layout,
         uint32_t subpass) {
+    fHasUnstoredPipelines = true;
     return GrVkPipeline::Make(fGpu, programInfo, shaderStageInfo, shaderStageCount,
                               compatibleRenderPass, layout, this->pipelineCache(), subpass);
 }
@@ -317,6 +344,7 @@ sk_sp<const GrVkPipeline> GrVkResourceProvider::findOrCreateMSAALoadPipeline(
         if (!pipeline) {
             return nullptr;
         }
+        fHasUnstoredPipelines = true;
         fMSAALoadPipelines.push_back({pipeline, &renderPass});
     }
     SkASSERT(pipeline);
@@ -559,11 +587,11 @@ void GrVkResourceProvider::storePipelineCacheData() {
         return;
     }
 
-    uint32_t key = GrVkGpu::kPipelineCache_PersistentCacheKeyType;
-    sk_sp<SkData> keyData = SkData::MakeWithoutCopy(&key, sizeof(uint32_t));
-
     fGpu->getContext()->priv().getPersistentCache()->store(
-            *keyData, *SkData::MakeWithoutCopy(data.get(), dataSize), SkString("VkPipelineCache"));
+            *make_pipeline_cache_key(fGpu->physicalDeviceProperties()),
+            *SkData::MakeWithoutCopy(data.get(), dataSize),
+            SkString("VkPipelineCache"));
+    fHasUnstoredPipelines = false;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -202,6 +202,9 @@ public:
 
     void storePipelineCacheData();
 
+    // Whether pipelines have been made since the pipeline cache data was last stored.
+    bool hasUnstoredPipelines() const { return fHasUnstoredPipelines; }
+
     // Destroy any cached resources. To be called before destroying the VkDevice.
     // The assumption is that all queues are idle and all command buffers are finished.
     // For resource tracing to work properly, this should be called after unrefing all other
@@ -296,6 +299,7 @@ private:
 
     // Central cache for creating pipelines
     VkPipelineCache fPipelineCache;
+    bool fHasUnstoredPipelines = false;
 
     struct MSAALoadPipeline {
         sk_sp<const GrVkPipeline> fPipeline;
@@ -14,6 +14,7 @@
 #include "src/gpu/graphite/RasterPathAtlas.h"
 #include "src/gpu/graphite/RecorderPriv.h"
 #include "src/gpu/graphite/RendererProvider.h"
+#include "src/gpu/graphite/SharedContext.h"
 #include "src/gpu/graphite/TextureProxy.h"
 #include "src/gpu/graphite/text/TextAtlasManager.h"
 
@@ -28,8 +29,16 @@ AtlasProvider::PathAtlasFlagsBitMask AtlasProvider::QueryPathAtlasSupport(const
     return flags;
 }
 
+static sk_sp<TextAtlasManager> text_atlas_manager(Recorder* recorder) {
+    if (TextAtlasManager* shared = recorder->priv().sharedContext()->sharedTextAtlasManager()) {
+        return sk_ref_sp(shared);
+    }
+    return sk_make_sp<TextAtlasManager>(recorder->priv().caps(), DrawAtlas::Shared::kNo);
+}
+
 AtlasProvider::AtlasProvider(Recorder* recorder)
-        : fTextAtlasManager(std::make_unique<TextAtlasManager>(recorder))
+        : fRecorder(recorder)
+        , fTextAtlasManager(text_atlas_manager(recorder))
         , fRasterPathAtlas(std::make_unique<RasterPathAtlas>(recorder))
         , fPathAtlasFlags(QueryPathAtlasSupport(recorder->priv().caps())) {}
 
@@ -88,7 +97,7 @@ void AtlasProvider::clearTexturePool() {
 }
 
 void AtlasProvider::recordUploads(DrawContext* dc) {
-    if (!fTextAtlasManager->recordUploads(dc)) {
+    if (!fTextAtlasManager->recordUploads(fRecorder, dc)) {
         SKGPU_LOG_E("TextAtlasManager uploads have failed -- may see invalid results.");
     }
 
@@ -98,10 +107,17 @@ void AtlasProvider::recordUploads(DrawContext* dc) {
 }
 
 void AtlasProvider::postFlush() {
-    fTextAtlasManager->postFlush();
+    fTextAtlasManager->postFlush(fRecorder);
     if (fRasterPathAtlas) {
         fRasterPathAtlas->postFlush();
     }
 }
 
+void AtlasProvider::addToMemoryReport(GpuMemoryReport* report) const {
+    fTextAtlasManager->addToMemoryReport(report);
+    if (fRasterPathAtlas) {
+        fRasterPathAtlas->addToMemoryReport(report);
+    }
+}
+
 }  // namespace skgpu::graphite
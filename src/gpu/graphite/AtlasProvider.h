@@ -16,6 +16,10 @@
 #include <memory>
 #include <unordered_map>
 
+namespace skgpu {
+struct GpuMemoryReport;
+}
+
 namespace skgpu::graphite {
 
 class Caps;
@@ -49,7 +53,8 @@ public:
     ~AtlasProvider() = default;
 
     // Returns the TextAtlasManager that provides access to persistent DrawAtlas instances used in
-    // glyph rendering. This TextAtlasManager is always available.
+    // glyph rendering. This TextAtlasManager is always available, and is shared with the other
+    // Recorders of the Context if it was made with ContextOptions::fShareGlyphAtlasAcrossRecorders.
     TextAtlasManager* textAtlasManager() const { return fTextAtlasManager.get(); }
 
     // Returns whether a particular atlas type is available. Currently PathAtlasFlags::kRaster is
@@ -80,8 +85,14 @@ public:
     // Handle any post-flush work (garbage collection, e.g.)
     void postFlush();
 
+    // Adds the glyph and raster path atlases to 'report'. The glyph atlases are included even when
+    // they are shared with other Recorders.
+    void addToMemoryReport(GpuMemoryReport*) const;
+
 private:
-    std::unique_ptr<TextAtlasManager> fTextAtlasManager;
+    Recorder* fRecorder;
+
+    sk_sp<TextAtlasManager> fTextAtlasManager;
 
     // Accumulates atlas coverage masks generated by software rendering that are required by one or
     // more entries in `fPendingDraws`. During the snapUploadTask step, prior to pending draws
@@ -45,6 +45,11 @@ protected:
                        /*commandBufferRefsAsUsageRefs=*/commandBufferRefsAsUsageRefs)
             , fSize(size) {}
 
+    // For buffers that wrap memory the client owns, which don't count against the budget.
+    Buffer(const SharedContext* sharedContext, size_t size, Ownership ownership)
+            : Resource(sharedContext, ownership, skgpu::Budgeted::kNo, size)
+            , fSize(size) {}
+
     void* fMapPtr = nullptr;
 
 private:
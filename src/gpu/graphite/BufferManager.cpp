@@ -8,6 +8,7 @@
 #include "src/gpu/graphite/BufferManager.h"
 
 #include "include/gpu/graphite/Recording.h"
+#include "src/base/SkMathPriv.h"
 #include "src/gpu/graphite/Caps.h"
 #include "src/gpu/graphite/ContextPriv.h"
 #include "src/gpu/graphite/Log.h"
@@ -19,6 +20,9 @@
 #include "src/gpu/graphite/task/ClearBuffersTask.h"
 #include "src/gpu/graphite/task/CopyTask.h"
 
+#include <algorithm>
+#include <utility>
+
 namespace skgpu::graphite {
 
 namespace {
@@ -29,6 +33,12 @@ static constexpr size_t kIndexBufferSize   = 2 << 10; //  2 KB
 static constexpr size_t kUniformBufferSize = 2 << 10; //  2 KB
 static constexpr size_t kStorageBufferSize = 2 << 10; //  2 KB
 
+// The first buffer of each type in a Recording is made large enough for what the last Recording
+// used of that type, rounded up to a power of two, up to this size. A Recorder that snaps similar
+// Recordings each frame then gets one buffer per type from the ResourceCache instead of a block at
+// a time, and finds the ones the GPU is done with in the cache since they keep the same sizes.
+static constexpr size_t kMaxBufferSizeHint = 1 << 20; // 1 MB
+
 // The limit for all data created by the StaticBufferManager. This data remains alive for
 // the entire SharedContext so we want to keep it small and give a concrete upper bound to
 // clients for our steady-state memory usage.
@@ -156,6 +166,7 @@ void DrawBufferManager::returnVertexBytes(size_t unusedBytes) {
     }
     SkASSERT(fCurrentBuffers[kVertexBufferIndex].fOffset >= unusedBytes);
     fCurrentBuffers[kVertexBufferIndex].fOffset -= unusedBytes;
+    fBytesWritten -= unusedBytes;
 }
 
 std::pair<IndexWriter, BindBufferInfo> DrawBufferManager::getIndexWriter(size_t requiredBytes) {
@@ -269,6 +280,7 @@ ScratchBuffer DrawBufferManager::getScratchStorage(size_t requiredBytes) {
             this->onFailedBuffer();
             return {};
         }
+        fBufferAllocations++;
     }
     return {requiredBytes, info.fStartAlignment, std::move(buffer), this};
 }
@@ -338,6 +350,13 @@ void DrawBufferManager::transferToRecording(Recording* recording) {
     // The current draw buffers have not been added to fUsedBuffers,
     // so we need to handle them as well.
     for (auto& info : fCurrentBuffers) {
+        if (info.fBuffer) {
+            this->retireBuffer(&info);
+        }
+        const size_t usedBytes = std::exchange(info.fUsedBytes, 0);
+        info.fSizeHint = usedBytes > info.fBlockSize
+                ? SkNextPow2(SkToInt(std::min(usedBytes, kMaxBufferSizeHint)))
+                : 0;
         if (!info.fBuffer) {
             continue;
         }
@@ -362,6 +381,27 @@ void DrawBufferManager::transferToRecording(Recording* recording) {
         info.fTransferBuffer = {};
         info.fOffset = 0;
     }
+
+    fBytesWritten = 0;
+    fBufferAllocations = 0;
+    fAlignmentBytes = 0;
+    fUnusedBytes = 0;
+}
+
+size_t DrawBufferManager::unusedBytes() const {
+    size_t unusedBytes = fUnusedBytes;
+    for (const auto& info : fCurrentBuffers) {
+        if (info.fBuffer) {
+            unusedBytes += info.fBuffer->size() - info.fOffset;
+        }
+    }
+    return unusedBytes;
+}
+
+void DrawBufferManager::retireBuffer(BufferInfo* info) {
+    SkASSERT(info->fBuffer && info->fOffset <= info->fBuffer->size());
+    info->fUsedBytes += info->fOffset;
+    fUnusedBytes += info->fBuffer->size() - info->fOffset;
 }
 
 std::pair<void*, BindBufferInfo> DrawBufferManager::prepareMappedBindBuffer(
@@ -388,6 +428,7 @@ std::pair<void*, BindBufferInfo> DrawBufferManager::prepareMappedBindBuffer(
     }
 
     mapPtr = SkTAddOffset<void>(mapPtr, static_cast<ptrdiff_t>(bindInfo.fOffset));
+    fBytesWritten += requiredBytes;
     return {mapPtr, bindInfo};
 }
 
@@ -408,6 +449,7 @@ BindBufferInfo DrawBufferManager::prepareBindBuffer(BufferInfo* info,
 
     if (info->fBuffer &&
         !can_fit(requiredBytes, info->fBuffer->size(), info->fOffset, info->fStartAlignment)) {
+        this->retireBuffer(info);
         fUsedBuffers.emplace_back(std::move(info->fBuffer), info->fTransferBuffer);
         info->fTransferBuffer = {};
     }
@@ -419,7 +461,9 @@ BindBufferInfo DrawBufferManager::prepareBindBuffer(BufferInfo* info,
         AccessPattern accessPattern = (useTransferBuffer || !supportCpuUpload)
                                               ? AccessPattern::kGpuOnly
                                               : AccessPattern::kHostVisible;
-        size_t bufferSize = sufficient_block_size(requiredBytes, info->fBlockSize);
+        size_t bufferSize = std::max(sufficient_block_size(requiredBytes, info->fBlockSize),
+                                     info->fSizeHint);
+        info->fSizeHint = 0;
         info->fBuffer = fResourceProvider->findOrCreateBuffer(bufferSize,
                                                               info->fType,
                                                               accessPattern,
@@ -429,6 +473,7 @@ BindBufferInfo DrawBufferManager::prepareBindBuffer(BufferInfo* info,
             this->onFailedBuffer();
             return {};
         }
+        fBufferAllocations++;
     }
 
     if (useTransferBuffer && !info->fTransferBuffer) {
@@ -444,7 +489,9 @@ BindBufferInfo DrawBufferManager::prepareBindBuffer(BufferInfo* info,
         SkASSERT(info->fTransferMapPtr);
     }
 
-    info->fOffset = SkAlignTo(info->fOffset, info->fStartAlignment);
+    const size_t alignedOffset = SkAlignTo(info->fOffset, info->fStartAlignment);
+    fAlignmentBytes += alignedOffset - info->fOffset;
+    info->fOffset = alignedOffset;
     BindBufferInfo bindInfo{info->fBuffer.get(), info->fOffset};
     info->fOffset += requiredBytes;
 
@@ -151,6 +151,14 @@ public:
     // hasMappingFailed() returns true.
     void transferToRecording(Recording*);
 
+    // The bytes handed out by the mapped writers and pointers since the last transferToRecording().
+    size_t bytesWritten() const { return fBytesWritten; }
+    // Since the last transferToRecording(): the buffers requested from the ResourceProvider, the
+    // padding skipped to align suballocations, and the bytes left unused at the end of the buffers.
+    int bufferAllocations() const { return fBufferAllocations; }
+    size_t alignmentBytes() const { return fAlignmentBytes; }
+    size_t unusedBytes() const;
+
 private:
     friend class ScratchBuffer;
 
@@ -166,6 +174,11 @@ private:
         BindBufferInfo fTransferBuffer{};
         void* fTransferMapPtr = nullptr;
         size_t fOffset = 0;
+
+        // The bytes used by this type's buffers so far in the current Recording, and the size of
+        // the first buffer of the next one, picked from what the last Recording used.
+        size_t fUsedBytes = 0;
+        size_t fSizeHint = 0;
     };
     std::pair<void* /*mappedPtr*/, BindBufferInfo> prepareMappedBindBuffer(BufferInfo* info,
                                                                            size_t requiredBytes,
@@ -178,6 +191,9 @@ private:
 
     sk_sp<Buffer> findReusableSbo(size_t bufferSize);
 
+    // Notes that the current buffer of 'info' won't be suballocated from again.
+    void retireBuffer(BufferInfo* info);
+
     // Marks manager in a failed state, unmaps any previously collected buffers.
     void onFailedBuffer();
 
@@ -212,6 +228,11 @@ private:
     // If mapping failed on Buffers created/managed by this DrawBufferManager or by the mapped
     // transfer buffers from the UploadManager, remember so that the next Recording will fail.
     bool fMappingFailed = false;
+
+    size_t fBytesWritten = 0;
+    int fBufferAllocations = 0;
+    size_t fAlignmentBytes = 0;
+    size_t fUnusedBytes = 0;
 };
 
 /**
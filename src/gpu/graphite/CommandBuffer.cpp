@@ -7,6 +7,7 @@
 
 #include "src/gpu/graphite/CommandBuffer.h"
 
+#include "include/gpu/graphite/GraphiteTypes.h"
 #include "src/core/SkTraceEvent.h"
 #include "src/gpu/RefCntedCallback.h"
 #include "src/gpu/graphite/Buffer.h"
@@ -57,10 +58,29 @@ void CommandBuffer::callFinishedProcs(bool success) {
         for (int i = 0; i < fFinishedProcs.size(); ++i) {
             fFinishedProcs[i]->setFailureResult();
         }
+    } else if (!fGpuTimedStats.empty()) {
+        const uint64_t gpuTimeNs = this->gpuTimerResultNs();
+        for (RecordingStats* stats : fGpuTimedStats) {
+            stats->fGpuTimeNs = gpuTimeNs;
+        }
     }
+    fGpuTimedStats.clear();
+    fGpuTimerStarted = false;
     fFinishedProcs.clear();
 }
 
+bool CommandBuffer::startGpuTimer() {
+    if (!fGpuTimerStarted) {
+        fGpuTimerStarted = this->onStartGpuTimer();
+    }
+    return fGpuTimerStarted;
+}
+
+void CommandBuffer::addGpuTimedStats(RecordingStats* stats) {
+    SkASSERT(fGpuTimerStarted);
+    fGpuTimedStats.push_back(stats);
+}
+
 void CommandBuffer::addBuffersToAsyncMapOnSubmit(SkSpan<const sk_sp<Buffer>> buffers) {
     for (size_t i = 0; i < buffers.size(); ++i) {
         SkASSERT(buffers[i]);
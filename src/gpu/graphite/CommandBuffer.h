@@ -11,12 +11,14 @@
 #include "include/core/SkColor.h"
 #include "include/core/SkRect.h"
 #include "include/core/SkRefCnt.h"
+#include "include/core/SkSpan.h"
 #include "include/private/base/SkTArray.h"
 #include "src/gpu/GpuRefCnt.h"
 #include "src/gpu/graphite/CommandTypes.h"
 #include "src/gpu/graphite/DrawTypes.h"
 #include "src/gpu/graphite/DrawWriter.h"
 #include "src/gpu/graphite/Resource.h"
+#include "src/gpu/graphite/ResourceTypes.h"
 
 namespace skgpu {
 class RefCntedCallback;
@@ -31,6 +33,7 @@ class DrawPass;
 class SharedContext;
 class GraphicsPipeline;
 struct RenderPassDesc;
+struct RecordingStats;
 class Sampler;
 class Texture;
 class TextureProxy;
@@ -61,8 +64,17 @@ public:
     virtual bool setNewCommandBufferResources() = 0;
 
     void addFinishedProc(sk_sp<RefCntedCallback> finishedProc);
+    // Sets the fGpuTimeNs of the stats passed to addGpuTimedStats() if 'success' is true, then
+    // calls the finished procs.
     void callFinishedProcs(bool success);
 
+    // Starts timing the command buffer on the GPU, from now until it is submitted, if it hasn't
+    // started already. Returns false if the backend can't time command buffers.
+    bool startGpuTimer();
+    // Once the timer is started, the GPU time is written into 'stats' before the finished procs are
+    // called, so 'stats' must stay alive until then.
+    void addGpuTimedStats(RecordingStats* stats);
+
     virtual void addWaitSemaphores(size_t numWaitSemaphores,
                                    const BackendSemaphore* waitSemaphores) {}
     virtual void addSignalSemaphores(size_t numWaitSemaphores,
@@ -112,11 +124,36 @@ public:
     void setReplayTranslation(SkIVector translation) { fReplayTranslation = translation; }
     void clearReplayTranslation() { fReplayTranslation = {0, 0}; }
 
+    // This has subsequently added commands bind the buffers of 'remaps' in place of the uniform
+    // buffer ranges they cover, for a Recording whose uniforms were patched. 'remaps' must stay
+    // valid until clearUniformBufferRemaps() is called.
+    void setUniformBufferRemaps(SkSpan<const UniformBufferRemap> remaps) {
+        fUniformBufferRemaps = remaps;
+    }
+    void clearUniformBufferRemaps() { fUniformBufferRemaps = {}; }
+
 protected:
     CommandBuffer();
 
+    bool isGpuTimerStarted() const { return fGpuTimerStarted; }
+
+    // Returns 'info', or where it was moved to by the current uniform buffer remaps.
+    BindUniformBufferInfo remapUniformBuffer(const BindUniformBufferInfo& info) const {
+        for (const UniformBufferRemap& remap : fUniformBufferRemaps) {
+            if (info.fBuffer == remap.fFrom && info.fOffset >= remap.fOffset &&
+                info.fOffset < remap.fOffset + remap.fSize) {
+                BindUniformBufferInfo remapped = info;
+                remapped.fBuffer = remap.fTo;
+                remapped.fOffset = info.fOffset - remap.fOffset;
+                return remapped;
+            }
+        }
+        return info;
+    }
+
     SkISize fRenderPassSize;
     SkIVector fReplayTranslation;
+    SkSpan<const UniformBufferRemap> fUniformBufferRemaps;
 
 private:
     // Release all tracked Resources
@@ -124,6 +161,12 @@ private:
 
     virtual void onResetCommandBuffer() = 0;
 
+    // Returns false if the GPU time of the command buffer can't be measured. Otherwise the time
+    // from now until the command buffer is submitted is returned by gpuTimerResultNs() once the
+    // command buffer has finished.
+    virtual bool onStartGpuTimer() { return false; }
+    virtual uint64_t gpuTimerResultNs() { return 0; }
+
     virtual bool onAddRenderPass(const RenderPassDesc&,
                                  const Texture* colorTexture,
                                  const Texture* resolveTexture,
@@ -165,6 +208,9 @@ private:
     TrackedResourceArray<gr_cb<Resource>> fCommandBufferResources;
     skia_private::TArray<sk_sp<RefCntedCallback>> fFinishedProcs;
     skia_private::TArray<sk_sp<Buffer>> fBuffersToAsyncMap;
+
+    bool fGpuTimerStarted = false;
+    skia_private::TArray<RecordingStats*> fGpuTimedStats;
 };
 
 } // namespace skgpu::graphite
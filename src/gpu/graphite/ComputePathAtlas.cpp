@@ -17,6 +17,7 @@
 #include "src/gpu/graphite/RendererProvider.h"
 #include "src/gpu/graphite/TextureProxy.h"
 #include "src/gpu/graphite/TextureUtils.h"
+#include "src/gpu/graphite/geom/Shape.h"
 #include "src/gpu/graphite/geom/Transform_graphite.h"
 
 #ifdef SK_ENABLE_VELLO_SHADERS
@@ -35,6 +36,23 @@ constexpr uint16_t kComputeAtlasDim = 4096;
 // dispatches to render multiple atlas pages can be prohibitive.
 constexpr size_t kBboxAreaThreshold = 1024 * 512;
 
+// Masks larger than kBboxAreaThreshold are still rendered by the compute atlas if their paths are
+// complex enough for that to pay off, with at least one verb per this many pixels of mask. The
+// tessellating renderers emit geometry for every verb, and their stencil pass covers the path's
+// bounds once per overlapping winding fan, so their cost grows with a path's complexity while
+// vello's grows with its mask's area. Dense fills such as map tiles and vector illustrations are
+// often well past this, while large but simple shapes stay with tessellation, which doesn't use up
+// atlas space and force atlas flushes.
+constexpr float kMaxPixelsPerVerbForLargeMasks = 256.f;
+
+int verb_count(const Shape& shape) {
+    if (shape.isPath()) {
+        return shape.path().countVerbs();
+    }
+    // Lines, rects and round rects have at most a handful of verbs.
+    return shape.isRRect() ? 10 : 5;
+}
+
 // Coordinate size that is too large for vello to handle efficiently. See the discussion on
 // https://github.com/linebender/vello/pull/542.
 constexpr float kCoordinateThreshold = 1e10;
@@ -59,7 +77,8 @@ bool ComputePathAtlas::initializeTextureIfNeeded() {
 }
 
 bool ComputePathAtlas::isSuitableForAtlasing(const Rect& transformedShapeBounds,
-                                             const Rect& clipBounds) const {
+                                             const Rect& clipBounds,
+                                             const Shape& shape) const {
     Rect shapeBounds = transformedShapeBounds.makeRoundOut();
     Rect maskBounds = shapeBounds.makeIntersect(clipBounds);
     skvx::float2 maskSize = maskBounds.size();
@@ -72,7 +91,8 @@ bool ComputePathAtlas::isSuitableForAtlasing(const Rect& transformedShapeBounds,
     // For now we're allowing paths that are smaller than 1/32nd of the full 4096x4096 atlas size
     // to prevent the atlas texture from filling up too often. There are several approaches we
     // should explore to alleviate the cost of atlasing large paths.
-    if (width * height > kBboxAreaThreshold) {
+    if (width * height > kBboxAreaThreshold &&
+        width * height > verb_count(shape) * kMaxPixelsPerVerbForLargeMasks) {
         return false;
     }
 
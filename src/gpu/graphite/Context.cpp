@@ -11,6 +11,7 @@
 #include "include/core/SkPathTypes.h"
 #include "include/core/SkTraceMemoryDump.h"
 #include "include/effects/SkRuntimeEffect.h"
+#include "include/gpu/GpuMemoryReport.h"
 #include "include/gpu/graphite/BackendTexture.h"
 #include "include/gpu/graphite/Recorder.h"
 #include "include/gpu/graphite/Recording.h"
@@ -37,6 +38,8 @@
 #include "src/gpu/graphite/Image_Graphite.h"
 #include "src/gpu/graphite/KeyContext.h"
 #include "src/gpu/graphite/Log.h"
+#include "src/gpu/graphite/PipelineCompiler.h"
+#include "src/gpu/graphite/PipelineUsageLog.h"
 #include "src/gpu/graphite/QueueManager.h"
 #include "src/gpu/graphite/RecorderPriv.h"
 #include "src/gpu/graphite/RecordingPriv.h"
@@ -46,12 +49,14 @@
 #include "src/gpu/graphite/RuntimeEffectDictionary.h"
 #include "src/gpu/graphite/ShaderCodeDictionary.h"
 #include "src/gpu/graphite/SharedContext.h"
+#include "src/gpu/graphite/SharedImageCache.h"
 #include "src/gpu/graphite/Surface_Graphite.h"
 #include "src/gpu/graphite/TextureProxyView.h"
 #include "src/gpu/graphite/TextureUtils.h"
 #include "src/gpu/graphite/task/CopyTask.h"
 #include "src/gpu/graphite/task/SynchronizeToCpuTask.h"
 #include "src/gpu/graphite/task/UploadTask.h"
+#include "src/gpu/graphite/text/TextAtlasManager.h"
 
 #include "src/image/SkSurface_Base.h"
 
@@ -89,6 +94,32 @@ Context::Context(sk_sp<SharedContext> sharedContext,
                                                              SK_InvalidGenID,
                                                              options.fGpuBudgetInBytes);
     fMappedBufferManager = std::make_unique<ClientMappedBufferManager>(this->contextID());
+    if (options.fPipelineCompilationExecutor) {
+        fSharedContext->setPipelineCompiler(std::make_unique<PipelineCompiler>(
+                fSharedContext.get(),
+                options.fPipelineCompilationExecutor,
+                options.fDropDrawsWithPendingPipelines));
+    }
+    if (options.fSubmissionExecutor) {
+        if (fSharedContext->caps()->allowCpuSync()) {
+            fQueueManager->setSubmissionExecutor(options.fSubmissionExecutor);
+        } else {
+            SKGPU_LOG_W("ContextOptions::fSubmissionExecutor is ignored with "
+                        "ContextOptions::fNeverYieldToWebGPU.");
+        }
+    }
+    if (options.fRecordPipelineUsage) {
+        fSharedContext->setPipelineUsageLog(std::make_unique<PipelineUsageLog>());
+    }
+    if (options.fShareGlyphAtlasAcrossRecorders) {
+        fSharedContext->setSharedTextAtlasManager(
+                sk_make_sp<TextAtlasManager>(fSharedContext->caps(), DrawAtlas::Shared::kYes));
+    }
+    if (options.fShareImageUploadsAcrossRecorders) {
+        auto imageCache = std::make_unique<SharedImageCache>(fSharedContext->caps());
+        fResourceProvider->setSharedImageCache(imageCache.get());
+        fSharedContext->setSharedImageCache(std::move(imageCache));
+    }
 #if defined(GRAPHITE_TEST_UTILS)
     if (options.fOptionsPriv) {
         fStoreContextRefInRecorder = options.fOptionsPriv->fStoreContextRefInRecorder;
@@ -97,12 +128,25 @@ Context::Context(sk_sp<SharedContext> sharedContext,
 }
 
 Context::~Context() {
+    // The submission tasks use the backend QueueManager, so they have to finish while it's alive.
+    fQueueManager->finishSubmissionTasks();
 #if defined(GRAPHITE_TEST_UTILS)
     ASSERT_SINGLE_OWNER
     for (auto& recorder : fTrackedRecorders) {
         recorder->priv().setContext(nullptr);
     }
 #endif
+    // The shared glyph atlas pages were instantiated with the Context's ResourceProvider.
+    if (TextAtlasManager* textAtlasManager = fSharedContext->sharedTextAtlasManager()) {
+        textAtlasManager->freeAll();
+        fSharedContext->setSharedTextAtlasManager(nullptr);
+    }
+    // As are the textures of the shared image cache.
+    if (SharedImageCache* imageCache = fSharedContext->sharedImageCache()) {
+        imageCache->freeAll();
+        fResourceProvider->setSharedImageCache(nullptr);
+        fSharedContext->setSharedImageCache(nullptr);
+    }
 }
 
 bool Context::finishInitialization() {
@@ -156,6 +200,31 @@ std::unique_ptr<Recorder> Context::makeInternalRecorder() const {
 bool Context::insertRecording(const InsertRecordingInfo& info) {
     ASSERT_SINGLE_OWNER
 
+    // Recorders that share a glyph atlas or image cache leave uploading to them to the Context.
+    // Uploading all the glyphs placed and images added so far ahead of each Recording means that
+    // every Recording finds those from before it was snapped, whatever order Recordings are
+    // inserted in.
+    TextAtlasManager* textAtlasManager = fSharedContext->sharedTextAtlasManager();
+    SharedImageCache* imageCache = fSharedContext->sharedImageCache();
+    const bool glyphUploads = textAtlasManager && textAtlasManager->hasPendingUploads();
+    const bool imageUploads = imageCache && imageCache->hasPendingUploads();
+    if (glyphUploads || imageUploads) {
+        std::unique_ptr<Recorder> recorder = this->makeInternalRecorder();
+        if (glyphUploads && !textAtlasManager->recordPendingUploads(recorder.get())) {
+            SKGPU_LOG_E("Shared glyph atlas uploads have failed -- may see invalid results.");
+        }
+        if (imageUploads && !imageCache->recordPendingUploads(recorder.get())) {
+            SKGPU_LOG_E("Shared image uploads have failed -- may see invalid results.");
+        }
+        // Whatever uploads were recorded are still inserted.
+        std::unique_ptr<Recording> uploads = recorder->snap();
+        InsertRecordingInfo uploadInfo;
+        uploadInfo.fRecording = uploads.get();
+        if (!uploads || !fQueueManager->addRecording(uploadInfo, this)) {
+            SKGPU_LOG_E("Shared uploads have failed -- may see invalid results.");
+        }
+    }
+
     return fQueueManager->addRecording(info, this);
 }
 
@@ -764,6 +833,25 @@ void Context::freeGpuResources() {
     fResourceProvider->freeGpuResources();
 }
 
+void Context::syncPipelineData(size_t maxSize) {
+    ASSERT_SINGLE_OWNER
+
+    fSharedContext->syncPipelineData(maxSize);
+}
+
+sk_sp<SkData> Context::serializePipelineUsage() const {
+    ASSERT_SINGLE_OWNER
+
+    PipelineUsageLog* log = fSharedContext->pipelineUsageLog();
+    return log ? log->serialize(fSharedContext.get()) : nullptr;
+}
+
+int Context::precompilePipelines(const SkData& data) {
+    ASSERT_SINGLE_OWNER
+
+    return PipelineUsageLog::Precompile(this, data);
+}
+
 void Context::performDeferredCleanup(std::chrono::milliseconds msNotUsed) {
     ASSERT_SINGLE_OWNER
 
@@ -788,6 +876,16 @@ void Context::dumpMemoryStatistics(SkTraceMemoryDump* traceMemoryDump) const {
     fResourceProvider->dumpMemoryStatistics(traceMemoryDump);
     // TODO: What is the graphite equivalent for the text blob cache and how do we print out its
     // used bytes here (see Ganesh implementation).
+
+    skgpu::GpuMemoryReport report;
+    this->getMemoryReport(&report);
+    report.dumpMemoryStatistics(traceMemoryDump, "skia/gpu_memory_report/context");
+}
+
+void Context::getMemoryReport(skgpu::GpuMemoryReport* report) const {
+    ASSERT_SINGLE_OWNER
+    *report = {};
+    fResourceProvider->addToMemoryReport(report);
 }
 
 bool Context::isDeviceLost() const {
@@ -20,6 +20,7 @@ namespace skgpu::graphite {
 
 class Caps;
 class GlobalCache;
+class PipelineCompiler;
 class RendererProvider;
 class ResourceProvider;
 class ShaderCodeDictionary;
@@ -46,6 +47,9 @@ public:
     const RendererProvider* rendererProvider() const {
         return fContext->fSharedContext->rendererProvider();
     }
+    PipelineCompiler* pipelineCompiler() const {
+        return fContext->fSharedContext->pipelineCompiler();
+    }
     ResourceProvider* resourceProvider() const {
         return fContext->fResourceProvider.get();
     }
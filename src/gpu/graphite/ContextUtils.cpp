@@ -14,6 +14,7 @@
 #include "src/gpu/graphite/GraphicsPipelineDesc.h"
 #include "src/gpu/graphite/KeyContext.h"
 #include "src/gpu/graphite/PaintParams.h"
+#include "src/gpu/graphite/PatchableUniforms.h"
 #include "src/gpu/graphite/PipelineData.h"
 #include "src/gpu/graphite/RecorderPriv.h"
 #include "src/gpu/graphite/RenderPassDesc.h"
@@ -62,6 +63,9 @@ std::tuple<UniquePaintParamsID, const UniformDataBlock*, const TextureDataBlock*
         if (gatherer->hasUniforms()) {
             UniformDataCache* uniformDataCache = recorder->priv().uniformDataCache();
             uniforms = uniformDataCache->insert(gatherer->finishUniformDataBlock());
+            if (PatchableUniformTracker* tracker = recorder->priv().patchableUniformTracker()) {
+                tracker->addBlock(uniforms, gatherer->patchableUniforms());
+            }
         }
         if (gatherer->hasTextures()) {
             TextureDataCache* textureDataCache = recorder->priv().textureDataCache();
@@ -52,6 +52,7 @@
 #include "src/core/SkBlurMaskFilterImpl.h"
 #include "src/core/SkColorSpacePriv.h"
 #include "src/core/SkConvertPixels.h"
+#include "src/core/SkDrawStatsSink.h"
 #include "src/core/SkImageFilterTypes.h"
 #include "src/core/SkImageInfoPriv.h"
 #include "src/core/SkImagePriv.h"
@@ -694,7 +695,8 @@ bool Device::drawAsTiledImageRect(SkCanvas* canvas,
                                   const SkRect& dst,
                                   const SkSamplingOptions& sampling,
                                   const SkPaint& paint,
-                                  SkCanvas::SrcRectConstraint constraint) {
+                                  SkCanvas::SrcRectConstraint constraint,
+                                  SkTiledImageUtils::TileStreamer* streamer) {
     auto recorder = canvas->recorder();
     if (!recorder) {
         return false;
@@ -725,7 +727,8 @@ bool Device::drawAsTiledImageRect(SkCanvas* canvas,
                                                            &paint,
                                                            constraint,
                                                            cacheSize,
-                                                           maxTextureSize);
+                                                           maxTextureSize,
+                                                           streamer);
 #if defined(GRAPHITE_TEST_UTILS)
     gNumTilesDrawnGraphite.store(numTiles, std::memory_order_relaxed);
 #endif
@@ -1072,6 +1075,20 @@ void Device::drawGeometry(const Transform& localToDevice,
         SKGPU_LOG_W("Skipping draw with no supported renderer or PathAtlas.");
         return;
     }
+    if (pathAtlas) {
+        // The compute atlas was already made if chooseRenderer() picked it.
+        const bool isComputeAtlas =
+                fRecorder->priv().atlasProvider()->isAvailable(
+                        AtlasProvider::PathAtlasFlags::kCompute) &&
+                pathAtlas == fDC->getComputePathAtlas(fRecorder);
+        ++(isComputeAtlas ? fPathRendererStats.fComputeDraws : fPathRendererStats.fRasterDraws);
+        SkDrawStatsSink::NoteRenderer(isComputeAtlas ? "ComputePathAtlas" : "RasterPathAtlas");
+    } else {
+        if (geometry.isShape() && renderer->requiresMSAA()) {
+            ++fPathRendererStats.fTessellatedDraws;
+        }
+        SkDrawStatsSink::NoteRenderer(renderer->name());
+    }
 
     // Calculate the clipped bounds of the draw and determine the clip elements that affect the
     // draw without updating the clip stack.
@@ -1242,12 +1259,27 @@ void Device::drawGeometry(const Transform& localToDevice,
         }
     }
 
-    // TODO: If 'fullyOpaque' is true, it might be useful to store the draw bounds and Z in a
-    // special occluders list for filtering the DrawList/DrawPass when flushing.
-    // const bool fullyOpaque = !dependsOnDst &&
-    //                          clipOrder == DrawOrder::kNoIntersection &&
-    //                          shape.isRect() &&
-    //                          localToDevice.type() <= Transform::Type::kRectStaysRect;
+    // An opaque, unclipped rect fill hides the earlier draws within it, which the DrawList then
+    // skips entirely when it's flushed. Pixels wholly inside the rect are fully covered even when
+    // the renderer antialiases its edges.
+    const bool fullyOpaque = !paint_depends_on_dst(shading) &&
+                             !paint.getMaskFilter() &&
+                             !clip.shader() &&
+                             rendererCoverage != Coverage::kLCD &&
+                             clipOrder == DrawOrder::kNoIntersection &&
+                             styleType == SkStrokeRec::kFill_Style &&
+                             !pathAtlas &&
+                             geometry.isShape() &&
+                             geometry.shape().isRect() &&
+                             !geometry.shape().inverted() &&
+                             localToDevice.type() <= Transform::Type::kRectStaysRect;
+    if (fullyOpaque) {
+        Rect occluder = localToDevice.mapRect(geometry.shape().rect()).makeRoundIn()
+                                     .makeIntersect(Rect(SkRect::Make(clip.scissor())));
+        if (!occluder.isEmptyNegativeOrNaN()) {
+            fDC->recordOccluder(occluder, order.depth());
+        }
+    }
 
     // Post-draw book keeping (bounds manager, depth tracking, etc.)
     fColorDepthBoundsManager->recordDraw(clip.drawBounds(), order.paintOrder());
@@ -1273,7 +1305,9 @@ void Device::drawClipShape(const Transform& localToDevice,
     if (!renderer) {
         SKGPU_LOG_W("Skipping clip with no supported path renderer.");
         return;
-    } else if (renderer->depthStencilFlags() & DepthStencilFlags::kStencil) {
+    }
+    SkDrawStatsSink::NoteRenderer(renderer->name());
+    if (renderer->depthStencilFlags() & DepthStencilFlags::kStencil) {
         DisjointStencilIndex setIndex = fDisjointStencilSet->add(order.paintOrder(),
                                                                  clip.drawBounds());
         order.dependsOnStencil(setIndex);
@@ -1352,7 +1386,7 @@ std::pair<const Renderer*, PathAtlas*> Device::chooseRenderer(const Transform& l
     // II: otherwise:
     //    1. Always use compute AA if supported unless it was excluded by ContextOptions or the
     //       compute renderer cannot render the shape efficiently yet (based on the result of
-    //       `isSuitableForAtlasing`).
+    //       `isSuitableForAtlasing`, which weighs the shape's verb count against its mask size).
     //    2. Fall back to CPU raster AA if hardware MSAA is disabled or it was explicitly requested
     //       via ContextOptions.
     //    3. Otherwise use tessellation.
@@ -1380,7 +1414,7 @@ std::pair<const Renderer*, PathAtlas*> Device::chooseRenderer(const Transform& l
         // having to evaluate the entire clip stack before choosing the renderer as it will have to
         // get evaluated again if we fall back to a different renderer).
         drawBounds = localToDevice.mapRect(shape.bounds());
-        if (atlas->isSuitableForAtlasing(*drawBounds, fClip.conservativeBounds())) {
+        if (atlas->isSuitableForAtlasing(*drawBounds, fClip.conservativeBounds(), shape)) {
             pathAtlas = atlas;
         }
     }
@@ -1534,6 +1568,14 @@ void Device::internalFlush() {
     fDC->flush(fRecorder);
 
     fColorDepthBoundsManager->reset();
+    TRACE_COUNTER1("skia.gpu", "# bounds manager draws",
+                   fColorDepthBoundsManager->lastFrameStats().fDrawCount);
+    TRACE_COUNTER1("skia.gpu", "bounds manager grid cell size",
+                   fColorDepthBoundsManager->lastFrameStats().fGridCellSize);
+    TRACE_COUNTER1("skia.gpu", "# compute atlas path draws", fPathRendererStats.fComputeDraws);
+    TRACE_COUNTER1("skia.gpu", "# raster atlas path draws", fPathRendererStats.fRasterDraws);
+    TRACE_COUNTER1("skia.gpu", "# tessellated path draws", fPathRendererStats.fTessellatedDraws);
+    fPathRendererStats = {};
     fDisjointStencilSet->reset();
     fCurrentDepth = DrawOrder::kClearDepth;
 
@@ -1680,6 +1722,10 @@ sk_sp<skif::Backend> Device::createImageFilteringBackend(const SkSurfaceProps& s
 
 TextureProxy* Device::target() { return fDC->target(); }
 
+#if defined(GRAPHITE_TEST_UTILS)
+int Device::numPendingOccludedDraws() const { return fDC->numPendingOccludedDraws(); }
+#endif
+
 TextureProxyView Device::readSurfaceView() const { return fDC->readSurfaceView(); }
 
 bool Device::isScratchDevice() const {
@@ -25,7 +25,7 @@ class SkStrokeRec;
 namespace skgpu::graphite {
 
 class PathAtlas;
-class BoundsManager;
+class HybridBoundsManager;
 class Clip;
 class Context;
 class DrawContext;
@@ -86,6 +86,10 @@ public:
     SkStrikeDeviceInfo strikeDeviceInfo() const override;
 
     TextureProxy* target();
+#if defined(GRAPHITE_TEST_UTILS)
+    // The number of draws recorded since the last flush that will be skipped as occluded.
+    int numPendingOccludedDraws() const;
+#endif
     // May be null if target is not sampleable.
     TextureProxyView readSurfaceView() const;
     // Can succeed if target is readable but not sampleable. Assumes 'subset' is contained in bounds
@@ -172,7 +176,8 @@ public:
                               const SkRect& dst,
                               const SkSamplingOptions&,
                               const SkPaint&,
-                              SkCanvas::SrcRectConstraint) override;
+                              SkCanvas::SrcRectConstraint,
+                              SkTiledImageUtils::TileStreamer*) override;
     // TODO: Implement these using per-edge AA quads and an inlined image shader program.
     void drawImageLattice(const SkImage*, const SkCanvas::Lattice&,
                           const SkRect& dst, SkFilterMode, const SkPaint&) override {}
@@ -298,7 +303,7 @@ private:
 
     // Tracks accumulated intersections for ordering dependent use of the color and depth attachment
     // (i.e. depth-based clipping, and transparent blending)
-    std::unique_ptr<BoundsManager> fColorDepthBoundsManager;
+    std::unique_ptr<HybridBoundsManager> fColorDepthBoundsManager;
     // Tracks disjoint stencil indices for all recordered draws
     std::unique_ptr<IntersectionTreeSet> fDisjointStencilSet;
 
@@ -311,6 +316,15 @@ private:
     // The DrawContext's target supports MSAA
     bool fMSAASupported = false;
 
+    // The number of path draws that went to each kind of path renderer since the last flush,
+    // reported as trace counters when the Device flushes.
+    struct PathRendererStats {
+        int fComputeDraws = 0;
+        int fRasterDraws = 0;
+        int fTessellatedDraws = 0;
+    };
+    PathRendererStats fPathRendererStats;
+
     // TODO(b/330864257): Clean up once flushPendingWorkToRecorder() doesn't have to be re-entrant
     bool fIsFlushing = false;
 
@@ -11,6 +11,7 @@
 
 #include "include/core/SkColorSpace.h"
 #include "include/core/SkStream.h"
+#include "include/gpu/GpuMemoryReport.h"
 #include "include/gpu/graphite/Recorder.h"
 #include "include/private/SkColorData.h"
 #include "include/private/base/SkTPin.h"
@@ -23,7 +24,10 @@
 #include "src/gpu/graphite/ContextPriv.h"
 #include "src/gpu/graphite/DrawContext.h"
 #include "src/gpu/graphite/RecorderPriv.h"
+#include "src/gpu/graphite/ResourceProvider.h"
+#include "src/gpu/graphite/Texture.h"
 #include "src/gpu/graphite/TextureProxy.h"
+#include "src/gpu/graphite/task/UploadTask.h"
 
 using namespace skia_private;
 
@@ -54,11 +58,13 @@ std::unique_ptr<DrawAtlas> DrawAtlas::Make(SkColorType colorType, size_t bpp, in
                                            AtlasGenerationCounter* generationCounter,
                                            AllowMultitexturing allowMultitexturing,
                                            UseStorageTextures useStorageTextures,
+                                           Shared shared,
                                            PlotEvictionCallback* evictor,
                                            std::string_view label) {
     std::unique_ptr<DrawAtlas> atlas(new DrawAtlas(colorType, bpp, width, height,
                                                    plotWidth, plotHeight, generationCounter,
-                                                   allowMultitexturing, useStorageTextures, label));
+                                                   allowMultitexturing, useStorageTextures, shared,
+                                                   label));
 
     if (evictor != nullptr) {
         atlas->fEvictionCallbacks.emplace_back(evictor);
@@ -79,6 +85,7 @@ DrawAtlas::DrawAtlas(SkColorType colorType, size_t bpp, int width, int height,
                      int plotWidth, int plotHeight, AtlasGenerationCounter* generationCounter,
                      AllowMultitexturing allowMultitexturing,
                      UseStorageTextures useStorageTextures,
+                     Shared shared,
                      std::string_view label)
         : fColorType(colorType)
         , fBytesPerPixel(bpp)
@@ -87,6 +94,7 @@ DrawAtlas::DrawAtlas(SkColorType colorType, size_t bpp, int width, int height,
         , fPlotWidth(plotWidth)
         , fPlotHeight(plotHeight)
         , fUseStorageTextures(useStorageTextures)
+        , fShared(shared)
         , fLabel(label)
         , fAtlasID(next_id())
         , fGenerationCounter(generationCounter)
@@ -145,7 +153,8 @@ bool DrawAtlas::addRectToPage(unsigned int pageIdx, int width, int height,
     return false;
 }
 
-bool DrawAtlas::recordUploads(DrawContext* dc, Recorder* recorder) {
+template <typename RecordUploadFn>
+bool DrawAtlas::recordPlotUploads(RecordUploadFn&& recordUpload) {
     TRACE_EVENT0("skia.gpu", TRACE_FUNC);
     for (uint32_t pageIdx = 0; pageIdx < fNumActivePages; ++pageIdx) {
         PlotList::Iter plotIter;
@@ -167,8 +176,7 @@ bool DrawAtlas::recordUploads(DrawContext* dc, Recorder* recorder) {
 
                 // Src and dst colorInfo are the same
                 SkColorInfo colorInfo(fColorType, kUnknown_SkAlphaType, nullptr);
-                if (!dc->recordUpload(recorder, sk_ref_sp(proxy), colorInfo, colorInfo, levels,
-                                      dstRect, /*ConditionalUploadContext=*/nullptr)) {
+                if (!recordUpload(sk_ref_sp(proxy), colorInfo, levels, dstRect)) {
                     return false;
                 }
             }
@@ -177,6 +185,44 @@ bool DrawAtlas::recordUploads(DrawContext* dc, Recorder* recorder) {
     return true;
 }
 
+bool DrawAtlas::recordUploads(DrawContext* dc, Recorder* recorder) {
+    return this->recordPlotUploads([&](sk_sp<TextureProxy> proxy,
+                                       const SkColorInfo& colorInfo,
+                                       const std::vector<MipLevel>& levels,
+                                       const SkIRect& dstRect) {
+        return dc->recordUpload(recorder, std::move(proxy), colorInfo, colorInfo, levels, dstRect,
+                                /*ConditionalUploadContext=*/nullptr);
+    });
+}
+
+bool DrawAtlas::recordUploads(UploadList* uploads, Recorder* recorder) {
+    return this->recordPlotUploads([&](sk_sp<TextureProxy> proxy,
+                                       const SkColorInfo& colorInfo,
+                                       const std::vector<MipLevel>& levels,
+                                       const SkIRect& dstRect) {
+        // The pages of a shared atlas are left for the Context to instantiate, which it does
+        // before recording uploads to them.
+        if (proxy->isLazy() && !proxy->lazyInstantiate(recorder->priv().resourceProvider())) {
+            return false;
+        }
+        return uploads->recordUpload(recorder, std::move(proxy), colorInfo, colorInfo, levels,
+                                     dstRect, /*ConditionalUploadContext=*/nullptr);
+    });
+}
+
+bool DrawAtlas::hasPendingUploads() {
+    for (uint32_t pageIdx = 0; pageIdx < fNumActivePages; ++pageIdx) {
+        PlotList::Iter plotIter;
+        plotIter.init(fPages[pageIdx].fPlotList, PlotList::Iter::kHead_IterStart);
+        for (Plot* plot = plotIter.get(); plot; plot = plotIter.next()) {
+            if (plot->needsUpload()) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
 // Number of atlas-related flushes beyond which we consider a plot to no longer be in use.
 //
 // This value is somewhat arbitrary -- the idea is to keep it low enough that
@@ -226,7 +272,10 @@ DrawAtlas::ErrorCode DrawAtlas::addRect(Recorder* recorder,
         for (unsigned int pageIdx = 0; pageIdx < fNumActivePages; ++pageIdx) {
             Plot* plot = fPages[pageIdx].fPlotList.tail();
             SkASSERT(plot);
-            if (plot->lastUseToken() < recorder->priv().tokenTracker()->nextFlushToken()) {
+            const bool inUse = fShared == Shared::kYes
+                    ? this->isPinned(plot)
+                    : plot->lastUseToken() >= recorder->priv().tokenTracker()->nextFlushToken();
+            if (!inUse) {
                 this->processEvictionAndResetRects(plot);
                 SkDEBUGCODE(bool verify = )plot->addRect(width, height, atlasLocator);
                 SkASSERT(verify);
@@ -256,7 +305,8 @@ DrawAtlas::ErrorCode DrawAtlas::addRect(Recorder* recorder,
     // All plots are currently in use by the current set of draws, so we need to fail. This
     // gives the Device a chance to snap the current set of uploads and draws, advance the draw
     // token, and call back into this function. The subsequent call will have plots available
-    // for fresh uploads.
+    // for fresh uploads. The plots of a shared atlas stay pinned until the GPU is done with the
+    // Recordings that read them, so a retry only finds room once some of those have finished.
     return ErrorCode::kTryAgain;
 }
 
@@ -336,7 +386,8 @@ void DrawAtlas::compact(AtlasToken startTokenForNextFlush) {
 
                 // Count plots we can potentially upload to in all pages except the last one
                 // (the potential compactee).
-                if (plot->flushesSinceLastUsed() > kPlotRecentlyUsedCount) {
+                if (plot->flushesSinceLastUsed() > kPlotRecentlyUsedCount &&
+                    !this->isPinned(plot)) {
                     availablePlots.push_back() = plot;
                 }
 
@@ -366,8 +417,8 @@ void DrawAtlas::compact(AtlasToken startTokenForNextFlush) {
                 SkDebugf("%d ", plot->flushesSinceLastUsed());
             }
 
-            // If this plot was used recently
-            if (plot->flushesSinceLastUsed() <= kPlotRecentlyUsedCount) {
+            // If this plot was used recently, or is still read by a pending Recording
+            if (plot->flushesSinceLastUsed() <= kPlotRecentlyUsedCount || this->isPinned(plot)) {
                 usedPlots++;
             } else if (plot->lastUseToken() != AtlasToken::InvalidToken()) {
                 // otherwise if aged out just evict it.
@@ -388,7 +439,8 @@ void DrawAtlas::compact(AtlasToken startTokenForNextFlush) {
             plotIter.init(fPages[lastPageIndex].fPlotList, PlotList::Iter::kHead_IterStart);
             while (Plot* plot = plotIter.get()) {
                 // If this plot was used recently
-                if (plot->flushesSinceLastUsed() <= kPlotRecentlyUsedCount) {
+                if (plot->flushesSinceLastUsed() <= kPlotRecentlyUsedCount &&
+                    !this->isPinned(plot)) {
                     // See if there's room in an lower index page and if so evict.
                     // We need to be somewhat harsh here so that a handful of plots that are
                     // consistently in use don't end up locking the page in memory.
@@ -462,12 +514,24 @@ bool DrawAtlas::activateNewPage(Recorder* recorder) {
                                                                     Mipmapped::kNo,
                                                                     recorder->priv().isProtected(),
                                                                     Renderable::kNo);
-    fProxies[fNumActivePages] = TextureProxy::Make(caps,
-                                                   recorder->priv().resourceProvider(),
-                                                   {fTextureWidth, fTextureHeight},
-                                                   textureInfo,
-                                                   fLabel,
-                                                   skgpu::Budgeted::kYes);
+    if (fShared == Shared::kYes) {
+        // Any number of Recorders may use the page, so rather than have whichever snaps first
+        // instantiate it, the Context does when inserting the first Recording that uses it.
+        const SkISize dimensions = {fTextureWidth, fTextureHeight};
+        fProxies[fNumActivePages] = TextureProxy::MakeLazy(
+                caps, dimensions, textureInfo, skgpu::Budgeted::kYes, Volatile::kNo,
+                [dimensions, textureInfo, label = fLabel](ResourceProvider* resourceProvider) {
+                    return resourceProvider->findOrCreateScratchTexture(
+                            dimensions, textureInfo, label, skgpu::Budgeted::kYes);
+                });
+    } else {
+        fProxies[fNumActivePages] = TextureProxy::Make(caps,
+                                                       recorder->priv().resourceProvider(),
+                                                       {fTextureWidth, fTextureHeight},
+                                                       textureInfo,
+                                                       fLabel,
+                                                       skgpu::Budgeted::kYes);
+    }
     if (!fProxies[fNumActivePages]) {
         return false;
     }
@@ -530,6 +594,25 @@ void DrawAtlas::evictAllPlots() {
     }
 }
 
+void DrawAtlas::addToMemoryReport(const char* name, GpuMemoryReport* report) const {
+    GpuMemoryReport::Atlas& atlas = report->fAtlases.emplace_back();
+    atlas.fName = name;
+    atlas.fActivePages = fNumActivePages;
+    atlas.fMaxPages = fMaxPages;
+    atlas.fBytes = fNumActivePages * fTextureWidth * fTextureHeight * fBytesPerPixel;
+    atlas.fPlotsPerPage = fNumPlots;
+    // The plots are all the same size, so their mean fullness is the pages' occupancy.
+    float fullness = 0;
+    for (uint32_t pageIndex = 0; pageIndex < fNumActivePages; ++pageIndex) {
+        for (uint32_t plotIndex = 0; plotIndex < fNumPlots; ++plotIndex) {
+            const float plotFullness = fPages[pageIndex].fPlotArray[plotIndex]->percentFull();
+            atlas.fPlotsInUse += plotFullness > 0;
+            fullness += plotFullness;
+        }
+    }
+    atlas.fOccupancy = fNumActivePages ? fullness / (fNumActivePages * fNumPlots) : 0;
+}
+
 DrawAtlasConfig::DrawAtlasConfig(int maxTextureSize, size_t maxBytes) {
     static const SkISize kARGBDimensions[] = {
         {256, 256},   // maxBytes < 2^19
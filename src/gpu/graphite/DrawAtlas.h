@@ -19,11 +19,14 @@
 
 class SkAutoPixmapStorage;
 
+namespace skgpu { struct GpuMemoryReport; }
+
 namespace skgpu::graphite {
 
 class DrawContext;
 class Recorder;
 class TextureProxy;
+class UploadList;
 
 /**
  * TODO: the process described here is tentative, and this comment revised once locked down.
@@ -49,6 +52,11 @@ class TextureProxy;
  * gradually migrate to other pages via the usual upload system.
  *
  * Garbage collection is initiated by the DrawAtlas's client via the compact() method.
+ *
+ * A DrawAtlas shared by several Recorders cannot use AtlasTokens to tell whether a plot is still
+ * read by draws, since each Recorder has its own tokens and its Recordings may be inserted at any
+ * time. Instead its client pins the plots that the draws of a Recording read until the GPU is done
+ * with them; pinned plots are never evicted, and their pages are never deactivated.
  */
 class DrawAtlas {
 public:
@@ -58,6 +66,13 @@ public:
     /** Should the atlas use storage textures? */
     enum class UseStorageTextures : bool { kNo, kYes };
 
+    /**
+     * Is the atlas shared by Recorders? The pages of a shared atlas are lazy proxies, instantiated
+     * by the Context when a Recording that uses them is inserted, and plots are evicted only when
+     * they are not pinned.
+     */
+    enum class Shared : bool { kNo, kYes };
+
     /**
      * Returns a DrawAtlas.
      *  @param ct                  The colorType which this atlas will store.
@@ -69,6 +84,7 @@ public:
      *  @param atlasGeneration     A pointer to the context's generation counter.
      *  @param allowMultitexturing Can the atlas use more than one texture.
      *  @param useStorageTextures  Should the atlas use storage textures.
+     *  @param shared              Is the atlas shared by Recorders.
      *  @param evictor             A pointer to an eviction callback class.
      *  @param label               Label for texture resources.
      *
@@ -80,6 +96,7 @@ public:
                                            AtlasGenerationCounter* generationCounter,
                                            AllowMultitexturing allowMultitexturing,
                                            UseStorageTextures useStorageTextures,
+                                           Shared shared,
                                            PlotEvictionCallback* evictor,
                                            std::string_view label);
 
@@ -116,6 +133,8 @@ public:
     // Return relative location within the Plot, as indicated by the AtlasLocator.
     SkIPoint prepForRender(const AtlasLocator&, SkAutoPixmapStorage*);
     bool recordUploads(DrawContext*, Recorder*);
+    bool recordUploads(UploadList*, Recorder*);
+    bool hasPendingUploads();
 
     const sk_sp<TextureProxy>* getProxies() const { return fProxies; }
 
@@ -159,6 +178,17 @@ public:
 
     void compact(AtlasToken startTokenForNextFlush);
 
+    // Pins are only used by shared atlases, whose clients pin each plot a Recording reads for as
+    // long as the Recording may still be executed.
+    void pinPlot(uint32_t pageIdx, uint32_t plotIdx) {
+        SkASSERT(fShared == Shared::kYes);
+        ++fPinCounts[pageIdx][plotIdx];
+    }
+    void unpinPlot(uint32_t pageIdx, uint32_t plotIdx) {
+        SkASSERT(fPinCounts[pageIdx][plotIdx] > 0);
+        --fPinCounts[pageIdx][plotIdx];
+    }
+
     // Mark all plots with any content as full. Used only with Vello because it can't do
     // new renders to a texture without a clear.
     void markUsedPlotsAsFull();
@@ -169,6 +199,9 @@ public:
         return fMaxPages;
     }
 
+    /** Adds the atlas's page count and occupancy to 'report', as the atlas called 'name'. */
+    void addToMemoryReport(const char* name, GpuMemoryReport* report) const;
+
     int numAllocated_TestingOnly() const;
     void setMaxPages_TestingOnly(uint32_t maxPages);
 
@@ -178,10 +211,14 @@ private:
               AtlasGenerationCounter* generationCounter,
               AllowMultitexturing allowMultitexturing,
               UseStorageTextures useStorageTextures,
+              Shared shared,
               std::string_view label);
 
     bool addRectToPage(unsigned int pageIdx, int width, int height, AtlasLocator*);
 
+    template <typename RecordUploadFn>
+    bool recordPlotUploads(RecordUploadFn&&);
+
     void updatePlot(Plot* plot, AtlasLocator*);
 
     inline void makeMRU(Plot* plot, int pageIdx) {
@@ -203,6 +240,10 @@ private:
         return fPages[pageIdx].fPlotArray[plotIdx].get();
     }
 
+    bool isPinned(const Plot* plot) const {
+        return fPinCounts[plot->pageIndex()][plot->plotIndex()] > 0;
+    }
+
     void internalSetLastUseToken(Plot* plot, uint32_t pageIdx, AtlasToken token) {
         this->makeMRU(plot, pageIdx);
         plot->setLastUseToken(token);
@@ -226,6 +267,7 @@ private:
     int                   fPlotHeight;
     unsigned int          fNumPlots;
     UseStorageTextures    fUseStorageTextures;
+    Shared                fShared;
     const std::string     fLabel;
     uint32_t              fAtlasID;   // unique identifier for this atlas
 
@@ -260,6 +302,8 @@ private:
 
     uint32_t fNumActivePages;
 
+    int fPinCounts[PlotLocator::kMaxMultitexturePages][PlotLocator::kMaxPlots] = {};
+
     SkDEBUGCODE(void validate(const AtlasLocator& atlasLocator) const;)
 };
 
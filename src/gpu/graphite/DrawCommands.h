@@ -203,6 +203,42 @@ public:
     using Iter = SkTBlockList<Command, 16>::CIter;
     Iter commands() const { return fCommands.items(); }
 
+    // Removes every BindGraphicsPipeline command whose pipeline index 'isDropped' returns true
+    // for, along with the draws that use that pipeline. All other state changes are kept, so the
+    // state seen by the remaining draws is unchanged.
+    template <typename Fn>
+    void removeDrawsForPipelines(Fn&& isDropped) {
+        SkTBlockList<Command, 16> kept{SkBlockAllocator::GrowthPolicy::kFibonacci};
+        bool dropping = false;
+        for (const Command& cmd : fCommands.items()) {
+            switch (cmd.first) {
+                case Type::kBindGraphicsPipeline:
+                    dropping = isDropped(static_cast<BindGraphicsPipeline*>(cmd.second)
+                                                 ->fPipelineIndex);
+                    if (dropping) {
+                        continue;
+                    }
+                    break;
+                case Type::kDraw:
+                case Type::kDrawIndexed:
+                case Type::kDrawInstanced:
+                case Type::kDrawIndexedInstanced:
+                case Type::kDrawIndirect:
+                case Type::kDrawIndexedIndirect:
+                    if (dropping) {
+                        continue;
+                    }
+                    break;
+                default:
+                    break;
+            }
+            kept.push_back(cmd);
+        }
+        // The commands' payloads live in fAlloc, so only the list of commands changes.
+        fCommands.reset();
+        fCommands.concat(std::move(kept));
+    }
+
 private:
     template <typename T, typename... Args>
     void add(Args&&... args) {
@@ -158,6 +158,10 @@ void DrawContext::recordDraw(const Renderer* renderer,
     fPendingDraws->recordDraw(renderer, localToDevice, geometry, clip, ordering, paint, stroke);
 }
 
+void DrawContext::recordOccluder(const Rect& bounds, PaintersDepth depth) {
+    fPendingDraws->recordOccluder(bounds, depth);
+}
+
 bool DrawContext::recordUpload(Recorder* recorder,
                                sk_sp<TextureProxy> targetProxy,
                                const SkColorInfo& srcColorInfo,
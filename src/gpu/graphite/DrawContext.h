@@ -64,6 +64,10 @@ public:
 
     int pendingRenderSteps() const { return fPendingDraws->renderStepCount(); }
 
+#if defined(GRAPHITE_TEST_UTILS)
+    int numPendingOccludedDraws() const { return fPendingDraws->numOccludedDraws(); }
+#endif
+
     void clear(const SkColor4f& clearColor);
     void discard();
 
@@ -75,6 +79,9 @@ public:
                     const PaintParams* paint,
                     const StrokeStyle* stroke);
 
+    // See DrawList::recordOccluder().
+    void recordOccluder(const Rect& bounds, PaintersDepth depth);
+
     bool recordUpload(Recorder* recorder,
                       sk_sp<TextureProxy> targetProxy,
                       const SkColorInfo& srcColorInfo,
@@ -51,4 +51,55 @@ void DrawList::recordDraw(const Renderer* renderer,
     }
 }
 
+void DrawList::recordOccluder(const Rect& bounds, PaintersDepth depth) {
+    SkASSERT(bounds == bounds.makeRoundIn());
+    SkASSERT(!fDraws.empty() && fDraws.back().fDrawParams.order().depth() == depth);
+    const float area = bounds.area();
+    if (!(area >= kMinOccluderArea)) {
+        return;
+    }
+
+    // Depths increase as draws are recorded, so the new occluder hides everything the ones it
+    // contains hide.
+    int smallest = -1;
+    for (int i = fOccluders.size() - 1; i >= 0; --i) {
+        SkASSERT(fOccluders[i].fDepth < depth);
+        if (bounds.contains(fOccluders[i].fBounds)) {
+            fOccluders.removeShuffle(i);
+        } else if (smallest < 0 ||
+                   fOccluders[i].fBounds.area() < fOccluders[smallest].fBounds.area()) {
+            smallest = i;
+        }
+    }
+    if (fOccluders.size() < kMaxOccluders) {
+        fOccluders.push_back({bounds, depth});
+    } else if (fOccluders[smallest].fBounds.area() < area) {
+        fOccluders[smallest] = {bounds, depth};
+    }
+}
+
+#if defined(GRAPHITE_TEST_UTILS)
+int DrawList::numOccludedDraws() const {
+    int count = 0;
+    for (const Draw& draw : fDraws.items()) {
+        if (draw.fPaintParams.has_value() && this->isOccluded(draw)) {
+            count++;
+        }
+    }
+    return count;
+}
+#endif
+
+bool DrawList::isOccluded(const Draw& draw) const {
+    SkASSERT(draw.fPaintParams.has_value());
+    const Rect& bounds = draw.fDrawParams.clip().drawBounds();
+    const PaintersDepth depth = draw.fDrawParams.order().depth();
+    for (const Occluder& occluder : fOccluders) {
+        if (depth < occluder.fDepth && occluder.fBounds.contains(bounds)) {
+            return true;
+        }
+    }
+    return false;
+}
+
 } // namespace skgpu::graphite
@@ -9,6 +9,7 @@
 #define skgpu_graphite_DrawList_DEFINED
 
 #include "include/core/SkPaint.h"
+#include "include/private/base/SkTArray.h"
 #include "src/base/SkTBlockList.h"
 
 #include "src/gpu/graphite/DrawOrder.h"
@@ -81,8 +82,18 @@ public:
                     const PaintParams* paint,
                     const StrokeStyle* stroke);
 
+    // Records that the pixels of 'bounds', which must be pixel-aligned, are filled with opaque
+    // color by the draw at 'depth', which must have been recorded already. Earlier draws entirely
+    // within one of the largest such rects are skipped when the DrawList is made into a DrawPass.
+    void recordOccluder(const Rect& bounds, PaintersDepth depth);
+
     int renderStepCount() const { return fRenderStepCount; }
 
+#if defined(GRAPHITE_TEST_UTILS)
+    // The number of draws recorded so far that would be skipped as occluded.
+    int numOccludedDraws() const;
+#endif
+
     // Bounds for a dst copy required by this DrawList.
     const Rect& dstCopyBounds() const { return fDstCopyBounds; }
 
@@ -107,6 +118,19 @@ private:
     // The returned Transform reference remains valid for the lifetime of the DrawList.
     const Transform& deduplicateTransform(const Transform&);
 
+    // Whether the draw, which must have shading, is hidden by an opaque draw recorded after it.
+    bool isOccluded(const Draw&) const;
+
+    struct Occluder {
+        Rect          fBounds;
+        PaintersDepth fDepth;
+    };
+    // Only the largest occluders are kept, which is enough for the backgrounds of stacked layers
+    // while keeping the test of each draw cheap.
+    static constexpr int kMaxOccluders = 4;
+    // Occluders smaller than this many pixels aren't worth testing draws against.
+    static constexpr float kMinOccluderArea = 64.f * 64.f;
+
     SkTBlockList<Transform, 16> fTransforms{SkBlockAllocator::GrowthPolicy::kFibonacci};
     SkTBlockList<Draw, 16>      fDraws{SkBlockAllocator::GrowthPolicy::kFibonacci};
 
@@ -119,6 +143,8 @@ private:
 #endif
 
     Rect fDstCopyBounds = Rect::InfiniteInverted();
+
+    skia_private::STArray<kMaxOccluders, Occluder> fOccluders;
 };
 
 } // namespace skgpu::graphite
@@ -7,9 +7,12 @@
 
 #include "src/gpu/graphite/DrawPass.h"
 
+#include "include/core/SkExecutor.h"
 #include "include/gpu/graphite/GraphiteTypes.h"
 #include "include/gpu/graphite/Recorder.h"
 #include "include/private/base/SkAlign.h"
+#include "include/private/base/SkSemaphore.h"
+#include "include/private/base/SkTemplates.h"
 #include "src/core/SkTraceEvent.h"
 #include "src/gpu/graphite/Buffer.h"
 #include "src/gpu/graphite/BufferManager.h"
@@ -24,18 +27,21 @@
 #include "src/gpu/graphite/GraphicsPipelineDesc.h"
 #include "src/gpu/graphite/Log.h"
 #include "src/gpu/graphite/PaintParamsKey.h"
+#include "src/gpu/graphite/PatchableUniforms.h"
 #include "src/gpu/graphite/PipelineData.h"
 #include "src/gpu/graphite/PipelineDataCache.h"
 #include "src/gpu/graphite/RecorderPriv.h"
 #include "src/gpu/graphite/Renderer.h"
 #include "src/gpu/graphite/ResourceProvider.h"
 #include "src/gpu/graphite/Sampler.h"
+#include "src/gpu/graphite/StaticUniformArena.h"
 #include "src/gpu/graphite/Texture.h"
 #include "src/gpu/graphite/UniformManager.h"
 #include "src/gpu/graphite/geom/BoundsManager.h"
 
 #include "src/base/SkMathPriv.h"
 #include "src/base/SkTBlockList.h"
+#include "src/base/SkTSort.h"
 
 #include <algorithm>
 #include <unordered_map>
@@ -46,6 +52,12 @@ namespace skgpu::graphite {
 
 namespace {
 
+// Passes with fewer sort keys than this use std::sort rather than a radix sort.
+static constexpr size_t kMinRadixSortKeys = 2048;
+
+// PendingDrawPasses sorts the keys of passes with at least this many on its executor.
+static constexpr size_t kMinExecutorSortKeys = 256;
+
 // Helper to manage packed fields within a uint64_t
 template <uint64_t Bits, uint64_t Offset>
 struct Bitfield {
@@ -216,7 +228,21 @@ public:
     // by GraphicsPipelineCache::Index and possibly the UniformCache::Index (when not using SSBOs).
     // When using SSBOs, the buffer is the same for all UniformCache::Indices that share the same
     // pipeline (and is stored in index 0).
-    bool writeUniforms(DrawBufferManager* bufferMgr) {
+    //
+    // If 'patchables' is not null, it's told where the data blocks of each pipeline were written,
+    // which were encoded with 'layout'.
+    //
+    // If 'arena' is not null, blocks that it holds are bound there instead of being written again.
+    // It can only be used with UBOs, and not along with 'patchables'.
+    bool writeUniforms(DrawBufferManager* bufferMgr,
+                       PatchableUniformTracker* patchables,
+                       StaticUniformArena* arena,
+                       Layout layout) {
+        SkASSERT(!arena || (!fUseStorageBuffers && !patchables));
+        if (arena) {
+            arena->beginPass();
+        }
+        skia_private::TArray<BindUniformBufferInfo> arenaBindings;
         for (UniformCache& cache : fPerPipelineCaches) {
             if (cache.empty()) {
                 continue;
@@ -228,13 +254,44 @@ public:
             if (!fUseStorageBuffers) {
                 udbSize = bufferMgr->alignUniformBlockSize(udbSize);
             }
+
+            size_t writtenCount = cache.size();
+            if (arena) {
+                arenaBindings.clear();
+                for (const CpuOrGpuData& dataBlock : cache.data()) {
+                    arenaBindings.push_back(arena->findOrAdd(*dataBlock.fCpuData, udbSize));
+                    if (arenaBindings.back()) {
+                        writtenCount--;
+                    }
+                }
+                if (writtenCount == 0) {
+                    for (int i = 0; i < arenaBindings.size(); ++i) {
+                        cache.data()[i].fGpuData = arenaBindings[i];
+                    }
+                    continue;
+                }
+            }
+
             auto [writer, bufferInfo] =
-                    fUseStorageBuffers ? bufferMgr->getSsboWriter(udbSize * cache.size())
-                                       : bufferMgr->getUniformWriter(udbSize * cache.size());
+                    fUseStorageBuffers ? bufferMgr->getSsboWriter(udbSize * writtenCount)
+                                       : bufferMgr->getUniformWriter(udbSize * writtenCount);
             if (!writer) {
                 return false; // Early out if buffer mapping failed
             }
 
+            if (patchables && patchables->hasBlocks()) {
+                skia_private::TArray<const UniformDataBlock*> blocks(SkToInt(cache.size()));
+                for (const CpuOrGpuData& dataBlock : cache.data()) {
+                    blocks.push_back(dataBlock.fCpuData);
+                }
+                patchables->addRange(bufferInfo,
+                                     udbSize,
+                                     fUseStorageBuffers ? BufferType::kStorage
+                                                        : BufferType::kUniform,
+                                     layout,
+                                     blocks);
+            }
+
             uint32_t bindingSize;
             if (fUseStorageBuffers) {
                 // For storage buffer we will always bind all the blocks.
@@ -245,8 +302,13 @@ public:
                 bindingSize = static_cast<uint32_t>(udbSize);
             }
 
-            for (CpuOrGpuData& dataBlock : cache.data()) {
+            for (int i = 0; i < SkToInt(cache.size()); ++i) {
+                CpuOrGpuData& dataBlock = cache.data()[i];
                 SkASSERT(dataBlock.fCpuData->size() == udbDataSize);
+                if (arena && arenaBindings[i]) {
+                    dataBlock.fGpuData = arenaBindings[i];
+                    continue;
+                }
                 writer.write(dataBlock.fCpuData->data(), udbDataSize);
                 // Swap from tracking the CPU data to the location of the GPU data
                 dataBlock.fGpuData.fBuffer = bufferInfo.fBuffer;
@@ -337,6 +399,9 @@ private:
  */
 class DrawPass::SortKey {
 public:
+    // Leaves the key uninitialized, for scratch space to sort into.
+    SortKey() = default;
+
     SortKey(const DrawList::Draw* draw,
             int renderStep,
             GraphicsPipelineCache::Index pipelineIndex,
@@ -379,6 +444,9 @@ public:
         return TextureBindingsField::get(fUniformKey);
     }
 
+    // The 128-bit value operator< compares, as SkTRadixSort wants it: least significant word first.
+    uint64_t keyWord(int i) const { return i ? fPipelineKey : fUniformKey; }
+
 private:
     // Fields are ordered from most-significant to least when sorting by 128-bit value.
     // NOTE: We don't use C++ bit fields because field ordering is implementation defined and we
@@ -419,7 +487,51 @@ DrawPass::DrawPass(sk_sp<TextureProxy> target,
         , fOps(ops)
         , fClearColor(clearColor) {}
 
-DrawPass::~DrawPass() = default;
+/**
+ * What DrawPass::Make() gathers for writing a pass's commands: its draws, the sort key of every
+ * (step, draw) pair, and the uniform and texture bindings the keys index into. The keys are sorted
+ * either by Make() or, in a batch of PendingDrawPasses, on the batch's executor.
+ */
+class DrawPass::PendingCommands : public SkRefCnt {
+public:
+    PendingCommands(std::unique_ptr<DrawList> draws,
+                    bool useStorageBuffers,
+                    SkISize targetSize,
+                    TessellatedPathCache* pathCache)
+            : fDraws(std::move(draws))
+            , fGeometryUniformTracker(useStorageBuffers)
+            , fShadingUniformTracker(useStorageBuffers)
+            , fTargetSize(targetSize)
+            , fPathCache(pathCache) {}
+
+    void sortKeys();
+
+    // Sorts the keys if they weren't sorted on an executor, and writes the commands for them into
+    // the pass. Returns false if the vertex data couldn't be written.
+    bool writeCommands(DrawPass*, DrawBufferManager*);
+
+    std::unique_ptr<DrawList> fDraws;
+    std::vector<SortKey> fKeys;
+    UniformTracker fGeometryUniformTracker;
+    UniformTracker fShadingUniformTracker;
+    TextureBindingTracker fTextureBindingTracker;
+    SkISize fTargetSize;
+    // The Recorder's, which outlives the pending commands since it finishes them.
+    TessellatedPathCache* fPathCache;
+
+    // The pass the commands are for, or null if it was deleted before they were written.
+    DrawPass* fPass = nullptr;
+    // Signaled once the keys are sorted, when they are sorted on an executor.
+    bool fSortingOnExecutor = false;
+    SkSemaphore fSorted;
+};
+
+DrawPass::~DrawPass() {
+    if (fPending) {
+        // Still waiting in the Recorder's PendingDrawPasses, which now skips it.
+        fPending->fPass = nullptr;
+    }
+}
 
 std::unique_ptr<DrawPass> DrawPass::Make(Recorder* recorder,
                                          std::unique_ptr<DrawList> draws,
@@ -478,9 +590,14 @@ std::unique_ptr<DrawPass> DrawPass::Make(Recorder* recorder,
     Layout uniformLayout =
             useStorageBuffers ? bindingReqs.fStorageBufferLayout : bindingReqs.fUniformBufferLayout;
 
-    UniformTracker geometryUniformTracker(useStorageBuffers);
-    UniformTracker shadingUniformTracker(useStorageBuffers);
-    TextureBindingTracker textureBindingTracker;
+    sk_sp<PendingCommands> pending(new PendingCommands(std::move(draws),
+                                                       useStorageBuffers,
+                                                       targetInfo.dimensions(),
+                                                       recorder->priv().tessellatedPathCache()));
+    UniformTracker& geometryUniformTracker = pending->fGeometryUniformTracker;
+    UniformTracker& shadingUniformTracker = pending->fShadingUniformTracker;
+    TextureBindingTracker& textureBindingTracker = pending->fTextureBindingTracker;
+    const DrawList* drawList = pending->fDraws.get();
 
     ShaderCodeDictionary* dict = recorder->priv().shaderCodeDictionary();
     PaintParamsKeyBuilder builder(dict);
@@ -489,10 +606,18 @@ std::unique_ptr<DrawPass> DrawPass::Make(Recorder* recorder,
     // shading and geometry uniforms below.
     PipelineDataGatherer gatherer(recorder->priv().caps(), uniformLayout);
 
-    std::vector<SortKey> keys;
-    keys.reserve(draws->renderStepCount());
+    std::vector<SortKey>& keys = pending->fKeys;
+    keys.reserve(drawList->renderStepCount());
+
+    int occludedDraws = 0;
+    for (const DrawList::Draw& draw : drawList->fDraws.items()) {
+        // Draws hidden by a later opaque draw are skipped before gathering any of their data.
+        // Depth-only draws are always kept, since the draws they clip rely on the depth they write.
+        if (draw.fPaintParams.has_value() && drawList->isOccluded(draw)) {
+            occludedDraws++;
+            continue;
+        }
 
-    for (const DrawList::Draw& draw : draws->fDraws.items()) {
         // If we have two different descriptors, such that the uniforms from the PaintParams can be
         // bound independently of those used by the rest of the RenderStep, then we can upload now
         // and remember the location for re-use on any RenderStep that does shading.
@@ -546,32 +671,89 @@ std::unique_ptr<DrawPass> DrawPass::Make(Recorder* recorder,
         drawPass->fRequiresMSAA |= draw.fRenderer->requiresMSAA();
     }
 
-    if (!geometryUniformTracker.writeUniforms(bufferMgr) ||
-        !shadingUniformTracker.writeUniforms(bufferMgr)) {
+    TRACE_COUNTER1("skia.gpu", "# occluded draws", occludedDraws);
+
+    if (!geometryUniformTracker.writeUniforms(bufferMgr,
+                                              /*patchables=*/nullptr,
+                                              /*arena=*/nullptr,
+                                              uniformLayout) ||
+        !shadingUniformTracker.writeUniforms(bufferMgr,
+                                             recorder->priv().patchableUniformTracker(),
+                                             recorder->priv().staticUniformArena(),
+                                             uniformLayout)) {
         // The necessary uniform data couldn't be written to the GPU, so the DrawPass is invalid.
         // Early out now since the next Recording snap will fail.
         return nullptr;
     }
 
-    // TODO: Explore sorting algorithms; in all likelihood this will be mostly sorted already, so
-    // algorithms that approach O(n) in that condition may be favorable. Alternatively, could
-    // explore radix sort that is always O(n). Brief testing suggested std::sort was faster than
-    // std::stable_sort and SkTQSort on my [ml]'s Windows desktop. Also worth considering in-place
-    // vs. algorithms that require an extra O(n) storage.
+    drawPass->fBounds = passBounds.roundOut().asSkIRect();
+    drawPass->fPipelineDescs = pipelineCache.detach();
+
+    RecordingStats* stats = recorder->priv().pendingRecordingStats();
+    stats->fDrawPassCount++;
+    stats->fDrawCount += drawList->fDraws.count() - occludedDraws;
+    stats->fPipelineCount += drawPass->fPipelineDescs.size();
+
+    // In a batch of pending passes the keys are sorted on the batch's executor, and the commands
+    // are written once the batch is finished. Otherwise they are written now.
+    if (PendingDrawPasses* batch = recorder->priv().pendingDrawPasses()) {
+        pending->fPass = drawPass.get();
+        drawPass->fPending = pending;
+        batch->add(std::move(pending));
+    } else if (!pending->writeCommands(drawPass.get(), bufferMgr)) {
+        return nullptr;
+    }
+
+    return drawPass;
+}
+
+void DrawPass::PendingCommands::sortKeys() {
+    TRACE_EVENT1("skia.gpu", TRACE_FUNC, "key count", fKeys.size());
+    std::vector<SortKey>& keys = fKeys;
+    // Large passes are radix sorted, which takes a pass over the keys for each byte that differs
+    // between them. Keys only use a few bits of each field, so that is under half of the 16 bytes.
+    // Draws that share a paint order (the common case, since non-overlapping draws get the same
+    // CompressedPaintersOrder) sort about twice as fast this way as with std::sort, but std::sort
+    // is faster when draws are already almost in order or there are few of them. See
+    // bench/graphite/DrawPassSortBench.cpp.
     // TODO: It's not strictly necessary, but would a stable sort be useful or just end up hiding
-    // bugs in the DrawOrder determination code?
-    std::sort(keys.begin(), keys.end());
+    // bugs in the DrawOrder determination code? (The radix sort happens to be stable.)
+    if (keys.size() < kMinRadixSortKeys) {
+        std::sort(keys.begin(), keys.end());
+    } else {
+        skia_private::AutoTMalloc<SortKey> scratch(keys.size());
+        SkTRadixSort<2>(keys.data(), keys.data() + keys.size(), scratch.get(),
+                        [](const SortKey& key, int i) { return key.keyWord(i); });
+    }
+}
+
+bool DrawPass::PendingCommands::writeCommands(DrawPass* drawPass, DrawBufferManager* bufferMgr) {
+    TRACE_EVENT0("skia.gpu", TRACE_FUNC);
+    if (fSortingOnExecutor) {
+        fSorted.wait();
+        fSortingOnExecutor = false;
+    } else {
+        this->sortKeys();
+    }
+    if (bufferMgr->hasMappingFailed()) {
+        SKGPU_LOG_W("Buffer mapping has already failed; dropping draw pass!");
+        return false;
+    }
+
+    UniformTracker& geometryUniformTracker = fGeometryUniformTracker;
+    UniformTracker& shadingUniformTracker = fShadingUniformTracker;
+    TextureBindingTracker& textureBindingTracker = fTextureBindingTracker;
 
     // Used to record vertex/instance data, buffer binds, and draw calls
-    DrawWriter drawWriter(&drawPass->fCommandList, bufferMgr);
+    DrawWriter drawWriter(&drawPass->fCommandList, bufferMgr, fPathCache);
     GraphicsPipelineCache::Index lastPipeline = GraphicsPipelineCache::kInvalidIndex;
-    SkIRect lastScissor = SkIRect::MakeSize(targetInfo.dimensions());
+    SkIRect lastScissor = SkIRect::MakeSize(fTargetSize);
 
     SkASSERT(drawPass->fTarget->isFullyLazy() ||
              SkIRect::MakeSize(drawPass->fTarget->dimensions()).contains(lastScissor));
     drawPass->fCommandList.setScissor(lastScissor);
 
-    for (const SortKey& key : keys) {
+    for (const SortKey& key : fKeys) {
         const DrawList::Draw& draw = key.draw();
         const RenderStep& renderStep = key.renderStep();
 
@@ -636,15 +818,12 @@ std::unique_ptr<DrawPass> DrawPass::Make(Recorder* recorder,
 
         if (bufferMgr->hasMappingFailed()) {
             SKGPU_LOG_W("Failed to write necessary vertex/instance data for DrawPass, dropping!");
-            return nullptr;
+            return false;
         }
     }
     // Finish recording draw calls for any collected data at the end of the loop
     drawWriter.flush();
 
-    drawPass->fBounds = passBounds.roundOut().asSkIRect();
-
-    drawPass->fPipelineDescs   = pipelineCache.detach();
     drawPass->fSamplerDescs    = textureBindingTracker.detachSamplers();
     drawPass->fSampledTextures = textureBindingTracker.detachTextures();
 
@@ -652,7 +831,52 @@ std::unique_ptr<DrawPass> DrawPass::Make(Recorder* recorder,
     TRACE_COUNTER1("skia.gpu", "# textures", drawPass->fSampledTextures.size());
     TRACE_COUNTER1("skia.gpu", "# commands", drawPass->fCommandList.count());
 
-    return drawPass;
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+PendingDrawPasses::PendingDrawPasses(SkExecutor* executor) : fExecutor(executor) {}
+
+PendingDrawPasses::~PendingDrawPasses() {
+    // Passes that are never finished still have to wait for their keys before they're deleted.
+    for (const sk_sp<DrawPass::PendingCommands>& pending : fPending) {
+        if (pending->fSortingOnExecutor) {
+            pending->fSorted.wait();
+        }
+        if (pending->fPass) {
+            pending->fPass->fPending.reset();
+        }
+    }
+}
+
+void PendingDrawPasses::add(sk_sp<DrawPass::PendingCommands> pending) {
+    // Small passes aren't worth the hand-off.
+    if (pending->fKeys.size() >= kMinExecutorSortKeys) {
+        pending->fSortingOnExecutor = true;
+        fExecutor->add([pending]() {
+            pending->sortKeys();
+            pending->fSorted.signal();
+        });
+    }
+    fPending.push_back(std::move(pending));
+}
+
+bool PendingDrawPasses::finish(DrawBufferManager* bufferMgr) {
+    TRACE_EVENT1("skia.gpu", TRACE_FUNC, "pass count", fPending.size());
+    bool succeeded = true;
+    for (const sk_sp<DrawPass::PendingCommands>& pending : fPending) {
+        if (DrawPass* drawPass = pending->fPass) {
+            succeeded &= pending->writeCommands(drawPass, bufferMgr);
+            pending->fPass = nullptr;
+            drawPass->fPending.reset();
+        } else if (pending->fSortingOnExecutor) {
+            // The pass was deleted, but the executor could still be sorting its keys.
+            pending->fSorted.wait();
+        }
+    }
+    fPending.clear();
+    return succeeded;
 }
 
 bool DrawPass::prepareResources(ResourceProvider* resourceProvider,
@@ -660,17 +884,52 @@ bool DrawPass::prepareResources(ResourceProvider* resourceProvider,
                                 const RenderPassDesc& renderPassDesc) {
     TRACE_EVENT0("skia.gpu", TRACE_FUNC);
 
+    // With a pipeline compilation executor, start every missing pipeline before waiting on any
+    // of them so that they compile concurrently.
+    bool compilingAsync = false;
+    for (const GraphicsPipelineDesc& pipelineDesc : fPipelineDescs) {
+        compilingAsync |= resourceProvider->compileGraphicsPipelineAsync(runtimeDict,
+                                                                         pipelineDesc,
+                                                                         renderPassDesc);
+    }
+    const bool dropPending = compilingAsync && resourceProvider->dropDrawsWithPendingPipelines();
+
+    bool droppedDraws = false;
     fFullPipelines.reserve(fFullPipelines.size() + fPipelineDescs.size());
     for (const GraphicsPipelineDesc& pipelineDesc : fPipelineDescs) {
-        auto pipeline = resourceProvider->findOrCreateGraphicsPipeline(runtimeDict,
-                                                                       pipelineDesc,
-                                                                       renderPassDesc);
+        sk_sp<GraphicsPipeline> pipeline;
+        if (dropPending) {
+            bool compiling = false;
+            pipeline = resourceProvider->findGraphicsPipeline(pipelineDesc,
+                                                              renderPassDesc,
+                                                              &compiling);
+            if (!pipeline && compiling) {
+                // Still compiling; the draws using it are removed below.
+                droppedDraws = true;
+                fFullPipelines.push_back(nullptr);
+                continue;
+            }
+        }
+        if (!pipeline) {
+            // If the asynchronous compile failed, try it here like any synchronous compile rather
+            // than dropping the draws in every pass from now on.
+            pipeline = resourceProvider->findOrCreateGraphicsPipeline(runtimeDict,
+                                                                      pipelineDesc,
+                                                                      renderPassDesc);
+        }
         if (!pipeline) {
             SKGPU_LOG_W("Failed to create GraphicsPipeline for draw in RenderPass. Dropping pass!");
             return false;
         }
         fFullPipelines.push_back(std::move(pipeline));
     }
+    if (droppedDraws) {
+        TRACE_EVENT_INSTANT0("skia.gpu", "Dropped draws with pending pipelines",
+                             TRACE_EVENT_SCOPE_THREAD);
+        fCommandList.removeDrawsForPipelines([&](uint32_t index) {
+            return !fFullPipelines[index];
+        });
+    }
     // The DrawPass may be long lived on a Recording and we no longer need the GraphicPipelineDescs
     // once we've created pipelines, so we drop the storage for them here.
     fPipelineDescs.clear();
@@ -705,7 +964,10 @@ bool DrawPass::prepareResources(ResourceProvider* resourceProvider,
 
 void DrawPass::addResourceRefs(CommandBuffer* commandBuffer) const {
     for (int i = 0; i < fFullPipelines.size(); ++i) {
-        commandBuffer->trackResource(fFullPipelines[i]);
+        // Pipelines whose draws were dropped while they compiled are null.
+        if (fFullPipelines[i]) {
+            commandBuffer->trackResource(fFullPipelines[i]);
+        }
     }
     for (int i = 0; i < fSampledTextures.size(); ++i) {
         commandBuffer->trackCommandBufferResource(fSampledTextures[i]->refTexture());
@@ -21,12 +21,14 @@
 
 #include <memory>
 
+class SkExecutor;
 struct SkImageInfo;
 
 namespace skgpu::graphite {
 
 class BoundsManager;
 class CommandBuffer;
+class DrawBufferManager;
 class DrawList;
 class GraphicsPipeline;
 class Recorder;
@@ -58,6 +60,9 @@ public:
     // clear color. If the DrawList has draws that required a dst readback texture copy to sample
     // from in the shader, it must be provided in `dstCopy` and a copy task must be executed before
     // the DrawPass is executed.
+    //
+    // While the Recorder has PendingDrawPasses, the pass's commands are only written once they are
+    // finished. Until then only its bounds, ops, depth-stencil flags and pipelines are known.
     static std::unique_ptr<DrawPass> Make(Recorder*,
                                           std::unique_ptr<DrawList>,
                                           sk_sp<TextureProxy> target,
@@ -104,6 +109,9 @@ public:
     void addResourceRefs(CommandBuffer*) const;
 
 private:
+    friend class PendingDrawPasses;
+
+    class PendingCommands;
     class SortKey;
 
     DrawPass(sk_sp<TextureProxy> target,
@@ -130,6 +138,32 @@ private:
     skia_private::TArray<sk_sp<GraphicsPipeline>> fFullPipelines;
     skia_private::TArray<sk_sp<TextureProxy>> fSampledTextures;
     skia_private::TArray<sk_sp<Sampler>> fSamplers;
+
+    // Set until the pass's commands are written, when they are written by PendingDrawPasses.
+    sk_sp<PendingCommands> fPending;
+};
+
+/**
+ * Collects the DrawPasses made while the Recorder flushes its devices, so that their draws are
+ * sorted on an executor, concurrently with gathering the uniforms of the passes that follow. Their
+ * commands are written, in the order the passes were made, by finish().
+ */
+class PendingDrawPasses {
+public:
+    explicit PendingDrawPasses(SkExecutor*);
+    ~PendingDrawPasses();
+
+    // Writes the commands of every pass made since the last call. Returns false if the vertex data
+    // of any of them couldn't be written, in which case the next Recording snap will fail.
+    bool finish(DrawBufferManager*);
+
+private:
+    friend class DrawPass;  // for add()
+
+    void add(sk_sp<DrawPass::PendingCommands>);
+
+    SkExecutor* fExecutor;
+    skia_private::TArray<sk_sp<DrawPass::PendingCommands>> fPending;
 };
 
 } // namespace skgpu::graphite
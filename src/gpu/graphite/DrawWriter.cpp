@@ -12,9 +12,12 @@
 
 namespace skgpu::graphite {
 
-DrawWriter::DrawWriter(DrawPassCommands::List* commandList, DrawBufferManager* bufferManager)
+DrawWriter::DrawWriter(DrawPassCommands::List* commandList,
+                       DrawBufferManager* bufferManager,
+                       TessellatedPathCache* pathCache)
         : fCommandList(commandList)
         , fManager(bufferManager)
+        , fPathCache(pathCache)
         , fPrimitiveType(PrimitiveType::kTriangles)
         , fVertexStride(0)
         , fInstanceStride(0)
@@ -15,6 +15,8 @@
 
 namespace skgpu::graphite {
 
+class TessellatedPathCache;
+
 namespace DrawPassCommands {
 class List;
 }
@@ -60,7 +62,9 @@ class DrawWriter {
 public:
     // NOTE: This constructor creates a writer that defaults 0 vertex and instance stride, so
     // 'newPipelineState()' must be called once the pipeline properties are known before it's used.
-    DrawWriter(DrawPassCommands::List*, DrawBufferManager*);
+    DrawWriter(DrawPassCommands::List*,
+               DrawBufferManager*,
+               TessellatedPathCache* pathCache = nullptr);
 
     // Cannot move or copy
     DrawWriter(const DrawWriter&) = delete;
@@ -71,6 +75,9 @@ public:
 
     DrawBufferManager* bufferManager() { return fManager; }
 
+    // The Recorder's cache of tessellated path patches, or null if RenderSteps shouldn't use one.
+    TessellatedPathCache* pathCache() { return fPathCache; }
+
     // Issue draw calls for any pending vertex and instance data collected by the writer.
     // Use either flush() or newDynamicState() based on context and readability.
     void flush();
@@ -195,6 +202,7 @@ private:
     // Both of these pointers must outlive the DrawWriter.
     DrawPassCommands::List* fCommandList;
     DrawBufferManager* fManager;
+    TessellatedPathCache* fPathCache;
 
     SkAutoMalloc fFailureStorage; // storage address for VertexWriter when GPU buffer mapping fails
 
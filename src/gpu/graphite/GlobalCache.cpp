@@ -24,6 +24,7 @@ GlobalCache::~GlobalCache() {
     SkASSERT(fGraphicsPipelineCache.count() == 0);
     SkASSERT(fComputePipelineCache.count() == 0);
     SkASSERT(fStaticResource.size() == 0);
+    SkASSERT(fInFlightGraphicsPipelines.count() == 0);
 }
 
 void GlobalCache::deleteResources() {
@@ -32,13 +33,66 @@ void GlobalCache::deleteResources() {
     fGraphicsPipelineCache.reset();
     fComputePipelineCache.reset();
     fStaticResource.clear();
+    fFailedGraphicsPipelineCompiles.reset();
 }
 
-sk_sp<GraphicsPipeline> GlobalCache::findGraphicsPipeline(const UniqueKey& key) {
+sk_sp<GraphicsPipeline> GlobalCache::InFlightGraphicsPipeline::wait() {
+    // Pass the signal on so that every waiter (and any later one) gets through.
+    fDone.wait();
+    fDone.signal();
+    return fPipeline;
+}
+
+sk_sp<GraphicsPipeline> GlobalCache::findGraphicsPipeline(
+        const UniqueKey& key,
+        sk_sp<InFlightGraphicsPipeline>* inFlight) {
     SkAutoSpinlock lock{fSpinLock};
 
     sk_sp<GraphicsPipeline>* entry = fGraphicsPipelineCache.find(key);
-    return entry ? *entry : nullptr;
+    if (entry) {
+        return *entry;
+    }
+    if (inFlight) {
+        sk_sp<InFlightGraphicsPipeline>* pending = fInFlightGraphicsPipelines.find(key);
+        *inFlight = pending ? *pending : nullptr;
+    }
+    return nullptr;
+}
+
+sk_sp<GlobalCache::InFlightGraphicsPipeline> GlobalCache::beginGraphicsPipelineCompile(
+        const UniqueKey& key) {
+    SkAutoSpinlock lock{fSpinLock};
+
+    if (fGraphicsPipelineCache.find(key) || fInFlightGraphicsPipelines.find(key) ||
+        fFailedGraphicsPipelineCompiles.contains(key)) {
+        return nullptr;
+    }
+    return *fInFlightGraphicsPipelines.set(key, sk_make_sp<InFlightGraphicsPipeline>());
+}
+
+void GlobalCache::finishGraphicsPipelineCompile(const UniqueKey& key,
+                                                sk_sp<GraphicsPipeline> pipeline) {
+    sk_sp<InFlightGraphicsPipeline> inFlight;
+    {
+        SkAutoSpinlock lock{fSpinLock};
+
+        sk_sp<InFlightGraphicsPipeline>* pending = fInFlightGraphicsPipelines.find(key);
+        SkASSERT(pending);
+        inFlight = std::move(*pending);
+        fInFlightGraphicsPipelines.remove(key);
+
+        if (pipeline) {
+            sk_sp<GraphicsPipeline>* entry = fGraphicsPipelineCache.find(key);
+            if (!entry) {
+                entry = fGraphicsPipelineCache.insert(key, std::move(pipeline));
+            } // else a synchronous compile of the same pipeline beat us to it
+            pipeline = *entry;
+        } else {
+            fFailedGraphicsPipelineCompiles.add(key);
+        }
+    }
+    inFlight->fPipeline = std::move(pipeline);
+    inFlight->fDone.signal();
 }
 
 sk_sp<GraphicsPipeline> GlobalCache::addGraphicsPipeline(const UniqueKey& key,
@@ -66,6 +120,7 @@ void GlobalCache::resetGraphicsPipelines() {
     SkAutoSpinlock lock{fSpinLock};
 
     fGraphicsPipelineCache.reset();
+    fFailedGraphicsPipelineCompiles.reset();
 }
 
 void GlobalCache::forEachGraphicsPipeline(
@@ -9,11 +9,14 @@
 #define skgpu_graphite_GlobalCache_DEFINED
 
 #include "include/core/SkRefCnt.h"
+#include "include/private/base/SkSemaphore.h"
 #include "include/private/base/SkTArray.h"
 #include "src/base/SkSpinlock.h"
 #include "src/core/SkLRUCache.h"
+#include "src/core/SkTHash.h"
 #include "src/gpu/ResourceKey.h"
 
+#include <atomic>
 #include <functional>
 
 namespace skgpu::graphite {
@@ -33,16 +36,44 @@ class ShaderCodeDictionary;
  * hit. If it's not found, the Recorder creates the resource on its own, without locking the
  * GlobalCache. After the resource is created, it is added to the GlobalCache, atomically returning
  * the winning Resource in the event of a race between Recorders for the same UniqueKey.
+ *
+ * GraphicsPipelines compiled asynchronously by the PipelineCompiler are registered as in flight
+ * while they compile, so that nobody else starts an equivalent compile and anyone that can't
+ * proceed without the pipeline can wait for it instead.
  */
 class GlobalCache {
 public:
+    // A GraphicsPipeline that is queued for or being compiled by a PipelineCompiler task.
+    class InFlightGraphicsPipeline : public SkRefCnt {
+    public:
+        // Returns true for exactly one caller, which must then compile the pipeline and call
+        // finishGraphicsPipelineCompile(). The PipelineCompiler task claims it when it starts, so
+        // a thread that needs the pipeline before the task has started can compile it itself
+        // instead of waiting for a task that may be queued behind it on the same executor.
+        bool claim() { return !fClaimed.exchange(true, std::memory_order_acq_rel); }
+
+        // Blocks until the compile finishes and returns the pipeline, or null if it failed. Only
+        // call this once the compile has been claimed by someone else.
+        sk_sp<GraphicsPipeline> wait();
+
+    private:
+        friend class GlobalCache;
+
+        std::atomic<bool> fClaimed{false};
+        SkSemaphore fDone;
+        sk_sp<GraphicsPipeline> fPipeline;  // Written before fDone is signaled.
+    };
+
     GlobalCache();
     ~GlobalCache();
 
     void deleteResources();
 
-    // Find a cached GraphicsPipeline that matches the associated key.
-    sk_sp<GraphicsPipeline> findGraphicsPipeline(const UniqueKey&) SK_EXCLUDES(fSpinLock);
+    // Find a cached GraphicsPipeline that matches the associated key. If there is none but one is
+    // being compiled and 'inFlight' is not null, it is set to the in-flight compile.
+    sk_sp<GraphicsPipeline> findGraphicsPipeline(
+            const UniqueKey&,
+            sk_sp<InFlightGraphicsPipeline>* inFlight = nullptr) SK_EXCLUDES(fSpinLock);
 
     // Associate the given pipeline with the key. If the key has already had a separate pipeline
     // associated with the key, that pipeline is returned and the passed-in pipeline is discarded.
@@ -50,6 +81,19 @@ public:
     sk_sp<GraphicsPipeline> addGraphicsPipeline(const UniqueKey&,
                                                 sk_sp<GraphicsPipeline>) SK_EXCLUDES(fSpinLock);
 
+    // Registers an in-flight compile for the key, unless a pipeline for it is already cached or
+    // being compiled, or an earlier in-flight compile of it failed, in which case null is returned.
+    // Whoever claims the returned compile must call finishGraphicsPipelineCompile().
+    sk_sp<InFlightGraphicsPipeline> beginGraphicsPipelineCompile(const UniqueKey&)
+            SK_EXCLUDES(fSpinLock);
+
+    // Adds the compiled pipeline (if it is not null) like addGraphicsPipeline() and releases
+    // everyone waiting on the in-flight compile. A null pipeline is remembered as a failure, so
+    // that the pipeline is no longer compiled asynchronously and callers that need it compile it
+    // synchronously instead.
+    void finishGraphicsPipelineCompile(const UniqueKey&, sk_sp<GraphicsPipeline>)
+            SK_EXCLUDES(fSpinLock);
+
 #if defined(GRAPHITE_TEST_UTILS)
     int numGraphicsPipelines() const SK_EXCLUDES(fSpinLock);
     void resetGraphicsPipelines() SK_EXCLUDES(fSpinLock);
@@ -86,6 +130,11 @@ private:
     GraphicsPipelineCache fGraphicsPipelineCache SK_GUARDED_BY(fSpinLock);
     ComputePipelineCache  fComputePipelineCache  SK_GUARDED_BY(fSpinLock);
 
+    skia_private::THashMap<UniqueKey, sk_sp<InFlightGraphicsPipeline>, KeyHash>
+            fInFlightGraphicsPipelines SK_GUARDED_BY(fSpinLock);
+    skia_private::THashSet<UniqueKey, KeyHash> fFailedGraphicsPipelineCompiles
+            SK_GUARDED_BY(fSpinLock);
+
     skia_private::TArray<sk_sp<Resource>> fStaticResource SK_GUARDED_BY(fSpinLock);
 };
 
@@ -9,6 +9,7 @@
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColorSpace.h"
 #include "include/core/SkImage.h"
+#include "include/core/SkPixmap.h"
 #include "include/core/SkSurface.h"
 #include "include/core/SkYUVAInfo.h"
 #include "include/core/SkYUVAPixmaps.h"
@@ -20,6 +21,7 @@
 #include "include/gpu/graphite/YUVABackendTextures.h"
 #include "include/private/base/SkMutex.h"
 #include "src/core/SkImageFilterTypes.h"
+#include "src/core/SkImageInfoPriv.h"
 #include "src/core/SkImageFilter_Base.h"
 #include "src/gpu/RefCntedCallback.h"
 #include "src/gpu/graphite/Caps.h"
@@ -34,6 +36,7 @@
 #include "src/gpu/graphite/TextureProxy.h"
 #include "src/gpu/graphite/TextureProxyView.h"
 #include "src/gpu/graphite/TextureUtils.h"
+#include "src/gpu/graphite/task/UploadTask.h"
 #include "src/image/SkImage_Base.h"
 #include "src/image/SkImage_Lazy.h"
 #include "src/image/SkImage_Picture.h"
@@ -415,6 +418,71 @@ sk_sp<SkImage> TextureFromImage(skgpu::graphite::Recorder* recorder,
     return ib->makeSubset(recorder, ib->bounds(), requiredProps);
 }
 
+sk_sp<SkImage> TextureFromPixelWriter(skgpu::graphite::Recorder* recorder,
+                                      const SkImageInfo& info,
+                                      const PixelWriterProc& writePixels,
+                                      std::string_view label) {
+    if (!recorder || !writePixels || !SkImageInfoIsValid(info)) {
+        return nullptr;
+    }
+    if (label.empty()) {
+        label = "PixelWriterTexture";
+    }
+
+    const Caps* caps = recorder->priv().caps();
+    SkColorType ct = info.colorType();
+    TextureInfo textureInfo = caps->getDefaultSampledTextureInfo(ct,
+                                                                 skgpu::Mipmapped::kNo,
+                                                                 recorder->priv().isProtected(),
+                                                                 skgpu::Renderable::kNo);
+    bool writesInPlace = false;
+    if (textureInfo.isValid()) {
+        auto [supportedColorType, isRGB888Format] =
+                caps->supportedWritePixelsColorType(ct, textureInfo, ct);
+        writesInPlace = supportedColorType == ct && !isRGB888Format;
+    }
+    if (!writesInPlace) {
+        SkBitmap bitmap;
+        if (!bitmap.tryAllocPixels(info) || !writePixels(bitmap.pixmap())) {
+            return nullptr;
+        }
+        bitmap.setImmutable();
+        return MakeFromBitmap(recorder,
+                              info.colorInfo(),
+                              bitmap,
+                              /*mipmaps=*/nullptr,
+                              skgpu::Budgeted::kNo,
+                              /*requiredProps=*/{},
+                              label);
+    }
+
+    sk_sp<TextureProxy> proxy = TextureProxy::Make(caps,
+                                                   recorder->priv().resourceProvider(),
+                                                   info.dimensions(),
+                                                   textureInfo,
+                                                   label,
+                                                   skgpu::Budgeted::kNo);
+    if (!proxy) {
+        return nullptr;
+    }
+    UploadInstance upload = UploadInstance::MakeInPlace(recorder,
+                                                        proxy,
+                                                        info.colorInfo(),
+                                                        SkIRect::MakeSize(info.dimensions()),
+                                                        writePixels,
+                                                        std::make_unique<ImageUploadContext>());
+    if (!upload.isValid()) {
+        return nullptr;
+    }
+    recorder->priv().add(UploadTask::Make(std::move(upload)));
+
+    skgpu::Swizzle swizzle = caps->getReadSwizzle(ct, textureInfo);
+    if (SkColorTypeIsAlphaOnly(ct)) {
+        swizzle = skgpu::Swizzle::Concat(swizzle, skgpu::Swizzle("aaaa"));
+    }
+    return sk_make_sp<Image>(TextureProxyView(std::move(proxy), swizzle), info.colorInfo());
+}
+
 sk_sp<SkImage> TextureFromYUVAPixmaps(Recorder* recorder,
                                       const SkYUVAPixmaps& pixmaps,
                                       SkImage::RequiredProperties requiredProps,
@@ -988,6 +988,8 @@ static void gather_runtime_effect_uniforms(const KeyContext& keyContext,
     SkSpan<const SkRuntimeEffect::Uniform> rtsUniforms = effect->uniforms();
 
     if (!rtsUniforms.empty() && uniformData) {
+        const bool patchable = keyContext.recorder() &&
+                               keyContext.recorder()->priv().patchableUniformTracker();
         // Collect all the other uniforms from the provided SkData.
         const uint8_t* uniformBase = uniformData->bytes();
         for (size_t index = 0; index < rtsUniforms.size(); ++index) {
@@ -996,6 +998,9 @@ static void gather_runtime_effect_uniforms(const KeyContext& keyContext,
             const uint8_t* uniformPtr = uniformBase + rtsUniforms[index].offset;
             // Pass the uniform data to the gatherer.
             gatherer->write(uniform, uniformPtr);
+            if (patchable) {
+                gatherer->markPatchable(effect, SkToInt(index), uniform);
+            }
         }
     }
 
@@ -46,6 +46,9 @@ public:
     static constexpr PaintParamsKey Invalid() { return PaintParamsKey(SkSpan<const int32_t>()); }
     bool isValid() const { return !fData.empty(); }
 
+    // The code-snippet IDs of the key's nodes, in depth-first order.
+    SkSpan<const int32_t> data() const { return fData; }
+
     // Return a PaintParamsKey whose data is owned by the provided arena and is not attached to
     // a PaintParamsKeyBuilder. The caller must ensure that the SkArenaAlloc remains alive longer
     // than the returned key.
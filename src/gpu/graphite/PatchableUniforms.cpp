@@ -0,0 +1,177 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/gpu/graphite/PatchableUniforms.h"
+
+#include "src/gpu/graphite/Buffer.h"
+#include "src/gpu/graphite/Caps.h"
+#include "src/gpu/graphite/CommandBuffer.h"
+#include "src/gpu/graphite/PipelineData.h"
+#include "src/gpu/graphite/ResourceProvider.h"
+#include "src/gpu/graphite/UniformManager.h"
+
+#include <cstring>
+
+namespace skgpu::graphite {
+
+PatchableUniforms::PatchableUniforms() = default;
+PatchableUniforms::~PatchableUniforms() = default;
+
+bool PatchableUniforms::set(const SkRuntimeEffect* effect, int index, const void* data) {
+    bool found = false;
+    for (Range& range : fRanges) {
+        for (const Patch& patch : range.fPatches) {
+            const PatchableUniform& uniform = patch.fUniform;
+            if (uniform.fEffect.get() != effect || uniform.fIndex != index) {
+                continue;
+            }
+            // The uniform is encoded on its own, and since it was aligned in the block when it was
+            // first written, its bytes are the last ones before its end there too.
+            UniformManager uniformManager(range.fLayout);
+            SkDEBUGCODE(uniformManager.setExpectedUniforms({&uniform.fUniform, 1});)
+            uniformManager.write(uniform.fUniform, data);
+            SkDEBUGCODE(uniformManager.doneWithExpectedUniforms();)
+            const size_t size = uniformManager.size();
+            SkASSERT(size <= patch.fEnd && patch.fEnd <= range.fSize);
+            UniformDataBlock encoded = uniformManager.finishUniformDataBlock();
+            memcpy(range.fData.get() + patch.fEnd - size, encoded.data(), size);
+
+            range.fDirty = true;
+            found = true;
+        }
+    }
+    return found;
+}
+
+bool PatchableUniforms::upload(ResourceProvider* resourceProvider,
+                               const Caps* caps,
+                               CommandBuffer* commandBuffer,
+                               Range* range) {
+    if (caps->drawBufferCanBeMapped()) {
+        sk_sp<Buffer> buffer = resourceProvider->findOrCreateBuffer(range->fSize,
+                                                                    range->fType,
+                                                                    AccessPattern::kHostVisible,
+                                                                    "PatchedUniforms");
+        void* mapPtr = buffer ? buffer->map() : nullptr;
+        if (!mapPtr) {
+            return false;
+        }
+        memcpy(mapPtr, range->fData.get(), range->fSize);
+        buffer->unmap();
+        range->fPatchedBuffer = std::move(buffer);
+        return true;
+    }
+
+    sk_sp<Buffer> transferBuffer =
+            resourceProvider->findOrCreateBuffer(range->fSize,
+                                                 BufferType::kXferCpuToGpu,
+                                                 AccessPattern::kHostVisible,
+                                                 "PatchedUniformsTransfer");
+    sk_sp<Buffer> buffer = resourceProvider->findOrCreateBuffer(range->fSize,
+                                                                range->fType,
+                                                                AccessPattern::kGpuOnly,
+                                                                "PatchedUniforms");
+    void* mapPtr = transferBuffer ? transferBuffer->map() : nullptr;
+    if (!mapPtr || !buffer) {
+        return false;
+    }
+    memcpy(mapPtr, range->fData.get(), range->fSize);
+    transferBuffer->unmap();
+    if (!commandBuffer->copyBufferToBuffer(transferBuffer.get(), 0, buffer, 0, range->fSize)) {
+        return false;
+    }
+    commandBuffer->trackResource(std::move(transferBuffer));
+    range->fPatchedBuffer = std::move(buffer);
+    return true;
+}
+
+bool PatchableUniforms::prepareForInsert(ResourceProvider* resourceProvider,
+                                         const Caps* caps,
+                                         CommandBuffer* commandBuffer) {
+    fRemaps.clear();
+    for (Range& range : fRanges) {
+        if (range.fDirty) {
+            if (!this->upload(resourceProvider, caps, commandBuffer, &range)) {
+                return false;
+            }
+            range.fDirty = false;
+        }
+        if (range.fPatchedBuffer) {
+            commandBuffer->trackResource(range.fPatchedBuffer);
+            fRemaps.push_back({range.fBuffer, range.fOffset, range.fSize,
+                               range.fPatchedBuffer.get()});
+        }
+    }
+    commandBuffer->setUniformBufferRemaps(fRemaps);
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+PatchableUniformTracker::PatchableUniformTracker() = default;
+PatchableUniformTracker::~PatchableUniformTracker() = default;
+
+void PatchableUniformTracker::addBlock(const UniformDataBlock* block,
+                                       SkSpan<const PatchableUniform> uniforms) {
+    if (uniforms.empty() || fBlocks.find(block)) {
+        return;
+    }
+    fBlocks.set(block,
+                skia_private::TArray<PatchableUniform>(uniforms.data(), SkToInt(uniforms.size())));
+}
+
+void PatchableUniformTracker::addRange(BindBufferInfo start,
+                                       size_t stride,
+                                       BufferType type,
+                                       Layout layout,
+                                       SkSpan<const UniformDataBlock* const> blocks) {
+    SkASSERT(start.fBuffer);
+    bool patchable = false;
+    for (const UniformDataBlock* block : blocks) {
+        if (fBlocks.find(block)) {
+            patchable = true;
+            break;
+        }
+    }
+    if (!patchable) {
+        return;
+    }
+
+    if (!fCurrent) {
+        fCurrent = std::make_unique<PatchableUniforms>();
+    }
+    PatchableUniforms::Range& range = fCurrent->fRanges.push_back();
+    range.fBuffer = start.fBuffer;
+    range.fOffset = start.fOffset;
+    range.fSize = stride * blocks.size();
+    range.fType = type;
+    range.fLayout = layout;
+    // The padding between blocks is never read, so it's left zeroed.
+    range.fData = std::make_unique<std::byte[]>(range.fSize);
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        const size_t blockOffset = i * stride;
+        SkASSERT(blocks[i]->size() <= stride);
+        memcpy(range.fData.get() + blockOffset, blocks[i]->data(), blocks[i]->size());
+        if (const skia_private::TArray<PatchableUniform>* uniforms = fBlocks.find(blocks[i])) {
+            for (const PatchableUniform& uniform : *uniforms) {
+                range.fPatches.push_back({uniform, blockOffset + uniform.fEnd});
+            }
+        }
+    }
+}
+
+std::unique_ptr<PatchableUniforms> PatchableUniformTracker::detach() {
+    fBlocks.reset();
+    return std::move(fCurrent);
+}
+
+void PatchableUniformTracker::reset() {
+    fBlocks.reset();
+    fCurrent.reset();
+}
+
+} // namespace skgpu::graphite
@@ -0,0 +1,125 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef skgpu_graphite_PatchableUniforms_DEFINED
+#define skgpu_graphite_PatchableUniforms_DEFINED
+
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkSpan.h"
+#include "include/effects/SkRuntimeEffect.h"
+#include "include/private/base/SkTArray.h"
+#include "src/core/SkTHash.h"
+#include "src/gpu/graphite/ResourceTypes.h"
+#include "src/gpu/graphite/Uniform.h"
+
+#include <cstddef>
+#include <memory>
+
+namespace skgpu::graphite {
+
+class Buffer;
+class Caps;
+class CommandBuffer;
+class ResourceProvider;
+class UniformDataBlock;
+
+// A uniform of a runtime effect as it was written to a paint's uniform data block. Its value ends
+// at fEnd bytes into the block.
+struct PatchableUniform {
+    sk_sp<const SkRuntimeEffect> fEffect;
+    int fIndex;  // Into fEffect->uniforms()
+    Uniform fUniform;
+    size_t fEnd;
+};
+
+/**
+ * The runtime effect uniforms of a Recording snapped by a Recorder made with
+ * RecorderOptions::fPatchableRuntimeEffectUniforms, and where its DrawPasses wrote them.
+ *
+ * The paint uniforms a DrawPass writes for one pipeline are one range of a uniform or storage
+ * buffer. Changing a uniform doesn't touch those buffers, which earlier insertions of the Recording
+ * may still be reading. Instead the ranges holding it are copied into new buffers when the
+ * Recording is next inserted, and the CommandBuffer binds those in place of the originals.
+ */
+class PatchableUniforms {
+public:
+    PatchableUniforms();
+    ~PatchableUniforms();
+
+    // Encodes 'data', laid out like the effect's uniform 'index', into every range that holds the
+    // uniform. Returns false if none of the Recording's draws used it.
+    bool set(const SkRuntimeEffect*, int index, const void* data);
+
+    // Writes the ranges that changed since the last call into new buffers, keeps the buffers of all
+    // patched ranges alive on 'commandBuffer', and has it bind them in place of the originals until
+    // CommandBuffer::clearUniformBufferRemaps(). Returns false if a buffer couldn't be made.
+    bool prepareForInsert(ResourceProvider*, const Caps*, CommandBuffer*);
+
+private:
+    friend class PatchableUniformTracker;
+
+    struct Patch {
+        PatchableUniform fUniform;
+        size_t fEnd;  // Relative to the start of the range
+    };
+
+    struct Range {
+        const Buffer* fBuffer;
+        size_t fOffset;
+        size_t fSize;
+        BufferType fType;
+        Layout fLayout;
+        std::unique_ptr<std::byte[]> fData;  // The current contents of the range
+        skia_private::TArray<Patch> fPatches;
+        sk_sp<Buffer> fPatchedBuffer;  // Null until the range is first patched
+        bool fDirty = false;
+    };
+
+    bool upload(ResourceProvider*, const Caps*, CommandBuffer*, Range*);
+
+    skia_private::TArray<Range> fRanges;
+    skia_private::TArray<UniformBufferRemap> fRemaps;
+};
+
+/**
+ * Collects the PatchableUniforms of the Recording being recorded. A Recorder only has one when it
+ * was made with RecorderOptions::fPatchableRuntimeEffectUniforms.
+ */
+class PatchableUniformTracker {
+public:
+    PatchableUniformTracker();
+    ~PatchableUniformTracker();
+
+    // Notes the runtime effect uniforms written to 'block', a pointer from the Recorder's
+    // UniformDataCache. The draws of a block that is already known keep its uniforms, so two
+    // paints that wrote the same bytes are patched together.
+    void addBlock(const UniformDataBlock*, SkSpan<const PatchableUniform>);
+
+    bool hasBlocks() const { return !fBlocks.empty(); }
+
+    // Notes where a DrawPass wrote the paint uniforms of one pipeline: 'blocks' follow each other
+    // every 'stride' bytes from 'start'. Nothing is kept unless one of them is patchable.
+    void addRange(BindBufferInfo start,
+                  size_t stride,
+                  BufferType,
+                  Layout,
+                  SkSpan<const UniformDataBlock* const> blocks);
+
+    // Returns what was collected since the last call, or null if nothing can be patched.
+    std::unique_ptr<PatchableUniforms> detach();
+
+    void reset();
+
+private:
+    skia_private::THashMap<const UniformDataBlock*, skia_private::TArray<PatchableUniform>>
+            fBlocks;
+    std::unique_ptr<PatchableUniforms> fCurrent;
+};
+
+} // namespace skgpu::graphite
+
+#endif // skgpu_graphite_PatchableUniforms_DEFINED
@@ -89,6 +89,7 @@ PathAtlas::DrawAtlasMgr::DrawAtlasMgr(size_t width, size_t height,
                                          DrawAtlas::AllowMultitexturing::kYes :
                                          DrawAtlas::AllowMultitexturing::kNo,
                                  useStorageTextures,
+                                 DrawAtlas::Shared::kNo,
                                  /*evictor=*/this,
                                  label);
     SkASSERT(fDrawAtlas);
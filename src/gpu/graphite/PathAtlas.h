@@ -99,9 +99,13 @@ public:
      *
      * `clipBounds` represents the conservative bounding box of the union of the clip stack that
      * should apply to the shape.
+     *
+     * `shape` is the shape that would be rendered, so that its complexity can be weighed against
+     * the size of its mask.
      */
     virtual bool isSuitableForAtlasing(const Rect& transformedShapeBounds,
-                                       const Rect& clipBounds) const {
+                                       const Rect& clipBounds,
+                                       const Shape& shape) const {
         return true;
     }
 
@@ -139,6 +143,10 @@ protected:
         void evict(PlotLocator) override;
         void postFlush(Recorder*);
 
+        void addToMemoryReport(const char* name, GpuMemoryReport* report) const {
+            fDrawAtlas->addToMemoryReport(name, report);
+        }
+
     protected:
         DrawAtlasMgr(size_t width, size_t height,
                      size_t plotWidth, size_t plotHeight,
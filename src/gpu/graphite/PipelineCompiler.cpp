@@ -0,0 +1,97 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/gpu/graphite/PipelineCompiler.h"
+
+#include "include/core/SkExecutor.h"
+#include "src/core/SkTraceEvent.h"
+#include "src/gpu/graphite/Caps.h"
+#include "src/gpu/graphite/GlobalCache.h"
+#include "src/gpu/graphite/GraphicsPipeline.h"
+#include "src/gpu/graphite/GraphicsPipelineDesc.h"
+#include "src/gpu/graphite/PipelineUsageLog.h"
+#include "src/gpu/graphite/RenderPassDesc.h"
+#include "src/gpu/graphite/ResourceProvider.h"
+#include "src/gpu/graphite/RuntimeEffectDictionary.h"
+#include "src/gpu/graphite/SharedContext.h"
+
+#include <utility>
+
+namespace skgpu::graphite {
+
+PipelineCompiler::PipelineCompiler(SharedContext* sharedContext,
+                                   SkExecutor* executor,
+                                   bool dropDrawsWithPendingPipelines)
+        : fSharedContext(sharedContext)
+        , fDropDrawsWithPendingPipelines(dropDrawsWithPendingPipelines)
+        , fTaskGroup(*executor) {}
+
+PipelineCompiler::~PipelineCompiler() {
+    fTaskGroup.wait();
+}
+
+void PipelineCompiler::compileAsync(const RuntimeEffectDictionary* runtimeDict,
+                                    const GraphicsPipelineDesc& pipelineDesc,
+                                    const RenderPassDesc& renderPassDesc) {
+    UniqueKey pipelineKey = fSharedContext->caps()->makeGraphicsPipelineKey(pipelineDesc,
+                                                                            renderPassDesc);
+    sk_sp<GlobalCache::InFlightGraphicsPipeline> inFlight =
+            fSharedContext->globalCache()->beginGraphicsPipelineCompile(pipelineKey);
+    if (!inFlight) {
+        return;
+    }
+
+    // The Recorder's runtime effect dictionary is reset when it snaps a Recording, so the task
+    // keeps its own copy (which also keeps the runtime effects alive).
+    auto dict = runtimeDict ? std::make_shared<RuntimeEffectDictionary>(*runtimeDict) : nullptr;
+    fTaskGroup.add([this, dict, pipelineDesc, renderPassDesc, inFlight = std::move(inFlight),
+                    key = std::move(pipelineKey)]() {
+        if (!inFlight->claim()) {
+            // A thread that needed the pipeline before we got to it compiled it itself.
+            return;
+        }
+        TRACE_EVENT0("skia.shaders", "PipelineCompiler::compileAsync");
+        std::unique_ptr<WorkerProvider> provider = this->acquireProvider();
+        sk_sp<GraphicsPipeline> pipeline;
+        if (provider) {
+            pipeline = provider->fResourceProvider->createGraphicsPipeline(dict.get(),
+                                                                           pipelineDesc,
+                                                                           renderPassDesc);
+            this->releaseProvider(std::move(provider));
+        }
+        if (PipelineUsageLog* log = fSharedContext->pipelineUsageLog(); log && pipeline) {
+            log->record(key, pipelineDesc, renderPassDesc);
+        }
+        fSharedContext->globalCache()->finishGraphicsPipelineCompile(key, std::move(pipeline));
+    });
+}
+
+std::unique_ptr<PipelineCompiler::WorkerProvider> PipelineCompiler::acquireProvider() {
+    {
+        SkAutoMutexExclusive lock(fProviderMutex);
+        if (!fFreeProviders.empty()) {
+            std::unique_ptr<WorkerProvider> provider = std::move(fFreeProviders.back());
+            fFreeProviders.pop_back();
+            return provider;
+        }
+    }
+
+    // Pipeline creation only uses the ResourceProvider's cache for small objects like render
+    // passes, so the budget doesn't matter much.
+    auto provider = std::make_unique<WorkerProvider>();
+    provider->fResourceProvider = fSharedContext->makeResourceProvider(&provider->fSingleOwner,
+                                                                       SK_InvalidGenID,
+                                                                       /*resourceBudget=*/0);
+    return provider->fResourceProvider ? std::move(provider) : nullptr;
+}
+
+void PipelineCompiler::releaseProvider(std::unique_ptr<WorkerProvider> provider) {
+    SkAutoMutexExclusive lock(fProviderMutex);
+    fFreeProviders.push_back(std::move(provider));
+}
+
+} // namespace skgpu::graphite
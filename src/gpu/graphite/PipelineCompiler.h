@@ -0,0 +1,75 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef skgpu_graphite_PipelineCompiler_DEFINED
+#define skgpu_graphite_PipelineCompiler_DEFINED
+
+#include "include/private/base/SkMutex.h"
+#include "include/private/base/SkTArray.h"
+#include "include/private/base/SingleOwner.h"
+#include "src/core/SkTaskGroup.h"
+
+#include <memory>
+
+class SkExecutor;
+
+namespace skgpu::graphite {
+
+class GraphicsPipelineDesc;
+class RenderPassDesc;
+class ResourceProvider;
+class RuntimeEffectDictionary;
+class SharedContext;
+
+/**
+ * Compiles GraphicsPipelines on the SkExecutor given to ContextOptions. Each compile is registered
+ * with the GlobalCache while it is in flight, so requests for the same pipeline from other threads
+ * wait for (or skip) it instead of compiling it again, and the finished pipeline lands in the
+ * GlobalCache like any synchronously compiled one. A thread that needs a pipeline whose task hasn't
+ * started yet compiles it itself, since the task may be queued behind that thread.
+ *
+ * Backend ResourceProviders are not thread safe, so each task borrows one of a small pool of
+ * ResourceProviders that only the PipelineCompiler uses.
+ */
+class PipelineCompiler {
+public:
+    PipelineCompiler(SharedContext*, SkExecutor*, bool dropDrawsWithPendingPipelines);
+    ~PipelineCompiler();  // Waits for all outstanding compiles.
+
+    // Starts compiling the pipeline unless it is already cached or being compiled.
+    void compileAsync(const RuntimeEffectDictionary*,
+                      const GraphicsPipelineDesc&,
+                      const RenderPassDesc&);
+
+    // Waits for every compile started so far to finish.
+    void wait() { fTaskGroup.wait(); }
+
+    bool dropDrawsWithPendingPipelines() const { return fDropDrawsWithPendingPipelines; }
+
+private:
+    struct WorkerProvider {
+        SingleOwner fSingleOwner;
+        std::unique_ptr<ResourceProvider> fResourceProvider;
+    };
+
+    std::unique_ptr<WorkerProvider> acquireProvider();
+    void releaseProvider(std::unique_ptr<WorkerProvider>);
+
+    SharedContext* fSharedContext;
+    const bool fDropDrawsWithPendingPipelines;
+
+    SkMutex fProviderMutex;
+    skia_private::TArray<std::unique_ptr<WorkerProvider>> fFreeProviders
+            SK_GUARDED_BY(fProviderMutex);
+
+    // Declared last so that it is destroyed (waiting for the tasks) before the providers.
+    SkTaskGroup fTaskGroup;
+};
+
+} // namespace skgpu::graphite
+
+#endif // skgpu_graphite_PipelineCompiler_DEFINED
@@ -18,6 +18,7 @@ PipelineDataGatherer::PipelineDataGatherer(const Caps* caps, Layout layout)
 void PipelineDataGatherer::resetWithNewLayout(Layout layout) {
     fUniformManager.resetWithNewLayout(layout);
     fTextureDataBlock.reset();
+    fPatchableUniforms.clear();
 }
 
 #ifdef SK_DEBUG
@@ -19,6 +19,7 @@
 #include "src/base/SkEnumBitMask.h"
 #include "src/gpu/graphite/Caps.h"
 #include "src/gpu/graphite/DrawTypes.h"
+#include "src/gpu/graphite/PatchableUniforms.h"
 #include "src/gpu/graphite/TextureProxy.h"
 #include "src/gpu/graphite/UniformManager.h"
 
@@ -120,6 +121,13 @@ public:
 
     void write(const Uniform& u, const void* data) { fUniformManager.write(u, data); }
 
+    // Notes that the uniform 'u' just written holds the value of the effect's uniform 'index', so
+    // that it can be patched in the Recording (see PatchableUniformTracker).
+    void markPatchable(const SkRuntimeEffect* effect, int index, const Uniform& u) {
+        fPatchableUniforms.push_back({sk_ref_sp(effect), index, u, fUniformManager.size()});
+    }
+    SkSpan<const PatchableUniform> patchableUniforms() const { return fPatchableUniforms; }
+
     void writePaintColor(const SkPMColor4f& color) { fUniformManager.writePaintColor(color); }
 
     bool hasUniforms() const { return fUniformManager.size(); }
@@ -139,6 +147,7 @@ private:
     const Caps* const fCaps;
     TextureDataBlock  fTextureDataBlock;
     UniformManager    fUniformManager;
+    skia_private::TArray<PatchableUniform> fPatchableUniforms;
 };
 
 #ifdef SK_DEBUG
@@ -0,0 +1,339 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/gpu/graphite/PipelineUsageLog.h"
+
+#include "include/core/SkColorType.h"
+#include "include/core/SkData.h"
+#include "include/core/SkString.h"
+#include "include/gpu/graphite/Context.h"
+#include "src/core/SkChecksum.h"
+#include "src/core/SkKnownRuntimeEffects.h"
+#include "src/core/SkReadBuffer.h"
+#include "src/core/SkWriteBuffer.h"
+#include "src/gpu/graphite/Caps.h"
+#include "src/gpu/graphite/ContextPriv.h"
+#include "src/gpu/graphite/GraphicsPipeline.h"
+#include "src/gpu/graphite/Log.h"
+#include "src/gpu/graphite/PaintParamsKey.h"
+#include "src/gpu/graphite/PipelineCompiler.h"
+#include "src/gpu/graphite/Renderer.h"
+#include "src/gpu/graphite/RendererProvider.h"
+#include "src/gpu/graphite/ResourceProvider.h"
+#include "src/gpu/graphite/RuntimeEffectDictionary.h"
+#include "src/gpu/graphite/ShaderCodeDictionary.h"
+#include "src/gpu/graphite/SharedContext.h"
+
+#include <cstring>
+#include <memory>
+
+using namespace skia_private;
+
+namespace skgpu::graphite {
+
+namespace {
+
+constexpr uint32_t kMagic = SkSetFourByteTag('s', 'k', 'p', 'u');
+constexpr uint32_t kVersion = 1;
+
+// The render pass of a pipeline, as the arguments RenderPassDesc::Make() rebuilds it from.
+struct RenderPassParams {
+    SkColorType fColorType;
+    Mipmapped fMipmapped;
+    Protected fProtected;
+    LoadOp fLoadOp;
+    SkEnumBitMask<DepthStencilFlags> fDepthStencilFlags = DepthStencilFlags::kNone;
+    bool fRequiresMSAA;
+};
+
+// Snippet IDs are only stable within a build of Skia, so the data records a hash of the built-in
+// snippets and is ignored by builds whose snippets differ.
+uint32_t snippet_table_hash(const ShaderCodeDictionary* dict) {
+    uint32_t hash = SkKnownRuntimeEffects::kStableKeyCnt;
+    for (int id = 0; id < kBuiltInCodeSnippetIDCount; ++id) {
+        const ShaderSnippet* snippet = dict->getEntry(id);
+        SkASSERT(snippet && snippet->fName);
+        hash = SkChecksum::Hash32(snippet->fName, strlen(snippet->fName), hash);
+        hash = SkChecksum::Hash32(&snippet->fNumChildren, sizeof(snippet->fNumChildren), hash);
+    }
+    return hash;
+}
+
+bool make_render_pass(const Caps* caps, const RenderPassParams& params, RenderPassDesc* desc) {
+    TextureInfo info = caps->getDefaultSampledTextureInfo(params.fColorType,
+                                                          params.fMipmapped,
+                                                          params.fProtected,
+                                                          Renderable::kYes);
+    if (!info.isValid()) {
+        return false;
+    }
+    *desc = RenderPassDesc::Make(caps,
+                                 info,
+                                 params.fLoadOp,
+                                 StoreOp::kStore,
+                                 params.fDepthStencilFlags,
+                                 /* clearColor= */ { .0f, .0f, .0f, .0f },
+                                 params.fRequiresMSAA,
+                                 caps->getWriteSwizzle(params.fColorType, info));
+    return true;
+}
+
+// Finds the parameters that rebuild a render pass the pipeline compiles to the same key with.
+bool describe_render_pass(const Caps* caps,
+                          const GraphicsPipelineDesc& pipelineDesc,
+                          const RenderPassDesc& renderPassDesc,
+                          RenderPassParams* params) {
+    const TextureInfo& targetInfo = renderPassDesc.fColorResolveAttachment.fTextureInfo.isValid()
+                                            ? renderPassDesc.fColorResolveAttachment.fTextureInfo
+                                            : renderPassDesc.fColorAttachment.fTextureInfo;
+    const UniqueKey pipelineKey = caps->makeGraphicsPipelineKey(pipelineDesc, renderPassDesc);
+
+    const bool hasDepthStencil = renderPassDesc.fDepthStencilAttachment.fTextureInfo.isValid();
+    const SkEnumBitMask<DepthStencilFlags> noDepthStencil[] = {DepthStencilFlags::kNone};
+    const SkEnumBitMask<DepthStencilFlags> withDepthStencil[] = {DepthStencilFlags::kDepth,
+                                                                 DepthStencilFlags::kDepthStencil,
+                                                                 DepthStencilFlags::kStencil};
+    SkSpan<const SkEnumBitMask<DepthStencilFlags>> depthStencilFlags =
+            hasDepthStencil ? SkSpan<const SkEnumBitMask<DepthStencilFlags>>(withDepthStencil)
+                            : SkSpan<const SkEnumBitMask<DepthStencilFlags>>(noDepthStencil);
+
+    for (int ct = 0; ct < kSkColorTypeCnt; ++ct) {
+        const SkColorType colorType = static_cast<SkColorType>(ct);
+        // Cheaply rule out the color types whose textures differ before building any keys.
+        if (!(caps->getDefaultSampledTextureInfo(colorType,
+                                                 targetInfo.mipmapped(),
+                                                 targetInfo.isProtected(),
+                                                 Renderable::kYes) == targetInfo)) {
+            continue;
+        }
+        for (LoadOp loadOp : {LoadOp::kLoad, LoadOp::kClear, LoadOp::kDiscard}) {
+            for (SkEnumBitMask<DepthStencilFlags> flags : depthStencilFlags) {
+                RenderPassParams candidate = {colorType,
+                                              targetInfo.mipmapped(),
+                                              targetInfo.isProtected(),
+                                              loadOp,
+                                              flags,
+                                              renderPassDesc.fSampleCount > 1};
+                RenderPassDesc rebuilt;
+                if (make_render_pass(caps, candidate, &rebuilt) &&
+                    caps->makeGraphicsPipelineKey(pipelineDesc, rebuilt) == pipelineKey) {
+                    *params = candidate;
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+// Adds the node at data[*index] and its children to the builder. Returns false if the data doesn't
+// describe a tree of snippets this build knows about.
+bool add_node(ShaderCodeDictionary* dict,
+              SkSpan<const int32_t> data,
+              size_t* index,
+              PaintParamsKeyBuilder* builder) {
+    if (*index >= data.size()) {
+        return false;
+    }
+    const int32_t snippetID = data[(*index)++];
+    if (snippetID >= SkKnownRuntimeEffects::kUnknownRuntimeEffectIDStart) {
+        return false;
+    }
+    if (snippetID >= SkKnownRuntimeEffects::kSkiaKnownRuntimeEffectsStart &&
+        snippetID < SkKnownRuntimeEffects::kSkiaKnownRuntimeEffectsStart +
+                            SkKnownRuntimeEffects::kStableKeyCnt) {
+        if (snippetID == static_cast<int>(SkKnownRuntimeEffects::StableKey::kInvalid)) {
+            return false;
+        }
+        // The dictionary only adds the snippets of Skia's own runtime effects once they're used.
+        dict->findOrCreateRuntimeEffectSnippet(SkKnownRuntimeEffects::GetKnownRuntimeEffect(
+                static_cast<SkKnownRuntimeEffects::StableKey>(snippetID)));
+    }
+    const ShaderSnippet* snippet = dict->getEntry(snippetID);
+    if (!snippet) {
+        return false;
+    }
+    builder->beginBlock(snippetID);
+    for (int i = 0; i < snippet->fNumChildren; ++i) {
+        if (!add_node(dict, data, index, builder)) {
+            return false;
+        }
+    }
+    builder->endBlock();
+    return true;
+}
+
+} // anonymous namespace
+
+void PipelineUsageLog::record(const UniqueKey& pipelineKey,
+                              const GraphicsPipelineDesc& pipelineDesc,
+                              const RenderPassDesc& renderPassDesc) {
+    SkAutoMutexExclusive lock(fMutex);
+    if (fRecordedKeys.contains(pipelineKey)) {
+        return;
+    }
+    fRecordedKeys.add(pipelineKey);
+    fEntries.push_back({pipelineDesc, renderPassDesc});
+}
+
+sk_sp<SkData> PipelineUsageLog::serialize(const SharedContext* sharedContext) const {
+    const Caps* caps = sharedContext->caps();
+    const RendererProvider* rendererProvider = sharedContext->rendererProvider();
+    const ShaderCodeDictionary* dict = sharedContext->shaderCodeDictionary();
+
+    TArray<Entry> entries;
+    {
+        SkAutoMutexExclusive lock(fMutex);
+        entries = fEntries;
+    }
+
+    struct EncodedEntry {
+        const char* fRenderStepName;
+        PaintParamsKey fPaintKey;
+        RenderPassParams fRenderPass;
+    };
+    TArray<EncodedEntry> encoded;
+    int skipped = 0;
+    for (const Entry& entry : entries) {
+        const RenderStep* step = rendererProvider->lookup(entry.fPipelineDesc.renderStepID());
+        if (!step || rendererProvider->findRenderStep(step->name()) != step) {
+            ++skipped;
+            continue;
+        }
+
+        PaintParamsKey paintKey = dict->lookup(entry.fPipelineDesc.paintParamsID());
+        bool userDefined = false;
+        for (int32_t snippetID : paintKey.data()) {
+            userDefined |= snippetID >= SkKnownRuntimeEffects::kUnknownRuntimeEffectIDStart;
+        }
+
+        RenderPassParams renderPass;
+        if (userDefined ||
+            !describe_render_pass(caps, entry.fPipelineDesc, entry.fRenderPassDesc, &renderPass)) {
+            ++skipped;
+            continue;
+        }
+        encoded.push_back({step->name(), paintKey, renderPass});
+    }
+    if (skipped) {
+        SKGPU_LOG_D("PipelineUsageLog: %d of %d pipelines can't be serialized",
+                    skipped, entries.size());
+    }
+
+    SkBinaryWriteBuffer buffer({});
+    buffer.writeUInt(kMagic);
+    buffer.writeUInt(kVersion);
+    buffer.writeUInt(static_cast<uint32_t>(sharedContext->backend()));
+    buffer.writeUInt(snippet_table_hash(dict));
+    buffer.writeUInt(encoded.size());
+    for (const EncodedEntry& entry : encoded) {
+        buffer.writeString(entry.fRenderStepName);
+        SkSpan<const int32_t> paintKey = entry.fPaintKey.data();
+        buffer.writeUInt(paintKey.size());
+        for (int32_t snippetID : paintKey) {
+            buffer.writeInt(snippetID);
+        }
+        buffer.writeUInt(entry.fRenderPass.fColorType);
+        buffer.writeBool(entry.fRenderPass.fMipmapped == Mipmapped::kYes);
+        buffer.writeBool(entry.fRenderPass.fProtected == Protected::kYes);
+        buffer.writeUInt(static_cast<uint32_t>(entry.fRenderPass.fLoadOp));
+        buffer.writeUInt(entry.fRenderPass.fDepthStencilFlags.value());
+        buffer.writeBool(entry.fRenderPass.fRequiresMSAA);
+    }
+    return buffer.snapshotAsData();
+}
+
+int PipelineUsageLog::Precompile(Context* context, const SkData& data) {
+    const Caps* caps = context->priv().caps();
+    const RendererProvider* rendererProvider = context->priv().rendererProvider();
+    ShaderCodeDictionary* dict = context->priv().shaderCodeDictionary();
+    ResourceProvider* resourceProvider = context->priv().resourceProvider();
+
+    SkReadBuffer buffer(data.data(), data.size());
+    if (buffer.readUInt() != kMagic ||
+        buffer.readUInt() != kVersion ||
+        buffer.readUInt() != static_cast<uint32_t>(context->backend()) ||
+        buffer.readUInt() != snippet_table_hash(dict) ||
+        !buffer.isValid()) {
+        SKGPU_LOG_W("PipelineUsageLog: The data doesn't match this build of Skia or backend");
+        return 0;
+    }
+
+    auto rtEffectDict = std::make_unique<RuntimeEffectDictionary>();
+    TArray<std::pair<GraphicsPipelineDesc, RenderPassDesc>> pipelines;
+    const uint32_t count = buffer.readUInt();
+    for (uint32_t i = 0; i < count && buffer.isValid(); ++i) {
+        SkString stepName;
+        buffer.readString(&stepName);
+        const uint32_t paintKeySize = buffer.readUInt();
+        if (!buffer.validate(paintKeySize <= buffer.available() / sizeof(int32_t))) {
+            break;
+        }
+        TArray<int32_t> paintKey(paintKeySize);
+        for (uint32_t j = 0; j < paintKeySize; ++j) {
+            paintKey.push_back(buffer.readInt());
+        }
+        RenderPassParams renderPass;
+        renderPass.fColorType = buffer.read32LE(kLastEnum_SkColorType);
+        renderPass.fMipmapped = buffer.readBool() ? Mipmapped::kYes : Mipmapped::kNo;
+        renderPass.fProtected = buffer.readBool() ? Protected::kYes : Protected::kNo;
+        renderPass.fLoadOp = buffer.read32LE(LoadOp::kLast);
+        renderPass.fDepthStencilFlags = buffer.read32LE(DepthStencilFlags::kDepthStencil);
+        renderPass.fRequiresMSAA = buffer.readBool();
+        if (!buffer.isValid()) {
+            break;
+        }
+
+        const RenderStep* step = rendererProvider->findRenderStep(stepName.c_str());
+        if (!step || step->performsShading() == paintKey.empty()) {
+            continue;
+        }
+        UniquePaintParamsID paintID = UniquePaintParamsID::InvalidID();
+        if (!paintKey.empty()) {
+            // A key can have more than one root node.
+            PaintParamsKeyBuilder builder(dict);
+            SkSpan<const int32_t> snippetIDs(paintKey);
+            size_t index = 0;
+            bool valid = true;
+            while (valid && index < snippetIDs.size()) {
+                valid = add_node(dict, snippetIDs, &index, &builder);
+            }
+            if (!valid) {
+                continue;
+            }
+            paintID = dict->findOrCreate(&builder);
+        }
+        RenderPassDesc renderPassDesc;
+        if (!make_render_pass(caps, renderPass, &renderPassDesc)) {
+            continue;
+        }
+
+        GraphicsPipelineDesc pipelineDesc(step, paintID);
+        if (!resourceProvider->compileGraphicsPipelineAsync(rtEffectDict.get(),
+                                                            pipelineDesc,
+                                                            renderPassDesc)) {
+            resourceProvider->findOrCreateGraphicsPipeline(rtEffectDict.get(),
+                                                           pipelineDesc,
+                                                           renderPassDesc);
+        }
+        pipelines.push_back({pipelineDesc, renderPassDesc});
+    }
+    if (!buffer.isValid()) {
+        SKGPU_LOG_W("PipelineUsageLog: The data is malformed");
+    }
+
+    if (PipelineCompiler* compiler = context->priv().pipelineCompiler()) {
+        compiler->wait();
+    }
+    int compiled = 0;
+    for (const auto& [pipelineDesc, renderPassDesc] : pipelines) {
+        compiled += SkToBool(resourceProvider->findGraphicsPipeline(pipelineDesc, renderPassDesc));
+    }
+    return compiled;
+}
+
+} // namespace skgpu::graphite
@@ -0,0 +1,71 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef skgpu_graphite_PipelineUsageLog_DEFINED
+#define skgpu_graphite_PipelineUsageLog_DEFINED
+
+#include "include/core/SkRefCnt.h"
+#include "include/private/base/SkMutex.h"
+#include "include/private/base/SkTArray.h"
+#include "include/private/base/SkThreadAnnotations.h"
+#include "src/core/SkTHash.h"
+#include "src/gpu/ResourceKey.h"
+#include "src/gpu/graphite/GraphicsPipelineDesc.h"
+#include "src/gpu/graphite/RenderPassDesc.h"
+
+class SkData;
+
+namespace skgpu::graphite {
+
+class Context;
+class SharedContext;
+
+/**
+ * The pipelines a Context compiled, kept when it was made with
+ * ContextOptions::fRecordPipelineUsage so that a later run can compile them up front.
+ *
+ * UniquePaintParamsIDs and RenderStep IDs only mean something within one process, so serialize()
+ * writes each pipeline out as the code-snippet IDs of its paint key, the name of its RenderStep,
+ * and the parameters RenderPassDesc::Make() rebuilds its render pass from. Pipelines that can't be
+ * rebuilt that way are left out: those whose paint uses a user-defined runtime effect, and those
+ * drawn to targets whose texture isn't the default one for some color type (such as wrapped
+ * client textures with unusual usages).
+ */
+class PipelineUsageLog {
+public:
+    // Notes a pipeline that was just compiled. Thread safe.
+    void record(const UniqueKey& pipelineKey,
+                const GraphicsPipelineDesc&,
+                const RenderPassDesc&) SK_EXCLUDES(fMutex);
+
+    // Encodes the pipelines recorded so far.
+    sk_sp<SkData> serialize(const SharedContext*) const SK_EXCLUDES(fMutex);
+
+    // Compiles the pipelines in data from serialize(). Entries that don't match the Context, e.g.
+    // because they were written by a different version of Skia or for another backend, are
+    // skipped. Returns the number of pipelines compiled.
+    static int Precompile(Context*, const SkData&);
+
+private:
+    struct Entry {
+        GraphicsPipelineDesc fPipelineDesc;
+        RenderPassDesc fRenderPassDesc;
+    };
+
+    struct UniqueKeyHash {
+        uint32_t operator()(const UniqueKey& key) const { return key.hash(); }
+    };
+
+    mutable SkMutex fMutex;
+    // A pipeline can be compiled more than once, e.g. if the GlobalCache evicted it.
+    skia_private::THashSet<UniqueKey, UniqueKeyHash> fRecordedKeys SK_GUARDED_BY(fMutex);
+    skia_private::TArray<Entry> fEntries SK_GUARDED_BY(fMutex);
+};
+
+} // namespace skgpu::graphite
+
+#endif // skgpu_graphite_PipelineUsageLog_DEFINED
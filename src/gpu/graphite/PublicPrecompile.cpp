@@ -17,6 +17,7 @@
 #include "src/gpu/graphite/KeyContext.h"
 #include "src/gpu/graphite/Log.h"
 #include "src/gpu/graphite/PaintOptionsPriv.h"
+#include "src/gpu/graphite/PipelineCompiler.h"
 #include "src/gpu/graphite/RenderPassDesc.h"
 #include "src/gpu/graphite/Renderer.h"
 #include "src/gpu/graphite/RendererProvider.h"
@@ -61,6 +62,12 @@ void compile(const RendererProvider* rendererProvider,
             GraphicsPipelineDesc pipelineDesc(s, paintID);
 
             for (const RenderPassDesc& renderPassDesc : renderPassDescs) {
+                if (resourceProvider->compileGraphicsPipelineAsync(keyContext.rtEffectDict(),
+                                                                   pipelineDesc,
+                                                                   renderPassDesc)) {
+                    // Precompile() waits for it before returning.
+                    continue;
+                }
                 sk_sp<GraphicsPipeline> pipeline = resourceProvider->findOrCreateGraphicsPipeline(
                         keyContext.rtEffectDict(),
                         pipelineDesc,
@@ -126,6 +133,12 @@ void Precompile(Context* context, const PaintOptions& options, DrawTypeFlags dra
             }
         }
     }
+
+    // Any pipelines handed off to the compilation executor above compile in parallel; they must
+    // all be done when we return.
+    if (PipelineCompiler* compiler = context->priv().pipelineCompiler()) {
+        compiler->wait();
+    }
 }
 
 void PrecompileCombinations(Context* context,
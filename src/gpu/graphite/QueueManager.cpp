@@ -8,7 +8,9 @@
 #include "src/gpu/graphite/QueueManager.h"
 
 #include "include/gpu/graphite/Recording.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/core/SkTraceEvent.h"
+#include "src/gpu/GpuTypesPriv.h"
 #include "src/gpu/RefCntedCallback.h"
 #include "src/gpu/graphite/Buffer.h"
 #include "src/gpu/graphite/Caps.h"
@@ -21,8 +23,28 @@
 #include "src/gpu/graphite/UploadBufferManager.h"
 #include "src/gpu/graphite/task/Task.h"
 
+#include <chrono>
+#include <memory>
+
 namespace skgpu::graphite {
 
+namespace {
+
+// Keeps the RecordingStats of a Recording inserted with a GpuFinishedWithStatsProc until the proc
+// is called, which is when its RefCntedCallback is deleted.
+struct StatsCallbackContext {
+    GpuFinishedWithStatsProc fProc;
+    GpuFinishedContext fContext;
+    RecordingStats fStats;
+};
+
+void call_stats_proc(GpuFinishedContext context, CallbackResult result) {
+    std::unique_ptr<StatsCallbackContext> statsContext(static_cast<StatsCallbackContext*>(context));
+    statsContext->fProc(statsContext->fContext, result, statsContext->fStats);
+}
+
+}  // anonymous namespace
+
 // This constant determines how many OutstandingSubmissions are allocated together as a block in
 // the deque. As such it needs to balance allocating too much memory vs. incurring
 // allocation/deallocation thrashing. It should roughly correspond to the max number of outstanding
@@ -35,6 +57,8 @@ QueueManager::QueueManager(const SharedContext* sharedContext)
 }
 
 QueueManager::~QueueManager() {
+    // The backend QueueManager already had to finish the submission tasks.
+    SkASSERT(!fSubmissionTasks || !this->hasUnfinishedGpuWork());
     if (fSharedContext->caps()->allowCpuSync()) {
         this->checkForFinishedWork(SyncToCpu::kYes);
     } else if (!fOutstandingSubmissions.empty()) {
@@ -45,13 +69,16 @@ QueueManager::~QueueManager() {
 
 bool QueueManager::setupCommandBuffer(ResourceProvider* resourceProvider) {
     if (!fCurrentCommandBuffer) {
-        if (fAvailableCommandBuffers.size()) {
-            fCurrentCommandBuffer = std::move(fAvailableCommandBuffers.back());
-            fAvailableCommandBuffers.pop_back();
-            if (!fCurrentCommandBuffer->setNewCommandBufferResources()) {
-                fCurrentCommandBuffer.reset();
+        {
+            SkAutoMutexExclusive lock(fAvailableMutex);
+            if (fAvailableCommandBuffers.size()) {
+                fCurrentCommandBuffer = std::move(fAvailableCommandBuffers.back());
+                fAvailableCommandBuffers.pop_back();
             }
         }
+        if (fCurrentCommandBuffer && !fCurrentCommandBuffer->setNewCommandBufferResources()) {
+            fCurrentCommandBuffer.reset();
+        }
     }
     if (!fCurrentCommandBuffer) {
         fCurrentCommandBuffer = this->getNewCommandBuffer(resourceProvider);
@@ -65,9 +92,17 @@ bool QueueManager::setupCommandBuffer(ResourceProvider* resourceProvider) {
 
 bool QueueManager::addRecording(const InsertRecordingInfo& info, Context* context) {
     TRACE_EVENT0("skia.gpu", TRACE_FUNC);
+    const skgpu::StdSteadyClock::time_point insertStart = skgpu::StdSteadyClock::now();
 
     sk_sp<RefCntedCallback> callback;
-    if (info.fFinishedProc) {
+    RecordingStats* stats = nullptr;
+    if (info.fFinishedWithStatsProc) {
+        auto statsContext = new StatsCallbackContext{info.fFinishedWithStatsProc,
+                                                     info.fFinishedContext,
+                                                     {}};
+        stats = &statsContext->fStats;
+        callback = RefCntedCallback::Make(call_stats_proc, statsContext);
+    } else if (info.fFinishedProc) {
         callback = RefCntedCallback::Make(info.fFinishedProc, info.fFinishedContext);
     }
 
@@ -79,6 +114,9 @@ bool QueueManager::addRecording(const InsertRecordingInfo& info, Context* contex
         SKGPU_LOG_E("No valid Recording passed into addRecording call");
         return false;
     }
+    if (stats) {
+        *stats = info.fRecording->priv().stats();
+    }
 
     if (this->fSharedContext->caps()->requireOrderedRecordings()) {
         uint32_t* recordingID = fLastAddedRecordingIDs.find(info.fRecording->priv().recorderID());
@@ -139,6 +177,10 @@ bool QueueManager::addRecording(const InsertRecordingInfo& info, Context* contex
         }
     }
 
+    // The timer has to start before the Recording's commands, but the stats are only handed to the
+    // command buffer along with the callback that keeps them alive.
+    const bool timeGpu = stats && fCurrentCommandBuffer->startGpuTimer();
+
     fCurrentCommandBuffer->addWaitSemaphores(info.fNumWaitSemaphores, info.fWaitSemaphores);
     if (!info.fRecording->priv().addCommands(context,
                                              fCurrentCommandBuffer.get(),
@@ -158,12 +200,19 @@ bool QueueManager::addRecording(const InsertRecordingInfo& info, Context* contex
                                                             info.fTargetTextureState);
     }
 
+    info.fRecording->priv().deinstantiateVolatileLazyProxies();
+
+    if (stats) {
+        stats->fInsertCpuTimeNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                skgpu::StdSteadyClock::now() - insertStart).count();
+        if (timeGpu) {
+            fCurrentCommandBuffer->addGpuTimedStats(stats);
+        }
+    }
     if (callback) {
         fCurrentCommandBuffer->addFinishedProc(std::move(callback));
     }
 
-    info.fRecording->priv().deinstantiateVolatileLazyProxies();
-
     return true;
 }
 
@@ -229,20 +278,88 @@ bool QueueManager::submitToGpu() {
     }
 #endif
 
-    auto submission = this->onSubmitToGpu();
+    // The queue submit always happens on the calling thread so it stays ordered with the client's
+    // own use of the queue; only waiting for the submission to finish moves to the executor.
+    auto submission = this->onSubmitToGpu(std::move(fCurrentCommandBuffer));
     if (!submission) {
         return false;
     }
 
+    if (fSubmissionTasks) {
+        SkAutoMutexExclusive lock(fSubmissionMutex);
+        new (fOutstandingSubmissions.push_back()) OutstandingSubmission(std::move(submission));
+        if (!fWaiting) {
+            fWaiting = true;
+            fSubmissionTasks->add([this] { this->waitForOutstandingSubmissions(); });
+        }
+        return true;
+    }
+
     new (fOutstandingSubmissions.push_back()) OutstandingSubmission(std::move(submission));
     return true;
 }
 
-bool QueueManager::hasUnfinishedGpuWork() { return !fOutstandingSubmissions.empty(); }
+void QueueManager::setSubmissionExecutor(SkExecutor* executor) {
+    SkASSERT(fOutstandingSubmissions.empty() && !fSubmissionTasks);
+    // The wait task blocks until each submission finishes.
+    SkASSERT(fSharedContext->caps()->allowCpuSync());
+    fSubmissionTasks = std::make_unique<SkTaskGroup>(*executor);
+}
+
+void QueueManager::finishSubmissionTasks() {
+    if (fSubmissionTasks) {
+        fSubmissionTasks->wait();
+    }
+}
+
+void QueueManager::waitForOutstandingSubmissions() {
+    TRACE_EVENT0("skia.gpu", TRACE_FUNC);
+    while (true) {
+        OutstandingSubmission* front;
+        {
+            SkAutoMutexExclusive lock(fSubmissionMutex);
+            front = (OutstandingSubmission*)fOutstandingSubmissions.front();
+            if (!front) {
+                fWaiting = false;
+                return;
+            }
+        }
+
+        // Only this task removes submissions, and adding them doesn't move the existing ones, so
+        // the front can be waited on without holding the lock.
+        (*front)->waitUntilFinished(fSharedContext);
+
+        OutstandingSubmission finished;
+        {
+            SkAutoMutexExclusive lock(fSubmissionMutex);
+            finished = std::move(*front);
+            fOutstandingSubmissions.pop_front();
+            front->~OutstandingSubmission();
+        }
+        // Calls the finished procs and returns the CommandBuffer outside of the lock.
+        finished.reset();
+    }
+}
+
+bool QueueManager::hasUnfinishedGpuWork() {
+    if (fSubmissionTasks) {
+        SkAutoMutexExclusive lock(fSubmissionMutex);
+        return fWaiting;
+    }
+    return !fOutstandingSubmissions.empty();
+}
 
 void QueueManager::checkForFinishedWork(SyncToCpu sync) {
     TRACE_EVENT1("skia.gpu", TRACE_FUNC, "sync", sync == SyncToCpu::kYes);
 
+    if (fSubmissionTasks) {
+        // The submission tasks handle finished work as soon as it finishes.
+        if (sync == SyncToCpu::kYes) {
+            fSubmissionTasks->wait();
+        }
+        return;
+    }
+
     if (sync == SyncToCpu::kYes) {
         SkASSERT(fSharedContext->caps()->allowCpuSync());
         // wait for the last submission to finish
@@ -270,6 +387,7 @@ void QueueManager::checkForFinishedWork(SyncToCpu sync) {
 }
 
 void QueueManager::returnCommandBuffer(std::unique_ptr<CommandBuffer> commandBuffer) {
+    SkAutoMutexExclusive lock(fAvailableMutex);
     fAvailableCommandBuffers.push_back(std::move(commandBuffer));
 }
 
@@ -11,12 +11,16 @@
 #include "include/core/SkRefCnt.h"
 #include "include/gpu/graphite/GraphiteTypes.h"
 #include "include/private/base/SkDeque.h"
+#include "include/private/base/SkMutex.h"
 #include "include/private/base/SkTArray.h"
 #include "src/core/SkTHash.h"
 
 #include <memory>
 #include <vector>
 
+class SkExecutor;
+class SkTaskGroup;
+
 namespace skgpu::graphite {
 
 class Buffer;
@@ -48,6 +52,14 @@ public:
     [[nodiscard]] bool hasUnfinishedGpuWork();
     void checkForFinishedWork(SyncToCpu);
 
+    // Has a task on 'executor' wait for each submission to finish and call its finished procs;
+    // submitToGpu() still submits on the calling thread. See ContextOptions::fSubmissionExecutor.
+    // Must be called before anything is submitted.
+    void setSubmissionExecutor(SkExecutor* executor);
+    // Waits for the submission task to see every submission finish. Must be called before the
+    // backend QueueManager is destroyed, since finishing a submission returns its CommandBuffer.
+    void finishSubmissionTasks();
+
 #if defined(GRAPHITE_TEST_UTILS)
     virtual void startCapture() {}
     virtual void stopCapture() {}
@@ -69,13 +81,27 @@ protected:
 
 private:
     virtual std::unique_ptr<CommandBuffer> getNewCommandBuffer(ResourceProvider*) = 0;
-    virtual OutstandingSubmission onSubmitToGpu() = 0;
+    virtual OutstandingSubmission onSubmitToGpu(std::unique_ptr<CommandBuffer>) = 0;
 
     bool setupCommandBuffer(ResourceProvider*);
 
+    // The submission task, which waits for the outstanding submissions to finish in order. It only
+    // runs while there are outstanding submissions.
+    void waitForOutstandingSubmissions();
+
+    // Only set with a submission executor.
+    std::unique_ptr<SkTaskGroup> fSubmissionTasks;
+
+    // Guards fOutstandingSubmissions and the submission task's state when there's an executor.
+    SkMutex fSubmissionMutex;
+    bool fWaiting SK_GUARDED_BY(fSubmissionMutex) = false;
+
     SkDeque fOutstandingSubmissions;
 
-    std::vector<std::unique_ptr<CommandBuffer>> fAvailableCommandBuffers;
+    // Command buffers are returned by the submission task when there is an executor.
+    SkMutex fAvailableMutex;
+    std::vector<std::unique_ptr<CommandBuffer>> fAvailableCommandBuffers
+            SK_GUARDED_BY(fAvailableMutex);
 
     skia_private::THashMap<uint32_t, uint32_t> fLastAddedRecordingIDs;
 };
@@ -34,6 +34,12 @@ public:
         fUncachedAtlasMgr.postFlush(fRecorder);
     }
 
+    void addToMemoryReport(GpuMemoryReport* report) const {
+        fCachedAtlasMgr.addToMemoryReport("raster_path_cached", report);
+        fSmallPathAtlasMgr.addToMemoryReport("raster_path_small", report);
+        fUncachedAtlasMgr.addToMemoryReport("raster_path_uncached", report);
+    }
+
 protected:
     const TextureProxy* onAddShape(const Shape&,
                                    const Transform& transform,
@@ -10,8 +10,10 @@
 #include "include/core/SkBitmap.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColorSpace.h"
+#include "include/core/SkString.h"
 #include "include/core/SkTraceMemoryDump.h"
 #include "include/effects/SkRuntimeEffect.h"
+#include "include/gpu/GpuMemoryReport.h"
 #include "include/gpu/graphite/BackendTexture.h"
 #include "include/gpu/graphite/GraphiteTypes.h"
 #include "include/gpu/graphite/ImageProvider.h"
@@ -22,6 +24,7 @@
 #include "src/core/SkTraceEvent.h"
 #include "src/gpu/AtlasTypes.h"
 #include "src/gpu/DataUtils.h"
+#include "src/gpu/GpuTypesPriv.h"
 #include "src/gpu/RefCntedCallback.h"
 #include "src/gpu/graphite/AtlasProvider.h"
 #include "src/gpu/graphite/BufferManager.h"
@@ -29,8 +32,10 @@
 #include "src/gpu/graphite/CommandBuffer.h"
 #include "src/gpu/graphite/ContextPriv.h"
 #include "src/gpu/graphite/Device.h"
+#include "src/gpu/graphite/DrawPass.h"
 #include "src/gpu/graphite/GlobalCache.h"
 #include "src/gpu/graphite/Log.h"
+#include "src/gpu/graphite/PatchableUniforms.h"
 #include "src/gpu/graphite/PathAtlas.h"
 #include "src/gpu/graphite/PipelineData.h"
 #include "src/gpu/graphite/PipelineDataCache.h"
@@ -42,8 +47,10 @@
 #include "src/gpu/graphite/RuntimeEffectDictionary.h"
 #include "src/gpu/graphite/ScratchResourceManager.h"
 #include "src/gpu/graphite/SharedContext.h"
+#include "src/gpu/graphite/StaticUniformArena.h"
 #include "src/gpu/graphite/Texture.h"
 #include "src/gpu/graphite/UploadBufferManager.h"
+#include "src/gpu/graphite/render/TessellatedPathCache.h"
 #include "src/gpu/graphite/task/CopyTask.h"
 #include "src/gpu/graphite/task/TaskList.h"
 #include "src/gpu/graphite/task/UploadTask.h"
@@ -123,10 +130,24 @@ Recorder::Recorder(sk_sp<SharedContext> sharedContext,
         fResourceProvider = fOwnedResourceProvider.get();
     }
     fUploadBufferManager = std::make_unique<UploadBufferManager>(fResourceProvider,
-                                                                 fSharedContext->caps());
+                                                                 fSharedContext->caps(),
+                                                                 options.fUploadExecutor);
     fDrawBufferManager = std::make_unique<DrawBufferManager>(fResourceProvider,
                                                              fSharedContext->caps(),
                                                              fUploadBufferManager.get());
+    fTessellatedPathCache = std::make_unique<TessellatedPathCache>();
+    if (options.fDrawPassExecutor) {
+        fPendingDrawPasses = std::make_unique<PendingDrawPasses>(options.fDrawPassExecutor);
+    }
+    if (options.fPatchableRuntimeEffectUniforms) {
+        fPatchableUniformTracker = std::make_unique<PatchableUniformTracker>();
+    } else if (options.fStaticUniformArenaBytes) {
+        const Caps* caps = fSharedContext->caps();
+        if (caps->drawBufferCanBeMapped() && !caps->storageBufferPreferred()) {
+            fStaticUniformArena = std::make_unique<StaticUniformArena>(
+                    fResourceProvider, caps, options.fStaticUniformArenaBytes);
+        }
+    }
 
     SkASSERT(fResourceProvider);
 }
@@ -152,6 +173,8 @@ Recorder::~Recorder() {
 
     // TODO: needed?
     fStrikeCache->freeAll();
+
+    fAtlasProvider->textAtlasManager()->releasePlotPins(this);
 }
 
 BackendApi Recorder::backend() const { return fSharedContext->backend(); }
@@ -159,6 +182,7 @@ BackendApi Recorder::backend() const { return fSharedContext->backend(); }
 std::unique_ptr<Recording> Recorder::snap() {
     TRACE_EVENT0("skia.gpu", TRACE_FUNC);
     ASSERT_SINGLE_OWNER
+    const skgpu::StdSteadyClock::time_point snapStart = skgpu::StdSteadyClock::now();
     this->priv().flushTrackedDevices();
 
     std::unordered_set<sk_sp<TextureProxy>, Recording::ProxyHash> nonVolatileLazyProxies;
@@ -203,8 +227,13 @@ std::unique_ptr<Recording> Recorder::snap() {
                                                                  fUploadBufferManager.get());
         fTextureDataCache = std::make_unique<TextureDataCache>();
         fUniformDataCache = std::make_unique<UniformDataCache>();
+        if (fPatchableUniformTracker) {
+            fPatchableUniformTracker->reset();
+        }
         fRootTaskList->reset();
         fRuntimeEffectDict->reset();
+        fPendingRecordingStats = {};
+        fPipelinesCompiledBeforeSnap = fResourceProvider->numGraphicsPipelinesCompiled();
         return nullptr;
     }
 
@@ -215,20 +244,49 @@ std::unique_ptr<Recording> Recorder::snap() {
                                                        std::move(targetProxyData),
                                                        std::move(fFinishedProcs)));
 
+    // The plots of a shared glyph atlas that this Recording reads stay pinned while it can still
+    // be inserted or the GPU is using it.
+    TextAtlasManager* textAtlasManager = fAtlasProvider->textAtlasManager();
+    if (textAtlasManager->isShared()) {
+        recording->priv().setGlyphAtlasPins(textAtlasManager->takePlotPins(this));
+    }
+
+    // The buffer managers start counting again for the next Recording when it is transferred.
+    RecordingStats stats = std::exchange(fPendingRecordingStats, {});
+    stats.fBufferBytesWritten = fDrawBufferManager->bytesWritten();
+    stats.fBufferAllocations = fDrawBufferManager->bufferAllocations();
+    stats.fBufferAlignmentBytes = fDrawBufferManager->alignmentBytes();
+    stats.fBufferUnusedBytes = fDrawBufferManager->unusedBytes();
+    stats.fUploadBytes = fUploadBufferManager->textureBytesWritten();
+    const int pipelinesCompiled = fResourceProvider->numGraphicsPipelinesCompiled();
+    stats.fPipelinesCompiled = pipelinesCompiled - fPipelinesCompiledBeforeSnap;
+    fPipelinesCompiledBeforeSnap = pipelinesCompiled;
+
     // Allow the buffer managers to add any collected tasks for data transfer or initialization
     // before moving the root task list to the Recording.
     fDrawBufferManager->transferToRecording(recording.get());
     fUploadBufferManager->transferToRecording(recording.get());
+    if (fStaticUniformArena) {
+        fStaticUniformArena->transferToRecording(recording.get());
+    }
     recording->priv().addTasks(std::move(*fRootTaskList));
+    if (fPatchableUniformTracker) {
+        recording->priv().setPatchableUniforms(fPatchableUniformTracker->detach());
+    }
 
     SkASSERT(!fRootTaskList->hasTasks());
     fRuntimeEffectDict->reset();
     fTextureDataCache = std::make_unique<TextureDataCache>();
     fUniformDataCache = std::make_unique<UniformDataCache>();
-    if (!this->priv().caps()->requireOrderedRecordings()) {
-        fAtlasProvider->textAtlasManager()->evictAtlases();
+    // A shared atlas keeps its contents, since the Context uploads them ahead of each Recording.
+    if (!this->priv().caps()->requireOrderedRecordings() && !textAtlasManager->isShared()) {
+        textAtlasManager->evictAtlases();
     }
 
+    stats.fSnapCpuTimeNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            skgpu::StdSteadyClock::now() - snapStart).count();
+    recording->priv().setStats(stats);
+
     return recording;
 }
 
@@ -450,6 +508,11 @@ void Recorder::freeGpuResources() {
     // them.
     fAtlasProvider->clearTexturePool();
 
+    // The arena's buffers are only dropped between Recordings, since pending passes bind them.
+    if (fStaticUniformArena) {
+        fStaticUniformArena->reset();
+    }
+
     fResourceProvider->freeGpuResources();
 }
 
@@ -475,6 +538,18 @@ void Recorder::dumpMemoryStatistics(SkTraceMemoryDump* traceMemoryDump) const {
     fResourceProvider->dumpMemoryStatistics(traceMemoryDump);
     // TODO: What is the graphite equivalent for the text blob cache and how do we print out its
     // used bytes here (see Ganesh implementation).
+
+    skgpu::GpuMemoryReport report;
+    this->getMemoryReport(&report);
+    SkString name = SkStringPrintf("skia/gpu_memory_report/recorder_%u", fUniqueID);
+    report.dumpMemoryStatistics(traceMemoryDump, name.c_str());
+}
+
+void Recorder::getMemoryReport(skgpu::GpuMemoryReport* report) const {
+    ASSERT_SINGLE_OWNER
+    *report = {};
+    fResourceProvider->addToMemoryReport(report);
+    fAtlasProvider->addToMemoryReport(report);
 }
 
 void RecorderPriv::addPendingRead(const TextureProxy* proxy) {
@@ -515,6 +590,13 @@ void RecorderPriv::flushTrackedDevices() {
         }
     }
 
+    // Write the commands of the passes made above before the flush token is issued, since their
+    // vertices can refer to atlas entries that may be replaced after it. A re-entrant call also
+    // writes the passes the outer call made so far, which keeps them in order.
+    if (fRecorder->fPendingDrawPasses) {
+        fRecorder->fPendingDrawPasses->finish(fRecorder->fDrawBufferManager.get());
+    }
+
     // Issue next upload flush token. This is only used by the atlasing code which
     // always uses this method. Calling in Device::flushPendingWorkToRecorder may
     // miss parent device flushes, increment too often, and lead to atlas corruption.
@@ -57,6 +57,11 @@ public:
     TextureDataCache* textureDataCache() { return fRecorder->fTextureDataCache.get(); }
     DrawBufferManager* drawBufferManager() { return fRecorder->fDrawBufferManager.get(); }
     UploadBufferManager* uploadBufferManager() { return fRecorder->fUploadBufferManager.get(); }
+    // Non-null only while tracked devices are being flushed with a draw pass executor.
+    PendingDrawPasses* pendingDrawPasses() {
+        return fRecorder->fFlushingDevicesIndex >= 0 ? fRecorder->fPendingDrawPasses.get()
+                                                     : nullptr;
+    }
 
     AtlasProvider* atlasProvider() { return fRecorder->fAtlasProvider.get(); }
     TokenTracker* tokenTracker() { return fRecorder->fTokenTracker.get(); }
@@ -66,6 +71,21 @@ public:
     }
     ProxyCache* proxyCache() { return this->resourceProvider()->proxyCache(); }
 
+    RecordingStats* pendingRecordingStats() { return &fRecorder->fPendingRecordingStats; }
+
+    // Null unless the Recorder was made with RecorderOptions::fPatchableRuntimeEffectUniforms.
+    PatchableUniformTracker* patchableUniformTracker() {
+        return fRecorder->fPatchableUniformTracker.get();
+    }
+
+    // Null unless the Recorder was made with RecorderOptions::fStaticUniformArenaBytes, and the
+    // backend supports it.
+    StaticUniformArena* staticUniformArena() { return fRecorder->fStaticUniformArena.get(); }
+
+    TessellatedPathCache* tessellatedPathCache() {
+        return fRecorder->fTessellatedPathCache.get();
+    }
+
     // NOTE: Temporary access for DrawTask to manipulate pending read counts.
     void addPendingRead(const TextureProxy*);
 
@@ -81,10 +101,11 @@ public:
 
     size_t getResourceCacheLimit() const;
 
+    SharedContext* sharedContext() { return fRecorder->fSharedContext.get(); }
+
 #if defined(GRAPHITE_TEST_UTILS)
     bool deviceIsRegistered(Device*) const;
     ResourceCache* resourceCache() { return fRecorder->fResourceProvider->resourceCache(); }
-    SharedContext* sharedContext() { return fRecorder->fSharedContext.get(); }
     // used by the Context that created this Recorder to set a back pointer
     void setContext(Context*);
     Context* context() { return fRecorder->fContext; }
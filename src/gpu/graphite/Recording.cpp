@@ -7,17 +7,22 @@
 
 #include "include/gpu/graphite/Recording.h"
 
+#include "include/effects/SkRuntimeEffect.h"
 #include "src/core/SkChecksum.h"
+#include "src/core/SkTraceEvent.h"
 #include "src/gpu/RefCntedCallback.h"
+#include "src/gpu/graphite/Buffer.h"
 #include "src/gpu/graphite/CommandBuffer.h"
 #include "src/gpu/graphite/ContextPriv.h"
 #include "src/gpu/graphite/Log.h"
+#include "src/gpu/graphite/PatchableUniforms.h"
 #include "src/gpu/graphite/RecordingPriv.h"
 #include "src/gpu/graphite/Resource.h"
 #include "src/gpu/graphite/ResourceProvider.h"
 #include "src/gpu/graphite/Surface_Graphite.h"
 #include "src/gpu/graphite/Texture.h"
 #include "src/gpu/graphite/TextureProxy.h"
+#include "src/gpu/graphite/UploadBufferManager.h"
 #include "src/gpu/graphite/task/TaskList.h"
 
 #include <unordered_set>
@@ -41,10 +46,26 @@ Recording::Recording(uint32_t uniqueID,
         , fFinishedProcs(std::move(finishedProcs)) {}
 
 Recording::~Recording() {
+    // The upload buffers can't be released while they're being written.
+    this->priv().finishPendingUploadWrites();
     // Any finished procs that haven't been passed to a CommandBuffer fail
     this->priv().setFailureResultForFinishedProcs();
 }
 
+bool Recording::setRuntimeEffectUniform(const SkRuntimeEffect* effect,
+                                        std::string_view name,
+                                        SkSpan<const std::byte> data) {
+    if (!fPatchableUniforms || !effect) {
+        return false;
+    }
+    const SkRuntimeEffect::Uniform* uniform = effect->findUniform(name);
+    if (!uniform || uniform->sizeInBytes() != data.size()) {
+        return false;
+    }
+    const int index = SkToInt(uniform - effect->uniforms().data());
+    return fPatchableUniforms->set(effect, index, data.data());
+}
+
 std::size_t Recording::ProxyHash::operator()(const sk_sp<TextureProxy> &proxy) const {
     return SkGoodHash()(proxy.get());
 }
@@ -128,6 +149,8 @@ bool RecordingPriv::addCommands(Context* context,
     AutoDeinstantiateTextureProxy autoDeinstantiateTargetProxy(
             fRecording->fTargetProxyData ? fRecording->fTargetProxyData->lazyProxy() : nullptr);
 
+    this->finishPendingUploadWrites();
+
     const Texture* replayTarget = nullptr;
     ResourceProvider* resourceProvider = context->priv().resourceProvider();
     SkASSERT(!SkToBool(fRecording->fTargetProxyData) || SkToBool(targetSurface));
@@ -153,25 +176,67 @@ bool RecordingPriv::addCommands(Context* context,
         commandBuffer->trackResource(fRecording->fExtraResourceRefs[i]);
     }
 
+    if (fRecording->fPatchableUniforms &&
+        !fRecording->fPatchableUniforms->prepareForInsert(
+                resourceProvider, context->priv().caps(), commandBuffer)) {
+        SKGPU_LOG_E("Could not upload patched uniforms.");
+        commandBuffer->clearUniformBufferRemaps();
+        return false;
+    }
+
     // There's no need to differentiate kSuccess and kDiscard at the root list level; if every task
     // is discarded, the Recording will automatically be a no-op on replay while still correctly
     // notifying any finish procs the client may have added.
-    if (fRecording->fRootTaskList->addCommands(
-                context, commandBuffer, {replayTarget, targetTranslation}) == Task::Status::kFail) {
+    const Task::Status status = fRecording->fRootTaskList->addCommands(
+            context, commandBuffer, {replayTarget, targetTranslation});
+    commandBuffer->clearUniformBufferRemaps();
+    if (status == Task::Status::kFail) {
         return false;
     }
     for (int i = 0; i < fRecording->fFinishedProcs.size(); ++i) {
         commandBuffer->addFinishedProc(std::move(fRecording->fFinishedProcs[i]));
     }
     fRecording->fFinishedProcs.clear();
+    if (fRecording->fGlyphAtlasPins) {
+        commandBuffer->addFinishedProc(fRecording->fGlyphAtlasPins);
+    }
 
     return true;
 }
 
+void RecordingPriv::setGlyphAtlasPins(sk_sp<RefCntedCallback> pins) {
+    fRecording->fGlyphAtlasPins = std::move(pins);
+}
+
+void RecordingPriv::setPatchableUniforms(std::unique_ptr<PatchableUniforms> patchableUniforms) {
+    fRecording->fPatchableUniforms = std::move(patchableUniforms);
+}
+
 void RecordingPriv::addResourceRef(sk_sp<Resource> resource) {
     fRecording->fExtraResourceRefs.push_back(std::move(resource));
 }
 
+void RecordingPriv::setPendingUploadWrites(sk_sp<PendingUploadWrites> writes,
+                                           std::vector<sk_sp<Buffer>> buffers) {
+    SkASSERT(!fRecording->fPendingUploadWrites);
+    fRecording->fPendingUploadWrites = std::move(writes);
+    fRecording->fMappedUploadBuffers = std::move(buffers);
+}
+
+void RecordingPriv::finishPendingUploadWrites() {
+    if (!fRecording->fPendingUploadWrites) {
+        return;
+    }
+    TRACE_EVENT0("skia.gpu", TRACE_FUNC);
+    fRecording->fPendingUploadWrites->wait();
+    fRecording->fPendingUploadWrites.reset();
+    for (sk_sp<Buffer>& buffer : fRecording->fMappedUploadBuffers) {
+        buffer->unmap();
+        fRecording->fExtraResourceRefs.push_back(std::move(buffer));
+    }
+    fRecording->fMappedUploadBuffers.clear();
+}
+
 void RecordingPriv::addTask(sk_sp<Task> task) {
     fRecording->fRootTaskList->add(std::move(task));
 }
@@ -33,12 +33,22 @@ public:
     // Textures or GPU only Buffers as well, we should keep a second list for Refs that we want to
     // put CommandBuffer refs on.
     void addResourceRef(sk_sp<Resource> resource);
+    // The Recording waits for 'writes' and unmaps 'buffers' when its commands are first added.
+    void setPendingUploadWrites(sk_sp<PendingUploadWrites> writes,
+                                std::vector<sk_sp<Buffer>> buffers);
+    void finishPendingUploadWrites();
     void addTask(sk_sp<Task> task);
     void addTasks(TaskList&& tasks);
 
     uint32_t recorderID() const { return fRecording->fRecorderID; }
     uint32_t uniqueID() const { return fRecording->fUniqueID; }
 
+    const RecordingStats& stats() const { return fRecording->fStats; }
+    void setStats(const RecordingStats& stats) { fRecording->fStats = stats; }
+
+    void setPatchableUniforms(std::unique_ptr<PatchableUniforms>);
+    void setGlyphAtlasPins(sk_sp<RefCntedCallback>);
+
 #if defined(GRAPHITE_TEST_UTILS)
     bool isTargetProxyInstantiated() const;
     int numVolatilePromiseImages() const;
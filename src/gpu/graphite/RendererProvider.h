@@ -12,6 +12,7 @@
 #include "include/core/SkVertices.h"
 #include "src/gpu/graphite/Renderer.h"
 
+#include <string_view>
 #include <vector>
 
 namespace skgpu::graphite {
@@ -83,6 +84,8 @@ public:
     }
 
     const RenderStep* lookup(uint32_t uniqueID) const;
+    // Unlike their IDs, RenderStep names are the same in every process.
+    const RenderStep* findRenderStep(std::string_view name) const;
 
 #ifdef SK_ENABLE_VELLO_SHADERS
     // Compute shader-based path renderer and compositor.
@@ -7,13 +7,16 @@
 
 #include "src/gpu/graphite/ResourceCache.h"
 
+#include "include/gpu/GpuMemoryReport.h"
 #include "include/private/base/SingleOwner.h"
 #include "src/base/SkRandom.h"
 #include "src/core/SkTMultiMap.h"
 #include "src/core/SkTraceEvent.h"
+#include "src/gpu/GpuMemoryReportPriv.h"
 #include "src/gpu/graphite/GraphiteResourceKey.h"
 #include "src/gpu/graphite/ProxyCache.h"
 #include "src/gpu/graphite/Resource.h"
+#include "src/gpu/graphite/SharedImageCache.h"
 
 #if defined(GRAPHITE_TEST_UTILS)
 #include "src/gpu/graphite/Texture.h"
@@ -138,6 +141,10 @@ Resource* ResourceCache::findAndRefResource(const GraphiteResourceKey& key,
             resource = fResourceMap.find(key);
         }
     }
+    if (key.shareable() == Shareable::kNo) {
+        ++fScratchRequests;
+        fScratchReuses += resource != nullptr;
+    }
     if (resource) {
         // All resources we pull out of the cache for use should be budgeted
         SkASSERT(resource->budgeted() == skgpu::Budgeted::kYes);
@@ -402,8 +409,13 @@ void ResourceCache::purgeResource(Resource* resource) {
 void ResourceCache::purgeAsNeeded() {
     ASSERT_SINGLE_OWNER
 
-    if (this->overbudget() && fProxyCache) {
-        fProxyCache->freeUniquelyHeld();
+    if (this->overbudget() && (fProxyCache || fSharedImageCache)) {
+        if (fProxyCache) {
+            fProxyCache->freeUniquelyHeld();
+        }
+        if (fSharedImageCache) {
+            fSharedImageCache->freeUniquelyHeld();
+        }
 
         // After the image cache frees resources we need to return those resources to the cache
         this->processReturnedResources();
@@ -442,6 +454,9 @@ void ResourceCache::purgeResources(const StdSteadyClock::time_point* purgeTime)
     if (fProxyCache) {
         fProxyCache->purgeProxiesNotUsedSince(purgeTime);
     }
+    if (fSharedImageCache) {
+        fSharedImageCache->purgeNotUsedSince(purgeTime);
+    }
     this->processReturnedResources();
 
     // Early out if the very first item is too new to purge to avoid sorting the queue when
@@ -564,6 +579,23 @@ void ResourceCache::dumpMemoryStatistics(SkTraceMemoryDump* traceMemoryDump) con
     }
 }
 
+void ResourceCache::addToMemoryReport(GpuMemoryReport* report) const {
+    auto add = [report](const Resource* resource, bool purgeable) {
+        AddResourceToReport(report, resource->getResourceType(), resource->gpuMemorySize(),
+                            purgeable, resource->budgeted() == skgpu::Budgeted::kYes);
+    };
+    for (int i = 0; i < fNonpurgeableResources.size(); ++i) {
+        add(fNonpurgeableResources[i], /*purgeable=*/false);
+    }
+    for (int i = 0; i < fPurgeableQueue.count(); ++i) {
+        add(fPurgeableQueue.at(i), /*purgeable=*/true);
+    }
+    SortReportResourceTypes(report);
+    report->fBudget += fMaxBytes;
+    report->fScratchRequests += fScratchRequests;
+    report->fScratchReuses += fScratchReuses;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 const GraphiteResourceKey& ResourceCache::MapTraits::GetKey(const Resource& r) {
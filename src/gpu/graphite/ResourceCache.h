@@ -25,6 +25,7 @@
 class SkTraceMemoryDump;
 
 namespace skgpu {
+struct GpuMemoryReport;
 class SingleOwner;
 }
 
@@ -33,6 +34,7 @@ namespace skgpu::graphite {
 class GraphiteResourceKey;
 class ProxyCache;
 class Resource;
+class SharedImageCache;
 
 #if defined(GRAPHITE_TEST_UTILS)
 class Texture;
@@ -84,6 +86,9 @@ public:
 
     void dumpMemoryStatistics(SkTraceMemoryDump* traceMemoryDump) const;
 
+    // Adds the cached resources, the budget and the scratch reuse counts to 'report'.
+    void addToMemoryReport(GpuMemoryReport* report) const;
+
 #if defined(GRAPHITE_TEST_UTILS)
     void forceProcessReturnedResources() { this->processReturnedResources(); }
 
@@ -106,6 +111,10 @@ public:
 
     ProxyCache* proxyCache() { return fProxyCache.get(); }
 
+    // The Context's cache frees the unused textures of the SharedImageCache along with its own
+    // resources. The image cache must outlive it or be unset first.
+    void setSharedImageCache(SharedImageCache* imageCache) { fSharedImageCache = imageCache; }
+
 private:
     ResourceCache(SingleOwner*, uint32_t recorderID, size_t maxBytes);
 
@@ -164,6 +173,7 @@ private:
     PurgeableQueue fPurgeableQueue;
     ResourceArray fNonpurgeableResources;
     std::unique_ptr<ProxyCache> fProxyCache;
+    SharedImageCache* fSharedImageCache = nullptr;
 
     SkDEBUGCODE(int fCount = 0;)
 
@@ -173,6 +183,10 @@ private:
     size_t fMaxBytes;
     size_t fBudgetedBytes = 0;
 
+    // Lookups of non-shareable (scratch) keys, and how many of them found a resource.
+    int fScratchRequests = 0;
+    int fScratchReuses = 0;
+
     SingleOwner* fSingleOwner = nullptr;
 
     bool fIsShutdown = false;
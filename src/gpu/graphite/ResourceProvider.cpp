@@ -21,6 +21,8 @@
 #include "src/gpu/graphite/GraphicsPipeline.h"
 #include "src/gpu/graphite/GraphicsPipelineDesc.h"
 #include "src/gpu/graphite/Log.h"
+#include "src/gpu/graphite/PipelineCompiler.h"
+#include "src/gpu/graphite/PipelineUsageLog.h"
 #include "src/gpu/graphite/RenderPassDesc.h"
 #include "src/gpu/graphite/RendererProvider.h"
 #include "src/gpu/graphite/ResourceCache.h"
@@ -58,7 +60,26 @@ sk_sp<GraphicsPipeline> ResourceProvider::findOrCreateGraphicsPipeline(
     auto globalCache = fSharedContext->globalCache();
     UniqueKey pipelineKey = fSharedContext->caps()->makeGraphicsPipelineKey(pipelineDesc,
                                                                             renderPassDesc);
-    sk_sp<GraphicsPipeline> pipeline = globalCache->findGraphicsPipeline(pipelineKey);
+    sk_sp<GlobalCache::InFlightGraphicsPipeline> inFlight;
+    sk_sp<GraphicsPipeline> pipeline = globalCache->findGraphicsPipeline(pipelineKey, &inFlight);
+    if (!pipeline && inFlight) {
+        if (inFlight->claim()) {
+            // The PipelineCompiler hasn't started on it yet. Its task may be queued behind this
+            // thread on the same executor, so compile it here rather than wait for the task.
+            pipeline = this->createGraphicsPipeline(runtimeDict, pipelineDesc, renderPassDesc);
+            if (pipeline) {
+                fGraphicsPipelinesCompiled++;
+                if (PipelineUsageLog* log = fSharedContext->pipelineUsageLog()) {
+                    log->record(pipelineKey, pipelineDesc, renderPassDesc);
+                }
+            }
+            // This returns the cached pipeline if another Recorder compiled one in the meantime.
+            globalCache->finishGraphicsPipelineCompile(pipelineKey, std::move(pipeline));
+            return globalCache->findGraphicsPipeline(pipelineKey);
+        }
+        // The PipelineCompiler is already working on it. If that fails we try again ourselves.
+        pipeline = inFlight->wait();
+    }
     if (!pipeline) {
         // Haven't encountered this pipeline, so create a new one. Since pipelines are shared
         // across Recorders, we could theoretically create equivalent pipelines on different
@@ -71,14 +92,49 @@ sk_sp<GraphicsPipeline> ResourceProvider::findOrCreateGraphicsPipeline(
                      TRACE_STR_COPY(to_str(fSharedContext, pipelineDesc, renderPassDesc).c_str()));
         pipeline = this->createGraphicsPipeline(runtimeDict, pipelineDesc, renderPassDesc);
         if (pipeline) {
+            fGraphicsPipelinesCompiled++;
             // TODO: Should we store a null pipeline if we failed to create one so that subsequent
             // usage immediately sees that the pipeline cannot be created, vs. retrying every time?
+            if (PipelineUsageLog* log = fSharedContext->pipelineUsageLog()) {
+                log->record(pipelineKey, pipelineDesc, renderPassDesc);
+            }
             pipeline = globalCache->addGraphicsPipeline(pipelineKey, std::move(pipeline));
         }
     }
     return pipeline;
 }
 
+bool ResourceProvider::compileGraphicsPipelineAsync(const RuntimeEffectDictionary* runtimeDict,
+                                                    const GraphicsPipelineDesc& pipelineDesc,
+                                                    const RenderPassDesc& renderPassDesc) {
+    PipelineCompiler* compiler = fSharedContext->pipelineCompiler();
+    if (!compiler) {
+        return false;
+    }
+    compiler->compileAsync(runtimeDict, pipelineDesc, renderPassDesc);
+    return true;
+}
+
+sk_sp<GraphicsPipeline> ResourceProvider::findGraphicsPipeline(
+        const GraphicsPipelineDesc& pipelineDesc,
+        const RenderPassDesc& renderPassDesc,
+        bool* compiling) {
+    UniqueKey pipelineKey = fSharedContext->caps()->makeGraphicsPipelineKey(pipelineDesc,
+                                                                            renderPassDesc);
+    sk_sp<GlobalCache::InFlightGraphicsPipeline> inFlight;
+    sk_sp<GraphicsPipeline> pipeline =
+            fSharedContext->globalCache()->findGraphicsPipeline(pipelineKey, &inFlight);
+    if (compiling) {
+        *compiling = inFlight != nullptr;
+    }
+    return pipeline;
+}
+
+bool ResourceProvider::dropDrawsWithPendingPipelines() const {
+    PipelineCompiler* compiler = fSharedContext->pipelineCompiler();
+    return compiler && compiler->dropDrawsWithPendingPipelines();
+}
+
 sk_sp<ComputePipeline> ResourceProvider::findOrCreateComputePipeline(
         const ComputePipelineDesc& pipelineDesc) {
     auto globalCache = fSharedContext->globalCache();
@@ -189,6 +245,17 @@ sk_sp<Texture> ResourceProvider::createWrappedTexture(const BackendTexture& back
     return texture;
 }
 
+sk_sp<Buffer> ResourceProvider::wrapHostMemory(const void* ptr,
+                                               size_t size,
+                                               sk_sp<SkRefCnt> memoryOwner) {
+    SkASSERT(ptr && size);
+    sk_sp<Buffer> buffer = this->onWrapHostMemory(ptr, size, std::move(memoryOwner));
+    if (buffer) {
+        buffer->setLabel("HostMemoryUploadBuffer");
+    }
+    return buffer;
+}
+
 sk_sp<Sampler> ResourceProvider::findOrCreateCompatibleSampler(const SamplerDesc& samplerDesc) {
     GraphiteResourceKey key = fSharedContext->caps()->makeSamplerKey(samplerDesc);
 
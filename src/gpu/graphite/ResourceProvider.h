@@ -8,6 +8,7 @@
 #ifndef skgpu_graphite_ResourceProvider_DEFINED
 #define skgpu_graphite_ResourceProvider_DEFINED
 
+#include "include/core/SkRefCnt.h"
 #include "include/core/SkSize.h"
 #include "include/core/SkTileMode.h"
 #include "src/core/SkLRUCache.h"
@@ -57,6 +58,23 @@ public:
                                                          const GraphicsPipelineDesc&,
                                                          const RenderPassDesc&);
 
+    // If the Context was created with a pipeline compilation executor, starts compiling the
+    // pipeline on it (unless it's already cached or being compiled) and returns true. Otherwise
+    // does nothing and returns false.
+    bool compileGraphicsPipelineAsync(const RuntimeEffectDictionary*,
+                                      const GraphicsPipelineDesc&,
+                                      const RenderPassDesc&);
+
+    // Returns the pipeline if it has already been compiled, without blocking or compiling it. If
+    // it hasn't, 'compiling' (if not null) is set to whether it is being compiled asynchronously.
+    sk_sp<GraphicsPipeline> findGraphicsPipeline(const GraphicsPipelineDesc&,
+                                                 const RenderPassDesc&,
+                                                 bool* compiling = nullptr);
+
+    // Whether draws should be dropped rather than wait for a pipeline that is compiling
+    // asynchronously.
+    bool dropDrawsWithPendingPipelines() const;
+
     sk_sp<ComputePipeline> findOrCreateComputePipeline(const ComputePipelineDesc&);
 
     sk_sp<Texture> findOrCreateScratchTexture(SkISize,
@@ -77,6 +95,11 @@ public:
                                      AccessPattern,
                                      std::string_view label);
 
+    // Wraps 'size' bytes of client memory starting at 'ptr' in a buffer that uploads can copy from
+    // in place. 'memoryOwner' keeps the memory alive and is released once the buffer is destroyed.
+    // Returns null if the backend can't have the GPU read the memory directly.
+    sk_sp<Buffer> wrapHostMemory(const void* ptr, size_t size, sk_sp<SkRefCnt> memoryOwner);
+
     sk_sp<Sampler> findOrCreateCompatibleSampler(const SamplerDesc&);
 
     BackendTexture createBackendTexture(SkISize dimensions, const TextureInfo&);
@@ -93,9 +116,21 @@ public:
         fResourceCache->dumpMemoryStatistics(traceMemoryDump);
     }
 
+    void addToMemoryReport(GpuMemoryReport* report) const {
+        fResourceCache->addToMemoryReport(report);
+    }
+
+    // The Context's provider purges the textures of the image cache shared by its Recorders.
+    void setSharedImageCache(SharedImageCache* imageCache) {
+        fResourceCache->setSharedImageCache(imageCache);
+    }
+
     void freeGpuResources();
     void purgeResourcesNotUsedSince(StdSteadyClock::time_point purgeTime);
 
+    // How many times findOrCreateGraphicsPipeline() had to compile a pipeline.
+    int numGraphicsPipelinesCompiled() const { return fGraphicsPipelinesCompiled; }
+
 #if defined(GRAPHITE_TEST_UTILS)
     ResourceCache* resourceCache() { return fResourceCache.get(); }
     const SharedContext* sharedContext() { return fSharedContext; }
@@ -121,6 +156,8 @@ protected:
     sk_sp<ResourceCache> fResourceCache;
 
 private:
+    friend class PipelineCompiler;  // for createGraphicsPipeline()
+
     virtual sk_sp<GraphicsPipeline> createGraphicsPipeline(const RuntimeEffectDictionary*,
                                                            const GraphicsPipelineDesc&,
                                                            const RenderPassDesc&) = 0;
@@ -139,6 +176,10 @@ private:
 
     virtual sk_sp<Texture> onCreateWrappedTexture(const BackendTexture&) = 0;
 
+    virtual sk_sp<Buffer> onWrapHostMemory(const void*, size_t, sk_sp<SkRefCnt>) {
+        return nullptr;
+    }
+
     virtual BackendTexture onCreateBackendTexture(SkISize dimensions, const TextureInfo&) = 0;
 #ifdef SK_BUILD_FOR_ANDROID
     virtual BackendTexture onCreateBackendTexture(AHardwareBuffer*,
@@ -148,6 +189,8 @@ private:
                                                   bool fromAndroidWindow) const;
 #endif
     virtual void onDeleteBackendTexture(const BackendTexture&) = 0;
+
+    int fGraphicsPipelinesCompiled = 0;
 };
 
 } // namespace skgpu::graphite
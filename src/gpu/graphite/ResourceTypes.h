@@ -182,6 +182,17 @@ struct BindUniformBufferInfo : public BindBufferInfo {
     bool operator!=(const BindUniformBufferInfo& o) const { return !(*this == o); }
 };
 
+/**
+ * Has uniform buffer bindings that start within [fOffset, fOffset + fSize) of fFrom bind fTo
+ * instead, at the same position relative to the start of fTo.
+ */
+struct UniformBufferRemap {
+    const Buffer* fFrom = nullptr;
+    size_t fOffset = 0;
+    size_t fSize = 0;
+    const Buffer* fTo = nullptr;
+};
+
 /**
  * Represents a buffer region that should be cleared to 0. A ClearBuffersTask does not take an
  * owning reference to the buffer it clears. A higher layer is responsible for managing the lifetime
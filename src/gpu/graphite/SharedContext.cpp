@@ -12,8 +12,12 @@
 #include "src/gpu/graphite/Caps.h"
 #include "src/gpu/graphite/CommandBuffer.h"
 #include "src/gpu/graphite/GpuWorkSubmission.h"
+#include "src/gpu/graphite/PipelineCompiler.h"
+#include "src/gpu/graphite/PipelineUsageLog.h"
 #include "src/gpu/graphite/RendererProvider.h"
 #include "src/gpu/graphite/ResourceProvider.h"
+#include "src/gpu/graphite/SharedImageCache.h"
+#include "src/gpu/graphite/text/TextAtlasManager.h"
 
 namespace skgpu::graphite {
 
@@ -27,6 +31,7 @@ SharedContext::~SharedContext() {
     // TODO: add disconnect?
 
     // TODO: destroyResources instead?
+    SkASSERT(!fPipelineCompiler);
 }
 
 Protected SharedContext::isProtected() const { return Protected(fCaps->protectedSupport()); }
@@ -37,4 +42,26 @@ void SharedContext::setRendererProvider(std::unique_ptr<RendererProvider> render
     fRendererProvider = std::move(rendererProvider);
 }
 
+void SharedContext::setPipelineCompiler(std::unique_ptr<PipelineCompiler> pipelineCompiler) {
+    SkASSERT(pipelineCompiler && !fPipelineCompiler);
+    fPipelineCompiler = std::move(pipelineCompiler);
+}
+
+void SharedContext::setPipelineUsageLog(std::unique_ptr<PipelineUsageLog> pipelineUsageLog) {
+    SkASSERT(pipelineUsageLog && !fPipelineUsageLog);
+    fPipelineUsageLog = std::move(pipelineUsageLog);
+}
+
+void SharedContext::setSharedTextAtlasManager(sk_sp<TextAtlasManager> textAtlasManager) {
+    fSharedTextAtlasManager = std::move(textAtlasManager);
+}
+
+void SharedContext::setSharedImageCache(std::unique_ptr<SharedImageCache> imageCache) {
+    fSharedImageCache = std::move(imageCache);
+}
+
+void SharedContext::destroyPipelineCompiler() {
+    fPipelineCompiler.reset();
+}
+
 } // namespace skgpu::graphite
@@ -25,8 +25,12 @@ namespace skgpu::graphite {
 class BackendTexture;
 class Caps;
 class CommandBuffer;
+class PipelineCompiler;
+class PipelineUsageLog;
 class RendererProvider;
 class ResourceProvider;
+class SharedImageCache;
+class TextAtlasManager;
 class TextureInfo;
 
 class SharedContext : public SkRefCnt {
@@ -46,6 +50,21 @@ public:
 
     const RendererProvider* rendererProvider() const { return fRendererProvider.get(); }
 
+    // Null unless the Context was created with a pipeline compilation executor.
+    PipelineCompiler* pipelineCompiler() const { return fPipelineCompiler.get(); }
+
+    // Null unless the Context was created with ContextOptions::fRecordPipelineUsage, in which case
+    // every pipeline it compiles is noted here.
+    PipelineUsageLog* pipelineUsageLog() const { return fPipelineUsageLog.get(); }
+
+    // Null unless the Context was created with ContextOptions::fShareGlyphAtlasAcrossRecorders, in
+    // which case all of its Recorders place glyphs in this TextAtlasManager.
+    TextAtlasManager* sharedTextAtlasManager() const { return fSharedTextAtlasManager.get(); }
+
+    // Null unless the Context was created with ContextOptions::fShareImageUploadsAcrossRecorders,
+    // in which case all of its Recorders upload raster images to textures in this cache.
+    SharedImageCache* sharedImageCache() const { return fSharedImageCache.get(); }
+
     ShaderCodeDictionary* shaderCodeDictionary() { return &fShaderDictionary; }
     const ShaderCodeDictionary* shaderCodeDictionary() const { return &fShaderDictionary; }
 
@@ -57,21 +76,44 @@ public:
     // gotten into an unrecoverable, lost state.
     virtual bool isDeviceLost() const { return false; }
 
+    // Called by Context::syncPipelineData(). Backends that can serialize their compiled pipelines
+    // write them to the ContextOptions' PersistentPipelineStorage.
+    virtual void syncPipelineData(size_t maxSize) {}
+
 protected:
     SharedContext(std::unique_ptr<const Caps>, BackendApi);
 
+    // Waits for any outstanding asynchronous pipeline compiles and destroys the PipelineCompiler.
+    // Backend subclasses must call this before tearing down anything the compiles use.
+    void destroyPipelineCompiler();
+
 private:
-    friend class Context; // for setRendererProvider()
+    // for setRendererProvider(), setPipelineCompiler(), setPipelineUsageLog(),
+    // setSharedTextAtlasManager() and setSharedImageCache()
+    friend class Context;
 
     // Must be created out-of-band to allow RenderSteps to use a QueueManager.
     void setRendererProvider(std::unique_ptr<RendererProvider> rendererProvider);
 
+    void setPipelineCompiler(std::unique_ptr<PipelineCompiler> pipelineCompiler);
+
+    void setPipelineUsageLog(std::unique_ptr<PipelineUsageLog>);
+
+    void setSharedTextAtlasManager(sk_sp<TextAtlasManager>);
+
+    void setSharedImageCache(std::unique_ptr<SharedImageCache>);
+
     std::unique_ptr<const Caps> fCaps; // Provided by backend subclass
 
     BackendApi fBackend;
     GlobalCache fGlobalCache;
     std::unique_ptr<RendererProvider> fRendererProvider;
     ShaderCodeDictionary fShaderDictionary;
+    // Declared before the PipelineCompiler, whose compiles record to it.
+    std::unique_ptr<PipelineUsageLog> fPipelineUsageLog;
+    std::unique_ptr<PipelineCompiler> fPipelineCompiler;
+    sk_sp<TextAtlasManager> fSharedTextAtlasManager;
+    std::unique_ptr<SharedImageCache> fSharedImageCache;
 };
 
 } // namespace skgpu::graphite
@@ -0,0 +1,248 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/gpu/graphite/SharedImageCache.h"
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkPixelRef.h"
+#include "include/gpu/GpuTypes.h"
+#include "include/private/SkIDChangeListener.h"
+#include "src/core/SkMipmap.h"
+#include "src/gpu/graphite/Caps.h"
+#include "src/gpu/graphite/Image_Graphite.h"
+#include "src/gpu/graphite/Log.h"
+#include "src/gpu/graphite/RecorderPriv.h"
+#include "src/gpu/graphite/ResourceProvider.h"
+#include "src/gpu/graphite/Texture.h"
+#include "src/gpu/graphite/TextureProxy.h"
+#include "src/gpu/graphite/TextureUtils.h"
+#include "src/gpu/graphite/task/UploadTask.h"
+#include "src/image/SkImage_Base.h"
+#include "src/image/SkImage_Raster.h"
+
+#include <atomic>
+#include <utility>
+
+using namespace skia_private;
+
+namespace skgpu::graphite {
+
+namespace {
+
+// The invalidation messages of the cache are posted to the same bus as those of the Recorders'
+// ProxyCaches. Its keys are in their own domain, so a Recorder that was given the same ID would
+// find none of them in its cache and ignore them.
+uint32_t next_id() {
+    static std::atomic<uint32_t> nextID{1};
+    uint32_t id;
+    do {
+        id = nextID.fetch_add(1, std::memory_order_relaxed);
+    } while (id == SK_InvalidUniqueID);
+    return id;
+}
+
+void make_key(UniqueKey* key, const SkBitmap& bm, Mipmapped mipmapped) {
+    SkIPoint origin = bm.pixelRefOrigin();
+    SkIRect subset = SkIRect::MakePtSize(origin, bm.dimensions());
+
+    static const UniqueKey::Domain kSharedImageCacheDomain = UniqueKey::GenerateDomain();
+    UniqueKey::Builder builder(key, kSharedImageCacheDomain, 6, "SharedImageCache");
+    builder[0] = bm.pixelRef()->getGenerationID();
+    builder[1] = subset.fLeft;
+    builder[2] = subset.fTop;
+    builder[3] = subset.fRight;
+    builder[4] = subset.fBottom;
+    builder[5] = mipmapped == Mipmapped::kYes;
+}
+
+class InvalidationListener : public SkIDChangeListener {
+public:
+    InvalidationListener(const UniqueKey& key, uint32_t cacheID) : fMsg(key, cacheID) {}
+
+    void changed() override {
+        SkMessageBus<UniqueKeyInvalidatedMsg_Graphite, uint32_t>::Post(fMsg);
+    }
+
+private:
+    UniqueKeyInvalidatedMsg_Graphite fMsg;
+};
+
+} // anonymous namespace
+
+SharedImageCache::SharedImageCache(const Caps* caps)
+        : fCaps(caps)
+        , fUniqueID(next_id())
+        , fInvalidUniqueKeyInbox(fUniqueID) {}
+
+SharedImageCache::~SharedImageCache() {
+    SkASSERT(fCache.count() == 0 && fPendingUploads.empty());
+}
+
+sk_sp<SkImage> SharedImageCache::MakeImage(const Entry& entry) {
+    return sk_make_sp<Image>(TextureProxyView(entry.fProxy, entry.fReadSwizzle), entry.fColorInfo);
+}
+
+SharedImageCache::Entry* SharedImageCache::find(const UniqueKey& mipmappedKey,
+                                                const UniqueKey* key) {
+    Entry* entry = fCache.find(mipmappedKey);
+    if (!entry && key) {
+        entry = fCache.find(*key);
+    }
+    if (entry) {
+        entry->fLastUse = skgpu::StdSteadyClock::now();
+    }
+    return entry;
+}
+
+sk_sp<SkImage> SharedImageCache::findOrCreate(Recorder* recorder,
+                                              const SkImage* image,
+                                              Mipmapped mipmapped) {
+    SkASSERT(as_IB(image)->isRasterBacked());
+    const SkImage_Raster* raster = static_cast<const SkImage_Raster*>(image);
+    SkBitmap bitmap = raster->bitmap();
+    if (bitmap.dimensions().area() <= 1) {
+        mipmapped = Mipmapped::kNo;
+    }
+
+    UniqueKey mipmappedKey, key;
+    make_key(&mipmappedKey, bitmap, Mipmapped::kYes);
+    if (mipmapped == Mipmapped::kNo) {
+        make_key(&key, bitmap, Mipmapped::kNo);
+    }
+    const UniqueKey& newKey = mipmapped == Mipmapped::kYes ? mipmappedKey : key;
+    const UniqueKey* otherKey = mipmapped == Mipmapped::kYes ? nullptr : &key;
+
+    {
+        SkAutoMutexExclusive lock(fMutex);
+        this->processInvalidKeyMsgs();
+        if (Entry* entry = this->find(mipmappedKey, otherKey)) {
+            return MakeImage(*entry);
+        }
+    }
+
+    // Converting the pixels and building the mip levels can take a while, so it's done without
+    // holding the lock. If another Recorder adds the same image first, its texture is used.
+    auto upload = std::make_unique<BitmapUpload>();
+    if (!PrepareBitmapUpload(fCaps, recorder->priv().isProtected(), bitmap, raster->refMips(),
+                             mipmapped, upload.get())) {
+        return nullptr;
+    }
+    const SkISize dimensions = upload->fBitmap.dimensions();
+    const TextureInfo textureInfo = upload->fTextureInfo;
+    sk_sp<TextureProxy> proxy = TextureProxy::MakeLazy(
+            fCaps, dimensions, textureInfo, skgpu::Budgeted::kYes, Volatile::kNo,
+            [dimensions, textureInfo](ResourceProvider* resourceProvider) {
+                return resourceProvider->findOrCreateScratchTexture(
+                        dimensions, textureInfo, "SharedImageCache", skgpu::Budgeted::kYes);
+            });
+    if (!proxy) {
+        return nullptr;
+    }
+
+    SkAutoMutexExclusive lock(fMutex);
+    this->processInvalidKeyMsgs();
+    if (Entry* entry = this->find(mipmappedKey, otherKey)) {
+        return MakeImage(*entry);
+    }
+
+    Entry* entry = fCache.set(newKey, {proxy,
+                                       upload->fReadSwizzle,
+                                       image->imageInfo().colorInfo().makeColorType(
+                                               upload->fColorType),
+                                       skgpu::StdSteadyClock::now()});
+    fPendingUploads.push_back({std::move(proxy), std::move(upload)});
+    // As in ProxyCache, an entry is only dropped when the pixels change if something besides this
+    // call holds on to them.
+    if (!bitmap.pixelRef()->unique()) {
+        bitmap.pixelRef()->addGenIDChangeListener(
+                sk_make_sp<InvalidationListener>(newKey, fUniqueID));
+    }
+    return MakeImage(*entry);
+}
+
+bool SharedImageCache::hasPendingUploads() {
+    SkAutoMutexExclusive lock(fMutex);
+    return !fPendingUploads.empty();
+}
+
+bool SharedImageCache::recordPendingUploads(Recorder* recorder) {
+    SkAutoMutexExclusive lock(fMutex);
+    bool succeeded = true;
+    UploadList uploads;
+    for (PendingUpload& pending : fPendingUploads) {
+        if (pending.fProxy->unique()) {
+            // No image made from the entry is left, nor is the entry.
+            continue;
+        }
+        const SkBitmap& bitmap = pending.fUpload->fBitmap;
+        const SkColorInfo& colorInfo = bitmap.info().colorInfo();
+        if (!pending.fProxy->lazyInstantiate(recorder->priv().resourceProvider()) ||
+            !uploads.recordUpload(recorder, pending.fProxy, colorInfo, colorInfo,
+                                  pending.fUpload->fTexels, SkIRect::MakeSize(bitmap.dimensions()),
+                                  /*ConditionalUploadContext=*/nullptr)) {
+            SKGPU_LOG_W("SharedImageCache: Could not upload a %dx%d image",
+                        bitmap.width(), bitmap.height());
+            succeeded = false;
+        }
+    }
+    fPendingUploads.clear();
+    if (sk_sp<UploadTask> task = UploadTask::Make(&uploads)) {
+        recorder->priv().add(std::move(task));
+    }
+    return succeeded;
+}
+
+void SharedImageCache::freeUniquelyHeld() {
+    SkAutoMutexExclusive lock(fMutex);
+    this->purge(nullptr);
+}
+
+void SharedImageCache::purgeNotUsedSince(const skgpu::StdSteadyClock::time_point* purgeTime) {
+    SkAutoMutexExclusive lock(fMutex);
+    this->purge(purgeTime);
+}
+
+void SharedImageCache::purge(const skgpu::StdSteadyClock::time_point* purgeTime) {
+    this->processInvalidKeyMsgs();
+
+    std::vector<UniqueKey> toRemove;
+    fCache.foreach([&](const UniqueKey& key, const Entry* entry) {
+        // The refs Recorders and images take are only ever taken from the cache under the lock,
+        // so a texture nothing else refers to now won't be referred to once it's dropped.
+        if (entry->fProxy->unique() && (!purgeTime || entry->fLastUse < *purgeTime)) {
+            toRemove.push_back(key);
+        }
+    });
+    for (const UniqueKey& key : toRemove) {
+        fCache.remove(key);
+    }
+}
+
+void SharedImageCache::freeAll() {
+    SkAutoMutexExclusive lock(fMutex);
+    fPendingUploads.clear();
+    fCache.reset();
+}
+
+void SharedImageCache::processInvalidKeyMsgs() {
+    TArray<UniqueKeyInvalidatedMsg_Graphite> invalidKeyMsgs;
+    fInvalidUniqueKeyInbox.poll(&invalidKeyMsgs);
+    for (const UniqueKeyInvalidatedMsg_Graphite& msg : invalidKeyMsgs) {
+        // The entry may already have been dropped.
+        fCache.removeIfExists(msg.key());
+    }
+}
+
+#if defined(GRAPHITE_TEST_UTILS)
+int SharedImageCache::numCached() {
+    SkAutoMutexExclusive lock(fMutex);
+    return fCache.count();
+}
+#endif
+
+} // namespace skgpu::graphite
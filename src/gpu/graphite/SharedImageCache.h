@@ -0,0 +1,120 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef skgpu_graphite_SharedImageCache_DEFINED
+#define skgpu_graphite_SharedImageCache_DEFINED
+
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkRefCnt.h"
+#include "include/private/base/SkMutex.h"
+#include "include/private/base/SkThreadAnnotations.h"
+#include "src/core/SkMessageBus.h"
+#include "src/core/SkTHash.h"
+#include "src/gpu/GpuTypesPriv.h"
+#include "src/gpu/ResourceKey.h"
+#include "src/gpu/Swizzle.h"
+
+#include <memory>
+#include <vector>
+
+class SkImage;
+
+namespace skgpu {
+    enum class Mipmapped : bool;
+}
+
+namespace skgpu::graphite {
+
+struct BitmapUpload;
+class Caps;
+class Recorder;
+class TextureProxy;
+
+/**
+ * The textures of raster images uploaded by any of the Recorders of a Context that was made with
+ * ContextOptions::fShareImageUploadsAcrossRecorders, so that an image drawn by several Recorders
+ * is uploaded once. Entries are keyed by the image's pixel ref generation ID and subset, and
+ * whether the texture has mip levels; a draw that doesn't need mip levels uses a texture that has
+ * them if there is one.
+ *
+ * A Recorder that misses finds a texture that is not made yet: its proxy is instantiated by the
+ * Context, which uploads the pixels of every texture made so far ahead of each Recording it
+ * inserts (see recordPendingUploads()). Every Recording that samples a texture is snapped after it
+ * was made, so its pixels are always in place first whatever order Recordings are inserted in.
+ *
+ * The textures count against the Context's ResourceCache budget. Entries that nothing else refers
+ * to are dropped when that cache is over budget or purges resources, and an entry is dropped when
+ * its pixels change.
+ */
+class SharedImageCache {
+public:
+    explicit SharedImageCache(const Caps*);
+    ~SharedImageCache();
+
+    // Returns an image backed by the texture for 'image', which must be raster backed, making it
+    // if there isn't one yet. Returns null if the image can't be uploaded.
+    sk_sp<SkImage> findOrCreate(Recorder*, const SkImage* image, Mipmapped);
+
+    bool hasPendingUploads();
+
+    // Records the uploads of the textures made since the last call on 'recorder', which must use
+    // the Context's ResourceProvider. Returns false if any of them failed.
+    bool recordPendingUploads(Recorder*);
+
+    // Drops the entries whose texture nothing else refers to.
+    void freeUniquelyHeld();
+
+    // Drops the entries whose texture nothing else refers to and that haven't been used since
+    // 'purgeTime', or all such entries if it is null. Textures still in use keep their entries.
+    void purgeNotUsedSince(const skgpu::StdSteadyClock::time_point* purgeTime);
+
+    // Drops every entry, which must be done before the Context's ResourceProvider goes away.
+    void freeAll();
+
+#if defined(GRAPHITE_TEST_UTILS)
+    int numCached();
+#endif
+
+private:
+    struct Entry {
+        sk_sp<TextureProxy> fProxy;
+        Swizzle fReadSwizzle;
+        SkColorInfo fColorInfo;
+        skgpu::StdSteadyClock::time_point fLastUse;
+    };
+
+    // The pending uploads keep their proxies, so an entry is never dropped before its upload is
+    // recorded, and the upload is still recorded if the entry is dropped because its pixels
+    // changed while an image made from it is in use.
+    struct PendingUpload {
+        sk_sp<TextureProxy> fProxy;
+        std::unique_ptr<BitmapUpload> fUpload;
+    };
+
+    struct UniqueKeyHash {
+        uint32_t operator()(const UniqueKey& key) const { return key.hash(); }
+    };
+
+    static sk_sp<SkImage> MakeImage(const Entry&);
+    // Finds the entry with mip levels, or if there is none and 'key' is not null, the one without.
+    Entry* find(const UniqueKey& mipmappedKey, const UniqueKey* key) SK_REQUIRES(fMutex);
+    void processInvalidKeyMsgs() SK_REQUIRES(fMutex);
+    void purge(const skgpu::StdSteadyClock::time_point* purgeTime) SK_REQUIRES(fMutex);
+
+    const Caps* fCaps;
+    const uint32_t fUniqueID;
+
+    SkMutex fMutex;
+    skia_private::THashMap<UniqueKey, Entry, UniqueKeyHash> fCache SK_GUARDED_BY(fMutex);
+    std::vector<PendingUpload> fPendingUploads SK_GUARDED_BY(fMutex);
+    SkMessageBus<UniqueKeyInvalidatedMsg_Graphite, uint32_t>::Inbox fInvalidUniqueKeyInbox
+            SK_GUARDED_BY(fMutex);
+};
+
+} // namespace skgpu::graphite
+
+#endif // skgpu_graphite_SharedImageCache_DEFINED
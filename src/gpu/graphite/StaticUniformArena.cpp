@@ -0,0 +1,161 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/gpu/graphite/StaticUniformArena.h"
+
+#include "include/gpu/graphite/Recording.h"
+#include "src/gpu/graphite/Buffer.h"
+#include "src/gpu/graphite/Caps.h"
+#include "src/gpu/graphite/RecordingPriv.h"
+#include "src/gpu/graphite/ResourceProvider.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace skgpu::graphite {
+
+namespace {
+
+// A block moves into the arena once this many passes have used it. Blocks that a single pass uses
+// many times are already written once per pass.
+constexpr int kPassesBeforeAdding = 3;
+
+// The blocks that aren't in the arena yet are copied to count their uses. Once there are this many
+// of them they're all forgotten, which only delays moving the recurring ones into the arena.
+constexpr int kMaxCandidates = 1024;
+
+constexpr size_t kMaxChunkSize = 64 << 10;
+
+}  // anonymous namespace
+
+StaticUniformArena::StaticUniformArena(ResourceProvider* resourceProvider,
+                                       const Caps* caps,
+                                       size_t maxBytes)
+        : fResourceProvider(resourceProvider)
+        , fMaxBytes(maxBytes)
+        , fChunkSize(std::min(maxBytes, kMaxChunkSize))
+        , fAlignment(std::max<size_t>(caps->requiredUniformBufferAlignment(), 1)) {
+    SkASSERT(caps->drawBufferCanBeMapped());
+}
+
+StaticUniformArena::~StaticUniformArena() = default;
+
+BindUniformBufferInfo StaticUniformArena::findOrAdd(const UniformDataBlock& block,
+                                                   size_t alignedSize) {
+    const BlockRef ref{&block};
+    if (std::unique_ptr<Entry>* found = fEntries.find(ref)) {
+        Entry* entry = found->get();
+        if (!entry->fLocation && entry->fLastPass != fCurrentPass) {
+            entry->fLastPass = fCurrentPass;
+            if (++entry->fPassCount >= kPassesBeforeAdding && !fFull) {
+                entry->fLocation = this->add(block, alignedSize);
+                if (entry->fLocation) {
+                    fCandidateCount--;
+                }
+            }
+        }
+        if (entry->fLocation) {
+            SkASSERT(entry->fLocation.fBindingSize == alignedSize);
+            fUsedSinceTransfer = true;
+        }
+        return entry->fLocation;
+    }
+
+    if (fFull) {
+        return {};
+    }
+    if (fCandidateCount >= kMaxCandidates) {
+        this->dropCandidates();
+    }
+    auto entry = std::make_unique<Entry>();
+    entry->fData = std::make_unique<char[]>(block.size());
+    memcpy(entry->fData.get(), block.data(), block.size());
+    entry->fBlock = UniformDataBlock({entry->fData.get(), block.size()});
+    entry->fPassCount = 1;
+    entry->fLastPass = fCurrentPass;
+    const BlockRef key{&entry->fBlock};
+    fEntries.set(key, std::move(entry));
+    fCandidateCount++;
+    return {};
+}
+
+BindUniformBufferInfo StaticUniformArena::add(const UniformDataBlock& block, size_t alignedSize) {
+    SkASSERT(block.size() <= alignedSize && alignedSize % fAlignment == 0);
+    if (fChunks.empty() || fChunkOffset + alignedSize > fChunkSize) {
+        if (alignedSize > fChunkSize || fBytesUsed + fChunkSize > fMaxBytes) {
+            // Only stop adding when it's the total that's used up, big blocks are just skipped.
+            fFull = alignedSize <= fChunkSize;
+            return {};
+        }
+        sk_sp<Buffer> chunk = fResourceProvider->findOrCreateBuffer(fChunkSize,
+                                                                    BufferType::kUniform,
+                                                                    AccessPattern::kHostVisible,
+                                                                    "StaticUniformArena");
+        if (!chunk) {
+            fFull = true;
+            return {};
+        }
+        fChunks.push_back(std::move(chunk));
+        fChunkOffset = 0;
+        fBytesUsed += fChunkSize;
+    }
+
+    Buffer* chunk = fChunks.back().get();
+    // Passes that are already on the GPU may read the rest of the chunk, but never these bytes.
+    void* mapPtr = chunk->map();
+    if (!mapPtr) {
+        fFull = true;
+        return {};
+    }
+    memcpy(static_cast<char*>(mapPtr) + fChunkOffset, block.data(), block.size());
+    chunk->unmap();
+
+    BindUniformBufferInfo location;
+    location.fBuffer = chunk;
+    location.fOffset = fChunkOffset;
+    location.fBindingSize = SkToU32(alignedSize);
+    fChunkOffset += alignedSize;
+    return location;
+}
+
+void StaticUniformArena::dropCandidates() {
+    skia_private::TArray<BlockRef> candidates;
+    fEntries.foreach([&](const BlockRef& key, const std::unique_ptr<Entry>& entry) {
+        if (!entry->fLocation) {
+            candidates.push_back(key);
+        }
+    });
+    for (const BlockRef& key : candidates) {
+        fEntries.remove(key);
+    }
+    fCandidateCount = 0;
+}
+
+void StaticUniformArena::transferToRecording(Recording* recording) {
+    if (!fUsedSinceTransfer) {
+        return;
+    }
+    for (const sk_sp<Buffer>& chunk : fChunks) {
+        recording->priv().addResourceRef(chunk);
+    }
+    fUsedSinceTransfer = false;
+}
+
+void StaticUniformArena::reset() {
+    if (fUsedSinceTransfer) {
+        // Passes that haven't been snapped yet bind the buffers without a ref.
+        return;
+    }
+    fEntries.reset();
+    fCandidateCount = 0;
+    fChunks.clear();
+    fChunkOffset = 0;
+    fBytesUsed = 0;
+    fFull = false;
+}
+
+}  // namespace skgpu::graphite
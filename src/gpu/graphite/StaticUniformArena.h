@@ -0,0 +1,101 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef skgpu_graphite_StaticUniformArena_DEFINED
+#define skgpu_graphite_StaticUniformArena_DEFINED
+
+#include "include/core/SkRefCnt.h"
+#include "include/private/base/SkTArray.h"
+#include "src/core/SkTHash.h"
+#include "src/gpu/graphite/PipelineData.h"
+#include "src/gpu/graphite/ResourceTypes.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace skgpu::graphite {
+
+class Buffer;
+class Caps;
+class Recording;
+class ResourceProvider;
+
+/**
+ * Keeps the paint uniform blocks that a Recorder's DrawPasses use again and again in long-lived
+ * uniform buffers, so that passes bind them where they already are instead of writing them to the
+ * pass's own buffers. A block moves into the arena once it has been used by a few different passes,
+ * and then stays there until the arena is reset.
+ *
+ * A block is written into the arena through a mapped pointer as soon as it moves there, and never
+ * changes after that, so any Recording snapped later finds it whatever order Recordings are
+ * inserted in. This needs draw buffers that can be mapped while the GPU may read other parts of
+ * them, and uniform buffers that are bound one block at a time (not storage buffers).
+ */
+class StaticUniformArena {
+public:
+    StaticUniformArena(ResourceProvider*, const Caps*, size_t maxBytes);
+    ~StaticUniformArena();
+
+    // Starts counting the uses of blocks by a new DrawPass.
+    void beginPass() { fCurrentPass++; }
+
+    // Returns where the block is in the arena, moving it there if this use makes it recurring
+    // enough, or an empty binding if the pass has to write the block itself. 'alignedSize' is the
+    // size of the block rounded up to the uniform buffer alignment.
+    BindUniformBufferInfo findOrAdd(const UniformDataBlock&, size_t alignedSize);
+
+    // Has the Recording keep the arena's buffers alive if any pass since the last call used them.
+    void transferToRecording(Recording*);
+
+    // Drops all blocks and buffers, unless passes that are still being recorded use them.
+    // Recordings that used them keep them until they are deleted.
+    void reset();
+
+    size_t bytesUsed() const { return fBytesUsed; }
+
+private:
+    struct Entry {
+        std::unique_ptr<char[]> fData;
+        UniformDataBlock fBlock;
+        int fPassCount = 0;
+        uint32_t fLastPass = 0;
+        BindUniformBufferInfo fLocation;  // Empty until the block is in the arena
+    };
+
+    struct BlockRef {
+        const UniformDataBlock* fBlock;
+
+        bool operator==(const BlockRef& that) const { return *fBlock == *that.fBlock; }
+    };
+    struct BlockRefHash {
+        uint32_t operator()(const BlockRef& ref) const { return ref.fBlock->hash(); }
+    };
+
+    BindUniformBufferInfo add(const UniformDataBlock&, size_t alignedSize);
+    void dropCandidates();
+
+    ResourceProvider* fResourceProvider;
+    const size_t fMaxBytes;
+    const size_t fChunkSize;
+    const size_t fAlignment;
+
+    skia_private::THashMap<BlockRef, std::unique_ptr<Entry>, BlockRefHash> fEntries;
+    int fCandidateCount = 0;
+
+    skia_private::TArray<sk_sp<Buffer>> fChunks;
+    size_t fChunkOffset = 0;  // Into fChunks.back()
+    size_t fBytesUsed = 0;
+    bool fFull = false;
+    bool fUsedSinceTransfer = false;
+
+    uint32_t fCurrentPass = 0;
+};
+
+}  // namespace skgpu::graphite
+
+#endif  // skgpu_graphite_StaticUniformArena_DEFINED
@@ -43,9 +43,11 @@
 #include "src/gpu/graphite/RecorderPriv.h"
 #include "src/gpu/graphite/ResourceProvider.h"
 #include "src/gpu/graphite/ResourceTypes.h"
+#include "src/gpu/graphite/SharedImageCache.h"
 #include "src/gpu/graphite/SpecialImage_Graphite.h"
 #include "src/gpu/graphite/Surface_Graphite.h"
 #include "src/gpu/graphite/Texture.h"
+#include "src/gpu/graphite/compute/ComputeBlur.h"
 #include "src/gpu/graphite/task/CopyTask.h"
 #include "src/gpu/graphite/task/SynchronizeToCpuTask.h"
 #include "src/gpu/graphite/task/UploadTask.h"
@@ -201,6 +203,15 @@ sk_sp<SkSpecialImage> blur_impl(Recorder* recorder,
                                 SkIRect dstRect,
                                 sk_sp<SkColorSpace> outCS,
                                 const SkSurfaceProps& outProps) {
+    // Large blurs are cheaper as sliding box blurs in compute shaders than as a Gaussian kernel
+    // over a rescaled image, when the backend can run them.
+    if (sigma.width() >= kMinComputeBlurSigma || sigma.height() >= kMinComputeBlurSigma) {
+        if (sk_sp<SkSpecialImage> output = ComputeBlur(recorder, sigma, input, srcRect, tileMode,
+                                                       dstRect, outCS, outProps)) {
+            return output;
+        }
+    }
+
     // See if we can do a blur on the original resolution image
     if (sigma.width() <= kMaxLinearBlurSigma &&
         sigma.height() <= kMaxLinearBlurSigma) {
@@ -371,23 +382,26 @@ private:
     std::string fLabel;
 };
 
+class RefCntedBitmapUpload final : public SkRefCnt {
+public:
+    BitmapUpload fUpload;
+};
+
 } // anonymous namespace
 
-std::tuple<TextureProxyView, SkColorType> MakeBitmapProxyView(Recorder* recorder,
-                                                              const SkBitmap& bitmap,
-                                                              sk_sp<SkMipmap> mipmapsIn,
-                                                              Mipmapped mipmapped,
-                                                              Budgeted budgeted,
-                                                              std::string_view label) {
+bool PrepareBitmapUpload(const Caps* caps,
+                         Protected isProtected,
+                         const SkBitmap& bitmap,
+                         sk_sp<SkMipmap> mipmapsIn,
+                         Mipmapped mipmapped,
+                         BitmapUpload* upload) {
     // Adjust params based on input and Caps
-    const Caps* caps = recorder->priv().caps();
     SkColorType ct = bitmap.info().colorType();
 
     if (bitmap.dimensions().area() <= 1) {
         mipmapped = Mipmapped::kNo;
     }
 
-    Protected isProtected = recorder->priv().isProtected();
     auto textureInfo = caps->getDefaultSampledTextureInfo(ct, mipmapped, isProtected,
                                                           Renderable::kNo);
     if (!textureInfo.isValid()) {
@@ -398,11 +412,11 @@ std::tuple<TextureProxyView, SkColorType> MakeBitmapProxyView(Recorder* recorder
     SkASSERT(textureInfo.isValid());
 
     // Convert bitmap to texture colortype if necessary
-    SkBitmap bmpToUpload;
+    SkBitmap& bmpToUpload = upload->fBitmap;
     if (ct != bitmap.info().colorType()) {
         if (!bmpToUpload.tryAllocPixels(bitmap.info().makeColorType(ct)) ||
             !bitmap.readPixels(bmpToUpload.pixmap())) {
-            return {};
+            return false;
         }
         bmpToUpload.setImmutable();
     } else {
@@ -410,7 +424,7 @@ std::tuple<TextureProxyView, SkColorType> MakeBitmapProxyView(Recorder* recorder
     }
 
     if (!SkImageInfoIsValid(bmpToUpload.info())) {
-        return {};
+        return false;
     }
 
     int mipLevelCount = (mipmapped == Mipmapped::kYes) ?
@@ -418,18 +432,18 @@ std::tuple<TextureProxyView, SkColorType> MakeBitmapProxyView(Recorder* recorder
 
 
     // setup MipLevels
-    sk_sp<SkMipmap> mipmaps;
-    std::vector<MipLevel> texels;
+    std::vector<MipLevel>& texels = upload->fTexels;
     if (mipLevelCount == 1) {
         texels.resize(mipLevelCount);
         texels[0].fPixels = bmpToUpload.getPixels();
         texels[0].fRowBytes = bmpToUpload.rowBytes();
     } else {
+        sk_sp<SkMipmap>& mipmaps = upload->fMipmaps;
         mipmaps = SkToBool(mipmapsIn)
                           ? mipmapsIn
                           : sk_sp<SkMipmap>(SkMipmap::Build(bmpToUpload.pixmap(), nullptr));
         if (!mipmaps) {
-            return {};
+            return false;
         }
 
         SkASSERT(mipLevelCount == mipmaps->countLevels() + 1);
@@ -448,37 +462,70 @@ std::tuple<TextureProxyView, SkColorType> MakeBitmapProxyView(Recorder* recorder
         }
     }
 
+    Swizzle swizzle = caps->getReadSwizzle(ct, textureInfo);
+    // If the color type is alpha-only, propagate the alpha value to the other channels.
+    if (SkColorTypeIsAlphaOnly(ct)) {
+        swizzle = Swizzle::Concat(swizzle, Swizzle("aaaa"));
+    }
+
+    upload->fColorType = ct;
+    upload->fTextureInfo = textureInfo;
+    upload->fReadSwizzle = swizzle;
+    return true;
+}
+
+std::tuple<TextureProxyView, SkColorType> MakeBitmapProxyView(Recorder* recorder,
+                                                              const SkBitmap& bitmap,
+                                                              sk_sp<SkMipmap> mipmapsIn,
+                                                              Mipmapped mipmapped,
+                                                              Budgeted budgeted,
+                                                              std::string_view label) {
+    const Caps* caps = recorder->priv().caps();
+    // The upload may be written after this returns, so the prepared upload is ref-counted to keep
+    // its pixels alive until then.
+    auto preparedOwner = sk_make_sp<RefCntedBitmapUpload>();
+    BitmapUpload& prepared = preparedOwner->fUpload;
+    if (!PrepareBitmapUpload(caps, recorder->priv().isProtected(), bitmap, std::move(mipmapsIn),
+                             mipmapped, &prepared)) {
+        return {};
+    }
+    const SkBitmap& bmpToUpload = prepared.fBitmap;
+    const SkColorType ct = prepared.fColorType;
+
     // Create proxy
     sk_sp<TextureProxy> proxy = TextureProxy::Make(caps,
                                                    recorder->priv().resourceProvider(),
                                                    bmpToUpload.dimensions(),
-                                                   textureInfo,
+                                                   prepared.fTextureInfo,
                                                    std::move(label),
                                                    budgeted);
     if (!proxy) {
         return {};
     }
     SkASSERT(caps->areColorTypeAndTextureInfoCompatible(ct, proxy->textureInfo()));
-    SkASSERT(mipmapped == Mipmapped::kNo || proxy->mipmapped() == Mipmapped::kYes);
+    SkASSERT(mipmapped == Mipmapped::kNo || bitmap.dimensions().area() <= 1 ||
+             proxy->mipmapped() == Mipmapped::kYes);
 
     // Src and dst colorInfo are the same
     const SkColorInfo& colorInfo = bmpToUpload.info().colorInfo();
+    // Only an immutable pixel ref promises its pixels stay valid and unchanged for as long as it
+    // is referenced. Other pixels, like those installed over client memory, must be read now.
+    sk_sp<SkRefCnt> pixelsOwner;
+    if (bmpToUpload.isImmutable()) {
+        pixelsOwner = std::move(preparedOwner);
+    }
     // Add UploadTask to Recorder
     UploadInstance upload = UploadInstance::Make(
-            recorder, proxy, colorInfo, colorInfo, texels,
-            SkIRect::MakeSize(bmpToUpload.dimensions()), std::make_unique<ImageUploadContext>());
+            recorder, proxy, colorInfo, colorInfo, prepared.fTexels,
+            SkIRect::MakeSize(bmpToUpload.dimensions()), std::make_unique<ImageUploadContext>(),
+            std::move(pixelsOwner));
     if (!upload.isValid()) {
         SKGPU_LOG_E("MakeBitmapProxyView: Could not create UploadInstance");
         return {};
     }
     recorder->priv().add(UploadTask::Make(std::move(upload)));
 
-    Swizzle swizzle = caps->getReadSwizzle(ct, textureInfo);
-    // If the color type is alpha-only, propagate the alpha value to the other channels.
-    if (SkColorTypeIsAlphaOnly(colorInfo.colorType())) {
-        swizzle = Swizzle::Concat(swizzle, Swizzle("aaaa"));
-    }
-    return {{std::move(proxy), swizzle}, ct};
+    return {{std::move(proxy), prepared.fReadSwizzle}, ct};
 }
 
 sk_sp<TextureProxy> MakePromiseImageLazyProxy(
@@ -813,6 +860,9 @@ std::pair<sk_sp<SkImage>, SkSamplingOptions> GetGraphiteBacked(Recorder* recorde
             mipmapped = Mipmapped::kNo;
             sampling = SkSamplingOptions(SkFilterMode::kLinear, SkMipmapMode::kNone);
         }
+    } else if (SharedImageCache* imageCache = recorder->priv().sharedContext()->sharedImageCache();
+               imageCache && as_IB(imageIn)->isRasterBacked()) {
+        result = imageCache->findOrCreate(recorder, imageIn, mipmapped);
     } else {
         auto clientImageProvider = recorder->clientImageProvider();
         result = clientImageProvider->findOrCreate(
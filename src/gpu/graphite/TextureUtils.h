@@ -8,17 +8,22 @@
 #ifndef skgpu_graphite_TextureUtils_DEFINED
 #define skgpu_graphite_TextureUtils_DEFINED
 
+#include "include/core/SkBitmap.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkRefCnt.h"
 #include "include/gpu/GpuTypes.h"
 #include "include/gpu/graphite/Image.h"
+#include "include/gpu/graphite/TextureInfo.h"
+#include "src/gpu/Swizzle.h"
+#include "src/gpu/graphite/ResourceTypes.h"
 #include "src/gpu/graphite/TextureProxyView.h"
+#include "src/gpu/graphite/task/UploadTask.h"
 
 #include <functional>
 #include <tuple>
 #include <utility>
+#include <vector>
 
-class SkBitmap;
 enum SkColorType : int;
 class SkImage;
 struct SkImageInfo;
@@ -36,6 +41,26 @@ class Image;
 class Recorder;
 class TextureProxyView;
 
+// The pixels of a bitmap ready to upload to a sampled texture: converted to a color type the
+// texture can hold if the bitmap's can't be, and with its mip levels built if they're needed.
+// 'fTexels' points into 'fBitmap' and 'fMipmaps'.
+struct BitmapUpload {
+    SkColorType fColorType;
+    TextureInfo fTextureInfo;
+    Swizzle fReadSwizzle;
+    SkBitmap fBitmap;
+    sk_sp<SkMipmap> fMipmaps;
+    std::vector<MipLevel> fTexels;
+};
+
+// Returns false if the pixels couldn't be converted or the mip levels couldn't be built.
+bool PrepareBitmapUpload(const Caps*,
+                         Protected,
+                         const SkBitmap&,
+                         sk_sp<SkMipmap>,
+                         Mipmapped,
+                         BitmapUpload*);
+
 // Create TextureProxyView and SkColorType pair using pixel data in SkBitmap,
 // adding any necessary copy commands to Recorder
 std::tuple<TextureProxyView, SkColorType> MakeBitmapProxyView(Recorder*,
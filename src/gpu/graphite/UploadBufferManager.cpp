@@ -20,11 +20,25 @@ namespace skgpu::graphite {
 static constexpr size_t kReusedBufferSize = 64 << 10;  // 64 KB
 
 UploadBufferManager::UploadBufferManager(ResourceProvider* resourceProvider,
-                                         const Caps* caps)
+                                         const Caps* caps,
+                                         SkExecutor* uploadExecutor)
         : fResourceProvider(resourceProvider)
+        , fUploadExecutor(uploadExecutor)
         , fMinAlignment(caps->requiredTransferBufferAlignment()) {}
 
-UploadBufferManager::~UploadBufferManager() {}
+UploadBufferManager::~UploadBufferManager() {
+    // Writes still pending must finish before their buffers can be released.
+    if (fPendingWrites) {
+        fPendingWrites->wait();
+    }
+}
+
+PendingUploadWrites* UploadBufferManager::pendingWrites() {
+    if (fUploadExecutor && !fPendingWrites) {
+        fPendingWrites = sk_make_sp<PendingUploadWrites>(*fUploadExecutor);
+    }
+    return fPendingWrites.get();
+}
 
 std::tuple<TextureUploadWriter, BindBufferInfo> UploadBufferManager::getTextureUploadWriter(
         size_t requiredBytes, size_t requiredAlignment) {
@@ -35,6 +49,7 @@ std::tuple<TextureUploadWriter, BindBufferInfo> UploadBufferManager::getTextureU
         return {TextureUploadWriter(), BindBufferInfo()};
     }
 
+    fTextureBytesWritten += requiredBytes;
     return {TextureUploadWriter(bufferMapPtr, requiredBytes), bindInfo};
 }
 
@@ -102,19 +117,29 @@ std::tuple<void*/*mappedPtr*/, BindBufferInfo> UploadBufferManager::makeBindInfo
 }
 
 void UploadBufferManager::transferToRecording(Recording* recording) {
-    for (sk_sp<Buffer>& buffer : fUsedBuffers) {
-        buffer->unmap();
-        recording->priv().addResourceRef(std::move(buffer));
-    }
-    fUsedBuffers.clear();
-
+    fTextureBytesWritten = 0;
     if (fReusedBuffer) {
-        fReusedBuffer->unmap();
-        recording->priv().addResourceRef(std::move(fReusedBuffer));
+        fUsedBuffers.push_back(std::move(fReusedBuffer));
     }
+    if (fPendingWrites) {
+        // The Recording unmaps the buffers once the writes are done.
+        recording->priv().setPendingUploadWrites(std::move(fPendingWrites),
+                                                 std::move(fUsedBuffers));
+    } else {
+        for (sk_sp<Buffer>& buffer : fUsedBuffers) {
+            buffer->unmap();
+            recording->priv().addResourceRef(std::move(buffer));
+        }
+    }
+    fUsedBuffers.clear();
 }
 
 void UploadBufferManager::transferToCommandBuffer(CommandBuffer* commandBuffer) {
+    fTextureBytesWritten = 0;
+    if (fPendingWrites) {
+        fPendingWrites->wait();
+        fPendingWrites.reset();
+    }
     for (sk_sp<Buffer>& buffer : fUsedBuffers) {
         buffer->unmap();
         commandBuffer->trackResource(std::move(buffer));
@@ -9,9 +9,11 @@
 #define skgpu_graphite_UploadBufferManager_DEFINED
 
 #include "include/core/SkRefCnt.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/gpu/BufferWriter.h"
 #include "src/gpu/graphite/DrawTypes.h"
 
+#include <functional>
 #include <string_view>
 #include <tuple>
 #include <vector>
@@ -24,18 +26,41 @@ class CommandBuffer;
 class Recording;
 class ResourceProvider;
 
+// The writes into mapped upload buffers that run on a Recorder's upload executor. The buffers they
+// write to must stay mapped until wait() returns, which is why a Recording that has pending writes
+// leaves its upload buffers mapped until the Context inserts it.
+class PendingUploadWrites : public SkRefCnt {
+public:
+    explicit PendingUploadWrites(SkExecutor& executor) : fWrites(executor) {}
+    ~PendingUploadWrites() override { this->wait(); }
+
+    void add(std::function<void()> write) { fWrites.add(std::move(write)); }
+    void wait() { fWrites.wait(); }
+
+private:
+    SkTaskGroup fWrites;
+};
+
 class UploadBufferManager {
 public:
-    UploadBufferManager(ResourceProvider*, const Caps*);
+    // If 'uploadExecutor' isn't null, uploads may write to their buffers on it.
+    UploadBufferManager(ResourceProvider*, const Caps*, SkExecutor* uploadExecutor = nullptr);
     ~UploadBufferManager();
 
     std::tuple<TextureUploadWriter, BindBufferInfo> getTextureUploadWriter(
             size_t requiredBytes, size_t requiredAlignment);
 
+    // Null if there's no upload executor. Otherwise the writes added to it go to the buffers that
+    // the next call to transferToRecording() hands to the Recording.
+    PendingUploadWrites* pendingWrites();
+
     // Finalizes all buffers and transfers ownership of them to a Recording.
     void transferToRecording(Recording*);
     void transferToCommandBuffer(CommandBuffer*);
 
+    // The bytes handed out by getTextureUploadWriter() since the buffers were last transferred.
+    size_t textureBytesWritten() const { return fTextureBytesWritten; }
+
 private:
     friend class DrawBufferManager; // to access makeBindInfo
     friend class StaticBufferManager; // to access makeBindInfo
@@ -46,12 +71,16 @@ private:
                                                                 std::string_view label);
 
     ResourceProvider* fResourceProvider;
+    SkExecutor* fUploadExecutor;
+    sk_sp<PendingUploadWrites> fPendingWrites;
 
     sk_sp<Buffer> fReusedBuffer;
     size_t fMinAlignment;
     size_t fReusedBufferOffset = 0;
 
     std::vector<sk_sp<Buffer>> fUsedBuffers;
+
+    size_t fTextureBytesWritten = 0;
 };
 
 }  // namespace skgpu::graphite
@@ -0,0 +1,353 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/gpu/graphite/compute/ComputeBlur.h"
+
+#include "include/core/SkColorSpace.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkSurfaceProps.h"
+#include "src/base/SkNoDestructor.h"
+#include "src/core/SkSpecialImage.h"
+#include "src/gpu/BlurUtils.h"
+#include "src/gpu/graphite/BufferManager.h"
+#include "src/gpu/graphite/Caps.h"
+#include "src/gpu/graphite/Image_Base_Graphite.h"
+#include "src/gpu/graphite/Image_Graphite.h"
+#include "src/gpu/graphite/PipelineData.h"
+#include "src/gpu/graphite/RecorderPriv.h"
+#include "src/gpu/graphite/SpecialImage_Graphite.h"
+#include "src/gpu/graphite/TextureProxy.h"
+#include "src/gpu/graphite/TextureUtils.h"
+#include "src/gpu/graphite/UniformManager.h"
+#include "src/gpu/graphite/compute/ComputeStep.h"
+#include "src/gpu/graphite/compute/DispatchGroup.h"
+#include "src/gpu/graphite/task/ComputeTask.h"
+
+#include <cmath>
+
+namespace skgpu::graphite {
+namespace {
+
+// Each workgroup box blurs one row (or column) of its output.
+constexpr uint32_t kWorkgroupSize = 256;
+
+// The horizontal pass reads the source image and writes the intermediate texture, which the
+// vertical pass reads from to write the output.
+enum Slot : int {
+    kSource = 0,
+    kIntermediate = 1,
+    kOutput = 2,
+    kHorizontalUniforms = 3,
+    kVerticalUniforms = 4,
+};
+
+class BlurComputeStep final : public ComputeStep {
+public:
+    enum class Axis { kX, kY };
+
+    explicit BlurComputeStep(Axis axis)
+            : ComputeStep(
+                      /*name=*/axis == Axis::kX ? "BoxBlurX" : "BoxBlurY",
+                      /*localDispatchSize=*/{kWorkgroupSize, 1, 1},
+                      /*resources=*/{
+                          {
+                              /*type=*/ResourceType::kUniformBuffer,
+                              /*flow=*/DataFlow::kShared,
+                              /*policy=*/ResourcePolicy::kMapped,
+                              /*slot=*/axis == Axis::kX ? kHorizontalUniforms : kVerticalUniforms,
+                              /*sksl=*/"uniformBlock { int4 bounds; int4 params; int4 radii; }",
+                          },
+                          {
+                              /*type=*/ResourceType::kReadOnlyTexture,
+                              /*flow=*/DataFlow::kShared,
+                              /*policy=*/ResourcePolicy::kNone,
+                              /*slot=*/axis == Axis::kX ? kSource : kIntermediate,
+                              /*sksl=*/"src",
+                          },
+                          {
+                              /*type=*/ResourceType::kWriteOnlyStorageTexture,
+                              /*flow=*/DataFlow::kShared,
+                              /*policy=*/ResourcePolicy::kNone,
+                              /*slot=*/axis == Axis::kX ? kIntermediate : kOutput,
+                              /*sksl=*/"dst",
+                          },
+                      })
+            , fAxis(axis) {}
+    ~BlurComputeStep() override = default;
+
+    // 'bounds' are the texels of 'src' that can be read, and 'params.w' is the SkTileMode that
+    // applies outside of them. The line of workgroup i starts at (params.x, params.y + i) in 'src'
+    // along the blur axis, is 'params.z' pixels long and is written to line i of 'dst'. 'radii'
+    // holds the three box radii and, last, their sum.
+    std::string computeSkSL() const override {
+        std::string sksl = fAxis == Axis::kX
+                ? "int2 axis_coord(int along, int across) { return int2(along, across); }\n"
+                : "int2 axis_coord(int along, int across) { return int2(across, along); }\n";
+        sksl += R"(
+            const int kThreads = 256;
+            const int kMaxChunk = 8;
+
+            workgroup half4 line[2048];
+
+            int tile(int c, int lo, int hi, int mode) {
+                int n = hi - lo;
+                if (mode == 1) {
+                    return lo + ((c - lo) % n + n) % n;
+                }
+                if (mode == 2) {
+                    int t = ((c - lo) % (2 * n) + 2 * n) % (2 * n);
+                    return lo + (t < n ? t : 2 * n - 1 - t);
+                }
+                // Clamp, and decal once the caller has checked that c is in bounds.
+                return clamp(c, lo, hi - 1);
+            }
+
+            void main() {
+                int lineIndex = int(sk_WorkgroupID.x);
+                int tid = int(sk_LocalInvocationIndex);
+                int n = params.z + 2 * radii.w;
+
+                for (int i = tid; i < n; i += kThreads) {
+                    int2 coord = axis_coord(params.x - radii.w + i, params.y + lineIndex);
+                    half4 texel = half4(0);
+                    if (params.w != 3 || (all(greaterThanEqual(coord, bounds.xy)) &&
+                                          all(lessThan(coord, bounds.zw)))) {
+                        coord = int2(tile(coord.x, bounds.x, bounds.z, params.w),
+                                     tile(coord.y, bounds.y, bounds.w, params.w));
+                        texel = textureRead(src, uint2(coord));
+                    }
+                    line[i] = texel;
+                }
+                workgroupBarrier();
+
+                // Every box shrinks the span of pixels that are blurred correctly by its radius on
+                // either side, leaving the pixels of the output line once all three are applied.
+                // Each thread slides the box over a run of at most kMaxChunk of them, summing in
+                // full precision.
+                int lo = 0;
+                for (int box = 0; box < 3; ++box) {
+                    int r = box == 0 ? radii.x : (box == 1 ? radii.y : radii.z);
+                    lo += r;
+                    int chunk = (n - 2 * lo + kThreads - 1) / kThreads;
+                    int start = lo + tid * chunk;
+                    int end = min(start + chunk, n - lo);
+                    half4 boxed[kMaxChunk];
+                    if (r > 0 && start < end) {
+                        float4 sum = float4(0);
+                        for (int k = start - r; k <= start + r; ++k) {
+                            sum += float4(line[k]);
+                        }
+                        float scale = 1.0 / float(2 * r + 1);
+                        for (int i = start; i < end; ++i) {
+                            boxed[i - start] = half4(sum * scale);
+                            if (i + 1 < end) {
+                                sum += float4(line[i + r + 1]) - float4(line[i - r]);
+                            }
+                        }
+                    }
+                    workgroupBarrier();
+                    if (r > 0) {
+                        for (int i = start; i < end; ++i) {
+                            line[i] = boxed[i - start];
+                        }
+                    }
+                    workgroupBarrier();
+                }
+
+                for (int i = tid; i < params.z; i += kThreads) {
+                    textureWrite(dst, uint2(axis_coord(i, lineIndex)), line[radii.w + i]);
+                }
+            }
+        )";
+        return sksl;
+    }
+
+    std::tuple<SkISize, SkColorType> calculateTextureParameters(
+            int index, const ResourceDesc&) const override {
+        // ComputeBlur() assigns both textures to the DispatchGroup, so only the color type is
+        // used, to check that the assigned texture has the right format.
+        SkASSERT(index == 2);
+        return {SkISize::MakeEmpty(), kRGBA_8888_SkColorType};
+    }
+
+private:
+    const Axis fAxis;
+};
+
+// The steps are shared by every Recorder so that their pipelines are only compiled once.
+const BlurComputeStep* blur_step(BlurComputeStep::Axis axis) {
+    static const SkNoDestructor<BlurComputeStep> kX(BlurComputeStep::Axis::kX);
+    static const SkNoDestructor<BlurComputeStep> kY(BlurComputeStep::Axis::kY);
+    return axis == BlurComputeStep::Axis::kX ? kX.get() : kY.get();
+}
+
+bool assign_uniforms(Recorder* recorder,
+                     DispatchGroup::Builder* builder,
+                     Slot slot,
+                     const SkIRect& bounds,
+                     const SkIRect& params,
+                     const std::array<int, 3>& radii) {
+    const auto& bindingReqs = recorder->priv().caps()->resourceBindingRequirements();
+    UniformManager mgr(bindingReqs.fUniformBufferLayout);
+    SkDEBUGCODE(
+        const Uniform uniforms[] = {{"bounds", SkSLType::kInt4},
+                                    {"params", SkSLType::kInt4},
+                                    {"radii",  SkSLType::kInt4}};
+        mgr.setExpectedUniforms(uniforms);
+    )
+    mgr.write(bounds);
+    mgr.write(params);
+    mgr.write(SkIRect::MakeLTRB(radii[0], radii[1], radii[2], radii[0] + radii[1] + radii[2]));
+    SkDEBUGCODE(mgr.doneWithExpectedUniforms();)
+
+    UniformDataBlock dataBlock = mgr.finishUniformDataBlock();
+    auto [writer, bufInfo] =
+            recorder->priv().drawBufferManager()->getUniformWriter(dataBlock.size());
+    if (!bufInfo) {
+        return false;
+    }
+    writer.write(dataBlock.data(), dataBlock.size());
+    builder->assignSharedBuffer({bufInfo, dataBlock.size()}, slot);
+    return true;
+}
+
+bool can_blur_axis(float sigma) {
+    return BlurSigmaRadius(sigma) == 0 || sigma >= kMinComputeBlurSigma;
+}
+
+}  // anonymous namespace
+
+std::array<int, 3> ComputeBlurBoxRadii(float sigma) {
+    // The widths of n boxes whose variances, (w^2 - 1) / 12, add up to sigma^2 as closely as two
+    // neighbouring odd widths allow (see "Fast Almost-Gaussian Filtering", Kovesi 2010).
+    constexpr int kBoxes = 3;
+    const float variance = sigma * sigma;
+    int lower = static_cast<int>(std::floor(std::sqrt(12.f * variance / kBoxes + 1.f)));
+    if (lower % 2 == 0) {
+        lower--;
+    }
+    lower = std::max(lower, 1);
+    int numLower = static_cast<int>(std::round(
+            (12.f * variance - kBoxes * lower * lower - 4.f * kBoxes * lower - 3.f * kBoxes) /
+            (-4.f * lower - 4.f)));
+    numLower = std::clamp(numLower, 0, kBoxes);
+
+    std::array<int, 3> radii;
+    for (int i = 0; i < kBoxes; ++i) {
+        radii[i] = i < numLower ? (lower - 1) / 2 : (lower + 1) / 2;
+    }
+    return radii;
+}
+
+sk_sp<SkSpecialImage> ComputeBlur(Recorder* recorder,
+                                  SkSize sigma,
+                                  const sk_sp<SkSpecialImage>& input,
+                                  const SkIRect& srcRect,
+                                  SkTileMode tileMode,
+                                  const SkIRect& dstRect,
+                                  const sk_sp<SkColorSpace>& outCS,
+                                  const SkSurfaceProps& outProps) {
+    const Caps* caps = recorder->priv().caps();
+    if (!caps->computeSupport() ||
+        !can_blur_axis(sigma.width()) || !can_blur_axis(sigma.height()) ||
+        std::max(sigma.width(), sigma.height()) < kMinComputeBlurSigma) {
+        return nullptr;
+    }
+
+    const std::array<int, 3> radiiX =
+            ComputeBlurBoxRadii(BlurSigmaRadius(sigma.width()) ? sigma.width() : 0.f);
+    const std::array<int, 3> radiiY =
+            ComputeBlurBoxRadii(BlurSigmaRadius(sigma.height()) ? sigma.height() : 0.f);
+    const int radiusX = radiiX[0] + radiiX[1] + radiiX[2];
+    const int radiusY = radiiY[0] + radiiY[1] + radiiY[2];
+    if (dstRect.isEmpty() ||
+        dstRect.width() + 2 * radiusX > kMaxComputeBlurSpan ||
+        dstRect.height() + 2 * radiusY > kMaxComputeBlurSpan) {
+        return nullptr;
+    }
+
+    // Storage textures are always declared as rgba8 in compute SkSL, and the blur reads texels as
+    // they are stored, so the input must be RGBA 8888 without a read swizzle.
+    if (input->colorType() != kRGBA_8888_SkColorType ||
+        !SkColorSpace::Equals(input->getColorSpace(), outCS.get())) {
+        return nullptr;
+    }
+    sk_sp<SkImage> inputImage = input->asImage();
+    TextureProxyView inputView = AsView(inputImage.get());
+    if (!inputView || inputView.origin() != Origin::kTopLeft ||
+        inputView.swizzle() != Swizzle::RGBA() || inputView.proxy()->isProtected()) {
+        return nullptr;
+    }
+    const TextureInfo storageInfo = caps->getDefaultStorageTextureInfo(kRGBA_8888_SkColorType);
+    if (!caps->isStorage(storageInfo)) {
+        return nullptr;
+    }
+
+    // The intermediate texture holds the horizontally blurred rows that the vertical pass reads,
+    // so every row that any output pixel needs is blurred, with the tile mode applied to both axes
+    // then.
+    const SkISize intermediateSize = {dstRect.width(), dstRect.height() + 2 * radiusY};
+    sk_sp<TextureProxy> intermediate = TextureProxy::Make(caps,
+                                                          recorder->priv().resourceProvider(),
+                                                          intermediateSize,
+                                                          storageInfo,
+                                                          "ComputeBlurIntermediateTexture",
+                                                          skgpu::Budgeted::kYes);
+    sk_sp<TextureProxy> output = TextureProxy::Make(caps,
+                                                    recorder->priv().resourceProvider(),
+                                                    dstRect.size(),
+                                                    storageInfo,
+                                                    "ComputeBlurOutputTexture",
+                                                    skgpu::Budgeted::kYes);
+    if (!intermediate || !output) {
+        return nullptr;
+    }
+
+    // srcRect and dstRect are relative to the subset of the input's texture.
+    const SkIPoint subsetOrigin = input->subset().topLeft();
+    const SkIRect srcBounds = srcRect.makeOffset(subsetOrigin);
+    const SkIPoint dstOrigin = dstRect.topLeft() + subsetOrigin;
+
+    DispatchGroup::Builder builder(recorder);
+    builder.assignSharedTexture(inputView.refProxy(), kSource);
+    builder.assignSharedTexture(intermediate, kIntermediate);
+    builder.assignSharedTexture(output, kOutput);
+    if (!assign_uniforms(recorder, &builder, kHorizontalUniforms, srcBounds,
+                         SkIRect::MakeLTRB(dstOrigin.x(), dstOrigin.y() - radiusY,
+                                           dstRect.width(), static_cast<int>(tileMode)),
+                         radiiX) ||
+        !assign_uniforms(recorder, &builder, kVerticalUniforms,
+                         SkIRect::MakeSize(intermediateSize),
+                         SkIRect::MakeLTRB(radiusY, 0, dstRect.height(),
+                                           static_cast<int>(SkTileMode::kClamp)),
+                         radiiY) ||
+        !builder.appendStep(blur_step(BlurComputeStep::Axis::kX),
+                            WorkgroupSize(intermediateSize.height(), 1, 1)) ||
+        !builder.appendStep(blur_step(BlurComputeStep::Axis::kY),
+                            WorkgroupSize(dstRect.width(), 1, 1))) {
+        return nullptr;
+    }
+
+    // Any draws that render the input have to be recorded ahead of the dispatches.
+    static_cast<Image_Base*>(inputImage.get())->notifyInUse(recorder, /*drawContext=*/nullptr);
+
+    ComputeTask::DispatchGroupList groups;
+    groups.push_back(builder.finalize());
+    recorder->priv().add(ComputeTask::Make(std::move(groups)));
+
+    const SkColorInfo outColorInfo(kRGBA_8888_SkColorType, kPremul_SkAlphaType, outCS);
+    sk_sp<SkImage> outputImage = sk_make_sp<Image>(
+            TextureProxyView(std::move(output),
+                             caps->getReadSwizzle(kRGBA_8888_SkColorType, storageInfo)),
+            outColorInfo);
+    return SkSpecialImages::MakeGraphite(recorder,
+                                         SkIRect::MakeSize(dstRect.size()),
+                                         std::move(outputImage),
+                                         outProps);
+}
+
+}  // namespace skgpu::graphite
@@ -0,0 +1,58 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef skgpu_graphite_compute_ComputeBlur_DEFINED
+#define skgpu_graphite_compute_ComputeBlur_DEFINED
+
+#include "include/core/SkRect.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkSize.h"
+#include "include/core/SkTileMode.h"
+
+#include <array>
+
+class SkColorSpace;
+class SkSpecialImage;
+class SkSurfaceProps;
+
+namespace skgpu::graphite {
+
+class Recorder;
+
+// Blurs with a sigma at least this large are done with compute shaders when the Recorder's
+// backend supports them. Below it the shader blurs, which sample a downscaled image once sigma is
+// past kMaxLinearBlurSigma, need less work per pixel.
+static constexpr float kMinComputeBlurSigma = 20.f;
+
+// The most pixels a compute blur workgroup can hold in workgroup memory: a row (or column) of the
+// output plus the blur radius on either side. 2048 half4s are 16KB, the least that WebGPU allows.
+static constexpr int kMaxComputeBlurSpan = 2048;
+
+// Returns the radii of the three box blurs that, applied one after another, approximate a Gaussian
+// blur with 'sigma'.
+std::array<int, 3> ComputeBlurBoxRadii(float sigma);
+
+// Blurs 'srcRect' of 'input' into an image the size of 'dstRect', with the same meaning as the
+// arguments of SkBlurEngine::Algorithm::blur(), using two compute passes of three box blurs each.
+// Every workgroup loads a row (or column) into workgroup memory and slides the boxes over it, so
+// the blur reads each source pixel once whatever the sigma.
+//
+// Returns null, having recorded nothing, if the Recorder's backend can't run compute shaders, if
+// either sigma is positive but below kMinComputeBlurSigma, if a row or column doesn't fit in
+// kMaxComputeBlurSpan, or if 'input' isn't an RGBA 8888 texture in 'outCS'.
+sk_sp<SkSpecialImage> ComputeBlur(Recorder*,
+                                  SkSize sigma,
+                                  const sk_sp<SkSpecialImage>& input,
+                                  const SkIRect& srcRect,
+                                  SkTileMode,
+                                  const SkIRect& dstRect,
+                                  const sk_sp<SkColorSpace>& outCS,
+                                  const SkSurfaceProps&);
+
+}  // namespace skgpu::graphite
+
+#endif  // skgpu_graphite_compute_ComputeBlur_DEFINED
@@ -417,7 +417,7 @@ bool DawnCommandBuffer::addDrawPass(const DrawPass* drawPass) {
             }
             case DrawPassCommands::Type::kBindUniformBuffer: {
                 auto bub = static_cast<DrawPassCommands::BindUniformBuffer*>(cmdPtr);
-                this->bindUniformBuffer(bub->fInfo, bub->fSlot);
+                this->bindUniformBuffer(this->remapUniformBuffer(bub->fInfo), bub->fSlot);
                 break;
             }
             case DrawPassCommands::Type::kBindDrawBuffers: {
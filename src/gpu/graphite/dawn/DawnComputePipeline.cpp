@@ -14,6 +14,7 @@
 #include "src/gpu/graphite/dawn/DawnAsyncWait.h"
 #include "src/gpu/graphite/dawn/DawnErrorChecker.h"
 #include "src/gpu/graphite/dawn/DawnGraphiteUtilsPriv.h"
+#include "src/gpu/graphite/dawn/DawnShaderModuleCache.h"
 #include "src/gpu/graphite/dawn/DawnSharedContext.h"
 #include "src/gpu/graphite/dawn/DawnUtilsPriv.h"
 #include "src/sksl/SkSLProgramSettings.h"
@@ -54,19 +55,18 @@ static ShaderInfo compile_shader_module(const DawnSharedContext* sharedContext,
         SkSL::ProgramSettings settings;
 
         std::string sksl = BuildComputeSkSL(caps, step);
-        if (skgpu::SkSLToWGSL(caps->shaderCaps(),
-                              sksl,
-                              SkSL::ProgramKind::kCompute,
-                              settings,
-                              &wgsl,
-                              &interface,
-                              errorHandler)) {
-            if (!DawnCompileWGSLShaderModule(sharedContext, step->name(), wgsl,
-                                             &info.fModule, errorHandler)) {
-                return {};
-            }
-            info.fEntryPoint = "main";
+        if (!sharedContext->shaderModuleCache()->findOrCreate(sharedContext,
+                                                             step->name(),
+                                                             sksl,
+                                                             SkSL::ProgramKind::kCompute,
+                                                             settings,
+                                                             &info.fModule,
+                                                             &wgsl,
+                                                             &interface,
+                                                             errorHandler)) {
+            return {};
         }
+        info.fEntryPoint = "main";
     }
 
     return info;
@@ -21,6 +21,7 @@
 #include "src/gpu/graphite/dawn/DawnErrorChecker.h"
 #include "src/gpu/graphite/dawn/DawnGraphiteUtilsPriv.h"
 #include "src/gpu/graphite/dawn/DawnResourceProvider.h"
+#include "src/gpu/graphite/dawn/DawnShaderModuleCache.h"
 #include "src/gpu/graphite/dawn/DawnSharedContext.h"
 #include "src/gpu/graphite/dawn/DawnUtilsPriv.h"
 #include "src/sksl/SkSLProgramSettings.h"
@@ -297,19 +298,21 @@ sk_sp<DawnGraphicsPipeline> DawnGraphicsPipeline::Make(const DawnSharedContext*
     const bool localCoordsNeeded = fsSkSLInfo.fRequiresLocalCoords;
     const int numTexturesAndSamplers = fsSkSLInfo.fNumTexturesAndSamplers;
 
+    // Pipelines that only differ in their render pass or vertex state share their shaders, so the
+    // WGSL and shader modules come from the cache when possible.
+    DawnShaderModuleCache* moduleCache = sharedContext->shaderModuleCache();
+
     bool hasFragmentSkSL = !fsSkSL.empty();
     if (hasFragmentSkSL) {
-        if (!skgpu::SkSLToWGSL(caps.shaderCaps(),
-                               fsSkSL,
-                               SkSL::ProgramKind::kGraphiteFragment,
-                               settings,
-                               &fsCode,
-                               &fsInterface,
-                               errorHandler)) {
-            return {};
-        }
-        if (!DawnCompileWGSLShaderModule(sharedContext, fsSkSLInfo.fLabel.c_str(), fsCode,
-                                         &fsModule, errorHandler)) {
+        if (!moduleCache->findOrCreate(sharedContext,
+                                       fsSkSLInfo.fLabel.c_str(),
+                                       fsSkSL,
+                                       SkSL::ProgramKind::kGraphiteFragment,
+                                       settings,
+                                       &fsModule,
+                                       &fsCode,
+                                       &fsInterface,
+                                       errorHandler)) {
             return {};
         }
     }
@@ -319,17 +322,15 @@ sk_sp<DawnGraphicsPipeline> DawnGraphicsPipeline::Make(const DawnSharedContext*
                                               useStorageBuffers,
                                               localCoordsNeeded);
     const std::string& vsSkSL = vsSkSLInfo.fSkSL;
-    if (!skgpu::SkSLToWGSL(caps.shaderCaps(),
-                           vsSkSL,
-                           SkSL::ProgramKind::kGraphiteVertex,
-                           settings,
-                           &vsCode,
-                           &vsInterface,
-                           errorHandler)) {
-        return {};
-    }
-    if (!DawnCompileWGSLShaderModule(sharedContext, vsSkSLInfo.fLabel.c_str(), vsCode,
-                                     &vsModule, errorHandler)) {
+    if (!moduleCache->findOrCreate(sharedContext,
+                                   vsSkSLInfo.fLabel.c_str(),
+                                   vsSkSL,
+                                   SkSL::ProgramKind::kGraphiteVertex,
+                                   settings,
+                                   &vsModule,
+                                   &vsCode,
+                                   &vsInterface,
+                                   errorHandler)) {
         return {};
     }
 
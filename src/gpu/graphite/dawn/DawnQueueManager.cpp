@@ -128,12 +128,13 @@ std::unique_ptr<CommandBuffer> DawnQueueManager::getNewCommandBuffer(
                                    static_cast<DawnResourceProvider*>(resourceProvider));
 }
 
-QueueManager::OutstandingSubmission DawnQueueManager::onSubmitToGpu() {
-    SkASSERT(fCurrentCommandBuffer);
-    DawnCommandBuffer* dawnCmdBuffer = static_cast<DawnCommandBuffer*>(fCurrentCommandBuffer.get());
+QueueManager::OutstandingSubmission DawnQueueManager::onSubmitToGpu(
+        std::unique_ptr<CommandBuffer> commandBuffer) {
+    SkASSERT(commandBuffer);
+    DawnCommandBuffer* dawnCmdBuffer = static_cast<DawnCommandBuffer*>(commandBuffer.get());
     auto wgpuCmdBuffer = dawnCmdBuffer->finishEncoding();
     if (!wgpuCmdBuffer) {
-        fCurrentCommandBuffer->callFinishedProcs(/*success=*/false);
+        commandBuffer->callFinishedProcs(/*success=*/false);
         return nullptr;
     }
 
@@ -141,9 +142,9 @@ QueueManager::OutstandingSubmission DawnQueueManager::onSubmitToGpu() {
 
 #if defined(__EMSCRIPTEN__)
     return std::make_unique<DawnWorkSubmissionWithAsyncWait>(
-            std::move(fCurrentCommandBuffer), this, dawnSharedContext());
+            std::move(commandBuffer), this, dawnSharedContext());
 #else
-    return std::make_unique<DawnWorkSubmissionWithFuture>(std::move(fCurrentCommandBuffer), this);
+    return std::make_unique<DawnWorkSubmissionWithFuture>(std::move(commandBuffer), this);
 #endif
 }
 
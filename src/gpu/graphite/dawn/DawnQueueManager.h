@@ -30,7 +30,7 @@ private:
     const DawnSharedContext* dawnSharedContext() const;
 
     std::unique_ptr<CommandBuffer> getNewCommandBuffer(ResourceProvider*) override;
-    OutstandingSubmission onSubmitToGpu() override;
+    OutstandingSubmission onSubmitToGpu(std::unique_ptr<CommandBuffer>) override;
 
 #if defined(GRAPHITE_TEST_UTILS)
     void startCapture() override;
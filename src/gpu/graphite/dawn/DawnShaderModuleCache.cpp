@@ -0,0 +1,283 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/gpu/graphite/dawn/DawnShaderModuleCache.h"
+
+#include "include/core/SkMilestone.h"
+#include "include/core/SkStream.h"
+#include "include/gpu/ShaderErrorHandler.h"
+#include "include/gpu/graphite/PersistentPipelineStorage.h"
+#include "include/private/base/SkTo.h"
+#include "src/core/SkChecksum.h"
+#include "src/gpu/graphite/Caps.h"
+#include "src/gpu/graphite/dawn/DawnCaps.h"
+#include "src/gpu/graphite/dawn/DawnErrorChecker.h"
+#include "src/gpu/graphite/dawn/DawnGraphiteUtilsPriv.h"
+#include "src/gpu/graphite/dawn/DawnSharedContext.h"
+#include "src/gpu/graphite/dawn/DawnUtilsPriv.h"
+#include "src/sksl/SkSLProgramKind.h"
+#include "src/sksl/SkSLProgramSettings.h"
+#include "src/sksl/SkSLUtil.h"
+
+#include <cstring>
+#include <optional>
+#include <utility>
+
+namespace skgpu::graphite {
+namespace {
+
+// Stored WGSL is only loaded back by the same Skia milestone; the version changes when the layout
+// below does.
+constexpr uint32_t kStorageVersion = 2;
+
+sk_sp<SkData> make_storage_key() {
+    SkString key = SkStringPrintf("skia/graphite/dawn/wgsl/m%d/v%u", SK_MILESTONE, kStorageVersion);
+    return SkData::MakeWithCopy(key.c_str(), key.size());
+}
+
+void write_string(SkWStream* stream, const std::string& string) {
+    stream->write32(SkToU32(string.size()));
+    stream->write(string.data(), string.size());
+}
+
+bool read_string(SkStreamAsset* stream, std::string* string) {
+    uint32_t size;
+    if (!stream->readU32(&size) || size > stream->getLength() - stream->getPosition()) {
+        return false;
+    }
+    string->resize(size);
+    return stream->read(string->data(), size) == size;
+}
+
+// The stored data is a count followed by that many entries, each being its key text, its program
+// interface and its WGSL. The key itself is recomputed from the key text when it's loaded.
+void write_entry(SkWStream* stream, const std::string& keyText,
+                 const SkSL::ProgramInterface& interface, const std::string& wgsl) {
+    write_string(stream, keyText);
+    stream->write8(interface.fRTFlipUniform);
+    stream->write8(interface.fUseLastFragColor);
+    stream->write8(interface.fOutputSecondaryColor);
+    write_string(stream, wgsl);
+}
+
+size_t entry_size(const std::string& keyText, const std::string& wgsl) {
+    return 2 * sizeof(uint32_t) + keyText.size() + 3 + wgsl.size();
+}
+
+bool read_entry(SkStreamAsset* stream, std::string* keyText, SkSL::ProgramInterface* interface,
+                std::string* wgsl) {
+    uint8_t rtFlip, useLastFragColor, outputSecondaryColor;
+    if (!read_string(stream, keyText) ||
+        !stream->readU8(&rtFlip) ||
+        !stream->readU8(&useLastFragColor) ||
+        !stream->readU8(&outputSecondaryColor) ||
+        !read_string(stream, wgsl)) {
+        return false;
+    }
+    interface->fRTFlipUniform = rtFlip;
+    interface->fUseLastFragColor = useLastFragColor;
+    interface->fOutputSecondaryColor = outputSecondaryColor;
+    return true;
+}
+
+class SilentErrorHandler final : public ShaderErrorHandler {};
+
+// Compiles WGSL that was loaded from the persistent storage. It may have been written by a build
+// whose Tint accepted code that this one doesn't, so errors are neither reported to the Context's
+// error handler nor left for the device's uncaptured error callback.
+bool compile_stored_wgsl(const DawnSharedContext* sharedContext,
+                         const char* label,
+                         const std::string& wgsl,
+                         wgpu::ShaderModule* module) {
+    SilentErrorHandler silentErrorHandler;
+    std::optional<DawnErrorChecker> errorChecker;
+    if (sharedContext->dawnCaps()->allowScopedErrorChecks()) {
+        errorChecker.emplace(sharedContext);
+    }
+    bool success = DawnCompileWGSLShaderModule(sharedContext, label, wgsl, module,
+                                               &silentErrorHandler);
+    if (errorChecker.has_value() && errorChecker->popErrorScopes() != DawnErrorType::kNoError) {
+        success = false;
+    }
+    if (!success) {
+        *module = nullptr;
+    }
+    return success;
+}
+
+}  // namespace
+
+DawnShaderModuleCache::DawnShaderModuleCache(PersistentPipelineStorage* storage)
+        : fStorage(storage)
+        , fStorageKey(storage ? make_storage_key() : nullptr)
+        , fEntries(kMaxEntries) {}
+
+std::string DawnShaderModuleCache::KeyText(const SkSL::ShaderCaps* caps,
+                                           const std::string& sksl,
+                                           SkSL::ProgramKind kind,
+                                           const SkSL::ProgramSettings& settings) {
+    // Everything besides the SkSL that the generated WGSL depends on. The shader caps are the same
+    // for every pipeline of a Context, but stored WGSL may have been generated for another device.
+    const int32_t config[] = {
+        (int32_t)kind,
+        settings.fFragColorIsInOut,
+        settings.fForceHighPrecision,
+        settings.fSharpenTextures,
+        settings.fForceNoRTFlip,
+        settings.fRTFlipOffset,
+        settings.fRTFlipBinding,
+        settings.fRTFlipSet,
+        settings.fDefaultUniformSet,
+        settings.fDefaultUniformBinding,
+        settings.fOptimize,
+        settings.fRemoveDeadFunctions,
+        settings.fRemoveDeadVariables,
+        settings.fInlineThreshold,
+        settings.fForceNoInline,
+        settings.fUnrollLoopThreshold,
+        settings.fEliminateCommonSubexpressions,
+        settings.fAllowNarrowingConversions,
+        settings.fUsePushConstants,
+        (int32_t)settings.fMaxVersionAllowed,
+        caps->fDualSourceBlendingSupport,
+        caps->fShaderDerivativeSupport,
+        caps->fFBFetchSupport,
+        caps->fInfinitySupport,
+    };
+    std::string keyText(reinterpret_cast<const char*>(config), sizeof(config));
+    keyText += sksl;
+    return keyText;
+}
+
+uint64_t DawnShaderModuleCache::Key(const std::string& keyText) {
+    return SkChecksum::Hash64(keyText.data(), keyText.size());
+}
+
+void DawnShaderModuleCache::loadFromStorage() {
+    fLoaded = true;
+    if (!fStorage) {
+        return;
+    }
+    sk_sp<SkData> data = fStorage->load(*fStorageKey);
+    if (!data) {
+        return;
+    }
+    SkMemoryStream stream(std::move(data));
+    uint32_t count;
+    if (!stream.readU32(&count)) {
+        return;
+    }
+    for (uint32_t i = 0; i < count && fEntries.count() < kMaxEntries; ++i) {
+        Entry entry;
+        if (!read_entry(&stream, &entry.fKeyText, &entry.fInterface, &entry.fWGSL)) {
+            // Keep whatever was read before the data ended.
+            break;
+        }
+        const uint64_t key = Key(entry.fKeyText);
+        if (!fEntries.find(key)) {
+            fEntries.insert(key, std::move(entry));
+        }
+    }
+}
+
+bool DawnShaderModuleCache::findOrCreate(const DawnSharedContext* sharedContext,
+                                         const char* label,
+                                         const std::string& sksl,
+                                         SkSL::ProgramKind kind,
+                                         const SkSL::ProgramSettings& settings,
+                                         wgpu::ShaderModule* outModule,
+                                         std::string* outWGSL,
+                                         SkSL::ProgramInterface* outInterface,
+                                         ShaderErrorHandler* errorHandler) {
+    const SkSL::ShaderCaps* shaderCaps = sharedContext->caps()->shaderCaps();
+    std::string keyText = KeyText(shaderCaps, sksl, kind, settings);
+    const uint64_t key = Key(keyText);
+
+    std::string& wgsl = *outWGSL;
+    wgsl.clear();
+    {
+        SkAutoMutexExclusive lock(fMutex);
+        if (!fLoaded) {
+            this->loadFromStorage();
+        }
+        // An entry whose hash collides with the key but that was made from something else is
+        // replaced below.
+        Entry* entry = fEntries.find(key);
+        if (entry && entry->fKeyText == keyText) {
+            wgsl = entry->fWGSL;
+            *outInterface = entry->fInterface;
+            if (entry->fModule) {
+                *outModule = entry->fModule;
+                return true;
+            }
+        }
+    }
+
+    // Code generation and Tint run outside of the lock, so that pipelines compiled on other
+    // threads don't wait for them. Two threads may compile the same shader; the last one wins.
+    // WGSL found without a module was loaded from the persistent storage, and is dropped if it
+    // doesn't compile anymore.
+    bool generated = wgsl.empty();
+    if (!generated && !compile_stored_wgsl(sharedContext, label, wgsl, outModule)) {
+        SkAutoMutexExclusive lock(fMutex);
+        Entry* entry = fEntries.find(key);
+        if (entry && entry->fKeyText == keyText && !entry->fModule) {
+            fEntries.remove(key);
+            fChangedSinceSync = true;
+        }
+        wgsl.clear();
+        generated = true;
+    }
+    if (generated &&
+        (!SkSLToWGSL(shaderCaps, sksl, kind, settings, &wgsl, outInterface, errorHandler) ||
+         !DawnCompileWGSLShaderModule(sharedContext, label, wgsl, outModule, errorHandler))) {
+        return false;
+    }
+
+    SkAutoMutexExclusive lock(fMutex);
+    fEntries.insert_or_update(key, {std::move(keyText), wgsl, *outInterface, *outModule});
+    fChangedSinceSync |= generated;
+    return true;
+}
+
+void DawnShaderModuleCache::syncPipelineData(size_t maxSize) {
+    if (!fStorage) {
+        return;
+    }
+
+    SkDynamicMemoryWStream stream;
+    {
+        SkAutoMutexExclusive lock(fMutex);
+        if (!fChangedSinceSync) {
+            return;
+        }
+        fChangedSinceSync = false;
+
+        // Entries are visited from the most to the least recently used; the ones that don't fit
+        // are left out.
+        SkDynamicMemoryWStream entries;
+        uint32_t count = 0;
+        size_t size = sizeof(count);
+        fEntries.foreach([&](const uint64_t*, const Entry* entry) {
+            const size_t entrySize = entry_size(entry->fKeyText, entry->fWGSL);
+            if (size + entrySize <= maxSize) {
+                write_entry(&entries, entry->fKeyText, entry->fInterface, entry->fWGSL);
+                size += entrySize;
+                ++count;
+            }
+        });
+        if (!count) {
+            return;
+        }
+        stream.write32(count);
+        entries.writeToAndReset(&stream);
+    }
+    sk_sp<SkData> data = stream.detachAsData();
+    fStorage->store(*fStorageKey, *data);
+}
+
+}  // namespace skgpu::graphite
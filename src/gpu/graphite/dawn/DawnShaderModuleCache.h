@@ -0,0 +1,108 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef skgpu_graphite_DawnShaderModuleCache_DEFINED
+#define skgpu_graphite_DawnShaderModuleCache_DEFINED
+
+#include "include/core/SkData.h"
+#include "include/core/SkRefCnt.h"
+#include "include/private/base/SkMutex.h"
+#include "include/private/base/SkThreadAnnotations.h"
+#include "src/core/SkLRUCache.h"
+#include "src/sksl/ir/SkSLProgram.h"
+
+#include "webgpu/webgpu_cpp.h"  // NO_G3_REWRITE
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace SkSL {
+enum class ProgramKind : int8_t;
+struct ProgramSettings;
+struct ShaderCaps;
+}  // namespace SkSL
+
+namespace skgpu {
+class ShaderErrorHandler;
+}
+
+namespace skgpu::graphite {
+
+class DawnSharedContext;
+class PersistentPipelineStorage;
+
+/**
+ * Caches the WGSL generated from Graphite's SkSL and the shader modules Dawn created from it, so
+ * that pipelines which only differ in render pass or vertex state, but share their shaders, skip
+ * both SkSL code generation and Tint. Entries are keyed by the SkSL, the program kind and every
+ * setting and shader cap that changes the generated code; they are found by a hash of those, but
+ * only used if the whole key matches.
+ *
+ * If the Context has a PersistentPipelineStorage, the WGSL (but not the modules) is loaded from it
+ * on first use and written back by syncPipelineData(), so later runs only need Tint. Stored WGSL
+ * that fails to compile is dropped and generated again from the SkSL.
+ */
+class DawnShaderModuleCache {
+public:
+    static constexpr int kMaxEntries = 512;
+
+    explicit DawnShaderModuleCache(PersistentPipelineStorage*);
+
+    // Returns the shader module for `sksl`, its WGSL and the interface of its program, compiling
+    // it only if it isn't in the cache. On failure, the error has been reported to `errorHandler`.
+    bool findOrCreate(const DawnSharedContext*,
+                      const char* label,
+                      const std::string& sksl,
+                      SkSL::ProgramKind,
+                      const SkSL::ProgramSettings&,
+                      wgpu::ShaderModule* outModule,
+                      std::string* outWGSL,
+                      SkSL::ProgramInterface* outInterface,
+                      ShaderErrorHandler* errorHandler);
+
+    // Stores the most recently used WGSL that fits in maxSize bytes, if anything has been added
+    // since the last time.
+    void syncPipelineData(size_t maxSize);
+
+#if defined(GRAPHITE_TEST_UTILS)
+    int numEntries() {
+        SkAutoMutexExclusive lock(fMutex);
+        return fEntries.count();
+    }
+#endif
+
+private:
+    struct Entry {
+        // The SkSL and everything else the WGSL was generated from, see KeyText().
+        std::string fKeyText;
+        std::string fWGSL;
+        SkSL::ProgramInterface fInterface;
+        // Null until a pipeline needs it, for WGSL loaded from the persistent storage.
+        wgpu::ShaderModule fModule;
+    };
+
+    static std::string KeyText(const SkSL::ShaderCaps*,
+                               const std::string& sksl,
+                               SkSL::ProgramKind,
+                               const SkSL::ProgramSettings&);
+    static uint64_t Key(const std::string& keyText);
+
+    void loadFromStorage() SK_REQUIRES(fMutex);
+
+    PersistentPipelineStorage* const fStorage;
+    const sk_sp<SkData> fStorageKey;
+
+    SkMutex fMutex;
+    SkLRUCache<uint64_t, Entry> fEntries SK_GUARDED_BY(fMutex);
+    bool fLoaded SK_GUARDED_BY(fMutex) = false;
+    bool fChangedSinceSync SK_GUARDED_BY(fMutex) = false;
+};
+
+}  // namespace skgpu::graphite
+
+#endif  // skgpu_graphite_DawnShaderModuleCache_DEFINED
@@ -44,24 +44,32 @@ sk_sp<SharedContext> DawnSharedContext::Make(const DawnBackendContext& backendCo
 
     return sk_sp<SharedContext>(new DawnSharedContext(backendContext,
                                                       std::move(caps),
-                                                      std::move(noopFragment)));
+                                                      std::move(noopFragment),
+                                                      options.fPersistentPipelineStorage));
 }
 
 DawnSharedContext::DawnSharedContext(const DawnBackendContext& backendContext,
                                      std::unique_ptr<const DawnCaps> caps,
-                                     wgpu::ShaderModule noopFragment)
+                                     wgpu::ShaderModule noopFragment,
+                                     PersistentPipelineStorage* pipelineStorage)
         : skgpu::graphite::SharedContext(std::move(caps), BackendApi::kDawn)
         , fInstance(backendContext.fInstance)
         , fDevice(backendContext.fDevice)
         , fQueue(backendContext.fQueue)
         , fTick(backendContext.fTick)
-        , fNoopFragment(std::move(noopFragment)) {}
+        , fNoopFragment(std::move(noopFragment))
+        , fShaderModuleCache(pipelineStorage) {}
 
 DawnSharedContext::~DawnSharedContext() {
+    this->destroyPipelineCompiler();
     // need to clear out resources before any allocator is removed
     this->globalCache()->deleteResources();
 }
 
+void DawnSharedContext::syncPipelineData(size_t maxSize) {
+    fShaderModuleCache.syncPipelineData(maxSize);
+}
+
 std::unique_ptr<ResourceProvider> DawnSharedContext::makeResourceProvider(
         SingleOwner* singleOwner,
         uint32_t recorderID,
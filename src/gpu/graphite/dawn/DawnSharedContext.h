@@ -13,6 +13,7 @@
 #include "include/gpu/graphite/dawn/DawnBackendContext.h"
 #include "src/gpu/graphite/SharedContext.h"
 #include "src/gpu/graphite/dawn/DawnCaps.h"
+#include "src/gpu/graphite/dawn/DawnShaderModuleCache.h"
 
 namespace skgpu::graphite {
 
@@ -33,6 +34,11 @@ public:
     const wgpu::Queue& queue() const { return fQueue; }
     const wgpu::ShaderModule& noopFragment() const { return fNoopFragment; }
 
+    // Shared by every pipeline compiled for this Context, on whichever thread.
+    DawnShaderModuleCache* shaderModuleCache() const { return &fShaderModuleCache; }
+
+    void syncPipelineData(size_t maxSize) override;
+
     bool hasTick() const { return fTick; }
 
     void tick() const {
@@ -43,7 +49,8 @@ public:
 private:
     DawnSharedContext(const DawnBackendContext&,
                       std::unique_ptr<const DawnCaps> caps,
-                      wgpu::ShaderModule noopFragment);
+                      wgpu::ShaderModule noopFragment,
+                      PersistentPipelineStorage*);
 
     wgpu::Instance     fInstance;
     wgpu::Device       fDevice;
@@ -52,6 +59,8 @@ private:
     // A noop fragment shader, it is used to workaround dawn a validation error(dawn doesn't allow
     // a pipeline with a color attachment but without a fragment shader).
     wgpu::ShaderModule fNoopFragment;
+
+    mutable DawnShaderModuleCache fShaderModuleCache;
 };
 
 } // namespace skgpu::graphite
@@ -16,6 +16,7 @@
 #include "src/gpu/graphite/DrawOrder.h"
 #include "src/gpu/graphite/geom/Rect.h"
 
+#include <algorithm>
 #include <cstdint>
 
 namespace skgpu::graphite {
@@ -102,6 +103,19 @@ public:
 
     int count() const { return fRects.count(); }
 
+    // The mean width and height of the recorded draws.
+    SkSize meanSize() const {
+        if (fRects.empty()) {
+            return SkSize::MakeEmpty();
+        }
+        skvx::float2 sum = 0.f;
+        for (const Rect& r : fRects.items()) {
+            sum += r.size();
+        }
+        sum *= 1.f / fRects.count();
+        return {sum.x(), sum.y()};
+    }
+
     void replayDraws(BoundsManager* manager) const {
         auto orderIter = fOrders.items().begin();
         for (const Rect& r : fRects.items()) {
@@ -240,8 +254,25 @@ private:
 // surprisingly efficient, has the highest accuracy, and very low memory overhead. Once the draw
 // call count is large enough, the grid's lower performance complexity outweigh its memory cost and
 // reduced accuracy.
+//
+// The grid's cells are sized to the draws seen before switching: draws that span many cells cost
+// more to record and query without being tracked any more accurately, so the cells grow with the
+// draws, up to kMaxCellScale times the requested size. A frame that switches to the grid early on
+// is likely followed by similar frames, so those start out using the grid rather than replaying
+// their first N draws into it.
 class HybridBoundsManager : public BoundsManager {
 public:
+    // Draws are assumed to cover usually this many cells per side when picking the cell size.
+    static constexpr float kTargetCellsPerDraw = 4.f;
+    static constexpr int kMaxCellScale = 4;
+
+    // The choices made for the most recent frame, and how many draws they were made for.
+    struct Stats {
+        int fDrawCount = 0;
+        int fGridCellSize = 0;       // 0 if the frame only used brute force
+        bool fStartedWithGrid = false;
+    };
+
     HybridBoundsManager(const SkISize& deviceSize,
                         int gridCellSize,
                         int maxBruteForceN,
@@ -262,15 +293,21 @@ public:
     void recordDraw(const Rect& bounds, CompressedPaintersOrder order) override {
         this->updateCurrentManagerIfNeeded();
         fCurrentManager->recordDraw(bounds, order);
+        fDrawCount++;
     }
 
     void reset() override {
         const bool usedGrid = fCurrentManager == fGridManager.get();
+        fLastFrame = {fDrawCount, usedGrid ? fCurrentGridCellSize : 0, fStartedWithGrid};
         if (usedGrid) {
             // Reset the grid manager so it's ready to use next frame, but don't delete it.
             fGridManager->reset();
-            // Assume brute force manager was reset when we swapped to the grid originally
-            fCurrentManager = &fBruteForceManager;
+            // Assume brute force manager was reset when we swapped to the grid originally. Keep
+            // using the grid from the start if this frame had well over enough draws for it.
+            fStartedWithGrid = fDrawCount >= 2 * fMaxBruteForceN;
+            if (!fStartedWithGrid) {
+                fCurrentManager = &fBruteForceManager;
+            }
         } else {
             if (fGridManager) {
                 // Clean up the grid manager that was created over a frame ago without being used.
@@ -279,10 +316,14 @@ public:
                 fGridManager = nullptr;
             }
             fBruteForceManager.reset();
+            fStartedWithGrid = false;
             SkASSERT(fCurrentManager == &fBruteForceManager);
         }
+        fDrawCount = 0;
     }
 
+    const Stats& lastFrameStats() const { return fLastFrame; }
+
 private:
     const SkISize fDeviceSize;
     const int     fGridCellSize;
@@ -298,6 +339,22 @@ private:
     // assumption that the owning Device will have similar frame-to-frame draw counts and will need
     // to upgrade to the grid manager again.
     std::unique_ptr<GridBoundsManager>       fGridManager;
+    int                                      fCurrentGridCellSize = 0;
+
+    int   fDrawCount = 0;
+    bool  fStartedWithGrid = false;
+    Stats fLastFrame;
+
+    int chooseGridCellSize() const {
+        SkSize meanSize = fBruteForceManager.meanSize();
+        float meanExtent = std::max(meanSize.width(), meanSize.height());
+        int cellSize = fGridCellSize;
+        while (cellSize < kMaxCellScale * fGridCellSize &&
+               kTargetCellsPerDraw * 2 * cellSize <= meanExtent) {
+            cellSize *= 2;
+        }
+        return cellSize;
+    }
 
     void updateCurrentManagerIfNeeded() {
         if (fCurrentManager == fGridManager.get() ||
@@ -307,8 +364,10 @@ private:
             return;
         }
         // Else we need to switch from the brute force manager to the grid manager
-        if (!fGridManager) {
-            fGridManager = GridBoundsManager::MakeRes(fDeviceSize, fGridCellSize, fMaxGridSize);
+        int cellSize = this->chooseGridCellSize();
+        if (!fGridManager || cellSize != fCurrentGridCellSize) {
+            fGridManager = GridBoundsManager::MakeRes(fDeviceSize, cellSize, fMaxGridSize);
+            fCurrentGridCellSize = cellSize;
         }
         fCurrentManager = fGridManager.get();
 
@@ -20,11 +20,18 @@ class MtlSharedContext;
 class MtlBuffer : public Buffer {
 public:
     static sk_sp<Buffer> Make(const MtlSharedContext*, size_t size, BufferType type, AccessPattern);
+    // Wraps client memory that starts on a page boundary, on devices with unified memory. The
+    // buffer covers whole pages, so it may be a little larger than 'size'.
+    static sk_sp<Buffer> MakeWrappedHostMemory(const MtlSharedContext*,
+                                               const void* ptr,
+                                               size_t size,
+                                               sk_sp<SkRefCnt> memoryOwner);
 
     id<MTLBuffer> mtlBuffer() const { return fBuffer.get(); }
 
 private:
     MtlBuffer(const MtlSharedContext*, size_t size, sk_cfp<id<MTLBuffer>>);
+    MtlBuffer(const MtlSharedContext*, size_t size, sk_cfp<id<MTLBuffer>>, Ownership);
 
     void onMap() override;
     void onUnmap() override;
@@ -10,6 +10,8 @@
 #include "include/private/base/SkAlign.h"
 #include "src/gpu/graphite/mtl/MtlSharedContext.h"
 
+#include <unistd.h>
+
 namespace skgpu::graphite {
 
 sk_sp<Buffer> MtlBuffer::Make(const MtlSharedContext* sharedContext,
@@ -45,11 +47,49 @@ sk_sp<Buffer> MtlBuffer::Make(const MtlSharedContext* sharedContext,
     return sk_sp<Buffer>(new MtlBuffer(sharedContext, size, std::move(buffer)));
 }
 
+sk_sp<Buffer> MtlBuffer::MakeWrappedHostMemory(const MtlSharedContext* sharedContext,
+                                               const void* ptr,
+                                               size_t size,
+                                               sk_sp<SkRefCnt> memoryOwner) {
+    if (@available(macOS 10.15, iOS 13.0, tvOS 13.0, *)) {
+        // With discrete memory the GPU would read the pages across the bus on every copy.
+        if (![sharedContext->device() hasUnifiedMemory]) {
+            return nullptr;
+        }
+        const size_t pageSize = getpagesize();
+        if (reinterpret_cast<uintptr_t>(ptr) % pageSize != 0) {
+            return nullptr;
+        }
+        const size_t wrappedSize = SkAlignTo(size, pageSize);
+        // The block captures a ref on the owner, which is dropped once Metal releases the block
+        // along with the buffer.
+        sk_cfp<id<MTLBuffer>> buffer([sharedContext->device()
+                newBufferWithBytesNoCopy:const_cast<void*>(ptr)
+                                  length:wrappedSize
+                                 options:MTLResourceStorageModeShared
+                             deallocator:^(void*, NSUInteger) {
+                                 (void)memoryOwner;
+                             }]);
+        if (!buffer) {
+            return nullptr;
+        }
+        return sk_sp<Buffer>(new MtlBuffer(sharedContext, wrappedSize, std::move(buffer),
+                                           Ownership::kWrapped));
+    }
+    return nullptr;
+}
+
 MtlBuffer::MtlBuffer(const MtlSharedContext* sharedContext,
                      size_t size,
                      sk_cfp<id<MTLBuffer>> buffer)
         : Buffer(sharedContext, size), fBuffer(std::move(buffer)) {}
 
+MtlBuffer::MtlBuffer(const MtlSharedContext* sharedContext,
+                     size_t size,
+                     sk_cfp<id<MTLBuffer>> buffer,
+                     Ownership ownership)
+        : Buffer(sharedContext, size, ownership), fBuffer(std::move(buffer)) {}
+
 void MtlBuffer::onMap() {
     SkASSERT(fBuffer);
     SkASSERT(!this->isMapped());
@@ -70,6 +70,10 @@ private:
 
     void onResetCommandBuffer() override;
 
+    // The MTLCommandBuffer is timed on the GPU anyway, so this only checks that the OS reports it.
+    bool onStartGpuTimer() override;
+    uint64_t gpuTimerResultNs() override;
+
     bool onAddRenderPass(const RenderPassDesc&,
                          const Texture* colorTexture,
                          const Texture* resolveTexture,
@@ -104,6 +104,22 @@ void MtlCommandBuffer::onResetCommandBuffer() {
     fCurrentIndexBufferOffset = 0;
 }
 
+bool MtlCommandBuffer::onStartGpuTimer() {
+    if (@available(macOS 10.15, iOS 10.3, tvOS 10.3, *)) {
+        return true;
+    }
+    return false;
+}
+
+uint64_t MtlCommandBuffer::gpuTimerResultNs() {
+    if (@available(macOS 10.15, iOS 10.3, tvOS 10.3, *)) {
+        // The times are in seconds.
+        CFTimeInterval gpuTime = (*fCommandBuffer).GPUEndTime - (*fCommandBuffer).GPUStartTime;
+        return gpuTime > 0 ? static_cast<uint64_t>(gpuTime * 1e9) : 0;
+    }
+    return 0;
+}
+
 void MtlCommandBuffer::addWaitSemaphores(size_t numWaitSemaphores,
                                          const BackendSemaphore* waitSemaphores) {
     if (!waitSemaphores) {
@@ -372,7 +388,7 @@ void MtlCommandBuffer::addDrawPass(const DrawPass* drawPass) {
             }
             case DrawPassCommands::Type::kBindUniformBuffer: {
                 auto bub = static_cast<DrawPassCommands::BindUniformBuffer*>(cmdPtr);
-                this->bindUniformBuffer(bub->fInfo, bub->fSlot);
+                this->bindUniformBuffer(this->remapUniformBuffer(bub->fInfo), bub->fSlot);
                 break;
             }
             case DrawPassCommands::Type::kBindDrawBuffers: {
@@ -26,7 +26,7 @@ private:
     const MtlSharedContext* mtlSharedContext() const;
 
     std::unique_ptr<CommandBuffer> getNewCommandBuffer(ResourceProvider*) override;
-    OutstandingSubmission onSubmitToGpu() override;
+    OutstandingSubmission onSubmitToGpu(std::unique_ptr<CommandBuffer>) override;
 
 #if defined(GRAPHITE_TEST_UTILS)
     void startCapture() override;
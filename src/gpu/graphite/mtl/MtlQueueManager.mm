@@ -49,16 +49,17 @@ private:
     }
 };
 
-QueueManager::OutstandingSubmission MtlQueueManager::onSubmitToGpu() {
-    SkASSERT(fCurrentCommandBuffer);
-    MtlCommandBuffer* mtlCmdBuffer = static_cast<MtlCommandBuffer*>(fCurrentCommandBuffer.get());
+QueueManager::OutstandingSubmission MtlQueueManager::onSubmitToGpu(
+        std::unique_ptr<CommandBuffer> commandBuffer) {
+    SkASSERT(commandBuffer);
+    MtlCommandBuffer* mtlCmdBuffer = static_cast<MtlCommandBuffer*>(commandBuffer.get());
     if (!mtlCmdBuffer->commit()) {
-        fCurrentCommandBuffer->callFinishedProcs(/*success=*/false);
+        commandBuffer->callFinishedProcs(/*success=*/false);
         return nullptr;
     }
 
     std::unique_ptr<GpuWorkSubmission> submission(
-            new MtlWorkSubmission(std::move(fCurrentCommandBuffer), this));
+            new MtlWorkSubmission(std::move(commandBuffer), this));
     return submission;
 }
 
@@ -43,6 +43,9 @@ private:
                                  skgpu::Budgeted) override;
     sk_sp<Texture> onCreateWrappedTexture(const BackendTexture&) override;
     sk_sp<Buffer> createBuffer(size_t size, BufferType type, AccessPattern) override;
+    sk_sp<Buffer> onWrapHostMemory(const void* ptr,
+                                   size_t size,
+                                   sk_sp<SkRefCnt> memoryOwner) override;
     sk_sp<Sampler> createSampler(const SamplerDesc&) override;
 
     BackendTexture onCreateBackendTexture(SkISize dimensions, const TextureInfo&) override;
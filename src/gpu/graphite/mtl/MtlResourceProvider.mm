@@ -261,6 +261,13 @@ sk_sp<Buffer> MtlResourceProvider::createBuffer(size_t size,
     return MtlBuffer::Make(this->mtlSharedContext(), size, type, accessPattern);
 }
 
+sk_sp<Buffer> MtlResourceProvider::onWrapHostMemory(const void* ptr,
+                                                    size_t size,
+                                                    sk_sp<SkRefCnt> memoryOwner) {
+    return MtlBuffer::MakeWrappedHostMemory(this->mtlSharedContext(), ptr, size,
+                                            std::move(memoryOwner));
+}
+
 sk_sp<Sampler> MtlResourceProvider::createSampler(const SamplerDesc& samplerDesc) {
     return MtlSampler::Make(this->mtlSharedContext(),
                             samplerDesc.samplingOptions(),
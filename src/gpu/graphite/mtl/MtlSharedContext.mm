@@ -57,6 +57,7 @@ MtlSharedContext::MtlSharedContext(sk_cfp<id<MTLDevice>> device,
         , fDevice(std::move(device)) {}
 
 MtlSharedContext::~MtlSharedContext() {
+    this->destroyPipelineCompiler();
     // need to clear out resources before the allocator (if any) is removed
     this->globalCache()->deleteResources();
 }
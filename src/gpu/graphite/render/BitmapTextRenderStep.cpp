@@ -123,12 +123,12 @@ void BitmapTextRenderStep::writeUniformsAndTextures(const DrawParams& params,
     SkDEBUGCODE(UniformExpectationsValidator uev(gatherer, this->uniforms());)
 
     const SubRunData& subRunData = params.geometry().subRunData();
-    unsigned int numProxies;
     Recorder* recorder = subRunData.recorder();
-    const sk_sp<TextureProxy>* proxies =
+    sk_sp<TextureProxy> proxies[PlotLocator::kMaxMultitexturePages];
+    const unsigned int numProxies =
             recorder->priv().atlasProvider()->textAtlasManager()->getProxies(
-                    subRunData.subRun()->maskFormat(), &numProxies);
-    SkASSERT(proxies && numProxies > 0);
+                    subRunData.subRun()->maskFormat(), proxies);
+    SkASSERT(numProxies > 0);
 
     // write uniforms
     gatherer->write(params.transform().matrix());  // subRunDeviceMatrix
@@ -42,6 +42,12 @@ public:
         return fInstances.append(tolerances, 1);
     }
 
+    // Reserves 'count' patches at once that all fit within 'tolerances', such as the cached
+    // patches of a TessellatedPathCache.
+    VertexWriter append(const tess::LinearTolerances& tolerances, unsigned int count) {
+        return fInstances.append(tolerances, count);
+    }
+
 private:
     struct LinearToleranceProxy {
         operator unsigned int() const { return FixedCountVariant::VertexCount(fTolerances); }
@@ -15,6 +15,7 @@
 #include "src/gpu/graphite/PipelineData.h"
 #include "src/gpu/graphite/render/CommonDepthStencilSettings.h"
 #include "src/gpu/graphite/render/DynamicInstancesPatchAllocator.h"
+#include "src/gpu/graphite/render/TessellatedPathCache.h"
 
 #include "src/gpu/tessellate/FixedCountBufferUtils.h"
 #include "src/gpu/tessellate/PatchWriter.h"
@@ -32,12 +33,34 @@ using namespace skgpu::tess;
 static constexpr PatchAttribs kAttribs = PatchAttribs::kPaintDepth |
                                          PatchAttribs::kSsboIndex;
 static constexpr PatchAttribs kAttribsWithCurveType = kAttribs | PatchAttribs::kExplicitCurveType;
-using Writer = PatchWriter<DynamicInstancesPatchAllocator<FixedCountCurves>,
-                           Required<PatchAttribs::kPaintDepth>,
-                           Required<PatchAttribs::kSsboIndex>,
-                           Optional<PatchAttribs::kExplicitCurveType>,
-                           AddTrianglesWhenChopping,
-                           DiscardFlatCurves>;
+template <typename PatchAllocator>
+using WriterFor = PatchWriter<PatchAllocator,
+                              Required<PatchAttribs::kPaintDepth>,
+                              Required<PatchAttribs::kSsboIndex>,
+                              Optional<PatchAttribs::kExplicitCurveType>,
+                              AddTrianglesWhenChopping,
+                              DiscardFlatCurves>;
+using Writer = WriterFor<DynamicInstancesPatchAllocator<FixedCountCurves>>;
+using CapturingWriter = WriterFor<TessellatedPathCache::CapturingPatchAllocator>;
+
+// TODO: For filled curves, the path verb loop is simple enough that it's not too big a deal
+// to copy the logic from PathCurveTessellator::write_patches. It may be required if we end
+// up switching to a shape iterator in graphite vs. a path iterator in ganesh, or if
+// graphite does not control point transformation on the CPU. On the  other hand, if we
+// provide a templated WritePatches function, the iterator could also be a template arg in
+// addition to PatchWriter's traits. Whatever pattern we choose will be based more on what's
+// best for the wedge and stroke case, which have more complex loops.
+template <typename W>
+void write_curves(W& writer, const SkPath& path) {
+    for (auto [verb, pts, w] : SkPathPriv::Iterate(path)) {
+        switch (verb) {
+            case SkPathVerb::kQuad:  writer.writeQuadratic(pts); break;
+            case SkPathVerb::kConic: writer.writeConic(pts, *w); break;
+            case SkPathVerb::kCubic: writer.writeCubic(pts);     break;
+            default:                                             break;
+        }
+    }
+}
 
 // The order of the attribute declarations must match the order used by
 // PatchWriter::emitPatchAttribs, i.e.:
@@ -114,39 +137,53 @@ void TessellateCurvesRenderStep::writeVertices(DrawWriter* dw,
                                                const DrawParams& params,
                                                skvx::ushort2 ssboIndices) const {
     SkPath path = params.geometry().shape().asPath(); // TODO: Iterate the Shape directly
-
-    int patchReserveCount = FixedCountCurves::PreallocCount(path.countVerbs());
-    Writer writer{fInfinitySupport ? kAttribs : kAttribsWithCurveType,
-                  *dw,
-                  fVertexBuffer,
-                  fIndexBuffer,
-                  patchReserveCount};
-    writer.updatePaintDepthAttrib(params.order().depthAsFloat());
-    writer.updateSsboIndexAttrib(ssboIndices);
+    const PatchAttribs attribs = fInfinitySupport ? kAttribs : kAttribsWithCurveType;
 
     // The vector xform approximates how the control points are transformed by the shader to
     // more accurately compute how many *parametric* segments are needed.
     // TODO: This doesn't account for perspective division yet, which will require updating the
     // approximate transform based on each verb's control points' bounding box.
     SkASSERT(params.transform().type() < Transform::Type::kPerspective);
-    writer.setShaderTransform(wangs_formula::VectorXform{params.transform().matrix()},
-                              params.transform().maxScaleFactor());
 
-    // TODO: For filled curves, the path verb loop is simple enough that it's not too big a deal
-    // to copy the logic from PathCurveTessellator::write_patches. It may be required if we end
-    // up switching to a shape iterator in graphite vs. a path iterator in ganesh, or if
-    // graphite does not control point transformation on the CPU. On the  other hand, if we
-    // provide a templated WritePatches function, the iterator could also be a template arg in
-    // addition to PatchWriter's traits. Whatever pattern we choose will be based more on what's
-    // best for the wedge and stroke case, which have more complex loops.
-    for (auto [verb, pts, w] : SkPathPriv::Iterate(path)) {
-        switch (verb) {
-            case SkPathVerb::kQuad:  writer.writeQuadratic(pts); break;
-            case SkPathVerb::kConic: writer.writeConic(pts, *w); break;
-            case SkPathVerb::kCubic: writer.writeCubic(pts);     break;
-            default:                                             break;
+    TessellatedPathCache* cache = dw->pathCache();
+    if (cache && TessellatedPathCache::CanCache(params, path)) {
+        using PatchType = TessellatedPathCache::PatchType;
+        const int bucket = TessellatedPathCache::ScaleBucket(params.transform().maxScaleFactor());
+        const TessellatedPathCache::Patches* patches =
+                cache->find(path, PatchType::kCurves, attribs, bucket);
+        if (!patches) {
+            TessellatedPathCache::Patches* added =
+                    cache->add(path, PatchType::kCurves, attribs, bucket);
+            CapturingWriter writer{attribs, added};
+            const float scale = TessellatedPathCache::BucketScale(bucket);
+            writer.setShaderTransform(wangs_formula::VectorXform{SkMatrix::Scale(scale, scale)},
+                                      scale);
+            write_curves(writer, path);
+            patches = added;
         }
+        if (patches->fCount > 0) {
+            DynamicInstancesPatchAllocator<FixedCountCurves> instances{PatchStride(attribs),
+                                                                       *dw,
+                                                                       fVertexBuffer,
+                                                                       fIndexBuffer,
+                                                                       0};
+            TessellatedPathCache::WritePatches(
+                    instances.append(patches->fTolerances, SkToUInt(patches->fCount)),
+                    *patches,
+                    attribs,
+                    params.order().depthAsFloat(),
+                    ssboIndices);
+        }
+        return;
     }
+
+    int patchReserveCount = FixedCountCurves::PreallocCount(path.countVerbs());
+    Writer writer{attribs, *dw, fVertexBuffer, fIndexBuffer, patchReserveCount};
+    writer.updatePaintDepthAttrib(params.order().depthAsFloat());
+    writer.updateSsboIndexAttrib(ssboIndices);
+    writer.setShaderTransform(wangs_formula::VectorXform{params.transform().matrix()},
+                              params.transform().maxScaleFactor());
+    write_curves(writer, path);
 }
 
 void TessellateCurvesRenderStep::writeUniformsAndTextures(const DrawParams& params,
@@ -14,6 +14,7 @@
 #include "src/gpu/graphite/DrawWriter.h"
 #include "src/gpu/graphite/PipelineData.h"
 #include "src/gpu/graphite/render/DynamicInstancesPatchAllocator.h"
+#include "src/gpu/graphite/render/TessellatedPathCache.h"
 
 #include "src/gpu/tessellate/FixedCountBufferUtils.h"
 #include "src/gpu/tessellate/MidpointContourParser.h"
@@ -34,11 +35,60 @@ static constexpr PatchAttribs kAttribs = PatchAttribs::kFanPoint |
                                          PatchAttribs::kSsboIndex;
 static constexpr PatchAttribs kAttribsWithCurveType = kAttribs | PatchAttribs::kExplicitCurveType;
 
-using Writer = PatchWriter<DynamicInstancesPatchAllocator<FixedCountWedges>,
-                           Required<PatchAttribs::kFanPoint>,
-                           Required<PatchAttribs::kPaintDepth>,
-                           Required<PatchAttribs::kSsboIndex>,
-                           Optional<PatchAttribs::kExplicitCurveType>>;
+template <typename PatchAllocator>
+using WriterFor = PatchWriter<PatchAllocator,
+                              Required<PatchAttribs::kFanPoint>,
+                              Required<PatchAttribs::kPaintDepth>,
+                              Required<PatchAttribs::kSsboIndex>,
+                              Optional<PatchAttribs::kExplicitCurveType>>;
+using Writer = WriterFor<DynamicInstancesPatchAllocator<FixedCountWedges>>;
+using CapturingWriter = WriterFor<TessellatedPathCache::CapturingPatchAllocator>;
+
+// TODO: Essentially the same as PathWedgeTessellator::write_patches but with a different
+// PatchWriter template.
+// For wedges, we iterate over each contour explicitly, using a fan point position that is in
+// the midpoint of the current contour.
+template <typename W>
+void write_wedges(W& writer, const SkPath& path) {
+    MidpointContourParser parser{path};
+    while (parser.parseNextContour()) {
+        writer.updateFanPointAttrib(parser.currentMidpoint());
+        SkPoint lastPoint = {0, 0};
+        SkPoint startPoint = {0, 0};
+        for (auto [verb, pts, w] : parser.currentContour()) {
+            switch (verb) {
+                case SkPathVerb::kMove:
+                    startPoint = lastPoint = pts[0];
+                    break;
+                case SkPathVerb::kLine:
+                    // Unlike curve tessellation, wedges have to handle lines as part of the patch,
+                    // effectively forming a single triangle with the fan point.
+                    writer.writeLine(pts[0], pts[1]);
+                    lastPoint = pts[1];
+                    break;
+                case SkPathVerb::kQuad:
+                    writer.writeQuadratic(pts);
+                    lastPoint = pts[2];
+                    break;
+                case SkPathVerb::kConic:
+                    writer.writeConic(pts, *w);
+                    lastPoint = pts[2];
+                    break;
+                case SkPathVerb::kCubic:
+                    writer.writeCubic(pts);
+                    lastPoint = pts[3];
+                    break;
+                default: break;
+            }
+        }
+
+        // Explicitly close the contour with another line segment, which also differs from curve
+        // tessellation since that approach's triangle step automatically closes the contour.
+        if (lastPoint != startPoint) {
+            writer.writeLine(lastPoint, startPoint);
+        }
+    }
+}
 
 // The order of the attribute declarations must match the order used by
 // PatchWriter::emitPatchAttribs, i.e.:
@@ -126,66 +176,53 @@ void TessellateWedgesRenderStep::writeVertices(DrawWriter* dw,
                                                const DrawParams& params,
                                                skvx::ushort2 ssboIndices) const {
     SkPath path = params.geometry().shape().asPath(); // TODO: Iterate the Shape directly
-
-    int patchReserveCount = FixedCountWedges::PreallocCount(path.countVerbs());
-    Writer writer{fInfinitySupport ? kAttribs : kAttribsWithCurveType,
-                  *dw,
-                  fVertexBuffer,
-                  fIndexBuffer,
-                  patchReserveCount};
-    writer.updatePaintDepthAttrib(params.order().depthAsFloat());
-    writer.updateSsboIndexAttrib(ssboIndices);
+    const PatchAttribs attribs = fInfinitySupport ? kAttribs : kAttribsWithCurveType;
 
     // The vector xform approximates how the control points are transformed by the shader to
     // more accurately compute how many *parametric* segments are needed.
     // TODO: This doesn't account for perspective division yet, which will require updating the
     // approximate transform based on each verb's control points' bounding box.
     SkASSERT(params.transform().type() < Transform::Type::kPerspective);
-    writer.setShaderTransform(wangs_formula::VectorXform{params.transform().matrix()},
-                              params.transform().maxScaleFactor());
 
-    // TODO: Essentially the same as PathWedgeTessellator::write_patches but with a different
-    // PatchWriter template.
-    // For wedges, we iterate over each contour explicitly, using a fan point position that is in
-    // the midpoint of the current contour.
-    MidpointContourParser parser{path};
-    while (parser.parseNextContour()) {
-        writer.updateFanPointAttrib(parser.currentMidpoint());
-        SkPoint lastPoint = {0, 0};
-        SkPoint startPoint = {0, 0};
-        for (auto [verb, pts, w] : parser.currentContour()) {
-            switch (verb) {
-                case SkPathVerb::kMove:
-                    startPoint = lastPoint = pts[0];
-                    break;
-                case SkPathVerb::kLine:
-                    // Unlike curve tessellation, wedges have to handle lines as part of the patch,
-                    // effectively forming a single triangle with the fan point.
-                    writer.writeLine(pts[0], pts[1]);
-                    lastPoint = pts[1];
-                    break;
-                case SkPathVerb::kQuad:
-                    writer.writeQuadratic(pts);
-                    lastPoint = pts[2];
-                    break;
-                case SkPathVerb::kConic:
-                    writer.writeConic(pts, *w);
-                    lastPoint = pts[2];
-                    break;
-                case SkPathVerb::kCubic:
-                    writer.writeCubic(pts);
-                    lastPoint = pts[3];
-                    break;
-                default: break;
-            }
+    TessellatedPathCache* cache = dw->pathCache();
+    if (cache && TessellatedPathCache::CanCache(params, path)) {
+        using PatchType = TessellatedPathCache::PatchType;
+        const int bucket = TessellatedPathCache::ScaleBucket(params.transform().maxScaleFactor());
+        const TessellatedPathCache::Patches* patches =
+                cache->find(path, PatchType::kWedges, attribs, bucket);
+        if (!patches) {
+            TessellatedPathCache::Patches* added =
+                    cache->add(path, PatchType::kWedges, attribs, bucket);
+            CapturingWriter writer{attribs, added};
+            const float scale = TessellatedPathCache::BucketScale(bucket);
+            writer.setShaderTransform(wangs_formula::VectorXform{SkMatrix::Scale(scale, scale)},
+                                      scale);
+            write_wedges(writer, path);
+            patches = added;
         }
-
-        // Explicitly close the contour with another line segment, which also differs from curve
-        // tessellation since that approach's triangle step automatically closes the contour.
-        if (lastPoint != startPoint) {
-            writer.writeLine(lastPoint, startPoint);
+        if (patches->fCount > 0) {
+            DynamicInstancesPatchAllocator<FixedCountWedges> instances{PatchStride(attribs),
+                                                                       *dw,
+                                                                       fVertexBuffer,
+                                                                       fIndexBuffer,
+                                                                       0};
+            TessellatedPathCache::WritePatches(
+                    instances.append(patches->fTolerances, SkToUInt(patches->fCount)),
+                    *patches,
+                    attribs,
+                    params.order().depthAsFloat(),
+                    ssboIndices);
         }
+        return;
     }
+
+    int patchReserveCount = FixedCountWedges::PreallocCount(path.countVerbs());
+    Writer writer{attribs, *dw, fVertexBuffer, fIndexBuffer, patchReserveCount};
+    writer.updatePaintDepthAttrib(params.order().depthAsFloat());
+    writer.updateSsboIndexAttrib(ssboIndices);
+    writer.setShaderTransform(wangs_formula::VectorXform{params.transform().matrix()},
+                              params.transform().maxScaleFactor());
+    write_wedges(writer, path);
 }
 
 void TessellateWedgesRenderStep::writeUniformsAndTextures(const DrawParams& params,
@@ -0,0 +1,115 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/gpu/graphite/render/TessellatedPathCache.h"
+
+#include "include/core/SkPath.h"
+#include "include/private/base/SkFloatingPoint.h"
+#include "src/gpu/graphite/DrawParams.h"
+
+#include <cmath>
+#include <cstring>
+
+namespace skgpu::graphite {
+
+namespace {
+
+// Caching is meant for small paths like icons that are drawn many times. Larger paths would use a
+// lot of memory for their patches, and are more likely to be drawn once or to change.
+constexpr int kMaxCachedVerbs = 128;
+constexpr int kMaxCachedPaths = 128;
+
+// Scales are bucketed to quarter octaves, so a cached path is tessellated with at most ~19% more
+// segments than its draw needs.
+constexpr int kBucketsPerOctave = 4;
+// Outside of these scales draws are unusual enough that they are just tessellated directly.
+constexpr int kMinScaleBucket = -8 * kBucketsPerOctave;
+constexpr int kMaxScaleBucket = 8 * kBucketsPerOctave;
+
+}  // anonymous namespace
+
+TessellatedPathCache::TessellatedPathCache() : fCache(kMaxCachedPaths) {}
+TessellatedPathCache::~TessellatedPathCache() = default;
+
+bool TessellatedPathCache::CanCache(const DrawParams& params, const SkPath& path) {
+    if (!params.geometry().isShape() || !params.geometry().shape().isPath() ||
+        path.isVolatile() || path.countVerbs() > kMaxCachedVerbs) {
+        return false;
+    }
+    const float maxScaleFactor = params.transform().maxScaleFactor();
+    if (!SkIsFinite(maxScaleFactor) || maxScaleFactor <= 0.f) {
+        return false;
+    }
+    const int bucket = ScaleBucket(maxScaleFactor);
+    return bucket >= kMinScaleBucket && bucket <= kMaxScaleBucket;
+}
+
+int TessellatedPathCache::ScaleBucket(float maxScaleFactor) {
+    return sk_float_ceil2int(kBucketsPerOctave * std::log2(maxScaleFactor));
+}
+
+float TessellatedPathCache::BucketScale(int scaleBucket) {
+    return std::exp2(scaleBucket / (float)kBucketsPerOctave);
+}
+
+TessellatedPathCache::Key TessellatedPathCache::MakeKey(const SkPath& path,
+                                                        PatchType type,
+                                                        tess::PatchAttribs attribs,
+                                                        int scaleBucket) {
+    Key key;
+    // Zero any padding so that the key can be hashed as bytes.
+    memset(&key, 0, sizeof(Key));
+    key.fGenID = path.getGenerationID();
+    key.fScaleBucket = scaleBucket;
+    key.fAttribs = static_cast<uint32_t>(attribs);
+    key.fType = type;
+    return key;
+}
+
+const TessellatedPathCache::Patches* TessellatedPathCache::find(const SkPath& path,
+                                                                PatchType type,
+                                                                tess::PatchAttribs attribs,
+                                                                int scaleBucket) {
+    return fCache.find(MakeKey(path, type, attribs, scaleBucket));
+}
+
+TessellatedPathCache::Patches* TessellatedPathCache::add(const SkPath& path,
+                                                        PatchType type,
+                                                        tess::PatchAttribs attribs,
+                                                        int scaleBucket) {
+    return fCache.insert(MakeKey(path, type, attribs, scaleBucket), Patches{});
+}
+
+void TessellatedPathCache::WritePatches(VertexWriter writer,
+                                        const Patches& patches,
+                                        tess::PatchAttribs attribs,
+                                        float depth,
+                                        skvx::ushort2 ssboIndices) {
+    using tess::PatchAttribs;
+    SkASSERT((attribs & PatchAttribs::kPaintDepth) && (attribs & PatchAttribs::kSsboIndex));
+    SkASSERT((attribs & ~(PatchAttribs::kFanPoint | PatchAttribs::kPaintDepth |
+                          PatchAttribs::kExplicitCurveType | PatchAttribs::kSsboIndex)) ==
+             PatchAttribs::kNone);
+
+    const size_t stride = tess::PatchStride(attribs);
+    const size_t depthOffset = tess::PatchStride(attribs & ~(PatchAttribs::kPaintDepth |
+                                                             PatchAttribs::kExplicitCurveType |
+                                                             PatchAttribs::kSsboIndex));
+    const size_t ssboOffset = stride - sizeof(ssboIndices);
+    SkASSERT(patches.fData.size() == SkToInt(stride) * patches.fCount);
+
+    char patch[tess::PatchStride(PatchAttribs::kFanPoint | PatchAttribs::kPaintDepth |
+                                 PatchAttribs::kExplicitCurveType | PatchAttribs::kSsboIndex)];
+    for (int i = 0; i < patches.fCount; ++i) {
+        memcpy(patch, patches.fData.data() + i * stride, stride);
+        memcpy(patch + depthOffset, &depth, sizeof(depth));
+        memcpy(patch + ssboOffset, &ssboIndices, sizeof(ssboIndices));
+        writer << VertexWriter::Array<char>(patch, SkToInt(stride));
+    }
+}
+
+}  // namespace skgpu::graphite
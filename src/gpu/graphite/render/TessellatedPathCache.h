@@ -0,0 +1,117 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef skgpu_graphite_render_TessellatedPathCache_DEFINED
+#define skgpu_graphite_render_TessellatedPathCache_DEFINED
+
+#include "include/private/base/SkTArray.h"
+#include "src/base/SkVx.h"
+#include "src/core/SkChecksum.h"
+#include "src/core/SkLRUCache.h"
+#include "src/gpu/BufferWriter.h"
+#include "src/gpu/tessellate/LinearTolerances.h"
+#include "src/gpu/tessellate/Tessellation.h"
+
+#include <cstdint>
+
+class SkPath;
+
+namespace skgpu::graphite {
+
+class DrawParams;
+
+/**
+ * The fill patches that TessellateWedgesRenderStep and TessellateCurvesRenderStep wrote for paths
+ * that were drawn by a Recorder, so that a path drawn again (such as an icon drawn many times at
+ * different translations) just copies them into the DrawPass's instance buffer.
+ *
+ * Patches are in the path's local coordinates and the shader applies each draw's transform, so
+ * only the number of segments they need depends on the transform. They are written for the
+ * smallest of a set of fixed scales that is at least the draw's max scale factor, which Wang's
+ * formula is conservative for, so draws whose scales fall into the same bucket share them. The
+ * depth and SSBO indices of each draw are written over the ones captured with the patches.
+ */
+class TessellatedPathCache {
+public:
+    enum class PatchType : uint8_t { kWedges, kCurves };
+
+    struct Patches {
+        skia_private::TArray<char> fData;  // PatchStride(attribs) bytes per patch
+        int fCount = 0;
+        tess::LinearTolerances fTolerances;
+    };
+
+    // The PatchAllocator for skgpu::tess::PatchWriter that captures patches into a Patches.
+    class CapturingPatchAllocator {
+    public:
+        CapturingPatchAllocator(size_t stride, Patches* patches)
+                : fStride(stride), fPatches(patches) {}
+
+        VertexWriter append(const tess::LinearTolerances& tolerances) {
+            fPatches->fTolerances.accumulate(tolerances);
+            fPatches->fCount++;
+            return {fPatches->fData.push_back_n(SkToInt(fStride)), fStride};
+        }
+
+    private:
+        size_t fStride;
+        Patches* fPatches;
+    };
+
+    TessellatedPathCache();
+    ~TessellatedPathCache();
+
+    // Returns whether the patches of the draw's path can be cached at all: it must be a
+    // non-volatile path with few enough verbs.
+    static bool CanCache(const DrawParams&, const SkPath&);
+
+    // The bucket of a draw with 'maxScaleFactor', which must be one CanCache() accepted, and the
+    // scale that the patches of its draws are written for.
+    static int ScaleBucket(float maxScaleFactor);
+    static float BucketScale(int scaleBucket);
+
+    // Returns the patches of the path written for the bucket, or null if there are none.
+    const Patches* find(const SkPath&, PatchType, tess::PatchAttribs, int scaleBucket);
+
+    // Adds empty patches for the path that the caller fills in with a CapturingPatchAllocator.
+    Patches* add(const SkPath&, PatchType, tess::PatchAttribs, int scaleBucket);
+
+    // Writes 'patches' to 'writer', replacing their depth and SSBO indices, which must be the last
+    // attribs of each patch other than an explicit curve type.
+    static void WritePatches(VertexWriter writer,
+                             const Patches& patches,
+                             tess::PatchAttribs,
+                             float depth,
+                             skvx::ushort2 ssboIndices);
+
+private:
+    struct Key {
+        uint32_t fGenID;
+        int32_t fScaleBucket;
+        uint32_t fAttribs;
+        PatchType fType;
+
+        bool operator==(const Key& that) const {
+            return fGenID == that.fGenID && fScaleBucket == that.fScaleBucket &&
+                   fAttribs == that.fAttribs && fType == that.fType;
+        }
+    };
+
+    struct KeyHash {
+        uint32_t operator()(const Key& key) const {
+            return SkChecksum::Hash32(&key, sizeof(Key));
+        }
+    };
+
+    static Key MakeKey(const SkPath&, PatchType, tess::PatchAttribs, int scaleBucket);
+
+    SkLRUCache<Key, Patches, KeyHash> fCache;
+};
+
+}  // namespace skgpu::graphite
+
+#endif  // skgpu_graphite_render_TessellatedPathCache_DEFINED
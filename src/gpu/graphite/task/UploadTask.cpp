@@ -8,6 +8,7 @@
 #include "src/gpu/graphite/task/UploadTask.h"
 
 #include "include/core/SkColorSpace.h"
+#include "include/core/SkPixmap.h"
 #include "include/gpu/graphite/Recorder.h"
 #include "include/private/base/SkAlign.h"
 #include "src/core/SkAutoPixmapStorage.h"
@@ -88,13 +89,106 @@ std::pair<size_t, size_t> compute_combined_buffer_size(
     return {combinedBufferSize, minTransferBufferAlignment};
 }
 
+// Writes the pixels of 'levels' to 'writer' at the offsets and row bytes of
+// 'levelOffsetsAndRowBytes', converting them from 'srcColorInfo' to 'dstColorInfo' if they differ.
+static void write_levels(TextureUploadWriter& writer,
+                         SkSpan<const MipLevel> levels,
+                         const TArray<std::pair<size_t, size_t>>& levelOffsetsAndRowBytes,
+                         const SkColorInfo& srcColorInfo,
+                         const SkColorInfo& dstColorInfo,
+                         SkISize dimensions,
+                         size_t bpp,
+                         bool isRGB888Format) {
+    int32_t currentWidth = dimensions.width();
+    int32_t currentHeight = dimensions.height();
+    bool needsConversion = (srcColorInfo != dstColorInfo);
+    for (size_t currentMipLevel = 0; currentMipLevel < levels.size(); currentMipLevel++) {
+        const size_t trimRowBytes = currentWidth * bpp;
+        const size_t srcRowBytes = levels[currentMipLevel].fRowBytes;
+        const auto [mipOffset, dstRowBytes] = levelOffsetsAndRowBytes[currentMipLevel];
+
+        // copy data into the buffer, skipping any trailing bytes
+        const char* src = (const char*)levels[currentMipLevel].fPixels;
+
+        if (isRGB888Format) {
+            SkASSERT(dstColorInfo.colorType() == kRGB_888x_SkColorType);
+            SkISize dims = {currentWidth, currentHeight};
+            SkImageInfo srcImageInfo = SkImageInfo::Make(dims, srcColorInfo);
+            SkImageInfo dstImageInfo = SkImageInfo::Make(dims, dstColorInfo);
+
+            const void* rgbConvertSrc = src;
+            size_t rgbSrcRowBytes = srcRowBytes;
+            SkAutoPixmapStorage temp;
+            if (needsConversion) {
+                temp.alloc(dstImageInfo);
+                SkAssertResult(SkConvertPixels(dstImageInfo,
+                                               temp.writable_addr(),
+                                               temp.rowBytes(),
+                                               srcImageInfo,
+                                               src,
+                                               srcRowBytes));
+                rgbConvertSrc = temp.addr();
+                rgbSrcRowBytes = temp.rowBytes();
+            }
+            writer.writeRGBFromRGBx(mipOffset,
+                                    rgbConvertSrc,
+                                    rgbSrcRowBytes,
+                                    dstRowBytes,
+                                    currentWidth,
+                                    currentHeight);
+        } else if (needsConversion) {
+            SkISize dims = {currentWidth, currentHeight};
+            SkImageInfo srcImageInfo = SkImageInfo::Make(dims, srcColorInfo);
+            SkImageInfo dstImageInfo = SkImageInfo::Make(dims, dstColorInfo);
+
+            writer.convertAndWrite(
+                    mipOffset, srcImageInfo, src, srcRowBytes, dstImageInfo, dstRowBytes);
+        } else {
+            writer.write(mipOffset, src, srcRowBytes, dstRowBytes, trimRowBytes, currentHeight);
+        }
+
+        currentWidth = std::max(1, currentWidth / 2);
+        currentHeight = std::max(1, currentHeight / 2);
+    }
+}
+
+// Uploads whose buffer space is at least this big are written on the Recorder's upload executor,
+// if it has one. Smaller ones take less time to write than to hand off.
+static constexpr size_t kMinAsyncUploadBytes = 256 << 10;  // 256 KB
+
+// Uploads of at least this many bytes may be copied straight from the source pixels. Wrapping
+// smaller ones costs about as much as copying them, and they rarely start on a page boundary.
+static constexpr size_t kMinHostMemoryUploadBytes = 256 << 10;  // 256 KB
+
+// Returns a buffer that wraps 'level' in place for a copy of 'dimensions' pixels, if the pixels'
+// row bytes suit a buffer-to-texture copy and the backend can wrap the memory. On unified memory
+// this skips copying the pixels into an upload buffer.
+static sk_sp<Buffer> wrap_level_pixels(Recorder* recorder,
+                                       const MipLevel& level,
+                                       SkISize dimensions,
+                                       size_t bpp,
+                                       sk_sp<SkRefCnt> pixelsOwner) {
+    const size_t rowBytes = level.fRowBytes;
+    if (rowBytes % bpp != 0 ||
+        recorder->priv().caps()->getAlignedTextureDataRowBytes(rowBytes) != rowBytes) {
+        return nullptr;
+    }
+    const size_t size = rowBytes * (dimensions.height() - 1) + dimensions.width() * bpp;
+    if (size < kMinHostMemoryUploadBytes) {
+        return nullptr;
+    }
+    return recorder->priv().resourceProvider()->wrapHostMemory(level.fPixels, size,
+                                                               std::move(pixelsOwner));
+}
+
 UploadInstance UploadInstance::Make(Recorder* recorder,
                                     sk_sp<TextureProxy> textureProxy,
                                     const SkColorInfo& srcColorInfo,
                                     const SkColorInfo& dstColorInfo,
                                     SkSpan<const MipLevel> levels,
                                     const SkIRect& dstRect,
-                                    std::unique_ptr<ConditionalUploadContext> condContext) {
+                                    std::unique_ptr<ConditionalUploadContext> condContext,
+                                    sk_sp<SkRefCnt> pixelsOwner) {
     const Caps* caps = recorder->priv().caps();
     SkASSERT(caps->isTexturable(textureProxy->textureInfo()));
     SkASSERT(caps->areColorTypeAndTextureInfoCompatible(dstColorInfo.colorType(),
@@ -141,6 +235,28 @@ UploadInstance UploadInstance::Make(Recorder* recorder,
     }
 
     const size_t bpp = isRGB888Format ? 3 : SkColorTypeBytesPerPixel(supportedColorType);
+
+    // Wrapped pixels are read when the GPU runs the copy, well after this returns, so only pixels
+    // whose owner keeps them alive and unchanged until then can be wrapped.
+    if (pixelsOwner && mipLevelCount == 1 && !isRGB888Format && srcColorInfo == dstColorInfo &&
+        supportedColorType == dstColorInfo.colorType()) {
+        if (sk_sp<Buffer> hostBuffer =
+                    wrap_level_pixels(recorder, levels[0], dstRect.size(), bpp, pixelsOwner)) {
+            UploadInstance upload{hostBuffer.get(), bpp, std::move(textureProxy),
+                                  std::move(condContext)};
+            upload.fHostBuffer = std::move(hostBuffer);
+            upload.fCopyData.push_back({
+                /*fBufferOffset=*/0,
+                /*fBufferRowBytes=*/levels[0].fRowBytes,
+                /*fRect=*/dstRect,
+                /*fMipmapLevel=*/0
+            });
+            ATRACE_ANDROID_FRAMEWORK("Upload Texture From Host Memory [%dx%d]",
+                                     dstRect.width(), dstRect.height());
+            return upload;
+        }
+    }
+
     TArray<std::pair<size_t, size_t>> levelOffsetsAndRowBytes(mipLevelCount);
 
     auto [combinedBufferSize, minAlignment] = compute_combined_buffer_size(
@@ -162,56 +278,37 @@ UploadInstance UploadInstance::Make(Recorder* recorder,
 
     UploadInstance upload{bufferInfo.fBuffer, bpp, std::move(textureProxy), std::move(condContext)};
 
+    SkASSERT(!isRGB888Format || supportedColorType == kRGB_888x_SkColorType);
+    if (PendingUploadWrites* pendingWrites = bufferMgr->pendingWrites();
+        pendingWrites && pixelsOwner && combinedBufferSize >= kMinAsyncUploadBytes) {
+        // The buffer stays mapped until the Recording's writes are done, so the writer's pointer
+        // can be handed to the executor.
+        void* bufferPtr = writer.writableBlock(0, combinedBufferSize, 1);
+        pendingWrites->add([bufferPtr,
+                            combinedBufferSize = combinedBufferSize,
+                            levelsCopy = std::vector<MipLevel>(levels.begin(), levels.end()),
+                            levelOffsetsAndRowBytes,
+                            srcColorInfo,
+                            dstColorInfo,
+                            dimensions = dstRect.size(),
+                            bpp,
+                            isRGB888Format,
+                            pixelsOwner = std::move(pixelsOwner)]() {
+            TRACE_EVENT0("skia.gpu", "UploadInstance async write");
+            TextureUploadWriter asyncWriter(bufferPtr, combinedBufferSize);
+            write_levels(asyncWriter, levelsCopy, levelOffsetsAndRowBytes, srcColorInfo,
+                         dstColorInfo, dimensions, bpp, isRGB888Format);
+        });
+    } else {
+        write_levels(writer, levels, levelOffsetsAndRowBytes, srcColorInfo, dstColorInfo,
+                     dstRect.size(), bpp, isRGB888Format);
+    }
+
     // Fill in copy data
     int32_t currentWidth = dstRect.width();
     int32_t currentHeight = dstRect.height();
-    bool needsConversion = (srcColorInfo != dstColorInfo);
     for (unsigned int currentMipLevel = 0; currentMipLevel < mipLevelCount; currentMipLevel++) {
-        const size_t trimRowBytes = currentWidth * bpp;
-        const size_t srcRowBytes = levels[currentMipLevel].fRowBytes;
         const auto [mipOffset, dstRowBytes] = levelOffsetsAndRowBytes[currentMipLevel];
-
-        // copy data into the buffer, skipping any trailing bytes
-        const char* src = (const char*)levels[currentMipLevel].fPixels;
-
-        if (isRGB888Format) {
-            SkASSERT(supportedColorType == kRGB_888x_SkColorType &&
-                     dstColorInfo.colorType() == kRGB_888x_SkColorType);
-            SkISize dims = {currentWidth, currentHeight};
-            SkImageInfo srcImageInfo = SkImageInfo::Make(dims, srcColorInfo);
-            SkImageInfo dstImageInfo = SkImageInfo::Make(dims, dstColorInfo);
-
-            const void* rgbConvertSrc = src;
-            size_t rgbSrcRowBytes = srcRowBytes;
-            SkAutoPixmapStorage temp;
-            if (needsConversion) {
-                temp.alloc(dstImageInfo);
-                SkAssertResult(SkConvertPixels(dstImageInfo,
-                                               temp.writable_addr(),
-                                               temp.rowBytes(),
-                                               srcImageInfo,
-                                               src,
-                                               srcRowBytes));
-                rgbConvertSrc = temp.addr();
-                rgbSrcRowBytes = temp.rowBytes();
-            }
-            writer.writeRGBFromRGBx(mipOffset,
-                                    rgbConvertSrc,
-                                    rgbSrcRowBytes,
-                                    dstRowBytes,
-                                    currentWidth,
-                                    currentHeight);
-        } else if (needsConversion) {
-            SkISize dims = {currentWidth, currentHeight};
-            SkImageInfo srcImageInfo = SkImageInfo::Make(dims, srcColorInfo);
-            SkImageInfo dstImageInfo = SkImageInfo::Make(dims, dstColorInfo);
-
-            writer.convertAndWrite(
-                    mipOffset, srcImageInfo, src, srcRowBytes, dstImageInfo, dstRowBytes);
-        } else {
-            writer.write(mipOffset, src, srcRowBytes, dstRowBytes, trimRowBytes, currentHeight);
-        }
-
         // For mipped data, the dstRect is always the full texture so we don't need to worry about
         // modifying the TL coord as it will always be 0,0,for all levels.
         upload.fCopyData.push_back({
@@ -232,6 +329,71 @@ UploadInstance UploadInstance::Make(Recorder* recorder,
     return upload;
 }
 
+UploadInstance UploadInstance::MakeInPlace(
+        Recorder* recorder,
+        sk_sp<TextureProxy> textureProxy,
+        const SkColorInfo& colorInfo,
+        const SkIRect& dstRect,
+        const std::function<bool(const SkPixmap&)>& writePixels,
+        std::unique_ptr<ConditionalUploadContext> condContext) {
+    const Caps* caps = recorder->priv().caps();
+    SkASSERT(caps->isTexturable(textureProxy->textureInfo()));
+    SkASSERT(caps->areColorTypeAndTextureInfoCompatible(colorInfo.colorType(),
+                                                        textureProxy->textureInfo()));
+
+    if (dstRect.isEmpty()) {
+        return Invalid();
+    }
+
+    auto [supportedColorType, isRGB888Format] =
+            caps->supportedWritePixelsColorType(colorInfo.colorType(),
+                                                textureProxy->textureInfo(),
+                                                colorInfo.colorType());
+    // The pixels land in the buffer exactly as writePixels produces them.
+    if (supportedColorType != colorInfo.colorType() || isRGB888Format) {
+        return Invalid();
+    }
+
+    const size_t bpp = SkColorTypeBytesPerPixel(supportedColorType);
+    TArray<std::pair<size_t, size_t>> levelOffsetsAndRowBytes(1);
+    auto [combinedBufferSize, minAlignment] = compute_combined_buffer_size(
+            caps,
+            /*mipLevelCount=*/1,
+            bpp,
+            dstRect.size(),
+            SkTextureCompressionType::kNone,
+            &levelOffsetsAndRowBytes);
+    SkASSERT(combinedBufferSize);
+
+    UploadBufferManager* bufferMgr = recorder->priv().uploadBufferManager();
+    auto [writer, bufferInfo] = bufferMgr->getTextureUploadWriter(combinedBufferSize, minAlignment);
+    if (!writer) {
+        SKGPU_LOG_W("Failed to get write-mapped buffer for texture upload of size %zu",
+                    combinedBufferSize);
+        return Invalid();
+    }
+
+    const auto [offset, dstRowBytes] = levelOffsetsAndRowBytes[0];
+    SkPixmap dst(SkImageInfo::Make(dstRect.size(), colorInfo),
+                 writer.writableBlock(offset, dstRowBytes, dstRect.height()),
+                 dstRowBytes);
+    if (!writePixels(dst)) {
+        return Invalid();
+    }
+
+    UploadInstance upload{bufferInfo.fBuffer, bpp, std::move(textureProxy), std::move(condContext)};
+    upload.fCopyData.push_back({
+        /*fBufferOffset=*/bufferInfo.fOffset + offset,
+        /*fBufferRowBytes=*/dstRowBytes,
+        /*fRect=*/dstRect,
+        /*fMipmapLevel=*/0
+    });
+
+    ATRACE_ANDROID_FRAMEWORK("Upload Texture In Place [%dx%d]", dstRect.width(), dstRect.height());
+
+    return upload;
+}
+
 UploadInstance UploadInstance::MakeCompressed(Recorder* recorder,
                                               sk_sp<TextureProxy> textureProxy,
                                               const void* data,
@@ -355,6 +517,11 @@ Task::Status UploadInstance::addCommand(Context* context,
         return Status::kSuccess;
     }
 
+    if (fHostBuffer) {
+        // The wrapped pixels must stay alive until the GPU has copied them.
+        commandBuffer->trackResource(fHostBuffer);
+    }
+
     if (fTextureProxy->texture() != replayData.fTarget) {
         // The CommandBuffer doesn't take ownership of the upload buffer here; it's owned by
         // UploadBufferManager, which will transfer ownership in transferToCommandBuffer.
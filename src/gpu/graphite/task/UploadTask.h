@@ -16,8 +16,11 @@
 #include "include/private/base/SkTArray.h"
 #include "src/gpu/graphite/CommandTypes.h"
 
+#include <functional>
 #include <memory>
 
+class SkPixmap;
+
 namespace skgpu::graphite {
 
 class Buffer;
@@ -69,13 +72,28 @@ public:
  */
 class UploadInstance {
 public:
+    // If 'pixelsOwner' is not null it keeps the pixels of 'levels' alive and unchanged for as long
+    // as it is referenced, so it must not be passed for borrowed or mutable pixels. A large upload
+    // that needs no conversion is then copied by the GPU straight from the pixels if the backend
+    // can wrap them in a buffer. Otherwise it is written to its upload buffer on the Recorder's
+    // upload executor, if it has one, after this returns.
     static UploadInstance Make(Recorder*,
                                sk_sp<TextureProxy> targetProxy,
                                const SkColorInfo& srcColorInfo,
                                const SkColorInfo& dstColorInfo,
                                SkSpan<const MipLevel> levels,
                                const SkIRect& dstRect,
-                               std::unique_ptr<ConditionalUploadContext>);
+                               std::unique_ptr<ConditionalUploadContext>,
+                               sk_sp<SkRefCnt> pixelsOwner = nullptr);
+    // Reserves upload buffer space for dstRect of the base level and has writePixels fill it in
+    // place, so the pixels are never copied on the CPU. Fails if the texture can't take
+    // colorInfo's color type without a conversion.
+    static UploadInstance MakeInPlace(Recorder*,
+                                      sk_sp<TextureProxy> targetProxy,
+                                      const SkColorInfo& colorInfo,
+                                      const SkIRect& dstRect,
+                                      const std::function<bool(const SkPixmap&)>& writePixels,
+                                      std::unique_ptr<ConditionalUploadContext>);
     static UploadInstance MakeCompressed(Recorder*,
                                          sk_sp<TextureProxy> targetProxy,
                                          const void* data,
@@ -104,6 +122,8 @@ private:
                    std::unique_ptr<ConditionalUploadContext> = nullptr);
 
     const Buffer* fBuffer;
+    // Set if fBuffer wraps the source pixels, which the UploadBufferManager doesn't own.
+    sk_sp<Buffer> fHostBuffer;
     size_t fBytesPerPixel;
     sk_sp<TextureProxy> fTextureProxy;
     skia_private::STArray<1, BufferTextureCopyData> fCopyData;
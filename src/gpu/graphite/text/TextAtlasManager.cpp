@@ -10,12 +10,15 @@
 #include "include/core/SkColorSpace.h"
 #include "include/gpu/graphite/Recorder.h"
 #include "src/base/SkAutoMalloc.h"
+#include "src/base/SkMathPriv.h"
 #include "src/core/SkDistanceFieldGen.h"
 #include "src/core/SkMasks.h"
+#include "src/gpu/RefCntedCallback.h"
 #include "src/gpu/graphite/AtlasProvider.h"
 #include "src/gpu/graphite/DrawAtlas.h"
 #include "src/gpu/graphite/RecorderPriv.h"
 #include "src/gpu/graphite/TextureProxy.h"
+#include "src/gpu/graphite/task/UploadTask.h"
 #include "src/sksl/SkSLUtil.h"
 #include "src/text/gpu/Glyph.h"
 #include "src/text/gpu/GlyphVector.h"
@@ -25,27 +28,48 @@ using Glyph = sktext::gpu::Glyph;
 
 namespace skgpu::graphite {
 
-TextAtlasManager::TextAtlasManager(Recorder* recorder)
-        : fRecorder(recorder)
-        , fSupportBilerpAtlas{recorder->priv().caps()->supportBilerpFromGlyphAtlas()}
-        , fAtlasConfig{recorder->priv().caps()->maxTextureSize(),
-                       recorder->priv().caps()->glyphCacheTextureMaximumBytes()} {
-    if (!recorder->priv().caps()->allowMultipleAtlasTextures() ||
+TextAtlasManager::TextAtlasManager(const Caps* caps, DrawAtlas::Shared shared)
+        : fCaps(caps)
+        , fShared(shared)
+        , fSupportBilerpAtlas{caps->supportBilerpFromGlyphAtlas()}
+        , fAtlasConfig{caps->maxTextureSize(), caps->glyphCacheTextureMaximumBytes()} {
+    if (!caps->allowMultipleAtlasTextures() ||
         // multitexturing supported only if range can represent the index + texcoords fully
-        !(recorder->priv().caps()->shaderCaps()->fFloatIs32Bits ||
-          recorder->priv().caps()->shaderCaps()->fIntegerSupport)) {
+        !(caps->shaderCaps()->fFloatIs32Bits || caps->shaderCaps()->fIntegerSupport)) {
         fAllowMultitexturing = DrawAtlas::AllowMultitexturing::kNo;
     } else {
         fAllowMultitexturing = DrawAtlas::AllowMultitexturing::kYes;
     }
+    if (this->isShared()) {
+        fSharedStrikeCache = std::make_unique<sktext::gpu::StrikeCache>();
+    }
 }
 
 TextAtlasManager::~TextAtlasManager() = default;
 
+unsigned int TextAtlasManager::getProxies(
+        MaskFormat format, sk_sp<TextureProxy> proxies[PlotLocator::kMaxMultitexturePages]) {
+    AutoLock lock(this);
+    format = this->resolveMaskFormat(format);
+    if (!this->initAtlas(format)) {
+        return 0;
+    }
+    const DrawAtlas* atlas = this->getAtlas(format);
+    for (unsigned int i = 0; i < atlas->numActivePages(); ++i) {
+        proxies[i] = atlas->getProxies()[i];
+    }
+    return atlas->numActivePages();
+}
+
 void TextAtlasManager::freeAll() {
+    AutoLock lock(this);
     for (int i = 0; i < kMaskFormatCount; ++i) {
         fAtlases[i] = nullptr;
     }
+    // Pins on the atlases just deleted are ignored when they are released.
+    if (fSharedStrikeCache) {
+        fSharedStrikeCache->freeAll();
+    }
 }
 
 bool TextAtlasManager::hasGlyph(MaskFormat format, Glyph* glyph) {
@@ -162,10 +186,10 @@ static void get_packed_glyph_image(
 
 MaskFormat TextAtlasManager::resolveMaskFormat(MaskFormat format) const {
     if (MaskFormat::kA565 == format &&
-        !fRecorder->priv().caps()->getDefaultSampledTextureInfo(kRGB_565_SkColorType,
-                                                                /*mipmapped=*/Mipmapped::kNo,
-                                                                Protected::kNo,
-                                                                Renderable::kNo).isValid()) {
+        !fCaps->getDefaultSampledTextureInfo(kRGB_565_SkColorType,
+                                             /*mipmapped=*/Mipmapped::kNo,
+                                             Protected::kNo,
+                                             Renderable::kNo).isValid()) {
         format = MaskFormat::kARGB;
     }
     return format;
@@ -173,7 +197,8 @@ MaskFormat TextAtlasManager::resolveMaskFormat(MaskFormat format) const {
 
 // Returns kSucceeded if glyph successfully added to texture atlas, kTryAgain if a RenderPassTask
 // needs to be snapped before adding the glyph, and kError if it can't be added at all.
-DrawAtlas::ErrorCode TextAtlasManager::addGlyphToAtlas(const SkGlyph& skGlyph,
+DrawAtlas::ErrorCode TextAtlasManager::addGlyphToAtlas(Recorder* recorder,
+                                                       const SkGlyph& skGlyph,
                                                        Glyph* glyph,
                                                        int srcPadding) {
 #if !defined(SK_DISABLE_SDF_TEXT)
@@ -237,7 +262,7 @@ DrawAtlas::ErrorCode TextAtlasManager::addGlyphToAtlas(const SkGlyph& skGlyph,
     get_packed_glyph_image(skGlyph, rowBytes, expectedMaskFormat, dataPtr);
 
     DrawAtlas* atlas = this->getAtlas(expectedMaskFormat);
-    auto errorCode = atlas->addToAtlas(fRecorder,
+    auto errorCode = atlas->addToAtlas(recorder,
                                        width,
                                        height,
                                        storage.get(),
@@ -250,9 +275,15 @@ DrawAtlas::ErrorCode TextAtlasManager::addGlyphToAtlas(const SkGlyph& skGlyph,
     return errorCode;
 }
 
-bool TextAtlasManager::recordUploads(DrawContext* dc) {
+bool TextAtlasManager::recordUploads(Recorder* recorder, DrawContext* dc) {
+    if (this->isShared()) {
+        // The Context records the uploads of a shared atlas when inserting Recordings.
+        return true;
+    }
+
+    AutoLock lock(this);
     for (int i = 0; i < skgpu::kMaskFormatCount; i++) {
-        if (fAtlases[i] && !fAtlases[i]->recordUploads(dc, fRecorder)) {
+        if (fAtlases[i] && !fAtlases[i]->recordUploads(dc, recorder)) {
             return false;
         }
     }
@@ -260,17 +291,137 @@ bool TextAtlasManager::recordUploads(DrawContext* dc) {
     return true;
 }
 
-void TextAtlasManager::addGlyphToBulkAndSetUseToken(BulkUsePlotUpdater* updater,
+AtlasToken TextAtlasManager::nextFlushToken(Recorder* recorder) const {
+    return this->isShared() ? fSharedTokenTracker.nextFlushToken()
+                            : recorder->priv().tokenTracker()->nextFlushToken();
+}
+
+void TextAtlasManager::addGlyphToBulkAndSetUseToken(Recorder* recorder,
+                                                    BulkUsePlotUpdater* updater,
                                                     MaskFormat format,
                                                     Glyph* glyph,
                                                     AtlasToken token) {
     SkASSERT(glyph);
     if (updater->add(glyph->fAtlasLocator)) {
         this->getAtlas(format)->setLastUseToken(glyph->fAtlasLocator, token);
+        this->pinPlot(recorder, format, glyph->fAtlasLocator.pageIndex(),
+                      glyph->fAtlasLocator.plotIndex());
+    }
+}
+
+void TextAtlasManager::setUseTokenBulk(Recorder* recorder,
+                                       const BulkUsePlotUpdater& updater,
+                                       AtlasToken token,
+                                       MaskFormat format) {
+    DrawAtlas* atlas = this->getAtlas(format);
+    atlas->setLastUseTokenBulk(updater, token);
+    for (int i = 0; i < updater.count(); ++i) {
+        const BulkUsePlotUpdater::PlotData& pd = updater.plotData(i);
+        if (pd.fPageIndex < atlas->numActivePages()) {
+            this->pinPlot(recorder, format, pd.fPageIndex, pd.fPlotIndex);
+        }
+    }
+}
+
+void TextAtlasManager::pinPlot(Recorder* recorder,
+                               MaskFormat format,
+                               uint32_t pageIdx,
+                               uint32_t plotIdx) {
+    if (!this->isShared()) {
+        return;
+    }
+    DrawAtlas* atlas = this->getAtlas(format);
+    const int index = MaskFormatToAtlasIndex(this->resolveMaskFormat(format));
+    PlotPins* pins = fPendingPins.find(recorder->priv().uniqueID());
+    if (!pins) {
+        pins = fPendingPins.set(recorder->priv().uniqueID(), PlotPins());
+    }
+    if (pins->fAtlasIDs[index] != atlas->atlasID()) {
+        // Any pins held are on an atlas that has since been deleted.
+        pins->fAtlasIDs[index] = atlas->atlasID();
+        memset(pins->fPlots[index], 0, sizeof(pins->fPlots[index]));
+    }
+    const uint32_t bit = 1u << plotIdx;
+    if (!(pins->fPlots[index][pageIdx] & bit)) {
+        pins->fPlots[index][pageIdx] |= bit;
+        atlas->pinPlot(pageIdx, plotIdx);
+    }
+}
+
+void TextAtlasManager::unpinPlots(const PlotPins& pins) {
+    for (int i = 0; i < kMaskFormatCount; ++i) {
+        DrawAtlas* atlas = fAtlases[i].get();
+        if (!atlas || atlas->atlasID() != pins.fAtlasIDs[i]) {
+            continue;
+        }
+        for (uint32_t page = 0; page < PlotLocator::kMaxMultitexturePages; ++page) {
+            for (uint32_t plots = pins.fPlots[i][page]; plots; plots &= plots - 1) {
+                atlas->unpinPlot(page, SkCTZ(plots));
+            }
+        }
+    }
+}
+
+sk_sp<RefCntedCallback> TextAtlasManager::takePlotPins(Recorder* recorder) {
+    SkASSERT(this->isShared());
+    AutoLock lock(this);
+    PlotPins* pins = fPendingPins.find(recorder->priv().uniqueID());
+    if (!pins) {
+        return nullptr;
+    }
+    auto context = new std::pair<sk_sp<TextAtlasManager>, PlotPins>(sk_ref_sp(this), *pins);
+    fPendingPins.remove(recorder->priv().uniqueID());
+    return RefCntedCallback::Make(&TextAtlasManager::ReleasePlotPins,
+                                  static_cast<RefCntedCallback::Context>(context));
+}
+
+void TextAtlasManager::ReleasePlotPins(void* context) {
+    std::unique_ptr<std::pair<sk_sp<TextAtlasManager>, PlotPins>> pins(
+            static_cast<std::pair<sk_sp<TextAtlasManager>, PlotPins>*>(context));
+    TextAtlasManager* manager = pins->first.get();
+    AutoLock lock(manager);
+    manager->unpinPlots(pins->second);
+}
+
+void TextAtlasManager::releasePlotPins(Recorder* recorder) {
+    if (!this->isShared()) {
+        return;
+    }
+    AutoLock lock(this);
+    if (const PlotPins* pins = fPendingPins.find(recorder->priv().uniqueID())) {
+        this->unpinPlots(*pins);
+        fPendingPins.remove(recorder->priv().uniqueID());
+    }
+}
+
+bool TextAtlasManager::hasPendingUploads() {
+    SkASSERT(this->isShared());
+    AutoLock lock(this);
+    for (int i = 0; i < kMaskFormatCount; ++i) {
+        if (fAtlases[i] && fAtlases[i]->hasPendingUploads()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool TextAtlasManager::recordPendingUploads(Recorder* recorder) {
+    SkASSERT(this->isShared());
+    AutoLock lock(this);
+    UploadList uploads;
+    for (int i = 0; i < kMaskFormatCount; ++i) {
+        if (fAtlases[i] && !fAtlases[i]->recordUploads(&uploads, recorder)) {
+            return false;
+        }
+    }
+    if (sk_sp<UploadTask> task = UploadTask::Make(&uploads)) {
+        recorder->priv().add(std::move(task));
     }
+    return true;
 }
 
 void TextAtlasManager::setAtlasDimensionsToMinimum_ForTesting() {
+    AutoLock lock(this);
     // Delete any old atlases.
     // This should be safe to do as long as we are not in the middle of a flush.
     for (int i = 0; i < skgpu::kMaskFormatCount; i++) {
@@ -282,6 +433,7 @@ void TextAtlasManager::setAtlasDimensionsToMinimum_ForTesting() {
 }
 
 bool TextAtlasManager::initAtlas(MaskFormat format) {
+    format = this->resolveMaskFormat(format);
     int index = MaskFormatToAtlasIndex(format);
     if (fAtlases[index] == nullptr) {
         SkColorType colorType = MaskFormatToColorType(format);
@@ -294,6 +446,7 @@ bool TextAtlasManager::initAtlas(MaskFormat format) {
                                           /*generationCounter=*/this,
                                           fAllowMultitexturing,
                                           DrawAtlas::UseStorageTextures::kNo,
+                                          fShared,
                                           /*evictor=*/nullptr,
                                           /*label=*/"TextAtlas");
         if (!fAtlases[index]) {
@@ -303,11 +456,25 @@ bool TextAtlasManager::initAtlas(MaskFormat format) {
     return true;
 }
 
-void TextAtlasManager::postFlush() {
-    auto tokenTracker = fRecorder->priv().tokenTracker();
+void TextAtlasManager::postFlush(Recorder* recorder) {
+    AutoLock lock(this);
+    if (this->isShared()) {
+        fSharedTokenTracker.issueFlushToken();
+    }
+    const AtlasToken nextFlushToken = this->nextFlushToken(recorder);
+    for (int i = 0; i < kMaskFormatCount; ++i) {
+        if (fAtlases[i]) {
+            fAtlases[i]->compact(nextFlushToken);
+        }
+    }
+}
+
+void TextAtlasManager::addToMemoryReport(GpuMemoryReport* report) const {
+    AutoLock lock(this);
     for (int i = 0; i < kMaskFormatCount; ++i) {
         if (fAtlases[i]) {
-            fAtlases[i]->compact(tokenTracker->nextFlushToken());
+            fAtlases[i]->addToMemoryReport(
+                    MaskFormatToTextAtlasName(AtlasIndexToMaskFormat(i)), report);
         }
     }
 }
@@ -326,20 +493,21 @@ std::tuple<bool, int> GlyphVector::regenerateAtlasForGraphite(int begin,
                                                               int srcPadding,
                                                               skgpu::graphite::Recorder* recorder) {
     auto atlasManager = recorder->priv().atlasProvider()->textAtlasManager();
-    auto tokenTracker = recorder->priv().tokenTracker();
+    // Other Recorders may be placing glyphs in a shared atlas, so hold its lock throughout.
+    skgpu::graphite::TextAtlasManager::AutoLock lock(atlasManager);
 
     // TODO: this is not a great place for this -- need a better way to init atlases when needed
-    unsigned int numActiveProxies;
-    const sk_sp<skgpu::graphite::TextureProxy>* proxies =
-            atlasManager->getProxies(maskFormat, &numActiveProxies);
-    if (!proxies) {
+    if (!atlasManager->initAtlas(maskFormat)) {
         SkDebugf("Could not allocate backing texture for atlas\n");
         return {false, 0};
     }
 
     uint64_t currentAtlasGen = atlasManager->atlasGeneration(maskFormat);
+    const skgpu::AtlasToken nextFlushToken = atlasManager->nextFlushToken(recorder);
 
-    this->packedGlyphIDToGlyph(recorder->priv().strikeCache());
+    sktext::gpu::StrikeCache* sharedStrikeCache = atlasManager->sharedStrikeCache();
+    this->packedGlyphIDToGlyph(sharedStrikeCache ? sharedStrikeCache
+                                                 : recorder->priv().strikeCache());
 
     if (fAtlasGeneration != currentAtlasGen) {
         // Calculate the texture coordinates for the vertexes during first use (fAtlasGeneration
@@ -358,15 +526,18 @@ std::tuple<bool, int> GlyphVector::regenerateAtlasForGraphite(int begin,
 
             if (!atlasManager->hasGlyph(maskFormat, gpuGlyph)) {
                 const SkGlyph& skGlyph = *metricsAndImages.glyph(gpuGlyph->fPackedID);
-                auto code = atlasManager->addGlyphToAtlas(skGlyph, gpuGlyph, srcPadding);
+                auto code = atlasManager->addGlyphToAtlas(recorder, skGlyph, gpuGlyph, srcPadding);
                 if (code != DrawAtlas::ErrorCode::kSucceeded) {
-                    success = code != DrawAtlas::ErrorCode::kError;
+                    // The plots of a full shared atlas are only freed as the Recordings that read
+                    // them finish, which flushing this Recorder does not wait for. So draw what
+                    // was placed and try the rest again, but give up if nothing fit.
+                    success = code == DrawAtlas::ErrorCode::kTryAgain &&
+                              (glyphsPlacedInAtlas > 0 || !atlasManager->isShared());
                     break;
                 }
             }
             atlasManager->addGlyphToBulkAndSetUseToken(
-                    &fBulkUseUpdater, maskFormat, gpuGlyph,
-                    tokenTracker->nextFlushToken());
+                    recorder, &fBulkUseUpdater, maskFormat, gpuGlyph, nextFlushToken);
             glyphsPlacedInAtlas++;
         }
 
@@ -383,9 +554,7 @@ std::tuple<bool, int> GlyphVector::regenerateAtlasForGraphite(int begin,
         if (end == SkCount(fGlyphs)) {
             // The atlas hasn't changed and the texture coordinates are all still valid. Update
             // all the plots used to the new use token.
-            atlasManager->setUseTokenBulk(fBulkUseUpdater,
-                                          tokenTracker->nextFlushToken(),
-                                          maskFormat);
+            atlasManager->setUseTokenBulk(recorder, fBulkUseUpdater, nextFlushToken, maskFormat);
         }
         return {true, end - begin};
     }
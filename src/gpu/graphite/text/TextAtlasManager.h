@@ -8,16 +8,28 @@
 #ifndef skgpu_graphite_TextAtlasManager_DEFINED
 #define skgpu_graphite_TextAtlasManager_DEFINED
 
+#include "include/core/SkRefCnt.h"
 #include "include/gpu/graphite/TextureInfo.h"
+#include "include/private/base/SkMutex.h"
+#include "include/private/base/SkThreadAnnotations.h"
+#include "src/core/SkTHash.h"
 #include "src/gpu/AtlasTypes.h"
 #include "src/gpu/graphite/Caps.h"
 #include "src/gpu/graphite/DrawAtlas.h"
 
+#include <memory>
+
 namespace sktext::gpu {
 class Glyph;
+class StrikeCache;
 }
 class SkGlyph;
 
+namespace skgpu {
+struct GpuMemoryReport;
+class RefCntedCallback;
+}
+
 namespace skgpu::graphite {
 
 class Recorder;
@@ -25,51 +37,92 @@ class UploadList;
 
 //////////////////////////////////////////////////////////////////////////////////////////////////
 /** The TextAtlasManager manages the lifetime of and access to DrawAtlases used in glyph rendering.
+ *
+ * Each Recorder has its own TextAtlasManager, unless the Context was made with
+ * ContextOptions::fShareGlyphAtlasAcrossRecorders, in which case all of its Recorders use one that
+ * the Context makes. A shared TextAtlasManager also keeps the Glyphs that locate masks in the
+ * atlas, so that each mask is placed and uploaded once for all Recorders. It pins the plots that a
+ * Recorder's draws read until the GPU is done with the Recording they are snapped into (see
+ * takePlotPins()), and leaves uploading to the Context, which records the uploads that all
+ * Recorders have queued ahead of each Recording it inserts (see recordPendingUploads()).
+ *
+ * The methods that place glyphs must be called with an AutoLock held, while the rest take one
+ * themselves. Only a shared TextAtlasManager locks; one owned by a Recorder is only ever used on
+ * that Recorder's thread, so its AutoLocks do nothing.
  */
-class TextAtlasManager : public AtlasGenerationCounter {
+class TextAtlasManager : public AtlasGenerationCounter, public SkRefCnt {
 public:
-    TextAtlasManager(Recorder*);
-    ~TextAtlasManager();
-
-    // If getProxies returns nullptr, the client must not try to use other functions on the
-    // StrikeCache which use the atlas.  This function *must* be called first, before other
-    // functions which use the atlas.
-    const sk_sp<TextureProxy>* getProxies(MaskFormat format,
-                                          unsigned int* numActiveProxies) {
-        format = this->resolveMaskFormat(format);
-        if (this->initAtlas(format)) {
-            *numActiveProxies = this->getAtlas(format)->numActivePages();
-            return this->getAtlas(format)->getProxies();
+    TextAtlasManager(const Caps*, DrawAtlas::Shared);
+    ~TextAtlasManager() override;
+
+    bool isShared() const { return fShared == DrawAtlas::Shared::kYes; }
+
+    // Holds the lock of a shared TextAtlasManager for its lifetime.
+    class SK_SCOPED_CAPABILITY AutoLock {
+    public:
+        AutoLock(const TextAtlasManager* manager) SK_ACQUIRE(manager->fMutex)
+                SK_NO_THREAD_SAFETY_ANALYSIS
+                : fMutex(manager->isShared() ? &manager->fMutex : nullptr) {
+            if (fMutex) {
+                fMutex->acquire();
+            }
+        }
+
+        ~AutoLock() SK_RELEASE_CAPABILITY() SK_NO_THREAD_SAFETY_ANALYSIS {
+            if (fMutex) {
+                fMutex->release();
+            }
         }
-        *numActiveProxies = 0;
-        return nullptr;
+
+    private:
+        SkMutex* const fMutex;
+    };
+
+    // Copies the proxies of the active pages of the atlas for the format into 'proxies' and
+    // returns their number. If that is zero the atlas could not be made, and the client must not
+    // try to use other functions which use the atlas. This function *must* be called first,
+    // before other functions which use the atlas.
+    unsigned int getProxies(MaskFormat format,
+                            sk_sp<TextureProxy> proxies[PlotLocator::kMaxMultitexturePages]);
+
+    // Null unless the TextAtlasManager is shared, in which case the Glyphs placed in its atlases
+    // must come from this StrikeCache, used with an AutoLock held.
+    sktext::gpu::StrikeCache* sharedStrikeCache() const SK_REQUIRES(fMutex) {
+        return fSharedStrikeCache.get();
     }
 
     void freeAll();
 
-    bool hasGlyph(MaskFormat, sktext::gpu::Glyph*);
+    bool initAtlas(MaskFormat) SK_REQUIRES(fMutex);
+
+    bool hasGlyph(MaskFormat, sktext::gpu::Glyph*) SK_REQUIRES(fMutex);
 
-    DrawAtlas::ErrorCode addGlyphToAtlas(const SkGlyph&,
+    DrawAtlas::ErrorCode addGlyphToAtlas(Recorder*,
+                                         const SkGlyph&,
                                          sktext::gpu::Glyph*,
-                                         int srcPadding);
+                                         int srcPadding) SK_REQUIRES(fMutex);
+
+    // The token to pass to addGlyphToBulkAndSetUseToken() and setUseTokenBulk() for draws that
+    // the Recorder is making now.
+    AtlasToken nextFlushToken(Recorder*) const SK_REQUIRES(fMutex);
 
     // To ensure the DrawAtlas does not evict the Glyph Mask from its texture backing store,
     // the client must pass in the current draw token along with the sktext::gpu::Glyph.
     // A BulkUsePlotUpdater is used to manage bulk last use token updating in the Atlas.
     // For convenience, this function will also set the use token for the current glyph if required
     // NOTE: the bulk uploader is only valid if the subrun has a valid atlasGeneration
-    void addGlyphToBulkAndSetUseToken(BulkUsePlotUpdater*, MaskFormat,
-                                      sktext::gpu::Glyph*, AtlasToken);
+    void addGlyphToBulkAndSetUseToken(Recorder*, BulkUsePlotUpdater*, MaskFormat,
+                                      sktext::gpu::Glyph*, AtlasToken) SK_REQUIRES(fMutex);
 
-    void setUseTokenBulk(const BulkUsePlotUpdater& updater,
+    void setUseTokenBulk(Recorder*,
+                         const BulkUsePlotUpdater& updater,
                          AtlasToken token,
-                         MaskFormat format) {
-        this->getAtlas(format)->setLastUseTokenBulk(updater, token);
-    }
+                         MaskFormat format) SK_REQUIRES(fMutex);
 
-    bool recordUploads(DrawContext* dc);
+    bool recordUploads(Recorder*, DrawContext* dc);
 
     void evictAtlases() {
+        AutoLock lock(this);
         for (int i = 0; i < kMaskFormatCount; ++i) {
             if (fAtlases[i]) {
                 fAtlases[i]->evictAllPlots();
@@ -77,15 +130,38 @@ public:
         }
     }
 
-    void postFlush();
+    void postFlush(Recorder*);
+
+    // Adds the glyph atlases that have been created to 'report'.
+    void addToMemoryReport(GpuMemoryReport*) const;
 
     // Some clients may wish to verify the integrity of the texture backing store of the
     // GrDrawOpAtlas. The atlasGeneration returned below is a monotonically increasing number which
     // changes every time something is removed from the texture backing store.
-    uint64_t atlasGeneration(skgpu::MaskFormat format) const {
+    uint64_t atlasGeneration(skgpu::MaskFormat format) const SK_REQUIRES(fMutex) {
         return this->getAtlas(format)->atlasGeneration();
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    // Functions for shared TextAtlasManagers only
+
+    // Hands off the pins on the plots read by the Recorder's draws since it last did, to be held
+    // until the returned callback is destroyed. The Recorder adds it to the finished procs of the
+    // Recording it snaps, so that the plots stay put until the GPU is done with the Recording, or
+    // the Recording is deleted without being inserted. Returns null if there are no pins.
+    sk_sp<RefCntedCallback> takePlotPins(Recorder*);
+
+    // Drops the pins of a Recorder that is going away with draws that were never snapped.
+    void releasePlotPins(Recorder*);
+
+    // Whether any Recorder has placed glyphs that are not yet uploaded.
+    bool hasPendingUploads();
+
+    // Records UploadTasks on the Recorder for all glyphs that are not yet uploaded. The Context
+    // calls this with an internal Recorder, and inserts what it snaps, before inserting each
+    // Recording.
+    bool recordPendingUploads(Recorder*);
+
     ///////////////////////////////////////////////////////////////////////////
     // Functions intended debug only
 
@@ -93,7 +169,16 @@ public:
     void setMaxPages_TestingOnly(uint32_t maxPages);
 
 private:
-    bool initAtlas(MaskFormat);
+    // The plots, by atlas and page, that a Recorder's draws read and that are pinned for them.
+    struct PlotPins {
+        uint32_t fAtlasIDs[kMaskFormatCount] = {};
+        uint32_t fPlots[kMaskFormatCount][PlotLocator::kMaxMultitexturePages] = {};
+    };
+
+    void pinPlot(Recorder*, MaskFormat, uint32_t pageIdx, uint32_t plotIdx) SK_REQUIRES(fMutex);
+    void unpinPlots(const PlotPins&) SK_REQUIRES(fMutex);
+    static void ReleasePlotPins(void* context);
+
     // Change an expected 565 mask format to 8888 if 565 is not supported (will happen when using
     // Metal on Intel MacOS). The actual conversion of the data is handled in
     // get_packed_glyph_image() in StrikeCache.cpp
@@ -107,19 +192,28 @@ private:
         return static_cast<skgpu::MaskFormat>(idx);
     }
 
-    DrawAtlas* getAtlas(skgpu::MaskFormat format) const {
+    DrawAtlas* getAtlas(skgpu::MaskFormat format) const SK_REQUIRES(fMutex) {
         format = this->resolveMaskFormat(format);
         int atlasIndex = MaskFormatToAtlasIndex(format);
         SkASSERT(fAtlases[atlasIndex]);
         return fAtlases[atlasIndex].get();
     }
 
-    Recorder* fRecorder;
+    const Caps* fCaps;
+    const DrawAtlas::Shared fShared;
     DrawAtlas::AllowMultitexturing fAllowMultitexturing;
-    std::unique_ptr<DrawAtlas> fAtlases[kMaskFormatCount];
+    mutable SkMutex fMutex;
+    std::unique_ptr<DrawAtlas> fAtlases[kMaskFormatCount] SK_GUARDED_BY(fMutex);
     static_assert(kMaskFormatCount == 3);
     bool fSupportBilerpAtlas;
     DrawAtlasConfig fAtlasConfig;
+
+    // Only used when shared. Each Recorder has its own tokens, so a shared atlas counts the
+    // flushes of all of them with its own.
+    TokenTracker fSharedTokenTracker SK_GUARDED_BY(fMutex);
+    std::unique_ptr<sktext::gpu::StrikeCache> fSharedStrikeCache SK_GUARDED_BY(fMutex);
+    // The pins of each Recorder's draws that have not yet been snapped, by Recorder ID.
+    skia_private::THashMap<uint32_t, PlotPins> fPendingPins SK_GUARDED_BY(fMutex);
 };
 
 }  // namespace skgpu::graphite
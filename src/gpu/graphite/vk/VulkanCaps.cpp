@@ -78,6 +78,10 @@ void VulkanCaps::init(const ContextOptions& contextOptions,
     fRequiredStorageBufferAlignment =  physDevProperties.limits.minStorageBufferOffsetAlignment;
     fRequiredTransferBufferAlignment = 4;
 
+    if (physDevProperties.limits.timestampComputeAndGraphics) {
+        fTimestampPeriod = std::max(physDevProperties.limits.timestampPeriod, 0.f);
+    }
+
     fResourceBindingReqs.fUniformBufferLayout = Layout::kStd140;
     // TODO(skia:14639): We cannot use std430 layout for SSBOs until SkSL gracefully handles
     // implicit array stride.
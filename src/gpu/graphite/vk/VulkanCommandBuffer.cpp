@@ -106,6 +106,10 @@ VulkanCommandBuffer::~VulkanCommandBuffer() {
         VULKAN_CALL(fSharedContext->interface(),
                     DestroyFence(fSharedContext->device(), fSubmitFence, nullptr));
     }
+    if (VK_NULL_HANDLE != fTimestampQueryPool) {
+        VULKAN_CALL(fSharedContext->interface(),
+                    DestroyQueryPool(fSharedContext->device(), fTimestampQueryPool, nullptr));
+    }
     // This should delete any command buffers as well.
     VULKAN_CALL(fSharedContext->interface(),
                 DestroyCommandPool(fSharedContext->device(), fPool, nullptr));
@@ -134,6 +138,59 @@ void VulkanCommandBuffer::onResetCommandBuffer() {
     }
 }
 
+bool VulkanCommandBuffer::onStartGpuTimer() {
+    SkASSERT(fActive && !fActiveRenderPass);
+    if (fSharedContext->vulkanCaps().timestampPeriod() <= 0.f) {
+        return false;
+    }
+    if (fTimestampQueryPool == VK_NULL_HANDLE) {
+        VkQueryPoolCreateInfo createInfo = {};
+        createInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+        createInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+        createInfo.queryCount = 2;
+        VkResult result;
+        VULKAN_CALL_RESULT(fSharedContext,
+                           result,
+                           CreateQueryPool(fSharedContext->device(),
+                                           &createInfo,
+                                           nullptr,
+                                           &fTimestampQueryPool));
+        if (result != VK_SUCCESS) {
+            fTimestampQueryPool = VK_NULL_HANDLE;
+            return false;
+        }
+    }
+    VULKAN_CALL(fSharedContext->interface(),
+                CmdResetQueryPool(fPrimaryCommandBuffer, fTimestampQueryPool, 0, 2));
+    VULKAN_CALL(fSharedContext->interface(),
+                CmdWriteTimestamp(fPrimaryCommandBuffer,
+                                  VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                                  fTimestampQueryPool,
+                                  0));
+    return true;
+}
+
+uint64_t VulkanCommandBuffer::gpuTimerResultNs() {
+    SkASSERT(fTimestampQueryPool != VK_NULL_HANDLE);
+    uint64_t timestamps[2];
+    VkResult result;
+    VULKAN_CALL_RESULT_NOCHECK(fSharedContext->interface(),
+                               result,
+                               GetQueryPoolResults(fSharedContext->device(),
+                                                   fTimestampQueryPool,
+                                                   /*firstQuery=*/0,
+                                                   /*queryCount=*/2,
+                                                   sizeof(timestamps),
+                                                   timestamps,
+                                                   sizeof(uint64_t),
+                                                   VK_QUERY_RESULT_64_BIT));
+    if (result != VK_SUCCESS || timestamps[1] < timestamps[0]) {
+        return 0;
+    }
+    const double timestampPeriod = fSharedContext->vulkanCaps().timestampPeriod();
+    return static_cast<uint64_t>((timestamps[1] - timestamps[0]) * timestampPeriod);
+}
+
 bool VulkanCommandBuffer::setNewCommandBufferResources() {
     this->begin();
     return true;
@@ -159,6 +216,14 @@ void VulkanCommandBuffer::end() {
 
     this->submitPipelineBarriers();
 
+    if (this->isGpuTimerStarted()) {
+        VULKAN_CALL(fSharedContext->interface(),
+                    CmdWriteTimestamp(fPrimaryCommandBuffer,
+                                      VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                                      fTimestampQueryPool,
+                                      1));
+    }
+
     VULKAN_CALL_ERRCHECK(fSharedContext, EndCommandBuffer(fPrimaryCommandBuffer));
 
     fActive = false;
@@ -814,7 +879,7 @@ void VulkanCommandBuffer::addDrawPass(const DrawPass* drawPass) {
             }
             case DrawPassCommands::Type::kBindUniformBuffer: {
                 auto bub = static_cast<DrawPassCommands::BindUniformBuffer*>(cmdPtr);
-                this->recordBufferBindingInfo(bub->fInfo, bub->fSlot);
+                this->recordBufferBindingInfo(this->remapUniformBuffer(bub->fInfo), bub->fSlot);
                 break;
             }
             case DrawPassCommands::Type::kBindDrawBuffers: {
@@ -1053,30 +1118,11 @@ void VulkanCommandBuffer::recordTextureAndSamplerDescSet(
         fBindTextureSamplers = false;
         return;
     }
-    // Query resource provider to obtain a descriptor set for the texture/samplers
-    TArray<DescriptorData> descriptors(command.fNumTexSamplers);
-    for (int i = 0; i < command.fNumTexSamplers; i++) {
-        descriptors.push_back({DescriptorType::kCombinedTextureSampler,
-                               /*count=*/1,
-                               /*bindingIdx=*/i,
-                               PipelineStageFlags::kFragmentShader});
-    }
-    sk_sp<VulkanDescriptorSet> set = fResourceProvider->findOrCreateDescriptorSet(
-            SkSpan<DescriptorData>{&descriptors.front(), descriptors.size()});
-
-    if (!set) {
-        SKGPU_LOG_E("Unable to find or create descriptor set");
-        fNumTextureSamplers = 0;
-        fTextureSamplerDescSetToBind = VK_NULL_HANDLE;
-        fBindTextureSamplers = false;
-        return;
-    }
-    // Populate the descriptor set with texture/sampler descriptors
-    TArray<VkWriteDescriptorSet> writeDescriptorSets(command.fNumTexSamplers);
-    TArray<VkDescriptorImageInfo> descriptorImageInfos(command.fNumTexSamplers);
+    TArray<const VulkanTexture*> textures(command.fNumTexSamplers);
+    TArray<const VulkanSampler*> samplers(command.fNumTexSamplers);
     for (int i = 0; i < command.fNumTexSamplers; ++i) {
-        auto texture = const_cast<VulkanTexture*>(static_cast<const VulkanTexture*>(
-                drawPass.getTexture(command.fTextureIndices[i])));
+        auto texture = static_cast<const VulkanTexture*>(
+                drawPass.getTexture(command.fTextureIndices[i]));
         auto sampler = static_cast<const VulkanSampler*>(
                 drawPass.getSampler(command.fSamplerIndices[i]));
         if (!texture || !sampler) {
@@ -1088,33 +1134,21 @@ void VulkanCommandBuffer::recordTextureAndSamplerDescSet(
             fBindTextureSamplers = false;
             return;
         }
+        textures.push_back(texture);
+        samplers.push_back(sampler);
+    }
 
-        VkDescriptorImageInfo& textureInfo = descriptorImageInfos.push_back();
-        memset(&textureInfo, 0, sizeof(VkDescriptorImageInfo));
-        textureInfo.sampler = sampler->vkSampler();
-        textureInfo.imageView =
-                texture->getImageView(VulkanImageView::Usage::kShaderInput)->imageView();
-        textureInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-
-        VkWriteDescriptorSet& writeInfo = writeDescriptorSets.push_back();
-        memset(&writeInfo, 0, sizeof(VkWriteDescriptorSet));
-        writeInfo.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        writeInfo.pNext = nullptr;
-        writeInfo.dstSet = *set->descriptorSet();
-        writeInfo.dstBinding = i;
-        writeInfo.dstArrayElement = 0;
-        writeInfo.descriptorCount = 1;
-        writeInfo.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-        writeInfo.pImageInfo = &textureInfo;
-        writeInfo.pBufferInfo = nullptr;
-        writeInfo.pTexelBufferView = nullptr;
-    }
-
-    VULKAN_CALL(fSharedContext->interface(), UpdateDescriptorSets(fSharedContext->device(),
-                                                                  command.fNumTexSamplers,
-                                                                  &writeDescriptorSets[0],
-                                                                  /*descriptorCopyCount=*/0,
-                                                                  /*pDescriptorCopies=*/nullptr));
+    // Query resource provider to obtain a descriptor set for the texture/samplers. Draws that go
+    // back to textures they bound before get the set that was written for them then.
+    sk_sp<VulkanDescriptorSet> set = fResourceProvider->findOrCreateTextureSamplerDescriptorSet(
+            textures, samplers);
+    if (!set) {
+        SKGPU_LOG_E("Unable to find or create descriptor set");
+        fNumTextureSamplers = 0;
+        fTextureSamplerDescSetToBind = VK_NULL_HANDLE;
+        fBindTextureSamplers = false;
+        return;
+    }
 
     // Store the updated descriptor set to be actually bound later on. This avoids binding and
     // potentially having to re-bind in cases where earlier descriptor sets change while going
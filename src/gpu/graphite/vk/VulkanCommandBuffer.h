@@ -58,6 +58,10 @@ private:
 
     void onResetCommandBuffer() override;
 
+    // Writes a timestamp now and another one when the command buffer ends.
+    bool onStartGpuTimer() override;
+    uint64_t gpuTimerResultNs() override;
+
     void begin();
     void end();
 
@@ -189,6 +193,9 @@ private:
 
     VkFence fSubmitFence = VK_NULL_HANDLE;
 
+    // Holds the start and end timestamps of the GPU timer, made the first time it is started.
+    VkQueryPool fTimestampQueryPool = VK_NULL_HANDLE;
+
     // Current semaphores
     skia_private::STArray<1, VkSemaphore> fWaitSemaphores;
     skia_private::STArray<1, VkSemaphore> fSignalSemaphores;
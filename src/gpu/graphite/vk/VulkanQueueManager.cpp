@@ -47,17 +47,17 @@ private:
     }
 };
 
-QueueManager::OutstandingSubmission VulkanQueueManager::onSubmitToGpu() {
-    SkASSERT(fCurrentCommandBuffer);
-    VulkanCommandBuffer* vkCmdBuffer =
-            static_cast<VulkanCommandBuffer*>(fCurrentCommandBuffer.get());
+QueueManager::OutstandingSubmission VulkanQueueManager::onSubmitToGpu(
+        std::unique_ptr<CommandBuffer> commandBuffer) {
+    SkASSERT(commandBuffer);
+    VulkanCommandBuffer* vkCmdBuffer = static_cast<VulkanCommandBuffer*>(commandBuffer.get());
     if (!vkCmdBuffer->submit(fQueue)) {
-        fCurrentCommandBuffer->callFinishedProcs(/*success=*/false);
+        commandBuffer->callFinishedProcs(/*success=*/false);
         return nullptr;
     }
 
     std::unique_ptr<GpuWorkSubmission> submission(
-            new VulkanWorkSubmission(std::move(fCurrentCommandBuffer), this));
+            new VulkanWorkSubmission(std::move(commandBuffer), this));
     return submission;
 }
 
@@ -25,7 +25,7 @@ private:
     const VulkanSharedContext* vkSharedContext() const;
 
     std::unique_ptr<CommandBuffer> getNewCommandBuffer(ResourceProvider*) override;
-    OutstandingSubmission onSubmitToGpu() override;
+    OutstandingSubmission onSubmitToGpu(std::unique_ptr<CommandBuffer>) override;
 
 #if defined(GRAPHITE_TEST_UTILS)
     // TODO: Implement these
@@ -12,6 +12,7 @@
 #include "include/gpu/graphite/BackendTexture.h"
 #include "include/gpu/graphite/vk/VulkanGraphiteTypes.h"
 #include "include/gpu/vk/VulkanMutableTextureState.h"
+#include "include/private/base/SkTo.h"
 #include "src/gpu/graphite/Buffer.h"
 #include "src/gpu/graphite/ComputePipeline.h"
 #include "src/gpu/graphite/GraphicsPipeline.h"
@@ -40,6 +41,7 @@
 namespace skgpu::graphite {
 
 constexpr int kMaxNumberOfCachedBufferDescSets = 1024;
+constexpr int kMaxNumberOfCachedTextureDescSets = 1024;
 
 VulkanResourceProvider::VulkanResourceProvider(SharedContext* sharedContext,
                                                SingleOwner* singleOwner,
@@ -50,15 +52,10 @@ VulkanResourceProvider::VulkanResourceProvider(SharedContext* sharedContext,
         : ResourceProvider(sharedContext, singleOwner, recorderID, resourceBudget)
         , fIntrinsicUniformBuffer(std::move(intrinsicConstantUniformBuffer))
         , fLoadMSAAVertexBuffer(std::move(loadMSAAVertexBuffer))
-        , fUniformBufferDescSetCache(kMaxNumberOfCachedBufferDescSets) {}
+        , fUniformBufferDescSetCache(kMaxNumberOfCachedBufferDescSets)
+        , fTextureSamplerDescSetCache(kMaxNumberOfCachedTextureDescSets) {}
 
 VulkanResourceProvider::~VulkanResourceProvider() {
-    if (fPipelineCache != VK_NULL_HANDLE) {
-        VULKAN_CALL(this->vulkanSharedContext()->interface(),
-                    DestroyPipelineCache(this->vulkanSharedContext()->device(),
-                                         fPipelineCache,
-                                         nullptr));
-    }
     if (fMSAALoadVertShaderModule != VK_NULL_HANDLE) {
         VULKAN_CALL(this->vulkanSharedContext()->interface(),
                     DestroyShaderModule(this->vulkanSharedContext()->device(),
@@ -406,6 +403,76 @@ sk_sp<VulkanDescriptorSet> VulkanResourceProvider::findOrCreateUniformBuffersDes
     return *fUniformBufferDescSetCache.insert(key, newDS);
 }
 
+sk_sp<VulkanDescriptorSet> VulkanResourceProvider::findOrCreateTextureSamplerDescriptorSet(
+        SkSpan<const VulkanTexture*> textures,
+        SkSpan<const VulkanSampler*> samplers) {
+    SkASSERT(!textures.empty() && textures.size() == samplers.size());
+    const int numTexSamplers = SkToInt(textures.size());
+
+    // Resource IDs are never reused, so a set cached for textures or samplers that have since been
+    // destroyed is never found again and just ages out of the cache.
+    static const UniqueKey::Domain kTextureBindGroupDomain = UniqueKey::GenerateDomain();
+    UniqueKey key;
+    {
+        UniqueKey::Builder builder(
+                &key, kTextureBindGroupDomain, 2 * numTexSamplers, "TextureSamplerDescSet");
+        for (int i = 0; i < numTexSamplers; ++i) {
+            builder[2 * i] = textures[i]->uniqueID().asUInt();
+            builder[2 * i + 1] = samplers[i]->uniqueID().asUInt();
+        }
+        builder.finish();
+    }
+    if (auto* existingDescSet = fTextureSamplerDescSetCache.find(key)) {
+        return *existingDescSet;
+    }
+
+    skia_private::TArray<DescriptorData> descriptors(numTexSamplers);
+    for (int i = 0; i < numTexSamplers; i++) {
+        descriptors.push_back({DescriptorType::kCombinedTextureSampler,
+                               /*count=*/1,
+                               /*bindingIdx=*/i,
+                               PipelineStageFlags::kFragmentShader});
+    }
+    sk_sp<VulkanDescriptorSet> set = this->findOrCreateDescriptorSet(
+            SkSpan<DescriptorData>{&descriptors.front(), descriptors.size()});
+    if (!set) {
+        return nullptr;
+    }
+
+    // Populate the descriptor set with texture/sampler descriptors
+    skia_private::TArray<VkWriteDescriptorSet> writeDescriptorSets(numTexSamplers);
+    skia_private::TArray<VkDescriptorImageInfo> descriptorImageInfos(numTexSamplers);
+    for (int i = 0; i < numTexSamplers; ++i) {
+        VkDescriptorImageInfo& textureInfo = descriptorImageInfos.push_back();
+        memset(&textureInfo, 0, sizeof(VkDescriptorImageInfo));
+        textureInfo.sampler = samplers[i]->vkSampler();
+        textureInfo.imageView =
+                textures[i]->getImageView(VulkanImageView::Usage::kShaderInput)->imageView();
+        textureInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+        VkWriteDescriptorSet& writeInfo = writeDescriptorSets.push_back();
+        memset(&writeInfo, 0, sizeof(VkWriteDescriptorSet));
+        writeInfo.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        writeInfo.pNext = nullptr;
+        writeInfo.dstSet = *set->descriptorSet();
+        writeInfo.dstBinding = i;
+        writeInfo.dstArrayElement = 0;
+        writeInfo.descriptorCount = 1;
+        writeInfo.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        writeInfo.pImageInfo = &textureInfo;
+        writeInfo.pBufferInfo = nullptr;
+        writeInfo.pTexelBufferView = nullptr;
+    }
+
+    const VulkanSharedContext* sharedContext = this->vulkanSharedContext();
+    VULKAN_CALL(sharedContext->interface(), UpdateDescriptorSets(sharedContext->device(),
+                                                                 numTexSamplers,
+                                                                 &writeDescriptorSets[0],
+                                                                 /*descriptorCopyCount=*/0,
+                                                                 /*pDescriptorCopies=*/nullptr));
+    return *fTextureSamplerDescSetCache.insert(key, std::move(set));
+}
+
 
 sk_sp<VulkanRenderPass> VulkanResourceProvider::findOrCreateRenderPassWithKnownKey(
             const RenderPassDesc& renderPassDesc,
@@ -438,26 +505,7 @@ sk_sp<VulkanRenderPass> VulkanResourceProvider::findOrCreateRenderPass(
 }
 
 VkPipelineCache VulkanResourceProvider::pipelineCache() {
-    if (fPipelineCache == VK_NULL_HANDLE) {
-        VkPipelineCacheCreateInfo createInfo;
-        memset(&createInfo, 0, sizeof(VkPipelineCacheCreateInfo));
-        createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
-        createInfo.pNext = nullptr;
-        createInfo.flags = 0;
-        createInfo.initialDataSize = 0;
-        createInfo.pInitialData = nullptr;
-        VkResult result;
-        VULKAN_CALL_RESULT(this->vulkanSharedContext(),
-                           result,
-                           CreatePipelineCache(this->vulkanSharedContext()->device(),
-                                               &createInfo,
-                                               nullptr,
-                                               &fPipelineCache));
-        if (VK_SUCCESS != result) {
-            fPipelineCache = VK_NULL_HANDLE;
-        }
-    }
-    return fPipelineCache;
+    return this->vulkanSharedContext()->pipelineCache();
 }
 
 sk_sp<VulkanFramebuffer> VulkanResourceProvider::createFramebuffer(
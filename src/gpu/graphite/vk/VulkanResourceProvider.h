@@ -28,7 +28,9 @@ class VulkanDescriptorSet;
 class VulkanFramebuffer;
 class VulkanGraphicsPipeline;
 class VulkanRenderPass;
+class VulkanSampler;
 class VulkanSharedContext;
+class VulkanTexture;
 class VulkanYcbcrConversion;
 
 class VulkanResourceProvider final : public ResourceProvider {
@@ -52,6 +54,10 @@ public:
     sk_sp<VulkanYcbcrConversion> findOrCreateCompatibleYcbcrConversion(
             const VulkanYcbcrConversionInfo& ycbcrInfo) const;
 
+#if defined(GRAPHITE_TEST_UTILS)
+    int numCachedTextureSamplerDescSets() const { return fTextureSamplerDescSetCache.count(); }
+#endif
+
 private:
     const VulkanSharedContext* vulkanSharedContext() const;
 
@@ -90,6 +96,13 @@ private:
             SkSpan<DescriptorData> requestedDescriptors,
             SkSpan<BindUniformBufferInfo> bindUniformBufferInfo);
 
+    // Returns a descriptor set that binds each texture with its sampler to consecutive combined
+    // texture-sampler bindings. Sets are cached by the IDs of the textures and samplers, so that
+    // returning to a binding that was used before doesn't allocate and write a new set each time.
+    sk_sp<VulkanDescriptorSet> findOrCreateTextureSamplerDescriptorSet(
+            SkSpan<const VulkanTexture*> textures,
+            SkSpan<const VulkanSampler*> samplers);
+
     sk_sp<VulkanGraphicsPipeline> findOrCreateLoadMSAAPipeline(const RenderPassDesc&);
 
     // Find or create a compatible (needed when creating a framebuffer and graphics pipeline) or
@@ -103,7 +116,6 @@ private:
     VkPipelineCache pipelineCache();
 
     friend class VulkanCommandBuffer;
-    VkPipelineCache fPipelineCache = VK_NULL_HANDLE;
 
     // Each render pass will need buffer space to record rtAdjust information. To minimize costly
     // allocation calls and searching of the resource cache, we find & store a uniform buffer upon
@@ -130,6 +142,7 @@ private:
     };
     using DescriptorSetCache = SkLRUCache<UniqueKey, sk_sp<VulkanDescriptorSet>, UniqueKeyHash>;
     DescriptorSetCache fUniformBufferDescSetCache;
+    DescriptorSetCache fTextureSamplerDescSetCache;
 };
 
 } // namespace skgpu::graphite
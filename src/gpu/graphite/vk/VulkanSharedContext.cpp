@@ -7,13 +7,16 @@
 
 #include "src/gpu/graphite/vk/VulkanSharedContext.h"
 
+#include "include/core/SkData.h"
 #include "include/gpu/graphite/ContextOptions.h"
+#include "include/gpu/graphite/PersistentPipelineStorage.h"
 #include "include/gpu/vk/VulkanBackendContext.h"
 #include "include/private/base/SkMutex.h"
 #include "src/gpu/graphite/Log.h"
 #include "src/gpu/graphite/ResourceTypes.h"
 #include "src/gpu/graphite/vk/VulkanBuffer.h"
 #include "src/gpu/graphite/vk/VulkanCaps.h"
+#include "src/gpu/graphite/vk/VulkanGraphiteUtilsPriv.h"
 #include "src/gpu/graphite/vk/VulkanResourceProvider.h"
 #include "src/gpu/vk/VulkanInterface.h"
 #include "src/gpu/vk/VulkanUtilsPriv.h"
@@ -22,8 +25,31 @@
 #include "src/gpu/vk/VulkanAMDMemoryAllocator.h"
 #endif
 
+#include <cstring>
+
 namespace skgpu::graphite {
 
+namespace {
+
+// VkPipelineCache data is only usable by the driver that produced it. The driver validates the
+// header of any initial data itself, but keying on the same fields lets a single storage hold
+// data for several devices without them overwriting each other.
+sk_sp<SkData> make_pipeline_storage_key(const VkPhysicalDeviceProperties& props) {
+    static constexpr char kTag[] = "skgpu::graphite::Vulkan";
+    const uint32_t ids[] = {props.vendorID, props.deviceID, props.driverVersion};
+
+    sk_sp<SkData> key = SkData::MakeUninitialized(sizeof(kTag) + sizeof(ids) + VK_UUID_SIZE);
+    char* ptr = static_cast<char*>(key->writable_data());
+    memcpy(ptr, kTag, sizeof(kTag));
+    ptr += sizeof(kTag);
+    memcpy(ptr, ids, sizeof(ids));
+    ptr += sizeof(ids);
+    memcpy(ptr, props.pipelineCacheUUID, VK_UUID_SIZE);
+    return key;
+}
+
+}  // anonymous namespace
+
 sk_sp<SharedContext> VulkanSharedContext::Make(const VulkanBackendContext& context,
                                                const ContextOptions& options) {
     if (context.fInstance == VK_NULL_HANDLE ||
@@ -127,27 +153,103 @@ sk_sp<SharedContext> VulkanSharedContext::Make(const VulkanBackendContext& conte
         return nullptr;
     }
 
+    sk_sp<SkData> pipelineStorageKey;
+    if (options.fPersistentPipelineStorage) {
+        pipelineStorageKey = make_pipeline_storage_key(physDeviceProperties);
+    }
+
     return sk_sp<SharedContext>(new VulkanSharedContext(context,
                                                         std::move(interface),
                                                         std::move(memoryAllocator),
-                                                        std::move(caps)));
+                                                        std::move(caps),
+                                                        options.fPersistentPipelineStorage,
+                                                        std::move(pipelineStorageKey)));
 }
 
 VulkanSharedContext::VulkanSharedContext(const VulkanBackendContext& backendContext,
                                          sk_sp<const skgpu::VulkanInterface> interface,
                                          sk_sp<skgpu::VulkanMemoryAllocator> memoryAllocator,
-                                         std::unique_ptr<const VulkanCaps> caps)
+                                         std::unique_ptr<const VulkanCaps> caps,
+                                         PersistentPipelineStorage* pipelineStorage,
+                                         sk_sp<SkData> pipelineStorageKey)
         : skgpu::graphite::SharedContext(std::move(caps), BackendApi::kVulkan)
         , fInterface(std::move(interface))
         , fMemoryAllocator(std::move(memoryAllocator))
         , fDevice(std::move(backendContext.fDevice))
         , fQueueIndex(backendContext.fGraphicsQueueIndex)
         , fDeviceLostContext(backendContext.fDeviceLostContext)
-        , fDeviceLostProc(backendContext.fDeviceLostProc) {}
+        , fDeviceLostProc(backendContext.fDeviceLostProc)
+        , fPipelineStorage(pipelineStorage)
+        , fPipelineStorageKey(std::move(pipelineStorageKey)) {}
 
 VulkanSharedContext::~VulkanSharedContext() {
+    this->destroyPipelineCompiler();
     // need to clear out resources before the allocator is removed
     this->globalCache()->deleteResources();
+
+    SkAutoMutexExclusive lock(fPipelineCacheMutex);
+    if (fPipelineCache != VK_NULL_HANDLE) {
+        VULKAN_CALL(this->interface(), DestroyPipelineCache(fDevice, fPipelineCache, nullptr));
+    }
+}
+
+VkPipelineCache VulkanSharedContext::pipelineCache() const {
+    SkAutoMutexExclusive lock(fPipelineCacheMutex);
+    if (fPipelineCache == VK_NULL_HANDLE) {
+        sk_sp<SkData> initialData;
+        if (fPipelineStorage) {
+            initialData = fPipelineStorage->load(*fPipelineStorageKey);
+        }
+
+        VkPipelineCacheCreateInfo createInfo;
+        memset(&createInfo, 0, sizeof(VkPipelineCacheCreateInfo));
+        createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+        createInfo.pNext = nullptr;
+        createInfo.flags = 0;
+        createInfo.initialDataSize = initialData ? initialData->size() : 0;
+        createInfo.pInitialData = initialData ? initialData->data() : nullptr;
+        VkResult result;
+        VULKAN_CALL_RESULT(this, result, CreatePipelineCache(fDevice,
+                                                             &createInfo,
+                                                             nullptr,
+                                                             &fPipelineCache));
+        if (VK_SUCCESS != result) {
+            fPipelineCache = VK_NULL_HANDLE;
+        }
+    }
+    return fPipelineCache;
+}
+
+void VulkanSharedContext::syncPipelineData(size_t maxSize) {
+    if (!fPipelineStorage) {
+        return;
+    }
+
+    SkAutoMutexExclusive lock(fPipelineCacheMutex);
+    if (fPipelineCache == VK_NULL_HANDLE) {
+        // Nothing has been compiled since the Context was created.
+        return;
+    }
+
+    size_t dataSize = 0;
+    VkResult result;
+    VULKAN_CALL_RESULT(this, result, GetPipelineCacheData(fDevice,
+                                                          fPipelineCache,
+                                                          &dataSize,
+                                                          nullptr));
+    if (result != VK_SUCCESS || dataSize == 0 || dataSize > maxSize) {
+        return;
+    }
+
+    sk_sp<SkData> data = SkData::MakeUninitialized(dataSize);
+    VULKAN_CALL_RESULT(this, result, GetPipelineCacheData(fDevice,
+                                                          fPipelineCache,
+                                                          &dataSize,
+                                                          data->writable_data()));
+    if (result != VK_SUCCESS) {
+        return;
+    }
+    fPipelineStorage->store(*fPipelineStorageKey, *data);
 }
 
 std::unique_ptr<ResourceProvider> VulkanSharedContext::makeResourceProvider(
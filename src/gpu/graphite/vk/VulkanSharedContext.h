@@ -8,6 +8,8 @@
 #ifndef skgpu_graphite_VulkanSharedContext_DEFINED
 #define skgpu_graphite_VulkanSharedContext_DEFINED
 
+#include "include/core/SkData.h"
+#include "include/core/SkRefCnt.h"
 #include "include/private/base/SkMutex.h"
 #include "src/gpu/graphite/SharedContext.h"
 
@@ -23,6 +25,7 @@ class VulkanMemoryAllocator;
 namespace skgpu::graphite {
 
 struct ContextOptions;
+class PersistentPipelineStorage;
 class VulkanCaps;
 
 class VulkanSharedContext final : public SharedContext {
@@ -50,11 +53,19 @@ public:
         return fDeviceIsLost;
     }
 
+    // The VkPipelineCache shared by all ResourceProviders. It is created on first use and, if the
+    // client provided a PersistentPipelineStorage, seeded with the data stored for this driver.
+    VkPipelineCache pipelineCache() const;
+
+    void syncPipelineData(size_t maxSize) override;
+
 private:
     VulkanSharedContext(const VulkanBackendContext&,
                         sk_sp<const skgpu::VulkanInterface> interface,
                         sk_sp<skgpu::VulkanMemoryAllocator> memoryAllocator,
-                        std::unique_ptr<const VulkanCaps> caps);
+                        std::unique_ptr<const VulkanCaps> caps,
+                        PersistentPipelineStorage*,
+                        sk_sp<SkData> pipelineStorageKey);
 
     sk_sp<const skgpu::VulkanInterface> fInterface;
     sk_sp<skgpu::VulkanMemoryAllocator> fMemoryAllocator;
@@ -67,6 +78,13 @@ private:
     mutable bool fDeviceIsLost SK_GUARDED_BY(fDeviceIsLostMutex) = false;
     skgpu::VulkanDeviceLostContext fDeviceLostContext;
     skgpu::VulkanDeviceLostProc fDeviceLostProc;
+
+    PersistentPipelineStorage* const fPipelineStorage;
+    // Identifies the driver that produced a pipeline cache's data; see make_pipeline_storage_key().
+    const sk_sp<SkData> fPipelineStorageKey;
+
+    mutable SkMutex fPipelineCacheMutex;
+    mutable VkPipelineCache fPipelineCache SK_GUARDED_BY(fPipelineCacheMutex) = VK_NULL_HANDLE;
 };
 
 } // namespace skgpu::graphite
@@ -393,7 +393,13 @@ public:
 
     // Write a cubic curve with its four control points.
     AI void writeCubic(float2 p0, float2 p1, float2 p2, float2 p3) {
-        float n4 = wangs_formula::cubic_p4(kPrecision, p0, p1, p2, p3, fApproxTransform);
+        this->writeCubic(p0, p1, p2, p3,
+                         wangs_formula::cubic_p4(kPrecision, p0, p1, p2, p3, fApproxTransform));
+    }
+    // Write a cubic whose Wang's formula was already evaluated, raised to the 4th power, with
+    // kPrecision and the shader transform (e.g. for a batch of cubics by the SoA overload of
+    // wangs_formula::cubic_p4).
+    AI void writeCubic(float2 p0, float2 p1, float2 p2, float2 p3, float n4) {
         if constexpr (kDiscardFlatCurves) {
             if (n4 <= 1.f) {
                 // This cubic only needs one segment (e.g. a line) but we're not filling space with
@@ -15,6 +15,7 @@
 #include "src/base/SkFloatBits.h"
 #include "src/base/SkUtils.h"
 #include "src/base/SkVx.h"
+#include "src/core/SkCurveBatch.h"
 
 #include <math.h>
 #include <algorithm>
@@ -120,6 +121,11 @@ public:
         fC1 = {m.rc(0,1), m.rc(1,1)};
         return *this;
     }
+    // Writes the columns of the matrix, as expected by the batched SkOpts kernels.
+    AI void getColumns(float m[4]) const {
+        fC0.store(m);
+        fC1.store(m + 2);
+    }
     AI skvx::float2 operator()(skvx::float2 vector) const {
         return fC0 * vector.x() + fC1 * vector.y();
     }
@@ -152,6 +158,16 @@ AI float quadratic_p4(float precision,
                         vectorXform);
 }
 
+// Evaluates quadratic_p4() for 'count' quadratics in SoA layout: (x[k][i], y[k][i]) is control
+// point k of quadratic i.
+AI void quadratic_p4(float precision,
+                     const float* const x[3], const float* const y[3], int count, float n4[],
+                     const VectorXform& vectorXform = VectorXform()) {
+    float m[4];
+    vectorXform.getColumns(m);
+    SkOpts::quadratic_wangs_formula_p4(length_term_p2<2>(precision), m, x, y, count, n4);
+}
+
 // Returns Wang's formula specialized for a quadratic curve.
 AI float quadratic(float precision,
                    const SkPoint pts[],
@@ -191,6 +207,16 @@ AI float cubic_p4(float precision,
                     vectorXform);
 }
 
+// Evaluates cubic_p4() for 'count' cubics in SoA layout: (x[k][i], y[k][i]) is control point k
+// of cubic i.
+AI void cubic_p4(float precision,
+                 const float* const x[4], const float* const y[4], int count, float n4[],
+                 const VectorXform& vectorXform = VectorXform()) {
+    float m[4];
+    vectorXform.getColumns(m);
+    SkOpts::cubic_wangs_formula_p4(length_term_p2<3>(precision), m, x, y, count, n4);
+}
+
 // Returns Wang's formula specialized for a cubic curve.
 AI float cubic(float precision,
                const SkPoint pts[],
@@ -293,6 +293,10 @@ bool SkImage::hasMipmaps() const { return as_IB(this)->onHasMipmaps(); }
 
 bool SkImage::isProtected() const { return as_IB(this)->onIsProtected(); }
 
+void SkImage::prefetchDecode(SkExecutor* executor) const {
+    as_IB(this)->onPrefetchDecode(executor);
+}
+
 sk_sp<SkImage> SkImage::withMipmaps(sk_sp<SkMipmap> mips) const {
     if (mips == nullptr || mips->validForRootLevel(this->imageInfo())) {
         if (auto result = as_IB(this)->onMakeWithMipmaps(std::move(mips))) {
@@ -22,6 +22,7 @@ class GrDirectContext;
 class GrImageContext;
 class SkBitmap;
 class SkColorSpace;
+class SkExecutor;
 class SkPixmap;
 enum SkColorType : int;
 enum SkYUVColorSpace : int;
@@ -127,6 +128,10 @@ public:
 
     virtual sk_sp<SkData> onRefEncoded() const { return nullptr; }
 
+    // Images whose pixels are generated on demand decode them into the raster cache on
+    // |executor|. Other images have nothing to prefetch.
+    virtual void onPrefetchDecode(SkExecutor*) const {}
+
     virtual bool onAsLegacyBitmap(GrDirectContext*, SkBitmap*) const;
 
     enum class Type {
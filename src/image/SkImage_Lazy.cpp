@@ -10,6 +10,7 @@
 #include "include/core/SkBitmap.h"
 #include "include/core/SkColorSpace.h"
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImageGenerator.h"
 #include "include/core/SkPixmap.h"
 #include "include/core/SkSize.h"
@@ -120,18 +121,33 @@ bool SkImage_Lazy::getROPixels(GrDirectContext* ctx, SkBitmap* bitmap,
 
     if (SkImage::kAllow_CachingHint == chint) {
         SkPixmap pmap;
-        SkBitmapCache::RecPtr cacheRec = SkBitmapCache::Alloc(desc, this->imageInfo(), &pmap);
-        if (!cacheRec) {
-            return false;
-        }
+        SkBitmapCache::RecPtr cacheRec;
         bool success = false;
         {   // make sure ScopedGenerator goes out of scope before we try readPixelsProxy
-            success = ScopedGenerator(fSharedGenerator)->getPixels(pmap);
+            ScopedGenerator generator(fSharedGenerator);
+            // Decodes from one generator are serialized by its mutex, so threads that missed the
+            // cache at the same time wait here for the first one. Looking again once we hold the
+            // mutex lets them share that decode instead of each repeating it.
+            if (SkBitmapCache::Find(desc, bitmap)) {
+                check_output_bitmap();
+                return true;
+            }
+            cacheRec = SkBitmapCache::Alloc(desc, this->imageInfo(), &pmap);
+            if (!cacheRec) {
+                return false;
+            }
+            success = generator->getPixels(pmap);
+            if (success) {
+                // Publish the pixels before the next waiter takes the mutex.
+                SkBitmapCache::Add(std::move(cacheRec), bitmap);
+            }
         }
-        if (!success && !this->readPixelsProxy(ctx, pmap)) {
-            return false;
+        if (!success) {
+            if (!this->readPixelsProxy(ctx, pmap)) {
+                return false;
+            }
+            SkBitmapCache::Add(std::move(cacheRec), bitmap);
         }
-        SkBitmapCache::Add(std::move(cacheRec), bitmap);
         this->notifyAddedToRasterCache();
     } else {
         if (!bitmap->tryAllocPixels(this->imageInfo())) {
@@ -154,6 +170,14 @@ sk_sp<SharedGenerator> SkImage_Lazy::generator() const {
     return fSharedGenerator;
 }
 
+void SkImage_Lazy::onPrefetchDecode(SkExecutor* executor) const {
+    SkExecutor& exec = executor ? *executor : SkExecutor::GetDefault();
+    exec.add([image = sk_ref_sp(this)] {
+        SkBitmap bitmap;
+        image->getROPixels(nullptr, &bitmap, SkImage::kAllow_CachingHint);
+    });
+}
+
 bool SkImage_Lazy::onIsProtected() const {
     ScopedGenerator generator(fSharedGenerator);
     return generator->isProtected();
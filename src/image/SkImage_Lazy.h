@@ -29,6 +29,7 @@ class SharedGenerator;
 class SkBitmap;
 class SkCachedData;
 class SkData;
+class SkExecutor;
 class SkPixmap;
 enum SkColorType : int;
 struct SkIRect;
@@ -60,6 +61,7 @@ public:
         return false;
     }
     bool onIsProtected() const override;
+    void onPrefetchDecode(SkExecutor*) const override;
 
     bool onReadPixels(GrDirectContext*, const SkImageInfo&, void*, size_t, int srcX, int srcY,
                       CachingHint) const override;
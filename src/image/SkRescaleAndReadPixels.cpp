@@ -19,11 +19,220 @@
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkSamplingOptions.h"
 #include "include/core/SkSurface.h"
+#include "include/private/base/SkTemplates.h"
+#include "include/private/base/SkTo.h"
+#include "src/base/SkVx.h"
+#include "src/core/SkImageInfoPriv.h"
+#include "src/core/SkTaskGroup.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <cstddef>
 #include <memory>
 #include <utility>
+#include <vector>
+
+namespace {
+
+class Result : public SkImage::AsyncReadResult {
+public:
+    Result(std::unique_ptr<const char[]> data, size_t rowBytes)
+            : fData(std::move(data)), fRowBytes(rowBytes) {}
+    int count() const override { return 1; }
+    const void* data(int i) const override { return fData.get(); }
+    size_t rowBytes(int i) const override { return fRowBytes; }
+
+private:
+    std::unique_ptr<const char[]> fData;
+    size_t fRowBytes;
+};
+
+// A filter kernel, as a function of the distance in pixels, and the radius past which it is 0.
+struct ResampleFilter {
+    float (*fEval)(float);
+    float fRadius;
+};
+
+float tent(float x) {
+    x = std::fabs(x);
+    return x < 1 ? 1 - x : 0;
+}
+
+// Mitchell-Netravali with B = C = 1/3, the cubic that kRepeatedCubic draws with.
+float mitchell(float x) {
+    static constexpr float B = 1.0f/3, C = 1.0f/3;
+    x = std::fabs(x);
+    if (x < 1) {
+        return ((12 - 9*B - 6*C)*x*x*x + (-18 + 12*B + 6*C)*x*x + (6 - 2*B)) / 6;
+    }
+    if (x < 2) {
+        return ((-B - 6*C)*x*x*x + (6*B + 30*C)*x*x + (-12*B - 48*C)*x + (8*B + 24*C)) / 6;
+    }
+    return 0;
+}
+
+// For each dst pixel along one axis, the contiguous run of src pixels it reads and their
+// normalized weights. When downscaling the filter is widened by the scale, so every src pixel
+// contributes, and taps past the edges are folded onto the edge pixels.
+class ResampleWeights {
+public:
+    ResampleWeights(int srcSize, int dstSize, const ResampleFilter& filter) {
+        const float scale = (float)dstSize / srcSize;
+        const float filterScale = std::max(1.f, 1 / scale);
+        const float support = filter.fRadius * filterScale;
+        fMaxCount = std::min(srcSize, (int)std::ceil(2 * support) + 1);
+        fStart.resize(dstSize);
+        fCount.resize(dstSize);
+        fWeights.assign(SkToSizeT(dstSize) * fMaxCount, 0.f);
+
+        for (int i = 0; i < dstSize; ++i) {
+            const float center = (i + 0.5f) / scale - 0.5f;
+            const int left = (int)std::ceil(center - support),
+                      right = (int)std::floor(center + support);
+            const int start = std::clamp(left, 0, srcSize - 1),
+                      end = std::clamp(right, 0, srcSize - 1);
+            fStart[i] = start;
+            fCount[i] = end - start + 1;
+            SkASSERT(fCount[i] <= fMaxCount);
+
+            float* w = fWeights.data() + SkToSizeT(i) * fMaxCount;
+            float sum = 0;
+            for (int k = left; k <= right; ++k) {
+                const float wk = filter.fEval((k - center) / filterScale);
+                w[std::clamp(k, 0, srcSize - 1) - start] += wk;
+                sum += wk;
+            }
+            if (sum != 0) {
+                for (int k = 0; k < fCount[i]; ++k) {
+                    w[k] /= sum;
+                }
+            } else {
+                w[std::clamp((int)std::round(center), start, end) - start] = 1;
+            }
+        }
+    }
+
+    int maxCount() const { return fMaxCount; }
+    int start(int i) const { return fStart[i]; }
+    int count(int i) const { return fCount[i]; }
+    const float* weights(int i) const { return fWeights.data() + SkToSizeT(i) * fMaxCount; }
+
+private:
+    int fMaxCount;
+    std::vector<int> fStart;
+    std::vector<int> fCount;
+    std::vector<float> fWeights;
+};
+
+// Both passes work on RGBA F32 pixels, one skvx::float4 each.
+void resample_row(float* dst, const float* src, const ResampleWeights& weights, int dstW) {
+    for (int x = 0; x < dstW; ++x) {
+        const float* w = weights.weights(x);
+        const float* s = src + 4 * weights.start(x);
+        skvx::float4 acc = 0;
+        for (int k = 0; k < weights.count(x); ++k) {
+            acc += w[k] * skvx::float4::Load(s + 4 * k);
+        }
+        acc.store(dst + 4 * x);
+    }
+}
+
+void resample_column(float* dst, const float* rows, size_t rowFloats,
+                     const float* w, int count, int width) {
+    for (int x = 0; x < 4 * width; x += 4) {
+        skvx::float4 acc = 0;
+        for (int k = 0; k < count; ++k) {
+            acc += w[k] * skvx::float4::Load(rows + k * rowFloats + x);
+        }
+        acc.store(dst + x);
+    }
+}
+
+// Rescales in a single pass of a separable filter, in the working color space. Each strip of dst
+// rows is filtered horizontally from just the src rows it needs, then vertically, so strips are
+// independent and run in parallel on the default executor.
+bool resample(const SkPixmap& src,
+              const SkIRect& srcRect,
+              sk_sp<SkColorSpace> workingCS,
+              const ResampleFilter& filter,
+              const SkPixmap& dst) {
+    // Strips read at least this many src rows, or four times the vertical filter's taps, so the
+    // rows filtered twice where strips overlap stay a small fraction.
+    static constexpr int kMinStripSrcRows = 128;
+    static constexpr int64_t kMinPixelsToSplit = 256 * 256;
+
+    const int srcW = srcRect.width(), srcH = srcRect.height();
+    const int dstW = dst.width(), dstH = dst.height();
+    const ResampleWeights xWeights(srcW, dstW, filter),
+                          yWeights(srcH, dstH, filter);
+
+    int stripRows = dstH;
+    if (SkToS64(dstW) * dstH >= kMinPixelsToSplit) {
+        const int stripSrcRows = std::max(kMinStripSrcRows, 4 * yWeights.maxCount());
+        stripRows = std::clamp((int)((int64_t)stripSrcRows * dstH / srcH), 1, dstH);
+    }
+    const int strips = (dstH + stripRows - 1) / stripRows;
+
+    const SkImageInfo srcRowInfo = SkImageInfo::Make(srcW, 1, kRGBA_F32_SkColorType,
+                                                     kPremul_SkAlphaType, workingCS);
+    const SkImageInfo dstRowInfo = srcRowInfo.makeWH(dstW, 1);
+    const bool clampToAlpha = SkColorTypeIsNormalized(dst.colorType());
+    const size_t dstRowFloats = 4 * SkToSizeT(dstW);
+
+    std::atomic<bool> failed{false};
+    auto resampleStrip = [&](int strip) {
+        const int top = strip * stripRows, bottom = std::min(dstH, top + stripRows);
+        // The starts and ends of the weights only move forward, so these bound every tap.
+        const int srcTop = yWeights.start(top),
+                  srcBottom = yWeights.start(bottom - 1) + yWeights.count(bottom - 1);
+
+        skia_private::AutoTMalloc<float> storage(4 * SkToSizeT(srcW) +
+                                                 dstRowFloats * (srcBottom - srcTop + 1));
+        float* srcRow = storage.get();
+        float* filtered = srcRow + 4 * SkToSizeT(srcW);
+        float* dstRow = filtered + dstRowFloats * (srcBottom - srcTop);
+
+        const SkPixmap srcRowPM(srcRowInfo, srcRow, srcRowInfo.minRowBytes());
+        for (int y = srcTop; y < srcBottom; ++y) {
+            if (!src.readPixels(srcRowPM, srcRect.fLeft, srcRect.fTop + y)) {
+                failed = true;
+                return;
+            }
+            resample_row(filtered + dstRowFloats * (y - srcTop), srcRow, xWeights, dstW);
+        }
+
+        const SkPixmap dstRowPM(dstRowInfo, dstRow, dstRowInfo.minRowBytes());
+        for (int y = top; y < bottom; ++y) {
+            resample_column(dstRow, filtered + dstRowFloats * (yWeights.start(y) - srcTop),
+                            dstRowFloats, yWeights.weights(y), yWeights.count(y), dstW);
+            if (clampToAlpha) {
+                // The cubic's negative lobes can overshoot, which an 8-bit result can't hold.
+                for (int x = 0; x < 4 * dstW; x += 4) {
+                    skvx::float4 px = skvx::float4::Load(dstRow + x);
+                    const float a = std::clamp(px[3], 0.f, 1.f);
+                    skvx::pin(px, skvx::float4(0), skvx::float4(a)).store(dstRow + x);
+                }
+            }
+            SkPixmap dstRowOut;
+            SkAssertResult(dst.extractSubset(&dstRowOut, SkIRect::MakeXYWH(0, y, dstW, 1)));
+            if (!dstRowPM.readPixels(dstRowOut)) {
+                failed = true;
+                return;
+            }
+        }
+    };
+
+    SkTaskGroup tasks;
+    for (int strip = 1; strip < strips; ++strip) {
+        tasks.add([&resampleStrip, strip] { resampleStrip(strip); });
+    }
+    resampleStrip(0);
+    tasks.wait();
+    return !failed;
+}
+
+}  // anonymous namespace
 
 void SkRescaleAndReadPixels(SkBitmap bmp,
                             const SkImageInfo& resultInfo,
@@ -32,6 +241,31 @@ void SkRescaleAndReadPixels(SkBitmap bmp,
                             SkImage::RescaleMode rescaleMode,
                             SkImage::ReadPixelsCallback callback,
                             SkImage::ReadPixelsContext context) {
+    if (rescaleMode == SkImage::RescaleMode::kRepeatedLinear ||
+        rescaleMode == SkImage::RescaleMode::kRepeatedCubic) {
+        // The repeated modes exist to avoid aliasing on the GPU, where filtering is limited to a
+        // few taps. On the CPU one pass of a filter scaled to the whole rescale does better and
+        // never allocates intermediate images.
+        sk_sp<SkColorSpace> workingCS = bmp.refColorSpace();
+        // As below, a linear rescale needs a color space to linearize from.
+        if (rescaleGamma == SkSurface::RescaleGamma::kLinear && workingCS &&
+            !workingCS->gammaIsLinear()) {
+            workingCS = workingCS->makeLinearGamma();
+        }
+        const ResampleFilter filter = rescaleMode == SkImage::RescaleMode::kRepeatedCubic
+                                              ? ResampleFilter{mitchell, 2}
+                                              : ResampleFilter{tent, 1};
+        size_t rowBytes = resultInfo.minRowBytes();
+        std::unique_ptr<char[]> data(new char[resultInfo.height() * rowBytes]);
+        SkPixmap pm(resultInfo, data.get(), rowBytes);
+        if (resample(bmp.pixmap(), srcRect, std::move(workingCS), filter, pm)) {
+            callback(context, std::make_unique<Result>(std::move(data), rowBytes));
+        } else {
+            callback(context, nullptr);
+        }
+        return;
+    }
+
     int srcW = srcRect.width();
     int srcH = srcRect.height();
 
@@ -147,18 +381,6 @@ void SkRescaleAndReadPixels(SkBitmap bmp,
     std::unique_ptr<char[]> data(new char[resultInfo.height() * rowBytes]);
     SkPixmap pm(resultInfo, data.get(), rowBytes);
     if (srcImage->readPixels(nullptr, pm, srcX, srcY)) {
-        class Result : public SkImage::AsyncReadResult {
-        public:
-            Result(std::unique_ptr<const char[]> data, size_t rowBytes)
-                    : fData(std::move(data)), fRowBytes(rowBytes) {}
-            int count() const override { return 1; }
-            const void* data(int i) const override { return fData.get(); }
-            size_t rowBytes(int i) const override { return fRowBytes; }
-
-        private:
-            std::unique_ptr<const char[]> fData;
-            size_t fRowBytes;
-        };
         callback(context, std::make_unique<Result>(std::move(data), rowBytes));
     } else {
         callback(context, nullptr);
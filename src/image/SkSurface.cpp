@@ -16,6 +16,7 @@
 #include "include/core/SkPixmap.h"
 #include "include/core/SkRect.h"
 #include "include/core/SkRefCnt.h"
+#include "include/core/SkRegion.h"
 #include "include/core/SkScalar.h"
 #include "include/core/SkSize.h"
 #include "include/core/SkSurfaceProps.h"
@@ -79,6 +80,14 @@ void SkSurface::notifyContentWillChange(ContentChangeMode mode) {
     sk_ignore_unused_variable(asSB(this)->aboutToDraw(mode));
 }
 
+SkRegion SkSurface::dirtyRegion() const {
+    return asConstSB(this)->fDirtyTiles.region();
+}
+
+void SkSurface::resetDirtyRegion() {
+    asSB(this)->fDirtyTiles.reset();
+}
+
 SkCanvas* SkSurface::getCanvas() {
     return asSB(this)->getCachedCanvas();
 }
@@ -119,11 +128,11 @@ void SkSurface::draw(SkCanvas* canvas, SkScalar x, SkScalar y, const SkSamplingO
 }
 
 bool SkSurface::peekPixels(SkPixmap* pmap) {
-    return this->getCanvas()->peekPixels(pmap);
+    return asSB(this)->onPeekPixels(pmap);
 }
 
 bool SkSurface::readPixels(const SkPixmap& pm, int srcX, int srcY) {
-    return this->getCanvas()->readPixels(pm, srcX, srcY);
+    return asSB(this)->onReadPixels(pm, srcX, srcY);
 }
 
 bool SkSurface::readPixels(const SkImageInfo& dstInfo, void* dstPixels, size_t dstRowBytes,
@@ -211,7 +220,9 @@ void SkSurface::writePixels(const SkPixmap& pmap, int x, int y) {
         if (srcR.contains(dstR)) {
             mode = kDiscard_ContentChangeMode;
         }
-        if (!asSB(this)->aboutToDraw(mode)) {
+        SkIRect dirty = srcR;
+        SkAssertResult(dirty.intersect(dstR));
+        if (!asSB(this)->aboutToDraw(mode, &dirty)) {
             return;
         }
         asSB(this)->onWritePixels(pmap, x, y);
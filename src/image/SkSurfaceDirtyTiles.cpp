@@ -0,0 +1,73 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/image/SkSurfaceDirtyTiles.h"
+
+#include "include/core/SkRegion.h"
+
+#include <algorithm>
+
+SkSurfaceDirtyTiles::SkSurfaceDirtyTiles(int width, int height)
+        : fBounds(SkIRect::MakeWH(std::max(width, 0), std::max(height, 0)))
+        , fCols((fBounds.width()  + kTileSize - 1) / kTileSize)
+        , fRows((fBounds.height() + kTileSize - 1) / kTileSize)
+        , fDirty(fCols * fRows, false) {}
+
+void SkSurfaceDirtyTiles::mark(const SkIRect& rect) {
+    SkIRect r;
+    if (this->isAll() || !r.intersect(rect, fBounds)) {
+        return;
+    }
+    const int l = r.fLeft / kTileSize, t = r.fTop / kTileSize,
+              rt = (r.fRight - 1) / kTileSize, b = (r.fBottom - 1) / kTileSize;
+    for (int y = t; y <= b; ++y) {
+        for (int x = l; x <= rt; ++x) {
+            if (!fDirty[y * fCols + x]) {
+                fDirty[y * fCols + x] = true;
+                fDirtyCount++;
+            }
+        }
+    }
+}
+
+void SkSurfaceDirtyTiles::markAll() {
+    std::fill(fDirty.begin(), fDirty.end(), true);
+    fDirtyCount = fCols * fRows;
+}
+
+void SkSurfaceDirtyTiles::reset() {
+    std::fill(fDirty.begin(), fDirty.end(), false);
+    fDirtyCount = 0;
+}
+
+SkRegion SkSurfaceDirtyTiles::region() const {
+    SkRegion region;
+    if (this->isAll()) {
+        region.setRect(fBounds);
+        return region;
+    }
+    for (int y = 0; y < fRows && !this->isEmpty(); ++y) {
+        // Add each horizontal run of dirty tiles as one rect.
+        for (int x = 0; x < fCols;) {
+            if (!fDirty[y * fCols + x]) {
+                ++x;
+                continue;
+            }
+            int end = x + 1;
+            while (end < fCols && fDirty[y * fCols + end]) {
+                ++end;
+            }
+            SkIRect run = SkIRect::MakeLTRB(x * kTileSize, y * kTileSize,
+                                            end * kTileSize, (y + 1) * kTileSize);
+            if (run.intersect(fBounds)) {
+                region.op(run, SkRegion::kUnion_Op);
+            }
+            x = end;
+        }
+    }
+    return region;
+}
@@ -0,0 +1,45 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkSurfaceDirtyTiles_DEFINED
+#define SkSurfaceDirtyTiles_DEFINED
+
+#include "include/core/SkRect.h"
+
+#include <vector>
+
+class SkRegion;
+
+/**
+ *  Tracks which kTileSize x kTileSize tiles of a surface have been drawn to. Marking is
+ *  conservative: any tile a rect touches becomes dirty.
+ */
+class SkSurfaceDirtyTiles {
+public:
+    static constexpr int kTileSize = 64;
+
+    SkSurfaceDirtyTiles(int width, int height);
+
+    void mark(const SkIRect&);
+    void markAll();
+    void reset();
+
+    bool isEmpty() const { return fDirtyCount == 0; }
+    bool isAll() const { return fDirtyCount == fCols * fRows; }
+
+    // The union of the dirty tiles, clipped to the surface bounds.
+    SkRegion region() const;
+
+private:
+    SkIRect fBounds;
+    int fCols;
+    int fRows;
+    int fDirtyCount = 0;
+    std::vector<bool> fDirty;  // fCols * fRows, row-major
+};
+
+#endif
@@ -30,10 +30,10 @@ class SkSurfaceProps;
 namespace skgpu { namespace graphite { class Recorder; } }
 
 SkSurface_Base::SkSurface_Base(int width, int height, const SkSurfaceProps* props)
-        : SkSurface(width, height, props) {}
+        : SkSurface(width, height, props), fDirtyTiles(width, height) {}
 
 SkSurface_Base::SkSurface_Base(const SkImageInfo& info, const SkSurfaceProps* props)
-        : SkSurface(info, props) {}
+        : SkSurface(info, props), fDirtyTiles(info.width(), info.height()) {}
 
 SkSurface_Base::~SkSurface_Base() {
     // in case the canvas outsurvives us, we null the callback
@@ -92,7 +92,15 @@ bool SkSurface_Base::outstandingImageSnapshot() const {
     return fCachedImage && !fCachedImage->unique();
 }
 
-bool SkSurface_Base::aboutToDraw(ContentChangeMode mode) {
+bool SkSurface_Base::onPeekPixels(SkPixmap* pmap) {
+    return this->getCachedCanvas()->peekPixels(pmap);
+}
+
+bool SkSurface_Base::onReadPixels(const SkPixmap& dst, int srcX, int srcY) {
+    return this->getCachedCanvas()->readPixels(dst, srcX, srcY);
+}
+
+bool SkSurface_Base::aboutToDraw(ContentChangeMode mode, const SkIRect* dirtyBounds) {
     this->dirtyGenerationID();
 
     SkASSERT(!fCachedCanvas || fCachedCanvas->getSurfaceBase() == this);
@@ -121,6 +129,13 @@ bool SkSurface_Base::aboutToDraw(ContentChangeMode mode) {
     } else if (kDiscard_ContentChangeMode == mode) {
         this->onDiscard();
     }
+
+    const SkIRect bounds = dirtyBounds ? *dirtyBounds : SkIRect::MakeWH(this->width(),
+                                                                        this->height());
+    if (!bounds.isEmpty()) {
+        fDirtyTiles.mark(bounds);
+        this->onMarkDirty(bounds);
+    }
     return true;
 }
 
@@ -15,6 +15,7 @@
 #include "include/core/SkScalar.h"
 #include "include/core/SkSurface.h"
 #include "include/core/SkTypes.h"
+#include "src/image/SkSurfaceDirtyTiles.h"
 
 #include <cstdint>
 #include <memory>
@@ -95,6 +96,14 @@ public:
 
     virtual void onWritePixels(const SkPixmap&, int x, int y) = 0;
 
+    /**
+     *  Backs SkSurface::peekPixels() and readPixels(). The default implementations go through
+     *  the cached canvas; surfaces whose canvas does not draw directly into their pixels override
+     *  these.
+     */
+    virtual bool onPeekPixels(SkPixmap*);
+    virtual bool onReadPixels(const SkPixmap& dst, int srcX, int srcY);
+
     /**
      * Default implementation does a rescale/read and then calls the callback.
      */
@@ -149,6 +158,11 @@ public:
      */
     virtual void onRestoreBackingMutability() {}
 
+    /**
+     *  Called after any copy-on-write, with the device-space bounds that are about to change.
+     */
+    virtual void onMarkDirty(const SkIRect&) {}
+
     /**
      * Caused the current backend 3D API to wait on the passed in semaphores before executing new
      * commands on the gpu. Any previously submitting commands will not be blocked by these
@@ -178,8 +192,12 @@ private:
     std::unique_ptr<SkCanvas> fCachedCanvas = nullptr;
     sk_sp<SkImage>            fCachedImage  = nullptr;
 
-    // Returns false if drawing should not take place (allocation failure).
-    [[nodiscard]] bool aboutToDraw(ContentChangeMode mode);
+    // Accumulated for SkSurface::dirtyRegion().
+    SkSurfaceDirtyTiles       fDirtyTiles;
+
+    // Returns false if drawing should not take place (allocation failure). 'dirtyBounds' are the
+    // device-space bounds the draw may change; null means the whole surface.
+    [[nodiscard]] bool aboutToDraw(ContentChangeMode mode, const SkIRect* dirtyBounds = nullptr);
 
     // Returns true if there is an outstanding image-snapshot, indicating that a call to aboutToDraw
     // would trigger a copy-on-write.
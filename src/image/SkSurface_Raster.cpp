@@ -15,6 +15,7 @@
 #include "include/core/SkPixelRef.h"
 #include "include/core/SkRect.h"
 #include "include/core/SkRefCnt.h"
+#include "include/core/SkRegion.h"
 #include "include/core/SkScalar.h"
 #include "include/core/SkSurface.h"
 #include "include/private/base/SkAssert.h"
@@ -59,6 +60,7 @@ SkSurface_Raster::SkSurface_Raster(const SkImageInfo& info, void* pixels, size_t
                                    void (*releaseProc)(void* pixels, void* context), void* context,
                                    const SkSurfaceProps* props)
     : INHERITED(info, props)
+    , fTilesSinceCopy(info.width(), info.height())
 {
     fBitmap.installPixels(info, pixels, rb, releaseProc, context);
     fWeOwnThePixels = false;    // We are "Direct"
@@ -67,6 +69,7 @@ SkSurface_Raster::SkSurface_Raster(const SkImageInfo& info, void* pixels, size_t
 SkSurface_Raster::SkSurface_Raster(const SkImageInfo& info, sk_sp<SkPixelRef> pr,
                                    const SkSurfaceProps* props)
     : INHERITED(pr->width(), pr->height(), props)
+    , fTilesSinceCopy(pr->width(), pr->height())
 {
     fBitmap.setInfo(info, pr->rowBytes());
     fBitmap.setPixelRef(std::move(pr), 0, 0);
@@ -127,7 +130,25 @@ bool SkSurface_Raster::onCopyOnWrite(ContentChangeMode mode) {
     SkASSERT(cached);
     if (SkBitmapImageGetPixelRef(cached.get()) == fBitmap.pixelRef()) {
         SkASSERT(fWeOwnThePixels);
-        if (kDiscard_ContentChangeMode == mode) {
+        sk_sp<SkPixelRef> shared = sk_ref_sp(fBitmap.pixelRef());
+
+        if (fSparePixels && fSparePixels->unique()) {
+            // The snapshot that held the spare pixels is gone, and they differ from ours only in
+            // the tiles drawn to since we last swapped, so those are all we need to copy.
+            SkBitmap spare;
+            spare.setInfo(fBitmap.info(), fSparePixels->rowBytes());
+            fSparePixels->restoreMutability();
+            spare.setPixelRef(std::move(fSparePixels), 0, 0);
+            if (kRetain_ContentChangeMode == mode) {
+                for (SkRegion::Iterator iter(fTilesSinceCopy.region()); !iter.done(); iter.next()) {
+                    SkPixmap src;
+                    SkAssertResult(fBitmap.pixmap().extractSubset(&src, iter.rect()));
+                    SkAssertResult(spare.writePixels(src, iter.rect().x(), iter.rect().y()));
+                }
+            }
+            spare.notifyPixelsChanged();
+            fBitmap = spare;
+        } else if (kDiscard_ContentChangeMode == mode) {
             if (!fBitmap.tryAllocPixels()) {
                 return false;
             }
@@ -141,6 +162,11 @@ bool SkSurface_Raster::onCopyOnWrite(ContentChangeMode mode) {
             memcpy(fBitmap.getPixels(), prev.getPixels(), fBitmap.computeByteSize());
         }
 
+        if (this->props().flags() & SkSurfaceProps::kReuseSnapshotPixels_Flag) {
+            fSparePixels = std::move(shared);
+            fTilesSinceCopy.reset();
+        }
+
         // Now fBitmap is a deep copy of itself (and therefore different from
         // what is being used by the image. Next we update the canvas to use
         // this as its backend, so we can't modify the image's pixels anymore.
@@ -151,6 +177,18 @@ bool SkSurface_Raster::onCopyOnWrite(ContentChangeMode mode) {
     return true;
 }
 
+void SkSurface_Raster::onMarkDirty(const SkIRect& bounds) {
+    if (fSparePixels) {
+        fTilesSinceCopy.mark(bounds);
+    }
+}
+
+bool SkSurface_Raster::onPeekPixels(SkPixmap* pmap) {
+    // Writes through the returned pixels aren't tracked, so the spare pixels can't be trusted.
+    fSparePixels.reset();
+    return INHERITED::onPeekPixels(pmap);
+}
+
 sk_sp<const SkCapabilities> SkSurface_Raster::onCapabilities() {
     return SkCapabilities::RasterBackend();
 }
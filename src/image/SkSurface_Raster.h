@@ -13,6 +13,7 @@
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkSamplingOptions.h"
 #include "include/core/SkScalar.h"
+#include "src/image/SkSurfaceDirtyTiles.h"
 #include "src/image/SkSurface_Base.h"
 
 #include <cstring>
@@ -48,11 +49,18 @@ public:
     bool onCopyOnWrite(ContentChangeMode) override;
     void onRestoreBackingMutability() override;
     sk_sp<const SkCapabilities> onCapabilities() override;
+    void onMarkDirty(const SkIRect&) override;
+    bool onPeekPixels(SkPixmap*) override;
 
 private:
     SkBitmap    fBitmap;
     bool        fWeOwnThePixels;
 
+    // With SkSurfaceProps::kReuseSnapshotPixels_Flag, the pixels last shared with a snapshot,
+    // and the tiles of fBitmap drawn to since fBitmap stopped matching them.
+    sk_sp<SkPixelRef>   fSparePixels;
+    SkSurfaceDirtyTiles fTilesSinceCopy;
+
     using INHERITED = SkSurface_Base;
 };
 
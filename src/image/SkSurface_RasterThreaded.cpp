@@ -0,0 +1,367 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/image/SkSurface_RasterThreaded.h"
+
+#include "include/core/SkBBHFactory.h"
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkCapabilities.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkMallocPixelRef.h"
+#include "include/core/SkPixelRef.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkSurface.h"
+#include "include/private/base/SkAssert.h"
+#include "include/private/base/SkMalloc.h"
+#include "src/core/SkBigPicture.h"
+#include "src/core/SkImagePriv.h"
+#include "src/core/SkRTree.h"
+#include "src/core/SkRecord.h"
+#include "src/core/SkRecordDraw.h"
+#include "src/core/SkRecorder.h"
+#include "src/core/SkRecords.h"
+#include "src/core/SkSurfacePriv.h"
+#include "src/core/SkTaskGroup.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace {
+
+SkRecords::Type op_type(const SkRecord& record, int i) {
+    return record.visit(i, [](const auto& op) { return std::decay_t<decltype(op)>::kType; });
+}
+
+bool is_save_or_restore_op(SkRecords::Type type) {
+    return type == SkRecords::Save_Type ||
+           type == SkRecords::SaveLayer_Type ||
+           type == SkRecords::SaveBehind_Type ||
+           type == SkRecords::Restore_Type;
+}
+
+bool is_state_op(SkRecords::Type type) {
+    switch (type) {
+        case SkRecords::SetMatrix_Type:
+        case SkRecords::SetM44_Type:
+        case SkRecords::Concat_Type:
+        case SkRecords::Concat44_Type:
+        case SkRecords::Translate_Type:
+        case SkRecords::Scale_Type:
+        case SkRecords::ClipPath_Type:
+        case SkRecords::ClipRRect_Type:
+        case SkRecords::ClipRect_Type:
+        case SkRecords::ClipRegion_Type:
+        case SkRecords::ClipShader_Type:
+        case SkRecords::ResetClip_Type:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Copies a Save or state op into another SkRecord.
+struct CopyStateOp {
+    SkRecord* fDst;
+
+    template <typename T> void operator()(const T& op) {
+        if constexpr (std::is_copy_constructible_v<T>) {
+            new (fDst->append<T>()) T(op);
+        } else {
+            SkUNREACHABLE;
+        }
+    }
+};
+
+}  // anonymous namespace
+
+SkSurface_RasterThreaded::SkSurface_RasterThreaded(const SkImageInfo& info,
+                                                   sk_sp<SkPixelRef> pr,
+                                                   SkExecutor* executor,
+                                                   int tileSize,
+                                                   const SkSurfaceProps* props)
+        : INHERITED(pr->width(), pr->height(), props)
+        , fExecutor(executor)
+        , fTileSize(tileSize)
+        , fRecord(sk_make_sp<SkRecord>()) {
+    fBitmap.setInfo(info, pr->rowBytes());
+    fBitmap.setPixelRef(std::move(pr), 0, 0);
+}
+
+SkSurface_RasterThreaded::~SkSurface_RasterThreaded() {
+    // The recorder (our cached canvas) outlives fRecord.
+    if (fRecorder) {
+        fRecorder->forgetRecord();
+    }
+}
+
+SkCanvas* SkSurface_RasterThreaded::onNewCanvas() {
+    SkASSERT(!fRecorder);
+    fRecorder = new SkRecorder(fRecord.get(), SkRect::Make(fBitmap.bounds()));
+    // The recorder never calls SkCanvas::predrawNotify(), so tell the surface about each op the
+    // way a raster canvas would before it draws. This forks the pixels from any outstanding
+    // snapshot, drops the cached one and bumps the generation ID.
+    fRecorder->setWillAppendProc(WillAppend, this);
+    return fRecorder;
+}
+
+void SkSurface_RasterThreaded::WillAppend(void* ctx) {
+    auto* surface = static_cast<SkSurface_RasterThreaded*>(ctx);
+    surface->notifyContentWillChange(kRetain_ContentChangeMode);
+}
+
+sk_sp<SkSurface> SkSurface_RasterThreaded::onNewSurface(const SkImageInfo& info) {
+    return SkSurfaces::RasterThreaded(info, fExecutor, fTileSize, &this->props());
+}
+
+void SkSurface_RasterThreaded::flushPendingDraws() {
+    const int count = fRecord->count();
+    if (!fRecorder || fFlushedOps == count) {
+        return;
+    }
+
+    // Draws inside a saveLayer() only reach the surface when the layer is restored, so stop at
+    // the outermost layer that is still open.
+    int end = count;
+    {
+        std::vector<std::pair<int, bool>> openSaves;  // (op index, is a layer)
+        for (int i = fFlushedOps; i < count; ++i) {
+            switch (op_type(*fRecord, i)) {
+                case SkRecords::Save_Type:
+                    openSaves.push_back({i, false});
+                    break;
+                case SkRecords::SaveLayer_Type:
+                case SkRecords::SaveBehind_Type:
+                    openSaves.push_back({i, true});
+                    break;
+                case SkRecords::Restore_Type:
+                    // Restores of saves opened in an earlier flush leave openSaves empty.
+                    if (!openSaves.empty()) {
+                        openSaves.pop_back();
+                    }
+                    break;
+                default:
+                    break;
+            }
+        }
+        for (const auto& [index, isLayer] : openSaves) {
+            if (isLayer) {
+                end = index;
+                break;
+            }
+        }
+    }
+    if (end == fFlushedOps) {
+        return;
+    }
+
+    // Bin the pending ops by tile. FillBounds needs to see the whole record to track the matrix
+    // and clip, but only the pending ops go into the hierarchy.
+    const int pending = end - fFlushedOps;
+    sk_sp<SkBBoxHierarchy> bbh;
+    {
+        std::vector<SkRect> bounds(count);
+        std::vector<SkBBoxHierarchy::Metadata> meta(count);
+        SkRecordFillBounds(SkRect::Make(fBitmap.bounds()), *fRecord, bounds.data(), meta.data());
+        bbh = sk_make_sp<SkRTree>();
+        bbh->insert(bounds.data() + fFlushedOps, meta.data() + fFlushedOps, pending);
+    }
+
+    // Saves, restores, and matrix/clip ops may pair up with ops that were already flushed, so
+    // their recorded bounds can't be trusted to cover what they affect. Every tile plays them.
+    std::vector<int> controlOps;
+    for (int i = fFlushedOps; i < end; ++i) {
+        SkRecords::Type type = op_type(*fRecord, i);
+        if (is_save_or_restore_op(type) || is_state_op(type)) {
+            controlOps.push_back(i - fFlushedOps);
+        }
+    }
+
+    // SkDrawables are not thread safe, but their picture snapshots are.
+    std::unique_ptr<SkBigPicture::SnapshotArray> drawables;
+    if (SkDrawableList* list = fRecorder->getDrawableList()) {
+        drawables.reset(list->newDrawableSnapshot());
+    }
+    const SkPicture* const* drawablePicts = drawables ? drawables->begin() : nullptr;
+    const int drawableCount = drawables ? drawables->count() : 0;
+
+    const int tilesX = (fBitmap.width()  + fTileSize - 1) / fTileSize,
+              tilesY = (fBitmap.height() + fTileSize - 1) / fTileSize;
+    SkExecutor& executor = fExecutor ? *fExecutor : SkExecutor::GetDefault();
+    SkTaskGroup(executor).batch(tilesX * tilesY, [&](int t) {
+        const SkIRect tile = SkIRect::MakeXYWH((t % tilesX) * fTileSize,
+                                               (t / tilesX) * fTileSize,
+                                               fTileSize,
+                                               fTileSize);
+        std::vector<int> ops;
+        bbh->search(SkRect::Make(tile), &ops);
+        if (ops.empty()) {
+            return;
+        }
+        ops.insert(ops.end(), controlOps.begin(), controlOps.end());
+        std::sort(ops.begin(), ops.end());
+        ops.erase(std::unique(ops.begin(), ops.end()), ops.end());
+
+        // Each tile canvas draws in the surface's device space, but is never allowed to touch
+        // pixels outside its tile, even through resetClip().
+        SkCanvas canvas(fBitmap, this->props());
+        canvas.androidFramework_setDeviceClipRestriction(tile);
+
+        SkRecords::Draw draw(&canvas, drawablePicts, nullptr, drawableCount);
+        for (int i : fLiveStateOps) {
+            fRecord->visit(i, draw);
+        }
+        for (int i : ops) {
+            fRecord->visit(fFlushedOps + i, draw);
+        }
+    });
+
+    // Track which saves and matrix/clip ops are still in effect after the flushed ops.
+    for (int i = fFlushedOps; i < end; ++i) {
+        SkRecords::Type type = op_type(*fRecord, i);
+        if (is_save_or_restore_op(type) && type != SkRecords::Restore_Type) {
+            fSaveStack.push_back(fLiveStateOps.size());
+            fLiveStateOps.push_back(i);
+        } else if (type == SkRecords::Restore_Type) {
+            if (!fSaveStack.empty()) {
+                fLiveStateOps.resize(fSaveStack.back());
+                fSaveStack.pop_back();
+            }
+        } else if (is_state_op(type)) {
+            fLiveStateOps.push_back(i);
+        }
+    }
+    fFlushedOps = end;
+
+    // If nothing is left pending, start a new record holding only the state still in effect so
+    // the record doesn't grow without bound.
+    if (end == count) {
+        auto compacted = sk_make_sp<SkRecord>();
+        CopyStateOp copy{compacted.get()};
+        for (int& i : fLiveStateOps) {
+            fRecord->visit(i, copy);
+            i = compacted->count() - 1;
+        }
+        fRecord = std::move(compacted);
+        fFlushedOps = fRecord->count();
+        fRecorder->setRecord(fRecord.get());
+    }
+}
+
+void SkSurface_RasterThreaded::onDraw(SkCanvas* canvas, SkScalar x, SkScalar y,
+                                      const SkSamplingOptions& sampling, const SkPaint* paint) {
+    this->flushPendingDraws();
+    canvas->drawImage(fBitmap.asImage().get(), x, y, sampling, paint);
+}
+
+sk_sp<SkImage> SkSurface_RasterThreaded::onNewImageSnapshot(const SkIRect* subset) {
+    this->flushPendingDraws();
+    if (subset) {
+        SkASSERT(SkIRect::MakeWH(fBitmap.width(), fBitmap.height()).contains(*subset));
+        SkBitmap dst;
+        dst.allocPixels(fBitmap.info().makeDimensions(subset->size()));
+        SkAssertResult(fBitmap.readPixels(dst.pixmap(), subset->left(), subset->top()));
+        dst.setImmutable();
+        return dst.asImage();
+    }
+
+    // We always own our pixels; undone by onRestoreBackingMutability() if we can avoid the COW.
+    if (SkPixelRef* pr = fBitmap.pixelRef()) {
+        pr->setTemporarilyImmutable();
+    }
+    return SkMakeImageFromRasterBitmap(fBitmap, kIfMutable_SkCopyPixelsMode);
+}
+
+void SkSurface_RasterThreaded::onWritePixels(const SkPixmap& src, int x, int y) {
+    this->flushPendingDraws();
+    fBitmap.writePixels(src, x, y);
+}
+
+bool SkSurface_RasterThreaded::onPeekPixels(SkPixmap* pixmap) {
+    this->flushPendingDraws();
+    return fBitmap.peekPixels(pixmap);
+}
+
+bool SkSurface_RasterThreaded::onReadPixels(const SkPixmap& dst, int srcX, int srcY) {
+    this->flushPendingDraws();
+    return fBitmap.readPixels(dst, srcX, srcY);
+}
+
+void SkSurface_RasterThreaded::onRestoreBackingMutability() {
+    SkASSERT(!this->hasCachedImage());  // Shouldn't be any snapshots out there.
+    if (SkPixelRef* pr = fBitmap.pixelRef()) {
+        pr->restoreMutability();
+    }
+}
+
+bool SkSurface_RasterThreaded::onCopyOnWrite(ContentChangeMode mode) {
+    // Are we sharing pixelrefs with the image? Unlike SkSurface_Raster there is no device to
+    // retarget; tile canvases are created from fBitmap on every flush.
+    sk_sp<SkImage> cached(this->refCachedImage());
+    SkASSERT(cached);
+    if (SkBitmapImageGetPixelRef(cached.get()) == fBitmap.pixelRef()) {
+        SkBitmap prev(fBitmap);
+        if (!fBitmap.tryAllocPixels()) {
+            return false;
+        }
+        if (kRetain_ContentChangeMode == mode) {
+            SkASSERT(prev.info() == fBitmap.info());
+            SkASSERT(prev.rowBytes() == fBitmap.rowBytes());
+            memcpy(fBitmap.getPixels(), prev.getPixels(), fBitmap.computeByteSize());
+        }
+    }
+    return true;
+}
+
+sk_sp<const SkCapabilities> SkSurface_RasterThreaded::onCapabilities() {
+    return SkCapabilities::RasterBackend();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Smaller surfaces fit in a few huge pages, so there's little to spread across NUMA nodes.
+static constexpr size_t kMinFirstTouchBytes = 8 * 1024 * 1024;
+
+namespace SkSurfaces {
+
+sk_sp<SkSurface> RasterThreaded(const SkImageInfo& info,
+                                SkExecutor* executor,
+                                int tileSize,
+                                const SkSurfaceProps* props) {
+    if (!SkSurfaceValidateRasterInfo(info) || tileSize <= 0) {
+        return nullptr;
+    }
+
+    sk_sp<SkPixelRef> pr = SkMallocPixelRef::MakeAllocate(info, 0);
+    if (!pr) {
+        return nullptr;
+    }
+
+    // Large allocations are usually fresh pages that nothing has written yet. Writing each band
+    // of tiles first from the executor spreads them over the NUMA nodes its threads run on,
+    // instead of putting them all on this thread's node. They're zero either way.
+    const size_t rowBytes = pr->rowBytes();
+    if (info.computeByteSize(rowBytes) >= kMinFirstTouchBytes) {
+        char* pixels = static_cast<char*>(pr->pixels());
+        const int bands = (info.height() + tileSize - 1) / tileSize;
+        SkTaskGroup(executor ? *executor : SkExecutor::GetDefault()).batch(bands, [&](int band) {
+            const int top = band * tileSize;
+            const int rows = std::min(tileSize, info.height() - top);
+            sk_bzero(pixels + top * rowBytes, rows * rowBytes);
+        });
+    }
+
+    return sk_make_sp<SkSurface_RasterThreaded>(info, std::move(pr), executor, tileSize, props);
+}
+
+}  // namespace SkSurfaces
@@ -0,0 +1,89 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkSurface_RasterThreaded_DEFINED
+#define SkSurface_RasterThreaded_DEFINED
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkSamplingOptions.h"
+#include "include/core/SkScalar.h"
+#include "src/image/SkSurface_Base.h"
+
+#include <vector>
+
+class SkCanvas;
+class SkCapabilities;
+class SkExecutor;
+class SkImage;
+class SkPaint;
+class SkPixelRef;
+class SkPixmap;
+class SkRecord;
+class SkRecorder;
+class SkSurface;
+class SkSurfaceProps;
+struct SkIRect;
+
+/**
+ *  A raster surface whose canvas records draws into an SkRecord instead of rasterizing them
+ *  immediately. Whenever the pixels are needed (snapshots, reads, writes, drawing the surface),
+ *  the pending draws are binned by tile using their recorded bounds and each tile is rasterized
+ *  on an SkExecutor, each tile with its own SkCanvas clipped to that tile. Every tile canvas draws
+ *  in the surface's own device space, so the result is identical to drawing serially with a clip
+ *  to each tile in turn. (Edges that cross tile boundaries may round slightly differently than
+ *  they would when drawn without any clip.)
+ */
+class SkSurface_RasterThreaded : public SkSurface_Base {
+public:
+    SkSurface_RasterThreaded(const SkImageInfo& info, sk_sp<SkPixelRef>, SkExecutor*,
+                             int tileSize, const SkSurfaceProps*);
+    ~SkSurface_RasterThreaded() override;
+
+    // From SkSurface.h
+    SkImageInfo imageInfo() const override { return fBitmap.info(); }
+
+    // From SkSurface_Base.h
+    SkSurface_Base::Type type() const override { return SkSurface_Base::Type::kRaster; }
+
+    SkCanvas* onNewCanvas() override;
+    sk_sp<SkSurface> onNewSurface(const SkImageInfo&) override;
+    sk_sp<SkImage> onNewImageSnapshot(const SkIRect* subset) override;
+    void onWritePixels(const SkPixmap&, int x, int y) override;
+    bool onPeekPixels(SkPixmap*) override;
+    bool onReadPixels(const SkPixmap&, int srcX, int srcY) override;
+    void onDraw(SkCanvas*, SkScalar, SkScalar, const SkSamplingOptions&, const SkPaint*) override;
+    bool onCopyOnWrite(ContentChangeMode) override;
+    void onRestoreBackingMutability() override;
+    sk_sp<const SkCapabilities> onCapabilities() override;
+
+private:
+    static void WillAppend(void* ctx);
+
+    // Rasterizes all the recorded draws that are not inside a still-open saveLayer().
+    void flushPendingDraws();
+
+    SkBitmap        fBitmap;
+    SkExecutor*     fExecutor;
+    const int       fTileSize;
+
+    sk_sp<SkRecord> fRecord;
+    SkRecorder*     fRecorder = nullptr;  // Owned by SkSurface_Base as the cached canvas.
+
+    // Ops in fRecord before fFlushedOps have already been rasterized.
+    int             fFlushedOps = 0;
+    // Indices of already-rasterized matrix and clip ops that are still in effect, in order.
+    // These are replayed into each tile canvas before the pending ops.
+    std::vector<int> fLiveStateOps;
+    // For each open save() below fFlushedOps, the size of fLiveStateOps when it was opened.
+    std::vector<int> fSaveStack;
+
+    using INHERITED = SkSurface_Base;
+};
+
+#endif
@@ -0,0 +1,171 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/image/SkTileStreamer.h"
+
+#include "include/core/SkAlphaType.h"
+#include "include/core/SkBitmap.h"
+#include "include/core/SkColorType.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkPixmap.h"
+#include "include/core/SkSize.h"
+#include "include/private/base/SkTo.h"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace SkTiledImageUtils {
+
+std::unique_ptr<TileStreamer> TileStreamer::Make(size_t uploadBudgetPerFrame,
+                                                 size_t tileCacheBytes) {
+    return std::make_unique<SkTileStreamer>(uploadBudgetPerFrame, tileCacheBytes);
+}
+
+}  // namespace SkTiledImageUtils
+
+// A handful of large images on screen at once is typical, and a placeholder is at most 1MB.
+static constexpr int kMaxPlaceholders = 8;
+
+SkTileStreamer::SkTileStreamer(size_t uploadBudgetPerFrame, size_t tileCacheBytes)
+        : fUploadBudget(uploadBudgetPerFrame)
+        , fTileCacheBytes(tileCacheBytes)
+        , fTiles(INT_MAX)
+        , fPlaceholders(kMaxPlaceholders) {}
+
+void SkTileStreamer::newFrame() {
+    ++fFrame;
+    fBytesUploaded = 0;
+    fTilesUploaded = 0;
+    fPlaceholderTiles = 0;
+}
+
+SkTileStreamer::TileKey SkTileStreamer::MakeKey(const SkBitmap& bitmap, const SkIRect& subset) {
+    return {bitmap.getGenerationID(), subset.makeOffset(bitmap.pixelRefOrigin())};
+}
+
+bool SkTileStreamer::admitTile(const SkBitmap& bitmap, const SkIRect& subset,
+                               size_t gpuCacheSize) {
+    const TileKey key = MakeKey(bitmap, subset);
+    if (Tile* tile = fTiles.find(key)) {
+        tile->fLastFrame = fFrame;
+        return true;
+    }
+
+    const size_t bytes = SkToSizeT(subset.width()) * subset.height() * bitmap.bytesPerPixel();
+    if (fTilesUploaded > 0 && fBytesUploaded + bytes > fUploadBudget) {
+        return false;
+    }
+    fBytesUploaded += bytes;
+    fTilesUploaded += 1;
+    fTiles.insert(key, {key, bytes, fFrame});
+    fTileBytes += bytes;
+    this->purgeTiles(gpuCacheSize);
+    return true;
+}
+
+void SkTileStreamer::purgeTiles(size_t gpuCacheSize) {
+    // Tiles the GPU cache has likely evicted would be uploaded again without being charged, so
+    // don't remember more than it can reasonably hold.
+    size_t limit = fTileCacheBytes;
+    if (gpuCacheSize) {
+        limit = std::min(limit, gpuCacheSize / 2);
+    }
+    Tile lru;
+    while (fTileBytes > limit && fTiles.removeLeastRecentlyUsed(&lru)) {
+        if (lru.fLastFrame == fFrame) {
+            // Everything left is drawn this frame, so it is on the GPU regardless.
+            fTiles.insert(lru.fKey, lru);
+            break;
+        }
+        fTileBytes -= lru.fBytes;
+    }
+}
+
+// Averages the source pixels that fall in each destination pixel, in a single pass over the source.
+// (Sampling a mip level instead would build the whole mip chain on the drawing thread first.) The
+// source is read one row at a time, converted to the destination's premultiplied N32 format.
+static bool box_downsample(const SkPixmap& src, const SkPixmap& dst) {
+    SkASSERT(dst.colorType() == kN32_SkColorType);
+    SkASSERT(dst.width() <= src.width() && dst.height() <= src.height());
+    // The first source row or column of destination pixel i.
+    auto edge = [](int i, int srcSize, int dstSize) {
+        return SkToInt(int64_t(i) * srcSize / dstSize);
+    };
+
+    const SkImageInfo rowInfo = dst.info().makeWH(src.width(), 1);
+    std::vector<uint32_t> row(src.width());
+    std::vector<uint32_t> sums(4 * dst.width());
+    for (int y = 0; y < dst.height(); ++y) {
+        const int top = edge(y, src.height(), dst.height());
+        const int bottom = edge(y + 1, src.height(), dst.height());
+        std::fill(sums.begin(), sums.end(), 0);
+        for (int sy = top; sy < bottom; ++sy) {
+            if (!src.readPixels(rowInfo, row.data(), rowInfo.minRowBytes(), 0, sy)) {
+                return false;
+            }
+            for (int x = 0; x < dst.width(); ++x) {
+                const int right = edge(x + 1, src.width(), dst.width());
+                for (int sx = edge(x, src.width(), dst.width()); sx < right; ++sx) {
+                    for (int c = 0; c < 4; ++c) {
+                        sums[4 * x + c] += (row[sx] >> (8 * c)) & 0xFF;
+                    }
+                }
+            }
+        }
+
+        uint32_t* out = dst.writable_addr32(0, y);
+        for (int x = 0; x < dst.width(); ++x) {
+            const uint32_t count = (bottom - top) * (edge(x + 1, src.width(), dst.width()) -
+                                                     edge(x, src.width(), dst.width()));
+            uint32_t pixel = 0;
+            for (int c = 0; c < 4; ++c) {
+                pixel |= ((sums[4 * x + c] + count / 2) / count) << (8 * c);
+            }
+            out[x] = pixel;
+        }
+    }
+    return true;
+}
+
+sk_sp<SkImage> SkTileStreamer::placeholderForTile(const SkBitmap& bitmap) {
+    const TileKey key = MakeKey(bitmap, bitmap.bounds());
+    if (sk_sp<SkImage>* found = fPlaceholders.find(key)) {
+        fPlaceholderTiles += 1;
+        return *found;
+    }
+
+    const float scale = (float)kPlaceholderMaxDimension / std::max(bitmap.width(), bitmap.height());
+    if (scale > 0.5f) {
+        return nullptr;
+    }
+    const SkISize size = {std::max(1, (int)std::round(bitmap.width() * scale)),
+                          std::max(1, (int)std::round(bitmap.height() * scale))};
+    SkBitmap lowRes;
+    const SkAlphaType alphaType = bitmap.isOpaque() ? kOpaque_SkAlphaType : kPremul_SkAlphaType;
+    if (!lowRes.tryAllocPixels(bitmap.info().makeDimensions(size)
+                                             .makeColorType(kN32_SkColorType)
+                                             .makeAlphaType(alphaType))) {
+        return nullptr;
+    }
+    // Averaging every pixel keeps the placeholder from aliasing the way a plain linear downscale
+    // by this much would.
+    if (!box_downsample(bitmap.pixmap(), lowRes.pixmap())) {
+        return nullptr;
+    }
+    lowRes.setImmutable();
+    sk_sp<SkImage> image = lowRes.asImage();
+
+    // The placeholder is uploaded the first time it is drawn.
+    fBytesUploaded += lowRes.computeByteSize();
+    fPlaceholderTiles += 1;
+    fPlaceholders.insert(key, image);
+    return image;
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkTileStreamer_DEFINED
+#define SkTileStreamer_DEFINED
+
+#include "include/core/SkImage.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkTiledImageUtils.h"
+#include "src/core/SkLRUCache.h"
+
+#include <cstddef>
+#include <cstdint>
+
+class SkBitmap;
+
+/**
+ *  The implementation of SkTiledImageUtils::TileStreamer. The tiled draw asks it about each tile
+ *  in turn. Tiles are identified by the bitmap's generation ID and the subset of its pixel ref,
+ *  the same way the GPU backends key the textures they upload for them.
+ */
+class SkTileStreamer final : public SkTiledImageUtils::TileStreamer {
+public:
+    // Placeholders fit in this many pixels on their longer side.
+    static constexpr int kPlaceholderMaxDimension = 512;
+
+    SkTileStreamer(size_t uploadBudgetPerFrame, size_t tileCacheBytes);
+
+    void newFrame() override;
+    size_t bytesUploadedThisFrame() const override { return fBytesUploaded; }
+    int placeholderTilesThisFrame() const override { return fPlaceholderTiles; }
+
+    // Returns true if the 'subset' of 'bitmap' should be drawn now: either it was drawn recently,
+    // or this frame's budget has room to upload it. The first new tile of a frame is always let
+    // through, so a budget smaller than a tile still makes progress. 'gpuCacheSize' is the GPU
+    // resource cache limit, or 0 if it is unknown.
+    bool admitTile(const SkBitmap& bitmap, const SkIRect& subset, size_t gpuCacheSize);
+
+    // Returns a low-resolution copy of 'bitmap' to draw in place of a tile that admitTile()
+    // turned away, and counts that tile. Returns null if 'bitmap' is too small for a placeholder
+    // to save anything, in which case the tile should be drawn anyway.
+    sk_sp<SkImage> placeholderForTile(const SkBitmap& bitmap);
+
+private:
+    struct TileKey {
+        uint32_t fGenID;
+        SkIRect  fSubset;  // In the coordinates of the pixel ref.
+
+        bool operator==(const TileKey& that) const {
+            return fGenID == that.fGenID && fSubset == that.fSubset;
+        }
+    };
+
+    struct Tile {
+        TileKey  fKey;
+        size_t   fBytes;
+        uint64_t fLastFrame;
+    };
+
+    static TileKey MakeKey(const SkBitmap&, const SkIRect& subset);
+
+    void purgeTiles(size_t gpuCacheSize);
+
+    const size_t fUploadBudget;
+    const size_t fTileCacheBytes;
+
+    uint64_t fFrame = 0;
+    size_t fBytesUploaded = 0;
+    int fTilesUploaded = 0;
+    int fPlaceholderTiles = 0;
+
+    // The tiles drawn recently, which are assumed to still be on the GPU. Their count is unbounded;
+    // purgeTiles() trims them by bytes instead.
+    SkLRUCache<TileKey, Tile> fTiles;
+    size_t fTileBytes = 0;
+
+    SkLRUCache<TileKey, sk_sp<SkImage>> fPlaceholders;
+};
+
+#endif
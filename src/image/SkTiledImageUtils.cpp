@@ -28,6 +28,17 @@ void DrawImageRect(SkCanvas* canvas,
                    const SkSamplingOptions& sampling,
                    const SkPaint* paint,
                    SkCanvas::SrcRectConstraint constraint) {
+    DrawImageRect(canvas, image, src, dst, sampling, paint, constraint, /*streamer=*/nullptr);
+}
+
+void DrawImageRect(SkCanvas* canvas,
+                   const SkImage* image,
+                   const SkRect& src,
+                   const SkRect& dst,
+                   const SkSamplingOptions& sampling,
+                   const SkPaint* paint,
+                   SkCanvas::SrcRectConstraint constraint,
+                   TileStreamer* streamer) {
     if (!image || !canvas) {
         return;
     }
@@ -37,7 +48,7 @@ void DrawImageRect(SkCanvas* canvas,
         p = *paint;
     }
     if (!SkCanvasPriv::TopDevice(canvas)->drawAsTiledImageRect(
-                canvas, image, &src, dst, sampling, p, constraint)) {
+                canvas, image, &src, dst, sampling, p, constraint, streamer)) {
         // Either the image didn't require tiling or this is a raster-backed
         // canvas. In either case fall back to a default draw.
         canvas->drawImageRect(image, src, dst, sampling, paint, constraint);
@@ -11,9 +11,13 @@
 #include "include/private/chromium/SkDiscardableMemory.h"
 #include "src/base/SkTInternalLList.h"
 #include "src/lazy/SkDiscardableMemoryPool.h"
+#include "src/lazy/SkPurgeablePages.h"
 
 using namespace skia_private;
 
+// Smaller allocations are malloc'd even by purgeable pools, since they'd waste most of a page.
+static constexpr size_t kMinPurgeableBytes = 64 * 1024;
+
 // Note:
 // A PoolDiscardableMemory is memory that is counted in a pool.
 // A DiscardableMemoryPool is a pool of PoolDiscardableMemorys.
@@ -28,7 +32,7 @@ class PoolDiscardableMemory;
  */
 class DiscardableMemoryPool : public SkDiscardableMemoryPool {
 public:
-    DiscardableMemoryPool(size_t budget);
+    DiscardableMemoryPool(size_t budget, bool purgeable);
     ~DiscardableMemoryPool() override;
 
     std::unique_ptr<SkDiscardableMemory> make(size_t bytes);
@@ -57,10 +61,13 @@ private:
     SkMutex      fMutex;
     size_t       fBudget;
     size_t       fUsed;
+    const bool   fPurgeable;
     SkTInternalLList<PoolDiscardableMemory> fList;
 
     /** Function called to free memory if needed */
     void dumpDownTo(size_t budget);
+    /** Frees an unlocked DM's memory and takes it out of the pool. */
+    void purge(PoolDiscardableMemory* dm);
     /** called by DiscardableMemoryPool upon destruction */
     void removeFromPool(PoolDiscardableMemory* dm);
     /** called by DiscardableMemoryPool::lock() */
@@ -80,6 +87,9 @@ private:
 class PoolDiscardableMemory : public SkDiscardableMemory {
 public:
     PoolDiscardableMemory(sk_sp<DiscardableMemoryPool> pool, UniqueVoidPtr pointer, size_t bytes);
+    PoolDiscardableMemory(sk_sp<DiscardableMemoryPool> pool,
+                          std::unique_ptr<SkPurgeablePages> pages,
+                          size_t bytes);
     ~PoolDiscardableMemory() override;
     bool lock() override;
     void* data() override;
@@ -88,8 +98,12 @@ public:
 private:
     SK_DECLARE_INTERNAL_LLIST_INTERFACE(PoolDiscardableMemory);
     sk_sp<DiscardableMemoryPool> fPool;
+    bool hasMemory() const { return fPointer != nullptr || fPages != nullptr; }
+
     bool                         fLocked;
     UniqueVoidPtr                   fPointer;
+    // Instead of fPointer, for pools whose memory the OS may reclaim while it's unlocked.
+    std::unique_ptr<SkPurgeablePages> fPages;
     const size_t                 fBytes;
 };
 
@@ -102,6 +116,15 @@ PoolDiscardableMemory::PoolDiscardableMemory(sk_sp<DiscardableMemoryPool> pool,
     SkASSERT(fBytes > 0);
 }
 
+PoolDiscardableMemory::PoolDiscardableMemory(sk_sp<DiscardableMemoryPool> pool,
+                                             std::unique_ptr<SkPurgeablePages> pages,
+                                             size_t bytes)
+        : fPool(std::move(pool)), fLocked(true), fPages(std::move(pages)), fBytes(bytes) {
+    SkASSERT(fPool != nullptr);
+    SkASSERT(fPages != nullptr);
+    SkASSERT(fBytes > 0);
+}
+
 PoolDiscardableMemory::~PoolDiscardableMemory() {
     SkASSERT(!fLocked); // contract for SkDiscardableMemory
     fPool->removeFromPool(this);
@@ -114,7 +137,7 @@ bool PoolDiscardableMemory::lock() {
 
 void* PoolDiscardableMemory::data() {
     SkASSERT(fLocked); // contract for SkDiscardableMemory
-    return fPointer.get();
+    return fPages ? fPages->data() : fPointer.get();
 }
 
 void PoolDiscardableMemory::unlock() {
@@ -124,9 +147,10 @@ void PoolDiscardableMemory::unlock() {
 
 ////////////////////////////////////////////////////////////////////////////////
 
-DiscardableMemoryPool::DiscardableMemoryPool(size_t budget)
+DiscardableMemoryPool::DiscardableMemoryPool(size_t budget, bool purgeable)
     : fBudget(budget)
-    , fUsed(0) {
+    , fUsed(0)
+    , fPurgeable(purgeable) {
     #if SK_LAZY_CACHE_STATS
     fCacheHits = 0;
     fCacheMisses = 0;
@@ -150,26 +174,41 @@ void DiscardableMemoryPool::dumpDownTo(size_t budget) {
     while ((fUsed > budget) && (cur)) {
         if (!cur->fLocked) {
             PoolDiscardableMemory* dm = cur;
-            SkASSERT(dm->fPointer != nullptr);
-            dm->fPointer = nullptr;
-            SkASSERT(fUsed >= dm->fBytes);
-            fUsed -= dm->fBytes;
             cur = iter.prev();
-            // Purged DMs are taken out of the list.  This saves times
-            // looking them up.  Purged DMs are NOT deleted.
-            fList.remove(dm);
+            this->purge(dm);
         } else {
             cur = iter.prev();
         }
     }
 }
 
+void DiscardableMemoryPool::purge(PoolDiscardableMemory* dm) {
+    fMutex.assertHeld();
+    SkASSERT(!dm->fLocked);
+    SkASSERT(dm->hasMemory());
+    dm->fPointer = nullptr;
+    dm->fPages = nullptr;
+    SkASSERT(fUsed >= dm->fBytes);
+    fUsed -= dm->fBytes;
+    // Purged DMs are taken out of the list.  This saves times
+    // looking them up.  Purged DMs are NOT deleted.
+    fList.remove(dm);
+}
+
 std::unique_ptr<SkDiscardableMemory> DiscardableMemoryPool::make(size_t bytes) {
-    UniqueVoidPtr addr(sk_malloc_canfail(bytes));
-    if (nullptr == addr) {
-        return nullptr;
+    std::unique_ptr<PoolDiscardableMemory> dm;
+    if (fPurgeable && bytes >= kMinPurgeableBytes) {
+        if (auto pages = SkPurgeablePages::Make(bytes)) {
+            dm = std::make_unique<PoolDiscardableMemory>(sk_ref_sp(this), std::move(pages), bytes);
+        }
+    }
+    if (!dm) {
+        UniqueVoidPtr addr(sk_malloc_canfail(bytes));
+        if (nullptr == addr) {
+            return nullptr;
+        }
+        dm = std::make_unique<PoolDiscardableMemory>(sk_ref_sp(this), std::move(addr), bytes);
     }
-    auto dm = std::make_unique<PoolDiscardableMemory>(sk_ref_sp(this), std::move(addr), bytes);
     SkAutoMutexExclusive autoMutexAcquire(fMutex);
     fList.addToHead(dm.get());
     fUsed += bytes;
@@ -180,7 +219,7 @@ std::unique_ptr<SkDiscardableMemory> DiscardableMemoryPool::make(size_t bytes) {
 void DiscardableMemoryPool::removeFromPool(PoolDiscardableMemory* dm) {
     SkAutoMutexExclusive autoMutexAcquire(fMutex);
     // This is called by dm's destructor.
-    if (dm->fPointer != nullptr) {
+    if (dm->hasMemory()) {
         SkASSERT(fUsed >= dm->fBytes);
         fUsed -= dm->fBytes;
         fList.remove(dm);
@@ -192,7 +231,11 @@ void DiscardableMemoryPool::removeFromPool(PoolDiscardableMemory* dm) {
 bool DiscardableMemoryPool::lock(PoolDiscardableMemory* dm) {
     SkASSERT(dm != nullptr);
     SkAutoMutexExclusive autoMutexAcquire(fMutex);
-    if (nullptr == dm->fPointer) {
+    if (dm->hasMemory() && dm->fPages && !dm->fPages->lock()) {
+        // The OS reclaimed some of it.
+        this->purge(dm);
+    }
+    if (!dm->hasMemory()) {
         // May have been purged while waiting for lock.
         #if SK_LAZY_CACHE_STATS
         ++fCacheMisses;
@@ -210,6 +253,10 @@ bool DiscardableMemoryPool::lock(PoolDiscardableMemory* dm) {
 
 void DiscardableMemoryPool::unlock(PoolDiscardableMemory* dm) {
     SkASSERT(dm != nullptr);
+    if (dm->fPages) {
+        // Still locked, so it can't be purged meanwhile.
+        dm->fPages->unlock();
+    }
     SkAutoMutexExclusive autoMutexAcquire(fMutex);
     dm->fLocked = false;
     this->dumpDownTo(fBudget);
@@ -231,12 +278,21 @@ void DiscardableMemoryPool::dumpPool() {
 }  // namespace
 
 sk_sp<SkDiscardableMemoryPool> SkDiscardableMemoryPool::Make(size_t size) {
-    return sk_make_sp<DiscardableMemoryPool>(size);
+    return sk_make_sp<DiscardableMemoryPool>(size, /*purgeable=*/false);
+}
+
+sk_sp<SkDiscardableMemoryPool> SkDiscardableMemoryPool::MakePurgeable(size_t size) {
+    return sk_make_sp<DiscardableMemoryPool>(size, /*purgeable=*/true);
 }
 
 SkDiscardableMemoryPool* SkGetGlobalDiscardableMemoryPool() {
     // Intentionally leak this global pool.
     static SkDiscardableMemoryPool* global =
-            new DiscardableMemoryPool(SK_DEFAULT_GLOBAL_DISCARDABLE_MEMORY_POOL_SIZE);
+            new DiscardableMemoryPool(SK_DEFAULT_GLOBAL_DISCARDABLE_MEMORY_POOL_SIZE,
+#if defined(SK_DISABLE_PURGEABLE_DISCARDABLE_MEMORY)
+                                      /*purgeable=*/false);
+#else
+                                      /*purgeable=*/true);
+#endif
     return global;
 }
@@ -50,11 +50,19 @@ public:
      *  the pool works.
      */
     static sk_sp<SkDiscardableMemoryPool> Make(size_t size);
+
+    /**
+     *  Like Make(), but while large blocks are unlocked the OS may also reclaim them under memory
+     *  pressure (with madvise(MADV_FREE) on Linux and Android), which makes their next lock()
+     *  fail. Elsewhere this is the same as Make().
+     */
+    static sk_sp<SkDiscardableMemoryPool> MakePurgeable(size_t size);
 };
 
 /**
  *  Returns (and creates if needed) a threadsafe global
- *  SkDiscardableMemoryPool.
+ *  SkDiscardableMemoryPool. Its memory is purgeable by the OS, as with
+ *  MakePurgeable(), unless SK_DISABLE_PURGEABLE_DISCARDABLE_MEMORY is defined.
  */
 SkDiscardableMemoryPool* SkGetGlobalDiscardableMemoryPool();
 
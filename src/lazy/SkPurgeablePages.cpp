@@ -0,0 +1,91 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/lazy/SkPurgeablePages.h"
+
+#include "include/core/SkTypes.h"
+#include "include/private/base/SkAlign.h"
+
+#if (defined(SK_BUILD_FOR_UNIX) || defined(SK_BUILD_FOR_ANDROID)) && !defined(__EMSCRIPTEN__)
+    #include <sys/mman.h>
+    #include <unistd.h>
+    #if defined(MADV_FREE)
+        #define SK_PURGEABLE_PAGES_SUPPORTED
+    #endif
+#endif
+
+#if defined(SK_PURGEABLE_PAGES_SUPPORTED)
+
+#include <atomic>
+#include <cstdint>
+
+// Any non-zero value works, since reclaimed pages read back as zero.
+static constexpr uint64_t kCookie = 0x536b50757267656bull;
+
+// Kernels before 4.5 reject MADV_FREE; their pages just aren't purgeable.
+static std::atomic<bool> gMadvFreeWorks{true};
+
+SkPurgeablePages::SkPurgeablePages(void* addr, size_t mappedBytes, size_t pageSize)
+        : fAddr(addr)
+        , fMappedBytes(mappedBytes)
+        , fPageSize(pageSize)
+        , fSavedWords(new uint64_t[mappedBytes / pageSize]) {}
+
+std::unique_ptr<SkPurgeablePages> SkPurgeablePages::Make(size_t bytes) {
+    if (!gMadvFreeWorks.load(std::memory_order_relaxed)) {
+        return nullptr;
+    }
+    const long pageSize = sysconf(_SC_PAGESIZE);
+    if (bytes == 0 || pageSize <= 0 || bytes > SIZE_MAX - pageSize) {
+        return nullptr;
+    }
+    const size_t mappedBytes = SkAlignTo(bytes, static_cast<size_t>(pageSize));
+    void* addr = mmap(nullptr, mappedBytes, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (addr == MAP_FAILED) {
+        return nullptr;
+    }
+    return std::unique_ptr<SkPurgeablePages>(
+            new SkPurgeablePages(addr, mappedBytes, static_cast<size_t>(pageSize)));
+}
+
+SkPurgeablePages::~SkPurgeablePages() {
+    munmap(fAddr, fMappedBytes);
+}
+
+void SkPurgeablePages::unlock() {
+    char* page = static_cast<char*>(fAddr);
+    for (size_t i = 0; i < fMappedBytes / fPageSize; ++i, page += fPageSize) {
+        uint64_t* word = reinterpret_cast<uint64_t*>(page);
+        fSavedWords[i] = *word;
+        *word = kCookie;
+    }
+    if (madvise(fAddr, fMappedBytes, MADV_FREE) != 0) {
+        gMadvFreeWorks.store(false, std::memory_order_relaxed);
+    }
+}
+
+bool SkPurgeablePages::lock() {
+    bool intact = true;
+    char* page = static_cast<char*>(fAddr);
+    for (size_t i = 0; i < fMappedBytes / fPageSize; ++i, page += fPageSize) {
+        // Reading and writing the word in one step means the write is to the page we checked.
+        uint64_t* word = reinterpret_cast<uint64_t*>(page);
+        intact &= __atomic_exchange_n(word, fSavedWords[i], __ATOMIC_RELAXED) == kCookie;
+    }
+    return intact;
+}
+
+#else
+
+std::unique_ptr<SkPurgeablePages> SkPurgeablePages::Make(size_t) { return nullptr; }
+
+SkPurgeablePages::~SkPurgeablePages() = default;
+void SkPurgeablePages::unlock() {}
+bool SkPurgeablePages::lock() { return true; }
+
+#endif  // SK_PURGEABLE_PAGES_SUPPORTED
@@ -0,0 +1,51 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkPurgeablePages_DEFINED
+#define SkPurgeablePages_DEFINED
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/**
+ *  Page-aligned memory that the kernel may reclaim while it is unlocked, instead of swapping it
+ *  out, so an unlocked cache entry costs nothing under memory pressure. Implemented with
+ *  madvise(MADV_FREE) on Linux and Android.
+ *
+ *  A page the kernel reclaimed reads back as zeros, so unlock() saves the first word of each page
+ *  and replaces it with a non-zero cookie. lock() swaps each saved word back atomically; a page
+ *  that no longer has its cookie was reclaimed. The swap writes to the page, which stops the
+ *  kernel from reclaiming it afterwards.
+ */
+class SkPurgeablePages {
+public:
+    // Returns null if this platform can't purge pages, or if the memory can't be mapped. The memory
+    // starts out locked and zeroed.
+    static std::unique_ptr<SkPurgeablePages> Make(size_t bytes);
+
+    ~SkPurgeablePages();
+
+    void* data() const { return fAddr; }
+
+    // Lets the kernel reclaim the pages until lock() is called. Must be locked.
+    void unlock();
+
+    // Locks the memory again. Returns false if the kernel reclaimed any of it, in which case its
+    // contents are lost (though it is still locked and usable).
+    bool lock();
+
+private:
+    SkPurgeablePages(void* addr, size_t mappedBytes, size_t pageSize);
+
+    void*                       fAddr;
+    size_t                      fMappedBytes;
+    size_t                      fPageSize;
+    std::unique_ptr<uint64_t[]> fSavedWords;  // the first word of each page, while unlocked
+};
+
+#endif  // SkPurgeablePages_DEFINED
@@ -19,6 +19,29 @@
 // To keep Skia resistant to timing attacks, it's important not to branch on pixel data.
 // In particular, don't be tempted to [v]ptest, pmovmskb, etc. to branch on the source alpha.
 
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SKX
+    #include <immintrin.h>
+
+    // The same math as SkPMSrcOver_AVX2() below, on 16 pixels at a time.
+    static inline __m512i SkPMSrcOver_SKX(const __m512i& src, const __m512i& dst) {
+        const int _ = -1;   // fills a literal 0 byte.
+        __m512i srcA_x2 = _mm512_shuffle_epi8(src,
+                _mm512_broadcast_i32x4(_mm_setr_epi8(3,_,3,_, 7,_,7,_, 11,_,11,_, 15,_,15,_)));
+        __m512i scale_x2 = _mm512_sub_epi16(_mm512_set1_epi16(256),
+                                            srcA_x2);
+
+        __m512i rb = _mm512_and_si512(_mm512_set1_epi32(0x00ff00ff), dst);
+        rb = _mm512_mullo_epi16(rb, scale_x2);
+        rb = _mm512_srli_epi16 (rb, 8);
+
+        __m512i ga = _mm512_srli_epi16(dst, 8);
+        ga = _mm512_mullo_epi16(ga, scale_x2);
+        ga = _mm512_andnot_si512(_mm512_set1_epi32(0x00ff00ff), ga);
+
+        return _mm512_adds_epu8(src, _mm512_or_si512(rb, ga));
+    }
+#endif
+
 #if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX2
     #include <immintrin.h>
 
@@ -97,6 +120,26 @@
         return vraddhn_u16(prod, vrshrq_n_u16(prod, 8));
     }
 
+#if defined(SK_CPU_ARM64)
+    // As SkMulDiv255Round_neon8(), on 16 lanes. vmull_high_u8() is AArch64-only.
+    static inline uint8x16_t SkMulDiv255Round_neon16(uint8x16_t x, uint8x16_t y) {
+        uint16x8_t lo = vmull_u8(vget_low_u8(x), vget_low_u8(y)),
+                   hi = vmull_high_u8(x, y);
+        return vraddhn_high_u16(vraddhn_u16(lo, vrshrq_n_u16(lo, 8)),
+                                hi, vrshrq_n_u16(hi, 8));
+    }
+
+    static inline uint8x16x4_t SkPMSrcOver_neon16(uint8x16x4_t dst, uint8x16x4_t src) {
+        uint8x16_t nalphas = vmvnq_u8(src.val[3]);  // 256 - alpha
+        return {
+            vqaddq_u8(src.val[0], SkMulDiv255Round_neon16(nalphas, dst.val[0])),
+            vqaddq_u8(src.val[1], SkMulDiv255Round_neon16(nalphas, dst.val[1])),
+            vqaddq_u8(src.val[2], SkMulDiv255Round_neon16(nalphas, dst.val[2])),
+            vqaddq_u8(src.val[3], SkMulDiv255Round_neon16(nalphas, dst.val[3])),
+        };
+    }
+#endif
+
     static inline uint8x8x4_t SkPMSrcOver_neon8(uint8x8x4_t dst, uint8x8x4_t src) {
         uint8x8_t nalphas = vmvn_u8(src.val[3]);  // 256 - alpha
         return {
@@ -165,6 +208,16 @@ inline void blit_row_s32a_opaque(SkPMColor* dst, const SkPMColor* src, int len,
     SkASSERT(alpha == 0xFF);
     sk_msan_assert_initialized(src, src+len);
 
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SKX
+    while (len >= 16) {
+        _mm512_storeu_si512(dst, SkPMSrcOver_SKX(_mm512_loadu_si512(src),
+                                                 _mm512_loadu_si512(dst)));
+        src += 16;
+        dst += 16;
+        len -= 16;
+    }
+#endif
+
 #if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX2
     while (len >= 8) {
         _mm256_storeu_si256((__m256i*)dst,
@@ -186,6 +239,16 @@ inline void blit_row_s32a_opaque(SkPMColor* dst, const SkPMColor* src, int len,
     }
 #endif
 
+#if defined(SK_ARM_HAS_NEON) && defined(SK_CPU_ARM64)
+    while (len >= 16) {
+        vst4q_u8((uint8_t*)dst, SkPMSrcOver_neon16(vld4q_u8((const uint8_t*)dst),
+                                                   vld4q_u8((const uint8_t*)src)));
+        src += 16;
+        dst += 16;
+        len -= 16;
+    }
+#endif
+
 #if defined(SK_ARM_HAS_NEON)
     while (len >= 8) {
         vst4_u8((uint8_t*)dst, SkPMSrcOver_neon8(vld4_u8((const uint8_t*)dst),
@@ -241,7 +304,11 @@ inline void blit_row_s32a_opaque(SkPMColor* dst, const SkPMColor* src, int len,
 // Blend constant color over count dst pixels
 /*not static*/
 inline void blit_row_color32(SkPMColor* dst, int count, SkPMColor color) {
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SKX
+    constexpr int N = 16;  // One 512-bit register of pixels.
+#else
     constexpr int N = 4;  // 8, 16 also reasonable choices
+#endif
     using U32 = skvx::Vec<  N, uint32_t>;
     using U16 = skvx::Vec<4*N, uint16_t>;
     using U8  = skvx::Vec<4*N, uint8_t>;
@@ -0,0 +1,116 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkCurveBatch_opts_DEFINED
+#define SkCurveBatch_opts_DEFINED
+
+#include "src/base/SkVx.h"
+
+#include <algorithm>
+
+namespace SK_OPTS_NS {
+
+// Each kernel handles 8 curves per iteration, one per lane, then finishes the tail one curve at a
+// time with the same code on 1-lane vectors.
+template <int N>
+static void cubic_wangs_formula_p4_n(float lengthTerm, const float m[4],
+                                     const float* const x[4], const float* const y[4],
+                                     int i, float n4[]) {
+    using F = skvx::Vec<N, float>;
+    const F x0 = F::Load(x[0] + i), x1 = F::Load(x[1] + i),
+            x2 = F::Load(x[2] + i), x3 = F::Load(x[3] + i);
+    const F y0 = F::Load(y[0] + i), y1 = F::Load(y[1] + i),
+            y2 = F::Load(y[2] + i), y3 = F::Load(y[3] + i);
+    const F vx0 = -2*x1 + x0 + x2, vy0 = -2*y1 + y0 + y2;
+    const F vx1 = -2*x2 + x1 + x3, vy1 = -2*y2 + y1 + y3;
+    const F tx0 = m[0]*vx0 + m[2]*vy0, ty0 = m[1]*vx0 + m[3]*vy0;
+    const F tx1 = m[0]*vx1 + m[2]*vy1, ty1 = m[1]*vx1 + m[3]*vy1;
+    (max(tx0*tx0 + ty0*ty0, tx1*tx1 + ty1*ty1) * lengthTerm).store(n4 + i);
+}
+
+static void cubic_wangs_formula_p4(float lengthTerm, const float m[4],
+                                   const float* const x[4], const float* const y[4],
+                                   int count, float n4[]) {
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        cubic_wangs_formula_p4_n<8>(lengthTerm, m, x, y, i, n4);
+    }
+    for (; i < count; ++i) {
+        cubic_wangs_formula_p4_n<1>(lengthTerm, m, x, y, i, n4);
+    }
+}
+
+template <int N>
+static void quadratic_wangs_formula_p4_n(float lengthTerm, const float m[4],
+                                         const float* const x[3], const float* const y[3],
+                                         int i, float n4[]) {
+    using F = skvx::Vec<N, float>;
+    const F x0 = F::Load(x[0] + i), x1 = F::Load(x[1] + i), x2 = F::Load(x[2] + i);
+    const F y0 = F::Load(y[0] + i), y1 = F::Load(y[1] + i), y2 = F::Load(y[2] + i);
+    const F vx = -2*x1 + x0 + x2, vy = -2*y1 + y0 + y2;
+    const F tx = m[0]*vx + m[2]*vy, ty = m[1]*vx + m[3]*vy;
+    ((tx*tx + ty*ty) * lengthTerm).store(n4 + i);
+}
+
+static void quadratic_wangs_formula_p4(float lengthTerm, const float m[4],
+                                       const float* const x[3], const float* const y[3],
+                                       int count, float n4[]) {
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        quadratic_wangs_formula_p4_n<8>(lengthTerm, m, x, y, i, n4);
+    }
+    for (; i < count; ++i) {
+        quadratic_wangs_formula_p4_n<1>(lengthTerm, m, x, y, i, n4);
+    }
+}
+
+// De Casteljau on one coordinate, with the arithmetic of SkChopCubicAt(). That exits early when
+// t == 1, which gives the same points as mixing with an exact b at t == 1.
+template <int N>
+static void chop_cubic_coords_n(const float* const src[4], const skvx::Vec<N, float>& t,
+                                const skvx::Vec<N, int>& tIsOne, int i, float* const dst[7]) {
+    using F = skvx::Vec<N, float>;
+    auto mix = [&](const F& a, const F& b) {
+        return skvx::if_then_else(tIsOne, b, (b - a)*t + a);
+    };
+    const F p0 = F::Load(src[0] + i), p1 = F::Load(src[1] + i),
+            p2 = F::Load(src[2] + i), p3 = F::Load(src[3] + i);
+    const F ab = mix(p0, p1), bc = mix(p1, p2), cd = mix(p2, p3);
+    const F abc = mix(ab, bc), bcd = mix(bc, cd);
+    const F abcd = mix(abc, bcd);
+    p0.store(dst[0] + i);
+    ab.store(dst[1] + i);
+    abc.store(dst[2] + i);
+    abcd.store(dst[3] + i);
+    bcd.store(dst[4] + i);
+    cd.store(dst[5] + i);
+    p3.store(dst[6] + i);
+}
+
+template <int N>
+static void chop_cubics_at_n(const float* const x[4], const float* const y[4], const float t[],
+                             int i, float* const dstX[7], float* const dstY[7]) {
+    const auto T = skvx::Vec<N, float>::Load(t + i);
+    const auto tIsOne = T == 1;
+    chop_cubic_coords_n<N>(x, T, tIsOne, i, dstX);
+    chop_cubic_coords_n<N>(y, T, tIsOne, i, dstY);
+}
+
+static void chop_cubics_at(const float* const x[4], const float* const y[4], const float t[],
+                           int count, float* const dstX[7], float* const dstY[7]) {
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        chop_cubics_at_n<8>(x, y, t, i, dstX, dstY);
+    }
+    for (; i < count; ++i) {
+        chop_cubics_at_n<1>(x, y, t, i, dstX, dstY);
+    }
+}
+
+}  // namespace SK_OPTS_NS
+
+#endif  // SkCurveBatch_opts_DEFINED
@@ -0,0 +1,247 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkDistanceFieldGen_opts_DEFINED
+#define SkDistanceFieldGen_opts_DEFINED
+
+#include "include/private/base/SkFeatures.h"
+#include "src/base/SkVx.h"
+#include "src/core/SkDistanceFieldGen.h"
+
+#include <cstdint>
+
+#if !defined(SK_DISABLE_SDF_TEXT)
+
+// These are the parts of SkDistanceFieldGen.cpp that can be done for every pixel of a row at
+// once: finding the edges of the glyph, unpacking its alpha, packing the distances, and the
+// parts of Danielsson's 8SSEDT that only look at the row above or below the one being updated.
+//
+// In the distance transform,
+// each candidate is the neighbor's vector to its nearest edge, moved by the offset to the
+// neighbor, and its squared length computed from the neighbor's. The arithmetic avoids
+// multiplies so that no target fuses it differently, and every target gives the same result.
+//
+// A candidate replaces the current value only if it is strictly nearer, so an earlier candidate
+// wins a tie; the order of the candidates below is the order SkDistanceFieldGen.cpp relies on.
+
+namespace SK_OPTS_NS {
+
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX2
+    static constexpr int kDistanceFieldLanes = 8;
+#else
+    static constexpr int kDistanceFieldLanes = 4;
+#endif
+
+template <typename F>
+static inline F df_twice(F x) { return x + x; }
+
+// The candidates from the upper left, upper and upper right neighbors.
+template <typename F, typename Keep>
+static inline void df_nearest_above(F ulD, F ulX, F ulY,
+                                    F uD, F uX, F uY,
+                                    F urD, F urX, F urY,
+                                    F* d, F* x, F* y, Keep keep) {
+    F candD = ulD - df_twice(ulX + ulY - 1.0f);
+    keep(candD < *d, candD, ulX - 1.0f, ulY - 1.0f, d, x, y);
+
+    candD = uD - df_twice(uY) + 1.0f;
+    keep(candD < *d, candD, uX, uY - 1.0f, d, x, y);
+
+    candD = urD + df_twice(urX - urY + 1.0f);
+    keep(candD < *d, candD, urX + 1.0f, urY - 1.0f, d, x, y);
+}
+
+// The nearest of the candidates from the lower left, lower and lower right neighbors.
+template <typename F, typename Keep>
+static inline void df_nearest_below(F blD, F blX, F blY,
+                                    F bD, F bX, F bY,
+                                    F brD, F brX, F brY,
+                                    F* d, F* x, F* y, Keep keep) {
+    *d = blD - df_twice(blX - blY - 1.0f);
+    *x = blX - 1.0f;
+    *y = blY + 1.0f;
+
+    F candD = bD + df_twice(bY) + 1.0f;
+    keep(candD < *d, candD, bX, bY + 1.0f, d, x, y);
+
+    candD = brD + df_twice(brX + brY + 1.0f);
+    keep(candD < *d, candD, brX + 1.0f, brY + 1.0f, d, x, y);
+}
+
+static inline void df_keep_scalar(bool nearer, float candD, float candX, float candY,
+                                  float* d, float* x, float* y) {
+    if (nearer) {
+        *d = candD;
+        *x = candX;
+        *y = candY;
+    }
+}
+
+// We treat an "edge" as a place where we cross from >=128 to <128, or vice versa, or
+// where we have two non-zero pixels that are <128.
+template <typename U8>
+static inline U8 df_crosses_edge(U8 curr, U8 neighbor) {
+    return ((curr ^ neighbor) >= 0x80) | (((curr - 1) < 127) & ((neighbor - 1) < 127));
+}
+
+template <typename F, typename U8>
+static inline F df_alpha(U8 image) {
+    // 255 is exactly 1, which the multiply would not give.
+    return skvx::if_then_else(skvx::cast<int32_t>(image) == 255,
+                              F(1.0f), skvx::cast<float>(image) * 0.00392156862f);  // 1/255
+}
+
+static void distance_field_find_edges(const uint8_t* above, const uint8_t* row,
+                                      const uint8_t* below, float* alpha, uint8_t* edges,
+                                      int count) {
+    using F = skvx::Vec<kDistanceFieldLanes, float>;
+    using U8 = skvx::Vec<kDistanceFieldLanes, uint8_t>;
+
+    int i = 0;
+    for (; i + kDistanceFieldLanes <= count; i += kDistanceFieldLanes) {
+        const U8 curr = U8::Load(row + i);
+        const U8 edge = df_crosses_edge(curr, U8::Load(row + i - 1)) |
+                        df_crosses_edge(curr, U8::Load(row + i + 1)) |
+                        df_crosses_edge(curr, U8::Load(above + i - 1)) |
+                        df_crosses_edge(curr, U8::Load(above + i)) |
+                        df_crosses_edge(curr, U8::Load(above + i + 1)) |
+                        df_crosses_edge(curr, U8::Load(below + i - 1)) |
+                        df_crosses_edge(curr, U8::Load(below + i)) |
+                        df_crosses_edge(curr, U8::Load(below + i + 1));
+        // using 255 makes for convenient debug rendering
+        edge.store(edges + i);
+        df_alpha<F>(curr).store(alpha + i);
+    }
+    for (; i < count; ++i) {
+        using U1 = skvx::Vec<1, uint8_t>;
+        const U1 curr = row[i];
+        const U1 edge = df_crosses_edge(curr, U1(row[i - 1])) |
+                        df_crosses_edge(curr, U1(row[i + 1])) |
+                        df_crosses_edge(curr, U1(above[i - 1])) |
+                        df_crosses_edge(curr, U1(above[i])) |
+                        df_crosses_edge(curr, U1(above[i + 1])) |
+                        df_crosses_edge(curr, U1(below[i - 1])) |
+                        df_crosses_edge(curr, U1(below[i])) |
+                        df_crosses_edge(curr, U1(below[i + 1]));
+        edges[i] = edge[0];
+        alpha[i] = df_alpha<skvx::Vec<1, float>>(curr)[0];
+    }
+}
+
+// The zero value is at 128, with 128 values in [0, 128) but only 127 in (128, 255], so the
+// distances are limited to (-SK_DistanceFieldMagnitude, SK_DistanceFieldMagnitude * 127/128].
+template <int N>
+static inline skvx::Vec<N, uint8_t> df_pack(skvx::Vec<N, float> distSq,
+                                            skvx::Vec<N, float> alpha) {
+    using F = skvx::Vec<N, float>;
+    constexpr float kMagnitude = SK_DistanceFieldMagnitude;
+    F dist = skvx::sqrt(distSq);
+    dist = skvx::if_then_else(alpha > 0.5f, -dist, dist);
+    dist = skvx::max(F(-kMagnitude), skvx::min(-dist, F(kMagnitude * 127.0f / 128.0f)));
+    dist += kMagnitude;
+    // The values are never negative, so truncating rounds them as SkScalarRoundToInt() would.
+    return skvx::cast<uint8_t>(skvx::cast<int32_t>(dist / (2 * kMagnitude) * 256.0f + 0.5f));
+}
+
+static void distance_field_pack(const float* distSq, const float* alpha, uint8_t* distanceField,
+                                int count) {
+    using F = skvx::Vec<kDistanceFieldLanes, float>;
+    int i = 0;
+    for (; i + kDistanceFieldLanes <= count; i += kDistanceFieldLanes) {
+        df_pack(F::Load(distSq + i), F::Load(alpha + i)).store(distanceField + i);
+    }
+    for (; i < count; ++i) {
+        using F1 = skvx::Vec<1, float>;
+        distanceField[i] = df_pack(F1(distSq[i]), F1(alpha[i]))[0];
+    }
+}
+
+static void distance_field_nearest_above(SkDistanceFieldRow row, SkDistanceFieldRow above,
+                                         const uint8_t* edges, int count) {
+    using F = skvx::Vec<kDistanceFieldLanes, float>;
+    using I = skvx::Vec<kDistanceFieldLanes, int32_t>;
+    using B = skvx::Vec<kDistanceFieldLanes, uint8_t>;
+    auto keep = [](I nearer, F candD, F candX, F candY, F* d, F* x, F* y) {
+        *d = skvx::if_then_else(nearer, candD, *d);
+        *x = skvx::if_then_else(nearer, candX, *x);
+        *y = skvx::if_then_else(nearer, candY, *y);
+    };
+
+    int i = 0;
+    for (; i + kDistanceFieldLanes <= count; i += kDistanceFieldLanes) {
+        F d = F::Load(row.fDistSq + i),
+          x = F::Load(row.fX + i),
+          y = F::Load(row.fY + i);
+        const F oldD = d;
+        df_nearest_above(F::Load(above.fDistSq + i - 1),
+                         F::Load(above.fX + i - 1),
+                         F::Load(above.fY + i - 1),
+                         F::Load(above.fDistSq + i),
+                         F::Load(above.fX + i),
+                         F::Load(above.fY + i),
+                         F::Load(above.fDistSq + i + 1),
+                         F::Load(above.fX + i + 1),
+                         F::Load(above.fY + i + 1),
+                         &d, &x, &y, keep);
+        // Edge pixels keep the distances they started with.
+        const I notEdge = skvx::cast<int32_t>(B::Load(edges + i)) == 0;
+        if (any(notEdge & (d < oldD))) {
+            skvx::if_then_else(notEdge, d, oldD).store(row.fDistSq + i);
+            skvx::if_then_else(notEdge, x, F::Load(row.fX + i)).store(row.fX + i);
+            skvx::if_then_else(notEdge, y, F::Load(row.fY + i)).store(row.fY + i);
+        }
+    }
+    for (; i < count; ++i) {
+        if (!edges[i]) {
+            df_nearest_above(above.fDistSq[i - 1], above.fX[i - 1], above.fY[i - 1],
+                             above.fDistSq[i], above.fX[i], above.fY[i],
+                             above.fDistSq[i + 1], above.fX[i + 1], above.fY[i + 1],
+                             row.fDistSq + i, row.fX + i, row.fY + i, df_keep_scalar);
+        }
+    }
+}
+
+static void distance_field_nearest_below(SkDistanceFieldRow nearest, SkDistanceFieldRow below,
+                                         int count) {
+    using F = skvx::Vec<kDistanceFieldLanes, float>;
+    using I = skvx::Vec<kDistanceFieldLanes, int32_t>;
+    auto keep = [](I nearer, F candD, F candX, F candY, F* d, F* x, F* y) {
+        *d = skvx::if_then_else(nearer, candD, *d);
+        *x = skvx::if_then_else(nearer, candX, *x);
+        *y = skvx::if_then_else(nearer, candY, *y);
+    };
+
+    int i = 0;
+    for (; i + kDistanceFieldLanes <= count; i += kDistanceFieldLanes) {
+        F d, x, y;
+        df_nearest_below(F::Load(below.fDistSq + i - 1),
+                         F::Load(below.fX + i - 1),
+                         F::Load(below.fY + i - 1),
+                         F::Load(below.fDistSq + i),
+                         F::Load(below.fX + i),
+                         F::Load(below.fY + i),
+                         F::Load(below.fDistSq + i + 1),
+                         F::Load(below.fX + i + 1),
+                         F::Load(below.fY + i + 1),
+                         &d, &x, &y, keep);
+        d.store(nearest.fDistSq + i);
+        x.store(nearest.fX + i);
+        y.store(nearest.fY + i);
+    }
+    for (; i < count; ++i) {
+        df_nearest_below(below.fDistSq[i - 1], below.fX[i - 1], below.fY[i - 1],
+                         below.fDistSq[i], below.fX[i], below.fY[i],
+                         below.fDistSq[i + 1], below.fX[i + 1], below.fY[i + 1],
+                         nearest.fDistSq + i, nearest.fX + i, nearest.fY + i, df_keep_scalar);
+    }
+}
+
+}  // namespace SK_OPTS_NS
+
+#endif  // !defined(SK_DISABLE_SDF_TEXT)
+
+#endif  // SkDistanceFieldGen_opts_DEFINED
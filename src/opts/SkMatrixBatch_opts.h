@@ -0,0 +1,132 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkMatrixBatch_opts_DEFINED
+#define SkMatrixBatch_opts_DEFINED
+
+#include "include/core/SkMatrix.h"
+#include "include/core/SkPoint.h"
+#include "include/core/SkPoint3.h"
+#include "include/core/SkRect.h"
+#include "include/private/base/SkFloatingPoint.h"
+#include "src/base/SkVx.h"
+
+namespace SK_OPTS_NS {
+
+// The point kernels work on 8 points at a time, which is one register on SKX, two on HSW and four
+// on SSE2 and NEON, and then finish the tail one point at a time. The per-point arithmetic is
+// that of SkMatrix::Affine_vpts() and SkMatrix::Persp_xy().
+
+static void map_points_affine(const float affine[6], const SkPoint src[], int count,
+                              SkPoint dst[]) {
+    const float sx = affine[SkMatrix::kAScaleX], ky = affine[SkMatrix::kASkewY],
+                kx = affine[SkMatrix::kASkewX],  sy = affine[SkMatrix::kAScaleY],
+                tx = affine[SkMatrix::kATransX], ty = affine[SkMatrix::kATransY];
+    using float16 = skvx::Vec<16, float>;
+    const skvx::float2 scale2{sx, sy}, skew2{kx, ky}, trans2{tx, ty};
+    const skvx::float4 scale4 = skvx::join(scale2, scale2),
+                       skew4  = skvx::join(skew2, skew2),
+                       trans4 = skvx::join(trans2, trans2);
+    const skvx::float8 scale8 = skvx::join(scale4, scale4),
+                       skew8  = skvx::join(skew4, skew4),
+                       trans8 = skvx::join(trans4, trans4);
+    const float16 scale = skvx::join(scale8, scale8),
+                  skew  = skvx::join(skew8, skew8),
+                  trans = skvx::join(trans8, trans8);
+
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const float16 p = float16::Load(src + i);
+        const float16 swz = skvx::shuffle<1,0, 3,2, 5,4, 7,6, 9,8, 11,10, 13,12, 15,14>(p);
+        (p * scale + swz * skew + trans).store(dst + i);
+    }
+    for (; i < count; ++i) {
+        const skvx::float2 p = skvx::float2::Load(src + i);
+        (p * scale2 + skvx::shuffle<1,0>(p) * skew2 + trans2).store(dst + i);
+    }
+}
+
+template <int N>
+static void map_points_homogeneous_n(const float mat[9], const SkPoint src[],
+                                     skvx::Vec<N, float>* x, skvx::Vec<N, float>* y,
+                                     skvx::Vec<N, float>* w) {
+    skvx::Vec<N, float> sx, sy;
+    skvx::strided_load2(&src->fX, sx, sy);
+    *x = sx * mat[SkMatrix::kMScaleX] + sy * mat[SkMatrix::kMSkewX]  + mat[SkMatrix::kMTransX];
+    *y = sx * mat[SkMatrix::kMSkewY]  + sy * mat[SkMatrix::kMScaleY] + mat[SkMatrix::kMTransY];
+    *w = sx * mat[SkMatrix::kMPersp0] + sy * mat[SkMatrix::kMPersp1] + mat[SkMatrix::kMPersp2];
+}
+
+template <int N>
+static void map_points_persp_n(const float mat[9], const SkPoint src[], SkPoint dst[]) {
+    skvx::Vec<N, float> x, y, w;
+    map_points_homogeneous_n<N>(mat, src, &x, &y, &w);
+    w = skvx::if_then_else(w != 0, 1 / w, skvx::Vec<N, float>(0));
+    x *= w;
+    y *= w;
+    for (int j = 0; j < N; ++j) {
+        dst[j] = {x[j], y[j]};
+    }
+}
+
+static void map_points_persp(const float mat[9], const SkPoint src[], int count, SkPoint dst[]) {
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        map_points_persp_n<8>(mat, src + i, dst + i);
+    }
+    for (; i < count; ++i) {
+        map_points_persp_n<1>(mat, src + i, dst + i);
+    }
+}
+
+template <int N>
+static void map_points_homogeneous_n(const float mat[9], const SkPoint src[], SkPoint3 dst[]) {
+    skvx::Vec<N, float> x, y, w;
+    map_points_homogeneous_n<N>(mat, src, &x, &y, &w);
+    for (int j = 0; j < N; ++j) {
+        dst[j] = {x[j], y[j], w[j]};
+    }
+}
+
+static void map_points_homogeneous(const float mat[9], const SkPoint src[], int count,
+                                   SkPoint3 dst[]) {
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        map_points_homogeneous_n<8>(mat, src + i, dst + i);
+    }
+    for (; i < count; ++i) {
+        map_points_homogeneous_n<1>(mat, src + i, dst + i);
+    }
+}
+
+// Each rect is mapped as its four corners, with x and y in one float8: L T, R T, L B, R B.
+static void map_rects_affine(const float affine[6], const SkRect src[], int count, SkRect dst[]) {
+    const float sx = affine[SkMatrix::kAScaleX], ky = affine[SkMatrix::kASkewY],
+                kx = affine[SkMatrix::kASkewX],  sy = affine[SkMatrix::kAScaleY],
+                tx = affine[SkMatrix::kATransX], ty = affine[SkMatrix::kATransY];
+    const skvx::float8 scale{sx, sy, sx, sy, sx, sy, sx, sy},
+                       skew {kx, ky, kx, ky, kx, ky, kx, ky},
+                       trans{tx, ty, tx, ty, tx, ty, tx, ty};
+    for (int i = 0; i < count; ++i) {
+        const skvx::float4 ltrb = skvx::float4::Load(&src[i]);
+        const skvx::float8 p = skvx::shuffle<0,1, 2,1, 0,3, 2,3>(ltrb);
+        const skvx::float8 swz = skvx::shuffle<1,0, 3,2, 5,4, 7,6>(p);
+        const skvx::float8 m = p * scale + swz * skew + trans;
+        const skvx::float4 lo = skvx::min(m.lo, m.hi), hi = skvx::max(m.lo, m.hi);
+        const skvx::float2 mn = skvx::min(lo.lo, lo.hi), mx = skvx::max(hi.lo, hi.hi);
+        // Like SkRect::setBoundsNoCheck(), a non-finite corner makes the whole rect NaN.
+        if (all(m * 0 == 0)) {
+            skvx::join(mn, mx).store(&dst[i]);
+        } else {
+            dst[i].setLTRB(SK_FloatNaN, SK_FloatNaN, SK_FloatNaN, SK_FloatNaN);
+        }
+    }
+}
+
+}  // namespace SK_OPTS_NS
+
+#endif  // SkMatrixBatch_opts_DEFINED
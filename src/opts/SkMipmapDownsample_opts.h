@@ -0,0 +1,95 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkMipmapDownsample_opts_DEFINED
+#define SkMipmapDownsample_opts_DEFINED
+
+#include "src/base/SkUtils.h"
+#include "src/base/SkVx.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace SK_OPTS_NS {
+
+// The vector loops filter 8 dst pixels at a time. The 16 (or 17) source pixels of each row are
+// split into their even and odd columns and widened to 16 bits per channel, which holds the
+// filter sums exactly, so the results are bit-identical to the one pixel at a time tail.
+static constexpr int kMipmapDownsampleN = 8;
+
+using MipmapPixels = skvx::Vec<2 * kMipmapDownsampleN, uint32_t>;
+using MipmapWide   = skvx::Vec<4 * kMipmapDownsampleN, uint16_t>;
+
+static inline MipmapWide mipmap_widen(const skvx::Vec<kMipmapDownsampleN, uint32_t>& px) {
+    return skvx::cast<uint16_t>(
+            sk_bit_cast<skvx::Vec<4 * kMipmapDownsampleN, uint8_t>>(px));
+}
+static inline MipmapWide mipmap_even(const MipmapPixels& px) {
+    return mipmap_widen(skvx::shuffle<0, 2, 4, 6, 8, 10, 12, 14>(px));
+}
+static inline MipmapWide mipmap_odd(const MipmapPixels& px) {
+    return mipmap_widen(skvx::shuffle<1, 3, 5, 7, 9, 11, 13, 15>(px));
+}
+
+static inline skvx::Vec<4, uint16_t> mipmap_expand(const uint32_t* px) {
+    return skvx::cast<uint16_t>(skvx::byte4::Load(px));
+}
+static inline uint32_t mipmap_compact(const skvx::Vec<4, uint16_t>& c) {
+    uint32_t r;
+    skvx::cast<uint8_t>(c).store(&r);
+    return r;
+}
+
+static void mipmap_downsample_2_2_8888(void* dst, const void* src, size_t srcRB, int count) {
+    auto p0 = static_cast<const uint32_t*>(src);
+    auto p1 = reinterpret_cast<const uint32_t*>(static_cast<const char*>(src) + srcRB);
+    auto d  = static_cast<uint32_t*>(dst);
+
+    int i = 0;
+    for (; i + kMipmapDownsampleN <= count; i += kMipmapDownsampleN) {
+        const MipmapPixels r0 = MipmapPixels::Load(p0 + 2 * i),
+                           r1 = MipmapPixels::Load(p1 + 2 * i);
+        const MipmapWide sum = mipmap_even(r0) + mipmap_odd(r0) + mipmap_even(r1) + mipmap_odd(r1);
+        skvx::cast<uint8_t>(sum >> 2).store(d + i);
+    }
+    for (; i < count; ++i) {
+        const auto sum = mipmap_expand(p0 + 2 * i) + mipmap_expand(p0 + 2 * i + 1) +
+                         mipmap_expand(p1 + 2 * i) + mipmap_expand(p1 + 2 * i + 1);
+        d[i] = mipmap_compact(sum >> 2);
+    }
+}
+
+static void mipmap_downsample_3_3_8888(void* dst, const void* src, size_t srcRB, int count) {
+    auto p0 = static_cast<const uint32_t*>(src);
+    auto p1 = reinterpret_cast<const uint32_t*>(static_cast<const char*>(src) + srcRB);
+    auto p2 = reinterpret_cast<const uint32_t*>(static_cast<const char*>(src) + 2 * srcRB);
+    auto d  = static_cast<uint32_t*>(dst);
+
+    // Each dst pixel reads source columns 2i, 2i+1 and 2i+2. The second load of a row starts two
+    // pixels in so its even columns are the 2i+2 taps; that reads one pixel past the last tap, so
+    // the vector loop stops while at least one dst pixel is left for the tail.
+    auto row = [](const uint32_t* p) {
+        const MipmapPixels px = MipmapPixels::Load(p), next = MipmapPixels::Load(p + 2);
+        return mipmap_even(px) + (mipmap_odd(px) << 1) + mipmap_even(next);
+    };
+    int i = 0;
+    for (; i + kMipmapDownsampleN < count; i += kMipmapDownsampleN) {
+        const MipmapWide sum = row(p0 + 2 * i) + (row(p1 + 2 * i) << 1) + row(p2 + 2 * i);
+        skvx::cast<uint8_t>(sum >> 4).store(d + i);
+    }
+    auto tap = [](const uint32_t* p) {
+        return mipmap_expand(p) + (mipmap_expand(p + 1) << 1) + mipmap_expand(p + 2);
+    };
+    for (; i < count; ++i) {
+        const auto sum = tap(p0 + 2 * i) + (tap(p1 + 2 * i) << 1) + tap(p2 + 2 * i);
+        d[i] = mipmap_compact(sum >> 4);
+    }
+}
+
+}  // namespace SK_OPTS_NS
+
+#endif  // SkMipmapDownsample_opts_DEFINED
@@ -5,11 +5,17 @@
  * found in the LICENSE file.
  */
 
+#include "src/core/SkBlitMask.h"
+#include "src/core/SkBlitRow.h"
+#include "src/core/SkMatrixBatch.h"
 #include "src/core/SkOpts.h"
 
 #if !defined(SK_ENABLE_OPTIMIZE_SIZE)
 
 #define SK_OPTS_NS skx
+#include "src/opts/SkBlitMask_opts.h"
+#include "src/opts/SkBlitRow_opts.h"
+#include "src/opts/SkMatrixBatch_opts.h"
 #include "src/opts/SkRasterPipeline_opts.h"
 
 namespace SkOpts {
@@ -29,6 +35,22 @@ namespace SkOpts {
         start_pipeline_lowp = SK_OPTS_NS::lowp::start_pipeline;
     #undef M
     }
+
+    void Init_BlitMask_skx() {
+        blit_mask_d32_a8 = SK_OPTS_NS::blit_mask_d32_a8;
+    }
+
+    void Init_BlitRow_skx() {
+        blit_row_color32     = SK_OPTS_NS::blit_row_color32;
+        blit_row_s32a_opaque = SK_OPTS_NS::blit_row_s32a_opaque;
+    }
+
+    void Init_MatrixBatch_skx() {
+        map_points_affine      = SK_OPTS_NS::map_points_affine;
+        map_points_persp       = SK_OPTS_NS::map_points_persp;
+        map_points_homogeneous = SK_OPTS_NS::map_points_homogeneous;
+        map_rects_affine       = SK_OPTS_NS::map_rects_affine;
+    }
 }  // namespace SkOpts
 
 #endif // SK_ENABLE_OPTIMIZE_SIZE
@@ -2716,6 +2716,43 @@ STAGE(byte_tables, const SkRasterPipeline_TablesCtx* tables) {
     a = from_byte(gather(tables->a, to_unorm(a, 255)));
 }
 
+// Finds the LUT entry below `v`, and how far `v` is from it towards the next entry.
+SI U32 lut_3D_coord(F v, float scale, F* t) {
+    F x  = clamp_01_(v) * scale,
+      x0 = min(floor_(x), scale - 1);  // The entry above x0 has to be in the table too.
+    *t = x - x0;
+    return trunc_(x0);
+}
+
+STAGE(lut_3D, const SkRasterPipeline_Lut3DCtx* ctx) {
+    const float scale = (float)(ctx->size - 1);
+    F tr, tg, tb;
+    U32 ir = lut_3D_coord(r, scale, &tr),
+        ig = lut_3D_coord(g, scale, &tg),
+        ib = lut_3D_coord(b, scale, &tb);
+
+    // Each entry is 4 floats; step to the next green and blue entries with these strides.
+    const uint32_t gStride = 4 * ctx->size,
+                   bStride = 4 * ctx->size * ctx->size;
+    U32 ix = 4*ir + gStride*ig + bStride*ib;
+
+    // Trilinear interpolation between the 8 entries around the color, one channel at a time.
+    F rgba[4];
+    for (uint32_t c = 0; c < 4; ++c) {
+        const float* p = ctx->table + c;
+        auto bilerp = [&](U32 plane) {
+            return lerp(lerp(gather(p, plane          ), gather(p, plane           + 4), tr),
+                        lerp(gather(p, plane + gStride), gather(p, plane + gStride + 4), tr),
+                        tg);
+        };
+        rgba[c] = lerp(bilerp(ix), bilerp(ix + bStride), tb);
+    }
+    r = rgba[0] * a;
+    g = rgba[1] * a;
+    b = rgba[2] * a;
+    a = rgba[3] * a;
+}
+
 SI F strip_sign(F x, U32* sign) {
     U32 bits = sk_bit_cast<U32>(x);
     *sign = bits & 0x80000000;
@@ -3468,6 +3505,16 @@ STAGE(evenly_spaced_2_stop_gradient, const SkRasterPipeline_EvenlySpaced2StopGra
     a = mad(t, c->f[3], c->b[3]);
 }
 
+STAGE(gradient_lut, const SkRasterPipeline_GradientLUTCtx* c) {
+    auto t = r;
+    F i = mad(clamp_01_(t), c->scale, 1.5f);
+    i = if_then_else(t < 0, 0.0f, i);
+    i = if_then_else(t > 1, (float)c->lastIndex, i);
+    // The min() keeps NaN t in bounds.
+    U32 idx = min(trunc_(i), U32_(c->lastIndex));
+    from_8888(gather(c->table, idx), &r,&g,&b,&a);
+}
+
 STAGE(xy_to_unit_angle, NoCtx) {
     F X = r,
       Y = g;
@@ -3838,6 +3885,21 @@ STAGE_TAIL(set_base_pointer, std::byte* p) {
     base = p;
 }
 
+// SkSL programs which can also run in lowp use these stages; in highp, they are identical to
+// set_base_pointer, store_src, store_dst and load_src. (See SK_RASTER_PIPELINE_OPS_SKSL_LOWP.)
+STAGE_TAIL(set_lowp_base_pointer, std::byte* p) {
+    base = p;
+}
+STAGE_TAIL(store_src_slots, float* ptr) {
+    store_src_k(ptr, dx,dy,base, r,g,b,a, dr,dg,db,da);
+}
+STAGE_TAIL(store_dst_slots, float* ptr) {
+    store_dst_k(ptr, dx,dy,base, r,g,b,a, dr,dg,db,da);
+}
+STAGE_TAIL(load_src_slots, const float* ptr) {
+    load_src_k(ptr, dx,dy,base, r,g,b,a, dr,dg,db,da);
+}
+
 // All control flow stages used by SkSL maintain some state in the common registers:
 //   r: condition mask
 //   g: loop mask
@@ -4990,8 +5052,42 @@ STAGE(bilerp_clamp_8888, const SkRasterPipeline_GatherCtx* ctx) {
     }
 }
 
-// A specialized fused image shader for clamp-x, clamp-y, non-sRGB sampling.
-STAGE(bicubic_clamp_8888, const SkRasterPipeline_GatherCtx* ctx) {
+// Samples one 8-bit channel of a YUVA plane. (x,y) are in image space; planes that are subsampled
+// relative to the image (e.g. 4:2:0 chroma) are scaled down so their samples stay centered.
+SI F sample_yuva_channel(const SkRasterPipeline_YUVACtx* ctx, int i, F x, F y) {
+    x *= ctx->scaleX[i];
+    y *= ctx->scaleY[i];
+
+    auto fetch = [&](F px, F py) {
+        px = clamp_ex(px, ctx->width [i]);
+        py = clamp_ex(py, ctx->height[i]);
+        U32 ix = trunc_(py)*ctx->stride[i] + trunc_(px)*ctx->bytesPerPixel[i];
+        return from_byte(gather(ctx->pixels[i], ix));
+    };
+
+    if (!ctx->linear) {
+        return fetch(x, y);
+    }
+    F fx = fract(x + 0.5f),
+      fy = fract(y + 0.5f);
+    F top = lerp(fetch(x - 0.5f, y - 0.5f), fetch(x + 0.5f, y - 0.5f), fx),
+      bot = lerp(fetch(x - 0.5f, y + 0.5f), fetch(x + 0.5f, y + 0.5f), fx);
+    return lerp(top, bot, fy);
+}
+
+// Reads Y, U, V and A from their planes into r, g, b and a. A follow-up matrix_4x5 converts to RGB.
+STAGE(sample_yuva, const SkRasterPipeline_YUVACtx* ctx) {
+    F x = r,
+      y = g;
+    r = sample_yuva_channel(ctx, 0, x, y);
+    g = sample_yuva_channel(ctx, 1, x, y);
+    b = sample_yuva_channel(ctx, 2, x, y);
+    a = ctx->pixels[3] ? sample_yuva_channel(ctx, 3, x, y) : F1;
+}
+
+// Specialized fused image shaders for clamp or repeat tiling in both x and y, non-sRGB sampling.
+template <bool kRepeat>
+SI void bicubic_8888(const SkRasterPipeline_GatherCtx* ctx, F& r, F& g, F& b, F& a) {
     // (cx,cy) are the center of our sample.
     F cx = r,
       cy = g;
@@ -5014,6 +5110,9 @@ STAGE(bicubic_clamp_8888, const SkRasterPipeline_GatherCtx* ctx) {
                          bicubic_wts(fx, w[2], w[6], w[10], w[14]),
                          bicubic_wts(fx, w[3], w[7], w[11], w[15])};
 
+    const float invWidth  = 1.0f / ctx->width,
+                invHeight = 1.0f / ctx->height;
+
     F sample_y = cy - 1.5f;
     for (int yy = 0; yy <= 3; ++yy) {
         F sample_x = cx - 1.5f;
@@ -5021,8 +5120,14 @@ STAGE(bicubic_clamp_8888, const SkRasterPipeline_GatherCtx* ctx) {
             F scale = scalex[xx] * scaley[yy];
 
             // ix_and_ptr() will clamp to the image's bounds for us.
+            F sx = sample_x,
+              sy = sample_y;
+            if (kRepeat) {
+                sx = sx - floor_(sx * invWidth ) * ctx->width;
+                sy = sy - floor_(sy * invHeight) * ctx->height;
+            }
             const uint32_t* ptr;
-            U32 ix = ix_and_ptr(&ptr, ctx, sample_x, sample_y);
+            U32 ix = ix_and_ptr(&ptr, ctx, sx, sy);
 
             F sr,sg,sb,sa;
             from_8888(gather(ptr, ix), &sr,&sg,&sb,&sa);
@@ -5038,6 +5143,13 @@ STAGE(bicubic_clamp_8888, const SkRasterPipeline_GatherCtx* ctx) {
     }
 }
 
+STAGE(bicubic_clamp_8888, const SkRasterPipeline_GatherCtx* ctx) {
+    bicubic_8888<false>(ctx, r,g,b,a);
+}
+STAGE(bicubic_repeat_8888, const SkRasterPipeline_GatherCtx* ctx) {
+    bicubic_8888<true>(ctx, r,g,b,a);
+}
+
 // ~~~~~~ skgpu::Swizzle stage ~~~~~~ //
 
 STAGE(swizzle, void* ctx) {
@@ -5059,6 +5171,56 @@ STAGE(swizzle, void* ctx) {
     }
 }
 
+// ~~~~~~ Fused stages ~~~~~~ //
+
+// A fused stage runs the kernels of several consecutive stages without returning to the stage
+// loop in between, reading each stage's context from that stage's own slot in the program. It
+// then jumps past all the slots it replaced. (See SK_RASTER_PIPELINE_OPS_FUSED.)
+#define FUSED_STAGE(name, numStages) \
+    DECLARE_STAGE(name, Ctx ctx, void, program += numStages, /*no offset*/, /*no musttail*/)
+
+#define CALL_FUSED(name, slot) \
+    name##_k(Ctx{ctx.fStage + slot}, dx,dy,base, r,g,b,a, dr,dg,db,da)
+
+FUSED_STAGE(fused_load_8888_dst_srcover_store_8888, 3) {
+    CALL_FUSED(load_8888_dst, 0);
+    CALL_FUSED(srcover,       1);
+    CALL_FUSED(store_8888,    2);
+}
+FUSED_STAGE(fused_load_8888_srcover_store_8888, 4) {
+    CALL_FUSED(load_8888,     0);
+    CALL_FUSED(load_8888_dst, 1);
+    CALL_FUSED(srcover,       2);
+    CALL_FUSED(store_8888,    3);
+}
+FUSED_STAGE(fused_bilerp_clamp_8888_srcover_store_8888, 4) {
+    CALL_FUSED(bilerp_clamp_8888, 0);
+    CALL_FUSED(load_8888_dst,     1);
+    CALL_FUSED(srcover,           2);
+    CALL_FUSED(store_8888,        3);
+}
+FUSED_STAGE(fused_seed_shader_matrix_2x3, 2) {
+    CALL_FUSED(seed_shader, 0);
+    CALL_FUSED(matrix_2x3,  1);
+}
+
+// SkSL programs can be thousands of stages long, so their fused stages tail-call like the rest.
+#define FUSED_STAGE_TAIL(name, numStages) \
+    DECLARE_STAGE(name, Ctx ctx, void, program += numStages, /*no offset*/, JUMPER_MUSTTAIL)
+
+#define DECLARE_SKSL_FUSION(first, second)              \
+    FUSED_STAGE_TAIL(fused_##first##_##second, 2) {     \
+        CALL_FUSED(first,  0);                          \
+        CALL_FUSED(second, 1);                          \
+    }
+
+SK_RASTER_PIPELINE_SKSL_FUSIONS(DECLARE_SKSL_FUSION)
+
+#undef DECLARE_SKSL_FUSION
+#undef FUSED_STAGE_TAIL
+#undef CALL_FUSED
+#undef FUSED_STAGE
+
 namespace lowp {
 #if defined(JUMPER_IS_SCALAR) || defined(SK_ENABLE_OPTIMIZE_SIZE) || \
         defined(SK_BUILD_FOR_GOOGLE3) || defined(SK_DISABLE_LOWP_RASTER_PIPELINE)
@@ -5119,12 +5281,13 @@ static constexpr U16 U16_0   = U16_(0),
 #if JUMPER_NARROW_STAGES
     struct Params {
         size_t dx, dy;
+        std::byte* base;
         U16 dr,dg,db,da;
     };
     using Stage = void (ABI*)(Params*, SkRasterPipelineStage* program, U16 r, U16 g, U16 b, U16 a);
 #else
     using Stage = void (ABI*)(SkRasterPipelineStage* program,
-                              size_t dx, size_t dy,
+                              size_t dx, size_t dy, std::byte* base,
                               U16  r, U16  g, U16  b, U16  a,
                               U16 dr, U16 dg, U16 db, U16 da);
 #endif
@@ -5139,9 +5302,10 @@ static void start_pipeline(size_t x0,     size_t y0,
         tailPointer = &unreferencedTail;
     }
     auto start = (Stage)program->fn;
+    std::byte* const base = nullptr;
     for (size_t dy = y0; dy < ylimit; dy++) {
     #if JUMPER_NARROW_STAGES
-        Params params = { x0,dy, U16_0,U16_0,U16_0,U16_0 };
+        Params params = { x0,dy,base, U16_0,U16_0,U16_0,U16_0 };
         for (; params.dx + N <= xlimit; params.dx += N) {
             start(&params, program, U16_0,U16_0,U16_0,U16_0);
         }
@@ -5155,12 +5319,12 @@ static void start_pipeline(size_t x0,     size_t y0,
     #else
         size_t dx = x0;
         for (; dx + N <= xlimit; dx += N) {
-            start(program, dx,dy, U16_0,U16_0,U16_0,U16_0, U16_0,U16_0,U16_0,U16_0);
+            start(program, dx,dy,base, U16_0,U16_0,U16_0,U16_0, U16_0,U16_0,U16_0,U16_0);
         }
         if (size_t tail = xlimit - dx) {
             *tailPointer = tail;
             patch_memory_contexts(memoryCtxPatches, dx, dy, tail);
-            start(program, dx,dy, U16_0,U16_0,U16_0,U16_0, U16_0,U16_0,U16_0,U16_0);
+            start(program, dx,dy,base, U16_0,U16_0,U16_0,U16_0, U16_0,U16_0,U16_0,U16_0);
             restore_memory_contexts(memoryCtxPatches, dx, dy, tail);
             *tailPointer = 0xFF;
         }
@@ -5171,7 +5335,7 @@ static void start_pipeline(size_t x0,     size_t y0,
 #if JUMPER_NARROW_STAGES
     static void ABI just_return(Params*, SkRasterPipelineStage*, U16,U16,U16,U16) {}
 #else
-    static void ABI just_return(SkRasterPipelineStage*, size_t,size_t,
+    static void ABI just_return(SkRasterPipelineStage*, size_t,size_t, std::byte*,
                                 U16,U16,U16,U16, U16,U16,U16,U16) {}
 #endif
 
@@ -5186,7 +5350,7 @@ static void start_pipeline(size_t x0,     size_t y0,
 // and will have (x,y) geometry and/or (r,g,b,a, dr,dg,db,da) pixel arguments as appropriate.
 
 #if JUMPER_NARROW_STAGES
-    #define STAGE_GG(name, ARG)                                                                \
+    #define DECLARE_STAGE_GG(name, ARG, INC)                                                   \
         SI void name##_k(ARG, size_t dx, size_t dy, F& x, F& y);                               \
         static void ABI name(Params* params, SkRasterPipelineStage* program,                   \
                              U16 r, U16 g, U16 b, U16 a) {                                     \
@@ -5195,12 +5359,13 @@ static void start_pipeline(size_t x0,     size_t y0,
             name##_k(Ctx{program}, params->dx,params->dy, x,y);                                \
             split(x, &r,&g);                                                                   \
             split(y, &b,&a);                                                                   \
-            auto fn = (Stage)(++program)->fn;                                                  \
+            INC;                                                                               \
+            auto fn = (Stage)program->fn;                                                      \
             fn(params, program, r,g,b,a);                                                      \
         }                                                                                      \
         SI void name##_k(ARG, size_t dx, size_t dy, F& x, F& y)
 
-    #define STAGE_GP(name, ARG)                                                            \
+    #define DECLARE_STAGE_GP(name, ARG, INC)                                               \
         SI void name##_k(ARG, size_t dx, size_t dy, F x, F y,                              \
                          U16&  r, U16&  g, U16&  b, U16&  a,                               \
                          U16& dr, U16& dg, U16& db, U16& da);                              \
@@ -5210,14 +5375,15 @@ static void start_pipeline(size_t x0,     size_t y0,
                  y = join<F>(b,a);                                                         \
             name##_k(Ctx{program}, params->dx,params->dy, x,y, r,g,b,a,                    \
                      params->dr,params->dg,params->db,params->da);                         \
-            auto fn = (Stage)(++program)->fn;                                              \
+            INC;                                                                           \
+            auto fn = (Stage)program->fn;                                                  \
             fn(params, program, r,g,b,a);                                                  \
         }                                                                                  \
         SI void name##_k(ARG, size_t dx, size_t dy, F x, F y,                              \
                          U16&  r, U16&  g, U16&  b, U16&  a,                               \
                          U16& dr, U16& dg, U16& db, U16& da)
 
-    #define STAGE_PP(name, ARG)                                                            \
+    #define DECLARE_STAGE_PP(name, ARG, INC)                                               \
         SI void name##_k(ARG, size_t dx, size_t dy,                                        \
                          U16&  r, U16&  g, U16&  b, U16&  a,                               \
                          U16& dr, U16& dg, U16& db, U16& da);                              \
@@ -5225,17 +5391,18 @@ static void start_pipeline(size_t x0,     size_t y0,
                              U16 r, U16 g, U16 b, U16 a) {                                 \
             name##_k(Ctx{program}, params->dx,params->dy, r,g,b,a,                         \
                      params->dr,params->dg,params->db,params->da);                         \
-            auto fn = (Stage)(++program)->fn;                                              \
+            INC;                                                                           \
+            auto fn = (Stage)program->fn;                                                  \
             fn(params, program, r,g,b,a);                                                  \
         }                                                                                  \
         SI void name##_k(ARG, size_t dx, size_t dy,                                        \
                          U16&  r, U16&  g, U16&  b, U16&  a,                               \
                          U16& dr, U16& dg, U16& db, U16& da)
 #else
-    #define STAGE_GG(name, ARG)                                                            \
+    #define DECLARE_STAGE_GG(name, ARG, INC)                                               \
         SI void name##_k(ARG, size_t dx, size_t dy, F& x, F& y);                           \
         static void ABI name(SkRasterPipelineStage* program,                               \
-                             size_t dx, size_t dy,                                         \
+                             size_t dx, size_t dy, std::byte* base,                        \
                              U16  r, U16  g, U16  b, U16  a,                               \
                              U16 dr, U16 dg, U16 db, U16 da) {                             \
             auto x = join<F>(r,g),                                                         \
@@ -5243,46 +5410,54 @@ static void start_pipeline(size_t x0,     size_t y0,
             name##_k(Ctx{program}, dx,dy, x,y);                                            \
             split(x, &r,&g);                                                               \
             split(y, &b,&a);                                                               \
-            auto fn = (Stage)(++program)->fn;                                              \
-            fn(program, dx,dy, r,g,b,a, dr,dg,db,da);                                      \
+            INC;                                                                           \
+            auto fn = (Stage)program->fn;                                                  \
+            fn(program, dx,dy,base, r,g,b,a, dr,dg,db,da);                                 \
         }                                                                                  \
         SI void name##_k(ARG, size_t dx, size_t dy, F& x, F& y)
 
-    #define STAGE_GP(name, ARG)                                                            \
+    #define DECLARE_STAGE_GP(name, ARG, INC)                                               \
         SI void name##_k(ARG, size_t dx, size_t dy, F x, F y,                              \
                          U16&  r, U16&  g, U16&  b, U16&  a,                               \
                          U16& dr, U16& dg, U16& db, U16& da);                              \
         static void ABI name(SkRasterPipelineStage* program,                               \
-                             size_t dx, size_t dy,                                         \
+                             size_t dx, size_t dy, std::byte* base,                        \
                              U16  r, U16  g, U16  b, U16  a,                               \
                              U16 dr, U16 dg, U16 db, U16 da) {                             \
             auto x = join<F>(r,g),                                                         \
                  y = join<F>(b,a);                                                         \
             name##_k(Ctx{program}, dx,dy, x,y, r,g,b,a, dr,dg,db,da);                      \
-            auto fn = (Stage)(++program)->fn;                                              \
-            fn(program, dx,dy, r,g,b,a, dr,dg,db,da);                                      \
+            INC;                                                                           \
+            auto fn = (Stage)program->fn;                                                  \
+            fn(program, dx,dy,base, r,g,b,a, dr,dg,db,da);                                 \
         }                                                                                  \
         SI void name##_k(ARG, size_t dx, size_t dy, F x, F y,                              \
                          U16&  r, U16&  g, U16&  b, U16&  a,                               \
                          U16& dr, U16& dg, U16& db, U16& da)
 
-    #define STAGE_PP(name, ARG)                                                            \
+    #define DECLARE_STAGE_PP(name, ARG, INC)                                               \
         SI void name##_k(ARG, size_t dx, size_t dy,                                        \
                          U16&  r, U16&  g, U16&  b, U16&  a,                               \
                          U16& dr, U16& dg, U16& db, U16& da);                              \
         static void ABI name(SkRasterPipelineStage* program,                               \
-                             size_t dx, size_t dy,                                         \
+                             size_t dx, size_t dy, std::byte* base,                        \
                              U16  r, U16  g, U16  b, U16  a,                               \
                              U16 dr, U16 dg, U16 db, U16 da) {                             \
             name##_k(Ctx{program}, dx,dy, r,g,b,a, dr,dg,db,da);                           \
-            auto fn = (Stage)(++program)->fn;                                              \
-            fn(program, dx,dy, r,g,b,a, dr,dg,db,da);                                      \
+            INC;                                                                           \
+            auto fn = (Stage)program->fn;                                                  \
+            fn(program, dx,dy,base, r,g,b,a, dr,dg,db,da);                                 \
         }                                                                                  \
         SI void name##_k(ARG, size_t dx, size_t dy,                                        \
                          U16&  r, U16&  g, U16&  b, U16&  a,                               \
                          U16& dr, U16& dg, U16& db, U16& da)
 #endif
 
+// A typical stage increments the program counter by 1.
+#define STAGE_GG(name, ARG) DECLARE_STAGE_GG(name, ARG, ++program)
+#define STAGE_GP(name, ARG) DECLARE_STAGE_GP(name, ARG, ++program)
+#define STAGE_PP(name, ARG) DECLARE_STAGE_PP(name, ARG, ++program)
+
 // ~~~~~~ Commonly used helper functions ~~~~~~ //
 
 /**
@@ -6440,6 +6615,16 @@ STAGE_GP(evenly_spaced_2_stop_gradient, const SkRasterPipeline_EvenlySpaced2Stop
                    &r,&g,&b,&a);
 }
 
+STAGE_GP(gradient_lut, const SkRasterPipeline_GradientLUTCtx* c) {
+    auto t = x;
+    F i = mad(clamp_01_(t), c->scale, 1.5f);
+    i = if_then_else(t < 0, 0.0f, i);
+    i = if_then_else(t > 1, (float)c->lastIndex, i);
+    // The clamp keeps NaN t in bounds.
+    I32 idx = min(max(cast<I32>(i), 0), (int32_t)c->lastIndex);
+    from_8888(gather<U32>(c->table, (U32)idx), &r,&g,&b,&a);
+}
+
 STAGE_GP(bilerp_clamp_8888, const SkRasterPipeline_GatherCtx* ctx) {
     // Quantize sample point and transform into lerp coordinates converting them to 16.16 fixed
     // point number.
@@ -6536,6 +6721,79 @@ STAGE_GP(bilerp_clamp_8888, const SkRasterPipeline_GatherCtx* ctx) {
     a = lerpY(topA, bottomA);
 }
 
+SI F bicubic_wts(F t, float A, float B, float C, float D) {
+    return mad(t, mad(t, mad(t, D, C), B), A);
+}
+
+// The 16 taps of a bicubic filter all share the fractional offset (fx,fy) from the pixel grid, so
+// the filter is separable: each row of 4 taps is filtered horizontally, then the 4 rows vertically.
+template <bool kRepeat>
+SI void bicubic_8888(const SkRasterPipeline_GatherCtx* ctx, F x, F y,
+                     U16* r, U16* g, U16* b, U16* a) {
+    F fx = fract(x + 0.5f),
+      fy = fract(y + 0.5f);
+
+    const float* w = ctx->weights;
+    const F wx[4] = {bicubic_wts(fx, w[0], w[4], w[ 8], w[12]),
+                     bicubic_wts(fx, w[1], w[5], w[ 9], w[13]),
+                     bicubic_wts(fx, w[2], w[6], w[10], w[14]),
+                     bicubic_wts(fx, w[3], w[7], w[11], w[15])};
+    const F wy[4] = {bicubic_wts(fy, w[0], w[4], w[ 8], w[12]),
+                     bicubic_wts(fy, w[1], w[5], w[ 9], w[13]),
+                     bicubic_wts(fy, w[2], w[6], w[10], w[14]),
+                     bicubic_wts(fy, w[3], w[7], w[11], w[15])};
+
+    // Integer coordinates of the taps. ix_and_ptr() will clamp them to the image's bounds.
+    I32 sx[4], sy[4];
+    const F x0 = floor_(x - 1.5f),
+            y0 = floor_(y - 1.5f);
+    for (int i = 0; i < 4; ++i) {
+        F tx = x0 + (float)i,
+          ty = y0 + (float)i;
+        if (kRepeat) {
+            tx = tx - floor_(tx * (1.0f / ctx->width )) * ctx->width;
+            ty = ty - floor_(ty * (1.0f / ctx->height)) * ctx->height;
+        }
+        sx[i] = cast<I32>(tx);
+        sy[i] = cast<I32>(ty);
+    }
+
+    F R = F_(0), G = F_(0), B = F_(0), A = F_(0);
+    for (int yy = 0; yy < 4; ++yy) {
+        F rowR = F_(0), rowG = F_(0), rowB = F_(0), rowA = F_(0);
+        for (int xx = 0; xx < 4; ++xx) {
+            const uint32_t* ptr;
+            U32 ix = ix_and_ptr(&ptr, ctx, sx[xx], sy[yy]);
+            U16 sr, sg, sb, sa;
+            from_8888(gather<U32>(ptr, ix), &sr,&sg,&sb,&sa);
+
+            rowR = mad(wx[xx], cast<F>(sr), rowR);
+            rowG = mad(wx[xx], cast<F>(sg), rowG);
+            rowB = mad(wx[xx], cast<F>(sb), rowB);
+            rowA = mad(wx[xx], cast<F>(sa), rowA);
+        }
+        R = mad(wy[yy], rowR, R);
+        G = mad(wy[yy], rowG, G);
+        B = mad(wy[yy], rowB, B);
+        A = mad(wy[yy], rowA, A);
+    }
+
+    // Bicubic filtering overshoots on both sides of [0,255]. The low side can't be represented,
+    // so clamp both here; the image shader follows with clamp_gamut or clamp_01.
+    auto round_channel = [](F v) { return cast<U16>(min(max(0.0f, v), 255.0f) + 0.5f); };
+    *r = round_channel(R);
+    *g = round_channel(G);
+    *b = round_channel(B);
+    *a = round_channel(A);
+}
+
+STAGE_GP(bicubic_clamp_8888, const SkRasterPipeline_GatherCtx* ctx) {
+    bicubic_8888<false>(ctx, x, y, &r, &g, &b, &a);
+}
+STAGE_GP(bicubic_repeat_8888, const SkRasterPipeline_GatherCtx* ctx) {
+    bicubic_8888<true>(ctx, x, y, &r, &g, &b, &a);
+}
+
 STAGE_GG(xy_to_unit_angle, NoCtx) {
     F xabs = abs_(x),
       yabs = abs_(y);
@@ -6597,6 +6855,205 @@ STAGE_PP(swizzle, void* ctx) {
     }
 }
 
+// ~~~~~~ SkSL stages ~~~~~~ //
+
+// SkSL slots hold floats laid out for the highp stride, so a lowp program keeps one copy of its
+// slots for each highp-sized part of the lowp stride. The copies are `sksl_copy_offset(base)` bytes
+// apart, and the highp SkSL math runs once on each of them. (See SK_RASTER_PIPELINE_OPS_SKSL_LOWP.)
+using HighpF = SK_OPTS_NS::F;
+static constexpr size_t kHighpN = SK_OPTS_NS::N;
+static constexpr size_t kNumSkSLCopies = N / kHighpN;
+static_assert(kNumSkSLCopies * kHighpN == N);
+
+// RP::Program stores the distance between copies just ahead of the slots.
+SI ptrdiff_t sksl_copy_offset(const std::byte* base) {
+    return sk_unaligned_load<ptrdiff_t>(base - sizeof(ptrdiff_t));
+}
+
+// SkSL stages get the base pointer and don't take part in the GG/GP/PP split; they leave the
+// registers alone, apart from the stages which move colors in and out of slots.
+#if JUMPER_NARROW_STAGES
+    #define SKSL_STAGE(name, ARG)                                                          \
+        SI void name##_k(ARG, size_t dx, size_t dy, std::byte*& base,                      \
+                         U16&  r, U16&  g, U16&  b, U16&  a,                               \
+                         U16& dr, U16& dg, U16& db, U16& da);                              \
+        static void ABI name(Params* params, SkRasterPipelineStage* program,               \
+                             U16 r, U16 g, U16 b, U16 a) {                                 \
+            name##_k(Ctx{program}, params->dx,params->dy,params->base, r,g,b,a,            \
+                     params->dr,params->dg,params->db,params->da);                         \
+            ++program;                                                                     \
+            auto fn = (Stage)program->fn;                                                  \
+            JUMPER_MUSTTAIL return fn(params, program, r,g,b,a);                           \
+        }                                                                                  \
+        SI void name##_k(ARG, size_t dx, size_t dy, std::byte*& base,                      \
+                         U16&  r, U16&  g, U16&  b, U16&  a,                               \
+                         U16& dr, U16& dg, U16& db, U16& da)
+#else
+    #define SKSL_STAGE(name, ARG)                                                          \
+        SI void name##_k(ARG, size_t dx, size_t dy, std::byte*& base,                      \
+                         U16&  r, U16&  g, U16&  b, U16&  a,                               \
+                         U16& dr, U16& dg, U16& db, U16& da);                              \
+        static void ABI name(SkRasterPipelineStage* program,                               \
+                             size_t dx, size_t dy, std::byte* base,                        \
+                             U16  r, U16  g, U16  b, U16  a,                               \
+                             U16 dr, U16 dg, U16 db, U16 da) {                             \
+            name##_k(Ctx{program}, dx,dy,base, r,g,b,a, dr,dg,db,da);                      \
+            ++program;                                                                     \
+            auto fn = (Stage)program->fn;                                                  \
+            JUMPER_MUSTTAIL return fn(program, dx,dy,base, r,g,b,a, dr,dg,db,da);          \
+        }                                                                                  \
+        SI void name##_k(ARG, size_t dx, size_t dy, std::byte*& base,                      \
+                         U16&  r, U16&  g, U16&  b, U16&  a,                               \
+                         U16& dr, U16& dg, U16& db, U16& da)
+#endif
+
+SKSL_STAGE(set_lowp_base_pointer, std::byte* p) {
+    base = p;
+}
+
+// The lowp SkSL ops never read the lane masks; the lanes past the tail are computed and ignored.
+SKSL_STAGE(init_lane_masks, NoCtx) {}
+
+// Colors are converted to floats on the way into the slots, and rounded back to [0,1] on the way
+// out. RP::Program only runs programs in lowp when their result is known to be in that range.
+SI void store_slots(float* ptr, const std::byte* base, U16 r, U16 g, U16 b, U16 a) {
+    const ptrdiff_t copyOffset = sksl_copy_offset(base);
+    const U16 rgba[] = {r, g, b, a};
+    SK_UNROLL for (size_t channel = 0; channel < 4; ++channel) {
+        F value = cast<F>(rgba[channel]) * (1 / 255.0f);
+        std::byte* dst = (std::byte*)(ptr + channel * kHighpN);
+        SK_UNROLL for (size_t copy = 0; copy < kNumSkSLCopies; ++copy) {
+            memcpy(dst + copy * copyOffset, (const float*)&value + copy * kHighpN, sizeof(HighpF));
+        }
+    }
+}
+
+SI void load_slots(const float* ptr, const std::byte* base, U16* r, U16* g, U16* b, U16* a) {
+    const ptrdiff_t copyOffset = sksl_copy_offset(base);
+    U16* rgba[] = {r, g, b, a};
+    SK_UNROLL for (size_t channel = 0; channel < 4; ++channel) {
+        F value;
+        const std::byte* src = (const std::byte*)(ptr + channel * kHighpN);
+        SK_UNROLL for (size_t copy = 0; copy < kNumSkSLCopies; ++copy) {
+            memcpy((float*)&value + copy * kHighpN, src + copy * copyOffset, sizeof(HighpF));
+        }
+        *rgba[channel] = cast<U16>(min(max(0, value), 1) * 255.0f + 0.5f);
+    }
+}
+
+SKSL_STAGE(store_src_slots, float* ptr) {
+    store_slots(ptr, base, r,g,b,a);
+}
+SKSL_STAGE(store_dst_slots, float* ptr) {
+    store_slots(ptr, base, dr,dg,db,da);
+}
+SKSL_STAGE(load_src_slots, const float* ptr) {
+    load_slots(ptr, base, &r,&g,&b,&a);
+}
+
+// The remaining SkSL stages run the highp kernel on each copy of the slots. Most of them address
+// slots relative to the base pointer, but some contexts point directly at the first copy.
+enum class SkSLContext {
+    kBaseRelative,  // the context only holds offsets from the base pointer
+    kSlotPointer,   // the context is a pointer into the slots
+    kUniformCtx,    // the context is a SkRasterPipeline_UniformCtx, with `dst` in the slots
+};
+
+template <SkSLContext Kind, auto Kernel>
+SI void run_sksl_kernel(SkRasterPipelineStage* stage, size_t dx, size_t dy, std::byte* base) {
+    const ptrdiff_t copyOffset = sksl_copy_offset(base);
+    SK_UNROLL for (size_t copy = 0; copy < kNumSkSLCopies; ++copy) {
+        const ptrdiff_t offset = copy * copyOffset;
+        SkRasterPipelineStage copyStage = *stage;
+        SkRasterPipeline_UniformCtx uniformCtx;
+        if constexpr (Kind == SkSLContext::kSlotPointer) {
+            copyStage.ctx = (std::byte*)stage->ctx + offset;
+        } else if constexpr (Kind == SkSLContext::kUniformCtx) {
+            uniformCtx = *(const SkRasterPipeline_UniformCtx*)stage->ctx;
+            uniformCtx.dst = (int32_t*)((std::byte*)uniformCtx.dst + offset);
+            copyStage.ctx = &uniformCtx;
+        }
+        std::byte* copyBase = base + offset;
+        HighpF r{}, g{}, b{}, a{}, dr{}, dg{}, db{}, da{};
+        Kernel(Ctx{&copyStage}, dx + copy * kHighpN, dy, copyBase, r,g,b,a, dr,dg,db,da);
+    }
+}
+
+#define SKSL_HIGHP_STAGE(name, KIND)                                                          \
+    SKSL_STAGE(name, Ctx ctx) {                                                               \
+        run_sksl_kernel<SkSLContext::KIND, &SK_OPTS_NS::name##_k>(ctx.fStage, dx,dy, base);   \
+    }
+
+#define SKSL_HIGHP_STAGES_1_TO_4(name1, name2, name3, name4, KIND) \
+    SKSL_HIGHP_STAGE(name1, KIND) SKSL_HIGHP_STAGE(name2, KIND)    \
+    SKSL_HIGHP_STAGE(name3, KIND) SKSL_HIGHP_STAGE(name4, KIND)
+
+#define SKSL_HIGHP_FLOAT_STAGES(name)                                                           \
+    SKSL_HIGHP_STAGE(name##_n_floats, kBaseRelative)                                            \
+    SKSL_HIGHP_STAGES_1_TO_4(name##_float, name##_2_floats, name##_3_floats, name##_4_floats, \
+                             kSlotPointer)
+
+SKSL_HIGHP_STAGES_1_TO_4(copy_uniform, copy_2_uniforms, copy_3_uniforms, copy_4_uniforms,
+                         kUniformCtx)
+SKSL_HIGHP_STAGES_1_TO_4(copy_constant, splat_2_constants, splat_3_constants, splat_4_constants,
+                         kBaseRelative)
+SKSL_HIGHP_STAGES_1_TO_4(copy_slot_unmasked, copy_2_slots_unmasked,
+                         copy_3_slots_unmasked, copy_4_slots_unmasked, kBaseRelative)
+SKSL_HIGHP_STAGES_1_TO_4(copy_immutable_unmasked, copy_2_immutables_unmasked,
+                         copy_3_immutables_unmasked, copy_4_immutables_unmasked, kBaseRelative)
+SKSL_HIGHP_STAGES_1_TO_4(swizzle_1, swizzle_2, swizzle_3, swizzle_4, kBaseRelative)
+SKSL_HIGHP_STAGE(dot_2_floats, kSlotPointer)
+SKSL_HIGHP_STAGE(dot_3_floats, kSlotPointer)
+SKSL_HIGHP_STAGE(dot_4_floats, kSlotPointer)
+SKSL_HIGHP_STAGE(add_imm_float, kBaseRelative)
+SKSL_HIGHP_STAGE(mul_imm_float, kBaseRelative)
+SKSL_HIGHP_STAGE(max_imm_float, kBaseRelative)
+SKSL_HIGHP_STAGE(min_imm_float, kBaseRelative)
+SKSL_HIGHP_FLOAT_STAGES(add)
+SKSL_HIGHP_FLOAT_STAGES(sub)
+SKSL_HIGHP_FLOAT_STAGES(mul)
+SKSL_HIGHP_FLOAT_STAGES(div)
+SKSL_HIGHP_FLOAT_STAGES(max)
+SKSL_HIGHP_FLOAT_STAGES(min)
+SKSL_HIGHP_FLOAT_STAGES(mix)
+
+#undef SKSL_HIGHP_FLOAT_STAGES
+#undef SKSL_HIGHP_STAGES_1_TO_4
+#undef SKSL_HIGHP_STAGE
+#undef SKSL_STAGE
+
+// ~~~~~~ Fused stages ~~~~~~ //
+
+#define CALL_FUSED_GG(name, slot) name##_k(Ctx{ctx.fStage + slot}, dx,dy, x,y)
+#define CALL_FUSED_GP(name, slot) name##_k(Ctx{ctx.fStage + slot}, dx,dy, x,y, r,g,b,a, dr,dg,db,da)
+#define CALL_FUSED_PP(name, slot) name##_k(Ctx{ctx.fStage + slot}, dx,dy, r,g,b,a, dr,dg,db,da)
+
+DECLARE_STAGE_PP(fused_load_8888_dst_srcover_store_8888, Ctx ctx, program += 3) {
+    CALL_FUSED_PP(load_8888_dst, 0);
+    CALL_FUSED_PP(srcover,       1);
+    CALL_FUSED_PP(store_8888,    2);
+}
+DECLARE_STAGE_PP(fused_load_8888_srcover_store_8888, Ctx ctx, program += 4) {
+    CALL_FUSED_PP(load_8888,     0);
+    CALL_FUSED_PP(load_8888_dst, 1);
+    CALL_FUSED_PP(srcover,       2);
+    CALL_FUSED_PP(store_8888,    3);
+}
+DECLARE_STAGE_GP(fused_bilerp_clamp_8888_srcover_store_8888, Ctx ctx, program += 4) {
+    CALL_FUSED_GP(bilerp_clamp_8888, 0);
+    CALL_FUSED_PP(load_8888_dst,     1);
+    CALL_FUSED_PP(srcover,           2);
+    CALL_FUSED_PP(store_8888,        3);
+}
+DECLARE_STAGE_GG(fused_seed_shader_matrix_2x3, Ctx ctx, program += 2) {
+    CALL_FUSED_GG(seed_shader, 0);
+    CALL_FUSED_GG(matrix_2x3,  1);
+}
+
+#undef CALL_FUSED_GG
+#undef CALL_FUSED_GP
+#undef CALL_FUSED_PP
+
 #endif//defined(JUMPER_IS_SCALAR) controlling whether we build lowp stages
 }  // namespace lowp
 
@@ -0,0 +1,44 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkTextQuads_opts_DEFINED
+#define SkTextQuads_opts_DEFINED
+
+#include "include/core/SkMatrix.h"
+#include "include/core/SkPoint.h"
+#include "src/base/SkVx.h"
+
+namespace SK_OPTS_NS {
+
+// The four corners of a glyph are mapped together as the (x, y) pairs of one float8, with the
+// arithmetic of SkMatrix::Affine_vpts.
+static void map_text_quads(const float affine[6], const SkPoint leftTop[], const SkPoint size[],
+                           int count, SkPoint corners[]) {
+    const float sx = affine[SkMatrix::kAScaleX], ky = affine[SkMatrix::kASkewY],
+                kx = affine[SkMatrix::kASkewX],  sy = affine[SkMatrix::kAScaleY],
+                tx = affine[SkMatrix::kATransX], ty = affine[SkMatrix::kATransY];
+    const skvx::float8 scale{sx, sy, sx, sy, sx, sy, sx, sy},
+                       skew {kx, ky, kx, ky, kx, ky, kx, ky},
+                       trans{tx, ty, tx, ty, tx, ty, tx, ty};
+    // Which of the width and height each corner adds to the left top: LT, LB, RT, RB.
+    const skvx::float8 corner{0, 0, 0, 1, 1, 0, 1, 1};
+
+    auto splat = [](SkPoint p) {
+        const skvx::float2 p2 = skvx::float2::Load(&p);
+        const skvx::float4 p4 = skvx::join(p2, p2);
+        return skvx::join(p4, p4);
+    };
+    for (int i = 0; i < count; ++i) {
+        const skvx::float8 src = splat(leftTop[i]) + splat(size[i]) * corner;
+        const skvx::float8 swz = skvx::shuffle<1, 0, 3, 2, 5, 4, 7, 6>(src);
+        (src * scale + swz * skew + trans).store(corners + 4 * i);
+    }
+}
+
+}  // namespace SK_OPTS_NS
+
+#endif  // SkTextQuads_opts_DEFINED
@@ -5,6 +5,7 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkExecutor.h"
 #include "include/core/SkPath.h"
 #include "include/core/SkPathTypes.h"
 #include "include/core/SkPoint.h"
@@ -17,6 +18,7 @@
 #include "src/base/SkArenaAlloc.h"
 #include "src/core/SkPathEnums.h"
 #include "src/core/SkPathPriv.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/pathops/SkOpContour.h"
 #include "src/pathops/SkOpEdgeBuilder.h"
 #include "src/pathops/SkOpSegment.h"
@@ -25,7 +27,9 @@
 #include "src/pathops/SkPathOpsTypes.h"
 #include "src/pathops/SkPathWriter.h"
 
+#include <atomic>
 #include <cstdint>
+#include <utility>
 
 static bool one_contour(const SkPath& path) {
     SkSTArenaAlloc<256> allocator;
@@ -40,6 +44,112 @@ static bool one_contour(const SkPath& path) {
     return true;
 }
 
+namespace {
+
+// An intermediate result of resolve(). Paths produced by Op() or Simplify() are already made of
+// non-overlapping contours; the paths passed to add() may not be.
+struct Operand {
+    SkPath fPath;
+    bool fSimplified;
+};
+
+}  // namespace
+
+// True if the paths cover areas that can't touch, so combining them needs no intersections.
+static bool disjoint(const SkPath& one, const SkPath& two) {
+    if (one.isInverseFillType() || two.isInverseFillType()) {
+        return false;
+    }
+    if (one.isEmpty() || two.isEmpty()) {
+        return true;
+    }
+    const SkRect& a = one.getBounds();
+    const SkRect& b = two.getBounds();
+    return a.fRight < b.fLeft || b.fRight < a.fLeft || a.fBottom < b.fTop || b.fBottom < a.fTop;
+}
+
+static bool simplify(Operand* operand) {
+    if (!operand->fSimplified) {
+        if (!Simplify(operand->fPath, &operand->fPath)) {
+            return false;
+        }
+        operand->fSimplified = true;
+    }
+    return true;
+}
+
+// Sets one to (one op two).
+static bool combine(Operand* one, Operand* two, SkPathOp op) {
+    if (!disjoint(one->fPath, two->fPath)) {
+        if (!Op(one->fPath, two->fPath, op, &one->fPath)) {
+            return false;
+        }
+        one->fSimplified = true;
+        return true;
+    }
+    switch (op) {
+        case kDifference_SkPathOp:
+            return true;
+        case kIntersect_SkPathOp:
+            *one = {SkPath(), true};
+            return true;
+        case kReverseDifference_SkPathOp:
+            *one = std::move(*two);
+            return true;
+        case kUnion_SkPathOp:
+        case kXOR_SkPathOp:
+            if (two->fPath.isEmpty()) {
+                return true;
+            }
+            if (one->fPath.isEmpty()) {
+                *one = std::move(*two);
+                return true;
+            }
+            // Both simplified paths are filled even-odd, and neither covers the other.
+            if (!simplify(one) || !simplify(two)) {
+                return false;
+            }
+            one->fPath.addPath(two->fPath);
+            return true;
+    }
+    SkUNREACHABLE;
+}
+
+// Combines the operands with op, which must be associative and commutative, pairing them up so
+// that each Op() works on paths of about the same size. The pairs at each level are combined on
+// the executor, if there is one. Leaves the result in operands[0].
+static bool reduce(skia_private::TArray<Operand>* operands, SkPathOp op, SkExecutor* executor) {
+    while (operands->size() > 1) {
+        const int pairs = operands->size() / 2;
+        std::atomic<bool> success{true};
+        auto combinePair = [&](int pair) {
+            if (!combine(&(*operands)[2 * pair], &(*operands)[2 * pair + 1], op)) {
+                success.store(false, std::memory_order_relaxed);
+            }
+        };
+        if (executor && pairs > 1) {
+            SkTaskGroup tasks(*executor);
+            tasks.batch(pairs - 1, [&](int pair) { combinePair(pair + 1); });
+            combinePair(0);
+            tasks.wait();
+        } else {
+            for (int pair = 0; pair < pairs; ++pair) {
+                combinePair(pair);
+            }
+        }
+        if (!success.load(std::memory_order_relaxed)) {
+            return false;
+        }
+        for (int index = 1; index < operands->size(); ++index) {
+            if (index % 2 == 0) {
+                (*operands)[index / 2] = std::move((*operands)[index]);
+            }
+        }
+        operands->resize((operands->size() + 1) / 2);
+    }
+    return true;
+}
+
 void SkOpBuilder::ReversePath(SkPath* path) {
     SkPath temp;
     SkPoint lastPt;
@@ -176,15 +286,38 @@ bool SkOpBuilder::resolve(SkPath* result) {
         }
     }
     if (!allUnion) {
-        *result = fPathRefs[0];
-        for (int index = 1; index < count; ++index) {
-            if (!Op(*result, fPathRefs[index], fOps[index], result)) {
+        // Applying the ops one at a time makes each Op() intersect the growing result with one
+        // more path. Instead, combine each run of the same op as a balanced tree: a run of
+        // unions, intersects or xors can be grouped any way, and subtracting each path of a run
+        // is the same as subtracting their union.
+        Operand sum = {SkPath(), true};
+        for (int index = 0; index < count;) {
+            const SkPathOp op = fOps[index];
+            int end = index + 1;
+            if (op != kReverseDifference_SkPathOp) {
+                while (end < count && fOps[end] == op) {
+                    ++end;
+                }
+            }
+            skia_private::TArray<Operand> run;
+            run.reserve_exact(end - index);
+            for (; index < end; ++index) {
+                run.push_back({std::move(fPathRefs[index]), false});
+            }
+            const SkPathOp runOp = op == kDifference_SkPathOp ? kUnion_SkPathOp : op;
+            if (!reduce(&run, runOp, fExecutor) || !combine(&sum, &run[0], op)) {
                 reset();
                 *result = original;
                 return false;
             }
         }
         reset();
+        // Ops skipped for disjoint operands can leave a path that was added unsimplified.
+        if (count > 1 && !simplify(&sum)) {
+            *result = original;
+            return false;
+        }
+        *result = std::move(sum.fPath);
         return true;
     }
     SkPath sum;
@@ -11,9 +11,11 @@
 #include "include/private/base/SkDebug.h"
 #include "include/private/base/SkMalloc.h"
 #include "include/private/base/SkTo.h"
+#include "src/core/SkStreamPriv.h"
 #include "src/core/SkTraceEvent.h"
 
 #include <algorithm>
+#include <climits>
 #include <cstdint>
 #include <cstring>
 
@@ -29,6 +31,23 @@ template <typename T> void* skia_alloc_func(void*, T items, T size) {
 
 void skia_free_func(void*, void* address) { sk_free(address); }
 
+int zlib_strategy(SkDeflateWStream::Strategy strategy) {
+    switch (strategy) {
+        case SkDeflateWStream::Strategy::kDefault:     return Z_DEFAULT_STRATEGY;
+        case SkDeflateWStream::Strategy::kFiltered:    return Z_FILTERED;
+        case SkDeflateWStream::Strategy::kHuffmanOnly: return Z_HUFFMAN_ONLY;
+        case SkDeflateWStream::Strategy::kRLE:         return Z_RLE;
+    }
+    SkUNREACHABLE;
+}
+
+void init_z_stream(z_stream* zStream) {
+    zStream->next_in = nullptr;
+    zStream->zalloc = &skia_alloc_func;
+    zStream->zfree = &skia_free_func;
+    zStream->opaque = nullptr;
+}
+
 }  // namespace
 
 #define SKDEFLATEWSTREAM_INPUT_BUFFER_SIZE 4096
@@ -69,7 +88,8 @@ struct SkDeflateWStream::Impl {
 
 SkDeflateWStream::SkDeflateWStream(SkWStream* out,
                                    int compressionLevel,
-                                   bool gzip)
+                                   bool gzip,
+                                   Strategy strategy)
     : fImpl(std::make_unique<SkDeflateWStream::Impl>()) {
 
     // There has existed at some point at least one zlib implementation which thought it was being
@@ -83,17 +103,71 @@ SkDeflateWStream::SkDeflateWStream(SkWStream* out,
     if (!fImpl->fOut) {
         return;
     }
-    fImpl->fZStream.next_in = nullptr;
-    fImpl->fZStream.zalloc = &skia_alloc_func;
-    fImpl->fZStream.zfree = &skia_free_func;
-    fImpl->fZStream.opaque = nullptr;
+    init_z_stream(&fImpl->fZStream);
     SkASSERT(compressionLevel <= 9 && compressionLevel >= -1);
     SkDEBUGCODE(int r =) deflateInit2(&fImpl->fZStream, compressionLevel,
                                       Z_DEFLATED, gzip ? 0x1F : 0x0F,
-                                      8, Z_DEFAULT_STRATEGY);
+                                      8, zlib_strategy(strategy));
     SkASSERT(Z_OK == r);
 }
 
+sk_sp<SkData> SkDeflateWStream::Compress(SkStreamAsset* src,
+                                         int compressionLevel,
+                                         Strategy strategy) {
+    TRACE_EVENT0("skia", TRACE_FUNC);
+    SkASSERT(src && src->hasLength());
+    SkASSERT(compressionLevel != 0);
+    SkASSERT(compressionLevel <= 9 && compressionLevel >= -1);
+    const size_t length = src->getLength() - src->getPosition();
+
+    z_stream zStream;
+    init_z_stream(&zStream);
+    if (Z_OK != deflateInit2(&zStream, compressionLevel, Z_DEFLATED, 0x0F, 8,
+                             zlib_strategy(strategy))) {
+        return nullptr;
+    }
+    // zlib counts bytes in (32 bit) uInts.
+    const uLong bound = length <= UINT_MAX / 2
+                      ? deflateBound(&zStream, static_cast<uLong>(length))
+                      : 0;
+    if (bound == 0 || bound > UINT_MAX) {
+        (void)deflateEnd(&zStream);
+        SkDynamicMemoryWStream compressed;
+        {
+            SkDeflateWStream deflateWStream(&compressed, compressionLevel, false, strategy);
+            SkStreamCopy(&deflateWStream, src);
+        }
+        return compressed.detachAsData();
+    }
+
+    // The bound is large enough for deflate() to never run out of room, so it writes straight
+    // into the result.
+    sk_sp<SkData> out = SkData::MakeUninitialized(bound);
+    zStream.next_out = static_cast<Bytef*>(out->writable_data());
+    zStream.avail_out = SkToUInt(bound);
+    int rc;
+    if (const void* base = src->getMemoryBase()) {
+        zStream.next_in = const_cast<Bytef*>(static_cast<const Bytef*>(base) + src->getPosition());
+        zStream.avail_in = SkToUInt(length);
+        rc = deflate(&zStream, Z_FINISH);
+        (void)src->seek(src->getLength());
+    } else {
+        unsigned char inBuffer[SKDEFLATEWSTREAM_INPUT_BUFFER_SIZE];
+        do {
+            const size_t bytesRead = src->read(inBuffer, sizeof(inBuffer));
+            zStream.next_in = inBuffer;
+            zStream.avail_in = SkToUInt(bytesRead);
+            rc = deflate(&zStream, bytesRead == 0 || src->isAtEnd() ? Z_FINISH : Z_NO_FLUSH);
+        } while (rc == Z_OK);
+    }
+    const size_t compressedSize = zStream.total_out;
+    (void)deflateEnd(&zStream);
+    if (rc != Z_STREAM_END) {
+        return nullptr;
+    }
+    return SkData::MakeSubset(out.get(), 0, compressedSize);
+}
+
 SkDeflateWStream::~SkDeflateWStream() { this->finalize(); }
 
 void SkDeflateWStream::finalize() {
@@ -114,6 +188,15 @@ bool SkDeflateWStream::write(const void* void_buffer, size_t len) {
     }
     const char* buffer = (const char*)void_buffer;
     while (len > 0) {
+        // Large writes need not be copied into fInBuffer first.
+        if (fImpl->fInBufferIndex == 0 && len >= sizeof(fImpl->fInBuffer)) {
+            const size_t todeflate = std::min<size_t>(len, INT_MAX);
+            do_deflate(Z_NO_FLUSH, &fImpl->fZStream, fImpl->fOut,
+                       (unsigned char*)buffer, todeflate);
+            len -= todeflate;
+            buffer += todeflate;
+            continue;
+        }
         size_t tocopy =
                 std::min(len, sizeof(fImpl->fInBuffer) - fImpl->fInBufferIndex);
         memcpy(fImpl->fInBuffer + fImpl->fInBufferIndex, buffer, tocopy);
@@ -9,6 +9,8 @@
 #ifndef SkFlate_DEFINED
 #define SkFlate_DEFINED
 
+#include "include/core/SkData.h"
+#include "include/core/SkRefCnt.h"
 #include "include/core/SkStream.h"
 #include <cstddef>
 
@@ -22,6 +24,15 @@
   */
 class SkDeflateWStream final : public SkWStream {
 public:
+    /** Matches zlib's strategies. kFiltered and kRLE suit image data, kHuffmanOnly is the
+        fastest and compresses the least. */
+    enum class Strategy : int {
+        kDefault = 0,
+        kFiltered = 1,
+        kHuffmanOnly = 2,
+        kRLE = 3,
+    };
+
     /** Does not take ownership of the stream.
 
         @param compressionLevel 1 is best speed; 9 is best compression.
@@ -32,10 +43,22 @@ public:
         a wrapper, documented in RFC 1952, around a deflate stream."
         gzip adds a header with a magic number to the beginning of the
         stream, allowing a client to identify a gzip file.
+
+        @param strategy tunes the compression algorithm for the kind of data written.
      */
     SkDeflateWStream(SkWStream*,
                      int compressionLevel,
-                     bool gzip = false);
+                     bool gzip = false,
+                     Strategy strategy = Strategy::kDefault);
+
+    /** Compresses the rest of |src|, which must have a length, into a zlib stream. This is
+        faster than copying |src| through an SkDeflateWStream: the output is written straight
+        into a buffer sized up front, and if |src| has a memory base it is compressed in a
+        single call, without being copied. Returns nullptr on failure.
+     */
+    static sk_sp<SkData> Compress(SkStreamAsset* src,
+                                  int compressionLevel,
+                                  Strategy strategy = Strategy::kDefault);
 
     /** The destructor calls finalize(). */
     ~SkDeflateWStream() override;
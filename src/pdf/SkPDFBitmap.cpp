@@ -33,7 +33,9 @@
 #include "modules/skcms/skcms.h"
 #include "src/core/SkTHash.h"
 #include "src/pdf/SkDeflate.h"
+#include "src/pdf/SkKeyedImage.h"
 #include "src/pdf/SkPDFDocumentPriv.h"
+#include "src/pdf/SkPDFResourceCache.h"
 #include "src/pdf/SkPDFTypes.h"
 #include "src/pdf/SkPDFUnion.h"
 
@@ -137,18 +139,105 @@ void emit_image_stream(SkPDFDocument* doc,
     doc->emitStream(pdfDict, std::move(writeStream), ref);
 }
 
-void do_deflated_alpha(const SkPixmap& pm, SkPDFDocument* doc, SkPDFIndirectReference ref) {
+// Everything serialize_image() writes for an image except its object numbers, so that it can
+// be kept in an SkPDF::ResourceCache.
+struct EncodedImage {
+    SkPDFStreamFormat fFormat = SkPDFStreamFormat::Uncompressed;
+    SkISize fSize = {0, 0};
+    int fChannels = 0;  // 1 for gray, 3 for RGB.
+    sk_sp<SkData> fICCProfile;
+    sk_sp<SkData> fColor;
+    sk_sp<SkData> fAlpha;  // In fFormat, or null if the image is opaque.
+};
+
+struct CachedImageHeader {
+    int32_t fFormat;
+    int32_t fWidth;
+    int32_t fHeight;
+    int32_t fChannels;
+    uint32_t fICCProfileSize;
+    uint32_t fColorSize;
+    int32_t fAlphaSize;  // -1 if there is no alpha.
+};
+
+sk_sp<SkData> pack_encoded_image(const EncodedImage& image) {
+    CachedImageHeader header = {
+        static_cast<int32_t>(image.fFormat),
+        image.fSize.width(),
+        image.fSize.height(),
+        image.fChannels,
+        image.fICCProfile ? SkToU32(image.fICCProfile->size()) : 0,
+        SkToU32(image.fColor->size()),
+        image.fAlpha ? SkToS32(image.fAlpha->size()) : -1,
+    };
+    SkDynamicMemoryWStream packed;
+    packed.write(&header, sizeof(header));
+    if (image.fICCProfile) {
+        packed.write(image.fICCProfile->data(), image.fICCProfile->size());
+    }
+    packed.write(image.fColor->data(), image.fColor->size());
+    if (image.fAlpha) {
+        packed.write(image.fAlpha->data(), image.fAlpha->size());
+    }
+    return packed.detachAsData();
+}
+
+std::optional<EncodedImage> unpack_encoded_image(const sk_sp<SkData>& packed) {
+    CachedImageHeader header;
+    if (packed->size() < sizeof(header)) {
+        return std::nullopt;
+    }
+    memcpy(&header, packed->data(), sizeof(header));
+    const size_t alphaSize = header.fAlphaSize < 0 ? 0 : SkToSizeT(header.fAlphaSize);
+    if (packed->size() != sizeof(header) + header.fICCProfileSize + header.fColorSize + alphaSize) {
+        return std::nullopt;
+    }
+    EncodedImage image;
+    image.fFormat = static_cast<SkPDFStreamFormat>(header.fFormat);
+    image.fSize = {header.fWidth, header.fHeight};
+    image.fChannels = header.fChannels;
+    size_t offset = sizeof(header);
+    if (header.fICCProfileSize) {
+        image.fICCProfile = SkData::MakeSubset(packed.get(), offset, header.fICCProfileSize);
+        offset += header.fICCProfileSize;
+    }
+    image.fColor = SkData::MakeSubset(packed.get(), offset, header.fColorSize);
+    offset += header.fColorSize;
+    if (header.fAlphaSize >= 0) {
+        image.fAlpha = SkData::MakeSubset(packed.get(), offset, alphaSize);
+    }
+    return image;
+}
+
+// Returns a stream that the caller writes to, and then finishes with finish_encoded_stream().
+SkWStream* begin_encoded_stream(const SkPDFDocument* doc,
+                                SkDynamicMemoryWStream* buffer,
+                                std::optional<SkDeflateWStream>* deflateWStream) {
     SkPDF::Metadata::CompressionLevel compressionLevel = doc->metadata().fCompressionLevel;
-    SkPDFStreamFormat format = compressionLevel == SkPDF::Metadata::CompressionLevel::None
-                             ? SkPDFStreamFormat::Uncompressed
-                             : SkPDFStreamFormat::Flate;
+    if (compressionLevel == SkPDF::Metadata::CompressionLevel::None) {
+        return buffer;
+    }
+    deflateWStream->emplace(buffer, SkToInt(compressionLevel), false,
+                            static_cast<SkDeflateWStream::Strategy>(
+                                    doc->metadata().fCompressionStrategy));
+    return &**deflateWStream;
+}
+
+sk_sp<SkData> finish_encoded_stream(SkDynamicMemoryWStream* buffer,
+                                    std::optional<SkDeflateWStream>* deflateWStream) {
+    if (*deflateWStream) {
+        (*deflateWStream)->finalize();
+    }
+    #ifdef SK_PDF_BASE85_BINARY
+    SkPDFUtils::Base85Encode(buffer->detachAsStream(), buffer);
+    #endif
+    return buffer->detachAsData();
+}
+
+sk_sp<SkData> deflate_alpha(const SkPixmap& pm, const SkPDFDocument* doc) {
     SkDynamicMemoryWStream buffer;
-    SkWStream* stream = &buffer;
     std::optional<SkDeflateWStream> deflateWStream;
-    if (format == SkPDFStreamFormat::Flate) {
-        deflateWStream.emplace(&buffer, SkToInt(compressionLevel));
-        stream = &*deflateWStream;
-    }
+    SkWStream* stream = begin_encoded_stream(doc, &buffer, &deflateWStream);
     if (kAlpha_8_SkColorType == pm.colorType()) {
         SkASSERT(pm.rowBytes() == (size_t)pm.width());
         stream->write(pm.addr8(), pm.width() * pm.height());
@@ -171,17 +260,7 @@ void do_deflated_alpha(const SkPixmap& pm, SkPDFDocument* doc, SkPDFIndirectRefe
         }
         stream->write(byteBuffer, dst - byteBuffer);
     }
-    if (deflateWStream) {
-        deflateWStream->finalize();
-    }
-
-    #ifdef SK_PDF_BASE85_BINARY
-    SkPDFUtils::Base85Encode(buffer.detachAsStream(), &buffer);
-    #endif
-    int length = SkToInt(buffer.bytesWritten());
-    emit_image_stream(doc, ref, [&buffer](SkWStream* stream) { buffer.writeToAndReset(stream); },
-                      pm.info().dimensions(), SkPDFUnion::Name("DeviceGray"),
-                      SkPDFIndirectReference(), length, format);
+    return finish_encoded_stream(&buffer, &deflateWStream);
 }
 
 SkPDFUnion write_icc_profile(SkPDFDocument* doc, sk_sp<SkData>&& icc, int channels) {
@@ -207,41 +286,28 @@ SkPDFUnion write_icc_profile(SkPDFDocument* doc, sk_sp<SkData>&& icc, int channe
     return SkPDFUnion::Object(std::move(iccPDF));
 }
 
-void do_deflated_image(const SkPixmap& pm,
-                       SkPDFDocument* doc,
-                       bool isOpaque,
-                       SkPDFIndirectReference ref) {
-    SkPDFIndirectReference sMask;
-    if (!isOpaque) {
-        sMask = doc->reserveRef();
-    }
-    SkPDF::Metadata::CompressionLevel compressionLevel = doc->metadata().fCompressionLevel;
-    SkPDFStreamFormat format = compressionLevel == SkPDF::Metadata::CompressionLevel::None
-                             ? SkPDFStreamFormat::Uncompressed
-                             : SkPDFStreamFormat::Flate;
+EncodedImage deflate_image(const SkPixmap& pm, const SkPDFDocument* doc, bool isOpaque) {
+    EncodedImage image;
+    image.fFormat = doc->metadata().fCompressionLevel == SkPDF::Metadata::CompressionLevel::None
+                  ? SkPDFStreamFormat::Uncompressed
+                  : SkPDFStreamFormat::Flate;
+    image.fSize = pm.info().dimensions();
     SkDynamicMemoryWStream buffer;
-    SkWStream* stream = &buffer;
     std::optional<SkDeflateWStream> deflateWStream;
-    if (format == SkPDFStreamFormat::Flate) {
-        deflateWStream.emplace(&buffer, SkToInt(compressionLevel));
-        stream = &*deflateWStream;
-    }
-    SkPDFUnion colorSpace = SkPDFUnion::Name("DeviceGray");
-    int channels;
+    SkWStream* stream = begin_encoded_stream(doc, &buffer, &deflateWStream);
     switch (pm.colorType()) {
         case kAlpha_8_SkColorType:
-            channels = 1;
+            image.fChannels = 1;
             fill_stream(stream, '\x00', pm.width() * pm.height());
             break;
         case kGray_8_SkColorType:
-            channels = 1;
-            SkASSERT(sMask.fValue = -1);
+            image.fChannels = 1;
+            SkASSERT(isOpaque);
             SkASSERT(pm.rowBytes() == (size_t)pm.width());
             stream->write(pm.addr8(), pm.width() * pm.height());
             break;
         default:
-            colorSpace = SkPDFUnion::Name("DeviceRGB");
-            channels = 3;
+            image.fChannels = 3;
             SkASSERT(pm.alphaType() == kUnpremul_SkAlphaType);
             SkASSERT(pm.colorType() == kBGRA_8888_SkColorType);
             SkASSERT(pm.rowBytes() == (size_t)pm.width() * 4);
@@ -267,36 +333,28 @@ void do_deflated_image(const SkPixmap& pm,
             }
             stream->write(byteBuffer, dst - byteBuffer);
     }
-    if (deflateWStream) {
-        deflateWStream->finalize();
-    }
+    image.fColor = finish_encoded_stream(&buffer, &deflateWStream);
 
-    if (pm.colorSpace() && channels != 1) {
+    if (pm.colorSpace() && image.fChannels != 1) {
         skcms_ICCProfile iccProfile;
         pm.colorSpace()->toProfile(&iccProfile);
-        sk_sp<SkData> iccData = SkWriteICCProfile(&iccProfile, "");
-        colorSpace = write_icc_profile(doc, std::move(iccData), channels);
+        image.fICCProfile = SkWriteICCProfile(&iccProfile, "");
     }
-
-    #ifdef SK_PDF_BASE85_BINARY
-    SkPDFUtils::Base85Encode(buffer.detachAsStream(), &buffer);
-    #endif
-    int length = SkToInt(buffer.bytesWritten());
-    emit_image_stream(doc, ref, [&buffer](SkWStream* stream) { buffer.writeToAndReset(stream); },
-                      pm.info().dimensions(), std::move(colorSpace), sMask, length, format);
     if (!isOpaque) {
-        do_deflated_alpha(pm, doc, sMask);
+        image.fAlpha = deflate_alpha(pm, doc);
     }
+    return image;
 }
 
-bool do_jpeg(sk_sp<SkData> data, SkColorSpace* imageColorSpace, SkPDFDocument* doc, SkISize size,
-             SkPDFIndirectReference ref) {
+std::optional<EncodedImage> encode_jpeg(sk_sp<SkData> data,
+                                        SkColorSpace* imageColorSpace,
+                                        SkISize size) {
     static constexpr const SkCodecs::Decoder decoders[] = {
         SkJpegDecoder::Decoder(),
     };
     std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(data, decoders);
     if (!codec) {
-        return false;
+        return std::nullopt;
     }
 
     SkISize jpegSize = codec->dimensions();
@@ -309,7 +367,7 @@ bool do_jpeg(sk_sp<SkData> data, SkColorSpace* imageColorSpace, SkPDFDocument* d
     if (jpegSize != size  // Safety check.
             || !goodColorType
             || kTopLeft_SkEncodedOrigin != exifOrientation) {
-        return false;
+        return std::nullopt;
     }
     #ifdef SK_PDF_BASE85_BINARY
     SkDynamicMemoryWStream buffer;
@@ -317,25 +375,45 @@ bool do_jpeg(sk_sp<SkData> data, SkColorSpace* imageColorSpace, SkPDFDocument* d
     data = buffer.detachAsData();
     #endif
 
-    int channels = yuv ? 3 : 1;
-    SkPDFUnion colorSpace = yuv ? SkPDFUnion::Name("DeviceRGB") : SkPDFUnion::Name("DeviceGray");
+    EncodedImage image;
+    image.fFormat = SkPDFStreamFormat::DCT;
+    image.fSize = jpegSize;
+    image.fChannels = yuv ? 3 : 1;
+    image.fColor = std::move(data);
     if (sk_sp<SkData> encodedIccProfileData = encodedInfo.profileData()) {
-        colorSpace = write_icc_profile(doc, std::move(encodedIccProfileData), channels);
+        image.fICCProfile = std::move(encodedIccProfileData);
     } else if (const skcms_ICCProfile* codecIccProfile = codec->getICCProfile()) {
-        sk_sp<SkData> codecIccData = SkWriteICCProfile(codecIccProfile, "");
-        colorSpace = write_icc_profile(doc, std::move(codecIccData), channels);
-    } else if (imageColorSpace && channels != 1) {
+        image.fICCProfile = SkWriteICCProfile(codecIccProfile, "");
+    } else if (imageColorSpace && image.fChannels != 1) {
         skcms_ICCProfile imageIccProfile;
         imageColorSpace->toProfile(&imageIccProfile);
-        sk_sp<SkData> imageIccData = SkWriteICCProfile(&imageIccProfile, "");
-        colorSpace = write_icc_profile(doc, std::move(imageIccData), channels);
+        image.fICCProfile = SkWriteICCProfile(&imageIccProfile, "");
     }
+    return image;
+}
 
+void emit_encoded_image(EncodedImage image, SkPDFDocument* doc, SkPDFIndirectReference ref) {
+    SkPDFIndirectReference sMask;
+    if (image.fAlpha) {
+        sMask = doc->reserveRef();
+    }
+    SkPDFUnion colorSpace = image.fChannels == 1 ? SkPDFUnion::Name("DeviceGray")
+                                                 : SkPDFUnion::Name("DeviceRGB");
+    if (image.fICCProfile) {
+        colorSpace = write_icc_profile(doc, std::move(image.fICCProfile), image.fChannels);
+    }
+    const sk_sp<SkData>& color = image.fColor;
     emit_image_stream(doc, ref,
-                      [&data](SkWStream* dst) { dst->write(data->data(), data->size()); },
-                      jpegSize, std::move(colorSpace),
-                      SkPDFIndirectReference(), SkToInt(data->size()), SkPDFStreamFormat::DCT);
-    return true;
+                      [&color](SkWStream* dst) { dst->write(color->data(), color->size()); },
+                      image.fSize, std::move(colorSpace), sMask, SkToInt(color->size()),
+                      image.fFormat);
+    if (image.fAlpha) {
+        const sk_sp<SkData>& alpha = image.fAlpha;
+        emit_image_stream(doc, sMask,
+                          [&alpha](SkWStream* dst) { dst->write(alpha->data(), alpha->size()); },
+                          image.fSize, SkPDFUnion::Name("DeviceGray"), SkPDFIndirectReference(),
+                          SkToInt(alpha->size()), image.fFormat);
+    }
 }
 
 SkBitmap to_pixels(const SkImage* image) {
@@ -363,18 +441,12 @@ SkBitmap to_pixels(const SkImage* image) {
     return bm;
 }
 
-void serialize_image(const SkImage* img,
-                     int encodingQuality,
-                     SkPDFDocument* doc,
-                     SkPDFIndirectReference ref) {
-    SkASSERT(img);
-    SkASSERT(doc);
-    SkASSERT(encodingQuality >= 0);
+EncodedImage encode_image(const SkImage* img, int encodingQuality, const SkPDFDocument* doc) {
     SkISize dimensions = img->dimensions();
-
     if (sk_sp<SkData> data = img->refEncodedData()) {
-        if (do_jpeg(std::move(data), img->colorSpace(), doc, dimensions, ref)) {
-            return;
+        if (std::optional<EncodedImage> jpeg =
+                    encode_jpeg(std::move(data), img->colorSpace(), dimensions)) {
+            return std::move(*jpeg);
         }
     }
     SkBitmap bm = to_pixels(img);
@@ -385,32 +457,69 @@ void serialize_image(const SkImage* img,
         jOpts.fQuality = encodingQuality;
         SkDynamicMemoryWStream stream;
         if (SkJpegEncoder::Encode(&stream, pm, jOpts)) {
-            if (do_jpeg(stream.detachAsData(), pm.colorSpace(), doc, dimensions, ref)) {
-                return;
+            if (std::optional<EncodedImage> jpeg =
+                        encode_jpeg(stream.detachAsData(), pm.colorSpace(), dimensions)) {
+                return std::move(*jpeg);
             }
         }
     }
-    do_deflated_image(pm, doc, isOpaque, ref);
+    return deflate_image(pm, doc, isOpaque);
+}
+
+void serialize_image(const SkImage* img,
+                     int encodingQuality,
+                     const SkBitmapKey& key,
+                     SkPDFDocument* doc,
+                     SkPDFIndirectReference ref) {
+    SkASSERT(img);
+    SkASSERT(doc);
+    SkASSERT(encodingQuality >= 0);
+
+    SkPDFResourceCacheImpl* cache = SkPDFResourceCacheImpl::Get(doc->metadata());
+    if (!cache) {
+        emit_encoded_image(encode_image(img, encodingQuality, doc), doc, ref);
+        return;
+    }
+    // Everything that the encoded image depends on.
+    SkDynamicMemoryWStream cacheKey;
+    cacheKey.write32(SkToU32(SkPDFResourceCacheImpl::Kind::kImage));
+    cacheKey.write(&key.fSubset, sizeof(key.fSubset));
+    cacheKey.write32(key.fID);
+    cacheKey.write32(SkToU32(encodingQuality));
+    cacheKey.write32(static_cast<uint32_t>(doc->metadata().fCompressionLevel));
+    cacheKey.write32(static_cast<uint32_t>(doc->metadata().fCompressionStrategy));
+    sk_sp<SkData> cacheKeyData = cacheKey.detachAsData();
+    if (sk_sp<SkData> packed = cache->find(cacheKeyData)) {
+        if (std::optional<EncodedImage> cached = unpack_encoded_image(packed)) {
+            emit_encoded_image(std::move(*cached), doc, ref);
+            return;
+        }
+    }
+    EncodedImage image = encode_image(img, encodingQuality, doc);
+    cache->add(std::move(cacheKeyData), pack_encoded_image(image));
+    emit_encoded_image(std::move(image), doc, ref);
 }
 
 } // namespace
 
 SkPDFIndirectReference SkPDFSerializeImage(const SkImage* img,
                                            SkPDFDocument* doc,
-                                           int encodingQuality) {
+                                           int encodingQuality,
+                                           const SkBitmapKey* key) {
     SkASSERT(img);
     SkASSERT(doc);
+    const SkBitmapKey cacheKey = key ? *key : SkBitmapKeyFromImage(img);
     SkPDFIndirectReference ref = doc->reserveRef();
     if (SkExecutor* executor = doc->executor()) {
         SkRef(img);
         doc->incrementJobCount();
-        executor->add([img, encodingQuality, doc, ref]() {
-            serialize_image(img, encodingQuality, doc, ref);
+        executor->add([img, encodingQuality, cacheKey, doc, ref]() {
+            serialize_image(img, encodingQuality, cacheKey, doc, ref);
             SkSafeUnref(img);
             doc->signalJobComplete();
         });
         return ref;
     }
-    serialize_image(img, encodingQuality, doc, ref);
+    serialize_image(img, encodingQuality, cacheKey, doc, ref);
     return ref;
 }
@@ -16,16 +16,20 @@
 class SkCodec;
 class SkImage;
 class SkPDFDocument;
+struct SkBitmapKey;
 struct SkEncodedInfo;
 struct SkPDFIndirectReference;
 
 /**
  * Serialize a SkImage as an Image Xobject.
  *  quality > 100 means lossless
+ *  key, if not null, identifies img in the document's SkPDF::ResourceCache in place of its
+ *  own unique ID (e.g. when img is a subset of another image).
  */
 SkPDFIndirectReference SkPDFSerializeImage(const SkImage* img,
                                            SkPDFDocument* doc,
-                                           int encodingQuality = 101);
+                                           int encodingQuality = 101,
+                                           const SkBitmapKey* key = nullptr);
 
 class SkPDFBitmap {
 public:
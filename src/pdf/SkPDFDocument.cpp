@@ -9,8 +9,10 @@
 
 #include "include/core/SkCanvas.h"
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkMatrix.h"
+#include "include/core/SkPicture.h"
 #include "include/core/SkRect.h"
 #include "include/core/SkSize.h"
 #include "include/core/SkStream.h"
@@ -42,6 +44,7 @@
 #include <algorithm>
 #include <atomic>
 #include <cstddef>
+#include <limits>
 #include <new>
 #include <utility>
 
@@ -158,55 +161,69 @@ static void serialize_footer(const SkPDFOffsetMap& offsetMap,
     wStream->writeText("\n%%EOF\n");
 }
 
+// PDF wants a tree describing all the pages in the document.  We arbitrary
+// choose 8 (kMaxPageTreeNodeSize) as the number of allowed children.  The
+// internal nodes have type "Pages" with an array of children, a parent pointer,
+// and the number of leaves below the node as "Count."
+static constexpr size_t kMaxPageTreeNodeSize = 8;
+
+namespace {
+struct PageTreeNode {
+    std::unique_ptr<SkPDFDict> fNode;
+    SkPDFIndirectReference fReservedRef;
+    int fPageObjectDescendantCount;
+
+    static std::vector<PageTreeNode> Layer(std::vector<PageTreeNode> vec, SkPDFDocument* doc) {
+        std::vector<PageTreeNode> result;
+        const size_t n = vec.size();
+        SkASSERT(n >= 1);
+        const size_t result_len = (n - 1) / kMaxPageTreeNodeSize + 1;
+        SkASSERT(result_len >= 1);
+        SkASSERT(n == 1 || result_len < n);
+        result.reserve(result_len);
+        size_t index = 0;
+        for (size_t i = 0; i < result_len; ++i) {
+            if (n != 1 && index + 1 == n) {  // No need to create a new node.
+                result.push_back(std::move(vec[index++]));
+                continue;
+            }
+            SkPDFIndirectReference parent = doc->reserveRef();
+            auto kids_list = SkPDFMakeArray();
+            int descendantCount = 0;
+            for (size_t j = 0; j < kMaxPageTreeNodeSize && index < n; ++j) {
+                PageTreeNode& node = vec[index++];
+                node.fNode->insertRef("Parent", parent);
+                kids_list->appendRef(doc->emit(*node.fNode, node.fReservedRef));
+                descendantCount += node.fPageObjectDescendantCount;
+            }
+            auto next = SkPDFMakeDict("Pages");
+            next->insertInt("Count", descendantCount);
+            next->insertObject("Kids", std::move(kids_list));
+            result.push_back(PageTreeNode{std::move(next), parent, descendantCount});
+        }
+        return result;
+    }
+};
+}  // namespace
+
+static SkPDFIndirectReference emit_page_tree(SkPDFDocument* doc,
+                                             std::vector<PageTreeNode> currentLayer) {
+    while (currentLayer.size() > 1) {
+        currentLayer = PageTreeNode::Layer(std::move(currentLayer), doc);
+    }
+    SkASSERT(currentLayer.size() == 1);
+    const PageTreeNode& root = currentLayer[0];
+    return doc->emit(*root.fNode, root.fReservedRef);
+}
+
 static SkPDFIndirectReference generate_page_tree(
         SkPDFDocument* doc,
         std::vector<std::unique_ptr<SkPDFDict>> pages,
         const std::vector<SkPDFIndirectReference>& pageRefs) {
-    // PDF wants a tree describing all the pages in the document.  We arbitrary
-    // choose 8 (kNodeSize) as the number of allowed children.  The internal
-    // nodes have type "Pages" with an array of children, a parent pointer, and
-    // the number of leaves below the node as "Count."  The leaves are passed
-    // into the method, have type "Page" and need a parent pointer. This method
-    // builds the tree bottom up, skipping internal nodes that would have only
-    // one child.
+    // The leaves are passed into the method, have type "Page" and need a
+    // parent pointer. This method builds the tree bottom up, skipping internal
+    // nodes that would have only one child.
     SkASSERT(!pages.empty());
-    struct PageTreeNode {
-        std::unique_ptr<SkPDFDict> fNode;
-        SkPDFIndirectReference fReservedRef;
-        int fPageObjectDescendantCount;
-
-        static std::vector<PageTreeNode> Layer(std::vector<PageTreeNode> vec, SkPDFDocument* doc) {
-            std::vector<PageTreeNode> result;
-            static constexpr size_t kMaxNodeSize = 8;
-            const size_t n = vec.size();
-            SkASSERT(n >= 1);
-            const size_t result_len = (n - 1) / kMaxNodeSize + 1;
-            SkASSERT(result_len >= 1);
-            SkASSERT(n == 1 || result_len < n);
-            result.reserve(result_len);
-            size_t index = 0;
-            for (size_t i = 0; i < result_len; ++i) {
-                if (n != 1 && index + 1 == n) {  // No need to create a new node.
-                    result.push_back(std::move(vec[index++]));
-                    continue;
-                }
-                SkPDFIndirectReference parent = doc->reserveRef();
-                auto kids_list = SkPDFMakeArray();
-                int descendantCount = 0;
-                for (size_t j = 0; j < kMaxNodeSize && index < n; ++j) {
-                    PageTreeNode& node = vec[index++];
-                    node.fNode->insertRef("Parent", parent);
-                    kids_list->appendRef(doc->emit(*node.fNode, node.fReservedRef));
-                    descendantCount += node.fPageObjectDescendantCount;
-                }
-                auto next = SkPDFMakeDict("Pages");
-                next->insertInt("Count", descendantCount);
-                next->insertObject("Kids", std::move(kids_list));
-                result.push_back(PageTreeNode{std::move(next), parent, descendantCount});
-            }
-            return result;
-        }
-    };
     std::vector<PageTreeNode> currentLayer;
     currentLayer.reserve(pages.size());
     SkASSERT(pages.size() == pageRefs.size());
@@ -214,12 +231,33 @@ static SkPDFIndirectReference generate_page_tree(
         currentLayer.push_back(PageTreeNode{std::move(pages[i]), pageRefs[i], 1});
     }
     currentLayer = PageTreeNode::Layer(std::move(currentLayer), doc);
-    while (currentLayer.size() > 1) {
-        currentLayer = PageTreeNode::Layer(std::move(currentLayer), doc);
+    return emit_page_tree(doc, std::move(currentLayer));
+}
+
+// In streaming mode the pages have already been emitted, each run of
+// kMaxPageTreeNodeSize pages pointing at a parent reserved for it.
+static SkPDFIndirectReference generate_streamed_page_tree(
+        SkPDFDocument* doc,
+        const std::vector<SkPDFIndirectReference>& parentRefs,
+        const std::vector<SkPDFIndirectReference>& pageRefs) {
+    SkASSERT(!parentRefs.empty());
+    SkASSERT(parentRefs.size() == (pageRefs.size() - 1) / kMaxPageTreeNodeSize + 1);
+    std::vector<PageTreeNode> currentLayer;
+    currentLayer.reserve(parentRefs.size());
+    for (size_t i = 0; i < parentRefs.size(); ++i) {
+        const size_t first = i * kMaxPageTreeNodeSize;
+        const size_t count = std::min(kMaxPageTreeNodeSize, pageRefs.size() - first);
+        auto kids = SkPDFMakeArray();
+        kids->reserve(count);
+        for (size_t j = 0; j < count; ++j) {
+            kids->appendRef(pageRefs[first + j]);
+        }
+        auto node = SkPDFMakeDict("Pages");
+        node->insertInt("Count", SkToInt(count));
+        node->insertObject("Kids", std::move(kids));
+        currentLayer.push_back(PageTreeNode{std::move(node), parentRefs[i], SkToInt(count)});
     }
-    SkASSERT(currentLayer.size() == 1);
-    const PageTreeNode& root = currentLayer[0];
-    return doc->emit(*root.fNode, root.fReservedRef);
+    return emit_page_tree(doc, std::move(currentLayer));
 }
 
 template<typename T, typename... Args>
@@ -230,9 +268,17 @@ static void reset_object(T* dst, Args&&... args) {
 
 ////////////////////////////////////////////////////////////////////////////////
 
+static int shared_resource_limit(const SkPDF::Metadata& metadata) {
+    return metadata.fStreaming ? std::max(metadata.fStreamingResourceLimit, 1)
+                               : std::numeric_limits<int>::max();
+}
+
 SkPDFDocument::SkPDFDocument(SkWStream* stream,
                              SkPDF::Metadata metadata)
     : SkDocument(stream)
+    , fImageShaderMap(shared_resource_limit(metadata))
+    , fGradientPatternMap(shared_resource_limit(metadata))
+    , fPDFBitmapMap(shared_resource_limit(metadata))
     , fMetadata(std::move(metadata)) {
     constexpr float kDpiForRasterScaleOne = 72.0f;
     if (fMetadata.fRasterDPI != kDpiForRasterScaleOne) {
@@ -270,8 +316,16 @@ static SkSize operator*(SkISize u, SkScalar s) { return SkSize{u.width() * s, u.
 static SkSize operator*(SkSize u, SkScalar s) { return SkSize{u.width() * s, u.height() * s}; }
 
 SkCanvas* SkPDFDocument::onBeginPage(SkScalar width, SkScalar height) {
+    if (this->recordsPages()) {
+        fRecordedPageSize = {width, height};
+        return fPageRecorder.beginRecording(width, height);
+    }
+    return this->beginPageDevice(width, height);
+}
+
+SkCanvas* SkPDFDocument::beginPageDevice(SkScalar width, SkScalar height) {
     SkASSERT(fCanvas.imageInfo().dimensions().isZero());
-    if (fPages.empty()) {
+    if (fPageRefs.empty()) {
         // if this is the first page if the document.
         {
             SkAutoMutexExclusive autoMutexAcquire(fMutex);
@@ -375,6 +429,14 @@ std::unique_ptr<SkPDFArray> SkPDFDocument::getAnnotations() {
 }
 
 void SkPDFDocument::onEndPage() {
+    if (this->recordsPages()) {
+        this->convertPageLater(fRecordedPageSize, fPageRecorder.finishRecordingAsPicture());
+        return;
+    }
+    this->endPageDevice();
+}
+
+void SkPDFDocument::endPageDevice() {
     SkASSERT(!fCanvas.imageInfo().dimensions().isZero());
     reset_object(&fCanvas);
     SkASSERT(fPageDevice);
@@ -399,10 +461,114 @@ void SkPDFDocument::onEndPage() {
     // The StructParents unique identifier for each page is just its
     // 0-based page index.
     page->insertInt("StructParents", SkToInt(this->currentPageIndex()));
-    fPages.emplace_back(std::move(page));
+    if (fMetadata.fStreaming) {
+        this->emitStreamedPage(std::move(page));
+        this->evictUnusedFonts();
+    } else {
+        fPages.emplace_back(std::move(page));
+    }
+    fEndedPageCount++;
+}
+
+void SkPDFDocument::emitStreamedPage(std::unique_ptr<SkPDFDict> page) {
+    if (this->currentPageIndex() % kMaxPageTreeNodeSize == 0) {
+        fStreamedPageParents.push_back(this->reserveRef());
+    }
+    page->insertRef("Parent", fStreamedPageParents.back());
+    this->emit(*page, fPageRefs.back());
+}
+
+// Fonts are subset when the document closes, so every font that has been drawn with stays in
+// fFontMap until then. In streaming mode, once there are more fonts than the limit, the ones
+// not drawn with for the longest are subset and emitted now instead, and forgotten.
+void SkPDFDocument::evictUnusedFonts() {
+    const int limit = std::max(fMetadata.fStreamingResourceLimit, 1);
+    if (fFontMap.count() <= limit) {
+        return;
+    }
+    std::vector<std::pair<size_t, uint64_t>> fonts;  // (last page used, key)
+    fonts.reserve(fFontMap.count());
+    for (const auto& [key, font] : fFontMap) {
+        // Fonts drawn with on this page are still in use.
+        if (font.lastPageUsed() < this->currentPageIndex()) {
+            fonts.emplace_back(font.lastPageUsed(), key);
+        }
+    }
+    const size_t evictCount = std::min(fonts.size(), SkToSizeT(fFontMap.count() - limit));
+    std::partial_sort(fonts.begin(), fonts.begin() + evictCount, fonts.end());
+    for (size_t i = 0; i < evictCount; ++i) {
+        const uint64_t key = fonts[i].second;
+        SkPDFFont* font = fFontMap.find(key);
+        font->emitSubset(this);
+
+        // A later use of the typeface will make a new subset, which needs a new tag.
+        if (auto metrics = fTypefaceMetrics.find(font->typeface()->uniqueID())) {
+            SkString& name = (*metrics)->fPostScriptName;
+            name.remove(0, 7);
+            name.prepend(this->nextFontSubsetTag());
+        }
+        fFontMap.remove(key);
+    }
+}
+
+void SkPDFDocument::convertPageLater(SkSize pageSize, sk_sp<SkPicture> page) {
+    // Don't let the caller get too far ahead of the conversions, holding every page in memory.
+    static constexpr size_t kMaxPendingPages = 4;
+    this->waitForRecordedPages(kMaxPendingPages - 1);
+
+    bool post;
+    {
+        SkAutoMutexExclusive lock(fRecordedPagesMutex);
+        fRecordedPages.push_back({pageSize, std::move(page)});
+        fPendingPageCount++;
+        post = !fConvertingPages;
+        fConvertingPages = true;
+    }
+    if (post) {
+        fExecutor->add([this] { this->convertRecordedPages(); });
+    }
+}
+
+// Only this converts pages, one at a time and in order, so the pages' objects are emitted just
+// as they would be if each page were drawn straight into its SkPDFDevice.
+void SkPDFDocument::convertRecordedPages() {
+    fRecordedPagesMutex.acquire();
+    while (!fRecordedPages.empty()) {
+        RecordedPage page = std::move(fRecordedPages.front());
+        fRecordedPages.pop_front();
+        fRecordedPagesMutex.release();
+
+        SkCanvas* canvas = this->beginPageDevice(page.fSize.width(), page.fSize.height());
+        canvas->drawPicture(page.fPicture);
+        this->endPageDevice();
+        page.fPicture.reset();
+
+        fRecordedPagesMutex.acquire();
+        fPendingPageCount--;
+        if (fPageWaiters > 0) {
+            fPageConverted.signal(fPageWaiters);
+            fPageWaiters = 0;
+        }
+    }
+    fConvertingPages = false;
+    fRecordedPagesMutex.release();
+}
+
+void SkPDFDocument::waitForRecordedPages(size_t maxPending) {
+    for (;;) {
+        {
+            SkAutoMutexExclusive lock(fRecordedPagesMutex);
+            if (fPendingPageCount <= maxPending) {
+                return;
+            }
+            fPageWaiters++;
+        }
+        fPageConverted.wait();
+    }
 }
 
 void SkPDFDocument::onAbort() {
+    this->waitForRecordedPages(0);
     this->waitForJobs();
 }
 
@@ -607,8 +773,9 @@ SkString SkPDFDocument::nextFontSubsetTag() {
 }
 
 void SkPDFDocument::onClose(SkWStream* stream) {
+    this->waitForRecordedPages(0);
     SkASSERT(fCanvas.imageInfo().dimensions().isZero());
-    if (fPages.empty()) {
+    if (fPageRefs.empty()) {
         this->waitForJobs();
         return;
     }
@@ -621,7 +788,11 @@ void SkPDFDocument::onClose(SkWStream* stream) {
         docCatalog->insertObject("OutputIntents", make_srgb_output_intents(this));
     }
 
-    docCatalog->insertRef("Pages", generate_page_tree(this, std::move(fPages), fPageRefs));
+    docCatalog->insertRef("Pages",
+                          fMetadata.fStreaming
+                                  ? generate_streamed_page_tree(this, fStreamedPageParents,
+                                                                fPageRefs)
+                                  : generate_page_tree(this, std::move(fPages), fPageRefs));
 
     if (!fNamedDestinations.empty()) {
         docCatalog->insertRef("Dests", append_destinations(this, fNamedDestinations));
@@ -9,11 +9,13 @@
 
 #include "include/core/SkCanvas.h"
 #include "include/core/SkData.h"
+#include "include/core/SkPictureRecorder.h"
 #include "include/core/SkDocument.h"
 #include "include/core/SkPoint.h"
 #include "include/core/SkRect.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkScalar.h"
+#include "include/core/SkSize.h"
 #include "include/core/SkSpan.h"  // IWYU pragma: keep
 #include "include/core/SkStream.h"
 #include "include/core/SkString.h"
@@ -21,6 +23,8 @@
 #include "include/docs/SkPDFDocument.h"
 #include "include/private/base/SkMutex.h"
 #include "include/private/base/SkSemaphore.h"
+#include "include/private/base/SkThreadAnnotations.h"
+#include "src/core/SkLRUCache.h"
 #include "src/core/SkTHash.h"
 #include "src/pdf/SkPDFBitmap.h"
 #include "src/pdf/SkPDFGraphicState.h"
@@ -32,6 +36,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <atomic>
+#include <deque>
 #include <vector>
 #include <memory>
 
@@ -152,19 +157,20 @@ public:
     SkExecutor* executor() const { return fExecutor; }
     void incrementJobCount();
     void signalJobComplete();
-    size_t currentPageIndex() { return fPages.size(); }
+    size_t currentPageIndex() { return fEndedPageCount; }
     size_t pageCount() { return fPageRefs.size(); }
 
     const SkMatrix& currentPageTransform() const;
 
-    // Canonicalized objects
-    skia_private::THashMap<SkPDFImageShaderKey,
-                           SkPDFIndirectReference,
-                           SkPDFImageShaderKey::Hash> fImageShaderMap;
-    skia_private::THashMap<SkPDFGradientShader::Key,
-                           SkPDFIndirectReference,
-                           SkPDFGradientShader::KeyHash> fGradientPatternMap;
-    skia_private::THashMap<SkBitmapKey, SkPDFIndirectReference> fPDFBitmapMap;
+    // Canonicalized objects. The ones that grow with the content are LRU caches, which only
+    // forget anything in streaming mode (see SkPDF::Metadata::fStreaming).
+    SkLRUCache<SkPDFImageShaderKey,
+               SkPDFIndirectReference,
+               SkPDFImageShaderKey::Hash> fImageShaderMap;
+    SkLRUCache<SkPDFGradientShader::Key,
+               SkPDFIndirectReference,
+               SkPDFGradientShader::KeyHash> fGradientPatternMap;
+    SkLRUCache<SkBitmapKey, SkPDFIndirectReference> fPDFBitmapMap;
     skia_private::THashMap<SkPDFIccProfileKey,
                            SkPDFIndirectReference,
                            SkPDFIccProfileKey::Hash> fICCProfileMap;
@@ -190,6 +196,11 @@ private:
     SkCanvas fCanvas;
     std::vector<std::unique_ptr<SkPDFDict>> fPages;
     std::vector<SkPDFIndirectReference> fPageRefs;
+    size_t fEndedPageCount = 0;
+    // In streaming mode, pages are emitted as they end rather than kept in fPages, so their
+    // parents in the page tree have to be known in advance: each of these is the parent of a
+    // run of consecutive pages.
+    std::vector<SkPDFIndirectReference> fStreamedPageParents;
 
     sk_sp<SkPDFDevice> fPageDevice;
     std::atomic<int> fNextObjectNumber = {1};
@@ -209,7 +220,32 @@ private:
     SkMutex fMutex;
     SkSemaphore fSemaphore;
 
+    // For SkPDF::Metadata::fRecordPages: the caller's pages are recorded, and converted on
+    // fExecutor by convertRecordedPages().
+    struct RecordedPage {
+        SkSize fSize;
+        sk_sp<SkPicture> fPicture;
+    };
+    SkPictureRecorder fPageRecorder;
+    SkSize fRecordedPageSize = {0, 0};
+    SkMutex fRecordedPagesMutex;
+    std::deque<RecordedPage> fRecordedPages SK_GUARDED_BY(fRecordedPagesMutex);
+    size_t fPendingPageCount SK_GUARDED_BY(fRecordedPagesMutex) = 0;
+    bool fConvertingPages SK_GUARDED_BY(fRecordedPagesMutex) = false;
+    int fPageWaiters SK_GUARDED_BY(fRecordedPagesMutex) = 0;
+    SkSemaphore fPageConverted;
+
+    bool recordsPages() const { return fMetadata.fRecordPages && fExecutor; }
+    SkCanvas* beginPageDevice(SkScalar width, SkScalar height);
+    void endPageDevice();
+    void convertPageLater(SkSize pageSize, sk_sp<SkPicture>);
+    void convertRecordedPages();
+    // Blocks until at most |maxPending| recorded pages are waiting or being converted.
+    void waitForRecordedPages(size_t maxPending);
+
     void waitForJobs();
+    void emitStreamedPage(std::unique_ptr<SkPDFDict> page);
+    void evictUnusedFonts();
     SkWStream* beginObject(SkPDFIndirectReference);
     void endObject();
 };
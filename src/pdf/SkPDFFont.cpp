@@ -45,6 +45,7 @@
 #include "src/pdf/SkPDFFormXObject.h"
 #include "src/pdf/SkPDFMakeCIDGlyphWidthsArray.h"
 #include "src/pdf/SkPDFMakeToUnicodeCmap.h"
+#include "src/pdf/SkPDFResourceCache.h"
 #include "src/pdf/SkPDFSubsetFont.h"
 #include "src/pdf/SkPDFType1Font.h"
 #include "src/pdf/SkPDFUtils.h"
@@ -221,6 +222,7 @@ SkPDFFont* SkPDFFont::GetFontResource(SkPDFDocument* doc,
 
     if (SkPDFFont* found = doc->fFontMap.find(typefaceID)) {
         SkASSERT(multibyte == found->multiByteGlyphs());
+        found->fLastPageUsed = doc->currentPageIndex();
         return found;
     }
 
@@ -240,8 +242,10 @@ SkPDFFont* SkPDFFont::GetFontResource(SkPDFDocument* doc,
         lastGlyph = SkToU16(std::min<int>((int)lastGlyph, 254 + (int)subsetCode));
     }
     auto ref = doc->reserveRef();
-    return doc->fFontMap.set(
+    SkPDFFont* font = doc->fFontMap.set(
             typefaceID, SkPDFFont(std::move(typeface), firstNonZeroGlyph, lastGlyph, type, ref));
+    font->fLastPageUsed = doc->currentPageIndex();
+    return font;
 }
 
 SkPDFFont::SkPDFFont(sk_sp<SkTypeface> typeface,
@@ -288,6 +292,29 @@ void SkPDFFont::PopulateCommonFontDescriptor(SkPDFDict* descriptor,
 //  Type0Font
 ///////////////////////////////////////////////////////////////////////////////
 
+// Subsetting is slow, so documents that share a resource cache share their subsets.
+static sk_sp<SkData> subset_font(const SkTypeface& typeface,
+                                 const SkPDFGlyphUse& glyphUsage,
+                                 const SkPDFDocument* doc) {
+    SkPDFResourceCacheImpl* cache = SkPDFResourceCacheImpl::Get(doc->metadata());
+    if (!cache) {
+        return SkPDFSubsetFont(typeface, glyphUsage);
+    }
+    SkDynamicMemoryWStream key;
+    key.write32(SkToU32(SkPDFResourceCacheImpl::Kind::kFontSubset));
+    key.write32(typeface.uniqueID());
+    glyphUsage.getSetValues([&key](unsigned gid) { key.write16(SkToU16(gid)); });
+    sk_sp<SkData> keyData = key.detachAsData();
+    if (sk_sp<SkData> subset = cache->find(keyData)) {
+        return subset;
+    }
+    sk_sp<SkData> subset = SkPDFSubsetFont(typeface, glyphUsage);
+    if (subset) {
+        cache->add(std::move(keyData), subset);
+    }
+    return subset;
+}
+
 static void emit_subset_type0(const SkPDFFont& font, SkPDFDocument* doc) {
     const SkAdvancedTypefaceMetrics* metricsPtr =
         SkPDFFont::GetMetrics(font.typeface(), doc);
@@ -317,7 +344,7 @@ static void emit_subset_type0(const SkPDFFont& font, SkPDFDocument* doc) {
                 if (!SkToBool(metrics.fFlags &
                               SkAdvancedTypefaceMetrics::kNotSubsettable_FontFlag)) {
                     SkASSERT(font.firstGlyphID() == 1);
-                    sk_sp<SkData> subsetFontData = SkPDFSubsetFont(*face, font.glyphUsage());
+                    sk_sp<SkData> subsetFontData = subset_font(*face, font.glyphUsage(), doc);
                     if (subsetFontData) {
                         std::unique_ptr<SkPDFDict> tmp = SkPDFMakeDict();
                         tmp->insertInt("Length1", SkToInt(subsetFontData->size()));
@@ -82,6 +82,9 @@ public:
 
     SkPDFIndirectReference indirectReference() const { return fIndirectReference; }
 
+    // The index of the last page that drew with this font.
+    size_t lastPageUsed() const { return fLastPageUsed; }
+
     /** Get the font resource for the passed typeface and glyphID. The
      *  reference count of the object is incremented and it is the caller's
      *  responsibility to unreference it when done.  This is needed to
@@ -127,6 +130,7 @@ private:
     SkPDFGlyphUse fGlyphUsage;
     SkPDFIndirectReference fIndirectReference;
     SkAdvancedTypefaceMetrics::FontType fFontType;
+    size_t fLastPageUsed = 0;
 
     SkPDFFont(sk_sp<SkTypeface>,
               SkGlyphID firstGlyphID,
@@ -1021,7 +1021,7 @@ static SkPDFIndirectReference find_pdf_shader(SkPDFDocument* doc,
     } else {
         pdfShader = make_function_shader(doc, key);
     }
-    gradientPatternMap.set(std::move(key), pdfShader);
+    gradientPatternMap.insert(std::move(key), pdfShader);
     return pdfShader;
 }
 
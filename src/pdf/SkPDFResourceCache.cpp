@@ -0,0 +1,58 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/pdf/SkPDFResourceCache.h"
+
+#include "include/private/base/SkAssert.h"
+
+#include <climits>
+#include <utility>
+
+sk_sp<SkPDF::ResourceCache> SkPDF::ResourceCache::Make(size_t byteBudget) {
+    return sk_make_sp<SkPDFResourceCacheImpl>(byteBudget);
+}
+
+// The budget, not the count, limits the number of entries.
+SkPDFResourceCacheImpl::SkPDFResourceCacheImpl(size_t byteBudget)
+        : fByteBudget(byteBudget), fEntries(INT_MAX) {}
+
+sk_sp<SkData> SkPDFResourceCacheImpl::find(sk_sp<SkData> key) {
+    SkAutoMutexExclusive lock(fMutex);
+    Value* value = fEntries.find(Key{std::move(key)});
+    return value ? value->fData : nullptr;
+}
+
+void SkPDFResourceCacheImpl::add(sk_sp<SkData> key, sk_sp<SkData> value) {
+    const size_t bytes = key->size() + value->size();
+    if (bytes > fByteBudget) {
+        return;
+    }
+    Key entryKey{std::move(key)};
+    SkAutoMutexExclusive lock(fMutex);
+    // Two documents may have made the same value at once.
+    if (fEntries.find(entryKey)) {
+        return;
+    }
+    while (fBytesUsed + bytes > fByteBudget) {
+        Value removed;
+        SkAssertResult(fEntries.removeLeastRecentlyUsed(&removed));
+        fBytesUsed -= removed.fBytes;
+    }
+    fEntries.insert(std::move(entryKey), Value{std::move(value), bytes});
+    fBytesUsed += bytes;
+}
+
+size_t SkPDFResourceCacheImpl::bytesUsed() const {
+    SkAutoMutexExclusive lock(fMutex);
+    return fBytesUsed;
+}
+
+void SkPDFResourceCacheImpl::purgeAll() {
+    SkAutoMutexExclusive lock(fMutex);
+    fEntries.reset();
+    fBytesUsed = 0;
+}
@@ -0,0 +1,75 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkPDFResourceCache_DEFINED
+#define SkPDFResourceCache_DEFINED
+
+#include "include/core/SkData.h"
+#include "include/core/SkRefCnt.h"
+#include "include/docs/SkPDFDocument.h"
+#include "include/private/base/SkMutex.h"
+#include "include/private/base/SkThreadAnnotations.h"
+#include "src/core/SkChecksum.h"
+#include "src/core/SkLRUCache.h"
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ *  The implementation of SkPDF::ResourceCache: a thread-safe map from byte strings to byte
+ *  strings, which forgets the least recently used entries once they take up more than the byte
+ *  budget.
+ */
+class SkPDFResourceCacheImpl final : public SkPDF::ResourceCache {
+public:
+    // The first four bytes of each key.
+    enum class Kind : uint32_t {
+        kFontSubset,
+        kImage,
+    };
+
+    explicit SkPDFResourceCacheImpl(size_t byteBudget);
+
+    static SkPDFResourceCacheImpl* Get(const SkPDF::Metadata& metadata) {
+        return static_cast<SkPDFResourceCacheImpl*>(metadata.fResourceCache.get());
+    }
+
+    sk_sp<SkData> find(sk_sp<SkData> key);
+
+    // Does nothing if an entry for |key| is already there, or if the entry would not fit in the
+    // budget on its own.
+    void add(sk_sp<SkData> key, sk_sp<SkData> value);
+
+    size_t bytesUsed() const override;
+    void purgeAll() override;
+
+private:
+    struct Key {
+        sk_sp<SkData> fData;
+
+        bool operator==(const Key& that) const { return fData->equals(that.fData.get()); }
+
+        struct Hash {
+            uint32_t operator()(const Key& k) const {
+                return SkChecksum::Hash32(k.fData->data(), k.fData->size());
+            }
+        };
+    };
+
+    struct Value {
+        sk_sp<SkData> fData;
+        size_t fBytes = 0;  // Of the key and the value.
+    };
+
+    const size_t fByteBudget;
+
+    mutable SkMutex fMutex;
+    SkLRUCache<Key, Value, Key::Hash> fEntries SK_GUARDED_BY(fMutex);
+    size_t fBytesUsed SK_GUARDED_BY(fMutex) = 0;
+};
+
+#endif  // SkPDFResourceCache_DEFINED
@@ -369,7 +369,7 @@ SkPDFIndirectReference SkPDFMakeShader(SkPDFDocument* doc,
                                   SkRect::Make(surfaceBBox),
                                   skimg,
                                   paintColor);
-        doc->fImageShaderMap.set(std::move(key), pdfShader);
+        doc->fImageShaderMap.insert(std::move(key), pdfShader);
         return pdfShader;
     }
     // Don't bother to de-dup fallback shader.
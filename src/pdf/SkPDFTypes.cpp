@@ -7,12 +7,14 @@
 
 #include "src/pdf/SkPDFTypes.h"
 
+#include "include/core/SkData.h"
 #include "include/core/SkExecutor.h"
 #include "include/core/SkStream.h"
 #include "include/core/SkString.h"
 #include "include/docs/SkPDFDocument.h"
 #include "include/private/base/SkDebug.h"
 #include "include/private/base/SkTo.h"
+#include "src/base/SkAllocationCounters.h"
 #include "src/base/SkUTF.h"
 #include "src/base/SkUtils.h"
 #include "src/core/SkStreamPriv.h"
@@ -541,6 +543,15 @@ void SkPDFDict::insertUnion(const char key[], SkPDFUnion&& value) {
 
 
 
+static_assert((int)SkPDF::Metadata::CompressionStrategy::Default ==
+              (int)SkDeflateWStream::Strategy::kDefault);
+static_assert((int)SkPDF::Metadata::CompressionStrategy::Filtered ==
+              (int)SkDeflateWStream::Strategy::kFiltered);
+static_assert((int)SkPDF::Metadata::CompressionStrategy::HuffmanOnly ==
+              (int)SkDeflateWStream::Strategy::kHuffmanOnly);
+static_assert((int)SkPDF::Metadata::CompressionStrategy::RLE ==
+              (int)SkDeflateWStream::Strategy::kRLE);
+
 static void serialize_stream(SkPDFDict* origDict,
                              SkStreamAsset* stream,
                              SkPDFSteamCompressionEnabled compress,
@@ -557,23 +568,28 @@ static void serialize_stream(SkPDFDict* origDict,
         compress == SkPDFSteamCompressionEnabled::Yes &&
         stream->getLength() > kMinimumSavings)
     {
-        SkDynamicMemoryWStream compressedData;
-        SkDeflateWStream deflateWStream(&compressedData,SkToInt(doc->metadata().fCompressionLevel));
-        SkStreamCopy(&deflateWStream, stream);
-        deflateWStream.finalize();
+        // The length is known, so the whole stream can be compressed in one pass.
+        sk_sp<SkData> compressedData = SkDeflateWStream::Compress(
+                stream,
+                SkToInt(doc->metadata().fCompressionLevel),
+                static_cast<SkDeflateWStream::Strategy>(doc->metadata().fCompressionStrategy));
         #ifdef SK_PDF_BASE85_BINARY
-        {
-            SkPDFUtils::Base85Encode(compressedData.detachAsStream(), &compressedData);
-            tmp = compressedData.detachAsStream();
+        if (compressedData) {
+            SkDynamicMemoryWStream encodedData;
+            SkPDFUtils::Base85Encode(SkMemoryStream::Make(std::move(compressedData)),
+                                     &encodedData);
+            tmp = encodedData.detachAsStream();
             stream = tmp.get();
             auto filters = SkPDFMakeArray();
             filters->appendName("ASCII85Decode");
             filters->appendName("FlateDecode");
             dict.insertObject("Filter", std::move(filters));
+        } else {
+            SkAssertResult(stream->rewind());
         }
         #else
-        if (stream->getLength() > compressedData.bytesWritten() + kMinimumSavings) {
-            tmp = compressedData.detachAsStream();
+        if (compressedData && stream->getLength() > compressedData->size() + kMinimumSavings) {
+            tmp = SkMemoryStream::Make(std::move(compressedData));
             stream = tmp.get();
             dict.insertName("Filter", "FlateDecode");
         } else {
@@ -596,17 +612,23 @@ SkPDFIndirectReference SkPDFStreamOut(std::unique_ptr<SkPDFDict> dict,
     if (SkExecutor* executor = doc->executor()) {
         SkPDFDict* dictPtr = dict.release();
         SkStreamAsset* contentPtr = content.release();
-        // Pass ownership of both pointers into a std::function, which should
+        // Streams queued for the executor can add up to much of a document's memory.
+        SkAccountedBytes* accountedPtr = new SkAccountedBytes(SkAllocationCategory::kPDF);
+        accountedPtr->set(contentPtr->getLength());
+        // Pass ownership of the pointers into a std::function, which should
         // only be executed once.
         doc->incrementJobCount();
-        executor->add([dictPtr, contentPtr, compress, doc, ref]() {
+        executor->add([dictPtr, contentPtr, accountedPtr, compress, doc, ref]() {
             serialize_stream(dictPtr, contentPtr, compress, doc, ref);
             delete dictPtr;
             delete contentPtr;
+            delete accountedPtr;
             doc->signalJobComplete();
         });
         return ref;
     }
+    SkAccountedBytes accounted(SkAllocationCategory::kPDF);
+    accounted.set(content->getLength());
     serialize_stream(dict.get(), content.get(), compress, doc, ref);
     return ref;
 }
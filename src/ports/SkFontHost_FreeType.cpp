@@ -23,6 +23,7 @@
 #include "include/private/base/SkTPin.h"
 #include "include/private/base/SkTemplates.h"
 #include "include/private/base/SkTo.h"
+#include "src/base/SkTInternalLList.h"
 #include "src/base/SkTSearch.h"
 #include "src/core/SkAdvancedTypefaceMetrics.h"
 #include "src/core/SkDescriptor.h"
@@ -32,7 +33,9 @@
 #include "src/core/SkGlyph.h"
 #include "src/core/SkMask.h"
 #include "src/core/SkMaskGamma.h"
+#include "src/core/SkOSFile.h"
 #include "src/core/SkScalerContext.h"
+#include "src/core/SkTHash.h"
 #include "src/ports/SkFontHost_FreeType_common.h"
 #include "src/ports/SkTypeface_FreeType.h"
 #include "src/sfnt/SkOTUtils.h"
@@ -41,6 +44,9 @@
 #include "src/utils/SkCallableTraits.h"
 #include "src/utils/SkMatrix22.h"
 
+#include <sys/stat.h>
+
+#include <cstdint>
 #include <memory>
 #include <optional>
 #include <tuple>
@@ -199,6 +205,12 @@ static FreeTypeLibrary* gFTLibrary;
 
 ///////////////////////////////////////////////////////////////////////////
 
+// The most FT_Faces kept open at once. Beyond this the least recently used of the faces no
+// scaler context is using are closed, to be opened again if their typeface is used again.
+#ifndef SK_FREETYPE_MAX_OPEN_FACES
+    #define SK_FREETYPE_MAX_OPEN_FACES 64
+#endif
+
 class SkTypeface_FreeType::FaceRec {
 public:
     SkUniqueFTFace fFace;
@@ -206,15 +218,28 @@ public:
     std::unique_ptr<SkStreamAsset> fSkStream;
     FT_UShort fFTPaletteEntryCount = 0;
     std::unique_ptr<SkColor[]> fSkPalette;
+    // The scaler contexts borrowing fFace. A face in use is never evicted.
+    int fScalerContextCount = 0;
 
     static std::unique_ptr<FaceRec> Make(const SkTypeface_FreeType* typeface);
     ~FaceRec();
 
+    // Caller must lock f_t_mutex() before calling these functions.
+    static void MarkUsed(FaceRec* rec);
+    static void EvictIdle();
+
 private:
-    FaceRec(std::unique_ptr<SkStreamAsset> stream);
+    FaceRec(const SkTypeface_FreeType* owner, std::unique_ptr<SkStreamAsset> stream);
     void setupAxes(const SkFontData& data);
     void setupPalette(const SkFontData& data);
 
+    SK_DECLARE_INTERNAL_LLIST_INTERFACE(FaceRec);
+    const SkTypeface_FreeType* fOwner;
+
+    // All the open faces, most recently used first. Guarded by f_t_mutex().
+    static SkTInternalLList<FaceRec> gFaceRecs;
+    static int gFaceRecCount;
+
     // Private to ref_ft_library and unref_ft_library
     static int gFTCount;
 
@@ -245,6 +270,8 @@ private:
     }
 };
 int SkTypeface_FreeType::FaceRec::gFTCount;
+SkTInternalLList<SkTypeface_FreeType::FaceRec> SkTypeface_FreeType::FaceRec::gFaceRecs;
+int SkTypeface_FreeType::FaceRec::gFaceRecCount;
 
 extern "C" {
     static unsigned long sk_ft_stream_io(FT_Stream ftStream,
@@ -266,8 +293,10 @@ extern "C" {
     static void sk_ft_stream_close(FT_Stream) {}
 }
 
-SkTypeface_FreeType::FaceRec::FaceRec(std::unique_ptr<SkStreamAsset> stream)
+SkTypeface_FreeType::FaceRec::FaceRec(const SkTypeface_FreeType* owner,
+                                      std::unique_ptr<SkStreamAsset> stream)
         : fSkStream(std::move(stream))
+        , fOwner(owner)
 {
     sk_bzero(&fFTStream, sizeof(fFTStream));
     fFTStream.size = fSkStream->getLength();
@@ -277,14 +306,42 @@ SkTypeface_FreeType::FaceRec::FaceRec(std::unique_ptr<SkStreamAsset> stream)
 
     f_t_mutex().assertHeld();
     ref_ft_library();
+    gFaceRecs.addToHead(this);
+    ++gFaceRecCount;
 }
 
 SkTypeface_FreeType::FaceRec::~FaceRec() {
     f_t_mutex().assertHeld();
+    SkASSERT(fScalerContextCount == 0);
+    gFaceRecs.remove(this);
+    --gFaceRecCount;
     fFace.reset(); // Must release face before the library, the library frees existing faces.
     unref_ft_library();
 }
 
+void SkTypeface_FreeType::FaceRec::MarkUsed(FaceRec* rec) {
+    f_t_mutex().assertHeld();
+    if (gFaceRecs.head() != rec) {
+        gFaceRecs.remove(rec);
+        gFaceRecs.addToHead(rec);
+    }
+}
+
+void SkTypeface_FreeType::FaceRec::EvictIdle() {
+    f_t_mutex().assertHeld();
+    FaceRec* rec = gFaceRecs.tail();
+    // The most recently used face is the one about to be used, so it always stays.
+    while (gFaceRecCount > SK_FREETYPE_MAX_OPEN_FACES && rec && rec != gFaceRecs.head()) {
+        FaceRec* prev = rec->fPrev;
+        if (rec->fScalerContextCount == 0) {
+            // The typeface keeps its font data, so opening the face again sets it up the same.
+            rec->fOwner->fFaceRecEvicted = true;
+            rec->fOwner->fFaceRec.reset();
+        }
+        rec = prev;
+    }
+}
+
 void SkTypeface_FreeType::FaceRec::setupAxes(const SkFontData& data) {
     if (!(fFace->face_flags & FT_FACE_FLAG_MULTIPLE_MASTERS)) {
         return;
@@ -377,7 +434,7 @@ SkTypeface_FreeType::FaceRec::Make(const SkTypeface_FreeType* typeface) {
         return nullptr;
     }
 
-    std::unique_ptr<FaceRec> rec(new FaceRec(data->detachStream()));
+    std::unique_ptr<FaceRec> rec(new FaceRec(typeface, data->detachStream()));
 
     FT_Open_Args args;
     memset(&args, 0, sizeof(args));
@@ -905,6 +962,7 @@ SkScalerContext_FreeType::SkScalerContext_FreeType(sk_sp<SkTypeface_FreeType> ty
         LOG_INFO("Could not create FT_Face.\n");
         return;
     }
+    ++fFaceRec->fScalerContextCount;
 
     fLCDIsVert = SkToBool(fRec.fFlags & SkScalerContext::kLCD_Vertical_Flag);
 
@@ -1081,6 +1139,9 @@ SkScalerContext_FreeType::~SkScalerContext_FreeType() {
         FT_Done_Size(fFTSize);
     }
 
+    if (fFaceRec) {
+        --fFaceRec->fScalerContextCount;
+    }
     fFaceRec = nullptr;
 }
 
@@ -1930,7 +1991,22 @@ sk_sp<SkData> SkTypeface_FreeType::onCopyTableData(SkFontTableTag tag) const {
 
 SkTypeface_FreeType::FaceRec* SkTypeface_FreeType::getFaceRec() const {
     f_t_mutex().assertHeld();
-    fFTFaceOnce([this]{ fFaceRec = SkTypeface_FreeType::FaceRec::Make(this); });
+    bool opened = false;
+    fFTFaceOnce([&]{
+        fFaceRec = SkTypeface_FreeType::FaceRec::Make(this);
+        opened = true;
+    });
+    if (fFaceRecEvicted) {
+        fFaceRecEvicted = false;
+        fFaceRec = SkTypeface_FreeType::FaceRec::Make(this);
+        opened = true;
+    }
+    if (fFaceRec) {
+        FaceRec::MarkUsed(fFaceRec.get());
+        if (opened) {
+            FaceRec::EvictIdle();
+        }
+    }
     return fFaceRec.get();
 }
 
@@ -2019,6 +2095,101 @@ sk_sp<SkTypeface> SkTypeface_FreeType::MakeFromStream(std::unique_ptr<SkStreamAs
     return sk_make_sp<SkTypeface_FreeTypeStream>(std::move(data), name, style, isFixedPitch);
 }
 
+namespace {
+
+// The font files opened by path, each mapped once. A mapping is kept while nothing uses it, so
+// that a typeface whose face was evicted, or a new typeface for the same file, opens it again
+// without mapping it again, until more than kMaxFiles files have been mapped. A file whose size or
+// modification time has changed since it was mapped is mapped again, and those still using the
+// old mapping keep it.
+class MappedFontFiles {
+public:
+    static MappedFontFiles& Get() {
+        static MappedFontFiles& files = *new MappedFontFiles;
+        return files;
+    }
+
+    sk_sp<SkData> map(const char path[]) {
+        SkString key(path);
+        uint64_t size;
+        int64_t modified;
+        if (!StatFile(path, &size, &modified)) {
+            SkAutoMutexExclusive lock(fMutex);
+            fFiles.remove(key);
+            return nullptr;
+        }
+
+        SkAutoMutexExclusive lock(fMutex);
+        if (MappedFile* mapped = fFiles.find(key)) {
+            if (mapped->fSize == size && mapped->fModified == modified) {
+                return mapped->fData;
+            }
+            fFiles.remove(key);
+        }
+
+        FILE* file = sk_fopen(path, kRead_SkFILE_Flag);
+        if (!file) {
+            return nullptr;
+        }
+        sk_sp<SkData> data = SkData::MakeFromFILE(file);
+        sk_fclose(file);
+        if (!data) {
+            return nullptr;
+        }
+
+        if (fFiles.count() >= kMaxFiles) {
+            this->purgeUnused();
+        }
+        // If the file changed after it was stat'ed, it is mapped again the next time it is opened.
+        fFiles.set(std::move(key), {data, size, modified});
+        return data;
+    }
+
+private:
+    static constexpr int kMaxFiles = 64;
+
+    struct MappedFile {
+        sk_sp<SkData> fData;
+        uint64_t fSize;
+        int64_t fModified;
+    };
+
+    static bool StatFile(const char path[], uint64_t* size, int64_t* modified) {
+        struct stat status = {};
+        if (0 != stat(path, &status)) {
+            return false;
+        }
+        *size = static_cast<uint64_t>(status.st_size);
+        *modified = static_cast<int64_t>(status.st_mtime);
+        return true;
+    }
+
+    void purgeUnused() SK_REQUIRES(fMutex) {
+        TArray<SkString> unused;
+        fFiles.foreach([&](const SkString& path, const MappedFile& mapped) {
+            if (mapped.fData->unique()) {
+                unused.push_back(path);
+            }
+        });
+        for (const SkString& path : unused) {
+            fFiles.remove(path);
+        }
+    }
+
+    SkMutex fMutex;
+    THashMap<SkString, MappedFile> fFiles SK_GUARDED_BY(fMutex);
+};
+
+}  // namespace
+
+std::unique_ptr<SkStreamAsset> SkTypeface_FreeType::MakeFileStream(const char path[]) {
+    if (sk_sp<SkData> data = MappedFontFiles::Get().map(path)) {
+        return std::make_unique<SkMemoryStream>(std::move(data));
+    }
+    // If the file cannot be mapped, read it as it is needed.
+    return SkStream::MakeFromFile(path);
+}
+
 SkFontScanner_FreeType::SkFontScanner_FreeType() : fLibrary(nullptr) {
     if (FT_New_Library(&gFTMemory, &fLibrary)) {
         return;
@@ -21,6 +21,7 @@
 #include "include/private/base/SkTemplates.h"
 #include "src/base/SkTSearch.h"
 #include "src/core/SkFontDescriptor.h"
+#include "src/core/SkFontFallbackCache.h"
 #include "src/core/SkFontScanner.h"
 #include "src/core/SkOSFile.h"
 #include "src/core/SkTypefaceCache.h"
@@ -84,7 +85,7 @@ public:
             sk_sp<SkData> data(SkData::MakeFromFILE(fFile));
             return data ? std::make_unique<SkMemoryStream>(std::move(data)) : nullptr;
         }
-        return SkStream::MakeFromFile(fPathName.c_str());
+        return SkTypeface_FreeType::MakeFileStream(fPathName.c_str());
     }
 
     void onGetFontDescriptor(SkFontDescriptor* desc, bool* serialize) const override {
@@ -246,6 +247,33 @@ private:
     using INHERITED = SkFontStyleSet;
 };
 
+/** The faces tried, in order, for the fallback of one family, style and list of languages. */
+class FallbackChain : public SkFontFallbackCache::Chain {
+public:
+    explicit FallbackChain(TArray<sk_sp<SkTypeface_AndroidSystem>> faces)
+        : fFaces(std::move(faces)) { }
+
+    int count() const override { return fFaces.size(); }
+
+    void getCoverage(int index, SkUnichar first,
+                     SkFontFallbackCache::Coverage* coverage) const override {
+        SkUnichar characters[SkFontFallbackCache::kBlockSize];
+        SkGlyphID glyphs[SkFontFallbackCache::kBlockSize];
+        for (int i = 0; i < SkFontFallbackCache::kBlockSize; ++i) {
+            characters[i] = first + i;
+        }
+        fFaces[index]->unicharsToGlyphs(characters, SkFontFallbackCache::kBlockSize, glyphs);
+        for (int i = 0; i < SkFontFallbackCache::kBlockSize; ++i) {
+            coverage->set(i, glyphs[i] != 0);
+        }
+    }
+
+    sk_sp<SkTypeface> makeTypeface(int index) const override { return fFaces[index]; }
+
+private:
+    TArray<sk_sp<SkTypeface_AndroidSystem>> fFaces;
+};
+
 /** On Android a single family can have many names, but our API assumes unique names.
  *  Map names to the back end so that all names for a given family refer to the same
  *  (non-replicated) set of typefaces.
@@ -333,11 +361,14 @@ protected:
         return sset->matchStyle(style);
     }
 
-    static sk_sp<SkTypeface_AndroidSystem> find_family_style_character(
+    // Calls visit(face) for each face of the fallback families of familyName which matches the
+    // other arguments, until visit returns true.
+    template <typename Visit>
+    static bool visit_family_style(
             const SkString& familyName,
             const TArray<NameToFamily, true>& fallbackNameToFamilyMap,
             const SkFontStyle& style, bool elegant,
-            const SkString& langTag, SkUnichar character)
+            const SkString& langTag, Visit&& visit)
     {
         for (int i = 0; i < fallbackNameToFamilyMap.size(); ++i) {
             SkFontStyleSet_Android* family = fallbackNameToFamilyMap[i].styleSet;
@@ -358,18 +389,18 @@ protected:
                 continue;
             }
 
-            if (face->unicharToGlyph(character) != 0) {
-                return face;
+            if (visit(std::move(face))) {
+                return true;
             }
         }
-        return nullptr;
+        return false;
     }
 
-    sk_sp<SkTypeface> onMatchFamilyStyleCharacter(const char familyName[],
-                                                  const SkFontStyle& style,
-                                                  const char* bcp47[],
-                                                  int bcp47Count,
-                                                  SkUnichar character) const override {
+    // Calls visit(face) for each face that may be the fallback for a character, in the order
+    // that they are tried, until visit returns true.
+    template <typename Visit>
+    void visitFallbacks(const char familyName[], const SkFontStyle& style,
+                        const char* bcp47[], int bcp47Count, Visit&& visit) const {
         // The variant 'elegant' is 'not squashed', 'compact' is 'stays in ascent/descent'.
         // The variant 'default' means 'compact and elegant'.
         // As a result, it is not possible to know the variant context from the font alone.
@@ -382,27 +413,43 @@ protected:
                 for (int bcp47Index = bcp47Count; bcp47Index --> 0;) {
                     SkLanguage lang(bcp47[bcp47Index]);
                     while (!lang.getTag().isEmpty()) {
-                        sk_sp<SkTypeface_AndroidSystem> matchingTypeface =
-                            find_family_style_character(currentFamilyName, fFallbackNameToFamilyMap,
-                                                        style, SkToBool(elegant),
-                                                        lang.getTag(), character);
-                        if (matchingTypeface) {
-                            return matchingTypeface;
+                        if (visit_family_style(currentFamilyName, fFallbackNameToFamilyMap,
+                                               style, SkToBool(elegant), lang.getTag(), visit)) {
+                            return;
                         }
 
                         lang = lang.getParent();
                     }
                 }
-                sk_sp<SkTypeface_AndroidSystem> matchingTypeface =
-                    find_family_style_character(currentFamilyName, fFallbackNameToFamilyMap,
-                                                style, SkToBool(elegant),
-                                                SkString(), character);
-                if (matchingTypeface) {
-                    return matchingTypeface;
+                if (visit_family_style(currentFamilyName, fFallbackNameToFamilyMap,
+                                       style, SkToBool(elegant), SkString(), visit)) {
+                    return;
                 }
             }
         }
-        return nullptr;
+    }
+
+    sk_sp<SkTypeface> onMatchFamilyStyleCharacter(const char familyName[],
+                                                  const SkFontStyle& style,
+                                                  const char* bcp47[],
+                                                  int bcp47Count,
+                                                  SkUnichar character) const override {
+        // The fallback for a character is the first face in visitFallbacks() order with a
+        // glyph for it, so the order can be found once for all characters.
+        return fFallbackCache.match(familyName, style, bcp47, bcp47Count, character, [&]() {
+            TArray<sk_sp<SkTypeface_AndroidSystem>> faces;
+            this->visitFallbacks(familyName, style, bcp47, bcp47Count,
+                                 [&](sk_sp<SkTypeface_AndroidSystem> face) {
+                // Only the first time a face is tried can it be the one found.
+                if (std::none_of(faces.begin(), faces.end(), [&](const auto& f) {
+                        return f == face;
+                    })) {
+                    faces.push_back(std::move(face));
+                }
+                return false;
+            });
+            return std::make_unique<FallbackChain>(std::move(faces));
+        });
     }
 
     sk_sp<SkTypeface> onMakeFromData(sk_sp<SkData> data, int ttcIndex) const override {
@@ -448,6 +495,8 @@ private:
     TArray<NameToFamily, true> fNameToFamilyMap;
     TArray<NameToFamily, true> fFallbackNameToFamilyMap;
 
+    mutable SkFontFallbackCache fFallbackCache;
+
     void addFamily(FontFamily& family, const bool isolated, int familyIndex) {
         TArray<NameToFamily, true>* nameToFamily = &fNameToFamilyMap;
         if (family.fIsFallbackFont) {
@@ -8,23 +8,196 @@
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkStream.h"
 #include "include/ports/SkFontMgr_directory.h"
+#include "include/private/base/SkTArray.h"
 #include "src/core/SkFontScanner.h"
 #include "src/core/SkOSFile.h"
+#include "src/core/SkTHash.h"
 #include "src/ports/SkFontMgr_custom.h"
 #include "src/ports/SkTypeface_FreeType.h"
 #include "src/utils/SkOSPath.h"
 
+#include <sys/stat.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <utility>
+
+using namespace skia_private;
+
+namespace {
+
+// What scanning one font file found, so that it need not be scanned again while its size and
+// modification time stay the same.
+struct IndexedFile {
+    struct Instance {
+        SkString fFamilyName;
+        SkFontStyle fStyle;
+        bool fIsFixedPitch;
+        int fIndex;  // (instanceIndex << 16) + faceIndex, as SkTypeface_File takes it.
+    };
+
+    uint64_t fSize = 0;
+    int64_t fModified = 0;
+    TArray<Instance> fInstances;  // Empty for a file that is not a font.
+};
+
+using FontIndex = THashMap<SkString, IndexedFile>;
+
+static constexpr uint32_t kIndexMagic = 0x69666b73;  // 'skfi'
+static constexpr uint32_t kIndexVersion = 1;
+
+bool stat_file(const char path[], uint64_t* size, int64_t* modified) {
+    struct stat status = {};
+    if (0 != stat(path, &status)) {
+        return false;
+    }
+    *size = static_cast<uint64_t>(status.st_size);
+    *modified = static_cast<int64_t>(status.st_mtime);
+    return true;
+}
+
+[[nodiscard]] bool read_u64(SkStream* stream, uint64_t* value) {
+    uint32_t lo, hi;
+    if (!stream->readU32(&lo) || !stream->readU32(&hi)) {
+        return false;
+    }
+    *value = (static_cast<uint64_t>(hi) << 32) | lo;
+    return true;
+}
+
+bool write_u64(SkWStream* stream, uint64_t value) {
+    return stream->write32(static_cast<uint32_t>(value)) &&
+           stream->write32(static_cast<uint32_t>(value >> 32));
+}
+
+[[nodiscard]] bool read_string(SkStream* stream, SkString* string) {
+    size_t length;
+    if (!stream->readPackedUInt(&length)) {
+        return false;
+    }
+    if (stream->hasLength() && stream->getLength() - stream->getPosition() < length) {
+        return false;
+    }
+    string->resize(length);
+    return stream->read(string->data(), length) == length;
+}
+
+bool write_string(SkWStream* stream, const SkString& string) {
+    return stream->writePackedUInt(string.size()) && stream->write(string.c_str(), string.size());
+}
+
+// A missing, unreadable or out of date index reads as empty, and every font file is scanned.
+FontIndex read_index(const char path[]) {
+    FontIndex index;
+    std::unique_ptr<SkStreamAsset> stream = SkStream::MakeFromFile(path);
+    uint32_t magic, version, fileCount;
+    if (!stream ||
+        !stream->readU32(&magic) || magic != kIndexMagic ||
+        !stream->readU32(&version) || version != kIndexVersion ||
+        !stream->readU32(&fileCount)) {
+        return index;
+    }
+    for (uint32_t i = 0; i < fileCount; ++i) {
+        SkString filename;
+        IndexedFile file;
+        uint64_t modified;
+        uint32_t instanceCount;
+        if (!read_string(stream.get(), &filename) ||
+            !read_u64(stream.get(), &file.fSize) ||
+            !read_u64(stream.get(), &modified) ||
+            !stream->readU32(&instanceCount)) {
+            return FontIndex();
+        }
+        file.fModified = static_cast<int64_t>(modified);
+        for (uint32_t j = 0; j < instanceCount; ++j) {
+            IndexedFile::Instance instance;
+            uint16_t weight, width, slant;
+            int32_t fontIndex;
+            if (!read_string(stream.get(), &instance.fFamilyName) ||
+                !stream->readU16(&weight) ||
+                !stream->readU16(&width) ||
+                !stream->readU16(&slant) || slant > SkFontStyle::kOblique_Slant ||
+                !stream->readBool(&instance.fIsFixedPitch) ||
+                !stream->readS32(&fontIndex)) {
+                return FontIndex();
+            }
+            instance.fStyle = SkFontStyle(weight, width, static_cast<SkFontStyle::Slant>(slant));
+            instance.fIndex = fontIndex;
+            file.fInstances.push_back(std::move(instance));
+        }
+        index.set(std::move(filename), std::move(file));
+    }
+    return index;
+}
+
+void write_index(const char path[], const FontIndex& index) {
+    // Write a new index next to the old one and swap it in, so that a font manager being made
+    // at the same time never reads half of it.
+    SkString tempPath(path);
+    tempPath.append(".tmp");
+    bool ok;
+    {
+        SkFILEWStream stream(tempPath.c_str());
+        ok = stream.isValid() &&
+             stream.write32(kIndexMagic) &&
+             stream.write32(kIndexVersion) &&
+             stream.write32(index.count());
+        index.foreach([&](const SkString& filename, const IndexedFile& file) {
+            ok = ok && write_string(&stream, filename) &&
+                       write_u64(&stream, file.fSize) &&
+                       write_u64(&stream, static_cast<uint64_t>(file.fModified)) &&
+                       stream.write32(file.fInstances.size());
+            for (const IndexedFile::Instance& instance : file.fInstances) {
+                ok = ok && write_string(&stream, instance.fFamilyName) &&
+                           stream.write16(instance.fStyle.weight()) &&
+                           stream.write16(instance.fStyle.width()) &&
+                           stream.write16(instance.fStyle.slant()) &&
+                           stream.writeBool(instance.fIsFixedPitch) &&
+                           stream.write32(instance.fIndex);
+            }
+        });
+        if (ok) {
+            stream.fsync();
+        }
+    }
+    if (!ok) {
+        remove(tempPath.c_str());
+        return;
+    }
+    if (0 != rename(tempPath.c_str(), path)) {
+        // Windows will not rename over an existing file.
+        remove(path);
+        if (0 != rename(tempPath.c_str(), path)) {
+            remove(tempPath.c_str());
+        }
+    }
+}
+
+}  // namespace
+
 class DirectorySystemFontLoader : public SkFontMgr_Custom::SystemFontLoader {
 public:
-    DirectorySystemFontLoader(const char* dir) : fBaseDirectory(dir) { }
+    DirectorySystemFontLoader(const char* dir, const char* indexPath)
+            : fBaseDirectory(dir), fIndexPath(indexPath) { }
 
     void loadSystemFonts(const SkFontScanner* scanner,
                          SkFontMgr_Custom::Families* families) const override
     {
-        load_directory_fonts(scanner, fBaseDirectory, ".ttf", families);
-        load_directory_fonts(scanner, fBaseDirectory, ".ttc", families);
-        load_directory_fonts(scanner, fBaseDirectory, ".otf", families);
-        load_directory_fonts(scanner, fBaseDirectory, ".pfb", families);
+        FontIndex previous, current;
+        if (!fIndexPath.isEmpty()) {
+            previous = read_index(fIndexPath.c_str());
+        }
+        bool indexChanged = false;
+
+        for (const char* suffix : {".ttf", ".ttc", ".otf", ".pfb"}) {
+            load_directory_fonts(scanner, fBaseDirectory, suffix, previous, &current,
+                                 &indexChanged, families);
+        }
+
+        // Font files that went away also make for a new index.
+        if (!fIndexPath.isEmpty() && (indexChanged || current.count() != previous.count())) {
+            write_index(fIndexPath.c_str(), current);
+        }
 
         if (families->empty()) {
             SkFontStyleSet_Custom* family = new SkFontStyleSet_Custom(SkString());
@@ -45,8 +218,42 @@ private:
         return nullptr;
     }
 
+    static void scan_file(const SkFontScanner* scanner, SkStreamAsset* stream,
+                          IndexedFile* file)
+    {
+        int numFaces;
+        if (!scanner->scanFile(stream, &numFaces)) {
+            return;
+        }
+
+        for (int faceIndex = 0; faceIndex < numFaces; ++faceIndex) {
+            int numInstances;
+            if (!scanner->scanFace(stream, faceIndex, &numInstances)) {
+                continue;
+            }
+            for (int instanceIndex = 0; instanceIndex <= numInstances; ++instanceIndex) {
+                bool isFixedPitch;
+                SkString realname;
+                SkFontStyle style = SkFontStyle(); // avoid uninitialized warning
+                if (!scanner->scanInstance(stream,
+                                           faceIndex,
+                                           instanceIndex,
+                                           &realname,
+                                           &style,
+                                           &isFixedPitch,
+                                           nullptr)) {
+                    continue;
+                }
+                file->fInstances.push_back({std::move(realname), style, isFixedPitch,
+                                            (instanceIndex << 16) + faceIndex});
+            }
+        }
+    }
+
     static void load_directory_fonts(const SkFontScanner* scanner,
                                      const SkString& directory, const char* suffix,
+                                     const FontIndex& previous, FontIndex* current,
+                                     bool* indexChanged,
                                      SkFontMgr_Custom::Families* families)
     {
         SkOSFile::Iter iter(directory.c_str(), suffix);
@@ -54,49 +261,36 @@ private:
 
         while (iter.next(&name, false)) {
             SkString filename(SkOSPath::Join(directory.c_str(), name.c_str()));
-            std::unique_ptr<SkStreamAsset> stream = SkStream::MakeFromFile(filename.c_str());
-            if (!stream) {
-                // SkDebugf("---- failed to open <%s>\n", filename.c_str());
-                continue;
-            }
 
-            int numFaces;
-            if (!scanner->scanFile(stream.get(), &numFaces)) {
-                // SkDebugf("---- failed to open <%s> as a font\n", filename.c_str());
-                continue;
-            }
-
-            for (int faceIndex = 0; faceIndex < numFaces; ++faceIndex) {
-                int numInstances;
-                if (!scanner->scanFace(stream.get(), faceIndex, &numInstances)) {
-                    // SkDebugf("---- failed to open <%s> as a font\n", filename.c_str());
+            IndexedFile file;
+            const bool haveStat = stat_file(filename.c_str(), &file.fSize, &file.fModified);
+            const IndexedFile* indexed = haveStat ? previous.find(filename) : nullptr;
+            if (indexed && indexed->fSize == file.fSize &&
+                           indexed->fModified == file.fModified) {
+                file.fInstances = indexed->fInstances;
+            } else {
+                std::unique_ptr<SkStreamAsset> stream = SkStream::MakeFromFile(filename.c_str());
+                if (!stream) {
+                    // SkDebugf("---- failed to open <%s>\n", filename.c_str());
                     continue;
                 }
-                for (int instanceIndex = 0; instanceIndex <= numInstances; ++instanceIndex) {
-                    bool isFixedPitch;
-                    SkString realname;
-                    SkFontStyle style = SkFontStyle(); // avoid uninitialized warning
-                    if (!scanner->scanInstance(stream.get(),
-                                               faceIndex,
-                                               instanceIndex,
-                                               &realname,
-                                               &style,
-                                               &isFixedPitch,
-                                               nullptr)) {
-                        // SkDebugf("---- failed to open <%s> <%d> as a font\n",
-                        //          filename.c_str(), faceIndex);
-                        continue;
-                    }
-
-                    SkFontStyleSet_Custom* addTo = find_family(*families, realname.c_str());
-                    if (nullptr == addTo) {
-                        addTo = new SkFontStyleSet_Custom(realname);
-                        families->push_back().reset(addTo);
-                    }
-                    addTo->appendTypeface(sk_make_sp<SkTypeface_File>(
-                            style, isFixedPitch, true, realname, filename.c_str(),
-                            (instanceIndex << 16) + faceIndex));
+                scan_file(scanner, stream.get(), &file);
+                *indexChanged = true;
+            }
+
+            for (const IndexedFile::Instance& instance : file.fInstances) {
+                SkFontStyleSet_Custom* addTo = find_family(*families,
+                                                           instance.fFamilyName.c_str());
+                if (nullptr == addTo) {
+                    addTo = new SkFontStyleSet_Custom(instance.fFamilyName);
+                    families->push_back().reset(addTo);
                 }
+                addTo->appendTypeface(sk_make_sp<SkTypeface_File>(
+                        instance.fStyle, instance.fIsFixedPitch, true, instance.fFamilyName,
+                        filename.c_str(), instance.fIndex));
+            }
+            if (haveStat) {
+                current->set(std::move(filename), std::move(file));
             }
         }
 
@@ -106,13 +300,19 @@ private:
                 continue;
             }
             SkString dirname(SkOSPath::Join(directory.c_str(), name.c_str()));
-            load_directory_fonts(scanner, dirname, suffix, families);
+            load_directory_fonts(scanner, dirname, suffix, previous, current, indexChanged,
+                                 families);
         }
     }
 
     SkString fBaseDirectory;
+    SkString fIndexPath;
 };
 
 sk_sp<SkFontMgr> SkFontMgr_New_Custom_Directory(const char* dir) {
-    return sk_make_sp<SkFontMgr_Custom>(DirectorySystemFontLoader(dir));
+    return SkFontMgr_New_Custom_Directory(dir, nullptr);
+}
+
+sk_sp<SkFontMgr> SkFontMgr_New_Custom_Directory(const char* dir, const char* indexPath) {
+    return sk_make_sp<SkFontMgr_Custom>(DirectorySystemFontLoader(dir, indexPath));
 }
@@ -18,15 +18,19 @@
 #include "include/core/SkTypes.h"
 #include "include/private/base/SkDebug.h"
 #include "include/private/base/SkMutex.h"
+#include "include/private/base/SkOnce.h"
 #include "include/private/base/SkTArray.h"
 #include "include/private/base/SkTDArray.h"
 #include "include/private/base/SkTemplates.h"
 #include "include/private/base/SkThreadAnnotations.h"
+#include "src/base/SkSharedMutex.h"
 #include "src/base/SkTSort.h"
 #include "src/core/SkAdvancedTypefaceMetrics.h"
 #include "src/core/SkFontDescriptor.h"
+#include "src/core/SkFontFallbackCache.h"
 #include "src/core/SkOSFile.h"
 #include "src/core/SkScalerContext.h"
+#include "src/core/SkTHash.h"
 #include "src/core/SkTypefaceCache.h"
 #include "src/ports/SkTypeface_FreeType.h"
 
@@ -37,6 +41,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <string_view>
 #include <utility>
 
 class SkData;
@@ -447,7 +452,7 @@ public:
                 filename = resolvedFilename.c_str();
             }
         }
-        return SkStream::MakeFromFile(filename);
+        return SkTypeface_FreeType::MakeFileStream(filename);
     }
 
     void onFilterRec(SkScalerContextRec* rec) const override {
@@ -535,7 +540,10 @@ private:
 class SkFontMgr_fontconfig : public SkFontMgr {
     mutable SkAutoFcConfig fFC;  // Only mutable to avoid const cast when passed to FontConfig API.
     const SkString fSysroot;
-    const sk_sp<SkDataTable> fFamilyNames;
+    // Most callers never list the families, so the list is only made when first asked for.
+    mutable SkOnce fFamilyNamesOnce;
+    mutable sk_sp<SkDataTable> fFamilyNames;
+    mutable SkFontFallbackCache fFallbackCache;
 
     class StyleSet : public SkFontStyleSet {
     public:
@@ -602,21 +610,13 @@ class SkFontMgr_fontconfig : public SkFontMgr {
         SkAutoFcFontSet fFontSet;
     };
 
-    static bool FindName(const SkTDArray<const char*>& list, const char* str) {
-        int count = list.size();
-        for (int i = 0; i < count; ++i) {
-            if (!strcmp(list[i], str)) {
-                return true;
-            }
-        }
-        return false;
-    }
-
     static sk_sp<SkDataTable> GetFamilyNames(FcConfig* fcconfig) {
         FCLocker lock;
 
         SkTDArray<const char*> names;
         SkTDArray<size_t> sizes;
+        // The names point into the config's patterns, which outlive this.
+        THashSet<std::string_view> seen;
 
         static const FcSetName fcNameSet[] = { FcSetSystem, FcSetApplication };
         for (int setIndex = 0; setIndex < (int)std::size(fcNameSet); ++setIndex) {
@@ -638,7 +638,8 @@ class SkFontMgr_fontconfig : public SkFontMgr {
                         continue;
                     }
                     const char* familyName = reinterpret_cast<const char*>(fcFamilyName);
-                    if (familyName && !FindName(names, familyName)) {
+                    if (familyName && !seen.contains(familyName)) {
+                        seen.add(familyName);
                         *names.append() = familyName;
                         *sizes.append() = strlen(familyName) + 1;
                     }
@@ -656,7 +657,7 @@ class SkFontMgr_fontconfig : public SkFontMgr {
         return FcTrue == FcPatternEqual(cshFace->fPattern, ctxPattern);
     }
 
-    mutable SkMutex fTFCacheMutex;
+    mutable SkSharedMutex fTFCacheMutex;
     mutable SkTypefaceCache fTFCache;
     /** Creates a typeface using a typeface cache.
      *  @param pattern a complete pattern from FcFontRenderPrepare.
@@ -665,22 +666,36 @@ class SkFontMgr_fontconfig : public SkFontMgr {
         if (!pattern) {
             return nullptr;
         }
-        // Cannot hold FCLocker when calling fTFCache.add; an evicted typeface may need to lock.
-        // Must hold fTFCacheMutex when interacting with fTFCache.
-        SkAutoMutexExclusive ama(fTFCacheMutex);
-        sk_sp<SkTypeface> face = [&]() {
+        // Cached typefaces are filed by the hash of their pattern, so a lookup only compares
+        // patterns with the same hash.
+        const uint32_t key = [&]() {
+            FCLocker lock;
+            return FcPatternHash(pattern);
+        }();
+        auto find = [&]() {
             FCLocker lock;
-            sk_sp<SkTypeface> face = fTFCache.findByProcAndRef(FindByFcPattern, pattern);
+            sk_sp<SkTypeface> face = fTFCache.findByKeyAndProcAndRef(key, FindByFcPattern, pattern);
             if (face) {
                 pattern.reset();
             }
             return face;
-        }();
+        };
+        // Cannot hold FCLocker when calling fTFCache.add; an evicted typeface may need to lock.
+        // Must hold fTFCacheMutex when interacting with fTFCache. Most calls find a cached
+        // typeface, so look for one with the mutex shared first.
+        {
+            SkAutoSharedMutexShared shared(fTFCacheMutex);
+            if (sk_sp<SkTypeface> face = find()) {
+                return face;
+            }
+        }
+        SkAutoSharedMutexExclusive ama(fTFCacheMutex);
+        sk_sp<SkTypeface> face = find();
         if (!face) {
             face = SkTypeface_fontconfig::Make(std::move(pattern), fSysroot);
             if (face) {
                 // Cannot hold FCLocker in fTFCache.add; evicted typefaces may need to lock.
-                fTFCache.add(face);
+                fTFCache.add(face, key);
             }
         }
         return face;
@@ -690,26 +705,31 @@ public:
     /** Takes control of the reference to 'config'. */
     explicit SkFontMgr_fontconfig(FcConfig* config)
         : fFC(config ? config : FcInitLoadConfigAndFonts())
-        , fSysroot(reinterpret_cast<const char*>(FcConfigGetSysRoot(fFC)))
-        , fFamilyNames(GetFamilyNames(fFC)) { }
+        , fSysroot(reinterpret_cast<const char*>(FcConfigGetSysRoot(fFC))) { }
 
     ~SkFontMgr_fontconfig() override {
+        fFallbackCache.reset();
         // Hold the lock while unrefing the config.
         FCLocker lock;
         fFC.reset();
     }
 
 protected:
+    const SkDataTable& familyNames() const {
+        fFamilyNamesOnce([this] { fFamilyNames = GetFamilyNames(fFC); });
+        return *fFamilyNames;
+    }
+
     int onCountFamilies() const override {
-        return fFamilyNames->count();
+        return this->familyNames().count();
     }
 
     void onGetFamilyName(int index, SkString* familyName) const override {
-        familyName->set(fFamilyNames->atStr(index));
+        familyName->set(this->familyNames().atStr(index));
     }
 
     sk_sp<SkFontStyleSet> onCreateStyleSet(int index) const override {
-        return this->onMatchFamily(fFamilyNames->atStr(index));
+        return this->onMatchFamily(this->familyNames().atStr(index));
     }
 
     /** True if any string object value in the font is the same
@@ -890,13 +910,59 @@ protected:
         return createTypefaceFromFcPattern(std::move(font));
     }
 
+    /** The fonts FcFontSort() ranks for a request, best first, without regard to any character.
+     *  FcFontMatch() weighs covering the character above the family, style and languages, so its
+     *  choice for a character is (nearly always) the first of these fonts that covers it.
+     */
+    class FallbackChain : public SkFontFallbackCache::Chain {
+    public:
+        FallbackChain(const SkFontMgr_fontconfig* fontMgr, SkAutoFcPattern pattern,
+                      SkAutoFcFontSet fontSet, TArray<FcPattern*> fonts)
+            : fFontMgr(fontMgr)
+            , fPattern(std::move(pattern))
+            , fFontSet(std::move(fontSet))
+            , fFonts(std::move(fonts))
+        { }
+
+        ~FallbackChain() override {
+            // Hold the lock while unrefing the patterns.
+            FCLocker lock;
+            fFontSet.reset();
+            fPattern.reset();
+        }
+
+        int count() const override { return fFonts.size(); }
+
+        void getCoverage(int index, SkUnichar first,
+                         SkFontFallbackCache::Coverage* coverage) const override {
+            FCLocker lock;
+            for (int i = 0; i < SkFontFallbackCache::kBlockSize; ++i) {
+                coverage->set(i, FontContainsCharacter(fFonts[index], first + i));
+            }
+        }
+
+        sk_sp<SkTypeface> makeTypeface(int index) const override {
+            SkAutoFcPattern font([&]() {
+                FCLocker lock;
+                return FcFontRenderPrepare(fFontMgr->fFC, fPattern, fFonts[index]);
+            }());
+            return fFontMgr->createTypefaceFromFcPattern(std::move(font));
+        }
+
+    private:
+        const SkFontMgr_fontconfig* fFontMgr;  // Owns the cache which owns this.
+        SkAutoFcPattern fPattern;
+        SkAutoFcFontSet fFontSet;
+        TArray<FcPattern*> fFonts;  // The accessible fonts of fFontSet.
+    };
+
     sk_sp<SkTypeface> onMatchFamilyStyleCharacter(const char familyName[],
                                                   const SkFontStyle& style,
                                                   const char* bcp47[],
                                                   int bcp47Count,
                                                   SkUnichar character) const override
     {
-        SkAutoFcPattern font([&](){
+        return fFallbackCache.match(familyName, style, bcp47, bcp47Count, character, [&]() {
             FCLocker lock;
 
             SkAutoFcPattern pattern;
@@ -908,10 +974,6 @@ protected:
             }
             fcpattern_from_skfontstyle(style, pattern);
 
-            SkAutoFcCharSet charSet;
-            FcCharSetAddChar(charSet, character);
-            FcPatternAddCharSet(pattern, FC_CHARSET, charSet);
-
             if (bcp47Count > 0) {
                 SkASSERT(bcp47);
                 SkAutoFcLangSet langSet;
@@ -925,13 +987,18 @@ protected:
             FcDefaultSubstitute(pattern);
 
             FcResult result;
-            SkAutoFcPattern font(FcFontMatch(fFC, pattern, &result));
-            if (!font || !FontAccessible(font) || !FontContainsCharacter(font, character)) {
-                font.reset();
+            SkAutoFcFontSet fontSet(FcFontSort(fFC, pattern, FcFalse, nullptr, &result));
+            TArray<FcPattern*> fonts;
+            if (fontSet) {
+                for (int i = 0; i < fontSet->nfont; ++i) {
+                    if (FontAccessible(fontSet->fonts[i])) {
+                        fonts.push_back(fontSet->fonts[i]);
+                    }
+                }
             }
-            return font;
-        }());
-        return createTypefaceFromFcPattern(std::move(font));
+            return std::make_unique<FallbackChain>(this, std::move(pattern), std::move(fontSet),
+                                                   std::move(fonts));
+        });
     }
 
     sk_sp<SkTypeface> onMakeFromStreamIndex(std::unique_ptr<SkStreamAsset> stream,
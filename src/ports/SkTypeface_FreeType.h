@@ -42,6 +42,12 @@ public:
     static constexpr SkTypeface::FactoryId FactoryId = SkSetFourByteTag('f','r','e','e');
     static sk_sp<SkTypeface> MakeFromStream(std::unique_ptr<SkStreamAsset>, const SkFontArguments&);
 
+    /** Opens the font file at path. The file is mapped into memory once per process and the
+     *  mapping is shared by every stream opened on it, such as those of the faces of a font
+     *  collection, even after the typefaces using it go away. A file that has changed since it
+     *  was mapped is mapped again. Returns nullptr on failure. */
+    static std::unique_ptr<SkStreamAsset> MakeFileStream(const char path[]);
+
 protected:
     SkTypeface_FreeType(const SkFontStyle& style, bool isFixedPitch);
     ~SkTypeface_FreeType() override;
@@ -79,6 +85,8 @@ protected:
 private:
     mutable SkOnce fFTFaceOnce;
     mutable std::unique_ptr<FaceRec> fFaceRec;
+    // Whether fFaceRec was closed for being idle, and should be opened again when next used.
+    mutable bool fFaceRecEvicted = false;
 
     mutable SkSharedMutex fC2GCacheMutex;
     mutable SkCharToGlyphCache fC2GCache;
@@ -11,6 +11,7 @@
 #include "include/core/SkBitmap.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkFontMetrics.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkPictureRecorder.h"
@@ -19,9 +20,14 @@
 #include "include/pathops/SkPathOps.h"
 #include "src/core/SkFontDescriptor.h"
 #include "src/core/SkFontPriv.h"
+#include "src/core/SkTHash.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/ports/SkTypeface_fontations_priv.h"
 #include "src/ports/fontations/src/skpath_bridge.h"
 
+#include <algorithm>
+#include <vector>
+
 namespace {
 
 [[maybe_unused]] static inline const constexpr bool kSkShowTextBlitCoverage = false;
@@ -85,6 +91,93 @@ bool isAxisAligned(const SkScalerContextRec& rec) {
                                   bothZero(rec.fPost2x2[0][0], rec.fPost2x2[1][1]));
 }
 
+bool getPathForGlyphId(const fontations_ffi::BridgeOutlineCollection& outlines,
+                       const fontations_ffi::BridgeNormalizedCoords& coords,
+                       uint16_t glyphId,
+                       float yScale,
+                       const fontations_ffi::BridgeHintingInstance& hintingInstance,
+                       SkPath* path) {
+    sk_fontations::PathGeometrySink pathWrapper;
+    fontations_ffi::BridgeScalerMetrics scalerMetrics;
+
+    if (!fontations_ffi::get_path(outlines,
+                                  glyphId,
+                                  yScale,
+                                  coords,
+                                  hintingInstance,
+                                  pathWrapper,
+                                  scalerMetrics)) {
+        return false;
+    }
+    *path = std::move(pathWrapper).into_inner();
+    if (scalerMetrics.has_overlaps) {
+        // See SkScalerContext_FreeType_Base::generateGlyphPath.
+        Simplify(*path, path);
+        AsWinding(*path, path);
+    }
+    return true;
+}
+
+/** Records the glyphs whose outlines a COLR glyph clips or fills with, without drawing. */
+class OutlineCollector : public fontations_ffi::ColorPainterWrapper {
+public:
+    explicit OutlineCollector(std::vector<SkGlyphID>* glyphs) : fGlyphs(glyphs) {}
+
+    void push_transform(const fontations_ffi::Transform&) override {}
+    void pop_transform() override {}
+    void push_clip_glyph(uint16_t glyph_id) override { fGlyphs->push_back(glyph_id); }
+    void push_clip_rectangle(float, float, float, float) override {}
+    void pop_clip() override {}
+
+    void fill_solid(uint16_t, float) override {}
+    void fill_radial(const fontations_ffi::FillRadialParams&,
+                     fontations_ffi::BridgeColorStops&,
+                     uint8_t) override {}
+    void fill_linear(const fontations_ffi::FillLinearParams&,
+                     fontations_ffi::BridgeColorStops&,
+                     uint8_t) override {}
+    void fill_sweep(const fontations_ffi::FillSweepParams&,
+                    fontations_ffi::BridgeColorStops&,
+                    uint8_t) override {}
+
+    void fill_glyph_solid(uint16_t glyph_id, uint16_t, float) override {
+        fGlyphs->push_back(glyph_id);
+    }
+    void fill_glyph_radial(uint16_t glyph_id,
+                           const fontations_ffi::Transform&,
+                           const fontations_ffi::FillRadialParams&,
+                           fontations_ffi::BridgeColorStops&,
+                           uint8_t) override {
+        fGlyphs->push_back(glyph_id);
+    }
+    void fill_glyph_linear(uint16_t glyph_id,
+                           const fontations_ffi::Transform&,
+                           const fontations_ffi::FillLinearParams&,
+                           fontations_ffi::BridgeColorStops&,
+                           uint8_t) override {
+        fGlyphs->push_back(glyph_id);
+    }
+    void fill_glyph_sweep(uint16_t glyph_id,
+                          const fontations_ffi::Transform&,
+                          const fontations_ffi::FillSweepParams&,
+                          fontations_ffi::BridgeColorStops&,
+                          uint8_t) override {
+        fGlyphs->push_back(glyph_id);
+    }
+
+    void push_layer(uint8_t) override {}
+    void pop_layer() override {}
+
+private:
+    std::vector<SkGlyphID>* fGlyphs;
+};
+
+// Enough for the glyphs of a few pages of text, or the layers of a screenful of emoji.
+constexpr int kMaxCachedOutlines = 2048;
+
+// Extracting an outline takes a few microseconds, so don't hand tasks fewer than this many.
+constexpr size_t kMinOutlinesPerTask = 32;
+
 }  // namespace
 
 sk_sp<SkTypeface> SkTypeface_Make_Fontations(std::unique_ptr<SkStreamAsset> fontData,
@@ -92,6 +185,21 @@ sk_sp<SkTypeface> SkTypeface_Make_Fontations(std::unique_ptr<SkStreamAsset> font
     return SkTypeface_Fontations::MakeFromStream(std::move(fontData), args);
 }
 
+void SkTypeface_PrefetchFontationsOutlines(const SkTypeface* typeface,
+                                           SkSpan<const SkGlyphID> glyphs,
+                                           SkExecutor* executor) {
+    if (!typeface) {
+        return;
+    }
+    SkFontDescriptor desc;
+    bool isLocal = false;
+    typeface->getFontDescriptor(&desc, &isLocal);
+    if (desc.getFactoryId() != SkTypeface_Fontations::FactoryId) {
+        return;
+    }
+    static_cast<const SkTypeface_Fontations*>(typeface)->prefetchOutlines(glyphs, executor);
+}
+
 SkTypeface_Fontations::SkTypeface_Fontations(
         sk_sp<SkData> fontData,
         const SkFontStyle& style,
@@ -108,7 +216,8 @@ SkTypeface_Fontations::SkTypeface_Fontations(
         , fMappingIndex(std::move(mappingIndex))
         , fBridgeNormalizedCoords(std::move(normalizedCoords))
         , fOutlines(std::move(outlines))
-        , fPalette(std::move(palette)) {}
+        , fPalette(std::move(palette))
+        , fOutlineCache(kMaxCachedOutlines) {}
 
 sk_sp<SkTypeface> SkTypeface_Fontations::MakeFromStream(std::unique_ptr<SkStreamAsset> stream,
                                                         const SkFontArguments& args) {
@@ -259,6 +368,88 @@ size_t AxisWrapper::size() const { return fAxisCount; }
 
 }  // namespace sk_fontations
 
+bool SkTypeface_Fontations::extractUnscaledPath(SkGlyphID glyphId, SkPath* path) const {
+    // Unhinted outlines scale linearly, so extracting them at one unit per em unit gives the
+    // outline in font units.
+    uint16_t upem = fontations_ffi::units_per_em_or_zero(*fBridgeFontRef);
+    if (upem == 0) {
+        return false;
+    }
+    return getPathForGlyphId(*fOutlines, *fBridgeNormalizedCoords, glyphId, upem,
+                             *fontations_ffi::no_hinting_instance(), path);
+}
+
+void SkTypeface_Fontations::cacheUnscaledPath(SkGlyphID glyphId, const SkPath& path) const {
+    SkAutoMutexExclusive lock(fOutlineCacheMutex);
+    // Another thread may have extracted the same glyph in the meantime.
+    fOutlineCache.insert_or_update(glyphId, path);
+}
+
+bool SkTypeface_Fontations::getUnscaledPath(SkGlyphID glyphId, SkPath* path) const {
+    {
+        SkAutoMutexExclusive lock(fOutlineCacheMutex);
+        if (const SkPath* cached = fOutlineCache.find(glyphId)) {
+            *path = *cached;
+            return true;
+        }
+    }
+    // Extract without holding the lock so that other threads can use the cache meanwhile.
+    if (!this->extractUnscaledPath(glyphId, path)) {
+        return false;
+    }
+    this->cacheUnscaledPath(glyphId, *path);
+    return true;
+}
+
+void SkTypeface_Fontations::prefetchOutlines(SkSpan<const SkGlyphID> glyphs,
+                                             SkExecutor* executor) const {
+    // COLR glyphs are drawn with the outlines of other glyphs, so prefetch those instead.
+    std::vector<SkGlyphID> wanted;
+    OutlineCollector collector(&wanted);
+    for (SkGlyphID glyphId : glyphs) {
+        if (fontations_ffi::has_colrv1_glyph(*fBridgeFontRef, glyphId) ||
+            fontations_ffi::has_colrv0_glyph(*fBridgeFontRef, glyphId)) {
+            fontations_ffi::draw_colr_glyph(
+                    *fBridgeFontRef, *fBridgeNormalizedCoords, glyphId, collector);
+        } else {
+            wanted.push_back(glyphId);
+        }
+    }
+
+    std::vector<SkGlyphID> missing;
+    {
+        skia_private::THashSet<SkGlyphID> seen;
+        SkAutoMutexExclusive lock(fOutlineCacheMutex);
+        for (SkGlyphID glyphId : wanted) {
+            if (!seen.contains(glyphId) && !fOutlineCache.find(glyphId)) {
+                seen.add(glyphId);
+                missing.push_back(glyphId);
+            }
+        }
+    }
+    // Fetching more than the cache holds would only evict what was just fetched.
+    missing.resize(std::min(missing.size(), SkToSizeT(kMaxCachedOutlines)));
+
+    auto extractRange = [this, &missing](size_t start, size_t end) {
+        for (size_t i = start; i < end; ++i) {
+            SkPath path;
+            if (this->extractUnscaledPath(missing[i], &path)) {
+                this->cacheUnscaledPath(missing[i], path);
+            }
+        }
+    };
+    if (!executor || missing.size() < 2 * kMinOutlinesPerTask) {
+        extractRange(0, missing.size());
+        return;
+    }
+    SkTaskGroup tasks(*executor);
+    for (size_t start = 0; start < missing.size(); start += kMinOutlinesPerTask) {
+        size_t end = std::min(start + kMinOutlinesPerTask, missing.size());
+        tasks.add([&extractRange, start, end] { extractRange(start, end); });
+    }
+    tasks.wait();
+}
+
 int SkTypeface_Fontations::onGetUPEM() const {
     return fontations_ffi::units_per_em_or_zero(*fBridgeFontRef);
 }
@@ -425,32 +616,20 @@ public:
 
     // yScale is only used if hintinInstance is set to Unhinted,
     // otherwise the size is controlled by the configured hintingInstance.
-    // hintingInstance argument is needed as COLRv1 drawing performs unhinted,
-    // unscaled path retrieval.
     bool generateYScalePathForGlyphId(
             uint16_t glyphId,
             SkPath* path,
             float yScale,
             const fontations_ffi::BridgeHintingInstance& hintingInstance) {
-        sk_fontations::PathGeometrySink pathWrapper;
-        fontations_ffi::BridgeScalerMetrics scalerMetrics;
-
-        if (!fontations_ffi::get_path(fOutlines,
-                                      glyphId,
-                                      yScale,
-                                      fBridgeNormalizedCoords,
-                                      hintingInstance,
-                                      pathWrapper,
-                                      scalerMetrics)) {
-            return false;
-        }
-        *path = std::move(pathWrapper).into_inner();
-        if (scalerMetrics.has_overlaps) {
-            // See SkScalerContext_FreeType_Base::generateGlyphPath.
-            Simplify(*path, path);
-            AsWinding(*path, path);
-        }
-        return true;
+        return getPathForGlyphId(
+                fOutlines, fBridgeNormalizedCoords, glyphId, yScale, hintingInstance, path);
+    }
+
+    // Unhinted path in font units, as used for drawing COLR glyphs. It comes from the outline
+    // cache that the typeface shares across sizes.
+    bool generateUnscaledPathForGlyphId(uint16_t glyphId, SkPath* path) {
+        return static_cast<SkTypeface_Fontations*>(this->getTypeface())
+                ->getUnscaledPath(glyphId, path);
     }
 
 protected:
@@ -730,9 +909,15 @@ protected:
                     SkScalerContextRec::PreMatrixScale::kVertical, &scale, &remainingMatrix)) {
             return false;
         }
-        bool result = generateYScalePathForGlyphId(
-                glyph.getGlyphID(), path, scale.y(), *fHintingInstance);
-        if (!result) {
+        if (fRec.getHinting() == SkFontHinting::kNone) {
+            // Unhinted outlines only differ in scale, so use the cached one.
+            uint16_t upem = fontations_ffi::units_per_em_or_zero(fBridgeFontRef);
+            if (upem == 0 || !generateUnscaledPathForGlyphId(glyph.getGlyphID(), path)) {
+                return false;
+            }
+            remainingMatrix.preScale(scale.y() / upem, scale.y() / upem);
+        } else if (!generateYScalePathForGlyphId(
+                           glyph.getGlyphID(), path, scale.y(), *fHintingInstance)) {
             return false;
         }
 
@@ -1197,7 +1382,7 @@ void ColorPainter::pop_transform() { fCanvas.restore(); }
 void ColorPainter::push_clip_glyph(uint16_t glyph_id) {
     fCanvas.save();
     SkPath path;
-    fScalerContext.generateYScalePathForGlyphId(glyph_id, &path, fUpem, *fontations_ffi::no_hinting_instance());
+    fScalerContext.generateUnscaledPathForGlyphId(glyph_id, &path);
     fCanvas.clipPath(path, fAntialias);
 }
 
@@ -1230,7 +1415,7 @@ void ColorPainter::fill_solid(uint16_t palette_index, float alpha) {
 
 void ColorPainter::fill_glyph_solid(uint16_t glyph_id, uint16_t palette_index, float alpha) {
     SkPath path;
-    fScalerContext.generateYScalePathForGlyphId(glyph_id, &path, fUpem, *fontations_ffi::no_hinting_instance());
+    fScalerContext.generateUnscaledPathForGlyphId(glyph_id, &path);
 
     SkPaint paint;
     configure_solid_paint(palette_index, alpha, paint);
@@ -1293,7 +1478,7 @@ void ColorPainter::fill_glyph_linear(uint16_t glyph_id,
                                      fontations_ffi::BridgeColorStops& bridge_stops,
                                      uint8_t extend_mode) {
     SkPath path;
-    fScalerContext.generateYScalePathForGlyphId(glyph_id, &path, fUpem, *fontations_ffi::no_hinting_instance());
+    fScalerContext.generateUnscaledPathForGlyphId(glyph_id, &path);
 
     SkPaint paint;
     SkMatrix paintTransform = SkMatrixFromFontationsTransform(transform);
@@ -1450,7 +1635,7 @@ void ColorPainter::fill_glyph_radial(uint16_t glyph_id,
                                      fontations_ffi::BridgeColorStops& bridge_stops,
                                      uint8_t extend_mode) {
     SkPath path;
-    fScalerContext.generateYScalePathForGlyphId(glyph_id, &path, fUpem, *fontations_ffi::no_hinting_instance());
+    fScalerContext.generateUnscaledPathForGlyphId(glyph_id, &path);
 
     SkPaint paint;
     SkMatrix paintTransform = SkMatrixFromFontationsTransform(transform);
@@ -1515,7 +1700,7 @@ void ColorPainter::fill_glyph_sweep(uint16_t glyph_id,
                                     fontations_ffi::BridgeColorStops& bridge_stops,
                                     uint8_t extend_mode) {
     SkPath path;
-    fScalerContext.generateYScalePathForGlyphId(glyph_id, &path, fUpem, *fontations_ffi::no_hinting_instance());
+    fScalerContext.generateUnscaledPathForGlyphId(glyph_id, &path);
 
     SkPaint paint;
     SkMatrix paintTransform = SkMatrixFromFontationsTransform(transform);
@@ -1563,7 +1748,7 @@ void BoundsPainter::pop_transform() {
 
 void BoundsPainter::push_clip_glyph(uint16_t glyph_id) {
     SkPath path;
-    fScalerContext.generateYScalePathForGlyphId(glyph_id, &path, fUpem, *fontations_ffi::no_hinting_instance());
+    fScalerContext.generateUnscaledPathForGlyphId(glyph_id, &path);
     path.transform(fCurrentTransform);
     fBounds.join(path.getBounds());
 }
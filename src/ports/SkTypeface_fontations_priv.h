@@ -13,13 +13,17 @@
 #include "include/core/SkSpan.h"
 #include "include/core/SkStream.h"
 #include "include/core/SkTypeface.h"
+#include "include/private/base/SkMutex.h"
 #include "include/private/base/SkOnce.h"
+#include "include/private/base/SkThreadAnnotations.h"
 #include "src/core/SkAdvancedTypefaceMetrics.h"
+#include "src/core/SkLRUCache.h"
 #include "src/core/SkScalerContext.h"
 #include "src/ports/fontations/src/ffi.rs.h"
 
 #include <memory>
 
+class SkExecutor;
 class SkStreamAsset;
 class SkFontationsScalerContext;
 
@@ -223,6 +227,14 @@ public:
         return SkSpan<SkColor>(reinterpret_cast<SkColor*>(fPalette.data()), fPalette.size());
     }
 
+    // Returns the unhinted outline of 'glyphId' in font units. Outlines don't depend on the size,
+    // so they are cached here and shared by all the scaler contexts of this typeface.
+    bool getUnscaledPath(SkGlyphID glyphId, SkPath* path) const;
+
+    // Caches the outlines of 'glyphs', and those that their COLR paints clip and fill with,
+    // extracting them in parallel on 'executor' if it isn't null.
+    void prefetchOutlines(SkSpan<const SkGlyphID> glyphs, SkExecutor* executor) const;
+
     static constexpr SkTypeface::FactoryId FactoryId = SkSetFourByteTag('f', 'n', 't', 'a');
 
     static sk_sp<SkTypeface> MakeFromData(sk_sp<SkData> fontData, const SkFontArguments&);
@@ -266,6 +278,12 @@ private:
 
     mutable SkOnce fGlyphMasksMayNeedCurrentColorOnce;
     mutable bool fGlyphMasksMayNeedCurrentColor;
+
+    bool extractUnscaledPath(SkGlyphID glyphId, SkPath* path) const;
+    void cacheUnscaledPath(SkGlyphID glyphId, const SkPath& path) const;
+
+    mutable SkMutex fOutlineCacheMutex;
+    mutable SkLRUCache<SkGlyphID, SkPath> fOutlineCache SK_GUARDED_BY(fOutlineCacheMutex);
 };
 
 #endif  // SkTypeface_Fontations_DEFINED
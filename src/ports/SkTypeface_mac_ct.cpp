@@ -34,13 +34,13 @@
 #include "include/ports/SkTypeface_mac.h"
 #include "include/private/base/SkFixed.h"
 #include "include/private/base/SkMalloc.h"
-#include "include/private/base/SkMutex.h"
 #include "include/private/base/SkOnce.h"
 #include "include/private/base/SkTDArray.h"
 #include "include/private/base/SkTPin.h"
 #include "include/private/base/SkTemplates.h"
 #include "include/private/base/SkTo.h"
 #include "src/base/SkEndian.h"
+#include "src/base/SkSharedMutex.h"
 #include "src/base/SkUTF.h"
 #include "src/core/SkAdvancedTypefaceMetrics.h"
 #include "src/core/SkFontDescriptor.h"
@@ -167,7 +167,7 @@ static bool find_by_CTFontRef(SkTypeface* cached, void* context) {
 sk_sp<SkTypeface> SkTypeface_Mac::Make(SkUniqueCFRef<CTFontRef> font,
                                        OpszVariation opszVariation,
                                        std::unique_ptr<SkStreamAsset> providedData) {
-    static SkMutex gTFCacheMutex;
+    static SkSharedMutex gTFCacheMutex;
     static SkTypefaceCache gTFCache;
 
     SkASSERT(font);
@@ -187,12 +187,22 @@ sk_sp<SkTypeface> SkTypeface_Mac::Make(SkUniqueCFRef<CTFontRef> font,
         return makeTypeface();
     }
 
-    SkAutoMutexExclusive ama(gTFCacheMutex);
-    sk_sp<SkTypeface> face = gTFCache.findByProcAndRef(find_by_CTFontRef, (void*)font.get());
+    // CFEqual fonts have the same CFHash.
+    const uint32_t key = static_cast<uint32_t>(CFHash(font.get()));
+    {
+        SkAutoSharedMutexShared shared(gTFCacheMutex);
+        if (sk_sp<SkTypeface> face =
+                gTFCache.findByKeyAndProcAndRef(key, find_by_CTFontRef, (void*)font.get())) {
+            return face;
+        }
+    }
+    SkAutoSharedMutexExclusive ama(gTFCacheMutex);
+    sk_sp<SkTypeface> face =
+            gTFCache.findByKeyAndProcAndRef(key, find_by_CTFontRef, (void*)font.get());
     if (!face) {
         face = makeTypeface();
         if (face) {
-            gTFCache.add(face);
+            gTFCache.add(face, key);
         }
     }
     return face;
@@ -17,6 +17,8 @@
 #include "include/core/SkScalar.h"
 #include "include/core/SkShader.h"
 #include "include/core/SkTileMode.h"
+#include "include/core/SkYUVAInfo.h"
+#include "include/core/SkYUVAPixmaps.h"
 #include "include/private/base/SkMath.h"
 #include "modules/skcms/skcms.h"
 #include "src/base/SkArenaAlloc.h"
@@ -33,12 +35,16 @@
 #include "src/core/SkReadBuffer.h"
 #include "src/core/SkSamplingPriv.h"
 #include "src/core/SkWriteBuffer.h"
+#include "src/core/SkYUVAInfoLocation.h"
+#include "src/core/SkYUVMath.h"
 #include "src/image/SkImage_Base.h"
+#include "src/image/SkImage_Lazy.h"
 
 #ifdef SK_ENABLE_LEGACY_SHADERCONTEXT
 #include "src/shaders/SkBitmapProcShader.h"
 #endif
 
+#include <atomic>
 #include <optional>
 #include <tuple>
 #include <utility>
@@ -70,6 +76,12 @@ SkM44 SkImageShader::CubicResamplerMatrix(float B, float C) {
                              0,              0,                    -C,      (1.f/6)*B + C);
 }
 
+static std::atomic<bool> gUseRasterYUVAPlanes{false};
+
+void SkImageShader::SetUseRasterYUVAPlanes(bool usePlanes) {
+    gUseRasterYUVAPlanes.store(usePlanes, std::memory_order_relaxed);
+}
+
 /**
  *  We are faster in clamp, so always use that tiling when we can.
  */
@@ -506,6 +518,52 @@ static SkSamplingOptions tweak_sampling(SkSamplingOptions sampling, const SkMatr
     return SkSamplingOptions(filter, sampling.mipmap);
 }
 
+// Fills `ctx` with the 8-bit YUVA planes that `image` decodes to, returning the data that owns
+// them, or null if the image has no such planes or they need more than scaling to line up.
+static sk_sp<SkCachedData> yuva_planes(const SkImage_Lazy* image,
+                                       SkRasterPipeline_YUVACtx* ctx,
+                                       SkYUVAInfo* yuvaInfo) {
+    SkYUVAPixmapInfo::SupportedDataTypes dataTypes;
+    for (int numChannels = 1; numChannels <= 4; ++numChannels) {
+        dataTypes.enableDataType(SkYUVAPixmapInfo::DataType::kUnorm8, numChannels);
+    }
+    SkYUVAPixmaps pixmaps;
+    sk_sp<SkCachedData> data = image->getPlanes(dataTypes, &pixmaps);
+    // Previously cached planes may have been decoded for another data type.
+    if (!data || pixmaps.dataType() != SkYUVAPixmaps::DataType::kUnorm8) {
+        return nullptr;
+    }
+    const SkYUVAInfo& info = pixmaps.yuvaInfo();
+    if (info.origin() != kTopLeft_SkEncodedOrigin ||
+        info.sitingX() != SkYUVAInfo::Siting::kCentered ||
+        info.sitingY() != SkYUVAInfo::Siting::kCentered) {
+        return nullptr;
+    }
+
+    SkYUVAInfo::YUVALocations locations = pixmaps.toYUVALocations();
+    for (int i = 0; i < SkYUVAInfo::kYUVAChannelCount; ++i) {
+        ctx->pixels[i] = nullptr;
+        if (locations[i].fPlane < 0) {
+            SkASSERT(i == SkYUVAInfo::kA);
+            continue;
+        }
+        const SkPixmap& plane = pixmaps.plane(locations[i].fPlane);
+        int bpp = plane.info().bytesPerPixel();
+        // Single channel planes (gray or alpha) hold their value in their only byte.
+        int offset = bpp == 1 ? 0 : static_cast<int>(locations[i].fChannel);
+
+        ctx->pixels[i]        = static_cast<const uint8_t*>(plane.addr()) + offset;
+        ctx->stride[i]        = static_cast<int>(plane.rowBytes());
+        ctx->bytesPerPixel[i] = bpp;
+        ctx->width[i]         = plane.width();
+        ctx->height[i]        = plane.height();
+        ctx->scaleX[i]        = static_cast<float>(plane.width())  / image->width();
+        ctx->scaleY[i]        = static_cast<float>(plane.height()) / image->height();
+    }
+    *yuvaInfo = info;
+    return data;
+}
+
 bool SkImageShader::appendStages(const SkStageRec& rec, const SkShaders::MatrixRec& mRec) const {
     SkASSERT(!needs_subset(fImage.get(), fSubset));  // TODO(skbug.com/12784)
 
@@ -527,6 +585,41 @@ bool SkImageShader::appendStages(const SkStageRec& rec, const SkShaders::MatrixR
         baseInv.normalizePerspective();
     }
 
+    // Lazy images that decode to YUVA planes can be sampled from those planes, converting to RGB
+    // per pixel rather than decoding the whole image to RGBA first.
+    if (!fRaw && !sampling.useCubic && sampling.mipmap == SkMipmapMode::kNone &&
+        fTileModeX == SkTileMode::kClamp && fTileModeY == SkTileMode::kClamp &&
+        gUseRasterYUVAPlanes.load(std::memory_order_relaxed) &&
+        as_IB(fImage)->type() == SkImage_Base::Type::kLazy) {
+        auto* yuva = alloc->make<SkRasterPipeline_YUVACtx>();
+        SkYUVAInfo yuvaInfo;
+        if (sk_sp<SkCachedData> planes = yuva_planes(static_cast<const SkImage_Lazy*>(fImage.get()),
+                                                     yuva, &yuvaInfo)) {
+            // The arena keeps the planes locked for as long as the pipeline may read them.
+            alloc->make<sk_sp<SkCachedData>>(std::move(planes));
+
+            if (mRec.totalMatrixIsValid()) {
+                sampling = tweak_sampling(sampling, baseInv);
+            }
+            if (!mRec.apply(rec)) {
+                return false;
+            }
+            yuva->linear = sampling.filter == SkFilterMode::kLinear;
+
+            auto* yuvToRGB = alloc->makeArrayDefault<float>(20);
+            SkColorMatrix_YUV2RGB(yuvaInfo.yuvColorSpace(), yuvToRGB);
+
+            p->append(SkRasterPipelineOp::sample_yuva, yuva);
+            p->append(SkRasterPipelineOp::matrix_4x5, yuvToRGB);
+            p->append(SkRasterPipelineOp::clamp_01);
+
+            SkAlphaType at = yuvaInfo.hasAlpha() ? kUnpremul_SkAlphaType : kOpaque_SkAlphaType;
+            alloc->make<SkColorSpaceXformSteps>(fImage->colorSpace(), at,
+                                                rec.fDstCS, kPremul_SkAlphaType)->apply(p);
+            return true;
+        }
+    }
+
     SkASSERT(!sampling.useCubic || sampling.mipmap == SkMipmapMode::kNone);
     auto* access = SkMipmapAccessor::Make(alloc, fImage.get(), baseInv, sampling.mipmap);
     if (!access) {
@@ -722,9 +815,13 @@ bool SkImageShader::appendStages(const SkStageRec& rec, const SkShaders::MatrixR
     if (true
         && (ct == kRGBA_8888_SkColorType || ct == kBGRA_8888_SkColorType)
         && sampling.useCubic
-        && fTileModeX == SkTileMode::kClamp && fTileModeY == SkTileMode::kClamp) {
+        && fTileModeX == fTileModeY
+        && (fTileModeX == SkTileMode::kClamp || fTileModeX == SkTileMode::kRepeat)) {
 
-        p->append(SkRasterPipelineOp::bicubic_clamp_8888, upper.gather);
+        // These have lowp implementations, so high quality scaling need not leave lowp.
+        p->append(fTileModeX == SkTileMode::kClamp ? SkRasterPipelineOp::bicubic_clamp_8888
+                                                   : SkRasterPipelineOp::bicubic_repeat_8888,
+                  upper.gather);
         if (ct == kBGRA_8888_SkColorType) {
             p->append(SkRasterPipelineOp::swap_rb);
         }
@@ -63,6 +63,10 @@ public:
 
     static SkM44 CubicResamplerMatrix(float B, float C);
 
+    // Lets raster drawing of lazy images that decode to 8-bit YUVA planes sample the planes
+    // directly instead of decoding to RGBA first. Off by default.
+    static void SetUseRasterYUVAPlanes(bool);
+
     SkTileMode tileModeX() const { return fTileModeX; }
     SkTileMode tileModeY() const { return fTileModeY; }
     sk_sp<SkImage> image() const { return fImage; }
@@ -9,19 +9,95 @@
 
 #include "include/core/SkColor.h"
 #include "include/core/SkColorSpace.h"
+#include "include/core/SkImage.h"
 #include "include/core/SkRefCnt.h"
+#include "include/core/SkSamplingOptions.h"
 #include "include/core/SkShader.h"
+#include "include/core/SkTileMode.h"
 #include "include/effects/SkPerlinNoiseShader.h"
 #include "src/base/SkArenaAlloc.h"
 #include "src/core/SkEffectPriv.h"
+#include "src/core/SkImageInfoPriv.h"
 #include "src/core/SkRasterPipeline.h"
 #include "src/core/SkRasterPipelineOpContexts.h"
 #include "src/core/SkRasterPipelineOpList.h"
 #include "src/core/SkReadBuffer.h"
+#include "src/core/SkResourceCache.h"
 #include "src/core/SkWriteBuffer.h"
 #include "src/shaders/SkPerlinNoiseShaderType.h"
 
+#include <atomic>
+#include <cstddef>
 #include <optional>
+#include <utility>
+
+class SkDiscardableMemory;
+
+namespace {
+std::atomic<bool> gUseRasterTileCache{false};
+
+static unsigned gNoiseTileKeyNamespaceLabel;
+
+struct NoiseTileKey : public SkResourceCache::Key {
+public:
+    NoiseTileKey(SkPerlinNoiseShaderType type,
+                 SkScalar baseFrequencyX,
+                 SkScalar baseFrequencyY,
+                 int numOctaves,
+                 SkScalar seed,
+                 SkISize tileSize)
+            : fType(static_cast<uint32_t>(type))
+            , fBaseFrequencyX(baseFrequencyX)
+            , fBaseFrequencyY(baseFrequencyY)
+            , fNumOctaves(numOctaves)
+            , fSeed(seed)
+            , fTileSize(tileSize) {
+        static const size_t keySize = sizeof(fType) +
+                                      sizeof(fBaseFrequencyX) +
+                                      sizeof(fBaseFrequencyY) +
+                                      sizeof(fNumOctaves) +
+                                      sizeof(fSeed) +
+                                      sizeof(fTileSize);
+        // This better be packed.
+        SkASSERT(sizeof(uint32_t) * (&fEndOfStruct - &fType) == keySize);
+        this->init(&gNoiseTileKeyNamespaceLabel, 0, keySize);
+    }
+
+private:
+    uint32_t fType;
+    SkScalar fBaseFrequencyX;
+    SkScalar fBaseFrequencyY;
+    int32_t  fNumOctaves;
+    SkScalar fSeed;
+    SkISize  fTileSize;
+
+    SkDEBUGCODE(uint32_t fEndOfStruct;)
+};
+
+struct NoiseTileRec : public SkResourceCache::Rec {
+    NoiseTileRec(const NoiseTileKey& key, sk_sp<SkImage> image)
+        : fKey(key)
+        , fImage(std::move(image)) {}
+
+    NoiseTileKey   fKey;
+    sk_sp<SkImage> fImage;
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override {
+        return sizeof(fKey) + (size_t)fImage->width() * fImage->height() * 4;
+    }
+    const char* getCategory() const override { return "noise-tile"; }
+    SkDiscardableMemory* diagnostic_only_getDiscardable() const override { return nullptr; }
+
+    static bool Visitor(const SkResourceCache::Rec& baseRec, void* contextImage) {
+        const NoiseTileRec& rec = static_cast<const NoiseTileRec&>(baseRec);
+        sk_sp<SkImage>* result = reinterpret_cast<sk_sp<SkImage>*>(contextImage);
+
+        *result = rec.fImage;
+        return true;
+    }
+};
+}  // namespace
 
 SkPerlinNoiseShader::SkPerlinNoiseShader(SkPerlinNoiseShaderType type,
                                          SkScalar baseFrequencyX,
@@ -80,18 +156,16 @@ void SkPerlinNoiseShader::flatten(SkWriteBuffer& buffer) const {
     buffer.writeInt(fTileSize.fHeight);
 }
 
-bool SkPerlinNoiseShader::appendStages(const SkStageRec& rec,
-                                       const SkShaders::MatrixRec& mRec) const {
-    std::optional<SkShaders::MatrixRec> newMRec = mRec.apply(rec);
-    if (!newMRec.has_value()) {
-        return false;
-    }
+void SkPerlinNoiseShader::SetUseRasterTileCache(bool useCache) {
+    gUseRasterTileCache.store(useCache, std::memory_order_relaxed);
+}
 
+void SkPerlinNoiseShader::appendNoiseStage(SkRasterPipeline* p, SkArenaAlloc* alloc) const {
     fInitPaintingDataOnce([&] {
         const_cast<SkPerlinNoiseShader*>(this)->fPaintingData = this->getPaintingData();
     });
 
-    auto* ctx = rec.fAlloc->make<SkRasterPipeline_PerlinNoiseCtx>();
+    auto* ctx = alloc->make<SkRasterPipeline_PerlinNoiseCtx>();
     ctx->noiseType = fType;
     ctx->baseFrequencyX = fPaintingData->fBaseFrequency.fX;
     ctx->baseFrequencyY = fPaintingData->fBaseFrequency.fY;
@@ -102,7 +176,67 @@ bool SkPerlinNoiseShader::appendStages(const SkStageRec& rec,
     ctx->latticeSelector = fPaintingData->fLatticeSelector;
     ctx->noiseData = &fPaintingData->fNoise[0][0][0];
 
-    rec.fPipeline->append(SkRasterPipelineOp::perlin_noise, ctx);
+    p->append(SkRasterPipelineOp::perlin_noise, ctx);
+}
+
+// Returns one tile of stitched noise, shaded exactly as appendStages() would with an identity
+// matrix. The pixels are not tagged with a color space since the noise stage does no conversion.
+sk_sp<SkImage> SkPerlinNoiseShader::cachedTile() const {
+    NoiseTileKey key(fType, fBaseFrequencyX, fBaseFrequencyY, fNumOctaves, fSeed, fTileSize);
+
+    sk_sp<SkImage> image;
+    if (SkResourceCache::Find(key, NoiseTileRec::Visitor, &image)) {
+        return image;
+    }
+
+    SkBitmap bitmap;
+    if (!bitmap.tryAllocPixels(SkImageInfo::MakeN32Premul(fTileSize))) {
+        return nullptr;
+    }
+    SkSTArenaAlloc<256> alloc;
+    SkRasterPipeline p(&alloc);
+    SkRasterPipeline_MemoryCtx dst = {bitmap.getPixels(), bitmap.rowBytesAsPixels()};
+    p.append(SkRasterPipelineOp::seed_shader);
+    this->appendNoiseStage(&p, &alloc);
+    p.appendStore(bitmap.colorType(), &dst);
+    p.run(0, 0, fTileSize.width(), fTileSize.height());
+    bitmap.setImmutable();
+
+    image = bitmap.asImage();
+    SkResourceCache::Add(new NoiseTileRec(key, image));
+    return image;
+}
+
+bool SkPerlinNoiseShader::appendStages(const SkStageRec& rec,
+                                       const SkShaders::MatrixRec& mRec) const {
+    // Stitched noise is continuous across tile edges, so it can be shaded once per tile and then
+    // drawn like an image. Outside the first tile this repeats the tile exactly, which shading
+    // every pixel only does approximately.
+    const int dstBits = SkColorTypeMaxBitsPerChannel(rec.fDstColorType);
+    if (gUseRasterTileCache.load(std::memory_order_relaxed) && fStitchTiles &&
+        dstBits > 0 && dstBits <= 8 &&
+        (int64_t)fTileSize.width() * fTileSize.height() <= kMaxCachedTilePixels) {
+        if (sk_sp<SkImage> tile = this->cachedTile()) {
+            // Tag the tile with the destination color space so drawing it converts nothing.
+            if (rec.fDstCS) {
+                tile = tile->reinterpretColorSpace(sk_ref_sp(rec.fDstCS));
+            }
+            // Keep the image shader alive by using alloc instead of stack memory.
+            auto& tileShader = *rec.fAlloc->make<sk_sp<SkShader>>();
+            tileShader = tile->makeShader(SkTileMode::kRepeat, SkTileMode::kRepeat,
+                                          SkSamplingOptions(SkFilterMode::kLinear));
+            if (tileShader) {
+                return as_SB(tileShader)->appendStages(rec, mRec);
+            }
+        }
+    }
+
+    std::optional<SkShaders::MatrixRec> newMRec = mRec.apply(rec);
+    if (!newMRec.has_value()) {
+        return false;
+    }
+
+    this->appendNoiseStage(rec.fPipeline, rec.fAlloc);
     return true;
 }
 
@@ -26,6 +26,9 @@
 #include <cstring>
 #include <memory>
 
+class SkArenaAlloc;
+class SkImage;
+class SkRasterPipeline;
 class SkReadBuffer;
 enum class SkPerlinNoiseShaderType;
 struct SkStageRec;
@@ -257,12 +260,23 @@ public:
 
     bool appendStages(const SkStageRec& rec, const SkShaders::MatrixRec& mRec) const override;
 
+    // When enabled, stitched noise drawn on the CPU to destinations with at most 8 bits per
+    // channel is rendered once per tile into a cached image and then repeated with an image
+    // shader. Off by default; see SkGraphics::SetRasterNoiseTileCache().
+    static void SetUseRasterTileCache(bool);
+
 protected:
     void flatten(SkWriteBuffer&) const override;
 
 private:
     SK_FLATTENABLE_HOOKS(SkPerlinNoiseShader)
 
+    // Tiles with more pixels than this are always shaded per pixel.
+    static constexpr int kMaxCachedTilePixels = 1024 * 1024;
+
+    void appendNoiseStage(SkRasterPipeline*, SkArenaAlloc*) const;
+    sk_sp<SkImage> cachedTile() const;
+
     const SkPerlinNoiseShaderType fType;
     const SkScalar fBaseFrequencyX;
     const SkScalar fBaseFrequencyY;
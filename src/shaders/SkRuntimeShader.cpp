@@ -22,6 +22,7 @@
 #include "src/core/SkPicturePriv.h"
 #include "src/core/SkReadBuffer.h"
 #include "src/core/SkRuntimeEffectPriv.h"
+#include "src/core/SkRuntimeEffectProfiler.h"
 #include "src/core/SkWriteBuffer.h"
 #include "src/shaders/SkShaderBase.h"
 #include "src/sksl/codegen/SkSLRasterPipelineBuilder.h"
@@ -94,7 +95,9 @@ bool SkRuntimeShader::appendStages(const SkStageRec& rec, const SkShaders::Matri
                                                     rec.fDstCS,
                                                     rec.fAlloc);
         RuntimeEffectRPCallbacks callbacks(rec, *newMRec, fChildren, fEffect->fSampleUsages);
+        auto* profile = SkRuntimeEffectProfiler::Global()->appendBegin(rec, *fEffect);
         bool success = program->appendStages(rec.fPipeline, rec.fAlloc, &callbacks, uniforms);
+        SkRuntimeEffectProfiler::AppendEnd(rec, profile);
         return success;
     }
     return false;
@@ -15,19 +15,25 @@
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkShader.h"
 #include "include/core/SkTileMode.h"
+#include "include/core/SkStream.h"
 #include "include/private/SkColorData.h"
 #include "include/private/base/SkFloatingPoint.h"
 #include "include/private/base/SkMalloc.h"
+#include "include/private/base/SkMutex.h"
 #include "include/private/base/SkTArray.h"
 #include "include/private/base/SkTPin.h"
 #include "include/private/base/SkTo.h"
 #include "src/base/SkArenaAlloc.h"
 #include "src/base/SkFloatBits.h"
+#include "src/base/SkNoDestructor.h"
 #include "src/base/SkVx.h"
+#include "src/core/SkChecksum.h"
 #include "src/core/SkColorSpacePriv.h"
 #include "src/core/SkColorSpaceXformSteps.h"
 #include "src/core/SkConvertPixels.h"
 #include "src/core/SkEffectPriv.h"
+#include "src/core/SkImageInfoPriv.h"
+#include "src/core/SkLRUCache.h"
 #include "src/core/SkPicturePriv.h"
 #include "src/core/SkRasterPipeline.h"
 #include "src/core/SkRasterPipelineOpContexts.h"
@@ -36,6 +42,7 @@
 #include "src/core/SkWriteBuffer.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <optional>
 #include <utility>
@@ -526,6 +533,157 @@ void SkGradientBaseShader::AppendInterpolatedToDstStages(SkRasterPipeline* p,
             ->apply(p);
 }
 
+namespace {
+// Number of evenly spaced samples of t in [0,1] in a raster gradient table. At 8 bits per channel
+// this keeps the error from sampling the nearest entry below one step for most gradients.
+constexpr int kLUTSampleCount = 1024;
+constexpr int kLUTEntryCount = kLUTSampleCount + 2;
+constexpr int kLUTCacheCount = 32;
+
+std::atomic<bool> gUseRasterLUT{false};
+
+// Tables are keyed by the exact stops, interpolation and color spaces, so identical gradients
+// made by different shaders (e.g. re-recorded every frame) share one.
+struct LUTKey {
+    sk_sp<SkData> fData;
+
+    bool operator==(const LUTKey& that) const { return fData->equals(that.fData.get()); }
+};
+
+struct LUTKeyHash {
+    uint32_t operator()(const LUTKey& key) const {
+        return SkChecksum::Hash32(key.fData->data(), key.fData->size());
+    }
+};
+
+struct LUTCache {
+    SkMutex fMutex;
+    SkLRUCache<LUTKey, sk_sp<SkData>, LUTKeyHash> fTables SK_GUARDED_BY(fMutex){kLUTCacheCount};
+};
+
+LUTCache& lut_cache() {
+    static SkNoDestructor<LUTCache> gCache;
+    return *gCache;
+}
+}  // namespace
+
+static void write_lut_color_space(SkWStream* stream, const SkColorSpace* cs) {
+    // A null color space writes all zeros, which no real color space has.
+    skcms_TransferFunction tf = {};
+    skcms_Matrix3x3 toXYZD50 = {};
+    if (cs) {
+        cs->transferFn(&tf);
+        cs->toXYZD50(&toXYZD50);
+    }
+    stream->write(&tf, sizeof(tf));
+    stream->write(&toXYZD50, sizeof(toXYZD50));
+}
+
+static LUTKey make_lut_key(const SkGradientBaseShader* shader, const SkColorSpace* dstCS) {
+    const SkGradientShader::Interpolation& interpolation = shader->fInterpolation;
+
+    SkDynamicMemoryWStream stream;
+    stream.write32(SkToU32(shader->fColorCount));
+    stream.write32(shader->fPositions ? 1 : 0);
+    stream.write32(static_cast<uint32_t>(interpolation.fInPremul));
+    stream.write32(static_cast<uint32_t>(interpolation.fColorSpace));
+    stream.write32(static_cast<uint32_t>(interpolation.fHueMethod));
+    stream.write(shader->fColors, shader->fColorCount * sizeof(SkColor4f));
+    if (shader->fPositions) {
+        stream.write(shader->fPositions, shader->fColorCount * sizeof(SkScalar));
+    }
+    write_lut_color_space(&stream, shader->fColorSpace.get());
+    write_lut_color_space(&stream, dstCS);
+    return {stream.detachAsData()};
+}
+
+// Runs the gradient's own stages over the table's t values, so the table matches the unbaked
+// gradient at each sample for every interpolation color space.
+static sk_sp<SkData> make_lut(const SkGradientBaseShader* shader, SkColorSpace* dstCS) {
+    skia_private::AutoTMalloc<float> src(4 * kLUTEntryCount);
+    for (int i = 0; i < kLUTEntryCount; ++i) {
+        float t;
+        if (i == 0) {
+            t = -1;
+        } else if (i == kLUTEntryCount - 1) {
+            t = 2;
+        } else {
+            t = (i - 1) / static_cast<float>(kLUTSampleCount - 1);
+        }
+        src[4*i + 0] = t;
+        src[4*i + 1] = 0;
+        src[4*i + 2] = 0;
+        src[4*i + 3] = 1;
+    }
+    sk_sp<SkData> lut = SkData::MakeUninitialized(kLUTEntryCount * sizeof(uint32_t));
+
+    SkSTArenaAlloc<2048> alloc;
+    SkRasterPipeline p(&alloc);
+    SkRasterPipeline_MemoryCtx srcCtx = {src.get(), 0},
+                               dstCtx = {lut->writable_data(), 0};
+    p.append(SkRasterPipelineOp::load_f32, &srcCtx);
+
+    SkColor4fXformer xformedColors(shader, dstCS);
+    if (!xformedColors.fPositions) {
+        // Evenly spaced stops are always evaluated with t clamped, see appendStages().
+        p.append(SkRasterPipelineOp::clamp_x_1);
+    }
+    SkGradientBaseShader::AppendGradientFillStages(&p, &alloc,
+                                                   xformedColors.fColors.begin(),
+                                                   xformedColors.fPositions,
+                                                   xformedColors.fColors.size());
+    SkGradientBaseShader::AppendInterpolatedToDstStages(
+            &p, &alloc, shader->colorsAreOpaque(), shader->fInterpolation,
+            xformedColors.fIntermediateColorSpace.get(), dstCS);
+    p.append(SkRasterPipelineOp::store_8888, &dstCtx);
+    p.run(0, 0, kLUTEntryCount, 1);
+    return lut;
+}
+
+static sk_sp<SkData> find_or_make_lut(const SkGradientBaseShader* shader, SkColorSpace* dstCS) {
+    LUTKey key = make_lut_key(shader, dstCS);
+    LUTCache& cache = lut_cache();
+    {
+        SkAutoMutexExclusive lock(cache.fMutex);
+        if (sk_sp<SkData>* lut = cache.fTables.find(key)) {
+            return *lut;
+        }
+    }
+
+    sk_sp<SkData> lut = make_lut(shader, dstCS);
+
+    SkAutoMutexExclusive lock(cache.fMutex);
+    if (sk_sp<SkData>* existing = cache.fTables.find(key)) {
+        return *existing;
+    }
+    cache.fTables.insert(std::move(key), lut);
+    return lut;
+}
+
+void SkGradientBaseShader::SetUseRasterLUT(bool useLUT) {
+    gUseRasterLUT.store(useLUT, std::memory_order_relaxed);
+}
+
+void SkGradientBaseShader::PurgeRasterLUTCache() {
+    LUTCache& cache = lut_cache();
+    SkAutoMutexExclusive lock(cache.fMutex);
+    cache.fTables.reset();
+}
+
+bool SkGradientBaseShader::useRasterLUT(SkColorType dstColorType) const {
+    if (!gUseRasterLUT.load(std::memory_order_relaxed)) {
+        return false;
+    }
+    // Two evenly spaced stops are already a single multiply-add per channel.
+    if (fColorCount <= 2 && !fPositions) {
+        return false;
+    }
+    // The table holds 8 bits per channel, which is all the destination keeps. sRGB-encoded
+    // destinations are excluded since they are shaded in linear space.
+    const int bits = SkColorTypeMaxBitsPerChannel(dstColorType);
+    return bits > 0 && bits <= 8 && dstColorType != kSRGBA_8888_SkColorType;
+}
+
 bool SkGradientBaseShader::appendStages(const SkStageRec& rec,
                                         const SkShaders::MatrixRec& mRec) const {
     SkRasterPipeline* p = rec.fPipeline;
@@ -566,14 +724,27 @@ bool SkGradientBaseShader::appendStages(const SkStageRec& rec,
             break;
     }
 
-    // Transform all of the colors to destination color space, possibly premultiplied
-    SkColor4fXformer xformedColors(this, rec.fDstCS);
-    AppendGradientFillStages(p, alloc,
-                             xformedColors.fColors.begin(),
-                             xformedColors.fPositions,
-                             xformedColors.fColors.size());
-    AppendInterpolatedToDstStages(p, alloc, fColorsAreOpaque, fInterpolation,
-                                  xformedColors.fIntermediateColorSpace.get(), rec.fDstCS);
+    if (this->useRasterLUT(rec.fDstColorType)) {
+        // The table already holds premul colors in the destination color space, and sampling
+        // it has a lowp implementation.
+        sk_sp<SkData> lut = find_or_make_lut(this, rec.fDstCS);
+        auto ctx = alloc->make<SkRasterPipeline_GradientLUTCtx>();
+        ctx->table = static_cast<const uint32_t*>(lut->data());
+        ctx->scale = kLUTSampleCount - 1;
+        ctx->lastIndex = kLUTEntryCount - 1;
+        p->append(SkRasterPipelineOp::gradient_lut, ctx);
+        // Keep the table alive for as long as the pipeline.
+        alloc->make<sk_sp<SkData>>(std::move(lut));
+    } else {
+        // Transform all of the colors to destination color space, possibly premultiplied
+        SkColor4fXformer xformedColors(this, rec.fDstCS);
+        AppendGradientFillStages(p, alloc,
+                                 xformedColors.fColors.begin(),
+                                 xformedColors.fPositions,
+                                 xformedColors.fColors.size());
+        AppendInterpolatedToDstStages(p, alloc, fColorsAreOpaque, fInterpolation,
+                                      xformedColors.fIntermediateColorSpace.get(), rec.fDstCS);
+    }
 
     if (decal_ctx) {
         p->append(SkRasterPipelineOp::check_decal_mask, decal_ctx);
@@ -11,6 +11,7 @@
 #include "include/core/SkBitmap.h"
 #include "include/core/SkColor.h"
 #include "include/core/SkColorSpace.h"
+#include "include/core/SkColorType.h"
 #include "include/core/SkMatrix.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkScalar.h"
@@ -93,6 +94,12 @@ public:
                                                   sk_sp<SkColorSpace> colorSpace,
                                                   SkTileMode mode);
 
+    // When enabled, raster gradients drawn to destinations with at most 8 bits per channel sample
+    // a cached table of their colors instead of searching the stops for every pixel. Off by
+    // default; see SkGraphics::SetRasterGradientLUT().
+    static void SetUseRasterLUT(bool);
+    static void PurgeRasterLUTCache();
+
     // The default SkScalarNearlyZero threshold of .0024 is too big and causes regressions for svg
     // gradients defined in the wild.
     static constexpr SkScalar kDegenerateThreshold = SK_Scalar1 / (1 << 15);
@@ -106,6 +113,8 @@ protected:
 
     bool appendStages(const SkStageRec&, const SkShaders::MatrixRec&) const override;
 
+    bool useRasterLUT(SkColorType dstColorType) const;
+
     virtual void appendGradientStages(SkArenaAlloc* alloc,
                                       SkRasterPipeline* tPipeline,
                                       SkRasterPipeline* postPipeline) const = 0;
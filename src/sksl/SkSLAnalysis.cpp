@@ -500,6 +500,10 @@ int Analysis::NodeCountUpToLimit(const FunctionDefinition& function, int limit)
     return NodeCountVisitor{limit}.visit(*function.body());
 }
 
+int Analysis::NodeCountUpToLimit(const Statement& stmt, int limit) {
+    return NodeCountVisitor{limit}.visit(stmt);
+}
+
 bool Analysis::StatementWritesToVariable(const Statement& stmt, const Variable& var) {
     return VariableWriteVisitor(&var).visit(stmt);
 }
@@ -105,6 +105,7 @@ bool IsDynamicallyUniformExpression(const Expression& expr);
 bool DetectVarDeclarationWithoutScope(const Statement& stmt, ErrorReporter* errors = nullptr);
 
 int NodeCountUpToLimit(const FunctionDefinition& function, int limit);
+int NodeCountUpToLimit(const Statement& stmt, int limit);
 
 /**
  * Finds unconditional exits from a switch-case. Returns true if this statement unconditionally
@@ -18,6 +18,7 @@
 #include "src/sksl/SkSLPool.h"
 #include "src/sksl/SkSLProgramKind.h"
 #include "src/sksl/SkSLProgramSettings.h"
+#include "src/sksl/SkSLRehydrator.h"
 #include "src/sksl/analysis/SkSLProgramUsage.h"
 #include "src/sksl/ir/SkSLProgram.h"
 #include "src/sksl/ir/SkSLSymbolTable.h"  // IWYU pragma: keep
@@ -112,6 +113,8 @@ void Compiler::FinalizeSettings(ProgramSettings* settings, ProgramKind kind) {
     settings->fInlineThreshold *= (int)settings->fOptimize;
     settings->fRemoveDeadFunctions &= settings->fOptimize;
     settings->fRemoveDeadVariables &= settings->fOptimize;
+    settings->fUnrollLoopThreshold *= (int)settings->fOptimize;
+    settings->fEliminateCommonSubexpressions &= settings->fOptimize;
 
     // Runtime effects always allow narrowing conversions.
     if (ProgramConfig::IsRuntimeEffect(kind)) {
@@ -204,6 +207,35 @@ std::unique_ptr<Module> Compiler::compileModule(ProgramKind kind,
     return module;
 }
 
+std::unique_ptr<Module> Compiler::rehydrateModule(ProgramKind kind,
+                                                  sk_sp<const SkData> dehydratedModule,
+                                                  std::string_view moduleSource,
+                                                  const Module* parentModule) {
+    SkASSERT(parentModule);
+    SkASSERT(dehydratedModule);
+    SkASSERT(this->errorCount() == 0);
+
+    ProgramSettings settings;
+    settings.fUseMemoryPool = false;
+    this->initializeContext(parentModule, kind, settings, moduleSource, /*isModule=*/true);
+
+    auto module = std::make_unique<Module>();
+    module->fParent = parentModule;
+    bool success = Rehydrator(*fContext, {dehydratedModule->bytes(), dehydratedModule->size()})
+                           .readModule(moduleSource, &module->fElements);
+    module->fDehydratedData = std::move(dehydratedModule);
+    module->fSymbols = std::move(fGlobalSymbols);
+
+    this->cleanupContext();
+
+    if (!success || this->errorCount() != 0) {
+        // Leave the compiler ready to compile the module from its source.
+        this->resetErrors();
+        return nullptr;
+    }
+    return module;
+}
+
 std::unique_ptr<Program> Compiler::convertProgram(ProgramKind kind,
                                                   std::string programSource,
                                                   const ProgramSettings& settings) {
@@ -345,6 +377,9 @@ bool Compiler::optimize(Program& program) {
                          program.fUsage.get());
 #endif
 
+        // Look for repeated expressions once inlining and loop unrolling have exposed them.
+        Transform::EliminateCommonSubexpressions(program);
+
         // Unreachable code can confuse some drivers, so it's worth removing. (skia:12012)
         Transform::EliminateUnreachableCode(program);
 
@@ -390,6 +425,9 @@ bool Compiler::runInliner(Inliner* inliner,
 
     bool result = inliner->analyze(elements, symbols, usage);
 
+    // Unroll loops once inlining is done, so that inlined code counts toward the unrolled size.
+    result |= inliner->unrollLoops(elements, usage);
+
     fContext->fSymbolTable = nullptr;
     return result;
 #endif
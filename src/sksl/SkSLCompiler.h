@@ -8,6 +8,8 @@
 #ifndef SKSL_COMPILER
 #define SKSL_COMPILER
 
+#include "include/core/SkData.h"
+#include "include/core/SkRefCnt.h"
 #include "include/core/SkSize.h"
 #include "include/core/SkTypes.h"
 #include "src/sksl/SkSLContext.h"  // IWYU pragma: keep
@@ -55,6 +57,8 @@ struct ProgramSettings;
 
 struct Module {
     const Module*                                fParent = nullptr;
+    sk_sp<const SkData>                          fDehydratedData;  // Holds the symbol names of a
+                                                                    // rehydrated module
     std::unique_ptr<SymbolTable>                 fSymbols;
     std::vector<std::unique_ptr<ProgramElement>> fElements;
 };
@@ -64,6 +68,12 @@ struct Module {
  * while performing basic optimizations such as constant-folding and dead-code elimination. Then the
  * Program is passed into a CodeGenerator to produce compiled output.
  *
+ * A Compiler is not thread-safe, but it is cheap to create: the built-in modules are loaded once
+ * and shared by every Compiler, and nothing in them is modified by compiling a program. To compile
+ * on several threads at once, give each thread its own Compiler. A Program reports its code
+ * generation errors to the Compiler which made it, so keep that Compiler alive, and on the same
+ * thread, until code generation is finished.
+ *
  * See the README for information about SkSL.
  */
 class SK_API Compiler {
@@ -158,6 +168,16 @@ public:
                                           const Module* parentModule,
                                           bool shouldInline);
 
+    /**
+     * Loads a module that was serialized by the Dehydrator after compiling `moduleSource`. Returns
+     * null if the data doesn't hold that module, or doesn't match the parent modules; the module
+     * can be compiled from its source instead.
+     */
+    std::unique_ptr<Module> rehydrateModule(ProgramKind kind,
+                                            sk_sp<const SkData> dehydratedModule,
+                                            std::string_view moduleSource,
+                                            const Module* parentModule);
+
     /** Optimize a module at minification time, before writing it out. */
     bool optimizeModuleBeforeMinifying(ProgramKind kind, Module& module, bool shrinkSymbols);
 
@@ -210,7 +230,7 @@ private:
     /** Optimize a module at Skia runtime, after loading it. */
     bool optimizeModuleAfterLoading(ProgramKind kind, Module& module);
 
-    /** Flattens out function calls when it is safe to do so. */
+    /** Flattens out function calls and unrolls loops when it is safe to do so. */
     bool runInliner(Inliner* inliner,
                     const std::vector<std::unique_ptr<ProgramElement>>& elements,
                     SymbolTable* symbols,
@@ -37,6 +37,10 @@ using StatementArray = skia_private::STArray<2, std::unique_ptr<Statement>>;
 // default threshold value is arbitrary, but tends to work well in practice.
 static constexpr int kDefaultInlineThreshold = 50;
 
+// Loops larger than this (measured in IR nodes, once unrolled) will not be unrolled. This is the
+// threshold used when loop unrolling is enabled without a more specific limit.
+static constexpr int kDefaultUnrollLoopThreshold = 256;
+
 // A hard upper limit on the number of variable slots allowed in a function/global scope.
 // This is an arbitrary limit, but is needed to prevent code generation from taking unbounded
 // amounts of time or space.
@@ -0,0 +1,664 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/sksl/SkSLDehydrator.h"
+
+#include "include/core/SkData.h"
+#include "src/core/SkChecksum.h"
+#include "src/sksl/SkSLCompiler.h"
+#include "src/sksl/SkSLOperator.h"
+#include "src/sksl/SkSLRehydrator.h"
+#include "src/sksl/ir/SkSLBinaryExpression.h"
+#include "src/sksl/ir/SkSLBlock.h"
+#include "src/sksl/ir/SkSLConstructor.h"
+#include "src/sksl/ir/SkSLDoStatement.h"
+#include "src/sksl/ir/SkSLExpression.h"
+#include "src/sksl/ir/SkSLExpressionStatement.h"
+#include "src/sksl/ir/SkSLFieldAccess.h"
+#include "src/sksl/ir/SkSLFieldSymbol.h"
+#include "src/sksl/ir/SkSLForStatement.h"
+#include "src/sksl/ir/SkSLFunctionCall.h"
+#include "src/sksl/ir/SkSLFunctionDeclaration.h"
+#include "src/sksl/ir/SkSLFunctionDefinition.h"
+#include "src/sksl/ir/SkSLFunctionPrototype.h"
+#include "src/sksl/ir/SkSLIfStatement.h"
+#include "src/sksl/ir/SkSLIndexExpression.h"
+#include "src/sksl/ir/SkSLInterfaceBlock.h"
+#include "src/sksl/ir/SkSLLayout.h"
+#include "src/sksl/ir/SkSLLiteral.h"
+#include "src/sksl/ir/SkSLPostfixExpression.h"
+#include "src/sksl/ir/SkSLPrefixExpression.h"
+#include "src/sksl/ir/SkSLProgramElement.h"
+#include "src/sksl/ir/SkSLReturnStatement.h"
+#include "src/sksl/ir/SkSLSetting.h"
+#include "src/sksl/ir/SkSLStatement.h"
+#include "src/sksl/ir/SkSLStructDefinition.h"
+#include "src/sksl/ir/SkSLSwitchCase.h"
+#include "src/sksl/ir/SkSLSwitchStatement.h"
+#include "src/sksl/ir/SkSLSwizzle.h"
+#include "src/sksl/ir/SkSLSymbol.h"
+#include "src/sksl/ir/SkSLSymbolTable.h"
+#include "src/sksl/ir/SkSLTernaryExpression.h"
+#include "src/sksl/ir/SkSLType.h"
+#include "src/sksl/ir/SkSLVarDeclarations.h"
+#include "src/sksl/ir/SkSLVariable.h"
+#include "src/sksl/ir/SkSLVariableReference.h"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace skia_private;
+
+namespace SkSL {
+
+namespace {
+
+// ModuleLoader adds aliases like `vec4` and hides the private types behind `invalid` aliases
+// after loading the public module, and does the same after rehydrating it.
+bool is_alias(const Symbol& symbol) {
+    return symbol.is<Type>() && &symbol.as<Type>().resolve() != &symbol.as<Type>();
+}
+
+Rehydrator::ExpressionKind constructor_kind(Expression::Kind kind) {
+    switch (kind) {
+        case Expression::Kind::kConstructorArray:
+            return Rehydrator::ExpressionKind::kConstructorArray;
+        case Expression::Kind::kConstructorArrayCast:
+            return Rehydrator::ExpressionKind::kConstructorArrayCast;
+        case Expression::Kind::kConstructorCompound:
+            return Rehydrator::ExpressionKind::kConstructorCompound;
+        case Expression::Kind::kConstructorCompoundCast:
+            return Rehydrator::ExpressionKind::kConstructorCompoundCast;
+        case Expression::Kind::kConstructorDiagonalMatrix:
+            return Rehydrator::ExpressionKind::kConstructorDiagonalMatrix;
+        case Expression::Kind::kConstructorMatrixResize:
+            return Rehydrator::ExpressionKind::kConstructorMatrixResize;
+        case Expression::Kind::kConstructorScalarCast:
+            return Rehydrator::ExpressionKind::kConstructorScalarCast;
+        case Expression::Kind::kConstructorSplat:
+            return Rehydrator::ExpressionKind::kConstructorSplat;
+        case Expression::Kind::kConstructorStruct:
+            return Rehydrator::ExpressionKind::kConstructorStruct;
+        default:
+            SkUNREACHABLE;
+    }
+}
+
+}  // namespace
+
+sk_sp<SkData> Dehydrator::Dehydrate(const Module& module, std::string_view source) {
+    if (!module.fSymbols || !module.fSymbols->fParent) {
+        return nullptr;
+    }
+    Dehydrator dehydrator(module.fSymbols->fParent);
+    dehydrator.fSymbolTable = module.fSymbols.get();
+    dehydrator.writeSymbolTable(*module.fSymbols);
+
+    int elementCount = 0;
+    for (const std::unique_ptr<ProgramElement>& element : module.fElements) {
+        elementCount += !element->is<FunctionPrototype>();
+    }
+    dehydrator.writeU16(elementCount);
+    for (const std::unique_ptr<ProgramElement>& element : module.fElements) {
+        if (!element->is<FunctionPrototype>()) {
+            dehydrator.writeElement(*element);
+        }
+    }
+    if (dehydrator.fFailed) {
+        return nullptr;
+    }
+
+    TArray<uint8_t> header;
+    dehydrator.fOut = &header;
+    dehydrator.writeU32(Rehydrator::kMagic);
+    dehydrator.writeU16(Rehydrator::kVersion);
+    dehydrator.writeU32(SkChecksum::Hash32(source.data(), source.size()));
+    dehydrator.writeU16(dehydrator.fImportIDs.count());
+
+    sk_sp<SkData> data = SkData::MakeUninitialized(header.size() + dehydrator.fImports.size() +
+                                                   dehydrator.fBody.size());
+    uint8_t* dst = static_cast<uint8_t*>(data->writable_data());
+    for (const TArray<uint8_t>* part : {&header, &dehydrator.fImports, &dehydrator.fBody}) {
+        std::copy(part->begin(), part->end(), dst);
+        dst += part->size();
+    }
+    return data;
+}
+
+bool Dehydrator::fail(const char* reason) {
+    if (!fFailed) {
+        SkDebugf("Unable to dehydrate module: %s\n", reason);
+    }
+    fFailed = true;
+    return false;
+}
+
+void Dehydrator::writeBytes(const void* src, size_t size) {
+    fOut->push_back_n(size, static_cast<const uint8_t*>(src));
+}
+
+void Dehydrator::writeString(std::string_view s) {
+    if (s.size() > 0xFFFF) {
+        this->fail("name too long");
+        return;
+    }
+    this->writeU16(s.size());
+    this->writeBytes(s.data(), s.size());
+}
+
+void Dehydrator::writeLayout(const Layout& layout) {
+    if (layout == Layout{}) {
+        this->writeU8(0);
+        return;
+    }
+    this->writeU8(1);
+    this->writeS32(layout.fFlags.value());
+    this->writeS32(layout.fLocation);
+    this->writeS32(layout.fOffset);
+    this->writeS32(layout.fBinding);
+    this->writeS32(layout.fTexture);
+    this->writeS32(layout.fSampler);
+    this->writeS32(layout.fIndex);
+    this->writeS32(layout.fSet);
+    this->writeS32(layout.fBuiltin);
+    this->writeS32(layout.fInputAttachmentIndex);
+    this->writeS32(layout.fLocalSizeX);
+    this->writeS32(layout.fLocalSizeY);
+    this->writeS32(layout.fLocalSizeZ);
+}
+
+uint16_t Dehydrator::symbolID(const Symbol* symbol) {
+    if (!symbol) {
+        return Rehydrator::kNoSymbol;
+    }
+    if (const uint16_t* id = fSymbolIDs.find(symbol)) {
+        return *id;
+    }
+    return this->importID(symbol);
+}
+
+uint16_t Dehydrator::importID(const Symbol* symbol) {
+    if (const uint16_t* id = fImportIDs.find(symbol)) {
+        return *id | Rehydrator::kImportedSymbol;
+    }
+    // A symbol that this module doesn't declare (or doesn't declare before using it) has to be
+    // found again by looking it up in the parent modules.
+    const Symbol* found = fParentSymbols->find(symbol->name());
+    Rehydrator::ImportKind kind;
+    STArray<8, uint16_t> parameterTypes;
+    switch (symbol->kind()) {
+        case Symbol::Kind::kType:
+            kind = Rehydrator::ImportKind::kType;
+            break;
+
+        case Symbol::Kind::kVariable:
+            kind = Rehydrator::ImportKind::kVariable;
+            break;
+
+        case Symbol::Kind::kFunctionDeclaration: {
+            kind = Rehydrator::ImportKind::kFunction;
+            const auto& decl = symbol->as<FunctionDeclaration>();
+            for (const Variable* param : decl.parameters()) {
+                parameterTypes.push_back(this->importID(&param->type()));
+            }
+            // The Rehydrator picks the first overload that takes the same parameter types.
+            const FunctionDeclaration* overload =
+                    found && found->is<FunctionDeclaration>() ? &found->as<FunctionDeclaration>()
+                                                              : nullptr;
+            for (; overload; overload = overload->nextOverload()) {
+                SkSpan<Variable* const> parameters = overload->parameters();
+                if (std::equal(parameters.begin(), parameters.end(),
+                               decl.parameters().begin(), decl.parameters().end(),
+                               [](const Variable* a, const Variable* b) {
+                                   return &a->type() == &b->type();
+                               })) {
+                    break;
+                }
+            }
+            found = overload;
+            break;
+        }
+        default:
+            found = nullptr;
+            break;
+    }
+    if (found != symbol) {
+        this->fail("symbol isn't declared before it's used, or isn't found in the parent modules");
+        return Rehydrator::kNoSymbol;
+    }
+    if (fImportIDs.count() >= Rehydrator::kMaxSymbols) {
+        this->fail("too many imported symbols");
+        return Rehydrator::kNoSymbol;
+    }
+
+    TArray<uint8_t>* out = std::exchange(fOut, &fImports);
+    this->writeU8((uint8_t)kind);
+    this->writeString(symbol->name());
+    if (kind == Rehydrator::ImportKind::kFunction) {
+        this->writeU8(parameterTypes.size());
+        for (uint16_t id : parameterTypes) {
+            this->writeU16(id | Rehydrator::kImportedSymbol);
+        }
+    }
+    fOut = out;
+
+    uint16_t id = fImportIDs.count();
+    fImportIDs.set(symbol, id);
+    return id | Rehydrator::kImportedSymbol;
+}
+
+void Dehydrator::writeSymbol(const Symbol& symbol) {
+    switch (symbol.kind()) {
+        case Symbol::Kind::kType: {
+            const Type& type = symbol.as<Type>();
+            if (type.isArray()) {
+                this->writeU8((uint8_t)Rehydrator::SymbolKind::kArrayType);
+                this->writeString(type.name());
+                this->writeSymbolRef(&type.componentType());
+                this->writeS32(type.columns());
+            } else if (type.isStruct() || type.isInterfaceBlock()) {
+                this->writeU8((uint8_t)Rehydrator::SymbolKind::kStructType);
+                this->writeString(type.name());
+                this->writeU8(type.isInterfaceBlock());
+                if (type.fields().size() > 0xFF) {
+                    this->fail("too many fields");
+                    return;
+                }
+                this->writeU8(type.fields().size());
+                for (const Field& field : type.fields()) {
+                    this->writeLayout(field.fLayout);
+                    this->writeS32(field.fModifierFlags.value());
+                    this->writeString(field.fName);
+                    this->writeSymbolRef(field.fType);
+                }
+            } else {
+                this->fail("unsupported type");
+                return;
+            }
+            break;
+        }
+        case Symbol::Kind::kVariable: {
+            const Variable& var = symbol.as<Variable>();
+            this->writeU8((uint8_t)Rehydrator::SymbolKind::kVariable);
+            this->writeString(var.name());
+            this->writeString(var.mangledName() != var.name() ? var.mangledName()
+                                                              : std::string_view());
+            this->writeLayout(var.layout());
+            this->writeS32(var.modifierFlags().value());
+            this->writeSymbolRef(&var.type());
+            this->writeU8(var.isBuiltin());
+            this->writeU8((uint8_t)var.storage());
+            break;
+        }
+        case Symbol::Kind::kFunctionDeclaration: {
+            const FunctionDeclaration& decl = symbol.as<FunctionDeclaration>();
+            this->writeU8((uint8_t)Rehydrator::SymbolKind::kFunctionDeclaration);
+            this->writeString(decl.name());
+            this->writeS32(decl.modifierFlags().value());
+            this->writeSymbolRef(&decl.returnType());
+            if (decl.parameters().size() > 0xFF) {
+                this->fail("too many parameters");
+                return;
+            }
+            this->writeU8(decl.parameters().size());
+            for (const Variable* param : decl.parameters()) {
+                this->writeSymbolRef(param);
+            }
+            this->writeSymbolRef(decl.nextOverload());
+            break;
+        }
+        case Symbol::Kind::kField: {
+            const FieldSymbol& field = symbol.as<FieldSymbol>();
+            this->writeU8((uint8_t)Rehydrator::SymbolKind::kField);
+            this->writeSymbolRef(&field.owner());
+            this->writeU16(field.fieldIndex());
+            break;
+        }
+        default:
+            this->fail("unsupported symbol");
+            return;
+    }
+    if (fSymbolIDs.count() >= Rehydrator::kMaxSymbols) {
+        this->fail("too many symbols");
+        return;
+    }
+    fSymbolIDs.set(&symbol, fSymbolIDs.count());
+}
+
+void Dehydrator::writeSymbolTable(const SymbolTable& table) {
+    int ownedCount = 0;
+    for (const std::unique_ptr<Symbol>& symbol : table.fOwnedSymbols) {
+        ownedCount += !is_alias(*symbol);
+    }
+    this->writeU16(ownedCount);
+    for (const std::unique_ptr<Symbol>& symbol : table.fOwnedSymbols) {
+        if (!is_alias(*symbol)) {
+            this->writeSymbol(*symbol);
+        }
+    }
+
+    // The names are sorted so that the same module is always dehydrated into the same data.
+    std::vector<const Symbol*> named;
+    table.foreach([&](std::string_view name, const Symbol* symbol) {
+        if (name != symbol->name()) {
+            this->fail("renamed symbol");
+        }
+        if (!is_alias(*symbol)) {
+            named.push_back(symbol);
+        }
+    });
+    std::sort(named.begin(), named.end(), [](const Symbol* a, const Symbol* b) {
+        return a->name() < b->name();
+    });
+    this->writeU16(named.size());
+    for (const Symbol* symbol : named) {
+        this->writeSymbolRef(symbol);
+    }
+}
+
+void Dehydrator::writeNestedSymbolTable(const SymbolTable* table) {
+    if (!table) {
+        this->writeU8(0);
+        return;
+    }
+    if (table->fParent != fSymbolTable) {
+        this->fail("symbol table isn't nested in the enclosing one");
+        return;
+    }
+    this->writeU8(1);
+    this->writeU8(table->isBuiltin());
+    this->writeSymbolTable(*table);
+}
+
+void Dehydrator::writeElement(const ProgramElement& element) {
+    switch (element.kind()) {
+        case ProgramElement::Kind::kFunction: {
+            const FunctionDefinition& function = element.as<FunctionDefinition>();
+            this->writeU8((uint8_t)Rehydrator::ElementKind::kFunction);
+            this->writeSymbolRef(&function.declaration());
+            this->writeStatement(function.body().get());
+            break;
+        }
+        case ProgramElement::Kind::kGlobalVar:
+            this->writeU8((uint8_t)Rehydrator::ElementKind::kGlobalVar);
+            this->writeStatement(element.as<GlobalVarDeclaration>().declaration().get());
+            break;
+
+        case ProgramElement::Kind::kInterfaceBlock:
+            this->writeU8((uint8_t)Rehydrator::ElementKind::kInterfaceBlock);
+            this->writeSymbolRef(element.as<InterfaceBlock>().var());
+            break;
+
+        case ProgramElement::Kind::kStructDefinition:
+            this->writeU8((uint8_t)Rehydrator::ElementKind::kStructDefinition);
+            this->writeSymbolRef(&element.as<StructDefinition>().type());
+            break;
+
+        default:
+            this->fail("unsupported element");
+            break;
+    }
+}
+
+void Dehydrator::writeStatement(const Statement* statement) {
+    if (!statement) {
+        this->writeU8(Rehydrator::kNone);
+        return;
+    }
+    switch (statement->kind()) {
+        case Statement::Kind::kBlock: {
+            const Block& block = statement->as<Block>();
+            this->writeU8((uint8_t)Rehydrator::StatementKind::kBlock);
+            this->writeU8((uint8_t)block.blockKind());
+            this->writeNestedSymbolTable(block.symbolTable());
+            const SymbolTable* enclosingTable = fSymbolTable;
+            if (block.symbolTable()) {
+                fSymbolTable = block.symbolTable();
+            }
+            if (block.children().size() > 0xFFFF) {
+                this->fail("too many statements");
+                break;
+            }
+            this->writeU16(block.children().size());
+            for (const std::unique_ptr<Statement>& child : block.children()) {
+                this->writeStatement(child.get());
+            }
+            fSymbolTable = enclosingTable;
+            break;
+        }
+        case Statement::Kind::kBreak:
+            this->writeU8((uint8_t)Rehydrator::StatementKind::kBreak);
+            break;
+
+        case Statement::Kind::kContinue:
+            this->writeU8((uint8_t)Rehydrator::StatementKind::kContinue);
+            break;
+
+        case Statement::Kind::kDiscard:
+            this->writeU8((uint8_t)Rehydrator::StatementKind::kDiscard);
+            break;
+
+        case Statement::Kind::kDo: {
+            const DoStatement& d = statement->as<DoStatement>();
+            this->writeU8((uint8_t)Rehydrator::StatementKind::kDo);
+            this->writeStatement(d.statement().get());
+            this->writeExpression(d.test().get());
+            break;
+        }
+        case Statement::Kind::kExpression:
+            this->writeU8((uint8_t)Rehydrator::StatementKind::kExpression);
+            this->writeExpression(statement->as<ExpressionStatement>().expression().get());
+            break;
+
+        case Statement::Kind::kFor: {
+            const ForStatement& f = statement->as<ForStatement>();
+            this->writeU8((uint8_t)Rehydrator::StatementKind::kFor);
+            this->writeNestedSymbolTable(f.symbols());
+            const SymbolTable* enclosingTable = fSymbolTable;
+            if (f.symbols()) {
+                fSymbolTable = f.symbols();
+            }
+            this->writeStatement(f.initializer().get());
+            this->writeExpression(f.test().get());
+            this->writeExpression(f.next().get());
+            this->writeStatement(f.statement().get());
+            if (const LoopUnrollInfo* unrollInfo = f.unrollInfo()) {
+                this->writeU8(1);
+                this->writeSymbolRef(unrollInfo->fIndex);
+                this->writeDouble(unrollInfo->fStart);
+                this->writeDouble(unrollInfo->fDelta);
+                this->writeS32(unrollInfo->fCount);
+            } else {
+                this->writeU8(0);
+            }
+            fSymbolTable = enclosingTable;
+            break;
+        }
+        case Statement::Kind::kIf: {
+            const IfStatement& i = statement->as<IfStatement>();
+            this->writeU8((uint8_t)Rehydrator::StatementKind::kIf);
+            this->writeExpression(i.test().get());
+            this->writeStatement(i.ifTrue().get());
+            this->writeStatement(i.ifFalse().get());
+            break;
+        }
+        case Statement::Kind::kNop:
+            this->writeU8((uint8_t)Rehydrator::StatementKind::kNop);
+            break;
+
+        case Statement::Kind::kReturn:
+            this->writeU8((uint8_t)Rehydrator::StatementKind::kReturn);
+            this->writeExpression(statement->as<ReturnStatement>().expression().get());
+            break;
+
+        case Statement::Kind::kSwitch: {
+            const SwitchStatement& s = statement->as<SwitchStatement>();
+            this->writeU8((uint8_t)Rehydrator::StatementKind::kSwitch);
+            this->writeExpression(s.value().get());
+            this->writeStatement(s.caseBlock().get());
+            break;
+        }
+        case Statement::Kind::kSwitchCase: {
+            const SwitchCase& c = statement->as<SwitchCase>();
+            this->writeU8((uint8_t)Rehydrator::StatementKind::kSwitchCase);
+            this->writeU8(c.isDefault());
+            this->writeS64(c.isDefault() ? 0 : c.value());
+            this->writeStatement(c.statement().get());
+            break;
+        }
+        case Statement::Kind::kVarDeclaration: {
+            const VarDeclaration& v = statement->as<VarDeclaration>();
+            if (v.var()->varDeclaration() != &v) {
+                this->fail("variable has another declaration");
+                break;
+            }
+            this->writeU8((uint8_t)Rehydrator::StatementKind::kVarDeclaration);
+            this->writeSymbolRef(v.var());
+            this->writeSymbolRef(&v.baseType());
+            this->writeS32(v.arraySize());
+            this->writeExpression(v.value().get());
+            break;
+        }
+        default:
+            this->fail("unsupported statement");
+            break;
+    }
+}
+
+void Dehydrator::writeExpression(const Expression* expression) {
+    if (!expression) {
+        this->writeU8(Rehydrator::kNone);
+        return;
+    }
+    switch (expression->kind()) {
+        case Expression::Kind::kBinary: {
+            const BinaryExpression& b = expression->as<BinaryExpression>();
+            this->writeU8((uint8_t)Rehydrator::ExpressionKind::kBinary);
+            this->writeExpression(b.left().get());
+            this->writeU8((uint8_t)b.getOperator().kind());
+            this->writeExpression(b.right().get());
+            this->writeSymbolRef(&b.type());
+            break;
+        }
+        case Expression::Kind::kConstructorArray:
+        case Expression::Kind::kConstructorArrayCast:
+        case Expression::Kind::kConstructorCompound:
+        case Expression::Kind::kConstructorCompoundCast:
+        case Expression::Kind::kConstructorDiagonalMatrix:
+        case Expression::Kind::kConstructorMatrixResize:
+        case Expression::Kind::kConstructorScalarCast:
+        case Expression::Kind::kConstructorSplat:
+        case Expression::Kind::kConstructorStruct: {
+            SkSpan<const std::unique_ptr<Expression>> args =
+                    expression->asAnyConstructor().argumentSpan();
+            Rehydrator::ExpressionKind kind = constructor_kind(expression->kind());
+            this->writeU8((uint8_t)kind);
+            this->writeSymbolRef(&expression->type());
+            if (kind == Rehydrator::ExpressionKind::kConstructorArray ||
+                kind == Rehydrator::ExpressionKind::kConstructorCompound ||
+                kind == Rehydrator::ExpressionKind::kConstructorStruct) {
+                if (args.size() > 0xFF) {
+                    this->fail("too many arguments");
+                    break;
+                }
+                this->writeU8(args.size());
+            }
+            for (const std::unique_ptr<Expression>& arg : args) {
+                this->writeExpression(arg.get());
+            }
+            break;
+        }
+        case Expression::Kind::kFieldAccess: {
+            const FieldAccess& f = expression->as<FieldAccess>();
+            this->writeU8((uint8_t)Rehydrator::ExpressionKind::kFieldAccess);
+            this->writeExpression(f.base().get());
+            this->writeU16(f.fieldIndex());
+            this->writeU8((uint8_t)f.ownerKind());
+            break;
+        }
+        case Expression::Kind::kFunctionCall: {
+            const FunctionCall& f = expression->as<FunctionCall>();
+            this->writeU8((uint8_t)Rehydrator::ExpressionKind::kFunctionCall);
+            this->writeSymbolRef(&f.type());
+            this->writeSymbolRef(&f.function());
+            if (f.arguments().size() > 0xFF) {
+                this->fail("too many arguments");
+                break;
+            }
+            this->writeU8(f.arguments().size());
+            for (const std::unique_ptr<Expression>& arg : f.arguments()) {
+                this->writeExpression(arg.get());
+            }
+            break;
+        }
+        case Expression::Kind::kIndex: {
+            const IndexExpression& i = expression->as<IndexExpression>();
+            this->writeU8((uint8_t)Rehydrator::ExpressionKind::kIndex);
+            this->writeExpression(i.base().get());
+            this->writeExpression(i.index().get());
+            break;
+        }
+        case Expression::Kind::kLiteral: {
+            const Literal& l = expression->as<Literal>();
+            this->writeU8((uint8_t)Rehydrator::ExpressionKind::kLiteral);
+            this->writeSymbolRef(&l.type());
+            this->writeDouble(l.value());
+            break;
+        }
+        case Expression::Kind::kPostfix: {
+            const PostfixExpression& p = expression->as<PostfixExpression>();
+            this->writeU8((uint8_t)Rehydrator::ExpressionKind::kPostfix);
+            this->writeExpression(p.operand().get());
+            this->writeU8((uint8_t)p.getOperator().kind());
+            break;
+        }
+        case Expression::Kind::kPrefix: {
+            const PrefixExpression& p = expression->as<PrefixExpression>();
+            this->writeU8((uint8_t)Rehydrator::ExpressionKind::kPrefix);
+            this->writeU8((uint8_t)p.getOperator().kind());
+            this->writeExpression(p.operand().get());
+            break;
+        }
+        case Expression::Kind::kSetting:
+            this->writeU8((uint8_t)Rehydrator::ExpressionKind::kSetting);
+            this->writeString(expression->as<Setting>().name());
+            break;
+
+        case Expression::Kind::kSwizzle: {
+            const Swizzle& s = expression->as<Swizzle>();
+            this->writeU8((uint8_t)Rehydrator::ExpressionKind::kSwizzle);
+            this->writeExpression(s.base().get());
+            this->writeU8(s.components().size());
+            for (int8_t component : s.components()) {
+                this->writeU8((uint8_t)component);
+            }
+            break;
+        }
+        case Expression::Kind::kTernary: {
+            const TernaryExpression& t = expression->as<TernaryExpression>();
+            this->writeU8((uint8_t)Rehydrator::ExpressionKind::kTernary);
+            this->writeExpression(t.test().get());
+            this->writeExpression(t.ifTrue().get());
+            this->writeExpression(t.ifFalse().get());
+            break;
+        }
+        case Expression::Kind::kVariableReference: {
+            const VariableReference& v = expression->as<VariableReference>();
+            this->writeU8((uint8_t)Rehydrator::ExpressionKind::kVariableReference);
+            this->writeSymbolRef(v.variable());
+            this->writeU8((uint8_t)v.refKind());
+            break;
+        }
+        default:
+            this->fail("unsupported expression");
+            break;
+    }
+}
+
+}  // namespace SkSL
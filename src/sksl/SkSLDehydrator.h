@@ -0,0 +1,85 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SKSL_DEHYDRATOR
+#define SKSL_DEHYDRATOR
+
+#include "include/core/SkRefCnt.h"
+#include "include/private/base/SkTArray.h"
+#include "src/core/SkTHash.h"
+
+#include <cstdint>
+#include <string_view>
+
+class SkData;
+
+namespace SkSL {
+
+class Expression;
+class ProgramElement;
+class Statement;
+class Symbol;
+class SymbolTable;
+class Type;
+struct Layout;
+struct Module;
+
+/**
+ * Serializes a built-in module's IR into the format that the Rehydrator reads, so that it can be
+ * loaded without compiling its source. This is used by sksl-dehydrate to generate the
+ * .dehydrated.sksl files, and by tests; it isn't needed at runtime.
+ */
+class Dehydrator {
+public:
+    // Returns the dehydrated module, which was compiled from `source`, or null if the module holds
+    // IR that has no dehydrated form. Function prototypes aren't kept, as in the loaded modules,
+    // and the type aliases that ModuleLoader adds to the public module are left to be added again.
+    static sk_sp<SkData> Dehydrate(const Module& module, std::string_view source);
+
+private:
+    explicit Dehydrator(const SymbolTable* parentSymbols) : fParentSymbols(parentSymbols) {}
+
+    bool fail(const char* reason);
+
+    void writeBytes(const void* src, size_t size);
+    void writeU8(uint8_t value) { this->writeBytes(&value, sizeof(value)); }
+    void writeU16(uint16_t value) { this->writeBytes(&value, sizeof(value)); }
+    void writeU32(uint32_t value) { this->writeBytes(&value, sizeof(value)); }
+    void writeS32(int32_t value) { this->writeBytes(&value, sizeof(value)); }
+    void writeS64(int64_t value) { this->writeBytes(&value, sizeof(value)); }
+    void writeDouble(double value) { this->writeBytes(&value, sizeof(value)); }
+    void writeString(std::string_view s);
+    void writeLayout(const Layout& layout);
+
+    uint16_t symbolID(const Symbol* symbol);
+    uint16_t importID(const Symbol* symbol);
+    void writeSymbolRef(const Symbol* symbol) { this->writeU16(this->symbolID(symbol)); }
+
+    void writeSymbolTable(const SymbolTable& table);
+    void writeSymbol(const Symbol& symbol);
+    void writeNestedSymbolTable(const SymbolTable* table);
+
+    void writeElement(const ProgramElement& element);
+    void writeStatement(const Statement* statement);
+    void writeExpression(const Expression* expression);
+
+    const SymbolTable* fParentSymbols;
+    const SymbolTable* fSymbolTable = nullptr;
+    bool fFailed = false;
+
+    skia_private::THashMap<const Symbol*, uint16_t> fSymbolIDs;
+    skia_private::THashMap<const Symbol*, uint16_t> fImportIDs;
+
+    // Imports are written as they're found, ahead of the module that uses them.
+    skia_private::TArray<uint8_t> fImports;
+    skia_private::TArray<uint8_t> fBody;
+    skia_private::TArray<uint8_t>* fOut = &fBody;
+};
+
+}  // namespace SkSL
+
+#endif
@@ -45,6 +45,7 @@
 #include "src/sksl/ir/SkSLIRNode.h"
 #include "src/sksl/ir/SkSLIfStatement.h"
 #include "src/sksl/ir/SkSLIndexExpression.h"
+#include "src/sksl/ir/SkSLLiteral.h"
 #include "src/sksl/ir/SkSLModifierFlags.h"
 #include "src/sksl/ir/SkSLNop.h"
 #include "src/sksl/ir/SkSLPostfixExpression.h"
@@ -62,6 +63,7 @@
 #include "src/sksl/ir/SkSLVarDeclarations.h"
 #include "src/sksl/ir/SkSLVariable.h"
 #include "src/sksl/ir/SkSLVariableReference.h"
+#include "src/sksl/transform/SkSLProgramWriter.h"
 #include "src/sksl/transform/SkSLTransform.h"
 
 #include <algorithm>
@@ -373,9 +375,9 @@ std::unique_ptr<Statement> Inliner::inlineStatement(Position pos,
     ++fInlinedStatementCounter;
 
     switch (statement.kind()) {
-        case Statement::Kind::kBlock:
-            return makeWithChildSymbolTable([&](std::unique_ptr<SymbolTable> symbolTable) {
-                const Block& block = statement.as<Block>();
+        case Statement::Kind::kBlock: {
+            const Block& block = statement.as<Block>();
+            auto cloneBlock = [&](std::unique_ptr<SymbolTable> symbolTable) {
                 StatementArray statements;
                 statements.reserve_exact(block.children().size());
                 for (const std::unique_ptr<Statement>& child : block.children()) {
@@ -385,7 +387,20 @@ std::unique_ptr<Statement> Inliner::inlineStatement(Position pos,
                                    std::move(statements),
                                    block.blockKind(),
                                    std::move(symbolTable));
-            });
+            };
+            // Block::Make discards the symbol table of an unscoped block which declares nothing.
+            // Such a block doesn't get a symbol table of its own; otherwise, the symbol tables of
+            // any statements nested inside of it would be left with a dangling parent.
+            bool declaresVariables = std::any_of(block.children().begin(),
+                                                 block.children().end(),
+                                                 [](const std::unique_ptr<Statement>& child) {
+                                                     return child->is<VarDeclaration>();
+                                                 });
+            if (!block.isScope() && !declaresVariables) {
+                return cloneBlock(/*symbolTable=*/nullptr);
+            }
+            return makeWithChildSymbolTable(cloneBlock);
+        }
 
         case Statement::Kind::kBreak:
             return BreakStatement::Make(pos);
@@ -1160,6 +1175,125 @@ bool Inliner::analyze(const std::vector<std::unique_ptr<ProgramElement>>& elemen
     return madeChanges;
 }
 
+std::unique_ptr<Statement> Inliner::unrollLoop(const ForStatement& loop,
+                                               const ProgramUsage& usage) {
+    const LoopUnrollInfo* unrollInfo = loop.unrollInfo();
+    if (!unrollInfo || unrollInfo->fCount <= 0) {
+        return nullptr;
+    }
+
+    // Once the loop is unrolled, there's nothing left for a `break` or `continue` to affect. A
+    // `return` can't be copied either, since `inlineStatement` treats it as the function result.
+    Analysis::LoopControlFlowInfo controlFlow = Analysis::GetLoopControlFlowInfo(*loop.statement());
+    if (controlFlow.fHasBreak || controlFlow.fHasContinue || controlFlow.fHasReturn) {
+        return nullptr;
+    }
+
+    // The unrolled loop holds a copy of the body for every iteration, and all of those copies need
+    // to fit within the threshold.
+    int bodySizeLimit = this->settings().fUnrollLoopThreshold / unrollInfo->fCount;
+    if (bodySizeLimit <= 0 ||
+        Analysis::NodeCountUpToLimit(*loop.statement(), bodySizeLimit + 1) > bodySizeLimit) {
+        return nullptr;
+    }
+
+    // Enforce the same limit on new statements as the inliner.
+    if (fInlinedStatementCounter >= kInlinedStatementLimit) {
+        return nullptr;
+    }
+
+    // The unrolled iterations share a scope, which takes the place of the loop's own scope. The
+    // body's braces only need to be kept if it declares variables of its own.
+    const Position pos = loop.fPosition;
+    const bool isBuiltinCode = loop.symbols()->isBuiltin();
+    auto symbols = std::make_unique<SymbolTable>(loop.symbols()->fParent, isBuiltinCode);
+    const Statement& body = *loop.statement();
+    const bool flattenBody = body.is<Block>() && (!body.as<Block>().symbolTable() ||
+                                                  !body.as<Block>().symbolTable()->count());
+
+    const Type& indexType = unrollInfo->fIndex->type();
+    double indexValue = unrollInfo->fStart;
+    StatementArray iterations;
+    for (int iteration = 0; iteration < unrollInfo->fCount; ++iteration) {
+        // Each copy of the body sees the loop index as a literal value.
+        VariableRewriteMap varMap;
+        varMap.set(unrollInfo->fIndex, Literal::Make(pos, indexValue, &indexType));
+
+        auto unrollStatement = [&](const Statement& stmt) {
+            iterations.push_back(this->inlineStatement(
+                    pos, &varMap, symbols.get(), /*resultExpr=*/nullptr,
+                    Analysis::ReturnComplexity::kSingleSafeReturn, stmt, usage, isBuiltinCode));
+        };
+        if (flattenBody) {
+            for (const std::unique_ptr<Statement>& child : body.as<Block>().children()) {
+                unrollStatement(*child);
+            }
+        } else {
+            unrollStatement(body);
+        }
+
+        // Advance the index the same way the loop would, including float rounding.
+        indexValue += unrollInfo->fDelta;
+        if (indexType.componentType().isFloat()) {
+            indexValue = (float)indexValue;
+        }
+    }
+
+    return Block::Make(pos, std::move(iterations), Block::Kind::kBracedScope, std::move(symbols));
+}
+
+bool Inliner::unrollLoops(const std::vector<std::unique_ptr<ProgramElement>>& elements,
+                          ProgramUsage* usage) {
+    // A threshold of zero indicates that loop unrolling is disabled, so we can just return.
+    if (this->settings().fUnrollLoopThreshold <= 0) {
+        return false;
+    }
+
+    class LoopUnroller : public ProgramWriter {
+    public:
+        LoopUnroller(Inliner* inliner, ProgramUsage* usage) : fInliner(inliner), fUsage(usage) {}
+
+        using ProgramWriter::visitProgramElement;
+
+        bool visitExpressionPtr(std::unique_ptr<Expression>& expr) override {
+            // Loops can't appear inside of an expression.
+            return false;
+        }
+
+        bool visitStatementPtr(std::unique_ptr<Statement>& stmt) override {
+            // Unroll the inner loops first, so that their unrolled size counts toward the size of
+            // the loops which enclose them.
+            INHERITED::visitStatementPtr(stmt);
+
+            if (stmt->is<ForStatement>()) {
+                std::unique_ptr<Statement> unrolled =
+                        fInliner->unrollLoop(stmt->as<ForStatement>(), *fUsage);
+                if (unrolled) {
+                    fUsage->remove(stmt.get());
+                    fUsage->add(unrolled.get());
+                    stmt = std::move(unrolled);
+                    fMadeChanges = true;
+                }
+            }
+            return false;
+        }
+
+        Inliner* fInliner;
+        ProgramUsage* fUsage;
+        bool fMadeChanges = false;
+
+        using INHERITED = ProgramWriter;
+    };
+
+    LoopUnroller unroller(this, usage);
+    for (const std::unique_ptr<ProgramElement>& pe : elements) {
+        if (pe->is<FunctionDefinition>()) {
+            unroller.visitProgramElement(*pe);
+        }
+    }
+    return unroller.fMadeChanges;
+}
+
 }  // namespace SkSL
 
 #endif  // SK_ENABLE_OPTIMIZE_SIZE
@@ -22,6 +22,7 @@
 
 namespace SkSL {
 
+class ForStatement;
 class FunctionCall;
 class FunctionDeclaration;
 class FunctionDefinition;
@@ -50,6 +51,13 @@ public:
                  SymbolTable* symbols,
                  ProgramUsage* usage);
 
+    /**
+     * Unrolls `for` loops with a constant iteration count, when the unrolled loop fits within the
+     * program's loop-unroll threshold. Returns true if any changes are made.
+     */
+    bool unrollLoops(const std::vector<std::unique_ptr<ProgramElement>>& elements,
+                     ProgramUsage* usage);
+
 private:
     using VariableRewriteMap = skia_private::THashMap<const Variable*, std::unique_ptr<Expression>>;
 
@@ -109,6 +117,12 @@ private:
     /** Adds a scope to inlined bodies returned by `inlineCall`, if one is required. */
     void ensureScopedBlocks(Statement* inlinedBody, Statement* parentStmt);
 
+    /**
+     * Returns a copy of the loop's body for each of its iterations, with the loop index replaced
+     * by its value in that iteration, or null if the loop can't be unrolled within the threshold.
+     */
+    std::unique_ptr<Statement> unrollLoop(const ForStatement& loop, const ProgramUsage& usage);
+
     /** Checks whether inlining is viable for a FunctionCall, modulo recursion and function size. */
     bool isSafeToInline(const FunctionDefinition* functionDef, const ProgramUsage& usage);
 
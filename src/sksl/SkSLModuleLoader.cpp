@@ -6,6 +6,9 @@
  */
 #include "src/sksl/SkSLModuleLoader.h"
 
+#include "include/core/SkData.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkSpan.h"
 #include "include/core/SkTypes.h"
 #include "include/private/base/SkMutex.h"
 #include "src/base/SkNoDestructor.h"
@@ -22,6 +25,7 @@
 #include "src/sksl/ir/SkSLVariable.h"
 
 #include <algorithm>
+#include <cstdint>
 #include <string>
 #include <utility>
 #include <vector>
@@ -49,7 +53,7 @@
         return moduleSource;
     }
 
-    #define MODULE_DATA(name) #name, load_module_file(#name ".sksl")
+    #define MODULE_DATA(name) #name, load_module_file(#name ".sksl"), SkSpan<const uint8_t>()
 
 #else
 
@@ -84,7 +88,29 @@
         #endif
     #endif
 
-    #define MODULE_DATA(name) #name, std::string(SKSL_MINIFIED_##name)
+    // Release builds load the modules from their dehydrated IR, which is faster than compiling the
+    // minified code. The IR is larger than the code, so it's left out of optimize-for-size builds.
+    #if !defined(SK_ENABLE_OPTIMIZE_SIZE) && !defined(SK_DEBUG)
+        #include "src/sksl/generated/sksl_shared.dehydrated.sksl"
+        #include "src/sksl/generated/sksl_compute.dehydrated.sksl"
+        #include "src/sksl/generated/sksl_frag.dehydrated.sksl"
+        #include "src/sksl/generated/sksl_gpu.dehydrated.sksl"
+        #include "src/sksl/generated/sksl_public.dehydrated.sksl"
+        #include "src/sksl/generated/sksl_rt_shader.dehydrated.sksl"
+        #include "src/sksl/generated/sksl_vert.dehydrated.sksl"
+        #if defined(SK_GRAPHITE)
+        #include "src/sksl/generated/sksl_graphite_frag.dehydrated.sksl"
+        #include "src/sksl/generated/sksl_graphite_vert.dehydrated.sksl"
+        #include "src/sksl/generated/sksl_graphite_frag_es2.dehydrated.sksl"
+        #include "src/sksl/generated/sksl_graphite_vert_es2.dehydrated.sksl"
+        #endif
+
+        #define DEHYDRATED_DATA(name) SkSpan<const uint8_t>(SKSL_DEHYDRATED_##name)
+    #else
+        #define DEHYDRATED_DATA(name) SkSpan<const uint8_t>()
+    #endif
+
+    #define MODULE_DATA(name) #name, std::string(SKSL_MINIFIED_##name), DEHYDRATED_DATA(name)
 
 #endif
 
@@ -171,6 +197,8 @@ struct ModuleLoader::Impl {
     std::unique_ptr<const Module> fPublicModule;            // [Shared] minus Private types +
                                                             //     Runtime effect intrinsics
     std::unique_ptr<const Module> fRuntimeShaderModule;     // [Public] + Runtime shader decls
+
+    bool fUseDehydratedModules = true;
 };
 
 ModuleLoader ModuleLoader::Get() {
@@ -187,15 +215,21 @@ ModuleLoader::~ModuleLoader() {
 }
 
 void ModuleLoader::unloadModules() {
-    fModuleLoader.fSharedModule           = nullptr;
-    fModuleLoader.fGPUModule              = nullptr;
-    fModuleLoader.fVertexModule           = nullptr;
-    fModuleLoader.fFragmentModule         = nullptr;
-    fModuleLoader.fComputeModule          = nullptr;
-    fModuleLoader.fGraphiteVertexModule   = nullptr;
-    fModuleLoader.fGraphiteFragmentModule = nullptr;
-    fModuleLoader.fPublicModule           = nullptr;
-    fModuleLoader.fRuntimeShaderModule    = nullptr;
+    fModuleLoader.fSharedModule              = nullptr;
+    fModuleLoader.fGPUModule                 = nullptr;
+    fModuleLoader.fVertexModule              = nullptr;
+    fModuleLoader.fFragmentModule            = nullptr;
+    fModuleLoader.fComputeModule             = nullptr;
+    fModuleLoader.fGraphiteVertexModule      = nullptr;
+    fModuleLoader.fGraphiteFragmentModule    = nullptr;
+    fModuleLoader.fGraphiteVertexES2Module   = nullptr;
+    fModuleLoader.fGraphiteFragmentES2Module = nullptr;
+    fModuleLoader.fPublicModule              = nullptr;
+    fModuleLoader.fRuntimeShaderModule       = nullptr;
+}
+
+void ModuleLoader::useDehydratedModules(bool enabled) {
+    fModuleLoader.fUseDehydratedModules = enabled;
 }
 
 ModuleLoader::Impl::Impl() {
@@ -246,6 +280,28 @@ static std::unique_ptr<Module> compile_and_shrink(SkSL::Compiler* compiler,
     return m;
 }
 
+static std::unique_ptr<Module> load_module(SkSL::Compiler* compiler,
+                                           bool useDehydratedModule,
+                                           ProgramKind kind,
+                                           const char* moduleName,
+                                           std::string moduleSource,
+                                           SkSpan<const uint8_t> dehydratedModule,
+                                           const Module* parent) {
+    if (useDehydratedModule && !dehydratedModule.empty()) {
+        // The dehydrated IR is used as-is; it was already inlined and shrunk when it was generated.
+        // If it doesn't match the source (or the parent modules), the module is compiled instead.
+        std::unique_ptr<Module> m = compiler->rehydrateModule(
+                kind,
+                SkData::MakeWithoutCopy(dehydratedModule.data(), dehydratedModule.size()),
+                moduleSource,
+                parent);
+        if (m) {
+            return m;
+        }
+    }
+    return compile_and_shrink(compiler, kind, moduleName, std::move(moduleSource), parent);
+}
+
 const BuiltinTypes& ModuleLoader::builtinTypes() {
     return fModuleLoader.fBuiltinTypes;
 }
@@ -299,10 +355,11 @@ void ModuleLoader::addPublicTypeAliases(const SkSL::Module* module) {
 const Module* ModuleLoader::loadPublicModule(SkSL::Compiler* compiler) {
     if (!fModuleLoader.fPublicModule) {
         const Module* sharedModule = this->loadSharedModule(compiler);
-        fModuleLoader.fPublicModule = compile_and_shrink(compiler,
-                                                         ProgramKind::kFragment,
-                                                         MODULE_DATA(sksl_public),
-                                                         sharedModule);
+        fModuleLoader.fPublicModule = load_module(compiler,
+                                                  fModuleLoader.fUseDehydratedModules,
+                                                  ProgramKind::kFragment,
+                                                  MODULE_DATA(sksl_public),
+                                                  sharedModule);
         this->addPublicTypeAliases(fModuleLoader.fPublicModule.get());
     }
     return fModuleLoader.fPublicModule.get();
@@ -311,10 +368,11 @@ const Module* ModuleLoader::loadPublicModule(SkSL::Compiler* compiler) {
 const Module* ModuleLoader::loadPrivateRTShaderModule(SkSL::Compiler* compiler) {
     if (!fModuleLoader.fRuntimeShaderModule) {
         const Module* publicModule = this->loadPublicModule(compiler);
-        fModuleLoader.fRuntimeShaderModule = compile_and_shrink(compiler,
-                                                                ProgramKind::kFragment,
-                                                                MODULE_DATA(sksl_rt_shader),
-                                                                publicModule);
+        fModuleLoader.fRuntimeShaderModule = load_module(compiler,
+                                                         fModuleLoader.fUseDehydratedModules,
+                                                         ProgramKind::kFragment,
+                                                         MODULE_DATA(sksl_rt_shader),
+                                                         publicModule);
     }
     return fModuleLoader.fRuntimeShaderModule.get();
 }
@@ -322,10 +380,11 @@ const Module* ModuleLoader::loadPrivateRTShaderModule(SkSL::Compiler* compiler)
 const Module* ModuleLoader::loadSharedModule(SkSL::Compiler* compiler) {
     if (!fModuleLoader.fSharedModule) {
         const Module* rootModule = this->rootModule();
-        fModuleLoader.fSharedModule = compile_and_shrink(compiler,
-                                                         ProgramKind::kFragment,
-                                                         MODULE_DATA(sksl_shared),
-                                                         rootModule);
+        fModuleLoader.fSharedModule = load_module(compiler,
+                                                  fModuleLoader.fUseDehydratedModules,
+                                                  ProgramKind::kFragment,
+                                                  MODULE_DATA(sksl_shared),
+                                                  rootModule);
     }
     return fModuleLoader.fSharedModule.get();
 }
@@ -333,10 +392,11 @@ const Module* ModuleLoader::loadSharedModule(SkSL::Compiler* compiler) {
 const Module* ModuleLoader::loadGPUModule(SkSL::Compiler* compiler) {
     if (!fModuleLoader.fGPUModule) {
         const Module* sharedModule = this->loadSharedModule(compiler);
-        fModuleLoader.fGPUModule = compile_and_shrink(compiler,
-                                                      ProgramKind::kFragment,
-                                                      MODULE_DATA(sksl_gpu),
-                                                      sharedModule);
+        fModuleLoader.fGPUModule = load_module(compiler,
+                                               fModuleLoader.fUseDehydratedModules,
+                                               ProgramKind::kFragment,
+                                               MODULE_DATA(sksl_gpu),
+                                               sharedModule);
     }
     return fModuleLoader.fGPUModule.get();
 }
@@ -344,10 +404,11 @@ const Module* ModuleLoader::loadGPUModule(SkSL::Compiler* compiler) {
 const Module* ModuleLoader::loadFragmentModule(SkSL::Compiler* compiler) {
     if (!fModuleLoader.fFragmentModule) {
         const Module* gpuModule = this->loadGPUModule(compiler);
-        fModuleLoader.fFragmentModule = compile_and_shrink(compiler,
-                                                           ProgramKind::kFragment,
-                                                           MODULE_DATA(sksl_frag),
-                                                           gpuModule);
+        fModuleLoader.fFragmentModule = load_module(compiler,
+                                                    fModuleLoader.fUseDehydratedModules,
+                                                    ProgramKind::kFragment,
+                                                    MODULE_DATA(sksl_frag),
+                                                    gpuModule);
     }
     return fModuleLoader.fFragmentModule.get();
 }
@@ -355,10 +416,11 @@ const Module* ModuleLoader::loadFragmentModule(SkSL::Compiler* compiler) {
 const Module* ModuleLoader::loadVertexModule(SkSL::Compiler* compiler) {
     if (!fModuleLoader.fVertexModule) {
         const Module* gpuModule = this->loadGPUModule(compiler);
-        fModuleLoader.fVertexModule = compile_and_shrink(compiler,
-                                                         ProgramKind::kVertex,
-                                                         MODULE_DATA(sksl_vert),
-                                                         gpuModule);
+        fModuleLoader.fVertexModule = load_module(compiler,
+                                                  fModuleLoader.fUseDehydratedModules,
+                                                  ProgramKind::kVertex,
+                                                  MODULE_DATA(sksl_vert),
+                                                  gpuModule);
     }
     return fModuleLoader.fVertexModule.get();
 }
@@ -366,10 +428,11 @@ const Module* ModuleLoader::loadVertexModule(SkSL::Compiler* compiler) {
 const Module* ModuleLoader::loadComputeModule(SkSL::Compiler* compiler) {
     if (!fModuleLoader.fComputeModule) {
         const Module* gpuModule = this->loadGPUModule(compiler);
-        fModuleLoader.fComputeModule = compile_and_shrink(compiler,
-                                                          ProgramKind::kCompute,
-                                                          MODULE_DATA(sksl_compute),
-                                                          gpuModule);
+        fModuleLoader.fComputeModule = load_module(compiler,
+                                                   fModuleLoader.fUseDehydratedModules,
+                                                   ProgramKind::kCompute,
+                                                   MODULE_DATA(sksl_compute),
+                                                   gpuModule);
     }
     return fModuleLoader.fComputeModule.get();
 }
@@ -378,10 +441,11 @@ const Module* ModuleLoader::loadGraphiteFragmentModule(SkSL::Compiler* compiler)
 #if defined(SK_GRAPHITE)
     if (!fModuleLoader.fGraphiteFragmentModule) {
         const Module* fragmentModule = this->loadFragmentModule(compiler);
-        fModuleLoader.fGraphiteFragmentModule = compile_and_shrink(compiler,
-                                                                   ProgramKind::kGraphiteFragment,
-                                                                   MODULE_DATA(sksl_graphite_frag),
-                                                                   fragmentModule);
+        fModuleLoader.fGraphiteFragmentModule = load_module(compiler,
+                                                            fModuleLoader.fUseDehydratedModules,
+                                                            ProgramKind::kGraphiteFragment,
+                                                            MODULE_DATA(sksl_graphite_frag),
+                                                            fragmentModule);
     }
     return fModuleLoader.fGraphiteFragmentModule.get();
 #else
@@ -394,10 +458,11 @@ const Module* ModuleLoader::loadGraphiteFragmentES2Module(SkSL::Compiler* compil
     if (!fModuleLoader.fGraphiteFragmentES2Module) {
         const Module* fragmentModule = this->loadFragmentModule(compiler);
         fModuleLoader.fGraphiteFragmentES2Module =
-                compile_and_shrink(compiler,
-                                   ProgramKind::kGraphiteFragmentES2,
-                                   MODULE_DATA(sksl_graphite_frag_es2),
-                                   fragmentModule);
+                load_module(compiler,
+                            fModuleLoader.fUseDehydratedModules,
+                            ProgramKind::kGraphiteFragmentES2,
+                            MODULE_DATA(sksl_graphite_frag_es2),
+                            fragmentModule);
     }
     return fModuleLoader.fGraphiteFragmentES2Module.get();
 #else
@@ -409,10 +474,11 @@ const Module* ModuleLoader::loadGraphiteVertexModule(SkSL::Compiler* compiler) {
 #if defined(SK_GRAPHITE)
     if (!fModuleLoader.fGraphiteVertexModule) {
         const Module* vertexModule = this->loadVertexModule(compiler);
-        fModuleLoader.fGraphiteVertexModule = compile_and_shrink(compiler,
-                                                                 ProgramKind::kGraphiteVertex,
-                                                                 MODULE_DATA(sksl_graphite_vert),
-                                                                 vertexModule);
+        fModuleLoader.fGraphiteVertexModule = load_module(compiler,
+                                                          fModuleLoader.fUseDehydratedModules,
+                                                          ProgramKind::kGraphiteVertex,
+                                                          MODULE_DATA(sksl_graphite_vert),
+                                                          vertexModule);
     }
     return fModuleLoader.fGraphiteVertexModule.get();
 #else
@@ -425,10 +491,11 @@ const Module* ModuleLoader::loadGraphiteVertexES2Module(SkSL::Compiler* compiler
     if (!fModuleLoader.fGraphiteVertexES2Module) {
         const Module* vertexModule = this->loadVertexModule(compiler);
         fModuleLoader.fGraphiteVertexES2Module =
-                compile_and_shrink(compiler,
-                                   ProgramKind::kGraphiteVertexES2,
-                                   MODULE_DATA(sksl_graphite_vert_es2),
-                                   vertexModule);
+                load_module(compiler,
+                            fModuleLoader.fUseDehydratedModules,
+                            ProgramKind::kGraphiteVertexES2,
+                            MODULE_DATA(sksl_graphite_vert_es2),
+                            vertexModule);
     }
     return fModuleLoader.fGraphiteVertexES2Module.get();
 #else
@@ -58,6 +58,11 @@ public:
 
     // This unloads every module. It's useful primarily for benchmarking purposes.
     void unloadModules();
+
+    // Modules are loaded from their dehydrated IR when the build includes it (see
+    // SkSLModuleLoader.cpp), unless this is turned off. Turning it off makes modules that are
+    // loaded afterwards compile from their source, which is useful for benchmarking and testing.
+    void useDehydratedModules(bool enabled);
 };
 
 }  // namespace SkSL
@@ -54,6 +54,12 @@ struct ProgramSettings {
     int fInlineThreshold = SkSL::kDefaultInlineThreshold;
     // If true, every function in the generated program will be given the `noinline` modifier.
     bool fForceNoInline = false;
+    // (Requires fOptimize = true) When greater than zero, unrolls `for` loops with a constant
+    // iteration count. The threshold value sets an upper limit on the size of the unrolled loop.
+    int fUnrollLoopThreshold = 0;
+    // (Requires fOptimize = true) Reuses the value of an expression that was already computed
+    // earlier in the same block, instead of computing it again.
+    bool fEliminateCommonSubexpressions = false;
     // If true, implicit conversions to lower precision numeric types are allowed (e.g., float to
     // half). These are always allowed when compiling Runtime Effects.
     bool fAllowNarrowingConversions = false;
@@ -0,0 +1,794 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/sksl/SkSLRehydrator.h"
+
+#include "src/core/SkChecksum.h"
+#include "src/sksl/SkSLContext.h"
+#include "src/sksl/SkSLIntrinsicList.h"
+#include "src/sksl/SkSLOperator.h"
+#include "src/sksl/SkSLPosition.h"
+#include "src/sksl/ir/SkSLBinaryExpression.h"
+#include "src/sksl/ir/SkSLBlock.h"
+#include "src/sksl/ir/SkSLBreakStatement.h"
+#include "src/sksl/ir/SkSLConstructorArray.h"
+#include "src/sksl/ir/SkSLConstructorArrayCast.h"
+#include "src/sksl/ir/SkSLConstructorCompound.h"
+#include "src/sksl/ir/SkSLConstructorCompoundCast.h"
+#include "src/sksl/ir/SkSLConstructorDiagonalMatrix.h"
+#include "src/sksl/ir/SkSLConstructorMatrixResize.h"
+#include "src/sksl/ir/SkSLConstructorScalarCast.h"
+#include "src/sksl/ir/SkSLConstructorSplat.h"
+#include "src/sksl/ir/SkSLConstructorStruct.h"
+#include "src/sksl/ir/SkSLContinueStatement.h"
+#include "src/sksl/ir/SkSLDiscardStatement.h"
+#include "src/sksl/ir/SkSLDoStatement.h"
+#include "src/sksl/ir/SkSLExpression.h"
+#include "src/sksl/ir/SkSLExpressionStatement.h"
+#include "src/sksl/ir/SkSLFieldAccess.h"
+#include "src/sksl/ir/SkSLFieldSymbol.h"
+#include "src/sksl/ir/SkSLForStatement.h"
+#include "src/sksl/ir/SkSLFunctionCall.h"
+#include "src/sksl/ir/SkSLFunctionDeclaration.h"
+#include "src/sksl/ir/SkSLFunctionDefinition.h"
+#include "src/sksl/ir/SkSLIfStatement.h"
+#include "src/sksl/ir/SkSLIndexExpression.h"
+#include "src/sksl/ir/SkSLInterfaceBlock.h"
+#include "src/sksl/ir/SkSLLayout.h"
+#include "src/sksl/ir/SkSLLiteral.h"
+#include "src/sksl/ir/SkSLModifierFlags.h"
+#include "src/sksl/ir/SkSLNop.h"
+#include "src/sksl/ir/SkSLPostfixExpression.h"
+#include "src/sksl/ir/SkSLPrefixExpression.h"
+#include "src/sksl/ir/SkSLProgramElement.h"
+#include "src/sksl/ir/SkSLReturnStatement.h"
+#include "src/sksl/ir/SkSLSetting.h"
+#include "src/sksl/ir/SkSLStatement.h"
+#include "src/sksl/ir/SkSLStructDefinition.h"
+#include "src/sksl/ir/SkSLSwitchCase.h"
+#include "src/sksl/ir/SkSLSwitchStatement.h"
+#include "src/sksl/ir/SkSLSwizzle.h"
+#include "src/sksl/ir/SkSLSymbol.h"
+#include "src/sksl/ir/SkSLSymbolTable.h"
+#include "src/sksl/ir/SkSLTernaryExpression.h"
+#include "src/sksl/ir/SkSLType.h"
+#include "src/sksl/ir/SkSLVarDeclarations.h"
+#include "src/sksl/ir/SkSLVariable.h"
+#include "src/sksl/ir/SkSLVariableReference.h"
+
+#include <cstring>
+#include <string>
+#include <utility>
+
+using namespace skia_private;
+
+namespace SkSL {
+
+Rehydrator::Rehydrator(const Context& context, SkSpan<const uint8_t> data)
+        : fContext(context)
+        , fPtr(data.data())
+        , fEnd(data.data() + data.size()) {}
+
+Rehydrator::~Rehydrator() = default;
+
+bool Rehydrator::readBytes(void* dst, size_t size) {
+    if (fFailed || (size_t)(fEnd - fPtr) < size) {
+        return this->fail();
+    }
+    memcpy(dst, fPtr, size);
+    fPtr += size;
+    return true;
+}
+
+uint8_t Rehydrator::readU8() {
+    uint8_t value = 0;
+    this->readBytes(&value, sizeof(value));
+    return value;
+}
+
+uint16_t Rehydrator::readU16() {
+    uint16_t value = 0;
+    this->readBytes(&value, sizeof(value));
+    return value;
+}
+
+uint32_t Rehydrator::readU32() {
+    uint32_t value = 0;
+    this->readBytes(&value, sizeof(value));
+    return value;
+}
+
+int32_t Rehydrator::readS32() {
+    int32_t value = 0;
+    this->readBytes(&value, sizeof(value));
+    return value;
+}
+
+int64_t Rehydrator::readS64() {
+    int64_t value = 0;
+    this->readBytes(&value, sizeof(value));
+    return value;
+}
+
+double Rehydrator::readDouble() {
+    double value = 0;
+    this->readBytes(&value, sizeof(value));
+    return value;
+}
+
+std::string_view Rehydrator::readString() {
+    uint16_t length = this->readU16();
+    if (fFailed || (size_t)(fEnd - fPtr) < length) {
+        this->fail();
+        return {};
+    }
+    std::string_view result(reinterpret_cast<const char*>(fPtr), length);
+    fPtr += length;
+    return result;
+}
+
+bool Rehydrator::readLayout(Layout* layout) {
+    if (!this->readU8()) {
+        *layout = Layout{};
+        return !fFailed;
+    }
+    layout->fFlags = static_cast<LayoutFlag>(this->readS32());
+    layout->fLocation = this->readS32();
+    layout->fOffset = this->readS32();
+    layout->fBinding = this->readS32();
+    layout->fTexture = this->readS32();
+    layout->fSampler = this->readS32();
+    layout->fIndex = this->readS32();
+    layout->fSet = this->readS32();
+    layout->fBuiltin = this->readS32();
+    layout->fInputAttachmentIndex = this->readS32();
+    layout->fLocalSizeX = this->readS32();
+    layout->fLocalSizeY = this->readS32();
+    layout->fLocalSizeZ = this->readS32();
+    return !fFailed;
+}
+
+Symbol* Rehydrator::readSymbolRef() {
+    uint16_t id = this->readU16();
+    if (fFailed || id == kNoSymbol) {
+        return nullptr;
+    }
+    if (id & kImportedSymbol) {
+        id &= ~kImportedSymbol;
+        if (id >= fImports.size()) {
+            this->fail();
+            return nullptr;
+        }
+        return fImports[id];
+    }
+    if (id >= fSymbols.size()) {
+        this->fail();
+        return nullptr;
+    }
+    return fSymbols[id];
+}
+
+const Type* Rehydrator::readTypeRef() {
+    Symbol* symbol = this->readSymbolRef();
+    if (!symbol || !symbol->is<Type>()) {
+        this->fail();
+        return nullptr;
+    }
+    return &symbol->as<Type>();
+}
+
+Variable* Rehydrator::readVariableRef() {
+    Symbol* symbol = this->readSymbolRef();
+    if (!symbol || !symbol->is<Variable>()) {
+        this->fail();
+        return nullptr;
+    }
+    return &symbol->as<Variable>();
+}
+
+bool Rehydrator::readImports() {
+    // The imported symbols are the ones the module uses from its parents; the symbol table that the
+    // module's symbols are declared in still only holds its parents' symbols at this point.
+    const SymbolTable* parentSymbols = fSymbolTable->fParent;
+    if (!parentSymbols) {
+        return this->fail();
+    }
+    int count = this->readU16();
+    fImports.reserve_exact(count);
+    for (int i = 0; i < count && !fFailed; ++i) {
+        auto kind = (ImportKind)this->readU8();
+        std::string_view name = this->readString();
+        Symbol* symbol = fFailed ? nullptr : parentSymbols->findMutable(name);
+        switch (kind) {
+            case ImportKind::kType:
+                if (!symbol || !symbol->is<Type>()) {
+                    return this->fail();
+                }
+                break;
+
+            case ImportKind::kVariable:
+                if (!symbol || !symbol->is<Variable>()) {
+                    return this->fail();
+                }
+                break;
+
+            case ImportKind::kFunction: {
+                STArray<8, const Type*> parameterTypes;
+                int parameterCount = this->readU8();
+                for (int p = 0; p < parameterCount; ++p) {
+                    parameterTypes.push_back(this->readTypeRef());
+                }
+                if (fFailed || !symbol || !symbol->is<FunctionDeclaration>()) {
+                    return this->fail();
+                }
+                // Find the overload that takes the same parameter types.
+                FunctionDeclaration* overload = &symbol->as<FunctionDeclaration>();
+                for (; overload; overload = overload->mutableNextOverload()) {
+                    SkSpan<Variable* const> parameters = overload->parameters();
+                    if (parameters.size() == (size_t)parameterCount &&
+                        std::equal(parameters.begin(), parameters.end(), parameterTypes.begin(),
+                                   [](const Variable* param, const Type* type) {
+                                       return &param->type() == type;
+                                   })) {
+                        break;
+                    }
+                }
+                if (!overload) {
+                    return this->fail();
+                }
+                symbol = overload;
+                break;
+            }
+            default:
+                return this->fail();
+        }
+        fImports.push_back(symbol);
+    }
+    return !fFailed;
+}
+
+bool Rehydrator::readSymbol(SymbolTable* table) {
+    if ((int)fSymbols.size() >= kMaxSymbols) {
+        return this->fail();
+    }
+    std::unique_ptr<Symbol> symbol;
+    switch ((SymbolKind)this->readU8()) {
+        case SymbolKind::kArrayType: {
+            std::string_view name = this->readString();
+            const Type* componentType = this->readTypeRef();
+            int columns = this->readS32();
+            if (fFailed) {
+                return false;
+            }
+            symbol = Type::MakeArrayType(fContext, name, *componentType, columns);
+            break;
+        }
+        case SymbolKind::kStructType: {
+            std::string_view name = this->readString();
+            bool interfaceBlock = this->readU8();
+            int fieldCount = this->readU8();
+            TArray<Field> fields;
+            fields.reserve_exact(fieldCount);
+            for (int i = 0; i < fieldCount && !fFailed; ++i) {
+                Layout layout;
+                this->readLayout(&layout);
+                ModifierFlags flags = static_cast<ModifierFlag>(this->readS32());
+                std::string_view fieldName = this->readString();
+                const Type* type = this->readTypeRef();
+                fields.emplace_back(Position(), layout, flags, fieldName, type);
+            }
+            if (fFailed) {
+                return false;
+            }
+            symbol = Type::MakeStructType(fContext, Position(), name, std::move(fields),
+                                          interfaceBlock);
+            break;
+        }
+        case SymbolKind::kVariable: {
+            std::string_view name = this->readString();
+            std::string_view mangledName = this->readString();
+            Layout layout;
+            this->readLayout(&layout);
+            ModifierFlags flags = static_cast<ModifierFlag>(this->readS32());
+            const Type* type = this->readTypeRef();
+            bool builtin = this->readU8();
+            auto storage = (Variable::Storage)this->readU8();
+            if (fFailed || storage > Variable::Storage::kParameter) {
+                return this->fail();
+            }
+            symbol = Variable::Make(Position(), Position(), layout, flags, type, name,
+                                    std::string(mangledName), builtin, storage);
+            break;
+        }
+        case SymbolKind::kFunctionDeclaration: {
+            std::string_view name = this->readString();
+            ModifierFlags flags = static_cast<ModifierFlag>(this->readS32());
+            const Type* returnType = this->readTypeRef();
+            int parameterCount = this->readU8();
+            TArray<Variable*> parameters;
+            parameters.reserve_exact(parameterCount);
+            for (int i = 0; i < parameterCount; ++i) {
+                parameters.push_back(this->readVariableRef());
+            }
+            Symbol* nextOverload = this->readSymbolRef();
+            if (fFailed || (nextOverload && !nextOverload->is<FunctionDeclaration>())) {
+                return this->fail();
+            }
+            // Functions without a body are intrinsics; the kind is cleared again when the
+            // function's definition is read.
+            auto decl = std::make_unique<FunctionDeclaration>(fContext,
+                                                              Position(),
+                                                              flags,
+                                                              name,
+                                                              std::move(parameters),
+                                                              returnType,
+                                                              FindIntrinsicKind(name));
+            if (nextOverload) {
+                if (nextOverload->name() != name) {
+                    return this->fail();
+                }
+                decl->setNextOverload(&nextOverload->as<FunctionDeclaration>());
+            }
+            symbol = std::move(decl);
+            break;
+        }
+        case SymbolKind::kField: {
+            const Variable* owner = this->readVariableRef();
+            int fieldIndex = this->readU16();
+            if (fFailed || fieldIndex >= (int)owner->type().fields().size()) {
+                return this->fail();
+            }
+            symbol = std::make_unique<FieldSymbol>(Position(), owner, fieldIndex);
+            break;
+        }
+        default:
+            return this->fail();
+    }
+    if (!symbol) {
+        return this->fail();
+    }
+    fSymbols.push_back(table->takeOwnershipOfSymbol(std::move(symbol)));
+    return true;
+}
+
+bool Rehydrator::readSymbolTable(SymbolTable* table) {
+    int ownedCount = this->readU16();
+    for (int i = 0; i < ownedCount && !fFailed; ++i) {
+        if (!this->readSymbol(table)) {
+            return this->fail();
+        }
+    }
+    // Symbols are looked up by their own names; functions by the newest overload.
+    int namedCount = this->readU16();
+    for (int i = 0; i < namedCount && !fFailed; ++i) {
+        Symbol* symbol = this->readSymbolRef();
+        if (!symbol || symbol->name().empty()) {
+            return this->fail();
+        }
+        table->injectWithoutOwnership(symbol);
+    }
+    return !fFailed;
+}
+
+std::unique_ptr<SymbolTable> Rehydrator::readNestedSymbolTable() {
+    bool builtin = this->readU8();
+    auto table = std::make_unique<SymbolTable>(fSymbolTable, builtin);
+    if (!this->readSymbolTable(table.get())) {
+        return nullptr;
+    }
+    return table;
+}
+
+bool Rehydrator::readModule(std::string_view source,
+                            std::vector<std::unique_ptr<ProgramElement>>* elements) {
+    fSymbolTable = fContext.fSymbolTable;
+    if (!fSymbolTable || this->readU32() != kMagic || this->readU16() != kVersion ||
+        this->readU32() != SkChecksum::Hash32(source.data(), source.size())) {
+        return this->fail();
+    }
+    if (!this->readImports() || !this->readSymbolTable(fSymbolTable)) {
+        return this->fail();
+    }
+    int elementCount = this->readU16();
+    elements->reserve(elementCount);
+    for (int i = 0; i < elementCount; ++i) {
+        std::unique_ptr<ProgramElement> element = this->readElement();
+        if (!element) {
+            return this->fail();
+        }
+        elements->push_back(std::move(element));
+    }
+    return !fFailed && fPtr == fEnd;
+}
+
+std::unique_ptr<ProgramElement> Rehydrator::readElement() {
+    switch ((ElementKind)this->readU8()) {
+        case ElementKind::kFunction: {
+            Symbol* symbol = this->readSymbolRef();
+            if (!symbol || !symbol->is<FunctionDeclaration>()) {
+                break;
+            }
+            FunctionDeclaration& decl = symbol->as<FunctionDeclaration>();
+            std::unique_ptr<Statement> body = this->readStatement();
+            if (!body || !body->is<Block>() || decl.definition()) {
+                break;
+            }
+            auto function = std::make_unique<FunctionDefinition>(Position(), &decl,
+                                                                 /*builtin=*/true,
+                                                                 std::move(body));
+            decl.setDefinition(function.get());
+            return function;
+        }
+        case ElementKind::kGlobalVar: {
+            std::unique_ptr<Statement> decl = this->readStatement();
+            if (!decl || !decl->is<VarDeclaration>()) {
+                break;
+            }
+            return std::make_unique<GlobalVarDeclaration>(std::move(decl));
+        }
+        case ElementKind::kInterfaceBlock: {
+            Variable* var = this->readVariableRef();
+            if (!var || !var->type().componentType().isInterfaceBlock() || var->interfaceBlock()) {
+                break;
+            }
+            return std::make_unique<InterfaceBlock>(Position(), var);
+        }
+        case ElementKind::kStructDefinition: {
+            const Type* type = this->readTypeRef();
+            if (!type || !type->isStruct()) {
+                break;
+            }
+            return std::make_unique<StructDefinition>(Position(), *type);
+        }
+        default:
+            break;
+    }
+    this->fail();
+    return nullptr;
+}
+
+std::unique_ptr<Statement> Rehydrator::readStatement() {
+    uint8_t kind = this->readU8();
+    if (fFailed || kind == kNone) {
+        return nullptr;
+    }
+    switch ((StatementKind)kind) {
+        case StatementKind::kBlock: {
+            auto blockKind = (Block::Kind)this->readU8();
+            std::unique_ptr<SymbolTable> symbols;
+            if (this->readU8()) {
+                symbols = this->readNestedSymbolTable();
+                if (!symbols) {
+                    break;
+                }
+            }
+            // The block's statements are nested in its symbol table, if it has one.
+            SymbolTable* enclosingTable = fSymbolTable;
+            if (symbols) {
+                fSymbolTable = symbols.get();
+            }
+            StatementArray statements;
+            int count = this->readU16();
+            statements.reserve_exact(count);
+            for (int i = 0; i < count; ++i) {
+                std::unique_ptr<Statement> statement = this->readStatement();
+                if (!statement) {
+                    break;
+                }
+                statements.push_back(std::move(statement));
+            }
+            fSymbolTable = enclosingTable;
+            if (fFailed || statements.size() != count) {
+                break;
+            }
+            return std::make_unique<Block>(Position(), std::move(statements), blockKind,
+                                           std::move(symbols));
+        }
+        case StatementKind::kBreak:
+            return std::make_unique<BreakStatement>(Position());
+
+        case StatementKind::kContinue:
+            return std::make_unique<ContinueStatement>(Position());
+
+        case StatementKind::kDiscard:
+            return std::make_unique<DiscardStatement>(Position());
+
+        case StatementKind::kDo: {
+            std::unique_ptr<Statement> statement = this->readStatement();
+            std::unique_ptr<Expression> test = this->readExpression();
+            if (!statement || !test) {
+                break;
+            }
+            return std::make_unique<DoStatement>(Position(), std::move(statement),
+                                                 std::move(test));
+        }
+        case StatementKind::kExpression: {
+            std::unique_ptr<Expression> expression = this->readExpression();
+            if (!expression) {
+                break;
+            }
+            return std::make_unique<ExpressionStatement>(std::move(expression));
+        }
+        case StatementKind::kFor: {
+            std::unique_ptr<SymbolTable> symbols;
+            if (this->readU8()) {
+                symbols = this->readNestedSymbolTable();
+                if (!symbols) {
+                    break;
+                }
+            }
+            SymbolTable* enclosingTable = fSymbolTable;
+            if (symbols) {
+                fSymbolTable = symbols.get();
+            }
+            std::unique_ptr<Statement> initializer = this->readStatement();
+            std::unique_ptr<Expression> test = this->readExpression();
+            std::unique_ptr<Expression> next = this->readExpression();
+            std::unique_ptr<Statement> statement = this->readStatement();
+            std::unique_ptr<LoopUnrollInfo> unrollInfo;
+            if (this->readU8()) {
+                unrollInfo = std::make_unique<LoopUnrollInfo>();
+                unrollInfo->fIndex = this->readVariableRef();
+                unrollInfo->fStart = this->readDouble();
+                unrollInfo->fDelta = this->readDouble();
+                unrollInfo->fCount = this->readS32();
+            }
+            fSymbolTable = enclosingTable;
+            if (fFailed || !statement) {
+                break;
+            }
+            return std::make_unique<ForStatement>(Position(), ForLoopPositions{},
+                                                  std::move(initializer), std::move(test),
+                                                  std::move(next), std::move(statement),
+                                                  std::move(unrollInfo), std::move(symbols));
+        }
+        case StatementKind::kIf: {
+            std::unique_ptr<Expression> test = this->readExpression();
+            std::unique_ptr<Statement> ifTrue = this->readStatement();
+            std::unique_ptr<Statement> ifFalse = this->readStatement();
+            if (fFailed || !test || !ifTrue) {
+                break;
+            }
+            return std::make_unique<IfStatement>(Position(), std::move(test), std::move(ifTrue),
+                                                 std::move(ifFalse));
+        }
+        case StatementKind::kNop:
+            return std::make_unique<Nop>();
+
+        case StatementKind::kReturn: {
+            std::unique_ptr<Expression> expression = this->readExpression();
+            if (fFailed) {
+                break;
+            }
+            return std::make_unique<ReturnStatement>(Position(), std::move(expression));
+        }
+        case StatementKind::kSwitch: {
+            std::unique_ptr<Expression> value = this->readExpression();
+            std::unique_ptr<Statement> caseBlock = this->readStatement();
+            if (!value || !caseBlock || !caseBlock->is<Block>()) {
+                break;
+            }
+            return std::make_unique<SwitchStatement>(Position(), std::move(value),
+                                                     std::move(caseBlock));
+        }
+        case StatementKind::kSwitchCase: {
+            bool isDefault = this->readU8();
+            SKSL_INT value = this->readS64();
+            std::unique_ptr<Statement> statement = this->readStatement();
+            if (!statement) {
+                break;
+            }
+            return isDefault ? SwitchCase::MakeDefault(Position(), std::move(statement))
+                             : SwitchCase::Make(Position(), value, std::move(statement));
+        }
+        case StatementKind::kVarDeclaration: {
+            Variable* var = this->readVariableRef();
+            const Type* baseType = this->readTypeRef();
+            int arraySize = this->readS32();
+            std::unique_ptr<Expression> value = this->readExpression();
+            if (fFailed || var->varDeclaration()) {
+                break;
+            }
+            auto decl = std::make_unique<VarDeclaration>(var, baseType, arraySize,
+                                                         std::move(value));
+            var->setVarDeclaration(decl.get());
+            return decl;
+        }
+        default:
+            break;
+    }
+    this->fail();
+    return nullptr;
+}
+
+bool Rehydrator::readExpressionArray(ExpressionArray* args) {
+    int count = this->readU8();
+    args->reserve_exact(count);
+    for (int i = 0; i < count; ++i) {
+        std::unique_ptr<Expression> arg = this->readExpression();
+        if (!arg) {
+            return this->fail();
+        }
+        args->push_back(std::move(arg));
+    }
+    return !fFailed;
+}
+
+std::unique_ptr<Expression> Rehydrator::readExpression() {
+    uint8_t kind = this->readU8();
+    if (fFailed || kind == kNone) {
+        return nullptr;
+    }
+    switch ((ExpressionKind)kind) {
+        case ExpressionKind::kBinary: {
+            std::unique_ptr<Expression> left = this->readExpression();
+            auto op = (Operator::Kind)this->readU8();
+            std::unique_ptr<Expression> right = this->readExpression();
+            const Type* type = this->readTypeRef();
+            if (fFailed || !left || !right) {
+                break;
+            }
+            return std::make_unique<BinaryExpression>(Position(), std::move(left), op,
+                                                      std::move(right), type);
+        }
+        case ExpressionKind::kConstructorArray:
+        case ExpressionKind::kConstructorCompound:
+        case ExpressionKind::kConstructorStruct: {
+            const Type* type = this->readTypeRef();
+            ExpressionArray args;
+            if (!this->readExpressionArray(&args)) {
+                break;
+            }
+            switch ((ExpressionKind)kind) {
+                case ExpressionKind::kConstructorArray:
+                    return std::make_unique<ConstructorArray>(Position(), *type, std::move(args));
+                case ExpressionKind::kConstructorCompound:
+                    return std::make_unique<ConstructorCompound>(Position(), *type,
+                                                                 std::move(args));
+                default:
+                    return std::make_unique<ConstructorStruct>(Position(), *type, std::move(args));
+            }
+        }
+        case ExpressionKind::kConstructorArrayCast:
+        case ExpressionKind::kConstructorCompoundCast:
+        case ExpressionKind::kConstructorDiagonalMatrix:
+        case ExpressionKind::kConstructorMatrixResize:
+        case ExpressionKind::kConstructorScalarCast:
+        case ExpressionKind::kConstructorSplat: {
+            const Type* type = this->readTypeRef();
+            std::unique_ptr<Expression> arg = this->readExpression();
+            if (fFailed || !arg) {
+                break;
+            }
+            switch ((ExpressionKind)kind) {
+                case ExpressionKind::kConstructorArrayCast:
+                    return std::make_unique<ConstructorArrayCast>(Position(), *type,
+                                                                  std::move(arg));
+                case ExpressionKind::kConstructorCompoundCast:
+                    return std::make_unique<ConstructorCompoundCast>(Position(), *type,
+                                                                     std::move(arg));
+                case ExpressionKind::kConstructorDiagonalMatrix:
+                    return std::make_unique<ConstructorDiagonalMatrix>(Position(), *type,
+                                                                       std::move(arg));
+                case ExpressionKind::kConstructorMatrixResize:
+                    return std::make_unique<ConstructorMatrixResize>(Position(), *type,
+                                                                     std::move(arg));
+                case ExpressionKind::kConstructorScalarCast:
+                    return std::make_unique<ConstructorScalarCast>(Position(), *type,
+                                                                   std::move(arg));
+                default:
+                    return std::make_unique<ConstructorSplat>(Position(), *type, std::move(arg));
+            }
+        }
+        case ExpressionKind::kFieldAccess: {
+            std::unique_ptr<Expression> base = this->readExpression();
+            int fieldIndex = this->readU16();
+            auto ownerKind = (FieldAccess::OwnerKind)this->readU8();
+            if (fFailed || !base || fieldIndex >= (int)base->type().fields().size()) {
+                break;
+            }
+            return std::make_unique<FieldAccess>(Position(), std::move(base), fieldIndex,
+                                                 ownerKind);
+        }
+        case ExpressionKind::kFunctionCall: {
+            const Type* type = this->readTypeRef();
+            Symbol* function = this->readSymbolRef();
+            ExpressionArray args;
+            if (!this->readExpressionArray(&args) || !function ||
+                !function->is<FunctionDeclaration>()) {
+                break;
+            }
+            return std::make_unique<FunctionCall>(Position(), type,
+                                                  &function->as<FunctionDeclaration>(),
+                                                  std::move(args));
+        }
+        case ExpressionKind::kIndex: {
+            std::unique_ptr<Expression> base = this->readExpression();
+            std::unique_ptr<Expression> index = this->readExpression();
+            if (fFailed || !base || !index) {
+                break;
+            }
+            return std::make_unique<IndexExpression>(fContext, Position(), std::move(base),
+                                                     std::move(index));
+        }
+        case ExpressionKind::kLiteral: {
+            const Type* type = this->readTypeRef();
+            double value = this->readDouble();
+            if (fFailed) {
+                break;
+            }
+            return std::make_unique<Literal>(Position(), value, type);
+        }
+        case ExpressionKind::kPostfix: {
+            std::unique_ptr<Expression> operand = this->readExpression();
+            auto op = (Operator::Kind)this->readU8();
+            if (fFailed || !operand) {
+                break;
+            }
+            return std::make_unique<PostfixExpression>(Position(), std::move(operand), op);
+        }
+        case ExpressionKind::kPrefix: {
+            auto op = (Operator::Kind)this->readU8();
+            std::unique_ptr<Expression> operand = this->readExpression();
+            if (fFailed || !operand) {
+                break;
+            }
+            return std::make_unique<PrefixExpression>(Position(), op, std::move(operand));
+        }
+        case ExpressionKind::kSetting: {
+            std::string_view name = this->readString();
+            if (fFailed) {
+                break;
+            }
+            // This reports an error for a name that isn't a capability.
+            std::unique_ptr<Expression> setting = Setting::Convert(fContext, Position(), name);
+            if (!setting) {
+                break;
+            }
+            return setting;
+        }
+        case ExpressionKind::kSwizzle: {
+            std::unique_ptr<Expression> base = this->readExpression();
+            int count = this->readU8();
+            if (fFailed || !base || count < 1 || count > 4) {
+                break;
+            }
+            ComponentArray components;
+            for (int i = 0; i < count; ++i) {
+                components.push_back((int8_t)this->readU8());
+            }
+            if (fFailed) {
+                break;
+            }
+            return std::make_unique<Swizzle>(fContext, Position(), std::move(base), components);
+        }
+        case ExpressionKind::kTernary: {
+            std::unique_ptr<Expression> test = this->readExpression();
+            std::unique_ptr<Expression> ifTrue = this->readExpression();
+            std::unique_ptr<Expression> ifFalse = this->readExpression();
+            if (fFailed || !test || !ifTrue || !ifFalse) {
+                break;
+            }
+            return std::make_unique<TernaryExpression>(Position(), std::move(test),
+                                                       std::move(ifTrue), std::move(ifFalse));
+        }
+        case ExpressionKind::kVariableReference: {
+            const Variable* var = this->readVariableRef();
+            auto refKind = (VariableRefKind)this->readU8();
+            if (fFailed || refKind > VariableRefKind::kPointer) {
+                break;
+            }
+            return std::make_unique<VariableReference>(Position(), var, refKind);
+        }
+        default:
+            break;
+    }
+    this->fail();
+    return nullptr;
+}
+
+}  // namespace SkSL
@@ -0,0 +1,180 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SKSL_REHYDRATOR
+#define SKSL_REHYDRATOR
+
+#include "include/core/SkSpan.h"
+#include "include/private/base/SkTArray.h"
+#include "src/sksl/SkSLDefines.h"
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace SkSL {
+
+class Context;
+class Expression;
+class ProgramElement;
+class Statement;
+class Symbol;
+class SymbolTable;
+class Type;
+class Variable;
+struct Layout;
+
+/**
+ * Reads a module that was serialized by the Dehydrator back into IR, without lexing, parsing or
+ * optimizing its source again. Symbol names point straight into the dehydrated data, which must
+ * outlive the module.
+ *
+ * The dehydrated module holds the IR of a module that was compiled from `source` and inlined. Its
+ * symbols are declared in the context's symbol table, which must be a fresh module-level table on
+ * top of the parent module's symbols, in the same order that the compiler declared them. Symbols
+ * of the parent modules are looked up by name; types by name, and functions by name and parameter
+ * types.
+ *
+ * The data is checked as it is read. If it is malformed, was made from another source, or refers
+ * to a symbol the parent modules don't have, reading fails and the module should be compiled from
+ * its source instead.
+ */
+class Rehydrator {
+public:
+    // The data starts with kMagic, kVersion and the Hash32 of the source. kVersion has to change
+    // whenever the format below changes.
+    inline static constexpr uint32_t kMagic = 0x4c534b53;  // 'SKSL'
+    inline static constexpr uint16_t kVersion = 1;
+
+    // A symbol is identified by a uint16; symbols of the parent modules are imported first, then
+    // the module's own symbols are numbered in the order they're declared.
+    inline static constexpr uint16_t kNoSymbol = 0xFFFF;
+    inline static constexpr uint16_t kImportedSymbol = 0x8000;
+    inline static constexpr int kMaxSymbols = 0x7FFF;
+
+    enum class ImportKind : uint8_t {
+        kType,
+        kVariable,
+        kFunction,
+    };
+
+    // Each symbol, element, statement and expression starts with its kind. These are kept apart
+    // from the IRNode kinds so that adding IR doesn't change the format; operators and modifier
+    // and layout flags are written as their values, and the modules are dehydrated again whenever
+    // those change.
+    enum class SymbolKind : uint8_t {
+        kArrayType,
+        kStructType,
+        kVariable,
+        kFunctionDeclaration,
+        kField,
+    };
+
+    enum class ElementKind : uint8_t {
+        kFunction,
+        kGlobalVar,
+        kInterfaceBlock,
+        kStructDefinition,
+    };
+
+    enum class StatementKind : uint8_t {
+        kBlock,
+        kBreak,
+        kContinue,
+        kDiscard,
+        kDo,
+        kExpression,
+        kFor,
+        kIf,
+        kNop,
+        kReturn,
+        kSwitch,
+        kSwitchCase,
+        kVarDeclaration,
+    };
+
+    enum class ExpressionKind : uint8_t {
+        kBinary,
+        kConstructorArray,
+        kConstructorArrayCast,
+        kConstructorCompound,
+        kConstructorCompoundCast,
+        kConstructorDiagonalMatrix,
+        kConstructorMatrixResize,
+        kConstructorScalarCast,
+        kConstructorSplat,
+        kConstructorStruct,
+        kFieldAccess,
+        kFunctionCall,
+        kIndex,
+        kLiteral,
+        kPostfix,
+        kPrefix,
+        kSetting,
+        kSwizzle,
+        kTernary,
+        kVariableReference,
+    };
+
+    // A missing statement or expression is written as kNone instead of its kind.
+    inline static constexpr uint8_t kNone = 0xFF;
+
+    Rehydrator(const Context& context, SkSpan<const uint8_t> data);
+    ~Rehydrator();
+
+    // Reads the module's symbols into the context's symbol table, and appends its program elements.
+    // Returns false if the data can't be read; the elements and symbols read until then are kept,
+    // so that they are cleaned up along with the rest of the module.
+    bool readModule(std::string_view source,
+                    std::vector<std::unique_ptr<ProgramElement>>* elements);
+
+private:
+    bool fail() {
+        fFailed = true;
+        return false;
+    }
+
+    bool readBytes(void* dst, size_t size);
+    uint8_t readU8();
+    uint16_t readU16();
+    uint32_t readU32();
+    int32_t readS32();
+    int64_t readS64();
+    double readDouble();
+    std::string_view readString();
+
+    bool readLayout(Layout* layout);
+
+    Symbol* readSymbolRef();
+    const Type* readTypeRef();
+    Variable* readVariableRef();
+    bool readImports();
+    bool readSymbolTable(SymbolTable* table);
+    bool readSymbol(SymbolTable* table);
+    std::unique_ptr<SymbolTable> readNestedSymbolTable();
+
+    std::unique_ptr<ProgramElement> readElement();
+    std::unique_ptr<Statement> readStatement();
+    std::unique_ptr<Expression> readExpression();
+    bool readExpressionArray(ExpressionArray* args);
+
+    const Context& fContext;
+    const uint8_t* fPtr;
+    const uint8_t* fEnd;
+    bool fFailed = false;
+
+    // The symbol table that the statements being read are nested in.
+    SymbolTable* fSymbolTable = nullptr;
+
+    skia_private::TArray<Symbol*> fImports;
+    skia_private::TArray<Symbol*> fSymbols;
+};
+
+}  // namespace SkSL
+
+#endif
@@ -8,6 +8,7 @@
 #include "src/sksl/codegen/SkSLRasterPipelineBuilder.h"
 
 #include "include/core/SkStream.h"
+#include "include/private/base/SkAlign.h"
 #include "include/private/base/SkMalloc.h"
 #include "include/private/base/SkTo.h"
 #include "src/base/SkArenaAlloc.h"
@@ -30,7 +31,9 @@
 #include <cmath>
 #include <cstddef>
 #include <cstring>
+#include <initializer_list>
 #include <iterator>
+#include <limits>
 #include <string>
 #include <string_view>
 #include <tuple>
@@ -1631,24 +1634,346 @@ static void* context_bit_pun(intptr_t val) {
     return sk_bit_cast<void*>(val);
 }
 
-Program::SlotData Program::allocateSlotData(SkArenaAlloc* alloc) const {
+Program::SlotData Program::allocateSlotData(SkArenaAlloc* alloc, int numCopies) const {
     // Allocate a contiguous slab of slot data for immutables, values, and stack entries.
     const int N = SkOpts::raster_pipeline_highp_stride;
     const int scalarWidth = 1 * sizeof(float);
     const int vectorWidth = N * sizeof(float);
-    const int allocSize = vectorWidth * (fNumValueSlots + fNumTempStackSlots) +
-                          scalarWidth * fNumImmutableSlots;
-    float* slotPtr = static_cast<float*>(alloc->makeBytesAlignedTo(allocSize, vectorWidth));
-    sk_bzero(slotPtr, allocSize);
+    const int copySize = vectorWidth * (fNumValueSlots + fNumTempStackSlots) +
+                         scalarWidth * fNumImmutableSlots;
+    // Lowp programs need a copy of the slab for each highp-sized part of the lowp stride. The lowp
+    // stages find the distance between copies just ahead of the slots, so leave room for it.
+    const int headerSize = SkAlignTo(sizeof(ptrdiff_t), vectorWidth);
+    const int copyStride = SkAlignTo(copySize, vectorWidth);
+    const int allocSize = headerSize + numCopies * copyStride;
+    std::byte* slab = static_cast<std::byte*>(alloc->makeBytesAlignedTo(allocSize, vectorWidth));
+    sk_bzero(slab, allocSize);
+    float* slotPtr = reinterpret_cast<float*>(slab + headerSize);
+    const ptrdiff_t copyOffset = copyStride;
+    memcpy(slab + headerSize - sizeof(ptrdiff_t), &copyOffset, sizeof(ptrdiff_t));
 
     // Store the temp stack immediately after the values, and immutable data after the stack.
     SlotData s;
     s.values    = SkSpan{slotPtr,        N * fNumValueSlots};
     s.stack     = SkSpan{s.values.end(), N * fNumTempStackSlots};
     s.immutable = SkSpan{s.stack.end(),  1 * fNumImmutableSlots};
+    s.numCopies = numCopies;
+    s.copyStride = copyStride;
     return s;
 }
 
+namespace {
+
+// The range of values a slot might hold. Anything we can't reason about, like NaN, is unbounded.
+struct ValueRange {
+    float fMin = -std::numeric_limits<float>::infinity();
+    float fMax = std::numeric_limits<float>::infinity();
+
+    static ValueRange Hull(std::initializer_list<float> values) {
+        ValueRange range{values.begin()[0], values.begin()[0]};
+        for (float value : values) {
+            if (std::isnan(value)) {
+                return ValueRange{};
+            }
+            range.fMin = std::min(range.fMin, value);
+            range.fMax = std::max(range.fMax, value);
+        }
+        return range;
+    }
+    static ValueRange Exactly(float value) { return Hull({value}); }
+
+    bool isWithin(float min, float max) const { return fMin >= min && fMax <= max; }
+
+    static ValueRange Add(ValueRange a, ValueRange b) {
+        return Hull({a.fMin + b.fMin, a.fMax + b.fMax});
+    }
+    static ValueRange Sub(ValueRange a, ValueRange b) {
+        return Hull({a.fMin - b.fMax, a.fMax - b.fMin});
+    }
+    static ValueRange Mul(ValueRange a, ValueRange b) {
+        return Hull({a.fMin * b.fMin, a.fMin * b.fMax, a.fMax * b.fMin, a.fMax * b.fMax});
+    }
+    static ValueRange Div(ValueRange a, ValueRange b) {
+        if (b.fMin <= 0 && b.fMax >= 0) {
+            return ValueRange{};
+        }
+        return Hull({a.fMin / b.fMin, a.fMin / b.fMax, a.fMax / b.fMin, a.fMax / b.fMax});
+    }
+    static ValueRange Min(ValueRange a, ValueRange b) {
+        return Hull({std::min(a.fMin, b.fMin), std::min(a.fMax, b.fMax)});
+    }
+    static ValueRange Max(ValueRange a, ValueRange b) {
+        return Hull({std::max(a.fMin, b.fMin), std::max(a.fMax, b.fMax)});
+    }
+    static ValueRange Mix(ValueRange x, ValueRange y, ValueRange t) {
+        if (t.isWithin(0, 1)) {
+            return Hull({x.fMin, x.fMax, y.fMin, y.fMax});
+        }
+        return Add(x, Mul(Sub(y, x), t));
+    }
+};
+
+}  // namespace
+
+bool Program::stagesCanRunInLowp(const TArray<Stage>& stages, const SlotData& slots) const {
+    // Lowp can't run traces or control flow, so we only need to follow straight-line programs.
+    if (fDebugTrace) {
+        return false;
+    }
+    const size_t N = SkOpts::raster_pipeline_highp_stride;
+    const size_t vectorWidth = N * sizeof(float);
+    const size_t numVectorSlots = fNumValueSlots + fNumTempStackSlots;
+    const std::byte* basePtr = reinterpret_cast<const std::byte*>(slots.values.data());
+
+    // Nothing is known about a slot until the program writes to it.
+    TArray<ValueRange> ranges;
+    ranges.push_back_n(numVectorSlots);
+
+    // Converts a context into the index of a value or stack slot; returns -1 if it isn't one, or
+    // if `count` slots from there wouldn't fit.
+    auto slotIndex = [&](size_t offset, size_t count) -> int {
+        if (offset % vectorWidth || offset / vectorWidth + count > numVectorSlots) {
+            return -1;
+        }
+        return offset / vectorWidth;
+    };
+    auto slotAt = [&](const void* ptr, size_t count) -> int {
+        const std::byte* bytePtr = static_cast<const std::byte*>(ptr);
+        return bytePtr >= basePtr ? slotIndex(bytePtr - basePtr, count) : -1;
+    };
+    auto immutableAt = [&](size_t offset, size_t count) -> const float* {
+        size_t start = numVectorSlots * vectorWidth;
+        if (offset < start || (offset - start) / sizeof(float) + count > slots.immutable.size()) {
+            return nullptr;
+        }
+        return &slots.immutable[(offset - start) / sizeof(float)];
+    };
+
+    using RangeFn = ValueRange (*)(ValueRange, ValueRange);
+    auto applyBinary = [&](int dst, int numSlots, RangeFn fn) {
+        for (int index = 0; index < numSlots; ++index) {
+            ranges[dst + index] = fn(ranges[dst + index], ranges[dst + numSlots + index]);
+        }
+    };
+    auto applyMix = [&](int dst, int numSlots) {
+        for (int index = 0; index < numSlots; ++index) {
+            ranges[dst + index] = ValueRange::Mix(ranges[dst + numSlots + index],
+                                                  ranges[dst + 2 * numSlots + index],
+                                                  ranges[dst + index]);
+        }
+    };
+
+    bool resultFitsInLowp = false;
+    for (const Stage& stage : stages) {
+        switch (stage.op) {
+            case ProgramOp::init_lane_masks:
+                break;
+
+            case ProgramOp::store_src:
+            case ProgramOp::store_dst: {
+                int dst = slotAt(stage.ctx, 4);
+                if (dst < 0) {
+                    return false;
+                }
+                std::fill_n(&ranges[dst], 4, ValueRange{0, 1});
+                break;
+            }
+            case ProgramOp::load_src: {
+                int src = slotAt(stage.ctx, 4);
+                if (src < 0) {
+                    return false;
+                }
+                resultFitsInLowp = std::all_of(&ranges[src], &ranges[src] + 4,
+                                               [](ValueRange range) {
+                                                   return range.isWithin(0, 1);
+                                               });
+                break;
+            }
+            case ProgramOp::copy_constant:
+            case ProgramOp::splat_2_constants:
+            case ProgramOp::splat_3_constants:
+            case ProgramOp::splat_4_constants: {
+                int numSlots = (int)stage.op - (int)ProgramOp::copy_constant + 1;
+                auto ctx = SkRPCtxUtils::Unpack((SkRasterPipeline_ConstantCtx*)stage.ctx);
+                int dst = slotIndex(ctx.dst, numSlots);
+                if (dst < 0) {
+                    return false;
+                }
+                std::fill_n(&ranges[dst], numSlots,
+                            ValueRange::Exactly(sk_bit_cast<float>(ctx.value)));
+                break;
+            }
+            case ProgramOp::copy_uniform:
+            case ProgramOp::copy_2_uniforms:
+            case ProgramOp::copy_3_uniforms:
+            case ProgramOp::copy_4_uniforms: {
+                int numSlots = (int)stage.op - (int)ProgramOp::copy_uniform + 1;
+                auto* ctx = static_cast<const SkRasterPipeline_UniformCtx*>(stage.ctx);
+                int dst = slotAt(ctx->dst, numSlots);
+                if (dst < 0) {
+                    return false;
+                }
+                for (int index = 0; index < numSlots; ++index) {
+                    ranges[dst + index] = ValueRange::Exactly(sk_bit_cast<float>(ctx->src[index]));
+                }
+                break;
+            }
+            case ProgramOp::copy_slot_unmasked:
+            case ProgramOp::copy_2_slots_unmasked:
+            case ProgramOp::copy_3_slots_unmasked:
+            case ProgramOp::copy_4_slots_unmasked: {
+                int numSlots = (int)stage.op - (int)ProgramOp::copy_slot_unmasked + 1;
+                auto ctx = SkRPCtxUtils::Unpack((SkRasterPipeline_BinaryOpCtx*)stage.ctx);
+                int dst = slotIndex(ctx.dst, numSlots);
+                int src = slotIndex(ctx.src, numSlots);
+                if (dst < 0 || src < 0) {
+                    return false;
+                }
+                std::copy_n(&ranges[src], numSlots, &ranges[dst]);
+                break;
+            }
+            case ProgramOp::copy_immutable_unmasked:
+            case ProgramOp::copy_2_immutables_unmasked:
+            case ProgramOp::copy_3_immutables_unmasked:
+            case ProgramOp::copy_4_immutables_unmasked: {
+                int numSlots = (int)stage.op - (int)ProgramOp::copy_immutable_unmasked + 1;
+                auto ctx = SkRPCtxUtils::Unpack((SkRasterPipeline_BinaryOpCtx*)stage.ctx);
+                int dst = slotIndex(ctx.dst, numSlots);
+                const float* src = immutableAt(ctx.src, numSlots);
+                if (dst < 0 || !src) {
+                    return false;
+                }
+                for (int index = 0; index < numSlots; ++index) {
+                    ranges[dst + index] = ValueRange::Exactly(src[index]);
+                }
+                break;
+            }
+            case ProgramOp::swizzle_1:
+            case ProgramOp::swizzle_2:
+            case ProgramOp::swizzle_3:
+            case ProgramOp::swizzle_4: {
+                int numSlots = (int)stage.op - (int)ProgramOp::swizzle_1 + 1;
+                auto ctx = SkRPCtxUtils::Unpack((SkRasterPipeline_SwizzleCtx*)stage.ctx);
+                ValueRange swizzled[4];
+                for (int index = 0; index < numSlots; ++index) {
+                    int src = slotIndex(ctx.dst + ctx.offsets[index], 1);
+                    if (src < 0) {
+                        return false;
+                    }
+                    swizzled[index] = ranges[src];
+                }
+                int dst = slotIndex(ctx.dst, numSlots);
+                if (dst < 0) {
+                    return false;
+                }
+                std::copy_n(swizzled, numSlots, &ranges[dst]);
+                break;
+            }
+            case ProgramOp::dot_2_floats:
+            case ProgramOp::dot_3_floats:
+            case ProgramOp::dot_4_floats: {
+                int numSlots = (int)stage.op - (int)ProgramOp::dot_2_floats + 2;
+                int dst = slotAt(stage.ctx, 2 * numSlots);
+                if (dst < 0) {
+                    return false;
+                }
+                ValueRange sum = ValueRange::Exactly(0);
+                for (int index = 0; index < numSlots; ++index) {
+                    sum = ValueRange::Add(sum, ValueRange::Mul(ranges[dst + index],
+                                                               ranges[dst + numSlots + index]));
+                }
+                ranges[dst] = sum;
+                break;
+            }
+
+#define BINARY_FLOAT_OP_CASES(name, fn)                                                           \
+            case ProgramOp::name##_float:                                                         \
+            case ProgramOp::name##_2_floats:                                                      \
+            case ProgramOp::name##_3_floats:                                                      \
+            case ProgramOp::name##_4_floats: {                                                    \
+                int numSlots = (int)stage.op - (int)ProgramOp::name##_float + 1;                  \
+                int dst = slotAt(stage.ctx, 2 * numSlots);                                        \
+                if (dst < 0) {                                                                    \
+                    return false;                                                                 \
+                }                                                                                 \
+                applyBinary(dst, numSlots, &ValueRange::fn);                                      \
+                break;                                                                            \
+            }                                                                                     \
+            case ProgramOp::name##_n_floats: {                                                    \
+                auto ctx = SkRPCtxUtils::Unpack((SkRasterPipeline_BinaryOpCtx*)stage.ctx);        \
+                int numSlots = (ctx.src - ctx.dst) / vectorWidth;                                 \
+                int dst = slotIndex(ctx.dst, 2 * numSlots);                                       \
+                if (ctx.src <= ctx.dst || dst < 0) {                                              \
+                    return false;                                                                 \
+                }                                                                                 \
+                applyBinary(dst, numSlots, &ValueRange::fn);                                      \
+                break;                                                                            \
+            }
+
+#define IMMEDIATE_FLOAT_OP_CASE(name, fn)                                                         \
+            case ProgramOp::name##_imm_float: {                                                   \
+                auto ctx = SkRPCtxUtils::Unpack((SkRasterPipeline_ConstantCtx*)stage.ctx);        \
+                int dst = slotIndex(ctx.dst, 1);                                                  \
+                if (dst < 0) {                                                                    \
+                    return false;                                                                 \
+                }                                                                                 \
+                ranges[dst] = ValueRange::fn(ranges[dst],                                         \
+                                             ValueRange::Exactly(sk_bit_cast<float>(ctx.value))); \
+                break;                                                                            \
+            }
+
+            BINARY_FLOAT_OP_CASES(add, Add)
+            BINARY_FLOAT_OP_CASES(sub, Sub)
+            BINARY_FLOAT_OP_CASES(mul, Mul)
+            BINARY_FLOAT_OP_CASES(div, Div)
+            BINARY_FLOAT_OP_CASES(min, Min)
+            BINARY_FLOAT_OP_CASES(max, Max)
+            IMMEDIATE_FLOAT_OP_CASE(add, Add)
+            IMMEDIATE_FLOAT_OP_CASE(mul, Mul)
+            IMMEDIATE_FLOAT_OP_CASE(min, Min)
+            IMMEDIATE_FLOAT_OP_CASE(max, Max)
+
+#undef BINARY_FLOAT_OP_CASES
+#undef IMMEDIATE_FLOAT_OP_CASE
+
+            case ProgramOp::mix_float:
+            case ProgramOp::mix_2_floats:
+            case ProgramOp::mix_3_floats:
+            case ProgramOp::mix_4_floats: {
+                int numSlots = (int)stage.op - (int)ProgramOp::mix_float + 1;
+                int dst = slotAt(stage.ctx, 3 * numSlots);
+                if (dst < 0) {
+                    return false;
+                }
+                applyMix(dst, numSlots);
+                break;
+            }
+            case ProgramOp::mix_n_floats: {
+                auto ctx = SkRPCtxUtils::Unpack((SkRasterPipeline_TernaryOpCtx*)stage.ctx);
+                int numSlots = ctx.delta / vectorWidth;
+                int dst = slotIndex(ctx.dst, 3 * numSlots);
+                if (numSlots <= 0 || dst < 0) {
+                    return false;
+                }
+                applyMix(dst, numSlots);
+                break;
+            }
+            default:
+                // Every other op is highp-only.
+                return false;
+        }
+    }
+    return resultFitsInLowp;
+}
+
+bool Program::canRunInLowp(SkSpan<const float> uniforms) const {
+    SkArenaAlloc alloc(/*firstHeapAllocation=*/1000);
+    TArray<Stage> stages;
+    SlotData slotData = this->allocateSlotData(&alloc);
+    this->makeStages(&stages, &alloc, uniforms, slotData);
+    return this->stagesCanRunInLowp(stages, slotData);
+}
+
 bool Program::appendStages(SkRasterPipeline* pipeline,
                            SkArenaAlloc* alloc,
                            RP::Callbacks* callbacks,
@@ -1661,6 +1986,24 @@ bool Program::appendStages(SkRasterPipeline* pipeline,
     SlotData slotData = this->allocateSlotData(alloc);
     this->makeStages(&stages, alloc, uniforms, slotData);
 
+    // If the program can run in lowp, it needs a copy of its slots for each highp-sized part of the
+    // lowp stride. Lay out the stages again over slot data with room for every copy, and give each
+    // copy the immutable values.
+    const bool lowp = this->stagesCanRunInLowp(stages, slotData);
+    const int numCopies = SkOpts::raster_pipeline_lowp_stride /
+                          SkOpts::raster_pipeline_highp_stride;
+    if (lowp && numCopies > 1) {
+        stages.clear();
+        slotData = this->allocateSlotData(alloc, numCopies);
+        this->makeStages(&stages, alloc, uniforms, slotData);
+
+        std::byte* immutable = reinterpret_cast<std::byte*>(slotData.immutable.data());
+        for (int copy = 1; copy < numCopies; ++copy) {
+            memcpy(immutable + copy * slotData.copyStride, immutable,
+                   slotData.immutable.size_bytes());
+        }
+    }
+
     // Allocate buffers for branch targets and labels; these are needed to convert labels into
     // actual offsets into the pipeline and fix up branches.
     TArray<SkRasterPipeline_BranchCtx*> branchContexts;
@@ -1673,7 +2016,9 @@ bool Program::appendStages(SkRasterPipeline* pipeline,
     auto resetBasePointer = [&]() {
         // Whenever we hand off control to another shader, we have to assume that it might overwrite
         // the base pointer (if it uses SkSL, it will!), so we reset it on return.
-        pipeline->append(SkRasterPipelineOp::set_base_pointer, slotData.values.data());
+        pipeline->append(lowp ? SkRasterPipelineOp::set_lowp_base_pointer
+                              : SkRasterPipelineOp::set_base_pointer,
+                         slotData.values.data());
     };
 
     resetBasePointer();
@@ -1723,6 +2068,21 @@ bool Program::appendStages(SkRasterPipeline* pipeline,
                 // resetBasePointer here.
                 break;
 
+            case ProgramOp::store_src:
+                pipeline->append(lowp ? SkRasterPipelineOp::store_src_slots
+                                      : SkRasterPipelineOp::store_src, stage.ctx);
+                break;
+
+            case ProgramOp::store_dst:
+                pipeline->append(lowp ? SkRasterPipelineOp::store_dst_slots
+                                      : SkRasterPipelineOp::store_dst, stage.ctx);
+                break;
+
+            case ProgramOp::load_src:
+                pipeline->append(lowp ? SkRasterPipelineOp::load_src_slots
+                                      : SkRasterPipelineOp::load_src, stage.ctx);
+                break;
+
             case ProgramOp::label: {
                 // Remember the absolute pipeline position of this label.
                 int labelID = sk_bit_cast<intptr_t>(stage.ctx);
@@ -168,6 +168,12 @@ public:
 
     int numUniforms() const { return fNumUniformSlots; }
 
+    // Returns true if the program can run in lowp with the passed-in uniforms. Every op it uses
+    // needs a lowp implementation, and its result must stay within [0, 1] for any input color in
+    // [0, 1], so that lowp doesn't need to clamp it. (Lowp stores colors in 8 bits, but the
+    // program's own math still runs in float.)
+    bool canRunInLowp(SkSpan<const float> uniforms) const;
+
 private:
     using StackDepths = skia_private::TArray<int>; // [stack index] = depth of stack
 
@@ -175,8 +181,12 @@ private:
         SkSpan<float> values;
         SkSpan<float> stack;
         SkSpan<float> immutable;
+        // Lowp programs keep an identical copy of the slot data for each highp-sized part of the
+        // lowp stride, `copyStride` bytes apart. (See SK_RASTER_PIPELINE_OPS_SKSL_LOWP.)
+        int numCopies = 1;
+        int copyStride = 0;
     };
-    SlotData allocateSlotData(SkArenaAlloc* alloc) const;
+    SlotData allocateSlotData(SkArenaAlloc* alloc, int numCopies = 1) const;
 
     struct Stage {
         ProgramOp op;
@@ -189,6 +199,10 @@ private:
     void optimize();
     StackDepths tempStackMaxDepths() const;
 
+    // Tracks the range of every slot through the stages to see if the program can run in lowp.
+    bool stagesCanRunInLowp(const skia_private::TArray<Stage>& stages,
+                            const SlotData& slots) const;
+
     // These methods are used to split up multi-slot copies into multiple ops as needed.
     void appendCopy(skia_private::TArray<Stage>* pipeline,
                     SkArenaAlloc* alloc,
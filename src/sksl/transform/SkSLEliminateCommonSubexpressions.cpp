@@ -0,0 +1,625 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkSpan.h"
+#include "include/core/SkTypes.h"
+#include "include/private/base/SkTArray.h"
+#include "src/sksl/SkSLAnalysis.h"
+#include "src/sksl/SkSLCompiler.h"
+#include "src/sksl/SkSLDefines.h"
+#include "src/sksl/SkSLMangler.h"
+#include "src/sksl/SkSLOperator.h"
+#include "src/sksl/SkSLProgramSettings.h"
+#include "src/sksl/analysis/SkSLProgramUsage.h"
+#include "src/sksl/analysis/SkSLProgramVisitor.h"
+#include "src/sksl/ir/SkSLBinaryExpression.h"
+#include "src/sksl/ir/SkSLBlock.h"
+#include "src/sksl/ir/SkSLChildCall.h"
+#include "src/sksl/ir/SkSLConstructor.h"
+#include "src/sksl/ir/SkSLExpression.h"
+#include "src/sksl/ir/SkSLExpressionStatement.h"
+#include "src/sksl/ir/SkSLFieldAccess.h"
+#include "src/sksl/ir/SkSLFunctionCall.h"
+#include "src/sksl/ir/SkSLFunctionDeclaration.h"
+#include "src/sksl/ir/SkSLFunctionDefinition.h"
+#include "src/sksl/ir/SkSLIRNode.h"
+#include "src/sksl/ir/SkSLIfStatement.h"
+#include "src/sksl/ir/SkSLIndexExpression.h"
+#include "src/sksl/ir/SkSLLiteral.h"
+#include "src/sksl/ir/SkSLPrefixExpression.h"
+#include "src/sksl/ir/SkSLProgram.h"
+#include "src/sksl/ir/SkSLProgramElement.h"
+#include "src/sksl/ir/SkSLReturnStatement.h"
+#include "src/sksl/ir/SkSLStatement.h"
+#include "src/sksl/ir/SkSLSwitchStatement.h"
+#include "src/sksl/ir/SkSLSwizzle.h"
+#include "src/sksl/ir/SkSLTernaryExpression.h"
+#include "src/sksl/ir/SkSLType.h"
+#include "src/sksl/ir/SkSLVarDeclarations.h"
+#include "src/sksl/ir/SkSLVariable.h"
+#include "src/sksl/ir/SkSLVariableReference.h"
+#include "src/sksl/transform/SkSLProgramWriter.h"
+#include "src/sksl/transform/SkSLTransform.h"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+using namespace skia_private;
+
+namespace SkSL {
+
+class Context;
+
+namespace {
+
+// Limits the number of expressions that a block keeps track of. This keeps the cost of the search
+// linear in the size of the block, even when a block is very long (e.g. an unrolled loop).
+static constexpr int kMaxAvailableExpressions = 256;
+
+// Returns true if both expressions always compute the same value. Unlike IsSameExpressionTree, this
+// also compares operators and calls, since arithmetic is what we're hoping to reuse.
+static bool is_same_value(const Expression& left, const Expression& right) {
+    if (left.kind() != right.kind() || !left.type().matches(right.type())) {
+        return false;
+    }
+
+    auto sameArguments = [](SkSpan<const std::unique_ptr<Expression>> leftArgs,
+                            SkSpan<const std::unique_ptr<Expression>> rightArgs) {
+        if (leftArgs.size() != rightArgs.size()) {
+            return false;
+        }
+        for (size_t index = 0; index < leftArgs.size(); ++index) {
+            if (!is_same_value(*leftArgs[index], *rightArgs[index])) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    switch (left.kind()) {
+        case Expression::Kind::kBinary: {
+            const BinaryExpression& leftBinary = left.as<BinaryExpression>();
+            const BinaryExpression& rightBinary = right.as<BinaryExpression>();
+            return leftBinary.getOperator().kind() == rightBinary.getOperator().kind() &&
+                   is_same_value(*leftBinary.left(), *rightBinary.left()) &&
+                   is_same_value(*leftBinary.right(), *rightBinary.right());
+        }
+        case Expression::Kind::kChildCall:
+            return &left.as<ChildCall>().child() == &right.as<ChildCall>().child() &&
+                   sameArguments(left.as<ChildCall>().arguments(),
+                                 right.as<ChildCall>().arguments());
+
+        case Expression::Kind::kConstructorArray:
+        case Expression::Kind::kConstructorArrayCast:
+        case Expression::Kind::kConstructorCompound:
+        case Expression::Kind::kConstructorCompoundCast:
+        case Expression::Kind::kConstructorDiagonalMatrix:
+        case Expression::Kind::kConstructorMatrixResize:
+        case Expression::Kind::kConstructorScalarCast:
+        case Expression::Kind::kConstructorStruct:
+        case Expression::Kind::kConstructorSplat:
+            return sameArguments(left.asAnyConstructor().argumentSpan(),
+                                 right.asAnyConstructor().argumentSpan());
+
+        case Expression::Kind::kFieldAccess:
+            return left.as<FieldAccess>().fieldIndex() == right.as<FieldAccess>().fieldIndex() &&
+                   is_same_value(*left.as<FieldAccess>().base(), *right.as<FieldAccess>().base());
+
+        case Expression::Kind::kFunctionCall:
+            return &left.as<FunctionCall>().function() == &right.as<FunctionCall>().function() &&
+                   sameArguments(left.as<FunctionCall>().arguments(),
+                                 right.as<FunctionCall>().arguments());
+
+        case Expression::Kind::kIndex:
+            return is_same_value(*left.as<IndexExpression>().index(),
+                                 *right.as<IndexExpression>().index()) &&
+                   is_same_value(*left.as<IndexExpression>().base(),
+                                 *right.as<IndexExpression>().base());
+
+        case Expression::Kind::kLiteral:
+            return left.as<Literal>().value() == right.as<Literal>().value();
+
+        case Expression::Kind::kPrefix:
+            return left.as<PrefixExpression>().getOperator().kind() ==
+                           right.as<PrefixExpression>().getOperator().kind() &&
+                   is_same_value(*left.as<PrefixExpression>().operand(),
+                                 *right.as<PrefixExpression>().operand());
+
+        case Expression::Kind::kSwizzle:
+            return left.as<Swizzle>().components() == right.as<Swizzle>().components() &&
+                   is_same_value(*left.as<Swizzle>().base(), *right.as<Swizzle>().base());
+
+        case Expression::Kind::kTernary:
+            return is_same_value(*left.as<TernaryExpression>().test(),
+                                 *right.as<TernaryExpression>().test()) &&
+                   is_same_value(*left.as<TernaryExpression>().ifTrue(),
+                                 *right.as<TernaryExpression>().ifTrue()) &&
+                   is_same_value(*left.as<TernaryExpression>().ifFalse(),
+                                 *right.as<TernaryExpression>().ifFalse());
+
+        case Expression::Kind::kVariableReference:
+            return left.as<VariableReference>().variable() ==
+                   right.as<VariableReference>().variable();
+
+        default:
+            return false;
+    }
+}
+
+// Returns true if the expression is worth keeping in a variable, and is safe to evaluate earlier.
+static bool is_reusable(const Expression& expr) {
+    const Type& type = expr.type();
+    if (type.isLiteral() || !(type.isScalar() || type.isVector() || type.isMatrix())) {
+        return false;
+    }
+    // Trivial expressions cost no more than reading a variable, and constant expressions are left
+    // to the constant folder.
+    return !Analysis::IsTrivialExpression(expr) &&
+           !Analysis::IsCompileTimeConstant(expr) &&
+           !Analysis::HasSideEffects(expr);
+}
+
+static void collect_referenced_variables(const Expression& expr,
+                                         TArray<const Variable*>* variables) {
+    class VariableCollector : public ProgramVisitor {
+    public:
+        VariableCollector(TArray<const Variable*>* variables) : fVariables(variables) {}
+
+        bool visitExpression(const Expression& expr) override {
+            if (expr.is<VariableReference>()) {
+                const Variable* var = expr.as<VariableReference>().variable();
+                if (std::find(fVariables->begin(), fVariables->end(), var) == fVariables->end()) {
+                    fVariables->push_back(var);
+                }
+            }
+            return INHERITED::visitExpression(expr);
+        }
+
+        TArray<const Variable*>* fVariables;
+
+        using INHERITED = ProgramVisitor;
+    };
+
+    VariableCollector{variables}.visitExpression(expr);
+}
+
+static bool references_any(SkSpan<const Variable* const> referenced,
+                           SkSpan<const Variable* const> variables) {
+    for (const Variable* var : referenced) {
+        if (std::find(variables.begin(), variables.end(), var) != variables.end()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Describes the variables that are written by a statement.
+struct StatementWrites {
+    // Every variable that the statement writes to.
+    TArray<const Variable*> fAll;
+    // The variables which might be written before all of the statement's expressions are
+    // evaluated. The target of an assignment like `x = ...` or `x += ...` is written last.
+    TArray<const Variable*> fInterior;
+    // Calls to functions with side effects may write to any global variable.
+    bool fCallsImpureFunction = false;
+};
+
+static StatementWrites get_writes(const Statement& stmt) {
+    class WriteCollector : public ProgramVisitor {
+    public:
+        using ProgramVisitor::visitStatement;
+
+        WriteCollector(const Statement& stmt) {
+            if (stmt.is<ExpressionStatement>()) {
+                Expression& expr = *stmt.as<ExpressionStatement>().expression();
+                if (expr.is<BinaryExpression>()) {
+                    fAssignedVar = expr.as<BinaryExpression>().isAssignmentIntoVariable();
+                }
+            }
+        }
+
+        bool visitExpression(const Expression& expr) override {
+            if (expr.is<VariableReference>()) {
+                const VariableReference& ref = expr.as<VariableReference>();
+                if (ref.refKind() != VariableRefKind::kRead) {
+                    fWrites.fAll.push_back(ref.variable());
+                    if (&ref != fAssignedVar) {
+                        fWrites.fInterior.push_back(ref.variable());
+                    }
+                }
+            } else if (expr.is<FunctionCall>()) {
+                if (!expr.as<FunctionCall>().function().modifierFlags().isPure()) {
+                    fWrites.fCallsImpureFunction = true;
+                }
+            }
+            return INHERITED::visitExpression(expr);
+        }
+
+        const VariableReference* fAssignedVar = nullptr;
+        StatementWrites fWrites;
+
+        using INHERITED = ProgramVisitor;
+    };
+
+    WriteCollector collector{stmt};
+    collector.visitStatement(stmt);
+    return std::move(collector.fWrites);
+}
+
+// Returns the expression which a statement evaluates before anything else, if it has one.
+static std::unique_ptr<Expression>* leading_expression(Statement& stmt) {
+    switch (stmt.kind()) {
+        case Statement::Kind::kExpression:
+            return &stmt.as<ExpressionStatement>().expression();
+        case Statement::Kind::kIf:
+            return &stmt.as<IfStatement>().test();
+        case Statement::Kind::kReturn:
+            return &stmt.as<ReturnStatement>().expression();
+        case Statement::Kind::kSwitch:
+            return &stmt.as<SwitchStatement>().value();
+        case Statement::Kind::kVarDeclaration:
+            return &stmt.as<VarDeclaration>().value();
+        default:
+            return nullptr;
+    }
+}
+
+// A statement in a block, along with the symbol table that holds the variables it declares.
+struct BlockStatement {
+    std::unique_ptr<Statement>* fStatement;
+    SymbolTable* fSymbols;
+};
+
+// Gathers the statements of a block, including the statements of any unscoped blocks inside of it;
+// these run in sequence with the rest of the block, and often hold code from the inliner.
+static void gather_statements(Block& block,
+                              SymbolTable* symbols,
+                              TArray<BlockStatement>* result) {
+    if (block.symbolTable()) {
+        symbols = block.symbolTable();
+    }
+    for (std::unique_ptr<Statement>& stmt : block.children()) {
+        if (stmt->is<Block>() && !stmt->as<Block>().isScope()) {
+            gather_statements(stmt->as<Block>(), symbols, result);
+        } else {
+            result->push_back(BlockStatement{&stmt, symbols});
+        }
+    }
+}
+
+class CommonSubexpressionEliminator : public ProgramWriter {
+public:
+    CommonSubexpressionEliminator(const Context& context, ProgramUsage* usage)
+            : fContext(context)
+            , fUsage(usage) {}
+
+    using ProgramWriter::visitProgramElement;
+
+    bool visitExpressionPtr(std::unique_ptr<Expression>& expr) override {
+        // Blocks can't appear inside of an expression.
+        return false;
+    }
+
+    bool visitStatementPtr(std::unique_ptr<Statement>& stmt) override {
+        if (stmt->is<Block>()) {
+            // The unscoped blocks inside of this block are processed along with it, and the scoped
+            // blocks are processed on their own.
+            TArray<BlockStatement> statements;
+            gather_statements(stmt->as<Block>(), /*symbols=*/nullptr, &statements);
+            std::vector<StatementArray> hoistedDecls = this->eliminateWithinBlock(statements);
+            for (BlockStatement& blockStmt : statements) {
+                this->visitStatementPtr(*blockStmt.fStatement);
+            }
+            // Declare the new variables just ahead of the statements which compute their values.
+            for (size_t index = 0; index < hoistedDecls.size(); ++index) {
+                StatementArray& decls = hoistedDecls[index];
+                if (!decls.empty()) {
+                    std::unique_ptr<Statement>& blockStmt = *statements[index].fStatement;
+                    Position pos = blockStmt->fPosition;
+                    decls.push_back(std::move(blockStmt));
+                    blockStmt = Block::Make(pos, std::move(decls), Block::Kind::kUnbracedBlock);
+                }
+            }
+            return false;
+        }
+        return INHERITED::visitStatementPtr(stmt);
+    }
+
+    bool fMadeChanges = false;
+
+private:
+    // An expression computed by an earlier statement in the block, whose value is still current.
+    struct Candidate {
+        const Expression* fValue;
+        // Where the expression is stored. This is the slot to replace when it's moved into a
+        // variable. (The expression itself doesn't move, so `fValue` remains valid.)
+        std::unique_ptr<Expression>* fSlot;
+        // The variable holding the expression's value, once it has one.
+        const Variable* fVariable;
+        // Every variable that the value depends on.
+        TArray<const Variable*> fReads;
+        // The statement which computes the expression, and the range of expression nodes that it
+        // spans within that statement. Ranges which nest contain one another.
+        int fStatement;
+        int fFirstNode;
+        int fEndNode;
+        bool fAvailable;
+    };
+
+    static bool Overlaps(const Candidate& a, const Candidate& b) {
+        return a.fStatement == b.fStatement &&
+               ((a.fFirstNode <= b.fFirstNode && b.fEndNode <= a.fEndNode) ||
+                (b.fFirstNode <= a.fFirstNode && a.fEndNode <= b.fEndNode));
+    }
+
+    // Searches a block for repeated values, and returns the declarations that need to be added
+    // ahead of each statement.
+    std::vector<StatementArray> eliminateWithinBlock(SkSpan<BlockStatement> statements) {
+        std::vector<StatementArray> hoistedDecls(statements.size());
+        if (statements.size() < 2) {
+            return hoistedDecls;
+        }
+
+        fStatements = statements;
+        fCandidates.clear();
+        fHoistedDecls = &hoistedDecls;
+
+        for (int index = 0; index < (int)statements.size(); ++index) {
+            Statement& stmt = **statements[index].fStatement;
+            StatementWrites writes = get_writes(stmt);
+            if (writes.fCallsImpureFunction) {
+                // We can't tell which values this statement might change.
+                fCandidates.clear();
+                continue;
+            }
+            if (std::unique_ptr<Expression>* expr = leading_expression(stmt); expr && *expr) {
+                this->reuseValues(*expr, writes.fInterior);
+                this->trimCandidates();
+                const Variable* declaredVar = stmt.is<VarDeclaration>()
+                                                      ? stmt.as<VarDeclaration>().var()
+                                                      : nullptr;
+                this->addCandidates(index, *expr, writes.fAll, declaredVar);
+            }
+            // Anything which depends on a variable that was just written no longer holds.
+            if (!writes.fAll.empty()) {
+                for (Candidate& candidate : fCandidates) {
+                    if (references_any(candidate.fReads, writes.fAll)) {
+                        candidate.fAvailable = false;
+                    }
+                }
+            }
+        }
+
+        fStatements = {};
+        fCandidates.clear();
+        fHoistedDecls = nullptr;
+        return hoistedDecls;
+    }
+
+    // Replaces expressions with the variable holding their value, if an earlier statement already
+    // computed them. Expressions which read a variable that the statement writes early on are left
+    // alone, since they might not compute the same value.
+    void reuseValues(std::unique_ptr<Expression>& expr, SkSpan<const Variable* const> writes) {
+        class ValueReuser : public ProgramWriter {
+        public:
+            ValueReuser(CommonSubexpressionEliminator* eliminator,
+                        SkSpan<const Variable* const> writes)
+                    : fEliminator(eliminator)
+                    , fWrites(writes) {}
+
+            bool visitExpressionPtr(std::unique_ptr<Expression>& expr) override {
+                if (is_reusable(*expr)) {
+                    TArray<const Variable*> reads;
+                    collect_referenced_variables(*expr, &reads);
+                    if (!references_any(reads, fWrites)) {
+                        if (Candidate* candidate = fEliminator->findCandidate(*expr)) {
+                            if (const Variable* var = fEliminator->variableFor(candidate)) {
+                                fEliminator->replaceWithVariable(expr, var);
+                                return false;
+                            }
+                        }
+                    }
+                }
+                return INHERITED::visitExpressionPtr(expr);
+            }
+
+            bool visitStatementPtr(std::unique_ptr<Statement>& stmt) override { return false; }
+
+            CommonSubexpressionEliminator* fEliminator;
+            SkSpan<const Variable* const> fWrites;
+
+            using INHERITED = ProgramWriter;
+        };
+
+        ValueReuser{this, writes}.visitExpressionPtr(expr);
+    }
+
+    // Makes the reusable expressions in a statement available to the statements after it. Only
+    // expressions which are evaluated unconditionally are included.
+    void addCandidates(int statementIndex,
+                       std::unique_ptr<Expression>& expr,
+                       SkSpan<const Variable* const> writes,
+                       const Variable* declaredVar) {
+        class CandidateFinder : public ProgramWriter {
+        public:
+            CandidateFinder(CommonSubexpressionEliminator* eliminator,
+                            int statementIndex,
+                            SkSpan<const Variable* const> writes,
+                            const Variable* declaredVar)
+                    : fEliminator(eliminator)
+                    , fStatementIndex(statementIndex)
+                    , fWrites(writes)
+                    , fDeclaredVar(declaredVar) {}
+
+            bool visitExpressionPtr(std::unique_ptr<Expression>& expr) override {
+                // A variable declaration's initial value is already held in its variable.
+                const Variable* holdingVar = fDeclaredVar;
+                fDeclaredVar = nullptr;
+
+                TArray<Candidate>& candidates = fEliminator->fCandidates;
+                int candidateIndex = -1;
+                int firstNode = fNextNode++;
+                if (is_reusable(*expr)) {
+                    TArray<const Variable*> reads;
+                    collect_referenced_variables(*expr, &reads);
+                    if (!references_any(reads, fWrites)) {
+                        if (holdingVar) {
+                            reads.push_back(holdingVar);
+                        }
+                        candidateIndex = candidates.size();
+                        candidates.push_back(Candidate{expr.get(), &expr, holdingVar,
+                                                       std::move(reads), fStatementIndex,
+                                                       firstNode, /*fEndNode=*/-1,
+                                                       /*fAvailable=*/true});
+                    }
+                }
+
+                // Only the parts of an expression that always run are worth moving earlier.
+                switch (expr->kind()) {
+                    case Expression::Kind::kBinary: {
+                        BinaryExpression& binary = expr->as<BinaryExpression>();
+                        this->visitExpressionPtr(binary.left());
+                        if (binary.getOperator().kind() != Operator::Kind::LOGICALAND &&
+                            binary.getOperator().kind() != Operator::Kind::LOGICALOR) {
+                            this->visitExpressionPtr(binary.right());
+                        }
+                        break;
+                    }
+                    case Expression::Kind::kTernary:
+                        this->visitExpressionPtr(expr->as<TernaryExpression>().test());
+                        break;
+
+                    default:
+                        INHERITED::visitExpressionPtr(expr);
+                        break;
+                }
+
+                if (candidateIndex >= 0) {
+                    candidates[candidateIndex].fEndNode = fNextNode;
+                }
+                return false;
+            }
+
+            bool visitStatementPtr(std::unique_ptr<Statement>& stmt) override { return false; }
+
+            CommonSubexpressionEliminator* fEliminator;
+            int fStatementIndex;
+            SkSpan<const Variable* const> fWrites;
+            const Variable* fDeclaredVar;
+            int fNextNode = 0;
+
+            using INHERITED = ProgramWriter;
+        };
+
+        CandidateFinder{this, statementIndex, writes, declaredVar}.visitExpressionPtr(expr);
+    }
+
+    // Discards old candidates once there are too many of them. This happens between statements,
+    // since the candidates of the statement being searched need to stay put.
+    void trimCandidates() {
+        if (fCandidates.size() < kMaxAvailableExpressions) {
+            return;
+        }
+        // Discard the candidates that are no longer available, and if that isn't enough, forget
+        // the oldest half. Dropping a candidate only gives up on reusing it.
+        TArray<Candidate> remaining;
+        for (Candidate& candidate : fCandidates) {
+            if (candidate.fAvailable) {
+                remaining.push_back(std::move(candidate));
+            }
+        }
+        if (remaining.size() >= kMaxAvailableExpressions) {
+            TArray<Candidate> newest;
+            for (int index = remaining.size() / 2; index < remaining.size(); ++index) {
+                newest.push_back(std::move(remaining[index]));
+            }
+            remaining = std::move(newest);
+        }
+        fCandidates = std::move(remaining);
+    }
+
+    Candidate* findCandidate(const Expression& expr) {
+        for (Candidate& candidate : fCandidates) {
+            if (candidate.fAvailable && is_same_value(*candidate.fValue, expr)) {
+                return &candidate;
+            }
+        }
+        return nullptr;
+    }
+
+    // Returns the variable holding the candidate's value. If it doesn't have one yet, the value is
+    // moved into a new variable, declared just ahead of the statement which computes it. Returns
+    // null if there's no symbol table to hold the variable.
+    const Variable* variableFor(Candidate* candidate) {
+        SymbolTable* symbols = fStatements[candidate->fStatement].fSymbols;
+        if (!candidate->fVariable && symbols) {
+            std::unique_ptr<Expression>& slot = *candidate->fSlot;
+            Position pos = slot->fPosition;
+            const Type* type = &slot->type();
+            fUsage->remove(slot.get());
+            Variable::ScratchVariable scratch = Variable::MakeScratchVariable(fContext,
+                                                                              fMangler,
+                                                                              "cse",
+                                                                              type,
+                                                                              symbols,
+                                                                              std::move(slot));
+            fUsage->add(scratch.fVarDecl.get());
+            (*fHoistedDecls)[candidate->fStatement].push_back(std::move(scratch.fVarDecl));
+
+            slot = VariableReference::Make(pos, scratch.fVarSymbol);
+            fUsage->add(slot.get());
+            candidate->fVariable = scratch.fVarSymbol;
+            fMadeChanges = true;
+
+            // The candidates which contain this value, or are contained by it, have been split
+            // apart and can't be reused.
+            for (Candidate& other : fCandidates) {
+                if (&other != candidate && Overlaps(other, *candidate)) {
+                    other.fAvailable = false;
+                }
+            }
+        }
+        return candidate->fVariable;
+    }
+
+    void replaceWithVariable(std::unique_ptr<Expression>& expr, const Variable* var) {
+        Position pos = expr->fPosition;
+        fUsage->remove(expr.get());
+        expr = VariableReference::Make(pos, var);
+        fUsage->add(expr.get());
+        fMadeChanges = true;
+    }
+
+    const Context& fContext;
+    ProgramUsage* fUsage;
+    Mangler fMangler;
+    SkSpan<BlockStatement> fStatements;
+    TArray<Candidate> fCandidates;
+    std::vector<StatementArray>* fHoistedDecls = nullptr;
+
+    using INHERITED = ProgramWriter;
+};
+
+}  // namespace
+
+bool Transform::EliminateCommonSubexpressions(Program& program) {
+    if (!program.fConfig->fSettings.fEliminateCommonSubexpressions) {
+        return false;
+    }
+
+    CommonSubexpressionEliminator visitor{*program.fContext, program.fUsage.get()};
+    for (std::unique_ptr<ProgramElement>& pe : program.fOwnedElements) {
+        if (pe->is<FunctionDefinition>()) {
+            visitor.visitProgramElement(*pe);
+        }
+    }
+    return visitor.fMadeChanges;
+}
+
+}  // namespace SkSL
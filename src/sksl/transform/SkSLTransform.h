@@ -104,6 +104,13 @@ bool EliminateDeadGlobalVariables(const Context& context,
                                   bool onlyPrivateGlobals);
 bool EliminateDeadGlobalVariables(Program& program);
 
+/**
+ * Replaces expressions which an earlier statement in the same block already computed with a
+ * variable holding their value. Only expressions without side effects are reused, and only while
+ * the variables they read are unchanged. Returns true if any changes were made.
+ */
+bool EliminateCommonSubexpressions(Program& program);
+
 /** Renames private functions and function-local variables to minimize code size. */
 void RenamePrivateSymbols(Context& context, Module& module, ProgramUsage* usage, ProgramKind kind);
 
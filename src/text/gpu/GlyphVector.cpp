@@ -70,13 +70,14 @@ std::optional<GlyphVector> GlyphVector::MakeFromBuffer(SkReadBuffer& buffer,
 
     // Check for enough bytes to populate the packedGlyphID array. If not enough something has
     // gone wrong.
-    if (!buffer.validate(glyphCount * sizeof(uint32_t) <= buffer.available())) {
+    const uint32_t* packedGlyphIDs = buffer.skipT<uint32_t>(glyphCount);
+    if (!buffer.isValid()) {
         return std::nullopt;
     }
 
     Variant* variants = alloc->makePODArray<Variant>(glyphCount);
     for (int i = 0; i < glyphCount; i++) {
-        variants[i].packedGlyphID = SkPackedGlyphID(buffer.readUInt());
+        variants[i].packedGlyphID = SkPackedGlyphID(packedGlyphIDs[i]);
     }
     return GlyphVector{std::move(promise.value()), SkSpan(variants, glyphCount)};
 }
@@ -99,7 +99,7 @@ public:
         return glyph->drawable() != nullptr;
     }
 
-    void writePendingGlyphs(SkWriteBuffer& buffer);
+    void writePendingGlyphs(SkWriteBuffer& buffer, bool runLengthEncodeImages);
 
     SkDiscardableHandleId discardableHandleId() const { return fDiscardableHandleId; }
 
@@ -165,7 +165,7 @@ RemoteStrike::RemoteStrike(
     SkASSERT(fContext != nullptr);
 }
 
-void RemoteStrike::writePendingGlyphs(SkWriteBuffer& buffer) {
+void RemoteStrike::writePendingGlyphs(SkWriteBuffer& buffer, bool runLengthEncodeImages) {
     SkASSERT(this->hasPendingGlyphs());
 
     buffer.writeUInt(fContext->getTypeface()->uniqueID());
@@ -197,7 +197,9 @@ void RemoteStrike::writePendingGlyphs(SkWriteBuffer& buffer) {
     }
 
     // Send all the pending glyph information.
-    SkStrike::FlattenGlyphsByType(buffer, fMasksToSend, fPathsToSend, fDrawablesToSend);
+    buffer.writeBool(runLengthEncodeImages);
+    SkStrike::FlattenGlyphsByType(
+            buffer, fMasksToSend, fPathsToSend, fDrawablesToSend, runLengthEncodeImages);
 
     // Reset all the sending data.
     fMasksToSend.clear();
@@ -269,6 +271,7 @@ public:
 
     // SkStrikeServer API methods
     void writeStrikeData(std::vector<uint8_t>* memory);
+    void setRunLengthEncodeImages(bool runLengthEncode) { fRunLengthEncodeImages = runLengthEncode; }
 
     sk_sp<sktext::StrikeForGPU> findOrCreateScopedStrike(const SkStrikeSpec& strikeSpec) override;
 
@@ -299,6 +302,7 @@ private:
     SkStrikeServer::DiscardableHandleManager* const fDiscardableHandleManager;
     THashSet<SkTypefaceID> fCachedTypefaces;
     size_t fMaxEntriesInDescriptorMap = kMaxEntriesInDescriptorMap;
+    bool fRunLengthEncodeImages = false;
 
     // State cached until the next serialization.
     THashSet<RemoteStrike*> fRemoteStrikesToSend;
@@ -351,7 +355,7 @@ void SkStrikeServerImpl::writeStrikeData(std::vector<uint8_t>* memory) {
     fRemoteStrikesToSend.foreach(
             [&](RemoteStrike* strike) {
                 if (strike->hasPendingGlyphs()) {
-                    strike->writePendingGlyphs(buffer);
+                    strike->writePendingGlyphs(buffer, fRunLengthEncodeImages);
                     strike->resetScalerContext();
                 }
             }
@@ -556,6 +560,10 @@ void SkStrikeServer::writeStrikeData(std::vector<uint8_t>* memory) {
     fImpl->writeStrikeData(memory);
 }
 
+void SkStrikeServer::setRunLengthEncodeImages(bool runLengthEncode) {
+    fImpl->setRunLengthEncodeImages(runLengthEncode);
+}
+
 SkStrikeServerImpl* SkStrikeServer::impl() { return fImpl.get(); }
 
 void SkStrikeServer::setMaxEntriesInDescriptorMapForTesting(size_t count) {
@@ -739,7 +747,8 @@ bool SkStrikeClientImpl::readStrikeData(const volatile void* memory, size_t memo
         // Make sure this strike is pinned on the GPU side.
         strike->verifyPinnedStrike();
 
-        if (!strike->mergeFromBuffer(buffer)) {
+        const bool runLengthEncodedImages = buffer.readBool();
+        if (!strike->mergeFromBuffer(buffer, runLengthEncodedImages)) {
             postError(__LINE__);
             return false;
         }
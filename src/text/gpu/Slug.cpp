@@ -8,12 +8,14 @@
 #include "include/private/chromium/Slug.h"
 
 #include "include/core/SkCanvas.h"
+#include "include/core/SkData.h"
 #include "include/core/SkPoint.h"
 #include "include/core/SkSerialProcs.h"
 #include "src/core/SkReadBuffer.h"
 #include "src/core/SkWriteBuffer.h"
+#include "src/text/gpu/SlugImpl.h"
 
-class SkData;
+#include <utility>
 
 namespace sktext::gpu {
 
@@ -47,6 +49,14 @@ sk_sp<Slug> Slug::Deserialize(const void* data, size_t size, const SkStrikeClien
     return MakeFromBuffer(buffer);
 }
 
+sk_sp<Slug> Slug::Deserialize(sk_sp<SkData> data, const SkStrikeClient* client) {
+    if (data == nullptr) {
+        return nullptr;
+    }
+    SkReadBuffer buffer{data->data(), data->size()};
+    return SlugImpl::MakeFromBuffer(buffer, client, std::move(data));
+}
+
 void Slug::draw(SkCanvas* canvas, const SkPaint& paint) const {
     canvas->drawSlug(this, paint);
 }
@@ -7,6 +7,7 @@
 
 #include "src/text/gpu/SlugImpl.h"
 
+#include "include/core/SkData.h"
 #include "include/core/SkMatrix.h"
 #include "include/core/SkPoint.h"
 #include "include/core/SkRect.h"
@@ -43,7 +44,9 @@ void SlugImpl::doFlatten(SkWriteBuffer& buffer) const {
     fSubRuns->flattenRuns(buffer);
 }
 
-sk_sp<Slug> SlugImpl::MakeFromBuffer(SkReadBuffer& buffer, const SkStrikeClient* client) {
+sk_sp<Slug> SlugImpl::MakeFromBuffer(SkReadBuffer& buffer,
+                                     const SkStrikeClient* client,
+                                     sk_sp<SkData> borrowedData) {
     SkRect sourceBounds = buffer.readRect();
     if (!buffer.validate(!sourceBounds.isEmpty())) {
         return nullptr;
@@ -53,6 +56,7 @@ sk_sp<Slug> SlugImpl::MakeFromBuffer(SkReadBuffer& buffer, const SkStrikeClient*
 
     auto [initializer, _, alloc] =
             SubRunAllocator::AllocateClassMemoryAndArena<SlugImpl>(allocSizeHint);
+    alloc.setBorrowedData(std::move(borrowedData));
 
     gpu::SubRunContainerOwner container =
             gpu::SubRunContainer::MakeFromBufferInAlloc(buffer, client, &alloc);
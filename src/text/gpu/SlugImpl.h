@@ -17,6 +17,7 @@
 
 #include <cstddef>
 
+class SkData;
 class SkMatrix;
 class SkPaint;
 class SkReadBuffer;
@@ -44,8 +45,11 @@ public:
                                 const SkPaint& paint,
                                 SkStrikeDeviceInfo strikeDeviceInfo,
                                 sktext::StrikeForGPUCacheInterface* strikeCache);
+    // If borrowedData is set, it must hold the bytes buffer reads, and the Slug refers to them
+    // instead of copying them where it can.
     static sk_sp<Slug> MakeFromBuffer(SkReadBuffer& buffer,
-                                      const SkStrikeClient* client);
+                                      const SkStrikeClient* client,
+                                      sk_sp<SkData> borrowedData = nullptr);
     void doFlatten(SkWriteBuffer& buffer) const override;
 
     SkRect sourceBounds() const override { return fSourceBounds; }
@@ -8,6 +8,8 @@
 #ifndef sktext_gpu_SubRunAllocator_DEFINED
 #define sktext_gpu_SubRunAllocator_DEFINED
 
+#include "include/core/SkData.h"
+#include "include/core/SkRefCnt.h"
 #include "include/core/SkSpan.h"
 #include "include/private/base/SkAssert.h"
 #include "include/private/base/SkMath.h"
@@ -320,8 +322,29 @@ public:
 
     void* alignedBytes(int size, int alignment);
 
+    // Keeps data alive for as long as the allocator, so that borrowPODSpan can return spans into
+    // it instead of copies.
+    void setBorrowedData(sk_sp<SkData> data) { fBorrowedData = std::move(data); }
+
+    // Returns s itself if it lies in the borrowed data, and a copy of it otherwise.
+    template<typename T>
+    SkSpan<const T> borrowPODSpan(SkSpan<const T> s) {
+        static_assert(HasNoDestructor<T>, "This is not POD. Use makeUniqueArray.");
+        if (fBorrowedData != nullptr) {
+            const char* begin = static_cast<const char*>(fBorrowedData->data());
+            const char* end = begin + fBorrowedData->size();
+            const char* data = reinterpret_cast<const char*>(s.data());
+            if (begin <= data && data <= end && s.size_bytes() <= SkToSizeT(end - data) &&
+                reinterpret_cast<uintptr_t>(data) % alignof(T) == 0) {
+                return s;
+            }
+        }
+        return this->makePODSpan(s);
+    }
+
 private:
     BagOfBytes fAlloc;
+    sk_sp<SkData> fBorrowedData;
 };
 
 // Helper for defining allocators with inline/reserved storage.
@@ -175,7 +175,7 @@ public:
     }
     PathOpSubmitter(bool isAntiAliased,
                     SkScalar strikeToSourceScale,
-                    SkSpan<SkPoint> positions,
+                    SkSpan<const SkPoint> positions,
                     SkSpan<IDOrPath> idsOrPaths,
                     SkStrikePromise&& strikePromise);
 
@@ -241,19 +241,18 @@ std::optional<PathOpSubmitter> PathOpSubmitter::MakeFromBuffer(SkReadBuffer& buf
     SkScalar strikeToSourceScale = buffer.readScalar();
     if (!buffer.validate(0 < strikeToSourceScale)) { return std::nullopt; }
 
-    SkSpan<SkPoint> positions = MakePointsFromBuffer(buffer, alloc);
+    SkSpan<const SkPoint> positions = MakePointsFromBuffer(buffer, alloc);
     if (positions.empty()) { return std::nullopt; }
     const int glyphCount = SkCount(positions);
 
     // Remember, we stored an int for glyph id.
-    if (!buffer.validateCanReadN<int>(glyphCount)) { return std::nullopt; }
+    const int32_t* glyphIDs = buffer.skipT<int32_t>(glyphCount);
+    if (!buffer.isValid()) { return std::nullopt; }
     auto idsOrPaths = SkSpan(alloc->makeUniqueArray<IDOrPath>(glyphCount).release(), glyphCount);
-    for (auto& idOrPath : idsOrPaths) {
-        idOrPath.fGlyphID = SkTo<SkGlyphID>(buffer.readInt());
+    for (int i = 0; i < glyphCount; ++i) {
+        idsOrPaths[i].fGlyphID = SkTo<SkGlyphID>(glyphIDs[i]);
     }
 
-    if (!buffer.isValid()) { return std::nullopt; }
-
     return PathOpSubmitter{isAntiAlias,
                            strikeToSourceScale,
                            positions,
@@ -264,7 +263,7 @@ std::optional<PathOpSubmitter> PathOpSubmitter::MakeFromBuffer(SkReadBuffer& buf
 PathOpSubmitter::PathOpSubmitter(
         bool isAntiAliased,
         SkScalar strikeToSourceScale,
-        SkSpan<SkPoint> positions,
+        SkSpan<const SkPoint> positions,
         SkSpan<IDOrPath> idsOrPaths,
         SkStrikePromise&& strikePromise)
         : fIDsOrPaths{idsOrPaths}
@@ -440,7 +439,7 @@ public:
         return *this;
     }
     DrawableOpSubmitter(SkScalar strikeToSourceScale,
-                        SkSpan<SkPoint> positions,
+                        SkSpan<const SkPoint> positions,
                         SkSpan<IDOrDrawable> idsOrDrawables,
                         SkStrikePromise&& strikePromise);
 
@@ -466,7 +465,7 @@ public:
 
 private:
     const SkScalar fStrikeToSourceScale;
-    const SkSpan<SkPoint> fPositions;
+    const SkSpan<const SkPoint> fPositions;
     const SkSpan<IDOrDrawable> fIDsOrDrawables;
     // When the promise is converted to a strike it acts as the ref on the strike to keep the
     // SkDrawable data alive.
@@ -499,15 +498,16 @@ std::optional<DrawableOpSubmitter> DrawableOpSubmitter::MakeFromBuffer(
     SkScalar strikeToSourceScale = buffer.readScalar();
     if (!buffer.validate(0 < strikeToSourceScale)) { return std::nullopt; }
 
-    SkSpan<SkPoint> positions = MakePointsFromBuffer(buffer, alloc);
+    SkSpan<const SkPoint> positions = MakePointsFromBuffer(buffer, alloc);
     if (positions.empty()) { return std::nullopt; }
     const int glyphCount = SkCount(positions);
 
-    if (!buffer.validateCanReadN<int>(glyphCount)) { return std::nullopt; }
+    // Remember, we stored an int for glyph id.
+    const int32_t* glyphIDs = buffer.skipT<int32_t>(glyphCount);
+    if (!buffer.isValid()) { return std::nullopt; }
     auto idsOrDrawables = alloc->makePODArray<IDOrDrawable>(glyphCount);
-    for (int i = 0; i < SkToInt(glyphCount); ++i) {
-        // Remember, we stored an int for glyph id.
-        idsOrDrawables[i].fGlyphID = SkTo<SkGlyphID>(buffer.readInt());
+    for (int i = 0; i < glyphCount; ++i) {
+        idsOrDrawables[i].fGlyphID = SkTo<SkGlyphID>(glyphIDs[i]);
     }
 
     SkASSERT(buffer.isValid());
@@ -519,7 +519,7 @@ std::optional<DrawableOpSubmitter> DrawableOpSubmitter::MakeFromBuffer(
 
 DrawableOpSubmitter::DrawableOpSubmitter(
         SkScalar strikeToSourceScale,
-        SkSpan<SkPoint> positions,
+        SkSpan<const SkPoint> positions,
         SkSpan<IDOrDrawable> idsOrDrawables,
         SkStrikePromise&& strikePromise)
         : fStrikeToSourceScale{strikeToSourceScale}
@@ -1503,13 +1503,20 @@ prepare_for_direct_mask_drawing(StrikeForGPU* strike,
     int acceptedSize = 0,
         rejectedSize = 0;
     SkGlyphRect boundingRect = skglyph::empty_rect();
+    // Map all the positions with one vectorized call. The accepted positions hold them until
+    // each is used, which is safe since a glyph is only ever accepted into an earlier slot.
+    SkASSERT(source.size() <= acceptedBuffer.size());
+    const SkSpan<SkPoint> mappedPositions = acceptedBuffer.get<1>().first(source.size());
+    positionMatrixWithRounding.mapPoints(mappedPositions.data(), source.get<1>().data(),
+                                         SkToInt(source.size()));
+
     StrikeMutationMonitor m{strike};
-    for (auto [glyphID, pos] : source) {
+    for (auto [i, glyphID, pos] : SkMakeEnumerate(source)) {
         if (!SkIsFinite(pos.x(), pos.y())) {
             continue;
         }
 
-        const SkPoint mappedPos = positionMatrixWithRounding.mapPoint(pos);
+        const SkPoint mappedPos = mappedPositions[i];
         const SkPackedGlyphID packedID{glyphID, mappedPos, mask};
         switch (const SkGlyphDigest digest = strike->digestFor(skglyph::kDirectMask, packedID);
                 digest.actionFor(skglyph::kDirectMask)) {
@@ -1993,8 +2000,9 @@ bool SubRunContainer::canReuse(const SkPaint& paint, const SkMatrix& positionMat
 }
 
 // Returns the empty span if there is a problem reading the positions.
-SkSpan<SkPoint> MakePointsFromBuffer(SkReadBuffer& buffer, SubRunAllocator* alloc) {
-    uint32_t glyphCount = buffer.getArrayCount();
+SkSpan<const SkPoint> MakePointsFromBuffer(SkReadBuffer& buffer, SubRunAllocator* alloc) {
+    // This reads what SkWriteBuffer::writePointArray wrote.
+    uint32_t glyphCount = buffer.readUInt();
 
     // Zero indicates a problem with serialization.
     if (!buffer.validate(glyphCount != 0)) { return {}; }
@@ -2003,9 +2011,9 @@ SkSpan<SkPoint> MakePointsFromBuffer(SkReadBuffer& buffer, SubRunAllocator* allo
     if (!buffer.validate(glyphCount <= INT_MAX &&
                          BagOfBytes::WillCountFit<SkPoint>(glyphCount))) { return {}; }
 
-    SkPoint* positionsData = alloc->makePODArray<SkPoint>(glyphCount);
-    if (!buffer.readPointArray(positionsData, glyphCount)) { return {}; }
-    return {positionsData, glyphCount};
+    const SkPoint* positionsData = buffer.skipT<SkPoint>(glyphCount);
+    if (!buffer.isValid()) { return {}; }
+    return alloc->borrowPODSpan(SkSpan(positionsData, glyphCount));
 }
 
 }  // namespace sktext::gpu
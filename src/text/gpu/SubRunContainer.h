@@ -248,8 +248,9 @@ private:
     SubRunList fSubRuns;
 };
 
-// Returns the empty span if there is a problem reading the positions.
-SkSpan<SkPoint> MakePointsFromBuffer(SkReadBuffer&, SubRunAllocator*);
+// Returns the empty span if there is a problem reading the positions. The positions are in the
+// buffer's memory if the allocator borrows it, and copied into the allocator otherwise.
+SkSpan<const SkPoint> MakePointsFromBuffer(SkReadBuffer&, SubRunAllocator*);
 
 }  // namespace sktext::gpu
 
@@ -7,13 +7,19 @@
 
 #include "src/text/gpu/TextBlobRedrawCoordinator.h"
 
+#include "include/core/SkFont.h"
 #include "include/core/SkMatrix.h"
 #include "include/core/SkPoint.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkTypeface.h"
 #include "include/core/SkTypes.h"
+#include "src/core/SkChecksum.h"
 #include "src/core/SkDevice.h"
 #include "src/core/SkStrikeCache.h"
+#include "src/core/SkTextBlobPriv.h"
 #include "src/text/GlyphRun.h"
 
+#include <cstring>
 #include <utility>
 
 class SkCanvas;
@@ -31,8 +37,49 @@ static inline bool SkShouldPostMessageToBus(
     return msg.fContextID == msgBusUniqueID;
 }
 
+static uint64_t content_hash(const SkTextBlob& textBlob) {
+    uint64_t hash = 0;
+    for (SkTextBlobRunIterator it(&textBlob); !it.done(); it.next()) {
+        const SkFont& font = it.font();
+        const struct {
+            SkTypefaceID typefaceID;
+            SkScalar size, scaleX, skewX;
+            SkPoint offset;
+            uint32_t glyphCount, positioning;
+        } run = {font.getTypeface() ? font.getTypeface()->uniqueID() : 0,
+                 font.getSize(), font.getScaleX(), font.getSkewX(), it.offset(),
+                 it.glyphCount(), it.positioning()};
+        hash = SkChecksum::Hash64(&run, sizeof(run), hash);
+        hash = SkChecksum::Hash64(it.glyphs(), it.glyphCount() * sizeof(uint16_t), hash);
+        hash = SkChecksum::Hash64(
+                it.pos(), it.glyphCount() * it.scalarsPerGlyph() * sizeof(SkScalar), hash);
+    }
+    return hash;
+}
+
+// Whether the two blobs draw the same, which their text and clusters do not change.
+static bool same_content(const SkTextBlob& a, const SkTextBlob& b) {
+    if (a.bounds() != b.bounds()) {
+        return false;
+    }
+    SkTextBlobRunIterator itA(&a), itB(&b);
+    for (; !itA.done() && !itB.done(); itA.next(), itB.next()) {
+        if (itA.font() != itB.font() ||
+            itA.offset() != itB.offset() ||
+            itA.positioning() != itB.positioning() ||
+            itA.glyphCount() != itB.glyphCount() ||
+            0 != memcmp(itA.glyphs(), itB.glyphs(), itA.glyphCount() * sizeof(uint16_t)) ||
+            0 != memcmp(itA.pos(), itB.pos(),
+                        itA.glyphCount() * itA.scalarsPerGlyph() * sizeof(SkScalar))) {
+            return false;
+        }
+    }
+    return itA.done() && itB.done();
+}
+
 TextBlobRedrawCoordinator::TextBlobRedrawCoordinator(uint32_t messageBusID)
         : fSizeBudget(kDefaultBudget)
+        , fInternedBlobs(kMaxInternedBlobs)
         , fMessageBusID(messageBusID)
         , fPurgeBlobInbox(messageBusID) { }
 
@@ -59,6 +106,7 @@ sk_sp<TextBlob> TextBlobRedrawCoordinator::findOrCreateBlob(const SkMatrix& view
             glyphRunList, paint, positionMatrix, strikeDeviceInfo);
     sk_sp<TextBlob> blob;
     if (canCache) {
+        key.fUniqueID = this->internedBlobID(*glyphRunList.blob());
         blob = this->find(key);
     }
 
@@ -93,10 +141,33 @@ sk_sp<TextBlob> TextBlobRedrawCoordinator::addOrReturnExisting(
         const GlyphRunList& glyphRunList, sk_sp<TextBlob> blob) {
     SkAutoSpinlock lock{fSpinLock};
     blob = this->internalAdd(std::move(blob));
-    glyphRunList.temporaryShuntBlobNotifyAddedToCache(fMessageBusID, post_purge_blob_message);
+    // A blob cached under another SkTextBlob's uniqueID is purged when that SkTextBlob is freed
+    // instead.
+    if (blob->key().fUniqueID == glyphRunList.uniqueID()) {
+        glyphRunList.temporaryShuntBlobNotifyAddedToCache(fMessageBusID, post_purge_blob_message);
+    }
     return blob;
 }
 
+uint32_t TextBlobRedrawCoordinator::internedBlobID(const SkTextBlob& textBlob) {
+    {
+        SkAutoSpinlock lock{fSpinLock};
+        if (fBlobIDCache.find(textBlob.uniqueID())) {
+            return textBlob.uniqueID();
+        }
+    }
+
+    const uint64_t hash = content_hash(textBlob);
+    SkAutoSpinlock lock{fSpinLock};
+    if (sk_sp<const SkTextBlob>* interned = fInternedBlobs.find(hash)) {
+        // A different blob with the same hash keeps its place; this one is not shared.
+        return same_content(**interned, textBlob) ? (*interned)->uniqueID()
+                                                  : textBlob.uniqueID();
+    }
+    fInternedBlobs.insert(hash, sk_ref_sp(&textBlob));
+    return textBlob.uniqueID();
+}
+
 sk_sp<TextBlob> TextBlobRedrawCoordinator::find(const TextBlob::Key& key) {
     SkAutoSpinlock lock{fSpinLock};
     const BlobIDCacheEntry* idEntry = fBlobIDCache.find(key.fUniqueID);
@@ -139,6 +210,7 @@ void TextBlobRedrawCoordinator::freeAll() {
     SkAutoSpinlock lock{fSpinLock};
     fBlobIDCache.reset();
     fBlobList.reset();
+    fInternedBlobs.reset();
     fCurrentSize = 0;
 }
 
@@ -9,10 +9,12 @@
 #define sktext_gpu_TextBlobRedrawCoordinator_DEFINED
 
 #include "include/core/SkRefCnt.h"
+#include "include/core/SkTextBlob.h"
 #include "include/private/base/SkTArray.h"
 #include "include/private/base/SkThreadAnnotations.h"
 #include "src/base/SkSpinlock.h"
 #include "src/base/SkTInternalLList.h"
+#include "src/core/SkLRUCache.h"
 #include "src/core/SkMessageBus.h"
 #include "src/core/SkTHash.h"
 #include "src/text/gpu/SubRunContainer.h"
@@ -38,6 +40,12 @@ namespace sktext::gpu {
 // uniqueID. The second tier uses the sktext::gpu::TextBlob's key to get a general match for the
 // draw. The last tier queries each sub run using canReuse to determine if each sub run can handle
 // the drawing parameters.
+//
+// Clients often remake an SkTextBlob with the same contents for each frame, which would miss the
+// first tier every time. So an SkTextBlob whose uniqueID has nothing cached is looked up by a hash
+// of its contents (its runs' fonts, glyphs and positions) in a bounded table of the SkTextBlobs
+// seen before. If one has the same contents, its uniqueID is used in its place. The table holds a
+// ref on the SkTextBlobs in it, so their cached draw data stays until they fall out of the table.
 class TextBlobRedrawCoordinator {
 public:
     TextBlobRedrawCoordinator(uint32_t messageBusID);
@@ -101,6 +109,10 @@ private:
 
     sk_sp<TextBlob> find(const TextBlob::Key& key) SK_EXCLUDES(fSpinLock);
 
+    // Returns the uniqueID of the first SkTextBlob seen with the same contents as textBlob that is
+    // still in fInternedBlobs, or textBlob's own uniqueID.
+    uint32_t internedBlobID(const SkTextBlob& textBlob) SK_EXCLUDES(fSpinLock);
+
     void remove(TextBlob* blob) SK_EXCLUDES(fSpinLock);
 
     void internalPurgeStaleBlobs() SK_REQUIRES(fSpinLock);
@@ -112,12 +124,16 @@ private:
     void internalCheckPurge(TextBlob* blob = nullptr) SK_REQUIRES(fSpinLock);
 
     static const int kDefaultBudget = 1 << 22;
+    static const int kMaxInternedBlobs = 256;
 
     mutable SkSpinlock fSpinLock;
     TextBlobList fBlobList SK_GUARDED_BY(fSpinLock);
     skia_private::THashMap<uint32_t, BlobIDCacheEntry> fBlobIDCache SK_GUARDED_BY(fSpinLock);
     size_t fSizeBudget SK_GUARDED_BY(fSpinLock);
     size_t fCurrentSize SK_GUARDED_BY(fSpinLock) {0};
+    // The SkTextBlobs that other SkTextBlobs with the same contents share draw data with, by the
+    // hash of their contents.
+    SkLRUCache<uint64_t, sk_sp<const SkTextBlob>> fInternedBlobs SK_GUARDED_BY(fSpinLock);
 
     // In practice 'messageBusID' is always the unique ID of the owning GrContext
     const uint32_t fMessageBusID;
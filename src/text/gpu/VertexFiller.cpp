@@ -15,7 +15,9 @@
 #include "include/core/SkTypes.h"
 #include "include/private/base/SkTLogic.h"
 #include "src/base/SkZip.h"
+#include "src/core/SkEnumerate.h"
 #include "src/core/SkReadBuffer.h"
+#include "src/core/SkTextQuads.h"
 #include "src/core/SkWriteBuffer.h"
 #include "src/gpu/AtlasTypes.h"
 #include "src/text/gpu/Glyph.h"
@@ -26,6 +28,7 @@
 #include "src/gpu/ganesh/ops/AtlasTextOp.h"
 #endif
 
+#include <algorithm>
 #include <cstdint>
 #include <initializer_list>
 #include <optional>
@@ -70,7 +73,7 @@ std::optional<VertexFiller> VertexFiller::MakeFromBuffer(SkReadBuffer &buffer,
 
     SkRect creationBounds = buffer.readRect();
 
-    SkSpan<SkPoint> leftTop = MakePointsFromBuffer(buffer, alloc);
+    SkSpan<const SkPoint> leftTop = MakePointsFromBuffer(buffer, alloc);
     if (leftTop.empty()) { return std::nullopt; }
 
     SkASSERT(buffer.isValid());
@@ -228,18 +231,31 @@ template<typename Quad, typename VertexData>
 static void fill2D(SkZip<Quad, const Glyph*, const VertexData> quadData,
                    GrColor color,
                    const SkMatrix& viewDifference) {
-    for (auto [quad, glyph, leftTop] : quadData) {
-        auto [l, t] = leftTop;
-        auto [r, b] = leftTop + glyph->fAtlasLocator.widthHeight();
-        SkPoint lt = viewDifference.mapXY(l, t),
-                lb = viewDifference.mapXY(l, b),
-                rt = viewDifference.mapXY(r, t),
-                rb = viewDifference.mapXY(r, b);
-        auto [al, at, ar, ab] = glyph->fAtlasLocator.getUVs();
-        quad[0] = {lt, color, {al, at}};  // L,T
-        quad[1] = {lb, color, {al, ab}};  // L,B
-        quad[2] = {rt, color, {ar, at}};  // R,T
-        quad[3] = {rb, color, {ar, ab}};  // R,B
+    float affine[6];
+    SkAssertResult(viewDifference.asAffine(affine));
+
+    // Map the corners of a batch of glyphs at a time, then interleave them with the colors and
+    // atlas locations.
+    static constexpr int kBatchSize = 64;
+    SkPoint sizes[kBatchSize];
+    SkPoint corners[4 * kBatchSize];
+    for (size_t start = 0; start < quadData.size(); start += kBatchSize) {
+        auto batch = quadData.subspan(start, std::min<size_t>(kBatchSize, quadData.size() - start));
+        for (auto [i, glyph] : SkMakeEnumerate(batch.template get<1>())) {
+            sizes[i] = glyph->fAtlasLocator.widthHeight();
+        }
+        SkOpts::map_text_quads(affine, batch.template get<2>().data(), sizes, batch.size(),
+                               corners);
+
+        const SkPoint* corner = corners;
+        for (auto [quad, glyph, leftTop] : batch) {
+            auto [al, at, ar, ab] = glyph->fAtlasLocator.getUVs();
+            quad[0] = {corner[0], color, {al, at}};  // L,T
+            quad[1] = {corner[1], color, {al, ab}};  // L,B
+            quad[2] = {corner[2], color, {ar, at}};  // R,T
+            quad[3] = {corner[3], color, {ar, ab}};  // R,B
+            corner += 4;
+        }
     }
 }
 
@@ -376,6 +376,8 @@ bool SkDashPath::InternalFilter(SkPath* dst, const SkPath& src, SkStrokeRec* rec
                 cullPathStorage.lineTo(midPoint - v);
             }
         }
+        // The culled path is rebuilt for every call, so keep it out of the measure cache.
+        cullPathStorage.setIsVolatile(true);
         srcPtr = &cullPathStorage;
     }
 
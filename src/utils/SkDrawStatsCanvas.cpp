@@ -0,0 +1,397 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/utils/SkDrawStatsCanvas.h"
+
+#include "include/core/SkBlendMode.h"
+#include "include/core/SkBlender.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkMatrix.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkPath.h"
+#include "include/core/SkRRect.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkRegion.h"
+#include "include/core/SkShader.h"
+#include "include/core/SkStream.h"
+#include "include/core/SkTextBlob.h"
+#include "include/core/SkVertices.h"
+#include "include/private/base/SkTArray.h"
+#include "src/base/SkTime.h"
+#include "src/core/SkBlenderBase.h"
+#include "src/core/SkDrawStatsSink.h"
+#include "src/shaders/SkShaderBase.h"
+#include "src/text/GlyphRun.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace {
+
+const char* shader_name(const SkPaint* paint) {
+    const SkShaderBase* shader = paint ? as_SB(paint->getShader()) : nullptr;
+    if (!shader) {
+        return "None";
+    }
+    switch (shader->asGradient()) {
+        case SkShaderBase::GradientType::kNone: break;
+#define M(type) case SkShaderBase::GradientType::k##type: return #type "Gradient";
+        SK_ALL_GRADIENTS(M)
+#undef M
+    }
+    switch (shader->type()) {
+#define M(type) case SkShaderBase::ShaderType::k##type: return #type;
+        SK_ALL_SHADERS(M)
+#undef M
+    }
+    SkUNREACHABLE;
+}
+
+const char* blender_name(const SkPaint* paint) {
+    if (!paint) {
+        return SkBlendMode_Name(SkBlendMode::kSrcOver);
+    }
+    if (std::optional<SkBlendMode> mode = paint->asBlendMode()) {
+        return SkBlendMode_Name(*mode);
+    }
+    switch (as_BB(paint->getBlender())->type()) {
+#define M(type) case SkBlenderBase::BlenderType::k##type: return #type;
+        SK_ALL_BLENDERS(M)
+#undef M
+    }
+    SkUNREACHABLE;
+}
+
+// The device pixels the draw may touch: its bounds, grown by the paint's effects, mapped to the
+// device and clipped. Draws without bounds cover the whole clip.
+uint64_t covered_pixels(const SkCanvas* canvas, const SkRect* localBounds, const SkPaint* paint) {
+    SkRect device = SkRect::Make(canvas->getDeviceClipBounds());
+    if (localBounds && (!paint || paint->canComputeFastBounds())) {
+        SkRect storage;
+        const SkRect& bounds = paint ? paint->computeFastBounds(*localBounds, &storage)
+                                     : *localBounds;
+        if (!device.intersect(canvas->getTotalMatrix().mapRect(bounds))) {
+            return 0;
+        }
+    }
+    const SkIRect pixels = device.roundOut();
+    return pixels.isEmpty() ? 0 : (uint64_t)pixels.width() * (uint64_t)pixels.height();
+}
+
+void add(SkDrawStatsCanvas::Counter* counter, double millis, uint64_t pixels) {
+    counter->fDraws  += 1;
+    counter->fMillis += millis;
+    counter->fPixels += pixels;
+}
+
+SkDrawStatsCanvas::Counter* find(std::vector<SkDrawStatsCanvas::NamedCounter>* list,
+                                 const char* name) {
+    for (SkDrawStatsCanvas::NamedCounter& entry : *list) {
+        if (entry.fName.equals(name)) {
+            return &entry.fCounter;
+        }
+    }
+    list->push_back({SkString(name), {}});
+    return &list->back().fCounter;
+}
+
+void dump_table(SkWStream* out,
+                const char* title,
+                std::vector<std::pair<const char*, SkDrawStatsCanvas::Counter>> rows) {
+    if (rows.empty()) {
+        return;
+    }
+    std::sort(rows.begin(), rows.end(), [](const auto& a, const auto& b) {
+        return a.second.fMillis > b.second.fMillis;
+    });
+    out->writeText(SkStringPrintf("%-32s %8s %10s %10s\n", title, "draws", "ms", "Mpixels")
+                           .c_str());
+    for (const auto& [name, counter] : rows) {
+        out->writeText(SkStringPrintf("%-32s %8d %10.3f %10.3f\n",
+                                      name, counter.fDraws, counter.fMillis,
+                                      counter.fPixels * 1e-6).c_str());
+    }
+}
+
+}  // namespace
+
+// Times one forwarded draw and, while it runs, collects the rendering choices the backends note.
+class SkDrawStatsCanvas::AutoDraw final : public SkDrawStatsSink {
+public:
+    AutoDraw(SkDrawStatsCanvas* canvas, Op op, const SkPaint* paint, const SkRect* localBounds)
+            : fCanvas(canvas)
+            , fOp(op)
+            , fPaint(paint)
+            , fPixels(covered_pixels(canvas, localBounds, paint))
+            , fInstall(this)
+            , fStart(SkTime::GetNSecs()) {}
+
+    AutoDraw(SkDrawStatsCanvas* canvas, Op op, const SkPaint& paint, const SkRect* localBounds)
+            : AutoDraw(canvas, op, &paint, localBounds) {}
+
+    ~AutoDraw() override {
+        const double millis = (SkTime::GetNSecs() - fStart) * 1e-6;
+
+        Stats& stats = fCanvas->fStats;
+        add(&stats.fOps[static_cast<int>(fOp)], millis, fPixels);
+        add(find(&stats.fShaders, shader_name(fPaint)), millis, fPixels);
+        add(find(&stats.fBlenders, blender_name(fPaint)), millis, fPixels);
+        for (const char* renderer : fRenderers) {
+            add(find(&stats.fRenderers, renderer), millis, fPixels);
+        }
+    }
+
+private:
+    void onRenderer(const char* name) override {
+        for (const char* renderer : fRenderers) {
+            if (0 == strcmp(renderer, name)) {
+                return;
+            }
+        }
+        fRenderers.push_back(name);
+    }
+
+    void onRasterPipeline(bool lowp) override {
+        ++(lowp ? fCanvas->fStats.fLowpPipelines : fCanvas->fStats.fHighpPipelines);
+    }
+
+    SkDrawStatsCanvas* const fCanvas;
+    const Op                 fOp;
+    const SkPaint* const     fPaint;
+    const uint64_t           fPixels;
+    AutoInstall              fInstall;
+    const double             fStart;
+
+    skia_private::STArray<2, const char*> fRenderers;
+};
+
+const char* SkDrawStatsCanvas::OpName(Op op) {
+    switch (op) {
+        case Op::kPaint:          return "paint";
+        case Op::kBehind:         return "behind";
+        case Op::kPoints:         return "points";
+        case Op::kRect:           return "rect";
+        case Op::kRRect:          return "rrect";
+        case Op::kDRRect:         return "drrect";
+        case Op::kRegion:         return "region";
+        case Op::kOval:           return "oval";
+        case Op::kArc:            return "arc";
+        case Op::kPath:           return "path";
+        case Op::kImage:          return "image";
+        case Op::kImageRect:      return "image_rect";
+        case Op::kImageLattice:   return "image_lattice";
+        case Op::kAtlas:          return "atlas";
+        case Op::kVertices:       return "vertices";
+        case Op::kPatch:          return "patch";
+        case Op::kText:           return "text";
+        case Op::kShadow:         return "shadow";
+        case Op::kEdgeAAQuad:     return "edge_aa_quad";
+        case Op::kEdgeAAImageSet: return "edge_aa_image_set";
+    }
+    SkUNREACHABLE;
+}
+
+void SkDrawStatsCanvas::Stats::dump(SkWStream* out) const {
+    using Rows = std::vector<std::pair<const char*, Counter>>;
+    auto named_rows = [](const std::vector<NamedCounter>& list) {
+        Rows rows;
+        for (const NamedCounter& entry : list) {
+            rows.push_back({entry.fName.c_str(), entry.fCounter});
+        }
+        return rows;
+    };
+
+    Rows ops;
+    for (int i = 0; i < kOpCount; ++i) {
+        if (fOps[i].fDraws) {
+            ops.push_back({OpName(static_cast<Op>(i)), fOps[i]});
+        }
+    }
+    dump_table(out, "op", std::move(ops));
+    dump_table(out, "shader", named_rows(fShaders));
+    dump_table(out, "blender", named_rows(fBlenders));
+    dump_table(out, "renderer", named_rows(fRenderers));
+    if (fLowpPipelines || fHighpPipelines) {
+        out->writeText(SkStringPrintf("raster pipelines: %d lowp, %d highp\n",
+                                      fLowpPipelines, fHighpPipelines).c_str());
+    }
+}
+
+SkDrawStatsCanvas::SkDrawStatsCanvas(SkCanvas* target)
+        : SkPaintFilterCanvas(target)
+        , fTarget(target) {}
+
+SkDrawStatsCanvas::Stats SkDrawStatsCanvas::endFrame() {
+    return std::exchange(fStats, Stats());
+}
+
+skgpu::graphite::Recorder* SkDrawStatsCanvas::recorder() const {
+    return fTarget->recorder();
+}
+
+void SkDrawStatsCanvas::onDrawPaint(const SkPaint& paint) {
+    AutoDraw ad(this, Op::kPaint, paint, nullptr);
+    this->SkPaintFilterCanvas::onDrawPaint(paint);
+}
+
+void SkDrawStatsCanvas::onDrawBehind(const SkPaint& paint) {
+    AutoDraw ad(this, Op::kBehind, paint, nullptr);
+    this->SkPaintFilterCanvas::onDrawBehind(paint);
+}
+
+void SkDrawStatsCanvas::onDrawPoints(PointMode mode, size_t count, const SkPoint pts[],
+                                     const SkPaint& paint) {
+    SkRect bounds;
+    bounds.setBounds(pts, SkToInt(count));
+    // Points are stroked whatever the paint's style.
+    bounds.outset(paint.getStrokeWidth() / 2, paint.getStrokeWidth() / 2);
+    AutoDraw ad(this, Op::kPoints, paint, &bounds);
+    this->SkPaintFilterCanvas::onDrawPoints(mode, count, pts, paint);
+}
+
+void SkDrawStatsCanvas::onDrawRect(const SkRect& rect, const SkPaint& paint) {
+    const SkRect bounds = rect.makeSorted();
+    AutoDraw ad(this, Op::kRect, paint, &bounds);
+    this->SkPaintFilterCanvas::onDrawRect(rect, paint);
+}
+
+void SkDrawStatsCanvas::onDrawRRect(const SkRRect& rrect, const SkPaint& paint) {
+    AutoDraw ad(this, Op::kRRect, paint, &rrect.getBounds());
+    this->SkPaintFilterCanvas::onDrawRRect(rrect, paint);
+}
+
+void SkDrawStatsCanvas::onDrawDRRect(const SkRRect& outer, const SkRRect& inner,
+                                     const SkPaint& paint) {
+    AutoDraw ad(this, Op::kDRRect, paint, &outer.getBounds());
+    this->SkPaintFilterCanvas::onDrawDRRect(outer, inner, paint);
+}
+
+void SkDrawStatsCanvas::onDrawRegion(const SkRegion& region, const SkPaint& paint) {
+    const SkRect bounds = SkRect::Make(region.getBounds());
+    AutoDraw ad(this, Op::kRegion, paint, &bounds);
+    this->SkPaintFilterCanvas::onDrawRegion(region, paint);
+}
+
+void SkDrawStatsCanvas::onDrawOval(const SkRect& rect, const SkPaint& paint) {
+    const SkRect bounds = rect.makeSorted();
+    AutoDraw ad(this, Op::kOval, paint, &bounds);
+    this->SkPaintFilterCanvas::onDrawOval(rect, paint);
+}
+
+void SkDrawStatsCanvas::onDrawArc(const SkRect& rect, SkScalar startAngle, SkScalar sweepAngle,
+                                  bool useCenter, const SkPaint& paint) {
+    const SkRect bounds = rect.makeSorted();
+    AutoDraw ad(this, Op::kArc, paint, &bounds);
+    this->SkPaintFilterCanvas::onDrawArc(rect, startAngle, sweepAngle, useCenter, paint);
+}
+
+void SkDrawStatsCanvas::onDrawPath(const SkPath& path, const SkPaint& paint) {
+    AutoDraw ad(this, Op::kPath, paint, path.isInverseFillType() ? nullptr : &path.getBounds());
+    this->SkPaintFilterCanvas::onDrawPath(path, paint);
+}
+
+void SkDrawStatsCanvas::onDrawImage2(const SkImage* image, SkScalar x, SkScalar y,
+                                     const SkSamplingOptions& sampling, const SkPaint* paint) {
+    const SkRect bounds = SkRect::MakeXYWH(x, y, image->width(), image->height());
+    AutoDraw ad(this, Op::kImage, paint, &bounds);
+    this->SkPaintFilterCanvas::onDrawImage2(image, x, y, sampling, paint);
+}
+
+void SkDrawStatsCanvas::onDrawImageRect2(const SkImage* image, const SkRect& src,
+                                         const SkRect& dst, const SkSamplingOptions& sampling,
+                                         const SkPaint* paint, SrcRectConstraint constraint) {
+    AutoDraw ad(this, Op::kImageRect, paint, &dst);
+    this->SkPaintFilterCanvas::onDrawImageRect2(image, src, dst, sampling, paint, constraint);
+}
+
+void SkDrawStatsCanvas::onDrawImageLattice2(const SkImage* image, const Lattice& lattice,
+                                            const SkRect& dst, SkFilterMode filter,
+                                            const SkPaint* paint) {
+    AutoDraw ad(this, Op::kImageLattice, paint, &dst);
+    this->SkPaintFilterCanvas::onDrawImageLattice2(image, lattice, dst, filter, paint);
+}
+
+void SkDrawStatsCanvas::onDrawAtlas2(const SkImage* image, const SkRSXform xform[],
+                                     const SkRect tex[], const SkColor colors[], int count,
+                                     SkBlendMode mode, const SkSamplingOptions& sampling,
+                                     const SkRect* cull, const SkPaint* paint) {
+    AutoDraw ad(this, Op::kAtlas, paint, cull);
+    this->SkPaintFilterCanvas::onDrawAtlas2(image, xform, tex, colors, count, mode, sampling,
+                                            cull, paint);
+}
+
+void SkDrawStatsCanvas::onDrawVerticesObject(const SkVertices* vertices, SkBlendMode mode,
+                                             const SkPaint& paint) {
+    AutoDraw ad(this, Op::kVertices, paint, &vertices->bounds());
+    this->SkPaintFilterCanvas::onDrawVerticesObject(vertices, mode, paint);
+}
+
+void SkDrawStatsCanvas::onDrawPatch(const SkPoint cubics[12], const SkColor colors[4],
+                                    const SkPoint texCoords[4], SkBlendMode mode,
+                                    const SkPaint& paint) {
+    SkRect bounds;
+    bounds.setBounds(cubics, 12);
+    AutoDraw ad(this, Op::kPatch, paint, &bounds);
+    this->SkPaintFilterCanvas::onDrawPatch(cubics, colors, texCoords, mode, paint);
+}
+
+void SkDrawStatsCanvas::onDrawPicture(const SkPicture* picture, const SkMatrix* matrix,
+                                      const SkPaint* paint) {
+    // Played back through this canvas, so each of the picture's draws is counted.
+    this->SkCanvas::onDrawPicture(picture, matrix, paint);
+}
+
+void SkDrawStatsCanvas::onDrawDrawable(SkDrawable* drawable, const SkMatrix* matrix) {
+    this->SkCanvas::onDrawDrawable(drawable, matrix);
+}
+
+void SkDrawStatsCanvas::onDrawGlyphRunList(const sktext::GlyphRunList& list,
+                                           const SkPaint& paint) {
+    const SkRect bounds = list.sourceBoundsWithOrigin();
+    AutoDraw ad(this, Op::kText, paint, &bounds);
+    this->SkPaintFilterCanvas::onDrawGlyphRunList(list, paint);
+}
+
+void SkDrawStatsCanvas::onDrawTextBlob(const SkTextBlob* blob, SkScalar x, SkScalar y,
+                                       const SkPaint& paint) {
+    const SkRect bounds = blob->bounds().makeOffset(x, y);
+    AutoDraw ad(this, Op::kText, paint, &bounds);
+    this->SkPaintFilterCanvas::onDrawTextBlob(blob, x, y, paint);
+}
+
+void SkDrawStatsCanvas::onDrawShadowRec(const SkPath& path, const SkDrawShadowRec& rec) {
+    // Shadows can spread well past the path, so count the whole clip.
+    AutoDraw ad(this, Op::kShadow, nullptr, nullptr);
+    this->SkPaintFilterCanvas::onDrawShadowRec(path, rec);
+}
+
+void SkDrawStatsCanvas::onDrawEdgeAAQuad(const SkRect& rect, const SkPoint clip[4],
+                                         QuadAAFlags aa, const SkColor4f& color,
+                                         SkBlendMode mode) {
+    SkPaint paint(color);
+    paint.setBlendMode(mode);
+    AutoDraw ad(this, Op::kEdgeAAQuad, paint, &rect);
+    this->SkPaintFilterCanvas::onDrawEdgeAAQuad(rect, clip, aa, color, mode);
+}
+
+void SkDrawStatsCanvas::onDrawEdgeAAImageSet2(const ImageSetEntry set[], int count,
+                                              const SkPoint dstClips[],
+                                              const SkMatrix preViewMatrices[],
+                                              const SkSamplingOptions& sampling,
+                                              const SkPaint* paint,
+                                              SrcRectConstraint constraint) {
+    SkRect bounds = SkRect::MakeEmpty();
+    for (int i = 0; i < count; ++i) {
+        const int matrixIndex = set[i].fMatrixIndex;
+        bounds.join(matrixIndex >= 0 ? preViewMatrices[matrixIndex].mapRect(set[i].fDstRect)
+                                     : set[i].fDstRect);
+    }
+    AutoDraw ad(this, Op::kEdgeAAImageSet, paint, &bounds);
+    this->SkPaintFilterCanvas::onDrawEdgeAAImageSet2(set, count, dstClips, preViewMatrices,
+                                                     sampling, paint, constraint);
+}
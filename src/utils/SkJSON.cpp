@@ -11,11 +11,13 @@
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkStream.h"
 #include "include/core/SkString.h"
+#include "include/private/base/SkAlign.h"
 #include "include/private/base/SkDebug.h"
 #include "include/private/base/SkMalloc.h"
 #include "include/private/base/SkTo.h"
 #include "include/utils/SkParse.h"
 #include "src/base/SkArenaAlloc.h"
+#include "src/base/SkMathPriv.h"
 #include "src/base/SkUTF.h"
 
 #include <cmath>
@@ -26,6 +28,12 @@
 #include <tuple>
 #include <vector>
 
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE2
+    #include <emmintrin.h>
+#elif defined(SK_ARM_HAS_NEON)
+    #include <arm_neon.h>
+#endif
+
 namespace skjson {
 
 // #define SK_JSON_REPORT_ERRORS
@@ -298,11 +306,113 @@ static inline bool is_digit(char c)    { return g_token_flags[static_cast<uint8_
 static inline bool is_numeric(char c)  { return g_token_flags[static_cast<uint8_t>(c)] & 0x10; }
 static inline bool is_eoscope(char c)  { return g_token_flags[static_cast<uint8_t>(c)] & 0x20; }
 
-static inline const char* skip_ws(const char* p) {
+// Whitespace runs (indentation) and string bodies are scanned 16 bytes at a time where SIMD is
+// available.  Each block is classified into a bitmask with one bit per byte (4 bits with NEON, so
+// byte indices come from the bit index >> kBlockShift), and the scan stops at the lowest set bit.
+// Blocks stop short of p_stop, the final scope terminator: the scalar scans below rely on it to
+// not run past the end of the input.
+
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE2
+static constexpr int kBlockShift = 0;
+
+// Bytes which are not whitespace.
+static inline uint64_t non_ws_mask(const char* p) {
+    const __m128i c  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    const __m128i ws = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(c, _mm_set1_epi8(' ')),
+                                                 _mm_cmpeq_epi8(c, _mm_set1_epi8('\n'))),
+                                    _mm_or_si128(_mm_cmpeq_epi8(c, _mm_set1_epi8('\t')),
+                                                 _mm_cmpeq_epi8(c, _mm_set1_epi8('\r'))));
+    return ~static_cast<uint32_t>(_mm_movemask_epi8(ws)) & 0xffff;
+}
+
+// Quotes, backslashes and control characters.
+static inline uint64_t eostring_mask(const char* p) {
+    const __m128i c    = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    const __m128i ctrl = _mm_cmpeq_epi8(_mm_max_epu8(c, _mm_set1_epi8(0x1f)), _mm_set1_epi8(0x1f));
+    const __m128i eos  = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(c, _mm_set1_epi8('"')),
+                                                   _mm_cmpeq_epi8(c, _mm_set1_epi8('\\'))),
+                                      ctrl);
+    return static_cast<uint32_t>(_mm_movemask_epi8(eos));
+}
+#elif defined(SK_ARM_HAS_NEON)
+static constexpr int kBlockShift = 2;
+
+static inline uint64_t to_mask(uint8x16_t m) {
+    // Narrowing each 16-bit pair of 0x00/0xff bytes by 4 bits leaves a nibble per byte.
+    const uint8x8_t nibbles = vshrn_n_u16(vreinterpretq_u16_u8(m), 4);
+    return vget_lane_u64(vreinterpret_u64_u8(nibbles), 0) & 0x8888888888888888ull;
+}
+
+static inline uint64_t non_ws_mask(const char* p) {
+    const uint8x16_t c  = vld1q_u8(reinterpret_cast<const uint8_t*>(p));
+    const uint8x16_t ws = vorrq_u8(vorrq_u8(vceqq_u8(c, vdupq_n_u8(' ')),
+                                            vceqq_u8(c, vdupq_n_u8('\n'))),
+                                   vorrq_u8(vceqq_u8(c, vdupq_n_u8('\t')),
+                                            vceqq_u8(c, vdupq_n_u8('\r'))));
+    return to_mask(vmvnq_u8(ws));
+}
+
+static inline uint64_t eostring_mask(const char* p) {
+    const uint8x16_t c   = vld1q_u8(reinterpret_cast<const uint8_t*>(p));
+    const uint8x16_t eos = vorrq_u8(vorrq_u8(vceqq_u8(c, vdupq_n_u8('"')),
+                                             vceqq_u8(c, vdupq_n_u8('\\'))),
+                                    vcltq_u8(c, vdupq_n_u8(0x20)));
+    return to_mask(eos);
+}
+#endif
+
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE2 || defined(SK_ARM_HAS_NEON)
+static constexpr size_t kBlockSize = 16;
+static constexpr size_t kShortString = 4;
+
+static inline size_t lowest_in_block(uint64_t mask) {
+    SkASSERT(mask);
+    const uint32_t lo = static_cast<uint32_t>(mask);
+    const int bit = lo ? SkCTZ(lo) : 32 + SkCTZ(static_cast<uint32_t>(mask >> 32));
+    return bit >> kBlockShift;
+}
+#endif
+
+static inline const char* skip_ws(const char* p, const char* p_stop) {
+    // Most whitespace runs are empty or a single space between tokens; only indentation runs are
+    // worth scanning in blocks.
+    if (!is_ws(p[0])) return p;
+    if (!is_ws(p[1])) return p + 1;
+
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE2 || defined(SK_ARM_HAS_NEON)
+    for (; p_stop - p > static_cast<ptrdiff_t>(kBlockSize); p += kBlockSize) {
+        if (const uint64_t mask = non_ws_mask(p)) {
+            return p + lowest_in_block(mask);
+        }
+    }
+#endif
+
     while (is_ws(*p)) ++p;
     return p;
 }
 
+// Returns the first quote, backslash or control character at or after p, or a scope terminator
+// (which may be inside the string).
+static inline const char* find_eostring(const char* p, const char* p_stop) {
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE2 || defined(SK_ARM_HAS_NEON)
+    // Most strings are short keys, which are quicker to scan one byte at a time.
+    for (const char* p_short = p + kShortString; p < p_short; ++p) {
+        if (is_eostring(*p)) return p;
+    }
+
+    // Blocks don't stop at scope terminators inside strings; the scalar scan has to, in case they
+    // are the end of the input.
+    for (; p_stop - p > static_cast<ptrdiff_t>(kBlockSize); p += kBlockSize) {
+        if (const uint64_t mask = eostring_mask(p)) {
+            return p + lowest_in_block(mask);
+        }
+    }
+#endif
+
+    while (!is_eostring(*p)) ++p;
+    return p;
+}
+
 static inline float pow10(int32_t exp) {
     static constexpr float g_pow10_table[63] =
     {
@@ -349,7 +459,7 @@ public:
             return this->error(NullValue(), p_stop, "invalid top-level value");
         }
 
-        p = skip_ws(p);
+        p = skip_ws(p, p_stop);
 
         switch (*p) {
         case '{':
@@ -362,7 +472,7 @@ public:
 
     match_object:
         SkASSERT(*p == '{');
-        p = skip_ws(p + 1);
+        p = skip_ws(p + 1, p_stop);
 
         this->pushObjectScope();
 
@@ -370,7 +480,7 @@ public:
 
         // goto match_object_key;
     match_object_key:
-        p = skip_ws(p);
+        p = skip_ws(p, p_stop);
         if (*p != '"') return this->error(NullValue(), p, "expected object key");
 
         p = this->matchString(p, p_stop, [this](const char* key, size_t size, const char* eos) {
@@ -378,14 +488,14 @@ public:
         });
         if (!p) return NullValue();
 
-        p = skip_ws(p);
+        p = skip_ws(p, p_stop);
         if (*p != ':') return this->error(NullValue(), p, "expected ':' separator");
 
         ++p;
 
         // goto match_value;
     match_value:
-        p = skip_ws(p);
+        p = skip_ws(p, p_stop);
 
         switch (*p) {
         case '\0':
@@ -419,7 +529,7 @@ public:
     match_post_value:
         SkASSERT(!this->inTopLevelScope());
 
-        p = skip_ws(p);
+        p = skip_ws(p, p_stop);
         switch (*p) {
         case ',':
             ++p;
@@ -472,7 +582,7 @@ public:
 
     match_array:
         SkASSERT(*p == '[');
-        p = skip_ws(p + 1);
+        p = skip_ws(p + 1, p_stop);
 
         this->pushArrayScope();
 
@@ -730,7 +840,7 @@ private:
         do {
             // Consume string chars.
             // This is the fast path, and hopefully we only hit it once then quick-exit below.
-            for (p = p + 1; !is_eostring(*p); ++p);
+            p = find_eostring(p + 1, p_stop);
 
             if (*p == '"') {
                 // Valid string found.
@@ -943,16 +1053,251 @@ SkString Value::toString() const {
     return SkString(static_cast<const char*>(data->data()), data->size());
 }
 
+// The binary DOM form is
+//
+//   [magic (8 bytes)] [root record (8 bytes)] [vector_0] ... [vector_n-1]
+//
+// Records are 8-byte Values, verbatim except for those pointing to vectors (long strings,
+// arrays and objects), which store the offset of their vector (past the root record) in place
+// of the pointer.  Vectors are laid out as in memory, padded to 8 bytes, except that their 64-bit
+// size also holds their tag:
+//
+//   [uint64_t n << 3 | tag] [REC_0] ... [REC_n-1] [string \0 terminator] [padding]
+//
+// Vectors appear in breadth-first order, so loading them is a single pass which also verifies
+// that each is referenced exactly once.
+namespace {
+
+static constexpr char kBinaryMagic[8] = { '\0', 's', 'k', 'j', 's', 'o', 'n', '1' };
+static constexpr size_t kBinaryHeaderSize = sizeof(kBinaryMagic) + sizeof(uint64_t);
+
+class BinaryValue final : public Value {
+public:
+    static void Write(const Value& root, SkWStream* stream) {
+        std::vector<const BinaryValue*> queue;
+        uint64_t offset = 0;
+
+        auto write_record = [&](const Value& v) {
+            const auto& bv = static_cast<const BinaryValue&>(v);
+            if (!bv.isVector()) {
+                stream->write(&bv, sizeof(Value));
+                return;
+            }
+            const uint64_t rec = offset | static_cast<uint64_t>(bv.getTag());
+            stream->write(&rec, sizeof(rec));
+            offset += VectorBytes(bv.getTag(), bv.vectorSize());
+            queue.push_back(&bv);
+        };
+
+        stream->write(kBinaryMagic, sizeof(kBinaryMagic));
+        write_record(root);
+
+        for (size_t i = 0; i < queue.size(); ++i) {
+            const auto* v = queue[i];
+            // The header also holds the tag, so vectors can be read in order.
+            const uint64_t n      = v->vectorSize(),
+                           header = n << 3 | static_cast<uint64_t>(v->getTag());
+            stream->write(&header, sizeof(header));
+
+            switch (v->getTag()) {
+            case Tag::kString:
+                stream->write(v->as<StringValue>().begin(), n + 1);
+                break;
+            case Tag::kArray:
+                for (const auto& entry : v->as<ArrayValue>()) {
+                    write_record(entry);
+                }
+                break;
+            case Tag::kObject:
+                for (const auto& member : v->as<ObjectValue>()) {
+                    write_record(member.fKey);
+                    write_record(member.fValue);
+                }
+                break;
+            default:
+                SkUNREACHABLE;
+            }
+
+            static constexpr char kPadding[8] = {};
+            const auto written = sizeof(header) + PayloadBytes(v->getTag(), n);
+            stream->write(kPadding, SkAlign8(written) - written);
+        }
+    }
+
+    static Value Read(const char* data, size_t size, SkArenaAlloc& alloc) {
+        if (!DOM::IsBinary(data, size) || SkAlign8(size) != size) {
+            return NullValue();
+        }
+
+        const char* image      = data + kBinaryHeaderSize;
+        const size_t imageSize = size - kBinaryHeaderSize;
+
+        // When size_t is 64-bit, vectors are laid out exactly as in memory, so we copy the whole
+        // image at once and fix it up in place.  Otherwise, vectors are copied one by one.
+        static constexpr bool kInPlace = sizeof(size_t) == sizeof(uint64_t);
+        char* block = nullptr;
+        if (kInPlace && imageSize) {
+            block = reinterpret_cast<char*>(alloc.makeBytesAlignedTo(imageSize, kRecAlign));
+            memcpy(block, image, imageSize);
+            image = block;
+        }
+
+        // Vectors copied one by one, in order.
+        std::vector<size_t*> copies;
+        uint64_t next_offset = 0;
+
+        auto read_record = [&](const char* src, Value* dst) {
+            uint64_t rec;
+            memcpy(&rec, src, sizeof(rec));
+            if (!kInPlace) {
+                memcpy(static_cast<void*>(dst), &rec, sizeof(rec));
+            }
+
+            const auto tag = static_cast<Tag>(rec & kTagMask);
+            switch (tag) {
+            case Tag::kBool:
+                // See cast<bool>() for the layout of inline values.
+                return ((rec >> 8) & 0xff) <= 1;
+            case Tag::kShortString:
+                // Short strings must be \0-terminated within the record.
+                return (rec >> 56) == 0;
+            case Tag::kString:
+            case Tag::kArray:
+            case Tag::kObject:
+                break;
+            default:
+                return true;
+            }
+
+            // Vectors must follow each other in the order they are referenced.
+            const auto offset = rec & ~static_cast<uint64_t>(kTagMask);
+            if (offset != next_offset || imageSize - offset < sizeof(uint64_t)) {
+                return false;
+            }
+            uint64_t header;
+            memcpy(&header, image + offset, sizeof(header));
+            const auto n = header >> 3;
+            // Entries take at least one byte each, which bounds n before computing sizes.
+            if (static_cast<Tag>(header & kTagMask) != tag ||
+                n > imageSize - offset || VectorBytes(tag, n) > imageSize - offset) {
+                return false;
+            }
+            next_offset += VectorBytes(tag, n);
+
+            void* vec;
+            if (kInPlace) {
+                vec = block + offset;
+            } else {
+                vec = alloc.makeBytesAlignedTo(sizeof(size_t) + PayloadBytes(tag, n), kRecAlign);
+                copies.push_back(static_cast<size_t*>(vec));
+            }
+            static_cast<BinaryValue*>(dst)->init_tagged_pointer(tag, vec);
+            return true;
+        };
+
+        // Like JSON text, the binary form must hold an object or an array.
+        Value root;
+        memcpy(static_cast<void*>(&root), data + sizeof(kBinaryMagic), sizeof(Value));
+        if ((!root.is<ObjectValue>() && !root.is<ArrayValue>()) ||
+            !read_record(data + sizeof(kBinaryMagic), &root)) {
+            return NullValue();
+        }
+
+        // Each vector is referenced before it is read, since vectors are in breadth-first order.
+        uint64_t offset = 0;
+        for (size_t i = 0; offset < next_offset; ++i) {
+            uint64_t header;
+            memcpy(&header, image + offset, sizeof(header));
+            const auto  tag = static_cast<Tag>(header & kTagMask);
+            const auto  n   = SkTo<size_t>(header >> 3);
+            const char* src = image + offset + sizeof(uint64_t);
+
+            auto* size_ptr = kInPlace ? reinterpret_cast<size_t*>(block + offset) : copies[i];
+            *size_ptr = n;
+            auto* dst = reinterpret_cast<Value*>(size_ptr + 1);
+
+            if (tag == Tag::kString) {
+                if (src[n] != '\0') {
+                    return NullValue();
+                }
+                if (!kInPlace) {
+                    memcpy(dst, src, n + 1);
+                }
+            } else {
+                // Object members are key/value record pairs, and keys must be strings.
+                const bool   is_object = tag == Tag::kObject;
+                const size_t count     = is_object ? 2 * n : n;
+                for (size_t j = 0; j < count; ++j) {
+                    const auto* rec = src + j * sizeof(Value);
+                    if (is_object && !(j & 1) &&
+                        (*rec & kTagMask) != SkToU8(Tag::kShortString) &&
+                        (*rec & kTagMask) != SkToU8(Tag::kString)) {
+                        return NullValue();
+                    }
+                    if (!read_record(rec, dst + j)) {
+                        return NullValue();
+                    }
+                }
+            }
+
+            offset += VectorBytes(tag, n);
+        }
+
+        return offset == imageSize ? root : NullValue();
+    }
+
+private:
+    bool isVector() const {
+        return this->getTag() == Tag::kString ||
+               this->getTag() == Tag::kArray  ||
+               this->getTag() == Tag::kObject;
+    }
+
+    size_t vectorSize() const {
+        SkASSERT(this->isVector());
+        return *this->ptr<size_t>();
+    }
+
+    static uint64_t PayloadBytes(Tag tag, uint64_t n) {
+        switch (tag) {
+        case Tag::kString: return n + 1;
+        case Tag::kArray:  return n * sizeof(Value);
+        case Tag::kObject: return n * sizeof(Member);
+        default:           SkUNREACHABLE;
+        }
+    }
+
+    static uint64_t VectorBytes(Tag tag, uint64_t n) {
+        return SkAlign8(sizeof(uint64_t) + PayloadBytes(tag, n));
+    }
+};
+
+} // namespace
+
 static constexpr size_t kMinChunkSize = 4096;
 
-DOM::DOM(const char* data, size_t size)
+DOM::DOM(const char* data, size_t size, Format format)
     : fAlloc(kMinChunkSize) {
+    if (format == Format::kBinary) {
+        fRoot = BinaryValue::Read(data, size, fAlloc);
+        return;
+    }
+
     DOMParser parser(fAlloc);
 
     fRoot = parser.parse(data, size);
 }
 
-void DOM::write(SkWStream* stream) const {
+bool DOM::IsBinary(const char* data, size_t size) {
+    return size >= kBinaryHeaderSize && !memcmp(data, kBinaryMagic, sizeof(kBinaryMagic));
+}
+
+void DOM::write(SkWStream* stream, Format format) const {
+    if (format == Format::kBinary) {
+        BinaryValue::Write(fRoot, stream);
+        return;
+    }
+
     Write(fRoot, stream);
 }
 
@@ -357,11 +357,24 @@ private:
 
 class DOM final : public SkNoncopyable {
 public:
-    DOM(const char*, size_t);
+    /**
+     * Besides JSON text, a DOM can be stored in a binary form which loads without any text
+     * parsing: its values are laid out as in memory, and only need their pointers fixed up.
+     * The binary form is specific to this implementation, and not meant for long-term storage.
+     */
+    enum class Format {
+        kText,
+        kBinary,
+    };
+
+    DOM(const char*, size_t, Format = Format::kText);
+
+    // Returns true if the data starts like the binary form.
+    static bool IsBinary(const char*, size_t);
 
     const Value& root() const { return fRoot; }
 
-    void write(SkWStream*) const;
+    void write(SkWStream*, Format = Format::kText) const;
 
 private:
     SkArenaAlloc fAlloc;
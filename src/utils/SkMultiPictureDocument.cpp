@@ -10,16 +10,20 @@
 #include "include/core/SkCanvas.h"
 #include "include/core/SkData.h"
 #include "include/core/SkDocument.h"
+#include "include/core/SkFontMgr.h"
 #include "include/core/SkPicture.h"
 #include "include/core/SkPictureRecorder.h"
 #include "include/core/SkRect.h"
 #include "include/core/SkScalar.h"
 #include "include/core/SkSerialProcs.h"
 #include "include/core/SkStream.h"
+#include "include/core/SkTypeface.h"
 #include "include/private/base/SkDebug.h"
 #include "include/private/base/SkTArray.h"
 #include "include/private/base/SkTo.h"
 #include "include/utils/SkNWayCanvas.h"
+#include "src/base/SkSafeMath.h"
+#include "src/core/SkTHash.h"
 #include "src/utils/SkMultiPictureDocumentPriv.h"
 
 #include <algorithm>
@@ -27,6 +31,7 @@
 #include <cstdint>
 #include <cstring>
 #include <functional>
+#include <memory>
 #include <utility>
 
 using namespace skia_private;
@@ -35,13 +40,23 @@ using namespace skia_private;
   File format:
       BEGINNING_OF_FILE:
         kMagic
-        uint32_t version_number (==2)
+        uint32_t version_number (==3)
         uint32_t page_count
         {
           float sizeX
           float sizeY
         } * page_count
-        skp file
+        uint32_t page_length * page_count
+        uint32_t typeface_count
+        uint32_t typeface_length * typeface_count
+        typeface * typeface_count
+        skp file * page_count
+
+  Each page is its own skp file, so any one of them can be read without the others. Typefaces are
+  shared between pages: each page refers to them by their index in the document.
+
+  Version 2 documents end with a single skp file instead, of all the pages one after another,
+  separated by kEndPage annotations.
 */
 
 namespace {
@@ -50,22 +65,28 @@ static constexpr char kMagic[] = "Skia Multi-Picture Doc\n\n";
 
 static constexpr char kEndPage[] = "SkMultiPictureEndPage";
 
-const uint32_t kVersion = 2;
+const uint32_t kVersion = 3;
+const uint32_t kUnindexedVersion = 2;
 
-static SkSize join(const TArray<SkSize>& sizes) {
-    SkSize joined = {0, 0};
-    for (SkSize s : sizes) {
-        joined = SkSize{std::max(joined.width(), s.width()), std::max(joined.height(), s.height())};
+static sk_sp<SkData> serialize_typeface(SkTypeface* typeface, const SkSerialProcs& procs) {
+    if (procs.fTypefaceProc) {
+        if (sk_sp<SkData> data = procs.fTypefaceProc(typeface, procs.fTypefaceCtx)) {
+            return data;
+        }
     }
-    return joined;
+    // As in SkPictureData, include the font data, since there may be no font manager to find the
+    // typeface from its descriptor alone.
+    return typeface->serialize(SkTypeface::SerializeBehavior::kDoIncludeData);
 }
 
 struct MultiPictureDocument final : public SkDocument {
     const SkSerialProcs fProcs;
     SkPictureRecorder fPictureRecorder;
     SkSize fCurrentPageSize;
-    TArray<sk_sp<SkPicture>> fPages;
+    TArray<sk_sp<SkData>> fPages;
     TArray<SkSize> fSizes;
+    TArray<sk_sp<SkTypeface>> fTypefaces;
+    THashMap<SkTypefaceID, uint32_t> fTypefaceIndices;
     std::function<void(const SkPicture*)> fOnEndPage;
     MultiPictureDocument(SkWStream* s,
                          const SkSerialProcs* procs,
@@ -83,10 +104,27 @@ struct MultiPictureDocument final : public SkDocument {
     void onEndPage() override {
         fSizes.push_back(fCurrentPageSize);
         sk_sp<SkPicture> lastPage = fPictureRecorder.finishRecordingAsPicture();
-        fPages.push_back(lastPage);
         if (fOnEndPage) {
             fOnEndPage(lastPage.get());
         }
+        // Pages are serialized as they end, so only their serialized form is kept around.
+        SkSerialProcs procs = fProcs;
+        procs.fTypefaceProc = [](SkTypeface* typeface, void* ctx) {
+            return static_cast<MultiPictureDocument*>(ctx)->typefaceIndex(typeface);
+        };
+        procs.fTypefaceCtx = this;
+        fPages.push_back(lastPage->serialize(&procs));
+    }
+    sk_sp<SkData> typefaceIndex(SkTypeface* typeface) {
+        uint32_t index;
+        if (const uint32_t* found = fTypefaceIndices.find(typeface->uniqueID())) {
+            index = *found;
+        } else {
+            index = SkToU32(fTypefaces.size());
+            fTypefaces.push_back(sk_ref_sp(typeface));
+            fTypefaceIndices.set(typeface->uniqueID(), index);
+        }
+        return SkData::MakeWithCopy(&index, sizeof(index));
     }
     void onClose(SkWStream* wStream) override {
         SkASSERT(wStream);
@@ -97,21 +135,31 @@ struct MultiPictureDocument final : public SkDocument {
         for (SkSize s : fSizes) {
             wStream->write(&s, sizeof(s));
         }
-        SkSize bigsize = join(fSizes);
-        SkCanvas* c = fPictureRecorder.beginRecording(SkRect::MakeSize(bigsize));
-        for (const sk_sp<SkPicture>& page : fPages) {
-            c->drawPicture(page);
-            // Annotations must include some data.
-            c->drawAnnotation(SkRect::MakeEmpty(), kEndPage, SkData::MakeWithCString("X"));
+        for (const sk_sp<SkData>& page : fPages) {
+            wStream->write32(SkToU32(page->size()));
         }
-        sk_sp<SkPicture> p = fPictureRecorder.finishRecordingAsPicture();
-        p->serialize(wStream, &fProcs);
-        fPages.clear();
-        fSizes.clear();
+        TArray<sk_sp<SkData>> typefaces;
+        typefaces.reserve_exact(fTypefaces.size());
+        for (const sk_sp<SkTypeface>& typeface : fTypefaces) {
+            typefaces.push_back(serialize_typeface(typeface.get(), fProcs));
+        }
+        wStream->write32(SkToU32(typefaces.size()));
+        for (const sk_sp<SkData>& typeface : typefaces) {
+            wStream->write32(SkToU32(typeface->size()));
+        }
+        for (const sk_sp<SkData>& typeface : typefaces) {
+            wStream->write(typeface->data(), typeface->size());
+        }
+        for (const sk_sp<SkData>& page : fPages) {
+            wStream->write(page->data(), page->size());
+        }
+        this->onAbort();
     }
     void onAbort() override {
         fPages.clear();
         fSizes.clear();
+        fTypefaces.clear();
+        fTypefaceIndices.reset();
     }
 };
 
@@ -153,7 +201,8 @@ sk_sp<SkDocument> Make(SkWStream* dst,
     return sk_make_sp<MultiPictureDocument>(dst, procs, std::move(onEndPage));
 }
 
-int ReadPageCount(SkStreamSeekable* src) {
+// Leaves the stream just past the page count, and sets the document's version.
+static int read_page_count(SkStreamSeekable* src, uint32_t* version) {
     if (!src) {
         return 0;
     }
@@ -161,28 +210,33 @@ int ReadPageCount(SkStreamSeekable* src) {
     const size_t size = sizeof(kMagic) - 1;
     char buffer[size];
     if (size != src->read(buffer, size) || 0 != memcmp(kMagic, buffer, size)) {
-        src = nullptr;
         return 0;
     }
-    uint32_t versionNumber;
-    if (!src->readU32(&versionNumber) || versionNumber != kVersion) {
+    if (!src->readU32(version) || (*version != kVersion && *version != kUnindexedVersion)) {
         return 0;
     }
     uint32_t pageCount;
     if (!src->readU32(&pageCount) || pageCount > INT_MAX) {
         return 0;
     }
-    // leave stream position right here.
     return SkTo<int>(pageCount);
 }
 
-bool ReadPageSizes(SkStreamSeekable* stream,
-                   SkDocumentPage* dstArray,
-                   int dstArrayCount) {
+int ReadPageCount(SkStreamSeekable* src) {
+    uint32_t version;
+    // leave stream position right here.
+    return read_page_count(src, &version);
+}
+
+// Leaves the stream just past the page sizes, and sets the document's version.
+static bool read_page_sizes(SkStreamSeekable* stream,
+                            SkDocumentPage* dstArray,
+                            int dstArrayCount,
+                            uint32_t* version) {
     if (!dstArray || dstArrayCount < 1) {
         return false;
     }
-    int pageCount = ReadPageCount(stream);
+    int pageCount = read_page_count(stream, version);
     if (pageCount < 1 || pageCount != dstArrayCount) {
         return false;
     }
@@ -192,17 +246,181 @@ bool ReadPageSizes(SkStreamSeekable* stream,
             return false;
         }
     }
-    // leave stream position right here.
     return true;
 }
 
-bool Read(SkStreamSeekable* src,
-          SkDocumentPage* dstArray,
-          int dstArrayCount,
-          const SkDeserialProcs* procs) {
-    if (!ReadPageSizes(src, dstArray, dstArrayCount)) {
-        return false;
+bool ReadPageSizes(SkStreamSeekable* stream,
+                   SkDocumentPage* dstArray,
+                   int dstArrayCount) {
+    uint32_t version;
+    // leave stream position right here.
+    return read_page_sizes(stream, dstArray, dstArrayCount, &version);
+}
+
+namespace {
+class IndexedReader final : public Reader {
+public:
+    // The stream must be just past the page count.
+    static std::unique_ptr<Reader> Make(SkStreamSeekable* src,
+                                        int pageCount,
+                                        const SkDeserialProcs* procs) {
+        std::unique_ptr<IndexedReader> reader(new IndexedReader(src, procs));
+        // Don't trust the counts in the header with large allocations before checking them
+        // against the stream's length, where we know it.
+        auto fits = [src](size_t count, size_t bytesEach) {
+            return !src->hasLength() ||
+                   count <= (src->getLength() - std::min(src->getLength(), src->getPosition())) /
+                                    bytesEach;
+        };
+        if (!fits(pageCount, sizeof(SkSize) + sizeof(uint32_t))) {
+            return nullptr;
+        }
+        reader->fPages.resize(pageCount);
+        for (Page& page : reader->fPages) {
+            if (sizeof(page.fSize) != src->read(&page.fSize, sizeof(page.fSize))) {
+                return nullptr;
+            }
+        }
+        for (Page& page : reader->fPages) {
+            if (!src->readU32(&page.fLength)) {
+                return nullptr;
+            }
+        }
+        uint32_t typefaceCount;
+        if (!src->readU32(&typefaceCount) || !fits(typefaceCount, sizeof(uint32_t))) {
+            return nullptr;
+        }
+        reader->fTypefaces.resize(typefaceCount);
+        for (Typeface& typeface : reader->fTypefaces) {
+            if (!src->readU32(&typeface.fLength)) {
+                return nullptr;
+            }
+        }
+
+        // The typefaces and then the pages follow the index, in order.
+        SkSafeMath safe;
+        size_t offset = src->getPosition();
+        for (Typeface& typeface : reader->fTypefaces) {
+            typeface.fOffset = offset;
+            offset = safe.add(offset, typeface.fLength);
+        }
+        for (Page& page : reader->fPages) {
+            page.fOffset = offset;
+            offset = safe.add(offset, page.fLength);
+        }
+        if (!safe || (src->hasLength() && offset > src->getLength())) {
+            return nullptr;
+        }
+        return reader;
+    }
+
+    int pageCount() const override { return fPages.size(); }
+
+    SkSize pageSize(int index) const override {
+        return index >= 0 && index < fPages.size() ? fPages[index].fSize : SkSize{0, 0};
+    }
+
+    sk_sp<SkPicture> readPage(int index) override {
+        if (index < 0 || index >= fPages.size()) {
+            return nullptr;
+        }
+        const Page& page = fPages[index];
+        if (!fStream->seek(page.fOffset)) {
+            return nullptr;
+        }
+        sk_sp<SkData> data = SkData::MakeFromStream(fStream, page.fLength);
+        if (!data) {
+            return nullptr;
+        }
+        SkDeserialProcs procs = fProcs;
+        procs.fTypefaceProc = [](const void* data, size_t length, void* ctx) -> sk_sp<SkTypeface> {
+            // Pictures pass typeface procs the stream to read from, rather than the data itself.
+            SkASSERT(length == sizeof(SkStream*));
+            SkStream* stream = *static_cast<SkStream* const*>(data);
+            uint32_t index;
+            if (!stream->readU32(&index)) {
+                return nullptr;
+            }
+            return static_cast<IndexedReader*>(ctx)->typeface(index);
+        };
+        procs.fTypefaceCtx = this;
+        return SkPicture::MakeFromData(data.get(), &procs);
+    }
+
+private:
+    struct Page {
+        SkSize   fSize;
+        uint32_t fLength;
+        size_t   fOffset;
+    };
+    struct Typeface {
+        uint32_t          fLength;
+        size_t            fOffset;
+        bool              fRead = false;
+        sk_sp<SkTypeface> fTypeface;
+    };
+
+    IndexedReader(SkStreamSeekable* src, const SkDeserialProcs* procs)
+            : fStream(src), fProcs(procs ? *procs : SkDeserialProcs()) {}
+
+    // Only called while a page is being deserialized, from its own copy of the page's data, so
+    // the stream is free to move.
+    sk_sp<SkTypeface> typeface(uint32_t index) {
+        if (index >= SkToU32(fTypefaces.size())) {
+            return nullptr;
+        }
+        Typeface& typeface = fTypefaces[index];
+        if (!typeface.fRead) {
+            typeface.fRead = true;
+            sk_sp<SkData> data;
+            if (fStream->seek(typeface.fOffset)) {
+                data = SkData::MakeFromStream(fStream, typeface.fLength);
+            }
+            if (data) {
+                SkMemoryStream stream(std::move(data));
+                if (fProcs.fTypefaceProc) {
+                    // Like SkPictureData, pass the proc the stream rather than the data.
+                    SkStream* streamPtr = &stream;
+                    typeface.fTypeface = fProcs.fTypefaceProc(&streamPtr, sizeof(streamPtr),
+                                                              fProcs.fTypefaceCtx);
+                } else {
+                    typeface.fTypeface = SkTypeface::MakeDeserialize(&stream, nullptr);
+                }
+            }
+        }
+        return typeface.fTypeface;
+    }
+
+    SkStreamSeekable*       fStream;
+    const SkDeserialProcs   fProcs;
+    TArray<Page, true>      fPages;
+    TArray<Typeface>        fTypefaces;
+};
+
+// Version 2 documents can't be read a page at a time, so this reads them all at once.
+class UnindexedReader final : public Reader {
+public:
+    explicit UnindexedReader(TArray<SkDocumentPage> pages) : fPages(std::move(pages)) {}
+
+    int pageCount() const override { return fPages.size(); }
+
+    SkSize pageSize(int index) const override {
+        return index >= 0 && index < fPages.size() ? fPages[index].fSize : SkSize{0, 0};
     }
+
+    sk_sp<SkPicture> readPage(int index) override {
+        return index >= 0 && index < fPages.size() ? fPages[index].fPicture : nullptr;
+    }
+
+private:
+    TArray<SkDocumentPage> fPages;
+};
+}  // namespace
+
+static bool read_unindexed(SkStreamSeekable* src,
+                           SkDocumentPage* dstArray,
+                           int dstArrayCount,
+                           const SkDeserialProcs* procs) {
     SkSize joined = {0.0f, 0.0f};
     for (int i = 0; i < dstArrayCount; ++i) {
         joined = SkSize{std::max(joined.width(), dstArray[i].fSize.width()),
@@ -224,4 +442,46 @@ bool Read(SkStreamSeekable* src,
     }
     return true;
 }
+
+std::unique_ptr<Reader> Reader::Make(SkStreamSeekable* src, const SkDeserialProcs* procs) {
+    uint32_t version;
+    const int pageCount = read_page_count(src, &version);
+    if (pageCount < 1) {
+        return nullptr;
+    }
+    if (version == kVersion) {
+        return IndexedReader::Make(src, pageCount, procs);
+    }
+    TArray<SkDocumentPage> pages(pageCount);
+    pages.resize(pageCount);
+    if (!read_page_sizes(src, pages.data(), pageCount, &version) ||
+        !read_unindexed(src, pages.data(), pageCount, procs)) {
+        return nullptr;
+    }
+    return std::make_unique<UnindexedReader>(std::move(pages));
+}
+
+bool Read(SkStreamSeekable* src,
+          SkDocumentPage* dstArray,
+          int dstArrayCount,
+          const SkDeserialProcs* procs) {
+    uint32_t version;
+    if (!read_page_sizes(src, dstArray, dstArrayCount, &version)) {
+        return false;
+    }
+    if (version == kUnindexedVersion) {
+        return read_unindexed(src, dstArray, dstArrayCount, procs);
+    }
+    std::unique_ptr<Reader> reader = Reader::Make(src, procs);
+    if (!reader) {
+        return false;
+    }
+    for (int i = 0; i < dstArrayCount; ++i) {
+        dstArray[i].fPicture = reader->readPage(i);
+        if (!dstArray[i].fPicture) {
+            return false;
+        }
+    }
+    return true;
+}
 }  // namespace SkMultiPictureDocument
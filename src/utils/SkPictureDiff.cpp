@@ -0,0 +1,441 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/utils/SkPictureDiff.h"
+
+#include "include/core/SkBBHFactory.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkM44.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkPath.h"
+#include "include/core/SkPicture.h"
+#include "include/core/SkRRect.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkSamplingOptions.h"
+#include "include/core/SkTextBlob.h"
+#include "include/private/base/SkTArray.h"
+#include "src/core/SkBigPicture.h"
+#include "src/core/SkChecksum.h"
+#include "src/core/SkPathPriv.h"
+#include "src/core/SkPicturePriv.h"
+#include "src/core/SkRecord.h"
+#include "src/core/SkRecordDraw.h"
+#include "src/core/SkRecords.h"
+#include "src/core/SkTHash.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+using namespace SkRecords;
+
+namespace {
+
+// One op that can change pixels. Ops are matched by 'key', which covers their content, bounds and
+// drawing state. Ops that can't be compared have no key and never match.
+struct DiffOp {
+    uint64_t key;
+    bool     comparable;
+    SkRect   bounds;
+};
+
+class KeyWriter {
+public:
+    template <typename T>
+    void write(const T& value) {
+        static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>);
+        this->writeBytes(&value, sizeof(value));
+    }
+
+    void writeBytes(const void* data, size_t bytes) {
+        size_t offset = fBytes.size();
+        fBytes.resize(offset + bytes);
+        memcpy(fBytes.data() + offset, data, bytes);
+    }
+
+    void writeRect(const SkRect& r) { this->writeBytes(&r, sizeof(SkRect)); }
+
+    void writeRRect(const SkRRect& rr) {
+        char storage[SkRRect::kSizeInMemory];
+        this->writeBytes(storage, rr.writeToMemory(storage));
+    }
+
+    void writeM44(const SkM44& m) {
+        SkScalar values[16];
+        m.getColMajor(values);
+        this->writeBytes(values, sizeof(values));
+    }
+
+    void writePath(const SkPath& path) {
+        this->write(path.getFillType());
+        this->write(path.countVerbs());
+        this->writeBytes(SkPathPriv::VerbData(path), path.countVerbs());
+        this->writeBytes(SkPathPriv::PointData(path), path.countPoints() * sizeof(SkPoint));
+        this->writeBytes(SkPathPriv::ConicWeightData(path),
+                         SkPathPriv::ConicWeightCnt(path) * sizeof(SkScalar));
+    }
+
+    void writePaint(const SkPaint& paint) {
+        this->write(paint.getColor4f().fR);
+        this->write(paint.getColor4f().fG);
+        this->write(paint.getColor4f().fB);
+        this->write(paint.getColor4f().fA);
+        this->write(paint.getStyle());
+        this->write(paint.getStrokeWidth());
+        this->write(paint.getStrokeMiter());
+        this->write(paint.getStrokeCap());
+        this->write(paint.getStrokeJoin());
+        this->write(paint.isAntiAlias());
+        this->write(paint.isDither());
+        // Effects are immutable, and the pictures keep them alive, so identity implies equality.
+        this->write(paint.getShader());
+        this->write(paint.getColorFilter());
+        this->write(paint.getMaskFilter());
+        this->write(paint.getPathEffect());
+        this->write(paint.getImageFilter());
+        this->write(paint.getBlender());
+    }
+
+    void writePaint(const Optional<SkPaint>& paint) {
+        this->write(SkToBool(paint));
+        if (paint) {
+            this->writePaint(*paint);
+        }
+    }
+
+    void writeSampling(const SkSamplingOptions& sampling) {
+        this->write(sampling.maxAniso);
+        this->write(sampling.useCubic);
+        this->write(sampling.cubic.B);
+        this->write(sampling.cubic.C);
+        this->write(sampling.filter);
+        this->write(sampling.mipmap);
+    }
+
+    void writeImage(const SkImage* image) { this->write(image->uniqueID()); }
+
+    uint64_t hash() const { return SkChecksum::Hash64(fBytes.data(), fBytes.size()); }
+
+private:
+    std::vector<uint8_t> fBytes;
+};
+
+// Visits a record's ops, turning every op that can change pixels into a DiffOp.
+class DiffOpBuilder {
+public:
+    DiffOpBuilder(const SkRect& cullRect, const SkRect bounds[], std::vector<DiffOp>* ops)
+            : fCullRect(cullRect), fBounds(bounds), fOps(ops) {}
+
+    void setCurrentOp(int index) { fCurrentOp = index; }
+
+    // State ops. Their effect is folded into the keys of the draws they apply to.
+    void operator()(const NoOp&) {}
+    void operator()(const Save&) { fStack.push_back(fState); }
+    void operator()(const Restore&) {
+        if (!fStack.empty()) {
+            fState = fStack.back();
+            fStack.pop_back();
+        }
+    }
+    void operator()(const SetMatrix& op) { fState.ctm = SkM44(op.matrix); }
+    void operator()(const SetM44& op)    { fState.ctm = op.matrix; }
+    void operator()(const Concat& op)    { fState.ctm.preConcat(SkM44(op.matrix)); }
+    void operator()(const Concat44& op)  { fState.ctm.preConcat(op.matrix); }
+    void operator()(const Translate& op) { fState.ctm.preTranslate(op.dx, op.dy); }
+    void operator()(const Scale& op)     { fState.ctm.preScale(op.sx, op.sy); }
+
+    void operator()(const ClipRect& op) {
+        this->updateClip(op, [&](KeyWriter* w) { w->writeRect(op.rect); w->write(op.opAA.op());
+                                                 w->write(op.opAA.aa()); });
+    }
+    void operator()(const ClipRRect& op) {
+        this->updateClip(op, [&](KeyWriter* w) { w->writeRRect(op.rrect); w->write(op.opAA.op());
+                                                 w->write(op.opAA.aa()); });
+    }
+    void operator()(const ClipPath& op) {
+        this->updateClip(op, [&](KeyWriter* w) { w->writePath(op.path); w->write(op.opAA.op());
+                                                 w->write(op.opAA.aa()); });
+    }
+    void operator()(const ClipRegion& op) {
+        this->updateClip(op, [&](KeyWriter* w) {
+            std::unique_ptr<char[]> storage(new char[op.region.writeToMemory(nullptr)]);
+            w->writeBytes(storage.get(), op.region.writeToMemory(storage.get()));
+            w->write(op.op);
+        });
+    }
+    void operator()(const ClipShader& op) {
+        this->updateClip(op, [&](KeyWriter* w) { w->write(op.shader.get()); w->write(op.op); });
+    }
+    void operator()(const ResetClip&) { fState.clip = 0; }
+
+    void operator()(const SaveLayer& op) {
+        // A backdrop reads what was drawn beneath it, which may have changed anywhere, and its
+        // result can cover the whole clip regardless of what the layer draws.
+        const bool comparable = !op.backdrop;
+        uint64_t key = this->addOp(op, comparable, [&](KeyWriter* w) {
+            w->write(SkToBool(op.bounds));
+            if (op.bounds) {
+                w->writeRect(*op.bounds);
+            }
+            w->writePaint(op.paint);
+            w->write(op.saveLayerFlags);
+            w->write(op.backdropScale);
+            w->write(op.filters.size());
+            for (size_t i = 0; i < op.filters.size(); ++i) {
+                w->write(op.filters[i].get());
+            }
+        });
+        fStack.push_back(fState);
+        // Everything drawn into the layer depends on how the layer is composited. Draws into a
+        // backdrop layer may match, but the layer already damages the whole cull rect.
+        fState.layer = key;
+    }
+
+    // Draws with content we can compare.
+    void operator()(const DrawPaint& op) {
+        this->addOp(op, true, [&](KeyWriter* w) { w->writePaint(op.paint); });
+    }
+    void operator()(const DrawRect& op) {
+        this->addOp(op, true, [&](KeyWriter* w) { w->writePaint(op.paint);
+                                                  w->writeRect(op.rect); });
+    }
+    void operator()(const DrawOval& op) {
+        this->addOp(op, true, [&](KeyWriter* w) { w->writePaint(op.paint);
+                                                  w->writeRect(op.oval); });
+    }
+    void operator()(const DrawArc& op) {
+        this->addOp(op, true, [&](KeyWriter* w) {
+            w->writePaint(op.paint);
+            w->writeRect(op.oval);
+            w->write(op.startAngle);
+            w->write(op.sweepAngle);
+            w->write(op.useCenter);
+        });
+    }
+    void operator()(const DrawRRect& op) {
+        this->addOp(op, true, [&](KeyWriter* w) { w->writePaint(op.paint);
+                                                  w->writeRRect(op.rrect); });
+    }
+    void operator()(const DrawDRRect& op) {
+        this->addOp(op, true, [&](KeyWriter* w) {
+            w->writePaint(op.paint);
+            w->writeRRect(op.outer);
+            w->writeRRect(op.inner);
+        });
+    }
+    void operator()(const DrawPath& op) {
+        this->addOp(op, true, [&](KeyWriter* w) { w->writePaint(op.paint);
+                                                  w->writePath(op.path); });
+    }
+    void operator()(const DrawRegion& op) {
+        this->addOp(op, true, [&](KeyWriter* w) {
+            w->writePaint(op.paint);
+            std::unique_ptr<char[]> storage(new char[op.region.writeToMemory(nullptr)]);
+            w->writeBytes(storage.get(), op.region.writeToMemory(storage.get()));
+        });
+    }
+    void operator()(const DrawPoints& op) {
+        this->addOp(op, true, [&](KeyWriter* w) {
+            w->writePaint(op.paint);
+            w->write(op.mode);
+            w->write(op.count);
+            w->writeBytes(op.pts, op.count * sizeof(SkPoint));
+        });
+    }
+    void operator()(const DrawImage& op) {
+        this->addOp(op, true, [&](KeyWriter* w) {
+            w->writePaint(op.paint);
+            w->writeImage(op.image.get());
+            w->write(op.left);
+            w->write(op.top);
+            w->writeSampling(op.sampling);
+        });
+    }
+    void operator()(const DrawImageRect& op) {
+        this->addOp(op, true, [&](KeyWriter* w) {
+            w->writePaint(op.paint);
+            w->writeImage(op.image.get());
+            w->writeRect(op.src);
+            w->writeRect(op.dst);
+            w->writeSampling(op.sampling);
+            w->write(op.constraint);
+        });
+    }
+    void operator()(const DrawTextBlob& op) {
+        this->addOp(op, true, [&](KeyWriter* w) {
+            w->writePaint(op.paint);
+            w->write(op.blob->uniqueID());
+            w->write(op.x);
+            w->write(op.y);
+        });
+    }
+    void operator()(const DrawPicture& op) {
+        this->addOp(op, true, [&](KeyWriter* w) {
+            w->writePaint(op.paint);
+            w->write(op.picture->uniqueID());
+            SkScalar matrix[9];
+            op.matrix.get9(matrix);
+            w->writeBytes(matrix, sizeof(matrix));
+        });
+    }
+
+    // Everything else that draws is never matched; ops that don't draw are ignored.
+    template <typename T>
+    void operator()(const T& op) {
+        if (T::kTags & kDraw_Tag || std::is_same_v<T, SaveBehind>) {
+            this->addOp(op, false, [](KeyWriter*) {});
+        }
+        if constexpr (std::is_same_v<T, SaveBehind>) {
+            fStack.push_back(fState);
+        }
+    }
+
+private:
+    struct State {
+        SkM44    ctm;
+        uint64_t clip  = 0;
+        uint64_t layer = 0;
+    };
+
+    template <typename T, typename Fn>
+    void updateClip(const T&, Fn&& writeClip) {
+        KeyWriter w;
+        w.write(T::kType);
+        w.write(fState.clip);
+        w.writeM44(fState.ctm);
+        writeClip(&w);
+        fState.clip = w.hash();
+    }
+
+    template <typename T, typename Fn>
+    uint64_t addOp(const T& op, bool comparable, Fn&& writeContent) {
+        SkRect bounds = fBounds[fCurrentOp];
+        if constexpr (std::is_same_v<T, SaveLayer>) {
+            if (op.backdrop) {
+                bounds = fCullRect;
+            }
+        }
+        if (bounds.isEmpty()) {
+            return 0;
+        }
+        uint64_t key = 0;
+        if (comparable) {
+            KeyWriter w;
+            w.write(T::kType);
+            w.writeM44(fState.ctm);
+            w.write(fState.clip);
+            w.write(fState.layer);
+            w.writeRect(bounds);
+            writeContent(&w);
+            key = w.hash();
+        }
+        fOps->push_back({key, comparable, bounds});
+        return key;
+    }
+
+    const SkRect         fCullRect;
+    const SkRect*        fBounds;
+    std::vector<DiffOp>* fOps;
+    int                  fCurrentOp = 0;
+    State                fState;
+    std::vector<State>   fStack;
+};
+
+// Returns false if the picture has no record to diff (e.g. it holds a single draw).
+bool build_ops(const SkPicture& picture, std::vector<DiffOp>* ops) {
+    const SkBigPicture* big = SkPicturePriv::AsSkBigPicture(sk_ref_sp(&picture));
+    if (!big) {
+        return false;
+    }
+    const SkRecord& record = *big->record();
+    std::unique_ptr<SkRect[]> bounds(new SkRect[record.count()]);
+    std::unique_ptr<SkBBoxHierarchy::Metadata[]> meta(
+            new SkBBoxHierarchy::Metadata[record.count()]);
+    SkRecordFillBounds(big->cullRect(), record, bounds.get(), meta.get());
+
+    DiffOpBuilder builder(big->cullRect(), bounds.get(), ops);
+    for (int i = 0; i < record.count(); ++i) {
+        builder.setCurrentOp(i);
+        record.visit(i, builder);
+    }
+    return true;
+}
+
+}  // namespace
+
+SkRegion SkPictureDiff::Damage(const SkPicture& before, const SkPicture& after) {
+    if (before.uniqueID() == after.uniqueID()) {
+        return SkRegion();
+    }
+
+    std::vector<DiffOp> beforeOps, afterOps;
+    if (!build_ops(before, &beforeOps) || !build_ops(after, &afterOps)) {
+        SkRegion damage(before.cullRect().roundOut());
+        damage.op(after.cullRect().roundOut(), SkRegion::kUnion_Op);
+        return damage;
+    }
+
+    // The indices of each key's ops in 'before', in draw order.
+    skia_private::THashMap<uint64_t, skia_private::TArray<int>> beforeIndices;
+    for (int i = 0; i < (int)beforeOps.size(); ++i) {
+        if (beforeOps[i].comparable) {
+            if (skia_private::TArray<int>* indices = beforeIndices.find(beforeOps[i].key)) {
+                indices->push_back(i);
+            } else {
+                beforeIndices.set(beforeOps[i].key, skia_private::TArray<int>{i});
+            }
+        }
+    }
+
+    // The first op in 'before' with 'key' that comes after 'lastMatched', or -1.
+    auto next_match = [&](const DiffOp& op, int lastMatched) {
+        if (!op.comparable) {
+            return -1;
+        }
+        const skia_private::TArray<int>* indices = beforeIndices.find(op.key);
+        if (!indices) {
+            return -1;
+        }
+        auto it = std::upper_bound(indices->begin(), indices->end(), lastMatched);
+        return it == indices->end() ? -1 : *it;
+    };
+
+    // Match greedily, keeping matched ops in the same relative order so that the ops covering
+    // any undamaged pixel are drawn in the same sequence in both pictures. An op that would skip
+    // ahead past the next op's match is treated as moved rather than matched.
+    std::vector<bool> beforeMatched(beforeOps.size(), false);
+    std::vector<SkIRect> damage;
+    int lastMatched = -1;
+    for (size_t i = 0; i < afterOps.size(); ++i) {
+        int match = next_match(afterOps[i], lastMatched);
+        if (match > lastMatched + 1 && i + 1 < afterOps.size()) {
+            int nextMatch = next_match(afterOps[i + 1], lastMatched);
+            if (nextMatch >= 0 && nextMatch < match) {
+                match = -1;
+            }
+        }
+        if (match >= 0) {
+            beforeMatched[match] = true;
+            lastMatched = match;
+        } else {
+            damage.push_back(afterOps[i].bounds.roundOut());
+        }
+    }
+    for (size_t i = 0; i < beforeOps.size(); ++i) {
+        if (!beforeMatched[i]) {
+            damage.push_back(beforeOps[i].bounds.roundOut());
+        }
+    }
+
+    SkRegion region;
+    for (const SkIRect& r : damage) {
+        region.op(r, SkRegion::kUnion_Op);
+    }
+    return region;
+}
@@ -0,0 +1,150 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/utils/SkPictureStream.h"
+
+#include "include/core/SkCanvas.h"
+#include "include/core/SkStream.h"
+#include "src/core/SkPictureData.h"
+#include "src/core/SkPicturePlayback.h"
+#include "src/core/SkPicturePriv.h"
+#include "src/core/SkPictureRecord.h"
+#include "src/core/SkRecord.h"
+#include "src/core/SkRecordDraw.h"
+#include "src/core/SkRecorder.h"
+#include "src/core/SkRecords.h"
+
+#include <algorithm>
+#include <utility>
+
+// How deeply pictures may nest inside a chunk.
+static constexpr int kRecursionLimit = 100;
+
+namespace {
+// How an op changes the number of open saves.
+struct SaveDelta {
+    template <typename T> int operator()(const T&) { return 0; }
+    int operator()(const SkRecords::Save&) { return 1; }
+    int operator()(const SkRecords::SaveLayer&) { return 1; }
+    int operator()(const SkRecords::SaveBehind&) { return 1; }
+    int operator()(const SkRecords::Restore&) { return -1; }
+};
+}  // namespace
+
+SkPictureStreamWriter::SkPictureStreamWriter(const SkRect& bounds, ChunkProc chunkProc,
+                                             const SkSerialProcs* procs, int opsPerChunk)
+        : fBounds(bounds)
+        , fChunkProc(std::move(chunkProc))
+        , fProcs(procs ? *procs : SkSerialProcs())
+        , fOpsPerChunk(std::max(opsPerChunk, 1))
+        , fRecord(sk_make_sp<SkRecord>())
+        , fRecorder(std::make_unique<SkRecorder>(fRecord.get(), bounds)) {
+    fRecorder->setWillAppendProc(WillAppend, this);
+}
+
+SkPictureStreamWriter::~SkPictureStreamWriter() {
+    this->finish();
+}
+
+SkCanvas* SkPictureStreamWriter::getCanvas() {
+    return fRecorder.get();
+}
+
+void SkPictureStreamWriter::WillAppend(void* ctx) {
+    auto* writer = static_cast<SkPictureStreamWriter*>(ctx);
+    // This is called in the middle of drawing an op, so the ops written so far stay in fRecord
+    // until flush() or finish() can start a new one.
+    if (writer->fRecord->count() - writer->fWrittenOps >= writer->fOpsPerChunk) {
+        writer->writeChunk();
+    }
+}
+
+void SkPictureStreamWriter::flush() {
+    if (!fRecorder) {
+        return;
+    }
+    this->writeChunk();
+    // Free the written ops. The recorder keeps its matrix, clip and saves.
+    fRecord = sk_make_sp<SkRecord>();
+    fRecorder->setRecord(fRecord.get());
+    fWrittenOps = 0;
+}
+
+void SkPictureStreamWriter::finish() {
+    if (!fRecorder) {
+        return;
+    }
+    this->writeChunk();
+    fRecorder->forgetRecord();
+    fRecorder.reset();
+    fRecord.reset();
+}
+
+void SkPictureStreamWriter::writeChunk() {
+    const int count = fRecord->count();
+    if (count == fWrittenOps) {
+        return;
+    }
+
+    // Record the ops as a picture's ops, continuing inside the saves left open by earlier chunks.
+    const SkPictInfo info = SkPicturePriv::MakeHeader(fBounds);
+    SkPictureRecord record(info.fCullRect.roundOut(), 0/*flags*/);
+    record.beginContinuation(fOpenSaves);
+    const SkDrawableList* drawables = fRecorder->getDrawableList();
+    const SkM44 identity;
+    SkRecords::Draw draw(&record, nullptr, drawables ? drawables->begin() : nullptr,
+                         drawables ? drawables->count() : 0, &identity);
+    for (int i = fWrittenOps; i < count; ++i) {
+        fOpenSaves = std::max(fOpenSaves + fRecord->visit(i, SaveDelta()), 0);
+        fRecord->visit(i, draw);
+    }
+    fWrittenOps = count;
+
+    SkDynamicMemoryWStream stream;
+    stream.write(&info, sizeof(info));
+    SkPictureData(record, info).serialize(&stream, fProcs, nullptr);
+    fChunkProc(stream.detachAsData());
+}
+
+SkPictureStreamReader::SkPictureStreamReader(const SkDeserialProcs* procs)
+        : fProcs(procs ? *procs : SkDeserialProcs()) {}
+
+bool SkPictureStreamReader::playChunk(const void* data, size_t size, SkCanvas* canvas) {
+    if (fFailed) {
+        return false;
+    }
+    SkMemoryStream stream(data, size);
+    SkPictInfo info;
+    std::unique_ptr<SkPictureData> pictureData;
+    if (SkPicture_StreamIsSKP(&stream, &info)) {
+        pictureData.reset(SkPictureData::CreateFromStream(&stream, info, fProcs, nullptr,
+                                                          kRecursionLimit));
+    }
+    if (!pictureData) {
+        fFailed = true;
+        return false;
+    }
+
+    if (!fStarted) {
+        // Like a picture's playback, the stream's ops are drawn inside a save.
+        fStarted = true;
+        fSaveCount = canvas->save();
+        fInitialMatrix = canvas->getLocalToDevice();
+    }
+    SkPicturePlayback playback(pictureData.get());
+    if (!playback.drawContinuation(canvas, fInitialMatrix, fSaveCount + 1)) {
+        fFailed = true;
+    }
+    return !fFailed;
+}
+
+void SkPictureStreamReader::finish(SkCanvas* canvas) {
+    if (fStarted) {
+        canvas->restoreToCount(fSaveCount);
+        fStarted = false;
+    }
+}
@@ -0,0 +1,231 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/utils/SkPrefetchingStream.h"
+
+#include "include/core/SkExecutor.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+// fetch() publishes what it has read at least this often, so a consumer of a large window does
+// not wait for the whole window to fill.
+static constexpr size_t kMaxFetchSize = 64 * 1024;
+
+std::unique_ptr<SkPrefetchingStream> SkPrefetchingStream::Make(std::unique_ptr<SkStream> source,
+                                                               SkExecutor* executor,
+                                                               size_t windowSize) {
+    if (!source) {
+        return nullptr;
+    }
+    std::unique_ptr<SkPrefetchingStream> stream(
+            new SkPrefetchingStream(std::move(source), executor, std::max<size_t>(windowSize, 1)));
+    bool post;
+    {
+        SkAutoMutexExclusive lock(stream->fMutex);
+        post = stream->startFetchIfNeeded();
+    }
+    if (post) {
+        stream->postFetch();
+    }
+    return stream;
+}
+
+SkPrefetchingStream::SkPrefetchingStream(std::unique_ptr<SkStream> source,
+                                         SkExecutor* executor,
+                                         size_t windowSize)
+        : fExecutor(executor ? *executor : SkExecutor::GetDefault())
+        , fSource(std::move(source))
+        , fWindowSize(windowSize)
+        , fHasLength(fSource->hasLength())
+        , fLength(fHasLength ? fSource->getLength() : 0)
+        , fBuffer(windowSize) {}
+
+SkPrefetchingStream::~SkPrefetchingStream() {
+    bool waitForFetch;
+    {
+        SkAutoMutexExclusive lock(fMutex);
+        fClosing = true;
+        waitForFetch = fFetching;
+    }
+    if (waitForFetch) {
+        fFetchFinished.wait();
+    }
+}
+
+void SkPrefetchingStream::setBlocking(bool blocking) {
+    SkAutoMutexExclusive lock(fMutex);
+    fBlocking = blocking;
+}
+
+size_t SkPrefetchingStream::waitForMoreData() {
+    for (;;) {
+        uint64_t fetchedBytes;
+        bool post;
+        {
+            SkAutoMutexExclusive lock(fMutex);
+            if (fSize > 0 || fSourceDone) {
+                return fSize;
+            }
+            post = this->startFetchIfNeeded();
+            fetchedBytes = fFetchedBytes;
+        }
+        if (post) {
+            this->postFetch();
+        }
+        this->waitForFetchedBytes(fetchedBytes);
+    }
+}
+
+size_t SkPrefetchingStream::bytesBuffered() const {
+    SkAutoMutexExclusive lock(fMutex);
+    return fSize;
+}
+
+size_t SkPrefetchingStream::read(void* buffer, size_t size) {
+    size_t total = 0;
+    while (total < size) {
+        size_t n;
+        uint64_t fetchedBytes;
+        bool post;
+        {
+            SkAutoMutexExclusive lock(fMutex);
+            n = std::min(size - total, fSize);
+            if (buffer) {
+                const size_t first = std::min(n, fWindowSize - fHead);
+                auto dst = static_cast<uint8_t*>(buffer) + total;
+                memcpy(dst, fBuffer.get() + fHead, first);
+                memcpy(dst + first, fBuffer.get(), n - first);
+            }
+            fHead = (fHead + n) % fWindowSize;
+            fSize -= n;
+            fPosition += n;
+            total += n;
+
+            post = this->startFetchIfNeeded();
+            fetchedBytes = fFetchedBytes;
+            if (n == 0 && (fSourceDone || !fBlocking)) {
+                size = total;  // Nothing more to be had now; stop after posting the fetch.
+            }
+        }
+        if (post) {
+            this->postFetch();
+        }
+        if (n == 0 && total < size) {
+            this->waitForFetchedBytes(fetchedBytes);
+        }
+    }
+    return total;
+}
+
+size_t SkPrefetchingStream::peek(void* buffer, size_t size) const {
+    size = std::min(size, fWindowSize);
+    // Starting a fetch does not change what the stream holds, only how soon it arrives.
+    auto self = const_cast<SkPrefetchingStream*>(this);
+    for (;;) {
+        uint64_t fetchedBytes;
+        bool post;
+        {
+            SkAutoMutexExclusive lock(fMutex);
+            if (fSize >= size || fSourceDone) {
+                const size_t n = std::min(size, fSize);
+                const size_t first = std::min(n, fWindowSize - fHead);
+                memcpy(buffer, fBuffer.get() + fHead, first);
+                memcpy(static_cast<uint8_t*>(buffer) + first, fBuffer.get(), n - first);
+                return n;
+            }
+            post = self->startFetchIfNeeded();
+            fetchedBytes = fFetchedBytes;
+        }
+        if (post) {
+            self->postFetch();
+        }
+        this->waitForFetchedBytes(fetchedBytes);
+    }
+}
+
+bool SkPrefetchingStream::isAtEnd() const {
+    SkAutoMutexExclusive lock(fMutex);
+    return fSourceDone && fSize == 0;
+}
+
+size_t SkPrefetchingStream::getPosition() const {
+    SkAutoMutexExclusive lock(fMutex);
+    return fPosition;
+}
+
+bool SkPrefetchingStream::startFetchIfNeeded() {
+    if (fFetching || fSourceDone || fClosing || fSize == fWindowSize) {
+        return false;
+    }
+    fFetching = true;
+    return true;
+}
+
+void SkPrefetchingStream::postFetch() {
+    fExecutor.add([this] { this->fetch(); });
+}
+
+void SkPrefetchingStream::fetch() {
+    bool closing;
+    for (;;) {
+        size_t offset, space;
+        {
+            SkAutoMutexExclusive lock(fMutex);
+            if (fClosing || fSize == fWindowSize) {
+                fFetching = false;
+                closing = fClosing;
+                break;
+            }
+            offset = (fHead + fSize) % fWindowSize;
+            space = std::min({fWindowSize - fSize, fWindowSize - offset, kMaxFetchSize});
+        }
+
+        const size_t bytesRead = fSource->read(fBuffer.get() + offset, space);
+        // A source that returns nothing without being at its end would otherwise be retried
+        // forever; like SkStream's other users, treat it as exhausted.
+        const bool done = bytesRead == 0 || fSource->isAtEnd();
+
+        SkAutoMutexExclusive lock(fMutex);
+        fSize += bytesRead;
+        fFetchedBytes += bytesRead;
+        fSourceDone = done;
+        this->wakeWaiters();
+        if (done) {
+            fFetching = false;
+            closing = fClosing;
+            break;
+        }
+    }
+    // Once fFetching is false the destructor no longer waits for this fetch, so |this| may only
+    // be touched after that if the destructor is already waiting.
+    if (closing) {
+        fFetchFinished.signal();
+    }
+}
+
+void SkPrefetchingStream::waitForFetchedBytes(uint64_t fetchedBytes) const {
+    for (;;) {
+        {
+            SkAutoMutexExclusive lock(fMutex);
+            if (fFetchedBytes != fetchedBytes || fSourceDone || fSize == fWindowSize ||
+                !fFetching) {
+                return;
+            }
+            fWaiters++;
+        }
+        fFetched.wait();
+    }
+}
+
+void SkPrefetchingStream::wakeWaiters() {
+    if (fWaiters > 0) {
+        fFetched.signal(fWaiters);
+        fWaiters = 0;
+    }
+}
@@ -0,0 +1,112 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkPrefetchingStream_DEFINED
+#define SkPrefetchingStream_DEFINED
+
+#include "include/core/SkStream.h"
+#include "include/private/base/SkMutex.h"
+#include "include/private/base/SkSemaphore.h"
+#include "include/private/base/SkTemplates.h"
+#include "include/private/base/SkThreadAnnotations.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+class SkExecutor;
+
+/**
+ *  Wraps a slow, synchronously readable stream (e.g. one fed by the network) and reads ahead of
+ *  the caller on an SkExecutor, keeping up to a fixed window of bytes buffered. This lets a codec
+ *  decode what has already arrived while the next bytes are still being read.
+ *
+ *  By default read() waits for the bytes it was asked for, like any other SkStream. After
+ *  setBlocking(false), read() only returns bytes that are already buffered, so a short read
+ *  means "not yet" rather than "never" and isAtEnd() stays false until the source is really
+ *  exhausted. That is what SkCodec's incremental decoding expects: incrementalDecode() returns
+ *  kIncompleteInput, and the caller can waitForMoreData() before calling it again.
+ *
+ *  peek() always waits until it can return as many bytes as were asked for (up to the window
+ *  size), so sniffing the image format in SkCodec::MakeFromStream() sees the whole header.
+ *
+ *  The stream cannot rewind once bytes have been read.
+ */
+class SkPrefetchingStream final : public SkStream {
+public:
+    static constexpr size_t kDefaultWindowSize = 256 * 1024;
+
+    /**
+     *  |executor| runs the read-ahead; if it is null, SkExecutor::GetDefault() is used, which
+     *  typically reads on the calling thread. |windowSize| is the most that is read ahead.
+     *  Returns nullptr if |source| is null.
+     */
+    static std::unique_ptr<SkPrefetchingStream> Make(std::unique_ptr<SkStream> source,
+                                                     SkExecutor* executor,
+                                                     size_t windowSize = kDefaultWindowSize);
+
+    ~SkPrefetchingStream() override;
+
+    void setBlocking(bool blocking);
+
+    /**
+     *  Waits until at least one byte is buffered or the source is exhausted, so that a read()
+     *  which came up short can be retried. Returns the number of bytes buffered.
+     */
+    size_t waitForMoreData();
+
+    size_t bytesBuffered() const;
+
+    size_t read(void* buffer, size_t size) override;
+    size_t peek(void* buffer, size_t size) const override;
+    bool isAtEnd() const override;
+
+    bool hasPosition() const override { return true; }
+    size_t getPosition() const override;
+
+    bool hasLength() const override { return fHasLength; }
+    size_t getLength() const override { return fLength; }
+
+private:
+    SkPrefetchingStream(std::unique_ptr<SkStream>, SkExecutor*, size_t windowSize);
+
+    // Starts a read-ahead if none is running and there is room for one. Returns true if the
+    // caller should post fetch() to the executor, which must be done without holding fMutex.
+    bool startFetchIfNeeded() SK_REQUIRES(fMutex);
+    void postFetch();
+    void fetch();
+
+    // Blocks until bytes have been added to the buffer since |fetchedBytes| was read, or until
+    // nothing more will be added.
+    void waitForFetchedBytes(uint64_t fetchedBytes) const;
+    void wakeWaiters() SK_REQUIRES(fMutex);
+
+    SkExecutor&                         fExecutor;
+    const std::unique_ptr<SkStream>     fSource;  // Only touched by fetch().
+    const size_t                        fWindowSize;
+    const bool                          fHasLength;
+    const size_t                        fLength;
+
+    // A ring buffer of the bytes read ahead. fetch() reads from the source into the part outside
+    // of [fHead, fHead + fSize) without holding fMutex, so a slow source never blocks read().
+    skia_private::AutoTMalloc<uint8_t>  fBuffer;
+
+    mutable SkMutex     fMutex;
+    size_t              fHead SK_GUARDED_BY(fMutex) = 0;
+    size_t              fSize SK_GUARDED_BY(fMutex) = 0;
+    size_t              fPosition SK_GUARDED_BY(fMutex) = 0;
+    uint64_t            fFetchedBytes SK_GUARDED_BY(fMutex) = 0;
+    bool                fBlocking SK_GUARDED_BY(fMutex) = true;
+    bool                fFetching SK_GUARDED_BY(fMutex) = false;
+    bool                fSourceDone SK_GUARDED_BY(fMutex) = false;
+    bool                fClosing SK_GUARDED_BY(fMutex) = false;
+    mutable int         fWaiters SK_GUARDED_BY(fMutex) = 0;
+    mutable SkSemaphore fFetched;
+    SkSemaphore         fFetchFinished;
+};
+
+#endif
@@ -0,0 +1,497 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/utils/SkRingBufferTracer.h"
+
+#include "include/core/SkData.h"
+#include "include/core/SkStream.h"
+#include "include/private/base/SkThreadID.h"
+#include "include/utils/SkTraceEventPhase.h"
+#include "src/base/SkMathPriv.h"
+#include "src/core/SkTraceEvent.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <memory>
+
+#if defined(SK_BUILD_FOR_WIN)
+    #include "src/base/SkLeanWindows.h"
+#else
+    #include <unistd.h>
+    #if defined(__linux__)
+        #include <sys/syscall.h>
+    #elif defined(SK_BUILD_FOR_MAC) || defined(SK_BUILD_FOR_IOS)
+        #include <pthread.h>
+    #endif
+#endif
+
+namespace {
+
+// Field numbers from perfetto/protos/perfetto/trace/*.proto.
+enum : uint32_t {
+    kTrace_Packet = 1,
+
+    kTracePacket_Timestamp               = 8,
+    kTracePacket_TrustedPacketSequenceID = 10,
+    kTracePacket_TrackEvent              = 11,
+    kTracePacket_SequenceFlags           = 13,
+    kTracePacket_TrackDescriptor         = 60,
+
+    kTrackDescriptor_UUID   = 1,
+    kTrackDescriptor_Thread = 4,
+
+    kThreadDescriptor_PID = 1,
+    kThreadDescriptor_TID = 2,
+
+    kTrackEvent_Type       = 9,
+    kTrackEvent_TrackUUID  = 11,
+    kTrackEvent_Categories = 22,
+    kTrackEvent_Name       = 23,
+};
+
+enum : uint64_t {
+    kSeqIncrementalStateCleared = 1,
+
+    kTypeSliceBegin = 1,
+    kTypeSliceEnd   = 2,
+    kTypeInstant    = 3,
+};
+
+// Just enough of the protobuf wire format to write the messages above.
+class ProtoWriter {
+public:
+    void varint(uint32_t field, uint64_t value) {
+        this->writeVarint(field << 3);
+        this->writeVarint(value);
+    }
+
+    void bytes(uint32_t field, const void* data, size_t size) {
+        this->writeVarint((field << 3) | 2);
+        this->writeVarint(size);
+        fBytes.insert(fBytes.end(), (const uint8_t*)data, (const uint8_t*)data + size);
+    }
+
+    void string(uint32_t field, const char* str) { this->bytes(field, str, strlen(str)); }
+
+    void message(uint32_t field, const ProtoWriter& msg) {
+        this->bytes(field, msg.fBytes.data(), msg.fBytes.size());
+    }
+
+    // Writes this message to |stream| as a field of an enclosing message.
+    void writeAsField(uint32_t field, SkWStream* stream) const {
+        ProtoWriter header;
+        header.writeVarint((field << 3) | 2);
+        header.writeVarint(fBytes.size());
+        stream->write(header.fBytes.data(), header.fBytes.size());
+        stream->write(fBytes.data(), fBytes.size());
+    }
+
+    void reset() { fBytes.clear(); }
+
+private:
+    void writeVarint(uint64_t value) {
+        while (value >= 0x80) {
+            fBytes.push_back((uint8_t)(value | 0x80));
+            value >>= 7;
+        }
+        fBytes.push_back((uint8_t)value);
+    }
+
+    std::vector<uint8_t> fBytes;
+};
+
+uint64_t now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+int32_t current_pid() {
+#if defined(SK_BUILD_FOR_WIN)
+    return (int32_t)GetCurrentProcessId();
+#else
+    return (int32_t)getpid();
+#endif
+}
+
+int32_t current_tid() {
+#if defined(SK_BUILD_FOR_WIN)
+    return (int32_t)GetCurrentThreadId();
+#elif defined(__linux__)
+    return (int32_t)syscall(SYS_gettid);
+#elif defined(SK_BUILD_FOR_MAC) || defined(SK_BUILD_FOR_IOS)
+    uint64_t tid = 0;
+    pthread_threadid_np(nullptr, &tid);
+    return (int32_t)tid;
+#else
+    return (int32_t)SkGetThreadID();
+#endif
+}
+
+bool is_disabled_by_default(const char* category) {
+    return 0 == strncmp(category, TRACE_CATEGORY_PREFIX, strlen(TRACE_CATEGORY_PREFIX));
+}
+
+static const uint8_t kNeverEnabled = 0;
+
+static std::atomic<uint32_t> gNextTracerID{1};
+
+}  // namespace
+
+// One thread's events. Only the owning thread writes; exportPerfettoTrace() reads concurrently,
+// seqlock style, and discards the slots that may have been rewritten while it was copying them.
+class SkRingBufferTracer::ThreadRing final : public SkNVRefCnt<ThreadRing> {
+public:
+    static constexpr uint64_t kOpen = ~0ull;  // A complete event whose duration isn't known yet.
+
+    struct Event {
+        std::atomic<uint64_t>    fStartNs;
+        std::atomic<uint64_t>    fDurationNs;
+        std::atomic<const char*> fName;
+        std::atomic<uint32_t>    fPhaseAndCategory;
+    };
+
+    // A copy of an Event that can be sorted and encoded at leisure.
+    struct Snapshot {
+        uint64_t    fStartNs;
+        uint64_t    fDurationNs;
+        const char* fName;
+        char        fPhase;
+        int         fCategory;
+    };
+
+    ThreadRing(size_t capacity, int index)
+            : fEvents(new Event[capacity])
+            , fMask(capacity - 1)
+            , fSequenceID(index + 1) {
+        this->claim();
+    }
+
+    // Called, under the tracer's mutex, when a thread starts recording into this ring.
+    void claim() {
+        fFirst.store(fWritten.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        fPID = current_pid();
+        fTID = current_tid();
+        fInUse.store(true, std::memory_order_relaxed);
+    }
+
+    void release() { fInUse.store(false, std::memory_order_release); }
+    bool inUse() const { return fInUse.load(std::memory_order_acquire); }
+
+    void clear() {
+        fFirst.store(fWritten.load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+
+    SkEventTracer::Handle record(char phase, int category, const char* name) {
+        const uint64_t index = fWritten.load(std::memory_order_relaxed);
+        Event& event = fEvents[index & fMask];
+
+        // Pairs with the acquire fence in snapshot(): a reader that sees any of the stores below
+        // will also see fStarted > index, and so won't trust this slot's previous event.
+        fStarted.store(index + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        event.fStartNs.store(now_ns(), std::memory_order_relaxed);
+        event.fDurationNs.store(kOpen, std::memory_order_relaxed);
+        event.fName.store(name, std::memory_order_relaxed);
+        event.fPhaseAndCategory.store((uint32_t)(uint8_t)phase | ((uint32_t)category << 8),
+                                      std::memory_order_relaxed);
+        fWritten.store(index + 1, std::memory_order_release);
+        return index + 1;
+    }
+
+    void end(SkEventTracer::Handle handle) {
+        const uint64_t index = handle - 1;
+        if (handle == 0 || fWritten.load(std::memory_order_relaxed) - index > fMask + 1) {
+            return;  // The event has already been overwritten.
+        }
+        Event& event = fEvents[index & fMask];
+        const uint64_t start = event.fStartNs.load(std::memory_order_relaxed);
+        event.fDurationNs.store(std::max<uint64_t>(now_ns() - start, 1),
+                                std::memory_order_relaxed);
+    }
+
+    std::vector<Snapshot> snapshot() const {
+        const uint64_t capacity = fMask + 1;
+        const uint64_t end = fWritten.load(std::memory_order_acquire);
+        const uint64_t begin = std::max(fFirst.load(std::memory_order_relaxed),
+                                        end > capacity ? end - capacity : 0);
+
+        std::vector<Snapshot> events;
+        events.reserve(end - begin);
+        for (uint64_t i = begin; i < end; ++i) {
+            const Event& event = fEvents[i & fMask];
+            const uint32_t phaseAndCategory =
+                    event.fPhaseAndCategory.load(std::memory_order_relaxed);
+            events.push_back({event.fStartNs.load(std::memory_order_relaxed),
+                              event.fDurationNs.load(std::memory_order_relaxed),
+                              event.fName.load(std::memory_order_relaxed),
+                              (char)(phaseAndCategory & 0xff),
+                              (int)(phaseAndCategory >> 8)});
+        }
+
+        // Slot i is rewritten by event i + capacity, so drop the events whose slots the writer
+        // has started on since we read fWritten.
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const uint64_t started = fStarted.load(std::memory_order_relaxed);
+        if (started > begin + capacity) {
+            const uint64_t overwritten = started - capacity - begin;
+            events.erase(events.begin(),
+                         events.begin() + std::min<uint64_t>(overwritten, events.size()));
+        }
+        return events;
+    }
+
+    int32_t  pid()        const { return fPID; }
+    int32_t  tid()        const { return fTID; }
+    uint32_t sequenceID() const { return fSequenceID; }
+
+private:
+    std::unique_ptr<Event[]> fEvents;
+    const uint64_t           fMask;
+    const uint32_t           fSequenceID;
+
+    std::atomic<uint64_t> fStarted{0};  // The number of events ever begun,
+    std::atomic<uint64_t> fWritten{0};  // and of those, how many are completely written.
+    std::atomic<uint64_t> fFirst{0};    // Events before this were cleared.
+    std::atomic<bool>     fInUse{false};
+
+    int32_t fPID = 0;
+    int32_t fTID = 0;
+};
+
+SkRingBufferTracer::SkRingBufferTracer(const Options& options)
+        : fEventsPerThread(SkNextPow2((int)std::clamp<size_t>(options.fEventsPerThread,
+                                                              16, 1 << 24)))
+        , fIncludeDisabledByDefault(options.fIncludeDisabledByDefault)
+        , fTracerID(gNextTracerID.fetch_add(1, std::memory_order_relaxed)) {}
+
+SkRingBufferTracer::~SkRingBufferTracer() = default;
+
+void SkRingBufferTracer::setEnabled(bool enabled) {
+    SkAutoMutexExclusive lock(fMutex);
+    fEnabled.store(enabled, std::memory_order_relaxed);
+    for (int i = 0; i < fCategoryCount; ++i) {
+        fCategoryFlags[i] = this->categoryFlags(fCategoryNames[i]);
+    }
+}
+
+uint8_t SkRingBufferTracer::categoryFlags(const char* category) const {
+    const bool record = this->isEnabled() &&
+                        (fIncludeDisabledByDefault || !is_disabled_by_default(category));
+    return record ? kEnabledForRecording_CategoryGroupEnabledFlags : 0;
+}
+
+void SkRingBufferTracer::clear() {
+    SkAutoMutexExclusive lock(fMutex);
+    for (const sk_sp<ThreadRing>& ring : fRings) {
+        ring->clear();
+    }
+}
+
+const uint8_t* SkRingBufferTracer::getCategoryGroupEnabled(const char* name) {
+    // The macros cache the result for each call site, so this is rarely called.
+    SkAutoMutexExclusive lock(fMutex);
+    for (int i = 0; i < fCategoryCount; ++i) {
+        if (0 == strcmp(name, fCategoryNames[i])) {
+            return &fCategoryFlags[i];
+        }
+    }
+    if (fCategoryCount == kMaxCategories) {
+        return &kNeverEnabled;
+    }
+
+    const int i = fCategoryCount++;
+    fCategoryNames[i] = name;
+    fCategoryFlags[i] = this->categoryFlags(name);
+    return &fCategoryFlags[i];
+}
+
+const char* SkRingBufferTracer::getCategoryGroupName(const uint8_t* categoryEnabledFlag) {
+    if (categoryEnabledFlag >= fCategoryFlags &&
+        categoryEnabledFlag < fCategoryFlags + kMaxCategories) {
+        return fCategoryNames[categoryEnabledFlag - fCategoryFlags];
+    }
+    return "";
+}
+
+SkRingBufferTracer::ThreadRing* SkRingBufferTracer::currentThreadRing() {
+    struct Slot {
+        uint32_t          fTracerID = 0;
+        sk_sp<ThreadRing> fRing;
+
+        ~Slot() {
+            if (fRing) {
+                fRing->release();
+            }
+        }
+    };
+    static thread_local Slot tSlot;
+
+    if (tSlot.fTracerID == fTracerID) {
+        return tSlot.fRing.get();
+    }
+    if (tSlot.fRing) {
+        tSlot.fRing->release();
+    }
+
+    // Reuse the ring of a thread that has exited, rather than growing without bound in programs
+    // that keep starting new threads.
+    SkAutoMutexExclusive lock(fMutex);
+    sk_sp<ThreadRing> ring;
+    for (const sk_sp<ThreadRing>& candidate : fRings) {
+        if (!candidate->inUse()) {
+            ring = candidate;
+            ring->claim();
+            break;
+        }
+    }
+    if (!ring) {
+        ring = sk_make_sp<ThreadRing>(fEventsPerThread, (int)fRings.size());
+        fRings.push_back(ring);
+    }
+
+    tSlot.fTracerID = fTracerID;
+    tSlot.fRing = std::move(ring);
+    return tSlot.fRing.get();
+}
+
+const char* SkRingBufferTracer::internName(const char* name) {
+    SkAutoMutexExclusive lock(fMutex);
+    auto found = fInternedNames.find(name);
+    if (found != fInternedNames.end()) {
+        return found->c_str();
+    }
+    if (fInternedNames.size() == kMaxInternedNames) {
+        return "(too many copied names)";
+    }
+    return fInternedNames.emplace(name).first->c_str();
+}
+
+SkEventTracer::Handle SkRingBufferTracer::addTraceEvent(char phase,
+                                                        const uint8_t* categoryEnabledFlag,
+                                                        const char* name,
+                                                        uint64_t id,
+                                                        int32_t numArgs,
+                                                        const char** argNames,
+                                                        const uint8_t* argTypes,
+                                                        const uint64_t* argValues,
+                                                        uint8_t flags) {
+    switch (phase) {
+        case TRACE_EVENT_PHASE_BEGIN:
+        case TRACE_EVENT_PHASE_END:
+        case TRACE_EVENT_PHASE_COMPLETE:
+        case TRACE_EVENT_PHASE_INSTANT:
+            break;
+        default:
+            return 0;
+    }
+    if (categoryEnabledFlag < fCategoryFlags ||
+        categoryEnabledFlag >= fCategoryFlags + kMaxCategories) {
+        return 0;
+    }
+
+    if (flags & TRACE_EVENT_FLAG_COPY) {
+        name = this->internName(name);
+    }
+    return this->currentThreadRing()->record(phase,
+                                             (int)(categoryEnabledFlag - fCategoryFlags),
+                                             name);
+}
+
+void SkRingBufferTracer::updateTraceEventDuration(const uint8_t*,
+                                                  const char*,
+                                                  SkEventTracer::Handle handle) {
+    // Complete events always end on the thread that began them.
+    this->currentThreadRing()->end(handle);
+}
+
+sk_sp<SkData> SkRingBufferTracer::exportPerfettoTrace() const {
+    // Holding the mutex keeps rings from being reused, and categories from being added, while
+    // they are read.
+    SkAutoMutexExclusive lock(fMutex);
+
+    SkDynamicMemoryWStream stream;
+    ProtoWriter packet, child, grandchild;
+    struct Slice {
+        uint64_t    fTimestamp;
+        int64_t     fOrder;  // Ends before begins at the same time, and inner slices end first.
+        uint64_t    fType;
+        const char* fName;
+        int         fCategory;
+    };
+
+    for (const sk_sp<ThreadRing>& ring : fRings) {
+        const uint64_t trackUUID = ((uint64_t)fTracerID << 32) | ring->sequenceID();
+
+        std::vector<Slice> slices;
+        int64_t order = 0;
+        for (const ThreadRing::Snapshot& event : ring->snapshot()) {
+            ++order;
+            switch (event.fPhase) {
+                case TRACE_EVENT_PHASE_BEGIN:
+                    slices.push_back({event.fStartNs, order, kTypeSliceBegin,
+                                      event.fName, event.fCategory});
+                    break;
+                case TRACE_EVENT_PHASE_END:
+                    slices.push_back({event.fStartNs, -order, kTypeSliceEnd,
+                                      event.fName, event.fCategory});
+                    break;
+                case TRACE_EVENT_PHASE_INSTANT:
+                    slices.push_back({event.fStartNs, order, kTypeInstant,
+                                      event.fName, event.fCategory});
+                    break;
+                case TRACE_EVENT_PHASE_COMPLETE:
+                    slices.push_back({event.fStartNs, order, kTypeSliceBegin,
+                                      event.fName, event.fCategory});
+                    // Still open events are left unterminated.
+                    if (event.fDurationNs != ThreadRing::kOpen) {
+                        slices.push_back({event.fStartNs + event.fDurationNs, -order,
+                                          kTypeSliceEnd, event.fName, event.fCategory});
+                    }
+                    break;
+            }
+        }
+        if (slices.empty()) {
+            continue;
+        }
+        std::sort(slices.begin(), slices.end(), [](const Slice& a, const Slice& b) {
+            return a.fTimestamp != b.fTimestamp ? a.fTimestamp < b.fTimestamp
+                                                : a.fOrder < b.fOrder;
+        });
+
+        // The thread's track comes first in its sequence.
+        grandchild.reset();
+        grandchild.varint(kThreadDescriptor_PID, (uint32_t)ring->pid());
+        grandchild.varint(kThreadDescriptor_TID, (uint32_t)ring->tid());
+        child.reset();
+        child.varint(kTrackDescriptor_UUID, trackUUID);
+        child.message(kTrackDescriptor_Thread, grandchild);
+        packet.reset();
+        packet.varint(kTracePacket_TrustedPacketSequenceID, ring->sequenceID());
+        packet.varint(kTracePacket_SequenceFlags, kSeqIncrementalStateCleared);
+        packet.message(kTracePacket_TrackDescriptor, child);
+        packet.writeAsField(kTrace_Packet, &stream);
+
+        for (const Slice& slice : slices) {
+            child.reset();
+            child.varint(kTrackEvent_Type, slice.fType);
+            child.varint(kTrackEvent_TrackUUID, trackUUID);
+            if (slice.fType != kTypeSliceEnd) {
+                child.string(kTrackEvent_Categories, fCategoryNames[slice.fCategory]);
+                child.string(kTrackEvent_Name, slice.fName);
+            }
+            packet.reset();
+            packet.varint(kTracePacket_Timestamp, slice.fTimestamp);
+            packet.varint(kTracePacket_TrustedPacketSequenceID, ring->sequenceID());
+            packet.message(kTracePacket_TrackEvent, child);
+            packet.writeAsField(kTrace_Packet, &stream);
+        }
+    }
+
+    return stream.detachAsData();
+}
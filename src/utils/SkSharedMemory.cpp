@@ -0,0 +1,374 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/utils/SkSharedMemory.h"
+
+#include "include/core/SkAlphaType.h"
+#include "include/core/SkColorSpace.h"
+#include "include/core/SkColorType.h"
+#include "include/core/SkData.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkMallocPixelRef.h"
+#include "include/core/SkPixelRef.h"
+#include "include/core/SkPixmap.h"
+#include "include/private/base/SkMutex.h"
+#include "include/private/base/SkTFitsIn.h"
+#include "src/core/SkReadBuffer.h"
+#include "src/core/SkWriteBuffer.h"
+
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <utility>
+
+#if (defined(SK_BUILD_FOR_UNIX) || defined(SK_BUILD_FOR_ANDROID) || defined(SK_BUILD_FOR_MAC) || \
+     defined(SK_BUILD_FOR_IOS)) && !defined(__EMSCRIPTEN__)
+    #define SK_SHARED_MEMORY_SUPPORTED
+#endif
+
+#if defined(SK_SHARED_MEMORY_SUPPORTED)
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(SK_BUILD_FOR_UNIX) || defined(SK_BUILD_FOR_ANDROID)
+    #include <sys/syscall.h>
+#endif
+#if defined(SK_BUILD_FOR_ANDROID)
+    #include <linux/ashmem.h>
+    #include <sys/ioctl.h>
+#endif
+#if defined(SK_BUILD_FOR_MAC) || defined(SK_BUILD_FOR_IOS)
+    #include <atomic>
+    #include <cstdio>
+#endif
+
+namespace {
+
+// The shared memory mapped in this process, by start address, so FindFD() can find the descriptor
+// to send for memory inside it.
+struct Mapping {
+    size_t fSize;
+    int    fFD;
+};
+
+struct Mappings {
+    SkMutex fMutex;
+    std::map<uintptr_t, Mapping> fByAddr SK_GUARDED_BY(fMutex);
+};
+
+Mappings* mappings() {
+    static Mappings* mappings = new Mappings;
+    return mappings;
+}
+
+// Returns a new descriptor for 'size' bytes of zeroed, anonymous shared memory, or -1.
+int create_fd(size_t size) {
+    int fd = -1;
+#if defined(SK_BUILD_FOR_UNIX) || defined(SK_BUILD_FOR_ANDROID)
+    #if defined(SYS_memfd_create)
+        // Called directly, since libc wrappers are newer than the kernels that support it.
+        static constexpr unsigned kMemfdCloexec = 0x0001;
+        fd = static_cast<int>(syscall(SYS_memfd_create, "skia", kMemfdCloexec));
+    #endif
+    #if defined(SK_BUILD_FOR_ANDROID)
+        if (fd < 0) {
+            fd = open("/dev/ashmem", O_RDWR | O_CLOEXEC);
+            if (fd >= 0 && ioctl(fd, ASHMEM_SET_SIZE, size) < 0) {
+                close(fd);
+                return -1;
+            }
+            return fd;  // ashmem is sized by the ioctl, not ftruncate()
+        }
+    #endif
+#else
+    // Give the memory a unique name just long enough to open it.
+    static std::atomic<uint32_t> nextID{0};
+    char name[32];
+    snprintf(name, sizeof(name), "/skia-%d-%u", static_cast<int>(getpid()), nextID++);
+    fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd >= 0) {
+        shm_unlink(name);
+    }
+#endif
+    if (fd >= 0 && (!SkTFitsIn<off_t>(size) || ftruncate(fd, static_cast<off_t>(size)) != 0)) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+size_t fd_size(int fd) {
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < 0) {
+        return 0;
+    }
+#if defined(SK_BUILD_FOR_ANDROID)
+    if (st.st_size == 0) {
+        // ashmem doesn't report its size through fstat().
+        int size = ioctl(fd, ASHMEM_GET_SIZE, nullptr);
+        return size > 0 ? static_cast<size_t>(size) : 0;
+    }
+#endif
+    return SkTFitsIn<size_t>(st.st_size) ? static_cast<size_t>(st.st_size) : 0;
+}
+
+void release_mapping(const void* addr, void* ctx) {
+    const size_t size = reinterpret_cast<size_t>(ctx);
+    int fd = -1;
+    {
+        Mappings* m = mappings();
+        SkAutoMutexExclusive lock(m->fMutex);
+        auto found = m->fByAddr.find(reinterpret_cast<uintptr_t>(addr));
+        SkASSERT(found != m->fByAddr.end());
+        fd = found->second.fFD;
+        m->fByAddr.erase(found);
+    }
+    munmap(const_cast<void*>(addr), size);
+    close(fd);
+}
+
+// Maps all of 'fd', which the returned data takes ownership of. Closes 'fd' on failure.
+sk_sp<SkData> map_fd(int fd, size_t size, bool requireWritable) {
+    if (fd < 0) {
+        return nullptr;
+    }
+    void* addr = MAP_FAILED;
+    if (size > 0) {
+        addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (addr == MAP_FAILED && !requireWritable) {
+            // e.g. the sender only shared a read-only descriptor.
+            addr = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        }
+    }
+    if (addr == MAP_FAILED) {
+        close(fd);
+        return nullptr;
+    }
+    {
+        Mappings* m = mappings();
+        SkAutoMutexExclusive lock(m->fMutex);
+        m->fByAddr[reinterpret_cast<uintptr_t>(addr)] = {size, fd};
+    }
+    return SkData::MakeWithProc(addr, size, release_mapping, reinterpret_cast<void*>(size));
+}
+
+sk_sp<SkData> map_dup(int fd, bool requireWritable) {
+    if (fd < 0) {
+        return nullptr;
+    }
+    const size_t size = fd_size(fd);
+    return map_fd(fcntl(fd, F_DUPFD_CLOEXEC, 0), size, requireWritable);
+}
+
+}  // namespace
+
+bool SkSharedMemory::IsSupported() { return true; }
+
+sk_sp<SkData> SkSharedMemory::MakeData(size_t size) {
+    if (size == 0) {
+        return nullptr;
+    }
+    return map_fd(create_fd(size), size, /*requireWritable=*/true);
+}
+
+sk_sp<SkData> SkSharedMemory::MapData(int fd) {
+    return map_dup(fd, /*requireWritable=*/false);
+}
+
+int SkSharedMemory::FindFD(const void* addr, size_t length, size_t* offset) {
+    const uintptr_t start = reinterpret_cast<uintptr_t>(addr);
+    Mappings* m = mappings();
+    SkAutoMutexExclusive lock(m->fMutex);
+    auto after = m->fByAddr.upper_bound(start);
+    if (after == m->fByAddr.begin()) {
+        return -1;
+    }
+    const auto& [base, mapping] = *std::prev(after);
+    const size_t offsetInMapping = start - base;
+    if (offsetInMapping > mapping.fSize || length > mapping.fSize - offsetInMapping) {
+        return -1;
+    }
+    if (offset) {
+        *offset = offsetInMapping;
+    }
+    return mapping.fFD;
+}
+
+static sk_sp<SkPixelRef> make_pixel_ref(sk_sp<SkData> data, size_t offset,
+                                        const SkImageInfo& info, size_t rowBytes) {
+    const size_t bytes = info.computeByteSize(rowBytes);
+    if (!data || SkImageInfo::ByteSizeOverflowed(bytes) || offset > data->size() ||
+        bytes > data->size() - offset) {
+        return nullptr;
+    }
+    if (offset > 0 || bytes < data->size()) {
+        data = SkData::MakeSubset(data.get(), offset, bytes);
+    }
+    return SkMallocPixelRef::MakeWithData(info, rowBytes, std::move(data));
+}
+
+sk_sp<SkPixelRef> SkSharedMemory::MakePixelRef(const SkImageInfo& info, size_t rowBytes) {
+    if (!info.validRowBytes(rowBytes)) {
+        return nullptr;
+    }
+    const size_t bytes = info.computeByteSize(rowBytes);
+    if (SkImageInfo::ByteSizeOverflowed(bytes)) {
+        return nullptr;
+    }
+    return make_pixel_ref(MakeData(bytes), 0, info, rowBytes);
+}
+
+sk_sp<SkPixelRef> SkSharedMemory::MapPixelRef(int fd, size_t offset, const SkImageInfo& info,
+                                              size_t rowBytes) {
+    // Pixel refs are writable, so the memory has to be too.
+    return make_pixel_ref(map_dup(fd, /*requireWritable=*/true), offset, info, rowBytes);
+}
+
+#else
+
+bool SkSharedMemory::IsSupported() { return false; }
+sk_sp<SkData> SkSharedMemory::MakeData(size_t) { return nullptr; }
+sk_sp<SkData> SkSharedMemory::MapData(int) { return nullptr; }
+int SkSharedMemory::FindFD(const void*, size_t, size_t*) { return -1; }
+sk_sp<SkPixelRef> SkSharedMemory::MakePixelRef(const SkImageInfo&, size_t) { return nullptr; }
+sk_sp<SkPixelRef> SkSharedMemory::MapPixelRef(int, size_t, const SkImageInfo&, size_t) {
+    return nullptr;
+}
+
+#endif  // SK_SHARED_MEMORY_SUPPORTED
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Serialized images start with this, which neither PNG nor any other codec's data does.
+static constexpr uint32_t kMagic = SkSetFourByteTag('s', 'k', 's', 'm');
+
+enum class Kind : uint32_t {
+    kPixels,   // a raster image's pixels
+    kEncoded,  // a lazy image's encoded data
+};
+
+static void write_size(SkWriteBuffer& buffer, size_t value) {
+    buffer.writeUInt(static_cast<uint32_t>(static_cast<uint64_t>(value)));
+    buffer.writeUInt(static_cast<uint32_t>(static_cast<uint64_t>(value) >> 32));
+}
+
+static size_t read_size(SkReadBuffer& buffer) {
+    const uint64_t lo = buffer.readUInt(),
+                   hi = buffer.readUInt();
+    const uint64_t value = lo | (hi << 32);
+    return buffer.validate(SkTFitsIn<size_t>(value)) ? static_cast<size_t>(value) : 0;
+}
+
+sk_sp<SkData> SkSharedMemorySerialContext::SerializeImage(SkImage* image, void* ctx) {
+    auto context = static_cast<SkSharedMemorySerialContext*>(ctx);
+
+    Kind kind;
+    SkPixmap pixmap;
+    sk_sp<SkData> encoded;
+    const void* addr;
+    size_t length;
+    if (image->peekPixels(&pixmap)) {
+        kind = Kind::kPixels;
+        addr = pixmap.addr();
+        length = pixmap.computeByteSize();
+    } else if ((encoded = image->refEncodedData())) {
+        kind = Kind::kEncoded;
+        addr = encoded->data();
+        length = encoded->size();
+    } else {
+        return nullptr;
+    }
+    size_t offset;
+    const int fd = SkSharedMemory::FindFD(addr, length, &offset);
+    if (fd < 0) {
+        return nullptr;  // serialize it as usual
+    }
+
+    uint32_t index = 0;
+    while (index < context->fFDs.size() && context->fFDs[index] != fd) {
+        index++;
+    }
+    if (index == context->fFDs.size()) {
+        context->fFDs.push_back(fd);
+    }
+
+    SkBinaryWriteBuffer buffer({});
+    buffer.writeUInt(kMagic);
+    buffer.writeUInt(static_cast<uint32_t>(kind));
+    buffer.writeUInt(index);
+    write_size(buffer, offset);
+    write_size(buffer, length);
+    if (kind == Kind::kPixels) {
+        const SkImageInfo& info = pixmap.info();
+        buffer.writeInt(info.width());
+        buffer.writeInt(info.height());
+        buffer.writeUInt(info.colorType());
+        buffer.writeUInt(info.alphaType());
+        write_size(buffer, pixmap.rowBytes());
+        sk_sp<SkData> colorSpace = info.colorSpace() ? info.colorSpace()->serialize() : nullptr;
+        buffer.writeDataAsByteArray(colorSpace.get());
+    }
+    return buffer.snapshotAsData();
+}
+
+sk_sp<SkImage> SkSharedMemoryDeserialContext::DeserializeImage(const void* data, size_t length,
+                                                               void* ctx) {
+    auto context = static_cast<SkSharedMemoryDeserialContext*>(ctx);
+
+    SkReadBuffer buffer(data, length);
+    if (length < sizeof(kMagic) || buffer.readUInt() != kMagic) {
+        return nullptr;  // not ours; let the default decoding handle it
+    }
+    const Kind kind = buffer.read32LE(Kind::kEncoded);
+    const uint32_t index = buffer.readUInt();
+    const size_t offset = read_size(buffer);
+    const size_t size = read_size(buffer);
+    if (!buffer.validate(index < context->fFDs.size())) {
+        return nullptr;
+    }
+
+    if (context->fMappings.size() < context->fFDs.size()) {
+        context->fMappings.resize(context->fFDs.size());
+    }
+    sk_sp<SkData>& memory = context->fMappings[index];
+    if (!memory) {
+        memory = SkSharedMemory::MapData(context->fFDs[index]);
+    }
+    if (!memory || offset > memory->size() || size > memory->size() - offset) {
+        return nullptr;
+    }
+    sk_sp<SkData> bytes = SkData::MakeSubset(memory.get(), offset, size);
+
+    if (kind == Kind::kEncoded) {
+        return buffer.isValid() ? SkImages::DeferredFromEncodedData(std::move(bytes)) : nullptr;
+    }
+
+    const int width = buffer.readInt();
+    const int height = buffer.readInt();
+    const SkColorType colorType = buffer.read32LE(kLastEnum_SkColorType);
+    const SkAlphaType alphaType = buffer.read32LE(kLastEnum_SkAlphaType);
+    const size_t rowBytes = read_size(buffer);
+    sk_sp<SkData> colorSpaceData = buffer.readByteArrayAsData();
+    sk_sp<SkColorSpace> colorSpace;
+    if (colorSpaceData && colorSpaceData->size() > 0) {
+        colorSpace = SkColorSpace::Deserialize(colorSpaceData->data(), colorSpaceData->size());
+        if (!colorSpace) {
+            return nullptr;
+        }
+    }
+    if (!buffer.isValid()) {
+        return nullptr;
+    }
+    // RasterFromData() checks the pixels fit in 'bytes'.
+    const SkImageInfo info =
+            SkImageInfo::Make(width, height, colorType, alphaType, std::move(colorSpace));
+    return SkImages::RasterFromData(info, std::move(bytes), rowBytes);
+}
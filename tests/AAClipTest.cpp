@@ -20,11 +20,15 @@
 #include "include/core/SkScalar.h"
 #include "include/core/SkTypes.h"
 #include "include/private/base/SkMalloc.h"
+#include "include/private/base/SkMath.h"
 #include "include/private/base/SkTemplates.h"
 #include "src/base/SkRandom.h"
 #include "src/core/SkAAClip.h"
+#include "src/core/SkBlitter.h"
+#include "src/core/SkClipMaskCache.h"
 #include "src/core/SkMask.h"
 #include "src/core/SkRasterClip.h"
+#include "src/core/SkResourceCache.h"
 #include "tests/Test.h"
 
 #include <cstdint>
@@ -434,6 +438,69 @@ static void test_huge(skiatest::Reporter* reporter) {
     clip.setRect(r);
 }
 
+// Records the A8 rows an SkAAClipBlitter hands on.
+class RecordMaskBlitter final : public SkBlitter {
+public:
+    RecordMaskBlitter(uint8_t* pixels, size_t rowBytes) : fPixels(pixels), fRowBytes(rowBytes) {}
+
+    void blitH(int, int, int) override { SkASSERT(false); }
+    void blitAntiH(int, int, const SkAlpha[], const int16_t[]) override { SkASSERT(false); }
+    void blitMask(const SkMask& mask, const SkIRect& clip) override {
+        SkASSERT(mask.fFormat == SkMask::kA8_Format);
+        for (int y = clip.fTop; y < clip.fBottom; ++y) {
+            memcpy(fPixels + y * fRowBytes + clip.fLeft, mask.getAddr8(clip.fLeft, y),
+                   clip.width());
+        }
+    }
+
+private:
+    uint8_t* fPixels;
+    size_t   fRowBytes;
+};
+
+// A complex clip has many runs per row, long and short, so blitting a mask through it covers
+// both the wide and the leftover pixels of each run.
+static void test_blit_mask_through_complex_clip(skiatest::Reporter* reporter) {
+    constexpr int W = 203, H = 37;
+    SkPath path;
+    for (int i = 0; i < 12; ++i) {
+        path.addCircle(W * 0.5f, H * 0.5f, 3.3f + i * 8.1f);
+    }
+    path.setFillType(SkPathFillType::kEvenOdd);
+    const SkIRect bounds = SkIRect::MakeWH(W, H);
+
+    SkAAClip clip;
+    clip.setPath(path, bounds, true);
+    SkMaskBuilder clipMask;
+    clip.copyToMask(&clipMask);
+    SkAutoMaskFreeImage freeClip(clipMask.image());
+
+    SkRandom rand;
+    uint8_t src[W * H];
+    for (uint8_t& a : src) {
+        a = rand.nextU() & 0xFF;
+    }
+    SkMask srcMask(src, bounds, W, SkMask::kA8_Format);
+
+    uint8_t dst[W * H] = {};
+    RecordMaskBlitter record(dst, W);
+    SkAAClipBlitter blitter;
+    blitter.init(&record, &clip);
+    blitter.blitMask(srcMask, clip.getBounds());
+
+    const SkIRect& cb = clip.getBounds();
+    for (int y = cb.fTop; y < cb.fBottom; ++y) {
+        for (int x = cb.fLeft; x < cb.fRight; ++x) {
+            const uint8_t c = *clipMask.getAddr8(x, y);
+            const uint8_t expected = SkMulDiv255Round(src[y * W + x], c);
+            if (dst[y * W + x] != expected) {
+                ERRORF(reporter, "(%d, %d): got %d, expected %d", x, y, dst[y * W + x], expected);
+                return;
+            }
+        }
+    }
+}
+
 DEF_TEST(AAClip, reporter) {
     test_empty(reporter);
     test_path_bounds(reporter);
@@ -445,4 +512,53 @@ DEF_TEST(AAClip, reporter) {
     test_really_a_rect(reporter);
     test_crbug_422693(reporter);
     test_huge(reporter);
+    test_blit_mask_through_complex_clip(reporter);
+}
+
+static bool operator==(const SkAAClip& a, const SkAAClip& b) {
+    SkMaskBuilder mask0, mask1;
+    a.copyToMask(&mask0);
+    b.copyToMask(&mask1);
+    SkAutoMaskFreeImage free0(mask0.image());
+    SkAutoMaskFreeImage free1(mask1.image());
+    return mask0 == mask1;
+}
+
+DEF_TEST(AAClip_maskCache, reporter) {
+    SkResourceCache cache(1024 * 1024);
+
+    SkPath path;
+    path.addCircle(30, 30, 20);
+    path.addCircle(50, 40, 20);
+    const SkMatrix ctm = SkMatrix::Translate(3.5f, 2.25f);
+    const SkIRect bounds = SkIRect::MakeWH(100, 100);
+
+    // The first call adds the mask, the second finds it, and both match rasterizing directly.
+    SkAAClip expected, first, second;
+    expected.setPath(path.makeTransform(ctm), bounds, true);
+    REPORTER_ASSERT(reporter, SkClipMaskCache::SetPath(&first, path, ctm, bounds, true, &cache));
+    const size_t bytes = cache.getTotalBytesUsed();
+    REPORTER_ASSERT(reporter, bytes > 0);
+    REPORTER_ASSERT(reporter, SkClipMaskCache::SetPath(&second, path, ctm, bounds, true, &cache));
+    REPORTER_ASSERT(reporter, cache.getTotalBytesUsed() == bytes);
+    REPORTER_ASSERT(reporter, first == expected && second == expected);
+
+    // Different bounds, or no AA, make their own masks.
+    SkAAClip other;
+    SkClipMaskCache::SetPath(&other, path, ctm, SkIRect::MakeWH(40, 40), true, &cache);
+    SkClipMaskCache::SetPath(&other, path, ctm, bounds, false, &cache);
+    REPORTER_ASSERT(reporter, cache.getTotalBytesUsed() > bytes);
+
+    // The hard-edged form agrees with SkRegion::setPath().
+    SkRegion expectedRgn, rgn;
+    expectedRgn.setPath(path.makeTransform(ctm), SkRegion(bounds));
+    REPORTER_ASSERT(reporter, SkClipMaskCache::SetPath(&rgn, path, ctm, bounds, &cache));
+    REPORTER_ASSERT(reporter, rgn == expectedRgn);
+
+    // Volatile paths are never cached.
+    const size_t before = cache.getTotalBytesUsed();
+    SkPath volatilePath = path;
+    volatilePath.setIsVolatile(true);
+    SkClipMaskCache::SetPath(&other, volatilePath, SkMatrix::I(), bounds, true, &cache);
+    REPORTER_ASSERT(reporter, cache.getTotalBytesUsed() == before);
 }
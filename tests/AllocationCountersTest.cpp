@@ -0,0 +1,101 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkGraphics.h"
+#include "include/core/SkString.h"
+#include "include/core/SkTraceMemoryDump.h"
+#include "src/base/SkAllocationCounters.h"
+#include "src/base/SkArenaAlloc.h"
+#include "tests/Test.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+class SkDiscardableMemory;
+
+// Other tests allocate concurrently, so these only check counts far bigger than anything they
+// allocate. The counts include every owner's bytes, so they are never below this test's.
+static constexpr size_t kHuge = SIZE_MAX / 4;
+
+namespace {
+class CodecDump : public SkTraceMemoryDump {
+public:
+    void dumpNumericValue(const char* dumpName, const char* valueName, const char*,
+                          uint64_t value) override {
+        if (!strcmp(dumpName, "skia/sk_allocations/codec")) {
+            if (!strcmp(valueName, "size")) {
+                fSize = value;
+            } else if (!strcmp(valueName, "peak_size")) {
+                fPeak = value;
+            }
+        }
+    }
+    void setMemoryBacking(const char*, const char*, const char*) override {}
+    void setDiscardableMemoryBacking(const char*, const SkDiscardableMemory&) override {}
+    LevelOfDetail getRequestedDetails() const override {
+        return SkTraceMemoryDump::kLight_LevelOfDetail;
+    }
+
+    uint64_t fSize = 0;
+    uint64_t fPeak = 0;
+};
+}  // namespace
+
+DEF_TEST(AllocationCounters, r) {
+    const bool wasEnabled = SkAllocationCounters::SetEnabled(true);
+    constexpr SkAllocationCategory kCategory = SkAllocationCategory::kPDF;
+
+    {
+        SkAccountedBytes bytes(kCategory);
+        bytes.set(kHuge);
+        REPORTER_ASSERT(r, bytes.bytes() == kHuge);
+        REPORTER_ASSERT(r, SkAllocationCounters::Get(kCategory).fCurrent >= kHuge);
+        REPORTER_ASSERT(r, SkAllocationCounters::Get(kCategory).fPeak >= kHuge);
+
+        bytes.set(0);
+        REPORTER_ASSERT(r, SkAllocationCounters::Get(kCategory).fCurrent < kHuge);
+        REPORTER_ASSERT(r, SkAllocationCounters::Get(kCategory).fPeak >= kHuge);
+
+        SkAllocationCounters::ResetPeaks();
+        REPORTER_ASSERT(r, SkAllocationCounters::Get(kCategory).fPeak < kHuge);
+
+        // Bytes counted while counting was on are still subtracted after it's turned off, and
+        // growth while it's off isn't counted.
+        bytes.set(kHuge);
+        SkAllocationCounters::SetEnabled(false);
+        bytes.add(kHuge);
+        REPORTER_ASSERT(r, bytes.bytes() == kHuge);
+        bytes.set(0);
+        REPORTER_ASSERT(r, SkAllocationCounters::Get(kCategory).fCurrent < kHuge);
+        SkAllocationCounters::SetEnabled(true);
+
+        bytes.set(kHuge);
+        bytes.setCategory(SkAllocationCategory::kCodec);
+        REPORTER_ASSERT(r, SkAllocationCounters::Get(kCategory).fCurrent < kHuge);
+        REPORTER_ASSERT(r, SkAllocationCounters::Get(SkAllocationCategory::kCodec).fCurrent >=
+                           kHuge);
+
+        CodecDump dump;
+        SkGraphics::DumpMemoryStatistics(&dump);
+        REPORTER_ASSERT(r, dump.fSize >= kHuge);
+        REPORTER_ASSERT(r, dump.fPeak >= dump.fSize);
+    }
+    REPORTER_ASSERT(r, SkAllocationCounters::Get(SkAllocationCategory::kCodec).fCurrent < kHuge);
+
+    {
+        SkArenaAlloc arena(1024);
+        arena.makeBytesAlignedTo(1 << 20, 8);
+        REPORTER_ASSERT(r, SkAllocationCounters::Get(SkAllocationCategory::kArenaAlloc).fCurrent
+                           >= size_t(1 << 20));
+        arena.setAllocationCategory(SkAllocationCategory::kRecord);
+        REPORTER_ASSERT(r, SkAllocationCounters::Get(SkAllocationCategory::kRecord).fCurrent
+                           >= size_t(1 << 20));
+    }
+
+    SkAllocationCounters::SetEnabled(wasEnabled);
+}
@@ -8,19 +8,29 @@
 #include "include/android/SkAnimatedImage.h"
 #include "include/codec/SkAndroidCodec.h"
 #include "include/codec/SkCodec.h"
+#include "include/codec/SkCodecAnimation.h"
+#include "include/codec/SkEncodedImageFormat.h"
 #include "include/core/SkAlphaType.h"
 #include "include/core/SkBitmap.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColor.h"
+#include "include/core/SkColorPriv.h"
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkImage.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkPicture.h"
+#include "include/core/SkPixmap.h"
 #include "include/core/SkRect.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkSize.h"
 #include "include/core/SkString.h"
 #include "include/core/SkTypes.h"
 #include "include/core/SkUnPreMultiply.h"
+#include "include/private/SkEncodedInfo.h"
+#include "include/private/base/SkTo.h"
+#include "modules/skcms/skcms.h"
+#include "src/codec/SkFrameHolder.h"
 #include "tests/CodecPriv.h"
 #include "tests/Test.h"
 #include "tools/Resources.h"
@@ -28,6 +38,7 @@
 
 #include <cstddef>
 #include <initializer_list>
+#include <iterator>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -286,6 +297,38 @@ DEF_TEST(AnimatedImage_copyOnWrite, r) {
     }
 }
 
+// Decodes every frame of codec into frames, each built on its required frame.
+static void decode_frames(skiatest::Reporter* r,
+                          const char* file,
+                          SkCodec* codec,
+                          const std::vector<SkCodec::FrameInfo>& frameInfos,
+                          std::vector<SkBitmap>* frames) {
+    for (size_t i = 0; i < frameInfos.size(); ++i) {
+        auto info = codec->getInfo().makeAlphaType(frameInfos[i].fAlphaType);
+        auto& bm = (*frames)[i];
+
+        SkCodec::Options options;
+        options.fFrameIndex = (int) i;
+        options.fPriorFrame = frameInfos[i].fRequiredFrame;
+        if (options.fPriorFrame == SkCodec::kNoFrame) {
+            bm.allocPixels(info);
+            bm.eraseColor(0);
+        } else {
+            const SkBitmap& priorFrame = (*frames)[options.fPriorFrame];
+            if (!ToolUtils::copy_to(&bm, priorFrame.colorType(), priorFrame)) {
+                ERRORF(r, "Failed to copy %s frame %i", file, options.fPriorFrame);
+                options.fPriorFrame = SkCodec::kNoFrame;
+            }
+            REPORTER_ASSERT(r, bm.setAlphaType(frameInfos[i].fAlphaType));
+        }
+
+        auto result = codec->getPixels(info, bm.getPixels(), bm.rowBytes(), &options);
+        if (result != SkCodec::kSuccess) {
+            ERRORF(r, "error in %s frame %zu: %s", file, i, SkCodec::ResultToString(result));
+        }
+    }
+}
+
 DEF_TEST(AnimatedImage, r) {
     if (GetResourcePath().isEmpty()) {
         return;
@@ -325,30 +368,7 @@ DEF_TEST(AnimatedImage, r) {
         // number of frames (e.g. call getFrameInfo).
         const int defaultRepetitionCount = codec->getRepetitionCount();
 
-        for (size_t i = 0; i < frameInfos.size(); ++i) {
-            auto info = codec->getInfo().makeAlphaType(frameInfos[i].fAlphaType);
-            auto& bm = frames[i];
-
-            SkCodec::Options options;
-            options.fFrameIndex = (int) i;
-            options.fPriorFrame = frameInfos[i].fRequiredFrame;
-            if (options.fPriorFrame == SkCodec::kNoFrame) {
-                bm.allocPixels(info);
-                bm.eraseColor(0);
-            } else {
-                const SkBitmap& priorFrame = frames[options.fPriorFrame];
-                if (!ToolUtils::copy_to(&bm, priorFrame.colorType(), priorFrame)) {
-                    ERRORF(r, "Failed to copy %s frame %i", file, options.fPriorFrame);
-                    options.fPriorFrame = SkCodec::kNoFrame;
-                }
-                REPORTER_ASSERT(r, bm.setAlphaType(frameInfos[i].fAlphaType));
-            }
-
-            auto result = codec->getPixels(info, bm.getPixels(), bm.rowBytes(), &options);
-            if (result != SkCodec::kSuccess) {
-                ERRORF(r, "error in %s frame %zu: %s", file, i, SkCodec::ResultToString(result));
-            }
-        }
+        decode_frames(r, file, codec.get(), frameInfos, &frames);
 
         auto androidCodec = SkAndroidCodec::MakeFromCodec(std::move(codec));
         if (!androidCodec) {
@@ -484,3 +504,375 @@ DEF_TEST(AnimatedImage, r) {
         }
     }
 }
+
+DEF_TEST(AnimatedImage_seek, r) {
+    if (GetResourcePath().isEmpty()) {
+        return;
+    }
+    auto executor = SkExecutor::MakeFIFOThreadPool(1);
+    for (const char* file : { "images/alphabetAnim.gif",
+                              "images/colorTables.gif",
+                              "images/stoplight.webp",
+                              "images/required.webp",
+                              }) {
+        auto data = GetResourceAsData(file);
+        if (!data) {
+            ERRORF(r, "Could not get %s", file);
+            continue;
+        }
+        auto codec = SkCodec::MakeFromData(data);
+        if (!codec) {
+            ERRORF(r, "Could not create codec for %s", file);
+            continue;
+        }
+        std::vector<SkCodec::FrameInfo> frameInfos = codec->getFrameInfo();
+        std::vector<SkBitmap> frames(frameInfos.size());
+        decode_frames(r, file, codec.get(), frameInfos, &frames);
+        const int frameCount = SkToInt(frames.size());
+        const auto imageInfo = codec->getInfo().makeAlphaType(kPremul_SkAlphaType);
+
+        // No cache, a cache too small for every frame, and one that holds them all. The
+        // lookahead runs on the last two.
+        const size_t frameBytes = imageInfo.computeMinByteSize();
+        for (size_t budget : { size_t(0), 2 * frameBytes, frameCount * frameBytes }) {
+            auto animatedImage = SkAnimatedImage::Make(SkAndroidCodec::MakeFromCodec(
+                    SkCodec::MakeFromData(data)));
+            if (!animatedImage) {
+                ERRORF(r, "Could not create animated image for %s", file);
+                break;
+            }
+            animatedImage->setFrameCacheBudget(budget);
+            REPORTER_ASSERT(r, animatedImage->getFrameCacheBudget() == budget);
+            if (budget) {
+                animatedImage->setLookaheadExecutor(executor.get());
+            }
+
+            auto seekAndCompare = [&](int frame) {
+                const int duration = animatedImage->seekFrame(frame);
+                REPORTER_ASSERT(r, duration == frameInfos[frame].fDuration);
+                REPORTER_ASSERT(r, duration == animatedImage->currentFrameDuration());
+
+                SkBitmap test;
+                test.allocPixels(imageInfo);
+                test.eraseColor(0);
+                SkCanvas canvas(test);
+                animatedImage->draw(&canvas);
+                return compare_bitmaps(r, file, frame, frames[frame], test);
+            };
+
+            // Backwards, then forwards by skipping frames, then around again. Every order
+            // makes the seek start from a different set of decoded frames.
+            bool ok = true;
+            for (int i = frameCount - 1; ok && i >= 0; --i) {
+                ok = seekAndCompare(i);
+            }
+            for (int step : { 2, 3, 1 }) {
+                for (int i = 0; ok && i < frameCount; i += step) {
+                    ok = seekAndCompare(i);
+                }
+            }
+            // Playing on from a seek continues with the following frame.
+            if (ok && animatedImage->seekFrame(0) != SkAnimatedImage::kFinished) {
+                animatedImage->decodeNextFrame();
+                SkBitmap test;
+                test.allocPixels(imageInfo);
+                test.eraseColor(0);
+                SkCanvas canvas(test);
+                animatedImage->draw(&canvas);
+                compare_bitmaps(r, file, 1, frames[1], test);
+            }
+            REPORTER_ASSERT(r, animatedImage->seekFrame(frameCount) == SkAnimatedImage::kFinished);
+        }
+    }
+}
+
+namespace {
+
+// A frame of FakeAnimatedCodec: a rectangle of a single color drawn over the frames before it.
+struct FakeFrameDesc {
+    SkIRect                          fRect;
+    SkColor                          fColor;
+    SkCodecAnimation::DisposalMethod fDisposalMethod;
+    SkCodecAnimation::Blend          fBlend;
+};
+
+using Disposal = SkCodecAnimation::DisposalMethod;
+using Blend = SkCodecAnimation::Blend;
+
+constexpr int kFakeSize = 16;
+
+// Every disposal method, both blends, translucent frames and keyframes (0, 5 and 9) after the
+// first, so that the required frames the codec computes take every kind of shortcut.
+const FakeFrameDesc kFakeFrames[] = {
+    {SkIRect::MakeXYWH(0, 0, 16, 16), 0xFF808080, Disposal::kKeep,            Blend::kSrcOver},
+    {SkIRect::MakeXYWH(2, 2, 6, 6),   0x80FF0000, Disposal::kKeep,            Blend::kSrcOver},
+    {SkIRect::MakeXYWH(8, 2, 6, 6),   0xFF00FF00, Disposal::kRestoreBGColor,  Blend::kSrcOver},
+    {SkIRect::MakeXYWH(4, 8, 8, 6),   0x800000FF, Disposal::kRestorePrevious, Blend::kSrcOver},
+    {SkIRect::MakeXYWH(0, 0, 10, 10), 0x60FFFF00, Disposal::kKeep,            Blend::kSrcOver},
+    {SkIRect::MakeXYWH(0, 0, 16, 16), 0xFF00FFFF, Disposal::kKeep,            Blend::kSrcOver},
+    {SkIRect::MakeXYWH(1, 1, 4, 12),  0xFFFF00FF, Disposal::kRestorePrevious, Blend::kSrc},
+    {SkIRect::MakeXYWH(6, 6, 8, 8),   0x40000000, Disposal::kRestoreBGColor,  Blend::kSrc},
+    {SkIRect::MakeXYWH(3, 3, 10, 4),  0xA0FFFFFF, Disposal::kKeep,            Blend::kSrcOver},
+    {SkIRect::MakeXYWH(0, 0, 16, 16), 0x80408000, Disposal::kKeep,            Blend::kSrc},
+    {SkIRect::MakeXYWH(5, 5, 6, 6),   0xFFFF8000, Disposal::kRestorePrevious, Blend::kSrcOver},
+    {SkIRect::MakeXYWH(0, 8, 16, 8),  0x90800080, Disposal::kKeep,            Blend::kSrcOver},
+};
+
+constexpr int kFakeFrameCount = std::size(kFakeFrames);
+
+int fake_duration(int frame) { return 10 * (frame + 1); }
+
+void draw_fake_frame(const SkPixmap& dst, const FakeFrameDesc& desc) {
+    const SkPMColor src = SkPreMultiplyColor(desc.fColor);
+    for (int y = desc.fRect.top(); y < desc.fRect.bottom(); ++y) {
+        for (int x = desc.fRect.left(); x < desc.fRect.right(); ++x) {
+            uint32_t* pixel = dst.writable_addr32(x, y);
+            *pixel = desc.fBlend == Blend::kSrc ? src : SkPMSrcOver(src, *pixel);
+        }
+    }
+}
+
+// A multi-frame codec with no encoded data, which draws kFakeFrames and counts its decodes.
+class FakeAnimatedCodec final : public SkCodec {
+public:
+    explicit FakeAnimatedCodec(int* decodeCount)
+            : SkCodec(SkEncodedInfo::Make(kFakeSize, kFakeSize, SkEncodedInfo::kRGBA_Color,
+                                          SkEncodedInfo::kUnpremul_Alpha, 8),
+                      skcms_PixelFormat_RGBA_8888, nullptr)
+            , fDecodeCount(decodeCount) {
+        fFrameHolder.fFrames.reserve(kFakeFrameCount);
+        for (int i = 0; i < kFakeFrameCount; ++i) {
+            FakeFrame& frame = fFrameHolder.fFrames.emplace_back(i, kFakeFrames[i].fColor);
+            const SkIRect& rect = kFakeFrames[i].fRect;
+            frame.setXYWH(rect.x(), rect.y(), rect.width(), rect.height());
+            frame.setDisposalMethod(kFakeFrames[i].fDisposalMethod);
+            frame.setBlend(kFakeFrames[i].fBlend);
+            frame.setDuration(fake_duration(i));
+            fFrameHolder.setAlphaAndRequiredFrame(&frame);
+        }
+    }
+
+protected:
+    SkEncodedImageFormat onGetEncodedFormat() const override { return SkEncodedImageFormat::kGIF; }
+
+    Result onGetPixels(const SkImageInfo& info, void* pixels, size_t rowBytes,
+                       const Options& options, int* rowsDecoded) override {
+        if (info.colorType() != kN32_SkColorType) {
+            return kInvalidConversion;
+        }
+        if (fDecodeCount) {
+            ++*fDecodeCount;
+        }
+        const SkPixmap dst(info, pixels, rowBytes);
+        const FakeFrame& frame = fFrameHolder.fFrames[options.fFrameIndex];
+        if (frame.getRequiredFrame() == kNoFrame &&
+            options.fZeroInitialized == kNo_ZeroInitialized) {
+            dst.erase(SK_ColorTRANSPARENT);
+        }
+        draw_fake_frame(dst, kFakeFrames[options.fFrameIndex]);
+        *rowsDecoded = info.height();
+        return kSuccess;
+    }
+
+    bool usesColorXform() const override { return false; }
+
+    int onGetFrameCount() override { return kFakeFrameCount; }
+
+    bool onGetFrameInfo(int i, FrameInfo* frameInfo) const override {
+        if (i < 0 || i >= kFakeFrameCount) {
+            return false;
+        }
+        if (frameInfo) {
+            fFrameHolder.fFrames[i].fillIn(frameInfo, true);
+        }
+        return true;
+    }
+
+    int onGetRepetitionCount() override { return kRepetitionCountInfinite; }
+
+private:
+    class FakeFrame final : public SkFrame {
+    public:
+        FakeFrame(int id, SkColor color) : SkFrame(id), fColor(color) {}
+
+    private:
+        SkEncodedInfo::Alpha onReportedAlpha() const override {
+            return SkColorGetA(fColor) == 0xFF ? SkEncodedInfo::kOpaque_Alpha
+                                               : SkEncodedInfo::kUnpremul_Alpha;
+        }
+
+        SkColor fColor;
+    };
+
+    class FrameHolder final : public SkFrameHolder {
+    public:
+        FrameHolder() {
+            fScreenWidth = kFakeSize;
+            fScreenHeight = kFakeSize;
+        }
+
+        std::vector<FakeFrame> fFrames;
+
+    private:
+        const SkFrame* onGetFrame(int i) const override { return &fFrames[i]; }
+    };
+
+    const SkFrameHolder* getFrameHolder() const override { return &fFrameHolder; }
+
+    FrameHolder fFrameHolder;
+    int*        fDecodeCount;
+};
+
+sk_sp<SkAnimatedImage> make_fake_animated_image(int* decodeCount) {
+    return SkAnimatedImage::Make(SkAndroidCodec::MakeFromCodec(
+            std::make_unique<FakeAnimatedCodec>(decodeCount)));
+}
+
+// Composites kFakeFrames one after the other, the way a viewer would, independently of the
+// required frames the codec works out.
+std::vector<SkBitmap> render_fake_frames() {
+    std::vector<SkBitmap> frames(kFakeFrameCount);
+    SkBitmap screen;
+    screen.allocN32Pixels(kFakeSize, kFakeSize);
+    screen.eraseColor(SK_ColorTRANSPARENT);
+    for (int i = 0; i < kFakeFrameCount; ++i) {
+        SkBitmap previous;
+        SkAssertResult(ToolUtils::copy_to(&previous, screen.colorType(), screen));
+        draw_fake_frame(screen.pixmap(), kFakeFrames[i]);
+        SkAssertResult(ToolUtils::copy_to(&frames[i], screen.colorType(), screen));
+        switch (kFakeFrames[i].fDisposalMethod) {
+            case Disposal::kKeep:
+                break;
+            case Disposal::kRestoreBGColor:
+                screen.erase(SK_ColorTRANSPARENT, kFakeFrames[i].fRect);
+                break;
+            case Disposal::kRestorePrevious:
+                std::swap(screen, previous);
+                break;
+        }
+    }
+    return frames;
+}
+
+bool shows_fake_frame(skiatest::Reporter* r, SkAnimatedImage* animatedImage,
+                      const std::vector<SkBitmap>& expected, int frame) {
+    sk_sp<SkImage> image = animatedImage->getCurrentFrame();
+    SkBitmap actual;
+    actual.allocPixels(expected[frame].info());
+    if (!image || !image->readPixels(nullptr, actual.pixmap(), 0, 0)) {
+        ERRORF(r, "Could not read fake frame %d", frame);
+        return false;
+    }
+    for (int y = 0; y < kFakeSize; ++y) {
+        for (int x = 0; x < kFakeSize; ++x) {
+            if (*actual.getAddr32(x, y) != *expected[frame].getAddr32(x, y)) {
+                ERRORF(r, "fake frame %d does not match at pixel %d, %d: expected %x, actual %x",
+                       frame, x, y, *expected[frame].getAddr32(x, y), *actual.getAddr32(x, y));
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+}  // anonymous namespace
+
+// Playback and seeks with every cache budget, with and without the lookahead, against frames
+// composited without the codec.
+DEF_TEST(AnimatedImage_fakeCodec, r) {
+    const std::vector<SkBitmap> expected = render_fake_frames();
+    const size_t frameBytes = expected[0].computeByteSize();
+    auto executor = SkExecutor::MakeFIFOThreadPool(1);
+    for (size_t budget : { size_t(0), 2 * frameBytes, kFakeFrameCount * frameBytes }) {
+        for (SkExecutor* lookahead : { static_cast<SkExecutor*>(nullptr), executor.get() }) {
+            sk_sp<SkAnimatedImage> animatedImage = make_fake_animated_image(nullptr);
+            if (!animatedImage) {
+                ERRORF(r, "Could not create animated image for the fake codec");
+                return;
+            }
+            animatedImage->setFrameCacheBudget(budget);
+            animatedImage->setLookaheadExecutor(lookahead);
+            REPORTER_ASSERT(r, animatedImage->getFrameCount() == kFakeFrameCount);
+            REPORTER_ASSERT(r, animatedImage->currentFrameDuration() == fake_duration(0));
+            bool ok = shows_fake_frame(r, animatedImage.get(), expected, 0);
+
+            // Two loops, the second of which can use whatever the first cached.
+            for (int i = 1; ok && i <= 2 * kFakeFrameCount; ++i) {
+                const int frame = i % kFakeFrameCount;
+                REPORTER_ASSERT(r, animatedImage->decodeNextFrame() == fake_duration(frame));
+                ok = shows_fake_frame(r, animatedImage.get(), expected, frame);
+            }
+
+            // Backwards, then skipping frames, so that each seek starts from a different set of
+            // decoded and cached frames.
+            for (int i = kFakeFrameCount - 1; ok && i >= 0; --i) {
+                REPORTER_ASSERT(r, animatedImage->seekFrame(i) == fake_duration(i));
+                ok = shows_fake_frame(r, animatedImage.get(), expected, i);
+            }
+            for (int step : { 3, 2, 5 }) {
+                for (int i = 0; ok && i < kFakeFrameCount; i += step) {
+                    REPORTER_ASSERT(r, animatedImage->seekFrame(i) == fake_duration(i));
+                    ok = shows_fake_frame(r, animatedImage.get(), expected, i);
+                }
+            }
+
+            // Playback goes on from the frame seeked to.
+            if (ok) {
+                animatedImage->seekFrame(6);
+                REPORTER_ASSERT(r, animatedImage->decodeNextFrame() == fake_duration(7));
+                shows_fake_frame(r, animatedImage.get(), expected, 7);
+            }
+            REPORTER_ASSERT(r, animatedImage->seekFrame(kFakeFrameCount) ==
+                               SkAnimatedImage::kFinished);
+            animatedImage->setLookaheadExecutor(nullptr);
+        }
+    }
+}
+
+// The cache keeps keyframes over the frames that depend on them, and seeks start from them.
+DEF_TEST(AnimatedImage_fakeCodecCache, r) {
+    const std::vector<SkBitmap> expected = render_fake_frames();
+    const size_t frameBytes = expected[0].computeByteSize();
+    for (size_t budget : { size_t(0), 3 * frameBytes }) {
+        int decodes = 0;
+        sk_sp<SkAnimatedImage> animatedImage = make_fake_animated_image(&decodes);
+        if (!animatedImage) {
+            ERRORF(r, "Could not create animated image for the fake codec");
+            return;
+        }
+        animatedImage->setFrameCacheBudget(budget);
+
+        // Play a whole loop, back to frame 0.
+        for (int i = 0; i < kFakeFrameCount; ++i) {
+            animatedImage->decodeNextFrame();
+        }
+        shows_fake_frame(r, animatedImage.get(), expected, 0);
+
+        // Keyframes 5, 9 and 0 are all that fit, so they are what is left.
+        decodes = 0;
+        for (int keyframe : { 5, 9, 0 }) {
+            REPORTER_ASSERT(r, animatedImage->seekFrame(keyframe) == fake_duration(keyframe));
+            shows_fake_frame(r, animatedImage.get(), expected, keyframe);
+        }
+        if (budget) {
+            REPORTER_ASSERT(r, decodes == 0, "decodes %d", decodes);
+        } else {
+            REPORTER_ASSERT(r, decodes > 0, "decodes %d", decodes);
+        }
+
+        // Frame 8 needs frame 7, which needs frame 5, so with 5 cached that takes two decodes.
+        decodes = 0;
+        REPORTER_ASSERT(r, animatedImage->seekFrame(8) == fake_duration(8));
+        shows_fake_frame(r, animatedImage.get(), expected, 8);
+        if (budget) {
+            REPORTER_ASSERT(r, decodes == 2, "decodes %d", decodes);
+        }
+
+        // Dropping the budget drops the cached frames.
+        animatedImage->setFrameCacheBudget(0);
+        decodes = 0;
+        REPORTER_ASSERT(r, animatedImage->seekFrame(9) == fake_duration(9));
+        shows_fake_frame(r, animatedImage.get(), expected, 9);
+        REPORTER_ASSERT(r, decodes > 0, "decodes %d", decodes);
+    }
+}
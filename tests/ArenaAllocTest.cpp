@@ -243,3 +243,55 @@ DEF_TEST(SkFibBlockSizes, r) {
         REPORTER_ASSERT(r, lastSize == 1346269u * 1024);
     }
 }
+
+DEF_TEST(ArenaAllocBlockRecycling, r) {
+    const bool wasEnabled = SkArenaAlloc::SetBlockRecycling(true);
+    SkArenaAlloc::PurgeThreadBlockCache();
+
+    static int destroyed = 0;
+    struct Node {
+        ~Node() { destroyed++; }
+        char filler[200];
+    };
+
+    // The stats are per thread, so other tests can't change them while this one runs.
+    const SkArenaAlloc::BlockRecyclingStats before = SkArenaAlloc::ThreadBlockRecyclingStats();
+    {
+        SkSTArenaAlloc<64> arena(1024);
+        for (int i = 0; i < 32; i++) {
+            arena.make<Node>();
+        }
+    }
+    SkArenaAlloc::BlockRecyclingStats stats = SkArenaAlloc::ThreadBlockRecyclingStats();
+    REPORTER_ASSERT(r, destroyed == 32);
+    REPORTER_ASSERT(r, stats.fAllocated > before.fAllocated);
+    REPORTER_ASSERT(r, stats.fReused == before.fReused);
+    REPORTER_ASSERT(r, stats.fCachedBlocks > 0);
+    REPORTER_ASSERT(r, stats.fCachedBytes >= 1024);
+
+    // The same arena again reuses the cached blocks, and its objects are still destroyed.
+    {
+        SkSTArenaAlloc<64> arena(1024);
+        for (int i = 0; i < 32; i++) {
+            arena.make<Node>();
+        }
+    }
+    const SkArenaAlloc::BlockRecyclingStats after = SkArenaAlloc::ThreadBlockRecyclingStats();
+    REPORTER_ASSERT(r, destroyed == 64);
+    REPORTER_ASSERT(r, after.fReused > stats.fReused);
+    REPORTER_ASSERT(r, after.fAllocated == stats.fAllocated);
+
+    // Blocks too big to cache are freed as usual.
+    {
+        SkArenaAlloc arena(1024);
+        arena.makeBytesAlignedTo(256 * 1024, 8);
+    }
+    REPORTER_ASSERT(r, SkArenaAlloc::ThreadBlockRecyclingStats().fCachedBytes <= 256 * 1024);
+
+    SkArenaAlloc::PurgeThreadBlockCache();
+    stats = SkArenaAlloc::ThreadBlockRecyclingStats();
+    REPORTER_ASSERT(r, stats.fCachedBlocks == 0);
+    REPORTER_ASSERT(r, stats.fCachedBytes == 0);
+
+    SkArenaAlloc::SetBlockRecycling(wasEnabled);
+}
@@ -10,10 +10,14 @@
 #ifdef SK_CODEC_DECODES_AVIF
 #include "include/codec/SkCodec.h"
 #include "include/core/SkBitmap.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkSize.h"
 #include "tests/Test.h"
 #include "tools/Resources.h"
 #include "tools/ToolUtils.h"
 
+#include <vector>
+
 struct AvifTestCase {
     const char* path;
     int imageWidth;
@@ -230,4 +234,58 @@ DEF_TEST(AvifDecodeAnimationWithAlpha, r) {
     run_avif_test(r, t);
 }
 
+// Decodes every frame of path with and without an executor, switching between the two, and checks
+// that the results match.
+static void run_avif_executor_test(skiatest::Reporter* r,
+                                   const char* path,
+                                   SkColorType colorType,
+                                   SkISize dimensions) {
+    auto codec = SkCodec::MakeFromData(GetResourceAsData(path));
+    if (!codec) {
+        ERRORF(r, "Could not create codec from %s", path);
+        return;
+    }
+    const SkImageInfo info = codec->getInfo().makeColorType(colorType).makeDimensions(dimensions);
+    auto executor = SkExecutor::MakeFIFOThreadPool(4);
+
+    auto decode = [&](int frameIndex, SkExecutor* exec, SkBitmap* bm) {
+        SkCodec::Options options;
+        options.fFrameIndex = frameIndex;
+        options.fExecutor = exec;
+        bm->allocPixels(info);
+        return SkCodec::kSuccess == codec->getPixels(bm->pixmap(), &options);
+    };
+
+    std::vector<SkBitmap> serial(codec->getFrameCount());
+    for (int i = 0; i < codec->getFrameCount(); ++i) {
+        REPORTER_ASSERT(r, decode(i, nullptr, &serial[i]), "%s frame %d", path, i);
+    }
+    // Switching between threaded and serial decodes recreates the AV1 decoder, which must then
+    // seek back to the frame it was asked for.
+    for (int i = 0; i < codec->getFrameCount(); ++i) {
+        for (SkExecutor* exec : {executor.get(), static_cast<SkExecutor*>(nullptr)}) {
+            SkBitmap bm;
+            REPORTER_ASSERT(r, decode(i, exec, &bm), "%s frame %d", path, i);
+            REPORTER_ASSERT(r, ToolUtils::equal_pixels(bm, serial[i]), "%s frame %d", path, i);
+        }
+    }
+}
+
+DEF_TEST(AvifDecodeWithExecutor, r) {
+    run_avif_executor_test(r, "images/alphabetAnim.avif", kRGBA_8888_SkColorType, {100, 100});
+}
+
+DEF_TEST(AvifDecodeAnimationWithAlphaWithExecutor, r) {
+    run_avif_executor_test(r, "images/example_1_animated.avif", kRGBA_8888_SkColorType,
+                           {256, 256});
+}
+
+DEF_TEST(AvifDecode10BitToRGBAF16BitmapWithExecutor, r) {
+    run_avif_executor_test(r, "images/example_3_10bit.avif", kRGBA_F16_SkColorType, {512, 512});
+}
+
+DEF_TEST(AvifDecode12BitToRGBAF16BitmapDownscaleWithExecutor, r) {
+    run_avif_executor_test(r, "images/example_3_12bit.avif", kRGBA_F16_SkColorType, {100, 100});
+}
+
 #endif  // SK_CODEC_DECODES_AVIF
@@ -61,6 +61,7 @@ namespace skgpu { namespace graphite { class Recorder; } }
 #include <atomic>
 #include <functional>
 #include <initializer_list>
+#include <memory>
 #include <string.h>
 #include <utility>
 
@@ -569,6 +570,100 @@ void tiled_image_caching_test(GrDirectContext* dContext,
 #endif
 }
 
+// Here the 16 tiles of the same image stream in two per frame, with the rest drawn from a
+// placeholder. Once they are all in, the result matches drawing the image without a streamer.
+void tiled_image_streaming_test(GrDirectContext* dContext,
+                                skgpu::graphite::Recorder* recorder,
+                                skiatest::Reporter* reporter) {
+    static const int kImageSize = 4096;
+    static const int kOverrideMaxTextureSize = 1024;
+    static const size_t kTileBytes = kOverrideMaxTextureSize * kOverrideMaxTextureSize * 4;
+
+    sk_sp<SkImage> img = make_big_bitmap_image(kImageSize,
+                                               /* whiteBandWidth= */ 0,
+                                               /* desiredLineWidth= */ 16,
+                                               /* desiredDepth= */ 7);
+
+    auto destII = SkImageInfo::Make(kImageSize, kImageSize,
+                                    kRGBA_8888_SkColorType,
+                                    kPremul_SkAlphaType);
+
+    sk_sp<SkSurface> surface;
+
+#if defined(SK_GANESH)
+    if (dContext) {
+        surface = SkSurfaces::RenderTarget(dContext, skgpu::Budgeted::kNo, destII);
+    }
+#endif
+
+#if defined(SK_GRAPHITE)
+    if (recorder) {
+        surface = SkSurfaces::RenderTarget(recorder, destII);
+    }
+#endif
+
+    if (!surface) {
+        return;
+    }
+
+    SkCanvas* canvas = surface->getCanvas();
+
+#if defined(SK_GANESH) && defined(GR_TEST_UTILS)
+    gOverrideMaxTextureSizeGanesh = kOverrideMaxTextureSize;
+#endif
+#if defined(SK_GRAPHITE) && defined(GRAPHITE_TEST_UTILS)
+    gOverrideMaxTextureSizeGraphite = kOverrideMaxTextureSize;
+#endif
+    const SkSamplingOptions sampling(SkFilterMode::kNearest, SkMipmapMode::kNone);
+    const SkRect bounds = SkRect::MakeIWH(kImageSize, kImageSize);
+
+    SkBitmap expected;
+    expected.allocPixels(destII);
+    canvas->clear(SK_ColorBLACK);
+    SkTiledImageUtils::DrawImageRect(canvas, img, bounds, bounds, sampling);
+    SkAssertResult(surface->readPixels(expected, 0, 0));
+
+    std::unique_ptr<SkTiledImageUtils::TileStreamer> streamer =
+            SkTiledImageUtils::TileStreamer::Make(/* uploadBudgetPerFrame= */ 2 * kTileBytes);
+    int frames = 0;
+    for (int placeholders = 14; placeholders >= 0; placeholders -= 2) {
+        streamer->newFrame();
+        canvas->clear(SK_ColorBLACK);
+        SkTiledImageUtils::DrawImageRect(canvas, img.get(), bounds, bounds, sampling,
+                                         /* paint= */ nullptr,
+                                         SkCanvas::kFast_SrcRectConstraint,
+                                         streamer.get());
+        REPORTER_ASSERT(reporter, streamer->placeholderTilesThisFrame() == placeholders,
+                        "Frame %d expected: %d Actual: %d",
+                        frames, placeholders, streamer->placeholderTilesThisFrame());
+        ++frames;
+    }
+    REPORTER_ASSERT(reporter, streamer->bytesUploadedThisFrame() == 2 * kTileBytes);
+
+    // Every tile is cached now, so nothing new is uploaded.
+    streamer->newFrame();
+    canvas->clear(SK_ColorBLACK);
+    SkTiledImageUtils::DrawImageRect(canvas, img.get(), bounds, bounds, sampling,
+                                     /* paint= */ nullptr, SkCanvas::kFast_SrcRectConstraint,
+                                     streamer.get());
+    REPORTER_ASSERT(reporter, streamer->placeholderTilesThisFrame() == 0);
+    REPORTER_ASSERT(reporter, streamer->bytesUploadedThisFrame() == 0);
+
+    SkBitmap actual;
+    actual.allocPixels(destII);
+    SkAssertResult(surface->readPixels(actual, 0, 0));
+    REPORTER_ASSERT(reporter,
+                    !memcmp(expected.getPixels(), actual.getPixels(), expected.computeByteSize()));
+
+    // reset to default behavior
+#if defined(SK_GANESH) && defined(GR_TEST_UTILS)
+    gOverrideMaxTextureSizeGanesh = 0;
+#endif
+#if defined(SK_GRAPHITE) && defined(GRAPHITE_TEST_UTILS)
+    gOverrideMaxTextureSizeGraphite = 0;
+#endif
+}
+
 } // anonymous namespace
 
 #if defined(SK_GANESH)
@@ -593,6 +688,15 @@ DEF_GANESH_TEST_FOR_RENDERING_CONTEXTS(TiledDrawCacheTest_Ganesh,
     tiled_image_caching_test(dContext, /* recorder= */ nullptr, reporter);
 }
 
+DEF_GANESH_TEST_FOR_RENDERING_CONTEXTS(TiledDrawStreamingTest_Ganesh,
+                                       reporter,
+                                       ctxInfo,
+                                       CtsEnforcement::kNever) {
+    auto dContext = ctxInfo.directContext();
+
+    tiled_image_streaming_test(dContext, /* recorder= */ nullptr, reporter);
+}
+
 #endif // SK_GANESH
 
 #if defined(SK_GRAPHITE)
@@ -618,4 +722,14 @@ DEF_GRAPHITE_TEST_FOR_RENDERING_CONTEXTS(TiledDrawCacheTest_Graphite,
     tiled_image_caching_test(/* dContext= */ nullptr, recorder.get(), reporter);
 }
 
+DEF_GRAPHITE_TEST_FOR_RENDERING_CONTEXTS(TiledDrawStreamingTest_Graphite,
+                                         reporter,
+                                         context,
+                                         CtsEnforcement::kNever) {
+    std::unique_ptr<skgpu::graphite::Recorder> recorder =
+            context->makeRecorder(ToolUtils::CreateTestingRecorderOptions());
+
+    tiled_image_streaming_test(/* dContext= */ nullptr, recorder.get(), reporter);
+}
+
 #endif // SK_GRAPHITE
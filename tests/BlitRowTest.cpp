@@ -0,0 +1,98 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkColor.h"
+#include "include/core/SkColorPriv.h"
+#include "include/private/SkColorData.h"
+#include "src/base/SkRandom.h"
+#include "src/core/SkBlitMask.h"
+#include "src/core/SkBlitRow.h"
+#include "tests/Test.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+// These lengths cover every tail of the 4, 8 and 16 pixel SIMD loops.
+static constexpr int kMaxLen = 70;
+
+static int max_channel_diff(SkPMColor a, SkPMColor b) {
+    int diff = 0;
+    for (int shift = 0; shift < 32; shift += 8) {
+        diff = std::max(diff, std::abs((int)((a >> shift) & 0xff) - (int)((b >> shift) & 0xff)));
+    }
+    return diff;
+}
+
+static SkPMColor random_pmcolor(SkRandom* rand) {
+    return SkPreMultiplyColor(rand->nextU());
+}
+
+DEF_TEST(BlitRow_S32A_Opaque, r) {
+    SkRandom rand;
+    for (int len = 0; len <= kMaxLen; ++len) {
+        SkPMColor src[kMaxLen], dst[kMaxLen + 1], expected[kMaxLen + 1];
+        for (int i = 0; i < len; ++i) {
+            src[i] = random_pmcolor(&rand);
+            dst[i] = random_pmcolor(&rand);
+            expected[i] = SkPMSrcOver(src[i], dst[i]);
+        }
+        dst[len] = expected[len] = 0xdeadbeef;
+
+        SkOpts::blit_row_s32a_opaque(dst, src, len, 0xFF);
+        for (int i = 0; i < len; ++i) {
+            // NEON rounds where SkPMSrcOver() truncates.
+            REPORTER_ASSERT(r, max_channel_diff(dst[i], expected[i]) <= 1,
+                            "len %d, pixel %d: %08x vs %08x", len, i, dst[i], expected[i]);
+        }
+        REPORTER_ASSERT(r, dst[len] == 0xdeadbeef, "len %d wrote past the end", len);
+    }
+}
+
+DEF_TEST(BlitMask_D32_A8, r) {
+    SkRandom rand;
+    const SkColor colors[] = {SK_ColorBLACK, 0xFF3080C0, 0x803080C0, 0x00000000};
+    for (SkColor color : colors) {
+        const SkPMColor pm = SkPreMultiplyColor(color);
+        const float sa = SkGetPackedA32(pm) / 255.0f;
+        for (int w = 1; w <= kMaxLen; ++w) {
+            constexpr int kH = 3, kRowPixels = kMaxLen + 1;
+            SkPMColor dst[kH * kRowPixels], orig[kH * kRowPixels];
+            SkAlpha mask[kH * kMaxLen];
+            for (int i = 0; i < kH * kRowPixels; ++i) {
+                dst[i] = orig[i] = random_pmcolor(&rand);
+            }
+            for (SkAlpha& aa : mask) {
+                aa = rand.nextU() & 0xff;
+            }
+
+            SkOpts::blit_mask_d32_a8(dst, kRowPixels * sizeof(SkPMColor), mask, kMaxLen,
+                                     color, w, kH);
+            for (int y = 0; y < kH; ++y) {
+                for (int x = 0; x < kRowPixels; ++x) {
+                    const SkPMColor got = dst[y*kRowPixels + x],
+                                    d   = orig[y*kRowPixels + x];
+                    if (x == w) {
+                        REPORTER_ASSERT(r, got == d, "w %d wrote past the end", w);
+                        break;
+                    }
+                    // s*aa + d*(1 - sa*aa), which the kernels approximate within a couple steps.
+                    const float aa = mask[y*kMaxLen + x] / 255.0f;
+                    SkPMColor expected = 0;
+                    for (int shift = 0; shift < 32; shift += 8) {
+                        const float c = ((pm >> shift) & 0xff) * aa +
+                                        ((d  >> shift) & 0xff) * (1 - sa * aa);
+                        expected |= (SkPMColor)std::lround(c) << shift;
+                    }
+                    REPORTER_ASSERT(r, max_channel_diff(got, expected) <= 3,
+                                    "color %08x, w %d, (%d,%d): %08x vs %08x",
+                                    color, w, x, y, got, expected);
+                }
+            }
+        }
+    }
+}
@@ -43,6 +43,7 @@
 #include "src/gpu/ganesh/ops/GrDrawOp.h"
 #include "src/gpu/ganesh/ops/GrOp.h"
 #include "src/gpu/ganesh/ops/OpsTask.h"
+#include "src/gpu/ganesh/ops/QuadPerEdgeAA.h"
 #include "src/gpu/ganesh/ops/TextureOp.h"
 #include "tests/CtsEnforcement.h"
 #include "tests/Test.h"
@@ -138,6 +139,10 @@ static void fillrectop_creation_test(skiatest::Reporter* reporter, GrDirectConte
 
     int actualTotNumQuads = 0;
 
+    if (skgpu::ganesh::QuadPerEdgeAA::MaxIndirectDraws(*dContext->priv().caps()) > 1) {
+        // Each of the runs of quads here fits in one op that draws them with indirect draws.
+        expectedNumOps = 1;
+    }
     for (int i = 0; i < actualNumOps; ++i) {
         const GrOp* tmp = opsTask->getChain(i);
         REPORTER_ASSERT(reporter, tmp->classID() == skgpu::ganesh::FillRectOp::ClassID());
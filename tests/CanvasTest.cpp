@@ -13,6 +13,7 @@
 #include "include/core/SkColorSpace.h"
 #include "include/core/SkColorType.h"
 #include "include/core/SkDocument.h"
+#include "include/core/SkGraphics.h"
 #include "include/core/SkImageFilter.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkMatrix.h"
@@ -38,12 +39,14 @@
 #include "include/utils/SkNWayCanvas.h"
 #include "include/utils/SkPaintFilterCanvas.h"
 #include "src/core/SkBigPicture.h"
+#include "src/core/SkLayerPixelPool.h"
 #include "src/core/SkRecord.h"
 #include "src/core/SkRecords.h"
 #include "src/utils/SkCanvasStack.h"
 #include "tests/Test.h"
 
 #include <cstddef>
+#include <cstring>
 #include <initializer_list>
 #include <memory>
 #include <utility>
@@ -788,3 +791,81 @@ DEF_GRAPHITE_TEST_FOR_RENDERING_CONTEXTS(TestManyDrawsGraphite, reporter, contex
     test_many_draws(reporter, surface.get());
 }
 #endif
+
+static void draw_nested_layers(SkCanvas* canvas, int frame) {
+    canvas->clear(SK_ColorWHITE);
+    SkPaint paint;
+    for (int i = 0; i < 4; ++i) {
+        // Vary the layer sizes from frame to frame so that blocks get reused for smaller layers.
+        const SkRect bounds = SkRect::MakeXYWH(4 * i, 3 * i, 60 - 7 * i - frame, 50 - 5 * i);
+        paint.setAlphaf(0.75f);
+        canvas->saveLayer(&bounds, &paint);
+        paint.setAlphaf(1);
+        paint.setColor(i & 1 ? SK_ColorBLUE : SK_ColorRED);
+        canvas->drawCircle(bounds.centerX() + frame, bounds.centerY(), 10 + 3 * i, paint);
+    }
+    canvas->restoreToCount(1);
+}
+
+DEF_SERIAL_TEST(Canvas_RasterLayerPool, r) {
+    REPORTER_ASSERT(r, SkLayerPixelPool::SizeClass(1) == 4096);
+    REPORTER_ASSERT(r, SkLayerPixelPool::SizeClass(4097) == 5120);
+    REPORTER_ASSERT(r, SkLayerPixelPool::SizeClass(5120) == 5120);
+    REPORTER_ASSERT(r, SkLayerPixelPool::SizeClass(8193) == 10240);
+
+    const SkImageInfo info = SkImageInfo::MakeN32Premul(64, 64);
+    auto expected = SkSurfaces::Raster(info);
+    auto actual = SkSurfaces::Raster(info);
+
+    SkGraphics::PurgeAllCaches();
+    const size_t prevLimit = SkGraphics::SetRasterLayerPoolByteLimit(1024 * 1024);
+    for (int frame = 0; frame < 5; ++frame) {
+        SkGraphics::SetRasterLayerPoolByteLimit(0);
+        draw_nested_layers(expected->getCanvas(), frame);
+        SkGraphics::SetRasterLayerPoolByteLimit(1024 * 1024);
+        draw_nested_layers(actual->getCanvas(), frame);
+
+        SkPixmap e, a;
+        SkAssertResult(expected->peekPixels(&e));
+        SkAssertResult(actual->peekPixels(&a));
+        for (int y = 0; y < info.height(); ++y) {
+            REPORTER_ASSERT(r, 0 == memcmp(e.addr(0, y), a.addr(0, y), e.info().minRowBytes()),
+                            "frame %d, row %d", frame, y);
+        }
+    }
+
+    // Later frames reused the memory of earlier frames' layers.
+    SkGraphics::RasterLayerPoolStats stats = SkGraphics::GetRasterLayerPoolStats();
+    REPORTER_ASSERT(r, stats.fReuses > 0);
+
+    SkGraphics::SetRasterLayerPoolByteLimit(prevLimit);
+    SkGraphics::PurgeAllCaches();
+
+    // A reused block is cleared, and blocks past the limit are freed instead of pooled.
+    SkLayerPixelPool pool(2 * 4096);
+    const SkImageInfo small = SkImageInfo::MakeN32Premul(16, 16);
+    {
+        SkBitmap a, b, c;
+        REPORTER_ASSERT(r, pool.allocPixels(small, &a));
+        REPORTER_ASSERT(r, pool.allocPixels(small, &b));
+        REPORTER_ASSERT(r, pool.allocPixels(small, &c));
+        c.eraseColor(SK_ColorRED);  // c is destroyed first, so its block is pooled
+        REPORTER_ASSERT(r, pool.stats().fBytesInUse == 3 * 4096);
+    }
+    SkLayerPixelPool::Stats poolStats = pool.stats();
+    REPORTER_ASSERT(r, poolStats.fBytesInUse == 0);
+    REPORTER_ASSERT(r, poolStats.fBytesPooled == 2 * 4096);
+    REPORTER_ASSERT(r, poolStats.fPeakBytesInUse == 3 * 4096);
+    {
+        SkBitmap a, b;
+        REPORTER_ASSERT(r, pool.allocPixels(small.makeWH(8, 8), &a));
+        REPORTER_ASSERT(r, pool.allocPixels(small, &b));
+        REPORTER_ASSERT(r, a.getColor(7, 7) == SK_ColorTRANSPARENT);
+        REPORTER_ASSERT(r, b.getColor(15, 15) == SK_ColorTRANSPARENT);
+        REPORTER_ASSERT(r, pool.stats().fReuses == 2);
+    }
+    pool.purgeAll();
+    poolStats = pool.stats();
+    REPORTER_ASSERT(r, poolStats.fBytesPooled == 0);
+    REPORTER_ASSERT(r, poolStats.fPeakBytesInUse == 0);
+}
@@ -8,12 +8,14 @@
 #include "include/codec/SkCodec.h"
 #include "include/core/SkBitmap.h"
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkStream.h"
 #include "include/core/SkString.h"
 #include "include/core/SkTypes.h"
 #include "include/private/base/SkDebug.h"
+#include "src/utils/SkPrefetchingStream.h"
 #include "tests/CodecPriv.h"
 #include "tests/FakeStreams.h"
 #include "tests/Test.h"
@@ -507,3 +509,48 @@ DEF_TEST(Codec_incomplete, r) {
         }
     }
 }
+
+// In non-blocking mode, SkPrefetchingStream returns only the bytes that have been read ahead so
+// far. The codec sees the rest as kIncompleteInput, and resumes once more bytes have arrived.
+DEF_TEST(Codec_partialPrefetchingStream, r) {
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(1);
+    for (const char* name : {"images/box.gif", "images/color_wheel.gif", "images/plane.png",
+                             "images/mandrill_256.png"}) {
+        sk_sp<SkData> file = GetResourceAsData(name);
+        SkBitmap truth;
+        if (!file || !create_truth(file, &truth)) {
+            continue;
+        }
+
+        // A small window keeps the read-ahead from getting far ahead of the decode.
+        auto owned = SkPrefetchingStream::Make(std::make_unique<SkMemoryStream>(file),
+                                               executor.get(), 256);
+        SkPrefetchingStream* stream = owned.get();
+        auto codec = SkCodec::MakeFromStream(std::move(owned));
+        if (!codec) {
+            ERRORF(r, "Failed to create codec for %s", name);
+            continue;
+        }
+        stream->setBlocking(false);
+
+        const SkImageInfo info = standardize_info(codec.get());
+        SkBitmap incremental;
+        incremental.allocPixels(info);
+        SkCodec::Result result;
+        while ((result = codec->startIncrementalDecode(info, incremental.getPixels(),
+                                                       incremental.rowBytes())) ==
+               SkCodec::kIncompleteInput && !stream->isAtEnd()) {
+            stream->waitForMoreData();
+        }
+        if (result != SkCodec::kSuccess) {
+            ERRORF(r, "Failed to start incremental decode of %s: %d", name, (int)result);
+            continue;
+        }
+        while ((result = codec->incrementalDecode()) == SkCodec::kIncompleteInput &&
+               !stream->isAtEnd()) {
+            stream->waitForMoreData();
+        }
+        REPORTER_ASSERT(r, result == SkCodec::kSuccess, "%s: %d", name, (int)result);
+        compare_bitmaps(r, truth, incremental);
+    }
+}
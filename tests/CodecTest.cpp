@@ -11,6 +11,7 @@
 #include "include/codec/SkGifDecoder.h"
 #include "include/codec/SkJpegDecoder.h"
 #include "include/codec/SkPngChunkReader.h"
+#include "include/codec/SkRawDecoder.h"
 #include "include/core/SkAlphaType.h"
 #include "include/core/SkBitmap.h"
 #include "include/core/SkCanvas.h"
@@ -19,6 +20,7 @@
 #include "include/core/SkColorType.h"
 #include "include/core/SkData.h"
 #include "include/core/SkDataTable.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkImageGenerator.h"
 #include "include/core/SkImageInfo.h"
@@ -59,6 +61,7 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <cstdlib>
 #include <cstring>
 #include <initializer_list>
 #include <memory>
@@ -943,6 +946,89 @@ DEF_TEST(Codec_raw_notseekable, r) {
 
     test_info(r, codec.get(), codec->getInfo(), SkCodec::kSuccess, nullptr);
 }
+
+// Rendering the DNG and converting it into the destination in bands on an executor should match
+// doing it all on one thread.
+DEF_TEST(Codec_raw_executor, r) {
+    constexpr char path[] = "images/sample_1mp.dng";
+    sk_sp<SkData> data(GetResourceAsData(path));
+    if (!data) {
+        SkDebugf("Missing resource '%s'\n", path);
+        return;
+    }
+
+    auto executor = SkExecutor::MakeFIFOThreadPool(4);
+    for (float scale : {1.f, 0.5f}) {
+        std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(data);
+        REPORTER_ASSERT(r, codec);
+        if (!codec) {
+            return;
+        }
+        const SkImageInfo info = codec->getInfo().makeDimensions(
+                codec->getScaledDimensions(scale));
+
+        SkBitmap serial, parallel;
+        serial.allocPixels(info);
+        parallel.allocPixels(info);
+        REPORTER_ASSERT(r, SkCodec::kSuccess == codec->getPixels(serial.pixmap()));
+
+        codec = SkCodec::MakeFromData(data);
+        SkCodec::Options options;
+        options.fExecutor = executor.get();
+        REPORTER_ASSERT(r, SkCodec::kSuccess == codec->getPixels(parallel.pixmap(), &options));
+        REPORTER_ASSERT(r, md5(serial) == md5(parallel), "scale %g", scale);
+    }
+}
+
+// The embedded JPEG thumbnail is only used when the client asks for it, and then only for
+// downscaled decodes, where it should still look like the rendered DNG.
+DEF_TEST(Codec_raw_thumbnail, r) {
+    constexpr char path[] = "images/dng_with_preview.dng";
+    sk_sp<SkData> data(GetResourceAsData(path));
+    if (!data) {
+        SkDebugf("Missing resource '%s'\n", path);
+        return;
+    }
+
+    SkRawDecoder::DecodeOptions decodeOptions;
+    decodeOptions.fUseEmbeddedThumbnail = true;
+    for (float scale : {1.f, 0.f}) {
+        std::unique_ptr<SkCodec> rendered = SkRawDecoder::Decode(data, nullptr);
+        std::unique_ptr<SkCodec> preview = SkRawDecoder::Decode(data, nullptr, &decodeOptions);
+        REPORTER_ASSERT(r, rendered && preview);
+        if (!rendered || !preview) {
+            return;
+        }
+        const SkImageInfo info = rendered->getInfo().makeDimensions(
+                rendered->getScaledDimensions(scale));
+
+        SkBitmap renderedBm, previewBm;
+        renderedBm.allocPixels(info);
+        previewBm.allocPixels(info);
+        REPORTER_ASSERT(r, SkCodec::kSuccess == rendered->getPixels(renderedBm.pixmap()));
+        REPORTER_ASSERT(r, SkCodec::kSuccess == preview->getPixels(previewBm.pixmap()));
+
+        if (scale == 1.f) {
+            REPORTER_ASSERT(r, md5(renderedBm) == md5(previewBm));
+            continue;
+        }
+
+        // The camera renders the thumbnail its own way, so only check that it shows the same
+        // image, not a crop or a rotation of it.
+        double totalDiff = 0;
+        for (int y = 0; y < info.height(); ++y) {
+            for (int x = 0; x < info.width(); ++x) {
+                const SkColor a = renderedBm.getColor(x, y),
+                              b = previewBm.getColor(x, y);
+                totalDiff += std::abs((int)SkColorGetR(a) - (int)SkColorGetR(b)) +
+                             std::abs((int)SkColorGetG(a) - (int)SkColorGetG(b)) +
+                             std::abs((int)SkColorGetB(a) - (int)SkColorGetB(b));
+            }
+        }
+        const double meanDiff = totalDiff / (3.0 * info.width() * info.height());
+        REPORTER_ASSERT(r, meanDiff < 32, "mean channel difference %g", meanDiff);
+    }
+}
 #endif
 
 // Test that even if webp_parse_header fails to peek enough, it will fall back to read()
@@ -2081,3 +2167,78 @@ DEF_TEST(Codec_jpeg_can_return_data_from_original_stream, r) {
     REPORTER_ASSERT(r, encodedData->size() == expectedBytes);
     REPORTER_ASSERT(r, SkJpegDecoder::IsJpeg(encodedData->data(), encodedData->size()));
 }
+
+DEF_TEST(Codec_jpeg_restart_stripes, r) {
+    // A 4032x3024 baseline image with a restart marker after every MCU row.
+    constexpr char path[] = "images/iphone_13_pro.jpeg";
+    sk_sp<SkData> data = GetResourceAsData(path);
+    if (!data) {
+        SkDebugf("Missing resource '%s'\n", path);
+        return;
+    }
+
+    auto executor = SkExecutor::MakeFIFOThreadPool(4);
+    for (sk_sp<SkColorSpace> colorSpace : {sk_sp<SkColorSpace>(), SkColorSpace::MakeSRGB()}) {
+        std::unique_ptr<SkCodec> codec = SkJpegDecoder::Decode(data, nullptr);
+        REPORTER_ASSERT(r, codec);
+        if (!codec) {
+            return;
+        }
+        const SkImageInfo info = codec->getInfo().makeColorSpace(colorSpace);
+
+        SkBitmap serial, parallel;
+        serial.allocPixels(info);
+        parallel.allocPixels(info);
+        REPORTER_ASSERT(r, SkCodec::kSuccess == codec->getPixels(serial.pixmap()));
+
+        SkCodec::Options options;
+        options.fExecutor = executor.get();
+        REPORTER_ASSERT(r, SkCodec::kSuccess == codec->getPixels(parallel.pixmap(), &options));
+
+        // Every stripe decodes the rows around its edges, so it should match exactly.
+        REPORTER_ASSERT(r, md5(serial) == md5(parallel));
+    }
+}
+
+DEF_TEST(Codec_jpeg_restart_seek, r) {
+    constexpr char path[] = "images/iphone_13_pro.jpeg";
+    sk_sp<SkData> data = GetResourceAsData(path);
+    if (!data) {
+        SkDebugf("Missing resource '%s'\n", path);
+        return;
+    }
+    auto codec = SkAndroidCodec::MakeFromCodec(SkJpegDecoder::Decode(data, nullptr));
+    REPORTER_ASSERT(r, codec);
+    if (!codec) {
+        return;
+    }
+
+    // Subset decodes far enough down the image start at a restart marker instead of skipping
+    // every row above. Compare each with the bottom of a subset that starts at the top.
+    auto decode = [&](const SkIRect& subset, int sampleSize, SkBitmap* bm) {
+        SkAndroidCodec::AndroidOptions options;
+        options.fSubset = &subset;
+        options.fSampleSize = sampleSize;
+        const SkISize size = codec->getSampledSubsetDimensions(sampleSize, subset);
+        bm->allocPixels(codec->getInfo().makeDimensions(size));
+        return SkCodec::kSuccess ==
+               codec->getAndroidPixels(bm->info(), bm->getPixels(), bm->rowBytes(), &options);
+    };
+    for (int sampleSize : {1, 2}) {
+        for (const SkIRect& tile : {SkIRect::MakeXYWH(0, 1024, 512, 512),
+                                    SkIRect::MakeXYWH(1000, 2000, 700, 300),
+                                    SkIRect::MakeXYWH(2500, 3800, 500, 232)}) {
+            SkBitmap seeked, full;
+            REPORTER_ASSERT(r, decode(tile, sampleSize, &seeked));
+            REPORTER_ASSERT(r, decode(SkIRect::MakeLTRB(tile.left(), 0, tile.right(),
+                                                         tile.bottom()),
+                                      sampleSize, &full));
+            SkBitmap fullBottom;
+            REPORTER_ASSERT(r, full.extractSubset(&fullBottom,
+                    SkIRect::MakeXYWH(0, full.height() - seeked.height(),
+                                      seeked.width(), seeked.height())));
+            REPORTER_ASSERT(r, md5(seeked) == md5(fullBottom),
+                            "tile %d,%d at sample size %d", tile.x(), tile.y(), sampleSize);
+        }
+    }
+}
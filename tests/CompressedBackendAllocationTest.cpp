@@ -6,6 +6,7 @@
  */
 
 #include "include/core/SkAlphaType.h"
+#include "include/core/SkBitmap.h"
 #include "include/core/SkBlendMode.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColor.h"
@@ -375,3 +376,49 @@ DEF_GANESH_TEST_FOR_RENDERING_CONTEXTS(CompressedBackendAllocationTest,
         }
     }
 }
+
+// Test making compressed textures from images by encoding them on the CPU
+DEF_GANESH_TEST_FOR_RENDERING_CONTEXTS(CompressedTextureFromImageTest,
+                                       reporter,
+                                       ctxInfo,
+                                       CtsEnforcement::kNever) {
+    auto dContext = ctxInfo.directContext();
+
+    // Pure colors are exact in all the formats.
+    SkBitmap bitmap;
+    bitmap.allocPixels(SkImageInfo::Make(70, 50, kRGBA_8888_SkColorType, kOpaque_SkAlphaType));
+    bitmap.eraseColor(SK_ColorRED);
+    bitmap.setImmutable();
+    sk_sp<SkImage> image = bitmap.asImage();
+
+    for (auto compression : {SkTextureCompressionType::kETC2_RGB8_UNORM,
+                             SkTextureCompressionType::kBC1_RGB8_UNORM,
+                             SkTextureCompressionType::kBC1_RGBA8_UNORM}) {
+        for (auto mipmapped : {skgpu::Mipmapped::kNo, skgpu::Mipmapped::kYes}) {
+            sk_sp<SkImage> compressed = SkImages::CompressedTextureFromImage(
+                    dContext, image.get(), compression, mipmapped);
+            if (!dContext->compressedBackendFormat(compression).isValid()) {
+                REPORTER_ASSERT(reporter, !compressed);
+                continue;
+            }
+            if (!compressed) {
+                ERRORF(reporter, "Could not compress to %s",
+                       skgpu::CompressionTypeToStr(compression));
+                continue;
+            }
+            REPORTER_ASSERT(reporter, compressed->isTextureBacked());
+            REPORTER_ASSERT(reporter, compressed->dimensions() == image->dimensions());
+            check_readback(dContext, compressed, compression, SkColors::kRed, reporter,
+                           "compressed from image");
+        }
+    }
+
+    // Images with alpha are left to the caller.
+    SkBitmap translucent;
+    translucent.allocN32Pixels(8, 8);
+    translucent.eraseColor(SK_ColorTRANSPARENT);
+    sk_sp<SkImage> translucentImage = translucent.asImage();
+    REPORTER_ASSERT(reporter, !SkImages::CompressedTextureFromImage(
+                                      dContext, translucentImage.get(),
+                                      SkTextureCompressionType::kBC1_RGBA8_UNORM));
+}
@@ -0,0 +1,89 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkColorPriv.h"
+#include "include/core/SkData.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkPixmap.h"
+#include "include/core/SkSize.h"
+#include "include/core/SkTextureCompressionType.h"
+#include "src/core/SkCompressedDataUtils.h"
+#include "tests/Test.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+
+// A smooth image, with a sharp edge and a flat area, that isn't a multiple of the block size.
+static SkBitmap make_source() {
+    SkBitmap bm;
+    bm.allocPixels(SkImageInfo::Make(37, 21, kRGBA_8888_SkColorType, kOpaque_SkAlphaType));
+    for (int y = 0; y < bm.height(); ++y) {
+        for (int x = 0; x < bm.width(); ++x) {
+            uint8_t* p = static_cast<uint8_t*>(bm.getAddr(x, y));
+            if (x >= 24) {
+                p[0] = 40, p[1] = 160, p[2] = 220;
+            } else {
+                p[0] = 10 * x;
+                p[1] = 12 * y;
+                p[2] = x < 12 ? 30 : 200;
+            }
+            p[3] = 0xFF;
+        }
+    }
+    return bm;
+}
+
+DEF_TEST(CompressedDataUtils_RoundTrip, reporter) {
+    const SkBitmap src = make_source();
+
+    for (SkTextureCompressionType type : {SkTextureCompressionType::kETC2_RGB8_UNORM,
+                                          SkTextureCompressionType::kBC1_RGB8_UNORM,
+                                          SkTextureCompressionType::kBC1_RGBA8_UNORM}) {
+        size_t size = SkCompressedDataSize(type, src.dimensions(), nullptr, false);
+        sk_sp<SkData> data = SkData::MakeUninitialized(size);
+        if (!SkCompress(src.pixmap(), type, data->writable_data())) {
+            ERRORF(reporter, "Could not compress to type %d", (int)type);
+            continue;
+        }
+
+        SkBitmap dst;
+        dst.allocPixels(SkImageInfo::MakeN32(src.width(), src.height(), kOpaque_SkAlphaType));
+        REPORTER_ASSERT(reporter, SkDecompress(data, src.dimensions(), type, &dst));
+
+        int totalError = 0, maxFlatError = 0;
+        for (int y = 0; y < src.height(); ++y) {
+            for (int x = 0; x < src.width(); ++x) {
+                const uint8_t* s = static_cast<const uint8_t*>(src.getAddr(x, y));
+                SkPMColor d = *dst.getAddr32(x, y);
+                REPORTER_ASSERT(reporter, SkGetPackedA32(d) == 0xFF);
+                const int error = std::abs(s[0] - (int)SkGetPackedR32(d)) +
+                                  std::abs(s[1] - (int)SkGetPackedG32(d)) +
+                                  std::abs(s[2] - (int)SkGetPackedB32(d));
+                totalError += error;
+                if (x >= 28) {
+                    maxFlatError = std::max(maxFlatError, error);
+                }
+            }
+        }
+        // Both formats should keep a solid color within a few steps of its 5 or 6 bit value and
+        // the image as a whole within a little over that.
+        const float meanError = totalError / (3.0f * src.width() * src.height());
+        REPORTER_ASSERT(reporter, maxFlatError <= 12, "type %d flat error %d",
+                        (int)type, maxFlatError);
+        REPORTER_ASSERT(reporter, meanError < 5, "type %d mean error %f", (int)type, meanError);
+    }
+
+    // Only RGBA_8888 is read.
+    SkBitmap bgra;
+    bgra.allocPixels(SkImageInfo::Make(4, 4, kBGRA_8888_SkColorType, kOpaque_SkAlphaType));
+    uint8_t block[8];
+    REPORTER_ASSERT(reporter,
+                    !SkCompress(bgra.pixmap(), SkTextureCompressionType::kBC1_RGB8_UNORM, block));
+}
@@ -11,8 +11,11 @@
 #include "include/core/SkColor.h"
 #include "include/core/SkColorSpace.h"
 #include "include/core/SkColorType.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkPaint.h"
+#include "include/core/SkPicture.h"
+#include "include/core/SkPictureRecorder.h"
 #include "include/core/SkRect.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkSize.h"
@@ -47,6 +50,7 @@
 #include <initializer_list>
 #include <memory>
 #include <utility>
+#include <vector>
 
 class SkImage;
 struct GrContextOptions;
@@ -1315,6 +1319,53 @@ DEF_GANESH_TEST_FOR_RENDERING_CONTEXTS(DDLMultipleDDLs, reporter, ctxInfo, CtsEn
     }
 }
 
+DEF_GANESH_TEST_FOR_RENDERING_CONTEXTS(DDLRecordTiled, reporter, ctxInfo, CtsEnforcement::kNever) {
+    auto context = ctxInfo.directContext();
+
+    SkImageInfo ii = SkImageInfo::MakeN32Premul(100, 70);
+    sk_sp<SkSurface> s = SkSurfaces::RenderTarget(context, skgpu::Budgeted::kNo, ii);
+
+    GrSurfaceCharacterization characterization;
+    SkAssertResult(s->characterize(&characterization));
+
+    SkPictureRecorder pictureRecorder;
+    SkCanvas* canvas = pictureRecorder.beginRecording(SkRect::Make(ii.bounds()));
+    canvas->clear(SK_ColorRED);
+    SkPaint p;
+    p.setColor(SK_ColorGREEN);
+    canvas->drawRect(SkRect::MakeLTRB(10, 10, 90, 60), p);
+    sk_sp<SkPicture> picture = pictureRecorder.finishRecordingAsPicture();
+
+    REPORTER_ASSERT(reporter, GrDeferredDisplayListRecorder::RecordTiled(
+                                      picture.get(), characterization, {0, 32}, nullptr).empty());
+
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(2);
+    std::vector<sk_sp<GrDeferredDisplayList>> ddls = GrDeferredDisplayListRecorder::RecordTiled(
+            picture.get(), characterization, {32, 32}, executor.get());
+    // The last column and row of tiles are cut short by the surface.
+    REPORTER_ASSERT(reporter, ddls.size() == 4 * 3);
+
+    // Drawing the tiles backwards makes sure none of them draws outside of itself.
+    for (auto ddl = ddls.rbegin(); ddl != ddls.rend(); ++ddl) {
+        REPORTER_ASSERT(reporter, skgpu::ganesh::DrawDDL(s, *ddl));
+    }
+
+    SkBitmap bitmap;
+    bitmap.allocPixels(ii);
+    s->readPixels(ii, bitmap.getPixels(), bitmap.rowBytes(), 0, 0);
+    for (int y = 0; y < ii.height(); ++y) {
+        for (int x = 0; x < ii.width(); ++x) {
+            bool inRect = x >= 10 && x < 90 && y >= 10 && y < 60;
+            SkColor expected = inRect ? SK_ColorGREEN : SK_ColorRED;
+            if (bitmap.getColor(x, y) != expected) {
+                ERRORF(reporter, "Expected 0x%08x at (%d, %d), got 0x%08x",
+                       expected, x, y, bitmap.getColor(x, y));
+                return; // we only really need to report the error once
+            }
+        }
+    }
+}
+
 #ifdef SK_GL
 
 static sk_sp<GrPromiseImageTexture> noop_fulfill_proc(void*) {
@@ -8,10 +8,17 @@
 #include "include/core/SkRefCnt.h"
 #include "include/private/chromium/SkDiscardableMemory.h"
 #include "src/lazy/SkDiscardableMemoryPool.h"
+#include "src/lazy/SkPurgeablePages.h"
 #include "tests/Test.h"
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 
+#if defined(SK_BUILD_FOR_UNIX) || defined(SK_BUILD_FOR_ANDROID)
+    #include <sys/mman.h>
+#endif
+
 DEF_TEST(DiscardableMemoryPool, reporter) {
     sk_sp<SkDiscardableMemoryPool> pool(SkDiscardableMemoryPool::Make(1));
     pool->setRAMBudget(3);
@@ -36,3 +43,50 @@ DEF_TEST(DiscardableMemoryPool, reporter) {
     REPORTER_ASSERT(reporter, !dm2->lock());
     REPORTER_ASSERT(reporter, 0 == pool->getRAMUsed());
 }
+
+#if defined(SK_BUILD_FOR_UNIX) || defined(SK_BUILD_FOR_ANDROID)
+// Reclaims the memory now, as the kernel would under memory pressure.
+static void reclaim(void* addr, size_t bytes) {
+    madvise(addr, bytes, MADV_DONTNEED);
+}
+
+DEF_TEST(DiscardableMemoryPool_Purgeable, reporter) {
+    constexpr size_t kBytes = 128 * 1024;
+    std::unique_ptr<SkPurgeablePages> pages = SkPurgeablePages::Make(kBytes);
+    if (!pages) {
+        return;  // this kernel can't purge pages
+    }
+    auto bytes = static_cast<uint8_t*>(pages->data());
+    for (size_t i = 0; i < kBytes; ++i) {
+        bytes[i] = static_cast<uint8_t>(i * 7 + 1);
+    }
+    pages->unlock();
+    // The kernel is free to reclaim it, but if it didn't, it's all still there.
+    if (pages->lock()) {
+        bool intact = true;
+        for (size_t i = 0; i < kBytes; ++i) {
+            intact &= bytes[i] == static_cast<uint8_t>(i * 7 + 1);
+        }
+        REPORTER_ASSERT(reporter, intact);
+    }
+    pages->unlock();
+    reclaim(bytes, 1);
+    REPORTER_ASSERT(reporter, !pages->lock());
+
+    // A purgeable pool drops memory the kernel reclaimed when it's next locked.
+    sk_sp<SkDiscardableMemoryPool> pool = SkDiscardableMemoryPool::MakePurgeable(4 * kBytes);
+    std::unique_ptr<SkDiscardableMemory> dm(pool->create(kBytes));
+    void* addr = dm->data();
+    dm->unlock();
+    REPORTER_ASSERT(reporter, kBytes == pool->getRAMUsed());
+    reclaim(addr, kBytes);
+    REPORTER_ASSERT(reporter, !dm->lock());
+    REPORTER_ASSERT(reporter, 0 == pool->getRAMUsed());
+
+    // Small allocations aren't purgeable by the kernel, but still by the pool's budget.
+    std::unique_ptr<SkDiscardableMemory> small(pool->create(100));
+    small->unlock();
+    REPORTER_ASSERT(reporter, small->lock());
+    small->unlock();
+}
+#endif
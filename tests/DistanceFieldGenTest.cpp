@@ -0,0 +1,252 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkExecutor.h"
+#include "include/core/SkTypes.h"
+#include "include/private/base/SkTo.h"
+#include "src/base/SkRandom.h"
+#include "src/core/SkDistanceFieldGen.h"
+#include "src/core/SkMask.h"
+#include "tests/Test.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+#if !defined(SK_DISABLE_SDF_TEXT)
+
+// The kernels as built for the default target, to compare with the ones SkOpts picked for this
+// CPU, which are the hsw ones on CPUs with AVX2.
+#define SK_OPTS_NS dftest
+#define SK_OPTS_TARGET SK_OPTS_TARGET_DEFAULT
+#include "src/opts/SkOpts_SetTarget.h"
+#include "src/opts/SkDistanceFieldGen_opts.h"
+#include "src/opts/SkOpts_RestoreTarget.h"
+
+namespace {
+
+struct TestImage {
+    int fWidth, fHeight;
+    std::vector<uint8_t> fPixels;
+};
+
+// A disc with an antialiased edge, off center so that rows and columns of the distance field
+// differ, and wide enough that the SIMD kernels handle most of each row.
+TestImage make_disc(int width, int height, float radius) {
+    TestImage image{width, height, std::vector<uint8_t>(width * height)};
+    const float cx = width * 0.4f, cy = height * 0.55f;
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            const float d = sqrtf((x - cx) * (x - cx) + (y - cy) * (y - cy)) - radius;
+            image.fPixels[y * width + x] =
+                    d < -0.5f ? 255 : d > 0.5f ? 0 : static_cast<uint8_t>((0.5f - d) * 255);
+        }
+    }
+    return image;
+}
+
+}  // namespace
+
+DEF_TEST(DistanceFieldGen_Disc, r) {
+    const TestImage image = make_disc(45, 38, 12);
+    std::vector<uint8_t> distanceField(SkComputeDistanceFieldSize(image.fWidth, image.fHeight));
+    REPORTER_ASSERT(r, SkGenerateDistanceFieldFromA8Image(distanceField.data(),
+                                                          image.fPixels.data(),
+                                                          image.fWidth, image.fHeight,
+                                                          image.fWidth));
+
+    // Inside the glyph the field is above 128, outside it below, and it falls off moving out
+    // from the center.
+    const int width = image.fWidth + 2 * SK_DistanceFieldPad;
+    auto at = [&](int x, int y) {
+        return distanceField[(y + SK_DistanceFieldPad) * width + x + SK_DistanceFieldPad];
+    };
+    const int cx = 18, cy = 21;
+    REPORTER_ASSERT(r, at(cx, cy) > 128);
+    REPORTER_ASSERT(r, at(0, 0) < 128);
+    REPORTER_ASSERT(r, at(image.fWidth - 1, cy) < 128);
+    for (int x = cx; x < image.fWidth - 1; ++x) {
+        REPORTER_ASSERT(r, at(x, cy) >= at(x + 1, cy), "x = %d", x);
+    }
+}
+
+DEF_TEST(DistanceFieldGen_Batch, r) {
+    // The batch gives each glyph the same distance field it would get alone, with or without
+    // an executor.
+    std::vector<TestImage> images;
+    for (int i = 0; i < 40; ++i) {
+        images.push_back(make_disc(3 + i * 7 % 61, 2 + i * 5 % 43, 1 + i % 15));
+    }
+
+    std::vector<std::vector<uint8_t>> expected;
+    for (const TestImage& image : images) {
+        std::vector<uint8_t>& distanceField = expected.emplace_back(
+                SkComputeDistanceFieldSize(image.fWidth, image.fHeight));
+        SkGenerateDistanceFieldFromA8Image(distanceField.data(), image.fPixels.data(),
+                                           image.fWidth, image.fHeight, image.fWidth);
+    }
+
+    std::unique_ptr<SkExecutor> pool = SkExecutor::MakeFIFOThreadPool(4);
+    for (SkExecutor* executor : {static_cast<SkExecutor*>(nullptr), pool.get()}) {
+        std::vector<std::vector<uint8_t>> distanceFields;
+        std::vector<SkDistanceFieldGlyph> glyphs;
+        for (const TestImage& image : images) {
+            distanceFields.emplace_back(SkComputeDistanceFieldSize(image.fWidth, image.fHeight));
+        }
+        for (size_t i = 0; i < images.size(); ++i) {
+            glyphs.push_back({distanceFields[i].data(), images[i].fPixels.data(),
+                              SkMask::kA8_Format, images[i].fWidth, images[i].fHeight,
+                              static_cast<size_t>(images[i].fWidth)});
+        }
+        REPORTER_ASSERT(r, SkGenerateDistanceFields(glyphs, executor));
+        REPORTER_ASSERT(r, distanceFields == expected);
+    }
+
+    // A glyph in a format without a distance field fails the batch, but not the other glyphs.
+    std::vector<uint8_t> distanceField(expected[0].size());
+    const SkDistanceFieldGlyph glyphs[] = {
+            {distanceField.data(), images[0].fPixels.data(), SkMask::kARGB32_Format,
+             images[0].fWidth, images[0].fHeight, static_cast<size_t>(images[0].fWidth)},
+            {distanceField.data(), images[0].fPixels.data(), SkMask::kA8_Format,
+             images[0].fWidth, images[0].fHeight, static_cast<size_t>(images[0].fWidth)},
+    };
+    REPORTER_ASSERT(r, !SkGenerateDistanceFields(glyphs, pool.get()));
+    REPORTER_ASSERT(r, distanceField == expected[0]);
+}
+
+namespace {
+
+// Longer than a few vectors of either target, and not a multiple of their widths, so that the
+// scalar tails run too.
+constexpr int kKernelCount = 45;
+
+// A row with a readable pixel on either side of its kKernelCount pixels.
+template <typename T>
+struct PaddedRow {
+    T* data() { return fPixels + 1; }
+    T fPixels[kKernelCount + 2];
+};
+
+struct PaddedTransformRow {
+    SkDistanceFieldRow row() { return {fDistSq.data(), fX.data(), fY.data()}; }
+    PaddedRow<float> fDistSq, fX, fY;
+};
+
+uint8_t random_alpha(SkRandom* random) {
+    // Mostly the values around the edge thresholds.
+    static constexpr uint8_t kValues[] = {0, 1, 126, 127, 128, 129, 254, 255};
+    return random->nextBool() ? kValues[random->nextULessThan(std::size(kValues))]
+                              : SkToU8(random->nextULessThan(256));
+}
+
+// A vector to the nearest edge, with whole offsets so that candidates tie, or a far pixel that
+// has yet to find an edge.
+void random_transform(SkRandom* random, float* distSq, float* x, float* y) {
+    if (random->nextULessThan(8) == 0) {
+        *distSq = 1e6f;
+        *x = *y = 1000.f;
+        return;
+    }
+    *x = random->nextRangeF(-20, 20);
+    *y = random->nextRangeF(-20, 20);
+    *x = random->nextBool() ? std::round(*x) : *x;
+    *y = random->nextBool() ? std::round(*y) : *y;
+    *distSq = *x * *x + *y * *y;
+}
+
+void randomize(SkRandom* random, PaddedTransformRow* row) {
+    for (int i = 0; i < kKernelCount + 2; ++i) {
+        random_transform(random, &row->fDistSq.fPixels[i], &row->fX.fPixels[i],
+                         &row->fY.fPixels[i]);
+    }
+}
+
+bool same(const PaddedTransformRow& a, const PaddedTransformRow& b) {
+    return !memcmp(&a, &b, sizeof(PaddedTransformRow));
+}
+
+}  // namespace
+
+// The SIMD kernels of every target, and their scalar tails, give exactly the same results.
+DEF_TEST(DistanceFieldGen_Kernels, r) {
+    SkOpts::Init_DistanceFieldGen();
+    SkRandom random;
+
+    for (int trial = 0; trial < 200; ++trial) {
+        PaddedRow<uint8_t> image[3];
+        for (PaddedRow<uint8_t>& row : image) {
+            for (uint8_t& pixel : row.fPixels) {
+                pixel = random_alpha(&random);
+            }
+        }
+        PaddedRow<float> alpha[3] = {};
+        PaddedRow<uint8_t> edges[3] = {};
+        dftest::distance_field_find_edges(image[0].data(), image[1].data(), image[2].data(),
+                                          alpha[0].data(), edges[0].data(), kKernelCount);
+        SkOpts::distance_field_find_edges(image[0].data(), image[1].data(), image[2].data(),
+                                          alpha[1].data(), edges[1].data(), kKernelCount);
+        for (int i = 0; i < kKernelCount; ++i) {
+            dftest::distance_field_find_edges(image[0].data() + i, image[1].data() + i,
+                                              image[2].data() + i, alpha[2].data() + i,
+                                              edges[2].data() + i, 1);
+        }
+        for (int k : {1, 2}) {
+            REPORTER_ASSERT(r, !memcmp(&alpha[0], &alpha[k], sizeof(alpha[0])), "trial %d", trial);
+            REPORTER_ASSERT(r, !memcmp(&edges[0], &edges[k], sizeof(edges[0])), "trial %d", trial);
+        }
+
+        PaddedRow<float> distSq;
+        for (float& d : distSq.fPixels) {
+            d = random.nextBool() ? std::round(random.nextRangeF(0, 64)) : random.nextRangeF(0, 64);
+        }
+        PaddedRow<uint8_t> packed[3] = {};
+        dftest::distance_field_pack(distSq.data(), alpha[0].data(), packed[0].data(),
+                                    kKernelCount);
+        SkOpts::distance_field_pack(distSq.data(), alpha[0].data(), packed[1].data(),
+                                    kKernelCount);
+        for (int i = 0; i < kKernelCount; ++i) {
+            dftest::distance_field_pack(distSq.data() + i, alpha[0].data() + i,
+                                        packed[2].data() + i, 1);
+        }
+        for (int k : {1, 2}) {
+            REPORTER_ASSERT(r, !memcmp(&packed[0], &packed[k], sizeof(packed[0])),
+                            "trial %d", trial);
+        }
+
+        PaddedTransformRow neighbors;
+        randomize(&random, &neighbors);
+        PaddedTransformRow rows[3];
+        randomize(&random, &rows[0]);
+        rows[1] = rows[2] = rows[0];
+        dftest::distance_field_nearest_above(rows[0].row(), neighbors.row(), edges[0].data(),
+                                             kKernelCount);
+        SkOpts::distance_field_nearest_above(rows[1].row(), neighbors.row(), edges[0].data(),
+                                             kKernelCount);
+        for (int i = 0; i < kKernelCount; ++i) {
+            const SkDistanceFieldRow row = rows[2].row(), above = neighbors.row();
+            dftest::distance_field_nearest_above({row.fDistSq + i, row.fX + i, row.fY + i},
+                                                 {above.fDistSq + i, above.fX + i, above.fY + i},
+                                                 edges[0].data() + i, 1);
+        }
+        REPORTER_ASSERT(r, same(rows[0], rows[1]) && same(rows[0], rows[2]), "trial %d", trial);
+
+        dftest::distance_field_nearest_below(rows[0].row(), neighbors.row(), kKernelCount);
+        SkOpts::distance_field_nearest_below(rows[1].row(), neighbors.row(), kKernelCount);
+        for (int i = 0; i < kKernelCount; ++i) {
+            const SkDistanceFieldRow row = rows[2].row(), below = neighbors.row();
+            dftest::distance_field_nearest_below({row.fDistSq + i, row.fX + i, row.fY + i},
+                                                 {below.fDistSq + i, below.fX + i, below.fY + i},
+                                                 1);
+        }
+        REPORTER_ASSERT(r, same(rows[0], rows[1]) && same(rows[0], rows[2]), "trial %d", trial);
+    }
+}
+
+#endif  // !defined(SK_DISABLE_SDF_TEXT)
@@ -6,12 +6,14 @@
  */
 
 #include "include/core/SkBitmap.h"
+#include "include/core/SkBlendMode.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColor.h"
 #include "include/core/SkImage.h" // IWYU pragma: keep
 #include "include/core/SkMatrix.h"
 #include "include/core/SkPaint.h"
 #include "include/core/SkPath.h"
+#include "include/core/SkRSXform.h"
 #include "include/core/SkRect.h"
 #include "include/core/SkSamplingOptions.h"
 #include "include/core/SkScalar.h"
@@ -26,6 +28,7 @@
 #include <array>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -263,3 +266,73 @@ DEF_TEST(DrawBitmapRect, reporter) {
 
     test_treatAsSprite(reporter);
 }
+
+// drawAtlas() and experimental_DrawEdgeAAImageSet() batch pixel-aligned sprites on raster
+// devices. They should match drawing each sprite with drawImageRect().
+DEF_TEST(DrawBitmapRect_spriteBatch, reporter) {
+    SkRandom rand;
+    SkBitmap atlasBM;
+    atlasBM.allocN32Pixels(64, 64);
+    for (int y = 0; y < atlasBM.height(); ++y) {
+        for (int x = 0; x < atlasBM.width(); ++x) {
+            *atlasBM.getAddr32(x, y) = SkPreMultiplyColor(rand.nextU());
+        }
+    }
+    sk_sp<SkImage> atlas = atlasBM.asImage();
+
+    // Enough sprites to cover more than 512x512 pixels, so the batch is split into bands.
+    constexpr int kCount = 400;
+    SkRSXform xforms[kCount];
+    SkRect texs[kCount];
+    SkCanvas::ImageSetEntry entries[kCount];
+    for (int i = 0; i < kCount; ++i) {
+        int w = 16 + rand.nextULessThan(40), h = 16 + rand.nextULessThan(40);
+        int l = rand.nextULessThan(64 - w + 1), t = rand.nextULessThan(64 - h + 1);
+        texs[i] = SkRect::MakeXYWH(l, t, w, h);
+        xforms[i] = SkRSXform::Make(1, 0, rand.nextRangeF(-20, 1000), rand.nextRangeF(-20, 580));
+        entries[i] = SkCanvas::ImageSetEntry(atlas, texs[i],
+                                             texs[i].makeOffset(xforms[i].fTx - texs[i].fLeft,
+                                                                xforms[i].fTy - texs[i].fTop),
+                                             1.0f, SkCanvas::kNone_QuadAAFlags);
+    }
+
+    auto draw = [&](auto&& proc) {
+        SkBitmap bm;
+        bm.allocN32Pixels(1000, 600);
+        bm.eraseColor(0xFF204060);
+        SkCanvas canvas(bm);
+        canvas.translate(3, 5);
+        canvas.clipRect({0, 0, 900, 500});
+        proc(&canvas);
+        return bm;
+    };
+    SkPaint paint;
+    paint.setAlphaf(0.75f);
+
+    SkBitmap expected = draw([&](SkCanvas* canvas) {
+        for (const auto& e : entries) {
+            canvas->drawImageRect(atlas, e.fSrcRect, e.fDstRect, SkSamplingOptions(), &paint,
+                                  SkCanvas::kFast_SrcRectConstraint);
+        }
+    });
+    SkBitmap atlasResult = draw([&](SkCanvas* canvas) {
+        canvas->drawAtlas(atlas.get(), xforms, texs, nullptr, kCount, SkBlendMode::kSrcOver,
+                          SkSamplingOptions(), nullptr, &paint);
+    });
+    SkBitmap imageSetResult = draw([&](SkCanvas* canvas) {
+        canvas->experimental_DrawEdgeAAImageSet(entries, kCount, nullptr, nullptr,
+                                                SkSamplingOptions(), &paint,
+                                                SkCanvas::kFast_SrcRectConstraint);
+    });
+
+    auto equal = [](const SkBitmap& a, const SkBitmap& b) {
+        for (int y = 0; y < a.height(); ++y) {
+            if (memcmp(a.getAddr32(0, y), b.getAddr32(0, y), a.width() * 4)) {
+                return false;
+            }
+        }
+        return true;
+    };
+    REPORTER_ASSERT(reporter, equal(expected, atlasResult));
+    REPORTER_ASSERT(reporter, equal(expected, imageSetResult));
+}
@@ -177,6 +177,81 @@ DEF_GANESH_TEST_FOR_RENDERING_CONTEXTS(BasicDrawOpAtlas,
     check(reporter, atlas.get(), 1, 4, 1);
 }
 
+class CountEvictions : public skgpu::PlotEvictionCallback {
+public:
+    void evict(skgpu::PlotLocator) override { ++fCount; }
+
+    int fCount = 0;
+};
+
+// This verifies that compactIdle() moves the live plots of the last page into plots of earlier
+// pages that have aged out, and releases the page, even when compact() would keep it.
+DEF_GANESH_TEST_FOR_RENDERING_CONTEXTS(DrawOpAtlasCompactIdle,
+                                       reporter,
+                                       ctxInfo,
+                                       CtsEnforcement::kNever) {
+    auto context = ctxInfo.directContext();
+    auto proxyProvider = context->priv().proxyProvider();
+    auto resourceProvider = context->priv().resourceProvider();
+    auto drawingManager = context->priv().drawingManager();
+    const GrCaps* caps = context->priv().caps();
+
+    GrOnFlushResourceProvider onFlushResourceProvider(drawingManager);
+    TestingUploadTarget uploadTarget;
+
+    GrColorType atlasColorType = GrColorType::kAlpha_8;
+    GrBackendFormat format = caps->getDefaultBackendFormat(atlasColorType,
+                                                           GrRenderable::kNo);
+
+    CountEvictions evictor;
+    skgpu::AtlasGenerationCounter counter;
+
+    std::unique_ptr<GrDrawOpAtlas> atlas = GrDrawOpAtlas::Make(
+                                                proxyProvider,
+                                                format,
+                                                GrColorTypeToSkColorType(atlasColorType),
+                                                GrColorTypeBytesPerPixel(atlasColorType),
+                                                kAtlasSize, kAtlasSize,
+                                                kAtlasSize/kNumPlots, kAtlasSize/kNumPlots,
+                                                &counter,
+                                                GrDrawOpAtlas::AllowMultitexturing::kYes,
+                                                &evictor,
+                                                /*label=*/"DrawOpAtlasCompactIdleTest");
+
+    // Fill the first page and half of the second.
+    static constexpr int kNumLocators = kNumPlots * kNumPlots + 2;
+    skgpu::AtlasLocator atlasLocators[kNumLocators];
+    for (int i = 0; i < kNumLocators; ++i) {
+        bool result = fill_plot(
+                atlas.get(), resourceProvider, &uploadTarget, &atlasLocators[i], i * 32);
+        REPORTER_ASSERT(reporter, result);
+        if (i == kNumPlots * kNumPlots - 1) {
+            atlas->instantiate(&onFlushResourceProvider);
+        }
+    }
+    check(reporter, atlas.get(), 2, 4, 2);
+
+    // Keep using two plots of each page. Too many plots of the last page are in use for compact()
+    // to release it, but the two first page plots that age out have room for them.
+    for (int i = 0; i < 64; ++i) {
+        for (int l : {0, 1, kNumLocators - 2, kNumLocators - 1}) {
+            atlas->setLastUseToken(atlasLocators[l], uploadTarget.tokenTracker()->nextDrawToken());
+        }
+        uploadTarget.issueDrawToken();
+        uploadTarget.issueFlushToken();
+        atlas->compact(uploadTarget.tokenTracker()->nextFlushToken());
+    }
+    check(reporter, atlas.get(), 2, 4, 2);
+    REPORTER_ASSERT(reporter, evictor.fCount == 0);
+
+    atlas->compactIdle();
+    check(reporter, atlas.get(), 1, 4, 1);
+    REPORTER_ASSERT(reporter, evictor.fCount == 4);
+    REPORTER_ASSERT(reporter, atlas->hasID(atlasLocators[0].plotLocator()));
+    REPORTER_ASSERT(reporter, atlas->hasID(atlasLocators[1].plotLocator()));
+    REPORTER_ASSERT(reporter, !atlas->hasID(atlasLocators[kNumLocators - 1].plotLocator()));
+}
+
 // This test verifies that the AtlasTextOp::onPrepare method correctly handles a failure
 // when allocating an atlas page.
 DEF_GANESH_TEST_FOR_RENDERING_CONTEXTS(GrAtlasTextOpPreparation,
@@ -0,0 +1,105 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkBlendMode.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkPath.h"
+#include "include/core/SkPicture.h"
+#include "include/core/SkPictureRecorder.h"
+#include "include/core/SkPoint.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkShader.h"
+#include "include/core/SkStream.h"
+#include "include/core/SkSurface.h"
+#include "include/core/SkTileMode.h"
+#include "include/effects/SkGradientShader.h"
+#include "include/utils/SkDrawStatsCanvas.h"
+#include "tests/Test.h"
+
+#include <cstring>
+#include <vector>
+
+using Op = SkDrawStatsCanvas::Op;
+
+static const SkDrawStatsCanvas::Counter* find(
+        const std::vector<SkDrawStatsCanvas::NamedCounter>& list, const char* name) {
+    for (const SkDrawStatsCanvas::NamedCounter& entry : list) {
+        if (entry.fName.equals(name)) {
+            return &entry.fCounter;
+        }
+    }
+    return nullptr;
+}
+
+DEF_TEST(DrawStatsCanvas_Raster, r) {
+    sk_sp<SkSurface> surface = SkSurfaces::Raster(SkImageInfo::MakeN32Premul(100, 100));
+    SkDrawStatsCanvas canvas(surface->getCanvas());
+
+    canvas.drawRect(SkRect::MakeXYWH(10, 10, 20, 20), SkPaint());
+    // Half of it is outside the surface.
+    canvas.drawRect(SkRect::MakeXYWH(90, 0, 20, 10), SkPaint());
+
+    const SkPoint pts[] = {{0, 0}, {100, 0}};
+    const SkColor colors[] = {SK_ColorRED, SK_ColorBLUE};
+    SkPaint gradient;
+    gradient.setShader(SkGradientShader::MakeLinear(pts, colors, nullptr, 2, SkTileMode::kClamp));
+    gradient.setBlendMode(SkBlendMode::kMultiply);
+    canvas.drawPath(SkPath::Circle(50, 50, 10), gradient);
+
+    // The picture's draws are counted one by one.
+    SkPictureRecorder recorder;
+    SkCanvas* pictureCanvas = recorder.beginRecording(SkRect::MakeWH(100, 100));
+    pictureCanvas->drawOval(SkRect::MakeWH(10, 10), SkPaint());
+    pictureCanvas->drawPaint(SkPaint());
+    canvas.drawPicture(recorder.finishRecordingAsPicture());
+
+    const SkDrawStatsCanvas::Stats& stats = canvas.stats();
+    const SkDrawStatsCanvas::Counter& rects = stats.fOps[(int)Op::kRect];
+    REPORTER_ASSERT(r, rects.fDraws == 2);
+    REPORTER_ASSERT(r, rects.fPixels == 20 * 20 + 10 * 10);
+    REPORTER_ASSERT(r, stats.fOps[(int)Op::kPath].fDraws == 1);
+    REPORTER_ASSERT(r, stats.fOps[(int)Op::kPath].fPixels == 20 * 20);
+    REPORTER_ASSERT(r, stats.fOps[(int)Op::kOval].fDraws == 1);
+    REPORTER_ASSERT(r, stats.fOps[(int)Op::kPaint].fPixels == 100 * 100);
+
+    const SkDrawStatsCanvas::Counter* none = find(stats.fShaders, "None");
+    const SkDrawStatsCanvas::Counter* linear = find(stats.fShaders, "LinearGradient");
+    REPORTER_ASSERT(r, none && none->fDraws == 4);
+    REPORTER_ASSERT(r, linear && linear->fDraws == 1);
+    const SkDrawStatsCanvas::Counter* multiply = find(stats.fBlenders, "Multiply");
+    REPORTER_ASSERT(r, multiply && multiply->fDraws == 1);
+
+    // The gradient is drawn with a raster pipeline.
+    REPORTER_ASSERT(r, stats.fLowpPipelines + stats.fHighpPipelines > 0);
+    REPORTER_ASSERT(r, stats.fRenderers.empty());
+
+    SkDynamicMemoryWStream text;
+    stats.dump(&text);
+    REPORTER_ASSERT(r, text.bytesWritten() > 0);
+
+    SkDrawStatsCanvas::Stats frame = canvas.endFrame();
+    REPORTER_ASSERT(r, frame.fOps[(int)Op::kRect].fDraws == 2);
+    REPORTER_ASSERT(r, canvas.stats().fOps[(int)Op::kRect].fDraws == 0);
+    REPORTER_ASSERT(r, canvas.stats().fShaders.empty());
+}
+
+DEF_TEST(DrawStatsCanvas_Clip, r) {
+    sk_sp<SkSurface> surface = SkSurfaces::Raster(SkImageInfo::MakeN32Premul(100, 100));
+    SkDrawStatsCanvas canvas(surface->getCanvas());
+
+    canvas.clipRect(SkRect::MakeWH(50, 50));
+    canvas.translate(40, 40);
+    canvas.drawRect(SkRect::MakeWH(20, 20), SkPaint());
+    REPORTER_ASSERT(r, canvas.stats().fOps[(int)Op::kRect].fPixels == 10 * 10);
+
+    // The target sees the same matrix and clip.
+    REPORTER_ASSERT(r, surface->getCanvas()->getDeviceClipBounds() == SkIRect::MakeWH(50, 50));
+}
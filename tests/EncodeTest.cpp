@@ -15,9 +15,11 @@
 #include "include/core/SkColorType.h"
 #include "include/core/SkData.h"
 #include "include/core/SkDataTable.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkPixmap.h"
+#include "include/core/SkRect.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkStream.h"
 #include "include/core/SkSurface.h"
@@ -29,13 +31,16 @@
 #include "include/private/base/SkMalloc.h"
 #include "include/private/base/SkTemplates.h"
 #include "src/core/SkImageInfoPriv.h"
+#include "src/encode/SkAsyncEncoder.h"
 #include "tests/Test.h"
 #include "tools/DecodeUtils.h"
+#include "tools/ToolUtils.h"
 
 #include <png.h>
 #include <webp/decode.h>
 
 #include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <initializer_list>
 #include <memory>
@@ -229,6 +234,50 @@ DEF_TEST(Encode_JpegDownsample, r) {
     REPORTER_ASSERT(r, almost_equals(bm1, bm2, 60));
 }
 
+DEF_TEST(Encode_JpegStreaming, r) {
+    SkBitmap bitmap;
+    if (!ToolUtils::GetResourceAsBitmap("images/mandrill_128.png", &bitmap)) {
+        return;
+    }
+
+    for (auto ct : { kRGBA_8888_SkColorType, kRGB_565_SkColorType, kGray_8_SkColorType }) {
+        SkBitmap src;
+        src.allocPixels(bitmap.info().makeColorType(ct));
+        REPORTER_ASSERT(r, bitmap.readPixels(src.pixmap()));
+
+        SkJpegEncoder::Options options;
+        SkDynamicMemoryWStream expectedStream;
+        REPORTER_ASSERT(r, SkJpegEncoder::Encode(&expectedStream, src.pixmap(), options));
+        sk_sp<SkData> expected = expectedStream.detachAsData();
+
+        for (int stripeHeight : {1, 7, 16, src.height()}) {
+            SkDynamicMemoryWStream stream;
+            auto encoder = SkJpegEncoder::Make(&stream, src.info(), options);
+            REPORTER_ASSERT(r, encoder);
+            for (int top = 0; top < src.height(); top += stripeHeight) {
+                SkPixmap rows;
+                const int height = std::min(stripeHeight, src.height() - top);
+                src.pixmap().extractSubset(&rows, SkIRect::MakeXYWH(0, top, src.width(), height));
+                REPORTER_ASSERT(r, encoder->encodeRows(rows));
+            }
+            REPORTER_ASSERT(r, stream.detachAsData()->equals(expected.get()),
+                            "color type %d, stripes of %d", ct, stripeHeight);
+        }
+    }
+
+    // Rows that do not match the encoder, or that run past the bottom, fail.
+    SkNullWStream ignored;
+    auto encoder = SkJpegEncoder::Make(&ignored, bitmap.info(), SkJpegEncoder::Options());
+    SkBitmap wrongType;
+    wrongType.allocPixels(bitmap.info().makeColorType(kRGB_565_SkColorType));
+    REPORTER_ASSERT(r, !encoder->encodeRows(wrongType.pixmap()));
+
+    encoder = SkJpegEncoder::Make(&ignored, bitmap.info(), SkJpegEncoder::Options());
+    SkBitmap tooTall;
+    tooTall.allocPixels(bitmap.info().makeWH(bitmap.width(), bitmap.height() + 1));
+    REPORTER_ASSERT(r, !encoder->encodeRows(tooTall.pixmap()));
+}
+
 static inline void pushComment(
         std::vector<std::string>& comments, const char* keyword, const char* text) {
     comments.push_back(keyword);
@@ -343,6 +392,177 @@ DEF_TEST(Encode_PngOptions, r) {
     REPORTER_ASSERT(r, almost_equals(bm0, bm2, 0));
 }
 
+// With an executor, the encoder filters and deflates bands of rows itself instead of going through
+// libpng. Whatever the options, and however the rows are fed in, that must decode to the same
+// pixels as a serial encode.
+DEF_TEST(Encode_PngExecutor, r) {
+    SkBitmap mandrill;
+    if (!ToolUtils::GetResourceAsBitmap("images/mandrill_512.png", &mandrill)) {
+        return;
+    }
+    // Several bands tall, with rows that are not a multiple of the filters' vector width.
+    SkBitmap subset;
+    REPORTER_ASSERT(r, mandrill.extractSubset(&subset, SkIRect::MakeWH(509, 512)));
+
+    auto executor = SkExecutor::MakeFIFOThreadPool(4);
+    auto decode = [](sk_sp<SkData> data, const SkImageInfo& info, SkBitmap* bm) {
+        std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(std::move(data));
+        return codec && bm->tryAllocPixels(info) &&
+               codec->getPixels(bm->pixmap()) == SkCodec::kSuccess;
+    };
+    auto encode = [&](const SkPixmap& src, const SkPngEncoder::Options& options, int rowsPerCall) {
+        SkDynamicMemoryWStream stream;
+        std::unique_ptr<SkEncoder> encoder = SkPngEncoder::Make(&stream, src, options);
+        for (int y = 0; encoder && y < src.height(); y += rowsPerCall) {
+            if (!encoder->encodeRows(rowsPerCall)) {
+                return sk_sp<SkData>();
+            }
+        }
+        return encoder ? stream.detachAsData() : nullptr;
+    };
+
+    const SkImageInfo infos[] = {
+            subset.info(),
+            subset.info().makeAlphaType(kOpaque_SkAlphaType),
+            subset.info().makeColorType(kGray_8_SkColorType).makeAlphaType(kOpaque_SkAlphaType),
+            subset.info().makeColorType(kRGBA_F16_SkColorType).makeAlphaType(kUnpremul_SkAlphaType),
+            // libpng drops the alpha of opaque F16, so this one is still encoded serially.
+            subset.info().makeColorType(kRGBA_F16_SkColorType).makeAlphaType(kOpaque_SkAlphaType),
+    };
+    struct {
+        SkPngEncoder::FilterFlag fFilters;
+        int fZLibLevel;
+    } const optionSets[] = {
+            {SkPngEncoder::FilterFlag::kAll, 6},
+            {SkPngEncoder::FilterFlag::kAll, 0},
+            {SkPngEncoder::FilterFlag::kAll, 9},
+            {SkPngEncoder::FilterFlag::kNone, 6},
+            {SkPngEncoder::FilterFlag::kSub, 6},
+            {SkPngEncoder::FilterFlag::kUp, 6},
+            {SkPngEncoder::FilterFlag::kAvg, 6},
+            {SkPngEncoder::FilterFlag::kPaeth, 6},
+            {SkPngEncoder::FilterFlag::kSub | SkPngEncoder::FilterFlag::kPaeth, 6},
+    };
+    for (const SkImageInfo& info : infos) {
+        SkBitmap src;
+        src.allocPixels(info);
+        REPORTER_ASSERT(r, subset.readPixels(src.pixmap()));
+
+        for (const auto& optionSet : optionSets) {
+            SkPngEncoder::Options options;
+            options.fFilterFlags = optionSet.fFilters;
+            options.fZLibLevel = optionSet.fZLibLevel;
+            SkBitmap expected;
+            REPORTER_ASSERT(r, decode(encode(src.pixmap(), options, src.height()), info,
+                                      &expected));
+
+            options.fExecutor = executor.get();
+            for (int rowsPerCall : {src.height(), 100, 1}) {
+                SkBitmap actual;
+                REPORTER_ASSERT(r, decode(encode(src.pixmap(), options, rowsPerCall), info,
+                                          &actual));
+                REPORTER_ASSERT(r, ToolUtils::equal_pixels(expected, actual),
+                                "color type %d, filters 0x%x, level %d, %d rows per call",
+                                info.colorType(), (int)optionSet.fFilters,
+                                optionSet.fZLibLevel, rowsPerCall);
+            }
+        }
+    }
+}
+
+DEF_TEST(Encode_Async, r) {
+    SkBitmap mandrill;
+    if (!ToolUtils::GetResourceAsBitmap("images/mandrill_128.png", &mandrill)) {
+        return;
+    }
+    const size_t imageBytes = mandrill.computeByteSize();
+
+    auto png = [](SkWStream* dst, const SkPixmap& src) {
+        return SkPngEncoder::Encode(dst, src, SkPngEncoder::Options());
+    };
+    auto jpeg = [](SkWStream* dst, const SkPixmap& src) {
+        return SkJpegEncoder::Encode(dst, src, SkJpegEncoder::Options());
+    };
+    auto encodeNow = [](const SkAsyncEncoder::Encoder& encoder, const SkPixmap& src) {
+        SkDynamicMemoryWStream stream;
+        return encoder(&stream, src) ? stream.detachAsData() : nullptr;
+    };
+    const sk_sp<SkData> expectedPng = encodeNow(png, mandrill.pixmap());
+    const sk_sp<SkData> expectedJpeg = encodeNow(jpeg, mandrill.pixmap());
+
+    auto executor = SkExecutor::MakeFIFOThreadPool(3);
+    constexpr int kRequests = 12;
+    std::atomic<int> released{0};
+    std::atomic<int> matched{0};
+    bool overLimit = false;
+    {
+        // Room for two requests at a time.
+        SkAsyncEncoder encoder(executor.get(), 2 * imageBytes);
+        for (int i = 0; i < kRequests; ++i) {
+            struct Pixels {
+                SkBitmap fBitmap;
+                std::atomic<int>* fReleased;
+            };
+            auto* pixels = new Pixels{{}, &released};
+            pixels->fBitmap.allocPixels(mandrill.info());
+            mandrill.readPixels(pixels->fBitmap.pixmap());
+
+            SkAsyncEncoder::Request request;
+            request.fSrc = pixels->fBitmap.pixmap();
+            request.fReleaseProc = [](void* context) {
+                auto* pixels = static_cast<Pixels*>(context);
+                (*pixels->fReleased)++;
+                delete pixels;
+            };
+            request.fReleaseContext = pixels;
+            request.fEncoders = {png, jpeg};
+            encoder.submit(std::move(request), [&](SkAsyncEncoder::Result result) {
+                if (result.fEncoded.size() == 2 && result.fEncoded[0] && result.fEncoded[1] &&
+                    result.fEncoded[0]->equals(expectedPng.get()) &&
+                    result.fEncoded[1]->equals(expectedJpeg.get())) {
+                    matched++;
+                }
+            });
+            if (encoder.bytesInFlight() > 2 * imageBytes) {
+                overLimit = true;
+            }
+        }
+        encoder.wait();
+        REPORTER_ASSERT(r, encoder.bytesInFlight() == 0);
+    }
+    REPORTER_ASSERT(r, released == kRequests);
+    REPORTER_ASSERT(r, matched == kRequests);
+    REPORTER_ASSERT(r, !overLimit);
+
+    // Both encoders are handed the one conversion to 8888.
+    SkBitmap f16;
+    f16.allocPixels(mandrill.info().makeColorType(kRGBA_F16_SkColorType));
+    REPORTER_ASSERT(r, mandrill.readPixels(f16.pixmap()));
+    SkBitmap converted;
+    converted.allocPixels(mandrill.info().makeColorType(kRGBA_8888_SkColorType));
+    REPORTER_ASSERT(r, f16.readPixels(converted.pixmap()));
+
+    bool releasedF16 = false;
+    sk_sp<SkData> convertedPng, convertedJpeg;
+    SkAsyncEncoder encoder(executor.get(), imageBytes);
+    SkAsyncEncoder::Request request;
+    request.fSrc = f16.pixmap();
+    request.fReleaseProc = [](void* context) { *static_cast<bool*>(context) = true; };
+    request.fReleaseContext = &releasedF16;
+    request.fColorType = kRGBA_8888_SkColorType;
+    request.fEncoders = {png, jpeg};
+    encoder.submit(std::move(request), [&](SkAsyncEncoder::Result result) {
+        convertedPng = result.fEncoded[0];
+        convertedJpeg = result.fEncoded[1];
+    });
+    encoder.wait();
+    REPORTER_ASSERT(r, releasedF16);
+    REPORTER_ASSERT(r, convertedPng && convertedPng->equals(
+                                               encodeNow(png, converted.pixmap()).get()));
+    REPORTER_ASSERT(r, convertedJpeg && convertedJpeg->equals(
+                                                encodeNow(jpeg, converted.pixmap()).get()));
+}
+
 #ifndef SK_BUILD_FOR_GOOGLE3
 DEF_TEST(Encode_WebpQuality, r) {
     SkBitmap bm;
@@ -0,0 +1,67 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkExecutor.h"
+#include "src/core/SkTaskGroup.h"
+#include "tests/Test.h"
+
+#include <atomic>
+#include <memory>
+
+DEF_TEST(SkExecutor_WorkStealing_Batch, r) {
+    auto pool = SkExecutor::MakeWorkStealingThreadPool(4);
+
+    std::atomic<int> count{0};
+    SkTaskGroup(*pool).batch(1000, [&](int) { count++; });
+
+    REPORTER_ASSERT(r, count == 1000);
+}
+
+DEF_TEST(SkExecutor_WorkStealing_Nested, r) {
+    auto pool = SkExecutor::MakeWorkStealingThreadPool(4);
+
+    // Work added from inside the pool lands on the worker's own deque and must still be found,
+    // either by that worker or by a thief.
+    std::atomic<int> count{0};
+    SkTaskGroup outer(*pool);
+    outer.batch(64, [&](int) {
+        SkTaskGroup inner(*pool);
+        inner.batch(64, [&](int) { count++; });
+    });
+    outer.wait();
+
+    REPORTER_ASSERT(r, count == 64 * 64);
+}
+
+DEF_TEST(SkExecutor_WorkStealing_Priorities, r) {
+    std::atomic<int> count{0};
+    {
+        auto pool = SkExecutor::MakeWorkStealingThreadPool(2);
+        for (int i = 0; i < 300; i++) {
+            auto priority = static_cast<SkExecutor::Priority>(i % 3);
+            pool->addWithPriority([&] { count++; }, priority);
+        }
+        // Destroying the pool runs all of the work queued before it.
+    }
+    REPORTER_ASSERT(r, count == 300);
+}
+
+DEF_TEST(SkExecutor_Priority_DefaultsToAdd, r) {
+    // Executors that don't know about priorities (here, the FIFO pool) still run the work.
+    auto pool = SkExecutor::MakeFIFOThreadPool(2);
+
+    std::atomic<int> count{0};
+    SkTaskGroup group(*pool);
+    for (int i = 0; i < 10; i++) {
+        group.add([&] { count++; });
+    }
+    pool->addWithPriority([&] { count++; }, SkExecutor::Priority::kHigh);
+    group.wait();
+    pool.reset();
+
+    REPORTER_ASSERT(r, count == 11);
+}
@@ -5,7 +5,13 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
 #include "include/core/SkColor.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkGraphics.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkPaint.h"
 #include "include/core/SkPath.h"
 #include "include/core/SkPathTypes.h"
 #include "include/core/SkRect.h"
@@ -15,7 +21,10 @@
 #include "src/core/SkScan.h"
 #include "tests/Test.h"
 
+#include <cmath>
 #include <cstdint>
+#include <cstring>
+#include <memory>
 
 struct FakeBlitter : public SkBlitter {
     FakeBlitter()
@@ -52,3 +61,60 @@ DEF_TEST(FillPathInverse, reporter) {
 
     REPORTER_ASSERT(reporter, blitter.m_blitCount == expected_lines);
 }
+
+// A star with many jagged points, spanning exactly (0, 0) to (512, 512).
+static SkPath make_big_star() {
+    constexpr int kPoints = 6000;
+    SkPath path;
+    path.moveTo(256, 0);
+    for (int i = 1; i < kPoints; ++i) {
+        const float angle = 2 * SK_FloatPI * i / kPoints;
+        const float radius = (i % 2) ? 256 : 180 + 60 * std::sin(angle * 7);
+        path.lineTo(256 + radius * std::sin(angle), 256 - radius * std::cos(angle));
+    }
+    path.lineTo(0, 256).lineTo(256, 512).lineTo(512, 256);
+    path.close();
+    path.setFillType(SkPathFillType::kEvenOdd);
+    return path;
+}
+
+DEF_SERIAL_TEST(FillPathParallel, reporter) {
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+
+    const SkPath path = make_big_star();
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    paint.setColor(0xFF3050A0);
+
+    const SkImageInfo info = SkImageInfo::MakeN32Premul(512, 512);
+    SkBitmap serial, parallel;
+    serial.allocPixels(info);
+    parallel.allocPixels(info);
+    serial.eraseColor(SK_ColorWHITE);
+    parallel.eraseColor(SK_ColorWHITE);
+
+    // The path fills 512 rows, so it is split into eight bands of 64 rows. Compare against
+    // serial fills clipped to each band in turn.
+    {
+        SkCanvas canvas(serial);
+        for (int top = 0; top < 512; top += 64) {
+            canvas.save();
+            canvas.clipRect(SkRect::MakeLTRB(0, top, 512, top + 64));
+            canvas.drawPath(path, paint);
+            canvas.restore();
+        }
+    }
+    {
+        SkGraphics::SetParallelPathFill(executor.get(), 5000, 0);
+        SkCanvas canvas(parallel);
+        canvas.drawPath(path, paint);
+        SkGraphics::SetParallelPathFill(nullptr);
+    }
+
+    for (int y = 0; y < info.height(); ++y) {
+        if (memcmp(serial.getAddr32(0, y), parallel.getAddr32(0, y), info.minRowBytes()) != 0) {
+            ERRORF(reporter, "Parallel fill differs from serial fill in row %d", y);
+            break;
+        }
+    }
+}
@@ -0,0 +1,155 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkFontStyle.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkTypeface.h"
+#include "src/core/SkFontFallbackCache.h"
+#include "tests/Test.h"
+
+#include <memory>
+#include <vector>
+
+namespace {
+
+// A chain of empty typefaces, font i of which covers the code points c with c % (i + 2) == 0,
+// counting the work asked of it.
+struct Counts {
+    int fChains = 0;
+    int fCoverages = 0;
+    int fTypefaces = 0;
+};
+
+class TestChain final : public SkFontFallbackCache::Chain {
+public:
+    TestChain(int count, Counts* counts) : fTypefaces(count), fCounts(counts) {
+        for (sk_sp<SkTypeface>& typeface : fTypefaces) {
+            typeface = SkTypeface::MakeEmpty();
+        }
+    }
+
+    int count() const override { return static_cast<int>(fTypefaces.size()); }
+
+    void getCoverage(int index, SkUnichar first,
+                     SkFontFallbackCache::Coverage* coverage) const override {
+        ++fCounts->fCoverages;
+        for (int i = 0; i < SkFontFallbackCache::kBlockSize; ++i) {
+            coverage->set(i, covers(index, first + i));
+        }
+    }
+
+    sk_sp<SkTypeface> makeTypeface(int index) const override {
+        ++fCounts->fTypefaces;
+        return fTypefaces[index];
+    }
+
+    static bool covers(int index, SkUnichar c) { return c % (index + 2) == 0; }
+
+    std::vector<sk_sp<SkTypeface>> fTypefaces;
+
+private:
+    Counts* fCounts;
+};
+
+}  // namespace
+
+DEF_TEST(FontFallbackCache, r) {
+    Counts counts;
+    TestChain* chain = nullptr;
+    auto makeChain = [&]() -> std::unique_ptr<SkFontFallbackCache::Chain> {
+        ++counts.fChains;
+        auto made = std::make_unique<TestChain>(3, &counts);
+        chain = made.get();
+        return made;
+    };
+
+    SkFontFallbackCache cache;
+    const char* bcp47[] = {"ja-JP", "en"};
+    auto match = [&](SkUnichar c) {
+        return cache.match("sans-serif", SkFontStyle(), bcp47, 2, c, makeChain);
+    };
+
+    // Each character gets the first font of the chain that covers it, or none.
+    REPORTER_ASSERT(r, match(0x4E00));
+    for (SkUnichar c = 0x4E00; c < 0x4E00 + 2 * SkFontFallbackCache::kBlockSize; ++c) {
+        sk_sp<SkTypeface> expected;
+        for (int i = 0; i < 3 && !expected; ++i) {
+            if (TestChain::covers(i, c)) {
+                expected = chain->fTypefaces[i];
+            }
+        }
+        REPORTER_ASSERT(r, match(c) == expected, "U+%04X", c);
+    }
+
+    // That took one chain, one coverage per font and block, and one typeface for each font
+    // that was matched (the third never is, as the first covers all it does).
+    REPORTER_ASSERT(r, counts.fChains == 1);
+    REPORTER_ASSERT(r, counts.fCoverages == 2 * 3);
+    REPORTER_ASSERT(r, counts.fTypefaces == 2);
+
+    // A block only looks as far down the chain as it needs to.
+    match(0x10000);
+    REPORTER_ASSERT(r, counts.fCoverages == 2 * 3 + 1);
+
+    // Other keys get other chains; the same key later does not.
+    cache.match("sans-serif", SkFontStyle::Bold(), bcp47, 2, 'a', makeChain);
+    cache.match("sans-serif", SkFontStyle(), bcp47, 1, 'a', makeChain);
+    cache.match(nullptr, SkFontStyle(), bcp47, 2, 'a', makeChain);
+    cache.match("", SkFontStyle(), bcp47, 2, 'a', makeChain);
+    REPORTER_ASSERT(r, counts.fChains == 5);
+    REPORTER_ASSERT(r, cache.match(nullptr, SkFontStyle(), bcp47, 2, 'b', makeChain));
+    REPORTER_ASSERT(r, counts.fChains == 5);
+
+    // Characters that are not code points match nothing.
+    REPORTER_ASSERT(r, !match(-1));
+    REPORTER_ASSERT(r, !match(0x110000));
+
+    // After a reset everything is asked for again.
+    cache.reset();
+    match('a');
+    REPORTER_ASSERT(r, counts.fChains == 6);
+}
+
+DEF_TEST(FontFallbackCache_Bounds, r) {
+    Counts counts;
+    auto makeChain = [&]() -> std::unique_ptr<SkFontFallbackCache::Chain> {
+        ++counts.fChains;
+        return std::make_unique<TestChain>(1, &counts);
+    };
+
+    SkFontFallbackCache cache(/*maxChains=*/2, /*maxBlocksPerChain=*/2);
+    const SkFontStyle styles[] = {SkFontStyle::Normal(), SkFontStyle::Bold(),
+                                  SkFontStyle::Italic()};
+    for (const SkFontStyle& style : styles) {
+        cache.match("serif", style, nullptr, 0, 'a', makeChain);
+    }
+    REPORTER_ASSERT(r, counts.fChains == 3);
+    // The least recently used chain was forgotten, the others were not.
+    cache.match("serif", styles[2], nullptr, 0, 'a', makeChain);
+    cache.match("serif", styles[1], nullptr, 0, 'a', makeChain);
+    REPORTER_ASSERT(r, counts.fChains == 3);
+    cache.match("serif", styles[0], nullptr, 0, 'a', makeChain);
+    REPORTER_ASSERT(r, counts.fChains == 4);
+
+    // The same goes for the blocks of a chain.
+    const int coverages = counts.fCoverages;
+    for (SkUnichar block : {1, 2, 3, 2, 1}) {
+        cache.match("serif", styles[0], nullptr, 0, block * SkFontFallbackCache::kBlockSize,
+                    makeChain);
+    }
+    REPORTER_ASSERT(r, counts.fCoverages == coverages + 4);
+
+    // A font manager with no chain for a key matches nothing for it, and remembers that.
+    int noChains = 0;
+    auto countedNoChain = [&]() -> std::unique_ptr<SkFontFallbackCache::Chain> {
+        ++noChains;
+        return nullptr;
+    };
+    REPORTER_ASSERT(r, !cache.match("mono", SkFontStyle(), nullptr, 0, 'a', countedNoChain));
+    REPORTER_ASSERT(r, !cache.match("mono", SkFontStyle(), nullptr, 0, 'b', countedNoChain));
+    REPORTER_ASSERT(r, noChains == 1);
+}
@@ -0,0 +1,255 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkData.h"
+#include "include/core/SkFontArguments.h"
+#include "include/core/SkFontMgr.h"
+#include "include/core/SkFontParameters.h"
+#include "include/core/SkFontStyle.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkScalar.h"
+#include "include/core/SkStream.h"
+#include "include/core/SkString.h"
+#include "include/core/SkTypeface.h"
+#include "include/ports/SkFontMgr_directory.h"
+#include "src/core/SkOSFile.h"
+#include "src/utils/SkOSPath.h"
+#include "tests/Test.h"
+#include "tools/Resources.h"
+
+#include <sys/stat.h>
+#include <utime.h>
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+struct Family {
+    SkString fName;
+    std::vector<SkFontStyle> fStyles;
+
+    bool operator==(const Family& that) const {
+        return fName == that.fName && fStyles == that.fStyles;
+    }
+};
+
+std::vector<Family> families(const sk_sp<SkFontMgr>& mgr) {
+    std::vector<Family> families;
+    for (int i = 0; i < mgr->countFamilies(); ++i) {
+        Family& family = families.emplace_back();
+        mgr->getFamilyName(i, &family.fName);
+        sk_sp<SkFontStyleSet> set = mgr->createStyleSet(i);
+        for (int j = 0; j < set->count(); ++j) {
+            set->getStyle(j, &family.fStyles.emplace_back(), nullptr);
+        }
+    }
+    return families;
+}
+
+}  // namespace
+
+DEF_TEST(FontMgrDirectory_Index, r) {
+    SkString tmpDir = skiatest::GetTmpDir();
+    if (tmpDir.isEmpty()) {
+        return;
+    }
+    const SkString fontDir = GetResourcePath("fonts");
+    const SkString indexPath = SkOSPath::Join(tmpDir.c_str(), "font_index");
+    remove(indexPath.c_str());
+
+    const std::vector<Family> expected = families(SkFontMgr_New_Custom_Directory(fontDir.c_str()));
+    REPORTER_ASSERT(r, !expected.empty());
+
+    // Making the index, and then reading it back, finds the same families as scanning.
+    REPORTER_ASSERT(r, families(SkFontMgr_New_Custom_Directory(fontDir.c_str(),
+                                                               indexPath.c_str())) == expected);
+    REPORTER_ASSERT(r, sk_exists(indexPath.c_str()));
+    sk_sp<SkFontMgr> indexed = SkFontMgr_New_Custom_Directory(fontDir.c_str(), indexPath.c_str());
+    REPORTER_ASSERT(r, families(indexed) == expected);
+    sk_sp<SkTypeface> typeface = indexed->matchFamilyStyle(expected[0].fName.c_str(),
+                                                           expected[0].fStyles[0]);
+    REPORTER_ASSERT(r, typeface && typeface->countGlyphs() > 0);
+
+    // A broken index is ignored and replaced.
+    {
+        SkFILEWStream stream(indexPath.c_str());
+        stream.write32(0x69666b73);
+        stream.write32(1);
+        stream.write32(1000);
+    }
+    REPORTER_ASSERT(r, families(SkFontMgr_New_Custom_Directory(fontDir.c_str(),
+                                                               indexPath.c_str())) == expected);
+    REPORTER_ASSERT(r, families(SkFontMgr_New_Custom_Directory(fontDir.c_str(),
+                                                               indexPath.c_str())) == expected);
+}
+
+DEF_TEST(FontMgrDirectory_IndexSkipsUnchangedFiles, r) {
+    SkString tmpDir = skiatest::GetTmpDir();
+    if (tmpDir.isEmpty()) {
+        return;
+    }
+    const SkString fontDir = SkOSPath::Join(tmpDir.c_str(), "font_index_fonts");
+    const SkString fontPath = SkOSPath::Join(fontDir.c_str(), "Em.ttf");
+    const SkString indexPath = SkOSPath::Join(tmpDir.c_str(), "font_index_2");
+    sk_mkdir(fontDir.c_str());
+    remove(indexPath.c_str());
+
+    sk_sp<SkData> font = GetResourceAsData("fonts/Em.ttf");
+    REPORTER_ASSERT(r, font);
+    auto write = [&](const void* data) {
+        SkFILEWStream stream(fontPath.c_str());
+        stream.write(data, font->size());
+    };
+    write(font->data());
+    struct stat status = {};
+    REPORTER_ASSERT(r, 0 == stat(fontPath.c_str(), &status));
+    const std::vector<Family> expected =
+            families(SkFontMgr_New_Custom_Directory(fontDir.c_str(), indexPath.c_str()));
+    REPORTER_ASSERT(r, expected.size() == 1 && !expected[0].fName.isEmpty());
+
+    // While its size and time stay the same, the font file is not read again.
+    std::vector<char> garbage(font->size(), 'x');
+    write(garbage.data());
+    utimbuf times = {status.st_atime, status.st_mtime};
+    REPORTER_ASSERT(r, 0 == utime(fontPath.c_str(), &times));
+    REPORTER_ASSERT(r, families(SkFontMgr_New_Custom_Directory(fontDir.c_str(),
+                                                               indexPath.c_str())) == expected);
+
+    // Once the time changes it is, and is found not to be a font.
+    times.modtime += 10;
+    REPORTER_ASSERT(r, 0 == utime(fontPath.c_str(), &times));
+    const std::vector<Family> changed =
+            families(SkFontMgr_New_Custom_Directory(fontDir.c_str(), indexPath.c_str()));
+    REPORTER_ASSERT(r, changed.size() == 1 && changed[0].fName.isEmpty());
+
+    remove(fontPath.c_str());
+    remove(indexPath.c_str());
+}
+
+DEF_TEST(FontMgrDirectory_SharedFileMapping, r) {
+    // The faces of a collection, and each opening of one face, share one mapping of the file.
+    sk_sp<SkFontMgr> mgr = SkFontMgr_New_Custom_Directory(GetResourcePath("fonts").c_str());
+    std::vector<sk_sp<SkTypeface>> typefaces;
+    for (int i = 0; i < mgr->countFamilies(); ++i) {
+        sk_sp<SkFontStyleSet> set = mgr->createStyleSet(i);
+        for (int j = 0; j < set->count(); ++j) {
+            typefaces.push_back(set->createTypeface(j));
+        }
+    }
+
+    bool foundCollection = false;
+    for (size_t i = 0; i < typefaces.size(); ++i) {
+        int index;
+        std::unique_ptr<SkStreamAsset> stream = typefaces[i]->openStream(&index);
+        REPORTER_ASSERT(r, stream && stream->getMemoryBase());
+        std::unique_ptr<SkStreamAsset> again = typefaces[i]->openStream(&index);
+        REPORTER_ASSERT(r, again->getMemoryBase() == stream->getMemoryBase());
+        for (size_t j = i + 1; j < typefaces.size(); ++j) {
+            int otherIndex;
+            std::unique_ptr<SkStreamAsset> other = typefaces[j]->openStream(&otherIndex);
+            if (other->getMemoryBase() == stream->getMemoryBase()) {
+                foundCollection = foundCollection || index != otherIndex;
+            }
+        }
+    }
+    REPORTER_ASSERT(r, foundCollection);
+}
+
+DEF_TEST(FontMgrDirectory_ManyTypefaces, r) {
+    // More typefaces than FreeType keeps faces open for still answer as they did, after their
+    // faces are closed and opened again.
+    sk_sp<SkFontMgr> mgr = SkFontMgr_New_Custom_Directory(GetResourcePath("fonts").c_str());
+    sk_sp<SkTypeface> variable = mgr->makeFromFile(GetResourcePath("fonts/Variable.ttf").c_str());
+    if (!variable) {
+        return;
+    }
+    const int axisCount = variable->getVariationDesignParameters(nullptr, 0);
+    std::vector<SkFontParameters::Variation::Axis> axes(axisCount);
+    if (axisCount < 1 ||
+        variable->getVariationDesignParameters(axes.data(), axisCount) != axisCount) {
+        ERRORF(r, "Variable.ttf has no axes.");
+        return;
+    }
+    const SkFontParameters::Variation::Axis& axis = axes[0];
+
+    constexpr int kCount = 200;
+    std::vector<sk_sp<SkTypeface>> typefaces;
+    std::vector<float> values;
+    for (int i = 0; i < kCount; ++i) {
+        const float value = axis.min + (axis.max - axis.min) * i / (kCount - 1);
+        const SkFontArguments::VariationPosition::Coordinate coordinate = {axis.tag, value};
+        typefaces.push_back(variable->makeClone(
+                SkFontArguments().setVariationDesignPosition({&coordinate, 1})));
+        values.push_back(value);
+    }
+    for (int pass = 0; pass < 2; ++pass) {
+        for (int i = 0; i < kCount; ++i) {
+            std::vector<SkFontArguments::VariationPosition::Coordinate> position(axisCount);
+            REPORTER_ASSERT(r, typefaces[i]->getVariationDesignPosition(position.data(),
+                                                                       axisCount) == axisCount);
+            REPORTER_ASSERT(r, position[0].axis == axis.tag);
+            REPORTER_ASSERT(r, SkScalarNearlyEqual(position[0].value, values[i], 1.0f / 64),
+                            "%d: %g != %g", i, position[0].value, values[i]);
+            REPORTER_ASSERT(r, typefaces[i]->countGlyphs() == variable->countGlyphs());
+        }
+    }
+}
+
+DEF_TEST(FontMgrDirectory_ChangedFileMappedAgain, r) {
+    SkString tmpDir = skiatest::GetTmpDir();
+    if (tmpDir.isEmpty()) {
+        return;
+    }
+    const SkString fontDir = SkOSPath::Join(tmpDir.c_str(), "font_mapping_fonts");
+    const SkString fontPath = SkOSPath::Join(fontDir.c_str(), "Font.ttf");
+    sk_mkdir(fontDir.c_str());
+
+    sk_sp<SkData> before = GetResourceAsData("fonts/Em.ttf");
+    sk_sp<SkData> after = GetResourceAsData("fonts/Distortable.ttf");
+    REPORTER_ASSERT(r, before && after);
+    // Files are replaced the way font updates usually replace them, by renaming a new file over
+    // the old one.
+    const SkString tmpPath = SkOSPath::Join(fontDir.c_str(), "Font.tmp");
+    auto write = [&](const SkData& data) {
+        {
+            SkFILEWStream stream(tmpPath.c_str());
+            stream.write(data.data(), data.size());
+        }
+        rename(tmpPath.c_str(), fontPath.c_str());
+    };
+    auto holds = [](SkStreamAsset* stream, const SkData& data) {
+        return stream && stream->getMemoryBase() && stream->getLength() == data.size() &&
+               0 == memcmp(stream->getMemoryBase(), data.data(), data.size());
+    };
+
+    write(*before);
+    sk_sp<SkFontMgr> mgr = SkFontMgr_New_Custom_Directory(fontDir.c_str());
+    REPORTER_ASSERT(r, mgr->countFamilies() == 1);
+    sk_sp<SkTypeface> typeface = mgr->createStyleSet(0)->createTypeface(0);
+    REPORTER_ASSERT(r, typeface);
+    if (!typeface) {
+        return;
+    }
+    int index;
+    std::unique_ptr<SkStreamAsset> stream = typeface->openStream(&index);
+    REPORTER_ASSERT(r, holds(stream.get(), *before));
+
+    // While the file stays the same it is not mapped again.
+    std::unique_ptr<SkStreamAsset> again = typeface->openStream(&index);
+    REPORTER_ASSERT(r, again && again->getMemoryBase() == stream->getMemoryBase());
+
+    // Once the file is replaced its new contents are read, and the old mapping is kept for those
+    // still using it.
+    write(*after);
+    std::unique_ptr<SkStreamAsset> changed = typeface->openStream(&index);
+    REPORTER_ASSERT(r, holds(changed.get(), *after));
+    REPORTER_ASSERT(r, holds(stream.get(), *before));
+
+    remove(fontPath.c_str());
+}
@@ -5,6 +5,10 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkExecutor.h"
+#include "include/core/SkFont.h"
+#include "include/core/SkFontTypes.h"
+#include "include/core/SkPath.h"
 #include "include/core/SkStream.h"
 #include "include/core/SkTypeface.h"
 #include "include/ports/SkTypeface_fontations.h"
@@ -12,11 +16,14 @@
 #include "tools/Resources.h"
 
 #include <memory>
+#include <numeric>
+#include <vector>
 
 namespace {
 const char kFontResource[] = "fonts/ahem.ttf";
 const char kTtcResource[] = "fonts/test.ttc";
 const char kVariableResource[] = "fonts/test_glyphs-glyf_colr_1_variable.ttf";
+const char kColrResource[] = "fonts/test_glyphs-glyf_colr_1.ttf";
 constexpr size_t kNumVariableAxes = 44;
 
 struct AxisExpectation {
@@ -265,3 +272,46 @@ DEF_TEST(Fontations_VariationParameters_BufferTooSmall, reporter) {
     REPORTER_ASSERT(reporter,
                     variableTypeface->getVariationDesignParameters(axes, kArrayTooSmall) == -1);
 }
+
+DEF_TEST(Fontations_PrefetchOutlines, reporter) {
+    sk_sp<SkTypeface> typeface(
+            SkTypeface_Make_Fontations(GetResourceAsStream(kFontResource), SkFontArguments()));
+    sk_sp<SkTypeface> prefetched(
+            SkTypeface_Make_Fontations(GetResourceAsStream(kFontResource), SkFontArguments()));
+    REPORTER_ASSERT(reporter, typeface && prefetched);
+
+    std::vector<SkGlyphID> glyphs(typeface->countGlyphs());
+    std::iota(glyphs.begin(), glyphs.end(), 0);
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(2);
+    SkTypeface_PrefetchFontationsOutlines(prefetched.get(), glyphs, executor.get());
+
+    // Paths scaled from the cached outlines match those extracted at the size.
+    for (float size : {12.f, 50.f}) {
+        SkFont font(typeface, size);
+        SkFont prefetchedFont(prefetched, size);
+        font.setHinting(SkFontHinting::kNone);
+        prefetchedFont.setHinting(SkFontHinting::kNone);
+        for (SkGlyphID glyph : glyphs) {
+            SkPath path, prefetchedPath;
+            bool hasPath = font.getPath(glyph, &path);
+            REPORTER_ASSERT(reporter, hasPath == prefetchedFont.getPath(glyph, &prefetchedPath));
+            SkRect bounds = path.getBounds();
+            SkRect prefetchedBounds = prefetchedPath.getBounds();
+            REPORTER_ASSERT(reporter,
+                            SkScalarNearlyEqual(bounds.fLeft, prefetchedBounds.fLeft, 1e-3f) &&
+                            SkScalarNearlyEqual(bounds.fTop, prefetchedBounds.fTop, 1e-3f) &&
+                            SkScalarNearlyEqual(bounds.fRight, prefetchedBounds.fRight, 1e-3f) &&
+                            SkScalarNearlyEqual(bounds.fBottom, prefetchedBounds.fBottom, 1e-3f));
+        }
+    }
+
+    // Color glyphs are walked for the outlines they draw with, and other typefaces are ignored.
+    sk_sp<SkTypeface> colrTypeface(
+            SkTypeface_Make_Fontations(GetResourceAsStream(kColrResource), SkFontArguments()));
+    REPORTER_ASSERT(reporter, colrTypeface);
+    std::vector<SkGlyphID> colrGlyphs(colrTypeface->countGlyphs());
+    std::iota(colrGlyphs.begin(), colrGlyphs.end(), 0);
+    SkTypeface_PrefetchFontationsOutlines(colrTypeface.get(), colrGlyphs, executor.get());
+    SkTypeface_PrefetchFontationsOutlines(SkTypeface::MakeEmpty().get(), glyphs);
+    SkTypeface_PrefetchFontationsOutlines(nullptr, glyphs);
+}
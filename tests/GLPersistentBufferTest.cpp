@@ -0,0 +1,93 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "tests/Test.h"
+
+#ifdef SK_GL
+#include "include/core/SkRefCnt.h"
+#include "include/gpu/GrDirectContext.h"
+#include "include/gpu/GrTypes.h"
+#include "include/private/gpu/ganesh/GrTypesPriv.h"
+#include "src/gpu/ganesh/GrDirectContextPriv.h"
+#include "src/gpu/ganesh/GrGpuBuffer.h"
+#include "src/gpu/ganesh/GrResourceProvider.h"
+#include "src/gpu/ganesh/gl/GrGLBuffer.h"
+#include "src/gpu/ganesh/gl/GrGLCaps.h"
+#include "src/gpu/ganesh/gl/GrGLGpu.h"
+#include "tests/CtsEnforcement.h"
+
+#include <cstring>
+
+struct GrContextOptions;
+
+DEF_GANESH_TEST_FOR_GL_CONTEXT(GLPersistentBufferTest,
+                               reporter,
+                               ctxInfo,
+                               CtsEnforcement::kNever) {
+    auto dContext = ctxInfo.directContext();
+    GrGLGpu* glGpu = static_cast<GrGLGpu*>(dContext->priv().getGpu());
+    if (!glGpu->glCaps().persistentBufferMapSupport()) {
+        return;
+    }
+    GrResourceProvider* resourceProvider = dContext->priv().resourceProvider();
+
+    static constexpr size_t kSize = 1024;
+    sk_sp<GrGpuBuffer> buffer = resourceProvider->createBuffer(kSize,
+                                                               GrGpuBufferType::kVertex,
+                                                               kDynamic_GrAccessPattern,
+                                                               GrResourceProvider::ZeroInit::kNo);
+    if (!buffer) {
+        ERRORF(reporter, "Could not create buffer");
+        return;
+    }
+    auto glBuffer = static_cast<GrGLBuffer*>(buffer.get());
+    REPORTER_ASSERT(reporter, glBuffer->isPersistentlyMapped());
+
+    // Each mapping gets the same memory, and writing it ties the buffer to the next submit.
+    void* ptr = buffer->map();
+    REPORTER_ASSERT(reporter, ptr);
+    memset(ptr, 0xFF, kSize);
+    buffer->unmap();
+    REPORTER_ASSERT(reporter, buffer->map() == ptr);
+    buffer->unmap();
+    REPORTER_ASSERT(reporter, glBuffer->gpuUse() == GrGLBuffer::GpuUse::kPendingSubmit);
+
+    // While the GPU may read the buffer, the cache won't hand it out again.
+    const uint32_t uniqueID = buffer->uniqueID().asUInt();
+    buffer.reset();
+    dContext->submit(GrSyncCpu::kNo);
+    if (glBuffer->gpuUse() == GrGLBuffer::GpuUse::kSubmitted) {
+        sk_sp<GrGpuBuffer> other = resourceProvider->createBuffer(
+                kSize, GrGpuBufferType::kVertex, kDynamic_GrAccessPattern,
+                GrResourceProvider::ZeroInit::kNo);
+        REPORTER_ASSERT(reporter, other && other->uniqueID().asUInt() != uniqueID);
+    }
+
+    // Once the GPU is done, buffers are free to be reused.
+    dContext->submit(GrSyncCpu::kYes);
+    sk_sp<GrGpuBuffer> reused = resourceProvider->createBuffer(kSize,
+                                                               GrGpuBufferType::kVertex,
+                                                               kDynamic_GrAccessPattern,
+                                                               GrResourceProvider::ZeroInit::kNo);
+    if (!reused) {
+        ERRORF(reporter, "Could not create buffer");
+        return;
+    }
+    REPORTER_ASSERT(reporter,
+                    static_cast<GrGLBuffer*>(reused.get())->gpuUse() == GrGLBuffer::GpuUse::kNone);
+
+    // Updating the buffer after it was submitted waits for the GPU first.
+    static constexpr char kData[16] = {1, 2, 3, 4};
+    REPORTER_ASSERT(reporter, reused->updateData(kData, 0, sizeof(kData), /*preserve=*/false));
+    dContext->submit(GrSyncCpu::kNo);
+    REPORTER_ASSERT(reporter, reused->updateData(kData, 16, sizeof(kData), /*preserve=*/false));
+    REPORTER_ASSERT(reporter, static_cast<GrGLBuffer*>(reused.get())->gpuUse() ==
+                              GrGLBuffer::GpuUse::kPendingSubmit);
+    dContext->submit(GrSyncCpu::kYes);
+}
+
+#endif  // SK_GL
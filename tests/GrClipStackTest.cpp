@@ -2111,6 +2111,9 @@ DEF_GANESH_TEST_FOR_CONTEXTS(ClipStack_SWMask,
         path.addCircle(x, y, radius);
         path.addCircle(x + radius / 2.f, y + radius / 2.f, radius);
         path.setFillType(SkPathFillType::kEvenOdd);
+        // Masks of volatile paths are keyed by their save record, whose lifetime this checks.
+        // ClipStack_SWMaskContentKey covers masks that outlive it.
+        path.setIsVolatile(true);
 
         // Use AA so that clip application does not route through the stencil buffer
         cs->clipPath(SkMatrix::I(), path, GrAA::kYes, SkClipOp::kIntersect);
@@ -2193,3 +2196,52 @@ DEF_GANESH_TEST_FOR_CONTEXTS(ClipStack_SWMask,
     cs = nullptr;
     verifyKeys({}, {keyADepth1, keyBDepth1});
 }
+
+DEF_GANESH_TEST_FOR_CONTEXTS(ClipStack_SWMaskContentKey,
+                             skgpu::IsRenderingContext,
+                             r,
+                             ctxInfo,
+                             disable_tessellation_atlas,
+                             CtsEnforcement::kNever) {
+    using ClipStack = skgpu::ganesh::ClipStack;
+    using SurfaceDrawContext = skgpu::ganesh::SurfaceDrawContext;
+
+    GrDirectContext* context = ctxInfo.directContext();
+    std::unique_ptr<SurfaceDrawContext> sdc = SurfaceDrawContext::Make(
+            context, GrColorType::kRGBA_8888, nullptr, SkBackingFit::kExact, kDeviceBounds.size(),
+            SkSurfaceProps(), /*label=*/{});
+    GrProxyProvider* proxyProvider = context->priv().proxyProvider();
+
+    std::unique_ptr<ClipStack> cs(new ClipStack(kDeviceBounds, &SkMatrix::I(), false));
+
+    SkPath path;
+    path.addCircle(5.f, 5.f, 20.f);
+    path.addCircle(15.f, 15.f, 20.f);
+    path.setFillType(SkPathFillType::kEvenOdd);
+
+    // Sets the same clip the way a frame would, and returns the key of the mask it drew with.
+    auto drawFrame = [&]() {
+        cs->save();
+        cs->clipPath(SkMatrix::I(), path, GrAA::kYes, SkClipOp::kIntersect);
+        GrPaint paint;
+        paint.setColor4f({1.f, 1.f, 1.f, 1.f});
+        sdc->drawRect(cs.get(), std::move(paint), GrAA::kYes, SkMatrix::I(), {0, 0, 20, 20});
+        skgpu::UniqueKey key = cs->testingOnly_getLastSWMaskKey();
+        cs->restore();
+        context->flush();
+        return key;
+    };
+
+    // The mask outlives the save record, and the next frame draws with it again.
+    skgpu::UniqueKey first = drawFrame();
+    REPORTER_ASSERT(r, first.isValid());
+    REPORTER_ASSERT(r, SkToBool(proxyProvider->findOrCreateProxyByUniqueKey(first)));
+    REPORTER_ASSERT(r, drawFrame() == first);
+
+    // Changing the path drops its mask, and the next frame makes a new one.
+    path.addCircle(10.f, 10.f, 5.f);
+    context->flush();
+    REPORTER_ASSERT(r, !proxyProvider->findOrCreateProxyByUniqueKey(first));
+    skgpu::UniqueKey second = drawFrame();
+    REPORTER_ASSERT(r, second.isValid() && second != first);
+}
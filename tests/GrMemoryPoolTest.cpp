@@ -14,7 +14,10 @@
 #include <array>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <memory>
+#include <thread>
+#include <vector>
 
 using namespace skia_private;
 
@@ -319,3 +322,43 @@ DEF_TEST(GrMemoryPoolAPI, reporter) {
         REPORTER_ASSERT(reporter, pool->size() == hugeBlockSize + kMinAllocSize);
     }
 }
+
+DEF_TEST(GrThreadMemoryPool, reporter) {
+    constexpr int kCount = 100;
+    std::vector<void*> allocations;
+
+    std::thread([&] {
+        for (int i = 0; i < kCount; ++i) {
+            void* p = GrThreadMemoryPool::Allocate(24);
+            REPORTER_ASSERT(reporter,
+                            reinterpret_cast<uintptr_t>(p) % GrMemoryPool::kAlignment == 0);
+            memset(p, i, 24);
+            allocations.push_back(p);
+        }
+        GrThreadMemoryPool::Stats stats = GrThreadMemoryPool::GetThreadStats();
+        REPORTER_ASSERT(reporter, stats.fPoolCount == 1);
+        REPORTER_ASSERT(reporter, stats.fAllocationCount == kCount);
+        REPORTER_ASSERT(reporter, stats.fTotalAllocationCount == kCount);
+        REPORTER_ASSERT(reporter, stats.fSize > 0);
+
+        // Releasing memory on the thread that made it goes back to the same pool.
+        for (int i = 0; i < kCount / 2; ++i) {
+            GrThreadMemoryPool::Release(allocations.back());
+            allocations.pop_back();
+        }
+        stats = GrThreadMemoryPool::GetThreadStats();
+        REPORTER_ASSERT(reporter, stats.fAllocationCount == kCount / 2);
+        REPORTER_ASSERT(reporter, stats.fTotalAllocationCount == kCount);
+    }).join();
+
+    // The rest is released here, after the thread that made it is gone, and doesn't count against
+    // this thread's pool.
+    int64_t before = GrThreadMemoryPool::GetThreadStats().fTotalAllocationCount;
+    for (int i = 0; i < kCount / 2; ++i) {
+        REPORTER_ASSERT(reporter, *static_cast<char*>(allocations[i]) == i);
+        GrThreadMemoryPool::Release(allocations[i]);
+    }
+    GrThreadMemoryPool::Release(GrThreadMemoryPool::Allocate(16));
+    REPORTER_ASSERT(reporter,
+                    GrThreadMemoryPool::GetThreadStats().fTotalAllocationCount == before + 1);
+}
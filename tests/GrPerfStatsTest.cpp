@@ -0,0 +1,124 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkSurface.h"
+#include "include/gpu/GpuTypes.h"
+#include "include/gpu/GrContextOptions.h"
+#include "include/gpu/GrDirectContext.h"
+#include "include/gpu/GrTypes.h"
+#include "include/gpu/ganesh/GrPerfStats.h"
+#include "include/gpu/ganesh/SkSurfaceGanesh.h"
+#include "include/private/base/SkTo.h"
+#include "src/gpu/ganesh/GrPerfStatsRecorder.h"
+#include "tests/CtsEnforcement.h"
+#include "tests/Test.h"
+
+#include <cstring>
+
+static void draw_and_sync(GrDirectContext* dContext) {
+    SkImageInfo info = SkImageInfo::MakeN32Premul(64, 64);
+    sk_sp<SkSurface> surface = SkSurfaces::RenderTarget(dContext, skgpu::Budgeted::kYes, info);
+    if (!surface) {
+        return;
+    }
+    SkPaint paint;
+    paint.setColor(SK_ColorRED);
+    surface->getCanvas()->drawRect(SkRect::MakeLTRB(8, 8, 40, 24), paint);
+    surface->getCanvas()->drawCircle(32, 40, 12, paint);
+    dContext->flushAndSubmit(surface.get(), GrSyncCpu::kYes);
+}
+
+static void enable_perf_stats(GrContextOptions* options) {
+    options->fEnablePerfStats = true;
+}
+
+DEF_GANESH_TEST_FOR_CONTEXTS(GrPerfStats_Collected,
+                             &skgpu::IsRenderingContext,
+                             reporter,
+                             ctxInfo,
+                             enable_perf_stats,
+                             CtsEnforcement::kNever) {
+    auto dContext = ctxInfo.directContext();
+    GrPerfStats stats;
+    dContext->getPerfStats(&stats);  // Drop whatever setting up the context did.
+
+    draw_and_sync(dContext);
+    dContext->getPerfStats(&stats);
+    REPORTER_ASSERT(reporter, !stats.fRenderTasks.empty());
+    bool sawOps = false;
+    for (const GrPerfStats::RenderTask& task : stats.fRenderTasks) {
+        REPORTER_ASSERT(reporter, task.fName);
+        REPORTER_ASSERT(reporter, task.fPrepareMs >= 0 && task.fExecuteMs >= 0);
+        sawOps |= task.fName && !strcmp(task.fName, "Ops");
+    }
+    REPORTER_ASSERT(reporter, sawOps);
+    REPORTER_ASSERT(reporter, stats.fPipelineCacheHits + stats.fPipelineCacheMisses > 0);
+    REPORTER_ASSERT(reporter, stats.fPipelineCompileMs >= 0);
+
+    // The same draws again find their pipelines, and each call only reports what is new.
+    draw_and_sync(dContext);
+    dContext->getPerfStats(&stats);
+    REPORTER_ASSERT(reporter, stats.fPipelineCacheMisses == 0);
+    dContext->getPerfStats(&stats);
+    REPORTER_ASSERT(reporter, stats.fPipelineCacheHits == 0 && stats.fPipelineCacheMisses == 0);
+}
+
+// A context whose stats aren't read keeps a bounded number of tasks, and counts the ones it drops.
+DEF_GANESH_TEST_FOR_CONTEXTS(GrPerfStats_Bounded,
+                             &skgpu::IsRenderingContext,
+                             reporter,
+                             ctxInfo,
+                             enable_perf_stats,
+                             CtsEnforcement::kNever) {
+    auto dContext = ctxInfo.directContext();
+    GrPerfStats stats;
+    dContext->getPerfStats(&stats);
+
+    SkImageInfo info = SkImageInfo::MakeN32Premul(16, 16);
+    sk_sp<SkSurface> surface = SkSurfaces::RenderTarget(dContext, skgpu::Budgeted::kYes, info);
+    REPORTER_ASSERT(reporter, surface);
+    if (!surface) {
+        return;
+    }
+    // Every flush executes at least one task.
+    constexpr int kFlushes = GrPerfStatsRecorder::kMaxTasks + 100;
+    SkPaint paint;
+    for (int i = 0; i < kFlushes; ++i) {
+        paint.setColor(i % 2 ? SK_ColorRED : SK_ColorBLUE);
+        surface->getCanvas()->drawRect(SkRect::MakeWH(8, 8), paint);
+        dContext->flushAndSubmit(surface.get(), i == kFlushes - 1 ? GrSyncCpu::kYes
+                                                                  : GrSyncCpu::kNo);
+    }
+
+    dContext->getPerfStats(&stats);
+    REPORTER_ASSERT(reporter,
+                    SkToInt(stats.fRenderTasks.size()) <= GrPerfStatsRecorder::kMaxTasks);
+    REPORTER_ASSERT(reporter, stats.fDroppedRenderTasks > 0);
+    REPORTER_ASSERT(reporter,
+                    SkToInt(stats.fRenderTasks.size()) + stats.fDroppedRenderTasks >= kFlushes);
+
+    dContext->getPerfStats(&stats);
+    REPORTER_ASSERT(reporter, stats.fDroppedRenderTasks == 0);
+}
+
+DEF_GANESH_TEST_FOR_RENDERING_CONTEXTS(GrPerfStats_Disabled,
+                                       reporter,
+                                       ctxInfo,
+                                       CtsEnforcement::kNever) {
+    auto dContext = ctxInfo.directContext();
+    draw_and_sync(dContext);
+    GrPerfStats stats;
+    dContext->getPerfStats(&stats);
+    REPORTER_ASSERT(reporter, stats.fRenderTasks.empty());
+    REPORTER_ASSERT(reporter, stats.fPipelineCacheHits == 0 && stats.fPipelineCacheMisses == 0);
+}
@@ -10,6 +10,7 @@
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColor.h"
 #include "include/core/SkColorType.h"
+#include "include/core/SkData.h"
 #include "include/core/SkFont.h"
 #include "include/core/SkFontStyle.h"
 #include "include/core/SkFontTypes.h"
@@ -349,6 +350,22 @@ DEF_TEST(SubRunAllocator, r) {
         void* ptr = arena.alignedBytes(4081, 8);
         REPORTER_ASSERT(r, ((intptr_t)ptr & 7) == 0);
     }
+
+    {
+        // Spans in the borrowed data are returned as they are, and others copied.
+        const int values[] = {1, 2, 3, 4};
+        sk_sp<SkData> data = SkData::MakeWithoutCopy(values, sizeof(values));
+        SubRunAllocator arena;
+        SkSpan<const int> s{values};
+        REPORTER_ASSERT(r, arena.borrowPODSpan(s).data() != values);
+        arena.setBorrowedData(data);
+        REPORTER_ASSERT(r, !data->unique());
+        REPORTER_ASSERT(r, arena.borrowPODSpan(s).data() == values);
+        REPORTER_ASSERT(r, arena.borrowPODSpan(s.last(2)).data() == values + 2);
+        const int others[] = {5, 6};
+        SkSpan<const int> copy = arena.borrowPODSpan(SkSpan<const int>{others});
+        REPORTER_ASSERT(r, copy.data() != others && copy[0] == 5 && copy[1] == 6);
+    }
 }
 
 using TextBlob = sktext::gpu::TextBlob;
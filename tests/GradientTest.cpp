@@ -12,6 +12,7 @@
 #include "include/core/SkColorPriv.h"
 #include "include/core/SkColorSpace.h"
 #include "include/core/SkColorType.h"
+#include "include/core/SkGraphics.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkMatrix.h"
 #include "include/core/SkPaint.h"
@@ -42,8 +43,11 @@
 #include "tests/CtsEnforcement.h"
 #include "tests/Test.h"
 
+#include <algorithm>
 #include <cstdint>
+#include <cstdlib>
 #include <cstring>
+#include <iterator>
 #include <string>
 
 // #if defined(SK_GRAPHITE)
@@ -616,3 +620,72 @@ DEF_TEST(Gradient, reporter) {
     test_sweep_fuzzer(reporter);
     test_unsorted_degenerate(reporter);
 }
+
+static SkBitmap draw_gradient_row(sk_sp<SkShader> shader, sk_sp<SkColorSpace> cs) {
+    SkBitmap bm;
+    bm.allocPixels(SkImageInfo::MakeN32Premul(512, 1, std::move(cs)));
+    bm.eraseColor(SK_ColorTRANSPARENT);
+    SkPaint paint;
+    paint.setShader(std::move(shader));
+    SkCanvas(bm).drawPaint(paint);
+    return bm;
+}
+
+static int max_channel_diff(SkColor a, SkColor b) {
+    int diff = 0;
+    for (int shift = 0; shift < 32; shift += 8) {
+        diff = std::max(diff, std::abs((int)((a >> shift) & 0xFF) - (int)((b >> shift) & 0xFF)));
+    }
+    return diff;
+}
+
+// Sampling the baked table should stay within a step or two of the exact gradient, and keep the
+// hard stops at the ends of a clamped gradient.
+DEF_SERIAL_TEST(Gradient_RasterLUT, reporter) {
+    const SkPoint pts[] = {{64, 0}, {448, 0}};
+    const SkColor manyStops[] = {SK_ColorRED, SK_ColorYELLOW, SK_ColorGREEN, SK_ColorCYAN,
+                                 SK_ColorBLUE, SK_ColorMAGENTA, SK_ColorBLACK, SK_ColorWHITE};
+    const SkColor hardColors[] = {SK_ColorRED, SK_ColorGREEN, SK_ColorGREEN, SK_ColorBLUE};
+    const SkScalar hardPos[] = {0, 0, 1, 1};
+
+    const sk_sp<SkShader> shaders[] = {
+        SkGradientShader::MakeLinear(pts, manyStops, nullptr, std::size(manyStops),
+                                     SkTileMode::kClamp),
+        SkGradientShader::MakeLinear(pts, manyStops, nullptr, std::size(manyStops),
+                                     SkTileMode::kMirror),
+        SkGradientShader::MakeRadial({256, 0}, 200, manyStops, nullptr, std::size(manyStops),
+                                     SkTileMode::kRepeat),
+        SkGradientShader::MakeLinear(pts, hardColors, hardPos, std::size(hardColors),
+                                     SkTileMode::kClamp),
+    };
+    const sk_sp<SkColorSpace> colorSpaces[] = {
+        nullptr,
+        SkColorSpace::MakeSRGB(),
+        SkColorSpace::MakeRGB(SkNamedTransferFn::kSRGB, SkNamedGamut::kDisplayP3),
+    };
+
+    for (const sk_sp<SkColorSpace>& cs : colorSpaces) {
+        for (const sk_sp<SkShader>& shader : shaders) {
+            SkGraphics::SetRasterGradientLUT(false);
+            SkBitmap expected = draw_gradient_row(shader, cs);
+            SkGraphics::SetRasterGradientLUT(true);
+            SkBitmap actual = draw_gradient_row(shader, cs);
+
+            for (int x = 0; x < expected.width(); ++x) {
+                int diff = max_channel_diff(expected.getColor(x, 0), actual.getColor(x, 0));
+                if (diff > 2) {
+                    ERRORF(reporter, "pixel %d differs by %d", x, diff);
+                    break;
+                }
+            }
+        }
+    }
+
+    // Outside a clamped gradient the colors beyond the hard stops are used.
+    SkBitmap hard = draw_gradient_row(shaders[3], nullptr);
+    REPORTER_ASSERT(reporter, hard.getColor(10, 0) == SK_ColorRED);
+    REPORTER_ASSERT(reporter, hard.getColor(256, 0) == SK_ColorGREEN);
+    REPORTER_ASSERT(reporter, hard.getColor(500, 0) == SK_ColorBLUE);
+
+    SkGraphics::SetRasterGradientLUT(false);
+}
@@ -8,7 +8,9 @@
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkString.h"
 #include "include/core/SkTypes.h"
+#include "src/base/SkRandom.h"
 #include "src/core/SkTHash.h"
+#include "src/core/SkTHashGroupTable.h"
 #include "tests/Test.h"
 
 #include <cstdint>
@@ -231,9 +233,9 @@ DEF_TEST(HashSetCtorOneElem, r) {
     REPORTER_ASSERT(r, !set.contains("three"));
 }
 
-template <typename T>
+template <typename T, typename Set = THashSet<T>>
 static void test_hash_set(skiatest::Reporter* r) {
-    THashSet<T> set;
+    Set set;
 
     set.add(T("Hello"));
     set.add(T("World"));
@@ -245,12 +247,12 @@ static void test_hash_set(skiatest::Reporter* r) {
     REPORTER_ASSERT(r, *set.find(T("Hello")) == T("Hello"));
 
     // Test walking the set with iterators, using preincrement (++iter).
-    for (typename THashSet<T>::Iter iter = set.begin(); iter != set.end(); ++iter) {
+    for (typename Set::Iter iter = set.begin(); iter != set.end(); ++iter) {
         REPORTER_ASSERT(r, *iter == T("Hello") || *iter == T("World"));
     }
 
     // Test walking the set with iterators, using postincrement (iter++).
-    for (typename THashSet<T>::Iter iter = set.begin(); iter != set.end(); iter++) {
+    for (typename Set::Iter iter = set.begin(); iter != set.end(); iter++) {
         REPORTER_ASSERT(r, *iter == T("Hello") || *iter == T("World"));
     }
 
@@ -261,7 +263,7 @@ static void test_hash_set(skiatest::Reporter* r) {
 
     // Ensure that iteration works equally well on a const set.
     const auto& cset = set;
-    for (typename THashSet<T>::Iter iter = cset.begin(); iter != cset.end(); iter++) {
+    for (typename Set::Iter iter = cset.begin(); iter != cset.end(); iter++) {
         REPORTER_ASSERT(r, *iter == T("Hello") || *iter == T("World"));
     }
 
@@ -270,7 +272,7 @@ static void test_hash_set(skiatest::Reporter* r) {
         REPORTER_ASSERT(r, entry == T("Hello") || entry == T("World"));
     }
 
-    THashSet<T> clone = set;
+    Set clone = set;
     REPORTER_ASSERT(r, clone.count() == 2);
     REPORTER_ASSERT(r, clone.contains(T("Hello")));
     REPORTER_ASSERT(r, clone.contains(T("World")));
@@ -489,3 +491,76 @@ DEF_TEST(HashSetSwap, r) {
     a.swap(THashSet<std::string_view>());
     REPORTER_ASSERT(r, a.empty());
 }
+
+DEF_TEST(HashGroupSet, r) {
+    test_hash_set<SkString, THashGroupSet<SkString>>(r);
+    test_hash_set<std::string, THashGroupSet<std::string>>(r);
+}
+
+// Runs the same random inserts and removals against a THashGroupMap and a THashMap, and checks
+// that they always agree.  Hashes are optionally squashed into a few values to force long probes.
+template <typename HashK>
+static void test_group_map_against_reference(skiatest::Reporter* r) {
+    THashGroupMap<uint32_t, int, HashK> map;
+    THashMap<uint32_t, int> reference;
+    SkRandom rand;
+
+    for (int i = 0; i < 20000; i++) {
+        uint32_t key = rand.nextULessThan(2000);
+        if (rand.nextBool()) {
+            int* val = map.set(key, i);
+            REPORTER_ASSERT(r, *val == i);
+            reference.set(key, i);
+        } else {
+            REPORTER_ASSERT(r, map.removeIfExists(key) == reference.removeIfExists(key));
+        }
+        REPORTER_ASSERT(r, map.count() == reference.count());
+    }
+
+    for (uint32_t key = 0; key < 2000; key++) {
+        const int* val = map.find(key);
+        const int* ref = reference.find(key);
+        REPORTER_ASSERT(r, !val == !ref);
+        REPORTER_ASSERT(r, !val || *val == *ref);
+    }
+
+    int seen = 0;
+    for (const auto& [key, val] : map) {
+        REPORTER_ASSERT(r, reference.find(key) && *reference.find(key) == val);
+        seen++;
+    }
+    REPORTER_ASSERT(r, seen == reference.count());
+
+    THashGroupMap<uint32_t, int, HashK> clone = map;
+    reference.foreach([&](uint32_t key, int val) {
+        REPORTER_ASSERT(r, clone.find(key) && *clone.find(key) == val);
+        clone.remove(key);
+    });
+    REPORTER_ASSERT(r, clone.empty());
+    REPORTER_ASSERT(r, map.count() == reference.count());
+}
+
+DEF_TEST(HashGroupMap, r) {
+    struct CollidingHash {
+        uint32_t operator()(uint32_t key) const { return (key % 5) * 0x01010101; }
+    };
+    test_group_map_against_reference<SkGoodHash>(r);
+    test_group_map_against_reference<CollidingHash>(r);
+
+    // Test that we don't leave dangling values in empty slots.
+    THashGroupMap<int, sk_sp<SkRefCnt>> refMap;
+    auto ref = sk_make_sp<SkRefCnt>();
+    refMap.set(0, ref);
+    REPORTER_ASSERT(r, !ref->unique());
+    refMap.remove(0);
+    REPORTER_ASSERT(r, refMap.count() == 0);
+    REPORTER_ASSERT(r, ref->unique());
+
+    // Initializer lists and operator[] work through the same THashMap interface.
+    THashGroupMap<int, std::string_view> map{{1, "one"}, {2, "two"}, {3, "three"}};
+    REPORTER_ASSERT(r, map.count() == 3);
+    REPORTER_ASSERT(r, map[2] == "two");
+    map[4] = "four";
+    REPORTER_ASSERT(r, map.count() == 4);
+    REPORTER_ASSERT(r, *map.find(4) == "four");
+}
@@ -10,13 +10,17 @@
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkTypes.h"
 #include "include/encode/SkICC.h"
+#include "include/private/base/SkTemplates.h"
 #include "modules/skcms/skcms.h"
+#include "src/core/SkICCProfileCache.h"
 #include "tests/Test.h"
 #include "tools/Resources.h"
 
 #include <cmath>
 #include <cstdint>
 #include <cstdlib>
+#include <cstring>
+#include <memory>
 
 DEF_TEST(AdobeRGB, r) {
     if (sk_sp<SkData> profile = GetResourceAsData("icc_profiles/AdobeRGB1998.icc")) {
@@ -146,3 +150,101 @@ DEF_TEST(HDR_ICC, r) {
         }
     }
 }
+
+DEF_TEST(ICC_CompiledTransform, r) {
+    skcms_ICCProfile p3, rec2020, srgb22;
+    SkColorSpace::MakeRGB(SkNamedTransferFn::kSRGB, SkNamedGamut::kDisplayP3)->toProfile(&p3);
+    SkColorSpace::MakeRGB(SkNamedTransferFn::kRec2020, SkNamedGamut::kRec2020)->toProfile(&rec2020);
+    SkColorSpace::MakeRGB(SkNamedTransferFn::k2Dot2, SkNamedGamut::kSRGB)->toProfile(&srgb22);
+    const skcms_ICCProfile* profiles[] = {nullptr, &p3, &rec2020, &srgb22};
+    const skcms_PixelFormat formats[] = {
+            skcms_PixelFormat_RGBA_8888,
+            skcms_PixelFormat_BGRA_8888,
+            skcms_PixelFormat_RGB_888,
+            skcms_PixelFormat_G_8,
+            skcms_PixelFormat_RGBA_1010102,
+            skcms_PixelFormat_RGBA_hhhh,
+    };
+
+    // An odd count covers both full vectors and the leftover pixels of every backend.
+    constexpr int kPixels = 101;
+    uint8_t src[8 * kPixels], expected[8 * kPixels], actual[8 * kPixels];
+    for (int i = 0; i < 8 * kPixels; ++i) {
+        src[i] = (i * 37 + 11) & 0xFF;
+    }
+
+    for (skcms_PixelFormat dstFmt : formats) {
+    for (const skcms_ICCProfile* srcProfile : profiles) {
+    for (const skcms_ICCProfile* dstProfile : profiles) {
+        const skcms_PixelFormat srcFmt = skcms_PixelFormat_RGBA_8888;
+        const skcms_AlphaFormat dstAlpha = skcms_AlphaFormat_PremulAsEncoded;
+        std::unique_ptr<skcms_CompiledTransform,
+                        SkFunctionObject<skcms_FreeCompiledTransform>> xform(
+                skcms_CompileTransform(srcFmt, skcms_AlphaFormat_Unpremul, srcProfile,
+                                       dstFmt, dstAlpha, dstProfile));
+        REPORTER_ASSERT(r, xform);
+
+        memset(expected, 0, sizeof(expected));
+        memset(actual, 0, sizeof(actual));
+        REPORTER_ASSERT(r, skcms_Transform(src, srcFmt, skcms_AlphaFormat_Unpremul, srcProfile,
+                                           expected, dstFmt, dstAlpha, dstProfile, kPixels));
+        // Running it twice checks the compiled transform isn't consumed by use.
+        for (int run = 0; run < 2; ++run) {
+            REPORTER_ASSERT(r, skcms_RunCompiledTransform(xform.get(), src, actual, kPixels));
+            REPORTER_ASSERT(r, 0 == memcmp(expected, actual, sizeof(actual)));
+        }
+    }}}
+
+    // Like skcms_Transform(), in-place conversion between formats of different sizes is refused.
+    std::unique_ptr<skcms_CompiledTransform, SkFunctionObject<skcms_FreeCompiledTransform>> xform(
+            skcms_CompileTransform(skcms_PixelFormat_RGBA_8888, skcms_AlphaFormat_Unpremul, nullptr,
+                                   skcms_PixelFormat_RGB_888, skcms_AlphaFormat_Unpremul, &p3));
+    REPORTER_ASSERT(r, xform);
+    REPORTER_ASSERT(r, !skcms_RunCompiledTransform(xform.get(), src, src, kPixels));
+}
+
+DEF_TEST(ICC_ProfileCache, r) {
+    sk_sp<SkData> adobe = GetResourceAsData("icc_profiles/AdobeRGB1998.icc");
+    sk_sp<SkData> hp = GetResourceAsData("icc_profiles/HP_ZR30w.icc");
+    if (!adobe || !hp) {
+        return;
+    }
+
+    SkICCProfileCache cache(adobe->size() + hp->size());
+    auto first = cache.intern(adobe);
+    REPORTER_ASSERT(r, first && first->fColorSpace && first->fColorSpaceIsExact);
+
+    // Equal bytes in a different SkData find the same profile and color space.
+    auto second = cache.intern(SkData::MakeWithCopy(adobe->data(), adobe->size()));
+    REPORTER_ASSERT(r, second == first);
+    REPORTER_ASSERT(r, second->fData == adobe);
+    auto stats = cache.stats();
+    REPORTER_ASSERT(r, stats.fHits == 1 && stats.fMisses == 1 && stats.fCount == 1);
+    REPORTER_ASSERT(r, stats.fBytesUsed == adobe->size());
+
+    // Bytes that aren't a profile are neither returned nor cached.
+    const uint8_t junk[64] = {};
+    REPORTER_ASSERT(r, !cache.intern(SkData::MakeWithCopy(junk, sizeof(junk))));
+    REPORTER_ASSERT(r, cache.stats().fCount == 1);
+
+    // Another profile fits under the limit; one more pushes out the least recently used.
+    auto hpEntry = cache.intern(hp);
+    REPORTER_ASSERT(r, hpEntry && hpEntry != first);
+    REPORTER_ASSERT(r, cache.stats().fCount == 2);
+    REPORTER_ASSERT(r, cache.intern(adobe) == first);
+    sk_sp<SkData> z32 = GetResourceAsData("icc_profiles/HP_Z32x.icc");
+    if (z32 && cache.intern(z32)) {
+        stats = cache.stats();
+        REPORTER_ASSERT(r, stats.fBytesUsed <= adobe->size() + hp->size());
+        REPORTER_ASSERT(r, cache.intern(adobe) == first);
+        REPORTER_ASSERT(r, cache.intern(hp) != hpEntry);
+    }
+
+    // Returned profiles outlive a purge; later lookups parse again.
+    cache.purgeAll();
+    REPORTER_ASSERT(r, cache.stats().fCount == 0 && cache.stats().fBytesUsed == 0);
+    REPORTER_ASSERT(r, first->fColorSpace);
+    auto reparsed = cache.intern(adobe);
+    REPORTER_ASSERT(r, reparsed != first);
+    REPORTER_ASSERT(r, SkColorSpace::Equals(reparsed->fColorSpace.get(), first->fColorSpace.get()));
+}
@@ -30,6 +30,7 @@
 #include "include/private/base/SkDebug.h"
 #include "include/private/gpu/ganesh/GrTypesPriv.h"
 #include "src/core/SkImageFilterCache.h"
+#include "src/core/SkImageFilter_Base.h"
 #include "src/core/SkImageFilterTypes.h"
 #include "src/core/SkSpecialImage.h"
 #include "src/gpu/ganesh/GrColorInfo.h" // IWYU pragma: keep
@@ -184,6 +185,85 @@ static void test_explicit_purging(skiatest::Reporter* reporter,
     REPORTER_ASSERT(reporter, !cache->get(key2, &foundImage));
 }
 
+// Results larger than the byte limit are never cached, and lowering the limit purges.
+static void test_byte_limit(skiatest::Reporter* reporter,
+                            const sk_sp<SkSpecialImage>& image) {
+    const size_t imageSize = image->getSize();
+    sk_sp<SkImageFilterCache> cache(SkImageFilterCache::Create(imageSize - 1));
+
+    SkIRect clip = SkIRect::MakeWH(100, 100);
+    SkImageFilterCacheKey key1(0, SkMatrix::I(), clip, image->uniqueID(), image->subset());
+    SkImageFilterCacheKey key2(1, SkMatrix::I(), clip, image->uniqueID(), image->subset());
+
+    auto filter = make_filter();
+    skif::FilterResult result(image, skif::LayerSpace<SkIPoint>({0, 0}));
+    cache->set(key1, filter.get(), result);
+
+    skif::FilterResult foundImage;
+    REPORTER_ASSERT(reporter, !cache->get(key1, &foundImage));
+    REPORTER_ASSERT(reporter, cache->stats().fBytesUsed == 0);
+
+    REPORTER_ASSERT(reporter, cache->setByteLimit(2 * imageSize) == imageSize - 1);
+    cache->set(key1, filter.get(), result);
+    cache->set(key2, filter.get(), result);
+    REPORTER_ASSERT(reporter, cache->get(key1, &foundImage));
+    REPORTER_ASSERT(reporter, cache->get(key2, &foundImage));
+    REPORTER_ASSERT(reporter, cache->stats().fBytesUsed == 2 * imageSize);
+
+    cache->setByteLimit(imageSize);
+    SkImageFilterCache::Stats stats = cache->stats();
+    REPORTER_ASSERT(reporter, stats.fEntryCount == 1);
+    REPORTER_ASSERT(reporter, stats.fBytesUsed <= stats.fByteLimit);
+}
+
+static void test_stats(skiatest::Reporter* reporter, const sk_sp<SkSpecialImage>& image) {
+    sk_sp<SkImageFilterCache> cache(SkImageFilterCache::Create(1000000));
+
+    SkIRect clip = SkIRect::MakeWH(100, 100);
+    SkImageFilterCacheKey key1(0, SkMatrix::I(), clip, image->uniqueID(), image->subset());
+    SkImageFilterCacheKey key2(1, SkMatrix::I(), clip, image->uniqueID(), image->subset());
+
+    auto filter = make_filter();
+    cache->set(key1, filter.get(), skif::FilterResult(image, skif::LayerSpace<SkIPoint>({0, 0})));
+
+    skif::FilterResult foundImage;
+    cache->get(key1, &foundImage);
+    cache->get(key1, &foundImage);
+    cache->get(key2, &foundImage);
+
+    SkImageFilterCache::Stats stats = cache->stats();
+    REPORTER_ASSERT(reporter, stats.fHits == 2);
+    REPORTER_ASSERT(reporter, stats.fMisses == 1);
+    REPORTER_ASSERT(reporter, stats.fEntryCount == 1);
+    REPORTER_ASSERT(reporter, stats.fBytesUsed == image->getSize());
+}
+
+// Entries stored without a filter are keyed by content and outlive any one filter instance.
+static void test_content_keyed(skiatest::Reporter* reporter,
+                               const sk_sp<SkSpecialImage>& image) {
+    auto filter1 = make_filter();
+    auto filter2 = make_filter();
+    const uint32_t contentID = as_IFB(filter1)->contentID();
+    REPORTER_ASSERT(reporter, contentID == as_IFB(filter2)->contentID());
+    REPORTER_ASSERT(reporter, contentID != as_IFB(filter1)->uniqueID());
+    REPORTER_ASSERT(reporter, contentID != as_IFB(filter2)->uniqueID());
+
+    auto other = SkImageFilters::ColorFilter(
+            SkColorFilters::Blend(SK_ColorRED, SkBlendMode::kSrcIn), nullptr);
+    REPORTER_ASSERT(reporter, contentID != as_IFB(other)->contentID());
+
+    sk_sp<SkImageFilterCache> cache(SkImageFilterCache::Create(1000000));
+    SkIRect clip = SkIRect::MakeWH(100, 100);
+    SkImageFilterCacheKey key(contentID, SkMatrix::I(), clip, image->uniqueID(), image->subset());
+    cache->set(key, nullptr, skif::FilterResult(image, skif::LayerSpace<SkIPoint>({0, 0})));
+
+    cache->purgeByImageFilter(filter1.get());
+    filter1.reset();
+
+    skif::FilterResult foundImage;
+    REPORTER_ASSERT(reporter, cache->get(key, &foundImage));
+}
+
 DEF_TEST(ImageFilterCache_RasterBacked, reporter) {
     SkBitmap srcBM = create_bm();
 
@@ -200,6 +280,9 @@ DEF_TEST(ImageFilterCache_RasterBacked, reporter) {
     test_dont_find_if_diff_key(reporter, fullImg, subsetImg);
     test_internal_purge(reporter, fullImg);
     test_explicit_purging(reporter, fullImg, subsetImg);
+    test_byte_limit(reporter, fullImg);
+    test_stats(reporter, fullImg);
+    test_content_keyed(reporter, fullImg);
 }
 
 
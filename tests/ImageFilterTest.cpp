@@ -14,8 +14,10 @@
 #include "include/core/SkColorFilter.h"
 #include "include/core/SkColorType.h"
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkFlattenable.h"
 #include "include/core/SkFont.h"
+#include "include/core/SkGraphics.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkImageFilter.h"
 #include "include/core/SkImageInfo.h"
@@ -79,8 +81,11 @@
 #endif
 
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <cstring>
+#include <functional>
+#include <memory>
 #include <utility>
 #include <limits>
 
@@ -1104,6 +1109,159 @@ DEF_GANESH_TEST_FOR_RENDERING_CONTEXTS(ImageFilterMergeResultSize_Gpu,
     test_imagefilter_merge_result_size(reporter, ctxInfo.directContext());
 }
 
+// A drop shadow, blur and offset merged, then blended over another blur, evaluated with the inputs
+// of the merge and blend on a thread pool, must match evaluating them in order.
+DEF_SERIAL_TEST(ImageFilterParallelInputs, reporter) {
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+
+    // New filters are made for each draw so that the second can't use the first's cached results.
+    auto makeFilter = [] {
+        sk_sp<SkImageFilter> branches[] = {
+            SkImageFilters::DropShadow(4, 6, 3, 3, SK_ColorBLACK, nullptr),
+            SkImageFilters::Blur(5, 5, nullptr),
+            SkImageFilters::Offset(10, -4, SkImageFilters::Blur(2, 2, nullptr)),
+        };
+        return SkImageFilters::Blend(SkBlendMode::kSrcOver,
+                                     SkImageFilters::Blur(8, 1, nullptr),
+                                     SkImageFilters::Merge(branches, std::size(branches)));
+    };
+    auto draw = [&](SkBitmap* bitmap) {
+        bitmap->allocN32Pixels(256, 256);
+        bitmap->eraseColor(SK_ColorTRANSPARENT);
+        SkCanvas canvas(*bitmap);
+        SkPaint filterPaint;
+        filterPaint.setImageFilter(makeFilter());
+        canvas.saveLayer(nullptr, &filterPaint);
+        SkPaint paint;
+        paint.setAntiAlias(true);
+        paint.setColor(SK_ColorRED);
+        canvas.drawCircle(90, 100, 50, paint);
+        paint.setColor(SK_ColorBLUE);
+        canvas.drawRect(SkRect::MakeLTRB(120, 60, 210, 200), paint);
+        canvas.restore();
+    };
+
+    SkBitmap serial, parallel;
+    draw(&serial);
+    SkGraphics::SetParallelImageFilters(executor.get());
+    draw(&parallel);
+    SkGraphics::SetParallelImageFilters(nullptr);
+
+    for (int y = 0; y < serial.height(); ++y) {
+        if (memcmp(serial.getAddr32(0, y), parallel.getAddr32(0, y),
+                   serial.info().minRowBytes()) != 0) {
+            ERRORF(reporter, "Parallel filter inputs differ from serial inputs in row %d", y);
+            break;
+        }
+    }
+}
+
+// Evaluating a layer's filter in tiles, with or without a thread pool, must match evaluating it
+// once for the whole layer.
+DEF_SERIAL_TEST(ImageFilterTiled, reporter) {
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+
+    auto draw = [](SkBitmap* bitmap) {
+        bitmap->allocN32Pixels(300, 200);
+        bitmap->eraseColor(SK_ColorWHITE);
+        SkCanvas canvas(*bitmap);
+        canvas.translate(7, 5);
+        SkPaint filterPaint;
+        filterPaint.setImageFilter(SkImageFilters::Merge(
+                SkImageFilters::DropShadow(6, 4, 3, 3, SK_ColorBLACK, nullptr),
+                SkImageFilters::Offset(-5, 9, SkImageFilters::Blur(4, 2, nullptr))));
+        filterPaint.setAlphaf(0.75f);
+        canvas.saveLayer(nullptr, &filterPaint);
+        SkPaint paint;
+        paint.setAntiAlias(true);
+        paint.setColor(SK_ColorGREEN);
+        canvas.drawCircle(100, 90, 60, paint);
+        paint.setColor(SK_ColorMAGENTA);
+        canvas.drawRect(SkRect::MakeLTRB(150, 40, 260, 170), paint);
+        canvas.restore();
+    };
+    auto compare = [&](const SkBitmap& expected, const SkBitmap& actual, const char* name) {
+        for (int y = 0; y < expected.height(); ++y) {
+            if (memcmp(expected.getAddr32(0, y), actual.getAddr32(0, y),
+                       expected.info().minRowBytes()) != 0) {
+                ERRORF(reporter, "%s filter differs from untiled filter in row %d", name, y);
+                break;
+            }
+        }
+    };
+
+    SkBitmap untiled, tiled, parallel;
+    draw(&untiled);
+    SkGraphics::SetImageFilterTileSize(64);
+    draw(&tiled);
+    SkGraphics::SetParallelImageFilters(executor.get());
+    draw(&parallel);
+    SkGraphics::SetParallelImageFilters(nullptr);
+    SkGraphics::SetImageFilterTileSize(0);
+
+    compare(untiled, tiled, "Tiled");
+    compare(untiled, parallel, "Parallel tiled");
+}
+
+// Big raster blurs split their passes into spans that run on the default SkExecutor. With a thread
+// pool installed there, they must match blurring on the calling thread.
+DEF_SERIAL_TEST(ImageFilterParallelBlur, reporter) {
+    // Counts the spans handed to the pool, to make sure the blur really was split.
+    class CountingExecutor final : public SkExecutor {
+    public:
+        CountingExecutor() : fPool(SkExecutor::MakeFIFOThreadPool(4)) {}
+
+        void add(std::function<void(void)> work) override {
+            fCount.fetch_add(1, std::memory_order_relaxed);
+            fPool->add(std::move(work));
+        }
+        void borrow() override { fPool->borrow(); }
+
+        int count() const { return fCount.load(std::memory_order_relaxed); }
+
+    private:
+        std::unique_ptr<SkExecutor> fPool;
+        std::atomic<int> fCount{0};
+    };
+
+    // A blur in both directions, which blurs Y in place after X, and one only along Y. New filters
+    // are made for each draw so that the second can't use the first's cached results.
+    for (SkScalar sigmaX : {SkIntToScalar(7), SkIntToScalar(0)}) {
+        auto draw = [sigmaX](SkBitmap* bitmap) {
+            bitmap->allocN32Pixels(600, 400);
+            bitmap->eraseColor(SK_ColorWHITE);
+            SkCanvas canvas(*bitmap);
+            SkPaint filterPaint;
+            filterPaint.setImageFilter(SkImageFilters::Blur(sigmaX, 11, nullptr));
+            canvas.saveLayer(nullptr, &filterPaint);
+            SkPaint paint;
+            paint.setAntiAlias(true);
+            paint.setColor(SK_ColorRED);
+            canvas.drawCircle(200, 180, 120, paint);
+            paint.setColor(SK_ColorBLUE);
+            canvas.drawRect(SkRect::MakeLTRB(330, 50, 560, 370), paint);
+            canvas.restore();
+        };
+
+        SkBitmap serial, parallel;
+        draw(&serial);
+        CountingExecutor executor;
+        SkExecutor::SetDefault(&executor);
+        draw(&parallel);
+        SkExecutor::SetDefault(nullptr);
+
+        REPORTER_ASSERT(reporter, executor.count() > 0, "sigmaX %g", sigmaX);
+        for (int y = 0; y < serial.height(); ++y) {
+            if (memcmp(serial.getAddr32(0, y), parallel.getAddr32(0, y),
+                       serial.info().minRowBytes()) != 0) {
+                ERRORF(reporter, "Parallel blur (sigmaX %g) differs from serial blur in row %d",
+                       sigmaX, y);
+                break;
+            }
+        }
+    }
+}
+
 static void draw_blurred_rect(SkCanvas* canvas) {
     SkPaint filterPaint;
     filterPaint.setColor(SK_ColorWHITE);
@@ -6,25 +6,32 @@
  */
 
 #include "include/core/SkAlphaType.h"
+#include "include/core/SkBitmap.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColor.h"
 #include "include/core/SkColorSpace.h"
 #include "include/core/SkColorType.h"
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkGraphics.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkImageGenerator.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkPicture.h"
 #include "include/core/SkPictureRecorder.h"
+#include "include/core/SkPixmap.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkYUVAInfo.h"
 #include "include/core/SkYUVAPixmaps.h"
 #include "src/base/SkAutoMalloc.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/image/SkImageGeneratorPriv.h"
 #include "tests/Test.h"
 
+#include <atomic>
+#include <chrono>
 #include <memory>
+#include <thread>
 
 #if defined(SK_BUILD_FOR_MAC) || defined(SK_BUILD_FOR_IOS)
     #include "include/ports/SkImageGeneratorCG.h"
@@ -133,3 +140,67 @@ DEF_TEST(PictureImageGenerator, reporter) {
     }
 }
 
+
+// Counts how many times it is asked for pixels, and takes a while to produce them.
+class SlowCountingGenerator : public SkImageGenerator {
+public:
+    explicit SlowCountingGenerator(std::atomic<int>* decodes)
+            : SkImageGenerator(SkImageInfo::MakeN32Premul(64, 64)), fDecodes(decodes) {}
+
+protected:
+    bool onGetPixels(const SkImageInfo& info, void* pixels, size_t rowBytes,
+                     const Options&) override {
+        (*fDecodes)++;
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        return SkPixmap(info, pixels, rowBytes).erase(SK_ColorBLUE);
+    }
+
+private:
+    std::atomic<int>* fDecodes;
+};
+
+DEF_TEST(ImageGenerator_ConcurrentDecodesAreShared, reporter) {
+    std::atomic<int> decodes{0};
+    sk_sp<SkImage> image =
+            SkImages::DeferredFromGenerator(std::make_unique<SlowCountingGenerator>(&decodes));
+
+    auto executor = SkExecutor::MakeFIFOThreadPool(4);
+    std::atomic<int> blue{0};
+    SkTaskGroup tasks(*executor);
+    tasks.batch(8, [&](int) {
+        SkBitmap bitmap;
+        bitmap.allocPixels(image->imageInfo());
+        if (image->readPixels(nullptr, bitmap.pixmap(), 0, 0) &&
+            bitmap.getColor(10, 10) == SK_ColorBLUE) {
+            blue++;
+        }
+    });
+    tasks.wait();
+    REPORTER_ASSERT(reporter, blue == 8);
+    REPORTER_ASSERT(reporter, decodes == 1, "decoded %d times", decodes.load());
+}
+
+DEF_TEST(ImageGenerator_PrefetchDecode, reporter) {
+    auto executor = SkExecutor::MakeFIFOThreadPool(1);
+    for (SkExecutor* exec : {executor.get(), static_cast<SkExecutor*>(nullptr)}) {
+        std::atomic<int> decodes{0};
+        sk_sp<SkImage> image =
+                SkImages::DeferredFromGenerator(std::make_unique<SlowCountingGenerator>(&decodes));
+        image->prefetchDecode(exec);
+
+        // Whether the prefetch has finished, is still decoding, or has not started yet, this
+        // read and the prefetch share a single decode: whichever runs second finds the pixels in
+        // the cache.
+        SkBitmap bitmap;
+        bitmap.allocPixels(image->imageInfo());
+        REPORTER_ASSERT(reporter, image->readPixels(nullptr, bitmap.pixmap(), 0, 0));
+        REPORTER_ASSERT(reporter, bitmap.getColor(10, 10) == SK_ColorBLUE);
+        REPORTER_ASSERT(reporter, decodes == 1, "decoded %d times", decodes.load());
+    }
+
+    // Images that are not lazily generated have nothing to prefetch.
+    SkBitmap raster;
+    raster.allocN32Pixels(8, 8);
+    raster.eraseColor(SK_ColorRED);
+    raster.asImage()->prefetchDecode(executor.get());
+}
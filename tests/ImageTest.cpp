@@ -559,6 +559,38 @@ DEF_GANESH_TEST_FOR_RENDERING_CONTEXTS(SkImage_makeNonTextureImage,
     }
 }
 
+DEF_GANESH_TEST_FOR_RENDERING_CONTEXTS(SkImage_TextureFromPixelWriter,
+                                       reporter,
+                                       contextInfo,
+                                       CtsEnforcement::kNextRelease) {
+    auto dContext = contextInfo.directContext();
+    sk_sp<SkImage> src = create_image();
+
+    int calls = 0;
+    sk_sp<SkImage> image = SkImages::TextureFromPixelWriter(
+            dContext, src->imageInfo(), [&](const SkPixmap& dst) {
+                ++calls;
+                REPORTER_ASSERT(reporter, dst.info() == src->imageInfo());
+                return src->readPixels(nullptr, dst, 0, 0);
+            });
+    REPORTER_ASSERT(reporter, calls == 1);
+    if (!image) {
+        ERRORF(reporter, "TextureFromPixelWriter failed.");
+        return;
+    }
+    REPORTER_ASSERT(reporter, image->isTextureBacked());
+    assert_equal(reporter, dContext, image.get(), nullptr, src.get());
+
+    // A writer that fails means there is no image.
+    calls = 0;
+    image = SkImages::TextureFromPixelWriter(dContext, src->imageInfo(), [&](const SkPixmap&) {
+        ++calls;
+        return false;
+    });
+    REPORTER_ASSERT(reporter, calls == 1);
+    REPORTER_ASSERT(reporter, !image);
+}
+
 DEF_GANESH_TEST_FOR_RENDERING_CONTEXTS(GrContext_colorTypeSupportedAsImage,
                                        reporter,
                                        ctxInfo,
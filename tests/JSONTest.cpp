@@ -15,6 +15,7 @@
 #include "tests/Test.h"
 
 #include <cstring>
+#include <string>
 #include <string_view>
 
 using namespace skjson;
@@ -535,3 +536,37 @@ DEF_TEST(JSON_Writable, r) {
     REPORTER_ASSERT(r, root.toString() ==
         SkString(R"({"null":42,"num":"foo","new":true,"newobj":{"newprop":-1}})"));
 }
+
+DEF_TEST(JSON_Binary, r) {
+    static constexpr char json[] =
+        R"({"int":42,"float":-1.5,"bool":[true,false],"null":null,"short":"abc",)"
+        R"("long":"a string which does not fit inline","nested":[[],{},[{"a":{"b":[1,2,3]}}]],)"
+        R"("a key which does not fit inline":{}})";
+    const DOM dom(json, strlen(json));
+    REPORTER_ASSERT(r, dom.root().is<ObjectValue>());
+
+    SkDynamicMemoryWStream stream;
+    dom.write(&stream, DOM::Format::kBinary);
+    const auto data = stream.detachAsData();
+    const auto* bytes = static_cast<const char*>(data->data());
+    REPORTER_ASSERT(r, DOM::IsBinary(bytes, data->size()));
+    REPORTER_ASSERT(r, !DOM::IsBinary(json, strlen(json)));
+
+    const DOM binary(bytes, data->size(), DOM::Format::kBinary);
+    REPORTER_ASSERT(r, binary.root().toString() == dom.root().toString());
+    const auto& nested = binary.root()["nested"].as<ArrayValue>()[2].as<ArrayValue>();
+    REPORTER_ASSERT(r, nested[0]["a"]["b"].is<ArrayValue>());
+
+    // Truncated or corrupt data is rejected rather than partially loaded.
+    for (size_t size = 0; size < data->size(); size += 8) {
+        REPORTER_ASSERT(r, DOM(bytes, size, DOM::Format::kBinary).root().is<NullValue>());
+    }
+    for (size_t i = 8; i < data->size(); ++i) {
+        std::string corrupt(bytes, data->size());
+        corrupt[i] ^= 0x5a;
+        const DOM d(corrupt.data(), corrupt.size(), DOM::Format::kBinary);
+        // Flipped bits in values may still load, but only as a complete DOM.
+        REPORTER_ASSERT(r, d.root().is<NullValue>() || d.root().is<ObjectValue>());
+        d.root().toString();
+    }
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkTypes.h"
+
+#ifdef SK_CODEC_DECODES_JPEGXL
+#include "include/core/SkExecutor.h"
+#include "src/codec/SkJpegxlCodec.h"
+#include "tests/Test.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+DEF_TEST(JpegxlRunParallelSerial, r) {
+    // An empty range doesn't set anything up.
+    REPORTER_ASSERT(r, SkJpegxlCodec::RunParallel(
+            nullptr, 5, 5,
+            [&](size_t) { ERRORF(r, "init called for an empty range"); return true; },
+            [&](uint32_t, size_t) { ERRORF(r, "func called for an empty range"); }));
+
+    // Without an executor, every value runs in order on this thread.
+    const std::thread::id thisThread = std::this_thread::get_id();
+    size_t workers = 0;
+    std::vector<uint32_t> values;
+    REPORTER_ASSERT(r, SkJpegxlCodec::RunParallel(
+            nullptr, 3, 40,
+            [&](size_t workerCount) { workers = workerCount; return true; },
+            [&](uint32_t value, size_t worker) {
+                REPORTER_ASSERT(r, worker == 0);
+                REPORTER_ASSERT(r, std::this_thread::get_id() == thisThread);
+                values.push_back(value);
+            }));
+    REPORTER_ASSERT(r, workers == 1);
+    REPORTER_ASSERT(r, values.size() == 37);
+    for (size_t i = 0; i < values.size(); ++i) {
+        REPORTER_ASSERT(r, values[i] == 3 + i, "value %zu is %u", i, values[i]);
+    }
+
+    // A failed init stops the loop before it starts.
+    REPORTER_ASSERT(r, !SkJpegxlCodec::RunParallel(
+            nullptr, 0, 10,
+            [](size_t) { return false; },
+            [&](uint32_t, size_t) { ERRORF(r, "func called after init failed"); }));
+}
+
+DEF_TEST(JpegxlRunParallelExecutor, r) {
+    auto executor = SkExecutor::MakeFIFOThreadPool(4);
+    for (uint32_t count : {1u, 3u, SkJpegxlCodec::kMaxParallelWorkers, 500u}) {
+        size_t workers = 0;
+        std::vector<std::atomic<int>> runs(count);
+        std::atomic<bool> busy[SkJpegxlCodec::kMaxParallelWorkers] = {};
+        std::atomic<bool> overlapped{false}, badWorker{false};
+        REPORTER_ASSERT(r, SkJpegxlCodec::RunParallel(
+                executor.get(), 100, 100 + count,
+                [&](size_t workerCount) { workers = workerCount; return true; },
+                [&](uint32_t value, size_t worker) {
+                    if (worker >= workers) {
+                        badWorker = true;
+                        return;
+                    }
+                    // libjxl gives each worker its own scratch space, so no two calls for a
+                    // worker may overlap.
+                    if (busy[worker].exchange(true)) {
+                        overlapped = true;
+                    }
+                    runs[value - 100]++;
+                    std::this_thread::yield();
+                    busy[worker] = false;
+                }));
+        const size_t expectedWorkers = std::min(count, SkJpegxlCodec::kMaxParallelWorkers);
+        REPORTER_ASSERT(r, workers == expectedWorkers, "count %u: %zu workers", count, workers);
+        REPORTER_ASSERT(r, !badWorker, "count %u", count);
+        REPORTER_ASSERT(r, !overlapped, "count %u", count);
+        for (uint32_t i = 0; i < count; ++i) {
+            REPORTER_ASSERT(r, runs[i] == 1, "count %u: value %u ran %d times", count, i,
+                            runs[i].load());
+        }
+    }
+
+    // A failed init stops the loop before anything is run on the executor.
+    REPORTER_ASSERT(r, !SkJpegxlCodec::RunParallel(
+            executor.get(), 0, 10,
+            [](size_t) { return false; },
+            [&](uint32_t, size_t) { ERRORF(r, "func called after init failed"); }));
+}
+
+#endif  // SK_CODEC_DECODES_JPEGXL
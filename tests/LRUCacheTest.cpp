@@ -70,3 +70,28 @@ DEF_TEST(LRUCacheRandom, r) {
     }
     REPORTER_ASSERT(r, 0 == instances);
 }
+
+DEF_TEST(LRUCacheRemoveLeastRecentlyUsed, r) {
+    int instances = 0;
+    {
+        SkLRUCache<int, std::unique_ptr<Value>> test(10);
+        for (int k : {1, 2, 3}) {
+            test.insert(k, std::make_unique<Value>(k, &instances));
+        }
+        REPORTER_ASSERT(r, test.find(1));
+
+        std::unique_ptr<Value> removed;
+        REPORTER_ASSERT(r, test.removeLeastRecentlyUsed(&removed));
+        REPORTER_ASSERT(r, removed && removed->fValue == 2);
+        REPORTER_ASSERT(r, !test.find(2));
+        removed.reset();
+
+        REPORTER_ASSERT(r, test.removeLeastRecentlyUsed());
+        REPORTER_ASSERT(r, !test.find(3));
+        REPORTER_ASSERT(r, 1 == instances);
+        REPORTER_ASSERT(r, test.removeLeastRecentlyUsed());
+        REPORTER_ASSERT(r, !test.removeLeastRecentlyUsed());
+        REPORTER_ASSERT(r, 0 == test.count());
+    }
+    REPORTER_ASSERT(r, 0 == instances);
+}
@@ -6,14 +6,17 @@
  */
 
 #include "include/core/SkData.h"
+#include "include/core/SkGraphics.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkMallocPixelRef.h"
 #include "include/core/SkPixelRef.h"
 #include "include/core/SkRefCnt.h"
+#include "include/private/base/SkMalloc.h"
 #include "src/base/SkAutoMalloc.h"
 #include "src/core/SkPixelRefPriv.h"
 #include "tests/Test.h"
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 
@@ -106,3 +109,60 @@ DEF_TEST(MallocPixelRef, reporter) {
         REPORTER_ASSERT(reporter, dataPtr->data() == pr->pixels());
     }
 }
+
+namespace {
+struct CountingAllocator {
+    std::atomic<int> fAllocs{0};
+    std::atomic<int> fFrees{0};
+};
+}  // namespace
+
+static void* counting_alloc(size_t bytes, void* ctx) {
+    static_cast<CountingAllocator*>(ctx)->fAllocs++;
+    return sk_calloc_canfail(bytes);
+}
+
+static void counting_free(void* pixels, size_t, void* ctx) {
+    auto allocator = static_cast<CountingAllocator*>(ctx);
+    allocator->fFrees++;
+    sk_free(pixels);
+}
+
+// The allocator is process-wide, so this runs alone; every pixel it allocates is freed here.
+DEF_SERIAL_TEST(MallocPixelRef_Allocator, reporter) {
+    const SkImageInfo small = SkImageInfo::MakeN32Premul(16, 16);
+    const SkImageInfo large = SkImageInfo::MakeN32Premul(1024, 768);
+
+    CountingAllocator counts;
+    SkGraphics::RasterPixelAllocator allocator;
+    allocator.fAlloc = counting_alloc;
+    allocator.fFree = counting_free;
+    allocator.fCtx = &counts;
+    allocator.fMinBytes = large.computeMinByteSize();
+    const SkGraphics::RasterPixelAllocator prev = SkGraphics::SetRasterPixelAllocator(allocator);
+    {
+        const int allocs = counts.fAllocs;
+        sk_sp<SkPixelRef> smallPR = SkMallocPixelRef::MakeAllocate(small, 0);
+        REPORTER_ASSERT(reporter, smallPR);
+        sk_sp<SkPixelRef> largePR = SkMallocPixelRef::MakeAllocate(large, 0);
+        REPORTER_ASSERT(reporter, largePR && counts.fAllocs == allocs + 1);
+
+        // Replacing the allocator doesn't change how existing pixels are freed.
+        SkGraphics::SetRasterPixelAllocator(prev);
+        const int frees = counts.fFrees;
+        largePR.reset();
+        REPORTER_ASSERT(reporter, counts.fFrees == frees + 1);
+    }
+
+    SkGraphics::SetRasterPixelAllocator(SkGraphics::HugePageRasterPixelAllocator(1024 * 1024));
+    {
+        sk_sp<SkPixelRef> pr = SkMallocPixelRef::MakeAllocate(large, 0);
+        REPORTER_ASSERT(reporter, pr);
+        const uint32_t* pixels = static_cast<const uint32_t*>(pr->pixels());
+        REPORTER_ASSERT(reporter, pixels[0] == 0 && pixels[1024 * 768 - 1] == 0);
+#if defined(SK_BUILD_FOR_UNIX) || defined(SK_BUILD_FOR_ANDROID)
+        REPORTER_ASSERT(reporter, reinterpret_cast<uintptr_t>(pixels) % (2 * 1024 * 1024) == 0);
+#endif
+    }
+    SkGraphics::SetRasterPixelAllocator(prev);
+}
@@ -1039,6 +1039,58 @@ DEF_TEST(Matrix_maprects, r) {
     }
 }
 
+// Test that the batched mappers agree with the one-at-a-time ones.
+DEF_TEST(Matrix_mapBatch, r) {
+    constexpr int N = 37;  // Not a multiple of the kernels' stride, to cover the tail.
+
+    SkRandom rand;
+    SkPoint pts[N];
+    SkRect rects[N];
+    for (int i = 0; i < N; ++i) {
+        pts[i].set(rand.nextSScalar1() * 100, rand.nextSScalar1() * 100);
+        rects[i] = SkRect::MakeXYWH(pts[i].fX, pts[i].fY,
+                                    rand.nextUScalar1() * 50, rand.nextUScalar1() * 50);
+    }
+
+    SkMatrix affine = SkMatrix::RotateDeg(30).postScale(1.5f, 0.5f).postTranslate(3, 4);
+    SkMatrix persp = affine;
+    persp.setPerspX(0.001f);
+    persp.setPerspY(-0.002f);
+
+    auto nearly_equal = [](SkPoint a, SkPoint b) {
+        return SkScalarNearlyEqual(a.fX, b.fX, 1e-3f) && SkScalarNearlyEqual(a.fY, b.fY, 1e-3f);
+    };
+
+    for (const SkMatrix& m : {affine, persp}) {
+        SkPoint dst[N];
+        SkPoint3 dst3[N];
+        m.mapPoints(dst, pts, N);
+        m.mapHomogeneousPoints(dst3, pts, N);
+        for (int i = 0; i < N; ++i) {
+            SkPoint expected = m.mapXY(pts[i].fX, pts[i].fY);
+            REPORTER_ASSERT(r, nearly_equal(dst[i], expected));
+            REPORTER_ASSERT(r, nearly_equal({dst3[i].fX / dst3[i].fZ, dst3[i].fY / dst3[i].fZ},
+                                            expected));
+        }
+    }
+
+    SkRect dstRects[N];
+    SkMatrixPriv::MapRects(affine, dstRects, rects, N);
+    for (int i = 0; i < N; ++i) {
+        SkRect expected = affine.mapRect(rects[i]);
+        REPORTER_ASSERT(r, nearly_equal({dstRects[i].fLeft, dstRects[i].fTop},
+                                        {expected.fLeft, expected.fTop}));
+        REPORTER_ASSERT(r, nearly_equal({dstRects[i].fRight, dstRects[i].fBottom},
+                                        {expected.fRight, expected.fBottom}));
+    }
+
+    // Non-finite results are reported the same way as mapRect() does.
+    SkMatrix huge = SkMatrix::RotateDeg(30).postScale(1e20f, 1e20f);
+    SkRect big = {0, 0, 1e20f, 1e20f};
+    SkMatrixPriv::MapRects(huge, &big, &big, 1);
+    REPORTER_ASSERT(r, !big.isFinite());
+}
+
 DEF_TEST(Matrix_mapRect_skbug12335, r) {
     // Stripped down test case from skbug.com/12335. Essentially, the corners of this rect would
     // map to homogoneous coords with very small w's (below the old value of kW0PlaneDistance) and
@@ -5,27 +5,42 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkBitmap.h"
 #include "include/core/SkBlendMode.h"
 #include "include/core/SkBlender.h"
+#include "include/core/SkCanvas.h"
 #include "include/core/SkColor.h"
 #include "include/core/SkColorFilter.h"
 #include "include/core/SkData.h"
+#include "include/core/SkImageInfo.h"
 #include "include/core/SkMesh.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkPoint.h"
 #include "include/core/SkRect.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkShader.h"
 #include "include/core/SkSpan.h"
 #include "include/core/SkString.h"
+#include "include/core/SkSurface.h"
 #include "include/core/SkTypes.h"
 #include "include/effects/SkRuntimeEffect.h"
+#include "include/gpu/GpuTypes.h"
+#include "include/gpu/GrDirectContext.h"
+#include "include/gpu/ganesh/SkMeshGanesh.h"
+#include "include/gpu/ganesh/SkSurfaceGanesh.h"
 #include "src/base/SkZip.h"
 #include "src/core/SkMeshPriv.h"
+#include "src/gpu/ganesh/GrCanvas.h"
+#include "src/gpu/ganesh/SurfaceDrawContext.h"
+#include "src/gpu/ganesh/ops/OpsTask.h"
+#include "tests/CtsEnforcement.h"
 #include "tests/Test.h"
 
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <initializer_list>
+#include <iterator>
 #include <limits>
 #include <string>
 #include <string_view>
@@ -1244,3 +1259,88 @@ DEF_TEST(MeshSpecUnusedVaryings, reporter) {
           false,
           true);
 }
+
+// Draws four quads with the same spec, the first three red and the last green, and checks that
+// the red ones are batched into one op.
+static void test_mesh_batching(skiatest::Reporter* reporter,
+                               GrDirectContext* dContext,
+                               bool gpuBuffers) {
+    static const Attribute kAttributes[] = {{Attribute::Type::kFloat2, 0, SkString{"pos"}}};
+    static const SkString kVS{R"(
+        Varyings main(const Attributes attrs) {
+            Varyings v;
+            v.position = attrs.pos;
+            return v;
+        })"};
+    static const SkString kFS{R"(
+        uniform half4 color;
+        float2 main(const Varyings v, out half4 c) {
+            c = color;
+            return v.position;
+        })"};
+    sk_sp<SkMeshSpecification> spec;
+    if (!check_for_success(reporter, kAttributes, sizeof(SkPoint), {}, kVS, kFS, &spec)) {
+        return;
+    }
+
+    const SkImageInfo ii = SkImageInfo::Make(32, 8, kRGBA_8888_SkColorType, kPremul_SkAlphaType);
+    sk_sp<SkSurface> surface = SkSurfaces::RenderTarget(dContext, skgpu::Budgeted::kNo, ii);
+    if (!surface) {
+        ERRORF(reporter, "Could not create surface");
+        return;
+    }
+    SkCanvas* canvas = surface->getCanvas();
+    canvas->clear(SK_ColorTRANSPARENT);
+    auto sdc = skgpu::ganesh::TopDeviceSurfaceDrawContext(canvas);
+    const int opChainsBefore = sdc->testingOnly_PeekLastOpsTask()->numOpChains();
+
+    static constexpr float kRed[]   = {1, 0, 0, 1};
+    static constexpr float kGreen[] = {0, 1, 0, 1};
+    for (int i = 0; i < 4; ++i) {
+        const SkRect r = SkRect::MakeXYWH(8 * i, 0, 8, 8);
+        const SkPoint verts[] = {{r.fLeft,  r.fTop}, {r.fRight, r.fTop}, {r.fLeft,  r.fBottom},
+                                 {r.fRight, r.fTop}, {r.fRight, r.fBottom}, {r.fLeft, r.fBottom}};
+        sk_sp<SkMesh::VertexBuffer> vb =
+                SkMeshes::MakeVertexBuffer(gpuBuffers ? dContext : nullptr, verts, sizeof(verts));
+        sk_sp<SkData> uniforms = SkData::MakeWithCopy(i < 3 ? kRed : kGreen, sizeof(kRed));
+        SkMesh::Result result = SkMesh::Make(spec,
+                                             SkMesh::Mode::kTriangles,
+                                             std::move(vb),
+                                             std::size(verts),
+                                             /*vertexOffset=*/0,
+                                             std::move(uniforms),
+                                             /*children=*/{},
+                                             r);
+        if (!result.mesh.isValid()) {
+            ERRORF(reporter, "Invalid mesh: %s", result.error.c_str());
+            return;
+        }
+        canvas->drawMesh(result.mesh, SkBlender::Mode(SkBlendMode::kDst), SkPaint());
+    }
+
+    const int opChains = sdc->testingOnly_PeekLastOpsTask()->numOpChains() - opChainsBefore;
+    REPORTER_ASSERT(reporter, opChains == 2, "gpuBuffers=%d opChains=%d", gpuBuffers, opChains);
+
+    SkBitmap bitmap;
+    bitmap.allocPixels(ii);
+    if (!surface->readPixels(bitmap, 0, 0)) {
+        ERRORF(reporter, "Could not read pixels");
+        return;
+    }
+    for (int i = 0; i < 4; ++i) {
+        const SkColor expected = i < 3 ? SK_ColorRED : SK_ColorGREEN;
+        const SkColor actual = bitmap.getColor(8 * i + 4, 4);
+        REPORTER_ASSERT(reporter, actual == expected,
+                        "gpuBuffers=%d quad %d: expected 0x%08x, got 0x%08x",
+                        gpuBuffers, i, expected, actual);
+    }
+}
+
+DEF_GANESH_TEST_FOR_RENDERING_CONTEXTS(Mesh_BatchesDrawsSharingSpec,
+                                       reporter,
+                                       ctxInfo,
+                                       CtsEnforcement::kNextRelease) {
+    for (bool gpuBuffers : {false, true}) {
+        test_mesh_batching(reporter, ctxInfo.directContext(), gpuBuffers);
+    }
+}
@@ -235,6 +235,76 @@ DEF_TEST(MipMap_F16, reporter) {
     sk_sp<SkMipmap> mipmap(SkMipmap::Build(bmp, nullptr));
 }
 
+// Each 8888 level is the previous level filtered by a box over two pixels along even-sized axes
+// and a 1-2-1 tent over three pixels along odd-sized ones. Large levels take the vectorized
+// kernels and are built in bands of rows, which must match this reference exactly.
+static SkColor mip_reference_8888(const SkPixmap& src, int x, int y) {
+    auto taps = [](int size, int weights[3]) {
+        if (size == 1) {
+            weights[0] = 1, weights[1] = weights[2] = 0;
+            return 0;
+        }
+        if (size & 1) {
+            weights[0] = 1, weights[1] = 2, weights[2] = 1;
+            return 2;
+        }
+        weights[0] = weights[1] = 1, weights[2] = 0;
+        return 1;
+    };
+    int wx[3], wy[3];
+    const int shift = taps(src.width(), wx) + taps(src.height(), wy);
+    const int sx = src.width() == 1 ? 0 : 2 * x, sy = src.height() == 1 ? 0 : 2 * y;
+
+    uint32_t result = 0;
+    for (int c = 0; c < 4; ++c) {
+        int sum = 0;
+        for (int j = 0; j < 3; ++j) {
+            for (int i = 0; i < 3; ++i) {
+                if (wx[i] && wy[j]) {
+                    sum += wx[i] * wy[j] * ((*src.addr32(sx + i, sy + j) >> (8 * c)) & 0xFF);
+                }
+            }
+        }
+        result |= (uint32_t)(sum >> shift) << (8 * c);
+    }
+    return result;
+}
+
+DEF_TEST(MipMap_8888Reference, reporter) {
+    SkRandom rand;
+    for (SkISize size : {SkISize{600, 530}, SkISize{601, 531}, SkISize{602, 531},
+                         SkISize{601, 530}, SkISize{37, 5}}) {
+        SkBitmap bm;
+        bm.allocPixels(SkImageInfo::Make(size, kRGBA_8888_SkColorType, kPremul_SkAlphaType));
+        for (int y = 0; y < bm.height(); ++y) {
+            for (int x = 0; x < bm.width(); ++x) {
+                *bm.getAddr32(x, y) = rand.nextU();
+            }
+        }
+        sk_sp<SkMipmap> mm(SkMipmap::Build(bm, nullptr));
+        REPORTER_ASSERT(reporter, mm);
+        if (!mm) {
+            continue;
+        }
+
+        SkPixmap src = bm.pixmap();
+        for (int i = 0; i < mm->countLevels(); ++i) {
+            SkMipmap::Level level;
+            REPORTER_ASSERT(reporter, mm->getLevel(i, &level));
+            const SkPixmap& dst = level.fPixmap;
+            int mismatches = 0;
+            for (int y = 0; y < dst.height(); ++y) {
+                for (int x = 0; x < dst.width(); ++x) {
+                    mismatches += *dst.addr32(x, y) != mip_reference_8888(src, x, y);
+                }
+            }
+            REPORTER_ASSERT(reporter, mismatches == 0, "%dx%d level %d: %d mismatches",
+                            size.width(), size.height(), i, mismatches);
+            src = dst;
+        }
+    }
+}
+
 static void fill_in_mips(SkMipmapBuilder* builder, sk_sp<SkImage> img) {
     int count = builder->countLevels();
     for (int i = 0; i < count; ++i) {
@@ -181,6 +181,59 @@ DEF_TEST(SkMultiPictureDocument_Serialize_and_deserialize, reporter) {
     }
 }
 
+// Pages of a document can be read on their own, in any order.
+DEF_TEST(SkMultiPictureDocument_Reader, reporter) {
+    static const int NUM_PAGES = 5;
+    auto surface(SkSurfaces::Raster(SkImageInfo::MakeN32Premul(100, 100)));
+    surface->getCanvas()->clear(SK_ColorGREEN);
+    sk_sp<SkImage> image(surface->makeImageSnapshot());
+
+    SkDynamicMemoryWStream stream;
+    sk_sp<SkDocument> multipic = SkMultiPictureDocument::Make(&stream);
+    std::vector<sk_sp<SkImage>> expectedImages;
+    for (int i = 0; i < NUM_PAGES; i++) {
+        // Every page uses the same typeface, which the document stores once.
+        const SkImageInfo info = SkImageInfo::MakeN32Premul(200 + i, 256);
+        draw_basic(multipic->beginPage(info.width(), info.height()), i + 1, image);
+        multipic->endPage();
+        auto surf = SkSurfaces::Raster(info);
+        draw_basic(surf->getCanvas(), i + 1, image);
+        expectedImages.push_back(surf->makeImageSnapshot());
+    }
+    multipic->close();
+    std::unique_ptr<SkStreamAsset> writtenStream = stream.detachAsStream();
+
+    auto reader = SkMultiPictureDocument::Reader::Make(writtenStream.get());
+    REPORTER_ASSERT(reporter, reader);
+    if (!reader) {
+        return;
+    }
+    REPORTER_ASSERT(reporter, reader->pageCount() == NUM_PAGES);
+    REPORTER_ASSERT(reporter, !reader->readPage(-1));
+    REPORTER_ASSERT(reporter, !reader->readPage(NUM_PAGES));
+
+    for (int i : {3, 1, 4, 0, 3}) {
+        REPORTER_ASSERT(reporter, reader->pageSize(i) == SkSize::Make(200 + i, 256));
+        sk_sp<SkPicture> page = reader->readPage(i);
+        REPORTER_ASSERT(reporter, page, "Failed to read page %d", i);
+        if (!page) {
+            continue;
+        }
+        auto surf = SkSurfaces::Raster(expectedImages[i]->imageInfo());
+        surf->getCanvas()->drawPicture(page);
+        auto img = surf->makeImageSnapshot();
+        REPORTER_ASSERT(reporter, ToolUtils::equal_pixels(img.get(), expectedImages[i].get()),
+                        "Page %d is wrong", i);
+    }
+
+    // A truncated document is rejected when it's opened.
+    writtenStream->rewind();
+    sk_sp<SkData> truncated = SkData::MakeFromStream(writtenStream.get(),
+                                                     writtenStream->getLength() - 1);
+    SkMemoryStream truncatedStream(truncated);
+    REPORTER_ASSERT(reporter, !SkMultiPictureDocument::Reader::Make(&truncatedStream));
+}
+
 
 #if defined(SK_GANESH) && defined(SK_BUILD_FOR_ANDROID) && __ANDROID_API__ >= 26
 
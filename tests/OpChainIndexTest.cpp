@@ -0,0 +1,65 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkRect.h"
+#include "include/private/base/SkTArray.h"
+#include "src/base/SkRandom.h"
+#include "src/gpu/ganesh/geometry/GrRect.h"
+#include "src/gpu/ganesh/ops/OpChainIndex.h"
+#include "tests/Test.h"
+
+#include <algorithm>
+#include <cstdint>
+
+using namespace skia_private;
+
+DEF_TEST(OpChainIndex, r) {
+    // Chains all over, and a little outside of, a 256x256 target, some of which grow as they are
+    // added to. The index answers as looking at every chain would.
+    skgpu::ganesh::OpChainIndex index(SkRect::MakeWH(256, 256));
+    TArray<SkRect> bounds;
+    TArray<uint32_t> classes;
+    SkRandom random;
+    auto randomRect = [&] {
+        const float x = random.nextRangeF(-16, 256), y = random.nextRangeF(-16, 256);
+        return SkRect::MakeXYWH(x, y, random.nextRangeF(0, 40), random.nextRangeF(0, 40));
+    };
+    for (int i = 0; i < 500; ++i) {
+        if (i > 0 && random.nextULessThan(4) == 0) {
+            const int grown = i - 1 - random.nextULessThan(std::min(i, 8));
+            bounds[grown].join(randomRect());
+            index.add(grown, classes[grown], bounds[grown]);
+        }
+        bounds.push_back(randomRect());
+        classes.push_back(random.nextULessThan(5));
+        index.add(i, classes.back(), bounds.back());
+        REPORTER_ASSERT(r, index.count() == bounds.size());
+
+        const SkRect query = randomRect();
+        const int minIndex = std::max(0, bounds.size() - 1 - (int)random.nextULessThan(50));
+        int expected = minIndex - 1;
+        for (int j = bounds.size() - 1; j >= minIndex; --j) {
+            if (GrRectsOverlap(bounds[j], query)) {
+                expected = j;
+                break;
+            }
+        }
+        REPORTER_ASSERT(r, index.lastOverlapping(query, minIndex) == expected,
+                        "%d: %d != %d", i, index.lastOverlapping(query, minIndex), expected);
+    }
+
+    for (uint32_t classID = 0; classID < 6; ++classID) {
+        TArray<int> expected;
+        for (int j = 0; j < classes.size(); ++j) {
+            if (classes[j] == classID) {
+                expected.push_back(j);
+            }
+        }
+        const TArray<int>* chains = index.chainsOfClass(classID);
+        REPORTER_ASSERT(r, chains ? *chains == expected : expected.empty());
+    }
+}
@@ -12,6 +12,7 @@
 #include "include/core/SkTypes.h"
 #include "include/gpu/GpuTypes.h"
 #include "include/gpu/GrBackendSurface.h"
+#include "include/gpu/GrContextOptions.h"
 #include "include/gpu/GrDirectContext.h"
 #include "include/gpu/GrTypes.h"
 #include "include/private/base/SkTDArray.h"
@@ -49,7 +50,6 @@ class GrDstProxyView;
 class GrRecordingContext;
 class SkArenaAlloc;
 enum class GrXferBarrierFlags;
-struct GrContextOptions;
 
 // We create Ops that write a value into a range of a buffer. We create ranges from
 // kNumOpPositions starting positions x kRanges canonical ranges. We repeat each range kNumRepeats
@@ -206,8 +206,8 @@ private:
  * adding the ops in all possible orders and verifies that the chained executions don't violate
  * painter's order.
  */
-DEF_GANESH_TEST(OpChainTest, reporter, /*ctxInfo*/, CtsEnforcement::kApiLevel_T) {
-    sk_sp<GrDirectContext> dContext = GrDirectContext::MakeMock(nullptr);
+static void test_op_chains(skiatest::Reporter* reporter, const GrContextOptions& options) {
+    sk_sp<GrDirectContext> dContext = GrDirectContext::MakeMock(nullptr, options);
     SkASSERT(dContext);
     const GrCaps* caps = dContext->priv().caps();
     static constexpr SkISize kDims = {kNumOps + 1, 1};
@@ -300,3 +300,14 @@ DEF_GANESH_TEST(OpChainTest, reporter, /*ctxInfo*/, CtsEnforcement::kApiLevel_T)
         }
     }
 }
+
+DEF_GANESH_TEST(OpChainTest, reporter, /*ctxInfo*/, CtsEnforcement::kApiLevel_T) {
+    test_op_chains(reporter, GrContextOptions());
+}
+
+DEF_GANESH_TEST(OpChainTest_ReorderLookback, reporter, /*ctxInfo*/, CtsEnforcement::kNever) {
+    // With every earlier chain in reach, found through the chain index.
+    GrContextOptions options;
+    options.fOpsTaskReorderLookback = 100;
+    test_op_chains(reporter, options);
+}
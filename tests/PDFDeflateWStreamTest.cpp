@@ -8,6 +8,7 @@
 #include "include/core/SkTypes.h"
 
 #ifdef SK_SUPPORT_PDF
+#include "include/core/SkData.h"
 #include "include/core/SkStream.h"
 #include "include/core/SkString.h"
 #include "include/private/base/SkDebug.h"
@@ -15,13 +16,16 @@
 #include "include/private/base/SkTemplates.h"
 #include "include/private/base/SkTo.h"
 #include "src/base/SkRandom.h"
+#include "src/core/SkStreamPriv.h"
 #include "src/pdf/SkDeflate.h"
 #include "tests/Test.h"
 
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <memory>
+#include <utility>
 
 #include "zlib.h"
 
@@ -177,4 +181,75 @@ DEF_TEST(SkPDF_DeflateWStream, r) {
     REPORTER_ASSERT(r, !emptyDeflateWStream.writeText("FOO"));
 }
 
+static bool inflates_to(skiatest::Reporter* r, sk_sp<SkData> compressed,
+                        const uint8_t* expected, size_t size) {
+    if (!compressed) {
+        return false;
+    }
+    SkMemoryStream compressedStream(std::move(compressed));
+    std::unique_ptr<SkStreamAsset> decompressed = stream_inflate(r, &compressedStream);
+    if (!decompressed || decompressed->getLength() != size) {
+        return false;
+    }
+    sk_sp<SkData> data = SkCopyStreamToData(decompressed.get());
+    return size == 0 || memcmp(data->data(), expected, size) == 0;
+}
+
+DEF_TEST(SkPDF_DeflateCompress, r) {
+    using Strategy = SkDeflateWStream::Strategy;
+    SkRandom random(654321);
+    for (size_t size : {0, 1, 4096, 100000}) {
+        // Runs of repeated bytes, so that every strategy has something to find.
+        AutoTMalloc<uint8_t> buffer(size);
+        for (size_t j = 0; j < size; ++j) {
+            buffer[j] = j % 64 < 32 ? random.nextU() & 0xff : 'x';
+        }
+        sk_sp<SkData> data = SkData::MakeWithoutCopy(buffer.get(), size);
+
+        for (Strategy strategy : {Strategy::kDefault, Strategy::kFiltered,
+                                  Strategy::kHuffmanOnly, Strategy::kRLE}) {
+            // A stream with a memory base is compressed in one call.
+            SkMemoryStream memoryStream(data);
+            REPORTER_ASSERT(r, inflates_to(r, SkDeflateWStream::Compress(&memoryStream, -1,
+                                                                         strategy),
+                                           buffer.get(), size),
+                            "size %zu strategy %d", size, (int)strategy);
+            REPORTER_ASSERT(r, memoryStream.isAtEnd());
+
+            // Otherwise it is read in pieces. Written a bit at a time, a large
+            // SkDynamicMemoryWStream spans several blocks and has no memory base.
+            SkDynamicMemoryWStream blocks;
+            for (size_t j = 0; j < size; j += 1000) {
+                blocks.write(buffer.get() + j, std::min<size_t>(size - j, 1000));
+            }
+            std::unique_ptr<SkStreamAsset> blockStream = blocks.detachAsStream();
+            REPORTER_ASSERT(r, !blockStream->getMemoryBase() || size <= 4096);
+            REPORTER_ASSERT(r, inflates_to(r, SkDeflateWStream::Compress(blockStream.get(), 9,
+                                                                         strategy),
+                                           buffer.get(), size),
+                            "size %zu strategy %d", size, (int)strategy);
+
+            // Only the rest of the stream is compressed.
+            if (size > 1) {
+                SkMemoryStream partStream(data);
+                (void)partStream.skip(size / 2);
+                REPORTER_ASSERT(r, inflates_to(r, SkDeflateWStream::Compress(&partStream, 1,
+                                                                             strategy),
+                                               buffer.get() + size / 2, size - size / 2));
+            }
+
+            // Writes larger than SkDeflateWStream's own buffer are deflated directly.
+            SkDynamicMemoryWStream compressed;
+            {
+                SkDeflateWStream deflateWStream(&compressed, -1, false, strategy);
+                deflateWStream.write(buffer.get(), std::min<size_t>(size, 10));
+                deflateWStream.write(buffer.get() + std::min<size_t>(size, 10),
+                                     size - std::min<size_t>(size, 10));
+                REPORTER_ASSERT(r, deflateWStream.bytesWritten() == size);
+            }
+            REPORTER_ASSERT(r, inflates_to(r, compressed.detachAsData(), buffer.get(), size));
+        }
+    }
+}
+
 #endif
@@ -4,16 +4,20 @@
  * Use of this source code is governed by a BSD-style license that can be
  * found in the LICENSE file.
  */
+#include "include/core/SkAnnotation.h"
 #include "include/core/SkBitmap.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColor.h"
+#include "include/core/SkColorPriv.h"
 #include "include/core/SkData.h"
 #include "include/core/SkDocument.h"
 #include "include/core/SkExecutor.h"
 #include "include/core/SkFont.h"
 #include "include/core/SkImage.h" // IWYU pragma: keep
 #include "include/core/SkPaint.h"
+#include "include/core/SkRect.h"
 #include "include/core/SkRefCnt.h"
+#include "include/core/SkSamplingOptions.h"
 #include "include/core/SkStream.h"
 #include "include/core/SkString.h"
 #include "include/docs/SkPDFDocument.h"
@@ -267,3 +271,156 @@ DEF_TEST(SkPDF_abort_jobs, rep) {
     doc->abort();
 }
 
+
+static int count(const sk_sp<SkData>& data, const char* needle) {
+    const size_t len = strlen(needle);
+    int n = 0;
+    for (size_t i = 0; i + len <= data->size(); ++i) {
+        n += memcmp(data->bytes() + i, needle, len) == 0;
+    }
+    return n;
+}
+
+// Draws |pageCount| pages, each with a logo shared by every page, an image of its own, and a
+// link whose text is in one of three typefaces taken in turn.
+static sk_sp<SkData> make_report(int pageCount, const SkPDF::Metadata& metadata) {
+    SkBitmap logo;
+    logo.allocN32Pixels(16, 16);
+    logo.eraseColor(SK_ColorBLUE);
+    sk_sp<SkImage> logoImage = logo.asImage();
+    sk_sp<SkTypeface> typefaces[] = {
+            ToolUtils::CreatePortableTypeface("serif", SkFontStyle()),
+            ToolUtils::CreatePortableTypeface("sans-serif", SkFontStyle()),
+            ToolUtils::CreatePortableTypeface("monospace", SkFontStyle()),
+    };
+
+    SkDynamicMemoryWStream stream;
+    auto doc = SkPDF::MakeDocument(&stream, metadata);
+    for (int i = 0; i < pageCount; ++i) {
+        SkCanvas* canvas = doc->beginPage(612, 792);
+        canvas->drawImage(logoImage, 10, 10);
+        SkBitmap photo;
+        photo.allocN32Pixels(8, 8);
+        photo.eraseColor(SkColorSetARGB(0xFF, 0x00, (uint8_t)i, 0x00));
+        canvas->drawImage(photo.asImage(), 100, 10);
+        SkFont font(typefaces[i % 3], 12);
+        canvas->drawString("Quarterly report", 10, 100, font, SkPaint());
+        sk_sp<SkData> url = SkData::MakeWithCString("https://skia.org/");
+        SkAnnotateRectWithURL(canvas, SkRect::MakeXYWH(10, 90, 100, 12), url.get());
+        doc->endPage();
+    }
+    doc->close();
+    return stream.detachAsData();
+}
+
+DEF_TEST(SkPDF_streaming, r) {
+    REQUIRE_PDF_DOCUMENT(SkPDF_streaming, r);
+    constexpr int kPageCount = 41;  // Not a multiple of the page tree's node size.
+    SkPDF::Metadata metadata;
+    const sk_sp<SkData> buffered = make_report(kPageCount, metadata);
+    metadata.fStreaming = true;
+    metadata.fStreamingResourceLimit = 2;
+    const sk_sp<SkData> streamed = make_report(kPageCount, metadata);
+
+    REPORTER_ASSERT(r, contains(streamed->bytes(), streamed->size(), "/Count 41"));
+    REPORTER_ASSERT(r, count(streamed, "/Type /Page\n") == kPageCount);
+    // 6 nodes of up to 8 pages each, and the root above them.
+    REPORTER_ASSERT(r, count(streamed, "/Type /Pages\n") == 7);
+
+    // The logo is drawn on every page, so it is never forgotten.
+    REPORTER_ASSERT(r, count(streamed, "/Subtype /Image") == count(buffered, "/Subtype /Image"));
+
+    // Only two of the three typefaces are remembered, so each page (but one) finds its typeface
+    // forgotten, and writes a new subset of it.
+    const int bufferedFonts = count(buffered, "/Type /Font");
+    const int streamedFonts = count(streamed, "/Type /Font");
+    REPORTER_ASSERT(r, bufferedFonts > 0 && streamedFonts > bufferedFonts,
+                    "buffered %d, streamed %d", bufferedFonts, streamedFonts);
+}
+
+DEF_TEST(SkPDF_record_pages, r) {
+    REQUIRE_PDF_DOCUMENT(SkPDF_record_pages, r);
+    constexpr int kPageCount = 20;
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(2);
+    SkPDF::Metadata metadata;
+    metadata.fExecutor = executor.get();
+    const sk_sp<SkData> direct = make_report(kPageCount, metadata);
+    metadata.fRecordPages = true;
+    const sk_sp<SkData> recorded = make_report(kPageCount, metadata);
+
+    // Parallel compression makes the bytes differ from run to run, but not the objects.
+    for (const char* needle : {"/Type /Page\n", "/Subtype /Image", "/Type /Font", "/S /URI"}) {
+        REPORTER_ASSERT(r, count(recorded, needle) == count(direct, needle), "%s", needle);
+    }
+    REPORTER_ASSERT(r, count(recorded, "/Type /Page\n") == kPageCount);
+    REPORTER_ASSERT(r, count(recorded, "/S /URI") == kPageCount);
+}
+
+static sk_sp<SkData> make_letter(const SkPDF::Metadata& metadata,
+                                 const sk_sp<SkImage>& logo,
+                                 const sk_sp<SkImage>& photo,
+                                 const sk_sp<SkTypeface>& typeface) {
+    SkDynamicMemoryWStream stream;
+    auto doc = SkPDF::MakeDocument(&stream, metadata);
+    SkCanvas* canvas = doc->beginPage(612, 792);
+    canvas->drawImage(logo, 10, 10);
+    canvas->drawImage(photo, 100, 10);
+    canvas->drawImageRect(photo, SkRect::MakeXYWH(4, 4, 8, 8), SkRect::MakeXYWH(100, 100, 8, 8),
+                          SkSamplingOptions(), nullptr, SkCanvas::kStrict_SrcRectConstraint);
+    canvas->drawString("Dear customer,", 10, 200, SkFont(typeface, 12), SkPaint());
+    doc->close();
+    return stream.detachAsData();
+}
+
+DEF_TEST(SkPDF_resource_cache, r) {
+    REQUIRE_PDF_DOCUMENT(SkPDF_resource_cache, r);
+    SkBitmap logo;
+    logo.allocN32Pixels(16, 16);
+    logo.eraseColor(SK_ColorTRANSPARENT);
+    logo.erase(SK_ColorBLUE, SkIRect::MakeXYWH(4, 4, 8, 8));
+    SkBitmap photo;
+    photo.allocN32Pixels(16, 16, true);
+    for (int y = 0; y < 16; ++y) {
+        for (int x = 0; x < 16; ++x) {
+            *photo.getAddr32(x, y) = SkPackARGB32(0xFF, x * 16, y * 16, 0x80);
+        }
+    }
+    // The same images and typeface go into each document.
+    const sk_sp<SkImage> logoImage = logo.asImage();
+    const sk_sp<SkImage> photoImage = photo.asImage();
+    const sk_sp<SkTypeface> typeface = ToolUtils::CreatePortableTypeface("serif", SkFontStyle());
+
+    SkPDF::Metadata metadata;
+    const sk_sp<SkData> uncached = make_letter(metadata, logoImage, photoImage, typeface);
+
+    sk_sp<SkPDF::ResourceCache> cache = SkPDF::ResourceCache::Make(1 << 20);
+    metadata.fResourceCache = cache;
+    const sk_sp<SkData> first = make_letter(metadata, logoImage, photoImage, typeface);
+    const size_t bytesUsed = cache->bytesUsed();
+    REPORTER_ASSERT(r, bytesUsed > 0);
+    const sk_sp<SkData> second = make_letter(metadata, logoImage, photoImage, typeface);
+    // Everything the second document needed was found, and it is written the same.
+    REPORTER_ASSERT(r, cache->bytesUsed() == bytesUsed);
+    REPORTER_ASSERT(r, first->equals(uncached.get()));
+    REPORTER_ASSERT(r, second->equals(uncached.get()));
+
+    // The photo encoded as JPEG is a different entry.
+    metadata.fEncodingQuality = 50;
+    const sk_sp<SkData> jpeg = make_letter(metadata, logoImage, photoImage, typeface);
+    REPORTER_ASSERT(r, cache->bytesUsed() > bytesUsed);
+    metadata.fResourceCache = nullptr;
+    REPORTER_ASSERT(r, jpeg->equals(make_letter(metadata, logoImage, photoImage, typeface).get()));
+
+    cache->purgeAll();
+    REPORTER_ASSERT(r, cache->bytesUsed() == 0);
+
+    // A cache that is too small for everything still produces the same document.
+    sk_sp<SkPDF::ResourceCache> smallCache = SkPDF::ResourceCache::Make(300);
+    metadata.fEncodingQuality = 101;
+    metadata.fResourceCache = smallCache;
+    for (int i = 0; i < 2; ++i) {
+        const sk_sp<SkData> small = make_letter(metadata, logoImage, photoImage, typeface);
+        REPORTER_ASSERT(r, small->equals(uncached.get()));
+        REPORTER_ASSERT(r, smallCache->bytesUsed() <= 300);
+    }
+}
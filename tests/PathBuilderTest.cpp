@@ -5,16 +5,27 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkMatrix.h"
+#include "include/core/SkPaint.h"
 #include "include/core/SkPath.h"
 #include "include/core/SkPathBuilder.h"
 #include "include/core/SkPathTypes.h"
+#include "include/core/SkPicture.h"
+#include "include/core/SkPictureRecorder.h"
 #include "include/core/SkPoint.h"
 #include "include/core/SkRRect.h"
 #include "include/core/SkRect.h"
 #include "include/core/SkScalar.h"
+#include "include/core/SkSurface.h"
+#include "src/base/SkArenaAlloc.h"
 #include "src/base/SkRandom.h"
 #include "src/core/SkPathPriv.h"
 #include "tests/Test.h"
+#include "tools/ToolUtils.h"
 
 #include <cstddef>
 #include <cstdint>
@@ -22,6 +33,19 @@
 #include <string>
 #include <vector>
 
+#if defined(SK_GANESH)
+#include "include/gpu/GpuTypes.h"
+#include "include/gpu/GrDirectContext.h"
+#include "include/gpu/ganesh/SkSurfaceGanesh.h"
+#endif
+
+#if defined(SK_GRAPHITE)
+#include "include/gpu/graphite/Context.h"
+#include "include/gpu/graphite/Recorder.h"
+#include "include/gpu/graphite/Recording.h"
+#include "include/gpu/graphite/Surface.h"
+#endif
+
 enum class SkPathConvexity;
 
 static void is_empty(skiatest::Reporter* reporter, const SkPath& p) {
@@ -262,6 +286,142 @@ DEF_TEST(pathbuilder_make, reporter) {
     REPORTER_ASSERT(reporter, p0 == p1);
 }
 
+DEF_TEST(pathbuilder_arena, r) {
+    SkSTArenaAlloc<1024> arena;
+    SkPathBuilder heapBuilder, arenaBuilder(&arena);
+
+    for (SkPathBuilder* b : {&heapBuilder, &arenaBuilder}) {
+        b->moveTo(0, 0).lineTo(10, 0).quadTo(20, 0, 20, 10).conicTo(20, 20, 10, 20, 0.5f)
+          .cubicTo(5, 20, 0, 15, 0, 10).close();
+        b->setFillType(SkPathFillType::kEvenOdd);
+    }
+    SkPath expected = heapBuilder.detach();
+
+    SkPath snap = arenaBuilder.snapshot();
+    SkPath path = arenaBuilder.detach();
+    REPORTER_ASSERT(r, snap == expected);
+    REPORTER_ASSERT(r, path == expected);
+    REPORTER_ASSERT(r, path.getBounds() == expected.getBounds());
+    REPORTER_ASSERT(r, snap.getGenerationID() != path.getGenerationID());
+
+    // The builder keeps its arena after detach().
+    SkPath oval = arenaBuilder.addOval({0, 0, 10, 10}).detach();
+    REPORTER_ASSERT(r, oval.isOval(nullptr));
+
+    // Editing an arena path copies it, leaving the other users alone.
+    SkPath copy = path;
+    copy.lineTo(30, 30);
+    REPORTER_ASSERT(r, path == expected);
+    REPORTER_ASSERT(r, copy.countPoints() == expected.countPoints() + 1);
+    copy.reset();
+    REPORTER_ASSERT(r, path == expected);
+}
+
+// Copies of an arena path are made on the heap, and so outlive the arena.
+DEF_TEST(pathbuilder_arena_copies, r) {
+    const SkPath expected = SkPathBuilder().moveTo(0, 0).lineTo(10, 0).conicTo(10, 10, 0, 10, 0.5f)
+                                           .close().detach();
+    SkPath assigned, transformed;
+    std::vector<SkPath> copies;
+    {
+        SkSTArenaAlloc<256> arena;
+        SkPath path = SkPathBuilder(&arena).moveTo(0, 0).lineTo(10, 0)
+                                           .conicTo(10, 10, 0, 10, 0.5f).close().detach();
+        REPORTER_ASSERT(r, path == expected);
+        assigned = path;
+        copies.push_back(path);
+        path.transform(SkMatrix::I(), &transformed);
+    }
+    REPORTER_ASSERT(r, assigned == expected);
+    REPORTER_ASSERT(r, copies[0] == expected);
+    REPORTER_ASSERT(r, transformed == expected);
+}
+
+// Draws a few filled and stroked paths. If 'useArena' is true they are built in an arena which is
+// gone by the time this returns, before anything the canvas recorded from them is used.
+static void draw_paths(SkCanvas* canvas, bool useArena) {
+    SkSTArenaAlloc<256> arena;
+    SkPathBuilder builder = useArena ? SkPathBuilder(&arena) : SkPathBuilder();
+
+    canvas->clear(SK_ColorWHITE);
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    paint.setStrokeWidth(3);
+    for (int i = 0; i < 8; ++i) {
+        const float x = 4 + 30 * (i % 4), y = 4 + 30 * (i / 4);
+        builder.moveTo(x, y + 12)
+               .conicTo(x, y, x + 12, y, 0.7f)
+               .quadTo(x + 24, y, x + 24, y + 12)
+               .cubicTo(x + 24, y + 20, x + 10, y + 26, x + 4, y + 24)
+               .close();
+        paint.setColor(SkColorSetRGB(30 * i, 255 - 30 * i, 128));
+        paint.setStyle(i % 2 ? SkPaint::kStroke_Style : SkPaint::kFill_Style);
+        canvas->drawPath(builder.detach(), paint);
+    }
+}
+
+static const SkImageInfo kArenaDrawInfo = SkImageInfo::MakeN32Premul(128, 64);
+
+DEF_TEST(pathbuilder_arena_picture, r) {
+    SkPictureRecorder recorder;
+    draw_paths(recorder.beginRecording(SkRect::Make(kArenaDrawInfo.bounds())), true);
+    sk_sp<SkPicture> picture = recorder.finishRecordingAsPicture();
+
+    SkBitmap expected, actual;
+    expected.allocPixels(kArenaDrawInfo);
+    actual.allocPixels(kArenaDrawInfo);
+    SkCanvas expectedCanvas(expected), actualCanvas(actual);
+    draw_paths(&expectedCanvas, false);
+    picture->playback(&actualCanvas);
+    REPORTER_ASSERT(r, ToolUtils::equal_pixels(expected, actual));
+}
+
+#if defined(SK_GANESH)
+DEF_GANESH_TEST_FOR_RENDERING_CONTEXTS(PathBuilderArenaGanesh,
+                                       r,
+                                       ctxInfo,
+                                       CtsEnforcement::kNever) {
+    GrDirectContext* dContext = ctxInfo.directContext();
+    SkBitmap results[2];
+    for (bool useArena : {false, true}) {
+        sk_sp<SkSurface> surface =
+                SkSurfaces::RenderTarget(dContext, skgpu::Budgeted::kNo, kArenaDrawInfo);
+        REPORTER_ASSERT(r, surface);
+        if (!surface) {
+            return;
+        }
+        // The ops that keep the paths only execute when the pixels are read.
+        draw_paths(surface->getCanvas(), useArena);
+        results[useArena].allocPixels(kArenaDrawInfo);
+        REPORTER_ASSERT(r, surface->readPixels(results[useArena], 0, 0));
+    }
+    REPORTER_ASSERT(r, ToolUtils::equal_pixels(results[0], results[1]));
+}
+#endif
+
+#if defined(SK_GRAPHITE)
+DEF_GRAPHITE_TEST_FOR_RENDERING_CONTEXTS(PathBuilderArenaGraphite, r, context,
+                                         CtsEnforcement::kNever) {
+    using namespace skgpu::graphite;
+    std::unique_ptr<Recorder> recorder = context->makeRecorder();
+    SkBitmap results[2];
+    for (bool useArena : {false, true}) {
+        sk_sp<SkSurface> surface = SkSurfaces::RenderTarget(recorder.get(), kArenaDrawInfo);
+        REPORTER_ASSERT(r, surface);
+        if (!surface) {
+            return;
+        }
+        // The draw lists that keep the paths are only turned into commands by snap().
+        draw_paths(surface->getCanvas(), useArena);
+        std::unique_ptr<Recording> recording = recorder->snap();
+        context->insertRecording({recording.get()});
+        results[useArena].allocPixels(kArenaDrawInfo);
+        REPORTER_ASSERT(r, surface->readPixels(results[useArena], 0, 0));
+    }
+    REPORTER_ASSERT(r, ToolUtils::equal_pixels(results[0], results[1]));
+}
+#endif
+
 DEF_TEST(pathbuilder_genid, r) {
     SkPathBuilder builder;
 
@@ -19,7 +19,9 @@
 #include <array>
 #include <cstddef>
 #include <initializer_list>
+#include <limits>
 #include <utility>
+#include <vector>
 
 static void test_small_segment3(skiatest::Reporter* reporter) {
     SkPath path;
@@ -356,3 +358,70 @@ DEF_TEST(contour_measure, reporter) {
 
     test_shrink(reporter);
 }
+
+DEF_TEST(contour_measure_getPosTans, reporter) {
+    // Enough curves to use the segment index.
+    SkPath path;
+    path.moveTo(0, 0);
+    for (int i = 0; i < 50; ++i) {
+        path.cubicTo(i * 10 + 3, 30, i * 10 + 7, -30, i * 10 + 10, 0);
+    }
+    auto cm = SkContourMeasureIter(path, false).next();
+    REPORTER_ASSERT(reporter, cm);
+
+    // In order, out of order, and out of range.
+    std::vector<SkScalar> distances;
+    for (int i = 0; i <= 200; ++i) {
+        distances.push_back(cm->length() * i / 200);
+    }
+    for (int i = 0; i <= 200; ++i) {
+        distances.push_back(cm->length() * ((i * 37) % 201) / 200);
+    }
+    distances.push_back(-10);
+    distances.push_back(cm->length() + 10);
+
+    std::vector<SkPoint> positions(distances.size());
+    std::vector<SkVector> tangents(distances.size());
+    REPORTER_ASSERT(reporter, cm->getPosTans(distances, positions, tangents));
+    for (size_t i = 0; i < distances.size(); ++i) {
+        SkPoint position;
+        SkVector tangent;
+        REPORTER_ASSERT(reporter, cm->getPosTan(distances[i], &position, &tangent));
+        REPORTER_ASSERT(reporter, positions[i] == position, "distance %g", distances[i]);
+        REPORTER_ASSERT(reporter, tangents[i] == tangent, "distance %g", distances[i]);
+    }
+
+    // Only positions, and a NaN distance that fails on its own.
+    const SkScalar nanDistances[] = {1, std::numeric_limits<SkScalar>::quiet_NaN(), 2};
+    SkPoint nanPositions[3] = {};
+    REPORTER_ASSERT(reporter, !cm->getPosTans(nanDistances, nanPositions, {}));
+    REPORTER_ASSERT(reporter, nanPositions[1] == SkPoint::Make(0, 0));
+    SkPoint position;
+    REPORTER_ASSERT(reporter, cm->getPosTan(2, &position, nullptr));
+    REPORTER_ASSERT(reporter, nanPositions[2] == position);
+}
+
+DEF_TEST(contour_measure_cache, reporter) {
+    SkPath path;
+    path.addCircle(0, 0, 100);
+    path.addRoundRect({0, 0, 50, 50}, 10, 10);
+
+    // Measuring the same path twice shares the contours, once the first iterator finished.
+    SkContourMeasureIter iter0(path, false);
+    auto cm0 = iter0.next();
+    auto cm1 = iter0.next();
+    REPORTER_ASSERT(reporter, cm0 && cm1 && !iter0.next());
+
+    SkContourMeasureIter iter1(path, false);
+    REPORTER_ASSERT(reporter, iter1.next() == cm0);
+    REPORTER_ASSERT(reporter, iter1.next() == cm1);
+    REPORTER_ASSERT(reporter, !iter1.next());
+
+    // Measuring differently doesn't.
+    REPORTER_ASSERT(reporter, SkContourMeasureIter(path, false, 2).next() != cm0);
+
+    // Nor does changing the path.
+    path.addCircle(0, 0, 10);
+    SkContourMeasureIter iter2(path, false);
+    REPORTER_ASSERT(reporter, iter2.next() != cm0);
+}
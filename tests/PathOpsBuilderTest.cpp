@@ -5,6 +5,7 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkExecutor.h"
 #include "include/core/SkPath.h"
 #include "include/core/SkPathTypes.h"
 #include "include/core/SkRect.h"
@@ -13,6 +14,8 @@
 #include "tests/PathOpsExtendedTest.h"
 #include "tests/Test.h"
 
+#include <memory>
+
 DEF_TEST(PathOpsBuilder, reporter) {
     SkOpBuilder builder;
     SkPath result;
@@ -364,3 +367,44 @@ SkOpBuilder builder;
     builder.add(path1, SkPathOp::kUnion_SkPathOp);
     builder.resolve(&path);
 }
+
+DEF_TEST(SkOpBuilderTreeReduction, reporter) {
+    // L-shaped paths aren't convex, so resolve() can't just simplify their sum.
+    auto makeL = [](float x, float y) {
+        SkPath path;
+        path.moveTo(x, y);
+        path.lineTo(x + 10, y);
+        path.lineTo(x + 10, y + 4);
+        path.lineTo(x + 4, y + 4);
+        path.lineTo(x + 4, y + 10);
+        path.lineTo(x, y + 10);
+        path.close();
+        return path;
+    };
+
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    for (SkExecutor* exec : {static_cast<SkExecutor*>(nullptr), executor.get()}) {
+        // Overlapping and disjoint unions, then differences, then an xor, compared against
+        // applying each op in turn.
+        SkOpBuilder builder(exec);
+        SkPath expected;
+        for (int i = 0; i < 20; ++i) {
+            const SkPathOp op = i < 14 ? kUnion_SkPathOp
+                              : i < 19 ? kDifference_SkPathOp
+                                       : kXOR_SkPathOp;
+            SkPath path = makeL(i * 7 % 60, i * 13 % 50);
+            builder.add(path, op);
+            REPORTER_ASSERT(reporter, Op(expected, path, op, &expected));
+        }
+        SkPath result;
+        REPORTER_ASSERT(reporter, builder.resolve(&result));
+        REPORTER_ASSERT(reporter, comparePaths(reporter, __FUNCTION__, expected, result) == 0);
+
+        // Intersecting disjoint paths is empty.
+        builder.add(makeL(0, 0), kUnion_SkPathOp);
+        builder.add(makeL(20, 20), kIntersect_SkPathOp);
+        builder.add(makeL(40, 40), kIntersect_SkPathOp);
+        REPORTER_ASSERT(reporter, builder.resolve(&result));
+        REPORTER_ASSERT(reporter, result.isEmpty());
+    }
+}
@@ -20,23 +20,30 @@
 #include "include/gpu/GrRecordingContext.h"
 #include "include/gpu/GrTypes.h"
 #include "include/private/gpu/ganesh/GrTypesPriv.h"
+#include "src/core/SkCachedData.h"
 #include "src/core/SkPathPriv.h"
+#include "src/core/SkResourceCache.h"
 #include "src/gpu/SkBackingFit.h"
 #include "src/gpu/ganesh/GrDirectContextPriv.h"
 #include "src/gpu/ganesh/GrPaint.h"
 #include "src/gpu/ganesh/GrRecordingContextPriv.h"
 #include "src/gpu/ganesh/GrResourceCache.h"
 #include "src/gpu/ganesh/GrStyle.h"
+#include "src/gpu/ganesh/GrThreadSafeCache.h"
 #include "src/gpu/ganesh/GrUserStencilSettings.h"
 #include "src/gpu/ganesh/PathRenderer.h"
 #include "src/gpu/ganesh/SurfaceDrawContext.h"
 #include "src/gpu/ganesh/effects/GrPorterDuffXferProcessor.h"
 #include "src/gpu/ganesh/geometry/GrStyledShape.h"
+#include "src/gpu/ganesh/ops/SmallPathMaskCache.h"
+#include "src/gpu/ganesh/ops/SmallPathShapeData.h"
 #include "src/gpu/ganesh/ops/SoftwarePathRenderer.h"
 #include "src/gpu/ganesh/ops/TriangulatingPathRenderer.h"
 #include "tests/CtsEnforcement.h"
 #include "tests/Test.h"
 
+#include <cstdint>
+#include <cstring>
 #include <functional>
 #include <memory>
 #include <utility>
@@ -163,6 +170,59 @@ static void test_path(
 }
 
 #if !defined(SK_ENABLE_OPTIMIZE_SIZE)
+// Test that an AA path drawn with a different matrix in every frame keeps one entry in the cache,
+// and that its mesh is cached once the matrix stops changing.
+static void test_animated_aa_path(skiatest::Reporter* reporter) {
+    sk_sp<GrDirectContext> dContext = GrDirectContext::MakeMock(nullptr);
+    dContext->setResourceCacheLimit(8000000);
+    GrResourceCache* cache = dContext->priv().getResourceCache();
+    GrThreadSafeCache* threadSafeCache = dContext->priv().threadSafeCache();
+
+    auto sdc = skgpu::ganesh::SurfaceDrawContext::Make(dContext.get(),
+                                                       GrColorType::kRGBA_8888,
+                                                       nullptr,
+                                                       SkBackingFit::kApprox,
+                                                       {800, 800},
+                                                       SkSurfaceProps(),
+                                                       /*label=*/{},
+                                                       /* sampleCnt= */ 1,
+                                                       skgpu::Mipmapped::kNo,
+                                                       GrProtected::kNo,
+                                                       kTopLeft_GrSurfaceOrigin);
+    if (!sdc) {
+        return;
+    }
+
+    sk_sp<skgpu::ganesh::PathRenderer> pathRenderer(new skgpu::ganesh::TriangulatingPathRenderer);
+    SkPath path = create_concave_path();
+    const GrStyle style(SkStrokeRec::kFill_InitStyle);
+    auto drawFrame = [&](float scaleX) {
+        draw_path(dContext.get(), sdc.get(), path, pathRenderer.get(), GrAAType::kCoverage, style,
+                  scaleX);
+        dContext->flushAndSubmit();
+    };
+
+    drawFrame(1.f);
+    REPORTER_ASSERT(reporter, threadSafeCache->numEntries() == 1);
+    REPORTER_ASSERT(reporter, cache_non_scratch_resources_equals(cache, 1));
+
+    // The meshes of the animation aren't cached, and neither they nor their listeners pile up.
+    for (int i = 1; i <= 10; ++i) {
+        drawFrame(1 + i / 10.f);
+        REPORTER_ASSERT(reporter, threadSafeCache->numEntries() == 1);
+        REPORTER_ASSERT(reporter, cache_non_scratch_resources_equals(cache, 0));
+    }
+    REPORTER_ASSERT(reporter, SkPathPriv::GenIDChangeListenersCount(path) == 1);
+
+    // The second frame with the same matrix caches the mesh, which the third one reuses.
+    drawFrame(2.f);
+    REPORTER_ASSERT(reporter, cache_non_scratch_resources_equals(cache, 1));
+    drawFrame(2.f);
+    REPORTER_ASSERT(reporter, threadSafeCache->numEntries() == 1);
+    REPORTER_ASSERT(reporter, cache_non_scratch_resources_equals(cache, 1));
+    REPORTER_ASSERT(reporter, SkPathPriv::GenIDChangeListenersCount(path) == 1);
+}
+
 // Test that deleting the original path invalidates the VBs cached by the tessellating path renderer
 DEF_GANESH_TEST(TriangulatingPathRendererCacheTest,
                 reporter,
@@ -186,6 +246,49 @@ DEF_GANESH_TEST(TriangulatingPathRendererCacheTest,
     GrStyle style(paint);
     test_path(reporter, create_concave_path, createPR, kExpectedResources, false, GrAAType::kNone,
               std::move(style));
+
+    // The device space meshes made for analytic AA are cached the same way.
+    test_path(reporter, create_concave_path, createPR, kExpectedResources, false,
+              GrAAType::kCoverage);
+
+    test_animated_aa_path(reporter);
+}
+
+// Test that small path masks shared between contexts are found only by the key they were made for
+DEF_TEST(SmallPathMaskCacheTest, reporter) {
+    GrStyledShape shape(create_concave_path(), GrStyle::SimpleFill());
+    skgpu::ganesh::SmallPathShapeDataKey dfKey(shape, 64);
+    skgpu::ganesh::SmallPathShapeDataKey otherDFKey(shape, 128);
+    skgpu::ganesh::SmallPathShapeDataKey bmKey(shape, SkMatrix::Scale(0.25f, 0.25f));
+
+    using skgpu::ganesh::SmallPathMaskCache;
+    SkResourceCache cache(1024 * 1024);
+    SmallPathMaskCache::Mask mask;
+    REPORTER_ASSERT(reporter, !SmallPathMaskCache::FindAndRef(dfKey, true, &mask, &cache));
+
+    static constexpr int kSize = 16;
+    sk_sp<SkCachedData> data(SmallPathMaskCache::NewData(dfKey, kSize, kSize, &cache));
+    if (!data) {
+        ERRORF(reporter, "Could not allocate mask");
+        return;
+    }
+    memset(data->writable_data(), 0x80, kSize * kSize);
+    const SkRect drawBounds = SkRect::MakeLTRB(-1, -2, 30, 40);
+    SmallPathMaskCache::Add(dfKey, true, {kSize, kSize, drawBounds}, data.get(), &cache);
+    data.reset();
+
+    sk_sp<SkCachedData> found(SmallPathMaskCache::FindAndRef(dfKey, true, &mask, &cache));
+    REPORTER_ASSERT(reporter, found);
+    if (found) {
+        REPORTER_ASSERT(reporter, mask.fWidth == kSize && mask.fHeight == kSize);
+        REPORTER_ASSERT(reporter, mask.fDrawBounds == drawBounds);
+        REPORTER_ASSERT(reporter, static_cast<const uint8_t*>(found->data())[kSize] == 0x80);
+    }
+
+    // Neither a distance field of another size nor a coverage mask match it.
+    REPORTER_ASSERT(reporter, !SmallPathMaskCache::FindAndRef(otherDFKey, true, &mask, &cache));
+    REPORTER_ASSERT(reporter, !SmallPathMaskCache::FindAndRef(dfKey, false, &mask, &cache));
+    REPORTER_ASSERT(reporter, !SmallPathMaskCache::FindAndRef(bmKey, false, &mask, &cache));
 }
 #endif
 
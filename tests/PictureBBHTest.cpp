@@ -17,6 +17,8 @@
 #include "include/core/SkScalar.h"
 #include "tests/Test.h"
 
+#include <memory>
+
 class PictureBBHTestBase {
 public:
     PictureBBHTestBase(int playbackWidth, int playbackHeight,
@@ -102,13 +104,17 @@ DEF_TEST(PictureNegativeSpace, r) {
 
     SkRect cull = {-200,-200,+200,+200};
 
+    // Translucent, so the second rect doesn't hide (and get optimized away under) the first.
+    SkPaint paint;
+    paint.setAlphaf(0.5f);
+
     {
         sk_sp<SkBBoxHierarchy> bbh = factory();
         auto canvas = recorder.beginRecording(cull, bbh);
             canvas->save();
             canvas->clipRect(cull);
-            canvas->drawRect({-20,-20,-10,-10}, SkPaint{});
-            canvas->drawRect({-20,-20,-10,-10}, SkPaint{});
+            canvas->drawRect({-20,-20,-10,-10}, paint);
+            canvas->drawRect({-20,-20,-10,-10}, paint);
             canvas->restore();
         auto pic = recorder.finishRecordingAsPicture();
         REPORTER_ASSERT(r, pic->approximateOpCount() == 5);
@@ -118,10 +124,74 @@ DEF_TEST(PictureNegativeSpace, r) {
     {
         auto canvas = recorder.beginRecording(cull, &factory);
             canvas->clipRect(cull);
-            canvas->drawRect({-20,-20,-10,-10}, SkPaint{});
-            canvas->drawRect({-20,-20,-10,-10}, SkPaint{});
+            canvas->drawRect({-20,-20,-10,-10}, paint);
+            canvas->drawRect({-20,-20,-10,-10}, paint);
         auto pic = recorder.finishRecordingAsPicture();
         REPORTER_ASSERT(r, pic->approximateOpCount() == 3);
         REPORTER_ASSERT(r, pic->cullRect() == (SkRect{-20,-20,-10,-10}));
     }
 }
+
+DEF_TEST(Picture_PlaybackParallel, r) {
+    constexpr int kSize = 96, kTile = 32, kTiles = (kSize / kTile) * (kSize / kTile);
+
+    auto record = [](SkBBHFactory* factory) {
+        SkPictureRecorder recorder;
+        SkCanvas* canvas = recorder.beginRecording(kSize, kSize, factory);
+        SkPaint paint;
+        paint.setAntiAlias(true);
+        for (int i = 0; i < 20; i++) {
+            paint.setColor(SkColorSetARGB(0xFF, 12 * i, 255 - 12 * i, 7 * i));
+            canvas->drawCircle(5.f * i, 4.f * i, 9, paint);
+        }
+        canvas->save();
+        canvas->clipRect(SkRect::MakeLTRB(20, 20, 70, 70));
+        canvas->drawColor(SK_ColorBLUE);
+        canvas->restore();
+        return recorder.finishRecordingAsPicture();
+    };
+
+    SkRTreeFactory factory;
+    for (SkBBHFactory* f : {(SkBBHFactory*)nullptr, (SkBBHFactory*)&factory}) {
+        sk_sp<SkPicture> picture = record(f);
+
+        SkRect tiles[kTiles];
+        for (int i = 0; i < kTiles; i++) {
+            tiles[i] = SkRect::MakeXYWH((i % 3) * kTile, (i / 3) * kTile, kTile, kTile);
+        }
+
+        // Anti-aliased edges can round differently under a clip, so the reference is a serial
+        // playback clipped to one tile at a time.
+        SkBitmap expected;
+        expected.allocN32Pixels(kSize, kSize);
+        expected.eraseColor(SK_ColorWHITE);
+        SkCanvas serial(expected);
+        for (const SkRect& tile : tiles) {
+            serial.save();
+            serial.clipRect(tile);
+            picture->playback(&serial);
+            serial.restore();
+        }
+
+        // Each tile canvas draws into its own region of one bitmap.
+        SkBitmap actual;
+        actual.allocN32Pixels(kSize, kSize);
+        actual.eraseColor(SK_ColorWHITE);
+        std::unique_ptr<SkCanvas> tileCanvases[kTiles];
+        SkCanvas* canvases[kTiles];
+        for (int i = 0; i < kTiles; i++) {
+            tileCanvases[i] = std::make_unique<SkCanvas>(actual);
+            canvases[i] = tileCanvases[i].get();
+        }
+        picture->playbackParallel(canvases, tiles, kTiles);
+
+        for (int y = 0; y < kSize; y++) {
+            for (int x = 0; x < kSize; x++) {
+                if (expected.getColor(x, y) != actual.getColor(x, y)) {
+                    ERRORF(r, "Mismatch at (%d, %d) with%s BBH", x, y, f ? "" : "out");
+                    return;
+                }
+            }
+        }
+    }
+}
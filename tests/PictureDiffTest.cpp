@@ -0,0 +1,122 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkPicture.h"
+#include "include/core/SkPictureRecorder.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkRegion.h"
+#include "include/utils/SkPictureDiff.h"
+#include "tests/Test.h"
+
+#include <cstring>
+#include <functional>
+
+namespace {
+
+constexpr SkRect kCull = SkRect::MakeWH(200, 200);
+
+// A small UI frame: a background, a list of rows, and a "selected" highlight.
+sk_sp<SkPicture> record_frame(int selectedRow, SkColor rowColor, bool extraBadge,
+                              bool clipLastRow) {
+    SkPictureRecorder recorder;
+    SkCanvas* canvas = recorder.beginRecording(kCull);
+
+    SkPaint paint;
+    paint.setColor(SK_ColorWHITE);
+    canvas->drawRect(kCull, paint);
+
+    for (int row = 0; row < 5; ++row) {
+        canvas->save();
+        canvas->translate(10, 10 + row * 38);
+        if (clipLastRow && row == 4) {
+            canvas->clipRect(SkRect::MakeWH(90, 30));
+        }
+        paint.setColor(row == selectedRow ? SK_ColorBLUE : rowColor);
+        canvas->drawRect(SkRect::MakeWH(180, 30), paint);
+        paint.setColor(SK_ColorBLACK);
+        paint.setAntiAlias(true);
+        canvas->drawCircle(15, 15, 8, paint);
+        paint.setAntiAlias(false);
+        canvas->restore();
+    }
+
+    if (extraBadge) {
+        paint.setColor(SK_ColorRED);
+        canvas->drawOval(SkRect::MakeXYWH(150, 2, 12, 12), paint);
+    }
+    return recorder.finishRecordingAsPicture();
+}
+
+SkBitmap draw(const std::function<void(SkCanvas*)>& fn) {
+    SkBitmap bm;
+    bm.allocN32Pixels(200, 200);
+    SkCanvas canvas(bm);
+    canvas.clear(SK_ColorTRANSPARENT);
+    fn(&canvas);
+    return bm;
+}
+
+// Redrawing only the damage over the old frame must reproduce the new frame.
+void check_repaint(skiatest::Reporter* r, const SkPicture& before, const SkPicture& after,
+                   const SkRegion& damage) {
+    SkBitmap expected = draw([&](SkCanvas* c) { c->drawPicture(&after); });
+    SkBitmap actual = draw([&](SkCanvas* c) {
+        c->drawPicture(&before);
+        c->clipRegion(damage);
+        c->clear(SK_ColorTRANSPARENT);
+        c->drawPicture(&after);
+    });
+    REPORTER_ASSERT(r, 0 == memcmp(expected.getPixels(), actual.getPixels(),
+                                   expected.computeByteSize()));
+}
+
+}  // namespace
+
+DEF_TEST(PictureDiff_Unchanged, r) {
+    sk_sp<SkPicture> a = record_frame(1, SK_ColorLTGRAY, false, false),
+                     b = record_frame(1, SK_ColorLTGRAY, false, false);
+    REPORTER_ASSERT(r, SkPictureDiff::Damage(*a, *b).isEmpty());
+    REPORTER_ASSERT(r, SkPictureDiff::Damage(*a, *a).isEmpty());
+}
+
+DEF_TEST(PictureDiff_ChangedDraws, r) {
+    sk_sp<SkPicture> base = record_frame(1, SK_ColorLTGRAY, false, false);
+
+    // Moving the selection damages just the two rows involved.
+    sk_sp<SkPicture> moved = record_frame(3, SK_ColorLTGRAY, false, false);
+    SkRegion damage = SkPictureDiff::Damage(*base, *moved);
+    SkRegion expected(SkIRect::MakeXYWH(10, 48, 180, 30));
+    expected.op(SkIRect::MakeXYWH(10, 124, 180, 30), SkRegion::kUnion_Op);
+    REPORTER_ASSERT(r, damage == expected);
+    check_repaint(r, *base, *moved, damage);
+
+    // An inserted draw damages only its own bounds, in either direction.
+    sk_sp<SkPicture> badge = record_frame(1, SK_ColorLTGRAY, true, false);
+    damage = SkPictureDiff::Damage(*base, *badge);
+    REPORTER_ASSERT(r, damage == SkRegion(SkIRect::MakeXYWH(150, 2, 12, 12)));
+    check_repaint(r, *base, *badge, damage);
+    REPORTER_ASSERT(r, SkPictureDiff::Damage(*badge, *base) == damage);
+    check_repaint(r, *badge, *base, SkPictureDiff::Damage(*badge, *base));
+
+    // A new clip damages the draws under it.
+    sk_sp<SkPicture> clipped = record_frame(1, SK_ColorLTGRAY, false, true);
+    damage = SkPictureDiff::Damage(*base, *clipped);
+    REPORTER_ASSERT(r, damage.contains(SkIRect::MakeXYWH(100, 162, 90, 30)));
+    REPORTER_ASSERT(r, !damage.intersects(SkIRect::MakeXYWH(10, 10, 180, 140)));
+    check_repaint(r, *base, *clipped, damage);
+
+    // Changing every row damages everything but the background.
+    sk_sp<SkPicture> recolored = record_frame(1, SK_ColorGRAY, false, false);
+    damage = SkPictureDiff::Damage(*base, *recolored);
+    REPORTER_ASSERT(r, !damage.contains(SkIRect::MakeXYWH(0, 0, 200, 10)));
+    check_repaint(r, *base, *recolored, damage);
+}
@@ -0,0 +1,110 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkData.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkM44.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkPixmap.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkSurface.h"
+#include "include/utils/SkPictureStream.h"
+#include "tests/Test.h"
+
+#include <cstring>
+#include <vector>
+
+static void draw_scene(SkCanvas* canvas) {
+    SkPaint paint;
+    canvas->save();
+    canvas->translate(10, 5);
+    canvas->clipRect({0, 0, 60, 60});
+    paint.setColor(SK_ColorRED);
+    canvas->drawRect({-5, -5, 30, 30}, paint);
+
+    SkPaint layerPaint;
+    layerPaint.setAlphaf(0.5f);
+    canvas->saveLayer(nullptr, &layerPaint);
+    canvas->scale(2, 2);
+    paint.setColor(SK_ColorBLUE);
+    for (int i = 0; i < 5; ++i) {
+        canvas->drawRect(SkRect::MakeXYWH(3 * i, 2 * i, 8, 8), paint);
+    }
+    canvas->restore();
+
+    // Relative to the matrix the stream started with, not the one at this chunk.
+    canvas->setMatrix(SkM44::Translate(40, 40));
+    paint.setColor(SK_ColorGREEN);
+    canvas->drawOval({0, 0, 20, 12}, paint);
+    canvas->restore();
+
+    paint.setColor(SK_ColorBLACK);
+    canvas->drawRect({70, 70, 90, 90}, paint);
+    // Left open for the reader to restore.
+    canvas->save();
+    canvas->clipRect({0, 0, 50, 100});
+    canvas->drawRect({40, 0, 60, 10}, paint);
+}
+
+DEF_TEST(PictureStream_MatchesDirectDraw, r) {
+    const SkImageInfo info = SkImageInfo::MakeN32Premul(100, 100);
+    auto expected = SkSurfaces::Raster(info);
+    auto actual = SkSurfaces::Raster(info);
+    for (auto surface : {expected, actual}) {
+        surface->getCanvas()->clear(SK_ColorWHITE);
+        surface->getCanvas()->translate(3, 4);
+    }
+    draw_scene(expected->getCanvas());
+
+    // Each chunk is played as soon as it is written, while the scene is still being drawn.
+    SkPictureStreamReader reader;
+    int chunks = 0;
+    SkPictureStreamWriter writer(SkRect::MakeWH(100, 100), [&](sk_sp<SkData> chunk) {
+        REPORTER_ASSERT(r, reader.playChunk(chunk.get(), actual->getCanvas()));
+        chunks++;
+    }, nullptr, /*opsPerChunk=*/3);
+    draw_scene(writer.getCanvas());
+    writer.flush();
+    writer.getCanvas()->drawRect({0, 90, 10, 100}, SkPaint());
+    writer.finish();
+    expected->getCanvas()->drawRect({0, 90, 10, 100}, SkPaint());
+
+    reader.finish(actual->getCanvas());
+    REPORTER_ASSERT(r, chunks > 5);
+    REPORTER_ASSERT(r, actual->getCanvas()->getSaveCount() == 1);
+    REPORTER_ASSERT(r, actual->getCanvas()->getLocalToDevice() == SkM44::Translate(3, 4));
+
+    SkPixmap e, a;
+    SkAssertResult(expected->peekPixels(&e));
+    SkAssertResult(actual->peekPixels(&a));
+    for (int y = 0; y < info.height(); ++y) {
+        REPORTER_ASSERT(r, 0 == memcmp(e.addr(0, y), a.addr(0, y), e.info().minRowBytes()),
+                        "row %d", y);
+    }
+}
+
+DEF_TEST(PictureStream_InvalidChunk, r) {
+    auto surface = SkSurfaces::Raster(SkImageInfo::MakeN32Premul(10, 10));
+    std::vector<sk_sp<SkData>> chunks;
+    SkPictureStreamWriter writer(SkRect::MakeWH(10, 10),
+                                 [&](sk_sp<SkData> chunk) { chunks.push_back(chunk); });
+    writer.getCanvas()->save();
+    writer.getCanvas()->drawPaint(SkPaint());
+    writer.finish();
+    REPORTER_ASSERT(r, chunks.size() == 1);
+
+    SkPictureStreamReader reader;
+    const char garbage[] = "not a chunk";
+    REPORTER_ASSERT(r, !reader.playChunk(garbage, sizeof(garbage), surface->getCanvas()));
+    // Nothing is played after an invalid chunk.
+    REPORTER_ASSERT(r, !reader.playChunk(chunks[0].get(), surface->getCanvas()));
+    reader.finish(surface->getCanvas());
+    REPORTER_ASSERT(r, surface->getCanvas()->getSaveCount() == 1);
+}
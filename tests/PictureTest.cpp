@@ -7,13 +7,16 @@
 
 #include "include/core/SkBBHFactory.h"
 #include "include/core/SkBitmap.h"
+#include "include/core/SkBlendMode.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkClipOp.h"
 #include "include/core/SkColor.h"
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkFont.h"
 #include "include/core/SkFontStyle.h"
 #include "include/core/SkImage.h" // IWYU pragma: keep
+#include "include/core/SkImageFilter.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkMatrix.h"
 #include "include/core/SkPaint.h"
@@ -22,21 +25,34 @@
 #include "include/core/SkPicture.h"
 #include "include/core/SkPictureRecorder.h"
 #include "include/core/SkPixelRef.h"
+#include "include/core/SkPixmap.h"
 #include "include/core/SkRect.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkSamplingOptions.h"
 #include "include/core/SkScalar.h"
+#include "include/core/SkSerialProcs.h"
 #include "include/core/SkStream.h"
+#include "include/core/SkSurface.h"
 #include "include/core/SkTypeface.h"
 #include "include/core/SkTypes.h"
+#include "include/effects/SkImageFilters.h"
+#include "include/private/base/SkAlign.h"
+#include "src/base/SkAutoMalloc.h"
 #include "src/base/SkRandom.h"
 #include "src/core/SkBigPicture.h"
+#include "src/core/SkPictureData.h"
+#include "src/core/SkPictureLayerCache.h"
 #include "src/core/SkPicturePriv.h"
 #include "src/core/SkRectPriv.h"
+#include "tests/FakeStreams.h"
 #include "tests/Test.h"
+#include "tools/ToolUtils.h"
 #include "tools/fonts/FontToolUtils.h"
 
+#include <atomic>
 #include <cstddef>
+#include <cstring>
+#include <functional>
 #include <memory>
 #include <vector>
 
@@ -701,6 +717,44 @@ DEF_TEST(Picture_getRecordingCanvas, r) {
     }
 }
 
+DEF_TEST(Picture_recycleStorage, r) {
+    SkPictureRecorder rec;
+    rec.setRecycleStorage(true);
+
+    auto record = [&](SkColor color) {
+        SkCanvas* canvas = rec.beginRecording(10, 10);
+        SkPaint paint;
+        paint.setColor(color);
+        for (int i = 0; i < 10; i++) {
+            canvas->drawRect(SkRect::MakeXYWH(i, 0, 1, 10), paint);
+        }
+        return rec.finishRecordingAsPicture();
+    };
+    auto center = [](const sk_sp<SkPicture>& pic) {
+        SkBitmap bm;
+        bm.allocN32Pixels(10, 10);
+        SkCanvas canvas(bm);
+        canvas.drawPicture(pic);
+        return bm.getColor(5, 5);
+    };
+
+    // The first picture is still alive while the second is recorded, so its storage must not be
+    // reused out from under it.
+    sk_sp<SkPicture> red = record(SK_ColorRED);
+    sk_sp<SkPicture> blue = record(SK_ColorBLUE);
+    REPORTER_ASSERT(r, center(red) == SK_ColorRED);
+    REPORTER_ASSERT(r, center(blue) == SK_ColorBLUE);
+
+    // Once released, recordings reuse that storage and still come out right.
+    red = nullptr;
+    blue = nullptr;
+    for (int i = 0; i < 3; i++) {
+        sk_sp<SkPicture> green = record(SK_ColorGREEN);
+        REPORTER_ASSERT(r, green->approximateOpCount() == 10);
+        REPORTER_ASSERT(r, center(green) == SK_ColorGREEN);
+    }
+}
+
 DEF_TEST(Picture_preserveCullRect, r) {
     SkPictureRecorder recorder;
 
@@ -793,6 +847,69 @@ DEF_TEST(Picture_empty_serial, reporter) {
     REPORTER_ASSERT(reporter, pic2);
 }
 
+DEF_TEST(Picture_serial_inPlace, r) {
+    auto make_pic = [](const sk_sp<SkPicture>& nested) {
+        SkPictureRecorder rec;
+        SkCanvas* c = rec.beginRecording({0,0, 64,64});
+        SkPaint paint;
+        paint.setColor(SK_ColorBLUE);
+        paint.setAntiAlias(true);
+        c->drawPath(SkPath::Circle(32, 32, 20), paint);
+        paint.setColor(0x8000FF00);
+        c->drawRect({5,5, 40,27}, paint);
+        if (nested) {
+            c->translate(16, 16);
+            c->drawPicture(nested);
+        }
+        return rec.finishRecordingAsPicture();
+    };
+    sk_sp<SkPicture> pic = make_pic(make_pic(make_pic(nullptr)));
+    sk_sp<SkData> data = pic->serialize();
+    REPORTER_ASSERT(r, data);
+
+    // The op data and flattened buffer are padded to be aligned relative to the stream's start.
+    SkMemoryStream stream(data);
+    REPORTER_ASSERT(r, SkPicture_StreamIsSKP(&stream, nullptr));
+    REPORTER_ASSERT(r, stream.skip(1) == 1);
+    uint32_t tag = 0, size = 0;
+    REPORTER_ASSERT(r, stream.readU32(&tag) && stream.readU32(&size));
+    if (tag == SK_PICT_PADDING_TAG) {
+        REPORTER_ASSERT(r, size <= 3 && stream.skip(size) == size);
+        REPORTER_ASSERT(r, stream.readU32(&tag) && stream.readU32(&size));
+    }
+    REPORTER_ASSERT(r, tag == SK_PICT_READER_TAG);
+    REPORTER_ASSERT(r, SkIsAlign4(stream.getPosition()));
+
+    auto draw = [](const sk_sp<SkPicture>& p) {
+        SkBitmap bm;
+        bm.allocN32Pixels(64, 64);
+        bm.eraseColor(SK_ColorWHITE);
+        SkCanvas canvas(bm);
+        canvas.drawPicture(p);
+        return bm;
+    };
+    const SkBitmap expected = draw(pic);
+
+    // Read in place from the SkData...
+    sk_sp<SkPicture> inPlace = SkPicture::MakeFromData(data.get());
+    // ...copied out of memory that isn't aligned...
+    SkAutoMalloc storage(data->size() + 1);
+    char* misaligned = static_cast<char*>(storage.get()) + 1;
+    memcpy(misaligned, data->data(), data->size());
+    sk_sp<SkPicture> copied = SkPicture::MakeFromData(misaligned, data->size());
+    // ...and copied out of a stream without memory.
+    NotAssetMemStream notMemory(data);
+    sk_sp<SkPicture> streamed = SkPicture::MakeFromStream(&notMemory);
+
+    for (const sk_sp<SkPicture>& p : {inPlace, copied, streamed}) {
+        REPORTER_ASSERT(r, p);
+        if (p) {
+            REPORTER_ASSERT(r, p->approximateOpCount(true) == pic->approximateOpCount(true));
+            REPORTER_ASSERT(r, ToolUtils::equal_pixels(draw(p), expected));
+        }
+    }
+}
+
 
 DEF_TEST(Picture_drawsNothing, r) {
     // Tests that pic->cullRect().isEmpty() is a good way to test a picture
@@ -896,11 +1013,14 @@ DEF_TEST(Picture_nested_op_count, r) {
     auto make_pic = [](int n, const sk_sp<SkPicture>& pic) {
         SkPictureRecorder rec;
         SkCanvas* c = rec.beginRecording({0,0, 100,100});
+        // Translucent, so each rect doesn't hide (and get optimized away under) the next.
+        SkPaint paint;
+        paint.setAlphaf(0.5f);
         for (int i = 0; i < n; i++) {
             if (pic) {
                 c->drawPicture(pic);
             } else {
-                c->drawRect({0,0, 100,100}, SkPaint{});
+                c->drawRect({0,0, 100,100}, paint);
             }
         }
         return rec.finishRecordingAsPicture();
@@ -924,3 +1044,175 @@ DEF_TEST(Picture_nested_op_count, r) {
     check(make_pic(10, leaf1),  10,  10);
     check(make_pic(10, leaf10), 10, 100);
 }
+
+// Draws 'picture' through 'cache' the way SkCanvas::drawPicture() does with the global cache.
+static void draw_through_layer_cache(SkPictureLayerCache* cache, SkCanvas* canvas,
+                                     const sk_sp<SkPicture>& picture) {
+    SkPixmap pm;
+    SkAssertResult(canvas->peekPixels(&pm));
+    if (!cache->drawPicture(canvas, pm.info(), picture.get(), nullptr, nullptr)) {
+        canvas->drawPicture(picture);
+    }
+}
+
+DEF_TEST(Picture_layerCache, r) {
+    SkPictureRecorder recorder;
+    SkCanvas* c = recorder.beginRecording({0, 0, 40, 30});
+    SkPaint paint;
+    for (int i = 0; i < 6; i++) {
+        paint.setColor(i & 1 ? SK_ColorBLUE : SK_ColorGREEN);
+        c->drawRect(SkRect::MakeXYWH(5 * i, 3 * i, 10, 8), paint);
+    }
+    sk_sp<SkPicture> picture = recorder.finishRecordingAsPicture();
+    REPORTER_ASSERT(r, picture->approximateOpCount() > 1);  // not unrolled by drawPicture()
+
+    // A local cache keeps this independent of other tests drawing pictures meanwhile.
+    SkPictureLayerCache cache(1024 * 1024);
+    const SkImageInfo info = SkImageInfo::MakeN32Premul(100, 100);
+    auto expected = SkSurfaces::Raster(info);
+    auto actual = SkSurfaces::Raster(info);
+    auto draw = [&](SkCanvas* canvas, int frame, bool cached) {
+        canvas->clear(SK_ColorWHITE);
+        canvas->save();
+        // The clip and whole-pixel translate change from frame to frame, the scale doesn't.
+        canvas->clipRect(SkRect::MakeXYWH(frame, 0, 90 - 2 * frame, 100));
+        canvas->translate(3 + 2 * frame, 5 + frame);
+        canvas->scale(2, 2);
+        if (cached) {
+            draw_through_layer_cache(&cache, canvas, picture);
+        } else {
+            canvas->drawPicture(picture);
+        }
+        canvas->restore();
+    };
+
+    for (int frame = 0; frame < 5; ++frame) {
+        draw(expected->getCanvas(), frame, false);
+        draw(actual->getCanvas(), frame, true);
+
+        SkPixmap e, a;
+        SkAssertResult(expected->peekPixels(&e));
+        SkAssertResult(actual->peekPixels(&a));
+        for (int y = 0; y < info.height(); ++y) {
+            REPORTER_ASSERT(r, 0 == memcmp(e.addr(0, y), a.addr(0, y), e.info().minRowBytes()),
+                            "frame %d, row %d", frame, y);
+        }
+    }
+
+    // The first two frames replayed the picture, the third cached it and the rest reused that.
+    SkPictureLayerCache::Stats stats = cache.stats();
+    REPORTER_ASSERT(r, stats.fMisses == 2);
+    REPORTER_ASSERT(r, stats.fPromotions == 1);
+    REPORTER_ASSERT(r, stats.fHits == 2);
+    REPORTER_ASSERT(r, stats.fCount == 1);
+    REPORTER_ASSERT(r, stats.fBytesUsed == 80 * 60 * 4);
+
+    // A different scale needs its own layer.
+    actual->getCanvas()->scale(0.5f, 0.5f);
+    draw_through_layer_cache(&cache, actual->getCanvas(), picture);
+    REPORTER_ASSERT(r, cache.stats().fMisses == 3);
+
+    // Layers over the limit aren't cached.
+    cache.setByteLimit(1024);
+    REPORTER_ASSERT(r, cache.stats().fCount == 0);
+    for (int i = 0; i < 4; ++i) {
+        draw(actual->getCanvas(), 0, true);
+    }
+    REPORTER_ASSERT(r, cache.stats().fPromotions == 1);
+}
+
+// Pictures that blend other than src-over, or read what is under them, would draw differently
+// through a transparent layer, so they are always replayed.
+DEF_TEST(Picture_layerCacheSkipsDestinationReads, r) {
+    auto record = [](const std::function<void(SkCanvas*)>& draw) {
+        SkPictureRecorder recorder;
+        SkCanvas* c = recorder.beginRecording({0, 0, 40, 30});
+        SkPaint paint;
+        paint.setColor(SK_ColorBLUE);
+        c->drawRect(SkRect::MakeWH(20, 20), paint);
+        draw(c);
+        c->drawRect(SkRect::MakeXYWH(20, 10, 20, 20), paint);
+        return recorder.finishRecordingAsPicture();
+    };
+    const sk_sp<SkPicture> pictures[] = {
+        record([](SkCanvas* c) {
+            SkPaint clear;
+            clear.setBlendMode(SkBlendMode::kClear);
+            c->drawRect(SkRect::MakeXYWH(5, 5, 10, 10), clear);
+        }),
+        record([](SkCanvas* c) {
+            sk_sp<SkImageFilter> blur = SkImageFilters::Blur(2, 2, nullptr);
+            c->saveLayer(SkCanvas::SaveLayerRec(nullptr, nullptr, blur.get(), 0));
+            c->restore();
+        }),
+    };
+
+    const SkImageInfo info = SkImageInfo::MakeN32Premul(50, 40);
+    for (const sk_sp<SkPicture>& picture : pictures) {
+        SkPictureLayerCache cache(1024 * 1024, /*promoteAfter=*/0);
+        auto expected = SkSurfaces::Raster(info);
+        auto actual = SkSurfaces::Raster(info);
+        for (int frame = 0; frame < 3; ++frame) {
+            expected->getCanvas()->clear(SK_ColorRED);
+            expected->getCanvas()->drawPicture(picture);
+            actual->getCanvas()->clear(SK_ColorRED);
+            draw_through_layer_cache(&cache, actual->getCanvas(), picture);
+
+            SkPixmap e, a;
+            SkAssertResult(expected->peekPixels(&e));
+            SkAssertResult(actual->peekPixels(&a));
+            for (int y = 0; y < info.height(); ++y) {
+                REPORTER_ASSERT(r,
+                                0 == memcmp(e.addr(0, y), a.addr(0, y), e.info().minRowBytes()),
+                                "frame %d, row %d", frame, y);
+            }
+        }
+        REPORTER_ASSERT(r, cache.stats().fPromotions == 0);
+        REPORTER_ASSERT(r, cache.stats().fCount == 0);
+    }
+}
+
+DEF_TEST(Picture_serializeWithImageExecutor, r) {
+    auto make_image = [](SkColor color) {
+        SkBitmap bitmap;
+        bitmap.allocN32Pixels(16, 16);
+        bitmap.eraseColor(color);
+        bitmap.setImmutable();
+        return bitmap.asImage();
+    };
+    // Two images with the same pixels but different IDs, and one that differs.
+    sk_sp<SkImage> red0 = make_image(SK_ColorRED),
+                   red1 = make_image(SK_ColorRED),
+                   blue = make_image(SK_ColorBLUE);
+    REPORTER_ASSERT(r, red0->uniqueID() != red1->uniqueID());
+
+    SkPictureRecorder recorder;
+    recorder.beginRecording({0, 0, 64, 64})->drawImage(red1, 20, 0);
+    sk_sp<SkPicture> nested = recorder.finishRecordingAsPicture();
+
+    SkCanvas* canvas = recorder.beginRecording({0, 0, 64, 64});
+    canvas->drawImage(red0, 0, 0);
+    canvas->drawImage(blue, 0, 20);
+    canvas->drawImage(red0, 20, 20);
+    canvas->drawPicture(nested);
+    sk_sp<SkPicture> picture = recorder.finishRecordingAsPicture();
+
+    std::atomic<int> calls{0};
+    SkSerialProcs procs;
+    procs.fImageProc = [](SkImage*, void* ctx) -> sk_sp<SkData> {
+        static_cast<std::atomic<int>*>(ctx)->fetch_add(1);
+        return nullptr;  // use the default encoding
+    };
+    procs.fImageCtx = &calls;
+    sk_sp<SkData> expected = picture->serialize(&procs);
+    REPORTER_ASSERT(r, calls == 3);
+
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    calls = 0;
+    procs.fImageExecutor = executor.get();
+    sk_sp<SkData> actual = picture->serialize(&procs);
+    // The red images are encoded once, and the output is the same.
+    REPORTER_ASSERT(r, calls == 2);
+    REPORTER_ASSERT(r, actual && actual->equals(expected.get()));
+    REPORTER_ASSERT(r, SkPicture::MakeFromData(actual.get()));
+}
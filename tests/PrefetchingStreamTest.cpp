@@ -0,0 +1,165 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkStream.h"
+#include "include/private/base/SkSemaphore.h"
+#include "src/utils/SkPrefetchingStream.h"
+#include "tests/Test.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Hands out at most |chunkSize| bytes per read(), like a socket would. If |gate| is not null,
+// each read() first waits for it to be signaled.
+class ChunkedStream : public SkStream {
+public:
+    ChunkedStream(sk_sp<SkData> data, size_t chunkSize, SkSemaphore* gate = nullptr)
+            : fStream(std::move(data)), fChunkSize(chunkSize), fGate(gate) {}
+
+    size_t read(void* buffer, size_t size) override {
+        if (fGate) {
+            fGate->wait();
+        }
+        return fStream.read(buffer, std::min(size, fChunkSize));
+    }
+    bool isAtEnd() const override { return fStream.isAtEnd(); }
+
+private:
+    SkMemoryStream fStream;
+    const size_t   fChunkSize;
+    SkSemaphore*   fGate;
+};
+
+}  // namespace
+
+static sk_sp<SkData> make_data(size_t size) {
+    sk_sp<SkData> data = SkData::MakeUninitialized(size);
+    auto bytes = static_cast<uint8_t*>(data->writable_data());
+    for (size_t i = 0; i < size; ++i) {
+        bytes[i] = static_cast<uint8_t>(i * 7 + (i >> 8));
+    }
+    return data;
+}
+
+DEF_TEST(PrefetchingStream_Read, r) {
+    constexpr size_t kSize = 100 * 1024;
+    const sk_sp<SkData> data = make_data(kSize);
+    std::unique_ptr<SkExecutor> pool = SkExecutor::MakeFIFOThreadPool(4);
+
+    for (SkExecutor* executor : {static_cast<SkExecutor*>(nullptr), pool.get()}) {
+        for (size_t windowSize : {1, 100, 4096, 1 << 20}) {
+            auto stream = SkPrefetchingStream::Make(std::make_unique<ChunkedStream>(data, 1000),
+                                                    executor, windowSize);
+            REPORTER_ASSERT(r, stream && !stream->hasLength());
+
+            std::vector<uint8_t> read(kSize);
+            size_t total = 0;
+            for (size_t size = 1; total < kSize; size = size * 3 % 5003) {
+                const size_t n = stream->read(read.data() + total, size);
+                REPORTER_ASSERT(r, n == std::min(size, kSize - total),
+                                "window %zu: read %zu of %zu", windowSize, n, size);
+                total += n;
+                REPORTER_ASSERT(r, stream->getPosition() == total);
+            }
+            REPORTER_ASSERT(r, memcmp(read.data(), data->data(), kSize) == 0,
+                            "window %zu", windowSize);
+
+            uint8_t byte;
+            REPORTER_ASSERT(r, stream->read(&byte, 1) == 0);
+            REPORTER_ASSERT(r, stream->isAtEnd());
+        }
+    }
+}
+
+DEF_TEST(PrefetchingStream_Skip, r) {
+    constexpr size_t kSize = 10000;
+    const sk_sp<SkData> data = make_data(kSize);
+    std::unique_ptr<SkExecutor> pool = SkExecutor::MakeFIFOThreadPool(2);
+
+    auto stream = SkPrefetchingStream::Make(std::make_unique<ChunkedStream>(data, 333),
+                                            pool.get(), 512);
+    REPORTER_ASSERT(r, stream->skip(4321) == 4321);
+    uint8_t byte;
+    REPORTER_ASSERT(r, stream->read(&byte, 1) == 1);
+    REPORTER_ASSERT(r, byte == data->bytes()[4321]);
+    REPORTER_ASSERT(r, stream->skip(kSize) == kSize - 4322);
+    REPORTER_ASSERT(r, stream->isAtEnd());
+}
+
+DEF_TEST(PrefetchingStream_Peek, r) {
+    const sk_sp<SkData> data = make_data(1000);
+    std::unique_ptr<SkExecutor> pool = SkExecutor::MakeFIFOThreadPool(2);
+
+    auto stream = SkPrefetchingStream::Make(std::make_unique<ChunkedStream>(data, 7),
+                                            pool.get(), 64);
+    uint8_t peeked[100];
+    // peek() waits for all it asked for, even though each source read returns only 7 bytes,
+    // but never asks for more than the window holds.
+    REPORTER_ASSERT(r, stream->peek(peeked, 50) == 50);
+    REPORTER_ASSERT(r, memcmp(peeked, data->data(), 50) == 0);
+    REPORTER_ASSERT(r, stream->peek(peeked, 100) == 64);
+    REPORTER_ASSERT(r, memcmp(peeked, data->data(), 64) == 0);
+    REPORTER_ASSERT(r, stream->getPosition() == 0);
+
+    REPORTER_ASSERT(r, stream->skip(990) == 990);
+    REPORTER_ASSERT(r, stream->peek(peeked, 50) == 10);
+    REPORTER_ASSERT(r, memcmp(peeked, data->bytes() + 990, 10) == 0);
+    REPORTER_ASSERT(r, !stream->isAtEnd());
+}
+
+DEF_TEST(PrefetchingStream_NonBlocking, r) {
+    constexpr size_t kSize = 250;
+    const sk_sp<SkData> data = make_data(kSize);
+    std::unique_ptr<SkExecutor> pool = SkExecutor::MakeFIFOThreadPool(1);
+    SkSemaphore gate;
+
+    auto stream = SkPrefetchingStream::Make(std::make_unique<ChunkedStream>(data, 100, &gate),
+                                            pool.get(), 1024);
+    stream->setBlocking(false);
+
+    // Nothing has arrived yet, which is not the same as the end of the stream.
+    uint8_t read[kSize];
+    REPORTER_ASSERT(r, stream->read(read, kSize) == 0);
+    REPORTER_ASSERT(r, !stream->isAtEnd());
+
+    gate.signal();
+    REPORTER_ASSERT(r, stream->waitForMoreData() == 100);
+    REPORTER_ASSERT(r, stream->read(read, kSize) == 100);
+    REPORTER_ASSERT(r, !stream->isAtEnd());
+
+    gate.signal(2);
+    size_t total = 100;
+    while (!stream->isAtEnd()) {
+        const size_t n = stream->read(read + total, kSize - total);
+        if (n == 0) {
+            stream->waitForMoreData();
+        }
+        total += n;
+    }
+    REPORTER_ASSERT(r, total == kSize);
+    REPORTER_ASSERT(r, memcmp(read, data->data(), kSize) == 0);
+}
+
+DEF_TEST(PrefetchingStream_DestroyWhileFetching, r) {
+    // The stream must wait for the read-ahead to stop before going away.
+    std::unique_ptr<SkExecutor> pool = SkExecutor::MakeFIFOThreadPool(2);
+    for (int i = 0; i < 20; ++i) {
+        auto stream = SkPrefetchingStream::Make(
+                std::make_unique<ChunkedStream>(make_data(1 << 20), 100), pool.get());
+        uint8_t bytes[10];
+        REPORTER_ASSERT(r, stream->read(bytes, i % 2 ? 0 : 10) == (i % 2 ? 0u : 10u));
+    }
+}
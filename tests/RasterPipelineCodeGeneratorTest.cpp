@@ -20,10 +20,15 @@
 #include "src/sksl/tracing/SkSLDebugTracePriv.h"
 #include "tests/Test.h"
 
+#include <cstdint>
+#include <cstdlib>
+#include <iterator>
 #include <memory>
 #include <optional>
 #include <string>
 
+extern bool gForceHighPrecisionRasterPipeline;
+
 //#define DUMP_PROGRAMS 1
 #if defined(DUMP_PROGRAMS)
 #include "src/core/SkStreamPriv.h"
@@ -250,3 +255,96 @@ DEF_TEST(SkSLRasterPipelineCodeGeneratorComparisonIntrinsicTest, r) {
          /*startingColor=*/SkColor4f{0.0, 0.0, 0.0, 0.0},
          /*expectedResult=*/SkColor4f{0.0, 1.0, 0.0, 1.0});
 }
+
+static std::unique_ptr<SkSL::RP::Program> make_color_filter_program(skiatest::Reporter* r,
+                                                                    SkSL::Compiler* compiler,
+                                                                    const char* src) {
+    std::unique_ptr<SkSL::Program> program = compiler->convertProgram(
+            SkSL::ProgramKind::kRuntimeColorFilter, std::string(src), SkSL::ProgramSettings{});
+    if (!program) {
+        ERRORF(r, "Unexpected error compiling %s\n%s", src, compiler->errorText().c_str());
+        return nullptr;
+    }
+    const SkSL::FunctionDeclaration* main = program->getFunction("main");
+    std::unique_ptr<SkSL::RP::Program> rasterProg =
+            SkSL::MakeRasterPipelineProgram(*program, *main->definition(), /*debugTrace=*/nullptr);
+    if (!rasterProg) {
+        ERRORF(r, "MakeRasterPipelineProgram failed for %s", src);
+    }
+    return rasterProg;
+}
+
+static void run_color_filter(const SkSL::RP::Program& program,
+                             SkSpan<const float> uniforms,
+                             bool forceHighp,
+                             const uint32_t* src,
+                             uint32_t* dst,
+                             int width) {
+    const bool oldForceHighp = gForceHighPrecisionRasterPipeline;
+    gForceHighPrecisionRasterPipeline = forceHighp;
+
+    SkArenaAlloc alloc(/*firstHeapAllocation=*/1000);
+    SkRasterPipeline pipeline(&alloc);
+    SkRasterPipeline_MemoryCtx srcCtx{const_cast<uint32_t*>(src), /*stride=*/width};
+    SkRasterPipeline_MemoryCtx dstCtx{dst, /*stride=*/width};
+    pipeline.append(SkRasterPipelineOp::load_8888, &srcCtx);
+    program.appendStages(&pipeline, &alloc, /*callbacks=*/nullptr, uniforms);
+    pipeline.append(SkRasterPipelineOp::store_8888, &dstCtx);
+    pipeline.run(0, 0, width, 1);
+
+    gForceHighPrecisionRasterPipeline = oldForceHighp;
+}
+
+DEF_SERIAL_TEST(SkSLRasterPipelineCodeGeneratorLowpTest, r) {
+    static constexpr float kTint[] = {0.25f, 0.5f, 0.75f, 1.0f};
+    static constexpr float kBrightTint[] = {0.25f, 0.5f, 2.0f, 1.0f};
+    struct Case {
+        const char* fSrc;
+        SkSpan<const float> fUniforms;
+        bool fLowp;
+    };
+    const Case kCases[] = {
+        {"half4 main(half4 c) { return c.bgra; }",                                {},   true},
+        {"half4 main(half4 c) { return mix(c, c.gbra, 0.25); }",                  {},   true},
+        {"half4 main(half4 c) { return half4(c.rgb * 0.5 + 0.25, c.a); }",        {},   true},
+        {"half4 main(half4 c) { return min(c, c.a) * 0.75 + c.r * 0.25; }",       {},   true},
+        {"half4 main(half4 c) { return half4(half3(dot(c.rgb, half3(0.25, 0.5, 0.25))), c.a); }",
+                                                                                  {},   true},
+        {"uniform half4 tint; half4 main(half4 c) { return c * tint; }",    kTint,       true},
+        {"uniform half4 tint; half4 main(half4 c) { return c * tint; }",    kBrightTint, false},
+        {"half4 main(half4 c) { return c * 2; }",                                 {},   false},
+        {"half4 main(half4 c) { return c - 0.5; }",                               {},   false},
+        {"half4 main(half4 c) { return c / c.a; }",                               {},   false},
+        {"half4 main(half4 c) { return c.r > 0.5 ? c : c.bgra; }",                {},   false},
+    };
+
+    // An odd width exercises the tail of both the lowp and highp pipelines.
+    uint32_t src[19];
+    for (int i = 0; i < (int)std::size(src); ++i) {
+        src[i] = 0x01020304u * (uint32_t)(i * 13 + 7) ^ (uint32_t)(i * 0x00FF00FF);
+    }
+
+    SkSL::Compiler compiler;
+    for (const Case& c : kCases) {
+        std::unique_ptr<SkSL::RP::Program> program = make_color_filter_program(r, &compiler,
+                                                                               c.fSrc);
+        if (!program) {
+            continue;
+        }
+        REPORTER_ASSERT(r, program->canRunInLowp(c.fUniforms) == c.fLowp, "%s", c.fSrc);
+
+        // Whichever precision the pipeline picks, it has to agree with highp.
+        uint32_t lowp[std::size(src)] = {}, highp[std::size(src)] = {};
+        run_color_filter(*program, c.fUniforms, /*forceHighp=*/false, src, lowp, std::size(src));
+        run_color_filter(*program, c.fUniforms, /*forceHighp=*/true, src, highp, std::size(src));
+        for (size_t i = 0; i < std::size(src); ++i) {
+            for (int shift = 0; shift < 32; shift += 8) {
+                int lowpChannel = (lowp[i] >> shift) & 0xFF,
+                    highpChannel = (highp[i] >> shift) & 0xFF;
+                REPORTER_ASSERT(r, std::abs(lowpChannel - highpChannel) <= 1,
+                                "%s: pixel %zu is %08X in lowp, %08X in highp",
+                                c.fSrc, i, lowp[i], highp[i]);
+            }
+        }
+    }
+}
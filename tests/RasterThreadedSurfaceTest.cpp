@@ -0,0 +1,175 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkPath.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkSurface.h"
+#include "include/effects/SkImageFilters.h"
+#include "tests/Test.h"
+
+#include <cstring>
+#include <functional>
+#include <memory>
+
+static bool equal_pixels(SkSurface* a, SkSurface* b) {
+    SkBitmap bmA, bmB;
+    bmA.allocPixels(a->imageInfo());
+    bmB.allocPixels(b->imageInfo());
+    if (!a->readPixels(bmA, 0, 0) || !b->readPixels(bmB, 0, 0)) {
+        return false;
+    }
+    for (int y = 0; y < bmA.height(); ++y) {
+        if (memcmp(bmA.getAddr(0, y), bmB.getAddr(0, y), bmA.info().minRowBytes()) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void draw_scene(SkCanvas* canvas) {
+    canvas->clear(SK_ColorWHITE);
+
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    paint.setColor(SK_ColorRED);
+    canvas->drawCircle(60, 60, 50, paint);
+
+    canvas->save();
+    canvas->translate(30, 20);
+    canvas->rotate(17);
+    canvas->clipRect(SkRect::MakeXYWH(10, 10, 120, 90), true);
+    paint.setColor(0x8000FF00);
+    canvas->drawRect(SkRect::MakeXYWH(0, 0, 200, 200), paint);
+    canvas->restore();
+
+    SkPaint layerPaint;
+    layerPaint.setImageFilter(SkImageFilters::Blur(4, 4, nullptr));
+    canvas->saveLayer(nullptr, &layerPaint);
+    SkPath path;
+    path.moveTo(100, 150).lineTo(190, 110).lineTo(160, 190).close();
+    paint.setColor(SK_ColorBLUE);
+    canvas->drawPath(path, paint);
+    canvas->restore();
+}
+
+DEF_TEST(RasterThreadedSurface_MatchesRaster, r) {
+    const SkImageInfo info = SkImageInfo::MakeN32Premul(200, 200);
+    auto executor = SkExecutor::MakeFIFOThreadPool(4);
+
+    // An odd tile size makes sure draws straddle plenty of tile edges.
+    constexpr int kTileSize = 37;
+    auto serial = SkSurfaces::Raster(info);
+    auto threaded = SkSurfaces::RasterThreaded(info, executor.get(), kTileSize);
+    REPORTER_ASSERT(r, serial && threaded);
+
+    // Edges can rasterize slightly differently under a clip, so compare against the same scene
+    // drawn serially one clipped tile at a time.
+    for (int y = 0; y < info.height(); y += kTileSize) {
+        for (int x = 0; x < info.width(); x += kTileSize) {
+            SkCanvas* canvas = serial->getCanvas();
+            canvas->save();
+            canvas->clipRect(SkRect::MakeXYWH(x, y, kTileSize, kTileSize));
+            draw_scene(canvas);
+            canvas->restore();
+        }
+    }
+    draw_scene(threaded->getCanvas());
+    REPORTER_ASSERT(r, equal_pixels(serial.get(), threaded.get()));
+}
+
+DEF_TEST(RasterThreadedSurface_StateAcrossFlushes, r) {
+    const SkImageInfo info = SkImageInfo::MakeN32Premul(128, 128);
+    auto executor = SkExecutor::MakeFIFOThreadPool(2);
+
+    auto serial = SkSurfaces::Raster(info);
+    auto threaded = SkSurfaces::RasterThreaded(info, executor.get(), 32);
+
+    // Reading the pixels flushes whatever is pending, including in the middle of a save() or
+    // a saveLayer(), so check after every step.
+    auto step = [&](const std::function<void(SkCanvas*)>& draw) {
+        draw(serial->getCanvas());
+        draw(threaded->getCanvas());
+        return equal_pixels(serial.get(), threaded.get());
+    };
+
+    SkPaint paint;
+    paint.setColor(SK_ColorGREEN);
+    REPORTER_ASSERT(r, step([](SkCanvas* c) {
+        c->clear(SK_ColorBLACK);
+        c->save();
+        c->translate(10, 10);
+    }));
+    REPORTER_ASSERT(r, step([&](SkCanvas* c) {
+        c->clipRect({0, 0, 50, 50});
+        c->drawPaint(paint);
+    }));
+    REPORTER_ASSERT(r, step([&](SkCanvas* c) {
+        c->saveLayerAlpha(nullptr, 0x80);
+        c->drawRect({40, 40, 90, 90}, paint);
+    }));
+    REPORTER_ASSERT(r, step([&](SkCanvas* c) {
+        c->drawRect({0, 0, 20, 20}, paint);
+        c->restore();
+    }));
+    REPORTER_ASSERT(r, step([&](SkCanvas* c) {
+        c->restore();
+        c->drawRect({100, 100, 120, 120}, paint);
+    }));
+}
+
+DEF_TEST(RasterThreadedSurface_SnapshotIsImmutable, r) {
+    const SkImageInfo info = SkImageInfo::MakeN32Premul(64, 64);
+    auto threaded = SkSurfaces::RasterThreaded(info, nullptr, 16);
+
+    threaded->getCanvas()->clear(SK_ColorRED);
+    sk_sp<SkImage> image = threaded->makeImageSnapshot();
+    threaded->getCanvas()->clear(SK_ColorBLUE);
+
+    SkBitmap after;
+    after.allocPixels(info);
+    REPORTER_ASSERT(r, threaded->readPixels(after, 0, 0));
+    REPORTER_ASSERT(r, after.getColor(5, 5) == SK_ColorBLUE);
+
+    SkBitmap before;
+    before.allocPixels(info);
+    REPORTER_ASSERT(r, image->readPixels(nullptr, before.pixmap(), 0, 0));
+    REPORTER_ASSERT(r, before.getColor(5, 5) == SK_ColorRED);
+}
+
+DEF_TEST(RasterThreadedSurface_DrawsInvalidateSnapshot, r) {
+    const SkImageInfo info = SkImageInfo::MakeN32Premul(64, 64);
+    auto threaded = SkSurfaces::RasterThreaded(info, nullptr, 16);
+
+    threaded->getCanvas()->clear(SK_ColorRED);
+    sk_sp<SkImage> red = threaded->makeImageSnapshot();
+    const uint32_t redGenID = threaded->generationID();
+
+    // A recorded draw has to drop the cached snapshot and change the generation ID right away,
+    // just like drawing to a raster surface does.
+    threaded->getCanvas()->drawRect({0, 0, 8, 8}, SkPaint(SkColors::kBlue));
+    REPORTER_ASSERT(r, threaded->generationID() != redGenID);
+
+    sk_sp<SkImage> blue = threaded->makeImageSnapshot();
+    REPORTER_ASSERT(r, blue != red);
+    REPORTER_ASSERT(r, blue->uniqueID() != red->uniqueID());
+
+    SkBitmap bm;
+    bm.allocPixels(info);
+    REPORTER_ASSERT(r, blue->readPixels(nullptr, bm.pixmap(), 0, 0));
+    REPORTER_ASSERT(r, bm.getColor(5, 5) == SK_ColorBLUE);
+    REPORTER_ASSERT(r, bm.getColor(20, 20) == SK_ColorRED);
+    REPORTER_ASSERT(r, red->readPixels(nullptr, bm.pixmap(), 0, 0));
+    REPORTER_ASSERT(r, bm.getColor(5, 5) == SK_ColorRED);
+}
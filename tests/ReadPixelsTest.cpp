@@ -14,6 +14,8 @@
 #include "include/core/SkColorPriv.h"
 #include "include/core/SkColorSpace.h"
 #include "include/core/SkColorType.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkGraphics.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkMatrix.h"
@@ -31,14 +33,18 @@
 #include "include/private/base/SkSafe32.h"
 #include "src/base/SkHalf.h"
 #include "src/base/SkMathPriv.h"
+#include "src/base/SkRandom.h"
+#include "src/base/SkVx.h"
 #include "src/core/SkImageInfoPriv.h"
 #include "tests/Test.h"
 
 #include <cstdint>
+#include <cstdlib>
 #include <cstring>
 #include <initializer_list>
 #include <memory>
 #include <string>
+#include <utility>
 
 static const int DEV_W = 100, DEV_H = 100;
 static const SkIRect DEV_RECT = SkIRect::MakeWH(DEV_W, DEV_H);
@@ -551,3 +557,106 @@ DEF_TEST(ReadPixels_InvalidRowBytes, reporter) {
         REPORTER_ASSERT(reporter, !surf->readPixels(dstII, storage.get(), badRowBytes, 0, 0));
     }
 }
+
+DEF_SERIAL_TEST(ReadPixels_Parallel, reporter) {
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+
+    // 1000 pixel wide rows are converted in bands of 65 rows, so the last band is short. The
+    // source has padded rows to check that bands start at the right row.
+    const auto p3 = SkColorSpace::MakeRGB(SkNamedTransferFn::kSRGB, SkNamedGamut::kDisplayP3);
+    const SkImageInfo srcInfo = SkImageInfo::Make(1000, 300, kRGBA_F16_SkColorType,
+                                                  kPremul_SkAlphaType, p3);
+    SkBitmap src;
+    src.allocPixels(srcInfo, srcInfo.minRowBytes() + 24);
+    SkRandom rand;
+    for (int y = 0; y < src.height(); ++y) {
+        for (int x = 0; x < src.width(); ++x) {
+            const float a = rand.nextF();
+            const skvx::float4 c = {rand.nextF() * a, rand.nextF() * a, rand.nextF() * a, a};
+            to_half(c).store(src.getAddr(x, y));
+        }
+    }
+
+    const SkImageInfo dstInfo = srcInfo.makeColorType(kRGBA_8888_SkColorType)
+                                       .makeColorSpace(SkColorSpace::MakeSRGB());
+    SkBitmap serial, parallel;
+    serial.allocPixels(dstInfo);
+    parallel.allocPixels(dstInfo);
+
+    REPORTER_ASSERT(reporter, src.readPixels(serial.pixmap()));
+    SkGraphics::SetParallelPixelConversion(executor.get(), 0);
+    REPORTER_ASSERT(reporter, src.readPixels(parallel.pixmap()));
+    SkGraphics::SetParallelPixelConversion(nullptr);
+
+    for (int y = 0; y < dstInfo.height(); ++y) {
+        if (memcmp(serial.getAddr32(0, y), parallel.getAddr32(0, y), dstInfo.minRowBytes()) != 0) {
+            ERRORF(reporter, "Parallel conversion differs from serial conversion in row %d", y);
+            break;
+        }
+    }
+}
+
+DEF_TEST(RescaleAndReadPixels_Raster, reporter) {
+    // A one pixel checkerboard averages to 50% gray, which is 128 when filtered in sRGB and 188
+    // when filtered in linear light.
+    const SkImageInfo srcInfo = SkImageInfo::MakeN32Premul(512, 384, SkColorSpace::MakeSRGB());
+    SkBitmap checker;
+    checker.allocPixels(srcInfo);
+    for (int y = 0; y < srcInfo.height(); ++y) {
+        for (int x = 0; x < srcInfo.width(); ++x) {
+            *checker.getAddr32(x, y) = ((x + y) & 1) ? SK_ColorWHITE : SK_ColorBLACK;
+        }
+    }
+    sk_sp<SkImage> image = checker.asImage();
+
+    struct Context {
+        std::unique_ptr<const SkImage::AsyncReadResult> fResult;
+    };
+    auto callback = [](SkImage::ReadPixelsContext context,
+                       std::unique_ptr<const SkImage::AsyncReadResult> result) {
+        static_cast<Context*>(context)->fResult = std::move(result);
+    };
+
+    const SkImageInfo dstInfo = srcInfo.makeWH(20, 15);
+    for (auto mode : {SkImage::RescaleMode::kRepeatedLinear,
+                      SkImage::RescaleMode::kRepeatedCubic}) {
+        for (auto [gamma, expected] : {std::pair(SkImage::RescaleGamma::kSrc, 128),
+                                       std::pair(SkImage::RescaleGamma::kLinear, 188)}) {
+            Context context;
+            image->asyncRescaleAndReadPixels(dstInfo, srcInfo.bounds(), gamma, mode, callback,
+                                             &context);
+            if (!context.fResult) {
+                ERRORF(reporter, "Rescale failed");
+                continue;
+            }
+            SkPixmap result(dstInfo, context.fResult->data(0), context.fResult->rowBytes(0));
+            for (int y = 0; y < dstInfo.height(); ++y) {
+                for (int x = 0; x < dstInfo.width(); ++x) {
+                    const SkColor c = result.getColor(x, y);
+                    if (SkColorGetA(c) != 255 || std::abs((int)SkColorGetG(c) - expected) > 2) {
+                        ERRORF(reporter, "Pixel (%d, %d) is %08x, expected gray %d",
+                               x, y, c, expected);
+                        return;
+                    }
+                }
+            }
+        }
+    }
+
+    // Upscaling a solid color keeps it exactly.
+    SkBitmap solid;
+    solid.allocPixels(srcInfo.makeWH(7, 5));
+    solid.eraseColor(0xFF336699);
+    Context context;
+    solid.asImage()->asyncRescaleAndReadPixels(
+            srcInfo.makeWH(31, 17), SkIRect::MakeWH(7, 5), SkImage::RescaleGamma::kLinear,
+            SkImage::RescaleMode::kRepeatedCubic, callback, &context);
+    REPORTER_ASSERT(reporter, context.fResult);
+    if (context.fResult) {
+        SkPixmap result(srcInfo.makeWH(31, 17), context.fResult->data(0),
+                        context.fResult->rowBytes(0));
+        REPORTER_ASSERT(reporter, result.getColor(0, 0) == 0xFF336699);
+        REPORTER_ASSERT(reporter, result.getColor(15, 8) == 0xFF336699);
+        REPORTER_ASSERT(reporter, result.getColor(30, 16) == 0xFF336699);
+    }
+}
@@ -41,6 +41,7 @@
 #include "src/core/SkImageInfoPriv.h"
 #include "src/gpu/SkBackingFit.h"
 #include "src/gpu/ganesh/GrCaps.h"
+#include "src/gpu/ganesh/GrClientMappedBufferManager.h"
 #include "src/gpu/ganesh/GrDataUtils.h"
 #include "src/gpu/ganesh/GrDirectContextPriv.h"
 #include "src/gpu/ganesh/GrFragmentProcessor.h"
@@ -733,6 +734,72 @@ DEF_GANESH_TEST_FOR_RENDERING_CONTEXTS(SurfaceAsyncReadPixels,
     }
 }
 
+DEF_GANESH_TEST_FOR_RENDERING_CONTEXTS(SurfaceAsyncReadPixelsBatch,
+                                       reporter,
+                                       ctxInfo,
+                                       CtsEnforcement::kNever) {
+    auto direct = ctxInfo.directContext();
+    static constexpr int kSurfaceCount = 3;
+    static constexpr SkColor kColors[kSurfaceCount] = {SK_ColorRED, SK_ColorGREEN, SK_ColorBLUE};
+    const auto ii = SkImageInfo::Make(12, 8, kRGBA_8888_SkColorType, kPremul_SkAlphaType);
+
+    sk_sp<SkSurface> surfaces[kSurfaceCount];
+    GrDirectContext::ReadPixelsRequest requests[kSurfaceCount];
+    for (int i = 0; i < kSurfaceCount; ++i) {
+        GrSurfaceOrigin origin = i % 2 ? kBottomLeft_GrSurfaceOrigin : kTopLeft_GrSurfaceOrigin;
+        surfaces[i] = SkSurfaces::RenderTarget(
+                direct, skgpu::Budgeted::kYes, ii, 1, origin, nullptr);
+        if (!surfaces[i]) {
+            ERRORF(reporter, "Could not create surface");
+            return;
+        }
+        surfaces[i]->getCanvas()->clear(kColors[i]);
+        requests[i] = {surfaces[i].get(), SkIRect::MakeXYWH(i, 1, 5 + i, 4)};
+    }
+
+    // The second batch may reuse the transfer buffer of the first.
+    for (int batch = 0; batch < 2; ++batch) {
+        AsyncContext context;
+        direct->asyncReadPixelsBatch(requests, kRGBA_8888_SkColorType, async_callback, &context);
+        direct->submit();
+        while (!context.fCalled) {
+            direct->checkAsyncWorkCompletion();
+        }
+        if (!context.fResult) {
+            ERRORF(reporter, "Batch %d failed", batch);
+            return;
+        }
+        REPORTER_ASSERT(reporter, context.fResult->count() == kSurfaceCount);
+        for (int i = 0; i < kSurfaceCount && i < context.fResult->count(); ++i) {
+            const SkIRect& rect = requests[i].fRect;
+            SkPixmap pixels(ii.makeDimensions(rect.size()),
+                            context.fResult->data(i),
+                            context.fResult->rowBytes(i));
+            for (int y = 0; y < rect.height(); ++y) {
+                for (int x = 0; x < rect.width(); ++x) {
+                    if (pixels.getColor(x, y) != kColors[i]) {
+                        ERRORF(reporter, "Batch %d, request %d: wrong pixel at %d, %d",
+                               batch, i, x, y);
+                        return;
+                    }
+                }
+            }
+        }
+        context.fResult.reset();
+        direct->performDeferredCleanup(std::chrono::minutes(1));
+    }
+
+    // The recycled transfer buffer is purged like any other resource that has gone unused.
+    direct->performDeferredCleanup(std::chrono::milliseconds(0));
+    REPORTER_ASSERT(reporter, !direct->priv().clientMappedBufferManager()->takeRecycledBuffer(1));
+
+    // Rects outside of their surface fail the whole batch.
+    requests[0].fRect = SkIRect::MakeWH(ii.width() + 1, 1);
+    AsyncContext context;
+    direct->asyncReadPixelsBatch(requests, kRGBA_8888_SkColorType, async_callback, &context);
+    REPORTER_ASSERT(reporter, context.fCalled && !context.fResult);
+}
+
 // Manually parameterized by GrRenderable and GrSurfaceOrigin to reduce per-test run time.
 static void image_async_read_pixels(GrRenderable renderable,
                                     GrSurfaceOrigin origin,
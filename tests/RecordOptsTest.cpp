@@ -112,6 +112,95 @@ DEF_TEST(RecordOpts_SaveSaveLayerRestoreRestore, r) {
     }
 }
 
+DEF_TEST(RecordOpts_NoopOccludedDraws, r) {
+    SkPaint opaque, translucent;
+    translucent.setAlphaf(0.5f);
+
+    {
+        SkRecord record;
+        SkRecorder recorder(&record, W, H);
+        recorder.drawRect(SkRect::MakeWH(W, H), opaque);                  // 0: background
+        recorder.drawRect(SkRect::MakeLTRB(10, 10, 20, 20), translucent);  // 1
+        recorder.drawAnnotation(SkRect::MakeWH(50, 50), "link", nullptr);  // 2
+        recorder.drawRect(SkRect::MakeWH(100.5f, 100.5f), translucent);   // 3: doesn't occlude
+        recorder.translate(5, 5);                                          // 4
+        recorder.drawRect(SkRect::MakeWH(100.5f, 100.5f), opaque);        // 5: occludes 1
+        recorder.drawPaint(opaque);                                        // 6: occludes all
+
+        SkRecordNoopOccludedDraws(&record);
+        assert_type<SkRecords::NoOp>(r, record, 0);
+        assert_type<SkRecords::NoOp>(r, record, 1);
+        assert_type<SkRecords::DrawAnnotation>(r, record, 2);
+        assert_type<SkRecords::NoOp>(r, record, 3);
+        assert_type<SkRecords::Translate>(r, record, 4);
+        assert_type<SkRecords::NoOp>(r, record, 5);
+        assert_type<SkRecords::DrawPaint>(r, record, 6);
+    }
+    {
+        // Only draws under the same clip are occluded.
+        SkRecord record;
+        SkRecorder recorder(&record, W, H);
+        recorder.drawRect(SkRect::MakeWH(10, 10), opaque);                 // 0
+        recorder.save();                                                   // 1
+            recorder.drawRect(SkRect::MakeWH(20, 20), opaque);             // 2
+            recorder.clipRect(SkRect::MakeWH(50, 50));                     // 3
+            recorder.drawRect(SkRect::MakeWH(30, 30), opaque);             // 4
+            recorder.drawRect(SkRect::MakeWH(100, 100), opaque);           // 5: occludes 4
+        recorder.restore();                                                // 6
+        recorder.drawRect(SkRect::MakeWH(100, 100), opaque);               // 7: occludes 0, 2
+
+        SkRecordNoopOccludedDraws(&record);
+        assert_type<SkRecords::NoOp>(r, record, 0);
+        assert_type<SkRecords::NoOp>(r, record, 2);
+        assert_type<SkRecords::NoOp>(r, record, 4);
+        assert_type<SkRecords::DrawRect>(r, record, 5);
+        assert_type<SkRecords::DrawRect>(r, record, 7);
+    }
+    {
+        // Nothing is occluded under an anti-aliased clip, by a rotated rect, or across a backdrop.
+        SkRecord record;
+        SkRecorder recorder(&record, W, H);
+        recorder.save();                                                   // 0
+            recorder.clipRect(SkRect::MakeWH(50.5f, 50.5f), true);         // 1
+            recorder.drawRect(SkRect::MakeWH(10, 10), opaque);             // 2
+            recorder.drawPaint(opaque);                                    // 3
+        recorder.restore();                                                // 4
+        recorder.drawRect(SkRect::MakeWH(10, 10), opaque);                 // 5
+        recorder.save();                                                   // 6
+            recorder.rotate(45);                                           // 7
+            recorder.drawRect(SkRect::MakeLTRB(-100, -100, 100, 100), opaque);  // 8
+        recorder.restore();                                                // 9
+        auto blur = SkImageFilters::Blur(3, 3, nullptr);
+        recorder.saveLayer(SkCanvas::SaveLayerRec(nullptr, nullptr, blur.get(), 0));  // 10
+        recorder.restore();                                                // 11
+        recorder.drawPaint(opaque);                                        // 12
+
+        SkRecordNoopOccludedDraws(&record);
+        assert_type<SkRecords::DrawRect>(r, record, 2);
+        assert_type<SkRecords::DrawRect>(r, record, 5);
+        assert_type<SkRecords::DrawRect>(r, record, 8);
+    }
+    {
+        // The bounds of draws inside a layer with an image filter include the filter's offset,
+        // so an opaque rect at the offset position must not occlude the draw it was offset from.
+        SkRecord record;
+        SkRecorder recorder(&record, W, H);
+        SkPaint layerPaint;
+        layerPaint.setImageFilter(SkImageFilters::Offset(100, 0, nullptr));
+        recorder.saveLayer(nullptr, &layerPaint);                          // 0
+            recorder.drawRect(SkRect::MakeLTRB(0, 0, 10, 10), opaque);     // 1
+            recorder.drawRect(SkRect::MakeLTRB(100, 0, 110, 10), opaque);  // 2
+            recorder.drawRect(SkRect::MakeWH(10, 10), translucent);        // 3
+            recorder.drawPaint(opaque);                                    // 4
+        recorder.restore();                                                // 5
+
+        SkRecordNoopOccludedDraws(&record);
+        assert_type<SkRecords::DrawRect>(r, record, 1);
+        assert_type<SkRecords::DrawRect>(r, record, 2);
+        assert_type<SkRecords::DrawRect>(r, record, 3);
+    }
+}
+
 #ifndef SK_BUILD_FOR_ANDROID_FRAMEWORK
 static void assert_savelayer_restore(skiatest::Reporter* r,
                                      SkRecord* record,
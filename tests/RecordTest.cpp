@@ -97,6 +97,34 @@ DEF_TEST(Record_defrag, r) {
     assert_type<SkRecords::Restore >(r, record, 3);
 }
 
+DEF_TEST(Record_reset, r) {
+    SkRecord record;
+    SkPaint paint;
+    for (int i = 0; i < 100; i++) {
+        APPEND(record, SkRecords::DrawRect, paint, SkRect::MakeWH(10, 10));
+    }
+    REPORTER_ASSERT(r, record.count() == 100);
+    const size_t bytes = record.bytesUsed();
+
+    // After a reset the record is empty, and a recording of the same size fits in the same space.
+    record.reset();
+    REPORTER_ASSERT(r, record.count() == 0);
+    for (int i = 0; i < 100; i++) {
+        APPEND(record, SkRecords::DrawRect, paint, SkRect::MakeWH(20, 10));
+    }
+    REPORTER_ASSERT(r, record.count() == 100);
+    REPORTER_ASSERT(r, record.bytesUsed() == bytes);
+
+    AreaSummer summer;
+    summer.apply(record);
+    REPORTER_ASSERT(r, summer.area() == 100 * 200);
+
+    // A record sized from hints works like any other.
+    SkRecord hinted(record.count(), record.bytesUsed());
+    APPEND(hinted, SkRecords::DrawRect, paint, SkRect::MakeWH(10, 10));
+    REPORTER_ASSERT(r, hinted.count() == 1);
+}
+
 #undef APPEND
 
 template <typename T>
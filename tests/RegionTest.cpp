@@ -15,8 +15,10 @@
 #include "include/core/SkScalar.h"
 #include "include/core/SkTypes.h"
 #include "include/private/base/SkDebug.h"
+#include "include/private/base/SkTArray.h"
 #include "src/base/SkAutoMalloc.h"
 #include "src/base/SkRandom.h"
+#include "src/core/SkRegionPriv.h"
 #include "src/core/SkScan.h"
 #include "tests/Test.h"
 
@@ -584,3 +586,59 @@ DEF_TEST(region_very_large, reporter) {
     REPORTER_ASSERT(reporter, smallRegion.contains(499, 0));
     REPORTER_ASSERT(reporter, smallRegion.contains(499, 499));
 }
+
+// The rect list form visits rects in the same order as the iterator, and converts back exactly.
+DEF_TEST(region_rect_list, reporter) {
+    SkRandom rand;
+    for (int i = 0; i < 1000; ++i) {
+        SkRegion rgn;
+        randRgn(rand, &rgn, 8);
+
+        skia_private::TArray<SkIRect> rects;
+        SkRegionPriv::ToRects(rgn, &rects);
+        int index = 0;
+        for (SkRegion::Iterator iter(rgn); !iter.done(); iter.next()) {
+            REPORTER_ASSERT(reporter, index < rects.size() && iter.rect() == rects[index]);
+            index += 1;
+        }
+        REPORTER_ASSERT(reporter, index == rects.size());
+
+        SkRegion copy;
+        REPORTER_ASSERT(reporter, SkRegionPriv::SetRects(&copy, rects) == !rgn.isEmpty());
+        REPORTER_ASSERT(reporter, copy == rgn);
+    }
+}
+
+// Union and intersection take their own span merges; check them pixel by pixel.
+DEF_TEST(region_union_intersect_pixels, reporter) {
+    constexpr int kSize = 32;
+    auto rand_small_rect = [](SkRandom& rand) {
+        SkIRect r = SkIRect::MakeLTRB(rand.nextULessThan(kSize), rand.nextULessThan(kSize),
+                                      rand.nextULessThan(kSize), rand.nextULessThan(kSize));
+        r.sort();
+        return r;
+    };
+
+    SkRandom rand;
+    for (int i = 0; i < 1000; ++i) {
+        SkRegion a, b;
+        for (int j = 0; j < 4; ++j) {
+            a.op(rand_small_rect(rand), SkRegion::kXOR_Op);
+            b.op(rand_small_rect(rand), SkRegion::kXOR_Op);
+        }
+        if (i & 1) {
+            b.setRect(rand_small_rect(rand));
+        }
+
+        SkRegion u, s;
+        u.op(a, b, SkRegion::kUnion_Op);
+        s.op(a, b, SkRegion::kIntersect_Op);
+        for (int y = 0; y < kSize; ++y) {
+            for (int x = 0; x < kSize; ++x) {
+                const bool inA = a.contains(x, y), inB = b.contains(x, y);
+                REPORTER_ASSERT(reporter, u.contains(x, y) == (inA || inB));
+                REPORTER_ASSERT(reporter, s.contains(x, y) == (inA && inB));
+            }
+        }
+    }
+}
@@ -19,6 +19,7 @@
 #include "include/core/SkString.h"
 #include "include/core/SkSurface.h"
 #include "include/core/SkTypes.h"
+#include "include/gpu/GpuMemoryReport.h"
 #include "include/gpu/GpuTypes.h"
 #include "include/gpu/GrBackendSurface.h"
 #include "include/gpu/GrDirectContext.h"
@@ -55,6 +56,7 @@
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <initializer_list>
 #include <memory>
 #include <string_view>
@@ -1025,6 +1027,56 @@ static void test_scratch_key_consistency(skiatest::Reporter* reporter) {
     find->unref();
 }
 
+static void test_memory_report(skiatest::Reporter* reporter) {
+    Mock mock(30000);
+    GrResourceCache* cache = mock.cache();
+    GrGpu* gpu = mock.gpu();
+
+    TestResource* locked = new TestResource(gpu, /*label=*/"locked", skgpu::Budgeted::kYes, 100);
+    TestResource* unbudgeted =
+            new TestResource(gpu, /*label=*/"unbudgeted", skgpu::Budgeted::kNo, 50);
+    TestResource::CreateScratch(gpu, skgpu::Budgeted::kYes, TestResource::kA_SimulatedProperty,
+                                200)->unref();
+
+    // One scratch request misses and one reuses the purgeable resource, which is then returned.
+    skgpu::ScratchKey scratchKey;
+    TestResource::ComputeScratchKey(TestResource::kB_SimulatedProperty, &scratchKey);
+    REPORTER_ASSERT(reporter, !cache->findAndRefScratchResource(scratchKey));
+    TestResource::ComputeScratchKey(TestResource::kA_SimulatedProperty, &scratchKey);
+    GrGpuResource* find = cache->findAndRefScratchResource(scratchKey);
+    REPORTER_ASSERT(reporter, find);
+    find->unref();
+
+    skgpu::GpuMemoryReport report;
+    mock.dContext()->getMemoryReport(&report);
+    REPORTER_ASSERT(reporter, report.fResourceCount == 3);
+    REPORTER_ASSERT(reporter, report.fResourceBytes == 350);
+    REPORTER_ASSERT(reporter, report.fPurgeableBytes == 200);
+    REPORTER_ASSERT(reporter, report.lockedBytes() == 150);
+    REPORTER_ASSERT(reporter, report.fBudgetedBytes == 300);
+    REPORTER_ASSERT(reporter, report.fBudget == 30000);
+    REPORTER_ASSERT(reporter, report.fScratchRequests == 2);
+    REPORTER_ASSERT(reporter, report.fScratchReuses == 1);
+    REPORTER_ASSERT(reporter, report.scratchReuseRate() == 0.5f);
+
+    REPORTER_ASSERT(reporter, report.fResourceTypes.size() == 1);
+    if (report.fResourceTypes.size() == 1) {
+        const skgpu::GpuMemoryReport::ResourceType& type = report.fResourceTypes[0];
+        REPORTER_ASSERT(reporter, !strcmp(type.fName, "Test"));
+        REPORTER_ASSERT(reporter, type.fCount == 3);
+        REPORTER_ASSERT(reporter, type.fPurgeableCount == 1);
+        REPORTER_ASSERT(reporter, type.fPurgeableBytes == 200);
+        REPORTER_ASSERT(reporter, type.fBudgetedBytes == 300);
+    }
+    // No text or paths were drawn, so no atlas has a page.
+    for (const skgpu::GpuMemoryReport::Atlas& atlas : report.fAtlases) {
+        REPORTER_ASSERT(reporter, atlas.fActivePages == 0 && atlas.fBytes == 0);
+    }
+
+    locked->unref();
+    unbudgeted->unref();
+}
+
 static void test_duplicate_unique_key(skiatest::Reporter* reporter) {
     Mock mock(30000);
     GrResourceCache* cache = mock.cache();
@@ -1287,6 +1339,104 @@ static void test_timestamp_wrap(skiatest::Reporter* reporter) {
     }
 }
 
+static void test_predictive_purge(skiatest::Reporter* reporter) {
+    Mock mock(30000);
+    GrResourceCache* cache = mock.cache();
+    GrGpu* gpu = mock.gpu();
+    using Category = GrResourceCache::Category;
+
+    skgpu::UniqueKey keyX, keyY;
+    make_unique_key<0>(&keyX, 0);
+    make_unique_key<0>(&keyY, 1);
+    TestResource* x = new TestResource(gpu, /*label=*/{}, skgpu::Budgeted::kYes, 10);
+    x->resourcePriv().setUniqueKey(keyX);
+    TestResource* y = new TestResource(gpu, /*label=*/{}, skgpu::Budgeted::kYes, 10);
+    y->resourcePriv().setUniqueKey(keyY);
+    x->unref();
+    y->unref();
+    REPORTER_ASSERT(reporter, GrResourceCache::CategoryOf(x) == Category::kBuffer);
+    REPORTER_ASSERT(reporter, cache->getCategoryStats(Category::kBuffer).fBudgetedBytes == 20);
+
+    auto use = [&](const skgpu::UniqueKey& key) {
+        GrGpuResource* resource = cache->findAndRefUniqueResource(key);
+        REPORTER_ASSERT(reporter, resource);
+        SkSafeUnref(resource);
+    };
+    // Y is used every frame through frame 5 and X only in frames 0 and 4, so that X goes four
+    // frames between uses.
+    for (int frame = 1; frame <= 5; ++frame) {
+        cache->notifyFrameSubmitted();
+        if (frame == 4) {
+            use(keyX);
+        }
+        use(keyY);
+    }
+    cache->notifyFrameSubmitted();
+    cache->notifyFrameSubmitted();
+
+    // In frame 7, Y was used more recently than X but is overdue, while X is not yet due.
+    cache->setLimit(10);
+    REPORTER_ASSERT(reporter, cache->hasUniqueKey(keyX));
+    REPORTER_ASSERT(reporter, !cache->hasUniqueKey(keyY));
+
+    // Looking Y up again is a miss that would have hit.
+    REPORTER_ASSERT(reporter, !cache->findAndRefUniqueResource(keyY));
+    GrResourceCache::CategoryStats stats = cache->getCategoryStats(Category::kBuffer);
+    REPORTER_ASSERT(reporter, stats.fHits == 6);
+    REPORTER_ASSERT(reporter, stats.fPurges == 1);
+    REPORTER_ASSERT(reporter, stats.fWouldHaveHits == 1);
+    REPORTER_ASSERT(reporter, cache->getLookupMissCount() == 1);
+    REPORTER_ASSERT(reporter, cache->wouldHaveHitRate() == 1.f / 7);
+
+    // A category's limit purges its resources even when the cache is within its budget.
+    cache->setLimit(30000);
+    cache->setCategoryLimit(Category::kBuffer, 0);
+    REPORTER_ASSERT(reporter, !cache->hasUniqueKey(keyX));
+    REPORTER_ASSERT(reporter, cache->getCategoryStats(Category::kBuffer).fBudgetedBytes == 0);
+    REPORTER_ASSERT(reporter, cache->getCategoryStats(Category::kBuffer).fPurges == 2);
+}
+
+static void test_most_overdue_purge(skiatest::Reporter* reporter) {
+    Mock mock(30000);
+    GrResourceCache* cache = mock.cache();
+    GrGpu* gpu = mock.gpu();
+
+    skgpu::UniqueKey keys[3];
+    for (int i = 0; i < 3; ++i) {
+        make_unique_key<0>(&keys[i], i);
+        TestResource* resource = new TestResource(gpu, /*label=*/{}, skgpu::Budgeted::kYes, 10);
+        resource->resourcePriv().setUniqueKey(keys[i]);
+        resource->unref();
+    }
+
+    // X is used in frame 4, so it's due in frame 8. Y is used every frame through frame 5, so
+    // it's due in frame 6. Z is never used again, so it's been due since frame 1.
+    const skgpu::UniqueKey& keyX = keys[0];
+    const skgpu::UniqueKey& keyY = keys[1];
+    const skgpu::UniqueKey& keyZ = keys[2];
+    for (int frame = 1; frame <= 5; ++frame) {
+        cache->notifyFrameSubmitted();
+        if (frame == 4) {
+            SkSafeUnref(cache->findAndRefUniqueResource(keyX));
+        }
+        SkSafeUnref(cache->findAndRefUniqueResource(keyY));
+    }
+    for (int frame = 6; frame <= 9; ++frame) {
+        cache->notifyFrameSubmitted();
+    }
+
+    // In frame 9 all three are overdue, and they go in the order they were due, although Y was
+    // used more recently than X.
+    cache->setLimit(20);
+    REPORTER_ASSERT(reporter, !cache->hasUniqueKey(keyZ));
+    REPORTER_ASSERT(reporter, cache->hasUniqueKey(keyX) && cache->hasUniqueKey(keyY));
+    cache->setLimit(10);
+    REPORTER_ASSERT(reporter, cache->hasUniqueKey(keyX));
+    REPORTER_ASSERT(reporter, !cache->hasUniqueKey(keyY));
+    cache->setLimit(0);
+    REPORTER_ASSERT(reporter, cache->getResourceCount() == 0);
+}
+
 static void test_time_purge(skiatest::Reporter* reporter) {
     Mock mock(1000000);
     auto dContext = mock.dContext();
@@ -1681,12 +1831,15 @@ DEF_GANESH_TEST(ResourceCacheMisc, reporter, /* options */, CtsEnforcement::kApi
     test_purge_invalidated(reporter);
     test_cache_chained_purge(reporter);
     test_timestamp_wrap(reporter);
+    test_predictive_purge(reporter);
+    test_most_overdue_purge(reporter);
     test_time_purge(reporter);
     test_partial_purge(reporter);
     test_custom_data(reporter);
     test_abandoned(reporter);
     test_tags(reporter);
     test_free_texture_messages(reporter);
+    test_memory_report(reporter);
 }
 
 // This simulates a portion of Chrome's context abandonment processing.
@@ -0,0 +1,224 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkData.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkString.h"
+#include "include/utils/SkEventTracer.h"
+#include "include/utils/SkRingBufferTracer.h"
+#include "include/utils/SkTraceEventPhase.h"
+#include "src/core/SkTraceEvent.h"
+#include "tests/Test.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Reads the fields of one protobuf message. Only varint and length-delimited fields are expected.
+class ProtoReader {
+public:
+    ProtoReader(const uint8_t* data, size_t size) : fPtr(data), fEnd(data + size) {}
+
+    bool next(uint32_t* field, uint64_t* value, ProtoReader* message) {
+        uint64_t tag;
+        if (fPtr == fEnd || !this->readVarint(&tag)) {
+            return false;
+        }
+        *field = (uint32_t)(tag >> 3);
+        if (!this->readVarint(value)) {
+            return false;
+        }
+        if ((tag & 7) == 2) {
+            if (*value > (uint64_t)(fEnd - fPtr)) {
+                return false;
+            }
+            *message = ProtoReader(fPtr, *value);
+            fPtr += *value;
+        }
+        return true;
+    }
+
+    std::string str() const { return std::string((const char*)fPtr, fEnd - fPtr); }
+
+private:
+    bool readVarint(uint64_t* value) {
+        *value = 0;
+        for (int shift = 0; fPtr < fEnd && shift < 64; shift += 7) {
+            const uint8_t byte = *fPtr++;
+            *value |= (uint64_t)(byte & 0x7f) << shift;
+            if (!(byte & 0x80)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    const uint8_t* fPtr;
+    const uint8_t* fEnd;
+};
+
+struct TraceEvent {
+    uint64_t    fTrack;
+    uint64_t    fType;  // 1: begin, 2: end, 3: instant
+    std::string fName;
+};
+
+struct ParsedTrace {
+    std::vector<uint64_t>   fTracks;
+    std::vector<TraceEvent> fEvents;
+};
+
+ParsedTrace parse(const sk_sp<SkData>& data) {
+    ParsedTrace parsed;
+    if (!data) {
+        return parsed;
+    }
+    ProtoReader trace(data->bytes(), data->size());
+    uint32_t field;
+    uint64_t value;
+    ProtoReader packet(nullptr, 0);
+    while (trace.next(&field, &value, &packet)) {
+        ProtoReader child(nullptr, 0);
+        while (packet.next(&field, &value, &child)) {
+            if (field == 60) {  // TracePacket.track_descriptor
+                ProtoReader unused(nullptr, 0);
+                while (child.next(&field, &value, &unused)) {
+                    if (field == 1) {  // TrackDescriptor.uuid
+                        parsed.fTracks.push_back(value);
+                    }
+                }
+            } else if (field == 11) {  // TracePacket.track_event
+                TraceEvent event = {};
+                ProtoReader str(nullptr, 0);
+                while (child.next(&field, &value, &str)) {
+                    if (field == 9) {
+                        event.fType = value;
+                    } else if (field == 11) {
+                        event.fTrack = value;
+                    } else if (field == 23) {
+                        event.fName = str.str();
+                    }
+                }
+                parsed.fEvents.push_back(event);
+            }
+        }
+    }
+    return parsed;
+}
+
+SkEventTracer::Handle add_event(SkRingBufferTracer* tracer, char phase, const uint8_t* category,
+                                const char* name, uint8_t flags = TRACE_EVENT_FLAG_NONE) {
+    return tracer->addTraceEvent(phase, category, name, 0, 0, nullptr, nullptr, nullptr, flags);
+}
+
+}  // namespace
+
+DEF_TEST(RingBufferTracer_Categories, r) {
+    SkRingBufferTracer tracer;
+    const uint8_t* skia = tracer.getCategoryGroupEnabled("skia");
+    const uint8_t* verbose =
+            tracer.getCategoryGroupEnabled(TRACE_CATEGORY_PREFIX "skia.shaders");
+    REPORTER_ASSERT(r, !*skia && !*verbose);
+    REPORTER_ASSERT(r, skia == tracer.getCategoryGroupEnabled("skia"));
+    REPORTER_ASSERT(r, !strcmp(tracer.getCategoryGroupName(skia), "skia"));
+
+    tracer.setEnabled(true);
+    REPORTER_ASSERT(r, *skia && !*verbose);
+    REPORTER_ASSERT(r, *tracer.getCategoryGroupEnabled("skia.gpu"));
+
+    tracer.setEnabled(false);
+    REPORTER_ASSERT(r, !*skia);
+    REPORTER_ASSERT(r, !tracer.exportPerfettoTrace()->size());
+
+    SkRingBufferTracer::Options options;
+    options.fIncludeDisabledByDefault = true;
+    SkRingBufferTracer verboseTracer(options);
+    verboseTracer.setEnabled(true);
+    REPORTER_ASSERT(r,
+            *verboseTracer.getCategoryGroupEnabled(TRACE_CATEGORY_PREFIX "skia.shaders"));
+}
+
+DEF_TEST(RingBufferTracer_Slices, r) {
+    SkRingBufferTracer tracer;
+    tracer.setEnabled(true);
+    const uint8_t* skia = tracer.getCategoryGroupEnabled("skia");
+
+    SkEventTracer::Handle frame = add_event(&tracer, TRACE_EVENT_PHASE_COMPLETE, skia, "frame");
+    SkEventTracer::Handle draw = add_event(&tracer, TRACE_EVENT_PHASE_COMPLETE, skia, "draw");
+    tracer.updateTraceEventDuration(skia, "draw", draw);
+    add_event(&tracer, TRACE_EVENT_PHASE_INSTANT, skia, "flush");
+    tracer.updateTraceEventDuration(skia, "frame", frame);
+    add_event(&tracer, TRACE_EVENT_PHASE_COMPLETE, skia, "unfinished");
+    add_event(&tracer, TRACE_EVENT_PHASE_COUNTER, skia, "counter");
+
+    ParsedTrace trace = parse(tracer.exportPerfettoTrace());
+    REPORTER_ASSERT(r, trace.fTracks.size() == 1);
+
+    const TraceEvent expected[] = {
+        {0, 1, "frame"},
+        {0, 1, "draw"},
+        {0, 2, ""},
+        {0, 3, "flush"},
+        {0, 2, ""},
+        {0, 1, "unfinished"},
+    };
+    REPORTER_ASSERT(r, trace.fEvents.size() == std::size(expected));
+    for (size_t i = 0; i < std::min(trace.fEvents.size(), std::size(expected)); ++i) {
+        REPORTER_ASSERT(r, trace.fEvents[i].fType == expected[i].fType);
+        REPORTER_ASSERT(r, trace.fEvents[i].fName == expected[i].fName,
+                        "%s", trace.fEvents[i].fName.c_str());
+        REPORTER_ASSERT(r, trace.fEvents[i].fTrack == trace.fTracks[0]);
+    }
+
+    tracer.clear();
+    REPORTER_ASSERT(r, parse(tracer.exportPerfettoTrace()).fEvents.empty());
+}
+
+DEF_TEST(RingBufferTracer_Wraparound, r) {
+    SkRingBufferTracer::Options options;
+    options.fEventsPerThread = 16;
+    SkRingBufferTracer tracer(options);
+    tracer.setEnabled(true);
+    const uint8_t* skia = tracer.getCategoryGroupEnabled("skia");
+
+    for (int i = 0; i < 40; ++i) {
+        SkString name = SkStringPrintf("event%d", i);
+        add_event(&tracer, TRACE_EVENT_PHASE_INSTANT, skia, name.c_str(), TRACE_EVENT_FLAG_COPY);
+    }
+
+    // Only the last 16 remain.
+    ParsedTrace trace = parse(tracer.exportPerfettoTrace());
+    REPORTER_ASSERT(r, trace.fEvents.size() == 16);
+    if (!trace.fEvents.empty()) {
+        REPORTER_ASSERT(r, trace.fEvents.front().fName == "event24");
+        REPORTER_ASSERT(r, trace.fEvents.back().fName == "event39");
+    }
+}
+
+DEF_TEST(RingBufferTracer_Threads, r) {
+    SkRingBufferTracer tracer;
+    tracer.setEnabled(true);
+    const uint8_t* skia = tracer.getCategoryGroupEnabled("skia");
+
+    add_event(&tracer, TRACE_EVENT_PHASE_INSTANT, skia, "main");
+    std::thread([&] { add_event(&tracer, TRACE_EVENT_PHASE_INSTANT, skia, "worker"); }).join();
+    // The exited thread's ring is reused, dropping its events.
+    std::thread([&] { add_event(&tracer, TRACE_EVENT_PHASE_INSTANT, skia, "next"); }).join();
+
+    ParsedTrace trace = parse(tracer.exportPerfettoTrace());
+    REPORTER_ASSERT(r, trace.fTracks.size() == 2);
+    REPORTER_ASSERT(r, trace.fEvents.size() == 2);
+    for (const TraceEvent& event : trace.fEvents) {
+        REPORTER_ASSERT(r, event.fName == "main" || event.fName == "next");
+    }
+}
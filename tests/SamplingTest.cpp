@@ -5,12 +5,19 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkBitmap.h"
+#include "include/core/SkBlendMode.h"
 #include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkImageInfo.h"
+#include "include/core/SkMatrix.h"
+#include "include/core/SkPaint.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkSamplingOptions.h"
+#include "include/core/SkShader.h"
 #include "include/core/SkSurface.h"
+#include "include/core/SkTileMode.h"
 #include "include/core/SkTypes.h"
 #include "src/base/SkRandom.h"
 #include "src/core/SkSamplingPriv.h"
@@ -18,6 +25,8 @@
 #include "tools/DecodeUtils.h"
 #include "tools/ToolUtils.h"
 
+#include <algorithm>
+#include <cstdlib>
 #include <initializer_list>
 
 // In general, sampling under identity matrix should not affect the pixels. However,
@@ -62,3 +71,49 @@ DEF_TEST(sampling_with_identity_matrix, r) {
         }
     }
 }
+
+static SkBitmap draw_scaled(const sk_sp<SkImage>& image, SkTileMode tm,
+                            const SkSamplingOptions& sampling, SkColorType ct) {
+    SkBitmap dst;
+    dst.allocPixels(SkImageInfo::Make(200, 200, ct, kPremul_SkAlphaType));
+    SkPaint paint;
+    SkMatrix lm = SkMatrix::Scale(1.7f, 1.3f);
+    lm.postTranslate(-30.25f, -20.5f);
+    paint.setShader(image->makeShader(tm, tm, sampling, &lm));
+    paint.setBlendMode(SkBlendMode::kSrc);
+    SkCanvas(dst).drawPaint(paint);
+
+    SkBitmap n32;
+    n32.allocN32Pixels(dst.width(), dst.height());
+    SkAssertResult(dst.readPixels(n32.pixmap()));
+    return n32;
+}
+
+// Cubic sampling of 8888 images with clamp or repeat tiling runs in the lowp pipeline when the
+// destination allows it. It should match the highp pipeline used for F16 destinations to within
+// rounding.
+DEF_TEST(sampling_cubic_lowp_matches_highp, r) {
+    auto src = ToolUtils::GetResourceAsImage("images/mandrill_128.png");
+    if (!src) {
+        return;
+    }
+    for (SkCubicResampler cubic : {SkCubicResampler::Mitchell(), SkCubicResampler::CatmullRom()}) {
+        for (SkTileMode tm : {SkTileMode::kClamp, SkTileMode::kRepeat}) {
+            SkBitmap lowp  = draw_scaled(src, tm, SkSamplingOptions(cubic), kN32_SkColorType);
+            SkBitmap highp = draw_scaled(src, tm, SkSamplingOptions(cubic), kRGBA_F16_SkColorType);
+
+            int maxDiff = 0;
+            for (int y = 0; y < lowp.height(); ++y) {
+                for (int x = 0; x < lowp.width(); ++x) {
+                    SkColor a = lowp.getColor(x, y),
+                            b = highp.getColor(x, y);
+                    for (int shift = 0; shift < 32; shift += 8) {
+                        maxDiff = std::max(maxDiff, std::abs((int)((a >> shift) & 0xFF) -
+                                                             (int)((b >> shift) & 0xFF)));
+                    }
+                }
+            }
+            REPORTER_ASSERT(r, maxDiff <= 2, "tile mode %d differs by %d", (int)tm, maxDiff);
+        }
+    }
+}
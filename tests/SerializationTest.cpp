@@ -1005,3 +1005,59 @@ DEF_TEST(ReadBuffer_empty, reporter) {
     REPORTER_ASSERT(reporter, data->size() == 0);
     REPORTER_ASSERT(reporter, reader.readInt() == 321);
 }
+
+DEF_TEST(ReadBuffer_trusted, reporter) {
+    SkBinaryWriteBuffer writer({});
+    writer.writeBool(true);
+    writer.writeInt(7);
+    size_t size = writer.bytesWritten();
+    SkAutoMalloc storage(size);
+    writer.writeToMemory(storage.get());
+    const uint64_t checksum = SkDeserialProcs::Checksum(storage.get(), size);
+    REPORTER_ASSERT(reporter, checksum != 0);
+
+    SkReadBuffer reader(storage.get(), size);
+    REPORTER_ASSERT(reporter, !reader.trustIfChecksumMatches(0));
+    REPORTER_ASSERT(reporter, !reader.trustIfChecksumMatches(checksum + 1));
+    REPORTER_ASSERT(reporter, !reader.isTrusted());
+    REPORTER_ASSERT(reporter, reader.trustIfChecksumMatches(checksum));
+    REPORTER_ASSERT(reporter, reader.readBool());
+    REPORTER_ASSERT(reporter, reader.checkInt(0, 10) == 7);
+    REPORTER_ASSERT(reporter, reader.isValid());
+    // Bounds are still checked.
+    (void)reader.readInt();
+    REPORTER_ASSERT(reporter, !reader.isValid());
+}
+
+DEF_TEST(Serialization_TrustedChecksum, reporter) {
+    sk_sp<SkImageFilter> filter = SkImageFilters::DropShadow(
+            2, 3, 4, 4, SK_ColorBLACK, SkImageFilters::Blur(3, 3, nullptr));
+    sk_sp<SkData> filterData = filter->serialize();
+
+    SkDeserialProcs procs;
+    procs.fTrustedChecksum = SkDeserialProcs::Checksum(filterData->data(), filterData->size());
+    sk_sp<SkImageFilter> trusted =
+            SkImageFilter::Deserialize(filterData->data(), filterData->size(), &procs);
+    REPORTER_ASSERT(reporter, trusted);
+    REPORTER_ASSERT(reporter, trusted && trusted->serialize()->equals(filterData.get()));
+
+    SkPictureRecorder recorder;
+    SkCanvas* canvas = recorder.beginRecording(64, 64);
+    SkPaint paint;
+    paint.setImageFilter(filter);
+    canvas->drawRect({8, 8, 40, 40}, paint);
+    canvas->drawPath(SkPath::Circle(32, 32, 10), SkPaint());
+    sk_sp<SkData> pictureData = recorder.finishRecordingAsPicture()->serialize();
+
+    procs.fTrustedChecksum = SkDeserialProcs::Checksum(pictureData->data(), pictureData->size());
+    sk_sp<SkPicture> picture = SkPicture::MakeFromData(pictureData.get(), &procs);
+    REPORTER_ASSERT(reporter, picture);
+    REPORTER_ASSERT(reporter, picture && picture->approximateOpCount() == 2);
+
+    // Once changed, the data no longer matches its checksum and is read with the usual checks.
+    SkAutoMalloc storage(pictureData->size());
+    memcpy(storage.get(), pictureData->data(), pictureData->size());
+    REPORTER_ASSERT(reporter, SkPicture::MakeFromData(storage.get(), pictureData->size(), &procs));
+    static_cast<uint8_t*>(storage.get())[pictureData->size() - 1] ^= 0xFF;
+    REPORTER_ASSERT(reporter, !SkPicture::MakeFromData(storage.get(), pictureData->size(), &procs));
+}
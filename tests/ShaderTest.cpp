@@ -13,6 +13,7 @@
 #include "include/core/SkColor.h"
 #include "include/core/SkColorType.h"
 #include "include/core/SkData.h"
+#include "include/core/SkGraphics.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkMatrix.h"
@@ -88,6 +89,50 @@ DEF_TEST(Shader_isAImage, reporter) {
     check_isaimage(reporter, shader1.get(), W, H, tmx, tmy, localM);
 }
 
+static SkBitmap draw_noise(const sk_sp<SkShader>& shader, int size) {
+    SkBitmap bm;
+    bm.allocN32Pixels(size, size);
+    SkPaint paint;
+    paint.setShader(shader);
+    paint.setBlendMode(SkBlendMode::kSrc);
+    SkCanvas(bm).drawPaint(paint);
+    return bm;
+}
+
+// Drawing stitched noise from a cached tile matches shading it directly over the first tile, and
+// repeats that tile everywhere else.
+DEF_SERIAL_TEST(PerlinNoise_RasterTileCache, reporter) {
+    constexpr int kTile = 48;
+    constexpr int kSize = 4 * kTile;
+    const SkISize tileSize = {kTile, kTile};
+    const sk_sp<SkShader> shaders[] = {
+        SkShaders::MakeFractalNoise(0.05f, 0.07f, 3, 2.f, &tileSize),
+        SkShaders::MakeTurbulence(0.1f, 0.05f, 4, 7.f, &tileSize),
+    };
+
+    for (const sk_sp<SkShader>& shader : shaders) {
+        SkGraphics::SetRasterNoiseTileCache(false);
+        SkBitmap expected = draw_noise(shader, kSize);
+        SkGraphics::SetRasterNoiseTileCache(true);
+        SkBitmap actual = draw_noise(shader, kSize);
+
+        for (int y = 0; y < kTile; ++y) {
+            for (int x = 0; x < kTile; ++x) {
+                REPORTER_ASSERT(reporter, expected.getColor(x, y) == actual.getColor(x, y),
+                                "(%d, %d)", x, y);
+            }
+        }
+        for (int y = 0; y < kSize; ++y) {
+            for (int x = 0; x < kSize; ++x) {
+                REPORTER_ASSERT(reporter,
+                                actual.getColor(x, y) == actual.getColor(x % kTile, y % kTile),
+                                "(%d, %d)", x, y);
+            }
+        }
+    }
+    SkGraphics::SetRasterNoiseTileCache(false);
+}
+
 // Make sure things are ok with just a single leg.
 DEF_TEST(ComposeShaderSingle, reporter) {
     SkBitmap srcBitmap;
@@ -0,0 +1,115 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkData.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkPicture.h"
+#include "include/core/SkPictureRecorder.h"
+#include "include/core/SkPixelRef.h"
+#include "include/core/SkPixmap.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkSerialProcs.h"
+#include "include/utils/SkSharedMemory.h"
+#include "tests/Test.h"
+
+#include <cstring>
+
+DEF_TEST(SharedMemory_Data, r) {
+    if (!SkSharedMemory::IsSupported()) {
+        REPORTER_ASSERT(r, !SkSharedMemory::MakeData(16));
+        return;
+    }
+
+    sk_sp<SkData> data = SkSharedMemory::MakeData(1000);
+    REPORTER_ASSERT(r, data && data->size() == 1000);
+    auto bytes = static_cast<uint8_t*>(data->writable_data());
+    REPORTER_ASSERT(r, bytes[0] == 0 && bytes[999] == 0);
+    memset(bytes, 0x5a, 1000);
+
+    size_t offset;
+    REPORTER_ASSERT(r, SkSharedMemory::FindFD(bytes + 10, 20, &offset) >= 0);
+    REPORTER_ASSERT(r, offset == 10);
+    REPORTER_ASSERT(r, SkSharedMemory::FindFD(bytes + 990, 20, &offset) < 0);
+    const uint8_t heap[4] = {};
+    REPORTER_ASSERT(r, SkSharedMemory::FindFD(heap, sizeof(heap), &offset) < 0);
+
+    // Mapping the descriptor again (as another process would) shares the same memory.
+    const int fd = SkSharedMemory::FindFD(bytes, 1000, &offset);
+    sk_sp<SkData> mapped = SkSharedMemory::MapData(fd);
+    REPORTER_ASSERT(r, mapped && mapped->size() >= 1000);
+    REPORTER_ASSERT(r, mapped->bytes() != data->bytes());
+    REPORTER_ASSERT(r, 0 == memcmp(mapped->data(), bytes, 1000));
+    bytes[500] = 7;
+    REPORTER_ASSERT(r, mapped->bytes()[500] == 7);
+
+    // The mapping has its own descriptor, so it outlives the original memory.
+    const int mappedFD = SkSharedMemory::FindFD(mapped->data(), 1000, &offset);
+    REPORTER_ASSERT(r, mappedFD >= 0 && mappedFD != fd);
+    data.reset();
+    REPORTER_ASSERT(r, mapped->bytes()[500] == 7);
+}
+
+DEF_TEST(SharedMemory_SerializeImages, r) {
+    if (!SkSharedMemory::IsSupported()) {
+        return;
+    }
+
+    const SkImageInfo info = SkImageInfo::MakeN32Premul(64, 32);
+    SkBitmap bitmap;
+    bitmap.setInfo(info);
+    bitmap.setPixelRef(SkSharedMemory::MakePixelRef(info, info.minRowBytes()), 0, 0);
+    REPORTER_ASSERT(r, bitmap.getPixels());
+    bitmap.eraseColor(SK_ColorBLUE);
+    bitmap.erase(SK_ColorRED, SkIRect::MakeXYWH(8, 4, 16, 8));
+    bitmap.setImmutable();
+    sk_sp<SkImage> shared = bitmap.asImage();
+
+    SkBitmap heapBitmap;
+    heapBitmap.allocPixels(info);
+    heapBitmap.eraseColor(SK_ColorGREEN);
+    sk_sp<SkImage> unshared = heapBitmap.asImage();
+
+    SkPictureRecorder recorder;
+    SkCanvas* canvas = recorder.beginRecording(200, 100);
+    canvas->drawImage(shared, 0, 0);
+    canvas->drawImage(shared, 70, 0);
+    canvas->drawImage(unshared, 140, 0);
+    sk_sp<SkPicture> picture = recorder.finishRecordingAsPicture();
+
+    SkSharedMemorySerialContext serialCtx;
+    SkSerialProcs serialProcs;
+    serialProcs.fImageProc = SkSharedMemorySerialContext::SerializeImage;
+    serialProcs.fImageCtx = &serialCtx;
+    sk_sp<SkData> skp = picture->serialize(&serialProcs);
+    REPORTER_ASSERT(r, skp);
+    REPORTER_ASSERT(r, serialCtx.fFDs.size() == 1);
+
+    SkSharedMemoryDeserialContext deserialCtx;
+    deserialCtx.fFDs = serialCtx.fFDs;
+    SkDeserialProcs deserialProcs;
+    deserialProcs.fImageProc = SkSharedMemoryDeserialContext::DeserializeImage;
+    deserialProcs.fImageCtx = &deserialCtx;
+    sk_sp<SkPicture> copy = SkPicture::MakeFromData(skp.get(), &deserialProcs);
+    REPORTER_ASSERT(r, copy);
+    REPORTER_ASSERT(r, deserialCtx.fMappings.size() == 1 && deserialCtx.fMappings[0]);
+
+    SkBitmap expected, actual;
+    expected.allocN32Pixels(200, 100);
+    actual.allocN32Pixels(200, 100);
+    expected.eraseColor(SK_ColorTRANSPARENT);
+    actual.eraseColor(SK_ColorTRANSPARENT);
+    SkCanvas(expected).drawPicture(picture);
+    SkCanvas(actual).drawPicture(copy);
+    for (int y = 0; y < 100; ++y) {
+        REPORTER_ASSERT(r, 0 == memcmp(expected.getAddr32(0, y), actual.getAddr32(0, y),
+                                       expected.rowBytes()), "row %d", y);
+    }
+}
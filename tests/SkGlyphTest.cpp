@@ -28,9 +28,11 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <initializer_list>
 #include <iterator>
 #include <optional>
+#include <vector>
 
 DEF_TEST(SkGlyphRectBasic, reporter) {
     using namespace skglyph;
@@ -192,6 +194,66 @@ DEF_TEST(SkGlyph_SendWithImage, reporter) {
     REPORTER_ASSERT(reporter, !dstGlyph->setImageHasBeenCalled());
 }
 
+DEF_TEST(SkGlyph_SendWithRunLengthEncodedImage, reporter) {
+    SkArenaAlloc alloc{256};
+    SkGlyph srcGlyph{SkPackedGlyphID{(SkGlyphID)12}};
+    SkGlyphTestPeer::SetGlyph1(&srcGlyph);
+
+    // Runs of every length around the limits, and literals between them.
+    uint8_t imageData[9][8];
+    uint8_t* pixels = &imageData[0][0];
+    size_t i = 0;
+    for (size_t run : {1, 2, 3, 1, 30, 1, 2}) {
+        for (size_t j = 0; j < run; ++j, ++i) {
+            pixels[i] = static_cast<uint8_t>(run);
+        }
+    }
+    for (; i < sizeof(imageData); ++i) {
+        pixels[i] = static_cast<uint8_t>(i);
+    }
+    srcGlyph.setImage(&alloc, imageData);
+
+    SkBinaryWriteBuffer writeBuffer({});
+    srcGlyph.flattenMetrics(writeBuffer);
+    srcGlyph.flattenImage(writeBuffer, /*runLengthEncode=*/true);
+    sk_sp<SkData> data = writeBuffer.snapshotAsData();
+
+    SkReadBuffer readBuffer{data->data(), data->size()};
+    std::optional<SkGlyph> dstGlyph = SkGlyph::MakeFromBuffer(readBuffer);
+    REPORTER_ASSERT(reporter, dstGlyph.has_value());
+    dstGlyph->addImageFromBuffer(readBuffer, &alloc, /*runLengthEncoded=*/true);
+    REPORTER_ASSERT(reporter, readBuffer.isValid());
+    REPORTER_ASSERT(reporter, readBuffer.available() == 0);
+    REPORTER_ASSERT(reporter, 0 == memcmp(imageData, dstGlyph->image(), sizeof(imageData)));
+
+    // An all zero mask, as between the strokes of most glyphs, takes a byte per run.
+    SkGlyph blankGlyph{SkPackedGlyphID{(SkGlyphID)12}};
+    SkGlyphTestPeer::SetGlyph1(&blankGlyph);
+    memset(imageData, 0, sizeof(imageData));
+    blankGlyph.setImage(&alloc, imageData);
+    SkBinaryWriteBuffer blankWriteBuffer({});
+    blankGlyph.flattenImage(blankWriteBuffer, /*runLengthEncode=*/true);
+    REPORTER_ASSERT(reporter, blankWriteBuffer.bytesWritten() < sizeof(imageData) / 4);
+
+    // Encoded data that is too short or too long for the glyph is an error.
+    for (const std::vector<uint8_t>& bad : {std::vector<uint8_t>{128, 0},
+                                            std::vector<uint8_t>{255, 0},
+                                            std::vector<uint8_t>{255},
+                                            std::vector<uint8_t>{5, 1}}) {
+        SkBinaryWriteBuffer badWriteBuffer({});
+        srcGlyph.flattenMetrics(badWriteBuffer);
+        badWriteBuffer.writeByteArray(bad.data(), bad.size());
+        data = badWriteBuffer.snapshotAsData();
+
+        SkReadBuffer badReadBuffer{data->data(), data->size()};
+        dstGlyph = SkGlyph::MakeFromBuffer(badReadBuffer);
+        REPORTER_ASSERT(reporter, dstGlyph.has_value());
+        dstGlyph->addImageFromBuffer(badReadBuffer, &alloc, /*runLengthEncoded=*/true);
+        REPORTER_ASSERT(reporter, !badReadBuffer.isValid());
+        REPORTER_ASSERT(reporter, !dstGlyph->setImageHasBeenCalled());
+    }
+}
+
 DEF_TEST(SkGlyph_SendWithPath, reporter) {
     SkArenaAlloc alloc{256};
     SkGlyph srcGlyph{SkPackedGlyphID{(SkGlyphID)12}};
@@ -5,6 +5,7 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkGraphics.h"
 #include "include/private/base/SkTo.h"
 #include "src/base/SkHalf.h"
 #include "src/base/SkUtils.h"
@@ -16,10 +17,14 @@
 #include "tests/Test.h"
 
 #include <cmath>
+#include <cstring>
 #include <numeric>
 
 using namespace skia_private;
 
+extern bool gForceHighPrecisionRasterPipeline;
+extern bool gDisableRasterPipelineStageFusion;
+
 DEF_TEST(SkRasterPipeline, r) {
     // Build and run a simple pipeline to exercise SkRasterPipeline,
     // drawing 50% transparent blue over opaque red in half-floats.
@@ -3450,3 +3455,185 @@ DEF_TEST(SkRasterPipeline_stack_rewind, r) {
         stack.validate(r);
     }
 }
+
+DEF_SERIAL_TEST(SkRasterPipeline_stageFusion, r) {
+    // Fused stages must produce exactly the same pixels as the stages they replace.
+    constexpr int kW = 21, kH = 3;  // An odd width exercises the tail of each row.
+    uint32_t src[kW * kH], dst[kW * kH];
+    uint32_t seed = 7;
+    auto next = [&] {
+        seed = seed * 1664525 + 1013904223;
+        return seed >> 24;
+    };
+    for (int i = 0; i < kW * kH; i++) {
+        uint32_t sa = next(), da = next();
+        src[i] = (sa << 24) | ((next() * sa / 255) << 16) | ((next() * sa / 255) << 8) |
+                 (next() * sa / 255);
+        dst[i] = (da << 24) | ((next() * da / 255) << 16) | ((next() * da / 255) << 8) |
+                 (next() * da / 255);
+    }
+
+    const float matrix[6] = {0.7f, 0.2f, 1.5f, -0.1f, 0.9f, 0.25f};
+    SkRasterPipeline_GatherCtx gather;
+    gather.pixels = src;
+    gather.stride = kW;
+    gather.width  = kW;
+    gather.height = kH;
+
+    using Op = SkRasterPipelineOp;
+    auto run = [&](int pipeline, uint32_t* out) {
+        memcpy(out, dst, sizeof(dst));
+        SkRasterPipeline_MemoryCtx srcCtx = {src, kW},
+                                   dstCtx = {out, kW};
+        SkRasterPipeline_<256> p;
+        switch (pipeline) {
+            case 0:
+                p.append(Op::load_8888, &srcCtx);
+                p.append(Op::load_8888_dst, &dstCtx);
+                break;
+            case 1:
+                p.append(Op::load_8888, &srcCtx);
+                p.append(Op::swap_rb);
+                p.append(Op::load_8888_dst, &dstCtx);
+                break;
+            case 2:
+                p.append(Op::seed_shader);
+                p.append(Op::matrix_2x3, const_cast<float*>(matrix));
+                p.append(Op::bilerp_clamp_8888, &gather);
+                p.append(Op::load_8888_dst, &dstCtx);
+                break;
+        }
+        p.append(Op::srcover);
+        p.append(Op::store_8888, &dstCtx);
+        p.run(0, 0, kW, kH);
+    };
+
+    const bool oldForceHighp = gForceHighPrecisionRasterPipeline;
+    for (bool highp : {false, true}) {
+        gForceHighPrecisionRasterPipeline = highp;
+        for (int pipeline = 0; pipeline < 3; pipeline++) {
+            uint32_t fused[kW * kH], unfused[kW * kH];
+            run(pipeline, fused);
+            gDisableRasterPipelineStageFusion = true;
+            run(pipeline, unfused);
+            gDisableRasterPipelineStageFusion = false;
+            for (int i = 0; i < kW * kH; i++) {
+                if (fused[i] != unfused[i]) {
+                    ERRORF(r, "%s pipeline %d pixel %d: fused %08x, unfused %08x",
+                           highp ? "highp" : "lowp", pipeline, i, fused[i], unfused[i]);
+                    break;
+                }
+            }
+        }
+    }
+    gForceHighPrecisionRasterPipeline = oldForceHighp;
+}
+
+DEF_SERIAL_TEST(SkRasterPipeline_skslStageFusion, r) {
+    // SkSL pushes an operand and consumes it with an arithmetic op; the fused pairs must match.
+    using Op = SkRasterPipelineOp;
+    constexpr int N = SkRasterPipeline_kMaxStride_highp;
+    const int stride = SkOpts::raster_pipeline_highp_stride;
+    static const Op kCopyUniforms[] = {Op::copy_uniform, Op::copy_2_uniforms,
+                                       Op::copy_3_uniforms, Op::copy_4_uniforms};
+    static const Op kCopySlots[] = {Op::copy_slot_unmasked, Op::copy_2_slots_unmasked,
+                                    Op::copy_3_slots_unmasked, Op::copy_4_slots_unmasked};
+    static const Op kArithmetic[4][4] = {
+            {Op::add_float, Op::add_2_floats, Op::add_3_floats, Op::add_4_floats},
+            {Op::sub_float, Op::sub_2_floats, Op::sub_3_floats, Op::sub_4_floats},
+            {Op::mul_float, Op::mul_2_floats, Op::mul_3_floats, Op::mul_4_floats},
+            {Op::div_float, Op::div_2_floats, Op::div_3_floats, Op::div_4_floats},
+    };
+    auto apply = [](int arithmetic, float x, float y) {
+        switch (arithmetic) {
+            case 0:  return x + y;
+            case 1:  return x - y;
+            case 2:  return x * y;
+            default: return x / y;
+        }
+    };
+
+    // The pushed operand goes in slots 4-7, right after the operand it's combined with, as on the
+    // SkSL temp stack. Slots 8-11 hold a variable to push.
+    alignas(64) float slots[12 * N];
+    const float uniforms[4] = {0.5f, -2.f, 3.25f, 8.f};
+    for (bool fromUniforms : {false, true}) {
+        for (int arithmetic = 0; arithmetic < 4; ++arithmetic) {
+            for (int width = 1; width <= 4; ++width) {
+                for (bool fused : {true, false}) {
+                    for (int i = 0; i < 12 * stride; ++i) {
+                        slots[i] = (i % 7) * 1.5f + 1.f;
+                    }
+                    float* dst = &slots[(4 - width) * stride];
+                    float expected[4 * N];
+                    for (int slot = 0; slot < width; ++slot) {
+                        for (int lane = 0; lane < stride; ++lane) {
+                            const float y = fromUniforms ? uniforms[slot]
+                                                         : slots[(8 + slot) * stride + lane];
+                            expected[slot * stride + lane] =
+                                    apply(arithmetic, dst[slot * stride + lane], y);
+                        }
+                    }
+
+                    SkArenaAlloc alloc(/*firstHeapAllocation=*/256);
+                    SkRasterPipeline p(&alloc);
+                    p.append(Op::set_base_pointer, &slots[0]);
+                    if (fromUniforms) {
+                        auto* ctx = alloc.make<SkRasterPipeline_UniformCtx>();
+                        ctx->dst = reinterpret_cast<int32_t*>(&slots[4 * stride]);
+                        ctx->src = reinterpret_cast<const int32_t*>(uniforms);
+                        p.append(kCopyUniforms[width - 1], ctx);
+                    } else {
+                        SkRasterPipeline_BinaryOpCtx ctx;
+                        ctx.dst = 4 * stride * sizeof(float);
+                        ctx.src = 8 * stride * sizeof(float);
+                        p.append(kCopySlots[width - 1], SkRPCtxUtils::Pack(ctx, &alloc));
+                    }
+                    p.append(kArithmetic[arithmetic][width - 1], dst);
+
+                    gDisableRasterPipelineStageFusion = !fused;
+                    p.run(0, 0, 1, 1);
+                    gDisableRasterPipelineStageFusion = false;
+
+                    for (int i = 0; i < width * stride; ++i) {
+                        if (dst[i] != expected[i]) {
+                            ERRORF(r, "%s %s width %d value %d: expected %g, found %g",
+                                   fused ? "fused" : "unfused",
+                                   SkRasterPipeline::GetOpName(kArithmetic[arithmetic][0]),
+                                   width, i, expected[i], dst[i]);
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+DEF_TEST(SkRasterPipeline_compileCache, r) {
+    // Two pipelines with the same ops but different contexts share a cached program.
+    uint32_t first[5]  = {0xff0000ff, 0xff00ff00, 0xffff0000, 0x80000080, 0x00000000},
+             second[5] = {0xff00ff00, 0xff0000ff, 0x80008000, 0xffff0000, 0xff123456};
+    auto swap_rb = [](uint32_t c) {
+        return (c & 0xff00ff00) | ((c & 0xff) << 16) | ((c >> 16) & 0xff);
+    };
+    uint32_t want[2][5];
+    for (int i = 0; i < 5; i++) {
+        want[0][i] = swap_rb(first[i]);
+        want[1][i] = swap_rb(second[i]);
+    }
+
+    const uint64_t hits = SkGraphics::GetRasterPipelineCacheHitCount();
+    for (uint32_t* pixels : {first, second}) {
+        SkRasterPipeline_MemoryCtx ctx = {pixels, 0};
+        SkRasterPipeline_<256> p;
+        p.append(SkRasterPipelineOp::load_8888, &ctx);
+        p.append(SkRasterPipelineOp::swap_rb);
+        p.append(SkRasterPipelineOp::store_8888, &ctx);
+        p.compile()(0, 0, 5, 1);
+    }
+    REPORTER_ASSERT(r, SkGraphics::GetRasterPipelineCacheHitCount() > hits);
+    REPORTER_ASSERT(r, SkGraphics::GetRasterPipelineCacheCountUsed() > 0);
+    REPORTER_ASSERT(r, 0 == memcmp(first, want[0], sizeof(first)));
+    REPORTER_ASSERT(r, 0 == memcmp(second, want[1], sizeof(second)));
+}
@@ -303,6 +303,59 @@ DEF_GANESH_TEST_FOR_RENDERING_CONTEXTS(SkRemoteGlyphCache_StrikeSerialization,
     discardableManager->unlockAndDeleteAll();
 }
 
+DEF_GANESH_TEST_FOR_RENDERING_CONTEXTS(SkRemoteGlyphCache_StrikeSerializationRunLengthEncoded,
+                                       reporter,
+                                       ctxInfo,
+                                       CtsEnforcement::kNever) {
+    auto dContext = ctxInfo.directContext();
+    sk_sp<DiscardableManager> discardableManager = sk_make_sp<DiscardableManager>();
+    SkStrikeServer server(discardableManager.get());
+    server.setRunLengthEncodeImages(true);
+    SkStrikeClient client(discardableManager, false);
+    const SkPaint paint;
+
+    // Server.
+    auto serverTypeface = ToolUtils::CreateTestTypeface("monospace", SkFontStyle());
+    const SkTypefaceID serverTypefaceID = serverTypeface->uniqueID();
+
+    int glyphCount = 10;
+    auto serverBlob = buildTextBlob(serverTypeface, glyphCount, 20);
+    auto props = FindSurfaceProps(dContext);
+    auto writeStrikeData = [&](SkStrikeServer* strikeServer, std::vector<uint8_t>* data) {
+        std::unique_ptr<SkCanvas> analysisCanvas = strikeServer->makeAnalysisCanvas(
+                100, 30, props, nullptr, dContext->supportsDistanceFieldText(),
+                !dContext->priv().caps()->disablePerspectiveSDFText());
+        analysisCanvas->drawTextBlob(serverBlob.get(), 0, 0, paint);
+        strikeServer->writeStrikeData(data);
+    };
+    std::vector<uint8_t> serverStrikeData;
+    writeStrikeData(&server, &serverStrikeData);
+
+    // The same glyphs take more space when not encoded.
+    {
+        sk_sp<DiscardableManager> plainDiscardableManager = sk_make_sp<DiscardableManager>();
+        SkStrikeServer plainServer(plainDiscardableManager.get());
+        std::vector<uint8_t> plainStrikeData;
+        writeStrikeData(&plainServer, &plainStrikeData);
+        REPORTER_ASSERT(reporter, serverStrikeData.size() < plainStrikeData.size());
+        plainDiscardableManager->unlockAndDeleteAll();
+    }
+
+    // Client.
+    REPORTER_ASSERT(reporter,
+                    client.readStrikeData(serverStrikeData.data(), serverStrikeData.size()));
+    auto clientTypeface = client.retrieveTypefaceUsingServerIDForTest(serverTypefaceID);
+    auto clientBlob = buildTextBlob(clientTypeface, glyphCount, 20);
+
+    SkBitmap expected = RasterBlob(serverBlob, 100, 30, paint, dContext);
+    SkBitmap actual = RasterBlob(clientBlob, 100, 30, paint, dContext);
+    compare_blobs(expected, actual, reporter);
+    REPORTER_ASSERT(reporter, !discardableManager->hasCacheMiss());
+
+    // Must unlock everything on termination, otherwise valgrind complains about memory leaks.
+    discardableManager->unlockAndDeleteAll();
+}
+
 static void use_padding_options(GrContextOptions* options) {
     options->fSupportBilerpFromGlyphAtlas = true;
 }
@@ -306,3 +306,58 @@ DEF_TEST(ResourceCache_purge, reporter) {
         }
     }
 }
+
+static bool test_rec_visitor(const SkResourceCache::Rec&, void*) { return true; }
+
+/*
+ *  Test that a sharded global cache finds what was added and keeps each shard in its budget.
+ */
+DEF_SERIAL_TEST(ResourceCache_shards, reporter) {
+    constexpr int kShardCount = 4;
+    constexpr size_t kByteLimit = 64 * 1024;
+    const int prevShardCount = SkResourceCache::SetShardCount(kShardCount);
+    const size_t prevByteLimit = SkResourceCache::SetTotalByteLimit(kByteLimit);
+    REPORTER_ASSERT(reporter, SkResourceCache::GetShardCount() == kShardCount);
+
+    uint64_t prevLookups = 0;
+    for (int i = 0; i < kShardCount; ++i) {
+        SkResourceCache::ShardStats stats = SkResourceCache::GetShardStats(i);
+        prevLookups += stats.fHitCount + stats.fMissCount;
+    }
+
+    int flags = 0;
+    for (int32_t data = 0; data < 8; ++data) {
+        auto rec = std::make_unique<TestRec>(0, data, &flags);
+        rec->fCanBePurged = true;
+        SkResourceCache::Add(rec.release());
+        REPORTER_ASSERT(reporter,
+                        SkResourceCache::Find(TestKey(0, data), test_rec_visitor, nullptr));
+    }
+    // Adding many more than fit pushes the first entries out.
+    for (int32_t data = 8; data < 1000; ++data) {
+        auto rec = std::make_unique<TestRec>(0, data, &flags);
+        rec->fCanBePurged = true;
+        SkResourceCache::Add(rec.release());
+    }
+    REPORTER_ASSERT(reporter, !SkResourceCache::Find(TestKey(0, 0), test_rec_visitor, nullptr));
+
+    uint64_t lookups = 0;
+    size_t bytesUsed = 0;
+    for (int i = 0; i < kShardCount; ++i) {
+        SkResourceCache::ShardStats stats = SkResourceCache::GetShardStats(i);
+        REPORTER_ASSERT(reporter, stats.fByteLimit == kByteLimit / kShardCount);
+        REPORTER_ASSERT(reporter, stats.fBytesUsed <= stats.fByteLimit);
+        REPORTER_ASSERT(reporter, stats.fCount > 0);
+        lookups += stats.fHitCount + stats.fMissCount;
+        bytesUsed += stats.fBytesUsed;
+    }
+    REPORTER_ASSERT(reporter, lookups - prevLookups == 9);
+    REPORTER_ASSERT(reporter, SkResourceCache::GetTotalBytesUsed() == bytesUsed);
+    REPORTER_ASSERT(reporter, bytesUsed <= kByteLimit);
+
+    SkResourceCache::SetShardCount(prevShardCount);
+    SkResourceCache::SetTotalByteLimit(prevByteLimit);
+    for (int i = kShardCount; i-- > 1;) {
+        REPORTER_ASSERT(reporter, SkResourceCache::GetShardStats(i).fCount == 0);
+    }
+}
@@ -6,6 +6,7 @@
  */
 
 #include "include/core/SkAlphaType.h"
+#include "include/core/SkBitmap.h"
 #include "include/core/SkBlendMode.h"
 #include "include/core/SkBlender.h"
 #include "include/core/SkCanvas.h"
@@ -14,6 +15,7 @@
 #include "include/core/SkColorFilter.h"
 #include "include/core/SkColorType.h"
 #include "include/core/SkData.h"
+#include "include/core/SkGraphics.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkPaint.h"
 #include "include/core/SkPixmap.h"
@@ -25,6 +27,7 @@
 #include "include/core/SkStream.h"
 #include "include/core/SkString.h"
 #include "include/core/SkSurface.h"
+#include "include/core/SkTraceMemoryDump.h"
 #include "include/core/SkTypes.h"
 #include "include/effects/SkBlenders.h"
 #include "include/effects/SkGradientShader.h"
@@ -39,8 +42,12 @@
 #include "include/sksl/SkSLVersion.h"
 #include "src/base/SkStringView.h"
 #include "src/base/SkTLazy.h"
+#include "src/core/SkColorLUTCache.h"
 #include "src/core/SkColorSpacePriv.h"
+#include "src/core/SkResourceCache.h"
+#include "src/core/SkRuntimeEffectCache.h"
 #include "src/core/SkRuntimeEffectPriv.h"
+#include "src/effects/colorfilters/SkRuntimeColorFilter.h"
 #include "src/gpu/KeyBuilder.h"
 #include "src/gpu/SkBackingFit.h"
 #include "src/gpu/ganesh/GrCaps.h"
@@ -55,10 +62,14 @@
 #include "tests/CtsEnforcement.h"
 #include "tests/Test.h"
 
+#include <algorithm>
 #include <array>
+#include <cmath>
 #include <cstdint>
+#include <cstring>
 #include <functional>
 #include <initializer_list>
+#include <iterator>
 #include <memory>
 #include <string>
 #include <thread>
@@ -1322,6 +1333,172 @@ DEF_TEST(SkRuntimeColorFilterSingleColor, r) {
     REPORTER_ASSERT(r, c.fA == 1.0f);
 }
 
+DEF_TEST(SkRuntimeColorFilterBakedLUT, r) {
+    // Draws a horizontal ramp of translucent colors through the filter, and returns the pixels.
+    auto draw = [](sk_sp<SkColorFilter> cf, SkAlphaType alphaType) {
+        SkBitmap bitmap;
+        bitmap.allocPixels(SkImageInfo::Make(64, 4, kRGBA_8888_SkColorType, kPremul_SkAlphaType));
+        SkCanvas canvas(bitmap);
+        const SkPoint pts[] = {{0, 0}, {64, 4}};
+        const SkColor4f colors[] = {{1, 0, 0, 1}, {0.2f, 0.9f, 0.4f, 1}, {0.1f, 0.3f, 1, 1}};
+        SkPaint paint;
+        paint.setShader(SkGradientShader::MakeLinear(pts, colors, /*colorSpace=*/nullptr,
+                                                     /*pos=*/nullptr, std::size(colors),
+                                                     SkTileMode::kClamp));
+        paint.setAlphaf(alphaType == kOpaque_SkAlphaType ? 1.0f : 0.5f);
+        paint.setColorFilter(std::move(cf));
+        canvas.drawPaint(paint);
+        return bitmap;
+    };
+
+    struct Case {
+        const char* fSkSL;
+        int fTolerance;
+    };
+    const Case kCases[] = {
+        // Separable filters are baked into byte tables. (The gradient is interpolated in float,
+        // so quantizing the input to a table index costs up to a step of the steepest slope.)
+        {"uniform half4 gain;"
+         "half4 main(half4 c) { c = unpremul(c); return half4(pow(c.rgb, half3(2.2)) * gain.rgb, 1)"
+         " * c.a; }", 2},
+        // ...anything else into a 3D table.
+        {"uniform half4 gain;"
+         "half4 main(half4 c) {"
+         "    c = unpremul(c);"
+         "    half luma = dot(c.rgb, half3(0.2126, 0.7152, 0.0722));"
+         "    return half4(saturate(mix(half3(luma), c.bgr, 1.5) * gain.rgb), 1) * c.a;"
+         "}", 3},
+    };
+    const float kGain[] = {0.9f, 1.0f, 0.8f, 1.0f};
+    sk_sp<const SkData> uniforms = SkData::MakeWithCopy(kGain, sizeof(kGain));
+
+    SkRuntimeEffect::Options bakedOptions;
+    bakedOptions.bakeColorFilterLUT = true;
+    SkResourceCache cache(1024 * 1024);
+    for (const Case& c : kCases) {
+        auto [effect, err] = SkRuntimeEffect::MakeForColorFilter(SkString(c.fSkSL));
+        auto [bakedEffect, bakedErr] =
+                SkRuntimeEffect::MakeForColorFilter(SkString(c.fSkSL), bakedOptions);
+        REPORTER_ASSERT(r, effect && bakedEffect, "%s", err.c_str());
+        if (!effect || !bakedEffect) {
+            continue;
+        }
+        for (SkAlphaType alphaType : {kOpaque_SkAlphaType, kPremul_SkAlphaType}) {
+            sk_sp<SkColorFilter> baked = bakedEffect->makeColorFilter(uniforms);
+            SkBitmap expected = draw(effect->makeColorFilter(uniforms), alphaType),
+                     actual = draw(static_cast<SkRuntimeColorFilter*>(baked.get())
+                                           ->makeWithLUTCache_ForTesting(&cache),
+                                   alphaType);
+            int maxDiff = 0;
+            for (int y = 0; y < expected.height(); ++y) {
+                for (int x = 0; x < expected.width(); ++x) {
+                    SkColor4f e = expected.getColor4f(x, y), a = actual.getColor4f(x, y);
+                    for (int i = 0; i < 4; ++i) {
+                        maxDiff = std::max(maxDiff, (int)std::lround(std::abs(e[i] - a[i]) * 255));
+                    }
+                }
+            }
+            REPORTER_ASSERT(r, maxDiff <= c.fTolerance, "%s: off by %d", c.fSkSL, maxDiff);
+        }
+
+        // The LUT is shared by every filter made from the effect with the same uniforms.
+        REPORTER_ASSERT(r, SkColorLUTCache::Find(*bakedEffect, /*dstCS=*/nullptr,
+                                                 SkSpan(kGain, std::size(kGain)), &cache));
+    }
+}
+
+DEF_SERIAL_TEST(SkRuntimeEffectProfiling, r) {
+    struct Profile {
+        SkString fSkSL;
+        uint64_t fPixels = 0, fNanoseconds = 0;
+    };
+    // Collects the dumps reported for one effect.
+    class ProfileDump : public SkTraceMemoryDump {
+    public:
+        explicit ProfileDump(const SkRuntimeEffect& effect)
+                : fDumpName(SkStringPrintf("skia/sk_runtime_effect/%08x",
+                                           SkRuntimeEffectPriv::Hash(effect))) {}
+
+        void dumpNumericValue(const char* dumpName, const char* valueName, const char*,
+                              uint64_t value) override {
+            if (fDumpName.equals(dumpName)) {
+                if (!strcmp(valueName, "pixels")) {
+                    fProfile.fPixels = value;
+                } else if (!strcmp(valueName, "time")) {
+                    fProfile.fNanoseconds = value;
+                }
+            }
+        }
+        void dumpStringValue(const char* dumpName, const char* valueName,
+                             const char* value) override {
+            if (fDumpName.equals(dumpName) && !strcmp(valueName, "sksl")) {
+                fProfile.fSkSL = value;
+            }
+        }
+        void setMemoryBacking(const char*, const char*, const char*) override {}
+        void setDiscardableMemoryBacking(const char*, const SkDiscardableMemory&) override {}
+        LevelOfDetail getRequestedDetails() const override {
+            return SkTraceMemoryDump::kObjectsBreakdowns_LevelOfDetail;
+        }
+
+        SkString fDumpName;
+        Profile fProfile;
+    };
+
+    auto [shaderEffect, shaderErr] = SkRuntimeEffect::MakeForShader(SkString(
+            "half4 main(float2 xy) { return half4(fract(xy.x / 7), fract(xy.y / 3), 0.5, 1); }"));
+    auto [filterEffect, filterErr] = SkRuntimeEffect::MakeForColorFilter(SkString(
+            "half4 main(half4 c) { return c.gbra * 0.75; }"));
+    auto [blenderEffect, blenderErr] = SkRuntimeEffect::MakeForBlender(SkString(
+            "half4 main(half4 src, half4 dst) { return mix(src, dst, 0.25); }"));
+    REPORTER_ASSERT(r, shaderEffect && filterEffect && blenderEffect);
+    if (!shaderEffect || !filterEffect || !blenderEffect) {
+        return;
+    }
+
+    // A multiple of every raster pipeline SIMD width, so that the pixel counts are exact.
+    constexpr int kWidth = 64, kHeight = 8;
+    auto draw = [&] {
+        SkBitmap bitmap;
+        bitmap.allocN32Pixels(kWidth, kHeight);
+        SkCanvas canvas(bitmap);
+        canvas.clear(SK_ColorBLUE);
+        SkPaint paint;
+        paint.setShader(shaderEffect->makeShader(/*uniforms=*/nullptr, /*children=*/{}));
+        paint.setColorFilter(filterEffect->makeColorFilter(/*uniforms=*/nullptr));
+        paint.setBlender(blenderEffect->makeBlender(/*uniforms=*/nullptr));
+        canvas.drawPaint(paint);
+    };
+    auto profile = [](const SkRuntimeEffect& effect) {
+        ProfileDump dump(effect);
+        SkGraphics::DumpRuntimeEffectProfile(&dump);
+        return dump.fProfile;
+    };
+
+    const bool wasEnabled = SkGraphics::SetRuntimeEffectProfiling(true);
+    SkGraphics::ResetRuntimeEffectProfile();
+    draw();
+    draw();
+    for (const SkRuntimeEffect* effect : {shaderEffect.get(), filterEffect.get(),
+                                          blenderEffect.get()}) {
+        Profile p = profile(*effect);
+        REPORTER_ASSERT(r, p.fPixels == 2 * kWidth * kHeight, "%llu",
+                        (unsigned long long)p.fPixels);
+        REPORTER_ASSERT(r, p.fNanoseconds > 0);
+        REPORTER_ASSERT(r, p.fSkSL.equals(effect->source().c_str()));
+    }
+
+    // Nothing is counted while profiling is disabled, and resetting clears the counts.
+    SkGraphics::SetRuntimeEffectProfiling(false);
+    draw();
+    REPORTER_ASSERT(r, profile(*shaderEffect).fPixels == 2 * kWidth * kHeight);
+    SkGraphics::ResetRuntimeEffectProfile();
+    REPORTER_ASSERT(r, profile(*shaderEffect).fPixels == 0);
+    REPORTER_ASSERT(r, profile(*shaderEffect).fNanoseconds == 0);
+
+    SkGraphics::SetRuntimeEffectProfiling(wasEnabled);
+}
+
 static void test_RuntimeEffectStructNameReuse(skiatest::Reporter* r, GrRecordingContext* rContext) {
     // Test that two different runtime effects can reuse struct names in a single paint operation
     auto [childEffect, err] = SkRuntimeEffect::MakeForShader(SkString(
@@ -1645,3 +1822,87 @@ DEF_GANESH_TEST_FOR_RENDERING_CONTEXTS(GrSkSLFP_UniformArray,
         }
     }
 }
+
+DEF_TEST(SkRuntimeEffectCache_Limits, r) {
+    SkString sksl[3];
+    sk_sp<SkRuntimeEffect> effects[3];
+    for (int i = 0; i < 3; ++i) {
+        sksl[i].printf("half4 main(float2 p) { return half4(%d); }", i);
+        effects[i] = SkRuntimeEffect::MakeForShader(sksl[i]).effect;
+        REPORTER_ASSERT(r, effects[i]);
+    }
+    const size_t bytes = SkRuntimeEffectCache::EstimatedBytes(sksl[0]);
+
+    SkRuntimeEffectCache cache(/*countLimit=*/2, /*byteLimit=*/100 * bytes);
+    const SkRuntimeEffectCache::MakeFn make = SkRuntimeEffect::MakeForShader;
+    cache.add(make, sksl[0], effects[0]);
+    cache.add(make, sksl[1], effects[1]);
+    REPORTER_ASSERT(r, cache.find(make, sksl[0]) == effects[0]);
+    REPORTER_ASSERT(r, cache.find(make, sksl[1]) == effects[1]);
+    // The same SkSL made as another kind of effect is a different entry.
+    REPORTER_ASSERT(r, !cache.find(SkRuntimeEffect::MakeForColorFilter, sksl[0]));
+    REPORTER_ASSERT(r, cache.getBytesUsed() == 2 * bytes);
+
+    // Past the count limit the least recently used effect goes.
+    cache.add(make, sksl[2], effects[2]);
+    REPORTER_ASSERT(r, cache.getCountUsed() == 2);
+    REPORTER_ASSERT(r, !cache.find(make, sksl[0]));
+    REPORTER_ASSERT(r, cache.find(make, sksl[2]) == effects[2]);
+
+    // Past the byte limit as well.
+    REPORTER_ASSERT(r, cache.setByteLimit(bytes) == 100 * bytes);
+    REPORTER_ASSERT(r, cache.getCountUsed() == 1);
+    REPORTER_ASSERT(r, cache.getBytesUsed() == bytes);
+    REPORTER_ASSERT(r, cache.find(make, sksl[2]) == effects[2]);
+
+    REPORTER_ASSERT(r, cache.setCountLimit(0) == 2);
+    REPORTER_ASSERT(r, cache.getCountUsed() == 0 && cache.getBytesUsed() == 0);
+    cache.add(make, sksl[0], effects[0]);
+    REPORTER_ASSERT(r, !cache.find(make, sksl[0]));
+}
+
+DEF_TEST(SkRuntimeEffectSpecialized, r) {
+    auto [effect, err] = SkRuntimeEffect::MakeForColorFilter(SkString(
+            "uniform int mode;"
+            "uniform half4 tint;"
+            "layout(color) uniform half4 color;"
+            "uniform float a, b;"
+            "uniform float arr[2];"
+            "half4 main(half4 c) {"
+            "    if (mode == 1) { return c * tint; }"
+            "    if (mode == 2) { return color + half(a + b); }"
+            "    return c;"
+            "}"));
+    REPORTER_ASSERT(r, effect, "%s", err.c_str());
+
+    const int one = 1, zero = 0;
+    sk_sp<SkRuntimeEffect> tinted = effect->makeSpecialized("mode", &one, sizeof(one));
+    REPORTER_ASSERT(r, tinted);
+    REPORTER_ASSERT(r, !tinted->findUniform("mode"));
+    REPORTER_ASSERT(r, tinted->uniformSize() == effect->uniformSize() - sizeof(int));
+    // The variant is cached, and is a different effect from the other variants.
+    REPORTER_ASSERT(r, effect->makeSpecialized("mode", &one, sizeof(one)) == tinted);
+    sk_sp<SkRuntimeEffect> passthrough = effect->makeSpecialized("mode", &zero, sizeof(zero));
+    REPORTER_ASSERT(r, passthrough && passthrough != tinted);
+    REPORTER_ASSERT(r, SkRuntimeEffectPriv::Hash(*passthrough) !=
+                       SkRuntimeEffectPriv::Hash(*tinted));
+
+    const float tint[4] = {0.5f, 0.25f, 1.f, 1.f};
+    sk_sp<SkRuntimeEffect> constantTint = tinted->makeSpecialized("tint", tint, sizeof(tint));
+    REPORTER_ASSERT(r, constantTint);
+    REPORTER_ASSERT(r, !constantTint->findUniform("tint"));
+
+    const SkColor4f color = {1.f, 1.f, 0.5f, 1.f};
+    sk_sp<SkData> uniforms = SkData::MakeZeroInitialized(constantTint->uniformSize());
+    SkColor4f filtered = constantTint->makeColorFilter(uniforms)
+                                 ->filterColor4f(color, sk_srgb_singleton(), sk_srgb_singleton());
+    REPORTER_ASSERT(r, filtered == SkColor4f({0.5f, 0.25f, 0.5f, 1.f}));
+
+    // Values of the wrong size, arrays, colors and uniforms that share a declaration can't be
+    // specialized.
+    REPORTER_ASSERT(r, !effect->makeSpecialized("mode", tint, sizeof(tint)));
+    REPORTER_ASSERT(r, !effect->makeSpecialized("unknown", &one, sizeof(one)));
+    REPORTER_ASSERT(r, !effect->makeSpecialized("color", tint, sizeof(tint)));
+    REPORTER_ASSERT(r, !effect->makeSpecialized("b", &tint[0], sizeof(float)));
+    REPORTER_ASSERT(r, !effect->makeSpecialized("arr", tint, 2 * sizeof(float)));
+}
@@ -0,0 +1,186 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkData.h"
+#include "include/core/SkRefCnt.h"
+#include "src/sksl/SkSLCompiler.h"
+#include "src/sksl/SkSLDehydrator.h"
+#include "src/sksl/SkSLModuleLoader.h"
+#include "src/sksl/SkSLProgramKind.h"
+#include "src/sksl/ir/SkSLFunctionPrototype.h"
+#include "src/sksl/ir/SkSLProgramElement.h"
+#include "src/sksl/ir/SkSLSymbolTable.h"
+#include "tests/Test.h"
+
+#include "src/sksl/generated/sksl_compute.minified.sksl"
+#include "src/sksl/generated/sksl_frag.minified.sksl"
+#include "src/sksl/generated/sksl_gpu.minified.sksl"
+#include "src/sksl/generated/sksl_graphite_frag.minified.sksl"
+#include "src/sksl/generated/sksl_graphite_frag_es2.minified.sksl"
+#include "src/sksl/generated/sksl_graphite_vert.minified.sksl"
+#include "src/sksl/generated/sksl_graphite_vert_es2.minified.sksl"
+#include "src/sksl/generated/sksl_public.minified.sksl"
+#include "src/sksl/generated/sksl_rt_shader.minified.sksl"
+#include "src/sksl/generated/sksl_shared.minified.sksl"
+#include "src/sksl/generated/sksl_vert.minified.sksl"
+
+#include "src/sksl/generated/sksl_compute.dehydrated.sksl"
+#include "src/sksl/generated/sksl_frag.dehydrated.sksl"
+#include "src/sksl/generated/sksl_gpu.dehydrated.sksl"
+#include "src/sksl/generated/sksl_graphite_frag.dehydrated.sksl"
+#include "src/sksl/generated/sksl_graphite_frag_es2.dehydrated.sksl"
+#include "src/sksl/generated/sksl_graphite_vert.dehydrated.sksl"
+#include "src/sksl/generated/sksl_graphite_vert_es2.dehydrated.sksl"
+#include "src/sksl/generated/sksl_public.dehydrated.sksl"
+#include "src/sksl/generated/sksl_rt_shader.dehydrated.sksl"
+#include "src/sksl/generated/sksl_shared.dehydrated.sksl"
+#include "src/sksl/generated/sksl_vert.dehydrated.sksl"
+
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <string>
+
+namespace {
+
+struct ModuleData {
+    const char* fName;
+    const char* fSource;
+    const uint8_t* fDehydrated;
+    size_t fDehydratedSize;
+    SkSL::ProgramKind fKind;
+    int fParent;  // An index into kModules, or -1 for the root module.
+};
+
+// This follows the module list in sksl-dehydrate.
+#define MODULE(name) #name, SKSL_MINIFIED_##name, SKSL_DEHYDRATED_##name, \
+                     sizeof(SKSL_DEHYDRATED_##name)
+const ModuleData kModules[] = {
+    {MODULE(sksl_shared),            SkSL::ProgramKind::kFragment,             -1},
+    {MODULE(sksl_gpu),               SkSL::ProgramKind::kFragment,              0},
+    {MODULE(sksl_vert),              SkSL::ProgramKind::kVertex,                1},
+    {MODULE(sksl_frag),              SkSL::ProgramKind::kFragment,              1},
+    {MODULE(sksl_compute),           SkSL::ProgramKind::kCompute,               1},
+    {MODULE(sksl_graphite_vert),     SkSL::ProgramKind::kGraphiteVertex,        2},
+    {MODULE(sksl_graphite_frag),     SkSL::ProgramKind::kGraphiteFragment,      3},
+    {MODULE(sksl_graphite_vert_es2), SkSL::ProgramKind::kGraphiteVertexES2,     2},
+    {MODULE(sksl_graphite_frag_es2), SkSL::ProgramKind::kGraphiteFragmentES2,   3},
+    {MODULE(sksl_public),            SkSL::ProgramKind::kFragment,              0},
+    {MODULE(sksl_rt_shader),         SkSL::ProgramKind::kFragment,              9},
+};
+#undef MODULE
+
+constexpr int kPublicModule = 9;
+
+sk_sp<SkData> dehydrated_data(const ModuleData& info) {
+    return SkData::MakeWithoutCopy(info.fDehydrated, info.fDehydratedSize);
+}
+
+std::unique_ptr<SkSL::Module> compile_module(SkSL::Compiler* compiler,
+                                             const ModuleData& info,
+                                             const SkSL::Module* parent) {
+    if (info.fSource[0] == '\0') {
+        auto module = std::make_unique<SkSL::Module>();
+        module->fParent = parent;
+        module->fSymbols = std::make_unique<SkSL::SymbolTable>(parent->fSymbols.get(),
+                                                               /*builtin=*/true);
+        module->fSymbols->markModuleBoundary();
+        return module;
+    }
+    return compiler->compileModule(info.fKind, info.fName, info.fSource, parent,
+                                   /*shouldInline=*/true);
+}
+
+std::string describe_module(const SkSL::Module& module) {
+    std::string text;
+    for (const std::unique_ptr<SkSL::ProgramElement>& element : module.fElements) {
+        if (!element->is<SkSL::FunctionPrototype>()) {
+            text += element->description();
+        }
+    }
+    return text;
+}
+
+int count_symbols(const SkSL::Module& module) {
+    int count = 0;
+    module.fSymbols->foreach([&](std::string_view, const SkSL::Symbol*) { ++count; });
+    return count;
+}
+
+}  // namespace
+
+DEF_TEST(SkSLDehydratedModulesMatchMinifiedModules, r) {
+    const SkSL::Module* rootModule = SkSL::ModuleLoader::Get().rootModule();
+    SkSL::Compiler compiler;
+    std::unique_ptr<SkSL::Module> compiled[std::size(kModules)];
+    std::unique_ptr<SkSL::Module> rehydrated[std::size(kModules)];
+    for (size_t index = 0; index < std::size(kModules); ++index) {
+        const ModuleData& info = kModules[index];
+        const SkSL::Module* compiledParent =
+                info.fParent < 0 ? rootModule : compiled[info.fParent].get();
+        const SkSL::Module* rehydratedParent =
+                info.fParent < 0 ? rootModule : rehydrated[info.fParent].get();
+
+        compiled[index] = compile_module(&compiler, info, compiledParent);
+        if (!compiled[index]) {
+            ERRORF(r, "%s didn't compile", info.fName);
+            return;
+        }
+
+        // The checked-in IR has to be what the compiler makes of the minified code today.
+        sk_sp<SkData> dehydrated = SkSL::Dehydrator::Dehydrate(*compiled[index], info.fSource);
+        REPORTER_ASSERT(r, dehydrated, "%s couldn't be dehydrated", info.fName);
+        REPORTER_ASSERT(r, dehydrated && dehydrated->equals(dehydrated_data(info).get()),
+                        "%s.dehydrated.sksl is out of date; run sksl-dehydrate", info.fName);
+
+        rehydrated[index] = compiler.rehydrateModule(info.fKind, dehydrated_data(info),
+                                                     info.fSource, rehydratedParent);
+        if (!rehydrated[index]) {
+            ERRORF(r, "%s couldn't be rehydrated", info.fName);
+            return;
+        }
+        REPORTER_ASSERT(r, describe_module(*compiled[index]) ==
+                           describe_module(*rehydrated[index]), "%s", info.fName);
+        REPORTER_ASSERT(r, count_symbols(*compiled[index]) == count_symbols(*rehydrated[index]),
+                        "%s", info.fName);
+
+        if (index == kPublicModule) {
+            SkSL::ModuleLoader::Get().addPublicTypeAliases(compiled[index].get());
+            SkSL::ModuleLoader::Get().addPublicTypeAliases(rehydrated[index].get());
+        }
+    }
+}
+
+DEF_TEST(SkSLRehydratorRejectsMismatchedData, r) {
+    const SkSL::Module* rootModule = SkSL::ModuleLoader::Get().rootModule();
+    SkSL::Compiler compiler;
+    const ModuleData& shared = kModules[0];
+    const ModuleData& gpu = kModules[1];
+
+    // The data has to belong to the module's source.
+    REPORTER_ASSERT(r, !compiler.rehydrateModule(shared.fKind, dehydrated_data(gpu),
+                                                 shared.fSource, rootModule));
+
+    // The symbols it imports have to be in the parent modules.
+    REPORTER_ASSERT(r, !compiler.rehydrateModule(gpu.fKind, dehydrated_data(gpu),
+                                                 gpu.fSource, rootModule));
+
+    // Truncated data is rejected wherever it ends.
+    for (size_t size : {size_t(0), size_t(8), gpu.fDehydratedSize / 2, gpu.fDehydratedSize - 1}) {
+        std::unique_ptr<SkSL::Module> sharedModule =
+                compiler.rehydrateModule(shared.fKind, dehydrated_data(shared), shared.fSource,
+                                         rootModule);
+        REPORTER_ASSERT(r, sharedModule);
+        REPORTER_ASSERT(r, !compiler.rehydrateModule(
+                                   gpu.fKind, SkData::MakeWithoutCopy(gpu.fDehydrated, size),
+                                   gpu.fSource, sharedModule.get()),
+                        "%zu bytes", size);
+    }
+
+    // After a failure, the compiler still compiles modules from source.
+    REPORTER_ASSERT(r, compile_module(&compiler, shared, rootModule));
+}
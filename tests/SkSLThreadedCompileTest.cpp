@@ -0,0 +1,127 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkTypes.h"
+#include "src/sksl/SkSLCompiler.h"
+#include "src/sksl/SkSLProgramKind.h"
+#include "src/sksl/SkSLProgramSettings.h"
+#include "src/sksl/SkSLUtil.h"
+#include "src/sksl/codegen/SkSLGLSLCodeGenerator.h"
+#include "src/sksl/codegen/SkSLMetalCodeGenerator.h"
+#include "src/sksl/codegen/SkSLSPIRVCodeGenerator.h"
+#include "src/sksl/codegen/SkSLWGSLCodeGenerator.h"
+#include "src/sksl/ir/SkSLProgram.h"
+#include "tests/Test.h"
+
+#include <array>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace {
+
+using ToBackendFn = bool (*)(SkSL::Program&, const SkSL::ShaderCaps*, std::string*);
+
+struct Backend {
+    const char* fName;
+    ToBackendFn fToBackend;
+};
+
+const Backend kBackends[] = {
+    {"GLSL",   SkSL::ToGLSL},
+    {"Metal",  SkSL::ToMetal},
+    {"SPIR-V", SkSL::ToSPIRV},
+    {"WGSL",   SkSL::ToWGSL},
+};
+
+struct Shader {
+    SkSL::ProgramKind fKind;
+    const char* fSource;
+};
+
+const Shader kShaders[] = {
+    {SkSL::ProgramKind::kVertex, R"(
+        layout(location=0) in float2 position;
+        layout(location=1) in half4 color;
+        layout(location=0) out half4 vcolor;
+        void main() {
+            vcolor = color;
+            sk_Position = position.xy01;
+        }
+    )"},
+    {SkSL::ProgramKind::kFragment, R"(
+        layout(location=0) in half4 vcolor;
+        layout(set=0, binding=0) uniform Uniforms {
+            half4 weights[4];
+            half threshold;
+        };
+        half luminance(half3 c) { return dot(c, half3(0.2126, 0.7152, 0.0722)); }
+        void main() {
+            half4 color = half4(0);
+            for (int i = 0; i < 4; ++i) {
+                color += weights[i] * vcolor;
+            }
+            sk_FragColor = luminance(color.rgb) > threshold ? color : vcolor.bgra;
+        }
+    )"},
+};
+
+constexpr int kNumThreads = 8;
+constexpr int kNumOutputs = std::size(kShaders) * std::size(kBackends);
+
+using Outputs = std::array<std::string, kNumOutputs>;
+
+// Compiles every shader to every backend, with a fresh Compiler for each shader.
+void compile_all(skiatest::Reporter* r, Outputs* outputs) {
+    SkSL::ProgramSettings settings;
+    // The vertex and fragment shaders are compiled separately, so their SPIR-V interfaces are not
+    // validated against each other.
+    settings.fValidateSPIRV = false;
+
+    int index = 0;
+    for (const Shader& shader : kShaders) {
+        SkSL::Compiler compiler;
+        std::unique_ptr<SkSL::Program> program =
+                compiler.convertProgram(shader.fKind, shader.fSource, settings);
+        if (!program) {
+            ERRORF(r, "%s", compiler.errorText().c_str());
+            return;
+        }
+        for (const Backend& backend : kBackends) {
+            std::string& output = (*outputs)[index++];
+            if (!backend.fToBackend(*program, SkSL::ShaderCapsFactory::Default(), &output)) {
+                ERRORF(r, "%s: %s", backend.fName, compiler.errorText().c_str());
+            }
+        }
+    }
+}
+
+}  // namespace
+
+DEF_TEST(SkSLThreadedCompile, r) {
+    // Every thread compiles the same shaders with its own Compilers. The built-in modules are
+    // shared between all of them, and may be loaded by whichever thread gets there first; each
+    // thread still has to produce exactly the same code.
+    Outputs outputs[kNumThreads];
+    std::thread threads[kNumThreads];
+    for (int i = 0; i < kNumThreads; ++i) {
+        threads[i] = std::thread(compile_all, r, &outputs[i]);
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    for (int i = 1; i < kNumThreads; ++i) {
+        for (int index = 0; index < kNumOutputs; ++index) {
+            REPORTER_ASSERT(r, !outputs[0][index].empty());
+            REPORTER_ASSERT(r, outputs[i][index] == outputs[0][index],
+                            "%s output differs between threads",
+                            kBackends[index % std::size(kBackends)].fName);
+        }
+    }
+}
@@ -21,6 +21,7 @@
 #include "include/core/SkSurfaceProps.h"
 #include "include/core/SkTypeface.h"
 #include "include/core/SkTypes.h"
+#include "include/private/base/SkFixed.h"
 #include "include/private/base/SkMutex.h"
 #include "include/private/base/SkTArray.h"
 #include "include/private/base/SkTo.h"
@@ -43,6 +44,7 @@
 #include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <functional>
 #include <initializer_list>
 #include <memory>
@@ -193,6 +195,10 @@ public:
         SkAutoMutexExclusive m{strike->fStrikeLock};
         return strike->glyph(packedID);
     }
+
+    static const SkGlyph* FindImageGlyph(SkStrike* strike, SkPackedGlyphID packedID) {
+        return strike->fImageGlyphs.find(packedID);
+    }
 };
 
 DEF_TEST(SkStrike_FlattenByType, reporter) {
@@ -292,3 +298,96 @@ DEF_TEST(SkStrike_FlattenByType, reporter) {
     REPORTER_ASSERT(reporter, dstDrawableGlyph->setDrawableHasBeenCalled());
     REPORTER_ASSERT(reporter, dstDrawableGlyph->drawable() != nullptr);
 }
+
+DEF_TEST(SkStrike_PreparedGlyphsMultiThread, reporter) {
+    static constexpr int kThreadCount = 4;
+
+    SkStrikeCache strikeCache;
+    SkFont font{ToolUtils::CreatePortableTypeface("serif", SkFontStyle())};
+    SkStrikeSpec spec = SkStrikeSpec::MakeWithNoDevice(font);
+    sk_sp<SkStrike> strike = spec.findOrCreateStrike(&strikeCache);
+
+    std::vector<SkGlyphID> glyphIDs;
+    std::vector<SkPackedGlyphID> packedIDs;
+    for (SkUnichar c = ' '; c < 'z'; c++) {
+        glyphIDs.push_back(font.unicharToGlyph(c));
+        packedIDs.push_back(SkPackedGlyphID{glyphIDs.back()});
+    }
+
+    // Glyphs prepared once are found again without the strike lock, so every thread must get
+    // the same, fully prepared glyphs no matter which of them prepared them first.
+    auto executor = SkExecutor::MakeFIFOThreadPool(kThreadCount);
+    std::atomic<int> failures{0};
+    SkTaskGroup(*executor).batch(kThreadCount, [&](int) {
+        std::vector<const SkGlyph*> results(glyphIDs.size());
+        for (int i = 0; i < 50; i++) {
+            strike->metrics(glyphIDs, results.data());
+            strike->prepareImages(packedIDs, results.data());
+            for (const SkGlyph* glyph : results) {
+                if (!glyph->setImageHasBeenCalled()) {
+                    failures++;
+                }
+            }
+            strike->preparePaths(glyphIDs, results.data());
+            for (const SkGlyph* glyph : results) {
+                if (!glyph->setPathHasBeenCalled()) {
+                    failures++;
+                }
+            }
+        }
+    });
+    REPORTER_ASSERT(reporter, failures == 0);
+
+    std::vector<const SkGlyph*> results(glyphIDs.size());
+    strike->metrics(glyphIDs, results.data());
+    for (size_t i = 0; i < glyphIDs.size(); i++) {
+        REPORTER_ASSERT(reporter,
+                        results[i] == SkStrikeTestingPeer::GetGlyph(strike.get(), packedIDs[i]));
+    }
+}
+
+DEF_TEST(SkStrike_PrefetchImages, reporter) {
+    SkFont font{ToolUtils::CreatePortableTypeface("serif", SkFontStyle()), 24};
+    font.setSubpixel(true);
+    SkStrikeSpec spec = SkStrikeSpec::MakeWithNoDevice(font);
+
+    // Enough glyphs, some repeated and at several subpixel positions, to need several tasks.
+    std::vector<SkPackedGlyphID> packedIDs;
+    for (SkUnichar c = ' '; c < 'z'; c++) {
+        const SkGlyphID glyphID = font.unicharToGlyph(c);
+        packedIDs.push_back(SkPackedGlyphID{glyphID});
+        packedIDs.push_back(SkPackedGlyphID{glyphID, SK_FixedHalf, 0});
+        packedIDs.push_back(SkPackedGlyphID{glyphID});
+    }
+
+    SkStrikeCache prefetchedCache;
+    sk_sp<SkStrike> prefetched = spec.findOrCreateStrike(&prefetchedCache);
+    auto executor = SkExecutor::MakeFIFOThreadPool(4);
+    prefetched->prefetchImages(packedIDs, executor.get());
+
+    // The prefetched glyphs are found without the strike lock ...
+    std::vector<const SkGlyph*> results(packedIDs.size());
+    for (size_t i = 0; i < packedIDs.size(); i++) {
+        REPORTER_ASSERT(reporter,
+                        SkStrikeTestingPeer::FindImageGlyph(prefetched.get(), packedIDs[i]) ==
+                                  SkStrikeTestingPeer::GetGlyph(prefetched.get(), packedIDs[i]));
+    }
+    prefetched->prepareImages(packedIDs, results.data());
+
+    // ... and are the same as the ones drawn one at a time.
+    SkStrikeCache serialCache;
+    sk_sp<SkStrike> serial = spec.findOrCreateStrike(&serialCache);
+    std::vector<const SkGlyph*> expected(packedIDs.size());
+    serial->prepareImages(packedIDs, expected.data());
+    for (size_t i = 0; i < packedIDs.size(); i++) {
+        const SkGlyph* glyph = results[i];
+        REPORTER_ASSERT(reporter, glyph->setImageHasBeenCalled());
+        REPORTER_ASSERT(reporter, glyph->iRect() == expected[i]->iRect());
+        REPORTER_ASSERT(reporter, glyph->maskFormat() == expected[i]->maskFormat());
+        REPORTER_ASSERT(reporter, glyph->advanceX() == expected[i]->advanceX());
+        if (!glyph->isEmpty() && !glyph->imageTooLarge()) {
+            REPORTER_ASSERT(reporter,
+                            memcmp(glyph->image(), expected[i]->image(), glyph->imageSize()) == 0);
+        }
+    }
+}
@@ -5,6 +5,7 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkData.h"
 #include "include/core/SkFont.h"
 #include "include/core/SkFontStyle.h"
 #include "include/core/SkFontTypes.h"
@@ -65,3 +66,38 @@ DEF_GANESH_TEST_FOR_RENDERING_CONTEXTS(Slug_empty,
     sk_sp<sktext::gpu::Slug> slug = sktext::gpu::Slug::ConvertBlob(canvas, *blob, {10, 10}, p);
     REPORTER_ASSERT(reporter, slug == nullptr);
 }
+
+DEF_GANESH_TEST_FOR_RENDERING_CONTEXTS(Slug_DeserializeBorrowingData,
+                                       reporter,
+                                       ctxInfo,
+                                       CtsEnforcement::kNever) {
+    auto dContext = ctxInfo.directContext();
+    SkImageInfo info = SkImageInfo::MakeN32Premul(256, 256);
+    auto surface(SkSurfaces::RenderTarget(dContext, skgpu::Budgeted::kNo, info));
+    auto canvas = surface->getCanvas();
+
+    SkFont font(ToolUtils::CreatePortableTypeface("serif", SkFontStyle()), 16);
+    font.setSubpixel(true);
+    font.setEdging(SkFont::Edging::kAntiAlias);
+    auto blob = SkTextBlob::MakeFromString("Borrowed glyphs", font);
+
+    SkPaint p;
+    p.setAntiAlias(true);
+    sk_sp<sktext::gpu::Slug> slug = sktext::gpu::Slug::ConvertBlob(canvas, *blob, {10, 10}, p);
+    REPORTER_ASSERT(reporter, slug != nullptr);
+    sk_sp<SkData> data = slug->serialize();
+
+    // The Slug refers to the glyph positions in data, so keeps it alive.
+    sk_sp<sktext::gpu::Slug> borrowing = sktext::gpu::Slug::Deserialize(data);
+    REPORTER_ASSERT(reporter, borrowing != nullptr);
+    REPORTER_ASSERT(reporter, !data->unique());
+    REPORTER_ASSERT(reporter, borrowing->serialize()->equals(data.get()));
+    borrowing->draw(canvas, p);
+
+    // Without data the copying Deserialize reads the same Slug.
+    sk_sp<sktext::gpu::Slug> copying = sktext::gpu::Slug::Deserialize(data->data(), data->size());
+    REPORTER_ASSERT(reporter, copying->serialize()->equals(data.get()));
+
+    borrowing.reset();
+    REPORTER_ASSERT(reporter, data->unique());
+}
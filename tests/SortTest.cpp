@@ -9,9 +9,12 @@
 #include "src/base/SkTSort.h"
 #include "tests/Test.h"
 
+#include <algorithm>
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
 #include <string>
+#include <vector>
 
 extern "C" {
     static int compare_int(const void* a, const void* b) {
@@ -63,4 +66,39 @@ DEF_TEST(Sort, reporter) {
     }
 }
 
+DEF_TEST(RadixSort, reporter) {
+    struct Item {
+        uint64_t fLo, fHi;
+        int fIndex;
+    };
+    auto keyWord = [](const Item& item, int i) { return i ? item.fHi : item.fLo; };
+    auto lessThan = [](const Item& a, const Item& b) {
+        return a.fHi < b.fHi || (a.fHi == b.fHi && a.fLo < b.fLo);
+    };
+
+    SkRandom rand;
+    for (int i = 0; i < 200; i++) {
+        int count = rand.nextRangeU(0, 3000);
+        // Keys that only use a few scattered bits, with plenty of ties to check stability.
+        int loShift = rand.nextRangeU(0, 56), hiShift = rand.nextRangeU(0, 56);
+        uint32_t loRange = rand.nextRangeU(1, 300), hiRange = rand.nextRangeU(1, 300);
+        std::vector<Item> items(count), scratch(count);
+        for (int j = 0; j < count; ++j) {
+            items[j] = {uint64_t(rand.nextULessThan(loRange)) << loShift,
+                        uint64_t(rand.nextULessThan(hiRange)) << hiShift,
+                        j};
+        }
+        std::vector<Item> reference = items;
+        std::stable_sort(reference.begin(), reference.end(), lessThan);
+
+        SkTRadixSort<2>(items.data(), items.data() + count, scratch.data(), keyWord);
+        for (int j = 0; j < count; ++j) {
+            if (items[j].fIndex != reference[j].fIndex) {
+                ERRORF(reporter, "RadixSort [%d] failed at %d", count, j);
+                break;
+            }
+        }
+    }
+}
+
 // need tests for SkStrSearch
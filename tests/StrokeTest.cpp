@@ -14,6 +14,8 @@
 #include "include/core/SkStrokeRec.h"
 #include "src/base/SkFloatBits.h"
 #include "src/core/SkPathPriv.h"
+#include "src/core/SkResourceCache.h"
+#include "src/core/SkStrokeCache.h"
 #include "tests/Test.h"
 
 #include <array>
@@ -192,3 +194,57 @@ DEF_TEST(Stroke, reporter) {
     test_strokerec_equality(reporter);
     test_big_stroke(reporter);
 }
+
+DEF_TEST(StrokeCache, reporter) {
+    SkResourceCache cache(1024 * 1024);
+
+    SkPath path;
+    path.moveTo(0, 0);
+    for (int i = 1; i <= 10; ++i) {
+        path.lineTo(10 * i, i % 2 ? 20 : 0);
+    }
+
+    SkStrokeRec rec(SkStrokeRec::kFill_InitStyle);
+    rec.setStrokeStyle(4);
+    rec.setStrokeParams(SkPaint::kRound_Cap, SkPaint::kMiter_Join, 4);
+    rec.setResScale(1.5f);
+
+    // The second stroke is the same outline as the first.
+    SkPath first, second;
+    REPORTER_ASSERT(reporter, SkStrokeCache::ApplyToPath(rec, path, &first, &cache));
+    REPORTER_ASSERT(reporter, SkStrokeCache::ApplyToPath(rec, path, &second, &cache));
+    REPORTER_ASSERT(reporter, first.getGenerationID() == second.getGenerationID());
+
+    // It matches stroking the path directly, at the rounded up resScale.
+    SkStrokeRec rounded = rec;
+    rounded.setResScale(2);
+    SkPath expected;
+    rounded.applyToPath(&expected, path);
+    REPORTER_ASSERT(reporter, first == expected);
+
+    // A resScale in the same power of two shares the outline.
+    rec.setResScale(1.9f);
+    REPORTER_ASSERT(reporter, SkStrokeCache::ApplyToPath(rec, path, &second, &cache));
+    REPORTER_ASSERT(reporter, first.getGenerationID() == second.getGenerationID());
+
+    // A different width doesn't.
+    rec.setStrokeStyle(5);
+    REPORTER_ASSERT(reporter, SkStrokeCache::ApplyToPath(rec, path, &second, &cache));
+    REPORTER_ASSERT(reporter, first.getGenerationID() != second.getGenerationID());
+    rec.setStrokeStyle(4);
+
+    // Nor does the path once it changes.
+    path.lineTo(0, 50);
+    REPORTER_ASSERT(reporter, SkStrokeCache::ApplyToPath(rec, path, &second, &cache));
+    REPORTER_ASSERT(reporter, first.getGenerationID() != second.getGenerationID());
+
+    // Volatile paths are stroked every time.
+    path.setIsVolatile(true);
+    REPORTER_ASSERT(reporter, SkStrokeCache::ApplyToPath(rec, path, &first, &cache));
+    REPORTER_ASSERT(reporter, SkStrokeCache::ApplyToPath(rec, path, &second, &cache));
+    REPORTER_ASSERT(reporter, first.getGenerationID() != second.getGenerationID());
+
+    // Fills aren't stroked at all.
+    rec.setFillStyle();
+    REPORTER_ASSERT(reporter, !SkStrokeCache::ApplyToPath(rec, path, &first, &cache));
+}
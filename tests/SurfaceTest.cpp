@@ -1311,3 +1311,88 @@ DEF_TEST(surface_image_unity, reporter) {
         }
     }
 }
+
+DEF_TEST(SurfaceDirtyRegion, reporter) {
+    constexpr int kTile = 64;
+    auto surface = SkSurfaces::Raster(SkImageInfo::MakeN32Premul(256, 256));
+    SkCanvas* canvas = surface->getCanvas();
+    canvas->clear(SK_ColorWHITE);
+    REPORTER_ASSERT(reporter, surface->dirtyRegion() == SkRegion(SkIRect::MakeWH(256, 256)));
+
+    surface->resetDirtyRegion();
+    REPORTER_ASSERT(reporter, surface->dirtyRegion().isEmpty());
+
+    SkPaint paint;
+    canvas->drawRect(SkRect::MakeXYWH(10, 10, 10, 10), paint);
+    REPORTER_ASSERT(reporter, surface->dirtyRegion() == SkRegion(SkIRect::MakeWH(kTile, kTile)));
+
+    // Clipped draws are bounded by the clip.
+    canvas->save();
+    canvas->clipRect(SkRect::MakeXYWH(2*kTile + 5, 2*kTile + 5, 10, 10));
+    canvas->drawPaint(paint);
+    canvas->restore();
+
+    SkRegion dirty = surface->dirtyRegion();
+    REPORTER_ASSERT(reporter, dirty.contains(SkIRect::MakeXYWH(2*kTile, 2*kTile, kTile, kTile)));
+    REPORTER_ASSERT(reporter, !dirty.intersects(SkIRect::MakeXYWH(kTile, 0, kTile, kTile)));
+    REPORTER_ASSERT(reporter, !dirty.intersects(SkIRect::MakeXYWH(3*kTile, 3*kTile, kTile, kTile)));
+
+    // Writes are bounded by the written rect.
+    SkBitmap bm;
+    bm.allocN32Pixels(1, 1);
+    bm.eraseColor(SK_ColorRED);
+    surface->writePixels(bm, 3*kTile + 1, 0);
+    REPORTER_ASSERT(reporter, surface->dirtyRegion().contains(
+                                      SkIRect::MakeXYWH(3*kTile, 0, kTile, kTile)));
+
+    // Outside changes dirty everything.
+    surface->notifyContentWillChange(SkSurface::kRetain_ContentChangeMode);
+    REPORTER_ASSERT(reporter, surface->dirtyRegion() == SkRegion(SkIRect::MakeWH(256, 256)));
+}
+
+// A surface that reuses snapshot pixels must draw exactly what a plain one does, while each
+// snapshot keeps the contents it was taken with.
+DEF_TEST(SurfaceReuseSnapshotPixels, reporter) {
+    const SkImageInfo info = SkImageInfo::MakeN32Premul(200, 150);
+    const SkSurfaceProps props(SkSurfaceProps::kReuseSnapshotPixels_Flag, kUnknown_SkPixelGeometry);
+    auto reusing = SkSurfaces::Raster(info, &props);
+    auto plain   = SkSurfaces::Raster(info);
+
+    auto draw_frame = [](SkSurface* surface, int frame) {
+        SkPaint paint;
+        paint.setColor(SkColorSetARGB(0xFF, 40 * frame, 255 - 30 * frame, 20 * frame));
+        surface->getCanvas()->drawRect(SkRect::MakeXYWH(23 * frame, 17 * frame, 12, 9), paint);
+    };
+    auto same_pixels = [](SkSurface* a, SkSurface* b) {
+        SkBitmap ba, bb;
+        ba.allocPixels(a->imageInfo());
+        bb.allocPixels(b->imageInfo());
+        return a->readPixels(ba, 0, 0) && b->readPixels(bb, 0, 0) &&
+               0 == memcmp(ba.getPixels(), bb.getPixels(), ba.computeByteSize());
+    };
+
+    reusing->getCanvas()->clear(SK_ColorWHITE);
+    plain->getCanvas()->clear(SK_ColorWHITE);
+
+    sk_sp<SkImage> previous;
+    for (int frame = 0; frame < 6; ++frame) {
+        sk_sp<SkImage> snapshot = reusing->makeImageSnapshot();
+        SkBitmap expectedSnapshot;
+        expectedSnapshot.allocPixels(info);
+        REPORTER_ASSERT(reporter, snapshot->readPixels(nullptr, expectedSnapshot.pixmap(), 0, 0));
+
+        // Release the previous snapshot so its pixels can be reused by this frame's draw.
+        previous = nullptr;
+        draw_frame(reusing.get(), frame);
+        draw_frame(plain.get(), frame);
+        REPORTER_ASSERT(reporter, same_pixels(reusing.get(), plain.get()), "frame %d", frame);
+
+        SkBitmap actualSnapshot;
+        actualSnapshot.allocPixels(info);
+        REPORTER_ASSERT(reporter, snapshot->readPixels(nullptr, actualSnapshot.pixmap(), 0, 0));
+        REPORTER_ASSERT(reporter, 0 == memcmp(expectedSnapshot.getPixels(),
+                                              actualSnapshot.getPixels(),
+                                              expectedSnapshot.computeByteSize()));
+        previous = std::move(snapshot);
+    }
+}
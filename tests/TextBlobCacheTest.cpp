@@ -86,6 +86,11 @@ public:
         cache->fSizeBudget = budget;
         cache->internalCheckPurge();
     }
+
+    static int BlobIDCount(sktext::gpu::TextBlobRedrawCoordinator* cache) {
+        SkAutoSpinlock lock{cache->fSpinLock};
+        return cache->fBlobIDCache.count();
+    }
 };
 
 // This test hammers the GPU textblobcache and font atlas
@@ -268,6 +273,36 @@ static sk_sp<SkTextBlob> make_blob() {
     return builder.make();
 }
 
+DEF_GANESH_TEST_FOR_MOCK_CONTEXT(TextBlobCacheInternsContents, reporter, ctxInfo) {
+    auto dContext = ctxInfo.directContext();
+    const SkImageInfo info =
+            SkImageInfo::Make(kScreenDim, kScreenDim, kN32_SkColorType, kPremul_SkAlphaType);
+    auto surface = SkSurfaces::RenderTarget(dContext, skgpu::Budgeted::kNo, info);
+    SkCanvas* canvas = surface->getCanvas();
+    sktext::gpu::TextBlobRedrawCoordinator* cache = dContext->priv().getTextBlobCache();
+    cache->freeAll();
+
+    // Separately made blobs with the same contents share their draw data.
+    sk_sp<SkTextBlob> first = make_blob();
+    canvas->drawTextBlob(first, 40, 40, SkPaint());
+    const int count = GrTextBlobTestingPeer::BlobIDCount(cache);
+    REPORTER_ASSERT(reporter, count == 1);
+    for (int i = 0; i < 3; ++i) {
+        sk_sp<SkTextBlob> same = make_blob();
+        REPORTER_ASSERT(reporter, same->uniqueID() != first->uniqueID());
+        canvas->drawTextBlob(same, 40, 40, SkPaint());
+        REPORTER_ASSERT(reporter, GrTextBlobTestingPeer::BlobIDCount(cache) == count);
+    }
+
+    // Blobs with other contents do not.
+    SkTextBlobBuilder builder;
+    SkFont font = ToolUtils::DefaultFont();
+    const auto& run = builder.allocRun(font, 1, 0, 0);
+    run.glyphs[0] = 1;
+    canvas->drawTextBlob(builder.make(), 40, 40, SkPaint());
+    REPORTER_ASSERT(reporter, GrTextBlobTestingPeer::BlobIDCount(cache) == count + 1);
+}
+
 // Turned off to pass on android and ios devices, which were running out of memory..
 #if 0
 static sk_sp<SkTextBlob> make_large_blob() {
@@ -464,6 +464,51 @@ DEF_TEST(TextBlob_serialize, reporter) {
     }
 }
 
+// Glyphs and positions are packed when that's smaller, and must read back exactly either way.
+DEF_TEST(TextBlob_serializePacked, reporter) {
+    const SkFont font = ToolUtils::DefaultFont();
+    constexpr int kCount = 64;
+
+    SkTextBlobBuilder builder;
+    const auto& h = builder.allocRunPosH(font, kCount, 20);      // on 1/64ths of a pixel
+    for (int i = 0; i < kCount; ++i) {
+        h.glyphs[i] = SkTo<uint16_t>(40 + i % 7);
+        h.pos[i] = i * 9.015625f;
+    }
+    const auto& f = builder.allocRunPos(font, kCount);           // on whole pixels
+    for (int i = 0; i < kCount; ++i) {
+        f.glyphs[i] = SkTo<uint16_t>(30000 + i * 3);
+        f.points()[i] = {i * 10.0f, 40.0f + (i & 1)};
+    }
+    const auto& u = builder.allocRunPosH(font, kCount, 60);      // can't be packed
+    for (int i = 0; i < kCount; ++i) {
+        u.glyphs[i] = SkTo<uint16_t>(i % 2 ? 0 : 65535);
+        u.pos[i] = i * 0.1f;
+    }
+    sk_sp<SkTextBlob> blob = builder.make();
+
+    sk_sp<SkData> data = blob->serialize(SkSerialProcs());
+    // Unpacked, the glyphs and positions alone would take 6, 10 and 6 bytes per glyph.
+    REPORTER_ASSERT(reporter, data->size() < kCount * (6 + 10 + 6));
+
+    sk_sp<SkTextBlob> copy = SkTextBlob::Deserialize(data->data(), data->size(), SkDeserialProcs());
+    REPORTER_ASSERT(reporter, copy);
+    if (!copy) {
+        return;
+    }
+    SkTextBlobRunIterator a(blob.get()), b(copy.get());
+    for (; !a.done() && !b.done(); a.next(), b.next()) {
+        REPORTER_ASSERT(reporter, a.positioning() == b.positioning());
+        REPORTER_ASSERT(reporter, a.glyphCount() == b.glyphCount());
+        REPORTER_ASSERT(reporter, a.font() == b.font());
+        REPORTER_ASSERT(reporter, !memcmp(a.glyphs(), b.glyphs(), a.glyphCount() * 2));
+        const int scalars = a.positioning() == SkTextBlobRunIterator::kFull_Positioning ? 2 : 1;
+        REPORTER_ASSERT(reporter,
+                        !memcmp(a.pos(), b.pos(), a.glyphCount() * scalars * sizeof(SkScalar)));
+    }
+    REPORTER_ASSERT(reporter, a.done() && b.done());
+}
+
 DEF_TEST(TextBlob_MakeAsDrawText, reporter) {
     const char text[] = "Hello";
     auto blob = SkTextBlob::MakeFromString(text, ToolUtils::DefaultFont(), SkTextEncoding::kUTF8);
@@ -0,0 +1,51 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkMatrix.h"
+#include "include/core/SkPoint.h"
+#include "include/core/SkRect.h"
+#include "src/base/SkRandom.h"
+#include "src/core/SkPointPriv.h"
+#include "src/core/SkTextQuads.h"
+#include "tests/Test.h"
+
+DEF_TEST(TextQuads_MatchMatrix, r) {
+    constexpr int kCount = 37;
+    SkRandom random;
+    SkPoint leftTop[kCount], size[kCount];
+    for (int i = 0; i < kCount; ++i) {
+        leftTop[i] = {random.nextRangeScalar(-100, 100), random.nextRangeScalar(-100, 100)};
+        size[i] = {random.nextRangeScalar(0, 64), random.nextRangeScalar(0, 64)};
+    }
+
+    for (const SkMatrix& matrix : {SkMatrix::I(),
+                                   SkMatrix::Translate(10.5f, -3),
+                                   SkMatrix::Scale(2, 0.5f),
+                                   SkMatrix::RotateDeg(30, {5, 7}),
+                                   SkMatrix::MakeAll(1.5f, 0.25f, 3, -0.5f, 2, 4, 0, 0, 1)}) {
+        float affine[6];
+        REPORTER_ASSERT(r, matrix.asAffine(affine));
+        SkPoint corners[4 * kCount];
+        SkOpts::map_text_quads(affine, leftTop, size, kCount, corners);
+
+        for (int i = 0; i < kCount; ++i) {
+            const SkRect rect = SkRect::MakeXYWH(leftTop[i].x(), leftTop[i].y(),
+                                                 size[i].x(), size[i].y());
+            const SkPoint expected[] = {matrix.mapXY(rect.left(),  rect.top()),
+                                        matrix.mapXY(rect.left(),  rect.bottom()),
+                                        matrix.mapXY(rect.right(), rect.top()),
+                                        matrix.mapXY(rect.right(), rect.bottom())};
+            for (int j = 0; j < 4; ++j) {
+                REPORTER_ASSERT(r, SkPointPriv::EqualsWithinTolerance(corners[4 * i + j],
+                                                                      expected[j], 1e-3f),
+                                "glyph %d corner %d: (%g, %g) != (%g, %g)", i, j,
+                                corners[4 * i + j].x(), corners[4 * i + j].y(),
+                                expected[j].x(), expected[j].y());
+            }
+        }
+    }
+}
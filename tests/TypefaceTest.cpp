@@ -616,6 +616,34 @@ DEF_TEST(TypefaceCache, reporter) {
     REPORTER_ASSERT(reporter, t1->unique());
 }
 
+static bool is_typeface(SkTypeface* face, void* ctx) {
+    return face == ctx;
+}
+
+DEF_TEST(TypefaceCache_Keyed, reporter) {
+    sk_sp<SkTypeface> t0(TestEmptyTypeface::Make());
+    sk_sp<SkTypeface> t1(TestEmptyTypeface::Make());
+    {
+        SkTypefaceCache cache;
+        cache.add(t0, 1);
+        cache.add(t1, 2);
+        REPORTER_ASSERT(reporter, count(reporter, cache) == 2);
+
+        REPORTER_ASSERT(reporter, cache.findByKeyAndProcAndRef(1, is_typeface, t0.get()) == t0);
+        REPORTER_ASSERT(reporter, cache.findByKeyAndProcAndRef(2, is_typeface, t1.get()) == t1);
+        // Lookups only see typefaces with their key.
+        REPORTER_ASSERT(reporter, !cache.findByKeyAndProcAndRef(2, is_typeface, t0.get()));
+        REPORTER_ASSERT(reporter, !cache.findByKeyAndProcAndRef(3, is_typeface, t0.get()));
+        REPORTER_ASSERT(reporter, cache.findByProcAndRef(is_typeface, t1.get()) == t1);
+
+        t0.reset();
+        cache.purgeAll();
+        REPORTER_ASSERT(reporter, count(reporter, cache) == 1);
+        REPORTER_ASSERT(reporter, cache.findByKeyAndProcAndRef(2, is_typeface, t1.get()) == t1);
+    }
+    REPORTER_ASSERT(reporter, t1->unique());
+}
+
 static void check_serialize_behaviors(sk_sp<SkTypeface> tf, skiatest::Reporter* reporter) {
     if (!tf) {
         return;
@@ -5,6 +5,7 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkBitmap.h"
 #include "include/core/SkBlendMode.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColor.h"
@@ -15,6 +16,7 @@
 #include "include/core/SkSurface.h"
 #include "include/core/SkVertices.h"
 #include "src/base/SkAutoMalloc.h"
+#include "src/base/SkRandom.h"
 #include "src/core/SkReadBuffer.h"
 #include "src/core/SkVerticesPriv.h"
 #include "src/core/SkWriteBuffer.h"
@@ -22,6 +24,8 @@
 #include "tools/ToolUtils.h"
 
 #include <cstdint>
+#include <cstdlib>
+#include <cstring>
 
 static bool equal(const SkVertices* vert0, const SkVertices* vert1) {
     SkVerticesPriv v0(vert0->priv()), v1(vert1->priv());
@@ -172,3 +176,56 @@ DEF_TEST(Vertices_clipping, reporter) {
         }
     }
 }
+
+DEF_TEST(Vertices_colorMesh, reporter) {
+    // Meshes with only per-vertex colors take a dedicated span blitter on 8888 destinations.
+    // Compare against F16, which always uses the general shader-based path.
+    constexpr int kGrid = 8, kSize = 64, kVertexCount = (kGrid + 1) * (kGrid + 1);
+    SkVertices::Builder builder(SkVertices::kTriangles_VertexMode, kVertexCount,
+                                kGrid * kGrid * 6, SkVertices::kHasColors_BuilderFlag);
+    SkRandom rand;
+    for (int i = 0; i < kVertexCount; ++i) {
+        int x = i % (kGrid + 1), y = i / (kGrid + 1);
+        builder.positions()[i] = {x * 7.3f + rand.nextF(), y * 7.1f + rand.nextF()};
+        builder.colors()[i] = rand.nextU() | 0x80000000;
+    }
+    uint16_t* idx = builder.indices();
+    for (int y = 0; y < kGrid; ++y) {
+        for (int x = 0; x < kGrid; ++x) {
+            uint16_t n = y * (kGrid + 1) + x;
+            uint16_t tri[] = {n, uint16_t(n + 1), uint16_t(n + kGrid + 2),
+                              n, uint16_t(n + kGrid + 2), uint16_t(n + kGrid + 1)};
+            memcpy(idx, tri, sizeof(tri));
+            idx += 6;
+        }
+    }
+    sk_sp<SkVertices> verts = builder.detach();
+
+    auto draw = [&](SkColorType ct, SkBlendMode mode, const SkPaint& paint) {
+        auto surf = SkSurfaces::Raster(SkImageInfo::Make(kSize, kSize, ct, kPremul_SkAlphaType));
+        surf->getCanvas()->clear(0x40204080);
+        surf->getCanvas()->drawVertices(verts, mode, paint);
+        SkBitmap bm;
+        bm.allocPixels(SkImageInfo::MakeN32Premul(kSize, kSize));
+        surf->readPixels(bm, 0, 0);
+        return bm;
+    };
+
+    SkPaint paint;
+    paint.setColor(0xC080FF40);
+    for (SkBlendMode mode : {SkBlendMode::kModulate, SkBlendMode::kDst}) {
+        SkBitmap fast = draw(kN32_SkColorType, mode, paint),
+                 ref  = draw(kRGBA_F16_SkColorType, mode, paint);
+        for (int y = 0; y < kSize; ++y) {
+            for (int x = 0; x < kSize; ++x) {
+                SkPMColor a = *fast.getAddr32(x, y),
+                          b = *ref.getAddr32(x, y);
+                for (int shift : {0, 8, 16, 24}) {
+                    int diff = (int)((a >> shift) & 0xFF) - (int)((b >> shift) & 0xFF);
+                    REPORTER_ASSERT(reporter, std::abs(diff) <= 2,
+                                    "mode %d (%d, %d): %08x vs %08x", (int)mode, x, y, a, b);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,109 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkTypes.h"
+
+#if defined(SK_GANESH) && defined(SK_VULKAN)
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkSurface.h"
+#include "include/gpu/GpuTypes.h"
+#include "include/gpu/GrContextOptions.h"
+#include "include/gpu/GrDirectContext.h"
+#include "include/gpu/GrTypes.h"
+#include "include/gpu/ganesh/SkSurfaceGanesh.h"
+#include "src/gpu/ganesh/GrDirectContextPriv.h"
+#include "src/gpu/ganesh/vk/GrVkGpu.h"
+#include "tests/CtsEnforcement.h"
+#include "tests/Test.h"
+#include "tools/gpu/ContextType.h"
+#include "tools/gpu/GrContextFactory.h"
+
+#include <memory>
+
+using sk_gpu_test::GrContextFactory;
+
+// Surfaces drawn in one flush, some of them into the others, come out the same when their render
+// passes are recorded on the executor's threads.
+DEF_GANESH_TEST(VkParallelRecordingTest, reporter, options, CtsEnforcement::kNever) {
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(2);
+    GrContextOptions parallelOptions = options;
+    parallelOptions.fExecutor = executor.get();
+    parallelOptions.fRecordVulkanCommandBuffersInParallel = true;
+
+    for (int ct = 0; ct < skgpu::kContextTypeCount; ++ct) {
+        auto contextType = static_cast<skgpu::ContextType>(ct);
+        if (skgpu::ganesh::ContextTypeBackend(contextType) != GrBackendApi::kVulkan) {
+            continue;
+        }
+        GrContextFactory factory(parallelOptions);
+        GrDirectContext* dContext = factory.get(contextType);
+        if (!dContext) {
+            continue;
+        }
+        auto gpu = static_cast<GrVkGpu*>(dContext->priv().getGpu());
+        REPORTER_ASSERT(reporter, gpu->commandBufferExecutor() == executor.get());
+
+        const SkImageInfo ii =
+                SkImageInfo::Make(32, 32, kRGBA_8888_SkColorType, kPremul_SkAlphaType);
+        const SkColor colors[] = {SK_ColorRED, SK_ColorGREEN, SK_ColorBLUE, SK_ColorYELLOW};
+        sk_sp<SkSurface> sources[std::size(colors)];
+        for (size_t i = 0; i < std::size(colors); ++i) {
+            sources[i] = SkSurfaces::RenderTarget(dContext, skgpu::Budgeted::kNo, ii);
+            REPORTER_ASSERT(reporter, sources[i]);
+            if (!sources[i]) {
+                return;
+            }
+            SkPaint paint;
+            paint.setColor(colors[i]);
+            sources[i]->getCanvas()->clear(SK_ColorWHITE);
+            sources[i]->getCanvas()->drawRect(SkRect::MakeLTRB(0, 0, 16, 16), paint);
+            paint.setAntiAlias(true);
+            sources[i]->getCanvas()->drawCircle(24, 24, 6, paint);
+        }
+
+        // Each quarter of the destination is the corner of a source that was drawn red, green,
+        // blue or yellow.
+        const SkImageInfo dstII = ii.makeWH(64, 64);
+        sk_sp<SkSurface> dst = SkSurfaces::RenderTarget(dContext, skgpu::Budgeted::kNo, dstII);
+        REPORTER_ASSERT(reporter, dst);
+        if (!dst) {
+            return;
+        }
+        dst->getCanvas()->clear(SK_ColorBLACK);
+        for (size_t i = 0; i < std::size(colors); ++i) {
+            sk_sp<SkImage> image = sources[i]->makeImageSnapshot();
+            dst->getCanvas()->drawImage(image, (i % 2) * 32, (i / 2) * 32);
+        }
+        dContext->flushAndSubmit(GrSyncCpu::kYes);
+
+        SkBitmap bitmap;
+        bitmap.allocPixels(dstII);
+        REPORTER_ASSERT(reporter, dst->readPixels(bitmap, 0, 0));
+        for (size_t i = 0; i < std::size(colors); ++i) {
+            const int x = (i % 2) * 32, y = (i / 2) * 32;
+            REPORTER_ASSERT(reporter, bitmap.getColor(x + 8, y + 8) == colors[i], "%zu", i);
+            REPORTER_ASSERT(reporter, bitmap.getColor(x + 24, y + 8) == SK_ColorWHITE, "%zu", i);
+            REPORTER_ASSERT(reporter, bitmap.getColor(x + 24, y + 24) == colors[i], "%zu", i);
+        }
+
+        // The command buffers are reused by the next flush.
+        dst->getCanvas()->clear(SK_ColorGREEN);
+        dContext->flushAndSubmit(GrSyncCpu::kYes);
+        REPORTER_ASSERT(reporter, dst->readPixels(bitmap, 0, 0));
+        REPORTER_ASSERT(reporter, bitmap.getColor(40, 40) == SK_ColorGREEN);
+    }
+}
+
+#endif
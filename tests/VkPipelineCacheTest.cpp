@@ -0,0 +1,180 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkTypes.h"
+
+#if defined(SK_GANESH) && defined(SK_VULKAN)
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkData.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkString.h"
+#include "include/core/SkSurface.h"
+#include "include/gpu/GpuTypes.h"
+#include "include/gpu/GrContextOptions.h"
+#include "include/gpu/GrDirectContext.h"
+#include "include/gpu/GrTypes.h"
+#include "include/gpu/ganesh/SkSurfaceGanesh.h"
+#include "src/gpu/ganesh/GrDirectContextPriv.h"
+#include "src/gpu/ganesh/vk/GrVkGpu.h"
+#include "tests/CtsEnforcement.h"
+#include "tests/Test.h"
+#include "tools/gpu/ContextType.h"
+#include "tools/gpu/GrContextFactory.h"
+
+#include <vulkan/vulkan_core.h>
+#include <cstdint>
+#include <cstring>
+
+using sk_gpu_test::GrContextFactory;
+
+namespace {
+
+// Only keeps what the Vulkan backend stores for its VkPipelineCache, not its shaders.
+class PipelineCacheStorage final : public GrContextOptions::PersistentCache {
+public:
+    sk_sp<SkData> load(const SkData& key) override {
+        if (!is_pipeline_cache_key(key)) {
+            return nullptr;
+        }
+        ++fNumLoads;
+        return fKey && fKey->equals(&key) ? fData : nullptr;
+    }
+
+    void store(const SkData& key, const SkData& data, const SkString& description) override {
+        if (!is_pipeline_cache_key(key)) {
+            return;
+        }
+        ++fNumStores;
+        fKey = SkData::MakeWithCopy(key.data(), key.size());
+        fData = SkData::MakeWithCopy(data.data(), data.size());
+    }
+
+    static bool is_pipeline_cache_key(const SkData& key) {
+        uint32_t type;
+        return key.size() == 4 * sizeof(uint32_t) + VK_UUID_SIZE &&
+               key.copyRange(0, sizeof(type), &type) == sizeof(type) &&
+               type == GrVkGpu::kPipelineCache_PersistentCacheKeyType;
+    }
+
+    int fNumLoads = 0;
+    int fNumStores = 0;
+    sk_sp<SkData> fKey;
+    sk_sp<SkData> fData;
+};
+
+// Draws a red rect and an antialiased circle, and returns the color in the middle of the rect.
+SkColor draw(GrDirectContext* dContext) {
+    const SkImageInfo ii = SkImageInfo::Make(64, 64, kRGBA_8888_SkColorType, kPremul_SkAlphaType);
+    sk_sp<SkSurface> surface = SkSurfaces::RenderTarget(dContext, skgpu::Budgeted::kNo, ii);
+    if (!surface) {
+        return SK_ColorTRANSPARENT;
+    }
+    SkCanvas* canvas = surface->getCanvas();
+    canvas->clear(SK_ColorWHITE);
+    SkPaint paint;
+    paint.setColor(SK_ColorRED);
+    canvas->drawRect(SkRect::MakeLTRB(4, 4, 30, 30), paint);
+    paint.setAntiAlias(true);
+    paint.setColor(SK_ColorBLUE);
+    canvas->drawCircle(44, 44, 12, paint);
+    dContext->flushAndSubmit(surface.get(), GrSyncCpu::kYes);
+
+    SkBitmap bitmap;
+    bitmap.allocPixels(ii);
+    if (!surface->readPixels(bitmap, 0, 0)) {
+        return SK_ColorTRANSPARENT;
+    }
+    return bitmap.getColor(16, 16);
+}
+
+// The key is the key type followed by the vendor, device and driver version, and then the pipeline
+// cache UUID. The VkPipelineCache data starts with a header that has the same vendor, device and
+// UUID.
+bool key_matches(const SkData& key, const SkData& data, const VkPhysicalDeviceProperties& props) {
+    const uint32_t* ids = static_cast<const uint32_t*>(key.data());
+    if (ids[1] != props.vendorID || ids[2] != props.deviceID || ids[3] != props.driverVersion ||
+        memcmp(ids + 4, props.pipelineCacheUUID, VK_UUID_SIZE) != 0) {
+        return false;
+    }
+    return data.size() >= 16 + VK_UUID_SIZE &&
+           memcmp(data.bytes() + 8, ids + 1, 2 * sizeof(uint32_t)) == 0 &&
+           memcmp(data.bytes() + 16, props.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+}
+
+}  // anonymous namespace
+
+// The VkPipelineCache is loaded when the context is made, is stored under a key for the driver
+// every few submits while pipelines are being made, and seeds the next context.
+DEF_GANESH_TEST(VkPipelineCacheStoreTest, reporter, options, CtsEnforcement::kNever) {
+    for (int ct = 0; ct < skgpu::kContextTypeCount; ++ct) {
+        auto contextType = static_cast<skgpu::ContextType>(ct);
+        if (skgpu::ganesh::ContextTypeBackend(contextType) != GrBackendApi::kVulkan) {
+            continue;
+        }
+
+        PipelineCacheStorage storage;
+        GrContextOptions cacheOptions = options;
+        cacheOptions.fPersistentCache = &storage;
+        cacheOptions.fVulkanPipelineCacheStoreInterval = 2;
+        {
+            GrContextFactory factory(cacheOptions);
+            GrDirectContext* dContext = factory.get(contextType);
+            if (!dContext) {
+                continue;
+            }
+            const VkPhysicalDeviceProperties& props =
+                    static_cast<GrVkGpu*>(dContext->priv().getGpu())->physicalDeviceProperties();
+
+            // The cache is looked up before anything is drawn.
+            REPORTER_ASSERT(reporter, storage.fNumLoads == 1, "%d", storage.fNumLoads);
+            REPORTER_ASSERT(reporter, storage.fNumStores == 0);
+
+            REPORTER_ASSERT(reporter, draw(dContext) == SK_ColorRED);
+            dContext->flushAndSubmit();
+            REPORTER_ASSERT(reporter, storage.fNumStores == 1, "%d", storage.fNumStores);
+            REPORTER_ASSERT(reporter, storage.fKey && storage.fData &&
+                                      key_matches(*storage.fKey, *storage.fData, props));
+
+            // Submits that make no pipelines don't store the cache again.
+            for (int i = 0; i < 4; ++i) {
+                dContext->flushAndSubmit();
+            }
+            REPORTER_ASSERT(reporter, storage.fNumStores == 1, "%d", storage.fNumStores);
+        }
+
+        // The next context loads what was stored, and draws the same.
+        const sk_sp<SkData> stored = storage.fData;
+        storage.fNumLoads = storage.fNumStores = 0;
+        {
+            GrContextFactory factory(cacheOptions);
+            GrDirectContext* dContext = factory.get(contextType);
+            REPORTER_ASSERT(reporter, dContext);
+            if (!dContext) {
+                continue;
+            }
+            REPORTER_ASSERT(reporter, storage.fNumLoads == 1, "%d", storage.fNumLoads);
+            REPORTER_ASSERT(reporter, draw(dContext) == SK_ColorRED);
+        }
+
+        // Data from another pipeline cache version isn't passed to the driver.
+        if (stored && stored->size() >= 16 + VK_UUID_SIZE) {
+            sk_sp<SkData> corrupt = SkData::MakeWithCopy(stored->data(), stored->size());
+            static_cast<uint8_t*>(corrupt->writable_data())[16] ^= 0xFF;
+            storage.fData = corrupt;
+            GrContextFactory factory(cacheOptions);
+            GrDirectContext* dContext = factory.get(contextType);
+            REPORTER_ASSERT(reporter, dContext && draw(dContext) == SK_ColorRED);
+        }
+    }
+}
+
+#endif
@@ -12,6 +12,7 @@
 #include "include/core/SkTypes.h"
 #include "src/base/SkRandom.h"
 #include "src/base/SkVx.h"
+#include "src/core/SkCurveBatch.h"
 #include "src/core/SkGeometry.h"
 #include "src/gpu/tessellate/Tessellation.h"
 #include "src/gpu/tessellate/WangsFormula.h"
@@ -22,6 +23,7 @@
 #include <cstring>
 #include <functional>
 #include <limits>
+#include <vector>
 
 namespace skgpu::tess {
 
@@ -322,6 +324,91 @@ DEF_TEST(wangs_formula_vectorXforms, r) {
     });
 }
 
+// Ensure the batched SoA versions match evaluating one curve at a time.
+DEF_TEST(wangs_formula_batch, r) {
+    auto nearly_equal = [](float a, float b) {
+        return a == b || std::abs(a - b) <= 1e-5f * std::max(std::abs(a), std::abs(b));
+    };
+
+    SkRandom rand;
+    std::vector<SkPoint> cubics, quads;
+    for (int n = 0; n < 5; ++n) {
+        for_random_beziers(4, &rand, [&](const SkPoint pts[]) {
+            cubics.insert(cubics.end(), pts, pts + 4);
+        }, 10);
+        for_random_beziers(3, &rand, [&](const SkPoint pts[]) {
+            quads.insert(quads.end(), pts, pts + 3);
+        }, 10);
+    }
+    cubics.insert(cubics.end(), kSerp, kSerp + 4);
+    cubics.insert(cubics.end(), kLoop, kLoop + 4);
+    quads.insert(quads.end(), kQuad, kQuad + 3);
+
+    const int cubicCount = cubics.size() / 4;
+    const int quadCount = quads.size() / 3;
+    std::vector<float> cx[4], cy[4], qx[3], qy[3];
+    for (int i = 0; i < cubicCount; ++i) {
+        for (int k = 0; k < 4; ++k) {
+            cx[k].push_back(cubics[4*i + k].fX);
+            cy[k].push_back(cubics[4*i + k].fY);
+        }
+    }
+    for (int i = 0; i < quadCount; ++i) {
+        for (int k = 0; k < 3; ++k) {
+            qx[k].push_back(quads[3*i + k].fX);
+            qy[k].push_back(quads[3*i + k].fY);
+        }
+    }
+    const float* const cxs[4] = {cx[0].data(), cx[1].data(), cx[2].data(), cx[3].data()};
+    const float* const cys[4] = {cy[0].data(), cy[1].data(), cy[2].data(), cy[3].data()};
+    const float* const qxs[3] = {qx[0].data(), qx[1].data(), qx[2].data()};
+    const float* const qys[3] = {qy[0].data(), qy[1].data(), qy[2].data()};
+
+    for (const SkMatrix& m : {SkMatrix::I(),
+                              SkMatrix::Scale(1.5f, 0.25f),
+                              SkMatrix::MakeAll(.9f, 0.9f, 0, 1.1f, 1.1f, 0, 0, 0, 1)}) {
+        const wangs_formula::VectorXform xform(m);
+
+        std::vector<float> n4(cubicCount);
+        wangs_formula::cubic_p4(kPrecision, cxs, cys, cubicCount, n4.data(), xform);
+        for (int i = 0; i < cubicCount; ++i) {
+            float expected = wangs_formula::cubic_p4(kPrecision, &cubics[4*i], xform);
+            REPORTER_ASSERT(r, nearly_equal(n4[i], expected), "%g != %g", n4[i], expected);
+        }
+
+        n4.resize(quadCount);
+        wangs_formula::quadratic_p4(kPrecision, qxs, qys, quadCount, n4.data(), xform);
+        for (int i = 0; i < quadCount; ++i) {
+            float expected = wangs_formula::quadratic_p4(kPrecision, &quads[3*i], xform);
+            REPORTER_ASSERT(r, nearly_equal(n4[i], expected), "%g != %g", n4[i], expected);
+        }
+    }
+
+    // The batched chop matches SkChopCubicAt, including at the ends.
+    std::vector<float> t(cubicCount);
+    for (int i = 0; i < cubicCount; ++i) {
+        t[i] = i % 5 == 0 ? 1.f : i % 7 == 0 ? 0.f : rand.nextF();
+    }
+    std::vector<float> dx[7], dy[7];
+    for (int k = 0; k < 7; ++k) {
+        dx[k].resize(cubicCount);
+        dy[k].resize(cubicCount);
+    }
+    float* const dxs[7] = {dx[0].data(), dx[1].data(), dx[2].data(), dx[3].data(),
+                           dx[4].data(), dx[5].data(), dx[6].data()};
+    float* const dys[7] = {dy[0].data(), dy[1].data(), dy[2].data(), dy[3].data(),
+                           dy[4].data(), dy[5].data(), dy[6].data()};
+    SkOpts::chop_cubics_at(cxs, cys, t.data(), cubicCount, dxs, dys);
+    for (int i = 0; i < cubicCount; ++i) {
+        SkPoint expected[7];
+        SkChopCubicAt(&cubics[4*i], expected, t[i]);
+        for (int k = 0; k < 7; ++k) {
+            REPORTER_ASSERT(r, nearly_equal(dx[k][i], expected[k].fX) &&
+                               nearly_equal(dy[k][i], expected[k].fY));
+        }
+    }
+}
+
 DEF_TEST(wangs_formula_worst_case_cubic, r) {
     {
         SkPoint worstP[] = {{0,0}, {100,100}, {0,0}, {0,0}};
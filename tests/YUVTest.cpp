@@ -7,10 +7,17 @@
 
 #include "include/codec/SkCodec.h"
 #include "include/codec/SkEncodedOrigin.h"
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
 #include "include/core/SkColorType.h"
 #include "include/core/SkData.h"
+#include "include/core/SkGraphics.h"
+#include "include/core/SkImage.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkPixmap.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkSamplingOptions.h"
 #include "include/core/SkScalar.h"
 #include "include/core/SkSize.h"
 #include "include/core/SkStream.h"
@@ -23,9 +30,11 @@
 #include "tests/Test.h"
 #include "tools/Resources.h"
 
+#include <algorithm>
 #include <cmath>
 #include <cstdint>
 #include <memory>
+#include <tuple>
 #include <utility>
 
 static void codec_yuv(skiatest::Reporter* reporter,
@@ -141,6 +150,31 @@ DEF_TEST(Jpeg_YUV_Codec, r) {
     codec_yuv(r, "images/arrow.png", nullptr);
 }
 
+DEF_TEST(Webp_YUV_Codec, r) {
+    auto setExpectations = [](SkISize dims, SkYUVAInfo::PlaneConfig planeConfig) {
+        return SkYUVAInfo(dims,
+                          planeConfig,
+                          SkYUVAInfo::Subsampling::k420,
+                          kRec601_Limited_SkYUVColorSpace,
+                          kTopLeft_SkEncodedOrigin,
+                          SkYUVAInfo::Siting::kCentered,
+                          SkYUVAInfo::Siting::kCentered);
+    };
+
+    SkYUVAInfo expectations = setExpectations({800, 800}, SkYUVAInfo::PlaneConfig::kY_U_V);
+    codec_yuv(r, "images/webp-color-profile-lossy.webp", &expectations);
+
+    // Odd dimensions, with an alpha plane.
+    expectations = setExpectations({386, 395}, SkYUVAInfo::PlaneConfig::kY_U_V_A);
+    codec_yuv(r, "images/baby_tux.webp", &expectations);
+
+    // Lossless images should fail.
+    codec_yuv(r, "images/webp-color-profile-lossless.webp", nullptr);
+    codec_yuv(r, "images/color_wheel.webp", nullptr);
+    // Animated images should fail.
+    codec_yuv(r, "images/stoplight.webp", nullptr);
+}
+
 SkYUVAPixmaps decode_yuva(skiatest::Reporter* r, std::unique_ptr<SkStream> stream) {
     static constexpr auto kAllTypes = SkYUVAPixmapInfo::SupportedDataTypes::All();
     SkYUVAPixmaps result;
@@ -207,6 +241,100 @@ DEF_TEST(Jpeg_YUV_Encode, r) {
     }
 }
 
+// Returns rows [top, top + height) of |src| as SkYUVAPixmaps of their own, sharing |src|'s memory.
+static SkYUVAPixmaps yuva_stripe(const SkYUVAPixmaps& src, int top, int height) {
+    const SkYUVAInfo& srcInfo = src.yuvaInfo();
+    SkYUVAInfo info({srcInfo.width(), height},
+                    srcInfo.planeConfig(),
+                    srcInfo.subsampling(),
+                    srcInfo.yuvColorSpace());
+    SkISize dimensions[SkYUVAInfo::kMaxPlanes];
+    info.planeDimensions(dimensions);
+    SkPixmap planes[SkYUVAInfo::kMaxPlanes];
+    for (int i = 0; i < src.numPlanes(); ++i) {
+        const int ssVert = std::get<1>(srcInfo.planeSubsamplingFactors(i));
+        planes[i] = SkPixmap(src.plane(i).info().makeDimensions(dimensions[i]),
+                             src.plane(i).addr(0, top / ssVert),
+                             src.plane(i).rowBytes());
+    }
+    return SkYUVAPixmaps::FromExternalPixmaps(info, planes);
+}
+
+// Returns a copy of Y,U,V |src| with its U and V planes interleaved into one UV plane.
+static SkYUVAPixmaps interleave_uv(const SkYUVAPixmaps& src) {
+    const SkYUVAInfo& srcInfo = src.yuvaInfo();
+    SkYUVAInfo info(srcInfo.dimensions(),
+                    SkYUVAInfo::PlaneConfig::kY_UV,
+                    srcInfo.subsampling(),
+                    srcInfo.yuvColorSpace());
+    SkYUVAPixmaps dst = SkYUVAPixmaps::Allocate(
+            SkYUVAPixmapInfo(info, SkYUVAPixmapInfo::DataType::kUnorm8, nullptr));
+    src.plane(0).readPixels(dst.plane(0));
+    const SkPixmap& u = src.plane(1);
+    const SkPixmap& v = src.plane(2);
+    for (int y = 0; y < u.height(); ++y) {
+        auto* uv = static_cast<uint8_t*>(dst.plane(1).writable_addr(0, y));
+        for (int x = 0; x < u.width(); ++x) {
+            uv[2 * x + 0] = *u.addr8(x, y);
+            uv[2 * x + 1] = *v.addr8(x, y);
+        }
+    }
+    return dst;
+}
+
+DEF_TEST(Jpeg_YUV_EncodeStripes, r) {
+    const char* paths[] = {
+            "images/color_wheel.jpg",
+            "images/mandrill_h1v1.jpg",
+            "images/mandrill_h2v1.jpg",
+            "images/cropped_mandrill.jpg",
+    };
+    for (const auto* path : paths) {
+        SkYUVAPixmaps decoded;
+        {
+            std::unique_ptr<SkStream> stream(GetResourceAsStream(path));
+            decoded = decode_yuva(r, std::move(stream));
+        }
+        if (!decoded.isValid()) {
+            continue;
+        }
+
+        for (const SkYUVAPixmaps& src : {decoded, interleave_uv(decoded)}) {
+            SkJpegEncoder::Options options;
+            SkDynamicMemoryWStream expectedStream;
+            REPORTER_ASSERT(r, SkJpegEncoder::Encode(&expectedStream, src, nullptr, options));
+            sk_sp<SkData> expected = expectedStream.detachAsData();
+
+            // Stripes that are shorter than, taller than, and not aligned to an iMCU row.
+            const int height = src.yuvaInfo().height();
+            for (int stripeHeight : {2, 6, 16, 34, height}) {
+                SkDynamicMemoryWStream stream;
+                auto encoder = SkJpegEncoder::Make(&stream, src.pixmapsInfo(), nullptr, options);
+                REPORTER_ASSERT(r, encoder);
+                for (int top = 0; top < height; top += stripeHeight) {
+                    const int rows = std::min(stripeHeight, height - top);
+                    REPORTER_ASSERT(r, encoder->encodeRows(yuva_stripe(src, top, rows)));
+                }
+                REPORTER_ASSERT(r, stream.detachAsData()->equals(expected.get()),
+                                "%s, stripes of %d", path, stripeHeight);
+            }
+
+            // Stripes have to start on a row of the subsampled planes.
+            if (std::get<1>(SkYUVAInfo::SubsamplingFactors(src.yuvaInfo().subsampling())) > 1) {
+                SkNullWStream ignored;
+                auto encoder = SkJpegEncoder::Make(&ignored, src.pixmapsInfo(), nullptr, options);
+                REPORTER_ASSERT(r, !encoder->encodeRows(yuva_stripe(src, 0, 3)));
+                REPORTER_ASSERT(r, !encoder->encodeRows(yuva_stripe(src, 0, 2)));
+            }
+
+            // An RGB stripe does not fit a YUVA encoder.
+            SkNullWStream ignored;
+            auto encoder = SkJpegEncoder::Make(&ignored, src.pixmapsInfo(), nullptr, options);
+            REPORTER_ASSERT(r, !encoder->encodeRows(src.plane(0)));
+        }
+    }
+}
+
 // Be sure that the two matrices are inverses of each other
 // (i.e. rgb2yuv and yuv2rgb
 DEF_TEST(YUVMath, reporter) {
@@ -238,3 +366,62 @@ DEF_TEST(YUVMath, reporter) {
         }
     }
 }
+
+// Raster drawing of a JPEG from its YUV planes should match drawing its RGBA decode.
+DEF_SERIAL_TEST(YUVA_RasterPlanarSampling, r) {
+    auto draw = [](const sk_sp<SkImage>& image, float dx, const SkSamplingOptions& sampling) {
+        SkBitmap bm;
+        bm.allocPixels(SkImageInfo::MakeN32Premul(image->dimensions()));
+        SkCanvas canvas(bm);
+        canvas.clear(SK_ColorTRANSPARENT);
+        canvas.drawImage(image, dx, 0, sampling);
+        return bm;
+    };
+
+    auto max_diff = [](const SkBitmap& a, const SkBitmap& b, int inset) {
+        int maxDiff = 0;
+        for (int y = inset; y < a.height() - inset; ++y) {
+            for (int x = inset; x < a.width() - inset; ++x) {
+                SkColor ca = a.getColor(x, y),
+                        cb = b.getColor(x, y);
+                for (int shift : {0, 8, 16, 24}) {
+                    int da = std::abs(int((ca >> shift) & 0xff) - int((cb >> shift) & 0xff));
+                    maxDiff = std::max(maxDiff, da);
+                }
+            }
+        }
+        return maxDiff;
+    };
+
+    struct {
+        const char*       path;
+        float             dx;
+        SkSamplingOptions sampling;
+        int               tolerance;
+    } cases[] = {
+        // 4:4:4 at an integer offset only differs by the YUV->RGB conversion's rounding.
+        {"images/mandrill_h1v1.jpg",     0.0f, SkSamplingOptions(SkFilterMode::kLinear),  2},
+        // 4:2:0 chroma is bilerped here but upsampled by the decoder before the bilerp there.
+        {"images/mandrill_512_q075.jpg", 0.5f, SkSamplingOptions(SkFilterMode::kLinear), 12},
+    };
+
+    for (const auto& c : cases) {
+        sk_sp<SkData> data = GetResourceAsData(c.path);
+        if (!data) {
+            continue;
+        }
+        sk_sp<SkImage> image = SkImages::DeferredFromEncodedData(data);
+        REPORTER_ASSERT(r, image);
+        if (!image) {
+            continue;
+        }
+
+        SkBitmap expected = draw(image, c.dx, c.sampling);
+        SkGraphics::SetRasterYUVAPlanarSampling(true);
+        SkBitmap actual = draw(SkImages::DeferredFromEncodedData(data), c.dx, c.sampling);
+        SkGraphics::SetRasterYUVAPlanarSampling(false);
+
+        int diff = max_diff(expected, actual, /*inset=*/2);
+        REPORTER_ASSERT(r, diff <= c.tolerance, "%s: max difference %d", c.path, diff);
+    }
+}
@@ -47,4 +47,51 @@ DEF_TEST(BoundsManager, r) {
     // TODO: Then test calls where the new value is not larger than the current max
 }
 
+DEF_TEST(HybridBoundsManager, r) {
+    static constexpr int kCellSize = 16;
+    static constexpr int kMaxBruteForceN = 8;
+    HybridBoundsManager bm({1024, 1024}, kCellSize, kMaxBruteForceN, /*maxGridSize=*/0);
+
+    auto drawFrame = [&](int count, float size) {
+        CompressedPaintersOrder order = CompressedPaintersOrder::First();
+        for (int i = 0; i < count; ++i) {
+            order = order.next();
+            Rect b = Rect::XYWH((i % 8) * 100.f, (i / 8 % 8) * 100.f, size, size);
+            REPORTER_ASSERT(r, bm.getMostRecentDraw(b) < order);
+            bm.recordDraw(b, order);
+            REPORTER_ASSERT(r, bm.getMostRecentDraw(b) == order);
+        }
+        bm.reset();
+        return bm.lastFrameStats();
+    };
+
+    // Few draws only use brute force.
+    HybridBoundsManager::Stats stats = drawFrame(kMaxBruteForceN, 10.f);
+    REPORTER_ASSERT(r, stats.fDrawCount == kMaxBruteForceN);
+    REPORTER_ASSERT(r, stats.fGridCellSize == 0);
+
+    // Small draws keep the requested cell size, and enough of them start the next frame on the
+    // grid.
+    stats = drawFrame(4 * kMaxBruteForceN, 10.f);
+    REPORTER_ASSERT(r, stats.fGridCellSize == kCellSize);
+    REPORTER_ASSERT(r, !stats.fStartedWithGrid);
+    stats = drawFrame(4 * kMaxBruteForceN, 10.f);
+    REPORTER_ASSERT(r, stats.fGridCellSize == kCellSize);
+    REPORTER_ASSERT(r, stats.fStartedWithGrid);
+
+    // A frame with few draws goes back to brute force for the next one.
+    stats = drawFrame(kMaxBruteForceN + 1, 10.f);
+    REPORTER_ASSERT(r, stats.fStartedWithGrid);
+    stats = drawFrame(kMaxBruteForceN, 10.f);
+    REPORTER_ASSERT(r, !stats.fStartedWithGrid);
+    REPORTER_ASSERT(r, stats.fGridCellSize == 0);
+
+    // Large draws get larger cells, up to the limit.
+    stats = drawFrame(kMaxBruteForceN + 1, 130.f);
+    REPORTER_ASSERT(r, stats.fGridCellSize == 2 * kCellSize);
+    stats = drawFrame(kMaxBruteForceN, 10.f);
+    stats = drawFrame(kMaxBruteForceN + 1, 1000.f);
+    REPORTER_ASSERT(r, stats.fGridCellSize == HybridBoundsManager::kMaxCellScale * kCellSize);
+}
+
 }  // namespace skgpu::graphite
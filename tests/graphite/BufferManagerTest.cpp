@@ -70,4 +70,33 @@ DEF_GRAPHITE_TEST_FOR_RENDERING_CONTEXTS(BufferManagerGpuOnlyBufferTest, reporte
     REPORTER_ASSERT(reporter, ssbo.fBuffer != mappedSsbo.fBuffer);
 }
 
+DEF_GRAPHITE_TEST_FOR_RENDERING_CONTEXTS(BufferManagerSizeHintTest, reporter, context,
+                                         CtsEnforcement::kNever) {
+    std::unique_ptr<Recorder> recorder = context->makeRecorder();
+    DrawBufferManager* mgr = recorder->priv().drawBufferManager();
+
+    // Each request needs most of a 16KB vertex buffer block, so the first Recording gets a buffer
+    // for each of them.
+    static constexpr size_t kRequestSize = 10 << 10;
+    static constexpr int kRequestCount = 8;
+    auto request = [&]() {
+        for (int i = 0; i < kRequestCount; ++i) {
+            REPORTER_ASSERT(reporter, mgr->getVertexStorage(kRequestSize));
+        }
+    };
+
+    request();
+    REPORTER_ASSERT(reporter, mgr->bufferAllocations() == kRequestCount);
+    REPORTER_ASSERT(reporter, mgr->unusedBytes() > 0);
+    std::unique_ptr<Recording> first = recorder->snap();
+    REPORTER_ASSERT(reporter, first->priv().stats().fBufferAllocations == kRequestCount);
+    REPORTER_ASSERT(reporter, mgr->bufferAllocations() == 0);
+
+    // The next Recording's first buffer fits everything the last one used.
+    request();
+    REPORTER_ASSERT(reporter, mgr->bufferAllocations() == 1);
+    std::unique_ptr<Recording> second = recorder->snap();
+    REPORTER_ASSERT(reporter, second->priv().stats().fBufferAllocations == 1);
+}
+
 }  // namespace skgpu::graphite
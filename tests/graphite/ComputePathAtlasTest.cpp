@@ -0,0 +1,86 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "tests/Test.h"
+
+#include "include/core/SkPath.h"
+#include "include/core/SkRRect.h"
+#include "include/core/SkRect.h"
+#include "include/gpu/graphite/Context.h"
+#include "include/gpu/graphite/Recorder.h"
+#include "src/gpu/graphite/AtlasProvider.h"
+#include "src/gpu/graphite/ComputePathAtlas.h"
+#include "src/gpu/graphite/PathAtlas.h"
+#include "src/gpu/graphite/RecorderPriv.h"
+#include "src/gpu/graphite/TextureProxy.h"
+#include "src/gpu/graphite/geom/Rect.h"
+#include "src/gpu/graphite/geom/Shape.h"
+
+using namespace skgpu::graphite;
+
+namespace {
+
+// A zigzag that fills the square with side `size` at the origin, with about `verbCount` verbs.
+SkPath make_dense_path(float size, int verbCount) {
+    SkPath path;
+    path.moveTo(0, 0);
+    const int teeth = (verbCount - 3) / 2;
+    for (int i = 0; i < teeth; ++i) {
+        const float x = size * (i + 0.5f) / teeth;
+        path.lineTo(x, size);
+        path.lineTo(x + 0.5f * size / teeth, 0);
+    }
+    path.lineTo(size, size);
+    path.close();
+    return path;
+}
+
+bool is_suitable(const PathAtlas* atlas, const Shape& shape, const Rect& clipBounds) {
+    return atlas->isSuitableForAtlasing(shape.bounds(), clipBounds, shape);
+}
+
+}  // anonymous namespace
+
+// Masks past the area threshold are only rendered by the compute atlas when their paths have
+// enough verbs for the size of the mask.
+DEF_GRAPHITE_TEST_FOR_RENDERING_CONTEXTS(ComputePathAtlasSuitabilityTest, reporter, context,
+                                         CtsEnforcement::kNever) {
+    std::unique_ptr<Recorder> recorder = context->makeRecorder();
+    std::unique_ptr<ComputePathAtlas> computeAtlas =
+            recorder->priv().atlasProvider()->createComputePathAtlas(recorder.get());
+    if (!computeAtlas) {
+        return;
+    }
+    const PathAtlas* atlas = computeAtlas.get();
+    const Rect clip = Rect::WH(4096, 4096);
+
+    // Small masks are always atlased.
+    REPORTER_ASSERT(reporter, is_suitable(atlas, Shape(SkRect::MakeWH(100, 100)), clip));
+    REPORTER_ASSERT(reporter, is_suitable(atlas, Shape(make_dense_path(100, 8)), clip));
+
+    // A 1000x1000 mask needs at least 1000 * 1000 / 256 verbs.
+    REPORTER_ASSERT(reporter, !is_suitable(atlas, Shape(SkRect::MakeWH(1000, 1000)), clip));
+    REPORTER_ASSERT(reporter,
+                    !is_suitable(atlas, Shape(SkRRect::MakeRectXY(SkRect::MakeWH(1000, 1000),
+                                                                  50, 50)), clip));
+    const SkPath sparse = make_dense_path(1000, 3000);
+    const SkPath dense = make_dense_path(1000, 5000);
+    REPORTER_ASSERT(reporter, sparse.countVerbs() < 1000 * 1000 / 256);
+    REPORTER_ASSERT(reporter, dense.countVerbs() > 1000 * 1000 / 256);
+    REPORTER_ASSERT(reporter, !is_suitable(atlas, Shape(sparse), clip));
+    REPORTER_ASSERT(reporter, is_suitable(atlas, Shape(dense), clip));
+
+    // It's the clipped mask that counts.
+    REPORTER_ASSERT(reporter, is_suitable(atlas, Shape(SkRect::MakeWH(1000, 1000)),
+                                          Rect::WH(200, 200)));
+    REPORTER_ASSERT(reporter, is_suitable(atlas, Shape(sparse), Rect::WH(200, 200)));
+
+    // However dense, a mask larger than the atlas isn't atlased.
+    REPORTER_ASSERT(reporter, !is_suitable(atlas, Shape(make_dense_path(atlas->width() + 1.f,
+                                                                        100000)),
+                                           Rect::WH(8192, 8192)));
+}
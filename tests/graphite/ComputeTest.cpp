@@ -8,9 +8,12 @@
 #include "tests/Test.h"
 
 #include "include/core/SkBitmap.h"
+#include "include/core/SkSurfaceProps.h"
 #include "include/gpu/graphite/Context.h"
+#include "include/gpu/graphite/Image.h"
 #include "include/gpu/graphite/Recorder.h"
 #include "include/gpu/graphite/Recording.h"
+#include "include/private/base/SkTo.h"
 #include "src/gpu/graphite/Buffer.h"
 #include "src/gpu/graphite/Caps.h"
 #include "src/gpu/graphite/ComputePipelineDesc.h"
@@ -18,7 +21,10 @@
 #include "src/gpu/graphite/ContextPriv.h"
 #include "src/gpu/graphite/RecorderPriv.h"
 #include "src/gpu/graphite/ResourceProvider.h"
+#include "src/gpu/graphite/SpecialImage_Graphite.h"
+#include "src/gpu/graphite/TextureUtils.h"
 #include "src/gpu/graphite/UniformManager.h"
+#include "src/gpu/graphite/compute/ComputeBlur.h"
 #include "src/gpu/graphite/compute/ComputeStep.h"
 #include "src/gpu/graphite/compute/DispatchGroup.h"
 #include "src/gpu/graphite/task/ComputeTask.h"
@@ -28,6 +34,11 @@
 
 #include "tools/graphite/GraphiteTestContext.h"
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
 using namespace skgpu::graphite;
 using namespace skiatest::graphite;
 
@@ -2644,3 +2655,280 @@ DEF_GRAPHITE_TEST_FOR_DAWN_CONTEXT(Compute_NativeShaderSourceWGSL, reporter, con
                     kExpectedCount,
                     result);
 }
+
+// Tests that the box blurs approximate the Gaussian's variance and that a compute blur leaves a
+// solid color unchanged when the edges are clamped.
+DEF_GRAPHITE_TEST_FOR_DAWN_AND_METAL_CONTEXTS(Compute_BoxBlur,
+                                              reporter,
+                                              context,
+                                              testContext) {
+    for (float sigma : {20.f, 33.3f, 50.f, 128.f}) {
+        float variance = 0.f;
+        for (int radius : ComputeBlurBoxRadii(sigma)) {
+            variance += radius * (radius + 1) / 3.f;  // ((2r + 1)^2 - 1) / 12
+        }
+        REPORTER_ASSERT(reporter, std::abs(std::sqrt(variance) - sigma) < 0.05f * sigma,
+                        "sigma %.1f, box blurs have sigma %.1f", sigma, std::sqrt(variance));
+    }
+
+    std::unique_ptr<Recorder> recorder = context->makeRecorder();
+
+    constexpr int kDim = 64;
+    constexpr SkColor kColor = SkColorSetARGB(255, 32, 128, 224);
+    SkBitmap srcBitmap;
+    srcBitmap.allocPixels(SkImageInfo::Make(kDim, kDim, kRGBA_8888_SkColorType,
+                                            kPremul_SkAlphaType));
+    srcBitmap.eraseColor(kColor);
+    sk_sp<SkImage> srcImage = SkImages::TextureFromImage(recorder.get(), srcBitmap.asImage());
+    if (!srcImage) {
+        ERRORF(reporter, "Could not upload the source image");
+        return;
+    }
+
+    const SkIRect bounds = SkIRect::MakeWH(kDim, kDim);
+    sk_sp<SkSpecialImage> blurred = ComputeBlur(
+            recorder.get(),
+            {30.f, 40.f},
+            SkSpecialImages::MakeGraphite(recorder.get(), bounds, srcImage, SkSurfaceProps()),
+            bounds,
+            SkTileMode::kClamp,
+            bounds,
+            /*outCS=*/nullptr,
+            SkSurfaceProps());
+    if (!blurred) {
+        ERRORF(reporter, "Failed to blur with compute shaders");
+        return;
+    }
+
+    std::unique_ptr<Recording> recording = recorder->snap();
+    if (!recording) {
+        ERRORF(reporter, "Failed to make recording");
+        return;
+    }
+
+    InsertRecordingInfo insertInfo;
+    insertInfo.fRecording = recording.get();
+    context->insertRecording(insertInfo);
+    testContext->syncedSubmit(context);
+
+    SkBitmap bitmap;
+    SkImageInfo imgInfo =
+            SkImageInfo::Make(kDim, kDim, kRGBA_8888_SkColorType, kPremul_SkAlphaType);
+    bitmap.allocPixels(imgInfo);
+    SkPixmap pixels;
+    bool peekPixelsSuccess = bitmap.peekPixels(&pixels);
+    REPORTER_ASSERT(reporter, peekPixelsSuccess);
+
+    TextureProxyView blurredView = AsView(blurred->asImage());
+    bool readPixelsSuccess =
+            context->priv().readPixels(pixels, blurredView.proxy(), imgInfo, 0, 0);
+    REPORTER_ASSERT(reporter, readPixelsSuccess);
+
+    for (int y = 0; y < kDim; ++y) {
+        for (int x = 0; x < kDim; ++x) {
+            SkColor color = pixels.getColor(x, y);
+            bool matches = true;
+            for (int shift : {0, 8, 16, 24}) {
+                matches &= std::abs(int((color >> shift) & 0xFF) -
+                                    int((kColor >> shift) & 0xFF)) <= 1;
+            }
+            REPORTER_ASSERT(reporter, matches,
+                            "At position {%d, %d}, expected 0x%08x, found 0x%08x",
+                            x, y, kColor, color);
+        }
+    }
+}
+
+namespace {
+
+using BlurLine = std::vector<std::array<float, 4>>;
+
+// The texel that the compute blur reads for (c, other) along an axis, following its SkSL.
+int tile_coord(int c, int lo, int hi, SkTileMode mode) {
+    const int n = hi - lo;
+    switch (mode) {
+        case SkTileMode::kRepeat:
+            return lo + ((c - lo) % n + n) % n;
+        case SkTileMode::kMirror: {
+            const int t = ((c - lo) % (2 * n) + 2 * n) % (2 * n);
+            return lo + (t < n ? t : 2 * n - 1 - t);
+        }
+        default:
+            return std::clamp(c, lo, hi - 1);
+    }
+}
+
+// Applies the box blurs one after another to 'line', which holds the sum of their radii on either
+// side of the pixels that are returned.
+BlurLine box_blur_line(BlurLine line, const std::array<int, 3>& radii) {
+    const int n = SkToInt(line.size());
+    int lo = 0;
+    for (int r : radii) {
+        lo += r;
+        if (r == 0) {
+            continue;
+        }
+        BlurLine boxed = line;
+        for (int i = lo; i < n - lo; ++i) {
+            std::array<float, 4> sum = {0, 0, 0, 0};
+            for (int k = i - r; k <= i + r; ++k) {
+                for (int c = 0; c < 4; ++c) {
+                    sum[c] += line[k][c];
+                }
+            }
+            for (int c = 0; c < 4; ++c) {
+                boxed[i][c] = sum[c] / (2 * r + 1);
+            }
+        }
+        line = std::move(boxed);
+    }
+    return BlurLine(line.begin() + lo, line.end() - lo);
+}
+
+// Both passes write to RGBA 8888 textures.
+std::array<float, 4> quantize(const std::array<float, 4>& color) {
+    std::array<float, 4> result;
+    for (int c = 0; c < 4; ++c) {
+        result[c] = std::round(std::clamp(color[c], 0.f, 1.f) * 255) / 255;
+    }
+    return result;
+}
+
+// What ComputeBlur() should produce for 'src', blurring its own bounds into 'dstRect'.
+std::vector<BlurLine> reference_box_blur(const SkPixmap& src,
+                                         SkSize sigma,
+                                         SkTileMode mode,
+                                         const SkIRect& dstRect) {
+    const std::array<int, 3> radiiX = ComputeBlurBoxRadii(sigma.width());
+    const std::array<int, 3> radiiY = ComputeBlurBoxRadii(sigma.height());
+    const int radiusX = radiiX[0] + radiiX[1] + radiiX[2];
+    const int radiusY = radiiY[0] + radiiY[1] + radiiY[2];
+
+    // The rows of the intermediate texture.
+    std::vector<BlurLine> rows;
+    for (int j = 0; j < dstRect.height() + 2 * radiusY; ++j) {
+        const int y = dstRect.top() - radiusY + j;
+        BlurLine line;
+        for (int i = 0; i < dstRect.width() + 2 * radiusX; ++i) {
+            const int x = dstRect.left() - radiusX + i;
+            std::array<float, 4> texel = {0, 0, 0, 0};
+            if (mode != SkTileMode::kDecal || src.bounds().contains(x, y)) {
+                const uint8_t* p = static_cast<const uint8_t*>(
+                        src.addr(tile_coord(x, 0, src.width(), mode),
+                                 tile_coord(y, 0, src.height(), mode)));
+                texel = {p[0] / 255.f, p[1] / 255.f, p[2] / 255.f, p[3] / 255.f};
+            }
+            line.push_back(texel);
+        }
+        line = box_blur_line(std::move(line), radiiX);
+        for (auto& texel : line) {
+            texel = quantize(texel);
+        }
+        rows.push_back(std::move(line));
+    }
+
+    std::vector<BlurLine> result(dstRect.height(), BlurLine(dstRect.width()));
+    for (int x = 0; x < dstRect.width(); ++x) {
+        BlurLine column;
+        for (const BlurLine& row : rows) {
+            column.push_back(row[x]);
+        }
+        column = box_blur_line(std::move(column), radiiY);
+        for (int y = 0; y < dstRect.height(); ++y) {
+            result[y][x] = quantize(column[y]);
+        }
+    }
+    return result;
+}
+
+}  // namespace
+
+// Tests that compute blurs of a translucent gradient, which doesn't hide swapped axes, offsets or
+// tiling mistakes the way a solid color does, match blurring it on the CPU the same way.
+DEF_GRAPHITE_TEST_FOR_DAWN_AND_METAL_CONTEXTS(Compute_BoxBlurGradient,
+                                              reporter,
+                                              context,
+                                              testContext) {
+    std::unique_ptr<Recorder> recorder = context->makeRecorder();
+
+    // Not square, so that rows and columns differ. Red increases to the right, green downwards,
+    // and blue and alpha vary with both.
+    constexpr int kWidth = 64;
+    constexpr int kHeight = 40;
+    SkBitmap srcBitmap;
+    srcBitmap.allocPixels(SkImageInfo::Make(kWidth, kHeight, kRGBA_8888_SkColorType,
+                                            kPremul_SkAlphaType));
+    for (int y = 0; y < kHeight; ++y) {
+        for (int x = 0; x < kWidth; ++x) {
+            const float a = 0.25f + 0.75f * (x + y) / (kWidth + kHeight - 2);
+            const float r = a * x / (kWidth - 1);
+            const float g = a * y / (kHeight - 1);
+            const float b = a * ((x / 8 + y / 8) % 2);
+            uint8_t* p = static_cast<uint8_t*>(srcBitmap.getAddr(x, y));
+            p[0] = SkToU8(std::lround(r * 255));
+            p[1] = SkToU8(std::lround(g * 255));
+            p[2] = SkToU8(std::lround(b * 255));
+            p[3] = SkToU8(std::lround(a * 255));
+        }
+    }
+    srcBitmap.setImmutable();
+    sk_sp<SkImage> srcImage = SkImages::TextureFromImage(recorder.get(), srcBitmap.asImage());
+    if (!srcImage) {
+        ERRORF(reporter, "Could not upload the source image");
+        return;
+    }
+    const SkIRect srcBounds = SkIRect::MakeWH(kWidth, kHeight);
+    sk_sp<SkSpecialImage> input =
+            SkSpecialImages::MakeGraphite(recorder.get(), srcBounds, srcImage, SkSurfaceProps());
+
+    // The output extends past the source, where the tile mode matters most.
+    const SkIRect dstRect = SkIRect::MakeLTRB(-12, -8, kWidth + 12, kHeight + 8);
+    const SkSize sigmas[] = {{24.f, 36.f}, {30.f, 0.f}, {0.f, 30.f}};
+    const SkTileMode tileModes[] = {SkTileMode::kClamp, SkTileMode::kRepeat, SkTileMode::kMirror,
+                                    SkTileMode::kDecal};
+
+    for (SkSize sigma : sigmas) {
+        for (SkTileMode tileMode : tileModes) {
+            sk_sp<SkSpecialImage> blurred = ComputeBlur(recorder.get(), sigma, input, srcBounds,
+                                                        tileMode, dstRect, /*outCS=*/nullptr,
+                                                        SkSurfaceProps());
+            if (!blurred) {
+                ERRORF(reporter, "Failed to blur with compute shaders");
+                return;
+            }
+            if (!submit_recording(context, testContext, recorder.get())) {
+                ERRORF(reporter, "Failed to make recording");
+                return;
+            }
+
+            SkBitmap bitmap;
+            bitmap.allocPixels(SkImageInfo::Make(dstRect.size(), kRGBA_8888_SkColorType,
+                                                 kPremul_SkAlphaType));
+            TextureProxyView blurredView = AsView(blurred->asImage());
+            REPORTER_ASSERT(reporter, context->priv().readPixels(bitmap.pixmap(),
+                                                                 blurredView.proxy(),
+                                                                 bitmap.info(), 0, 0));
+
+            const std::vector<BlurLine> expected =
+                    reference_box_blur(srcBitmap.pixmap(), sigma, tileMode, dstRect);
+            // The intermediate values are held as halfs and rounded to 8 bits between the passes.
+            constexpr float kTolerance = 2.5f / 255;
+            bool matches = true;
+            for (int y = 0; y < dstRect.height() && matches; ++y) {
+                for (int x = 0; x < dstRect.width() && matches; ++x) {
+                    const uint8_t* p = static_cast<const uint8_t*>(bitmap.getAddr(x, y));
+                    for (int c = 0; c < 4; ++c) {
+                        if (std::abs(p[c] / 255.f - expected[y][x][c]) > kTolerance) {
+                            ERRORF(reporter, "sigma {%.1f, %.1f}, tile mode %d: channel %d at "
+                                   "{%d, %d} is %d, expected %.1f",
+                                   sigma.width(), sigma.height(), static_cast<int>(tileMode), c,
+                                   x, y, p[c], expected[y][x][c] * 255);
+                            matches = false;
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,179 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "tests/Test.h"
+
+#include "include/core/SkData.h"
+#include "include/gpu/graphite/Context.h"
+#include "include/gpu/graphite/PersistentPipelineStorage.h"
+#include "include/gpu/graphite/Recorder.h"
+#include "src/gpu/graphite/Caps.h"
+#include "src/gpu/graphite/RecorderPriv.h"
+#include "src/gpu/graphite/dawn/DawnSharedContext.h"
+#include "src/gpu/graphite/dawn/DawnShaderModuleCache.h"
+#include "src/sksl/SkSLProgramKind.h"
+#include "src/sksl/SkSLProgramSettings.h"
+
+#include "webgpu/webgpu_cpp.h"  // NO_G3_REWRITE
+
+#include <cstring>
+#include <string>
+
+using namespace skgpu::graphite;
+
+namespace {
+
+constexpr char kSkSL[] = "layout(local_size_x = 16, local_size_y = 1, local_size_z = 1) in;\n"
+                         "void main() {}\n";
+
+class MemoryStorage final : public PersistentPipelineStorage {
+public:
+    sk_sp<SkData> load(const SkData&) override { return fData; }
+    void store(const SkData&, const SkData& data) override {
+        fData = SkData::MakeWithCopy(data.data(), data.size());
+    }
+
+    sk_sp<SkData> fData;
+};
+
+// Returns whether the cache has a module for kSkSL, along with the WGSL it was compiled from.
+bool find_or_create(DawnShaderModuleCache* cache,
+                    const DawnSharedContext* sharedContext,
+                    std::string* wgsl) {
+    wgpu::ShaderModule module;
+    SkSL::ProgramInterface interface;
+    SkSL::ProgramSettings settings;
+    return cache->findOrCreate(sharedContext,
+                               "DawnShaderModuleCacheTest",
+                               kSkSL,
+                               SkSL::ProgramKind::kCompute,
+                               settings,
+                               &module,
+                               wgsl,
+                               &interface,
+                               sharedContext->caps()->shaderErrorHandler()) &&
+           module;
+}
+
+// Returns a copy of the data with the first occurrence of `from` overwritten by `to`, which has to
+// be as long.
+sk_sp<SkData> replace(const SkData& data, const std::string& from, const std::string& to) {
+    SkASSERT(from.size() == to.size());
+    const std::string bytes(static_cast<const char*>(data.data()), data.size());
+    const size_t offset = bytes.find(from);
+    SkASSERT(offset != std::string::npos);
+    sk_sp<SkData> copy = SkData::MakeWithCopy(data.data(), data.size());
+    memcpy(static_cast<char*>(copy->writable_data()) + offset, to.data(), to.size());
+    return copy;
+}
+
+}  // anonymous namespace
+
+DEF_GRAPHITE_TEST_FOR_DAWN_CONTEXT(DawnShaderModuleCacheStorageTest, reporter, context,
+                                   testContext) {
+    std::unique_ptr<Recorder> recorder = context->makeRecorder();
+    const auto* sharedContext =
+            static_cast<const DawnSharedContext*>(recorder->priv().sharedContext());
+
+    MemoryStorage storage;
+    std::string generatedWGSL;
+    {
+        DawnShaderModuleCache cache(&storage);
+        REPORTER_ASSERT(reporter, find_or_create(&cache, sharedContext, &generatedWGSL));
+        REPORTER_ASSERT(reporter, cache.numEntries() == 1);
+        cache.syncPipelineData(SIZE_MAX);
+    }
+    REPORTER_ASSERT(reporter, storage.fData);
+    const size_t newline = generatedWGSL.find('\n');
+    REPORTER_ASSERT(reporter, newline != std::string::npos);
+    if (!storage.fData || newline == std::string::npos) {
+        return;
+    }
+    const sk_sp<SkData> data = storage.fData;
+
+    // The same WGSL with a space for its first line break, which only stored WGSL can have.
+    std::string storedWGSL = generatedWGSL;
+    storedWGSL[newline] = ' ';
+
+    // The WGSL is loaded back instead of being generated again.
+    {
+        storage.fData = replace(*data, generatedWGSL, storedWGSL);
+        DawnShaderModuleCache cache(&storage);
+        std::string wgsl;
+        REPORTER_ASSERT(reporter, find_or_create(&cache, sharedContext, &wgsl));
+        REPORTER_ASSERT(reporter, wgsl == storedWGSL);
+        REPORTER_ASSERT(reporter, cache.numEntries() == 1);
+    }
+
+    // WGSL stored for other SkSL isn't used.
+    {
+        storage.fData = replace(*replace(*data, generatedWGSL, storedWGSL),
+                                "void main() {}", "void main(){ }");
+        DawnShaderModuleCache cache(&storage);
+        std::string wgsl;
+        REPORTER_ASSERT(reporter, find_or_create(&cache, sharedContext, &wgsl));
+        REPORTER_ASSERT(reporter, wgsl == generatedWGSL);
+        REPORTER_ASSERT(reporter, cache.numEntries() == 2);
+    }
+
+    // Stored WGSL that doesn't compile is replaced by WGSL generated from the SkSL, which is what
+    // gets stored next.
+    {
+        storage.fData = replace(*data, generatedWGSL, std::string(generatedWGSL.size(), '#'));
+        DawnShaderModuleCache cache(&storage);
+        std::string wgsl;
+        REPORTER_ASSERT(reporter, find_or_create(&cache, sharedContext, &wgsl));
+        REPORTER_ASSERT(reporter, wgsl == generatedWGSL);
+        REPORTER_ASSERT(reporter, cache.numEntries() == 1);
+
+        cache.syncPipelineData(SIZE_MAX);
+        REPORTER_ASSERT(reporter, storage.fData->equals(data.get()));
+    }
+}
+
+DEF_GRAPHITE_TEST_FOR_DAWN_CONTEXT(DawnShaderModuleCacheMalformedStorageTest, reporter, context,
+                                   testContext) {
+    std::unique_ptr<Recorder> recorder = context->makeRecorder();
+    const auto* sharedContext =
+            static_cast<const DawnSharedContext*>(recorder->priv().sharedContext());
+
+    MemoryStorage storage;
+    std::string generatedWGSL;
+    {
+        DawnShaderModuleCache cache(&storage);
+        REPORTER_ASSERT(reporter, find_or_create(&cache, sharedContext, &generatedWGSL));
+        cache.syncPipelineData(SIZE_MAX);
+    }
+    REPORTER_ASSERT(reporter, storage.fData && storage.fData->size() > 8);
+    if (!storage.fData || storage.fData->size() <= 8) {
+        return;
+    }
+    const sk_sp<SkData> data = storage.fData;
+
+    // A truncated entry is ignored, and its shader is generated again.
+    for (size_t size = 0; size < data->size(); ++size) {
+        storage.fData = SkData::MakeWithCopy(data->data(), size);
+        DawnShaderModuleCache cache(&storage);
+        std::string wgsl;
+        REPORTER_ASSERT(reporter, find_or_create(&cache, sharedContext, &wgsl), "size %zu", size);
+        REPORTER_ASSERT(reporter, wgsl == generatedWGSL, "size %zu", size);
+        REPORTER_ASSERT(reporter, cache.numEntries() == 1, "size %zu", size);
+    }
+
+    // A count past the end of the data loads the entries that are there, and a length past it
+    // loads nothing.
+    for (size_t offset : {0, 4}) {
+        storage.fData = SkData::MakeWithCopy(data->data(), data->size());
+        const uint32_t huge = 0xFFFFFFFF;
+        memcpy(static_cast<char*>(storage.fData->writable_data()) + offset, &huge, sizeof(huge));
+        DawnShaderModuleCache cache(&storage);
+        std::string wgsl;
+        REPORTER_ASSERT(reporter, find_or_create(&cache, sharedContext, &wgsl));
+        REPORTER_ASSERT(reporter, wgsl == generatedWGSL, "offset %zu", offset);
+        REPORTER_ASSERT(reporter, cache.numEntries() == 1, "offset %zu", offset);
+    }
+}
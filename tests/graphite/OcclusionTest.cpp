@@ -0,0 +1,183 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "tests/Test.h"
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkBlendMode.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkSurface.h"
+#include "include/gpu/graphite/Context.h"
+#include "include/gpu/graphite/Recorder.h"
+#include "include/gpu/graphite/Surface.h"
+#include "src/core/SkCanvasPriv.h"
+#include "src/core/SkDevice.h"
+#include "src/gpu/graphite/Device.h"
+
+#include <functional>
+
+using namespace skgpu::graphite;
+
+namespace {
+
+constexpr SkColor kOccluderColor = SK_ColorYELLOW;
+
+int num_pending_occluded_draws(SkCanvas* canvas) {
+    Device* device = SkCanvasPriv::TopDevice(canvas)->asGraphiteDevice();
+    return device ? device->numPendingOccludedDraws() : -1;
+}
+
+void draw_rect(SkCanvas* canvas, const SkRect& rect, SkColor color, bool antiAlias = false) {
+    SkPaint paint;
+    paint.setColor(color);
+    paint.setAntiAlias(antiAlias);
+    canvas->drawRect(rect, paint);
+}
+
+// Draws a red rect and a blue circle well inside (10, 10, 200, 200), and a green rect that crosses
+// its bottom right corner.
+void draw_background(SkCanvas* canvas) {
+    canvas->clear(SK_ColorWHITE);
+    draw_rect(canvas, SkRect::MakeLTRB(20, 20, 60, 60), SK_ColorRED);
+    SkPaint paint;
+    paint.setColor(SK_ColorBLUE);
+    paint.setAntiAlias(true);
+    canvas->drawCircle(100, 100, 20, paint);
+    draw_rect(canvas, SkRect::MakeLTRB(150, 150, 250, 250), SK_ColorGREEN);
+}
+
+}  // anonymous namespace
+
+// Draws entirely behind a later opaque rect are skipped, and the rendering is unchanged.
+DEF_GRAPHITE_TEST_FOR_RENDERING_CONTEXTS(OcclusionCullingTest, reporter, context,
+                                         CtsEnforcement::kNever) {
+    std::unique_ptr<Recorder> recorder = context->makeRecorder();
+    const SkImageInfo ii = SkImageInfo::Make(256, 256, kRGBA_8888_SkColorType, kPremul_SkAlphaType);
+    sk_sp<SkSurface> surface = SkSurfaces::RenderTarget(recorder.get(), ii);
+    REPORTER_ASSERT(reporter, surface);
+    if (!surface) {
+        return;
+    }
+    SkCanvas* canvas = surface->getCanvas();
+
+    draw_background(canvas);
+    draw_rect(canvas, SkRect::MakeLTRB(10, 10, 200, 200), kOccluderColor);
+    // Draws on top of the occluder are kept.
+    draw_rect(canvas, SkRect::MakeLTRB(30, 30, 50, 50), SK_ColorMAGENTA);
+    REPORTER_ASSERT(reporter, num_pending_occluded_draws(canvas) == 2,
+                    "%d", num_pending_occluded_draws(canvas));
+
+    SkBitmap result;
+    result.allocPixels(ii);
+    REPORTER_ASSERT(reporter, surface->readPixels(result, 0, 0));
+    REPORTER_ASSERT(reporter, result.getColor(40, 40) == SK_ColorMAGENTA);
+    REPORTER_ASSERT(reporter, result.getColor(25, 25) == kOccluderColor);
+    REPORTER_ASSERT(reporter, result.getColor(100, 100) == kOccluderColor);
+    REPORTER_ASSERT(reporter, result.getColor(190, 190) == kOccluderColor);
+    REPORTER_ASSERT(reporter, result.getColor(220, 220) == SK_ColorGREEN);
+    REPORTER_ASSERT(reporter, result.getColor(5, 5) == SK_ColorWHITE);
+}
+
+// Rects that don't fully hide what's under them, or are too small to bother with, don't occlude.
+DEF_GRAPHITE_TEST_FOR_RENDERING_CONTEXTS(OcclusionNonOccludersTest, reporter, context,
+                                         CtsEnforcement::kNever) {
+    std::unique_ptr<Recorder> recorder = context->makeRecorder();
+    const SkImageInfo ii = SkImageInfo::Make(256, 256, kRGBA_8888_SkColorType, kPremul_SkAlphaType);
+    sk_sp<SkSurface> surface = SkSurfaces::RenderTarget(recorder.get(), ii);
+    REPORTER_ASSERT(reporter, surface);
+    if (!surface) {
+        return;
+    }
+    SkCanvas* canvas = surface->getCanvas();
+    const SkRect occluder = SkRect::MakeLTRB(10, 10, 200, 200);
+
+    const struct {
+        const char* fName;
+        std::function<void(SkCanvas*)> fDraw;
+    } kCases[] = {
+        {"translucent", [&](SkCanvas* c) { draw_rect(c, occluder, 0x80FFFF00); }},
+        {"blended", [&](SkCanvas* c) {
+            SkPaint paint;
+            paint.setColor(kOccluderColor);
+            paint.setBlendMode(SkBlendMode::kMultiply);
+            c->drawRect(occluder, paint);
+        }},
+        {"stroked", [&](SkCanvas* c) {
+            SkPaint paint;
+            paint.setColor(kOccluderColor);
+            paint.setStyle(SkPaint::kStroke_Style);
+            paint.setStrokeWidth(200);
+            c->drawRect(occluder, paint);
+        }},
+        {"rotated", [&](SkCanvas* c) {
+            c->save();
+            c->rotate(30, 105, 105);
+            draw_rect(c, occluder.makeOutset(40, 40), kOccluderColor);
+            c->restore();
+        }},
+        {"small", [&](SkCanvas* c) {
+            draw_rect(c, SkRect::MakeLTRB(15, 15, 65, 65), kOccluderColor);
+        }},
+    };
+    for (const auto& testCase : kCases) {
+        draw_background(canvas);
+        testCase.fDraw(canvas);
+        REPORTER_ASSERT(reporter, num_pending_occluded_draws(canvas) == 0,
+                        "%s: %d", testCase.fName, num_pending_occluded_draws(canvas));
+        // Flush before the next case.
+        SkBitmap result;
+        result.allocPixels(ii);
+        REPORTER_ASSERT(reporter, surface->readPixels(result, 0, 0), "%s", testCase.fName);
+    }
+}
+
+// Only the pixels an antialiased or scissored occluder fully covers hide what's under them.
+DEF_GRAPHITE_TEST_FOR_RENDERING_CONTEXTS(OcclusionPartialCoverageTest, reporter, context,
+                                         CtsEnforcement::kNever) {
+    std::unique_ptr<Recorder> recorder = context->makeRecorder();
+    const SkImageInfo ii = SkImageInfo::Make(256, 256, kRGBA_8888_SkColorType, kPremul_SkAlphaType);
+    sk_sp<SkSurface> surface = SkSurfaces::RenderTarget(recorder.get(), ii);
+    REPORTER_ASSERT(reporter, surface);
+    if (!surface) {
+        return;
+    }
+    SkCanvas* canvas = surface->getCanvas();
+    SkBitmap result;
+    result.allocPixels(ii);
+
+    // An antialiased occluder only hides what's under the pixels it fully covers, so the rect
+    // that crosses its left edge is still drawn.
+    canvas->clear(SK_ColorWHITE);
+    draw_rect(canvas, SkRect::MakeLTRB(12, 20, 40, 60), SK_ColorRED);
+    draw_rect(canvas, SkRect::MakeLTRB(5, 80, 40, 120), SK_ColorBLUE);
+    draw_rect(canvas, SkRect::MakeLTRB(9.5f, 9.5f, 200.5f, 200.5f), kOccluderColor,
+              /*antiAlias=*/true);
+    REPORTER_ASSERT(reporter, num_pending_occluded_draws(canvas) == 1,
+                    "%d", num_pending_occluded_draws(canvas));
+    REPORTER_ASSERT(reporter, surface->readPixels(result, 0, 0));
+    REPORTER_ASSERT(reporter, result.getColor(7, 100) == SK_ColorBLUE);
+    REPORTER_ASSERT(reporter, result.getColor(30, 40) == kOccluderColor);
+
+    // A rect clip that only needs the scissor limits the occluder to the clip.
+    canvas->clear(SK_ColorWHITE);
+    draw_rect(canvas, SkRect::MakeLTRB(20, 20, 60, 60), SK_ColorRED);
+    draw_rect(canvas, SkRect::MakeLTRB(140, 20, 180, 60), SK_ColorGREEN);
+    canvas->save();
+    canvas->clipRect(SkRect::MakeLTRB(0, 0, 128, 128));
+    draw_rect(canvas, SkRect::MakeLTRB(0, 0, 250, 250), kOccluderColor);
+    canvas->restore();
+    REPORTER_ASSERT(reporter, num_pending_occluded_draws(canvas) == 1,
+                    "%d", num_pending_occluded_draws(canvas));
+    REPORTER_ASSERT(reporter, surface->readPixels(result, 0, 0));
+    REPORTER_ASSERT(reporter, result.getColor(40, 40) == kOccluderColor);
+    REPORTER_ASSERT(reporter, result.getColor(160, 40) == SK_ColorGREEN);
+    REPORTER_ASSERT(reporter, result.getColor(160, 160) == SK_ColorWHITE);
+}
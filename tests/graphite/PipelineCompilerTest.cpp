@@ -0,0 +1,165 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "tests/Test.h"
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkSurface.h"
+#include "include/gpu/graphite/Context.h"
+#include "include/gpu/graphite/ContextOptions.h"
+#include "include/gpu/graphite/Recorder.h"
+#include "include/gpu/graphite/Recording.h"
+#include "include/gpu/graphite/Surface.h"
+#include "include/private/base/SkSemaphore.h"
+#include "src/gpu/ResourceKey.h"
+#include "src/gpu/graphite/ContextPriv.h"
+#include "src/gpu/graphite/GlobalCache.h"
+#include "src/gpu/graphite/GraphicsPipeline.h"
+#include "src/gpu/graphite/PipelineCompiler.h"
+#include "tools/gpu/ContextType.h"
+
+using namespace skgpu::graphite;
+using skgpu::UniqueKey;
+
+namespace {
+
+// The executors have to outlive every Context made with them. A single thread makes it easy for a
+// compile task to end up queued behind a task that needs its pipeline.
+SkExecutor* compilation_executor() {
+    static SkExecutor* executor = SkExecutor::MakeFIFOThreadPool(1).release();
+    return executor;
+}
+
+void set_compilation_executor(ContextOptions* options) {
+    options->fPipelineCompilationExecutor = compilation_executor();
+}
+
+void set_compilation_executor_and_drop(ContextOptions* options) {
+    options->fPipelineCompilationExecutor = compilation_executor();
+    options->fDropDrawsWithPendingPipelines = true;
+}
+
+std::unique_ptr<Recording> draw_rect(Recorder* recorder, SkSurface* surface, SkColor color) {
+    surface->getCanvas()->clear(SK_ColorTRANSPARENT);
+    SkPaint paint;
+    paint.setColor(color);
+    surface->getCanvas()->drawRect(SkRect::MakeWH(16, 16), paint);
+    return recorder->snap();
+}
+
+SkColor read_color(Context* context, SkSurface* surface, std::unique_ptr<Recording> recording) {
+    context->insertRecording({recording.get()});
+    SkBitmap bitmap;
+    bitmap.allocPixels(surface->imageInfo());
+    if (!surface->readPixels(bitmap, 0, 0)) {
+        return SK_ColorTRANSPARENT;
+    }
+    return bitmap.getColor(8, 8);
+}
+
+}  // anonymous namespace
+
+DEF_GRAPHITE_TEST(PipelineCompilerInFlightTest, reporter, CtsEnforcement::kNever) {
+    static const UniqueKey::Domain kTestDomain = UniqueKey::GenerateDomain();
+    UniqueKey key;
+    {
+        UniqueKey::Builder builder(&key, kTestDomain, 1, "PipelineCompilerInFlightTest");
+        builder[0] = 1;
+    }
+
+    GlobalCache cache;
+    sk_sp<GlobalCache::InFlightGraphicsPipeline> inFlight = cache.beginGraphicsPipelineCompile(key);
+    REPORTER_ASSERT(reporter, inFlight);
+    REPORTER_ASSERT(reporter, !cache.beginGraphicsPipelineCompile(key));
+
+    sk_sp<GlobalCache::InFlightGraphicsPipeline> found;
+    REPORTER_ASSERT(reporter, !cache.findGraphicsPipeline(key, &found));
+    REPORTER_ASSERT(reporter, found == inFlight);
+
+    // Only one of the compile task and a thread that needs the pipeline gets to compile it.
+    REPORTER_ASSERT(reporter, found->claim());
+    REPORTER_ASSERT(reporter, !inFlight->claim());
+
+    // A failed compile releases the waiters, and is no longer offered to the compiler, so that
+    // callers compile the pipeline themselves instead of waiting on it forever.
+    cache.finishGraphicsPipelineCompile(key, nullptr);
+    REPORTER_ASSERT(reporter, !inFlight->wait());
+    REPORTER_ASSERT(reporter, !cache.findGraphicsPipeline(key, &found));
+    REPORTER_ASSERT(reporter, !found);
+    REPORTER_ASSERT(reporter, !cache.beginGraphicsPipelineCompile(key));
+
+    // Dropping the pipelines also forgets the failures.
+    cache.resetGraphicsPipelines();
+    inFlight = cache.beginGraphicsPipelineCompile(key);
+    REPORTER_ASSERT(reporter, inFlight);
+    REPORTER_ASSERT(reporter, inFlight->claim());
+    cache.finishGraphicsPipelineCompile(key, nullptr);
+    cache.deleteResources();
+}
+
+// Snapping a Recording on the compilation executor's only thread used to wait forever for compile
+// tasks queued behind it.
+DEF_CONDITIONAL_GRAPHITE_TEST_FOR_CONTEXTS(PipelineCompilerSnapOnExecutorTest,
+                                           skgpu::IsRenderingContext,
+                                           reporter,
+                                           context,
+                                           testContext,
+                                           set_compilation_executor,
+                                           true,
+                                           CtsEnforcement::kNever) {
+    context->priv().globalCache()->resetGraphicsPipelines();
+
+    std::unique_ptr<Recorder> recorder = context->makeRecorder();
+    const SkImageInfo info = SkImageInfo::Make(16, 16, kRGBA_8888_SkColorType, kPremul_SkAlphaType);
+    sk_sp<SkSurface> surface = SkSurfaces::RenderTarget(recorder.get(), info);
+    REPORTER_ASSERT(reporter, surface);
+
+    std::unique_ptr<Recording> recording;
+    SkSemaphore done;
+    compilation_executor()->add([&] {
+        recording = draw_rect(recorder.get(), surface.get(), SK_ColorRED);
+        done.signal();
+    });
+    done.wait();
+    REPORTER_ASSERT(reporter, recording);
+
+    REPORTER_ASSERT(reporter, read_color(context, surface.get(), std::move(recording)) ==
+                              SK_ColorRED);
+    context->priv().pipelineCompiler()->wait();
+}
+
+// Draws may be dropped while their pipeline compiles, but once it's done they have to show up.
+DEF_CONDITIONAL_GRAPHITE_TEST_FOR_CONTEXTS(PipelineCompilerDropDrawsTest,
+                                           skgpu::IsRenderingContext,
+                                           reporter,
+                                           context,
+                                           testContext,
+                                           set_compilation_executor_and_drop,
+                                           true,
+                                           CtsEnforcement::kNever) {
+    context->priv().globalCache()->resetGraphicsPipelines();
+
+    std::unique_ptr<Recorder> recorder = context->makeRecorder();
+    const SkImageInfo info = SkImageInfo::Make(16, 16, kRGBA_8888_SkColorType, kPremul_SkAlphaType);
+    sk_sp<SkSurface> surface = SkSurfaces::RenderTarget(recorder.get(), info);
+    REPORTER_ASSERT(reporter, surface);
+
+    // The first frame may or may not drop the rect, depending on how fast it compiled.
+    SkColor color = read_color(context, surface.get(),
+                               draw_rect(recorder.get(), surface.get(), SK_ColorGREEN));
+    REPORTER_ASSERT(reporter, color == SK_ColorGREEN || color == SK_ColorTRANSPARENT);
+
+    context->priv().pipelineCompiler()->wait();
+    color = read_color(context, surface.get(),
+                       draw_rect(recorder.get(), surface.get(), SK_ColorGREEN));
+    REPORTER_ASSERT(reporter, color == SK_ColorGREEN);
+}
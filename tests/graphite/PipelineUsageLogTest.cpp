@@ -0,0 +1,167 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "tests/Test.h"
+
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkData.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkRRect.h"
+#include "include/core/SkSurface.h"
+#include "include/effects/SkGradientShader.h"
+#include "include/gpu/graphite/Context.h"
+#include "include/gpu/graphite/ContextOptions.h"
+#include "include/gpu/graphite/Recorder.h"
+#include "include/gpu/graphite/Recording.h"
+#include "include/gpu/graphite/Surface.h"
+#include "include/private/base/SkTo.h"
+#include "src/core/SkReadBuffer.h"
+#include "src/gpu/graphite/ContextPriv.h"
+#include "src/gpu/graphite/GlobalCache.h"
+#include "src/gpu/graphite/RecorderPriv.h"
+#include "src/gpu/graphite/ResourceProvider.h"
+#include "tools/graphite/GraphiteTestContext.h"
+
+#include <cstring>
+
+using namespace skgpu::graphite;
+
+namespace {
+
+void record_pipeline_usage(ContextOptions* options) {
+    options->fRecordPipelineUsage = true;
+}
+
+// Draws with a few different pipelines, and returns how many the Recorder compiled.
+int draw(Context* context, skiatest::graphite::GraphiteTestContext* testContext) {
+    std::unique_ptr<Recorder> recorder = context->makeRecorder();
+    const SkImageInfo ii = SkImageInfo::Make(64, 64, kRGBA_8888_SkColorType, kPremul_SkAlphaType);
+    sk_sp<SkSurface> surface = SkSurfaces::RenderTarget(recorder.get(), ii);
+    if (!surface) {
+        return 0;
+    }
+    SkCanvas* canvas = surface->getCanvas();
+    canvas->clear(SK_ColorWHITE);
+
+    SkPaint paint;
+    paint.setColor(SK_ColorRED);
+    canvas->drawRect(SkRect::MakeLTRB(4, 4, 30, 30), paint);
+    paint.setAntiAlias(true);
+    canvas->drawCircle(40, 40, 12, paint);
+
+    const SkPoint pts[] = {{0, 0}, {64, 64}};
+    const SkColor colors[] = {SK_ColorBLUE, SK_ColorGREEN};
+    paint.setShader(SkGradientShader::MakeLinear(pts, colors, nullptr, 2, SkTileMode::kClamp));
+    canvas->drawRRect(SkRRect::MakeRectXY(SkRect::MakeLTRB(8, 36, 60, 60), 6, 6), paint);
+
+    std::unique_ptr<Recording> recording = recorder->snap();
+    context->insertRecording({recording.get()});
+    testContext->syncedSubmit(context);
+    return recorder->priv().resourceProvider()->numGraphicsPipelinesCompiled();
+}
+
+// The number of pipelines in data from Context::serializePipelineUsage(), which follows the
+// magic number, version, backend and snippet hash.
+uint32_t entry_count(const SkData& data) {
+    SkReadBuffer buffer(data.data(), data.size());
+    for (int i = 0; i < 4; ++i) {
+        buffer.readUInt();
+    }
+    return buffer.readUInt();
+}
+
+} // anonymous namespace
+
+// The pipelines a Context compiled can be precompiled from their serialized form, after which the
+// same draws don't compile anything.
+DEF_CONDITIONAL_GRAPHITE_TEST_FOR_CONTEXTS(PipelineUsageLogRoundTripTest,
+                                           skgpu::IsRenderingContext,
+                                           reporter,
+                                           context,
+                                           testContext,
+                                           record_pipeline_usage,
+                                           true,
+                                           CtsEnforcement::kNever) {
+    context->priv().globalCache()->resetGraphicsPipelines();
+    REPORTER_ASSERT(reporter, draw(context, testContext) > 0);
+
+    sk_sp<SkData> data = context->serializePipelineUsage();
+    REPORTER_ASSERT(reporter, data);
+    if (!data) {
+        return;
+    }
+    const uint32_t count = entry_count(*data);
+    REPORTER_ASSERT(reporter, count > 0);
+
+    context->priv().globalCache()->resetGraphicsPipelines();
+    REPORTER_ASSERT(reporter, context->precompilePipelines(*data) == SkToInt(count));
+    REPORTER_ASSERT(reporter, draw(context, testContext) == 0);
+
+    // Serializing again writes the same pipelines.
+    sk_sp<SkData> again = context->serializePipelineUsage();
+    REPORTER_ASSERT(reporter, again && entry_count(*again) == count);
+}
+
+// Data that is truncated, corrupted or for another build compiles at most what it validly holds.
+DEF_CONDITIONAL_GRAPHITE_TEST_FOR_CONTEXTS(PipelineUsageLogMalformedTest,
+                                           skgpu::IsRenderingContext,
+                                           reporter,
+                                           context,
+                                           testContext,
+                                           record_pipeline_usage,
+                                           true,
+                                           CtsEnforcement::kNever) {
+    context->priv().globalCache()->resetGraphicsPipelines();
+    draw(context, testContext);
+    sk_sp<SkData> data = context->serializePipelineUsage();
+    REPORTER_ASSERT(reporter, data && data->size() > 20);
+    if (!data || data->size() <= 20) {
+        return;
+    }
+    const int count = SkToInt(entry_count(*data));
+
+    REPORTER_ASSERT(reporter, context->precompilePipelines(*SkData::MakeEmpty()) == 0);
+
+    // Every truncation stops at the last complete entry.
+    for (size_t size = 0; size < data->size(); ++size) {
+        sk_sp<SkData> truncated = SkData::MakeWithCopy(data->data(), size);
+        const int compiled = context->precompilePipelines(*truncated);
+        REPORTER_ASSERT(reporter, compiled >= 0 && compiled < count, "size %zu", size);
+        if (size < 20) {
+            REPORTER_ASSERT(reporter, compiled == 0, "size %zu", size);
+        }
+    }
+
+    // A change to any of the header fields means the data is ignored.
+    for (size_t offset = 0; offset < 16; offset += 4) {
+        sk_sp<SkData> corrupt = SkData::MakeWithCopy(data->data(), data->size());
+        static_cast<uint8_t*>(corrupt->writable_data())[offset] ^= 0x5A;
+        REPORTER_ASSERT(reporter, context->precompilePipelines(*corrupt) == 0,
+                        "offset %zu", offset);
+    }
+
+    // A count past the end of the data reads what is there and stops.
+    sk_sp<SkData> overcount = SkData::MakeWithCopy(data->data(), data->size());
+    const uint32_t hugeCount = 0x7FFFFFFF;
+    memcpy(static_cast<uint8_t*>(overcount->writable_data()) + 16, &hugeCount, 4);
+    REPORTER_ASSERT(reporter, context->precompilePipelines(*overcount) == count);
+
+    // A paint key longer than the data is rejected before anything is allocated for it.
+    sk_sp<SkData> longKey = SkData::MakeWithCopy(data->data(), data->size());
+    SkReadBuffer buffer(longKey->data(), longKey->size());
+    for (int i = 0; i < 5; ++i) {
+        buffer.readUInt();
+    }
+    SkString stepName;
+    buffer.readString(&stepName);
+    REPORTER_ASSERT(reporter, buffer.isValid());
+    const size_t keySizeOffset = data->size() - buffer.available();
+    memcpy(static_cast<uint8_t*>(longKey->writable_data()) + keySizeOffset, &hugeCount, 4);
+    REPORTER_ASSERT(reporter, context->precompilePipelines(*longKey) == 0);
+}
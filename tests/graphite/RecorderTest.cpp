@@ -7,13 +7,31 @@
 
 #include "tests/Test.h"
 
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColorPriv.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkPixmap.h"
+#include "include/core/SkYUVAInfo.h"
+#include "include/core/SkYUVAPixmaps.h"
+#include "include/effects/SkRuntimeEffect.h"
 #include "include/gpu/graphite/Context.h"
+#include "include/gpu/graphite/Image.h"
 #include "include/gpu/graphite/Recorder.h"
+#include "include/gpu/graphite/Surface.h"
+#include "include/private/base/SkAlign.h"
+#include "include/private/base/SkMalloc.h"
 #include "src/gpu/SkBackingFit.h"
 #include "src/gpu/graphite/Device.h"
 #include "src/gpu/graphite/RecorderPriv.h"
+#include "src/gpu/graphite/StaticUniformArena.h"
+
+#include <cstring>
 
 using namespace skgpu::graphite;
+using CallbackResult = skgpu::CallbackResult;
 using Mipmapped = skgpu::Mipmapped;
 
 // Tests to make sure the managing of back pointers between Recorder and Device all work properly.
@@ -100,3 +118,487 @@ DEF_GRAPHITE_TEST_FOR_ALL_CONTEXTS(RecorderDevicePtrTest, reporter, context,
     device1.reset();
     device3.reset();
 }
+
+// Draws enough rects to several surfaces that their passes' keys are sorted on the executor, and
+// checks that the last rect drawn over each pixel wins.
+DEF_GRAPHITE_TEST_FOR_ALL_CONTEXTS(RecorderDrawPassExecutorTest, reporter, context,
+                                   CtsEnforcement::kNever) {
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(2);
+    RecorderOptions options;
+    options.fDrawPassExecutor = executor.get();
+    std::unique_ptr<Recorder> recorder = context->makeRecorder(options);
+
+    static constexpr int kSize = 32;
+    static constexpr int kSurfaceCount = 3;
+    static constexpr SkColor kColors[] = {SK_ColorRED, SK_ColorGREEN, SK_ColorBLUE};
+    SkImageInfo info = SkImageInfo::Make({kSize, kSize}, kRGBA_8888_SkColorType,
+                                         kPremul_SkAlphaType);
+    sk_sp<SkSurface> surfaces[kSurfaceCount];
+    for (int s = 0; s < kSurfaceCount; ++s) {
+        surfaces[s] = SkSurfaces::RenderTarget(recorder.get(), info);
+        REPORTER_ASSERT(reporter, surfaces[s]);
+        if (!surfaces[s]) {
+            return;
+        }
+    }
+
+    // Each row of pixels gets rects of every color, ending on the surface's own color. Rects of
+    // the same color don't overlap, so they share a paint order, while the colors are layered.
+    for (int layer = 0; layer < 4; ++layer) {
+        for (int c = 0; c < kSurfaceCount; ++c) {
+            for (int s = 0; s < kSurfaceCount; ++s) {
+                SkPaint paint;
+                paint.setColor(kColors[(s + c + 1) % kSurfaceCount]);
+                SkCanvas* canvas = surfaces[s]->getCanvas();
+                for (int y = 0; y < kSize; ++y) {
+                    for (int x = 0; x < kSize; x += 4) {
+                        canvas->drawRect(SkRect::MakeXYWH(x, y, 4, 1), paint);
+                    }
+                }
+            }
+        }
+    }
+
+    std::unique_ptr<Recording> recording = recorder->snap();
+    REPORTER_ASSERT(reporter, recording);
+    if (!recording) {
+        return;
+    }
+    InsertRecordingInfo insertInfo;
+    insertInfo.fRecording = recording.get();
+    REPORTER_ASSERT(reporter, context->insertRecording(insertInfo));
+
+    for (int s = 0; s < kSurfaceCount; ++s) {
+        SkBitmap result;
+        result.allocPixels(info);
+        REPORTER_ASSERT(reporter, surfaces[s]->readPixels(result, 0, 0));
+        SkColor expected = kColors[s];
+        for (int y = 0; y < kSize; ++y) {
+            for (int x = 0; x < kSize; ++x) {
+                if (result.getColor(x, y) != expected) {
+                    ERRORF(reporter, "Surface %d at (%d, %d): expected %08x, found %08x",
+                           s, x, y, expected, result.getColor(x, y));
+                    return;
+                }
+            }
+        }
+    }
+}
+
+// Draws a raster image big enough that its pixels are written to the upload buffer on the
+// executor, and checks that they all reach the surface.
+DEF_GRAPHITE_TEST_FOR_ALL_CONTEXTS(RecorderUploadExecutorTest, reporter, context,
+                                   CtsEnforcement::kNever) {
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(2);
+    RecorderOptions options;
+    options.fUploadExecutor = executor.get();
+    std::unique_ptr<Recorder> recorder = context->makeRecorder(options);
+
+    static constexpr int kSize = 512;
+    SkImageInfo info = SkImageInfo::Make({kSize, kSize}, kRGBA_8888_SkColorType,
+                                         kPremul_SkAlphaType);
+    SkBitmap src;
+    src.allocPixels(info);
+    for (int y = 0; y < kSize; ++y) {
+        for (int x = 0; x < kSize; ++x) {
+            *src.getAddr32(x, y) = SkPackARGB32(0xFF, x % 256, y % 256, (x + y) % 256);
+        }
+    }
+    src.setImmutable();
+    sk_sp<SkImage> image = src.asImage();
+
+    sk_sp<SkSurface> surface = SkSurfaces::RenderTarget(recorder.get(), info);
+    REPORTER_ASSERT(reporter, surface);
+    if (!surface) {
+        return;
+    }
+    surface->getCanvas()->drawImage(image, 0, 0);
+
+    std::unique_ptr<Recording> recording = recorder->snap();
+    REPORTER_ASSERT(reporter, recording);
+    if (!recording) {
+        return;
+    }
+    InsertRecordingInfo insertInfo;
+    insertInfo.fRecording = recording.get();
+    REPORTER_ASSERT(reporter, context->insertRecording(insertInfo));
+
+    SkBitmap result;
+    result.allocPixels(info);
+    REPORTER_ASSERT(reporter, surface->readPixels(result, 0, 0));
+    for (int y = 0; y < kSize; ++y) {
+        for (int x = 0; x < kSize; ++x) {
+            if (*result.getAddr32(x, y) != *src.getAddr32(x, y)) {
+                ERRORF(reporter, "At (%d, %d): expected %08x, found %08x",
+                       x, y, *src.getAddr32(x, y), *result.getAddr32(x, y));
+                return;
+            }
+        }
+    }
+}
+
+// Makes an image from YUVA planes in memory that is freed as soon as TextureFromYUVAPixmaps()
+// returns, as the client may do, and checks that the image still draws what the planes held.
+static void check_borrowed_yuva_planes(skiatest::Reporter* reporter,
+                                       Context* context,
+                                       Recorder* recorder) {
+    static constexpr int kSize = 1024;
+    // A multiple of every page size in use, so that backends could wrap the planes.
+    static constexpr uintptr_t kPageAlignment = 64 << 10;
+    SkYUVAInfo yuvaInfo({kSize, kSize}, SkYUVAInfo::PlaneConfig::kY_U_V,
+                        SkYUVAInfo::Subsampling::k444, kIdentity_SkYUVColorSpace);
+    SkYUVAPixmapInfo pixmapInfo(yuvaInfo, SkYUVAPixmapInfo::DataType::kUnorm8,
+                                /*rowBytes=*/nullptr);
+    const size_t totalBytes = pixmapInfo.computeTotalBytes();
+    void* storage = sk_malloc_throw(totalBytes + kPageAlignment);
+    void* memory = reinterpret_cast<void*>(
+            SkAlignTo(reinterpret_cast<uintptr_t>(storage), kPageAlignment));
+    SkYUVAPixmaps pixmaps = SkYUVAPixmaps::FromExternalMemory(pixmapInfo, memory);
+
+    // The identity color space draws Y, U and V as red, green and blue.
+    auto planeValue = [](int plane, int x, int y) -> uint8_t {
+        return plane == 0 ? x % 256 : plane == 1 ? y % 256 : (x + y) % 256;
+    };
+    for (int i = 0; i < 3; ++i) {
+        for (int y = 0; y < kSize; ++y) {
+            for (int x = 0; x < kSize; ++x) {
+                *pixmaps.plane(i).writable_addr8(x, y) = planeValue(i, x, y);
+            }
+        }
+    }
+    sk_sp<SkImage> image = SkImages::TextureFromYUVAPixmaps(recorder, pixmaps);
+    // Scribble over the planes too, in case the allocator leaves freed memory as it was.
+    memset(memory, 0, totalBytes);
+    sk_free(storage);
+    REPORTER_ASSERT(reporter, image);
+    if (!image) {
+        return;
+    }
+
+    SkImageInfo info = SkImageInfo::Make({kSize, kSize}, kRGBA_8888_SkColorType,
+                                         kPremul_SkAlphaType);
+    sk_sp<SkSurface> surface = SkSurfaces::RenderTarget(recorder, info);
+    REPORTER_ASSERT(reporter, surface);
+    if (!surface) {
+        return;
+    }
+    surface->getCanvas()->drawImage(image, 0, 0);
+
+    std::unique_ptr<Recording> recording = recorder->snap();
+    REPORTER_ASSERT(reporter, recording);
+    if (!recording) {
+        return;
+    }
+    InsertRecordingInfo insertInfo;
+    insertInfo.fRecording = recording.get();
+    REPORTER_ASSERT(reporter, context->insertRecording(insertInfo));
+    context->submit(SyncToCpu::kYes);
+
+    SkBitmap result;
+    result.allocPixels(info);
+    REPORTER_ASSERT(reporter, surface->readPixels(result, 0, 0));
+    auto near = [](unsigned a, unsigned b) { return (a > b ? a - b : b - a) <= 2; };
+    for (int y = 0; y < kSize; ++y) {
+        for (int x = 0; x < kSize; ++x) {
+            SkColor color = result.getColor(x, y);
+            if (!near(SkColorGetR(color), planeValue(0, x, y)) ||
+                !near(SkColorGetG(color), planeValue(1, x, y)) ||
+                !near(SkColorGetB(color), planeValue(2, x, y))) {
+                ERRORF(reporter, "At (%d, %d): expected %02x%02x%02x, found %08x", x, y,
+                       planeValue(0, x, y), planeValue(1, x, y), planeValue(2, x, y), color);
+                return;
+            }
+        }
+    }
+}
+
+// Planes installed over client memory are borrowed, so they must be written to the upload buffer
+// before TextureFromYUVAPixmaps() returns rather than on the executor.
+DEF_GRAPHITE_TEST_FOR_ALL_CONTEXTS(RecorderUploadExecutorBorrowedPixelsTest, reporter, context,
+                                   CtsEnforcement::kNever) {
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(2);
+    RecorderOptions options;
+    options.fUploadExecutor = executor.get();
+    std::unique_ptr<Recorder> recorder = context->makeRecorder(options);
+    check_borrowed_yuva_planes(reporter, context, recorder.get());
+}
+
+// Checks the counts that are passed to InsertRecordingInfo::fFinishedWithStatsProc.
+DEF_GRAPHITE_TEST_FOR_ALL_CONTEXTS(RecorderRecordingStatsTest, reporter, context,
+                                   CtsEnforcement::kNever) {
+    std::unique_ptr<Recorder> recorder = context->makeRecorder();
+
+    static constexpr int kSize = 64;
+    SkImageInfo info = SkImageInfo::Make({kSize, kSize}, kRGBA_8888_SkColorType,
+                                         kPremul_SkAlphaType);
+    sk_sp<SkSurface> surface = SkSurfaces::RenderTarget(recorder.get(), info);
+    REPORTER_ASSERT(reporter, surface);
+    if (!surface) {
+        return;
+    }
+
+    struct Result {
+        bool fCalled = false;
+        CallbackResult fResult = CallbackResult::kFailed;
+        RecordingStats fStats;
+    };
+    auto record = [&](Result* result) {
+        SkBitmap src;
+        src.allocPixels(info);
+        src.eraseColor(SK_ColorGREEN);
+        surface->getCanvas()->drawImage(src.asImage(), 0, 0);
+        surface->getCanvas()->drawRect(SkRect::MakeWH(kSize / 2, kSize / 2), SkPaint());
+
+        std::unique_ptr<Recording> recording = recorder->snap();
+        REPORTER_ASSERT(reporter, recording);
+        if (!recording) {
+            return;
+        }
+        InsertRecordingInfo insertInfo;
+        insertInfo.fRecording = recording.get();
+        insertInfo.fFinishedContext = result;
+        insertInfo.fFinishedWithStatsProc = [](GpuFinishedContext c,
+                                               CallbackResult callbackResult,
+                                               const RecordingStats& stats) {
+            Result* result = static_cast<Result*>(c);
+            result->fCalled = true;
+            result->fResult = callbackResult;
+            result->fStats = stats;
+        };
+        REPORTER_ASSERT(reporter, context->insertRecording(insertInfo));
+        context->submit(SyncToCpu::kYes);
+    };
+
+    Result first;
+    record(&first);
+    REPORTER_ASSERT(reporter, first.fCalled);
+    REPORTER_ASSERT(reporter, first.fResult == CallbackResult::kSuccess);
+    REPORTER_ASSERT(reporter, first.fStats.fDrawPassCount >= 1);
+    REPORTER_ASSERT(reporter, first.fStats.fDrawCount >= 2);
+    REPORTER_ASSERT(reporter, first.fStats.fPipelineCount >= 2);
+    REPORTER_ASSERT(reporter, first.fStats.fBufferBytesWritten > 0);
+    REPORTER_ASSERT(reporter, first.fStats.fUploadBytes >= info.computeMinByteSize());
+    REPORTER_ASSERT(reporter, first.fStats.fSnapCpuTimeNs > 0);
+
+    // The same draws need no new pipelines.
+    Result second;
+    record(&second);
+    REPORTER_ASSERT(reporter, second.fCalled);
+    REPORTER_ASSERT(reporter, second.fStats.fPipelineCount == first.fStats.fPipelineCount);
+    REPORTER_ASSERT(reporter, second.fStats.fPipelinesCompiled == 0);
+}
+
+DEF_GRAPHITE_TEST_FOR_ALL_CONTEXTS(RecordingPatchRuntimeEffectUniformsTest, reporter, context,
+                                   CtsEnforcement::kNever) {
+    sk_sp<SkRuntimeEffect> effect = SkRuntimeEffect::MakeForShader(SkString(
+            "uniform half4 color;"
+            "half4 main(float2 p) { return color; }")).effect;
+    REPORTER_ASSERT(reporter, effect);
+
+    static constexpr int kSize = 16;
+    SkImageInfo info = SkImageInfo::Make({kSize, kSize}, kRGBA_8888_SkColorType,
+                                         kPremul_SkAlphaType);
+    auto record = [&](Recorder* recorder, sk_sp<SkSurface>* surface) {
+        *surface = SkSurfaces::RenderTarget(recorder, info);
+        if (!*surface) {
+            return std::unique_ptr<Recording>();
+        }
+        SkRuntimeShaderBuilder builder(effect);
+        builder.uniform("color") = SkV4{1.f, 0.f, 0.f, 1.f};
+        SkPaint paint;
+        paint.setShader(builder.makeShader());
+        (*surface)->getCanvas()->drawRect(SkRect::MakeWH(kSize, kSize), paint);
+        return recorder->snap();
+    };
+    auto insertAndRead = [&](Recording* recording, SkSurface* surface) {
+        InsertRecordingInfo insertInfo;
+        insertInfo.fRecording = recording;
+        REPORTER_ASSERT(reporter, context->insertRecording(insertInfo));
+        context->submit(SyncToCpu::kYes);
+
+        SkBitmap bitmap;
+        bitmap.allocPixels(info);
+        if (!surface->readPixels(bitmap.pixmap(), 0, 0)) {
+            ERRORF(reporter, "readPixels failed");
+            return SkColor(0);
+        }
+        return bitmap.getColor(kSize / 2, kSize / 2);
+    };
+
+    static constexpr SkV4 kGreen{0.f, 1.f, 0.f, 1.f};
+    auto green = SkSpan(reinterpret_cast<const std::byte*>(&kGreen), sizeof(kGreen));
+
+    // Without the option there's nothing to patch.
+    {
+        std::unique_ptr<Recorder> recorder = context->makeRecorder();
+        sk_sp<SkSurface> surface;
+        std::unique_ptr<Recording> recording = record(recorder.get(), &surface);
+        REPORTER_ASSERT(reporter, recording);
+        REPORTER_ASSERT(reporter,
+                        !recording->setRuntimeEffectUniform(effect.get(), "color", green));
+    }
+
+    RecorderOptions options;
+    options.fPatchableRuntimeEffectUniforms = true;
+    std::unique_ptr<Recorder> recorder = context->makeRecorder(options);
+    sk_sp<SkSurface> surface;
+    std::unique_ptr<Recording> recording = record(recorder.get(), &surface);
+    REPORTER_ASSERT(reporter, recording);
+    if (!recording) {
+        return;
+    }
+
+    REPORTER_ASSERT(reporter, insertAndRead(recording.get(), surface.get()) == SK_ColorRED);
+
+    REPORTER_ASSERT(reporter, !recording->setRuntimeEffectUniform(effect.get(), "colour", green));
+    REPORTER_ASSERT(reporter, !recording->setRuntimeEffectUniform(effect.get(), "color",
+                                                                  green.first(sizeof(float))));
+    REPORTER_ASSERT(reporter, recording->setRuntimeEffectUniform(effect.get(), "color", green));
+    REPORTER_ASSERT(reporter, insertAndRead(recording.get(), surface.get()) == SK_ColorGREEN);
+
+    // The patched value stays for later insertions.
+    REPORTER_ASSERT(reporter, insertAndRead(recording.get(), surface.get()) == SK_ColorGREEN);
+}
+
+// Draws the same paint in several Recordings, so that its uniforms move into the static uniform
+// arena, and checks that the draws that bind them there still get the right color.
+DEF_GRAPHITE_TEST_FOR_ALL_CONTEXTS(RecorderStaticUniformArenaTest, reporter, context,
+                                   CtsEnforcement::kNever) {
+    sk_sp<SkRuntimeEffect> effect = SkRuntimeEffect::MakeForShader(SkString(
+            "uniform half4 color;"
+            "half4 main(float2 p) { return color; }")).effect;
+    REPORTER_ASSERT(reporter, effect);
+
+    RecorderOptions options;
+    options.fStaticUniformArenaBytes = 1 << 16;
+    std::unique_ptr<Recorder> recorder = context->makeRecorder(options);
+
+    static constexpr int kSize = 16;
+    SkImageInfo info = SkImageInfo::Make({kSize, kSize}, kRGBA_8888_SkColorType,
+                                         kPremul_SkAlphaType);
+    sk_sp<SkSurface> surface = SkSurfaces::RenderTarget(recorder.get(), info);
+    REPORTER_ASSERT(reporter, surface);
+    if (!surface) {
+        return;
+    }
+    auto paintFor = [&](SkV4 color) {
+        SkRuntimeShaderBuilder builder(effect);
+        builder.uniform("color") = color;
+        SkPaint paint;
+        paint.setShader(builder.makeShader());
+        return paint;
+    };
+
+    static constexpr int kFrames = 6;
+    for (int frame = 0; frame < kFrames; ++frame) {
+        // The left half always uses the same uniforms, the right half new ones every frame.
+        SkCanvas* canvas = surface->getCanvas();
+        canvas->drawRect(SkRect::MakeWH(kSize / 2, kSize), paintFor({1.f, 0.f, 0.f, 1.f}));
+        canvas->drawRect(SkRect::MakeXYWH(kSize / 2, 0, kSize / 2, kSize),
+                         paintFor({0.f, frame / (float)kFrames, 1.f, 1.f}));
+        std::unique_ptr<Recording> recording = recorder->snap();
+        REPORTER_ASSERT(reporter, recording);
+        if (!recording) {
+            return;
+        }
+        InsertRecordingInfo insertInfo;
+        insertInfo.fRecording = recording.get();
+        REPORTER_ASSERT(reporter, context->insertRecording(insertInfo));
+        context->submit(SyncToCpu::kYes);
+
+        SkBitmap bitmap;
+        bitmap.allocPixels(info);
+        REPORTER_ASSERT(reporter, surface->readPixels(bitmap.pixmap(), 0, 0));
+        REPORTER_ASSERT(reporter, bitmap.getColor(kSize / 4, kSize / 2) == SK_ColorRED,
+                        "frame %d: %08x", frame, bitmap.getColor(kSize / 4, kSize / 2));
+        REPORTER_ASSERT(reporter, SkColorGetB(bitmap.getColor(3 * kSize / 4, kSize / 2)) == 0xFF);
+    }
+
+    // Backends that bind storage buffers or can't map draw buffers don't make the arena.
+    if (StaticUniformArena* arena = recorder->priv().staticUniformArena()) {
+        REPORTER_ASSERT(reporter, arena->bytesUsed() > 0);
+        recorder->freeGpuResources();
+        REPORTER_ASSERT(reporter, arena->bytesUsed() == 0);
+    }
+}
+
+// Draws a raster image whose pixels start on a page boundary, as video and camera frames do, so
+// that backends with unified memory copy it straight from the client's memory. Checks that the
+// pixels all reach the surface and that the memory is released once nothing needs it.
+DEF_GRAPHITE_TEST_FOR_ALL_CONTEXTS(RecorderHostMemoryUploadTest, reporter, context,
+                                   CtsEnforcement::kNever) {
+    std::unique_ptr<Recorder> recorder = context->makeRecorder();
+
+    static constexpr int kSize = 512;
+    // A multiple of every page size in use.
+    static constexpr uintptr_t kPageAlignment = 64 << 10;
+    SkImageInfo info = SkImageInfo::Make({kSize, kSize}, kRGBA_8888_SkColorType,
+                                         kPremul_SkAlphaType);
+    // Leave room to round the start up, and the end up to a whole page.
+    void* storage = sk_malloc_throw(info.computeMinByteSize() + 2 * kPageAlignment);
+    void* pixels = reinterpret_cast<void*>(
+            SkAlignTo(reinterpret_cast<uintptr_t>(storage), kPageAlignment));
+    SkPixmap src(info, pixels, info.minRowBytes());
+    for (int y = 0; y < kSize; ++y) {
+        for (int x = 0; x < kSize; ++x) {
+            *src.writable_addr32(x, y) = SkPackARGB32(0xFF, x % 256, y % 256, (x + y) % 256);
+        }
+    }
+    struct Storage {
+        void* fMemory;
+        bool fReleased = false;
+    } owned = {storage};
+    sk_sp<SkImage> image = SkImages::RasterFromPixmap(
+            src,
+            [](const void*, void* ctx) {
+                auto owned = static_cast<Storage*>(ctx);
+                sk_free(owned->fMemory);
+                owned->fReleased = true;
+            },
+            &owned);
+
+    sk_sp<SkSurface> surface = SkSurfaces::RenderTarget(recorder.get(), info);
+    REPORTER_ASSERT(reporter, surface);
+    if (!surface) {
+        return;
+    }
+    surface->getCanvas()->drawImage(image, 0, 0);
+    image.reset();
+
+    std::unique_ptr<Recording> recording = recorder->snap();
+    REPORTER_ASSERT(reporter, recording);
+    if (!recording) {
+        return;
+    }
+    InsertRecordingInfo insertInfo;
+    insertInfo.fRecording = recording.get();
+    REPORTER_ASSERT(reporter, context->insertRecording(insertInfo));
+
+    SkBitmap result;
+    result.allocPixels(info);
+    REPORTER_ASSERT(reporter, surface->readPixels(result, 0, 0));
+    // The source may already be gone if it was copied into an upload buffer.
+    for (int y = 0; y < kSize; ++y) {
+        for (int x = 0; x < kSize; ++x) {
+            const uint32_t expected = SkPackARGB32(0xFF, x % 256, y % 256, (x + y) % 256);
+            if (*result.getAddr32(x, y) != expected) {
+                ERRORF(reporter, "At (%d, %d): expected %08x, found %08x",
+                       x, y, expected, *result.getAddr32(x, y));
+                return;
+            }
+        }
+    }
+
+    recording.reset();
+    recorder.reset();
+    context->submit(SyncToCpu::kYes);
+    REPORTER_ASSERT(reporter, owned.fReleased);
+}
+
+// YUVA planes installed over client memory are borrowed, so even when they start on a page
+// boundary they must be copied before TextureFromYUVAPixmaps() returns rather than wrapped.
+DEF_GRAPHITE_TEST_FOR_ALL_CONTEXTS(RecorderHostMemoryBorrowedPixelsTest, reporter, context,
+                                   CtsEnforcement::kNever) {
+    std::unique_ptr<Recorder> recorder = context->makeRecorder();
+    check_borrowed_yuva_planes(reporter, context, recorder.get());
+}
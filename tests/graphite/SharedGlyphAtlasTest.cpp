@@ -0,0 +1,235 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "tests/Test.h"
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkFont.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkSurface.h"
+#include "include/gpu/graphite/Context.h"
+#include "include/gpu/graphite/ContextOptions.h"
+#include "include/gpu/graphite/Recorder.h"
+#include "include/gpu/graphite/Recording.h"
+#include "include/gpu/graphite/Surface.h"
+#include "src/gpu/graphite/AtlasProvider.h"
+#include "src/gpu/graphite/RecorderPriv.h"
+#include "src/gpu/graphite/text/TextAtlasManager.h"
+#include "tests/TestUtils.h"
+#include "tools/fonts/FontToolUtils.h"
+#include "tools/graphite/GraphiteTestContext.h"
+
+using namespace skgpu::graphite;
+
+namespace {
+
+constexpr SkColor4f kBackgroundColor = SkColors::kWhite;
+
+void share_glyph_atlas(ContextOptions* options) {
+    options->fShareGlyphAtlasAcrossRecorders = true;
+}
+
+SkFont make_font(SkScalar size) {
+    SkFont font(ToolUtils::CreatePortableTypeface("serif", SkFontStyle()));
+    font.setEdging(SkFont::Edging::kAntiAlias);
+    font.setSize(size);
+    return font;
+}
+
+void draw_text(SkCanvas* canvas, const char* text, SkScalar x, SkScalar y, const SkFont& font) {
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    canvas->drawSimpleText(text, strlen(text), SkTextEncoding::kUTF8, x, y, font, paint);
+}
+
+bool insert(Context* context, Recording* recording) {
+    InsertRecordingInfo info;
+    info.fRecording = recording;
+    return context->insertRecording(info);
+}
+
+bool has_ink(const SkPixmap& pixmap, const SkIRect& rect) {
+    for (int y = rect.top(); y < rect.bottom(); ++y) {
+        for (int x = rect.left(); x < rect.right(); ++x) {
+            if (pixmap.getColor(x, y) != kBackgroundColor.toSkColor()) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void compare_pixels(skiatest::Reporter* reporter, const SkPixmap& a, const SkPixmap& b) {
+    const float tol = 1.f/256;
+    const float tols[4] = {tol, tol, tol, tol};
+    auto error = std::function<ComparePixmapsErrorReporter>([&](int x, int y,
+                                                                const float diffs[4]) {
+        ERRORF(reporter,
+               "Error at %d, %d. Diff in floats: (%f, %f, %f, %f)",
+               x, y, diffs[0], diffs[1], diffs[2], diffs[3]);
+    });
+    ComparePixels(a, b, tols, error);
+}
+
+} // anonymous namespace
+
+// Recorders that share the atlas draw the same text the same, whichever Recording goes first.
+DEF_CONDITIONAL_GRAPHITE_TEST_FOR_CONTEXTS(SharedGlyphAtlasRecordersTest,
+                                           skgpu::IsRenderingContext,
+                                           reporter,
+                                           context,
+                                           testContext,
+                                           share_glyph_atlas,
+                                           true,
+                                           CtsEnforcement::kNever) {
+    const SkImageInfo ii = SkImageInfo::Make(128, 32, kRGBA_8888_SkColorType, kPremul_SkAlphaType);
+    const SkFont font = make_font(16);
+
+    std::unique_ptr<Recorder> recorders[2] = {context->makeRecorder(), context->makeRecorder()};
+    REPORTER_ASSERT(reporter,
+                    recorders[0]->priv().atlasProvider()->textAtlasManager() ==
+                    recorders[1]->priv().atlasProvider()->textAtlasManager());
+    REPORTER_ASSERT(reporter, recorders[0]->priv().atlasProvider()->textAtlasManager()->isShared());
+
+    sk_sp<SkSurface> surfaces[2];
+    std::unique_ptr<Recording> recordings[2];
+    for (int i = 0; i < 2; ++i) {
+        surfaces[i] = SkSurfaces::RenderTarget(recorders[i].get(), ii);
+        REPORTER_ASSERT(reporter, surfaces[i]);
+        surfaces[i]->getCanvas()->clear(kBackgroundColor);
+        draw_text(surfaces[i]->getCanvas(), "Hamburgefons", 3, 20, font);
+        recordings[i] = recorders[i]->snap();
+        REPORTER_ASSERT(reporter, recordings[i]);
+    }
+
+    // The second Recorder's Recording goes first, so it uploads the glyphs both read.
+    REPORTER_ASSERT(reporter, insert(context, recordings[1].get()));
+    REPORTER_ASSERT(reporter, insert(context, recordings[0].get()));
+    context->submit();
+
+    SkBitmap results[2];
+    for (int i = 0; i < 2; ++i) {
+        results[i].allocPixels(ii);
+        REPORTER_ASSERT(reporter, surfaces[i]->readPixels(results[i].pixmap(), 0, 0));
+    }
+    REPORTER_ASSERT(reporter, has_ink(results[0].pixmap(), ii.bounds()));
+    compare_pixels(reporter, results[0].pixmap(), results[1].pixmap());
+}
+
+// A Recording that reads the shared atlas can be inserted again, even after other Recorders have
+// filled the atlas with other glyphs.
+DEF_CONDITIONAL_GRAPHITE_TEST_FOR_CONTEXTS(SharedGlyphAtlasReinsertTest,
+                                           skgpu::IsRenderingContext,
+                                           reporter,
+                                           context,
+                                           testContext,
+                                           share_glyph_atlas,
+                                           true,
+                                           CtsEnforcement::kNever) {
+    const SkImageInfo ii = SkImageInfo::Make(128, 32, kRGBA_8888_SkColorType, kPremul_SkAlphaType);
+
+    std::unique_ptr<Recorder> recorder = context->makeRecorder();
+    recorder->priv().atlasProvider()->textAtlasManager()->setAtlasDimensionsToMinimum_ForTesting();
+
+    sk_sp<SkSurface> surface = SkSurfaces::RenderTarget(recorder.get(), ii);
+    REPORTER_ASSERT(reporter, surface);
+    surface->getCanvas()->clear(kBackgroundColor);
+    std::unique_ptr<Recording> clearRecording = recorder->snap();
+    draw_text(surface->getCanvas(), "Hamburgefons", 3, 20, make_font(16));
+    std::unique_ptr<Recording> textRecording = recorder->snap();
+    REPORTER_ASSERT(reporter, clearRecording && textRecording);
+
+    SkBitmap result0, result1;
+    result0.allocPixels(ii);
+    result1.allocPixels(ii);
+
+    REPORTER_ASSERT(reporter, insert(context, clearRecording.get()));
+    REPORTER_ASSERT(reporter, insert(context, textRecording.get()));
+    context->submit();
+    REPORTER_ASSERT(reporter, surface->readPixels(result0.pixmap(), 0, 0));
+    REPORTER_ASSERT(reporter, has_ink(result0.pixmap(), ii.bounds()));
+
+    // Another Recorder draws enough glyphs to have to evict whatever it can from the atlas.
+    std::unique_ptr<Recorder> other = context->makeRecorder();
+    const SkImageInfo otherII =
+            SkImageInfo::Make(256, 256, kRGBA_8888_SkColorType, kPremul_SkAlphaType);
+    sk_sp<SkSurface> otherSurface = SkSurfaces::RenderTarget(other.get(), otherII);
+    REPORTER_ASSERT(reporter, otherSurface);
+    for (SkScalar size = 20; size < 120; size += 10) {
+        otherSurface->getCanvas()->clear(kBackgroundColor);
+        draw_text(otherSurface->getCanvas(), "ABCDEFGHIJKLMNOPQRSTUVWXYZ", 0, size,
+                  make_font(size));
+        std::unique_ptr<Recording> otherRecording = other->snap();
+        REPORTER_ASSERT(reporter, otherRecording);
+        REPORTER_ASSERT(reporter, insert(context, otherRecording.get()));
+        testContext->syncedSubmit(context);
+    }
+
+    REPORTER_ASSERT(reporter, insert(context, clearRecording.get()));
+    REPORTER_ASSERT(reporter, insert(context, textRecording.get()));
+    context->submit();
+    REPORTER_ASSERT(reporter, surface->readPixels(result1.pixmap(), 0, 0));
+    compare_pixels(reporter, result0.pixmap(), result1.pixmap());
+}
+
+// When every plot of the shared atlas is pinned, text draws the glyphs that fit instead of
+// retrying forever, and the rest fit once the Recordings that pin the plots are done.
+DEF_CONDITIONAL_GRAPHITE_TEST_FOR_CONTEXTS(SharedGlyphAtlasFullTest,
+                                           skgpu::IsRenderingContext,
+                                           reporter,
+                                           context,
+                                           testContext,
+                                           share_glyph_atlas,
+                                           true,
+                                           CtsEnforcement::kNever) {
+    // Each glyph takes up most of a plot, and the minimum atlas only has a few of them.
+    static constexpr char kGlyphs[] = "MWOQDHNUGA";
+    static constexpr int kCellSize = 256;
+    static constexpr int kColumns = 5;
+    const SkFont font = make_font(200);
+    const SkImageInfo ii = SkImageInfo::Make(kColumns * kCellSize, 2 * kCellSize,
+                                             kRGBA_8888_SkColorType, kPremul_SkAlphaType);
+    auto cell = [](int i) {
+        return SkIRect::MakeXYWH((i % kColumns) * kCellSize, (i / kColumns) * kCellSize,
+                                 kCellSize, kCellSize);
+    };
+
+    std::unique_ptr<Recorder> recorder = context->makeRecorder();
+    recorder->priv().atlasProvider()->textAtlasManager()->setAtlasDimensionsToMinimum_ForTesting();
+
+    sk_sp<SkSurface> surface = SkSurfaces::RenderTarget(recorder.get(), ii);
+    REPORTER_ASSERT(reporter, surface);
+    SkBitmap result;
+    result.allocPixels(ii);
+
+    surface->getCanvas()->clear(kBackgroundColor);
+    for (int i = 0; kGlyphs[i]; ++i) {
+        const char glyph[] = {kGlyphs[i], '\0'};
+        draw_text(surface->getCanvas(), glyph, cell(i).left() + 16, cell(i).top() + 200, font);
+    }
+    std::unique_ptr<Recording> recording = recorder->snap();
+    REPORTER_ASSERT(reporter, recording);
+    REPORTER_ASSERT(reporter, insert(context, recording.get()));
+    testContext->syncedSubmit(context);
+    REPORTER_ASSERT(reporter, surface->readPixels(result.pixmap(), 0, 0));
+    REPORTER_ASSERT(reporter, has_ink(result.pixmap(), cell(0)));
+
+    // Deleting the Recording, which the GPU is done with, releases its plots.
+    recording.reset();
+
+    const int last = std::size(kGlyphs) - 2;
+    const char glyph[] = {kGlyphs[last], '\0'};
+    surface->getCanvas()->clear(kBackgroundColor);
+    draw_text(surface->getCanvas(), glyph, cell(0).left() + 16, cell(0).top() + 200, font);
+    recording = recorder->snap();
+    REPORTER_ASSERT(reporter, recording);
+    REPORTER_ASSERT(reporter, insert(context, recording.get()));
+    testContext->syncedSubmit(context);
+    REPORTER_ASSERT(reporter, surface->readPixels(result.pixmap(), 0, 0));
+    REPORTER_ASSERT(reporter, has_ink(result.pixmap(), cell(0)));
+}
@@ -0,0 +1,205 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "tests/Test.h"
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkSurface.h"
+#include "include/gpu/graphite/Context.h"
+#include "include/gpu/graphite/ContextOptions.h"
+#include "include/gpu/graphite/Recorder.h"
+#include "include/gpu/graphite/Recording.h"
+#include "include/gpu/graphite/Surface.h"
+#include "src/core/SkImagePriv.h"
+#include "src/gpu/GpuTypesPriv.h"
+#include "src/gpu/graphite/Image_Graphite.h"
+#include "src/gpu/graphite/RecorderPriv.h"
+#include "src/gpu/graphite/SharedContext.h"
+#include "src/gpu/graphite/SharedImageCache.h"
+#include "src/gpu/graphite/TextureProxy.h"
+#include "tools/graphite/GraphiteTestContext.h"
+
+#include <chrono>
+#include <thread>
+
+using namespace skgpu::graphite;
+using Mipmapped = skgpu::Mipmapped;
+
+namespace {
+
+void share_image_uploads(ContextOptions* options) {
+    options->fShareImageUploadsAcrossRecorders = true;
+}
+
+// A 16x16 image that is red on the left and green on the right.
+SkBitmap make_bitmap() {
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(16, 16);
+    bitmap.eraseColor(SK_ColorRED);
+    bitmap.erase(SK_ColorGREEN, SkIRect::MakeLTRB(8, 0, 16, 16));
+    bitmap.setImmutable();
+    return bitmap;
+}
+
+TextureProxy* proxy(const sk_sp<SkImage>& image) {
+    return image ? static_cast<Image*>(image.get())->textureProxyView().proxy() : nullptr;
+}
+
+} // anonymous namespace
+
+// Recorders share the textures of the images they upload, and a change to the pixels drops them.
+DEF_CONDITIONAL_GRAPHITE_TEST_FOR_CONTEXTS(SharedImageCacheTest,
+                                           skgpu::IsRenderingContext,
+                                           reporter,
+                                           context,
+                                           testContext,
+                                           share_image_uploads,
+                                           true,
+                                           CtsEnforcement::kNever) {
+    std::unique_ptr<Recorder> recorder1 = context->makeRecorder();
+    std::unique_ptr<Recorder> recorder2 = context->makeRecorder();
+    SharedImageCache* cache = recorder1->priv().sharedContext()->sharedImageCache();
+    REPORTER_ASSERT(reporter, cache);
+    if (!cache) {
+        return;
+    }
+    REPORTER_ASSERT(reporter, cache->numCached() == 0);
+
+    // The image shares the bitmap's pixels, so that they can be changed under it.
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(32, 32);
+    bitmap.eraseColor(SK_ColorBLUE);
+    sk_sp<SkImage> rasterImage = SkMakeImageFromRasterBitmap(bitmap, kNever_SkCopyPixelsMode);
+
+    sk_sp<SkImage> image1 = cache->findOrCreate(recorder1.get(), rasterImage.get(),
+                                                Mipmapped::kNo);
+    REPORTER_ASSERT(reporter, image1);
+    REPORTER_ASSERT(reporter, cache->numCached() == 1);
+    REPORTER_ASSERT(reporter, cache->hasPendingUploads());
+
+    // Another Recorder finds the same texture.
+    sk_sp<SkImage> image2 = cache->findOrCreate(recorder2.get(), rasterImage.get(),
+                                                Mipmapped::kNo);
+    REPORTER_ASSERT(reporter, proxy(image2) && proxy(image2) == proxy(image1));
+    REPORTER_ASSERT(reporter, cache->numCached() == 1);
+
+    // A draw that needs mip levels gets its own texture, which from then on is also used by draws
+    // that don't.
+    sk_sp<SkImage> mipmapped = cache->findOrCreate(recorder2.get(), rasterImage.get(),
+                                                   Mipmapped::kYes);
+    REPORTER_ASSERT(reporter, proxy(mipmapped) && proxy(mipmapped) != proxy(image1));
+    REPORTER_ASSERT(reporter, proxy(mipmapped)->mipmapped() == Mipmapped::kYes);
+    REPORTER_ASSERT(reporter, cache->numCached() == 2);
+    image2 = cache->findOrCreate(recorder1.get(), rasterImage.get(), Mipmapped::kNo);
+    REPORTER_ASSERT(reporter, proxy(image2) == proxy(mipmapped));
+
+    // Entries still in use aren't purged.
+    cache->freeUniquelyHeld();
+    REPORTER_ASSERT(reporter, cache->numCached() == 2);
+
+    // Changing the pixels drops the entries, even those still in use.
+    bitmap.eraseColor(SK_ColorYELLOW);
+    cache->freeUniquelyHeld();
+    REPORTER_ASSERT(reporter, cache->numCached() == 0);
+
+    // The uploads of the dropped entries that are still in use are recorded all the same.
+    REPORTER_ASSERT(reporter, cache->hasPendingUploads());
+    std::unique_ptr<Recording> recording = recorder1->snap();
+    context->insertRecording({recording.get()});
+    testContext->syncedSubmit(context);
+    REPORTER_ASSERT(reporter, !cache->hasPendingUploads());
+}
+
+// Entries that nothing refers to are purged once they haven't been used for a while.
+DEF_CONDITIONAL_GRAPHITE_TEST_FOR_CONTEXTS(SharedImageCachePurgeTest,
+                                           skgpu::IsRenderingContext,
+                                           reporter,
+                                           context,
+                                           testContext,
+                                           share_image_uploads,
+                                           true,
+                                           CtsEnforcement::kNever) {
+    std::unique_ptr<Recorder> recorder = context->makeRecorder();
+    SharedImageCache* cache = recorder->priv().sharedContext()->sharedImageCache();
+    REPORTER_ASSERT(reporter, cache);
+    if (!cache) {
+        return;
+    }
+
+    SkBitmap bitmap1 = make_bitmap(), bitmap2 = make_bitmap();
+    sk_sp<SkImage> rasterImage1 = bitmap1.asImage(), rasterImage2 = bitmap2.asImage();
+    sk_sp<SkImage> image1 = cache->findOrCreate(recorder.get(), rasterImage1.get(),
+                                                Mipmapped::kNo);
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    const skgpu::StdSteadyClock::time_point timeBetween = skgpu::StdSteadyClock::now();
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    sk_sp<SkImage> image2 = cache->findOrCreate(recorder.get(), rasterImage2.get(),
+                                                Mipmapped::kNo);
+    REPORTER_ASSERT(reporter, image1 && image2);
+    REPORTER_ASSERT(reporter, cache->numCached() == 2);
+
+    std::unique_ptr<Recording> recording = recorder->snap();
+    context->insertRecording({recording.get()});
+    testContext->syncedSubmit(context);
+    recording.reset();
+
+    // Only the first entry is old enough, and it's still in use.
+    cache->purgeNotUsedSince(&timeBetween);
+    REPORTER_ASSERT(reporter, cache->numCached() == 2);
+
+    image1.reset();
+    cache->purgeNotUsedSince(&timeBetween);
+    REPORTER_ASSERT(reporter, cache->numCached() == 1);
+
+    image2.reset();
+    cache->purgeNotUsedSince(nullptr);
+    REPORTER_ASSERT(reporter, cache->numCached() == 0);
+}
+
+// Recordings from different Recorders that draw the same image show it whatever order they are
+// inserted in, although only the first Recorder to draw it made its texture.
+DEF_CONDITIONAL_GRAPHITE_TEST_FOR_CONTEXTS(SharedImageCacheDrawTest,
+                                           skgpu::IsRenderingContext,
+                                           reporter,
+                                           context,
+                                           testContext,
+                                           share_image_uploads,
+                                           true,
+                                           CtsEnforcement::kNever) {
+    const SkBitmap bitmap = make_bitmap();
+    sk_sp<SkImage> rasterImage = bitmap.asImage();
+    const SkImageInfo ii = SkImageInfo::Make(16, 16, kRGBA_8888_SkColorType, kPremul_SkAlphaType);
+
+    std::unique_ptr<Recorder> recorders[2] = {context->makeRecorder(), context->makeRecorder()};
+    SharedImageCache* cache = recorders[0]->priv().sharedContext()->sharedImageCache();
+    sk_sp<SkSurface> surfaces[2];
+    std::unique_ptr<Recording> recordings[2];
+    for (int i = 0; i < 2; ++i) {
+        surfaces[i] = SkSurfaces::RenderTarget(recorders[i].get(), ii);
+        REPORTER_ASSERT(reporter, surfaces[i]);
+        surfaces[i]->getCanvas()->clear(SK_ColorTRANSPARENT);
+        surfaces[i]->getCanvas()->drawImage(rasterImage, 0, 0);
+        recordings[i] = recorders[i]->snap();
+        REPORTER_ASSERT(reporter, recordings[i]);
+    }
+    REPORTER_ASSERT(reporter, cache && cache->numCached() == 1);
+
+    context->insertRecording({recordings[1].get()});
+    context->insertRecording({recordings[0].get()});
+    testContext->syncedSubmit(context);
+
+    for (int i = 0; i < 2; ++i) {
+        SkBitmap result;
+        result.allocPixels(ii);
+        REPORTER_ASSERT(reporter, surfaces[i]->readPixels(result.pixmap(), 0, 0));
+        REPORTER_ASSERT(reporter, result.getColor(2, 8) == SK_ColorRED, "surface %d", i);
+        REPORTER_ASSERT(reporter, result.getColor(13, 8) == SK_ColorGREEN, "surface %d", i);
+    }
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "tests/Test.h"
+
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkSurface.h"
+#include "include/gpu/graphite/Context.h"
+#include "include/gpu/graphite/ContextOptions.h"
+#include "include/gpu/graphite/Recorder.h"
+#include "include/gpu/graphite/Recording.h"
+#include "include/gpu/graphite/Surface.h"
+#include "src/gpu/graphite/Caps.h"
+#include "src/gpu/graphite/ContextPriv.h"
+#include "tools/gpu/ContextType.h"
+
+#include <atomic>
+
+using namespace skgpu::graphite;
+
+namespace {
+
+void set_submission_executor(ContextOptions* options) {
+    // The executor has to outlive every Context made with it.
+    static SkExecutor* executor = SkExecutor::MakeFIFOThreadPool(1).release();
+    options->fSubmissionExecutor = executor;
+}
+
+struct FinishedCounts {
+    std::atomic<int> fSucceeded{0};
+    std::atomic<int> fFailed{0};
+};
+
+}  // anonymous namespace
+
+DEF_CONDITIONAL_GRAPHITE_TEST_FOR_CONTEXTS(SubmissionExecutorTest,
+                                           skgpu::IsRenderingContext,
+                                           reporter,
+                                           context,
+                                           testContext,
+                                           set_submission_executor,
+                                           true,
+                                           CtsEnforcement::kNever) {
+    if (!context->priv().caps()->allowCpuSync()) {
+        return;
+    }
+
+    std::unique_ptr<Recorder> recorder = context->makeRecorder();
+    const SkImageInfo info = SkImageInfo::Make(16, 16, kRGBA_8888_SkColorType, kPremul_SkAlphaType);
+    sk_sp<SkSurface> surface = SkSurfaces::RenderTarget(recorder.get(), info);
+    REPORTER_ASSERT(reporter, surface);
+
+    FinishedCounts counts;
+    auto finishedProc = [](GpuFinishedContext context, skgpu::CallbackResult result) {
+        FinishedCounts* counts = static_cast<FinishedCounts*>(context);
+        (result == skgpu::CallbackResult::kSuccess ? counts->fSucceeded : counts->fFailed)++;
+    };
+
+    static constexpr int kNumRecordings = 4;
+    for (int i = 0; i < kNumRecordings; ++i) {
+        surface->getCanvas()->clear(i % 2 ? SK_ColorRED : SK_ColorBLUE);
+        std::unique_ptr<Recording> recording = recorder->snap();
+        InsertRecordingInfo insertInfo;
+        insertInfo.fRecording = recording.get();
+        insertInfo.fFinishedProc = finishedProc;
+        insertInfo.fFinishedContext = &counts;
+        REPORTER_ASSERT(reporter, context->insertRecording(insertInfo));
+        // Each submit is on this thread; only the wait is handed to the executor.
+        REPORTER_ASSERT(reporter, context->submit(SyncToCpu::kNo));
+    }
+
+    // Syncing waits for the executor to see all of it finish.
+    REPORTER_ASSERT(reporter, context->submit(SyncToCpu::kYes));
+    REPORTER_ASSERT(reporter, !context->hasUnfinishedGpuWork());
+    REPORTER_ASSERT(reporter, counts.fSucceeded == kNumRecordings,
+                    "%d", counts.fSucceeded.load());
+    REPORTER_ASSERT(reporter, counts.fFailed == 0);
+}
@@ -0,0 +1,104 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "tests/Test.h"
+
+#include "include/core/SkMatrix.h"
+#include "include/core/SkPath.h"
+#include "src/gpu/graphite/render/TessellatedPathCache.h"
+#include "src/gpu/tessellate/PatchWriter.h"
+
+#include <cmath>
+#include <cstring>
+
+namespace skgpu::graphite {
+
+using namespace skgpu::tess;
+
+namespace {
+
+constexpr PatchAttribs kAttribs = PatchAttribs::kPaintDepth |
+                                  PatchAttribs::kExplicitCurveType |
+                                  PatchAttribs::kSsboIndex;
+
+using CapturingWriter = PatchWriter<TessellatedPathCache::CapturingPatchAllocator,
+                                    Required<PatchAttribs::kPaintDepth>,
+                                    Required<PatchAttribs::kSsboIndex>,
+                                    Optional<PatchAttribs::kExplicitCurveType>>;
+
+}  // anonymous namespace
+
+DEF_TEST(TessellatedPathCacheScaleBuckets, r) {
+    for (float scale : {0.01f, 0.3f, 1.f, 1.1f, 2.f, 3.7f, 100.f}) {
+        const float bucketScale =
+                TessellatedPathCache::BucketScale(TessellatedPathCache::ScaleBucket(scale));
+        // Patches are written for a scale at least as large as the draw's, and not much larger.
+        REPORTER_ASSERT(r, bucketScale >= scale * 0.9999f, "%f -> %f", scale, bucketScale);
+        REPORTER_ASSERT(r, bucketScale < scale * std::exp2(0.25f) * 1.0001f,
+                        "%f -> %f", scale, bucketScale);
+    }
+    REPORTER_ASSERT(r, TessellatedPathCache::ScaleBucket(1.f) == 0);
+    REPORTER_ASSERT(r, TessellatedPathCache::ScaleBucket(1.05f) ==
+                       TessellatedPathCache::ScaleBucket(1.15f));
+}
+
+DEF_TEST(TessellatedPathCacheFindAndWrite, r) {
+    using PatchType = TessellatedPathCache::PatchType;
+
+    SkPath path;
+    path.moveTo(0, 0).cubicTo(10, 20, 30, -20, 40, 0).close();
+    SkPath other = path;
+    other.lineTo(5, 5);
+
+    TessellatedPathCache cache;
+    REPORTER_ASSERT(r, !cache.find(path, PatchType::kCurves, kAttribs, 0));
+
+    TessellatedPathCache::Patches* added = cache.add(path, PatchType::kCurves, kAttribs, 0);
+    {
+        CapturingWriter writer{kAttribs, added};
+        writer.setShaderTransform(wangs_formula::VectorXform{SkMatrix::I()});
+        SkPoint pts[4] = {{0, 0}, {10, 20}, {30, -20}, {40, 0}};
+        writer.writeCubic(pts);
+    }
+    REPORTER_ASSERT(r, added->fCount >= 1);
+    REPORTER_ASSERT(r, added->fData.size() == added->fCount * SkToInt(PatchStride(kAttribs)));
+
+    // Only the same path, kind of patch, attribs and scale bucket share the patches.
+    REPORTER_ASSERT(r, cache.find(path, PatchType::kCurves, kAttribs, 0) == added);
+    REPORTER_ASSERT(r, !cache.find(path, PatchType::kWedges, kAttribs, 0));
+    REPORTER_ASSERT(r, !cache.find(path, PatchType::kCurves, kAttribs, 1));
+    REPORTER_ASSERT(r, !cache.find(path, PatchType::kCurves,
+                                   kAttribs & ~PatchAttribs::kExplicitCurveType, 0));
+    REPORTER_ASSERT(r, !cache.find(other, PatchType::kCurves, kAttribs, 0));
+
+    // Written patches keep their control points and curve type but take the draw's depth and SSBO
+    // indices, which follow the control points and surround the curve type.
+    const size_t stride = PatchStride(kAttribs);
+    skia_private::TArray<char> buffer;
+    buffer.push_back_n(added->fData.size());
+    TessellatedPathCache::WritePatches({buffer.data(), buffer.size_bytes()},
+                                       *added, kAttribs, 0.5f, {3, 7});
+    for (int i = 0; i < added->fCount; ++i) {
+        const char* patch = buffer.data() + i * stride;
+        const char* captured = added->fData.data() + i * stride;
+        REPORTER_ASSERT(r, !memcmp(patch, captured, 4 * sizeof(SkPoint)));
+
+        float depth;
+        memcpy(&depth, patch + 4 * sizeof(SkPoint), sizeof(float));
+        REPORTER_ASSERT(r, depth == 0.5f);
+
+        REPORTER_ASSERT(r, !memcmp(patch + 4 * sizeof(SkPoint) + sizeof(float),
+                                   captured + 4 * sizeof(SkPoint) + sizeof(float),
+                                   sizeof(float)));
+
+        uint16_t ssboIndices[2];
+        memcpy(ssboIndices, patch + stride - sizeof(ssboIndices), sizeof(ssboIndices));
+        REPORTER_ASSERT(r, ssboIndices[0] == 3 && ssboIndices[1] == 7);
+    }
+}
+
+}  // namespace skgpu::graphite
@@ -0,0 +1,151 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "tests/Test.h"
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkPixmap.h"
+#include "include/core/SkRect.h"
+#include "include/gpu/graphite/Context.h"
+#include "include/gpu/graphite/Image.h"
+#include "include/gpu/graphite/Recorder.h"
+#include "include/gpu/graphite/Recording.h"
+#include "src/gpu/graphite/ContextPriv.h"
+#include "src/gpu/graphite/Image_Graphite.h"
+#include "tests/TestUtils.h"
+#include "tools/graphite/GraphiteTestContext.h"
+
+#include <functional>
+
+using namespace skgpu::graphite;
+
+namespace {
+
+// An odd width, so that the rows the writer is given are padded to whatever row pitch the backend
+// needs.
+constexpr int kWidth = 37;
+constexpr int kHeight = 13;
+
+// Red increases to the right, green downwards, and alpha varies across the image.
+SkBitmap make_source() {
+    SkBitmap bitmap;
+    bitmap.allocPixels(SkImageInfo::Make(kWidth, kHeight, kRGBA_8888_SkColorType,
+                                         kUnpremul_SkAlphaType));
+    for (int y = 0; y < kHeight; ++y) {
+        for (int x = 0; x < kWidth; ++x) {
+            const float r = x / (kWidth - 1.f);
+            const float g = y / (kHeight - 1.f);
+            const float a = 0.5f + ((x + y) % 16) / 32.f;
+            bitmap.erase({r, g, 1 - r, a}, SkIRect::MakeXYWH(x, y, 1, 1));
+        }
+    }
+    bitmap.setImmutable();
+    return bitmap;
+}
+
+}  // anonymous namespace
+
+// Images written through TextureFromPixelWriter read back as written, whether the writer wrote
+// straight into the upload buffer or into a temporary bitmap that was converted.
+DEF_GRAPHITE_TEST_FOR_RENDERING_CONTEXTS(TextureFromPixelWriterTest, reporter, context,
+                                         CtsEnforcement::kNever) {
+    std::unique_ptr<Recorder> recorder = context->makeRecorder();
+    const SkBitmap source = make_source();
+
+    const struct {
+        SkColorType fColorType;
+        SkAlphaType fAlphaType;
+    } kFormats[] = {
+        {kRGBA_8888_SkColorType, kPremul_SkAlphaType},
+        {kBGRA_8888_SkColorType, kPremul_SkAlphaType},
+        {kRGB_888x_SkColorType,  kOpaque_SkAlphaType},
+        {kRGB_565_SkColorType,   kOpaque_SkAlphaType},
+        {kARGB_4444_SkColorType, kPremul_SkAlphaType},
+        {kAlpha_8_SkColorType,   kPremul_SkAlphaType},
+        {kGray_8_SkColorType,    kOpaque_SkAlphaType},
+        {kRGBA_F16_SkColorType,  kPremul_SkAlphaType},
+    };
+    for (const auto& format : kFormats) {
+        const SkImageInfo info = source.info().makeColorType(format.fColorType)
+                                              .makeAlphaType(format.fAlphaType);
+        SkBitmap expected;
+        expected.allocPixels(info);
+        REPORTER_ASSERT(reporter, source.readPixels(expected.pixmap()));
+
+        int calls = 0;
+        sk_sp<SkImage> image = SkImages::TextureFromPixelWriter(
+                recorder.get(), info, [&](const SkPixmap& dst) {
+                    ++calls;
+                    REPORTER_ASSERT(reporter, dst.info() == info, "ct %d", info.colorType());
+                    REPORTER_ASSERT(reporter, dst.rowBytes() >= info.minRowBytes());
+                    return expected.pixmap().readPixels(dst);
+                });
+        REPORTER_ASSERT(reporter, calls == 1, "ct %d", info.colorType());
+        if (!image) {
+            // Not every backend can make textures of every color type.
+            continue;
+        }
+        REPORTER_ASSERT(reporter, image->isTextureBacked());
+        REPORTER_ASSERT(reporter, image->imageInfo() == info);
+
+        std::unique_ptr<Recording> recording = recorder->snap();
+        context->insertRecording({recording.get()});
+
+        SkBitmap result;
+        result.allocPixels(info.makeColorType(kRGBA_8888_SkColorType));
+        const TextureProxy* proxy = static_cast<Image*>(image.get())->textureProxyView().proxy();
+        REPORTER_ASSERT(reporter,
+                        context->priv().readPixels(result.pixmap(), proxy, info, 0, 0),
+                        "ct %d", info.colorType());
+
+        const float tol = 2.f/255;
+        const float tols[4] = {tol, tol, tol, tol};
+        auto error = std::function<ComparePixmapsErrorReporter>([&](int x, int y,
+                                                                    const float diffs[4]) {
+            ERRORF(reporter, "ct %d: error at %d, %d. Diff in floats: (%f, %f, %f, %f)",
+                   info.colorType(), x, y, diffs[0], diffs[1], diffs[2], diffs[3]);
+        });
+        ComparePixels(expected.pixmap(), result.pixmap(), tols, error);
+    }
+}
+
+// A writer that fails, or an image that can't be made, means there is no image.
+DEF_GRAPHITE_TEST_FOR_RENDERING_CONTEXTS(TextureFromPixelWriterFailureTest, reporter, context,
+                                         CtsEnforcement::kNever) {
+    std::unique_ptr<Recorder> recorder = context->makeRecorder();
+    const SkImageInfo info = SkImageInfo::Make(kWidth, kHeight, kRGBA_8888_SkColorType,
+                                               kPremul_SkAlphaType);
+
+    for (SkColorType ct : {kRGBA_8888_SkColorType, kRGB_888x_SkColorType}) {
+        int calls = 0;
+        sk_sp<SkImage> image = SkImages::TextureFromPixelWriter(
+                recorder.get(), info.makeColorType(ct), [&](const SkPixmap&) {
+                    ++calls;
+                    return false;
+                });
+        REPORTER_ASSERT(reporter, calls == 1, "ct %d", ct);
+        REPORTER_ASSERT(reporter, !image, "ct %d", ct);
+    }
+
+    int calls = 0;
+    auto writer = [&](const SkPixmap&) {
+        ++calls;
+        return true;
+    };
+    REPORTER_ASSERT(reporter, !SkImages::TextureFromPixelWriter(nullptr, info, writer));
+    REPORTER_ASSERT(reporter, !SkImages::TextureFromPixelWriter(recorder.get(),
+                                                                info.makeWH(0, kHeight), writer));
+    REPORTER_ASSERT(reporter, !SkImages::TextureFromPixelWriter(recorder.get(), info, nullptr));
+    REPORTER_ASSERT(reporter, calls == 0);
+
+    // Nothing was recorded for the failed images.
+    std::unique_ptr<Recording> recording = recorder->snap();
+    REPORTER_ASSERT(reporter, recording && context->insertRecording({recording.get()}));
+}
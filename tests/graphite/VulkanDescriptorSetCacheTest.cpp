@@ -0,0 +1,112 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "tests/Test.h"
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkSamplingOptions.h"
+#include "include/core/SkSurface.h"
+#include "include/gpu/graphite/Context.h"
+#include "include/gpu/graphite/Image.h"
+#include "include/gpu/graphite/Recorder.h"
+#include "include/gpu/graphite/Recording.h"
+#include "include/gpu/graphite/Surface.h"
+#include "src/gpu/graphite/ContextPriv.h"
+#include "src/gpu/graphite/vk/VulkanResourceProvider.h"
+
+#include <utility>
+#include <vector>
+
+using namespace skgpu::graphite;
+
+namespace {
+
+constexpr int kCellSize = 8;
+
+sk_sp<SkImage> make_image(Recorder* recorder, SkColor color) {
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(4, 4);
+    bitmap.eraseColor(color);
+    bitmap.setImmutable();
+    return SkImages::TextureFromImage(recorder, bitmap.asImage().get());
+}
+
+// Draws each image into its own cell of the first row, and returns the color in each cell.
+std::vector<SkColor> draw(Context* context, Recorder* recorder, SkSurface* surface,
+                          const std::vector<std::pair<sk_sp<SkImage>, SkSamplingOptions>>& draws) {
+    SkCanvas* canvas = surface->getCanvas();
+    canvas->clear(SK_ColorTRANSPARENT);
+    for (size_t i = 0; i < draws.size(); ++i) {
+        canvas->drawImageRect(draws[i].first,
+                              SkRect::MakeXYWH(i * kCellSize, 0, kCellSize, kCellSize),
+                              draws[i].second);
+    }
+    std::unique_ptr<Recording> recording = recorder->snap();
+    context->insertRecording({recording.get()});
+
+    SkBitmap result;
+    result.allocPixels(surface->imageInfo());
+    std::vector<SkColor> colors;
+    if (surface->readPixels(result, 0, 0)) {
+        for (size_t i = 0; i < draws.size(); ++i) {
+            colors.push_back(result.getColor(i * kCellSize + kCellSize / 2, kCellSize / 2));
+        }
+    }
+    return colors;
+}
+
+}  // anonymous namespace
+
+// Draws that go back to textures and samplers they bound before reuse the descriptor set that was
+// written for them, and still sample the right textures.
+DEF_GRAPHITE_TEST_FOR_VULKAN_CONTEXT(VulkanTextureDescriptorSetCacheTest, reporter, context,
+                                     CtsEnforcement::kNever) {
+    auto resourceProvider =
+            static_cast<VulkanResourceProvider*>(context->priv().resourceProvider());
+    std::unique_ptr<Recorder> recorder = context->makeRecorder();
+    const SkImageInfo ii = SkImageInfo::Make(8 * kCellSize, kCellSize, kRGBA_8888_SkColorType,
+                                             kPremul_SkAlphaType);
+    sk_sp<SkSurface> surface = SkSurfaces::RenderTarget(recorder.get(), ii);
+    sk_sp<SkImage> red = make_image(recorder.get(), SK_ColorRED);
+    sk_sp<SkImage> green = make_image(recorder.get(), SK_ColorGREEN);
+    sk_sp<SkImage> blue = make_image(recorder.get(), SK_ColorBLUE);
+    REPORTER_ASSERT(reporter, surface && red && green && blue);
+    if (!surface || !red || !green || !blue) {
+        return;
+    }
+    const SkSamplingOptions nearest(SkFilterMode::kNearest);
+    const SkSamplingOptions linear(SkFilterMode::kLinear);
+
+    const int initialCount = resourceProvider->numCachedTextureSamplerDescSets();
+    std::vector<SkColor> colors = draw(context, recorder.get(), surface.get(),
+                                       {{red, nearest}, {green, nearest}, {red, nearest},
+                                        {green, nearest}});
+    REPORTER_ASSERT(reporter, colors == std::vector<SkColor>({SK_ColorRED, SK_ColorGREEN,
+                                                             SK_ColorRED, SK_ColorGREEN}));
+    const int count = resourceProvider->numCachedTextureSamplerDescSets();
+    REPORTER_ASSERT(reporter, count > initialCount && count <= initialCount + 2,
+                    "%d %d", initialCount, count);
+
+    // The same bindings in the next frame don't add sets.
+    colors = draw(context, recorder.get(), surface.get(),
+                  {{green, nearest}, {red, nearest}, {green, nearest}});
+    REPORTER_ASSERT(reporter, colors == std::vector<SkColor>({SK_ColorGREEN, SK_ColorRED,
+                                                             SK_ColorGREEN}));
+    REPORTER_ASSERT(reporter, resourceProvider->numCachedTextureSamplerDescSets() == count);
+
+    // Another texture, or the same texture with another sampler, needs another set.
+    colors = draw(context, recorder.get(), surface.get(),
+                  {{red, nearest}, {blue, nearest}, {red, linear}});
+    REPORTER_ASSERT(reporter, colors == std::vector<SkColor>({SK_ColorRED, SK_ColorBLUE,
+                                                             SK_ColorRED}));
+    REPORTER_ASSERT(reporter, resourceProvider->numCachedTextureSamplerDescSets() > count);
+}
@@ -0,0 +1,170 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "tests/Test.h"
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkData.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkSurface.h"
+#include "include/gpu/graphite/Context.h"
+#include "include/gpu/graphite/PersistentPipelineStorage.h"
+#include "include/gpu/graphite/Recorder.h"
+#include "include/gpu/graphite/Recording.h"
+#include "include/gpu/graphite/Surface.h"
+#include "include/private/gpu/vk/SkiaVulkan.h"
+#include "tools/graphite/GraphiteTestContext.h"
+#include "tools/graphite/TestOptions.h"
+
+#include <cstring>
+
+using namespace skgpu::graphite;
+
+namespace {
+
+class MemoryStorage final : public PersistentPipelineStorage {
+public:
+    sk_sp<SkData> load(const SkData& key) override {
+        ++fNumLoads;
+        fLoadKey = SkData::MakeWithCopy(key.data(), key.size());
+        return fData;
+    }
+    void store(const SkData& key, const SkData& data) override {
+        ++fNumStores;
+        fStoreKey = SkData::MakeWithCopy(key.data(), key.size());
+        fData = SkData::MakeWithCopy(data.data(), data.size());
+    }
+
+    int fNumLoads = 0;
+    int fNumStores = 0;
+    sk_sp<SkData> fLoadKey;
+    sk_sp<SkData> fStoreKey;
+    sk_sp<SkData> fData;
+};
+
+std::unique_ptr<Context> make_context(skiatest::graphite::GraphiteTestContext* testContext,
+                                      PersistentPipelineStorage* storage) {
+    skiatest::graphite::TestOptions options;
+    options.fContextOptions.fPersistentPipelineStorage = storage;
+    return testContext->makeContext(options);
+}
+
+// Draws with a few different pipelines and returns the color at the center of the red rect.
+SkColor draw(Context* context, skiatest::graphite::GraphiteTestContext* testContext) {
+    std::unique_ptr<Recorder> recorder = context->makeRecorder();
+    const SkImageInfo ii = SkImageInfo::Make(64, 64, kRGBA_8888_SkColorType, kPremul_SkAlphaType);
+    sk_sp<SkSurface> surface = SkSurfaces::RenderTarget(recorder.get(), ii);
+    if (!surface) {
+        return SK_ColorTRANSPARENT;
+    }
+    SkCanvas* canvas = surface->getCanvas();
+    canvas->clear(SK_ColorWHITE);
+
+    SkPaint paint;
+    paint.setColor(SK_ColorRED);
+    canvas->drawRect(SkRect::MakeLTRB(4, 4, 30, 30), paint);
+    paint.setAntiAlias(true);
+    paint.setColor(SK_ColorBLUE);
+    canvas->drawCircle(44, 44, 12, paint);
+
+    std::unique_ptr<Recording> recording = recorder->snap();
+    context->insertRecording({recording.get()});
+    testContext->syncedSubmit(context);
+
+    SkBitmap bitmap;
+    bitmap.allocPixels(ii);
+    if (!surface->readPixels(bitmap, 0, 0)) {
+        return SK_ColorTRANSPARENT;
+    }
+    return bitmap.getColor(16, 16);
+}
+
+// The key starts with a tag and is followed by the vendor, device and driver version, and then the
+// pipeline cache UUID. VkPipelineCache data starts with a header that has the same vendor, device
+// and UUID.
+bool data_matches_key(const SkData& data, const SkData& key) {
+    static constexpr size_t kTagSize = sizeof("skgpu::graphite::Vulkan");
+    static constexpr size_t kHeaderSize = 16 + VK_UUID_SIZE;
+    if (key.size() != kTagSize + 3 * sizeof(uint32_t) + VK_UUID_SIZE ||
+        data.size() < kHeaderSize) {
+        return false;
+    }
+    const uint8_t* keyBytes = key.bytes() + kTagSize;
+    const uint8_t* dataBytes = data.bytes();
+    return memcmp(keyBytes, dataBytes + 8, 2 * sizeof(uint32_t)) == 0 &&
+           memcmp(keyBytes + 3 * sizeof(uint32_t), dataBytes + 16, VK_UUID_SIZE) == 0;
+}
+
+}  // anonymous namespace
+
+// The driver's pipeline cache is written to the client's storage, under a key for the driver, and
+// seeds the pipeline cache of the next Context made with the same storage.
+DEF_GRAPHITE_TEST_FOR_CONTEXTS(VulkanPipelineStorageTest, skiatest::IsVulkanContextType, reporter,
+                               unusedContext, testContext, CtsEnforcement::kNever) {
+    MemoryStorage storage;
+    {
+        std::unique_ptr<Context> context = make_context(testContext, &storage);
+        REPORTER_ASSERT(reporter, context);
+        if (!context) {
+            return;
+        }
+
+        // Nothing is stored before anything was compiled.
+        context->syncPipelineData();
+        REPORTER_ASSERT(reporter, storage.fNumStores == 0);
+
+        REPORTER_ASSERT(reporter, draw(context.get(), testContext) == SK_ColorRED);
+        REPORTER_ASSERT(reporter, storage.fNumLoads == 1, "%d", storage.fNumLoads);
+
+        // Data larger than the limit isn't stored.
+        context->syncPipelineData(1);
+        REPORTER_ASSERT(reporter, storage.fNumStores == 0);
+
+        context->syncPipelineData();
+        REPORTER_ASSERT(reporter, storage.fNumStores == 1);
+    }
+    REPORTER_ASSERT(reporter, storage.fData && storage.fStoreKey);
+    if (!storage.fData || !storage.fStoreKey) {
+        return;
+    }
+    REPORTER_ASSERT(reporter,
+                    storage.fLoadKey && storage.fLoadKey->equals(storage.fStoreKey.get()));
+    REPORTER_ASSERT(reporter, data_matches_key(*storage.fData, *storage.fStoreKey));
+
+    // The next Context loads what was stored, and draws the same.
+    const sk_sp<SkData> stored = storage.fData;
+    storage.fNumLoads = storage.fNumStores = 0;
+    {
+        std::unique_ptr<Context> context = make_context(testContext, &storage);
+        REPORTER_ASSERT(reporter, context);
+        if (!context) {
+            return;
+        }
+        REPORTER_ASSERT(reporter, draw(context.get(), testContext) == SK_ColorRED);
+        REPORTER_ASSERT(reporter, storage.fNumLoads == 1, "%d", storage.fNumLoads);
+        context->syncPipelineData();
+        REPORTER_ASSERT(reporter, storage.fNumStores == 1);
+        REPORTER_ASSERT(reporter, storage.fData &&
+                                  data_matches_key(*storage.fData, *storage.fStoreKey));
+    }
+
+    // Data the driver doesn't accept is ignored.
+    sk_sp<SkData> corrupt = SkData::MakeWithCopy(stored->data(), stored->size());
+    memset(corrupt->writable_data(), 0xA5, corrupt->size());
+    storage.fData = corrupt;
+    {
+        std::unique_ptr<Context> context = make_context(testContext, &storage);
+        REPORTER_ASSERT(reporter, context);
+        if (!context) {
+            return;
+        }
+        REPORTER_ASSERT(reporter, draw(context.get(), testContext) == SK_ColorRED);
+    }
+}
@@ -0,0 +1,27 @@
+
+out vec4 sk_FragColor;
+uniform vec4 colorGreen;
+uniform vec4 colorRed;
+uniform vec4 inputVal;
+float repeated_expressions_are_computed_once_hh4(vec4 v) {
+    float a = (v.x * v.y + v.z) * 2.0;
+    float b = (v.x * v.y + v.z) * 3.0;
+    return a + b;
+}
+float writes_invalidate_expressions_hh4(vec4 v) {
+    float a = v.x * v.y;
+    v.x += 1.0;
+    float b = v.x * v.y;
+    return b - a;
+}
+float conditional_expressions_are_not_reused_hh4(vec4 v) {
+    float a = v.x > 0.0 ? v.y * v.z : 0.0;
+    float b = v.y * v.z;
+    return a + b;
+}
+vec4 main() {
+    vec3 _0_color = inputVal.xyz * inputVal.w;
+    float _1_low = dot(_0_color, vec3(0.299, 0.587, 0.114)) * 0.5;
+    float _2_high = dot(_0_color, vec3(0.299, 0.587, 0.114)) * 1.5;
+    return ((_2_high - _1_low >= 0.0 && repeated_expressions_are_computed_once_hh4(inputVal) >= 0.0) && writes_invalidate_expressions_hh4(inputVal) >= 0.0) && conditional_expressions_are_not_reused_hh4(inputVal) >= 0.0 ? colorGreen : colorRed;
+}
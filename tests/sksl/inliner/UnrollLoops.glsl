@@ -0,0 +1,54 @@
+
+out vec4 sk_FragColor;
+uniform vec4 colorGreen;
+uniform vec4 colorRed;
+uniform vec4 inputVal;
+float weighted_sum_h() {
+    float sum = 0.0;
+    {
+        const float _2_weight = 1.0;
+        sum += _2_weight;
+        const float _3_weight = 2.0;
+        sum += _3_weight;
+        const float _4_weight = 3.0;
+        sum += _4_weight;
+    }
+    return sum;
+}
+int nested_loops_i() {
+    int count = 0;
+    {
+        {
+            count += 1;
+            count += 2;
+        }
+    }
+    return count;
+}
+int loop_with_break_is_not_unrolled_i() {
+    int count = 0;
+    for (int i = 0;i < 8; ++i) {
+        if (i > int(inputVal.x)) {
+            break;
+        }
+        ++count;
+    }
+    return count;
+}
+float large_loop_is_not_unrolled_h() {
+    float sum = 0.0;
+    for (int i = 0;i < 1000; ++i) {
+        sum += inputVal.y;
+    }
+    return sum;
+}
+vec4 main() {
+    float _0_sum = 0.0;
+    {
+        _0_sum += inputVal.x;
+        _0_sum += inputVal.y;
+        _0_sum += inputVal.z;
+        _0_sum += inputVal.w;
+    }
+    return (((_0_sum == ((inputVal.x + inputVal.y) + inputVal.z) + inputVal.w && weighted_sum_h() == 6.0) && nested_loops_i() == 3) && loop_with_break_is_not_unrolled_i() >= 0) && large_loop_is_not_unrolled_h() >= 0.0 ? colorGreen : colorRed;
+}
@@ -0,0 +1,46 @@
+
+out vec4 sk_FragColor;
+uniform vec4 colorGreen;
+uniform vec4 colorRed;
+uniform vec4 inputVal;
+float weighted_sum_h() {
+    float sum = 0.0;
+    for (float x = 0.5;x < 2.0; x += 0.5) {
+        float weight = x * 2.0;
+        sum += weight;
+    }
+    return sum;
+}
+int nested_loops_i() {
+    int count = 0;
+    for (int y = 0;y < 2; ++y) {
+        for (int x = 0;x < 3; ++x) {
+            count += x * y;
+        }
+    }
+    return count;
+}
+int loop_with_break_is_not_unrolled_i() {
+    int count = 0;
+    for (int i = 0;i < 8; ++i) {
+        if (i > int(inputVal.x)) {
+            break;
+        }
+        ++count;
+    }
+    return count;
+}
+float large_loop_is_not_unrolled_h() {
+    float sum = 0.0;
+    for (int i = 0;i < 1000; ++i) {
+        sum += inputVal.y;
+    }
+    return sum;
+}
+vec4 main() {
+    float _0_sum = 0.0;
+    for (int _1_i = 0;_1_i < 4; ++_1_i) {
+        _0_sum += inputVal[_1_i];
+    }
+    return (((_0_sum == ((inputVal.x + inputVal.y) + inputVal.z) + inputVal.w && weighted_sum_h() == 6.0) && nested_loops_i() == 3) && loop_with_break_is_not_unrolled_i() >= 0) && large_loop_is_not_unrolled_h() >= 0.0 ? colorGreen : colorRed;
+}
@@ -37,9 +37,11 @@ CORE_TESTS = [
     "DataRefTest.cpp",
     "DequeTest.cpp",
     "DescriptorTest.cpp",
+    "DistanceFieldGenTest.cpp",
     "DrawBitmapRectTest.cpp",
     "DrawPathTest.cpp",
     "EmptyPathTest.cpp",
+    "ExecutorTest.cpp",
     "F16StagesTest.cpp",
     "FillPathTest.cpp",
     "FitsInTest.cpp",
@@ -61,6 +63,7 @@ CORE_TESTS = [
     "InfRectTest.cpp",
     "InsetConvexPolyTest.cpp",
     "IsClosedSingleContourTest.cpp",
+    "JpegxlTest.cpp",
     "LListTest.cpp",
     "LRUCacheTest.cpp",
     "M44Test.cpp",
@@ -93,9 +96,11 @@ CORE_TESTS = [
     "Point3Test.cpp",
     "PointTest.cpp",
     "PolyUtilsTest.cpp",
+    "PrefetchingStreamTest.cpp",
     "QuickRejectTest.cpp",
     "RRectInPathTest.cpp",
     "RTreeTest.cpp",
+    "RasterThreadedSurfaceTest.cpp",
     "RandomTest.cpp",
     "ReadPixelsTest.cpp",
     "RecorderTest.cpp",
@@ -123,6 +128,7 @@ CORE_TESTS = [
     "SkImageTest.cpp",
     "SkMallocTest.cpp",
     "SkPathRangeIterTest.cpp",
+    "SkSLDehydratorTest.cpp",
     "SkSLErrorTest.cpp",
     "SkSLMemoryLayoutTest.cpp",
     "SkSLTypeTest.cpp",
@@ -158,6 +164,7 @@ CORE_CODEC_TESTS = [
 
 FONT_TESTS = [
     "FlattenDrawableTest.cpp",
+    "FontFallbackCacheTest.cpp",
     "FontHostTest.cpp",
     "FontNamesTest.cpp",
     "PaintTest.cpp",
@@ -192,6 +199,7 @@ TEXT_TESTS = [
     "DrawTextTest.cpp",
     "FontHostStreamTest.cpp",
     "TextBlobTest.cpp",
+    "TextQuadsTest.cpp",
     "TypefaceTest.cpp",
     "UnicodeTest.cpp",
 ]
@@ -389,25 +389,26 @@ std::unique_ptr<MSKPPlayer> MSKPPlayer::Make(SkStreamSeekable* stream) {
     procs.fImageProc = SkSharingDeserialContext::deserializeImage;
     procs.fImageCtx = deserialContext.get();
 
-    int pageCount = SkMultiPictureDocument::ReadPageCount(stream);
-    if (!pageCount) {
-        return nullptr;
-    }
-    std::vector<SkDocumentPage> pages(pageCount);
-    if (!SkMultiPictureDocument::Read(stream, pages.data(), pageCount, &procs)) {
+    auto reader = SkMultiPictureDocument::Reader::Make(stream, &procs);
+    if (!reader) {
         return nullptr;
     }
     std::unique_ptr<MSKPPlayer> result(new MSKPPlayer);
-    result->fRootLayers.reserve(pages.size());
-    for (const auto& page : pages) {
-        SkISize dims = {SkScalarCeilToInt(page.fSize.width()),
-                        SkScalarCeilToInt(page.fSize.height())};
+    result->fRootLayers.reserve(reader->pageCount());
+    // Read one page at a time, so only its commands are kept rather than every page's picture.
+    for (int i = 0; i < reader->pageCount(); ++i) {
+        sk_sp<SkPicture> page = reader->readPage(i);
+        if (!page) {
+            return nullptr;
+        }
+        SkSize size = reader->pageSize(i);
+        SkISize dims = {SkScalarCeilToInt(size.width()), SkScalarCeilToInt(size.height())};
         result->fRootLayers.emplace_back();
         result->fRootLayers.back().fDimensions = dims;
         result->fMaxDimensions.fWidth  = std::max(dims.width() , result->fMaxDimensions.width() );
         result->fMaxDimensions.fHeight = std::max(dims.height(), result->fMaxDimensions.height());
         CmdRecordCanvas sc(&result->fRootLayers.back(), &result->fOffscreenLayers);
-        page.fPicture->playback(&sc);
+        page->playback(&sc);
     }
     return result;
 }
@@ -0,0 +1,538 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/codec/SkAndroidCodec.h"
+#include "include/codec/SkCodec.h"
+#include "include/codec/SkEncodedImageFormat.h"
+#include "include/core/SkBitmap.h"
+#include "include/core/SkData.h"
+#include "include/core/SkGraphics.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkSize.h"
+#include "include/core/SkString.h"
+#include "include/gpu/GpuTypes.h"
+#include "include/gpu/GrDirectContext.h"
+#include "include/gpu/ganesh/SkImageGanesh.h"
+#include "src/core/SkOSFile.h"
+#include "src/utils/SkOSPath.h"
+#include "tools/CodecUtils.h"
+#include "tools/ProcStats.h"
+#include "tools/flags/CommandLineFlags.h"
+#include "tools/flags/CommonFlags.h"
+#include "tools/flags/CommonFlagsConfig.h"
+#include "tools/gpu/GrContextFactory.h"
+
+#if defined(SK_GRAPHITE)
+#include "include/gpu/graphite/Context.h"
+#include "include/gpu/graphite/Image.h"
+#include "include/gpu/graphite/Recorder.h"
+#include "include/gpu/graphite/Recording.h"
+#include "tools/GpuToolUtils.h"
+#include "tools/graphite/ContextFactory.h"
+#include "tools/graphite/GraphiteTestContext.h"
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Measures decode throughput over a corpus of encoded images, the way clients decode them: many
+ * images of mixed formats, sampled down by SkAndroidCodec to the size they will be drawn at, on
+ * several threads at once.
+ *
+ * Each run decodes every image in the corpus at one target scale with one number of threads, and
+ * reports images/s, decoded and encoded MB/s, and the peak resident set size during the run. With
+ * a GPU config, each decoded image is also uploaded to a texture on the main thread while the
+ * workers keep decoding, so the numbers cover the whole path from encoded bytes to texture.
+ *
+ *   decode_throughput --images ~/corpus --scales 1 0.5 0.25 --threads 1 4 --config 8888 gl
+ */
+
+static DEFINE_string(images, "", "Directories or files of encoded images to decode.");
+static DEFINE_string(scales, "1",
+                     "Target scales to decode at. Each image is sampled by SkAndroidCodec to the "
+                     "nearest size it supports.");
+static DEFINE_string(threads, "1", "Numbers of decoding threads to run with.");
+static DEFINE_int(loops, 5, "Timed passes over the corpus in each run. The median is reported.");
+static DEFINE_bool(formats, true, "Print a per-format breakdown under each run.");
+static DEFINE_bool(verbose, false, "Print the images that are skipped.");
+
+static constexpr int kFormatCount = static_cast<int>(SkEncodedImageFormat::kJPEGXL) + 1;
+
+static const char* format_name(SkEncodedImageFormat format) {
+    switch (format) {
+        case SkEncodedImageFormat::kBMP:    return "BMP";
+        case SkEncodedImageFormat::kGIF:    return "GIF";
+        case SkEncodedImageFormat::kICO:    return "ICO";
+        case SkEncodedImageFormat::kJPEG:   return "JPEG";
+        case SkEncodedImageFormat::kPNG:    return "PNG";
+        case SkEncodedImageFormat::kWBMP:   return "WBMP";
+        case SkEncodedImageFormat::kWEBP:   return "WEBP";
+        case SkEncodedImageFormat::kPKM:    return "PKM";
+        case SkEncodedImageFormat::kKTX:    return "KTX";
+        case SkEncodedImageFormat::kASTC:   return "ASTC";
+        case SkEncodedImageFormat::kDNG:    return "DNG";
+        case SkEncodedImageFormat::kHEIF:   return "HEIF";
+        case SkEncodedImageFormat::kAVIF:   return "AVIF";
+        case SkEncodedImageFormat::kJPEGXL: return "JPEGXL";
+    }
+    SkUNREACHABLE;
+}
+
+struct EncodedImage {
+    sk_sp<SkData>        fData;
+    SkEncodedImageFormat fFormat;
+};
+
+// What a set of decodes cost. fMillis is the time spent decoding on the worker threads, so it
+// does not shrink as threads are added.
+struct Tally {
+    int      fImages       = 0;
+    uint64_t fEncodedBytes = 0;
+    uint64_t fDecodedBytes = 0;
+    double   fMillis       = 0;
+
+    void add(const Tally& other) {
+        fImages       += other.fImages;
+        fEncodedBytes += other.fEncodedBytes;
+        fDecodedBytes += other.fDecodedBytes;
+        fMillis       += other.fMillis;
+    }
+};
+
+using Clock = std::chrono::steady_clock;
+
+static double elapsed_ms(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+static void add_image(const SkString& path, std::vector<EncodedImage>* corpus) {
+    sk_sp<SkData> data = SkData::MakeFromFileName(path.c_str());
+    std::unique_ptr<SkAndroidCodec> codec = data ? SkAndroidCodec::MakeFromData(data) : nullptr;
+    if (!codec) {
+        if (FLAGS_verbose) {
+            SkDebugf("Skipping %s: no codec.\n", path.c_str());
+        }
+        return;
+    }
+    corpus->push_back({std::move(data), codec->getEncodedFormat()});
+}
+
+// Every file that a codec recognizes is part of the corpus, whatever its extension.
+static std::vector<EncodedImage> collect_corpus() {
+    std::vector<EncodedImage> corpus;
+    for (int i = 0; i < FLAGS_images.size(); ++i) {
+        const char* path = FLAGS_images[i];
+        if (!sk_isdir(path)) {
+            add_image(SkString(path), &corpus);
+            continue;
+        }
+        SkOSFile::Iter it(path);
+        for (SkString file; it.next(&file);) {
+            add_image(SkOSPath::Join(path, file.c_str()), &corpus);
+        }
+    }
+    return corpus;
+}
+
+// Decodes the image to N32, sampled down to the nearest size SkAndroidCodec supports for the
+// target scale. Returns null if the image can't be decoded.
+static sk_sp<SkImage> decode(const EncodedImage& image, float scale) {
+    std::unique_ptr<SkAndroidCodec> codec = SkAndroidCodec::MakeFromData(image.fData);
+    if (!codec) {
+        return nullptr;
+    }
+    SkISize size = codec->getInfo().dimensions();
+    size = {std::max(1, (int)(size.width() * scale)), std::max(1, (int)(size.height() * scale))};
+
+    SkAndroidCodec::AndroidOptions options;
+    options.fSampleSize = codec->computeSampleSize(&size);
+
+    SkImageInfo info = codec->getInfo().makeDimensions(size).makeColorType(kN32_SkColorType);
+    if (info.alphaType() == kUnpremul_SkAlphaType) {
+        info = info.makeAlphaType(kPremul_SkAlphaType);
+    }
+    SkBitmap bitmap;
+    if (!bitmap.tryAllocPixels(info)) {
+        return nullptr;
+    }
+    const SkCodec::Result result =
+            codec->getAndroidPixels(info, bitmap.getPixels(), bitmap.rowBytes(), &options);
+    if (result != SkCodec::kSuccess && result != SkCodec::kIncompleteInput) {
+        return nullptr;
+    }
+    bitmap.setImmutable();
+    return bitmap.asImage();
+}
+
+// Uploads decoded images to textures. It is only used on the thread that created it.
+class Uploader {
+public:
+    virtual ~Uploader() = default;
+
+    virtual bool upload(const sk_sp<SkImage>&) = 0;
+    // Waits for the GPU to finish the uploads.
+    virtual void finish() = 0;
+};
+
+class GaneshUploader final : public Uploader {
+public:
+    static std::unique_ptr<Uploader> Make(const SkCommandLineConfigGpu* config) {
+        GrContextOptions options;
+        CommonFlags::SetCtxOptions(&options);
+        auto factory = std::make_unique<sk_gpu_test::GrContextFactory>(options);
+        GrDirectContext* context =
+                factory->get(config->getContextType(), config->getContextOverrides());
+        if (!context) {
+            return nullptr;
+        }
+        return std::unique_ptr<Uploader>(new GaneshUploader(std::move(factory), context));
+    }
+
+    bool upload(const sk_sp<SkImage>& image) override {
+        sk_sp<SkImage> texture = SkImages::TextureFromImage(
+                fContext, image, skgpu::Mipmapped::kNo, skgpu::Budgeted::kNo);
+        fContext->flushAndSubmit();
+        return texture != nullptr;
+    }
+
+    void finish() override { fContext->flushAndSubmit(GrSyncCpu::kYes); }
+
+private:
+    GaneshUploader(std::unique_ptr<sk_gpu_test::GrContextFactory> factory,
+                   GrDirectContext* context)
+            : fFactory(std::move(factory)), fContext(context) {}
+
+    std::unique_ptr<sk_gpu_test::GrContextFactory> fFactory;
+    GrDirectContext*                               fContext;
+};
+
+#if defined(SK_GRAPHITE)
+class GraphiteUploader final : public Uploader {
+public:
+    static std::unique_ptr<Uploader> Make(const SkCommandLineConfigGraphite* config) {
+        auto factory = std::make_unique<skiatest::graphite::ContextFactory>(config->getOptions());
+        skiatest::graphite::ContextInfo info = factory->getContextInfo(config->getContextType());
+        if (!info.fContext) {
+            return nullptr;
+        }
+        std::unique_ptr<skgpu::graphite::Recorder> recorder =
+                info.fContext->makeRecorder(ToolUtils::CreateTestingRecorderOptions());
+        if (!recorder) {
+            return nullptr;
+        }
+        return std::unique_ptr<Uploader>(new GraphiteUploader(
+                std::move(factory), info.fTestContext, info.fContext, std::move(recorder)));
+    }
+
+    ~GraphiteUploader() override {
+        // The recorder must go before the context that made it.
+        fRecorder.reset();
+    }
+
+    bool upload(const sk_sp<SkImage>& image) override {
+        sk_sp<SkImage> texture = SkImages::TextureFromImage(fRecorder.get(), image);
+        std::unique_ptr<skgpu::graphite::Recording> recording = fRecorder->snap();
+        if (!texture || !recording || !fContext->insertRecording({recording.get()})) {
+            return false;
+        }
+        fContext->submit(skgpu::graphite::SyncToCpu::kNo);
+        return true;
+    }
+
+    void finish() override { fTestContext->syncedSubmit(fContext); }
+
+private:
+    GraphiteUploader(std::unique_ptr<skiatest::graphite::ContextFactory> factory,
+                     skiatest::graphite::GraphiteTestContext* testContext,
+                     skgpu::graphite::Context* context,
+                     std::unique_ptr<skgpu::graphite::Recorder> recorder)
+            : fFactory(std::move(factory))
+            , fTestContext(testContext)
+            , fContext(context)
+            , fRecorder(std::move(recorder)) {}
+
+    std::unique_ptr<skiatest::graphite::ContextFactory> fFactory;
+    skiatest::graphite::GraphiteTestContext*            fTestContext;
+    skgpu::graphite::Context*                           fContext;
+    std::unique_ptr<skgpu::graphite::Recorder>          fRecorder;
+};
+#endif
+
+// Hands decoded images from the worker threads to the uploading thread. It holds at most a few
+// images per worker, so a slow upload holds the workers back rather than piling up memory.
+class UploadQueue {
+public:
+    explicit UploadQueue(int workers) : fCapacity(2 * workers), fWorkers(workers) {}
+
+    void push(sk_sp<SkImage> image) {
+        std::unique_lock<std::mutex> lock(fMutex);
+        fNotFull.wait(lock, [&] { return (int)fImages.size() < fCapacity; });
+        fImages.push_back(std::move(image));
+        fNotEmpty.notify_one();
+    }
+
+    void workerDone() {
+        std::lock_guard<std::mutex> lock(fMutex);
+        --fWorkers;
+        fNotEmpty.notify_one();
+    }
+
+    // Returns null once every worker is done and the queue is drained.
+    sk_sp<SkImage> pop() {
+        std::unique_lock<std::mutex> lock(fMutex);
+        fNotEmpty.wait(lock, [&] { return !fImages.empty() || fWorkers == 0; });
+        if (fImages.empty()) {
+            return nullptr;
+        }
+        sk_sp<SkImage> image = std::move(fImages.front());
+        fImages.pop_front();
+        fNotFull.notify_one();
+        return image;
+    }
+
+private:
+    std::mutex                 fMutex;
+    std::condition_variable    fNotFull;
+    std::condition_variable    fNotEmpty;
+    std::deque<sk_sp<SkImage>> fImages;
+    const int                  fCapacity;
+    int                        fWorkers;
+};
+
+// Polls the resident set size on a background thread, keeping the largest value seen.
+class PeakRSSSampler {
+public:
+    PeakRSSSampler() : fThread([this] {
+        while (!fDone.load(std::memory_order_relaxed)) {
+            this->sample();
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+    }) {}
+
+    ~PeakRSSSampler() {
+        fDone.store(true, std::memory_order_relaxed);
+        fThread.join();
+    }
+
+    int64_t peakBytes() {
+        this->sample();
+        return fPeak.load(std::memory_order_relaxed);
+    }
+
+private:
+    void sample() {
+        const int64_t rss = sk_tools::getCurrResidentSetSizeBytes();
+        int64_t peak = fPeak.load(std::memory_order_relaxed);
+        while (rss > peak && !fPeak.compare_exchange_weak(peak, rss, std::memory_order_relaxed)) {}
+    }
+
+    std::atomic<int64_t> fPeak{-1};
+    std::atomic<bool>    fDone{false};
+    std::thread          fThread;
+};
+
+// Decodes the whole corpus once. Each format's decodes are added to its entry in formats[].
+// Returns the wall time of the pass, or -1 if an upload failed.
+static double run_pass(const std::vector<EncodedImage>& corpus, float scale, int threadCount,
+                       Uploader* uploader, Tally formats[kFormatCount]) {
+    std::vector<std::vector<Tally>> tallies(threadCount, std::vector<Tally>(kFormatCount));
+    std::atomic<size_t> next{0};
+    UploadQueue queue(threadCount);
+
+    const Clock::time_point start = Clock::now();
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threadCount; ++t) {
+        workers.emplace_back([&, t] {
+            while (true) {
+                const size_t i = next.fetch_add(1, std::memory_order_relaxed);
+                if (i >= corpus.size()) {
+                    break;
+                }
+                const EncodedImage& image = corpus[i];
+                const Clock::time_point decodeStart = Clock::now();
+                sk_sp<SkImage> decoded = decode(image, scale);
+                if (!decoded) {
+                    continue;
+                }
+                Tally& tally = tallies[t][static_cast<int>(image.fFormat)];
+                tally.fMillis += elapsed_ms(decodeStart);
+                tally.fImages += 1;
+                tally.fEncodedBytes += image.fData->size();
+                tally.fDecodedBytes += decoded->imageInfo().computeMinByteSize();
+                if (uploader) {
+                    queue.push(std::move(decoded));
+                }
+            }
+            queue.workerDone();
+        });
+    }
+
+    bool uploaded = true;
+    if (uploader) {
+        while (sk_sp<SkImage> image = queue.pop()) {
+            uploaded &= uploader->upload(image);
+        }
+        uploader->finish();
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    const double wallMs = elapsed_ms(start);
+
+    for (const std::vector<Tally>& threadTallies : tallies) {
+        for (int f = 0; f < kFormatCount; ++f) {
+            formats[f].add(threadTallies[f]);
+        }
+    }
+    return uploaded ? wallMs : -1;
+}
+
+static double mb(uint64_t bytes) { return bytes / (1024.0 * 1024.0); }
+
+static void run(const std::vector<EncodedImage>& corpus, const char* config, float scale,
+                int threadCount, Uploader* uploader) {
+    // Warm up the codecs, the allocator and the GPU context.
+    Tally warmup[kFormatCount];
+    if (run_pass(corpus, scale, threadCount, uploader, warmup) < 0) {
+        SkDebugf("Skipping %s: uploads failed.\n", config);
+        return;
+    }
+
+    PeakRSSSampler rss;
+    Tally formats[kFormatCount];
+    std::vector<double> passMs;
+    for (int i = 0; i < FLAGS_loops; ++i) {
+        const double ms = run_pass(corpus, scale, threadCount, uploader, formats);
+        if (ms < 0) {
+            SkDebugf("Skipping %s: uploads failed.\n", config);
+            return;
+        }
+        passMs.push_back(ms);
+    }
+    std::sort(passMs.begin(), passMs.end());
+    const double seconds = passMs[passMs.size() / 2] / 1000;
+
+    Tally total;
+    for (const Tally& format : formats) {
+        total.add(format);
+    }
+    // Throughput is for one pass over the corpus, so divide the totals by the number of passes.
+    const double perPass = 1.0 / passMs.size();
+    const int64_t peakRSS = rss.peakBytes();
+    printf("%-10s %6g %8d %9.1f %13.1f %13.1f %12.1f\n",
+           config, scale, threadCount,
+           total.fImages * perPass / seconds,
+           mb(total.fDecodedBytes) * perPass / seconds,
+           mb(total.fEncodedBytes) * perPass / seconds,
+           peakRSS < 0 ? -1.0 : mb(peakRSS));
+
+    if (FLAGS_formats) {
+        for (int f = 0; f < kFormatCount; ++f) {
+            const Tally& format = formats[f];
+            if (!format.fImages) {
+                continue;
+            }
+            // Per-format numbers are for one decoding thread, since the formats' decodes are
+            // interleaved within a pass.
+            printf("    %-7s %6d images %9.3f ms/image %9.1f MB/s decoded per thread\n",
+                   format_name(static_cast<SkEncodedImageFormat>(f)),
+                   (int)(format.fImages * perPass),
+                   format.fMillis / format.fImages,
+                   mb(format.fDecodedBytes) / (format.fMillis / 1000));
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    CommandLineFlags::SetUsage(
+            "Measures decode throughput over a corpus of images, at several scales and thread "
+            "counts. Raster configs only decode; GPU configs also upload each image.");
+    CommandLineFlags::Parse(argc, argv);
+
+    SkGraphics::Init();
+    CodecUtils::RegisterAllAvailable();
+
+    std::vector<EncodedImage> corpus = collect_corpus();
+    if (corpus.empty()) {
+        SkDebugf("No decodable images found in --images.\n");
+        return 1;
+    }
+    if (FLAGS_loops < 1) {
+        SkDebugf("--loops must be at least 1.\n");
+        return 1;
+    }
+
+    int counts[kFormatCount] = {};
+    for (const EncodedImage& image : corpus) {
+        counts[static_cast<int>(image.fFormat)]++;
+    }
+    SkString summary;
+    for (int f = 0; f < kFormatCount; ++f) {
+        if (counts[f]) {
+            summary.appendf(" %d %s", counts[f], format_name(static_cast<SkEncodedImageFormat>(f)));
+        }
+    }
+    printf("Corpus: %zu images:%s\n", corpus.size(), summary.c_str());
+    printf("%-10s %6s %8s %9s %13s %13s %12s\n",
+           "config", "scale", "threads", "images/s", "decoded_MB/s", "encoded_MB/s", "peak_rss_MB");
+
+    SkCommandLineConfigArray configs;
+    ParseConfigs(FLAGS_config, &configs);
+    for (const std::unique_ptr<SkCommandLineConfig>& config : configs) {
+        const char* tag = config->getTag().c_str();
+        // Raster configs only decode, so they have no uploader.
+        std::unique_ptr<Uploader> uploader;
+        if (const SkCommandLineConfigGpu* gpuConfig = config->asConfigGpu()) {
+            uploader = GaneshUploader::Make(gpuConfig);
+#if defined(SK_GRAPHITE)
+        } else if (const SkCommandLineConfigGraphite* graphiteConfig = config->asConfigGraphite()) {
+            uploader = GraphiteUploader::Make(graphiteConfig);
+#endif
+        } else if (!config->getBackend().equals("8888")) {
+            SkDebugf("Skipping %s: only 8888 and GPU configs are supported.\n", tag);
+            continue;
+        }
+        if (!uploader && !config->getBackend().equals("8888")) {
+            SkDebugf("Skipping %s: failed to create a context.\n", tag);
+            continue;
+        }
+
+        for (int s = 0; s < FLAGS_scales.size(); ++s) {
+            const float scale = atof(FLAGS_scales[s]);
+            if (!(scale > 0 && scale <= 1)) {
+                SkDebugf("Skipping scale %s: scales must be in (0, 1].\n", FLAGS_scales[s]);
+                continue;
+            }
+            for (int t = 0; t < FLAGS_threads.size(); ++t) {
+                const int threadCount = atoi(FLAGS_threads[t]);
+                if (threadCount < 1) {
+                    SkDebugf("Skipping %s threads.\n", FLAGS_threads[t]);
+                    continue;
+                }
+                run(corpus, tag, scale, threadCount, uploader.get());
+            }
+        }
+    }
+
+    const int maxRSS = sk_tools::getMaxResidentSetSizeMB();
+    if (maxRSS >= 0) {
+        printf("Max RSS over the whole process: %d MB\n", maxRSS);
+    }
+    return 0;
+}
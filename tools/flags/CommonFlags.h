@@ -41,6 +41,7 @@ bool CollectImages(const CommandLineFlags::StringArray& dir,
  *     --disableDriverCorrectnessWorkarounds
  *     --reduceOpsTaskSplitting
  *     --dontReduceOpsTaskSplitting
+ *     --opsTaskReorderLookback
  *     --allowMSAAOnNewIntel
  */
 void SetCtxOptions(struct GrContextOptions*);
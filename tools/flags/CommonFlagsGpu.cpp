@@ -40,6 +40,10 @@ static DEFINE_bool(disableDriverCorrectnessWorkarounds, false,
 static DEFINE_bool(dontReduceOpsTaskSplitting, false,
                    "Don't reorder tasks to reduce render passes");
 
+static DEFINE_int(opsTaskReorderLookback, 0,
+                  "Number of earlier op chains an op may be combined with, or the default if "
+                  "not more than 10.");
+
 static DEFINE_int(gpuResourceCacheLimit, -1,
                   "Maximum number of bytes to use for budgeted GPU resources. "
                   "Default is -1, which means GrResourceCache::kDefaultMaxSize.");
@@ -117,6 +121,7 @@ void SetCtxOptions(GrContextOptions* ctxOptions) {
     } else {
         ctxOptions->fReduceOpsTaskSplitting = GrContextOptions::Enable::kYes;
     }
+    ctxOptions->fOpsTaskReorderLookback = FLAGS_opsTaskReorderLookback;
     ctxOptions->fAllowMSAAOnNewIntel = FLAGS_allowMSAAOnNewIntel;
 }
 
@@ -62,6 +62,7 @@ DRAW_OP_TEST_EXTERN(RegionOp);
 #if !defined(SK_ENABLE_OPTIMIZE_SIZE)
 DRAW_OP_TEST_EXTERN(RRectOp);
 #endif
+DRAW_OP_TEST_EXTERN(ShadowConvexPolygonOp);
 DRAW_OP_TEST_EXTERN(ShadowRRectOp);
 #if !defined(SK_ENABLE_OPTIMIZE_SIZE)
 DRAW_OP_TEST_EXTERN(SmallPathOp);
@@ -102,6 +103,7 @@ void GrDrawRandomOp(SkRandom* random, skgpu::ganesh::SurfaceDrawContext* sdc, Gr
 #if !defined(SK_ENABLE_OPTIMIZE_SIZE)
             DRAW_OP_TEST_ENTRY(RRectOp),
 #endif
+            DRAW_OP_TEST_ENTRY(ShadowConvexPolygonOp),
             DRAW_OP_TEST_ENTRY(ShadowRRectOp),
 #if !defined(SK_ENABLE_OPTIMIZE_SIZE)
             DRAW_OP_TEST_ENTRY(SmallPathOp),
@@ -36,6 +36,18 @@
 #include "tools/gpu/FlushFinishTracker.h"
 #include "tools/gpu/GpuTimer.h"
 #include "tools/gpu/GrContextFactory.h"
+#include "tools/gpu/MemoryCache.h"
+
+#if defined(SK_GRAPHITE)
+#include "include/gpu/graphite/Context.h"
+#include "include/gpu/graphite/PersistentPipelineStorage.h"
+#include "include/gpu/graphite/Recorder.h"
+#include "include/gpu/graphite/Recording.h"
+#include "include/gpu/graphite/Surface.h"
+#include "tools/GpuToolUtils.h"
+#include "tools/graphite/ContextFactory.h"
+#include "tools/graphite/GraphiteTestContext.h"
+#endif
 
 #if defined(SK_ENABLE_SVG)
 #include "modules/skshaper/utils/FactoryHelpers.h"
@@ -49,6 +61,11 @@
 #include <chrono>
 #include <cinttypes>
 #include <cmath>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <string>
 #include <vector>
 
 /**
@@ -63,7 +80,7 @@
  * Well, maybe a little fanciness, MSKP's can be loaded and played. The animation is played as many
  * times as necessary to reach the target sample duration and FPS is reported.
  *
- * Currently, only GPU configs are supported.
+ * Both Ganesh and Graphite GPU configs are supported.
  */
 
 static DEFINE_bool(ddl, false, "record the skp into DDLs before rendering");
@@ -84,6 +101,13 @@ static DEFINE_int(verbosity, 4, "level of verbosity (0=none to 5=debug)");
 static DEFINE_bool(suppressHeader, false, "don't print a header row before the results");
 static DEFINE_double(scale, 1, "Scale the size of the canvas and the zoom level by this factor.");
 static DEFINE_bool(dumpSamples, false, "print the individual samples to stdout");
+static DEFINE_bool(frameStats, false,
+                   "also print percentiles of each frame's CPU recording and GPU completion times, "
+                   "and how many frames were janky");
+static DEFINE_double(jankMs, 1000.0 / 60, "frames taking longer than this to complete are janky");
+static DEFINE_bool(comparePipelineCache, false,
+                   "before benchmarking, time the first frame on a new context with an empty "
+                   "persistent pipeline cache, then on another one loading what the first stored");
 
 static const char header[] =
 "   accum    median       max       min   stddev  samples  sample_ms  clock  metric  config    bench";
@@ -106,19 +130,86 @@ struct Sample {
     duration   fDuration;
 };
 
+/**
+ * Per-frame timings, for --frameStats. A frame's CPU time runs from when it starts drawing until
+ * its work is submitted, less the time spent waiting on earlier frames. Its GPU time runs from when
+ * it starts drawing until the CPU sees that the GPU has finished it.
+ */
+class FrameTimes {
+public:
+    using clock = std::chrono::steady_clock;
+    using FinishedProc = void (*)(void*);
+
+    void beginFrame() {
+        fStart = clock::now();
+        fWait = clock::duration::zero();
+    }
+
+    void addWait(clock::duration wait) { fWait += wait; }
+
+    // Returns a context for Finished(), which records when the GPU finished the current frame and
+    // then calls proc (if any) with context.
+    void* makeFinishedContext(FinishedProc proc, void* context) {
+        fGpuMs.push_back(std::numeric_limits<double>::quiet_NaN());
+        return new Pending{this, fGpuMs.size() - 1, fStart, proc, context};
+    }
+
+    static void Finished(void* finishedContext) {
+        std::unique_ptr<Pending> pending(static_cast<Pending*>(finishedContext));
+        pending->fTimes->fGpuMs[pending->fIndex] = ToMs(clock::now() - pending->fStart);
+        if (pending->fProc) {
+            pending->fProc(pending->fContext);
+        }
+    }
+
+    void endFrame() { fCpuMs.push_back(ToMs(clock::now() - fStart - fWait)); }
+
+    const std::vector<double>& cpuMs() const { return fCpuMs; }
+    const std::vector<double>& gpuMs() const { return fGpuMs; }
+
+private:
+    struct Pending {
+        FrameTimes*       fTimes;
+        size_t            fIndex;
+        clock::time_point fStart;
+        FinishedProc      fProc;
+        void*             fContext;
+    };
+
+    static double ToMs(clock::duration d) {
+        return std::chrono::duration<double, std::milli>(d).count();
+    }
+
+    clock::time_point   fStart;
+    clock::duration     fWait = clock::duration::zero();
+    std::vector<double> fCpuMs;
+    std::vector<double> fGpuMs;
+};
+
 class GpuSync {
 public:
     GpuSync() {}
     ~GpuSync() {}
 
-    void waitIfNeeded();
+    // tick lets the GPU API make progress while waiting, for Graphite backends that need it.
+    void waitIfNeeded(std::function<void()> tick = {});
 
     sk_gpu_test::FlushFinishTracker* newFlushTracker(GrDirectContext* context);
+#if defined(SK_GRAPHITE)
+    sk_gpu_test::FlushFinishTracker* newFlushTracker(skgpu::graphite::Context* context);
+#endif
+
+    // Frames drawn while this is set have their times recorded in it.
+    FrameTimes* frameTimes() const { return fFrameTimes; }
+    void setFrameTimes(FrameTimes* frameTimes) { fFrameTimes = frameTimes; }
 
 private:
+    sk_gpu_test::FlushFinishTracker* addFlushTracker(sk_gpu_test::FlushFinishTracker*);
+
     enum { kMaxFrameLag = 3 };
     sk_sp<sk_gpu_test::FlushFinishTracker> fFinishTrackers[kMaxFrameLag - 1];
     int fCurrentFlushIdx = 0;
+    FrameTimes* fFrameTimes = nullptr;
 };
 
 enum class ExitErr {
@@ -349,7 +440,8 @@ static void run_ddl_benchmark(sk_gpu_test::TestContext* testContext,
 static void run_benchmark(GrDirectContext* context,
                           sk_sp<SkSurface> surface,
                           SkpProducer* skpp,
-                          std::vector<Sample>* samples) {
+                          std::vector<Sample>* samples,
+                          FrameTimes* frameTimes) {
     using clock = std::chrono::high_resolution_clock;
     const Sample::duration sampleDuration = std::chrono::milliseconds(FLAGS_sampleMs);
     const clock::duration benchDuration = std::chrono::milliseconds(FLAGS_duration);
@@ -359,6 +451,7 @@ static void run_benchmark(GrDirectContext* context,
     do {
         i += skpp->drawAndFlushAndSync(context, surface.get(), gpuSync);
     } while(i < kNumFlushesToPrimeCache);
+    gpuSync.setFrameTimes(frameTimes);
 
     clock::time_point now = clock::now();
     const clock::time_point endTime = now + benchDuration;
@@ -379,8 +472,210 @@ static void run_benchmark(GrDirectContext* context,
     // fence.
     context->flush(surface.get());
     context->submit(GrSyncCpu::kYes);
+    context->checkAsyncWorkCompletion();
+}
+
+// Returns how long it takes to draw the first frame on a new context, and for the GPU to finish
+// it. The context loads and stores pipelines through ctxOptions.fPersistentCache.
+static double first_frame_ms(const GrContextOptions& ctxOptions,
+                             const SkCommandLineConfigGpu* config,
+                             const SkImageInfo& info,
+                             const SkSurfaceProps& props,
+                             const SkPicture* skp) {
+    using clock = std::chrono::steady_clock;
+
+    sk_gpu_test::GrContextFactory factory(ctxOptions);
+    GrDirectContext* context =
+            factory.get(config->getContextType(), config->getContextOverrides());
+    if (!context) {
+        exitf(ExitErr::kUnavailable, "failed to create context for config %s",
+                                     config->getTag().c_str());
+    }
+    sk_sp<SkSurface> surface =
+            SkSurfaces::RenderTarget(context, skgpu::Budgeted::kNo, info, config->getSamples(),
+                                     &props);
+    if (!surface) {
+        exitf(ExitErr::kUnavailable, "failed to create render target for config %s",
+                                     config->getTag().c_str());
+    }
+
+    SkCanvas* canvas = surface->getCanvas();
+    canvas->translate(-skp->cullRect().x(), -skp->cullRect().y());
+    if (FLAGS_scale != 1) {
+        canvas->scale(FLAGS_scale, FLAGS_scale);
+    }
+
+    const clock::time_point start = clock::now();
+    canvas->drawPicture(skp);
+    context->flush(surface.get());
+    context->submit(GrSyncCpu::kYes);
+    return std::chrono::duration<double, std::milli>(clock::now() - start).count();
+}
+
+#if defined(SK_GRAPHITE)
+
+// Keeps the pipeline data a Graphite Context stores, so another Context can load it.
+class MemoryPipelineStorage final : public skgpu::graphite::PersistentPipelineStorage {
+public:
+    sk_sp<SkData> load(const SkData& key) override {
+        auto found = fData.find(ToString(key));
+        return found != fData.end() ? found->second : nullptr;
+    }
+
+    void store(const SkData& key, const SkData& data) override {
+        fData[ToString(key)] = SkData::MakeWithCopy(data.data(), data.size());
+    }
+
+private:
+    static std::string ToString(const SkData& data) {
+        return std::string(static_cast<const char*>(data.data()), data.size());
+    }
+
+    std::map<std::string, sk_sp<SkData>> fData;
+};
+
+// A Graphite context, recorder and render target sized for the benchmark.
+struct GraphiteTarget {
+    GraphiteTarget(const skiatest::graphite::TestOptions& options,
+                   const SkCommandLineConfigGraphite* config,
+                   const SkImageInfo& info,
+                   const SkPicture* skp)
+            : fFactory(options) {
+        skiatest::graphite::ContextInfo ctxInfo = fFactory.getContextInfo(config->getContextType());
+        fTestContext = ctxInfo.fTestContext;
+        fContext = ctxInfo.fContext;
+        if (!fContext) {
+            exitf(ExitErr::kUnavailable, "failed to create context for config %s",
+                                         config->getTag().c_str());
+        }
+        fRecorder = fContext->makeRecorder(ToolUtils::CreateTestingRecorderOptions());
+        fSurface = fRecorder ? SkSurfaces::RenderTarget(fRecorder.get(), info) : nullptr;
+        if (!fSurface) {
+            exitf(ExitErr::kUnavailable, "failed to create %ix%i render target for config %s",
+                                         info.width(), info.height(), config->getTag().c_str());
+        }
+        SkCanvas* canvas = fSurface->getCanvas();
+        canvas->translate(-skp->cullRect().x(), -skp->cullRect().y());
+        if (FLAGS_scale != 1) {
+            canvas->scale(FLAGS_scale, FLAGS_scale);
+        }
+    }
+
+    ~GraphiteTarget() {
+        // The surface holds refs on the Context's device, so release it before the Context.
+        fSurface.reset();
+        fRecorder.reset();
+    }
+
+    skiatest::graphite::ContextFactory              fFactory;
+    skiatest::graphite::GraphiteTestContext*        fTestContext = nullptr;
+    skgpu::graphite::Context*                       fContext = nullptr;
+    std::unique_ptr<skgpu::graphite::Recorder>      fRecorder;
+    sk_sp<SkSurface>                                fSurface;
+};
+
+static void draw_skp_and_submit_with_sync(GraphiteTarget& target, const SkPicture* skp,
+                                          GpuSync& gpuSync) {
+    FrameTimes* frameTimes = gpuSync.frameTimes();
+    if (frameTimes) {
+        // Notice earlier frames finishing as soon as possible.
+        target.fContext->checkAsyncWorkCompletion();
+        frameTimes->beginFrame();
+    }
+
+    target.fSurface->getCanvas()->drawPicture(skp);
+    std::unique_ptr<skgpu::graphite::Recording> recording = target.fRecorder->snap();
+    if (!recording) {
+        exitf(ExitErr::kUnavailable, "failed to snap a Recording");
+    }
+
+    gpuSync.waitIfNeeded([&target] { target.fTestContext->tick(); });
+
+    skgpu::graphite::InsertRecordingInfo info;
+    info.fRecording = recording.get();
+    info.fFinishedProc = sk_gpu_test::FlushFinishTracker::FlushFinishedResult;
+    info.fFinishedContext = gpuSync.newFlushTracker(target.fContext);
+    if (frameTimes) {
+        info.fFinishedContext = frameTimes->makeFinishedContext(
+                sk_gpu_test::FlushFinishTracker::FlushFinished, info.fFinishedContext);
+        info.fFinishedProc = [](void* finishedContext, skgpu::CallbackResult) {
+            FrameTimes::Finished(finishedContext);
+        };
+    }
+    target.fContext->insertRecording(info);
+    target.fContext->submit(skgpu::graphite::SyncToCpu::kNo);
+
+    if (frameTimes) {
+        frameTimes->endFrame();
+    }
+}
+
+static void run_graphite_benchmark(GraphiteTarget& target,
+                                   const std::vector<sk_sp<SkPicture>>& frames,
+                                   std::vector<Sample>* samples,
+                                   FrameTimes* frameTimes) {
+    using clock = std::chrono::high_resolution_clock;
+    const Sample::duration sampleDuration = std::chrono::milliseconds(FLAGS_sampleMs);
+    const clock::duration benchDuration = std::chrono::milliseconds(FLAGS_duration);
+
+    GpuSync gpuSync;
+    for (int i = 0; i < kNumFlushesToPrimeCache; ++i) {
+        draw_skp_and_submit_with_sync(target, frames[i % frames.size()].get(), gpuSync);
+    }
+    gpuSync.setFrameTimes(frameTimes);
+
+    clock::time_point now = clock::now();
+    const clock::time_point endTime = now + benchDuration;
+
+    do {
+        clock::time_point sampleStart = now;
+        samples->emplace_back();
+        Sample& sample = samples->back();
+
+        do {
+            // Like MultiFrameSkp, play the whole animation each time.
+            for (const sk_sp<SkPicture>& frame : frames) {
+                draw_skp_and_submit_with_sync(target, frame.get(), gpuSync);
+            }
+            sample.fFrames += frames.size();
+            now = clock::now();
+            sample.fDuration = now - sampleStart;
+        } while (sample.fDuration < sampleDuration);
+    } while (now < endTime || 0 == samples->size() % 2);
+
+    // Make sure the gpu has finished all its work before we exit this function and delete the
+    // fence.
+    target.fTestContext->syncedSubmit(target.fContext);
+    target.fContext->checkAsyncWorkCompletion();
 }
 
+// Returns how long it takes to draw the first frame on a new Context, and for the GPU to finish it.
+// The Context loads pipelines from options' persistent pipeline storage, and stores them back.
+static double first_frame_ms(const skiatest::graphite::TestOptions& options,
+                             const SkCommandLineConfigGraphite* config,
+                             const SkImageInfo& info,
+                             const SkPicture* skp) {
+    using clock = std::chrono::steady_clock;
+
+    GraphiteTarget target(options, config, info, skp);
+    const clock::time_point start = clock::now();
+    target.fSurface->getCanvas()->drawPicture(skp);
+    std::unique_ptr<skgpu::graphite::Recording> recording = target.fRecorder->snap();
+    if (!recording) {
+        exitf(ExitErr::kUnavailable, "failed to snap a Recording");
+    }
+    skgpu::graphite::InsertRecordingInfo insertInfo;
+    insertInfo.fRecording = recording.get();
+    target.fContext->insertRecording(insertInfo);
+    target.fTestContext->syncedSubmit(target.fContext);
+    const double ms = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+
+    target.fContext->syncPipelineData();
+    return ms;
+}
+
+#endif  // SK_GRAPHITE
+
 static void run_gpu_time_benchmark(sk_gpu_test::GpuTimer* gpuTimer,
                                    GrDirectContext* context,
                                    sk_sp<SkSurface> surface,
@@ -491,6 +786,98 @@ void print_result(const std::vector<Sample>& samples, const char* config, const
     fflush(stdout);
 }
 
+// Returns the smallest value that is at least as large as the given fraction of the values.
+static double percentile(const std::vector<double>& sortedValues, double fraction) {
+    const size_t rank = static_cast<size_t>(std::ceil(fraction * sortedValues.size()));
+    return sortedValues[std::min(std::max<size_t>(rank, 1), sortedValues.size()) - 1];
+}
+
+static void print_frame_stats(const FrameTimes& frameTimes, const char* config, const char* bench) {
+    std::vector<double> cpuMs = frameTimes.cpuMs(), gpuMs;
+    for (double ms : frameTimes.gpuMs()) {
+        if (std::isfinite(ms)) {
+            gpuMs.push_back(ms);
+        }
+    }
+    if (cpuMs.empty() || gpuMs.empty()) {
+        return;
+    }
+    std::sort(cpuMs.begin(), cpuMs.end());
+    std::sort(gpuMs.begin(), gpuMs.end());
+    const size_t janky = gpuMs.end() - std::upper_bound(gpuMs.begin(), gpuMs.end(), FLAGS_jankMs);
+
+    printf("frames %zu  cpu p50/p95/p99 %.4g/%.4g/%.4g ms  gpu p50/p95/p99 %.4g/%.4g/%.4g ms  "
+           "janky %zu (>%.4g ms)  %s  %s\n",
+           gpuMs.size(),
+           percentile(cpuMs, 0.5), percentile(cpuMs, 0.95), percentile(cpuMs, 0.99),
+           percentile(gpuMs, 0.5), percentile(gpuMs, 0.95), percentile(gpuMs, 0.99),
+           janky, FLAGS_jankMs, config, bench);
+    fflush(stdout);
+}
+
+static void print_pipeline_cache_comparison(double coldMs, double warmMs,
+                                            const char* config, const char* bench) {
+    printf("first frame %.4g ms with a cold pipeline cache, %.4g ms warm  %s  %s\n",
+           coldMs, warmMs, config, bench);
+    fflush(stdout);
+}
+
+#if defined(SK_GRAPHITE)
+
+static void run_graphite(const SkCommandLineConfigGraphite* config,
+                         const SkImageInfo& info,
+                         const SkPicture* skp,
+                         const MultiFrameSkp* mskp,
+                         const char* srcname) {
+    if (FLAGS_ddl || FLAGS_gpuClock) {
+        exitf(ExitErr::kUnavailable, "--ddl and --gpuClock are not supported with Graphite");
+    }
+
+    skiatest::graphite::TestOptions options = config->getOptions();
+    MemoryPipelineStorage pipelineStorage;
+    if (FLAGS_comparePipelineCache) {
+        options.fContextOptions.fPersistentPipelineStorage = &pipelineStorage;
+        const double coldMs = first_frame_ms(options, config, info, skp);
+        const double warmMs = first_frame_ms(options, config, info, skp);
+        print_pipeline_cache_comparison(coldMs, warmMs, config->getTag().c_str(), srcname);
+    }
+
+    std::vector<sk_sp<SkPicture>> frames;
+    if (mskp) {
+        for (int i = 0; i < mskp->count(); ++i) {
+            frames.push_back(mskp->frame(i));
+        }
+    } else {
+        frames.push_back(sk_ref_sp(skp));
+    }
+
+    GraphiteTarget target(options, config, info, skp);
+
+    std::vector<Sample> samples;
+    FrameTimes frameTimes;
+    run_graphite_benchmark(target, frames, &samples, FLAGS_frameStats ? &frameTimes : nullptr);
+    print_result(samples, config->getTag().c_str(), srcname);
+    if (FLAGS_frameStats) {
+        print_frame_stats(frameTimes, config->getTag().c_str(), srcname);
+    }
+
+    if (!FLAGS_png.isEmpty()) {
+        SkBitmap bmp;
+        bmp.allocPixels(info);
+        if (!target.fSurface->readPixels(bmp, 0, 0)) {
+            exitf(ExitErr::kUnavailable, "failed to read canvas pixels for png");
+        }
+        if (!mkdir_p(SkOSPath::Dirname(FLAGS_png[0]))) {
+            exitf(ExitErr::kIO, "failed to create directory for png \"%s\"", FLAGS_png[0]);
+        }
+        if (!ToolUtils::EncodeImageToPngFile(FLAGS_png[0], bmp)) {
+            exitf(ExitErr::kIO, "failed to save png to \"%s\"", FLAGS_png[0]);
+        }
+    }
+}
+
+#endif  // SK_GRAPHITE
+
 int main(int argc, char** argv) {
     CommandLineFlags::SetUsage(
             "Use skpbench.py instead. "
@@ -506,9 +893,14 @@ int main(int argc, char** argv) {
 
     // Parse the config.
     const SkCommandLineConfigGpu* config = nullptr; // Initialize for spurious warning.
+    const SkCommandLineConfigGraphite* graphiteConfig = nullptr;
     SkCommandLineConfigArray configs;
     ParseConfigs(FLAGS_config, &configs);
-    if (configs.size() != 1 || !(config = configs[0]->asConfigGpu())) {
+    if (configs.size() == 1) {
+        config = configs[0]->asConfigGpu();
+        graphiteConfig = configs[0]->asConfigGraphite();
+    }
+    if (!config && !graphiteConfig) {
         exitf(ExitErr::kUsage, "invalid config '%s': must specify one (and only one) GPU config",
                                join(FLAGS_config).c_str());
     }
@@ -565,14 +957,38 @@ int main(int argc, char** argv) {
         }
     }
 
+#if defined(SK_GRAPHITE)
+    if (graphiteConfig) {
+        SkImageInfo info = SkImageInfo::Make(width, height, graphiteConfig->getColorType(),
+                                             graphiteConfig->getAlphaType());
+        run_graphite(graphiteConfig, info, skp.get(), mskp.get(), srcname.c_str());
+        return 0;
+    }
+#endif
+
     if (config->getSurfType() != SkCommandLineConfigGpu::SurfType::kDefault) {
         exitf(ExitErr::kUnavailable, "This tool only supports the default surface type. (%s)",
               config->getTag().c_str());
     }
 
-    // Create a context.
+    SkImageInfo info = SkImageInfo::Make(
+            width, height, config->getColorType(), config->getAlphaType(), config->refColorSpace());
+    SkSurfaceProps props(config->getSurfaceFlags(), kRGB_H_SkPixelGeometry);
+
     GrContextOptions ctxOptions;
     CommonFlags::SetCtxOptions(&ctxOptions);
+
+    // This makes its own contexts, so it runs before the benchmark's context is made current.
+    if (FLAGS_comparePipelineCache) {
+        GrContextOptions cacheOptions = ctxOptions;
+        sk_gpu_test::MemoryCache pipelineCache;
+        cacheOptions.fPersistentCache = &pipelineCache;
+        const double coldMs = first_frame_ms(cacheOptions, config, info, props, skp.get());
+        const double warmMs = first_frame_ms(cacheOptions, config, info, props, skp.get());
+        print_pipeline_cache_comparison(coldMs, warmMs, config->getTag().c_str(), srcname.c_str());
+    }
+
+    // Create a context.
     sk_gpu_test::GrContextFactory factory(ctxOptions);
     sk_gpu_test::ContextInfo ctxInfo =
         factory.getContextInfo(config->getContextType(), config->getContextOverrides());
@@ -605,9 +1021,6 @@ int main(int argc, char** argv) {
     }
 
     // Create a render target.
-    SkImageInfo info = SkImageInfo::Make(
-            width, height, config->getColorType(), config->getAlphaType(), config->refColorSpace());
-    SkSurfaceProps props(config->getSurfaceFlags(), kRGB_H_SkPixelGeometry);
     sk_sp<SkSurface> surface =
             SkSurfaces::RenderTarget(ctx, skgpu::Budgeted::kNo, info, config->getSamples(), &props);
     if (!surface) {
@@ -628,14 +1041,17 @@ int main(int argc, char** argv) {
     if (FLAGS_scale != 1) {
         canvas->scale(FLAGS_scale, FLAGS_scale);
     }
+    FrameTimes frameTimes;
     if (!FLAGS_gpuClock) {
         if (FLAGS_ddl) {
             run_ddl_benchmark(testCtx, ctx, surface, skp.get(), &samples);
         } else if (!mskp) {
             auto s = std::make_unique<StaticSkp>(skp);
-            run_benchmark(ctx, surface, s.get(), &samples);
+            run_benchmark(ctx, surface, s.get(), &samples,
+                          FLAGS_frameStats ? &frameTimes : nullptr);
         } else {
-            run_benchmark(ctx, surface, mskp.get(), &samples);
+            run_benchmark(ctx, surface, mskp.get(), &samples,
+                          FLAGS_frameStats ? &frameTimes : nullptr);
         }
     } else {
         if (FLAGS_ddl) {
@@ -647,6 +1063,10 @@ int main(int argc, char** argv) {
         run_gpu_time_benchmark(testCtx->gpuTimer(), ctx, surface, skp.get(), &samples);
     }
     print_result(samples, config->getTag().c_str(), srcname.c_str());
+    if (FLAGS_frameStats) {
+        // Not collected by the DDL and GPU clock modes.
+        print_frame_stats(frameTimes, config->getTag().c_str(), srcname.c_str());
+    }
 
     // Save a proof (if one was requested).
     if (!FLAGS_png.isEmpty()) {
@@ -672,13 +1092,29 @@ static void flush_with_sync(GrDirectContext* context, GpuSync& gpuSync) {
     GrFlushInfo flushInfo;
     flushInfo.fFinishedProc = sk_gpu_test::FlushFinishTracker::FlushFinished;
     flushInfo.fFinishedContext = gpuSync.newFlushTracker(context);
+    FrameTimes* frameTimes = gpuSync.frameTimes();
+    if (frameTimes) {
+        flushInfo.fFinishedContext = frameTimes->makeFinishedContext(flushInfo.fFinishedProc,
+                                                                     flushInfo.fFinishedContext);
+        flushInfo.fFinishedProc = FrameTimes::Finished;
+    }
 
     context->flush(flushInfo);
     context->submit();
+
+    if (frameTimes) {
+        frameTimes->endFrame();
+    }
 }
 
 static void draw_skp_and_flush_with_sync(GrDirectContext* context, SkSurface* surface,
                                          const SkPicture* skp, GpuSync& gpuSync) {
+    if (FrameTimes* frameTimes = gpuSync.frameTimes()) {
+        // Notice earlier frames finishing as soon as possible.
+        context->checkAsyncWorkCompletion();
+        frameTimes->beginFrame();
+    }
+
     auto canvas = surface->getCanvas();
     canvas->drawPicture(skp);
 
@@ -758,14 +1194,29 @@ static void exitf(ExitErr err, const char* format, ...) {
     exit((int)err);
 }
 
-void GpuSync::waitIfNeeded() {
+void GpuSync::waitIfNeeded(std::function<void()> tick) {
     if (fFinishTrackers[fCurrentFlushIdx]) {
-        fFinishTrackers[fCurrentFlushIdx]->waitTillFinished();
+        const FrameTimes::clock::time_point start = FrameTimes::clock::now();
+        fFinishTrackers[fCurrentFlushIdx]->waitTillFinished(std::move(tick));
+        if (fFrameTimes) {
+            fFrameTimes->addWait(FrameTimes::clock::now() - start);
+        }
     }
 }
 
 sk_gpu_test::FlushFinishTracker* GpuSync::newFlushTracker(GrDirectContext* context) {
-    fFinishTrackers[fCurrentFlushIdx].reset(new sk_gpu_test::FlushFinishTracker(context));
+    return this->addFlushTracker(new sk_gpu_test::FlushFinishTracker(context));
+}
+
+#if defined(SK_GRAPHITE)
+sk_gpu_test::FlushFinishTracker* GpuSync::newFlushTracker(skgpu::graphite::Context* context) {
+    return this->addFlushTracker(new sk_gpu_test::FlushFinishTracker(context));
+}
+#endif
+
+sk_gpu_test::FlushFinishTracker* GpuSync::addFlushTracker(
+        sk_gpu_test::FlushFinishTracker* newTracker) {
+    fFinishTrackers[fCurrentFlushIdx].reset(newTracker);
 
     sk_gpu_test::FlushFinishTracker* tracker = fFinishTrackers[fCurrentFlushIdx].get();
     // We add an additional ref to the current flush tracker here. This ref is owned by the finish
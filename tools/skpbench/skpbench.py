@@ -56,6 +56,14 @@ __argparse.add_argument('--gpu',
   help="perform timing on the gpu clock instead of cpu (gpu work only)")
 __argparse.add_argument('--fps',
   action='store_true', help="use fps instead of ms")
+__argparse.add_argument('--frame-stats',
+  action='store_true',
+  help="also print per-frame CPU and GPU time percentiles, and how many frames were janky")
+__argparse.add_argument('--jank-ms',
+  type=float, help="frames taking longer than this to complete are janky (default 16.7)")
+__argparse.add_argument('--compare-pipeline-cache',
+  action='store_true',
+  help="time the first frame with a cold and with a warm persistent pipeline cache")
 __argparse.add_argument('--pr',
   help="comma- or space-separated list of GPU path renderers, including: "
        "[[~]all [~]default [~]dashline [~]msaa [~]aaconvex "
@@ -145,6 +153,12 @@ class SKPBench:
     ARGV.extend(['--gpuClock', 'true'])
   if FLAGS.fps:
     ARGV.extend(['--fps', 'true'])
+  if FLAGS.frame_stats:
+    ARGV.extend(['--frameStats', 'true'])
+  if FLAGS.jank_ms:
+    ARGV.extend(['--jankMs', str(FLAGS.jank_ms)])
+  if FLAGS.compare_pipeline_cache:
+    ARGV.extend(['--comparePipelineCache', 'true'])
   if FLAGS.pr:
     ARGV.extend(['--pr'] + re.split(r'[ ,]', FLAGS.pr))
   if FLAGS.cc:
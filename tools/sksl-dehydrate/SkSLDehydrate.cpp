@@ -0,0 +1,150 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#define SK_OPTS_NS sksl_dehydrate_standalone
+#include "include/core/SkData.h"
+#include "src/core/SkOpts.h"
+#include "src/sksl/SkSLCompiler.h"
+#include "src/sksl/SkSLDehydrator.h"
+#include "src/sksl/SkSLFileOutputStream.h"
+#include "src/sksl/SkSLModuleLoader.h"
+#include "src/sksl/SkSLProgramKind.h"
+#include "src/sksl/ir/SkSLSymbolTable.h"
+
+#include "src/sksl/generated/sksl_compute.minified.sksl"
+#include "src/sksl/generated/sksl_frag.minified.sksl"
+#include "src/sksl/generated/sksl_gpu.minified.sksl"
+#include "src/sksl/generated/sksl_graphite_frag.minified.sksl"
+#include "src/sksl/generated/sksl_graphite_frag_es2.minified.sksl"
+#include "src/sksl/generated/sksl_graphite_vert.minified.sksl"
+#include "src/sksl/generated/sksl_graphite_vert_es2.minified.sksl"
+#include "src/sksl/generated/sksl_public.minified.sksl"
+#include "src/sksl/generated/sksl_rt_shader.minified.sksl"
+#include "src/sksl/generated/sksl_shared.minified.sksl"
+#include "src/sksl/generated/sksl_vert.minified.sksl"
+
+#include <iterator>
+#include <memory>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string>
+
+void SkDebugf(const char format[], ...) {
+    va_list args;
+    va_start(args, format);
+    vfprintf(stderr, format, args);
+    va_end(args);
+}
+
+namespace SkOpts {
+    size_t raster_pipeline_highp_stride = 1;
+}
+
+namespace {
+
+struct ModuleInfo {
+    const char* fName;
+    const char* fSource;
+    SkSL::ProgramKind fKind;
+    int fParent;  // An index into kModules, or -1 for the root module.
+};
+
+// The modules are compiled from their minified code, the same way ModuleLoader compiles them, so
+// that the dehydrated IR matches the release builds. Parents are listed before their children.
+#define MODULE(name) #name, SKSL_MINIFIED_##name
+const ModuleInfo kModules[] = {
+    {MODULE(sksl_shared),            SkSL::ProgramKind::kFragment,             -1},
+    {MODULE(sksl_gpu),               SkSL::ProgramKind::kFragment,              0},
+    {MODULE(sksl_vert),              SkSL::ProgramKind::kVertex,                1},
+    {MODULE(sksl_frag),              SkSL::ProgramKind::kFragment,              1},
+    {MODULE(sksl_compute),           SkSL::ProgramKind::kCompute,               1},
+    {MODULE(sksl_graphite_vert),     SkSL::ProgramKind::kGraphiteVertex,        2},
+    {MODULE(sksl_graphite_frag),     SkSL::ProgramKind::kGraphiteFragment,      3},
+    {MODULE(sksl_graphite_vert_es2), SkSL::ProgramKind::kGraphiteVertexES2,     2},
+    {MODULE(sksl_graphite_frag_es2), SkSL::ProgramKind::kGraphiteFragmentES2,   3},
+    {MODULE(sksl_public),            SkSL::ProgramKind::kFragment,              0},
+    {MODULE(sksl_rt_shader),         SkSL::ProgramKind::kFragment,              9},
+};
+#undef MODULE
+
+constexpr int kPublicModule = 9;
+
+std::unique_ptr<SkSL::Module> compile_module(SkSL::Compiler* compiler,
+                                             const ModuleInfo& info,
+                                             const SkSL::Module* parent) {
+    if (info.fSource[0] == '\0') {
+        // The ES2 modules are still empty, and the compiler doesn't take empty modules. They're
+        // dehydrated as a module that declares nothing.
+        auto module = std::make_unique<SkSL::Module>();
+        module->fParent = parent;
+        module->fSymbols = std::make_unique<SkSL::SymbolTable>(parent->fSymbols.get(),
+                                                               /*builtin=*/true);
+        module->fSymbols->markModuleBoundary();
+        return module;
+    }
+    return compiler->compileModule(info.fKind, info.fName, info.fSource, parent,
+                                   /*shouldInline=*/true);
+}
+
+bool write_dehydrated_module(const char* outputDir, const char* name, const SkData& data) {
+    std::string path = std::string(outputDir) + "/" + name + ".dehydrated.sksl";
+    SkSL::FileOutputStream out(path.c_str());
+    if (!out.isValid()) {
+        printf("error writing '%s'\n", path.c_str());
+        return false;
+    }
+    out.printf("static constexpr uint8_t SKSL_DEHYDRATED_%s[] = {", name);
+    const uint8_t* bytes = data.bytes();
+    for (size_t i = 0; i < data.size(); ++i) {
+        out.writeText(i % 16 ? " " : "\n    ");
+        out.printf("0x%02x,", bytes[i]);
+    }
+    out.writeText("\n};\n");
+    if (!out.close()) {
+        printf("error writing '%s'\n", path.c_str());
+        return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, const char** argv) {
+    if (argc != 2) {
+        printf("usage: sksl-dehydrate <output dir>\n"
+               "\n"
+               "Compiles the minified built-in modules and writes their dehydrated IR.\n");
+        return 1;
+    }
+
+    const SkSL::Module* rootModule = SkSL::ModuleLoader::Get().rootModule();
+    SkSL::Compiler compiler;
+    std::unique_ptr<SkSL::Module> modules[std::size(kModules)];
+    for (size_t index = 0; index < std::size(kModules); ++index) {
+        const ModuleInfo& info = kModules[index];
+        const SkSL::Module* parent = info.fParent < 0 ? rootModule : modules[info.fParent].get();
+        modules[index] = compile_module(&compiler, info, parent);
+        if (!modules[index]) {
+            return 1;
+        }
+
+        sk_sp<SkData> data = SkSL::Dehydrator::Dehydrate(*modules[index], info.fSource);
+        if (!data) {
+            printf("error dehydrating '%s'\n", info.fName);
+            return 1;
+        }
+        if (!write_dehydrated_module(argv[1], info.fName, *data)) {
+            return 1;
+        }
+
+        if (index == kPublicModule) {
+            // The runtime shader module is compiled with the public type aliases in scope.
+            SkSL::ModuleLoader::Get().addPublicTypeAliases(modules[index].get());
+        }
+    }
+    return 0;
+}
@@ -12,6 +12,7 @@
 #include "src/core/SkCpu.h"
 #include "src/core/SkOpts.h"
 #include "src/sksl/SkSLCompiler.h"
+#include "src/sksl/SkSLDefines.h"
 #include "src/sksl/SkSLFileOutputStream.h"
 #include "src/sksl/SkSLProgramSettings.h"
 #include "src/sksl/SkSLStringStream.h"
@@ -464,6 +465,12 @@ static bool detect_shader_settings(const std::string& text,
                 if (consume_suffix(&settingsText, " InlineThresholdMax")) {
                     settings->fInlineThreshold = INT_MAX;
                 }
+                if (consume_suffix(&settingsText, " UnrollLoops")) {
+                    settings->fUnrollLoopThreshold = SkSL::kDefaultUnrollLoopThreshold;
+                }
+                if (consume_suffix(&settingsText, " EliminateCommonSubexpressions")) {
+                    settings->fEliminateCommonSubexpressions = true;
+                }
                 if (consume_suffix(&settingsText, " Sharpen")) {
                     settings->fSharpenTextures = true;
                 }